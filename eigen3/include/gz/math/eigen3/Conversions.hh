@@ -18,10 +18,15 @@
 #ifndef GZ_MATH_EIGEN3_CONVERSIONS_HH_
 #define GZ_MATH_EIGEN3_CONVERSIONS_HH_
 
+#include <cstddef>
+#include <vector>
+
 #include <Eigen/Geometry>
 #include <gz/math/AxisAlignedBox.hh>
 #include <gz/math/Matrix3.hh>
+#include <gz/math/Matrix4.hh>
 #include <gz/math/Matrix6.hh>
+#include <gz/math/MatrixN.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/Quaternion.hh>
 #include <gz/math/Vector3.hh>
@@ -88,6 +93,28 @@ namespace ignition
         return matrix;
       }
 
+      /// \brief Convert from gz::math::MatrixN to Eigen::Matrix.
+      /// \param[in] _m gz::math::MatrixN to convert.
+      /// \return The equivalent Eigen::Matrix.
+      /// \tparam Precision Precision such as int, double or float.
+      /// \tparam Rows Number of rows.
+      /// \tparam Cols Number of columns.
+      template<typename Precision, std::size_t Rows, std::size_t Cols>
+      inline Eigen::Matrix<Precision, Rows, Cols> convert(
+          const MatrixN<Precision, Rows, Cols> &_m)
+      {
+        Eigen::Matrix<Precision, Rows, Cols> matrix;
+        for (std::size_t i = 0; i < Rows; ++i)
+        {
+          for (std::size_t j = 0; j < Cols; ++j)
+          {
+            matrix(i, j) = _m(i, j);
+          }
+        }
+
+        return matrix;
+      }
+
       /// \brief Convert gz::math::Quaterniond to Eigen::Quaterniond.
       /// \param[in] _q gz::math::Quaterniond to convert.
       /// \return The equivalent Eigen::Quaterniond.
@@ -178,6 +205,28 @@ namespace ignition
         return matrix;
       }
 
+      /// \brief Convert an Eigen::Matrix to gz::math::MatrixN.
+      /// \param[in] _m Eigen matrix to convert.
+      /// \return The equivalent gz::math::MatrixN.
+      /// \tparam Precision Precision such as int, double or float.
+      /// \tparam Rows Number of rows.
+      /// \tparam Cols Number of columns.
+      template<typename Precision, int Rows, int Cols, int Options>
+      inline MatrixN<Precision, Rows, Cols> convert(
+          const Eigen::Matrix<Precision, Rows, Cols, Options> &_m)
+      {
+        MatrixN<Precision, Rows, Cols> matrix;
+        for (std::size_t i = 0; i < Rows; ++i)
+        {
+          for (std::size_t j = 0; j < Cols; ++j)
+          {
+            matrix(i, j) = _m(i, j);
+          }
+        }
+
+        return matrix;
+      }
+
       /// \brief Convert Eigen::Quaterniond to gz::math::Quaterniond.
       /// \param[in] _q Eigen::Quaterniond to convert.
       /// \return The equivalent gz::math::Quaterniond.
@@ -203,6 +252,224 @@ namespace ignition
 
         return pose;
       }
+
+      /// \brief Check at compile time that Vector3<Precision> can be viewed
+      /// as a column of an Eigen::Map without copying: its coordinates are
+      /// the contiguous array returned by operator[], and arrays of it have
+      /// a stride which is a whole number of coordinates.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      constexpr bool checkVector3Layout()
+      {
+        static_assert(sizeof(Vector3<Precision>) % sizeof(Precision) == 0,
+          "Vector3 size must be a multiple of its coordinate size");
+        static_assert(sizeof(Vector3<Precision>) >= 3 * sizeof(Precision),
+          "Vector3 must store its coordinates in place");
+        return true;
+      }
+
+      /// \brief Eigen::Map view of an array of Vector3, as a 3xN matrix
+      /// with one column per vector.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      using Vector3ArrayMap = Eigen::Map<
+        Eigen::Matrix<Precision, 3, Eigen::Dynamic>, Eigen::Unaligned,
+        Eigen::OuterStride<>>;
+
+      /// \brief Read only Eigen::Map view of an array of Vector3, as a 3xN
+      /// matrix with one column per vector.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      using ConstVector3ArrayMap = Eigen::Map<
+        const Eigen::Matrix<Precision, 3, Eigen::Dynamic>, Eigen::Unaligned,
+        Eigen::OuterStride<>>;
+
+      /// \brief View a gz::math::Vector3 as an Eigen vector without copying.
+      /// Changes to the view change _v.
+      /// \param[in] _v Vector to view. It must outlive the view.
+      /// \return Eigen::Map of the coordinates of _v.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      inline Eigen::Map<Eigen::Matrix<Precision, 3, 1>> map(
+          Vector3<Precision> &_v)
+      {
+        static_assert(checkVector3Layout<Precision>(), "");
+        return Eigen::Map<Eigen::Matrix<Precision, 3, 1>>(&_v[0]);
+      }
+
+      /// \brief View a gz::math::Vector3 as a read only Eigen vector without
+      /// copying.
+      /// \param[in] _v Vector to view. It must outlive the view.
+      /// \return Eigen::Map of the coordinates of _v.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      inline Eigen::Map<const Eigen::Matrix<Precision, 3, 1>> map(
+          const Vector3<Precision> &_v)
+      {
+        static_assert(checkVector3Layout<Precision>(), "");
+        return Eigen::Map<const Eigen::Matrix<Precision, 3, 1>>(
+          &const_cast<Vector3<Precision> &>(_v)[0]);
+      }
+
+      /// \brief View an array of gz::math::Vector3 as a 3xN Eigen matrix
+      /// without copying, so that bulk linear algebra runs directly on it.
+      /// For example, map(points, count) = rotation * map(points, count)
+      /// rotates every point in place. Changes to the view change the
+      /// vectors.
+      /// \param[in] _v Array of _count vectors. It must outlive the view.
+      /// \param[in] _count Number of vectors.
+      /// \return Eigen::Map with one column per vector.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      inline Vector3ArrayMap<Precision> map(Vector3<Precision> *_v,
+          const std::size_t _count)
+      {
+        static_assert(checkVector3Layout<Precision>(), "");
+        return Vector3ArrayMap<Precision>(
+          _count == 0 ? nullptr : &_v[0][0], 3,
+          static_cast<Eigen::Index>(_count),
+          Eigen::OuterStride<>(sizeof(Vector3<Precision>) /
+                               sizeof(Precision)));
+      }
+
+      /// \brief View an array of gz::math::Vector3 as a read only 3xN Eigen
+      /// matrix without copying.
+      /// \param[in] _v Array of _count vectors. It must outlive the view.
+      /// \param[in] _count Number of vectors.
+      /// \return Eigen::Map with one column per vector.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      inline ConstVector3ArrayMap<Precision> map(
+          const Vector3<Precision> *_v, const std::size_t _count)
+      {
+        static_assert(checkVector3Layout<Precision>(), "");
+        return ConstVector3ArrayMap<Precision>(
+          _count == 0 ? nullptr : &const_cast<Vector3<Precision> *>(_v)[0][0],
+          3, static_cast<Eigen::Index>(_count),
+          Eigen::OuterStride<>(sizeof(Vector3<Precision>) /
+                               sizeof(Precision)));
+      }
+
+      /// \brief View a vector of gz::math::Vector3 as a 3xN Eigen matrix
+      /// without copying. The view is invalidated if _v is resized.
+      /// \param[in] _v Vectors to view.
+      /// \return Eigen::Map with one column per vector.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      inline Vector3ArrayMap<Precision> map(
+          std::vector<Vector3<Precision>> &_v)
+      {
+        return map(_v.data(), _v.size());
+      }
+
+      /// \brief View a vector of gz::math::Vector3 as a read only 3xN Eigen
+      /// matrix without copying. The view is invalidated if _v is resized.
+      /// \param[in] _v Vectors to view.
+      /// \return Eigen::Map with one column per vector.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      inline ConstVector3ArrayMap<Precision> map(
+          const std::vector<Vector3<Precision>> &_v)
+      {
+        return map(_v.data(), _v.size());
+      }
+
+      /// \brief View a gz::math::Matrix3 as an Eigen matrix without copying.
+      /// Its elements are stored in row major order. Changes to the view
+      /// change _m.
+      /// \param[in] _m Matrix to view. It must outlive the view.
+      /// \return Eigen::Map of the elements of _m.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      inline Eigen::Map<Eigen::Matrix<Precision, 3, 3, Eigen::RowMajor>> map(
+          Matrix3<Precision> &_m)
+      {
+        static_assert(sizeof(Matrix3<Precision>) >= 9 * sizeof(Precision),
+          "Matrix3 must store its elements in place");
+        return Eigen::Map<Eigen::Matrix<Precision, 3, 3, Eigen::RowMajor>>(
+          &_m(0, 0));
+      }
+
+      /// \brief View a gz::math::Matrix3 as a read only Eigen matrix without
+      /// copying.
+      /// \param[in] _m Matrix to view. It must outlive the view.
+      /// \return Eigen::Map of the elements of _m.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      inline Eigen::Map<const Eigen::Matrix<Precision, 3, 3, Eigen::RowMajor>>
+        map(const Matrix3<Precision> &_m)
+      {
+        static_assert(sizeof(Matrix3<Precision>) >= 9 * sizeof(Precision),
+          "Matrix3 must store its elements in place");
+        return Eigen::Map<
+          const Eigen::Matrix<Precision, 3, 3, Eigen::RowMajor>>(&_m(0, 0));
+      }
+
+      /// \brief View a gz::math::Matrix4 as an Eigen matrix without copying.
+      /// Its elements are stored in row major order. Changes to the view
+      /// change _m.
+      /// \param[in] _m Matrix to view. It must outlive the view.
+      /// \return Eigen::Map of the elements of _m.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      inline Eigen::Map<Eigen::Matrix<Precision, 4, 4, Eigen::RowMajor>> map(
+          Matrix4<Precision> &_m)
+      {
+        static_assert(sizeof(Matrix4<Precision>) >= 16 * sizeof(Precision),
+          "Matrix4 must store its elements in place");
+        return Eigen::Map<Eigen::Matrix<Precision, 4, 4, Eigen::RowMajor>>(
+          &_m(0, 0));
+      }
+
+      /// \brief View a gz::math::Matrix4 as a read only Eigen matrix without
+      /// copying.
+      /// \param[in] _m Matrix to view. It must outlive the view.
+      /// \return Eigen::Map of the elements of _m.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision>
+      inline Eigen::Map<const Eigen::Matrix<Precision, 4, 4, Eigen::RowMajor>>
+        map(const Matrix4<Precision> &_m)
+      {
+        static_assert(sizeof(Matrix4<Precision>) >= 16 * sizeof(Precision),
+          "Matrix4 must store its elements in place");
+        return Eigen::Map<
+          const Eigen::Matrix<Precision, 4, 4, Eigen::RowMajor>>(&_m(0, 0));
+      }
+
+      /// \brief Eigen matrix type with the row major layout of
+      /// gz::math::MatrixN. Eigen requires column vectors to be column
+      /// major, which is the same layout.
+      /// \tparam Precision Precision such as int, double or float.
+      /// \tparam Rows Number of rows.
+      /// \tparam Cols Number of columns.
+      template<typename Precision, std::size_t Rows, std::size_t Cols>
+      using MatrixNLayout = Eigen::Matrix<Precision, Rows, Cols,
+        (Cols == 1 && Rows != 1) ? Eigen::ColMajor : Eigen::RowMajor>;
+
+      /// \brief View a gz::math::MatrixN as an Eigen matrix without copying.
+      /// Changes to the view change _m.
+      /// \param[in] _m Matrix to view. It must outlive the view.
+      /// \return Eigen::Map of the elements of _m.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision, std::size_t Rows, std::size_t Cols>
+      inline Eigen::Map<MatrixNLayout<Precision, Rows, Cols>> map(
+          MatrixN<Precision, Rows, Cols> &_m)
+      {
+        return Eigen::Map<MatrixNLayout<Precision, Rows, Cols>>(_m.Data());
+      }
+
+      /// \brief View a gz::math::MatrixN as a read only Eigen matrix
+      /// without copying.
+      /// \param[in] _m Matrix to view. It must outlive the view.
+      /// \return Eigen::Map of the elements of _m.
+      /// \tparam Precision Precision such as int, double or float.
+      template<typename Precision, std::size_t Rows, std::size_t Cols>
+      inline Eigen::Map<const MatrixNLayout<Precision, Rows, Cols>> map(
+          const MatrixN<Precision, Rows, Cols> &_m)
+      {
+        return Eigen::Map<const MatrixNLayout<Precision, Rows, Cols>>(
+          _m.Data());
+      }
     }
   }
 }
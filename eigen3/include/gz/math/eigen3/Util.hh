@@ -18,6 +18,10 @@
 #ifndef GZ_MATH_EIGEN3_UTIL_HH_
 #define GZ_MATH_EIGEN3_UTIL_HH_
 
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <thread>
 #include <vector>
 
 #include <Eigen/Geometry>
@@ -28,6 +32,7 @@
 #include <gz/math/OrientedBox.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/Quaternion.hh>
+#include <gz/math/Trace.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/eigen3/Conversions.hh>
 
@@ -37,36 +42,88 @@ namespace ignition
   {
     namespace eigen3
     {
-      /// \brief Get covariance matrix from a set of 3d vertices
-      /// https://github.com/isl-org/Open3D/blob/76c2baf9debd460900f056a9b51e9a80de9c0e64/cpp/open3d/utility/Eigen.cpp#L305
-      /// \param[in] _vertices a vector of 3d vertices
-      /// \return Covariance matrix
-      inline Eigen::Matrix3d covarianceMatrix(
-        const std::vector<math::Vector3d> &_vertices)
+      /// \brief Minimum number of vertices processed by each thread of the
+      /// multithreaded functions below.
+      const std::size_t kMinVerticesPerThread = 65536;
+
+      /// \brief Get the number of threads used to process vertices.
+      /// \param[in] _count Number of vertices.
+      /// \param[in] _threads Requested number of threads, or 0 for the
+      /// number of hardware threads.
+      /// \return Number of threads, at least 1.
+      inline std::size_t vertexThreads(const std::size_t _count,
+        const unsigned int _threads)
       {
-        if (_vertices.empty())
-          return Eigen::Matrix3d::Identity();
+        std::size_t threads = _threads;
+        if (threads == 0)
+          threads = std::thread::hardware_concurrency();
+        threads = std::min(threads, _count / kMinVerticesPerThread);
+        return std::max<std::size_t>(threads, 1);
+      }
 
-        Eigen::Matrix<double, 9, 1> cumulants;
-        cumulants.setZero();
-        for (const auto &vertex : _vertices)
+      /// \brief Call a function on contiguous blocks of vertices, each on
+      /// its own thread.
+      /// \param[in] _count Number of vertices.
+      /// \param[in] _threads Number of threads, from vertexThreads.
+      /// \param[in] _function Function called with the thread index and the
+      /// first and past the last vertex index of its block.
+      template<typename Function>
+      void forEachVertexBlock(const std::size_t _count,
+        const std::size_t _threads, const Function &_function)
+      {
+        const std::size_t chunk = (_count + _threads - 1) / _threads;
+        std::vector<std::thread> workers;
+        for (std::size_t t = 1; t < _threads; ++t)
         {
-          const Eigen::Vector3d &point = math::eigen3::convert(vertex);
-          cumulants(0) += point(0);
-          cumulants(1) += point(1);
-          cumulants(2) += point(2);
-          cumulants(3) += point(0) * point(0);
-          cumulants(4) += point(0) * point(1);
-          cumulants(5) += point(0) * point(2);
-          cumulants(6) += point(1) * point(1);
-          cumulants(7) += point(1) * point(2);
-          cumulants(8) += point(2) * point(2);
+          const std::size_t begin = std::min(_count, t * chunk);
+          const std::size_t end = std::min(_count, begin + chunk);
+          workers.emplace_back(
+              [&_function, t, begin, end]()
+              {
+                _function(t, begin, end);
+              });
         }
+        _function(0, 0, std::min(_count, chunk));
 
-        Eigen::Matrix3d covariance;
+        for (auto &worker : workers)
+          worker.join();
+      }
 
-        cumulants /= static_cast<double>(_vertices.size());
+      /// \brief Sums of the coordinates of a set of vertices and of their
+      /// products, from which the covariance matrix is computed. The sums
+      /// are x, y, z, xx, xy, xz, yy, yz and zz.
+      using Cumulants = Eigen::Matrix<double, 9, 1>;
 
+      /// \brief Add a vertex to the cumulants of a set of vertices.
+      /// \param[in] _vertex Vertex to add.
+      /// \param[in,out] _cumulants Cumulants to add the vertex to.
+      inline void addCumulants(const math::Vector3d &_vertex,
+        Cumulants &_cumulants)
+      {
+        const Eigen::Vector3d &point = math::eigen3::convert(_vertex);
+        _cumulants(0) += point(0);
+        _cumulants(1) += point(1);
+        _cumulants(2) += point(2);
+        _cumulants(3) += point(0) * point(0);
+        _cumulants(4) += point(0) * point(1);
+        _cumulants(5) += point(0) * point(2);
+        _cumulants(6) += point(1) * point(1);
+        _cumulants(7) += point(1) * point(2);
+        _cumulants(8) += point(2) * point(2);
+      }
+
+      /// \brief Get the covariance matrix from the cumulants of a set of
+      /// vertices.
+      /// \param[in] _cumulants Cumulants of the vertices.
+      /// \param[in] _count Number of vertices, which must be positive.
+      /// \return Covariance matrix
+      inline Eigen::Matrix3d covarianceMatrix(const Cumulants &_cumulants,
+        const std::size_t _count)
+      {
+        const Cumulants cumulants =
+          _cumulants / static_cast<double>(_count);
+
+        Eigen::Matrix3d covariance;
         covariance(0, 0) = cumulants(3) - cumulants(0) * cumulants(0);
         covariance(1, 1) = cumulants(6) - cumulants(1) * cumulants(1);
         covariance(2, 2) = cumulants(8) - cumulants(2) * cumulants(2);
@@ -79,31 +136,73 @@ namespace ignition
         return covariance;
       }
 
-      /// \brief Get the oriented 3d bounding box of a set of 3d
-      /// vertices using PCA
-      /// http://codextechnicanum.blogspot.com/2015/04/find-minimum-oriented-bounding-box-of.html
+      /// \brief Get the cumulants of a set of 3d vertices, summing
+      /// contiguous blocks of vertices on several threads.
       /// \param[in] _vertices a vector of 3d vertices
-      /// \return Oriented 3D box
-      inline gz::math::OrientedBoxd verticesToOrientedBox(
-        const std::vector<math::Vector3d> &_vertices)
+      /// \param[in] _threads Number of threads, or 0 for the number of
+      /// hardware threads. Small sets of vertices always use a single
+      /// thread. The sums are combined in a different order with more than
+      /// one thread, so results may differ in the last bits from a single
+      /// thread run.
+      /// \return Cumulants of the vertices
+      inline Cumulants vertexCumulants(
+        const std::vector<math::Vector3d> &_vertices,
+        const unsigned int _threads = 1)
       {
-        math::OrientedBoxd box;
+        const std::size_t threads =
+          vertexThreads(_vertices.size(), _threads);
+        std::vector<Cumulants> partial(threads, Cumulants::Zero());
+        forEachVertexBlock(_vertices.size(), threads,
+          [&](std::size_t _t, std::size_t _begin, std::size_t _end)
+          {
+            for (std::size_t i = _begin; i < _end; ++i)
+              addCumulants(_vertices[i], partial[_t]);
+          });
 
-        // Return an empty box if there are no vertices
+        for (std::size_t t = 1; t < threads; ++t)
+          partial[0] += partial[t];
+        return partial[0];
+      }
+
+      /// \brief Get covariance matrix from a set of 3d vertices, summing
+      /// contiguous blocks of vertices on several threads.
+      /// \param[in] _vertices a vector of 3d vertices
+      /// \param[in] _threads Number of threads, or 0 for the number of
+      /// hardware threads. Small sets of vertices always use a single
+      /// thread, and give the same result as
+      /// covarianceMatrix(const std::vector<math::Vector3d> &).
+      /// \return Covariance matrix
+      /// \sa vertexCumulants
+      inline Eigen::Matrix3d covarianceMatrix(
+        const std::vector<math::Vector3d> &_vertices,
+        const unsigned int _threads)
+      {
         if (_vertices.empty())
-          return box;
+          return Eigen::Matrix3d::Identity();
 
-        math::Vector3d mean;
-        for (const auto &point : _vertices)
-          mean += point;
-        mean /= static_cast<double>(_vertices.size());
+        return covarianceMatrix(vertexCumulants(_vertices, _threads),
+                                _vertices.size());
+      }
 
-        Eigen::Vector3d centroid = math::eigen3::convert(mean);
-        Eigen::Matrix3d covariance = covarianceMatrix(_vertices);
+      /// \brief Get covariance matrix from a set of 3d vertices
+      /// https://github.com/isl-org/Open3D/blob/76c2baf9debd460900f056a9b51e9a80de9c0e64/cpp/open3d/utility/Eigen.cpp#L305
+      /// \param[in] _vertices a vector of 3d vertices
+      /// \return Covariance matrix
+      inline Eigen::Matrix3d covarianceMatrix(
+        const std::vector<math::Vector3d> &_vertices)
+      {
+        return covarianceMatrix(_vertices, 1);
+      }
 
+      /// \brief Get the principal axes of a set of vertices, which are the
+      /// eigenvectors of their covariance matrix.
+      /// \param[in] _covariance Covariance matrix of the vertices.
+      /// \return Rotation matrix whose columns are the principal axes.
+      inline Eigen::Matrix3d principalAxes(const Eigen::Matrix3d &_covariance)
+      {
         // Eigen Vectors
         Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d>
-          eigenSolver(covariance, Eigen::ComputeEigenvectors);
+          eigenSolver(_covariance, Eigen::ComputeEigenvectors);
         Eigen::Matrix3d eigenVectorsPCA = eigenSolver.eigenvectors();
 
         // This line is necessary for proper orientation in some cases.
@@ -111,49 +210,425 @@ namespace ignition
         // different and the box doesn't get correctly oriented in some cases.
         eigenVectorsPCA.col(2) =
           eigenVectorsPCA.col(0).cross(eigenVectorsPCA.col(1));
+        return eigenVectorsPCA;
+      }
 
-        // Transform the original cloud to the origin where the principal
-        // components correspond to the axes.
-        Eigen::Matrix4d projectionTransform(Eigen::Matrix4d::Identity());
-        projectionTransform.block<3, 3>(0, 0) = eigenVectorsPCA.transpose();
-        projectionTransform.block<3, 1>(0, 3) =
-          -1.0f * (projectionTransform.block<3, 3>(0, 0) * centroid);
-
-        Eigen::Vector3d minPoint(INF_I32, INF_I32, INF_I32);
-        Eigen::Vector3d maxPoint(-INF_I32, -INF_I32, -INF_I32);
-
-        // Get the minimum and maximum points of the transformed cloud.
-        for (const auto &point : _vertices)
-        {
-          Eigen::Vector4d pt(0, 0, 0, 1);
-          pt.head<3>() = math::eigen3::convert(point);
-          Eigen::Vector4d tfPoint = projectionTransform * pt;
-          minPoint = minPoint.cwiseMin(tfPoint.head<3>());
-          maxPoint = maxPoint.cwiseMax(tfPoint.head<3>());
-        }
-
-        const Eigen::Vector3d meanDiagonal = 0.5f * (maxPoint + minPoint);
+      /// \brief Get the box which is aligned with the principal axes of a set
+      /// of vertices and bounds their extents along those axes.
+      /// \param[in] _axes Principal axes, from principalAxes.
+      /// \param[in] _centroid Origin of the frame of the extents.
+      /// \param[in] _minPoint Minimum of the vertices in the frame of the
+      /// principal axes centered at _centroid.
+      /// \param[in] _maxPoint Maximum of the vertices in the same frame.
+      /// \return Oriented 3D box
+      inline gz::math::OrientedBoxd orientedBox(const Eigen::Matrix3d &_axes,
+        const Eigen::Vector3d &_centroid, const Eigen::Vector3d &_minPoint,
+        const Eigen::Vector3d &_maxPoint)
+      {
+        const Eigen::Vector3d meanDiagonal = 0.5f * (_maxPoint + _minPoint);
 
         // quaternion is calculated using the eigenvectors (which determines
         // how the final box gets rotated), and the transform to put the box
         // in correct location is calculated
-        const Eigen::Quaterniond bboxQuaternion(eigenVectorsPCA);
+        const Eigen::Quaterniond bboxQuaternion(_axes);
         const Eigen::Vector3d bboxTransform =
-          eigenVectorsPCA * meanDiagonal + centroid;
+          _axes * meanDiagonal + _centroid;
 
         math::Vector3d size(
-            maxPoint.x() - minPoint.x(),
-            maxPoint.y() - minPoint.y(),
-            maxPoint.z() - minPoint.z()
+            _maxPoint.x() - _minPoint.x(),
+            _maxPoint.y() - _minPoint.y(),
+            _maxPoint.z() - _minPoint.z()
         );
         math::Pose3d pose;
         pose.Rot() = math::eigen3::convert(bboxQuaternion);
         pose.Pos() = math::eigen3::convert(bboxTransform);
 
+        math::OrientedBoxd box;
         box.Size(size);
         box.Pose(pose);
         return box;
       }
+
+      /// \brief Get the vertices of an approximate convex hull of a set of
+      /// vertices, which are the vertices with the smallest and largest
+      /// projections on the 13 axes of a 26-DOP: the coordinate axes, the
+      /// face diagonals and the cube diagonals. Every one of them is a
+      /// vertex of the convex hull.
+      /// \param[in] _vertices a vector of 3d vertices
+      /// \param[in] _threads Number of threads, or 0 for the number of
+      /// hardware threads. Small sets of vertices always use a single
+      /// thread.
+      /// \return At most 26 distinct vertices, or no vertices if _vertices
+      /// is empty.
+      inline std::vector<math::Vector3d> extremeVertices(
+        const std::vector<math::Vector3d> &_vertices,
+        const unsigned int _threads = 1)
+      {
+        constexpr int kAxes = 13;
+        const Eigen::Vector3d axes[kAxes] =
+        {
+          {1, 0, 0}, {0, 1, 0}, {0, 0, 1},
+          {1, 1, 0}, {1, -1, 0}, {1, 0, 1}, {1, 0, -1}, {0, 1, 1}, {0, 1, -1},
+          {1, 1, 1}, {1, 1, -1}, {1, -1, 1}, {1, -1, -1}
+        };
+
+        if (_vertices.empty())
+          return {};
+
+        // Index and projection of the vertex with the smallest and largest
+        // projection on each axis, found for each block of vertices.
+        struct Extremes
+        {
+          std::size_t min[kAxes] = {};
+          std::size_t max[kAxes] = {};
+          double minValue[kAxes];
+          double maxValue[kAxes];
+        };
+
+        const std::size_t threads =
+          vertexThreads(_vertices.size(), _threads);
+        std::vector<Extremes> partial(threads);
+        forEachVertexBlock(_vertices.size(), threads,
+          [&](std::size_t _t, std::size_t _begin, std::size_t _end)
+          {
+            Extremes &extremes = partial[_t];
+            std::fill(extremes.minValue, extremes.minValue + kAxes,
+                      std::numeric_limits<double>::infinity());
+            std::fill(extremes.maxValue, extremes.maxValue + kAxes,
+                      -std::numeric_limits<double>::infinity());
+            for (std::size_t i = _begin; i < _end; ++i)
+            {
+              const Eigen::Vector3d &point =
+                math::eigen3::convert(_vertices[i]);
+              for (int a = 0; a < kAxes; ++a)
+              {
+                const double d = axes[a].dot(point);
+                if (d < extremes.minValue[a])
+                {
+                  extremes.minValue[a] = d;
+                  extremes.min[a] = i;
+                }
+                if (d > extremes.maxValue[a])
+                {
+                  extremes.maxValue[a] = d;
+                  extremes.max[a] = i;
+                }
+              }
+            }
+          });
+
+        // Blocks are merged in order, so ties go to the first vertex like
+        // in a single block. Empty blocks keep infinite values.
+        Extremes extremes = partial[0];
+        for (std::size_t t = 1; t < threads; ++t)
+        {
+          for (int a = 0; a < kAxes; ++a)
+          {
+            if (partial[t].minValue[a] < extremes.minValue[a])
+            {
+              extremes.minValue[a] = partial[t].minValue[a];
+              extremes.min[a] = partial[t].min[a];
+            }
+            if (partial[t].maxValue[a] > extremes.maxValue[a])
+            {
+              extremes.maxValue[a] = partial[t].maxValue[a];
+              extremes.max[a] = partial[t].max[a];
+            }
+          }
+        }
+
+        std::vector<std::size_t> indices(extremes.min, extremes.min + kAxes);
+        indices.insert(indices.end(), extremes.max, extremes.max + kAxes);
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()),
+                      indices.end());
+
+        std::vector<math::Vector3d> result;
+        result.reserve(indices.size());
+        for (const auto i : indices)
+          result.push_back(_vertices[i]);
+        return result;
+      }
+
+      /// \brief Get the axes of a box which tightly fits a small set of
+      /// vertices, such as the extremeVertices of a larger set, following
+      /// the DiTO algorithm of Larsson and Kallberg, "Fast Computation of
+      /// Tight-Fitting Oriented Bounding Boxes". A base triangle is made of
+      /// the two most distant vertices and the vertex farthest from the line
+      /// through them, and completed into two tetrahedra by the vertices
+      /// farthest above and below it. Each edge of each face of these gives
+      /// candidate axes: the edge, the face normal, and their cross product.
+      /// The candidate whose box around the vertices has the smallest
+      /// surface area is chosen.
+      /// \param[in] _vertices Vertices to fit. Every pair is compared, so
+      /// this should only be used with a few vertices.
+      /// \return Rotation matrix whose columns are the axes, or the identity
+      /// if _vertices has less than two distinct vertices.
+      inline Eigen::Matrix3d extremeVerticesAxes(
+        const std::vector<math::Vector3d> &_vertices)
+      {
+        std::vector<Eigen::Vector3d> points;
+        points.reserve(_vertices.size());
+        for (const auto &vertex : _vertices)
+          points.push_back(math::eigen3::convert(vertex));
+
+        // Most distant pair of vertices
+        std::size_t i0 = 0;
+        std::size_t i1 = 0;
+        double maxDistance = 0;
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+          for (std::size_t j = i + 1; j < points.size(); ++j)
+          {
+            const double distance = (points[j] - points[i]).squaredNorm();
+            if (distance > maxDistance)
+            {
+              maxDistance = distance;
+              i0 = i;
+              i1 = j;
+            }
+          }
+        }
+        if (maxDistance <= 0)
+          return Eigen::Matrix3d::Identity();
+
+        // Vertex farthest from the line through them
+        const Eigen::Vector3d &p0 = points[i0];
+        const Eigen::Vector3d &p1 = points[i1];
+        const Eigen::Vector3d line = (p1 - p0).normalized();
+        std::size_t i2 = i0;
+        double maxLineDistance = 0;
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+          const Eigen::Vector3d d = points[i] - p0;
+          const double distance = (d - d.dot(line) * line).squaredNorm();
+          if (distance > maxLineDistance)
+          {
+            maxLineDistance = distance;
+            i2 = i;
+          }
+        }
+
+        // Collinear vertices only fix the first axis
+        Eigen::Matrix3d axes;
+        if (maxLineDistance <= maxDistance * 1e-12)
+        {
+          axes.col(0) = line;
+          axes.col(1) = line.unitOrthogonal();
+          axes.col(2) = line.cross(axes.col(1));
+          return axes;
+        }
+
+        // Surface area of the box with the given axes around the vertices,
+        // which is a quarter of the actual area
+        auto area = [&points](const Eigen::Matrix3d &_axes)
+        {
+          Eigen::Vector3d minPoint = _axes.transpose() * points[0];
+          Eigen::Vector3d maxPoint = minPoint;
+          for (const auto &point : points)
+          {
+            const Eigen::Vector3d tfPoint = _axes.transpose() * point;
+            minPoint = minPoint.cwiseMin(tfPoint);
+            maxPoint = maxPoint.cwiseMax(tfPoint);
+          }
+          const Eigen::Vector3d size = maxPoint - minPoint;
+          return size.x() * size.y() + size.x() * size.z() +
+                 size.y() * size.z();
+        };
+
+        double minArea = std::numeric_limits<double>::infinity();
+        auto tryTriangle = [&](const Eigen::Vector3d &_a,
+          const Eigen::Vector3d &_b, const Eigen::Vector3d &_c)
+        {
+          const Eigen::Vector3d normal = (_b - _a).cross(_c - _a);
+          if (normal.squaredNorm() <= 0)
+            return;
+
+          const Eigen::Vector3d edges[] = {_b - _a, _c - _b, _a - _c};
+          for (const auto &edge : edges)
+          {
+            Eigen::Matrix3d candidate;
+            candidate.col(0) = edge.normalized();
+            candidate.col(1) = normal.normalized();
+            candidate.col(2) = candidate.col(0).cross(candidate.col(1));
+            const double candidateArea = area(candidate);
+            if (candidateArea < minArea)
+            {
+              minArea = candidateArea;
+              axes = candidate;
+            }
+          }
+        };
+
+        const Eigen::Vector3d &p2 = points[i2];
+        tryTriangle(p0, p1, p2);
+
+        // Vertices farthest above and below the base triangle
+        const Eigen::Vector3d normal = (p1 - p0).cross(p2 - p0);
+        std::size_t above = i0;
+        std::size_t below = i0;
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+          const double height = normal.dot(points[i] - p0);
+          if (height > normal.dot(points[above] - p0))
+            above = i;
+          if (height < normal.dot(points[below] - p0))
+            below = i;
+        }
+        for (const std::size_t apex : {above, below})
+        {
+          if (apex == i0)
+            continue;
+          tryTriangle(p0, p1, points[apex]);
+          tryTriangle(p1, p2, points[apex]);
+          tryTriangle(p2, p0, points[apex]);
+        }
+
+        return axes;
+      }
+
+      /// \brief Get the oriented 3d bounding box of a set of 3d
+      /// vertices using PCA, without storing the vertices. The vertices are
+      /// visited twice: once for their covariance, and once for their
+      /// extents along the principal axes. This suits vertices which are
+      /// selected or transformed on the fly, such as the points of a
+      /// cluster given by indices into a larger point cloud.
+      /// \param[in] _forEachVertex Function which takes a function of a
+      /// const math::Vector3d &, and calls it on every vertex. It must visit
+      /// the same vertices each time it is called.
+      /// \return Oriented 3D box, which is empty if there are no vertices.
+      /// \sa verticesToOrientedBox(const std::vector<math::Vector3d> &)
+      template<typename ForEachVertex>
+      gz::math::OrientedBoxd verticesToOrientedBox(
+        const ForEachVertex &_forEachVertex)
+      {
+        IGN_MATH_TRACE_ZONE("eigen3::verticesToOrientedBox");
+        Cumulants cumulants = Cumulants::Zero();
+        std::size_t count = 0;
+        _forEachVertex([&](const math::Vector3d &_vertex)
+          {
+            addCumulants(_vertex, cumulants);
+            ++count;
+          });
+
+        // Return an empty box if there are no vertices
+        if (count == 0)
+          return math::OrientedBoxd();
+
+        const Eigen::Vector3d centroid =
+          cumulants.head<3>() / static_cast<double>(count);
+        const Eigen::Matrix3d axes =
+          principalAxes(covarianceMatrix(cumulants, count));
+
+        // Get the minimum and maximum points of the cloud transformed to the
+        // origin, where the principal components correspond to the axes.
+        const Eigen::Matrix3d toAxes = axes.transpose();
+        const Eigen::Vector3d offset = -(toAxes * centroid);
+        Eigen::Vector3d minPoint(INF_I32, INF_I32, INF_I32);
+        Eigen::Vector3d maxPoint(-INF_I32, -INF_I32, -INF_I32);
+        _forEachVertex([&](const math::Vector3d &_vertex)
+          {
+            const Eigen::Vector3d tfPoint =
+              toAxes * math::eigen3::convert(_vertex) + offset;
+            minPoint = minPoint.cwiseMin(tfPoint);
+            maxPoint = maxPoint.cwiseMax(tfPoint);
+          });
+
+        return orientedBox(axes, centroid, minPoint, maxPoint);
+      }
+
+      /// \brief Get the oriented 3d bounding box of a set of 3d
+      /// vertices using PCA
+      /// http://codextechnicanum.blogspot.com/2015/04/find-minimum-oriented-bounding-box-of.html
+      /// \param[in] _vertices a vector of 3d vertices
+      /// \return Oriented 3D box
+      inline gz::math::OrientedBoxd verticesToOrientedBox(
+        const std::vector<math::Vector3d> &_vertices)
+      {
+        return verticesToOrientedBox(
+          [&_vertices](const auto &_function)
+          {
+            for (const auto &vertex : _vertices)
+              _function(vertex);
+          });
+      }
+
+      /// \brief Get the oriented 3d bounding box of a set of 3d
+      /// vertices using PCA, processing contiguous blocks of vertices on
+      /// several threads.
+      /// \param[in] _vertices a vector of 3d vertices
+      /// \param[in] _threads Number of threads, or 0 for the number of
+      /// hardware threads. Small sets of vertices always use a single
+      /// thread.
+      /// \param[in] _hullPrefilter If true, only the extremeVertices of
+      /// _vertices, which lie on their convex hull, are used to choose the
+      /// axes of the box with extremeVerticesAxes instead of PCA. This is
+      /// usually tighter than PCA, which is biased towards densely sampled
+      /// parts of a scan. The box still bounds every vertex.
+      /// \return Oriented 3D box
+      inline gz::math::OrientedBoxd verticesToOrientedBox(
+        const std::vector<math::Vector3d> &_vertices,
+        const unsigned int _threads, const bool _hullPrefilter = false)
+      {
+        IGN_MATH_TRACE_ZONE("eigen3::verticesToOrientedBox(threads)");
+
+        // Return an empty box if there are no vertices
+        if (_vertices.empty())
+          return math::OrientedBoxd();
+
+        Eigen::Vector3d centroid;
+        Eigen::Matrix3d axes;
+        if (_hullPrefilter)
+        {
+          const auto hull = extremeVertices(_vertices, _threads);
+          math::Vector3d mean;
+          for (const auto &point : hull)
+            mean += point;
+          centroid = math::eigen3::convert(mean) /
+            static_cast<double>(hull.size());
+          axes = extremeVerticesAxes(hull);
+        }
+        else
+        {
+          const Cumulants cumulants = vertexCumulants(_vertices, _threads);
+          centroid =
+            cumulants.head<3>() / static_cast<double>(_vertices.size());
+          axes = principalAxes(covarianceMatrix(cumulants, _vertices.size()));
+        }
+
+        // Get the minimum and maximum points of the cloud transformed to the
+        // origin, where the principal components correspond to the axes.
+        const Eigen::Matrix3d toAxes = axes.transpose();
+        const Eigen::Vector3d offset = -(toAxes * centroid);
+        const std::size_t threads =
+          vertexThreads(_vertices.size(), _threads);
+        std::vector<Eigen::Vector3d> minPoints(threads,
+          Eigen::Vector3d(INF_I32, INF_I32, INF_I32));
+        std::vector<Eigen::Vector3d> maxPoints(threads,
+          Eigen::Vector3d(-INF_I32, -INF_I32, -INF_I32));
+        forEachVertexBlock(_vertices.size(), threads,
+          [&](std::size_t _t, std::size_t _begin, std::size_t _end)
+          {
+            Eigen::Vector3d minPoint = minPoints[_t];
+            Eigen::Vector3d maxPoint = maxPoints[_t];
+            for (std::size_t i = _begin; i < _end; ++i)
+            {
+              const Eigen::Vector3d tfPoint =
+                toAxes * math::eigen3::convert(_vertices[i]) + offset;
+              minPoint = minPoint.cwiseMin(tfPoint);
+              maxPoint = maxPoint.cwiseMax(tfPoint);
+            }
+            minPoints[_t] = minPoint;
+            maxPoints[_t] = maxPoint;
+          });
+
+        for (std::size_t t = 1; t < threads; ++t)
+        {
+          minPoints[0] = minPoints[0].cwiseMin(minPoints[t]);
+          maxPoints[0] = maxPoints[0].cwiseMax(maxPoints[t]);
+        }
+        return orientedBox(axes, centroid, minPoints[0], maxPoints[0]);
+      }
     }
   }
 }
@@ -18,6 +18,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include <gz/math/eigen3/Conversions.hh>
 
 /////////////////////////////////////////////////
@@ -221,3 +223,121 @@ TEST(EigenConversions, ConvertPose3)
     EXPECT_EQ(iPose, iPose2);
   }
 }
+
+/////////////////////////////////////////////////
+/// Check Vector3 views
+TEST(EigenConversions, MapVector3)
+{
+  gz::math::Vector3d v(1, 2, 3);
+  auto view = gz::math::eigen3::map(v);
+  EXPECT_EQ(gz::math::eigen3::convert(v), view);
+  view *= 2;
+  EXPECT_EQ(gz::math::Vector3d(2, 4, 6), v);
+
+  const gz::math::Vector3d &constV = v;
+  EXPECT_EQ(Eigen::Vector3d(2, 4, 6), gz::math::eigen3::map(constV));
+
+  gz::math::Vector3f vf(1, 2, 3);
+  gz::math::eigen3::map(vf).z() = 4;
+  EXPECT_EQ(gz::math::Vector3f(1, 2, 4), vf);
+}
+
+/////////////////////////////////////////////////
+/// Check views of arrays of Vector3
+TEST(EigenConversions, MapVector3Array)
+{
+  std::vector<gz::math::Vector3d> points;
+  for (int i = 0; i < 10; ++i)
+    points.push_back(gz::math::Vector3d(i, -i, 2 * i));
+
+  auto view = gz::math::eigen3::map(points);
+  ASSERT_EQ(3, view.rows());
+  ASSERT_EQ(10, view.cols());
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(gz::math::eigen3::convert(points[i]), view.col(i));
+
+  // Bulk operations in place
+  const gz::math::Quaterniond rot(0.1, 0.2, 0.3);
+  const std::vector<gz::math::Vector3d> original = points;
+  view = gz::math::eigen3::convert(rot).toRotationMatrix() * view;
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(rot * original[i], points[i]);
+
+  const auto &constPoints = original;
+  const Eigen::Vector3d sum =
+    gz::math::eigen3::map(constPoints).rowwise().sum();
+  EXPECT_EQ(Eigen::Vector3d(45, -45, 90), sum);
+
+  // Part of an array
+  auto part = gz::math::eigen3::map(points.data() + 2, 3);
+  EXPECT_EQ(3, part.cols());
+  EXPECT_EQ(gz::math::eigen3::convert(points[4]), part.col(2));
+
+  std::vector<gz::math::Vector3d> empty;
+  EXPECT_EQ(0, gz::math::eigen3::map(empty).cols());
+}
+
+/////////////////////////////////////////////////
+/// Check Matrix3 and Matrix4 views
+TEST(EigenConversions, MapMatrix)
+{
+  gz::math::Matrix3d m3(1, 2, 3, 4, 5, 6, 7, 8, 9);
+  auto view3 = gz::math::eigen3::map(m3);
+  EXPECT_EQ(gz::math::eigen3::convert(m3), view3);
+  view3(0, 2) = 10;
+  EXPECT_DOUBLE_EQ(10, m3(0, 2));
+  view3.transposeInPlace();
+  EXPECT_EQ(gz::math::Matrix3d(1, 4, 7, 2, 5, 8, 10, 6, 9), m3);
+
+  const gz::math::Matrix3d &constM3 = m3;
+  EXPECT_EQ(gz::math::eigen3::convert(m3), gz::math::eigen3::map(constM3));
+
+  gz::math::Matrix4d m4(gz::math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3));
+  const gz::math::Matrix4d &constM4 = m4;
+  auto view4 = gz::math::eigen3::map(constM4);
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+      EXPECT_DOUBLE_EQ(m4(i, j), view4(i, j));
+  }
+
+  // Products match those of gz::math
+  gz::math::Matrix4d product;
+  gz::math::eigen3::map(product) = view4 * view4;
+  EXPECT_EQ(m4 * m4, product);
+}
+
+/////////////////////////////////////////////////
+/// Check MatrixN conversions and views
+TEST(EigenConversions, MatrixN)
+{
+  const gz::math::MatrixN<double, 2, 3> m = {1, 2, 3, 4, 5, 6};
+  const Eigen::Matrix<double, 2, 3> eigen = gz::math::eigen3::convert(m);
+  EXPECT_DOUBLE_EQ(2, eigen(0, 1));
+  EXPECT_DOUBLE_EQ(4, eigen(1, 0));
+  EXPECT_EQ(m, gz::math::eigen3::convert(eigen));
+
+  // Matrix6 conversions are unchanged
+  Eigen::Matrix<double, 6, 6> eigen6 = Eigen::Matrix<double, 6, 6>::Identity();
+  const gz::math::Matrix6d m6 = gz::math::eigen3::convert(eigen6);
+  EXPECT_EQ(gz::math::Matrix6d::Identity, m6);
+
+  gz::math::MatrixN<double, 2, 3> copy = m;
+  auto view = gz::math::eigen3::map(copy);
+  EXPECT_EQ(eigen, view);
+  view(1, 2) = 10;
+  EXPECT_DOUBLE_EQ(10, copy(1, 2));
+
+  gz::math::VectorN<double, 7> v = {1, 2, 3, 4, 5, 6, 7};
+  const gz::math::VectorN<double, 7> &constV = v;
+  EXPECT_DOUBLE_EQ(140, gz::math::eigen3::map(constV).squaredNorm());
+  gz::math::eigen3::map(v) *= 2;
+  EXPECT_DOUBLE_EQ(14, v[6]);
+
+  // Products match those of gz::math
+  const gz::math::MatrixN<double, 3, 2> b = {1, 0, 0, 1, 2, -1};
+  gz::math::MatrixN<double, 2, 2> product;
+  gz::math::eigen3::map(product) =
+      gz::math::eigen3::map(m) * gz::math::eigen3::map(b);
+  EXPECT_EQ(m * b, product);
+}
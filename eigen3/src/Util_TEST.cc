@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gz/math/Rand.hh>
 #include <gz/math/eigen3/Util.hh>
 
 using namespace gz;
@@ -170,3 +175,133 @@ TEST(EigenUtil, covarianceEmptyTest)
   EXPECT_DOUBLE_EQ(covariance(7), 0);
   EXPECT_DOUBLE_EQ(covariance(8), 1);
 }
+
+/////////////////////////////////////////////////
+/// \brief Points in a 4x2x1 box, half of which are sampled densely in a
+/// slab along one of its diagonals.
+std::vector<math::Vector3d> rotatedBoxPoints(const math::Pose3d &_pose)
+{
+  std::vector<math::Vector3d> vertices;
+  for (int i = 0; i < 200000; ++i)
+  {
+    math::Vector3d p(math::Rand::DblUniform(-2, 2),
+                     math::Rand::DblUniform(-1, 1),
+                     math::Rand::DblUniform(-0.5, 0.5));
+    if (i % 2 != 0)
+    {
+      const double t = math::Rand::DblUniform(-1, 1);
+      p.Set(2 * t, t, p.Z());
+    }
+    vertices.push_back(_pose.CoordPositionAdd(p));
+  }
+  return vertices;
+}
+
+/////////////////////////////////////////////////
+TEST(EigenUtil, covarianceThreads)
+{
+  math::Rand::Seed(12345);
+  const auto vertices = rotatedBoxPoints(math::Pose3d(1, 2, 3, 0, 0, 0.3));
+
+  const Eigen::Matrix3d covariance =
+    math::eigen3::covarianceMatrix(vertices);
+  EXPECT_EQ(covariance, math::eigen3::covarianceMatrix(vertices, 1));
+  EXPECT_TRUE(covariance.isApprox(
+    math::eigen3::covarianceMatrix(vertices, 3), 1e-9));
+  EXPECT_TRUE(covariance.isApprox(
+    math::eigen3::covarianceMatrix(vertices, 0), 1e-9));
+
+  std::vector<math::Vector3d> emptyVertices;
+  EXPECT_EQ(Eigen::Matrix3d::Identity(),
+    math::eigen3::covarianceMatrix(emptyVertices, 4));
+}
+
+/////////////////////////////////////////////////
+TEST(EigenUtil, verticesToOrientedBoxVariants)
+{
+  math::Rand::Seed(12345);
+  const math::Pose3d pose(1, 2, 3, 0.2, 0.1, 0.3);
+  const auto vertices = rotatedBoxPoints(pose);
+
+  // Streaming over the same vertices gives the same box
+  const math::OrientedBoxd box =
+    math::eigen3::verticesToOrientedBox(vertices);
+  std::size_t visits = 0;
+  const math::OrientedBoxd streamed = math::eigen3::verticesToOrientedBox(
+    [&](const auto &_function)
+    {
+      for (const auto &vertex : vertices)
+        _function(vertex);
+      ++visits;
+    });
+  EXPECT_EQ(2u, visits);
+  EXPECT_EQ(box, streamed);
+  EXPECT_EQ(box, math::eigen3::verticesToOrientedBox(vertices, 1));
+
+  const math::OrientedBoxd threaded =
+    math::eigen3::verticesToOrientedBox(vertices, 4);
+  EXPECT_TRUE(box.Size().Equal(threaded.Size(), 1e-9));
+  EXPECT_TRUE(box.Pose().Pos().Equal(threaded.Pose().Pos(), 1e-9));
+
+  // The densely sampled slab biases the axes of every vertex, while the
+  // axes from the hull match the box.
+  const math::OrientedBoxd hullBox =
+    math::eigen3::verticesToOrientedBox(vertices, 0, true);
+  const math::Vector3d sorted = [](math::Vector3d _v)
+    {
+      _v.Set(std::min({_v.X(), _v.Y(), _v.Z()}),
+             _v.X() + _v.Y() + _v.Z() - std::min({_v.X(), _v.Y(), _v.Z()}) -
+               std::max({_v.X(), _v.Y(), _v.Z()}),
+             std::max({_v.X(), _v.Y(), _v.Z()}));
+      return _v;
+    }(hullBox.Size());
+  EXPECT_TRUE(math::Vector3d(1, 2, 4).Equal(sorted, 0.01)) << sorted;
+  EXPECT_TRUE(pose.Pos().Equal(hullBox.Pose().Pos(), 0.01));
+  EXPECT_LT(hullBox.Volume(), box.Volume());
+
+  // Every vertex is in both boxes
+  for (std::size_t i = 0; i < vertices.size(); i += 97)
+  {
+    math::OrientedBoxd grown(box.Size() + math::Vector3d(1e-6, 1e-6, 1e-6),
+                             box.Pose());
+    math::OrientedBoxd hullGrown(
+      hullBox.Size() + math::Vector3d(1e-6, 1e-6, 1e-6), hullBox.Pose());
+    EXPECT_TRUE(grown.Contains(vertices[i]));
+    EXPECT_TRUE(hullGrown.Contains(vertices[i]));
+  }
+
+  // No vertices
+  std::vector<math::Vector3d> emptyVertices;
+  EXPECT_EQ(math::OrientedBoxd(),
+    math::eigen3::verticesToOrientedBox(emptyVertices, 0, true));
+  EXPECT_EQ(math::OrientedBoxd(), math::eigen3::verticesToOrientedBox(
+    [](const auto &) {}));
+}
+
+/////////////////////////////////////////////////
+TEST(EigenUtil, extremeVertices)
+{
+  std::vector<math::Vector3d> vertices;
+  EXPECT_TRUE(math::eigen3::extremeVertices(vertices).empty());
+
+  // The corners of a cube, and points inside it
+  for (int i = 0; i < 8; ++i)
+  {
+    vertices.push_back(math::Vector3d(0.1 * i, 0.05 * i, -0.02 * i));
+    vertices.push_back(math::Vector3d(i & 1 ? 1 : -1, i & 2 ? 1 : -1,
+                                      i & 4 ? 1 : -1));
+  }
+
+  const auto hull = math::eigen3::extremeVertices(vertices);
+  ASSERT_EQ(8u, hull.size());
+  for (const auto &v : hull)
+  {
+    EXPECT_DOUBLE_EQ(1.0, std::abs(v.X()));
+    EXPECT_DOUBLE_EQ(1.0, std::abs(v.Y()));
+    EXPECT_DOUBLE_EQ(1.0, std::abs(v.Z()));
+  }
+
+  // A single vertex
+  vertices.resize(1);
+  EXPECT_EQ(vertices, math::eigen3::extremeVertices(vertices, 0));
+}
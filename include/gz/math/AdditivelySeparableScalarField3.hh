@@ -17,9 +17,13 @@
 #ifndef GZ_MATH_SEPARABLE_SCALAR_FIELD3_HH_
 #define GZ_MATH_SEPARABLE_SCALAR_FIELD3_HH_
 
+#include <cmath>
+#include <cstddef>
 #include <limits>
+#include <type_traits>
 #include <utility>
 
+#include <gz/math/Polynomial3.hh>
 #include <gz/math/Region3.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/config.hh>
@@ -83,6 +87,55 @@ namespace ignition
             this->r(_point.Z()));
       }
 
+      /// \brief Evaluate the scalar field at many points. When
+      /// ScalarFunctionT is Polynomial3<ScalarT>, the three polynomials are
+      /// evaluated together with Horner's scheme in a loop the compiler can
+      /// vectorize, so finite results may differ from
+      /// Evaluate(const Vector3<ScalarT> &) by rounding.
+      /// \param[in] _points Array of _count scalar field arguments.
+      /// \param[in] _count Number of points.
+      /// \param[out] _values Array of at least _count values, written with
+      /// the result of evaluating `F(_points[i])`.
+      public: void Evaluate(const Vector3<ScalarT> *_points,
+                            const std::size_t _count,
+                            ScalarT *_values) const
+      {
+        if constexpr (std::is_same_v<ScalarFunctionT, Polynomial3<ScalarT>>)
+        {
+          const Vector4<ScalarT> &cp = this->p.Coeffs();
+          const Vector4<ScalarT> &cq = this->q.Coeffs();
+          const Vector4<ScalarT> &cr = this->r.Coeffs();
+          const ScalarT p0 = cp[0], p1 = cp[1], p2 = cp[2];
+          const ScalarT q0 = cq[0], q1 = cq[1], q2 = cq[2];
+          const ScalarT r0 = cr[0], r1 = cr[1], r2 = cr[2];
+          const ScalarT c = cp[3] + cq[3] + cr[3];
+          for (std::size_t i = 0; i < _count; ++i)
+          {
+            const ScalarT x = _points[i].X();
+            const ScalarT y = _points[i].Y();
+            const ScalarT z = _points[i].Z();
+            _values[i] = this->k * (
+                ((p0 * x + p1) * x + p2) * x +
+                ((q0 * y + q1) * y + q2) * y +
+                ((r0 * z + r1) * z + r2) * z + c);
+          }
+
+          // Non-finite points give non-finite values above, fix them up in
+          // a separate pass which keeps the loop above free of branches
+          using std::isfinite;
+          for (std::size_t i = 0; i < _count; ++i)
+          {
+            if (!isfinite(_values[i]))
+              _values[i] = this->Evaluate(_points[i]);
+          }
+        }
+        else
+        {
+          for (std::size_t i = 0; i < _count; ++i)
+            _values[i] = this->Evaluate(_points[i]);
+        }
+      }
+
       /// \brief Call operator overload
       /// \see SeparableScalarField3::Evaluate()
       /// \param[in] _point scalar field argument
@@ -17,6 +17,7 @@
 #ifndef GZ_MATH_ANGLE_HH_
 #define GZ_MATH_ANGLE_HH_
 
+#include <cstddef>
 #include <iostream>
 #include <gz/math/Helpers.hh>
 #include <gz/math/config.hh>
@@ -148,6 +149,39 @@ namespace ignition
       /// \return The normalized value of this Angle.
       public: Angle Normalized() const;
 
+      /// \brief Normalize an array of angles in the range -Pi to Pi, as
+      /// Normalize does for one angle. The angles are reduced by a multiple
+      /// of 2 Pi rather than with trigonometric functions, so the loop
+      /// vectorizes, and the results match Normalize to within rounding.
+      /// \param[in] _in Angles in radians.
+      /// \param[in] _count Number of angles.
+      /// \param[out] _out Normalized angles, which may be _in.
+      public: static void Normalize(const double *_in,
+                                    const std::size_t _count,
+                                    double *_out);
+
+      /// \brief Unwrap a sequence of angles, such as a heading log, into a
+      /// continuous track: multiples of 2 Pi are added so that consecutive
+      /// angles differ by at most Pi. The first angle is kept.
+      /// \param[in] _in Angles in radians.
+      /// \param[in] _count Number of angles.
+      /// \param[out] _out Unwrapped angles, which may be _in.
+      public: static void Unwrap(const double *_in,
+                                 const std::size_t _count,
+                                 double *_out);
+
+      /// \brief Unwrap the next part of a sequence of angles, continuing
+      /// the track which ended at _previous. This lets long sequences be
+      /// unwrapped a part at a time.
+      /// \param[in] _in Angles in radians.
+      /// \param[in] _count Number of angles.
+      /// \param[in] _previous Last unwrapped angle of the track.
+      /// \param[out] _out Unwrapped angles, which may be _in.
+      public: static void Unwrap(const double *_in,
+                                 const std::size_t _count,
+                                 const double _previous,
+                                 double *_out);
+
       /// \brief Return the angle's radian value
       /// \return double containing the angle's radian value
       public: double operator()() const;
@@ -17,6 +17,7 @@
 #ifndef GZ_MATH_AXISALIGNEDBOX_HH_
 #define GZ_MATH_AXISALIGNEDBOX_HH_
 
+#include <cstddef>
 #include <iostream>
 #include <tuple>
 #include <gz/math/config.hh>
@@ -70,6 +71,11 @@ namespace ignition
       /// \param[in]  _b AxisAlignedBox to copy
       public: AxisAlignedBox(const AxisAlignedBox &_b);
 
+      /// \brief Move constructor. It doesn't allocate memory. The moved
+      /// from box can only be assigned to or destroyed.
+      /// \param[in] _b AxisAlignedBox to move
+      public: AxisAlignedBox(AxisAlignedBox &&_b) noexcept;
+
       /// \brief Destructor
       public: virtual ~AxisAlignedBox();
 
@@ -97,11 +103,46 @@ namespace ignition
       /// \param[in]  _box AxisAlignedBox to add to this box
       public: void Merge(const AxisAlignedBox &_box);
 
+      /// \brief Get the bounds of an array of points, the same as merging
+      /// a box around each point into a default box, without going
+      /// through a box per point. The reduction uses SSE2 or AVX min/max,
+      /// as allowed by ActiveSimdLevel(), and splits large arrays between
+      /// threads. As with Vector3::Min and Vector3::Max, NaN components
+      /// are ignored and infinite components are kept.
+      /// \param[in] _points The points.
+      /// \param[in] _count Number of points.
+      /// \param[in] _threads Number of threads. A value of 0 uses the
+      /// number of hardware threads. Small arrays always use a single
+      /// thread.
+      /// \return The bounds, or a default box if there are no points.
+      public: static AxisAlignedBox FromPoints(const Vector3d *_points,
+                                               const std::size_t _count,
+                                               const unsigned int _threads = 1);
+
+      /// \brief Get the bounds of an array of boxes, the same as merging
+      /// them into a default box. Empty boxes, such as default boxes, are
+      /// left out.
+      /// \param[in] _boxes The boxes.
+      /// \param[in] _count Number of boxes.
+      /// \param[in] _threads Number of threads. A value of 0 uses the
+      /// number of hardware threads. Small arrays always use a single
+      /// thread.
+      /// \return The bounds, or a default box if there are no boxes.
+      public: static AxisAlignedBox FromBoxes(const AxisAlignedBox *_boxes,
+                                              const std::size_t _count,
+                                              const unsigned int _threads = 1);
+
       /// \brief Assignment operator. Set this box to the parameter
       /// \param[in]  _b AxisAlignedBox to copy
       /// \return The new box.
       public: AxisAlignedBox &operator=(const AxisAlignedBox &_b);
 
+      /// \brief Move assignment operator. It doesn't allocate memory, and
+      /// swaps the corners of the boxes.
+      /// \param[in] _b AxisAlignedBox to move
+      /// \return The new box.
+      public: AxisAlignedBox &operator=(AxisAlignedBox &&_b) noexcept;
+
       /// \brief Addition operator. result = this + _b
       /// \param[in] _b AxisAlignedBox to add
       /// \return The new box
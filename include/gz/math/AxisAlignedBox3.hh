@@ -0,0 +1,483 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_AXISALIGNEDBOX3_HH_
+#define GZ_MATH_AXISALIGNEDBOX3_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <tuple>
+
+#include <gz/math/config.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Line3.hh>
+#include <gz/math/Vector3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class AxisAlignedBox3 AxisAlignedBox3.hh
+    /// ignition/math/AxisAlignedBox3.hh
+    /// \brief A header-only, value type counterpart of AxisAlignedBox.
+    ///
+    /// The corners are stored inline as plain arrays, so the class is
+    /// trivially copyable, never allocates, and its scalar operations can
+    /// be evaluated at compile time. This makes it suitable for large
+    /// arrays of boxes, such as the ones handled by a broadphase, where the
+    /// heap allocated private data of AxisAlignedBox dominates the cost.
+    ///
+    /// The semantics match AxisAlignedBox: a default constructed box is
+    /// empty, with its minimum corner at the largest value of T and its
+    /// maximum corner at the lowest value of T, so that merging it with
+    /// another box yields the other box.
+    template<typename T>
+    class AxisAlignedBox3
+    {
+      /// \brief Default constructor. This constructor will set the box's
+      /// minimum corner to the largest value of T and the maximum corner to
+      /// the lowest value of T, yielding an empty box.
+      public: constexpr AxisAlignedBox3() = default;
+
+      /// \brief Constructor. This constructor will compute the box's
+      /// minimum and maximum corners based on the two arguments.
+      /// \param[in] _vec1X One corner's X position
+      /// \param[in] _vec1Y One corner's Y position
+      /// \param[in] _vec1Z One corner's Z position
+      /// \param[in] _vec2X Other corner's X position
+      /// \param[in] _vec2Y Other corner's Y position
+      /// \param[in] _vec2Z Other corner's Z position
+      public: constexpr AxisAlignedBox3(T _vec1X, T _vec1Y, T _vec1Z,
+                                        T _vec2X, T _vec2Y, T _vec2Z)
+      : minCorner{std::min(_vec1X, _vec2X), std::min(_vec1Y, _vec2Y),
+                  std::min(_vec1Z, _vec2Z)},
+        maxCorner{std::max(_vec1X, _vec2X), std::max(_vec1Y, _vec2Y),
+                  std::max(_vec1Z, _vec2Z)}
+      {
+      }
+
+      /// \brief Constructor. This constructor will compute the box's
+      /// minimum and maximum corners based on the two arguments.
+      /// \param[in] _vec1 One corner of the box
+      /// \param[in] _vec2 Another corner of the box
+      public: AxisAlignedBox3(const Vector3<T> &_vec1,
+                              const Vector3<T> &_vec2)
+      : AxisAlignedBox3(_vec1.X(), _vec1.Y(), _vec1.Z(),
+                        _vec2.X(), _vec2.Y(), _vec2.Z())
+      {
+      }
+
+      /// \brief Conversion constructor from an AxisAlignedBox.
+      /// \param[in] _box Box to convert. An empty box stays empty.
+      public: explicit AxisAlignedBox3(const AxisAlignedBox &_box)
+      {
+        if (_box.Min().X() > _box.Max().X() ||
+            _box.Min().Y() > _box.Max().Y() ||
+            _box.Min().Z() > _box.Max().Z())
+        {
+          return;
+        }
+
+        this->SetMin(Vector3<T>(static_cast<T>(_box.Min().X()),
+                                static_cast<T>(_box.Min().Y()),
+                                static_cast<T>(_box.Min().Z())));
+        this->SetMax(Vector3<T>(static_cast<T>(_box.Max().X()),
+                                static_cast<T>(_box.Max().Y()),
+                                static_cast<T>(_box.Max().Z())));
+      }
+
+      /// \brief Convert to an AxisAlignedBox.
+      /// \return The equivalent AxisAlignedBox. An empty box is converted
+      /// to a default constructed AxisAlignedBox.
+      public: AxisAlignedBox ToAxisAlignedBox() const
+      {
+        if (this->Empty())
+          return AxisAlignedBox();
+
+        AxisAlignedBox box;
+        box.Min().Set(this->minCorner[0], this->minCorner[1],
+                      this->minCorner[2]);
+        box.Max().Set(this->maxCorner[0], this->maxCorner[1],
+                      this->maxCorner[2]);
+        return box;
+      }
+
+      /// \brief Get the length along the x dimension
+      /// \return Double value of the length in the x dimension
+      public: constexpr T XLength() const
+      {
+        return std::max(T(0), this->maxCorner[0] - this->minCorner[0]);
+      }
+
+      /// \brief Get the length along the y dimension
+      /// \return Double value of the length in the y dimension
+      public: constexpr T YLength() const
+      {
+        return std::max(T(0), this->maxCorner[1] - this->minCorner[1]);
+      }
+
+      /// \brief Get the length along the z dimension
+      /// \return Double value of the length in the z dimension
+      public: constexpr T ZLength() const
+      {
+        return std::max(T(0), this->maxCorner[2] - this->minCorner[2]);
+      }
+
+      /// \brief Get the size of the box
+      /// \return Size of the box
+      public: Vector3<T> Size() const
+      {
+        return Vector3<T>(this->XLength(), this->YLength(), this->ZLength());
+      }
+
+      /// \brief Get the box center
+      /// \return The center position of the box
+      public: Vector3<T> Center() const
+      {
+        return Vector3<T>(
+          T(0.5) * this->minCorner[0] + T(0.5) * this->maxCorner[0],
+          T(0.5) * this->minCorner[1] + T(0.5) * this->maxCorner[1],
+          T(0.5) * this->minCorner[2] + T(0.5) * this->maxCorner[2]);
+      }
+
+      /// \brief Get the volume of the box in m^3.
+      /// \return Volume of the box in m^3.
+      public: constexpr T Volume() const
+      {
+        return this->XLength() * this->YLength() * this->ZLength();
+      }
+
+      /// \brief Get whether the box is empty, which is the case when its
+      /// minimum corner is greater than its maximum corner along any axis.
+      /// \return True if the box is empty.
+      public: constexpr bool Empty() const
+      {
+        return this->minCorner[0] > this->maxCorner[0] ||
+               this->minCorner[1] > this->maxCorner[1] ||
+               this->minCorner[2] > this->maxCorner[2];
+      }
+
+      /// \brief Merge a box with this box
+      /// \param[in]  _box Bounding box to merge with this box
+      public: constexpr void Merge(const AxisAlignedBox3<T> &_box)
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          this->minCorner[i] = std::min(this->minCorner[i], _box.minCorner[i]);
+          this->maxCorner[i] = std::max(this->maxCorner[i], _box.maxCorner[i]);
+        }
+      }
+
+      /// \brief Expand the box so that it contains a point.
+      /// \param[in] _p Point to include in the box
+      public: void Merge(const Vector3<T> &_p)
+      {
+        this->Merge(AxisAlignedBox3<T>(_p.X(), _p.Y(), _p.Z(),
+                                       _p.X(), _p.Y(), _p.Z()));
+      }
+
+      /// \brief Get the intersection of this box with another box.
+      /// \param[in] _box The other box
+      /// \return The common part of both boxes, which is empty when they
+      /// don't intersect.
+      public: constexpr AxisAlignedBox3<T> Intersection(
+                  const AxisAlignedBox3<T> &_box) const
+      {
+        AxisAlignedBox3<T> result;
+        for (int i = 0; i < 3; ++i)
+        {
+          result.minCorner[i] = std::max(this->minCorner[i],
+                                         _box.minCorner[i]);
+          result.maxCorner[i] = std::min(this->maxCorner[i],
+                                         _box.maxCorner[i]);
+        }
+        return result;
+      }
+
+      /// \brief Addition operator. result = this + _b
+      /// \param[in] _b Box to add
+      /// \return The new box
+      public: constexpr AxisAlignedBox3<T> operator+(
+                  const AxisAlignedBox3<T> &_b) const
+      {
+        AxisAlignedBox3<T> result(*this);
+        result.Merge(_b);
+        return result;
+      }
+
+      /// \brief Addition set operator. this = this + _b
+      /// \param[in] _b Box to add
+      /// \return This new box
+      public: constexpr const AxisAlignedBox3<T> &operator+=(
+                  const AxisAlignedBox3<T> &_b)
+      {
+        this->Merge(_b);
+        return *this;
+      }
+
+      /// \brief Equality test operator. The corners are compared with the
+      /// same tolerance as Vector3::operator==.
+      /// \param[in] _b Box to test
+      /// \return True if equal
+      public: constexpr bool operator==(const AxisAlignedBox3<T> &_b) const
+      {
+        const T tol = static_cast<T>(1e-3);
+        for (int i = 0; i < 3; ++i)
+        {
+          const T dMin = this->minCorner[i] - _b.minCorner[i];
+          const T dMax = this->maxCorner[i] - _b.maxCorner[i];
+          if (!(dMin <= tol && -dMin <= tol && dMax <= tol && -dMax <= tol))
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Inequality test operator
+      /// \param[in] _b Box to test
+      /// \return True if not equal
+      public: constexpr bool operator!=(const AxisAlignedBox3<T> &_b) const
+      {
+        return !(*this == _b);
+      }
+
+      /// \brief Subtract a vector from the min and max values
+      /// \param[in] _v The vector to use during subtraction
+      /// \return The new box
+      public: AxisAlignedBox3<T> operator-(const Vector3<T> &_v) const
+      {
+        return AxisAlignedBox3<T>(this->Min() - _v, this->Max() - _v);
+      }
+
+      /// \brief Add a vector to the min and max values
+      /// \param[in] _v The vector to use during addition
+      /// \return The new box
+      public: AxisAlignedBox3<T> operator+(const Vector3<T> &_v) const
+      {
+        return AxisAlignedBox3<T>(this->Min() + _v, this->Max() + _v);
+      }
+
+      /// \brief Output operator
+      /// \param[in] _out Output stream
+      /// \param[in] _b Box to output to the stream
+      /// \return The stream
+      public: friend std::ostream &operator<<(std::ostream &_out,
+                  const AxisAlignedBox3<T> &_b)
+      {
+        return _out << "Min[" << _b.Min() << "] Max[" << _b.Max() << "]";
+      }
+
+      /// \brief Get the minimum corner.
+      /// \return The Vector3 that is the minimum corner of the box.
+      public: Vector3<T> Min() const
+      {
+        return Vector3<T>(this->minCorner[0], this->minCorner[1],
+                          this->minCorner[2]);
+      }
+
+      /// \brief Get the maximum corner.
+      /// \return The Vector3 that is the maximum corner of the box.
+      public: Vector3<T> Max() const
+      {
+        return Vector3<T>(this->maxCorner[0], this->maxCorner[1],
+                          this->maxCorner[2]);
+      }
+
+      /// \brief Set the minimum corner. The corners are not reordered, so
+      /// setting a minimum corner greater than the maximum corner yields an
+      /// empty box.
+      /// \param[in] _min The minimum corner of the box.
+      public: void SetMin(const Vector3<T> &_min)
+      {
+        this->minCorner[0] = _min.X();
+        this->minCorner[1] = _min.Y();
+        this->minCorner[2] = _min.Z();
+      }
+
+      /// \brief Set the maximum corner. The corners are not reordered, so
+      /// setting a maximum corner less than the minimum corner yields an
+      /// empty box.
+      /// \param[in] _max The maximum corner of the box.
+      public: void SetMax(const Vector3<T> &_max)
+      {
+        this->maxCorner[0] = _max.X();
+        this->maxCorner[1] = _max.Y();
+        this->maxCorner[2] = _max.Z();
+      }
+
+      /// \brief Test box intersection. This test will only work if
+      /// both box's minimum corner is less than or equal to their
+      /// maximum corner.
+      /// \param[in] _box AxisAlignedBox3 to check for intersection with
+      /// this box.
+      /// \return True if this box intersects _box.
+      public: constexpr bool Intersects(const AxisAlignedBox3<T> &_box) const
+      {
+        // Check the six separating planes.
+        for (int i = 0; i < 3; ++i)
+        {
+          if (this->maxCorner[i] < _box.minCorner[i] ||
+              this->minCorner[i] > _box.maxCorner[i])
+          {
+            return false;
+          }
+        }
+
+        // Otherwise the two boxes must intersect.
+        return true;
+      }
+
+      /// \brief Check if a point lies inside the box.
+      /// \param[in] _p Point to check.
+      /// \return True if the point is inside the box.
+      public: bool Contains(const Vector3<T> &_p) const
+      {
+        return _p.X() >= this->minCorner[0] && _p.X() <= this->maxCorner[0] &&
+               _p.Y() >= this->minCorner[1] && _p.Y() <= this->maxCorner[1] &&
+               _p.Z() >= this->minCorner[2] && _p.Z() <= this->maxCorner[2];
+      }
+
+      /// \brief Check if a ray (origin, direction) intersects the box.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return True if the ray intersects the box.
+      public: bool IntersectCheck(const Vector3<T> &_origin,
+                  const Vector3<T> &_dir, const T _min, const T _max) const
+      {
+        return std::get<0>(this->Intersect(_origin, _dir, _min, _max));
+      }
+
+      /// \brief Check if a ray (origin, direction) intersects the box.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return A boolean and T tuple. The boolean value is true
+      /// if the line intersects the box. The T is the distance from
+      /// the ray's start to the closest intersection point on the box,
+      /// minus the _min distance.
+      public: std::tuple<bool, T> IntersectDist(const Vector3<T> &_origin,
+                  const Vector3<T> &_dir, const T _min, const T _max) const
+      {
+        auto result = this->Intersect(_origin, _dir, _min, _max);
+        return std::make_tuple(std::get<0>(result), std::get<1>(result));
+      }
+
+      /// \brief Check if a ray (origin, direction) intersects the box.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return A boolean, T, Vector3 tuple. The boolean value is true
+      /// if the line intersects the box. The T is the distance from the
+      /// ray's start to the closest intersection point on the box, minus
+      /// the _min distance. The Vector3 is the intersection point.
+      public: std::tuple<bool, T, Vector3<T>> Intersect(
+                  const Vector3<T> &_origin, const Vector3<T> &_dir,
+                  const T _min, const T _max) const
+      {
+        Vector3<T> dir = _dir;
+        dir.Normalize();
+        return this->Intersect(
+            Line3<T>(_origin + dir * _min, _origin + dir * _max));
+      }
+
+      /// \brief Check if a line intersects the box.
+      /// \param[in] _line The line to check against this box.
+      /// \return A boolean, T, Vector3 tuple. The boolean value is true
+      /// if the line intersects the box. The T is the distance from the
+      /// line's start to the closest intersection point. The Vector3 is
+      /// the intersection point.
+      public: std::tuple<bool, T, Vector3<T>> Intersect(
+                  const Line3<T> &_line) const
+      {
+        // low and high are the results from all clipping so far.
+        T low = 0;
+        T high = 1;
+
+        const Vector3<T> start = _line[0];
+        const Vector3<T> delta = _line[1] - _line[0];
+        const T starts[3] = {start.X(), start.Y(), start.Z()};
+        const T deltas[3] = {delta.X(), delta.Y(), delta.Z()};
+        for (int i = 0; i < 3; ++i)
+        {
+          if (!this->ClipLine(i, starts[i], deltas[i], low, high))
+            return std::make_tuple(false, T(0), Vector3<T>::Zero);
+        }
+
+        Vector3<T> intersection = start + delta * low;
+        return std::make_tuple(true, start.Distance(intersection),
+                               intersection);
+      }
+
+      /// \brief Clip a line by a dimension of the box, in the same way as
+      /// AxisAlignedBox does.
+      /// \param[in] _d Dimension of the box (0, 1 or 2).
+      /// \param[in] _start Coordinate of the line's start along _d.
+      /// \param[in] _delta Length of the line along _d.
+      /// \param[in,out] _low Close distance, as a fraction of the line.
+      /// \param[in,out] _high Far distance, as a fraction of the line.
+      /// \return True if the line still intersects the box.
+      private: bool ClipLine(const int _d, const T _start, const T _delta,
+                             T &_low, T &_high) const
+      {
+        T dimLow = (this->minCorner[_d] - _start) / _delta;
+        T dimHigh = (this->maxCorner[_d] - _start) / _delta;
+
+        if (dimHigh < dimLow)
+          std::swap(dimHigh, dimLow);
+
+        if (dimHigh < _low)
+          return false;
+
+        if (dimLow > _high)
+          return false;
+
+        if (std::isfinite(dimLow))
+          _low = std::max(dimLow, _low);
+
+        if (std::isfinite(dimHigh))
+          _high = std::min(dimHigh, _high);
+
+        return true;
+      }
+
+      /// \brief Minimum corner of the box
+      private: T minCorner[3] = {std::numeric_limits<T>::max(),
+                                 std::numeric_limits<T>::max(),
+                                 std::numeric_limits<T>::max()};
+
+      /// \brief Maximum corner of the box
+      private: T maxCorner[3] = {std::numeric_limits<T>::lowest(),
+                                 std::numeric_limits<T>::lowest(),
+                                 std::numeric_limits<T>::lowest()};
+    };
+
+    /// typedef AxisAlignedBox3<double> as AxisAlignedBox3d.
+    using AxisAlignedBox3d = AxisAlignedBox3<double>;
+
+    /// typedef AxisAlignedBox3<float> as AxisAlignedBox3f.
+    using AxisAlignedBox3f = AxisAlignedBox3<float>;
+    }
+  }
+}
+#endif
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_BASICSTOPWATCH_HH_
+#define GZ_MATH_BASICSTOPWATCH_HH_
+
+#include <chrono>
+
+#include <gz/math/TscClock.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class BasicStopwatch BasicStopwatch.hh
+    /// ignition/math/BasicStopwatch.hh
+    /// \brief A header-only Stopwatch templated on its clock. It keeps its
+    /// state inline instead of behind a private data pointer, so it is
+    /// cheap to construct and copy, and Start() and Stop() read the clock
+    /// once and can be inlined. With TscClock, a Start() and Stop() pair
+    /// takes a few nanoseconds, which suits timing the phases of a fast
+    /// control loop without perturbing it.
+    ///
+    /// The behavior is the same as Stopwatch.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::TscClock::Calibrate();
+    /// gz::math::TscStopwatch watch;
+    /// watch.Start();
+    ///
+    /// // do something...
+    ///
+    /// watch.Stop();
+    /// std::cout << "Elapsed time is "
+    ///   << std::chrono::duration_cast<std::chrono::microseconds>(
+    ///     watch.ElapsedRunTime()).count() << " us\n";
+    /// ```
+    ///
+    /// \tparam Clock A type meeting the standard Clock named requirement,
+    /// such as std::chrono::steady_clock or TscClock.
+    template<typename Clock = std::chrono::steady_clock>
+    class BasicStopwatch
+    {
+      /// \brief Clock used to measure time.
+      public: using clock = Clock;
+
+      /// \brief Get whether the stopwatch is running.
+      /// \return True if the stopwatch is running.
+      public: bool Running() const
+      {
+        return this->running;
+      }
+
+      /// \brief Start the stopwatch.
+      /// \param[in] _reset If true the stopwatch is reset first.
+      /// \return True if the the stopwatch was started. This will return
+      /// false if the stopwatch was already running.
+      public: bool Start(const bool _reset = false)
+      {
+        if (_reset)
+          this->Reset();
+
+        if (this->running)
+          return false;
+
+        const typename Clock::time_point now = Clock::now();
+        if (this->startTime != this->stopTime)
+          this->stopDuration += now - this->stopTime;
+
+        this->running = true;
+        this->startTime = now;
+        return true;
+      }
+
+      /// \brief Get the time when the stopwatch was started.
+      /// \return The time when stopwatch was started, or
+      /// Clock::time_point::min() if the stopwatch has not been started.
+      public: typename Clock::time_point StartTime() const
+      {
+        return this->startTime;
+      }
+
+      /// \brief Stop the stopwatch
+      /// \return True if the stopwatch was stopped. This will return false
+      /// if the stopwatch is not running.
+      public: bool Stop()
+      {
+        if (!this->running)
+          return false;
+
+        this->running = false;
+        this->stopTime = Clock::now();
+        this->runDuration += this->stopTime - this->startTime;
+        return true;
+      }
+
+      /// \brief Get the time when the stopwatch was last stopped.
+      /// \return The time when stopwatch was last stopped, or
+      /// Clock::time_point::min() if the stopwatch has never been stopped.
+      public: typename Clock::time_point StopTime() const
+      {
+        return this->stopTime;
+      }
+
+      /// \brief Reset the stopwatch. This resets the start time, stop time,
+      /// elapsed duration and elapsed stop duration.
+      public: void Reset()
+      {
+        *this = BasicStopwatch();
+      }
+
+      /// \brief Get the amount of time that the stop watch has been
+      /// running, spanning all start and stop calls since the last reset.
+      /// \return Total amount of elapsed run time.
+      public: typename Clock::duration ElapsedRunTime() const
+      {
+        if (this->running)
+          return Clock::now() - this->startTime + this->runDuration;
+        return this->runDuration;
+      }
+
+      /// \brief Get the amount of time that the stop watch has been
+      /// stopped, spanning all start and stop calls since the last reset.
+      /// \return Total amount of elapsed stop time.
+      public: typename Clock::duration ElapsedStopTime() const
+      {
+        if (this->running)
+          return this->stopDuration;
+
+        // The clock is not running, and Stop() has been called.
+        if (this->stopTime > Clock::time_point::min())
+          return this->stopDuration + (Clock::now() - this->stopTime);
+
+        // Otherwise, the stopwatch has been reset or never started.
+        return Clock::duration::zero();
+      }
+
+      /// \brief Equality operator.
+      /// \param[in] _watch The watch to compare.
+      /// \return True if this watch equals the provided watch.
+      public: bool operator==(const BasicStopwatch &_watch) const
+      {
+        return this->running == _watch.running &&
+          this->startTime == _watch.startTime &&
+          this->stopTime == _watch.stopTime &&
+          this->stopDuration == _watch.stopDuration &&
+          this->runDuration == _watch.runDuration;
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _watch The watch to compare.
+      /// \return True if this watch does not equal the provided watch.
+      public: bool operator!=(const BasicStopwatch &_watch) const
+      {
+        return !(*this == _watch);
+      }
+
+      /// \brief True if the stopwatch is running.
+      private: bool running = false;
+
+      /// \brief Time of the last start.
+      private: typename Clock::time_point startTime =
+                 Clock::time_point::min();
+
+      /// \brief Time of the last stop.
+      private: typename Clock::time_point stopTime =
+                 Clock::time_point::min();
+
+      /// \brief Amount of stop time.
+      private: typename Clock::duration stopDuration =
+                 Clock::duration::zero();
+
+      /// \brief Amount of run time.
+      private: typename Clock::duration runDuration =
+                 Clock::duration::zero();
+    };
+
+    /// \brief Stopwatch reading the CPU time stamp counter.
+    using TscStopwatch = BasicStopwatch<TscClock>;
+    }
+  }
+}
+#endif
@@ -0,0 +1,736 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_BINARYCODEC_HH_
+#define GZ_MATH_BINARYCODEC_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/AxisAlignedBox3.hh>
+#include <gz/math/Diagnostics.hh>
+#include <gz/math/MassMatrix3.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/Vector4.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Unsigned integer with the size of a scalar, used to
+      /// reorder its bytes.
+      template<std::size_t N> struct BinaryWord;
+      template<> struct BinaryWord<1> { using Type = uint8_t; };
+      template<> struct BinaryWord<2> { using Type = uint16_t; };
+      template<> struct BinaryWord<4> { using Type = uint32_t; };
+      template<> struct BinaryWord<8> { using Type = uint64_t; };
+
+      /// \brief True for the scalars the codec can encode: integers other
+      /// than bool, float and double.
+      template<typename T>
+      constexpr bool isBinaryScalar =
+        std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+        (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+         sizeof(T) == 8);
+
+      /// \brief Encoding of a type: its size in bytes, and functions that
+      /// store and load it. Only the specializations are defined.
+      template<typename T, typename Enable = void>
+      struct BinaryCodec;
+
+      /// \brief Scalars are stored little endian. Floating point values
+      /// keep their IEEE 754 bits.
+      template<typename T>
+      struct BinaryCodec<T, std::enable_if_t<isBinaryScalar<T>>>
+      {
+        static constexpr std::size_t kSize = sizeof(T);
+
+        static void Store(const T &_v, uint8_t *_out)
+        {
+          typename BinaryWord<sizeof(T)>::Type u;
+          std::memcpy(&u, &_v, sizeof(T));
+          for (std::size_t i = 0; i < sizeof(T); ++i)
+            _out[i] = static_cast<uint8_t>(u >> (8 * i));
+        }
+
+        static void Load(const uint8_t *_in, T &_v)
+        {
+          typename BinaryWord<sizeof(T)>::Type u = 0;
+          for (std::size_t i = 0; i < sizeof(T); ++i)
+          {
+            u = static_cast<decltype(u)>(
+                u | static_cast<decltype(u)>(_in[i]) << (8 * i));
+          }
+          std::memcpy(&_v, &u, sizeof(T));
+        }
+      };
+
+      /// \brief Vector2 as x, y.
+      template<typename T>
+      struct BinaryCodec<Vector2<T>>
+      {
+        static constexpr std::size_t kSize = 2 * sizeof(T);
+
+        static void Store(const Vector2<T> &_v, uint8_t *_out)
+        {
+          BinaryCodec<T>::Store(_v.X(), _out);
+          BinaryCodec<T>::Store(_v.Y(), _out + sizeof(T));
+        }
+
+        static void Load(const uint8_t *_in, Vector2<T> &_v)
+        {
+          T x, y;
+          BinaryCodec<T>::Load(_in, x);
+          BinaryCodec<T>::Load(_in + sizeof(T), y);
+          _v.Set(x, y);
+        }
+      };
+
+      /// \brief Vector3 as x, y, z.
+      template<typename T>
+      struct BinaryCodec<Vector3<T>>
+      {
+        static constexpr std::size_t kSize = 3 * sizeof(T);
+
+        static void Store(const Vector3<T> &_v, uint8_t *_out)
+        {
+          BinaryCodec<T>::Store(_v.X(), _out);
+          BinaryCodec<T>::Store(_v.Y(), _out + sizeof(T));
+          BinaryCodec<T>::Store(_v.Z(), _out + 2 * sizeof(T));
+        }
+
+        static void Load(const uint8_t *_in, Vector3<T> &_v)
+        {
+          T x, y, z;
+          BinaryCodec<T>::Load(_in, x);
+          BinaryCodec<T>::Load(_in + sizeof(T), y);
+          BinaryCodec<T>::Load(_in + 2 * sizeof(T), z);
+          _v.Set(x, y, z);
+        }
+      };
+
+      /// \brief Vector4 as x, y, z, w.
+      template<typename T>
+      struct BinaryCodec<Vector4<T>>
+      {
+        static constexpr std::size_t kSize = 4 * sizeof(T);
+
+        static void Store(const Vector4<T> &_v, uint8_t *_out)
+        {
+          BinaryCodec<T>::Store(_v.X(), _out);
+          BinaryCodec<T>::Store(_v.Y(), _out + sizeof(T));
+          BinaryCodec<T>::Store(_v.Z(), _out + 2 * sizeof(T));
+          BinaryCodec<T>::Store(_v.W(), _out + 3 * sizeof(T));
+        }
+
+        static void Load(const uint8_t *_in, Vector4<T> &_v)
+        {
+          T x, y, z, w;
+          BinaryCodec<T>::Load(_in, x);
+          BinaryCodec<T>::Load(_in + sizeof(T), y);
+          BinaryCodec<T>::Load(_in + 2 * sizeof(T), z);
+          BinaryCodec<T>::Load(_in + 3 * sizeof(T), w);
+          _v.Set(x, y, z, w);
+        }
+      };
+
+      /// \brief Quaternion as w, x, y, z, stored as is without
+      /// normalization.
+      template<typename T>
+      struct BinaryCodec<Quaternion<T>>
+      {
+        static constexpr std::size_t kSize = 4 * sizeof(T);
+
+        static void Store(const Quaternion<T> &_q, uint8_t *_out)
+        {
+          BinaryCodec<T>::Store(_q.W(), _out);
+          BinaryCodec<T>::Store(_q.X(), _out + sizeof(T));
+          BinaryCodec<T>::Store(_q.Y(), _out + 2 * sizeof(T));
+          BinaryCodec<T>::Store(_q.Z(), _out + 3 * sizeof(T));
+        }
+
+        static void Load(const uint8_t *_in, Quaternion<T> &_q)
+        {
+          T w, x, y, z;
+          BinaryCodec<T>::Load(_in, w);
+          BinaryCodec<T>::Load(_in + sizeof(T), x);
+          BinaryCodec<T>::Load(_in + 2 * sizeof(T), y);
+          BinaryCodec<T>::Load(_in + 3 * sizeof(T), z);
+          _q.Set(w, x, y, z);
+        }
+      };
+
+      /// \brief Pose3 as the position followed by the rotation.
+      template<typename T>
+      struct BinaryCodec<Pose3<T>>
+      {
+        static constexpr std::size_t kSize =
+          BinaryCodec<Vector3<T>>::kSize + BinaryCodec<Quaternion<T>>::kSize;
+
+        static void Store(const Pose3<T> &_p, uint8_t *_out)
+        {
+          BinaryCodec<Vector3<T>>::Store(_p.Pos(), _out);
+          BinaryCodec<Quaternion<T>>::Store(_p.Rot(),
+              _out + BinaryCodec<Vector3<T>>::kSize);
+        }
+
+        static void Load(const uint8_t *_in, Pose3<T> &_p)
+        {
+          Vector3<T> pos;
+          Quaternion<T> rot;
+          BinaryCodec<Vector3<T>>::Load(_in, pos);
+          BinaryCodec<Quaternion<T>>::Load(
+              _in + BinaryCodec<Vector3<T>>::kSize, rot);
+          _p.Set(pos, rot);
+        }
+      };
+
+      /// \brief AxisAlignedBox as the minimum corner followed by the
+      /// maximum corner. Empty boxes round trip unchanged.
+      template<>
+      struct BinaryCodec<AxisAlignedBox>
+      {
+        static constexpr std::size_t kSize = 2 * BinaryCodec<Vector3d>::kSize;
+
+        static void Store(const AxisAlignedBox &_b, uint8_t *_out)
+        {
+          BinaryCodec<Vector3d>::Store(_b.Min(), _out);
+          BinaryCodec<Vector3d>::Store(_b.Max(),
+              _out + BinaryCodec<Vector3d>::kSize);
+        }
+
+        static void Load(const uint8_t *_in, AxisAlignedBox &_b)
+        {
+          BinaryCodec<Vector3d>::Load(_in, _b.Min());
+          BinaryCodec<Vector3d>::Load(_in + BinaryCodec<Vector3d>::kSize,
+              _b.Max());
+        }
+      };
+
+      /// \brief AxisAlignedBox3 as the minimum corner followed by the
+      /// maximum corner. Empty boxes round trip unchanged.
+      template<typename T>
+      struct BinaryCodec<AxisAlignedBox3<T>>
+      {
+        static constexpr std::size_t kSize =
+          2 * BinaryCodec<Vector3<T>>::kSize;
+
+        static void Store(const AxisAlignedBox3<T> &_b, uint8_t *_out)
+        {
+          BinaryCodec<Vector3<T>>::Store(_b.Min(), _out);
+          BinaryCodec<Vector3<T>>::Store(_b.Max(),
+              _out + BinaryCodec<Vector3<T>>::kSize);
+        }
+
+        static void Load(const uint8_t *_in, AxisAlignedBox3<T> &_b)
+        {
+          Vector3<T> min, max;
+          BinaryCodec<Vector3<T>>::Load(_in, min);
+          BinaryCodec<Vector3<T>>::Load(
+              _in + BinaryCodec<Vector3<T>>::kSize, max);
+          _b.SetMin(min);
+          _b.SetMax(max);
+        }
+      };
+
+      /// \brief MassMatrix3 as the mass, the diagonal moments and the
+      /// off-diagonal moments. Invalid mass matrices are not rejected.
+      template<typename T>
+      struct BinaryCodec<MassMatrix3<T>>
+      {
+        static constexpr std::size_t kSize =
+          sizeof(T) + 2 * BinaryCodec<Vector3<T>>::kSize;
+
+        static void Store(const MassMatrix3<T> &_m, uint8_t *_out)
+        {
+          BinaryCodec<T>::Store(_m.Mass(), _out);
+          BinaryCodec<Vector3<T>>::Store(_m.DiagonalMoments(),
+              _out + sizeof(T));
+          BinaryCodec<Vector3<T>>::Store(_m.OffDiagonalMoments(),
+              _out + sizeof(T) + BinaryCodec<Vector3<T>>::kSize);
+        }
+
+        static void Load(const uint8_t *_in, MassMatrix3<T> &_m)
+        {
+          T mass;
+          Vector3<T> diagonal, offDiagonal;
+          BinaryCodec<T>::Load(_in, mass);
+          BinaryCodec<Vector3<T>>::Load(_in + sizeof(T), diagonal);
+          BinaryCodec<Vector3<T>>::Load(
+              _in + sizeof(T) + BinaryCodec<Vector3<T>>::kSize, offDiagonal);
+          _m = MassMatrix3<T>(mass, diagonal, offDiagonal);
+        }
+      };
+
+      /// \brief 1/sqrt(2), the largest magnitude of the three smallest
+      /// components of a unit quaternion.
+      constexpr double smallestThreeRange = 0.70710678118654752440;
+
+      /// \brief Map a signed integer to an unsigned one so that values of
+      /// small magnitude have few significant bits.
+      /// \param[in] _v Signed value.
+      /// \return 0, -1, 1, -2, ... mapped to 0, 1, 2, 3, ...
+      constexpr uint64_t zigzagEncode(const int64_t _v)
+      {
+        return (static_cast<uint64_t>(_v) << 1) ^
+               (_v < 0 ? ~uint64_t(0) : uint64_t(0));
+      }
+
+      /// \brief Inverse of zigzagEncode.
+      /// \param[in] _v Encoded value.
+      /// \return Signed value.
+      constexpr int64_t zigzagDecode(const uint64_t _v)
+      {
+        return static_cast<int64_t>((_v >> 1) ^ (~(_v & 1) + 1));
+      }
+    }
+
+    /// \class BinaryEncoder BinaryCodec.hh ignition/math/BinaryCodec.hh
+    /// \brief Appends math types to a byte buffer in a compact binary
+    /// format that is the same on every platform.
+    ///
+    /// Scalars are stored little endian with their natural size, and
+    /// floating point values keep their IEEE 754 bits, so Write and
+    /// WriteArray round trip exactly. Vectors are stored component by
+    /// component, quaternions as w, x, y, z, poses as the position then
+    /// the rotation, boxes as the minimum then the maximum corner, and
+    /// mass matrices as the mass, the diagonal and the off-diagonal
+    /// moments. There is no type tag or padding: a Pose3d takes 56 bytes.
+    ///
+    /// WriteSmallestThree and WritePoseDeltas are lossy encodings for
+    /// logs of rotations and trajectories. Read the data back with
+    /// BinaryDecoder, in the same order and with the same types.
+    class BinaryEncoder
+    {
+      /// \brief Constructor.
+      /// \param[in] _buffer Buffer the encoded bytes are appended to. It
+      /// must outlive the encoder.
+      public: explicit BinaryEncoder(std::vector<uint8_t> &_buffer)
+        : buffer(_buffer)
+      {
+      }
+
+      /// \brief Append a value.
+      /// \param[in] _value Value to encode.
+      public: template<typename T>
+              void Write(const T &_value)
+      {
+        using Codec = detail::BinaryCodec<T>;
+        const std::size_t offset = this->buffer.size();
+        this->buffer.resize(offset + Codec::kSize);
+        Codec::Store(_value, this->buffer.data() + offset);
+      }
+
+      /// \brief Append an array of values. The buffer grows once.
+      /// \param[in] _values Values to encode.
+      /// \param[in] _count Number of values.
+      public: template<typename T>
+              void WriteArray(const T *_values, const std::size_t _count)
+      {
+        using Codec = detail::BinaryCodec<T>;
+        const std::size_t offset = this->buffer.size();
+        this->buffer.resize(offset + _count * Codec::kSize);
+        uint8_t *out = this->buffer.data() + offset;
+        for (std::size_t i = 0; i < _count; ++i, out += Codec::kSize)
+          Codec::Store(_values[i], out);
+      }
+
+      /// \brief Append an unsigned integer as a LEB128 varint, one to ten
+      /// bytes with seven bits each. Useful for array sizes.
+      /// \param[in] _value Value to encode.
+      public: void WriteVarint(uint64_t _value)
+      {
+        while (_value >= 0x80)
+        {
+          this->buffer.push_back(static_cast<uint8_t>(_value | 0x80));
+          _value >>= 7;
+        }
+        this->buffer.push_back(static_cast<uint8_t>(_value));
+      }
+
+      /// \brief Append a rotation with the smallest three compression.
+      /// The quaternion is normalized, its largest component is dropped
+      /// and made positive, and the other three, which lie within
+      /// +/-1/sqrt(2), are quantized to _bits bits each. The encoding
+      /// takes (2 + 3 * _bits) / 8 bytes rounded up: 8 bytes with the
+      /// default 20 bits, for a component error below 7e-7.
+      /// \param[in] _q Rotation to encode. A zero quaternion encodes the
+      /// identity.
+      /// \param[in] _bits Bits per component, clamped to [1, 20]. The
+      /// decoder must use the same value.
+      public: template<typename T>
+              void WriteSmallestThree(const Quaternion<T> &_q,
+                                      unsigned int _bits = 20)
+      {
+        _bits = std::clamp(_bits, 1u, 20u);
+        Quaternion<T> q = _q;
+        q.Normalize();
+        const double c[4] = {static_cast<double>(q.W()),
+          static_cast<double>(q.X()), static_cast<double>(q.Y()),
+          static_cast<double>(q.Z())};
+
+        unsigned int largest = 0;
+        for (unsigned int i = 1; i < 4; ++i)
+        {
+          if (std::abs(c[i]) > std::abs(c[largest]))
+            largest = i;
+        }
+        const double sign = c[largest] < 0 ? -1.0 : 1.0;
+
+        const double maxValue = static_cast<double>((1u << _bits) - 1);
+        uint64_t packed = largest;
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+          if (i == largest)
+            continue;
+          const double unit = (sign * c[i] + detail::smallestThreeRange) /
+            (2 * detail::smallestThreeRange);
+          const double v =
+            std::clamp(std::round(unit * maxValue), 0.0, maxValue);
+          packed = (packed << _bits) | static_cast<uint64_t>(v);
+        }
+
+        const std::size_t bytes = (2 + 3 * _bits + 7) / 8;
+        for (std::size_t i = 0; i < bytes; ++i)
+          this->buffer.push_back(static_cast<uint8_t>(packed >> (8 * i)));
+      }
+
+      /// \brief Append a sequence of poses, such as a trajectory, as
+      /// quantized deltas. Positions are rounded to multiples of
+      /// _resolution, rotations are normalized and their components
+      /// rounded to multiples of 2^-_rotationBits, and each pose is stored
+      /// as variable length differences from the previous one. Smooth
+      /// trajectories take a few bytes per pose instead of 56.
+      ///
+      /// Decoded positions are within _resolution / 2 of the originals,
+      /// as long as they are within 2^61 * _resolution of the origin.
+      /// Non-finite values are encoded as zero. The sign of each
+      /// quaternion may be flipped, which does not change the rotation.
+      /// \param[in] _poses Poses to encode.
+      /// \param[in] _count Number of poses.
+      /// \param[in] _resolution Position resolution, finite and positive.
+      /// \param[in] _rotationBits Fractional bits of the quaternion
+      /// components, in [1, 30].
+      /// \return True on success, false if a parameter is invalid, in
+      /// which case nothing is written.
+      public: template<typename T>
+              bool WritePoseDeltas(const Pose3<T> *_poses,
+                                   const std::size_t _count,
+                                   const double _resolution = 1e-5,
+                                   const unsigned int _rotationBits = 20)
+      {
+        if (!(_resolution > 0) || !std::isfinite(_resolution) ||
+            _rotationBits < 1 || _rotationBits > 30)
+        {
+          IGN_MATH_DIAGNOSTIC("Invalid pose delta resolution[" << _resolution
+              << "] or rotation bits[" << _rotationBits << "]");
+          return false;
+        }
+
+        this->WriteVarint(_count);
+        this->Write(_resolution);
+        this->Write(static_cast<uint8_t>(_rotationBits));
+
+        const double rotationScale = std::ldexp(1.0, _rotationBits);
+        int64_t prev[7] = {0, 0, 0, 0, 0, 0, 0};
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const Vector3<T> &pos = _poses[i].Pos();
+          Quaternion<T> rot = _poses[i].Rot();
+          rot.Normalize();
+
+          int64_t cur[7];
+          for (int j = 0; j < 3; ++j)
+            cur[j] = Quantize(static_cast<double>(pos[j]) / _resolution);
+          cur[3] = Quantize(static_cast<double>(rot.W()) * rotationScale);
+          cur[4] = Quantize(static_cast<double>(rot.X()) * rotationScale);
+          cur[5] = Quantize(static_cast<double>(rot.Y()) * rotationScale);
+          cur[6] = Quantize(static_cast<double>(rot.Z()) * rotationScale);
+
+          // q and -q are the same rotation. Keep the one closest to the
+          // previous quaternion, so that the deltas stay small.
+          int64_t dot = 0;
+          for (int j = 3; j < 7; ++j)
+            dot += cur[j] * prev[j];
+          if (dot < 0)
+          {
+            for (int j = 3; j < 7; ++j)
+              cur[j] = -cur[j];
+          }
+
+          for (int j = 0; j < 7; ++j)
+          {
+            this->WriteVarint(detail::zigzagEncode(cur[j] - prev[j]));
+            prev[j] = cur[j];
+          }
+        }
+        return true;
+      }
+
+      /// \brief Round a value to an integer within +/-2^61, so that the
+      /// difference of two of them does not overflow.
+      /// \param[in] _v Value to round.
+      /// \return Rounded value, or 0 if _v is NaN.
+      private: static int64_t Quantize(const double _v)
+      {
+        constexpr double kLimit = 2305843009213693952.0;
+        if (std::isnan(_v))
+          return 0;
+        return std::llround(std::clamp(_v, -kLimit, kLimit));
+      }
+
+      /// \brief Buffer the bytes are appended to.
+      private: std::vector<uint8_t> &buffer;
+    };
+
+    /// \class BinaryDecoder BinaryCodec.hh ignition/math/BinaryCodec.hh
+    /// \brief Reads math types written by BinaryEncoder.
+    ///
+    /// Every read checks the remaining size. A read that fails leaves its
+    /// output unchanged and puts the decoder in a failed state, in which
+    /// all following reads fail, so a sequence of reads can be checked
+    /// once with Good().
+    class BinaryDecoder
+    {
+      /// \brief Constructor.
+      /// \param[in] _data Encoded bytes. They must outlive the decoder.
+      /// \param[in] _size Number of bytes.
+      public: BinaryDecoder(const uint8_t *_data, const std::size_t _size)
+        : data(_data), end(_data + _size)
+      {
+      }
+
+      /// \brief Constructor.
+      /// \param[in] _buffer Encoded bytes. The buffer must outlive the
+      /// decoder and not be resized while it is used.
+      public: explicit BinaryDecoder(const std::vector<uint8_t> &_buffer)
+        : BinaryDecoder(_buffer.data(), _buffer.size())
+      {
+      }
+
+      /// \brief Read a value.
+      /// \param[out] _value Decoded value.
+      /// \return True on success.
+      public: template<typename T>
+              bool Read(T &_value)
+      {
+        using Codec = detail::BinaryCodec<T>;
+        if (!this->Require(Codec::kSize))
+          return false;
+        Codec::Load(this->data, _value);
+        this->data += Codec::kSize;
+        return true;
+      }
+
+      /// \brief Read an array of values.
+      /// \param[out] _values Decoded values, _count of them.
+      /// \param[in] _count Number of values.
+      /// \return True on success. Nothing is written on failure.
+      public: template<typename T>
+              bool ReadArray(T *_values, const std::size_t _count)
+      {
+        using Codec = detail::BinaryCodec<T>;
+        if (!this->good || _count > this->Remaining() / Codec::kSize)
+        {
+          this->good = false;
+          return false;
+        }
+        for (std::size_t i = 0; i < _count; ++i, this->data += Codec::kSize)
+          Codec::Load(this->data, _values[i]);
+        return true;
+      }
+
+      /// \brief Read an unsigned integer written by
+      /// BinaryEncoder::WriteVarint.
+      /// \param[out] _value Decoded value.
+      /// \return True on success.
+      public: bool ReadVarint(uint64_t &_value)
+      {
+        uint64_t value = 0;
+        const uint8_t *p = this->data;
+        for (unsigned int shift = 0; this->good && p < this->end;
+             shift += 7)
+        {
+          const uint8_t byte = *p++;
+          // The tenth byte holds the last bit of a 64 bit value.
+          if (shift == 63 && byte > 1)
+            break;
+          value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+          if (!(byte & 0x80))
+          {
+            this->data = p;
+            _value = value;
+            return true;
+          }
+        }
+        this->good = false;
+        return false;
+      }
+
+      /// \brief Read a rotation written by
+      /// BinaryEncoder::WriteSmallestThree.
+      /// \param[out] _q Decoded rotation, normalized.
+      /// \param[in] _bits Bits per component used by the encoder.
+      /// \return True on success.
+      public: template<typename T>
+              bool ReadSmallestThree(Quaternion<T> &_q,
+                                     unsigned int _bits = 20)
+      {
+        _bits = std::clamp(_bits, 1u, 20u);
+        const std::size_t bytes = (2 + 3 * _bits + 7) / 8;
+        if (!this->Require(bytes))
+          return false;
+
+        uint64_t packed = 0;
+        for (std::size_t i = 0; i < bytes; ++i)
+          packed |= static_cast<uint64_t>(this->data[i]) << (8 * i);
+        this->data += bytes;
+
+        const uint64_t mask = (uint64_t(1) << _bits) - 1;
+        const double maxValue = static_cast<double>(mask);
+        const unsigned int largest =
+          static_cast<unsigned int>(packed >> (3 * _bits)) & 3u;
+
+        double c[4];
+        double sumSq = 0;
+        for (int i = 3; i >= 0; --i)
+        {
+          if (static_cast<unsigned int>(i) == largest)
+            continue;
+          const double unit = static_cast<double>(packed & mask) / maxValue;
+          packed >>= _bits;
+          c[i] = (2 * unit - 1) * detail::smallestThreeRange;
+          sumSq += c[i] * c[i];
+        }
+        c[largest] = std::sqrt(std::max(0.0, 1.0 - sumSq));
+
+        Quaternion<T> q(static_cast<T>(c[0]), static_cast<T>(c[1]),
+                        static_cast<T>(c[2]), static_cast<T>(c[3]));
+        q.Normalize();
+        _q = q;
+        return true;
+      }
+
+      /// \brief Read a sequence of poses written by
+      /// BinaryEncoder::WritePoseDeltas.
+      /// \param[out] _poses Decoded poses, replacing the contents. The
+      /// rotations are normalized.
+      /// \return True on success. _poses is unchanged on failure.
+      public: template<typename T>
+              bool ReadPoseDeltas(std::vector<Pose3<T>> &_poses)
+      {
+        uint64_t count;
+        double resolution;
+        uint8_t rotationBits;
+        if (!this->ReadVarint(count) || !this->Read(resolution) ||
+            !this->Read(rotationBits))
+        {
+          return false;
+        }
+
+        // Each pose takes at least seven bytes, which bounds the
+        // allocation for corrupt input.
+        if (!(resolution > 0) || !std::isfinite(resolution) ||
+            rotationBits < 1 || rotationBits > 30 ||
+            count > this->Remaining() / 7)
+        {
+          this->good = false;
+          return false;
+        }
+
+        const double rotationScale = std::ldexp(1.0, -rotationBits);
+        std::vector<Pose3<T>> poses;
+        poses.reserve(static_cast<std::size_t>(count));
+        int64_t cur[7] = {0, 0, 0, 0, 0, 0, 0};
+        for (uint64_t i = 0; i < count; ++i)
+        {
+          for (int j = 0; j < 7; ++j)
+          {
+            uint64_t delta;
+            if (!this->ReadVarint(delta))
+              return false;
+            // Wrap around like the encoder's subtraction did.
+            cur[j] = static_cast<int64_t>(static_cast<uint64_t>(cur[j]) +
+                static_cast<uint64_t>(detail::zigzagDecode(delta)));
+          }
+
+          Quaternion<T> rot(
+              static_cast<T>(static_cast<double>(cur[3]) * rotationScale),
+              static_cast<T>(static_cast<double>(cur[4]) * rotationScale),
+              static_cast<T>(static_cast<double>(cur[5]) * rotationScale),
+              static_cast<T>(static_cast<double>(cur[6]) * rotationScale));
+          rot.Normalize();
+          poses.emplace_back(Vector3<T>(
+              static_cast<T>(static_cast<double>(cur[0]) * resolution),
+              static_cast<T>(static_cast<double>(cur[1]) * resolution),
+              static_cast<T>(static_cast<double>(cur[2]) * resolution)),
+              rot);
+        }
+        _poses = std::move(poses);
+        return true;
+      }
+
+      /// \brief Check that no read has failed.
+      /// \return True if all reads succeeded.
+      public: bool Good() const
+      {
+        return this->good;
+      }
+
+      /// \brief Get the number of bytes left to read.
+      /// \return Number of bytes.
+      public: std::size_t Remaining() const
+      {
+        return static_cast<std::size_t>(this->end - this->data);
+      }
+
+      /// \brief Check that the decoder is good and has enough bytes left,
+      /// or fail.
+      /// \param[in] _size Number of bytes needed.
+      /// \return True if the bytes can be read.
+      private: bool Require(const std::size_t _size)
+      {
+        this->good = this->good && _size <= this->Remaining();
+        return this->good;
+      }
+
+      /// \brief Next byte to read.
+      private: const uint8_t *data;
+
+      /// \brief End of the bytes.
+      private: const uint8_t *end;
+
+      /// \brief False once a read has failed.
+      private: bool good = true;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_BOUNDINGVOLUMEHIERARCHY_HH_
+#define GZ_MATH_BOUNDINGVOLUMEHIERARCHY_HH_
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Frustum.hh>
+#include <gz/math/Vector3.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  // Forward declaration.
+  class BoundingVolumeHierarchyPrivate;
+
+  /// \class BoundingVolumeHierarchy BoundingVolumeHierarchy.hh
+  /// ignition/math/BoundingVolumeHierarchy.hh
+  /// \brief A bounding volume hierarchy (BVH) over a set of axis aligned
+  /// boxes, used to answer ray and overlap queries against many boxes in
+  /// logarithmic rather than linear time.
+  ///
+  /// The tree is built with the surface area heuristic (SAH) and stored as
+  /// a flat array of nodes. Boxes are referred to by their index in the
+  /// vector passed to Build(). Boxes with a minimum corner greater than
+  /// their maximum corner, such as a default constructed AxisAlignedBox,
+  /// are ignored.
+  ///
+  /// Ray queries follow the conventions of AxisAlignedBox::Intersect: the
+  /// direction is normalized, only the segment between the distances _min
+  /// and _max along the ray is considered, and reported distances are
+  /// measured from the start of that segment.
+  ///
+  /// The hierarchy does not track changes to the boxes; call Build() again
+  /// after they move.
+  class IGNITION_MATH_VISIBLE BoundingVolumeHierarchy
+  {
+    /// \brief Index reported by ray queries when no box is hit.
+    public: static constexpr std::size_t kNoHit =
+      std::numeric_limits<std::size_t>::max();
+
+    /// \brief Default constructor. Creates an empty hierarchy.
+    public: BoundingVolumeHierarchy();
+
+    /// \brief Constructor. Builds a hierarchy over a set of boxes.
+    /// \param[in] _boxes Boxes to insert.
+    public: explicit BoundingVolumeHierarchy(
+                const std::vector<AxisAlignedBox> &_boxes);
+
+    /// \brief Copy constructor.
+    /// \param[in] _bvh Hierarchy to copy.
+    public: BoundingVolumeHierarchy(const BoundingVolumeHierarchy &_bvh);
+
+    /// \brief Destructor.
+    public: ~BoundingVolumeHierarchy();
+
+    /// \brief Assignment operator.
+    /// \param[in] _bvh Hierarchy to copy.
+    /// \return Reference to this hierarchy.
+    public: BoundingVolumeHierarchy &operator=(
+                const BoundingVolumeHierarchy &_bvh);
+
+    /// \brief Rebuild the hierarchy over a new set of boxes.
+    /// \param[in] _boxes Boxes to insert.
+    public: void Build(const std::vector<AxisAlignedBox> &_boxes);
+
+    /// \brief Rebuild the hierarchy over a new set of boxes using several
+    /// threads. The resulting hierarchy is the same as with a single
+    /// thread.
+    /// \param[in] _boxes Boxes to insert.
+    /// \param[in] _threads Number of threads used to build the tree. The
+    /// two subtrees of large nodes are built concurrently. A value of 0
+    /// uses the number of hardware threads. Small hierarchies always use a
+    /// single thread.
+    public: void Build(const std::vector<AxisAlignedBox> &_boxes,
+                       const unsigned int _threads);
+
+    /// \brief Get the number of boxes passed to the last Build() call,
+    /// including the ignored ones.
+    /// \return Number of boxes.
+    public: std::size_t BoxCount() const;
+
+    /// \brief Get the number of nodes of the tree.
+    /// \return Number of nodes. It is 0 for an empty hierarchy.
+    public: std::size_t NodeCount() const;
+
+    /// \brief Get whether the hierarchy contains no valid boxes.
+    /// \return True if there are no valid boxes.
+    public: bool Empty() const;
+
+    /// \brief Get the box that bounds every box in the hierarchy.
+    /// \return The bounding box, or a default box if the hierarchy is empty.
+    public: AxisAlignedBox Bounds() const;
+
+    /// \brief Find the closest box hit by a ray.
+    /// \param[in] _origin Origin of the ray.
+    /// \param[in] _dir Direction of the ray. This ray will be normalized.
+    /// \param[in] _min Minimum allowed distance.
+    /// \param[in] _max Maximum allowed distance.
+    /// \return A boolean, double, std::size_t tuple. The boolean value is
+    /// true if the ray hits a box. The double is the distance from the
+    /// ray's start to the closest intersection point, and zero when there
+    /// is no hit. The std::size_t is the index of the closest box hit, or
+    /// kNoHit.
+    public: std::tuple<bool, double, std::size_t> ClosestHit(
+                const Vector3d &_origin, const Vector3d &_dir,
+                const double _min, const double _max) const;
+
+    /// \brief Find the closest primitive hit by a ray, in a hierarchy built
+    /// over the bounds of primitives such as the triangles of a mesh. The
+    /// function _hit is called for the boxes hit by the ray, nearest
+    /// subtrees first, and boxes farther than the closest primitive hit so
+    /// far are skipped. See Triangle3::RayIntersection to intersect
+    /// triangles.
+    /// \param[in] _origin Origin of the ray.
+    /// \param[in] _dir Direction of the ray. This ray will be normalized.
+    /// \param[in] _min Minimum allowed distance.
+    /// \param[in] _max Maximum allowed distance.
+    /// \param[in] _hit Function called with the index of a box hit by the
+    /// ray and the distance from _origin where the ray enters it. It
+    /// returns true if the ray hits the primitive of that box, and then
+    /// sets the distance to that of the primitive hit, measured from
+    /// _origin along the normalized direction. Hits closer than _min are
+    /// ignored.
+    /// \return A boolean, double, std::size_t tuple as returned by
+    /// ClosestHit(const Vector3d &, const Vector3d &, double, double),
+    /// for the closest primitive hit.
+    public: std::tuple<bool, double, std::size_t> ClosestHit(
+                const Vector3d &_origin, const Vector3d &_dir,
+                const double _min, const double _max,
+                const std::function<bool(std::size_t, double &)> &_hit) const;
+
+    /// \brief Check if a ray hits any box. This is cheaper than
+    /// ClosestHit() because traversal stops at the first hit.
+    /// \param[in] _origin Origin of the ray.
+    /// \param[in] _dir Direction of the ray. This ray will be normalized.
+    /// \param[in] _min Minimum allowed distance.
+    /// \param[in] _max Maximum allowed distance.
+    /// \return True if the ray hits at least one box.
+    public: bool AnyHit(const Vector3d &_origin, const Vector3d &_dir,
+                        const double _min, const double _max) const;
+
+    /// \brief Find the closest box hit by each ray of a batch. Rays are
+    /// given by the elements with the same index in _origins and _dirs.
+    /// \param[in] _origins Origins of the rays.
+    /// \param[in] _dirs Directions of the rays. They will be normalized.
+    /// It must have the same size as _origins.
+    /// \param[in] _min Minimum allowed distance.
+    /// \param[in] _max Maximum allowed distance.
+    /// \param[out] _indices Index of the closest box hit by each ray, or
+    /// kNoHit. It is resized to the number of rays.
+    /// \param[out] _distances Distance from each ray's start to its closest
+    /// intersection point, or zero. It is resized to the number of rays.
+    /// \return False if _origins and _dirs have different sizes.
+    public: bool ClosestHits(const std::vector<Vector3d> &_origins,
+                             const std::vector<Vector3d> &_dirs,
+                             const double _min, const double _max,
+                             std::vector<std::size_t> &_indices,
+                             std::vector<double> &_distances) const;
+
+    /// \brief Find the box nearest to a point.
+    /// \param[in] _point The point.
+    /// \param[in] _maxDistance Maximum allowed distance from the point.
+    /// \return A boolean, double, std::size_t tuple. The boolean value is
+    /// true if a box is within _maxDistance of the point. The double is the
+    /// distance from the point to the nearest box, which is zero if the
+    /// point is inside of it, and zero when there is no box. The
+    /// std::size_t is the index of the nearest box, or kNoHit. The lowest
+    /// index is reported when several boxes are at the same distance.
+    public: std::tuple<bool, double, std::size_t> Nearest(
+                const Vector3d &_point, const double _maxDistance) const;
+
+    /// \brief Find the primitive nearest to a point, in a hierarchy built
+    /// over the bounds of primitives such as the triangles of a mesh. The
+    /// function _distance is called for the boxes within the distance of
+    /// the nearest primitive found so far, nearest subtrees first.
+    /// \param[in] _point The point.
+    /// \param[in] _maxDistance Maximum allowed distance from the point.
+    /// \param[in] _distance Function called with the index of a box and
+    /// the distance from the point to it. It returns true if the primitive
+    /// of that box counts, and then sets the distance to that of the
+    /// primitive, which is not less than the distance to its box.
+    /// \return A boolean, double, std::size_t tuple as returned by
+    /// Nearest(const Vector3d &, double), for the nearest primitive.
+    public: std::tuple<bool, double, std::size_t> Nearest(
+                const Vector3d &_point, const double _maxDistance,
+                const std::function<bool(std::size_t, double &)> &_distance)
+                const;
+
+    /// \brief Find all the boxes that intersect a box, using the same test
+    /// as AxisAlignedBox::Intersects.
+    /// \param[in] _box Box to check.
+    /// \param[out] _indices Indices of the intersecting boxes, in no
+    /// particular order. The vector is cleared first.
+    public: void Overlaps(const AxisAlignedBox &_box,
+                          std::vector<std::size_t> &_indices) const;
+
+    /// \brief Find all the boxes that are inside a frustum. The result for
+    /// each box is the same as Frustum::Contains(const AxisAlignedBox &).
+    ///
+    /// The tree is culled hierarchically: a node outside of a plane is
+    /// skipped with its whole subtree, and the planes a node is fully
+    /// inside of are not tested again for its descendants. The boxes of a
+    /// node inside all the planes are reported without testing them, so the
+    /// cost grows with the number of visible boxes rather than with the
+    /// size of the hierarchy.
+    /// \param[in] _frustum Frustum to check.
+    /// \param[out] _indices Indices of the boxes inside the frustum, in no
+    /// particular order. The vector is cleared first.
+    public: void Overlaps(const Frustum &_frustum,
+                          std::vector<std::size_t> &_indices) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+    /// \brief Private data pointer.
+    private: std::unique_ptr<BoundingVolumeHierarchyPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+  };
+  }
+}
+}
+#endif
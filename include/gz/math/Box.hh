@@ -21,8 +21,10 @@
 #include <gz/math/MassMatrix3.hh>
 #include <gz/math/Material.hh>
 #include <gz/math/Plane.hh>
+#include <gz/math/Pose3.hh>
 #include <gz/math/Vector3.hh>
 
+#include "gz/math/detail/FixedIntersectionPoints.hh"
 #include "gz/math/detail/WellOrderedVector.hh"
 
 #include <set>
@@ -38,6 +40,12 @@ namespace ignition
     template<typename T>
     using IntersectionPoints = std::set<Vector3<T>, WellOrderedVectors<T>>;
 
+    /// \brief Allocation free version of IntersectionPoints. Its capacity
+    /// holds the vertices of a box below a plane together with the
+    /// intersections of the plane with the edges of the box.
+    template<typename T>
+    using BoxIntersectionPoints = FixedIntersectionPoints<T, 14>;
+
     /// \class Box Box.hh ignition/math/Box.hh
     /// \brief A representation of a box. All units are in meters.
     ///
@@ -151,6 +159,31 @@ namespace ignition
       public: std::optional<Vector3<Precision>>
         CenterOfVolumeBelow(const Plane<Precision> &_plane) const;
 
+      /// \brief Compute the volume below a plane and its center for many
+      /// boxes, such as the submerged volume and center of buoyancy of
+      /// floating bodies below a water plane. Unlike VolumeBelow and
+      /// CenterOfVolumeBelow, each box is clipped against the plane in
+      /// place without allocating, and the center is the exact centroid
+      /// of the volume below the plane.
+      /// \param[in] _sizes Array of _count box sizes.
+      /// \param[in] _poses Array of _count poses of the box centers, in the
+      /// frame of _plane.
+      /// \param[in] _count Number of boxes.
+      /// \param[in] _plane The plane which cuts every box. Its normal does
+      /// not need to be normalized.
+      /// \param[out] _volumes Array of at least _count values, written with
+      /// the volume below the plane of each box in m^3.
+      /// \param[out] _centers Array of at least _count vectors, written with
+      /// the center of the volume below the plane of each box, in the frame
+      /// of _plane. This is the center of the box if no part of it is below
+      /// the plane.
+      public: static void VolumesBelow(const Vector3<Precision> *_sizes,
+                                       const Pose3<Precision> *_poses,
+                                       const std::size_t _count,
+                                       const Plane<Precision> &_plane,
+                                       Precision *_volumes,
+                                       Vector3<Precision> *_centers);
+
       /// \brief All the vertices which are on or below the plane.
       /// \param[in] _plane The plane which cuts the box, expressed in the box's
       /// frame.
@@ -159,6 +192,16 @@ namespace ignition
       public: IntersectionPoints<Precision>
         VerticesBelow(const Plane<Precision> &_plane) const;
 
+      /// \brief All the vertices which are on or below the plane, without
+      /// allocating.
+      /// \param[in] _plane The plane which cuts the box, expressed in the box's
+      /// frame.
+      /// \param[out] _vertices Box vertices which are below the plane,
+      /// expressed in the box's frame. They are added to the points already
+      /// in _vertices.
+      public: void VerticesBelow(const Plane<Precision> &_plane,
+                  BoxIntersectionPoints<Precision> &_vertices) const;
+
       /// \brief Compute the box's density given a mass value. The
       /// box is assumed to be solid with uniform density. This
       /// function requires the box's size to be set to
@@ -192,6 +235,47 @@ namespace ignition
       /// could be due to an invalid size (<=0) or density (<=0).
       public: bool MassMatrix(MassMatrix3<Precision> &_massMat) const;
 
+      /// \brief Compute the volumes of many boxes. Each result is the same
+      /// as Volume() of a box with the corresponding size.
+      /// \param[in] _sizes Array of _count box sizes.
+      /// \param[in] _count Number of boxes.
+      /// \param[out] _volumes Array of at least _count values, written with
+      /// the volume of each box in m^3.
+      public: static void Volumes(const Vector3<Precision> *_sizes,
+                                  const std::size_t _count,
+                                  Precision *_volumes);
+
+      /// \brief Compute the densities of many boxes from their masses.
+      /// Each result is the same as DensityFromMass of a box with the
+      /// corresponding size.
+      /// \param[in] _sizes Array of _count box sizes.
+      /// \param[in] _masses Array of _count masses, in kg.
+      /// \param[in] _count Number of boxes.
+      /// \param[out] _densities Array of at least _count values, written
+      /// with the density of each box in kg/m^3, or a negative value if
+      /// the size or mass is <= 0.
+      public: static void DensitiesFromMasses(
+                  const Vector3<Precision> *_sizes,
+                  const Precision *_masses,
+                  const std::size_t _count,
+                  Precision *_densities);
+
+      /// \brief Compute the mass matrices of many boxes of uniform density.
+      /// Each result is the same as MassMatrix of a box with the
+      /// corresponding size and a material of the corresponding density,
+      /// without constructing a Material.
+      /// \param[in] _sizes Array of _count box sizes.
+      /// \param[in] _densities Array of _count densities, in kg/m^3.
+      /// \param[in] _count Number of boxes.
+      /// \param[out] _massMats Array of at least _count mass matrices.
+      /// Boxes with a size or density <= 0 are written with a default
+      /// constructed mass matrix, which has zero mass.
+      /// \return True if the mass matrix of every box was computed.
+      public: static bool MassMatrices(const Vector3<Precision> *_sizes,
+                                       const Precision *_densities,
+                                       const std::size_t _count,
+                                       MassMatrix3<Precision> *_massMats);
+
       /// \brief Get intersection between a plane and the box's edges.
       /// Edges contained on the plane are ignored.
       /// \param[in] _plane The plane against which we are testing intersection.
@@ -200,6 +284,15 @@ namespace ignition
       public: IntersectionPoints<Precision> Intersections(
         const Plane<Precision> &_plane) const;
 
+      /// \brief Get intersection between a plane and the box's edges, without
+      /// allocating. Edges contained on the plane are ignored.
+      /// \param[in] _plane The plane against which we are testing intersection.
+      /// \param[out] _intersections Points along the edges of the box where
+      /// the intersection occurs. They are added to the points already in
+      /// _intersections.
+      public: void Intersections(const Plane<Precision> &_plane,
+                  BoxIntersectionPoints<Precision> &_intersections) const;
+
       /// \brief Size of the box.
       private: Vector3<Precision> size = Vector3<Precision>::Zero;
 
@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_CACHEDPOSE3_HH_
+#define GZ_MATH_CACHEDPOSE3_HH_
+
+#include <cstddef>
+#include <vector>
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/Vector3SoA.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class CachedPose3 CachedPose3.hh ignition/math/CachedPose3.hh
+    /// \brief A Pose3 that caches the rotation matrix and the Euler angles
+    /// of its rotation.
+    ///
+    /// Quaternion::Roll, Pitch and Yaw each run the full Euler conversion,
+    /// and Pose3::CoordPositionAdd rotates with two quaternion products.
+    /// CachedPose3 computes the rotation matrix and the Euler angles the
+    /// first time they are needed and keeps them until the rotation
+    /// changes, so repeated attitude queries and point transforms only pay
+    /// for the conversion once.
+    ///
+    /// The rotation can only be changed through the setters, which
+    /// invalidate the cache. The position is not part of the cache and can
+    /// be modified freely.
+    ///
+    /// The const accessors fill the cache, so a CachedPose3 must not be
+    /// read from several threads at the same time unless the cache has
+    /// already been filled, for example by calling RotationMatrix() and
+    /// Euler() once before sharing it.
+    template<typename T>
+    class CachedPose3
+    {
+      /// \brief Default constructor, the identity pose.
+      public: CachedPose3() = default;
+
+      /// \brief Constructor
+      /// \param[in] _pose Pose to wrap
+      public: explicit CachedPose3(const Pose3<T> &_pose)
+      : pose(_pose)
+      {
+      }
+
+      /// \brief Constructor
+      /// \param[in] _pos A position
+      /// \param[in] _rot A rotation
+      public: CachedPose3(const Vector3<T> &_pos, const Quaternion<T> &_rot)
+      : pose(_pos, _rot)
+      {
+      }
+
+      /// \brief Assign a pose and invalidate the cache.
+      /// \param[in] _pose Pose to copy
+      /// \return Reference to this
+      public: CachedPose3<T> &operator=(const Pose3<T> &_pose)
+      {
+        this->Set(_pose);
+        return *this;
+      }
+
+      /// \brief Set the pose and invalidate the cache.
+      /// \param[in] _pose Pose to copy
+      public: void Set(const Pose3<T> &_pose)
+      {
+        this->pose = _pose;
+        this->Invalidate();
+      }
+
+      /// \brief Set the position and rotation and invalidate the cache.
+      /// \param[in] _pos The position
+      /// \param[in] _rot The rotation
+      public: void Set(const Vector3<T> &_pos, const Quaternion<T> &_rot)
+      {
+        this->pose.Set(_pos, _rot);
+        this->Invalidate();
+      }
+
+      /// \brief Set the rotation and invalidate the cache.
+      /// \param[in] _rot The rotation
+      public: void SetRot(const Quaternion<T> &_rot)
+      {
+        this->pose.Rot() = _rot;
+        this->Invalidate();
+      }
+
+      /// \brief Get the wrapped pose.
+      /// \return The pose
+      public: const Pose3<T> &Pose() const
+      {
+        return this->pose;
+      }
+
+      /// \brief Get the position.
+      /// \return Origin of the pose
+      public: const Vector3<T> &Pos() const
+      {
+        return this->pose.Pos();
+      }
+
+      /// \brief Get a mutable reference to the position. Changing the
+      /// position does not affect the cache.
+      /// \return Origin of the pose
+      public: Vector3<T> &Pos()
+      {
+        return this->pose.Pos();
+      }
+
+      /// \brief Get the rotation. Use SetRot to change it.
+      /// \return Quaternion representation of the rotation
+      public: const Quaternion<T> &Rot() const
+      {
+        return this->pose.Rot();
+      }
+
+      /// \brief Get the rotation matrix, computing it on first use.
+      /// \return Matrix3(Rot())
+      public: const Matrix3<T> &RotationMatrix() const
+      {
+        if (!this->rotationValid)
+        {
+          this->rotation = Matrix3<T>(this->pose.Rot());
+          this->rotationValid = true;
+        }
+        return this->rotation;
+      }
+
+      /// \brief Get the Euler angles, computing them on first use.
+      /// \return Rot().Euler()
+      public: const Vector3<T> &Euler() const
+      {
+        if (!this->eulerValid)
+        {
+          this->euler = this->pose.Rot().Euler();
+          this->eulerValid = true;
+        }
+        return this->euler;
+      }
+
+      /// \brief Get the Euler roll angle in radians.
+      /// \return The roll component
+      public: T Roll() const
+      {
+        return this->Euler().X();
+      }
+
+      /// \brief Get the Euler pitch angle in radians.
+      /// \return The pitch component
+      public: T Pitch() const
+      {
+        return this->Euler().Y();
+      }
+
+      /// \brief Get the Euler yaw angle in radians.
+      /// \return The yaw component
+      public: T Yaw() const
+      {
+        return this->Euler().Z();
+      }
+
+      /// \brief Rotate a vector by the cached rotation matrix.
+      /// \param[in] _vec Vector to rotate
+      /// \return The rotated vector
+      public: Vector3<T> RotateVector(const Vector3<T> &_vec) const
+      {
+        return this->RotationMatrix() * _vec;
+      }
+
+      /// \brief Rotate a vector by the inverse rotation, using the
+      /// transpose of the cached rotation matrix.
+      /// \param[in] _vec Vector to rotate
+      /// \return The rotated vector
+      public: Vector3<T> RotateVectorReverse(const Vector3<T> &_vec) const
+      {
+        const Matrix3<T> &m = this->RotationMatrix();
+        return Vector3<T>(
+            m(0, 0) * _vec.X() + m(1, 0) * _vec.Y() + m(2, 0) * _vec.Z(),
+            m(0, 1) * _vec.X() + m(1, 1) * _vec.Y() + m(2, 1) * _vec.Z(),
+            m(0, 2) * _vec.X() + m(1, 2) * _vec.Y() + m(2, 2) * _vec.Z());
+      }
+
+      /// \brief Transform a point from the pose frame to the parent frame,
+      /// like Pose3::CoordPositionAdd.
+      /// \param[in] _pos Point to transform
+      /// \return The transformed point
+      public: Vector3<T> CoordPositionAdd(const Vector3<T> &_pos) const
+      {
+        return this->RotateVector(_pos) + this->pose.Pos();
+      }
+
+      /// \brief Transform a point from the parent frame to the pose frame,
+      /// the inverse of CoordPositionAdd.
+      /// \param[in] _pos Point to transform
+      /// \return The transformed point
+      public: Vector3<T> CoordPositionSub(const Vector3<T> &_pos) const
+      {
+        return this->RotateVectorReverse(_pos - this->pose.Pos());
+      }
+
+      /// \brief Transform a set of points: _out[i] = CoordPositionAdd(_in[i])
+      /// \param[in] _in Points to transform
+      /// \param[out] _out Transformed points, resized to _in.size(). It may
+      /// be the same vector as _in.
+      public: void CoordPositionAdd(const std::vector<Vector3<T>> &_in,
+                                    std::vector<Vector3<T>> &_out) const
+      {
+        const Matrix3<T> &rot = this->RotationMatrix();
+        const Vector3<T> &p = this->pose.Pos();
+        _out.resize(_in.size());
+        for (std::size_t i = 0; i < _in.size(); ++i)
+          _out[i] = rot * _in[i] + p;
+      }
+
+      /// \brief Transform a set of points stored as a structure-of-arrays:
+      /// _out[i] = CoordPositionAdd(_in[i]).
+      /// \param[in] _in Points to transform
+      /// \param[out] _out Transformed points, resized to _in.Size(). It may
+      /// be the same container as _in.
+      public: void CoordPositionAdd(const Vector3SoA<T> &_in,
+                                    Vector3SoA<T> &_out) const
+      {
+        const Matrix3<T> &rot = this->RotationMatrix();
+        const T r00 = rot(0, 0), r01 = rot(0, 1), r02 = rot(0, 2);
+        const T r10 = rot(1, 0), r11 = rot(1, 1), r12 = rot(1, 2);
+        const T r20 = rot(2, 0), r21 = rot(2, 1), r22 = rot(2, 2);
+        const Vector3<T> &p = this->pose.Pos();
+        const T px = p.X(), py = p.Y(), pz = p.Z();
+
+        const std::size_t n = _in.Size();
+        _out.Resize(n);
+        const T *ix = _in.XData(), *iy = _in.YData(), *iz = _in.ZData();
+        T *ox = _out.XData(), *oy = _out.YData(), *oz = _out.ZData();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          const T x = ix[i], y = iy[i], z = iz[i];
+          ox[i] = r00 * x + r01 * y + r02 * z + px;
+          oy[i] = r10 * x + r11 * y + r12 * z + py;
+          oz[i] = r20 * x + r21 * y + r22 * z + pz;
+        }
+      }
+
+      /// \brief Mark the cached matrix and Euler angles as stale.
+      private: void Invalidate()
+      {
+        this->rotationValid = false;
+        this->eulerValid = false;
+      }
+
+      /// \brief The wrapped pose
+      private: Pose3<T> pose;
+
+      /// \brief Cached rotation matrix of pose.Rot()
+      private: mutable Matrix3<T> rotation;
+
+      /// \brief Cached Euler angles of pose.Rot()
+      private: mutable Vector3<T> euler;
+
+      /// \brief True if rotation matches pose.Rot()
+      private: mutable bool rotationValid = false;
+
+      /// \brief True if euler matches pose.Rot()
+      private: mutable bool eulerValid = false;
+    };
+
+    typedef CachedPose3<double> CachedPose3d;
+    typedef CachedPose3<float> CachedPose3f;
+    }
+  }
+}
+#endif
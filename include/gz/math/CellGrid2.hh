@@ -0,0 +1,386 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_CELLGRID2_HH_
+#define GZ_MATH_CELLGRID2_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <gz/math/Export.hh>
+#include <gz/math/Line2.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    /// \class CellGrid2 CellGrid2.hh ignition/math/CellGrid2.hh
+    /// \brief A uniform grid of square cells over a rectangle, such as the
+    /// cells of a 2D occupancy grid or costmap.
+    ///
+    /// The grid only describes the cells; it stores no data. Cells are
+    /// referred to by their integer coordinates along X and Y, or by a
+    /// linear index in which X varies fastest, to index arrays of cell
+    /// data. CellTraversal2 walks the cells touched by a segment, and
+    /// MarkRays() finds the free and occupied cells of a laser scan.
+    /// VoxelGrid is the 3D counterpart.
+    class IGNITION_MATH_VISIBLE CellGrid2
+    {
+      /// \brief Mark of the cells not crossed by any ray.
+      public: static constexpr uint8_t kUnknown = 0;
+
+      /// \brief Mark of the cells crossed by a ray before its endpoint.
+      public: static constexpr uint8_t kFree = 1;
+
+      /// \brief Mark of the cells holding the endpoint of a ray.
+      public: static constexpr uint8_t kOccupied = 2;
+
+      /// \brief Cells visited by a traversal, see CellTraversal2.
+      public: enum TraversalMode
+              {
+                /// \brief Every cell that the segment passes through.
+                /// This is the default.
+                SUPERCOVER = 0,
+
+                /// \brief One cell per step along the major axis, with
+                /// Bresenham's line algorithm.
+                BRESENHAM = 1
+              };
+
+      /// \brief Default constructor. Creates an invalid grid without
+      /// cells.
+      public: CellGrid2() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _min Minimum corner of the grid.
+      /// \param[in] _max Maximum corner of the grid. It is moved up so
+      /// that the grid holds a whole number of cells.
+      /// \param[in] _resolution Side of the cells.
+      /// The grid is invalid if the rectangle is empty or not finite, if
+      /// the resolution is not positive and finite, or if there would be
+      /// more than 2^31 cells along an axis.
+      public: CellGrid2(const Vector2d &_min, const Vector2d &_max,
+                        const double _resolution);
+
+      /// \brief Check that the grid has cells.
+      /// \return True if the grid was built from valid arguments.
+      public: bool Valid() const;
+
+      /// \brief Get the minimum corner of the grid.
+      /// \return The corner, or zero if the grid is invalid.
+      public: const Vector2d &Min() const;
+
+      /// \brief Get the maximum corner of the cells.
+      /// \return The corner, or zero if the grid is invalid.
+      public: Vector2d Max() const;
+
+      /// \brief Get the side of the cells.
+      /// \return The resolution, or 0 if the grid is invalid.
+      public: double Resolution() const;
+
+      /// \brief Get the number of cells along each axis.
+      /// \return The counts, which are zero if the grid is invalid.
+      public: const Vector2i &CellCounts() const;
+
+      /// \brief Get the total number of cells.
+      /// \return The product of the counts along each axis.
+      public: std::size_t CellCount() const;
+
+      /// \brief Find the cell holding a point. Points on the boundary
+      /// between cells belong to the upper cell, except on the upper
+      /// boundary of the grid.
+      /// \param[in] _point The point.
+      /// \param[out] _cell Coordinates of the cell. Unchanged if the point
+      /// is outside of the grid.
+      /// \return True if the point is inside of the grid.
+      public: bool Cell(const Vector2d &_point, Vector2i &_cell) const;
+
+      /// \brief Check that cell coordinates are inside of the grid.
+      /// \param[in] _cell Coordinates of the cell.
+      /// \return True if the cell exists.
+      public: bool Contains(const Vector2i &_cell) const
+      {
+        return _cell.X() >= 0 && _cell.X() < this->counts.X() &&
+               _cell.Y() >= 0 && _cell.Y() < this->counts.Y();
+      }
+
+      /// \brief Get the linear index of a cell.
+      /// \param[in] _cell Coordinates of a cell inside of the grid.
+      /// \return X + CellCounts().X() * Y.
+      public: std::size_t Index(const Vector2i &_cell) const
+      {
+        return static_cast<std::size_t>(_cell.X()) +
+            static_cast<std::size_t>(this->counts.X()) *
+            static_cast<std::size_t>(_cell.Y());
+      }
+
+      /// \brief Get the center of a cell.
+      /// \param[in] _cell Coordinates of the cell.
+      /// \return The center of the cell.
+      public: Vector2d CellCenter(const Vector2i &_cell) const;
+
+      /// \brief Mark the cells seen by a laser scan, as a costmap update
+      /// does. Each ray goes from the origin to an endpoint. The cells
+      /// traversed by a ray are free, and the cell of its endpoint is
+      /// occupied, which takes precedence over free marks of other rays.
+      /// Rays longer than _maxRange are cut to that length and mark no
+      /// occupied cell. Endpoints that are not finite are skipped.
+      /// \param[in] _origin Origin of the rays.
+      /// \param[in] _endpoints Endpoints of the rays.
+      /// \param[in] _maxRange Maximum length of the rays.
+      /// \param[out] _marks Mark of each cell by linear index: kUnknown,
+      /// kFree or kOccupied. The vector is resized to CellCount() and
+      /// cleared first, and keeps its capacity.
+      /// \param[in] _mode Cells traversed by each ray.
+      /// \param[in] _threads Number of threads used to trace the rays. A
+      /// value of 0 uses the number of hardware threads. Small scans always
+      /// use a single thread. The marks are the same for any number of
+      /// threads.
+      public: void MarkRays(const Vector2d &_origin,
+                            const std::vector<Vector2d> &_endpoints,
+                            const double _maxRange,
+                            std::vector<uint8_t> &_marks,
+                            const TraversalMode _mode = SUPERCOVER,
+                            const unsigned int _threads = 1) const;
+
+      /// \brief Minimum corner of the grid.
+      private: Vector2d origin;
+
+      /// \brief Side of the cells.
+      private: double resolution = 0;
+
+      /// \brief Number of cells along each axis.
+      private: Vector2i counts;
+    };
+
+    /// \class CellTraversal2 CellGrid2.hh ignition/math/CellGrid2.hh
+    /// \brief Iterator over the cells of a CellGrid2 touched by a segment,
+    /// in order from its first point, clipped to the grid.
+    ///
+    /// Two sets of cells are available, see CellGrid2::TraversalMode:
+    /// - SUPERCOVER visits every cell that the segment passes through,
+    ///   with the 2D digital differential analyzer of Amanatides and Woo.
+    ///   Consecutive cells share a side, except through the corner of
+    ///   cells, where both cells on the sides of the corner are visited
+    ///   before the diagonal one.
+    /// - BRESENHAM visits one cell per column or row, whichever is longer,
+    ///   from the cell of the first point to the cell of the last point,
+    ///   with integer steps only. Consecutive cells share a side or a
+    ///   corner. This is the classic costmap raytrace, which visits fewer
+    ///   cells but may skip the corner of a cell that the segment crosses.
+    ///
+    /// Each step costs a few additions and comparisons, and the traversal
+    /// does not allocate.
+    ///
+    /// <b>Example</b>
+    /// \code{.cpp}
+    /// for (gz::math::CellTraversal2 it(grid, gz::math::Line2d(from, to));
+    ///      it.Valid(); it.Next())
+    /// {
+    ///   cost[grid.Index(it.Cell())] = 0;
+    /// }
+    /// \endcode
+    class IGNITION_MATH_VISIBLE CellTraversal2
+    {
+      /// \brief Constructor. Starts at the first cell of a segment.
+      /// \param[in] _grid Grid to traverse, which must outlive the
+      /// traversal.
+      /// \param[in] _segment Segment from its first point to its second
+      /// point.
+      /// \param[in] _mode Cells to visit.
+      public: CellTraversal2(const CellGrid2 &_grid, const Line2d &_segment,
+                             const CellGrid2::TraversalMode _mode =
+                                 CellGrid2::SUPERCOVER);
+
+      /// \brief Check that the traversal has a current cell.
+      /// \return False once the segment leaves the grid or ends, or if it
+      /// never enters the grid.
+      public: bool Valid() const
+      {
+        return this->valid;
+      }
+
+      /// \brief Move to the next cell of the segment.
+      /// \return Valid() after the move.
+      public: bool Next()
+      {
+        if (!this->valid)
+          return false;
+        if (this->mode == CellGrid2::BRESENHAM)
+          return this->NextBresenham();
+        if (this->corner > 0)
+          return this->NextCorner();
+
+        const double tx = this->tMax[0];
+        const double ty = this->tMax[1];
+        // Both axes are crossed at once at a corner, up to the rounding
+        // of the accumulated crossing distances.
+        if (std::abs(tx - ty) <=
+            8 * std::numeric_limits<double>::epsilon() *
+            std::min(std::abs(tx), std::abs(ty)))
+        {
+          if (tx >= this->end)
+            return this->Stop();
+          this->base = this->cell;
+          this->corner = 3;
+          return this->NextCorner();
+        }
+
+        const int axis = tx < ty ? 0 : 1;
+        if (this->tMax[axis] >= this->end)
+          return this->Stop();
+
+        int &coordinate = this->cell[axis];
+        coordinate += this->step[axis];
+        if (coordinate < 0 || coordinate >= this->grid->CellCounts()[axis])
+          return this->Stop();
+        this->tMax[axis] += this->tDelta[axis];
+        return true;
+      }
+
+      /// \brief Get the current cell.
+      /// \return Coordinates of the cell in the grid.
+      public: const Vector2i &Cell() const
+      {
+        return this->cell;
+      }
+
+      /// \brief Get the mode of the traversal.
+      /// \return The cells visited by the traversal.
+      public: CellGrid2::TraversalMode Mode() const
+      {
+        return this->mode;
+      }
+
+      /// \brief End the traversal.
+      /// \return False.
+      private: bool Stop()
+      {
+        this->valid = false;
+        return false;
+      }
+
+      /// \brief Move to the next cell around a corner crossed by a
+      /// supercover traversal: the cell across X, then across Y, then the
+      /// diagonal one, from which the traversal goes on. Side cells outside
+      /// of the grid are skipped.
+      /// \return Valid() after the move.
+      private: bool NextCorner()
+      {
+        while (this->corner > 0)
+        {
+          const int stage = this->corner--;
+          Vector2i next = this->base;
+          if (stage != 2)
+            next.X() += this->step.X();
+          if (stage != 3)
+            next.Y() += this->step.Y();
+
+          if (stage == 1)
+          {
+            if (!this->grid->Contains(next))
+              return this->Stop();
+            this->cell = next;
+            this->tMax[0] += this->tDelta[0];
+            this->tMax[1] += this->tDelta[1];
+            return true;
+          }
+          if (this->grid->Contains(next))
+          {
+            this->cell = next;
+            return true;
+          }
+        }
+        return this->Stop();
+      }
+
+      /// \brief Move to the next cell of a Bresenham traversal.
+      /// \return Valid() after the move.
+      private: bool NextBresenham()
+      {
+        if (this->cell == this->last)
+          return this->Stop();
+        const int64_t twice = 2 * this->error;
+        if (twice >= this->deltaY)
+        {
+          this->error += this->deltaY;
+          this->cell.X() += this->step.X();
+        }
+        if (twice <= this->deltaX)
+        {
+          this->error += this->deltaX;
+          this->cell.Y() += this->step.Y();
+        }
+        return true;
+      }
+
+      /// \brief Grid being traversed.
+      private: const CellGrid2 *grid;
+
+      /// \brief Cells to visit.
+      private: CellGrid2::TraversalMode mode;
+
+      /// \brief Current cell.
+      private: Vector2i cell;
+
+      /// \brief Step of the cell coordinates along each axis: -1, 0 or 1.
+      private: Vector2i step;
+
+      /// \brief Supercover: distance along the segment of the next cell
+      /// boundary along each axis.
+      private: Vector2d tMax;
+
+      /// \brief Supercover: distance along the segment between cell
+      /// boundaries along each axis.
+      private: Vector2d tDelta;
+
+      /// \brief Supercover: distance along the segment at which to stop.
+      private: double end = 0;
+
+      /// \brief Supercover: cell before the corner being crossed.
+      private: Vector2i base;
+
+      /// \brief Supercover: number of cells left to visit around the
+      /// corner being crossed.
+      private: int corner = 0;
+
+      /// \brief Bresenham: last cell.
+      private: Vector2i last;
+
+      /// \brief Bresenham: absolute number of cells along X.
+      private: int64_t deltaX = 0;
+
+      /// \brief Bresenham: negated absolute number of cells along Y.
+      private: int64_t deltaY = 0;
+
+      /// \brief Bresenham: accumulated error.
+      private: int64_t error = 0;
+
+      /// \brief Whether there is a current cell.
+      private: bool valid = false;
+    };
+    }
+  }
+}
+#endif
@@ -19,6 +19,7 @@
 
 #include <iostream>
 #include <cctype>
+#include <cstddef>
 
 #include <gz/math/Helpers.hh>
 #include <gz/math/Vector3.hh>
@@ -187,6 +188,98 @@ namespace ignition
       /// \param[in] _v the new color
       public: void SetFromABGR(const ABGR _v);
 
+      /// \enum PackedFormat
+      /// \brief Channel order of a color packed in an unsigned int, from
+      /// the most to the least significant byte.
+      public: enum PackedFormat
+      {
+        /// \brief Packed as RGBA, see AsRGBA.
+        PACKED_RGBA = 0,
+
+        /// \brief Packed as BGRA, see AsBGRA.
+        PACKED_BGRA = 1,
+
+        /// \brief Packed as ARGB, see AsARGB.
+        PACKED_ARGB = 2,
+
+        /// \brief Packed as ABGR, see AsABGR.
+        PACKED_ABGR = 3
+      };
+
+      /// \brief Unpack an array of packed colors, as SetFromRGBA and the
+      /// other SetFrom functions do for one color, but without creating a
+      /// Color per element. This is meant for images and colored point
+      /// clouds.
+      /// \param[in] _packed Array of _count packed colors.
+      /// \param[in] _count Number of colors.
+      /// \param[in] _format Channel order of the packed colors.
+      /// \param[out] _rgba Array of at least 4 * _count values, written
+      /// with the red, green, blue and alpha of each color, in [0..1].
+      /// \param[in] _srgb True if the red, green and blue bytes are sRGB
+      /// encoded, in which case they are converted to linear values with
+      /// a lookup table. Alpha is always linear.
+      public: static void Unpack(const unsigned int *_packed,
+                                 const std::size_t _count,
+                                 const PackedFormat _format, float *_rgba,
+                                 const bool _srgb = false);
+
+      /// \brief Pack an array of colors, as AsRGBA and the other As
+      /// functions do for one color.
+      /// \param[in] _rgba Array of 4 * _count values, the red, green, blue
+      /// and alpha of each color. Values are clamped to [0..1], and NaN is
+      /// packed as 0.
+      /// \param[in] _count Number of colors.
+      /// \param[in] _format Channel order of the packed colors.
+      /// \param[out] _packed Array of at least _count packed colors.
+      /// \param[in] _srgb True to encode the red, green and blue values as
+      /// sRGB with a lookup table, rounded to the nearest byte within one
+      /// unit. Otherwise, and for alpha, values are truncated as in AsRGBA.
+      public: static void Pack(const float *_rgba, const std::size_t _count,
+                               const PackedFormat _format,
+                               unsigned int *_packed,
+                               const bool _srgb = false);
+
+      /// \brief Convert an array of colors to HSV, as HSV() does for one
+      /// color.
+      /// \param[in] _rgba Array of 4 * _count values, the red, green, blue
+      /// and alpha of each color. Alpha is ignored.
+      /// \param[in] _count Number of colors.
+      /// \param[out] _hsv Array of at least 3 * _count values, written with
+      /// the hue, saturation and value of each color.
+      public: static void RGBAToHSV(const float *_rgba,
+                                    const std::size_t _count, float *_hsv);
+
+      /// \brief Convert an array of HSV values to colors, as SetFromHSV
+      /// does for one color.
+      /// \param[in] _hsv Array of 3 * _count values, the hue,
+      /// saturation and value of each color.
+      /// \param[in] _count Number of colors.
+      /// \param[in,out] _rgba Array of at least 4 * _count values. The red,
+      /// green and blue of each color are written, and alpha is left
+      /// unchanged.
+      public: static void HSVToRGBA(const float *_hsv,
+                                    const std::size_t _count, float *_rgba);
+
+      /// \brief Convert an array of colors to YUV, as YUV() does for one
+      /// color.
+      /// \param[in] _rgba Array of 4 * _count values, the red, green, blue
+      /// and alpha of each color. Alpha is ignored.
+      /// \param[in] _count Number of colors.
+      /// \param[out] _yuv Array of at least 3 * _count values, written with
+      /// the YUV values of each color.
+      public: static void RGBAToYUV(const float *_rgba,
+                                    const std::size_t _count, float *_yuv);
+
+      /// \brief Convert an array of YUV values to colors, as SetFromYUV
+      /// does for one color.
+      /// \param[in] _yuv Array of 3 * _count YUV values.
+      /// \param[in] _count Number of colors.
+      /// \param[in,out] _rgba Array of at least 4 * _count values. The red,
+      /// green and blue of each color are written, and alpha is left
+      /// unchanged.
+      public: static void YUVToRGBA(const float *_yuv,
+                                    const std::size_t _count, float *_rgba);
+
       /// \brief Addition operator (this + _pt)
       /// \param[in] _pt Color to add
       /// \return The resulting color
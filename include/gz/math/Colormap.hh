@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_COLORMAP_HH_
+#define GZ_MATH_COLORMAP_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gz/math/Color.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  //
+  // Forward declare private data
+  class ColormapPrivate;
+
+  /// \class Colormap Colormap.hh ignition/math/Colormap.hh
+  /// \brief Mapping of scalar values to colors, to visualize scalar
+  /// fields, depth or intensity.
+  ///
+  /// A colormap is a lookup table of Size() colors, built once from
+  /// color stops. Each table is kept packed in every Color::PackedFormat,
+  /// so that Map converts an array of values to packed colors with a
+  /// single load per value, and no Color is created per value. Values are
+  /// scaled from a range to the table, clamped to its ends, and rounded
+  /// to the nearest entry. NaN values, such as the points where a
+  /// PiecewiseScalarField3 is not defined, get NanColor().
+  ///
+  /// Viridis(), Jet() and Turbo() are the common colormaps, built on
+  /// first use and shared.
+  ///
+  /// # Example usage
+  ///
+  /// \code{.cpp}
+  /// std::vector<double> values(points.size());
+  /// field.Evaluate(points.data(), points.size(), values.data());
+  ///
+  /// std::vector<unsigned int> colors(points.size());
+  /// gz::math::Colormap::Viridis().Map(values.data(), values.size(),
+  ///     0.0, 10.0, gz::math::Color::PACKED_RGBA, colors.data());
+  /// \endcode
+  class IGNITION_MATH_VISIBLE Colormap
+  {
+    /// \brief Default number of colors of the lookup table.
+    public: static constexpr std::size_t kDefaultSize = 256;
+
+    /// \brief Default constructor, a grayscale colormap from black to
+    /// white.
+    public: Colormap();
+
+    /// \brief Constructor from evenly spaced color stops. The colors
+    /// between the stops are linearly interpolated, alpha included.
+    /// \param[in] _colors Colors of the stops, from the lowest to the
+    /// highest value. A single color makes a uniform colormap.
+    /// \param[in] _size Number of colors of the lookup table.
+    /// \sa Valid()
+    public: explicit Colormap(const std::vector<Color> &_colors,
+                              const std::size_t _size = kDefaultSize);
+
+    /// \brief Constructor from color stops at given positions.
+    /// \param[in] _positions Positions of the stops, increasing from 0 to
+    /// 1.
+    /// \param[in] _colors Colors of the stops, one per position.
+    /// \param[in] _size Number of colors of the lookup table.
+    /// \sa Valid()
+    public: Colormap(const std::vector<float> &_positions,
+                     const std::vector<Color> &_colors,
+                     const std::size_t _size = kDefaultSize);
+
+    /// \brief Copy constructor.
+    /// \param[in] _other The colormap to copy.
+    public: Colormap(const Colormap &_other);
+
+    /// \brief Move constructor.
+    /// \param[in] _other The colormap to move.
+    public: Colormap(Colormap &&_other) noexcept;
+
+    /// \brief Destructor.
+    public: ~Colormap();
+
+    /// \brief Copy assignment operator.
+    /// \param[in] _other The colormap to copy.
+    /// \return Reference to this colormap.
+    public: Colormap &operator=(const Colormap &_other);
+
+    /// \brief Move assignment operator.
+    /// \param[in] _other The colormap to move.
+    /// \return Reference to this colormap.
+    public: Colormap &operator=(Colormap &&_other) noexcept;
+
+    /// \brief The perceptually uniform viridis colormap, from dark blue
+    /// to yellow, interpolated from 11 stops of the matplotlib colormap.
+    /// \return Reference to the shared colormap.
+    public: static const Colormap &Viridis();
+
+    /// \brief The jet colormap, from dark blue through cyan, yellow and
+    /// red to dark red, as in MATLAB.
+    /// \return Reference to the shared colormap.
+    public: static const Colormap &Jet();
+
+    /// \brief The turbo colormap, an improved rainbow colormap, computed
+    /// with the polynomial approximation published by its authors.
+    /// \return Reference to the shared colormap.
+    public: static const Colormap &Turbo();
+
+    /// \brief Get whether the colormap was built from valid stops: at
+    /// least one color, as many positions as colors, and a size of at
+    /// least one. The positions of several stops must increase from 0 to
+    /// 1. An invalid colormap has no colors, and maps every value to
+    /// NanColor().
+    /// \return True if the colormap is valid.
+    public: bool Valid() const;
+
+    /// \brief Get the number of colors of the lookup table.
+    /// \return Number of colors, 0 if the colormap is invalid.
+    public: std::size_t Size() const;
+
+    /// \brief Set the color of NaN values. It is transparent black by
+    /// default.
+    /// \param[in] _color The color.
+    public: void SetNanColor(const Color &_color);
+
+    /// \brief Get the color of NaN values.
+    /// \return The color.
+    public: Color NanColor() const;
+
+    /// \brief Get the color of a value in [0, 1], through the lookup
+    /// table.
+    /// \param[in] _t The value, clamped to [0, 1].
+    /// \return The color of the nearest entry of the table, or NanColor()
+    /// if _t is NaN.
+    public: Color At(const float _t) const;
+
+    /// \brief Map an array of values to packed colors.
+    /// \param[in] _values The values.
+    /// \param[in] _count Number of values.
+    /// \param[in] _min Value of the first color of the table.
+    /// \param[in] _max Value of the last color of the table. If it is not
+    /// above _min, every value that isn't NaN gets the first color.
+    /// \param[in] _format Channel order of the packed colors.
+    /// \param[out] _packed Array of at least _count packed colors.
+    public: void Map(const float *_values, const std::size_t _count,
+                     const float _min, const float _max,
+                     const Color::PackedFormat _format,
+                     unsigned int *_packed) const;
+
+    /// \brief Map an array of values to packed colors, such as the
+    /// results of PiecewiseScalarField3::Evaluate.
+    /// \param[in] _values The values.
+    /// \param[in] _count Number of values.
+    /// \param[in] _min Value of the first color of the table.
+    /// \param[in] _max Value of the last color of the table.
+    /// \param[in] _format Channel order of the packed colors.
+    /// \param[out] _packed Array of at least _count packed colors.
+    public: void Map(const double *_values, const std::size_t _count,
+                     const double _min, const double _max,
+                     const Color::PackedFormat _format,
+                     unsigned int *_packed) const;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<ColormapPrivate> dataPtr;
+  };
+}
+}
+}
+#endif
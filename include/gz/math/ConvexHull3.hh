@@ -0,0 +1,712 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_CONVEXHULL3_HH_
+#define GZ_MATH_CONVEXHULL3_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class ConvexHull3 ConvexHull3.hh ignition/math/ConvexHull3.hh
+    /// \brief Convex hull of a set of 3D points, computed with Quickhull.
+    ///
+    /// The hull is a closed triangle mesh whose vertices are a subset of
+    /// the input points, wound counter-clockwise when seen from outside,
+    /// so that it can be passed to MeshMassProperties. It is usually much
+    /// smaller than the input, which speeds up bounding box fits, mass
+    /// properties and support queries.
+    ///
+    /// Points closer to the hull than a tolerance scaled to the extent of
+    /// the input are treated as inside. Coplanar faces are not merged, so
+    /// points on a flat side of the hull may be kept as vertices if they
+    /// are added before the corners of that side. Points that are not
+    /// finite are ignored.
+    ///
+    /// The points are kept in intrusive lists over arrays that are
+    /// reused by the next call to Build(), so rebuilding a hull of a
+    /// similar size does not allocate.
+    template<typename T>
+    class ConvexHull3
+    {
+      /// \brief Index reported when no point is found.
+      public: static constexpr std::size_t kNoPoint =
+        std::numeric_limits<std::size_t>::max();
+
+      /// \brief Default constructor, for an empty hull.
+      public: ConvexHull3() = default;
+
+      /// \brief Compute the hull of a set of points, replacing the
+      /// previous hull.
+      /// \param[in] _points The points.
+      /// \param[in] _threads Number of threads used to assign the points
+      /// to the faces of the first tetrahedron, which is the pass over all
+      /// the points. A value of 0 uses the number of hardware threads.
+      /// Small sets always use a single thread. The hull is the same for
+      /// any number of threads.
+      /// \return True if the hull has a volume, false if there are fewer
+      /// than 4 points that are not coplanar, in which case the hull is
+      /// empty.
+      public: bool Build(const std::vector<Vector3<T>> &_points,
+                         const unsigned int _threads = 1)
+      {
+        return this->Build(_points.data(), _points.size(), _threads);
+      }
+
+      /// \brief Compute the hull of an array of points, replacing the
+      /// previous hull. The points are not copied.
+      /// \param[in] _points The points.
+      /// \param[in] _count Number of points.
+      /// \param[in] _threads Number of threads used to assign the points
+      /// to the faces of the first tetrahedron. See Build() above.
+      /// \return True if the hull has a volume.
+      public: bool Build(const Vector3<T> *_points, const std::size_t _count,
+                         const unsigned int _threads = 1)
+      {
+        this->vertices.clear();
+        this->inputIndices.clear();
+        this->indices.clear();
+        this->normals.clear();
+        this->offsets.clear();
+        this->faces.clear();
+        this->freeFaces.clear();
+        this->tolerance = 0;
+
+        if (!this->Start(_points, _count, _threads))
+          return false;
+
+        while (!this->work.empty())
+        {
+          const std::size_t f = this->work.back();
+          this->work.pop_back();
+          if (this->faces[f].alive && this->faces[f].outside != kNoPoint)
+            this->AddPoint(_points, this->faces[f].farthest, f);
+        }
+
+        this->Collect(_points, _count);
+        return true;
+      }
+
+      /// \brief Check that the hull has a volume.
+      /// \return True if the last call to Build() succeeded.
+      public: bool Valid() const
+      {
+        return !this->indices.empty();
+      }
+
+      /// \brief Get the vertices of the hull.
+      /// \return The vertices, in the order of the input points.
+      public: const std::vector<Vector3<T>> &Vertices() const
+      {
+        return this->vertices;
+      }
+
+      /// \brief Get the index in the input of each vertex of the hull.
+      /// \return One index into the points passed to Build() per vertex.
+      public: const std::vector<std::size_t> &InputIndices() const
+      {
+        return this->inputIndices;
+      }
+
+      /// \brief Get the triangles of the hull.
+      /// \return Three indices into Vertices() per triangle, wound
+      /// counter-clockwise when seen from outside.
+      public: const std::vector<std::size_t> &Indices() const
+      {
+        return this->indices;
+      }
+
+      /// \brief Get the number of triangles of the hull.
+      /// \return A third of the number of indices.
+      public: std::size_t TriangleCount() const
+      {
+        return this->indices.size() / 3;
+      }
+
+      /// \brief Get the distance below which points are treated as lying
+      /// on the hull.
+      /// \return The tolerance, scaled to the extent of the input points.
+      public: T Tolerance() const
+      {
+        return this->tolerance;
+      }
+
+      /// \brief Check if a point is inside of the hull, up to Tolerance().
+      /// \param[in] _point The point.
+      /// \return True if the point is inside of or on the hull.
+      public: bool Contains(const Vector3<T> &_point) const
+      {
+        if (!this->Valid())
+          return false;
+        for (std::size_t i = 0; i < this->offsets.size(); ++i)
+        {
+          if (this->normals[i].Dot(_point) - this->offsets[i] >
+              this->tolerance)
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      /// \brief Get the vertex of the hull that is farthest along a
+      /// direction, as used by GJK.
+      /// \param[in] _dir The direction, which needs not be normalized.
+      /// \return Index into Vertices() of the vertex, or kNoPoint if the
+      /// hull is empty.
+      public: std::size_t Support(const Vector3<T> &_dir) const
+      {
+        std::size_t best = kNoPoint;
+        T bestDot = -std::numeric_limits<T>::infinity();
+        for (std::size_t i = 0; i < this->vertices.size(); ++i)
+        {
+          const T dot = this->vertices[i].Dot(_dir);
+          if (dot > bestDot)
+          {
+            bestDot = dot;
+            best = i;
+          }
+        }
+        return best;
+      }
+
+      /// \brief A triangle of the hull under construction.
+      private: struct Face
+      {
+        /// \brief Input indices of the vertices, counter-clockwise.
+        std::size_t v[3];
+
+        /// \brief Face across edge v[i] -> v[(i + 1) % 3].
+        std::size_t adj[3];
+
+        /// \brief Outward unit normal.
+        Vector3<T> normal;
+
+        /// \brief Distance of the plane from the origin along the normal.
+        T offset;
+
+        /// \brief First point of the list of points above the face.
+        std::size_t outside;
+
+        /// \brief Point of the list farthest above the face.
+        std::size_t farthest;
+
+        /// \brief Distance of the farthest point above the face.
+        T farthestDistance;
+
+        /// \brief Whether the face is part of the hull.
+        bool alive;
+
+        /// \brief Whether the face is seen from the point being added.
+        bool visible;
+      };
+
+      /// \brief An edge of the boundary of the faces seen from a point.
+      private: struct HorizonEdge
+      {
+        /// \brief Input index of the first vertex.
+        std::size_t from;
+
+        /// \brief Input index of the second vertex.
+        std::size_t to;
+
+        /// \brief Face across the edge that is not seen from the point.
+        std::size_t face;
+
+        /// \brief Index of the edge in that face.
+        int edge;
+      };
+
+      /// \brief Step of the depth first search of the faces seen from a
+      /// point.
+      private: struct Visit
+      {
+        /// \brief Face being visited.
+        std::size_t face;
+
+        /// \brief First edge to cross.
+        int edge;
+
+        /// \brief Number of edges crossed so far.
+        int count;
+      };
+
+      /// \brief Check that a point can be used.
+      /// \param[in] _point The point.
+      /// \return True if all the coordinates are finite.
+      private: static bool Finite(const Vector3<T> &_point)
+      {
+        return std::isfinite(_point.X()) && std::isfinite(_point.Y()) &&
+               std::isfinite(_point.Z());
+      }
+
+      /// \brief Get the signed distance of a point above a face.
+      /// \param[in] _face The face.
+      /// \param[in] _point The point.
+      /// \return The distance, positive outside.
+      private: static T Distance(const Face &_face, const Vector3<T> &_point)
+      {
+        return _face.normal.Dot(_point) - _face.offset;
+      }
+
+      /// \brief Find the initial tetrahedron and assign the points to its
+      /// faces.
+      /// \param[in] _points The points.
+      /// \param[in] _count Number of points.
+      /// \param[in] _threads Number of threads for the assignment.
+      /// \return False if the points have no volume.
+      private: bool Start(const Vector3<T> *_points, const std::size_t _count,
+                          const unsigned int _threads)
+      {
+        // Extreme points along each axis, and the extent of the input.
+        std::size_t extremes[6];
+        std::fill(extremes, extremes + 6, kNoPoint);
+        Vector3<T> maxAbs = Vector3<T>::Zero;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const Vector3<T> &p = _points[i];
+          if (!Finite(p))
+            continue;
+          for (int a = 0; a < 3; ++a)
+          {
+            if (extremes[a] == kNoPoint || p[a] < _points[extremes[a]][a])
+              extremes[a] = i;
+            if (extremes[a + 3] == kNoPoint ||
+                p[a] > _points[extremes[a + 3]][a])
+            {
+              extremes[a + 3] = i;
+            }
+            maxAbs[a] = std::max(maxAbs[a], std::abs(p[a]));
+          }
+        }
+        if (extremes[0] == kNoPoint)
+          return false;
+        this->tolerance = 3 * std::numeric_limits<T>::epsilon() *
+            (maxAbs.X() + maxAbs.Y() + maxAbs.Z());
+
+        // The two extreme points farthest apart.
+        std::size_t i0 = extremes[0];
+        std::size_t i1 = extremes[3];
+        T best = 0;
+        for (int a = 0; a < 3; ++a)
+        {
+          const T d = (_points[extremes[a + 3]] -
+              _points[extremes[a]]).SquaredLength();
+          if (d > best)
+          {
+            best = d;
+            i0 = extremes[a];
+            i1 = extremes[a + 3];
+          }
+        }
+        if (std::sqrt(best) <= this->tolerance)
+          return false;
+
+        // The point farthest from their line, then from their plane.
+        const Vector3<T> &p0 = _points[i0];
+        const Vector3<T> axis = (_points[i1] - p0).Normalized();
+        std::size_t i2 = kNoPoint;
+        best = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (!Finite(_points[i]))
+            continue;
+          const T d = (_points[i] - p0).Cross(axis).SquaredLength();
+          if (d > best)
+          {
+            best = d;
+            i2 = i;
+          }
+        }
+        if (i2 == kNoPoint || std::sqrt(best) <= this->tolerance)
+          return false;
+
+        const Vector3<T> normal =
+            (_points[i1] - p0).Cross(_points[i2] - p0).Normalized();
+        std::size_t i3 = kNoPoint;
+        best = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (!Finite(_points[i]))
+            continue;
+          const T d = std::abs(normal.Dot(_points[i] - p0));
+          if (d > best)
+          {
+            best = d;
+            i3 = i;
+          }
+        }
+        if (i3 == kNoPoint || best <= this->tolerance)
+          return false;
+
+        // Wind the base away from the apex, so that all faces point out.
+        if (normal.Dot(_points[i3] - p0) > 0)
+          std::swap(i1, i2);
+
+        // Faces and their neighbors, with the edges of each face in order.
+        this->NewFace(_points, i0, i1, i2);
+        this->NewFace(_points, i0, i3, i1);
+        this->NewFace(_points, i1, i3, i2);
+        this->NewFace(_points, i2, i3, i0);
+        this->Link(0, 0, 1, 2);
+        this->Link(0, 1, 2, 2);
+        this->Link(0, 2, 3, 2);
+        this->Link(1, 0, 3, 1);
+        this->Link(1, 1, 2, 0);
+        this->Link(2, 1, 3, 0);
+
+        // Assign each point to the first face it is above.
+        this->next.assign(_count, kNoPoint);
+        this->assignment.assign(_count, kNoFace);
+        auto assign = [&](const std::size_t _begin, const std::size_t _end)
+        {
+          for (std::size_t i = _begin; i < _end; ++i)
+          {
+            if (i == i0 || i == i1 || i == i2 || i == i3 ||
+                !Finite(_points[i]))
+            {
+              continue;
+            }
+            for (uint8_t f = 0; f < 4; ++f)
+            {
+              if (Distance(this->faces[f], _points[i]) > this->tolerance)
+              {
+                this->assignment[i] = f;
+                break;
+              }
+            }
+          }
+        };
+
+        std::size_t threads = _threads;
+        if (threads == 0)
+          threads = std::thread::hardware_concurrency();
+        threads = std::min(threads, _count / kMinPointsPerThread);
+        if (threads <= 1)
+        {
+          assign(0, _count);
+        }
+        else
+        {
+          std::vector<std::thread> workers;
+          for (std::size_t t = 1; t < threads; ++t)
+          {
+            workers.emplace_back(assign, _count * t / threads,
+                                 _count * (t + 1) / threads);
+          }
+          assign(0, _count / threads);
+          for (auto &worker : workers)
+            worker.join();
+        }
+
+        // The lists are linked in input order whatever the threads.
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (this->assignment[i] != kNoFace)
+            this->AddOutside(_points, this->assignment[i], i);
+        }
+
+        this->work.clear();
+        for (std::size_t f = 0; f < 4; ++f)
+        {
+          if (this->faces[f].outside != kNoPoint)
+            this->work.push_back(f);
+        }
+        return true;
+      }
+
+      /// \brief Create a face, reusing the slot of a removed face if any.
+      /// \param[in] _points The points.
+      /// \param[in] _a Input index of the first vertex.
+      /// \param[in] _b Input index of the second vertex.
+      /// \param[in] _c Input index of the third vertex.
+      /// \return Index of the face.
+      private: std::size_t NewFace(const Vector3<T> *_points,
+                                   const std::size_t _a, const std::size_t _b,
+                                   const std::size_t _c)
+      {
+        std::size_t index;
+        if (this->freeFaces.empty())
+        {
+          index = this->faces.size();
+          this->faces.emplace_back();
+        }
+        else
+        {
+          index = this->freeFaces.back();
+          this->freeFaces.pop_back();
+        }
+
+        Face &face = this->faces[index];
+        face.v[0] = _a;
+        face.v[1] = _b;
+        face.v[2] = _c;
+        face.adj[0] = face.adj[1] = face.adj[2] = kNoPoint;
+        face.normal = (_points[_b] - _points[_a]).Cross(
+            _points[_c] - _points[_a]).Normalized();
+        face.offset = face.normal.Dot(_points[_a]);
+        face.outside = kNoPoint;
+        face.farthest = kNoPoint;
+        face.farthestDistance = 0;
+        face.alive = true;
+        face.visible = false;
+        return index;
+      }
+
+      /// \brief Make two faces neighbors across an edge.
+      /// \param[in] _f First face.
+      /// \param[in] _e Edge of the first face.
+      /// \param[in] _g Second face.
+      /// \param[in] _h Edge of the second face.
+      private: void Link(const std::size_t _f, const int _e,
+                         const std::size_t _g, const int _h)
+      {
+        this->faces[_f].adj[_e] = _g;
+        this->faces[_g].adj[_h] = _f;
+      }
+
+      /// \brief Add a point to the list of points above a face.
+      /// \param[in] _points The points.
+      /// \param[in] _f The face.
+      /// \param[in] _i Input index of the point.
+      private: void AddOutside(const Vector3<T> *_points, const std::size_t _f,
+                               const std::size_t _i)
+      {
+        Face &face = this->faces[_f];
+        const T d = Distance(face, _points[_i]);
+        this->next[_i] = face.outside;
+        face.outside = _i;
+        if (face.farthest == kNoPoint || d > face.farthestDistance)
+        {
+          face.farthest = _i;
+          face.farthestDistance = d;
+        }
+      }
+
+      /// \brief Add a point to the hull, replacing the faces it sees.
+      /// \param[in] _points The points.
+      /// \param[in] _eye Input index of the point.
+      /// \param[in] _start A face that sees the point.
+      private: void AddPoint(const Vector3<T> *_points, const std::size_t _eye,
+                             const std::size_t _start)
+      {
+        const Vector3<T> &eye = _points[_eye];
+
+        // Depth first search of the faces seen from the point. Crossing
+        // the edges of each face in order from the one it was entered by
+        // lists the horizon as a closed loop.
+        this->horizon.clear();
+        this->visible.clear();
+        this->stack.clear();
+        this->faces[_start].visible = true;
+        this->visible.push_back(_start);
+        this->stack.push_back({_start, 0, 0});
+        while (!this->stack.empty())
+        {
+          Visit &top = this->stack.back();
+          if (top.count == 3)
+          {
+            this->stack.pop_back();
+            continue;
+          }
+          const std::size_t f = top.face;
+          const int e = (top.edge + top.count) % 3;
+          ++top.count;
+
+          const std::size_t n = this->faces[f].adj[e];
+          Face &neighbor = this->faces[n];
+          if (neighbor.visible)
+            continue;
+
+          int back = 0;
+          while (neighbor.adj[back] != f)
+            ++back;
+          if (Distance(neighbor, eye) > 0)
+          {
+            neighbor.visible = true;
+            this->visible.push_back(n);
+            this->stack.push_back({n, (back + 1) % 3, 0});
+          }
+          else
+          {
+            this->horizon.push_back({this->faces[f].v[e],
+                this->faces[f].v[(e + 1) % 3], n, back});
+          }
+        }
+
+        // Gather the points above the faces that are removed.
+        this->orphans.clear();
+        for (const std::size_t f : this->visible)
+        {
+          Face &face = this->faces[f];
+          for (std::size_t i = face.outside; i != kNoPoint; i = this->next[i])
+          {
+            if (i != _eye)
+              this->orphans.push_back(i);
+          }
+          face.alive = false;
+          this->freeFaces.push_back(f);
+        }
+
+        // Fan of new faces from the horizon to the point.
+        this->created.clear();
+        for (const HorizonEdge &edge : this->horizon)
+        {
+          const std::size_t f = this->NewFace(_points, edge.from, edge.to,
+                                              _eye);
+          this->Link(f, 0, edge.face, edge.edge);
+          this->created.push_back(f);
+        }
+        const std::size_t count = this->created.size();
+        for (std::size_t k = 0; k < count; ++k)
+          this->Link(this->created[k], 1, this->created[(k + 1) % count], 2);
+
+        // Reassign the points, dropping the ones now inside.
+        for (const std::size_t i : this->orphans)
+        {
+          for (const std::size_t f : this->created)
+          {
+            if (Distance(this->faces[f], _points[i]) > this->tolerance)
+            {
+              this->AddOutside(_points, f, i);
+              break;
+            }
+          }
+        }
+        for (const std::size_t f : this->created)
+        {
+          if (this->faces[f].outside != kNoPoint)
+            this->work.push_back(f);
+        }
+      }
+
+      /// \brief Copy the faces of the hull to the output buffers.
+      /// \param[in] _points The points.
+      /// \param[in] _count Number of points.
+      private: void Collect(const Vector3<T> *_points,
+                            const std::size_t _count)
+      {
+        // Vertices in input order.
+        this->next.assign(_count, kNoPoint);
+        for (const Face &face : this->faces)
+        {
+          if (!face.alive)
+            continue;
+          for (const std::size_t v : face.v)
+            this->next[v] = 0;
+        }
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (this->next[i] == kNoPoint)
+            continue;
+          this->next[i] = this->vertices.size();
+          this->vertices.push_back(_points[i]);
+          this->inputIndices.push_back(i);
+        }
+
+        for (const Face &face : this->faces)
+        {
+          if (!face.alive)
+            continue;
+          for (const std::size_t v : face.v)
+            this->indices.push_back(this->next[v]);
+          this->normals.push_back(face.normal);
+          this->offsets.push_back(face.offset);
+        }
+      }
+
+      /// \brief Face index reported for points inside of the first
+      /// tetrahedron.
+      private: static constexpr uint8_t kNoFace = 255;
+
+      /// \brief Minimum number of points assigned by each thread.
+      private: static constexpr std::size_t kMinPointsPerThread = 16384;
+
+      /// \brief Vertices of the hull.
+      private: std::vector<Vector3<T>> vertices;
+
+      /// \brief Input index of each vertex.
+      private: std::vector<std::size_t> inputIndices;
+
+      /// \brief Three vertex indices per triangle.
+      private: std::vector<std::size_t> indices;
+
+      /// \brief Outward unit normal of each triangle.
+      private: std::vector<Vector3<T>> normals;
+
+      /// \brief Offset of the plane of each triangle.
+      private: std::vector<T> offsets;
+
+      /// \brief Distance below which points lie on the hull.
+      private: T tolerance = 0;
+
+      /// \brief Faces under construction, alive or removed.
+      private: std::vector<Face> faces;
+
+      /// \brief Removed faces whose slots can be reused.
+      private: std::vector<std::size_t> freeFaces;
+
+      /// \brief Next point in the list of each point, by input index.
+      /// Also the vertex index of each input point once done.
+      private: std::vector<std::size_t> next;
+
+      /// \brief Face of the first tetrahedron of each point.
+      private: std::vector<uint8_t> assignment;
+
+      /// \brief Faces that may have points above them.
+      private: std::vector<std::size_t> work;
+
+      /// \brief Horizon of the point being added.
+      private: std::vector<HorizonEdge> horizon;
+
+      /// \brief Faces seen from the point being added.
+      private: std::vector<std::size_t> visible;
+
+      /// \brief Stack of the search of the faces seen from a point.
+      private: std::vector<Visit> stack;
+
+      /// \brief Points above the faces being removed.
+      private: std::vector<std::size_t> orphans;
+
+      /// \brief Faces created for the point being added.
+      private: std::vector<std::size_t> created;
+    };
+
+    /// \typedef ConvexHull3<double> ConvexHull3d
+    /// \brief ConvexHull3 with double precision.
+    typedef ConvexHull3<double> ConvexHull3d;
+
+    /// \typedef ConvexHull3<float> ConvexHull3f
+    /// \brief ConvexHull3 with float precision.
+    typedef ConvexHull3<float> ConvexHull3f;
+    }
+  }
+}
+#endif
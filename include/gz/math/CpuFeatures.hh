@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_CPUFEATURES_HH_
+#define GZ_MATH_CPUFEATURES_HH_
+
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \enum SimdLevel
+    /// \brief Instruction sets of the SIMD kernels of the library. The x86
+    /// levels are ordered: a CPU which supports a level supports the levels
+    /// before it.
+    ///
+    /// Batch kernels compiled into the library, such as the culling of
+    /// Frustum, select their instruction set at run time from
+    /// ActiveSimdLevel(), so a single build uses the widest instructions of
+    /// each CPU it runs on. Kernels inlined from headers, such as those of
+    /// Matrix4 and Vector3SoA, use the instruction sets enabled when the
+    /// calling code is compiled.
+    enum class SimdLevel
+    {
+      /// \brief Portable scalar code.
+      SCALAR = 0,
+
+      /// \brief x86 SSE2.
+      SSE2 = 1,
+
+      /// \brief x86 AVX.
+      AVX = 2,
+
+      /// \brief x86 AVX2 and FMA.
+      AVX2 = 3,
+
+      /// \brief x86 AVX-512 foundation.
+      AVX512 = 4,
+
+      /// \brief ARM NEON.
+      NEON = 5
+    };
+
+    /// \brief Get the widest instruction set supported by the CPU and the
+    /// operating system. This is detected once, on the first call.
+    /// \return The instruction set.
+    SimdLevel IGNITION_MATH_VISIBLE SupportedSimdLevel();
+
+    /// \brief Get the instruction set used by the batch kernels of the
+    /// library, for diagnostics. This is SupportedSimdLevel() by default,
+    /// or SCALAR if the library was built with IGNITION_MATH_DISABLE_SIMD.
+    /// The IGNITION_MATH_SIMD environment variable, read on the first
+    /// call, can select a narrower instruction set by name, such as "sse2"
+    /// or "scalar". Kernels without a version for the active instruction
+    /// set use the widest narrower version they have.
+    /// \return The instruction set.
+    SimdLevel IGNITION_MATH_VISIBLE ActiveSimdLevel();
+
+    /// \brief Set the instruction set used by the batch kernels of the
+    /// library, such as to compare the results of several kernels. Batch
+    /// operations running in other threads may use either instruction set.
+    /// \param[in] _level The instruction set.
+    /// \return True if the CPU supports the instruction set and it was
+    /// selected, false otherwise.
+    bool IGNITION_MATH_VISIBLE SetActiveSimdLevel(const SimdLevel _level);
+
+    /// \brief Get the name of an instruction set, such as "avx2".
+    /// \param[in] _level The instruction set.
+    /// \return The lowercase name, or "unknown" for invalid values.
+    IGNITION_MATH_VISIBLE const char *SimdLevelName(const SimdLevel _level);
+    }
+  }
+}
+#endif
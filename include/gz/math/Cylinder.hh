@@ -17,8 +17,11 @@
 #ifndef GZ_MATH_CYLINDER_HH_
 #define GZ_MATH_CYLINDER_HH_
 
+#include <cstddef>
+#include <tuple>
 #include "gz/math/MassMatrix3.hh"
 #include "gz/math/Material.hh"
+#include "gz/math/Pose3.hh"
 #include "gz/math/Quaternion.hh"
 
 namespace ignition
@@ -150,6 +153,106 @@ namespace ignition
       /// \sa Precision DensityFromMass(const Precision _mass) const
       public: bool SetDensityFromMass(const Precision _mass);
 
+      /// \brief Compute the volumes of many cylinders. Each result is the
+      /// same as Volume() of a cylinder with the corresponding length and
+      /// radius.
+      /// \param[in] _lengths Array of _count cylinder lengths.
+      /// \param[in] _radii Array of _count cylinder radii.
+      /// \param[in] _count Number of cylinders.
+      /// \param[out] _volumes Array of at least _count values, written with
+      /// the volume of each cylinder in m^3.
+      public: static void Volumes(const Precision *_lengths,
+                                  const Precision *_radii,
+                                  const std::size_t _count,
+                                  Precision *_volumes);
+
+      /// \brief Compute the densities of many cylinders from their masses.
+      /// Each result is the same as DensityFromMass of a cylinder with the
+      /// corresponding length and radius.
+      /// \param[in] _lengths Array of _count cylinder lengths.
+      /// \param[in] _radii Array of _count cylinder radii.
+      /// \param[in] _masses Array of _count masses, in kg.
+      /// \param[in] _count Number of cylinders.
+      /// \param[out] _densities Array of at least _count values, written
+      /// with the density of each cylinder in kg/m^3, or a negative value if
+      /// the radius, length or mass is <= 0.
+      public: static void DensitiesFromMasses(const Precision *_lengths,
+                                              const Precision *_radii,
+                                              const Precision *_masses,
+                                              const std::size_t _count,
+                                              Precision *_densities);
+
+      /// \brief Compute the mass matrices of many cylinders of uniform
+      /// density, aligned with the Z axis. Each result is the same as
+      /// MassMatrix of a cylinder with the corresponding length, radius
+      /// and density, and no rotational offset, without constructing a
+      /// Material.
+      /// \param[in] _lengths Array of _count cylinder lengths.
+      /// \param[in] _radii Array of _count cylinder radii.
+      /// \param[in] _densities Array of _count densities, in kg/m^3.
+      /// \param[in] _count Number of cylinders.
+      /// \param[out] _massMats Array of at least _count mass matrices.
+      /// Cylinders with a radius, length or density <= 0 are written with a
+      /// default constructed mass matrix, which has zero mass.
+      /// \return True if the mass matrix of every cylinder was computed.
+      public: static bool MassMatrices(const Precision *_lengths,
+                                       const Precision *_radii,
+                                       const Precision *_densities,
+                                       const std::size_t _count,
+                                       MassMatrix3<Precision> *_massMats);
+
+      /// \brief Check if a ray (origin, direction) hits the surface of the
+      /// cylinder.
+      /// \param[in] _pose Pose of the center of the cylinder, whose axis is
+      /// along Z rotated by the rotational offset, in the frame of the ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return A boolean and Precision tuple. The boolean value is true if
+      /// the ray hits the surface between the distances _min and _max from
+      /// _origin; rays starting inside hit it where they leave. The
+      /// Precision is the distance from _origin to the hit minus _min, as
+      /// in AxisAlignedBox::IntersectDist, or zero when the boolean value
+      /// is false.
+      public: std::tuple<bool, Precision> IntersectDist(
+                  const Pose3<Precision> &_pose,
+                  const Vector3<Precision> &_origin,
+                  const Vector3<Precision> &_dir,
+                  const Precision _min, const Precision _max) const;
+
+      /// \brief Intersect a bundle of rays from the same origin, such as
+      /// the beams of a range sensor, with the cylinder. Calling it for every
+      /// shape of a scene with the same ranges leaves the distance of the
+      /// closest hit of each ray.
+      /// \param[in] _pose Pose of the center of the cylinder, whose axis is
+      /// along Z rotated by the rotational offset, in the frame of the rays.
+      /// \param[in] _origin Origin of the rays.
+      /// \param[in] _dirs Array of _count unit ray directions.
+      /// \param[in] _count Number of rays.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in, out] _ranges Array of _count distances. Each one is the
+      /// maximum allowed distance of its ray, and is lowered to the
+      /// distance from _origin to the hit of the ray if there is one.
+      /// \return Number of lowered ranges.
+      public: std::size_t IntersectRays(const Pose3<Precision> &_pose,
+                                        const Vector3<Precision> &_origin,
+                                        const Vector3<Precision> *_dirs,
+                                        const std::size_t _count,
+                                        const Precision _min,
+                                        Precision *_ranges) const;
+
+      /// \brief Find where a ray is inside of the cylinder.
+      /// \param[in] _origin Origin of the ray, in the frame of the cylinder.
+      /// \param[in] _dir Unit direction of the ray, in the frame of the
+      /// cylinder.
+      /// \param[out] _tin Distance where the ray enters the cylinder.
+      /// \param[out] _tout Distance where the ray leaves the cylinder.
+      /// \return False if the line through the ray misses the cylinder.
+      private: bool RayInterval(const Vector3<Precision> &_origin,
+                                const Vector3<Precision> &_dir,
+                                Precision &_tin, Precision &_tout) const;
+
       /// \brief Radius of the cylinder.
       private: Precision radius = 0.0;
 
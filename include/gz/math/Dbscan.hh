@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DBSCAN_HH_
+#define GZ_MATH_DBSCAN_HH_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <gz/math/Executor.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  //
+  // Forward declare private data
+  class DbscanPrivate;
+
+  /// \class Dbscan Dbscan.hh ignition/math/Dbscan.hh
+  /// \brief Density-based clustering of points (DBSCAN), and Euclidean
+  /// cluster extraction. Unlike Kmeans, the number of clusters is not
+  /// chosen in advance, clusters may have any shape, and isolated points
+  /// are left out as noise.
+  ///
+  /// A point is a core point if at least MinPoints() points, itself
+  /// included, are within Epsilon() of it. Core points within Epsilon()
+  /// of each other belong to the same cluster. Other points within
+  /// Epsilon() of a core point join the cluster of the lowest such core
+  /// point, and the rest are noise. Euclidean cluster extraction is the
+  /// special case where every point is a core point: points within
+  /// Epsilon() of each other are in the same cluster.
+  ///
+  /// The neighbors of the points are found on a PointGrid with cells of
+  /// Epsilon(), in parallel, and clusters are merged with a concurrent
+  /// union-find whose roots are the lowest core point of each cluster.
+  /// Clusters are numbered by their lowest core point, so the result does
+  /// not depend on the number of threads.
+  ///
+  /// # Example usage
+  ///
+  /// ```{.cpp}
+  /// gz::math::Dbscan dbscan(0.2, 8);
+  /// std::vector<gz::math::Vector3d> centroids;
+  /// std::vector<unsigned int> labels;
+  /// dbscan.Cluster(obstaclePoints, centroids, labels);
+  /// ```
+  class IGNITION_MATH_VISIBLE Dbscan
+  {
+    /// \brief Label of the points that belong to no cluster.
+    public: static constexpr unsigned int kNoise =
+      std::numeric_limits<unsigned int>::max();
+
+    /// \brief Constructor, with an epsilon of 0.1 and 5 minimum points.
+    public: Dbscan();
+
+    /// \brief Constructor.
+    /// \param[in] _epsilon Neighborhood radius, see SetEpsilon().
+    /// \param[in] _minPoints Minimum number of points of a core point,
+    /// see SetMinPoints().
+    public: Dbscan(const double _epsilon, const std::size_t _minPoints);
+
+    /// \brief Copy constructor.
+    /// \param[in] _other Clustering to copy.
+    public: Dbscan(const Dbscan &_other);
+
+    /// \brief Destructor.
+    public: ~Dbscan();
+
+    /// \brief Assignment operator.
+    /// \param[in] _other Clustering to copy.
+    /// \return Reference to this object.
+    public: Dbscan &operator=(const Dbscan &_other);
+
+    /// \brief Set the radius of the neighborhood of a point.
+    /// \param[in] _epsilon Radius, inclusive.
+    public: void SetEpsilon(const double _epsilon);
+
+    /// \brief Get the radius of the neighborhood of a point.
+    /// \return Radius. The default is 0.1.
+    public: double Epsilon() const;
+
+    /// \brief Set the minimum number of points in the neighborhood of a
+    /// core point.
+    /// \param[in] _minPoints Number of points, including the point itself.
+    public: void SetMinPoints(const std::size_t _minPoints);
+
+    /// \brief Get the minimum number of points in the neighborhood of a
+    /// core point.
+    /// \return Number of points. The default is 5.
+    public: std::size_t MinPoints() const;
+
+    /// \brief Set the range of sizes of the clusters. The points of
+    /// smaller or larger clusters are labeled as noise, such as to drop
+    /// specks and the ground from Euclidean clusters of obstacles.
+    /// \param[in] _min Minimum number of points of a cluster.
+    /// \param[in] _max Maximum number of points of a cluster.
+    public: void SetClusterSizeLimits(const std::size_t _min,
+                                      const std::size_t _max);
+
+    /// \brief Get the minimum number of points of a cluster.
+    /// \return Number of points. The default is 1.
+    public: std::size_t MinClusterSize() const;
+
+    /// \brief Get the maximum number of points of a cluster.
+    /// \return Number of points. The default is the largest std::size_t.
+    public: std::size_t MaxClusterSize() const;
+
+    /// \brief Set the number of threads used to find the neighbors of the
+    /// points and to merge clusters.
+    /// \param[in] _threads Number of threads. A value of 0 uses the
+    /// number of hardware threads.
+    public: void SetThreadCount(const unsigned int _threads);
+
+    /// \brief Get the number of threads.
+    /// \return Number of threads. The default is 1.
+    public: unsigned int ThreadCount() const;
+
+    /// \brief Set the executor used instead of threads of its own, such
+    /// as a ThreadPool shared with other batch operations. When set, the
+    /// thread count is ignored and the points are split into
+    /// Executor::BlockCount blocks.
+    /// \param[in] _executor The executor, or nullptr to use the thread
+    /// count again.
+    public: void SetExecutor(std::shared_ptr<Executor> _executor);
+
+    /// \brief Cluster points with DBSCAN.
+    /// \param[in] _points The points. Points that are not finite are
+    /// noise.
+    /// \param[out] _centroids Vector of centroids. Each element is the
+    /// mean of the points of one cluster.
+    /// \param[out] _labels Vector of labels, one per point. Each element
+    /// is the cluster to which the point belongs, or kNoise.
+    /// \return False if there are no points or if the epsilon is not
+    /// positive and finite, in which case the outputs are not changed.
+    public: bool Cluster(const std::vector<Vector3d> &_points,
+                         std::vector<Vector3d> &_centroids,
+                         std::vector<unsigned int> &_labels) const;
+
+    /// \brief Extract Euclidean clusters, as Cluster() with a minimum of
+    /// a single point. Only points that are not finite, and the points of
+    /// clusters outside of the size limits, are noise.
+    /// \param[in] _points The points.
+    /// \param[out] _centroids Vector of centroids.
+    /// \param[out] _labels Vector of labels, one per point.
+    /// \return False if there are no points or if the epsilon is not
+    /// positive and finite.
+    public: bool EuclideanCluster(const std::vector<Vector3d> &_points,
+                                  std::vector<Vector3d> &_centroids,
+                                  std::vector<unsigned int> &_labels) const;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<DbscanPrivate> dataPtr;
+  };
+}
+}
+}
+#endif
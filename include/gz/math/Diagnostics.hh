@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_MATH_DIAGNOSTICS_HH_
+#define GZ_MATH_DIAGNOSTICS_HH_
+
+#include <functional>
+#include <sstream>
+#include <string>
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \brief Function receiving the diagnostics of the library, such as
+    /// the reason why an input was rejected. It may be called from any
+    /// thread, and from several threads at once.
+    using DiagnosticHandler = std::function<void(const std::string &)>;
+
+    /// \brief Number of diagnostics reported per second by default.
+    static constexpr unsigned int kDefaultDiagnosticRateLimit = 20;
+
+    /// \brief Set the function receiving the diagnostics of the library.
+    /// By default, they are written to std::cerr.
+    /// \param[in] _handler The function, or nullptr to write the
+    /// diagnostics to std::cerr.
+    void IGNITION_MATH_VISIBLE SetDiagnosticHandler(
+        DiagnosticHandler _handler);
+
+    /// \brief Set the number of diagnostics reported per second, over all
+    /// threads. Once the limit is reached, further diagnostics are dropped
+    /// without being formatted, and their number is reported at the start
+    /// of the next second.
+    /// \param[in] _limit Number of diagnostics per second, 0 to drop them
+    /// all. The default is kDefaultDiagnosticRateLimit.
+    void IGNITION_MATH_VISIBLE SetDiagnosticRateLimit(
+        const unsigned int _limit);
+
+    /// \brief Get the number of diagnostics reported per second.
+    /// \return The limit.
+    unsigned int IGNITION_MATH_VISIBLE DiagnosticRateLimit();
+
+    /// \brief Count a diagnostic against the rate limit. This is used by
+    /// IGN_MATH_DIAGNOSTIC to avoid formatting the dropped diagnostics.
+    /// \return True if the diagnostic should be reported.
+    bool IGNITION_MATH_VISIBLE AcquireDiagnostic();
+
+    /// \brief Pass a diagnostic to the handler. Use AcquireDiagnostic
+    /// first, or IGN_MATH_DIAGNOSTIC, to honor the rate limit.
+    /// \param[in] _message The diagnostic, without a trailing newline.
+    void IGNITION_MATH_VISIBLE ReportDiagnostic(const std::string &_message);
+    }
+  }
+}
+
+/// \brief Report a diagnostic built with the stream operators, such as
+/// IGN_MATH_DIAGNOSTIC("Vertex [" << id << "] Not found"). The message is
+/// only formatted if the rate limit allows it. Define
+/// IGNITION_MATH_DISABLE_DIAGNOSTICS to compile the diagnostics out.
+#ifdef IGNITION_MATH_DISABLE_DIAGNOSTICS
+#define IGN_MATH_DIAGNOSTIC(_msg) do {} while (false)
+#else
+#define IGN_MATH_DIAGNOSTIC(_msg) \
+  do \
+  { \
+    if (gz::math::AcquireDiagnostic()) \
+    { \
+      std::ostringstream ignMathDiagnostic; \
+      ignMathDiagnostic << _msg; \
+      gz::math::ReportDiagnostic(ignMathDiagnostic.str()); \
+    } \
+  } while (false)
+#endif
+
+#endif
@@ -78,8 +78,34 @@ namespace ignition
     /// // The left wheel has rotated, the right wheel did not rotate
     /// odom.Update(IGN_DTOR(4), IGN_DTOR(2), std::chrono::steady_clock::now());
     /// \endcode
+    ///
+    /// Init, Update and the getters are real-time safe: they never
+    /// allocate memory. The constructor, and SetVelocityRollingWindowSize
+    /// with a window size other than 10, allocate the velocity buffers.
     class IGNITION_MATH_VISIBLE DiffDriveOdometry
     {
+      /// \enum IntegrationType
+      /// \brief Methods to integrate the wheel displacements of an update
+      /// into the pose. Both assume that the wheel speeds are constant
+      /// between updates, so that the vehicle moves along an arc.
+      public: enum IntegrationType
+              {
+                /// \brief Exact arc when the heading changes by at least
+                /// 1e-6 radians in an update, second order Runge-Kutta
+                /// otherwise. This is the default.
+                HYBRID = 0,
+
+                /// \brief Exact arc for every update, in a form that keeps
+                /// full precision as the heading change goes to zero and
+                /// needs three trigonometric functions instead of four. The
+                /// pose after a constant speed arc does not depend on how
+                /// many updates it was split into, so odometry can run at a
+                /// low rate without losing accuracy on such paths. The
+                /// remaining error comes only from speed changes between
+                /// updates.
+                EXACT_ARC = 1
+              };
+
       /// \brief Constructor.
       /// \param[in] _windowSize Rolling window size used to compute the
       /// velocity mean
@@ -136,6 +162,14 @@ namespace ignition
       /// \param[in] _size The Velocity rolling window size.
       public: void SetVelocityRollingWindowSize(size_t _size);
 
+      /// \brief Set the method used to integrate the pose.
+      /// \param[in] _integration The integration method.
+      public: void SetIntegration(IntegrationType _integration);
+
+      /// \brief Get the method used to integrate the pose.
+      /// \return The integration method. The default is HYBRID.
+      public: IntegrationType Integration() const;
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
 // std::unique_ptr
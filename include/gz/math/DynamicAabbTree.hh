@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DYNAMICAABBTREE_HH_
+#define GZ_MATH_DYNAMICAABBTREE_HH_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  // Forward declaration.
+  class DynamicAabbTreePrivate;
+
+  /// \class DynamicAabbTree DynamicAabbTree.hh
+  /// ignition/math/DynamicAabbTree.hh
+  /// \brief A bounding volume tree over moving axis aligned boxes, updated
+  /// incrementally, used as the broadphase of a physics engine or any
+  /// other search for overlapping pairs among objects that move.
+  ///
+  /// Each box is stored enlarged by a margin, as a fat box. Moving a box
+  /// within its fat box does not change the tree, and a box that leaves
+  /// its fat box is removed and inserted again with a new fat box. Leaves
+  /// are inserted next to the sibling that increases the surface area of
+  /// the tree the least, and rotations keep the tree balanced after each
+  /// insertion and removal.
+  ///
+  /// Boxes are referred to by the proxy id returned by Insert(). Ids stay
+  /// valid until the box is removed, and the ids of removed boxes are
+  /// reused. Queries test the fat boxes, so they may report boxes that
+  /// are up to the margin apart. Unlike BoundingVolumeHierarchy, nothing
+  /// needs to be rebuilt when boxes move.
+  ///
+  /// Queries write into vectors passed by the caller, which keep their
+  /// capacity, so repeated queries do not allocate memory once the
+  /// vectors are large enough. Queries are const and can be made from
+  /// several threads at the same time.
+  class IGNITION_MATH_VISIBLE DynamicAabbTree
+  {
+    /// \brief Proxy id returned when a box can't be inserted.
+    public: static constexpr std::size_t kNull =
+      std::numeric_limits<std::size_t>::max();
+
+    /// \brief Default constructor. Creates an empty tree with a margin of
+    /// 0.1.
+    public: DynamicAabbTree();
+
+    /// \brief Constructor.
+    /// \param[in] _margin Distance the fat boxes extend past the boxes on
+    /// every side. Negative values are replaced by 0.
+    public: explicit DynamicAabbTree(const double _margin);
+
+    /// \brief Copy constructor.
+    /// \param[in] _tree Tree to copy.
+    public: DynamicAabbTree(const DynamicAabbTree &_tree);
+
+    /// \brief Destructor.
+    public: ~DynamicAabbTree();
+
+    /// \brief Assignment operator.
+    /// \param[in] _tree Tree to copy.
+    /// \return Reference to this tree.
+    public: DynamicAabbTree &operator=(const DynamicAabbTree &_tree);
+
+    /// \brief Get the margin of the fat boxes.
+    /// \return The margin.
+    public: double Margin() const;
+
+    /// \brief Set the margin of the fat boxes. It applies to boxes
+    /// inserted or moved out of their fat box afterwards.
+    /// \param[in] _margin The margin. Negative values are replaced by 0.
+    public: void SetMargin(const double _margin);
+
+    /// \brief Insert a box.
+    /// \param[in] _box Box to insert, finite with a minimum corner not
+    /// greater than its maximum corner.
+    /// \return Proxy id of the box, or kNull if the box is empty or not
+    /// finite.
+    public: std::size_t Insert(const AxisAlignedBox &_box);
+
+    /// \brief Remove a box.
+    /// \param[in] _id Proxy id of the box.
+    /// \return True if the box was removed, false if _id is not the id of
+    /// a box in the tree.
+    public: bool Remove(const std::size_t _id);
+
+    /// \brief Update the box of a proxy. If the box is still inside its
+    /// fat box nothing changes. Otherwise the proxy is inserted again with
+    /// a fat box enlarged by the margin, and also by the displacement in
+    /// the direction of the motion, which predicts where the box is going.
+    /// \param[in] _id Proxy id of the box.
+    /// \param[in] _box New box, finite with a minimum corner not greater
+    /// than its maximum corner.
+    /// \param[in] _displacement Expected displacement of the box before
+    /// the next update.
+    /// \return True if the fat box changed, false if it did not or if _id
+    /// or _box is invalid.
+    public: bool Move(const std::size_t _id, const AxisAlignedBox &_box,
+                      const Vector3d &_displacement = Vector3d::Zero);
+
+    /// \brief Remove all the boxes.
+    public: void Clear();
+
+    /// \brief Check if a proxy id refers to a box in the tree.
+    /// \param[in] _id Proxy id.
+    /// \return True if _id is the id of a box.
+    public: bool Contains(const std::size_t _id) const;
+
+    /// \brief Get the fat box of a proxy.
+    /// \param[in] _id Proxy id of the box.
+    /// \return The fat box, or a default box if _id is invalid.
+    public: AxisAlignedBox FatBox(const std::size_t _id) const;
+
+    /// \brief Get the number of boxes.
+    /// \return Number of boxes.
+    public: std::size_t Size() const;
+
+    /// \brief Get the height of the tree.
+    /// \return Number of levels below the root, 0 for a tree with one box
+    /// or no box.
+    public: std::size_t Height() const;
+
+    /// \brief Find the boxes whose fat box intersects a box, using the
+    /// same test as AxisAlignedBox::Intersects.
+    /// \param[in] _box Box to check.
+    /// \param[out] _ids Proxy ids of the intersecting boxes, in no
+    /// particular order. The vector is cleared first.
+    public: void Overlaps(const AxisAlignedBox &_box,
+                          std::vector<std::size_t> &_ids) const;
+
+    /// \brief Find all the pairs of boxes whose fat boxes intersect.
+    /// \param[out] _pairs Pairs of proxy ids, with the lower id first and
+    /// each pair reported once, in no particular order. The vector is
+    /// cleared first.
+    public: void OverlappingPairs(
+                std::vector<std::pair<std::size_t, std::size_t>> &_pairs)
+                const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+    /// \brief Private data pointer.
+    private: std::unique_ptr<DynamicAabbTreePrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+  };
+  }
+}
+}
+#endif
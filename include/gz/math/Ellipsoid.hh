@@ -17,9 +17,12 @@
 #ifndef GZ_MATH_ELLIPSOID_HH_
 #define GZ_MATH_ELLIPSOID_HH_
 
+#include <cstddef>
+#include <tuple>
 #include <optional>
 #include "gz/math/MassMatrix3.hh"
 #include "gz/math/Material.hh"
+#include "gz/math/Pose3.hh"
 
 namespace ignition
 {
@@ -108,6 +111,99 @@ namespace ignition
       /// \sa Precision DensityFromMass(const Precision _mass) const
       public: bool SetDensityFromMass(const Precision _mass);
 
+      /// \brief Compute the volumes of many ellipsoids. Each result is the
+      /// same as Volume() of an ellipsoid with the corresponding radii.
+      /// \param[in] _radii Array of _count ellipsoid radii.
+      /// \param[in] _count Number of ellipsoids.
+      /// \param[out] _volumes Array of at least _count values, written with
+      /// the volume of each ellipsoid in m^3.
+      public: static void Volumes(const Vector3<Precision> *_radii,
+                                  const std::size_t _count,
+                                  Precision *_volumes);
+
+      /// \brief Compute the densities of many ellipsoids from their masses.
+      /// Each result is the same as DensityFromMass of an ellipsoid with the
+      /// corresponding radii.
+      /// \param[in] _radii Array of _count ellipsoid radii.
+      /// \param[in] _masses Array of _count masses, in kg.
+      /// \param[in] _count Number of ellipsoids.
+      /// \param[out] _densities Array of at least _count values, written
+      /// with the density of each ellipsoid in kg/m^3, or NaN if a radius
+      /// or the mass is <= 0.
+      public: static void DensitiesFromMasses(
+                  const Vector3<Precision> *_radii,
+                  const Precision *_masses,
+                  const std::size_t _count,
+                  Precision *_densities);
+
+      /// \brief Compute the mass matrices of many ellipsoids of uniform
+      /// density. Each result is the same as MassMatrix of an ellipsoid
+      /// with the corresponding radii and density, without constructing a
+      /// Material.
+      /// \param[in] _radii Array of _count ellipsoid radii.
+      /// \param[in] _densities Array of _count densities, in kg/m^3.
+      /// \param[in] _count Number of ellipsoids.
+      /// \param[out] _massMats Array of at least _count mass matrices.
+      /// Ellipsoids with a radius or density <= 0 are written with a
+      /// default constructed mass matrix, which has zero mass.
+      /// \return True if the mass matrix of every ellipsoid was computed.
+      public: static bool MassMatrices(const Vector3<Precision> *_radii,
+                                       const Precision *_densities,
+                                       const std::size_t _count,
+                                       MassMatrix3<Precision> *_massMats);
+
+      /// \brief Check if a ray (origin, direction) hits the surface of the
+      /// ellipsoid.
+      /// \param[in] _pose Pose of the center of the ellipsoid, in the frame of
+      /// the ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return A boolean and Precision tuple. The boolean value is true if
+      /// the ray hits the surface between the distances _min and _max from
+      /// _origin; rays starting inside hit it where they leave. The
+      /// Precision is the distance from _origin to the hit minus _min, as
+      /// in AxisAlignedBox::IntersectDist, or zero when the boolean value
+      /// is false.
+      public: std::tuple<bool, Precision> IntersectDist(
+                  const Pose3<Precision> &_pose,
+                  const Vector3<Precision> &_origin,
+                  const Vector3<Precision> &_dir,
+                  const Precision _min, const Precision _max) const;
+
+      /// \brief Intersect a bundle of rays from the same origin, such as
+      /// the beams of a range sensor, with the ellipsoid. Calling it for every
+      /// shape of a scene with the same ranges leaves the distance of the
+      /// closest hit of each ray.
+      /// \param[in] _pose Pose of the center of the ellipsoid, in the frame of
+      /// the rays.
+      /// \param[in] _origin Origin of the rays.
+      /// \param[in] _dirs Array of _count unit ray directions.
+      /// \param[in] _count Number of rays.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in, out] _ranges Array of _count distances. Each one is the
+      /// maximum allowed distance of its ray, and is lowered to the
+      /// distance from _origin to the hit of the ray if there is one.
+      /// \return Number of lowered ranges.
+      public: std::size_t IntersectRays(const Pose3<Precision> &_pose,
+                                        const Vector3<Precision> &_origin,
+                                        const Vector3<Precision> *_dirs,
+                                        const std::size_t _count,
+                                        const Precision _min,
+                                        Precision *_ranges) const;
+
+      /// \brief Find where a ray is inside of the ellipsoid.
+      /// \param[in] _origin Origin of the ray, in the frame of the ellipsoid.
+      /// \param[in] _dir Unit direction of the ray, in the frame of the
+      /// ellipsoid.
+      /// \param[out] _tin Distance where the ray enters the ellipsoid.
+      /// \param[out] _tout Distance where the ray leaves the ellipsoid.
+      /// \return False if the line through the ray misses the ellipsoid.
+      private: bool RayInterval(const Vector3<Precision> &_origin,
+                                const Vector3<Precision> &_dir,
+                                Precision &_tin, Precision &_tout) const;
+
       /// \brief Radius of the ellipsoid.
       private: Vector3<Precision> radii = Vector3<Precision>::Zero;
 
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_EXECUTOR_HH_
+#define GZ_MATH_EXECUTOR_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declarations.
+    class ThreadPoolPrivate;
+
+    /// \class Executor Executor.hh ignition/math/Executor.hh
+    /// \brief Interface of the policies that run the work of batch
+    /// operations, such as SerialExecutor, ThreadPool, or a
+    /// FunctionExecutor forwarding to the scheduler of an application.
+    ///
+    /// Batch operations split their input into contiguous blocks with
+    /// BlockCount and ForEachBlock, and combine the results of the blocks
+    /// in block order. Results therefore only depend on the number of
+    /// blocks, which only depends on Concurrency.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::ThreadPool pool(4);
+    /// gz::math::MeshMassPropertiesd props;
+    /// props.AddTriangles(vertices, indices, count, pool);
+    /// ```
+    class IGNITION_MATH_VISIBLE Executor
+    {
+      /// \brief Destructor.
+      public: virtual ~Executor();
+
+      /// \brief Get the number of tasks that may run at once.
+      /// \return Number of tasks, at least 1.
+      public: virtual unsigned int Concurrency() const = 0;
+
+      /// \brief Call a task with every index of a range, possibly from
+      /// several threads at once, and return once all calls have returned.
+      /// The calling thread may run some of the calls. Tasks must not
+      /// throw.
+      /// \param[in] _count Number of calls.
+      /// \param[in] _task Function taking an index in [0, _count).
+      public: virtual void Run(const std::size_t _count,
+                               const std::function<void(std::size_t)> &_task)
+                               = 0;
+
+      /// \brief Get the number of blocks to split a range into. Blocks
+      /// hold at least `_minBlockSize` elements, so that each task works on
+      /// enough contiguous memory to amortize scheduling, and there are up
+      /// to kBlocksPerTask blocks per concurrent task, so that idle threads
+      /// can take over the blocks of busy ones.
+      /// \param[in] _count Number of elements.
+      /// \param[in] _minBlockSize Minimum number of elements per block.
+      /// \return Number of blocks, at least 1.
+      public: std::size_t BlockCount(const std::size_t _count,
+                                     const std::size_t _minBlockSize) const
+      {
+        const unsigned int concurrency = this->Concurrency();
+        if (concurrency <= 1)
+          return 1;
+        return std::max<std::size_t>(1, std::min<std::size_t>(
+            static_cast<std::size_t>(concurrency) * kBlocksPerTask,
+            _count / std::max<std::size_t>(_minBlockSize, 1)));
+      }
+
+      /// \brief Split a range into contiguous blocks of about the same size
+      /// and call a function with each of them, through Run.
+      /// \param[in] _count Number of elements.
+      /// \param[in] _blocks Number of blocks, usually from BlockCount.
+      /// \param[in] _function Function taking the first element, the end
+      ///   of the elements and the index of a block.
+      public: template<typename Function>
+              void ForEachBlock(const std::size_t _count,
+                                const std::size_t _blocks,
+                                const Function &_function)
+      {
+        if (_blocks <= 1)
+        {
+          _function(std::size_t(0), _count, std::size_t(0));
+          return;
+        }
+        this->Run(_blocks, [&](const std::size_t _block)
+        {
+          _function(_count * _block / _blocks,
+                    _count * (_block + 1) / _blocks, _block);
+        });
+      }
+
+      /// \brief Maximum number of blocks per concurrent task.
+      public: static constexpr std::size_t kBlocksPerTask = 4;
+    };
+
+    /// \class SerialExecutor Executor.hh ignition/math/Executor.hh
+    /// \brief Executor which runs all the tasks in order on the calling
+    /// thread. Use it for batch operations called from threads that are
+    /// already busy, to avoid oversubscription.
+    class IGNITION_MATH_VISIBLE SerialExecutor : public Executor
+    {
+      // Documentation inherited.
+      public: unsigned int Concurrency() const override;
+
+      // Documentation inherited.
+      public: void Run(const std::size_t _count,
+                       const std::function<void(std::size_t)> &_task)
+                       override;
+    };
+
+    /// \class ThreadPool Executor.hh ignition/math/Executor.hh
+    /// \brief Executor with a fixed set of worker threads, which are
+    /// started once and reused by every Run.
+    ///
+    /// Each Run splits its indices into one contiguous range per thread,
+    /// including the calling thread. A thread which finishes its range
+    /// takes the remaining indices of the other ranges, one at a time, so
+    /// uneven tasks are balanced without locks.
+    ///
+    /// The pool never adds threads to a busy system: a Run called from
+    /// within a task of the pool, or while another thread is running a
+    /// batch on the pool, runs its tasks on the calling thread.
+    class IGNITION_MATH_VISIBLE ThreadPool : public Executor
+    {
+      /// \brief Constructor.
+      /// \param[in] _threads Number of threads running tasks, including
+      /// the thread calling Run. A value of 0 uses the number of hardware
+      /// threads.
+      public: explicit ThreadPool(const unsigned int _threads = 0);
+
+      /// \brief Destructor. Stops the worker threads.
+      public: ~ThreadPool() override;
+
+      /// \brief Thread pools are not copyable.
+      public: ThreadPool(const ThreadPool &) = delete;
+
+      /// \brief Thread pools are not copyable.
+      /// \return this
+      public: ThreadPool &operator=(const ThreadPool &) = delete;
+
+      // Documentation inherited.
+      public: unsigned int Concurrency() const override;
+
+      // Documentation inherited.
+      public: void Run(const std::size_t _count,
+                       const std::function<void(std::size_t)> &_task)
+                       override;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ThreadPoolPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+
+    /// \class FunctionExecutor Executor.hh ignition/math/Executor.hh
+    /// \brief Executor which forwards the tasks to a function, to run
+    /// batch operations on the scheduler of an application.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// // Intel TBB
+    /// gz::math::FunctionExecutor tbbExecutor(
+    ///     [](std::size_t _count,
+    ///        const std::function<void(std::size_t)> &_task)
+    ///     {
+    ///       tbb::parallel_for(std::size_t(0), _count, _task);
+    ///     },
+    ///     tbb::this_task_arena::max_concurrency());
+    ///
+    /// // C++17 parallel algorithms
+    /// gz::math::FunctionExecutor stdExecutor(
+    ///     [](std::size_t _count,
+    ///        const std::function<void(std::size_t)> &_task)
+    ///     {
+    ///       std::vector<std::size_t> indices(_count);
+    ///       std::iota(indices.begin(), indices.end(), 0);
+    ///       std::for_each(std::execution::par, indices.begin(),
+    ///                     indices.end(), _task);
+    ///     },
+    ///     std::thread::hardware_concurrency());
+    /// ```
+    class IGNITION_MATH_VISIBLE FunctionExecutor : public Executor
+    {
+      /// \brief Function which calls a task with every index of a range
+      /// and returns once all calls have returned.
+      public: using RunFunction = std::function<void(
+                  std::size_t, const std::function<void(std::size_t)> &)>;
+
+      /// \brief Constructor.
+      /// \param[in] _run Function running the tasks.
+      /// \param[in] _concurrency Number of tasks that `_run` may run at
+      /// once. Values below 1 are treated as 1.
+      public: FunctionExecutor(RunFunction _run,
+                               const unsigned int _concurrency);
+
+      // Documentation inherited.
+      public: unsigned int Concurrency() const override;
+
+      // Documentation inherited.
+      public: void Run(const std::size_t _count,
+                       const std::function<void(std::size_t)> &_task)
+                       override;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::function
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Function running the tasks.
+      private: RunFunction run;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+      /// \brief Number of tasks that may run at once.
+      private: unsigned int concurrency;
+    };
+    }
+  }
+}
+#endif
@@ -17,6 +17,8 @@
 #ifndef GZ_MATH_FILTER_HH_
 #define GZ_MATH_FILTER_HH_
 
+#include <cstddef>
+#include <vector>
 #include <gz/math/Helpers.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/Quaternion.hh>
@@ -29,6 +31,34 @@ namespace ignition
     // Inline bracket to help doxygen filtering.
     inline namespace IGNITION_MATH_VERSION_NAMESPACE {
     //
+    namespace detail {
+      /// \brief Compute the feedback gain of a one-pole filter.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      /// \return The gain of the feedback, the input gain is 1 minus it.
+      inline double OnePoleFeedback(double _fc, double _fs)
+      {
+        return exp(-2.0 * IGN_PI * _fc / _fs);
+      }
+
+      /// \brief Compute the coefficients of a bi-quad filter.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      /// \param[in] _q Q coefficient.
+      /// \param[out] _a0 Gain of the input.
+      /// \param[out] _b1 Gain of the previous output.
+      /// \param[out] _b2 Gain of the output before previous.
+      inline void BiQuadCoefficients(double _fc, double _fs, double _q,
+                                     double &_a0, double &_b1, double &_b2)
+      {
+        double k = tan(IGN_PI * _fc / _fs);
+        double kQuadDenom = k * k + k / _q + 1.0;
+        _a0 = k * k/ kQuadDenom;
+        _b1 = 2 * (k * k - 1.0) / kQuadDenom;
+        _b2 = (k * k - k / _q + 1.0) / kQuadDenom;
+      }
+    }  // namespace detail
+
     /// \class Filter Filter.hh ignition/math/Filter.hh
     /// \brief Filter base class
     template <class T>
@@ -80,7 +110,7 @@ namespace ignition
       // Documentation Inherited.
       public: virtual void Fc(double _fc, double _fs) override
       {
-        b1 = exp(-2.0 * IGN_PI * _fc / _fs);
+        b1 = detail::OnePoleFeedback(_fc, _fs);
         a0 = 1.0 - b1;
       }
 
@@ -179,14 +209,11 @@ namespace ignition
       /// \param[in] _q Q coefficient.
       public: void Fc(double _fc, double _fs, double _q)
       {
-        double k = tan(IGN_PI * _fc / _fs);
-        double kQuadDenom = k * k + k / _q + 1.0;
-        this->a0 = k * k/ kQuadDenom;
+        detail::BiQuadCoefficients(_fc, _fs, _q,
+                                   this->a0, this->b1, this->b2);
         this->a1 = 2 * this->a0;
         this->a2 = this->a0;
         this->b0 = 1.0;
-        this->b1 = 2 * (k * k - 1.0) / kQuadDenom;
-        this->b2 = (k * k - k / _q + 1.0) / kQuadDenom;
       }
 
       /// \brief Set the current filter's output.
@@ -245,6 +272,300 @@ namespace ignition
         this->Set(math::Vector3d(0, 0, 0));
       }
     };
+
+    /// \class OnePoleBank Filter.hh ignition/math/Filter.hh
+    /// \brief A bank of one-pole filters, one per channel, that processes
+    /// all the channels together.
+    ///
+    /// Each channel behaves as a OnePole filter with its own cutoff
+    /// frequency and sample rate. The coefficients and outputs are stored
+    /// as arrays and the filters are not virtual, so processing a block of
+    /// samples is a plain loop over the channels for each sample.
+    ///
+    /// Blocks are made of frames, where a frame holds one sample of every
+    /// channel: sample i of channel c is at index i * Channels() + c.
+    template <class T>
+    class OnePoleBank
+    {
+      /// \brief Constructor. Creates a bank without channels.
+      public: OnePoleBank() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _channels Number of channels.
+      /// \param[in] _fc Cutoff frequency of every channel.
+      /// \param[in] _fs Sample rate of every channel.
+      public: OnePoleBank(std::size_t _channels, double _fc, double _fs)
+      {
+        this->Resize(_channels);
+        this->Fc(_fc, _fs);
+      }
+
+      /// \brief Set the number of channels. New channels have zero gains
+      /// and outputs.
+      /// \param[in] _channels Number of channels.
+      public: void Resize(std::size_t _channels)
+      {
+        this->a0.resize(_channels, 0.0);
+        this->b1.resize(_channels, 0.0);
+        this->y0.resize(_channels, T{});
+      }
+
+      /// \brief Get the number of channels.
+      /// \return Number of channels.
+      public: std::size_t Channels() const
+      {
+        return this->y0.size();
+      }
+
+      /// \brief Set the cutoff frequency and sample rate of every channel.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      public: void Fc(double _fc, double _fs)
+      {
+        for (std::size_t c = 0; c < this->Channels(); ++c)
+          this->FcChannel(c, _fc, _fs);
+      }
+
+      /// \brief Set the cutoff frequency and sample rate of a channel.
+      /// \param[in] _channel Index of the channel. Nothing is done if it
+      /// is out of range.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      public: void FcChannel(std::size_t _channel, double _fc,
+                             double _fs)
+      {
+        if (_channel >= this->Channels())
+          return;
+        this->b1[_channel] = detail::OnePoleFeedback(_fc, _fs);
+        this->a0[_channel] = 1.0 - this->b1[_channel];
+      }
+
+      /// \brief Set the output of every channel.
+      /// \param[in] _val New value.
+      public: void Set(const T &_val)
+      {
+        this->y0.assign(this->y0.size(), _val);
+      }
+
+      /// \brief Set the output of a channel.
+      /// \param[in] _channel Index of the channel. Nothing is done if it
+      /// is out of range.
+      /// \param[in] _val New value.
+      public: void SetChannel(std::size_t _channel, const T &_val)
+      {
+        if (_channel < this->Channels())
+          this->y0[_channel] = _val;
+      }
+
+      /// \brief Get the outputs of the filters.
+      /// \return The output of each channel.
+      public: const std::vector<T> &Value() const
+      {
+        return this->y0;
+      }
+
+      /// \brief Update the filters with blocks of frames.
+      /// \param[in] _input Array of _frames frames of input samples.
+      /// \param[out] _output Array of _frames frames, written with the
+      /// output of each channel after each sample. It may be _input.
+      /// \param[in] _frames Number of frames.
+      public: void Process(const T *_input, T *_output,
+                           std::size_t _frames = 1)
+      {
+        const std::size_t channels = this->Channels();
+        const double *gain = this->a0.data();
+        const double *feedback = this->b1.data();
+        T *y = this->y0.data();
+        for (std::size_t i = 0; i < _frames; ++i)
+        {
+          const T *x = _input + i * channels;
+          T *out = _output + i * channels;
+          for (std::size_t c = 0; c < channels; ++c)
+          {
+            y[c] = gain[c] * x[c] + feedback[c] * y[c];
+            out[c] = y[c];
+          }
+        }
+      }
+
+      /// \brief Input gain of each channel.
+      private: std::vector<double> a0;
+
+      /// \brief Gain of the feedback of each channel.
+      private: std::vector<double> b1;
+
+      /// \brief Output of each channel.
+      private: std::vector<T> y0;
+    };
+
+    /// \class BiQuadBank Filter.hh ignition/math/Filter.hh
+    /// \brief A bank of bi-quad filters, one per channel, that processes
+    /// all the channels together.
+    ///
+    /// Each channel behaves as a BiQuad filter with its own coefficients.
+    /// Blocks of samples are laid out as in OnePoleBank.
+    template <class T>
+    class BiQuadBank
+    {
+      /// \brief Constructor. Creates a bank without channels.
+      public: BiQuadBank() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _channels Number of channels.
+      /// \param[in] _fc Cutoff frequency of every channel.
+      /// \param[in] _fs Sample rate of every channel.
+      public: BiQuadBank(std::size_t _channels, double _fc, double _fs)
+      {
+        this->Resize(_channels);
+        this->Fc(_fc, _fs);
+      }
+
+      /// \brief Set the number of channels. New channels have zero gains
+      /// and outputs.
+      /// \param[in] _channels Number of channels.
+      public: void Resize(std::size_t _channels)
+      {
+        this->a0.resize(_channels, 0.0);
+        this->b1.resize(_channels, 0.0);
+        this->b2.resize(_channels, 0.0);
+        this->x1.resize(_channels, T{});
+        this->x2.resize(_channels, T{});
+        this->y1.resize(_channels, T{});
+        this->y2.resize(_channels, T{});
+      }
+
+      /// \brief Get the number of channels.
+      /// \return Number of channels.
+      public: std::size_t Channels() const
+      {
+        return this->y1.size();
+      }
+
+      /// \brief Set the cutoff frequency and sample rate of every channel,
+      /// with a Q coefficient of 0.5.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      public: void Fc(double _fc, double _fs)
+      {
+        this->Fc(_fc, _fs, 0.5);
+      }
+
+      /// \brief Set the cutoff frequency, sample rate and Q coefficient of
+      /// every channel.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      /// \param[in] _q Q coefficient.
+      public: void Fc(double _fc, double _fs, double _q)
+      {
+        for (std::size_t c = 0; c < this->Channels(); ++c)
+          this->FcChannel(c, _fc, _fs, _q);
+      }
+
+      /// \brief Set the cutoff frequency, sample rate and Q coefficient of
+      /// a channel.
+      /// \param[in] _channel Index of the channel. Nothing is done if it
+      /// is out of range.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      /// \param[in] _q Q coefficient.
+      public: void FcChannel(std::size_t _channel, double _fc,
+                             double _fs, double _q = 0.5)
+      {
+        if (_channel >= this->Channels())
+          return;
+        detail::BiQuadCoefficients(_fc, _fs, _q, this->a0[_channel],
+                                   this->b1[_channel], this->b2[_channel]);
+      }
+
+      /// \brief Set the output and history of every channel.
+      /// \param[in] _val New value.
+      public: void Set(const T &_val)
+      {
+        for (std::size_t c = 0; c < this->Channels(); ++c)
+          this->SetChannel(c, _val);
+      }
+
+      /// \brief Set the output and history of a channel.
+      /// \param[in] _channel Index of the channel. Nothing is done if it
+      /// is out of range.
+      /// \param[in] _val New value.
+      public: void SetChannel(std::size_t _channel, const T &_val)
+      {
+        if (_channel >= this->Channels())
+          return;
+        this->y1[_channel] = this->y2[_channel] = this->x1[_channel] =
+          this->x2[_channel] = _val;
+      }
+
+      /// \brief Get the outputs of the filters.
+      /// \return The output of each channel.
+      public: const std::vector<T> &Value() const
+      {
+        // The output is always the previous output of the next sample.
+        return this->y1;
+      }
+
+      /// \brief Update the filters with blocks of frames.
+      /// \param[in] _input Array of _frames frames of input samples.
+      /// \param[out] _output Array of _frames frames, written with the
+      /// output of each channel after each sample. It may be _input.
+      /// \param[in] _frames Number of frames.
+      public: void Process(const T *_input, T *_output,
+                           std::size_t _frames = 1)
+      {
+        const std::size_t channels = this->Channels();
+        const double *ga0 = this->a0.data();
+        const double *gb1 = this->b1.data();
+        const double *gb2 = this->b2.data();
+        T *px1 = this->x1.data();
+        T *px2 = this->x2.data();
+        T *py1 = this->y1.data();
+        T *py2 = this->y2.data();
+        for (std::size_t i = 0; i < _frames; ++i)
+        {
+          const T *x = _input + i * channels;
+          T *out = _output + i * channels;
+          for (std::size_t c = 0; c < channels; ++c)
+          {
+            // Same expression as BiQuad::Process, where a1 = 2 * a0 and
+            // a2 = a0.
+            const T xc = x[c];
+            const T y = ga0[c] * xc +
+                        (2 * ga0[c]) * px1[c] +
+                        ga0[c] * px2[c] -
+                        gb1[c] * py1[c] -
+                        gb2[c] * py2[c];
+            px2[c] = px1[c];
+            px1[c] = xc;
+            py2[c] = py1[c];
+            py1[c] = y;
+            out[c] = y;
+          }
+        }
+      }
+
+      /// \brief Input gain of each channel.
+      private: std::vector<double> a0;
+
+      /// \brief Gain of the previous output of each channel.
+      private: std::vector<double> b1;
+
+      /// \brief Gain of the output before previous of each channel.
+      private: std::vector<double> b2;
+
+      /// \brief Previous input of each channel.
+      private: std::vector<T> x1;
+
+      /// \brief Input before previous of each channel.
+      private: std::vector<T> x2;
+
+      /// \brief Output of each channel, and previous output of the next
+      /// sample.
+      private: std::vector<T> y1;
+
+      /// \brief Output before previous of each channel.
+      private: std::vector<T> y2;
+    };
     }
   }
 }
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_FRAMETREE_HH_
+#define GZ_MATH_FRAMETREE_HH_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include <gz/math/Pose3.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  // Forward declaration.
+  class FrameTreePrivate;
+
+  /// \class FrameTree FrameTree.hh ignition/math/FrameTree.hh
+  /// \brief A tree of named coordinate frames, such as
+  /// world <- base <- link <- sensor, that caches the pose of each frame
+  /// in the world frame.
+  ///
+  /// Each frame stores its pose relative to its parent. Frames without a
+  /// parent are relative to the world. The world pose of a frame is the
+  /// product of the relative poses along its path to the world,
+  /// X_WF = X_WP * X_PF, and is computed the first time it is queried and
+  /// then cached. Changing the relative pose of a frame only invalidates
+  /// the cached world poses of that frame and its descendants, so updating
+  /// one joint of a large model recomputes only the affected subtree.
+  ///
+  /// Frames are referred to by the index returned by AddFrame(). A parent
+  /// is always added before its children, so a frame index is always
+  /// larger than the index of its parent.
+  ///
+  /// Queries of world poses are const but fill the cache. After
+  /// UpdateWorldPoses(), every world pose is cached and const queries only
+  /// read, so they can be made from several threads at the same time as
+  /// long as no relative pose changes. Otherwise concurrent queries need
+  /// external synchronization.
+  class IGNITION_MATH_VISIBLE FrameTree
+  {
+    /// \brief Index returned when there is no frame, and parent of the
+    /// frames that are relative to the world.
+    public: static constexpr std::size_t kNoFrame =
+      std::numeric_limits<std::size_t>::max();
+
+    /// \brief Default constructor. Creates an empty tree.
+    public: FrameTree();
+
+    /// \brief Copy constructor.
+    /// \param[in] _tree Tree to copy.
+    public: FrameTree(const FrameTree &_tree);
+
+    /// \brief Destructor.
+    public: ~FrameTree();
+
+    /// \brief Assignment operator.
+    /// \param[in] _tree Tree to copy.
+    /// \return Reference to this tree.
+    public: FrameTree &operator=(const FrameTree &_tree);
+
+    /// \brief Add a frame.
+    /// \param[in] _name Unique name of the frame.
+    /// \param[in] _parent Index of the parent frame, or kNoFrame for a
+    /// frame relative to the world.
+    /// \param[in] _pose Pose of the frame relative to its parent.
+    /// \return Index of the new frame, or kNoFrame if the name is already
+    /// used or the parent does not exist.
+    public: std::size_t AddFrame(const std::string &_name,
+                                 const std::size_t _parent,
+                                 const Pose3d &_pose);
+
+    /// \brief Get the number of frames.
+    /// \return Number of frames.
+    public: std::size_t FrameCount() const;
+
+    /// \brief Remove all the frames.
+    public: void Clear();
+
+    /// \brief Find a frame by name.
+    /// \param[in] _name Name of the frame.
+    /// \return Index of the frame, or kNoFrame if there is no such frame.
+    public: std::size_t FrameIndex(const std::string &_name) const;
+
+    /// \brief Get the name of a frame.
+    /// \param[in] _frame Index of the frame.
+    /// \return Name of the frame, or an empty string if _frame is invalid.
+    public: const std::string &Name(const std::size_t _frame) const;
+
+    /// \brief Get the parent of a frame.
+    /// \param[in] _frame Index of the frame.
+    /// \return Index of the parent, or kNoFrame if the frame is relative
+    /// to the world or _frame is invalid.
+    public: std::size_t Parent(const std::size_t _frame) const;
+
+    /// \brief Get the children of a frame.
+    /// \param[in] _frame Index of the frame.
+    /// \return Indices of the children in the order they were added, or an
+    /// empty vector if _frame is invalid.
+    public: const std::vector<std::size_t> &Children(
+                const std::size_t _frame) const;
+
+    /// \brief Set the pose of a frame relative to its parent. The cached
+    /// world poses of the frame and its descendants are invalidated.
+    /// \param[in] _frame Index of the frame.
+    /// \param[in] _pose New relative pose.
+    /// \return False if _frame is invalid.
+    public: bool SetRelativePose(const std::size_t _frame,
+                                 const Pose3d &_pose);
+
+    /// \brief Get the pose of a frame relative to its parent.
+    /// \param[in] _frame Index of the frame.
+    /// \return Relative pose, or the identity if _frame is invalid.
+    public: const Pose3d &RelativePose(const std::size_t _frame) const;
+
+    /// \brief Get the pose of a frame in the world frame. Only the frames
+    /// between _frame and its closest ancestor with a cached world pose are
+    /// computed, and their world poses are cached.
+    /// \param[in] _frame Index of the frame.
+    /// \return World pose, or the identity if _frame is invalid.
+    public: const Pose3d &WorldPose(const std::size_t _frame) const;
+
+    /// \brief Get the world poses of many frames.
+    /// \param[in] _frames Indices of the frames.
+    /// \param[out] _poses World pose of each frame, resized to
+    /// _frames.size().
+    public: void WorldPoses(const std::vector<std::size_t> &_frames,
+                            std::vector<Pose3d> &_poses) const;
+
+    /// \brief Get the pose of a frame relative to another frame,
+    /// X_BF = X_WB^-1 * X_WF.
+    /// \param[in] _frame Index of the frame.
+    /// \param[in] _base Index of the frame to express the pose in, or
+    /// kNoFrame for the world.
+    /// \return Pose of _frame in _base, or the identity if a frame is
+    /// invalid.
+    public: Pose3d PoseInFrame(const std::size_t _frame,
+                               const std::size_t _base) const;
+
+    /// \brief Compute and cache the world pose of every frame whose cache
+    /// is invalid, in a single pass over the frames.
+    public: void UpdateWorldPoses();
+
+    /// \brief Get whether the world pose of a frame is cached.
+    /// \param[in] _frame Index of the frame.
+    /// \return True if the world pose is cached, false if it needs to be
+    /// computed or _frame is invalid.
+    public: bool WorldPoseCached(const std::size_t _frame) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+    /// \brief Private data pointer.
+    private: std::unique_ptr<FrameTreePrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+  };
+  }
+}
+}
+#endif
@@ -17,8 +17,13 @@
 #ifndef GZ_MATH_FRUSTUM_HH_
 #define GZ_MATH_FRUSTUM_HH_
 
+#include <array>
+#include <cstdint>
+#include <vector>
+
 #include <gz/math/Angle.hh>
 #include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/AxisAlignedBox3.hh>
 #include <gz/math/Plane.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/config.hh>
@@ -35,6 +40,11 @@ namespace ignition
 
     /// \brief Mathematical representation of a frustum and related functions.
     /// This is also known as a view frustum.
+    ///
+    /// The planes, corners and bounds of the frustum are computed when they
+    /// are first needed after one of its properties changed, so setting
+    /// several properties, or the pose every frame, only computes them once.
+    /// Const member functions may be called concurrently.
     class IGNITION_MATH_VISIBLE Frustum
     {
       /// \brief Planes that define the boundaries of the frustum.
@@ -90,6 +100,11 @@ namespace ignition
       /// \param[in] _p Frustum to copy.
       public: Frustum(const Frustum &_p);
 
+      /// \brief Move constructor. It doesn't allocate memory. The moved
+      /// from frustum can only be assigned to or destroyed.
+      /// \param[in] _p Frustum to move.
+      public: Frustum(Frustum &&_p) noexcept;
+
       /// \brief Destructor
       public: virtual ~Frustum();
 
@@ -158,6 +173,158 @@ namespace ignition
       /// \return True if the point is inside the pyramid frustum.
       public: bool Contains(const Vector3d &_p) const;
 
+      /// \brief Check which boxes of a batch lie inside the pyramid frustum.
+      /// The result for each box is the same as Contains(const
+      /// AxisAlignedBox &), but the planes are tested with vector
+      /// instructions.
+      /// \param[in] _boxes Boxes to check.
+      /// \param[out] _visible Visibility bitmask. Bit (i % 64) of element
+      /// (i / 64) is set when box i is inside the frustum. It is resized to
+      /// hold one bit per box, and unused bits are zero.
+      /// \return Number of boxes inside the frustum.
+      public: std::size_t Contains(const std::vector<AxisAlignedBox> &_boxes,
+                  std::vector<uint64_t> &_visible) const;
+
+      /// \brief Check which boxes of a batch lie inside the pyramid frustum,
+      /// using plane coherency. The plane that culled a box in the previous
+      /// call is tested first, so boxes that stay outside of the frustum
+      /// between calls are usually rejected with a single plane test.
+      /// \param[in] _boxes Boxes to check.
+      /// \param[out] _visible Visibility bitmask, see Contains(const
+      /// std::vector<AxisAlignedBox> &, std::vector<uint64_t> &).
+      /// \param[in,out] _planeCache Index of the plane that last culled each
+      /// box. Keep it between calls with the same boxes. It is resized and
+      /// zeroed when its size differs from the number of boxes.
+      /// \return Number of boxes inside the frustum.
+      public: std::size_t Contains(const std::vector<AxisAlignedBox> &_boxes,
+                  std::vector<uint64_t> &_visible,
+                  std::vector<uint8_t> &_planeCache) const;
+
+      /// \brief Check which boxes of a batch lie inside the pyramid frustum.
+      /// \param[in] _boxes Boxes to check.
+      /// \param[out] _visible Visibility bitmask, see Contains(const
+      /// std::vector<AxisAlignedBox> &, std::vector<uint64_t> &).
+      /// \return Number of boxes inside the frustum.
+      public: std::size_t Contains(
+                  const std::vector<AxisAlignedBox3d> &_boxes,
+                  std::vector<uint64_t> &_visible) const;
+
+      /// \brief Check which boxes of a batch lie inside the pyramid frustum,
+      /// using plane coherency.
+      /// \param[in] _boxes Boxes to check.
+      /// \param[out] _visible Visibility bitmask, see Contains(const
+      /// std::vector<AxisAlignedBox> &, std::vector<uint64_t> &).
+      /// \param[in,out] _planeCache Index of the plane that last culled each
+      /// box, see Contains(const std::vector<AxisAlignedBox> &,
+      /// std::vector<uint64_t> &, std::vector<uint8_t> &).
+      /// \return Number of boxes inside the frustum.
+      public: std::size_t Contains(
+                  const std::vector<AxisAlignedBox3d> &_boxes,
+                  std::vector<uint64_t> &_visible,
+                  std::vector<uint8_t> &_planeCache) const;
+
+      /// \brief Check which spheres of a batch may lie inside the pyramid
+      /// frustum. A sphere is culled when it is on the negative side of one
+      /// of the planes. This is conservative: a sphere close to an edge of
+      /// the frustum may be reported as visible while being outside.
+      /// \param[in] _centers Centers of the spheres.
+      /// \param[in] _radii Radii of the spheres. It must have the same size
+      /// as _centers.
+      /// \param[out] _visible Visibility bitmask, see Contains(const
+      /// std::vector<AxisAlignedBox> &, std::vector<uint64_t> &).
+      /// \return Number of spheres inside the frustum, or 0 with an empty
+      /// bitmask if _centers and _radii have different sizes.
+      public: std::size_t Contains(const std::vector<Vector3d> &_centers,
+                  const std::vector<double> &_radii,
+                  std::vector<uint64_t> &_visible) const;
+
+      /// \brief Check which spheres of a batch may lie inside the pyramid
+      /// frustum, using plane coherency.
+      /// \param[in] _centers Centers of the spheres.
+      /// \param[in] _radii Radii of the spheres. It must have the same size
+      /// as _centers.
+      /// \param[out] _visible Visibility bitmask, see Contains(const
+      /// std::vector<AxisAlignedBox> &, std::vector<uint64_t> &).
+      /// \param[in,out] _planeCache Index of the plane that last culled each
+      /// sphere, see Contains(const std::vector<AxisAlignedBox> &,
+      /// std::vector<uint64_t> &, std::vector<uint8_t> &).
+      /// \return Number of spheres inside the frustum, or 0 with an empty
+      /// bitmask if _centers and _radii have different sizes.
+      public: std::size_t Contains(const std::vector<Vector3d> &_centers,
+                  const std::vector<double> &_radii,
+                  std::vector<uint64_t> &_visible,
+                  std::vector<uint8_t> &_planeCache) const;
+
+      /// \brief Check which single precision boxes of a batch lie inside
+      /// the pyramid frustum. The boxes are tested in double precision, so
+      /// the result is the same as for the boxes converted to
+      /// AxisAlignedBox3d.
+      /// \param[in] _boxes Boxes to check.
+      /// \param[out] _visible Visibility bitmask, see Contains(const
+      /// std::vector<AxisAlignedBox> &, std::vector<uint64_t> &).
+      /// \return Number of boxes inside the frustum.
+      public: std::size_t Contains(
+                  const std::vector<AxisAlignedBox3f> &_boxes,
+                  std::vector<uint64_t> &_visible) const;
+
+      /// \brief Check which single precision boxes of a batch lie inside
+      /// the pyramid frustum, using plane coherency.
+      /// \param[in] _boxes Boxes to check.
+      /// \param[out] _visible Visibility bitmask, see Contains(const
+      /// std::vector<AxisAlignedBox> &, std::vector<uint64_t> &).
+      /// \param[in,out] _planeCache Index of the plane that last culled each
+      /// box, see Contains(const std::vector<AxisAlignedBox> &,
+      /// std::vector<uint64_t> &, std::vector<uint8_t> &).
+      /// \return Number of boxes inside the frustum.
+      public: std::size_t Contains(
+                  const std::vector<AxisAlignedBox3f> &_boxes,
+                  std::vector<uint64_t> &_visible,
+                  std::vector<uint8_t> &_planeCache) const;
+
+      /// \brief Check which single precision spheres of a batch may lie
+      /// inside the pyramid frustum, see Contains(const
+      /// std::vector<Vector3d> &, const std::vector<double> &,
+      /// std::vector<uint64_t> &).
+      /// \param[in] _centers Centers of the spheres.
+      /// \param[in] _radii Radii of the spheres. It must have the same size
+      /// as _centers.
+      /// \param[out] _visible Visibility bitmask, see Contains(const
+      /// std::vector<AxisAlignedBox> &, std::vector<uint64_t> &).
+      /// \return Number of spheres inside the frustum, or 0 with an empty
+      /// bitmask if _centers and _radii have different sizes.
+      public: std::size_t Contains(const std::vector<Vector3f> &_centers,
+                  const std::vector<float> &_radii,
+                  std::vector<uint64_t> &_visible) const;
+
+      /// \brief Check which single precision spheres of a batch may lie
+      /// inside the pyramid frustum, using plane coherency.
+      /// \param[in] _centers Centers of the spheres.
+      /// \param[in] _radii Radii of the spheres. It must have the same size
+      /// as _centers.
+      /// \param[out] _visible Visibility bitmask, see Contains(const
+      /// std::vector<AxisAlignedBox> &, std::vector<uint64_t> &).
+      /// \param[in,out] _planeCache Index of the plane that last culled each
+      /// sphere, see Contains(const std::vector<AxisAlignedBox> &,
+      /// std::vector<uint64_t> &, std::vector<uint8_t> &).
+      /// \return Number of spheres inside the frustum, or 0 with an empty
+      /// bitmask if _centers and _radii have different sizes.
+      public: std::size_t Contains(const std::vector<Vector3f> &_centers,
+                  const std::vector<float> &_radii,
+                  std::vector<uint64_t> &_visible,
+                  std::vector<uint8_t> &_planeCache) const;
+
+      /// \brief Get the corners of the frustum.
+      /// \return The near top left, near top right, near bottom left and
+      /// near bottom right corners, followed by the same corners of the far
+      /// plane.
+      public: std::array<Vector3d, 8> Corners() const;
+
+      /// \brief Get the axis aligned box that bounds the frustum, which is
+      /// the box that bounds its corners. A box that does not intersect it
+      /// is outside of the frustum, which makes it a cheap broadphase test.
+      /// \return The bounding box.
+      public: AxisAlignedBox Bounds() const;
+
       /// \brief Get the pose of the frustum
       /// \return Pose of the frustum
       /// \sa SetPose
@@ -173,8 +340,15 @@ namespace ignition
       /// \return The new frustum.
       public: Frustum &operator=(const Frustum &_f);
 
-      /// \brief Compute the planes of the frustum. This is called whenever
-      /// a property of the frustum is changed.
+      /// \brief Move assignment operator. It doesn't allocate memory, and
+      /// swaps the data of the frustums.
+      /// \param[in] _f Frustum to move.
+      /// \return The new frustum.
+      public: Frustum &operator=(Frustum &&_f) noexcept;
+
+      /// \brief Compute the planes of the frustum. Changing a property of
+      /// the frustum marks its planes, corners and bounds as outdated, and
+      /// they are recomputed by the first function that needs them.
       private: void ComputePlanes();
 
       /// \internal
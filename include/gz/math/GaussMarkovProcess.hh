@@ -20,6 +20,7 @@
 #include <chrono>
 #include <memory>
 #include <gz/math/Export.hh>
+#include <gz/math/PhiloxEngine.hh>
 #include <gz/math/config.hh>
 
 namespace ignition
@@ -44,11 +45,44 @@ namespace ignition
     /// See the Update(const clock::duration &) for details on the forumla
     /// used to update the process.
     ///
+    /// Once constructed, a process does not allocate memory, so Update and
+    /// Set are real-time safe. The Update overloads without an engine draw
+    /// from the shared Rand engine, which allocates its state on the first
+    /// draw of each thread; the overloads taking a PhiloxEngine never do.
+    ///
     /// ## Example usage
     ///
     /// \snippet examples/gauss_markov_process_example.cc complete
     class IGNITION_MATH_VISIBLE GaussMarkovProcess
     {
+      /// \enum DiscretizationType
+      /// \brief Methods to advance the process by a time step.
+      public: enum DiscretizationType
+              {
+                /// \brief Euler step of the differential equation, with a
+                /// noise of standard deviation sigma per update whatever
+                /// the time step. The statistics of the process depend on
+                /// the update rate. This is the default.
+                EULER = 0,
+
+                /// \brief Exact transition of the continuous process over
+                /// the time step, where sigma is the diffusion per square
+                /// root of a second:
+                ///
+                /// \f$x_{t+dt} = \mu + (x_t - \mu) e^{-\theta dt} +
+                /// \sigma \sqrt{\frac{1 - e^{-2 \theta dt}}{2 \theta}}
+                /// N(0, 1)\f$
+                ///
+                /// which is \f$x_t + \sigma \sqrt{dt} N(0, 1)\f$, a random
+                /// walk, when theta is zero. One update of any length has
+                /// the same distribution as many shorter updates over the
+                /// same time, so the process can be updated at the rate of
+                /// its consumer. The coefficients are cached for the last
+                /// time step, so updates at a fixed rate cost no more than
+                /// Euler steps.
+                EXACT = 1
+              };
+
       // Default constructor. This sets all the parameters to zero.
       public: GaussMarkovProcess();
 
@@ -103,9 +137,20 @@ namespace ignition
       /// to the start value.
       public: void Reset();
 
+      /// \brief Set the method used by Update to advance the process. It
+      /// doesn't change the parameters or the current value.
+      /// \param[in] _discretization The method.
+      public: void SetDiscretization(DiscretizationType _discretization);
+
+      /// \brief Get the method used by Update to advance the process.
+      /// \return The method.
+      /// \sa SetDiscretization(DiscretizationType)
+      public: DiscretizationType Discretization() const;
+
       /// \brief Update the process and get the new value.
       ///
-      /// The following equation is computed:
+      /// With the default EULER discretization, the following equation is
+      /// computed:
       ///
       /// \f$x_{t+1} += \theta * (\mu - x_t) * dt + \sigma * dW_t\f$
       ///
@@ -128,6 +173,9 @@ namespace ignition
       /// This implementation include a drift parameter, mu. In financial
       /// mathematics, this is known as a Vasicek model.
       ///
+      /// The EXACT discretization samples the continuous process instead,
+      /// see DiscretizationType.
+      ///
       /// \param[in] _dt Length of the timestep after which a new sample
       /// should be taken.
       /// \return The new value of this process.
@@ -135,6 +183,29 @@ namespace ignition
 
       public: double Update(double _dt);
 
+      /// \brief Update the process with a normal sample drawn from a
+      /// caller provided engine, and get the new value.
+      ///
+      /// This is the same as Update(const clock::duration &), except that
+      /// \f$dW_t\f$ comes from _engine instead of the shared Rand engine.
+      /// Giving each process its own counter based stream, e.g. with
+      /// Rand::StreamEngine(), makes the result independent of the order
+      /// in which processes are updated from different threads.
+      /// \param[in] _dt Length of the timestep after which a new sample
+      /// should be taken.
+      /// \param[in,out] _engine Engine of the normal sample.
+      /// \return The new value of this process.
+      public: double Update(const clock::duration &_dt,
+                            PhiloxEngine &_engine);
+
+      /// \brief Update the process with a normal sample drawn from a
+      /// caller provided engine, and get the new value.
+      /// \param[in] _dt Length of the timestep in seconds.
+      /// \param[in,out] _engine Engine of the normal sample.
+      /// \return The new value of this process.
+      /// \sa Update(const clock::duration &, PhiloxEngine &)
+      public: double Update(double _dt, PhiloxEngine &_engine);
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
 // std::unique_ptr
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GAUSSMARKOVPROCESSENSEMBLE_HH_
+#define GZ_MATH_GAUSSMARKOVPROCESSENSEMBLE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <gz/math/Export.hh>
+#include <gz/math/GaussMarkovProcess.hh>
+#include <gz/math/Rand.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declarations.
+    class GaussMarkovProcessEnsemblePrivate;
+
+    /** \class GaussMarkovProcessEnsemble GaussMarkovProcessEnsemble.hh\
+     * ignition/math/GaussMarkovProcessEnsemble.hh
+     **/
+    /// \brief A set of independent Gauss-Markov processes that are updated
+    /// together, such as the biases of many sensors.
+    ///
+    /// Each process follows the same equation as GaussMarkovProcess, with
+    /// its own start value and theta, mu and sigma parameters. The values
+    /// and parameters are stored as arrays, and an update draws the normal
+    /// samples of all the processes at once from a generator owned by the
+    /// ensemble, instead of one sample per process from the shared Rand
+    /// engine.
+    class IGNITION_MATH_VISIBLE GaussMarkovProcessEnsemble
+    {
+      /// \brief Default constructor. Creates an empty ensemble. Its
+      /// generator is seeded with Rand::Seed() and stream 0.
+      public: GaussMarkovProcessEnsemble();
+
+      /// \brief Create an ensemble of processes with the same parameters.
+      /// This will also call Set(), and in turn Reset().
+      /// \param[in] _size Number of processes.
+      /// \param[in] _start The start value of the processes.
+      /// \param[in] _theta The theta (\f$\theta\f$) parameter. A value of
+      /// zero will be used if this parameter is negative.
+      /// \param[in] _mu The mu (\f$\mu\f$) parameter.
+      /// \param[in] _sigma The sigma (\f$\sigma\f$) parameter. A value of
+      /// zero will be used if this parameter is negative.
+      /// \sa GaussMarkovProcess::Update(const clock::duration &)
+      public: GaussMarkovProcessEnsemble(std::size_t _size, double _start,
+                  double _theta, double _mu, double _sigma);
+
+      /// \brief Copy constructor. The copy continues the same random
+      /// sequence.
+      /// \param[in] _ensemble Ensemble to copy.
+      public: GaussMarkovProcessEnsemble(
+                  const GaussMarkovProcessEnsemble &_ensemble);
+
+      /// \brief Destructor.
+      public: ~GaussMarkovProcessEnsemble();
+
+      /// \brief Assignment operator. The copy continues the same random
+      /// sequence.
+      /// \param[in] _ensemble Ensemble to copy.
+      /// \return Reference to this ensemble.
+      public: GaussMarkovProcessEnsemble &operator=(
+                  const GaussMarkovProcessEnsemble &_ensemble);
+
+      /// \brief Set the number of processes and their shared parameters.
+      /// This will also call Reset().
+      /// \param[in] _size Number of processes.
+      /// \param[in] _start The start value of the processes.
+      /// \param[in] _theta The theta (\f$\theta\f$) parameter.
+      /// \param[in] _mu The mu (\f$\mu\f$) parameter.
+      /// \param[in] _sigma The sigma (\f$\sigma\f$) parameter.
+      public: void Set(std::size_t _size, double _start, double _theta,
+                       double _mu, double _sigma);
+
+      /// \brief Set the parameters of each process. The number of processes
+      /// is the size of the vectors. This will also call Reset().
+      /// \param[in] _start The start value of each process.
+      /// \param[in] _theta The theta (\f$\theta\f$) parameter of each
+      /// process. A value of zero will be used for negative values.
+      /// \param[in] _mu The mu (\f$\mu\f$) parameter of each process.
+      /// \param[in] _sigma The sigma (\f$\sigma\f$) parameter of each
+      /// process. A value of zero will be used for negative values.
+      /// \return False if the vectors have different sizes, in which case
+      /// the ensemble is not changed.
+      public: bool Set(const std::vector<double> &_start,
+                       const std::vector<double> &_theta,
+                       const std::vector<double> &_mu,
+                       const std::vector<double> &_sigma);
+
+      /// \brief Get the number of processes.
+      /// \return The number of processes.
+      public: std::size_t Size() const;
+
+      /// \brief Get the start values.
+      /// \return The start value of each process.
+      public: const std::vector<double> &Start() const;
+
+      /// \brief Get the current process values.
+      /// \return The value of each process.
+      public: const std::vector<double> &Values() const;
+
+      /// \brief Get the theta (\f$\theta\f$) values.
+      /// \return The theta value of each process.
+      public: const std::vector<double> &Theta() const;
+
+      /// \brief Get the mu (\f$\mu\f$) values.
+      /// \return The mu value of each process.
+      public: const std::vector<double> &Mu() const;
+
+      /// \brief Get the sigma (\f$\sigma\f$) values.
+      /// \return The sigma value of each process.
+      public: const std::vector<double> &Sigma() const;
+
+      /// \brief Get the generator of the normal samples, e.g. to seed it.
+      /// \return Reference to the generator.
+      public: RandomGenerator &Generator();
+
+      /// \brief Reset the processes. This will set the current value of
+      /// each process to its start value.
+      public: void Reset();
+
+      /// \brief Update all the processes and get their new values.
+      ///
+      /// Each process is updated with the equation of
+      /// GaussMarkovProcess::Update(const clock::duration &), with its own
+      /// normal sample. The samples of a step are drawn in process order
+      /// from Generator().
+      /// \param[in] _dt Length of the timestep after which a new sample
+      /// should be taken.
+      /// \return The new value of each process.
+      public: const std::vector<double> &Update(const clock::duration &_dt);
+
+      /// \brief Update all the processes and get their new values.
+      /// \param[in] _dt Length of the timestep in seconds.
+      /// \return The new value of each process.
+      /// \sa Update(const clock::duration &)
+      public: const std::vector<double> &Update(double _dt);
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<GaussMarkovProcessEnsemblePrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
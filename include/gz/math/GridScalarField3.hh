@@ -0,0 +1,755 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRID_SCALAR_FIELD3_HH_
+#define GZ_MATH_GRID_SCALAR_FIELD3_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Executor.hh>
+#include <gz/math/Region3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+#include <gz/math/detail/MarchingCubes.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Whether a scalar field can evaluate many points at once.
+      template<typename ScalarField3T, typename ScalarT, typename = void>
+      struct HasBatchEvaluate : std::false_type
+      {
+      };
+
+      /// \brief Whether a scalar field can evaluate many points at once.
+      template<typename ScalarField3T, typename ScalarT>
+      struct HasBatchEvaluate<ScalarField3T, ScalarT, std::void_t<
+          decltype(std::declval<const ScalarField3T &>().Evaluate(
+              std::declval<const Vector3<ScalarT> *>(), std::size_t(),
+              std::declval<ScalarT *>()))>> : std::true_type
+      {
+      };
+    }
+
+    /** \class GridScalarField3 GridScalarField3.hh\
+     * ignition/math/GridScalarField3.hh
+     */
+    /// \brief The GridScalarField3 class constructs a scalar field F in
+    /// R^3 from samples on a regular grid of nodes, such as wind, current
+    /// or density data, interpolated between the nodes.
+    ///
+    /// The nodes span the bounds of a Region3, with the first and last
+    /// node along each axis on the bounds. The samples are stored
+    /// contiguously with x varying fastest, then y, then z. Evaluation
+    /// finds the cell of a point with one division per axis, so it takes
+    /// the same time anywhere in the grid. The field is NaN outside of its
+    /// region.
+    ///
+    /// The field meets the requirements of a piece of a
+    /// PiecewiseScalarField3, including Minimum() and stream output.
+    ///
+    /// Sample() tabulates another field, such as a PiecewiseScalarField3
+    /// or an AdditivelySeparableScalarField3, onto the nodes, and
+    /// IsoSurface() extracts a level set of the nodes as a triangle mesh.
+    ///
+    /// \tparam ScalarT a numeric type for which std::numeric_limits<> traits
+    ///   have been specialized.
+    template<typename ScalarT>
+    class GridScalarField3
+    {
+      /// \brief Interpolation between the nodes.
+      public: enum InterpolationType
+              {
+                /// \brief Trilinear interpolation of the 8 nodes around a
+                /// point, which is continuous. This is the default.
+                TRILINEAR = 0,
+
+                /// \brief Tricubic Catmull-Rom interpolation of the 64
+                /// nodes around a point, which has a continuous gradient.
+                /// Nodes past the bounds repeat the nodes on the bounds.
+                TRICUBIC = 1
+              };
+
+      /// \brief Constructor, for a field that is undefined everywhere.
+      public: GridScalarField3() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _region Region spanned by the nodes. It must be
+      ///   bounded and not empty.
+      /// \param[in] _nx Number of nodes along x, at least 2.
+      /// \param[in] _ny Number of nodes along y, at least 2.
+      /// \param[in] _nz Number of nodes along z, at least 2.
+      /// \param[in] _value Initial value of all the nodes.
+      /// If the region or the numbers of nodes are not valid, the field
+      /// has no nodes and is undefined everywhere.
+      public: GridScalarField3(const Region3<ScalarT> &_region,
+                               const std::size_t _nx, const std::size_t _ny,
+                               const std::size_t _nz,
+                               const ScalarT _value = ScalarT(0))
+      {
+        using std::isfinite;
+        const Interval<ScalarT> *intervals[3] = {
+          &_region.Ix(), &_region.Iy(), &_region.Iz()};
+        const std::size_t counts[3] = {_nx, _ny, _nz};
+        for (int i = 0; i < 3; ++i)
+        {
+          const ScalarT left = intervals[i]->LeftValue();
+          const ScalarT right = intervals[i]->RightValue();
+          if (counts[i] < 2 || !isfinite(left) || !isfinite(right) ||
+              !(left < right))
+          {
+            return;
+          }
+        }
+
+        this->region = _region;
+        this->nx = _nx;
+        this->ny = _ny;
+        this->nz = _nz;
+        for (int i = 0; i < 3; ++i)
+        {
+          this->origin[i] = intervals[i]->LeftValue();
+          this->spacing[i] =
+              (intervals[i]->RightValue() - intervals[i]->LeftValue()) /
+              static_cast<ScalarT>(counts[i] - 1);
+          this->inverseSpacing[i] = ScalarT(1) / this->spacing[i];
+        }
+        this->values.assign(_nx * _ny * _nz, _value);
+      }
+
+      /// \brief Check that the field has nodes.
+      /// \return True if the field was built from valid arguments.
+      public: bool Valid() const
+      {
+        return !this->values.empty();
+      }
+
+      /// \brief Get the region spanned by the nodes.
+      /// \return The region, which is empty if the field is not valid.
+      public: const Region3<ScalarT> &Region() const
+      {
+        return this->region;
+      }
+
+      /// \brief Get the number of nodes along x.
+      /// \return The number of nodes.
+      public: std::size_t NodeCountX() const
+      {
+        return this->nx;
+      }
+
+      /// \brief Get the number of nodes along y.
+      /// \return The number of nodes.
+      public: std::size_t NodeCountY() const
+      {
+        return this->ny;
+      }
+
+      /// \brief Get the number of nodes along z.
+      /// \return The number of nodes.
+      public: std::size_t NodeCountZ() const
+      {
+        return this->nz;
+      }
+
+      /// \brief Get the distance between nodes along each axis.
+      /// \return The spacing, which is zero if the field is not valid.
+      public: const Vector3<ScalarT> &Spacing() const
+      {
+        return this->spacing;
+      }
+
+      /// \brief Get the position of a node.
+      /// \param[in] _i Index of the node along x.
+      /// \param[in] _j Index of the node along y.
+      /// \param[in] _k Index of the node along z.
+      /// \return The position.
+      public: Vector3<ScalarT> Node(const std::size_t _i, const std::size_t _j,
+                                    const std::size_t _k) const
+      {
+        return this->origin + Vector3<ScalarT>(
+            static_cast<ScalarT>(_i) * this->spacing.X(),
+            static_cast<ScalarT>(_j) * this->spacing.Y(),
+            static_cast<ScalarT>(_k) * this->spacing.Z());
+      }
+
+      /// \brief Get the linear index of a node in Values().
+      /// \param[in] _i Index of the node along x.
+      /// \param[in] _j Index of the node along y.
+      /// \param[in] _k Index of the node along z.
+      /// \return _i + NodeCountX() * (_j + NodeCountY() * _k).
+      public: std::size_t Index(const std::size_t _i, const std::size_t _j,
+                                const std::size_t _k) const
+      {
+        return _i + this->nx * (_j + this->ny * _k);
+      }
+
+      /// \brief Get the value of a node.
+      /// \param[in] _i Index of the node along x.
+      /// \param[in] _j Index of the node along y.
+      /// \param[in] _k Index of the node along z.
+      /// \return The value.
+      public: ScalarT Value(const std::size_t _i, const std::size_t _j,
+                            const std::size_t _k) const
+      {
+        return this->values[this->Index(_i, _j, _k)];
+      }
+
+      /// \brief Set the value of a node.
+      /// \param[in] _i Index of the node along x.
+      /// \param[in] _j Index of the node along y.
+      /// \param[in] _k Index of the node along z.
+      /// \param[in] _value The value.
+      public: void SetValue(const std::size_t _i, const std::size_t _j,
+                            const std::size_t _k, const ScalarT _value)
+      {
+        this->values[this->Index(_i, _j, _k)] = _value;
+      }
+
+      /// \brief Get the values of the nodes, to fill them in bulk.
+      /// \return The values, in the order given by Index().
+      public: std::vector<ScalarT> &Values()
+      {
+        return this->values;
+      }
+
+      /// \brief Get the values of the nodes.
+      /// \return The values, in the order given by Index().
+      public: const std::vector<ScalarT> &Values() const
+      {
+        return this->values;
+      }
+
+      /// \brief Get the interpolation between the nodes.
+      /// \return The interpolation type.
+      public: InterpolationType Interpolation() const
+      {
+        return this->interpolation;
+      }
+
+      /// \brief Set the interpolation between the nodes.
+      /// \param[in] _interpolation The interpolation type.
+      public: void SetInterpolation(const InterpolationType _interpolation)
+      {
+        this->interpolation = _interpolation;
+      }
+
+      /// \brief Set the value of every node to the value of another field
+      /// at the node. Rows of nodes along x are evaluated with the batch
+      /// Evaluate() of the field when it has one, and with its call
+      /// operator otherwise.
+      /// \param[in] _field The field to sample. It is evaluated from
+      ///   several threads at once, so evaluation must be thread safe, as
+      ///   it is for the scalar fields of this library.
+      /// \param[in] _threads Number of threads sampling layers of nodes
+      ///   along z. A value of 0 uses the number of hardware threads.
+      ///   Small grids always use a single thread. The values are the same
+      ///   for any number of threads.
+      public: template<typename ScalarField3T>
+              void Sample(const ScalarField3T &_field,
+                          const unsigned int _threads = 1)
+      {
+        auto sample = [this, &_field](const std::size_t _kBegin,
+                                      const std::size_t _kEnd)
+        {
+          this->SampleLayers(_field, _kBegin, _kEnd);
+        };
+
+        std::size_t threads = _threads;
+        if (threads == 0)
+          threads = std::thread::hardware_concurrency();
+        threads = std::min({threads, this->nz,
+                            this->values.size() / kMinNodesPerThread});
+        if (threads <= 1)
+        {
+          sample(0, this->nz);
+          return;
+        }
+
+        std::vector<std::thread> workers;
+        for (std::size_t t = 1; t < threads; ++t)
+        {
+          workers.emplace_back(sample, this->nz * t / threads,
+                               this->nz * (t + 1) / threads);
+        }
+        sample(0, this->nz / threads);
+        for (auto &worker : workers)
+          worker.join();
+      }
+
+      /// \brief Set the value of every node to the value of another field
+      /// at the node, with blocks of layers of nodes along z run by an
+      /// executor. The values are the same as with the threads overload.
+      /// \param[in] _field The field to sample, which must be thread safe.
+      /// \param[in] _executor Executor running the blocks of layers.
+      public: template<typename ScalarField3T>
+              void Sample(const ScalarField3T &_field, Executor &_executor)
+      {
+        const std::size_t blocks = std::min(this->nz,
+            _executor.BlockCount(this->values.size(), kMinNodesPerThread));
+        _executor.ForEachBlock(this->nz, blocks,
+          [this, &_field](const std::size_t _kBegin, const std::size_t _kEnd,
+                          std::size_t)
+          {
+            this->SampleLayers(_field, _kBegin, _kEnd);
+          });
+      }
+
+      /// \brief Extract the surface where the field equals a value, with
+      /// marching cubes over the cells of the grid. The surface crosses
+      /// each edge between a node below `_isovalue` and a node that is
+      /// not at the linear interpolation of their values, and each such
+      /// vertex is shared by the triangles around the edge. The surface is
+      /// closed away from the bounds of the region. Cells with a NaN node
+      /// are skipped.
+      /// \param[in] _isovalue Value of the field on the surface.
+      /// \param[out] _vertices Vertices of the surface.
+      /// \param[out] _indices Indices in `_vertices` of the corners of each
+      ///   triangle, three per triangle. Triangles are counter-clockwise
+      ///   when seen from the side where the field is above `_isovalue`,
+      ///   which is the outside for MeshMassProperties when the field is a
+      ///   signed distance.
+      public: void IsoSurface(const ScalarT _isovalue,
+                              std::vector<Vector3<ScalarT>> &_vertices,
+                              std::vector<std::size_t> &_indices) const
+      {
+        _vertices.clear();
+        _indices.clear();
+        if (this->values.empty())
+          return;
+
+        const detail::MarchingCubesTable &table = detail::MarchingCubes();
+        const std::size_t layer = this->nx * this->ny;
+        const std::size_t offsets[8] = {
+          0, 1, this->nx, this->nx + 1,
+          layer, layer + 1, layer + this->nx, layer + this->nx + 1};
+        constexpr std::size_t kNoVertex =
+            std::numeric_limits<std::size_t>::max();
+
+        // Vertices on the 3 edges starting at each node of the two layers
+        // of nodes of the current cells.
+        std::vector<std::size_t> edgeVertices[2];
+        edgeVertices[0].assign(3 * layer, kNoVertex);
+        edgeVertices[1].assign(3 * layer, kNoVertex);
+
+        for (std::size_t k = 0; k + 1 < this->nz; ++k)
+        {
+          if (k > 0)
+          {
+            std::fill(edgeVertices[(k + 1) % 2].begin(),
+                      edgeVertices[(k + 1) % 2].end(), kNoVertex);
+          }
+          for (std::size_t j = 0; j + 1 < this->ny; ++j)
+          {
+            for (std::size_t i = 0; i + 1 < this->nx; ++i)
+            {
+              const std::size_t base = this->Index(i, j, k);
+              ScalarT corners[8];
+              int config = 0;
+              bool defined = true;
+              for (int c = 0; c < 8; ++c)
+              {
+                corners[c] = this->values[base + offsets[c]];
+                defined = defined && !std::isnan(corners[c]);
+                if (corners[c] < _isovalue)
+                  config |= 1 << c;
+              }
+              if (!defined || config == 0 || config == 255)
+                continue;
+
+              for (const int8_t *e = table.triangles[config]; *e >= 0; ++e)
+              {
+                const int c0 = table.edgeCorners[*e][0];
+                const int c1 = table.edgeCorners[*e][1];
+                std::size_t &vertex =
+                    edgeVertices[(k + (c0 >> 2)) % 2][
+                        3 * (base % layer + offsets[c0 & 3]) + *e / 4];
+                if (vertex == kNoVertex)
+                {
+                  vertex = _vertices.size();
+                  const ScalarT t = (_isovalue - corners[c0]) /
+                                    (corners[c1] - corners[c0]);
+                  const Vector3<ScalarT> p0 = this->Node(
+                      i + (c0 & 1), j + ((c0 >> 1) & 1), k + (c0 >> 2));
+                  const Vector3<ScalarT> p1 = this->Node(
+                      i + (c1 & 1), j + ((c1 >> 1) & 1), k + (c1 >> 2));
+                  _vertices.push_back(p0 + (p1 - p0) * t);
+                }
+                _indices.push_back(vertex);
+              }
+            }
+          }
+        }
+      }
+
+      /// \brief Evaluate the scalar field at `_point`
+      /// \param[in] _point scalar field argument
+      /// \return the interpolated value, or NaN if `_point` is outside of
+      ///   the region of the field
+      public: ScalarT Evaluate(const Vector3<ScalarT> &_point) const
+      {
+        if (this->values.empty() || !this->region.Contains(_point))
+          return std::numeric_limits<ScalarT>::quiet_NaN();
+        if (this->interpolation == TRICUBIC)
+          return this->Tricubic(_point);
+        return this->Trilinear(_point);
+      }
+
+      /// \brief Evaluate the scalar field at many points.
+      /// \param[in] _points Array of _count scalar field arguments.
+      /// \param[in] _count Number of points.
+      /// \param[out] _values Array of at least _count values, written with
+      /// the result of evaluating `F(_points[i])`.
+      public: void Evaluate(const Vector3<ScalarT> *_points,
+                            const std::size_t _count,
+                            ScalarT *_values) const
+      {
+        if (this->values.empty())
+        {
+          std::fill(_values, _values + _count,
+                    std::numeric_limits<ScalarT>::quiet_NaN());
+          return;
+        }
+
+        // Branch on the interpolation once for the whole batch.
+        if (this->interpolation == TRICUBIC)
+        {
+          for (std::size_t i = 0; i < _count; ++i)
+          {
+            _values[i] = this->region.Contains(_points[i]) ?
+                this->Tricubic(_points[i]) :
+                std::numeric_limits<ScalarT>::quiet_NaN();
+          }
+        }
+        else
+        {
+          for (std::size_t i = 0; i < _count; ++i)
+          {
+            _values[i] = this->region.Contains(_points[i]) ?
+                this->Trilinear(_points[i]) :
+                std::numeric_limits<ScalarT>::quiet_NaN();
+          }
+        }
+      }
+
+      /// \brief Call operator overload
+      /// \see GridScalarField3::Evaluate()
+      /// \param[in] _point scalar field argument
+      /// \return the result of evaluating `F(_point)`
+      public: ScalarT operator()(const Vector3<ScalarT> &_point) const
+      {
+        return this->Evaluate(_point);
+      }
+
+      /// \brief Compute scalar field minimum in a `_region`. A trilinear
+      /// interpolant reaches its minimum over a box at a corner of the
+      /// box clipped to a cell, so the field is evaluated at the bounds of
+      /// the region and at the nodes between them. This is exact for
+      /// TRILINEAR interpolation, and misses undershoots of TRICUBIC
+      /// interpolation between the nodes.
+      /// \param[in] _region scalar field argument set to check
+      /// \param[out] _pMin scalar field argument that yields
+      ///   the minimum, or NaN if the field is not defined in `_region`
+      /// \return the scalar field minimum in the given `_region`,
+      ///   or NaN if the field is not defined in `_region`
+      public: ScalarT Minimum(const Region3<ScalarT> &_region,
+                              Vector3<ScalarT> &_pMin) const
+      {
+        _pMin = Vector3<ScalarT>::NaN;
+        const Region3<ScalarT> clipped = this->region.Intersection(_region);
+        if (this->values.empty() || clipped.Empty())
+          return std::numeric_limits<ScalarT>::quiet_NaN();
+
+        // Coordinates to check along each axis.
+        const Interval<ScalarT> *intervals[3] = {
+          &clipped.Ix(), &clipped.Iy(), &clipped.Iz()};
+        const std::size_t counts[3] = {this->nx, this->ny, this->nz};
+        std::vector<ScalarT> coords[3];
+        for (int a = 0; a < 3; ++a)
+        {
+          const ScalarT lo = intervals[a]->LeftValue();
+          const ScalarT hi = intervals[a]->RightValue();
+          coords[a].push_back(lo);
+          const ScalarT first = std::ceil(
+              (lo - this->origin[a]) * this->inverseSpacing[a]);
+          for (std::size_t n = static_cast<std::size_t>(
+                   std::max(first, ScalarT(0)));
+               n < counts[a]; ++n)
+          {
+            const ScalarT c = this->origin[a] +
+                static_cast<ScalarT>(n) * this->spacing[a];
+            if (c >= hi)
+              break;
+            if (c > lo)
+              coords[a].push_back(c);
+          }
+          if (hi > lo)
+            coords[a].push_back(hi);
+        }
+
+        ScalarT yMin = std::numeric_limits<ScalarT>::infinity();
+        for (const ScalarT z : coords[2])
+        {
+          for (const ScalarT y : coords[1])
+          {
+            for (const ScalarT x : coords[0])
+            {
+              const Vector3<ScalarT> p(x, y, z);
+              const ScalarT value = this->interpolation == TRICUBIC ?
+                  this->Tricubic(p) : this->Trilinear(p);
+              if (value < yMin)
+              {
+                yMin = value;
+                _pMin = p;
+              }
+            }
+          }
+        }
+        if (_pMin.IsFinite())
+          return yMin;
+        return std::numeric_limits<ScalarT>::quiet_NaN();
+      }
+
+      /// \brief Compute scalar field minimum in a `_region`
+      /// \param[in] _region scalar field argument set to check
+      /// \return the scalar field minimum in the given `_region`,
+      ///   or NaN if the field is not defined in `_region`
+      public: ScalarT Minimum(const Region3<ScalarT> &_region) const
+      {
+        Vector3<ScalarT> pMin;
+        return this->Minimum(_region, pMin);
+      }
+
+      /// \brief Compute scalar field minimum
+      /// \param[out] _pMin scalar field argument that yields
+      ///   the minimum, or NaN if the field is not valid
+      /// \return the scalar field minimum
+      public: ScalarT Minimum(Vector3<ScalarT> &_pMin) const
+      {
+        return this->Minimum(Region3<ScalarT>::Unbounded, _pMin);
+      }
+
+      /// \brief Compute scalar field minimum
+      /// \return the scalar field minimum
+      public: ScalarT Minimum() const
+      {
+        Vector3<ScalarT> pMin;
+        return this->Minimum(Region3<ScalarT>::Unbounded, pMin);
+      }
+
+      /// \brief Stream insertion operator
+      /// \param _out output stream
+      /// \param _field GridScalarField3 to output
+      /// \return the stream
+      public: friend std::ostream &operator<<(
+          std::ostream &_out,
+          const gz::math::GridScalarField3<ScalarT> &_field)
+      {
+        return _out << "grid " << _field.nx << "x" << _field.ny << "x"
+                    << _field.nz << " over " << _field.region;
+      }
+
+      /// \brief Find the cell of a point along an axis.
+      /// \param[in] _axis The axis.
+      /// \param[in] _coord Coordinate of the point, inside of the region.
+      /// \param[in] _count Number of nodes along the axis.
+      /// \param[out] _t Position of the point in the cell, from 0 to 1.
+      /// \return Index of the first node of the cell.
+      private: std::size_t Cell(const int _axis, const ScalarT _coord,
+                                const std::size_t _count, ScalarT &_t) const
+      {
+        const ScalarT u =
+            (_coord - this->origin[_axis]) * this->inverseSpacing[_axis];
+        const ScalarT last = static_cast<ScalarT>(_count - 2);
+        const ScalarT cell = std::min(std::max(std::floor(u), ScalarT(0)),
+                                      last);
+        _t = std::min(std::max(u - cell, ScalarT(0)), ScalarT(1));
+        return static_cast<std::size_t>(cell);
+      }
+
+      /// \brief Interpolate the 8 nodes around a point.
+      /// \param[in] _point A point inside of the region.
+      /// \return The interpolated value.
+      private: ScalarT Trilinear(const Vector3<ScalarT> &_point) const
+      {
+        ScalarT tx, ty, tz;
+        const std::size_t i = this->Cell(0, _point.X(), this->nx, tx);
+        const std::size_t j = this->Cell(1, _point.Y(), this->ny, ty);
+        const std::size_t k = this->Cell(2, _point.Z(), this->nz, tz);
+
+        const ScalarT *v = this->values.data() + this->Index(i, j, k);
+        const std::size_t dy = this->nx;
+        const std::size_t dz = this->nx * this->ny;
+        const ScalarT c00 = v[0] + tx * (v[1] - v[0]);
+        const ScalarT c10 = v[dy] + tx * (v[dy + 1] - v[dy]);
+        const ScalarT c01 = v[dz] + tx * (v[dz + 1] - v[dz]);
+        const ScalarT c11 = v[dz + dy] + tx * (v[dz + dy + 1] - v[dz + dy]);
+        const ScalarT c0 = c00 + ty * (c10 - c00);
+        const ScalarT c1 = c01 + ty * (c11 - c01);
+        return c0 + tz * (c1 - c0);
+      }
+
+      /// \brief Get the Catmull-Rom weights of 4 consecutive nodes.
+      /// \param[in] _t Position of the point between the middle nodes.
+      /// \param[out] _w The weights.
+      private: static void CubicWeights(const ScalarT _t, ScalarT _w[4])
+      {
+        const ScalarT t2 = _t * _t;
+        const ScalarT t3 = t2 * _t;
+        _w[0] = (-t3 + 2 * t2 - _t) / 2;
+        _w[1] = (3 * t3 - 5 * t2 + 2) / 2;
+        _w[2] = (-3 * t3 + 4 * t2 + _t) / 2;
+        _w[3] = (t3 - t2) / 2;
+      }
+
+      /// \brief Get the indices of 4 consecutive nodes, repeating the
+      /// nodes on the bounds.
+      /// \param[in] _first Index of the first node of the cell.
+      /// \param[in] _count Number of nodes along the axis.
+      /// \param[out] _n The indices.
+      private: static void CubicNodes(const std::size_t _first,
+                                      const std::size_t _count,
+                                      std::size_t _n[4])
+      {
+        _n[0] = _first > 0 ? _first - 1 : 0;
+        _n[1] = _first;
+        _n[2] = _first + 1;
+        _n[3] = std::min(_first + 2, _count - 1);
+      }
+
+      /// \brief Interpolate the 64 nodes around a point.
+      /// \param[in] _point A point inside of the region.
+      /// \return The interpolated value.
+      private: ScalarT Tricubic(const Vector3<ScalarT> &_point) const
+      {
+        ScalarT tx, ty, tz;
+        const std::size_t i = this->Cell(0, _point.X(), this->nx, tx);
+        const std::size_t j = this->Cell(1, _point.Y(), this->ny, ty);
+        const std::size_t k = this->Cell(2, _point.Z(), this->nz, tz);
+
+        ScalarT wx[4], wy[4], wz[4];
+        CubicWeights(tx, wx);
+        CubicWeights(ty, wy);
+        CubicWeights(tz, wz);
+        std::size_t ix[4], iy[4], iz[4];
+        CubicNodes(i, this->nx, ix);
+        CubicNodes(j, this->ny, iy);
+        CubicNodes(k, this->nz, iz);
+
+        ScalarT result = 0;
+        for (int c = 0; c < 4; ++c)
+        {
+          ScalarT plane = 0;
+          for (int b = 0; b < 4; ++b)
+          {
+            const ScalarT *row = this->values.data() +
+                this->nx * (iy[b] + this->ny * iz[c]);
+            const ScalarT line = wx[0] * row[ix[0]] + wx[1] * row[ix[1]] +
+                                 wx[2] * row[ix[2]] + wx[3] * row[ix[3]];
+            plane += wy[b] * line;
+          }
+          result += wz[c] * plane;
+        }
+        return result;
+      }
+
+      /// \brief Set the value of the nodes of layers along z to the value
+      /// of another field at the nodes.
+      /// \param[in] _field The field to sample.
+      /// \param[in] _kBegin First layer.
+      /// \param[in] _kEnd End of the layers.
+      private: template<typename ScalarField3T>
+               void SampleLayers(const ScalarField3T &_field,
+                                 const std::size_t _kBegin,
+                                 const std::size_t _kEnd)
+      {
+        std::vector<Vector3<ScalarT>> row(this->nx);
+        for (std::size_t k = _kBegin; k < _kEnd; ++k)
+        {
+          for (std::size_t j = 0; j < this->ny; ++j)
+          {
+            for (std::size_t i = 0; i < this->nx; ++i)
+              row[i] = this->Node(i, j, k);
+            ScalarT *out = this->values.data() + this->Index(0, j, k);
+            if constexpr (
+                detail::HasBatchEvaluate<ScalarField3T, ScalarT>::value)
+            {
+              _field.Evaluate(row.data(), this->nx, out);
+            }
+            else
+            {
+              for (std::size_t i = 0; i < this->nx; ++i)
+                out[i] = _field(row[i]);
+            }
+          }
+        }
+      }
+
+      /// \brief Minimum number of nodes sampled by each thread.
+      private: static constexpr std::size_t kMinNodesPerThread = 16384;
+
+      /// \brief Region spanned by the nodes.
+      private: Region3<ScalarT> region;
+
+      /// \brief Position of the first node.
+      private: Vector3<ScalarT> origin;
+
+      /// \brief Distance between nodes along each axis.
+      private: Vector3<ScalarT> spacing;
+
+      /// \brief Inverse of the distance between nodes along each axis.
+      private: Vector3<ScalarT> inverseSpacing;
+
+      /// \brief Number of nodes along x.
+      private: std::size_t nx = 0;
+
+      /// \brief Number of nodes along y.
+      private: std::size_t ny = 0;
+
+      /// \brief Number of nodes along z.
+      private: std::size_t nz = 0;
+
+      /// \brief Interpolation between the nodes.
+      private: InterpolationType interpolation = TRILINEAR;
+
+      /// \brief Values of the nodes.
+      private: std::vector<ScalarT> values;
+    };
+
+    /// \typedef GridScalarField3<double> GridScalarField3d
+    /// \brief GridScalarField3 with double precision.
+    typedef GridScalarField3<double> GridScalarField3d;
+
+    /// \typedef GridScalarField3<float> GridScalarField3f
+    /// \brief GridScalarField3 with float precision.
+    typedef GridScalarField3<float> GridScalarField3f;
+    }
+  }
+}
+#endif
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_HALF_HH_
+#define GZ_MATH_HALF_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Half Half.hh ignition/math/Half.hh
+    /// \brief An IEEE 754 binary16 (half precision) floating point value,
+    /// used as a storage format for bulk data such as point clouds and
+    /// vertex buffers, where it halves the memory traffic of float.
+    ///
+    /// A half has 11 significant bits and a largest finite value of 65504.
+    /// Arithmetic is done in float: a half is converted to float, used, and
+    /// converted back. Conversion from float rounds to nearest even,
+    /// values too large to be represented become infinite, and NaN becomes
+    /// a quiet NaN. Conversion to float is exact.
+    ///
+    /// The array conversions FromFloat and ToFloat give the same results
+    /// as the conversions of a single value, and use vector instructions
+    /// when available.
+    class IGNITION_MATH_VISIBLE Half
+    {
+      /// \brief Largest finite value of a half.
+      public: static constexpr float Max = 65504.0f;
+
+      /// \brief Default constructor. The value is positive zero.
+      public: constexpr Half() = default;
+
+      /// \brief Constructor from a float, rounded to nearest even.
+      /// \param[in] _f Value to convert.
+      public: explicit Half(const float _f)
+        : bits(FloatToBits(_f))
+      {
+      }
+
+      /// \brief Convert to float. The conversion is exact.
+      /// \return The value as a float.
+      public: explicit operator float() const
+      {
+        return BitsToFloat(this->bits);
+      }
+
+      /// \brief Get the value as a float. The conversion is exact.
+      /// \return The value as a float.
+      public: float Float() const
+      {
+        return BitsToFloat(this->bits);
+      }
+
+      /// \brief Get the binary16 encoding of the value.
+      /// \return The bits of the value.
+      public: constexpr uint16_t Bits() const
+      {
+        return this->bits;
+      }
+
+      /// \brief Create a half from its binary16 encoding.
+      /// \param[in] _bits The bits of the value.
+      /// \return The half.
+      public: static constexpr Half FromBits(const uint16_t _bits)
+      {
+        Half h;
+        h.bits = _bits;
+        return h;
+      }
+
+      /// \brief Equality operator. Compares the encodings, so that NaN is
+      /// equal to itself and positive zero differs from negative zero.
+      /// \param[in] _h Half to compare.
+      /// \return True if both halves have the same encoding.
+      public: constexpr bool operator==(const Half &_h) const
+      {
+        return this->bits == _h.bits;
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _h Half to compare.
+      /// \return True if the halves have different encodings.
+      public: constexpr bool operator!=(const Half &_h) const
+      {
+        return this->bits != _h.bits;
+      }
+
+      /// \brief Convert an array of floats to halves.
+      /// \param[in] _in Values to convert.
+      /// \param[in] _count Number of values.
+      /// \param[out] _out Converted values, _count of them. It may not
+      /// overlap _in.
+      public: static void FromFloat(const float *_in,
+                                    const std::size_t _count, Half *_out);
+
+      /// \brief Convert an array of halves to floats.
+      /// \param[in] _in Values to convert.
+      /// \param[in] _count Number of values.
+      /// \param[out] _out Converted values, _count of them. It may not
+      /// overlap _in.
+      public: static void ToFloat(const Half *_in, const std::size_t _count,
+                                  float *_out);
+
+      /// \brief Convert a float to the encoding of a half, rounding to
+      /// nearest even.
+      /// \param[in] _f Value to convert.
+      /// \return The bits of the half.
+      public: static uint16_t FloatToBits(const float _f)
+      {
+        uint32_t u;
+        std::memcpy(&u, &_f, sizeof(u));
+        const uint32_t sign = u & 0x80000000u;
+        u ^= sign;
+
+        uint32_t h;
+        // Values of at least 2^16 round to infinity.
+        if (u >= ((127u + 16u) << 23))
+        {
+          h = u > (255u << 23) ? 0x7e00u : 0x7c00u;
+        }
+        // Values below 2^-14 give a subnormal half or zero. Adding a
+        // power of two moves the half mantissa to the low bits of the
+        // float, and the addition rounds it.
+        else if (u < (113u << 23))
+        {
+          const uint32_t magicBits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+          float magic;
+          std::memcpy(&magic, &magicBits, sizeof(magic));
+          float f;
+          std::memcpy(&f, &u, sizeof(f));
+          f += magic;
+          std::memcpy(&u, &f, sizeof(u));
+          h = u - magicBits;
+        }
+        // Normal values: rebias the exponent and round the mantissa to
+        // nearest even.
+        else
+        {
+          const uint32_t mantOdd = (u >> 13) & 1u;
+          u += (static_cast<uint32_t>(15 - 127) << 23) + 0xfffu + mantOdd;
+          h = u >> 13;
+        }
+        return static_cast<uint16_t>(h | (sign >> 16));
+      }
+
+      /// \brief Convert the encoding of a half to a float. The conversion
+      /// is exact.
+      /// \param[in] _bits The bits of the half.
+      /// \return The value as a float.
+      public: static float BitsToFloat(const uint16_t _bits)
+      {
+        const uint32_t shiftedExp = 0x7c00u << 13;
+        uint32_t u = (_bits & 0x7fffu) << 13;
+        const uint32_t exp = u & shiftedExp;
+        u += (127u - 15u) << 23;
+
+        float f;
+        // Infinity or NaN.
+        if (exp == shiftedExp)
+        {
+          u += (128u - 16u) << 23;
+        }
+        // Zero or subnormal: renormalize with a subtraction.
+        else if (exp == 0)
+        {
+          u += 1u << 23;
+          const uint32_t magicBits = 113u << 23;
+          float magic;
+          std::memcpy(&magic, &magicBits, sizeof(magic));
+          std::memcpy(&f, &u, sizeof(f));
+          f -= magic;
+          std::memcpy(&u, &f, sizeof(u));
+        }
+        u |= static_cast<uint32_t>(_bits & 0x8000u) << 16;
+        std::memcpy(&f, &u, sizeof(f));
+        return f;
+      }
+
+      /// \brief The binary16 encoding.
+      private: uint16_t bits = 0;
+    };
+
+    static_assert(sizeof(Half) == 2, "Half must be two bytes");
+    }
+  }
+}
+#endif
@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_HASH_HH_
+#define GZ_MATH_HASH_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/Vector4.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \brief Mix the bits of a 64 bit value, with the finalizer of
+    /// SplitMix64, so that values that differ in a few bits get unrelated
+    /// hashes.
+    /// \param[in] _value The value.
+    /// \return The mixed value.
+    constexpr uint64_t HashMix(uint64_t _value)
+    {
+      _value = (_value ^ (_value >> 30)) * 0xbf58476d1ce4e5b9ull;
+      _value = (_value ^ (_value >> 27)) * 0x94d049bb133111ebull;
+      return _value ^ (_value >> 31);
+    }
+
+    /// \brief Combine a hash into a seed, in order, such as to hash the
+    /// components of a vector.
+    /// \param[in,out] _seed The seed, updated with the hash.
+    /// \param[in] _hash The hash to combine.
+    constexpr void HashCombine(std::size_t &_seed, const std::size_t _hash)
+    {
+      _seed = static_cast<std::size_t>(HashMix(
+          static_cast<uint64_t>(_seed) * 0x9e3779b97f4a7c15ull +
+          static_cast<uint64_t>(_hash)));
+    }
+
+    /// \brief Get the hash of an integer.
+    /// \param[in] _value The value.
+    /// \return The hash.
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value, std::size_t>::type
+    HashValue(const T _value)
+    {
+      return static_cast<std::size_t>(HashMix(static_cast<uint64_t>(_value)));
+    }
+
+    /// \brief Get the bits of an integer, to compare and hash it.
+    /// \param[in] _value The value.
+    /// \return The bits.
+    template<typename T>
+    constexpr typename std::enable_if<std::is_integral<T>::value,
+                                      uint64_t>::type
+    ExactBits(const T _value)
+    {
+      return static_cast<uint64_t>(_value);
+    }
+
+    /// \brief Get the bits of a floating point number, to compare and hash
+    /// it. Zero and negative zero have the same bits, and a float has the
+    /// bits of the same value as a double.
+    /// \param[in] _value The value.
+    /// \return The bits.
+    template<typename T>
+    typename std::enable_if<std::is_floating_point<T>::value,
+                            uint64_t>::type
+    ExactBits(const T _value)
+    {
+      // Adding zero turns negative zero into zero and keeps other values.
+      const double value = static_cast<double>(_value) + 0.0;
+      uint64_t bits = 0;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+
+    /// \brief Get the hash of a floating point number, from its bits. Zero
+    /// and negative zero have the same hash.
+    /// \param[in] _value The value.
+    /// \return The hash.
+    template<typename T>
+    typename std::enable_if<std::is_floating_point<T>::value,
+                            std::size_t>::type
+    HashValue(const T _value)
+    {
+      return static_cast<std::size_t>(HashMix(ExactBits(_value)));
+    }
+
+    /// \brief Get the cell of a regular grid that contains a point, such
+    /// as a voxel index to use as the key of a hash set or map. Coordinates
+    /// are clamped to the range of int, and NaN gives the lowest cell.
+    /// \param[in] _point The point.
+    /// \param[in] _cellSize Size of the cells, positive.
+    /// \return The cell, whose coordinates are the points divided by the
+    /// cell size, rounded down.
+    template<typename T>
+    Vector3i QuantizedCell(const Vector3<T> &_point, const T _cellSize)
+    {
+      Vector3i cell;
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        const double c = std::floor(static_cast<double>(_point[axis]) /
+            static_cast<double>(_cellSize));
+        if (c >= static_cast<double>(std::numeric_limits<int>::max()))
+          cell[axis] = std::numeric_limits<int>::max();
+        else if (c >= static_cast<double>(std::numeric_limits<int>::min()))
+          cell[axis] = static_cast<int>(c);
+        else
+          cell[axis] = std::numeric_limits<int>::min();
+      }
+      return cell;
+    }
+
+    /// \brief Exact equality of vectors and quaternions, component by
+    /// component, to use with the std::hash specializations of this
+    /// header. Components are compared by their ExactBits, so that zero
+    /// equals negative zero and NaN equals a NaN with the same bits. The
+    /// operator== of floating point vectors and quaternions has a
+    /// tolerance, which no hash can follow, so that
+    /// std::unordered_set<Vector3d> could hold values that compare equal.
+    /// Use Vector3HashSet to merge points within a tolerance.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// std::unordered_set<gz::math::Vector3d,
+    ///     std::hash<gz::math::Vector3d>, gz::math::ExactlyEqual> seen;
+    /// ```
+    struct ExactlyEqual
+    {
+      /// \brief Compare two 2D vectors.
+      /// \param[in] _a First vector.
+      /// \param[in] _b Second vector.
+      /// \return True if every component has the same bits.
+      template<typename T>
+      bool operator()(const Vector2<T> &_a, const Vector2<T> &_b) const
+      {
+        return ExactBits(_a.X()) == ExactBits(_b.X()) &&
+               ExactBits(_a.Y()) == ExactBits(_b.Y());
+      }
+
+      /// \brief Compare two 3D vectors.
+      /// \param[in] _a First vector.
+      /// \param[in] _b Second vector.
+      /// \return True if every component has the same bits.
+      template<typename T>
+      bool operator()(const Vector3<T> &_a, const Vector3<T> &_b) const
+      {
+        return ExactBits(_a.X()) == ExactBits(_b.X()) &&
+               ExactBits(_a.Y()) == ExactBits(_b.Y()) &&
+               ExactBits(_a.Z()) == ExactBits(_b.Z());
+      }
+
+      /// \brief Compare two 4D vectors.
+      /// \param[in] _a First vector.
+      /// \param[in] _b Second vector.
+      /// \return True if every component has the same bits.
+      template<typename T>
+      bool operator()(const Vector4<T> &_a, const Vector4<T> &_b) const
+      {
+        return ExactBits(_a.X()) == ExactBits(_b.X()) &&
+               ExactBits(_a.Y()) == ExactBits(_b.Y()) &&
+               ExactBits(_a.Z()) == ExactBits(_b.Z()) &&
+               ExactBits(_a.W()) == ExactBits(_b.W());
+      }
+
+      /// \brief Compare two quaternions. A quaternion and its negation
+      /// are different, although they are the same rotation.
+      /// \param[in] _a First quaternion.
+      /// \param[in] _b Second quaternion.
+      /// \return True if every component has the same bits.
+      template<typename T>
+      bool operator()(const Quaternion<T> &_a, const Quaternion<T> &_b) const
+      {
+        return ExactBits(_a.W()) == ExactBits(_b.W()) &&
+               ExactBits(_a.X()) == ExactBits(_b.X()) &&
+               ExactBits(_a.Y()) == ExactBits(_b.Y()) &&
+               ExactBits(_a.Z()) == ExactBits(_b.Z());
+      }
+    };
+    }
+  }
+}
+
+namespace std
+{
+  /// \brief Hash of a 2D vector, from the exact values of its components.
+  /// Integer vectors, such as grid cells, can be used as is in unordered
+  /// containers; floating point vectors need ExactlyEqual.
+  template<typename T>
+  struct hash<ignition::math::Vector2<T>>
+  {
+    /// \brief Get the hash of a vector.
+    /// \param[in] _v The vector.
+    /// \return The hash.
+    std::size_t operator()(const ignition::math::Vector2<T> &_v) const
+    {
+      std::size_t seed = ignition::math::HashValue(_v.X());
+      ignition::math::HashCombine(seed, ignition::math::HashValue(_v.Y()));
+      return seed;
+    }
+  };
+
+  /// \brief Hash of a 3D vector, from the exact values of its components.
+  /// Integer vectors, such as voxel indices from QuantizedCell, can be
+  /// used as is in unordered containers; floating point vectors need
+  /// ExactlyEqual.
+  template<typename T>
+  struct hash<ignition::math::Vector3<T>>
+  {
+    /// \brief Get the hash of a vector.
+    /// \param[in] _v The vector.
+    /// \return The hash.
+    std::size_t operator()(const ignition::math::Vector3<T> &_v) const
+    {
+      std::size_t seed = ignition::math::HashValue(_v.X());
+      ignition::math::HashCombine(seed, ignition::math::HashValue(_v.Y()));
+      ignition::math::HashCombine(seed, ignition::math::HashValue(_v.Z()));
+      return seed;
+    }
+  };
+
+  /// \brief Hash of a 4D vector, from the exact values of its components.
+  template<typename T>
+  struct hash<ignition::math::Vector4<T>>
+  {
+    /// \brief Get the hash of a vector.
+    /// \param[in] _v The vector.
+    /// \return The hash.
+    std::size_t operator()(const ignition::math::Vector4<T> &_v) const
+    {
+      std::size_t seed = ignition::math::HashValue(_v.X());
+      ignition::math::HashCombine(seed, ignition::math::HashValue(_v.Y()));
+      ignition::math::HashCombine(seed, ignition::math::HashValue(_v.Z()));
+      ignition::math::HashCombine(seed, ignition::math::HashValue(_v.W()));
+      return seed;
+    }
+  };
+
+  /// \brief Hash of a quaternion, from the exact values of its
+  /// components. A quaternion and its negation have different hashes.
+  template<typename T>
+  struct hash<ignition::math::Quaternion<T>>
+  {
+    /// \brief Get the hash of a quaternion.
+    /// \param[in] _q The quaternion.
+    /// \return The hash.
+    std::size_t operator()(const ignition::math::Quaternion<T> &_q) const
+    {
+      std::size_t seed = ignition::math::HashValue(_q.W());
+      ignition::math::HashCombine(seed, ignition::math::HashValue(_q.X()));
+      ignition::math::HashCombine(seed, ignition::math::HashValue(_q.Y()));
+      ignition::math::HashCombine(seed, ignition::math::HashValue(_q.Z()));
+      return seed;
+    }
+  };
+}
+#endif
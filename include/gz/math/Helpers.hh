@@ -18,16 +18,21 @@
 #define GZ_MATH_FUNCTIONS_HH_
 
 #include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -403,7 +408,7 @@ namespace ignition
     /// \param[in] _min minimum
     /// \param[in] _max maximum
     template<typename T>
-    inline T clamp(T _v, T _min, T _max)
+    constexpr T clamp(T _v, T _min, T _max)
     {
       return std::max(std::min(_v, _max), _min);
     }
@@ -698,10 +703,391 @@ namespace ignition
         return _num + _multiple - remainder;
     }
 
+    namespace detail
+    {
+      /// \brief Sine and cosine of an angle in [-pi/4, pi/4], with the
+      /// minimax polynomials of the Cephes library.
+      /// \param[in] _r The angle in radians.
+      /// \param[out] _sin Sine of _r.
+      /// \param[out] _cos Cosine of _r.
+      inline void fastSinCosReduced(const double _r, double &_sin,
+                                    double &_cos)
+      {
+        const double z = _r * _r;
+        _sin = _r + _r * z * (-1.6666654611e-1 + z * (8.3321608736e-3 +
+                              z * -1.9515295891e-4));
+        _cos = 1.0 - 0.5 * z + z * z * (4.166664568298827e-2 +
+               z * (-1.388731625493765e-3 + z * 2.443315711809948e-5));
+      }
+    }
+
+    /// \brief Approximate sine and cosine of an angle, computed together.
+    /// The absolute error is below 3e-9, and float results are within one
+    /// ULP, for angles up to 1e6 radians in magnitude. Unlike std::sin and
+    /// std::cos, this has no branches or calls, so loops over arrays
+    /// vectorize. Use it where full double precision isn't needed, such as
+    /// for rendering.
+    /// \param[in] _x The angle in radians.
+    /// \param[out] _sin Sine of _x.
+    /// \param[out] _cos Cosine of _x.
+    template<typename T>
+    inline void fastSinCos(const T _x, T &_sin, T &_cos)
+    {
+      // Reduce to [-pi/4, pi/4] with pi/2 split in two parts, the first of
+      // which is exact when multiplied by the quadrant.
+      const double x = static_cast<double>(_x);
+      const double k = std::floor(x * 0.63661977236758134308 + 0.5);
+      const double quadrant = std::abs(k) < 1e15 ? k : 0.0;
+      const double r = (x - quadrant * 1.57079632673412561417) -
+                       quadrant * 6.07710050650619224932e-11;
+      double s;
+      double c;
+      detail::fastSinCosReduced(r, s, c);
+
+      const int64_t q = static_cast<int64_t>(quadrant);
+      const bool swap = (q & 1) != 0;
+      const double sq = swap ? c : s;
+      const double cq = swap ? s : c;
+      _sin = static_cast<T>((q & 2) ? -sq : sq);
+      _cos = static_cast<T>(((q + 1) & 2) ? -cq : cq);
+    }
+
+    /// \brief Approximate sine of an angle, see fastSinCos for the error.
+    /// \param[in] _x The angle in radians.
+    /// \return Sine of _x.
+    template<typename T>
+    inline T fastSin(const T _x)
+    {
+      T s;
+      T c;
+      fastSinCos(_x, s, c);
+      return s;
+    }
+
+    /// \brief Approximate cosine of an angle, see fastSinCos for the error.
+    /// \param[in] _x The angle in radians.
+    /// \return Cosine of _x.
+    template<typename T>
+    inline T fastCos(const T _x)
+    {
+      T s;
+      T c;
+      fastSinCos(_x, s, c);
+      return c;
+    }
+
+    /// \brief Approximate arc tangent of _y / _x, in the quadrant given by
+    /// the signs of _y and _x like std::atan2. The absolute error is below
+    /// 1e-8, and float results are within one ULP, for finite inputs.
+    /// Like fastSinCos, this vectorizes.
+    /// \param[in] _y Y coordinate.
+    /// \param[in] _x X coordinate.
+    /// \return The angle in radians, in [-pi, pi].
+    template<typename T>
+    inline T fastAtan2(const T _y, const T _x)
+    {
+      const double y = static_cast<double>(_y);
+      const double x = static_cast<double>(_x);
+      const double ay = std::abs(y);
+      const double ax = std::abs(x);
+      const double hi = std::max(ax, ay);
+      const double lo = std::min(ax, ay);
+
+      // Arc tangent of a ratio in [0, 1], reduced to [-tan(pi/8),
+      // tan(pi/8)] for the polynomial of the Cephes library.
+      const double a = hi > 0 ? lo / hi : 0.0;
+      const bool upper = a > 0.41421356237309504880;
+      const double b = upper ? (a - 1.0) / (a + 1.0) : a;
+      const double z = b * b;
+      double r = (((8.05374449538e-2 * z - 1.38776856032e-1) * z +
+                   1.99777106478e-1) * z - 3.33329491539e-1) * z * b + b;
+      r = upper ? r + 0.78539816339744830962 : r;
+
+      r = ay > ax ? 1.57079632679489661923 - r : r;
+      r = std::signbit(x) ? 3.14159265358979323846 - r : r;
+      r = std::copysign(r, y);
+
+      // std::min and std::max drop NaN inputs
+      return static_cast<T>(std::isnan(x) || std::isnan(y) ? x + y : r);
+    }
+
+    /// \brief Approximate arc sine, with the error of fastAtan2.
+    /// \param[in] _x Sine, in [-1, 1].
+    /// \return The angle in radians, in [-pi/2, pi/2], or NaN if _x is out
+    /// of range.
+    template<typename T>
+    inline T fastAsin(const T _x)
+    {
+      const double x = static_cast<double>(_x);
+      return static_cast<T>(fastAtan2(x, std::sqrt((1.0 - x) * (1.0 + x))));
+    }
+
+    /// \brief Approximate arc cosine, with the error of fastAtan2.
+    /// \param[in] _x Cosine, in [-1, 1].
+    /// \return The angle in radians, in [0, pi], or NaN if _x is out of
+    /// range.
+    template<typename T>
+    inline T fastAcos(const T _x)
+    {
+      const double x = static_cast<double>(_x);
+      return static_cast<T>(fastAtan2(std::sqrt((1.0 - x) * (1.0 + x)), x));
+    }
+
+    /// \brief Approximate exponential. The relative error is below 2e-9,
+    /// and float results are within one ULP. Results which would be
+    /// denormal are flushed to zero. Like fastSinCos, this vectorizes.
+    /// \param[in] _x The exponent.
+    /// \return e raised to the power _x.
+    template<typename T>
+    inline T fastExp(const T _x)
+    {
+      // exp(x) = 2^k exp(r), with r in [-ln(2)/2, ln(2)/2] and ln(2) split
+      // in two parts.
+      const double x = static_cast<double>(_x);
+      double xc = x > 709.0 ? 709.0 : (x < -708.0 ? -708.0 : x);
+      xc = std::isnan(xc) ? 0.0 : xc;
+      const double k = std::floor(xc * 1.44269504088896340736 + 0.5);
+      const double r = (xc - k * 6.93147180369123816490e-1) -
+                       k * 1.90821492927058770002e-10;
+      const double p = 1.0 + r + r * r * (5.0000001201e-1 +
+          r * (1.6666665459e-1 + r * (4.1665795894e-2 +
+          r * (8.3334519073e-3 + r * (1.3981999507e-3 +
+          r * 1.9875691500e-4)))));
+
+      const int64_t bits = (static_cast<int64_t>(k) + 1023) << 52;
+      double scale;
+      std::memcpy(&scale, &bits, sizeof(scale));
+      double result = p * scale;
+      result = x > 709.782712893384 ?
+          std::numeric_limits<double>::infinity() : result;
+      result = x < -708.396418532264 ? 0.0 : result;
+      return static_cast<T>(std::isnan(x) ? x : result);
+    }
+
+    /// \brief Precision policy of the batch functions, such as
+    /// QuaternionSoA::Slerp, which selects the standard library functions.
+    /// This is the default.
+    struct FullPrecision
+    {
+      /// \brief Sine and cosine.
+      /// \param[in] _x The angle in radians.
+      /// \param[out] _sin Sine of _x.
+      /// \param[out] _cos Cosine of _x.
+      template<typename T>
+      static void SinCos(const T _x, T &_sin, T &_cos)
+      {
+        _sin = std::sin(_x);
+        _cos = std::cos(_x);
+      }
+
+      /// \brief Sine.
+      /// \param[in] _x The angle in radians.
+      /// \return Sine of _x.
+      template<typename T>
+      static T Sin(const T _x)
+      {
+        return std::sin(_x);
+      }
+
+      /// \brief Arc tangent of _y / _x.
+      /// \param[in] _y Y coordinate.
+      /// \param[in] _x X coordinate.
+      /// \return The angle in radians.
+      template<typename T>
+      static T Atan2(const T _y, const T _x)
+      {
+        return std::atan2(_y, _x);
+      }
+
+      /// \brief Arc sine.
+      /// \param[in] _x Sine.
+      /// \return The angle in radians.
+      template<typename T>
+      static T Asin(const T _x)
+      {
+        return std::asin(_x);
+      }
+
+      /// \brief Arc cosine.
+      /// \param[in] _x Cosine.
+      /// \return The angle in radians.
+      template<typename T>
+      static T Acos(const T _x)
+      {
+        return std::acos(_x);
+      }
+
+      /// \brief Exponential.
+      /// \param[in] _x The exponent.
+      /// \return e raised to the power _x.
+      template<typename T>
+      static T Exp(const T _x)
+      {
+        return std::exp(_x);
+      }
+    };
+
+    /// \brief Precision policy of the batch functions which selects the
+    /// approximations fastSinCos, fastAtan2, fastAsin, fastAcos and fastExp,
+    /// for paths such as rendering which don't need full double precision.
+    struct FastPrecision
+    {
+      /// \brief Sine and cosine.
+      /// \param[in] _x The angle in radians.
+      /// \param[out] _sin Sine of _x.
+      /// \param[out] _cos Cosine of _x.
+      template<typename T>
+      static void SinCos(const T _x, T &_sin, T &_cos)
+      {
+        fastSinCos(_x, _sin, _cos);
+      }
+
+      /// \brief Sine.
+      /// \param[in] _x The angle in radians.
+      /// \return Sine of _x.
+      template<typename T>
+      static T Sin(const T _x)
+      {
+        return fastSin(_x);
+      }
+
+      /// \brief Arc tangent of _y / _x.
+      /// \param[in] _y Y coordinate.
+      /// \param[in] _x X coordinate.
+      /// \return The angle in radians.
+      template<typename T>
+      static T Atan2(const T _y, const T _x)
+      {
+        return fastAtan2(_y, _x);
+      }
+
+      /// \brief Arc sine.
+      /// \param[in] _x Sine.
+      /// \return The angle in radians.
+      template<typename T>
+      static T Asin(const T _x)
+      {
+        return fastAsin(_x);
+      }
+
+      /// \brief Arc cosine.
+      /// \param[in] _x Cosine.
+      /// \return The angle in radians.
+      template<typename T>
+      static T Acos(const T _x)
+      {
+        return fastAcos(_x);
+      }
+
+      /// \brief Exponential.
+      /// \param[in] _x The exponent.
+      /// \return e raised to the power _x.
+      template<typename T>
+      static T Exp(const T _x)
+      {
+        return fastExp(_x);
+      }
+    };
+
+    namespace detail
+    {
+      /// \brief Check if a character is white space, as std::isspace does
+      /// in the "C" locale.
+      /// \param[in] _c Character to check.
+      /// \return True if _c is white space.
+      constexpr bool isSpace(const char _c)
+      {
+        return _c == ' ' || (_c >= '\t' && _c <= '\r');
+      }
+
+      /// \brief Check if a text is empty or only white space.
+      /// \param[in] _text Text to check.
+      /// \return True if _text has no other character than white space.
+      constexpr bool isSpace(const std::string_view _text)
+      {
+        for (const char c : _text)
+        {
+          if (!isSpace(c))
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Parse a number at the start of a character range, as
+      /// std::from_chars does, but also accepting a leading '+' and, for
+      /// floating point numbers, a "0x" prefixed hexadecimal value, like
+      /// std::strtod in the "C" locale.
+      /// \param[in] _first Start of the range.
+      /// \param[in] _last End of the range.
+      /// \param[out] _value Parsed value, unchanged on failure.
+      /// \return Pointer past the number, or nullptr if the range does not
+      /// start with a number or the number is out of range.
+      template<typename T>
+      const char *fromChars(const char *_first, const char *_last,
+                            T &_value)
+      {
+        const char *p = _first;
+        bool negative = false;
+        if (p != _last && (*p == '+' || *p == '-'))
+        {
+          negative = *p == '-';
+          ++p;
+        }
+        // std::from_chars accepts a '-' but not a '+', and only after the
+        // sign has been consumed can both be handled the same way.
+        if (p == _last || *p == '+' || *p == '-')
+          return nullptr;
+
+        T value{};
+        std::from_chars_result result{nullptr, std::errc::invalid_argument};
+        if constexpr (std::is_floating_point_v<T>)
+        {
+          if (_last - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+          {
+#if defined(__cpp_lib_to_chars)
+            result = std::from_chars(p + 2, _last, value,
+                                     std::chars_format::hex);
+#endif
+            // "0x" with no hexadecimal digits is the number 0.
+            if (result.ec == std::errc::invalid_argument)
+              result = {p + 1, std::errc()};
+          }
+          else
+          {
+#if defined(__cpp_lib_to_chars)
+            result = std::from_chars(p, _last, value);
+#else
+            // Standard libraries without floating point std::from_chars
+            // use a stream in the "C" locale.
+            std::istringstream stream(std::string(p, _last));
+            stream.imbue(std::locale::classic());
+            if (stream >> value)
+            {
+              const auto pos = stream.tellg();
+              result = {pos < 0 ? _last : p + pos, std::errc()};
+            }
+#endif
+          }
+        }
+        else
+        {
+          if (negative)
+            --p;
+          result = std::from_chars(p, _last, value);
+          negative = false;
+        }
+
+        if (result.ec != std::errc())
+          return nullptr;
+        _value = negative ? -value : value;
+        return result.ptr;
+      }
+    }
+
     /// \brief parse string into an integer
     /// \param[in] _input the string
     /// \return an integer, 0 or 0 and a message in the error stream
-    inline int parseInt(const std::string &_input)
+    inline int parseInt(std::string_view _input)
     {
       // Return NAN_I if it is empty
       if (_input.empty())
@@ -709,28 +1095,28 @@ namespace ignition
         return NAN_I;
       }
       // Return 0 if it is all spaces
-      else if (_input.find_first_not_of(' ') == std::string::npos)
+      else if (_input.find_first_not_of(' ') == std::string_view::npos)
       {
         return 0;
       }
 
-      // Otherwise try standard library
-      try
-      {
-        return std::stoi(_input);
-      }
+      // Otherwise parse the leading integer, after any white space.
+      const char *first = _input.data();
+      const char *last = first + _input.size();
+      while (first != last && detail::isSpace(*first))
+        ++first;
+      int value = NAN_I;
       // if that fails, return NAN_I
-      catch(...)
-      {
+      if (!detail::fromChars(first, last, value))
         return NAN_I;
-      }
+      return value;
     }
 
     /// \brief parse string into float
     /// \param _input the string
     /// \return a floating point number (can be NaN) or 0 with a message in the
     /// error stream
-    inline double parseFloat(const std::string &_input)
+    inline double parseFloat(std::string_view _input)
     {
       // Return NAN_D if it is empty
       if (_input.empty())
@@ -738,21 +1124,148 @@ namespace ignition
         return NAN_D;
       }
       // Return 0 if it is all spaces
-      else if (_input.find_first_not_of(' ') == std::string::npos)
+      else if (_input.find_first_not_of(' ') == std::string_view::npos)
       {
         return 0;
       }
 
-      // Otherwise try standard library
-      try
+      // Otherwise parse the leading number, after any white space.
+      const char *first = _input.data();
+      const char *last = first + _input.size();
+      while (first != last && detail::isSpace(*first))
+        ++first;
+      double value = NAN_D;
+      // if that fails, return NAN_D. Denormal values are out of range for
+      // std::stod, which this used before, so they also give NAN_D.
+      if (!detail::fromChars(first, last, value) ||
+          std::fpclassify(value) == FP_SUBNORMAL)
       {
-        return std::stod(_input);
+        return NAN_D;
       }
-      // if that fails, return NAN_D
-      catch(...)
+      return value;
+    }
+
+    /// \brief Parse the next number of a white space separated list, such
+    /// as the "1 0.5 -2e3" text of a vector. Leading white space is
+    /// skipped, and the number must be followed by white space or by the
+    /// end of the text.
+    ///
+    /// Unlike parseInt and parseFloat, this does not allocate, does not
+    /// depend on the locale, and reports errors instead of returning a
+    /// sentinel value.
+    /// \param[in,out] _input Text to parse. On success it is advanced past
+    /// the number.
+    /// \param[out] _value Parsed number. It is unchanged on failure.
+    /// \return True if a number was parsed, false at the end of the text,
+    /// if the next token is not a number, or if it is out of range for T.
+    template<typename T>
+    inline bool parseNext(std::string_view &_input, T &_value)
+    {
+      static_assert(std::is_arithmetic_v<T>, "T must be a number type");
+      const char *first = _input.data();
+      const char *last = first + _input.size();
+      while (first != last && detail::isSpace(*first))
+        ++first;
+
+      T value;
+      const char *end = detail::fromChars(first, last, value);
+      if (!end || (end != last && !detail::isSpace(*end)))
+        return false;
+      _value = value;
+      _input.remove_prefix(static_cast<std::size_t>(end - _input.data()));
+      return true;
+    }
+
+    /// \brief Parse a white space separated list of numbers, with
+    /// parseNext.
+    /// \param[in] _input Text to parse.
+    /// \param[out] _values The numbers are appended to it. It is unchanged
+    /// on failure.
+    /// \return True if the whole text is a list of numbers, which may be
+    /// empty.
+    template<typename T>
+    inline bool parseNumbers(std::string_view _input, std::vector<T> &_values)
+    {
+      const std::size_t size = _values.size();
+      T value;
+      while (parseNext(_input, value))
+        _values.push_back(value);
+
+      if (!detail::isSpace(_input))
       {
-        return NAN_D;
+        _values.resize(size);
+        return false;
+      }
+      return true;
+    }
+
+    /// \brief Write a number into a character buffer with std::to_chars.
+    /// Floating point numbers are written in the shortest form that parses
+    /// back to the same value with parseNext or parseFloat, except that
+    /// negative zero is written as "0", as appendToStream does. The output
+    /// does not depend on the locale and nothing is allocated.
+    /// \param[in] _first Start of the buffer.
+    /// \param[in] _last End of the buffer.
+    /// \param[in] _value Number to write.
+    /// \return Pointer past the last character written, or nullptr if the
+    /// buffer is too small, in which case its content is unspecified. The
+    /// output is not null terminated.
+    template<typename T>
+    inline char *formatNumber(char *_first, char *_last, const T _value)
+    {
+      static_assert(std::is_arithmetic_v<T>, "T must be a number type");
+      std::to_chars_result result{nullptr, std::errc::value_too_large};
+      if constexpr (std::is_floating_point_v<T>)
+      {
+        // Adding zero turns negative zero into zero
+        const T value = _value + T(0);
+#if defined(__cpp_lib_to_chars)
+        result = std::to_chars(_first, _last, value);
+#else
+        // Standard libraries without floating point std::to_chars use a
+        // stream in the "C" locale, with enough digits to round trip.
+        std::ostringstream stream;
+        stream.imbue(std::locale::classic());
+        stream << std::setprecision(std::numeric_limits<T>::max_digits10)
+               << value;
+        const std::string text = stream.str();
+        if (text.size() <= static_cast<std::size_t>(_last - _first))
+          result = {std::copy(text.begin(), text.end(), _first), std::errc()};
+#endif
+      }
+      else
+      {
+        result = std::to_chars(_first, _last, _value);
+      }
+      return result.ec == std::errc() ? result.ptr : nullptr;
+    }
+
+    /// \brief Write white space separated numbers into a character buffer,
+    /// with formatNumber.
+    /// \param[in] _first Start of the buffer.
+    /// \param[in] _last End of the buffer.
+    /// \param[in] _values Numbers to write.
+    /// \param[in] _count Number of values.
+    /// \return Pointer past the last character written, or nullptr if the
+    /// buffer is too small.
+    template<typename T>
+    inline char *formatNumbers(char *_first, char *_last, const T *_values,
+                               const std::size_t _count)
+    {
+      char *p = _first;
+      for (std::size_t i = 0; i < _count; ++i)
+      {
+        if (i > 0)
+        {
+          if (p == _last)
+            return nullptr;
+          *p++ = ' ';
+        }
+        p = formatNumber(p, _last, _values[i]);
+        if (!p)
+          return nullptr;
       }
+      return p;
     }
 
     /// \brief Convert a std::chrono::steady_clock::time_point to a seconds and
@@ -1142,6 +1655,79 @@ namespace ignition
     using PairOutput = uint64_t;
 #endif
 
+// Detect whether constexpr functions can tell constant evaluation apart
+// from run time evaluation, to use faster code at run time.
+#if defined(__has_builtin)
+  #if __has_builtin(__builtin_is_constant_evaluated)
+    #define IGNITION_MATH_HAS_IS_CONSTANT_EVALUATED 1
+  #endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+  #define IGNITION_MATH_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+
+    namespace detail
+    {
+      /// \brief Integer square root computed one bit at a time, usable in
+      /// constant expressions.
+      /// \param[in] _x Value.
+      /// \return The largest integer whose square is not greater than _x.
+      constexpr uint64_t isqrtBits(const uint64_t _x)
+      {
+        uint64_t rem = _x;
+        uint64_t root = 0;
+        uint64_t bit = uint64_t(1) << 62;
+        while (bit > _x)
+          bit >>= 2;
+        while (bit != 0)
+        {
+          if (rem >= root + bit)
+          {
+            rem -= root + bit;
+            root = (root >> 1) + bit;
+          }
+          else
+          {
+            root >>= 1;
+          }
+          bit >>= 2;
+        }
+        return root;
+      }
+
+      /// \brief Integer square root computed from the double precision
+      /// square root. The rounding of _x and of the square root make the
+      /// estimate wrong by at most one, which is then corrected, so the
+      /// result is exact for every 64 bit value.
+      /// \param[in] _x Value.
+      /// \return The largest integer whose square is not greater than _x.
+      inline uint64_t isqrtDouble(const uint64_t _x)
+      {
+        const uint64_t maxRoot = 0xffffffffu;
+        uint64_t r = static_cast<uint64_t>(
+            std::sqrt(static_cast<double>(_x)));
+        r = r > maxRoot ? maxRoot : r;
+        if (r * r > _x)
+          --r;
+        else if (r < maxRoot && (r + 1) * (r + 1) <= _x)
+          ++r;
+        return r;
+      }
+
+      /// \brief Integer square root, exact for every 64 bit value. It uses
+      /// isqrtDouble at run time when the compiler can tell constant
+      /// evaluation apart, and isqrtBits otherwise.
+      /// \param[in] _x Value.
+      /// \return The largest integer whose square is not greater than _x.
+      constexpr uint64_t isqrt(const uint64_t _x)
+      {
+#ifdef IGNITION_MATH_HAS_IS_CONSTANT_EVALUATED
+        if (!__builtin_is_constant_evaluated())
+          return isqrtDouble(_x);
+#endif
+        return isqrtBits(_x);
+      }
+    }
+
     /// \brief A pairing function that maps two values to a unique third
     /// value. This is an implement of Szudzik's function.
     /// \param[in] _a First value, must be a non-negative integer. On
@@ -1151,6 +1737,7 @@ namespace ignition
     /// \return A unique non-negative integer value. On Windows the return
     /// value is uint32_t. On Linux/OSX the return value is uint64_t
     /// \sa Unpair
+    /// \sa Pair64
     PairOutput IGNITION_MATH_VISIBLE Pair(
         const PairInput _a, const PairInput _b);
 
@@ -1165,8 +1752,60 @@ namespace ignition
     /// tuple contains two uint16_t values. On Linux/OSX the tuple contains
     /// two uint32_t values.
     /// \sa Pair
+    /// \sa Unpair64
     std::tuple<PairInput, PairInput> IGNITION_MATH_VISIBLE Unpair(
         const PairOutput _key);
+
+    /// \brief Szudzik's pairing function, as Pair, with 32 bit values and
+    /// 64 bit keys on every platform. It can be used in constant
+    /// expressions.
+    /// \param[in] _a First value.
+    /// \param[in] _b Second value.
+    /// \return A unique key.
+    /// \sa Unpair64
+    constexpr uint64_t Pair64(const uint32_t _a, const uint32_t _b)
+    {
+      // Store in 64bit local variable so that we don't overflow.
+      const uint64_t a = _a;
+      const uint64_t b = _b;
+
+      // Szudzik's function
+      return _a >= _b ? a * a + a + b : a + b * b;
+    }
+
+    /// \brief The reverse of Pair64. The square root is computed with
+    /// integers, so every 64 bit key is inverted exactly. It can be used
+    /// in constant expressions.
+    /// \param[in] _key A key generated from the Pair64 function.
+    /// \return A tuple with the two values that generate _key.
+    /// \sa Pair64
+    constexpr std::tuple<uint32_t, uint32_t> Unpair64(const uint64_t _key)
+    {
+      const uint64_t root = detail::isqrt(_key);
+      const uint64_t rem = _key - root * root;
+
+      return rem >= root ?
+        std::make_tuple(static_cast<uint32_t>(root),
+                        static_cast<uint32_t>(rem - root)) :
+        std::make_tuple(static_cast<uint32_t>(rem),
+                        static_cast<uint32_t>(root));
+    }
+
+    /// \brief Pair arrays of values, as Pair64 does for one pair.
+    /// \param[in] _a First values.
+    /// \param[in] _b Second values.
+    /// \param[in] _count Number of pairs.
+    /// \param[out] _keys Keys, _count of them.
+    void IGNITION_MATH_VISIBLE Pair64(const uint32_t *_a,
+        const uint32_t *_b, const std::size_t _count, uint64_t *_keys);
+
+    /// \brief Unpair an array of keys, as Unpair64 does for one key.
+    /// \param[in] _keys Keys generated from the Pair64 function.
+    /// \param[in] _count Number of keys.
+    /// \param[out] _a First values, _count of them.
+    /// \param[out] _b Second values, _count of them.
+    void IGNITION_MATH_VISIBLE Unpair64(const uint64_t *_keys,
+        const std::size_t _count, uint32_t *_a, uint32_t *_b);
     }
   }
 }
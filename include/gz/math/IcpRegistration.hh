@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_ICPREGISTRATION_HH_
+#define GZ_MATH_ICPREGISTRATION_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gz/math/Executor.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/Vector3SoA.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  //
+  // Forward declare private data
+  class IcpRegistrationPrivate;
+
+  /// \class IcpRegistration IcpRegistration.hh
+  /// ignition/math/IcpRegistration.hh
+  /// \brief Iterative closest point registration, which finds the pose
+  /// that aligns a source set of points, such as a new scan, with a target
+  /// set of points, such as a map or a previous scan.
+  ///
+  /// Each iteration transforms the source points by the current pose,
+  /// matches each of them with its nearest target point in a KdTree3, and
+  /// updates the pose from the matches. The point-to-point metric
+  /// minimizes the squared distances between matched points in closed
+  /// form, with the SVD of their cross-covariance (Kabsch). The
+  /// point-to-plane metric minimizes the squared distances from the
+  /// source points to the tangent planes of their matches, and usually
+  /// converges in fewer iterations on smooth surfaces. It uses the normals
+  /// given with the target, or estimates them from the neighbors of each
+  /// target point.
+  ///
+  /// Matching runs on several threads, each on a contiguous block of
+  /// source points. Partial sums are combined in block order, so results
+  /// only depend on the number of blocks.
+  ///
+  /// # Example usage
+  ///
+  /// ```{.cpp}
+  /// gz::math::IcpRegistration icp(mapPoints);
+  /// icp.SetMetric(gz::math::IcpRegistration::POINT_TO_PLANE);
+  /// icp.SetMaxCorrespondenceDistance(0.5);
+  /// auto result = icp.Align(scan, odometryPose);
+  /// if (result.converged)
+  ///   robotPose = result.pose;
+  /// ```
+  class IGNITION_MATH_VISIBLE IcpRegistration
+  {
+    /// \enum Metric
+    /// \brief Error minimized by each iteration.
+    public: enum Metric
+            {
+              /// \brief Squared distance between matched points. This is
+              /// the default.
+              POINT_TO_POINT = 0,
+
+              /// \brief Squared distance from each source point to the
+              /// tangent plane of its match.
+              POINT_TO_PLANE = 1
+            };
+
+    /// \brief Outcome of a registration.
+    public: struct Result
+            {
+              /// \brief Pose that maps the source points onto the target.
+              Pose3d pose;
+
+              /// \brief Number of iterations, each of which updated the
+              /// pose once.
+              unsigned int iterations = 0;
+
+              /// \brief True if the last update of the pose was within the
+              /// tolerances.
+              bool converged = false;
+
+              /// \brief Number of source points that were matched with a
+              /// target point, at the returned pose.
+              std::size_t inliers = 0;
+
+              /// \brief Root mean square distance between matched points,
+              /// at the returned pose. Zero when there are no inliers.
+              double rmsError = 0;
+            };
+
+    /// \brief Constructor. The target is empty.
+    public: IcpRegistration();
+
+    /// \brief Constructor.
+    /// \param[in] _target Target points, see SetTarget().
+    public: explicit IcpRegistration(const std::vector<Vector3d> &_target);
+
+    /// \brief Copy constructor.
+    /// \param[in] _other Registration to copy.
+    public: IcpRegistration(const IcpRegistration &_other);
+
+    /// \brief Destructor.
+    public: ~IcpRegistration();
+
+    /// \brief Assignment operator.
+    /// \param[in] _other Registration to copy.
+    /// \return Reference to this object.
+    public: IcpRegistration &operator=(const IcpRegistration &_other);
+
+    /// \brief Set the target points and build their kd-tree. Points that
+    /// are not finite are never matched. The normals used by the
+    /// point-to-plane metric are estimated by the first registration that
+    /// needs them.
+    /// \param[in] _target Target points.
+    public: void SetTarget(const std::vector<Vector3d> &_target);
+
+    /// \brief Set the target points and their normals.
+    /// \param[in] _target Target points.
+    /// \param[in] _normals Unit normal of each target point. Points with a
+    /// zero normal are not matched by the point-to-plane metric.
+    /// \return False if there is not one normal per point; the normals
+    /// are then estimated.
+    public: bool SetTarget(const std::vector<Vector3d> &_target,
+                           const std::vector<Vector3d> &_normals);
+
+    /// \brief Get the target points.
+    /// \return The points passed to SetTarget().
+    public: const std::vector<Vector3d> &Target() const;
+
+    /// \brief Get the normals of the target points, estimating them if
+    /// needed. A normal is estimated as the direction of least variance of
+    /// the nearest neighbors of a point, and is zero if they are collinear
+    /// or fewer than 3.
+    /// \return One unit or zero normal per target point.
+    public: const std::vector<Vector3d> &TargetNormals();
+
+    /// \brief Set the error minimized by each iteration.
+    /// \param[in] _metric The metric.
+    public: void SetMetric(const Metric _metric);
+
+    /// \brief Get the error minimized by each iteration.
+    /// \return The metric. The default is POINT_TO_POINT.
+    public: Metric GetMetric() const;
+
+    /// \brief Set the maximum number of iterations of a registration.
+    /// \param[in] _iterations Number of iterations.
+    public: void SetMaxIterations(const unsigned int _iterations);
+
+    /// \brief Get the maximum number of iterations of a registration.
+    /// \return Number of iterations. The default is 30.
+    public: unsigned int MaxIterations() const;
+
+    /// \brief Set the maximum distance between matched points. Source
+    /// points farther from every target point are ignored, which rejects
+    /// the parts of a scan that the target does not cover.
+    /// \param[in] _distance Maximum distance, inclusive.
+    public: void SetMaxCorrespondenceDistance(const double _distance);
+
+    /// \brief Get the maximum distance between matched points.
+    /// \return Maximum distance. The default is infinity.
+    public: double MaxCorrespondenceDistance() const;
+
+    /// \brief Set the tolerances of convergence. A registration stops
+    /// once an update of the pose translates by no more than
+    /// _translation and rotates by no more than _rotation.
+    /// \param[in] _translation Tolerance on the translation.
+    /// \param[in] _rotation Tolerance on the rotation angle, in radians.
+    public: void SetTolerance(const double _translation,
+                              const double _rotation);
+
+    /// \brief Get the tolerance on the translation of an update.
+    /// \return The tolerance. The default is 1e-6.
+    public: double TranslationTolerance() const;
+
+    /// \brief Get the tolerance on the rotation angle of an update.
+    /// \return The tolerance, in radians. The default is 1e-6.
+    public: double RotationTolerance() const;
+
+    /// \brief Set the number of nearest neighbors used to estimate each
+    /// target normal. It resets the estimated normals.
+    /// \param[in] _neighbors Number of neighbors, including the point.
+    public: void SetNormalNeighbors(const std::size_t _neighbors);
+
+    /// \brief Get the number of nearest neighbors used to estimate each
+    /// target normal.
+    /// \return Number of neighbors. The default is 10.
+    public: std::size_t NormalNeighbors() const;
+
+    /// \brief Set the number of threads used to match points and to
+    /// estimate normals.
+    /// \param[in] _threads Number of threads. A value of 0 uses the
+    /// number of hardware threads.
+    public: void SetThreadCount(const unsigned int _threads);
+
+    /// \brief Get the number of threads used to match points.
+    /// \return Number of threads. The default is 1.
+    public: unsigned int ThreadCount() const;
+
+    /// \brief Set the executor used instead of threads of its own, such
+    /// as a ThreadPool shared with other batch operations. When set, the
+    /// thread count is ignored and the points are split into
+    /// Executor::BlockCount blocks.
+    /// \param[in] _executor The executor, or nullptr to use the thread
+    /// count again.
+    public: void SetExecutor(std::shared_ptr<Executor> _executor);
+
+    /// \brief Find the pose that aligns source points with the target.
+    /// \param[in] _source Source points, in their own frame.
+    /// \param[in] _initial Initial guess of the pose, such as the pose
+    /// predicted by odometry. ICP converges to the nearest local minimum,
+    /// so the guess must be close enough.
+    /// \return The pose and its convergence statistics. The pose is
+    /// _initial if fewer than 3 source points, or 6 with the
+    /// point-to-plane metric, are matched, or if they don't constrain the
+    /// pose, such as when they are collinear.
+    public: Result Align(const Vector3SoAd &_source,
+                         const Pose3d &_initial = Pose3d::Zero);
+
+    /// \brief Find the pose that aligns source points with the target.
+    /// \param[in] _source Source points, in their own frame.
+    /// \param[in] _initial Initial guess of the pose.
+    /// \return The pose and its convergence statistics.
+    /// \sa Align(const Vector3SoAd &, const Pose3d &)
+    public: Result Align(const std::vector<Vector3d> &_source,
+                         const Pose3d &_initial = Pose3d::Zero);
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<IcpRegistrationPrivate> dataPtr;
+  };
+}
+}
+}
+#endif
@@ -17,6 +17,7 @@
 #ifndef GZ_MATH_INERTIAL_HH_
 #define GZ_MATH_INERTIAL_HH_
 
+#include <vector>
 #include <gz/math/config.hh>
 #include "gz/math/MassMatrix3.hh"
 #include "gz/math/Pose3.hh"
@@ -159,9 +160,10 @@ namespace ignition
       public: bool SetMassMatrixRotation(const Quaternion<T> &_q,
                                          const T _tol = 1e-6)
       {
-        this->pose.Rot() *= this->MassMatrix().PrincipalAxesOffset(_tol) *
-                            _q.Inverse();
-        const auto moments = this->MassMatrix().PrincipalMoments(_tol);
+        Vector3<T> moments;
+        Quaternion<T> offset;
+        this->MassMatrix().PrincipalAxes(moments, offset, _tol);
+        this->pose.Rot() *= offset * _q.Inverse();
         const auto diag = Matrix3<T>(
             moments[0], 0, 0,
             0, moments[1], 0,
@@ -267,6 +269,82 @@ namespace ignition
         return Inertial<T>(*this) += _inertial;
       }
 
+      /// \brief Sum a range of inertial properties expressed in the same
+      /// frame F. This is equivalent to adding them one by one with
+      /// operator+=, starting from the first one, but the mass, first and
+      /// second moments of all the bodies are accumulated about a common
+      /// point and converted to the center of mass only once. This avoids
+      /// the intermediate sums and the repeated rotations of operator+=,
+      /// which matters when merging many bodies.
+      /// \param[in] _first Iterator to the first inertial.
+      /// \param[in] _last Iterator past the last inertial.
+      /// \return Sum of the inertials, with the inertial frame aligned with
+      /// frame F. If the total mass is not positive, the first inertial is
+      /// returned, and if the range is empty a default Inertial.
+      public: template<typename Iterator>
+      static Inertial<T> Sum(Iterator _first, Iterator _last)
+      {
+        if (_first == _last)
+          return Inertial<T>();
+
+        // Moments are accumulated about the center of mass of the first
+        // body rather than the origin of F, which keeps the shift to the
+        // final center of mass accurate for bodies far from the origin.
+        const Vector3<T> origin = _first->Pose().Pos();
+        T mass = 0;
+        Vector3<T> moment;
+        Matrix3<T> moi = Matrix3<T>::Zero;
+        T sxx = 0, syy = 0, szz = 0, sxy = 0, sxz = 0, syz = 0;
+        for (Iterator iter = _first; iter != _last; ++iter)
+        {
+          const T m = iter->MassMatrix().Mass();
+          const Vector3<T> d = iter->Pose().Pos() - origin;
+          const Vector3<T> md = m * d;
+          mass += m;
+          moment += md;
+          moi = moi + iter->Moi();
+          sxx += md.X() * d.X();
+          syy += md.Y() * d.Y();
+          szz += md.Z() * d.Z();
+          sxy += md.X() * d.Y();
+          sxz += md.X() * d.Z();
+          syz += md.Y() * d.Z();
+        }
+
+        // Only continue if total mass is positive
+        if (mass <= 0)
+          return *_first;
+
+        // Second moments about the center of mass, then the parallel axis
+        // theorem for all the bodies at once
+        const Vector3<T> com = moment / mass;
+        const Vector3<T> mcom = mass * com;
+        sxx -= mcom.X() * com.X();
+        syy -= mcom.Y() * com.Y();
+        szz -= mcom.Z() * com.Z();
+        sxy -= mcom.X() * com.Y();
+        sxz -= mcom.X() * com.Z();
+        syz -= mcom.Y() * com.Z();
+
+        const Vector3<T> ixxyyzz(moi(0, 0) + syy + szz,
+                                 moi(1, 1) + szz + sxx,
+                                 moi(2, 2) + sxx + syy);
+        const Vector3<T> ixyxzyz(moi(0, 1) - sxy,
+                                 moi(0, 2) - sxz,
+                                 moi(1, 2) - syz);
+        return Inertial<T>(MassMatrix3<T>(mass, ixxyyzz, ixyxzyz),
+                           Pose3<T>(origin + com, Quaternion<T>::Identity));
+      }
+
+      /// \brief Sum inertial properties expressed in the same frame F.
+      /// \sa Sum(Iterator, Iterator)
+      /// \param[in] _inertials Inertials to add.
+      /// \return Sum of the inertials.
+      public: static Inertial<T> Sum(const std::vector<Inertial<T>> &_inertials)
+      {
+        return Sum(_inertials.begin(), _inertials.end());
+      }
+
       /// \brief Mass and inertia matrix of the object expressed in the
       /// center of mass reference frame.
       private: MassMatrix3<T> massMatrix;
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_INSTRUMENTATION_HH_
+#define GZ_MATH_INSTRUMENTATION_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \enum InstrumentedSubsystem
+    /// \brief Parts of the library whose hidden heap allocations and deep
+    /// copies are counted in instrumented builds.
+    enum class InstrumentedSubsystem
+    {
+      /// \brief Maps of references returned by graph::Graph, such as
+      /// Vertices() and AdjacentsFrom().
+      GRAPH = 0,
+
+      /// \brief IntersectionPoints sets returned by Box.
+      INTERSECTIONS = 1,
+
+      /// \brief Copies of the private data of classes such as
+      /// AxisAlignedBox, Frustum, SemanticVersion and Spline.
+      PIMPL = 2,
+
+      /// \brief Copies of the observations and results of Kmeans.
+      KMEANS = 3
+    };
+
+    /// \brief Number of InstrumentedSubsystem values.
+    static constexpr std::size_t kInstrumentedSubsystemCount = 4;
+
+    /// \brief Counters of a subsystem, accumulated since the start of the
+    /// process or the last ResetInstrumentationCounters(). Sizes are those
+    /// of the allocated or copied elements, without the overhead of the
+    /// allocator or the memory owned by the elements.
+    struct InstrumentationCounters
+    {
+      /// \brief Number of heap allocations.
+      uint64_t allocations = 0;
+
+      /// \brief Bytes allocated.
+      uint64_t allocatedBytes = 0;
+
+      /// \brief Number of deep copies.
+      uint64_t copies = 0;
+
+      /// \brief Bytes copied.
+      uint64_t copiedBytes = 0;
+    };
+
+    /// \brief Check whether the library counts its allocations and
+    /// copies. It does when it is configured with the CMake option
+    /// IGNITION_MATH_INSTRUMENTATION, which is on by default in Debug
+    /// builds. The counters are otherwise always zero, and the counting
+    /// is compiled out.
+    /// \return True if the counters are updated.
+    bool IGNITION_MATH_VISIBLE InstrumentationEnabled();
+
+    /// \brief Get the counters of a subsystem. They are updated by all
+    /// threads, so the difference of two readings only covers a single
+    /// operation if no other thread uses the subsystem meanwhile.
+    /// \param[in] _subsystem The subsystem.
+    /// \return The counters.
+    InstrumentationCounters IGNITION_MATH_VISIBLE
+    SubsystemCounters(const InstrumentedSubsystem _subsystem);
+
+    /// \brief Get the sum of the counters of all subsystems.
+    /// \return The counters.
+    InstrumentationCounters IGNITION_MATH_VISIBLE TotalCounters();
+
+    /// \brief Set the counters of all subsystems to zero.
+    void IGNITION_MATH_VISIBLE ResetInstrumentationCounters();
+
+    /// \brief Get the name of a subsystem, such as "graph".
+    /// \param[in] _subsystem The subsystem.
+    /// \return The name.
+    const char IGNITION_MATH_VISIBLE *InstrumentedSubsystemName(
+        const InstrumentedSubsystem _subsystem);
+
+    /// \brief Count heap allocations. This is used by
+    /// IGN_MATH_COUNT_ALLOCATIONS.
+    /// \param[in] _subsystem Subsystem which allocated.
+    /// \param[in] _count Number of allocations.
+    /// \param[in] _bytes Bytes allocated.
+    void IGNITION_MATH_VISIBLE CountAllocations(
+        const InstrumentedSubsystem _subsystem, const uint64_t _count,
+        const uint64_t _bytes);
+
+    /// \brief Count a deep copy. This is used by IGN_MATH_COUNT_COPY.
+    /// \param[in] _subsystem Subsystem which copied.
+    /// \param[in] _bytes Bytes copied.
+    void IGNITION_MATH_VISIBLE CountCopy(
+        const InstrumentedSubsystem _subsystem, const uint64_t _bytes);
+    }
+  }
+}
+
+/// \brief Count heap allocations of a subsystem, named by its
+/// InstrumentedSubsystem value, such as
+/// IGN_MATH_COUNT_ALLOCATIONS(GRAPH, res.size(), bytes). The arguments are
+/// not evaluated in builds without IGNITION_MATH_INSTRUMENTATION.
+#ifdef IGNITION_MATH_INSTRUMENTATION
+#define IGN_MATH_COUNT_ALLOCATIONS(_subsystem, _count, _bytes) \
+  gz::math::CountAllocations(gz::math::InstrumentedSubsystem::_subsystem, \
+      _count, _bytes)
+#else
+#define IGN_MATH_COUNT_ALLOCATIONS(_subsystem, _count, _bytes) \
+  do {} while (false)
+#endif
+
+/// \brief Count a deep copy of a subsystem, such as
+/// IGN_MATH_COUNT_COPY(PIMPL, sizeof(FrustumPrivate)). The arguments are
+/// not evaluated in builds without IGNITION_MATH_INSTRUMENTATION.
+#ifdef IGNITION_MATH_INSTRUMENTATION
+#define IGN_MATH_COUNT_COPY(_subsystem, _bytes) \
+  gz::math::CountCopy(gz::math::InstrumentedSubsystem::_subsystem, _bytes)
+#else
+#define IGN_MATH_COUNT_COPY(_subsystem, _bytes) do {} while (false)
+#endif
+
+#endif
@@ -17,11 +17,15 @@
 #ifndef GZ_MATH_INTERVAL_HH_
 #define GZ_MATH_INTERVAL_HH_
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <ostream>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <gz/math/config.hh>
 
@@ -163,6 +167,76 @@ namespace ignition
         return this->leftValue < _value && _value < this->rightValue;
       }
 
+      /// \brief Check which of many values the interval contains. Each
+      /// result is the same as Contains(const T &) of the value, but the
+      /// open or closed bounds are resolved once with ClosedBounds(), so
+      /// the loop has no branches and can be vectorized.
+      /// \param[in] _values Array of _count values.
+      /// \param[in] _count Number of values.
+      /// \param[out] _contained Membership bitmask. Bit (i % 64) of element
+      /// (i / 64) is set when value i is contained. It is resized to hold
+      /// one bit per value, and unused bits are zero.
+      /// \return Number of values contained.
+      public: std::size_t Contains(const T *_values, const std::size_t _count,
+                                   std::vector<uint64_t> &_contained) const
+      {
+        T lo, hi;
+        this->ClosedBounds(lo, hi);
+        _contained.assign((_count + 63) / 64, 0);
+        std::size_t inside = 0;
+        for (std::size_t block = 0; block < _contained.size(); ++block)
+        {
+          const std::size_t begin = block * 64;
+          const std::size_t size = std::min<std::size_t>(64, _count - begin);
+          const T *values = _values + begin;
+          uint64_t bits = 0;
+          for (std::size_t i = 0; i < size; ++i)
+          {
+            const bool in = (lo <= values[i]) & (values[i] <= hi);
+            bits |= static_cast<uint64_t>(in) << i;
+            inside += in;
+          }
+          _contained[block] = bits;
+        }
+        return inside;
+      }
+
+      /// \brief Get the bounds of the closed interval with the same values,
+      /// so that membership only takes two comparisons of the same kind.
+      /// Open bounds of floating point intervals move inward to the next
+      /// representable value, and those of integral intervals by one.
+      /// \param[out] _lo Lowest value of the interval.
+      /// \param[out] _hi Highest value of the interval. If the interval is
+      ///   empty, `_hi` is lower than `_lo`.
+      public: void ClosedBounds(T &_lo, T &_hi) const
+      {
+        static_assert(std::is_arithmetic<T>::value,
+                      "ClosedBounds needs an arithmetic type");
+        _lo = this->leftValue;
+        _hi = this->rightValue;
+        if constexpr (std::is_floating_point<T>::value)
+        {
+          if (!this->leftClosed)
+            _lo = std::nextafter(_lo, std::numeric_limits<T>::infinity());
+          if (!this->rightClosed)
+            _hi = std::nextafter(_hi, -std::numeric_limits<T>::infinity());
+        }
+        else
+        {
+          if ((!this->leftClosed && _lo == std::numeric_limits<T>::max()) ||
+              (!this->rightClosed && _hi == std::numeric_limits<T>::lowest()))
+          {
+            _lo = std::numeric_limits<T>::max();
+            _hi = std::numeric_limits<T>::lowest();
+            return;
+          }
+          if (!this->leftClosed)
+            ++_lo;
+          if (!this->rightClosed)
+            --_hi;
+        }
+      }
+
       /// \brief Check if the interval contains `_other` interval
       /// \param[in] _other interval to check for membership
       /// \return true if it is contained, false otherwise
@@ -243,6 +317,39 @@ namespace ignition
         return true;
       }
 
+      /// \brief Compute the intersection with `_other` interval
+      /// \param[in] _other interval to intersect with
+      /// \return the intersection of both intervals, which
+      ///   is empty if they do not intersect
+      public: Interval<T> Intersection(const Interval<T> &_other) const
+      {
+        T left = this->leftValue;
+        bool isLeftClosed = this->leftClosed;
+        if (this->leftValue < _other.leftValue)
+        {
+          left = _other.leftValue;
+          isLeftClosed = _other.leftClosed;
+        }
+        else if (!(_other.leftValue < this->leftValue))
+        {
+          isLeftClosed = this->leftClosed && _other.leftClosed;
+        }
+        T right = this->rightValue;
+        bool isRightClosed = this->rightClosed;
+        if (_other.rightValue < this->rightValue)
+        {
+          right = _other.rightValue;
+          isRightClosed = _other.rightClosed;
+        }
+        else if (!(this->rightValue < _other.rightValue))
+        {
+          isRightClosed = this->rightClosed && _other.rightClosed;
+        }
+        return Interval<T>(
+            std::move(left), isLeftClosed,
+            std::move(right), isRightClosed);
+      }
+
       /// \brief Equality test operator
       /// \param _other interval to check for equality
       /// \return true if intervals are equal, false otherwise
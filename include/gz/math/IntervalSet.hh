@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_INTERVALSET_HH_
+#define GZ_MATH_INTERVALSET_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Interval.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class IntervalSet IntervalSet.hh ignition/math/IntervalSet.hh
+    /// \brief The IntervalSet class represents a union of intervals of
+    /// real numbers, such as allowed speed bands.
+    ///
+    /// The set is stored as a sorted list of disjoint, non-empty intervals,
+    /// where intervals which overlap or touch, like [0, 1) and [1, 2], are
+    /// merged. Membership tests are binary searches, so they take
+    /// O(log n) time for a set of n intervals. Union, intersection,
+    /// complement and difference are linear merges of the lists.
+    ///
+    /// \tparam T a floating point type, since complements extend to
+    ///   infinity.
+    template <typename T>
+    class IntervalSet
+    {
+      /// \brief Constructor, for an empty set.
+      public: IntervalSet() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _interval The only interval of the set.
+      public: explicit IntervalSet(const Interval<T> &_interval)
+      {
+        if (!_interval.Empty())
+          this->intervals.push_back(_interval);
+      }
+
+      /// \brief Constructor.
+      /// \param[in] _intervals Intervals of the set, in any order. They may
+      ///   overlap, and empty intervals are ignored.
+      public: explicit IntervalSet(std::vector<Interval<T>> _intervals)
+      : intervals(std::move(_intervals))
+      {
+        this->Normalize();
+      }
+
+      /// \brief Get the disjoint intervals of the set.
+      /// \return The intervals, sorted in increasing order.
+      public: const std::vector<Interval<T>> &Intervals() const
+      {
+        return this->intervals;
+      }
+
+      /// \brief Check if the set is empty.
+      /// \return True if the set has no values.
+      public: bool Empty() const
+      {
+        return this->intervals.empty();
+      }
+
+      /// \brief Check if the set contains `_value`.
+      /// \param[in] _value Value to check for membership.
+      /// \return True if it is contained, false otherwise.
+      public: bool Contains(const T &_value) const
+      {
+        // Last interval which doesn't start after the value.
+        auto it = std::upper_bound(
+            this->intervals.begin(), this->intervals.end(), _value,
+            [](const T &_v, const Interval<T> &_interval)
+            {
+              return _v < _interval.LeftValue();
+            });
+        return it != this->intervals.begin() &&
+               std::prev(it)->Contains(_value);
+      }
+
+      /// \brief Check if the set contains all of `_interval`.
+      /// \param[in] _interval Interval to check for membership.
+      /// \return True if it is contained, false otherwise. Like
+      ///   Interval::Contains, empty intervals are never contained.
+      public: bool Contains(const Interval<T> &_interval) const
+      {
+        auto it = this->FirstStartingAfter(_interval);
+        return it != this->intervals.begin() &&
+               std::prev(it)->Contains(_interval);
+      }
+
+      /// \brief Check if the set intersects `_interval`.
+      /// \param[in] _interval Interval to check for intersection.
+      /// \return True if they intersect, false otherwise.
+      public: bool Intersects(const Interval<T> &_interval) const
+      {
+        auto it = this->FirstStartingAfter(_interval);
+        return (it != this->intervals.end() && it->Intersects(_interval)) ||
+               (it != this->intervals.begin() &&
+                std::prev(it)->Intersects(_interval));
+      }
+
+      /// \brief Add an interval to the set.
+      /// \param[in] _interval The interval.
+      public: void Add(const Interval<T> &_interval)
+      {
+        *this = this->Union(IntervalSet<T>(_interval));
+      }
+
+      /// \brief Compute the union with `_other` set.
+      /// \param[in] _other Set to unite with.
+      /// \return The values in either set.
+      public: IntervalSet<T> Union(const IntervalSet<T> &_other) const
+      {
+        IntervalSet<T> result;
+        result.intervals.resize(
+            this->intervals.size() + _other.intervals.size());
+        std::merge(this->intervals.begin(), this->intervals.end(),
+                   _other.intervals.begin(), _other.intervals.end(),
+                   result.intervals.begin(), StartsBefore);
+        result.Merge();
+        return result;
+      }
+
+      /// \brief Compute the intersection with `_other` set.
+      /// \param[in] _other Set to intersect with.
+      /// \return The values in both sets.
+      public: IntervalSet<T> Intersection(const IntervalSet<T> &_other) const
+      {
+        IntervalSet<T> result;
+        auto a = this->intervals.begin();
+        auto b = _other.intervals.begin();
+        while (a != this->intervals.end() && b != _other.intervals.end())
+        {
+          Interval<T> both = a->Intersection(*b);
+          if (!both.Empty())
+            result.intervals.push_back(std::move(both));
+
+          // Move past the interval which ends first.
+          if (a->RightValue() < b->RightValue() ||
+              (!(b->RightValue() < a->RightValue()) && !a->IsRightClosed()))
+          {
+            ++a;
+          }
+          else
+          {
+            ++b;
+          }
+        }
+        return result;
+      }
+
+      /// \brief Compute the complement of the set.
+      /// \return The real numbers which are not in the set.
+      public: IntervalSet<T> Complement() const
+      {
+        IntervalSet<T> result;
+        T left = -std::numeric_limits<T>::infinity();
+        bool leftClosed = false;
+        for (const Interval<T> &interval : this->intervals)
+        {
+          const Interval<T> gap(left, leftClosed, interval.LeftValue(),
+                                !interval.IsLeftClosed());
+          if (!gap.Empty())
+            result.intervals.push_back(gap);
+          left = interval.RightValue();
+          leftClosed = !interval.IsRightClosed();
+        }
+        const Interval<T> gap(left, leftClosed,
+                              std::numeric_limits<T>::infinity(), false);
+        if (!gap.Empty())
+          result.intervals.push_back(gap);
+        return result;
+      }
+
+      /// \brief Compute the difference with `_other` set.
+      /// \param[in] _other Set to remove.
+      /// \return The values in this set and not in `_other`.
+      public: IntervalSet<T> Difference(const IntervalSet<T> &_other) const
+      {
+        return this->Intersection(_other.Complement());
+      }
+
+      /// \brief Equality test operator
+      /// \param _other set to check for equality
+      /// \return true if sets are equal, false otherwise
+      public: bool operator==(const IntervalSet<T> &_other) const
+      {
+        return this->intervals.size() == _other.intervals.size() &&
+               std::equal(this->intervals.begin(), this->intervals.end(),
+                          _other.intervals.begin());
+      }
+
+      /// \brief Inequality test operator
+      /// \param _other set to check for inequality
+      /// \return true if sets are unequal, false otherwise
+      public: bool operator!=(const IntervalSet<T> &_other) const
+      {
+        return !(*this == _other);
+      }
+
+      /// \brief Stream insertion operator
+      /// \param _out output stream
+      /// \param _set IntervalSet to output
+      /// \return the stream
+      public: friend std::ostream &operator<<(
+        std::ostream &_out, const gz::math::IntervalSet<T> &_set)
+      {
+        if (_set.intervals.empty())
+          return _out << "{}";
+        for (std::size_t i = 0; i < _set.intervals.size(); ++i)
+          _out << (i > 0 ? " U " : "") << _set.intervals[i];
+        return _out;
+      }
+
+      /// \brief Check whether an interval starts before another one.
+      /// \param[in] _a First interval.
+      /// \param[in] _b Second interval.
+      /// \return True if `_a` has values lower than all values of `_b`.
+      private: static bool StartsBefore(const Interval<T> &_a,
+                                        const Interval<T> &_b)
+      {
+        return _a.LeftValue() < _b.LeftValue() ||
+               (!(_b.LeftValue() < _a.LeftValue()) &&
+                _a.IsLeftClosed() && !_b.IsLeftClosed());
+      }
+
+      /// \brief Find the first interval of the set which starts after an
+      /// interval.
+      /// \param[in] _interval The interval.
+      /// \return Iterator to the interval, or the end of the intervals.
+      private: typename std::vector<Interval<T>>::const_iterator
+               FirstStartingAfter(const Interval<T> &_interval) const
+      {
+        return std::upper_bound(this->intervals.begin(),
+                                this->intervals.end(), _interval,
+                                StartsBefore);
+      }
+
+      /// \brief Remove empty intervals, sort the intervals and merge them.
+      private: void Normalize()
+      {
+        this->intervals.erase(
+            std::remove_if(this->intervals.begin(), this->intervals.end(),
+                           [](const Interval<T> &_interval)
+                           {
+                             return _interval.Empty();
+                           }),
+            this->intervals.end());
+        std::sort(this->intervals.begin(), this->intervals.end(),
+                  StartsBefore);
+        this->Merge();
+      }
+
+      /// \brief Merge sorted, non-empty intervals which overlap or touch.
+      private: void Merge()
+      {
+        std::size_t last = 0;
+        for (std::size_t i = 1; i < this->intervals.size(); ++i)
+        {
+          const Interval<T> &current = this->intervals[last];
+          const Interval<T> &next = this->intervals[i];
+          const bool touching =
+              next.LeftValue() < current.RightValue() ||
+              (!(current.RightValue() < next.LeftValue()) &&
+               (current.IsRightClosed() || next.IsLeftClosed()));
+          if (!touching)
+          {
+            this->intervals[++last] = next;
+            continue;
+          }
+          if (current.RightValue() < next.RightValue())
+          {
+            this->intervals[last] = Interval<T>(
+                current.LeftValue(), current.IsLeftClosed(),
+                next.RightValue(), next.IsRightClosed());
+          }
+          else if (!(next.RightValue() < current.RightValue()) &&
+                   next.IsRightClosed())
+          {
+            this->intervals[last] = Interval<T>(
+                current.LeftValue(), current.IsLeftClosed(),
+                current.RightValue(), true);
+          }
+        }
+        if (!this->intervals.empty())
+          this->intervals.resize(last + 1);
+      }
+
+      /// \brief Sorted, disjoint and non-empty intervals of the set.
+      private: std::vector<Interval<T>> intervals;
+    };
+
+    using IntervalSetf = IntervalSet<float>;
+    using IntervalSetd = IntervalSet<double>;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,846 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_KALMANFILTER_HH_
+#define GZ_MATH_KALMANFILTER_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/MatrixN.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    /// \class KalmanFilter KalmanFilter.hh ignition/math/KalmanFilter.hh
+    /// \brief A linear or extended Kalman filter with a state of N values
+    /// and measurements of M values, both fixed at compile time.
+    ///
+    /// The state and covariance are MatrixN, so the filter never
+    /// allocates. Updates use the Joseph form of the covariance update,
+    /// P = (I - K H) P (I - K H)^T + K R K^T, which keeps P symmetric and
+    /// positive semi-definite for any gain, and solve with the innovation
+    /// covariance through its Cholesky factorization instead of inverting
+    /// it. For an extended filter, pass the propagated state or predicted
+    /// measurement together with the Jacobian evaluated at the state.
+    /// KalmanFilterBank runs many linear filters with the same models.
+    /// \tparam T a floating point type.
+    /// \tparam N Number of state values.
+    /// \tparam M Number of measurement values.
+    template<typename T, std::size_t N, std::size_t M>
+    class KalmanFilter
+    {
+      /// \brief Default constructor. The state and covariance are zero.
+      public: KalmanFilter() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _state Initial state.
+      /// \param[in] _covariance Initial state covariance.
+      public: KalmanFilter(const VectorN<T, N> &_state,
+                           const MatrixN<T, N, N> &_covariance)
+      : state(_state), covariance(_covariance)
+      {
+      }
+
+      /// \brief Get the state.
+      /// \return The state estimate.
+      public: const VectorN<T, N> &State() const
+      {
+        return this->state;
+      }
+
+      /// \brief Set the state.
+      /// \param[in] _state New state estimate.
+      public: void SetState(const VectorN<T, N> &_state)
+      {
+        this->state = _state;
+      }
+
+      /// \brief Get the state covariance.
+      /// \return The covariance of the state estimate.
+      public: const MatrixN<T, N, N> &Covariance() const
+      {
+        return this->covariance;
+      }
+
+      /// \brief Set the state covariance.
+      /// \param[in] _covariance New covariance of the state estimate.
+      public: void SetCovariance(const MatrixN<T, N, N> &_covariance)
+      {
+        this->covariance = _covariance;
+      }
+
+      /// \brief Predict with a linear model, x = F x and
+      /// P = F P F^T + Q.
+      /// \param[in] _f State transition matrix F.
+      /// \param[in] _q Process noise covariance Q.
+      public: void Predict(const MatrixN<T, N, N> &_f,
+                           const MatrixN<T, N, N> &_q)
+      {
+        this->Predict(_f * this->state, _f, _q);
+      }
+
+      /// \brief Predict with a nonlinear model, x = f(x) and
+      /// P = F P F^T + Q.
+      /// \param[in] _state Propagated state f(x).
+      /// \param[in] _jacobian Jacobian F of f at the current state.
+      /// \param[in] _q Process noise covariance Q.
+      public: void Predict(const VectorN<T, N> &_state,
+                           const MatrixN<T, N, N> &_jacobian,
+                           const MatrixN<T, N, N> &_q)
+      {
+        this->state = _state;
+        this->covariance =
+            _jacobian * this->covariance * _jacobian.Transposed() + _q;
+      }
+
+      /// \brief Update with a measurement of a linear model, z = H x.
+      /// \param[in] _z Measurement.
+      /// \param[in] _h Measurement matrix H.
+      /// \param[in] _r Measurement noise covariance R.
+      /// \return False if the innovation covariance is not positive
+      /// definite, in which case the filter is unchanged.
+      public: bool Update(const VectorN<T, M> &_z,
+                          const MatrixN<T, M, N> &_h,
+                          const MatrixN<T, M, M> &_r)
+      {
+        return this->Update(_z, _h * this->state, _h, _r);
+      }
+
+      /// \brief Update with a measurement of a nonlinear model, z = h(x).
+      /// \param[in] _z Measurement.
+      /// \param[in] _predicted Predicted measurement h(x).
+      /// \param[in] _jacobian Jacobian H of h at the current state.
+      /// \param[in] _r Measurement noise covariance R.
+      /// \return False if the innovation covariance is not positive
+      /// definite, in which case the filter is unchanged.
+      public: bool Update(const VectorN<T, M> &_z,
+                          const VectorN<T, M> &_predicted,
+                          const MatrixN<T, M, N> &_jacobian,
+                          const MatrixN<T, M, M> &_r)
+      {
+        const MatrixN<T, N, M> pht = this->covariance * _jacobian.Transposed();
+        MatrixN<T, M, M> s = _jacobian * pht + _r;
+        if (!s.CholeskyFactor())
+          return false;
+
+        // K = P H^T S^-1, so S K^T = H P
+        const MatrixN<T, N, M> k = s.CholeskySolve(pht.Transposed())
+            .Transposed();
+        const MatrixN<T, N, N> a = MatrixN<T, N, N>::Identity() -
+                                   k * _jacobian;
+        this->state += k * (_z - _predicted);
+        this->covariance = a * this->covariance * a.Transposed() +
+                           k * _r * k.Transposed();
+        return true;
+      }
+
+      /// \brief State estimate.
+      private: VectorN<T, N> state;
+
+      /// \brief Covariance of the state estimate.
+      private: MatrixN<T, N, N> covariance;
+    };
+
+    /// \class UnscentedKalmanFilter KalmanFilter.hh
+    /// ignition/math/KalmanFilter.hh
+    /// \brief An unscented Kalman filter with a state of N values and
+    /// measurements of M values, both fixed at compile time.
+    ///
+    /// The models are functions, or function objects, that map a
+    /// VectorN<T, N> state to a propagated state or a VectorN<T, M>
+    /// measurement. They are evaluated at 2N + 1 sigma points drawn from
+    /// the Cholesky factor of the covariance, with the scaled unscented
+    /// transform of parameters alpha, beta and kappa. The filter never
+    /// allocates.
+    /// \tparam T a floating point type.
+    /// \tparam N Number of state values.
+    /// \tparam M Number of measurement values.
+    template<typename T, std::size_t N, std::size_t M>
+    class UnscentedKalmanFilter
+    {
+      /// \brief Number of sigma points.
+      public: static constexpr std::size_t SigmaPoints{2 * N + 1};
+
+      /// \brief Constructor.
+      /// \param[in] _state Initial state.
+      /// \param[in] _covariance Initial state covariance.
+      /// \param[in] _alpha Spread of the sigma points around the state.
+      /// \param[in] _beta Prior knowledge of the distribution, 2 for a
+      /// Gaussian.
+      /// \param[in] _kappa Secondary scaling parameter.
+      public: UnscentedKalmanFilter(const VectorN<T, N> &_state,
+                                    const MatrixN<T, N, N> &_covariance,
+                                    const T _alpha = T(1e-3),
+                                    const T _beta = 2, const T _kappa = 0)
+      : state(_state), covariance(_covariance)
+      {
+        const T n = static_cast<T>(N);
+        const T lambda = _alpha * _alpha * (n + _kappa) - n;
+        this->scale = std::sqrt(n + lambda);
+        this->meanWeight0 = lambda / (n + lambda);
+        this->covarianceWeight0 =
+            this->meanWeight0 + 1 - _alpha * _alpha + _beta;
+        this->weight = 1 / (2 * (n + lambda));
+      }
+
+      /// \brief Get the state.
+      /// \return The state estimate.
+      public: const VectorN<T, N> &State() const
+      {
+        return this->state;
+      }
+
+      /// \brief Set the state.
+      /// \param[in] _state New state estimate.
+      public: void SetState(const VectorN<T, N> &_state)
+      {
+        this->state = _state;
+      }
+
+      /// \brief Get the state covariance.
+      /// \return The covariance of the state estimate.
+      public: const MatrixN<T, N, N> &Covariance() const
+      {
+        return this->covariance;
+      }
+
+      /// \brief Set the state covariance.
+      /// \param[in] _covariance New covariance of the state estimate.
+      public: void SetCovariance(const MatrixN<T, N, N> &_covariance)
+      {
+        this->covariance = _covariance;
+      }
+
+      /// \brief Predict with a nonlinear model x = f(x).
+      /// \param[in] _f Process model, called as _f(x) for each sigma point.
+      /// \param[in] _q Process noise covariance Q.
+      /// \return False if the covariance is not positive definite, in
+      /// which case the filter is unchanged.
+      public: template<typename Function>
+      bool Predict(Function _f, const MatrixN<T, N, N> &_q)
+      {
+        VectorN<T, N> points[SigmaPoints];
+        if (!this->SigmaPointsOf(points))
+          return false;
+        for (std::size_t i = 0; i < SigmaPoints; ++i)
+          points[i] = _f(points[i]);
+
+        const VectorN<T, N> mean = this->Mean(points);
+        MatrixN<T, N, N> p = _q;
+        for (std::size_t i = 0; i < SigmaPoints; ++i)
+        {
+          const VectorN<T, N> d = points[i] - mean;
+          p += d * d.Transposed() * this->CovarianceWeight(i);
+        }
+        this->state = mean;
+        this->covariance = Symmetrized(p);
+        return true;
+      }
+
+      /// \brief Update with a measurement of a nonlinear model z = h(x).
+      /// \param[in] _z Measurement.
+      /// \param[in] _h Measurement model, called as _h(x) for each sigma
+      /// point.
+      /// \param[in] _r Measurement noise covariance R.
+      /// \return False if the state or innovation covariance is not
+      /// positive definite, in which case the filter is unchanged.
+      public: template<typename Function>
+      bool Update(const VectorN<T, M> &_z, Function _h,
+                  const MatrixN<T, M, M> &_r)
+      {
+        VectorN<T, N> points[SigmaPoints];
+        if (!this->SigmaPointsOf(points))
+          return false;
+        VectorN<T, M> measurements[SigmaPoints];
+        for (std::size_t i = 0; i < SigmaPoints; ++i)
+          measurements[i] = _h(points[i]);
+
+        const VectorN<T, M> mean = this->Mean(measurements);
+        MatrixN<T, M, M> s = _r;
+        MatrixN<T, N, M> pxz;
+        for (std::size_t i = 0; i < SigmaPoints; ++i)
+        {
+          const T w = this->CovarianceWeight(i);
+          const VectorN<T, M> dz = measurements[i] - mean;
+          s += dz * dz.Transposed() * w;
+          pxz += (points[i] - this->state) * dz.Transposed() * w;
+        }
+
+        MatrixN<T, M, M> l = s;
+        if (!l.CholeskyFactor())
+          return false;
+        const MatrixN<T, N, M> k = l.CholeskySolve(pxz.Transposed())
+            .Transposed();
+        this->state += k * (_z - mean);
+        this->covariance =
+            Symmetrized(this->covariance - k * s * k.Transposed());
+        return true;
+      }
+
+      /// \brief Draw the sigma points of the state and covariance.
+      /// \param[out] _points The SigmaPoints points.
+      /// \return False if the covariance is not positive definite.
+      private: bool SigmaPointsOf(VectorN<T, N> *_points) const
+      {
+        MatrixN<T, N, N> l = this->covariance;
+        if (!l.CholeskyFactor())
+          return false;
+        _points[0] = this->state;
+        for (std::size_t j = 0; j < N; ++j)
+        {
+          // Column j of the lower triangular factor
+          VectorN<T, N> column;
+          for (std::size_t i = j; i < N; ++i)
+            column[i] = l(i, j) * this->scale;
+          _points[1 + j] = this->state + column;
+          _points[1 + N + j] = this->state - column;
+        }
+        return true;
+      }
+
+      /// \brief Get the weighted mean of sigma points.
+      /// \param[in] _points The SigmaPoints points.
+      /// \return The mean.
+      private: template<std::size_t K>
+      VectorN<T, K> Mean(const VectorN<T, K> *_points) const
+      {
+        VectorN<T, K> mean = _points[0] * this->meanWeight0;
+        for (std::size_t i = 1; i < SigmaPoints; ++i)
+          mean += _points[i] * this->weight;
+        return mean;
+      }
+
+      /// \brief Get the covariance weight of a sigma point.
+      /// \param[in] _index Index of the point.
+      /// \return The weight.
+      private: T CovarianceWeight(const std::size_t _index) const
+      {
+        return _index == 0 ? this->covarianceWeight0 : this->weight;
+      }
+
+      /// \brief Get the symmetric part of a matrix, which removes the
+      /// rounding errors of the covariance updates.
+      /// \param[in] _m Square matrix.
+      /// \return (_m + _m^T) / 2.
+      private: static MatrixN<T, N, N> Symmetrized(
+                   const MatrixN<T, N, N> &_m)
+      {
+        return (_m + _m.Transposed()) * T(0.5);
+      }
+
+      /// \brief State estimate.
+      private: VectorN<T, N> state;
+
+      /// \brief Covariance of the state estimate.
+      private: MatrixN<T, N, N> covariance;
+
+      /// \brief Square root of N + lambda, the spread of the sigma points.
+      private: T scale = 0;
+
+      /// \brief Weight of the first sigma point in means.
+      private: T meanWeight0 = 0;
+
+      /// \brief Weight of the first sigma point in covariances.
+      private: T covarianceWeight0 = 0;
+
+      /// \brief Weight of the other sigma points.
+      private: T weight = 0;
+    };
+
+    /// \class KalmanFilterBank KalmanFilter.hh
+    /// ignition/math/KalmanFilter.hh
+    /// \brief Many independent linear Kalman filters with the same models,
+    /// such as one constant velocity filter per tracked object, updated
+    /// together.
+    ///
+    /// Each filter behaves as a KalmanFilter, with a Joseph form update.
+    /// The states and covariances are stored as structures of arrays: row
+    /// i of the states and element (i, j) of the covariances are arrays
+    /// with one value per filter. Predict and Update run every matrix
+    /// operation on blocks of filters at once, in loops over the filters
+    /// that the compiler vectorizes, and skip the zeros of F and H.
+    /// \tparam T a floating point type.
+    /// \tparam N Number of state values.
+    /// \tparam M Number of measurement values.
+    template<typename T, std::size_t N, std::size_t M>
+    class KalmanFilterBank
+    {
+      /// \brief Constructor. Creates a bank without filters.
+      public: KalmanFilterBank() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _size Number of filters, with zero states and
+      /// covariances.
+      public: explicit KalmanFilterBank(const std::size_t _size)
+      {
+        this->Resize(_size);
+      }
+
+      /// \brief Set the number of filters. New filters have zero states
+      /// and covariances.
+      /// \param[in] _size Number of filters.
+      public: void Resize(const std::size_t _size)
+      {
+        std::vector<T> x(N * _size, T(0));
+        std::vector<T> p(N * N * _size, T(0));
+        const std::size_t kept = std::min(_size, this->size);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+          std::copy_n(this->states.data() + i * this->size, kept,
+                      x.data() + i * _size);
+        }
+        for (std::size_t i = 0; i < N * N; ++i)
+        {
+          std::copy_n(this->covariances.data() + i * this->size, kept,
+                      p.data() + i * _size);
+        }
+        this->states.swap(x);
+        this->covariances.swap(p);
+        this->size = _size;
+      }
+
+      /// \brief Get the number of filters.
+      /// \return Number of filters.
+      public: std::size_t Size() const
+      {
+        return this->size;
+      }
+
+      /// \brief Set the state and covariance of a filter.
+      /// \param[in] _index Index of the filter. Nothing is done if it is
+      /// out of range.
+      /// \param[in] _state New state estimate.
+      /// \param[in] _covariance New covariance of the state estimate.
+      public: void SetFilter(const std::size_t _index,
+                             const VectorN<T, N> &_state,
+                             const MatrixN<T, N, N> &_covariance)
+      {
+        if (_index >= this->size)
+          return;
+        for (std::size_t i = 0; i < N; ++i)
+          this->states[i * this->size + _index] = _state[i];
+        for (std::size_t i = 0; i < N * N; ++i)
+          this->covariances[i * this->size + _index] = _covariance[i];
+      }
+
+      /// \brief Get the state of a filter.
+      /// \param[in] _index Index of the filter, which must be in range.
+      /// \return The state estimate.
+      public: VectorN<T, N> State(const std::size_t _index) const
+      {
+        VectorN<T, N> result;
+        for (std::size_t i = 0; i < N; ++i)
+          result[i] = this->states[i * this->size + _index];
+        return result;
+      }
+
+      /// \brief Get the state covariance of a filter.
+      /// \param[in] _index Index of the filter, which must be in range.
+      /// \return The covariance of the state estimate.
+      public: MatrixN<T, N, N> Covariance(const std::size_t _index) const
+      {
+        MatrixN<T, N, N> result;
+        for (std::size_t i = 0; i < N * N; ++i)
+          result[i] = this->covariances[i * this->size + _index];
+        return result;
+      }
+
+      /// \brief Get a row of the states.
+      /// \param[in] _row Index of the state value, less than N.
+      /// \return Array of Size() values, one per filter.
+      public: const T *StateData(const std::size_t _row) const
+      {
+        return this->states.data() + _row * this->size;
+      }
+
+      /// \brief Predict every filter with a linear model, x = F x and
+      /// P = F P F^T + Q.
+      /// \param[in] _f State transition matrix F.
+      /// \param[in] _q Process noise covariance Q.
+      public: void Predict(const MatrixN<T, N, N> &_f,
+                           const MatrixN<T, N, N> &_q)
+      {
+        T x[N][kBlockSize];
+        T p[N * N][kBlockSize];
+        T fp[N * N][kBlockSize];
+        for (std::size_t start = 0; start < this->size; start += kBlockSize)
+        {
+          const std::size_t m = std::min(kBlockSize, this->size - start);
+          this->Load(start, m, x, p);
+
+          // x = F x
+          T fx[N][kBlockSize];
+          Multiply<1>(_f, x, m, fx);
+
+          // F P, then (F P) F^T + Q for the upper triangle
+          Multiply<N>(_f, p, m, fp);
+          for (std::size_t i = 0; i < N; ++i)
+          {
+            for (std::size_t j = i; j < N; ++j)
+            {
+              T *out = p[i * N + j];
+              std::fill(out, out + m, _q(i, j));
+              for (std::size_t k = 0; k < N; ++k)
+              {
+                // Skip the exact zeros of sparse models
+                const T f = _f(j, k);
+                if (equal(f, T(0), T(0)))
+                  continue;
+                const T *a = fp[i * N + k];
+                for (std::size_t l = 0; l < m; ++l)
+                  out[l] += a[l] * f;
+              }
+            }
+          }
+          MirrorUpper(p, m);
+          this->Store(start, m, fx, p, nullptr);
+        }
+      }
+
+      /// \brief Update the filters with measurements of a linear model,
+      /// z = H x.
+      /// \param[in] _z Measurements as M rows of Size() values: value r of
+      /// the measurement of filter f is at _z[r * Size() + f].
+      /// \param[in] _h Measurement matrix H.
+      /// \param[in] _r Measurement noise covariance R.
+      /// \param[in] _valid Optional array of Size() flags, false for the
+      /// filters without a measurement, which are left unchanged.
+      /// \return Number of filters updated. Filters whose innovation
+      /// covariance is not positive definite are left unchanged.
+      public: std::size_t Update(const T *_z, const MatrixN<T, M, N> &_h,
+                                 const MatrixN<T, M, M> &_r,
+                                 const bool *_valid = nullptr)
+      {
+        std::size_t updated = 0;
+        T x[N][kBlockSize];
+        T p[N * N][kBlockSize];
+        T ph[N * M][kBlockSize];
+        T s[M * M][kBlockSize];
+        T k[N * M][kBlockSize];
+        T a[N * N][kBlockSize];
+        T ap[N * N][kBlockSize];
+        T y[M][kBlockSize];
+        bool ok[kBlockSize];
+        for (std::size_t start = 0; start < this->size; start += kBlockSize)
+        {
+          const std::size_t m = std::min(kBlockSize, this->size - start);
+          bool any = false;
+          for (std::size_t l = 0; l < m; ++l)
+          {
+            ok[l] = !_valid || _valid[start + l];
+            any = any || ok[l];
+          }
+          if (!any)
+            continue;
+          this->Load(start, m, x, p);
+
+          // Innovation y = z - H x
+          Multiply<1>(_h, x, m, y);
+          for (std::size_t r = 0; r < M; ++r)
+          {
+            const T *z = _z + r * this->size + start;
+            for (std::size_t l = 0; l < m; ++l)
+              y[r][l] = z[l] - y[r][l];
+          }
+
+          // P H^T, then S = H P H^T + R
+          for (std::size_t i = 0; i < N; ++i)
+          {
+            for (std::size_t r = 0; r < M; ++r)
+            {
+              T *out = ph[i * M + r];
+              std::fill(out, out + m, T(0));
+              for (std::size_t c = 0; c < N; ++c)
+              {
+                const T h = _h(r, c);
+                if (equal(h, T(0), T(0)))
+                  continue;
+                const T *pc = p[i * N + c];
+                for (std::size_t l = 0; l < m; ++l)
+                  out[l] += pc[l] * h;
+              }
+            }
+          }
+          Multiply<M>(_h, ph, m, s);
+          for (std::size_t i = 0; i < M * M; ++i)
+          {
+            for (std::size_t l = 0; l < m; ++l)
+              s[i][l] += _r[i];
+          }
+
+          // Cholesky factor of S in its lower triangle. Lanes that fail
+          // get NaN, and are not stored.
+          for (std::size_t j = 0; j < M; ++j)
+          {
+            T *d = s[j * M + j];
+            for (std::size_t c = 0; c < j; ++c)
+            {
+              const T *ljc = s[j * M + c];
+              for (std::size_t l = 0; l < m; ++l)
+                d[l] -= ljc[l] * ljc[l];
+            }
+            for (std::size_t l = 0; l < m; ++l)
+            {
+              ok[l] = ok[l] && d[l] > 0 && std::isfinite(d[l]);
+              d[l] = std::sqrt(d[l]);
+            }
+            for (std::size_t i = j + 1; i < M; ++i)
+            {
+              T *lij = s[i * M + j];
+              for (std::size_t c = 0; c < j; ++c)
+              {
+                const T *lic = s[i * M + c];
+                const T *ljc = s[j * M + c];
+                for (std::size_t l = 0; l < m; ++l)
+                  lij[l] -= lic[l] * ljc[l];
+              }
+              for (std::size_t l = 0; l < m; ++l)
+                lij[l] /= d[l];
+            }
+          }
+
+          // Row i of K solves S k = row i of P H^T
+          for (std::size_t i = 0; i < N; ++i)
+          {
+            for (std::size_t r = 0; r < M; ++r)
+              std::copy(ph[i * M + r], ph[i * M + r] + m, k[i * M + r]);
+            for (std::size_t r = 0; r < M; ++r)
+            {
+              T *b = k[i * M + r];
+              for (std::size_t c = 0; c < r; ++c)
+              {
+                const T *lrc = s[r * M + c];
+                const T *bc = k[i * M + c];
+                for (std::size_t l = 0; l < m; ++l)
+                  b[l] -= lrc[l] * bc[l];
+              }
+              const T *d = s[r * M + r];
+              for (std::size_t l = 0; l < m; ++l)
+                b[l] /= d[l];
+            }
+            for (std::size_t r = M; r-- > 0;)
+            {
+              T *b = k[i * M + r];
+              for (std::size_t c = r + 1; c < M; ++c)
+              {
+                const T *lcr = s[c * M + r];
+                const T *bc = k[i * M + c];
+                for (std::size_t l = 0; l < m; ++l)
+                  b[l] -= lcr[l] * bc[l];
+              }
+              const T *d = s[r * M + r];
+              for (std::size_t l = 0; l < m; ++l)
+                b[l] /= d[l];
+            }
+          }
+
+          // x += K y
+          for (std::size_t i = 0; i < N; ++i)
+          {
+            for (std::size_t r = 0; r < M; ++r)
+            {
+              const T *kir = k[i * M + r];
+              const T *yr = y[r];
+              for (std::size_t l = 0; l < m; ++l)
+                x[i][l] += kir[l] * yr[l];
+            }
+          }
+
+          // Joseph form, P = A P A^T + K R K^T with A = I - K H
+          for (std::size_t i = 0; i < N; ++i)
+          {
+            for (std::size_t j = 0; j < N; ++j)
+            {
+              T *aij = a[i * N + j];
+              std::fill(aij, aij + m, i == j ? T(1) : T(0));
+              for (std::size_t r = 0; r < M; ++r)
+              {
+                const T h = _h(r, j);
+                if (equal(h, T(0), T(0)))
+                  continue;
+                const T *kir = k[i * M + r];
+                for (std::size_t l = 0; l < m; ++l)
+                  aij[l] -= kir[l] * h;
+              }
+            }
+          }
+          for (std::size_t i = 0; i < N; ++i)
+          {
+            for (std::size_t j = 0; j < N; ++j)
+            {
+              T *out = ap[i * N + j];
+              std::fill(out, out + m, T(0));
+              for (std::size_t c = 0; c < N; ++c)
+              {
+                const T *aic = a[i * N + c];
+                const T *pcj = p[c * N + j];
+                for (std::size_t l = 0; l < m; ++l)
+                  out[l] += aic[l] * pcj[l];
+              }
+            }
+          }
+          for (std::size_t i = 0; i < N; ++i)
+          {
+            for (std::size_t j = i; j < N; ++j)
+            {
+              T *out = p[i * N + j];
+              std::fill(out, out + m, T(0));
+              for (std::size_t c = 0; c < N; ++c)
+              {
+                const T *apic = ap[i * N + c];
+                const T *ajc = a[j * N + c];
+                for (std::size_t l = 0; l < m; ++l)
+                  out[l] += apic[l] * ajc[l];
+              }
+              for (std::size_t r = 0; r < M; ++r)
+              {
+                for (std::size_t c = 0; c < M; ++c)
+                {
+                  const T rv = _r(r, c);
+                  if (equal(rv, T(0), T(0)))
+                    continue;
+                  const T *kir = k[i * M + r];
+                  const T *kjc = k[j * M + c];
+                  for (std::size_t l = 0; l < m; ++l)
+                    out[l] += kir[l] * rv * kjc[l];
+                }
+              }
+            }
+          }
+          MirrorUpper(p, m);
+
+          for (std::size_t l = 0; l < m; ++l)
+            updated += ok[l];
+          this->Store(start, m, x, p, ok);
+        }
+        return updated;
+      }
+
+      /// \brief Number of filters processed together.
+      private: static constexpr std::size_t kBlockSize = 16;
+
+      /// \brief Multiply a constant matrix by a block of matrices,
+      /// _out = _a * _b, skipping the zeros of _a.
+      /// \tparam C Number of columns of the block matrices.
+      /// \param[in] _a Constant R x K matrix.
+      /// \param[in] _b Block of K x C matrices, element (k, c) at
+      /// _b[k * C + c].
+      /// \param[in] _m Number of filters in the block.
+      /// \param[out] _out Block of R x C matrices.
+      private: template<std::size_t C, std::size_t R, std::size_t K>
+      static void Multiply(const MatrixN<T, R, K> &_a,
+                              const T (*_b)[kBlockSize], const std::size_t _m,
+                              T (*_out)[kBlockSize])
+      {
+        for (std::size_t i = 0; i < R; ++i)
+        {
+          for (std::size_t j = 0; j < C; ++j)
+          {
+            T *out = _out[i * C + j];
+            std::fill(out, out + _m, T(0));
+            for (std::size_t k = 0; k < K; ++k)
+            {
+              const T v = _a(i, k);
+              if (equal(v, T(0), T(0)))
+                continue;
+              const T *b = _b[k * C + j];
+              for (std::size_t l = 0; l < _m; ++l)
+                out[l] += v * b[l];
+            }
+          }
+        }
+      }
+
+      /// \brief Copy the upper triangles of a block of covariances to
+      /// their lower triangles.
+      /// \param[in,out] _p Block of covariances.
+      /// \param[in] _m Number of filters in the block.
+      private: static void MirrorUpper(T (*_p)[kBlockSize],
+                                       const std::size_t _m)
+      {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+          for (std::size_t j = 0; j < i; ++j)
+            std::copy(_p[j * N + i], _p[j * N + i] + _m, _p[i * N + j]);
+        }
+      }
+
+      /// \brief Copy the states and covariances of a block of filters.
+      /// \param[in] _start Index of the first filter.
+      /// \param[in] _m Number of filters.
+      /// \param[out] _x States.
+      /// \param[out] _p Covariances.
+      private: void Load(const std::size_t _start, const std::size_t _m,
+                         T (*_x)[kBlockSize], T (*_p)[kBlockSize]) const
+      {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+          const T *src = this->states.data() + i * this->size + _start;
+          std::copy(src, src + _m, _x[i]);
+        }
+        for (std::size_t i = 0; i < N * N; ++i)
+        {
+          const T *src = this->covariances.data() + i * this->size + _start;
+          std::copy(src, src + _m, _p[i]);
+        }
+      }
+
+      /// \brief Store the states and covariances of a block of filters.
+      /// \param[in] _start Index of the first filter.
+      /// \param[in] _m Number of filters.
+      /// \param[in] _x States.
+      /// \param[in] _p Covariances.
+      /// \param[in] _mask Optional flags of the filters to store.
+      private: void Store(const std::size_t _start, const std::size_t _m,
+                          const T (*_x)[kBlockSize],
+                          const T (*_p)[kBlockSize], const bool *_mask)
+      {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+          T *dst = this->states.data() + i * this->size + _start;
+          for (std::size_t l = 0; l < _m; ++l)
+            dst[l] = !_mask || _mask[l] ? _x[i][l] : dst[l];
+        }
+        for (std::size_t i = 0; i < N * N; ++i)
+        {
+          T *dst = this->covariances.data() + i * this->size + _start;
+          for (std::size_t l = 0; l < _m; ++l)
+            dst[l] = !_mask || _mask[l] ? _p[i][l] : dst[l];
+        }
+      }
+
+      /// \brief Number of filters.
+      private: std::size_t size = 0;
+
+      /// \brief States, N rows of size values.
+      private: std::vector<T> states;
+
+      /// \brief Covariances, N * N rows of size values in row major
+      /// order.
+      private: std::vector<T> covariances;
+    };
+    }
+  }
+}
+#endif
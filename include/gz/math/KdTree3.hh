@@ -0,0 +1,432 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_KDTREE3_HH_
+#define GZ_MATH_KDTREE3_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  /// \class KdTree3 KdTree3.hh ignition/math/KdTree3.hh
+  /// \brief An exact kd-tree over a set of points, used to match points
+  /// against their nearest neighbors, as in ICP scan matching or k-means
+  /// assignment.
+  ///
+  /// The tree is implicit: the points are reordered so that the median
+  /// of each range splits it, along the axis of largest extent, and the
+  /// only other data is the split axis of each median. Nodes are found by
+  /// halving ranges, ranges of a few points are scanned in order, and the
+  /// whole tree takes one byte per point besides the points and their
+  /// indices.
+  ///
+  /// Points are referred to by their index in the vector passed to
+  /// Build(). Points that are not finite are ignored. The tree does not
+  /// track changes to the points; call Build() again after they move.
+  /// Queries are const and may be made from several threads at once.
+  /// \tparam T Precision, float or double.
+  template<typename T>
+  class KdTree3
+  {
+    /// \brief Index reported when no point is found.
+    public: static constexpr std::size_t kNoPoint =
+      std::numeric_limits<std::size_t>::max();
+
+    /// \brief Default constructor. Creates an empty tree.
+    public: KdTree3() = default;
+
+    /// \brief Constructor. Builds a tree over a set of points.
+    /// \param[in] _points Points to insert.
+    public: explicit KdTree3(const std::vector<Vector3<T>> &_points)
+    {
+      this->Build(_points);
+    }
+
+    /// \brief Rebuild the tree over a new set of points, in O(n log n).
+    /// \param[in] _points Points to insert.
+    public: void Build(const std::vector<Vector3<T>> &_points)
+    {
+      this->indices.clear();
+      for (std::size_t i = 0; i < _points.size(); ++i)
+      {
+        if (_points[i].IsFinite())
+          this->indices.push_back(i);
+      }
+      this->axes.assign(this->indices.size(), 0);
+      this->BuildRange(_points, 0, this->indices.size());
+
+      this->points.clear();
+      this->points.reserve(this->indices.size());
+      for (const std::size_t index : this->indices)
+        this->points.push_back(_points[index]);
+    }
+
+    /// \brief Get the number of points in the tree, which excludes the
+    /// points that are not finite.
+    /// \return Number of points.
+    public: std::size_t Size() const
+    {
+      return this->points.size();
+    }
+
+    /// \brief Find the point nearest to a location.
+    /// \param[in] _point The location.
+    /// \param[in] _maxDistance Maximum allowed distance from the location.
+    /// \return A boolean, T, std::size_t tuple. The boolean value is true
+    /// if a point is within _maxDistance of the location. The T value is
+    /// the distance to the nearest point, and zero when there is none. The
+    /// std::size_t is the index of the nearest point, or kNoPoint. The
+    /// lowest index is reported when several points are at the same
+    /// distance.
+    public: std::tuple<bool, T, std::size_t> Nearest(
+                const Vector3<T> &_point, const T _maxDistance) const
+    {
+      Candidate best(_maxDistance * _maxDistance, kNoPoint);
+      if (_maxDistance >= 0 && _point.IsFinite() && !this->points.empty())
+        this->SearchNearest(_point, 0, this->points.size(), best);
+      if (best.second == kNoPoint)
+        return std::make_tuple(false, T(0), kNoPoint);
+      return std::make_tuple(true, std::sqrt(best.first), best.second);
+    }
+
+    /// \brief Find the points nearest to a location.
+    /// \param[in] _point The location.
+    /// \param[in] _k Number of points to find.
+    /// \param[out] _indices Indices of the _k nearest points, or of all
+    /// the points if there are fewer, nearest first. Points at the same
+    /// distance are sorted by index. The vector is cleared first.
+    public: void Nearest(const Vector3<T> &_point, const std::size_t _k,
+                         std::vector<std::size_t> &_indices) const
+    {
+      std::vector<Candidate> heap;
+      this->Search(_point, _k, heap);
+      _indices.clear();
+      for (const Candidate &candidate : heap)
+        _indices.push_back(candidate.second);
+    }
+
+    /// \brief Find the points nearest to each of a batch of locations.
+    /// \param[in] _points The locations.
+    /// \param[in] _k Number of points to find for each location.
+    /// \param[out] _indices Indices of the nearest points, _k per
+    /// location, nearest first, with location i at [i * _k, (i + 1) * _k).
+    /// Rows are padded with kNoPoint when the tree has fewer than _k
+    /// points, or when the location is not finite.
+    /// \param[out] _distances Distances to the points of _indices, with
+    /// infinity for padding.
+    /// \param[in] _threads Number of threads, each answering a contiguous
+    /// part of the batch. A value of 0 uses the number of hardware
+    /// threads. Small batches always use a single thread.
+    public: void Nearest(const std::vector<Vector3<T>> &_points,
+                         const std::size_t _k,
+                         std::vector<std::size_t> &_indices,
+                         std::vector<T> &_distances,
+                         const unsigned int _threads = 1) const
+    {
+      _indices.assign(_points.size() * _k, kNoPoint);
+      _distances.assign(_points.size() * _k,
+                        std::numeric_limits<T>::infinity());
+      if (_k == 0)
+        return;
+
+      auto work = [&](const std::size_t _begin, const std::size_t _end)
+      {
+        std::vector<Candidate> heap;
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          this->Search(_points[i], _k, heap);
+          for (std::size_t j = 0; j < heap.size(); ++j)
+          {
+            _indices[i * _k + j] = heap[j].second;
+            _distances[i * _k + j] = std::sqrt(heap[j].first);
+          }
+        }
+      };
+
+      // Each thread answers at least this many locations.
+      const std::size_t minPerThread = 256;
+      unsigned int threads = _threads;
+      if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+      threads = static_cast<unsigned int>(std::max<std::size_t>(1,
+          std::min<std::size_t>(threads, _points.size() / minPerThread)));
+
+      std::vector<std::thread> workers;
+      for (unsigned int t = 1; t < threads; ++t)
+      {
+        workers.emplace_back(work, _points.size() * t / threads,
+                             _points.size() * (t + 1) / threads);
+      }
+      work(0, _points.size() / threads);
+      for (auto &worker : workers)
+        worker.join();
+    }
+
+    /// \brief Find the points within a distance of a location.
+    /// \param[in] _center The location.
+    /// \param[in] _radius Maximum distance, inclusive.
+    /// \param[out] _indices Indices of the points, in no particular order.
+    /// The vector is cleared first.
+    public: void Overlaps(const Vector3<T> &_center, const T _radius,
+                          std::vector<std::size_t> &_indices) const
+    {
+      _indices.clear();
+      if (_radius >= 0 && !this->points.empty())
+      {
+        this->SearchRadius(_center, _radius * _radius, 0,
+                           this->points.size(), _indices);
+      }
+    }
+
+    /// \brief A point found by a search, ordered by squared distance then
+    /// index.
+    private: using Candidate = std::pair<T, std::size_t>;
+
+    /// \brief Ranges with at most this many points are scanned.
+    private: static constexpr std::size_t kLeafSize = 8;
+
+    /// \brief Split a range at its median along its axis of largest
+    /// extent, and the two halves recursively.
+    /// \param[in] _points Points passed to Build().
+    /// \param[in] _begin First index of the range.
+    /// \param[in] _end One past the last index of the range.
+    private: void BuildRange(const std::vector<Vector3<T>> &_points,
+                             const std::size_t _begin, const std::size_t _end)
+    {
+      if (_end - _begin <= kLeafSize)
+        return;
+
+      Vector3<T> min = _points[this->indices[_begin]];
+      Vector3<T> max = min;
+      for (std::size_t i = _begin + 1; i < _end; ++i)
+      {
+        min.Min(_points[this->indices[i]]);
+        max.Max(_points[this->indices[i]]);
+      }
+      const Vector3<T> extent = max - min;
+      int axis = 0;
+      if (extent.Y() > extent[axis])
+        axis = 1;
+      if (extent.Z() > extent[axis])
+        axis = 2;
+
+      const std::size_t mid = _begin + (_end - _begin) / 2;
+      std::nth_element(this->indices.begin() + _begin,
+          this->indices.begin() + mid, this->indices.begin() + _end,
+          [&](const std::size_t _a, const std::size_t _b)
+          {
+            return _points[_a][axis] < _points[_b][axis];
+          });
+      this->axes[mid] = static_cast<uint8_t>(axis);
+      this->BuildRange(_points, _begin, mid);
+      this->BuildRange(_points, mid + 1, _end);
+    }
+
+    /// \brief Offer a point to a max-heap of the _k nearest points.
+    /// \param[in] _candidate The point.
+    /// \param[in] _k Size of the heap.
+    /// \param[in,out] _heap The heap.
+    private: static void Offer(const Candidate &_candidate,
+                               const std::size_t _k,
+                               std::vector<Candidate> &_heap)
+    {
+      if (_heap.size() < _k)
+      {
+        _heap.push_back(_candidate);
+        std::push_heap(_heap.begin(), _heap.end());
+      }
+      else if (_candidate < _heap.front())
+      {
+        std::pop_heap(_heap.begin(), _heap.end());
+        _heap.back() = _candidate;
+        std::push_heap(_heap.begin(), _heap.end());
+      }
+    }
+
+    /// \brief Find the _k points nearest to a location.
+    /// \param[in] _point The location.
+    /// \param[in] _k Number of points to find.
+    /// \param[out] _heap The points found, nearest first.
+    private: void Search(const Vector3<T> &_point, const std::size_t _k,
+                         std::vector<Candidate> &_heap) const
+    {
+      _heap.clear();
+      if (_k == 0 || !_point.IsFinite() || this->points.empty())
+        return;
+      this->SearchRange(_point, _k, 0, this->points.size(), _heap);
+      std::sort_heap(_heap.begin(), _heap.end());
+    }
+
+    /// \brief Find the _k points nearest to a location in a range,
+    /// visiting the half that holds the location first.
+    /// \param[in] _point The location.
+    /// \param[in] _k Number of points to find.
+    /// \param[in] _begin First index of the range.
+    /// \param[in] _end One past the last index of the range.
+    /// \param[in,out] _heap Max-heap of the points found.
+    private: void SearchRange(const Vector3<T> &_point, const std::size_t _k,
+                              const std::size_t _begin,
+                              const std::size_t _end,
+                              std::vector<Candidate> &_heap) const
+    {
+      if (_end - _begin <= kLeafSize)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          Offer(Candidate((this->points[i] - _point).SquaredLength(),
+                          this->indices[i]), _k, _heap);
+        }
+        return;
+      }
+
+      const std::size_t mid = _begin + (_end - _begin) / 2;
+      Offer(Candidate((this->points[mid] - _point).SquaredLength(),
+                      this->indices[mid]), _k, _heap);
+      const int axis = this->axes[mid];
+      const T diff = _point[axis] - this->points[mid][axis];
+      if (diff < 0)
+        this->SearchRange(_point, _k, _begin, mid, _heap);
+      else
+        this->SearchRange(_point, _k, mid + 1, _end, _heap);
+
+      // Points at the same distance as the farthest found may have a
+      // lower index, so the other half is searched on ties.
+      if (_heap.size() < _k || diff * diff <= _heap.front().first)
+      {
+        if (diff < 0)
+          this->SearchRange(_point, _k, mid + 1, _end, _heap);
+        else
+          this->SearchRange(_point, _k, _begin, mid, _heap);
+      }
+    }
+
+    /// \brief Find the point nearest to a location in a range.
+    /// \param[in] _point The location.
+    /// \param[in] _begin First index of the range.
+    /// \param[in] _end One past the last index of the range.
+    /// \param[in,out] _best Nearest point found, with kNoPoint as index
+    /// while none is found within the squared distance of _best.
+    private: void SearchNearest(const Vector3<T> &_point,
+                                const std::size_t _begin,
+                                const std::size_t _end,
+                                Candidate &_best) const
+    {
+      auto offer = [&](const std::size_t _i)
+      {
+        const Candidate candidate(
+            (this->points[_i] - _point).SquaredLength(), this->indices[_i]);
+        if (candidate.first <= _best.first &&
+            (_best.second == kNoPoint || candidate < _best))
+        {
+          _best = candidate;
+        }
+      };
+
+      if (_end - _begin <= kLeafSize)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+          offer(i);
+        return;
+      }
+
+      const std::size_t mid = _begin + (_end - _begin) / 2;
+      offer(mid);
+      const int axis = this->axes[mid];
+      const T diff = _point[axis] - this->points[mid][axis];
+      if (diff < 0)
+        this->SearchNearest(_point, _begin, mid, _best);
+      else
+        this->SearchNearest(_point, mid + 1, _end, _best);
+
+      if (diff * diff <= _best.first)
+      {
+        if (diff < 0)
+          this->SearchNearest(_point, mid + 1, _end, _best);
+        else
+          this->SearchNearest(_point, _begin, mid, _best);
+      }
+    }
+
+    /// \brief Find the points within a distance of a location in a range.
+    /// \param[in] _center The location.
+    /// \param[in] _radiusSquared Squared maximum distance.
+    /// \param[in] _begin First index of the range.
+    /// \param[in] _end One past the last index of the range.
+    /// \param[out] _indices Indices of the points found, appended.
+    private: void SearchRadius(const Vector3<T> &_center,
+                               const T _radiusSquared,
+                               const std::size_t _begin,
+                               const std::size_t _end,
+                               std::vector<std::size_t> &_indices) const
+    {
+      if (_end - _begin <= kLeafSize)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          if ((this->points[i] - _center).SquaredLength() <= _radiusSquared)
+            _indices.push_back(this->indices[i]);
+        }
+        return;
+      }
+
+      const std::size_t mid = _begin + (_end - _begin) / 2;
+      if ((this->points[mid] - _center).SquaredLength() <= _radiusSquared)
+        _indices.push_back(this->indices[mid]);
+      const int axis = this->axes[mid];
+      const T diff = _center[axis] - this->points[mid][axis];
+      if (diff <= 0 || diff * diff <= _radiusSquared)
+        this->SearchRadius(_center, _radiusSquared, _begin, mid, _indices);
+      if (diff >= 0 || diff * diff <= _radiusSquared)
+      {
+        this->SearchRadius(_center, _radiusSquared, mid + 1, _end,
+                           _indices);
+      }
+    }
+
+    /// \brief Points, in tree order.
+    private: std::vector<Vector3<T>> points;
+
+    /// \brief Index passed to Build() of each point.
+    private: std::vector<std::size_t> indices;
+
+    /// \brief Split axis of each median, unused for other points.
+    private: std::vector<uint8_t> axes;
+  };
+
+  /// \brief KdTree3 with double precision.
+  typedef KdTree3<double> KdTree3d;
+
+  /// \brief KdTree3 with single precision.
+  typedef KdTree3<float> KdTree3f;
+  }
+}
+}
+#endif
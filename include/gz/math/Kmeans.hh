@@ -17,7 +17,11 @@
 #ifndef GZ_MATH_KMEANS_HH_
 #define GZ_MATH_KMEANS_HH_
 
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
 #include <vector>
+#include <gz/math/Executor.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/Helpers.hh>
 #include <gz/math/config.hh>
@@ -39,28 +43,119 @@ namespace ignition
     /// Description based on http://en.wikipedia.org/wiki/K-means_clustering.
     class IGNITION_MATH_VISIBLE Kmeans
     {
+      /// \enum SeedingType
+      /// \brief Strategies to choose the initial centroids.
+      public: enum SeedingType
+              {
+                /// \brief Use the first k observations as initial centroids.
+                /// This is the default.
+                FIRST_OBSERVATIONS = 0,
+
+                /// \brief k-means++ seeding. The first centroid is a random
+                /// observation and each following centroid is an observation
+                /// chosen with probability proportional to its squared
+                /// distance to the closest centroid already chosen. It
+                /// usually converges in fewer iterations and to better
+                /// clusters. The random choices use gz::math::Rand, so
+                /// results are repeatable with Rand::Seed().
+                KMEANS_PLUS_PLUS = 1
+              };
+
       /// \brief constructor
       /// \param[in] _obs Set of observations to cluster.
       public: explicit Kmeans(const std::vector<Vector3d> &_obs);
 
+      /// \brief Constructor which takes the observations without copying
+      /// them.
+      /// \param[in] _obs Set of observations to cluster.
+      public: explicit Kmeans(std::vector<Vector3d> &&_obs);
+
+      /// \brief Constructor. The observations, centroids and the working
+      /// memory of Cluster() and UpdateClusters() are allocated from a
+      /// memory resource, such as a std::pmr::monotonic_buffer_resource.
+      /// Observations moved in later keep their own allocation.
+      /// \param[in] _obs Set of observations to cluster.
+      /// \param[in] _resource Memory resource, which must outlive the
+      /// object.
+      public: Kmeans(const std::vector<Vector3d> &_obs,
+                     std::pmr::memory_resource *_resource);
+
       /// \brief Destructor.
       public: virtual ~Kmeans();
 
       /// \brief Get the observations to cluster.
       /// \return The vector of observations.
+      /// \sa ObservationData() to read them without a copy.
       public: std::vector<Vector3d> Observations() const;
 
+      /// \brief Get the observations to cluster without copying them.
+      /// \return Pointer to the ObservationCount() observations, valid
+      /// until the observations are changed.
+      public: const Vector3d *ObservationData() const;
+
+      /// \brief Get the number of observations to cluster.
+      /// \return The number of observations.
+      public: std::size_t ObservationCount() const;
+
       /// \brief Set the observations to cluster.
       /// \param[in] _obs The new vector of observations.
       /// \return True if the vector is not empty or false otherwise.
       public: bool Observations(const std::vector<Vector3d> &_obs);
 
+      /// \brief Set the observations to cluster, taking the vector
+      /// without copying it.
+      /// \param[in] _obs The new vector of observations. It is left
+      /// unchanged if it is empty.
+      /// \return True if the vector is not empty or false otherwise.
+      public: bool Observations(std::vector<Vector3d> &&_obs);
+
       /// \brief Add observations to the cluster.
       /// \param[in] _obs Vector of observations.
       /// \return True if the _obs vector is not empty or false otherwise.
       public: bool AppendObservations(const std::vector<Vector3d> &_obs);
 
+      /// \brief Add observations to the cluster. When there are no
+      /// observations yet, the vector is taken without copying it.
+      /// \param[in] _obs Vector of observations.
+      /// \return True if the _obs vector is not empty or false otherwise.
+      public: bool AppendObservations(std::vector<Vector3d> &&_obs);
+
+      /// \brief Set weighted observations to cluster. An observation of
+      /// weight w counts as w identical observations, so clustering points
+      /// aggregated into voxels, weighted by the number of points of each
+      /// voxel, gives the centroids of the raw points.
+      /// \param[in] _obs The new vector of observations.
+      /// \param[in] _weights Weight of each observation, finite and not
+      /// negative. Observations of weight 0 are labeled but do not move
+      /// the centroids.
+      /// \return True if the vectors are not empty, have the same size and
+      /// the weights are valid, or false otherwise.
+      public: bool Observations(const std::vector<Vector3d> &_obs,
+                                const std::vector<double> &_weights);
+
+      /// \brief Add weighted observations to the cluster. Observations
+      /// added without weights have a weight of 1.
+      /// \param[in] _obs Vector of observations.
+      /// \param[in] _weights Weight of each observation, see
+      /// Observations(const std::vector<Vector3d> &,
+      /// const std::vector<double> &).
+      /// \return True if the vectors are not empty, have the same size and
+      /// the weights are valid, or false otherwise.
+      public: bool AppendObservations(const std::vector<Vector3d> &_obs,
+                                      const std::vector<double> &_weights);
+
+      /// \brief Get the weights of the observations.
+      /// \return The weight of each observation, 1 for the observations set
+      /// without weights.
+      public: std::vector<double> Weights() const;
+
       /// \brief Executes the k-means algorithm.
+      /// Each centroid is the weighted mean of its observations, see
+      /// Observations(const std::vector<Vector3d> &,
+      /// const std::vector<double> &).
+      /// The assignment step uses Hamerly's triangle inequality bounds to
+      /// skip most distance computations once centroids stop moving much.
+      /// The labels are the same as with a brute force search.
       /// \param[in] _k Number of partitions to cluster.
       /// \param[out] _centroids Vector of centroids. Each element contains the
       /// centroid of one cluster.
@@ -75,6 +170,110 @@ namespace ignition
                            std::vector<Vector3d> &_centroids,
                            std::vector<unsigned int> &_labels);
 
+      /// \brief Executes the k-means algorithm, writing the results into
+      /// buffers owned by the caller. The results can also be read,
+      /// without copies, with CentroidData() and LabelData().
+      /// \param[in] _k Number of partitions to cluster.
+      /// \param[out] _centroids Buffer for the _k centroids, or nullptr.
+      /// \param[out] _labels Buffer for the ObservationCount() labels, or
+      /// nullptr.
+      /// \return True when the operation succeed or false otherwise, as
+      /// for Cluster(int, std::vector<Vector3d> &,
+      /// std::vector<unsigned int> &). The buffers are not written on
+      /// failure.
+      public: bool Cluster(int _k, Vector3d *_centroids,
+                           unsigned int *_labels);
+
+      /// \brief Get the centroids without copying them.
+      /// \return Pointer to the CentroidCount() centroids computed by the
+      /// last Cluster() and UpdateClusters() calls, valid until the next
+      /// one.
+      public: const Vector3d *CentroidData() const;
+
+      /// \brief Get the number of centroids.
+      /// \return The number of centroids, 0 before Cluster() succeeds.
+      public: std::size_t CentroidCount() const;
+
+      /// \brief Get the labels of the observations without copying them.
+      /// \return Pointer to the LabelCount() labels computed by the last
+      /// Cluster() call, valid until the next one.
+      public: const unsigned int *LabelData() const;
+
+      /// \brief Get the number of labels.
+      /// \return The number of observations at the last Cluster() call.
+      public: std::size_t LabelCount() const;
+
+      /// \brief Update the clusters computed by the last Cluster() call with
+      /// a batch of new observations, without clustering the whole set of
+      /// observations again (mini-batch k-means). Each new observation is
+      /// assigned to its closest centroid, and then each centroid moves
+      /// towards its new observations so that it remains the mean of all
+      /// the observations it has been assigned.
+      ///
+      /// Unlike AppendObservations(), the new observations are not stored,
+      /// so the memory used does not grow with the number of updates. A
+      /// following call to Cluster() starts from scratch using
+      /// Observations() only.
+      /// \param[in] _obs Batch of new observations.
+      /// \param[out] _centroids Vector of updated centroids.
+      /// \param[out] _labels Vector of labels. The size of this vector is
+      /// equal to the size of _obs. Each element represents the cluster to
+      /// which the new observation belongs.
+      /// \return True when the operation succeed or false otherwise. The
+      /// operation will fail if _obs is empty or if Cluster() has not been
+      /// called successfully before.
+      public: bool UpdateClusters(const std::vector<Vector3d> &_obs,
+                                  std::vector<Vector3d> &_centroids,
+                                  std::vector<unsigned int> &_labels);
+
+      /// \brief Update the clusters computed by the last Cluster() call with
+      /// a batch of new weighted observations. Each centroid remains the
+      /// weighted mean of all the observations it has been assigned.
+      /// \param[in] _obs Batch of new observations.
+      /// \param[in] _weights Weight of each new observation, finite and not
+      /// negative.
+      /// \param[out] _centroids Vector of updated centroids.
+      /// \param[out] _labels Vector of labels, one for each new observation.
+      /// \return True when the operation succeed or false otherwise. The
+      /// operation will fail if _obs is empty, if the weights are not valid
+      /// or if Cluster() has not been called successfully before.
+      /// \sa UpdateClusters(const std::vector<Vector3d> &,
+      /// std::vector<Vector3d> &, std::vector<unsigned int> &)
+      public: bool UpdateClusters(const std::vector<Vector3d> &_obs,
+                                  const std::vector<double> &_weights,
+                                  std::vector<Vector3d> &_centroids,
+                                  std::vector<unsigned int> &_labels);
+
+      /// \brief Set the strategy used to choose the initial centroids.
+      /// \param[in] _seeding The seeding strategy.
+      public: void SetSeeding(SeedingType _seeding);
+
+      /// \brief Get the strategy used to choose the initial centroids.
+      /// \return The seeding strategy. The default is FIRST_OBSERVATIONS.
+      public: SeedingType Seeding() const;
+
+      /// \brief Set the number of threads used by Cluster() to assign
+      /// observations to centroids and to seed with k-means++. Each thread
+      /// processes a contiguous block of observations. Note that partial
+      /// sums are combined in a different order with more than one thread,
+      /// so centroids may differ in the last bits from a single thread run.
+      /// \param[in] _threads Number of threads. A value of 0 uses the number
+      /// of hardware threads.
+      public: void SetThreadCount(unsigned int _threads);
+
+      /// \brief Get the number of threads used by Cluster().
+      /// \return The number of threads. The default is 1. A value of 0 means
+      /// the number of hardware threads.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Set the executor used by Cluster() and UpdateClusters()
+      /// instead of threads of their own, such as a ThreadPool shared with
+      /// other batch operations. When set, the thread count is ignored and
+      /// observations are split into Executor::BlockCount blocks.
+      /// \param[in] _executor The executor, or nullptr to use the thread
+      /// count again.
+      public: void SetExecutor(std::shared_ptr<Executor> _executor);
+
       /// \brief Given an observation, it returns the closest centroid to it.
       /// \param[in] _p Point to check.
       /// \return The index of the closest centroid to the point _p.
@@ -18,6 +18,7 @@
 #define GZ_MATH_LINE2_HH_
 
 #include <algorithm>
+#include <cmath>
 #include <gz/math/Vector2.hh>
 #include <gz/math/config.hh>
 
@@ -261,6 +262,38 @@ namespace ignition
                     (this->pts[0].Y() - this->pts[1].Y()));
       }
 
+      /// \brief Calculate the shortest distance between the line segment
+      /// and a point.
+      /// \param[in] _pt Point which we are measuring distance to.
+      /// \return Distance from the point to the closest point of the
+      /// segment, or to the start point if the segment has length 0.
+      public: double Distance(const math::Vector2<T> &_pt) const
+      {
+        const double dx = static_cast<double>(this->pts[1].X()) -
+                          this->pts[0].X();
+        const double dy = static_cast<double>(this->pts[1].Y()) -
+                          this->pts[0].Y();
+        const double px = static_cast<double>(_pt.X()) - this->pts[0].X();
+        const double py = static_cast<double>(_pt.Y()) - this->pts[0].Y();
+
+        // Point is projected beyond pt0 or the line has length 0
+        const double along = px * dx + py * dy;
+        if (along <= 0.0)
+          return std::sqrt(px * px + py * py);
+
+        // Point is projected beyond pt1
+        const double lengthSquared = dx * dx + dy * dy;
+        if (along >= lengthSquared)
+        {
+          const double qx = static_cast<double>(_pt.X()) - this->pts[1].X();
+          const double qy = static_cast<double>(_pt.Y()) - this->pts[1].Y();
+          return std::sqrt(qx * qx + qy * qy);
+        }
+
+        // Distance to point projected onto line
+        return std::abs(px * dy - py * dx) / std::sqrt(lengthSquared);
+      }
+
       /// \brief Get the slope of the line
       /// \return The slope of the line, NAN_D if the line is vertical.
       public: double Slope() const
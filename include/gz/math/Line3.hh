@@ -18,7 +18,13 @@
 #define GZ_MATH_LINE3_HH_
 
 #include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
 #include <gz/math/Vector3.hh>
+#include <gz/math/Vector3SoA.hh>
 #include <gz/math/config.hh>
 
 namespace ignition
@@ -229,10 +235,62 @@ namespace ignition
         return true;
       }
 
+      /// \brief Compute the shortest distance between this segment and each
+      /// segment of a batch, for example to prefilter capsule collisions.
+      ///
+      /// Unlike Distance(const Line3<T> &, Line3<T> &, double), segments of
+      /// zero length are handled as points and parallel segments need no
+      /// tolerance. The distance loop only uses arithmetic and selects so
+      /// that it can be auto-vectorized.
+      /// \param[in] _starts Start points of the segments.
+      /// \param[in] _ends End points of the segments, with the same size as
+      /// _starts.
+      /// \param[out] _distances Distance from this segment to each segment,
+      /// resized to _starts.Size().
+      public: void Distances(const Vector3SoA<T> &_starts,
+                             const Vector3SoA<T> &_ends,
+                             std::vector<T> &_distances) const
+      {
+        const T start[3] = {this->pts[0].X(), this->pts[0].Y(),
+                            this->pts[0].Z()};
+        const T end[3] = {this->pts[1].X(), this->pts[1].Y(),
+                          this->pts[1].Z()};
+        _distances.resize(_starts.Size());
+        DistancesKernel<false>(_starts.Size(),
+            start, start + 1, start + 2, end, end + 1, end + 2,
+            _starts.XData(), _starts.YData(), _starts.ZData(),
+            _ends.XData(), _ends.YData(), _ends.ZData(), _distances.data());
+      }
+
+      /// \brief Compute the shortest distance between the segments of two
+      /// batches, pair by pair, as Distances(const Vector3SoA<T> &,
+      /// const Vector3SoA<T> &, std::vector<T> &) does for one segment.
+      /// \param[in] _startsA Start points of the first segments.
+      /// \param[in] _endsA End points of the first segments.
+      /// \param[in] _startsB Start points of the second segments.
+      /// \param[in] _endsB End points of the second segments. All four
+      /// containers must have the same size.
+      /// \param[out] _distances Distance between each pair of segments,
+      /// resized to _startsA.Size().
+      public: static void Distances(const Vector3SoA<T> &_startsA,
+                                    const Vector3SoA<T> &_endsA,
+                                    const Vector3SoA<T> &_startsB,
+                                    const Vector3SoA<T> &_endsB,
+                                    std::vector<T> &_distances)
+      {
+        _distances.resize(_startsA.Size());
+        DistancesKernel<true>(_startsA.Size(),
+            _startsA.XData(), _startsA.YData(), _startsA.ZData(),
+            _endsA.XData(), _endsA.YData(), _endsA.ZData(),
+            _startsB.XData(), _startsB.YData(), _startsB.ZData(),
+            _endsB.XData(), _endsB.YData(), _endsB.ZData(),
+            _distances.data());
+      }
+
       /// \brief Calculate shortest distance between line and point
       /// \param[in] _pt Point which we are measuring distance to.
       /// \returns Distance from point to line.
-      public: T Distance(const Vector3<T> &_pt)
+      public: T Distance(const Vector3<T> &_pt) const
       {
         auto line = this->pts[1] - this->pts[0];
         auto ptTo0 = _pt - this->pts[0];
@@ -411,6 +469,99 @@ namespace ignition
         return *this;
       }
 
+      /// \brief Shortest distance between pairs of segments, following
+      /// Ericson, Real-Time Collision Detection, section 5.1.9. The
+      /// parameter on the first segment is clamped, the parameter on the
+      /// second segment is solved for it and clamped, and the first is
+      /// solved again.
+      ///
+      /// The loop has no comparisons, which GCC would not if-convert, so
+      /// that it vectorizes. Divisors get a small offset instead: a segment
+      /// of zero length has zero numerators and so a zero parameter, and for
+      /// parallel segments any first parameter in [0, 1] leads to the right
+      /// distance. Squared distances go to a local block, which cannot alias
+      /// the inputs, and square roots are taken in a second loop.
+      /// \tparam Pairwise True to read pair i of the first segments, false
+      /// to use their first element for every pair.
+      /// \param[in] _n Number of pairs.
+      /// \param[in] _ax X coordinates of the starts of the first segments.
+      /// \param[in] _ay Y coordinates of the starts of the first segments.
+      /// \param[in] _az Z coordinates of the starts of the first segments.
+      /// \param[in] _bx X coordinates of the ends of the first segments.
+      /// \param[in] _by Y coordinates of the ends of the first segments.
+      /// \param[in] _bz Z coordinates of the ends of the first segments.
+      /// \param[in] _cx X coordinates of the starts of the second segments.
+      /// \param[in] _cy Y coordinates of the starts of the second segments.
+      /// \param[in] _cz Z coordinates of the starts of the second segments.
+      /// \param[in] _dx X coordinates of the ends of the second segments.
+      /// \param[in] _dy Y coordinates of the ends of the second segments.
+      /// \param[in] _dz Z coordinates of the ends of the second segments.
+      /// \param[out] _out Array of _n distances.
+      private: template<bool Pairwise>
+               static void DistancesKernel(const std::size_t _n,
+                   const T *_ax, const T *_ay, const T *_az,
+                   const T *_bx, const T *_by, const T *_bz,
+                   const T *_cx, const T *_cy, const T *_cz,
+                   const T *_dx, const T *_dy, const T *_dz, T *_out)
+      {
+        const T tiny = std::numeric_limits<T>::min();
+        const T eps = std::numeric_limits<T>::epsilon();
+        const std::size_t kBlockSize = 64;
+        T block[kBlockSize];
+        for (std::size_t begin = 0; begin < _n; begin += kBlockSize)
+        {
+          const std::size_t count = std::min(kBlockSize, _n - begin);
+          for (std::size_t k = 0; k < count; ++k)
+          {
+            const std::size_t i = begin + k;
+            const std::size_t j = Pairwise ? i : 0;
+            const T d1x = _bx[j] - _ax[j];
+            const T d1y = _by[j] - _ay[j];
+            const T d1z = _bz[j] - _az[j];
+            const T d2x = _dx[i] - _cx[i];
+            const T d2y = _dy[i] - _cy[i];
+            const T d2z = _dz[i] - _cz[i];
+            const T rx = _ax[j] - _cx[i];
+            const T ry = _ay[j] - _cy[i];
+            const T rz = _az[j] - _cz[i];
+
+            const T a = d1x * d1x + d1y * d1y + d1z * d1z;
+            const T e = d2x * d2x + d2y * d2y + d2z * d2z;
+            const T b = d1x * d2x + d1y * d2y + d1z * d2z;
+            const T c = d1x * rx + d1y * ry + d1z * rz;
+            const T f = d2x * rx + d2y * ry + d2z * rz;
+            // The relative offset keeps the first parameter of nearly
+            // parallel segments from overflowing.
+            const T denom = a * e - b * b + eps * a * e + tiny;
+
+            // Independent reciprocals keep divisions out of the chain below.
+            const T invDenom = T(1) / denom;
+            const T invE = T(1) / (e + tiny);
+            const T invA = T(1) / (a + tiny);
+
+            T s = Clamp01((b * f - c * e) * invDenom);
+            const T t = Clamp01((b * s + f) * invE);
+            s = Clamp01((b * t - c) * invA);
+
+            const T x = rx + d1x * s - d2x * t;
+            const T y = ry + d1y * s - d2y * t;
+            const T z = rz + d1z * s - d2z * t;
+            block[k] = x * x + y * y + z * z;
+          }
+
+          for (std::size_t k = 0; k < count; ++k)
+            _out[begin + k] = static_cast<T>(std::sqrt(block[k]));
+        }
+      }
+
+      /// \brief Clamp a value to [0, 1] without comparisons.
+      /// \param[in] _x Value to clamp.
+      /// \return The clamped value.
+      private: static T Clamp01(const T _x)
+      {
+        return T(0.5) * (std::abs(_x) - std::abs(_x - T(1)) + T(1));
+      }
+
       /// \brief Vector for storing the start and end points of the line
       private: math::Vector3<T> pts[2];
     };
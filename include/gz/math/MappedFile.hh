@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_MAPPEDFILE_HH_
+#define GZ_MATH_MAPPEDFILE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  // Forward declaration.
+  class MappedFilePrivate;
+
+  /// \class MappedFile MappedFile.hh ignition/math/MappedFile.hh
+  /// \brief A file mapped read only in memory.
+  ///
+  /// Opening a file maps it without reading it; the operating system
+  /// loads its pages when they are accessed and can drop them under
+  /// memory pressure, so files larger than the memory can be read in
+  /// place. The mapping starts on a page boundary, so data written at
+  /// aligned offsets in the file can be read as arrays of values.
+  ///
+  /// The file must not be modified while it is mapped. A MappedFile can
+  /// be moved but not copied, and Data() can be read from several threads
+  /// at the same time.
+  class IGNITION_MATH_VISIBLE MappedFile
+  {
+    /// \brief Default constructor. No file is open.
+    public: MappedFile();
+
+    /// \brief Move constructor.
+    /// \param[in] _file File to move. It is left closed.
+    public: MappedFile(MappedFile &&_file);
+
+    /// \brief Destructor. Closes the file.
+    public: ~MappedFile();
+
+    /// \brief Move assignment operator. Closes the current file.
+    /// \param[in] _file File to move. It is left closed.
+    /// \return Reference to this object.
+    public: MappedFile &operator=(MappedFile &&_file) noexcept;
+
+    /// \brief Map a file, closing the current one first.
+    /// \param[in] _filename Path of the file.
+    /// \return True on success, false if the file can't be opened or
+    /// is empty.
+    public: bool Open(const std::string &_filename);
+
+    /// \brief Unmap the file.
+    public: void Close();
+
+    /// \brief Get whether a file is mapped.
+    /// \return True if a file is mapped.
+    public: bool IsOpen() const;
+
+    /// \brief Get the mapped bytes.
+    /// \return The first byte of the file, or nullptr if no file is
+    /// mapped.
+    public: const uint8_t *Data() const;
+
+    /// \brief Get the size of the file.
+    /// \return Number of mapped bytes, 0 if no file is mapped.
+    public: std::size_t Size() const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+    /// \brief Private data pointer.
+    private: std::unique_ptr<MappedFilePrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+  };
+  }
+}
+}
+#endif
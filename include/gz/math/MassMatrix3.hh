@@ -671,7 +671,7 @@ namespace ignition
             - Id[0]*Id[1]*Id[2]
             - 2*Ip[0]*Ip[1]*Ip[2];
         // p = b^2 - 3c
-        T p = std::pow(b, 2) - 3*c;
+        T p = b*b - 3*c;
 
         // At this point, it is important to check that p is not close
         //  to zero, since its inverse is used to compute delta.
@@ -684,16 +684,24 @@ namespace ignition
           return b / 3.0 * Vector3<T>::One;
 
         // q = 2b^3 - 9bc - 27d
-        T q = 2*std::pow(b, 3) - 9*b*c - 27*d;
+        T q = (2*b*b - 9*c)*b - 27*d;
 
         // delta = acos(q / (2 * p^(1.5)))
         // additionally clamp the argument to [-1,1]
-        T delta = acos(clamp<T>(0.5 * q / std::pow(p, 1.5), -1, 1));
+        const T sqrtP = sqrt(p);
+        T delta = acos(clamp<T>(0.5 * q / (p * sqrtP), -1, 1));
+
+        // The three roots use cos(delta/3 + k*2pi/3), which are expanded
+        // from the sine and cosine of delta/3 to evaluate only two
+        // trigonometric functions.
+        const T cos0 = cos(delta / 3);
+        const T sin0 = sin(delta / 3);
+        const T sqrt3 = static_cast<T>(1.7320508075688772);
+        T moment0 = (b + 2*sqrtP * cos0) / 3;
+        T moment1 = (b - sqrtP * (cos0 + sqrt3*sin0)) / 3;
+        T moment2 = (b - sqrtP * (cos0 - sqrt3*sin0)) / 3;
 
         // sort the moments from smallest to largest
-        T moment0 = (b + 2*sqrt(p) * cos(delta / 3.0)) / 3.0;
-        T moment1 = (b + 2*sqrt(p) * cos((delta + 2*IGN_PI)/3.0)) / 3.0;
-        T moment2 = (b + 2*sqrt(p) * cos((delta - 2*IGN_PI)/3.0)) / 3.0;
         sort3(moment0, moment1, moment2);
         return Vector3<T>(moment0, moment1, moment2);
       }
@@ -711,7 +719,80 @@ namespace ignition
       /// with MOI = R(q).Transpose() * L * R(q)
       public: Quaternion<T> PrincipalAxesOffset(const T _tol = 1e-6) const
       {
-        Vector3<T> moments = this->PrincipalMoments(_tol);
+        return this->PrincipalAxesOffset(this->PrincipalMoments(_tol), _tol);
+      }
+
+      /// \brief Compute the principal moments of inertia and the
+      /// rotational offset of the principal axes together. This gives the
+      /// same results as PrincipalMoments and PrincipalAxesOffset, but
+      /// computes the principal moments only once.
+      /// \param[out] _moments Principal moments of inertia, see
+      /// PrincipalMoments.
+      /// \param[out] _offset Rotational offset of principal axes, see
+      /// PrincipalAxesOffset.
+      /// \param[in] _tol Relative tolerance given by absolute value
+      /// of _tol, see PrincipalMoments.
+      /// \return False if the offset could not be computed, in which case
+      /// _offset is a zero quaternion.
+      public: bool PrincipalAxes(Vector3<T> &_moments,
+                                 Quaternion<T> &_offset,
+                                 const T _tol = 1e-6) const
+      {
+        _moments = this->PrincipalMoments(_tol);
+        _offset = this->PrincipalAxesOffset(_moments, _tol);
+        return _offset != Quaternion<T>::Zero;
+      }
+
+      /// \brief Compute the principal moments of inertia of many mass
+      /// matrices. Each result is the same as PrincipalMoments(_tol) of
+      /// the corresponding mass matrix.
+      /// \param[in] _matrices Array of _count mass matrices.
+      /// \param[in] _count Number of mass matrices.
+      /// \param[out] _moments Array of at least _count vectors, written
+      /// with the principal moments of each mass matrix.
+      /// \param[in] _tol Relative tolerance, see PrincipalMoments.
+      public: static void PrincipalMoments(const MassMatrix3<T> *_matrices,
+                                           const std::size_t _count,
+                                           Vector3<T> *_moments,
+                                           const T _tol = 1e-6)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _moments[i] = _matrices[i].PrincipalMoments(_tol);
+      }
+
+      /// \brief Verify many mass matrices. Each result is the same as
+      /// IsValid(_tolerance) of the corresponding mass matrix.
+      /// \param[in] _matrices Array of _count mass matrices.
+      /// \param[in] _count Number of mass matrices.
+      /// \param[out] _valid Array of at least _count flags, written with
+      /// the validity of each mass matrix.
+      /// \param[in] _tolerance Tolerance, see IsValid.
+      /// \return True if all the mass matrices are valid.
+      public: static bool IsValid(const MassMatrix3<T> *_matrices,
+                                  const std::size_t _count,
+                                  bool *_valid,
+                                  const T _tolerance =
+                                  IGN_MASSMATRIX3_DEFAULT_TOLERANCE<T>)
+      {
+        bool all = true;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          _valid[i] = _matrices[i].IsValid(_tolerance);
+          all = all && _valid[i];
+        }
+        return all;
+      }
+
+      /// \brief Compute rotational offset of principal axes from the
+      /// principal moments.
+      /// \param[in] _moments Principal moments, as returned by
+      /// PrincipalMoments(_tol).
+      /// \param[in] _tol Relative tolerance, see PrincipalAxesOffset.
+      /// \return Rotational offset of principal axes.
+      private: Quaternion<T> PrincipalAxesOffset(const Vector3<T> &_moments,
+                                                 const T _tol) const
+      {
+        const Vector3<T> &moments = _moments;
         // Compute tolerance relative to maximum value of inertia diagonal
         T tol = _tol * this->Ixxyyzz.Max();
         if (moments.Equal(this->Ixxyyzz, tol) ||
@@ -743,6 +824,9 @@ namespace ignition
         Vector2<T> f1(this->Ixyxzyz[0], -this->Ixyxzyz[1]);
         Vector2<T> f2(this->Ixxyyzz[1] - this->Ixxyyzz[2],
                    -2*this->Ixyxzyz[2]);
+        // Directions of f1 and f2, which are used by every candidate angle
+        const T angleF1 = Angle2(f1, tol);
+        const T angleF2 = Angle2(f2, tol);
 
         // Check if two moments are equal, since different equations are used
         // The moments vector is already sorted, so just check adjacent values.
@@ -780,7 +864,7 @@ namespace ignition
           Vector2<T> g2(momentsDiff3 * s, 0);
           // combining eq 5.12 and 5.14, and subtracting psi2
           // instead of multiplying by its rotation matrix:
-          math::Angle phi12(0.5*(Angle2(g2, tol) - Angle2(f2, tol)));
+          math::Angle phi12(0.5*(Angle2(g2, tol) - angleF2));
           phi12.Normalize();
 
           // The paragraph prior to equation 5.16 describes how to choose
@@ -811,7 +895,7 @@ namespace ignition
             Vector2<T> g1a(0, 0.5*momentsDiff3 * sin(2*phi2));
             // combining eq 5.11 and 5.13, and subtracting psi1
             // instead of multiplying by its rotation matrix:
-            math::Angle phi11a(Angle2(g1a, tol) - Angle2(f1, tol));
+            math::Angle phi11a(Angle2(g1a, tol) - angleF1);
             phi11a.Normalize();
 
             // b: phi2 < 0
@@ -819,16 +903,14 @@ namespace ignition
             Vector2<T> g1b(0, 0.5*momentsDiff3 * sin(-2*phi2));
             // combining eq 5.11 and 5.13, and subtracting psi1
             // instead of multiplying by its rotation matrix:
-            math::Angle phi11b(Angle2(g1b, tol) - Angle2(f1, tol));
+            math::Angle phi11b(Angle2(g1b, tol) - angleF1);
             phi11b.Normalize();
 
             // choose sign of phi2
             // based on whether phi11a or phi11b is closer to phi12
             // use sin and cos to account for angle wrapping
-            T erra = std::pow(sin(phi1) - sin(phi11a.Radian()), 2)
-                   + std::pow(cos(phi1) - cos(phi11a.Radian()), 2);
-            T errb = std::pow(sin(phi1) - sin(phi11b.Radian()), 2)
-                   + std::pow(cos(phi1) - cos(phi11b.Radian()), 2);
+            T erra = AngleError(phi1, phi11a.Radian());
+            T errb = AngleError(phi1, phi11b.Radian());
             if (errb < erra)
             {
               phi2 *= -1;
@@ -914,14 +996,14 @@ namespace ignition
         else if (f1small)
         {
           // use phi12 (equations 5.12, 5.14)
-          math::Angle phi12(0.5*(Angle2(g2, tol) - Angle2(f2, tol)));
+          math::Angle phi12(0.5*(Angle2(g2, tol) - angleF2));
           phi12.Normalize();
           phi1 = phi12.Radian();
         }
         else if (f2small)
         {
           // use phi11 (equations 5.11, 5.13)
-          math::Angle phi11(Angle2(g1, tol) - Angle2(f1, tol));
+          math::Angle phi11(Angle2(g1, tol) - angleF1);
           phi11.Normalize();
           phi1 = phi11.Radian();
         }
@@ -929,25 +1011,23 @@ namespace ignition
         {
           // check for when phi11 == phi12
           // eqs 5.11, 5.13:
-          math::Angle phi11(Angle2(g1, tol) - Angle2(f1, tol));
+          math::Angle phi11(Angle2(g1, tol) - angleF1);
           phi11.Normalize();
           // eqs 5.12, 5.14:
-          math::Angle phi12(0.5*(Angle2(g2, tol) - Angle2(f2, tol)));
+          math::Angle phi12(0.5*(Angle2(g2, tol) - angleF2));
           phi12.Normalize();
-          T err  = std::pow(sin(phi11.Radian()) - sin(phi12.Radian()), 2)
-                 + std::pow(cos(phi11.Radian()) - cos(phi12.Radian()), 2);
+          T err = AngleError(phi11.Radian(), phi12.Radian());
           phi1 = phi11.Radian();
           math::Vector2<T> signsPhi23(1, 1);
           // case a: phi2 <= 0
           {
             Vector2<T> g1a = Vector2<T>(1, -1) * g1;
             Vector2<T> g2a = Vector2<T>(1, -1) * g2;
-            math::Angle phi11a(Angle2(g1a, tol) - Angle2(f1, tol));
-            math::Angle phi12a(0.5*(Angle2(g2a, tol) - Angle2(f2, tol)));
+            math::Angle phi11a(Angle2(g1a, tol) - angleF1);
+            math::Angle phi12a(0.5*(Angle2(g2a, tol) - angleF2));
             phi11a.Normalize();
             phi12a.Normalize();
-            T erra = std::pow(sin(phi11a.Radian()) - sin(phi12a.Radian()), 2)
-                   + std::pow(cos(phi11a.Radian()) - cos(phi12a.Radian()), 2);
+            T erra = AngleError(phi11a.Radian(), phi12a.Radian());
             if (erra < err)
             {
               err = erra;
@@ -959,12 +1039,11 @@ namespace ignition
           {
             Vector2<T> g1b = Vector2<T>(-1, 1) * g1;
             Vector2<T> g2b = Vector2<T>(1, -1) * g2;
-            math::Angle phi11b(Angle2(g1b, tol) - Angle2(f1, tol));
-            math::Angle phi12b(0.5*(Angle2(g2b, tol) - Angle2(f2, tol)));
+            math::Angle phi11b(Angle2(g1b, tol) - angleF1);
+            math::Angle phi12b(0.5*(Angle2(g2b, tol) - angleF2));
             phi11b.Normalize();
             phi12b.Normalize();
-            T errb = std::pow(sin(phi11b.Radian()) - sin(phi12b.Radian()), 2)
-                   + std::pow(cos(phi11b.Radian()) - cos(phi12b.Radian()), 2);
+            T errb = AngleError(phi11b.Radian(), phi12b.Radian());
             if (errb < err)
             {
               err = errb;
@@ -976,12 +1055,11 @@ namespace ignition
           {
             Vector2<T> g1c = Vector2<T>(-1, -1) * g1;
             Vector2<T> g2c = g2;
-            math::Angle phi11c(Angle2(g1c, tol) - Angle2(f1, tol));
-            math::Angle phi12c(0.5*(Angle2(g2c, tol) - Angle2(f2, tol)));
+            math::Angle phi11c(Angle2(g1c, tol) - angleF1);
+            math::Angle phi12c(0.5*(Angle2(g2c, tol) - angleF2));
             phi11c.Normalize();
             phi12c.Normalize();
-            T errc = std::pow(sin(phi11c.Radian()) - sin(phi12c.Radian()), 2)
-                   + std::pow(cos(phi11c.Radian()) - cos(phi12c.Radian()), 2);
+            T errc = AngleError(phi11c.Radian(), phi12c.Radian());
             if (errc < err)
             {
               phi1 = phi11c.Radian();
@@ -1033,7 +1111,7 @@ namespace ignition
         _size.Y(sqrt(6*(moments.Z() + moments.X() - moments.Y()) / this->mass));
         _size.Z(sqrt(6*(moments.X() + moments.Y() - moments.Z()) / this->mass));
 
-        _rot = this->PrincipalAxesOffset(_tol);
+        _rot = this->PrincipalAxesOffset(moments, _tol);
 
         if (_rot == Quaternion<T>::Zero)
         {
@@ -1246,6 +1324,17 @@ namespace ignition
         return sqrt(_x);
       }
 
+      /// \brief Squared distance between the directions of two angles on
+      /// the unit circle, which is
+      /// (sin(_a) - sin(_b))^2 + (cos(_a) - cos(_b))^2 = 2 - 2 cos(_a - _b).
+      /// \param[in] _a First angle.
+      /// \param[in] _b Second angle.
+      /// \return Squared distance, in the range [0, 4].
+      private: static T AngleError(const T _a, const T _b)
+      {
+        return 2 - 2*cos(_a - _b);
+      }
+
       /// \brief Angle formed by direction of a Vector2.
       /// \param[in] _v Vector whose direction is to be computed.
       /// \param[in] _eps Minimum length of vector required for computing angle.
@@ -45,6 +45,11 @@ namespace ignition
     /// found in the Ignition Common library, which was at version 1 at the
     /// time of this writing.
     ///
+    /// Copies of a Material share its properties, and default and
+    /// built-in materials share static properties, so that copying a
+    /// material, or a shape that holds one, does not copy the properties.
+    /// They are copied only when a setter changes shared properties.
+    ///
     /// **How to create a wood material:**
     ///
     /// ~~~
@@ -33,7 +33,7 @@ namespace ignition
     /// Source: https://en.wikipedia.org/wiki/Density
     /// \sa Material
     // Developer Note: When modifying this enum, make sure to also modify
-    // the kMaterials map in src/MaterialTypes.hh.
+    // the kMaterialData table in src/MaterialType.hh.
     enum class MaterialType
     {
       /// \brief Styrofoam, density = 75.0 kg/m^3
@@ -24,6 +24,8 @@
 #include <gz/math/Vector3.hh>
 #include <gz/math/Quaternion.hh>
 #include <gz/math/config.hh>
+#include <gz/math/detail/Cholesky.hh>
+#include <gz/math/detail/SymmetricEigen3.hh>
 
 namespace ignition
 {
@@ -46,17 +48,14 @@ namespace ignition
       public: static const Matrix3<T> Zero;
 
       /// \brief Constructor
-      public: Matrix3()
+      public: constexpr Matrix3()
+      : data{{0, 0, 0}, {0, 0, 0}, {0, 0, 0}}
       {
-        std::memset(this->data, 0, sizeof(this->data[0][0])*9);
       }
 
       /// \brief Copy constructor
       /// \param _m Matrix to copy
-      public: Matrix3(const Matrix3<T> &_m)
-      {
-        std::memcpy(this->data, _m.data, sizeof(this->data[0][0])*9);
-      }
+      public: constexpr Matrix3(const Matrix3<T> &_m) = default;
 
       /// \brief Constructor
       /// \param[in] _v00 Row 0, Col 0 value
@@ -68,19 +67,13 @@ namespace ignition
       /// \param[in] _v20 Row 2, Col 0 value
       /// \param[in] _v21 Row 2, Col 1 value
       /// \param[in] _v22 Row 2, Col 2 value
-      public: Matrix3(T _v00, T _v01, T _v02,
-                      T _v10, T _v11, T _v12,
-                      T _v20, T _v21, T _v22)
+      public: constexpr Matrix3(T _v00, T _v01, T _v02,
+                                T _v10, T _v11, T _v12,
+                                T _v20, T _v21, T _v22)
+      : data{{_v00, _v01, _v02},
+             {_v10, _v11, _v12},
+             {_v20, _v21, _v22}}
       {
-        this->data[0][0] = _v00;
-        this->data[0][1] = _v01;
-        this->data[0][2] = _v02;
-        this->data[1][0] = _v10;
-        this->data[1][1] = _v11;
-        this->data[1][2] = _v12;
-        this->data[2][0] = _v20;
-        this->data[2][1] = _v21;
-        this->data[2][2] = _v22;
       }
 
       /// \brief Construct Matrix3 from a quaternion.
@@ -101,7 +94,7 @@ namespace ignition
       }
 
       /// \brief Desctructor
-      public: virtual ~Matrix3() {}
+      public: virtual ~Matrix3() = default;
 
       /// \brief Set values
       /// \param[in] _v00 Row 0, Col 0 value
@@ -113,9 +106,9 @@ namespace ignition
       /// \param[in] _v20 Row 2, Col 0 value
       /// \param[in] _v21 Row 2, Col 1 value
       /// \param[in] _v22 Row 2, Col 2 value
-      public: void Set(T _v00, T _v01, T _v02,
-                       T _v10, T _v11, T _v12,
-                       T _v20, T _v21, T _v22)
+      public: constexpr void Set(T _v00, T _v01, T _v02,
+                                 T _v10, T _v11, T _v12,
+                                 T _v20, T _v21, T _v22)
       {
         this->data[0][0] = _v00;
         this->data[0][1] = _v01;
@@ -132,9 +125,9 @@ namespace ignition
       /// \param[in] _xAxis The x axis
       /// \param[in] _yAxis The y axis
       /// \param[in] _zAxis The z axis
-      public: void Axes(const Vector3<T> &_xAxis,
-                        const Vector3<T> &_yAxis,
-                        const Vector3<T> &_zAxis)
+      public: constexpr void Axes(const Vector3<T> &_xAxis,
+                                  const Vector3<T> &_yAxis,
+                                  const Vector3<T> &_zAxis)
       {
         this->Col(0, _xAxis);
         this->Col(1, _yAxis);
@@ -210,7 +203,7 @@ namespace ignition
       /// \param[in] _c The colum index [0, 1, 2]. _col is clamped to the
       /// range [0, 2].
       /// \param[in] _v The value to set in each row of the column.
-      public: void Col(unsigned int _c, const Vector3<T> &_v)
+      public: constexpr void Col(unsigned int _c, const Vector3<T> &_v)
       {
         unsigned int c = clamp(_c, 0u, 2u);
 
@@ -222,14 +215,11 @@ namespace ignition
       /// \brief Equal operator. this = _mat
       /// \param _mat Incoming matrix
       /// \return itself
-      public: Matrix3<T> &operator=(const Matrix3<T> &_mat)
-      {
-        memcpy(this->data, _mat.data, sizeof(this->data[0][0])*9);
-        return *this;
-      }
+      public: constexpr Matrix3<T> &operator=(const Matrix3<T> &_mat)
+          = default;
 
       /// \brief returns the element wise difference of two matrices
-      public: Matrix3<T> operator-(const Matrix3<T> &_m) const
+      public: constexpr Matrix3<T> operator-(const Matrix3<T> &_m) const
       {
         return Matrix3<T>(
             this->data[0][0] - _m(0, 0),
@@ -244,7 +234,7 @@ namespace ignition
       }
 
       /// \brief returns the element wise sum of two matrices
-      public: Matrix3<T> operator+(const Matrix3<T> &_m) const
+      public: constexpr Matrix3<T> operator+(const Matrix3<T> &_m) const
       {
         return Matrix3<T>(
             this->data[0][0]+_m(0, 0),
@@ -259,7 +249,7 @@ namespace ignition
       }
 
       /// \brief returns the element wise scalar multiplication
-      public: Matrix3<T> operator*(const T &_s) const
+      public: constexpr Matrix3<T> operator*(const T &_s) const
       {
         return Matrix3<T>(
           _s * this->data[0][0], _s * this->data[0][1], _s * this->data[0][2],
@@ -270,7 +260,7 @@ namespace ignition
       /// \brief Matrix multiplication operator
       /// \param[in] _m Matrix3<T> to multiply
       /// \return product of this * _m
-      public: Matrix3<T> operator*(const Matrix3<T> &_m) const
+      public: constexpr Matrix3<T> operator*(const Matrix3<T> &_m) const
       {
         return Matrix3<T>(
             // first row
@@ -317,7 +307,7 @@ namespace ignition
       /// treated like a column vector.
       /// \param _vec Vector3
       /// \return Resulting vector from multiplication
-      public: Vector3<T> operator*(const Vector3<T> &_vec) const
+      public: constexpr Vector3<T> operator*(const Vector3<T> &_vec) const
       {
         return Vector3<T>(
             this->data[0][0]*_vec.X() + this->data[0][1]*_vec.Y() +
@@ -332,7 +322,7 @@ namespace ignition
       /// \param[in] _s Scaling factor.
       /// \param[in] _m Input matrix.
       /// \return A scaled matrix.
-      public: friend inline Matrix3<T> operator*(T _s, const Matrix3<T> &_m)
+      public: friend constexpr Matrix3<T> operator*(T _s, const Matrix3<T> &_m)
       {
         return _m * _s;
       }
@@ -343,8 +333,8 @@ namespace ignition
       /// \param[in] _v Input vector.
       /// \param[in] _m Input matrix.
       /// \return The product vector.
-      public: friend inline Vector3<T> operator*(const Vector3<T> &_v,
-                                                 const Matrix3<T> &_m)
+      public: friend constexpr Vector3<T> operator*(const Vector3<T> &_v,
+                                                    const Matrix3<T> &_m)
       {
         return Vector3<T>(
             _m(0, 0)*_v.X() + _m(1, 0)*_v.Y() + _m(2, 0)*_v.Z(),
@@ -398,7 +388,7 @@ namespace ignition
       /// \param[in] _row row index. _row is clamped to the range [0,2]
       /// \param[in] _col column index. _col is clamped to the range [0,2]
       /// \return a pointer to the row
-      public: inline const T &operator()(size_t _row, size_t _col) const
+      public: constexpr const T &operator()(size_t _row, size_t _col) const
       {
         return this->data[clamp(_row, IGN_ZERO_SIZE_T, IGN_TWO_SIZE_T)]
                          [clamp(_col, IGN_ZERO_SIZE_T, IGN_TWO_SIZE_T)];
@@ -408,7 +398,7 @@ namespace ignition
       /// \param[in] _row row index. _row is clamped to the range [0,2]
       /// \param[in] _col column index. _col is clamped to the range [0,2]
       /// \return a pointer to the row
-      public: inline T &operator()(size_t _row, size_t _col)
+      public: constexpr T &operator()(size_t _row, size_t _col)
       {
         return this->data[clamp(_row, IGN_ZERO_SIZE_T, IGN_TWO_SIZE_T)]
                          [clamp(_col, IGN_ZERO_SIZE_T, IGN_TWO_SIZE_T)];
@@ -416,7 +406,7 @@ namespace ignition
 
       /// \brief Return the determinant of the matrix
       /// \return Determinant of this matrix.
-      public: T Determinant() const
+      public: constexpr T Determinant() const
       {
         T t0 = this->data[2][2]*this->data[1][1]
              - this->data[2][1]*this->data[1][2];
@@ -434,7 +424,7 @@ namespace ignition
 
       /// \brief Return the inverse matrix
       /// \return Inverse of this matrix.
-      public: Matrix3<T> Inverse() const
+      public: constexpr Matrix3<T> Inverse() const
       {
         T t0 = this->data[2][2]*this->data[1][1] -
                     this->data[2][1]*this->data[1][2];
@@ -467,6 +457,79 @@ namespace ignition
              this->data[1][0] * this->data[0][1]));
       }
 
+      /// \brief Compute the eigenvalues and eigenvectors of a symmetric
+      /// matrix, such as an inertia or covariance matrix. Only the upper
+      /// triangle is read. The solution is in closed form, and remains
+      /// accurate for repeated eigenvalues.
+      /// \param[out] _values Eigenvalues, from smallest to largest.
+      /// \param[out] _vectors Rotation matrix whose columns are the unit
+      /// eigenvectors, in the order of _values, so that this matrix is
+      /// _vectors * diag(_values) * _vectors.Transposed().
+      /// \sa Matrix3SoA::SymmetricEigen for many matrices.
+      public: void SymmetricEigen(Vector3<T> &_values,
+                                  Matrix3<T> &_vectors) const
+      {
+        const T a[6] = {this->data[0][0], this->data[0][1], this->data[0][2],
+                        this->data[1][1], this->data[1][2], this->data[2][2]};
+        T values[3];
+        detail::SymmetricEigen3(a, values, &_vectors.data[0][0]);
+        _values.Set(values[0], values[1], values[2]);
+      }
+
+      /// \brief Replace the lower triangle of this symmetric positive
+      /// definite matrix, such as an inertia matrix, by its Cholesky factor
+      /// L, such that the matrix is L L^T. CholeskySolve then solves
+      /// systems with the matrix in fewer operations than the Inverse
+      /// takes, and more accurately. Only the lower triangle is read, and
+      /// the upper triangle is left unchanged.
+      /// \param[in] _tolerance Pivots must be greater than this fraction of
+      /// the largest diagonal element, which rejects nearly singular
+      /// matrices.
+      /// \return False if the matrix is not positive definite or not
+      /// finite. The lower triangle is then partially factored.
+      /// \sa Matrix3SoA::CholeskySolve for many matrices.
+      public: bool CholeskyFactor(const T _tolerance = 0)
+      {
+        return detail::CholeskyFactor<3>(&this->data[0][0], _tolerance);
+      }
+
+      /// \brief Solve this * x = _b, once CholeskyFactor has succeeded.
+      /// \param[in] _b Right hand side.
+      /// \return The solution x.
+      public: Vector3<T> CholeskySolve(const Vector3<T> &_b) const
+      {
+        T x[3] = {_b.X(), _b.Y(), _b.Z()};
+        detail::CholeskySolve<3>(&this->data[0][0], x);
+        return Vector3<T>(x[0], x[1], x[2]);
+      }
+
+      /// \brief Replace the lower triangle of this symmetric matrix by its
+      /// LDL^T factorization, without pivoting: the strictly lower triangle
+      /// holds the unit lower triangular L, and the diagonal holds D.
+      /// Unlike CholeskyFactor it takes no square roots, and also factors
+      /// indefinite matrices whose leading minors are not singular. Only
+      /// the lower triangle is read, and the upper triangle is left
+      /// unchanged.
+      /// \param[in] _tolerance Pivots must have a magnitude greater than
+      /// this fraction of the largest diagonal magnitude.
+      /// \return False if a pivot is zero, below the tolerance, or not
+      /// finite. The lower triangle is then partially factored.
+      /// \sa Matrix3SoA::LdltSolve for many matrices.
+      public: bool LdltFactor(const T _tolerance = 0)
+      {
+        return detail::LdltFactor<3>(&this->data[0][0], _tolerance);
+      }
+
+      /// \brief Solve this * x = _b, once LdltFactor has succeeded.
+      /// \param[in] _b Right hand side.
+      /// \return The solution x.
+      public: Vector3<T> LdltSolve(const Vector3<T> &_b) const
+      {
+        T x[3] = {_b.X(), _b.Y(), _b.Z()};
+        detail::LdltSolve<3>(&this->data[0][0], x);
+        return Vector3<T>(x[0], x[1], x[2]);
+      }
+
       /// \brief Transpose this matrix.
       public: void Transpose()
       {
@@ -477,7 +540,7 @@ namespace ignition
 
       /// \brief Return the transpose of this matrix
       /// \return Transpose of this matrix.
-      public: Matrix3<T> Transposed() const
+      public: constexpr Matrix3<T> Transposed() const
       {
         return Matrix3<T>(
           this->data[0][0], this->data[1][0], this->data[2][0],
@@ -0,0 +1,446 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_MATRIX3SOA_HH_
+#define GZ_MATH_MATRIX3SOA_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Vector3SoA.hh>
+#include <gz/math/config.hh>
+#include <gz/math/detail/SymmetricEigen3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Matrix3SoA Matrix3SoA.hh ignition/math/Matrix3SoA.hh
+    /// \brief A structure-of-arrays container of 3x3 matrices.
+    ///
+    /// Like Vector3SoA, each of the nine elements is kept in its own
+    /// contiguous array, so that Determinant, Inverse and Multiply run as
+    /// plain loops that compilers auto-vectorize. SymmetricEigen
+    /// diagonalizes many symmetric matrices, such as the covariances of
+    /// the neighborhoods of every point of a cloud.
+    ///
+    /// Individual elements can be read and written as Matrix3<T>, and the
+    /// arrays are exposed through Data().
+    template<typename T>
+    class Matrix3SoA
+    {
+      /// \brief Default constructor, creates an empty container.
+      public: Matrix3SoA() = default;
+
+      /// \brief Constructor, creates _size identity matrices.
+      /// \param[in] _size Number of elements.
+      public: explicit Matrix3SoA(const std::size_t _size)
+      {
+        this->Resize(_size);
+      }
+
+      /// \brief Constructor from an array of Matrix3.
+      /// \param[in] _m Matrices to copy.
+      public: explicit Matrix3SoA(const std::vector<Matrix3<T>> &_m)
+      {
+        this->Assign(_m);
+      }
+
+      /// \brief Replace the contents with a copy of an array of Matrix3.
+      /// \param[in] _m Matrices to copy.
+      public: void Assign(const std::vector<Matrix3<T>> &_m)
+      {
+        this->Resize(_m.size());
+        for (std::size_t i = 0; i < _m.size(); ++i)
+          this->Set(i, _m[i]);
+      }
+
+      /// \brief Copy the contents into an array of Matrix3.
+      /// \param[out] _m Destination, resized to Size().
+      public: void CopyTo(std::vector<Matrix3<T>> &_m) const
+      {
+        _m.resize(this->Size());
+        for (std::size_t i = 0; i < this->Size(); ++i)
+          _m[i] = (*this)[i];
+      }
+
+      /// \brief Get the contents as an array of Matrix3.
+      /// \return A copy of the elements.
+      public: std::vector<Matrix3<T>> ToVector() const
+      {
+        std::vector<Matrix3<T>> result;
+        this->CopyTo(result);
+        return result;
+      }
+
+      /// \brief Get the number of elements.
+      /// \return Number of elements.
+      public: std::size_t Size() const
+      {
+        return this->data[0].size();
+      }
+
+      /// \brief Check if the container is empty.
+      /// \return True if there are no elements.
+      public: bool Empty() const
+      {
+        return this->data[0].empty();
+      }
+
+      /// \brief Change the number of elements. New elements are identity
+      /// matrices.
+      /// \param[in] _size New number of elements.
+      public: void Resize(const std::size_t _size)
+      {
+        for (std::size_t k = 0; k < 9; ++k)
+          this->data[k].resize(_size, (k % 4 == 0) ? T(1) : T(0));
+      }
+
+      /// \brief Reserve storage for a number of elements.
+      /// \param[in] _size Number of elements to reserve.
+      public: void Reserve(const std::size_t _size)
+      {
+        for (auto &array : this->data)
+          array.reserve(_size);
+      }
+
+      /// \brief Remove all the elements.
+      public: void Clear()
+      {
+        for (auto &array : this->data)
+          array.clear();
+      }
+
+      /// \brief Append an element.
+      /// \param[in] _m Matrix to append.
+      public: void PushBack(const Matrix3<T> &_m)
+      {
+        for (std::size_t k = 0; k < 9; ++k)
+          this->data[k].push_back(_m(k / 3, k % 3));
+      }
+
+      /// \brief Get an element.
+      /// \param[in] _index Index of the element, must be lower than Size().
+      /// \return A copy of the element.
+      public: Matrix3<T> operator[](const std::size_t _index) const
+      {
+        const std::size_t i = _index;
+        return Matrix3<T>(
+            this->data[0][i], this->data[1][i], this->data[2][i],
+            this->data[3][i], this->data[4][i], this->data[5][i],
+            this->data[6][i], this->data[7][i], this->data[8][i]);
+      }
+
+      /// \brief Set an element.
+      /// \param[in] _index Index of the element, must be lower than Size().
+      /// \param[in] _m New value.
+      public: void Set(const std::size_t _index, const Matrix3<T> &_m)
+      {
+        for (std::size_t k = 0; k < 9; ++k)
+          this->data[k][_index] = _m(k / 3, k % 3);
+      }
+
+      /// \brief Get the array of one matrix element.
+      /// \param[in] _row Row of the element, lower than 3.
+      /// \param[in] _col Column of the element, lower than 3.
+      /// \return Pointer to the Size() contiguous values of the element.
+      public: T *Data(const std::size_t _row, const std::size_t _col)
+      {
+        return this->data[_row * 3 + _col].data();
+      }
+
+      /// \brief Get the array of one matrix element.
+      /// \param[in] _row Row of the element, lower than 3.
+      /// \param[in] _col Column of the element, lower than 3.
+      /// \return Pointer to the Size() contiguous values of the element.
+      public: const T *Data(const std::size_t _row,
+                            const std::size_t _col) const
+      {
+        return this->data[_row * 3 + _col].data();
+      }
+
+      /// \brief Compute the determinant of every element, as
+      /// Matrix3::Determinant.
+      /// \param[out] _out Determinants, resized to Size().
+      public: void Determinant(std::vector<T> &_out) const
+      {
+        const std::size_t n = this->Size();
+        _out.resize(n);
+        const T *m00 = this->Data(0, 0), *m01 = this->Data(0, 1),
+                *m02 = this->Data(0, 2), *m10 = this->Data(1, 0),
+                *m11 = this->Data(1, 1), *m12 = this->Data(1, 2),
+                *m20 = this->Data(2, 0), *m21 = this->Data(2, 1),
+                *m22 = this->Data(2, 2);
+        T *out = _out.data();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          out[i] = (m22[i] * m11[i] - m21[i] * m12[i]) * m00[i]
+                 - (m22[i] * m10[i] - m20[i] * m12[i]) * m01[i]
+                 + (m21[i] * m10[i] - m20[i] * m11[i]) * m02[i];
+        }
+      }
+
+      /// \brief Compute the inverse of every element, as Matrix3::Inverse.
+      /// Singular matrices give non-finite elements.
+      /// \param[out] _out Inverses, resized to Size(). It may be this
+      /// container.
+      public: void Inverse(Matrix3SoA<T> &_out) const
+      {
+        const std::size_t n = this->Size();
+        _out.Resize(n);
+        const T *m00 = this->Data(0, 0), *m01 = this->Data(0, 1),
+                *m02 = this->Data(0, 2), *m10 = this->Data(1, 0),
+                *m11 = this->Data(1, 1), *m12 = this->Data(1, 2),
+                *m20 = this->Data(2, 0), *m21 = this->Data(2, 1),
+                *m22 = this->Data(2, 2);
+
+        T r[9][kBlockSize];
+        ForEachBlock(n, [&](const std::size_t _start, const auto _m)
+        {
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            // Cofactors of the first column
+            const T t0 = m22[i] * m11[i] - m21[i] * m12[i];
+            const T t1 = m20[i] * m12[i] - m22[i] * m10[i];
+            const T t2 = m21[i] * m10[i] - m20[i] * m11[i];
+            const T invDet = T(1) / (t0 * m00[i] + t1 * m01[i] +
+                                     t2 * m02[i]);
+            r[0][j] = invDet * t0;
+            r[1][j] = invDet * (m21[i] * m02[i] - m22[i] * m01[i]);
+            r[2][j] = invDet * (m12[i] * m01[i] - m11[i] * m02[i]);
+            r[3][j] = invDet * t1;
+            r[4][j] = invDet * (m22[i] * m00[i] - m20[i] * m02[i]);
+            r[5][j] = invDet * (m10[i] * m02[i] - m12[i] * m00[i]);
+            r[6][j] = invDet * t2;
+            r[7][j] = invDet * (m20[i] * m01[i] - m21[i] * m00[i]);
+            r[8][j] = invDet * (m11[i] * m00[i] - m10[i] * m01[i]);
+          }
+          for (std::size_t k = 0; k < 9; ++k)
+            std::copy(r[k], r[k] + _m, _out.data[k].data() + _start);
+        });
+      }
+
+      /// \brief Multiply every vector by the matching matrix,
+      /// _out[i] = this[i] * _v[i].
+      /// \param[in] _v Vectors, must have the same size.
+      /// \param[out] _out Products, resized to Size(). It may alias _v.
+      public: void Multiply(const Vector3SoA<T> &_v,
+                            Vector3SoA<T> &_out) const
+      {
+        const std::size_t n = this->Size();
+        _out.Resize(n);
+        const T *m00 = this->Data(0, 0), *m01 = this->Data(0, 1),
+                *m02 = this->Data(0, 2), *m10 = this->Data(1, 0),
+                *m11 = this->Data(1, 1), *m12 = this->Data(1, 2),
+                *m20 = this->Data(2, 0), *m21 = this->Data(2, 1),
+                *m22 = this->Data(2, 2);
+        const T *vx = _v.XData(), *vy = _v.YData(), *vz = _v.ZData();
+        T *ox = _out.XData(), *oy = _out.YData(), *oz = _out.ZData();
+
+        T rx[kBlockSize], ry[kBlockSize], rz[kBlockSize];
+        ForEachBlock(n, [&](const std::size_t _start, const auto _m)
+        {
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            rx[j] = m00[i] * vx[i] + m01[i] * vy[i] + m02[i] * vz[i];
+            ry[j] = m10[i] * vx[i] + m11[i] * vy[i] + m12[i] * vz[i];
+            rz[j] = m20[i] * vx[i] + m21[i] * vy[i] + m22[i] * vz[i];
+          }
+          std::copy(rx, rx + _m, ox + _start);
+          std::copy(ry, ry + _m, oy + _start);
+          std::copy(rz, rz + _m, oz + _start);
+        });
+      }
+
+      /// \brief Solve this[i] * _x[i] = _b[i] for every element, whose
+      /// matrices are symmetric positive definite, with a Cholesky
+      /// factorization as Matrix3::CholeskySolve. Only the lower triangles
+      /// are read. Matrices that are not positive definite give
+      /// non-finite solutions.
+      /// \param[in] _b Right hand sides, must have the same size.
+      /// \param[out] _x Solutions, resized to Size(). It may alias _b.
+      public: void CholeskySolve(const Vector3SoA<T> &_b,
+                                 Vector3SoA<T> &_x) const
+      {
+        const std::size_t n = this->Size();
+        _x.Resize(n);
+        const T *m00 = this->Data(0, 0), *m10 = this->Data(1, 0),
+                *m11 = this->Data(1, 1), *m20 = this->Data(2, 0),
+                *m21 = this->Data(2, 1), *m22 = this->Data(2, 2);
+        const T *bx = _b.XData(), *by = _b.YData(), *bz = _b.ZData();
+        T *ox = _x.XData(), *oy = _x.YData(), *oz = _x.ZData();
+
+        T rx[kBlockSize], ry[kBlockSize], rz[kBlockSize];
+        ForEachBlock(n, [&](const std::size_t _start, const auto _m)
+        {
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            // Inverse diagonal and lower triangle of the factor
+            const T d0 = T(1) / std::sqrt(m00[i]);
+            const T l10 = m10[i] * d0;
+            const T l20 = m20[i] * d0;
+            const T d1 = T(1) / std::sqrt(m11[i] - l10 * l10);
+            const T l21 = (m21[i] - l20 * l10) * d1;
+            const T d2 = T(1) / std::sqrt(m22[i] - l20 * l20 - l21 * l21);
+            const T y0 = bx[i] * d0;
+            const T y1 = (by[i] - l10 * y0) * d1;
+            const T y2 = (bz[i] - l20 * y0 - l21 * y1) * d2;
+            rz[j] = y2 * d2;
+            ry[j] = (y1 - l21 * rz[j]) * d1;
+            rx[j] = (y0 - l10 * ry[j] - l20 * rz[j]) * d0;
+          }
+          std::copy(rx, rx + _m, ox + _start);
+          std::copy(ry, ry + _m, oy + _start);
+          std::copy(rz, rz + _m, oz + _start);
+        });
+      }
+
+      /// \brief Solve this[i] * _x[i] = _b[i] for every element, whose
+      /// matrices are symmetric, with an LDL^T factorization as
+      /// Matrix3::LdltSolve. Only the lower triangles are read. Matrices
+      /// with a singular leading minor give non-finite solutions.
+      /// \param[in] _b Right hand sides, must have the same size.
+      /// \param[out] _x Solutions, resized to Size(). It may alias _b.
+      public: void LdltSolve(const Vector3SoA<T> &_b,
+                             Vector3SoA<T> &_x) const
+      {
+        const std::size_t n = this->Size();
+        _x.Resize(n);
+        const T *m00 = this->Data(0, 0), *m10 = this->Data(1, 0),
+                *m11 = this->Data(1, 1), *m20 = this->Data(2, 0),
+                *m21 = this->Data(2, 1), *m22 = this->Data(2, 2);
+        const T *bx = _b.XData(), *by = _b.YData(), *bz = _b.ZData();
+        T *ox = _x.XData(), *oy = _x.YData(), *oz = _x.ZData();
+
+        T rx[kBlockSize], ry[kBlockSize], rz[kBlockSize];
+        ForEachBlock(n, [&](const std::size_t _start, const auto _m)
+        {
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            const T d0 = m00[i];
+            const T l10 = m10[i] / d0;
+            const T l20 = m20[i] / d0;
+            const T d1 = m11[i] - l10 * m10[i];
+            const T l21 = (m21[i] - l20 * m10[i]) / d1;
+            const T d2 = m22[i] - l20 * m20[i] - l21 * l21 * d1;
+            const T y0 = bx[i];
+            const T y1 = by[i] - l10 * y0;
+            const T y2 = bz[i] - l20 * y0 - l21 * y1;
+            rz[j] = y2 / d2;
+            ry[j] = y1 / d1 - l21 * rz[j];
+            rx[j] = y0 / d0 - l10 * ry[j] - l20 * rz[j];
+          }
+          std::copy(rx, rx + _m, ox + _start);
+          std::copy(ry, ry + _m, oy + _start);
+          std::copy(rz, rz + _m, oz + _start);
+        });
+      }
+
+      /// \brief Compute the eigenvalues and eigenvectors of every element,
+      /// as Matrix3::SymmetricEigen. Only the upper triangles are read.
+      /// \param[out] _values Eigenvalues of each element, from smallest to
+      /// largest, resized to Size().
+      /// \param[out] _vectors Eigenvectors of each element, as the columns
+      /// of a rotation matrix, resized to Size(). It may be this container.
+      public: void SymmetricEigen(Vector3SoA<T> &_values,
+                                  Matrix3SoA<T> &_vectors) const
+      {
+        const std::size_t n = this->Size();
+        _values.Resize(n);
+        _vectors.Resize(n);
+        const T *m00 = this->Data(0, 0), *m01 = this->Data(0, 1),
+                *m02 = this->Data(0, 2), *m11 = this->Data(1, 1),
+                *m12 = this->Data(1, 2), *m22 = this->Data(2, 2);
+        T *lx = _values.XData(), *ly = _values.YData(),
+          *lz = _values.ZData();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          const T a[6] = {m00[i], m01[i], m02[i], m11[i], m12[i], m22[i]};
+          T values[3];
+          T vectors[9];
+          detail::SymmetricEigen3(a, values, vectors);
+          lx[i] = values[0];
+          ly[i] = values[1];
+          lz[i] = values[2];
+          for (std::size_t k = 0; k < 9; ++k)
+            _vectors.data[k][i] = vectors[k];
+        }
+      }
+
+      /// \brief Equality operator.
+      /// \param[in] _m Container to compare with.
+      /// \return True if both containers hold the same elements, using the
+      /// same tolerance as Matrix3::operator==.
+      public: bool operator==(const Matrix3SoA<T> &_m) const
+      {
+        if (this->Size() != _m.Size())
+          return false;
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          if ((*this)[i] != _m[i])
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _m Container to compare with.
+      /// \return True if the containers differ.
+      public: bool operator!=(const Matrix3SoA<T> &_m) const
+      {
+        return !(*this == _m);
+      }
+
+      /// \brief Call a function on consecutive blocks of at most kBlockSize
+      /// elements, computed into local arrays and then copied to the
+      /// output, as in QuaternionSoA.
+      /// \param[in] _n Number of elements.
+      /// \param[in] _fn Function called with the index of the first
+      /// element of a block and the size of the block.
+      private: template<typename F>
+               static void ForEachBlock(const std::size_t _n, F &&_fn)
+      {
+        std::size_t start = 0;
+        for (; start + kBlockSize <= _n; start += kBlockSize)
+          _fn(start, std::integral_constant<std::size_t, kBlockSize>());
+        if (start < _n)
+          _fn(start, _n - start);
+      }
+
+      /// \brief Number of elements processed per local block.
+      private: static constexpr std::size_t kBlockSize = 64;
+
+      /// \brief Element arrays, in row-major order.
+      private: std::vector<T> data[9];
+    };
+
+    typedef Matrix3SoA<double> Matrix3SoAd;
+    typedef Matrix3SoA<float> Matrix3SoAf;
+    }
+  }
+}
+#endif
@@ -18,12 +18,16 @@
 #define GZ_MATH_MATRIX4_HH_
 
 #include <algorithm>
+#include <cstdint>
 #include <utility>
+#include <vector>
 #include <gz/math/Helpers.hh>
 #include <gz/math/Matrix3.hh>
 #include <gz/math/Vector3.hh>
+#include <gz/math/Vector3SoA.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/config.hh>
+#include <gz/math/detail/Matrix4Simd.hh>
 
 namespace ignition
 {
@@ -32,6 +36,30 @@ namespace ignition
     // Inline bracket to help doxygen filtering.
     inline namespace IGNITION_MATH_VERSION_NAMESPACE {
     //
+    /// \enum ClipCode
+    /// \brief Bits of the clip codes computed by Matrix4::Project, one for
+    /// each plane of the view volume that a point is outside of.
+    enum ClipCode : uint8_t
+    {
+      /// \brief Left of the view volume, x < -w.
+      CLIP_LEFT = 1,
+
+      /// \brief Right of the view volume, x > w.
+      CLIP_RIGHT = 2,
+
+      /// \brief Below the view volume, y < -w.
+      CLIP_BOTTOM = 4,
+
+      /// \brief Above the view volume, y > w.
+      CLIP_TOP = 8,
+
+      /// \brief In front of the near plane, z < -w.
+      CLIP_NEAR = 16,
+
+      /// \brief Beyond the far plane, z > w.
+      CLIP_FAR = 32
+    };
+
     /// \class Matrix4 Matrix4.hh ignition/math/Matrix4.hh
     /// \brief A 4x4 matrix class
     template<typename T>
@@ -477,12 +505,17 @@ namespace ignition
 
       /// \brief Return the inverse matrix.
       /// This is a non-destructive operation.
+      /// On SSE2 capable targets the float version uses a vectorized
+      /// kernel.
       /// \return Inverse of this matrix.
       public: Matrix4<T> Inverse() const
       {
         T v0, v1, v2, v3, v4, v5, t00, t10, t20, t30;
         Matrix4<T> r;
 
+        if (detail::Matrix4InverseSimd(&this->data[0][0], &r.data[0][0]))
+          return r;
+
         v0 = this->data[2][0]*this->data[3][1] -
           this->data[2][1]*this->data[3][0];
         v1 = this->data[2][0]*this->data[3][2] -
@@ -569,6 +602,57 @@ namespace ignition
         return r;
       }
 
+      /// \brief Return the inverse of a rigid transform, such as a matrix
+      /// built from a Pose3: the upper left 3x3 block must be a rotation
+      /// and the last row must be [0 0 0 1]. The inverse is the transpose
+      /// R^T of the rotation with the translation -R^T t, which takes
+      /// about a fifth of the operations of Inverse(). Other matrices give
+      /// a wrong result; use InverseAffine() for affine matrices with
+      /// scale or shear.
+      /// \return Inverse of this matrix.
+      public: Matrix4<T> InverseRigid() const
+      {
+        Matrix4<T> r;
+        for (int i = 0; i < 3; ++i)
+        {
+          r.data[i][0] = this->data[0][i];
+          r.data[i][1] = this->data[1][i];
+          r.data[i][2] = this->data[2][i];
+          r.data[i][3] = -(this->data[0][i] * this->data[0][3] +
+                           this->data[1][i] * this->data[1][3] +
+                           this->data[2][i] * this->data[2][3]);
+        }
+        r.data[3][3] = 1;
+        return r;
+      }
+
+      /// \brief Return the inverse of an affine matrix, whose last row is
+      /// [0 0 0 1] as checked by IsAffine(). The inverse is built from the
+      /// inverse A^-1 of the upper left 3x3 block, with the translation
+      /// -A^-1 t, which takes about half the operations of Inverse().
+      /// Singular matrices give infinite or NaN values, as with Inverse().
+      /// \return Inverse of this matrix.
+      public: Matrix4<T> InverseAffine() const
+      {
+        const Matrix3<T> inv = Matrix3<T>(
+            this->data[0][0], this->data[0][1], this->data[0][2],
+            this->data[1][0], this->data[1][1], this->data[1][2],
+            this->data[2][0], this->data[2][1], this->data[2][2]).Inverse();
+
+        Matrix4<T> r;
+        for (int i = 0; i < 3; ++i)
+        {
+          r.data[i][0] = inv(i, 0);
+          r.data[i][1] = inv(i, 1);
+          r.data[i][2] = inv(i, 2);
+          r.data[i][3] = -(inv(i, 0) * this->data[0][3] +
+                           inv(i, 1) * this->data[1][3] +
+                           inv(i, 2) * this->data[2][3]);
+        }
+        r.data[3][3] = 1;
+        return r;
+      }
+
       /// \brief Transpose this matrix.
       public: void Transpose()
       {
@@ -630,91 +714,19 @@ namespace ignition
         return *this;
       }
 
-      /// \brief Multiplication operator
+      /// \brief Multiplication operator.
+      /// The float and double versions use SSE/AVX or NEON kernels when the
+      /// target supports them, see detail/Matrix4Simd.hh.
       /// \param[in] _m2 Incoming matrix
       /// \return This matrix * _mat
       public: Matrix4<T> operator*(const Matrix4<T> &_m2) const
       {
-        return Matrix4<T>(
-          this->data[0][0] * _m2(0, 0) +
-          this->data[0][1] * _m2(1, 0) +
-          this->data[0][2] * _m2(2, 0) +
-          this->data[0][3] * _m2(3, 0),
-
-          this->data[0][0] * _m2(0, 1) +
-          this->data[0][1] * _m2(1, 1) +
-          this->data[0][2] * _m2(2, 1) +
-          this->data[0][3] * _m2(3, 1),
-
-          this->data[0][0] * _m2(0, 2) +
-          this->data[0][1] * _m2(1, 2) +
-          this->data[0][2] * _m2(2, 2) +
-          this->data[0][3] * _m2(3, 2),
-
-          this->data[0][0] * _m2(0, 3) +
-          this->data[0][1] * _m2(1, 3) +
-          this->data[0][2] * _m2(2, 3) +
-          this->data[0][3] * _m2(3, 3),
-
-          this->data[1][0] * _m2(0, 0) +
-          this->data[1][1] * _m2(1, 0) +
-          this->data[1][2] * _m2(2, 0) +
-          this->data[1][3] * _m2(3, 0),
-
-          this->data[1][0] * _m2(0, 1) +
-          this->data[1][1] * _m2(1, 1) +
-          this->data[1][2] * _m2(2, 1) +
-          this->data[1][3] * _m2(3, 1),
-
-          this->data[1][0] * _m2(0, 2) +
-          this->data[1][1] * _m2(1, 2) +
-          this->data[1][2] * _m2(2, 2) +
-          this->data[1][3] * _m2(3, 2),
-
-          this->data[1][0] * _m2(0, 3) +
-          this->data[1][1] * _m2(1, 3) +
-          this->data[1][2] * _m2(2, 3) +
-          this->data[1][3] * _m2(3, 3),
-
-          this->data[2][0] * _m2(0, 0) +
-          this->data[2][1] * _m2(1, 0) +
-          this->data[2][2] * _m2(2, 0) +
-          this->data[2][3] * _m2(3, 0),
-
-          this->data[2][0] * _m2(0, 1) +
-          this->data[2][1] * _m2(1, 1) +
-          this->data[2][2] * _m2(2, 1) +
-          this->data[2][3] * _m2(3, 1),
-
-          this->data[2][0] * _m2(0, 2) +
-          this->data[2][1] * _m2(1, 2) +
-          this->data[2][2] * _m2(2, 2) +
-          this->data[2][3] * _m2(3, 2),
-
-          this->data[2][0] * _m2(0, 3) +
-          this->data[2][1] * _m2(1, 3) +
-          this->data[2][2] * _m2(2, 3) +
-          this->data[2][3] * _m2(3, 3),
-
-          this->data[3][0] * _m2(0, 0) +
-          this->data[3][1] * _m2(1, 0) +
-          this->data[3][2] * _m2(2, 0) +
-          this->data[3][3] * _m2(3, 0),
-
-          this->data[3][0] * _m2(0, 1) +
-          this->data[3][1] * _m2(1, 1) +
-          this->data[3][2] * _m2(2, 1) +
-          this->data[3][3] * _m2(3, 1),
-
-          this->data[3][0] * _m2(0, 2) +
-          this->data[3][1] * _m2(1, 2) +
-          this->data[3][2] * _m2(2, 2) +
-          this->data[3][3] * _m2(3, 2),
-
-          this->data[3][0] * _m2(0, 3) +
-          this->data[3][1] * _m2(1, 3) +
-          this->data[3][2] * _m2(2, 3) +
-          this->data[3][3] * _m2(3, 3));
+        T r[16];
+        detail::Matrix4Multiply(&this->data[0][0], &_m2.data[0][0], r);
+        return Matrix4<T>(r[0], r[1], r[2], r[3],
+                          r[4], r[5], r[6], r[7],
+                          r[8], r[9], r[10], r[11],
+                          r[12], r[13], r[14], r[15]);
       }
 
       /// \brief Multiplication operator
@@ -731,6 +743,47 @@ namespace ignition
             this->data[2][2]*_vec.Z() + this->data[2][3]);
       }
 
+      /// \brief Project points to pixel coordinates through this matrix,
+      /// such as a projection matrix multiplied by a view matrix, in one
+      /// vectorized pass. Each point p is transformed to the clip
+      /// coordinates (x, y, z, w) = M [p, 1], which are divided by w to
+      /// normalized device coordinates in [-1, 1] inside the view volume,
+      /// as in OpenGL. Unlike operator*(const Vector3<T> &), the w
+      /// component is kept.
+      /// \param[in] _points Points to project.
+      /// \param[in] _width Image width, in pixels.
+      /// \param[in] _height Image height, in pixels.
+      /// \param[out] _u Pixel column of each point, from 0 at the left edge
+      /// of the image to _width at its right edge. Resized to the number of
+      /// points.
+      /// \param[out] _v Pixel row of each point, from 0 at the top edge of
+      /// the image to _height at its bottom edge. Resized to the number of
+      /// points.
+      /// \param[out] _depth W clip coordinate of each point, which is the
+      /// distance along the view direction for a perspective projection.
+      /// Resized to the number of points.
+      /// \param[out] _clip Bitmask of ClipCode values of each point, 0 for
+      /// points inside the view volume. Resized to the number of points.
+      /// \return Number of points inside the view volume. Points at w <= 0,
+      /// behind the center of projection, get NaN pixel coordinates.
+      public: std::size_t Project(const Vector3SoA<T> &_points,
+                                  const T _width, const T _height,
+                                  std::vector<T> &_u, std::vector<T> &_v,
+                                  std::vector<T> &_depth,
+                                  std::vector<uint8_t> &_clip) const
+      {
+        const std::size_t n = _points.Size();
+        _u.resize(n);
+        _v.resize(n);
+        _depth.resize(n);
+        _clip.resize(n);
+        detail::Matrix4Project(&this->data[0][0], _points.XData(),
+            _points.YData(), _points.ZData(), n, _width / 2, _height / 2,
+            _u.data(), _v.data(), _depth.data(), _clip.data());
+        return static_cast<std::size_t>(
+            std::count(_clip.begin(), _clip.end(), 0));
+      }
+
       /// \brief Get the value at the specified row, column index
       /// \param[in] _col The column index. Index values are clamped to a
       /// range of [0, 3].
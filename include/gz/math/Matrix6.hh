@@ -17,10 +17,15 @@
 #ifndef GZ_MATH_MATRIX6_HH_
 #define GZ_MATH_MATRIX6_HH_
 
+#include <cstddef>
+#include <limits>
 #include <utility>
 #include <gz/math/config.hh>
 #include <gz/math/Helpers.hh>
 #include <gz/math/Matrix3.hh>
+#include <gz/math/SpatialVector.hh>
+#include <gz/math/detail/Cholesky.hh>
+#include <gz/math/detail/Matrix6Simd.hh>
 
 namespace ignition
 {
@@ -311,25 +316,17 @@ namespace ignition
         return *this;
       }
 
-      /// \brief Multiplication operator
+      /// \brief Multiplication operator.
+      /// The double version uses SSE2 or NEON kernels when the target
+      /// supports them, see detail/Matrix6Simd.hh.
       /// \param[in] _m2 Incoming matrix
       /// \return This matrix * _m2
       public: Matrix6<T> operator*(const Matrix6<T> &_m2) const
       {
-        auto el = [&](size_t _row, size_t _col) -> T
-        {
-          T result = static_cast<T>(0);
-          for (size_t i = 0; i < MatrixSize; ++i)
-            result += this->data[_row][i] * _m2(i, _col);
-          return result;
-        };
-        return Matrix6<T>(
-            el(0, 0), el(0, 1), el(0, 2), el(0, 3), el(0, 4), el(0, 5),
-            el(1, 0), el(1, 1), el(1, 2), el(1, 3), el(1, 4), el(1, 5),
-            el(2, 0), el(2, 1), el(2, 2), el(2, 3), el(2, 4), el(2, 5),
-            el(3, 0), el(3, 1), el(3, 2), el(3, 3), el(3, 4), el(3, 5),
-            el(4, 0), el(4, 1), el(4, 2), el(4, 3), el(4, 4), el(4, 5),
-            el(5, 0), el(5, 1), el(5, 2), el(5, 3), el(5, 4), el(5, 5));
+        Matrix6<T> result;
+        detail::Matrix6Multiply(&this->data[0][0], &_m2.data[0][0],
+                                &result.data[0][0]);
+        return result;
       }
 
       /// \brief Addition assignment operator. This matrix will
@@ -360,6 +357,124 @@ namespace ignition
             el(5, 0), el(5, 1), el(5, 2), el(5, 3), el(5, 4), el(5, 5));
       }
 
+      /// \brief Replace the lower triangle of this symmetric positive
+      /// definite matrix, such as a spatial or articulated body inertia, by
+      /// its Cholesky factor L, such that the matrix is L L^T.
+      /// CholeskySolve then solves systems with the matrix. Only the lower
+      /// triangle is read, and the upper triangle is left unchanged.
+      /// \param[in] _tolerance Pivots must be greater than this fraction of
+      /// the largest diagonal element, which rejects nearly singular
+      /// matrices.
+      /// \return False if the matrix is not positive definite or not
+      /// finite. The lower triangle is then partially factored.
+      public: bool CholeskyFactor(const T _tolerance = 0)
+      {
+        return detail::CholeskyFactor<MatrixSize>(&this->data[0][0],
+                                                  _tolerance);
+      }
+
+      /// \brief Solve this * x = _b, once CholeskyFactor has succeeded. The
+      /// angular part of the vectors holds the first three rows, and the
+      /// linear part the last three, as in SpatialTransform.
+      /// \param[in] _b Right hand side.
+      /// \return The solution x.
+      public: SpatialVector<T> CholeskySolve(const SpatialVector<T> &_b) const
+      {
+        T x[MatrixSize];
+        ToArray(_b, x);
+        detail::CholeskySolve<MatrixSize>(&this->data[0][0], x);
+        return FromArray(x);
+      }
+
+      /// \brief Factor and solve many symmetric positive definite systems
+      /// in place, as CholeskyFactor and CholeskySolve do for each.
+      /// \param[in,out] _matrices Array of _count matrices, each replaced
+      /// by its factorization.
+      /// \param[in,out] _vectors Array of _count right hand sides, each
+      /// replaced by its solution, or by NaN if its matrix could not be
+      /// factored.
+      /// \param[in] _count Number of systems.
+      /// \param[in] _tolerance Tolerance of CholeskyFactor.
+      /// \return Number of systems solved.
+      public: static std::size_t CholeskySolve(Matrix6<T> *_matrices,
+                  SpatialVector<T> *_vectors, const std::size_t _count,
+                  const T _tolerance = 0)
+      {
+        std::size_t solved = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (_matrices[i].CholeskyFactor(_tolerance))
+          {
+            _vectors[i] = _matrices[i].CholeskySolve(_vectors[i]);
+            ++solved;
+          }
+          else
+          {
+            _vectors[i] = NanVector();
+          }
+        }
+        return solved;
+      }
+
+      /// \brief Replace the lower triangle of this symmetric matrix by its
+      /// LDL^T factorization, without pivoting: the strictly lower triangle
+      /// holds the unit lower triangular L, and the diagonal holds D.
+      /// Unlike CholeskyFactor it takes no square roots, and also factors
+      /// indefinite matrices whose leading minors are not singular. Only
+      /// the lower triangle is read, and the upper triangle is left
+      /// unchanged.
+      /// \param[in] _tolerance Pivots must have a magnitude greater than
+      /// this fraction of the largest diagonal magnitude.
+      /// \return False if a pivot is zero, below the tolerance, or not
+      /// finite. The lower triangle is then partially factored.
+      public: bool LdltFactor(const T _tolerance = 0)
+      {
+        return detail::LdltFactor<MatrixSize>(&this->data[0][0],
+                                              _tolerance);
+      }
+
+      /// \brief Solve this * x = _b, once LdltFactor has succeeded, with
+      /// the layout of CholeskySolve.
+      /// \param[in] _b Right hand side.
+      /// \return The solution x.
+      public: SpatialVector<T> LdltSolve(const SpatialVector<T> &_b) const
+      {
+        T x[MatrixSize];
+        ToArray(_b, x);
+        detail::LdltSolve<MatrixSize>(&this->data[0][0], x);
+        return FromArray(x);
+      }
+
+      /// \brief Factor and solve many symmetric systems in place, as
+      /// LdltFactor and LdltSolve do for each.
+      /// \param[in,out] _matrices Array of _count matrices, each replaced
+      /// by its factorization.
+      /// \param[in,out] _vectors Array of _count right hand sides, each
+      /// replaced by its solution, or by NaN if its matrix could not be
+      /// factored.
+      /// \param[in] _count Number of systems.
+      /// \param[in] _tolerance Tolerance of LdltFactor.
+      /// \return Number of systems solved.
+      public: static std::size_t LdltSolve(Matrix6<T> *_matrices,
+                  SpatialVector<T> *_vectors, const std::size_t _count,
+                  const T _tolerance = 0)
+      {
+        std::size_t solved = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (_matrices[i].LdltFactor(_tolerance))
+          {
+            _vectors[i] = _matrices[i].LdltSolve(_vectors[i]);
+            ++solved;
+          }
+          else
+          {
+            _vectors[i] = NanVector();
+          }
+        }
+        return solved;
+      }
+
      /// \brief Get the value at the specified row, column index
      /// \param[in] _col The column index. Index values are clamped to a
      /// range of [0, 5].
@@ -553,6 +668,37 @@ namespace ignition
       }
 
       /// \brief The 6x6 matrix
+      /// \brief Copy a spatial vector to an array, angular part first.
+      /// \param[in] _v The vector.
+      /// \param[out] _x The array.
+      private: static void ToArray(const SpatialVector<T> &_v,
+                                   T _x[MatrixSize])
+      {
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+          _x[i] = _v.Angular()[i];
+          _x[i + 3] = _v.Linear()[i];
+        }
+      }
+
+      /// \brief Build a spatial vector from an array, angular part first.
+      /// \param[in] _x The array.
+      /// \return The vector.
+      private: static SpatialVector<T> FromArray(const T _x[MatrixSize])
+      {
+        return SpatialVector<T>(Vector3<T>(_x[0], _x[1], _x[2]),
+                                Vector3<T>(_x[3], _x[4], _x[5]));
+      }
+
+      /// \brief Get the vector written for systems that cannot be solved.
+      /// \return A vector of NaN.
+      private: static SpatialVector<T> NanVector()
+      {
+        const T nan = std::numeric_limits<T>::quiet_NaN();
+        return SpatialVector<T>(Vector3<T>(nan, nan, nan),
+                                Vector3<T>(nan, nan, nan));
+      }
+
       private: T data[MatrixSize][MatrixSize];
     };
 
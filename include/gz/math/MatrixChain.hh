@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_MATRIXCHAIN_HH_
+#define GZ_MATH_MATRIXCHAIN_HH_
+
+#include <cstddef>
+#include <utility>
+
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    /// \class MatrixChain MatrixChain.hh ignition/math/MatrixChain.hh
+    /// \brief A product of matrices whose evaluation is deferred until the
+    /// matrices are applied to a vector or the product is requested.
+    ///
+    /// Writing A * B * C * v with the matrix types computes two full
+    /// matrix products before the vector is transformed. A chain created
+    /// with Chain() records the operands instead, and applies them to the
+    /// vector from right to left, which only needs matrix-vector products:
+    ///
+    ///     Vector3d p = Chain(A) * B * C * v;
+    ///
+    /// The chain works with any matrix type that multiplies with itself,
+    /// such as Matrix3, Matrix4 and Matrix6. Multiplying by a vector is
+    /// available when the matrix type can multiply that vector.
+    ///
+    /// Matrix4 multiplies a Vector3 as an affine transform, ignoring the
+    /// bottom row. Applying the operands one at a time gives the same
+    /// result as the full product only when every operand is affine, which
+    /// is the case for all rigid and scaling transforms.
+    ///
+    /// The chain keeps pointers to its operands, which must outlive it.
+    /// Temporaries are rejected at compile time, and a chain should not be
+    /// stored in a variable that outlives the full expression.
+    /// \tparam M Matrix type.
+    /// \tparam N Number of operands.
+    template<typename M, std::size_t N>
+    class MatrixChain
+    {
+      static_assert(N > 0, "A matrix chain needs at least one operand");
+
+      /// \brief Constructor.
+      /// \param[in] _operands Pointers to the operands, from left to right.
+      public: explicit MatrixChain(const M *const (&_operands)[N])
+      {
+        for (std::size_t i = 0; i < N; ++i)
+          this->operands[i] = _operands[i];
+      }
+
+      /// \brief Append a matrix to the right of the chain.
+      /// \param[in] _m Matrix to append. It must outlive the chain.
+      /// \return The longer chain.
+      public: MatrixChain<M, N + 1> operator*(const M &_m) const
+      {
+        const M *longer[N + 1];
+        for (std::size_t i = 0; i < N; ++i)
+          longer[i] = this->operands[i];
+        longer[N] = &_m;
+        return MatrixChain<M, N + 1>(longer);
+      }
+
+      /// \brief Temporaries would dangle, so they cannot be appended.
+      public: MatrixChain<M, N + 1> operator*(const M &&_m) const = delete;
+
+      /// \brief Apply the chain to a vector, multiplying the vector by the
+      /// operands from right to left. No intermediate matrix is created.
+      /// \param[in] _v Vector to transform.
+      /// \return Product of the chain and _v.
+      public: template<typename V>
+      auto operator*(const V &_v) const
+          -> decltype(std::declval<const M &>() * _v)
+      {
+        auto result = (*this->operands[N - 1]) * _v;
+        for (std::size_t i = N - 1; i > 0; --i)
+          result = (*this->operands[i - 1]) * result;
+        return result;
+      }
+
+      /// \brief Compute the product of the chain, from left to right.
+      /// \return Product of all the operands.
+      public: M Eval() const
+      {
+        M result = *this->operands[0];
+        for (std::size_t i = 1; i < N; ++i)
+          result = result * (*this->operands[i]);
+        return result;
+      }
+
+      /// \brief Convert the chain to the product of its operands.
+      /// \return Product of all the operands.
+      public: operator M() const
+      {
+        return this->Eval();
+      }
+
+      /// \brief Get the number of operands.
+      /// \return Number of operands.
+      public: static constexpr std::size_t Size()
+      {
+        return N;
+      }
+
+      /// \brief Operands, from left to right.
+      private: const M *operands[N];
+    };
+
+    /// \brief Start a lazy product of matrices.
+    /// \param[in] _m Leftmost matrix. It must outlive the chain.
+    /// \return A chain with a single operand.
+    template<typename M>
+    MatrixChain<M, 1> Chain(const M &_m)
+    {
+      const M *operands[1] = {&_m};
+      return MatrixChain<M, 1>(operands);
+    }
+
+    /// \brief Temporaries would dangle, so they cannot start a chain.
+    template<typename M>
+    MatrixChain<M, 1> Chain(const M &&_m) = delete;
+    }
+  }
+}
+#endif
@@ -0,0 +1,650 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_MATRIXN_HH_
+#define GZ_MATH_MATRIXN_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <type_traits>
+
+#include <gz/math/config.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Matrix4.hh>
+#include <gz/math/Matrix6.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/Vector4.hh>
+#include <gz/math/detail/Cholesky.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Get the alignment of fixed size storage of _count elements:
+      /// 16 bytes, for SSE loads, when that adds no padding, and the
+      /// alignment of T otherwise.
+      /// \return Alignment in bytes.
+      template<typename T, std::size_t _count>
+      constexpr std::size_t FixedStorageAlignment()
+      {
+        return (sizeof(T) * _count) % 16 == 0 && alignof(T) <= 16 ?
+            16 : alignof(T);
+      }
+    }
+
+    /// \class MatrixN MatrixN.hh ignition/math/MatrixN.hh
+    /// \brief A matrix whose size is fixed at compile time, for the sizes
+    /// that Matrix3, Matrix4 and Matrix6 do not cover, such as the state
+    /// covariance of a small Kalman filter or a 6x7 Jacobian.
+    ///
+    /// The elements are stored in place in row major order, without heap
+    /// allocation, and are zero by default. All loops have compile-time
+    /// bounds, which the compiler unrolls for small sizes, and most
+    /// operations are constexpr. Column vectors are MatrixN<T, N, 1>, see
+    /// VectorN. The eigen3 component maps a MatrixN onto an Eigen matrix
+    /// without copying.
+    /// \tparam T a numeric type.
+    /// \tparam R Number of rows.
+    /// \tparam C Number of columns.
+    template<typename T, std::size_t R, std::size_t C>
+    class MatrixN
+    {
+      static_assert(R > 0 && C > 0, "MatrixN must not be empty");
+
+      /// \brief Number of rows.
+      public: static constexpr std::size_t Rows{R};
+
+      /// \brief Number of columns.
+      public: static constexpr std::size_t Cols{C};
+
+      /// \brief Number of elements.
+      public: static constexpr std::size_t Size{R * C};
+
+      /// \brief Default constructor. All elements are zero.
+      public: constexpr MatrixN() = default;
+
+      /// \brief Constructor from elements in row major order. Missing
+      /// elements are zero, and extra elements are ignored.
+      /// \param[in] _values Elements.
+      public: constexpr MatrixN(std::initializer_list<T> _values)
+      {
+        std::size_t i = 0;
+        for (const T &v : _values)
+        {
+          if (i == Size)
+            break;
+          this->data[i++] = v;
+        }
+      }
+
+      /// \brief Constructor from a Vector2, for a 2x1 matrix.
+      /// \param[in] _v The vector.
+      public: template<std::size_t N = R,
+                       std::enable_if_t<N == 2 && C == 1, int> = 0>
+      constexpr explicit MatrixN(const Vector2<T> &_v)
+      : data{_v.X(), _v.Y()}
+      {
+      }
+
+      /// \brief Constructor from a Vector3, for a 3x1 matrix.
+      /// \param[in] _v The vector.
+      public: template<std::size_t N = R,
+                       std::enable_if_t<N == 3 && C == 1, int> = 0>
+      constexpr explicit MatrixN(const Vector3<T> &_v)
+      : data{_v.X(), _v.Y(), _v.Z()}
+      {
+      }
+
+      /// \brief Constructor from a Vector4, for a 4x1 matrix.
+      /// \param[in] _v The vector.
+      public: template<std::size_t N = R,
+                       std::enable_if_t<N == 4 && C == 1, int> = 0>
+      explicit MatrixN(const Vector4<T> &_v)
+      : data{_v.X(), _v.Y(), _v.Z(), _v.W()}
+      {
+      }
+
+      /// \brief Constructor from a Matrix3, for a 3x3 matrix.
+      /// \param[in] _m The matrix.
+      public: template<std::size_t N = R,
+                       std::enable_if_t<N == 3 && C == 3, int> = 0>
+      constexpr explicit MatrixN(const Matrix3<T> &_m)
+      {
+        this->CopyFrom(_m);
+      }
+
+      /// \brief Constructor from a Matrix4, for a 4x4 matrix.
+      /// \param[in] _m The matrix.
+      public: template<std::size_t N = R,
+                       std::enable_if_t<N == 4 && C == 4, int> = 0>
+      explicit MatrixN(const Matrix4<T> &_m)
+      {
+        this->CopyFrom(_m);
+      }
+
+      /// \brief Constructor from a Matrix6, for a 6x6 matrix.
+      /// \param[in] _m The matrix.
+      public: template<std::size_t N = R,
+                       std::enable_if_t<N == 6 && C == 6, int> = 0>
+      explicit MatrixN(const Matrix6<T> &_m)
+      {
+        this->CopyFrom(_m);
+      }
+
+      /// \brief Convert a 2x1 matrix to a Vector2.
+      /// \return The vector.
+      public: template<std::size_t N = R,
+                       std::enable_if_t<N == 2 && C == 1, int> = 0>
+      constexpr explicit operator Vector2<T>() const
+      {
+        return Vector2<T>(this->data[0], this->data[1]);
+      }
+
+      /// \brief Convert a 3x1 matrix to a Vector3.
+      /// \return The vector.
+      public: template<std::size_t N = R,
+                       std::enable_if_t<N == 3 && C == 1, int> = 0>
+      constexpr explicit operator Vector3<T>() const
+      {
+        return Vector3<T>(this->data[0], this->data[1], this->data[2]);
+      }
+
+      /// \brief Convert a 4x1 matrix to a Vector4.
+      /// \return The vector.
+      public: template<std::size_t N = R,
+                       std::enable_if_t<N == 4 && C == 1, int> = 0>
+      explicit operator Vector4<T>() const
+      {
+        return Vector4<T>(this->data[0], this->data[1], this->data[2],
+                          this->data[3]);
+      }
+
+      /// \brief Convert a 3x3 matrix to a Matrix3.
+      /// \return The matrix.
+      public: template<std::size_t N = R,
+                       std::enable_if_t<N == 3 && C == 3, int> = 0>
+      constexpr explicit operator Matrix3<T>() const
+      {
+        Matrix3<T> result = Matrix3<T>::Zero;
+        this->CopyTo(result);
+        return result;
+      }
+
+      /// \brief Convert a 4x4 matrix to a Matrix4.
+      /// \return The matrix.
+      public: template<std::size_t N = R,
+                       std::enable_if_t<N == 4 && C == 4, int> = 0>
+      explicit operator Matrix4<T>() const
+      {
+        Matrix4<T> result;
+        this->CopyTo(result);
+        return result;
+      }
+
+      /// \brief Convert a 6x6 matrix to a Matrix6.
+      /// \return The matrix.
+      public: template<std::size_t N = R,
+                       std::enable_if_t<N == 6 && C == 6, int> = 0>
+      explicit operator Matrix6<T>() const
+      {
+        Matrix6<T> result;
+        this->CopyTo(result);
+        return result;
+      }
+
+      /// \brief Get the identity matrix, ones on the diagonal and zeros
+      /// elsewhere. Non-square matrices get ones on their leading diagonal.
+      /// \return The identity matrix.
+      public: static constexpr MatrixN<T, R, C> Identity()
+      {
+        MatrixN<T, R, C> result;
+        for (std::size_t i = 0; i < R && i < C; ++i)
+          result(i, i) = 1;
+        return result;
+      }
+
+      /// \brief Get the zero matrix.
+      /// \return The zero matrix.
+      public: static constexpr MatrixN<T, R, C> Zero()
+      {
+        return MatrixN<T, R, C>();
+      }
+
+      /// \brief Get a matrix with every element set to a value.
+      /// \param[in] _value The value.
+      /// \return The matrix.
+      public: static constexpr MatrixN<T, R, C> Constant(const T _value)
+      {
+        MatrixN<T, R, C> result;
+        for (std::size_t i = 0; i < Size; ++i)
+          result.data[i] = _value;
+        return result;
+      }
+
+      /// \brief Get an element. The indices are not checked.
+      /// \param[in] _row Row index.
+      /// \param[in] _col Column index.
+      /// \return The element.
+      public: constexpr const T &operator()(const std::size_t _row,
+                                            const std::size_t _col) const
+      {
+        return this->data[_row * C + _col];
+      }
+
+      /// \brief Get a mutable element. The indices are not checked.
+      /// \param[in] _row Row index.
+      /// \param[in] _col Column index.
+      /// \return The element.
+      public: constexpr T &operator()(const std::size_t _row,
+                                      const std::size_t _col)
+      {
+        return this->data[_row * C + _col];
+      }
+
+      /// \brief Get an element by its row major index, such as the rows of
+      /// a vector. The index is not checked.
+      /// \param[in] _index Index.
+      /// \return The element.
+      public: constexpr const T &operator[](const std::size_t _index) const
+      {
+        return this->data[_index];
+      }
+
+      /// \brief Get a mutable element by its row major index. The index is
+      /// not checked.
+      /// \param[in] _index Index.
+      /// \return The element.
+      public: constexpr T &operator[](const std::size_t _index)
+      {
+        return this->data[_index];
+      }
+
+      /// \brief Get the elements in row major order.
+      /// \return Pointer to Size elements.
+      public: constexpr const T *Data() const
+      {
+        return this->data;
+      }
+
+      /// \brief Get the mutable elements in row major order.
+      /// \return Pointer to Size elements.
+      public: constexpr T *Data()
+      {
+        return this->data;
+      }
+
+      /// \brief Get a block of this matrix.
+      /// \param[in] _row Row of the first element of the block.
+      /// \param[in] _col Column of the first element of the block.
+      /// \return The BR x BC block. The indices are not checked.
+      /// \tparam BR Number of rows of the block.
+      /// \tparam BC Number of columns of the block.
+      public: template<std::size_t BR, std::size_t BC>
+      constexpr MatrixN<T, BR, BC> Block(const std::size_t _row,
+                                         const std::size_t _col) const
+      {
+        static_assert(BR <= R && BC <= C, "Block larger than the matrix");
+        MatrixN<T, BR, BC> result;
+        for (std::size_t i = 0; i < BR; ++i)
+          for (std::size_t j = 0; j < BC; ++j)
+            result(i, j) = (*this)(_row + i, _col + j);
+        return result;
+      }
+
+      /// \brief Set a block of this matrix.
+      /// \param[in] _row Row of the first element of the block.
+      /// \param[in] _col Column of the first element of the block.
+      /// \param[in] _block The block. The indices are not checked.
+      public: template<std::size_t BR, std::size_t BC>
+      constexpr void SetBlock(const std::size_t _row, const std::size_t _col,
+                              const MatrixN<T, BR, BC> &_block)
+      {
+        static_assert(BR <= R && BC <= C, "Block larger than the matrix");
+        for (std::size_t i = 0; i < BR; ++i)
+          for (std::size_t j = 0; j < BC; ++j)
+            (*this)(_row + i, _col + j) = _block(i, j);
+      }
+
+      /// \brief Get the transposed matrix.
+      /// \return The C x R transpose.
+      public: constexpr MatrixN<T, C, R> Transposed() const
+      {
+        MatrixN<T, C, R> result;
+        for (std::size_t i = 0; i < R; ++i)
+          for (std::size_t j = 0; j < C; ++j)
+            result(j, i) = (*this)(i, j);
+        return result;
+      }
+
+      /// \brief Get the sum of the diagonal elements.
+      /// \return The trace.
+      public: constexpr T Trace() const
+      {
+        T sum = 0;
+        for (std::size_t i = 0; i < R && i < C; ++i)
+          sum += (*this)(i, i);
+        return sum;
+      }
+
+      /// \brief Get the sum of the products of the elements of two
+      /// matrices, the dot product of vectors.
+      /// \param[in] _m The other matrix.
+      /// \return The dot product.
+      public: constexpr T Dot(const MatrixN<T, R, C> &_m) const
+      {
+        T sum = 0;
+        for (std::size_t i = 0; i < Size; ++i)
+          sum += this->data[i] * _m.data[i];
+        return sum;
+      }
+
+      /// \brief Get the sum of the squared elements.
+      /// \return The squared length of a vector, or the squared Frobenius
+      /// norm of a matrix.
+      public: constexpr T SquaredLength() const
+      {
+        return this->Dot(*this);
+      }
+
+      /// \brief Get the square root of the sum of the squared elements.
+      /// \return The length of a vector, or the Frobenius norm of a matrix.
+      public: T Length() const
+      {
+        return std::sqrt(this->SquaredLength());
+      }
+
+      /// \brief Check that all elements are finite.
+      /// \return True if no element is NaN or infinite.
+      public: bool IsFinite() const
+      {
+        for (std::size_t i = 0; i < Size; ++i)
+        {
+          if (!std::isfinite(this->data[i]))
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Add a matrix.
+      /// \param[in] _m The other matrix.
+      /// \return The sum.
+      public: constexpr MatrixN<T, R, C> operator+(
+                  const MatrixN<T, R, C> &_m) const
+      {
+        MatrixN<T, R, C> result = *this;
+        result += _m;
+        return result;
+      }
+
+      /// \brief Subtract a matrix.
+      /// \param[in] _m The other matrix.
+      /// \return The difference.
+      public: constexpr MatrixN<T, R, C> operator-(
+                  const MatrixN<T, R, C> &_m) const
+      {
+        MatrixN<T, R, C> result = *this;
+        result -= _m;
+        return result;
+      }
+
+      /// \brief Negate every element.
+      /// \return The negated matrix.
+      public: constexpr MatrixN<T, R, C> operator-() const
+      {
+        MatrixN<T, R, C> result;
+        for (std::size_t i = 0; i < Size; ++i)
+          result.data[i] = -this->data[i];
+        return result;
+      }
+
+      /// \brief Multiply by a scalar.
+      /// \param[in] _s The scalar.
+      /// \return The scaled matrix.
+      public: constexpr MatrixN<T, R, C> operator*(const T _s) const
+      {
+        MatrixN<T, R, C> result = *this;
+        result *= _s;
+        return result;
+      }
+
+      /// \brief Multiply a scalar by a matrix.
+      /// \param[in] _s The scalar.
+      /// \param[in] _m The matrix.
+      /// \return The scaled matrix.
+      public: friend constexpr MatrixN<T, R, C> operator*(const T _s,
+                  const MatrixN<T, R, C> &_m)
+      {
+        return _m * _s;
+      }
+
+      /// \brief Divide by a scalar.
+      /// \param[in] _s The scalar.
+      /// \return The scaled matrix.
+      public: constexpr MatrixN<T, R, C> operator/(const T _s) const
+      {
+        MatrixN<T, R, C> result;
+        for (std::size_t i = 0; i < Size; ++i)
+          result.data[i] = this->data[i] / _s;
+        return result;
+      }
+
+      /// \brief Multiply by a matrix.
+      /// \param[in] _m The C x K matrix.
+      /// \return The R x K product.
+      public: template<std::size_t K>
+      constexpr MatrixN<T, R, K> operator*(const MatrixN<T, C, K> &_m) const
+      {
+        MatrixN<T, R, K> result;
+        for (std::size_t i = 0; i < R; ++i)
+        {
+          // Accumulate rows of _m, which keeps the inner loop contiguous
+          for (std::size_t k = 0; k < C; ++k)
+          {
+            const T a = (*this)(i, k);
+            for (std::size_t j = 0; j < K; ++j)
+              result(i, j) += a * _m(k, j);
+          }
+        }
+        return result;
+      }
+
+      /// \brief Add a matrix to this.
+      /// \param[in] _m The other matrix.
+      /// \return Reference to this.
+      public: constexpr MatrixN<T, R, C> &operator+=(
+                  const MatrixN<T, R, C> &_m)
+      {
+        for (std::size_t i = 0; i < Size; ++i)
+          this->data[i] += _m.data[i];
+        return *this;
+      }
+
+      /// \brief Subtract a matrix from this.
+      /// \param[in] _m The other matrix.
+      /// \return Reference to this.
+      public: constexpr MatrixN<T, R, C> &operator-=(
+                  const MatrixN<T, R, C> &_m)
+      {
+        for (std::size_t i = 0; i < Size; ++i)
+          this->data[i] -= _m.data[i];
+        return *this;
+      }
+
+      /// \brief Multiply this by a scalar.
+      /// \param[in] _s The scalar.
+      /// \return Reference to this.
+      public: constexpr MatrixN<T, R, C> &operator*=(const T _s)
+      {
+        for (std::size_t i = 0; i < Size; ++i)
+          this->data[i] *= _s;
+        return *this;
+      }
+
+      /// \brief Replace the lower triangle of this symmetric positive
+      /// definite matrix by its Cholesky factor, as
+      /// Matrix3::CholeskyFactor. This is the usual way to solve with the
+      /// innovation covariance of a Kalman filter.
+      /// \param[in] _tolerance Pivots must be greater than this fraction of
+      /// the largest diagonal element.
+      /// \return False if the matrix is not positive definite or not
+      /// finite.
+      public: bool CholeskyFactor(const T _tolerance = 0)
+      {
+        static_assert(R == C, "CholeskyFactor needs a square matrix");
+        return detail::CholeskyFactor<R>(this->data, _tolerance);
+      }
+
+      /// \brief Solve this * X = _b, once CholeskyFactor has succeeded.
+      /// \param[in] _b Right hand sides, one per column.
+      /// \return The solutions X.
+      public: template<std::size_t K>
+      MatrixN<T, R, K> CholeskySolve(const MatrixN<T, R, K> &_b) const
+      {
+        static_assert(R == C, "CholeskySolve needs a square matrix");
+        MatrixN<T, R, K> result;
+        for (std::size_t k = 0; k < K; ++k)
+        {
+          T x[R];
+          for (std::size_t i = 0; i < R; ++i)
+            x[i] = _b(i, k);
+          detail::CholeskySolve<R>(this->data, x);
+          for (std::size_t i = 0; i < R; ++i)
+            result(i, k) = x[i];
+        }
+        return result;
+      }
+
+      /// \brief Replace the lower triangle of this symmetric matrix by its
+      /// LDL^T factorization, as Matrix3::LdltFactor.
+      /// \param[in] _tolerance Pivots must have a magnitude greater than
+      /// this fraction of the largest diagonal magnitude.
+      /// \return False if a pivot is zero, below the tolerance, or not
+      /// finite.
+      public: bool LdltFactor(const T _tolerance = 0)
+      {
+        static_assert(R == C, "LdltFactor needs a square matrix");
+        return detail::LdltFactor<R>(this->data, _tolerance);
+      }
+
+      /// \brief Solve this * X = _b, once LdltFactor has succeeded.
+      /// \param[in] _b Right hand sides, one per column.
+      /// \return The solutions X.
+      public: template<std::size_t K>
+      MatrixN<T, R, K> LdltSolve(const MatrixN<T, R, K> &_b) const
+      {
+        static_assert(R == C, "LdltSolve needs a square matrix");
+        MatrixN<T, R, K> result;
+        for (std::size_t k = 0; k < K; ++k)
+        {
+          T x[R];
+          for (std::size_t i = 0; i < R; ++i)
+            x[i] = _b(i, k);
+          detail::LdltSolve<R>(this->data, x);
+          for (std::size_t i = 0; i < R; ++i)
+            result(i, k) = x[i];
+        }
+        return result;
+      }
+
+      /// \brief Equality test with tolerance.
+      /// \param[in] _m The matrix to compare to.
+      /// \param[in] _tol Equality tolerance.
+      /// \return True if all elements are equal within _tol.
+      public: bool Equal(const MatrixN<T, R, C> &_m, const T &_tol) const
+      {
+        for (std::size_t i = 0; i < Size; ++i)
+        {
+          if (!equal<T>(this->data[i], _m.data[i], _tol))
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Equality operator, with the tolerance of Matrix3.
+      /// \param[in] _m The matrix to compare to.
+      /// \return True if all elements are equal within 1e-6.
+      public: bool operator==(const MatrixN<T, R, C> &_m) const
+      {
+        return this->Equal(_m, static_cast<T>(1e-6));
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _m The matrix to compare to.
+      /// \return True if an element differs by more than 1e-6.
+      public: bool operator!=(const MatrixN<T, R, C> &_m) const
+      {
+        return !(*this == _m);
+      }
+
+      /// \brief Stream insertion operator, row major and space separated
+      /// as Matrix3.
+      /// \param[in, out] _out Output stream.
+      /// \param[in] _m Matrix to output.
+      /// \return The stream.
+      public: friend std::ostream &operator<<(std::ostream &_out,
+                                              const MatrixN<T, R, C> &_m)
+      {
+        for (std::size_t i = 0; i < Size; ++i)
+        {
+          if (i > 0)
+            _out << " ";
+          _out << precision(_m.data[i], 6);
+        }
+        return _out;
+      }
+
+      /// \brief Copy the elements of a square matrix type.
+      /// \param[in] _m Matrix with operator()(row, col).
+      private: template<typename M>
+      constexpr void CopyFrom(const M &_m)
+      {
+        for (std::size_t i = 0; i < R; ++i)
+          for (std::size_t j = 0; j < C; ++j)
+            (*this)(i, j) = _m(i, j);
+      }
+
+      /// \brief Copy the elements to a square matrix type.
+      /// \param[out] _m Matrix with operator()(row, col).
+      private: template<typename M>
+      constexpr void CopyTo(M &_m) const
+      {
+        for (std::size_t i = 0; i < R; ++i)
+          for (std::size_t j = 0; j < C; ++j)
+            _m(i, j) = (*this)(i, j);
+      }
+
+      /// \brief Elements in row major order.
+      private: alignas(detail::FixedStorageAlignment<T, R * C>())
+               T data[R * C] = {};
+    };
+
+    /// \brief A column vector whose size is fixed at compile time.
+    /// \tparam T a numeric type.
+    /// \tparam N Number of elements.
+    template<typename T, std::size_t N>
+    using VectorN = MatrixN<T, N, 1>;
+    }
+  }
+}
+#endif
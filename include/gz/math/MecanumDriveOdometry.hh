@@ -41,6 +41,10 @@ namespace ignition
     /// Note: when computing velocity the math currently assumes that
     /// all wheels have a radius of 1.0.
     ///
+    /// Init, Update and the getters are real-time safe: they never
+    /// allocate memory. The constructor, and SetVelocityRollingWindowSize
+    /// with a window size other than 10, allocate the velocity buffers.
+    ///
     /// A vehicle with a heading of zero degrees has a local
     /// reference frame according to the diagram below.
     ///
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_MECANUMDRIVEODOMETRYBANK_HH_
+#define GZ_MATH_MECANUMDRIVEODOMETRYBANK_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gz/math/MecanumDriveOdometry.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declarations.
+    class MecanumDriveOdometryBankPrivate;
+
+    /** \class MecanumDriveOdometryBank MecanumDriveOdometryBank.hh \
+     * ignition/math/MecanumDriveOdometryBank.hh
+     **/
+    /// \brief Odometry of a fleet of mecanum-drive vehicles that are
+    /// updated together.
+    ///
+    /// Each vehicle follows the equations of MecanumDriveOdometry, with its
+    /// own or shared wheel parameters. Wheel positions, poses and
+    /// velocities are arrays with one element per vehicle, and an update
+    /// integrates every vehicle in a single pass.
+    class IGNITION_MATH_VISIBLE MecanumDriveOdometryBank
+    {
+      /// \brief Constructor.
+      /// \param[in] _size Number of vehicles.
+      /// \param[in] _windowSize Rolling window size used to compute the
+      /// velocity means.
+      public: explicit MecanumDriveOdometryBank(
+                  const std::size_t _size = 0,
+                  const std::size_t _windowSize = 10);
+
+      // Use a steady clock
+      public: using clock = std::chrono::steady_clock;
+
+      /// \brief Copy constructor.
+      /// \param[in] _bank Bank to copy.
+      public: MecanumDriveOdometryBank(const MecanumDriveOdometryBank &_bank);
+
+      /// \brief Destructor.
+      public: ~MecanumDriveOdometryBank();
+
+      /// \brief Assignment operator.
+      /// \param[in] _bank Bank to copy.
+      /// \return Reference to this bank.
+      public: MecanumDriveOdometryBank &operator=(
+                  const MecanumDriveOdometryBank &_bank);
+
+      /// \brief Change the number of vehicles. Existing vehicles are kept,
+      /// and new vehicles start at the origin with the default wheel
+      /// parameters of MecanumDriveOdometry. The velocity means are
+      /// cleared.
+      /// \param[in] _size Number of vehicles.
+      public: void Resize(const std::size_t _size);
+
+      /// \brief Get the number of vehicles.
+      /// \return Number of vehicles.
+      public: std::size_t Size() const;
+
+      /// \brief Initialize the odometry of every vehicle.
+      /// \param[in] _time Current time.
+      public: void Init(const clock::time_point &_time);
+
+      /// \brief Get whether Init has been called.
+      /// \return True if Init has been called, false otherwise.
+      public: bool Initialized() const;
+
+      /// \brief Update the odometry of every vehicle with the latest wheel
+      /// positions, as MecanumDriveOdometry::Update does for one vehicle.
+      /// \param[in] _frontLeftPos Front left wheel position of each
+      /// vehicle in radians.
+      /// \param[in] _frontRightPos Front right wheel position of each
+      /// vehicle in radians.
+      /// \param[in] _backLeftPos Back left wheel position of each vehicle
+      /// in radians.
+      /// \param[in] _backRightPos Back right wheel position of each vehicle
+      /// in radians.
+      /// \param[in] _time Current time point.
+      /// \return True if the odometry is actually updated. False if the
+      /// positions do not have Size() elements, in which case nothing
+      /// changes, or if the time step is zero, in which case the poses are
+      /// updated but not the velocities.
+      public: bool Update(const std::vector<double> &_frontLeftPos,
+                          const std::vector<double> &_frontRightPos,
+                          const std::vector<double> &_backLeftPos,
+                          const std::vector<double> &_backRightPos,
+                          const clock::time_point &_time);
+
+      /// \brief Set the wheel parameters of every vehicle.
+      /// \param[in] _wheelSeparation Distance between left and right
+      /// wheels.
+      /// \param[in] _wheelBase Distance between front and back wheels.
+      /// \param[in] _leftWheelRadius Radius of the left wheels.
+      /// \param[in] _rightWheelRadius Radius of the right wheels.
+      public: void SetWheelParams(double _wheelSeparation,
+                                  double _wheelBase,
+                                  double _leftWheelRadius,
+                                  double _rightWheelRadius);
+
+      /// \brief Set the wheel parameters of a vehicle.
+      /// \param[in] _index Index of the vehicle.
+      /// \param[in] _wheelSeparation Distance between left and right
+      /// wheels.
+      /// \param[in] _wheelBase Distance between front and back wheels.
+      /// \param[in] _leftWheelRadius Radius of the left wheels.
+      /// \param[in] _rightWheelRadius Radius of the right wheels.
+      /// \return False if _index is out of range.
+      public: bool SetWheelParams(const std::size_t _index,
+                                  double _wheelSeparation,
+                                  double _wheelBase,
+                                  double _leftWheelRadius,
+                                  double _rightWheelRadius);
+
+      /// \brief Set the velocity rolling window size of every vehicle.
+      /// \param[in] _size The Velocity rolling window size.
+      public: void SetVelocityRollingWindowSize(size_t _size);
+
+      /// \brief Get the headings.
+      /// \return The heading of each vehicle in radians.
+      public: const std::vector<double> &Heading() const;
+
+      /// \brief Get the X positions.
+      /// \return The X position of each vehicle in meters.
+      public: const std::vector<double> &X() const;
+
+      /// \brief Get the Y positions.
+      /// \return The Y position of each vehicle in meters.
+      public: const std::vector<double> &Y() const;
+
+      /// \brief Get the linear velocities.
+      /// \return The linear velocity of each vehicle in meter/second.
+      public: const std::vector<double> &LinearVelocity() const;
+
+      /// \brief Get the lateral velocities.
+      /// \return The lateral velocity of each vehicle in meter/second.
+      public: const std::vector<double> &LateralVelocity() const;
+
+      /// \brief Get the angular velocities.
+      /// \return The angular velocity of each vehicle in radians/second.
+      public: const std::vector<double> &AngularVelocity() const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MecanumDriveOdometryBankPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_MESHBOUNDINGVOLUMEHIERARCHY_HH_
+#define GZ_MATH_MESHBOUNDINGVOLUMEHIERARCHY_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/Triangle3.hh>
+#include <gz/math/Vector3.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  // Forward declaration.
+  class MeshBoundingVolumeHierarchyPrivate;
+
+  /// \class MeshBoundingVolumeHierarchy MeshBoundingVolumeHierarchy.hh
+  /// ignition/math/MeshBoundingVolumeHierarchy.hh
+  /// \brief A bounding volume hierarchy over the triangles of a mesh, used
+  /// to answer ray, closest point, signed distance and overlap queries in
+  /// logarithmic rather than linear time.
+  ///
+  /// The mesh is given as a vertex buffer and an index buffer with three
+  /// indices into the vertex buffer for each triangle, and both are copied.
+  /// Triangles are referred to by their position in the index buffer, and
+  /// the hierarchy is a BoundingVolumeHierarchy over their bounds.
+  ///
+  /// Signed distances are negative inside of the mesh. They use the angle
+  /// weighted pseudonormals of the closest triangle, edge or vertex, which
+  /// give the correct sign for closed meshes whose triangles are wound
+  /// counterclockwise when seen from outside. Pseudonormals are computed
+  /// when the hierarchy is built.
+  ///
+  /// The hierarchy does not track changes to the mesh; call Build() again
+  /// after the vertices move.
+  class IGNITION_MATH_VISIBLE MeshBoundingVolumeHierarchy
+  {
+    /// \brief Index reported by queries when no triangle is found.
+    public: static constexpr std::size_t kNoTriangle =
+      std::numeric_limits<std::size_t>::max();
+
+    /// \brief Default constructor. Creates an empty hierarchy.
+    public: MeshBoundingVolumeHierarchy();
+
+    /// \brief Constructor. Builds a hierarchy over a mesh.
+    /// \param[in] _vertices Vertex buffer.
+    /// \param[in] _indices Index buffer with three indices into _vertices
+    /// for each triangle.
+    /// \param[in] _threads Number of threads used to build the hierarchy.
+    /// \sa Build()
+    public: MeshBoundingVolumeHierarchy(
+                const std::vector<Vector3d> &_vertices,
+                const std::vector<uint32_t> &_indices,
+                const unsigned int _threads = 1);
+
+    /// \brief Copy constructor.
+    /// \param[in] _bvh Hierarchy to copy.
+    public: MeshBoundingVolumeHierarchy(
+                const MeshBoundingVolumeHierarchy &_bvh);
+
+    /// \brief Destructor.
+    public: ~MeshBoundingVolumeHierarchy();
+
+    /// \brief Assignment operator.
+    /// \param[in] _bvh Hierarchy to copy.
+    /// \return Reference to this hierarchy.
+    public: MeshBoundingVolumeHierarchy &operator=(
+                const MeshBoundingVolumeHierarchy &_bvh);
+
+    /// \brief Rebuild the hierarchy over a new mesh.
+    /// \param[in] _vertices Vertex buffer.
+    /// \param[in] _indices Index buffer with three indices into _vertices
+    /// for each triangle.
+    /// \param[in] _threads Number of threads used to build the hierarchy.
+    /// Triangle bounds and normals are computed by contiguous blocks of
+    /// triangles, and the tree is built as in
+    /// BoundingVolumeHierarchy::Build(). A value of 0 uses the number of
+    /// hardware threads. Small meshes always use a single thread.
+    /// \return False if the number of indices is not a multiple of three or
+    /// an index is out of range, in which case the hierarchy is empty.
+    public: bool Build(const std::vector<Vector3d> &_vertices,
+                       const std::vector<uint32_t> &_indices,
+                       const unsigned int _threads = 1);
+
+    /// \brief Get the number of triangles.
+    /// \return Number of triangles, a third of the number of indices.
+    public: std::size_t TriangleCount() const;
+
+    /// \brief Get whether the hierarchy contains no triangles.
+    /// \return True if there are no triangles.
+    public: bool Empty() const;
+
+    /// \brief Get the vertex buffer.
+    /// \return Vertices of the mesh.
+    public: const std::vector<Vector3d> &Vertices() const;
+
+    /// \brief Get the index buffer.
+    /// \return Three indices into Vertices() for each triangle.
+    public: const std::vector<uint32_t> &Indices() const;
+
+    /// \brief Get a triangle of the mesh.
+    /// \param[in] _index Index of the triangle, less than TriangleCount().
+    /// \return The triangle.
+    public: Triangle3d Triangle(const std::size_t _index) const;
+
+    /// \brief Get the box that bounds the mesh.
+    /// \return The bounding box, or a default box if the mesh is empty.
+    public: AxisAlignedBox Bounds() const;
+
+    /// \brief Find the closest triangle hit by a ray.
+    /// \param[in] _origin Origin of the ray.
+    /// \param[in] _dir Direction of the ray. This ray will be normalized.
+    /// \param[in] _min Minimum allowed distance.
+    /// \param[in] _max Maximum allowed distance.
+    /// \return A boolean, double, std::size_t tuple. The boolean value is
+    /// true if the ray hits a triangle. The double is the distance from the
+    /// ray's start to the closest intersection point minus _min, as in
+    /// Triangle3::IntersectDist, and zero when there is no hit. The
+    /// std::size_t is the index of the closest triangle hit, or
+    /// kNoTriangle.
+    public: std::tuple<bool, double, std::size_t> ClosestHit(
+                const Vector3d &_origin, const Vector3d &_dir,
+                const double _min, const double _max) const;
+
+    /// \brief Find the point of the mesh closest to a point.
+    /// \param[in] _point The point.
+    /// \param[out] _closest Closest point of the mesh. Only valid if the
+    /// return value is true.
+    /// \param[out] _triangle Index of the triangle of the closest point.
+    /// The lowest index is reported when several triangles are at the same
+    /// distance. Only valid if the return value is true.
+    /// \param[in] _maxDistance Maximum allowed distance from _point.
+    /// \return True if a triangle is within _maxDistance of _point.
+    public: bool ClosestPoint(const Vector3d &_point, Vector3d &_closest,
+                              std::size_t &_triangle,
+                              const double _maxDistance = MAX_D) const;
+
+    /// \brief Compute the signed distance from the mesh to a point.
+    /// \param[in] _point The point.
+    /// \return Distance from _point to the closest point of the mesh,
+    /// negative if _point is inside of the mesh, or NaN if the mesh is
+    /// empty.
+    public: double SignedDistance(const Vector3d &_point) const;
+
+    /// \brief Compute the signed distance from the mesh to many points.
+    /// Each result is the same as SignedDistance() of the corresponding
+    /// point.
+    /// \param[in] _points Array of _count points.
+    /// \param[in] _count Number of points.
+    /// \param[out] _distances Array of at least _count values, written with
+    /// the signed distance of each point.
+    /// \param[in] _threads Number of threads used for the queries. Each
+    /// thread handles a contiguous block of points. A value of 0 uses the
+    /// number of hardware threads. Small batches always use a single
+    /// thread.
+    public: void SignedDistances(const Vector3d *_points,
+                                 const std::size_t _count,
+                                 double *_distances,
+                                 const unsigned int _threads = 1) const;
+
+    /// \brief Find all the triangles that intersect a sphere.
+    /// \param[in] _center Center of the sphere.
+    /// \param[in] _radius Radius of the sphere.
+    /// \param[out] _indices Indices of the triangles with a point within
+    /// _radius of _center, in no particular order. The vector is cleared
+    /// first.
+    public: void Overlaps(const Vector3d &_center, const double _radius,
+                          std::vector<std::size_t> &_indices) const;
+
+    /// \brief Find all the triangles that intersect a box, including the
+    /// triangles touching its boundary. Unlike
+    /// BoundingVolumeHierarchy::Overlaps(), the triangles themselves rather
+    /// than their bounds are tested, using the separating axis theorem.
+    /// \param[in] _box Box to check.
+    /// \param[out] _indices Indices of the intersecting triangles, in no
+    /// particular order. The vector is cleared first.
+    public: void Overlaps(const AxisAlignedBox &_box,
+                          std::vector<std::size_t> &_indices) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+    /// \brief Private data pointer.
+    private: std::unique_ptr<MeshBoundingVolumeHierarchyPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+  };
+  }
+}
+}
+#endif
@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_MESHMASSPROPERTIES_HH_
+#define GZ_MATH_MESHMASSPROPERTIES_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <gz/math/Executor.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/MassMatrix3.hh>
+#include <gz/math/Material.hh>
+#include <gz/math/Triangle3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class MeshMassProperties MeshMassProperties.hh
+    /// ignition/math/MeshMassProperties.hh
+    /// \brief Computes the volume, center of mass and mass matrix of a
+    /// closed triangle mesh of uniform density.
+    ///
+    /// Each triangle forms a tetrahedron with the origin, and the divergence
+    /// theorem turns the volume integrals of the solid into a sum over
+    /// these signed tetrahedra. Only the running sums of 10 integrals are
+    /// stored, so triangles can be added one at a time, in any order, from
+    /// an indexed buffer that is not copied.
+    ///
+    /// Partial results computed over separate parts of a mesh are combined
+    /// with Merge, which is how AddTriangles reduces the work of several
+    /// threads. The result is only meaningful once every triangle of a
+    /// closed mesh has been added.
+    ///
+    /// The triangles must be consistently wound. Either winding gives the
+    /// same result, although counter-clockwise when seen from outside is
+    /// the usual convention. The integrals are taken about the origin, so
+    /// the vertices should be expressed in a frame close to the mesh to
+    /// avoid losing precision.
+    template<typename T>
+    class MeshMassProperties
+    {
+      /// \brief Default constructor, for an empty mesh.
+      public: MeshMassProperties() = default;
+
+      /// \brief Add a triangle of the mesh.
+      /// \param[in] _v0 First vertex.
+      /// \param[in] _v1 Second vertex.
+      /// \param[in] _v2 Third vertex.
+      public: void AddTriangle(const Vector3<T> &_v0, const Vector3<T> &_v1,
+                               const Vector3<T> &_v2)
+      {
+        // Six times the signed volume of the tetrahedron with the origin
+        const T d = _v0.Dot(_v1.Cross(_v2));
+        const Vector3<T> s = _v0 + _v1 + _v2;
+
+        this->volume6 += d;
+        this->first += d * s;
+
+        // Integral of x_k x_l over the tetrahedron, times 120 / d, is
+        // s_k s_l + sum over vertices of v_k v_l
+        this->second += d * (s * s + _v0 * _v0 + _v1 * _v1 + _v2 * _v2);
+        this->secondCross += d * Vector3<T>(
+            s.X() * s.Y() + _v0.X() * _v0.Y() + _v1.X() * _v1.Y() +
+              _v2.X() * _v2.Y(),
+            s.X() * s.Z() + _v0.X() * _v0.Z() + _v1.X() * _v1.Z() +
+              _v2.X() * _v2.Z(),
+            s.Y() * s.Z() + _v0.Y() * _v0.Z() + _v1.Y() * _v1.Z() +
+              _v2.Y() * _v2.Z());
+      }
+
+      /// \brief Add a triangle of the mesh.
+      /// \param[in] _triangle Triangle to add.
+      public: void AddTriangle(const Triangle3<T> &_triangle)
+      {
+        this->AddTriangle(_triangle[0], _triangle[1], _triangle[2]);
+      }
+
+      /// \brief Add triangles from an indexed triangle buffer. Neither the
+      /// vertices nor the indices are copied.
+      /// \param[in] _vertices Vertex buffer.
+      /// \param[in] _indices Index buffer with three indices into
+      /// _vertices for each triangle.
+      /// \param[in] _triangleCount Number of triangles, which is a third of
+      /// the number of indices.
+      /// \param[in] _threads Number of threads used to add the triangles.
+      /// Each thread sums a contiguous block of triangles, and the blocks
+      /// are merged in order. A value of 0 uses the number of hardware
+      /// threads. Small meshes always use a single thread. The sums are
+      /// combined in a different order with more than one thread, so
+      /// results may differ in the last bits from a single thread run.
+      public: template<typename Index>
+              void AddTriangles(const Vector3<T> *_vertices,
+                                const Index *_indices,
+                                const std::size_t _triangleCount,
+                                const unsigned int _threads = 1)
+      {
+        std::size_t threads = _threads;
+        if (threads == 0)
+          threads = std::thread::hardware_concurrency();
+        threads = std::min(threads, _triangleCount / kMinTrianglesPerThread);
+        if (threads <= 1)
+        {
+          this->AddRange(_vertices, _indices, 0, _triangleCount);
+          return;
+        }
+
+        const std::size_t chunk = (_triangleCount + threads - 1) / threads;
+        std::vector<MeshMassProperties<T>> partial(threads);
+        std::vector<std::thread> workers;
+        for (std::size_t t = 1; t < threads; ++t)
+        {
+          const std::size_t begin = std::min(_triangleCount, t * chunk);
+          const std::size_t end = std::min(_triangleCount, begin + chunk);
+          workers.emplace_back(
+              [&partial, _vertices, _indices, t, begin, end]()
+              {
+                partial[t].AddRange(_vertices, _indices, begin, end);
+              });
+        }
+        partial[0].AddRange(_vertices, _indices, 0,
+                            std::min(_triangleCount, chunk));
+
+        for (auto &worker : workers)
+          worker.join();
+        for (const auto &props : partial)
+          this->Merge(props);
+      }
+
+      /// \brief Add triangles from an indexed triangle buffer, running the
+      /// work on an executor. Each task sums a contiguous block of
+      /// triangles, and the blocks are merged in order, so results only
+      /// depend on the concurrency of the executor.
+      /// \param[in] _vertices Vertex buffer.
+      /// \param[in] _indices Index buffer with three indices into
+      /// _vertices for each triangle.
+      /// \param[in] _triangleCount Number of triangles, which is a third of
+      /// the number of indices.
+      /// \param[in] _executor Executor running the blocks of triangles.
+      public: template<typename Index>
+              void AddTriangles(const Vector3<T> *_vertices,
+                                const Index *_indices,
+                                const std::size_t _triangleCount,
+                                Executor &_executor)
+      {
+        const std::size_t blocks =
+            _executor.BlockCount(_triangleCount, kMinTrianglesPerThread);
+        if (blocks <= 1)
+        {
+          this->AddRange(_vertices, _indices, 0, _triangleCount);
+          return;
+        }
+
+        std::vector<MeshMassProperties<T>> partial(blocks);
+        _executor.ForEachBlock(_triangleCount, blocks,
+            [&](const std::size_t _begin, const std::size_t _end,
+                const std::size_t _block)
+            {
+              partial[_block].AddRange(_vertices, _indices, _begin, _end);
+            });
+        for (const auto &props : partial)
+          this->Merge(props);
+      }
+
+      /// \brief Add the triangles of another partial mesh, as if they had
+      /// been added to this one.
+      /// \param[in] _props Mass properties of the other part of the mesh.
+      public: void Merge(const MeshMassProperties<T> &_props)
+      {
+        this->volume6 += _props.volume6;
+        this->first += _props.first;
+        this->second += _props.second;
+        this->secondCross += _props.secondCross;
+      }
+
+      /// \brief Remove all the triangles.
+      public: void Reset()
+      {
+        *this = MeshMassProperties<T>();
+      }
+
+      /// \brief Get the volume enclosed by the mesh.
+      /// \return Volume in m^3.
+      public: T Volume() const
+      {
+        return std::abs(this->volume6) / 6;
+      }
+
+      /// \brief Get the center of mass, which is the centroid of the
+      /// enclosed volume.
+      /// \return Center of mass in the frame of the vertices, or the zero
+      /// vector if the enclosed volume is zero.
+      public: Vector3<T> CenterOfMass() const
+      {
+        if (this->ZeroVolume())
+          return Vector3<T>::Zero;
+        return this->first / (4 * this->volume6);
+      }
+
+      /// \brief Get the mass matrix of the solid about its center of mass,
+      /// with axes parallel to the frame of the vertices.
+      /// \param[in] _density Uniform density, in kg/m^3.
+      /// \param[out] _massMat The computed mass matrix.
+      /// \return False if the density is <= 0 or the enclosed volume is
+      /// zero, in which case _massMat is not modified.
+      public: bool MassMatrix(const T _density,
+                              MassMatrix3<T> &_massMat) const
+      {
+        if (_density <= 0 || this->ZeroVolume())
+          return false;
+
+        // A mesh wound clockwise has every integral negated
+        const T sign = this->volume6 < 0 ? -1 : 1;
+        const T volume = sign * this->volume6 / 6;
+        const Vector3<T> com = this->CenterOfMass();
+
+        // Second moments of the volume about the center of mass
+        const Vector3<T> c = sign * this->second / 120 - volume * com * com;
+        const Vector3<T> cCross = sign * this->secondCross / 120 -
+            volume * Vector3<T>(com.X() * com.Y(), com.X() * com.Z(),
+                                com.Y() * com.Z());
+
+        _massMat = MassMatrix3<T>(_density * volume,
+            _density * Vector3<T>(c.Y() + c.Z(), c.X() + c.Z(),
+                                  c.X() + c.Y()),
+            -_density * cCross);
+        return true;
+      }
+
+      /// \brief Get the mass matrix of the solid about its center of mass,
+      /// with axes parallel to the frame of the vertices.
+      /// \param[in] _mat Material that specifies a uniform density.
+      /// \param[out] _massMat The computed mass matrix.
+      /// \return False if the density is <= 0 or the enclosed volume is
+      /// zero, in which case _massMat is not modified.
+      public: bool MassMatrix(const Material &_mat,
+                              MassMatrix3<T> &_massMat) const
+      {
+        return this->MassMatrix(static_cast<T>(_mat.Density()), _massMat);
+      }
+
+      /// \brief Check if the enclosed volume is zero, or so small that
+      /// dividing by it would overflow.
+      /// \return True if the volume is zero.
+      private: bool ZeroVolume() const
+      {
+        return std::abs(this->volume6) < std::numeric_limits<T>::min();
+      }
+
+      /// \brief Add a range of triangles from an indexed triangle buffer.
+      /// \param[in] _vertices Vertex buffer.
+      /// \param[in] _indices Index buffer.
+      /// \param[in] _begin First triangle.
+      /// \param[in] _end End of the triangles.
+      private: template<typename Index>
+               void AddRange(const Vector3<T> *_vertices,
+                             const Index *_indices, const std::size_t _begin,
+                             const std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const Index *tri = _indices + 3 * i;
+          this->AddTriangle(_vertices[tri[0]], _vertices[tri[1]],
+                            _vertices[tri[2]]);
+        }
+      }
+
+      /// \brief Minimum number of triangles added by each thread.
+      private: static constexpr std::size_t kMinTrianglesPerThread = 16384;
+
+      /// \brief Sum of six times the signed tetrahedron volumes.
+      private: T volume6 = 0;
+
+      /// \brief Sum for the first moments of volume, which are 1/24 of
+      /// this value.
+      private: Vector3<T> first = Vector3<T>::Zero;
+
+      /// \brief Sum for the second moments of volume xx, yy and zz, which
+      /// are 1/120 of this value.
+      private: Vector3<T> second = Vector3<T>::Zero;
+
+      /// \brief Sum for the second moments of volume xy, xz and yz, which
+      /// are 1/120 of this value.
+      private: Vector3<T> secondCross = Vector3<T>::Zero;
+    };
+
+    /// \typedef MeshMassProperties<double> MeshMassPropertiesd
+    /// \brief MeshMassProperties with double precision.
+    typedef MeshMassProperties<double> MeshMassPropertiesd;
+
+    /// \typedef MeshMassProperties<float> MeshMassPropertiesf
+    /// \brief MeshMassProperties with float precision.
+    typedef MeshMassProperties<float> MeshMassPropertiesf;
+    }
+  }
+}
+#endif
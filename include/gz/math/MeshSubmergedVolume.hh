@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_MESHSUBMERGEDVOLUME_HH_
+#define GZ_MATH_MESHSUBMERGEDVOLUME_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <gz/math/Executor.hh>
+#include <gz/math/Plane.hh>
+#include <gz/math/Triangle3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class MeshSubmergedVolume MeshSubmergedVolume.hh
+    /// ignition/math/MeshSubmergedVolume.hh
+    /// \brief Computes the volume of a closed triangle mesh below a plane,
+    /// its centroid and the area of the mesh below the plane, which are
+    /// the submerged volume, center of buoyancy and wetted area of a hull
+    /// below a water plane.
+    ///
+    /// Each triangle is clipped against the plane, and the parts below it
+    /// are summed as signed tetrahedra, as in MeshMassProperties. The apex
+    /// of the tetrahedra is a point of the plane, so the flat cap that
+    /// closes the mesh at the plane has no volume and never needs to be
+    /// built. Only running sums are stored, so triangles can be added in
+    /// any order from an indexed buffer that is not copied, and nothing is
+    /// allocated unless the triangles are split among threads.
+    ///
+    /// The points below the plane are those at a negative Plane::Distance,
+    /// opposite the normal, as in Box::VolumeBelow. The plane is expressed
+    /// in the frame of the vertices, so a moving hull only needs the water
+    /// plane transformed into its frame, not its vertices moved. With many
+    /// hulls, computing each one with a single thread in its own task
+    /// keeps every call free of allocations.
+    ///
+    /// The mesh must be closed and consistently wound, with either
+    /// winding.
+    template<typename T>
+    class MeshSubmergedVolume
+    {
+      /// \brief Default constructor, for the plane z = 0 with a normal
+      /// along +Z.
+      public: MeshSubmergedVolume()
+        : MeshSubmergedVolume(Plane<T>(Vector3<T>::UnitZ, 0))
+      {
+      }
+
+      /// \brief Constructor.
+      /// \param[in] _plane The plane, in the frame of the vertices.
+      public: explicit MeshSubmergedVolume(const Plane<T> &_plane)
+      {
+        this->SetPlane(_plane);
+      }
+
+      /// \brief Set the plane and remove all the triangles.
+      /// \param[in] _plane The plane, in the frame of the vertices.
+      public: void SetPlane(const Plane<T> &_plane)
+      {
+        this->normal = _plane.Normal();
+        this->offset = _plane.Offset();
+        const T lengthSq = this->normal.SquaredLength();
+        this->origin = lengthSq > 0 ?
+            this->normal * (this->offset / lengthSq) : Vector3<T>::Zero;
+        this->Reset();
+      }
+
+      /// \brief Get the plane.
+      /// \return The plane, in the frame of the vertices.
+      public: Plane<T> ClipPlane() const
+      {
+        return Plane<T>(this->normal, this->offset);
+      }
+
+      /// \brief Add a triangle of the mesh.
+      /// \param[in] _v0 First vertex.
+      /// \param[in] _v1 Second vertex.
+      /// \param[in] _v2 Third vertex.
+      public: void AddTriangle(const Vector3<T> &_v0, const Vector3<T> &_v1,
+                               const Vector3<T> &_v2)
+      {
+        const Vector3<T> p[3] = {
+          _v0 - this->origin, _v1 - this->origin, _v2 - this->origin};
+        const T d[3] = {this->normal.Dot(p[0]), this->normal.Dot(p[1]),
+                        this->normal.Dot(p[2])};
+        const bool below[3] = {d[0] < 0, d[1] < 0, d[2] < 0};
+        const int count = below[0] + below[1] + below[2];
+        if (count == 0)
+          return;
+        if (count == 3)
+        {
+          this->AddPiece(p[0], p[1], p[2]);
+          return;
+        }
+
+        // Rotate the vertices, keeping the winding, so that the first one
+        // is alone on its side of the plane.
+        const bool lone = count == 1;
+        int k = 0;
+        while (below[k] != lone)
+          ++k;
+        const Vector3<T> &a = p[k];
+        const Vector3<T> &b = p[(k + 1) % 3];
+        const Vector3<T> &c = p[(k + 2) % 3];
+        const T da = d[k];
+        const Vector3<T> ab = a + (b - a) * (da / (da - d[(k + 1) % 3]));
+        const Vector3<T> ac = a + (c - a) * (da / (da - d[(k + 2) % 3]));
+
+        if (count == 1)
+        {
+          this->AddPiece(a, ab, ac);
+        }
+        else
+        {
+          this->AddPiece(ab, b, c);
+          this->AddPiece(ab, c, ac);
+        }
+      }
+
+      /// \brief Add a triangle of the mesh.
+      /// \param[in] _triangle Triangle to add.
+      public: void AddTriangle(const Triangle3<T> &_triangle)
+      {
+        this->AddTriangle(_triangle[0], _triangle[1], _triangle[2]);
+      }
+
+      /// \brief Add triangles from an indexed triangle buffer. Neither the
+      /// vertices nor the indices are copied.
+      /// \param[in] _vertices Vertex buffer.
+      /// \param[in] _indices Index buffer with three indices into
+      /// _vertices for each triangle.
+      /// \param[in] _triangleCount Number of triangles, which is a third of
+      /// the number of indices.
+      /// \param[in] _threads Number of threads used to add the triangles.
+      /// Each thread sums a contiguous block of triangles, and the blocks
+      /// are merged in order. A value of 0 uses the number of hardware
+      /// threads. Small meshes always use a single thread, which doesn't
+      /// allocate.
+      public: template<typename Index>
+              void AddTriangles(const Vector3<T> *_vertices,
+                                const Index *_indices,
+                                const std::size_t _triangleCount,
+                                const unsigned int _threads = 1)
+      {
+        std::size_t threads = _threads;
+        if (threads == 0)
+          threads = std::thread::hardware_concurrency();
+        threads = std::min(threads, _triangleCount / kMinTrianglesPerThread);
+        if (threads <= 1)
+        {
+          this->AddRange(_vertices, _indices, 0, _triangleCount);
+          return;
+        }
+
+        const std::size_t chunk = (_triangleCount + threads - 1) / threads;
+        std::vector<MeshSubmergedVolume<T>> partial(threads, this->Empty());
+        std::vector<std::thread> workers;
+        for (std::size_t t = 1; t < threads; ++t)
+        {
+          const std::size_t begin = std::min(_triangleCount, t * chunk);
+          const std::size_t end = std::min(_triangleCount, begin + chunk);
+          workers.emplace_back(
+              [&partial, _vertices, _indices, t, begin, end]()
+              {
+                partial[t].AddRange(_vertices, _indices, begin, end);
+              });
+        }
+        partial[0].AddRange(_vertices, _indices, 0,
+                            std::min(_triangleCount, chunk));
+
+        for (auto &worker : workers)
+          worker.join();
+        for (const auto &part : partial)
+          this->Merge(part);
+      }
+
+      /// \brief Add triangles from an indexed triangle buffer, running the
+      /// work on an executor. Each task sums a contiguous block of
+      /// triangles, and the blocks are merged in order.
+      /// \param[in] _vertices Vertex buffer.
+      /// \param[in] _indices Index buffer with three indices into
+      /// _vertices for each triangle.
+      /// \param[in] _triangleCount Number of triangles, which is a third of
+      /// the number of indices.
+      /// \param[in] _executor Executor running the blocks of triangles.
+      public: template<typename Index>
+              void AddTriangles(const Vector3<T> *_vertices,
+                                const Index *_indices,
+                                const std::size_t _triangleCount,
+                                Executor &_executor)
+      {
+        const std::size_t blocks =
+            _executor.BlockCount(_triangleCount, kMinTrianglesPerThread);
+        if (blocks <= 1)
+        {
+          this->AddRange(_vertices, _indices, 0, _triangleCount);
+          return;
+        }
+
+        std::vector<MeshSubmergedVolume<T>> partial(blocks, this->Empty());
+        _executor.ForEachBlock(_triangleCount, blocks,
+            [&](const std::size_t _begin, const std::size_t _end,
+                const std::size_t _block)
+            {
+              partial[_block].AddRange(_vertices, _indices, _begin, _end);
+            });
+        for (const auto &part : partial)
+          this->Merge(part);
+      }
+
+      /// \brief Add the triangles of another partial mesh clipped by the
+      /// same plane, as if they had been added to this one.
+      /// \param[in] _other Sums of the other part of the mesh.
+      public: void Merge(const MeshSubmergedVolume<T> &_other)
+      {
+        this->volume6 += _other.volume6;
+        this->first += _other.first;
+        this->area2 += _other.area2;
+      }
+
+      /// \brief Remove all the triangles, keeping the plane.
+      public: void Reset()
+      {
+        this->volume6 = 0;
+        this->first = Vector3<T>::Zero;
+        this->area2 = 0;
+      }
+
+      /// \brief Get the volume of the mesh below the plane.
+      /// \return Volume in m^3.
+      public: T Volume() const
+      {
+        return std::abs(this->volume6) / 6;
+      }
+
+      /// \brief Get the centroid of the volume below the plane, which is
+      /// the center of buoyancy.
+      /// \return Center of volume in the frame of the vertices, or nullopt
+      /// if no volume is below the plane.
+      public: std::optional<Vector3<T>> CenterOfVolume() const
+      {
+        // A volume below the smallest normal number would overflow
+        if (std::abs(this->volume6) < std::numeric_limits<T>::min())
+          return std::nullopt;
+        return this->origin + this->first / (4 * this->volume6);
+      }
+
+      /// \brief Get the area of the mesh below the plane, which is the
+      /// wetted surface of a hull. The cap at the plane is not included.
+      /// \return Area in m^2.
+      public: T WettedArea() const
+      {
+        return this->area2 / 2;
+      }
+
+      /// \brief Get an empty copy, with the same plane.
+      /// \return The copy.
+      private: MeshSubmergedVolume<T> Empty() const
+      {
+        MeshSubmergedVolume<T> res(*this);
+        res.Reset();
+        return res;
+      }
+
+      /// \brief Add a triangle that is entirely below the plane.
+      /// \param[in] _a First vertex, relative to the origin.
+      /// \param[in] _b Second vertex, relative to the origin.
+      /// \param[in] _c Third vertex, relative to the origin.
+      private: void AddPiece(const Vector3<T> &_a, const Vector3<T> &_b,
+                             const Vector3<T> &_c)
+      {
+        const T det = _a.Dot(_b.Cross(_c));
+        this->volume6 += det;
+        this->first += det * (_a + _b + _c);
+        this->area2 += (_b - _a).Cross(_c - _a).Length();
+      }
+
+      /// \brief Add a range of triangles from an indexed triangle buffer.
+      /// \param[in] _vertices Vertex buffer.
+      /// \param[in] _indices Index buffer.
+      /// \param[in] _begin First triangle.
+      /// \param[in] _end End of the triangles.
+      private: template<typename Index>
+               void AddRange(const Vector3<T> *_vertices,
+                             const Index *_indices, const std::size_t _begin,
+                             const std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const Index *tri = _indices + 3 * i;
+          this->AddTriangle(_vertices[tri[0]], _vertices[tri[1]],
+                            _vertices[tri[2]]);
+        }
+      }
+
+      /// \brief Minimum number of triangles added by each thread.
+      private: static constexpr std::size_t kMinTrianglesPerThread = 16384;
+
+      /// \brief Normal of the plane.
+      private: Vector3<T> normal = Vector3<T>::UnitZ;
+
+      /// \brief Offset of the plane along its normal.
+      private: T offset = 0;
+
+      /// \brief Point of the plane closest to the origin of the frame, the
+      /// apex of the tetrahedra.
+      private: Vector3<T> origin = Vector3<T>::Zero;
+
+      /// \brief Sum of six times the signed tetrahedron volumes.
+      private: T volume6 = 0;
+
+      /// \brief Sum for the first moments of volume about origin, which
+      /// are 1/24 of this value.
+      private: Vector3<T> first = Vector3<T>::Zero;
+
+      /// \brief Twice the area of the triangles below the plane.
+      private: T area2 = 0;
+    };
+
+    /// \typedef MeshSubmergedVolume<double> MeshSubmergedVolumed
+    /// \brief MeshSubmergedVolume with double precision.
+    typedef MeshSubmergedVolume<double> MeshSubmergedVolumed;
+
+    /// \typedef MeshSubmergedVolume<float> MeshSubmergedVolumef
+    /// \brief MeshSubmergedVolume with float precision.
+    typedef MeshSubmergedVolume<float> MeshSubmergedVolumef;
+    }
+  }
+}
+#endif
@@ -17,6 +17,8 @@
 #ifndef GZ_MATH_MOVINGWINDOWFILTER_HH_
 #define GZ_MATH_MOVINGWINDOWFILTER_HH_
 
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <vector>
 #include "gz/math/Export.hh"
@@ -29,6 +31,38 @@ namespace ignition
     inline namespace IGNITION_MATH_VERSION_NAMESPACE {
     //
 
+    namespace detail {
+      /// \brief Add a value to a running sum with Kahan compensation, so
+      /// that the rounding errors of long runs do not accumulate.
+      /// \param[in,out] _sum Running sum.
+      /// \param[in,out] _compensation Rounding error of the running sum,
+      /// to subtract from it.
+      /// \param[in] _val Value to add.
+      template<typename T>
+      void CompensatedAdd(T &_sum, T &_compensation, const T &_val)
+      {
+        const T y = _val - _compensation;
+        const T t = _sum + y;
+        _compensation = (t - _sum) - y;
+        _sum = t;
+      }
+
+      /// \brief Subtract a value from a running sum with Kahan
+      /// compensation.
+      /// \param[in,out] _sum Running sum.
+      /// \param[in,out] _compensation Rounding error of the running sum,
+      /// to subtract from it.
+      /// \param[in] _val Value to subtract.
+      template<typename T>
+      void CompensatedSubtract(T &_sum, T &_compensation, const T &_val)
+      {
+        const T y = _val + _compensation;
+        const T t = _sum - y;
+        _compensation = (t - _sum) + y;
+        _sum = t;
+      }
+    }  // namespace detail
+
     /// \cond
     /// \brief Private data members for MovingWindowFilter class.
     /// This must be in the header due to templatization.
@@ -50,6 +84,9 @@ namespace ignition
       /// \brief keep track of running sum
       public: T sum;
 
+      /// \brief rounding error of the running sum
+      public: T compensation;
+
       /// \brief keep track of number of elements
       public: unsigned int samples = 0;
     };
@@ -62,6 +99,7 @@ namespace ignition
       this->valHistory.resize(this->valWindowSize);
       this->valIter = this->valHistory.begin();
       this->sum = T();
+      this->compensation = T();
     }
     /// \endcond
 
@@ -69,6 +107,10 @@ namespace ignition
     /// version of MovingWindowFilter in the Ignition Common library.
     ///
     /// The default window size is 4.
+    ///
+    /// Update and Value are real-time safe: the history is allocated by
+    /// the constructor and SetWindowSize, and reused afterwards.
+    /// FixedMovingWindowFilter never allocates.
     template< typename T>
     class MovingWindowFilter
     {
@@ -123,7 +165,8 @@ namespace ignition
       // update sum and sample size with incoming _val
 
       // keep running sum
-      this->dataPtr->sum += _val;
+      detail::CompensatedAdd(
+          this->dataPtr->sum, this->dataPtr->compensation, _val);
 
       // shift pointer, wrap around if end has been reached.
       ++this->dataPtr->valIter;
@@ -139,7 +182,8 @@ namespace ignition
       if (this->dataPtr->samples > this->dataPtr->valWindowSize)
       {
         // subtract old value if buffer already filled
-        this->dataPtr->sum -= (*this->dataPtr->valIter);
+        detail::CompensatedSubtract(this->dataPtr->sum,
+            this->dataPtr->compensation, *this->dataPtr->valIter);
         // put new value into queue
         (*this->dataPtr->valIter) = _val;
         // reduce sample size
@@ -161,6 +205,7 @@ namespace ignition
       this->dataPtr->valHistory.resize(this->dataPtr->valWindowSize);
       this->dataPtr->valIter = this->dataPtr->valHistory.begin();
       this->dataPtr->sum = T();
+      this->dataPtr->compensation = T();
       this->dataPtr->samples = 0;
     }
 
@@ -182,8 +227,96 @@ namespace ignition
     template<typename T>
     T MovingWindowFilter<T>::Value() const
     {
-      return this->dataPtr->sum / static_cast<double>(this->dataPtr->samples);
+      return (this->dataPtr->sum - this->dataPtr->compensation) /
+        static_cast<double>(this->dataPtr->samples);
     }
+
+    /// \brief Moving window filter with a window size fixed at compile
+    /// time. The history is stored inline, so the filter never allocates,
+    /// and both Update() and Value() take constant time. The running sum is
+    /// compensated, as in MovingWindowFilter, so it does not drift over
+    /// long runs.
+    /// \tparam T Type of the filtered values.
+    /// \tparam N Size of the moving window.
+    template<typename T, std::size_t N>
+    class FixedMovingWindowFilter
+    {
+      static_assert(N > 0, "The window size must be positive");
+
+      /// \brief Update value of filter
+      /// \param[in] _val new raw value
+      public: void Update(const T _val)
+      {
+        if (this->samples == N)
+        {
+          // subtract old value if buffer already filled
+          detail::CompensatedSubtract(
+              this->sum, this->compensation, this->history[this->index]);
+        }
+        else
+        {
+          ++this->samples;
+        }
+        detail::CompensatedAdd(this->sum, this->compensation, _val);
+
+        // put new value into queue, wrap around if end has been reached.
+        this->history[this->index] = _val;
+        this->index = this->index + 1 == N ? 0 : this->index + 1;
+      }
+
+      /// \brief Clear the history.
+      public: void Reset()
+      {
+        this->index = 0;
+        this->samples = 0;
+        this->sum = T();
+        this->compensation = T();
+      }
+
+      /// \brief Get the window size.
+      /// \return The size of the moving window.
+      public: static constexpr std::size_t WindowSize()
+      {
+        return N;
+      }
+
+      /// \brief Get the number of values in the window.
+      /// \return Number of values, up to the window size.
+      public: std::size_t Samples() const
+      {
+        return this->samples;
+      }
+
+      /// \brief Get whether the window has been filled.
+      /// \return True if the window has been filled.
+      public: bool WindowFilled() const
+      {
+        return this->samples == N;
+      }
+
+      /// \brief Get filtered result
+      /// \return Latest filtered value
+      public: T Value() const
+      {
+        return (this->sum - this->compensation) /
+          static_cast<double>(this->samples);
+      }
+
+      /// \brief buffer history of raw values
+      private: std::array<T, N> history{};
+
+      /// \brief index of the oldest value in the buffer
+      private: std::size_t index = 0;
+
+      /// \brief number of values in the buffer
+      private: std::size_t samples = 0;
+
+      /// \brief running sum
+      private: T sum = T();
+
+      /// \brief rounding error of the running sum
+      private: T compensation = T();
+    };
     }
   }
 }
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_NORMALESTIMATOR_HH_
+#define GZ_MATH_NORMALESTIMATOR_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gz/math/Executor.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/KdTree3.hh>
+#include <gz/math/Matrix3SoA.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/Vector3SoA.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  //
+  // Forward declare private data
+  class NormalEstimatorPrivate;
+
+  /// \class NormalEstimator NormalEstimator.hh
+  /// ignition/math/NormalEstimator.hh
+  /// \brief Estimation of the surface normal and curvature at every point
+  /// of a cloud, from the covariance of its nearest neighbors.
+  ///
+  /// The normal is the eigenvector of the smallest eigenvalue of the
+  /// covariance, the direction of least variance. The curvature is the
+  /// surface variation l0 / (l0 + l1 + l2) of the eigenvalues, from 0 on
+  /// a plane to 1/3 for isotropic neighbors.
+  ///
+  /// Points are processed in blocks: the covariances of a block are
+  /// accumulated into a Matrix3SoA, and diagonalized together with
+  /// Matrix3SoA::SymmetricEigen. Blocks run in parallel, and each point
+  /// only depends on its neighbors, so results don't depend on the number
+  /// of threads.
+  ///
+  /// # Example usage
+  ///
+  /// ```{.cpp}
+  /// gz::math::NormalEstimator estimator;
+  /// estimator.SetNeighbors(16);
+  /// estimator.SetViewpoint(sensorPosition);
+  /// gz::math::Vector3SoAd normals;
+  /// std::vector<double> curvatures;
+  /// estimator.Estimate(scan, normals, curvatures);
+  /// ```
+  class IGNITION_MATH_VISIBLE NormalEstimator
+  {
+    /// \brief Constructor.
+    public: NormalEstimator();
+
+    /// \brief Copy constructor.
+    /// \param[in] _other Estimator to copy.
+    public: NormalEstimator(const NormalEstimator &_other);
+
+    /// \brief Destructor.
+    public: ~NormalEstimator();
+
+    /// \brief Assignment operator.
+    /// \param[in] _other Estimator to copy.
+    /// \return Reference to this object.
+    public: NormalEstimator &operator=(const NormalEstimator &_other);
+
+    /// \brief Set the number of nearest neighbors of each point.
+    /// \param[in] _neighbors Number of neighbors, including the point.
+    public: void SetNeighbors(const std::size_t _neighbors);
+
+    /// \brief Get the number of nearest neighbors of each point.
+    /// \return Number of neighbors. The default is 10.
+    public: std::size_t Neighbors() const;
+
+    /// \brief Set the maximum distance from a point to its neighbors.
+    /// Nearest neighbors farther than this are ignored, which keeps
+    /// sparse regions from blending distant surfaces.
+    /// \param[in] _radius Maximum distance, inclusive.
+    public: void SetRadius(const double _radius);
+
+    /// \brief Get the maximum distance from a point to its neighbors.
+    /// \return Maximum distance. The default is infinity.
+    public: double Radius() const;
+
+    /// \brief Set a viewpoint, such as the position of the sensor. Each
+    /// normal is then flipped to point towards it. Without a viewpoint,
+    /// the sign of the normals is arbitrary.
+    /// \param[in] _viewpoint The viewpoint.
+    public: void SetViewpoint(const Vector3d &_viewpoint);
+
+    /// \brief Remove the viewpoint.
+    public: void ClearViewpoint();
+
+    /// \brief Get whether a viewpoint is set.
+    /// \return True if SetViewpoint() was called since the last
+    /// ClearViewpoint().
+    public: bool HasViewpoint() const;
+
+    /// \brief Get the viewpoint.
+    /// \return The viewpoint, meaningful if HasViewpoint() is true.
+    public: const Vector3d &Viewpoint() const;
+
+    /// \brief Set the number of threads.
+    /// \param[in] _threads Number of threads. A value of 0 uses the
+    /// number of hardware threads.
+    public: void SetThreadCount(const unsigned int _threads);
+
+    /// \brief Get the number of threads.
+    /// \return Number of threads. The default is 1.
+    public: unsigned int ThreadCount() const;
+
+    /// \brief Set the executor used instead of threads of its own, such
+    /// as a ThreadPool shared with other batch operations. When set, the
+    /// thread count is ignored and the points are split into
+    /// Executor::BlockCount blocks.
+    /// \param[in] _executor The executor, or nullptr to use the thread
+    /// count again.
+    public: void SetExecutor(std::shared_ptr<Executor> _executor);
+
+    /// \brief Estimate the normal and curvature of every point.
+    /// \param[in] _points The points.
+    /// \param[out] _normals Unit normal of each point, resized to the
+    /// number of points. It is zero for points that are not finite, that
+    /// have fewer than 3 neighbors, or whose neighbors are collinear.
+    /// \param[out] _curvatures Surface variation of each point, resized to
+    /// the number of points. It is NaN where the normal is zero.
+    public: void Estimate(const Vector3SoAd &_points,
+                          Vector3SoAd &_normals,
+                          std::vector<double> &_curvatures) const;
+
+    /// \brief Estimate the normal and curvature of every point, with a
+    /// tree already built over them.
+    /// \param[in] _points The points.
+    /// \param[in] _tree Tree built over the same points, in the same
+    /// order.
+    /// \param[out] _normals Unit normal of each point.
+    /// \param[out] _curvatures Surface variation of each point.
+    /// \sa Estimate(const Vector3SoAd &, Vector3SoAd &,
+    /// std::vector<double> &) const
+    public: void Estimate(const Vector3SoAd &_points,
+                          const KdTree3d &_tree,
+                          Vector3SoAd &_normals,
+                          std::vector<double> &_curvatures) const;
+
+    /// \brief Compute the covariance of the neighbors of every point, such
+    /// as for generalized ICP.
+    /// \param[in] _points The points.
+    /// \param[in] _tree Tree built over the same points, in the same
+    /// order.
+    /// \param[out] _covariances Covariance of the neighbors of each point,
+    /// normalized by their number, resized to the number of points. It is
+    /// zero for points that are not finite or that have fewer than 3
+    /// neighbors.
+    public: void Covariances(const Vector3SoAd &_points,
+                             const KdTree3d &_tree,
+                             Matrix3SoAd &_covariances) const;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<NormalEstimatorPrivate> dataPtr;
+  };
+}
+}
+}
+#endif
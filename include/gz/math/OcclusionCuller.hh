@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_OCCLUSIONCULLER_HH_
+#define GZ_MATH_OCCLUSIONCULLER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/Frustum.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  //
+  // Forward declare private data
+  class OcclusionCullerPrivate;
+
+  /// \class OcclusionCuller OcclusionCuller.hh
+  /// ignition/math/OcclusionCuller.hh
+  /// \brief Software occlusion culling of boxes hidden behind occluders,
+  /// to use after Frustum culling in dense scenes.
+  ///
+  /// A small set of large occluders, such as walls, floors and big
+  /// furniture, is rasterized into a low resolution depth buffer seen
+  /// from the pose of a Frustum, with its field of view and aspect
+  /// ratio. Rows of pixels are rasterized with vector instructions when
+  /// ActiveSimdLevel() allows them. A hierarchy of tiles keeps the
+  /// farthest depth of each block of pixels, so that most boxes are
+  /// tested against a few tiles instead of every pixel they cover.
+  ///
+  /// A box is hidden when every pixel its projection touches holds an
+  /// occluder nearer than the nearest point of the box. Coverage is
+  /// sampled at pixel centers, so an object seen only through a gap
+  /// narrower than a pixel may be culled; otherwise the test is
+  /// conservative, and boxes that cross the near plane are visible.
+  ///
+  /// # Example usage
+  ///
+  /// \code{.cpp}
+  /// gz::math::OcclusionCuller culler;
+  /// culler.Reset(frustum);
+  /// culler.AddOccluders(walls);
+  ///
+  /// std::vector<uint64_t> visible;
+  /// frustum.Contains(boxes, visible);
+  /// culler.Cull(boxes, visible);
+  /// \endcode
+  class IGNITION_MATH_VISIBLE OcclusionCuller
+  {
+    /// \brief Default width of the depth buffer, in pixels.
+    public: static constexpr unsigned int kDefaultWidth = 256;
+
+    /// \brief Default height of the depth buffer, in pixels.
+    public: static constexpr unsigned int kDefaultHeight = 128;
+
+    /// \brief Default constructor, with a depth buffer of kDefaultWidth
+    /// by kDefaultHeight pixels and the view of a default Frustum.
+    public: OcclusionCuller();
+
+    /// \brief Constructor.
+    /// \param[in] _width Width of the depth buffer, in pixels. It is at
+    /// least 1.
+    /// \param[in] _height Height of the depth buffer, in pixels. It is at
+    /// least 1.
+    public: OcclusionCuller(const unsigned int _width,
+                            const unsigned int _height);
+
+    /// \brief Copy constructor.
+    /// \param[in] _other The culler to copy.
+    public: OcclusionCuller(const OcclusionCuller &_other);
+
+    /// \brief Move constructor.
+    /// \param[in] _other The culler to move.
+    public: OcclusionCuller(OcclusionCuller &&_other) noexcept;
+
+    /// \brief Destructor.
+    public: ~OcclusionCuller();
+
+    /// \brief Copy assignment operator.
+    /// \param[in] _other The culler to copy.
+    /// \return Reference to this culler.
+    public: OcclusionCuller &operator=(const OcclusionCuller &_other);
+
+    /// \brief Move assignment operator.
+    /// \param[in] _other The culler to move.
+    /// \return Reference to this culler.
+    public: OcclusionCuller &operator=(OcclusionCuller &&_other) noexcept;
+
+    /// \brief Get the width of the depth buffer.
+    /// \return Width in pixels.
+    public: unsigned int Width() const;
+
+    /// \brief Get the height of the depth buffer.
+    /// \return Height in pixels.
+    public: unsigned int Height() const;
+
+    /// \brief Set the view and remove all the occluders. Nothing is hidden
+    /// until occluders are added, except what lies beyond the far plane.
+    /// \param[in] _frustum The view. A near distance that is not positive
+    /// is replaced by a millionth of the far distance.
+    public: void Reset(const Frustum &_frustum);
+
+    /// \brief Add an occluding triangle. Both sides of it occlude.
+    /// \param[in] _v0 First vertex.
+    /// \param[in] _v1 Second vertex.
+    /// \param[in] _v2 Third vertex.
+    public: void AddOccluder(const Vector3d &_v0, const Vector3d &_v1,
+                             const Vector3d &_v2);
+
+    /// \brief Add a solid occluding box. Only the faces turned towards the
+    /// view are rasterized, and a box that contains the view point does
+    /// not occlude.
+    /// \param[in] _box The box.
+    public: void AddOccluder(const AxisAlignedBox &_box);
+
+    /// \brief Add solid occluding boxes.
+    /// \param[in] _boxes The boxes.
+    /// \sa AddOccluder(const AxisAlignedBox &)
+    public: void AddOccluders(const std::vector<AxisAlignedBox> &_boxes);
+
+    /// \brief Add occluding triangles from an indexed triangle buffer.
+    /// \param[in] _vertices Vertex buffer.
+    /// \param[in] _indices Index buffer with three indices into _vertices
+    /// for each triangle.
+    /// \param[in] _triangleCount Number of triangles.
+    public: void AddOccluders(const Vector3d *_vertices,
+                              const uint32_t *_indices,
+                              const std::size_t _triangleCount);
+
+    /// \brief Get the depth of the nearest occluder at a pixel.
+    /// \param[in] _x Column of the pixel, from the left.
+    /// \param[in] _y Row of the pixel, from the top.
+    /// \return Distance along the view direction, the far distance if no
+    /// occluder covers the pixel, or NaN if the pixel is outside of the
+    /// buffer.
+    public: double Depth(const unsigned int _x, const unsigned int _y) const;
+
+    /// \brief Check whether a box may be visible.
+    /// \param[in] _box The box.
+    /// \return False if the box is hidden by the occluders, beyond the far
+    /// plane, or outside of the view.
+    public: bool Visible(const AxisAlignedBox &_box) const;
+
+    /// \brief Check which boxes of a batch may be visible.
+    /// \param[in] _boxes Boxes to check.
+    /// \param[out] _visible Visibility bitmask. Bit (i % 64) of element
+    /// (i / 64) is set when box i may be visible. It is resized to hold
+    /// one bit per box, and unused bits are zero.
+    /// \return Number of boxes that may be visible.
+    public: std::size_t Visible(const std::vector<AxisAlignedBox> &_boxes,
+                                std::vector<uint64_t> &_visible) const;
+
+    /// \brief Clear the bits of the hidden boxes of a visibility bitmask,
+    /// such as the one filled by Frustum::Contains. Only the boxes whose
+    /// bit is set are tested.
+    /// \param[in] _boxes Boxes to check.
+    /// \param[in,out] _visible Visibility bitmask, see Visible(const
+    /// std::vector<AxisAlignedBox> &, std::vector<uint64_t> &). If its
+    /// size does not match the number of boxes, every box is tested.
+    /// \return Number of boxes that are still set in the bitmask.
+    public: std::size_t Cull(const std::vector<AxisAlignedBox> &_boxes,
+                             std::vector<uint64_t> &_visible) const;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<OcclusionCullerPrivate> dataPtr;
+  };
+}
+}
+}
+#endif
@@ -17,10 +17,15 @@
 #ifndef GZ_MATH_ORIENTEDBOX_HH_
 #define GZ_MATH_ORIENTEDBOX_HH_
 
+#include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <limits>
+#include <gz/math/AxisAlignedBox.hh>
 #include <gz/math/Helpers.hh>
 #include <gz/math/MassMatrix3.hh>
 #include <gz/math/Material.hh>
+#include <gz/math/Matrix3.hh>
 #include <gz/math/Matrix4.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/Vector3.hh>
@@ -39,7 +44,8 @@ namespace ignition
     class OrientedBox
     {
       /// \brief Default constructor
-      public: OrientedBox() : size(Vector3<T>::Zero), pose(Pose3<T>::Zero)
+      public: OrientedBox() : size(Vector3<T>::Zero), pose(Pose3<T>::Zero),
+                              rotation(Matrix3<T>::Identity)
       {
       }
 
@@ -48,7 +54,7 @@ namespace ignition
       /// value will be taken, so the size is non-negative.
       /// \param[in] _pose Box pose.
       public: OrientedBox(const Vector3<T> &_size, const Pose3<T> &_pose)
-          : size(_size.Abs()), pose(_pose)
+          : size(_size.Abs()), pose(_pose), rotation(_pose.Rot())
       {
       }
 
@@ -59,7 +65,8 @@ namespace ignition
       /// \param[in] _mat Material property for the box.
       public: OrientedBox(const Vector3<T> &_size, const Pose3<T> &_pose,
                   const Material &_mat)
-          : size(_size.Abs()), pose(_pose), material(_mat)
+          : size(_size.Abs()), pose(_pose), rotation(_pose.Rot()),
+            material(_mat)
       {
       }
 
@@ -67,7 +74,8 @@ namespace ignition
       /// \param[in] _size Box size, in its own coordinate frame. Its absolute
       /// value will be taken, so the size is non-negative.
       public: explicit OrientedBox(const Vector3<T> &_size)
-          : size(_size.Abs()), pose(Pose3<T>::Zero)
+          : size(_size.Abs()), pose(Pose3<T>::Zero),
+            rotation(Matrix3<T>::Identity)
       {
       }
 
@@ -77,14 +85,16 @@ namespace ignition
       /// \param[in] _mat Material property for the box.
       public: explicit OrientedBox(const Vector3<T> &_size,
                                    const Material &_mat)
-          : size(_size.Abs()), pose(Pose3<T>::Zero), material(_mat)
+          : size(_size.Abs()), pose(Pose3<T>::Zero),
+            rotation(Matrix3<T>::Identity), material(_mat)
       {
       }
 
       /// \brief Copy constructor.
       /// \param[in] _b OrientedBox to copy.
       public: OrientedBox(const OrientedBox<T> &_b)
-          : size(_b.size), pose(_b.pose), material(_b.material)
+          : size(_b.size), pose(_b.pose), rotation(_b.rotation),
+            material(_b.material)
       {
       }
 
@@ -142,6 +152,7 @@ namespace ignition
       public: void Pose(Pose3<T> &_pose)
       {
         this->pose = _pose;
+        this->rotation = Matrix3<T>(_pose.Rot());
       }
 
       /// \brief Assignment operator. Set this box to the parameter
@@ -151,6 +162,7 @@ namespace ignition
       {
         this->size = _b.size;
         this->pose = _b.pose;
+        this->rotation = _b.rotation;
         this->material = _b.material;
         return *this;
       }
@@ -199,6 +211,110 @@ namespace ignition
                p.Z() >= -this->size.Z()*0.5 && p.Z() <= this->size.Z()*0.5;
       }
 
+      /// \brief Check if each of many points lies inside the box. The
+      /// rotation into the frame of the box is only set up once, which
+      /// makes this faster than calling Contains for each point. Results
+      /// may differ from Contains by rounding for points on the faces.
+      /// \param[in] _points Array of _count points to check.
+      /// \param[in] _count Number of points.
+      /// \param[out] _results Array of at least _count values, written with
+      /// true if the corresponding point is inside the box.
+      /// \return Number of points inside the box.
+      public: std::size_t Contains(const Vector3d *_points,
+                                   const std::size_t _count,
+                                   bool *_results) const
+      {
+        T toLocal[3][3];
+        this->ToLocal(toLocal);
+        const double half[3] = {this->size.X() * 0.5, this->size.Y() * 0.5,
+                                this->size.Z() * 0.5};
+        const double pos[3] = {static_cast<double>(this->pose.Pos().X()),
+                               static_cast<double>(this->pose.Pos().Y()),
+                               static_cast<double>(this->pose.Pos().Z())};
+
+        std::size_t inside = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const double d[3] = {_points[i].X() - pos[0],
+                               _points[i].Y() - pos[1],
+                               _points[i].Z() - pos[2]};
+          bool in = true;
+          for (int a = 0; a < 3; ++a)
+          {
+            const double local = toLocal[a][0] * d[0] +
+                                 toLocal[a][1] * d[1] + toLocal[a][2] * d[2];
+            in = in && std::abs(local) <= half[a];
+          }
+          _results[i] = in;
+          inside += in;
+        }
+        return inside;
+      }
+
+      /// \brief Check if this box intersects another oriented box, using the
+      /// separating axis theorem. Boxes which touch intersect.
+      /// \param[in] _b Box to check.
+      /// \return True if the boxes intersect.
+      public: bool Intersects(const OrientedBox<T> &_b) const
+      {
+        T toLocal[3][3];
+        this->ToLocal(toLocal);
+        return this->Overlap(toLocal, _b.size, _b.rotation, _b.pose.Pos());
+      }
+
+      /// \brief Check if this box intersects an axis aligned box, using the
+      /// separating axis theorem. Boxes which touch intersect.
+      /// \param[in] _b Axis aligned box to check. A box whose minimum corner
+      /// is greater than its maximum corner, such as a default constructed
+      /// box, does not intersect anything.
+      /// \return True if the boxes intersect.
+      public: bool Intersects(const AxisAlignedBox &_b) const
+      {
+        if (_b.Min().X() > _b.Max().X() || _b.Min().Y() > _b.Max().Y() ||
+            _b.Min().Z() > _b.Max().Z())
+        {
+          return false;
+        }
+
+        const Vector3d extent = _b.Max() - _b.Min();
+        const Vector3d center = (_b.Min() + _b.Max()) * 0.5;
+        const Vector3<T> boxSize(static_cast<T>(extent.X()),
+            static_cast<T>(extent.Y()), static_cast<T>(extent.Z()));
+        const Vector3<T> boxCenter(static_cast<T>(center.X()),
+            static_cast<T>(center.Y()), static_cast<T>(center.Z()));
+        T toLocal[3][3];
+        this->ToLocal(toLocal);
+        return this->Overlap(toLocal, boxSize, Matrix3<T>::Identity,
+            boxCenter);
+      }
+
+      /// \brief Check if this box intersects each of many oriented boxes.
+      /// The rotation of this box into the frame of each other box is only
+      /// set up once, which makes this faster than calling Intersects for
+      /// each box.
+      /// \param[in] _boxes Array of _count boxes to check.
+      /// \param[in] _count Number of boxes.
+      /// \param[out] _results Array of at least _count values, written with
+      /// true if the corresponding box intersects this box.
+      /// \return Number of boxes which intersect this box.
+      public: std::size_t Intersects(const OrientedBox<T> *_boxes,
+                                     const std::size_t _count,
+                                     bool *_results) const
+      {
+        T toLocal[3][3];
+        this->ToLocal(toLocal);
+
+        std::size_t intersections = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const OrientedBox<T> &b = _boxes[i];
+          _results[i] = this->Overlap(toLocal, b.size, b.rotation,
+                                      b.pose.Pos());
+          intersections += _results[i];
+        }
+        return intersections;
+      }
+
       /// \brief Get the material associated with this box.
       /// \return The material assigned to this box.
       public: const gz::math::Material &Material() const
@@ -267,12 +383,108 @@ namespace ignition
         return _massMat.SetFromBox(this->material, this->size);
       }
 
+      /// \brief Get the transpose of the cached rotation, which rotates
+      /// world vectors into the frame of this box.
+      /// \param[out] _toLocal Rotation matrix.
+      private: void ToLocal(T _toLocal[3][3]) const
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          for (int j = 0; j < 3; ++j)
+            _toLocal[i][j] = this->rotation(j, i);
+        }
+      }
+
+      /// \brief Separating axis test of this box and another box, with the
+      /// 15 axes from Ericson, "Real-Time Collision Detection", section
+      /// 4.4.1. The test returns as soon as a separating axis is found.
+      /// \param[in] _toLocal Rotation from the world into the frame of this
+      /// box, from ToLocal.
+      /// \param[in] _size Size of the other box.
+      /// \param[in] _rot Rotation of the other box.
+      /// \param[in] _pos Center of the other box.
+      /// \return True if there is no separating axis.
+      private: bool Overlap(const T _toLocal[3][3], const Vector3<T> &_size,
+                            const Matrix3<T> &_rot,
+                            const Vector3<T> &_pos) const
+      {
+        // The epsilon keeps the cross products of nearly parallel edges,
+        // which are close to zero, from reporting a separating axis.
+        const T epsilon = std::numeric_limits<T>::epsilon() * 100;
+
+        // Half sizes, and the center of the other box in the frame of this
+        // box
+        const T a[3] = {this->size.X() / 2, this->size.Y() / 2,
+                        this->size.Z() / 2};
+        const T b[3] = {_size.X() / 2, _size.Y() / 2, _size.Z() / 2};
+        const Vector3<T> offset = _pos - this->pose.Pos();
+        T t[3];
+        for (int i = 0; i < 3; ++i)
+        {
+          t[i] = _toLocal[i][0] * offset.X() + _toLocal[i][1] * offset.Y() +
+                 _toLocal[i][2] * offset.Z();
+        }
+
+        // Axes of this box. Each row of the rotation of the other box in
+        // the frame of this box is only computed once the previous axes
+        // did not separate the boxes.
+        T r[3][3];
+        T absR[3][3];
+        for (int i = 0; i < 3; ++i)
+        {
+          for (int j = 0; j < 3; ++j)
+          {
+            r[i][j] = _toLocal[i][0] * _rot(0, j) +
+                      _toLocal[i][1] * _rot(1, j) +
+                      _toLocal[i][2] * _rot(2, j);
+            absR[i][j] = std::abs(r[i][j]) + epsilon;
+          }
+
+          if (std::abs(t[i]) >
+              a[i] + b[0] * absR[i][0] + b[1] * absR[i][1] + b[2] * absR[i][2])
+          {
+            return false;
+          }
+        }
+
+        // Axes of the second box
+        for (int j = 0; j < 3; ++j)
+        {
+          if (std::abs(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j]) >
+              a[0] * absR[0][j] + a[1] * absR[1][j] + a[2] * absR[2][j] + b[j])
+          {
+            return false;
+          }
+        }
+
+        // Cross products of an axis of each box
+        for (int i = 0; i < 3; ++i)
+        {
+          const int i1 = (i + 1) % 3;
+          const int i2 = (i + 2) % 3;
+          for (int j = 0; j < 3; ++j)
+          {
+            const int j1 = (j + 1) % 3;
+            const int j2 = (j + 2) % 3;
+            const T ra = a[i1] * absR[i2][j] + a[i2] * absR[i1][j];
+            const T rb = b[j1] * absR[i][j2] + b[j2] * absR[i][j1];
+            if (std::abs(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > ra + rb)
+              return false;
+          }
+        }
+
+        return true;
+      }
+
       /// \brief The size of the box in its local frame.
       private: Vector3<T> size;
 
       /// \brief The pose of the center of the box.
       private: Pose3<T> pose;
 
+      /// \brief Rotation matrix of the pose, cached for intersection tests.
+      private: Matrix3<T> rotation;
+
       /// \brief The box's material.
       private: gz::math::Material material;
     };
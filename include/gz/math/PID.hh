@@ -34,6 +34,10 @@ namespace ignition
     /// keeps track of PID-error states and control inputs given
     /// the state of a system and a user specified target state.
     /// It includes a user-adjustable command offset term (feed-forward).
+    ///
+    /// All the members other than the constructors are real-time safe:
+    /// they never allocate memory, take locks or make system calls, so
+    /// Update can run in hard real-time control loops.
     // cppcheck-suppress class_X_Y
     class IGNITION_MATH_VISIBLE PID
     {
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_PIDBANK_HH_
+#define GZ_MATH_PIDBANK_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gz/math/PID.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declarations.
+    class PIDBankPrivate;
+
+    /// \class PIDBank PIDBank.hh ignition/math/PIDBank.hh
+    /// \brief A set of independent PID controllers that are updated
+    /// together, such as the joint controllers of many robots.
+    ///
+    /// Each loop has its own gains, limits and state, and follows the same
+    /// equations as PID::Update. The gains and state are stored as arrays,
+    /// one per quantity, and an update processes every loop in a single
+    /// branch-free pass over contiguous memory. Disabled limits are stored
+    /// as infinite bounds, so that clamping needs no test.
+    class IGNITION_MATH_VISIBLE PIDBank
+    {
+      /// \brief Default constructor. Creates an empty bank.
+      public: PIDBank();
+
+      /// \brief Create a bank of loops with the same gains and limits.
+      /// \param[in] _size Number of loops.
+      /// \param[in] _pid Controller whose gains and limits are copied to
+      /// every loop. Its state is not copied.
+      public: PIDBank(const std::size_t _size, const PID &_pid);
+
+      /// \brief Copy constructor.
+      /// \param[in] _bank Bank to copy.
+      public: PIDBank(const PIDBank &_bank);
+
+      /// \brief Destructor.
+      public: ~PIDBank();
+
+      /// \brief Assignment operator.
+      /// \param[in] _bank Bank to copy.
+      /// \return Reference to this bank.
+      public: PIDBank &operator=(const PIDBank &_bank);
+
+      /// \brief Change the number of loops. Existing loops are kept, and
+      /// new loops get the gains and limits of _pid and a reset state.
+      /// \param[in] _size Number of loops.
+      /// \param[in] _pid Controller whose gains and limits are copied to
+      /// the new loops.
+      public: void Resize(const std::size_t _size, const PID &_pid = PID());
+
+      /// \brief Append a loop.
+      /// \param[in] _pid Controller whose gains and limits are copied. Its
+      /// state is not copied.
+      /// \return Index of the new loop.
+      public: std::size_t Add(const PID &_pid);
+
+      /// \brief Get the number of loops.
+      /// \return Number of loops.
+      public: std::size_t Size() const;
+
+      /// \brief Set the gains and limits of a loop, and reset its state.
+      /// \param[in] _index Index of the loop.
+      /// \param[in] _pid Controller whose gains and limits are copied.
+      /// \return False if _index is out of range.
+      public: bool Set(const std::size_t _index, const PID &_pid);
+
+      /// \brief Get a loop as a PID controller.
+      /// \param[in] _index Index of the loop.
+      /// \param[out] _pid Set to the gains, limits and command of the
+      /// loop. Its errors are reset.
+      /// \return False if _index is out of range, in which case _pid is
+      /// unchanged.
+      public: bool Loop(const std::size_t _index, PID &_pid) const;
+
+      /// \brief Reset the errors and commands of every loop.
+      public: void Reset();
+
+      /// \brief Update every loop, as PID::Update(const double, const
+      /// std::chrono::duration<double> &) does for one loop. The error rate
+      /// is the finite difference with the error of the previous update.
+      /// \param[in] _errors Error of each loop (p_state - p_target).
+      /// \param[in] _dt Change in time since the last update.
+      /// \param[out] _cmds Command of each loop, resized to Size(). As in
+      /// PID::Update, it is zero for loops whose error is not finite and
+      /// for every loop if _dt is zero, and those loops are not updated.
+      /// \return False if _errors does not have Size() elements.
+      public: bool Update(const std::vector<double> &_errors,
+                          const std::chrono::duration<double> &_dt,
+                          std::vector<double> &_cmds);
+
+      /// \brief Update every loop with a known error rate, as
+      /// PID::Update(const double, double, const
+      /// std::chrono::duration<double> &) does for one loop.
+      /// \param[in] _errors Error of each loop (p_state - p_target).
+      /// \param[in] _errorRates Error rate of each loop.
+      /// \param[in] _dt Change in time since the last update.
+      /// \param[out] _cmds Command of each loop, resized to Size(). It is
+      /// zero for loops whose error or error rate is not finite and for
+      /// every loop if _dt is zero, and those loops are not updated.
+      /// \return False if _errors or _errorRates do not have Size()
+      /// elements.
+      public: bool Update(const std::vector<double> &_errors,
+                          const std::vector<double> &_errorRates,
+                          const std::chrono::duration<double> &_dt,
+                          std::vector<double> &_cmds);
+
+      /// \brief Get the current command of every loop.
+      /// \return Commands, Size() of them.
+      public: const std::vector<double> &Cmd() const;
+
+      /// \brief Get the error terms of a loop, as PID::Errors.
+      /// \param[in] _index Index of the loop.
+      /// \param[out] _pe The proportional error.
+      /// \param[out] _ie The integral of gain times error.
+      /// \param[out] _de The derivative error.
+      /// \return False if _index is out of range.
+      public: bool Errors(const std::size_t _index, double &_pe,
+                          double &_ie, double &_de) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PIDBankPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
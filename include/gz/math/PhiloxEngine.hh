@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_PHILOXENGINE_HH_
+#define GZ_MATH_PHILOXENGINE_HH_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <gz/math/config.hh>
+#include <gz/math/Export.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class PhiloxEngine PhiloxEngine.hh ignition/math/PhiloxEngine.hh
+    /// \brief Counter based random number engine, implementing the
+    /// Philox4x32-10 generator of Salmon et al., "Parallel random numbers:
+    /// as easy as 1, 2, 3" (SC 2011).
+    ///
+    /// Each output is a pure function of a seed, a stream index and the
+    /// position of the output in the stream. Any number of streams can be
+    /// used in parallel, and a stream can jump to any position in constant
+    /// time, so results do not depend on how work is split between
+    /// threads. The raw output is the same on every platform.
+    ///
+    /// The engine satisfies the requirements of a uniform random bit
+    /// generator, and can be used with the standard distributions:
+    ///
+    ///     PhiloxEngine engine(seed, sampleIndex);
+    ///     NormalRealDist normal(0, 1);
+    ///     double noise = normal(engine);
+    class IGNITION_MATH_VISIBLE PhiloxEngine
+    {
+      /// \brief Type of the generated numbers.
+      public: using result_type = uint32_t;
+
+      /// \brief Get the smallest generated number.
+      /// \return Zero.
+      public: static constexpr result_type min()
+      {
+        return 0;
+      }
+
+      /// \brief Get the largest generated number.
+      /// \return The largest 32 bit unsigned integer.
+      public: static constexpr result_type max()
+      {
+        return std::numeric_limits<result_type>::max();
+      }
+
+      /// \brief Default constructor. Uses seed 0, stream 0 and starts at
+      /// position 0.
+      public: PhiloxEngine() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _seed Seed, used as the key of the generator.
+      /// \param[in] _stream Index of the stream.
+      /// \param[in] _position Index of the first output in the stream.
+      public: explicit PhiloxEngine(uint64_t _seed, uint64_t _stream = 0,
+                                    uint64_t _position = 0);
+
+      /// \brief Restart the engine on a new seed and stream, at position 0.
+      /// \param[in] _seed Seed, used as the key of the generator.
+      /// \param[in] _stream Index of the stream.
+      public: void Seed(uint64_t _seed, uint64_t _stream = 0);
+
+      /// \brief Get the seed.
+      /// \return The seed.
+      public: uint64_t Seed() const;
+
+      /// \brief Get the stream index.
+      /// \return The stream index.
+      public: uint64_t Stream() const;
+
+      /// \brief Move to a position of the stream, in constant time.
+      /// \param[in] _position Index of the next output in the stream.
+      public: void Seek(uint64_t _position);
+
+      /// \brief Get the position in the stream.
+      /// \return Index of the next output in the stream.
+      public: uint64_t Position() const;
+
+      /// \brief Skip outputs, in constant time.
+      /// \param[in] _count Number of outputs to skip.
+      public: void discard(unsigned long long _count);
+
+      /// \brief Generate the next number of the stream.
+      /// \return The number.
+      public: inline result_type operator()()
+      {
+        const uint64_t block = this->position >> 2;
+        if (!this->bufferValid || block != this->bufferBlock)
+          this->Generate(block);
+        return this->buffer[this->position++ & 3];
+      }
+
+      /// \brief Compute one block of four outputs.
+      /// \param[in] _seed Seed, used as the key of the generator.
+      /// \param[in] _stream Index of the stream.
+      /// \param[in] _block Index of the block in the stream. Block i holds
+      /// the outputs at positions 4i to 4i + 3.
+      /// \return The four outputs of the block.
+      public: static std::array<uint32_t, 4> Block(uint64_t _seed,
+                  uint64_t _stream, uint64_t _block);
+
+      /// \brief Equality operator.
+      /// \param[in] _engine Engine to compare with.
+      /// \return True if both engines produce the same sequence from now on.
+      public: bool operator==(const PhiloxEngine &_engine) const;
+
+      /// \brief Inequality operator.
+      /// \param[in] _engine Engine to compare with.
+      /// \return True if the engines produce different sequences.
+      public: bool operator!=(const PhiloxEngine &_engine) const;
+
+      /// \brief Fill the buffer with a block.
+      /// \param[in] _block Index of the block.
+      private: void Generate(uint64_t _block);
+
+      /// \brief Seed.
+      private: uint64_t seed{0};
+
+      /// \brief Stream index.
+      private: uint64_t stream{0};
+
+      /// \brief Index of the next output.
+      private: uint64_t position{0};
+
+      /// \brief Index of the block in the buffer.
+      private: uint64_t bufferBlock{0};
+
+      /// \brief True if the buffer holds block bufferBlock.
+      private: bool bufferValid{false};
+
+      /// \brief Outputs of the current block.
+      private: std::array<uint32_t, 4> buffer{{0, 0, 0, 0}};
+    };
+    }
+  }
+}
+#endif
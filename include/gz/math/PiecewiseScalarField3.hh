@@ -18,14 +18,19 @@
 #define GZ_MATH_PIECEWISE_SCALAR_FIELD3_HH_
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <utility>
 #include <vector>
 
+#include <gz/math/Diagnostics.hh>
 #include <gz/math/Region3.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/config.hh>
+#include <gz/math/detail/RegionGridIndex.hh>
 
 namespace ignition
 {
@@ -53,6 +58,12 @@ namespace ignition
     /// \tparam ScalarT a numeric type for which std::numeric_limits<> traits
     ///   have been specialized.
     ///
+    /// Fields with many pieces build a uniform grid over the bounded extent
+    /// of their regions, where each cell lists the pieces whose regions
+    /// overlap it. Evaluation then only checks the pieces listed in the cell
+    /// of the argument, in their original order, which gives the same
+    /// result as checking every piece.
+    ///
     /// ## Example
     ///
     /// \snippet examples/piecewise_scalar_field3_example.cc complete
@@ -75,25 +86,62 @@ namespace ignition
       public: explicit PiecewiseScalarField3(const std::vector<Piece> &_pieces)
       : pieces(_pieces)
       {
+        if (this->pieces.size() >= kMinPiecesForIndex)
+        {
+          this->regionIndex.Build(this->pieces.size(),
+              [this](size_t _i) -> const Region3<ScalarT> &
+              {
+                return this->pieces[_i].region;
+              });
+        }
+
+        // Pieces which may overlap each piece, in order. Without an index,
+        // these are all the following pieces.
+        std::vector<size_t> candidates;
+        std::vector<size_t> lastSeen(this->pieces.size(), kNoPiece);
         for (size_t i = 0; i < pieces.size(); ++i)
         {
           if (pieces[i].region.Empty())
           {
-            std::cerr << "Region #" << i << " (" << pieces[i].region
-                      << ") in piecewise scalar field definition is empty."
-                      << std::endl;
+            IGN_MATH_DIAGNOSTIC("Region #" << i << " (" << pieces[i].region
+                << ") in piecewise scalar field definition is empty.");
+          }
+
+          candidates.clear();
+          if (!this->regionIndex.Built())
+          {
+            for (size_t j = i + 1; j < pieces.size(); ++j)
+              candidates.push_back(j);
           }
-          for (size_t j = i + 1; j < pieces.size(); ++j)
+          else if (!pieces[i].region.Empty())
+          {
+            this->regionIndex.ForEachCell(pieces[i].region, [&](size_t _cell)
+            {
+              for (const size_t *c = this->regionIndex.CellBegin(_cell);
+                   c != this->regionIndex.CellEnd(_cell); ++c)
+              {
+                const size_t j = *c;
+                if (j > i && lastSeen[j] != i)
+                {
+                  lastSeen[j] = i;
+                  candidates.push_back(j);
+                }
+              }
+            });
+            std::sort(candidates.begin(), candidates.end());
+          }
+
+          for (const size_t j : candidates)
           {
             if (pieces[i].region.Intersects(pieces[j].region))
             {
-              std::cerr << "Detected overlap between regions in "
-                        << "piecewise scalar field definition: "
-                        << "region #" << i << " (" << pieces[i].region
-                        << ") overlaps with region #" << j << " ("
-                        << pieces[j].region << "). Region #" << i
-                        << " will take precedence when overlapping."
-                        << std::endl;
+              this->overlapping = true;
+              IGN_MATH_DIAGNOSTIC("Detected overlap between regions in "
+                  << "piecewise scalar field definition: "
+                  << "region #" << i << " (" << pieces[i].region
+                  << ") overlaps with region #" << j << " ("
+                  << pieces[j].region << "). Region #" << i
+                  << " will take precedence when overlapping.");
             }
           }
         }
@@ -114,17 +162,41 @@ namespace ignition
       ///   if the scalar field is not defined at `_p`
       public: ScalarT Evaluate(const Vector3<ScalarT> &_p) const
       {
-        auto it = std::find_if(
-            this->pieces.begin(), this->pieces.end(),
-            [&](const Piece &piece)
-            {
-              return piece.region.Contains(_p);
-            });
-        if (it == this->pieces.end())
+        const size_t index = this->PieceIndex(_p);
+        if (index == kNoPiece)
         {
           return std::numeric_limits<ScalarT>::quiet_NaN();
         }
-        return it->field(_p);
+        return this->pieces[index].field(_p);
+      }
+
+      /// \brief Evaluate the piecewise scalar field at many points. When
+      /// the regions do not overlap, the piece of the previous point is
+      /// checked first, which is faster for points which are near each
+      /// other, such as the points of a grid or a trajectory.
+      /// \param[in] _points Array of _count piecewise scalar field arguments
+      /// \param[in] _count Number of points
+      /// \param[out] _values Array of at least _count values, written with
+      /// the result of evaluating the field at each point, or NaN where the
+      /// scalar field is not defined
+      public: void Evaluate(const Vector3<ScalarT> *_points,
+                            const size_t _count, ScalarT *_values) const
+      {
+        size_t previous = kNoPiece;
+        for (size_t i = 0; i < _count; ++i)
+        {
+          const Vector3<ScalarT> &p = _points[i];
+          if (this->overlapping || previous == kNoPiece ||
+              !this->pieces[previous].region.Contains(p))
+          {
+            previous = this->PieceIndex(p);
+          }
+
+          if (previous == kNoPiece)
+            _values[i] = std::numeric_limits<ScalarT>::quiet_NaN();
+          else
+            _values[i] = this->pieces[previous].field(p);
+        }
       }
 
       /// \brief Call operator overload
@@ -141,6 +213,8 @@ namespace ignition
       /// Note that, since this method computes the minimum
       /// for each region independently, it implicitly assumes
       /// continuity in the boundaries between regions, if any.
+      /// The minimum of each piece is computed on the first call
+      /// and reused by later calls and by copies of this field.
       /// \param[out] _pMin scalar field argument that yields
       ///   the minimum, or NaN if the scalar field is not
       ///   defined anywhere (i.e. default constructed)
@@ -154,21 +228,10 @@ namespace ignition
           _pMin = Vector3<ScalarT>::NaN;
           return std::numeric_limits<ScalarT>::quiet_NaN();
         }
-        ScalarT yMin = std::numeric_limits<ScalarT>::infinity();
-        for (const Piece &piece : this->pieces)
-        {
-          if (!piece.region.Empty())
-          {
-            Vector3<ScalarT> p;
-            const ScalarT y = piece.field.Minimum(piece.region, p);
-            if (y < yMin)
-            {
-              _pMin = p;
-              yMin = y;
-            }
-          }
-        }
-        return yMin;
+        const std::shared_ptr<const Minima> minima = this->PieceMinima();
+        if (minima->index != kNoPiece)
+          _pMin = minima->points[minima->index];
+        return minima->minimum;
       }
 
       /// \brief Compute the piecewise scalar field minimum
@@ -181,6 +244,85 @@ namespace ignition
         return this->Minimum(pMin);
       }
 
+      /// \brief Compute the piecewise scalar field minimum in a `_region`
+      /// Like Minimum(Vector3<ScalarT> &), this method computes the minimum
+      /// for each region independently. Only the pieces which may intersect
+      /// `_region` are checked, and the cached minimum of a piece is used
+      /// when its region is inside `_region` or when it cannot be lower
+      /// than the minimum found so far.
+      /// \param[in] _region scalar field argument set to check
+      /// \param[out] _pMin scalar field argument that yields
+      ///   the minimum, or NaN if the scalar field is not
+      ///   defined anywhere in `_region`
+      /// \return the scalar field minimum in the given `_region`,
+      ///   or NaN if the scalar field is not defined anywhere
+      ///   in `_region`
+      public: ScalarT Minimum(const Region3<ScalarT> &_region,
+                              Vector3<ScalarT> &_pMin) const
+      {
+        _pMin = Vector3<ScalarT>::NaN;
+        if (this->pieces.empty() || _region.Empty())
+          return std::numeric_limits<ScalarT>::quiet_NaN();
+
+        std::vector<size_t> candidates;
+        if (!this->regionIndex.Built())
+        {
+          candidates.resize(this->pieces.size());
+          for (size_t i = 0; i < this->pieces.size(); ++i)
+            candidates[i] = i;
+        }
+        else
+        {
+          this->regionIndex.ForEachCell(_region, [&](size_t _cell)
+          {
+            candidates.insert(candidates.end(),
+                this->regionIndex.CellBegin(_cell),
+                this->regionIndex.CellEnd(_cell));
+          });
+          std::sort(candidates.begin(), candidates.end());
+          candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                           candidates.end());
+        }
+
+        const std::shared_ptr<const Minima> minima = this->PieceMinima();
+        bool defined = false;
+        ScalarT yMin = std::numeric_limits<ScalarT>::infinity();
+        for (const size_t i : candidates)
+        {
+          const Piece &piece = this->pieces[i];
+          if (!piece.region.Intersects(_region))
+            continue;
+          defined = true;
+
+          // A piece is never lower in part of its region than in all of it
+          if (!(minima->values[i] < yMin))
+            continue;
+          ScalarT y = minima->values[i];
+          Vector3<ScalarT> p = minima->points[i];
+          if (!_region.Contains(piece.region))
+            y = piece.field.Minimum(piece.region.Intersection(_region), p);
+          if (y < yMin)
+          {
+            _pMin = p;
+            yMin = y;
+          }
+        }
+        if (!defined)
+          return std::numeric_limits<ScalarT>::quiet_NaN();
+        return yMin;
+      }
+
+      /// \brief Compute the piecewise scalar field minimum in a `_region`
+      /// \param[in] _region scalar field argument set to check
+      /// \return the scalar field minimum in the given `_region`,
+      ///   or NaN if the scalar field is not defined anywhere
+      ///   in `_region`
+      public: ScalarT Minimum(const Region3<ScalarT> &_region) const
+      {
+        Vector3<ScalarT> pMin;
+        return this->Minimum(_region, pMin);
+      }
+
       /// \brief Stream insertion operator
       /// \param _out output stream
       /// \param _field SeparableScalarField3 to output
@@ -204,8 +346,143 @@ namespace ignition
                     << _field.pieces.back().region;
       }
 
+      /// \brief Minimum of each piece in its region
+      private: struct Minima
+      {
+        /// \brief Minimum of each piece, or infinity for empty regions
+        std::vector<ScalarT> values;
+
+        /// \brief Argument that yields the minimum of each piece
+        std::vector<Vector3<ScalarT>> points;
+
+        /// \brief Lowest minimum of all pieces
+        ScalarT minimum = std::numeric_limits<ScalarT>::infinity();
+
+        /// \brief Index of the first piece with the lowest minimum, or
+        /// kNoPiece if all regions are empty
+        size_t index = kNoPiece;
+      };
+
+      /// \brief Holder of the lazily computed minima of the pieces. It is
+      /// only ever set to minima computed from the same pieces, which copies
+      /// of the field share, so it is read and written atomically and
+      /// concurrent const calls at worst compute the minima more than once.
+      private: class MinimaCache
+      {
+        /// \brief Default constructor
+        public: MinimaCache() = default;
+
+        /// \brief Copy constructor
+        /// \param[in] _other Cache to share the minima of
+        public: MinimaCache(const MinimaCache &_other)
+        : minima(_other.Load())
+        {
+        }
+
+        /// \brief Copy assignment operator
+        /// \param[in] _other Cache to share the minima of
+        /// \return Reference to this cache
+        public: MinimaCache &operator=(const MinimaCache &_other)
+        {
+          this->Store(_other.Load());
+          return *this;
+        }
+
+        /// \brief Get the minima
+        /// \return The minima, or null if not computed yet
+        public: std::shared_ptr<const Minima> Load() const
+        {
+          return std::atomic_load(&this->minima);
+        }
+
+        /// \brief Set the minima
+        /// \param[in] _minima Minima of the pieces
+        public: void Store(std::shared_ptr<const Minima> _minima)
+        {
+          std::atomic_store(&this->minima, std::move(_minima));
+        }
+
+        /// \brief Minima of the pieces, or null if not computed yet
+        private: std::shared_ptr<const Minima> minima;
+      };
+
+      /// \brief Get the minimum of each piece, computing them on first use.
+      /// \return Minima of the pieces
+      private: std::shared_ptr<const Minima> PieceMinima() const
+      {
+        std::shared_ptr<const Minima> cached = this->minimaCache.Load();
+        if (cached)
+          return cached;
+
+        auto minima = std::make_shared<Minima>();
+        minima->values.resize(this->pieces.size(),
+                              std::numeric_limits<ScalarT>::infinity());
+        minima->points.resize(this->pieces.size(), Vector3<ScalarT>::NaN);
+        for (size_t i = 0; i < this->pieces.size(); ++i)
+        {
+          const Piece &piece = this->pieces[i];
+          if (piece.region.Empty())
+            continue;
+          minima->values[i] =
+              piece.field.Minimum(piece.region, minima->points[i]);
+          if (minima->values[i] < minima->minimum)
+          {
+            minima->minimum = minima->values[i];
+            minima->index = i;
+          }
+        }
+        this->minimaCache.Store(minima);
+        return minima;
+      }
+
+      /// \brief Get the first piece whose region contains a point.
+      /// \param[in] _p Point to look up
+      /// \return Index of the piece, or kNoPiece if no region contains _p
+      private: size_t PieceIndex(const Vector3<ScalarT> &_p) const
+      {
+        if (!this->regionIndex.Built())
+        {
+          for (size_t i = 0; i < this->pieces.size(); ++i)
+          {
+            if (this->pieces[i].region.Contains(_p))
+              return i;
+          }
+          return kNoPiece;
+        }
+
+        // No region contains a NaN coordinate, which has no cell either
+        if (std::isnan(_p.X()) || std::isnan(_p.Y()) || std::isnan(_p.Z()))
+          return kNoPiece;
+
+        const size_t cell = this->regionIndex.Cell(_p);
+        for (const size_t *c = this->regionIndex.CellBegin(cell);
+             c != this->regionIndex.CellEnd(cell); ++c)
+        {
+          if (this->pieces[*c].region.Contains(_p))
+            return *c;
+        }
+        return kNoPiece;
+      }
+
+      /// \brief Index returned when no piece contains a point
+      private: static constexpr size_t kNoPiece =
+          std::numeric_limits<size_t>::max();
+
+      /// \brief Minimum number of pieces for which a grid index is built
+      private: static constexpr size_t kMinPiecesForIndex = 16;
+
       /// \brief Scalar fields Pn and the regions Rn in which these are defined
       private: std::vector<Piece> pieces;
+
+      /// \brief Whether any two regions overlap
+      private: bool overlapping = false;
+
+      /// \brief Grid index of the regions of the pieces. Not built for
+      /// fields with few pieces.
+      private: detail::RegionGridIndex<ScalarT> regionIndex;
+
+      /// \brief Minimum of each piece, computed by the first Minimum call
+      private: mutable MinimaCache minimaCache;
     };
 
     template<typename ScalarField3T>
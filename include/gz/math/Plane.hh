@@ -20,9 +20,16 @@
 #include <gz/math/AxisAlignedBox.hh>
 #include <gz/math/Vector2.hh>
 #include <gz/math/Vector3.hh>
+#include <gz/math/Vector3SoA.hh>
 #include <gz/math/config.hh>
 #include <gz/math/Line2.hh>
 #include <gz/math/Quaternion.hh>
+#include <gz/math/detail/PlaneSimd.hh>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <optional>
 
 namespace ignition
@@ -168,6 +175,93 @@ namespace ignition
         return std::nullopt;
       }
 
+      /// \brief Intersect many rays, stored as structures-of-arrays, with
+      /// the plane. Each hit is the same point as Intersection() of the
+      /// corresponding ray, but hits behind the origin of a ray are
+      /// rejected, so that camera rays only hit the plane in front of the
+      /// camera. This is vectorized for float and double.
+      /// \param[in] _origins Origin of each ray.
+      /// \param[in] _directions Direction of each ray, not necessarily
+      /// normalized. Only the first _origins.Size() directions are used if
+      /// there are more.
+      /// \param[out] _hits Resized to the number of rays, and written with
+      /// the hit point of each ray, or NaN for the rays that miss.
+      /// \param[out] _valid Array of at least one value per ray, written
+      /// with 1 for the rays that hit the plane and 0 for the others, or
+      /// nullptr.
+      /// \param[out] _distances Array of at least one value per ray,
+      /// written with the parameter t of each hit, such that the hit is
+      /// origin + t * direction, or NaN for the rays that miss. This is the
+      /// distance to the hit for normalized directions. It can be nullptr.
+      /// \param[in] _tolerance The tolerance for determining a ray is
+      /// parallel to the plane, as in Intersection().
+      /// \return Number of rays that hit the plane.
+      public: std::size_t Intersections(const Vector3SoA<T> &_origins,
+                                        const Vector3SoA<T> &_directions,
+                                        Vector3SoA<T> &_hits,
+                                        uint8_t *_valid, T *_distances,
+                                        const double _tolerance = 1e-6) const
+      {
+        const std::size_t count =
+          std::min(_origins.Size(), _directions.Size());
+        _hits.Resize(count);
+
+        // Same basis as in Intersection, for planes of finite size
+        const bool bounded = this->Size() != Vector2<T>(0, 0);
+        Vector3<T> xAxis, yAxis;
+        if (bounded)
+        {
+          auto dotProduct = Vector3<T>::UnitZ.Dot(this->Normal());
+          auto angle = acos(dotProduct / this->Normal().Length());
+          auto axis = Vector3<T>::UnitZ.Cross(this->Normal().Normalized());
+          Quaternion<T> rotation(axis, angle);
+          xAxis = rotation * Vector3<T>::UnitX;
+          yAxis = rotation * Vector3<T>::UnitY;
+        }
+
+        T *hx = _hits.XData();
+        T *hy = _hits.YData();
+        T *hz = _hits.ZData();
+        T t[kBlockSize];
+        uint8_t valid[kBlockSize];
+        std::size_t hits = 0;
+        for (std::size_t begin = 0; begin < count; begin += kBlockSize)
+        {
+          const std::size_t n = std::min(kBlockSize, count - begin);
+          T *tOut = _distances ? _distances + begin : t;
+          uint8_t *validOut = _valid ? _valid + begin : valid;
+          hits += detail::PlaneRayHits(this->normal.X(), this->normal.Y(),
+              this->normal.Z(), this->d, static_cast<T>(_tolerance),
+              _origins.XData() + begin, _origins.YData() + begin,
+              _origins.ZData() + begin, _directions.XData() + begin,
+              _directions.YData() + begin, _directions.ZData() + begin, n,
+              hx + begin, hy + begin, hz + begin, tOut, validOut);
+
+          if (!bounded)
+            continue;
+
+          // Check if the hits are within the size bounds
+          const T nan = std::numeric_limits<T>::quiet_NaN();
+          for (std::size_t k = 0; k < n; ++k)
+          {
+            const std::size_t i = begin + k;
+            if (!validOut[k])
+              continue;
+
+            const Vector3<T> hit(hx[i], hy[i], hz[i]);
+            if (std::abs(xAxis.Dot(hit)) < this->Size().X() / 2 &&
+                std::abs(yAxis.Dot(hit)) < this->Size().Y() / 2)
+            {
+              continue;
+            }
+            hx[i] = hy[i] = hz[i] = tOut[k] = nan;
+            validOut[k] = 0;
+            --hits;
+          }
+        }
+        return hits;
+      }
+
       /// \brief The side of the plane a point is on.
       /// \param[in] _point The 3D point to check.
       /// \return Plane::NEGATIVE_SIDE if the distance from the point to the
@@ -207,6 +301,178 @@ namespace ignition
         return BOTH_SIDE;
       }
 
+      /// \brief Compute the signed distances from many points to the plane.
+      /// Each result is the same as Distance() of the corresponding point.
+      /// \param[in] _points Array of _count points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _distances Array of at least _count values, written
+      /// with the signed distance of each point.
+      public: void Distances(const Vector3<T> *_points,
+                             const std::size_t _count, T *_distances) const
+      {
+        Plane<T>::Classify(this, 1, _points, _count, _distances, nullptr);
+      }
+
+      /// \brief Compute the signed distances from many points, stored as a
+      /// structure-of-arrays, to the plane.
+      /// \param[in] _points Points to measure.
+      /// \param[out] _distances Array of at least _points.Size() values,
+      /// written with the signed distance of each point.
+      public: void Distances(const Vector3SoA<T> &_points,
+                             T *_distances) const
+      {
+        Plane<T>::Classify(this, 1, _points, _distances, nullptr);
+      }
+
+      /// \brief Find the side of the plane of many points. Each result is
+      /// the same as Side() of the corresponding point.
+      /// \param[in] _points Array of _count points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _sides Array of at least _count values, written with
+      /// the side of each point.
+      public: void Sides(const Vector3<T> *_points, const std::size_t _count,
+                         PlaneSide *_sides) const
+      {
+        Plane<T>::Classify(this, 1, _points, _count, nullptr, _sides);
+      }
+
+      /// \brief Find the side of the plane of many points stored as a
+      /// structure-of-arrays.
+      /// \param[in] _points Points to check.
+      /// \param[out] _sides Array of at least _points.Size() values, written
+      /// with the side of each point.
+      public: void Sides(const Vector3SoA<T> &_points, PlaneSide *_sides) const
+      {
+        Plane<T>::Classify(this, 1, _points, nullptr, _sides);
+      }
+
+      /// \brief Find the side of the plane of many boxes. Each result is the
+      /// same as Side() of the corresponding box.
+      /// \param[in] _boxes Array of _count boxes.
+      /// \param[in] _count Number of boxes.
+      /// \param[out] _sides Array of at least _count values, written with
+      /// the side of each box.
+      public: void Sides(const math::AxisAlignedBox *_boxes,
+                         const std::size_t _count, PlaneSide *_sides) const
+      {
+        Plane<T>::Sides(this, 1, _boxes, _count, _sides);
+      }
+
+      /// \brief Compute the signed distances from many points to several
+      /// planes. Each point is read once for all of the planes.
+      /// \param[in] _planes Array of _planeCount planes.
+      /// \param[in] _planeCount Number of planes.
+      /// \param[in] _points Array of _count points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _distances Array of at least _planeCount * _count
+      /// values. The distance from point i to plane p is written to
+      /// _distances[p * _count + i].
+      public: static void Distances(const Plane<T> *_planes,
+                                    const std::size_t _planeCount,
+                                    const Vector3<T> *_points,
+                                    const std::size_t _count, T *_distances)
+      {
+        Plane<T>::Classify(_planes, _planeCount, _points, _count,
+                           _distances, nullptr);
+      }
+
+      /// \brief Compute the signed distances from many points, stored as a
+      /// structure-of-arrays, to several planes.
+      /// \param[in] _planes Array of _planeCount planes.
+      /// \param[in] _planeCount Number of planes.
+      /// \param[in] _points Points to measure.
+      /// \param[out] _distances Array of at least
+      /// _planeCount * _points.Size() values. The distance from point i to
+      /// plane p is written to _distances[p * _points.Size() + i].
+      public: static void Distances(const Plane<T> *_planes,
+                                    const std::size_t _planeCount,
+                                    const Vector3SoA<T> &_points,
+                                    T *_distances)
+      {
+        Plane<T>::Classify(_planes, _planeCount, _points, _distances,
+                           nullptr);
+      }
+
+      /// \brief Find the sides of several planes of many points. Each point
+      /// is read once for all of the planes.
+      /// \param[in] _planes Array of _planeCount planes.
+      /// \param[in] _planeCount Number of planes.
+      /// \param[in] _points Array of _count points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _sides Array of at least _planeCount * _count values.
+      /// The side of plane p of point i is written to _sides[p * _count + i].
+      public: static void Sides(const Plane<T> *_planes,
+                                const std::size_t _planeCount,
+                                const Vector3<T> *_points,
+                                const std::size_t _count, PlaneSide *_sides)
+      {
+        Plane<T>::Classify(_planes, _planeCount, _points, _count, nullptr,
+                           _sides);
+      }
+
+      /// \brief Find the sides of several planes of many points stored as a
+      /// structure-of-arrays.
+      /// \param[in] _planes Array of _planeCount planes.
+      /// \param[in] _planeCount Number of planes.
+      /// \param[in] _points Points to check.
+      /// \param[out] _sides Array of at least _planeCount * _points.Size()
+      /// values. The side of plane p of point i is written to
+      /// _sides[p * _points.Size() + i].
+      public: static void Sides(const Plane<T> *_planes,
+                                const std::size_t _planeCount,
+                                const Vector3SoA<T> &_points,
+                                PlaneSide *_sides)
+      {
+        Plane<T>::Classify(_planes, _planeCount, _points, nullptr, _sides);
+      }
+
+      /// \brief Find the sides of several planes of many boxes. Each box is
+      /// read once for all of the planes.
+      /// \param[in] _planes Array of _planeCount planes.
+      /// \param[in] _planeCount Number of planes.
+      /// \param[in] _boxes Array of _count boxes.
+      /// \param[in] _count Number of boxes.
+      /// \param[out] _sides Array of at least _planeCount * _count values.
+      /// The side of plane p of box i is written to _sides[p * _count + i].
+      public: static void Sides(const Plane<T> *_planes,
+                                const std::size_t _planeCount,
+                                const math::AxisAlignedBox *_boxes,
+                                const std::size_t _count, PlaneSide *_sides)
+      {
+        T cx[kBlockSize], cy[kBlockSize], cz[kBlockSize];
+        T hx[kBlockSize], hy[kBlockSize], hz[kBlockSize];
+        T dist[kBlockSize], radius[kBlockSize];
+        for (std::size_t begin = 0; begin < _count; begin += kBlockSize)
+        {
+          const std::size_t n = std::min(kBlockSize, _count - begin);
+          for (std::size_t k = 0; k < n; ++k)
+          {
+            // Same center and half size as in Side(const AxisAlignedBox &)
+            const math::AxisAlignedBox &box = _boxes[begin + k];
+            const Vector3d center = box.Center();
+            cx[k] = center.X();
+            cy[k] = center.Y();
+            cz[k] = center.Z();
+            hx[k] = box.XLength() / 2.0;
+            hy[k] = box.YLength() / 2.0;
+            hz[k] = box.ZLength() / 2.0;
+          }
+
+          for (std::size_t p = 0; p < _planeCount; ++p)
+          {
+            const Vector3<T> &normal = _planes[p].normal;
+            detail::PlaneDistances(normal.X(), normal.Y(), normal.Z(),
+                                   _planes[p].d, cx, cy, cz, n, dist);
+            // Vector3::AbsDot of the normal and the non-negative half size.
+            detail::PlaneDistances(std::abs(normal.X()), std::abs(normal.Y()),
+                                   std::abs(normal.Z()), T(0), hx, hy, hz, n,
+                                   radius);
+            detail::PlaneClassify(dist, radius, n, BOTH_SIDE,
+                                  _sides + p * _count + begin);
+          }
+        }
+      }
+
       /// \brief Get distance to the plane give an origin and direction
       /// \param[in] _origin the origin
       /// \param[in] _dir a direction
@@ -271,6 +537,106 @@ namespace ignition
         return *this;
       }
 
+      /// \brief Classify points read from an array against several planes.
+      /// Points are copied by blocks into component arrays, which are then
+      /// classified against every plane.
+      /// \param[in] _planes Array of _planeCount planes.
+      /// \param[in] _planeCount Number of planes.
+      /// \param[in] _points Array of _count points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _distances Array of _planeCount * _count distances, or
+      /// nullptr.
+      /// \param[out] _sides Array of _planeCount * _count sides, or nullptr.
+      private: static void Classify(const Plane<T> *_planes,
+                                    const std::size_t _planeCount,
+                                    const Vector3<T> *_points,
+                                    const std::size_t _count,
+                                    T *_distances, PlaneSide *_sides)
+      {
+        T x[kBlockSize], y[kBlockSize], z[kBlockSize];
+        for (std::size_t begin = 0; begin < _count; begin += kBlockSize)
+        {
+          const std::size_t n = std::min(kBlockSize, _count - begin);
+          for (std::size_t k = 0; k < n; ++k)
+          {
+            x[k] = _points[begin + k].X();
+            y[k] = _points[begin + k].Y();
+            z[k] = _points[begin + k].Z();
+          }
+          Plane<T>::ClassifyBlock(_planes, _planeCount, x, y, z, n, _count,
+              _distances ? _distances + begin : nullptr,
+              _sides ? _sides + begin : nullptr);
+        }
+      }
+
+      /// \brief Classify points stored as a structure-of-arrays against
+      /// several planes.
+      /// \param[in] _planes Array of _planeCount planes.
+      /// \param[in] _planeCount Number of planes.
+      /// \param[in] _points Points to classify.
+      /// \param[out] _distances Array of _planeCount * _points.Size()
+      /// distances, or nullptr.
+      /// \param[out] _sides Array of _planeCount * _points.Size() sides, or
+      /// nullptr.
+      private: static void Classify(const Plane<T> *_planes,
+                                    const std::size_t _planeCount,
+                                    const Vector3SoA<T> &_points,
+                                    T *_distances, PlaneSide *_sides)
+      {
+        const std::size_t count = _points.Size();
+        const T *x = _points.XData();
+        const T *y = _points.YData();
+        const T *z = _points.ZData();
+        for (std::size_t begin = 0; begin < count; begin += kBlockSize)
+        {
+          const std::size_t n = std::min(kBlockSize, count - begin);
+          Plane<T>::ClassifyBlock(_planes, _planeCount, x + begin, y + begin,
+              z + begin, n, count,
+              _distances ? _distances + begin : nullptr,
+              _sides ? _sides + begin : nullptr);
+        }
+      }
+
+      /// \brief Classify a block of at most kBlockSize points against
+      /// several planes.
+      /// \param[in] _planes Array of _planeCount planes.
+      /// \param[in] _planeCount Number of planes.
+      /// \param[in] _x Array of _count x coordinates.
+      /// \param[in] _y Array of _count y coordinates.
+      /// \param[in] _z Array of _count z coordinates.
+      /// \param[in] _count Number of points in the block.
+      /// \param[in] _stride Distance between the outputs of two planes.
+      /// \param[out] _distances Distances of the block to the first plane,
+      /// or nullptr.
+      /// \param[out] _sides Sides of the block of the first plane, or
+      /// nullptr.
+      private: static void ClassifyBlock(const Plane<T> *_planes,
+                                         const std::size_t _planeCount,
+                                         const T *_x, const T *_y,
+                                         const T *_z,
+                                         const std::size_t _count,
+                                         const std::size_t _stride,
+                                         T *_distances, PlaneSide *_sides)
+      {
+        T dist[kBlockSize];
+        for (std::size_t p = 0; p < _planeCount; ++p)
+        {
+          const Vector3<T> &normal = _planes[p].normal;
+          T *out = _distances ? _distances + p * _stride : dist;
+          detail::PlaneDistances(normal.X(), normal.Y(), normal.Z(),
+                                 _planes[p].d, _x, _y, _z, _count, out);
+          if (_sides)
+          {
+            detail::PlaneClassify(out, static_cast<const T *>(nullptr),
+                                  _count, NO_SIDE, _sides + p * _stride);
+          }
+        }
+      }
+
+      /// \brief Number of points or boxes classified at a time by the batch
+      /// functions, sized so that the block buffers stay in L1 cache.
+      private: static constexpr std::size_t kBlockSize = 256;
+
       /// \brief Plane normal
       private: Vector3<T> normal;
 
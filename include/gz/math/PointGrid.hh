@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_POINTGRID_HH_
+#define GZ_MATH_POINTGRID_HH_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  // Forward declaration.
+  class PointGridPrivate;
+
+  /// \class PointGrid PointGrid.hh ignition/math/PointGrid.hh
+  /// \brief A uniform grid of cubic cells over a set of points, with the
+  /// occupied cells stored in a hash table, used to find the points near
+  /// a location without scanning all of them.
+  ///
+  /// Only the cells that hold points use memory, so the grid may span any
+  /// extent. The points are copied in the order of their cells, so that
+  /// the points of a cell are contiguous in memory. Points are referred to
+  /// by their index in the vector passed to Build(). Points that are not
+  /// finite are ignored.
+  ///
+  /// Queries are fastest when the cells are about the size of the
+  /// searched radius. The cell size may be chosen by the caller, or
+  /// derived from the bounds and number of points. Points far from the
+  /// others at more than about a million cells are merged into the
+  /// outermost cells, which slows the queries down but keeps them exact.
+  /// PointOctree adapts better to points that are unevenly spread.
+  ///
+  /// The grid does not track changes to the points; call Build() again
+  /// after they move.
+  class IGNITION_MATH_VISIBLE PointGrid
+  {
+    /// \brief Index reported when no point is found.
+    public: static constexpr std::size_t kNoPoint =
+      std::numeric_limits<std::size_t>::max();
+
+    /// \brief Default constructor. Creates an empty grid whose cell size
+    /// is chosen by Build().
+    public: PointGrid();
+
+    /// \brief Constructor. Creates an empty grid.
+    /// \param[in] _cellSize Side of the cells. Values that are not
+    /// positive and finite let Build() choose the size.
+    public: explicit PointGrid(const double _cellSize);
+
+    /// \brief Copy constructor.
+    /// \param[in] _grid Grid to copy.
+    public: PointGrid(const PointGrid &_grid);
+
+    /// \brief Destructor.
+    public: ~PointGrid();
+
+    /// \brief Assignment operator.
+    /// \param[in] _grid Grid to copy.
+    /// \return Reference to this grid.
+    public: PointGrid &operator=(const PointGrid &_grid);
+
+    /// \brief Get the side of the cells.
+    /// \return The cell size used by the last Build(), or the requested
+    /// one before the first build. It is 0 if Build() chooses the size and
+    /// has not been called.
+    public: double CellSize() const;
+
+    /// \brief Set the side of the cells used by the next Build().
+    /// \param[in] _cellSize Side of the cells. Values that are not
+    /// positive and finite let Build() choose the size, so that a cell
+    /// holds about two points on average.
+    public: void SetCellSize(const double _cellSize);
+
+    /// \brief Rebuild the grid over a new set of points.
+    /// \param[in] _points Points to insert.
+    public: void Build(const std::vector<Vector3d> &_points);
+
+    /// \brief Rebuild the grid over a new set of points using several
+    /// threads. The resulting grid is the same as with a single thread.
+    /// \param[in] _points Points to insert.
+    /// \param[in] _threads Number of threads used to find the cells of the
+    /// points. A value of 0 uses the number of hardware threads. Small sets
+    /// of points always use a single thread.
+    public: void Build(const std::vector<Vector3d> &_points,
+                       const unsigned int _threads);
+
+    /// \brief Get the number of points in the grid, which excludes the
+    /// points that are not finite.
+    /// \return Number of points.
+    public: std::size_t Size() const;
+
+    /// \brief Get the number of cells that hold points.
+    /// \return Number of occupied cells.
+    public: std::size_t CellCount() const;
+
+    /// \brief Get the bounds of the points.
+    /// \return The smallest box containing all the points, or a default
+    /// box if the grid is empty.
+    public: AxisAlignedBox Bounds() const;
+
+    /// \brief Find the point nearest to a location.
+    /// \param[in] _point The location.
+    /// \param[in] _maxDistance Maximum allowed distance from the location.
+    /// \return A boolean, double, std::size_t tuple. The boolean value is
+    /// true if a point is within _maxDistance of the location. The double
+    /// is the distance to the nearest point, and zero when there is none.
+    /// The std::size_t is the index of the nearest point, or kNoPoint. The
+    /// lowest index is reported when several points are at the same
+    /// distance.
+    public: std::tuple<bool, double, std::size_t> Nearest(
+                const Vector3d &_point, const double _maxDistance) const;
+
+    /// \brief Find the points nearest to a location, searching the cells
+    /// in growing shells around the cell of the location.
+    /// \param[in] _point The location.
+    /// \param[in] _k Number of points to find.
+    /// \param[out] _indices Indices of the _k nearest points, or of all
+    /// the points if there are fewer, nearest first. Points at the same
+    /// distance are sorted by index. The vector is cleared first.
+    public: void Nearest(const Vector3d &_point, const std::size_t _k,
+                         std::vector<std::size_t> &_indices) const;
+
+    /// \brief Find the points within a distance of a location.
+    /// \param[in] _center The location.
+    /// \param[in] _radius Maximum distance, inclusive.
+    /// \param[out] _indices Indices of the points, in no particular order.
+    /// The vector is cleared first.
+    public: void Overlaps(const Vector3d &_center, const double _radius,
+                          std::vector<std::size_t> &_indices) const;
+
+    /// \brief Find the points inside a box, including its boundary.
+    /// \param[in] _box Box to check.
+    /// \param[out] _indices Indices of the points, in no particular order.
+    /// The vector is cleared first.
+    public: void Overlaps(const AxisAlignedBox &_box,
+                          std::vector<std::size_t> &_indices) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+    /// \brief Private data pointer.
+    private: std::unique_ptr<PointGridPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+  };
+  }
+}
+}
+#endif
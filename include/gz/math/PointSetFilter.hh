@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_POINTSETFILTER_HH_
+#define GZ_MATH_POINTSETFILTER_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include <gz/math/Export.hh>
+#include <gz/math/OrientedBox.hh>
+#include <gz/math/Vector3SoA.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  /// \class PointSetFilter PointSetFilter.hh ignition/math/PointSetFilter.hh
+  /// \brief Filters that thin out a set of points or remove the points
+  /// that lie away from the others, as is usually done to scans before
+  /// clustering them or fitting shapes to them.
+  ///
+  /// The filters read the points from a Vector3SoAd. The outlier filters
+  /// report the indices of the points they keep, in increasing order,
+  /// which Select() turns into a new set of points, while the crop filters
+  /// compact the points they keep in place. Points that are not
+  /// finite are always removed. Every filter may run on several threads,
+  /// and gives the same result with any number of them. A thread count of
+  /// 0 uses the number of hardware threads, and small sets of points
+  /// always use a single thread.
+  class IGNITION_MATH_VISIBLE PointSetFilter
+  {
+    /// \brief Replace the points in each cubic cell of a grid by their
+    /// centroid. The cells are aligned with the origin, so the same
+    /// region of space falls into the same cell from one set of points to
+    /// the next.
+    /// \param[in] _points Points to downsample.
+    /// \param[in] _voxelSize Side of the cells, which must be positive.
+    /// \param[out] _centroids One centroid per occupied cell, ordered by
+    /// the lowest index of the points in the cell. It is cleared first.
+    /// \param[in] _threads Number of threads.
+    /// \return False if _voxelSize is not positive and finite, or if the
+    /// points span more than 2^21 cells along an axis; _centroids is then
+    /// empty.
+    public: static bool VoxelDownsample(const Vector3SoAd &_points,
+                const double _voxelSize, Vector3SoAd &_centroids,
+                const unsigned int _threads = 1);
+
+    /// \brief Remove the points that have too few neighbors within a
+    /// distance.
+    /// \param[in] _points Points to filter.
+    /// \param[in] _radius Distance within which neighbors are counted,
+    /// inclusive. It must be positive.
+    /// \param[in] _minNeighbors Minimum number of other points within
+    /// _radius for a point to be kept. Duplicates of a point count as
+    /// neighbors.
+    /// \param[out] _inliers Indices of the points that are kept, in
+    /// increasing order. It is cleared first.
+    /// \param[in] _threads Number of threads.
+    /// \return False if _radius is not positive and finite; _inliers is
+    /// then empty.
+    public: static bool RemoveRadiusOutliers(const Vector3SoAd &_points,
+                const double _radius, const std::size_t _minNeighbors,
+                std::vector<std::size_t> &_inliers,
+                const unsigned int _threads = 1);
+
+    /// \brief Remove the points whose mean distance to their _k nearest
+    /// neighbors is more than _stddevRatio standard deviations above the
+    /// mean of that distance over all the points.
+    /// \param[in] _points Points to filter.
+    /// \param[in] _k Number of neighbors of each point, which must be
+    /// positive. Fewer are used when there are not enough points.
+    /// \param[in] _stddevRatio Number of standard deviations above the
+    /// mean beyond which a point is removed. Negative values remove points
+    /// that are closer than average to their neighbors as well.
+    /// \param[out] _inliers Indices of the points that are kept, in
+    /// increasing order. It is cleared first.
+    /// \param[in] _threads Number of threads.
+    /// \return False if _k is zero or _stddevRatio is not finite;
+    /// _inliers is then empty.
+    public: static bool RemoveStatisticalOutliers(
+                const Vector3SoAd &_points, const std::size_t _k,
+                const double _stddevRatio,
+                std::vector<std::size_t> &_inliers,
+                const unsigned int _threads = 1);
+
+    /// \brief Keep the points inside an oriented box, or remove them,
+    /// such as the returns of a scan that hit the robot itself. The
+    /// points are moved into place, keeping their order, and the set is
+    /// shrunk to the points that are kept.
+    /// \param[in,out] _points Points to crop.
+    /// \param[in] _box The box. Points on its faces are inside.
+    /// \param[in] _removeInside True to remove the points inside the box
+    /// instead of keeping them.
+    /// \param[in] _threads Number of threads.
+    /// \return Number of points kept.
+    public: static std::size_t CropBox(Vector3SoAd &_points,
+                const OrientedBoxd &_box, const bool _removeInside = false,
+                const unsigned int _threads = 1);
+
+    /// \brief Keep the points inside any of several oriented boxes, or
+    /// remove them, as CropBox does with one box. The rotation into the
+    /// frame of each box is set up once, and the points are tested with
+    /// SSE2 or AVX, as allowed by ActiveSimdLevel(), in blocks which stay
+    /// in cache while every box is tested.
+    /// \param[in,out] _points Points to crop.
+    /// \param[in] _boxes Array of _count boxes.
+    /// \param[in] _count Number of boxes. With no boxes, no point is
+    /// inside a box.
+    /// \param[in] _removeInside True to remove the points inside any of
+    /// the boxes instead of keeping them.
+    /// \param[in] _threads Number of threads.
+    /// \return Number of points kept.
+    public: static std::size_t CropBoxes(Vector3SoAd &_points,
+                const OrientedBoxd *_boxes, const std::size_t _count,
+                const bool _removeInside = false,
+                const unsigned int _threads = 1);
+
+    /// \brief Copy a subset of points, such as the inliers reported by
+    /// one of the outlier filters.
+    /// \param[in] _points Points to copy from.
+    /// \param[in] _indices Indices of the points to copy, which must be
+    /// lower than _points.Size().
+    /// \param[out] _selected The points, in the order of _indices.
+    public: static void Select(const Vector3SoAd &_points,
+                               const std::vector<std::size_t> &_indices,
+                               Vector3SoAd &_selected);
+  };
+  }
+}
+}
+#endif
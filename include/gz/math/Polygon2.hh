@@ -0,0 +1,458 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_POLYGON2_HH_
+#define GZ_MATH_POLYGON2_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/Line2.hh>
+#include <gz/math/Triangle.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/config.hh>
+#include <gz/math/detail/Polygon2Simd.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Polygon2 Polygon2.hh ignition/math/Polygon2.hh
+    /// \brief A simple two dimensional polygon, such as a geofence or a
+    /// zone, defined by its vertices in order, either clockwise or
+    /// counterclockwise. The last vertex is joined to the first one.
+    ///
+    /// The edges are kept in a table, set up when the vertices are set,
+    /// that holds what the crossing test needs, together with the bounding
+    /// box of the polygon, so that testing many points does not recompute
+    /// them. The batch tests check the points in blocks, one edge at a
+    /// time, which the compiler can vectorize.
+    ///
+    /// Containment uses the crossing number, or even-odd rule, with half
+    /// open edges: a point on an edge shared by two polygons of a
+    /// partition is inside exactly one of them, but points on the boundary
+    /// of a single polygon may be inside or outside.
+    /// \tparam T a numeric type.
+    template<typename T>
+    class Polygon2
+    {
+      /// \brief Default constructor. Creates a polygon without vertices,
+      /// which contains no point.
+      public: Polygon2() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _vertices Vertices of the polygon, in order.
+      public: explicit Polygon2(const std::vector<Vector2<T>> &_vertices)
+      {
+        this->Set(_vertices);
+      }
+
+      /// \brief Set the vertices of the polygon and build its edge table.
+      /// \param[in] _vertices Vertices of the polygon, in order.
+      public: void Set(const std::vector<Vector2<T>> &_vertices)
+      {
+        this->vertices = _vertices;
+        const std::size_t count = this->vertices.size();
+        this->edgeX.resize(count);
+        this->edgeY0.resize(count);
+        this->edgeY1.resize(count);
+        this->edgeSlope.resize(count);
+        this->min.Set(0, 0);
+        this->max.Set(0, 0);
+        if (count == 0)
+          return;
+
+        this->min.Set(MAX_D, MAX_D);
+        this->max.Set(LOW_D, LOW_D);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          const Vector2<T> &a = this->vertices[i];
+          const Vector2<T> &b = this->vertices[(i + 1) % count];
+          const double dy = static_cast<double>(b.Y()) - a.Y();
+          this->edgeX[i] = a.X();
+          this->edgeY0[i] = a.Y();
+          this->edgeY1[i] = b.Y();
+          this->edgeSlope[i] =
+              std::abs(dy) < std::numeric_limits<double>::min() ? 0.0 :
+              (static_cast<double>(b.X()) - a.X()) / dy;
+          this->min.Set(std::min<double>(this->min.X(), a.X()),
+                        std::min<double>(this->min.Y(), a.Y()));
+          this->max.Set(std::max<double>(this->max.X(), a.X()),
+                        std::max<double>(this->max.Y(), a.Y()));
+        }
+      }
+
+      /// \brief Get the vertices.
+      /// \return The vertices, in order.
+      public: const std::vector<Vector2<T>> &Vertices() const
+      {
+        return this->vertices;
+      }
+
+      /// \brief Get the number of vertices, which is also the number of
+      /// edges.
+      /// \return Number of vertices.
+      public: std::size_t VertexCount() const
+      {
+        return this->vertices.size();
+      }
+
+      /// \brief Get an edge.
+      /// \param[in] _index Index of the edge, from vertex _index to the
+      /// next vertex, lower than VertexCount().
+      /// \return The edge.
+      public: Line2<T> Edge(const std::size_t _index) const
+      {
+        return Line2<T>(this->vertices[_index],
+            this->vertices[(_index + 1) % this->vertices.size()]);
+      }
+
+      /// \brief Get the signed area, positive if the vertices are
+      /// counterclockwise.
+      /// \return The signed area.
+      public: double SignedArea() const
+      {
+        double area = 0;
+        const std::size_t count = this->vertices.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          const Vector2<T> &a = this->vertices[i];
+          const Vector2<T> &b = this->vertices[(i + 1) % count];
+          area += static_cast<double>(a.X()) * b.Y() -
+                  static_cast<double>(b.X()) * a.Y();
+        }
+        return 0.5 * area;
+      }
+
+      /// \brief Get the area.
+      /// \return The area.
+      public: double Area() const
+      {
+        return std::abs(this->SignedArea());
+      }
+
+      /// \brief Get the minimum corner of the bounding box.
+      /// \return The minimum corner, or zero without vertices.
+      public: const Vector2d &Min() const
+      {
+        return this->min;
+      }
+
+      /// \brief Get the maximum corner of the bounding box.
+      /// \return The maximum corner, or zero without vertices.
+      public: const Vector2d &Max() const
+      {
+        return this->max;
+      }
+
+      /// \brief Get whether the polygon contains a point.
+      /// \param[in] _pt Point to check.
+      /// \return True if the point is inside the polygon, by the even-odd
+      /// rule.
+      public: bool Contains(const Vector2<T> &_pt) const
+      {
+        const double x = _pt.X();
+        const double y = _pt.Y();
+        if (!this->InBox(x, y))
+          return false;
+
+        bool inside = false;
+        for (std::size_t e = 0; e < this->edgeX.size(); ++e)
+        {
+          inside ^= detail::PolygonEdgeCrossed(this->edgeX[e],
+              this->edgeY0[e], this->edgeY1[e], this->edgeSlope[e], x, y);
+        }
+        return inside;
+      }
+
+      /// \brief Get whether the polygon contains each of many points.
+      /// Each result is the same as Contains(const Vector2<T> &).
+      /// \param[in] _points Array of _count points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _inside Array of _count results.
+      /// \return Number of points inside the polygon.
+      public: std::size_t Contains(const Vector2<T> *_points,
+                                   const std::size_t _count,
+                                   bool *_inside) const
+      {
+        std::size_t count = 0;
+        double x[kBlockSize];
+        double y[kBlockSize];
+        bool odd[kBlockSize];
+        for (std::size_t begin = 0; begin < _count; begin += kBlockSize)
+        {
+          const std::size_t n = std::min(kBlockSize, _count - begin);
+
+          // Copy the block, and whether any point is in the bounding box
+          bool anyInBox = false;
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            x[i] = _points[begin + i].X();
+            y[i] = _points[begin + i].Y();
+            anyInBox |= this->InBox(x[i], y[i]);
+          }
+
+          if (!anyInBox)
+          {
+            std::fill(_inside + begin, _inside + begin + n, false);
+            continue;
+          }
+
+          detail::PolygonCrossings(this->edgeX.data(), this->edgeY0.data(),
+              this->edgeY1.data(), this->edgeSlope.data(),
+              this->edgeX.size(), x, y, n, odd);
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            _inside[begin + i] = odd[i] && this->InBox(x[i], y[i]);
+            count += _inside[begin + i];
+          }
+        }
+        return count;
+      }
+
+      /// \brief Get the winding number of the polygon around a point,
+      /// the number of times the boundary turns counterclockwise around
+      /// it. It is nonzero inside a simple polygon, with the sign of the
+      /// orientation of its vertices.
+      /// \param[in] _pt Point to check.
+      /// \return The winding number.
+      public: int WindingNumber(const Vector2<T> &_pt) const
+      {
+        const double x = _pt.X();
+        const double y = _pt.Y();
+        int winding = 0;
+        const std::size_t count = this->vertices.size();
+        for (std::size_t e = 0; e < count; ++e)
+        {
+          const double y0 = this->edgeY0[e];
+          const double y1 = this->edgeY1[e];
+          const double x0 = this->edgeX[e];
+          const double x1 = this->vertices[(e + 1) % count].X();
+          const double side = (x1 - x0) * (y - y0) - (x - x0) * (y1 - y0);
+          if (y0 <= y && y1 > y && side > 0)
+            ++winding;
+          else if (y0 > y && y1 <= y && side < 0)
+            --winding;
+        }
+        return winding;
+      }
+
+      /// \brief Find the first of several polygons, such as the zones of
+      /// a map, that contains each of many points.
+      /// \param[in] _polygons Array of _polygonCount polygons.
+      /// \param[in] _polygonCount Number of polygons.
+      /// \param[in] _points Array of _count points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _zones Array of _count indices of the first polygon
+      /// that contains each point, or -1 if none does.
+      /// \return Number of points inside a polygon.
+      public: static std::size_t Locate(const Polygon2<T> *_polygons,
+                  const std::size_t _polygonCount,
+                  const Vector2<T> *_points, const std::size_t _count,
+                  int *_zones)
+      {
+        std::fill(_zones, _zones + _count, -1);
+        std::size_t located = 0;
+        bool inside[kBlockSize];
+        for (std::size_t begin = 0; begin < _count; begin += kBlockSize)
+        {
+          const std::size_t n = std::min(kBlockSize, _count - begin);
+          std::size_t remaining = n;
+          for (std::size_t p = 0; p < _polygonCount && remaining > 0; ++p)
+          {
+            _polygons[p].Contains(_points + begin, n, inside);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+              if (inside[i] && _zones[begin + i] < 0)
+              {
+                _zones[begin + i] = static_cast<int>(p);
+                --remaining;
+              }
+            }
+          }
+          located += n - remaining;
+        }
+        return located;
+      }
+
+      /// \brief Triangulate the polygon by ear clipping.
+      /// \param[out] _indices Vertex indices of the triangles, three per
+      /// triangle, counterclockwise. It is cleared first.
+      /// \return False if the polygon has fewer than 3 vertices, or if no
+      /// ear is found because the polygon is not simple; the triangles
+      /// found until then are kept.
+      public: bool Triangulate(std::vector<std::size_t> &_indices) const
+      {
+        _indices.clear();
+        const std::size_t count = this->vertices.size();
+        if (count < 3)
+          return false;
+
+        // Remaining vertices, counterclockwise
+        std::vector<std::size_t> remaining(count);
+        for (std::size_t i = 0; i < count; ++i)
+          remaining[i] = i;
+        if (this->SignedArea() < 0)
+          std::reverse(remaining.begin(), remaining.end());
+        _indices.reserve(3 * (count - 2));
+
+        std::size_t i = 0;
+        std::size_t failures = 0;
+        while (remaining.size() > 3)
+        {
+          const std::size_t n = remaining.size();
+          const std::size_t prev = remaining[(i + n - 1) % n];
+          const std::size_t curr = remaining[i % n];
+          const std::size_t next = remaining[(i + 1) % n];
+          if (this->IsEar(remaining, prev, curr, next))
+          {
+            _indices.insert(_indices.end(), {prev, curr, next});
+            remaining.erase(remaining.begin() + (i % n));
+            failures = 0;
+
+            // Check the previous vertex again, whose angle changed
+            i = (i % n + n - 2) % (n - 1);
+          }
+          else if (++failures > n)
+          {
+            // Without ears, drop a vertex on a straight angle, which
+            // leaves the polygon unchanged up to the tolerance.
+            std::size_t k = 0;
+            while (k < n && !equal(Orientation(
+                this->vertices[remaining[(k + n - 1) % n]],
+                this->vertices[remaining[k]],
+                this->vertices[remaining[(k + 1) % n]]), 0.0))
+            {
+              ++k;
+            }
+            if (k == n)
+              return false;
+            remaining.erase(remaining.begin() + k);
+            i = 0;
+            failures = 0;
+          }
+          else
+          {
+            i = (i + 1) % n;
+          }
+        }
+        _indices.insert(_indices.end(),
+                        {remaining[0], remaining[1], remaining[2]});
+        return true;
+      }
+
+      /// \brief Number of points tested together by the batch tests.
+      private: static constexpr std::size_t kBlockSize =
+          detail::kPolygonCrossingsBlock;
+
+      /// \brief Get whether a point is in the bounding box.
+      /// \param[in] _x X coordinate of the point.
+      /// \param[in] _y Y coordinate of the point.
+      /// \return True if it is inside or on the box.
+      private: bool InBox(const double _x, const double _y) const
+      {
+        return (_x >= this->min.X()) & (_x <= this->max.X()) &
+               (_y >= this->min.Y()) & (_y <= this->max.Y());
+      }
+
+      /// \brief Get the twice signed area of a triangle.
+      /// \param[in] _a First vertex.
+      /// \param[in] _b Second vertex.
+      /// \param[in] _c Third vertex.
+      /// \return Positive if the vertices are counterclockwise.
+      private: static double Orientation(const Vector2<T> &_a,
+                                         const Vector2<T> &_b,
+                                         const Vector2<T> &_c)
+      {
+        return (static_cast<double>(_b.X()) - _a.X()) *
+               (static_cast<double>(_c.Y()) - _a.Y()) -
+               (static_cast<double>(_b.Y()) - _a.Y()) *
+               (static_cast<double>(_c.X()) - _a.X());
+      }
+
+      /// \brief Get whether a vertex is an ear: its angle is convex and no
+      /// other remaining vertex is in its triangle.
+      /// \param[in] _remaining Remaining vertices, counterclockwise.
+      /// \param[in] _prev Previous vertex.
+      /// \param[in] _curr The vertex.
+      /// \param[in] _next Next vertex.
+      /// \return True if the vertex is an ear.
+      private: bool IsEar(const std::vector<std::size_t> &_remaining,
+                          const std::size_t _prev, const std::size_t _curr,
+                          const std::size_t _next) const
+      {
+        const Vector2<T> &a = this->vertices[_prev];
+        const Vector2<T> &b = this->vertices[_curr];
+        const Vector2<T> &c = this->vertices[_next];
+        if (!(Orientation(a, b, c) > 0))
+          return false;
+
+        const Triangle<T> ear(a, b, c);
+        for (const std::size_t j : _remaining)
+        {
+          if (j == _prev || j == _curr || j == _next)
+            continue;
+
+          // Vertices equal to a corner of the ear, where the polygon
+          // touches itself, do not block it.
+          const Vector2<T> &p = this->vertices[j];
+          if (p == a || p == b || p == c)
+            continue;
+          if (ear.Contains(p))
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Vertices, in order.
+      private: std::vector<Vector2<T>> vertices;
+
+      /// \brief X coordinate of the start of each edge.
+      private: std::vector<double> edgeX;
+
+      /// \brief Y coordinate of the start of each edge.
+      private: std::vector<double> edgeY0;
+
+      /// \brief Y coordinate of the end of each edge.
+      private: std::vector<double> edgeY1;
+
+      /// \brief Change of X per unit of Y along each edge, zero for
+      /// horizontal edges.
+      private: std::vector<double> edgeSlope;
+
+      /// \brief Minimum corner of the bounding box.
+      private: Vector2d min;
+
+      /// \brief Maximum corner of the bounding box.
+      private: Vector2d max;
+    };
+
+    /// Double specialization of the Polygon2 class.
+    typedef Polygon2<double> Polygon2d;
+
+    /// Float specialization of the Polygon2 class.
+    typedef Polygon2<float> Polygon2f;
+    }
+  }
+}
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_POLYLINESIMPLIFIER_HH_
+#define GZ_MATH_POLYLINESIMPLIFIER_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include <gz/math/Export.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  /// \class PolylineSimplifier PolylineSimplifier.hh
+  /// ignition/math/PolylineSimplifier.hh
+  /// \brief Simplification of polylines, such as recorded tracks, to
+  /// fewer points that stay within a tolerance of the original path.
+  ///
+  /// The first and last points are always kept, and the indices of the
+  /// points that are kept are reported in increasing order. Polylines with
+  /// fewer than 3 points are kept whole. The points must be finite.
+  class IGNITION_MATH_VISIBLE PolylineSimplifier
+  {
+    /// \brief Simplify a polyline with the Douglas-Peucker algorithm. The
+    /// points between two kept points are removed if their Line2
+    /// distance to the segment joining the kept points is at most the
+    /// tolerance. Otherwise the farthest of them is kept and both halves
+    /// are simplified again, so every removed point is within the
+    /// tolerance of the simplified polyline.
+    /// \remarks With a single thread no memory is allocated: the pending
+    /// halves are stacked at the end of _indices. Several threads search
+    /// the farthest point of the long intervals, with the same result as
+    /// a single thread.
+    /// \param[in] _points Array of _count points.
+    /// \param[in] _count Number of points.
+    /// \param[in] _tolerance Maximum distance from a removed point to the
+    /// simplified polyline.
+    /// \param[out] _indices Array of at least _count indices, written with
+    /// the indices of the points that are kept.
+    /// \param[in] _threads Number of threads, 0 for the number of hardware
+    /// threads.
+    /// \return Number of points kept.
+    public: static std::size_t DouglasPeucker(const Vector2d *_points,
+                const std::size_t _count, const double _tolerance,
+                std::size_t *_indices, const unsigned int _threads = 1);
+
+    /// \brief Simplify a 3D polyline with the Douglas-Peucker algorithm,
+    /// using the Line3 distance. See the 2D version.
+    /// \param[in] _points Array of _count points.
+    /// \param[in] _count Number of points.
+    /// \param[in] _tolerance Maximum distance from a removed point to the
+    /// simplified polyline.
+    /// \param[out] _indices Array of at least _count indices, written with
+    /// the indices of the points that are kept.
+    /// \param[in] _threads Number of threads, 0 for the number of hardware
+    /// threads.
+    /// \return Number of points kept.
+    public: static std::size_t DouglasPeucker(const Vector3d *_points,
+                const std::size_t _count, const double _tolerance,
+                std::size_t *_indices, const unsigned int _threads = 1);
+
+    /// \brief Simplify a polyline with the Douglas-Peucker algorithm.
+    /// \param[in] _points Points of the polyline.
+    /// \param[in] _tolerance Maximum distance from a removed point to the
+    /// simplified polyline.
+    /// \param[in] _threads Number of threads, 0 for the number of hardware
+    /// threads.
+    /// \return The points that are kept.
+    public: static std::vector<Vector2d> DouglasPeucker(
+                const std::vector<Vector2d> &_points,
+                const double _tolerance, const unsigned int _threads = 1);
+
+    /// \brief Simplify a 3D polyline with the Douglas-Peucker algorithm.
+    /// \param[in] _points Points of the polyline.
+    /// \param[in] _tolerance Maximum distance from a removed point to the
+    /// simplified polyline.
+    /// \param[in] _threads Number of threads, 0 for the number of hardware
+    /// threads.
+    /// \return The points that are kept.
+    public: static std::vector<Vector3d> DouglasPeucker(
+                const std::vector<Vector3d> &_points,
+                const double _tolerance, const unsigned int _threads = 1);
+
+    /// \brief Simplify a polyline with the Visvalingam-Whyatt algorithm.
+    /// The point that forms the triangle of smallest area with its two
+    /// neighbors is removed, and the areas of the neighbors are updated,
+    /// until every remaining triangle has an area of at least the
+    /// tolerance. This removes small details evenly instead of keeping the
+    /// farthest points, which often looks smoother than Douglas-Peucker.
+    /// \remarks The removal order is kept in a heap, in O(n log n) time,
+    /// and allocates memory proportional to the number of points.
+    /// \param[in] _points Array of _count points.
+    /// \param[in] _count Number of points.
+    /// \param[in] _minArea Area of the smallest triangle that is kept.
+    /// \param[out] _indices Array of at least _count indices, written with
+    /// the indices of the points that are kept.
+    /// \return Number of points kept.
+    public: static std::size_t Visvalingam(const Vector2d *_points,
+                const std::size_t _count, const double _minArea,
+                std::size_t *_indices);
+
+    /// \brief Simplify a 3D polyline with the Visvalingam-Whyatt
+    /// algorithm. See the 2D version.
+    /// \param[in] _points Array of _count points.
+    /// \param[in] _count Number of points.
+    /// \param[in] _minArea Area of the smallest triangle that is kept.
+    /// \param[out] _indices Array of at least _count indices, written with
+    /// the indices of the points that are kept.
+    /// \return Number of points kept.
+    public: static std::size_t Visvalingam(const Vector3d *_points,
+                const std::size_t _count, const double _minArea,
+                std::size_t *_indices);
+
+    /// \brief Simplify a polyline with the Visvalingam-Whyatt algorithm.
+    /// \param[in] _points Points of the polyline.
+    /// \param[in] _minArea Area of the smallest triangle that is kept.
+    /// \return The points that are kept.
+    public: static std::vector<Vector2d> Visvalingam(
+                const std::vector<Vector2d> &_points, const double _minArea);
+
+    /// \brief Simplify a 3D polyline with the Visvalingam-Whyatt
+    /// algorithm.
+    /// \param[in] _points Points of the polyline.
+    /// \param[in] _minArea Area of the smallest triangle that is kept.
+    /// \return The points that are kept.
+    public: static std::vector<Vector3d> Visvalingam(
+                const std::vector<Vector3d> &_points, const double _minArea);
+  };
+  }
+}
+}
+#endif
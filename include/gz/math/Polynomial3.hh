@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <string>
 #include <utility>
@@ -102,6 +103,38 @@ namespace ignition
                 this->coeffs[2] * _x + this->coeffs[3]);
       }
 
+      /// \brief Evaluate the polynomial at many arguments. The polynomial
+      /// is evaluated with Horner's scheme in a loop the compiler can
+      /// vectorize, so finite results may differ from Evaluate(const T &)
+      /// by rounding. Non-finite arguments are handled as in
+      /// Evaluate(const T &).
+      /// \param[in] _x Array of _count polynomial arguments.
+      /// \param[in] _count Number of arguments.
+      /// \param[out] _y Array of at least _count values, written with the
+      /// result of evaluating p(`_x[i]`).
+      public: void Evaluate(const T *_x, const std::size_t _count,
+                            T *_y) const
+      {
+        const T c0 = this->coeffs[0];
+        const T c1 = this->coeffs[1];
+        const T c2 = this->coeffs[2];
+        const T c3 = this->coeffs[3];
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const T x = _x[i];
+          _y[i] = ((c0 * x + c1) * x + c2) * x + c3;
+        }
+
+        // Non-finite arguments give non-finite values above, fix them up in
+        // a separate pass which keeps the loop above free of branches
+        using std::isfinite;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (!isfinite(_y[i]))
+            _y[i] = this->Evaluate(_x[i]);
+        }
+      }
+
       /// \brief Call operator overload
       /// \see Polynomial3::Evaluate()
       public: T operator()(const T &_x) const
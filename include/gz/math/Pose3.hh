@@ -17,8 +17,13 @@
 #ifndef GZ_MATH_POSE_HH_
 #define GZ_MATH_POSE_HH_
 
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include <gz/math/Matrix3.hh>
 #include <gz/math/Quaternion.hh>
 #include <gz/math/Vector3.hh>
+#include <gz/math/Vector3SoA.hh>
 #include <gz/math/config.hh>
 
 namespace ignition
@@ -138,6 +143,57 @@ namespace ignition
         return Pose3<T>(inv * (this->p*-1), inv);
       }
 
+      /// \brief Get the inverse of each of many poses, such as the
+      /// extrinsics of a set of cameras: _out[i] = _in[i].Inverse(). The
+      /// result is the same as calling Inverse on every pose, up to
+      /// rounding, with one division per pose instead of four and without
+      /// building intermediate quaternions and vectors.
+      /// \param[in] _in Array of _count poses to invert.
+      /// \param[in] _count Number of poses.
+      /// \param[out] _out Array of at least _count poses, written with the
+      /// inverses. It may be the same array as _in.
+      public: static void Inverse(const Pose3<T> *_in,
+                                  const std::size_t _count, Pose3<T> *_out)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const Quaternion<T> &q = _in[i].q;
+          T w = q.W(), x = q.X(), y = q.Y(), z = q.Z();
+          const T s = w * w + x * x + y * y + z * z;
+          if (equal<T>(s, static_cast<T>(0)))
+          {
+            // Quaternion::Inverse gives the identity
+            w = 1;
+            x = y = z = 0;
+          }
+          else
+          {
+            const T invS = 1 / s;
+            w *= invS;
+            x *= -invS;
+            y *= -invS;
+            z *= -invS;
+          }
+
+          // Rotate the negated position by the inverse quaternion, as
+          // Quaternion::operator*(Vector3) does: v + 2w(u x v) +
+          // 2u x (u x v), where u is the vector part.
+          const T px = -_in[i].p.X();
+          const T py = -_in[i].p.Y();
+          const T pz = -_in[i].p.Z();
+          const T uvx = y * pz - z * py;
+          const T uvy = z * px - x * pz;
+          const T uvz = x * py - y * px;
+          const T uuvx = y * uvz - z * uvy;
+          const T uuvy = z * uvx - x * uvz;
+          const T uuvz = x * uvy - y * uvx;
+          _out[i].p.Set(px + 2 * (w * uvx + uuvx),
+                        py + 2 * (w * uvy + uuvy),
+                        pz + 2 * (w * uvz + uuvz));
+          _out[i].q.Set(w, x, y, z);
+        }
+      }
+
       /// \brief Addition operator
       /// A is the transform from O to P specified in frame O
       /// B is the transform from P to Q specified in frame P
@@ -273,6 +329,58 @@ namespace ignition
                           _pose.p.Z() + tmp.Z());
       }
 
+      /// \brief Add this pose to a set of points: _out[i] = this + _in[i].
+      /// The result is the same as calling CoordPositionAdd on every point,
+      /// but the rotation is converted to a matrix only once.
+      /// \param[in] _in Points to transform.
+      /// \param[out] _out Transformed points, resized to _in.size(). It may
+      /// be the same vector as _in.
+      public: void CoordPositionAdd(const std::vector<Vector3<T>> &_in,
+                                    std::vector<Vector3<T>> &_out) const
+      {
+        const Matrix3<T> rot(this->q);
+        _out.resize(_in.size());
+        for (std::size_t i = 0; i < _in.size(); ++i)
+          _out[i] = rot * _in[i] + this->p;
+      }
+
+      /// \brief Add this pose to a set of points stored as a
+      /// structure-of-arrays: _out[i] = this + _in[i].
+      /// The rotation is converted to a matrix once, and the loop over the
+      /// component arrays is written so that it can be auto-vectorized.
+      /// \param[in] _in Points to transform.
+      /// \param[out] _out Transformed points, resized to _in.Size(). It may
+      /// be the same container as _in.
+      public: void CoordPositionAdd(const Vector3SoA<T> &_in,
+                                    Vector3SoA<T> &_out) const
+      {
+        const Matrix3<T> rot(this->q);
+        const T r00 = rot(0, 0), r01 = rot(0, 1), r02 = rot(0, 2);
+        const T r10 = rot(1, 0), r11 = rot(1, 1), r12 = rot(1, 2);
+        const T r20 = rot(2, 0), r21 = rot(2, 1), r22 = rot(2, 2);
+        const T px = this->p.X(), py = this->p.Y(), pz = this->p.Z();
+
+        const std::size_t n = _in.Size();
+        _out.Resize(n);
+        const T *ix = _in.XData(), *iy = _in.YData(), *iz = _in.ZData();
+        T *ox = _out.XData(), *oy = _out.YData(), *oz = _out.ZData();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          const T x = ix[i], y = iy[i], z = iz[i];
+          ox[i] = r00 * x + r01 * y + r02 * z + px;
+          oy[i] = r10 * x + r11 * y + r12 * z + py;
+          oz[i] = r20 * x + r21 * y + r22 * z + pz;
+        }
+      }
+
+      /// \brief Add this pose to a set of points in place:
+      /// _points[i] = this + _points[i].
+      /// \param[in,out] _points Points to transform.
+      public: void CoordPositionAdd(Vector3SoA<T> &_points) const
+      {
+        this->CoordPositionAdd(_points, _points);
+      }
+
       /// \brief Subtract one position from another: result = this - pose
       /// \param[in] _pose Pose3<T> to subtract
       /// \return The resulting position
@@ -483,6 +591,76 @@ namespace ignition
         return _in;
       }
 
+      /// \brief Parse a pose from a white space separated
+      /// "x y z roll pitch yaw" text, the format of an SDF pose, with the
+      /// angles in radians. The numbers are parsed with parseNext, without
+      /// allocating and independently of the locale.
+      /// \param[in] _text Text to parse.
+      /// \param[out] _pose Parsed pose. It is unchanged on failure.
+      /// \return True if _text holds exactly six numbers.
+      public: static bool Parse(std::string_view _text, Pose3<T> &_pose)
+      {
+        T v[6];
+        for (T &value : v)
+        {
+          if (!parseNext(_text, value))
+            return false;
+        }
+        if (!detail::isSpace(_text))
+          return false;
+        _pose.Set(v[0], v[1], v[2], v[3], v[4], v[5]);
+        return true;
+      }
+
+      /// \brief Parse a white space separated list of poses, six numbers
+      /// "x y z roll pitch yaw" per pose.
+      /// \param[in] _text Text to parse.
+      /// \param[out] _poses The poses are appended to it. It is unchanged
+      /// on failure.
+      /// \return True if _text holds a list of numbers whose length is a
+      /// multiple of six.
+      public: static bool ParseArray(std::string_view _text,
+                                     std::vector<Pose3<T>> &_poses)
+      {
+        const std::size_t size = _poses.size();
+        T v[6];
+        std::size_t i = 6;
+        while (parseNext(_text, v[0]))
+        {
+          i = 1;
+          while (i < 6 && parseNext(_text, v[i]))
+            ++i;
+          if (i < 6)
+            break;
+          _poses.emplace_back(v[0], v[1], v[2], v[3], v[4], v[5]);
+        }
+        if (i < 6 || !detail::isSpace(_text))
+        {
+          _poses.resize(size);
+          return false;
+        }
+        return true;
+      }
+
+      /// \brief Write the pose as "x y z roll pitch yaw" into a character
+      /// buffer, the format read by Parse and used by SDF, with
+      /// formatNumbers. Floating point numbers are written in the shortest
+      /// form that parses back to the same value, so the position round
+      /// trips exactly and the rotation up to the precision of the Euler
+      /// angle conversion. This does not allocate and does not depend on
+      /// the locale.
+      /// \param[in] _first Start of the buffer.
+      /// \param[in] _last End of the buffer.
+      /// \return Pointer past the last character written, or nullptr if
+      /// the buffer is too small. The output is not null terminated.
+      public: char *ToChars(char *_first, char *_last) const
+      {
+        const Vector3<T> rpy = this->q.Euler();
+        const T values[6] = {this->p.X(), this->p.Y(), this->p.Z(),
+                             rpy.X(), rpy.Y(), rpy.Z()};
+        return formatNumbers(_first, _last, values, 6);
+      }
+
       /// \brief The position
       private: Vector3<T> p;
 
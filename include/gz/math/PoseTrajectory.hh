@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_POSETRAJECTORY_HH_
+#define GZ_MATH_POSETRAJECTORY_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gz/math/Export.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  // Forward declaration.
+  class PoseTrajectoryPrivate;
+
+  /// \class PoseTrajectory PoseTrajectory.hh ignition/math/PoseTrajectory.hh
+  /// \brief A time parameterized spline through timestamped poses, used
+  /// to resample pose streams at other timestamps.
+  ///
+  /// The positions are interpolated with a Spline and the rotations with
+  /// a RotationSpline, both built in one pass when the poses are set.
+  /// Within the segment between two samples the spline parameter is
+  /// linear in time, so a query at a sample time returns that sample.
+  /// Times outside of the samples are clamped to the first or last one.
+  ///
+  /// Batch queries walk the segments forward from the segment of the
+  /// previous time, so resampling sorted timestamps costs O(n + m) for n
+  /// samples and m timestamps. A time earlier than the previous one is
+  /// located with a binary search.
+  ///
+  /// Queries are const and only read, so they can be made from several
+  /// threads at the same time.
+  class IGNITION_MATH_VISIBLE PoseTrajectory
+  {
+    /// \brief Default constructor. Creates an empty trajectory.
+    public: PoseTrajectory();
+
+    /// \brief Copy constructor.
+    /// \param[in] _trajectory Trajectory to copy.
+    public: PoseTrajectory(const PoseTrajectory &_trajectory);
+
+    /// \brief Destructor.
+    public: ~PoseTrajectory();
+
+    /// \brief Assignment operator.
+    /// \param[in] _trajectory Trajectory to copy.
+    /// \return Reference to this trajectory.
+    public: PoseTrajectory &operator=(const PoseTrajectory &_trajectory);
+
+    /// \brief Replace the samples.
+    /// \param[in] _times Time of each sample, finite and non-decreasing.
+    /// \param[in] _poses Pose of each sample.
+    /// \param[in] _count Number of samples.
+    /// \return True on success, false if the times are not finite and
+    /// non-decreasing, in which case the trajectory is unchanged.
+    public: bool SetPoses(const double *_times, const Pose3d *_poses,
+                          const std::size_t _count);
+
+    /// \brief Replace the samples.
+    /// \param[in] _times Time of each sample, finite and non-decreasing.
+    /// \param[in] _poses Pose of each sample, as many as _times.
+    /// \return True on success, false if the sizes differ or the times are
+    /// not finite and non-decreasing, in which case the trajectory is
+    /// unchanged.
+    public: bool SetPoses(const std::vector<double> &_times,
+                          const std::vector<Pose3d> &_poses);
+
+    /// \brief Remove all the samples.
+    public: void Clear();
+
+    /// \brief Get the number of samples.
+    /// \return Number of samples.
+    public: std::size_t Size() const;
+
+    /// \brief Get the time of a sample.
+    /// \param[in] _index Index of the sample, lower than Size().
+    /// \return Time of the sample.
+    public: double Time(const std::size_t _index) const;
+
+    /// \brief Get the pose of a sample.
+    /// \param[in] _index Index of the sample, lower than Size().
+    /// \return Pose of the sample.
+    public: const Pose3d &SamplePose(const std::size_t _index) const;
+
+    /// \brief Interpolate the pose at a time.
+    /// \param[in] _time Time to evaluate, clamped to the samples.
+    /// \param[out] _pose Interpolated pose.
+    /// \return True on success, false if there are no samples.
+    public: bool Interpolate(const double _time, Pose3d &_pose) const;
+
+    /// \brief Interpolate the poses at many times. Each pose is the same
+    /// as the one returned by Interpolate(const double, Pose3d &).
+    /// \param[in] _times Times to evaluate, preferably sorted.
+    /// \param[in] _count Number of times.
+    /// \param[out] _poses Array of at least _count interpolated poses.
+    /// \return True on success, false if there are no samples, in which
+    /// case _poses is not written.
+    public: bool Interpolate(const double *_times, const std::size_t _count,
+                             Pose3d *_poses) const;
+
+    /// \brief Interpolate the poses at many times.
+    /// \param[in] _times Times to evaluate, preferably sorted.
+    /// \param[out] _poses Interpolated poses, resized to the number of
+    /// times.
+    /// \return True on success, false if there are no samples, in which
+    /// case _poses is unchanged.
+    public: bool Interpolate(const std::vector<double> &_times,
+                             std::vector<Pose3d> &_poses) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+    /// \brief Private data pointer.
+    private: std::unique_ptr<PoseTrajectoryPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+  };
+  }
+}
+}
+#endif
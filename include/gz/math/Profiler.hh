@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_PROFILER_HH_
+#define GZ_MATH_PROFILER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <gz/math/Export.hh>
+#include <gz/math/SignalStats.hh>
+#include <gz/math/Stopwatch.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declarations.
+    class ProfilerPrivate;
+
+    /// \class Profiler Profiler.hh ignition/math/Profiler.hh
+    /// \brief Registry of named profiling zones, which collects the time
+    /// spent in each zone from any number of threads.
+    ///
+    /// Recording a duration only writes to a buffer owned by the calling
+    /// thread, without locks or atomic read-modify-write operations, so
+    /// zones can stay enabled in hot code. The durations are moved from
+    /// the buffers into a SignalStats per zone by Collect, which is also
+    /// called by Export. A thread that records faster than the buffers are
+    /// collected drops durations, see Dropped.
+    ///
+    /// Durations use the clock of Stopwatch and are inserted into the
+    /// statistics in seconds.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::Profiler profiler;
+    /// const std::size_t zone = profiler.Zone("update");
+    ///
+    /// void Update()
+    /// {
+    ///   gz::math::ProfilerScope scope(profiler, zone);
+    ///   // do something...
+    /// }
+    ///
+    /// // Periodically, from any thread
+    /// for (auto const &stats : profiler.Export())
+    ///   std::cout << stats.first << " p99 " << stats.second.at("p99");
+    /// ```
+    class IGNITION_MATH_VISIBLE Profiler
+    {
+      /// \brief Constructor.
+      /// \param[in] _statistics Comma-separated statistics of each zone,
+      /// see SignalStats::InsertStatistics.
+      /// \param[in] _bufferSize Number of durations that each thread can
+      /// record between two collections. It is rounded up to a power of
+      /// two.
+      public: explicit Profiler(
+                  const std::string &_statistics = "max,mean,min,p50,p99",
+                  const std::size_t _bufferSize = 8192);
+
+      /// \brief Destructor.
+      public: ~Profiler();
+
+      /// \brief Profilers are not copyable.
+      public: Profiler(const Profiler &) = delete;
+
+      /// \brief Profilers are not copyable.
+      /// \return this
+      public: Profiler &operator=(const Profiler &) = delete;
+
+      /// \brief Get the identifier of a zone, and register the zone if it
+      /// does not exist. This takes a lock, so the identifier should be
+      /// kept rather than looked up on every use.
+      /// \param[in] _name Name of the zone.
+      /// \return Identifier of the zone.
+      public: std::size_t Zone(const std::string &_name);
+
+      /// \brief Get the number of zones.
+      /// \return Number of zones.
+      public: std::size_t ZoneCount() const;
+
+      /// \brief Record the time spent in a zone by the calling thread.
+      /// \param[in] _zone Identifier of the zone, returned by Zone.
+      /// Durations of unknown zones are ignored by Collect.
+      /// \param[in] _elapsed Time spent in the zone.
+      public: void Record(const std::size_t _zone,
+                          const clock::duration &_elapsed);
+
+      /// \brief Move the durations recorded by all the threads into the
+      /// statistics of their zones.
+      public: void Collect();
+
+      /// \brief Collect the durations and get the statistics of each zone.
+      /// \return Map with the name of each zone as key, and the map of its
+      /// statistics as value, see SignalStats::Map.
+      public: std::map<std::string, std::map<std::string, double>> Export();
+
+      /// \brief Get the number of durations collected for a zone.
+      /// \param[in] _zone Identifier of the zone.
+      /// \return Number of durations, or 0 if the zone does not exist.
+      public: std::size_t Count(const std::size_t _zone) const;
+
+      /// \brief Get the number of durations that could not be recorded
+      /// because the buffer of their thread was full.
+      /// \return Number of dropped durations since the last Reset.
+      public: uint64_t Dropped() const;
+
+      /// \brief Forget all the recorded durations. The zones are kept.
+      public: void Reset();
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ProfilerPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+
+    /// \class ProfilerScope Profiler.hh ignition/math/Profiler.hh
+    /// \brief Records the time from its construction to its destruction in
+    /// a zone of a Profiler.
+    class ProfilerScope
+    {
+      /// \brief Constructor. Starts timing.
+      /// \param[in] _profiler Profiler to record into. It must outlive
+      /// this object.
+      /// \param[in] _zone Identifier of the zone, returned by
+      /// Profiler::Zone.
+      public: ProfilerScope(Profiler &_profiler, const std::size_t _zone)
+        : profiler(_profiler), zone(_zone), start(clock::now())
+      {
+      }
+
+      /// \brief Destructor. Records the time since construction.
+      public: ~ProfilerScope()
+      {
+        this->profiler.Record(this->zone, clock::now() - this->start);
+      }
+
+      /// \brief Scopes are not copyable.
+      public: ProfilerScope(const ProfilerScope &) = delete;
+
+      /// \brief Scopes are not copyable.
+      /// \return this
+      public: ProfilerScope &operator=(const ProfilerScope &) = delete;
+
+      /// \brief Profiler to record into.
+      private: Profiler &profiler;
+
+      /// \brief Identifier of the zone.
+      private: const std::size_t zone;
+
+      /// \brief Time of construction.
+      private: const clock::time_point start;
+    };
+    }
+  }
+}
+#endif
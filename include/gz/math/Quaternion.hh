@@ -22,6 +22,7 @@
 #include <gz/math/Vector3.hh>
 #include <gz/math/Matrix3.hh>
 #include <gz/math/config.hh>
+#include <gz/math/detail/ReciprocalSqrt.hh>
 
 namespace ignition
 {
@@ -44,7 +45,7 @@ namespace ignition
       public: static const Quaternion Zero;
 
       /// \brief Default Constructor
-      public: Quaternion()
+      public: constexpr Quaternion()
       : qw(1), qx(0), qy(0), qz(0)
       {
         // quaternion not normalized, because that breaks
@@ -56,7 +57,8 @@ namespace ignition
       /// \param[in] _x X param
       /// \param[in] _y Y param
       /// \param[in] _z Z param
-      public: Quaternion(const T &_w, const T &_x, const T &_y, const T &_z)
+      public: constexpr Quaternion(const T &_w, const T &_x, const T &_y,
+                                   const T &_z)
       : qw(_w), qx(_x), qy(_y), qz(_z)
       {}
 
@@ -94,28 +96,18 @@ namespace ignition
 
       /// \brief Copy constructor
       /// \param[in] _qt Quaternion<T> to copy
-      public: Quaternion(const Quaternion<T> &_qt)
+      public: constexpr Quaternion(const Quaternion<T> &_qt)
+      : qw(_qt.qw), qx(_qt.qx), qy(_qt.qy), qz(_qt.qz)
       {
-        this->qw = _qt.qw;
-        this->qx = _qt.qx;
-        this->qy = _qt.qy;
-        this->qz = _qt.qz;
       }
 
       /// \brief Destructor
-      public: ~Quaternion() {}
+      public: ~Quaternion() = default;
 
       /// \brief Assignment operator
       /// \param[in] _qt Quaternion<T> to copy
-      public: Quaternion<T> &operator=(const Quaternion<T> &_qt)
-      {
-        this->qw = _qt.qw;
-        this->qx = _qt.qx;
-        this->qy = _qt.qy;
-        this->qz = _qt.qz;
-
-        return *this;
-      }
+      public: constexpr Quaternion<T> &operator=(const Quaternion<T> &_qt)
+          = default;
 
       /// \brief Invert the quaternion
       public: void Invert()
@@ -253,6 +245,32 @@ namespace ignition
         return result;
       }
 
+      /// \brief Normalize the quaternion with an approximate reciprocal
+      /// square root, a hardware estimate refined by one Newton-Raphson
+      /// step. The norm of the result differs from one by less than 3e-7 on
+      /// x86 and 2.5e-5 on ARM, plus the rounding error of T. This is meant
+      /// to remove the drift that accumulates while integrating rotations.
+      /// As with Normalize(), a zero quaternion becomes the identity.
+      public: void NormalizeFast()
+      {
+        const T n2 = this->qw * this->qw + this->qx * this->qx +
+            this->qy * this->qy + this->qz * this->qz;
+
+        // Outside of this range the single precision estimate may
+        // overflow or underflow, and Normalize() handles zero quaternions.
+        if (!(n2 > static_cast<T>(1e-12) && n2 < static_cast<T>(1e12)))
+        {
+          this->Normalize();
+          return;
+        }
+
+        const T s = detail::ReciprocalSqrt(n2);
+        this->qw *= s;
+        this->qx *= s;
+        this->qy *= s;
+        this->qz *= s;
+      }
+
       /// \brief Set the quaternion from an axis and angle
       /// \param[in] _ax X axis
       /// \param[in] _ay Y axis
@@ -297,7 +315,7 @@ namespace ignition
       /// \param[in] _x x
       /// \param[in] _y y
       /// \param[in] _z z
-      public: void Set(T _w, T _x, T _y, T _z)
+      public: constexpr void Set(T _w, T _x, T _y, T _z)
       {
         this->qw = _w;
         this->qx = _x;
@@ -608,7 +626,7 @@ namespace ignition
       /// \brief Addition operator
       /// \param[in] _qt quaternion for addition
       /// \return this quaternion + _qt
-      public: Quaternion<T> operator+(const Quaternion<T> &_qt) const
+      public: constexpr Quaternion<T> operator+(const Quaternion<T> &_qt) const
       {
         Quaternion<T> result(this->qw + _qt.qw, this->qx + _qt.qx,
                              this->qy + _qt.qy, this->qz + _qt.qz);
@@ -618,7 +636,7 @@ namespace ignition
       /// \brief Addition operator
       /// \param[in] _qt quaternion for addition
       /// \return this quaternion + qt
-      public: Quaternion<T> operator+=(const Quaternion<T> &_qt)
+      public: constexpr Quaternion<T> operator+=(const Quaternion<T> &_qt)
       {
         *this = *this + _qt;
 
@@ -628,7 +646,7 @@ namespace ignition
       /// \brief Subtraction operator
       /// \param[in] _qt quaternion to subtract
       /// \return this quaternion - _qt
-      public: Quaternion<T> operator-(const Quaternion<T> &_qt) const
+      public: constexpr Quaternion<T> operator-(const Quaternion<T> &_qt) const
       {
         Quaternion<T> result(this->qw - _qt.qw, this->qx - _qt.qx,
                        this->qy - _qt.qy, this->qz - _qt.qz);
@@ -638,7 +656,7 @@ namespace ignition
       /// \brief Subtraction operator
       /// \param[in] _qt Quaternion<T> for subtraction
       /// \return This quaternion - qt
-      public: Quaternion<T> operator-=(const Quaternion<T> &_qt)
+      public: constexpr Quaternion<T> operator-=(const Quaternion<T> &_qt)
       {
         *this = *this - _qt;
         return *this;
@@ -647,7 +665,7 @@ namespace ignition
       /// \brief Multiplication operator
       /// \param[in] _q Quaternion<T> for multiplication
       /// \return This quaternion multiplied by the parameter
-      public: inline Quaternion<T> operator*(const Quaternion<T> &_q) const
+      public: constexpr Quaternion<T> operator*(const Quaternion<T> &_q) const
               {
                 return Quaternion<T>(
                   this->qw*_q.qw-this->qx*_q.qx-this->qy*_q.qy-this->qz*_q.qz,
@@ -659,7 +677,7 @@ namespace ignition
       /// \brief Multiplication operator by a scalar.
       /// \param[in] _f factor
       /// \return quaternion multiplied by the scalar
-      public: Quaternion<T> operator*(const T &_f) const
+      public: constexpr Quaternion<T> operator*(const T &_f) const
       {
         return Quaternion<T>(this->qw*_f, this->qx*_f,
                              this->qy*_f, this->qz*_f);
@@ -668,7 +686,7 @@ namespace ignition
       /// \brief Multiplication operator
       /// \param[in] _qt Quaternion<T> for multiplication
       /// \return This quaternion multiplied by the parameter
-      public: Quaternion<T> operator*=(const Quaternion<T> &_qt)
+      public: constexpr Quaternion<T> operator*=(const Quaternion<T> &_qt)
       {
         *this = *this * _qt;
         return *this;
@@ -677,7 +695,7 @@ namespace ignition
       /// \brief Vector3 multiplication operator
       /// \param[in] _v vector to multiply
       /// \return The result of the vector multiplication
-      public: Vector3<T> operator*(const Vector3<T> &_v) const
+      public: constexpr Vector3<T> operator*(const Vector3<T> &_v) const
       {
         Vector3<T> uv, uuv;
         Vector3<T> qvec(this->qx, this->qy, this->qz);
@@ -720,7 +738,7 @@ namespace ignition
 
       /// \brief Unary minus operator
       /// \return negates each component of the quaternion
-      public: Quaternion<T> operator-() const
+      public: constexpr Quaternion<T> operator-() const
       {
         return Quaternion<T>(-this->qw, -this->qx, -this->qy, -this->qz);
       }
@@ -785,7 +803,7 @@ namespace ignition
 
       /// \brief Return the X axis
       /// \return the X axis of the vector
-      public: Vector3<T> XAxis() const
+      public: constexpr Vector3<T> XAxis() const
       {
         T fTy  = 2.0f*this->qy;
         T fTz  = 2.0f*this->qz;
@@ -802,7 +820,7 @@ namespace ignition
 
       /// \brief Return the Y axis
       /// \return the Y axis of the vector
-      public: Vector3<T> YAxis() const
+      public: constexpr Vector3<T> YAxis() const
       {
         T fTx  = 2.0f*this->qx;
         T fTy  = 2.0f*this->qy;
@@ -819,7 +837,7 @@ namespace ignition
 
       /// \brief Return the Z axis
       /// \return the Z axis of the vector
-      public: Vector3<T> ZAxis() const
+      public: constexpr Vector3<T> ZAxis() const
       {
         T fTx  = 2.0f*this->qx;
         T fTy  = 2.0f*this->qy;
@@ -847,7 +865,7 @@ namespace ignition
       /// \brief Dot product
       /// \param[in] _q the other quaternion
       /// \return the product
-      public: T Dot(const Quaternion<T> &_q) const
+      public: constexpr T Dot(const Quaternion<T> &_q) const
       {
         return this->qw*_q.qw + this->qx * _q.qx +
                this->qy*_q.qy + this->qz*_q.qz;
@@ -928,6 +946,67 @@ namespace ignition
         }
       }
 
+      /// \brief Normalized linear interpolation between 2 quaternions. The
+      /// result follows the same arc as Slerp() but not at constant speed.
+      /// For unit quaternions, the rotation angle of the result differs from
+      /// that of Slerp() by at most 2.2e-5 radians for rotations 10 degrees
+      /// apart, 5.8e-4 radians for 30 degrees and 1.7e-2 radians for 90
+      /// degrees. The error is zero at _fT = 0, 0.5 and 1.
+      /// \param[in] _fT the interpolation parameter
+      /// \param[in] _rkP the beginning quaternion
+      /// \param[in] _rkQ the end quaternion
+      /// \param[in] _shortestPath when true, the rotation may be inverted to
+      /// get to minimize rotation
+      /// \return The result of the interpolation
+      public: static Quaternion<T> Nlerp(T _fT,
+                  const Quaternion<T> &_rkP, const Quaternion<T> &_rkQ,
+                  bool _shortestPath = false)
+      {
+        const T sign = (_shortestPath && _rkP.Dot(_rkQ) < 0) ? T(-1) : T(1);
+        Quaternion<T> t = _rkP * (1 - _fT) + _rkQ * (_fT * sign);
+        t.Normalize();
+        return t;
+      }
+
+      /// \brief Approximate spherical linear interpolation between 2 unit
+      /// quaternions, along the shortest path. The interpolation parameter
+      /// is corrected by a polynomial in _fT and in the cosine between the
+      /// quaternions before a normalized linear interpolation, which avoids
+      /// the trigonometric functions of Slerp(). The rotation angle of the
+      /// result differs from that of Slerp(_fT, _rkP, _rkQ, true) by at most
+      /// 3.3e-5 radians for rotations 30 degrees apart, 7.3e-5 radians for
+      /// 90 degrees and 8e-4 radians for any rotations.
+      /// \param[in] _fT the interpolation parameter
+      /// \param[in] _rkP the beginning quaternion
+      /// \param[in] _rkQ the end quaternion
+      /// \return The result of the interpolation
+      public: static Quaternion<T> SlerpFast(T _fT,
+                  const Quaternion<T> &_rkP, const Quaternion<T> &_rkQ)
+      {
+        const T cosine = _rkP.Dot(_rkQ);
+        return Nlerp(SlerpFastParameter(_fT, std::abs(cosine)), _rkP, _rkQ,
+                     true);
+      }
+
+      /// \brief Correct the interpolation parameter of a normalized linear
+      /// interpolation so that it approximates the constant angular speed
+      /// of a spherical linear interpolation. The correction is a cubic in
+      /// _fT, with coefficients fitted as polynomials of the cosine between
+      /// the quaternions, after "Approximating slerp" by A. Kapoulkine.
+      /// \param[in] _fT the interpolation parameter
+      /// \param[in] _d absolute value of the cosine between the quaternions
+      /// \return The corrected interpolation parameter.
+      public: static T SlerpFastParameter(const T _fT, const T _d)
+      {
+        const T a = static_cast<T>(1.0904) + _d * (static_cast<T>(-3.2452) +
+            _d * (static_cast<T>(3.55645) - _d * static_cast<T>(1.43519)));
+        const T b = static_cast<T>(0.848013) + _d * (
+            static_cast<T>(-1.06021) + _d * static_cast<T>(0.215638));
+        const T h = _fT - static_cast<T>(0.5);
+        const T k = a * h * h + b;
+        return _fT + _fT * h * (_fT - 1) * k;
+      }
+
       /// \brief Integrate quaternion for constant angular velocity vector
       /// along specified interval `_deltaT`.
       /// Implementation based on:
@@ -960,30 +1039,58 @@ namespace ignition
         return deltaQ * (*this);
       }
 
+      /// \brief Integrate quaternion for an angular velocity vector which
+      /// varies linearly from `_angularVelocity0` to `_angularVelocity1`
+      /// along the interval `_deltaT`, such as between two gyroscope
+      /// samples. The rotation vector of the interval is the integral of
+      /// the angular velocity plus the coning correction
+      /// -_deltaT^2 / 12 (_angularVelocity0 x _angularVelocity1), the
+      /// second order term of its Magnus expansion. This is exact for a
+      /// constant angular velocity, and when the axis of rotation moves,
+      /// it has a local error of a higher order in _deltaT than integrating
+      /// the mean angular velocity, so fewer steps reach the same accuracy.
+      /// \param[in] _angularVelocity0 Angular velocity vector at the start
+      /// of the interval, specified in same reference frame as base of this
+      /// quaternion.
+      /// \param[in] _angularVelocity1 Angular velocity vector at the end of
+      /// the interval, in the same frame.
+      /// \param[in] _deltaT Time interval in seconds to integrate over.
+      /// \return Quaternion at integrated configuration.
+      public: Quaternion<T> Integrate(const Vector3<T> &_angularVelocity0,
+                                      const Vector3<T> &_angularVelocity1,
+                                      const T _deltaT) const
+      {
+        const Vector3<T> rotation =
+            (_angularVelocity0 + _angularVelocity1) * (_deltaT / 2) -
+            _angularVelocity0.Cross(_angularVelocity1) *
+            (_deltaT * _deltaT / 12);
+        return this->Integrate(rotation, T(1));
+      }
+
       /// \brief Get the w component.
       /// \return The w quaternion component.
-      public: inline const T &W() const
+      public: constexpr const T &W() const
       {
         return this->qw;
       }
 
       /// \brief Get the x component.
       /// \return The x quaternion component.
-      public: inline const T &X() const
+      public: constexpr const T &X() const
       {
         return this->qx;
       }
 
       /// \brief Get the y component.
       /// \return The y quaternion component.
-      public: inline const T &Y() const
+      public: constexpr const T &Y() const
       {
         return this->qy;
       }
 
       /// \brief Get the z component.
       /// \return The z quaternion component.
-      public: inline const T &Z() const
+      public: constexpr const T &Z() const
       {
         return this->qz;
       }
@@ -991,56 +1098,56 @@ namespace ignition
 
       /// \brief Get a mutable w component.
       /// \return The w quaternion component.
-      public: inline T &W()
+      public: constexpr T &W()
       {
         return this->qw;
       }
 
       /// \brief Get a mutable x component.
       /// \return The x quaternion component.
-      public: inline T &X()
+      public: constexpr T &X()
       {
         return this->qx;
       }
 
       /// \brief Get a mutable y component.
       /// \return The y quaternion component.
-      public: inline T &Y()
+      public: constexpr T &Y()
       {
         return this->qy;
       }
 
       /// \brief Get a mutable z component.
       /// \return The z quaternion component.
-      public: inline T &Z()
+      public: constexpr T &Z()
       {
         return this->qz;
       }
 
       /// \brief Set the x component.
       /// \param[in] _v The new value for the x quaternion component.
-      public: inline void X(T _v)
+      public: constexpr void X(T _v)
       {
         this->qx = _v;
       }
 
       /// \brief Set the y component.
       /// \param[in] _v The new value for the y quaternion component.
-      public: inline void Y(T _v)
+      public: constexpr void Y(T _v)
       {
         this->qy = _v;
       }
 
       /// \brief Set the z component.
       /// \param[in] _v The new value for the z quaternion component.
-      public: inline void Z(T _v)
+      public: constexpr void Z(T _v)
       {
         this->qz = _v;
       }
 
       /// \brief Set the w component.
       /// \param[in] _v The new value for the w quaternion component.
-      public: inline void W(T _v)
+      public: constexpr void W(T _v)
       {
         this->qw = _v;
       }
@@ -0,0 +1,1185 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_QUATERNIONSOA_HH_
+#define GZ_MATH_QUATERNIONSOA_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/Matrix3SoA.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector3SoA.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class QuaternionSoA QuaternionSoA.hh ignition/math/QuaternionSoA.hh
+    /// \brief A structure-of-arrays container of quaternions.
+    ///
+    /// Like Vector3SoA, each component is kept in its own contiguous array
+    /// so that the batch operations below run as plain loops that
+    /// compilers auto-vectorize. Multiply, RotateVector and Normalize match
+    /// the corresponding Quaternion operations, and Slerp and Squad
+    /// interpolate many pairs of rotations at once, as needed to blend the
+    /// orientations of many bodies. Nlerp and SlerpFast are approximations
+    /// of Slerp without trigonometric functions, which vectorize. Integrate
+    /// propagates the attitudes of many bodies from their angular
+    /// velocities.
+    /// Euler, ToMatrix and ToAxis, and SetFromEuler, SetFromMatrix and
+    /// SetFromAxis, convert many orientations at once.
+    ///
+    /// Individual elements can be read and written as Quaternion<T>, and
+    /// the component arrays are exposed through WData(), XData(), YData()
+    /// and ZData().
+    template<typename T>
+    class QuaternionSoA
+    {
+      /// \brief Default constructor, creates an empty container.
+      public: QuaternionSoA() = default;
+
+      /// \brief Constructor, creates _size identity quaternions.
+      /// \param[in] _size Number of elements.
+      public: explicit QuaternionSoA(const std::size_t _size)
+        : w(_size, T(1)), x(_size, T(0)), y(_size, T(0)), z(_size, T(0))
+      {
+      }
+
+      /// \brief Constructor from an array of Quaternion.
+      /// \param[in] _q Quaternions to copy.
+      public: explicit QuaternionSoA(const std::vector<Quaternion<T>> &_q)
+      {
+        this->Assign(_q);
+      }
+
+      /// \brief Replace the contents with a copy of an array of Quaternion.
+      /// \param[in] _q Quaternions to copy.
+      public: void Assign(const std::vector<Quaternion<T>> &_q)
+      {
+        this->Resize(_q.size());
+        for (std::size_t i = 0; i < _q.size(); ++i)
+          this->Set(i, _q[i]);
+      }
+
+      /// \brief Copy the contents into an array of Quaternion.
+      /// \param[out] _q Destination, resized to Size().
+      public: void CopyTo(std::vector<Quaternion<T>> &_q) const
+      {
+        _q.resize(this->Size());
+        for (std::size_t i = 0; i < this->Size(); ++i)
+          _q[i].Set(this->w[i], this->x[i], this->y[i], this->z[i]);
+      }
+
+      /// \brief Get the contents as an array of Quaternion.
+      /// \return A copy of the elements.
+      public: std::vector<Quaternion<T>> ToVector() const
+      {
+        std::vector<Quaternion<T>> result;
+        this->CopyTo(result);
+        return result;
+      }
+
+      /// \brief Get the number of elements.
+      /// \return Number of elements.
+      public: std::size_t Size() const
+      {
+        return this->w.size();
+      }
+
+      /// \brief Check if the container is empty.
+      /// \return True if there are no elements.
+      public: bool Empty() const
+      {
+        return this->w.empty();
+      }
+
+      /// \brief Change the number of elements. New elements are identity
+      /// quaternions.
+      /// \param[in] _size New number of elements.
+      public: void Resize(const std::size_t _size)
+      {
+        this->w.resize(_size, T(1));
+        this->x.resize(_size, T(0));
+        this->y.resize(_size, T(0));
+        this->z.resize(_size, T(0));
+      }
+
+      /// \brief Reserve storage for a number of elements.
+      /// \param[in] _size Number of elements to reserve.
+      public: void Reserve(const std::size_t _size)
+      {
+        this->w.reserve(_size);
+        this->x.reserve(_size);
+        this->y.reserve(_size);
+        this->z.reserve(_size);
+      }
+
+      /// \brief Remove all the elements.
+      public: void Clear()
+      {
+        this->w.clear();
+        this->x.clear();
+        this->y.clear();
+        this->z.clear();
+      }
+
+      /// \brief Append an element.
+      /// \param[in] _q Quaternion to append.
+      public: void PushBack(const Quaternion<T> &_q)
+      {
+        this->w.push_back(_q.W());
+        this->x.push_back(_q.X());
+        this->y.push_back(_q.Y());
+        this->z.push_back(_q.Z());
+      }
+
+      /// \brief Get an element.
+      /// \param[in] _index Index of the element, must be lower than Size().
+      /// \return A copy of the element.
+      public: Quaternion<T> operator[](const std::size_t _index) const
+      {
+        return Quaternion<T>(this->w[_index], this->x[_index],
+                             this->y[_index], this->z[_index]);
+      }
+
+      /// \brief Set an element.
+      /// \param[in] _index Index of the element, must be lower than Size().
+      /// \param[in] _q New value.
+      public: void Set(const std::size_t _index, const Quaternion<T> &_q)
+      {
+        this->w[_index] = _q.W();
+        this->x[_index] = _q.X();
+        this->y[_index] = _q.Y();
+        this->z[_index] = _q.Z();
+      }
+
+      /// \brief Get the w components.
+      /// \return Pointer to the Size() contiguous w components.
+      public: T *WData() { return this->w.data(); }
+
+      /// \brief Get the w components.
+      /// \return Pointer to the Size() contiguous w components.
+      public: const T *WData() const { return this->w.data(); }
+
+      /// \brief Get the x components.
+      /// \return Pointer to the Size() contiguous x components.
+      public: T *XData() { return this->x.data(); }
+
+      /// \brief Get the x components.
+      /// \return Pointer to the Size() contiguous x components.
+      public: const T *XData() const { return this->x.data(); }
+
+      /// \brief Get the y components.
+      /// \return Pointer to the Size() contiguous y components.
+      public: T *YData() { return this->y.data(); }
+
+      /// \brief Get the y components.
+      /// \return Pointer to the Size() contiguous y components.
+      public: const T *YData() const { return this->y.data(); }
+
+      /// \brief Get the z components.
+      /// \return Pointer to the Size() contiguous z components.
+      public: T *ZData() { return this->z.data(); }
+
+      /// \brief Get the z components.
+      /// \return Pointer to the Size() contiguous z components.
+      public: const T *ZData() const { return this->z.data(); }
+
+      /// \brief Element-wise Hamilton product, _out[i] = _a[i] * _b[i].
+      /// _a and _b must have the same size. _out may alias either input.
+      /// \param[in] _a Left operands.
+      /// \param[in] _b Right operands.
+      /// \param[out] _out Result, resized to _a.Size().
+      public: static void Multiply(const QuaternionSoA<T> &_a,
+                                   const QuaternionSoA<T> &_b,
+                                   QuaternionSoA<T> &_out)
+      {
+        const std::size_t n = _a.Size();
+        _out.Resize(n);
+        MultiplyKernel<false, false>(n,
+            _a.w.data(), _a.x.data(), _a.y.data(), _a.z.data(),
+            _b.w.data(), _b.x.data(), _b.y.data(), _b.z.data(), _out);
+      }
+
+      /// \brief Multiply one quaternion by every element,
+      /// _out[i] = _q * _b[i]. This applies the same rotation to many
+      /// orientations. _out may alias _b.
+      /// \param[in] _q Left operand.
+      /// \param[in] _b Right operands.
+      /// \param[out] _out Result, resized to _b.Size().
+      public: static void Multiply(const Quaternion<T> &_q,
+                                   const QuaternionSoA<T> &_b,
+                                   QuaternionSoA<T> &_out)
+      {
+        const std::size_t n = _b.Size();
+        _out.Resize(n);
+        const T qw = _q.W(), qx = _q.X(), qy = _q.Y(), qz = _q.Z();
+        MultiplyKernel<true, false>(n, &qw, &qx, &qy, &qz,
+            _b.w.data(), _b.x.data(), _b.y.data(), _b.z.data(), _out);
+      }
+
+      /// \brief Multiply every element by one quaternion,
+      /// _out[i] = _a[i] * _q. This applies the same local rotation to many
+      /// orientations. _out may alias _a.
+      /// \param[in] _a Left operands.
+      /// \param[in] _q Right operand.
+      /// \param[out] _out Result, resized to _a.Size().
+      public: static void Multiply(const QuaternionSoA<T> &_a,
+                                   const Quaternion<T> &_q,
+                                   QuaternionSoA<T> &_out)
+      {
+        const std::size_t n = _a.Size();
+        _out.Resize(n);
+        const T qw = _q.W(), qx = _q.X(), qy = _q.Y(), qz = _q.Z();
+        MultiplyKernel<false, true>(n,
+            _a.w.data(), _a.x.data(), _a.y.data(), _a.z.data(),
+            &qw, &qx, &qy, &qz, _out);
+      }
+
+      /// \brief Rotate every vector by the matching quaternion,
+      /// _out[i] = this[i].RotateVector(_v[i]). As in
+      /// Quaternion::RotateVector, quaternions don't need to be normalized,
+      /// and zero quaternions give zero vectors.
+      /// \param[in] _v Vectors to rotate, must have the same size.
+      /// \param[out] _out Rotated vectors, resized to Size(). It may alias
+      /// _v.
+      public: void RotateVector(const Vector3SoA<T> &_v,
+                                Vector3SoA<T> &_out) const
+      {
+        const std::size_t n = this->Size();
+        _out.Resize(n);
+        const T *qw = this->w.data(), *qx = this->x.data(),
+                *qy = this->y.data(), *qz = this->z.data();
+        const T *vx = _v.XData(), *vy = _v.YData(), *vz = _v.ZData();
+        T *ox = _out.XData(), *oy = _out.YData(), *oz = _out.ZData();
+
+        T rx[kBlockSize], ry[kBlockSize], rz[kBlockSize];
+        ForEachBlock(n, [&](const std::size_t _start, const auto _m)
+        {
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            // q v q^-1 = v + 2 / |q|^2 (w (u x v) + u x (u x v)), with u
+            // the vector part of q.
+            const T norm2 = qw[i] * qw[i] + qx[i] * qx[i] +
+                            qy[i] * qy[i] + qz[i] * qz[i];
+            const T keep = std::abs(norm2) <= static_cast<T>(1e-6) ?
+                T(0) : T(1);
+            const T s = keep * T(2) / (norm2 + T(1) - keep);
+
+            const T tx = qy[i] * vz[i] - qz[i] * vy[i];
+            const T ty = qz[i] * vx[i] - qx[i] * vz[i];
+            const T tz = qx[i] * vy[i] - qy[i] * vx[i];
+            const T ux = qw[i] * tx + qy[i] * tz - qz[i] * ty;
+            const T uy = qw[i] * ty + qz[i] * tx - qx[i] * tz;
+            const T uz = qw[i] * tz + qx[i] * ty - qy[i] * tx;
+
+            rx[j] = keep * vx[i] + s * ux;
+            ry[j] = keep * vy[i] + s * uy;
+            rz[j] = keep * vz[i] + s * uz;
+          }
+          std::copy(rx, rx + _m, ox + _start);
+          std::copy(ry, ry + _m, oy + _start);
+          std::copy(rz, rz + _m, oz + _start);
+        });
+      }
+
+      /// \brief Normalize every element in place. As in
+      /// Quaternion::Normalize, zero quaternions become identity
+      /// quaternions.
+      public: void Normalize()
+      {
+        const std::size_t n = this->Size();
+        T *qw = this->w.data(), *qx = this->x.data(),
+          *qy = this->y.data(), *qz = this->z.data();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          const T s = static_cast<T>(std::sqrt(qw[i] * qw[i] +
+              qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i]));
+          // Branch free: zero quaternions are scaled by zero and get a w
+          // component of one.
+          const T keep = std::abs(s) <= static_cast<T>(1e-6) ? T(0) : T(1);
+          const T inv = keep / (s + T(1) - keep);
+          qw[i] = qw[i] * inv + (T(1) - keep);
+          qx[i] *= inv;
+          qy[i] *= inv;
+          qz[i] *= inv;
+        }
+      }
+
+      /// \brief Convert every element to Euler angles,
+      /// _out[i] = this[i].Euler(), with the same branches and tolerances
+      /// as Quaternion::Euler. The generic case is computed for a block of
+      /// elements without branches, and the elements at a pitch of PI/2 or
+      /// -PI/2 are corrected afterwards, so that the loop vectorizes with
+      /// FastPrecision.
+      /// \param[out] _out Roll, pitch and yaw angles in radians, resized to
+      /// Size().
+      /// \tparam Precision FullPrecision, or FastPrecision to use the
+      /// approximate trigonometric functions of Helpers.hh.
+      public: template<typename Precision = FullPrecision>
+              void Euler(Vector3SoA<T> &_out) const
+      {
+        const std::size_t n = this->Size();
+        _out.Resize(n);
+        const T *qw = this->w.data(), *qx = this->x.data(),
+                *qy = this->y.data(), *qz = this->z.data();
+        T *ox = _out.XData(), *oy = _out.YData(), *oz = _out.ZData();
+        const T tol = static_cast<T>(1e-15);
+
+        T nw[kBlockSize], nx[kBlockSize], ny[kBlockSize], nz[kBlockSize];
+        T rx[kBlockSize], ry[kBlockSize], rz[kBlockSize];
+        ForEachBlock(n, [&](const std::size_t _start, const auto _m)
+        {
+          std::size_t singular = 0;
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            T cw = qw[i], cx = qx[i], cy = qy[i], cz = qz[i];
+            NormalizeKernel(cw, cx, cy, cz);
+            nw[j] = cw;
+            nx[j] = cx;
+            ny[j] = cy;
+            nz[j] = cz;
+
+            const T squ = cw * cw;
+            const T sqx = cx * cx;
+            const T sqy = cy * cy;
+            const T sqz = cz * cz;
+
+            const T sarg = -2 * (cx * cz - cw * cy);
+            const T clamped = std::min(std::max(sarg, T(-1)), T(1));
+            const T pitch = Precision::Asin(clamped);
+            ry[j] = sarg <= T(-1.0) ? static_cast<T>(-0.5 * IGN_PI) :
+                (sarg >= T(1.0) ? static_cast<T>(0.5 * IGN_PI) : pitch);
+            rx[j] = Precision::Atan2(static_cast<T>(2 * (cy * cz + cw * cx)),
+                                     static_cast<T>(squ - sqx - sqy + sqz));
+            rz[j] = Precision::Atan2(static_cast<T>(2 * (cx * cy + cw * cz)),
+                                     static_cast<T>(squ + sqx - sqy - sqz));
+            singular += (std::abs(sarg - 1) < tol) |
+                        (std::abs(sarg + 1) < tol);
+          }
+
+          // At a pitch of PI/2 or -PI/2, only roll + yaw is known, and yaw
+          // is set to 0.
+          for (std::size_t j = 0; singular > 0 && j < _m; ++j)
+          {
+            const T sarg = -2 * (nx[j] * nz[j] - nw[j] * ny[j]);
+            const bool north = std::abs(sarg - 1) < tol;
+            if (!north && !(std::abs(sarg + 1) < tol))
+              continue;
+            const T up = north ? T(1) : T(-1);
+            --singular;
+            const T squ = nw[j] * nw[j];
+            const T sqx = nx[j] * nx[j];
+            const T sqy = ny[j] * ny[j];
+            const T sqz = nz[j] * nz[j];
+            rz[j] = T(0);
+            rx[j] = Precision::Atan2(
+                static_cast<T>(up * 2 * (nx[j] * ny[j] - nz[j] * nw[j])),
+                static_cast<T>(squ - sqx + sqy - sqz));
+          }
+          std::copy(rx, rx + _m, ox + _start);
+          std::copy(ry, ry + _m, oy + _start);
+          std::copy(rz, rz + _m, oz + _start);
+        });
+      }
+
+      /// \brief Set every element from Euler angles, this[i].Euler(
+      /// _euler[i]), as in Quaternion::Euler(T, T, T) including its
+      /// normalization. With FastPrecision, the loop vectorizes.
+      /// \param[in] _euler Roll, pitch and yaw angles in radians. This is
+      /// resized to its size.
+      /// \tparam Precision FullPrecision, or FastPrecision to use the
+      /// approximate trigonometric functions of Helpers.hh.
+      public: template<typename Precision = FullPrecision>
+              void SetFromEuler(const Vector3SoA<T> &_euler)
+      {
+        const std::size_t n = _euler.Size();
+        this->Resize(n);
+        const T *ex = _euler.XData(), *ey = _euler.YData(),
+                *ez = _euler.ZData();
+        T *ow = this->w.data(), *ox = this->x.data(),
+          *oy = this->y.data(), *oz = this->z.data();
+
+        T rw[kBlockSize], rx[kBlockSize], ry[kBlockSize], rz[kBlockSize];
+        ForEachBlock(n, [&](const std::size_t _start, const auto _m)
+        {
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            T sphi, cphi, sthe, cthe, spsi, cpsi;
+            Precision::SinCos(static_cast<T>(ex[i] / T(2.0)), sphi, cphi);
+            Precision::SinCos(static_cast<T>(ey[i] / T(2.0)), sthe, cthe);
+            Precision::SinCos(static_cast<T>(ez[i] / T(2.0)), spsi, cpsi);
+
+            T cw = cphi * cthe * cpsi + sphi * sthe * spsi;
+            T cx = sphi * cthe * cpsi - cphi * sthe * spsi;
+            T cy = cphi * sthe * cpsi + sphi * cthe * spsi;
+            T cz = cphi * cthe * spsi - sphi * sthe * cpsi;
+            NormalizeKernel(cw, cx, cy, cz);
+            rw[j] = cw;
+            rx[j] = cx;
+            ry[j] = cy;
+            rz[j] = cz;
+          }
+          std::copy(rw, rw + _m, ow + _start);
+          std::copy(rx, rx + _m, ox + _start);
+          std::copy(ry, ry + _m, oy + _start);
+          std::copy(rz, rz + _m, oz + _start);
+        });
+      }
+
+      /// \brief Convert every element to a rotation matrix,
+      /// _out[i] = Matrix3<T>(this[i]), normalizing a copy of the element
+      /// first as the Matrix3 constructor does.
+      /// \param[out] _out Rotation matrices, resized to Size().
+      public: void ToMatrix(Matrix3SoA<T> &_out) const
+      {
+        const std::size_t n = this->Size();
+        _out.Resize(n);
+        const T *qw = this->w.data(), *qx = this->x.data(),
+                *qy = this->y.data(), *qz = this->z.data();
+        T *o[9];
+        for (std::size_t k = 0; k < 9; ++k)
+          o[k] = _out.Data(k / 3, k % 3);
+
+        T r[9][kBlockSize];
+        ForEachBlock(n, [&](const std::size_t _start, const auto _m)
+        {
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            T cw = qw[i], cx = qx[i], cy = qy[i], cz = qz[i];
+            NormalizeKernel(cw, cx, cy, cz);
+            r[0][j] = 1 - 2 * cy * cy - 2 * cz * cz;
+            r[1][j] = 2 * cx * cy - 2 * cz * cw;
+            r[2][j] = 2 * cx * cz + 2 * cy * cw;
+            r[3][j] = 2 * cx * cy + 2 * cz * cw;
+            r[4][j] = 1 - 2 * cx * cx - 2 * cz * cz;
+            r[5][j] = 2 * cy * cz - 2 * cx * cw;
+            r[6][j] = 2 * cx * cz - 2 * cy * cw;
+            r[7][j] = 2 * cy * cz + 2 * cx * cw;
+            r[8][j] = 1 - 2 * cx * cx - 2 * cy * cy;
+          }
+          for (std::size_t k = 0; k < 9; ++k)
+            std::copy(r[k], r[k] + _m, o[k] + _start);
+        });
+      }
+
+      /// \brief Set every element from a rotation matrix, as in
+      /// Quaternion::Matrix. The branches on the trace and the largest
+      /// diagonal term are kept, since computing all four cases to select
+      /// one costs more than the mispredicted branches.
+      /// \param[in] _mat Rotation matrices, which must be orthogonal. This
+      /// is resized to their number.
+      public: void SetFromMatrix(const Matrix3SoA<T> &_mat)
+      {
+        const std::size_t n = _mat.Size();
+        this->Resize(n);
+        const T *m00 = _mat.Data(0, 0), *m01 = _mat.Data(0, 1),
+                *m02 = _mat.Data(0, 2), *m10 = _mat.Data(1, 0),
+                *m11 = _mat.Data(1, 1), *m12 = _mat.Data(1, 2),
+                *m20 = _mat.Data(2, 0), *m21 = _mat.Data(2, 1),
+                *m22 = _mat.Data(2, 2);
+        T *ow = this->w.data(), *ox = this->x.data(),
+          *oy = this->y.data(), *oz = this->z.data();
+
+        T rw[kBlockSize], rx[kBlockSize], ry[kBlockSize], rz[kBlockSize];
+        ForEachBlock(n, [&](const std::size_t _start, const auto _m)
+        {
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            const T trace = m00[i] + m11[i] + m22[i];
+            if (trace > 0.0000001)
+            {
+              rw[j] = static_cast<T>(std::sqrt(1 + trace) / 2);
+              const T s = static_cast<T>(1.0 / (4 * rw[j]));
+              rx[j] = (m21[i] - m12[i]) * s;
+              ry[j] = (m02[i] - m20[i]) * s;
+              rz[j] = (m10[i] - m01[i]) * s;
+            }
+            else if (m00[i] > m11[i] && m00[i] > m22[i])
+            {
+              rx[j] = static_cast<T>(
+                  std::sqrt(1.0 + m00[i] - m11[i] - m22[i]) / 2);
+              const T s = static_cast<T>(1.0 / (4 * rx[j]));
+              rw[j] = (m21[i] - m12[i]) * s;
+              ry[j] = (m10[i] + m01[i]) * s;
+              rz[j] = (m02[i] + m20[i]) * s;
+            }
+            else if (m11[i] > m22[i])
+            {
+              ry[j] = static_cast<T>(
+                  std::sqrt(1.0 - m00[i] + m11[i] - m22[i]) / 2);
+              const T s = static_cast<T>(1.0 / (4 * ry[j]));
+              rw[j] = (m02[i] - m20[i]) * s;
+              rx[j] = (m01[i] + m10[i]) * s;
+              rz[j] = (m12[i] + m21[i]) * s;
+            }
+            else
+            {
+              rz[j] = static_cast<T>(
+                  std::sqrt(1.0 - m00[i] - m11[i] + m22[i]) / 2);
+              const T s = static_cast<T>(1.0 / (4 * rz[j]));
+              rw[j] = (m10[i] - m01[i]) * s;
+              rx[j] = (m02[i] + m20[i]) * s;
+              ry[j] = (m12[i] + m21[i]) * s;
+            }
+          }
+          std::copy(rw, rw + _m, ow + _start);
+          std::copy(rx, rx + _m, ox + _start);
+          std::copy(ry, ry + _m, oy + _start);
+          std::copy(rz, rz + _m, oz + _start);
+        });
+      }
+
+      /// \brief Convert every element to an axis and an angle, as in
+      /// Quaternion::ToAxis. Elements without a vector part get the X axis
+      /// and a zero angle. With FastPrecision, the loop vectorizes.
+      /// \param[out] _axis Unit rotation axes, resized to Size().
+      /// \param[out] _angle Counterclockwise angles in radians, resized to
+      /// Size().
+      /// \tparam Precision FullPrecision, or FastPrecision to use the
+      /// approximate trigonometric functions of Helpers.hh.
+      public: template<typename Precision = FullPrecision>
+              void ToAxis(Vector3SoA<T> &_axis, std::vector<T> &_angle) const
+      {
+        const std::size_t n = this->Size();
+        _axis.Resize(n);
+        _angle.resize(n);
+        const T *qw = this->w.data(), *qx = this->x.data(),
+                *qy = this->y.data(), *qz = this->z.data();
+        T *ax = _axis.XData(), *ay = _axis.YData(), *az = _axis.ZData();
+        T *oa = _angle.data();
+
+        T ra[kBlockSize], rx[kBlockSize], ry[kBlockSize], rz[kBlockSize];
+        ForEachBlock(n, [&](const std::size_t _start, const auto _m)
+        {
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            const T len = qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i];
+            const bool zero = std::abs(len) <= static_cast<T>(1e-6);
+            const T invLen = static_cast<T>(
+                1.0 / std::sqrt(zero ? T(1) : len));
+            const T angle = static_cast<T>(2.0 * Precision::Acos(qw[i]));
+            ra[j] = zero ? T(0) : angle;
+            rx[j] = zero ? T(1) : qx[i] * invLen;
+            ry[j] = zero ? T(0) : qy[i] * invLen;
+            rz[j] = zero ? T(0) : qz[i] * invLen;
+          }
+          std::copy(ra, ra + _m, oa + _start);
+          std::copy(rx, rx + _m, ax + _start);
+          std::copy(ry, ry + _m, ay + _start);
+          std::copy(rz, rz + _m, az + _start);
+        });
+      }
+
+      /// \brief Set every element from an axis and an angle,
+      /// this[i].Axis(_axis[i], _angle[i]), as in Quaternion::Axis
+      /// including its normalization. With FastPrecision, the loop
+      /// vectorizes.
+      /// \param[in] _axis Rotation axes, which need not be unit vectors.
+      /// This is resized to their number.
+      /// \param[in] _angle Angles in radians, must have the size of _axis.
+      /// \tparam Precision FullPrecision, or FastPrecision to use the
+      /// approximate trigonometric functions of Helpers.hh.
+      public: template<typename Precision = FullPrecision>
+              void SetFromAxis(const Vector3SoA<T> &_axis,
+                               const std::vector<T> &_angle)
+      {
+        const std::size_t n = _axis.Size();
+        this->Resize(n);
+        const T *ax = _axis.XData(), *ay = _axis.YData(),
+                *az = _axis.ZData();
+        const T *aa = _angle.data();
+        T *ow = this->w.data(), *ox = this->x.data(),
+          *oy = this->y.data(), *oz = this->z.data();
+
+        T rw[kBlockSize], rx[kBlockSize], ry[kBlockSize], rz[kBlockSize];
+        ForEachBlock(n, [&](const std::size_t _start, const auto _m)
+        {
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            const T l = ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i];
+            const bool zero = std::abs(l) <= static_cast<T>(1e-6);
+            T sine, cosine;
+            Precision::SinCos(static_cast<T>(aa[i] * 0.5), sine, cosine);
+            const T scale = static_cast<T>(
+                sine / std::sqrt(zero ? T(1) : l));
+            T cw = zero ? T(1) : cosine;
+            T cx = zero ? T(0) : ax[i] * scale;
+            T cy = zero ? T(0) : ay[i] * scale;
+            T cz = zero ? T(0) : az[i] * scale;
+            NormalizeKernel(cw, cx, cy, cz);
+            rw[j] = cw;
+            rx[j] = cx;
+            ry[j] = cy;
+            rz[j] = cz;
+          }
+          std::copy(rw, rw + _m, ow + _start);
+          std::copy(rx, rx + _m, ox + _start);
+          std::copy(ry, ry + _m, oy + _start);
+          std::copy(rz, rz + _m, oz + _start);
+        });
+      }
+
+      /// \brief Integrate every element for a constant angular velocity,
+      /// _out[i] = this[i].Integrate(_angularVelocity[i], _deltaT). Steps
+      /// which rotate by less than 0.5 radians, such as those of attitude
+      /// propagation from gyroscope rates, use a series without
+      /// trigonometric functions which vectorizes.
+      /// \param[in] _angularVelocity Angular velocity vectors, must have the
+      /// size of this.
+      /// \param[in] _deltaT Time interval in seconds to integrate over.
+      /// \param[out] _out Integrated quaternions, resized to Size(). It may
+      /// alias this.
+      public: void Integrate(const Vector3SoA<T> &_angularVelocity,
+                             const T _deltaT, QuaternionSoA<T> &_out) const
+      {
+        this->IntegrateKernel<false>(
+            _angularVelocity, _angularVelocity, _deltaT, _out);
+      }
+
+      /// \brief Integrate every element for an angular velocity which
+      /// varies linearly along the interval, with the coning correction of
+      /// Quaternion::Integrate, _out[i] = this[i].Integrate(
+      /// _angularVelocity0[i], _angularVelocity1[i], _deltaT).
+      /// \param[in] _angularVelocity0 Angular velocity vectors at the start
+      /// of the interval, must have the size of this.
+      /// \param[in] _angularVelocity1 Angular velocity vectors at the end of
+      /// the interval, must have the size of this.
+      /// \param[in] _deltaT Time interval in seconds to integrate over.
+      /// \param[out] _out Integrated quaternions, resized to Size(). It may
+      /// alias this.
+      public: void Integrate(const Vector3SoA<T> &_angularVelocity0,
+                             const Vector3SoA<T> &_angularVelocity1,
+                             const T _deltaT, QuaternionSoA<T> &_out) const
+      {
+        this->IntegrateKernel<true>(
+            _angularVelocity0, _angularVelocity1, _deltaT, _out);
+      }
+
+      /// \brief Element-wise spherical linear interpolation with a common
+      /// parameter, _out[i] = Quaternion::Slerp(_t, _p[i], _q[i]).
+      /// \param[in] _t Interpolation parameter, between 0 and 1.
+      /// \param[in] _p Start quaternions.
+      /// \param[in] _q End quaternions, must have the size of _p.
+      /// \param[out] _out Result, resized to _p.Size(). It may alias either
+      /// input.
+      /// \param[in] _shortestPath When true, the rotation may be inverted to
+      /// minimize rotation.
+      /// \tparam Precision FullPrecision, or FastPrecision to use the
+      /// approximate trigonometric functions of Helpers.hh.
+      public: template<typename Precision = FullPrecision>
+              static void Slerp(const T _t, const QuaternionSoA<T> &_p,
+                                const QuaternionSoA<T> &_q,
+                                QuaternionSoA<T> &_out,
+                                const bool _shortestPath = false)
+      {
+        const std::size_t n = _p.Size();
+        _out.Resize(n);
+        SlerpKernel<Precision>(n, &_t, 0, _p, _q, _out, _shortestPath);
+      }
+
+      /// \brief Element-wise spherical linear interpolation with one
+      /// parameter per element,
+      /// _out[i] = Quaternion::Slerp(_t[i], _p[i], _q[i]).
+      /// \param[in] _t Interpolation parameters, between 0 and 1, must have
+      /// the size of _p.
+      /// \param[in] _p Start quaternions.
+      /// \param[in] _q End quaternions, must have the size of _p.
+      /// \param[out] _out Result, resized to _p.Size(). It may alias either
+      /// input.
+      /// \param[in] _shortestPath When true, the rotation may be inverted to
+      /// minimize rotation.
+      /// \tparam Precision FullPrecision, or FastPrecision to use the
+      /// approximate trigonometric functions of Helpers.hh.
+      public: template<typename Precision = FullPrecision>
+              static void Slerp(const std::vector<T> &_t,
+                                const QuaternionSoA<T> &_p,
+                                const QuaternionSoA<T> &_q,
+                                QuaternionSoA<T> &_out,
+                                const bool _shortestPath = false)
+      {
+        const std::size_t n = _p.Size();
+        _out.Resize(n);
+        SlerpKernel<Precision>(n, _t.data(), 1, _p, _q, _out,
+                               _shortestPath);
+      }
+
+      /// \brief Element-wise normalized linear interpolation with a common
+      /// parameter, _out[i] = Quaternion::Nlerp(_t, _p[i], _q[i]). See
+      /// Quaternion::Nlerp for the error against Slerp. Unlike Slerp, this
+      /// has no trigonometric functions, and it vectorizes.
+      /// \param[in] _t Interpolation parameter, between 0 and 1.
+      /// \param[in] _p Start quaternions.
+      /// \param[in] _q End quaternions, must have the size of _p.
+      /// \param[out] _out Result, resized to _p.Size(). It may alias either
+      /// input.
+      /// \param[in] _shortestPath When true, the rotation may be inverted to
+      /// minimize rotation.
+      public: static void Nlerp(const T _t, const QuaternionSoA<T> &_p,
+                                const QuaternionSoA<T> &_q,
+                                QuaternionSoA<T> &_out,
+                                const bool _shortestPath = false)
+      {
+        const std::size_t n = _p.Size();
+        _out.Resize(n);
+        if (_shortestPath)
+          NlerpKernel<true, false>(n, _t, _p, _q, _out);
+        else
+          NlerpKernel<false, false>(n, _t, _p, _q, _out);
+      }
+
+      /// \brief Element-wise approximate spherical linear interpolation of
+      /// unit quaternions along the shortest path, with a common parameter,
+      /// _out[i] = Quaternion::SlerpFast(_t, _p[i], _q[i]). See
+      /// Quaternion::SlerpFast for the error against Slerp. Unlike Slerp,
+      /// this has no trigonometric functions, and it vectorizes.
+      /// \param[in] _t Interpolation parameter, between 0 and 1.
+      /// \param[in] _p Start quaternions.
+      /// \param[in] _q End quaternions, must have the size of _p.
+      /// \param[out] _out Result, resized to _p.Size(). It may alias either
+      /// input.
+      public: static void SlerpFast(const T _t, const QuaternionSoA<T> &_p,
+                                    const QuaternionSoA<T> &_q,
+                                    QuaternionSoA<T> &_out)
+      {
+        const std::size_t n = _p.Size();
+        _out.Resize(n);
+        NlerpKernel<true, true>(n, _t, _p, _q, _out);
+      }
+
+      /// \brief Element-wise spherical quadratic interpolation with a
+      /// common parameter,
+      /// _out[i] = Quaternion::Squad(_t, _p[i], _a[i], _b[i], _q[i]).
+      /// \param[in] _t Interpolation parameter, between 0 and 1.
+      /// \param[in] _p Start quaternions.
+      /// \param[in] _a First intermediate quaternions.
+      /// \param[in] _b Second intermediate quaternions.
+      /// \param[in] _q End quaternions.
+      /// \param[out] _out Result, resized to _p.Size(). It may alias any
+      /// input.
+      /// \param[in] _shortestPath When true, the rotation from _p to _q may
+      /// be inverted to minimize rotation.
+      /// \tparam Precision FullPrecision, or FastPrecision to use the
+      /// approximate trigonometric functions of Helpers.hh.
+      public: template<typename Precision = FullPrecision>
+              static void Squad(const T _t, const QuaternionSoA<T> &_p,
+                                const QuaternionSoA<T> &_a,
+                                const QuaternionSoA<T> &_b,
+                                const QuaternionSoA<T> &_q,
+                                QuaternionSoA<T> &_out,
+                                const bool _shortestPath = false)
+      {
+        const T slerpT = static_cast<T>(2.0f * _t * (1.0f - _t));
+        QuaternionSoA<T> slerpP;
+        QuaternionSoA<T> slerpQ;
+        Slerp<Precision>(_t, _p, _q, slerpP, _shortestPath);
+        Slerp<Precision>(_t, _a, _b, slerpQ);
+        Slerp<Precision>(slerpT, slerpP, slerpQ, _out);
+      }
+
+      /// \brief Equality operator.
+      /// \param[in] _q Container to compare with.
+      /// \return True if both containers hold the same elements, using the
+      /// same tolerance as Quaternion::operator==.
+      public: bool operator==(const QuaternionSoA<T> &_q) const
+      {
+        if (this->Size() != _q.Size())
+          return false;
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          if ((*this)[i] != _q[i])
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _q Container to compare with.
+      /// \return True if the containers differ.
+      public: bool operator!=(const QuaternionSoA<T> &_q) const
+      {
+        return !(*this == _q);
+      }
+
+      /// \brief Hamilton product of two sets of component arrays.
+      /// \tparam OneA True to use the first element of the left operand for
+      /// every product.
+      /// \tparam OneB True to use the first element of the right operand
+      /// for every product.
+      /// \param[in] _n Number of elements.
+      /// \param[in] _aw Left w components.
+      /// \param[in] _ax Left x components.
+      /// \param[in] _ay Left y components.
+      /// \param[in] _az Left z components.
+      /// \param[in] _bw Right w components.
+      /// \param[in] _bx Right x components.
+      /// \param[in] _by Right y components.
+      /// \param[in] _bz Right z components.
+      /// \param[out] _out Result, already of size _n.
+      private: template<bool OneA, bool OneB>
+               static void MultiplyKernel(const std::size_t _n,
+                   const T *_aw, const T *_ax, const T *_ay, const T *_az,
+                   const T *_bw, const T *_bx, const T *_by, const T *_bz,
+                   QuaternionSoA<T> &_out)
+      {
+        T *ow = _out.w.data(), *ox = _out.x.data(),
+          *oy = _out.y.data(), *oz = _out.z.data();
+
+        T rw[kBlockSize], rx[kBlockSize], ry[kBlockSize], rz[kBlockSize];
+        ForEachBlock(_n, [&](const std::size_t _start, const auto _m)
+        {
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t ia = OneA ? 0 : _start + j;
+            const std::size_t ib = OneB ? 0 : _start + j;
+            const T aw = _aw[ia], ax = _ax[ia], ay = _ay[ia], az = _az[ia];
+            const T bw = _bw[ib], bx = _bx[ib], by = _by[ib], bz = _bz[ib];
+            rw[j] = aw * bw - ax * bx - ay * by - az * bz;
+            rx[j] = aw * bx + ax * bw + ay * bz - az * by;
+            ry[j] = aw * by - ax * bz + ay * bw + az * bx;
+            rz[j] = aw * bz + ax * by - ay * bx + az * bw;
+          }
+          std::copy(rw, rw + _m, ow + _start);
+          std::copy(rx, rx + _m, ox + _start);
+          std::copy(ry, ry + _m, oy + _start);
+          std::copy(rz, rz + _m, oz + _start);
+        });
+      }
+
+      /// \brief Call a function on consecutive blocks of at most kBlockSize
+      /// elements. The batch operations compute each block into local
+      /// arrays, which can't alias the inputs, and then copy it to the
+      /// output, so that the compiler vectorizes them without runtime alias
+      /// checks. Full blocks get their size as a compile time constant,
+      /// which avoids a scalar epilogue.
+      /// \param[in] _n Number of elements.
+      /// \param[in] _fn Function called with the index of the first
+      /// element of a block and the size of the block.
+      private: template<typename F>
+               static void ForEachBlock(const std::size_t _n, F &&_fn)
+      {
+        std::size_t start = 0;
+        for (; start + kBlockSize <= _n; start += kBlockSize)
+          _fn(start, std::integral_constant<std::size_t, kBlockSize>());
+        if (start < _n)
+          _fn(start, _n - start);
+      }
+
+      /// \brief Normalized linear interpolation of two sets of quaternions.
+      /// \tparam Shortest True to invert the rotation when it minimizes it.
+      /// \tparam Fast True to correct the parameter as in
+      /// Quaternion::SlerpFast.
+      /// \param[in] _n Number of elements.
+      /// \param[in] _t Interpolation parameter.
+      /// \param[in] _p Start quaternions.
+      /// \param[in] _q End quaternions.
+      /// \param[out] _out Result, already of size _n.
+      private: template<bool Shortest, bool Fast>
+               static void NlerpKernel(const std::size_t _n, const T _t,
+                                       const QuaternionSoA<T> &_p,
+                                       const QuaternionSoA<T> &_q,
+                                       QuaternionSoA<T> &_out)
+      {
+        const T *pw = _p.w.data(), *px = _p.x.data(),
+                *py = _p.y.data(), *pz = _p.z.data();
+        const T *qw = _q.w.data(), *qx = _q.x.data(),
+                *qy = _q.y.data(), *qz = _q.z.data();
+        T *ow = _out.w.data(), *ox = _out.x.data(),
+          *oy = _out.y.data(), *oz = _out.z.data();
+
+        T rw[kBlockSize], rx[kBlockSize], ry[kBlockSize], rz[kBlockSize];
+        ForEachBlock(_n, [&](const std::size_t _start, const auto _m)
+        {
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            const T cosine = pw[i] * qw[i] + px[i] * qx[i] +
+                             py[i] * qy[i] + pz[i] * qz[i];
+            const T sign = (Shortest && cosine < 0) ? T(-1) : T(1);
+            const T t = Fast ? Quaternion<T>::SlerpFastParameter(
+                _t, std::abs(cosine)) : _t;
+            const T c0 = 1 - t;
+            const T c1 = t * sign;
+
+            const T bw = pw[i] * c0 + qw[i] * c1;
+            const T bx = px[i] * c0 + qx[i] * c1;
+            const T by = py[i] * c0 + qy[i] * c1;
+            const T bz = pz[i] * c0 + qz[i] * c1;
+
+            // Branch free Quaternion::Normalize
+            const T norm = static_cast<T>(
+                std::sqrt(bw * bw + bx * bx + by * by + bz * bz));
+            const T keep = norm <= static_cast<T>(1e-6) ? T(0) : T(1);
+            const T inv = keep / (norm + T(1) - keep);
+            rw[j] = bw * inv + (T(1) - keep);
+            rx[j] = bx * inv;
+            ry[j] = by * inv;
+            rz[j] = bz * inv;
+          }
+          std::copy(rw, rw + _m, ow + _start);
+          std::copy(rx, rx + _m, ox + _start);
+          std::copy(ry, ry + _m, oy + _start);
+          std::copy(rz, rz + _m, oz + _start);
+        });
+      }
+
+      /// \brief Spherical linear interpolation of two sets of quaternions,
+      /// with the same branches and tolerances as Quaternion::Slerp.
+      /// \param[in] _n Number of elements.
+      /// \param[in] _t Interpolation parameters.
+      /// \param[in] _st Stride of _t, 0 or 1.
+      /// \param[in] _p Start quaternions.
+      /// \param[in] _q End quaternions.
+      /// \param[out] _out Result, already of size _n.
+      /// \param[in] _shortestPath When true, the rotation may be inverted.
+      /// \tparam Precision Precision policy of the trigonometric functions.
+      private: template<typename Precision>
+               static void SlerpKernel(const std::size_t _n, const T *_t,
+                                       const std::size_t _st,
+                                       const QuaternionSoA<T> &_p,
+                                       const QuaternionSoA<T> &_q,
+                                       QuaternionSoA<T> &_out,
+                                       const bool _shortestPath)
+      {
+        const T *pw = _p.w.data(), *px = _p.x.data(),
+                *py = _p.y.data(), *pz = _p.z.data();
+        const T *qw = _q.w.data(), *qx = _q.x.data(),
+                *qy = _q.y.data(), *qz = _q.z.data();
+        T *ow = _out.w.data(), *ox = _out.x.data(),
+          *oy = _out.y.data(), *oz = _out.z.data();
+        for (std::size_t i = 0; i < _n; ++i)
+        {
+          const T t = _t[i * _st];
+          T cosine = pw[i] * qw[i] + px[i] * qx[i] +
+                     py[i] * qy[i] + pz[i] * qz[i];
+          T sign = T(1);
+          if (cosine < 0.0f && _shortestPath)
+          {
+            cosine = -cosine;
+            sign = T(-1);
+          }
+
+          T c0, c1;
+          bool renormalize = false;
+          if (std::abs(cosine) < 1 - 1e-03)
+          {
+            const T sine = static_cast<T>(std::sqrt(1 - cosine * cosine));
+            const T angle = Precision::Atan2(sine, cosine);
+            const T invSine = static_cast<T>(1.0f / sine);
+            c0 = static_cast<T>(
+                Precision::Sin(static_cast<T>((1.0f - t) * angle)) * invSine);
+            c1 = static_cast<T>(Precision::Sin(t * angle) * invSine);
+          }
+          else
+          {
+            // Nearly parallel or opposite rotations, linear interpolation
+            // followed by a normalization as in Quaternion::Slerp.
+            c0 = static_cast<T>(1.0f - t);
+            c1 = t;
+            renormalize = true;
+          }
+          c1 *= sign;
+
+          T rw = pw[i] * c0 + qw[i] * c1;
+          T rx = px[i] * c0 + qx[i] * c1;
+          T ry = py[i] * c0 + qy[i] * c1;
+          T rz = pz[i] * c0 + qz[i] * c1;
+          if (renormalize)
+          {
+            const T s = static_cast<T>(
+                std::sqrt(rw * rw + rx * rx + ry * ry + rz * rz));
+            if (equal<T>(s, static_cast<T>(0)))
+            {
+              rw = T(1);
+              rx = ry = rz = T(0);
+            }
+            else
+            {
+              rw /= s;
+              rx /= s;
+              ry /= s;
+              rz /= s;
+            }
+          }
+          ow[i] = rw;
+          ox[i] = rx;
+          oy[i] = ry;
+          oz[i] = rz;
+        }
+      }
+
+      /// \brief Integrate every element for an angular velocity, as in
+      /// Quaternion::Integrate.
+      /// \tparam Coning True to integrate an angular velocity which varies
+      /// linearly from _w0 to _w1, false for the constant _w0.
+      /// \param[in] _w0 Angular velocities at the start of the interval.
+      /// \param[in] _w1 Angular velocities at the end of the interval, only
+      /// read if Coning is true.
+      /// \param[in] _deltaT Time interval.
+      /// \param[out] _out Result, resized to Size().
+      private: template<bool Coning>
+               void IntegrateKernel(const Vector3SoA<T> &_w0,
+                                    const Vector3SoA<T> &_w1,
+                                    const T _deltaT,
+                                    QuaternionSoA<T> &_out) const
+      {
+        const std::size_t n = this->Size();
+        const T *qw = this->w.data(), *qx = this->x.data(),
+                *qy = this->y.data(), *qz = this->z.data();
+        const T *ax = _w0.XData(), *ay = _w0.YData(), *az = _w0.ZData();
+        const T *bx = _w1.XData(), *by = _w1.YData(), *bz = _w1.ZData();
+        _out.Resize(n);
+        T *ow = _out.w.data(), *ox = _out.x.data(),
+          *oy = _out.y.data(), *oz = _out.z.data();
+        const T half = _deltaT / 2;
+        const T coning = _deltaT * _deltaT / 24;
+
+        // Below this squared half angle, the series of cos(a) and
+        // sin(a) / a in a^2 below are exact to double precision.
+        const T seriesLimit = static_cast<T>(0.0625);
+
+        T tx[kBlockSize], ty[kBlockSize], tz[kBlockSize];
+        T dw[kBlockSize], ds[kBlockSize];
+        T rw[kBlockSize], rx[kBlockSize], ry[kBlockSize], rz[kBlockSize];
+        ForEachBlock(n, [&](const std::size_t _start, const auto _m)
+        {
+          // Half of the rotation vector of the interval, and its
+          // exponential map with the series.
+          std::size_t large = 0;
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            if (Coning)
+            {
+              tx[j] = (ax[i] + bx[i]) * (half / 2) -
+                      (ay[i] * bz[i] - az[i] * by[i]) * coning;
+              ty[j] = (ay[i] + by[i]) * (half / 2) -
+                      (az[i] * bx[i] - ax[i] * bz[i]) * coning;
+              tz[j] = (az[i] + bz[i]) * (half / 2) -
+                      (ax[i] * by[i] - ay[i] * bx[i]) * coning;
+            }
+            else
+            {
+              tx[j] = ax[i] * half;
+              ty[j] = ay[i] * half;
+              tz[j] = az[i] * half;
+            }
+
+            const T a2 = tx[j] * tx[j] + ty[j] * ty[j] + tz[j] * tz[j];
+            large += a2 < seriesLimit ? 0 : 1;
+            dw[j] = 1 + a2 * (static_cast<T>(-1.0 / 2) +
+                    a2 * (static_cast<T>(1.0 / 24) +
+                    a2 * (static_cast<T>(-1.0 / 720) +
+                    a2 * (static_cast<T>(1.0 / 40320) +
+                    a2 * (static_cast<T>(-1.0 / 3628800) +
+                    a2 * static_cast<T>(1.0 / 479001600))))));
+            ds[j] = 1 + a2 * (static_cast<T>(-1.0 / 6) +
+                    a2 * (static_cast<T>(1.0 / 120) +
+                    a2 * (static_cast<T>(-1.0 / 5040) +
+                    a2 * (static_cast<T>(1.0 / 362880) +
+                    a2 * (static_cast<T>(-1.0 / 39916800) +
+                    a2 * static_cast<T>(1.0 / 6227020800.0))))));
+          }
+
+          // Larger angles, as in Quaternion::Integrate
+          if (large > 0)
+          {
+            for (std::size_t j = 0; j < _m; ++j)
+            {
+              const T a2 = tx[j] * tx[j] + ty[j] * ty[j] + tz[j] * tz[j];
+              if (a2 < seriesLimit)
+                continue;
+              const T a = static_cast<T>(std::sqrt(a2));
+              dw[j] = static_cast<T>(std::cos(a));
+              ds[j] = static_cast<T>(std::sin(a) / a);
+            }
+          }
+
+          for (std::size_t j = 0; j < _m; ++j)
+          {
+            const std::size_t i = _start + j;
+            const T dx = tx[j] * ds[j], dy = ty[j] * ds[j],
+                    dz = tz[j] * ds[j];
+            rw[j] = dw[j] * qw[i] - dx * qx[i] - dy * qy[i] - dz * qz[i];
+            rx[j] = dw[j] * qx[i] + dx * qw[i] + dy * qz[i] - dz * qy[i];
+            ry[j] = dw[j] * qy[i] - dx * qz[i] + dy * qw[i] + dz * qx[i];
+            rz[j] = dw[j] * qz[i] + dx * qy[i] - dy * qx[i] + dz * qw[i];
+          }
+          std::copy(rw, rw + _m, ow + _start);
+          std::copy(rx, rx + _m, ox + _start);
+          std::copy(ry, ry + _m, oy + _start);
+          std::copy(rz, rz + _m, oz + _start);
+        });
+      }
+
+      /// \brief Normalize one quaternion as Quaternion::Normalize, without
+      /// branches so that the loops which call it vectorize.
+      /// \param[in,out] _w w component.
+      /// \param[in,out] _x x component.
+      /// \param[in,out] _y y component.
+      /// \param[in,out] _z z component.
+      private: static void NormalizeKernel(T &_w, T &_x, T &_y, T &_z)
+      {
+        const T s = static_cast<T>(
+            std::sqrt(_w * _w + _x * _x + _y * _y + _z * _z));
+        // Zero quaternions are divided by one and scaled by zero, and get
+        // a w component of one.
+        const T keep = std::abs(s) <= static_cast<T>(1e-6) ? T(0) : T(1);
+        const T d = s * keep + (T(1) - keep);
+        _w = _w / d * keep + (T(1) - keep);
+        _x = _x / d * keep;
+        _y = _y / d * keep;
+        _z = _z / d * keep;
+      }
+
+      /// \brief Number of elements processed per local block.
+      private: static constexpr std::size_t kBlockSize = 64;
+
+      /// \brief w components.
+      private: std::vector<T> w;
+
+      /// \brief x components.
+      private: std::vector<T> x;
+
+      /// \brief y components.
+      private: std::vector<T> y;
+
+      /// \brief z components.
+      private: std::vector<T> z;
+    };
+
+    typedef QuaternionSoA<double> QuaternionSoAd;
+    typedef QuaternionSoA<float> QuaternionSoAf;
+    }
+  }
+}
+#endif
@@ -19,8 +19,11 @@
 
 #include <random>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <gz/math/Helpers.hh>
+#include <gz/math/PhiloxEngine.hh>
 #include <gz/math/config.hh>
 
 namespace ignition
@@ -43,8 +46,122 @@ namespace ignition
     /// \brief std::uniform_int<int>
     typedef std::uniform_int_distribution<int32_t> UniformIntDist;
 
+    // Forward declaration.
+    class RandomGeneratorPrivate;
+
+    /// \class RandomGenerator Rand.hh ignition/math/Rand.hh
+    /// \brief A random number generator that owns its engine, as opposed to
+    /// the static functions of Rand that share one engine. A generator is
+    /// not synchronized, so each thread should use its own, such as the one
+    /// returned by Rand::ThreadGenerator().
+    ///
+    /// A generator is seeded with a seed and a stream index, and the same
+    /// pair always produces the same sequence with a given standard library.
+    /// Different streams of the same seed produce independent sequences,
+    /// e.g. one per worker:
+    ///
+    ///     RandomGenerator gen(Rand::Seed(), workerIndex);
+    class IGNITION_MATH_VISIBLE RandomGenerator
+    {
+      /// \brief Constructor. Seeds the generator with Rand::Seed() and
+      /// stream 0.
+      public: RandomGenerator();
+
+      /// \brief Constructor.
+      /// \param[in] _seed The seed of the sequence.
+      /// \param[in] _stream Index of the sequence derived from _seed.
+      public: explicit RandomGenerator(unsigned int _seed,
+                                       uint64_t _stream = 0);
+
+      /// \brief Copy constructor. The copy continues the same sequence.
+      /// \param[in] _gen Generator to copy.
+      public: RandomGenerator(const RandomGenerator &_gen);
+
+      /// \brief Destructor.
+      public: ~RandomGenerator();
+
+      /// \brief Assignment operator. The copy continues the same sequence.
+      /// \param[in] _gen Generator to copy.
+      /// \return Reference to this generator.
+      public: RandomGenerator &operator=(const RandomGenerator &_gen);
+
+      /// \brief Restart the generator with a new seed and stream.
+      /// \param[in] _seed The seed of the sequence.
+      /// \param[in] _stream Index of the sequence derived from _seed.
+      public: void Seed(unsigned int _seed, uint64_t _stream = 0);
+
+      /// \brief Get the seed value.
+      /// \return The seed of the sequence.
+      public: unsigned int Seed() const;
+
+      /// \brief Get the stream index.
+      /// \return Index of the sequence derived from the seed.
+      public: uint64_t Stream() const;
+
+      /// \brief Get a double from a uniform distribution
+      /// \param[in] _min Minimum bound for the random number
+      /// \param[in] _max Maximum bound for the random number
+      /// \return The random number.
+      public: double DblUniform(double _min = 0, double _max = 1);
+
+      /// \brief Get a double from a normal distribution
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      /// \return The random number.
+      public: double DblNormal(double _mean = 0, double _sigma = 1);
+
+      /// \brief Get an integer from a uniform distribution
+      /// \param[in] _min Minimum bound for the random number
+      /// \param[in] _max Maximum bound for the random number
+      /// \return The random number.
+      public: int32_t IntUniform(int _min, int _max);
+
+      /// \brief Get an integer from a normal distribution
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      /// \return The random number.
+      public: int32_t IntNormal(int _mean, int _sigma);
+
+      /// \brief Fill an array with doubles from a uniform distribution.
+      /// The values are the same as those of _count calls to DblUniform.
+      /// \param[out] _values Array of _count values to fill.
+      /// \param[in] _count Number of values.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      public: void FillUniform(double *_values, const std::size_t _count,
+                               double _min = 0, double _max = 1);
+
+      /// \brief Fill an array with doubles from a normal distribution.
+      /// The values are the same as those of _count calls to DblNormal.
+      /// \param[out] _values Array of _count values to fill.
+      /// \param[in] _count Number of values.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      public: void FillNormal(double *_values, const std::size_t _count,
+                              double _mean = 0, double _sigma = 1);
+
+      /// \brief Get the engine, to use with other distributions.
+      /// \return Reference to the engine.
+      public: GeneratorType &Engine();
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<RandomGeneratorPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+
     /// \class Rand Rand.hh ignition/math/Rand.hh
     /// \brief Random number generator class
+    ///
+    /// The static functions share one engine and are not thread safe. Use
+    /// ThreadGenerator() or an owned RandomGenerator in threaded code.
     class IGNITION_MATH_VISIBLE Rand
     {
       /// \brief Set the seed value.
@@ -77,6 +194,27 @@ namespace ignition
       /// \param[in] _sigma Sigma value for the distribution
       public: static int32_t IntNormal(int _mean, int _sigma);
 
+      /// \brief Get the random number generator of the calling thread.
+      /// It is seeded with Seed() and a stream index that is unique to the
+      /// thread, and it is seeded again on its next use after Seed() is
+      /// set. No lock is taken. Stream indices are assigned in the order in
+      /// which threads first call this function; for sequences that do not
+      /// depend on thread scheduling, give each worker its own
+      /// RandomGenerator with a fixed stream index instead.
+      /// \return Reference to the generator of the calling thread.
+      public: static RandomGenerator &ThreadGenerator();
+
+      /// \brief Get a counter based engine keyed by Seed(). Each stream
+      /// produces the same numbers no matter which thread uses it or in
+      /// which order streams are used, which keeps parallel runs
+      /// reproducible when each task draws from its own stream, e.g. the
+      /// index of a Monte-Carlo sample.
+      /// \param[in] _stream Index of the stream.
+      /// \param[in] _position Index of the first output in the stream.
+      /// \return The engine.
+      public: static PhiloxEngine StreamEngine(uint64_t _stream,
+                                               uint64_t _position = 0);
+
       /// \brief Get a mutable reference to the seed (create the static
       /// member if it hasn't been created yet).
       private: static uint32_t &SeedMutable();
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_RANSACFITTER_HH_
+#define GZ_MATH_RANSACFITTER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gz/math/Executor.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/Plane.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/Vector3SoA.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  //
+  // Forward declare private data
+  class RansacFitterPrivate;
+
+  /// \class RansacFitter RansacFitter.hh ignition/math/RansacFitter.hh
+  /// \brief Robust fitting of planes, spheres and cylinders to points
+  /// with RANSAC, such as the segmentation of the ground in a lidar scan.
+  ///
+  /// Each hypothesis is a shape through a minimal random sample of the
+  /// points, scored by its number of inliers, the points within the
+  /// distance threshold of its surface. The hypothesis with the most
+  /// inliers is then refit to them by least squares.
+  ///
+  /// Hypotheses are evaluated in rounds of kHypothesesPerRound, in
+  /// parallel. After each round, the fit stops once enough hypotheses were
+  /// evaluated to have drawn a sample of inliers only with the requested
+  /// confidence, given the best inlier ratio so far. Hypothesis i draws
+  /// its sample from Rand::StreamEngine(Stream() + i), and ties are broken
+  /// by the lowest hypothesis, so the result only depends on Rand::Seed()
+  /// and the stream, and not on the number of threads.
+  ///
+  /// # Example usage
+  ///
+  /// ```{.cpp}
+  /// gz::math::RansacFitter ransac;
+  /// ransac.SetDistanceThreshold(0.05);
+  /// gz::math::Planed ground;
+  /// auto result = ransac.FitPlane(scan, ground);
+  /// if (result.found)
+  ///   gz::math::PointSetFilter::Select(scan, result.inliers, groundPoints);
+  /// ```
+  class IGNITION_MATH_VISIBLE RansacFitter
+  {
+    /// \brief Outcome of a fit.
+    public: struct Result
+            {
+              /// \brief True if a shape with at least the minimum number
+              /// of inliers was found.
+              bool found = false;
+
+              /// \brief Number of hypotheses evaluated.
+              unsigned int iterations = 0;
+
+              /// \brief Indices of the inliers of the shape, in increasing
+              /// order. Empty if no shape was found.
+              std::vector<std::size_t> inliers;
+            };
+
+    /// \brief Number of hypotheses evaluated between two checks of the
+    /// stopping criterion.
+    public: static constexpr unsigned int kHypothesesPerRound = 32;
+
+    /// \brief Constructor.
+    public: RansacFitter();
+
+    /// \brief Copy constructor.
+    /// \param[in] _other Fitter to copy.
+    public: RansacFitter(const RansacFitter &_other);
+
+    /// \brief Destructor.
+    public: ~RansacFitter();
+
+    /// \brief Assignment operator.
+    /// \param[in] _other Fitter to copy.
+    /// \return Reference to this object.
+    public: RansacFitter &operator=(const RansacFitter &_other);
+
+    /// \brief Set the maximum distance from an inlier to the surface of a
+    /// shape.
+    /// \param[in] _distance Distance, inclusive.
+    public: void SetDistanceThreshold(const double _distance);
+
+    /// \brief Get the maximum distance from an inlier to the surface of a
+    /// shape.
+    /// \return Distance. The default is 0.01.
+    public: double DistanceThreshold() const;
+
+    /// \brief Set the maximum number of hypotheses of a fit.
+    /// \param[in] _iterations Number of hypotheses.
+    public: void SetMaxIterations(const unsigned int _iterations);
+
+    /// \brief Get the maximum number of hypotheses of a fit.
+    /// \return Number of hypotheses. The default is 1000.
+    public: unsigned int MaxIterations() const;
+
+    /// \brief Set the probability of having drawn a sample of inliers only
+    /// after which a fit stops early. A value of 1 disables early stops.
+    /// \param[in] _confidence Probability in [0, 1].
+    public: void SetConfidence(const double _confidence);
+
+    /// \brief Get the probability of having drawn a sample of inliers only
+    /// after which a fit stops early.
+    /// \return Probability. The default is 0.99.
+    public: double Confidence() const;
+
+    /// \brief Set the minimum number of inliers of a shape.
+    /// \param[in] _inliers Number of inliers.
+    public: void SetMinInliers(const std::size_t _inliers);
+
+    /// \brief Get the minimum number of inliers of a shape.
+    /// \return Number of inliers. The default is 0, which only requires
+    /// the points of a minimal sample.
+    public: std::size_t MinInliers() const;
+
+    /// \brief Set the range of radii of the spheres and cylinders.
+    /// Hypotheses outside of the range are rejected.
+    /// \param[in] _min Minimum radius.
+    /// \param[in] _max Maximum radius.
+    public: void SetRadiusLimits(const double _min, const double _max);
+
+    /// \brief Get the minimum radius of the spheres and cylinders.
+    /// \return Minimum radius. The default is 0.
+    public: double MinRadius() const;
+
+    /// \brief Get the maximum radius of the spheres and cylinders.
+    /// \return Maximum radius. The default is infinity.
+    public: double MaxRadius() const;
+
+    /// \brief Set the index of the random stream of the first hypothesis.
+    /// Successive fits with the same stream draw the same samples; give
+    /// each frame of a sequence its own range of MaxIterations() streams
+    /// for independent samples.
+    /// \param[in] _stream Stream index.
+    public: void SetStream(const uint64_t _stream);
+
+    /// \brief Get the index of the random stream of the first hypothesis.
+    /// \return Stream index. The default is 0.
+    public: uint64_t Stream() const;
+
+    /// \brief Set the number of threads evaluating hypotheses.
+    /// \param[in] _threads Number of threads. A value of 0 uses the
+    /// number of hardware threads.
+    public: void SetThreadCount(const unsigned int _threads);
+
+    /// \brief Get the number of threads evaluating hypotheses.
+    /// \return Number of threads. The default is 1.
+    public: unsigned int ThreadCount() const;
+
+    /// \brief Set the executor used instead of threads of its own, such
+    /// as a ThreadPool shared with other batch operations. When set, the
+    /// thread count is ignored.
+    /// \param[in] _executor The executor, or nullptr to use the thread
+    /// count again.
+    public: void SetExecutor(std::shared_ptr<Executor> _executor);
+
+    /// \brief Fit a plane to points.
+    /// \param[in] _points The points.
+    /// \param[out] _plane The plane, with a unit normal. It is unchanged
+    /// if no plane is found.
+    /// \return Statistics and inliers of the fit.
+    public: Result FitPlane(const Vector3SoAd &_points,
+                            Planed &_plane) const;
+
+    /// \brief Fit a sphere to points.
+    /// \param[in] _points The points.
+    /// \param[out] _center Center of the sphere.
+    /// \param[out] _radius Radius of the sphere. The center and radius are
+    /// unchanged if no sphere is found.
+    /// \return Statistics and inliers of the fit.
+    public: Result FitSphere(const Vector3SoAd &_points, Vector3d &_center,
+                             double &_radius) const;
+
+    /// \brief Fit a cylinder of infinite length to points with normals.
+    /// Each hypothesis goes through two points, with the axis
+    /// perpendicular to both of their normals.
+    /// \param[in] _points The points.
+    /// \param[in] _normals Unit normal of each point.
+    /// \param[out] _axisPoint Point of the axis closest to the origin.
+    /// \param[out] _axisDirection Unit direction of the axis.
+    /// \param[out] _radius Radius of the cylinder. The axis and radius are
+    /// unchanged if no cylinder is found.
+    /// \return Statistics and inliers of the fit. Nothing is found if
+    /// there is not one normal per point.
+    public: Result FitCylinder(const Vector3SoAd &_points,
+                               const Vector3SoAd &_normals,
+                               Vector3d &_axisPoint,
+                               Vector3d &_axisDirection,
+                               double &_radius) const;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<RansacFitterPrivate> dataPtr;
+  };
+}
+}
+}
+#endif
@@ -17,13 +17,18 @@
 #ifndef GZ_MATH_REGION3_HH_
 #define GZ_MATH_REGION3_HH_
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <ostream>
 #include <utility>
+#include <vector>
 
 #include <gz/math/Interval.hh>
 #include <gz/math/Vector3.hh>
+#include <gz/math/Vector3SoA.hh>
 #include <gz/math/config.hh>
 
 namespace ignition
@@ -133,6 +138,51 @@ namespace ignition
                 this->iz.Contains(_point.Z()));
       }
 
+      /// \brief Check which of many points the region contains. Each
+      /// result is the same as Contains(const Vector3<T> &) of the point,
+      /// but the open or closed bounds are resolved once with
+      /// Interval::ClosedBounds(), so the loop has no branches.
+      /// \param[in] _points Array of _count points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _contained Membership bitmask. Bit (i % 64) of element
+      /// (i / 64) is set when point i is contained. It is resized to hold
+      /// one bit per point, and unused bits are zero.
+      /// \return Number of points contained.
+      public: std::size_t Contains(const Vector3<T> *_points,
+                                   const std::size_t _count,
+                                   std::vector<uint64_t> &_contained) const
+      {
+        return this->ContainsBatch(_count, _contained,
+            [_points](const std::size_t _i, T &_x, T &_y, T &_z)
+            {
+              _x = _points[_i].X();
+              _y = _points[_i].Y();
+              _z = _points[_i].Z();
+            });
+      }
+
+      /// \brief Check which of many points, stored as a
+      /// structure-of-arrays, the region contains. This layout lets the
+      /// compiler vectorize the comparisons.
+      /// \param[in] _points Points to check.
+      /// \param[out] _contained Membership bitmask, see Contains(const
+      /// Vector3<T> *, std::size_t, std::vector<uint64_t> &).
+      /// \return Number of points contained.
+      public: std::size_t Contains(const Vector3SoA<T> &_points,
+                                   std::vector<uint64_t> &_contained) const
+      {
+        const T *x = _points.XData();
+        const T *y = _points.YData();
+        const T *z = _points.ZData();
+        return this->ContainsBatch(_points.Size(), _contained,
+            [x, y, z](const std::size_t _i, T &_x, T &_y, T &_z)
+            {
+              _x = x[_i];
+              _y = y[_i];
+              _z = z[_i];
+            });
+      }
+
       /// \brief Check if the region contains `_other` region
       /// \param[in] _other region to check for membership
       /// \return true if it is contained, false otherwise
@@ -153,6 +203,17 @@ namespace ignition
                 this->iz.Intersects(_other.iz));
       }
 
+      /// \brief Compute the intersection with `_other` region
+      /// \param[in] _other region to intersect with
+      /// \return the intersection of both regions, which
+      ///   is empty if they do not intersect
+      public: Region3<T> Intersection(const Region3<T> &_other) const
+      {
+        return Region3<T>(this->ix.Intersection(_other.ix),
+                          this->iy.Intersection(_other.iy),
+                          this->iz.Intersection(_other.iz));
+      }
+
       /// \brief Equality test operator
       /// \param _other region to check for equality
       /// \return true if regions are equal, false otherwise
@@ -179,6 +240,43 @@ namespace ignition
         return _out <<_r.ix << " x " << _r.iy << " x " << _r.iz;
       }
 
+      /// \brief Check which of many points the region contains.
+      /// \param[in] _count Number of points.
+      /// \param[out] _contained Membership bitmask.
+      /// \param[in] _point Function taking the index of a point and
+      ///   writing its coordinates.
+      /// \return Number of points contained.
+      private: template<typename PointFunction>
+               std::size_t ContainsBatch(const std::size_t _count,
+                                         std::vector<uint64_t> &_contained,
+                                         const PointFunction &_point) const
+      {
+        T lo[3], hi[3];
+        this->ix.ClosedBounds(lo[0], hi[0]);
+        this->iy.ClosedBounds(lo[1], hi[1]);
+        this->iz.ClosedBounds(lo[2], hi[2]);
+        _contained.assign((_count + 63) / 64, 0);
+        std::size_t inside = 0;
+        for (std::size_t block = 0; block < _contained.size(); ++block)
+        {
+          const std::size_t begin = block * 64;
+          const std::size_t size = std::min<std::size_t>(64, _count - begin);
+          uint64_t bits = 0;
+          for (std::size_t i = 0; i < size; ++i)
+          {
+            T x, y, z;
+            _point(begin + i, x, y, z);
+            const bool in = (lo[0] <= x) & (x <= hi[0]) &
+                            (lo[1] <= y) & (y <= hi[1]) &
+                            (lo[2] <= z) & (z <= hi[2]);
+            bits |= static_cast<uint64_t>(in) << i;
+            inside += in;
+          }
+          _contained[block] = bits;
+        }
+        return inside;
+      }
+
       /// \brief The x-axis interval
       private: Interval<T> ix;
       /// \brief The y-axis interval
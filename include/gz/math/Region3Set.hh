@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_REGION3SET_HH_
+#define GZ_MATH_REGION3SET_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Region3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+#include <gz/math/detail/RegionGridIndex.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Region3Set Region3Set.hh ignition/math/Region3Set.hh
+    /// \brief The Region3Set class represents a union of regions of R^3
+    /// space, such as no-go zones, which may overlap.
+    ///
+    /// Sets with many regions build the same uniform grid index as
+    /// PiecewiseScalarField3, where each cell lists the regions which
+    /// overlap it. Membership tests then only check the regions of one
+    /// cell instead of every region.
+    template <typename T>
+    class Region3Set
+    {
+      /// \brief Index returned when no region contains a point.
+      public: static constexpr std::size_t kNoRegion =
+          std::numeric_limits<std::size_t>::max();
+
+      /// \brief Constructor, for an empty set.
+      public: Region3Set() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _regions Regions of the set, which may overlap.
+      public: explicit Region3Set(std::vector<Region3<T>> _regions)
+      : regions(std::move(_regions))
+      {
+        if (this->regions.size() >= kMinRegionsForIndex)
+        {
+          this->gridIndex.Build(this->regions.size(),
+              [this](std::size_t _i) -> const Region3<T> &
+              {
+                return this->regions[_i];
+              });
+        }
+      }
+
+      /// \brief Get the regions of the set.
+      /// \return The regions, in the order they were given.
+      public: const std::vector<Region3<T>> &Regions() const
+      {
+        return this->regions;
+      }
+
+      /// \brief Check if the set is empty.
+      /// \return True if every region is empty.
+      public: bool Empty() const
+      {
+        for (const Region3<T> &region : this->regions)
+        {
+          if (!region.Empty())
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Check if the set contains `_point`.
+      /// \param[in] _point Point to check for membership.
+      /// \return True if it is contained, false otherwise.
+      public: bool Contains(const Vector3<T> &_point) const
+      {
+        return this->RegionIndex(_point) != kNoRegion;
+      }
+
+      /// \brief Get the first region of the set which contains `_point`.
+      /// \param[in] _point Point to look up.
+      /// \return Index of the region in Regions(), or kNoRegion if no
+      ///   region contains the point.
+      public: std::size_t RegionIndex(const Vector3<T> &_point) const
+      {
+        if (!this->gridIndex.Built())
+        {
+          for (std::size_t i = 0; i < this->regions.size(); ++i)
+          {
+            if (this->regions[i].Contains(_point))
+              return i;
+          }
+          return kNoRegion;
+        }
+
+        // No region contains a NaN coordinate, which has no cell either
+        if (std::isnan(_point.X()) || std::isnan(_point.Y()) ||
+            std::isnan(_point.Z()))
+        {
+          return kNoRegion;
+        }
+
+        const std::size_t cell = this->gridIndex.Cell(_point);
+        for (const std::size_t *c = this->gridIndex.CellBegin(cell);
+             c != this->gridIndex.CellEnd(cell); ++c)
+        {
+          if (this->regions[*c].Contains(_point))
+            return *c;
+        }
+        return kNoRegion;
+      }
+
+      /// \brief Check if the set intersects `_region`.
+      /// \param[in] _region Region to check for intersection.
+      /// \return True if any region of the set intersects it.
+      public: bool Intersects(const Region3<T> &_region) const
+      {
+        if (_region.Empty())
+          return false;
+        if (!this->gridIndex.Built())
+        {
+          for (const Region3<T> &region : this->regions)
+          {
+            if (region.Intersects(_region))
+              return true;
+          }
+          return false;
+        }
+
+        bool intersects = false;
+        this->gridIndex.ForEachCell(_region, [&](std::size_t _cell)
+        {
+          for (const std::size_t *c = this->gridIndex.CellBegin(_cell);
+               !intersects && c != this->gridIndex.CellEnd(_cell); ++c)
+          {
+            intersects = this->regions[*c].Intersects(_region);
+          }
+        });
+        return intersects;
+      }
+
+      /// \brief Stream insertion operator
+      /// \param _out output stream
+      /// \param _set Region3Set to output
+      /// \return the stream
+      public: friend std::ostream &operator<<(
+        std::ostream &_out, const gz::math::Region3Set<T> &_set)
+      {
+        if (_set.regions.empty())
+          return _out << "{}";
+        for (std::size_t i = 0; i < _set.regions.size(); ++i)
+          _out << (i > 0 ? " U " : "") << "(" << _set.regions[i] << ")";
+        return _out;
+      }
+
+      /// \brief Minimum number of regions for which a grid index is built
+      private: static constexpr std::size_t kMinRegionsForIndex = 16;
+
+      /// \brief Regions of the set.
+      private: std::vector<Region3<T>> regions;
+
+      /// \brief Grid index of the regions. Not built for sets with few
+      /// regions.
+      private: detail::RegionGridIndex<T> gridIndex;
+    };
+
+    using Region3Setf = Region3Set<float>;
+    using Region3Setd = Region3Set<double>;
+    }
+  }
+}
+
+#endif
@@ -17,8 +17,13 @@
 #ifndef GZ_MATH_ROLLINGMEAN_HH_
 #define GZ_MATH_ROLLINGMEAN_HH_
 
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
 #include <memory>
 #include <gz/math/Export.hh>
+#include <gz/math/MovingWindowFilter.hh>
 #include <gz/math/config.hh>
 
 namespace ignition
@@ -35,6 +40,10 @@ namespace ignition
     /// The window size determines the maximum number of data points. The
     /// oldest value is popped off when the window size is reached and
     /// a new value is pushed in.
+    ///
+    /// The values are kept in a ring buffer allocated by the constructor
+    /// and SetWindowSize, so Push, Mean, Count and Clear are real-time
+    /// safe.
     class IGNITION_MATH_VISIBLE RollingMean
     {
       /// \brief Constructor
@@ -83,6 +92,105 @@ namespace ignition
 #pragma warning(pop)
 #endif
     };
+
+    /// \brief Rolling mean with a window size fixed at compile time. The
+    /// values are stored inline, so the object never allocates, and a
+    /// running sum makes Push() and Mean() take constant time. The sum is
+    /// compensated, as in FixedMovingWindowFilter, so it does not drift
+    /// over long runs. An infinite or NaN value poisons the running sum,
+    /// so the window is summed again while the sum is not finite, and the
+    /// mean recovers once that value has been dropped, as in RollingMean.
+    /// \tparam N The window size.
+    template<std::size_t N>
+    class FixedRollingMean
+    {
+      static_assert(N > 0, "The window size must be positive");
+
+      /// \brief Get the mean value.
+      /// \return The current mean value, or
+      /// std::numeric_limits<double>::quiet_NaN() if data points are not
+      /// present.
+      public: double Mean() const
+      {
+        if (this->count == 0)
+          return std::numeric_limits<double>::quiet_NaN();
+        return (this->sum - this->compensation) /
+          static_cast<double>(this->count);
+      }
+
+      /// \brief Get the number of data points.
+      /// \return The number of datapoints.
+      public: std::size_t Count() const
+      {
+        return this->count;
+      }
+
+      /// \brief Insert a new value. The oldest value is dropped when the
+      /// window is full.
+      /// \param[in] _value New value to insert.
+      public: void Push(const double _value)
+      {
+        if (this->count == N)
+        {
+          detail::CompensatedSubtract(
+              this->sum, this->compensation, this->values[this->index]);
+        }
+        else
+        {
+          ++this->count;
+        }
+        detail::CompensatedAdd(this->sum, this->compensation, _value);
+        this->values[this->index] = _value;
+        this->index = this->index + 1 == N ? 0 : this->index + 1;
+
+        if (!std::isfinite(this->sum) || !std::isfinite(this->compensation))
+          this->Resum();
+      }
+
+      /// \brief Remove all the pushed values.
+      public: void Clear()
+      {
+        this->index = 0;
+        this->count = 0;
+        this->sum = 0.0;
+        this->compensation = 0.0;
+      }
+
+      /// \brief Get the window size.
+      /// \return The window size.
+      public: static constexpr std::size_t WindowSize()
+      {
+        return N;
+      }
+
+      /// \brief Recompute the running sum from the stored values.
+      private: void Resum()
+      {
+        this->sum = 0.0;
+        this->compensation = 0.0;
+        // Until the window is full the values start at index 0.
+        for (std::size_t i = 0; i < this->count; ++i)
+        {
+          detail::CompensatedAdd(
+              this->sum, this->compensation, this->values[i]);
+        }
+      }
+
+      /// \brief The values, a ring buffer.
+      private: std::array<double, N> values{};
+
+      /// \brief Index of the oldest value, where the next one is stored.
+      private: std::size_t index = 0;
+
+      /// \brief Number of values.
+      private: std::size_t count = 0;
+
+      /// \brief Running sum of the values.
+      private: double sum = 0.0;
+
+      /// \brief Rounding error of the running sum.
+      private: double compensation = 0.0;
+    };
     }
   }
 }
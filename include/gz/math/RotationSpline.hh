@@ -17,6 +17,9 @@
 #ifndef GZ_MATH_ROTATIONSPLINE_HH_
 #define GZ_MATH_ROTATIONSPLINE_HH_
 
+#include <cstddef>
+#include <memory_resource>
+
 #include <gz/math/Quaternion.hh>
 #include <gz/math/config.hh>
 
@@ -32,14 +35,46 @@ namespace ignition
 
     /// \class RotationSpline RotationSpline.hh ignition/math/RotationSpline.hh
     /// \brief Spline for rotations
+    ///
+    /// Copies of a rotation spline share its points, tangents and segments
+    /// until one of them changes, so copies are cheap.
     class IGNITION_MATH_VISIBLE  RotationSpline
     {
       /// \brief Constructor. Sets the autoCalc to true
       public: RotationSpline();
 
+      /// \brief Constructor. Sets the autoCalc to true. The control points,
+      /// tangents and segments are allocated from a memory resource, such
+      /// as a std::pmr::monotonic_buffer_resource.
+      /// \param[in] _resource Memory resource, which must outlive the
+      /// spline.
+      public: explicit RotationSpline(std::pmr::memory_resource *_resource);
+
+      /// \brief Copy constructor. The data is shared with _other until
+      /// either spline changes.
+      /// \param[in] _other Spline to copy.
+      public: RotationSpline(const RotationSpline &_other);
+
+      /// \brief Move constructor. The moved from spline can only be
+      /// assigned to or destroyed.
+      /// \param[in] _other Spline to move.
+      public: RotationSpline(RotationSpline &&_other) noexcept;
+
       /// \brief Destructor. Nothing is done
       public: ~RotationSpline();
 
+      /// \brief Copy assignment operator. The data is shared with _other
+      /// until either spline changes.
+      /// \param[in] _other Spline to copy.
+      /// \return Reference to this spline.
+      public: RotationSpline &operator=(const RotationSpline &_other);
+
+      /// \brief Move assignment operator, which swaps the data of the
+      /// splines.
+      /// \param[in] _other Spline to move.
+      /// \return Reference to this spline.
+      public: RotationSpline &operator=(RotationSpline &&_other) noexcept;
+
       /// \brief Adds a control point to the end of the spline.
       /// \param[in] _p control point
       public: void AddPoint(const Quaterniond &_p);
@@ -82,6 +117,17 @@ namespace ignition
       public: Quaterniond Interpolate(double _t,
                                       const bool _useShortestPath = true);
 
+      /// \brief Returns an interpolated point based on a parametric
+      ///        value over the whole series, as the non const version.
+      /// \param[in] _t Parametric value.
+      /// \param[in] _useShortestPath Defines if rotation should take the
+      ///        shortest possible path
+      /// \return The rotation, or [INF, INF, INF, INF] on error.
+      /// \sa Finalize()
+      public: Quaterniond Interpolate(double _t,
+                                      const bool _useShortestPath = true)
+                                      const;
+
       /// \brief Interpolates a single segment of the spline
       ///        given a parametric value.
       /// \param[in] _fromIndex The point index to treat as t = 0.
@@ -94,6 +140,47 @@ namespace ignition
       public: Quaterniond Interpolate(const unsigned int _fromIndex,
                   const double _t, const bool _useShortestPath = true);
 
+      /// \brief Interpolates a single segment of the spline given a
+      ///        parametric value, as the non const version.
+      /// \param[in] _fromIndex The point index to treat as t = 0.
+      /// \param[in] _t Parametric value
+      /// \param[in] _useShortestPath Defines if rotation should take the
+      ///         shortest possible path
+      /// \return the rotation, or [INF, INF, INF, INF] on error.
+      public: Quaterniond Interpolate(const unsigned int _fromIndex,
+                  const double _t, const bool _useShortestPath = true) const;
+
+      /// \brief Returns interpolated points for many parametric values
+      ///        over the whole series at once.
+      /// \remarks Each rotation is the same as the one returned by
+      ///          Interpolate(double, const bool) for the same value. The
+      ///          slerp terms of each segment that do not depend on the
+      ///          parametric value are computed once when the tangents are
+      ///          recalculated, and reused by every value.
+      /// \param[in] _t Array of _count parametric values.
+      /// \param[in] _count Number of parametric values.
+      /// \param[out] _rotations Array of at least _count rotations, written
+      ///        with the interpolated rotations, or [INF, INF, INF, INF] for
+      ///        the values that are out of range. No memory is allocated.
+      /// \param[in] _useShortestPath Defines if rotation should take the
+      ///        shortest possible path
+      /// \return False if the spline has no points, in which case every
+      /// rotation is [INF, INF, INF, INF].
+      public: bool Interpolate(const double *_t, const size_t _count,
+                  Quaterniond *_rotations, const bool _useShortestPath = true);
+
+      /// \brief Returns interpolated points for many parametric values
+      ///        over the whole series at once, as the non const version.
+      /// \param[in] _t Array of _count parametric values.
+      /// \param[in] _count Number of parametric values.
+      /// \param[out] _rotations Array of at least _count rotations.
+      /// \param[in] _useShortestPath Defines if rotation should take the
+      ///        shortest possible path
+      /// \return False if the spline has no points.
+      public: bool Interpolate(const double *_t, const size_t _count,
+                  Quaterniond *_rotations,
+                  const bool _useShortestPath = true) const;
+
       /// \brief Tells the spline whether it should automatically calculate
       ///        tangents on demand as points are added.
       /// \remarks The spline calculates tangents at each point automatically
@@ -116,6 +203,22 @@ namespace ignition
       /// completing your updates to the spline points.
       public: void RecalcTangents();
 
+      /// \brief Builds now the segments that interpolation otherwise
+      ///        builds on first use after a change. Recalculating the
+      ///        tangents builds them too, so only points changed while
+      ///        automatic calculation is disabled leave them to build.
+      /// \remarks Call this once the spline is set up, to keep the build
+      ///          cost out of the first interpolation. Until the next
+      ///          change, the const Interpolate functions only read the
+      ///          spline, so any number of threads can share it, or copies
+      ///          of it, without locking.
+      public: void Finalize();
+
+      /// \brief Gets whether the segments are built, because Finalize or
+      ///        an interpolation built them since the last change.
+      /// \return True if interpolation builds nothing.
+      public: bool Finalized() const;
+
       /// \brief Private data pointer
       private: RotationSplinePrivate *dataPtr;
     };
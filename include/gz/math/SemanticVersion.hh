@@ -18,8 +18,11 @@
 #ifndef GZ_MATH_SEMANTICVERSION_HH_
 #define GZ_MATH_SEMANTICVERSION_HH_
 
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <gz/math/Helpers.hh>
 #include <gz/math/config.hh>
 
@@ -73,11 +76,162 @@ namespace ignition
       public: ~SemanticVersion();
 
       /// \brief Parse a version string and set the major, minor, patch
-      /// numbers, and prerelease and build strings.
+      /// numbers, and prerelease and build strings. See Split for the
+      /// accepted strings.
       /// \param[in] _versionStr The version string, such as "1.2.3-pr+123"
-      /// \return True on success.
+      /// \return True on success. On failure the version is unchanged.
       public: bool Parse(const std::string &_versionStr);
 
+      /// \brief Split a version string, such as "1.2.3-pr+123", into its
+      /// fields without allocating. Missing minor and patch numbers are
+      /// zero. Whitespace around the string is ignored, as are characters
+      /// after the digits of the last number, such as "beta" in
+      /// "1.2.3beta", which Parse has always accepted. This is constexpr,
+      /// so versions known at compile time can be checked and converted to
+      /// keys by the compiler.
+      /// \param[in] _versionStr The version string.
+      /// \param[out] _major The major number.
+      /// \param[out] _minor The minor number.
+      /// \param[out] _patch The patch number.
+      /// \param[out] _prerelease The prerelease string, a view of
+      /// _versionStr which is empty if there is none.
+      /// \param[out] _build The build metadata string, a view of
+      /// _versionStr which is empty if there is none.
+      /// \return True on success, false if the string is blank, has more
+      /// than three numbers, a number which doesn't start with a digit or
+      /// doesn't fit in an unsigned int, other characters than digits in
+      /// a number before the last one, or build metadata before a
+      /// prerelease string.
+      /// The outputs are only set on success.
+      public: static constexpr bool Split(std::string_view _versionStr,
+                                          unsigned int &_major,
+                                          unsigned int &_minor,
+                                          unsigned int &_patch,
+                                          std::string_view &_prerelease,
+                                          std::string_view &_build)
+      {
+        constexpr std::string_view kWhitespace = " \t\n\v\f\r";
+        const std::size_t first = _versionStr.find_first_not_of(kWhitespace);
+        if (first == std::string_view::npos)
+          return false;
+        _versionStr = _versionStr.substr(first,
+            _versionStr.find_last_not_of(kWhitespace) - first + 1);
+
+        const std::size_t prereleaseStart = _versionStr.find('-');
+        const std::size_t buildStart = _versionStr.find('+');
+
+        // Build meta data, if present, must be after prerelease string, if
+        // present
+        if (buildStart != std::string_view::npos &&
+            prereleaseStart != std::string_view::npos &&
+            buildStart < prereleaseStart)
+        {
+          return false;
+        }
+
+        const std::size_t numericEnd =
+            prereleaseStart != std::string_view::npos ? prereleaseStart :
+            (buildStart != std::string_view::npos ? buildStart :
+             _versionStr.size());
+
+        unsigned int numbers[3] = {0, 0, 0};
+        std::size_t count = 0;
+        std::size_t start = 0;
+        while (start <= numericEnd)
+        {
+          std::size_t end = _versionStr.find('.', start);
+          if (end == std::string_view::npos || end > numericEnd)
+            end = numericEnd;
+          if (count == 3 || end == start)
+            return false;
+
+          std::uint64_t value = 0;
+          for (std::size_t i = start; i < end; ++i)
+          {
+            const char c = _versionStr[i];
+            if (c < '0' || c > '9')
+            {
+              // Only the last number may have a suffix
+              if (i == start || end != numericEnd)
+                return false;
+              break;
+            }
+            value = value * 10 + static_cast<std::uint64_t>(c - '0');
+            if (value > std::numeric_limits<unsigned int>::max())
+              return false;
+          }
+          numbers[count++] = static_cast<unsigned int>(value);
+          start = end + 1;
+        }
+
+        _major = numbers[0];
+        _minor = numbers[1];
+        _patch = numbers[2];
+        _prerelease = std::string_view();
+        _build = std::string_view();
+        if (prereleaseStart != std::string_view::npos)
+        {
+          _prerelease = _versionStr.substr(prereleaseStart + 1,
+              buildStart != std::string_view::npos ?
+              buildStart - prereleaseStart - 1 : std::string_view::npos);
+        }
+        if (buildStart != std::string_view::npos)
+          _build = _versionStr.substr(buildStart + 1);
+        return true;
+      }
+
+      /// \brief Get the packed ordering key of a version. The major, minor
+      /// and patch numbers take 21 bits each, above one bit which is set
+      /// for versions without a prerelease string, so that comparing keys
+      /// orders versions as operator< does. Numbers above kMaxKeyNumber
+      /// saturate, and versions which differ only there get equal keys.
+      /// \param[in] _major The major number.
+      /// \param[in] _minor The minor number.
+      /// \param[in] _patch The patch number.
+      /// \param[in] _prerelease True if the version has a prerelease
+      /// string.
+      /// \return The key.
+      public: static constexpr std::uint64_t MakeKey(
+                  const unsigned int _major, const unsigned int _minor,
+                  const unsigned int _patch, const bool _prerelease)
+      {
+        const auto field = [](const unsigned int _n)
+        {
+          return static_cast<std::uint64_t>(
+              _n < kMaxKeyNumber ? _n : kMaxKeyNumber);
+        };
+        return (field(_major) << 43) | (field(_minor) << 22) |
+               (field(_patch) << 1) | (_prerelease ? 0u : 1u);
+      }
+
+      /// \brief Parse a version string directly into its ordering key,
+      /// without allocating. See Split and MakeKey.
+      /// \param[in] _versionStr The version string.
+      /// \param[out] _key The key, only set on success.
+      /// \return True on success.
+      public: static constexpr bool ParseKey(
+                  const std::string_view _versionStr, std::uint64_t &_key)
+      {
+        unsigned int maj = 0;
+        unsigned int min = 0;
+        unsigned int pat = 0;
+        std::string_view prerelease;
+        std::string_view build;
+        if (!Split(_versionStr, maj, min, pat, prerelease, build))
+          return false;
+        _key = MakeKey(maj, min, pat, !prerelease.empty());
+        return true;
+      }
+
+      /// \brief Get the packed ordering key of this version, computed when
+      /// the version is set. See MakeKey.
+      /// \return The key.
+      public: std::uint64_t Key() const;
+
+      /// \brief Largest major, minor or patch number represented exactly
+      /// in an ordering key.
+      public: static constexpr unsigned int kMaxKeyNumber = (1u << 21) - 1;
+
       /// \brief Returns the version as a string
       /// \return The semantic version string
       public: std::string Version() const;
@@ -0,0 +1,1123 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SHAPEDISTANCE_HH_
+#define GZ_MATH_SHAPEDISTANCE_HH_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include <gz/math/config.hh>
+#include <gz/math/Box.hh>
+#include <gz/math/Capsule.hh>
+#include <gz/math/Cylinder.hh>
+#include <gz/math/Ellipsoid.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Sphere.hh>
+#include <gz/math/Vector3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      template<typename T> class Gjk;
+    }
+
+    /// \brief Result of ShapeDistance and ShapePenetration.
+    template<typename T>
+    struct ShapeDistanceResult
+    {
+      /// \brief Signed distance between the shapes: the length of the gap
+      /// between them when they are separated, or minus the penetration
+      /// depth when they overlap.
+      T distance = 0;
+
+      /// \brief Point of the first shape closest to the second shape, or
+      /// deepest inside it, in the world frame.
+      Vector3<T> pointA;
+
+      /// \brief Point of the second shape closest to the first shape, or
+      /// deepest inside it, in the world frame.
+      Vector3<T> pointB;
+
+      /// \brief Unit contact normal, pointing from the first shape to the
+      /// second one. Translating the second shape by -distance times the
+      /// normal makes the shapes touch.
+      Vector3<T> normal;
+
+      /// \brief Number of GJK iterations of the query.
+      unsigned int iterations = 0;
+    };
+
+    /// \class ShapeDistanceCache ShapeDistance.hh
+    /// ignition/math/ShapeDistance.hh
+    /// \brief Simplex of a GJK query kept between frames.
+    ///
+    /// The simplex is stored as support points in the frames of the two
+    /// shapes, which stay valid while the shapes move. Passing the cache of
+    /// the previous frame to ShapeDistance or ShapePenetration starts the
+    /// search from the previous solution, which usually converges in one or
+    /// two iterations for coherent motion. A cache belongs to one ordered
+    /// pair of shapes and must be reset if their dimensions change.
+    template<typename T>
+    class ShapeDistanceCache
+    {
+      /// \brief Forget the cached simplex.
+      public: void Reset()
+      {
+        this->count = 0;
+      }
+
+      /// \brief Get the number of cached simplex vertices.
+      /// \return A number between 0 and 4.
+      public: unsigned int Size() const
+      {
+        return this->count;
+      }
+
+      /// \brief The queries read and write the simplex.
+      template<typename> friend class detail::Gjk;
+
+      /// \brief Support points of the first shape, in its frame.
+      private: std::array<Vector3<T>, 4> pointsA;
+
+      /// \brief Support points of the second shape, in its frame.
+      private: std::array<Vector3<T>, 4> pointsB;
+
+      /// \brief Number of cached vertices.
+      private: unsigned int count = 0;
+    };
+
+    namespace detail
+    {
+      /// \brief Sign of a support direction component, with 0 mapped to 1.
+      /// \param[in] _value Direction component.
+      /// \return -1 or 1.
+      template<typename T>
+      T SupportSign(const T _value)
+      {
+        return _value < 0 ? T(-1) : T(1);
+      }
+
+      /// \brief Farthest point of a box in a direction.
+      /// \param[in] _box Box, centered at the origin.
+      /// \param[in] _dir Direction.
+      /// \return Support point.
+      template<typename T>
+      Vector3<T> CoreSupport(const Box<T> &_box, const Vector3<T> &_dir)
+      {
+        const Vector3<T> half = _box.Size() * T(0.5);
+        return Vector3<T>(SupportSign(_dir.X()) * half.X(),
+                          SupportSign(_dir.Y()) * half.Y(),
+                          SupportSign(_dir.Z()) * half.Z());
+      }
+
+      /// \brief Radius added around the support points of a box.
+      /// \return 0.
+      template<typename T>
+      T SupportMargin(const Box<T> &)
+      {
+        return 0;
+      }
+
+      /// \brief Center of a sphere, which is inflated by its radius.
+      /// \return The origin.
+      template<typename T>
+      Vector3<T> CoreSupport(const Sphere<T> &, const Vector3<T> &)
+      {
+        return Vector3<T>::Zero;
+      }
+
+      /// \brief Radius added around the center of a sphere.
+      /// \param[in] _sphere Sphere.
+      /// \return The radius of the sphere.
+      template<typename T>
+      T SupportMargin(const Sphere<T> &_sphere)
+      {
+        return _sphere.Radius();
+      }
+
+      /// \brief Farthest point of the axis of a capsule in a direction. The
+      /// capsule is the axis inflated by its radius.
+      /// \param[in] _capsule Capsule, along Z and centered at the origin.
+      /// \param[in] _dir Direction.
+      /// \return Support point.
+      template<typename T>
+      Vector3<T> CoreSupport(const Capsule<T> &_capsule,
+                             const Vector3<T> &_dir)
+      {
+        return Vector3<T>(0, 0,
+            SupportSign(_dir.Z()) * _capsule.Length() * T(0.5));
+      }
+
+      /// \brief Radius added around the axis of a capsule.
+      /// \param[in] _capsule Capsule.
+      /// \return The radius of the capsule.
+      template<typename T>
+      T SupportMargin(const Capsule<T> &_capsule)
+      {
+        return _capsule.Radius();
+      }
+
+      /// \brief Farthest point of a cylinder in a direction.
+      /// \param[in] _cylinder Cylinder, centered at the origin along Z
+      /// rotated by its rotational offset.
+      /// \param[in] _dir Direction.
+      /// \return Support point.
+      template<typename T>
+      Vector3<T> CoreSupport(const Cylinder<T> &_cylinder,
+                             const Vector3<T> &_dir)
+      {
+        const Quaternion<T> offset = _cylinder.RotationalOffset();
+        const Vector3<T> dir = offset.RotateVectorReverse(_dir);
+        const T radial = std::sqrt(dir.X() * dir.X() + dir.Y() * dir.Y());
+        const T z = SupportSign(dir.Z()) * _cylinder.Length() * T(0.5);
+        if (radial <= 0)
+          return offset.RotateVector(Vector3<T>(0, 0, z));
+        const T scale = _cylinder.Radius() / radial;
+        return offset.RotateVector(
+            Vector3<T>(dir.X() * scale, dir.Y() * scale, z));
+      }
+
+      /// \brief Radius added around the support points of a cylinder.
+      /// \return 0.
+      template<typename T>
+      T SupportMargin(const Cylinder<T> &)
+      {
+        return 0;
+      }
+
+      /// \brief Farthest point of an ellipsoid in a direction.
+      /// \param[in] _ellipsoid Ellipsoid, centered at the origin.
+      /// \param[in] _dir Direction.
+      /// \return Support point.
+      template<typename T>
+      Vector3<T> CoreSupport(const Ellipsoid<T> &_ellipsoid,
+                             const Vector3<T> &_dir)
+      {
+        const Vector3<T> radii = _ellipsoid.Radii();
+        const Vector3<T> scaled = radii * radii * _dir;
+        const T length = std::sqrt(scaled.Dot(_dir));
+        if (length <= 0)
+          return Vector3<T>::Zero;
+        return scaled / length;
+      }
+
+      /// \brief Radius added around the support points of an ellipsoid.
+      /// \return 0.
+      template<typename T>
+      T SupportMargin(const Ellipsoid<T> &)
+      {
+        return 0;
+      }
+
+      /// \brief A shape placed in the world by a pose. Rounded shapes are
+      /// split into a core, a point for spheres and a segment for capsules,
+      /// inflated by a margin. The queries run on the cores and add the
+      /// margins afterwards, which is exact and avoids iterating over the
+      /// curved surfaces.
+      template<typename T, typename Shape>
+      class PlacedShape
+      {
+        /// \brief Constructor.
+        /// \param[in] _shape Shape.
+        /// \param[in] _pose Pose of the shape in the world frame.
+        public: PlacedShape(const Shape &_shape, const Pose3<T> &_pose)
+          : shape(_shape), pose(_pose), margin(SupportMargin(_shape))
+        {
+        }
+
+        /// \brief Farthest point of the core of the shape in a direction.
+        /// \param[in] _dir Direction, in the world frame.
+        /// \return Support point, in the frame of the shape.
+        public: Vector3<T> LocalSupport(const Vector3<T> &_dir) const
+        {
+          return CoreSupport(this->shape,
+                             this->pose.Rot().RotateVectorReverse(_dir));
+        }
+
+        /// \brief Express a point of the shape in the world frame.
+        /// \param[in] _point Point in the frame of the shape.
+        /// \return Point in the world frame.
+        public: Vector3<T> ToWorld(const Vector3<T> &_point) const
+        {
+          return this->pose.Pos() + this->pose.Rot().RotateVector(_point);
+        }
+
+        /// \brief Shape.
+        public: const Shape &shape;
+
+        /// \brief Pose of the shape in the world frame.
+        public: const Pose3<T> &pose;
+
+        /// \brief Radius around the core of the shape.
+        public: const T margin;
+      };
+
+      /// \brief Vertex of the Minkowski difference of two shapes.
+      template<typename T>
+      struct SupportVertex
+      {
+        /// \brief Point of the difference, a - b.
+        Vector3<T> w;
+
+        /// \brief Support point of the first shape, in the world frame.
+        Vector3<T> a;
+
+        /// \brief Support point of the second shape, in the world frame.
+        Vector3<T> b;
+
+        /// \brief Support point of the first shape, in its frame.
+        Vector3<T> localA;
+
+        /// \brief Support point of the second shape, in its frame.
+        Vector3<T> localB;
+      };
+
+      /// \brief GJK distance and EPA penetration depth between two convex
+      /// shapes given by their support functions. Nothing is allocated.
+      template<typename T>
+      class Gjk
+      {
+        /// \brief Vertex type.
+        public: using Vertex = SupportVertex<T>;
+
+        /// \brief Simplex of up to 4 vertices.
+        public: using Simplex = std::array<Vertex, 4>;
+
+        /// \brief Maximum number of GJK iterations.
+        public: static constexpr unsigned int kMaxIterations = 128;
+
+        /// \brief Maximum number of vertices of the EPA polytope.
+        public: static constexpr unsigned int kMaxEpaVertices = 64;
+
+        /// \brief Maximum number of faces of the EPA polytope.
+        public: static constexpr unsigned int kMaxEpaFaces =
+            2 * kMaxEpaVertices;
+
+        /// \brief Relative convergence tolerance.
+        /// \return Tolerance.
+        public: static T RelativeTolerance()
+        {
+          return std::sqrt(std::numeric_limits<T>::epsilon());
+        }
+
+        /// \brief Distance under which shapes are touching.
+        /// \return Tolerance.
+        public: static T AbsoluteTolerance()
+        {
+          return 100 * std::numeric_limits<T>::epsilon();
+        }
+
+        /// \brief Run a distance query, and an EPA query if the shapes
+        /// overlap and _penetration is true.
+        /// \param[in] _a First shape.
+        /// \param[in] _b Second shape.
+        /// \param[in] _penetration Whether to compute penetration depths.
+        /// \param[out] _result Result of the query.
+        /// \param[in, out] _cache Cached simplex, or nullptr.
+        /// \return True if the shapes are separated.
+        public: template<typename A, typename B>
+        static bool Query(const PlacedShape<T, A> &_a,
+                          const PlacedShape<T, B> &_b,
+                          const bool _penetration,
+                          ShapeDistanceResult<T> &_result,
+                          ShapeDistanceCache<T> *_cache)
+        {
+          Simplex simplex;
+          unsigned int count = 0;
+          if (_cache)
+          {
+            count = _cache->count;
+            for (unsigned int i = 0; i < count; ++i)
+            {
+              Vertex &vertex = simplex[i];
+              vertex.localA = _cache->pointsA[i];
+              vertex.localB = _cache->pointsB[i];
+              vertex.a = _a.ToWorld(vertex.localA);
+              vertex.b = _b.ToWorld(vertex.localB);
+              vertex.w = vertex.a - vertex.b;
+            }
+          }
+
+          // Distance between the cores.
+          std::array<T, 4> weights;
+          Vector3<T> v;
+          const bool separated = Distance(_a, _b, simplex, count, v, weights,
+                                          _result.iterations);
+          if (_cache)
+          {
+            _cache->count = count;
+            for (unsigned int i = 0; i < count; ++i)
+            {
+              _cache->pointsA[i] = simplex[i].localA;
+              _cache->pointsB[i] = simplex[i].localB;
+            }
+          }
+
+          const T margins = _a.margin + _b.margin;
+          if (separated)
+          {
+            const T coreDistance = v.Length();
+            _result.normal = -v / coreDistance;
+            _result.pointA = Vector3<T>::Zero;
+            _result.pointB = Vector3<T>::Zero;
+            for (unsigned int i = 0; i < count; ++i)
+            {
+              _result.pointA += simplex[i].a * weights[i];
+              _result.pointB += simplex[i].b * weights[i];
+            }
+            _result.pointA += _result.normal * _a.margin;
+            _result.pointB -= _result.normal * _b.margin;
+            _result.distance = coreDistance - margins;
+            if (_result.distance > 0)
+              return true;
+
+            // The margins overlap, which gives the exact depth.
+            if (!_penetration)
+              _result.distance = 0;
+            return false;
+          }
+
+          if (!_penetration)
+          {
+            _result.distance = 0;
+            return false;
+          }
+
+          // The cores overlap, and the margins add to their penetration
+          // depth.
+          Epa(_a, _b, simplex, count, weights, _result);
+          _result.distance -= margins;
+          _result.pointA += _result.normal * _a.margin;
+          _result.pointB -= _result.normal * _b.margin;
+          return false;
+        }
+
+        /// \brief GJK distance between the cores of two shapes.
+        /// \param[in] _a First shape.
+        /// \param[in] _b Second shape.
+        /// \param[in, out] _simplex Initial and final simplex.
+        /// \param[in, out] _count Number of vertices of _simplex.
+        /// \param[out] _v Point of the difference closest to the origin.
+        /// \param[out] _weights Weights of the vertices in _v.
+        /// \param[out] _iterations Number of iterations.
+        /// \return True if the shapes are separated.
+        public: template<typename A, typename B>
+        static bool Distance(const PlacedShape<T, A> &_a,
+                             const PlacedShape<T, B> &_b,
+                             Simplex &_simplex, unsigned int &_count,
+                             Vector3<T> &_v, std::array<T, 4> &_weights,
+                             unsigned int &_iterations)
+        {
+          if (_count == 0)
+          {
+            Vector3<T> dir = _b.pose.Pos() - _a.pose.Pos();
+            if (dir.SquaredLength() <= 0)
+              dir = Vector3<T>::UnitX;
+            _simplex[0] = Support(_a, _b, dir);
+            _count = 1;
+          }
+
+          const T relTol = RelativeTolerance();
+          const T absTol2 = AbsoluteTolerance() * AbsoluteTolerance();
+          for (_iterations = 1; ; ++_iterations)
+          {
+            if (!Reduce(_simplex, _count, _v, _weights))
+              return false;
+
+            const T vv = _v.SquaredLength();
+            if (vv <= absTol2)
+              return false;
+
+            if (_iterations >= kMaxIterations)
+              return true;
+
+            const Vertex w = Support(_a, _b, -_v);
+            if (vv - _v.Dot(w.w) <= relTol * vv)
+              return true;
+            for (unsigned int i = 0; i < _count; ++i)
+            {
+              if ((w.w - _simplex[i].w).SquaredLength() <= absTol2)
+                return true;
+            }
+            _simplex[_count++] = w;
+          }
+        }
+
+        /// \brief Get a vertex of the difference of the cores of two
+        /// shapes.
+        /// \param[in] _a First shape.
+        /// \param[in] _b Second shape.
+        /// \param[in] _dir Direction, in the world frame.
+        /// \return Farthest vertex of the difference in _dir.
+        public: template<typename A, typename B>
+        static Vertex Support(const PlacedShape<T, A> &_a,
+                              const PlacedShape<T, B> &_b,
+                              const Vector3<T> &_dir)
+        {
+          Vertex vertex;
+          vertex.localA = _a.LocalSupport(_dir);
+          vertex.localB = _b.LocalSupport(-_dir);
+          vertex.a = _a.ToWorld(vertex.localA);
+          vertex.b = _b.ToWorld(vertex.localB);
+          vertex.w = vertex.a - vertex.b;
+          return vertex;
+        }
+
+        /// \brief Vertices of a simplex that contribute to its point
+        /// closest to the origin, and their weights.
+        private: struct Reduction
+        {
+          /// \brief Number of vertices, or 4 if the origin is inside.
+          unsigned int count = 0;
+
+          /// \brief Indices of the vertices.
+          std::array<unsigned int, 4> index;
+
+          /// \brief Barycentric weights of the vertices.
+          std::array<T, 4> weight;
+        };
+
+        /// \brief Replace a simplex by the smallest sub-simplex containing
+        /// its point closest to the origin.
+        /// \param[in, out] _simplex Simplex.
+        /// \param[in, out] _count Number of vertices of _simplex.
+        /// \param[out] _v Point closest to the origin.
+        /// \param[out] _weights Weights of the remaining vertices.
+        /// \return False if the origin is inside the simplex.
+        private: static bool Reduce(Simplex &_simplex, unsigned int &_count,
+                                    Vector3<T> &_v,
+                                    std::array<T, 4> &_weights)
+        {
+          std::array<Vector3<T>, 4> w;
+          for (unsigned int i = 0; i < _count; ++i)
+            w[i] = _simplex[i].w;
+
+          Reduction r;
+          if (_count == 1)
+          {
+            r.count = 1;
+            r.index[0] = 0;
+            r.weight[0] = 1;
+          }
+          else if (_count == 2)
+            r = Segment(w, 0, 1);
+          else if (_count == 3)
+            r = Triangle(w, 0, 1, 2);
+          else
+            r = Tetrahedron(w);
+
+          if (r.count == 4)
+            return false;
+
+          const Simplex old = _simplex;
+          _v = Vector3<T>::Zero;
+          for (unsigned int i = 0; i < r.count; ++i)
+          {
+            _simplex[i] = old[r.index[i]];
+            _weights[i] = r.weight[i];
+            _v += _simplex[i].w * r.weight[i];
+          }
+          _count = r.count;
+          return true;
+        }
+
+        /// \brief Point of a segment closest to the origin.
+        /// \param[in] _w Points.
+        /// \param[in] _i0 Index of the first end.
+        /// \param[in] _i1 Index of the second end.
+        /// \return Contributing ends and their weights.
+        private: static Reduction Segment(const std::array<Vector3<T>, 4> &_w,
+                                          const unsigned int _i0,
+                                          const unsigned int _i1)
+        {
+          Reduction r;
+          const Vector3<T> edge = _w[_i1] - _w[_i0];
+          const T t = -_w[_i0].Dot(edge);
+          const T length2 = edge.SquaredLength();
+          if (t <= 0 || length2 <= 0)
+          {
+            r.count = 1;
+            r.index[0] = _i0;
+            r.weight[0] = 1;
+          }
+          else if (t >= length2)
+          {
+            r.count = 1;
+            r.index[0] = _i1;
+            r.weight[0] = 1;
+          }
+          else
+          {
+            r.count = 2;
+            r.index[0] = _i0;
+            r.index[1] = _i1;
+            r.weight[1] = t / length2;
+            r.weight[0] = 1 - r.weight[1];
+          }
+          return r;
+        }
+
+        /// \brief Point of a triangle closest to the origin, by testing
+        /// its Voronoi regions.
+        /// \param[in] _w Points.
+        /// \param[in] _i0 Index of the first corner.
+        /// \param[in] _i1 Index of the second corner.
+        /// \param[in] _i2 Index of the third corner.
+        /// \return Contributing corners and their weights.
+        private: static Reduction Triangle(
+                     const std::array<Vector3<T>, 4> &_w,
+                     const unsigned int _i0, const unsigned int _i1,
+                     const unsigned int _i2)
+        {
+          const Vector3<T> &a = _w[_i0];
+          const Vector3<T> &b = _w[_i1];
+          const Vector3<T> &c = _w[_i2];
+          const Vector3<T> ab = b - a;
+          const Vector3<T> ac = c - a;
+
+          Reduction r;
+          const T d1 = -ab.Dot(a);
+          const T d2 = -ac.Dot(a);
+          if (d1 <= 0 && d2 <= 0)
+          {
+            r.count = 1;
+            r.index[0] = _i0;
+            r.weight[0] = 1;
+            return r;
+          }
+
+          const T d3 = -ab.Dot(b);
+          const T d4 = -ac.Dot(b);
+          if (d3 >= 0 && d4 <= d3)
+          {
+            r.count = 1;
+            r.index[0] = _i1;
+            r.weight[0] = 1;
+            return r;
+          }
+
+          const T vc = d1 * d4 - d3 * d2;
+          if (vc <= 0 && d1 >= 0 && d3 <= 0)
+            return Segment(_w, _i0, _i1);
+
+          const T d5 = -ab.Dot(c);
+          const T d6 = -ac.Dot(c);
+          if (d6 >= 0 && d5 <= d6)
+          {
+            r.count = 1;
+            r.index[0] = _i2;
+            r.weight[0] = 1;
+            return r;
+          }
+
+          const T vb = d5 * d2 - d1 * d6;
+          if (vb <= 0 && d2 >= 0 && d6 <= 0)
+            return Segment(_w, _i0, _i2);
+
+          const T va = d3 * d6 - d5 * d4;
+          if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0)
+            return Segment(_w, _i1, _i2);
+
+          const T sum = va + vb + vc;
+          if (sum <= 0)
+          {
+            // Degenerate triangle: keep its closest edge.
+            Reduction best = Segment(_w, _i0, _i1);
+            T bestDistance = Length2(_w, best);
+            for (const auto &edge : {std::make_pair(_i0, _i2),
+                                     std::make_pair(_i1, _i2)})
+            {
+              const Reduction other = Segment(_w, edge.first, edge.second);
+              const T distance = Length2(_w, other);
+              if (distance < bestDistance)
+              {
+                best = other;
+                bestDistance = distance;
+              }
+            }
+            return best;
+          }
+
+          r.count = 3;
+          r.index[0] = _i0;
+          r.index[1] = _i1;
+          r.index[2] = _i2;
+          r.weight[1] = vb / sum;
+          r.weight[2] = vc / sum;
+          r.weight[0] = 1 - r.weight[1] - r.weight[2];
+          return r;
+        }
+
+        /// \brief Point of a tetrahedron closest to the origin.
+        /// \param[in] _w Corners.
+        /// \return Contributing corners and their weights, or a count of 4
+        /// if the origin is inside.
+        private: static Reduction Tetrahedron(
+                     const std::array<Vector3<T>, 4> &_w)
+        {
+          static const unsigned int faces[4][4] =
+              {{0, 1, 2, 3}, {0, 1, 3, 2}, {0, 2, 3, 1}, {1, 2, 3, 0}};
+          const T relTol = RelativeTolerance();
+
+          Reduction best;
+          best.count = 4;
+          T bestDistance = std::numeric_limits<T>::max();
+          for (const auto &face : faces)
+          {
+            const Vector3<T> &a = _w[face[0]];
+            const Vector3<T> normal =
+                (_w[face[1]] - a).Cross(_w[face[2]] - a);
+            const Vector3<T> opposite = _w[face[3]] - a;
+            const T sideOrigin = -normal.Dot(a);
+            const T sideOpposite = normal.Dot(opposite);
+
+            // The origin is outside of faces it is on the other side of
+            // than the opposite corner. Flat tetrahedra have no inside.
+            const bool flat = std::abs(sideOpposite) <=
+                relTol * normal.Length() * opposite.Length();
+            if (!flat && sideOrigin * sideOpposite >= 0)
+              continue;
+
+            const Reduction r = Triangle(_w, face[0], face[1], face[2]);
+            const T distance = Length2(_w, r);
+            if (distance < bestDistance)
+            {
+              best = r;
+              bestDistance = distance;
+            }
+          }
+          return best;
+        }
+
+        /// \brief Squared distance of the point of a reduction to the
+        /// origin.
+        /// \param[in] _w Points.
+        /// \param[in] _r Reduction.
+        /// \return Squared distance.
+        private: static T Length2(const std::array<Vector3<T>, 4> &_w,
+                                  const Reduction &_r)
+        {
+          Vector3<T> point;
+          for (unsigned int i = 0; i < _r.count; ++i)
+            point += _w[_r.index[i]] * _r.weight[i];
+          return point.SquaredLength();
+        }
+
+        /// \brief Face of the EPA polytope.
+        private: struct Face
+        {
+          /// \brief Vertices, counterclockwise seen from outside.
+          std::array<unsigned int, 3> index;
+
+          /// \brief Outward unit normal.
+          Vector3<T> normal;
+
+          /// \brief Distance of the plane of the face to the origin.
+          T distance;
+        };
+
+        /// \brief Grow a simplex with the origin on its boundary into a
+        /// tetrahedron.
+        /// \param[in] _a First shape.
+        /// \param[in] _b Second shape.
+        /// \param[in, out] _simplex Simplex.
+        /// \param[in, out] _count Number of vertices of _simplex.
+        /// \return False if the difference of the cores is flat.
+        private: template<typename A, typename B>
+        static bool BlowUp(const PlacedShape<T, A> &_a,
+                           const PlacedShape<T, B> &_b,
+                           Simplex &_simplex, unsigned int &_count)
+        {
+          const T relTol = RelativeTolerance();
+          const T absTol2 = AbsoluteTolerance() * AbsoluteTolerance();
+          const std::array<Vector3<T>, 6> axes = {
+              Vector3<T>::UnitX, -Vector3<T>::UnitX,
+              Vector3<T>::UnitY, -Vector3<T>::UnitY,
+              Vector3<T>::UnitZ, -Vector3<T>::UnitZ};
+
+          if (_count == 1)
+          {
+            for (const Vector3<T> &axis : axes)
+            {
+              const Vertex w = Support(_a, _b, axis);
+              if ((w.w - _simplex[0].w).SquaredLength() > absTol2)
+              {
+                _simplex[_count++] = w;
+                break;
+              }
+            }
+          }
+
+          if (_count == 2)
+          {
+            const Vector3<T> edge = _simplex[1].w - _simplex[0].w;
+            const Vector3<T> absEdge = edge.Abs();
+            Vector3<T> axis = Vector3<T>::UnitX;
+            if (absEdge.Y() <= absEdge.X() && absEdge.Y() <= absEdge.Z())
+              axis = Vector3<T>::UnitY;
+            else if (absEdge.Z() <= absEdge.X() &&
+                     absEdge.Z() <= absEdge.Y())
+              axis = Vector3<T>::UnitZ;
+            const Vector3<T> side = edge.Cross(axis);
+            const Vector3<T> up = edge.Cross(side);
+            const T length2 = edge.SquaredLength();
+            for (const Vector3<T> &dir : {side, up, -side, -up})
+            {
+              const Vertex w = Support(_a, _b, dir);
+              const Vector3<T> offset = (w.w - _simplex[0].w).Cross(edge);
+              if (offset.SquaredLength() > relTol * relTol * length2 *
+                  (w.w - _simplex[0].w).SquaredLength())
+              {
+                _simplex[_count++] = w;
+                break;
+              }
+            }
+          }
+
+          if (_count == 3)
+          {
+            const Vector3<T> normal = (_simplex[1].w - _simplex[0].w).Cross(
+                _simplex[2].w - _simplex[0].w);
+            for (const Vector3<T> &dir : {normal, -normal})
+            {
+              const Vertex w = Support(_a, _b, dir);
+              const Vector3<T> offset = w.w - _simplex[0].w;
+              if (std::abs(offset.Dot(normal)) >
+                  relTol * normal.Length() * offset.Length())
+              {
+                _simplex[_count++] = w;
+                break;
+              }
+            }
+          }
+
+          return _count == 4;
+        }
+
+        /// \brief Normal of a flat difference of cores, oriented from the
+        /// first shape to the second one.
+        /// \param[in] _a First shape.
+        /// \param[in] _b Second shape.
+        /// \param[in] _simplex Simplex spanning the difference.
+        /// \param[in] _count Number of vertices of _simplex, less than 4.
+        /// \return Unit normal.
+        private: template<typename A, typename B>
+        static Vector3<T> FlatNormal(const PlacedShape<T, A> &_a,
+                                     const PlacedShape<T, B> &_b,
+                                     const Simplex &_simplex,
+                                     const unsigned int _count)
+        {
+          const Vector3<T> centers = _b.pose.Pos() - _a.pose.Pos();
+          Vector3<T> normal = centers;
+          if (_count == 3)
+          {
+            normal = (_simplex[1].w - _simplex[0].w).Cross(
+                _simplex[2].w - _simplex[0].w);
+          }
+          else if (_count == 2)
+          {
+            const Vector3<T> edge =
+                (_simplex[1].w - _simplex[0].w).Normalized();
+            normal = centers - edge * edge.Dot(centers);
+            if (normal.SquaredLength() <= AbsoluteTolerance())
+            {
+              normal = edge.Cross(std::abs(edge.X()) < T(0.5) ?
+                  Vector3<T>::UnitX : Vector3<T>::UnitY);
+            }
+          }
+
+          const T length = normal.Length();
+          if (length <= 0)
+            return Vector3<T>::UnitZ;
+          normal /= length;
+          return normal.Dot(centers) < 0 ? -normal : normal;
+        }
+
+        /// \brief Create a face of the EPA polytope, oriented away from an
+        /// inner point.
+        /// \param[in] _vertices Vertices of the polytope.
+        /// \param[in] _i0 First vertex.
+        /// \param[in] _i1 Second vertex.
+        /// \param[in] _i2 Third vertex.
+        /// \param[in] _inside Point inside the polytope.
+        /// \return Face.
+        private: static Face MakeFace(const Vertex *_vertices,
+                                      const unsigned int _i0,
+                                      const unsigned int _i1,
+                                      const unsigned int _i2,
+                                      const Vector3<T> &_inside)
+        {
+          Face face;
+          face.index = {_i0, _i1, _i2};
+          const Vector3<T> &a = _vertices[_i0].w;
+          face.normal = (_vertices[_i1].w - a).Cross(_vertices[_i2].w - a);
+          if (face.normal.Dot(a - _inside) < 0)
+          {
+            std::swap(face.index[1], face.index[2]);
+            face.normal = -face.normal;
+          }
+          const T length = face.normal.Length();
+          if (length <= 0)
+          {
+            face.distance = std::numeric_limits<T>::max();
+            return face;
+          }
+          face.normal /= length;
+          face.distance = face.normal.Dot(a);
+          return face;
+        }
+
+        /// \brief EPA penetration depth of two overlapping cores.
+        /// \param[in] _a First shape.
+        /// \param[in] _b Second shape.
+        /// \param[in] _simplex Final GJK simplex, containing the origin.
+        /// \param[in] _count Number of vertices of _simplex.
+        /// \param[in] _weights Weights of the vertices of _simplex in the
+        /// origin, unless the origin is inside of a tetrahedron.
+        /// \param[out] _result Penetration depth, normal and points.
+        private: template<typename A, typename B>
+        static void Epa(const PlacedShape<T, A> &_a,
+                        const PlacedShape<T, B> &_b,
+                        Simplex _simplex, const unsigned int _count,
+                        const std::array<T, 4> &_weights,
+                        ShapeDistanceResult<T> &_result)
+        {
+          unsigned int count = _count;
+          if (!BlowUp(_a, _b, _simplex, count))
+          {
+            // The difference of the cores is flat, such as for crossing
+            // capsules, and the origin is on it. Its depth is 0 along its
+            // normal.
+            _result.distance = 0;
+            _result.pointA = Vector3<T>::Zero;
+            _result.pointB = Vector3<T>::Zero;
+            for (unsigned int i = 0; i < _count; ++i)
+            {
+              _result.pointA += _simplex[i].a * _weights[i];
+              _result.pointB += _simplex[i].b * _weights[i];
+            }
+            _result.normal = FlatNormal(_a, _b, _simplex, count);
+            return;
+          }
+
+          std::array<Vertex, kMaxEpaVertices> vertices;
+          unsigned int vertexCount = 4;
+          Vector3<T> inside;
+          for (unsigned int i = 0; i < 4; ++i)
+          {
+            vertices[i] = _simplex[i];
+            inside += _simplex[i].w * T(0.25);
+          }
+
+          std::array<Face, kMaxEpaFaces> faces;
+          unsigned int faceCount = 0;
+          faces[faceCount++] = MakeFace(vertices.data(), 0, 1, 2, inside);
+          faces[faceCount++] = MakeFace(vertices.data(), 0, 1, 3, inside);
+          faces[faceCount++] = MakeFace(vertices.data(), 0, 2, 3, inside);
+          faces[faceCount++] = MakeFace(vertices.data(), 1, 2, 3, inside);
+
+          const T relTol = RelativeTolerance();
+          std::array<bool, kMaxEpaFaces> visible;
+          std::array<std::pair<unsigned int, unsigned int>,
+                     3 * kMaxEpaFaces> horizon;
+          unsigned int closest = 0;
+          while (true)
+          {
+            closest = 0;
+            for (unsigned int f = 1; f < faceCount; ++f)
+            {
+              if (faces[f].distance < faces[closest].distance)
+                closest = f;
+            }
+            const Face &face = faces[closest];
+            if (vertexCount == kMaxEpaVertices)
+              break;
+
+            const Vertex w = Support(_a, _b, face.normal);
+            const T gap = face.normal.Dot(w.w) - face.distance;
+            if (gap <= relTol * std::max(T(1), face.distance))
+              break;
+
+            // Find the faces seen from the new vertex and the edges
+            // bounding them.
+            unsigned int edgeCount = 0;
+            unsigned int kept = 0;
+            for (unsigned int f = 0; f < faceCount; ++f)
+            {
+              const auto &index = faces[f].index;
+              visible[f] = faces[f].normal.Dot(
+                  w.w - vertices[index[0]].w) > 0;
+              if (!visible[f])
+              {
+                ++kept;
+                continue;
+              }
+              for (unsigned int e = 0; e < 3; ++e)
+              {
+                const auto edge = std::make_pair(index[e],
+                                                 index[(e + 1) % 3]);
+                unsigned int twin = 0;
+                while (twin < edgeCount &&
+                       (horizon[twin].first != edge.second ||
+                        horizon[twin].second != edge.first))
+                {
+                  ++twin;
+                }
+                if (twin < edgeCount)
+                  horizon[twin] = horizon[--edgeCount];
+                else
+                  horizon[edgeCount++] = edge;
+              }
+            }
+            if (kept + edgeCount > kMaxEpaFaces)
+              break;
+
+            unsigned int next = 0;
+            for (unsigned int f = 0; f < faceCount; ++f)
+            {
+              if (!visible[f])
+                faces[next++] = faces[f];
+            }
+            faceCount = next;
+
+            const unsigned int added = vertexCount;
+            vertices[vertexCount++] = w;
+            for (unsigned int e = 0; e < edgeCount; ++e)
+            {
+              faces[faceCount++] = MakeFace(vertices.data(),
+                  horizon[e].first, horizon[e].second, added, inside);
+            }
+          }
+
+          // Project the origin on the closest face.
+          const Face &face = faces[closest];
+          const Vertex &v0 = vertices[face.index[0]];
+          const Vertex &v1 = vertices[face.index[1]];
+          const Vertex &v2 = vertices[face.index[2]];
+          const Vector3<T> point = face.normal * face.distance;
+          const Vector3<T> e0 = v1.w - v0.w;
+          const Vector3<T> e1 = v2.w - v0.w;
+          const Vector3<T> p = point - v0.w;
+          const T d00 = e0.Dot(e0);
+          const T d01 = e0.Dot(e1);
+          const T d11 = e1.Dot(e1);
+          const T d20 = p.Dot(e0);
+          const T d21 = p.Dot(e1);
+          const T denominator = d00 * d11 - d01 * d01;
+          T u = 1;
+          T v = 0;
+          T t = 0;
+          if (denominator > 0)
+          {
+            v = (d11 * d20 - d01 * d21) / denominator;
+            t = (d00 * d21 - d01 * d20) / denominator;
+            u = 1 - v - t;
+          }
+
+          _result.distance = -face.distance;
+          _result.normal = face.normal;
+          _result.pointA = v0.a * u + v1.a * v + v2.a * t;
+          _result.pointB = v0.b * u + v1.b * v + v2.b * t;
+        }
+      };
+    }
+
+    /// \brief Distance between two convex shapes with GJK.
+    ///
+    /// The shapes can be any pair of Box, Capsule, Cylinder, Ellipsoid and
+    /// Sphere, placed in the world by a pose. Spheres and capsules are
+    /// handled as a point and a segment inflated by their radius, which
+    /// makes their distances exact; curved surfaces of cylinders and
+    /// ellipsoids converge to a relative tolerance of the square root of
+    /// the machine epsilon of T.
+    ///
+    /// <b>Example</b>
+    /// \code{.cpp}
+    /// gz::math::ShapeDistanceCache<double> cache;
+    /// gz::math::ShapeDistanceResult<double> result;
+    /// for (const auto &pose : trajectory)
+    /// {
+    ///   if (!gz::math::ShapeDistance(robot, pose, obstacle, obstaclePose,
+    ///                                result, &cache))
+    ///     std::cout << "Collision at " << pose << std::endl;
+    /// }
+    /// \endcode
+    /// \param[in] _a First shape.
+    /// \param[in] _poseA Pose of the first shape in the world frame.
+    /// \param[in] _b Second shape.
+    /// \param[in] _poseB Pose of the second shape in the world frame.
+    /// \param[out] _result Distance, closest points and normal. When the
+    /// shapes overlap, the distance is 0 and the other fields are
+    /// unspecified.
+    /// \param[in, out] _cache Simplex of the previous query of the same
+    /// shapes to start from, updated with the final simplex, or nullptr.
+    /// \return True if the shapes are separated, false if they overlap or
+    /// touch.
+    /// \sa ShapePenetration
+    template<typename T, typename ShapeA, typename ShapeB>
+    bool ShapeDistance(const ShapeA &_a, const Pose3<T> &_poseA,
+                       const ShapeB &_b, const Pose3<T> &_poseB,
+                       ShapeDistanceResult<T> &_result,
+                       ShapeDistanceCache<T> *_cache = nullptr)
+    {
+      return detail::Gjk<T>::Query(
+          detail::PlacedShape<T, ShapeA>(_a, _poseA),
+          detail::PlacedShape<T, ShapeB>(_b, _poseB), false, _result,
+          _cache);
+    }
+
+    /// \brief Signed distance between two convex shapes, with GJK and the
+    /// expanding polytope algorithm (EPA) when they overlap.
+    ///
+    /// This is ShapeDistance, followed by EPA when the shapes overlap to
+    /// find the penetration depth, the smallest translation that separates
+    /// them. Overlaps of rounded shapes whose cores are disjoint, such as
+    /// most sphere and capsule contacts, don't need EPA.
+    /// \param[in] _a First shape.
+    /// \param[in] _poseA Pose of the first shape in the world frame.
+    /// \param[in] _b Second shape.
+    /// \param[in] _poseB Pose of the second shape in the world frame.
+    /// \param[out] _result Signed distance, which is minus the penetration
+    /// depth when the shapes overlap, closest or deepest points and normal.
+    /// \param[in, out] _cache Simplex of the previous query of the same
+    /// shapes to start from, updated with the final simplex, or nullptr.
+    /// \return True if the shapes overlap or touch, false if they are
+    /// separated.
+    /// \sa ShapeDistance
+    template<typename T, typename ShapeA, typename ShapeB>
+    bool ShapePenetration(const ShapeA &_a, const Pose3<T> &_poseA,
+                          const ShapeB &_b, const Pose3<T> &_poseB,
+                          ShapeDistanceResult<T> &_result,
+                          ShapeDistanceCache<T> *_cache = nullptr)
+    {
+      return !detail::Gjk<T>::Query(
+          detail::PlacedShape<T, ShapeA>(_a, _poseA),
+          detail::PlacedShape<T, ShapeB>(_b, _poseB), true, _result,
+          _cache);
+    }
+    }
+  }
+}
+#endif
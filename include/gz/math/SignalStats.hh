@@ -19,6 +19,7 @@
 
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <gz/math/Helpers.hh>
 #include <gz/math/config.hh>
@@ -92,6 +93,12 @@ namespace ignition
 
       // Documentation inherited.
       public: virtual void InsertData(const double _data) override;
+
+      /// \brief Add the data points of another maximum statistic, as if
+      /// they had been inserted into this one. This combines statistics
+      /// computed over separate parts of a signal.
+      /// \param[in] _max Statistic to merge into this one.
+      public: void Merge(const SignalMaximum &_max);
     };
 
     /// \class SignalMean SignalStats.hh ignition/math/SignalStats.hh
@@ -107,6 +114,12 @@ namespace ignition
 
       // Documentation inherited.
       public: virtual void InsertData(const double _data) override;
+
+      /// \brief Add the data points of another mean statistic, as if
+      /// they had been inserted into this one. This combines statistics
+      /// computed over separate parts of a signal.
+      /// \param[in] _mean Statistic to merge into this one.
+      public: void Merge(const SignalMean &_mean);
     };
 
     /// \class SignalMinimum SignalStats.hh ignition/math/SignalStats.hh
@@ -122,6 +135,12 @@ namespace ignition
 
       // Documentation inherited.
       public: virtual void InsertData(const double _data) override;
+
+      /// \brief Add the data points of another minimum statistic, as if
+      /// they had been inserted into this one. This combines statistics
+      /// computed over separate parts of a signal.
+      /// \param[in] _min Statistic to merge into this one.
+      public: void Merge(const SignalMinimum &_min);
     };
 
     /// \class SignalRootMeanSquare SignalStats.hh ignition/math/SignalStats.hh
@@ -138,6 +157,12 @@ namespace ignition
 
       // Documentation inherited.
       public: virtual void InsertData(const double _data) override;
+
+      /// \brief Add the data points of another root mean square
+      /// statistic, as if they had been inserted into this one. This
+      /// combines statistics computed over separate parts of a signal.
+      /// \param[in] _rms Statistic to merge into this one.
+      public: void Merge(const SignalRootMeanSquare &_rms);
     };
 
     /// \class SignalMaxAbsoluteValue SignalStats.hh
@@ -156,6 +181,12 @@ namespace ignition
 
       // Documentation inherited.
       public: virtual void InsertData(const double _data) override;
+
+      /// \brief Add the data points of another maximum absolute value
+      /// statistic, as if they had been inserted into this one. This
+      /// combines statistics computed over separate parts of a signal.
+      /// \param[in] _maxAbs Statistic to merge into this one.
+      public: void Merge(const SignalMaxAbsoluteValue &_maxAbs);
     };
 
     /// \class SignalVariance SignalStats.hh ignition/math/SignalStats.hh
@@ -172,6 +203,107 @@ namespace ignition
 
       // Documentation inherited.
       public: virtual void InsertData(const double _data) override;
+
+      /// \brief Add the data points of another variance statistic, as if
+      /// they had been inserted into this one. This combines statistics
+      /// computed over separate parts of a signal.
+      /// The variances are combined with the parallel algorithm of Chan et
+      /// al., so the result matches inserting all the data points into one
+      /// statistic, up to rounding.
+      /// \param[in] _var Statistic to merge into this one.
+      public: void Merge(const SignalVariance &_var);
+    };
+
+    /// \brief Forward declare private data class.
+    class SignalQuantilePrivate;
+
+    /// \class SignalQuantile SignalStats.hh ignition/math/SignalStats.hh
+    /// \brief Estimating a quantile of a discretely sampled signal, such as
+    /// its median or 99th percentile, in bounded memory.
+    ///
+    /// The samples are summarized by a merging t-digest (Dunning and Ertl,
+    /// "Computing extremely accurate quantiles using t-digests", 2019),
+    /// which keeps a bounded number of weighted centroids. The centroids
+    /// are smaller near the ends of the distribution, so tail quantiles
+    /// are the most accurate. The memory used does not depend on the
+    /// number of samples, and digests of separate parts of a signal can be
+    /// merged.
+    class IGNITION_MATH_VISIBLE SignalQuantile : public SignalStatistic
+    {
+      /// \brief Constructor
+      /// \param[in] _quantile Quantile to estimate, between 0 and 1. For
+      /// example 0.99 for the 99th percentile. It is clamped to [0, 1].
+      /// \param[in] _compression Compression of the digest. The number of
+      /// centroids is roughly proportional to it, and the error inversely
+      /// proportional to it. It is clamped to at least 10.
+      public: explicit SignalQuantile(const double _quantile = 0.5,
+                                      const double _compression = 100);
+
+      /// \brief Constructor. The digest is allocated from a memory
+      /// resource, such as a std::pmr::monotonic_buffer_resource, so that
+      /// inserting data never calls the global allocator. Copies use the
+      /// default memory resource.
+      /// \param[in] _quantile Quantile to estimate, between 0 and 1.
+      /// \param[in] _compression Compression of the digest.
+      /// \param[in] _resource Memory resource, which must outlive the
+      /// statistic.
+      public: SignalQuantile(const double _quantile,
+                             const double _compression,
+                             std::pmr::memory_resource *_resource);
+
+      /// \brief Copy constructor
+      /// \param[in] _sq SignalQuantile to copy
+      public: SignalQuantile(const SignalQuantile &_sq);
+
+      /// \brief Destructor
+      public: virtual ~SignalQuantile();
+
+      /// \brief Get the quantile estimated by Value.
+      /// \return Quantile between 0 and 1.
+      public: double Quantile() const;
+
+      /// \brief Get the compression of the digest.
+      /// \return Compression.
+      public: double Compression() const;
+
+      /// \brief Get the estimate of the quantile.
+      /// \return Estimate of the quantile, or 0 if there is no data.
+      public: virtual double Value() const override;
+
+      /// \brief Get the estimate of any quantile from the same digest.
+      /// \param[in] _quantile Quantile between 0 and 1.
+      /// \return Estimate of the quantile, or 0 if there is no data.
+      public: double Value(const double _quantile) const;
+
+      /// \brief Get a short version of the name of this statistical measure.
+      /// \return "p" followed by the percentile, for example "p99" or
+      /// "p99.9".
+      public: virtual std::string ShortName() const override;
+
+      // Documentation inherited.
+      public: virtual void InsertData(const double _data) override;
+
+      // Documentation inherited.
+      public: virtual void Reset() override;
+
+      /// \brief Add the data points of another quantile statistic, as if
+      /// they had been inserted into this one. This combines statistics
+      /// computed over separate parts of a signal. The quantile and
+      /// compression of this statistic are kept.
+      /// \param[in] _sq Statistic to merge into this one.
+      public: void Merge(const SignalQuantile &_sq);
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Pointer to the digest.
+      private: std::unique_ptr<SignalQuantilePrivate> quantilePtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
     };
 
     /// \brief Forward declare private data class.
@@ -184,6 +316,12 @@ namespace ignition
       /// \brief Constructor
       public: SignalStats();
 
+      /// \brief Constructor. Statistics which store data, such as
+      /// percentiles, allocate it from a memory resource.
+      /// \param[in] _resource Memory resource, which must outlive the
+      /// statistics.
+      public: explicit SignalStats(std::pmr::memory_resource *_resource);
+
       /// \brief Destructor
       public: ~SignalStats();
 
@@ -214,6 +352,8 @@ namespace ignition
       ///  "maxAbs"
       ///  "mean"
       ///  "rms"
+      ///  "p" followed by a percentile between 0 and 100, such as "p50",
+      ///  "p99" or "p99.9", see SignalQuantile
       /// \return True if statistic was successfully added,
       /// false if name was not recognized or had already
       /// been inserted.
@@ -228,6 +368,15 @@ namespace ignition
       /// been inserted.
       public: bool InsertStatistics(const std::string &_names);
 
+      /// \brief Add the data points of another collection of statistics,
+      /// as if they had been inserted into this one. This combines
+      /// statistics computed over separate parts of a signal, for example
+      /// by parallel workers.
+      /// \param[in] _stats Statistics to merge into this one.
+      /// \return True if both collections hold the same statistics. Nothing
+      /// is changed otherwise.
+      public: bool Merge(const SignalStats &_stats);
+
       /// \brief Forget all previous data.
       public: void Reset();
 
@@ -246,6 +395,206 @@ namespace ignition
       private: std::unique_ptr<SignalStatsPrivate> dataPtr;
 #ifdef _WIN32
 #pragma warning(pop)
+#endif
+    };
+
+    /// \brief Forward declare private data class.
+    class SignalAccumulatorPrivate;
+
+    /// \class SignalAccumulator SignalStats.hh ignition/math/SignalStats.hh
+    /// \brief Computes all the statistics of SignalStats in a single pass.
+    ///
+    /// Unlike SignalStats, the statistics are not separate objects behind
+    /// virtual calls: each sample updates one set of running sums. The
+    /// values are the same as the values of the matching SignalStatistic
+    /// classes.
+    class IGNITION_MATH_VISIBLE SignalAccumulator
+    {
+      /// \brief Constructor
+      public: SignalAccumulator();
+
+      /// \brief Destructor
+      public: ~SignalAccumulator();
+
+      /// \brief Copy constructor
+      /// \param[in] _acc SignalAccumulator to copy
+      public: SignalAccumulator(const SignalAccumulator &_acc);
+
+      /// \brief Assignment operator
+      /// \param[in] _acc SignalAccumulator to copy
+      /// \return this
+      public: SignalAccumulator &operator=(const SignalAccumulator &_acc);
+
+      /// \brief Add a new sample to the statistics.
+      /// \param[in] _data New signal data point.
+      public: void InsertData(const double _data);
+
+      /// \brief Add new samples to the statistics.
+      /// \param[in] _data Array of signal data points.
+      /// \param[in] _count Number of data points.
+      public: void InsertData(const double *_data, const size_t _count);
+
+      /// \brief Add the data points of another accumulator, as if they had
+      /// been inserted into this one. This combines statistics computed
+      /// over separate parts of a signal, see SignalStats::Merge.
+      /// \param[in] _acc Accumulator to merge into this one.
+      public: void Merge(const SignalAccumulator &_acc);
+
+      /// \brief Forget all previous data.
+      public: void Reset();
+
+      /// \brief Get number of data points.
+      /// \return Number of data points.
+      public: size_t Count() const;
+
+      /// \brief Get the maximum value, see SignalMaximum.
+      /// \return Maximum value, or 0 if there is no data.
+      public: double Max() const;
+
+      /// \brief Get the maximum absolute value, see SignalMaxAbsoluteValue.
+      /// \return Maximum absolute value, or 0 if there is no data.
+      public: double MaxAbs() const;
+
+      /// \brief Get the mean value, see SignalMean.
+      /// \return Mean value, or 0 if there is no data.
+      public: double Mean() const;
+
+      /// \brief Get the minimum value, see SignalMinimum.
+      /// \return Minimum value, or 0 if there is no data.
+      public: double Min() const;
+
+      /// \brief Get the root mean square, see SignalRootMeanSquare.
+      /// \return Root mean square, or 0 if there is no data.
+      public: double Rms() const;
+
+      /// \brief Get the variance, see SignalVariance.
+      /// \return Variance, or 0 if there are less than two data points.
+      public: double Variance() const;
+
+      /// \brief Get the values of all the statistics, stored in a map
+      /// using the short name of each statistic as the key, like
+      /// SignalStats::Map.
+      /// \return Map with the short name of each statistic as key
+      /// and value of statistic as the value.
+      public: std::map<std::string, double> Map() const;
+
+      /// \brief Vector3Accumulator builds the accumulators of its
+      /// components.
+      friend class Vector3Accumulator;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<SignalAccumulatorPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+
+    /// \brief Forward declare private data class.
+    class SignalWindowAccumulatorPrivate;
+
+    /// \class SignalWindowAccumulator SignalStats.hh
+    /// ignition/math/SignalStats.hh
+    /// \brief Computes the statistics of SignalAccumulator over the most
+    /// recent samples of a signal.
+    ///
+    /// Each sample takes constant time: the sums are updated as samples
+    /// enter and leave the window, and the minimum, maximum and maximum
+    /// absolute value are the front of monotonic queues, which makes them
+    /// constant time amortized. The sums are recomputed from the window
+    /// each time it fills again, so rounding errors do not build up.
+    class IGNITION_MATH_VISIBLE SignalWindowAccumulator
+    {
+      /// \brief Constructor
+      /// \param[in] _windowSize Number of samples in the window. A window
+      /// size of zero is changed to one.
+      public: explicit SignalWindowAccumulator(const size_t _windowSize = 4);
+
+      /// \brief Destructor
+      public: ~SignalWindowAccumulator();
+
+      /// \brief Copy constructor
+      /// \param[in] _acc SignalWindowAccumulator to copy
+      public: SignalWindowAccumulator(const SignalWindowAccumulator &_acc);
+
+      /// \brief Assignment operator
+      /// \param[in] _acc SignalWindowAccumulator to copy
+      /// \return this
+      public: SignalWindowAccumulator &operator=(
+                  const SignalWindowAccumulator &_acc);
+
+      /// \brief Set the window size, and forget all previous data.
+      /// \param[in] _windowSize Number of samples in the window. A window
+      /// size of zero is changed to one.
+      public: void SetWindowSize(const size_t _windowSize);
+
+      /// \brief Get the window size.
+      /// \return Number of samples in the window.
+      public: size_t WindowSize() const;
+
+      /// \brief Add a new sample, which replaces the oldest sample once the
+      /// window is full.
+      /// \param[in] _data New signal data point.
+      public: void InsertData(const double _data);
+
+      /// \brief Add new samples, in order.
+      /// \param[in] _data Array of signal data points.
+      /// \param[in] _count Number of data points.
+      public: void InsertData(const double *_data, const size_t _count);
+
+      /// \brief Forget all previous data.
+      public: void Reset();
+
+      /// \brief Get number of data points in the window.
+      /// \return Number of data points, at most the window size.
+      public: size_t Count() const;
+
+      /// \brief Get the maximum value in the window.
+      /// \return Maximum value, or 0 if there is no data.
+      public: double Max() const;
+
+      /// \brief Get the maximum absolute value in the window.
+      /// \return Maximum absolute value, or 0 if there is no data.
+      public: double MaxAbs() const;
+
+      /// \brief Get the mean value of the window.
+      /// \return Mean value, or 0 if there is no data.
+      public: double Mean() const;
+
+      /// \brief Get the minimum value in the window.
+      /// \return Minimum value, or 0 if there is no data.
+      public: double Min() const;
+
+      /// \brief Get the root mean square of the window.
+      /// \return Root mean square, or 0 if there is no data.
+      public: double Rms() const;
+
+      /// \brief Get the variance of the window.
+      /// \return Variance, or 0 if there are less than two data points.
+      public: double Variance() const;
+
+      /// \brief Get the values of all the statistics, stored in a map
+      /// using the short name of each statistic as the key, like
+      /// SignalStats::Map.
+      /// \return Map with the short name of each statistic as key
+      /// and value of statistic as the value.
+      public: std::map<std::string, double> Map() const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<SignalWindowAccumulatorPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
 #endif
     };
     }
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SKINWEIGHTS_HH_
+#define GZ_MATH_SKINWEIGHTS_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include <gz/math/Matrix4.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3SoA.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  // Forward declaration.
+  class SkinWeightsPrivate;
+
+  /// \class SkinWeights SkinWeights.hh ignition/math/SkinWeights.hh
+  /// \brief Bone weights of the vertices of a skinned mesh, and the linear
+  /// blend and dual quaternion skinning kernels that deform the mesh with
+  /// them.
+  ///
+  /// Every vertex has the same number of influences, each one a bone index
+  /// and a weight. Vertices with fewer influences use a zero weight for the
+  /// remaining ones. The table is stored influence by influence, so that
+  /// the kernels read it and the structure-of-arrays positions with unit
+  /// stride, and can split the vertices between threads. Each blended
+  /// transform is accumulated in registers from a packed copy of the bone
+  /// transforms.
+  ///
+  /// The bone transforms passed to the kernels map the rest pose of the
+  /// mesh to its deformed pose, that is the world transform of each bone
+  /// multiplied by the inverse of its bind transform.
+  ///
+  /// Vertices whose weights are all zero keep their rest position.
+  class IGNITION_MATH_VISIBLE SkinWeights
+  {
+    /// \brief Default constructor. Creates a table without vertices.
+    public: SkinWeights();
+
+    /// \brief Constructor. Creates a table with all weights set to zero.
+    /// \param[in] _vertexCount Number of vertices.
+    /// \param[in] _influenceCount Number of influences of each vertex.
+    public: SkinWeights(const std::size_t _vertexCount,
+                        const std::size_t _influenceCount);
+
+    /// \brief Copy constructor.
+    /// \param[in] _weights Table to copy.
+    public: SkinWeights(const SkinWeights &_weights);
+
+    /// \brief Destructor.
+    public: ~SkinWeights();
+
+    /// \brief Assignment operator.
+    /// \param[in] _weights Table to copy.
+    /// \return Reference to this table.
+    public: SkinWeights &operator=(const SkinWeights &_weights);
+
+    /// \brief Set the whole table.
+    /// \param[in] _bones Bone index of each influence, InfluenceCount()
+    /// consecutive values per vertex.
+    /// \param[in] _weights Weight of each influence, laid out like _bones.
+    /// \param[in] _influenceCount Number of influences of each vertex.
+    /// \return False if _influenceCount is zero, or if the sizes of _bones
+    /// and _weights differ or are not a multiple of _influenceCount, in
+    /// which case the table is unchanged.
+    public: bool Set(const std::vector<uint32_t> &_bones,
+                     const std::vector<double> &_weights,
+                     const std::size_t _influenceCount);
+
+    /// \brief Set one influence of a vertex.
+    /// \param[in] _vertex Index of the vertex.
+    /// \param[in] _influence Index of the influence, less than
+    /// InfluenceCount().
+    /// \param[in] _bone Index of the bone.
+    /// \param[in] _weight Weight of the bone.
+    /// \return False if _vertex or _influence is out of range.
+    public: bool SetInfluence(const std::size_t _vertex,
+                              const std::size_t _influence,
+                              const uint32_t _bone, const double _weight);
+
+    /// \brief Get the number of vertices.
+    /// \return Number of vertices.
+    public: std::size_t VertexCount() const;
+
+    /// \brief Get the number of influences of each vertex.
+    /// \return Number of influences.
+    public: std::size_t InfluenceCount() const;
+
+    /// \brief Get the bone of an influence.
+    /// \param[in] _vertex Index of the vertex.
+    /// \param[in] _influence Index of the influence.
+    /// \return Index of the bone, or 0 if an index is out of range.
+    public: uint32_t Bone(const std::size_t _vertex,
+                          const std::size_t _influence) const;
+
+    /// \brief Get the weight of an influence.
+    /// \param[in] _vertex Index of the vertex.
+    /// \param[in] _influence Index of the influence.
+    /// \return Weight of the bone, or 0 if an index is out of range.
+    public: double Weight(const std::size_t _vertex,
+                          const std::size_t _influence) const;
+
+    /// \brief Get the largest bone index plus one.
+    /// \return Number of bone transforms the kernels need.
+    public: std::size_t BoneCount() const;
+
+    /// \brief Scale the weights of each vertex so that they sum to one.
+    /// Vertices whose weights sum to zero are left unchanged.
+    public: void NormalizeWeights();
+
+    /// \brief Deform vertices with linear blend skinning,
+    /// v' = sum_i(w_i * M_i * v).
+    /// \param[in] _transforms Affine transform of each bone. Only the top
+    /// three rows are used.
+    /// \param[in] _rest Rest positions, VertexCount() of them.
+    /// \param[out] _out Deformed positions, resized to _rest.Size(). It may
+    /// be the same container as _rest.
+    /// \param[in] _threads Number of threads. Each thread deforms a
+    /// contiguous range of vertices. A value of 0 uses the number of
+    /// hardware threads. Small meshes always use a single thread.
+    /// \return False if the number of rest positions is not VertexCount()
+    /// or there are fewer than BoneCount() transforms.
+    public: bool LinearBlend(const std::vector<Matrix4d> &_transforms,
+                             const Vector3SoAd &_rest, Vector3SoAd &_out,
+                             const unsigned int _threads = 1) const;
+
+    /// \brief Deform vertices with dual quaternion skinning. The unit dual
+    /// quaternions of the bones are blended with the weights, flipping
+    /// those in the opposite hemisphere of the first influence, and the
+    /// normalized blend is applied to the vertex. Unlike linear blending,
+    /// this preserves volume around twisting joints.
+    /// \param[in] _poses Rigid transform of each bone. The rotations are
+    /// normalized.
+    /// \param[in] _rest Rest positions, VertexCount() of them.
+    /// \param[out] _out Deformed positions, resized to _rest.Size(). It may
+    /// be the same container as _rest.
+    /// \param[in] _threads Number of threads, as in LinearBlend().
+    /// \return False if the number of rest positions is not VertexCount()
+    /// or there are fewer than BoneCount() poses.
+    public: bool DualQuaternionBlend(const std::vector<Pose3d> &_poses,
+                                     const Vector3SoAd &_rest,
+                                     Vector3SoAd &_out,
+                                     const unsigned int _threads = 1) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+    /// \brief Private data pointer.
+    private: std::unique_ptr<SkinWeightsPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+  };
+  }
+}
+}
+#endif
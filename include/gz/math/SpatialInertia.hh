@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SPATIALINERTIA_HH_
+#define GZ_MATH_SPATIALINERTIA_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include <gz/math/config.hh>
+#include <gz/math/Inertial.hh>
+#include <gz/math/MassMatrix3.hh>
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Matrix6.hh>
+#include <gz/math/SpatialTransform.hh>
+#include <gz/math/SpatialVector.hh>
+#include <gz/math/Vector3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    /// \class SpatialInertia SpatialInertia.hh
+    /// ignition/math/SpatialInertia.hh
+    /// \brief The 6x6 spatial inertia of a rigid body about the origin of a
+    /// frame, stored as its mass m, first moment of mass h = m c, where c
+    /// is the center of mass, and rotational inertia I about the origin.
+    ///
+    /// With the angular part first, as in SpatialTransform, the matrix is
+    /// [I hx; hx^T m1], where hx is the cross product matrix of h.
+    /// Multiplying a motion vector by it gives the momentum, a force
+    /// vector. Transform() changes the frame of the inertia in a few 3x3
+    /// products, instead of the two 6x6 products of X* I X^-1, and
+    /// Matrix() builds the equivalent Matrix6.
+    /// \tparam T a numeric type.
+    template<typename T>
+    class SpatialInertia
+    {
+      /// \brief Default constructor. Creates a zero inertia.
+      public: SpatialInertia() = default;
+
+      /// \brief Constructor from the inertia about the center of mass.
+      /// \param[in] _mass Mass.
+      /// \param[in] _centerOfMass Center of mass.
+      /// \param[in] _moi Moment of inertia matrix about the center of mass,
+      /// expressed in this frame.
+      public: SpatialInertia(const T _mass, const Vector3<T> &_centerOfMass,
+                             const Matrix3<T> &_moi)
+      : mass(_mass), firstMoment(_centerOfMass * _mass),
+        rotationalInertia(_moi + Shift(_centerOfMass, _mass))
+      {
+      }
+
+      /// \brief Constructor from a mass matrix, whose center of mass is at
+      /// the origin.
+      /// \param[in] _massMatrix Mass and inertia matrix.
+      public: explicit SpatialInertia(const MassMatrix3<T> &_massMatrix)
+      : mass(_massMatrix.Mass()), rotationalInertia(_massMatrix.Moi())
+      {
+      }
+
+      /// \brief Constructor from an Inertial, expressed in the frame F of
+      /// the Inertial.
+      /// \param[in] _inertial Mass matrix and pose of the inertial frame.
+      public: explicit SpatialInertia(const Inertial<T> &_inertial)
+      : SpatialInertia(_inertial.MassMatrix().Mass(),
+                       _inertial.Pose().Pos(), _inertial.Moi())
+      {
+      }
+
+      /// \brief Get the mass.
+      /// \return Mass.
+      public: T Mass() const
+      {
+        return this->mass;
+      }
+
+      /// \brief Get the first moment of mass.
+      /// \return Mass times the center of mass.
+      public: const Vector3<T> &FirstMoment() const
+      {
+        return this->firstMoment;
+      }
+
+      /// \brief Get the center of mass.
+      /// \return Center of mass, or zero if the mass is zero.
+      public: Vector3<T> CenterOfMass() const
+      {
+        if (std::abs(this->mass) < std::numeric_limits<T>::min())
+          return Vector3<T>::Zero;
+        return this->firstMoment / this->mass;
+      }
+
+      /// \brief Get the rotational inertia about the origin.
+      /// \return Moment of inertia matrix about the origin.
+      public: const Matrix3<T> &RotationalInertia() const
+      {
+        return this->rotationalInertia;
+      }
+
+      /// \brief Get the moment of inertia about the center of mass.
+      /// \return Moment of inertia matrix about the center of mass.
+      public: Matrix3<T> Moi() const
+      {
+        return this->rotationalInertia -
+               Shift(this->CenterOfMass(), this->mass);
+      }
+
+      /// \brief Get the 6x6 matrix.
+      /// \return [I hx; hx^T m1].
+      public: Matrix6<T> Matrix() const
+      {
+        const Vector3<T> &h = this->firstMoment;
+        const Matrix3<T> hx(0, -h.Z(), h.Y(),
+                            h.Z(), 0, -h.X(),
+                            -h.Y(), h.X(), 0);
+        Matrix6<T> result;
+        result.SetSubmatrix(Matrix6<T>::TOP_LEFT, this->rotationalInertia);
+        result.SetSubmatrix(Matrix6<T>::TOP_RIGHT, hx);
+        result.SetSubmatrix(Matrix6<T>::BOTTOM_LEFT, hx.Transposed());
+        result.SetSubmatrix(Matrix6<T>::BOTTOM_RIGHT,
+                            Matrix3<T>::Identity * this->mass);
+        return result;
+      }
+
+      /// \brief Multiply a motion vector, such as a velocity, to get a
+      /// force vector, such as a momentum.
+      /// \param[in] _m Motion vector.
+      /// \return [I w + h x v; m v - h x w].
+      public: SpatialVector<T> operator*(const SpatialVector<T> &_m) const
+      {
+        return SpatialVector<T>(
+            this->rotationalInertia * _m.Angular() +
+            this->firstMoment.Cross(_m.Linear()),
+            _m.Linear() * this->mass -
+            this->firstMoment.Cross(_m.Angular()));
+      }
+
+      /// \brief Get the inertia of two bodies rigidly attached together.
+      /// \param[in] _i Inertia of the other body, in the same frame.
+      /// \return The sum of the inertias.
+      public: SpatialInertia<T> operator+(const SpatialInertia<T> &_i) const
+      {
+        SpatialInertia<T> result = *this;
+        result += _i;
+        return result;
+      }
+
+      /// \brief Add the inertia of another body rigidly attached to this.
+      /// \param[in] _i Inertia of the other body, in the same frame.
+      /// \return Reference to this.
+      public: SpatialInertia<T> &operator+=(const SpatialInertia<T> &_i)
+      {
+        this->mass += _i.mass;
+        this->firstMoment += _i.firstMoment;
+        this->rotationalInertia = this->rotationalInertia +
+                                  _i.rotationalInertia;
+        return *this;
+      }
+
+      /// \brief Express this inertia in another frame, X* I X^-1.
+      /// \param[in] _x Transform from this frame A to the new frame B.
+      /// \return The inertia in B.
+      public: SpatialInertia<T> Transform(
+                  const SpatialTransform<T> &_x) const
+      {
+        // With d = h_A - m r, where E and r are those of _x:
+        // I_B = E (I_A + h r^T + r d^T - (r.h + r.d) 1) E^T and h_B = E d.
+        const Matrix3<T> &e = _x.Rotation();
+        const Vector3<T> &r = _x.Translation();
+        const Vector3<T> &h = this->firstMoment;
+        const Vector3<T> d = h - r * this->mass;
+        const Matrix3<T> i = this->rotationalInertia + Outer(h, r) +
+            Outer(r, d) - Diagonal(r.Dot(h) + r.Dot(d));
+
+        SpatialInertia<T> result;
+        result.mass = this->mass;
+        result.firstMoment = e * d;
+        result.rotationalInertia = e * i * e.Transposed();
+        return result;
+      }
+
+      /// \brief Express this inertia in the source frame of a transform,
+      /// X^T I X, without inverting the transform.
+      /// \param[in] _x Transform from a frame A to this frame B.
+      /// \return The inertia in A.
+      public: SpatialInertia<T> InverseTransform(
+                  const SpatialTransform<T> &_x) const
+      {
+        // With g = E^T h_B and d = g + m r:
+        // I_A = E^T I_B E - g r^T - r d^T + (r.g + r.d) 1 and h_A = d.
+        const Matrix3<T> &e = _x.Rotation();
+        const Vector3<T> &r = _x.Translation();
+        const Vector3<T> g = this->firstMoment * e;
+        const Vector3<T> d = g + r * this->mass;
+
+        SpatialInertia<T> result;
+        result.mass = this->mass;
+        result.firstMoment = d;
+        result.rotationalInertia = e.Transposed() *
+            this->rotationalInertia * e - Outer(g, r) - Outer(r, d) +
+            Diagonal(r.Dot(g) + r.Dot(d));
+        return result;
+      }
+
+      /// \brief Build the spatial inertias of many Inertials, as the
+      /// constructor from an Inertial.
+      /// \param[in] _inertials Array of _count Inertials.
+      /// \param[in] _count Number of Inertials.
+      /// \param[out] _out Array of _count spatial inertias.
+      public: static void FromInertials(const Inertial<T> *_inertials,
+                  const std::size_t _count, SpatialInertia<T> *_out)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = SpatialInertia<T>(_inertials[i]);
+      }
+
+      /// \brief Express many inertias in other frames, as Transform.
+      /// \param[in] _transforms Array of _count transforms, from the frame
+      /// of each inertia to its new frame.
+      /// \param[in] _inertias Array of _count inertias.
+      /// \param[in] _count Number of inertias.
+      /// \param[out] _out Array of _count transformed inertias. It may be
+      /// _inertias.
+      public: static void Transform(const SpatialTransform<T> *_transforms,
+                  const SpatialInertia<T> *_inertias,
+                  const std::size_t _count, SpatialInertia<T> *_out)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = _inertias[i].Transform(_transforms[i]);
+      }
+
+      /// \brief Equality test with tolerance.
+      /// \param[in] _i The inertia to compare to.
+      /// \param[in] _tol Equality tolerance.
+      /// \return True if the masses, first moments and rotational inertias
+      /// are equal within _tol.
+      public: bool Equal(const SpatialInertia<T> &_i, const T &_tol) const
+      {
+        return equal(this->mass, _i.mass, _tol) &&
+               this->firstMoment.Equal(_i.firstMoment, _tol) &&
+               this->rotationalInertia.Equal(_i.rotationalInertia, _tol);
+      }
+
+      /// \brief Get the inertia of a point mass, which shifts an inertia
+      /// from the center of mass to the origin.
+      /// \param[in] _c Position of the point.
+      /// \param[in] _mass Mass of the point.
+      /// \return m (c.c 1 - c c^T).
+      private: static Matrix3<T> Shift(const Vector3<T> &_c, const T _mass)
+      {
+        return Diagonal(_mass * _c.Dot(_c)) - Outer(_c * _mass, _c);
+      }
+
+      /// \brief Get a diagonal matrix.
+      /// \param[in] _d Diagonal value.
+      /// \return _d 1.
+      private: static Matrix3<T> Diagonal(const T _d)
+      {
+        return Matrix3<T>(_d, 0, 0, 0, _d, 0, 0, 0, _d);
+      }
+
+      /// \brief Get an outer product.
+      /// \param[in] _a Column vector.
+      /// \param[in] _b Row vector.
+      /// \return _a _b^T.
+      private: static Matrix3<T> Outer(const Vector3<T> &_a,
+                                       const Vector3<T> &_b)
+      {
+        return Matrix3<T>(_a.X() * _b.X(), _a.X() * _b.Y(), _a.X() * _b.Z(),
+                          _a.Y() * _b.X(), _a.Y() * _b.Y(), _a.Y() * _b.Z(),
+                          _a.Z() * _b.X(), _a.Z() * _b.Y(), _a.Z() * _b.Z());
+      }
+
+      /// \brief Mass.
+      private: T mass = 0;
+
+      /// \brief First moment of mass, the mass times the center of mass.
+      private: Vector3<T> firstMoment;
+
+      /// \brief Rotational inertia about the origin.
+      private: Matrix3<T> rotationalInertia = Matrix3<T>::Zero;
+    };
+
+    typedef SpatialInertia<double> SpatialInertiad;
+    typedef SpatialInertia<float> SpatialInertiaf;
+    }
+  }
+}
+#endif
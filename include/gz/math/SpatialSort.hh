@@ -0,0 +1,326 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SPATIALSORT_HH_
+#define GZ_MATH_SPATIALSORT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+// Use the BMI2 bit deposit and extract instructions for the Morton codes
+// when the calling code is compiled for them. Define
+// IGNITION_MATH_DISABLE_SIMD to always use the portable code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD) && defined(__BMI2__) && \
+    defined(IGNITION_MATH_HAS_IS_CONSTANT_EVALUATED)
+  #define IGNITION_MATH_MORTON_BMI2 1
+  #include <immintrin.h>
+#endif
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \enum SpaceFillingCurve
+    /// \brief Curves that order the cells of a grid so that cells close
+    /// along the curve are close in space.
+    enum class SpaceFillingCurve
+    {
+      /// \brief Z-order curve, which interleaves the bits of the
+      /// coordinates. It is the cheapest to compute.
+      MORTON = 0,
+
+      /// \brief Hilbert curve, whose consecutive cells are always
+      /// adjacent, which gives slightly better locality.
+      HILBERT = 1
+    };
+
+    /// \brief Number of bits of each coordinate of a 3D curve key, so that
+    /// the key fits in 63 bits.
+    constexpr unsigned int kCurveBits = 21;
+
+    namespace detail
+    {
+      /// \brief Bits of the x coordinate in a Morton code.
+      constexpr uint64_t kMortonMask = 0x1249249249249249ull;
+
+      /// \brief Spread the 21 low bits of a value to every third bit.
+      /// \param[in] _v Value.
+      /// \return Spread bits.
+      constexpr uint64_t MortonSpread(const uint32_t _v)
+      {
+        uint64_t x = _v & 0x1fffffu;
+        x = (x | x << 32) & 0x1f00000000ffffull;
+        x = (x | x << 16) & 0x1f0000ff0000ffull;
+        x = (x | x << 8) & 0x100f00f00f00f00full;
+        x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+        x = (x | x << 2) & kMortonMask;
+        return x;
+      }
+
+      /// \brief Gather every third bit of a value, the reverse of
+      /// MortonSpread.
+      /// \param[in] _x Spread bits.
+      /// \return Value.
+      constexpr uint32_t MortonCompact(const uint64_t _x)
+      {
+        uint64_t x = _x & kMortonMask;
+        x = (x ^ (x >> 2)) & 0x10c30c30c30c30c3ull;
+        x = (x ^ (x >> 4)) & 0x100f00f00f00f00full;
+        x = (x ^ (x >> 8)) & 0x1f0000ff0000ffull;
+        x = (x ^ (x >> 16)) & 0x1f00000000ffffull;
+        x = (x ^ (x >> 32)) & 0x1fffffull;
+        return static_cast<uint32_t>(x);
+      }
+
+      /// \brief Step of the Hilbert transforms at one bit: invert the
+      /// lower bits of _x0 if the bit of _xi is set, or else exchange them
+      /// with those of _xi, without branches.
+      /// \param[in,out] _x0 The first coordinate.
+      /// \param[in,out] _xi The coordinate whose bit is tested, which may
+      /// be _x0.
+      /// \param[in] _q The bit.
+      constexpr void HilbertStep(uint32_t &_x0, uint32_t &_xi,
+                                 const uint32_t _q)
+      {
+        const uint32_t p = _q - 1;
+        const uint32_t set = 0u - ((_xi & _q) != 0);
+        _x0 ^= p & set;
+        const uint32_t t = (_x0 ^ _xi) & p & ~set;
+        _x0 ^= t;
+        _xi ^= t;
+      }
+
+      /// \brief Convert coordinates to the transposed Hilbert index of
+      /// Skilling (2004), in place. The coordinates are separate variables
+      /// rather than an array so that they stay in registers.
+      /// \param[in,out] _x The first coordinate.
+      /// \param[in,out] _y The second coordinate.
+      /// \param[in,out] _z The third coordinate.
+      constexpr void HilbertAxesToTranspose(uint32_t &_x, uint32_t &_y,
+                                            uint32_t &_z)
+      {
+        // Inverse undo
+        for (uint32_t q = 1u << (kCurveBits - 1); q > 1; q >>= 1)
+        {
+          HilbertStep(_x, _x, q);
+          HilbertStep(_x, _y, q);
+          HilbertStep(_x, _z, q);
+        }
+        // Gray encode
+        _y ^= _x;
+        _z ^= _y;
+        uint32_t t = 0;
+        for (uint32_t q = 1u << (kCurveBits - 1); q > 1; q >>= 1)
+          t ^= (q - 1) & (0u - ((_z & q) != 0));
+        _x ^= t;
+        _y ^= t;
+        _z ^= t;
+      }
+
+      /// \brief Convert a transposed Hilbert index to coordinates, in
+      /// place, the reverse of HilbertAxesToTranspose.
+      /// \param[in,out] _x The first part of the index.
+      /// \param[in,out] _y The second part.
+      /// \param[in,out] _z The third part.
+      constexpr void HilbertTransposeToAxes(uint32_t &_x, uint32_t &_y,
+                                            uint32_t &_z)
+      {
+        // Gray decode
+        const uint32_t t = _z >> 1;
+        _z ^= _y;
+        _y ^= _x;
+        _x ^= t;
+        // Undo excess work
+        for (uint32_t q = 2; q != (1u << kCurveBits); q <<= 1)
+        {
+          HilbertStep(_x, _z, q);
+          HilbertStep(_x, _y, q);
+          HilbertStep(_x, _x, q);
+        }
+      }
+    }
+
+    /// \brief Encode the cell of a 3D grid as a Morton code (Z-order), by
+    /// interleaving the bits of its coordinates: bit i of _x becomes bit
+    /// 3i of the code, bit i of _y bit 3i + 1 and bit i of _z bit 3i + 2.
+    /// Uses BMI2 at run time when the calling code is compiled for it.
+    /// \param[in] _x X coordinate, of which the low kCurveBits bits are
+    /// used.
+    /// \param[in] _y Y coordinate.
+    /// \param[in] _z Z coordinate.
+    /// \return The code, below 2^63.
+    /// \sa MortonDecode
+    constexpr uint64_t MortonEncode(const uint32_t _x, const uint32_t _y,
+                                    const uint32_t _z)
+    {
+#ifdef IGNITION_MATH_MORTON_BMI2
+      if (!__builtin_is_constant_evaluated())
+      {
+        return _pdep_u64(_x, detail::kMortonMask) |
+               _pdep_u64(_y, detail::kMortonMask << 1) |
+               _pdep_u64(_z, detail::kMortonMask << 2);
+      }
+#endif
+      return detail::MortonSpread(_x) | detail::MortonSpread(_y) << 1 |
+             detail::MortonSpread(_z) << 2;
+    }
+
+    /// \brief Decode a Morton code, the reverse of MortonEncode.
+    /// \param[in] _code The code.
+    /// \return The x, y and z coordinates of the cell.
+    /// \sa MortonEncode
+    constexpr std::tuple<uint32_t, uint32_t, uint32_t> MortonDecode(
+        const uint64_t _code)
+    {
+#ifdef IGNITION_MATH_MORTON_BMI2
+      if (!__builtin_is_constant_evaluated())
+      {
+        return std::make_tuple(
+            static_cast<uint32_t>(_pext_u64(_code, detail::kMortonMask)),
+            static_cast<uint32_t>(
+                _pext_u64(_code, detail::kMortonMask << 1)),
+            static_cast<uint32_t>(
+                _pext_u64(_code, detail::kMortonMask << 2)));
+      }
+#endif
+      return std::make_tuple(detail::MortonCompact(_code),
+                             detail::MortonCompact(_code >> 1),
+                             detail::MortonCompact(_code >> 2));
+    }
+
+    /// \brief Encode the cell of a 3D grid as its index along a Hilbert
+    /// curve over 2^kCurveBits cells per axis.
+    /// \param[in] _x X coordinate, of which the low kCurveBits bits are
+    /// used.
+    /// \param[in] _y Y coordinate.
+    /// \param[in] _z Z coordinate.
+    /// \return The index, below 2^63.
+    /// \sa HilbertDecode
+    constexpr uint64_t HilbertEncode(const uint32_t _x, const uint32_t _y,
+                                     const uint32_t _z)
+    {
+      uint32_t t[3] = {_x & 0x1fffffu, _y & 0x1fffffu, _z & 0x1fffffu};
+      detail::HilbertAxesToTranspose(t[0], t[1], t[2]);
+      // The first coordinate holds the most significant bit of each triple
+      return MortonEncode(t[2], t[1], t[0]);
+    }
+
+    /// \brief Decode an index along a Hilbert curve, the reverse of
+    /// HilbertEncode.
+    /// \param[in] _index The index.
+    /// \return The x, y and z coordinates of the cell.
+    /// \sa HilbertEncode
+    constexpr std::tuple<uint32_t, uint32_t, uint32_t> HilbertDecode(
+        const uint64_t _index)
+    {
+      const auto code = MortonDecode(_index);
+      uint32_t t[3] = {std::get<2>(code), std::get<1>(code),
+                       std::get<0>(code)};
+      detail::HilbertTransposeToAxes(t[0], t[1], t[2]);
+      return std::make_tuple(t[0], t[1], t[2]);
+    }
+
+    /// \brief Get the key of a point along a space-filling curve over a
+    /// box, split into 2^kCurveBits cells per axis. Points outside of the
+    /// box are clamped to it.
+    /// \param[in] _point The point.
+    /// \param[in] _bounds The box.
+    /// \param[in] _curve The curve.
+    /// \return The key, below 2^63.
+    /// \sa CurvePoint
+    uint64_t IGNITION_MATH_VISIBLE CurveKey(const Vector3d &_point,
+        const AxisAlignedBox &_bounds,
+        const SpaceFillingCurve _curve = SpaceFillingCurve::MORTON);
+
+    /// \brief Get the center of the cell of a key, the reverse of CurveKey
+    /// up to the size of the cells.
+    /// \param[in] _key The key.
+    /// \param[in] _bounds The box.
+    /// \param[in] _curve The curve.
+    /// \return The center of the cell.
+    /// \sa CurveKey
+    Vector3d IGNITION_MATH_VISIBLE CurvePoint(const uint64_t _key,
+        const AxisAlignedBox &_bounds,
+        const SpaceFillingCurve _curve = SpaceFillingCurve::MORTON);
+
+    /// \brief Get the keys of an array of points, as CurveKey. Points that
+    /// are not finite get the largest uint64_t key, after every other
+    /// key.
+    /// \param[in] _points The points.
+    /// \param[in] _bounds The box.
+    /// \param[in] _curve The curve.
+    /// \param[out] _keys Key of each point, resized to the number of
+    /// points.
+    /// \param[in] _threads Number of threads. A value of 0 uses the number
+    /// of hardware threads. Small arrays always use a single thread.
+    void IGNITION_MATH_VISIBLE CurveKeys(const std::vector<Vector3d> &_points,
+        const AxisAlignedBox &_bounds, const SpaceFillingCurve _curve,
+        std::vector<uint64_t> &_keys, const unsigned int _threads = 1);
+
+    /// \brief Sort keys with a stable least significant digit radix sort,
+    /// and get the permutation that sorts them. Digits shared by every key
+    /// are skipped.
+    /// \param[in,out] _keys The keys, sorted on return.
+    /// \param[out] _order Original index of each sorted key, resized to
+    /// the number of keys. Equal keys keep their original order.
+    /// \param[in] _threads Number of threads, each counting and moving a
+    /// contiguous part of the keys. A value of 0 uses the number of
+    /// hardware threads. Small arrays always use a single thread.
+    void IGNITION_MATH_VISIBLE RadixSort(std::vector<uint64_t> &_keys,
+        std::vector<std::size_t> &_order, const unsigned int _threads = 1);
+
+    /// \brief Reorder points along a space-filling curve over their
+    /// bounds, so that points close in the array are close in space, which
+    /// speeds up the neighbor searches and tree builds that follow. Points
+    /// that are not finite go last.
+    /// \param[in,out] _points The points, reordered on return.
+    /// \param[out] _order Original index of each reordered point.
+    /// \param[in] _curve The curve.
+    /// \param[in] _threads Number of threads. A value of 0 uses the number
+    /// of hardware threads.
+    void IGNITION_MATH_VISIBLE SpatialSort(std::vector<Vector3d> &_points,
+        std::vector<std::size_t> &_order,
+        const SpaceFillingCurve _curve = SpaceFillingCurve::MORTON,
+        const unsigned int _threads = 1);
+
+    /// \brief Reorder boxes along a space-filling curve through their
+    /// centers, such as before building a bounding volume hierarchy. Empty
+    /// boxes, such as default boxes, and boxes whose center is not finite
+    /// go last.
+    /// \param[in,out] _boxes The boxes, reordered on return.
+    /// \param[out] _order Original index of each reordered box.
+    /// \param[in] _curve The curve.
+    /// \param[in] _threads Number of threads. A value of 0 uses the number
+    /// of hardware threads.
+    void IGNITION_MATH_VISIBLE SpatialSort(std::vector<AxisAlignedBox> &_boxes,
+        std::vector<std::size_t> &_order,
+        const SpaceFillingCurve _curve = SpaceFillingCurve::MORTON,
+        const unsigned int _threads = 1);
+    }
+  }
+}
+#endif
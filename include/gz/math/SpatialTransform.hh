@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SPATIALTRANSFORM_HH_
+#define GZ_MATH_SPATIALTRANSFORM_HH_
+
+#include <gz/math/config.hh>
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Matrix6.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/SpatialVector.hh>
+#include <gz/math/Vector3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    /// \class SpatialTransform SpatialTransform.hh
+    /// ignition/math/SpatialTransform.hh
+    /// \brief A Plücker transform of spatial vectors from a frame A to a
+    /// frame B, stored as a rotation and a translation.
+    ///
+    /// The rotation E maps coordinates in A to coordinates in B, and the
+    /// translation r is the origin of B expressed in A. As a 6x6 matrix the
+    /// transform is [E 0; -E rx E] for motion vectors and [E -E rx; 0 E]
+    /// for force vectors, where rx is the cross product matrix of r.
+    ///
+    /// Applying the transform to a vector takes two 3x3 products and a
+    /// cross product, 24 multiplications, instead of the 36 of a Matrix6
+    /// product, and composing two transforms avoids a 6x6 matrix product.
+    /// MotionMatrix() and ForceMatrix() build the equivalent Matrix6.
+    /// \tparam T a numeric type.
+    template<typename T>
+    class SpatialTransform
+    {
+      /// \brief Default constructor. Creates the identity transform.
+      public: SpatialTransform() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _rotation Rotation from A coordinates to B coordinates.
+      /// \param[in] _translation Origin of B expressed in A.
+      public: SpatialTransform(const Matrix3<T> &_rotation,
+                               const Vector3<T> &_translation)
+      : rotation(_rotation), translation(_translation)
+      {
+      }
+
+      /// \brief Constructor from the pose of frame B in frame A, such as
+      /// the pose of a child link relative to its parent.
+      /// \param[in] _pose Pose of B in A.
+      public: explicit SpatialTransform(const Pose3<T> &_pose)
+      : rotation(Matrix3<T>(_pose.Rot()).Transposed()),
+        translation(_pose.Pos())
+      {
+      }
+
+      /// \brief Get the rotation.
+      /// \return Rotation from A coordinates to B coordinates.
+      public: const Matrix3<T> &Rotation() const
+      {
+        return this->rotation;
+      }
+
+      /// \brief Get the translation.
+      /// \return Origin of B expressed in A.
+      public: const Vector3<T> &Translation() const
+      {
+        return this->translation;
+      }
+
+      /// \brief Get the pose of frame B in frame A, the inverse of the
+      /// constructor from a Pose3.
+      /// \return Pose of B in A.
+      public: Pose3<T> Pose() const
+      {
+        return Pose3<T>(this->translation,
+                        Quaternion<T>(this->rotation.Transposed()));
+      }
+
+      /// \brief Transform a motion vector from A to B.
+      /// \param[in] _m Motion vector in A.
+      /// \return [E w; E (v - r x w)].
+      public: SpatialVector<T> ApplyMotion(const SpatialVector<T> &_m) const
+      {
+        return SpatialVector<T>(this->rotation * _m.Angular(),
+            this->rotation *
+            (_m.Linear() - this->translation.Cross(_m.Angular())));
+      }
+
+      /// \brief Transform a force vector from A to B.
+      /// \param[in] _f Force vector in A.
+      /// \return [E (n - r x f); E f].
+      public: SpatialVector<T> ApplyForce(const SpatialVector<T> &_f) const
+      {
+        return SpatialVector<T>(this->rotation *
+            (_f.Angular() - this->translation.Cross(_f.Linear())),
+            this->rotation * _f.Linear());
+      }
+
+      /// \brief Transform a motion vector from B to A, without inverting
+      /// the transform.
+      /// \param[in] _m Motion vector in B.
+      /// \return [E^T w; E^T v + r x E^T w].
+      public: SpatialVector<T> InverseApplyMotion(
+                  const SpatialVector<T> &_m) const
+      {
+        // A row vector times E is E^T times the column vector
+        const Vector3<T> w = _m.Angular() * this->rotation;
+        return SpatialVector<T>(w, _m.Linear() * this->rotation +
+            this->translation.Cross(w));
+      }
+
+      /// \brief Transform a force vector from B to A, without inverting
+      /// the transform.
+      /// \param[in] _f Force vector in B.
+      /// \return [E^T n + r x E^T f; E^T f].
+      public: SpatialVector<T> InverseApplyForce(
+                  const SpatialVector<T> &_f) const
+      {
+        const Vector3<T> f = _f.Linear() * this->rotation;
+        return SpatialVector<T>(_f.Angular() * this->rotation +
+            this->translation.Cross(f), f);
+      }
+
+      /// \brief Compose two transforms.
+      /// \param[in] _x Transform from a frame O to A.
+      /// \return Transform from O to B, this applied after _x.
+      public: SpatialTransform<T> operator*(
+                  const SpatialTransform<T> &_x) const
+      {
+        return SpatialTransform<T>(this->rotation * _x.rotation,
+            _x.translation + this->translation * _x.rotation);
+      }
+
+      /// \brief Get the inverse transform.
+      /// \return Transform from B to A.
+      public: SpatialTransform<T> Inverse() const
+      {
+        return SpatialTransform<T>(this->rotation.Transposed(),
+            -(this->rotation * this->translation));
+      }
+
+      /// \brief Get the 6x6 matrix that transforms motion vectors.
+      /// \return [E 0; -E rx E].
+      public: Matrix6<T> MotionMatrix() const
+      {
+        Matrix6<T> result;
+        result.SetSubmatrix(Matrix6<T>::TOP_LEFT, this->rotation);
+        result.SetSubmatrix(Matrix6<T>::BOTTOM_LEFT,
+            this->rotation * this->CrossMatrix() * static_cast<T>(-1));
+        result.SetSubmatrix(Matrix6<T>::BOTTOM_RIGHT, this->rotation);
+        return result;
+      }
+
+      /// \brief Get the 6x6 matrix that transforms force vectors.
+      /// \return [E -E rx; 0 E].
+      public: Matrix6<T> ForceMatrix() const
+      {
+        Matrix6<T> result;
+        result.SetSubmatrix(Matrix6<T>::TOP_LEFT, this->rotation);
+        result.SetSubmatrix(Matrix6<T>::TOP_RIGHT,
+            this->rotation * this->CrossMatrix() * static_cast<T>(-1));
+        result.SetSubmatrix(Matrix6<T>::BOTTOM_RIGHT, this->rotation);
+        return result;
+      }
+
+      /// \brief Equality test with tolerance.
+      /// \param[in] _x The transform to compare to.
+      /// \param[in] _tol Equality tolerance.
+      /// \return True if the rotations and translations are equal within
+      /// _tol.
+      public: bool Equal(const SpatialTransform<T> &_x, const T &_tol) const
+      {
+        return this->rotation.Equal(_x.rotation, _tol) &&
+               this->translation.Equal(_x.translation, _tol);
+      }
+
+      /// \brief Get the cross product matrix of the translation.
+      /// \return rx.
+      private: Matrix3<T> CrossMatrix() const
+      {
+        const Vector3<T> &r = this->translation;
+        return Matrix3<T>(0, -r.Z(), r.Y(),
+                          r.Z(), 0, -r.X(),
+                          -r.Y(), r.X(), 0);
+      }
+
+      /// \brief Rotation from A coordinates to B coordinates.
+      private: Matrix3<T> rotation = Matrix3<T>::Identity;
+
+      /// \brief Origin of B expressed in A.
+      private: Vector3<T> translation;
+    };
+
+    typedef SpatialTransform<double> SpatialTransformd;
+    typedef SpatialTransform<float> SpatialTransformf;
+    }
+  }
+}
+#endif
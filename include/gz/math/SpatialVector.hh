@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SPATIALVECTOR_HH_
+#define GZ_MATH_SPATIALVECTOR_HH_
+
+#include <iostream>
+
+#include <gz/math/config.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/Vector3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    /// \class SpatialVector SpatialVector.hh ignition/math/SpatialVector.hh
+    /// \brief A six dimensional spatial vector, made of an angular and a
+    /// linear part, in the ordering used by Matrix6 (angular on top).
+    ///
+    /// The same type holds motion vectors (twists: angular and linear
+    /// velocity) and force vectors (wrenches: moment and force). They
+    /// transform differently, so SpatialTransform and the cross products
+    /// below provide a motion and a force version of each operation.
+    /// \tparam T a numeric type.
+    template<typename T>
+    class SpatialVector
+    {
+      /// \brief Default constructor. Creates a zero vector.
+      public: SpatialVector() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _angular Angular part.
+      /// \param[in] _linear Linear part.
+      public: SpatialVector(const Vector3<T> &_angular,
+                            const Vector3<T> &_linear)
+      : angular(_angular), linear(_linear)
+      {
+      }
+
+      /// \brief Set both parts.
+      /// \param[in] _angular Angular part.
+      /// \param[in] _linear Linear part.
+      public: void Set(const Vector3<T> &_angular, const Vector3<T> &_linear)
+      {
+        this->angular = _angular;
+        this->linear = _linear;
+      }
+
+      /// \brief Get the angular part.
+      /// \return Angular velocity of a motion vector, or moment of a force
+      /// vector.
+      public: const Vector3<T> &Angular() const
+      {
+        return this->angular;
+      }
+
+      /// \brief Get a mutable reference to the angular part.
+      /// \return Angular part.
+      public: Vector3<T> &Angular()
+      {
+        return this->angular;
+      }
+
+      /// \brief Get the linear part.
+      /// \return Linear velocity of a motion vector, or force of a force
+      /// vector.
+      public: const Vector3<T> &Linear() const
+      {
+        return this->linear;
+      }
+
+      /// \brief Get a mutable reference to the linear part.
+      /// \return Linear part.
+      public: Vector3<T> &Linear()
+      {
+        return this->linear;
+      }
+
+      /// \brief Scalar product of a motion and a force vector, which is the
+      /// power delivered by the force.
+      /// \param[in] _v The other vector.
+      /// \return Sum of the products of the components.
+      public: T Dot(const SpatialVector<T> &_v) const
+      {
+        return this->angular.Dot(_v.angular) + this->linear.Dot(_v.linear);
+      }
+
+      /// \brief Spatial cross product of this motion vector with a motion
+      /// vector, as used to differentiate motion vectors in a moving frame.
+      /// \param[in] _m Motion vector.
+      /// \return [w x m_w; w x m_v + v x m_w], where w and v are the angular
+      /// and linear parts of this vector.
+      public: SpatialVector<T> CrossMotion(const SpatialVector<T> &_m) const
+      {
+        return SpatialVector<T>(this->angular.Cross(_m.angular),
+            this->angular.Cross(_m.linear) + this->linear.Cross(_m.angular));
+      }
+
+      /// \brief Spatial cross product of this motion vector with a force
+      /// vector, the dual of CrossMotion().
+      /// \param[in] _f Force vector.
+      /// \return [w x f_n + v x f_f; w x f_f], where f_n and f_f are the
+      /// moment and force of _f.
+      public: SpatialVector<T> CrossForce(const SpatialVector<T> &_f) const
+      {
+        return SpatialVector<T>(
+            this->angular.Cross(_f.angular) + this->linear.Cross(_f.linear),
+            this->angular.Cross(_f.linear));
+      }
+
+      /// \brief Addition operator.
+      /// \param[in] _v Vector to add.
+      /// \return The sum.
+      public: SpatialVector<T> operator+(const SpatialVector<T> &_v) const
+      {
+        return SpatialVector<T>(this->angular + _v.angular,
+                                this->linear + _v.linear);
+      }
+
+      /// \brief Addition assignment operator.
+      /// \param[in] _v Vector to add.
+      /// \return Reference to this vector.
+      public: SpatialVector<T> &operator+=(const SpatialVector<T> &_v)
+      {
+        this->angular += _v.angular;
+        this->linear += _v.linear;
+        return *this;
+      }
+
+      /// \brief Subtraction operator.
+      /// \param[in] _v Vector to subtract.
+      /// \return The difference.
+      public: SpatialVector<T> operator-(const SpatialVector<T> &_v) const
+      {
+        return SpatialVector<T>(this->angular - _v.angular,
+                                this->linear - _v.linear);
+      }
+
+      /// \brief Subtraction assignment operator.
+      /// \param[in] _v Vector to subtract.
+      /// \return Reference to this vector.
+      public: SpatialVector<T> &operator-=(const SpatialVector<T> &_v)
+      {
+        this->angular -= _v.angular;
+        this->linear -= _v.linear;
+        return *this;
+      }
+
+      /// \brief Negation operator.
+      /// \return The negated vector.
+      public: SpatialVector<T> operator-() const
+      {
+        return SpatialVector<T>(-this->angular, -this->linear);
+      }
+
+      /// \brief Multiplication by a scalar.
+      /// \param[in] _s Scalar.
+      /// \return The scaled vector.
+      public: SpatialVector<T> operator*(const T _s) const
+      {
+        return SpatialVector<T>(this->angular * _s, this->linear * _s);
+      }
+
+      /// \brief Multiplication of a scalar by a vector.
+      /// \param[in] _s Scalar.
+      /// \param[in] _v Vector.
+      /// \return The scaled vector.
+      public: friend inline SpatialVector<T> operator*(const T _s,
+                  const SpatialVector<T> &_v)
+      {
+        return _v * _s;
+      }
+
+      /// \brief Equality test with tolerance.
+      /// \param[in] _v The vector to compare to.
+      /// \param[in] _tol Equality tolerance.
+      /// \return True if all the components are equal within _tol.
+      public: bool Equal(const SpatialVector<T> &_v, const T &_tol) const
+      {
+        return this->angular.Equal(_v.angular, _tol) &&
+               this->linear.Equal(_v.linear, _tol);
+      }
+
+      /// \brief Equality operator, using a tolerance of 1e-6.
+      /// \param[in] _v The vector to compare to.
+      /// \return True if the vectors are equal.
+      public: bool operator==(const SpatialVector<T> &_v) const
+      {
+        return this->Equal(_v, static_cast<T>(1e-6));
+      }
+
+      /// \brief Inequality operator, using a tolerance of 1e-6.
+      /// \param[in] _v The vector to compare to.
+      /// \return True if the vectors are not equal.
+      public: bool operator!=(const SpatialVector<T> &_v) const
+      {
+        return !(*this == _v);
+      }
+
+      /// \brief Stream insertion operator. Writes the angular part followed
+      /// by the linear part.
+      /// \param[in] _out Output stream.
+      /// \param[in] _v Vector to output.
+      /// \return The stream.
+      public: friend std::ostream &operator<<(std::ostream &_out,
+                  const SpatialVector<T> &_v)
+      {
+        _out << _v.angular << " " << _v.linear;
+        return _out;
+      }
+
+      /// \brief Angular part.
+      private: Vector3<T> angular;
+
+      /// \brief Linear part.
+      private: Vector3<T> linear;
+    };
+
+    typedef SpatialVector<double> SpatialVectord;
+    typedef SpatialVector<float> SpatialVectorf;
+    }
+  }
+}
+#endif
@@ -33,6 +33,9 @@ inline namespace IGNITION_MATH_VERSION_NAMESPACE {
   class SpeedLimiterPrivate;
 
   /// \brief Class to limit velocity, acceleration and jerk.
+  ///
+  /// The setters, getters and Limit functions are real-time safe: they
+  /// never allocate memory. Only the constructor allocates.
   class IGNITION_MATH_VISIBLE SpeedLimiter
   {
     /// \brief Constructor.
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SPEEDLIMITERBANK_HH_
+#define GZ_MATH_SPEEDLIMITERBANK_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gz/math/SpeedLimiter.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declarations.
+    class SpeedLimiterBankPrivate;
+
+    /// \class SpeedLimiterBank SpeedLimiterBank.hh
+    /// ignition/math/SpeedLimiterBank.hh
+    /// \brief Velocity, acceleration and jerk limits for a set of axes
+    /// whose commands are limited together, such as the wheels of a fleet
+    /// of vehicles.
+    ///
+    /// Each axis has its own limits and follows the same equations as
+    /// SpeedLimiter::Limit. Unlike SpeedLimiter, the bank keeps the last
+    /// two limited velocities of every axis, so a single call per time
+    /// step limits all of them. The limits and history are stored as
+    /// arrays, one per quantity, and are updated in one pass without
+    /// per-axis calls.
+    class IGNITION_MATH_VISIBLE SpeedLimiterBank
+    {
+      /// \brief Default constructor. Creates an empty bank.
+      public: SpeedLimiterBank();
+
+      /// \brief Create a bank of axes with the same limits.
+      /// \param[in] _size Number of axes.
+      /// \param[in] _limiter Limiter whose limits are copied to every axis.
+      public: SpeedLimiterBank(const std::size_t _size,
+                               const SpeedLimiter &_limiter);
+
+      /// \brief Copy constructor.
+      /// \param[in] _bank Bank to copy.
+      public: SpeedLimiterBank(const SpeedLimiterBank &_bank);
+
+      /// \brief Destructor.
+      public: ~SpeedLimiterBank();
+
+      /// \brief Assignment operator.
+      /// \param[in] _bank Bank to copy.
+      /// \return Reference to this bank.
+      public: SpeedLimiterBank &operator=(const SpeedLimiterBank &_bank);
+
+      /// \brief Change the number of axes. Existing axes are kept, and new
+      /// axes get the limits of _limiter and a zero history.
+      /// \param[in] _size Number of axes.
+      /// \param[in] _limiter Limiter whose limits are copied to the new
+      /// axes.
+      public: void Resize(const std::size_t _size,
+                          const SpeedLimiter &_limiter = SpeedLimiter());
+
+      /// \brief Append an axis with a zero history.
+      /// \param[in] _limiter Limiter whose limits are copied.
+      /// \return Index of the new axis.
+      public: std::size_t Add(const SpeedLimiter &_limiter);
+
+      /// \brief Get the number of axes.
+      /// \return Number of axes.
+      public: std::size_t Size() const;
+
+      /// \brief Set the limits of an axis. Its history is kept.
+      /// \param[in] _index Index of the axis.
+      /// \param[in] _limiter Limiter whose limits are copied.
+      /// \return False if _index is out of range.
+      public: bool Set(const std::size_t _index,
+                       const SpeedLimiter &_limiter);
+
+      /// \brief Get the limits of an axis.
+      /// \param[in] _index Index of the axis.
+      /// \param[out] _limiter Set to the limits of the axis.
+      /// \return False if _index is out of range, in which case _limiter is
+      /// unchanged.
+      public: bool Limiter(const std::size_t _index,
+                           SpeedLimiter &_limiter) const;
+
+      /// \brief Set the velocity history of an axis, for example when it
+      /// starts from a known velocity.
+      /// \param[in] _index Index of the axis.
+      /// \param[in] _prevVel Velocity of the last time step.
+      /// \param[in] _prevPrevVel Velocity of the time step before.
+      /// \return False if _index is out of range.
+      public: bool SetHistory(const std::size_t _index, const double _prevVel,
+                              const double _prevPrevVel);
+
+      /// \brief Get the velocity history of an axis.
+      /// \param[in] _index Index of the axis.
+      /// \param[out] _prevVel Velocity of the last time step.
+      /// \param[out] _prevPrevVel Velocity of the time step before.
+      /// \return False if _index is out of range.
+      public: bool History(const std::size_t _index, double &_prevVel,
+                           double &_prevPrevVel) const;
+
+      /// \brief Set the velocity history of every axis to zero.
+      public: void Reset();
+
+      /// \brief Limit the velocity, acceleration and jerk of every axis, as
+      /// SpeedLimiter::Limit does for one axis with the stored history,
+      /// and then push the limited velocities to the history.
+      ///
+      /// As in SpeedLimiter, the acceleration and jerk limits are skipped
+      /// when _dt is zero. Only the velocity limits are applied then, and
+      /// the history does not change.
+      /// \param[in, out] _vels Velocity of each axis to limit [m/s].
+      /// \param[in] _dt Time step.
+      /// \return False if _vels does not have Size() elements, in which
+      /// case nothing changes.
+      public: bool Limit(std::vector<double> &_vels,
+                         const std::chrono::steady_clock::duration _dt);
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SpeedLimiterBankPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
@@ -17,8 +17,11 @@
 #ifndef GZ_MATH_SPHERE_HH_
 #define GZ_MATH_SPHERE_HH_
 
+#include <cstddef>
+#include <tuple>
 #include "gz/math/MassMatrix3.hh"
 #include "gz/math/Material.hh"
+#include "gz/math/Pose3.hh"
 #include "gz/math/Quaternion.hh"
 #include "gz/math/Plane.hh"
 
@@ -109,6 +112,30 @@ namespace ignition
       public: std::optional<Vector3<Precision>>
         CenterOfVolumeBelow(const Plane<Precision> &_plane) const;
 
+      /// \brief Compute the volume below a plane and its center for many
+      /// spheres, such as the submerged volume and center of buoyancy of
+      /// floating bodies below a water plane. Each result is the same as
+      /// VolumeBelow and CenterOfVolumeBelow of the corresponding sphere,
+      /// with the plane expressed in the frame of the sphere.
+      /// \param[in] _radii Array of _count sphere radii.
+      /// \param[in] _positions Array of _count sphere centers, in the frame
+      /// of _plane.
+      /// \param[in] _count Number of spheres.
+      /// \param[in] _plane The plane which cuts every sphere. Its normal
+      /// does not need to be normalized.
+      /// \param[out] _volumes Array of at least _count values, written with
+      /// the volume below the plane of each sphere in m^3.
+      /// \param[out] _centers Array of at least _count vectors, written with
+      /// the center of the volume below the plane of each sphere, in the
+      /// frame of _plane. This is the center of the sphere if no part of it
+      /// is below the plane.
+      public: static void VolumesBelow(const Precision *_radii,
+                                       const Vector3<Precision> *_positions,
+                                       const std::size_t _count,
+                                       const Plane<Precision> &_plane,
+                                       Precision *_volumes,
+                                       Vector3<Precision> *_centers);
+
       /// \brief Compute the sphere's density given a mass value. The
       /// sphere is assumed to be solid with uniform density. This
       /// function requires the sphere's radius to be set to a
@@ -133,6 +160,97 @@ namespace ignition
       /// \sa Precision DensityFromMass(const Precision _mass) const
       public: bool SetDensityFromMass(const Precision _mass);
 
+      /// \brief Compute the volumes of many spheres. Each result is the
+      /// same as Volume() of a sphere with the corresponding radius.
+      /// \param[in] _radii Array of _count sphere radii.
+      /// \param[in] _count Number of spheres.
+      /// \param[out] _volumes Array of at least _count values, written with
+      /// the volume of each sphere in m^3.
+      public: static void Volumes(const Precision *_radii,
+                                  const std::size_t _count,
+                                  Precision *_volumes);
+
+      /// \brief Compute the densities of many spheres from their masses.
+      /// Each result is the same as DensityFromMass of a sphere with the
+      /// corresponding radius.
+      /// \param[in] _radii Array of _count sphere radii.
+      /// \param[in] _masses Array of _count masses, in kg.
+      /// \param[in] _count Number of spheres.
+      /// \param[out] _densities Array of at least _count values, written
+      /// with the density of each sphere in kg/m^3, or a negative value if
+      /// the radius or mass is <= 0.
+      public: static void DensitiesFromMasses(const Precision *_radii,
+                                              const Precision *_masses,
+                                              const std::size_t _count,
+                                              Precision *_densities);
+
+      /// \brief Compute the mass matrices of many spheres of uniform
+      /// density. Each result is the same as MassMatrix of a sphere with the
+      /// corresponding radius and density, without constructing a Material.
+      /// \param[in] _radii Array of _count sphere radii.
+      /// \param[in] _densities Array of _count densities, in kg/m^3.
+      /// \param[in] _count Number of spheres.
+      /// \param[out] _massMats Array of at least _count mass matrices.
+      /// Spheres with a radius or density <= 0 are written with a default
+      /// constructed mass matrix, which has zero mass.
+      /// \return True if the mass matrix of every sphere was computed.
+      public: static bool MassMatrices(const Precision *_radii,
+                                       const Precision *_densities,
+                                       const std::size_t _count,
+                                       MassMatrix3<Precision> *_massMats);
+
+      /// \brief Check if a ray (origin, direction) hits the surface of the
+      /// sphere.
+      /// \param[in] _pose Pose of the center of the sphere, in the frame of
+      /// the ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return A boolean and Precision tuple. The boolean value is true if
+      /// the ray hits the surface between the distances _min and _max from
+      /// _origin; rays starting inside hit it where they leave. The
+      /// Precision is the distance from _origin to the hit minus _min, as
+      /// in AxisAlignedBox::IntersectDist, or zero when the boolean value
+      /// is false.
+      public: std::tuple<bool, Precision> IntersectDist(
+                  const Pose3<Precision> &_pose,
+                  const Vector3<Precision> &_origin,
+                  const Vector3<Precision> &_dir,
+                  const Precision _min, const Precision _max) const;
+
+      /// \brief Intersect a bundle of rays from the same origin, such as
+      /// the beams of a range sensor, with the sphere. Calling it for every
+      /// shape of a scene with the same ranges leaves the distance of the
+      /// closest hit of each ray.
+      /// \param[in] _pose Pose of the center of the sphere, in the frame of
+      /// the rays.
+      /// \param[in] _origin Origin of the rays.
+      /// \param[in] _dirs Array of _count unit ray directions.
+      /// \param[in] _count Number of rays.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in, out] _ranges Array of _count distances. Each one is the
+      /// maximum allowed distance of its ray, and is lowered to the
+      /// distance from _origin to the hit of the ray if there is one.
+      /// \return Number of lowered ranges.
+      public: std::size_t IntersectRays(const Pose3<Precision> &_pose,
+                                        const Vector3<Precision> &_origin,
+                                        const Vector3<Precision> *_dirs,
+                                        const std::size_t _count,
+                                        const Precision _min,
+                                        Precision *_ranges) const;
+
+      /// \brief Find where a ray is inside of the sphere.
+      /// \param[in] _origin Origin of the ray, in the frame of the sphere.
+      /// \param[in] _dir Unit direction of the ray, in the frame of the
+      /// sphere.
+      /// \param[out] _tin Distance where the ray enters the sphere.
+      /// \param[out] _tout Distance where the ray leaves the sphere.
+      /// \return False if the line through the ray misses the sphere.
+      private: bool RayInterval(const Vector3<Precision> &_origin,
+                                const Vector3<Precision> &_dir,
+                                Precision &_tin, Precision &_tout) const;
+
       /// \brief Radius of the sphere.
       private: Precision radius = 0.0;
 
@@ -17,11 +17,14 @@
 #ifndef GZ_MATH_SPHERICALCOORDINATES_HH_
 #define GZ_MATH_SPHERICALCOORDINATES_HH_
 
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <gz/math/Angle.hh>
 #include <gz/math/Vector3.hh>
+#include <gz/math/Vector3SoA.hh>
 #include <gz/math/Helpers.hh>
 #include <gz/math/config.hh>
 
@@ -68,6 +71,23 @@ namespace ignition
                 LOCAL2 = 5
               };
 
+      /// \enum AccuracyType
+      /// \brief Accuracy of the position conversions to and from
+      /// SPHERICAL coordinates.
+      public: enum AccuracyType
+              {
+                /// \brief Conversions at full double precision.
+                PRECISE = 1,
+
+                /// \brief Faster conversions. Positions within a few
+                /// kilometers of the reference use a cached second order
+                /// expansion of the conversion around the reference, with an
+                /// error below 1 millimeter, and the others use a cheaper
+                /// evaluation of the same closed form solution as PRECISE.
+                /// The expansions are disabled near the poles.
+                FAST = 2
+              };
+
       /// \brief Constructor.
       public: SphericalCoordinates();
 
@@ -149,6 +169,43 @@ namespace ignition
                                      const gz::math::Angle &_latB,
                                      const gz::math::Angle &_lonB);
 
+      /// \brief Get the distances from one point to many points, with the
+      /// same formula as the single pair Distance. The trigonometric
+      /// functions are evaluated once per point rather than once per pair.
+      /// \param[in] _latA Latitude of point A.
+      /// \param[in] _lonA Longitude of point A.
+      /// \param[in] _latB Latitudes of the other points in radians.
+      /// \param[in] _lonB Longitudes of the other points in radians. It must
+      /// have the same size as _latB.
+      /// \param[out] _distances Distance in meters from point A to each of
+      /// the other points. It is resized to the number of points.
+      /// \return False if _latB and _lonB have different sizes.
+      public: static bool Distance(const gz::math::Angle &_latA,
+                                   const gz::math::Angle &_lonA,
+                                   const std::vector<double> &_latB,
+                                   const std::vector<double> &_lonB,
+                                   std::vector<double> &_distances);
+
+      /// \brief Get the distance matrix between two sets of points, with
+      /// the same formula as the single pair Distance.
+      /// \param[in] _latA Latitudes of the first points in radians.
+      /// \param[in] _lonA Longitudes of the first points in radians. It must
+      /// have the same size as _latA.
+      /// \param[in] _latB Latitudes of the second points in radians.
+      /// \param[in] _lonB Longitudes of the second points in radians. It
+      /// must have the same size as _latB.
+      /// \param[out] _distances Distances in meters, in row major order:
+      /// the distance from the i-th first point to the j-th second point is
+      /// at index i * _latB.size() + j. It is resized to the number of
+      /// pairs.
+      /// \return False if the latitudes and longitudes of a set of points
+      /// have different sizes.
+      public: static bool Distance(const std::vector<double> &_latA,
+                                   const std::vector<double> &_lonA,
+                                   const std::vector<double> &_latB,
+                                   const std::vector<double> &_lonB,
+                                   std::vector<double> &_distances);
+
       /// \brief Get SurfaceType currently in use.
       /// \return Current SurfaceType value.
       public: SurfaceType Surface() const;
@@ -191,6 +248,34 @@ namespace ignition
       /// \param[in] _angle Heading offset for the frame.
       public: void SetHeadingOffset(const gz::math::Angle &_angle);
 
+      /// \brief Set the whole reference origin at once. Like the setters
+      /// of each part, this only records the origin: the transformation
+      /// matrices and the expansions of the FAST accuracy are computed once,
+      /// by the next conversion.
+      /// \param[in] _latitude Reference geodetic latitude.
+      /// \param[in] _longitude Reference longitude.
+      /// \param[in] _elevation Reference elevation above sea level in
+      /// meters.
+      /// \param[in] _heading Heading offset for the frame.
+      public: void SetOrigin(const gz::math::Angle &_latitude,
+                             const gz::math::Angle &_longitude,
+                             const double _elevation,
+                             const gz::math::Angle &_heading);
+
+      /// \brief Set the number of recently used origins whose
+      /// transformations are kept, so that switching back to one of them,
+      /// such as when a vehicle moves between map tiles, doesn't compute
+      /// them again. The cache is disabled by default. Each origin takes
+      /// about 700 bytes.
+      /// \param[in] _size Maximum number of origins, 0 to disable the
+      /// cache.
+      public: void SetOriginCacheSize(const std::size_t _size);
+
+      /// \brief Get the number of recently used origins whose
+      /// transformations are kept.
+      /// \return Maximum number of origins, 0 if the cache is disabled.
+      public: std::size_t OriginCacheSize() const;
+
       /// \brief Convert a geodetic position vector to Cartesian coordinates.
       /// This performs a `PositionTransform` from SPHERICAL to LOCAL.
       /// \param[in] _latLonEle Geodetic position in the planetary frame of
@@ -207,9 +292,19 @@ namespace ignition
       public: gz::math::Vector3d LocalFromGlobalVelocity(
                   const gz::math::Vector3d &_xyz) const;
 
-      /// \brief Update coordinate transformation matrix with reference location
+      /// \brief Update coordinate transformation matrix with reference
+      /// location now, rather than on the next conversion.
       public: void UpdateTransformationMatrix();
 
+      /// \brief Set the accuracy of the position conversions. The default
+      /// is PRECISE.
+      /// \param[in] _accuracy AccuracyType specification.
+      public: void SetAccuracy(const AccuracyType &_accuracy);
+
+      /// \brief Get the accuracy of the position conversions.
+      /// \return AccuracyType specification.
+      public: AccuracyType Accuracy() const;
+
       /// \brief Convert between positions in SPHERICAL/ECEF/LOCAL/GLOBAL frame
       /// Spherical coordinates use radians, while the other frames use meters.
       /// \param[in] _pos Position vector in frame defined by parameter _in
@@ -220,6 +315,38 @@ namespace ignition
               PositionTransform(const gz::math::Vector3d &_pos,
                   const CoordinateType &_in, const CoordinateType &_out) const;
 
+      /// \brief Convert a batch of positions between SPHERICAL/ECEF/LOCAL/
+      /// GLOBAL frames. Each result is the same as the one computed by the
+      /// single position PositionTransform, but the positions are processed
+      /// in chunks with the cached transformation matrices, which is much
+      /// faster for large point sets.
+      /// \param[in] _pos Positions in frame defined by parameter _in
+      /// \param[in] _in  CoordinateType for input
+      /// \param[in] _out CoordinateType for output
+      /// \param[out] _result Transformed positions, resized to the size of
+      /// _pos. It may be the same vector as _pos.
+      /// \return False if _in or _out is not a valid coordinate type, in
+      /// which case _result is a copy of _pos.
+      public: bool PositionTransform(
+                  const std::vector<gz::math::Vector3d> &_pos,
+                  const CoordinateType &_in, const CoordinateType &_out,
+                  std::vector<gz::math::Vector3d> &_result) const;
+
+      /// \brief Convert a batch of positions stored as a structure of arrays
+      /// between SPHERICAL/ECEF/LOCAL/GLOBAL frames. This avoids the
+      /// conversion to and from the array of structures layout.
+      /// \param[in] _pos Positions in frame defined by parameter _in
+      /// \param[in] _in  CoordinateType for input
+      /// \param[in] _out CoordinateType for output
+      /// \param[out] _result Transformed positions, resized to the size of
+      /// _pos. It may be the same object as _pos.
+      /// \return False if _in or _out is not a valid coordinate type, in
+      /// which case _result is a copy of _pos.
+      public: bool PositionTransform(
+                  const gz::math::Vector3SoA<double> &_pos,
+                  const CoordinateType &_in, const CoordinateType &_out,
+                  gz::math::Vector3SoA<double> &_result) const;
+
       /// \brief Convert between velocity in SPHERICAL/ECEF/LOCAL/GLOBAL frame
       /// Spherical coordinates use radians, while the other frames use meters.
       /// \param[in] _vel Velocity vector in frame defined by parameter _in
@@ -230,6 +357,59 @@ namespace ignition
                   const gz::math::Vector3d &_vel,
                   const CoordinateType &_in, const CoordinateType &_out) const;
 
+      /// \brief Convert a batch of velocities between ECEF/LOCAL/GLOBAL
+      /// frames. The pair of frames is resolved to a single rotation matrix
+      /// per batch, which is then applied to every velocity, so each result
+      /// matches the one of the single velocity VelocityTransform up to
+      /// rounding. As there, velocities in SPHERICAL coordinates are
+      /// returned unchanged.
+      /// \param[in] _vel Velocities in frame defined by parameter _in
+      /// \param[in] _in  CoordinateType for input
+      /// \param[in] _out CoordinateType for output
+      /// \param[out] _result Transformed velocities, resized to the size of
+      /// _vel. It may be the same vector as _vel.
+      /// \return False if _in or _out is not a valid coordinate type, in
+      /// which case _result is a copy of _vel.
+      public: bool VelocityTransform(
+                  const std::vector<gz::math::Vector3d> &_vel,
+                  const CoordinateType &_in, const CoordinateType &_out,
+                  std::vector<gz::math::Vector3d> &_result) const;
+
+      /// \brief Convert a batch of velocities stored as a structure of
+      /// arrays between ECEF/LOCAL/GLOBAL frames, as the batch
+      /// VelocityTransform above.
+      /// \param[in] _vel Velocities in frame defined by parameter _in
+      /// \param[in] _in  CoordinateType for input
+      /// \param[in] _out CoordinateType for output
+      /// \param[out] _result Transformed velocities, resized to the size of
+      /// _vel. It may be the same object as _vel.
+      /// \return False if _in or _out is not a valid coordinate type, in
+      /// which case _result is a copy of _vel.
+      public: bool VelocityTransform(
+                  const gz::math::Vector3SoA<double> &_vel,
+                  const CoordinateType &_in, const CoordinateType &_out,
+                  gz::math::Vector3SoA<double> &_result) const;
+
+      /// \brief Convert vectors between the East-North-Up axes of the
+      /// GLOBAL frame and North-East-Down axes, as used by many IMU and DVL
+      /// drivers. The conversion swaps the first two components and negates
+      /// the third, so it is its own inverse and converts either way.
+      /// \param[in] _vec Vectors to convert.
+      /// \param[out] _result Converted vectors, resized to the size of
+      /// _vec. It may be the same vector as _vec.
+      public: static void ConvertEnuNed(
+                  const std::vector<gz::math::Vector3d> &_vec,
+                  std::vector<gz::math::Vector3d> &_result);
+
+      /// \brief Convert vectors stored as a structure of arrays between
+      /// East-North-Up and North-East-Down axes, see ConvertEnuNed above.
+      /// \param[in] _vec Vectors to convert.
+      /// \param[out] _result Converted vectors, resized to the size of
+      /// _vec. It may be the same object as _vec.
+      public: static void ConvertEnuNed(
+                  const gz::math::Vector3SoA<double> &_vec,
+                  gz::math::Vector3SoA<double> &_result);
+
       /// \brief Equality operator, result = this == _sc
       /// \param[in] _sc Spherical coordinates to check for equality
       /// \return true if this == _sc
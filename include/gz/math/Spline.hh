@@ -19,6 +19,8 @@
 #ifndef GZ_MATH_SPLINE_HH_
 #define GZ_MATH_SPLINE_HH_
 
+#include <memory_resource>
+
 #include <gz/math/Helpers.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/config.hh>
@@ -36,14 +38,48 @@ namespace ignition
 
     /// \class Spline Spline.hh ignition/math/Spline.hh
     /// \brief Splines
+    ///
+    /// Copies of a spline share its control points, segments and arc
+    /// length table until one of them changes, so copying a spline or
+    /// storing it in a std::vector is cheap.
     class IGNITION_MATH_VISIBLE Spline
     {
       /// \brief constructor
       public: Spline();
 
+      /// \brief Constructor. The control points, segments and arc length
+      /// tables are allocated from a memory resource, such as a
+      /// std::pmr::monotonic_buffer_resource, so that adding points to the
+      /// spline and evaluating it never calls the global allocator.
+      /// \param[in] _resource Memory resource, which must outlive the
+      /// spline.
+      public: explicit Spline(std::pmr::memory_resource *_resource);
+
+      /// \brief Copy constructor. The data is shared with _other until
+      /// either spline changes.
+      /// \param[in] _other Spline to copy.
+      public: Spline(const Spline &_other);
+
+      /// \brief Move constructor. The moved from spline can only be
+      /// assigned to or destroyed.
+      /// \param[in] _other Spline to move.
+      public: Spline(Spline &&_other) noexcept;
+
       /// \brief destructor
       public: ~Spline();
 
+      /// \brief Copy assignment operator. The data is shared with _other
+      /// until either spline changes.
+      /// \param[in] _other Spline to copy.
+      /// \return Reference to this spline.
+      public: Spline &operator=(const Spline &_other);
+
+      /// \brief Move assignment operator, which swaps the data of the
+      /// splines.
+      /// \param[in] _other Spline to move.
+      /// \return Reference to this spline.
+      public: Spline &operator=(Spline &&_other) noexcept;
+
       /// \brief Sets the tension parameter.
       /// \remarks A value of 0 results in a Catmull-Rom
       /// spline.
@@ -72,6 +108,65 @@ namespace ignition
       public: double ArcLength(const unsigned int _index,
                                const double _t) const;
 
+      /// \brief Sets the resolution of the arc length table used by
+      /// InterpolateByDistance() and ParameterAtDistance().
+      /// \remarks The table holds the arc length at uniformly spaced
+      /// parameter values of every segment. It is built on the first
+      /// distance query after the spline changes, and the parameter values
+      /// between samples are interpolated linearly, so a higher resolution
+      /// is more accurate for segments whose speed varies. The default is
+      /// 16 samples per segment.
+      /// \param[in] _samples Number of samples per segment, at least 1.
+      public: void ArcLengthResolution(const unsigned int _samples);
+
+      /// \brief Gets the resolution of the arc length table.
+      /// \return Number of samples per segment.
+      public: unsigned int ArcLengthResolution() const;
+
+      /// \brief Gets the parameter value at which the arc length from the
+      /// start of the spline is a given distance, such that
+      /// Interpolate(ParameterAtDistance(_s)) is at distance \p _s along
+      /// the spline. It looks up the arc length table in logarithmic time.
+      /// \param[in] _s distance along the spline (range 0 to ArcLength()).
+      /// \return the parameter value (range 0 to 1), or INF on error.
+      public: double ParameterAtDistance(const double _s) const;
+
+      /// \brief Interpolates a point on the spline at a distance from its
+      /// start, which moves at constant speed along the spline as the
+      /// distance increases. See ParameterAtDistance().
+      /// \param[in] _s distance along the spline (range 0 to ArcLength()).
+      /// \return the interpolated point, or [INF, INF, INF] on error. Use
+      /// Vector3d::IsFinite() to check for an error.
+      public: Vector3d InterpolateByDistance(const double _s) const;
+
+      /// \brief Projects a point on the spline, finding the parameter
+      /// value of the closest point of the spline to it, such that
+      /// Interpolate(ClosestParameter(_point)) is that closest point.
+      /// \remarks Segments are skipped when their bounding box, or the box
+      /// of their block of 16 segments, is farther than the closest point
+      /// found so far, and the closest point of a segment is found among
+      /// the roots of the derivative of its squared distance. The boxes are built on the first projection
+      /// after the spline changes.
+      /// \param[in] _point point to project.
+      /// \return the parameter value (range 0 to 1), or INF on error.
+      public: double ClosestParameter(const Vector3d &_point) const;
+
+      /// \brief Projects a point on the part of the spline near a
+      /// previous projection, to track the progress of a point moving
+      /// along the spline. Only the segments within a distance along the
+      /// spline of the previous parameter value are searched, which
+      /// wraps around the ends of closed splines.
+      /// \param[in] _point point to project.
+      /// \param[in] _previous parameter value of the previous projection
+      /// (range 0 to 1).
+      /// \param[in] _window distance along the spline from _previous,
+      /// ahead and behind, that is searched.
+      /// \return the parameter value (range 0 to 1) of the closest point
+      /// in the window, or INF on error.
+      public: double ClosestParameter(const Vector3d &_point,
+                                      const double _previous,
+                                      const double _window) const;
+
       /// \brief Adds a single control point to the
       /// end of the spline.
       /// \param[in] _p control point value to add.
@@ -172,6 +267,23 @@ namespace ignition
       public: Vector3d Interpolate(const unsigned int _fromIndex,
                                    const double _t) const;
 
+      /// \brief Interpolates points on the spline at many parameter
+      /// values at once. Each point is the same as the one returned by
+      /// Interpolate(const double) for the same parameter value.
+      /// \remarks Parameter values sorted in ascending order are mapped to
+      /// their segments by walking the segments forward once, instead of
+      /// searching them for every value. Unsorted values are supported but
+      /// restart the walk each time the parameter value decreases.
+      /// \param[in] _t Array of _count parameter values (range 0 to 1).
+      /// \param[in] _count Number of parameter values.
+      /// \param[out] _points Array of at least _count points, written with
+      /// the interpolated points, or [INF, INF, INF] for the values that
+      /// are out of range. No memory is allocated.
+      /// \return False if the spline has no points, in which case every
+      /// point is [INF, INF, INF].
+      public: bool Interpolate(const double *_t, const size_t _count,
+                               Vector3d *_points) const;
+
       /// \brief Interpolates a tangent on the spline at
       /// parameter value \p _t.
       /// \remarks Parameter value is normalized over the
@@ -232,6 +344,11 @@ namespace ignition
       /// \param[in] _autoCalc If true, tangents are calculated for you whenever
       ///        a point changes. If false, you must call RecalcTangents to
       ///        recalculate them when it best suits.
+      /// \remarks When a point is added or updated with automatic
+      ///          calculation enabled, only the tangents and segments around
+      ///          it are recalculated, along with the end tangents of a
+      ///          closed spline. All the tangents are recalculated instead
+      ///          if points or the tension changed while it was disabled.
       public: void AutoCalculate(bool _autoCalc);
 
       /// \brief Recalculates the tangents associated with this spline.
@@ -240,6 +357,22 @@ namespace ignition
       ///          after completing your updates to the spline points.
       public: void RecalcTangents();
 
+      /// \brief Builds now the tables that const queries otherwise build
+      /// on first use after a change: the arc length table of
+      /// ParameterAtDistance and InterpolateByDistance, and the bounds of
+      /// ClosestParameter. The segment coefficients are always rebuilt
+      /// when points change.
+      /// \remarks Call this once the spline is set up, to keep the build
+      ///          cost out of the first query. Until the next change, const
+      ///          queries only read the spline, so any number of threads can
+      ///          share it, or copies of it, without locking.
+      public: void Finalize();
+
+      /// \brief Gets whether no table remains to be built, because
+      ///        Finalize or a query built them since the last change.
+      /// \return True if const queries build nothing.
+      public: bool Finalized() const;
+
       /// \brief Rebuilds spline segments.
       private: void Rebuild();
 
@@ -256,6 +389,18 @@ namespace ignition
                                  unsigned int &_index,
                                  double &_fraction) const;
 
+      /// \internal
+      /// \brief Maps a distance \p _s along the spline to the right
+      /// segment (starting at point \p _index) with the parameter value
+      /// fraction \p _fraction at which the arc length reaches \p _s.
+      /// \param[in] _s distance along the spline (range 0 to ArcLength()).
+      /// \param[out] _index point index at which the segment starts.
+      /// \param[out] _fraction parameter value fraction for the given segment.
+      /// \return True on success.
+      private: bool MapDistanceToSegment(const double _s,
+                                         unsigned int &_index,
+                                         double &_fraction) const;
+
       /// \internal
       /// \brief Private data pointer
       private: SplinePrivate *dataPtr;
@@ -45,6 +45,9 @@ namespace ignition
     /// accumulation after Start() has been called followed by Stop(). The
     /// stopwatch can be reset with the Reset() function.
     ///
+    /// See BasicStopwatch for a header-only variant with a choice of
+    /// clock, such as TscClock, for fine-grained timing.
+    ///
     /// # Example usage
     ///
     /// ```{.cpp}
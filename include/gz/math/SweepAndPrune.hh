@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SWEEPANDPRUNE_HH_
+#define GZ_MATH_SWEEPANDPRUNE_HH_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  // Forward declaration.
+  class SweepAndPrunePrivate;
+
+  /// \class SweepAndPrune SweepAndPrune.hh ignition/math/SweepAndPrune.hh
+  /// \brief A sort and sweep broadphase over moving axis aligned boxes,
+  /// which finds the pairs of boxes that overlap.
+  ///
+  /// The boxes are kept in one list per axis, sorted by their minimum on
+  /// that axis. Each search sweeps the list of the axis along which the
+  /// centers of the boxes spread the most. The list is first sorted again
+  /// by insertion sort, which only does a few swaps when the boxes moved
+  /// little since the last search, so scenes that change slowly, like
+  /// stacks of resting objects, cost about linear time per step. The sweep
+  /// can be split between several threads.
+  ///
+  /// Boxes are referred to by the id returned by Insert(). Ids stay valid
+  /// until the box is removed, and the ids of removed boxes are reused.
+  /// DynamicAabbTree does better when boxes move far between searches, or
+  /// to query single boxes.
+  class IGNITION_MATH_VISIBLE SweepAndPrune
+  {
+    /// \brief Id returned when a box can't be inserted.
+    public: static constexpr std::size_t kNull =
+      std::numeric_limits<std::size_t>::max();
+
+    /// \brief Default constructor. Creates an empty broadphase.
+    public: SweepAndPrune();
+
+    /// \brief Copy constructor.
+    /// \param[in] _sap Broadphase to copy.
+    public: SweepAndPrune(const SweepAndPrune &_sap);
+
+    /// \brief Destructor.
+    public: ~SweepAndPrune();
+
+    /// \brief Assignment operator.
+    /// \param[in] _sap Broadphase to copy.
+    /// \return Reference to this broadphase.
+    public: SweepAndPrune &operator=(const SweepAndPrune &_sap);
+
+    /// \brief Insert a box.
+    /// \param[in] _box Box to insert, finite with a minimum corner not
+    /// greater than its maximum corner.
+    /// \return Id of the box, or kNull if the box is empty or not finite.
+    public: std::size_t Insert(const AxisAlignedBox &_box);
+
+    /// \brief Remove a box. It takes time linear in the number of boxes.
+    /// \param[in] _id Id of the box.
+    /// \return True if the box was removed, false if _id is not the id of
+    /// a box.
+    public: bool Remove(const std::size_t _id);
+
+    /// \brief Set the box of an id, usually once per step. The lists are
+    /// sorted again by the next call to OverlappingPairs().
+    /// \param[in] _id Id of the box.
+    /// \param[in] _box New box, finite with a minimum corner not greater
+    /// than its maximum corner.
+    /// \return True if the box was set, false if _id or _box is invalid.
+    public: bool SetBox(const std::size_t _id, const AxisAlignedBox &_box);
+
+    /// \brief Remove all the boxes.
+    public: void Clear();
+
+    /// \brief Check if an id refers to a box.
+    /// \param[in] _id Id to check.
+    /// \return True if _id is the id of a box.
+    public: bool Contains(const std::size_t _id) const;
+
+    /// \brief Get the box of an id.
+    /// \param[in] _id Id of the box.
+    /// \return The box, or a default box if _id is invalid.
+    public: AxisAlignedBox Box(const std::size_t _id) const;
+
+    /// \brief Get the number of boxes.
+    /// \return Number of boxes.
+    public: std::size_t Size() const;
+
+    /// \brief Get the axis swept by the last call to OverlappingPairs().
+    /// \return 0, 1 or 2 for the X, Y or Z axis.
+    public: int SweepAxis() const;
+
+    /// \brief Find all the pairs of boxes that intersect, using the same
+    /// test as AxisAlignedBox::Intersects.
+    /// \param[out] _pairs Pairs of ids, with the lower id first and each
+    /// pair reported once. The vector is cleared first, and keeps its
+    /// capacity.
+    public: void OverlappingPairs(
+                std::vector<std::pair<std::size_t, std::size_t>> &_pairs);
+
+    /// \brief Find all the pairs of boxes that intersect using several
+    /// threads. The pairs are the same and in the same order as with a
+    /// single thread.
+    /// \param[out] _pairs Pairs of ids, with the lower id first and each
+    /// pair reported once. The vector is cleared first, and keeps its
+    /// capacity.
+    /// \param[in] _threads Number of threads used for the sweep. A value
+    /// of 0 uses the number of hardware threads. Small sets of boxes
+    /// always use a single thread.
+    public: void OverlappingPairs(
+                std::vector<std::pair<std::size_t, std::size_t>> &_pairs,
+                const unsigned int _threads);
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+    /// \brief Private data pointer.
+    private: std::unique_ptr<SweepAndPrunePrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+  };
+  }
+}
+}
+#endif
@@ -17,6 +17,7 @@
 #ifndef GZ_MATH_TEMPERATURE_HH_
 #define GZ_MATH_TEMPERATURE_HH_
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
 
@@ -112,6 +113,59 @@ namespace ignition
       /// \return Temperature in Kelvin
       public: static double FahrenheitToKelvin(const double _temp);
 
+      /// \brief Convert an array of temperatures from Kelvin to Celsius,
+      /// as KelvinToCelsius does for one temperature.
+      /// \param[in] _in Temperatures in Kelvin.
+      /// \param[in] _count Number of temperatures.
+      /// \param[out] _out Temperatures in Celsius, which may be _in.
+      public: static void KelvinToCelsius(const double *_in,
+                                          const std::size_t _count,
+                                          double *_out);
+
+      /// \brief Convert an array of temperatures from Kelvin to
+      /// Fahrenheit.
+      /// \param[in] _in Temperatures in Kelvin.
+      /// \param[in] _count Number of temperatures.
+      /// \param[out] _out Temperatures in Fahrenheit, which may be _in.
+      public: static void KelvinToFahrenheit(const double *_in,
+                                             const std::size_t _count,
+                                             double *_out);
+
+      /// \brief Convert an array of temperatures from Celsius to
+      /// Fahrenheit.
+      /// \param[in] _in Temperatures in Celsius.
+      /// \param[in] _count Number of temperatures.
+      /// \param[out] _out Temperatures in Fahrenheit, which may be _in.
+      public: static void CelsiusToFahrenheit(const double *_in,
+                                              const std::size_t _count,
+                                              double *_out);
+
+      /// \brief Convert an array of temperatures from Celsius to Kelvin.
+      /// \param[in] _in Temperatures in Celsius.
+      /// \param[in] _count Number of temperatures.
+      /// \param[out] _out Temperatures in Kelvin, which may be _in.
+      public: static void CelsiusToKelvin(const double *_in,
+                                          const std::size_t _count,
+                                          double *_out);
+
+      /// \brief Convert an array of temperatures from Fahrenheit to
+      /// Celsius.
+      /// \param[in] _in Temperatures in Fahrenheit.
+      /// \param[in] _count Number of temperatures.
+      /// \param[out] _out Temperatures in Celsius, which may be _in.
+      public: static void FahrenheitToCelsius(const double *_in,
+                                              const std::size_t _count,
+                                              double *_out);
+
+      /// \brief Convert an array of temperatures from Fahrenheit to
+      /// Kelvin.
+      /// \param[in] _in Temperatures in Fahrenheit.
+      /// \param[in] _count Number of temperatures.
+      /// \param[out] _out Temperatures in Kelvin, which may be _in.
+      public: static void FahrenheitToKelvin(const double *_in,
+                                             const std::size_t _count,
+                                             double *_out);
+
       /// \brief Set the temperature from a Kelvin value
       /// \param[in] _temp Temperature in Kelvin
       public: void SetKelvin(const double _temp);
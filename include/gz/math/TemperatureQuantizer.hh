@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_TEMPERATUREQUANTIZER_HH_
+#define GZ_MATH_TEMPERATUREQUANTIZER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  //
+  // Forward declare private data
+  class TemperatureQuantizerPrivate;
+
+  /// \class TemperatureQuantizer TemperatureQuantizer.hh
+  /// ignition/math/TemperatureQuantizer.hh
+  /// \brief Conversion of temperatures to the 8 or 16 bit counts of a
+  /// thermal sensor, such as the pixels of a thermal camera image.
+  ///
+  /// A temperature t, in Kelvin, becomes the count
+  /// round((t - Min()) / Resolution()), clamped to [0, MaxCount()], where
+  /// MaxCount() is the number of steps of Resolution() between Min() and
+  /// Max(), at most 65535. Counts written to 8 bit images are also
+  /// clamped to 255. Temperatures that are not a number become 0.
+  ///
+  /// Images that already hold temperatures as 16 bit codes, such as the
+  /// output of a thermal camera render pass with a linear encoding, are
+  /// converted through a lookup table of the 65536 codes. The table is
+  /// built once by SetInputEncoding, and then each pixel costs a single
+  /// load, whatever the range and resolution.
+  ///
+  /// # Example usage
+  ///
+  /// \code{.cpp}
+  /// // 8 bit image of 250 K to 350 K
+  /// gz::math::TemperatureQuantizer quantizer(250, 350, 100.0 / 255);
+  ///
+  /// // Rendered image with codes in hundredths of a Kelvin
+  /// quantizer.SetInputEncoding(0.01);
+  /// std::vector<uint8_t> counts(width * height);
+  /// quantizer.QuantizeEncoded(rendered.data(), rendered.size(),
+  ///                           counts.data());
+  /// \endcode
+  class IGNITION_MATH_VISIBLE TemperatureQuantizer
+  {
+    /// \brief Default constructor. The range is 0 K to 655.35 K with a
+    /// resolution of 0.01 K, which covers every 16 bit count.
+    public: TemperatureQuantizer();
+
+    /// \brief Constructor.
+    /// \param[in] _min Temperature of count 0, in Kelvin.
+    /// \param[in] _max Highest temperature, in Kelvin.
+    /// \param[in] _resolution Temperature step of one count, in Kelvin.
+    /// \sa Valid()
+    public: TemperatureQuantizer(const double _min, const double _max,
+                                 const double _resolution);
+
+    /// \brief Copy constructor.
+    /// \param[in] _other The quantizer to copy, with its lookup table.
+    public: TemperatureQuantizer(const TemperatureQuantizer &_other);
+
+    /// \brief Move constructor.
+    /// \param[in] _other The quantizer to move.
+    public: TemperatureQuantizer(TemperatureQuantizer &&_other) noexcept;
+
+    /// \brief Destructor.
+    public: ~TemperatureQuantizer();
+
+    /// \brief Copy assignment operator.
+    /// \param[in] _other The quantizer to copy, with its lookup table.
+    /// \return Reference to this quantizer.
+    public: TemperatureQuantizer &operator=(
+                const TemperatureQuantizer &_other);
+
+    /// \brief Move assignment operator.
+    /// \param[in] _other The quantizer to move.
+    /// \return Reference to this quantizer.
+    public: TemperatureQuantizer &operator=(
+                TemperatureQuantizer &&_other) noexcept;
+
+    /// \brief Set the range and resolution. The lookup table, if any, is
+    /// rebuilt for the same input encoding.
+    /// \param[in] _min Temperature of count 0, in Kelvin.
+    /// \param[in] _max Highest temperature, in Kelvin.
+    /// \param[in] _resolution Temperature step of one count, in Kelvin.
+    public: void SetRange(const double _min, const double _max,
+                          const double _resolution);
+
+    /// \brief Get whether the range and resolution are usable: finite,
+    /// Min() below Max(), and a positive Resolution(). The counts of an
+    /// invalid quantizer are all 0.
+    /// \return True if the quantizer is valid.
+    public: bool Valid() const;
+
+    /// \brief Get the temperature of count 0.
+    /// \return Temperature in Kelvin.
+    public: double Min() const;
+
+    /// \brief Get the highest temperature.
+    /// \return Temperature in Kelvin.
+    public: double Max() const;
+
+    /// \brief Get the temperature step of one count.
+    /// \return Resolution in Kelvin.
+    public: double Resolution() const;
+
+    /// \brief Get the highest count, that of Max().
+    /// \return The highest count.
+    public: uint16_t MaxCount() const;
+
+    /// \brief Convert a temperature to a count.
+    /// \param[in] _kelvin Temperature in Kelvin.
+    /// \return The count.
+    public: uint16_t Count(const double _kelvin) const;
+
+    /// \brief Convert a count to a temperature.
+    /// \param[in] _count The count.
+    /// \return Temperature in Kelvin.
+    public: double Kelvin(const uint16_t _count) const;
+
+    /// \brief Convert an array of temperatures to 16 bit counts.
+    /// \param[in] _kelvin Temperatures in Kelvin.
+    /// \param[in] _count Number of temperatures.
+    /// \param[out] _out Counts, one per temperature.
+    public: void Quantize(const double *_kelvin, const std::size_t _count,
+                          uint16_t *_out) const;
+
+    /// \brief Convert an array of temperatures to 8 bit counts.
+    /// \param[in] _kelvin Temperatures in Kelvin.
+    /// \param[in] _count Number of temperatures.
+    /// \param[out] _out Counts, one per temperature.
+    public: void Quantize(const double *_kelvin, const std::size_t _count,
+                          uint8_t *_out) const;
+
+    /// \brief Convert an array of counts to temperatures.
+    /// \param[in] _counts The counts.
+    /// \param[in] _count Number of counts.
+    /// \param[out] _kelvin Temperatures in Kelvin, one per count.
+    public: void Dequantize(const uint16_t *_counts, const std::size_t _count,
+                            double *_kelvin) const;
+
+    /// \brief Set the linear encoding of the 16 bit temperature codes
+    /// read by QuantizeEncoded, where code c is the temperature
+    /// _offset + c * _resolution, and build the lookup table of the
+    /// codes.
+    /// \param[in] _resolution Temperature step of one code, in Kelvin.
+    /// \param[in] _offset Temperature of code 0, in Kelvin.
+    /// \return False if the encoding is not finite or the resolution is
+    /// not positive, in which case the lookup table is cleared.
+    public: bool SetInputEncoding(const double _resolution,
+                                  const double _offset = 0.0);
+
+    /// \brief Get whether the lookup table of an input encoding is built.
+    /// \return True if QuantizeEncoded can be used.
+    public: bool HasInputEncoding() const;
+
+    /// \brief Convert an array of 16 bit temperature codes to 16 bit
+    /// counts through the lookup table.
+    /// \param[in] _codes Temperature codes, in the input encoding.
+    /// \param[in] _count Number of codes.
+    /// \param[out] _out Counts, one per code, which may be _codes.
+    /// \return False if no input encoding is set, in which case _out is
+    /// not changed.
+    /// \sa SetInputEncoding
+    public: bool QuantizeEncoded(const uint16_t *_codes,
+                                 const std::size_t _count,
+                                 uint16_t *_out) const;
+
+    /// \brief Convert an array of 16 bit temperature codes to 8 bit
+    /// counts through the lookup table.
+    /// \param[in] _codes Temperature codes, in the input encoding.
+    /// \param[in] _count Number of codes.
+    /// \param[out] _out Counts, one per code.
+    /// \return False if no input encoding is set, in which case _out is
+    /// not changed.
+    public: bool QuantizeEncoded(const uint16_t *_codes,
+                                 const std::size_t _count,
+                                 uint8_t *_out) const;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<TemperatureQuantizerPrivate> dataPtr;
+  };
+}
+}
+}
+#endif
@@ -0,0 +1,470 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_TIMEOFIMPACT_HH_
+#define GZ_MATH_TIMEOFIMPACT_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Box.hh>
+#include <gz/math/Capsule.hh>
+#include <gz/math/Cylinder.hh>
+#include <gz/math/Ellipsoid.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/ShapeDistance.hh>
+#include <gz/math/Sphere.hh>
+#include <gz/math/Vector3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    /// \brief Result of the time of impact queries.
+    template<typename T>
+    struct TimeOfImpactResult
+    {
+      /// \brief Fraction of the motion, between 0 and 1, at which the
+      /// shapes first touch.
+      T time = 1;
+
+      /// \brief Contact point at the time of impact, in the world frame.
+      /// Zero when the shapes overlap at the start of the motion.
+      Vector3<T> point;
+
+      /// \brief Unit contact normal at the time of impact, pointing from
+      /// the first shape to the second one. Zero when the shapes overlap at
+      /// the start of the motion.
+      Vector3<T> normal;
+
+      /// \brief Number of distance queries of conservative advancement, or
+      /// 0 for swept boxes.
+      unsigned int iterations = 0;
+    };
+
+    /// \brief Time of impact of two axis aligned boxes translating along
+    /// straight lines.
+    ///
+    /// Each box moves by its displacement during the motion. The boxes
+    /// touch at the latest time at which their projections on the three
+    /// axes start to overlap, if that is before all of them stop to
+    /// overlap. The result is exact, without iterations.
+    /// \param[in] _a First box, at the start of the motion.
+    /// \param[in] _motionA Displacement of the first box.
+    /// \param[in] _b Second box, at the start of the motion.
+    /// \param[in] _motionB Displacement of the second box.
+    /// \param[out] _result Time of impact, contact point at the center of
+    /// the touching region and normal along the axis of the touching faces.
+    /// Unchanged if the boxes don't touch.
+    /// \return True if the boxes touch or overlap during the motion, false
+    /// otherwise or if a box is empty.
+    inline bool SweptBoxTimeOfImpact(const AxisAlignedBox &_a,
+                                     const Vector3d &_motionA,
+                                     const AxisAlignedBox &_b,
+                                     const Vector3d &_motionB,
+                                     TimeOfImpactResult<double> &_result)
+    {
+      // Move the second box relative to the first one.
+      const Vector3d motion = _motionB - _motionA;
+      double enter = -std::numeric_limits<double>::infinity();
+      double exit = std::numeric_limits<double>::infinity();
+      int axis = -1;
+      for (int i = 0; i < 3; ++i)
+      {
+        if (_a.Min()[i] > _a.Max()[i] || _b.Min()[i] > _b.Max()[i])
+          return false;
+
+        const double gapBelow = _a.Min()[i] - _b.Max()[i];
+        const double gapAbove = _a.Max()[i] - _b.Min()[i];
+        if (std::abs(motion[i]) <= 0)
+        {
+          if (gapBelow > 0 || gapAbove < 0)
+            return false;
+          continue;
+        }
+
+        double t0 = gapBelow / motion[i];
+        double t1 = gapAbove / motion[i];
+        if (t0 > t1)
+          std::swap(t0, t1);
+        if (t0 > enter)
+        {
+          enter = t0;
+          axis = i;
+        }
+        exit = std::min(exit, t1);
+      }
+
+      if (enter > exit || enter > 1 || exit < 0)
+        return false;
+
+      _result.iterations = 0;
+      if (enter <= 0 || axis < 0)
+      {
+        _result.time = 0;
+        _result.point = Vector3d::Zero;
+        _result.normal = Vector3d::Zero;
+        return true;
+      }
+
+      _result.time = enter;
+      _result.normal = Vector3d::Zero;
+      _result.normal[axis] = motion[axis] < 0 ? 1 : -1;
+      const Vector3d minA = _a.Min() + _motionA * enter;
+      const Vector3d maxA = _a.Max() + _motionA * enter;
+      const Vector3d minB = _b.Min() + _motionB * enter;
+      const Vector3d maxB = _b.Max() + _motionB * enter;
+      for (int i = 0; i < 3; ++i)
+      {
+        _result.point[i] = 0.5 * (std::max(minA[i], minB[i]) +
+                                  std::min(maxA[i], maxB[i]));
+      }
+      return true;
+    }
+
+    /// \brief Times of impact of pairs of axis aligned boxes translating
+    /// along straight lines, such as the pairs found by a broadphase over
+    /// the boxes swept by the motion.
+    ///
+    /// <b>Example</b>
+    /// \code{.cpp}
+    /// // Insert the swept boxes, box + (box + motion), in the broadphase.
+    /// sap.OverlappingPairs(pairs);
+    /// gz::math::SweptBoxTimesOfImpact(boxes, motions, pairs, hits);
+    /// \endcode
+    /// \param[in] _boxes Boxes at the start of the motion.
+    /// \param[in] _motions Displacements of the boxes.
+    /// \param[in] _pairs Pairs of indices in _boxes and _motions.
+    /// \param[out] _hits Index in _pairs and result of the pairs that
+    /// touch, in the order of _pairs. The vector is cleared first, and
+    /// keeps its capacity.
+    /// \sa SweptBoxTimeOfImpact
+    inline void SweptBoxTimesOfImpact(
+        const std::vector<AxisAlignedBox> &_boxes,
+        const std::vector<Vector3d> &_motions,
+        const std::vector<std::pair<std::size_t, std::size_t>> &_pairs,
+        std::vector<std::pair<std::size_t, TimeOfImpactResult<double>>>
+            &_hits)
+    {
+      _hits.clear();
+      TimeOfImpactResult<double> result;
+      for (std::size_t i = 0; i < _pairs.size(); ++i)
+      {
+        const std::size_t a = _pairs[i].first;
+        const std::size_t b = _pairs[i].second;
+        if (SweptBoxTimeOfImpact(_boxes[a], _motions[a], _boxes[b],
+                                 _motions[b], result))
+        {
+          _hits.emplace_back(i, result);
+        }
+      }
+    }
+
+    namespace detail
+    {
+      /// \brief Largest distance of a point of a box from its origin.
+      /// \param[in] _box Box.
+      /// \return Half of the diagonal.
+      template<typename T>
+      T BoundingRadius(const Box<T> &_box)
+      {
+        return T(0.5) * _box.Size().Length();
+      }
+
+      /// \brief Largest distance of a point of a sphere from its origin.
+      /// \param[in] _sphere Sphere.
+      /// \return The radius.
+      template<typename T>
+      T BoundingRadius(const Sphere<T> &_sphere)
+      {
+        return _sphere.Radius();
+      }
+
+      /// \brief Largest distance of a point of a capsule from its origin.
+      /// \param[in] _capsule Capsule.
+      /// \return Half of the length plus the radius.
+      template<typename T>
+      T BoundingRadius(const Capsule<T> &_capsule)
+      {
+        return T(0.5) * _capsule.Length() + _capsule.Radius();
+      }
+
+      /// \brief Largest distance of a point of a cylinder from its origin,
+      /// which doesn't depend on its rotational offset.
+      /// \param[in] _cylinder Cylinder.
+      /// \return Distance to the rim of the caps.
+      template<typename T>
+      T BoundingRadius(const Cylinder<T> &_cylinder)
+      {
+        const T half = T(0.5) * _cylinder.Length();
+        return std::sqrt(half * half +
+                         _cylinder.Radius() * _cylinder.Radius());
+      }
+
+      /// \brief Largest distance of a point of an ellipsoid from its
+      /// origin.
+      /// \param[in] _ellipsoid Ellipsoid.
+      /// \return The largest radius.
+      template<typename T>
+      T BoundingRadius(const Ellipsoid<T> &_ellipsoid)
+      {
+        return _ellipsoid.Radii().Max();
+      }
+
+      /// \brief Motion of a shape from one pose to another, with a
+      /// constant linear velocity and a constant angular velocity.
+      template<typename T>
+      class PoseMotion
+      {
+        /// \brief Constructor.
+        /// \param[in] _start Pose at the start of the motion.
+        /// \param[in] _end Pose at the end of the motion.
+        public: PoseMotion(const Pose3<T> &_start, const Pose3<T> &_end)
+          : start(_start), translation(_end.Pos() - _start.Pos())
+        {
+          Quaternion<T> delta = _start.Rot().Inverse() * _end.Rot();
+          if (delta.W() < 0)
+            delta = -delta;
+          this->axis.Set(delta.X(), delta.Y(), delta.Z());
+          const T sine = this->axis.Length();
+          this->angle = 2 * std::atan2(sine, delta.W());
+          if (sine > 0)
+            this->axis /= sine;
+        }
+
+        /// \brief Get the pose at a time.
+        /// \param[in] _time Fraction of the motion, between 0 and 1.
+        /// \return Interpolated pose.
+        public: Pose3<T> At(const T _time) const
+        {
+          // Quaternion::Axis rounds small angles to 0, so build the
+          // rotation directly.
+          const T half = T(0.5) * this->angle * _time;
+          const Vector3<T> v = this->axis * std::sin(half);
+          return Pose3<T>(this->start.Pos() + this->translation * _time,
+              this->start.Rot() *
+              Quaternion<T>(std::cos(half), v.X(), v.Y(), v.Z()));
+        }
+
+        /// \brief Pose at the start of the motion.
+        public: const Pose3<T> start;
+
+        /// \brief Displacement of the origin of the shape.
+        public: const Vector3<T> translation;
+
+        /// \brief Unit axis of the rotation, in the frame of the start
+        /// pose.
+        public: Vector3<T> axis;
+
+        /// \brief Angle of the rotation, between 0 and pi.
+        public: T angle = 0;
+      };
+
+      /// \brief Conservative advancement between two moving shapes.
+      /// \param[in] _a First shape.
+      /// \param[in] _motionA Motion of the first shape.
+      /// \param[in] _b Second shape.
+      /// \param[in] _motionB Motion of the second shape.
+      /// \param[in] _maxTime Time after which to stop searching.
+      /// \param[in] _tolerance Distance at which the shapes touch.
+      /// \param[in] _maxIterations Maximum number of distance queries.
+      /// \param[out] _result Time of impact.
+      /// \return True if the shapes touch before _maxTime.
+      template<typename T, typename ShapeA, typename ShapeB>
+      bool ConservativeAdvancement(const ShapeA &_a,
+                                   const PoseMotion<T> &_motionA,
+                                   const ShapeB &_b,
+                                   const PoseMotion<T> &_motionB,
+                                   const T _maxTime, const T _tolerance,
+                                   const unsigned int _maxIterations,
+                                   TimeOfImpactResult<T> &_result)
+      {
+        // Bound on the speed at which points move away from the origins
+        // of the shapes because of their rotations.
+        const T rotationSpeed = _motionA.angle * BoundingRadius(_a) +
+                                _motionB.angle * BoundingRadius(_b);
+        const Vector3<T> translation =
+            _motionB.translation - _motionA.translation;
+
+        ShapeDistanceCache<T> cache;
+        ShapeDistanceResult<T> distance;
+        ShapeDistanceResult<T> last;
+        T time = 0;
+        T lastTime = 0;
+        unsigned int i = 0;
+        while (i < _maxIterations)
+        {
+          ++i;
+          if (!ShapeDistance(_a, _motionA.At(time), _b, _motionB.At(time),
+                             distance, &cache))
+          {
+            if (i == 1)
+            {
+              _result.time = 0;
+              _result.point = Vector3<T>::Zero;
+              _result.normal = Vector3<T>::Zero;
+              _result.iterations = i;
+              return true;
+            }
+            // The step ended exactly at the contact, or rounding brought
+            // the shapes slightly into each other.
+            ShapePenetration(_a, _motionA.At(time), _b, _motionB.At(time),
+                             last, &cache);
+            lastTime = time;
+            break;
+          }
+          last = distance;
+          lastTime = time;
+          if (distance.distance <= _tolerance)
+            break;
+
+          // Largest rate at which the distance can shrink.
+          const T speed = -translation.Dot(distance.normal) + rotationSpeed;
+          if (speed <= 0)
+            return false;
+          time += distance.distance / speed;
+          if (time > _maxTime)
+            return false;
+        }
+
+        _result.time = lastTime;
+        _result.point = (last.pointA + last.pointB) * T(0.5);
+        _result.normal = last.normal;
+        _result.iterations = i;
+        return true;
+      }
+    }
+
+    /// \brief Time of impact of two convex shapes moving between two
+    /// poses, with conservative advancement.
+    ///
+    /// The shapes can be any pair of Box, Capsule, Cylinder, Ellipsoid and
+    /// Sphere. Each shape moves from its start pose to its end pose with a
+    /// constant linear velocity and a constant angular velocity about its
+    /// origin, along the shortest rotation. Conservative advancement
+    /// repeatedly computes the distance between the shapes with
+    /// ShapeDistance and advances time by the distance divided by a bound
+    /// on the speed at which they approach, so it never steps past the
+    /// first contact. Pure translations usually converge in a few
+    /// iterations, fast rotations take more.
+    ///
+    /// <b>Example</b>
+    /// \code{.cpp}
+    /// gz::math::TimeOfImpactResult<double> result;
+    /// if (gz::math::ShapeTimeOfImpact(bullet, pose, nextPose,
+    ///                                 wall, wallPose, wallPose, result))
+    ///   nextPose = gz::math::Pose3d(...);  // Stop at result.time.
+    /// \endcode
+    /// \param[in] _a First shape.
+    /// \param[in] _startA Pose of the first shape at the start of the
+    /// motion.
+    /// \param[in] _endA Pose of the first shape at the end of the motion.
+    /// \param[in] _b Second shape.
+    /// \param[in] _startB Pose of the second shape at the start of the
+    /// motion.
+    /// \param[in] _endB Pose of the second shape at the end of the motion.
+    /// \param[out] _result Time of impact, contact point and normal. If the
+    /// iterations run out, the time is the last one at which the shapes
+    /// were known to be separated. Unchanged if the shapes don't touch.
+    /// \param[in] _tolerance Distance at which the shapes are considered to
+    /// touch, which must be positive.
+    /// \param[in] _maxIterations Maximum number of distance queries.
+    /// \return True if the shapes touch or overlap during the motion.
+    /// \sa ShapeDistance
+    template<typename T, typename ShapeA, typename ShapeB>
+    bool ShapeTimeOfImpact(const ShapeA &_a, const Pose3<T> &_startA,
+                           const Pose3<T> &_endA, const ShapeB &_b,
+                           const Pose3<T> &_startB, const Pose3<T> &_endB,
+                           TimeOfImpactResult<T> &_result,
+                           const T _tolerance = T(1e-4),
+                           const unsigned int _maxIterations = 64)
+    {
+      return detail::ConservativeAdvancement(_a,
+          detail::PoseMotion<T>(_startA, _endA), _b,
+          detail::PoseMotion<T>(_startB, _endB), T(1), _tolerance,
+          _maxIterations, _result);
+    }
+
+    /// \brief Earliest time of impact of a convex shape moving between two
+    /// poses with several others, such as the candidates found by a
+    /// broadphase for a fast body.
+    ///
+    /// Each query stops as soon as it passes the earliest time of impact
+    /// found so far, so most of the candidates cost a single distance
+    /// query.
+    /// \param[in] _a Moving shape.
+    /// \param[in] _startA Pose of the moving shape at the start of the
+    /// motion.
+    /// \param[in] _endA Pose of the moving shape at the end of the motion.
+    /// \param[in] _others Array of _count other shapes.
+    /// \param[in] _startOthers Array of _count poses of the other shapes at
+    /// the start of the motion.
+    /// \param[in] _endOthers Array of _count poses of the other shapes at
+    /// the end of the motion.
+    /// \param[in] _count Number of other shapes.
+    /// \param[out] _result Earliest time of impact, contact point and
+    /// normal, as in ShapeTimeOfImpact.
+    /// \param[out] _index Index of the other shape hit first.
+    /// \param[in] _tolerance Distance at which the shapes are considered to
+    /// touch, which must be positive.
+    /// \param[in] _maxIterations Maximum number of distance queries per
+    /// shape.
+    /// \return True if the moving shape touches any of the others.
+    /// \sa ShapeTimeOfImpact
+    template<typename T, typename ShapeA, typename ShapeB>
+    bool ShapeTimeOfImpact(const ShapeA &_a, const Pose3<T> &_startA,
+                           const Pose3<T> &_endA, const ShapeB *_others,
+                           const Pose3<T> *_startOthers,
+                           const Pose3<T> *_endOthers,
+                           const std::size_t _count,
+                           TimeOfImpactResult<T> &_result,
+                           std::size_t &_index,
+                           const T _tolerance = T(1e-4),
+                           const unsigned int _maxIterations = 64)
+    {
+      const detail::PoseMotion<T> motionA(_startA, _endA);
+      bool hit = false;
+      TimeOfImpactResult<T> result;
+      for (std::size_t i = 0; i < _count; ++i)
+      {
+        const T maxTime = hit ? _result.time : T(1);
+        if (detail::ConservativeAdvancement(_a, motionA, _others[i],
+                detail::PoseMotion<T>(_startOthers[i], _endOthers[i]),
+                maxTime, _tolerance, _maxIterations, result) &&
+            (!hit || result.time < _result.time))
+        {
+          _result = result;
+          _index = i;
+          hit = true;
+          if (result.time <= 0)
+            break;
+        }
+      }
+      return hit;
+    }
+    }
+  }
+}
+#endif
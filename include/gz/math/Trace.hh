@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_TRACE_HH_
+#define GZ_MATH_TRACE_HH_
+
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \brief Functions receiving the trace zones of the library. A zone
+    /// covers one call of a long running routine, such as
+    /// Kmeans::Cluster, a graph search or the build of a
+    /// BoundingVolumeHierarchy, or of a batch function. The functions
+    /// can forward the zones to a profiler, such as the ITT API of VTune
+    /// with __itt_task_begin and __itt_task_end, or the track events of
+    /// Perfetto.
+    ///
+    /// The functions may be called from any thread, and from several
+    /// threads at once. The end of a zone is always reported to the
+    /// functions which received its beginning, on the same thread, so
+    /// zones nest like the calls they cover.
+    struct TraceCallbacks
+    {
+      /// \brief Called when a zone begins.
+      /// \param[in] _name Name of the zone, such as "Kmeans::Cluster".
+      /// The string is a literal, which remains valid.
+      /// \param[in] _userData The userData of these callbacks.
+      void (*begin)(const char *_name, void *_userData) = nullptr;
+
+      /// \brief Called when a zone ends.
+      /// \param[in] _name Name of the zone, the same as that of begin.
+      /// \param[in] _userData The userData of these callbacks.
+      void (*end)(const char *_name, void *_userData) = nullptr;
+
+      /// \brief Pointer passed to the callbacks, such as a profiler
+      /// domain.
+      void *userData = nullptr;
+    };
+
+    /// \brief Set the functions receiving the trace zones of the library.
+    /// No zone is reported by default, and a zone then costs a single
+    /// atomic load. Define IGNITION_MATH_DISABLE_TRACING when building
+    /// the library to compile the zones out.
+    /// \param[in] _callbacks The functions, or nullptr to stop reporting
+    /// zones. They are not copied, and must remain valid until the end
+    /// of the zones they received, such as by being static.
+    void IGNITION_MATH_VISIBLE SetTraceCallbacks(
+        const TraceCallbacks *_callbacks);
+
+    /// \brief Get the functions receiving the trace zones.
+    /// \return The functions, or nullptr if none are set.
+    const TraceCallbacks IGNITION_MATH_VISIBLE *ActiveTraceCallbacks();
+
+    /// \class TraceZone Trace.hh gz/math/Trace.hh
+    /// \brief Report a trace zone over the lifetime of the object, if
+    /// trace callbacks are set when it is constructed. Use
+    /// IGN_MATH_TRACE_ZONE, which is compiled out along with the zones of
+    /// the library.
+    class IGNITION_MATH_VISIBLE TraceZone
+    {
+      /// \brief Begin a zone.
+      /// \param[in] _name Name of the zone, which must remain valid, such
+      /// as a string literal.
+      public: explicit TraceZone(const char *_name);
+
+      /// \brief End the zone.
+      public: ~TraceZone();
+
+      /// \brief Copying would end the zone twice.
+      public: TraceZone(const TraceZone &) = delete;
+
+      /// \brief Copying would end the zone twice.
+      public: TraceZone &operator=(const TraceZone &) = delete;
+
+      /// \brief Name of the zone.
+      private: const char *name;
+
+      /// \brief Functions which received the beginning of the zone, or
+      /// nullptr if none were set.
+      private: const TraceCallbacks *callbacks;
+    };
+    }
+  }
+}
+
+/// \brief Report a trace zone from this line to the end of the enclosing
+/// scope, such as IGN_MATH_TRACE_ZONE("Kmeans::Cluster"). Define
+/// IGNITION_MATH_DISABLE_TRACING to compile the zones out.
+#ifdef IGNITION_MATH_DISABLE_TRACING
+#define IGN_MATH_TRACE_ZONE(_name) do {} while (false)
+#else
+#define IGN_MATH_TRACE_ZONE(_name) \
+  gz::math::TraceZone ignMathTraceZone(_name)
+#endif
+
+#endif
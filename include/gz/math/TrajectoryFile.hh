@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_TRAJECTORYFILE_HH_
+#define GZ_MATH_TRAJECTORYFILE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/math/Export.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+  // Forward declaration.
+  class TrajectoryFilePrivate;
+
+  /// \class TrajectoryFile TrajectoryFile.hh ignition/math/TrajectoryFile.hh
+  /// \brief A recorded trajectory, a series of timestamped positions and
+  /// optionally rotations, stored in a file that is memory mapped.
+  ///
+  /// The file holds a 64 byte header followed by three columns: the
+  /// times, the positions, as x, y, z, and the rotations, as w, x, y, z,
+  /// all as double. All values are little
+  /// endian. Opening a file only maps it and checks the header, so even
+  /// very large files open immediately, and the columns are read in
+  /// place through Times(), Positions() and Rotations() without copying.
+  /// Pages are loaded by the operating system when they are accessed.
+  ///
+  /// Times are non-decreasing, which Write() checks and Open() trusts.
+  /// SampleIndex() finds the sample of a time with a binary search, and
+  /// Interpolate() evaluates the trajectory between samples with a Spline
+  /// through the positions and a RotationSpline through the rotations,
+  /// parameterized linearly in time within each segment.
+  ///
+  /// Opening a file requires a little endian host. A TrajectoryFile can
+  /// be moved but not copied. Const methods can be called from several
+  /// threads at the same time.
+  class IGNITION_MATH_VISIBLE TrajectoryFile
+  {
+    /// \brief Default constructor. No file is open.
+    public: TrajectoryFile();
+
+    /// \brief Move constructor.
+    /// \param[in] _file File to move. It is left closed.
+    public: TrajectoryFile(TrajectoryFile &&_file);
+
+    /// \brief Destructor. Closes the file.
+    public: ~TrajectoryFile();
+
+    /// \brief Move assignment operator. Closes the current file.
+    /// \param[in] _file File to move. It is left closed.
+    /// \return Reference to this object.
+    public: TrajectoryFile &operator=(TrajectoryFile &&_file) noexcept;
+
+    /// \brief Write a trajectory file.
+    /// \param[in] _filename Path of the file, replaced if it exists.
+    /// \param[in] _times Time of each sample, finite and non-decreasing.
+    /// \param[in] _positions Position of each sample.
+    /// \param[in] _rotations Rotation of each sample, or empty for a file
+    /// without rotations.
+    /// \return True on success. False if the sizes differ, the times are
+    /// not finite and non-decreasing, or the file can't be written.
+    public: static bool Write(const std::string &_filename,
+                              const std::vector<double> &_times,
+                              const std::vector<Vector3d> &_positions,
+                              const std::vector<Quaterniond> &_rotations =
+                                std::vector<Quaterniond>());
+
+    /// \brief Write a trajectory file of poses.
+    /// \param[in] _filename Path of the file, replaced if it exists.
+    /// \param[in] _times Time of each sample, finite and non-decreasing.
+    /// \param[in] _poses Pose of each sample.
+    /// \return True on success.
+    public: static bool Write(const std::string &_filename,
+                              const std::vector<double> &_times,
+                              const std::vector<Pose3d> &_poses);
+
+    /// \brief Open and map a trajectory file, closing the current one.
+    /// \param[in] _filename Path of the file.
+    /// \return True on success. False if the file can't be mapped or is
+    /// not a valid trajectory file, in which case no file is open.
+    public: bool Open(const std::string &_filename);
+
+    /// \brief Unmap the file. Pointers returned by Times(), Positions()
+    /// and Rotations() become invalid.
+    public: void Close();
+
+    /// \brief Check if a file is open.
+    /// \return True if a file is open.
+    public: bool IsOpen() const;
+
+    /// \brief Get the number of samples.
+    /// \return Number of samples, 0 if no file is open.
+    public: std::size_t Size() const;
+
+    /// \brief Check if the file has rotations.
+    /// \return True if the file has a rotation column.
+    public: bool HasRotations() const;
+
+    /// \brief Get the times of the samples.
+    /// \return Pointer to Size() times, or nullptr if no file is open.
+    public: const double *Times() const;
+
+    /// \brief Get the positions of the samples.
+    /// \return Pointer to 3 * Size() values, the x, y and z of each
+    /// sample, or nullptr if no file is open.
+    public: const double *Positions() const;
+
+    /// \brief Get the rotations of the samples.
+    /// \return Pointer to 4 * Size() values, the w, x, y and z of each
+    /// sample, or nullptr if no file is open or the file has no
+    /// rotations.
+    public: const double *Rotations() const;
+
+    /// \brief Get the pose of a sample.
+    /// \param[in] _index Index of the sample, lower than Size().
+    /// \return The position and rotation of the sample. The rotation is
+    /// the identity if the file has no rotations.
+    public: Pose3d SamplePose(const std::size_t _index) const;
+
+    /// \brief Find the sample at or before a time, in O(log n).
+    /// \param[in] _time Time to look up.
+    /// \return Index of the last sample whose time is not greater than
+    /// _time, 0 if _time is before the first sample, or 0 if the file is
+    /// empty or not open.
+    public: std::size_t SampleIndex(const double _time) const;
+
+    /// \brief Interpolate the position at a time. Times outside of the
+    /// recording are clamped to the first or last sample.
+    /// \param[in] _time Time to evaluate.
+    /// \param[out] _position Interpolated position.
+    /// \return True on success, false if there are no samples.
+    public: bool Interpolate(const double _time, Vector3d &_position) const;
+
+    /// \brief Interpolate the pose at a time. Times outside of the
+    /// recording are clamped to the first or last sample.
+    /// \param[in] _time Time to evaluate.
+    /// \param[out] _pose Interpolated pose. The rotation is the identity
+    /// if the file has no rotations.
+    /// \return True on success, false if there are no samples.
+    public: bool Interpolate(const double _time, Pose3d &_pose) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+    /// \brief Private data pointer.
+    private: std::unique_ptr<TrajectoryFilePrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+  };
+  }
+}
+}
+#endif
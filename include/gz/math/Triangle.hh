@@ -17,6 +17,7 @@
 #ifndef GZ_MATH_TRIANGLE_HH_
 #define GZ_MATH_TRIANGLE_HH_
 
+#include <cstddef>
 #include <set>
 #include <gz/math/Helpers.hh>
 #include <gz/math/Line2.hh>
@@ -137,6 +138,43 @@ namespace ignition
         return (u >= 0) && (v >= 0) && (u + v <= 1);
       }
 
+      /// \brief Get whether this triangle contains each of many points.
+      /// The dot products of the sides are computed once, and each result
+      /// is the same as Contains(const math::Vector2<T> &).
+      /// \param[in] _points Array of _count points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _inside Array of _count results, true for the points
+      /// inside or on the triangle.
+      /// \return Number of points inside or on the triangle.
+      public: std::size_t Contains(const math::Vector2<T> *_points,
+                                   const std::size_t _count,
+                                   bool *_inside) const
+      {
+        const math::Vector2<T> v0 = this->pts[2] - this->pts[0];
+        const math::Vector2<T> v1 = this->pts[1] - this->pts[0];
+        const double dot00 = v0.Dot(v0);
+        const double dot01 = v0.Dot(v1);
+        const double dot11 = v1.Dot(v1);
+        const double invDenom = 1.0 / (dot00 * dot11 - dot01 * dot01);
+
+        // A local copy of the first vertex, which the stores to _inside
+        // could otherwise alias.
+        const math::Vector2<T> origin = this->pts[0];
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const math::Vector2<T> v2 = _points[i] - origin;
+          const double dot02 = v0.Dot(v2);
+          const double dot12 = v1.Dot(v2);
+          const double u = (dot11 * dot02 - dot01 * dot12) * invDenom;
+          const double v = (dot00 * dot12 - dot01 * dot02) * invDenom;
+          const bool inside = (u >= 0) && (v >= 0) && (u + v <= 1);
+          _inside[i] = inside;
+          count += inside;
+        }
+        return count;
+      }
+
       /// \brief Get whether the given line intersects this triangle.
       /// \param[in] _line Line to check.
       /// \param[out] _ipt1 Return value of the first intersection point,
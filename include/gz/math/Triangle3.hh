@@ -17,6 +17,11 @@
 #ifndef GZ_MATH_TRIANGLE3_HH_
 #define GZ_MATH_TRIANGLE3_HH_
 
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+
 #include <gz/math/Helpers.hh>
 #include <gz/math/Line3.hh>
 #include <gz/math/Plane.hh>
@@ -237,6 +242,169 @@ namespace ignition
         return false;
       }
 
+      /// \brief Intersect a ray with a triangle using the Moller-Trumbore
+      /// algorithm. Both faces of the triangle are hit, and rays parallel to
+      /// the triangle never hit it.
+      /// \param[in] _v0 First vertex of the triangle.
+      /// \param[in] _v1 Second vertex of the triangle.
+      /// \param[in] _v2 Third vertex of the triangle.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray, which is not normalized.
+      /// \param[out] _t Position of the intersection along the ray, in
+      /// multiples of _dir, so that the point is _origin + _t * _dir. It may
+      /// be negative. Only valid if the return value is true.
+      /// \param[out] _u Barycentric coordinate of the intersection along
+      /// _v1 - _v0. Only valid if the return value is true.
+      /// \param[out] _v Barycentric coordinate of the intersection along
+      /// _v2 - _v0. Only valid if the return value is true.
+      /// \return True if the line through the ray intersects the triangle.
+      public: static bool RayIntersection(const Vector3<T> &_v0,
+                                          const Vector3<T> &_v1,
+                                          const Vector3<T> &_v2,
+                                          const Vector3<T> &_origin,
+                                          const Vector3<T> &_dir,
+                                          T &_t, T &_u, T &_v)
+      {
+        const Vector3<T> edge1 = _v1 - _v0;
+        const Vector3<T> edge2 = _v2 - _v0;
+        const Vector3<T> p = _dir.Cross(edge2);
+        const T det = edge1.Dot(p);
+        // The ray is parallel to the triangle
+        if (std::abs(det) < std::numeric_limits<T>::epsilon())
+          return false;
+
+        const T invDet = T(1) / det;
+        const Vector3<T> s = _origin - _v0;
+        _u = s.Dot(p) * invDet;
+        // Negated comparisons also reject NaN coordinates
+        if (!(_u >= T(0) && _u <= T(1)))
+          return false;
+
+        const Vector3<T> q = s.Cross(edge1);
+        _v = _dir.Dot(q) * invDet;
+        if (!(_v >= T(0) && _u + _v <= T(1)))
+          return false;
+
+        _t = edge2.Dot(q) * invDet;
+        return true;
+      }
+
+      /// \brief Check if a ray (origin, direction) intersects the triangle.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return A boolean and T tuple. The boolean value is true if the
+      /// ray intersects the triangle between the distances _min and _max
+      /// from _origin. The T is the distance from _origin to the
+      /// intersection point minus _min, as in AxisAlignedBox::IntersectDist,
+      /// or zero when the boolean value is false.
+      public: std::tuple<bool, T> IntersectDist(const Vector3<T> &_origin,
+                                                const Vector3<T> &_dir,
+                                                const T _min,
+                                                const T _max) const
+      {
+        const Vector3<T> dir = _dir.Normalized();
+        T t, u, v;
+        if (RayIntersection(this->pts[0], this->pts[1], this->pts[2],
+                            _origin, dir, t, u, v) &&
+            t >= _min && t <= _max)
+        {
+          return std::make_tuple(true, t - _min);
+        }
+        return std::make_tuple(false, T(0));
+      }
+
+      /// \brief Find the closest triangle of an indexed triangle buffer hit
+      /// by a ray. Every triangle is tested, see BoundingVolumeHierarchy to
+      /// only test the triangles near the ray in large meshes.
+      /// \param[in] _vertices Vertex buffer.
+      /// \param[in] _indices Index buffer with three indices into
+      /// _vertices for each triangle.
+      /// \param[in] _triangleCount Number of triangles, which is a third of
+      /// the number of indices.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \param[out] _triangle Index of the closest triangle hit. The lowest
+      /// index is reported when several triangles are hit at the same
+      /// distance. Only valid if the return value is true.
+      /// \param[out] _dist Distance from _origin to the closest intersection
+      /// point minus _min, as in IntersectDist. Only valid if the return
+      /// value is true.
+      /// \return True if the ray hits a triangle.
+      public: template<typename Index>
+              static bool ClosestHit(const Vector3<T> *_vertices,
+                                     const Index *_indices,
+                                     const std::size_t _triangleCount,
+                                     const Vector3<T> &_origin,
+                                     const Vector3<T> &_dir,
+                                     const T _min, const T _max,
+                                     std::size_t &_triangle, T &_dist)
+      {
+        const Vector3<T> dir = _dir.Normalized();
+        bool hit = false;
+        T closest = _max;
+        for (std::size_t i = 0; i < _triangleCount; ++i)
+        {
+          const Index *tri = _indices + 3 * i;
+          T t, u, v;
+          if (RayIntersection(_vertices[tri[0]], _vertices[tri[1]],
+                              _vertices[tri[2]], _origin, dir, t, u, v) &&
+              t >= _min && (t < closest || (!hit && t <= closest)))
+          {
+            hit = true;
+            closest = t;
+            _triangle = i;
+          }
+        }
+        if (hit)
+          _dist = closest - _min;
+        return hit;
+      }
+
+      /// \brief Find the closest triangle of an indexed triangle buffer hit
+      /// by each ray of a batch, as ClosestHit does for a single ray.
+      /// \param[in] _vertices Vertex buffer.
+      /// \param[in] _indices Index buffer with three indices into
+      /// _vertices for each triangle.
+      /// \param[in] _triangleCount Number of triangles, which is a third of
+      /// the number of indices.
+      /// \param[in] _origins Array of _rayCount ray origins.
+      /// \param[in] _dirs Array of _rayCount ray directions. They will be
+      /// normalized.
+      /// \param[in] _rayCount Number of rays.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \param[out] _triangles Array of at least _rayCount values, written
+      /// with the index of the closest triangle hit by each ray, or
+      /// std::numeric_limits<std::size_t>::max() if the ray hits none.
+      /// \param[out] _distances Array of at least _rayCount values, written
+      /// with the distance of each hit as in ClosestHit, or zero.
+      public: template<typename Index>
+              static void ClosestHits(const Vector3<T> *_vertices,
+                                      const Index *_indices,
+                                      const std::size_t _triangleCount,
+                                      const Vector3<T> *_origins,
+                                      const Vector3<T> *_dirs,
+                                      const std::size_t _rayCount,
+                                      const T _min, const T _max,
+                                      std::size_t *_triangles,
+                                      T *_distances)
+      {
+        for (std::size_t r = 0; r < _rayCount; ++r)
+        {
+          if (!ClosestHit(_vertices, _indices, _triangleCount, _origins[r],
+                          _dirs[r], _min, _max, _triangles[r],
+                          _distances[r]))
+          {
+            _triangles[r] = std::numeric_limits<std::size_t>::max();
+            _distances[r] = T(0);
+          }
+        }
+      }
+
       /// \brief Get the length of the triangle's perimeter.
       /// \return Sum of the triangle's line segments.
       public: T Perimeter() const
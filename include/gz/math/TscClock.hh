@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_TSCCLOCK_HH_
+#define GZ_MATH_TSCCLOCK_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+
+#include <gz/math/config.hh>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #define IGNITION_MATH_TSC_X86 1
+  #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+  #define IGNITION_MATH_TSC_X86 1
+  #include <x86intrin.h>
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+  #define IGNITION_MATH_TSC_ARM64 1
+#endif
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class TscClock TscClock.hh ignition/math/TscClock.hh
+    /// \brief A steady clock that reads the CPU time stamp counter, with
+    /// rdtsc on x86 and the virtual counter cntvct_el0 on 64 bit ARM. Both
+    /// are read without a system call, so now() takes a few nanoseconds,
+    /// also in virtual machines where std::chrono::steady_clock may not be
+    /// served from user space. On other platforms, it falls back to
+    /// std::chrono::steady_clock.
+    ///
+    /// The ARM counter reports its frequency. The x86 counter is calibrated
+    /// against std::chrono::steady_clock for 10 ms on the first call to
+    /// now() or Calibrate(), which costs that delay once per process. The
+    /// clock assumes an invariant time stamp counter, synchronized between
+    /// cores, which is the case of x86 processors from the last decade.
+    ///
+    /// TscClock meets the requirements of the standard Clock named
+    /// requirement, so it can be used with std::chrono and BasicStopwatch.
+    class TscClock
+    {
+      /// \brief Arithmetic type of the durations.
+      public: using rep = int64_t;
+
+      /// \brief Tick period of the durations, in seconds.
+      public: using period = std::nano;
+
+      /// \brief Duration type, in nanoseconds.
+      public: using duration = std::chrono::nanoseconds;
+
+      /// \brief Time point type. The epoch is the calibration.
+      public: using time_point = std::chrono::time_point<TscClock>;
+
+      /// \brief The clock never goes backwards.
+      public: static constexpr bool is_steady = true;
+
+      /// \brief Get the current time.
+      /// \return The time since the calibration.
+      public: static time_point now() noexcept
+      {
+        const Calibration &calibration = TscClock::Calibrated();
+        const auto ticks =
+          static_cast<int64_t>(TscClock::Ticks() - calibration.ticks);
+        return time_point(duration(static_cast<rep>(
+            static_cast<double>(ticks) * calibration.nanosecondsPerTick)));
+      }
+
+      /// \brief Read the raw counter.
+      /// \return Number of ticks of the counter.
+      public: static uint64_t Ticks() noexcept
+      {
+#if defined(IGNITION_MATH_TSC_X86)
+        return __rdtsc();
+#elif defined(IGNITION_MATH_TSC_ARM64)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<duration>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+      }
+
+      /// \brief Get whether the clock reads a hardware counter, or falls
+      /// back to std::chrono::steady_clock.
+      /// \return True for a hardware counter.
+      public: static constexpr bool Hardware()
+      {
+#if defined(IGNITION_MATH_TSC_X86) || defined(IGNITION_MATH_TSC_ARM64)
+        return true;
+#else
+        return false;
+#endif
+      }
+
+      /// \brief Calibrate the clock, if it has not been calibrated yet, so
+      /// that the first call to now() in a timed loop does not wait for the
+      /// calibration.
+      public: static void Calibrate()
+      {
+        TscClock::Calibrated();
+      }
+
+      /// \brief Get the frequency of the counter.
+      /// \return Number of ticks per second, as calibrated.
+      public: static double TicksPerSecond()
+      {
+        return 1e9 / TscClock::Calibrated().nanosecondsPerTick;
+      }
+
+      /// \brief Counter value at the epoch and tick period.
+      private: struct Calibration
+      {
+        /// \brief Counter value at the epoch.
+        uint64_t ticks;
+
+        /// \brief Duration of a tick, in nanoseconds.
+        double nanosecondsPerTick;
+      };
+
+      /// \brief Get the calibration, measured on the first call.
+      /// \return The calibration.
+      private: static const Calibration &Calibrated() noexcept
+      {
+        static const Calibration calibration = TscClock::Measure();
+        return calibration;
+      }
+
+      /// \brief Measure the tick period of the counter.
+      /// \return The calibration, with the current counter value as epoch.
+      private: static Calibration Measure() noexcept
+      {
+#if defined(IGNITION_MATH_TSC_X86)
+        // Count the ticks during an interval of the steady clock. The two
+        // clocks are read next to each other on both ends of the interval.
+        using steady = std::chrono::steady_clock;
+        const steady::time_point start = steady::now();
+        const uint64_t startTicks = TscClock::Ticks();
+        steady::time_point end = start;
+        while (end - start < std::chrono::milliseconds(10))
+          end = steady::now();
+        const uint64_t endTicks = TscClock::Ticks();
+        const double elapsed = static_cast<double>(
+            std::chrono::duration_cast<duration>(end - start).count());
+        return {startTicks,
+                elapsed / static_cast<double>(endTicks - startTicks)};
+#elif defined(IGNITION_MATH_TSC_ARM64)
+        uint64_t frequency;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+        return {TscClock::Ticks(), 1e9 / static_cast<double>(frequency)};
+#else
+        return {TscClock::Ticks(), 1.0};
+#endif
+      }
+    };
+    }
+  }
+}
+#endif
@@ -46,35 +46,29 @@ namespace ignition
       public: static const Vector2 NaN;
 
       /// \brief Default Constructor
-      public: Vector2()
+      public: constexpr Vector2()
+      : data{0, 0}
       {
-        this->data[0] = 0;
-        this->data[1] = 0;
       }
 
       /// \brief Constructor
       /// \param[in] _x value along x
       /// \param[in] _y value along y
-      public: Vector2(const T &_x, const T &_y)
+      public: constexpr Vector2(const T &_x, const T &_y)
+      : data{_x, _y}
       {
-        this->data[0] = _x;
-        this->data[1] = _y;
       }
 
       /// \brief Copy constructor
       /// \param[in] _v the value
-      public: Vector2(const Vector2<T> &_v)
-      {
-        this->data[0] = _v[0];
-        this->data[1] = _v[1];
-      }
+      public: constexpr Vector2(const Vector2<T> &_v) = default;
 
       /// \brief Destructor
-      public: virtual ~Vector2() {}
+      public: virtual ~Vector2() = default;
 
       /// \brief Return the sum of the values
       /// \return the sum
-      public: T Sum() const
+      public: constexpr T Sum() const
       {
         return this->data[0] + this->data[1];
       }
@@ -97,7 +91,7 @@ namespace ignition
 
       /// \brief Returns the square of the length (magnitude) of the vector
       /// \return The squared length
-      public: T SquaredLength() const
+      public: constexpr T SquaredLength() const
       {
         return
           this->data[0] * this->data[0] +
@@ -146,7 +140,7 @@ namespace ignition
       /// \brief Set the contents of the vector
       /// \param[in] _x value along x
       /// \param[in] _y value along y
-      public: void Set(T _x, T _y)
+      public: constexpr void Set(T _x, T _y)
       {
         this->data[0] = _x;
         this->data[1] = _y;
@@ -155,7 +149,7 @@ namespace ignition
       /// \brief Get the dot product of this vector and _v
       /// \param[in] _v the vector
       /// \return The dot product
-      public: T Dot(const Vector2<T> &_v) const
+      public: constexpr T Dot(const Vector2<T> &_v) const
       {
         return (this->data[0] * _v[0]) + (this->data[1] * _v[1]);
       }
@@ -196,7 +190,7 @@ namespace ignition
       /// \brief Set this vector's components to the maximum of itself and the
       ///        passed in vector
       /// \param[in] _v the maximum clamping vector
-      public: void Max(const Vector2<T> &_v)
+      public: constexpr void Max(const Vector2<T> &_v)
       {
         this->data[0] = std::max(_v[0], this->data[0]);
         this->data[1] = std::max(_v[1], this->data[1]);
@@ -205,7 +199,7 @@ namespace ignition
       /// \brief Set this vector's components to the minimum of itself and the
       ///        passed in vector
       /// \param[in] _v the minimum clamping vector
-      public: void Min(const Vector2<T> &_v)
+      public: constexpr void Min(const Vector2<T> &_v)
       {
         this->data[0] = std::min(_v[0], this->data[0]);
         this->data[1] = std::min(_v[1], this->data[1]);
@@ -213,14 +207,14 @@ namespace ignition
 
       /// \brief Get the maximum value in the vector
       /// \return the maximum element
-      public: T Max() const
+      public: constexpr T Max() const
       {
         return std::max(this->data[0], this->data[1]);
       }
 
       /// \brief Get the minimum value in the vector
       /// \return the minimum element
-      public: T Min() const
+      public: constexpr T Min() const
       {
         return std::min(this->data[0], this->data[1]);
       }
@@ -228,18 +222,12 @@ namespace ignition
       /// \brief Assignment operator
       /// \param[in] _v a value for x and y element
       /// \return this
-      public: Vector2 &operator=(const Vector2 &_v)
-      {
-        this->data[0] = _v[0];
-        this->data[1] = _v[1];
-
-        return *this;
-      }
+      public: constexpr Vector2 &operator=(const Vector2 &_v) = default;
 
       /// \brief Assignment operator
       /// \param[in] _v the value for x and y element
       /// \return this
-      public: const Vector2 &operator=(T _v)
+      public: constexpr const Vector2 &operator=(T _v)
       {
         this->data[0] = _v;
         this->data[1] = _v;
@@ -250,7 +238,7 @@ namespace ignition
       /// \brief Addition operator
       /// \param[in] _v vector to add
       /// \return sum vector
-      public: Vector2 operator+(const Vector2 &_v) const
+      public: constexpr Vector2 operator+(const Vector2 &_v) const
       {
         return Vector2(this->data[0] + _v[0], this->data[1] + _v[1]);
       }
@@ -258,7 +246,7 @@ namespace ignition
       /// \brief Addition assignment operator
       /// \param[in] _v the vector to add
       // \return this
-      public: const Vector2 &operator+=(const Vector2 &_v)
+      public: constexpr const Vector2 &operator+=(const Vector2 &_v)
       {
         this->data[0] += _v[0];
         this->data[1] += _v[1];
@@ -269,7 +257,7 @@ namespace ignition
       /// \brief Addition operators
       /// \param[in] _s the scalar addend
       /// \return sum vector
-      public: inline Vector2<T> operator+(const T _s) const
+      public: constexpr Vector2<T> operator+(const T _s) const
       {
         return Vector2<T>(this->data[0] + _s,
                           this->data[1] + _s);
@@ -279,8 +267,8 @@ namespace ignition
       /// \param[in] _s the scalar addend
       /// \param[in] _v input vector
       /// \return sum vector
-      public: friend inline Vector2<T> operator+(const T _s,
-                                                 const Vector2<T> &_v)
+      public: friend constexpr Vector2<T> operator+(const T _s,
+                                                    const Vector2<T> &_v)
       {
         return _v + _s;
       }
@@ -288,7 +276,7 @@ namespace ignition
       /// \brief Addition assignment operator
       /// \param[in] _s scalar addend
       /// \return this
-      public: const Vector2<T> &operator+=(const T _s)
+      public: constexpr const Vector2<T> &operator+=(const T _s)
       {
         this->data[0] += _s;
         this->data[1] += _s;
@@ -298,7 +286,7 @@ namespace ignition
 
       /// \brief Negation operator
       /// \return negative of this vector
-      public: inline Vector2 operator-() const
+      public: constexpr Vector2 operator-() const
       {
         return Vector2(-this->data[0], -this->data[1]);
       }
@@ -306,7 +294,7 @@ namespace ignition
       /// \brief Subtraction operator
       /// \param[in] _v the vector to substract
       /// \return the subtracted vector
-      public: Vector2 operator-(const Vector2 &_v) const
+      public: constexpr Vector2 operator-(const Vector2 &_v) const
       {
         return Vector2(this->data[0] - _v[0], this->data[1] - _v[1]);
       }
@@ -314,7 +302,7 @@ namespace ignition
       /// \brief Subtraction assignment operator
       /// \param[in] _v the vector to substract
       /// \return this
-      public: const Vector2 &operator-=(const Vector2 &_v)
+      public: constexpr const Vector2 &operator-=(const Vector2 &_v)
       {
         this->data[0] -= _v[0];
         this->data[1] -= _v[1];
@@ -325,7 +313,7 @@ namespace ignition
       /// \brief Subtraction operators
       /// \param[in] _s the scalar subtrahend
       /// \return difference vector
-      public: inline Vector2<T> operator-(const T _s) const
+      public: constexpr Vector2<T> operator-(const T _s) const
       {
         return Vector2<T>(this->data[0] - _s,
                           this->data[1] - _s);
@@ -335,8 +323,8 @@ namespace ignition
       /// \param[in] _s the scalar minuend
       /// \param[in] _v vector subtrahend
       /// \return difference vector
-      public: friend inline Vector2<T> operator-(const T _s,
-                                                 const Vector2<T> &_v)
+      public: friend constexpr Vector2<T> operator-(const T _s,
+                                                    const Vector2<T> &_v)
       {
         return {_s - _v.X(), _s - _v.Y()};
       }
@@ -344,7 +332,7 @@ namespace ignition
       /// \brief Subtraction assignment operator
       /// \param[in] _s scalar subtrahend
       /// \return this
-      public: const Vector2<T> &operator-=(T _s)
+      public: constexpr const Vector2<T> &operator-=(T _s)
       {
         this->data[0] -= _s;
         this->data[1] -= _s;
@@ -356,7 +344,7 @@ namespace ignition
       /// \remarks this is an element wise division
       /// \param[in] _v a vector
       /// \result a result
-      public: const Vector2 operator/(const Vector2 &_v) const
+      public: constexpr const Vector2 operator/(const Vector2 &_v) const
       {
         return Vector2(this->data[0] / _v[0], this->data[1] / _v[1]);
       }
@@ -365,7 +353,7 @@ namespace ignition
       /// \remarks this is an element wise division
       /// \param[in] _v a vector
       /// \return this
-      public: const Vector2 &operator/=(const Vector2 &_v)
+      public: constexpr const Vector2 &operator/=(const Vector2 &_v)
       {
         this->data[0] /= _v[0];
         this->data[1] /= _v[1];
@@ -376,7 +364,7 @@ namespace ignition
       /// \brief Division operator
       /// \param[in] _v the value
       /// \return a vector
-      public: const Vector2 operator/(T _v) const
+      public: constexpr const Vector2 operator/(T _v) const
       {
         return Vector2(this->data[0] / _v, this->data[1] / _v);
       }
@@ -384,7 +372,7 @@ namespace ignition
       /// \brief Division operator
       /// \param[in] _v the divisor
       /// \return a vector
-      public: const Vector2 &operator/=(T _v)
+      public: constexpr const Vector2 &operator/=(T _v)
       {
         this->data[0] /= _v;
         this->data[1] /= _v;
@@ -395,7 +383,7 @@ namespace ignition
       /// \brief Multiplication operators
       /// \param[in] _v the vector
       /// \return the result
-      public: const Vector2 operator*(const Vector2 &_v) const
+      public: constexpr const Vector2 operator*(const Vector2 &_v) const
       {
         return Vector2(this->data[0] * _v[0], this->data[1] * _v[1]);
       }
@@ -404,7 +392,7 @@ namespace ignition
       /// \remarks this is an element wise multiplication
       /// \param[in] _v the vector
       /// \return this
-      public: const Vector2 &operator*=(const Vector2 &_v)
+      public: constexpr const Vector2 &operator*=(const Vector2 &_v)
       {
         this->data[0] *= _v[0];
         this->data[1] *= _v[1];
@@ -415,7 +403,7 @@ namespace ignition
       /// \brief Multiplication operators
       /// \param[in] _v the scaling factor
       /// \return a scaled vector
-      public: const Vector2 operator*(T _v) const
+      public: constexpr const Vector2 operator*(T _v) const
       {
         return Vector2(this->data[0] * _v, this->data[1] * _v);
       }
@@ -424,8 +412,8 @@ namespace ignition
       /// \param[in] _s the scaling factor
       /// \param[in] _v the vector to scale
       /// \return a scaled vector
-      public: friend inline const Vector2 operator*(const T _s,
-                                                    const Vector2 &_v)
+      public: friend constexpr const Vector2 operator*(const T _s,
+                                                       const Vector2 &_v)
       {
         return Vector2(_v * _s);
       }
@@ -433,7 +421,7 @@ namespace ignition
       /// \brief Multiplication assignment operator
       /// \param[in] _v the scaling factor
       /// \return a scaled vector
-      public: const Vector2 &operator*=(T _v)
+      public: constexpr const Vector2 &operator*=(T _v)
       {
         this->data[0] *= _v;
         this->data[1] *= _v;
@@ -481,7 +469,7 @@ namespace ignition
       /// \brief Array subscript operator
       /// \param[in] _index The index, where 0 == x and 1 == y.
       /// The index is clamped to the range [0,1].
-      public: T &operator[](const std::size_t _index)
+      public: constexpr T &operator[](const std::size_t _index)
       {
         return this->data[clamp(_index, IGN_ZERO_SIZE_T, IGN_ONE_SIZE_T)];
       }
@@ -489,49 +477,49 @@ namespace ignition
       /// \brief Const-qualified array subscript operator
       /// \param[in] _index The index, where 0 == x and 1 == y.
       /// The index is clamped to the range [0,1].
-      public: T operator[](const std::size_t _index) const
+      public: constexpr T operator[](const std::size_t _index) const
       {
         return this->data[clamp(_index, IGN_ZERO_SIZE_T, IGN_ONE_SIZE_T)];
       }
 
       /// \brief Return the x value.
       /// \return Value of the X component.
-      public: inline T X() const
+      public: constexpr T X() const
       {
         return this->data[0];
       }
 
       /// \brief Return the y value.
       /// \return Value of the Y component.
-      public: inline T Y() const
+      public: constexpr T Y() const
       {
         return this->data[1];
       }
 
       /// \brief Return a mutable x value.
       /// \return Value of the X component.
-      public: inline T &X()
+      public: constexpr T &X()
       {
         return this->data[0];
       }
 
       /// \brief Return a mutable y value.
       /// \return Value of the Y component.
-      public: inline T &Y()
+      public: constexpr T &Y()
       {
         return this->data[1];
       }
 
       /// \brief Set the x value.
       /// \param[in] _v Value for the x component.
-      public: inline void X(const T &_v)
+      public: constexpr void X(const T &_v)
       {
         this->data[0] = _v;
       }
 
       /// \brief Set the y value.
       /// \param[in] _v Value for the y component.
-      public: inline void Y(const T &_v)
+      public: constexpr void Y(const T &_v)
       {
         this->data[1] = _v;
       }
@@ -551,7 +539,7 @@ namespace ignition
       /// \param[in] _pt Vector to compare.
       /// \return True if this vector's first or second value is less than
       /// the given vector's first or second value.
-      public: bool operator<(const Vector2<T> &_pt) const
+      public: constexpr bool operator<(const Vector2<T> &_pt) const
       {
         return this->data[0] < _pt[0] || this->data[1] < _pt[1];
       }
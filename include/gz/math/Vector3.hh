@@ -22,6 +22,8 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <string_view>
+#include <vector>
 
 #include <gz/math/Helpers.hh>
 #include <gz/math/config.hh>
@@ -59,39 +61,30 @@ namespace ignition
       public: static const Vector3 NaN;
 
       /// \brief Constructor
-      public: Vector3()
+      public: constexpr Vector3()
+      : data{0, 0, 0}
       {
-        this->data[0] = 0;
-        this->data[1] = 0;
-        this->data[2] = 0;
       }
 
       /// \brief Constructor
       /// \param[in] _x value along x
       /// \param[in] _y value along y
       /// \param[in] _z value along z
-      public: Vector3(const T &_x, const T &_y, const T &_z)
+      public: constexpr Vector3(const T &_x, const T &_y, const T &_z)
+      : data{_x, _y, _z}
       {
-        this->data[0] = _x;
-        this->data[1] = _y;
-        this->data[2] = _z;
       }
 
       /// \brief Copy constructor
       /// \param[in] _v a vector
-      public: Vector3(const Vector3<T> &_v)
-      {
-        this->data[0] = _v[0];
-        this->data[1] = _v[1];
-        this->data[2] = _v[2];
-      }
+      public: constexpr Vector3(const Vector3<T> &_v) = default;
 
       /// \brief Destructor
-      public: virtual ~Vector3() {}
+      public: virtual ~Vector3() = default;
 
       /// \brief Return the sum of the values
       /// \return the sum
-      public: T Sum() const
+      public: constexpr T Sum() const
       {
         return this->data[0] + this->data[1] + this->data[2];
       }
@@ -126,7 +119,7 @@ namespace ignition
 
       /// \brief Return the square of the length (magnitude) of the vector
       /// \return the squared length
-      public: T SquaredLength() const
+      public: constexpr T SquaredLength() const
       {
         return
           this->data[0] * this->data[0] +
@@ -182,7 +175,7 @@ namespace ignition
       /// \param[in] _x value along x
       /// \param[in] _y value along y
       /// \param[in] _z value aling z
-      public: inline void Set(T _x = 0, T _y = 0, T _z = 0)
+      public: constexpr void Set(T _x = 0, T _y = 0, T _z = 0)
       {
         this->data[0] = _x;
         this->data[1] = _y;
@@ -192,7 +185,7 @@ namespace ignition
       /// \brief Return the cross product of this vector with another vector.
       /// \param[in] _v a vector
       /// \return the cross product
-      public: Vector3 Cross(const Vector3<T> &_v) const
+      public: constexpr Vector3 Cross(const Vector3<T> &_v) const
       {
         return Vector3(this->data[1] * _v[2] - this->data[2] * _v[1],
                        this->data[2] * _v[0] - this->data[0] * _v[2],
@@ -202,7 +195,7 @@ namespace ignition
       /// \brief Return the dot product of this vector and another vector
       /// \param[in] _v the vector
       /// \return the dot product
-      public: T Dot(const Vector3<T> &_v) const
+      public: constexpr T Dot(const Vector3<T> &_v) const
       {
         return this->data[0] * _v[0] +
                this->data[1] * _v[1] +
@@ -278,7 +271,7 @@ namespace ignition
       /// \brief Set this vector's components to the maximum of itself and the
       ///        passed in vector
       /// \param[in] _v the maximum clamping vector
-      public: void Max(const Vector3<T> &_v)
+      public: constexpr void Max(const Vector3<T> &_v)
       {
         if (_v[0] > this->data[0])
           this->data[0] = _v[0];
@@ -291,7 +284,7 @@ namespace ignition
       /// \brief Set this vector's components to the minimum of itself and the
       ///        passed in vector
       /// \param[in] _v the minimum clamping vector
-      public: void Min(const Vector3<T> &_v)
+      public: constexpr void Min(const Vector3<T> &_v)
       {
         if (_v[0] < this->data[0])
           this->data[0] = _v[0];
@@ -303,14 +296,14 @@ namespace ignition
 
       /// \brief Get the maximum value in the vector
       /// \return the maximum element
-      public: T Max() const
+      public: constexpr T Max() const
       {
         return std::max(std::max(this->data[0], this->data[1]), this->data[2]);
       }
 
       /// \brief Get the minimum value in the vector
       /// \return the minimum element
-      public: T Min() const
+      public: constexpr T Min() const
       {
         return std::min(std::min(this->data[0], this->data[1]), this->data[2]);
       }
@@ -318,19 +311,12 @@ namespace ignition
       /// \brief Assignment operator
       /// \param[in] _v a new value
       /// \return this
-      public: Vector3 &operator=(const Vector3<T> &_v)
-      {
-        this->data[0] = _v[0];
-        this->data[1] = _v[1];
-        this->data[2] = _v[2];
-
-        return *this;
-      }
+      public: constexpr Vector3 &operator=(const Vector3<T> &_v) = default;
 
       /// \brief Assignment operator
       /// \param[in] _v assigned to all elements
       /// \return this
-      public: Vector3 &operator=(T _v)
+      public: constexpr Vector3 &operator=(T _v)
       {
         this->data[0] = _v;
         this->data[1] = _v;
@@ -342,7 +328,7 @@ namespace ignition
       /// \brief Addition operator
       /// \param[in] _v vector to add
       /// \return the sum vector
-      public: Vector3 operator+(const Vector3<T> &_v) const
+      public: constexpr Vector3 operator+(const Vector3<T> &_v) const
       {
         return Vector3(this->data[0] + _v[0],
                        this->data[1] + _v[1],
@@ -352,7 +338,7 @@ namespace ignition
       /// \brief Addition assignment operator
       /// \param[in] _v vector to add
       /// \return the sum vector
-      public: const Vector3 &operator+=(const Vector3<T> &_v)
+      public: constexpr const Vector3 &operator+=(const Vector3<T> &_v)
       {
         this->data[0] += _v[0];
         this->data[1] += _v[1];
@@ -364,7 +350,7 @@ namespace ignition
       /// \brief Addition operators
       /// \param[in] _s the scalar addend
       /// \return sum vector
-      public: inline Vector3<T> operator+(const T _s) const
+      public: constexpr Vector3<T> operator+(const T _s) const
       {
         return Vector3<T>(this->data[0] + _s,
                           this->data[1] + _s,
@@ -375,8 +361,8 @@ namespace ignition
       /// \param[in] _s the scalar addend
       /// \param[in] _v input vector
       /// \return sum vector
-      public: friend inline Vector3<T> operator+(const T _s,
-                                                 const Vector3<T> &_v)
+      public: friend constexpr Vector3<T> operator+(const T _s,
+                                                    const Vector3<T> &_v)
       {
         return {_v.X() + _s, _v.Y() + _s, _v.Z() + _s};
       }
@@ -384,7 +370,7 @@ namespace ignition
       /// \brief Addition assignment operator
       /// \param[in] _s scalar addend
       /// \return this
-      public: const Vector3<T> &operator+=(const T _s)
+      public: constexpr const Vector3<T> &operator+=(const T _s)
       {
         this->data[0] += _s;
         this->data[1] += _s;
@@ -395,7 +381,7 @@ namespace ignition
 
       /// \brief Negation operator
       /// \return negative of this vector
-      public: inline Vector3 operator-() const
+      public: constexpr Vector3 operator-() const
       {
         return Vector3(-this->data[0], -this->data[1], -this->data[2]);
       }
@@ -403,7 +389,7 @@ namespace ignition
       /// \brief Subtraction operators
       /// \param[in] _pt a vector to substract
       /// \return a vector after the substraction
-      public: inline Vector3<T> operator-(const Vector3<T> &_pt) const
+      public: constexpr Vector3<T> operator-(const Vector3<T> &_pt) const
       {
         return Vector3(this->data[0] - _pt[0],
                        this->data[1] - _pt[1],
@@ -413,7 +399,7 @@ namespace ignition
       /// \brief Subtraction assignment operators
       /// \param[in] _pt subtrahend
       /// \return a vector after the substraction
-      public: const Vector3<T> &operator-=(const Vector3<T> &_pt)
+      public: constexpr const Vector3<T> &operator-=(const Vector3<T> &_pt)
       {
         this->data[0] -= _pt[0];
         this->data[1] -= _pt[1];
@@ -425,7 +411,7 @@ namespace ignition
       /// \brief Subtraction operators
       /// \param[in] _s the scalar subtrahend
       /// \return difference vector
-      public: inline Vector3<T> operator-(const T _s) const
+      public: constexpr Vector3<T> operator-(const T _s) const
       {
         return Vector3<T>(this->data[0] - _s,
                           this->data[1] - _s,
@@ -436,8 +422,8 @@ namespace ignition
       /// \param[in] _s the scalar minuend
       /// \param[in] _v vector subtrahend
       /// \return difference vector
-      public: friend inline Vector3<T> operator-(const T _s,
-                                                 const Vector3<T> &_v)
+      public: friend constexpr Vector3<T> operator-(const T _s,
+                                                    const Vector3<T> &_v)
       {
         return {_s - _v.X(), _s - _v.Y(), _s - _v.Z()};
       }
@@ -445,7 +431,7 @@ namespace ignition
       /// \brief Subtraction assignment operator
       /// \param[in] _s scalar subtrahend
       /// \return this
-      public: const Vector3<T> &operator-=(const T _s)
+      public: constexpr const Vector3<T> &operator-=(const T _s)
       {
         this->data[0] -= _s;
         this->data[1] -= _s;
@@ -458,7 +444,7 @@ namespace ignition
       /// \remarks this is an element wise division
       /// \param[in] _pt the vector divisor
       /// \return a vector
-      public: const Vector3<T> operator/(const Vector3<T> &_pt) const
+      public: constexpr const Vector3<T> operator/(const Vector3<T> &_pt) const
       {
         return Vector3(this->data[0] / _pt[0],
                        this->data[1] / _pt[1],
@@ -469,7 +455,7 @@ namespace ignition
       /// \remarks this is an element wise division
       /// \param[in] _pt the vector divisor
       /// \return a vector
-      public: const Vector3<T> &operator/=(const Vector3<T> &_pt)
+      public: constexpr const Vector3<T> &operator/=(const Vector3<T> &_pt)
       {
         this->data[0] /= _pt[0];
         this->data[1] /= _pt[1];
@@ -482,7 +468,7 @@ namespace ignition
       /// \remarks this is an element wise division
       /// \param[in] _v the divisor
       /// \return a vector
-      public: const Vector3<T> operator/(T _v) const
+      public: constexpr const Vector3<T> operator/(T _v) const
       {
         return Vector3(this->data[0] / _v,
                        this->data[1] / _v,
@@ -493,7 +479,7 @@ namespace ignition
       /// \remarks this is an element wise division
       /// \param[in] _v the divisor
       /// \return this
-      public: const Vector3<T> &operator/=(T _v)
+      public: constexpr const Vector3<T> &operator/=(T _v)
       {
         this->data[0] /= _v;
         this->data[1] /= _v;
@@ -506,7 +492,7 @@ namespace ignition
       /// \remarks this is an element wise multiplication, not a cross product
       /// \param[in] _p multiplier operator
       /// \return a vector
-      public: Vector3<T> operator*(const Vector3<T> &_p) const
+      public: constexpr Vector3<T> operator*(const Vector3<T> &_p) const
       {
         return Vector3(this->data[0] * _p[0],
                        this->data[1] * _p[1],
@@ -517,7 +503,7 @@ namespace ignition
       /// \remarks this is an element wise multiplication, not a cross product
       /// \param[in] _v a vector
       /// \return this
-      public: const Vector3<T> &operator*=(const Vector3<T> &_v)
+      public: constexpr const Vector3<T> &operator*=(const Vector3<T> &_v)
       {
         this->data[0] *= _v[0];
         this->data[1] *= _v[1];
@@ -529,7 +515,7 @@ namespace ignition
       /// \brief Multiplication operators
       /// \param[in] _s the scaling factor
       /// \return a scaled vector
-      public: inline Vector3<T> operator*(T _s) const
+      public: constexpr Vector3<T> operator*(T _s) const
       {
         return Vector3<T>(this->data[0] * _s,
                           this->data[1] * _s,
@@ -540,7 +526,7 @@ namespace ignition
       /// \param[in] _s the scaling factor
       /// \param[in] _v input vector
       /// \return a scaled vector
-      public: friend inline Vector3<T> operator*(T _s, const Vector3<T> &_v)
+      public: friend constexpr Vector3<T> operator*(T _s, const Vector3<T> &_v)
       {
         return {_v.X() * _s, _v.Y() * _s, _v.Z() * _s};
       }
@@ -548,7 +534,7 @@ namespace ignition
       /// \brief Multiplication operator
       /// \param[in] _v scaling factor
       /// \return this
-      public: const Vector3<T> &operator*=(T _v)
+      public: constexpr const Vector3<T> &operator*=(T _v)
       {
         this->data[0] *= _v;
         this->data[1] *= _v;
@@ -615,7 +601,7 @@ namespace ignition
       /// \param[in] _index The index, where 0 == x, 1 == y, 2 == z.
       /// The index is clamped to the range [0,2].
       /// \return The value.
-      public: T &operator[](const std::size_t _index)
+      public: constexpr T &operator[](const std::size_t _index)
       {
         return this->data[clamp(_index, IGN_ZERO_SIZE_T, IGN_TWO_SIZE_T)];
       }
@@ -624,7 +610,7 @@ namespace ignition
       /// \param[in] _index The index, where 0 == x, 1 == y, 2 == z.
       /// The index is clamped to the range [0,2].
       /// \return The value.
-      public: T operator[](const std::size_t _index) const
+      public: constexpr T operator[](const std::size_t _index) const
       {
         return this->data[clamp(_index, IGN_ZERO_SIZE_T, IGN_TWO_SIZE_T)];
       }
@@ -651,63 +637,63 @@ namespace ignition
 
       /// \brief Get the x value.
       /// \return The x component of the vector
-      public: inline T X() const
+      public: constexpr T X() const
       {
         return this->data[0];
       }
 
       /// \brief Get the y value.
       /// \return The y component of the vector
-      public: inline T Y() const
+      public: constexpr T Y() const
       {
         return this->data[1];
       }
 
       /// \brief Get the z value.
       /// \return The z component of the vector
-      public: inline T Z() const
+      public: constexpr T Z() const
       {
         return this->data[2];
       }
 
       /// \brief Get a mutable reference to the x value.
       /// \return The x component of the vector
-      public: inline T &X()
+      public: constexpr T &X()
       {
         return this->data[0];
       }
 
       /// \brief Get a mutable reference to the y value.
       /// \return The y component of the vector
-      public: inline T &Y()
+      public: constexpr T &Y()
       {
         return this->data[1];
       }
 
       /// \brief Get a mutable reference to the z value.
       /// \return The z component of the vector
-      public: inline T &Z()
+      public: constexpr T &Z()
       {
         return this->data[2];
       }
 
       /// \brief Set the x value.
       /// \param[in] _v Value for the x component.
-      public: inline void X(const T &_v)
+      public: constexpr void X(const T &_v)
       {
         this->data[0] = _v;
       }
 
       /// \brief Set the y value.
       /// \param[in] _v Value for the y component.
-      public: inline void Y(const T &_v)
+      public: constexpr void Y(const T &_v)
       {
         this->data[1] = _v;
       }
 
       /// \brief Set the z value.
       /// \param[in] _v Value for the z component.
-      public: inline void Z(const T &_v)
+      public: constexpr void Z(const T &_v)
       {
         this->data[2] = _v;
       }
@@ -716,7 +702,7 @@ namespace ignition
       /// \param[in] _pt Vector to compare.
       /// \return True if this vector's X(), Y(), or Z() value is less
       /// than the given vector's corresponding values.
-      public: bool operator<(const Vector3<T> &_pt) const
+      public: constexpr bool operator<(const Vector3<T> &_pt) const
       {
         return this->data[0] < _pt[0] || this->data[1] < _pt[1] ||
                this->data[2] < _pt[2];
@@ -752,6 +738,65 @@ namespace ignition
         return _in;
       }
 
+      /// \brief Parse a vector from a white space separated "x y z" text,
+      /// such as the text of an SDF element. The numbers are parsed with
+      /// parseNext, without allocating and independently of the locale.
+      /// \param[in] _text Text to parse.
+      /// \param[out] _v Parsed vector. It is unchanged on failure.
+      /// \return True if _text holds exactly three numbers.
+      public: static bool Parse(std::string_view _text, Vector3<T> &_v)
+      {
+        T x, y, z;
+        if (!parseNext(_text, x) || !parseNext(_text, y) ||
+            !parseNext(_text, z) || !detail::isSpace(_text))
+        {
+          return false;
+        }
+        _v.Set(x, y, z);
+        return true;
+      }
+
+      /// \brief Parse a white space separated list of vectors, such as
+      /// "x0 y0 z0 x1 y1 z1 ...".
+      /// \param[in] _text Text to parse.
+      /// \param[out] _values The vectors are appended to it. It is unchanged
+      /// on failure.
+      /// \return True if _text holds a list of numbers whose length is a
+      /// multiple of three.
+      public: static bool ParseArray(std::string_view _text,
+                                     std::vector<Vector3<T>> &_values)
+      {
+        const std::size_t size = _values.size();
+        T x, y, z;
+        bool complete = true;
+        while (parseNext(_text, x))
+        {
+          complete = parseNext(_text, y) && parseNext(_text, z);
+          if (!complete)
+            break;
+          _values.emplace_back(x, y, z);
+        }
+        if (!complete || !detail::isSpace(_text))
+        {
+          _values.resize(size);
+          return false;
+        }
+        return true;
+      }
+
+      /// \brief Write the vector as "x y z" into a character buffer, with
+      /// formatNumbers. Floating point components are written in the
+      /// shortest form that Parse reads back to the same vector. This does
+      /// not allocate and does not depend on the locale.
+      /// \param[in] _first Start of the buffer.
+      /// \param[in] _last End of the buffer.
+      /// \return Pointer past the last character written, or nullptr if
+      /// the buffer is too small. The output is not null terminated.
+      public: char *ToChars(char *_first, char *_last) const
+      {
+        return formatNumbers(_first, _last, this->data, 3);
+      }
+
       /// \brief The x, y, and z values
       private: T data[3];
     };
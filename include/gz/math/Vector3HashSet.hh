@@ -0,0 +1,376 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_VECTOR3HASHSET_HH_
+#define GZ_MATH_VECTOR3HASHSET_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Hash.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Vector3HashSet Vector3HashSet.hh
+    /// ignition/math/Vector3HashSet.hh
+    /// \brief A set of 3D points that merges points within a tolerance of
+    /// each other, such as to weld the vertices of a mesh. It replaces a
+    /// std::set with WellOrderedVectors: points are stored in insertion
+    /// order in a single array, and found through a flat hash table with
+    /// linear probing over a grid of cells of 16 times the tolerance, in
+    /// constant time and without allocating a node per point.
+    ///
+    /// Two points are merged if each of their components are within the
+    /// tolerance, as with Vector3::Equal. A point is merged with the first
+    /// inserted point within the tolerance, so the result depends on the
+    /// order of insertion when points are chained within the tolerance of
+    /// each other. Points with a NaN component are never merged.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::Vector3HashSet<double> welded(1e-6);
+    /// std::vector<std::size_t> remap;
+    /// for (const auto &vertex : vertices)
+    ///   remap.push_back(welded.Insert(vertex).first);
+    /// ```
+    template<typename T>
+    class Vector3HashSet
+    {
+      /// \brief Index returned by Find when no point is within the
+      /// tolerance.
+      public: static constexpr std::size_t kNotFound =
+          std::numeric_limits<std::size_t>::max();
+
+      /// \brief Constructor.
+      /// \param[in] _tolerance Tolerance of each component. The default
+      /// is the tolerance of WellOrderedVectors. A tolerance that is not
+      /// positive only merges points that are exactly equal.
+      public: explicit Vector3HashSet(const T _tolerance = T(1e-3))
+        : tolerance(_tolerance > 0 ? _tolerance : T(0)),
+          inverse(_tolerance > 0 ? T(1) / (16 * _tolerance) : T(0))
+      {
+      }
+
+      /// \brief Get the tolerance.
+      /// \return The tolerance of each component.
+      public: T Tolerance() const
+      {
+        return this->tolerance;
+      }
+
+      /// \brief Insert a point, unless a point within the tolerance is
+      /// already in the set.
+      /// \param[in] _point The point.
+      /// \return The index of the point in Points(), either the one
+      /// inserted or the one already in the set, and whether the point
+      /// was inserted.
+      public: std::pair<std::size_t, bool> Insert(const Vector3<T> &_point)
+      {
+        const std::size_t found = this->Find(_point);
+        if (found != kNotFound)
+          return std::make_pair(found, false);
+
+        if (2 * (this->points.size() + 1) > this->slots.size())
+          this->Rehash(2 * std::max<std::size_t>(this->slots.size(), 8));
+
+        const std::size_t index = this->points.size();
+        this->points.push_back(_point);
+        this->Place(this->HashOf(this->CellOf(_point)), index);
+        return std::make_pair(index, true);
+      }
+
+      /// \brief Find a point within the tolerance.
+      /// \param[in] _point The point.
+      /// \return Index of the first inserted point within the tolerance,
+      /// or kNotFound.
+      public: std::size_t Find(const Vector3<T> &_point) const
+      {
+        if (this->slots.empty())
+          return kNotFound;
+
+        int side[3];
+        const Cell cell = this->CellOf(_point, side);
+        int neighbors = 0;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          if (side[axis] != 0)
+            neighbors |= 1 << axis;
+        }
+
+        std::size_t best = kNotFound;
+        for (int n = 0; n < 8; ++n)
+        {
+          if ((n & neighbors) != n)
+            continue;
+          Cell neighbor = cell;
+          for (int axis = 0; axis < 3; ++axis)
+          {
+            if (n & (1 << axis))
+              neighbor.c[axis] += side[axis];
+          }
+          best = std::min(best,
+              this->FindInCell(this->HashOf(neighbor), _point));
+        }
+        return best;
+      }
+
+      /// \brief Check if a point within the tolerance is in the set.
+      /// \param[in] _point The point.
+      /// \return True if Find would find a point.
+      public: bool Contains(const Vector3<T> &_point) const
+      {
+        return this->Find(_point) != kNotFound;
+      }
+
+      /// \brief Get the points of the set.
+      /// \return The points, in insertion order.
+      public: const std::vector<Vector3<T>> &Points() const
+      {
+        return this->points;
+      }
+
+      /// \brief Get the number of points.
+      /// \return The number of points.
+      public: std::size_t Size() const
+      {
+        return this->points.size();
+      }
+
+      /// \brief Check if the set has no point.
+      /// \return True if there is no point.
+      public: bool Empty() const
+      {
+        return this->points.empty();
+      }
+
+      /// \brief Remove every point, keeping the memory.
+      public: void Clear()
+      {
+        this->points.clear();
+        std::fill(this->slots.begin(), this->slots.end(), Slot());
+      }
+
+      /// \brief Reserve memory for a number of points, such as the number
+      /// of vertices of a mesh to weld.
+      /// \param[in] _count Number of points.
+      public: void Reserve(const std::size_t _count)
+      {
+        this->points.reserve(_count);
+        std::size_t capacity = 16;
+        while (capacity < 2 * _count)
+          capacity *= 2;
+        if (capacity > this->slots.size())
+          this->Rehash(capacity);
+      }
+
+      /// \brief Cell coordinates are clamped to [-kCellLimit, kCellLimit],
+      /// so that their neighbors do not overflow.
+      private: static constexpr int64_t kCellLimit = int64_t(1) << 62;
+
+      /// \brief Coordinates of a cell.
+      private: struct Cell
+      {
+        /// \brief Coordinates, or the hashes of the components of the
+        /// point when the tolerance is 0.
+        int64_t c[3];
+      };
+
+      /// \brief A slot of the hash table.
+      private: struct Slot
+      {
+        /// \brief High bits of the hash of the cell of the point, as the
+        /// low bits select the first slot to probe.
+        uint32_t hash = 0;
+
+        /// \brief Index of the point plus 1, 0 for an empty slot.
+        uint32_t index = 0;
+      };
+
+      /// \brief Get the cell of a point.
+      /// \param[in] _point The point.
+      /// \param[out] _side For each axis, -1 or 1 if points within the
+      /// tolerance may be in the previous or next cell, or else 0.
+      /// \return The cell.
+      private: Cell CellOf(const Vector3<T> &_point, int (&_side)[3]) const
+      {
+        Cell cell;
+        const double limit = static_cast<double>(kCellLimit);
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          _side[axis] = 0;
+          if (!(this->inverse > 0))
+          {
+            cell.c[axis] = static_cast<int64_t>(HashValue(_point[axis]));
+            continue;
+          }
+
+          // Rounded down without std::floor, which is a call without
+          // SSE4.1, and written so that NaN gives the lowest cell.
+          const double v = static_cast<double>(_point[axis]) *
+              static_cast<double>(this->inverse);
+          if (!(v >= -limit))
+          {
+            cell.c[axis] = -kCellLimit;
+          }
+          else if (v >= limit)
+          {
+            cell.c[axis] = kCellLimit;
+          }
+          else
+          {
+            int64_t c = static_cast<int64_t>(v);
+            c -= static_cast<double>(c) > v;
+            cell.c[axis] = c;
+
+            // Cells are 16 times the tolerance, so that only the points
+            // near a face of their cell have neighbors in the next cell.
+            // The margin of a 64th of a cell covers rounding.
+            const double f = v - static_cast<double>(c);
+            _side[axis] = f < 5.0 / 64 ? -1 : (f > 59.0 / 64 ? 1 : 0);
+          }
+        }
+        return cell;
+      }
+
+      /// \brief Get the cell of a point.
+      /// \param[in] _point The point.
+      /// \return The cell.
+      private: Cell CellOf(const Vector3<T> &_point) const
+      {
+        int side[3];
+        return this->CellOf(_point, side);
+      }
+
+      /// \brief Get the hash of a cell.
+      /// \param[in] _cell The cell.
+      /// \return The hash.
+      private: static std::size_t HashOf(const Cell &_cell)
+      {
+        // A single mix of the coordinates, as a hash is computed for each
+        // probed cell.
+        return static_cast<std::size_t>(HashMix(
+            static_cast<uint64_t>(_cell.c[0]) * 0x9e3779b97f4a7c15ull ^
+            static_cast<uint64_t>(_cell.c[1]) * 0xc2b2ae3d27d4eb4full ^
+            static_cast<uint64_t>(_cell.c[2])));
+      }
+
+      /// \brief Get the bits of a hash stored in a slot.
+      /// \param[in] _hash The hash.
+      /// \return The high bits of the hash.
+      private: static uint32_t Tag(const std::size_t _hash)
+      {
+        return static_cast<uint32_t>(static_cast<uint64_t>(_hash) >> 32);
+      }
+
+      /// \brief Find a point within the tolerance among the points of a
+      /// cell.
+      /// \param[in] _hash Hash of the cell.
+      /// \param[in] _point The point.
+      /// \return Index of the first such point, or kNotFound.
+      private: std::size_t FindInCell(const std::size_t _hash,
+                                      const Vector3<T> &_point) const
+      {
+        const std::size_t mask = this->slots.size() - 1;
+        std::size_t best = kNotFound;
+        for (std::size_t s = _hash & mask; this->slots[s].index != 0;
+             s = (s + 1) & mask)
+        {
+          const Slot &slot = this->slots[s];
+          if (slot.hash != Tag(_hash) || slot.index - 1 >= best)
+            continue;
+          const Vector3<T> &p = this->points[slot.index - 1];
+          if (std::abs(p.X() - _point.X()) <= this->tolerance &&
+              std::abs(p.Y() - _point.Y()) <= this->tolerance &&
+              std::abs(p.Z() - _point.Z()) <= this->tolerance)
+          {
+            best = slot.index - 1;
+          }
+        }
+        return best;
+      }
+
+      /// \brief Place a point in the first free slot from its hash.
+      /// \param[in] _hash Hash of the cell of the point.
+      /// \param[in] _index Index of the point.
+      private: void Place(const std::size_t _hash, const std::size_t _index)
+      {
+        const std::size_t mask = this->slots.size() - 1;
+        std::size_t s = _hash & mask;
+        while (this->slots[s].index != 0)
+          s = (s + 1) & mask;
+        this->slots[s].hash = Tag(_hash);
+        this->slots[s].index = static_cast<uint32_t>(_index + 1);
+      }
+
+      /// \brief Resize the hash table and place the points again.
+      /// \param[in] _capacity Number of slots, a power of 2.
+      private: void Rehash(const std::size_t _capacity)
+      {
+        this->slots.assign(_capacity, Slot());
+        for (std::size_t i = 0; i < this->points.size(); ++i)
+          this->Place(this->HashOf(this->CellOf(this->points[i])), i);
+      }
+
+      /// \brief Tolerance of each component.
+      private: T tolerance;
+
+      /// \brief Inverse of the size of the cells, 0 when the tolerance is
+      /// 0.
+      private: T inverse;
+
+      /// \brief Points in insertion order.
+      private: std::vector<Vector3<T>> points;
+
+      /// \brief Hash table, at most half full.
+      private: std::vector<Slot> slots;
+    };
+
+    /// \brief Weld the vertices of a mesh, merging vertices within a
+    /// tolerance of each other with a Vector3HashSet.
+    /// \param[in] _vertices The vertices.
+    /// \param[in] _tolerance Tolerance of each component.
+    /// \param[out] _welded The welded vertices, in order of first use.
+    /// \param[out] _remap Index in _welded of each vertex, to rewrite the
+    /// indices of the triangles.
+    template<typename T>
+    void WeldVertices(const std::vector<Vector3<T>> &_vertices,
+                      const T _tolerance,
+                      std::vector<Vector3<T>> &_welded,
+                      std::vector<std::size_t> &_remap)
+    {
+      Vector3HashSet<T> set(_tolerance);
+      _remap.resize(_vertices.size());
+      for (std::size_t i = 0; i < _vertices.size(); ++i)
+        _remap[i] = set.Insert(_vertices[i]).first;
+      _welded = set.Points();
+    }
+    }
+  }
+}
+#endif
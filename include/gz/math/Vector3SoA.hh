@@ -0,0 +1,446 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_VECTOR3SOA_HH_
+#define GZ_MATH_VECTOR3SOA_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Vector3SoA Vector3SoA.hh ignition/math/Vector3SoA.hh
+    /// \brief A structure-of-arrays container of 3D vectors.
+    ///
+    /// Vector3<T> stores its three components next to each other, so a
+    /// std::vector<Vector3<T>> interleaves x, y and z in memory. Vector3SoA
+    /// keeps each component in its own contiguous array instead, which
+    /// lets the batch operations below be written as simple loops over
+    /// plain arrays that compilers auto-vectorize.
+    ///
+    /// Individual elements can be read and written as Vector3<T>, and the
+    /// component arrays are exposed through XData(), YData() and ZData() to
+    /// interoperate with other libraries without copying.
+    ///
+    /// Batch operations that produce one scalar per element write into a
+    /// caller provided std::vector, which is only reallocated when its
+    /// capacity is too small.
+    template<typename T>
+    class Vector3SoA
+    {
+      /// \brief Default constructor, creates an empty container.
+      public: Vector3SoA() = default;
+
+      /// \brief Constructor, creates _size zero vectors.
+      /// \param[in] _size Number of elements.
+      public: explicit Vector3SoA(const std::size_t _size)
+        : x(_size, T(0)), y(_size, T(0)), z(_size, T(0))
+      {
+      }
+
+      /// \brief Constructor from an array of Vector3.
+      /// \param[in] _v Vectors to copy.
+      public: explicit Vector3SoA(const std::vector<Vector3<T>> &_v)
+      {
+        this->Assign(_v);
+      }
+
+      /// \brief Replace the contents with a copy of an array of Vector3.
+      /// \param[in] _v Vectors to copy.
+      public: void Assign(const std::vector<Vector3<T>> &_v)
+      {
+        this->Resize(_v.size());
+        for (std::size_t i = 0; i < _v.size(); ++i)
+        {
+          this->x[i] = _v[i].X();
+          this->y[i] = _v[i].Y();
+          this->z[i] = _v[i].Z();
+        }
+      }
+
+      /// \brief Copy the contents into an array of Vector3.
+      /// \param[out] _v Destination, resized to Size().
+      public: void CopyTo(std::vector<Vector3<T>> &_v) const
+      {
+        _v.resize(this->Size());
+        for (std::size_t i = 0; i < this->Size(); ++i)
+          _v[i].Set(this->x[i], this->y[i], this->z[i]);
+      }
+
+      /// \brief Get the contents as an array of Vector3.
+      /// \return A copy of the elements.
+      public: std::vector<Vector3<T>> ToVector() const
+      {
+        std::vector<Vector3<T>> result;
+        this->CopyTo(result);
+        return result;
+      }
+
+      /// \brief Get the number of elements.
+      /// \return Number of elements.
+      public: std::size_t Size() const
+      {
+        return this->x.size();
+      }
+
+      /// \brief Check if the container is empty.
+      /// \return True if there are no elements.
+      public: bool Empty() const
+      {
+        return this->x.empty();
+      }
+
+      /// \brief Change the number of elements. New elements are zero.
+      /// \param[in] _size New number of elements.
+      public: void Resize(const std::size_t _size)
+      {
+        this->x.resize(_size, T(0));
+        this->y.resize(_size, T(0));
+        this->z.resize(_size, T(0));
+      }
+
+      /// \brief Reserve storage for a number of elements.
+      /// \param[in] _size Number of elements to reserve.
+      public: void Reserve(const std::size_t _size)
+      {
+        this->x.reserve(_size);
+        this->y.reserve(_size);
+        this->z.reserve(_size);
+      }
+
+      /// \brief Remove all the elements.
+      public: void Clear()
+      {
+        this->x.clear();
+        this->y.clear();
+        this->z.clear();
+      }
+
+      /// \brief Append an element.
+      /// \param[in] _v Vector to append.
+      public: void PushBack(const Vector3<T> &_v)
+      {
+        this->x.push_back(_v.X());
+        this->y.push_back(_v.Y());
+        this->z.push_back(_v.Z());
+      }
+
+      /// \brief Get an element.
+      /// \param[in] _index Index of the element, must be lower than Size().
+      /// \return A copy of the element.
+      public: Vector3<T> operator[](const std::size_t _index) const
+      {
+        return Vector3<T>(this->x[_index], this->y[_index], this->z[_index]);
+      }
+
+      /// \brief Set an element.
+      /// \param[in] _index Index of the element, must be lower than Size().
+      /// \param[in] _v New value.
+      public: void Set(const std::size_t _index, const Vector3<T> &_v)
+      {
+        this->x[_index] = _v.X();
+        this->y[_index] = _v.Y();
+        this->z[_index] = _v.Z();
+      }
+
+      /// \brief Get the x components.
+      /// \return Pointer to the Size() contiguous x components.
+      public: T *XData() { return this->x.data(); }
+
+      /// \brief Get the x components.
+      /// \return Pointer to the Size() contiguous x components.
+      public: const T *XData() const { return this->x.data(); }
+
+      /// \brief Get the y components.
+      /// \return Pointer to the Size() contiguous y components.
+      public: T *YData() { return this->y.data(); }
+
+      /// \brief Get the y components.
+      /// \return Pointer to the Size() contiguous y components.
+      public: const T *YData() const { return this->y.data(); }
+
+      /// \brief Get the z components.
+      /// \return Pointer to the Size() contiguous z components.
+      public: T *ZData() { return this->z.data(); }
+
+      /// \brief Get the z components.
+      /// \return Pointer to the Size() contiguous z components.
+      public: const T *ZData() const { return this->z.data(); }
+
+      /// \brief Element-wise sum of two containers, _out[i] = _a[i] + _b[i].
+      /// _a and _b must have the same size. _out may alias either input.
+      /// \param[in] _a First operand.
+      /// \param[in] _b Second operand.
+      /// \param[out] _out Result, resized to _a.Size().
+      public: static void Add(const Vector3SoA<T> &_a,
+                              const Vector3SoA<T> &_b,
+                              Vector3SoA<T> &_out)
+      {
+        const std::size_t n = _a.Size();
+        _out.Resize(n);
+        Kernel(n, _a.x.data(), _b.x.data(), _out.x.data(), std::plus<T>());
+        Kernel(n, _a.y.data(), _b.y.data(), _out.y.data(), std::plus<T>());
+        Kernel(n, _a.z.data(), _b.z.data(), _out.z.data(), std::plus<T>());
+      }
+
+      /// \brief Element-wise difference of two containers,
+      /// _out[i] = _a[i] - _b[i]. _a and _b must have the same size. _out
+      /// may alias either input.
+      /// \param[in] _a First operand.
+      /// \param[in] _b Second operand.
+      /// \param[out] _out Result, resized to _a.Size().
+      public: static void Sub(const Vector3SoA<T> &_a,
+                              const Vector3SoA<T> &_b,
+                              Vector3SoA<T> &_out)
+      {
+        const std::size_t n = _a.Size();
+        _out.Resize(n);
+        Kernel(n, _a.x.data(), _b.x.data(), _out.x.data(), std::minus<T>());
+        Kernel(n, _a.y.data(), _b.y.data(), _out.y.data(), std::minus<T>());
+        Kernel(n, _a.z.data(), _b.z.data(), _out.z.data(), std::minus<T>());
+      }
+
+      /// \brief Element-wise cross product, _out[i] = _a[i].Cross(_b[i]).
+      /// _a and _b must have the same size. _out must not alias the inputs.
+      /// \param[in] _a First operand.
+      /// \param[in] _b Second operand.
+      /// \param[out] _out Result, resized to _a.Size().
+      public: static void Cross(const Vector3SoA<T> &_a,
+                                const Vector3SoA<T> &_b,
+                                Vector3SoA<T> &_out)
+      {
+        const std::size_t n = _a.Size();
+        _out.Resize(n);
+        const T *ax = _a.x.data(), *ay = _a.y.data(), *az = _a.z.data();
+        const T *bx = _b.x.data(), *by = _b.y.data(), *bz = _b.z.data();
+        T *ox = _out.x.data(), *oy = _out.y.data(), *oz = _out.z.data();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          ox[i] = ay[i] * bz[i] - az[i] * by[i];
+          oy[i] = az[i] * bx[i] - ax[i] * bz[i];
+          oz[i] = ax[i] * by[i] - ay[i] * bx[i];
+        }
+      }
+
+      /// \brief Element-wise dot product, _out[i] = this[i].Dot(_v[i]).
+      /// \param[in] _v Other operand, must have the same size.
+      /// \param[out] _out Result, resized to Size().
+      public: void Dot(const Vector3SoA<T> &_v, std::vector<T> &_out) const
+      {
+        const std::size_t n = this->Size();
+        _out.resize(n);
+        const T *ax = this->x.data(), *ay = this->y.data(),
+                *az = this->z.data();
+        const T *bx = _v.x.data(), *by = _v.y.data(), *bz = _v.z.data();
+        T *o = _out.data();
+        for (std::size_t i = 0; i < n; ++i)
+          o[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+      }
+
+      /// \brief Dot product of every element with one vector,
+      /// _out[i] = this[i].Dot(_v).
+      /// \param[in] _v Vector to project on.
+      /// \param[out] _out Result, resized to Size().
+      public: void Dot(const Vector3<T> &_v, std::vector<T> &_out) const
+      {
+        const std::size_t n = this->Size();
+        _out.resize(n);
+        const T *ax = this->x.data(), *ay = this->y.data(),
+                *az = this->z.data();
+        const T vx = _v.X(), vy = _v.Y(), vz = _v.Z();
+        T *o = _out.data();
+        for (std::size_t i = 0; i < n; ++i)
+          o[i] = ax[i] * vx + ay[i] * vy + az[i] * vz;
+      }
+
+      /// \brief Squared length of every element.
+      /// \param[out] _out Result, resized to Size().
+      public: void SquaredLength(std::vector<T> &_out) const
+      {
+        this->Dot(*this, _out);
+      }
+
+      /// \brief Length of every element.
+      /// \param[out] _out Result, resized to Size().
+      public: void Length(std::vector<T> &_out) const
+      {
+        this->SquaredLength(_out);
+        T *o = _out.data();
+        for (std::size_t i = 0; i < _out.size(); ++i)
+          o[i] = static_cast<T>(std::sqrt(o[i]));
+      }
+
+      /// \brief Normalize every element in place. As in
+      /// Vector3::Normalize, elements with zero length are left unchanged.
+      public: void Normalize()
+      {
+        const std::size_t n = this->Size();
+        T *ax = this->x.data(), *ay = this->y.data(), *az = this->z.data();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          const T d = static_cast<T>(
+              std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]));
+          // Branch free rescale: zero-length elements are multiplied by one.
+          const bool zero = equal<T>(d, static_cast<T>(0.0));
+          const T s = zero ? T(1) : T(1) / d;
+          ax[i] *= s;
+          ay[i] *= s;
+          az[i] *= s;
+        }
+      }
+
+      /// \brief Translate every element by a vector.
+      /// \param[in] _v Vector to add.
+      /// \return Reference to this container.
+      public: Vector3SoA<T> &operator+=(const Vector3<T> &_v)
+      {
+        this->Offset(this->x, _v.X());
+        this->Offset(this->y, _v.Y());
+        this->Offset(this->z, _v.Z());
+        return *this;
+      }
+
+      /// \brief Translate every element by the negative of a vector.
+      /// \param[in] _v Vector to subtract.
+      /// \return Reference to this container.
+      public: Vector3SoA<T> &operator-=(const Vector3<T> &_v)
+      {
+        return *this += -_v;
+      }
+
+      /// \brief Element-wise sum with another container of the same size.
+      /// \param[in] _v Vectors to add.
+      /// \return Reference to this container.
+      public: Vector3SoA<T> &operator+=(const Vector3SoA<T> &_v)
+      {
+        Add(*this, _v, *this);
+        return *this;
+      }
+
+      /// \brief Element-wise difference with another container of the same
+      /// size.
+      /// \param[in] _v Vectors to subtract.
+      /// \return Reference to this container.
+      public: Vector3SoA<T> &operator-=(const Vector3SoA<T> &_v)
+      {
+        Sub(*this, _v, *this);
+        return *this;
+      }
+
+      /// \brief Scale every element.
+      /// \param[in] _s Scale factor.
+      /// \return Reference to this container.
+      public: Vector3SoA<T> &operator*=(const T _s)
+      {
+        for (auto *c : {&this->x, &this->y, &this->z})
+        {
+          T *d = c->data();
+          for (std::size_t i = 0; i < c->size(); ++i)
+            d[i] *= _s;
+        }
+        return *this;
+      }
+
+      /// \brief Sum of all the elements.
+      /// \return The sum, or a zero vector if empty.
+      public: Vector3<T> Sum() const
+      {
+        T sx = 0, sy = 0, sz = 0;
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          sx += this->x[i];
+          sy += this->y[i];
+          sz += this->z[i];
+        }
+        return Vector3<T>(sx, sy, sz);
+      }
+
+      /// \brief Equality operator.
+      /// \param[in] _v Container to compare with.
+      /// \return True if both containers hold the same elements, using the
+      /// same tolerance as Vector3::operator==.
+      public: bool operator==(const Vector3SoA<T> &_v) const
+      {
+        if (this->Size() != _v.Size())
+          return false;
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          if ((*this)[i] != _v[i])
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _v Container to compare with.
+      /// \return True if the containers differ.
+      public: bool operator!=(const Vector3SoA<T> &_v) const
+      {
+        return !(*this == _v);
+      }
+
+      /// \brief Apply a binary operation to two arrays.
+      /// \param[in] _n Number of elements.
+      /// \param[in] _a First operand array.
+      /// \param[in] _b Second operand array.
+      /// \param[out] _out Output array.
+      /// \param[in] _op Operation.
+      private: template<typename Op>
+               static void Kernel(const std::size_t _n, const T *_a,
+                                  const T *_b, T *_out, Op _op)
+      {
+        for (std::size_t i = 0; i < _n; ++i)
+          _out[i] = _op(_a[i], _b[i]);
+      }
+
+      /// \brief Add a constant to every value of an array.
+      /// \param[in,out] _c Array to offset.
+      /// \param[in] _v Offset.
+      private: static void Offset(std::vector<T> &_c, const T _v)
+      {
+        T *d = _c.data();
+        for (std::size_t i = 0; i < _c.size(); ++i)
+          d[i] += _v;
+      }
+
+      /// \brief x components.
+      private: std::vector<T> x;
+
+      /// \brief y components.
+      private: std::vector<T> y;
+
+      /// \brief z components.
+      private: std::vector<T> z;
+    };
+
+    typedef Vector3SoA<double> Vector3SoAd;
+    typedef Vector3SoA<float> Vector3SoAf;
+    }
+  }
+}
+#endif
@@ -17,6 +17,8 @@
 #ifndef GZ_MATH_VECTOR3STATS_HH_
 #define GZ_MATH_VECTOR3STATS_HH_
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <gz/math/Helpers.hh>
 #include <gz/math/SignalStats.hh>
@@ -53,6 +55,7 @@ namespace ignition
       ///  "maxAbs"
       ///  "mean"
       ///  "rms"
+      ///  "p" followed by a percentile, such as "p99", see SignalQuantile
       /// \return True if statistic was successfully added,
       /// false if name was not recognized or had already
       /// been inserted.
@@ -67,6 +70,13 @@ namespace ignition
       /// been inserted.
       public: bool InsertStatistics(const std::string &_names);
 
+      /// \brief Add the data points of another collection of statistics,
+      /// as if they had been inserted into this one, see SignalStats::Merge.
+      /// \param[in] _stats Statistics to merge into this one.
+      /// \return True if both collections hold the same statistics. Nothing
+      /// is changed otherwise.
+      public: bool Merge(const Vector3Stats &_stats);
+
       /// \brief Forget all previous data.
       public: void Reset();
 
@@ -105,6 +115,85 @@ namespace ignition
       /// \brief Pointer to private data.
       protected: Vector3StatsPrivate *dataPtr;
     };
+
+    /// \brief Forward declare private data class.
+    class Vector3AccumulatorPrivate;
+
+    /// \class Vector3Accumulator Vector3Stats.hh
+    /// ignition/math/Vector3Stats.hh
+    /// \brief Computes the statistics of SignalAccumulator for the
+    /// components and the magnitude of a Vector3 signal in a single pass.
+    ///
+    /// Unlike Vector3Stats, a sample updates the four sets of running sums
+    /// in one non-virtual call, instead of going through four SignalStats
+    /// and their statistic objects. Accumulators of separate parts of a
+    /// signal, for example one per thread, can be merged.
+    class IGNITION_MATH_VISIBLE Vector3Accumulator
+    {
+      /// \brief Constructor
+      public: Vector3Accumulator();
+
+      /// \brief Destructor
+      public: ~Vector3Accumulator();
+
+      /// \brief Copy constructor
+      /// \param[in] _acc Vector3Accumulator to copy
+      public: Vector3Accumulator(const Vector3Accumulator &_acc);
+
+      /// \brief Assignment operator
+      /// \param[in] _acc Vector3Accumulator to copy
+      /// \return this
+      public: Vector3Accumulator &operator=(const Vector3Accumulator &_acc);
+
+      /// \brief Add a new sample to the statistics.
+      /// \param[in] _data New signal data point.
+      public: void InsertData(const Vector3d &_data);
+
+      /// \brief Add new samples to the statistics.
+      /// \param[in] _data Array of signal data points.
+      /// \param[in] _count Number of data points.
+      public: void InsertData(const Vector3d *_data, const size_t _count);
+
+      /// \brief Add the data points of another accumulator, as if they had
+      /// been inserted into this one.
+      /// \param[in] _acc Accumulator to merge into this one.
+      public: void Merge(const Vector3Accumulator &_acc);
+
+      /// \brief Forget all previous data.
+      public: void Reset();
+
+      /// \brief Get number of data points.
+      /// \return Number of data points.
+      public: size_t Count() const;
+
+      /// \brief Get statistics for x component of signal.
+      /// \return Statistics for x component of signal.
+      public: SignalAccumulator X() const;
+
+      /// \brief Get statistics for y component of signal.
+      /// \return Statistics for y component of signal.
+      public: SignalAccumulator Y() const;
+
+      /// \brief Get statistics for z component of signal.
+      /// \return Statistics for z component of signal.
+      public: SignalAccumulator Z() const;
+
+      /// \brief Get statistics for magnitude of signal.
+      /// \return Statistics for magnitude of signal.
+      public: SignalAccumulator Mag() const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<Vector3AccumulatorPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
     }
   }
 }
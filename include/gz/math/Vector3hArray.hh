@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_VECTOR3HARRAY_HH_
+#define GZ_MATH_VECTOR3HARRAY_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox3.hh>
+#include <gz/math/Half.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Vector3hArray Vector3hArray.hh ignition/math/Vector3hArray.hh
+    /// \brief A packed array of 3D points stored as half precision values.
+    ///
+    /// The x, y and z components of each point are stored next to each
+    /// other as Half, six bytes per point instead of 12 for Vector3f and 24
+    /// for Vector3d. This is the layout of a half precision vertex buffer,
+    /// so Data() can be uploaded to a GPU or written to a cache without
+    /// conversion.
+    ///
+    /// Points are converted from and to float with Half::FromFloat and
+    /// Half::ToFloat, in blocks, so that bulk conversions use vector
+    /// instructions. Components have 11 significant bits, a relative
+    /// precision of about 5e-4, and values of magnitude 65520 or more
+    /// become infinite, so coordinates are best kept in a local frame.
+    class Vector3hArray
+    {
+      /// \brief Default constructor, creates an empty array.
+      public: Vector3hArray() = default;
+
+      /// \brief Constructor, creates _size zero points.
+      /// \param[in] _size Number of points.
+      public: explicit Vector3hArray(const std::size_t _size)
+        : data(3 * _size)
+      {
+      }
+
+      /// \brief Constructor from an array of Vector3.
+      /// \param[in] _v Points to convert.
+      public: template<typename T>
+              explicit Vector3hArray(const std::vector<Vector3<T>> &_v)
+      {
+        this->Assign(_v);
+      }
+
+      /// \brief Replace the contents with an array of Vector3, rounded to
+      /// half precision.
+      /// \param[in] _v Points to convert.
+      public: template<typename T>
+              void Assign(const std::vector<Vector3<T>> &_v)
+      {
+        this->data.resize(3 * _v.size());
+        float buffer[3 * kBlock];
+        for (std::size_t i = 0; i < _v.size(); i += kBlock)
+        {
+          const std::size_t n = std::min(kBlock, _v.size() - i);
+          for (std::size_t j = 0; j < n; ++j)
+          {
+            buffer[3 * j] = static_cast<float>(_v[i + j].X());
+            buffer[3 * j + 1] = static_cast<float>(_v[i + j].Y());
+            buffer[3 * j + 2] = static_cast<float>(_v[i + j].Z());
+          }
+          Half::FromFloat(buffer, 3 * n, this->data.data() + 3 * i);
+        }
+      }
+
+      /// \brief Replace the contents with an array of interleaved float
+      /// coordinates, rounded to half precision.
+      /// \param[in] _xyz Coordinates, 3 * _count of them.
+      /// \param[in] _count Number of points.
+      public: void Assign(const float *_xyz, const std::size_t _count)
+      {
+        this->data.resize(3 * _count);
+        Half::FromFloat(_xyz, 3 * _count, this->data.data());
+      }
+
+      /// \brief Copy the contents into an array of Vector3.
+      /// \param[out] _v Destination, resized to Size().
+      public: template<typename T>
+              void CopyTo(std::vector<Vector3<T>> &_v) const
+      {
+        _v.resize(this->Size());
+        float buffer[3 * kBlock];
+        for (std::size_t i = 0; i < _v.size(); i += kBlock)
+        {
+          const std::size_t n = std::min(kBlock, _v.size() - i);
+          Half::ToFloat(this->data.data() + 3 * i, 3 * n, buffer);
+          for (std::size_t j = 0; j < n; ++j)
+          {
+            _v[i + j].Set(buffer[3 * j], buffer[3 * j + 1],
+                          buffer[3 * j + 2]);
+          }
+        }
+      }
+
+      /// \brief Copy the contents into an array of interleaved float
+      /// coordinates.
+      /// \param[out] _xyz Coordinates, 3 * Size() of them.
+      public: void CopyTo(float *_xyz) const
+      {
+        Half::ToFloat(this->data.data(), this->data.size(), _xyz);
+      }
+
+      /// \brief Get the number of points.
+      /// \return Number of points.
+      public: std::size_t Size() const
+      {
+        return this->data.size() / 3;
+      }
+
+      /// \brief Check if the array is empty.
+      /// \return True if there are no points.
+      public: bool Empty() const
+      {
+        return this->data.empty();
+      }
+
+      /// \brief Change the number of points. New points are zero.
+      /// \param[in] _size New number of points.
+      public: void Resize(const std::size_t _size)
+      {
+        this->data.resize(3 * _size);
+      }
+
+      /// \brief Reserve storage for a number of points.
+      /// \param[in] _size Number of points to reserve.
+      public: void Reserve(const std::size_t _size)
+      {
+        this->data.reserve(3 * _size);
+      }
+
+      /// \brief Remove all the points.
+      public: void Clear()
+      {
+        this->data.clear();
+      }
+
+      /// \brief Append a point, rounded to half precision.
+      /// \param[in] _v Point to append.
+      public: void PushBack(const Vector3f &_v)
+      {
+        this->data.push_back(Half(_v.X()));
+        this->data.push_back(Half(_v.Y()));
+        this->data.push_back(Half(_v.Z()));
+      }
+
+      /// \brief Get a point.
+      /// \param[in] _index Index of the point, must be lower than Size().
+      /// \return The point, converted to float.
+      public: Vector3f operator[](const std::size_t _index) const
+      {
+        return Vector3f(this->data[3 * _index].Float(),
+                        this->data[3 * _index + 1].Float(),
+                        this->data[3 * _index + 2].Float());
+      }
+
+      /// \brief Set a point, rounded to half precision.
+      /// \param[in] _index Index of the point, must be lower than Size().
+      /// \param[in] _v New value.
+      public: void Set(const std::size_t _index, const Vector3f &_v)
+      {
+        this->data[3 * _index] = Half(_v.X());
+        this->data[3 * _index + 1] = Half(_v.Y());
+        this->data[3 * _index + 2] = Half(_v.Z());
+      }
+
+      /// \brief Get the packed components, x, y and z of each point in
+      /// turn.
+      /// \return Pointer to 3 * Size() halves.
+      public: Half *Data()
+      {
+        return this->data.data();
+      }
+
+      /// \brief Get the packed components, x, y and z of each point in
+      /// turn.
+      /// \return Pointer to 3 * Size() halves.
+      public: const Half *Data() const
+      {
+        return this->data.data();
+      }
+
+      /// \brief Get the box that bounds the points.
+      /// \return The bounding box, empty if there are no points.
+      public: AxisAlignedBox3f Bounds() const
+      {
+        AxisAlignedBox3f box;
+        float buffer[3 * kBlock];
+        for (std::size_t i = 0; i < this->Size(); i += kBlock)
+        {
+          const std::size_t n = std::min(kBlock, this->Size() - i);
+          Half::ToFloat(this->data.data() + 3 * i, 3 * n, buffer);
+          for (std::size_t j = 0; j < n; ++j)
+          {
+            box.Merge(Vector3f(buffer[3 * j], buffer[3 * j + 1],
+                               buffer[3 * j + 2]));
+          }
+        }
+        return box;
+      }
+
+      /// \brief Equality operator. Compares the encodings of the
+      /// components.
+      /// \param[in] _v Array to compare.
+      /// \return True if both arrays hold the same points.
+      public: bool operator==(const Vector3hArray &_v) const
+      {
+        return this->data == _v.data;
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _v Array to compare.
+      /// \return True if the arrays differ.
+      public: bool operator!=(const Vector3hArray &_v) const
+      {
+        return !(*this == _v);
+      }
+
+      /// \brief Number of points converted at a time through a float
+      /// buffer on the stack.
+      private: static constexpr std::size_t kBlock = 256;
+
+      /// \brief Components of the points.
+      private: std::vector<Half> data;
+    };
+    }
+  }
+}
+#endif
@@ -47,9 +47,9 @@ namespace ignition
       public: static const Vector4 NaN;
 
       /// \brief Constructor
-      public: Vector4()
+      public: constexpr Vector4()
+      : data{0, 0, 0, 0}
       {
-        this->data[0] = this->data[1] = this->data[2] = this->data[3] = 0;
       }
 
       /// \brief Constructor with component values
@@ -57,26 +57,18 @@ namespace ignition
       /// \param[in] _y value along y axis
       /// \param[in] _z value along z axis
       /// \param[in] _w value along w axis
-      public: Vector4(const T &_x, const T &_y, const T &_z, const T &_w)
+      public: constexpr Vector4(const T &_x, const T &_y, const T &_z,
+                                const T &_w)
+      : data{_x, _y, _z, _w}
       {
-        this->data[0] = _x;
-        this->data[1] = _y;
-        this->data[2] = _z;
-        this->data[3] = _w;
       }
 
       /// \brief Copy constructor
       /// \param[in] _v vector
-      public: Vector4(const Vector4<T> &_v)
-      {
-        this->data[0] = _v[0];
-        this->data[1] = _v[1];
-        this->data[2] = _v[2];
-        this->data[3] = _v[3];
-      }
+      public: constexpr Vector4(const Vector4<T> &_v) = default;
 
       /// \brief Destructor
-      public: virtual ~Vector4() {}
+      public: virtual ~Vector4() = default;
 
       /// \brief Calc distance to the given point
       /// \param[in] _pt the point
@@ -110,7 +102,7 @@ namespace ignition
 
       /// \brief Return the square of the length (magnitude) of the vector
       /// \return the length
-      public: T SquaredLength() const
+      public: constexpr T SquaredLength() const
       {
         return
           this->data[0] * this->data[0] +
@@ -178,7 +170,7 @@ namespace ignition
       /// \brief Return the dot product of this vector and another vector
       /// \param[in] _v the vector
       /// \return the dot product
-      public: T Dot(const Vector4<T> &_v) const
+      public: constexpr T Dot(const Vector4<T> &_v) const
       {
         return this->data[0] * _v[0] +
                this->data[1] * _v[1] +
@@ -217,7 +209,7 @@ namespace ignition
       /// \param[in] _y value along y axis
       /// \param[in] _z value along z axis
       /// \param[in] _w value along w axis
-      public: void Set(T _x = 0, T _y = 0, T _z = 0, T _w = 0)
+      public: constexpr void Set(T _x = 0, T _y = 0, T _z = 0, T _w = 0)
       {
         this->data[0] = _x;
         this->data[1] = _y;
@@ -228,7 +220,7 @@ namespace ignition
       /// \brief Set this vector's components to the maximum of itself and the
       ///        passed in vector
       /// \param[in] _v the maximum clamping vector
-      public: void Max(const Vector4<T> &_v)
+      public: constexpr void Max(const Vector4<T> &_v)
       {
         this->data[0] = std::max(_v[0], this->data[0]);
         this->data[1] = std::max(_v[1], this->data[1]);
@@ -239,7 +231,7 @@ namespace ignition
       /// \brief Set this vector's components to the minimum of itself and the
       ///        passed in vector
       /// \param[in] _v the minimum clamping vector
-      public: void Min(const Vector4<T> &_v)
+      public: constexpr void Min(const Vector4<T> &_v)
       {
         this->data[0] = std::min(_v[0], this->data[0]);
         this->data[1] = std::min(_v[1], this->data[1]);
@@ -249,21 +241,21 @@ namespace ignition
 
       /// \brief Get the maximum value in the vector
       /// \return the maximum element
-      public: T Max() const
+      public: constexpr T Max() const
       {
         return *std::max_element(this->data, this->data+4);
       }
 
       /// \brief Get the minimum value in the vector
       /// \return the minimum element
-      public: T Min() const
+      public: constexpr T Min() const
       {
         return *std::min_element(this->data, this->data+4);
       }
 
       /// \brief Return the sum of the values
       /// \return the sum
-      public: T Sum() const
+      public: constexpr T Sum() const
       {
         return this->data[0] + this->data[1] + this->data[2] + this->data[3];
       }
@@ -271,19 +263,11 @@ namespace ignition
       /// \brief Assignment operator
       /// \param[in] _v the vector
       /// \return a reference to this vector
-      public: Vector4<T> &operator=(const Vector4<T> &_v)
-      {
-        this->data[0] = _v[0];
-        this->data[1] = _v[1];
-        this->data[2] = _v[2];
-        this->data[3] = _v[3];
-
-        return *this;
-      }
+      public: constexpr Vector4<T> &operator=(const Vector4<T> &_v) = default;
 
       /// \brief Assignment operator
       /// \param[in] _value
-      public: Vector4<T> &operator=(T _value)
+      public: constexpr Vector4<T> &operator=(T _value)
       {
         this->data[0] = _value;
         this->data[1] = _value;
@@ -296,7 +280,7 @@ namespace ignition
       /// \brief Addition operator
       /// \param[in] _v the vector to add
       /// \result a sum vector
-      public: Vector4<T> operator+(const Vector4<T> &_v) const
+      public: constexpr Vector4<T> operator+(const Vector4<T> &_v) const
       {
         return Vector4<T>(this->data[0] + _v[0],
                           this->data[1] + _v[1],
@@ -307,7 +291,7 @@ namespace ignition
       /// \brief Addition operator
       /// \param[in] _v the vector to add
       /// \return this vector
-      public: const Vector4<T> &operator+=(const Vector4<T> &_v)
+      public: constexpr const Vector4<T> &operator+=(const Vector4<T> &_v)
       {
         this->data[0] += _v[0];
         this->data[1] += _v[1];
@@ -320,7 +304,7 @@ namespace ignition
       /// \brief Addition operators
       /// \param[in] _s the scalar addend
       /// \return sum vector
-      public: inline Vector4<T> operator+(const T _s) const
+      public: constexpr Vector4<T> operator+(const T _s) const
       {
         return Vector4<T>(this->data[0] + _s,
                           this->data[1] + _s,
@@ -332,8 +316,8 @@ namespace ignition
       /// \param[in] _s the scalar addend
       /// \param[in] _v input vector
       /// \return sum vector
-      public: friend inline Vector4<T> operator+(const T _s,
-                                                 const Vector4<T> &_v)
+      public: friend constexpr Vector4<T> operator+(const T _s,
+                                                    const Vector4<T> &_v)
       {
         return _v + _s;
       }
@@ -341,7 +325,7 @@ namespace ignition
       /// \brief Addition assignment operator
       /// \param[in] _s scalar addend
       /// \return this
-      public: const Vector4<T> &operator+=(const T _s)
+      public: constexpr const Vector4<T> &operator+=(const T _s)
       {
         this->data[0] += _s;
         this->data[1] += _s;
@@ -353,7 +337,7 @@ namespace ignition
 
       /// \brief Negation operator
       /// \return negative of this vector
-      public: inline Vector4 operator-() const
+      public: constexpr Vector4 operator-() const
       {
         return Vector4(-this->data[0], -this->data[1],
                        -this->data[2], -this->data[3]);
@@ -362,7 +346,7 @@ namespace ignition
       /// \brief Subtraction operator
       /// \param[in] _v the vector to substract
       /// \return a vector
-      public: Vector4<T> operator-(const Vector4<T> &_v) const
+      public: constexpr Vector4<T> operator-(const Vector4<T> &_v) const
       {
         return Vector4<T>(this->data[0] - _v[0],
                           this->data[1] - _v[1],
@@ -373,7 +357,7 @@ namespace ignition
       /// \brief Subtraction assigment operators
       /// \param[in] _v the vector to substract
       /// \return this vector
-      public: const Vector4<T> &operator-=(const Vector4<T> &_v)
+      public: constexpr const Vector4<T> &operator-=(const Vector4<T> &_v)
       {
         this->data[0] -= _v[0];
         this->data[1] -= _v[1];
@@ -386,7 +370,7 @@ namespace ignition
       /// \brief Subtraction operators
       /// \param[in] _s the scalar subtrahend
       /// \return difference vector
-      public: inline Vector4<T> operator-(const T _s) const
+      public: constexpr Vector4<T> operator-(const T _s) const
       {
         return Vector4<T>(this->data[0] - _s,
                           this->data[1] - _s,
@@ -398,8 +382,8 @@ namespace ignition
       /// \param[in] _s the scalar minuend
       /// \param[in] _v vector subtrahend
       /// \return difference vector
-      public: friend inline Vector4<T> operator-(const T _s,
-                                                 const Vector4<T> &_v)
+      public: friend constexpr Vector4<T> operator-(const T _s,
+                                                    const Vector4<T> &_v)
       {
         return {_s - _v.X(), _s - _v.Y(), _s - _v.Z(), _s - _v.W()};
       }
@@ -407,7 +391,7 @@ namespace ignition
       /// \brief Subtraction assignment operator
       /// \param[in] _s scalar subtrahend
       /// \return this
-      public: const Vector4<T> &operator-=(const T _s)
+      public: constexpr const Vector4<T> &operator-=(const T _s)
       {
         this->data[0] -= _s;
         this->data[1] -= _s;
@@ -422,7 +406,7 @@ namespace ignition
       /// which has limited use.
       /// \param[in] _v the vector to perform element wise division with
       /// \return a result vector
-      public: const Vector4<T> operator/(const Vector4<T> &_v) const
+      public: constexpr const Vector4<T> operator/(const Vector4<T> &_v) const
       {
         return Vector4<T>(this->data[0] / _v[0],
                           this->data[1] / _v[1],
@@ -435,7 +419,7 @@ namespace ignition
       /// which has limited use.
       /// \param[in] _v the vector to perform element wise division with
       /// \return this
-      public: const Vector4<T> &operator/=(const Vector4<T> &_v)
+      public: constexpr const Vector4<T> &operator/=(const Vector4<T> &_v)
       {
         this->data[0] /= _v[0];
         this->data[1] /= _v[1];
@@ -450,7 +434,7 @@ namespace ignition
       /// which has limited use.
       /// \param[in] _v another vector
       /// \return a result vector
-      public: const Vector4<T> operator/(T _v) const
+      public: constexpr const Vector4<T> operator/(T _v) const
       {
         return Vector4<T>(this->data[0] / _v, this->data[1] / _v,
             this->data[2] / _v, this->data[3] / _v);
@@ -459,7 +443,7 @@ namespace ignition
       /// \brief Division operator
       /// \param[in] _v scaling factor
       /// \return a vector
-      public: const Vector4<T> &operator/=(T _v)
+      public: constexpr const Vector4<T> &operator/=(T _v)
       {
         this->data[0] /= _v;
         this->data[1] /= _v;
@@ -474,7 +458,7 @@ namespace ignition
       /// which has limited use.
       /// \param[in] _pt another vector
       /// \return result vector
-      public: const Vector4<T> operator*(const Vector4<T> &_pt) const
+      public: constexpr const Vector4<T> operator*(const Vector4<T> &_pt) const
       {
         return Vector4<T>(this->data[0] * _pt[0],
                           this->data[1] * _pt[1],
@@ -503,7 +487,7 @@ namespace ignition
       /// which has limited use.
       /// \param[in] _pt a vector
       /// \return this
-      public: const Vector4<T> &operator*=(const Vector4<T> &_pt)
+      public: constexpr const Vector4<T> &operator*=(const Vector4<T> &_pt)
       {
         this->data[0] *= _pt[0];
         this->data[1] *= _pt[1];
@@ -516,7 +500,7 @@ namespace ignition
       /// \brief Multiplication operators
       /// \param[in] _v scaling factor
       /// \return a  scaled vector
-      public: const Vector4<T> operator*(T _v) const
+      public: constexpr const Vector4<T> operator*(T _v) const
       {
         return Vector4<T>(this->data[0] * _v, this->data[1] * _v,
             this->data[2] * _v, this->data[3] * _v);
@@ -526,8 +510,8 @@ namespace ignition
       /// \param[in] _s the scaling factor
       /// \param[in] _v the vector to scale
       /// \return a scaled vector
-      public: friend inline const Vector4 operator*(const T _s,
-                                                    const Vector4 &_v)
+      public: friend constexpr const Vector4 operator*(const T _s,
+                                                       const Vector4 &_v)
       {
         return Vector4(_v * _s);
       }
@@ -535,7 +519,7 @@ namespace ignition
       /// \brief Multiplication assignment operator
       /// \param[in] _v scaling factor
       /// \return this
-      public: const Vector4<T> &operator*=(T _v)
+      public: constexpr const Vector4<T> &operator*=(T _v)
       {
         this->data[0] *= _v;
         this->data[1] *= _v;
@@ -592,7 +576,7 @@ namespace ignition
       /// \param[in] _index The index, where 0 == x, 1 == y, 2 == z, 3 == w.
       /// The index is clamped to the range (0,3).
       /// \return The value.
-      public: T &operator[](const std::size_t _index)
+      public: constexpr T &operator[](const std::size_t _index)
       {
         return this->data[clamp(_index, IGN_ZERO_SIZE_T, IGN_THREE_SIZE_T)];
       }
@@ -601,91 +585,91 @@ namespace ignition
       /// \param[in] _index The index, where 0 == x, 1 == y, 2 == z, 3 == w.
       /// The index is clamped to the range (0,3).
       /// \return The value.
-      public: T operator[](const std::size_t _index) const
+      public: constexpr T operator[](const std::size_t _index) const
       {
         return this->data[clamp(_index, IGN_ZERO_SIZE_T, IGN_THREE_SIZE_T)];
       }
 
       /// \brief Return a mutable x value.
       /// \return The x component of the vector
-      public: T &X()
+      public: constexpr T &X()
       {
         return this->data[0];
       }
 
       /// \brief Return a mutable y value.
       /// \return The y component of the vector
-      public: T &Y()
+      public: constexpr T &Y()
       {
         return this->data[1];
       }
 
       /// \brief Return a mutable z value.
       /// \return The z component of the vector
-      public: T &Z()
+      public: constexpr T &Z()
       {
         return this->data[2];
       }
 
       /// \brief Return a mutable w value.
       /// \return The w component of the vector
-      public: T &W()
+      public: constexpr T &W()
       {
         return this->data[3];
       }
 
       /// \brief Get the x value.
       /// \return The x component of the vector
-      public: T X() const
+      public: constexpr T X() const
       {
         return this->data[0];
       }
 
       /// \brief Get the y value.
       /// \return The y component of the vector
-      public: T Y() const
+      public: constexpr T Y() const
       {
         return this->data[1];
       }
 
       /// \brief Get the z value.
       /// \return The z component of the vector
-      public: T Z() const
+      public: constexpr T Z() const
       {
         return this->data[2];
       }
 
       /// \brief Get the w value.
       /// \return The w component of the vector
-      public: T W() const
+      public: constexpr T W() const
       {
         return this->data[3];
       }
 
       /// \brief Set the x value.
       /// \param[in] _v Value for the x component.
-      public: inline void X(const T &_v)
+      public: constexpr void X(const T &_v)
       {
         this->data[0] = _v;
       }
 
       /// \brief Set the y value.
       /// \param[in] _v Value for the y component.
-      public: inline void Y(const T &_v)
+      public: constexpr void Y(const T &_v)
       {
         this->data[1] = _v;
       }
 
       /// \brief Set the z value.
       /// \param[in] _v Value for the z component.
-      public: inline void Z(const T &_v)
+      public: constexpr void Z(const T &_v)
       {
         this->data[2] = _v;
       }
 
       /// \brief Set the w value.
       /// \param[in] _v Value for the w component.
-      public: inline void W(const T &_v)
+      public: constexpr void W(const T &_v)
       {
         this->data[3] = _v;
       }
@@ -694,7 +678,7 @@ namespace ignition
       /// \param[in] _pt Vector to compare.
       /// \return True if this vector's X(), Y(), Z() or W() value is less
       /// than the given vector's corresponding values.
-      public: bool operator<(const Vector4<T> &_pt) const
+      public: constexpr bool operator<(const Vector4<T> &_pt) const
       {
         return this->data[0] < _pt[0] || this->data[1] < _pt[1] ||
                this->data[2] < _pt[2] || this->data[3] < _pt[3];
@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_VOXELGRID_HH_
+#define GZ_MATH_VOXELGRID_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/Line3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    /// \class VoxelGrid VoxelGrid.hh ignition/math/VoxelGrid.hh
+    /// \brief A uniform grid of cubic cells over a box, such as the cells
+    /// of a voxel occupancy map.
+    ///
+    /// The grid only describes the cells; it stores no data. Cells are
+    /// referred to by their integer coordinates along X, Y and Z, or by a
+    /// linear index in which X varies fastest, to index arrays of cell
+    /// data. VoxelTraversal walks the cells crossed by a ray, and
+    /// MarkRays() finds the free and occupied cells of a range scan.
+    class IGNITION_MATH_VISIBLE VoxelGrid
+    {
+      /// \brief Mark of the cells not crossed by any ray.
+      public: static constexpr uint8_t kUnknown = 0;
+
+      /// \brief Mark of the cells crossed by a ray before its endpoint.
+      public: static constexpr uint8_t kFree = 1;
+
+      /// \brief Mark of the cells holding the endpoint of a ray.
+      public: static constexpr uint8_t kOccupied = 2;
+
+      /// \brief Default constructor. Creates an invalid grid without
+      /// cells.
+      public: VoxelGrid() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _bounds Box covered by the grid. Its maximum corner is
+      /// moved up so that the box holds a whole number of cells.
+      /// \param[in] _resolution Side of the cells.
+      /// The grid is invalid if the box is empty or not finite, if the
+      /// resolution is not positive and finite, or if there would be more
+      /// than 2^31 cells along an axis.
+      public: VoxelGrid(const AxisAlignedBox &_bounds,
+                        const double _resolution);
+
+      /// \brief Check that the grid has cells.
+      /// \return True if the grid was built from valid arguments.
+      public: bool Valid() const;
+
+      /// \brief Get the box covered by the cells.
+      /// \return The box, or a default box if the grid is invalid.
+      public: AxisAlignedBox Bounds() const;
+
+      /// \brief Get the side of the cells.
+      /// \return The resolution, or 0 if the grid is invalid.
+      public: double Resolution() const;
+
+      /// \brief Get the number of cells along each axis.
+      /// \return The counts, which are zero if the grid is invalid.
+      public: const Vector3i &CellCounts() const;
+
+      /// \brief Get the total number of cells.
+      /// \return The product of the counts along each axis.
+      public: std::size_t CellCount() const;
+
+      /// \brief Find the cell holding a point. Points on the boundary
+      /// between cells belong to the upper cell, except on the upper
+      /// boundary of the grid.
+      /// \param[in] _point The point.
+      /// \param[out] _cell Coordinates of the cell. Unchanged if the point
+      /// is outside of the grid.
+      /// \return True if the point is inside of the grid.
+      public: bool Cell(const Vector3d &_point, Vector3i &_cell) const;
+
+      /// \brief Check that cell coordinates are inside of the grid.
+      /// \param[in] _cell Coordinates of the cell.
+      /// \return True if the cell exists.
+      public: bool Contains(const Vector3i &_cell) const;
+
+      /// \brief Get the linear index of a cell.
+      /// \param[in] _cell Coordinates of a cell inside of the grid.
+      /// \return X + CellCounts().X() * (Y + CellCounts().Y() * Z).
+      public: std::size_t Index(const Vector3i &_cell) const
+      {
+        return static_cast<std::size_t>(_cell.X()) +
+            static_cast<std::size_t>(this->counts.X()) *
+            (static_cast<std::size_t>(_cell.Y()) +
+             static_cast<std::size_t>(this->counts.Y()) *
+             static_cast<std::size_t>(_cell.Z()));
+      }
+
+      /// \brief Get the box of a cell.
+      /// \param[in] _cell Coordinates of the cell.
+      /// \return The box of the cell.
+      public: AxisAlignedBox CellBox(const Vector3i &_cell) const;
+
+      /// \brief Mark the cells seen by a range scan, as an occupancy map
+      /// update does. Each ray goes from the origin to an endpoint. The
+      /// cells crossed by a ray are free, and the cell of its endpoint is
+      /// occupied, which takes precedence over free marks of other rays.
+      /// Rays longer than _maxRange are cut to that length and mark no
+      /// occupied cell. Endpoints that are not finite are skipped.
+      /// \param[in] _origin Origin of the rays.
+      /// \param[in] _endpoints Endpoints of the rays.
+      /// \param[in] _maxRange Maximum length of the rays.
+      /// \param[out] _marks Mark of each cell by linear index: kUnknown,
+      /// kFree or kOccupied. The vector is resized to CellCount() and
+      /// cleared first, and keeps its capacity.
+      public: void MarkRays(const Vector3d &_origin,
+                            const std::vector<Vector3d> &_endpoints,
+                            const double _maxRange,
+                            std::vector<uint8_t> &_marks) const;
+
+      /// \brief Mark the cells seen by a range scan using several threads.
+      /// The marks are the same as with a single thread.
+      /// \param[in] _origin Origin of the rays.
+      /// \param[in] _endpoints Endpoints of the rays.
+      /// \param[in] _maxRange Maximum length of the rays.
+      /// \param[out] _marks Mark of each cell by linear index, as in the
+      /// single threaded MarkRays().
+      /// \param[in] _threads Number of threads used to trace the rays. A
+      /// value of 0 uses the number of hardware threads. Small scans always
+      /// use a single thread.
+      public: void MarkRays(const Vector3d &_origin,
+                            const std::vector<Vector3d> &_endpoints,
+                            const double _maxRange,
+                            std::vector<uint8_t> &_marks,
+                            const unsigned int _threads) const;
+
+      /// \brief Minimum corner of the grid.
+      private: Vector3d origin;
+
+      /// \brief Side of the cells.
+      private: double resolution = 0;
+
+      /// \brief Number of cells along each axis.
+      private: Vector3i counts;
+    };
+
+    /// \class VoxelTraversal VoxelGrid.hh ignition/math/VoxelGrid.hh
+    /// \brief Iterator over the cells of a VoxelGrid crossed by a ray or a
+    /// segment, in order, with the 3D digital differential analyzer of
+    /// Amanatides and Woo.
+    ///
+    /// Each step moves to the next cell across the nearest cell boundary,
+    /// with a few additions and comparisons and no allocation. A ray
+    /// through an edge or a corner of cells crosses one axis at a time,
+    /// visiting one of the cells around it for an empty interval.
+    ///
+    /// <b>Example</b>
+    /// \code{.cpp}
+    /// for (gz::math::VoxelTraversal it(grid, origin, dir, 0, range);
+    ///      it.Valid(); it.Next())
+    /// {
+    ///   if (occupied[grid.Index(it.Cell())])
+    ///     return it.Entry();
+    /// }
+    /// \endcode
+    class IGNITION_MATH_VISIBLE VoxelTraversal
+    {
+      /// \brief Constructor. Starts at the first cell crossed by a ray.
+      /// \param[in] _grid Grid to traverse, which must outlive the
+      /// traversal.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// A zero direction visits the cell of the origin.
+      /// \param[in] _min Distance along the ray at which to start.
+      /// \param[in] _max Distance along the ray at which to stop.
+      public: VoxelTraversal(const VoxelGrid &_grid,
+                             const Vector3d &_origin,
+                             const Vector3d &_dir,
+                             const double _min, const double _max);
+
+      /// \brief Constructor. Starts at the first cell crossed by a segment.
+      /// \param[in] _grid Grid to traverse, which must outlive the
+      /// traversal.
+      /// \param[in] _segment Segment from its first point to its second
+      /// point.
+      public: VoxelTraversal(const VoxelGrid &_grid, const Line3d &_segment);
+
+      /// \brief Check that the traversal has a current cell.
+      /// \return False once the ray leaves the grid or passes its maximum
+      /// distance, or if it never enters the grid.
+      public: bool Valid() const
+      {
+        return this->valid;
+      }
+
+      /// \brief Move to the next cell crossed by the ray.
+      /// \return Valid() after the move.
+      public: bool Next()
+      {
+        if (!this->valid)
+          return false;
+
+        const int axis = this->ExitAxis();
+        const double exit = this->tMax[axis];
+        if (exit >= this->end)
+        {
+          this->valid = false;
+          return false;
+        }
+
+        int &coordinate = this->cell[axis];
+        coordinate += this->step[axis];
+        if (coordinate < 0 || coordinate >= this->grid->CellCounts()[axis])
+        {
+          this->valid = false;
+          return false;
+        }
+        this->entry = exit;
+        this->tMax[axis] += this->tDelta[axis];
+        return true;
+      }
+
+      /// \brief Get the current cell.
+      /// \return Coordinates of the cell in the grid.
+      public: const Vector3i &Cell() const
+      {
+        return this->cell;
+      }
+
+      /// \brief Get the distance along the ray at which it enters the
+      /// current cell.
+      /// \return The distance, not less than the minimum distance.
+      public: double Entry() const
+      {
+        return this->entry;
+      }
+
+      /// \brief Get the distance along the ray at which it leaves the
+      /// current cell.
+      /// \return The distance, not more than the maximum distance.
+      public: double Exit() const
+      {
+        return std::min(this->tMax[this->ExitAxis()], this->end);
+      }
+
+      /// \brief Get the axis of the nearest cell boundary.
+      /// \return 0, 1 or 2.
+      private: int ExitAxis() const
+      {
+        if (this->tMax[0] < this->tMax[1])
+          return this->tMax[0] < this->tMax[2] ? 0 : 2;
+        return this->tMax[1] < this->tMax[2] ? 1 : 2;
+      }
+
+      /// \brief Find the first cell of a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Unit direction of the ray, or zero.
+      /// \param[in] _min Distance along the ray at which to start.
+      /// \param[in] _max Distance along the ray at which to stop.
+      private: void Start(const Vector3d &_origin, const Vector3d &_dir,
+                          const double _min, const double _max);
+
+      /// \brief Grid being traversed.
+      private: const VoxelGrid *grid;
+
+      /// \brief Current cell.
+      private: Vector3i cell;
+
+      /// \brief Step of the cell coordinates along each axis: -1, 0 or 1.
+      private: Vector3i step;
+
+      /// \brief Distance along the ray of the next cell boundary along each
+      /// axis.
+      private: Vector3d tMax;
+
+      /// \brief Distance along the ray between cell boundaries along each
+      /// axis.
+      private: Vector3d tDelta;
+
+      /// \brief Distance along the ray at which it enters the current cell.
+      private: double entry = 0;
+
+      /// \brief Distance along the ray at which to stop.
+      private: double end = 0;
+
+      /// \brief Whether there is a current cell.
+      private: bool valid = false;
+    };
+    }
+  }
+}
+#endif
@@ -17,6 +17,7 @@
 #ifndef GZ_MATH_DETAIL_BOX_HH_
 #define GZ_MATH_DETAIL_BOX_HH_
 
+#include "gz/math/Instrumentation.hh"
 #include "gz/math/Triangle3.hh"
 
 #include <algorithm>
@@ -184,23 +185,87 @@ std::vector<std::pair<Triangle3<T>, T>> TrianglesInPlane(
   return triangles;
 }
 
+//////////////////////////////////////////////////
+/// \brief Allocation free version of TrianglesInPlane, which sums the
+/// volumes of the triangles instead of returning them.
+/// \param[in] _plane The plane in which the vertices exist.
+/// \param[in] _vertices The vertices of the polygon.
+/// \return Six times the signed volume of the tetrahedra formed by the
+/// origin and each triangle returned by TrianglesInPlane.
+template <typename T, std::size_t N>
+T VolumeOfTrianglesInPlane(
+    const Plane<T> &_plane, const FixedIntersectionPoints<T, N> &_vertices)
+{
+  Vector3<T> pointsInPlane[N];
+  std::size_t count = 0;
+
+  Vector3<T> centroid;
+  for (const auto &pt : _vertices)
+  {
+    if (_plane.Side(pt) == Plane<T>::NO_SIDE)
+    {
+      pointsInPlane[count++] = pt;
+      centroid += pt;
+    }
+  }
+
+  if (count < 3)
+    return 0;
+  centroid /= T(count);
+
+  // Choose a basis in the plane of the triangle
+  auto axis1 = (pointsInPlane[0] - centroid).Normalize();
+  auto axis2 = axis1.Cross(_plane.Normal()).Normalize();
+
+  // Since the polygon is always convex, we can try to create a fan of triangles
+  // by sorting the points by their angle in the plane basis. There are few
+  // points, so an insertion sort on angles computed once is enough.
+  T angles[N];
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const auto displacement = pointsInPlane[i] - centroid;
+    const T angle = atan2(axis2.Dot(displacement), axis1.Dot(displacement));
+    const Vector3<T> point = pointsInPlane[i];
+    std::size_t j = i;
+    for (; j > 0 && angle < angles[j - 1]; --j)
+    {
+      angles[j] = angles[j - 1];
+      pointsInPlane[j] = pointsInPlane[j - 1];
+    }
+    angles[j] = angle;
+    pointsInPlane[j] = point;
+  }
+
+  // Calculate the volume of the triangles
+  // https://n-e-r-v-o-u-s.com/blog/?p=4415
+  const T sign =
+      (_plane.Side({0, 0, 0}) == Plane<T>::POSITIVE_SIDE) ? -1 : 1;
+  T volume = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const Vector3<T> &a = pointsInPlane[i];
+    const Vector3<T> &b = pointsInPlane[(i + 1) % count];
+    auto crossProduct = centroid.Cross(b);
+    volume += sign * std::abs(crossProduct.Dot(a));
+  }
+  return volume;
+}
+
 /////////////////////////////////////////////////
 template<typename T>
 T Box<T>::VolumeBelow(const Plane<T> &_plane) const
 {
-  auto verticesBelow = this->VerticesBelow(_plane);
-  if (verticesBelow.empty())
+  BoxIntersectionPoints<T> verticesBelow;
+  this->VerticesBelow(_plane, verticesBelow);
+  if (verticesBelow.Empty())
     return 0;
 
-  auto intersections = this->Intersections(_plane);
   // TODO(arjo): investigate the use of _epsilon tolerance as this method
   // implicitly uses Vector3<T>::operator==()
-  verticesBelow.merge(intersections);
+  this->Intersections(_plane, verticesBelow);
 
   // Reconstruct the cut-box as a triangle mesh by attempting to fit planes.
-  std::vector<std::pair<Triangle3<T>, T>> triangles;
-
-  std::vector<Plane<T>> planes
+  const Plane<T> planes[] =
   {
     Plane<T>{Vector3<T>{0, 0, 1}, this->Size().Z()/2},
     Plane<T>{Vector3<T>{0, 0, -1}, this->Size().Z()/2},
@@ -211,25 +276,135 @@ T Box<T>::VolumeBelow(const Plane<T> &_plane) const
     _plane
   };
 
+  T volume = 0;
   for (const auto &p : planes)
+    volume += VolumeOfTrianglesInPlane(p, verticesBelow);
+
+  return std::abs(volume)/6;
+}
+
+//////////////////////////////////////////////////
+/// \brief Compute the volume and centroid of the part of a box, centered
+/// at the origin and aligned with the axes, which is below a plane that
+/// cuts it. The faces of the box are clipped against the plane, and the
+/// volume is summed over the tetrahedra formed by the triangles of the
+/// clipped faces and a point on the plane. The face formed by the plane
+/// does not contribute, so it does not need to be computed.
+/// \param[in] _half Half of the size of the box.
+/// \param[in] _normal Unit normal of the plane.
+/// \param[in] _offset Offset of the plane.
+/// \param[out] _centroid Centroid of the volume below the plane.
+/// \return Volume below the plane.
+template<typename T>
+T ClippedBoxVolumeBelow(const Vector3<T> &_half, const Vector3<T> &_normal,
+    const T _offset, Vector3<T> &_centroid)
+{
+  // Corner i of the box has the positive half size along x, y and z when
+  // bits 0, 1 and 2 of i are set. Each face lists its corners
+  // counter-clockwise when seen from outside.
+  static const int kFaces[6][4] = {
+    {0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4},
+    {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5}};
+
+  Vector3<T> corners[8];
+  T distances[8];
+  for (int i = 0; i < 8; ++i)
   {
-    auto newTriangles = TrianglesInPlane(p, verticesBelow);
-    triangles.insert(triangles.end(),
-      newTriangles.begin(),
-      newTriangles.end());
+    corners[i].Set(i & 1 ? _half.X() : -_half.X(),
+                   i & 2 ? _half.Y() : -_half.Y(),
+                   i & 4 ? _half.Z() : -_half.Z());
+    distances[i] = _normal.Dot(corners[i]) - _offset;
   }
 
-  // Calculate the volume of the triangles
-  // https://n-e-r-v-o-u-s.com/blog/?p=4415
-  T volume = 0;
-  for (const auto &triangle : triangles)
+  // Apex on the plane, close to the box
+  const Vector3<T> apex = _offset * _normal;
+
+  T volume6 = 0;
+  Vector3<T> moment = Vector3<T>::Zero;
+  for (const auto &face : kFaces)
+  {
+    // Clip the face against the plane. A quad cut by a plane has at most
+    // five vertices.
+    Vector3<T> polygon[5];
+    int count = 0;
+    for (int j = 0; j < 4; ++j)
+    {
+      const int a = face[j];
+      const int b = face[(j + 1) % 4];
+      if (distances[a] <= 0)
+        polygon[count++] = corners[a];
+      if ((distances[a] < 0 && distances[b] > 0) ||
+          (distances[a] > 0 && distances[b] < 0))
+      {
+        const T t = distances[a] / (distances[a] - distances[b]);
+        polygon[count++] = corners[a] + t * (corners[b] - corners[a]);
+      }
+    }
+
+    // Fan of tetrahedra from the apex
+    for (int j = 1; j + 1 < count; ++j)
+    {
+      const Vector3<T> v0 = polygon[0] - apex;
+      const Vector3<T> v1 = polygon[j] - apex;
+      const Vector3<T> v2 = polygon[j + 1] - apex;
+      const T tetra6 = v0.Dot(v1.Cross(v2));
+      volume6 += tetra6;
+      moment += tetra6 * (v0 + v1 + v2);
+    }
+  }
+
+  if (volume6 <= 0)
   {
-    auto crossProduct = (triangle.first[2]).Cross(triangle.first[1]);
-    auto meshVolume = std::abs(crossProduct.Dot(triangle.first[0]));
-    volume += triangle.second * meshVolume;
+    _centroid = apex;
+    return 0;
   }
 
-  return std::abs(volume)/6;
+  // The centroid of each tetrahedron relative to the apex is a quarter of
+  // the sum of its other vertices.
+  _centroid = apex + moment / (4 * volume6);
+  return volume6 / 6;
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+void Box<T>::VolumesBelow(const Vector3<T> *_sizes, const Pose3<T> *_poses,
+    const std::size_t _count, const Plane<T> &_plane, T *_volumes,
+    Vector3<T> *_centers)
+{
+  const T length = _plane.Normal().Length();
+  const Vector3<T> normal = _plane.Normal() / length;
+  const T offset = _plane.Offset() / length;
+
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const Pose3<T> &pose = _poses[i];
+    const Vector3<T> half = _sizes[i] / 2;
+
+    // Plane in the frame of the box
+    const Vector3<T> n = pose.Rot().RotateVectorReverse(normal);
+    const T d = offset - normal.Dot(pose.Pos());
+
+    // Distance from the center of the box to its farthest corner along n
+    const T extent = std::abs(n.X()) * half.X() + std::abs(n.Y()) * half.Y() +
+                     std::abs(n.Z()) * half.Z();
+
+    _centers[i] = pose.Pos();
+    if (d <= -extent)
+    {
+      _volumes[i] = 0;
+    }
+    else if (d >= extent)
+    {
+      _volumes[i] = _sizes[i].X() * _sizes[i].Y() * _sizes[i].Z();
+    }
+    else
+    {
+      Vector3<T> centroid;
+      _volumes[i] = ClippedBoxVolumeBelow(half, n, d, centroid);
+      if (_volumes[i] > 0)
+        _centers[i] = pose.CoordPositionAdd(centroid);
+    }
+  }
 }
 
 /////////////////////////////////////////////////
@@ -237,12 +412,12 @@ template<typename T>
 std::optional<Vector3<T>>
   Box<T>::CenterOfVolumeBelow(const Plane<T> &_plane) const
 {
-  auto verticesBelow = this->VerticesBelow(_plane);
-  if (verticesBelow.empty())
+  BoxIntersectionPoints<T> verticesBelow;
+  this->VerticesBelow(_plane, verticesBelow);
+  if (verticesBelow.Empty())
     return std::nullopt;
 
-  auto intersections = this->Intersections(_plane);
-  verticesBelow.merge(intersections);
+  this->Intersections(_plane, verticesBelow);
 
   Vector3<T> centroid;
   for (const auto &v : verticesBelow)
@@ -250,37 +425,43 @@ std::optional<Vector3<T>>
     centroid += v;
   }
 
-  return centroid / static_cast<T>(verticesBelow.size());
+  return centroid / static_cast<T>(verticesBelow.Size());
 }
 
 /////////////////////////////////////////////////
 template<typename T>
 IntersectionPoints<T> Box<T>::VerticesBelow(const Plane<T> &_plane) const
 {
-  // Get coordinates of all vertice of box
-  // TODO(arjo): Cache this for performance
-  IntersectionPoints<T> vertices
+  BoxIntersectionPoints<T> vertices;
+  this->VerticesBelow(_plane, vertices);
+  IGN_MATH_COUNT_ALLOCATIONS(INTERSECTIONS, vertices.Size(),
+      vertices.Size() * sizeof(Vector3<T>));
+  return IntersectionPoints<T>(vertices.begin(), vertices.end());
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+void Box<T>::VerticesBelow(const Plane<T> &_plane,
+    BoxIntersectionPoints<T> &_vertices) const
+{
+  // Get coordinates of all vertice of box. Equivalent vertices of a
+  // degenerate box are only checked once.
+  BoxIntersectionPoints<T> vertices;
+  for (int i = 0; i < 8; ++i)
   {
-    Vector3<T>{this->size.X()/2, this->size.Y()/2, this->size.Z()/2},
-    Vector3<T>{-this->size.X()/2, this->size.Y()/2, this->size.Z()/2},
-    Vector3<T>{this->size.X()/2, -this->size.Y()/2, this->size.Z()/2},
-    Vector3<T>{-this->size.X()/2, -this->size.Y()/2, this->size.Z()/2},
-    Vector3<T>{this->size.X()/2, this->size.Y()/2, -this->size.Z()/2},
-    Vector3<T>{-this->size.X()/2, this->size.Y()/2, -this->size.Z()/2},
-    Vector3<T>{this->size.X()/2, -this->size.Y()/2, -this->size.Z()/2},
-    Vector3<T>{-this->size.X()/2, -this->size.Y()/2, -this->size.Z()/2}
-  };
+    vertices.Insert(Vector3<T>{
+      i & 1 ? this->size.X()/2 : -this->size.X()/2,
+      i & 2 ? this->size.Y()/2 : -this->size.Y()/2,
+      i & 4 ? this->size.Z()/2 : -this->size.Z()/2});
+  }
 
-  IntersectionPoints<T> verticesBelow;
   for (const auto &v : vertices)
   {
     if (_plane.Distance(v) <= 0)
     {
-      verticesBelow.insert(v);
+      _vertices.Insert(v);
     }
   }
-
-  return verticesBelow;
 }
 
 /////////////////////////////////////////////////
@@ -310,16 +491,79 @@ bool Box<T>::MassMatrix(MassMatrix3<T> &_massMat) const
   return _massMat.SetFromBox(this->material, this->size);
 }
 
+//////////////////////////////////////////////////
+template<typename T>
+void Box<T>::Volumes(const Vector3<T> *_sizes, const std::size_t _count,
+    T *_volumes)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+    _volumes[i] = _sizes[i].X() * _sizes[i].Y() * _sizes[i].Z();
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+void Box<T>::DensitiesFromMasses(const Vector3<T> *_sizes,
+    const T *_masses, const std::size_t _count, T *_densities)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const Vector3<T> &size = _sizes[i];
+    const T volume = size.X() * size.Y() * size.Z();
+    _densities[i] = (size.Min() <= 0 || _masses[i] <= 0) ?
+        T(-1.0) : _masses[i] / volume;
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+bool Box<T>::MassMatrices(const Vector3<T> *_sizes, const T *_densities,
+    const std::size_t _count, MassMatrix3<T> *_massMats)
+{
+  bool all = true;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const Vector3<T> &size = _sizes[i];
+    const T mass = _densities[i] * (size.X() * size.Y() * size.Z());
+    if (mass <= 0 || size.Min() <= 0)
+    {
+      _massMats[i] = MassMatrix3<T>();
+      all = false;
+      continue;
+    }
+
+    // Principal moments of a box, see MassMatrix3::SetFromBox
+    const T x2 = size.X() * size.X();
+    const T y2 = size.Y() * size.Y();
+    const T z2 = size.Z() * size.Z();
+    const T k = mass / 12.0;
+    _massMats[i] = MassMatrix3<T>(mass,
+        Vector3<T>(k * (y2 + z2), k * (z2 + x2), k * (x2 + y2)),
+        Vector3<T>::Zero);
+  }
+  return all;
+}
+
 
 //////////////////////////////////////////////////
 template<typename T>
 IntersectionPoints<T> Box<T>::Intersections(
         const Plane<T> &_plane) const
 {
-  IntersectionPoints<T> intersections;
+  BoxIntersectionPoints<T> intersections;
+  this->Intersections(_plane, intersections);
+  IGN_MATH_COUNT_ALLOCATIONS(INTERSECTIONS, intersections.Size(),
+      intersections.Size() * sizeof(Vector3<T>));
+  return IntersectionPoints<T>(intersections.begin(), intersections.end());
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+void Box<T>::Intersections(const Plane<T> &_plane,
+    BoxIntersectionPoints<T> &_intersections) const
+{
   // These are vertices via which we can describe edges. We only need 4 such
   // vertices
-  std::vector<Vector3<T> > vertices
+  const Vector3<T> vertices[] =
   {
     Vector3<T>{-this->size.X()/2, -this->size.Y()/2, -this->size.Z()/2},
     Vector3<T>{this->size.X()/2, this->size.Y()/2, -this->size.Z()/2},
@@ -327,19 +571,11 @@ IntersectionPoints<T> Box<T>::Intersections(
     Vector3<T>{-this->size.X()/2, this->size.Y()/2, this->size.Z()/2}
   };
 
-  // Axes
-  std::vector<Vector3<T>> axes
-  {
-    Vector3<T>{1, 0, 0},
-    Vector3<T>{0, 1, 0},
-    Vector3<T>{0, 0, 1}
-  };
-
   // There are 12 edges, which are checked along 3 axes from 4 box corner
   // points.
   for (auto &v : vertices)
   {
-    for (auto &a : axes)
+    for (auto &a : {Vector3<T>::UnitX, Vector3<T>::UnitY, Vector3<T>::UnitZ})
     {
       auto intersection = _plane.Intersection(v, a);
       if (intersection.has_value() &&
@@ -350,12 +586,10 @@ IntersectionPoints<T> Box<T>::Intersections(
           intersection->Z() >= -this->size.Z()/2 &&
           intersection->Z() <= this->size.Z()/2)
       {
-        intersections.insert(intersection.value());
+        _intersections.Insert(intersection.value());
       }
     }
   }
-
-  return intersections;
 }
 
 }
@@ -17,10 +17,12 @@
 #ifndef GZ_MATH_DETAIL_CAPSULE_HH_
 #define GZ_MATH_DETAIL_CAPSULE_HH_
 
+#include <algorithm>
 #include <limits>
 #include <optional>
 #include <gz/math/Helpers.hh>
 #include <gz/math/Inertial.hh>
+#include <gz/math/detail/RayIntersection.hh>
 
 namespace ignition
 {
@@ -161,6 +163,136 @@ T Capsule<T>::DensityFromMass(const T _mass) const
   return _mass / this->Volume();
 }
 
+//////////////////////////////////////////////////
+template<typename T>
+void Capsule<T>::Volumes(const T *_lengths, const T *_radii,
+    const std::size_t _count, T *_volumes)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    _volumes[i] = IGN_PI * (_radii[i] * _radii[i]) *
+                  (_lengths[i] + 4. / 3. * _radii[i]);
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+void Capsule<T>::DensitiesFromMasses(const T *_lengths, const T *_radii,
+    const T *_masses, const std::size_t _count, T *_densities)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const T volume = IGN_PI * (_radii[i] * _radii[i]) *
+                     (_lengths[i] + 4. / 3. * _radii[i]);
+    _densities[i] = (_radii[i] <= 0 || _lengths[i] <= 0 || _masses[i] <= 0) ?
+        std::numeric_limits<T>::quiet_NaN() : _masses[i] / volume;
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+bool Capsule<T>::MassMatrices(const T *_lengths, const T *_radii,
+    const T *_densities, const std::size_t _count, MassMatrix3<T> *_massMats)
+{
+  bool all = true;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const T length = _lengths[i];
+    const T radius = _radii[i];
+    if (_densities[i] <= 0 || length <= 0 || radius <= 0)
+    {
+      _massMats[i] = MassMatrix3<T>();
+      all = false;
+      continue;
+    }
+
+    // Same terms as MassMatrix(): a cylinder about its centroid and two
+    // hemispheres whose centroids are 3/8 radius from their flat bases.
+    // The combined center of mass is at the origin, so each hemisphere
+    // only adds its mass times dz^2 to the transverse moments.
+    const T r2 = radius * radius;
+    const T cylinderMass = _densities[i] * (IGN_PI * r2 * length);
+    const T hemisphereMass = _densities[i] * 2. / 3. * IGN_PI * r2 * radius;
+    const T dz = length / 2. + radius * 3. / 8.;
+    const T ixx = cylinderMass / 12.0 * (3*r2 + length*length) +
+        2 * (83. / 320. * hemisphereMass * r2 + hemisphereMass * dz * dz);
+    const T izz = cylinderMass / 2.0 * r2 +
+        2 * (2. / 5. * hemisphereMass * r2);
+    _massMats[i] = MassMatrix3<T>(cylinderMass + 2 * hemisphereMass,
+        Vector3<T>(ixx, ixx, izz), Vector3<T>::Zero);
+  }
+  return all;
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::tuple<bool, T> Capsule<T>::IntersectDist(const Pose3<T> &_pose,
+    const Vector3<T> &_origin, const Vector3<T> &_dir,
+    const T _min, const T _max) const
+{
+  return detail::ShapeIntersectDist(_pose, _origin, _dir, _min, _max,
+      [this](const Vector3<T> &_o, const Vector3<T> &_d, T &_tin, T &_tout)
+      {
+        return this->RayInterval(_o, _d, _tin, _tout);
+      });
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::size_t Capsule<T>::IntersectRays(const Pose3<T> &_pose,
+    const Vector3<T> &_origin, const Vector3<T> *_dirs,
+    const std::size_t _count, const T _min, T *_ranges) const
+{
+  return detail::ShapeIntersectRays(_pose, _origin, _dirs, _count, _min,
+      _ranges,
+      [this](const Vector3<T> &_o, const Vector3<T> &_d, T &_tin, T &_tout)
+      {
+        return this->RayInterval(_o, _d, _tin, _tout);
+      });
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+bool Capsule<T>::RayInterval(const Vector3<T> &_origin,
+    const Vector3<T> &_dir, T &_tin, T &_tout) const
+{
+  // The capsule is the union of a cylinder and two spheres. It is convex,
+  // so the ray is inside of it from the first entry to the last exit.
+  const T radius2 = this->radius * this->radius;
+  const T half = this->length / 2;
+  bool hit = false;
+  _tin = std::numeric_limits<T>::infinity();
+  _tout = -std::numeric_limits<T>::infinity();
+
+  T sideIn, sideOut, capIn, capOut;
+  if (detail::QuadricRayInterval(
+          _dir.X() * _dir.X() + _dir.Y() * _dir.Y(),
+          _origin.X() * _dir.X() + _origin.Y() * _dir.Y(),
+          _origin.X() * _origin.X() + _origin.Y() * _origin.Y() - radius2,
+          sideIn, sideOut) &&
+      detail::SlabRayInterval(_origin.Z(), _dir.Z(), half, capIn, capOut) &&
+      std::max(sideIn, capIn) <= std::min(sideOut, capOut))
+  {
+    hit = true;
+    _tin = std::max(sideIn, capIn);
+    _tout = std::min(sideOut, capOut);
+  }
+
+  for (const T z : {-half, half})
+  {
+    const Vector3<T> origin(_origin.X(), _origin.Y(), _origin.Z() - z);
+    T tin, tout;
+    if (detail::QuadricRayInterval(_dir.SquaredLength(), origin.Dot(_dir),
+            origin.SquaredLength() - radius2, tin, tout))
+    {
+      hit = true;
+      _tin = std::min(_tin, tin);
+      _tout = std::max(_tout, tout);
+    }
+  }
+  return hit;
+}
+
 }
 }
 #endif
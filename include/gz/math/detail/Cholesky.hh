@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_CHOLESKY_HH_
+#define GZ_MATH_DETAIL_CHOLESKY_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Get the largest magnitude on the diagonal of a matrix.
+      /// \param[in] _a Row major N x N matrix.
+      /// \return The largest magnitude, or NaN if a diagonal element is NaN.
+      template<std::size_t N, typename T>
+      inline T LargestDiagonal(const T *_a)
+      {
+        T largest = 0;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+          const T d = std::abs(_a[i * N + i]);
+          if (std::isnan(d))
+            return d;
+          largest = std::max(largest, d);
+        }
+        return largest;
+      }
+
+      /// \brief Replace the lower triangle of a symmetric positive definite
+      /// matrix by its Cholesky factor L, such that A = L L^T. Only the
+      /// lower triangle is read, and the upper triangle is left unchanged.
+      /// \param[in,out] _a Row major N x N matrix.
+      /// \param[in] _tolerance Pivots must be greater than this fraction
+      /// of the largest diagonal element.
+      /// \return False if the matrix is not positive definite, or not
+      /// finite. The lower triangle is then partially factored.
+      template<std::size_t N, typename T>
+      inline bool CholeskyFactor(T *_a, const T _tolerance)
+      {
+        const T largest = LargestDiagonal<N>(_a);
+        if (!std::isfinite(largest))
+          return false;
+        const T threshold = _tolerance * largest;
+
+        for (std::size_t j = 0; j < N; ++j)
+        {
+          T pivot = _a[j * N + j];
+          for (std::size_t k = 0; k < j; ++k)
+            pivot -= _a[j * N + k] * _a[j * N + k];
+          if (!(pivot > threshold) || !(pivot > 0))
+            return false;
+          const T diagonal = std::sqrt(pivot);
+          const T inverse = 1 / diagonal;
+          _a[j * N + j] = diagonal;
+          for (std::size_t i = j + 1; i < N; ++i)
+          {
+            T sum = _a[i * N + j];
+            for (std::size_t k = 0; k < j; ++k)
+              sum -= _a[i * N + k] * _a[j * N + k];
+            _a[i * N + j] = sum * inverse;
+          }
+        }
+        return true;
+      }
+
+      /// \brief Solve A x = b from the Cholesky factor of A.
+      /// \param[in] _l Row major N x N matrix whose lower triangle holds
+      /// the factor from CholeskyFactor.
+      /// \param[in,out] _b The right hand side, replaced with x.
+      template<std::size_t N, typename T>
+      inline void CholeskySolve(const T *_l, T *_b)
+      {
+        // Reciprocals of the diagonal, shared by both substitutions
+        T inverse[N];
+        for (std::size_t i = 0; i < N; ++i)
+          inverse[i] = 1 / _l[i * N + i];
+        for (std::size_t i = 0; i < N; ++i)
+        {
+          for (std::size_t k = 0; k < i; ++k)
+            _b[i] -= _l[i * N + k] * _b[k];
+          _b[i] *= inverse[i];
+        }
+        for (std::size_t i = N; i-- > 0;)
+        {
+          for (std::size_t k = i + 1; k < N; ++k)
+            _b[i] -= _l[k * N + i] * _b[k];
+          _b[i] *= inverse[i];
+        }
+      }
+
+      /// \brief Replace the lower triangle of a symmetric matrix by its
+      /// LDL^T factorization, without pivoting: the strictly lower
+      /// triangle holds the unit lower triangular L and the diagonal holds
+      /// D. Unlike Cholesky, this does not take square roots and also
+      /// factors symmetric indefinite matrices whose leading minors are
+      /// not singular. Only the lower triangle is read, and the upper
+      /// triangle is left unchanged.
+      /// \param[in,out] _a Row major N x N matrix.
+      /// \param[in] _tolerance Pivots must have a magnitude greater than
+      /// this fraction of the largest diagonal magnitude.
+      /// \return False if a pivot is zero or below the tolerance, or not
+      /// finite. The lower triangle is then partially factored.
+      template<std::size_t N, typename T>
+      inline bool LdltFactor(T *_a, const T _tolerance)
+      {
+        const T largest = LargestDiagonal<N>(_a);
+        if (!std::isfinite(largest))
+          return false;
+        const T threshold = _tolerance * largest;
+
+        for (std::size_t j = 0; j < N; ++j)
+        {
+          // Row j of L times D
+          T ld[N];
+          T pivot = _a[j * N + j];
+          for (std::size_t k = 0; k < j; ++k)
+          {
+            ld[k] = _a[j * N + k] * _a[k * N + k];
+            pivot -= _a[j * N + k] * ld[k];
+          }
+          if (!(std::abs(pivot) > threshold) || !(std::abs(pivot) > 0) ||
+              !std::isfinite(pivot))
+          {
+            return false;
+          }
+          const T inverse = 1 / pivot;
+          _a[j * N + j] = pivot;
+          for (std::size_t i = j + 1; i < N; ++i)
+          {
+            T sum = _a[i * N + j];
+            for (std::size_t k = 0; k < j; ++k)
+              sum -= _a[i * N + k] * ld[k];
+            _a[i * N + j] = sum * inverse;
+          }
+        }
+        return true;
+      }
+
+      /// \brief Solve A x = b from the LDL^T factorization of A.
+      /// \param[in] _ld Row major N x N matrix whose lower triangle holds
+      /// the factorization from LdltFactor.
+      /// \param[in,out] _b The right hand side, replaced with x.
+      template<std::size_t N, typename T>
+      inline void LdltSolve(const T *_ld, T *_b)
+      {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+          for (std::size_t k = 0; k < i; ++k)
+            _b[i] -= _ld[i * N + k] * _b[k];
+        }
+        for (std::size_t i = 0; i < N; ++i)
+          _b[i] /= _ld[i * N + i];
+        for (std::size_t i = N; i-- > 0;)
+        {
+          for (std::size_t k = i + 1; k < N; ++k)
+            _b[i] -= _ld[k * N + i] * _b[k];
+        }
+      }
+    }
+    }
+  }
+}
+#endif
@@ -16,6 +16,11 @@
 */
 #ifndef GZ_MATH_DETAIL_CYLINDER_HH_
 #define GZ_MATH_DETAIL_CYLINDER_HH_
+
+#include <algorithm>
+
+#include <gz/math/detail/RayIntersection.hh>
+
 namespace ignition
 {
 namespace math
@@ -144,6 +149,105 @@ T Cylinder<T>::DensityFromMass(const T _mass) const
   return _mass / this->Volume();
 }
 
+//////////////////////////////////////////////////
+template<typename T>
+void Cylinder<T>::Volumes(const T *_lengths, const T *_radii,
+    const std::size_t _count, T *_volumes)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+    _volumes[i] = IGN_PI * (_radii[i] * _radii[i]) * _lengths[i];
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+void Cylinder<T>::DensitiesFromMasses(const T *_lengths, const T *_radii,
+    const T *_masses, const std::size_t _count, T *_densities)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const T volume = IGN_PI * (_radii[i] * _radii[i]) * _lengths[i];
+    _densities[i] = (_radii[i] <= 0 || _lengths[i] <= 0 || _masses[i] <= 0) ?
+        T(-1.0) : _masses[i] / volume;
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+bool Cylinder<T>::MassMatrices(const T *_lengths, const T *_radii,
+    const T *_densities, const std::size_t _count, MassMatrix3<T> *_massMats)
+{
+  bool all = true;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const T length = _lengths[i];
+    const T radius2 = _radii[i] * _radii[i];
+    if (_densities[i] <= 0 || length <= 0 || _radii[i] <= 0)
+    {
+      _massMats[i] = MassMatrix3<T>();
+      all = false;
+      continue;
+    }
+
+    // Principal moments of a cylinder, see MassMatrix3::SetFromCylinderZ
+    const T mass = _densities[i] * (IGN_PI * radius2 * length);
+    const T ixx = mass / 12.0 * (3*radius2 + length*length);
+    _massMats[i] = MassMatrix3<T>(mass,
+        Vector3<T>(ixx, ixx, mass / 2.0 * radius2), Vector3<T>::Zero);
+  }
+  return all;
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::tuple<bool, T> Cylinder<T>::IntersectDist(const Pose3<T> &_pose,
+    const Vector3<T> &_origin, const Vector3<T> &_dir,
+    const T _min, const T _max) const
+{
+  const Pose3<T> pose(_pose.Pos(), _pose.Rot() * this->rotOffset);
+  return detail::ShapeIntersectDist(pose, _origin, _dir, _min, _max,
+      [this](const Vector3<T> &_o, const Vector3<T> &_d, T &_tin, T &_tout)
+      {
+        return this->RayInterval(_o, _d, _tin, _tout);
+      });
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::size_t Cylinder<T>::IntersectRays(const Pose3<T> &_pose,
+    const Vector3<T> &_origin, const Vector3<T> *_dirs,
+    const std::size_t _count, const T _min, T *_ranges) const
+{
+  const Pose3<T> pose(_pose.Pos(), _pose.Rot() * this->rotOffset);
+  return detail::ShapeIntersectRays(pose, _origin, _dirs, _count, _min,
+      _ranges,
+      [this](const Vector3<T> &_o, const Vector3<T> &_d, T &_tin, T &_tout)
+      {
+        return this->RayInterval(_o, _d, _tin, _tout);
+      });
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+bool Cylinder<T>::RayInterval(const Vector3<T> &_origin,
+    const Vector3<T> &_dir, T &_tin, T &_tout) const
+{
+  // Inside of the infinite cylinder and between the caps.
+  T sideIn, sideOut, capIn, capOut;
+  if (!detail::QuadricRayInterval(
+          _dir.X() * _dir.X() + _dir.Y() * _dir.Y(),
+          _origin.X() * _dir.X() + _origin.Y() * _dir.Y(),
+          _origin.X() * _origin.X() + _origin.Y() * _origin.Y() -
+          this->radius * this->radius, sideIn, sideOut) ||
+      !detail::SlabRayInterval(_origin.Z(), _dir.Z(), this->length / 2,
+                               capIn, capOut))
+  {
+    return false;
+  }
+  _tin = std::max(sideIn, capIn);
+  _tout = std::min(sideOut, capOut);
+  return _tin <= _tout;
+}
+
 }
 }
 #endif
@@ -17,10 +17,12 @@
 #ifndef GZ_MATH_DETAIL_ELLIPSOID_HH_
 #define GZ_MATH_DETAIL_ELLIPSOID_HH_
 
+#include <algorithm>
 #include <limits>
 #include <optional>
 #include <gz/math/Helpers.hh>
 #include <gz/math/Inertial.hh>
+#include <gz/math/detail/RayIntersection.hh>
 
 namespace ignition
 {
@@ -123,6 +125,104 @@ T Ellipsoid<T>::DensityFromMass(const T _mass) const
   return _mass / this->Volume();
 }
 
+//////////////////////////////////////////////////
+template<typename T>
+void Ellipsoid<T>::Volumes(const Vector3<T> *_radii,
+    const std::size_t _count, T *_volumes)
+{
+  const T kFourThirdsPi = 4. * IGN_PI / 3.;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const Vector3<T> &radii = _radii[i];
+    _volumes[i] = kFourThirdsPi * radii.X() * radii.Y() * radii.Z();
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+void Ellipsoid<T>::DensitiesFromMasses(const Vector3<T> *_radii,
+    const T *_masses, const std::size_t _count, T *_densities)
+{
+  const T kFourThirdsPi = 4. * IGN_PI / 3.;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const Vector3<T> &radii = _radii[i];
+    const T volume = kFourThirdsPi * radii.X() * radii.Y() * radii.Z();
+    _densities[i] = (radii.Min() <= 0 || _masses[i] <= 0) ?
+        std::numeric_limits<T>::quiet_NaN() : _masses[i] / volume;
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+bool Ellipsoid<T>::MassMatrices(const Vector3<T> *_radii,
+    const T *_densities, const std::size_t _count, MassMatrix3<T> *_massMats)
+{
+  const T kFourThirdsPi = 4. * IGN_PI / 3.;
+  bool all = true;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const Vector3<T> &radii = _radii[i];
+    if (_densities[i] <= 0 || radii.Min() <= 0)
+    {
+      _massMats[i] = MassMatrix3<T>();
+      all = false;
+      continue;
+    }
+
+    // Same moments as MassMatrix()
+    const T mass = _densities[i] *
+        (kFourThirdsPi * radii.X() * radii.Y() * radii.Z());
+    const T x2 = radii.X() * radii.X();
+    const T y2 = radii.Y() * radii.Y();
+    const T z2 = radii.Z() * radii.Z();
+    const T k = mass / 5.;
+    _massMats[i] = MassMatrix3<T>(mass,
+        Vector3<T>(k * (y2 + z2), k * (x2 + z2), k * (x2 + y2)),
+        Vector3<T>::Zero);
+  }
+  return all;
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::tuple<bool, T> Ellipsoid<T>::IntersectDist(const Pose3<T> &_pose,
+    const Vector3<T> &_origin, const Vector3<T> &_dir,
+    const T _min, const T _max) const
+{
+  return detail::ShapeIntersectDist(_pose, _origin, _dir, _min, _max,
+      [this](const Vector3<T> &_o, const Vector3<T> &_d, T &_tin, T &_tout)
+      {
+        return this->RayInterval(_o, _d, _tin, _tout);
+      });
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::size_t Ellipsoid<T>::IntersectRays(const Pose3<T> &_pose,
+    const Vector3<T> &_origin, const Vector3<T> *_dirs,
+    const std::size_t _count, const T _min, T *_ranges) const
+{
+  return detail::ShapeIntersectRays(_pose, _origin, _dirs, _count, _min,
+      _ranges,
+      [this](const Vector3<T> &_o, const Vector3<T> &_d, T &_tin, T &_tout)
+      {
+        return this->RayInterval(_o, _d, _tin, _tout);
+      });
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+bool Ellipsoid<T>::RayInterval(const Vector3<T> &_origin,
+    const Vector3<T> &_dir, T &_tin, T &_tout) const
+{
+  // Scale the ellipsoid to a unit sphere.
+  const Vector3<T> origin = _origin / this->radii;
+  const Vector3<T> dir = _dir / this->radii;
+  return detail::QuadricRayInterval(dir.SquaredLength(), origin.Dot(dir),
+      origin.SquaredLength() - 1, _tin, _tout);
+}
+
 }
 }
 #endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_FIXEDINTERSECTIONPOINTS_HH_
+#define GZ_MATH_DETAIL_FIXEDINTERSECTIONPOINTS_HH_
+
+#include <cstddef>
+
+#include <gz/math/Vector3.hh>
+#include "gz/math/detail/WellOrderedVector.hh"
+
+namespace ignition
+{
+  namespace math
+  {
+    /// \brief A set of at most N points, stored in place without
+    /// allocating. Points are kept in the order of WellOrderedVectors, and
+    /// a point equivalent to one already in the set is not inserted, the
+    /// same as a std::set<Vector3<T>, WellOrderedVectors<T>>.
+    template<typename T, std::size_t N>
+    class FixedIntersectionPoints
+    {
+      /// \brief Insert a point, unless an equivalent point is already in
+      /// the set or the set is full.
+      /// \param[in] _point Point to insert.
+      /// \return True if the point was inserted.
+      public: bool Insert(const Vector3<T> &_point)
+      {
+        const WellOrderedVectors<T> less;
+
+        // First point which is not less than _point
+        std::size_t pos = 0;
+        while (pos < this->size && less(this->points[pos], _point))
+          ++pos;
+
+        if (pos < this->size && !less(_point, this->points[pos]))
+          return false;
+        if (this->size == N)
+          return false;
+
+        for (std::size_t i = this->size; i > pos; --i)
+          this->points[i] = this->points[i - 1];
+        this->points[pos] = _point;
+        ++this->size;
+        return true;
+      }
+
+      /// \brief Remove all the points.
+      public: void Clear()
+      {
+        this->size = 0;
+      }
+
+      /// \brief Get the number of points.
+      /// \return Number of points in the set.
+      public: std::size_t Size() const
+      {
+        return this->size;
+      }
+
+      /// \brief Check if the set is empty.
+      /// \return True if there are no points in the set.
+      public: bool Empty() const
+      {
+        return this->size == 0;
+      }
+
+      /// \brief Get a point.
+      /// \param[in] _index Index of the point, less than Size().
+      /// \return The point at _index.
+      public: const Vector3<T> &operator[](const std::size_t _index) const
+      {
+        return this->points[_index];
+      }
+
+      /// \brief Get an iterator to the first point.
+      /// \return Pointer to the first point.
+      public: const Vector3<T> *begin() const
+      {
+        return this->points;
+      }
+
+      /// \brief Get an iterator past the last point.
+      /// \return Pointer past the last point.
+      public: const Vector3<T> *end() const
+      {
+        return this->points + this->size;
+      }
+
+      /// \brief Points in the set, of which the first size are used.
+      private: Vector3<T> points[N];
+
+      /// \brief Number of points in the set.
+      private: std::size_t size = 0;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_MARCHINGCUBES_HH_
+#define GZ_MATH_DETAIL_MARCHINGCUBES_HH_
+
+#include <cstdint>
+
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Triangles of an isosurface through a cell of a grid, for
+      /// each of the 256 configurations of the corners of the cell.
+      ///
+      /// Corner c of a cell is at offset (c & 1, (c >> 1) & 1, c >> 2), and
+      /// bit c of a configuration is set when that corner is below the
+      /// isovalue. Edge 4 * a + k joins the k-th corner with a zero
+      /// coordinate a to the corner one step along axis a.
+      ///
+      /// The table is derived from the configurations rather than typed in.
+      /// On each face of the cell, the surface cuts off each corner below
+      /// the isovalue, so that the two cells sharing a face agree and the
+      /// surface is closed. The cuts are chained into loops, which are
+      /// split into fans of triangles wound counter-clockwise when seen
+      /// from above the isovalue.
+      struct MarchingCubesTable
+      {
+        /// \brief Corners joined by each edge.
+        uint8_t edgeCorners[12][2];
+
+        /// \brief Edges holding the vertices of the triangles of each
+        /// configuration, three per triangle, terminated by -1.
+        int8_t triangles[256][31];
+      };
+
+      /// \brief Build the marching cubes table.
+      /// \return The table.
+      inline MarchingCubesTable BuildMarchingCubesTable()
+      {
+        MarchingCubesTable table;
+        auto corner = [](const int _c)
+        {
+          return Vector3d(_c & 1, (_c >> 1) & 1, _c >> 2);
+        };
+
+        int edgeOf[8][8];
+        for (int a = 0; a < 3; ++a)
+        {
+          int k = 0;
+          for (int c = 0; c < 8; ++c)
+          {
+            if (c & (1 << a))
+              continue;
+            const int e = 4 * a + k++;
+            table.edgeCorners[e][0] = static_cast<uint8_t>(c);
+            table.edgeCorners[e][1] = static_cast<uint8_t>(c | (1 << a));
+            edgeOf[c][c | (1 << a)] = edgeOf[c | (1 << a)][c] = e;
+          }
+        }
+        auto midpoint = [&](const int _e)
+        {
+          return (corner(table.edgeCorners[_e][0]) +
+                  corner(table.edgeCorners[_e][1])) * 0.5;
+        };
+
+        for (int config = 0; config < 256; ++config)
+        {
+          auto below = [config](const int _c)
+          {
+            return ((config >> _c) & 1) != 0;
+          };
+
+          // Cuts on each face, directed with the corners above the
+          // isovalue on their left when seen from outside of the cell.
+          int next[12];
+          for (int &n : next)
+            n = -1;
+          for (int a = 0; a < 3; ++a)
+          {
+            const int u = 1 << ((a + 1) % 3);
+            const int v = 1 << ((a + 2) % 3);
+            for (int side = 0; side < 2; ++side)
+            {
+              const int base = side ? (1 << a) : 0;
+              const int q[4] = {base, base | u, base | u | v, base | v};
+              Vector3d normal;
+              normal[a] = side ? 1 : -1;
+
+              auto addCut = [&](const int _e1, const int _e2,
+                                const int _below)
+              {
+                const Vector3d p1 = midpoint(_e1);
+                const Vector3d left = normal.Cross(midpoint(_e2) - p1);
+                if ((corner(_below) - p1).Dot(left) > 0)
+                  next[_e2] = _e1;
+                else
+                  next[_e1] = _e2;
+              };
+
+              int crossing[4];
+              int count = 0;
+              for (int i = 0; i < 4; ++i)
+              {
+                if (below(q[i]) != below(q[(i + 1) % 4]))
+                  crossing[count++] = edgeOf[q[i]][q[(i + 1) % 4]];
+              }
+              if (count == 2)
+              {
+                int b = 0;
+                while (!below(q[b]))
+                  ++b;
+                addCut(crossing[0], crossing[1], q[b]);
+              }
+              else if (count == 4)
+              {
+                for (int i = 0; i < 4; ++i)
+                {
+                  if (below(q[i]))
+                  {
+                    addCut(edgeOf[q[(i + 3) % 4]][q[i]],
+                           edgeOf[q[i]][q[(i + 1) % 4]], q[i]);
+                  }
+                }
+              }
+            }
+          }
+
+          // Fans of triangles over each loop of cuts.
+          int8_t *out = table.triangles[config];
+          bool used[12] = {false};
+          for (int start = 0; start < 12; ++start)
+          {
+            if (next[start] < 0 || used[start])
+              continue;
+            int loop[12];
+            int size = 0;
+            for (int e = start; !used[e]; e = next[e])
+            {
+              used[e] = true;
+              loop[size++] = e;
+            }
+            for (int i = 1; i + 1 < size; ++i)
+            {
+              *out++ = static_cast<int8_t>(loop[0]);
+              *out++ = static_cast<int8_t>(loop[i + 1]);
+              *out++ = static_cast<int8_t>(loop[i]);
+            }
+          }
+          *out = -1;
+        }
+        return table;
+      }
+
+      /// \brief Get the marching cubes table, which is built on first use.
+      /// \return The table.
+      inline const MarchingCubesTable &MarchingCubes()
+      {
+        static const MarchingCubesTable table = BuildMarchingCubesTable();
+        return table;
+      }
+    }
+    }
+  }
+}
+#endif
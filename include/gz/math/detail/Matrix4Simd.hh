@@ -0,0 +1,524 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_MATRIX4SIMD_HH_
+#define GZ_MATH_DETAIL_MATRIX4SIMD_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include <gz/math/config.hh>
+
+// Select the instruction set used by the Matrix4 kernels at compile time.
+// Define IGNITION_MATH_DISABLE_SIMD to always use the portable scalar code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD)
+  #if defined(__AVX__)
+    #define IGNITION_MATH_MATRIX4_AVX 1
+    #define IGNITION_MATH_MATRIX4_SSE2 1
+    #include <immintrin.h>
+  #elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define IGNITION_MATH_MATRIX4_SSE2 1
+    #include <emmintrin.h>
+  #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define IGNITION_MATH_MATRIX4_NEON 1
+    #include <arm_neon.h>
+  #endif
+#endif
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Multiply two row-major 4x4 matrices, _r = _a * _b.
+      /// This is the portable implementation, used for any T without a
+      /// specialization below. _r must not alias _a or _b.
+      /// \param[in] _a Left operand, 16 contiguous values.
+      /// \param[in] _b Right operand, 16 contiguous values.
+      /// \param[out] _r Result, 16 contiguous values.
+      template<typename T>
+      inline void Matrix4Multiply(const T *_a, const T *_b, T *_r)
+      {
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+          const T a0 = _a[i * 4 + 0];
+          const T a1 = _a[i * 4 + 1];
+          const T a2 = _a[i * 4 + 2];
+          const T a3 = _a[i * 4 + 3];
+          for (std::size_t j = 0; j < 4; ++j)
+          {
+            _r[i * 4 + j] =
+              a0 * _b[j] + a1 * _b[4 + j] + a2 * _b[8 + j] + a3 * _b[12 + j];
+          }
+        }
+      }
+
+      /// \brief Invert a row-major 4x4 matrix with a vectorized kernel.
+      /// The generic version has no vectorized kernel and returns false,
+      /// in which case the caller uses its scalar implementation.
+      /// \param[in] _m Matrix to invert, 16 contiguous values.
+      /// \param[out] _r Inverse, 16 contiguous values.
+      /// \return True if _r was computed.
+      template<typename T>
+      inline bool Matrix4InverseSimd(const T * /*_m*/, T * /*_r*/)
+      {
+        return false;
+      }
+
+      /// \brief Project one point through a row-major 4x4 matrix, see
+      /// Matrix4Project.
+      /// \param[in] _m Matrix, 16 contiguous values.
+      /// \param[in] _x X coordinate of the point.
+      /// \param[in] _y Y coordinate of the point.
+      /// \param[in] _z Z coordinate of the point.
+      /// \param[in] _halfWidth Half of the image width, in pixels.
+      /// \param[in] _halfHeight Half of the image height, in pixels.
+      /// \param[out] _u Pixel column.
+      /// \param[out] _v Pixel row.
+      /// \param[out] _depth W clip coordinate.
+      /// \param[out] _clip Clip code.
+      template<typename T>
+      inline void Matrix4ProjectPoint(const T *_m, const T _x, const T _y,
+                                      const T _z, const T _halfWidth,
+                                      const T _halfHeight, T &_u, T &_v,
+                                      T &_depth, uint8_t &_clip)
+      {
+        const T cx = _m[0] * _x + _m[1] * _y + _m[2] * _z + _m[3];
+        const T cy = _m[4] * _x + _m[5] * _y + _m[6] * _z + _m[7];
+        const T cz = _m[8] * _x + _m[9] * _y + _m[10] * _z + _m[11];
+        const T cw = _m[12] * _x + _m[13] * _y + _m[14] * _z + _m[15];
+        _clip = static_cast<uint8_t>(
+            (cx < -cw) | (cx > cw) << 1 | (cy < -cw) << 2 |
+            (cy > cw) << 3 | (cz < -cw) << 4 | (cz > cw) << 5);
+        const T invW = cw > 0 ? 1 / cw : std::numeric_limits<T>::quiet_NaN();
+        _u = (cx * invW + 1) * _halfWidth;
+        _v = (1 - cy * invW) * _halfHeight;
+        _depth = cw;
+      }
+
+      /// \brief Project points through a row-major 4x4 matrix to pixel
+      /// coordinates. Each point is transformed to clip coordinates
+      /// (x, y, z, w), and the clip code has bit 0 set if x < -w, bit 1 if
+      /// x > w, bit 2 if y < -w, bit 3 if y > w, bit 4 if z < -w and bit 5
+      /// if z > w. This is the portable implementation, used for any T
+      /// without a specialization below.
+      /// \param[in] _m Matrix, 16 contiguous values.
+      /// \param[in] _x X coordinates of the points.
+      /// \param[in] _y Y coordinates of the points.
+      /// \param[in] _z Z coordinates of the points.
+      /// \param[in] _count Number of points.
+      /// \param[in] _halfWidth Half of the image width, in pixels.
+      /// \param[in] _halfHeight Half of the image height, in pixels.
+      /// \param[out] _u Pixel columns, _count values.
+      /// \param[out] _v Pixel rows, _count values.
+      /// \param[out] _depth W clip coordinates, _count values.
+      /// \param[out] _clip Clip codes, _count values.
+      template<typename T>
+      inline void Matrix4Project(const T *_m, const T *_x, const T *_y,
+                                 const T *_z, const std::size_t _count,
+                                 const T _halfWidth, const T _halfHeight,
+                                 T *_u, T *_v, T *_depth, uint8_t *_clip)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          Matrix4ProjectPoint(_m, _x[i], _y[i], _z[i], _halfWidth,
+                              _halfHeight, _u[i], _v[i], _depth[i],
+                              _clip[i]);
+        }
+      }
+
+#if defined(IGNITION_MATH_MATRIX4_SSE2)
+      /// \brief SSE specialization of Matrix4Multiply for float.
+      template<>
+      inline void Matrix4Multiply<float>(const float *_a, const float *_b,
+                                         float *_r)
+      {
+        const __m128 b0 = _mm_loadu_ps(_b);
+        const __m128 b1 = _mm_loadu_ps(_b + 4);
+        const __m128 b2 = _mm_loadu_ps(_b + 8);
+        const __m128 b3 = _mm_loadu_ps(_b + 12);
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+          const float *a = _a + i * 4;
+          __m128 row = _mm_mul_ps(_mm_set1_ps(a[0]), b0);
+          row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[1]), b1));
+          row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[2]), b2));
+          row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[3]), b3));
+          _mm_storeu_ps(_r + i * 4, row);
+        }
+      }
+
+      /// \brief SSE/AVX specialization of Matrix4Multiply for double.
+      template<>
+      inline void Matrix4Multiply<double>(const double *_a, const double *_b,
+                                          double *_r)
+      {
+#if defined(IGNITION_MATH_MATRIX4_AVX)
+        const __m256d b0 = _mm256_loadu_pd(_b);
+        const __m256d b1 = _mm256_loadu_pd(_b + 4);
+        const __m256d b2 = _mm256_loadu_pd(_b + 8);
+        const __m256d b3 = _mm256_loadu_pd(_b + 12);
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+          const double *a = _a + i * 4;
+          __m256d row = _mm256_mul_pd(_mm256_set1_pd(a[0]), b0);
+          row = _mm256_add_pd(row, _mm256_mul_pd(_mm256_set1_pd(a[1]), b1));
+          row = _mm256_add_pd(row, _mm256_mul_pd(_mm256_set1_pd(a[2]), b2));
+          row = _mm256_add_pd(row, _mm256_mul_pd(_mm256_set1_pd(a[3]), b3));
+          _mm256_storeu_pd(_r + i * 4, row);
+        }
+#else
+        // Each row is processed as two halves of two doubles.
+        for (std::size_t h = 0; h < 4; h += 2)
+        {
+          const __m128d b0 = _mm_loadu_pd(_b + h);
+          const __m128d b1 = _mm_loadu_pd(_b + 4 + h);
+          const __m128d b2 = _mm_loadu_pd(_b + 8 + h);
+          const __m128d b3 = _mm_loadu_pd(_b + 12 + h);
+          for (std::size_t i = 0; i < 4; ++i)
+          {
+            const double *a = _a + i * 4;
+            __m128d row = _mm_mul_pd(_mm_set1_pd(a[0]), b0);
+            row = _mm_add_pd(row, _mm_mul_pd(_mm_set1_pd(a[1]), b1));
+            row = _mm_add_pd(row, _mm_mul_pd(_mm_set1_pd(a[2]), b2));
+            row = _mm_add_pd(row, _mm_mul_pd(_mm_set1_pd(a[3]), b3));
+            _mm_storeu_pd(_r + i * 4 + h, row);
+          }
+        }
+#endif
+      }
+
+      /// \brief SSE specialization of Matrix4InverseSimd for float.
+      /// The matrix is split in four 2x2 blocks
+      ///   | A B |
+      ///   | C D |
+      /// and inverted with the block-wise adjugate formulation, which maps
+      /// every 2x2 block onto one SSE register.
+      template<>
+      inline bool Matrix4InverseSimd<float>(const float *_m, float *_r)
+      {
+        #define GZ_SHUFFLE_MASK(x, y, z, w) \
+            ((x) | (y) << 2 | (z) << 4 | (w) << 6)
+        #define GZ_SWIZZLE(v, x, y, z, w) _mm_castsi128_ps(_mm_shuffle_epi32( \
+            _mm_castps_si128(v), GZ_SHUFFLE_MASK(x, y, z, w)))
+        #define GZ_SHUFFLE(a, b, x, y, z, w) \
+            _mm_shuffle_ps(a, b, GZ_SHUFFLE_MASK(x, y, z, w))
+
+        // 2x2 matrix product A * B, with 2x2 matrices stored row-major in
+        // one register.
+        auto mul2 = [](__m128 _x, __m128 _y)
+        {
+          return _mm_add_ps(_mm_mul_ps(_x, GZ_SWIZZLE(_y, 0, 3, 0, 3)),
+              _mm_mul_ps(GZ_SWIZZLE(_x, 1, 0, 3, 2),
+                         GZ_SWIZZLE(_y, 2, 1, 2, 1)));
+        };
+        // 2x2 adjugate product adj(A) * B
+        auto adjMul2 = [](__m128 _x, __m128 _y)
+        {
+          return _mm_sub_ps(_mm_mul_ps(GZ_SWIZZLE(_x, 3, 3, 0, 0), _y),
+              _mm_mul_ps(GZ_SWIZZLE(_x, 1, 1, 2, 2),
+                         GZ_SWIZZLE(_y, 2, 3, 0, 1)));
+        };
+        // 2x2 product with adjugate A * adj(B)
+        auto mulAdj2 = [](__m128 _x, __m128 _y)
+        {
+          return _mm_sub_ps(_mm_mul_ps(_x, GZ_SWIZZLE(_y, 3, 0, 3, 0)),
+              _mm_mul_ps(GZ_SWIZZLE(_x, 1, 0, 3, 2),
+                         GZ_SWIZZLE(_y, 2, 1, 2, 1)));
+        };
+
+        const __m128 r0 = _mm_loadu_ps(_m);
+        const __m128 r1 = _mm_loadu_ps(_m + 4);
+        const __m128 r2 = _mm_loadu_ps(_m + 8);
+        const __m128 r3 = _mm_loadu_ps(_m + 12);
+
+        const __m128 a = _mm_movelh_ps(r0, r1);
+        const __m128 b = _mm_movehl_ps(r1, r0);
+        const __m128 c = _mm_movelh_ps(r2, r3);
+        const __m128 d = _mm_movehl_ps(r3, r2);
+
+        // Determinants of the blocks as (|A| |B| |C| |D|)
+        const __m128 detSub = _mm_sub_ps(
+            _mm_mul_ps(GZ_SHUFFLE(r0, r2, 0, 2, 0, 2),
+                       GZ_SHUFFLE(r1, r3, 1, 3, 1, 3)),
+            _mm_mul_ps(GZ_SHUFFLE(r0, r2, 1, 3, 1, 3),
+                       GZ_SHUFFLE(r1, r3, 0, 2, 0, 2)));
+        const __m128 detA = GZ_SWIZZLE(detSub, 0, 0, 0, 0);
+        const __m128 detB = GZ_SWIZZLE(detSub, 1, 1, 1, 1);
+        const __m128 detC = GZ_SWIZZLE(detSub, 2, 2, 2, 2);
+        const __m128 detD = GZ_SWIZZLE(detSub, 3, 3, 3, 3);
+
+        const __m128 dc = adjMul2(d, c);
+        const __m128 ab = adjMul2(a, b);
+
+        __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mul2(b, dc));
+        __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mul2(c, ab));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mulAdj2(d, ab));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mulAdj2(a, dc));
+
+        // |M| = |A||D| + |B||C| - tr(adj(A) B adj(D) C)
+        __m128 tr = _mm_mul_ps(ab, GZ_SWIZZLE(dc, 0, 2, 1, 3));
+        tr = _mm_add_ps(tr, GZ_SWIZZLE(tr, 1, 0, 3, 2));
+        tr = _mm_add_ps(tr, GZ_SWIZZLE(tr, 2, 3, 0, 1));
+        __m128 det = _mm_add_ps(_mm_mul_ps(detA, detD),
+                                _mm_mul_ps(detB, detC));
+        det = _mm_sub_ps(det, tr);
+
+        const __m128 invDet =
+          _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+
+        x = _mm_mul_ps(x, invDet);
+        y = _mm_mul_ps(y, invDet);
+        z = _mm_mul_ps(z, invDet);
+        w = _mm_mul_ps(w, invDet);
+
+        // Apply the adjugate shuffle while storing.
+        _mm_storeu_ps(_r, GZ_SHUFFLE(x, y, 3, 1, 3, 1));
+        _mm_storeu_ps(_r + 4, GZ_SHUFFLE(x, y, 2, 0, 2, 0));
+        _mm_storeu_ps(_r + 8, GZ_SHUFFLE(z, w, 3, 1, 3, 1));
+        _mm_storeu_ps(_r + 12, GZ_SHUFFLE(z, w, 2, 0, 2, 0));
+
+        #undef GZ_SHUFFLE
+        #undef GZ_SWIZZLE
+        #undef GZ_SHUFFLE_MASK
+        return true;
+      }
+
+      /// \brief SSE specialization of Matrix4Project for float, four
+      /// points at a time.
+      template<>
+      inline void Matrix4Project<float>(const float *_m, const float *_x,
+                                        const float *_y, const float *_z,
+                                        const std::size_t _count,
+                                        const float _halfWidth,
+                                        const float _halfHeight, float *_u,
+                                        float *_v, float *_depth,
+                                        uint8_t *_clip)
+      {
+        __m128 m[16];
+        for (std::size_t k = 0; k < 16; ++k)
+          m[k] = _mm_set1_ps(_m[k]);
+        __m128 bits[6];
+        for (int k = 0; k < 6; ++k)
+          bits[k] = _mm_castsi128_ps(_mm_set1_epi32(1 << k));
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 nan =
+            _mm_set1_ps(std::numeric_limits<float>::quiet_NaN());
+        const __m128 halfWidth = _mm_set1_ps(_halfWidth);
+        const __m128 halfHeight = _mm_set1_ps(_halfHeight);
+
+        std::size_t i = 0;
+        for (; i + 4 <= _count; i += 4)
+        {
+          const __m128 x = _mm_loadu_ps(_x + i);
+          const __m128 y = _mm_loadu_ps(_y + i);
+          const __m128 z = _mm_loadu_ps(_z + i);
+          __m128 c[4];
+          for (std::size_t r = 0; r < 4; ++r)
+          {
+            c[r] = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(m[4 * r], x), _mm_mul_ps(m[4 * r + 1], y)),
+                _mm_mul_ps(m[4 * r + 2], z)), m[4 * r + 3]);
+          }
+          const __m128 w = c[3];
+          const __m128 negW = _mm_sub_ps(zero, w);
+          __m128 code = _mm_setzero_ps();
+          for (std::size_t r = 0; r < 3; ++r)
+          {
+            code = _mm_or_ps(code,
+                _mm_and_ps(_mm_cmplt_ps(c[r], negW), bits[2 * r]));
+            code = _mm_or_ps(code,
+                _mm_and_ps(_mm_cmpgt_ps(c[r], w), bits[2 * r + 1]));
+          }
+          alignas(16) int32_t codes[4];
+          _mm_store_si128(reinterpret_cast<__m128i *>(codes),
+                          _mm_castps_si128(code));
+          for (std::size_t j = 0; j < 4; ++j)
+            _clip[i + j] = static_cast<uint8_t>(codes[j]);
+
+          const __m128 valid = _mm_cmpgt_ps(w, zero);
+          const __m128 invW = _mm_or_ps(
+              _mm_and_ps(valid, _mm_div_ps(one, w)),
+              _mm_andnot_ps(valid, nan));
+          _mm_storeu_ps(_u + i, _mm_mul_ps(
+              _mm_add_ps(_mm_mul_ps(c[0], invW), one), halfWidth));
+          _mm_storeu_ps(_v + i, _mm_mul_ps(
+              _mm_sub_ps(one, _mm_mul_ps(c[1], invW)), halfHeight));
+          _mm_storeu_ps(_depth + i, w);
+        }
+        for (; i < _count; ++i)
+        {
+          Matrix4ProjectPoint(_m, _x[i], _y[i], _z[i], _halfWidth,
+                              _halfHeight, _u[i], _v[i], _depth[i],
+                              _clip[i]);
+        }
+      }
+
+      /// \brief SSE/AVX specialization of Matrix4Project for double, two
+      /// or four points at a time.
+      template<>
+      inline void Matrix4Project<double>(const double *_m, const double *_x,
+                                         const double *_y, const double *_z,
+                                         const std::size_t _count,
+                                         const double _halfWidth,
+                                         const double _halfHeight,
+                                         double *_u, double *_v,
+                                         double *_depth, uint8_t *_clip)
+      {
+        std::size_t i = 0;
+#if defined(IGNITION_MATH_MATRIX4_AVX)
+        __m256d m[16];
+        for (std::size_t k = 0; k < 16; ++k)
+          m[k] = _mm256_set1_pd(_m[k]);
+        __m256d bits[6];
+        for (int k = 0; k < 6; ++k)
+          bits[k] = _mm256_castsi256_pd(_mm256_set1_epi64x(1 << k));
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d one = _mm256_set1_pd(1.0);
+        const __m256d nan =
+            _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN());
+        const __m256d halfWidth = _mm256_set1_pd(_halfWidth);
+        const __m256d halfHeight = _mm256_set1_pd(_halfHeight);
+
+        for (; i + 4 <= _count; i += 4)
+        {
+          const __m256d x = _mm256_loadu_pd(_x + i);
+          const __m256d y = _mm256_loadu_pd(_y + i);
+          const __m256d z = _mm256_loadu_pd(_z + i);
+          __m256d c[4];
+          for (std::size_t r = 0; r < 4; ++r)
+          {
+            c[r] = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+                _mm256_mul_pd(m[4 * r], x), _mm256_mul_pd(m[4 * r + 1], y)),
+                _mm256_mul_pd(m[4 * r + 2], z)), m[4 * r + 3]);
+          }
+          const __m256d w = c[3];
+          const __m256d negW = _mm256_sub_pd(zero, w);
+          __m256d code = _mm256_setzero_pd();
+          for (std::size_t r = 0; r < 3; ++r)
+          {
+            code = _mm256_or_pd(code, _mm256_and_pd(
+                _mm256_cmp_pd(c[r], negW, _CMP_LT_OQ), bits[2 * r]));
+            code = _mm256_or_pd(code, _mm256_and_pd(
+                _mm256_cmp_pd(c[r], w, _CMP_GT_OQ), bits[2 * r + 1]));
+          }
+          alignas(32) int64_t codes[4];
+          _mm256_store_si256(reinterpret_cast<__m256i *>(codes),
+                             _mm256_castpd_si256(code));
+          for (std::size_t j = 0; j < 4; ++j)
+            _clip[i + j] = static_cast<uint8_t>(codes[j]);
+
+          const __m256d valid = _mm256_cmp_pd(w, zero, _CMP_GT_OQ);
+          const __m256d invW = _mm256_blendv_pd(nan,
+              _mm256_div_pd(one, w), valid);
+          _mm256_storeu_pd(_u + i, _mm256_mul_pd(
+              _mm256_add_pd(_mm256_mul_pd(c[0], invW), one), halfWidth));
+          _mm256_storeu_pd(_v + i, _mm256_mul_pd(
+              _mm256_sub_pd(one, _mm256_mul_pd(c[1], invW)), halfHeight));
+          _mm256_storeu_pd(_depth + i, w);
+        }
+#else
+        __m128d m[16];
+        for (std::size_t k = 0; k < 16; ++k)
+          m[k] = _mm_set1_pd(_m[k]);
+        __m128d bits[6];
+        for (int k = 0; k < 6; ++k)
+          bits[k] = _mm_castsi128_pd(_mm_set1_epi64x(1 << k));
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d one = _mm_set1_pd(1.0);
+        const __m128d nan =
+            _mm_set1_pd(std::numeric_limits<double>::quiet_NaN());
+        const __m128d halfWidth = _mm_set1_pd(_halfWidth);
+        const __m128d halfHeight = _mm_set1_pd(_halfHeight);
+
+        for (; i + 2 <= _count; i += 2)
+        {
+          const __m128d x = _mm_loadu_pd(_x + i);
+          const __m128d y = _mm_loadu_pd(_y + i);
+          const __m128d z = _mm_loadu_pd(_z + i);
+          __m128d c[4];
+          for (std::size_t r = 0; r < 4; ++r)
+          {
+            c[r] = _mm_add_pd(_mm_add_pd(_mm_add_pd(
+                _mm_mul_pd(m[4 * r], x), _mm_mul_pd(m[4 * r + 1], y)),
+                _mm_mul_pd(m[4 * r + 2], z)), m[4 * r + 3]);
+          }
+          const __m128d w = c[3];
+          const __m128d negW = _mm_sub_pd(zero, w);
+          __m128d code = _mm_setzero_pd();
+          for (std::size_t r = 0; r < 3; ++r)
+          {
+            code = _mm_or_pd(code,
+                _mm_and_pd(_mm_cmplt_pd(c[r], negW), bits[2 * r]));
+            code = _mm_or_pd(code,
+                _mm_and_pd(_mm_cmpgt_pd(c[r], w), bits[2 * r + 1]));
+          }
+          alignas(16) int64_t codes[2];
+          _mm_store_si128(reinterpret_cast<__m128i *>(codes),
+                          _mm_castpd_si128(code));
+          _clip[i] = static_cast<uint8_t>(codes[0]);
+          _clip[i + 1] = static_cast<uint8_t>(codes[1]);
+
+          const __m128d valid = _mm_cmpgt_pd(w, zero);
+          const __m128d invW = _mm_or_pd(
+              _mm_and_pd(valid, _mm_div_pd(one, w)),
+              _mm_andnot_pd(valid, nan));
+          _mm_storeu_pd(_u + i, _mm_mul_pd(
+              _mm_add_pd(_mm_mul_pd(c[0], invW), one), halfWidth));
+          _mm_storeu_pd(_v + i, _mm_mul_pd(
+              _mm_sub_pd(one, _mm_mul_pd(c[1], invW)), halfHeight));
+          _mm_storeu_pd(_depth + i, w);
+        }
+#endif
+        for (; i < _count; ++i)
+        {
+          Matrix4ProjectPoint(_m, _x[i], _y[i], _z[i], _halfWidth,
+                              _halfHeight, _u[i], _v[i], _depth[i],
+                              _clip[i]);
+        }
+      }
+#elif defined(IGNITION_MATH_MATRIX4_NEON)
+      /// \brief NEON specialization of Matrix4Multiply for float.
+      template<>
+      inline void Matrix4Multiply<float>(const float *_a, const float *_b,
+                                         float *_r)
+      {
+        const float32x4_t b0 = vld1q_f32(_b);
+        const float32x4_t b1 = vld1q_f32(_b + 4);
+        const float32x4_t b2 = vld1q_f32(_b + 8);
+        const float32x4_t b3 = vld1q_f32(_b + 12);
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+          const float *a = _a + i * 4;
+          float32x4_t row = vmulq_n_f32(b0, a[0]);
+          row = vmlaq_n_f32(row, b1, a[1]);
+          row = vmlaq_n_f32(row, b2, a[2]);
+          row = vmlaq_n_f32(row, b3, a[3]);
+          vst1q_f32(_r + i * 4, row);
+        }
+      }
+#endif
+    }
+    }
+  }
+}
+#endif
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_MATRIX6SIMD_HH_
+#define GZ_MATH_DETAIL_MATRIX6SIMD_HH_
+
+#include <cstddef>
+
+#include <gz/math/config.hh>
+
+// Select the instruction set used by the Matrix6 kernels at compile time.
+// Define IGNITION_MATH_DISABLE_SIMD to always use the portable scalar code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define IGNITION_MATH_MATRIX6_SSE2 1
+    #include <emmintrin.h>
+  #elif defined(__aarch64__)
+    #define IGNITION_MATH_MATRIX6_NEON 1
+    #include <arm_neon.h>
+  #endif
+#endif
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Multiply two row-major 6x6 matrices, _r = _a * _b.
+      /// This is the portable implementation, used for any T without a
+      /// specialization below. _r must not alias _a or _b.
+      /// \param[in] _a Left operand, 36 contiguous values.
+      /// \param[in] _b Right operand, 36 contiguous values.
+      /// \param[out] _r Result, 36 contiguous values.
+      template<typename T>
+      inline void Matrix6Multiply(const T *_a, const T *_b, T *_r)
+      {
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+          const T *a = _a + i * 6;
+          T *r = _r + i * 6;
+          for (std::size_t j = 0; j < 6; ++j)
+            r[j] = a[0] * _b[j];
+          for (std::size_t k = 1; k < 6; ++k)
+          {
+            for (std::size_t j = 0; j < 6; ++j)
+              r[j] += a[k] * _b[k * 6 + j];
+          }
+        }
+      }
+
+#if defined(IGNITION_MATH_MATRIX6_SSE2)
+      /// \brief SSE2 specialization of Matrix6Multiply for double. Each row
+      /// of the result is three pairs of doubles, accumulated in registers.
+      template<>
+      inline void Matrix6Multiply<double>(const double *_a, const double *_b,
+                                          double *_r)
+      {
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+          const double *a = _a + i * 6;
+          __m128d s = _mm_set1_pd(a[0]);
+          __m128d r0 = _mm_mul_pd(s, _mm_loadu_pd(_b));
+          __m128d r1 = _mm_mul_pd(s, _mm_loadu_pd(_b + 2));
+          __m128d r2 = _mm_mul_pd(s, _mm_loadu_pd(_b + 4));
+          for (std::size_t k = 1; k < 6; ++k)
+          {
+            const double *b = _b + k * 6;
+            s = _mm_set1_pd(a[k]);
+            r0 = _mm_add_pd(r0, _mm_mul_pd(s, _mm_loadu_pd(b)));
+            r1 = _mm_add_pd(r1, _mm_mul_pd(s, _mm_loadu_pd(b + 2)));
+            r2 = _mm_add_pd(r2, _mm_mul_pd(s, _mm_loadu_pd(b + 4)));
+          }
+          _mm_storeu_pd(_r + i * 6, r0);
+          _mm_storeu_pd(_r + i * 6 + 2, r1);
+          _mm_storeu_pd(_r + i * 6 + 4, r2);
+        }
+      }
+#elif defined(IGNITION_MATH_MATRIX6_NEON)
+      /// \brief NEON specialization of Matrix6Multiply for double. Each row
+      /// of the result is three pairs of doubles, accumulated in registers.
+      template<>
+      inline void Matrix6Multiply<double>(const double *_a, const double *_b,
+                                          double *_r)
+      {
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+          const double *a = _a + i * 6;
+          float64x2_t r0 = vmulq_n_f64(vld1q_f64(_b), a[0]);
+          float64x2_t r1 = vmulq_n_f64(vld1q_f64(_b + 2), a[0]);
+          float64x2_t r2 = vmulq_n_f64(vld1q_f64(_b + 4), a[0]);
+          for (std::size_t k = 1; k < 6; ++k)
+          {
+            const double *b = _b + k * 6;
+            r0 = vfmaq_n_f64(r0, vld1q_f64(b), a[k]);
+            r1 = vfmaq_n_f64(r1, vld1q_f64(b + 2), a[k]);
+            r2 = vfmaq_n_f64(r2, vld1q_f64(b + 4), a[k]);
+          }
+          vst1q_f64(_r + i * 6, r0);
+          vst1q_f64(_r + i * 6 + 2, r1);
+          vst1q_f64(_r + i * 6 + 4, r2);
+        }
+      }
+#endif
+    }
+    }
+  }
+}
+#endif
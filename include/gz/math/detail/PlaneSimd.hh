@@ -0,0 +1,583 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_PLANESIMD_HH_
+#define GZ_MATH_DETAIL_PLANESIMD_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include <gz/math/config.hh>
+
+// Select the instruction set used by the Plane kernels at compile time.
+// Define IGNITION_MATH_DISABLE_SIMD to always use the portable scalar code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD)
+  #if defined(__AVX__)
+    #define IGNITION_MATH_PLANE_AVX 1
+    #include <immintrin.h>
+  #elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define IGNITION_MATH_PLANE_SSE2 1
+    #include <emmintrin.h>
+  #endif
+#endif
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Compute the signed distances of points to a plane,
+      /// _out[i] = _nx * _x[i] + _ny * _y[i] + _nz * _z[i] - _d, which is
+      /// the same expression as Plane::Distance. This is the portable
+      /// implementation, used for any T without a specialization below.
+      /// \param[in] _nx X component of the plane normal.
+      /// \param[in] _ny Y component of the plane normal.
+      /// \param[in] _nz Z component of the plane normal.
+      /// \param[in] _d Plane offset.
+      /// \param[in] _x Array of _count x coordinates.
+      /// \param[in] _y Array of _count y coordinates.
+      /// \param[in] _z Array of _count z coordinates.
+      /// \param[in] _count Number of points.
+      /// \param[out] _out Array of at least _count distances.
+      template<typename T>
+      inline void PlaneDistances(const T _nx, const T _ny, const T _nz,
+                                 const T _d, const T *_x, const T *_y,
+                                 const T *_z, const std::size_t _count,
+                                 T *_out)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = _nx * _x[i] + _ny * _y[i] + _nz * _z[i] - _d;
+      }
+
+      /// \brief Classify signed distances against a band around a plane.
+      /// _out[i] is 0, the negative side, if _dist[i] < -_radius[i], 1, the
+      /// positive side, if _dist[i] > _radius[i], and _onSide otherwise.
+      /// This is the portable implementation, used for any T without an
+      /// overload below.
+      /// \param[in] _dist Array of _count signed distances.
+      /// \param[in] _radius Array of _count band radii, or nullptr for a
+      /// band of zero width.
+      /// \param[in] _count Number of distances.
+      /// \param[in] _onSide Value written for distances within the band.
+      /// \param[out] _out Array of at least _count sides.
+      /// \tparam Side Enum type of the sides.
+      template<typename T, typename Side>
+      inline void PlaneClassify(const T *_dist, const T *_radius,
+                                const std::size_t _count, const Side _onSide,
+                                Side *_out)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const T r = _radius ? _radius[i] : T(0);
+          if (_dist[i] < -r)
+            _out[i] = static_cast<Side>(0);
+          else if (_dist[i] > r)
+            _out[i] = static_cast<Side>(1);
+          else
+            _out[i] = _onSide;
+        }
+      }
+
+      /// \brief Count the values within a range, such as the distances of
+      /// points within a band around a plane. Values that are NaN are not
+      /// counted. This is the portable implementation, used for any T
+      /// without a specialization below.
+      /// \param[in] _values Array of _count values.
+      /// \param[in] _count Number of values.
+      /// \param[in] _low Lowest value counted.
+      /// \param[in] _high Highest value counted.
+      /// \return Number of values in [_low, _high].
+      template<typename T>
+      inline std::size_t CountInRange(const T *_values,
+                                      const std::size_t _count,
+                                      const T _low, const T _high)
+      {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+          n += (_values[i] >= _low) & (_values[i] <= _high);
+        return n;
+      }
+
+      /// \brief Intersect rays with a plane, with the same expressions as
+      /// Plane::Intersection. A ray hits the plane when the absolute dot
+      /// product of the plane normal and its direction is at least
+      /// _tolerance and the hit is not behind its origin. Hit points and
+      /// parameters of the rays that miss are NaN. This is the portable
+      /// implementation, also used for the last elements by the
+      /// specializations of PlaneRayHits.
+      /// \param[in] _nx X component of the plane normal.
+      /// \param[in] _ny Y component of the plane normal.
+      /// \param[in] _nz Z component of the plane normal.
+      /// \param[in] _d Plane offset.
+      /// \param[in] _tolerance Smallest absolute dot product of the normal
+      /// and a direction for a ray that is not parallel to the plane.
+      /// \param[in] _ox Array of _count x coordinates of the origins.
+      /// \param[in] _oy Array of _count y coordinates of the origins.
+      /// \param[in] _oz Array of _count z coordinates of the origins.
+      /// \param[in] _dx Array of _count x coordinates of the directions.
+      /// \param[in] _dy Array of _count y coordinates of the directions.
+      /// \param[in] _dz Array of _count z coordinates of the directions.
+      /// \param[in] _count Number of rays.
+      /// \param[out] _hx Array of at least _count x coordinates of the hits.
+      /// \param[out] _hy Array of at least _count y coordinates of the hits.
+      /// \param[out] _hz Array of at least _count z coordinates of the hits.
+      /// \param[out] _t Array of at least _count ray parameters of the hits.
+      /// \param[out] _valid Array of at least _count values, 1 for the rays
+      /// that hit the plane and 0 otherwise.
+      /// \return Number of rays that hit the plane.
+      template<typename T>
+      inline std::size_t PlaneRayHitsScalar(const T _nx, const T _ny,
+          const T _nz, const T _d, const T _tolerance,
+          const T *_ox, const T *_oy, const T *_oz,
+          const T *_dx, const T *_dy, const T *_dz, const std::size_t _count,
+          T *_hx, T *_hy, T *_hz, T *_t, uint8_t *_valid)
+      {
+        const T nan = std::numeric_limits<T>::quiet_NaN();
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const T denom = _nx * _dx[i] + _ny * _dy[i] + _nz * _dz[i];
+          const T t =
+            (_d - (_nx * _ox[i] + _ny * _oy[i] + _nz * _oz[i])) / denom;
+          const bool hit = std::abs(denom) >= _tolerance && t >= 0;
+          _hx[i] = hit ? _ox[i] + _dx[i] * t : nan;
+          _hy[i] = hit ? _oy[i] + _dy[i] * t : nan;
+          _hz[i] = hit ? _oz[i] + _dz[i] * t : nan;
+          _t[i] = hit ? t : nan;
+          _valid[i] = hit;
+          n += hit;
+        }
+        return n;
+      }
+
+      /// \brief Intersect rays with a plane, see PlaneRayHitsScalar. This is
+      /// the portable implementation, used for any T without a
+      /// specialization below.
+      /// \return Number of rays that hit the plane.
+      template<typename T>
+      inline std::size_t PlaneRayHits(const T _nx, const T _ny, const T _nz,
+          const T _d, const T _tolerance,
+          const T *_ox, const T *_oy, const T *_oz,
+          const T *_dx, const T *_dy, const T *_dz, const std::size_t _count,
+          T *_hx, T *_hy, T *_hz, T *_t, uint8_t *_valid)
+      {
+        return PlaneRayHitsScalar(_nx, _ny, _nz, _d, _tolerance, _ox, _oy,
+            _oz, _dx, _dy, _dz, _count, _hx, _hy, _hz, _t, _valid);
+      }
+
+#if defined(IGNITION_MATH_PLANE_AVX) || defined(IGNITION_MATH_PLANE_SSE2)
+      /// \brief SSE/AVX specialization of PlaneDistances for double.
+      template<>
+      inline void PlaneDistances<double>(const double _nx, const double _ny,
+                                         const double _nz, const double _d,
+                                         const double *_x, const double *_y,
+                                         const double *_z,
+                                         const std::size_t _count,
+                                         double *_out)
+      {
+        std::size_t i = 0;
+#if defined(IGNITION_MATH_PLANE_AVX)
+        const __m256d nx = _mm256_set1_pd(_nx);
+        const __m256d ny = _mm256_set1_pd(_ny);
+        const __m256d nz = _mm256_set1_pd(_nz);
+        const __m256d d = _mm256_set1_pd(_d);
+        for (; i + 4 <= _count; i += 4)
+        {
+          __m256d r = _mm256_mul_pd(nx, _mm256_loadu_pd(_x + i));
+          r = _mm256_add_pd(r, _mm256_mul_pd(ny, _mm256_loadu_pd(_y + i)));
+          r = _mm256_add_pd(r, _mm256_mul_pd(nz, _mm256_loadu_pd(_z + i)));
+          _mm256_storeu_pd(_out + i, _mm256_sub_pd(r, d));
+        }
+#else
+        const __m128d nx = _mm_set1_pd(_nx);
+        const __m128d ny = _mm_set1_pd(_ny);
+        const __m128d nz = _mm_set1_pd(_nz);
+        const __m128d d = _mm_set1_pd(_d);
+        for (; i + 2 <= _count; i += 2)
+        {
+          __m128d r = _mm_mul_pd(nx, _mm_loadu_pd(_x + i));
+          r = _mm_add_pd(r, _mm_mul_pd(ny, _mm_loadu_pd(_y + i)));
+          r = _mm_add_pd(r, _mm_mul_pd(nz, _mm_loadu_pd(_z + i)));
+          _mm_storeu_pd(_out + i, _mm_sub_pd(r, d));
+        }
+#endif
+        for (; i < _count; ++i)
+          _out[i] = _nx * _x[i] + _ny * _y[i] + _nz * _z[i] - _d;
+      }
+
+      /// \brief SSE/AVX specialization of PlaneDistances for float.
+      template<>
+      inline void PlaneDistances<float>(const float _nx, const float _ny,
+                                        const float _nz, const float _d,
+                                        const float *_x, const float *_y,
+                                        const float *_z,
+                                        const std::size_t _count,
+                                        float *_out)
+      {
+        std::size_t i = 0;
+#if defined(IGNITION_MATH_PLANE_AVX)
+        const __m256 nx = _mm256_set1_ps(_nx);
+        const __m256 ny = _mm256_set1_ps(_ny);
+        const __m256 nz = _mm256_set1_ps(_nz);
+        const __m256 d = _mm256_set1_ps(_d);
+        for (; i + 8 <= _count; i += 8)
+        {
+          __m256 r = _mm256_mul_ps(nx, _mm256_loadu_ps(_x + i));
+          r = _mm256_add_ps(r, _mm256_mul_ps(ny, _mm256_loadu_ps(_y + i)));
+          r = _mm256_add_ps(r, _mm256_mul_ps(nz, _mm256_loadu_ps(_z + i)));
+          _mm256_storeu_ps(_out + i, _mm256_sub_ps(r, d));
+        }
+#else
+        const __m128 nx = _mm_set1_ps(_nx);
+        const __m128 ny = _mm_set1_ps(_ny);
+        const __m128 nz = _mm_set1_ps(_nz);
+        const __m128 d = _mm_set1_ps(_d);
+        for (; i + 4 <= _count; i += 4)
+        {
+          __m128 r = _mm_mul_ps(nx, _mm_loadu_ps(_x + i));
+          r = _mm_add_ps(r, _mm_mul_ps(ny, _mm_loadu_ps(_y + i)));
+          r = _mm_add_ps(r, _mm_mul_ps(nz, _mm_loadu_ps(_z + i)));
+          _mm_storeu_ps(_out + i, _mm_sub_ps(r, d));
+        }
+#endif
+        for (; i < _count; ++i)
+          _out[i] = _nx * _x[i] + _ny * _y[i] + _nz * _z[i] - _d;
+      }
+
+      /// \brief Select the sides of four lanes from 32 bit comparison
+      /// masks, without branches.
+      /// \param[in] _lt Lanes below the band.
+      /// \param[in] _gt Lanes above the band.
+      /// \param[in] _onSide Value for lanes within the band, in every lane.
+      /// \return Side of each lane: 0 below, 1 above or _onSide.
+      inline __m128 PlaneSelectSides(const __m128 _lt, const __m128 _gt,
+                                     const __m128 _onSide)
+      {
+        const __m128 one = _mm_castsi128_ps(_mm_set1_epi32(1));
+        return _mm_or_ps(_mm_andnot_ps(_mm_or_ps(_lt, _gt), _onSide),
+                         _mm_and_ps(_gt, one));
+      }
+
+      /// \brief SSE/AVX overload of PlaneClassify for double. Sides are
+      /// stored four at a time as 32 bit integers, so enums of any other
+      /// size use the portable implementation.
+      template<typename Side>
+      inline void PlaneClassify(const double *_dist, const double *_radius,
+                                const std::size_t _count, const Side _onSide,
+                                Side *_out)
+      {
+        std::size_t i = 0;
+        if constexpr (sizeof(Side) == sizeof(int))
+        {
+          const __m128 onSide =
+            _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(_onSide)));
+#if defined(IGNITION_MATH_PLANE_AVX)
+          const __m256d zero = _mm256_setzero_pd();
+          for (; i + 4 <= _count; i += 4)
+          {
+            const __m256d dist = _mm256_loadu_pd(_dist + i);
+            const __m256d r = _radius ? _mm256_loadu_pd(_radius + i) : zero;
+            const __m256 lt = _mm256_castpd_ps(
+                _mm256_cmp_pd(dist, _mm256_sub_pd(zero, r), _CMP_LT_OQ));
+            const __m256 gt = _mm256_castpd_ps(
+                _mm256_cmp_pd(dist, r, _CMP_GT_OQ));
+            // Keep one 32 bit half of each 64 bit mask
+            const __m128 lt4 = _mm_shuffle_ps(_mm256_castps256_ps128(lt),
+                _mm256_extractf128_ps(lt, 1), _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 gt4 = _mm_shuffle_ps(_mm256_castps256_ps128(gt),
+                _mm256_extractf128_ps(gt, 1), _MM_SHUFFLE(2, 0, 2, 0));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(_out + i),
+                _mm_castps_si128(PlaneSelectSides(lt4, gt4, onSide)));
+          }
+#else
+          const __m128d zero = _mm_setzero_pd();
+          for (; i + 4 <= _count; i += 4)
+          {
+            const __m128d dist0 = _mm_loadu_pd(_dist + i);
+            const __m128d dist1 = _mm_loadu_pd(_dist + i + 2);
+            const __m128d r0 = _radius ? _mm_loadu_pd(_radius + i) : zero;
+            const __m128d r1 = _radius ? _mm_loadu_pd(_radius + i + 2) : zero;
+            // Keep one 32 bit half of each 64 bit mask
+            const __m128 lt4 = _mm_shuffle_ps(
+                _mm_castpd_ps(_mm_cmplt_pd(dist0, _mm_sub_pd(zero, r0))),
+                _mm_castpd_ps(_mm_cmplt_pd(dist1, _mm_sub_pd(zero, r1))),
+                _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 gt4 = _mm_shuffle_ps(
+                _mm_castpd_ps(_mm_cmpgt_pd(dist0, r0)),
+                _mm_castpd_ps(_mm_cmpgt_pd(dist1, r1)),
+                _MM_SHUFFLE(2, 0, 2, 0));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(_out + i),
+                _mm_castps_si128(PlaneSelectSides(lt4, gt4, onSide)));
+          }
+#endif
+        }
+        PlaneClassify<double, Side>(_dist + i, _radius ? _radius + i : nullptr,
+                                    _count - i, _onSide, _out + i);
+      }
+
+      /// \brief SSE overload of PlaneClassify for float. Sides are stored
+      /// four at a time as 32 bit integers, so enums of any other size use
+      /// the portable implementation.
+      template<typename Side>
+      inline void PlaneClassify(const float *_dist, const float *_radius,
+                                const std::size_t _count, const Side _onSide,
+                                Side *_out)
+      {
+        std::size_t i = 0;
+        if constexpr (sizeof(Side) == sizeof(int))
+        {
+          const __m128 onSide =
+            _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(_onSide)));
+          const __m128 zero = _mm_setzero_ps();
+          for (; i + 4 <= _count; i += 4)
+          {
+            const __m128 dist = _mm_loadu_ps(_dist + i);
+            const __m128 r = _radius ? _mm_loadu_ps(_radius + i) : zero;
+            const __m128 lt = _mm_cmplt_ps(dist, _mm_sub_ps(zero, r));
+            const __m128 gt = _mm_cmpgt_ps(dist, r);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(_out + i),
+                _mm_castps_si128(PlaneSelectSides(lt, gt, onSide)));
+          }
+        }
+        PlaneClassify<float, Side>(_dist + i, _radius ? _radius + i : nullptr,
+                                   _count - i, _onSide, _out + i);
+      }
+
+      /// \brief SSE/AVX specialization of CountInRange for double. Lanes in
+      /// the range add 1.0 to per-lane sums, which are exact below 2^53.
+      template<>
+      inline std::size_t CountInRange<double>(const double *_values,
+                                              const std::size_t _count,
+                                              const double _low,
+                                              const double _high)
+      {
+        std::size_t i = 0;
+        double lanes[4] = {0, 0, 0, 0};
+#if defined(IGNITION_MATH_PLANE_AVX)
+        const __m256d low = _mm256_set1_pd(_low);
+        const __m256d high = _mm256_set1_pd(_high);
+        const __m256d one = _mm256_set1_pd(1.0);
+        __m256d sum = _mm256_setzero_pd();
+        for (; i + 4 <= _count; i += 4)
+        {
+          const __m256d v = _mm256_loadu_pd(_values + i);
+          const __m256d in = _mm256_and_pd(
+              _mm256_cmp_pd(v, low, _CMP_GE_OQ),
+              _mm256_cmp_pd(v, high, _CMP_LE_OQ));
+          sum = _mm256_add_pd(sum, _mm256_and_pd(in, one));
+        }
+        _mm256_storeu_pd(lanes, sum);
+#else
+        const __m128d low = _mm_set1_pd(_low);
+        const __m128d high = _mm_set1_pd(_high);
+        const __m128d one = _mm_set1_pd(1.0);
+        __m128d sum0 = _mm_setzero_pd();
+        __m128d sum1 = _mm_setzero_pd();
+        for (; i + 4 <= _count; i += 4)
+        {
+          const __m128d v0 = _mm_loadu_pd(_values + i);
+          const __m128d v1 = _mm_loadu_pd(_values + i + 2);
+          sum0 = _mm_add_pd(sum0, _mm_and_pd(_mm_and_pd(
+              _mm_cmpge_pd(v0, low), _mm_cmple_pd(v0, high)), one));
+          sum1 = _mm_add_pd(sum1, _mm_and_pd(_mm_and_pd(
+              _mm_cmpge_pd(v1, low), _mm_cmple_pd(v1, high)), one));
+        }
+        _mm_storeu_pd(lanes, sum0);
+        _mm_storeu_pd(lanes + 2, sum1);
+#endif
+        std::size_t n = static_cast<std::size_t>(
+            lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+        for (; i < _count; ++i)
+          n += (_values[i] >= _low) & (_values[i] <= _high);
+        return n;
+      }
+
+      /// \brief SSE/AVX specialization of PlaneRayHits for double.
+      template<>
+      inline std::size_t PlaneRayHits<double>(const double _nx,
+          const double _ny, const double _nz, const double _d,
+          const double _tolerance,
+          const double *_ox, const double *_oy, const double *_oz,
+          const double *_dx, const double *_dy, const double *_dz,
+          const std::size_t _count,
+          double *_hx, double *_hy, double *_hz, double *_t, uint8_t *_valid)
+      {
+        std::size_t i = 0;
+        std::size_t n = 0;
+#if defined(IGNITION_MATH_PLANE_AVX)
+        const __m256d nx = _mm256_set1_pd(_nx);
+        const __m256d ny = _mm256_set1_pd(_ny);
+        const __m256d nz = _mm256_set1_pd(_nz);
+        const __m256d d = _mm256_set1_pd(_d);
+        const __m256d tolerance = _mm256_set1_pd(_tolerance);
+        const __m256d sign = _mm256_set1_pd(-0.0);
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d nan =
+          _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN());
+        for (; i + 4 <= _count; i += 4)
+        {
+          const __m256d ox = _mm256_loadu_pd(_ox + i);
+          const __m256d oy = _mm256_loadu_pd(_oy + i);
+          const __m256d oz = _mm256_loadu_pd(_oz + i);
+          const __m256d dx = _mm256_loadu_pd(_dx + i);
+          const __m256d dy = _mm256_loadu_pd(_dy + i);
+          const __m256d dz = _mm256_loadu_pd(_dz + i);
+          __m256d denom = _mm256_mul_pd(nx, dx);
+          denom = _mm256_add_pd(denom, _mm256_mul_pd(ny, dy));
+          denom = _mm256_add_pd(denom, _mm256_mul_pd(nz, dz));
+          __m256d dot = _mm256_mul_pd(nx, ox);
+          dot = _mm256_add_pd(dot, _mm256_mul_pd(ny, oy));
+          dot = _mm256_add_pd(dot, _mm256_mul_pd(nz, oz));
+          const __m256d t = _mm256_div_pd(_mm256_sub_pd(d, dot), denom);
+          const __m256d hit = _mm256_and_pd(
+              _mm256_cmp_pd(_mm256_andnot_pd(sign, denom), tolerance,
+                            _CMP_GE_OQ),
+              _mm256_cmp_pd(t, zero, _CMP_GE_OQ));
+          _mm256_storeu_pd(_hx + i, _mm256_blendv_pd(nan,
+              _mm256_add_pd(ox, _mm256_mul_pd(dx, t)), hit));
+          _mm256_storeu_pd(_hy + i, _mm256_blendv_pd(nan,
+              _mm256_add_pd(oy, _mm256_mul_pd(dy, t)), hit));
+          _mm256_storeu_pd(_hz + i, _mm256_blendv_pd(nan,
+              _mm256_add_pd(oz, _mm256_mul_pd(dz, t)), hit));
+          _mm256_storeu_pd(_t + i, _mm256_blendv_pd(nan, t, hit));
+
+          const int mask = _mm256_movemask_pd(hit);
+          for (int k = 0; k < 4; ++k)
+          {
+            _valid[i + k] = static_cast<uint8_t>((mask >> k) & 1);
+            n += _valid[i + k];
+          }
+        }
+#else
+        const __m128d nx = _mm_set1_pd(_nx);
+        const __m128d ny = _mm_set1_pd(_ny);
+        const __m128d nz = _mm_set1_pd(_nz);
+        const __m128d d = _mm_set1_pd(_d);
+        const __m128d tolerance = _mm_set1_pd(_tolerance);
+        const __m128d sign = _mm_set1_pd(-0.0);
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d nan =
+          _mm_set1_pd(std::numeric_limits<double>::quiet_NaN());
+        for (; i + 2 <= _count; i += 2)
+        {
+          const __m128d ox = _mm_loadu_pd(_ox + i);
+          const __m128d oy = _mm_loadu_pd(_oy + i);
+          const __m128d oz = _mm_loadu_pd(_oz + i);
+          const __m128d dx = _mm_loadu_pd(_dx + i);
+          const __m128d dy = _mm_loadu_pd(_dy + i);
+          const __m128d dz = _mm_loadu_pd(_dz + i);
+          __m128d denom = _mm_mul_pd(nx, dx);
+          denom = _mm_add_pd(denom, _mm_mul_pd(ny, dy));
+          denom = _mm_add_pd(denom, _mm_mul_pd(nz, dz));
+          __m128d dot = _mm_mul_pd(nx, ox);
+          dot = _mm_add_pd(dot, _mm_mul_pd(ny, oy));
+          dot = _mm_add_pd(dot, _mm_mul_pd(nz, oz));
+          const __m128d t = _mm_div_pd(_mm_sub_pd(d, dot), denom);
+          const __m128d hit = _mm_and_pd(
+              _mm_cmpge_pd(_mm_andnot_pd(sign, denom), tolerance),
+              _mm_cmpge_pd(t, zero));
+          const __m128d miss = _mm_andnot_pd(hit, nan);
+          _mm_storeu_pd(_hx + i, _mm_or_pd(miss, _mm_and_pd(hit,
+              _mm_add_pd(ox, _mm_mul_pd(dx, t)))));
+          _mm_storeu_pd(_hy + i, _mm_or_pd(miss, _mm_and_pd(hit,
+              _mm_add_pd(oy, _mm_mul_pd(dy, t)))));
+          _mm_storeu_pd(_hz + i, _mm_or_pd(miss, _mm_and_pd(hit,
+              _mm_add_pd(oz, _mm_mul_pd(dz, t)))));
+          _mm_storeu_pd(_t + i, _mm_or_pd(miss, _mm_and_pd(hit, t)));
+
+          const int mask = _mm_movemask_pd(hit);
+          _valid[i] = static_cast<uint8_t>(mask & 1);
+          _valid[i + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+          n += _valid[i] + _valid[i + 1];
+        }
+#endif
+        return n + PlaneRayHitsScalar(_nx, _ny, _nz, _d, _tolerance,
+            _ox + i, _oy + i, _oz + i, _dx + i, _dy + i, _dz + i, _count - i,
+            _hx + i, _hy + i, _hz + i, _t + i, _valid + i);
+      }
+
+      /// \brief SSE specialization of PlaneRayHits for float.
+      template<>
+      inline std::size_t PlaneRayHits<float>(const float _nx,
+          const float _ny, const float _nz, const float _d,
+          const float _tolerance,
+          const float *_ox, const float *_oy, const float *_oz,
+          const float *_dx, const float *_dy, const float *_dz,
+          const std::size_t _count,
+          float *_hx, float *_hy, float *_hz, float *_t, uint8_t *_valid)
+      {
+        std::size_t i = 0;
+        std::size_t n = 0;
+        const __m128 nx = _mm_set1_ps(_nx);
+        const __m128 ny = _mm_set1_ps(_ny);
+        const __m128 nz = _mm_set1_ps(_nz);
+        const __m128 d = _mm_set1_ps(_d);
+        const __m128 tolerance = _mm_set1_ps(_tolerance);
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 nan =
+          _mm_set1_ps(std::numeric_limits<float>::quiet_NaN());
+        for (; i + 4 <= _count; i += 4)
+        {
+          const __m128 ox = _mm_loadu_ps(_ox + i);
+          const __m128 oy = _mm_loadu_ps(_oy + i);
+          const __m128 oz = _mm_loadu_ps(_oz + i);
+          const __m128 dx = _mm_loadu_ps(_dx + i);
+          const __m128 dy = _mm_loadu_ps(_dy + i);
+          const __m128 dz = _mm_loadu_ps(_dz + i);
+          __m128 denom = _mm_mul_ps(nx, dx);
+          denom = _mm_add_ps(denom, _mm_mul_ps(ny, dy));
+          denom = _mm_add_ps(denom, _mm_mul_ps(nz, dz));
+          __m128 dot = _mm_mul_ps(nx, ox);
+          dot = _mm_add_ps(dot, _mm_mul_ps(ny, oy));
+          dot = _mm_add_ps(dot, _mm_mul_ps(nz, oz));
+          const __m128 t = _mm_div_ps(_mm_sub_ps(d, dot), denom);
+          const __m128 hit = _mm_and_ps(
+              _mm_cmpge_ps(_mm_andnot_ps(sign, denom), tolerance),
+              _mm_cmpge_ps(t, zero));
+          const __m128 miss = _mm_andnot_ps(hit, nan);
+          _mm_storeu_ps(_hx + i, _mm_or_ps(miss, _mm_and_ps(hit,
+              _mm_add_ps(ox, _mm_mul_ps(dx, t)))));
+          _mm_storeu_ps(_hy + i, _mm_or_ps(miss, _mm_and_ps(hit,
+              _mm_add_ps(oy, _mm_mul_ps(dy, t)))));
+          _mm_storeu_ps(_hz + i, _mm_or_ps(miss, _mm_and_ps(hit,
+              _mm_add_ps(oz, _mm_mul_ps(dz, t)))));
+          _mm_storeu_ps(_t + i, _mm_or_ps(miss, _mm_and_ps(hit, t)));
+
+          const int mask = _mm_movemask_ps(hit);
+          for (int k = 0; k < 4; ++k)
+          {
+            _valid[i + k] = static_cast<uint8_t>((mask >> k) & 1);
+            n += _valid[i + k];
+          }
+        }
+        return n + PlaneRayHitsScalar(_nx, _ny, _nz, _d, _tolerance,
+            _ox + i, _oy + i, _oz + i, _dx + i, _dy + i, _dz + i, _count - i,
+            _hx + i, _hy + i, _hz + i, _t + i, _valid + i);
+      }
+#endif
+    }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_POLYGON2SIMD_HH_
+#define GZ_MATH_DETAIL_POLYGON2SIMD_HH_
+
+#include <cstddef>
+
+#include <gz/math/config.hh>
+
+// Select the instruction set used by the Polygon2 kernels at compile time.
+// Define IGNITION_MATH_DISABLE_SIMD to always use the portable scalar code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define IGNITION_MATH_POLYGON2_SSE2 1
+    #include <emmintrin.h>
+  #endif
+#endif
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Maximum number of points of PolygonCrossings.
+      constexpr std::size_t kPolygonCrossingsBlock = 64;
+
+      /// \brief Get whether a horizontal ray from a point towards -X
+      /// crosses an edge, counting the lower end of the edge but not the
+      /// upper end.
+      /// \param[in] _x0 X coordinate of the start of the edge.
+      /// \param[in] _y0 Y coordinate of the start of the edge.
+      /// \param[in] _y1 Y coordinate of the end of the edge.
+      /// \param[in] _slope Change of X per unit of Y along the edge.
+      /// \param[in] _x X coordinate of the point.
+      /// \param[in] _y Y coordinate of the point.
+      /// \return True if the ray crosses the edge.
+      inline bool PolygonEdgeCrossed(const double _x0, const double _y0,
+                                     const double _y1, const double _slope,
+                                     const double _x, const double _y)
+      {
+        const double crossing = _x0 + (_y - _y0) * _slope;
+        return ((_y0 > _y) != (_y1 > _y)) & (crossing < _x);
+      }
+
+      /// \brief Get whether rays from points towards -X cross the edges of
+      /// a polygon an odd number of times. The points are tested two at a
+      /// time against one edge after the other with SSE2 when it is
+      /// available, with the same result as PolygonEdgeCrossed.
+      /// \param[in] _x0 Array of _edges X coordinates of the edge starts.
+      /// \param[in] _y0 Array of _edges Y coordinates of the edge starts.
+      /// \param[in] _y1 Array of _edges Y coordinates of the edge ends.
+      /// \param[in] _slope Array of _edges changes of X per unit of Y.
+      /// \param[in] _edges Number of edges.
+      /// \param[in] _x Array of _count X coordinates of the points.
+      /// \param[in] _y Array of _count Y coordinates of the points.
+      /// \param[in] _count Number of points, at most
+      /// kPolygonCrossingsBlock.
+      /// \param[out] _odd Array of _count results.
+      inline void PolygonCrossings(const double *_x0, const double *_y0,
+                                   const double *_y1, const double *_slope,
+                                   const std::size_t _edges,
+                                   const double *_x, const double *_y,
+                                   const std::size_t _count, bool *_odd)
+      {
+        std::size_t i = 0;
+#if defined(IGNITION_MATH_POLYGON2_SSE2)
+        __m128d parity[kPolygonCrossingsBlock / 2];
+        const std::size_t pairs = _count / 2;
+        for (std::size_t p = 0; p < pairs; ++p)
+          parity[p] = _mm_setzero_pd();
+        for (std::size_t e = 0; e < _edges; ++e)
+        {
+          const __m128d x0 = _mm_set1_pd(_x0[e]);
+          const __m128d y0 = _mm_set1_pd(_y0[e]);
+          const __m128d y1 = _mm_set1_pd(_y1[e]);
+          const __m128d slope = _mm_set1_pd(_slope[e]);
+          for (std::size_t p = 0; p < pairs; ++p)
+          {
+            const __m128d x = _mm_loadu_pd(_x + 2 * p);
+            const __m128d y = _mm_loadu_pd(_y + 2 * p);
+            const __m128d crossing =
+                _mm_add_pd(x0, _mm_mul_pd(_mm_sub_pd(y, y0), slope));
+            const __m128d spans =
+                _mm_xor_pd(_mm_cmpgt_pd(y0, y), _mm_cmpgt_pd(y1, y));
+            parity[p] = _mm_xor_pd(parity[p],
+                _mm_and_pd(spans, _mm_cmplt_pd(crossing, x)));
+          }
+        }
+        for (std::size_t p = 0; p < pairs; ++p)
+        {
+          const int mask = _mm_movemask_pd(parity[p]);
+          _odd[2 * p] = (mask & 1) != 0;
+          _odd[2 * p + 1] = (mask & 2) != 0;
+        }
+        i = 2 * pairs;
+#endif
+        for (; i < _count; ++i)
+        {
+          bool odd = false;
+          for (std::size_t e = 0; e < _edges; ++e)
+          {
+            odd ^= PolygonEdgeCrossed(_x0[e], _y0[e], _y1[e], _slope[e],
+                                      _x[i], _y[i]);
+          }
+          _odd[i] = odd;
+        }
+      }
+    }
+    }
+  }
+}
+#endif
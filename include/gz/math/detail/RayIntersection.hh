@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_RAYINTERSECTION_HH_
+#define GZ_MATH_DETAIL_RAYINTERSECTION_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include <gz/math/config.hh>
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Find where a line is inside of a quadric, which is where
+      /// _a * t^2 + 2 * _b * t + _c <= 0. The roots are computed without
+      /// cancellation.
+      /// \param[in] _a Quadratic coefficient, >= 0.
+      /// \param[in] _b Half of the linear coefficient.
+      /// \param[in] _c Constant coefficient.
+      /// \param[out] _tin Start of the interval.
+      /// \param[out] _tout End of the interval.
+      /// \return False if the line is never inside.
+      template<typename T>
+      bool QuadricRayInterval(const T _a, const T _b, const T _c,
+                              T &_tin, T &_tout)
+      {
+        if (_a <= 0)
+        {
+          // Parallel to the axis of a cylinder.
+          _tin = -std::numeric_limits<T>::infinity();
+          _tout = std::numeric_limits<T>::infinity();
+          return _c <= 0;
+        }
+
+        const T disc = _b * _b - _a * _c;
+        if (disc < 0)
+          return false;
+
+        // Both roots are zero when q is, and dividing by a denormal q
+        // would overflow.
+        const T q = -(_b + std::copysign(std::sqrt(disc), _b));
+        if (std::abs(q) < std::numeric_limits<T>::min())
+        {
+          _tin = 0;
+          _tout = 0;
+          return true;
+        }
+        _tin = q / _a;
+        _tout = _c / q;
+        if (_tin > _tout)
+          std::swap(_tin, _tout);
+        return true;
+      }
+
+      /// \brief Find where a line is between two parallel planes, which is
+      /// where |_origin + t * _dir| <= _half.
+      /// \param[in] _origin Coordinate of the line's origin across the
+      /// planes.
+      /// \param[in] _dir Coordinate of the line's direction across the
+      /// planes.
+      /// \param[in] _half Half of the distance between the planes.
+      /// \param[out] _tin Start of the interval.
+      /// \param[out] _tout End of the interval.
+      /// \return False if the line is never between the planes.
+      template<typename T>
+      bool SlabRayInterval(const T _origin, const T _dir, const T _half,
+                           T &_tin, T &_tout)
+      {
+        if (std::abs(_dir) < std::numeric_limits<T>::min())
+        {
+          _tin = -std::numeric_limits<T>::infinity();
+          _tout = std::numeric_limits<T>::infinity();
+          return std::abs(_origin) <= _half;
+        }
+        const T inv = 1 / _dir;
+        _tin = (-_half - _origin) * inv;
+        _tout = (_half - _origin) * inv;
+        if (_tin > _tout)
+          std::swap(_tin, _tout);
+        return true;
+      }
+
+      /// \brief Find the first point of the surface of a convex shape hit
+      /// by a ray, given the interval of the ray inside of the shape. Rays
+      /// starting inside of the shape hit it where they leave it.
+      /// \param[in] _tin Start of the interval inside of the shape.
+      /// \param[in] _tout End of the interval inside of the shape.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \param[out] _t Distance of the hit.
+      /// \return True if the surface is hit between _min and _max.
+      template<typename T>
+      bool FirstSurfaceHit(const T _tin, const T _tout, const T _min,
+                           const T _max, T &_t)
+      {
+        _t = _tin >= _min ? _tin : _tout;
+        return _t >= _min && _t <= _max;
+      }
+
+      /// \brief Intersect a ray with a shape placed by a pose, as the
+      /// IntersectDist functions of the shapes do.
+      /// \param[in] _pose Pose of the shape, in the frame of the ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \param[in] _interval Callable with signature
+      /// bool(const Vector3<T> &, const Vector3<T> &, T &, T &) finding
+      /// the interval of a ray inside of the shape, in its frame.
+      /// \return Whether the ray hits the shape and the distance of the hit
+      /// minus _min.
+      template<typename T, typename Interval>
+      std::tuple<bool, T> ShapeIntersectDist(const Pose3<T> &_pose,
+                                             const Vector3<T> &_origin,
+                                             const Vector3<T> &_dir,
+                                             const T _min, const T _max,
+                                             const Interval &_interval)
+      {
+        const Vector3<T> origin =
+            _pose.Rot().RotateVectorReverse(_origin - _pose.Pos());
+        const Vector3<T> dir =
+            _pose.Rot().RotateVectorReverse(_dir.Normalized());
+        T tin, tout, t;
+        if (_interval(origin, dir, tin, tout) &&
+            FirstSurfaceHit(tin, tout, _min, _max, t))
+        {
+          return std::make_tuple(true, t - _min);
+        }
+        return std::make_tuple(false, T(0));
+      }
+
+      /// \brief Intersect a bundle of rays from the same origin with a
+      /// shape placed by a pose, as the IntersectRays functions of the
+      /// shapes do.
+      /// \param[in] _pose Pose of the shape, in the frame of the rays.
+      /// \param[in] _origin Origin of the rays.
+      /// \param[in] _dirs Array of _count unit ray directions.
+      /// \param[in] _count Number of rays.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in, out] _ranges Array of _count maximum distances, lowered
+      /// to the distance of the hits.
+      /// \param[in] _interval Callable finding the interval of a ray inside
+      /// of the shape, in its frame, as in ShapeIntersectDist.
+      /// \return Number of lowered ranges.
+      template<typename T, typename Interval>
+      std::size_t ShapeIntersectRays(const Pose3<T> &_pose,
+                                     const Vector3<T> &_origin,
+                                     const Vector3<T> *_dirs,
+                                     const std::size_t _count,
+                                     const T _min, T *_ranges,
+                                     const Interval &_interval)
+      {
+        const Matrix3<T> toShape = Matrix3<T>(_pose.Rot()).Transposed();
+        const Vector3<T> origin = toShape * (_origin - _pose.Pos());
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          T tin, tout, t;
+          if (_interval(origin, toShape * _dirs[i], tin, tout) &&
+              FirstSurfaceHit(tin, tout, _min, _ranges[i], t) &&
+              t < _ranges[i])
+          {
+            _ranges[i] = t;
+            ++hits;
+          }
+        }
+        return hits;
+      }
+    }
+    }
+  }
+}
+#endif
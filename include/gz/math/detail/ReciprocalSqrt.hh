@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_RECIPROCALSQRT_HH_
+#define GZ_MATH_DETAIL_RECIPROCALSQRT_HH_
+
+#include <cmath>
+
+#include <gz/math/config.hh>
+
+// Select the reciprocal square root estimate instruction at compile time.
+// Define IGNITION_MATH_DISABLE_SIMD to always use the portable scalar code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD)
+  #if defined(__SSE__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define IGNITION_MATH_RSQRT_SSE 1
+    #include <xmmintrin.h>
+  #elif defined(__aarch64__)
+    #define IGNITION_MATH_RSQRT_NEON 1
+    #include <arm_neon.h>
+  #endif
+#endif
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Estimate 1 / sqrt(_x) with the hardware instruction when
+      /// there is one. The relative error is below 1.5 * 2^-12 with SSE and
+      /// below 2^-8 with NEON.
+      /// \param[in] _x Positive, normal single precision value.
+      /// \return The estimate.
+      inline float ReciprocalSqrtEstimate(const float _x)
+      {
+#if defined(IGNITION_MATH_RSQRT_SSE)
+        return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(_x)));
+#elif defined(IGNITION_MATH_RSQRT_NEON)
+        return vrsqrtes_f32(_x);
+#else
+        return 1.0f / std::sqrt(_x);
+#endif
+      }
+
+      /// \brief Approximate 1 / sqrt(_x) with a hardware estimate refined by
+      /// one Newton-Raphson step. The relative error is below 3e-7 with
+      /// SSE, plus the rounding error of T, and below 2.5e-5 with NEON.
+      /// \param[in] _x Value within the range of normal single precision
+      /// values.
+      /// \return The approximation.
+      template<typename T>
+      inline T ReciprocalSqrt(const T _x)
+      {
+        const T y = static_cast<T>(
+            ReciprocalSqrtEstimate(static_cast<float>(_x)));
+        return y * (static_cast<T>(1.5) - static_cast<T>(0.5) * _x * y * y);
+      }
+    }
+    }
+  }
+}
+#endif
@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_REGIONGRIDINDEX_HH_
+#define GZ_MATH_DETAIL_REGIONGRIDINDEX_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <gz/math/Region3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief A uniform grid over the bounded extent of a list of
+      /// regions, where each cell lists the regions which overlap it, in
+      /// their original order. Unbounded regions extend to the first or
+      /// last cells along their unbounded axes.
+      template<typename ScalarT>
+      class RegionGridIndex
+      {
+        /// \brief Build the index.
+        /// \param[in] _count Number of regions.
+        /// \param[in] _regionOf Function taking the index of a region and
+        ///   returning a reference to it.
+        public: template<typename RegionOf>
+                void Build(const std::size_t _count,
+                           const RegionOf &_regionOf)
+        {
+          ScalarT lower[3];
+          ScalarT upper[3];
+          std::fill(lower, lower + 3, std::numeric_limits<ScalarT>::max());
+          std::fill(upper, upper + 3,
+                    std::numeric_limits<ScalarT>::lowest());
+          for (std::size_t i = 0; i < _count; ++i)
+          {
+            const Region3<ScalarT> &region = _regionOf(i);
+            if (region.Empty())
+              continue;
+            const Interval<ScalarT> *intervals[3] =
+                {&region.Ix(), &region.Iy(), &region.Iz()};
+            for (int a = 0; a < 3; ++a)
+            {
+              for (const ScalarT value : {intervals[a]->LeftValue(),
+                                          intervals[a]->RightValue()})
+              {
+                if (std::isfinite(value))
+                {
+                  lower[a] = std::min(lower[a], value);
+                  upper[a] = std::max(upper[a], value);
+                }
+              }
+            }
+          }
+
+          // Cell size for about one cell per region over the axes with an
+          // extent, which are also the only axes split into several cells
+          double volume = 1;
+          int dimensions = 0;
+          for (int a = 0; a < 3; ++a)
+          {
+            if (upper[a] > lower[a])
+            {
+              volume *= static_cast<double>(upper[a] - lower[a]);
+              ++dimensions;
+            }
+          }
+          const double cellSize = dimensions == 0 ? 0 : std::pow(
+              volume / static_cast<double>(_count), 1.0 / dimensions);
+
+          for (int a = 0; a < 3; ++a)
+          {
+            this->gridCells[a] = 1;
+            this->gridMin[a] = 0;
+            this->gridInvCellSize[a] = 0;
+            if (upper[a] > lower[a])
+            {
+              const double extent = static_cast<double>(upper[a] - lower[a]);
+              this->gridCells[a] = static_cast<std::size_t>(std::min(
+                  std::ceil(extent / cellSize),
+                  static_cast<double>(_count)));
+              this->gridCells[a] = std::max<std::size_t>(
+                  this->gridCells[a], 1);
+              this->gridMin[a] = lower[a];
+              this->gridInvCellSize[a] = static_cast<ScalarT>(
+                  static_cast<double>(this->gridCells[a]) / extent);
+            }
+          }
+
+          // Count the regions of each cell, then list them in order
+          const std::size_t cells =
+              this->gridCells[0] * this->gridCells[1] * this->gridCells[2];
+          this->cellStart.assign(cells + 1, 0);
+          for (std::size_t i = 0; i < _count; ++i)
+          {
+            if (!_regionOf(i).Empty())
+            {
+              this->ForEachCell(_regionOf(i),
+                  [this](std::size_t _cell) { ++this->cellStart[_cell + 1]; });
+            }
+          }
+          for (std::size_t c = 0; c < cells; ++c)
+            this->cellStart[c + 1] += this->cellStart[c];
+
+          std::vector<std::size_t> next(this->cellStart.begin(),
+                                        this->cellStart.end() - 1);
+          this->cellItems.resize(this->cellStart.back());
+          for (std::size_t i = 0; i < _count; ++i)
+          {
+            if (!_regionOf(i).Empty())
+            {
+              this->ForEachCell(_regionOf(i),
+                  [this, &next, i](std::size_t _cell)
+                  {
+                    this->cellItems[next[_cell]++] = i;
+                  });
+            }
+          }
+        }
+
+        /// \brief Check whether the index was built.
+        /// \return True if Build() was called.
+        public: bool Built() const
+        {
+          return !this->cellStart.empty();
+        }
+
+        /// \brief Get the cell which contains a point. Points outside of
+        /// the grid are in its first or last cells.
+        /// \param[in] _p The point, which has no NaN coordinate.
+        /// \return Index of the cell.
+        public: std::size_t Cell(const Vector3<ScalarT> &_p) const
+        {
+          return this->Cell(this->CellIndex(0, _p.X()),
+                            this->CellIndex(1, _p.Y()),
+                            this->CellIndex(2, _p.Z()));
+        }
+
+        /// \brief Get the first region listed in a cell.
+        /// \param[in] _cell Index of the cell.
+        /// \return Pointer to the index of the first region.
+        public: const std::size_t *CellBegin(const std::size_t _cell) const
+        {
+          return this->cellItems.data() + this->cellStart[_cell];
+        }
+
+        /// \brief Get the end of the regions listed in a cell.
+        /// \param[in] _cell Index of the cell.
+        /// \return Pointer past the index of the last region.
+        public: const std::size_t *CellEnd(const std::size_t _cell) const
+        {
+          return this->cellItems.data() + this->cellStart[_cell + 1];
+        }
+
+        /// \brief Call a function with the index of every grid cell which
+        /// overlaps a non-empty region.
+        /// \param[in] _region Region, which must not be empty
+        /// \param[in] _function Function taking a cell index
+        public: template<typename Function>
+                void ForEachCell(const Region3<ScalarT> &_region,
+                                 const Function &_function) const
+        {
+          const Interval<ScalarT> *intervals[3] =
+              {&_region.Ix(), &_region.Iy(), &_region.Iz()};
+          std::size_t lo[3];
+          std::size_t hi[3];
+          for (int a = 0; a < 3; ++a)
+          {
+            lo[a] = this->CellIndex(a, intervals[a]->LeftValue());
+            hi[a] = this->CellIndex(a, intervals[a]->RightValue());
+          }
+          for (std::size_t z = lo[2]; z <= hi[2]; ++z)
+          {
+            for (std::size_t y = lo[1]; y <= hi[1]; ++y)
+            {
+              for (std::size_t x = lo[0]; x <= hi[0]; ++x)
+                _function(this->Cell(x, y, z));
+            }
+          }
+        }
+
+        /// \brief Get the index of the grid cell along an axis which
+        /// contains a value. Values outside of the grid are clamped to its
+        /// first or last cell, since only unbounded regions extend there.
+        /// The index is non-decreasing with the value, so the cells between
+        /// those of the bounds of an interval contain all of its values.
+        /// \param[in] _axis Axis index, 0 for x, 1 for y and 2 for z
+        /// \param[in] _value Coordinate along the axis, which is not NaN
+        /// \return Cell index along the axis
+        private: std::size_t CellIndex(const int _axis,
+                                       const ScalarT _value) const
+        {
+          const ScalarT t =
+              (_value - this->gridMin[_axis]) * this->gridInvCellSize[_axis];
+          if (!(t > 0))
+            return 0;
+          if (t >= static_cast<ScalarT>(this->gridCells[_axis]))
+            return this->gridCells[_axis] - 1;
+          return static_cast<std::size_t>(t);
+        }
+
+        /// \brief Get the index of a grid cell in the cell lists.
+        /// \param[in] _x Cell index along the x axis
+        /// \param[in] _y Cell index along the y axis
+        /// \param[in] _z Cell index along the z axis
+        /// \return Index of the cell
+        private: std::size_t Cell(const std::size_t _x, const std::size_t _y,
+                                  const std::size_t _z) const
+        {
+          return (_z * this->gridCells[1] + _y) * this->gridCells[0] + _x;
+        }
+
+        /// \brief Lower bounds of the grid along each axis
+        private: ScalarT gridMin[3] = {0, 0, 0};
+
+        /// \brief Number of cells per unit length along each axis
+        private: ScalarT gridInvCellSize[3] = {0, 0, 0};
+
+        /// \brief Number of cells along each axis
+        private: std::size_t gridCells[3] = {1, 1, 1};
+
+        /// \brief Start of the regions of each cell in cellItems, followed
+        /// by the total number of entries. Empty if the index wasn't built.
+        private: std::vector<std::size_t> cellStart;
+
+        /// \brief Indices of the regions which overlap each cell, in
+        /// increasing order for each cell
+        private: std::vector<std::size_t> cellItems;
+      };
+    }
+    }
+  }
+}
+#endif
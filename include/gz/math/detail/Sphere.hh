@@ -18,6 +18,7 @@
 #define GZ_MATH_DETAIL_SPHERE_HH_
 
 #include "gz/math/Sphere.hh"
+#include "gz/math/detail/RayIntersection.hh"
 
 namespace ignition
 {
@@ -149,6 +150,44 @@ std::optional<Vector3<T>>
   return - z * _plane.Normal().Normalized();
 }
 
+//////////////////////////////////////////////////
+template<typename T>
+void Sphere<T>::VolumesBelow(const T *_radii, const Vector3<T> *_positions,
+    const std::size_t _count, const Plane<T> &_plane, T *_volumes,
+    Vector3<T> *_centers)
+{
+  const T length = _plane.Normal().Length();
+  const Vector3<T> normal = _plane.Normal() / length;
+  const T offset = _plane.Offset() / length;
+
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const T r = _radii[i];
+    const T dist = normal.Dot(_positions[i]) - offset;
+
+    _centers[i] = _positions[i];
+    if (dist >= r)
+    {
+      // sphere is completely above plane
+      _volumes[i] = 0;
+    }
+    else if (dist <= -r)
+    {
+      // sphere is completely below plane
+      _volumes[i] = (4.0/3.0) * IGN_PI * (r * r * r);
+    }
+    else
+    {
+      // Volume and centroid of the spherical cap below the plane, see
+      // VolumeBelow and CenterOfVolumeBelow
+      const T h = r - dist;
+      const T numerator = 2 * r - h;
+      _volumes[i] = IGN_PI * h * h * (3 * r - h) / 3;
+      _centers[i] -= 3 * numerator * numerator / (4 * (3 * r - h)) * normal;
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 template<typename T>
 bool Sphere<T>::SetDensityFromMass(const T _mass)
@@ -168,6 +207,92 @@ T Sphere<T>::DensityFromMass(const T _mass) const
 
   return _mass / this->Volume();
 }
+
+//////////////////////////////////////////////////
+template<typename T>
+void Sphere<T>::Volumes(const T *_radii, const std::size_t _count,
+    T *_volumes)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+    _volumes[i] = (4.0/3.0) * IGN_PI * (_radii[i] * _radii[i] * _radii[i]);
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+void Sphere<T>::DensitiesFromMasses(const T *_radii, const T *_masses,
+    const std::size_t _count, T *_densities)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const T volume =
+        (4.0/3.0) * IGN_PI * (_radii[i] * _radii[i] * _radii[i]);
+    _densities[i] = (_radii[i] <= 0 || _masses[i] <= 0) ?
+        T(-1.0) : _masses[i] / volume;
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+bool Sphere<T>::MassMatrices(const T *_radii, const T *_densities,
+    const std::size_t _count, MassMatrix3<T> *_massMats)
+{
+  bool all = true;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const T radius2 = _radii[i] * _radii[i];
+    if (_densities[i] <= 0 || _radii[i] <= 0)
+    {
+      _massMats[i] = MassMatrix3<T>();
+      all = false;
+      continue;
+    }
+
+    // Principal moments of a sphere, see MassMatrix3::SetFromSphere
+    const T mass = _densities[i] *
+        ((4.0/3.0) * IGN_PI * (radius2 * _radii[i]));
+    const T i0 = 0.4 * mass * radius2;
+    _massMats[i] = MassMatrix3<T>(mass, Vector3<T>(i0, i0, i0),
+        Vector3<T>::Zero);
+  }
+  return all;
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::tuple<bool, T> Sphere<T>::IntersectDist(const Pose3<T> &_pose,
+    const Vector3<T> &_origin, const Vector3<T> &_dir,
+    const T _min, const T _max) const
+{
+  return detail::ShapeIntersectDist(_pose, _origin, _dir, _min, _max,
+      [this](const Vector3<T> &_o, const Vector3<T> &_d, T &_tin, T &_tout)
+      {
+        return this->RayInterval(_o, _d, _tin, _tout);
+      });
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::size_t Sphere<T>::IntersectRays(const Pose3<T> &_pose,
+    const Vector3<T> &_origin, const Vector3<T> *_dirs,
+    const std::size_t _count, const T _min, T *_ranges) const
+{
+  return detail::ShapeIntersectRays(_pose, _origin, _dirs, _count, _min,
+      _ranges,
+      [this](const Vector3<T> &_o, const Vector3<T> &_d, T &_tin, T &_tout)
+      {
+        return this->RayInterval(_o, _d, _tin, _tout);
+      });
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+bool Sphere<T>::RayInterval(const Vector3<T> &_origin,
+    const Vector3<T> &_dir, T &_tin, T &_tout) const
+{
+  return detail::QuadricRayInterval(_dir.SquaredLength(), _origin.Dot(_dir),
+      _origin.SquaredLength() - this->radius * this->radius, _tin, _tout);
+}
+
 }
 }
 #endif
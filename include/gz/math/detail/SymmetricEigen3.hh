@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_SYMMETRICEIGEN3_HH_
+#define GZ_MATH_DETAIL_SYMMETRICEIGEN3_HH_
+
+#include <algorithm>
+#include <cmath>
+
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Unit eigenvector of a symmetric 3x3 matrix for an eigenvalue
+      /// of multiplicity one. The rows of A - lambda I span a plane, and the
+      /// largest cross product of two rows is normal to it.
+      /// \param[in] _a Upper triangle, a00 a01 a02 a11 a12 a22.
+      /// \param[in] _lambda Eigenvalue.
+      /// \param[out] _v Eigenvector.
+      template<typename T>
+      inline void SymmetricEigenvector0(const T _a[6], const T _lambda,
+                                        T _v[3])
+      {
+        const T r0[3] = {_a[0] - _lambda, _a[1], _a[2]};
+        const T r1[3] = {_a[1], _a[3] - _lambda, _a[4]};
+        const T r2[3] = {_a[2], _a[4], _a[5] - _lambda};
+        const T c01[3] = {r0[1] * r1[2] - r0[2] * r1[1],
+                          r0[2] * r1[0] - r0[0] * r1[2],
+                          r0[0] * r1[1] - r0[1] * r1[0]};
+        const T c02[3] = {r0[1] * r2[2] - r0[2] * r2[1],
+                          r0[2] * r2[0] - r0[0] * r2[2],
+                          r0[0] * r2[1] - r0[1] * r2[0]};
+        const T c12[3] = {r1[1] * r2[2] - r1[2] * r2[1],
+                          r1[2] * r2[0] - r1[0] * r2[2],
+                          r1[0] * r2[1] - r1[1] * r2[0]};
+        const T d01 = c01[0] * c01[0] + c01[1] * c01[1] + c01[2] * c01[2];
+        const T d02 = c02[0] * c02[0] + c02[1] * c02[1] + c02[2] * c02[2];
+        const T d12 = c12[0] * c12[0] + c12[1] * c12[1] + c12[2] * c12[2];
+
+        const T *c = c01;
+        T d = d01;
+        if (d02 > d)
+        {
+          c = c02;
+          d = d02;
+        }
+        if (d12 > d)
+        {
+          c = c12;
+          d = d12;
+        }
+        const T inv = T(1) / std::sqrt(d);
+        _v[0] = c[0] * inv;
+        _v[1] = c[1] * inv;
+        _v[2] = c[2] * inv;
+      }
+
+      /// \brief Unit eigenvector of a symmetric 3x3 matrix, orthogonal to a
+      /// known eigenvector. The matrix is restricted to the plane normal to
+      /// _w, where the null vector of the 2x2 system is well defined even
+      /// for repeated eigenvalues.
+      /// \param[in] _a Upper triangle, a00 a01 a02 a11 a12 a22.
+      /// \param[in] _w Known unit eigenvector.
+      /// \param[in] _lambda Eigenvalue.
+      /// \param[out] _v Eigenvector.
+      template<typename T>
+      inline void SymmetricEigenvector1(const T _a[6], const T _w[3],
+                                        const T _lambda, T _v[3])
+      {
+        // Orthonormal basis u, v of the plane normal to w
+        T u[3];
+        if (std::abs(_w[0]) > std::abs(_w[1]))
+        {
+          const T inv = T(1) / std::sqrt(_w[0] * _w[0] + _w[2] * _w[2]);
+          u[0] = -_w[2] * inv;
+          u[1] = 0;
+          u[2] = _w[0] * inv;
+        }
+        else
+        {
+          const T inv = T(1) / std::sqrt(_w[1] * _w[1] + _w[2] * _w[2]);
+          u[0] = 0;
+          u[1] = _w[2] * inv;
+          u[2] = -_w[1] * inv;
+        }
+        const T v[3] = {_w[1] * u[2] - _w[2] * u[1],
+                        _w[2] * u[0] - _w[0] * u[2],
+                        _w[0] * u[1] - _w[1] * u[0]};
+
+        const T au[3] = {_a[0] * u[0] + _a[1] * u[1] + _a[2] * u[2],
+                         _a[1] * u[0] + _a[3] * u[1] + _a[4] * u[2],
+                         _a[2] * u[0] + _a[4] * u[1] + _a[5] * u[2]};
+        const T av[3] = {_a[0] * v[0] + _a[1] * v[1] + _a[2] * v[2],
+                         _a[1] * v[0] + _a[3] * v[1] + _a[4] * v[2],
+                         _a[2] * v[0] + _a[4] * v[1] + _a[5] * v[2]};
+        T m00 = u[0] * au[0] + u[1] * au[1] + u[2] * au[2] - _lambda;
+        T m01 = u[0] * av[0] + u[1] * av[1] + u[2] * av[2];
+        T m11 = v[0] * av[0] + v[1] * av[1] + v[2] * av[2] - _lambda;
+
+        // Null vector (s, t) of [m00 m01; m01 m11], using the larger row.
+        // When the row is zero, every vector of the plane is a solution.
+        T s = 1;
+        T t = 0;
+        const T abs00 = std::abs(m00);
+        const T abs01 = std::abs(m01);
+        const T abs11 = std::abs(m11);
+        if (abs00 >= abs11)
+        {
+          if (std::max(abs00, abs01) > 0)
+          {
+            if (abs00 >= abs01)
+            {
+              m01 /= m00;
+              m00 = T(1) / std::sqrt(T(1) + m01 * m01);
+              m01 *= m00;
+            }
+            else
+            {
+              m00 /= m01;
+              m01 = T(1) / std::sqrt(T(1) + m00 * m00);
+              m00 *= m01;
+            }
+            s = m01;
+            t = -m00;
+          }
+        }
+        else if (std::max(abs11, abs01) > 0)
+        {
+          if (abs11 >= abs01)
+          {
+            m01 /= m11;
+            m11 = T(1) / std::sqrt(T(1) + m01 * m01);
+            m01 *= m11;
+          }
+          else
+          {
+            m11 /= m01;
+            m01 = T(1) / std::sqrt(T(1) + m11 * m11);
+            m11 *= m01;
+          }
+          s = m11;
+          t = -m01;
+        }
+        _v[0] = s * u[0] + t * v[0];
+        _v[1] = s * u[1] + t * v[1];
+        _v[2] = s * u[2] + t * v[2];
+      }
+
+      /// \brief Eigenvalues and eigenvectors of a symmetric 3x3 matrix,
+      /// with the closed form solution of the characteristic cubic and
+      /// the eigenvector construction of D. Eberly, "A Robust Eigensolver
+      /// for 3x3 Symmetric Matrices". The matrix is scaled by its largest
+      /// element first to avoid overflow, and repeated eigenvalues give
+      /// orthonormal eigenvectors.
+      /// \param[in] _a Upper triangle, a00 a01 a02 a11 a12 a22.
+      /// \param[out] _values Eigenvalues, from smallest to largest.
+      /// \param[out] _vectors Eigenvectors as the columns of a row-major
+      /// rotation matrix, in the order of _values, so that
+      /// A = V diag(values) V^T.
+      template<typename T>
+      inline void SymmetricEigen3(const T _a[6], T _values[3], T _vectors[9])
+      {
+        T scale = std::abs(_a[0]);
+        for (int i = 1; i < 6; ++i)
+          scale = std::max(scale, std::abs(_a[i]));
+
+        T e[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+        T b[6] = {0, 0, 0, 0, 0, 0};
+        T q = 0;
+        T p = 0;
+        if (scale > 0)
+        {
+          for (int i = 0; i < 6; ++i)
+            b[i] = _a[i] / scale;
+          q = (b[0] + b[3] + b[5]) / 3;
+          const T b00 = b[0] - q;
+          const T b11 = b[3] - q;
+          const T b22 = b[5] - q;
+          p = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 +
+              2 * (b[1] * b[1] + b[2] * b[2] + b[4] * b[4])) / 6);
+        }
+
+        if (p <= 0)
+        {
+          // A multiple of the identity
+          for (int i = 0; i < 3; ++i)
+            _values[i] = q * scale;
+        }
+        else
+        {
+          // det((A - qI) / p) / 2 is the cosine of three times the angle
+          // of the largest root.
+          const T b00 = b[0] - q;
+          const T b11 = b[3] - q;
+          const T b22 = b[5] - q;
+          const T c00 = b11 * b22 - b[4] * b[4];
+          const T c01 = b[1] * b22 - b[4] * b[2];
+          const T c02 = b[1] * b[4] - b11 * b[2];
+          const T halfDet = std::min(T(1), std::max(T(-1),
+              (b00 * c00 - b[1] * c01 + b[2] * c02) / (2 * p * p * p)));
+          const T angle = std::acos(halfDet) / 3;
+          const T twoThirdsPi = static_cast<T>(2.09439510239319549);
+          const T beta2 = 2 * std::cos(angle);
+          const T beta0 = 2 * std::cos(angle + twoThirdsPi);
+          const T beta1 = -(beta0 + beta2);
+          T lambda[3] = {q + p * beta0, q + p * beta1, q + p * beta2};
+
+          // Start from the eigenvalue furthest from the other two, which
+          // always has multiplicity one.
+          T v0[3], v1[3], v2[3];
+          if (halfDet >= 0)
+          {
+            SymmetricEigenvector0(b, lambda[2], v2);
+            SymmetricEigenvector1(b, v2, lambda[1], v1);
+            v0[0] = v1[1] * v2[2] - v1[2] * v2[1];
+            v0[1] = v1[2] * v2[0] - v1[0] * v2[2];
+            v0[2] = v1[0] * v2[1] - v1[1] * v2[0];
+          }
+          else
+          {
+            SymmetricEigenvector0(b, lambda[0], v0);
+            SymmetricEigenvector1(b, v0, lambda[1], v1);
+            v2[0] = v0[1] * v1[2] - v0[2] * v1[1];
+            v2[1] = v0[2] * v1[0] - v0[0] * v1[2];
+            v2[2] = v0[0] * v1[1] - v0[1] * v1[0];
+          }
+          for (int i = 0; i < 3; ++i)
+          {
+            _values[i] = lambda[i] * scale;
+            e[i][0] = v0[i];
+            e[i][1] = v1[i];
+            e[i][2] = v2[i];
+          }
+        }
+
+        for (int i = 0; i < 3; ++i)
+        {
+          for (int j = 0; j < 3; ++j)
+            _vectors[i * 3 + j] = e[i][j];
+        }
+      }
+    }
+    }
+  }
+}
+#endif
@@ -0,0 +1,433 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRAPH_CSRGRAPH_HH_
+#define GZ_MATH_GRAPH_CSRGRAPH_HH_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/graph/Edge.hh"
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/Vertex.hh"
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+namespace graph
+{
+  /// \typedef CSRIndex.
+  /// \brief Dense index of a vertex or an arc inside a CSRGraph.
+  using CSRIndex = uint32_t;
+
+  /// \brief Represents an invalid CSRIndex.
+  static const CSRIndex kNullIndex = std::numeric_limits<CSRIndex>::max();
+
+  /// \brief An immutable graph stored in compressed sparse row (CSR) form.
+  ///
+  /// Vertices are renumbered with dense indices in [0, VertexCount()),
+  /// following the ascending order of their VertexId. The outgoing arcs of
+  /// vertex i are stored contiguously in the range
+  /// [Offsets()[i], Offsets()[i + 1]) of the Targets(), Weights() and
+  /// EdgeIds() arrays, sorted by target index. An undirected edge is stored
+  /// as two arcs, one in each direction.
+  ///
+  /// Only the topology and the edge weights are kept; vertex and edge user
+  /// data remain in the source graph and can be retrieved through the
+  /// VertexId and EdgeId of each element. A CSRGraph does not track changes
+  /// made to the graph it was built from.
+  ///
+  /// The overloads of BreadthFirstSort, DepthFirstSort, Dijkstra and
+  /// ConnectedComponents in GraphAlgorithms.hh that take a CSRGraph run over
+  /// these contiguous arrays instead of the std::map containers of Graph.
+  ///
+  /// A CSRGraph can also be built straight from an edge list over vertices
+  /// numbered 0..n-1. Vertex Ids then equal the dense indices and EdgeIds
+  /// are positions in the edge list, so no Graph or std::map is ever
+  /// created, and the vectors returned by the algorithms are indexed by
+  /// vertex Id.
+  ///
+  /// <b>Example</b>
+  /// \code{.cpp}
+  /// gz::math::graph::DirectedGraph<int, double> graph(...);
+  /// gz::math::graph::CSRGraph csr(graph);
+  /// auto res = gz::math::graph::Dijkstra(csr, 0);
+  ///
+  /// gz::math::graph::CSRGraph dense(3, {{0, 1}, {1, 2}}, {2.0, 0.5});
+  /// auto levels = gz::math::graph::BreadthFirstLevels(dense, 0);
+  /// \endcode
+  class CSRGraph
+  {
+    /// \brief Default constructor. Creates an empty graph.
+    public: CSRGraph() = default;
+
+    /// \brief Constructor. Freezes the current topology of a graph.
+    /// \param[in] _graph The graph to convert.
+    public: template<typename V, typename E, typename EdgeType>
+    explicit CSRGraph(const Graph<V, E, EdgeType> &_graph)
+    {
+      this->directed = !std::is_same<EdgeType, UndirectedEdge<E>>::value;
+
+      auto allVertices = _graph.Vertices();
+      auto allEdges = _graph.Edges();
+
+      if (allVertices.size() >= kNullIndex ||
+          2 * allEdges.size() >= kNullIndex)
+      {
+        IGN_MATH_DIAGNOSTIC("[CSRGraph] The graph is too large to be indexed. "
+            << "Ignoring graph.");
+        return;
+      }
+
+      // Vertex ids are sorted, since they are the keys of a std::map.
+      this->ids.reserve(allVertices.size());
+      for (auto const &v : allVertices)
+        this->ids.push_back(v.first);
+
+      this->identity = this->ids.empty() ||
+        this->ids.back() == this->ids.size() - 1;
+
+      // Count the outgoing arcs of each vertex.
+      this->offsets.assign(this->ids.size() + 1, 0);
+      for (auto const &e : allEdges)
+      {
+        this->ForEachArc(e.second.get(), [this](CSRIndex _u, CSRIndex)
+        {
+          ++this->offsets[_u + 1];
+        });
+      }
+      std::partial_sum(this->offsets.begin(), this->offsets.end(),
+                       this->offsets.begin());
+
+      // Fill the arcs. Edges are visited by ascending EdgeId, so each row
+      // is sorted by EdgeId at this point.
+      const CSRIndex arcCount = this->offsets.back();
+      this->targets.resize(arcCount);
+      this->weights.resize(arcCount);
+      this->edgeIds.resize(arcCount);
+      std::vector<CSRIndex> next(this->offsets.begin(),
+                                 this->offsets.end() - 1);
+      for (auto const &e : allEdges)
+      {
+        const auto &edge = e.second.get();
+        this->ForEachArc(edge, [&](CSRIndex _u, CSRIndex _v)
+        {
+          const CSRIndex arc = next[_u]++;
+          this->targets[arc] = _v;
+          this->weights[arc] = edge.Weight();
+          this->edgeIds[arc] = edge.Id();
+        });
+      }
+
+      this->SortRows();
+    }
+
+    /// \brief Constructor. Builds a graph directly from an edge list, without
+    /// going through a Graph. This is meant for large graphs whose vertices
+    /// are numbered densely, for example when loaded from a file. The
+    /// vertex Ids are 0.._vertexCount-1 and equal the dense indices, so
+    /// Index() and Id() are O(1) and the vectors returned by the CSRGraph
+    /// algorithms are indexed by vertex Id.
+    /// \param[in] _vertexCount Number of vertices.
+    /// \param[in] _edges Source and target vertex of each edge. The EdgeId
+    /// of an edge is its position in this vector. Edges with a vertex out
+    /// of range are ignored.
+    /// \param[in] _weights Weight of each edge, or an empty vector to give
+    /// every edge a weight of 1. Otherwise it must have one element per
+    /// edge.
+    /// \param[in] _directed True to store each edge as a single arc from
+    /// its source to its target, or false to store it in both directions.
+    public: CSRGraph(const CSRIndex _vertexCount,
+                     const std::vector<std::pair<CSRIndex, CSRIndex>> &_edges,
+                     const std::vector<double> &_weights = {},
+                     const bool _directed = false)
+    {
+      if (_vertexCount >= kNullIndex || 2 * _edges.size() >= kNullIndex)
+      {
+        IGN_MATH_DIAGNOSTIC("[CSRGraph] The graph is too large to be indexed. "
+            << "Ignoring graph.");
+        return;
+      }
+
+      if (!_weights.empty() && _weights.size() != _edges.size())
+      {
+        IGN_MATH_DIAGNOSTIC(
+            "[CSRGraph] The number of weights doesn't match the "
+            << "number of edges. Ignoring graph.");
+        return;
+      }
+
+      this->directed = _directed;
+      this->ids.resize(_vertexCount);
+      std::iota(this->ids.begin(), this->ids.end(), 0);
+
+      auto forEachArc = [&](const std::size_t _edge, auto _fn)
+      {
+        const CSRIndex u = _edges[_edge].first;
+        const CSRIndex v = _edges[_edge].second;
+        if (u >= _vertexCount || v >= _vertexCount)
+          return;
+
+        _fn(u, v);
+
+        // A self loop only contributes one arc.
+        if (!_directed && u != v)
+          _fn(v, u);
+      };
+
+      // Count the outgoing arcs of each vertex.
+      this->offsets.assign(_vertexCount + 1, 0);
+      for (std::size_t e = 0; e < _edges.size(); ++e)
+      {
+        forEachArc(e, [this](CSRIndex _u, CSRIndex)
+        {
+          ++this->offsets[_u + 1];
+        });
+      }
+      std::partial_sum(this->offsets.begin(), this->offsets.end(),
+                       this->offsets.begin());
+
+      // Fill the arcs by ascending EdgeId.
+      const CSRIndex arcCount = this->offsets.back();
+      this->targets.resize(arcCount);
+      this->weights.resize(arcCount);
+      this->edgeIds.resize(arcCount);
+      std::vector<CSRIndex> next(this->offsets.begin(),
+                                 this->offsets.end() - 1);
+      for (std::size_t e = 0; e < _edges.size(); ++e)
+      {
+        forEachArc(e, [&](CSRIndex _u, CSRIndex _v)
+        {
+          const CSRIndex arc = next[_u]++;
+          this->targets[arc] = _v;
+          this->weights[arc] = _weights.empty() ? 1.0 : _weights[e];
+          this->edgeIds[arc] = e;
+        });
+      }
+
+      this->SortRows();
+    }
+
+    /// \brief Get the number of vertices.
+    /// \return The number of vertices.
+    public: CSRIndex VertexCount() const
+    {
+      return static_cast<CSRIndex>(this->ids.size());
+    }
+
+    /// \brief Get the number of stored arcs. An undirected edge counts as
+    /// two arcs.
+    /// \return The number of arcs.
+    public: CSRIndex ArcCount() const
+    {
+      return static_cast<CSRIndex>(this->targets.size());
+    }
+
+    /// \brief Get whether the graph has no vertices.
+    /// \return True when there are no vertices in the graph or
+    /// false otherwise.
+    public: bool Empty() const
+    {
+      return this->ids.empty();
+    }
+
+    /// \brief Get whether the graph was built from a directed graph.
+    /// \return True if every edge was stored as a single arc or false if
+    /// the edges were stored in both directions.
+    public: bool Directed() const
+    {
+      return this->directed;
+    }
+
+    /// \brief Get the dense index of a vertex.
+    /// This is O(1) when the vertex Ids are 0..VertexCount()-1 and
+    /// O(log n) otherwise.
+    /// \param[in] _id The vertex Id.
+    /// \return The dense index of the vertex or kNullIndex if the vertex
+    /// does not exist.
+    public: CSRIndex Index(const VertexId &_id) const
+    {
+      if (this->identity)
+      {
+        return _id < this->ids.size() ? static_cast<CSRIndex>(_id)
+                                      : kNullIndex;
+      }
+
+      auto it = std::lower_bound(this->ids.begin(), this->ids.end(), _id);
+      if (it == this->ids.end() || *it != _id)
+        return kNullIndex;
+
+      return static_cast<CSRIndex>(it - this->ids.begin());
+    }
+
+    /// \brief Get the Id of a vertex from its dense index.
+    /// \param[in] _index The dense index, in [0, VertexCount()).
+    /// \return The vertex Id or kNullId if the index is out of range.
+    public: VertexId Id(const CSRIndex _index) const
+    {
+      if (_index >= this->ids.size())
+        return kNullId;
+
+      return this->ids[_index];
+    }
+
+    /// \brief Get the number of arcs leaving a vertex.
+    /// \param[in] _index The dense index of the vertex.
+    /// \return The out degree, or 0 if the index is out of range.
+    public: CSRIndex OutDegree(const CSRIndex _index) const
+    {
+      if (_index >= this->ids.size())
+        return 0;
+
+      return this->offsets[_index + 1] - this->offsets[_index];
+    }
+
+    /// \brief Get the vertex Ids, sorted in ascending order. Element i is
+    /// the Id of the vertex with dense index i.
+    /// \return The vertex Ids.
+    public: const std::vector<VertexId> &Ids() const
+    {
+      return this->ids;
+    }
+
+    /// \brief Get the row offsets. This array has VertexCount() + 1
+    /// elements.
+    /// \return The row offsets.
+    public: const std::vector<CSRIndex> &Offsets() const
+    {
+      return this->offsets;
+    }
+
+    /// \brief Get the dense index of the target vertex of each arc.
+    /// \return The arc targets.
+    public: const std::vector<CSRIndex> &Targets() const
+    {
+      return this->targets;
+    }
+
+    /// \brief Get the weight of each arc.
+    /// \return The arc weights.
+    public: const std::vector<double> &Weights() const
+    {
+      return this->weights;
+    }
+
+    /// \brief Get the Id of the graph edge that produced each arc.
+    /// \return The arc edge Ids.
+    public: const std::vector<EdgeId> &EdgeIds() const
+    {
+      return this->edgeIds;
+    }
+
+    /// \brief Call a function for every arc that an edge contributes.
+    /// \param[in] _edge The edge.
+    /// \param[in] _fn Function receiving the source and target indices.
+    private: template<typename EdgeType, typename F>
+    void ForEachArc(const EdgeType &_edge, F _fn) const
+    {
+      auto vertices = _edge.Vertices();
+      const CSRIndex u = this->Index(vertices.first);
+      const CSRIndex v = this->Index(vertices.second);
+      if (u == kNullIndex || v == kNullIndex)
+        return;
+
+      if (_edge.From(vertices.first) == vertices.second)
+        _fn(u, v);
+
+      // A self loop only contributes one arc.
+      if (u != v && _edge.From(vertices.second) == vertices.first)
+        _fn(v, u);
+    }
+
+    /// \brief Sort each row by target, keeping EdgeId order among parallel
+    /// arcs. This matches the neighbor order produced by
+    /// Graph::AdjacentsFrom. The rows must be sorted by EdgeId.
+    private: void SortRows()
+    {
+      std::vector<CSRIndex> perm;
+      for (CSRIndex u = 0; u < this->VertexCount(); ++u)
+      {
+        const CSRIndex begin = this->offsets[u];
+        const CSRIndex end = this->offsets[u + 1];
+        if (std::is_sorted(this->targets.begin() + begin,
+                           this->targets.begin() + end))
+        {
+          continue;
+        }
+
+        perm.resize(end - begin);
+        std::iota(perm.begin(), perm.end(), begin);
+        std::stable_sort(perm.begin(), perm.end(),
+          [this](CSRIndex _a, CSRIndex _b)
+          {
+            return this->targets[_a] < this->targets[_b];
+          });
+        this->Permute(perm, this->targets, begin);
+        this->Permute(perm, this->weights, begin);
+        this->Permute(perm, this->edgeIds, begin);
+      }
+    }
+
+    /// \brief Reorder a segment of an array.
+    /// \param[in] _perm Absolute source indices of the segment elements.
+    /// \param[in,out] _values Array to reorder.
+    /// \param[in] _begin First index of the segment.
+    private: template<typename T>
+    static void Permute(const std::vector<CSRIndex> &_perm,
+                        std::vector<T> &_values, const CSRIndex _begin)
+    {
+      std::vector<T> tmp(_perm.size());
+      for (std::size_t i = 0; i < _perm.size(); ++i)
+        tmp[i] = _values[_perm[i]];
+      std::copy(tmp.begin(), tmp.end(), _values.begin() + _begin);
+    }
+
+    /// \brief Vertex Ids, indexed by dense index.
+    private: std::vector<VertexId> ids;
+
+    /// \brief Row offsets into the arc arrays.
+    private: std::vector<CSRIndex> offsets = {0};
+
+    /// \brief Target vertex of each arc.
+    private: std::vector<CSRIndex> targets;
+
+    /// \brief Weight of each arc.
+    private: std::vector<double> weights;
+
+    /// \brief Edge Id of each arc.
+    private: std::vector<EdgeId> edgeIds;
+
+    /// \brief True when the Id of every vertex equals its dense index.
+    private: bool identity = true;
+
+    /// \brief True when built from a directed graph.
+    private: bool directed = false;
+  };
+}
+}
+}
+}
+#endif
@@ -0,0 +1,622 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRAPH_CSRGRAPHVIEW_HH_
+#define GZ_MATH_GRAPH_CSRGRAPHVIEW_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include "gz/math/BinaryCodec.hh"
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/graph/CSRGraph.hh"
+#include "gz/math/graph/Vertex.hh"
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+namespace graph
+{
+  /// \brief A CSRGraph read in place from a block of memory, usually a
+  /// file mapped with MappedFile.
+  ///
+  /// Write() stores a CSRGraph in a compact binary format: a 64 byte
+  /// header followed by the Ids(), Offsets(), Targets(), Weights() and
+  /// EdgeIds() arrays, and optionally one fixed size record per vertex
+  /// and per arc. Every array starts on an 8 byte boundary and values are
+  /// little endian, so once the file is mapped the arrays are used as
+  /// they are, without deserializing anything. Opening a graph of any
+  /// size only checks the header; the operating system loads the pages
+  /// that a query touches, and several processes mapping the same file
+  /// share them.
+  ///
+  /// A CSRGraphView has the accessors of CSRGraph, returning pointers
+  /// into the memory instead of vectors, and the workspace overloads of
+  /// BreadthFirstSort, DepthFirstSort and Dijkstra in GraphAlgorithms.hh
+  /// run on it directly. The memory must stay valid and unchanged while
+  /// the view is open.
+  ///
+  /// Open() trusts the arrays, as they were written by Write(). Call
+  /// Validate() once for files that come from an untrusted source. Views
+  /// can only be opened on little endian hosts, and the vertex and arc
+  /// records are stored with the layout of the host that wrote them.
+  ///
+  /// <b>Example</b>
+  /// \code{.cpp}
+  /// std::ofstream out("roads.gzcsr", std::ios::binary);
+  /// gz::math::graph::CSRGraphView::Write(out, csr);
+  /// out.close();
+  ///
+  /// gz::math::MappedFile file;
+  /// gz::math::graph::CSRGraphView view;
+  /// if (file.Open("roads.gzcsr") && view.Open(file.Data(), file.Size()))
+  /// {
+  ///   gz::math::graph::SearchWorkspace workspace;
+  ///   gz::math::graph::Dijkstra(view, 0, workspace, 42);
+  /// }
+  /// \endcode
+  class CSRGraphView
+  {
+    /// \brief Default constructor. No graph is open.
+    public: CSRGraphView() = default;
+
+    /// \brief Write a graph without vertex or arc records.
+    /// \param[out] _out Binary stream to write to.
+    /// \param[in] _graph The graph.
+    /// \return True on success.
+    public: static bool Write(std::ostream &_out, const CSRGraph &_graph)
+    {
+      return Write(_out, _graph, nullptr, 0, nullptr, 0);
+    }
+
+    /// \brief Write a graph with a record per vertex and per arc. Records
+    /// are copied byte for byte and must be trivially copyable, at most
+    /// 64 KiB and aligned to at most 8 bytes.
+    /// \param[out] _out Binary stream to write to.
+    /// \param[in] _graph The graph.
+    /// \param[in] _vertexData One record per vertex, indexed by dense
+    /// index, or empty.
+    /// \param[in] _arcData One record per arc, indexed like Targets(), or
+    /// empty. Use EdgeIds() to find the edge of each arc.
+    /// \return True on success, false if a non empty record vector
+    /// doesn't have one element per vertex or arc.
+    public: template<typename VertexData, typename ArcData>
+    static bool Write(std::ostream &_out, const CSRGraph &_graph,
+                      const std::vector<VertexData> &_vertexData,
+                      const std::vector<ArcData> &_arcData)
+    {
+      static_assert(std::is_trivially_copyable<VertexData>::value &&
+                    std::is_trivially_copyable<ArcData>::value,
+                    "Records must be trivially copyable");
+      static_assert(alignof(VertexData) <= kAlignment &&
+                    alignof(ArcData) <= kAlignment,
+                    "Records must not need more than 8 byte alignment");
+      static_assert(sizeof(VertexData) <= kMaxRecordSize &&
+                    sizeof(ArcData) <= kMaxRecordSize,
+                    "Records must not be larger than 64 KiB");
+
+      if ((!_vertexData.empty() &&
+           _vertexData.size() != _graph.VertexCount()) ||
+          (!_arcData.empty() && _arcData.size() != _graph.ArcCount()))
+      {
+        IGN_MATH_DIAGNOSTIC("Expected one record per vertex and per arc");
+        return false;
+      }
+
+      return Write(_out, _graph,
+          _vertexData.data(), _vertexData.empty() ? 0 : sizeof(VertexData),
+          _arcData.data(), _arcData.empty() ? 0 : sizeof(ArcData));
+    }
+
+    /// \brief Open a graph stored by Write(). Only the header is read.
+    /// \param[in] _data First byte of the stored graph, aligned to 8
+    /// bytes. A mapped file is aligned to a page.
+    /// \param[in] _size Number of bytes.
+    /// \return True on success. On failure, the view is left closed.
+    public: bool Open(const uint8_t *_data, const std::size_t _size)
+    {
+      this->Close();
+
+      if (!LittleEndianHost())
+      {
+        IGN_MATH_DIAGNOSTIC("Graph files can only be opened on little endian "
+            << "hosts");
+        return false;
+      }
+
+      if (!_data || reinterpret_cast<uintptr_t>(_data) % kAlignment != 0 ||
+          _size < kHeaderSize ||
+          std::memcmp(_data, kMagic, sizeof(kMagic)) != 0)
+      {
+        IGN_MATH_DIAGNOSTIC("Invalid graph file header");
+        return false;
+      }
+
+      BinaryDecoder decoder(_data + sizeof(kMagic),
+                            kHeaderSize - sizeof(kMagic));
+      uint32_t version = 0;
+      uint32_t flags = 0;
+      uint64_t n = 0;
+      uint64_t m = 0;
+      uint32_t vertexSize = 0;
+      uint32_t arcSize = 0;
+      decoder.Read(version);
+      decoder.Read(flags);
+      decoder.Read(n);
+      decoder.Read(m);
+      decoder.Read(vertexSize);
+      decoder.Read(arcSize);
+
+      if (!decoder.Good() || version != kVersion || n >= kNullIndex ||
+          m >= kNullIndex || vertexSize > kMaxRecordSize ||
+          arcSize > kMaxRecordSize)
+      {
+        IGN_MATH_DIAGNOSTIC("Invalid graph file header");
+        return false;
+      }
+
+      // Every array must fit in the file, and the row offsets must cover
+      // all the arcs.
+      const Layout layout(n, m, vertexSize, arcSize);
+      if (layout.end > _size)
+      {
+        IGN_MATH_DIAGNOSTIC("Truncated graph file");
+        return false;
+      }
+      const CSRIndex *rows =
+        reinterpret_cast<const CSRIndex *>(_data + layout.offsets);
+      if (rows[0] != 0 || rows[n] != m)
+      {
+        IGN_MATH_DIAGNOSTIC("Invalid graph file offsets");
+        return false;
+      }
+
+      this->vertexCount = static_cast<CSRIndex>(n);
+      this->arcCount = static_cast<CSRIndex>(m);
+      this->directed = (flags & kDirected) != 0;
+      this->identity = (flags & kIdentity) != 0;
+      this->vertexDataSize = vertexSize;
+      this->arcDataSize = arcSize;
+      this->ids = reinterpret_cast<const VertexId *>(_data + layout.ids);
+      this->offsets = rows;
+      this->targets =
+        reinterpret_cast<const CSRIndex *>(_data + layout.targets);
+      this->weights =
+        reinterpret_cast<const double *>(_data + layout.weights);
+      this->edgeIds =
+        reinterpret_cast<const EdgeId *>(_data + layout.edgeIds);
+      this->vertexData = vertexSize ? _data + layout.vertexData : nullptr;
+      this->arcData = arcSize ? _data + layout.arcData : nullptr;
+      return true;
+    }
+
+    /// \brief Close the view. The memory is not released.
+    public: void Close()
+    {
+      *this = CSRGraphView();
+    }
+
+    /// \brief Get whether a graph is open.
+    /// \return True if a graph is open.
+    public: bool IsOpen() const
+    {
+      return this->offsets != nullptr;
+    }
+
+    /// \brief Check every array of the graph, which reads the whole
+    /// graph: vertex Ids must be strictly increasing, row offsets
+    /// non-decreasing and arc targets valid vertex indices.
+    /// \return True if the graph is open and consistent.
+    public: bool Validate() const
+    {
+      if (!this->IsOpen())
+        return false;
+
+      for (CSRIndex i = 0; i < this->vertexCount; ++i)
+      {
+        if ((i > 0 && this->ids[i] <= this->ids[i - 1]) ||
+            (this->identity && this->ids[i] != i) ||
+            this->offsets[i + 1] < this->offsets[i])
+        {
+          return false;
+        }
+      }
+
+      return std::all_of(this->targets, this->targets + this->arcCount,
+        [this](const CSRIndex _target)
+        {
+          return _target < this->vertexCount;
+        });
+    }
+
+    /// \brief Get the number of vertices.
+    /// \return The number of vertices.
+    public: CSRIndex VertexCount() const
+    {
+      return this->vertexCount;
+    }
+
+    /// \brief Get the number of stored arcs. An undirected edge counts as
+    /// two arcs.
+    /// \return The number of arcs.
+    public: CSRIndex ArcCount() const
+    {
+      return this->arcCount;
+    }
+
+    /// \brief Get whether the graph has no vertices.
+    /// \return True when there are no vertices in the graph or
+    /// false otherwise.
+    public: bool Empty() const
+    {
+      return this->vertexCount == 0;
+    }
+
+    /// \brief Get whether the graph was built from a directed graph.
+    /// \return True if every edge was stored as a single arc or false if
+    /// the edges were stored in both directions.
+    public: bool Directed() const
+    {
+      return this->directed;
+    }
+
+    /// \brief Get the dense index of a vertex.
+    /// This is O(1) when the vertex Ids are 0..VertexCount()-1 and
+    /// O(log n) otherwise.
+    /// \param[in] _id The vertex Id.
+    /// \return The dense index of the vertex or kNullIndex if the vertex
+    /// does not exist.
+    public: CSRIndex Index(const VertexId &_id) const
+    {
+      if (this->identity)
+      {
+        return _id < this->vertexCount ? static_cast<CSRIndex>(_id)
+                                       : kNullIndex;
+      }
+
+      const VertexId *end = this->ids + this->vertexCount;
+      const VertexId *it = std::lower_bound(this->ids, end, _id);
+      if (it == end || *it != _id)
+        return kNullIndex;
+
+      return static_cast<CSRIndex>(it - this->ids);
+    }
+
+    /// \brief Get the Id of a vertex from its dense index.
+    /// \param[in] _index The dense index, in [0, VertexCount()).
+    /// \return The vertex Id or kNullId if the index is out of range.
+    public: VertexId Id(const CSRIndex _index) const
+    {
+      if (_index >= this->vertexCount)
+        return kNullId;
+
+      return this->ids[_index];
+    }
+
+    /// \brief Get the number of arcs leaving a vertex.
+    /// \param[in] _index The dense index of the vertex.
+    /// \return The out degree, or 0 if the index is out of range.
+    public: CSRIndex OutDegree(const CSRIndex _index) const
+    {
+      if (_index >= this->vertexCount)
+        return 0;
+
+      return this->offsets[_index + 1] - this->offsets[_index];
+    }
+
+    /// \brief Get the vertex Ids, sorted in ascending order.
+    /// \return VertexCount() vertex Ids.
+    public: const VertexId *Ids() const
+    {
+      return this->ids;
+    }
+
+    /// \brief Get the row offsets.
+    /// \return VertexCount() + 1 row offsets, or nullptr if no graph is
+    /// open.
+    public: const CSRIndex *Offsets() const
+    {
+      return this->offsets;
+    }
+
+    /// \brief Get the dense index of the target vertex of each arc.
+    /// \return ArcCount() arc targets.
+    public: const CSRIndex *Targets() const
+    {
+      return this->targets;
+    }
+
+    /// \brief Get the weight of each arc.
+    /// \return ArcCount() arc weights.
+    public: const double *Weights() const
+    {
+      return this->weights;
+    }
+
+    /// \brief Get the Id of the graph edge that produced each arc.
+    /// \return ArcCount() edge Ids.
+    public: const EdgeId *EdgeIds() const
+    {
+      return this->edgeIds;
+    }
+
+    /// \brief Get the size of the vertex records.
+    /// \return Size of a record in bytes, 0 if there are none.
+    public: std::size_t VertexDataSize() const
+    {
+      return this->vertexDataSize;
+    }
+
+    /// \brief Get the size of the arc records.
+    /// \return Size of a record in bytes, 0 if there are none.
+    public: std::size_t ArcDataSize() const
+    {
+      return this->arcDataSize;
+    }
+
+    /// \brief Get the vertex records, indexed by dense index.
+    /// \return VertexCount() records, or nullptr if there are none or if
+    /// their size is not the size of T.
+    public: template<typename T>
+    const T *VertexData() const
+    {
+      static_assert(alignof(T) <= kAlignment,
+                    "Records must not need more than 8 byte alignment");
+      if (this->vertexDataSize != sizeof(T))
+        return nullptr;
+      return reinterpret_cast<const T *>(this->vertexData);
+    }
+
+    /// \brief Get the arc records, indexed like Targets().
+    /// \return ArcCount() records, or nullptr if there are none or if
+    /// their size is not the size of T.
+    public: template<typename T>
+    const T *ArcData() const
+    {
+      static_assert(alignof(T) <= kAlignment,
+                    "Records must not need more than 8 byte alignment");
+      if (this->arcDataSize != sizeof(T))
+        return nullptr;
+      return reinterpret_cast<const T *>(this->arcData);
+    }
+
+    /// \brief Offsets of the arrays in a stored graph.
+    private: struct Layout
+    {
+      /// \brief Constructor.
+      /// \param[in] _n Number of vertices.
+      /// \param[in] _m Number of arcs.
+      /// \param[in] _vertexSize Size of a vertex record.
+      /// \param[in] _arcSize Size of an arc record.
+      Layout(const uint64_t _n, const uint64_t _m,
+             const uint64_t _vertexSize, const uint64_t _arcSize)
+      {
+        uint64_t pos = kHeaderSize;
+        auto next = [&pos](const uint64_t _bytes)
+        {
+          const uint64_t start = pos;
+          pos = Align(pos + _bytes);
+          return start;
+        };
+        this->ids = next(_n * sizeof(VertexId));
+        this->offsets = next((_n + 1) * sizeof(CSRIndex));
+        this->targets = next(_m * sizeof(CSRIndex));
+        this->weights = next(_m * sizeof(double));
+        this->edgeIds = next(_m * sizeof(EdgeId));
+        this->vertexData = next(_n * _vertexSize);
+        this->arcData = next(_m * _arcSize);
+        this->end = pos;
+      }
+
+      /// \brief Offset of the vertex Ids.
+      uint64_t ids;
+
+      /// \brief Offset of the row offsets.
+      uint64_t offsets;
+
+      /// \brief Offset of the arc targets.
+      uint64_t targets;
+
+      /// \brief Offset of the arc weights.
+      uint64_t weights;
+
+      /// \brief Offset of the arc edge Ids.
+      uint64_t edgeIds;
+
+      /// \brief Offset of the vertex records.
+      uint64_t vertexData;
+
+      /// \brief Offset of the arc records.
+      uint64_t arcData;
+
+      /// \brief Size of the stored graph.
+      uint64_t end;
+    };
+
+    /// \brief Round a size up to the alignment of the arrays.
+    /// \param[in] _size The size.
+    /// \return The aligned size.
+    private: static uint64_t Align(const uint64_t _size)
+    {
+      return (_size + kAlignment - 1) / kAlignment * kAlignment;
+    }
+
+    /// \brief Check if the host is little endian.
+    /// \return True if the host is little endian.
+    private: static bool LittleEndianHost()
+    {
+      const uint16_t one = 1;
+      uint8_t first;
+      std::memcpy(&first, &one, 1);
+      return first == 1;
+    }
+
+    /// \brief Write a graph with records given as bytes.
+    /// \param[out] _out Binary stream to write to.
+    /// \param[in] _graph The graph.
+    /// \param[in] _vertexData Vertex records, or nullptr.
+    /// \param[in] _vertexSize Size of a vertex record, or 0.
+    /// \param[in] _arcData Arc records, or nullptr.
+    /// \param[in] _arcSize Size of an arc record, or 0.
+    /// \return True on success.
+    private: static bool Write(std::ostream &_out, const CSRGraph &_graph,
+                               const void *_vertexData,
+                               const std::size_t _vertexSize,
+                               const void *_arcData,
+                               const std::size_t _arcSize)
+    {
+      const uint64_t n = _graph.VertexCount();
+      const uint64_t m = _graph.ArcCount();
+      const bool identity = n == 0 || _graph.Ids().back() == n - 1;
+
+      std::vector<uint8_t> buffer(kMagic, kMagic + sizeof(kMagic));
+      BinaryEncoder encoder(buffer);
+      encoder.Write(kVersion);
+      encoder.Write((_graph.Directed() ? kDirected : 0u) |
+                    (identity ? kIdentity : 0u));
+      encoder.Write(n);
+      encoder.Write(m);
+      encoder.Write(static_cast<uint32_t>(_vertexSize));
+      encoder.Write(static_cast<uint32_t>(_arcSize));
+      buffer.resize(kHeaderSize, 0);
+      _out.write(reinterpret_cast<const char *>(buffer.data()),
+                 static_cast<std::streamsize>(buffer.size()));
+
+      WriteArray(_out, _graph.Ids());
+      WriteArray(_out, _graph.Offsets());
+      WriteArray(_out, _graph.Targets());
+      WriteArray(_out, _graph.Weights());
+      WriteArray(_out, _graph.EdgeIds());
+      WriteBytes(_out, _vertexData, n * _vertexSize);
+      WriteBytes(_out, _arcData, m * _arcSize);
+      return _out.good();
+    }
+
+    /// \brief Encode an array and write it to a stream in chunks,
+    /// followed by its padding.
+    /// \param[out] _out Stream to write to.
+    /// \param[in] _values Values to write.
+    private: template<typename T>
+    static void WriteArray(std::ostream &_out, const std::vector<T> &_values)
+    {
+      std::vector<uint8_t> buffer;
+      for (std::size_t i = 0; i < _values.size(); i += kChunk)
+      {
+        buffer.clear();
+        BinaryEncoder encoder(buffer);
+        encoder.WriteArray(_values.data() + i,
+                           std::min(kChunk, _values.size() - i));
+        _out.write(reinterpret_cast<const char *>(buffer.data()),
+                   static_cast<std::streamsize>(buffer.size()));
+      }
+      WriteBytes(_out, nullptr, _values.size() * sizeof(T));
+    }
+
+    /// \brief Write bytes to a stream, followed by their padding.
+    /// \param[out] _out Stream to write to.
+    /// \param[in] _data Bytes to write, or nullptr to only write the
+    /// padding.
+    /// \param[in] _size Number of bytes.
+    private: static void WriteBytes(std::ostream &_out, const void *_data,
+                                    const uint64_t _size)
+    {
+      if (_data)
+      {
+        _out.write(static_cast<const char *>(_data),
+                   static_cast<std::streamsize>(_size));
+      }
+      const char padding[kAlignment] = {};
+      _out.write(padding, static_cast<std::streamsize>(Align(_size) - _size));
+    }
+
+    /// \brief First bytes of a graph file.
+    private: static constexpr char kMagic[8] =
+      {'G', 'Z', 'C', 'S', 'R', '\0', '\0', '\0'};
+
+    /// \brief Version of the format.
+    private: static constexpr uint32_t kVersion = 1;
+
+    /// \brief Size of the header, which keeps the arrays aligned.
+    private: static constexpr std::size_t kHeaderSize = 64;
+
+    /// \brief Alignment of every array.
+    private: static constexpr std::size_t kAlignment = 8;
+
+    /// \brief Largest size of a vertex or arc record.
+    private: static constexpr std::size_t kMaxRecordSize = 65536;
+
+    /// \brief Number of values encoded at a time when writing.
+    private: static constexpr std::size_t kChunk = 4096;
+
+    /// \brief Flag of the header set for directed graphs.
+    private: static constexpr uint32_t kDirected = 1;
+
+    /// \brief Flag of the header set when vertex Ids equal their index.
+    private: static constexpr uint32_t kIdentity = 2;
+
+    /// \brief Number of vertices.
+    private: CSRIndex vertexCount = 0;
+
+    /// \brief Number of arcs.
+    private: CSRIndex arcCount = 0;
+
+    /// \brief True when built from a directed graph.
+    private: bool directed = false;
+
+    /// \brief True when the Id of every vertex equals its dense index.
+    private: bool identity = true;
+
+    /// \brief Size of a vertex record.
+    private: std::size_t vertexDataSize = 0;
+
+    /// \brief Size of an arc record.
+    private: std::size_t arcDataSize = 0;
+
+    /// \brief Vertex Ids, indexed by dense index.
+    private: const VertexId *ids = nullptr;
+
+    /// \brief Row offsets into the arc arrays.
+    private: const CSRIndex *offsets = nullptr;
+
+    /// \brief Target vertex of each arc.
+    private: const CSRIndex *targets = nullptr;
+
+    /// \brief Weight of each arc.
+    private: const double *weights = nullptr;
+
+    /// \brief Edge Id of each arc.
+    private: const EdgeId *edgeIds = nullptr;
+
+    /// \brief Vertex records, or nullptr.
+    private: const uint8_t *vertexData = nullptr;
+
+    /// \brief Arc records, or nullptr.
+    private: const uint8_t *arcData = nullptr;
+  };
+}
+}
+}
+}
+#endif
@@ -0,0 +1,997 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRAPH_CONTRACTIONHIERARCHY_HH_
+#define GZ_MATH_GRAPH_CONTRACTIONHIERARCHY_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include "gz/math/BinaryCodec.hh"
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/graph/CSRGraph.hh"
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+#include "gz/math/graph/SearchWorkspace.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/Trace.hh"
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+namespace graph
+{
+  /// \brief A contraction hierarchy, a preprocessed form of a weighted
+  /// graph that answers point-to-point shortest path queries much faster
+  /// than Dijkstra on a graph that doesn't change.
+  ///
+  /// Preprocessing ranks the vertices by importance and contracts them
+  /// from the least important one: a contracted vertex is removed from
+  /// the remaining graph, and a shortcut arc is added between two of its
+  /// neighbors whenever the path through it is the only shortest path
+  /// between them. A query then runs a bidirectional Dijkstra search that
+  /// only follows arcs towards more important vertices, which explores a
+  /// few hundred vertices on road-like graphs, and expands the shortcuts
+  /// of the path it finds back into the original vertices.
+  ///
+  /// Edge weights must not be negative. An undirected graph is handled as
+  /// a directed graph with an arc in each direction.
+  ///
+  /// The hierarchy can be saved to a compact byte buffer, which is the
+  /// same on every platform, and loaded back without preprocessing again.
+  ///
+  /// <b>Example</b>
+  /// \code{.cpp}
+  /// gz::math::graph::DirectedGraph<int, double> graph(...);
+  /// gz::math::graph::ContractionHierarchy ch(graph);
+  /// auto path = ch.ShortestPath(0, 42);
+  ///
+  /// // Many queries, without allocating.
+  /// gz::math::graph::SearchWorkspace forward, backward;
+  /// std::vector<gz::math::graph::VertexId> vertices;
+  /// double cost = ch.ShortestPath(0, 42, forward, backward, vertices);
+  /// \endcode
+  class ContractionHierarchy
+  {
+    /// \brief Default constructor. Creates an empty hierarchy.
+    public: ContractionHierarchy() = default;
+
+    /// \brief Constructor. Preprocesses a graph.
+    /// \param[in] _graph The graph.
+    public: template<typename V, typename E, typename EdgeType>
+    explicit ContractionHierarchy(const Graph<V, E, EdgeType> &_graph)
+      : ContractionHierarchy(CSRGraph(_graph))
+    {
+    }
+
+    /// \brief Constructor. Preprocesses a CSR graph.
+    /// \param[in] _graph The graph.
+    public: explicit ContractionHierarchy(const CSRGraph &_graph)
+    {
+      IGN_MATH_TRACE_ZONE("ContractionHierarchy::ContractionHierarchy");
+      const CSRIndex n = _graph.VertexCount();
+      this->ids = _graph.Ids();
+      this->ranks.assign(n, 0);
+
+      // Remaining graph, with one arc per pair of vertices.
+      Contraction contraction(n);
+      const auto &offsets = _graph.Offsets();
+      const auto &targets = _graph.Targets();
+      const auto &weights = _graph.Weights();
+      for (CSRIndex u = 0; u < n; ++u)
+      {
+        for (CSRIndex arc = offsets[u]; arc < offsets[u + 1]; ++arc)
+        {
+          if (targets[arc] != u)
+            contraction.AddArc(u, targets[arc], weights[arc], kNullIndex);
+        }
+      }
+
+      // Contract the vertices by increasing priority. Priorities only
+      // grow as the graph is contracted, so they are updated lazily when
+      // a vertex reaches the top of the queue.
+      using Entry = std::pair<int64_t, CSRIndex>;
+      std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+      for (CSRIndex v = 0; v < n; ++v)
+        pq.push(std::make_pair(contraction.Priority(v), v));
+
+      CSRIndex rank = 0;
+      while (!pq.empty())
+      {
+        const CSRIndex v = pq.top().second;
+        pq.pop();
+
+        const int64_t priority = contraction.Priority(v);
+        if (!pq.empty() && priority > pq.top().first)
+        {
+          pq.push(std::make_pair(priority, v));
+          continue;
+        }
+
+        contraction.Contract(v);
+        this->ranks[v] = rank++;
+      }
+
+      // Every arc, original or shortcut, goes up from its source or down
+      // to its target.
+      std::vector<std::vector<Arc>> upRows(n);
+      std::vector<std::vector<Arc>> downRows(n);
+      for (CSRIndex u = 0; u < n; ++u)
+      {
+        for (const Arc &arc : contraction.out[u])
+        {
+          if (this->ranks[arc.vertex] > this->ranks[u])
+            upRows[u].push_back(arc);
+          else
+            downRows[arc.vertex].push_back({u, arc.weight, arc.middle});
+        }
+      }
+      this->up.Assign(upRows);
+      this->down.Assign(downRows);
+    }
+
+    /// \brief Get the number of vertices.
+    /// \return The number of vertices.
+    public: CSRIndex VertexCount() const
+    {
+      return static_cast<CSRIndex>(this->ids.size());
+    }
+
+    /// \brief Get the number of arcs, including the shortcuts.
+    /// \return The number of arcs.
+    public: CSRIndex ArcCount() const
+    {
+      return this->up.Count() + this->down.Count();
+    }
+
+    /// \brief Get the number of shortcuts added by the preprocessing.
+    /// \return The number of shortcuts.
+    public: CSRIndex ShortcutCount() const
+    {
+      return this->up.ShortcutCount() + this->down.ShortcutCount();
+    }
+
+    /// \brief Get whether the hierarchy has no vertices.
+    /// \return True when there are no vertices.
+    public: bool Empty() const
+    {
+      return this->ids.empty();
+    }
+
+    /// \brief Get the dense index of a vertex, in the same order as
+    /// CSRGraph::Index().
+    /// \param[in] _id The vertex Id.
+    /// \return The dense index of the vertex or kNullIndex if the vertex
+    /// does not exist.
+    public: CSRIndex Index(const VertexId &_id) const
+    {
+      auto it = std::lower_bound(this->ids.begin(), this->ids.end(), _id);
+      if (it == this->ids.end() || *it != _id)
+        return kNullIndex;
+
+      return static_cast<CSRIndex>(it - this->ids.begin());
+    }
+
+    /// \brief Get the importance of a vertex, which is the order in which
+    /// it was contracted.
+    /// \param[in] _index Dense index of the vertex.
+    /// \return The rank, in [0, VertexCount()), or kNullIndex if the index
+    /// is out of range.
+    public: CSRIndex Rank(const CSRIndex _index) const
+    {
+      return _index < this->ranks.size() ? this->ranks[_index] : kNullIndex;
+    }
+
+    /// \brief Find the shortest path between two vertices, reusing the
+    /// memory of two workspaces. Nothing is allocated once the workspaces
+    /// and the path have grown to the size needed by the queries.
+    /// \param[in] _from The starting vertex.
+    /// \param[in] _to The destination vertex.
+    /// \param[in, out] _forward Memory of the search from _from.
+    /// \param[in, out] _backward Memory of the search from _to.
+    /// \param[out] _path The vertices of the shortest path, including
+    /// _from and _to. It is empty if there is no path.
+    /// \return The cost of the shortest path, or MAX_D if _to can't be
+    /// reached or one of the vertices doesn't exist.
+    public: double ShortestPath(const VertexId &_from, const VertexId &_to,
+                                SearchWorkspace &_forward,
+                                SearchWorkspace &_backward,
+                                std::vector<VertexId> &_path) const
+    {
+      _path.clear();
+
+      // Sanity check: The source and destination vertices should exist.
+      for (auto const &id : {_from, _to})
+      {
+        if (this->Index(id) == kNullIndex)
+        {
+          IGN_MATH_DIAGNOSTIC("Vertex [" << id << "] Not found");
+          return MAX_D;
+        }
+      }
+      const CSRIndex from = this->Index(_from);
+      const CSRIndex to = this->Index(_to);
+
+      // Index 0 is the forward search and index 1 the backward search.
+      // Both only move up the hierarchy.
+      SearchWorkspace *search[2] = {&_forward, &_backward};
+      const Arcs *arcs[2] = {&this->up, &this->down};
+      _forward.Reset(this->VertexCount());
+      _backward.Reset(this->VertexCount());
+      _forward.Push(from, 0.0, from);
+      _backward.Push(to, 0.0, to);
+
+      // Best path found so far and the vertex where both searches meet.
+      double best = MAX_D;
+      CSRIndex meeting = kNullIndex;
+
+      while (true)
+      {
+        // Expand the search with the lower frontier, until neither can
+        // improve the best path.
+        double top[2];
+        for (int side = 0; side < 2; ++side)
+        {
+          const CSRIndex u = search[side]->Top();
+          top[side] = u == kNullIndex ? MAX_D : search[side]->Cost(u);
+        }
+        const int side = top[0] <= top[1] ? 0 : 1;
+        if (top[side] >= best)
+          break;
+
+        SearchWorkspace &mine = *search[side];
+        const SearchWorkspace &other = *search[1 - side];
+        const CSRIndex u = mine.Pop();
+        const double uCost = mine.Cost(u);
+
+        // Check whether the searches meet at u with a shorter path.
+        if (other.Reached(u) && uCost + other.Cost(u) < best)
+        {
+          best = uCost + other.Cost(u);
+          meeting = u;
+        }
+
+        // Stall on demand: u can't be on a shortest path if a more
+        // important vertex reaches it with a lower cost.
+        const Arcs &b = *arcs[1 - side];
+        bool stalled = false;
+        for (CSRIndex arc = b.offsets[u];
+             arc < b.offsets[u + 1] && !stalled; ++arc)
+        {
+          stalled = mine.Cost(b.vertices[arc]) + b.weights[arc] < uCost;
+        }
+        if (stalled)
+          continue;
+
+        const Arcs &a = *arcs[side];
+        for (CSRIndex arc = a.offsets[u]; arc < a.offsets[u + 1]; ++arc)
+          mine.Push(a.vertices[arc], uCost + a.weights[arc], u);
+      }
+
+      if (meeting == kNullIndex)
+        return MAX_D;
+
+      // Vertices of the path in the hierarchy, from the source to the
+      // meeting vertex and then to the destination. The pending lists of
+      // the searches are free at this point.
+      auto &vertices = _backward.Pending();
+      for (CSRIndex v = meeting; v != from; v = _forward.Previous(v))
+        vertices.push_back(v);
+      vertices.push_back(from);
+      std::reverse(vertices.begin(), vertices.end());
+      for (CSRIndex v = meeting; v != to;)
+      {
+        v = _backward.Previous(v);
+        vertices.push_back(v);
+      }
+
+      // Expand the shortcuts with a stack of arcs, stored as the target
+      // then the source vertex, so that the first arc is on top.
+      auto &stack = _forward.Pending();
+      for (std::size_t i = vertices.size() - 1; i > 0; --i)
+      {
+        stack.push_back(vertices[i]);
+        stack.push_back(vertices[i - 1]);
+      }
+
+      _path.push_back(_from);
+      while (!stack.empty())
+      {
+        const CSRIndex a = stack.back();
+        stack.pop_back();
+        const CSRIndex b = stack.back();
+        stack.pop_back();
+
+        const CSRIndex middle = this->Middle(a, b);
+        if (middle == kNullIndex)
+        {
+          _path.push_back(this->ids[b]);
+          continue;
+        }
+        // Expand (a, middle) first, then (middle, b).
+        stack.push_back(b);
+        stack.push_back(middle);
+        stack.push_back(middle);
+        stack.push_back(a);
+      }
+
+      return best;
+    }
+
+    /// \brief Find the shortest path between two vertices.
+    /// \param[in] _from The starting vertex.
+    /// \param[in] _to The destination vertex.
+    /// \return The cost and the vertices of the shortest path, including
+    /// _from and _to. If the destination cannot be reached or one of the
+    /// vertices doesn't exist, the cost is MAX_D and the path is empty.
+    public: PathInfo ShortestPath(const VertexId &_from,
+                                  const VertexId &_to) const
+    {
+      SearchWorkspace forward;
+      SearchWorkspace backward;
+      PathInfo res(MAX_D, {});
+      res.first = this->ShortestPath(_from, _to, forward, backward,
+                                     res.second);
+      return res;
+    }
+
+    /// \brief Compute the costs of the shortest paths from several source
+    /// vertices to several target vertices, with the bucket method of
+    /// Knopp et al.
+    ///
+    /// Each target runs a backward search up the hierarchy, and leaves its
+    /// cost in a bucket of every vertex it settles. Each source then runs
+    /// a forward search up the hierarchy, and every vertex it settles
+    /// joins its cost with the bucket entries of that vertex. This takes
+    /// one search per source and per target, instead of one per pair, and
+    /// each search only explores a small part of the graph. The searches
+    /// are split among threads, each with its own SearchWorkspace.
+    /// \sa DistanceTable(const CSRGraph &, const std::vector<VertexId> &,
+    /// const std::vector<VertexId> &, std::vector<double> &,
+    /// const unsigned int)
+    /// \param[in] _sources The source vertices, one row each.
+    /// \param[in] _targets The target vertices, one column each.
+    /// \param[out] _table Row major table of _sources.size() rows and
+    /// _targets.size() columns. The entry of source i and target j is at
+    /// i * _targets.size() + j, and is MAX_D if the target can't be
+    /// reached. The table is cleared on error.
+    /// \param[in] _threads Number of threads. A value of 0 uses the number
+    /// of hardware threads.
+    /// \return False if a source or target vertex doesn't exist.
+    public: bool DistanceTable(const std::vector<VertexId> &_sources,
+                               const std::vector<VertexId> &_targets,
+                               std::vector<double> &_table,
+                               const unsigned int _threads = 1) const
+    {
+      IGN_MATH_TRACE_ZONE("ContractionHierarchy::DistanceTable");
+      // Minimum number of searches run by each thread.
+      const std::size_t kMinSearchesPerThread = 16;
+
+      _table.clear();
+      for (const auto *list : {&_sources, &_targets})
+      {
+        for (const VertexId &id : *list)
+        {
+          if (this->Index(id) == kNullIndex)
+          {
+            IGN_MATH_DIAGNOSTIC("Vertex [" << id << "] Not found");
+            return false;
+          }
+        }
+      }
+
+      const std::size_t columns = _targets.size();
+      _table.assign(_sources.size() * columns, MAX_D);
+      if (_table.empty())
+        return true;
+
+      // Vertices settled by the backward searches, with the target and the
+      // cost from the vertex to the target, gathered by thread.
+      struct Entry
+      {
+        CSRIndex vertex;
+        CSRIndex column;
+        double cost;
+      };
+      std::size_t blocks = detail::BlockCount(columns,
+          kMinSearchesPerThread, _threads);
+      std::vector<std::vector<Entry>> entries(blocks);
+      detail::ForEachBlock(columns, blocks,
+        [&](std::size_t _b, std::size_t _begin, std::size_t _end)
+        {
+          SearchWorkspace search;
+          std::vector<CSRIndex> settled;
+          for (std::size_t j = _begin; j < _end; ++j)
+          {
+            this->SearchUp(this->Index(_targets[j]), 1, search, settled);
+            for (const CSRIndex v : settled)
+            {
+              entries[_b].push_back(
+                  {v, static_cast<CSRIndex>(j), search.Cost(v)});
+            }
+          }
+        });
+
+      // Sort the entries into buckets by vertex.
+      const CSRIndex n = this->VertexCount();
+      std::vector<CSRIndex> offsets(n + 1, 0);
+      for (const auto &block : entries)
+      {
+        for (const Entry &entry : block)
+          ++offsets[entry.vertex + 1];
+      }
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      std::vector<std::pair<CSRIndex, double>> buckets(offsets.back());
+      std::vector<CSRIndex> next(offsets.begin(), offsets.end() - 1);
+      for (const auto &block : entries)
+      {
+        for (const Entry &entry : block)
+        {
+          buckets[next[entry.vertex]++] =
+              std::make_pair(entry.column, entry.cost);
+        }
+      }
+      entries.clear();
+
+      blocks = detail::BlockCount(_sources.size(), kMinSearchesPerThread,
+                                  _threads);
+      detail::ForEachBlock(_sources.size(), blocks,
+        [&](std::size_t, std::size_t _begin, std::size_t _end)
+        {
+          SearchWorkspace search;
+          std::vector<CSRIndex> settled;
+          for (std::size_t i = _begin; i < _end; ++i)
+          {
+            this->SearchUp(this->Index(_sources[i]), 0, search, settled);
+            double *row = _table.data() + i * columns;
+            for (const CSRIndex u : settled)
+            {
+              const double uCost = search.Cost(u);
+              for (CSRIndex k = offsets[u]; k < offsets[u + 1]; ++k)
+              {
+                row[buckets[k].first] = std::min(row[buckets[k].first],
+                    uCost + buckets[k].second);
+              }
+            }
+          }
+        });
+
+      return true;
+    }
+
+    /// \brief Append the hierarchy to a byte buffer.
+    /// \param[in, out] _buffer Buffer the hierarchy is appended to.
+    public: void Save(std::vector<uint8_t> &_buffer) const
+    {
+      BinaryEncoder encoder(_buffer);
+      encoder.WriteArray(kMagic, sizeof(kMagic));
+      encoder.WriteVarint(kVersion);
+      encoder.WriteVarint(this->ids.size());
+
+      // Vertex Ids are sorted, so their differences are small.
+      VertexId previous = 0;
+      for (const VertexId id : this->ids)
+      {
+        encoder.WriteVarint(id - previous);
+        previous = id;
+      }
+      encoder.WriteArray(this->ranks.data(), this->ranks.size());
+      this->up.Save(encoder);
+      this->down.Save(encoder);
+    }
+
+    /// \brief Write the hierarchy to a stream, such as a file opened in
+    /// binary mode.
+    /// \param[out] _out The stream.
+    /// \return True if the stream is good after writing.
+    public: bool Save(std::ostream &_out) const
+    {
+      std::vector<uint8_t> buffer;
+      this->Save(buffer);
+      _out.write(reinterpret_cast<const char *>(buffer.data()),
+                 static_cast<std::streamsize>(buffer.size()));
+      return _out.good();
+    }
+
+    /// \brief Load a hierarchy written by Save(). The data is validated,
+    /// so a truncated or corrupted buffer can't cause invalid queries.
+    /// \param[in] _data The bytes.
+    /// \param[in] _size Number of bytes.
+    /// \return True on success. On failure, the hierarchy is unchanged.
+    public: bool Load(const uint8_t *_data, const std::size_t _size)
+    {
+      BinaryDecoder decoder(_data, _size);
+      ContractionHierarchy ch;
+
+      uint8_t magic[sizeof(kMagic)];
+      uint64_t version = 0;
+      uint64_t count = 0;
+      bool valid = decoder.ReadArray(magic, sizeof(magic)) &&
+        std::equal(std::begin(magic), std::end(magic), kMagic) &&
+        decoder.ReadVarint(version) && version == kVersion &&
+        decoder.ReadVarint(count) && count < kNullIndex &&
+        count <= decoder.Remaining();
+
+      if (valid)
+      {
+        const CSRIndex n = static_cast<CSRIndex>(count);
+        ch.ids.resize(n);
+        for (CSRIndex i = 0; i < n && valid; ++i)
+        {
+          uint64_t delta = 0;
+          valid = decoder.ReadVarint(delta) && (i == 0 || delta > 0);
+          ch.ids[i] = (i == 0 ? 0 : ch.ids[i - 1]) + delta;
+          valid = valid && (i == 0 || ch.ids[i] > ch.ids[i - 1]);
+        }
+
+        // The ranks must be a permutation.
+        valid = valid && n <= decoder.Remaining() / sizeof(CSRIndex);
+        if (valid)
+        {
+          ch.ranks.resize(n);
+          decoder.ReadArray(ch.ranks.data(), n);
+          std::vector<bool> used(n, false);
+          for (const CSRIndex rank : ch.ranks)
+          {
+            valid = valid && rank < n && !used[rank];
+            if (valid)
+              used[rank] = true;
+          }
+        }
+
+        valid = valid && ch.up.Load(decoder, n) && ch.down.Load(decoder, n);
+      }
+
+      if (!valid || !decoder.Good())
+      {
+        IGN_MATH_DIAGNOSTIC("[ContractionHierarchy] Invalid data. "
+            << "Ignoring hierarchy.");
+        return false;
+      }
+
+      *this = std::move(ch);
+      return true;
+    }
+
+    /// \brief Load a hierarchy written by Save().
+    /// \param[in] _buffer The bytes.
+    /// \return True on success. On failure, the hierarchy is unchanged.
+    public: bool Load(const std::vector<uint8_t> &_buffer)
+    {
+      return this->Load(_buffer.data(), _buffer.size());
+    }
+
+    /// \brief Load a hierarchy written by Save() from the rest of a
+    /// stream, such as a file opened in binary mode.
+    /// \param[in] _in The stream.
+    /// \return True on success. On failure, the hierarchy is unchanged.
+    public: bool Load(std::istream &_in)
+    {
+      const std::vector<uint8_t> buffer(
+          (std::istreambuf_iterator<char>(_in)),
+          std::istreambuf_iterator<char>());
+      return this->Load(buffer);
+    }
+
+    /// \brief An arc of the hierarchy.
+    private: struct Arc
+    {
+      /// \brief The other vertex of the arc.
+      CSRIndex vertex;
+
+      /// \brief Weight of the arc.
+      double weight;
+
+      /// \brief Vertex whose contraction added the arc as a shortcut, or
+      /// kNullIndex for an arc of the original graph.
+      CSRIndex middle;
+    };
+
+    /// \brief Arcs in CSR form, with each row sorted by vertex.
+    private: struct Arcs
+    {
+      /// \brief Fill the arrays.
+      /// \param[in] _rows Arcs of each row.
+      void Assign(std::vector<std::vector<Arc>> &_rows)
+      {
+        this->offsets.assign(1, 0);
+        for (auto &row : _rows)
+        {
+          std::sort(row.begin(), row.end(),
+            [](const Arc &_a, const Arc &_b)
+            {
+              return _a.vertex < _b.vertex;
+            });
+          for (const Arc &arc : row)
+          {
+            this->vertices.push_back(arc.vertex);
+            this->weights.push_back(arc.weight);
+            this->middles.push_back(arc.middle);
+          }
+          this->offsets.push_back(
+              static_cast<CSRIndex>(this->vertices.size()));
+        }
+      }
+
+      /// \brief Get the number of arcs.
+      /// \return The number of arcs.
+      CSRIndex Count() const
+      {
+        return static_cast<CSRIndex>(this->vertices.size());
+      }
+
+      /// \brief Get the number of shortcuts.
+      /// \return The number of arcs with a middle vertex.
+      CSRIndex ShortcutCount() const
+      {
+        return static_cast<CSRIndex>(this->middles.size() - std::count(
+            this->middles.begin(), this->middles.end(), kNullIndex));
+      }
+
+      /// \brief Find an arc.
+      /// \param[in] _row The row.
+      /// \param[in] _vertex The other vertex of the arc.
+      /// \return Position of the arc, or kNullIndex if there is none.
+      CSRIndex Find(const CSRIndex _row, const CSRIndex _vertex) const
+      {
+        auto first = this->vertices.begin() + this->offsets[_row];
+        auto last = this->vertices.begin() + this->offsets[_row + 1];
+        auto it = std::lower_bound(first, last, _vertex);
+        if (it == last || *it != _vertex)
+          return kNullIndex;
+        return static_cast<CSRIndex>(it - this->vertices.begin());
+      }
+
+      /// \brief Append the arrays to an encoder.
+      /// \param[in, out] _encoder The encoder.
+      void Save(BinaryEncoder &_encoder) const
+      {
+        for (std::size_t i = 1; i < this->offsets.size(); ++i)
+          _encoder.WriteVarint(this->offsets[i] - this->offsets[i - 1]);
+        _encoder.WriteArray(this->vertices.data(), this->vertices.size());
+        _encoder.WriteArray(this->weights.data(), this->weights.size());
+        _encoder.WriteArray(this->middles.data(), this->middles.size());
+      }
+
+      /// \brief Read and validate the arrays.
+      /// \param[in, out] _decoder The decoder.
+      /// \param[in] _n Number of vertices.
+      /// \return True on success.
+      bool Load(BinaryDecoder &_decoder, const CSRIndex _n)
+      {
+        this->offsets.assign(1, 0);
+        for (CSRIndex i = 0; i < _n; ++i)
+        {
+          uint64_t degree = 0;
+          if (!_decoder.ReadVarint(degree) ||
+              degree >= kNullIndex - this->offsets.back())
+          {
+            return false;
+          }
+          this->offsets.push_back(
+              this->offsets.back() + static_cast<CSRIndex>(degree));
+        }
+
+        // Check the size before allocating.
+        const std::size_t count = this->offsets.back();
+        const std::size_t arcSize = 2 * sizeof(CSRIndex) + sizeof(double);
+        if (count > _decoder.Remaining() / arcSize)
+          return false;
+
+        this->vertices.resize(count);
+        this->weights.resize(count);
+        this->middles.resize(count);
+        if (!_decoder.ReadArray(this->vertices.data(), count) ||
+            !_decoder.ReadArray(this->weights.data(), count) ||
+            !_decoder.ReadArray(this->middles.data(), count))
+        {
+          return false;
+        }
+
+        for (CSRIndex i = 0; i < _n; ++i)
+        {
+          for (CSRIndex arc = this->offsets[i]; arc < this->offsets[i + 1];
+               ++arc)
+          {
+            if (this->vertices[arc] >= _n ||
+                (arc > this->offsets[i] &&
+                 this->vertices[arc] <= this->vertices[arc - 1]) ||
+                (this->middles[arc] >= _n &&
+                 this->middles[arc] != kNullIndex) ||
+                !(this->weights[arc] >= 0.0))
+            {
+              return false;
+            }
+          }
+        }
+        return true;
+      }
+
+      /// \brief Row offsets into the arc arrays.
+      std::vector<CSRIndex> offsets = {0};
+
+      /// \brief Other vertex of each arc: the target of an upward arc, or
+      /// the source of a downward arc.
+      std::vector<CSRIndex> vertices;
+
+      /// \brief Weight of each arc.
+      std::vector<double> weights;
+
+      /// \brief Middle vertex of each arc, or kNullIndex.
+      std::vector<CSRIndex> middles;
+    };
+
+    /// \brief A shortcut found by the preprocessing.
+    private: struct Shortcut
+    {
+      /// \brief Source vertex.
+      CSRIndex from;
+
+      /// \brief Target vertex.
+      CSRIndex to;
+
+      /// \brief Weight of the shortcut.
+      double weight;
+
+      /// \brief Contracted vertex the shortcut goes through.
+      CSRIndex middle;
+    };
+
+    /// \brief State of the preprocessing.
+    private: struct Contraction
+    {
+      /// \brief Constructor.
+      /// \param[in] _n Number of vertices.
+      explicit Contraction(const CSRIndex _n)
+        : out(_n), in(_n), contracted(_n, false), deletedNeighbors(_n, 0)
+      {
+      }
+
+      /// \brief Add an arc, or lower the weight of the existing arc
+      /// between the same vertices.
+      /// \param[in] _u Source vertex.
+      /// \param[in] _v Target vertex.
+      /// \param[in] _weight Weight of the arc.
+      /// \param[in] _middle Middle vertex of a shortcut, or kNullIndex.
+      void AddArc(const CSRIndex _u, const CSRIndex _v,
+                  const double _weight, const CSRIndex _middle)
+      {
+        auto match = [](const CSRIndex _vertex)
+        {
+          return [_vertex](const Arc &_arc) {return _arc.vertex == _vertex;};
+        };
+        auto fwd = std::find_if(this->out[_u].begin(), this->out[_u].end(),
+                                match(_v));
+        if (fwd == this->out[_u].end())
+        {
+          this->out[_u].push_back({_v, _weight, _middle});
+          this->in[_v].push_back({_u, _weight, _middle});
+          return;
+        }
+
+        if (fwd->weight <= _weight)
+          return;
+
+        auto bwd = std::find_if(this->in[_v].begin(), this->in[_v].end(),
+                                match(_u));
+        *fwd = {_v, _weight, _middle};
+        *bwd = {_u, _weight, _middle};
+      }
+
+      /// \brief Find the shortcuts needed to contract a vertex.
+      /// \param[in] _v The vertex.
+      /// \param[out] _shortcuts The shortcuts.
+      void Shortcuts(const CSRIndex _v, std::vector<Shortcut> &_shortcuts)
+      {
+        _shortcuts.clear();
+        this->contracted[_v] = true;
+
+        double maxOut = 0.0;
+        for (const Arc &arc : this->out[_v])
+        {
+          if (!this->contracted[arc.vertex])
+            maxOut = std::max(maxOut, arc.weight);
+        }
+
+        for (const Arc &inArc : this->in[_v])
+        {
+          const CSRIndex u = inArc.vertex;
+          if (this->contracted[u])
+            continue;
+
+          // Look for paths from u that avoid _v and are no longer than
+          // the paths through _v.
+          this->Witness(u, inArc.weight + maxOut);
+          for (const Arc &outArc : this->out[_v])
+          {
+            const CSRIndex w = outArc.vertex;
+            const double cost = inArc.weight + outArc.weight;
+            if (w != u && !this->contracted[w] &&
+                this->witness.Cost(w) > cost)
+            {
+              _shortcuts.push_back({u, w, cost, _v});
+            }
+          }
+        }
+
+        this->contracted[_v] = false;
+      }
+
+      /// \brief Run a bounded Dijkstra search in the remaining graph.
+      /// \param[in] _from The starting vertex.
+      /// \param[in] _maxCost Cost above which the search stops.
+      void Witness(const CSRIndex _from, const double _maxCost)
+      {
+        this->witness.Reset(static_cast<CSRIndex>(this->out.size()));
+        this->witness.Push(_from, 0.0, _from);
+        for (std::size_t settled = 0;
+             !this->witness.QueueEmpty() && settled < kWitnessSettleLimit;
+             ++settled)
+        {
+          const CSRIndex u = this->witness.Pop();
+          const double uCost = this->witness.Cost(u);
+          if (uCost > _maxCost)
+            break;
+
+          for (const Arc &arc : this->out[u])
+          {
+            if (!this->contracted[arc.vertex])
+              this->witness.Push(arc.vertex, uCost + arc.weight, u);
+          }
+        }
+      }
+
+      /// \brief Get the priority of a vertex: twice the number of
+      /// shortcuts its contraction adds minus the number of arcs it
+      /// removes, plus the number of its neighbors that were already
+      /// contracted, which spreads the contraction evenly over the graph.
+      /// \param[in] _v The vertex.
+      /// \return The priority. Lower is contracted first.
+      int64_t Priority(const CSRIndex _v)
+      {
+        this->Shortcuts(_v, this->shortcuts);
+        int64_t removed = 0;
+        for (const auto *arcs : {&this->out[_v], &this->in[_v]})
+        {
+          for (const Arc &arc : *arcs)
+            removed += this->contracted[arc.vertex] ? 0 : 1;
+        }
+        return 2 * (static_cast<int64_t>(this->shortcuts.size()) - removed) +
+          this->deletedNeighbors[_v];
+      }
+
+      /// \brief Contract a vertex, adding its shortcuts.
+      /// \param[in] _v The vertex.
+      void Contract(const CSRIndex _v)
+      {
+        this->Shortcuts(_v, this->shortcuts);
+        for (const Shortcut &s : this->shortcuts)
+          this->AddArc(s.from, s.to, s.weight, s.middle);
+        this->contracted[_v] = true;
+
+        for (const auto *arcs : {&this->out[_v], &this->in[_v]})
+        {
+          for (const Arc &arc : *arcs)
+            ++this->deletedNeighbors[arc.vertex];
+        }
+      }
+
+      /// \brief Outgoing arcs of each vertex.
+      std::vector<std::vector<Arc>> out;
+
+      /// \brief Incoming arcs of each vertex, with the source vertex.
+      std::vector<std::vector<Arc>> in;
+
+      /// \brief Whether each vertex was contracted.
+      std::vector<bool> contracted;
+
+      /// \brief Number of contracted neighbors of each vertex.
+      std::vector<int64_t> deletedNeighbors;
+
+      /// \brief Memory of the witness searches.
+      SearchWorkspace witness;
+
+      /// \brief Shortcuts of the vertex being contracted.
+      std::vector<Shortcut> shortcuts;
+    };
+
+    /// \brief Get the middle vertex of an arc.
+    /// \param[in] _a Source vertex.
+    /// \param[in] _b Target vertex.
+    /// \return The middle vertex, or kNullIndex for an original arc.
+    private: CSRIndex Middle(const CSRIndex _a, const CSRIndex _b) const
+    {
+      if (this->ranks[_b] > this->ranks[_a])
+        return this->up.middles[this->up.Find(_a, _b)];
+      return this->down.middles[this->down.Find(_b, _a)];
+    }
+
+    /// \brief Settle every vertex that a search moving only up the
+    /// hierarchy reaches from a vertex, with stall on demand.
+    /// \param[in] _from Dense index of the starting vertex.
+    /// \param[in] _side 0 for a forward search, 1 for a backward search.
+    /// \param[in, out] _search Memory of the search, which holds the costs
+    /// afterwards.
+    /// \param[out] _settled Vertices settled and not stalled, which are
+    /// the only ones that can be on a shortest path.
+    private: void SearchUp(const CSRIndex _from, const int _side,
+                           SearchWorkspace &_search,
+                           std::vector<CSRIndex> &_settled) const
+    {
+      const Arcs &a = _side == 0 ? this->up : this->down;
+      const Arcs &b = _side == 0 ? this->down : this->up;
+      _settled.clear();
+      _search.Reset(this->VertexCount());
+      _search.Push(_from, 0.0, _from);
+      while (!_search.QueueEmpty())
+      {
+        const CSRIndex u = _search.Pop();
+        const double uCost = _search.Cost(u);
+
+        bool stalled = false;
+        for (CSRIndex arc = b.offsets[u];
+             arc < b.offsets[u + 1] && !stalled; ++arc)
+        {
+          stalled = _search.Cost(b.vertices[arc]) + b.weights[arc] < uCost;
+        }
+        if (stalled)
+          continue;
+
+        _settled.push_back(u);
+        for (CSRIndex arc = a.offsets[u]; arc < a.offsets[u + 1]; ++arc)
+          _search.Push(a.vertices[arc], uCost + a.weights[arc], u);
+      }
+    }
+
+    /// \brief Magic bytes at the start of a saved hierarchy.
+    private: static constexpr uint8_t kMagic[4] = {'G', 'Z', 'C', 'H'};
+
+    /// \brief Version of the saved format.
+    private: static constexpr uint64_t kVersion = 1;
+
+    /// \brief Maximum number of vertices settled by a witness search.
+    /// Lower values are faster to preprocess but add more shortcuts.
+    private: static constexpr std::size_t kWitnessSettleLimit = 500;
+
+    /// \brief Vertex Ids, sorted and indexed by dense index.
+    private: std::vector<VertexId> ids;
+
+    /// \brief Rank of each vertex.
+    private: std::vector<CSRIndex> ranks;
+
+    /// \brief Arcs to more important vertices, by source vertex.
+    private: Arcs up;
+
+    /// \brief Arcs from more important vertices, by target vertex.
+    private: Arcs down;
+  };
+}
+}
+}
+}
+#endif
@@ -17,15 +17,21 @@
 #ifndef GZ_MATH_GRAPH_GRAPH_HH_
 #define GZ_MATH_GRAPH_GRAPH_HH_
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <gz/math/config.hh>
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/Instrumentation.hh"
 #include "gz/math/graph/Edge.hh"
 #include "gz/math/graph/Vertex.hh"
 
@@ -44,6 +50,12 @@ namespace graph
   /// other vertices if needed. This class supports the use of different edge
   /// types (e.g. directed or undirected edges).
   ///
+  /// The graph keeps a hash table from names to the Ids of the vertices
+  /// that use them, so that looking vertices up by name does not scan the
+  /// graph. The vertices of a graph that have the same name share a single
+  /// copy of it. Rename the vertices of a graph with SetVertexName(), as
+  /// Vertex::SetName() does not update the table.
+  ///
   /// <b> Example directed graph</b>
   //
   /// \code{.cpp}
@@ -107,25 +119,155 @@ namespace graph
     /// \brief Constructor.
     /// \param[in] _vertices Collection of vertices.
     /// \param[in] _edges Collection of edges.
+    /// \sa Assign()
     public: Graph(const std::vector<Vertex<V>> &_vertices,
                   const std::vector<EdgeInitializer<E>> &_edges)
     {
-      // Add all vertices.
+      this->Assign(_vertices, _edges);
+    }
+
+    /// \brief Replace the contents of the graph with a collection of
+    /// vertices and edges. The result is the same as adding the vertices
+    /// and then the edges one by one to an empty graph, but the elements
+    /// are validated in one pass and the internal containers are filled in
+    /// order, which is much faster for large graphs.
+    ///
+    /// Vertices with the Id of a previous vertex are ignored. Vertices
+    /// without an Id get the lowest Id that is free at their position, as
+    /// with AddVertex(). Edges with a vertex that doesn't exist are
+    /// ignored, and the others get consecutive Ids from 0. A single
+    /// diagnostic reports the number of ignored elements.
+    /// \param[in] _vertices Collection of vertices. Their data is moved
+    /// into the graph.
+    /// \param[in] _edges Collection of edges. Their data is moved into the
+    /// graph.
+    /// \return True when every vertex and edge was added or false
+    /// otherwise.
+    public: bool Assign(std::vector<Vertex<V>> _vertices,
+                        std::vector<EdgeInitializer<E>> _edges)
+    {
+      this->vertices.clear();
+      this->edges.clear();
+      this->adjList.clear();
+      this->names.clear();
+      this->nextVertexId = 0u;
+      this->nextEdgeId = 0u;
+
+      // Choose the Id of every vertex, as a pair of the Id and the
+      // position of the vertex, sorted by Id.
+      bool anyAuto = false;
+      bool anyCustom = false;
       for (auto const &v : _vertices)
       {
-        if (!this->AddVertex(v.Name(), v.Data(), v.Id()).Valid())
+        anyAuto = anyAuto || v.Id() == kNullId;
+        anyCustom = anyCustom || v.Id() != kNullId;
+      }
+      std::vector<std::pair<VertexId, size_t>> ids;
+      ids.reserve(_vertices.size());
+      if (!anyAuto)
+      {
+        // The first vertex with a given Id wins.
+        for (size_t i = 0; i < _vertices.size(); ++i)
+          ids.emplace_back(_vertices[i].Id(), i);
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end(),
+          [](const auto &_a, const auto &_b)
+          {
+            return _a.first == _b.first;
+          }), ids.end());
+      }
+      else if (!anyCustom)
+      {
+        for (size_t i = 0; i < _vertices.size() && i < kNullId; ++i)
+          ids.emplace_back(i, i);
+        if (!ids.empty())
+          this->nextVertexId = ids.back().first;
+      }
+      else
+      {
+        // Replay the choices of AddVertex().
+        std::set<VertexId> used;
+        for (size_t i = 0; i < _vertices.size(); ++i)
+        {
+          VertexId id = _vertices[i].Id();
+          if (id == kNullId)
+          {
+            while (used.count(this->nextVertexId) &&
+                   this->nextVertexId < MAX_UI64)
+            {
+              ++this->nextVertexId;
+            }
+            id = this->nextVertexId;
+          }
+          if (id != kNullId && used.insert(id).second)
+            ids.emplace_back(id, i);
+        }
+        std::sort(ids.begin(), ids.end());
+      }
+
+      // Insert the vertices in order, which takes constant time each.
+      std::vector<EdgeId_S *> adjacent;
+      adjacent.reserve(ids.size());
+      for (auto const &[id, index] : ids)
+      {
+        Vertex<V> &v = _vertices[index];
+        auto nameIt = this->names.find(v.Name());
+        auto name = nameIt != this->names.end() ?
+          nameIt->second.name : v.SharedName();
+        auto vIt = this->vertices.emplace_hint(this->vertices.end(), id,
+          Vertex<V>(std::move(name), std::move(v.Data()), id));
+        this->IndexName(vIt->second);
+        adjacent.push_back(&this->adjList.emplace_hint(
+          this->adjList.end(), id, EdgeId_S())->second);
+      }
+
+      // Dense Ids, the usual case, are their own position.
+      const bool dense = ids.empty() || ids.back().first == ids.size() - 1;
+      auto position = [&](const VertexId _id) -> size_t
+      {
+        if (dense)
+          return _id < ids.size() ? _id : ids.size();
+        auto it = std::lower_bound(ids.begin(), ids.end(),
+          std::make_pair(_id, size_t(0)));
+        if (it == ids.end() || it->first != _id)
+          return ids.size();
+        return static_cast<size_t>(it - ids.begin());
+      };
+
+      // Edges get increasing Ids, so they are appended to every container.
+      size_t ignoredEdges = 0;
+      for (auto &e : _edges)
+      {
+        const size_t first = position(e.vertices.first);
+        const size_t second = position(e.vertices.second);
+        if (first == ids.size() || second == ids.size())
         {
-          std::cerr << "Invalid vertex with Id [" << v.Id() << "]. Ignoring."
-                    << std::endl;
+          ++ignoredEdges;
+          continue;
         }
+
+        const EdgeId id = this->edges.size();
+        this->edges.emplace_hint(this->edges.end(), id,
+          EdgeType(e.vertices, std::move(e.data), e.weight, id));
+        adjacent[first]->emplace_hint(adjacent[first]->end(), id);
+        adjacent[second]->emplace_hint(adjacent[second]->end(), id);
       }
+      if (!this->edges.empty())
+        this->nextEdgeId = this->edges.rbegin()->first;
 
-      // Add all edges.
-      for (auto const &e : _edges)
+      const size_t ignoredVertices = _vertices.size() - ids.size();
+      if (ignoredVertices > 0)
+      {
+        IGN_MATH_DIAGNOSTIC("[Graph::Assign()] Ignoring [" << ignoredVertices
+            << "] vertices with a repeated Id.");
+      }
+      if (ignoredEdges > 0)
       {
-        if (!this->AddEdge(e.vertices, e.data, e.weight).Valid())
-          std::cerr << "Ignoring edge" << std::endl;
+        IGN_MATH_DIAGNOSTIC("[Graph::Assign()] Ignoring [" << ignoredEdges
+            << "] edges with a vertex that doesn't exist.");
       }
+
+      return ignoredVertices == 0 && ignoredEdges == 0;
     }
 
     /// \brief Add a new vertex to the graph.
@@ -148,21 +290,22 @@ namespace graph
         // No space for new Ids.
         if (id == kNullId)
         {
-          std::cerr << "[Graph::AddVertex()] The limit of vertices has been "
-                    << "reached. Ignoring vertex." << std::endl;
+          IGN_MATH_DIAGNOSTIC(
+              "[Graph::AddVertex()] The limit of vertices has been "
+              << "reached. Ignoring vertex.");
           return Vertex<V>::NullVertex;
         }
       }
 
       // Create the vertex.
       auto ret = this->vertices.insert(
-        std::make_pair(id, Vertex<V>(_name, _data, id)));
+        std::make_pair(id, Vertex<V>(this->SharedName(_name), _data, id)));
 
       // The Id already exists.
       if (!ret.second)
       {
-        std::cerr << "[Graph::AddVertex()] Repeated vertex [" << id << "]"
-                  << std::endl;
+        IGN_MATH_DIAGNOSTIC(
+            "[Graph::AddVertex()] Repeated vertex [" << id << "]");
         return Vertex<V>::NullVertex;
       }
 
@@ -170,7 +313,7 @@ namespace graph
       this->adjList[id] = EdgeId_S();
 
       // Update the map of names.
-      this->names.insert(std::make_pair(_name, id));
+      this->IndexName(ret.first->second);
 
       return ret.first->second;
     }
@@ -184,6 +327,8 @@ namespace graph
       for (auto const &v : this->vertices)
         res.emplace(std::make_pair(v.first, std::cref(v.second)));
 
+      IGN_MATH_COUNT_ALLOCATIONS(GRAPH, res.size(),
+          res.size() * sizeof(typename VertexRef_M<V>::value_type));
       return res;
     }
 
@@ -193,15 +338,57 @@ namespace graph
     public: const VertexRef_M<V> Vertices(const std::string &_name) const
     {
       VertexRef_M<V> res;
-      for (auto const &vertex : this->vertices)
+      auto iter = this->names.find(_name);
+      if (iter == this->names.end())
+        return res;
+
+      // Skip the vertices renamed with Vertex::SetName().
+      for (auto const &id : iter->second.ids)
       {
-        if (vertex.second.Name() == _name)
-          res.emplace(std::make_pair(vertex.first, std::cref(vertex.second)));
+        auto vIt = this->vertices.find(id);
+        if (vIt != this->vertices.end() && vIt->second.Name() == _name)
+          res.emplace_hint(res.end(), id, std::cref(vIt->second));
       }
 
+      IGN_MATH_COUNT_ALLOCATIONS(GRAPH, res.size(),
+          res.size() * sizeof(typename VertexRef_M<V>::value_type));
       return res;
     }
 
+    /// \brief Rename a vertex.
+    /// \param[in] _id Id of the vertex.
+    /// \param[in] _name New name of the vertex.
+    /// \return True when the vertex was renamed or false if it doesn't
+    /// exist.
+    public: bool SetVertexName(const VertexId &_id, const std::string &_name)
+    {
+      auto iter = this->vertices.find(_id);
+      if (iter == this->vertices.end())
+        return false;
+
+      this->UnindexName(iter->second);
+      iter->second.SetName(this->SharedName(_name));
+      this->IndexName(iter->second);
+      return true;
+    }
+
+    /// \brief Change the weight of an edge. Algorithms that keep results
+    /// across changes, such as IncrementalShortestPath, must be told
+    /// about the edge.
+    /// \param[in] _id Id of the edge.
+    /// \param[in] _weight New weight of the edge.
+    /// \return True when the weight was changed or false if the edge
+    /// doesn't exist.
+    public: bool SetEdgeWeight(const EdgeId &_id, const double _weight)
+    {
+      auto iter = this->edges.find(_id);
+      if (iter == this->edges.end())
+        return false;
+
+      iter->second.SetWeight(_weight);
+      return true;
+    }
+
     /// \brief Add a new edge to the graph.
     /// \param[in] _vertices The set of Ids of the two vertices.
     /// \param[in] _data User data.
@@ -217,8 +404,9 @@ namespace graph
       // No space for new Ids.
       if (id == kNullId)
       {
-        std::cerr << "[Graph::AddEdge()] The limit of edges has been reached. "
-                  << "Ignoring edge." << std::endl;
+        IGN_MATH_DIAGNOSTIC(
+            "[Graph::AddEdge()] The limit of edges has been reached. "
+            << "Ignoring edge.");
         return EdgeType::NullEdge;
       }
 
@@ -271,6 +459,8 @@ namespace graph
         res.emplace(std::make_pair(edge.first, std::cref(edge.second)));
       }
 
+      IGN_MATH_COUNT_ALLOCATIONS(GRAPH, res.size(),
+          res.size() * sizeof(typename EdgeRef_M<EdgeType>::value_type));
       return res;
     }
 
@@ -310,6 +500,8 @@ namespace graph
         }
       }
 
+      IGN_MATH_COUNT_ALLOCATIONS(GRAPH, res.size(),
+          res.size() * sizeof(typename VertexRef_M<V>::value_type));
       return res;
     }
 
@@ -363,6 +555,8 @@ namespace graph
             std::make_pair(neighborVertexId, std::cref(neighborVertex)));
       }
 
+      IGN_MATH_COUNT_ALLOCATIONS(GRAPH, res.size(),
+          res.size() * sizeof(typename VertexRef_M<V>::value_type));
       return res;
     }
 
@@ -440,6 +634,8 @@ namespace graph
           res.emplace(std::make_pair(edge.Id(), std::cref(edge)));
       }
 
+      IGN_MATH_COUNT_ALLOCATIONS(GRAPH, res.size(),
+          res.size() * sizeof(typename EdgeRef_M<EdgeType>::value_type));
       return res;
     }
 
@@ -476,6 +672,8 @@ namespace graph
           res.emplace(std::make_pair(edge.Id(), std::cref(edge)));
       }
 
+      IGN_MATH_COUNT_ALLOCATIONS(GRAPH, res.size(),
+          res.size() * sizeof(typename EdgeRef_M<EdgeType>::value_type));
       return res;
     }
 
@@ -490,6 +688,107 @@ namespace graph
       return this->IncidentsTo(_vertex.Id());
     }
 
+    /// \brief Call a function for every outgoing edge of a vertex. Unlike
+    /// IncidentsFrom(), no container is created: the adjacency set of the
+    /// vertex is walked in place, by ascending edge Id.
+    /// The graph must not be modified from within the function.
+    /// \param[in] _vertex Id of the vertex.
+    /// \param[in] _fn Function called with a const reference to each
+    /// outgoing edge. Nothing is called when the vertex does not exist.
+    public: template<typename F>
+    void ForEachIncidentFrom(const VertexId &_vertex, F &&_fn) const
+    {
+      const auto &adjIt = this->adjList.find(_vertex);
+      if (adjIt == this->adjList.end())
+        return;
+
+      for (auto const &edgeId : adjIt->second)
+      {
+        const auto &edge = this->EdgeFromId(edgeId);
+        if (edge.From(_vertex) != kNullId)
+          _fn(edge);
+      }
+    }
+
+    /// \brief Call a function for every incoming edge of a vertex. Unlike
+    /// IncidentsTo(), no container is created: the adjacency set of the
+    /// vertex is walked in place, by ascending edge Id.
+    /// The graph must not be modified from within the function.
+    /// \param[in] _vertex Id of the vertex.
+    /// \param[in] _fn Function called with a const reference to each
+    /// incoming edge. Nothing is called when the vertex does not exist.
+    public: template<typename F>
+    void ForEachIncidentTo(const VertexId &_vertex, F &&_fn) const
+    {
+      const auto &adjIt = this->adjList.find(_vertex);
+      if (adjIt == this->adjList.end())
+        return;
+
+      for (auto const &edgeId : adjIt->second)
+      {
+        const auto &edge = this->EdgeFromId(edgeId);
+        if (edge.To(_vertex) != kNullId)
+          _fn(edge);
+      }
+    }
+
+    /// \brief Call a function for every vertex adjacent from a given
+    /// vertex (see AdjacentsFrom()). Unlike AdjacentsFrom(), no container
+    /// is created and a neighbor is visited once per connecting edge, in
+    /// ascending edge Id order.
+    /// The graph must not be modified from within the function.
+    /// \param[in] _vertex Id of the vertex.
+    /// \param[in] _fn Function called with a const reference to each
+    /// neighbor vertex and to the edge that connects it.
+    public: template<typename F>
+    void ForEachAdjacentFrom(const VertexId &_vertex, F &&_fn) const
+    {
+      this->ForEachIncidentFrom(_vertex, [&](const EdgeType &_edge)
+      {
+        _fn(this->VertexFromId(_edge.From(_vertex)), _edge);
+      });
+    }
+
+    /// \brief Call a function for every vertex adjacent to a given vertex
+    /// (see AdjacentsTo()). Unlike AdjacentsTo(), no container is created
+    /// and a neighbor is visited once per connecting edge, in ascending
+    /// edge Id order.
+    /// The graph must not be modified from within the function.
+    /// \param[in] _vertex Id of the vertex.
+    /// \param[in] _fn Function called with a const reference to each
+    /// neighbor vertex and to the edge that connects it.
+    public: template<typename F>
+    void ForEachAdjacentTo(const VertexId &_vertex, F &&_fn) const
+    {
+      this->ForEachIncidentTo(_vertex, [&](const EdgeType &_edge)
+      {
+        _fn(this->VertexFromId(_edge.To(_vertex)), _edge);
+      });
+    }
+
+    /// \brief Call a function for every vertex of the graph, by ascending
+    /// Id. Unlike Vertices(), no container is created.
+    /// The graph must not be modified from within the function.
+    /// \param[in] _fn Function called with a const reference to each
+    /// vertex.
+    public: template<typename F>
+    void ForEachVertex(F &&_fn) const
+    {
+      for (auto const &v : this->vertices)
+        _fn(v.second);
+    }
+
+    /// \brief Call a function for every edge of the graph, by ascending
+    /// Id. Unlike Edges(), no container is created.
+    /// The graph must not be modified from within the function.
+    /// \param[in] _fn Function called with a const reference to each edge.
+    public: template<typename F>
+    void ForEachEdge(F &&_fn) const
+    {
+      for (auto const &edge : this->edges)
+        _fn(edge.second);
+    }
+
     /// \brief Get whether the graph is empty.
     /// \return True when there are no vertices in the graph or
     /// false otherwise.
@@ -507,8 +806,6 @@ namespace graph
       if (vIt == this->vertices.end())
         return false;
 
-      std::string name = vIt->second.Name();
-
       // Remove incident edges.
       auto incidents = this->IncidentsTo(_vertex);
       for (auto edgePair : incidents)
@@ -522,19 +819,11 @@ namespace graph
       // Remove the vertex (key) from the adjacency list.
       this->adjList.erase(_vertex);
 
-      // Remove the vertex.
-      this->vertices.erase(_vertex);
+      // Remove the vertex from the map of names.
+      this->UnindexName(vIt->second);
 
-      // Get an iterator to all vertices sharing name.
-      auto iterPair = this->names.equal_range(name);
-      for (auto it = iterPair.first; it != iterPair.second; ++it)
-      {
-        if (it->second == _vertex)
-        {
-          this->names.erase(it);
-          break;
-        }
-      }
+      // Remove the vertex.
+      this->vertices.erase(vIt);
 
       return true;
     }
@@ -552,12 +841,12 @@ namespace graph
     /// \return The number of vertices removed.
     public: size_t RemoveVertices(const std::string &_name)
     {
-      size_t numVertices = this->names.count(_name);
+      // Ids are collected first, as the entry of the name goes away with
+      // its last vertex.
       size_t result = 0;
-      for (size_t i = 0; i < numVertices; ++i)
+      for (auto const &vertex : this->Vertices(_name))
       {
-        auto iter = this->names.find(_name);
-        if (this->RemoveVertex(iter->second))
+        if (this->RemoveVertex(vertex.first))
           ++result;
       }
 
@@ -703,6 +992,52 @@ namespace graph
       return this->nextVertexId;
     }
 
+    /// \brief Get the shared copy of a name used by the vertices.
+    /// \param[in] _name The name.
+    /// \return The copy of the name used by the vertices, or a new copy if
+    /// no vertex uses it.
+    private: std::shared_ptr<const std::string> SharedName(
+                 const std::string &_name) const
+    {
+      auto iter = this->names.find(_name);
+      if (iter != this->names.end())
+        return iter->second.name;
+
+      return std::make_shared<const std::string>(_name);
+    }
+
+    /// \brief Add a vertex to the map of names.
+    /// \param[in] _vertex The vertex, whose name is shared from now on.
+    private: void IndexName(const Vertex<V> &_vertex)
+    {
+      const auto &name = _vertex.SharedName();
+      auto &entry =
+        this->names.try_emplace(std::string_view(*name)).first->second;
+      if (!entry.name)
+        entry.name = name;
+
+      // Ids are kept sorted, and new vertices usually have the largest one.
+      auto pos = std::lower_bound(entry.ids.begin(), entry.ids.end(),
+                                  _vertex.Id());
+      entry.ids.insert(pos, _vertex.Id());
+    }
+
+    /// \brief Remove a vertex from the map of names.
+    /// \param[in] _vertex The vertex.
+    private: void UnindexName(const Vertex<V> &_vertex)
+    {
+      auto iter = this->names.find(_vertex.Name());
+      if (iter == this->names.end())
+        return;
+
+      auto &ids = iter->second.ids;
+      auto pos = std::lower_bound(ids.begin(), ids.end(), _vertex.Id());
+      if (pos != ids.end() && *pos == _vertex.Id())
+        ids.erase(pos);
+      if (ids.empty())
+        this->names.erase(iter);
+    }
+
     /// \brief Get an available Id to be assigned to a new edge.
     /// \return The next available Id or kNullId if there aren't ids available.
     private: VertexId &NextEdgeId()
@@ -735,8 +1070,19 @@ namespace graph
     /// another vertex via (e).
     private: std::map<VertexId, EdgeId_S> adjList;
 
-    /// \brief Association between names and vertices curently used.
-    private: std::multimap<std::string, VertexId> names;
+    /// \brief The vertices that share a name.
+    private: struct NamedVertices
+    {
+      /// \brief The copy of the name shared by the vertices.
+      std::shared_ptr<const std::string> name;
+
+      /// \brief Sorted Ids of the vertices.
+      std::vector<VertexId> ids;
+    };
+
+    /// \brief Association between names and vertices curently used. The
+    /// keys view the shared copy of the name held by each entry.
+    private: std::unordered_map<std::string_view, NamedVertices> names;
   };
 
   /////////////////////////////////////////////////
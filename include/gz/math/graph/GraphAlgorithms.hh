@@ -17,17 +17,30 @@
 #ifndef GZ_MATH_GRAPH_GRAPHALGORITHMS_HH_
 #define GZ_MATH_GRAPH_GRAPHALGORITHMS_HH_
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
 #include <functional>
-#include <list>
 #include <map>
+#include <numeric>
 #include <queue>
-#include <stack>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include <gz/math/config.hh>
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/graph/CSRGraph.hh"
+#include "gz/math/graph/CSRGraphView.hh"
 #include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/SearchStats.hh"
+#include "gz/math/graph/SearchWorkspace.hh"
+#include "gz/math/graph/SubgraphView.hh"
 #include "gz/math/Helpers.hh"
+#include "gz/math/Trace.hh"
 
 namespace ignition
 {
@@ -42,6 +55,12 @@ namespace graph
   /// the cost (first element) to reach a destination vertex (second element).
   using CostInfo = std::pair<double, VertexId>;
 
+  /// \typedef PathInfo.
+  /// \brief Used in point-to-point searches such as AStar. The first element
+  /// is the cost of the path and the second element is the sequence of
+  /// vertices from the source to the destination vertex.
+  using PathInfo = std::pair<double, std::vector<VertexId>>;
+
   /// \brief Breadth first sort (BFS).
   /// Starting from the vertex == _from, it traverses the graph exploring the
   /// neighbors first, before moving to the next level neighbors.
@@ -52,42 +71,34 @@ namespace graph
   std::vector<VertexId> BreadthFirstSort(const Graph<V, E, EdgeType> &_graph,
                                          const VertexId &_from)
   {
-    // Create an auxiliary graph, where the data is just a boolean value that
-    // stores whether the vertex has been visited or not.
-    Graph<bool, E, EdgeType> visitorGraph;
-
-    // Copy the vertices (just the Id).
-    for (auto const &v : _graph.Vertices())
-      visitorGraph.AddVertex("", false, v.first);
-
-    // Copy the edges (without data).
-    for (auto const &e : _graph.Edges())
-      visitorGraph.AddEdge(e.second.get().Vertices(), E());
-
     std::vector<VertexId> visited;
-    std::list<VertexId> pending = {_from};
+    if (!_graph.VertexFromId(_from).Valid())
+      return visited;
 
-    while (!pending.empty())
-    {
-      auto vId = pending.front();
-      pending.pop_front();
+    std::unordered_set<VertexId> seen = {_from};
+    std::vector<VertexId> pending = {_from};
 
-      // If the vertex has been visited, skip.
-      auto &vertex = visitorGraph.VertexFromId(vId);
-      if (vertex.Data())
-        continue;
+    // Neighbors of the current vertex, reused across iterations.
+    std::vector<VertexId> adjacents;
 
+    for (std::size_t head = 0; head < pending.size(); ++head)
+    {
+      const VertexId vId = pending[head];
       visited.push_back(vId);
-      vertex.Data() = true;
 
       // Add more vertices to visit if they haven't been visited yet.
-      auto adjacents = visitorGraph.AdjacentsFrom(vId);
+      // Neighbors are expanded by ascending Id, like AdjacentsFrom().
+      adjacents.clear();
+      _graph.ForEachIncidentFrom(vId, [&](const EdgeType &_edge)
+      {
+        adjacents.push_back(_edge.From(vId));
+      });
+      std::sort(adjacents.begin(), adjacents.end());
+
       for (auto const &adj : adjacents)
       {
-        vId = adj.first;
-        auto &v = adj.second.get();
-        if (!v.Data())
-          pending.push_back(vId);
+        if (seen.insert(adj).second)
+          pending.push_back(adj);
       }
     }
 
@@ -104,42 +115,40 @@ namespace graph
   std::vector<VertexId> DepthFirstSort(const Graph<V, E, EdgeType> &_graph,
                                        const VertexId &_from)
   {
-    // Create an auxiliary graph, where the data is just a boolean value that
-    // stores whether the vertex has been visited or not.
-    Graph<bool, E, EdgeType> visitorGraph;
-
-    // Copy the vertices (just the Id).
-    for (auto const &v : _graph.Vertices())
-      visitorGraph.AddVertex("", false, v.first);
+    std::vector<VertexId> visited;
+    if (!_graph.VertexFromId(_from).Valid())
+      return visited;
 
-    // Copy the edges (without data).
-    for (auto const &e : _graph.Edges())
-      visitorGraph.AddEdge(e.second.get().Vertices(), E());
+    std::unordered_set<VertexId> seen;
+    std::vector<VertexId> pending = {_from};
 
-    std::vector<VertexId> visited;
-    std::stack<VertexId> pending({_from});
+    // Neighbors of the current vertex, reused across iterations.
+    std::vector<VertexId> adjacents;
 
     while (!pending.empty())
     {
-      auto vId = pending.top();
-      pending.pop();
+      const VertexId vId = pending.back();
+      pending.pop_back();
 
       // If the vertex has been visited, skip.
-      auto &vertex = visitorGraph.VertexFromId(vId);
-      if (vertex.Data())
+      if (!seen.insert(vId).second)
         continue;
 
       visited.push_back(vId);
-      vertex.Data() = true;
 
       // Add more vertices to visit if they haven't been visited yet.
-      auto adjacents = visitorGraph.AdjacentsFrom(vId);
+      // Neighbors are pushed by ascending Id, like AdjacentsFrom().
+      adjacents.clear();
+      _graph.ForEachIncidentFrom(vId, [&](const EdgeType &_edge)
+      {
+        adjacents.push_back(_edge.From(vId));
+      });
+      std::sort(adjacents.begin(), adjacents.end());
+
       for (auto const &adj : adjacents)
       {
-        vId = adj.first;
-        auto &v = adj.second.get();
-        if (!v.Data())
-          pending.push(vId);
+        if (seen.find(adj) == seen.end())
+          pending.push_back(adj);
       }
     }
 
@@ -214,12 +223,13 @@ namespace graph
                                         const VertexId &_from,
                                         const VertexId &_to = kNullId)
   {
+    IGN_MATH_TRACE_ZONE("Dijkstra");
     auto allVertices = _graph.Vertices();
 
     // Sanity check: The source vertex should exist.
     if (allVertices.find(_from) == allVertices.end())
     {
-      std::cerr << "Vertex [" << _from << "] Not found" << std::endl;
+      IGN_MATH_DIAGNOSTIC("Vertex [" << _from << "] Not found");
       return {};
     }
 
@@ -227,7 +237,7 @@ namespace graph
     if (_to != kNullId &&
         allVertices.find(_to) == allVertices.end())
     {
-      std::cerr << "Vertex [" << _from << "] Not found" << std::endl;
+      IGN_MATH_DIAGNOSTIC("Vertex [" << _from << "] Not found");
       return {};
     }
 
@@ -251,7 +261,8 @@ namespace graph
     while (!pq.empty())
     {
       // This is the minimum distance vertex.
-      VertexId u = pq.top().second;
+      const CostInfo top = pq.top();
+      const VertexId u = top.second;
 
       // Shortcut: Destination vertex found, exiting.
       if (_to != kNullId && _to == u)
@@ -259,30 +270,366 @@ namespace graph
 
       pq.pop();
 
-      for (auto const &edgePair : _graph.IncidentsFrom(u))
+      // Skip stale queue entries.
+      const double uCost = dist[u].first;
+      if (top.first > uCost)
+        continue;
+
+      _graph.ForEachIncidentFrom(u, [&](const EdgeType &_edge)
       {
-        const auto &edge = edgePair.second.get();
-        const auto &v = edge.From(u);
-        double weight = edge.Weight();
+        const VertexId v = _edge.From(u);
+        const double cost = uCost + _edge.Weight();
 
         //  If there is shorted path to v through u.
-        if (dist[v].first > dist[u].first + weight)
+        auto &vCost = dist[v];
+        if (vCost.first > cost)
         {
           // Updating distance of v.
-          dist[v] = std::make_pair(dist[u].first + weight, u);
-          pq.push(std::make_pair(dist[v].first, v));
+          vCost = std::make_pair(cost, u);
+          pq.push(std::make_pair(cost, v));
         }
-      }
+      });
     }
 
     return dist;
   }
 
+  namespace detail
+  {
+    /// \brief A* search that reports its work to a statistics sink.
+    /// \param[in] _graph A graph.
+    /// \param[in] _from The starting vertex.
+    /// \param[in] _to The destination vertex.
+    /// \param[in] _heuristic Estimated cost to the destination.
+    /// \param[in, out] _stats Statistics sink.
+    /// \return The cost and the vertices of the shortest path.
+    template<typename V, typename E, typename EdgeType, typename H,
+             typename Stats>
+    PathInfo AStar(const Graph<V, E, EdgeType> &_graph,
+                   const VertexId &_from,
+                   const VertexId &_to,
+                   H &&_heuristic,
+                   Stats &_stats)
+    {
+      IGN_MATH_TRACE_ZONE("AStar");
+      PathInfo res(MAX_D, {});
+
+      // Sanity check: The source and destination vertices should exist.
+      for (auto const &id : {_from, _to})
+      {
+        if (!_graph.VertexFromId(id).Valid())
+        {
+          IGN_MATH_DIAGNOSTIC("Vertex [" << id << "] Not found");
+          return res;
+        }
+      }
+
+      // Queue entry: estimated total cost, cost from the source, vertex.
+      using QueueEntry = std::pair<double, CostInfo>;
+      std::priority_queue<QueueEntry,
+        std::vector<QueueEntry>, std::greater<QueueEntry>> pq;
+
+      // Best known cost from the source and previous vertex in the path.
+      std::unordered_map<VertexId, CostInfo> dist;
+      dist[_from] = std::make_pair(0.0, _from);
+      pq.push(std::make_pair(_heuristic(_from), std::make_pair(0.0, _from)));
+      _stats.OnSearch();
+      _stats.OnPush(pq.size());
+
+      while (!pq.empty())
+      {
+        const double uCost = pq.top().second.first;
+        const VertexId u = pq.top().second.second;
+        pq.pop();
+
+        // Skip stale queue entries.
+        if (uCost > dist[u].first)
+          continue;
+
+        // Destination vertex settled, build the path.
+        if (u == _to)
+        {
+          res.first = uCost;
+          for (VertexId v = _to; v != _from; v = dist[v].second)
+            res.second.push_back(v);
+          res.second.push_back(_from);
+          std::reverse(res.second.begin(), res.second.end());
+          break;
+        }
+
+        _stats.OnExpand();
+        _graph.ForEachIncidentFrom(u, [&](const EdgeType &_edge)
+        {
+          _stats.OnRelax();
+          const VertexId v = _edge.From(u);
+          const double cost = uCost + _edge.Weight();
+
+          auto vIt = dist.find(v);
+          if (vIt == dist.end() || vIt->second.first > cost)
+          {
+            dist[v] = std::make_pair(cost, u);
+            pq.push(std::make_pair(cost + _heuristic(v),
+                                   std::make_pair(cost, v)));
+            _stats.OnPush(pq.size());
+          }
+        });
+      }
+
+      return res;
+    }
+  }
+
+  /// \brief A* search.
+  /// Find the shortest path between two vertices, expanding vertices in
+  /// order of their cost from the source plus an estimate of their cost to
+  /// the destination. The search stops as soon as the destination vertex
+  /// is settled, and only the vertices that were reached are stored, so
+  /// a good heuristic explores a small part of the graph.
+  ///
+  /// The heuristic must never overestimate the true cost to the destination
+  /// (admissible) for the returned path to be the shortest one. A heuristic
+  /// that always returns 0 makes this equivalent to Dijkstra().
+  ///
+  /// <b>Example</b>
+  /// \code{.cpp}
+  /// // Vertex data holds the position of the vertex.
+  /// gz::math::graph::UndirectedGraph<gz::math::Vector2d, double> graph(...);
+  /// auto goal = graph.VertexFromId(to).Data();
+  /// auto path = gz::math::graph::AStar(graph, from, to,
+  ///   [&](const gz::math::graph::VertexId &_id)
+  ///   {
+  ///     return graph.VertexFromId(_id).Data().Distance(goal);
+  ///   });
+  /// \endcode
+  /// \param[in] _graph A graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _to The destination vertex.
+  /// \param[in] _heuristic Callable with signature
+  /// double(const VertexId &) returning the estimated cost from a vertex to
+  /// the destination vertex.
+  /// \return The cost and the vertices of the shortest path, including
+  /// _from and _to. If the destination cannot be reached or one of the
+  /// vertices doesn't exist, the cost is MAX_D and the path is empty.
+  template<typename V, typename E, typename EdgeType, typename H>
+  PathInfo AStar(const Graph<V, E, EdgeType> &_graph,
+                 const VertexId &_from,
+                 const VertexId &_to,
+                 H &&_heuristic)
+  {
+    detail::NoSearchStats stats;
+    return detail::AStar(_graph, _from, _to, std::forward<H>(_heuristic),
+                         stats);
+  }
+
+  /// \brief A* search that also counts its work. Comparing the expanded
+  /// vertices with and without a heuristic measures how well it guides
+  /// the search. Stale queue entries are neither expanded nor counted.
+  /// \sa AStar()
+  /// \param[in] _graph A graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _to The destination vertex.
+  /// \param[in] _heuristic Callable with signature
+  /// double(const VertexId &) returning the estimated cost from a vertex to
+  /// the destination vertex.
+  /// \param[in, out] _stats Counters the work of the search is added to.
+  /// \return The cost and the vertices of the shortest path.
+  template<typename V, typename E, typename EdgeType, typename H>
+  PathInfo AStar(const Graph<V, E, EdgeType> &_graph,
+                 const VertexId &_from,
+                 const VertexId &_to,
+                 H &&_heuristic,
+                 SearchStats &_stats)
+  {
+    return detail::AStar(_graph, _from, _to, std::forward<H>(_heuristic),
+                         _stats);
+  }
+
+  /// \brief Bidirectional Dijkstra algorithm.
+  /// Find the shortest path between two vertices by running two Dijkstra
+  /// searches at the same time: one forward from the source vertex over the
+  /// outgoing edges and one backward from the destination vertex over the
+  /// incoming edges. The search stops as soon as no path through the
+  /// unexplored part of the graph can be shorter than the best path found
+  /// so far, which is usually much earlier than a single-source search
+  /// reaching the destination.
+  /// \param[in] _graph A graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _to The destination vertex.
+  /// \return The cost and the vertices of the shortest path, including
+  /// _from and _to. If the destination cannot be reached or one of the
+  /// vertices doesn't exist, the cost is MAX_D and the path is empty.
+  template<typename V, typename E, typename EdgeType>
+  PathInfo BidirectionalDijkstra(const Graph<V, E, EdgeType> &_graph,
+                                 const VertexId &_from,
+                                 const VertexId &_to)
+  {
+    IGN_MATH_TRACE_ZONE("BidirectionalDijkstra");
+    PathInfo res(MAX_D, {});
+
+    // Sanity check: The source and destination vertices should exist.
+    for (auto const &id : {_from, _to})
+    {
+      if (!_graph.VertexFromId(id).Valid())
+      {
+        IGN_MATH_DIAGNOSTIC("Vertex [" << id << "] Not found");
+        return res;
+      }
+    }
+
+    using Queue = std::priority_queue<CostInfo,
+      std::vector<CostInfo>, std::greater<CostInfo>>;
+
+    // Index 0 is the forward search and index 1 the backward search.
+    Queue pq[2];
+    std::unordered_map<VertexId, CostInfo> dist[2];
+
+    pq[0].push(std::make_pair(0.0, _from));
+    dist[0][_from] = std::make_pair(0.0, _from);
+    pq[1].push(std::make_pair(0.0, _to));
+    dist[1][_to] = std::make_pair(0.0, _to);
+
+    // Best path found so far and the vertex where both searches meet.
+    double best = _from == _to ? 0.0 : MAX_D;
+    VertexId meeting = _from == _to ? _from : kNullId;
+
+    while (!pq[0].empty() && !pq[1].empty())
+    {
+      // Stop when no unexplored path can improve the best one.
+      if (pq[0].top().first + pq[1].top().first >= best)
+        break;
+
+      // Expand the search with the smaller frontier.
+      const int side = pq[0].size() <= pq[1].size() ? 0 : 1;
+      auto &mine = dist[side];
+      const auto &other = dist[1 - side];
+
+      const double uCost = pq[side].top().first;
+      const VertexId u = pq[side].top().second;
+      pq[side].pop();
+
+      // Skip stale queue entries.
+      if (uCost > mine[u].first)
+        continue;
+
+      auto relax = [&](const VertexId _v, const double _weight)
+      {
+        const double cost = uCost + _weight;
+        auto vIt = mine.find(_v);
+        if (vIt == mine.end() || vIt->second.first > cost)
+        {
+          mine[_v] = std::make_pair(cost, u);
+          pq[side].push(std::make_pair(cost, _v));
+
+          // Check whether the searches meet at _v with a shorter path.
+          auto oIt = other.find(_v);
+          if (oIt != other.end() && cost + oIt->second.first < best)
+          {
+            best = cost + oIt->second.first;
+            meeting = _v;
+          }
+        }
+      };
+
+      if (side == 0)
+      {
+        _graph.ForEachIncidentFrom(u, [&](const EdgeType &_edge)
+        {
+          relax(_edge.From(u), _edge.Weight());
+        });
+      }
+      else
+      {
+        _graph.ForEachIncidentTo(u, [&](const EdgeType &_edge)
+        {
+          relax(_edge.To(u), _edge.Weight());
+        });
+      }
+    }
+
+    if (meeting == kNullId)
+      return res;
+
+    // Build the path: source to meeting vertex, then meeting vertex to
+    // destination.
+    res.first = best;
+    for (VertexId v = meeting; v != _from; v = dist[0][v].second)
+      res.second.push_back(v);
+    res.second.push_back(_from);
+    std::reverse(res.second.begin(), res.second.end());
+    for (VertexId v = meeting; v != _to;)
+    {
+      v = dist[1][v].second;
+      res.second.push_back(v);
+    }
+
+    return res;
+  }
+
+  namespace detail
+  {
+    /// \brief Label the weakly connected components of a graph with a
+    /// union-find forest over the vertex positions in Id order. The root
+    /// of each set is its smallest position, so the components are
+    /// numbered in the order of their smallest vertex Id.
+    /// \param[in] _graph A graph.
+    /// \param[out] _ids Ids of the vertices, in ascending order.
+    /// \param[out] _labels Component of each vertex of _ids.
+    /// \return The number of components.
+    template<typename V, typename E, typename EdgeType>
+    unsigned int ComponentLabels(const Graph<V, E, EdgeType> &_graph,
+                                 std::vector<VertexId> &_ids,
+                                 std::vector<unsigned int> &_labels)
+    {
+      IGN_MATH_TRACE_ZONE("ConnectedComponents");
+      _ids.clear();
+      _graph.ForEachVertex([&_ids](const Vertex<V> &_v)
+      {
+        _ids.push_back(_v.Id());
+      });
+
+      std::vector<std::size_t> parent(_ids.size());
+      std::iota(parent.begin(), parent.end(), 0);
+      auto find = [&parent](std::size_t _u)
+      {
+        while (parent[_u] != _u)
+        {
+          parent[_u] = parent[parent[_u]];
+          _u = parent[_u];
+        }
+        return _u;
+      };
+
+      _graph.ForEachEdge([&](const EdgeType &_edge)
+      {
+        const VertexId_P vertices = _edge.Vertices();
+        std::size_t u = find(static_cast<std::size_t>(std::lower_bound(
+            _ids.begin(), _ids.end(), vertices.first) - _ids.begin()));
+        std::size_t v = find(static_cast<std::size_t>(std::lower_bound(
+            _ids.begin(), _ids.end(), vertices.second) - _ids.begin()));
+        if (u != v)
+          parent[std::max(u, v)] = std::min(u, v);
+      });
+
+      // Roots come before the other vertices of their set.
+      unsigned int count = 0;
+      _labels.resize(_ids.size());
+      for (std::size_t i = 0; i < _ids.size(); ++i)
+      {
+        const std::size_t root = find(i);
+        _labels[i] = root == i ? count++ : _labels[root];
+      }
+      return count;
+    }
+  }
+
   /// \brief Calculate the connected components of an undirected graph.
   /// A connected component of an undirected graph is a subgraph in which any
   /// two vertices are connected to each other by paths, and which is connected
   /// to no additional vertices in the supergraph.
   /// \sa https://en.wikipedia.org/wiki/Connected_component_(graph_theory)
+  /// \sa ConnectedComponentViews() and
+  /// ConnectedComponents(const Graph &, std::map &), which don't copy the
+  /// graph.
   /// \param[in] _graph A graph.
   /// \return A vector of graphs. Each element of the graph is a component
   /// (subgraph) of the original graph.
@@ -290,44 +637,101 @@ namespace graph
   std::vector<UndirectedGraph<V, E>> ConnectedComponents(
     const UndirectedGraph<V, E> &_graph)
   {
-    std::map<VertexId, unsigned int> visited;
-    unsigned int componentCount = 0;
-
-    for (auto const &v : _graph.Vertices())
-    {
-      if (visited.find(v.first) == visited.end())
-      {
-        auto component = BreadthFirstSort(_graph, v.first);
-        for (auto const &vId : component)
-          visited[vId] = componentCount;
-        ++componentCount;
-      }
-    }
+    std::vector<VertexId> ids;
+    std::vector<unsigned int> labels;
+    const unsigned int componentCount =
+      detail::ComponentLabels(_graph, ids, labels);
 
     std::vector<UndirectedGraph<V, E>> res(componentCount);
 
     // Create the vertices.
-    for (auto const &vPair : _graph.Vertices())
+    std::size_t i = 0;
+    _graph.ForEachVertex([&](const Vertex<V> &_v)
     {
-      const auto &v = vPair.second.get();
-      const auto &componentId = visited[v.Id()];
-      res[componentId].AddVertex(v.Name(), v.Data(), v.Id());
-    }
+      res[labels[i++]].AddVertex(_v.Name(), _v.Data(), _v.Id());
+    });
 
     // Create the edges.
-    for (auto const &ePair : _graph.Edges())
+    _graph.ForEachEdge([&](const UndirectedEdge<E> &_e)
     {
-      const auto &e = ePair.second.get();
-      const auto &vertices = e.Vertices();
-      const auto &componentId = visited[vertices.first];
-      res[componentId].AddEdge(vertices, e.Data(), e.Weight());
-    }
+      const auto &vertices = _e.Vertices();
+      const auto it = std::lower_bound(ids.begin(), ids.end(),
+                                       vertices.first);
+      res[labels[it - ids.begin()]].AddEdge(vertices, _e.Data(),
+                                             _e.Weight());
+    });
+
+    return res;
+  }
+
+  /// \brief Label the connected components of a graph, without copying
+  /// it. Edge directions are ignored, so the components of a directed
+  /// graph are its weakly connected components, as with
+  /// ConnectedComponents(ToUndirectedGraph(_graph)).
+  /// \param[in] _graph A graph.
+  /// \param[out] _labels Component of each vertex, keyed by vertex Id. The
+  /// components are numbered from 0 in the same order as the graphs
+  /// returned by ConnectedComponents(), which is the order of their
+  /// smallest vertex Id. The map is cleared first.
+  /// \return The number of components.
+  template<typename V, typename E, typename EdgeType>
+  unsigned int ConnectedComponents(const Graph<V, E, EdgeType> &_graph,
+                                   std::map<VertexId, unsigned int> &_labels)
+  {
+    std::vector<VertexId> ids;
+    std::vector<unsigned int> labels;
+    const unsigned int count = detail::ComponentLabels(_graph, ids, labels);
+
+    // Ids are sorted, so every insertion goes at the end of the map.
+    _labels.clear();
+    for (std::size_t i = 0; i < ids.size(); ++i)
+      _labels.emplace_hint(_labels.end(), ids[i], labels[i]);
 
+    return count;
+  }
+
+  /// \brief Calculate the connected components of a graph as views that
+  /// refer to the vertices and edges of the graph instead of copying them.
+  /// Edge directions are ignored, so the components of a directed graph
+  /// are its weakly connected components.
+  /// \param[in] _graph A graph. It must outlive the views and must not be
+  /// modified while they are in use.
+  /// \return One view per component, in the same order as the graphs
+  /// returned by ConnectedComponents().
+  template<typename V, typename E, typename EdgeType>
+  std::vector<SubgraphView<V, E, EdgeType>> ConnectedComponentViews(
+    const Graph<V, E, EdgeType> &_graph)
+  {
+    std::vector<VertexId> ids;
+    std::vector<unsigned int> labels;
+    const unsigned int count = detail::ComponentLabels(_graph, ids, labels);
+
+    std::vector<std::vector<VertexId>> vertices(count);
+    for (std::size_t i = 0; i < ids.size(); ++i)
+      vertices[labels[i]].push_back(ids[i]);
+
+    std::vector<std::vector<EdgeId>> edges(count);
+    _graph.ForEachEdge([&](const EdgeType &_e)
+    {
+      const auto it = std::lower_bound(ids.begin(), ids.end(),
+                                       _e.Vertices().first);
+      edges[labels[it - ids.begin()]].push_back(_e.Id());
+    });
+
+    std::vector<SubgraphView<V, E, EdgeType>> res;
+    res.reserve(count);
+    for (unsigned int c = 0; c < count; ++c)
+    {
+      res.emplace_back(_graph, std::move(vertices[c]),
+                       std::move(edges[c]));
+    }
     return res;
   }
 
   /// \brief Copy a DirectedGraph to an UndirectedGraph with the same vertices
-  /// and edges.
+  /// and edges. To find the weakly connected components of a directed graph,
+  /// ConnectedComponentViews() and ConnectedComponents(const Graph &,
+  /// std::map &) avoid this copy.
   /// \param[in] _graph A directed graph.
   /// \return An undirected graph with the same vertices and edges as the
   /// original graph.
@@ -352,6 +756,1663 @@ namespace graph
 
     return UndirectedGraph<V, E>(vertices, edges);
   }
+
+  namespace detail
+  {
+    /// \brief Breadth first sort over a CSRGraph or a CSRGraphView.
+    /// \param[in] _graph A CSR graph.
+    /// \param[in] _from The starting vertex.
+    /// \param[in, out] _workspace Memory of the search.
+    /// \param[out] _visited Ids of the traversed vertices.
+    /// \param[in, out] _stats Statistics sink.
+    template<typename G, typename Stats>
+    void BreadthFirstSort(const G &_graph, const VertexId &_from,
+                          SearchWorkspace &_workspace,
+                          std::vector<VertexId> &_visited, Stats &_stats)
+    {
+      _visited.clear();
+      const CSRIndex from = _graph.Index(_from);
+      if (from == kNullIndex)
+        return;
+
+      _stats.OnSearch();
+
+      const auto &offsets = _graph.Offsets();
+      const auto &targets = _graph.Targets();
+
+      _workspace.Reset(_graph.VertexCount());
+      auto &pending = _workspace.Pending();
+      pending.push_back(from);
+      _workspace.Visit(from, 0.0, from);
+      _stats.OnPush(1);
+
+      for (std::size_t head = 0; head < pending.size(); ++head)
+      {
+        const CSRIndex u = pending[head];
+        _visited.push_back(_graph.Id(u));
+        _stats.OnExpand();
+
+        const double level = _workspace.Cost(u) + 1.0;
+        for (CSRIndex arc = offsets[u]; arc < offsets[u + 1]; ++arc)
+        {
+          _stats.OnRelax();
+          const CSRIndex v = targets[arc];
+          if (_workspace.Visit(v, level, u))
+          {
+            pending.push_back(v);
+            _stats.OnPush(pending.size() - head - 1);
+          }
+        }
+      }
+    }
+
+    /// \brief Depth first sort over a CSRGraph or a CSRGraphView.
+    /// \param[in] _graph A CSR graph.
+    /// \param[in] _from The starting vertex.
+    /// \param[in, out] _workspace Memory of the search.
+    /// \param[out] _visited Ids of the visited vertices.
+    /// \param[in, out] _stats Statistics sink.
+    template<typename G, typename Stats>
+    void DepthFirstSort(const G &_graph, const VertexId &_from,
+                        SearchWorkspace &_workspace,
+                        std::vector<VertexId> &_visited, Stats &_stats)
+    {
+      _visited.clear();
+      const CSRIndex from = _graph.Index(_from);
+      if (from == kNullIndex)
+        return;
+
+      _stats.OnSearch();
+
+      const auto &offsets = _graph.Offsets();
+      const auto &targets = _graph.Targets();
+
+      _workspace.Reset(_graph.VertexCount());
+      auto &pending = _workspace.Pending();
+      pending.push_back(from);
+      _stats.OnPush(1);
+
+      while (!pending.empty())
+      {
+        const CSRIndex u = pending.back();
+        pending.pop_back();
+
+        // If the vertex has been visited, skip.
+        if (!_workspace.Visit(u, 0.0, kNullIndex))
+          continue;
+
+        _visited.push_back(_graph.Id(u));
+        _stats.OnExpand();
+
+        for (CSRIndex arc = offsets[u]; arc < offsets[u + 1]; ++arc)
+        {
+          _stats.OnRelax();
+          const CSRIndex v = targets[arc];
+          if (!_workspace.Reached(v))
+          {
+            pending.push_back(v);
+            _stats.OnPush(pending.size());
+          }
+        }
+      }
+    }
+  }
+
+  /// \brief Breadth first sort (BFS) over a CSRGraph, reusing the memory
+  /// of a workspace. After the search, the workspace holds the number of
+  /// edges from _from to each reached vertex and its parent in the
+  /// traversal.
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[out] _visited Ids of the vertices traversed in a breadth first
+  /// manner. It is cleared first, and left empty if _from does not exist.
+  inline void BreadthFirstSort(const CSRGraph &_graph, const VertexId &_from,
+                               SearchWorkspace &_workspace,
+                               std::vector<VertexId> &_visited)
+  {
+    detail::NoSearchStats stats;
+    detail::BreadthFirstSort(_graph, _from, _workspace, _visited, stats);
+  }
+
+  /// \brief Breadth first sort (BFS) over a graph read in place, reusing
+  /// the memory of a workspace.
+  /// \sa BreadthFirstSort(const CSRGraph &, const VertexId &,
+  /// SearchWorkspace &, std::vector<VertexId> &)
+  /// \param[in] _graph An open CSR graph view.
+  /// \param[in] _from The starting vertex.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[out] _visited Ids of the vertices traversed in a breadth first
+  /// manner.
+  inline void BreadthFirstSort(const CSRGraphView &_graph,
+                               const VertexId &_from,
+                               SearchWorkspace &_workspace,
+                               std::vector<VertexId> &_visited)
+  {
+    detail::NoSearchStats stats;
+    detail::BreadthFirstSort(_graph, _from, _workspace, _visited, stats);
+  }
+
+  /// \brief Breadth first sort (BFS) over a CSRGraph.
+  /// Produces the same traversal as BreadthFirstSort() on the graph the
+  /// CSRGraph was built from, using flat arrays for the queue and the
+  /// visited flags.
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _from The starting vertex.
+  /// \return The vector of vertices Ids traversed in a breadth first manner.
+  /// An empty vector is returned if _from does not exist.
+  inline std::vector<VertexId> BreadthFirstSort(const CSRGraph &_graph,
+                                                const VertexId &_from)
+  {
+    SearchWorkspace workspace;
+    std::vector<VertexId> visited;
+    BreadthFirstSort(_graph, _from, workspace, visited);
+    return visited;
+  }
+
+  /// \brief Depth first sort (DFS) over a CSRGraph, reusing the memory of
+  /// a workspace. After the search, the workspace tells which vertices
+  /// were reached.
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[out] _visited Ids of the vertices visited in a depth first
+  /// manner. It is cleared first, and left empty if _from does not exist.
+  inline void DepthFirstSort(const CSRGraph &_graph, const VertexId &_from,
+                             SearchWorkspace &_workspace,
+                             std::vector<VertexId> &_visited)
+  {
+    detail::NoSearchStats stats;
+    detail::DepthFirstSort(_graph, _from, _workspace, _visited, stats);
+  }
+
+  /// \brief Depth first sort (DFS) over a graph read in place, reusing
+  /// the memory of a workspace.
+  /// \sa DepthFirstSort(const CSRGraph &, const VertexId &,
+  /// SearchWorkspace &, std::vector<VertexId> &)
+  /// \param[in] _graph An open CSR graph view.
+  /// \param[in] _from The starting vertex.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[out] _visited Ids of the vertices visited in a depth first
+  /// manner.
+  inline void DepthFirstSort(const CSRGraphView &_graph,
+                             const VertexId &_from,
+                             SearchWorkspace &_workspace,
+                             std::vector<VertexId> &_visited)
+  {
+    detail::NoSearchStats stats;
+    detail::DepthFirstSort(_graph, _from, _workspace, _visited, stats);
+  }
+
+  /// \brief Depth first sort (DFS) over a CSRGraph.
+  /// Produces the same traversal as DepthFirstSort() on the graph the
+  /// CSRGraph was built from, using flat arrays for the stack and the
+  /// visited flags.
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _from The starting vertex.
+  /// \return The vector of vertices Ids visited in a depth first manner.
+  /// An empty vector is returned if _from does not exist.
+  inline std::vector<VertexId> DepthFirstSort(const CSRGraph &_graph,
+                                              const VertexId &_from)
+  {
+    SearchWorkspace workspace;
+    std::vector<VertexId> visited;
+    DepthFirstSort(_graph, _from, workspace, visited);
+    return visited;
+  }
+
+  namespace detail
+  {
+    /// \brief Dijkstra algorithm over a CSRGraph or a CSRGraphView from
+    /// several source vertices, stopping once all the target vertices are
+    /// settled.
+    /// \param[in] _graph A CSR graph.
+    /// \param[in] _sources First of the source vertices.
+    /// \param[in] _sourceCount Number of source vertices.
+    /// \param[in, out] _workspace Memory of the search.
+    /// \param[in] _targets First of the target vertices.
+    /// \param[in] _targetCount Number of target vertices, or 0 to settle
+    /// every reachable vertex.
+    /// \param[in, out] _stats Statistics sink.
+    /// \return False if a source or target vertex doesn't exist, or if
+    /// there are no sources.
+    template<typename G, typename Stats>
+    bool Dijkstra(const G &_graph, const VertexId *_sources,
+                  const std::size_t _sourceCount,
+                  SearchWorkspace &_workspace, const VertexId *_targets,
+                  const std::size_t _targetCount, Stats &_stats)
+    {
+      IGN_MATH_TRACE_ZONE("Dijkstra(CSRGraph)");
+      // Sanity check: The source and target vertices should exist. This is
+      // checked before touching the workspace, to keep its results.
+      if (_sourceCount == 0)
+      {
+        IGN_MATH_DIAGNOSTIC("No source vertex");
+        return false;
+      }
+      for (std::size_t i = 0; i < _sourceCount; ++i)
+      {
+        if (_graph.Index(_sources[i]) == kNullIndex)
+        {
+          IGN_MATH_DIAGNOSTIC("Vertex [" << _sources[i] << "] Not found");
+          return false;
+        }
+      }
+      for (std::size_t i = 0; i < _targetCount; ++i)
+      {
+        if (_graph.Index(_targets[i]) == kNullIndex)
+        {
+          IGN_MATH_DIAGNOSTIC("Vertex [" << _targets[i] << "] Not found");
+          return false;
+        }
+      }
+
+      const auto &offsets = _graph.Offsets();
+      const auto &targets = _graph.Targets();
+      const auto &weights = _graph.Weights();
+
+      _workspace.Reset(_graph.VertexCount());
+      _stats.OnSearch();
+
+      // Sorted target vertices, counted down as they are settled.
+      auto &pending = _workspace.Pending();
+      for (std::size_t i = 0; i < _targetCount; ++i)
+        pending.push_back(_graph.Index(_targets[i]));
+      std::sort(pending.begin(), pending.end());
+      pending.erase(std::unique(pending.begin(), pending.end()),
+                    pending.end());
+      std::size_t remaining = pending.size();
+
+      for (std::size_t i = 0; i < _sourceCount; ++i)
+      {
+        const CSRIndex source = _graph.Index(_sources[i]);
+        if (_workspace.Push(source, 0.0, source))
+          _stats.OnPush(_workspace.QueueSize());
+      }
+
+      while (!_workspace.QueueEmpty())
+      {
+        // This is the minimum distance vertex, whose cost is now final.
+        const CSRIndex u = _workspace.Pop();
+
+        // Shortcut: All target vertices found, exiting.
+        if (remaining > 0 &&
+            std::binary_search(pending.begin(), pending.end(), u) &&
+            --remaining == 0)
+        {
+          break;
+        }
+
+        _stats.OnExpand();
+        const double uCost = _workspace.Cost(u);
+        for (CSRIndex arc = offsets[u]; arc < offsets[u + 1]; ++arc)
+        {
+          //  Update v if there is a shorter path to it through u.
+          _stats.OnRelax();
+          if (_workspace.Push(targets[arc], uCost + weights[arc], u))
+            _stats.OnPush(_workspace.QueueSize());
+        }
+      }
+
+      return true;
+    }
+  }
+
+  /// \brief Dijkstra algorithm over a CSRGraph, reusing the memory of a
+  /// workspace. Nothing is allocated once the workspace has grown to the
+  /// size of the graph, and the work is proportional to the part of the
+  /// graph that is explored, which makes it suited to many short queries.
+  /// The priority queue is an indexed heap with decrease-key, so it holds
+  /// each vertex at most once.
+  /// After the search, SearchWorkspace::Cost(), Previous() and Path() give
+  /// the shortest paths. When a destination vertex is provided, only the
+  /// path to it should be used.
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[in] _to Optional destination vertex.
+  /// \return False if the source or destination vertex don't exist, in
+  /// which case the workspace is left untouched.
+  inline bool Dijkstra(const CSRGraph &_graph, const VertexId &_from,
+                       SearchWorkspace &_workspace,
+                       const VertexId &_to = kNullId)
+  {
+    detail::NoSearchStats stats;
+    return detail::Dijkstra(_graph, &_from, 1, _workspace, &_to,
+                            _to == kNullId ? 0 : 1, stats);
+  }
+
+  /// \brief Dijkstra algorithm over a CSRGraph from several source
+  /// vertices, reusing the memory of a workspace. Every vertex gets the
+  /// cost of the shortest path from any of the sources, such as the
+  /// distance to the closest of several facilities. The sources have a
+  /// cost of 0 and are their own previous vertex, so the first vertex of
+  /// SearchWorkspace::Path() is the closest source.
+  /// When target vertices are provided, the search stops as soon as all of
+  /// them are settled, and only the paths to them should be used.
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _sources The starting vertices.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[in] _targets Optional destination vertices.
+  /// \return False if there are no sources, or if a source or destination
+  /// vertex doesn't exist, in which case the workspace is left untouched.
+  inline bool Dijkstra(const CSRGraph &_graph,
+                       const std::vector<VertexId> &_sources,
+                       SearchWorkspace &_workspace,
+                       const std::vector<VertexId> &_targets = {})
+  {
+    detail::NoSearchStats stats;
+    return detail::Dijkstra(_graph, _sources.data(), _sources.size(),
+                            _workspace, _targets.data(), _targets.size(),
+                            stats);
+  }
+
+  /// \brief Dijkstra algorithm over a graph read in place, reusing the
+  /// memory of a workspace.
+  /// \sa Dijkstra(const CSRGraph &, const VertexId &, SearchWorkspace &,
+  /// const VertexId &)
+  /// \param[in] _graph An open CSR graph view.
+  /// \param[in] _from The starting vertex.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[in] _to Optional destination vertex.
+  /// \return False if the source or destination vertex don't exist.
+  inline bool Dijkstra(const CSRGraphView &_graph, const VertexId &_from,
+                       SearchWorkspace &_workspace,
+                       const VertexId &_to = kNullId)
+  {
+    detail::NoSearchStats stats;
+    return detail::Dijkstra(_graph, &_from, 1, _workspace, &_to,
+                            _to == kNullId ? 0 : 1, stats);
+  }
+
+  /// \brief Dijkstra algorithm over a graph read in place from several
+  /// source vertices, reusing the memory of a workspace.
+  /// \sa Dijkstra(const CSRGraph &, const std::vector<VertexId> &,
+  /// SearchWorkspace &, const std::vector<VertexId> &)
+  /// \param[in] _graph An open CSR graph view.
+  /// \param[in] _sources The starting vertices.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[in] _targets Optional destination vertices.
+  /// \return False if there are no sources, or if a source or destination
+  /// vertex doesn't exist.
+  inline bool Dijkstra(const CSRGraphView &_graph,
+                       const std::vector<VertexId> &_sources,
+                       SearchWorkspace &_workspace,
+                       const std::vector<VertexId> &_targets = {})
+  {
+    detail::NoSearchStats stats;
+    return detail::Dijkstra(_graph, _sources.data(), _sources.size(),
+                            _workspace, _targets.data(), _targets.size(),
+                            stats);
+  }
+
+  /// \brief Breadth first sort (BFS) over a CSRGraph that also counts
+  /// its work.
+  /// \sa BreadthFirstSort(const CSRGraph &, const VertexId &,
+  /// SearchWorkspace &, std::vector<VertexId> &)
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[out] _visited Ids of the traversed vertices.
+  /// \param[in, out] _stats Counters the work of the search is added to.
+  inline void BreadthFirstSort(const CSRGraph &_graph, const VertexId &_from,
+                               SearchWorkspace &_workspace,
+                               std::vector<VertexId> &_visited,
+                               SearchStats &_stats)
+  {
+    detail::BreadthFirstSort(_graph, _from, _workspace, _visited, _stats);
+  }
+
+  /// \brief Breadth first sort (BFS) over a graph read in place that also
+  /// counts its work.
+  /// \param[in] _graph An open CSR graph view.
+  /// \param[in] _from The starting vertex.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[out] _visited Ids of the traversed vertices.
+  /// \param[in, out] _stats Counters the work of the search is added to.
+  inline void BreadthFirstSort(const CSRGraphView &_graph,
+                               const VertexId &_from,
+                               SearchWorkspace &_workspace,
+                               std::vector<VertexId> &_visited,
+                               SearchStats &_stats)
+  {
+    detail::BreadthFirstSort(_graph, _from, _workspace, _visited, _stats);
+  }
+
+  /// \brief Depth first sort (DFS) over a CSRGraph that also counts its
+  /// work. Vertices pushed on the stack several times are counted once
+  /// per push.
+  /// \sa DepthFirstSort(const CSRGraph &, const VertexId &,
+  /// SearchWorkspace &, std::vector<VertexId> &)
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[out] _visited Ids of the visited vertices.
+  /// \param[in, out] _stats Counters the work of the search is added to.
+  inline void DepthFirstSort(const CSRGraph &_graph, const VertexId &_from,
+                             SearchWorkspace &_workspace,
+                             std::vector<VertexId> &_visited,
+                             SearchStats &_stats)
+  {
+    detail::DepthFirstSort(_graph, _from, _workspace, _visited, _stats);
+  }
+
+  /// \brief Depth first sort (DFS) over a graph read in place that also
+  /// counts its work.
+  /// \param[in] _graph An open CSR graph view.
+  /// \param[in] _from The starting vertex.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[out] _visited Ids of the visited vertices.
+  /// \param[in, out] _stats Counters the work of the search is added to.
+  inline void DepthFirstSort(const CSRGraphView &_graph,
+                             const VertexId &_from,
+                             SearchWorkspace &_workspace,
+                             std::vector<VertexId> &_visited,
+                             SearchStats &_stats)
+  {
+    detail::DepthFirstSort(_graph, _from, _workspace, _visited, _stats);
+  }
+
+  /// \brief Dijkstra algorithm over a CSRGraph that also counts its work.
+  /// A push is the insertion of a vertex in the priority queue or a
+  /// decrease of its key.
+  /// \sa Dijkstra(const CSRGraph &, const VertexId &, SearchWorkspace &,
+  /// const VertexId &)
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[in] _to Destination vertex, or kNullId.
+  /// \param[in, out] _stats Counters the work of the search is added to.
+  /// \return False if the source or destination vertex don't exist.
+  inline bool Dijkstra(const CSRGraph &_graph, const VertexId &_from,
+                       SearchWorkspace &_workspace, const VertexId &_to,
+                       SearchStats &_stats)
+  {
+    return detail::Dijkstra(_graph, &_from, 1, _workspace, &_to,
+                            _to == kNullId ? 0 : 1, _stats);
+  }
+
+  /// \brief Dijkstra algorithm over a CSRGraph from several source
+  /// vertices that also counts its work.
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _sources The starting vertices.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[in] _targets Destination vertices, or an empty vector.
+  /// \param[in, out] _stats Counters the work of the search is added to.
+  /// \return False if there are no sources, or if a source or destination
+  /// vertex doesn't exist.
+  inline bool Dijkstra(const CSRGraph &_graph,
+                       const std::vector<VertexId> &_sources,
+                       SearchWorkspace &_workspace,
+                       const std::vector<VertexId> &_targets,
+                       SearchStats &_stats)
+  {
+    return detail::Dijkstra(_graph, _sources.data(), _sources.size(),
+                            _workspace, _targets.data(), _targets.size(),
+                            _stats);
+  }
+
+  /// \brief Dijkstra algorithm over a graph read in place that also
+  /// counts its work.
+  /// \param[in] _graph An open CSR graph view.
+  /// \param[in] _from The starting vertex.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[in] _to Destination vertex, or kNullId.
+  /// \param[in, out] _stats Counters the work of the search is added to.
+  /// \return False if the source or destination vertex don't exist.
+  inline bool Dijkstra(const CSRGraphView &_graph, const VertexId &_from,
+                       SearchWorkspace &_workspace, const VertexId &_to,
+                       SearchStats &_stats)
+  {
+    return detail::Dijkstra(_graph, &_from, 1, _workspace, &_to,
+                            _to == kNullId ? 0 : 1, _stats);
+  }
+
+  /// \brief Dijkstra algorithm over a graph read in place from several
+  /// source vertices that also counts its work.
+  /// \param[in] _graph An open CSR graph view.
+  /// \param[in] _sources The starting vertices.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[in] _targets Destination vertices, or an empty vector.
+  /// \param[in, out] _stats Counters the work of the search is added to.
+  /// \return False if there are no sources, or if a source or destination
+  /// vertex doesn't exist.
+  inline bool Dijkstra(const CSRGraphView &_graph,
+                       const std::vector<VertexId> &_sources,
+                       SearchWorkspace &_workspace,
+                       const std::vector<VertexId> &_targets,
+                       SearchStats &_stats)
+  {
+    return detail::Dijkstra(_graph, _sources.data(), _sources.size(),
+                            _workspace, _targets.data(), _targets.size(),
+                            _stats);
+  }
+
+  /// \brief Dijkstra algorithm over a CSRGraph.
+  /// Same as Dijkstra(), but distances are kept in flat arrays and the
+  /// result is a vector indexed by the dense vertex index. Use
+  /// CSRGraph::Index() to find the entry of a given VertexId.
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _to Optional destination vertex.
+  /// \return A vector with one entry per vertex. Each entry holds the
+  /// shortest cost from the origin vertex and the Id of the previous
+  /// vertex in the shortest path. Unreachable vertices have a cost of
+  /// MAX_D and a previous vertex of kNullId. When a destination vertex is
+  /// provided, only its entry should be used.
+  /// If the source or destination vertex don't exist, the function will
+  /// return an empty vector.
+  inline std::vector<CostInfo> Dijkstra(const CSRGraph &_graph,
+                                        const VertexId &_from,
+                                        const VertexId &_to = kNullId)
+  {
+    SearchWorkspace workspace;
+    if (!Dijkstra(_graph, _from, workspace, _to))
+      return {};
+
+    std::vector<CostInfo> res(_graph.VertexCount());
+    for (CSRIndex i = 0; i < _graph.VertexCount(); ++i)
+    {
+      res[i] = std::make_pair(workspace.Cost(i),
+                              _graph.Id(workspace.Previous(i)));
+    }
+
+    return res;
+  }
+
+  /// \brief Dijkstra algorithm over a CSRGraph from several source
+  /// vertices. Same as the single source version, but every vertex gets
+  /// the cost of the shortest path from any of the sources. The sources
+  /// have a cost of 0 and are their own previous vertex.
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _sources The starting vertices.
+  /// \param[in] _targets Optional destination vertices. The search stops
+  /// once all of them are settled, and only their entries should be used.
+  /// \return A vector with one entry per vertex, indexed by the dense
+  /// vertex index. If there are no sources, or if a source or destination
+  /// vertex doesn't exist, the function will return an empty vector.
+  inline std::vector<CostInfo> Dijkstra(const CSRGraph &_graph,
+      const std::vector<VertexId> &_sources,
+      const std::vector<VertexId> &_targets = {})
+  {
+    SearchWorkspace workspace;
+    if (!Dijkstra(_graph, _sources, workspace, _targets))
+      return {};
+
+    std::vector<CostInfo> res(_graph.VertexCount());
+    for (CSRIndex i = 0; i < _graph.VertexCount(); ++i)
+    {
+      res[i] = std::make_pair(workspace.Cost(i),
+                              _graph.Id(workspace.Previous(i)));
+    }
+
+    return res;
+  }
+
+  /// \brief Calculate the connected components of a CSRGraph built from an
+  /// undirected graph.
+  /// \sa ConnectedComponents()
+  /// \param[in] _graph A CSR graph built from an undirected graph.
+  /// \return A vector with the Ids of the vertices of each component. The
+  /// components are ordered by their smallest vertex Id and the vertices
+  /// of each component follow a breadth first order. An empty vector is
+  /// returned if _graph was built from a directed graph.
+  inline std::vector<std::vector<VertexId>> ConnectedComponents(
+    const CSRGraph &_graph)
+  {
+    std::vector<std::vector<VertexId>> res;
+    if (_graph.Directed())
+    {
+      IGN_MATH_DIAGNOSTIC("[ConnectedComponents] The graph must be undirected");
+      return res;
+    }
+
+    const auto &offsets = _graph.Offsets();
+    const auto &targets = _graph.Targets();
+
+    std::vector<char> seen(_graph.VertexCount(), 0);
+    std::vector<CSRIndex> pending;
+    pending.reserve(_graph.VertexCount());
+
+    for (CSRIndex root = 0; root < _graph.VertexCount(); ++root)
+    {
+      if (seen[root])
+        continue;
+
+      pending.clear();
+      pending.push_back(root);
+      seen[root] = 1;
+
+      for (std::size_t head = 0; head < pending.size(); ++head)
+      {
+        const CSRIndex u = pending[head];
+        for (CSRIndex arc = offsets[u]; arc < offsets[u + 1]; ++arc)
+        {
+          const CSRIndex v = targets[arc];
+          if (!seen[v])
+          {
+            seen[v] = 1;
+            pending.push_back(v);
+          }
+        }
+      }
+
+      std::vector<VertexId> component(pending.size());
+      for (std::size_t i = 0; i < pending.size(); ++i)
+        component[i] = _graph.Id(pending[i]);
+      res.push_back(std::move(component));
+    }
+
+    return res;
+  }
+
+  namespace detail
+  {
+    /// \brief Get the number of threads used to process a range.
+    /// \param[in] _count Size of the range.
+    /// \param[in] _minPerThread Minimum number of elements per thread.
+    /// \param[in] _threads Maximum number of threads, or 0 for the number
+    /// of hardware threads.
+    /// \return Number of blocks to split the range into, at least 1.
+    inline std::size_t BlockCount(const std::size_t _count,
+                                  const std::size_t _minPerThread,
+                                  const unsigned int _threads)
+    {
+      std::size_t threads = _threads;
+      if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+      return std::max<std::size_t>(1,
+          std::min(threads, _count / _minPerThread));
+    }
+
+    /// \brief Split a range in contiguous blocks and process each block on
+    /// its own thread. The first block runs on the calling thread.
+    /// \param[in] _count Size of the range.
+    /// \param[in] _blocks Number of blocks, from BlockCount().
+    /// \param[in] _fn Function called with the index of the block and the
+    /// first and past the end elements of the block.
+    template<typename F>
+    void ForEachBlock(const std::size_t _count, const std::size_t _blocks,
+                      F _fn)
+    {
+      const std::size_t chunk = (_count + _blocks - 1) / _blocks;
+      std::vector<std::thread> workers;
+      for (std::size_t b = 1; b < _blocks; ++b)
+      {
+        const std::size_t begin = std::min(_count, b * chunk);
+        const std::size_t end = std::min(_count, begin + chunk);
+        workers.emplace_back([&_fn, b, begin, end]() {_fn(b, begin, end);});
+      }
+      _fn(0, 0, std::min(_count, chunk));
+
+      for (auto &worker : workers)
+        worker.join();
+    }
+
+    /// \brief Find the root of a vertex in a concurrent union-find forest,
+    /// halving the path on the way.
+    /// \param[in,out] _parent Parent of each vertex.
+    /// \param[in] _u The vertex.
+    /// \return The root of _u.
+    inline CSRIndex FindRoot(std::vector<std::atomic<CSRIndex>> &_parent,
+                             CSRIndex _u)
+    {
+      CSRIndex p = _parent[_u].load(std::memory_order_relaxed);
+      while (p != _u)
+      {
+        const CSRIndex grandParent = _parent[p].load(
+            std::memory_order_relaxed);
+        // Losing this race only leaves a longer path behind.
+        if (p != grandParent)
+        {
+          _parent[_u].compare_exchange_weak(p, grandParent,
+              std::memory_order_relaxed);
+        }
+        _u = p;
+        p = _parent[_u].load(std::memory_order_relaxed);
+      }
+      return _u;
+    }
+
+    /// \brief Merge the sets of two vertices in a concurrent union-find
+    /// forest. The root with the larger index is linked below the other,
+    /// so every root is the smallest index of its set.
+    /// \param[in,out] _parent Parent of each vertex.
+    /// \param[in] _u First vertex.
+    /// \param[in] _v Second vertex.
+    /// \return True if this call merged two sets, false if the vertices
+    /// were already in the same set.
+    inline bool Unite(std::vector<std::atomic<CSRIndex>> &_parent,
+                      CSRIndex _u, CSRIndex _v)
+    {
+      while (true)
+      {
+        _u = FindRoot(_parent, _u);
+        _v = FindRoot(_parent, _v);
+        if (_u == _v)
+          return false;
+
+        if (_u < _v)
+          std::swap(_u, _v);
+
+        // Another thread may have linked _u in the meantime, in which case
+        // the roots are searched again.
+        CSRIndex expected = _u;
+        if (_parent[_u].compare_exchange_strong(expected, _v,
+                std::memory_order_relaxed))
+        {
+          return true;
+        }
+      }
+    }
+  }
+
+  /// \brief Compute the breadth first levels of the vertices of a
+  /// CSRGraph, which is the number of arcs on a shortest path from a
+  /// starting vertex.
+  ///
+  /// This is a level synchronous, direction optimizing search. Small
+  /// frontiers are expanded top down by scanning their outgoing arcs.
+  /// Once the arcs leaving the frontier outnumber a fraction of the arcs
+  /// left to explore, the search switches to bottom up. Each unvisited
+  /// vertex then scans its neighbors until it finds one in the frontier.
+  /// It switches back to top down when the frontier shrinks again.
+  /// Bottom up steps need the incoming arcs of each vertex, so graphs
+  /// built from a directed graph are always searched top down.
+  ///
+  /// The levels are the same as those of BreadthFirstSort(), and do not
+  /// depend on the number of threads. Sorting the reached vertices by level
+  /// gives a breadth first traversal.
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _threads Number of threads used to expand each level.
+  /// Each thread handles a contiguous block of the frontier in top down
+  /// steps, or of the vertices in bottom up steps. A value of 0 uses the
+  /// number of hardware threads. Levels with little work always use a
+  /// single thread.
+  /// \return A vector with the level of each vertex, indexed by dense
+  /// vertex index. The starting vertex has level 0 and vertices that can't
+  /// be reached have level kNullIndex. An empty vector is returned if
+  /// _from does not exist.
+  inline std::vector<CSRIndex> BreadthFirstLevels(
+    const CSRGraph &_graph, const VertexId &_from,
+    const unsigned int _threads = 1)
+  {
+    // Minimum number of arcs scanned by each thread.
+    const std::size_t kMinArcsPerThread = 16384;
+    // Switch to bottom up when the frontier has more than 1/kAlpha of the
+    // unexplored arcs, and back to top down when it has less than
+    // 1/kBeta of the vertices.
+    const std::size_t kAlpha = 15;
+    const std::size_t kBeta = 18;
+
+    const CSRIndex from = _graph.Index(_from);
+    if (from == kNullIndex)
+      return {};
+
+    const CSRIndex n = _graph.VertexCount();
+    const auto &offsets = _graph.Offsets();
+    const auto &targets = _graph.Targets();
+
+    std::vector<std::atomic<CSRIndex>> levels(n);
+    for (auto &level : levels)
+      level.store(kNullIndex, std::memory_order_relaxed);
+    levels[from].store(0, std::memory_order_relaxed);
+
+    std::vector<CSRIndex> frontier = {from};
+    std::vector<std::vector<CSRIndex>> next;
+    std::vector<char> inFrontier;
+    std::size_t frontierArcs = _graph.OutDegree(from);
+    std::size_t unexploredArcs = _graph.ArcCount() - frontierArcs;
+    bool bottomUp = false;
+
+    for (CSRIndex level = 1; !frontier.empty(); ++level)
+    {
+      if (!_graph.Directed())
+      {
+        if (!bottomUp && frontierArcs > unexploredArcs / kAlpha)
+          bottomUp = true;
+        else if (bottomUp && frontier.size() < n / kBeta)
+          bottomUp = false;
+      }
+
+      std::size_t blocks;
+      if (bottomUp)
+      {
+        inFrontier.assign(n, 0);
+        for (const CSRIndex u : frontier)
+          inFrontier[u] = 1;
+
+        blocks = detail::BlockCount(unexploredArcs + n, kMinArcsPerThread,
+                                    _threads);
+        next.resize(blocks);
+        detail::ForEachBlock(n, blocks,
+          [&](std::size_t _b, std::size_t _begin, std::size_t _end)
+          {
+            next[_b].clear();
+            for (std::size_t v = _begin; v < _end; ++v)
+            {
+              if (levels[v].load(std::memory_order_relaxed) != kNullIndex)
+                continue;
+
+              for (CSRIndex arc = offsets[v]; arc < offsets[v + 1]; ++arc)
+              {
+                if (inFrontier[targets[arc]])
+                {
+                  levels[v].store(level, std::memory_order_relaxed);
+                  next[_b].push_back(static_cast<CSRIndex>(v));
+                  break;
+                }
+              }
+            }
+          });
+      }
+      else
+      {
+        blocks = std::min<std::size_t>(frontier.size(),
+            detail::BlockCount(frontierArcs, kMinArcsPerThread, _threads));
+        next.resize(blocks);
+        detail::ForEachBlock(frontier.size(), blocks,
+          [&](std::size_t _b, std::size_t _begin, std::size_t _end)
+          {
+            next[_b].clear();
+            for (std::size_t i = _begin; i < _end; ++i)
+            {
+              const CSRIndex u = frontier[i];
+              for (CSRIndex arc = offsets[u]; arc < offsets[u + 1]; ++arc)
+              {
+                const CSRIndex v = targets[arc];
+                CSRIndex unvisited = kNullIndex;
+                if (levels[v].load(std::memory_order_relaxed) ==
+                      kNullIndex &&
+                    levels[v].compare_exchange_strong(unvisited, level,
+                      std::memory_order_relaxed))
+                {
+                  next[_b].push_back(v);
+                }
+              }
+            }
+          });
+      }
+
+      frontier.clear();
+      frontierArcs = 0;
+      for (std::size_t b = 0; b < blocks; ++b)
+      {
+        for (const CSRIndex v : next[b])
+        {
+          frontier.push_back(v);
+          frontierArcs += offsets[v + 1] - offsets[v];
+        }
+      }
+      unexploredArcs -= std::min(unexploredArcs, frontierArcs);
+    }
+
+    std::vector<CSRIndex> res(n);
+    for (CSRIndex i = 0; i < n; ++i)
+      res[i] = levels[i].load(std::memory_order_relaxed);
+    return res;
+  }
+
+  namespace detail
+  {
+    /// \brief Delta-stepping over a CSRGraph from several source vertices.
+    /// \param[in] _graph A CSR graph.
+    /// \param[in] _sources First of the source vertices.
+    /// \param[in] _sourceCount Number of source vertices.
+    /// \param[in] _delta Width of the buckets, or a value that isn't
+    /// positive to choose it from the weights.
+    /// \param[in] _threads Number of threads, 0 for the number of hardware
+    /// threads.
+    /// \return One entry per vertex, or an empty vector if a source vertex
+    /// doesn't exist or if there are no sources.
+    inline std::vector<CostInfo> DeltaStepping(const CSRGraph &_graph,
+        const VertexId *_sources, const std::size_t _sourceCount,
+        double _delta, const unsigned int _threads)
+    {
+      IGN_MATH_TRACE_ZONE("DeltaStepping(CSRGraph)");
+      // Minimum number of arcs relaxed by each thread.
+      const std::size_t kMinArcsPerThread = 16384;
+
+      if (_sourceCount == 0)
+      {
+        IGN_MATH_DIAGNOSTIC("No source vertex");
+        return {};
+      }
+      for (std::size_t i = 0; i < _sourceCount; ++i)
+      {
+        if (_graph.Index(_sources[i]) == kNullIndex)
+        {
+          IGN_MATH_DIAGNOSTIC("Vertex [" << _sources[i] << "] Not found");
+          return {};
+        }
+      }
+
+      const CSRIndex n = _graph.VertexCount();
+      const auto &offsets = _graph.Offsets();
+      const auto &targets = _graph.Targets();
+      const auto &weights = _graph.Weights();
+
+      // There may be thousands of rounds, so the number of hardware
+      // threads is only queried once.
+      const unsigned int threads = _threads > 0 ? _threads :
+          std::max(1u, std::thread::hardware_concurrency());
+
+      // The default width is the largest weight over the average degree,
+      // which keeps a few light arcs per vertex.
+      if (!(_delta > 0.0))
+      {
+        double maxWeight = 0.0;
+        for (const double w : weights)
+          maxWeight = std::max(maxWeight, w);
+        _delta = maxWeight * n / std::max<std::size_t>(1, weights.size());
+        if (!(_delta > 0.0))
+          _delta = 1.0;
+      }
+      auto bucketOf = [_delta](const double _cost)
+      {
+        return static_cast<std::size_t>(std::min(_cost / _delta, 1e18));
+      };
+
+      // Costs only decrease, through compare and swap.
+      std::vector<std::atomic<double>> cost(n);
+      for (auto &c : cost)
+        c.store(MAX_D, std::memory_order_relaxed);
+
+      // Buckets may hold stale or repeated entries, which are skipped with
+      // the stamps of the current bucket.
+      std::map<std::size_t, std::vector<CSRIndex>> buckets;
+      for (std::size_t i = 0; i < _sourceCount; ++i)
+      {
+        const CSRIndex source = _graph.Index(_sources[i]);
+        cost[source].store(0.0, std::memory_order_relaxed);
+        buckets[0].push_back(source);
+      }
+
+      // Vertices improved by each thread, in the current bucket or in
+      // later ones.
+      std::vector<std::vector<CSRIndex>> light;
+      std::vector<std::vector<std::pair<std::size_t, CSRIndex>>> later;
+      std::vector<std::size_t> frontierStamp(n, 0);
+      std::vector<std::size_t> settledStamp(n, 0);
+      std::vector<CSRIndex> frontier;
+      std::vector<CSRIndex> current;
+      std::vector<CSRIndex> settled;
+      std::size_t currentRound = 0;
+
+      // Relax the light or heavy arcs of a range of vertices.
+      auto relax = [&](const std::vector<CSRIndex> &_vertices,
+                       const bool _heavy, const std::size_t _bucket)
+      {
+        std::size_t arcs = 0;
+        for (const CSRIndex u : _vertices)
+          arcs += offsets[u + 1] - offsets[u];
+        const std::size_t blocks = std::min<std::size_t>(_vertices.size(),
+            BlockCount(arcs, kMinArcsPerThread, threads));
+        light.resize(blocks);
+        later.resize(blocks);
+        ++currentRound;
+
+        ForEachBlock(_vertices.size(), blocks,
+          [&](std::size_t _b, std::size_t _begin, std::size_t _end)
+          {
+            light[_b].clear();
+            later[_b].clear();
+            for (std::size_t i = _begin; i < _end; ++i)
+            {
+              const CSRIndex u = _vertices[i];
+              const double uCost = cost[u].load(std::memory_order_relaxed);
+              for (CSRIndex arc = offsets[u]; arc < offsets[u + 1]; ++arc)
+              {
+                if ((weights[arc] > _delta) != _heavy)
+                  continue;
+
+                const CSRIndex v = targets[arc];
+                const double vCost = uCost + weights[arc];
+                double old = cost[v].load(std::memory_order_relaxed);
+                while (vCost < old)
+                {
+                  if (cost[v].compare_exchange_weak(old, vCost,
+                        std::memory_order_relaxed))
+                  {
+                    // Rounding may put a cost below the current bucket.
+                    const std::size_t b = std::max(bucketOf(vCost), _bucket);
+                    if (b == _bucket)
+                      light[_b].push_back(v);
+                    else
+                      later[_b].emplace_back(b, v);
+                    break;
+                  }
+                }
+              }
+            }
+          });
+
+        frontier.clear();
+        for (std::size_t b = 0; b < blocks; ++b)
+        {
+          for (const CSRIndex v : light[b])
+          {
+            if (frontierStamp[v] != currentRound)
+            {
+              frontierStamp[v] = currentRound;
+              frontier.push_back(v);
+            }
+          }
+          for (const auto &entry : later[b])
+            buckets[entry.first].push_back(entry.second);
+        }
+      };
+
+      while (!buckets.empty())
+      {
+        const std::size_t bucket = buckets.begin()->first;
+        std::vector<CSRIndex> entries = std::move(buckets.begin()->second);
+        buckets.erase(buckets.begin());
+
+        // Stamp 0 is never a round, so the stamps start past it.
+        ++currentRound;
+        frontier.clear();
+        for (const CSRIndex v : entries)
+        {
+          if (frontierStamp[v] != currentRound &&
+              bucketOf(cost[v].load(std::memory_order_relaxed)) == bucket)
+          {
+            frontierStamp[v] = currentRound;
+            frontier.push_back(v);
+          }
+        }
+
+        // Relax light arcs until the bucket stops changing, then the heavy
+        // arcs of every vertex settled in it, which reach later buckets
+        // unless rounding keeps them in this one.
+        settled.clear();
+        while (!frontier.empty())
+        {
+          while (!frontier.empty())
+          {
+            for (const CSRIndex v : frontier)
+            {
+              if (settledStamp[v] != bucket + 1)
+              {
+                settledStamp[v] = bucket + 1;
+                settled.push_back(v);
+              }
+            }
+            current.swap(frontier);
+            relax(current, false, bucket);
+          }
+          relax(settled, true, bucket);
+        }
+      }
+
+      // The previous vertices can't follow the compare and swap of the
+      // costs. They come from a parallel breadth first search over the
+      // arcs that lie on shortest paths, which gives a tree even with
+      // arcs of zero weight.
+      std::vector<std::atomic<CSRIndex>> previous(n);
+      for (auto &p : previous)
+        p.store(kNullIndex, std::memory_order_relaxed);
+      frontier.clear();
+      for (std::size_t i = 0; i < _sourceCount; ++i)
+      {
+        const CSRIndex source = _graph.Index(_sources[i]);
+        if (previous[source].load(std::memory_order_relaxed) == kNullIndex)
+        {
+          previous[source].store(source, std::memory_order_relaxed);
+          frontier.push_back(source);
+        }
+      }
+
+      while (!frontier.empty())
+      {
+        std::size_t arcs = 0;
+        for (const CSRIndex u : frontier)
+          arcs += offsets[u + 1] - offsets[u];
+        const std::size_t blocks = std::min<std::size_t>(frontier.size(),
+            BlockCount(arcs, kMinArcsPerThread, threads));
+        light.resize(blocks);
+
+        ForEachBlock(frontier.size(), blocks,
+          [&](std::size_t _b, std::size_t _begin, std::size_t _end)
+          {
+            light[_b].clear();
+            for (std::size_t i = _begin; i < _end; ++i)
+            {
+              const CSRIndex u = frontier[i];
+              const double uCost = cost[u].load(std::memory_order_relaxed);
+              for (CSRIndex arc = offsets[u]; arc < offsets[u + 1]; ++arc)
+              {
+                const CSRIndex v = targets[arc];
+                // The arc is on a shortest path if it gives the same sum
+                // as the one that set the cost, bit for bit.
+                const double through = uCost + weights[arc];
+                const double vCost = cost[v].load(std::memory_order_relaxed);
+                CSRIndex unvisited = kNullIndex;
+                if (std::memcmp(&through, &vCost, sizeof(double)) == 0 &&
+                    previous[v].load(std::memory_order_relaxed) ==
+                      kNullIndex &&
+                    previous[v].compare_exchange_strong(unvisited, u,
+                      std::memory_order_relaxed))
+                {
+                  light[_b].push_back(v);
+                }
+              }
+            }
+          });
+
+        frontier.clear();
+        for (std::size_t b = 0; b < blocks; ++b)
+          frontier.insert(frontier.end(), light[b].begin(), light[b].end());
+      }
+
+      std::vector<CostInfo> res(n);
+      for (CSRIndex i = 0; i < n; ++i)
+      {
+        res[i] = std::make_pair(cost[i].load(std::memory_order_relaxed),
+            _graph.Id(previous[i].load(std::memory_order_relaxed)));
+      }
+      return res;
+    }
+  }
+
+  /// \brief Parallel single source shortest paths over a CSRGraph, with the
+  /// delta-stepping algorithm of Meyer and Sanders.
+  ///
+  /// Vertices are kept in buckets of costs of width _delta. The smallest
+  /// bucket is emptied in rounds: each round relaxes the light arcs, of
+  /// weight up to _delta, of the vertices that entered the bucket in the
+  /// previous round. Once no vertex enters the bucket, the heavy arcs of
+  /// its vertices are relaxed in a single round. The vertices of a round
+  /// are split among threads, and costs are lowered with atomic compare
+  /// and swap. A small _delta does the same work as Dijkstra() with less
+  /// parallelism, while a large one relaxes some arcs several times, as
+  /// Bellman-Ford does.
+  ///
+  /// The costs are the same as those of Dijkstra(), and the weights must
+  /// not be negative. When several shortest paths reach a vertex, the
+  /// previous vertex may differ from the one of Dijkstra(), and between
+  /// calls with several threads.
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _delta Width of the buckets. A value that isn't positive
+  /// uses the largest weight over the average out degree.
+  /// \param[in] _threads Number of threads used by each round. A value of 0
+  /// uses the number of hardware threads. Rounds with little work always
+  /// use a single thread.
+  /// \return A vector with one entry per vertex, indexed by the dense
+  /// vertex index, as in Dijkstra(const CSRGraph &, const VertexId &,
+  /// const VertexId &). Unreachable vertices have a cost of MAX_D and a
+  /// previous vertex of kNullId. If the source vertex doesn't exist, the
+  /// function will return an empty vector.
+  inline std::vector<CostInfo> DeltaStepping(const CSRGraph &_graph,
+                                             const VertexId &_from,
+                                             const double _delta = 0.0,
+                                             const unsigned int _threads = 1)
+  {
+    return detail::DeltaStepping(_graph, &_from, 1, _delta, _threads);
+  }
+
+  /// \brief Parallel shortest paths over a CSRGraph from several source
+  /// vertices. Same as the single source version, but every vertex gets
+  /// the cost of the shortest path from any of the sources. The sources
+  /// have a cost of 0 and are their own previous vertex.
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _sources The starting vertices.
+  /// \param[in] _delta Width of the buckets, or a value that isn't positive
+  /// to choose it from the weights.
+  /// \param[in] _threads Number of threads, 0 for the number of hardware
+  /// threads.
+  /// \return A vector with one entry per vertex, indexed by the dense
+  /// vertex index. If there are no sources, or if a source vertex doesn't
+  /// exist, the function will return an empty vector.
+  inline std::vector<CostInfo> DeltaStepping(const CSRGraph &_graph,
+      const std::vector<VertexId> &_sources, const double _delta = 0.0,
+      const unsigned int _threads = 1)
+  {
+    return detail::DeltaStepping(_graph, _sources.data(), _sources.size(),
+                                 _delta, _threads);
+  }
+
+  /// \brief Compute the costs of the shortest paths from several source
+  /// vertices to several target vertices of a CSRGraph, such as between
+  /// robots and tasks.
+  ///
+  /// Each source runs its own Dijkstra() search, which stops once every
+  /// target is settled. The sources are split in contiguous blocks, one
+  /// per thread, and each thread reuses a single SearchWorkspace. The
+  /// graph is only read, and each search writes its own row of the table.
+  /// A ContractionHierarchy of the graph computes the same table faster
+  /// with ContractionHierarchy::DistanceTable().
+  /// \param[in] _graph A CSR graph.
+  /// \param[in] _sources The source vertices, one row each.
+  /// \param[in] _targets The target vertices, one column each.
+  /// \param[out] _table Row major table of _sources.size() rows and
+  /// _targets.size() columns. The entry of source i and target j is at
+  /// i * _targets.size() + j, and is MAX_D if the target can't be reached.
+  /// The table is cleared on error.
+  /// \param[in] _threads Number of threads. A value of 0 uses the number of
+  /// hardware threads.
+  /// \return False if a source or target vertex doesn't exist.
+  inline bool DistanceTable(const CSRGraph &_graph,
+                            const std::vector<VertexId> &_sources,
+                            const std::vector<VertexId> &_targets,
+                            std::vector<double> &_table,
+                            const unsigned int _threads = 1)
+  {
+    IGN_MATH_TRACE_ZONE("DistanceTable(CSRGraph)");
+    _table.clear();
+    for (const auto *list : {&_sources, &_targets})
+    {
+      for (const VertexId &id : *list)
+      {
+        if (_graph.Index(id) == kNullIndex)
+        {
+          IGN_MATH_DIAGNOSTIC("Vertex [" << id << "] Not found");
+          return false;
+        }
+      }
+    }
+
+    const std::size_t columns = _targets.size();
+    _table.assign(_sources.size() * columns, MAX_D);
+    if (columns == 0)
+      return true;
+
+    std::vector<CSRIndex> targets(columns);
+    for (std::size_t j = 0; j < columns; ++j)
+      targets[j] = _graph.Index(_targets[j]);
+
+    detail::ForEachBlock(_sources.size(),
+      detail::BlockCount(_sources.size(), 1, _threads),
+      [&](std::size_t, std::size_t _begin, std::size_t _end)
+      {
+        SearchWorkspace workspace;
+        detail::NoSearchStats stats;
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          detail::Dijkstra(_graph, &_sources[i], 1, workspace,
+                           _targets.data(), columns, stats);
+          double *row = _table.data() + i * columns;
+          for (std::size_t j = 0; j < columns; ++j)
+            row[j] = workspace.Cost(targets[j]);
+        }
+      });
+
+    return true;
+  }
+
+  /// \brief Compute the costs of the shortest paths from several source
+  /// vertices to several target vertices of a graph. The graph is
+  /// converted to a CSRGraph once, which is cheaper than a single search
+  /// with the std::map of Dijkstra(const Graph &, const VertexId &,
+  /// const VertexId &).
+  /// \sa DistanceTable(const CSRGraph &, const std::vector<VertexId> &,
+  /// const std::vector<VertexId> &, std::vector<double> &,
+  /// const unsigned int)
+  /// \param[in] _graph A graph.
+  /// \param[in] _sources The source vertices, one row each.
+  /// \param[in] _targets The target vertices, one column each.
+  /// \param[out] _table Row major table of costs, MAX_D for targets that
+  /// can't be reached.
+  /// \param[in] _threads Number of threads, 0 for the number of hardware
+  /// threads.
+  /// \return False if a source or target vertex doesn't exist.
+  template<typename V, typename E, typename EdgeType>
+  bool DistanceTable(const Graph<V, E, EdgeType> &_graph,
+                     const std::vector<VertexId> &_sources,
+                     const std::vector<VertexId> &_targets,
+                     std::vector<double> &_table,
+                     const unsigned int _threads = 1)
+  {
+    return DistanceTable(CSRGraph(_graph), _sources, _targets, _table,
+                         _threads);
+  }
+
+  /// \brief Label the connected components of a CSRGraph built from an
+  /// undirected graph, using a concurrent union-find forest.
+  ///
+  /// Each thread merges the endpoints of a contiguous block of arcs, with
+  /// roughly the same number of arcs per block. Every edge is stored as
+  /// two arcs, so only the arcs pointing to a smaller index are used.
+  /// The root of each set is always its smallest vertex index, so the
+  /// result does not depend on the number of threads.
+  /// \sa ConnectedComponents(const CSRGraph &)
+  /// \param[in] _graph A CSR graph built from an undirected graph.
+  /// \param[out] _labels Component of each vertex, indexed by dense vertex
+  /// index. Components are numbered from 0 in the order of their smallest
+  /// vertex Id, as in ConnectedComponents(const CSRGraph &). The vector
+  /// is resized to the number of vertices, or cleared on error.
+  /// \param[in] _threads Number of threads. A value of 0 uses the number of
+  /// hardware threads. Small graphs always use a single thread.
+  /// \return The number of components, or 0 if _graph was built from a
+  /// directed graph.
+  inline CSRIndex ConnectedComponents(const CSRGraph &_graph,
+                                      std::vector<CSRIndex> &_labels,
+                                      const unsigned int _threads = 1)
+  {
+    // Minimum number of arcs or vertices processed by each thread.
+    const std::size_t kMinPerThread = 16384;
+
+    _labels.clear();
+    if (_graph.Directed())
+    {
+      IGN_MATH_DIAGNOSTIC("[ConnectedComponents] The graph must be undirected");
+      return 0;
+    }
+
+    const CSRIndex n = _graph.VertexCount();
+    const auto &offsets = _graph.Offsets();
+    const auto &targets = _graph.Targets();
+
+    std::vector<std::atomic<CSRIndex>> parent(n);
+    for (CSRIndex i = 0; i < n; ++i)
+      parent[i].store(i, std::memory_order_relaxed);
+
+    const std::size_t arcs = _graph.ArcCount();
+    detail::ForEachBlock(arcs,
+      detail::BlockCount(arcs, kMinPerThread, _threads),
+      [&](std::size_t, std::size_t _begin, std::size_t _end)
+      {
+        if (_begin == _end)
+          return;
+
+        // Source vertex of the first arc of the block.
+        CSRIndex u = static_cast<CSRIndex>(std::upper_bound(
+            offsets.begin(), offsets.end(), _begin) - offsets.begin() - 1);
+        for (std::size_t arc = _begin; arc < _end; ++arc)
+        {
+          while (offsets[u + 1] <= arc)
+            ++u;
+
+          const CSRIndex v = targets[arc];
+          if (v < u)
+            detail::Unite(parent, u, v);
+        }
+      });
+
+    // Number the roots in increasing order, then label every vertex with
+    // the number of its root.
+    _labels.resize(n);
+    CSRIndex count = 0;
+    for (CSRIndex i = 0; i < n; ++i)
+    {
+      if (parent[i].load(std::memory_order_relaxed) == i)
+        _labels[i] = count++;
+    }
+
+    detail::ForEachBlock(n, detail::BlockCount(n, kMinPerThread, _threads),
+      [&](std::size_t, std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const CSRIndex root =
+            detail::FindRoot(parent, static_cast<CSRIndex>(i));
+          // Roots already hold their number and are only read here.
+          if (root != i)
+            _labels[i] = _labels[root];
+        }
+      });
+
+    return count;
+  }
+
+  namespace detail
+  {
+    /// \brief An edge that may join a minimum spanning forest.
+    struct SpanningEdge
+    {
+      /// \brief Weight of the edge.
+      double weight;
+
+      /// \brief Id of the edge.
+      EdgeId id;
+
+      /// \brief Dense index of the first vertex.
+      CSRIndex u;
+
+      /// \brief Dense index of the second vertex.
+      CSRIndex v;
+    };
+
+    /// \brief Kruskal algorithm: add the edges by increasing weight,
+    /// skipping those that would close a cycle, which the union-find
+    /// forest of ConnectedComponents() detects.
+    /// \param[in] _vertexCount Number of vertices.
+    /// \param[in,out] _edges Candidate edges, without self loops. They are
+    /// sorted by weight, then by Id to break ties.
+    /// \return Ids of the edges of the forest, by increasing weight.
+    inline std::vector<EdgeId> Kruskal(const CSRIndex _vertexCount,
+                                       std::vector<SpanningEdge> &_edges)
+    {
+      std::sort(_edges.begin(), _edges.end(),
+        [](const SpanningEdge &_a, const SpanningEdge &_b)
+        {
+          return _a.weight < _b.weight ||
+            (!(_b.weight < _a.weight) && _a.id < _b.id);
+        });
+
+      std::vector<std::atomic<CSRIndex>> parent(_vertexCount);
+      for (CSRIndex i = 0; i < _vertexCount; ++i)
+        parent[i].store(i, std::memory_order_relaxed);
+
+      std::vector<EdgeId> res;
+      for (const SpanningEdge &edge : _edges)
+      {
+        // A spanning tree of n vertices has n - 1 edges.
+        if (res.size() + 1 >= _vertexCount)
+          break;
+        if (Unite(parent, edge.u, edge.v))
+          res.push_back(edge.id);
+      }
+      return res;
+    }
+  }
+
+  /// \brief Compute a minimum spanning forest of an undirected graph: a
+  /// minimum spanning tree of each connected component, with Kruskal
+  /// algorithm in O(E log E). Parallel edges and self loops are allowed.
+  /// \sa https://en.wikipedia.org/wiki/Kruskal%27s_algorithm
+  /// \param[in] _graph A graph. It must outlive the view and must not be
+  /// modified while it is in use.
+  /// \return A view with every vertex of the graph and the edges of the
+  /// forest. Among edges of equal weight, the smallest Ids are preferred.
+  template<typename V, typename E>
+  SubgraphView<V, E, UndirectedEdge<E>> MinimumSpanningForest(
+    const UndirectedGraph<V, E> &_graph)
+  {
+    std::vector<VertexId> ids;
+    _graph.ForEachVertex([&ids](const Vertex<V> &_v)
+    {
+      ids.push_back(_v.Id());
+    });
+
+    auto position = [&ids](const VertexId &_id)
+    {
+      return static_cast<CSRIndex>(
+          std::lower_bound(ids.begin(), ids.end(), _id) - ids.begin());
+    };
+
+    std::vector<detail::SpanningEdge> candidates;
+    _graph.ForEachEdge([&](const UndirectedEdge<E> &_edge)
+    {
+      const VertexId_P vertices = _edge.Vertices();
+      if (vertices.first != vertices.second)
+      {
+        candidates.push_back({_edge.Weight(), _edge.Id(),
+            position(vertices.first), position(vertices.second)});
+      }
+    });
+
+    std::vector<EdgeId> edges = detail::Kruskal(
+        static_cast<CSRIndex>(ids.size()), candidates);
+    std::sort(edges.begin(), edges.end());
+    return SubgraphView<V, E, UndirectedEdge<E>>(_graph, std::move(ids),
+                                                 std::move(edges));
+  }
+
+  /// \brief Compute a minimum spanning forest of a CSRGraph built from an
+  /// undirected graph, with Kruskal algorithm.
+  /// \sa MinimumSpanningForest(const UndirectedGraph &)
+  /// \param[in] _graph A CSR graph built from an undirected graph.
+  /// \return Ids of the edges of the forest, by increasing weight. An
+  /// empty vector is returned if _graph was built from a directed graph.
+  inline std::vector<EdgeId> MinimumSpanningForest(const CSRGraph &_graph)
+  {
+    if (_graph.Directed())
+    {
+      IGN_MATH_DIAGNOSTIC(
+          "[MinimumSpanningForest] The graph must be undirected");
+      return {};
+    }
+
+    const auto &offsets = _graph.Offsets();
+    const auto &targets = _graph.Targets();
+    const auto &weights = _graph.Weights();
+    const auto &edgeIds = _graph.EdgeIds();
+
+    // Every edge is stored as two arcs, so only the arcs pointing to a
+    // larger index are used.
+    std::vector<detail::SpanningEdge> candidates;
+    candidates.reserve(_graph.ArcCount() / 2);
+    for (CSRIndex u = 0; u < _graph.VertexCount(); ++u)
+    {
+      for (CSRIndex arc = offsets[u]; arc < offsets[u + 1]; ++arc)
+      {
+        if (targets[arc] > u)
+          candidates.push_back({weights[arc], edgeIds[arc], u, targets[arc]});
+      }
+    }
+
+    return detail::Kruskal(_graph.VertexCount(), candidates);
+  }
+
+  /// \brief Compute a minimum spanning tree of the connected component of
+  /// a vertex in a CSRGraph built from an undirected graph, with Prim
+  /// algorithm in O(E log V), reusing the memory of a workspace. Nothing is
+  /// allocated once the workspace and _edges have grown to the size of the
+  /// graph, which suits a tree computed again every cycle.
+  /// After the search, SearchWorkspace::Previous() gives the parent of
+  /// each vertex of the tree and SearchWorkspace::Cost() the weight of the
+  /// edge to its parent.
+  /// \sa https://en.wikipedia.org/wiki/Prim%27s_algorithm
+  /// \param[in] _graph A CSR graph built from an undirected graph.
+  /// \param[in] _root A vertex of the component.
+  /// \param[in, out] _workspace Memory of the search.
+  /// \param[out] _edges Ids of the edges of the tree, in the order they
+  /// were added. It is cleared first.
+  /// \return False if _graph was built from a directed graph or if _root
+  /// doesn't exist.
+  inline bool MinimumSpanningTree(const CSRGraph &_graph,
+                                  const VertexId &_root,
+                                  SearchWorkspace &_workspace,
+                                  std::vector<EdgeId> &_edges)
+  {
+    _edges.clear();
+    if (_graph.Directed())
+    {
+      IGN_MATH_DIAGNOSTIC("[MinimumSpanningTree] The graph must be undirected");
+      return false;
+    }
+
+    const CSRIndex root = _graph.Index(_root);
+    if (root == kNullIndex)
+    {
+      IGN_MATH_DIAGNOSTIC("Vertex [" << _root << "] Not found");
+      return false;
+    }
+
+    const auto &offsets = _graph.Offsets();
+    const auto &targets = _graph.Targets();
+    const auto &weights = _graph.Weights();
+    const auto &edgeIds = _graph.EdgeIds();
+
+    // The key of a vertex is the weight of its lightest edge to the tree.
+    _workspace.Reset(_graph.VertexCount());
+    _workspace.Push(root, 0.0, root);
+    while (!_workspace.QueueEmpty())
+    {
+      const CSRIndex u = _workspace.Pop();
+      if (u != root)
+      {
+        // Find the lightest of the arcs back to the parent, which are
+        // contiguous since rows are sorted by target.
+        const CSRIndex parent = _workspace.Previous(u);
+        const CSRIndex *row = targets.data();
+        CSRIndex best = static_cast<CSRIndex>(std::lower_bound(
+            row + offsets[u], row + offsets[u + 1], parent) - row);
+        for (CSRIndex arc = best + 1;
+             arc < offsets[u + 1] && targets[arc] == parent; ++arc)
+        {
+          if (weights[arc] < weights[best])
+            best = arc;
+        }
+        _edges.push_back(edgeIds[best]);
+      }
+
+      for (CSRIndex arc = offsets[u]; arc < offsets[u + 1]; ++arc)
+        _workspace.Push(targets[arc], weights[arc], u);
+    }
+
+    return true;
+  }
+
+  /// \brief Sort the vertices of a directed acyclic graph so that every
+  /// edge goes from a vertex to a later one, with Kahn algorithm in
+  /// O(V + E). Vertices are emitted as soon as all their predecessors are,
+  /// starting with the vertices without incoming edges in ascending Id
+  /// order, so the result is the same on every run.
+  /// \sa https://en.wikipedia.org/wiki/Topological_sorting
+  /// \param[in] _graph A directed graph.
+  /// \return The Ids of all the vertices in topological order. An empty
+  /// vector is returned if the graph has a cycle, including a self loop.
+  template<typename V, typename E>
+  std::vector<VertexId> TopologicalSort(const DirectedGraph<V, E> &_graph)
+  {
+    std::vector<VertexId> ids;
+    _graph.ForEachVertex([&ids](const Vertex<V> &_v)
+    {
+      ids.push_back(_v.Id());
+    });
+
+    auto position = [&ids](const VertexId &_id)
+    {
+      return static_cast<std::size_t>(
+          std::lower_bound(ids.begin(), ids.end(), _id) - ids.begin());
+    };
+
+    std::vector<std::size_t> inDegree(ids.size(), 0);
+    _graph.ForEachEdge([&](const DirectedEdge<E> &_edge)
+    {
+      ++inDegree[position(_edge.Head())];
+    });
+
+    // The result doubles as the queue of vertices whose predecessors are
+    // all sorted.
+    std::vector<VertexId> res;
+    res.reserve(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+      if (inDegree[i] == 0)
+        res.push_back(ids[i]);
+    }
+
+    for (std::size_t head = 0; head < res.size(); ++head)
+    {
+      _graph.ForEachIncidentFrom(res[head], [&](const DirectedEdge<E> &_e)
+      {
+        const VertexId v = _e.Head();
+        if (--inDegree[position(v)] == 0)
+          res.push_back(v);
+      });
+    }
+
+    // Vertices on a cycle never run out of predecessors.
+    if (res.size() != ids.size())
+      return {};
+
+    return res;
+  }
 }
 }
 }
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRAPH_GRAPHPUBLISHER_HH_
+#define GZ_MATH_GRAPH_GRAPHPUBLISHER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <gz/math/config.hh>
+#include "gz/math/graph/CSRGraph.hh"
+#include "gz/math/graph/Graph.hh"
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+namespace graph
+{
+  /// \brief Shares immutable snapshots of a changing graph with reader
+  /// threads.
+  ///
+  /// A Graph can't be read while another thread modifies it. Instead, the
+  /// thread that owns the graph freezes it into a CSRGraph after a batch of
+  /// edits and publishes it. Readers get the latest snapshot with Load(),
+  /// and run the CSRGraph algorithms on it without any lock: a snapshot
+  /// never changes, and it stays alive as long as a reader holds it, even
+  /// after newer snapshots are published.
+  ///
+  /// Load() only copies a shared pointer atomically, so it is cheap enough
+  /// to call once per query. Publish() builds the snapshot before swapping
+  /// it in, so readers never wait for a build. Publishing is serialized,
+  /// and versions are published in increasing order.
+  ///
+  /// A snapshot holds the topology and the weights. Vertex and edge user
+  /// data stay in the mutable graph and are not safe to read from other
+  /// threads.
+  ///
+  /// <b>Example</b>
+  /// \code{.cpp}
+  /// gz::math::graph::GraphPublisher publisher;
+  ///
+  /// // Updater thread.
+  /// graph.SetEdgeWeight(7, 10.0);
+  /// publisher.Publish(graph);
+  ///
+  /// // Reader threads.
+  /// auto snapshot = publisher.Load();
+  /// auto res = gz::math::graph::Dijkstra(snapshot->graph, 0);
+  /// \endcode
+  class GraphPublisher
+  {
+    /// \brief An immutable snapshot of a graph.
+    public: struct Snapshot
+    {
+      /// \brief The frozen graph.
+      CSRGraph graph;
+
+      /// \brief Version of the snapshot, incremented by each publication.
+      /// The empty snapshot of a new publisher has version 0.
+      uint64_t version = 0;
+    };
+
+    /// \brief Default constructor. Publishes an empty graph with version 0.
+    public: GraphPublisher()
+      : current(std::make_shared<const Snapshot>())
+    {
+    }
+
+    /// \brief Get the latest snapshot. This is safe to call from any
+    /// number of threads while another thread publishes.
+    /// \return The snapshot, never null.
+    public: std::shared_ptr<const Snapshot> Load() const
+    {
+      return std::atomic_load(&this->current);
+    }
+
+    /// \brief Freeze a graph and publish it. The graph must not be
+    /// modified during the call.
+    /// \param[in] _graph The graph.
+    /// \return The version of the new snapshot.
+    public: template<typename V, typename E, typename EdgeType>
+    uint64_t Publish(const Graph<V, E, EdgeType> &_graph)
+    {
+      return this->Publish(CSRGraph(_graph));
+    }
+
+    /// \brief Publish a CSR graph.
+    /// \param[in] _graph The graph, moved into the snapshot.
+    /// \return The version of the new snapshot.
+    public: uint64_t Publish(CSRGraph _graph)
+    {
+      auto snapshot = std::make_shared<Snapshot>();
+      snapshot->graph = std::move(_graph);
+
+      std::lock_guard<std::mutex> lock(this->publishMutex);
+      snapshot->version = std::atomic_load(&this->current)->version + 1;
+      const uint64_t version = snapshot->version;
+      std::atomic_store(&this->current,
+                        std::shared_ptr<const Snapshot>(std::move(snapshot)));
+      return version;
+    }
+
+    /// \brief The latest snapshot, only accessed atomically.
+    private: std::shared_ptr<const Snapshot> current;
+
+    /// \brief Serializes publications.
+    private: std::mutex publishMutex;
+  };
+}
+}
+}
+}
+#endif
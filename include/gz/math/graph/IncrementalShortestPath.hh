@@ -0,0 +1,403 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRAPH_INCREMENTALSHORTESTPATH_HH_
+#define GZ_MATH_GRAPH_INCREMENTALSHORTESTPATH_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+#include "gz/math/Helpers.hh"
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+namespace graph
+{
+  /// \brief Shortest paths from a source vertex that are repaired, rather
+  /// than computed again, when edge weights change.
+  ///
+  /// This is Lifelong Planning A* (LPA*). Every vertex keeps its cost g
+  /// and a one step lookahead rhs, the best cost offered by its incoming
+  /// edges. A weight change only makes the end of the edge inconsistent,
+  /// and Repair() propagates the change through the vertices whose cost
+  /// actually changes, in order of cost, so a local change such as a
+  /// blocked corridor expands a small part of the graph.
+  ///
+  /// Without a destination vertex, the shortest paths to every vertex are
+  /// maintained, like an incremental Dijkstra. With a destination, only
+  /// the path to it is kept up to date, and an optional heuristic focuses
+  /// the search like AStar(). The heuristic must be consistent.
+  ///
+  /// The planner keeps a reference to the graph, which must outlive it.
+  /// Change weights with Graph::SetEdgeWeight() and then call UpdateEdge().
+  /// Weights must not be negative; an infinite weight blocks an edge. Zero
+  /// weights are allowed: LPA* needs positive edge costs, or the vertices
+  /// of a zero weight cycle keep each other at a stale cost when a cost
+  /// goes up, so paths are compared by cost and then by number of edges.
+  /// The vertices and edges of the graph must not be added or removed.
+  ///
+  /// <b>Example</b>
+  /// \code{.cpp}
+  /// gz::math::graph::UndirectedGraph<int, double> graph(...);
+  /// gz::math::graph::IncrementalShortestPath planner(graph, 0, 42);
+  /// auto path = planner.ShortestPath();
+  ///
+  /// // A corridor becomes blocked.
+  /// graph.SetEdgeWeight(7, std::numeric_limits<double>::infinity());
+  /// planner.UpdateEdge(7);
+  /// path = planner.ShortestPath();
+  /// \endcode
+  template<typename V, typename E, typename EdgeType>
+  class IncrementalShortestPath
+  {
+    /// \brief Function estimating the cost from a vertex to the
+    /// destination.
+    public: using Heuristic = std::function<double(const VertexId &)>;
+
+    /// \brief Constructor. The paths are computed by the first query.
+    /// \param[in] _graph The graph.
+    /// \param[in] _from The source vertex.
+    /// \param[in] _to Optional destination vertex.
+    /// \param[in] _heuristic Optional heuristic, only used with a
+    /// destination vertex.
+    public: IncrementalShortestPath(const Graph<V, E, EdgeType> &_graph,
+                                    const VertexId &_from,
+                                    const VertexId &_to = kNullId,
+                                    Heuristic _heuristic = nullptr)
+      : graph(_graph), from(_from), to(_to),
+        heuristic(std::move(_heuristic))
+    {
+      // Sanity check: The source and destination vertices should exist.
+      for (auto const &id : {_from, _to})
+      {
+        if (id != kNullId && !_graph.VertexFromId(id).Valid())
+        {
+          IGN_MATH_DIAGNOSTIC("Vertex [" << id << "] Not found");
+          this->from = kNullId;
+          return;
+        }
+      }
+
+      if (this->to == kNullId)
+        this->heuristic = nullptr;
+
+      if (this->from != kNullId)
+      {
+        State &source = this->states[this->from];
+        source.rhs = PathCost(0.0, 0u);
+        source.parent = this->from;
+        this->Enqueue(this->from, source);
+      }
+    }
+
+    /// \brief Get whether the source and destination vertices exist.
+    /// \return True if the planner can answer queries.
+    public: bool Valid() const
+    {
+      return this->from != kNullId;
+    }
+
+    /// \brief Tell the planner that the weight of an edge changed.
+    /// The work is done by the next query or call to Repair().
+    /// \param[in] _id Id of the edge.
+    /// \return True if the edge exists.
+    public: bool UpdateEdge(const EdgeId &_id)
+    {
+      const EdgeType &edge = this->graph.EdgeFromId(_id);
+      if (edge.Id() == kNullId)
+      {
+        IGN_MATH_DIAGNOSTIC("Edge [" << _id << "] Not found");
+        return false;
+      }
+
+      if (!this->Valid())
+        return true;
+
+      // Update the ends that the edge leads to.
+      const auto vertices = edge.Vertices();
+      if (edge.From(vertices.first) == vertices.second)
+        this->UpdateVertex(vertices.second);
+      if (vertices.first != vertices.second &&
+          edge.From(vertices.second) == vertices.first)
+      {
+        this->UpdateVertex(vertices.first);
+      }
+      return true;
+    }
+
+    /// \brief Bring the shortest paths up to date after edge updates.
+    /// Queries call it, so calling it directly is only needed to control
+    /// when the work is done.
+    /// \return Number of vertices expanded, 0 if nothing changed.
+    public: std::size_t Repair()
+    {
+      std::size_t expanded = 0;
+      while (!this->queue.empty())
+      {
+        // With a destination, stop once it is consistent and no queued
+        // vertex can improve it.
+        if (this->to != kNullId)
+        {
+          const State &goal = this->StateOf(this->to);
+          if (Consistent(goal) &&
+              !(this->queue.begin()->first < this->Key(this->to, goal)))
+          {
+            break;
+          }
+        }
+
+        const VertexId u = this->queue.begin()->second;
+        this->queue.erase(this->queue.begin());
+        State &state = this->states[u];
+        state.queued = false;
+        ++expanded;
+
+        if (state.g > state.rhs)
+        {
+          // The cost of u went down and is now final.
+          state.g = state.rhs;
+        }
+        else
+        {
+          // The cost of u went up. Make it unknown and let its incoming
+          // edges offer a new one.
+          state.g = kUnreached;
+          this->UpdateVertex(u);
+        }
+
+        this->graph.ForEachIncidentFrom(u, [&](const EdgeType &_edge)
+        {
+          this->UpdateVertex(_edge.From(u));
+        });
+      }
+
+      this->expandedCount += expanded;
+      return expanded;
+    }
+
+    /// \brief Get the cost of the shortest path to a vertex.
+    /// \param[in] _to The vertex. With a destination vertex in the
+    /// constructor, only the destination is guaranteed to be exact.
+    /// \return The cost, or MAX_D if the vertex can't be reached or
+    /// doesn't exist.
+    public: double Cost(const VertexId &_to)
+    {
+      this->Repair();
+      const double g = this->StateOf(_to).g.first;
+      return g < kInf ? g : MAX_D;
+    }
+
+    /// \brief Get the shortest path to a vertex.
+    /// \param[in] _to The vertex. With a destination vertex in the
+    /// constructor, only the destination is guaranteed to be exact.
+    /// \return The cost and the vertices of the shortest path, including
+    /// the source and _to. If _to cannot be reached or doesn't exist, the
+    /// cost is MAX_D and the path is empty.
+    public: PathInfo ShortestPath(const VertexId &_to)
+    {
+      PathInfo res(MAX_D, {});
+      res.first = this->Cost(_to);
+      if (!(res.first < MAX_D))
+        return res;
+
+      // Follow the parents back to the source. Every vertex is visited at
+      // most once.
+      for (VertexId v = _to; res.second.size() <= this->states.size();
+           v = this->StateOf(v).parent)
+      {
+        res.second.push_back(v);
+        if (v == this->from)
+        {
+          std::reverse(res.second.begin(), res.second.end());
+          return res;
+        }
+      }
+
+      return PathInfo(MAX_D, {});
+    }
+
+    /// \brief Get the shortest path to the destination vertex given in
+    /// the constructor.
+    /// \return The cost and the vertices of the shortest path. If the
+    /// destination cannot be reached or there is none, the cost is MAX_D
+    /// and the path is empty.
+    public: PathInfo ShortestPath()
+    {
+      return this->ShortestPath(this->to);
+    }
+
+    /// \brief Get the total number of vertices expanded since the
+    /// planner was created, to compare with searches from scratch.
+    /// \return Number of expanded vertices.
+    public: std::size_t ExpandedCount() const
+    {
+      return this->expandedCount;
+    }
+
+    /// \brief Cost of a path and its number of edges, compared in that
+    /// order, so that every edge has a positive cost.
+    private: using PathCost = std::pair<double, std::size_t>;
+
+    /// \brief Queue key: the cost plus the heuristic, then the cost.
+    private: using QueueKey = std::pair<double, PathCost>;
+
+    /// \brief Search state of a vertex.
+    private: struct State
+    {
+      /// \brief Cost of the vertex.
+      PathCost g = kUnreached;
+
+      /// \brief Best cost offered by the incoming edges.
+      PathCost rhs = kUnreached;
+
+      /// \brief Vertex before this one on the path giving rhs.
+      VertexId parent = kNullId;
+
+      /// \brief Key of the vertex in the queue.
+      QueueKey key;
+
+      /// \brief Whether the vertex is in the queue.
+      bool queued = false;
+    };
+
+    /// \brief Check whether the cost of a vertex matches its lookahead.
+    /// \param[in] _state State of the vertex.
+    /// \return True if the vertex is consistent.
+    private: static bool Consistent(const State &_state)
+    {
+      return !(_state.g < _state.rhs) && !(_state.rhs < _state.g);
+    }
+
+    /// \brief Get the state of a vertex, without creating it.
+    /// \param[in] _id The vertex.
+    /// \return The state, or a state with infinite costs.
+    private: const State &StateOf(const VertexId &_id) const
+    {
+      static const State kUnreachedState;
+      auto it = this->states.find(_id);
+      return it == this->states.end() ? kUnreachedState : it->second;
+    }
+
+    /// \brief Get the cost of a path extended by an edge.
+    /// \param[in] _cost Cost of the path.
+    /// \param[in] _weight Weight of the edge.
+    /// \return The cost, or kUnreached if it is infinite.
+    private: static PathCost Extend(const PathCost &_cost,
+                                    const double _weight)
+    {
+      const double cost = _cost.first + _weight;
+      return cost < kInf ? PathCost(cost, _cost.second + 1) : kUnreached;
+    }
+
+    /// \brief Get the queue key of a vertex.
+    /// \param[in] _id The vertex.
+    /// \param[in] _state State of the vertex.
+    /// \return The key, ordered lexicographically.
+    private: QueueKey Key(const VertexId &_id, const State &_state) const
+    {
+      const PathCost cost = std::min(_state.g, _state.rhs);
+      const double h = this->heuristic ? this->heuristic(_id) : 0.0;
+      return QueueKey(cost.first + h, cost);
+    }
+
+    /// \brief Put a vertex in the queue.
+    /// \param[in] _id The vertex.
+    /// \param[in, out] _state State of the vertex.
+    private: void Enqueue(const VertexId &_id, State &_state)
+    {
+      _state.key = this->Key(_id, _state);
+      _state.queued = true;
+      this->queue.emplace(_state.key, _id);
+    }
+
+    /// \brief Recompute the lookahead of a vertex from its incoming edges
+    /// and queue it if it is inconsistent.
+    /// \param[in] _id The vertex.
+    private: void UpdateVertex(const VertexId &_id)
+    {
+      State &state = this->states[_id];
+      if (_id != this->from)
+      {
+        state.rhs = kUnreached;
+        state.parent = kNullId;
+        this->graph.ForEachIncidentTo(_id, [&](const EdgeType &_edge)
+        {
+          const VertexId p = _edge.To(_id);
+          const PathCost cost = Extend(this->StateOf(p).g, _edge.Weight());
+          if (cost < state.rhs)
+          {
+            state.rhs = cost;
+            state.parent = p;
+          }
+        });
+      }
+
+      if (state.queued)
+      {
+        this->queue.erase(std::make_pair(state.key, _id));
+        state.queued = false;
+      }
+      if (!Consistent(state))
+        this->Enqueue(_id, state);
+    }
+
+    /// \brief Infinite cost of the vertices that are not reached.
+    private: static constexpr double kInf =
+      std::numeric_limits<double>::infinity();
+
+    /// \brief Path cost of the vertices that are not reached.
+    private: static constexpr PathCost kUnreached = PathCost(kInf, 0u);
+
+    /// \brief The graph.
+    private: const Graph<V, E, EdgeType> &graph;
+
+    /// \brief The source vertex, or kNullId if the planner is invalid.
+    private: VertexId from;
+
+    /// \brief The destination vertex, or kNullId.
+    private: VertexId to;
+
+    /// \brief The heuristic, or empty.
+    private: Heuristic heuristic;
+
+    /// \brief State of the vertices that were touched by the search.
+    private: std::unordered_map<VertexId, State> states;
+
+    /// \brief Inconsistent vertices, ordered by key.
+    private: std::set<std::pair<QueueKey, VertexId>> queue;
+
+    /// \brief Total number of expanded vertices.
+    private: std::size_t expandedCount = 0;
+  };
+}
+}
+}
+}
+#endif
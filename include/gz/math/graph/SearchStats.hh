@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRAPH_SEARCHSTATS_HH_
+#define GZ_MATH_GRAPH_SEARCHSTATS_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+namespace graph
+{
+  /// \brief Counters of the work done by graph searches, to tune
+  /// heuristics or spot pathological queries.
+  ///
+  /// The overloads of BreadthFirstSort, DepthFirstSort, Dijkstra and AStar
+  /// in GraphAlgorithms.hh that take a SearchStats add the work of each
+  /// search to it. The counters accumulate over searches until Reset() is
+  /// called, and the peak queue size is the largest of all of them. The
+  /// overloads without a SearchStats are compiled without any counting.
+  ///
+  /// The counters are not synchronized; use one SearchStats per thread and
+  /// merge them with operator+=.
+  ///
+  /// <b>Example</b>
+  /// \code{.cpp}
+  /// gz::math::graph::SearchStats stats;
+  /// gz::math::graph::Dijkstra(csr, from, workspace, to, stats);
+  /// if (stats.expanded > 0.5 * csr.VertexCount())
+  ///   std::cerr << "Slow query from " << from << std::endl;
+  /// \endcode
+  struct SearchStats
+  {
+    /// \brief Number of searches.
+    uint64_t searches = 0;
+
+    /// \brief Number of vertices expanded, whose outgoing edges were
+    /// scanned.
+    uint64_t expanded = 0;
+
+    /// \brief Number of edges scanned from expanded vertices.
+    uint64_t relaxed = 0;
+
+    /// \brief Number of vertices inserted in the queue or the stack, or
+    /// moved up in a priority queue.
+    uint64_t pushes = 0;
+
+    /// \brief Largest number of vertices waiting in the queue or the
+    /// stack at once.
+    uint64_t peakQueueSize = 0;
+
+    /// \brief Set every counter to 0.
+    void Reset()
+    {
+      *this = SearchStats();
+    }
+
+    /// \brief Add the counters of other searches.
+    /// \param[in] _stats Counters to add.
+    /// \return Reference to this object.
+    SearchStats &operator+=(const SearchStats &_stats)
+    {
+      this->searches += _stats.searches;
+      this->expanded += _stats.expanded;
+      this->relaxed += _stats.relaxed;
+      this->pushes += _stats.pushes;
+      this->peakQueueSize = std::max(this->peakQueueSize,
+                                     _stats.peakQueueSize);
+      return *this;
+    }
+
+    /// \brief Count the start of a search.
+    void OnSearch()
+    {
+      ++this->searches;
+    }
+
+    /// \brief Count an expanded vertex.
+    void OnExpand()
+    {
+      ++this->expanded;
+    }
+
+    /// \brief Count a scanned edge.
+    void OnRelax()
+    {
+      ++this->relaxed;
+    }
+
+    /// \brief Count a push.
+    /// \param[in] _queueSize Number of queued vertices after the push.
+    void OnPush(const std::size_t _queueSize)
+    {
+      ++this->pushes;
+      this->peakQueueSize = std::max<uint64_t>(this->peakQueueSize,
+                                               _queueSize);
+    }
+  };
+
+  namespace detail
+  {
+    /// \brief Statistics sink that counts nothing, used by the searches
+    /// called without a SearchStats. Every call is optimized away.
+    struct NoSearchStats
+    {
+      /// \brief Do nothing.
+      void OnSearch() {}
+
+      /// \brief Do nothing.
+      void OnExpand() {}
+
+      /// \brief Do nothing.
+      void OnRelax() {}
+
+      /// \brief Do nothing.
+      void OnPush(const std::size_t) {}
+    };
+  }
+}
+}
+}
+}
+#endif
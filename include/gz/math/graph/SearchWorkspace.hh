@@ -0,0 +1,369 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRAPH_SEARCHWORKSPACE_HH_
+#define GZ_MATH_GRAPH_SEARCHWORKSPACE_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include "gz/math/graph/CSRGraph.hh"
+#include "gz/math/Helpers.hh"
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+namespace graph
+{
+  /// \brief Memory reused by the searches over a CSRGraph, such as the
+  /// overloads of BreadthFirstSort, DepthFirstSort and Dijkstra in
+  /// GraphAlgorithms.hh that take a workspace.
+  ///
+  /// The cost and previous vertex of every vertex are stored in flat
+  /// arrays indexed by the dense vertex index, along with a stamp telling
+  /// which search reached the vertex. Starting a new search only changes
+  /// the current stamp, so a short search costs nothing for the vertices it
+  /// doesn't reach, and no memory is allocated once the arrays have grown
+  /// to the size of the graph. The results of a search stay available
+  /// until the next one starts.
+  ///
+  /// A workspace is not synchronized; use one per thread. Its arrays can
+  /// be placed in a std::pmr::memory_resource, such as a monotonic arena
+  /// released after a batch of queries.
+  ///
+  /// <b>Example</b>
+  /// \code{.cpp}
+  /// gz::math::graph::CSRGraph csr(graph);
+  /// gz::math::graph::SearchWorkspace workspace;
+  /// std::vector<gz::math::graph::VertexId> path;
+  /// for (auto const &query : queries)
+  /// {
+  ///   if (gz::math::graph::Dijkstra(csr, query.from, workspace, query.to))
+  ///     workspace.Path(csr, query.to, path);
+  /// }
+  /// \endcode
+  class SearchWorkspace
+  {
+    /// \brief Default constructor. Creates an empty workspace, which grows
+    /// with the first search.
+    public: SearchWorkspace() = default;
+
+    /// \brief Constructor. Creates an empty workspace whose arrays are
+    /// allocated from a memory resource, which must outlive the workspace.
+    /// \param[in] _resource Memory resource of the arrays.
+    public: explicit SearchWorkspace(std::pmr::memory_resource *_resource)
+      : stamps(_resource), costs(_resource), previous(_resource),
+        positions(_resource), heap(_resource), pending(_resource)
+    {
+    }
+
+    /// \brief Start a new search, forgetting the results of the previous
+    /// one.
+    /// \param[in] _vertexCount Number of vertices of the searched graph.
+    public: void Reset(const CSRIndex _vertexCount)
+    {
+      if (this->stamps.size() < _vertexCount)
+      {
+        this->stamps.resize(_vertexCount, 0);
+        this->costs.resize(_vertexCount, MAX_D);
+        this->previous.resize(_vertexCount, kNullIndex);
+        this->positions.resize(_vertexCount, kNullIndex);
+      }
+      this->vertexCount = _vertexCount;
+
+      // Clear the stamps once they wrap around.
+      if (++this->stamp == 0)
+      {
+        std::fill(this->stamps.begin(), this->stamps.end(), 0);
+        this->stamp = 1;
+      }
+
+      this->heap.clear();
+      this->pending.clear();
+    }
+
+    /// \brief Check whether the current search reached a vertex.
+    /// \param[in] _index Dense index of the vertex.
+    /// \return True if the vertex was reached.
+    public: bool Reached(const CSRIndex _index) const
+    {
+      return _index < this->vertexCount &&
+        this->stamps[_index] == this->stamp;
+    }
+
+    /// \brief Get the cost of the best path found to a vertex by the
+    /// current search. After a breadth first search, it is the number of
+    /// edges from the starting vertex. After a depth first search, it is
+    /// not meaningful.
+    /// \param[in] _index Dense index of the vertex.
+    /// \return The cost, or MAX_D if the vertex was not reached.
+    public: double Cost(const CSRIndex _index) const
+    {
+      return this->Reached(_index) ? this->costs[_index] : MAX_D;
+    }
+
+    /// \brief Get the vertex before a vertex in the best path found by the
+    /// current search. The starting vertex is its own previous vertex.
+    /// \param[in] _index Dense index of the vertex.
+    /// \return Dense index of the previous vertex, or kNullIndex if the
+    /// vertex was not reached.
+    public: CSRIndex Previous(const CSRIndex _index) const
+    {
+      return this->Reached(_index) ? this->previous[_index] : kNullIndex;
+    }
+
+    /// \brief Get the best path found by the current search to a vertex.
+    /// \param[in] _graph The searched CSRGraph or CSRGraphView.
+    /// \param[in] _to Id of the last vertex of the path.
+    /// \param[out] _path Ids of the vertices from the starting vertex to
+    /// _to. It is cleared first.
+    /// \return The cost of the path, or MAX_D if _to was not reached, in
+    /// which case _path is empty.
+    public: template<typename G>
+    double Path(const G &_graph, const VertexId &_to,
+                std::vector<VertexId> &_path) const
+    {
+      _path.clear();
+      CSRIndex index = _graph.Index(_to);
+      if (!this->Reached(index))
+        return MAX_D;
+
+      while (true)
+      {
+        _path.push_back(_graph.Id(index));
+        const CSRIndex prev = this->previous[index];
+        if (prev == index || prev == kNullIndex)
+          break;
+        index = prev;
+      }
+      std::reverse(_path.begin(), _path.end());
+      return this->costs[_graph.Index(_to)];
+    }
+
+    /// \brief Record a path to a vertex if it is better than the best one
+    /// found so far by the current search, and queue the vertex in the
+    /// priority queue, or move it up if it is already queued. The queue is
+    /// an indexed heap holding each vertex at most once, so its size is
+    /// bounded by the number of vertices. Vertices that were already
+    /// removed from the queue with Pop() are left untouched.
+    /// \param[in] _index Dense index of the vertex.
+    /// \param[in] _cost Cost of the path.
+    /// \param[in] _previous Dense index of the previous vertex.
+    /// \return True if the path was recorded.
+    public: bool Push(const CSRIndex _index, const double _cost,
+                      const CSRIndex _previous)
+    {
+      if (this->stamps[_index] != this->stamp)
+      {
+        this->stamps[_index] = this->stamp;
+        this->positions[_index] = static_cast<CSRIndex>(this->heap.size());
+        this->heap.push_back(_index);
+      }
+      else if (this->positions[_index] == kNullIndex ||
+               this->costs[_index] <= _cost)
+      {
+        return false;
+      }
+
+      this->costs[_index] = _cost;
+      this->previous[_index] = _previous;
+      this->SiftUp(this->positions[_index]);
+      return true;
+    }
+
+    /// \brief Remove the vertex with the lowest cost from the priority
+    /// queue. Ties are broken by the lowest dense index.
+    /// \return Dense index of the vertex, or kNullIndex if the queue is
+    /// empty.
+    public: CSRIndex Pop()
+    {
+      if (this->heap.empty())
+        return kNullIndex;
+
+      const CSRIndex top = this->heap.front();
+      this->positions[top] = kNullIndex;
+      const CSRIndex last = this->heap.back();
+      this->heap.pop_back();
+      if (!this->heap.empty())
+      {
+        this->heap.front() = last;
+        this->positions[last] = 0;
+        this->SiftDown(0);
+      }
+      return top;
+    }
+
+    /// \brief Get the vertex with the lowest cost in the priority queue,
+    /// without removing it.
+    /// \return Dense index of the vertex, or kNullIndex if the queue is
+    /// empty.
+    public: CSRIndex Top() const
+    {
+      return this->heap.empty() ? kNullIndex : this->heap.front();
+    }
+
+    /// \brief Get the number of vertices in the priority queue.
+    /// \return Number of queued vertices.
+    public: std::size_t QueueSize() const
+    {
+      return this->heap.size();
+    }
+
+    /// \brief Check whether the priority queue is empty.
+    /// \return True if no vertex is queued.
+    public: bool QueueEmpty() const
+    {
+      return this->heap.empty();
+    }
+
+    /// \brief Check whether a vertex was reached by the current search and
+    /// is not waiting in the priority queue, which means that its cost is
+    /// final.
+    /// \param[in] _index Dense index of the vertex.
+    /// \return True if the vertex is settled.
+    public: bool Settled(const CSRIndex _index) const
+    {
+      return this->Reached(_index) &&
+        this->positions[_index] == kNullIndex;
+    }
+
+    /// \brief Mark a vertex as reached by the current search, unless it
+    /// already is.
+    /// \param[in] _index Dense index of the vertex.
+    /// \param[in] _cost Cost of the path to the vertex.
+    /// \param[in] _previous Dense index of the previous vertex.
+    /// \return True if the vertex was not reached before.
+    public: bool Visit(const CSRIndex _index, const double _cost,
+                       const CSRIndex _previous)
+    {
+      if (this->stamps[_index] == this->stamp)
+        return false;
+
+      this->stamps[_index] = this->stamp;
+      this->costs[_index] = _cost;
+      this->previous[_index] = _previous;
+      this->positions[_index] = kNullIndex;
+      return true;
+    }
+
+    /// \brief Get the storage of the vertices waiting to be expanded by a
+    /// traversal. It is cleared by Reset().
+    /// \return Dense indices of the vertices.
+    public: std::pmr::vector<CSRIndex> &Pending()
+    {
+      return this->pending;
+    }
+
+    /// \brief Check whether a queued vertex goes before another one.
+    /// \param[in] _a Dense index of the first vertex.
+    /// \param[in] _b Dense index of the second vertex.
+    /// \return True if _a has a lower cost, or the same cost and a lower
+    /// index.
+    private: bool Before(const CSRIndex _a, const CSRIndex _b) const
+    {
+      return this->costs[_a] < this->costs[_b] ||
+        (!(this->costs[_b] < this->costs[_a]) && _a < _b);
+    }
+
+    /// \brief Move an entry of the heap up to its place.
+    /// \param[in] _pos Position of the entry in the heap.
+    private: void SiftUp(CSRIndex _pos)
+    {
+      const CSRIndex index = this->heap[_pos];
+      while (_pos > 0)
+      {
+        const CSRIndex parent = (_pos - 1) / kArity;
+        if (!this->Before(index, this->heap[parent]))
+          break;
+        this->heap[_pos] = this->heap[parent];
+        this->positions[this->heap[_pos]] = _pos;
+        _pos = parent;
+      }
+      this->heap[_pos] = index;
+      this->positions[index] = _pos;
+    }
+
+    /// \brief Move an entry of the heap down to its place.
+    /// \param[in] _pos Position of the entry in the heap.
+    private: void SiftDown(CSRIndex _pos)
+    {
+      const CSRIndex index = this->heap[_pos];
+      const std::size_t size = this->heap.size();
+      while (true)
+      {
+        const std::size_t first = std::size_t{_pos} * kArity + 1;
+        if (first >= size)
+          break;
+        const std::size_t last = std::min(first + kArity, size);
+        std::size_t best = first;
+        for (std::size_t child = first + 1; child < last; ++child)
+        {
+          if (this->Before(this->heap[child], this->heap[best]))
+            best = child;
+        }
+        if (!this->Before(this->heap[best], index))
+          break;
+        this->heap[_pos] = this->heap[best];
+        this->positions[this->heap[_pos]] = _pos;
+        _pos = static_cast<CSRIndex>(best);
+      }
+      this->heap[_pos] = index;
+      this->positions[index] = _pos;
+    }
+
+    /// \brief Number of children of each entry of the heap. A 4-ary heap
+    /// is shallower than a binary one and its children share cache lines.
+    private: static constexpr std::size_t kArity = 4;
+
+    /// \brief Stamp of each vertex, equal to the current stamp for the
+    /// vertices reached by the current search.
+    private: std::pmr::vector<uint32_t> stamps;
+
+    /// \brief Cost of each vertex.
+    private: std::pmr::vector<double> costs;
+
+    /// \brief Previous vertex of each vertex.
+    private: std::pmr::vector<CSRIndex> previous;
+
+    /// \brief Position of each vertex in the heap, or kNullIndex if it is
+    /// not queued.
+    private: std::pmr::vector<CSRIndex> positions;
+
+    /// \brief Priority queue of Dijkstra searches, as an indexed heap of
+    /// dense vertex indices ordered by cost.
+    private: std::pmr::vector<CSRIndex> heap;
+
+    /// \brief Vertices waiting to be expanded by traversals.
+    private: std::pmr::vector<CSRIndex> pending;
+
+    /// \brief Stamp of the current search.
+    private: uint32_t stamp = 0;
+
+    /// \brief Number of vertices of the searched graph.
+    private: CSRIndex vertexCount = 0;
+  };
+}
+}
+}
+}
+#endif
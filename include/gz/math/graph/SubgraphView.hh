@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRAPH_SUBGRAPHVIEW_HH_
+#define GZ_MATH_GRAPH_SUBGRAPHVIEW_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include "gz/math/graph/Edge.hh"
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/Vertex.hh"
+
+namespace ignition
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+namespace graph
+{
+  /// \brief A read only view of a subset of the vertices and edges of a
+  /// graph.
+  ///
+  /// Only the Ids of the vertices and edges are stored. Vertex and edge
+  /// names, data and weights are read from the graph, which must outlive
+  /// the view and must not be modified while the view is in use. Call
+  /// ToGraph() to get an independent copy.
+  ///
+  /// <b>Example</b>
+  /// \code{.cpp}
+  /// gz::math::graph::UndirectedGraph<int, double> graph(...);
+  /// for (const auto &component : ConnectedComponentViews(graph))
+  /// {
+  ///   component.ForEachVertex([](const Vertex<int> &_v) {...});
+  /// }
+  /// \endcode
+  template<typename V, typename E, typename EdgeType>
+  class SubgraphView
+  {
+    /// \brief Constructor. Creates the subgraph induced by a set of
+    /// vertices, which contains every edge of the graph between two of
+    /// these vertices.
+    /// \param[in] _graph The graph.
+    /// \param[in] _vertices Ids of the vertices, in any order. Ids that are
+    /// not in the graph are ignored.
+    public: SubgraphView(const Graph<V, E, EdgeType> &_graph,
+                         std::vector<VertexId> _vertices)
+      : graph(&_graph), vertexIds(std::move(_vertices))
+    {
+      std::sort(this->vertexIds.begin(), this->vertexIds.end());
+      this->vertexIds.erase(
+          std::unique(this->vertexIds.begin(), this->vertexIds.end()),
+          this->vertexIds.end());
+      this->vertexIds.erase(std::remove_if(this->vertexIds.begin(),
+          this->vertexIds.end(), [&_graph](const VertexId &_id)
+          {
+            return !_graph.VertexFromId(_id).Valid();
+          }), this->vertexIds.end());
+
+      // Every edge is reported from its first vertex, so that undirected
+      // edges are only added once.
+      for (const VertexId &id : this->vertexIds)
+      {
+        _graph.ForEachIncidentFrom(id, [&](const EdgeType &_edge)
+        {
+          const VertexId_P vertices = _edge.Vertices();
+          if (vertices.first == id && this->HasVertex(vertices.second))
+            this->edgeIds.push_back(_edge.Id());
+        });
+      }
+      std::sort(this->edgeIds.begin(), this->edgeIds.end());
+    }
+
+    /// \brief Constructor from precomputed Ids. No check is made, which
+    /// makes this constructor suitable to build many views in one pass
+    /// over a graph.
+    /// \param[in] _graph The graph.
+    /// \param[in] _vertices Ids of vertices of _graph, sorted in ascending
+    /// order and without duplicates.
+    /// \param[in] _edges Ids of edges of _graph between vertices of
+    /// _vertices, sorted in ascending order and without duplicates.
+    public: SubgraphView(const Graph<V, E, EdgeType> &_graph,
+                         std::vector<VertexId> _vertices,
+                         std::vector<EdgeId> _edges)
+      : graph(&_graph), vertexIds(std::move(_vertices)),
+        edgeIds(std::move(_edges))
+    {
+    }
+
+    /// \brief Get the graph that this view refers to.
+    /// \return The graph.
+    public: const Graph<V, E, EdgeType> &Source() const
+    {
+      return *this->graph;
+    }
+
+    /// \brief Get the Ids of the vertices of the view.
+    /// \return The vertex Ids, sorted in ascending order.
+    public: const std::vector<VertexId> &VertexIds() const
+    {
+      return this->vertexIds;
+    }
+
+    /// \brief Get the Ids of the edges of the view.
+    /// \return The edge Ids, sorted in ascending order.
+    public: const std::vector<EdgeId> &EdgeIds() const
+    {
+      return this->edgeIds;
+    }
+
+    /// \brief Get the number of vertices of the view.
+    /// \return The number of vertices.
+    public: std::size_t VertexCount() const
+    {
+      return this->vertexIds.size();
+    }
+
+    /// \brief Get the number of edges of the view.
+    /// \return The number of edges.
+    public: std::size_t EdgeCount() const
+    {
+      return this->edgeIds.size();
+    }
+
+    /// \brief Get whether the view has no vertices.
+    /// \return True when there are no vertices in the view.
+    public: bool Empty() const
+    {
+      return this->vertexIds.empty();
+    }
+
+    /// \brief Get whether a vertex is part of the view.
+    /// \param[in] _id Id of the vertex.
+    /// \return True if the vertex is in the view.
+    public: bool HasVertex(const VertexId &_id) const
+    {
+      return std::binary_search(this->vertexIds.begin(),
+                                this->vertexIds.end(), _id);
+    }
+
+    /// \brief Get whether an edge is part of the view.
+    /// \param[in] _id Id of the edge.
+    /// \return True if the edge is in the view.
+    public: bool HasEdge(const EdgeId &_id) const
+    {
+      return std::binary_search(this->edgeIds.begin(), this->edgeIds.end(),
+                                _id);
+    }
+
+    /// \brief Get a reference to a vertex of the view using its Id.
+    /// \param[in] _id The Id of the vertex.
+    /// \return A reference to the vertex of the graph, or NullVertex if it
+    /// is not part of the view.
+    public: const Vertex<V> &VertexFromId(const VertexId &_id) const
+    {
+      if (!this->HasVertex(_id))
+        return Vertex<V>::NullVertex;
+
+      return this->graph->VertexFromId(_id);
+    }
+
+    /// \brief Get a reference to an edge of the view using its Id.
+    /// \param[in] _id The Id of the edge.
+    /// \return A reference to the edge of the graph, or NullEdge if it is
+    /// not part of the view.
+    public: const EdgeType &EdgeFromId(const EdgeId &_id) const
+    {
+      if (!this->HasEdge(_id))
+        return EdgeType::NullEdge;
+
+      return this->graph->EdgeFromId(_id);
+    }
+
+    /// \brief Call a function for every vertex of the view, by ascending
+    /// Id.
+    /// \param[in] _fn Function called with a const reference to each
+    /// vertex.
+    public: template<typename F>
+    void ForEachVertex(F &&_fn) const
+    {
+      for (const VertexId &id : this->vertexIds)
+        _fn(this->graph->VertexFromId(id));
+    }
+
+    /// \brief Call a function for every edge of the view, by ascending Id.
+    /// \param[in] _fn Function called with a const reference to each edge.
+    public: template<typename F>
+    void ForEachEdge(F &&_fn) const
+    {
+      for (const EdgeId &id : this->edgeIds)
+        _fn(this->graph->EdgeFromId(id));
+    }
+
+    /// \brief Copy the vertices and edges of the view into a new graph.
+    /// Vertices keep their Ids, while edges get new Ids.
+    /// \return A graph with the vertices and edges of the view.
+    public: Graph<V, E, EdgeType> ToGraph() const
+    {
+      Graph<V, E, EdgeType> res;
+      this->ForEachVertex([&res](const Vertex<V> &_v)
+      {
+        res.AddVertex(_v.Name(), _v.Data(), _v.Id());
+      });
+      this->ForEachEdge([&res](const EdgeType &_e)
+      {
+        res.AddEdge(_e.Vertices(), _e.Data(), _e.Weight());
+      });
+      return res;
+    }
+
+    /// \brief The graph.
+    private: const Graph<V, E, EdgeType> *graph;
+
+    /// \brief Sorted Ids of the vertices.
+    private: std::vector<VertexId> vertexIds;
+
+    /// \brief Sorted Ids of the edges.
+    private: std::vector<EdgeId> edgeIds;
+  };
+}
+}
+}
+}
+#endif
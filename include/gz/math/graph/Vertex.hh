@@ -22,7 +22,9 @@
 #include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include <gz/math/config.hh>
@@ -49,7 +51,9 @@ namespace graph
 
   /// \brief A vertex of a graph. It stores user information, an optional name,
   /// and keeps an internal unique Id. This class does not enforce to choose a
-  /// unique name.
+  /// unique name. The name is held by a shared pointer to an immutable
+  /// string, so that vertices with the same name, such as those of a Graph,
+  /// can share a single copy of it.
   template<typename V>
   class Vertex
   {
@@ -63,12 +67,63 @@ namespace graph
     public: Vertex(const std::string &_name,
                    const V &_data = V(),
                    const VertexId _id = kNullId)
-      : name(_name),
+      : name(std::make_shared<const std::string>(_name)),
         data(_data),
         id(_id)
     {
     }
 
+    /// \brief Constructor with a name shared with other vertices.
+    /// \param[in] _name Non-unique vertex name. A null pointer is an empty
+    /// name.
+    /// \param[in] _data User information.
+    /// \param[in] _id Optional unique id.
+    public: Vertex(std::shared_ptr<const std::string> _name,
+                   const V &_data = V(),
+                   const VertexId _id = kNullId)
+      : name(std::move(_name)),
+        data(_data),
+        id(_id)
+    {
+      if (!this->name)
+        this->name = EmptyName();
+    }
+
+    /// \brief Copy constructor.
+    /// \param[in] _other Vertex to copy.
+    public: Vertex(const Vertex &_other) = default;
+
+    /// \brief Move constructor. The moved-from vertex keeps an empty name.
+    /// \param[in] _other Vertex to move.
+    public: Vertex(Vertex &&_other)
+      noexcept(std::is_nothrow_move_constructible<V>::value)
+      : name(std::exchange(_other.name, EmptyName())),
+        data(std::move(_other.data)),
+        id(_other.id)
+    {
+    }
+
+    /// \brief Copy assignment operator.
+    /// \param[in] _other Vertex to copy.
+    /// \return Reference to this vertex.
+    public: Vertex &operator=(const Vertex &_other) = default;
+
+    /// \brief Move assignment operator. The moved-from vertex keeps an
+    /// empty name.
+    /// \param[in] _other Vertex to move.
+    /// \return Reference to this vertex.
+    public: Vertex &operator=(Vertex &&_other)
+      noexcept(std::is_nothrow_move_assignable<V>::value)
+    {
+      if (this != &_other)
+      {
+        this->name = std::exchange(_other.name, EmptyName());
+        this->data = std::move(_other.data);
+        this->id = _other.id;
+      }
+      return *this;
+    }
+
     /// \brief Retrieve the user information.
     /// \return Reference to the user information.
     public: const V &Data() const
@@ -93,15 +148,31 @@ namespace graph
     /// \brief Get the vertex name.
     /// \return The vertex name.
     public: const std::string &Name() const
+    {
+      return *this->name;
+    }
+
+    /// \brief Get the shared storage of the vertex name.
+    /// \return Pointer to the name, never null.
+    public: const std::shared_ptr<const std::string> &SharedName() const
     {
       return this->name;
     }
 
-    /// \brief Set the vertex name.
+    /// \brief Set the vertex name. The name index of a Graph is not updated
+    /// when one of its vertices is renamed this way; use
+    /// Graph::SetVertexName() instead.
     /// \param[in] _name The vertex name.
     public: void SetName(const std::string &_name)
     {
-      this->name = _name;
+      this->name = std::make_shared<const std::string>(_name);
+    }
+
+    /// \brief Set the vertex name to one shared with other vertices.
+    /// \param[in] _name The vertex name. A null pointer is an empty name.
+    public: void SetName(std::shared_ptr<const std::string> _name)
+    {
+      this->name = _name ? std::move(_name) : EmptyName();
     }
 
     /// \brief Whether the vertex is considered valid or not (id==kNullId).
@@ -124,8 +195,17 @@ namespace graph
       return _out;
     }
 
-    /// \brief Non-unique vertex name.
-    private: std::string name = "";
+    /// \brief Get the empty name shared by the vertices without one.
+    /// \return Pointer to an empty name.
+    private: static const std::shared_ptr<const std::string> &EmptyName()
+    {
+      static const std::shared_ptr<const std::string> empty =
+        std::make_shared<const std::string>();
+      return empty;
+    }
+
+    /// \brief Non-unique vertex name, never null.
+    private: std::shared_ptr<const std::string> name;
 
     /// \brief User information.
     private: V data;
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 #include <functional>
 #include <ostream>
+#include <vector>
 
 #include "gz/math/AdditivelySeparableScalarField3.hh"
 #include "gz/math/Polynomial3.hh"
@@ -43,6 +44,55 @@ TEST(AdditivelySeparableScalarField3Test, Evaluate)
   EXPECT_DOUBLE_EQ(scalarField(INF_V), math::INF_D);
 }
 
+/////////////////////////////////////////////////
+TEST(AdditivelySeparableScalarField3Test, EvaluateBatch)
+{
+  const std::vector<math::Vector3d> points{
+      math::Vector3d::Zero, math::Vector3d::One,
+      math::Vector3d(-1.5, 2., 0.25), math::Vector3d(10., -20., 30.),
+      math::Vector3d(math::INF_D, 0., 0.),
+      math::Vector3d(0., -math::INF_D, 1.),
+      math::Vector3d(0., 0., math::NAN_D)};
+  std::vector<double> values(points.size());
+
+  // Polynomial functions are evaluated together
+  {
+    const math::AdditivelySeparableScalarField3d<math::Polynomial3d> field(
+        -2., math::Polynomial3d(math::Vector4d(1., 0., -1., 2.)),
+        math::Polynomial3d(math::Vector4d(0., 1., 0., 0.)),
+        math::Polynomial3d(math::Vector4d(0., 0., 3., -1.)));
+    field.Evaluate(points.data(), points.size(), values.data());
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      const double expected = field(points[i]);
+      if (std::isnan(expected))
+      {
+        EXPECT_TRUE(std::isnan(values[i]));
+      }
+      else if (std::isinf(expected))
+      {
+        EXPECT_DOUBLE_EQ(expected, values[i]);
+      }
+      else
+      {
+        EXPECT_NEAR(expected, values[i],
+                    1e-9 * std::max(1., std::abs(expected)));
+      }
+    }
+  }
+
+  // Other functions are evaluated point by point
+  {
+    using ScalarFunctionT = std::function<double(double)>;
+    auto xyzFunc = [](double x) { return 2. * x; };
+    const math::AdditivelySeparableScalarField3d<ScalarFunctionT> field(
+        0.5, xyzFunc, xyzFunc, xyzFunc);
+    field.Evaluate(points.data(), 4, values.data());
+    for (std::size_t i = 0; i < 4; ++i)
+      EXPECT_DOUBLE_EQ(field(points[i]), values[i]);
+  }
+}
+
 /////////////////////////////////////////////////
 TEST(AdditivelySeparableScalarField3Test, Minimum)
 {
@@ -14,11 +14,62 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/Angle.hh"
 
 using namespace gz::math;
 
+namespace
+{
+  /// \brief 1 / (2 Pi).
+  const double kInvTwoPi = 0.15915494309189533577;
+
+  /// \brief 2 Pi split in two parts, the first of which has trailing zeros
+  /// so that its product with a number of turns below 2^20 is exact.
+  const double kTwoPiHi = 6.28318530693650245667;
+
+  /// \brief Remainder of 2 Pi after kTwoPiHi.
+  const double kTwoPiLo = 2.43084020260247704059e-10;
+
+  /// \brief Number of angles unwrapped per block.
+  const std::size_t kUnwrapBlock = 256;
+
+  /// \brief Unwrap angles, given the number of turns to add to the first.
+  /// \param[in] _in Angles in radians.
+  /// \param[in] _count Number of angles, at least one.
+  /// \param[in] _turns Turns added to the first angle.
+  /// \param[out] _out Unwrapped angles, which may be _in.
+  void UnwrapTurns(const double *_in, const std::size_t _count,
+                   double _turns, double *_out)
+  {
+    // The turns between consecutive angles are rounded in a loop which
+    // vectorizes, then summed. They are integers, so the sum is exact and
+    // long tracks don't drift.
+    double steps[kUnwrapBlock];
+    double previous = _in[0];
+    _out[0] = (_in[0] + _turns * kTwoPiHi) + _turns * kTwoPiLo;
+    for (std::size_t start = 1; start < _count; start += kUnwrapBlock)
+    {
+      const std::size_t m = std::min(kUnwrapBlock, _count - start);
+      const double *in = _in + start;
+      steps[0] = std::floor((previous - in[0]) * kInvTwoPi + 0.5);
+      for (std::size_t j = 1; j < m; ++j)
+        steps[j] = std::floor((in[j - 1] - in[j]) * kInvTwoPi + 0.5);
+      previous = in[m - 1];
+
+      double *out = _out + start;
+      for (std::size_t j = 0; j < m; ++j)
+      {
+        _turns += steps[j];
+        out[j] = (in[j] + _turns * kTwoPiHi) + _turns * kTwoPiLo;
+      }
+    }
+  }
+}
+
 const Angle Angle::Zero = Angle(0);
 const Angle Angle::Pi = Angle(IGN_PI);
 const Angle Angle::HalfPi = Angle(IGN_PI_2);
@@ -99,6 +150,35 @@ Angle Angle::Normalized() const
   return atan2(sin(this->value), cos(this->value));
 }
 
+//////////////////////////////////////////////////
+void Angle::Normalize(const double *_in, const std::size_t _count,
+                      double *_out)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double turns = std::ceil((_in[i] - IGN_PI) * kInvTwoPi);
+    _out[i] = (_in[i] - turns * kTwoPiHi) - turns * kTwoPiLo;
+  }
+}
+
+//////////////////////////////////////////////////
+void Angle::Unwrap(const double *_in, const std::size_t _count,
+                   double *_out)
+{
+  if (_count > 0)
+    UnwrapTurns(_in, _count, 0.0, _out);
+}
+
+//////////////////////////////////////////////////
+void Angle::Unwrap(const double *_in, const std::size_t _count,
+                   const double _previous, double *_out)
+{
+  if (_count == 0)
+    return;
+  const double turns = std::floor((_previous - _in[0]) * kInvTwoPi + 0.5);
+  UnwrapTurns(_in, _count, turns, _out);
+}
+
 //////////////////////////////////////////////////
 Angle Angle::operator-(const Angle &angle) const
 {
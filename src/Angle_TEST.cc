@@ -18,9 +18,11 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <vector>
 
 #include "gz/math/Helpers.hh"
 #include "gz/math/Angle.hh"
+#include "gz/math/Rand.hh"
 
 using namespace gz;
 
@@ -130,3 +132,63 @@ TEST(AngleTest, OperatorStreamOut)
   stream << a;
   EXPECT_EQ(stream.str(), "0.1");
 }
+
+/////////////////////////////////////////////////
+TEST(AngleTest, NormalizeBatch)
+{
+  std::vector<double> angles = {0, 1, -1, IGN_PI, 3.5, -3.5, 7.0, -100.25,
+                                1e5, -1e5, 2 * IGN_PI, -2 * IGN_PI};
+  math::Rand::Seed(3);
+  for (int i = 0; i < 1000; ++i)
+    angles.push_back(math::Rand::DblUniform(-1e4, 1e4));
+
+  std::vector<double> out(angles.size());
+  math::Angle::Normalize(angles.data(), angles.size(), out.data());
+  for (std::size_t i = 0; i < angles.size(); ++i)
+  {
+    EXPECT_NEAR(*math::Angle(angles[i]).Normalized(), out[i], 1e-10)
+      << angles[i];
+    EXPECT_GE(IGN_PI, out[i]);
+    EXPECT_LE(-IGN_PI, out[i]);
+  }
+
+  // In place
+  math::Angle::Normalize(angles.data(), angles.size(), angles.data());
+  EXPECT_EQ(out, angles);
+  math::Angle::Normalize(nullptr, 0, nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST(AngleTest, Unwrap)
+{
+  // A track turning several times, with steps below Pi
+  std::vector<double> track(2000);
+  math::Rand::Seed(5);
+  track[0] = 0.5;
+  for (std::size_t i = 1; i < track.size(); ++i)
+    track[i] = track[i - 1] + math::Rand::DblUniform(-0.5, 2.5);
+  std::vector<double> wrapped(track.size());
+  math::Angle::Normalize(track.data(), track.size(), wrapped.data());
+
+  std::vector<double> out(track.size());
+  math::Angle::Unwrap(wrapped.data(), wrapped.size(), out.data());
+  for (std::size_t i = 0; i < track.size(); ++i)
+    EXPECT_NEAR(track[i], out[i], 1e-9) << i;
+
+  // In place, and in parts
+  std::vector<double> parts = wrapped;
+  math::Angle::Unwrap(parts.data(), 700, parts.data());
+  math::Angle::Unwrap(parts.data() + 700, parts.size() - 700, parts[699],
+                      parts.data() + 700);
+  for (std::size_t i = 0; i < track.size(); ++i)
+    EXPECT_NEAR(track[i], parts[i], 1e-9) << i;
+
+  // The first angle is moved next to the previous one
+  const double next[] = {-3.0};
+  double nextOut[1];
+  math::Angle::Unwrap(next, 1, 3.0, nextOut);
+  EXPECT_NEAR(2 * IGN_PI - 3.0, nextOut[0], 1e-12);
+  math::Angle::Unwrap(next, 1, nextOut);
+  EXPECT_DOUBLE_EQ(-3.0, nextOut[0]);
+  math::Angle::Unwrap(nullptr, 0, nullptr);
+}
@@ -14,12 +14,257 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/CpuFeatures.hh>
+#include <gz/math/Executor.hh>
+#include <gz/math/Instrumentation.hh>
+
+// Select the instruction sets of the bounds kernels. The AVX kernel is
+// built even when the library targets older CPUs, and ActiveSimdLevel()
+// chooses between the kernels at run time. Define
+// IGNITION_MATH_DISABLE_SIMD to always use the portable scalar code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define IGNITION_MATH_AABB_SSE2 1
+    #include <emmintrin.h>
+    #if defined(__AVX__) || defined(_MSC_VER)
+      #define IGNITION_MATH_AABB_AVX 1
+      #define IGNITION_MATH_AABB_AVX_TARGET
+      #include <immintrin.h>
+    #elif defined(__GNUC__)
+      #define IGNITION_MATH_AABB_AVX 1
+      #define IGNITION_MATH_AABB_AVX_TARGET __attribute__((target("avx")))
+      #include <immintrin.h>
+    #endif
+  #endif
+#endif
 
 using namespace gz;
 using namespace math;
 
+namespace
+{
+  /// \brief Minimum number of points or boxes for each thread.
+  const std::size_t kMinPerThread = 65536;
+
+  /// \brief Distance between the components of consecutive points of an
+  /// array of Vector3d, in doubles.
+  const std::size_t kPointStride = sizeof(Vector3d) / sizeof(double);
+
+  /// \brief Signature of the bounds kernels, which grow a minimum and a
+  /// maximum corner to include an array of point components. The x, y
+  /// and z of each point are contiguous, and consecutive points are
+  /// kPointStride doubles apart.
+  using BoundsKernel = void (*)(const double *, std::size_t, double *,
+                                double *);
+
+  /// \brief Portable bounds kernel.
+  /// \param[in] _values Components of the first point.
+  /// \param[in] _count Number of points.
+  /// \param[in,out] _min Minimum corner.
+  /// \param[in,out] _max Maximum corner.
+  void BoundsScalar(const double *_values, const std::size_t _count,
+                    double *_min, double *_max)
+  {
+    // Local copies keep the corners in registers, since they could
+    // otherwise alias the values.
+    double min[3] = {_min[0], _min[1], _min[2]};
+    double max[3] = {_max[0], _max[1], _max[2]};
+    for (std::size_t i = 0; i < kPointStride * _count; i += kPointStride)
+    {
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        const double v = _values[i + axis];
+        min[axis] = v < min[axis] ? v : min[axis];
+        max[axis] = v > max[axis] ? v : max[axis];
+      }
+    }
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      _min[axis] = min[axis];
+      _max[axis] = max[axis];
+    }
+  }
+
+#if defined(IGNITION_MATH_AABB_SSE2)
+  /// \brief SSE2 bounds kernel, two points at a time. The x and y of a
+  /// point fill one register and its z the low lane of another, and each
+  /// of the two points has its own minimum and maximum registers. The NaN
+  /// components are ignored, since min and max return their second
+  /// operand when either is NaN.
+  void BoundsSse2(const double *_values, const std::size_t _count,
+                  double *_min, double *_max)
+  {
+    __m128d minXy[2], minZ[2], maxXy[2], maxZ[2];
+    for (int k = 0; k < 2; ++k)
+    {
+      minXy[k] = _mm_loadu_pd(_min);
+      minZ[k] = _mm_load_sd(_min + 2);
+      maxXy[k] = _mm_loadu_pd(_max);
+      maxZ[k] = _mm_load_sd(_max + 2);
+    }
+    std::size_t i = 0;
+    for (; i + 2 <= _count; i += 2)
+    {
+      for (int k = 0; k < 2; ++k)
+      {
+        const double *v = _values + kPointStride * (i + k);
+        const __m128d xy = _mm_loadu_pd(v);
+        const __m128d z = _mm_load_sd(v + 2);
+        minXy[k] = _mm_min_pd(xy, minXy[k]);
+        minZ[k] = _mm_min_sd(z, minZ[k]);
+        maxXy[k] = _mm_max_pd(xy, maxXy[k]);
+        maxZ[k] = _mm_max_sd(z, maxZ[k]);
+      }
+    }
+
+    alignas(16) double lanes[8][2];
+    _mm_store_pd(lanes[0], minXy[0]);
+    _mm_store_pd(lanes[1], minXy[1]);
+    _mm_store_pd(lanes[2], minZ[0]);
+    _mm_store_pd(lanes[3], minZ[1]);
+    _mm_store_pd(lanes[4], maxXy[0]);
+    _mm_store_pd(lanes[5], maxXy[1]);
+    _mm_store_pd(lanes[6], maxZ[0]);
+    _mm_store_pd(lanes[7], maxZ[1]);
+    _min[0] = std::min(lanes[0][0], lanes[1][0]);
+    _min[1] = std::min(lanes[0][1], lanes[1][1]);
+    _min[2] = std::min(lanes[2][0], lanes[3][0]);
+    _max[0] = std::max(lanes[4][0], lanes[5][0]);
+    _max[1] = std::max(lanes[4][1], lanes[5][1]);
+    _max[2] = std::max(lanes[6][0], lanes[7][0]);
+    BoundsScalar(_values + kPointStride * i, _count - i, _min, _max);
+  }
+#endif
+
+#if defined(IGNITION_MATH_AABB_AVX)
+  /// \brief AVX bounds kernel, four points at a time. The x, y and z of
+  /// a point fill the three low lanes of a register with a masked load,
+  /// which does not read past the z, and each of the four points has its
+  /// own minimum and maximum registers.
+  IGNITION_MATH_AABB_AVX_TARGET
+  void BoundsAvx(const double *_values, const std::size_t _count,
+                 double *_min, double *_max)
+  {
+    const __m256i mask = _mm256_set_epi64x(0, -1, -1, -1);
+    __m256d min[4], max[4];
+    for (int k = 0; k < 4; ++k)
+    {
+      min[k] = _mm256_maskload_pd(_min, mask);
+      max[k] = _mm256_maskload_pd(_max, mask);
+    }
+    std::size_t i = 0;
+    for (; i + 4 <= _count; i += 4)
+    {
+      for (int k = 0; k < 4; ++k)
+      {
+        const __m256d v =
+          _mm256_maskload_pd(_values + kPointStride * (i + k), mask);
+        min[k] = _mm256_min_pd(v, min[k]);
+        max[k] = _mm256_max_pd(v, max[k]);
+      }
+    }
+
+    const __m256d minAll = _mm256_min_pd(_mm256_min_pd(min[0], min[1]),
+                                         _mm256_min_pd(min[2], min[3]));
+    const __m256d maxAll = _mm256_max_pd(_mm256_max_pd(max[0], max[1]),
+                                         _mm256_max_pd(max[2], max[3]));
+    alignas(32) double lanes[2][4];
+    _mm256_store_pd(lanes[0], minAll);
+    _mm256_store_pd(lanes[1], maxAll);
+    // GCC does not clear the upper lanes when leaving functions with an
+    // AVX target attribute, which slows down the SSE code that follows.
+    _mm256_zeroupper();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      _min[axis] = lanes[0][axis];
+      _max[axis] = lanes[1][axis];
+    }
+    BoundsScalar(_values + kPointStride * i, _count - i, _min, _max);
+  }
+#endif
+
+  /// \brief Get the widest bounds kernel allowed by ActiveSimdLevel().
+  /// \return The kernel.
+  BoundsKernel SelectBoundsKernel()
+  {
+    const SimdLevel level = ActiveSimdLevel();
+    if (level == SimdLevel::SCALAR || level == SimdLevel::NEON)
+      return BoundsScalar;
+#if defined(IGNITION_MATH_AABB_AVX)
+    if (level != SimdLevel::SSE2)
+      return BoundsAvx;
+#endif
+#if defined(IGNITION_MATH_AABB_SSE2)
+    return BoundsSse2;
+#else
+    return BoundsScalar;
+#endif
+  }
+
+  /// \brief Grow bounds to include an array of points, with the widest
+  /// kernel allowed by ActiveSimdLevel().
+  /// \param[in] _points The points.
+  /// \param[in] _count Number of points.
+  /// \param[in,out] _min Minimum corner.
+  /// \param[in,out] _max Maximum corner.
+  void GrowBounds(const Vector3d *_points, const std::size_t _count,
+                  Vector3d &_min, Vector3d &_max)
+  {
+    const BoundsKernel kernel = SelectBoundsKernel();
+    double min[3] = {_min.X(), _min.Y(), _min.Z()};
+    double max[3] = {_max.X(), _max.Y(), _max.Z()};
+    if (_count > 0)
+      kernel(&const_cast<Vector3d &>(_points[0])[0], _count, min, max);
+    _min.Set(min[0], min[1], min[2]);
+    _max.Set(max[0], max[1], max[2]);
+  }
+
+  /// \brief Reduce the bounds of the parts of an array in parallel.
+  /// \param[in] _count Number of elements.
+  /// \param[in] _threads Number of threads, 0 for hardware threads.
+  /// \param[in] _grow Function growing bounds to include a range of
+  /// elements.
+  /// \return The bounds.
+  template<typename GrowFunction>
+  AxisAlignedBox ReduceBounds(const std::size_t _count,
+      const unsigned int _threads, const GrowFunction &_grow)
+  {
+    std::size_t threads = _threads;
+    if (threads == 0)
+      threads = std::thread::hardware_concurrency();
+    const std::size_t parts = std::max<std::size_t>(1,
+        std::min(threads, _count / kMinPerThread));
+
+    AxisAlignedBox bounds;
+    if (parts <= 1)
+    {
+      _grow(0, _count, bounds.Min(), bounds.Max());
+      return bounds;
+    }
+
+    std::vector<AxisAlignedBox> partial(parts);
+    ThreadPool pool(static_cast<unsigned int>(parts));
+    pool.ForEachBlock(_count, parts,
+      [&](const std::size_t _begin, const std::size_t _end,
+          const std::size_t _part)
+      {
+        _grow(_begin, _end, partial[_part].Min(), partial[_part].Max());
+      });
+    for (const AxisAlignedBox &box : partial)
+      bounds.Merge(box);
+    return bounds;
+  }
+}
+
+
 // Private data for AxisAlignedBox class
 class gz::math::AxisAlignedBoxPrivate
 {
@@ -63,10 +308,18 @@ AxisAlignedBox::AxisAlignedBox(const Vector3d &_vec1, const Vector3d &_vec2)
 AxisAlignedBox::AxisAlignedBox(const AxisAlignedBox &_b)
 : dataPtr(new AxisAlignedBoxPrivate)
 {
+  IGN_MATH_COUNT_COPY(PIMPL, sizeof(AxisAlignedBoxPrivate));
   this->dataPtr->min = _b.dataPtr->min;
   this->dataPtr->max = _b.dataPtr->max;
 }
 
+//////////////////////////////////////////////////
+AxisAlignedBox::AxisAlignedBox(AxisAlignedBox &&_b) noexcept
+: dataPtr(_b.dataPtr)
+{
+  _b.dataPtr = nullptr;
+}
+
 //////////////////////////////////////////////////
 AxisAlignedBox::~AxisAlignedBox()
 {
@@ -114,15 +367,64 @@ void AxisAlignedBox::Merge(const AxisAlignedBox &_box)
   this->dataPtr->max.Max(_box.dataPtr->max);
 }
 
+//////////////////////////////////////////////////
+AxisAlignedBox AxisAlignedBox::FromPoints(const Vector3d *_points,
+    const std::size_t _count, const unsigned int _threads)
+{
+  return ReduceBounds(_count, _threads,
+    [_points](const std::size_t _begin, const std::size_t _end,
+              Vector3d &_min, Vector3d &_max)
+    {
+      GrowBounds(_points + _begin, _end - _begin, _min, _max);
+    });
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox AxisAlignedBox::FromBoxes(const AxisAlignedBox *_boxes,
+    const std::size_t _count, const unsigned int _threads)
+{
+  return ReduceBounds(_count, _threads,
+    [_boxes](const std::size_t _begin, const std::size_t _end,
+             Vector3d &_min, Vector3d &_max)
+    {
+      // Empty boxes have a minimum above their maximum along some axis,
+      // and are kept out so that a box with one empty axis does not
+      // stretch the others.
+      for (std::size_t i = _begin; i < _end; ++i)
+      {
+        const Vector3d &boxMin = _boxes[i].dataPtr->min;
+        const Vector3d &boxMax = _boxes[i].dataPtr->max;
+        if (boxMin.X() <= boxMax.X() && boxMin.Y() <= boxMax.Y() &&
+            boxMin.Z() <= boxMax.Z())
+        {
+          _min.Min(boxMin);
+          _max.Max(boxMax);
+        }
+      }
+    });
+}
+
 //////////////////////////////////////////////////
 AxisAlignedBox &AxisAlignedBox::operator =(const AxisAlignedBox &_b)
 {
+  // A moved from box has no data
+  if (this->dataPtr == nullptr)
+    this->dataPtr = new AxisAlignedBoxPrivate;
+
+  IGN_MATH_COUNT_COPY(PIMPL, sizeof(AxisAlignedBoxPrivate));
   this->dataPtr->max = _b.dataPtr->max;
   this->dataPtr->min = _b.dataPtr->min;
 
   return *this;
 }
 
+//////////////////////////////////////////////////
+AxisAlignedBox &AxisAlignedBox::operator =(AxisAlignedBox &&_b) noexcept
+{
+  std::swap(this->dataPtr, _b.dataPtr);
+  return *this;
+}
+
 //////////////////////////////////////////////////
 AxisAlignedBox AxisAlignedBox::operator+(const AxisAlignedBox &_b) const
 {
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <tuple>
+#include <type_traits>
+
+#include "gz/math/AxisAlignedBox3.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+// The box is a plain value type.
+static_assert(std::is_trivially_copyable<AxisAlignedBox3d>::value,
+    "AxisAlignedBox3d must be trivially copyable");
+static_assert(sizeof(AxisAlignedBox3d) == 6 * sizeof(double),
+    "AxisAlignedBox3d must store its corners inline");
+
+// Scalar operations can be evaluated at compile time.
+static constexpr AxisAlignedBox3d kUnitBox(0, 0, 0, 1, 1, 1);
+static_assert(kUnitBox.Volume() > 0.99, "Volume must be constexpr");
+static_assert(!kUnitBox.Empty(), "Empty must be constexpr");
+static_assert(AxisAlignedBox3d().Empty(), "Default box must be empty");
+static_assert((kUnitBox + AxisAlignedBox3d(2, 0, 0, 3, 1, 1)).XLength() > 2.99,
+    "Merge must be constexpr");
+static_assert(kUnitBox.Intersects(AxisAlignedBox3d(1, 1, 1, 2, 2, 2)),
+    "Intersects must be constexpr");
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBox3Test, Constructor)
+{
+  AxisAlignedBox3d empty;
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ(Vector3d(MAX_D, MAX_D, MAX_D), empty.Min());
+  EXPECT_EQ(Vector3d(LOW_D, LOW_D, LOW_D), empty.Max());
+  EXPECT_DOUBLE_EQ(0.0, empty.Volume());
+  EXPECT_EQ(Vector3d::Zero, empty.Size());
+
+  // The corners are reordered, as in AxisAlignedBox.
+  AxisAlignedBox3d box(Vector3d(0, -1, 2), Vector3d(1, -2, 3));
+  EXPECT_FALSE(box.Empty());
+  EXPECT_EQ(Vector3d(0, -2, 2), box.Min());
+  EXPECT_EQ(Vector3d(1, -1, 3), box.Max());
+  EXPECT_EQ(box, AxisAlignedBox3d(1, -2, 3, 0, -1, 2));
+  EXPECT_DOUBLE_EQ(1.0, box.XLength());
+  EXPECT_DOUBLE_EQ(1.0, box.YLength());
+  EXPECT_DOUBLE_EQ(1.0, box.ZLength());
+  EXPECT_EQ(Vector3d(0.5, -1.5, 2.5), box.Center());
+  EXPECT_DOUBLE_EQ(1.0, box.Volume());
+
+  AxisAlignedBox3d copy(box);
+  EXPECT_EQ(box, copy);
+  copy.SetMax(Vector3d(4, 4, 4));
+  EXPECT_NE(box, copy);
+  EXPECT_EQ(Vector3d(4, 4, 4), copy.Max());
+
+  copy.SetMin(Vector3d(5, 0, 0));
+  EXPECT_TRUE(copy.Empty());
+
+  AxisAlignedBox3f boxf(0, 0, 0, 1, 2, 3);
+  EXPECT_FLOAT_EQ(6.0f, boxf.Volume());
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBox3Test, Conversion)
+{
+  AxisAlignedBox original(Vector3d(0, -1, 2), Vector3d(1, -2, 3));
+  AxisAlignedBox3d box(original);
+  EXPECT_EQ(original.Min(), box.Min());
+  EXPECT_EQ(original.Max(), box.Max());
+  EXPECT_EQ(original, box.ToAxisAlignedBox());
+
+  AxisAlignedBox3f boxf(original);
+  EXPECT_EQ(Vector3f(0, -2, 2), boxf.Min());
+  EXPECT_EQ(original, boxf.ToAxisAlignedBox());
+
+  // Empty boxes stay empty.
+  EXPECT_TRUE(AxisAlignedBox3f(AxisAlignedBox()).Empty());
+  EXPECT_EQ(AxisAlignedBox(), AxisAlignedBox3f().ToAxisAlignedBox());
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBox3Test, MergeAndOperators)
+{
+  AxisAlignedBox3d box(0, 0, 0, 1, 1, 1);
+
+  // Merging with an empty box is a no-op, in both directions.
+  AxisAlignedBox3d merged;
+  merged.Merge(box);
+  EXPECT_EQ(box, merged);
+  merged.Merge(AxisAlignedBox3d());
+  EXPECT_EQ(box, merged);
+
+  merged += AxisAlignedBox3d(-1, 2, 0, 0, 3, 1);
+  EXPECT_EQ(AxisAlignedBox3d(-1, 0, 0, 1, 3, 1), merged);
+  EXPECT_EQ(merged, box + AxisAlignedBox3d(-1, 2, 0, 0, 3, 1));
+
+  merged.Merge(Vector3d(0, 0, 5));
+  EXPECT_EQ(Vector3d(1, 3, 5), merged.Max());
+
+  EXPECT_EQ(AxisAlignedBox3d(1, 2, 3, 2, 3, 4), box + Vector3d(1, 2, 3));
+  EXPECT_EQ(AxisAlignedBox3d(-1, -2, -3, 0, -1, -2), box - Vector3d(1, 2, 3));
+
+  AxisAlignedBox3d overlap =
+    box.Intersection(AxisAlignedBox3d(0.5, -1, 0.5, 2, 0.5, 2));
+  EXPECT_EQ(AxisAlignedBox3d(0.5, 0, 0.5, 1, 0.5, 1), overlap);
+  EXPECT_TRUE(box.Intersection(AxisAlignedBox3d(2, 2, 2, 3, 3, 3)).Empty());
+
+  std::ostringstream stream;
+  stream << box;
+  EXPECT_EQ("Min[0 0 0] Max[1 1 1]", stream.str());
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBox3Test, MatchesAxisAlignedBox)
+{
+  Rand::Seed(1234);
+  auto randomVector = [](double _min, double _max)
+  {
+    return Vector3d(Rand::DblUniform(_min, _max),
+                    Rand::DblUniform(_min, _max),
+                    Rand::DblUniform(_min, _max));
+  };
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    Vector3d a = randomVector(-5, 5);
+    Vector3d b = randomVector(-5, 5);
+    AxisAlignedBox reference(a, b);
+    AxisAlignedBox3d box(a, b);
+    EXPECT_EQ(reference.Min(), box.Min());
+    EXPECT_EQ(reference.Max(), box.Max());
+    EXPECT_DOUBLE_EQ(reference.Volume(), box.Volume());
+    EXPECT_EQ(reference.Center(), box.Center());
+
+    AxisAlignedBox otherReference(randomVector(-5, 5), randomVector(-5, 5));
+    AxisAlignedBox3d other(otherReference);
+    EXPECT_EQ(reference.Intersects(otherReference), box.Intersects(other));
+    EXPECT_EQ((reference + otherReference), (box + other).ToAxisAlignedBox());
+
+    Vector3d point = randomVector(-6, 6);
+    EXPECT_EQ(reference.Contains(point), box.Contains(point));
+
+    // Random rays, along with axis aligned rays that exercise the
+    // divisions by zero.
+    Vector3d origin = randomVector(-10, 10);
+    Vector3d dir = randomVector(-1, 1);
+    if (i % 4 == 0)
+      dir = Vector3d(0, 0, dir.Z());
+    auto expected = reference.Intersect(origin, dir, 0.5, 30);
+    auto result = box.Intersect(origin, dir, 0.5, 30);
+    EXPECT_EQ(std::get<0>(expected), std::get<0>(result));
+    EXPECT_DOUBLE_EQ(std::get<1>(expected), std::get<1>(result));
+    EXPECT_EQ(std::get<2>(expected), std::get<2>(result));
+    EXPECT_EQ(std::get<0>(expected), box.IntersectCheck(origin, dir, 0.5, 30));
+    EXPECT_DOUBLE_EQ(std::get<1>(expected),
+        std::get<1>(box.IntersectDist(origin, dir, 0.5, 30)));
+  }
+}
@@ -16,8 +16,14 @@
 */
 #include <gtest/gtest.h>
 #include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "gz/math/AxisAlignedBox.hh"
+#include "gz/math/CpuFeatures.hh"
+#include "gz/math/Rand.hh"
 
 using namespace gz;
 using namespace math;
@@ -107,6 +113,27 @@ TEST_F(ExampleAxisAlignedBox, CopyConstructor)
   EXPECT_TRUE(box1.Max() == box.Max());
 }
 
+/////////////////////////////////////////////////
+TEST_F(ExampleAxisAlignedBox, Move)
+{
+  EXPECT_TRUE(std::is_nothrow_move_constructible<AxisAlignedBox>::value);
+  EXPECT_TRUE(std::is_nothrow_move_assignable<AxisAlignedBox>::value);
+
+  AxisAlignedBox box1(box);
+  AxisAlignedBox box2(std::move(box1));
+  EXPECT_EQ(box, box2);
+
+  AxisAlignedBox box3;
+  box3 = std::move(box2);
+  EXPECT_EQ(box, box3);
+
+  // Moved from boxes can be assigned to again
+  box1 = box;
+  EXPECT_EQ(box, box1);
+  box2 = std::move(box3);
+  EXPECT_EQ(box, box2);
+}
+
 /////////////////////////////////////////////////
 TEST_F(ExampleAxisAlignedBox, ManuallySet)
 {
@@ -601,3 +628,142 @@ TEST(AxisAlignedBoxTest, Volume)
   AxisAlignedBox box2(Vector3d(-1, -2, -3), Vector3d(1, 2, 3));
   EXPECT_DOUBLE_EQ(48.0, box2.Volume());
 }
+
+/////////////////////////////////////////////////
+/// \brief Merge a box around each point, as FromPoints does.
+AxisAlignedBox MergePoints(const std::vector<Vector3d> &_points)
+{
+  AxisAlignedBox box;
+  for (const Vector3d &p : _points)
+  {
+    box.Min().Min(p);
+    box.Max().Max(p);
+  }
+  return box;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that two boxes have exactly the same corners.
+void ExpectSameCorners(const AxisAlignedBox &_a, const AxisAlignedBox &_b)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ(_a.Min()[i], _b.Min()[i]) << i;
+    EXPECT_EQ(_a.Max()[i], _b.Max()[i]) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTest, FromPoints)
+{
+  EXPECT_EQ(AxisAlignedBox(), AxisAlignedBox::FromPoints(nullptr, 0));
+
+  const std::vector<Vector3d> points = {
+    {1, 2, 3}, {-1, 5, 0}, {4, -2, 7}, {0, 0, -8}, {2, 9, 1}};
+  const AxisAlignedBox box = AxisAlignedBox::FromPoints(points.data(),
+      points.size());
+  EXPECT_EQ(Vector3d(-1, -2, -8), box.Min());
+  EXPECT_EQ(Vector3d(4, 9, 7), box.Max());
+
+  // Every kernel the CPU supports gives the same bounds as merging each
+  // point, for every remainder of the SIMD loops, with NaN and infinite
+  // components.
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  Rand::Seed(17);
+  std::vector<Vector3d> values;
+  for (int i = 0; i < 40; ++i)
+  {
+    values.push_back(Vector3d(Rand::DblUniform(-10, 10),
+        Rand::DblUniform(-10, 10), Rand::DblUniform(-10, 10)));
+  }
+  values[5].X(nan);
+  values[6].Set(nan, nan, nan);
+  values[11].Z(-inf);
+  values[30].Y(inf);
+
+  const SimdLevel active = ActiveSimdLevel();
+  for (const SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2,
+                                SimdLevel::AVX, SimdLevel::AVX2,
+                                SimdLevel::AVX512})
+  {
+    if (!SetActiveSimdLevel(level))
+      continue;
+    for (std::size_t begin = 0; begin < 8; ++begin)
+    {
+      for (std::size_t count = 0; count + begin <= values.size(); ++count)
+      {
+        const std::vector<Vector3d> range(values.begin() + begin,
+            values.begin() + begin + count);
+        ExpectSameCorners(MergePoints(range),
+            AxisAlignedBox::FromPoints(range.data(), range.size()));
+      }
+    }
+  }
+  EXPECT_TRUE(SetActiveSimdLevel(active));
+
+  // All-NaN points leave the default box
+  const std::vector<Vector3d> nans(3, Vector3d(nan, nan, nan));
+  EXPECT_EQ(AxisAlignedBox(), AxisAlignedBox::FromPoints(nans.data(),
+                                                         nans.size()));
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTest, FromPointsThreads)
+{
+  Rand::Seed(5);
+  std::vector<Vector3d> points(300000);
+  for (Vector3d &p : points)
+  {
+    p.Set(Rand::DblUniform(-1, 1), Rand::DblUniform(-2, 2),
+          Rand::DblUniform(-3, 3));
+  }
+  points[123456].Set(5, -6, 7);
+
+  const AxisAlignedBox expected = MergePoints(points);
+  for (unsigned int threads : {1u, 2u, 3u, 0u})
+  {
+    ExpectSameCorners(expected, AxisAlignedBox::FromPoints(points.data(),
+        points.size(), threads));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTest, FromBoxes)
+{
+  EXPECT_EQ(AxisAlignedBox(), AxisAlignedBox::FromBoxes(nullptr, 0));
+
+  std::vector<AxisAlignedBox> boxes;
+  boxes.push_back(AxisAlignedBox(Vector3d(0, 0, 0), Vector3d(1, 1, 1)));
+  boxes.push_back(AxisAlignedBox());
+  boxes.push_back(AxisAlignedBox(Vector3d(-2, 0.5, 0), Vector3d(0, 3, 1)));
+  EXPECT_EQ(AxisAlignedBox(Vector3d(-2, 0, 0), Vector3d(1, 3, 1)),
+            AxisAlignedBox::FromBoxes(boxes.data(), boxes.size()));
+
+  // A box which is empty along one axis does not stretch the others
+  AxisAlignedBox flat;
+  flat.Min().Set(-100, -100, 5);
+  flat.Max().Set(100, 100, 4);
+  boxes.push_back(flat);
+  EXPECT_EQ(AxisAlignedBox(Vector3d(-2, 0, 0), Vector3d(1, 3, 1)),
+            AxisAlignedBox::FromBoxes(boxes.data(), boxes.size()));
+
+  // Large arrays give the same bounds on several threads
+  Rand::Seed(9);
+  boxes.clear();
+  for (int i = 0; i < 200000; ++i)
+  {
+    const Vector3d center(Rand::DblUniform(-50, 50),
+        Rand::DblUniform(-50, 50), Rand::DblUniform(-50, 50));
+    boxes.push_back(AxisAlignedBox(center - Vector3d::One,
+                                   center + Vector3d::One));
+  }
+  AxisAlignedBox expected;
+  for (const AxisAlignedBox &b : boxes)
+    expected.Merge(b);
+  for (unsigned int threads : {1u, 4u})
+  {
+    ExpectSameCorners(expected, AxisAlignedBox::FromBoxes(boxes.data(),
+        boxes.size(), threads));
+  }
+}
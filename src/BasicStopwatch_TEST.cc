@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <type_traits>
+
+#include "gz/math/BasicStopwatch.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Start, stop and restart a stopwatch, as in the Stopwatch tests
+/// with shorter sleeps.
+/// \param[in] _watch The stopwatch.
+template<typename Clock>
+void RunTimer(math::BasicStopwatch<Clock> &_watch)
+{
+  using Duration = typename Clock::duration;
+  const auto sleep = std::chrono::milliseconds(20);
+
+  // Windows may sleep for less than asked, so leave some room.
+  Duration slack = Duration::zero();
+#ifdef _WIN32
+  slack += std::chrono::milliseconds(10);
+#endif
+
+  EXPECT_TRUE(_watch.Start());
+  EXPECT_TRUE(_watch.Running());
+  EXPECT_GT(_watch.StartTime(), _watch.StopTime());
+  EXPECT_EQ(Duration::zero(), _watch.ElapsedStopTime());
+
+  std::this_thread::sleep_for(sleep);
+  EXPECT_GE(_watch.ElapsedRunTime() + slack, sleep);
+
+  EXPECT_TRUE(_watch.Stop());
+  EXPECT_FALSE(_watch.Running());
+  EXPECT_GT(_watch.StopTime(), _watch.StartTime());
+  const Duration elapsed = _watch.ElapsedRunTime();
+  EXPECT_GE(elapsed + slack, sleep);
+
+  // The run time does not change while stopped
+  std::this_thread::sleep_for(sleep);
+  EXPECT_GE(_watch.ElapsedStopTime() + slack, sleep);
+  EXPECT_EQ(elapsed, _watch.ElapsedRunTime());
+
+  // The stop time does not change while running
+  EXPECT_TRUE(_watch.Start());
+  const Duration elapsedStop = _watch.ElapsedStopTime();
+  std::this_thread::sleep_for(sleep);
+  EXPECT_EQ(elapsedStop, _watch.ElapsedStopTime());
+  EXPECT_GT(_watch.ElapsedRunTime(), elapsed);
+  EXPECT_GE(_watch.ElapsedRunTime() + slack, 2 * sleep);
+}
+
+/////////////////////////////////////////////////
+template<typename Clock>
+class BasicStopwatchTest : public ::testing::Test
+{
+};
+
+using Clocks = ::testing::Types<std::chrono::steady_clock, math::TscClock>;
+TYPED_TEST_SUITE(BasicStopwatchTest, Clocks);
+
+/////////////////////////////////////////////////
+TYPED_TEST(BasicStopwatchTest, StartStopReset)
+{
+  using Watch = math::BasicStopwatch<TypeParam>;
+  static_assert(std::is_trivially_copyable<Watch>::value,
+                "The stopwatch has no private data pointer");
+
+  Watch watch;
+  EXPECT_FALSE(watch.Running());
+  EXPECT_EQ(watch.StopTime(), watch.StartTime());
+  EXPECT_EQ(TypeParam::duration::zero(), watch.ElapsedRunTime());
+  EXPECT_EQ(TypeParam::duration::zero(), watch.ElapsedStopTime());
+
+  RunTimer(watch);
+
+  Watch copy(watch);
+  EXPECT_EQ(watch, copy);
+  EXPECT_NE(Watch(), copy);
+
+  watch.Reset();
+  EXPECT_EQ(Watch(), watch);
+  EXPECT_FALSE(watch.Running());
+  EXPECT_EQ(TypeParam::duration::zero(), watch.ElapsedRunTime());
+  EXPECT_EQ(TypeParam::duration::zero(), watch.ElapsedStopTime());
+
+  RunTimer(watch);
+  EXPECT_TRUE(watch.Running());
+
+  watch.Start(true);
+  EXPECT_TRUE(watch.Running());
+  EXPECT_LT(watch.StopTime(), watch.StartTime());
+  EXPECT_EQ(TypeParam::duration::zero(), watch.ElapsedStopTime());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(BasicStopwatchTest, FailStartStop)
+{
+  math::BasicStopwatch<TypeParam> watch;
+
+  // Can't stop while not running
+  EXPECT_FALSE(watch.Stop());
+  EXPECT_FALSE(watch.Running());
+
+  // Can't start while running
+  EXPECT_TRUE(watch.Start());
+  EXPECT_FALSE(watch.Start());
+  EXPECT_TRUE(watch.Running());
+
+  EXPECT_TRUE(watch.Stop());
+  EXPECT_FALSE(watch.Stop());
+  EXPECT_TRUE(watch.Start());
+}
+
+/////////////////////////////////////////////////
+TEST(BasicStopwatchTest, Default)
+{
+  static_assert(std::is_same<math::BasicStopwatch<>::clock,
+                             std::chrono::steady_clock>::value,
+                "The default clock is the steady clock");
+  static_assert(std::is_same<math::TscStopwatch::clock,
+                             math::TscClock>::value,
+                "TscStopwatch uses TscClock");
+}
@@ -0,0 +1,354 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "gz/math/BinaryCodec.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(BinaryCodecTest, LittleEndian)
+{
+  std::vector<uint8_t> buffer;
+  math::BinaryEncoder encoder(buffer);
+  encoder.Write(uint32_t(0x01020304));
+  encoder.Write(int16_t(-2));
+  encoder.Write(1.0);
+  encoder.Write(-2.0f);
+
+  const std::vector<uint8_t> expected = {
+    0x04, 0x03, 0x02, 0x01,
+    0xfe, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x3f,
+    0x00, 0x00, 0x00, 0xc0};
+  EXPECT_EQ(expected, buffer);
+
+  math::BinaryDecoder decoder(buffer);
+  uint32_t u = 0;
+  int16_t s = 0;
+  double d = 0;
+  float f = 0;
+  EXPECT_TRUE(decoder.Read(u));
+  EXPECT_TRUE(decoder.Read(s));
+  EXPECT_TRUE(decoder.Read(d));
+  EXPECT_TRUE(decoder.Read(f));
+  EXPECT_EQ(0x01020304u, u);
+  EXPECT_EQ(-2, s);
+  EXPECT_DOUBLE_EQ(1.0, d);
+  EXPECT_FLOAT_EQ(-2.0f, f);
+  EXPECT_EQ(0u, decoder.Remaining());
+  EXPECT_TRUE(decoder.Good());
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryCodecTest, Types)
+{
+  const math::Vector2d v2(1, -2);
+  const math::Vector3d v3(1.5, -2.25, 1e300);
+  const math::Vector3f v3f(0.1f, 0.2f, 0.3f);
+  const math::Vector4i v4(1, 2, 3, -4);
+  const math::Quaterniond q(0.1, 0.2, 0.3, 0.4);
+  const math::Pose3d pose(1, 2, 3, 0.1, 0.2, 0.3);
+  const math::AxisAlignedBox box(math::Vector3d(-1, -2, -3),
+                                 math::Vector3d(1, 2, 3));
+  const math::AxisAlignedBox emptyBox;
+  const math::AxisAlignedBox3f box3f(math::Vector3f(-1, 0, 1),
+                                     math::Vector3f(2, 3, 4));
+  const math::MassMatrix3d mass(2, math::Vector3d(1, 2, 3),
+                                math::Vector3d(0.1, 0.2, 0.3));
+
+  std::vector<uint8_t> buffer;
+  math::BinaryEncoder encoder(buffer);
+  encoder.Write(v2);
+  encoder.Write(v3);
+  encoder.Write(v3f);
+  encoder.Write(v4);
+  encoder.Write(q);
+  encoder.Write(pose);
+  encoder.Write(box);
+  encoder.Write(emptyBox);
+  encoder.Write(box3f);
+  encoder.Write(mass);
+  EXPECT_EQ(16u + 24u + 12u + 16u + 32u + 56u + 48u + 48u + 24u + 56u,
+            buffer.size());
+
+  math::Vector2d v2Out;
+  math::Vector3d v3Out;
+  math::Vector3f v3fOut;
+  math::Vector4i v4Out;
+  math::Quaterniond qOut;
+  math::Pose3d poseOut;
+  math::AxisAlignedBox boxOut;
+  math::AxisAlignedBox emptyBoxOut(box);
+  math::AxisAlignedBox3f box3fOut;
+  math::MassMatrix3d massOut;
+
+  math::BinaryDecoder decoder(buffer);
+  EXPECT_TRUE(decoder.Read(v2Out));
+  EXPECT_TRUE(decoder.Read(v3Out));
+  EXPECT_TRUE(decoder.Read(v3fOut));
+  EXPECT_TRUE(decoder.Read(v4Out));
+  EXPECT_TRUE(decoder.Read(qOut));
+  EXPECT_TRUE(decoder.Read(poseOut));
+  EXPECT_TRUE(decoder.Read(boxOut));
+  EXPECT_TRUE(decoder.Read(emptyBoxOut));
+  EXPECT_TRUE(decoder.Read(box3fOut));
+  EXPECT_TRUE(decoder.Read(massOut));
+  EXPECT_EQ(0u, decoder.Remaining());
+
+  // Stored bits round trip exactly, and quaternions are not normalized.
+  EXPECT_EQ(v2, v2Out);
+  EXPECT_EQ(v3.X(), v3Out.X());
+  EXPECT_EQ(v3.Z(), v3Out.Z());
+  EXPECT_EQ(v3f.Y(), v3fOut.Y());
+  EXPECT_EQ(v4, v4Out);
+  EXPECT_EQ(q.W(), qOut.W());
+  EXPECT_EQ(q.Z(), qOut.Z());
+  EXPECT_EQ(pose.Pos(), poseOut.Pos());
+  EXPECT_EQ(pose.Rot().X(), poseOut.Rot().X());
+  EXPECT_EQ(box, boxOut);
+  EXPECT_EQ(emptyBox.Min(), emptyBoxOut.Min());
+  EXPECT_EQ(emptyBox.Max(), emptyBoxOut.Max());
+  EXPECT_EQ(box3f, box3fOut);
+  EXPECT_EQ(mass, massOut);
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryCodecTest, Arrays)
+{
+  std::vector<math::Pose3d> poses;
+  for (int i = 0; i < 100; ++i)
+    poses.emplace_back(i, -i, 0.5 * i, 0.01 * i, 0.02 * i, -0.03 * i);
+
+  std::vector<uint8_t> buffer;
+  math::BinaryEncoder encoder(buffer);
+  encoder.WriteVarint(poses.size());
+  encoder.WriteArray(poses.data(), poses.size());
+  EXPECT_EQ(1u + 56u * poses.size(), buffer.size());
+
+  math::BinaryDecoder decoder(buffer);
+  uint64_t count = 0;
+  EXPECT_TRUE(decoder.ReadVarint(count));
+  ASSERT_EQ(poses.size(), count);
+  std::vector<math::Pose3d> out(count);
+  EXPECT_TRUE(decoder.ReadArray(out.data(), out.size()));
+  EXPECT_EQ(poses, out);
+
+  // Reading past the end fails and leaves the output unchanged.
+  math::Vector3d v(1, 2, 3);
+  EXPECT_FALSE(decoder.Read(v));
+  EXPECT_EQ(math::Vector3d(1, 2, 3), v);
+  EXPECT_FALSE(decoder.Good());
+
+  // Failure is sticky.
+  math::BinaryDecoder truncated(buffer.data(), 1 + 56 * 3 + 10);
+  EXPECT_TRUE(truncated.ReadVarint(count));
+  EXPECT_FALSE(truncated.ReadArray(out.data(), 4));
+  EXPECT_EQ(poses, out);
+  EXPECT_FALSE(truncated.Read(out[0]));
+  EXPECT_FALSE(truncated.Good());
+
+  // An element count that overflows the size is rejected.
+  math::BinaryDecoder overflow(buffer);
+  EXPECT_FALSE(overflow.ReadArray(out.data(),
+        std::numeric_limits<std::size_t>::max() / 8 + 1));
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryCodecTest, Varint)
+{
+  const std::vector<uint64_t> values = {0, 1, 127, 128, 300, 1ull << 35,
+    std::numeric_limits<uint64_t>::max()};
+
+  std::vector<uint8_t> buffer;
+  math::BinaryEncoder encoder(buffer);
+  for (uint64_t v : values)
+    encoder.WriteVarint(v);
+  EXPECT_EQ(1u + 1u + 1u + 2u + 2u + 6u + 10u, buffer.size());
+
+  math::BinaryDecoder decoder(buffer);
+  for (uint64_t v : values)
+  {
+    uint64_t out = 0;
+    EXPECT_TRUE(decoder.ReadVarint(out));
+    EXPECT_EQ(v, out);
+  }
+  EXPECT_EQ(0u, decoder.Remaining());
+
+  // Too long or truncated encodings are rejected.
+  const std::vector<uint8_t> tooLong(11, 0xff);
+  math::BinaryDecoder longDecoder(tooLong);
+  uint64_t out = 5;
+  EXPECT_FALSE(longDecoder.ReadVarint(out));
+  EXPECT_EQ(5u, out);
+
+  const std::vector<uint8_t> truncated = {0x80, 0x80};
+  math::BinaryDecoder truncatedDecoder(truncated);
+  EXPECT_FALSE(truncatedDecoder.ReadVarint(out));
+  EXPECT_EQ(5u, out);
+
+  EXPECT_EQ(0u, math::detail::zigzagEncode(0));
+  EXPECT_EQ(1u, math::detail::zigzagEncode(-1));
+  EXPECT_EQ(2u, math::detail::zigzagEncode(1));
+  for (int64_t v : {int64_t(0), int64_t(-7), int64_t(1) << 62,
+       std::numeric_limits<int64_t>::min(),
+       std::numeric_limits<int64_t>::max()})
+  {
+    EXPECT_EQ(v, math::detail::zigzagDecode(math::detail::zigzagEncode(v)));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryCodecTest, SmallestThree)
+{
+  std::vector<math::Quaterniond> rotations = {
+    math::Quaterniond::Identity,
+    math::Quaterniond(0, 0, 0, 1),
+    math::Quaterniond(-0.5, 0.5, -0.5, 0.5),
+    math::Quaterniond(0.1, 0.2, 0.3, 0.4),
+    math::Quaterniond(-3, 0.1, 2, -0.5)};
+  for (int i = 0; i < 50; ++i)
+    rotations.emplace_back(0.1 * i, -0.07 * i, 0.13 * i);
+
+  for (unsigned int bits : {20u, 12u})
+  {
+    std::vector<uint8_t> buffer;
+    math::BinaryEncoder encoder(buffer);
+    for (const auto &q : rotations)
+      encoder.WriteSmallestThree(q, bits);
+    EXPECT_EQ(((2 + 3 * bits + 7) / 8) * rotations.size(), buffer.size());
+
+    const double tol = bits == 20 ? 2e-6 : 1e-3;
+    math::BinaryDecoder decoder(buffer);
+    for (const auto &q : rotations)
+    {
+      math::Quaterniond out;
+      EXPECT_TRUE(decoder.ReadSmallestThree(out, bits));
+
+      math::Quaterniond expected = q;
+      expected.Normalize();
+      // q and -q are the same rotation.
+      const double dot = expected.W() * out.W() + expected.X() * out.X() +
+                         expected.Y() * out.Y() + expected.Z() * out.Z();
+      EXPECT_NEAR(1.0, std::abs(dot), tol * tol);
+      EXPECT_NEAR(std::abs(expected.X()), std::abs(out.X()), tol);
+      EXPECT_NEAR(std::abs(expected.Y()), std::abs(out.Y()), tol);
+      EXPECT_NEAR(std::abs(expected.Z()), std::abs(out.Z()), tol);
+    }
+    EXPECT_EQ(0u, decoder.Remaining());
+  }
+
+  // A zero quaternion encodes the identity.
+  std::vector<uint8_t> buffer;
+  math::BinaryEncoder encoder(buffer);
+  encoder.WriteSmallestThree(math::Quaterniond(0, 0, 0, 0));
+  math::BinaryDecoder decoder(buffer);
+  math::Quaterniond out(0, 1, 0, 0);
+  EXPECT_TRUE(decoder.ReadSmallestThree(out));
+  EXPECT_EQ(math::Quaterniond::Identity, out);
+
+  // Truncated input fails.
+  math::BinaryDecoder truncated(buffer.data(), buffer.size() - 1);
+  EXPECT_FALSE(truncated.ReadSmallestThree(out));
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryCodecTest, PoseDeltas)
+{
+  std::vector<math::Pose3d> poses;
+  for (int i = 0; i < 1000; ++i)
+  {
+    const double t = 0.01 * i;
+    poses.emplace_back(std::cos(t) * 10, std::sin(t) * 10, 0.1 * t,
+                       0, 0.1 * std::sin(t), t);
+  }
+  // A flipped quaternion must not make the deltas large.
+  poses[500].Rot() = -poses[500].Rot();
+
+  std::vector<uint8_t> buffer;
+  math::BinaryEncoder encoder(buffer);
+  EXPECT_TRUE(encoder.WritePoseDeltas(poses.data(), poses.size()));
+  EXPECT_LT(buffer.size(), 16 * poses.size());
+
+  std::vector<math::Pose3d> out;
+  math::BinaryDecoder decoder(buffer);
+  EXPECT_TRUE(decoder.ReadPoseDeltas(out));
+  EXPECT_EQ(0u, decoder.Remaining());
+  ASSERT_EQ(poses.size(), out.size());
+  for (std::size_t i = 0; i < poses.size(); ++i)
+  {
+    EXPECT_NEAR(poses[i].Pos().X(), out[i].Pos().X(), 5e-6);
+    EXPECT_NEAR(poses[i].Pos().Y(), out[i].Pos().Y(), 5e-6);
+    EXPECT_NEAR(poses[i].Pos().Z(), out[i].Pos().Z(), 5e-6);
+    const math::Quaterniond &q = poses[i].Rot();
+    const math::Quaterniond &r = out[i].Rot();
+    const double dot =
+      q.W() * r.W() + q.X() * r.X() + q.Y() * r.Y() + q.Z() * r.Z();
+    EXPECT_NEAR(1.0, std::abs(dot), 1e-10);
+  }
+
+  // Float poses, and coarser settings.
+  std::vector<math::Pose3f> posesF = {
+    math::Pose3f(1, 2, 3, 0.1f, 0.2f, 0.3f),
+    math::Pose3f(1.5f, 2, 3, 0.1f, 0.2f, 0.4f)};
+  std::vector<uint8_t> bufferF;
+  math::BinaryEncoder encoderF(bufferF);
+  EXPECT_TRUE(encoderF.WritePoseDeltas(posesF.data(), posesF.size(),
+                                       1e-3, 12));
+  std::vector<math::Pose3f> outF;
+  math::BinaryDecoder decoderF(bufferF);
+  EXPECT_TRUE(decoderF.ReadPoseDeltas(outF));
+  ASSERT_EQ(2u, outF.size());
+  EXPECT_NEAR(1.5f, outF[1].Pos().X(), 1e-3f);
+  EXPECT_NEAR(0.4f, outF[1].Rot().Euler().Z(), 1e-2f);
+
+  // Invalid parameters write nothing.
+  std::vector<uint8_t> empty;
+  math::BinaryEncoder invalid(empty);
+  EXPECT_FALSE(invalid.WritePoseDeltas(poses.data(), poses.size(), 0.0));
+  EXPECT_FALSE(invalid.WritePoseDeltas(poses.data(), poses.size(),
+                                       std::nan(""), 20));
+  EXPECT_FALSE(invalid.WritePoseDeltas(poses.data(), poses.size(),
+                                       1e-5, 31));
+  EXPECT_TRUE(empty.empty());
+
+  // Truncated input fails and leaves the output unchanged.
+  math::BinaryDecoder truncated(buffer.data(), buffer.size() / 2);
+  EXPECT_FALSE(truncated.ReadPoseDeltas(outF));
+  EXPECT_EQ(2u, outF.size());
+  EXPECT_FALSE(truncated.Good());
+
+  // Non-finite values are encoded as zero.
+  std::vector<math::Pose3d> nonFinite = {math::Pose3d(
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::infinity(), 1, 0, 0, 0)};
+  std::vector<uint8_t> bufferN;
+  math::BinaryEncoder encoderN(bufferN);
+  EXPECT_TRUE(encoderN.WritePoseDeltas(nonFinite.data(), 1));
+  math::BinaryDecoder decoderN(bufferN);
+  EXPECT_TRUE(decoderN.ReadPoseDeltas(out));
+  ASSERT_EQ(1u, out.size());
+  EXPECT_DOUBLE_EQ(0.0, out[0].Pos().X());
+  EXPECT_TRUE(std::isfinite(out[0].Pos().Y()));
+  EXPECT_NEAR(1.0, out[0].Pos().Z(), 1e-5);
+}
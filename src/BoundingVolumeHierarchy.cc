@@ -0,0 +1,1030 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+#include "gz/math/BoundingVolumeHierarchy.hh"
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/Trace.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Number of bins used to evaluate the surface area heuristic.
+  const int kBins = 16;
+
+  /// \brief Boxes in a node at or below which a leaf is always created.
+  const uint32_t kMinLeafSize = 2;
+
+  /// \brief Maximum number of boxes in a leaf.
+  const uint32_t kMaxLeafSize = 16;
+
+  /// \brief Depth from which nodes are split at the median, which bounds
+  /// the depth of the tree.
+  const int kMedianSplitDepth = 64;
+
+  /// \brief Minimum number of boxes in each subtree built by its own
+  /// thread.
+  const uint32_t kMinBoxesPerThread = 16384;
+
+  /// \brief Size of the traversal stacks. It is larger than the deepest
+  /// possible tree: kMedianSplitDepth plus log2 of the maximum box count.
+  const int kStackSize = 128;
+
+  /// \brief A node of the tree.
+  struct Node
+  {
+    /// \brief Minimum corner of the node bounds.
+    Vector3d min;
+
+    /// \brief Maximum corner of the node bounds.
+    Vector3d max;
+
+    /// \brief For leaves, index of the first box in the leaf order. For
+    /// interior nodes, index of the second child. The first child is always
+    /// the next node.
+    uint32_t offset;
+
+    /// \brief Number of boxes of a leaf, 0 for interior nodes.
+    uint32_t count;
+  };
+
+  /// \brief A ray prepared for slab tests.
+  struct Ray
+  {
+    /// \brief Origin of the ray.
+    Vector3d origin;
+
+    /// \brief Component-wise inverse of the normalized direction. Zero
+    /// components are replaced by the largest double, which avoids
+    /// 0 * inf products in the slab test.
+    Vector3d invDir;
+
+    /// \brief Distance range along the ray.
+    double min;
+
+    /// \brief Distance range along the ray.
+    double max;
+  };
+
+  /////////////////////////////////////////////////
+  Ray MakeRay(const Vector3d &_origin, const Vector3d &_dir,
+              const double _min, const double _max)
+  {
+    Ray ray;
+    ray.origin = _origin;
+    Vector3d dir = _dir;
+    dir.Normalize();
+    auto inverse = [](const double _d)
+    {
+      return std::abs(_d) > 0 ? 1.0 / _d :
+        std::copysign(std::numeric_limits<double>::max(), _d);
+    };
+    ray.invDir.Set(inverse(dir.X()), inverse(dir.Y()), inverse(dir.Z()));
+    ray.min = _min;
+    ray.max = _max;
+    return ray;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Clip a distance range against one slab of a box.
+  inline void ClipSlab(const double _min, const double _max,
+                       const double _origin, const double _invDir,
+                       double &_enter, double &_exit)
+  {
+    double t1 = (_min - _origin) * _invDir;
+    double t2 = (_max - _origin) * _invDir;
+    if (t1 > t2)
+      std::swap(t1, t2);
+    _enter = std::max(_enter, t1);
+    _exit = std::min(_exit, t2);
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Slab test of a ray against a box.
+  /// \param[in] _ray The ray.
+  /// \param[in] _min Minimum corner of the box.
+  /// \param[in] _max Maximum corner of the box.
+  /// \param[in] _far Farthest distance of interest.
+  /// \param[out] _enter Distance along the ray where it enters the box.
+  /// \return True if the ray hits the box before _far.
+  inline bool Slab(const Ray &_ray, const Vector3d &_min, const Vector3d &_max,
+                   const double _far, double &_enter)
+  {
+    double enter = _ray.min;
+    double exit = _far;
+    ClipSlab(_min.X(), _max.X(), _ray.origin.X(), _ray.invDir.X(),
+             enter, exit);
+    ClipSlab(_min.Y(), _max.Y(), _ray.origin.Y(), _ray.invDir.Y(),
+             enter, exit);
+    ClipSlab(_min.Z(), _max.Z(), _ray.origin.Z(), _ray.invDir.Z(),
+             enter, exit);
+    _enter = enter;
+    return enter <= exit;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Refinement of closest hit queries against the boxes
+  /// themselves, which counts every box hit at the distance where the ray
+  /// enters it.
+  inline bool BoxHit(const uint32_t, double &)
+  {
+    return true;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Squared distance from a point to a box, zero inside of it.
+  inline double DistanceSquared(const Vector3d &_point, const Vector3d &_min,
+                                const Vector3d &_max)
+  {
+    double distSq = 0;
+    for (int a = 0; a < 3; ++a)
+    {
+      const double d = std::max(std::max(_min[a] - _point[a], 0.0),
+                                _point[a] - _max[a]);
+      distSq += d * d;
+    }
+    return distSq;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Half of the surface area of a box.
+  inline double HalfArea(const Vector3d &_min, const Vector3d &_max)
+  {
+    const Vector3d d = _max - _min;
+    return d.X() * d.Y() + d.Y() * d.Z() + d.Z() * d.X();
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Grow a box to include another box.
+  inline void Grow(Vector3d &_min, Vector3d &_max,
+                   const Vector3d &_boxMin, const Vector3d &_boxMax)
+  {
+    _min.Min(_boxMin);
+    _max.Max(_boxMax);
+  }
+}
+
+/// \brief Private data for BoundingVolumeHierarchy.
+class gz::math::BoundingVolumeHierarchyPrivate
+{
+  /// \brief Build the subtree of a range of boxes.
+  /// \param[in,out] _nodes Nodes to append the subtree to.
+  /// \param[in] _begin First box of the range, in leaf order.
+  /// \param[in] _end One past the last box of the range, in leaf order.
+  /// \param[in] _depth Depth of the node.
+  /// \param[in] _threads Number of threads to build the subtree with.
+  /// The two subtrees of a node are built concurrently, into separate
+  /// node arrays which are then concatenated, so the result is the same
+  /// as with a single thread.
+  public: void BuildNode(std::vector<Node> &_nodes, uint32_t _begin,
+                         uint32_t _end, int _depth, unsigned int _threads);
+
+  /// \brief Closest hit query.
+  /// \param[in] _ray The ray.
+  /// \param[out] _dist Distance along the ray of the closest hit.
+  /// \param[in] _refine Function called with the leaf order index of each
+  /// box hit and the distance along the ray where the ray enters it. It
+  /// returns false if the box does not count as hit, and may increase the
+  /// distance to that of the primitive inside the box.
+  /// \return Index of the closest box hit in the leaf order, or the number
+  /// of boxes if there is no hit.
+  public: template<typename Refine>
+          uint32_t Closest(const Ray &_ray, double &_dist,
+                           const Refine &_refine) const;
+
+  /// \brief Nearest box query.
+  /// \param[in] _point The point.
+  /// \param[in,out] _distSq Squared maximum distance from the point, set
+  /// to the squared distance of the nearest box.
+  /// \param[in] _refine Function called with the leaf order index of each
+  /// box within the current nearest distance and its squared distance from
+  /// the point. It returns false if the box does not count, and may
+  /// increase the squared distance to that of the primitive inside the box.
+  /// \return Index of the nearest box in the leaf order, or the number of
+  /// boxes if there is none within the maximum distance.
+  public: template<typename Refine>
+          uint32_t Nearest(const Vector3d &_point, double &_distSq,
+                           const Refine &_refine) const;
+
+  /// \brief Flat array of nodes. The root is the first node.
+  public: std::vector<Node> nodes;
+
+  /// \brief Index of each box in the vector passed to Build(), in leaf
+  /// order.
+  public: std::vector<uint32_t> indices;
+
+  /// \brief Minimum corner of each box, in leaf order.
+  public: std::vector<Vector3d> boxMin;
+
+  /// \brief Maximum corner of each box, in leaf order.
+  public: std::vector<Vector3d> boxMax;
+
+  /// \brief Center of each box, in leaf order. Only used during builds.
+  public: std::vector<Vector3d> centers;
+
+  /// \brief Number of boxes passed to Build().
+  public: std::size_t boxCount = 0;
+};
+
+/////////////////////////////////////////////////
+void BoundingVolumeHierarchyPrivate::BuildNode(std::vector<Node> &_nodes,
+    uint32_t _begin, uint32_t _end, int _depth, unsigned int _threads)
+{
+  const uint32_t nodeIndex = static_cast<uint32_t>(_nodes.size());
+  _nodes.push_back(Node());
+
+  Vector3d min(MAX_D, MAX_D, MAX_D);
+  Vector3d max(LOW_D, LOW_D, LOW_D);
+  Vector3d centerMin = min;
+  Vector3d centerMax = max;
+  for (uint32_t i = _begin; i < _end; ++i)
+  {
+    Grow(min, max, this->boxMin[i], this->boxMax[i]);
+    Grow(centerMin, centerMax, this->centers[i], this->centers[i]);
+  }
+  _nodes[nodeIndex].min = min;
+  _nodes[nodeIndex].max = max;
+
+  const uint32_t count = _end - _begin;
+  auto makeLeaf = [&]()
+  {
+    _nodes[nodeIndex].offset = _begin;
+    _nodes[nodeIndex].count = count;
+  };
+
+  if (count <= kMinLeafSize)
+  {
+    makeLeaf();
+    return;
+  }
+
+  // Split along the axis with the largest spread of box centers.
+  const Vector3d extent = centerMax - centerMin;
+  int axis = 0;
+  if (extent.Y() > extent[axis])
+    axis = 1;
+  if (extent.Z() > extent[axis])
+    axis = 2;
+
+  uint32_t mid = _begin;
+  if (extent[axis] <= 0 && count <= kMaxLeafSize)
+  {
+    makeLeaf();
+    return;
+  }
+
+  if (extent[axis] > 0 && _depth < kMedianSplitDepth)
+  {
+    // Bin the boxes by center.
+    int binCount[kBins] = {0};
+    Vector3d binMin[kBins];
+    Vector3d binMax[kBins];
+    for (int b = 0; b < kBins; ++b)
+    {
+      binMin[b] = Vector3d(MAX_D, MAX_D, MAX_D);
+      binMax[b] = Vector3d(LOW_D, LOW_D, LOW_D);
+    }
+
+    const double scale = kBins / extent[axis];
+    auto binOf = [&](uint32_t _i)
+    {
+      const int b = static_cast<int>(
+          (this->centers[_i][axis] - centerMin[axis]) * scale);
+      return std::min(b, kBins - 1);
+    };
+
+    for (uint32_t i = _begin; i < _end; ++i)
+    {
+      const int b = binOf(i);
+      ++binCount[b];
+      Grow(binMin[b], binMax[b], this->boxMin[i], this->boxMax[i]);
+    }
+
+    // Sweep from the right to get the cost of the right side of each split.
+    double rightCost[kBins];
+    Vector3d accMin(MAX_D, MAX_D, MAX_D);
+    Vector3d accMax(LOW_D, LOW_D, LOW_D);
+    int accCount = 0;
+    for (int b = kBins - 1; b > 0; --b)
+    {
+      Grow(accMin, accMax, binMin[b], binMax[b]);
+      accCount += binCount[b];
+      rightCost[b] = accCount > 0 ? accCount * HalfArea(accMin, accMax) : 0;
+    }
+
+    // Sweep from the left and keep the cheapest split.
+    double bestCost = MAX_D;
+    int bestSplit = -1;
+    accMin = Vector3d(MAX_D, MAX_D, MAX_D);
+    accMax = Vector3d(LOW_D, LOW_D, LOW_D);
+    accCount = 0;
+    for (int b = 0; b < kBins - 1; ++b)
+    {
+      Grow(accMin, accMax, binMin[b], binMax[b]);
+      accCount += binCount[b];
+      if (accCount == 0 || accCount == static_cast<int>(count))
+        continue;
+
+      const double cost = accCount * HalfArea(accMin, accMax) +
+        rightCost[b + 1];
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        bestSplit = b;
+      }
+    }
+
+    // Compare against the cost of a leaf. A traversal step costs about as
+    // much as one box test.
+    const double area = HalfArea(min, max);
+    const double leafCost = count;
+    const double splitCost = area > 0 ? 1.0 + bestCost / area : leafCost;
+    if (bestSplit < 0 || (splitCost >= leafCost && count <= kMaxLeafSize))
+    {
+      if (count <= kMaxLeafSize)
+      {
+        makeLeaf();
+        return;
+      }
+    }
+    else
+    {
+      // Partition the boxes, and their data, around the split.
+      uint32_t left = _begin;
+      uint32_t right = _end;
+      while (left < right)
+      {
+        if (binOf(left) <= bestSplit)
+        {
+          ++left;
+        }
+        else
+        {
+          --right;
+          std::swap(this->indices[left], this->indices[right]);
+          std::swap(this->boxMin[left], this->boxMin[right]);
+          std::swap(this->boxMax[left], this->boxMax[right]);
+          std::swap(this->centers[left], this->centers[right]);
+        }
+      }
+      mid = left;
+    }
+  }
+
+  // Median split, used when the boxes can't be binned.
+  if (mid == _begin || mid == _end)
+  {
+    mid = _begin + count / 2;
+    std::vector<uint32_t> order(count);
+    for (uint32_t i = 0; i < count; ++i)
+      order[i] = _begin + i;
+    std::nth_element(order.begin(), order.begin() + count / 2, order.end(),
+      [&](uint32_t _a, uint32_t _b)
+      {
+        return this->centers[_a][axis] < this->centers[_b][axis];
+      });
+
+    std::vector<uint32_t> indicesTmp(count);
+    std::vector<Vector3d> minTmp(count), maxTmp(count), centerTmp(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      indicesTmp[i] = this->indices[order[i]];
+      minTmp[i] = this->boxMin[order[i]];
+      maxTmp[i] = this->boxMax[order[i]];
+      centerTmp[i] = this->centers[order[i]];
+    }
+    std::copy(indicesTmp.begin(), indicesTmp.end(),
+        this->indices.begin() + _begin);
+    std::copy(minTmp.begin(), minTmp.end(), this->boxMin.begin() + _begin);
+    std::copy(maxTmp.begin(), maxTmp.end(), this->boxMax.begin() + _begin);
+    std::copy(centerTmp.begin(), centerTmp.end(),
+        this->centers.begin() + _begin);
+  }
+
+  if (_threads > 1 &&
+      std::min(mid - _begin, _end - mid) >= kMinBoxesPerThread)
+  {
+    // The subtrees work on disjoint ranges of boxes, only the nodes are
+    // built separately.
+    std::vector<Node> secondNodes;
+    const unsigned int secondThreads = _threads / 2;
+    std::thread thread([&]()
+    {
+      secondNodes.reserve(2 * (_end - mid));
+      this->BuildNode(secondNodes, mid, _end, _depth + 1, secondThreads);
+    });
+    this->BuildNode(_nodes, _begin, mid, _depth + 1,
+                    _threads - secondThreads);
+    thread.join();
+
+    const uint32_t second = static_cast<uint32_t>(_nodes.size());
+    for (Node &node : secondNodes)
+    {
+      if (node.count == 0)
+        node.offset += second;
+    }
+    _nodes.insert(_nodes.end(), secondNodes.begin(), secondNodes.end());
+    _nodes[nodeIndex].offset = second;
+    _nodes[nodeIndex].count = 0;
+    return;
+  }
+
+  this->BuildNode(_nodes, _begin, mid, _depth + 1, _threads);
+  const uint32_t second = static_cast<uint32_t>(_nodes.size());
+  this->BuildNode(_nodes, mid, _end, _depth + 1, _threads);
+  _nodes[nodeIndex].offset = second;
+  _nodes[nodeIndex].count = 0;
+}
+
+/////////////////////////////////////////////////
+template<typename Refine>
+uint32_t BoundingVolumeHierarchyPrivate::Closest(const Ray &_ray,
+    double &_dist, const Refine &_refine) const
+{
+  const uint32_t noHit = static_cast<uint32_t>(this->indices.size());
+  uint32_t best = noHit;
+  double bestDist = _ray.max;
+  double enter;
+
+  if (this->nodes.empty() ||
+      !Slab(_ray, this->nodes[0].min, this->nodes[0].max, bestDist, enter))
+  {
+    return noHit;
+  }
+
+  uint32_t stack[kStackSize];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const Node &node = this->nodes[stack[--top]];
+
+    if (node.count > 0)
+    {
+      for (uint32_t i = node.offset; i < node.offset + node.count; ++i)
+      {
+        if (!Slab(_ray, this->boxMin[i], this->boxMax[i], bestDist, enter) ||
+            !_refine(i, enter) || !(enter <= bestDist))
+        {
+          continue;
+        }
+        if (enter < bestDist || best == noHit ||
+            this->indices[i] < this->indices[best])
+        {
+          bestDist = enter;
+          best = i;
+        }
+      }
+      continue;
+    }
+
+    // Visit the nearest child first.
+    const uint32_t first = static_cast<uint32_t>(&node - &this->nodes[0]) + 1;
+    const uint32_t second = node.offset;
+    double enterFirst, enterSecond;
+    const bool hitFirst = Slab(_ray, this->nodes[first].min,
+        this->nodes[first].max, bestDist, enterFirst);
+    const bool hitSecond = Slab(_ray, this->nodes[second].min,
+        this->nodes[second].max, bestDist, enterSecond);
+
+    if (hitFirst && hitSecond)
+    {
+      if (enterFirst <= enterSecond)
+      {
+        stack[top++] = second;
+        stack[top++] = first;
+      }
+      else
+      {
+        stack[top++] = first;
+        stack[top++] = second;
+      }
+    }
+    else if (hitFirst)
+    {
+      stack[top++] = first;
+    }
+    else if (hitSecond)
+    {
+      stack[top++] = second;
+    }
+  }
+
+  _dist = bestDist;
+  return best;
+}
+
+/////////////////////////////////////////////////
+template<typename Refine>
+uint32_t BoundingVolumeHierarchyPrivate::Nearest(const Vector3d &_point,
+    double &_distSq, const Refine &_refine) const
+{
+  const uint32_t none = static_cast<uint32_t>(this->indices.size());
+  uint32_t best = none;
+  double bestDistSq = _distSq;
+
+  if (this->nodes.empty() ||
+      DistanceSquared(_point, this->nodes[0].min, this->nodes[0].max) >
+      bestDistSq)
+  {
+    return none;
+  }
+
+  uint32_t stack[kStackSize];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const uint32_t nodeIndex = stack[--top];
+    const Node &node = this->nodes[nodeIndex];
+
+    // The nearest distance may have decreased since the node was pushed.
+    if (DistanceSquared(_point, node.min, node.max) > bestDistSq)
+      continue;
+
+    if (node.count > 0)
+    {
+      for (uint32_t i = node.offset; i < node.offset + node.count; ++i)
+      {
+        double distSq =
+            DistanceSquared(_point, this->boxMin[i], this->boxMax[i]);
+        if (distSq > bestDistSq || !_refine(i, distSq) ||
+            !(distSq <= bestDistSq))
+        {
+          continue;
+        }
+        if (distSq < bestDistSq || best == none ||
+            this->indices[i] < this->indices[best])
+        {
+          bestDistSq = distSq;
+          best = i;
+        }
+      }
+      continue;
+    }
+
+    // Visit the nearest child first.
+    const uint32_t first = nodeIndex + 1;
+    const uint32_t second = node.offset;
+    const double distFirst = DistanceSquared(_point,
+        this->nodes[first].min, this->nodes[first].max);
+    const double distSecond = DistanceSquared(_point,
+        this->nodes[second].min, this->nodes[second].max);
+    const bool nearFirst = distFirst <= distSecond;
+    const uint32_t nearNode = nearFirst ? first : second;
+    const uint32_t farNode = nearFirst ? second : first;
+    if (std::max(distFirst, distSecond) <= bestDistSq)
+      stack[top++] = farNode;
+    if (std::min(distFirst, distSecond) <= bestDistSq)
+      stack[top++] = nearNode;
+  }
+
+  _distSq = bestDistSq;
+  return best;
+}
+
+/////////////////////////////////////////////////
+BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+  : dataPtr(std::make_unique<BoundingVolumeHierarchyPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(
+    const std::vector<AxisAlignedBox> &_boxes)
+  : BoundingVolumeHierarchy()
+{
+  this->Build(_boxes);
+}
+
+/////////////////////////////////////////////////
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(
+    const BoundingVolumeHierarchy &_bvh)
+  : dataPtr(std::make_unique<BoundingVolumeHierarchyPrivate>(*_bvh.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy() = default;
+
+/////////////////////////////////////////////////
+BoundingVolumeHierarchy &BoundingVolumeHierarchy::operator=(
+    const BoundingVolumeHierarchy &_bvh)
+{
+  *this->dataPtr = *_bvh.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void BoundingVolumeHierarchy::Build(const std::vector<AxisAlignedBox> &_boxes)
+{
+  this->Build(_boxes, 1);
+}
+
+/////////////////////////////////////////////////
+void BoundingVolumeHierarchy::Build(const std::vector<AxisAlignedBox> &_boxes,
+    const unsigned int _threads)
+{
+  IGN_MATH_TRACE_ZONE("BoundingVolumeHierarchy::Build");
+  auto &d = *this->dataPtr;
+  d.nodes.clear();
+  d.indices.clear();
+  d.boxMin.clear();
+  d.boxMax.clear();
+  d.centers.clear();
+  d.boxCount = _boxes.size();
+
+  if (_boxes.size() >= std::numeric_limits<uint32_t>::max())
+  {
+    IGN_MATH_DIAGNOSTIC(
+        "BoundingVolumeHierarchy::Build() error: too many boxes ["
+        << _boxes.size() << "]");
+    d.boxCount = 0;
+    return;
+  }
+
+  for (std::size_t i = 0; i < _boxes.size(); ++i)
+  {
+    const Vector3d &min = _boxes[i].Min();
+    const Vector3d &max = _boxes[i].Max();
+    if (min.X() > max.X() || min.Y() > max.Y() || min.Z() > max.Z())
+      continue;
+
+    d.indices.push_back(static_cast<uint32_t>(i));
+    d.boxMin.push_back(min);
+    d.boxMax.push_back(max);
+    d.centers.push_back((min + max) * 0.5);
+  }
+
+  if (!d.indices.empty())
+  {
+    unsigned int threads = _threads;
+    if (threads == 0)
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    d.nodes.reserve(2 * d.indices.size());
+    d.BuildNode(d.nodes, 0, static_cast<uint32_t>(d.indices.size()), 0,
+                threads);
+  }
+
+  d.centers.clear();
+  d.centers.shrink_to_fit();
+}
+
+/////////////////////////////////////////////////
+std::size_t BoundingVolumeHierarchy::BoxCount() const
+{
+  return this->dataPtr->boxCount;
+}
+
+/////////////////////////////////////////////////
+std::size_t BoundingVolumeHierarchy::NodeCount() const
+{
+  return this->dataPtr->nodes.size();
+}
+
+/////////////////////////////////////////////////
+bool BoundingVolumeHierarchy::Empty() const
+{
+  return this->dataPtr->nodes.empty();
+}
+
+/////////////////////////////////////////////////
+AxisAlignedBox BoundingVolumeHierarchy::Bounds() const
+{
+  if (this->dataPtr->nodes.empty())
+    return AxisAlignedBox();
+
+  return AxisAlignedBox(this->dataPtr->nodes[0].min,
+                        this->dataPtr->nodes[0].max);
+}
+
+/////////////////////////////////////////////////
+std::tuple<bool, double, std::size_t> BoundingVolumeHierarchy::ClosestHit(
+    const Vector3d &_origin, const Vector3d &_dir,
+    const double _min, const double _max) const
+{
+  const Ray ray = MakeRay(_origin, _dir, _min, _max);
+  double dist = 0;
+  const uint32_t hit = this->dataPtr->Closest(ray, dist, BoxHit);
+  if (hit == this->dataPtr->indices.size())
+    return std::make_tuple(false, 0.0, kNoHit);
+
+  return std::make_tuple(true, dist - _min,
+      static_cast<std::size_t>(this->dataPtr->indices[hit]));
+}
+
+/////////////////////////////////////////////////
+std::tuple<bool, double, std::size_t> BoundingVolumeHierarchy::ClosestHit(
+    const Vector3d &_origin, const Vector3d &_dir,
+    const double _min, const double _max,
+    const std::function<bool(std::size_t, double &)> &_hit) const
+{
+  const auto &d = *this->dataPtr;
+  const Ray ray = MakeRay(_origin, _dir, _min, _max);
+  double dist = 0;
+  const uint32_t hit = d.Closest(ray, dist,
+      [&](const uint32_t _i, double &_dist)
+      {
+        double primitiveDist = _dist;
+        if (!_hit(d.indices[_i], primitiveDist) || primitiveDist < _min)
+          return false;
+        _dist = primitiveDist;
+        return true;
+      });
+  if (hit == d.indices.size())
+    return std::make_tuple(false, 0.0, kNoHit);
+
+  return std::make_tuple(true, dist - _min,
+      static_cast<std::size_t>(d.indices[hit]));
+}
+
+/////////////////////////////////////////////////
+bool BoundingVolumeHierarchy::AnyHit(const Vector3d &_origin,
+    const Vector3d &_dir, const double _min, const double _max) const
+{
+  const auto &d = *this->dataPtr;
+  const Ray ray = MakeRay(_origin, _dir, _min, _max);
+  double enter;
+
+  if (d.nodes.empty())
+    return false;
+
+  uint32_t stack[kStackSize];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const uint32_t nodeIndex = stack[--top];
+    const Node &node = d.nodes[nodeIndex];
+    if (!Slab(ray, node.min, node.max, ray.max, enter))
+      continue;
+
+    if (node.count == 0)
+    {
+      stack[top++] = node.offset;
+      stack[top++] = nodeIndex + 1;
+      continue;
+    }
+
+    for (uint32_t i = node.offset; i < node.offset + node.count; ++i)
+    {
+      if (Slab(ray, d.boxMin[i], d.boxMax[i], ray.max, enter))
+        return true;
+    }
+  }
+
+  return false;
+}
+
+/////////////////////////////////////////////////
+bool BoundingVolumeHierarchy::ClosestHits(
+    const std::vector<Vector3d> &_origins,
+    const std::vector<Vector3d> &_dirs,
+    const double _min, const double _max,
+    std::vector<std::size_t> &_indices,
+    std::vector<double> &_distances) const
+{
+  IGN_MATH_TRACE_ZONE("BoundingVolumeHierarchy::ClosestHits");
+  if (_origins.size() != _dirs.size())
+  {
+    IGN_MATH_DIAGNOSTIC("BoundingVolumeHierarchy::ClosestHits() error: "
+        << "origins [" << _origins.size() << "] and directions ["
+        << _dirs.size() << "] have different sizes");
+    return false;
+  }
+
+  const auto &d = *this->dataPtr;
+  _indices.resize(_origins.size());
+  _distances.resize(_origins.size());
+  for (std::size_t r = 0; r < _origins.size(); ++r)
+  {
+    const Ray ray = MakeRay(_origins[r], _dirs[r], _min, _max);
+    double dist = 0;
+    const uint32_t hit = d.Closest(ray, dist, BoxHit);
+    if (hit == d.indices.size())
+    {
+      _indices[r] = kNoHit;
+      _distances[r] = 0;
+    }
+    else
+    {
+      _indices[r] = d.indices[hit];
+      _distances[r] = dist - _min;
+    }
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::tuple<bool, double, std::size_t> BoundingVolumeHierarchy::Nearest(
+    const Vector3d &_point, const double _maxDistance) const
+{
+  const auto &d = *this->dataPtr;
+  if (!(_maxDistance >= 0))
+    return std::make_tuple(false, 0.0, kNoHit);
+
+  double distSq = _maxDistance * _maxDistance;
+  const uint32_t nearest = d.Nearest(_point, distSq, BoxHit);
+  if (nearest == d.indices.size())
+    return std::make_tuple(false, 0.0, kNoHit);
+
+  return std::make_tuple(true, std::sqrt(distSq),
+      static_cast<std::size_t>(d.indices[nearest]));
+}
+
+/////////////////////////////////////////////////
+std::tuple<bool, double, std::size_t> BoundingVolumeHierarchy::Nearest(
+    const Vector3d &_point, const double _maxDistance,
+    const std::function<bool(std::size_t, double &)> &_distance) const
+{
+  const auto &d = *this->dataPtr;
+  if (!(_maxDistance >= 0))
+    return std::make_tuple(false, 0.0, kNoHit);
+
+  double distSq = _maxDistance * _maxDistance;
+  const uint32_t nearest = d.Nearest(_point, distSq,
+      [&](const uint32_t _i, double &_distSq)
+      {
+        double dist = std::sqrt(_distSq);
+        if (!_distance(d.indices[_i], dist))
+          return false;
+        _distSq = dist * dist;
+        return true;
+      });
+  if (nearest == d.indices.size())
+    return std::make_tuple(false, 0.0, kNoHit);
+
+  return std::make_tuple(true, std::sqrt(distSq),
+      static_cast<std::size_t>(d.indices[nearest]));
+}
+
+/////////////////////////////////////////////////
+void BoundingVolumeHierarchy::Overlaps(const AxisAlignedBox &_box,
+    std::vector<std::size_t> &_indices) const
+{
+  const auto &d = *this->dataPtr;
+  _indices.clear();
+  if (d.nodes.empty())
+    return;
+
+  const Vector3d &min = _box.Min();
+  const Vector3d &max = _box.Max();
+  auto intersects = [&](const Vector3d &_min, const Vector3d &_max)
+  {
+    return !(_max.X() < min.X() || _max.Y() < min.Y() || _max.Z() < min.Z() ||
+             _min.X() > max.X() || _min.Y() > max.Y() || _min.Z() > max.Z());
+  };
+
+  uint32_t stack[kStackSize];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const uint32_t nodeIndex = stack[--top];
+    const Node &node = d.nodes[nodeIndex];
+    if (!intersects(node.min, node.max))
+      continue;
+
+    if (node.count == 0)
+    {
+      stack[top++] = node.offset;
+      stack[top++] = nodeIndex + 1;
+      continue;
+    }
+
+    for (uint32_t i = node.offset; i < node.offset + node.count; ++i)
+    {
+      if (intersects(d.boxMin[i], d.boxMax[i]))
+        _indices.push_back(d.indices[i]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void BoundingVolumeHierarchy::Overlaps(const Frustum &_frustum,
+    std::vector<std::size_t> &_indices) const
+{
+  const auto &d = *this->dataPtr;
+  _indices.clear();
+  if (d.nodes.empty())
+    return;
+
+  const int planeCount = Frustum::FRUSTUM_PLANE_BOTTOM + 1;
+  Planed planes[planeCount];
+  for (int p = 0; p < planeCount; ++p)
+    planes[p] = _frustum.Plane(static_cast<Frustum::FrustumPlane>(p));
+
+  // Classify a box against the planes of a mask, in the same way as
+  // Plane::Side. Returns false if the box is outside of one of them, and
+  // otherwise the planes that it straddles.
+  auto classify = [&](const Vector3d &_min, const Vector3d &_max,
+                      const unsigned int _mask, unsigned int &_straddled)
+  {
+    const double cx = 0.5 * _min.X() + 0.5 * _max.X();
+    const double cy = 0.5 * _min.Y() + 0.5 * _max.Y();
+    const double cz = 0.5 * _min.Z() + 0.5 * _max.Z();
+    const double hx = std::max(0.0, _max.X() - _min.X()) / 2.0;
+    const double hy = std::max(0.0, _max.Y() - _min.Y()) / 2.0;
+    const double hz = std::max(0.0, _max.Z() - _min.Z()) / 2.0;
+
+    _straddled = 0;
+    for (int p = 0; p < planeCount; ++p)
+    {
+      if (!(_mask & (1u << p)))
+        continue;
+
+      const Vector3d &n = planes[p].Normal();
+      const double dist = n.X() * cx + n.Y() * cy + n.Z() * cz -
+        planes[p].Offset();
+      const double r = std::abs(n.X() * hx) + std::abs(n.Y() * hy) +
+        std::abs(n.Z() * hz);
+      if (dist < -r)
+        return false;
+      if (!(dist > r))
+        _straddled |= 1u << p;
+    }
+    return true;
+  };
+
+  struct Entry
+  {
+    uint32_t node;
+    unsigned int mask;
+  };
+
+  Entry stack[kStackSize];
+  int top = 0;
+  stack[top++] = {0, (1u << planeCount) - 1};
+  while (top > 0)
+  {
+    const Entry entry = stack[--top];
+    const Node &node = d.nodes[entry.node];
+
+    unsigned int straddled = 0;
+    if (!classify(node.min, node.max, entry.mask, straddled))
+      continue;
+
+    // The subtree is inside every plane. Its boxes are contiguous in the
+    // leaf order, between its leftmost and rightmost leaves.
+    if (straddled == 0)
+    {
+      uint32_t first = entry.node;
+      while (d.nodes[first].count == 0)
+        ++first;
+      uint32_t last = entry.node;
+      while (d.nodes[last].count == 0)
+        last = d.nodes[last].offset;
+
+      const uint32_t end = d.nodes[last].offset + d.nodes[last].count;
+      for (uint32_t i = d.nodes[first].offset; i < end; ++i)
+        _indices.push_back(d.indices[i]);
+      continue;
+    }
+
+    if (node.count == 0)
+    {
+      stack[top++] = {node.offset, straddled};
+      stack[top++] = {entry.node + 1, straddled};
+      continue;
+    }
+
+    for (uint32_t i = node.offset; i < node.offset + node.count; ++i)
+    {
+      unsigned int boxStraddled = 0;
+      if (!classify(d.boxMin[i], d.boxMax[i], straddled, boxStraddled))
+        continue;
+
+      // A box straddling several planes may still be outside of the
+      // frustum, which only the exact test of Frustum::Contains detects.
+      // The planes that were skipped are ones the box is inside of.
+      if ((boxStraddled & (boxStraddled - 1)) &&
+          !_frustum.Contains(AxisAlignedBox(d.boxMin[i], d.boxMax[i])))
+      {
+        continue;
+      }
+      _indices.push_back(d.indices[i]);
+    }
+  }
+}
@@ -0,0 +1,482 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "gz/math/BoundingVolumeHierarchy.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Triangle3.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+/// \brief Random boxes with a center in [-_range, _range] and sides up to
+/// _size.
+std::vector<AxisAlignedBox> RandomBoxes(std::size_t _count, double _range,
+    double _size)
+{
+  std::vector<AxisAlignedBox> boxes;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    Vector3d center(Rand::DblUniform(-_range, _range),
+                    Rand::DblUniform(-_range, _range),
+                    Rand::DblUniform(-_range, _range));
+    Vector3d half(Rand::DblUniform(0, _size), Rand::DblUniform(0, _size),
+                  Rand::DblUniform(0, _size));
+    boxes.push_back(AxisAlignedBox(center - half * 0.5, center + half * 0.5));
+  }
+  return boxes;
+}
+
+/////////////////////////////////////////////////
+TEST(BoundingVolumeHierarchyTest, Empty)
+{
+  BoundingVolumeHierarchy bvh;
+  EXPECT_TRUE(bvh.Empty());
+  EXPECT_EQ(0u, bvh.BoxCount());
+  EXPECT_EQ(0u, bvh.NodeCount());
+  EXPECT_EQ(AxisAlignedBox(), bvh.Bounds());
+
+  auto hit = bvh.ClosestHit(Vector3d::Zero, Vector3d::UnitX, 0, 100);
+  EXPECT_FALSE(std::get<0>(hit));
+  EXPECT_DOUBLE_EQ(0, std::get<1>(hit));
+  EXPECT_EQ(BoundingVolumeHierarchy::kNoHit, std::get<2>(hit));
+  EXPECT_FALSE(bvh.AnyHit(Vector3d::Zero, Vector3d::UnitX, 0, 100));
+
+  std::vector<std::size_t> indices = {1, 2};
+  bvh.Overlaps(AxisAlignedBox(-Vector3d::One, Vector3d::One), indices);
+  EXPECT_TRUE(indices.empty());
+
+  // Invalid boxes are ignored.
+  BoundingVolumeHierarchy invalid({AxisAlignedBox(), AxisAlignedBox()});
+  EXPECT_TRUE(invalid.Empty());
+  EXPECT_EQ(2u, invalid.BoxCount());
+}
+
+/////////////////////////////////////////////////
+TEST(BoundingVolumeHierarchyTest, Simple)
+{
+  std::vector<AxisAlignedBox> boxes = {
+    AxisAlignedBox(Vector3d(4, -1, -1), Vector3d(6, 1, 1)),
+    AxisAlignedBox(),
+    AxisAlignedBox(Vector3d(1, -1, -1), Vector3d(2, 1, 1)),
+    AxisAlignedBox(Vector3d(1, 5, -1), Vector3d(2, 6, 1))};
+
+  BoundingVolumeHierarchy bvh(boxes);
+  EXPECT_FALSE(bvh.Empty());
+  EXPECT_EQ(4u, bvh.BoxCount());
+  EXPECT_GE(bvh.NodeCount(), 1u);
+  EXPECT_EQ(AxisAlignedBox(Vector3d(1, -1, -1), Vector3d(6, 6, 1)),
+            bvh.Bounds());
+
+  // The closest box along +X is box 2.
+  auto hit = bvh.ClosestHit(Vector3d::Zero, Vector3d(2, 0, 0), 0, 100);
+  EXPECT_TRUE(std::get<0>(hit));
+  EXPECT_DOUBLE_EQ(1.0, std::get<1>(hit));
+  EXPECT_EQ(2u, std::get<2>(hit));
+
+  // Distances are measured from the start of the segment.
+  hit = bvh.ClosestHit(Vector3d::Zero, Vector3d::UnitX, 3, 100);
+  EXPECT_TRUE(std::get<0>(hit));
+  EXPECT_DOUBLE_EQ(1.0, std::get<1>(hit));
+  EXPECT_EQ(0u, std::get<2>(hit));
+
+  // Origin inside a box.
+  hit = bvh.ClosestHit(Vector3d(5, 0, 0), Vector3d::UnitX, 0, 100);
+  EXPECT_TRUE(std::get<0>(hit));
+  EXPECT_DOUBLE_EQ(0.0, std::get<1>(hit));
+  EXPECT_EQ(0u, std::get<2>(hit));
+
+  // Too short.
+  hit = bvh.ClosestHit(Vector3d::Zero, Vector3d::UnitX, 0, 0.5);
+  EXPECT_FALSE(std::get<0>(hit));
+  EXPECT_FALSE(bvh.AnyHit(Vector3d::Zero, Vector3d::UnitX, 0, 0.5));
+  EXPECT_TRUE(bvh.AnyHit(Vector3d::Zero, Vector3d::UnitX, 0, 1.5));
+
+  // Ray parallel to the faces of the boxes.
+  EXPECT_FALSE(bvh.AnyHit(Vector3d(0, 3, 0), Vector3d::UnitX, 0, 100));
+  hit = bvh.ClosestHit(Vector3d(1.5, -3, 0), Vector3d::UnitY, 0, 100);
+  EXPECT_TRUE(std::get<0>(hit));
+  EXPECT_DOUBLE_EQ(2.0, std::get<1>(hit));
+  EXPECT_EQ(2u, std::get<2>(hit));
+
+  std::vector<std::size_t> indices;
+  bvh.Overlaps(AxisAlignedBox(Vector3d(1.5, 0, 0), Vector3d(4, 5, 0)),
+               indices);
+  std::sort(indices.begin(), indices.end());
+  EXPECT_EQ(std::vector<std::size_t>({0, 2, 3}), indices);
+
+  // Copy and assignment.
+  BoundingVolumeHierarchy copy(bvh);
+  EXPECT_EQ(bvh.NodeCount(), copy.NodeCount());
+  EXPECT_EQ(bvh.Bounds(), copy.Bounds());
+  BoundingVolumeHierarchy assigned;
+  assigned = bvh;
+  EXPECT_TRUE(assigned.AnyHit(Vector3d::Zero, Vector3d::UnitX, 0, 1.5));
+
+  // Rebuild.
+  assigned.Build({});
+  EXPECT_TRUE(assigned.Empty());
+  EXPECT_FALSE(bvh.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(BoundingVolumeHierarchyTest, MatchesBruteForce)
+{
+  Rand::Seed(1234);
+
+  // Many small boxes, and also many overlapping and identical boxes.
+  auto boxes = RandomBoxes(2000, 50, 4);
+  for (std::size_t i = 0; i < 100; ++i)
+    boxes.push_back(AxisAlignedBox(Vector3d(-1, -1, -1), Vector3d(1, 1, 1)));
+
+  BoundingVolumeHierarchy bvh(boxes);
+  EXPECT_LT(bvh.NodeCount(), 2 * boxes.size());
+
+  std::vector<Vector3d> origins, dirs;
+  for (std::size_t r = 0; r < 500; ++r)
+  {
+    origins.push_back(Vector3d(Rand::DblUniform(-60, 60),
+                               Rand::DblUniform(-60, 60),
+                               Rand::DblUniform(-60, 60)));
+    dirs.push_back(Vector3d(Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1),
+                            Rand::DblUniform(-1, 1)));
+  }
+  // Axis aligned rays.
+  origins.push_back(Vector3d(-60, 0.5, 0.5));
+  dirs.push_back(Vector3d::UnitX);
+  origins.push_back(Vector3d(0.5, 60, 0.5));
+  dirs.push_back(-Vector3d::UnitY);
+
+  std::vector<std::size_t> hitIndices;
+  std::vector<double> hitDistances;
+  ASSERT_TRUE(bvh.ClosestHits(origins, dirs, 1, 80, hitIndices,
+                              hitDistances));
+  ASSERT_EQ(origins.size(), hitIndices.size());
+  ASSERT_EQ(origins.size(), hitDistances.size());
+
+  std::size_t hits = 0;
+  for (std::size_t r = 0; r < origins.size(); ++r)
+  {
+    bool expectedHit = false;
+    double expectedDist = 0;
+    for (const auto &box : boxes)
+    {
+      auto result = box.Intersect(origins[r], dirs[r], 1, 80);
+      if (std::get<0>(result) &&
+          (!expectedHit || std::get<1>(result) < expectedDist))
+      {
+        expectedHit = true;
+        expectedDist = std::get<1>(result);
+      }
+    }
+
+    auto hit = bvh.ClosestHit(origins[r], dirs[r], 1, 80);
+    ASSERT_EQ(expectedHit, std::get<0>(hit)) << r;
+    EXPECT_EQ(expectedHit, bvh.AnyHit(origins[r], dirs[r], 1, 80));
+    EXPECT_EQ(std::get<2>(hit), hitIndices[r]);
+    if (expectedHit)
+    {
+      ++hits;
+      EXPECT_NEAR(expectedDist, std::get<1>(hit), 1e-9);
+      EXPECT_NEAR(expectedDist, hitDistances[r], 1e-9);
+
+      // The reported box is hit at that distance.
+      auto result = boxes[std::get<2>(hit)].Intersect(origins[r], dirs[r],
+                                                      1, 80);
+      EXPECT_TRUE(std::get<0>(result));
+      EXPECT_NEAR(expectedDist, std::get<1>(result), 1e-9);
+    }
+    else
+    {
+      EXPECT_EQ(BoundingVolumeHierarchy::kNoHit, hitIndices[r]);
+    }
+  }
+  EXPECT_GT(hits, 10u);
+
+  for (std::size_t q = 0; q < 100; ++q)
+  {
+    const auto query = RandomBoxes(1, 50, 20)[0];
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+      if (boxes[i].Intersects(query))
+        expected.push_back(i);
+    }
+
+    std::vector<std::size_t> indices;
+    bvh.Overlaps(query, indices);
+    std::sort(indices.begin(), indices.end());
+    EXPECT_EQ(expected, indices);
+  }
+
+  // Mismatched batch sizes.
+  origins.pop_back();
+  EXPECT_FALSE(bvh.ClosestHits(origins, dirs, 1, 80, hitIndices,
+                               hitDistances));
+}
+
+/////////////////////////////////////////////////
+TEST(BoundingVolumeHierarchyTest, Triangles)
+{
+  Rand::Seed(2468);
+
+  // A bumpy height field mesh over [-20, 20] x [-20, 20]
+  const int n = 40;
+  std::vector<Vector3d> vertices;
+  for (int y = 0; y <= n; ++y)
+  {
+    for (int x = 0; x <= n; ++x)
+    {
+      vertices.push_back(Vector3d(x - n / 2, y - n / 2,
+                                  Rand::DblUniform(-1, 1)));
+    }
+  }
+  std::vector<unsigned int> indices;
+  for (int y = 0; y < n; ++y)
+  {
+    for (int x = 0; x < n; ++x)
+    {
+      const unsigned int i = y * (n + 1) + x;
+      indices.insert(indices.end(), {i, i + 1, i + n + 2});
+      indices.insert(indices.end(), {i, i + n + 2, i + n + 1});
+    }
+  }
+  const std::size_t triangleCount = indices.size() / 3;
+
+  std::vector<AxisAlignedBox> boxes;
+  for (std::size_t t = 0; t < triangleCount; ++t)
+  {
+    AxisAlignedBox box;
+    for (int k = 0; k < 3; ++k)
+      box.Merge(AxisAlignedBox(vertices[indices[3 * t + k]],
+                               vertices[indices[3 * t + k]]));
+    boxes.push_back(box);
+  }
+  const BoundingVolumeHierarchy bvh(boxes);
+
+  std::size_t hits = 0;
+  for (std::size_t r = 0; r < 300; ++r)
+  {
+    const Vector3d origin(Rand::DblUniform(-25, 25),
+                          Rand::DblUniform(-25, 25),
+                          Rand::DblUniform(2, 10));
+    const Vector3d dir(Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1),
+                       Rand::DblUniform(-1, 0.2));
+    const Vector3d unitDir = dir.Normalized();
+
+    std::size_t expectedTriangle = 0;
+    double expectedDist = 0;
+    const bool expectedHit = Triangle3d::ClosestHit(vertices.data(),
+        indices.data(), triangleCount, origin, dir, 0.5, 50,
+        expectedTriangle, expectedDist);
+
+    std::size_t tested = 0;
+    const auto hit = bvh.ClosestHit(origin, dir, 0.5, 50,
+        [&](std::size_t _t, double &_dist)
+        {
+          ++tested;
+          const unsigned int *tri = &indices[3 * _t];
+          double u, v;
+          return Triangle3d::RayIntersection(vertices[tri[0]],
+              vertices[tri[1]], vertices[tri[2]], origin, unitDir, _dist,
+              u, v);
+        });
+
+    ASSERT_EQ(expectedHit, std::get<0>(hit)) << r;
+    if (expectedHit)
+    {
+      ++hits;
+      EXPECT_EQ(expectedTriangle, std::get<2>(hit)) << r;
+      EXPECT_NEAR(expectedDist, std::get<1>(hit), 1e-9) << r;
+      EXPECT_LT(tested, triangleCount / 10) << r;
+    }
+    else
+    {
+      EXPECT_EQ(BoundingVolumeHierarchy::kNoHit, std::get<2>(hit));
+    }
+  }
+  EXPECT_GT(hits, 100u);
+
+  // Hits before _min are ignored, even if their box is hit after it
+  const auto hit = bvh.ClosestHit(Vector3d(0.3, 0.6, 5), -Vector3d::UnitZ,
+      4.5, 50, [](std::size_t, double &_dist)
+      {
+        _dist = 4;
+        return true;
+      });
+  EXPECT_FALSE(std::get<0>(hit));
+}
+
+/////////////////////////////////////////////////
+TEST(BoundingVolumeHierarchyTest, Frustum)
+{
+  Rand::Seed(4321);
+
+  // Boxes of all sizes, so that many of them straddle several planes.
+  auto boxes = RandomBoxes(5000, 40, 6);
+  boxes.push_back(AxisAlignedBox());
+  BoundingVolumeHierarchy bvh(boxes);
+
+  Frustum frustum;
+  frustum.SetNear(0.5);
+  frustum.SetFar(30);
+  frustum.SetFOV(1.05);
+  frustum.SetAspectRatio(1.8);
+
+  std::vector<std::size_t> indices;
+  for (int step = 0; step < 8; ++step)
+  {
+    frustum.SetPose(Pose3d(step * 2.0 - 8, 1, 2, 0, 0.1 * step, 0.8 * step));
+    bvh.Overlaps(frustum, indices);
+    std::sort(indices.begin(), indices.end());
+
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i + 1 < boxes.size(); ++i)
+    {
+      if (frustum.Contains(boxes[i]))
+        expected.push_back(i);
+    }
+    EXPECT_EQ(expected, indices) << step;
+    EXPECT_FALSE(indices.empty());
+  }
+
+  // A frustum that contains every box.
+  frustum.SetPose(Pose3d(-200, 0, 0, 0, 0, 0));
+  frustum.SetFar(500);
+  frustum.SetFOV(2.5);
+  frustum.SetAspectRatio(1);
+  bvh.Overlaps(frustum, indices);
+  EXPECT_EQ(boxes.size() - 1, indices.size());
+
+  // A frustum that contains no box.
+  frustum.SetPose(Pose3d(-200, 0, 0, 0, 0, IGN_PI));
+  bvh.Overlaps(frustum, indices);
+  EXPECT_TRUE(indices.empty());
+
+  BoundingVolumeHierarchy empty;
+  indices.push_back(1);
+  empty.Overlaps(frustum, indices);
+  EXPECT_TRUE(indices.empty());
+}
+
+/////////////////////////////////////////////////
+/// \brief Distance from a point to a box, zero inside of it.
+double BoxDistance(const Vector3d &_point, const AxisAlignedBox &_box)
+{
+  Vector3d clamped = _point;
+  clamped.Max(_box.Min());
+  clamped.Min(_box.Max());
+  return _point.Distance(clamped);
+}
+
+/////////////////////////////////////////////////
+TEST(BoundingVolumeHierarchyTest, Nearest)
+{
+  BoundingVolumeHierarchy empty;
+  auto nearest = empty.Nearest(Vector3d::Zero, MAX_D);
+  EXPECT_FALSE(std::get<0>(nearest));
+  EXPECT_EQ(BoundingVolumeHierarchy::kNoHit, std::get<2>(nearest));
+
+  std::vector<AxisAlignedBox> boxes = RandomBoxes(500, 20, 2);
+  BoundingVolumeHierarchy bvh(boxes);
+
+  for (int i = 0; i < 200; ++i)
+  {
+    Vector3d point(Rand::DblUniform(-30, 30), Rand::DblUniform(-30, 30),
+                   Rand::DblUniform(-30, 30));
+
+    std::size_t expected = BoundingVolumeHierarchy::kNoHit;
+    double expectedDist = MAX_D;
+    for (std::size_t b = 0; b < boxes.size(); ++b)
+    {
+      double dist = BoxDistance(point, boxes[b]);
+      if (dist < expectedDist)
+      {
+        expectedDist = dist;
+        expected = b;
+      }
+    }
+
+    nearest = bvh.Nearest(point, MAX_D);
+    ASSERT_TRUE(std::get<0>(nearest));
+    EXPECT_NEAR(expectedDist, std::get<1>(nearest), 1e-9);
+    EXPECT_EQ(expected, std::get<2>(nearest));
+
+    // Nothing is found closer than the nearest box.
+    nearest = bvh.Nearest(point, expectedDist * 0.5);
+    EXPECT_EQ(expectedDist <= 0, std::get<0>(nearest));
+
+    // Primitives at a fixed offset from their boxes, with odd boxes
+    // rejected.
+    nearest = bvh.Nearest(point, MAX_D,
+        [](std::size_t _index, double &_dist)
+        {
+          _dist += 1;
+          return _index % 2 == 0;
+        });
+    double evenDist = MAX_D;
+    for (std::size_t b = 0; b < boxes.size(); b += 2)
+      evenDist = std::min(evenDist, BoxDistance(point, boxes[b]) + 1);
+    ASSERT_TRUE(std::get<0>(nearest));
+    EXPECT_NEAR(evenDist, std::get<1>(nearest), 1e-9);
+    EXPECT_EQ(0u, std::get<2>(nearest) % 2);
+  }
+
+  // Negative and NaN maximum distances find nothing.
+  EXPECT_FALSE(std::get<0>(bvh.Nearest(Vector3d::Zero, -1)));
+  EXPECT_FALSE(std::get<0>(bvh.Nearest(Vector3d::Zero, NAN_D)));
+}
+
+/////////////////////////////////////////////////
+TEST(BoundingVolumeHierarchyTest, ThreadedBuild)
+{
+  std::vector<AxisAlignedBox> boxes = RandomBoxes(100000, 100, 1);
+  BoundingVolumeHierarchy serial(boxes);
+  BoundingVolumeHierarchy threaded;
+  threaded.Build(boxes, 4);
+  EXPECT_EQ(serial.BoxCount(), threaded.BoxCount());
+  EXPECT_EQ(serial.NodeCount(), threaded.NodeCount());
+  EXPECT_EQ(serial.Bounds(), threaded.Bounds());
+
+  BoundingVolumeHierarchy hardware;
+  hardware.Build(boxes, 0);
+  EXPECT_EQ(serial.NodeCount(), hardware.NodeCount());
+
+  std::vector<std::size_t> serialIndices;
+  std::vector<std::size_t> threadedIndices;
+  for (int i = 0; i < 50; ++i)
+  {
+    Vector3d origin(Rand::DblUniform(-150, 150), Rand::DblUniform(-150, 150),
+                    Rand::DblUniform(-150, 150));
+    Vector3d dir = (-origin).Normalized();
+    EXPECT_EQ(serial.ClosestHit(origin, dir, 0, 500),
+              threaded.ClosestHit(origin, dir, 0, 500));
+    EXPECT_EQ(serial.Nearest(origin, MAX_D),
+              threaded.Nearest(origin, MAX_D));
+
+    AxisAlignedBox box(origin * 0.5, origin * 0.5 + Vector3d(5, 5, 5));
+    serial.Overlaps(box, serialIndices);
+    threaded.Overlaps(box, threadedIndices);
+    EXPECT_EQ(serialIndices, threadedIndices);
+  }
+}
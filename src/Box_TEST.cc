@@ -15,6 +15,7 @@
  *
 */
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cmath>
 
 #include "gz/math/Box.hh"
@@ -458,6 +459,74 @@ TEST(BoxTest, VerticesBelow)
   }
 }
 
+//////////////////////////////////////////////////
+TEST(BoxTest, FixedIntersectionPoints)
+{
+  // Sorted and deduplicated like IntersectionPoints
+  math::FixedIntersectionPoints<double, 3> points;
+  EXPECT_TRUE(points.Empty());
+  EXPECT_TRUE(points.Insert(math::Vector3d(1, 0, 0)));
+  EXPECT_TRUE(points.Insert(math::Vector3d(0, 0, 1)));
+  EXPECT_FALSE(points.Insert(math::Vector3d(1, 0, 0)));
+  EXPECT_TRUE(points.Insert(math::Vector3d(0, 1, 0)));
+  ASSERT_EQ(3u, points.Size());
+  EXPECT_EQ(math::Vector3d(0, 0, 1), points[0]);
+  EXPECT_EQ(math::Vector3d(0, 1, 0), points[1]);
+  EXPECT_EQ(math::Vector3d(1, 0, 0), points[2]);
+
+  // Full
+  EXPECT_FALSE(points.Insert(math::Vector3d(2, 0, 0)));
+  EXPECT_EQ(3u, points.Size());
+
+  points.Clear();
+  EXPECT_TRUE(points.Empty());
+  EXPECT_EQ(points.begin(), points.end());
+
+  // Same points as the overloads which return a set
+  const math::Boxd boxes[] =
+  {
+    math::Boxd(2.0, 2.0, 2.0),
+    math::Boxd(1.0, 2.0, 3.0),
+    math::Boxd(1.0, 0.0, 3.0)
+  };
+  const math::Planed planes[] =
+  {
+    math::Planed(math::Vector3d(0, 0, 1), -5),
+    math::Planed(math::Vector3d(0, 0, 1), 0.5),
+    math::Planed(math::Vector3d(1, 1, 1), 0.5),
+    math::Planed(math::Vector3d(1, -2, 0.5), -0.1),
+    math::Planed(math::Vector3d(0, 0, -1), 20)
+  };
+  for (const auto &box : boxes)
+  {
+    for (const auto &plane : planes)
+    {
+      math::BoxIntersectionPoints<double> vertices;
+      box.VerticesBelow(plane, vertices);
+      const auto expectedVertices = box.VerticesBelow(plane);
+      ASSERT_EQ(expectedVertices.size(), vertices.Size());
+      EXPECT_TRUE(std::equal(vertices.begin(), vertices.end(),
+                             expectedVertices.begin()));
+
+      math::BoxIntersectionPoints<double> intersections;
+      box.Intersections(plane, intersections);
+      const auto expectedIntersections = box.Intersections(plane);
+      ASSERT_EQ(expectedIntersections.size(), intersections.Size());
+      EXPECT_TRUE(std::equal(intersections.begin(), intersections.end(),
+                             expectedIntersections.begin()));
+
+      // Both fit in a single buffer
+      box.Intersections(plane, vertices);
+      auto merged = expectedVertices;
+      merged.insert(expectedIntersections.begin(),
+                    expectedIntersections.end());
+      ASSERT_EQ(merged.size(), vertices.Size());
+      EXPECT_TRUE(std::equal(vertices.begin(), vertices.end(),
+                             merged.begin()));
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 TEST(BoxTest, Mass)
 {
@@ -481,3 +550,97 @@ TEST(BoxTest, Mass)
   EXPECT_EQ(expectedMassMat, massMat);
   EXPECT_DOUBLE_EQ(expectedMassMat.Mass(), massMat.Mass());
 }
+
+//////////////////////////////////////////////////
+TEST(BoxTest, Batch)
+{
+  const math::Vector3d sizes[] = {
+    {1.0, 2.0, 3.0}, {0.1, 0.2, 0.3}, {2.0, 0.0, 1.0}};
+  const double densities[] = {1000.0, 2.5, 1.0};
+  const double masses[] = {2.0, 3.0, 1.0};
+
+  double volumes[3];
+  double densitiesFromMass[3];
+  math::MassMatrix3d massMats[3];
+  math::Boxd::Volumes(sizes, 3, volumes);
+  math::Boxd::DensitiesFromMasses(sizes, masses, 3, densitiesFromMass);
+  EXPECT_FALSE(math::Boxd::MassMatrices(sizes, densities, 3, massMats));
+  EXPECT_TRUE(math::Boxd::MassMatrices(sizes, densities, 2, massMats));
+
+  for (int i = 0; i < 3; ++i)
+  {
+    math::Boxd box(sizes[i], math::Material(densities[i]));
+    EXPECT_DOUBLE_EQ(box.Volume(), volumes[i]);
+    EXPECT_DOUBLE_EQ(box.DensityFromMass(masses[i]), densitiesFromMass[i]);
+
+    math::MassMatrix3d expected;
+    EXPECT_EQ(box.MassMatrix(expected), massMats[i].Mass() > 0);
+    EXPECT_EQ(expected, massMats[i]);
+  }
+  EXPECT_DOUBLE_EQ(0.0, massMats[2].Mass());
+}
+
+//////////////////////////////////////////////////
+TEST(BoxTest, VolumesBelow)
+{
+  const math::Planed plane(math::Vector3d(0, 0, 2), 1.0);
+  const math::Vector3d sizes[] = {
+    {2, 2, 2}, {1, 2, 3}, {1, 2, 3}, {1, 1, 1}, {1, 1, 1}, {0.5, 4, 1}};
+  const math::Pose3d poses[] = {
+    {0, 0, 0.5, 0, 0, 0},
+    {1, 2, 0.2, 0.1, 0.2, 0.3},
+    {-1, 0, 0.8, IGN_PI / 4, 0, IGN_PI / 4},
+    {0, 0, 5, 0, 0, 0},
+    {3, 2, -5, 0.4, 0.5, 0.6},
+    {0, 0, 0.6, 0, IGN_PI / 2, 0}};
+  const std::size_t count = 6;
+
+  double volumes[count];
+  math::Vector3d centers[count];
+  math::Boxd::VolumesBelow(sizes, poses, count, plane, volumes, centers);
+
+  // Half of the box is below the plane z = 0.5
+  EXPECT_DOUBLE_EQ(4.0, volumes[0]);
+  EXPECT_EQ(math::Vector3d(0, 0, 0), centers[0]);
+
+  // Above and below the plane
+  EXPECT_DOUBLE_EQ(0.0, volumes[3]);
+  EXPECT_EQ(poses[3].Pos(), centers[3]);
+  EXPECT_DOUBLE_EQ(1.0, volumes[4]);
+  EXPECT_EQ(poses[4].Pos(), centers[4]);
+
+  // Rotated so that its 0.5 size is vertical, with 0.15 below the plane
+  EXPECT_NEAR(0.15 * 4, volumes[5], 1e-12);
+  EXPECT_EQ(math::Vector3d(0, 0, 0.5 - 0.15 / 2), centers[5]);
+
+  // Tilted boxes, compared with a fine sampling of the box
+  EXPECT_NEAR(3.6153, volumes[1], 1e-3);
+  EXPECT_TRUE(math::Vector3d(0.884, 2.007, -0.383).Equal(centers[1], 2e-3));
+  EXPECT_NEAR(2.1515, volumes[2], 1e-3);
+  EXPECT_TRUE(math::Vector3d(-1.249, 0.249, 0.010).Equal(centers[2], 2e-3));
+
+  // The part above the plane is the part below the flipped plane
+  const math::Planed flipped(-plane.Normal(), -plane.Offset());
+  double volumesAbove[count];
+  math::Vector3d centersAbove[count];
+  math::Boxd::VolumesBelow(sizes, poses, count, flipped, volumesAbove,
+                           centersAbove);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const double volume = sizes[i].X() * sizes[i].Y() * sizes[i].Z();
+    EXPECT_NEAR(volume, volumes[i] + volumesAbove[i], 1e-12);
+    EXPECT_EQ(poses[i].Pos() * volume,
+              centers[i] * volumes[i] + centersAbove[i] * volumesAbove[i]);
+
+    // Same volume as VolumeBelow, with the plane in the box frame, for the
+    // boxes whose faces are parallel to the plane
+    if (i == 1 || i == 2)
+      continue;
+    const math::Vector3d normal = plane.Normal().Normalized();
+    math::Boxd box(sizes[i]);
+    math::Planed local(poses[i].Rot().RotateVectorReverse(normal),
+        plane.Offset() / plane.Normal().Length() - normal.Dot(poses[i].Pos()));
+    EXPECT_NEAR(box.VolumeBelow(local), volumes[i], 1e-9);
+  }
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gz/math/CachedPose3.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(CachedPose3Test, Construct)
+{
+  math::CachedPose3d identity;
+  EXPECT_EQ(math::Pose3d::Zero, identity.Pose());
+  EXPECT_EQ(math::Matrix3d::Identity, identity.RotationMatrix());
+  EXPECT_EQ(math::Vector3d::Zero, identity.Euler());
+
+  const math::Pose3d pose(1, -2, 3, 0.1, -0.2, 0.3);
+  math::CachedPose3d cached(pose);
+  EXPECT_EQ(pose, cached.Pose());
+  EXPECT_EQ(pose.Pos(), cached.Pos());
+  EXPECT_EQ(pose.Rot(), cached.Rot());
+
+  math::CachedPose3d fromParts(pose.Pos(), pose.Rot());
+  EXPECT_EQ(pose, fromParts.Pose());
+}
+
+/////////////////////////////////////////////////
+TEST(CachedPose3Test, Attitude)
+{
+  const math::Pose3d pose(1, -2, 3, 0.1, -0.2, 0.3);
+  math::CachedPose3d cached(pose);
+
+  EXPECT_EQ(math::Matrix3d(pose.Rot()), cached.RotationMatrix());
+  EXPECT_EQ(pose.Rot().Euler(), cached.Euler());
+  EXPECT_DOUBLE_EQ(pose.Roll(), cached.Roll());
+  EXPECT_DOUBLE_EQ(pose.Pitch(), cached.Pitch());
+  EXPECT_DOUBLE_EQ(pose.Yaw(), cached.Yaw());
+
+  // The cache returns the same object until the rotation changes
+  EXPECT_EQ(&cached.Euler(), &cached.Euler());
+  EXPECT_EQ(&cached.RotationMatrix(), &cached.RotationMatrix());
+}
+
+/////////////////////////////////////////////////
+TEST(CachedPose3Test, Invalidate)
+{
+  math::CachedPose3d cached(math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3));
+  EXPECT_NEAR(0.3, cached.Yaw(), 1e-12);
+  const math::Matrix3d before = cached.RotationMatrix();
+
+  // Changing the position keeps the rotation cache
+  cached.Pos() = math::Vector3d(4, 5, 6);
+  EXPECT_EQ(before, cached.RotationMatrix());
+  EXPECT_EQ(math::Vector3d(4, 5, 6), cached.Pose().Pos());
+
+  cached.SetRot(math::Quaterniond(0.4, 0.5, 0.6));
+  EXPECT_NEAR(0.6, cached.Yaw(), 1e-12);
+  EXPECT_EQ(math::Matrix3d(math::Quaterniond(0.4, 0.5, 0.6)),
+            cached.RotationMatrix());
+
+  cached.Set(math::Vector3d(1, 1, 1), math::Quaterniond(-0.1, 0.2, -0.3));
+  EXPECT_NEAR(-0.1, cached.Roll(), 1e-12);
+  EXPECT_NEAR(0.2, cached.Pitch(), 1e-12);
+  EXPECT_NEAR(-0.3, cached.Yaw(), 1e-12);
+
+  cached = math::Pose3d(0, 0, 0, 0.7, 0, 0);
+  EXPECT_NEAR(0.7, cached.Roll(), 1e-12);
+  EXPECT_EQ(math::Matrix3d(math::Quaterniond(0.7, 0, 0)),
+            cached.RotationMatrix());
+}
+
+/////////////////////////////////////////////////
+TEST(CachedPose3Test, Transform)
+{
+  // Non unit quaternion, like Pose3 the rotation is normalized
+  const math::Pose3d pose(math::Vector3d(1, -2, 3),
+                          math::Quaterniond(2, 0.5, -1, 0.25));
+  const math::CachedPose3d cached(pose);
+
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 20; ++i)
+    points.push_back(math::Vector3d(0.5 * i, -1.0 + i, 2.0 - 0.3 * i));
+
+  for (const auto &v : points)
+  {
+    const math::Vector3d expected = pose.CoordPositionAdd(v);
+    EXPECT_TRUE(expected.Equal(cached.CoordPositionAdd(v), 1e-12));
+    EXPECT_TRUE(v.Equal(cached.CoordPositionSub(expected), 1e-12));
+    EXPECT_TRUE(pose.Rot().RotateVector(v).Equal(
+        cached.RotateVector(v), 1e-12));
+    EXPECT_TRUE(pose.Rot().RotateVectorReverse(v).Equal(
+        cached.RotateVectorReverse(v), 1e-12));
+  }
+
+  std::vector<math::Vector3d> out;
+  cached.CoordPositionAdd(points, out);
+  ASSERT_EQ(points.size(), out.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(pose.CoordPositionAdd(points[i]).Equal(out[i], 1e-12));
+
+  math::Vector3SoAd soa(points);
+  cached.CoordPositionAdd(soa, soa);
+  ASSERT_EQ(points.size(), soa.Size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(out[i].Equal(soa[i], 1e-12));
+}
@@ -17,6 +17,8 @@
 #include <gtest/gtest.h>
 #include <cmath>
 #include <iostream>
+#include <tuple>
+#include <vector>
 
 #include "gz/math/Capsule.hh"
 #include "gz/math/Helpers.hh"
@@ -128,3 +130,110 @@ TEST(CapsuleTest, Mass)
   EXPECT_EQ(expectedMassMat.DiagonalMoments(), massMat->DiagonalMoments());
   EXPECT_DOUBLE_EQ(expectedMassMat.Mass(), massMat->Mass());
 }
+
+//////////////////////////////////////////////////
+TEST(CapsuleTest, Batch)
+{
+  const double lengths[] = {2.0, 0.1, 1.0};
+  const double radii[] = {0.1, 0.5, 0.0};
+  const double densities[] = {1000.0, 2.5, 1.0};
+  const double masses[] = {2.0, 3.0, 1.0};
+
+  double volumes[3];
+  double densitiesFromMass[3];
+  math::MassMatrix3d massMats[3];
+  math::Capsuled::Volumes(lengths, radii, 3, volumes);
+  math::Capsuled::DensitiesFromMasses(lengths, radii, masses, 3,
+                                      densitiesFromMass);
+  EXPECT_FALSE(math::Capsuled::MassMatrices(lengths, radii, densities, 3,
+                                            massMats));
+  EXPECT_TRUE(math::Capsuled::MassMatrices(lengths, radii, densities, 2,
+                                           massMats));
+
+  for (int i = 0; i < 2; ++i)
+  {
+    math::Capsuled capsule(lengths[i], radii[i],
+                           math::Material(densities[i]));
+    EXPECT_DOUBLE_EQ(capsule.Volume(), volumes[i]);
+    EXPECT_DOUBLE_EQ(capsule.DensityFromMass(masses[i]),
+                     densitiesFromMass[i]);
+
+    auto expected = capsule.MassMatrix();
+    ASSERT_NE(std::nullopt, expected);
+    EXPECT_EQ(*expected, massMats[i]);
+    EXPECT_DOUBLE_EQ(expected->Mass(), massMats[i].Mass());
+  }
+  EXPECT_TRUE(std::isnan(densitiesFromMass[2]));
+  EXPECT_DOUBLE_EQ(0.0, massMats[2].Mass());
+}
+
+/////////////////////////////////////////////////
+TEST(CapsuleTest, IntersectDist)
+{
+  // A capsule along X.
+  const math::Capsuled capsule(2.0, 0.5);
+  const math::Pose3d pose(0, 0, 0, 0, IGN_PI / 2, 0);
+
+  // End caps.
+  auto [hit, dist] = capsule.IntersectDist(pose, math::Vector3d(5, 0, 0),
+      -math::Vector3d::UnitX, 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_NEAR(3.5, dist, 1e-12);
+  std::tie(hit, dist) = capsule.IntersectDist(pose,
+      math::Vector3d(1.3, 5, 0), -math::Vector3d::UnitY, 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_NEAR(4.6, dist, 1e-12);
+
+  // Side.
+  std::tie(hit, dist) = capsule.IntersectDist(pose,
+      math::Vector3d(0.7, 0, 5), -math::Vector3d::UnitZ, 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_NEAR(4.5, dist, 1e-12);
+
+  // From the inside, along the axis.
+  std::tie(hit, dist) = capsule.IntersectDist(pose, math::Vector3d::Zero,
+      -math::Vector3d::UnitX, 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_NEAR(1.5, dist, 1e-12);
+
+  // Misses.
+  EXPECT_FALSE(std::get<0>(capsule.IntersectDist(pose,
+      math::Vector3d(1.6, 5, 0), -math::Vector3d::UnitY, 0, 10)));
+  EXPECT_FALSE(std::get<0>(capsule.IntersectDist(pose,
+      math::Vector3d(0, 0, 5), math::Vector3d::UnitZ, 0, 10)));
+}
+
+/////////////////////////////////////////////////
+TEST(CapsuleTest, IntersectRays)
+{
+  const math::Capsuled capsule(1.0, 0.3);
+  const math::Pose3d pose(2, 0.5, 0.2, 0.3, -0.4, 0.5);
+  const math::Vector3d origin(0.1, -0.2, 0.3);
+
+  std::vector<math::Vector3d> dirs;
+  for (int i = 0; i < 40; ++i)
+  {
+    for (int j = 0; j < 20; ++j)
+    {
+      const double yaw = -0.6 + i * 0.03;
+      const double pitch = -0.6 + j * 0.06;
+      dirs.push_back(math::Vector3d(std::cos(pitch) * std::cos(yaw),
+          std::cos(pitch) * std::sin(yaw), std::sin(pitch)));
+    }
+  }
+
+  std::vector<double> ranges(dirs.size(), 10.0);
+  const std::size_t hits = capsule.IntersectRays(pose, origin, dirs.data(),
+      dirs.size(), 0.0, ranges.data());
+  EXPECT_GT(hits, 0u);
+  EXPECT_LT(hits, dirs.size());
+
+  std::size_t singleHits = 0;
+  for (std::size_t i = 0; i < dirs.size(); ++i)
+  {
+    auto [hit, dist] = capsule.IntersectDist(pose, origin, dirs[i], 0, 10);
+    singleHits += hit;
+    EXPECT_NEAR(hit ? dist : 10.0, ranges[i], 1e-9);
+  }
+  EXPECT_EQ(singleHits, hits);
+}
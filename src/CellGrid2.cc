@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gz/math/CellGrid2.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Minimum number of rays for each thread of MarkRays.
+  constexpr std::size_t kMinRaysPerThread = 2048;
+
+  /// \brief Check that a point can be traced.
+  /// \param[in] _point The point.
+  /// \return True if all the coordinates are finite.
+  bool Traceable(const Vector2d &_point)
+  {
+    return std::isfinite(_point.X()) && std::isfinite(_point.Y());
+  }
+
+  /// \brief Find the cell of a point on the grid, clamping points that
+  /// rounding put just outside of it.
+  /// \param[in] _grid The grid.
+  /// \param[in] _point The point, on the grid up to rounding.
+  /// \return Coordinates of the cell.
+  Vector2i ClampedCell(const CellGrid2 &_grid, const Vector2d &_point)
+  {
+    Vector2i cell;
+    for (int i = 0; i < 2; ++i)
+    {
+      const double offset = std::floor(
+          (_point[i] - _grid.Min()[i]) / _grid.Resolution());
+      cell[i] = static_cast<int>(std::min<double>(
+          std::max(offset, 0.0), _grid.CellCounts()[i] - 1));
+    }
+    return cell;
+  }
+
+  /// \brief Call a function on the linear index of each cell traversed by
+  /// a ray of a scan.
+  /// \param[in] _grid Grid to traverse.
+  /// \param[in] _origin Origin of the ray.
+  /// \param[in] _endpoint Endpoint of the ray.
+  /// \param[in] _maxRange Maximum length of the ray.
+  /// \param[in] _mode Cells to visit.
+  /// \param[in] _visit Function called with each linear index.
+  template<typename Visit>
+  void TraceRay(const CellGrid2 &_grid, const Vector2d &_origin,
+                const Vector2d &_endpoint, const double _maxRange,
+                const CellGrid2::TraversalMode _mode, const Visit &_visit)
+  {
+    Vector2d end = _endpoint;
+    const double length = _origin.Distance(_endpoint);
+    if (length > _maxRange)
+      end = _origin + (_endpoint - _origin) * (_maxRange / length);
+
+    for (CellTraversal2 it(_grid, Line2d(_origin, end), _mode); it.Valid();
+         it.Next())
+    {
+      _visit(_grid.Index(it.Cell()));
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+CellGrid2::CellGrid2(const Vector2d &_min, const Vector2d &_max,
+                     const double _resolution)
+{
+  if (!(_resolution > 0) || !std::isfinite(_resolution) ||
+      !Traceable(_min) || !Traceable(_max))
+  {
+    return;
+  }
+
+  Vector2i cells;
+  for (int i = 0; i < 2; ++i)
+  {
+    if (!(_min[i] <= _max[i]))
+      return;
+    const double count = std::ceil((_max[i] - _min[i]) / _resolution);
+    if (count >= static_cast<double>(std::numeric_limits<int>::max()))
+      return;
+    cells[i] = std::max(1, static_cast<int>(count));
+  }
+
+  this->origin = _min;
+  this->resolution = _resolution;
+  this->counts = cells;
+}
+
+//////////////////////////////////////////////////
+bool CellGrid2::Valid() const
+{
+  return this->resolution > 0;
+}
+
+//////////////////////////////////////////////////
+const Vector2d &CellGrid2::Min() const
+{
+  return this->origin;
+}
+
+//////////////////////////////////////////////////
+Vector2d CellGrid2::Max() const
+{
+  return this->origin +
+      Vector2d(this->counts.X(), this->counts.Y()) * this->resolution;
+}
+
+//////////////////////////////////////////////////
+double CellGrid2::Resolution() const
+{
+  return this->resolution;
+}
+
+//////////////////////////////////////////////////
+const Vector2i &CellGrid2::CellCounts() const
+{
+  return this->counts;
+}
+
+//////////////////////////////////////////////////
+std::size_t CellGrid2::CellCount() const
+{
+  return static_cast<std::size_t>(this->counts.X()) *
+         static_cast<std::size_t>(this->counts.Y());
+}
+
+//////////////////////////////////////////////////
+bool CellGrid2::Cell(const Vector2d &_point, Vector2i &_cell) const
+{
+  if (!this->Valid())
+    return false;
+
+  Vector2i cell;
+  for (int i = 0; i < 2; ++i)
+  {
+    const double offset = (_point[i] - this->origin[i]) / this->resolution;
+    if (!(offset >= 0) || offset > this->counts[i])
+      return false;
+    cell[i] = std::min(static_cast<int>(offset), this->counts[i] - 1);
+  }
+  _cell = cell;
+  return true;
+}
+
+//////////////////////////////////////////////////
+Vector2d CellGrid2::CellCenter(const Vector2i &_cell) const
+{
+  return this->origin +
+      Vector2d(_cell.X() + 0.5, _cell.Y() + 0.5) * this->resolution;
+}
+
+//////////////////////////////////////////////////
+void CellGrid2::MarkRays(const Vector2d &_origin,
+                         const std::vector<Vector2d> &_endpoints,
+                         const double _maxRange,
+                         std::vector<uint8_t> &_marks,
+                         const TraversalMode _mode,
+                         const unsigned int _threads) const
+{
+  _marks.assign(this->CellCount(), kUnknown);
+  if (!this->Valid() || !Traceable(_origin))
+    return;
+
+  unsigned int threads = _threads;
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = static_cast<unsigned int>(std::max<std::size_t>(1,
+      std::min<std::size_t>(threads, _endpoints.size() / kMinRaysPerThread)));
+
+  if (threads == 1)
+  {
+    for (const auto &endpoint : _endpoints)
+    {
+      if (Traceable(endpoint))
+      {
+        TraceRay(*this, _origin, endpoint, _maxRange, _mode,
+                 [&_marks](const std::size_t _index)
+                 {
+                   _marks[_index] = kFree;
+                 });
+      }
+    }
+  }
+  else
+  {
+    // Each thread lists the cells of its rays, which are then marked in
+    // order, so that no two threads write to the same mark.
+    std::vector<std::vector<std::size_t>> freeCells(threads);
+    auto trace = [&](const unsigned int _t)
+    {
+      const std::size_t begin = _endpoints.size() * _t / threads;
+      const std::size_t end = _endpoints.size() * (_t + 1) / threads;
+      auto &cells = freeCells[_t];
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        if (Traceable(_endpoints[i]))
+        {
+          TraceRay(*this, _origin, _endpoints[i], _maxRange, _mode,
+                   [&cells](const std::size_t _index)
+                   {
+                     cells.push_back(_index);
+                   });
+        }
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int t = 1; t < threads; ++t)
+      workers.emplace_back(trace, t);
+    trace(0);
+    for (auto &worker : workers)
+      worker.join();
+
+    for (const auto &cells : freeCells)
+    {
+      for (const std::size_t index : cells)
+        _marks[index] = kFree;
+    }
+  }
+
+  // Occupied cells take precedence over the free ones.
+  Vector2i cell;
+  for (const auto &endpoint : _endpoints)
+  {
+    if (Traceable(endpoint) &&
+        endpoint.Distance(_origin) <= _maxRange &&
+        this->Cell(endpoint, cell))
+    {
+      _marks[this->Index(cell)] = kOccupied;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+CellTraversal2::CellTraversal2(const CellGrid2 &_grid,
+                               const Line2d &_segment,
+                               const CellGrid2::TraversalMode _mode)
+: grid(&_grid), mode(_mode)
+{
+  const Vector2d from = _segment[0];
+  const Vector2d dir = _segment[1] - _segment[0];
+  if (!this->grid->Valid() || !Traceable(from) || !Traceable(dir))
+    return;
+
+  // Clip the segment to the grid, with distances in units of its length.
+  const Vector2d &lower = this->grid->Min();
+  const Vector2d upper = this->grid->Max();
+  double t0 = 0;
+  double t1 = 1;
+  for (int i = 0; i < 2; ++i)
+  {
+    if (std::abs(dir[i]) <= 0)
+    {
+      if (from[i] < lower[i] || from[i] > upper[i])
+        return;
+      continue;
+    }
+    double ta = (lower[i] - from[i]) / dir[i];
+    double tb = (upper[i] - from[i]) / dir[i];
+    if (ta > tb)
+      std::swap(ta, tb);
+    t0 = std::max(t0, ta);
+    t1 = std::min(t1, tb);
+  }
+  if (t0 > t1)
+    return;
+
+  this->cell = ClampedCell(*this->grid, from + dir * t0);
+  for (int i = 0; i < 2; ++i)
+    this->step[i] = dir[i] > 0 ? 1 : (dir[i] < 0 ? -1 : 0);
+
+  if (this->mode == CellGrid2::BRESENHAM)
+  {
+    this->last = ClampedCell(*this->grid, from + dir * t1);
+    this->deltaX = std::abs(static_cast<int64_t>(this->last.X()) -
+                            this->cell.X());
+    this->deltaY = -std::abs(static_cast<int64_t>(this->last.Y()) -
+                             this->cell.Y());
+    this->error = this->deltaX + this->deltaY;
+    // The cells may be equal along an axis on which the segment moves.
+    this->step.X() = this->last.X() < this->cell.X() ? -1 : 1;
+    this->step.Y() = this->last.Y() < this->cell.Y() ? -1 : 1;
+  }
+  else
+  {
+    const double resolution = this->grid->Resolution();
+    for (int i = 0; i < 2; ++i)
+    {
+      if (this->step[i] > 0)
+      {
+        this->tMax[i] = (lower[i] + (this->cell[i] + 1) * resolution -
+                         from[i]) / dir[i];
+        this->tDelta[i] = resolution / dir[i];
+      }
+      else if (this->step[i] < 0)
+      {
+        this->tMax[i] = (lower[i] + this->cell[i] * resolution -
+                         from[i]) / dir[i];
+        this->tDelta[i] = -resolution / dir[i];
+      }
+      else
+      {
+        this->tMax[i] = std::numeric_limits<double>::infinity();
+        this->tDelta[i] = std::numeric_limits<double>::infinity();
+      }
+    }
+    this->end = t1;
+  }
+
+  this->valid = true;
+}
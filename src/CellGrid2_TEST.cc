@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gz/math/CellGrid2.hh"
+#include "gz/math/Helpers.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Collect the cells visited by a traversal.
+/// \param[in] _it Traversal, at its first cell.
+/// \return Coordinates of the cells, in order.
+static std::vector<Vector2i> Cells(CellTraversal2 _it)
+{
+  std::vector<Vector2i> cells;
+  for (; _it.Valid(); _it.Next())
+    cells.push_back(_it.Cell());
+  return cells;
+}
+
+/////////////////////////////////////////////////
+TEST(CellGrid2Test, Grid)
+{
+  const CellGrid2 grid(Vector2d(0, -1), Vector2d(1, 1.05), 0.5);
+  ASSERT_TRUE(grid.Valid());
+  EXPECT_DOUBLE_EQ(0.5, grid.Resolution());
+  EXPECT_EQ(Vector2i(2, 5), grid.CellCounts());
+  EXPECT_EQ(10u, grid.CellCount());
+  EXPECT_EQ(Vector2d(0, -1), grid.Min());
+  EXPECT_EQ(Vector2d(1, 1.5), grid.Max());
+
+  Vector2i cell;
+  EXPECT_TRUE(grid.Cell(Vector2d(0.7, -0.2), cell));
+  EXPECT_EQ(Vector2i(1, 1), cell);
+  EXPECT_EQ(3u, grid.Index(cell));
+  EXPECT_EQ(Vector2d(0.75, -0.25), grid.CellCenter(cell));
+
+  // Boundaries belong to the upper cell, except at the top of the grid.
+  EXPECT_TRUE(grid.Cell(Vector2d(0.5, 1.5), cell));
+  EXPECT_EQ(Vector2i(1, 4), cell);
+  EXPECT_EQ(grid.CellCount() - 1u, grid.Index(cell));
+
+  cell.Set(9, 9);
+  EXPECT_FALSE(grid.Cell(Vector2d(1.1, 0), cell));
+  EXPECT_FALSE(grid.Cell(
+        Vector2d(std::numeric_limits<double>::quiet_NaN(), 0), cell));
+  EXPECT_EQ(Vector2i(9, 9), cell);
+
+  EXPECT_TRUE(grid.Contains(Vector2i(1, 4)));
+  EXPECT_FALSE(grid.Contains(Vector2i(2, 0)));
+  EXPECT_FALSE(grid.Contains(Vector2i(0, -1)));
+
+  // Invalid grids.
+  EXPECT_FALSE(CellGrid2().Valid());
+  EXPECT_EQ(0u, CellGrid2().CellCount());
+  EXPECT_FALSE(CellGrid2(Vector2d(1, 0), Vector2d(0, 1), 1.0).Valid());
+  EXPECT_FALSE(CellGrid2(Vector2d::Zero, Vector2d::One, 0.0).Valid());
+  EXPECT_FALSE(CellGrid2(Vector2d::Zero, Vector2d::One, 1e-12).Valid());
+  EXPECT_FALSE(CellGrid2().Cell(Vector2d::Zero, cell));
+}
+
+/////////////////////////////////////////////////
+TEST(CellGrid2Test, Supercover)
+{
+  const CellGrid2 grid(Vector2d(0, 0), Vector2d(4, 4), 1.0);
+
+  // Along X, entering the grid from outside and stopping inside.
+  std::vector<Vector2i> cells = Cells(CellTraversal2(grid,
+      Line2d(Vector2d(-1, 0.5), Vector2d(2.5, 0.5))));
+  ASSERT_EQ(3u, cells.size());
+  EXPECT_EQ(Vector2i(0, 0), cells[0]);
+  EXPECT_EQ(Vector2i(2, 0), cells[2]);
+
+  // Through corners, both side cells are visited before the diagonal one.
+  cells = Cells(CellTraversal2(grid,
+      Line2d(Vector2d(0.5, 0.5), Vector2d(2.5, 2.5))));
+  const std::vector<Vector2i> expected = {
+    Vector2i(0, 0), Vector2i(1, 0), Vector2i(0, 1), Vector2i(1, 1),
+    Vector2i(2, 1), Vector2i(1, 2), Vector2i(2, 2)};
+  EXPECT_EQ(expected, cells);
+
+  // Leaving the grid through a corner ends the traversal.
+  cells = Cells(CellTraversal2(grid,
+      Line2d(Vector2d(3.5, 0.5), Vector2d(5, 2))));
+  ASSERT_EQ(1u, cells.size());
+  EXPECT_EQ(Vector2i(3, 0), cells[0]);
+
+  // A point visits its cell.
+  cells = Cells(CellTraversal2(grid,
+      Line2d(Vector2d(2.5, 1.5), Vector2d(2.5, 1.5))));
+  ASSERT_EQ(1u, cells.size());
+  EXPECT_EQ(Vector2i(2, 1), cells[0]);
+
+  // Misses.
+  EXPECT_FALSE(CellTraversal2(grid,
+      Line2d(Vector2d(-2, 0.5), Vector2d(-1, 0.5))).Valid());
+  EXPECT_FALSE(CellTraversal2(grid,
+      Line2d(Vector2d(-1, 5), Vector2d(5, 5))).Valid());
+  EXPECT_FALSE(CellTraversal2(CellGrid2(),
+      Line2d(Vector2d(0, 0), Vector2d(1, 1))).Valid());
+}
+
+/////////////////////////////////////////////////
+TEST(CellGrid2Test, Bresenham)
+{
+  const CellGrid2 grid(Vector2d(0, 0), Vector2d(10, 10), 1.0);
+
+  // One cell per column along the major axis.
+  CellTraversal2 it(grid, Line2d(Vector2d(0.5, 0.5), Vector2d(6.5, 3.5)),
+                    CellGrid2::BRESENHAM);
+  EXPECT_EQ(CellGrid2::BRESENHAM, it.Mode());
+  std::vector<Vector2i> cells = Cells(it);
+  const std::vector<Vector2i> expected = {
+    Vector2i(0, 0), Vector2i(1, 1), Vector2i(2, 1), Vector2i(3, 2),
+    Vector2i(4, 2), Vector2i(5, 3), Vector2i(6, 3)};
+  EXPECT_EQ(expected, cells);
+
+  // Backwards along the major Y axis, clipped to the grid.
+  cells = Cells(CellTraversal2(grid,
+      Line2d(Vector2d(4.5, 12), Vector2d(3.5, 6.5)), CellGrid2::BRESENHAM));
+  ASSERT_EQ(4u, cells.size());
+  EXPECT_EQ(Vector2i(4, 9), cells.front());
+  EXPECT_EQ(Vector2i(3, 6), cells.back());
+
+  // Random segments go from the first cell to the last, with one cell per
+  // step along the major axis, each touching the previous one.
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> coord(0, 10);
+  for (int r = 0; r < 200; ++r)
+  {
+    const Vector2d from(coord(rng), coord(rng));
+    const Vector2d to(coord(rng), coord(rng));
+    cells = Cells(CellTraversal2(grid, Line2d(from, to),
+        CellGrid2::BRESENHAM));
+
+    Vector2i first, last;
+    ASSERT_TRUE(grid.Cell(from, first));
+    ASSERT_TRUE(grid.Cell(to, last));
+    ASSERT_FALSE(cells.empty());
+    EXPECT_EQ(first, cells.front());
+    EXPECT_EQ(last, cells.back());
+    const Vector2i span = (last - first).Abs();
+    EXPECT_EQ(static_cast<std::size_t>(std::max(span.X(), span.Y()) + 1),
+              cells.size());
+    for (std::size_t i = 1; i < cells.size(); ++i)
+    {
+      const Vector2i move = (cells[i] - cells[i - 1]).Abs();
+      EXPECT_LE(move.X(), 1);
+      EXPECT_LE(move.Y(), 1);
+      EXPECT_GT(move.X() + move.Y(), 0);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(CellGrid2Test, SupercoverRandom)
+{
+  const CellGrid2 grid(Vector2d(-1, -2), Vector2d(3, 1), 0.25);
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> coord(-3, 4);
+
+  for (int r = 0; r < 200; ++r)
+  {
+    const Vector2d from(coord(rng), coord(rng));
+    const Vector2d to(coord(rng), coord(rng));
+
+    std::vector<Vector2i> cells;
+    for (CellTraversal2 it(grid, Line2d(from, to)); it.Valid(); it.Next())
+    {
+      EXPECT_TRUE(grid.Contains(it.Cell()));
+      // Consecutive cells share a side.
+      if (!cells.empty())
+      {
+        EXPECT_EQ(1, (it.Cell() - cells.back()).Abs().Sum());
+      }
+      cells.push_back(it.Cell());
+    }
+
+    // Every cell of points sampled along the segment is visited.
+    std::set<std::size_t> visited;
+    for (const auto &cell : cells)
+      visited.insert(grid.Index(cell));
+    for (int s = 1; s < 1000; ++s)
+    {
+      Vector2i cell;
+      if (grid.Cell(from + (to - from) * (s / 1000.0), cell))
+      {
+        EXPECT_EQ(1u, visited.count(grid.Index(cell)));
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(CellGrid2Test, MarkRays)
+{
+  const CellGrid2 grid(Vector2d(0, 0), Vector2d(10, 10), 1.0);
+  const Vector2d origin(0.5, 0.5);
+  const std::vector<Vector2d> endpoints = {
+    Vector2d(5.5, 0.5),
+    Vector2d(0.5, 20),
+    Vector2d(std::numeric_limits<double>::quiet_NaN(), 0),
+    Vector2d(2.5, 0.5)};
+
+  for (const auto mode : {CellGrid2::SUPERCOVER, CellGrid2::BRESENHAM})
+  {
+    std::vector<uint8_t> marks(3, 7);
+    grid.MarkRays(origin, endpoints, 6.0, marks, mode);
+    ASSERT_EQ(grid.CellCount(), marks.size());
+
+    auto mark = [&](const int _x, const int _y)
+    {
+      return marks[grid.Index(Vector2i(_x, _y))];
+    };
+    // The first ray frees the cells before its endpoint, except the one
+    // of the endpoint of the last ray.
+    EXPECT_EQ(CellGrid2::kFree, mark(0, 0));
+    EXPECT_EQ(CellGrid2::kFree, mark(1, 0));
+    EXPECT_EQ(CellGrid2::kOccupied, mark(2, 0));
+    EXPECT_EQ(CellGrid2::kFree, mark(4, 0));
+    EXPECT_EQ(CellGrid2::kOccupied, mark(5, 0));
+    EXPECT_EQ(CellGrid2::kUnknown, mark(6, 0));
+
+    // The second ray is cut at the maximum range, without an endpoint.
+    EXPECT_EQ(CellGrid2::kFree, mark(0, 6));
+    EXPECT_EQ(CellGrid2::kUnknown, mark(0, 7));
+    EXPECT_EQ(CellGrid2::kUnknown, mark(5, 5));
+  }
+
+  // An invalid grid has no marks.
+  std::vector<uint8_t> marks;
+  CellGrid2().MarkRays(origin, endpoints, 6.0, marks);
+  EXPECT_TRUE(marks.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(CellGrid2Test, MarkRaysThreads)
+{
+  const CellGrid2 grid(Vector2d(-5, -5), Vector2d(5, 5), 0.05);
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> range(0.5, 7);
+
+  // A laser scan around the origin.
+  std::vector<Vector2d> endpoints;
+  const int count = 20000;
+  for (int i = 0; i < count; ++i)
+  {
+    const double a = -IGN_PI + 2 * IGN_PI * i / count;
+    const double r = range(rng);
+    endpoints.emplace_back(r * std::cos(a), r * std::sin(a));
+  }
+
+  const Vector2d origin(0.02, -0.01);
+  for (const auto mode : {CellGrid2::SUPERCOVER, CellGrid2::BRESENHAM})
+  {
+    std::vector<uint8_t> single;
+    grid.MarkRays(origin, endpoints, 6.0, single, mode);
+    for (const unsigned int threads : {0u, 2u, 3u})
+    {
+      std::vector<uint8_t> marks;
+      grid.MarkRays(origin, endpoints, 6.0, marks, mode, threads);
+      EXPECT_EQ(single, marks);
+    }
+
+    std::size_t occupied = 0;
+    for (const uint8_t mark : single)
+      occupied += mark == CellGrid2::kOccupied;
+    EXPECT_GT(occupied, 1000u);
+  }
+}
@@ -16,12 +16,292 @@
  */
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
 
 #include "gz/math/Color.hh"
 
+// Select the instruction set used by the batch packing kernels.
+// Define IGNITION_MATH_DISABLE_SIMD to always use the portable scalar code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define IGNITION_MATH_COLOR_SSE2 1
+    #include <emmintrin.h>
+  #endif
+#endif
+
 using namespace gz;
 using namespace math;
 
+namespace
+{
+  /// \brief Bit offsets of the red, green, blue and alpha bytes of a
+  /// packed color, for each Color::PackedFormat.
+  const unsigned int kPackedShifts[4][4] = {
+    {24, 16, 8, 0},
+    {8, 16, 24, 0},
+    {16, 8, 0, 24},
+    {0, 8, 16, 24}};
+
+  /// \brief Number of entries of the table that encodes linear values as
+  /// sRGB. It is fine enough for the result to be within one unit of the
+  /// nearest byte.
+  const int kSrgbEncodeSize = 4096;
+
+  /// \brief Lookup tables between sRGB encoded bytes and linear values.
+  struct SrgbTables
+  {
+    SrgbTables()
+    {
+      for (int i = 0; i < 256; ++i)
+      {
+        const double c = i / 255.0;
+        this->toLinear[i] = static_cast<float>(c <= 0.04045 ?
+            c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+      }
+      for (int i = 0; i < kSrgbEncodeSize; ++i)
+      {
+        const double l = i / static_cast<double>(kSrgbEncodeSize - 1);
+        const double c = l <= 0.0031308 ?
+            12.92 * l : 1.055 * std::pow(l, 1 / 2.4) - 0.055;
+        this->toSrgb[i] = static_cast<uint8_t>(std::lround(c * 255));
+      }
+    }
+
+    /// \brief Linear value of each sRGB byte.
+    float toLinear[256];
+
+    /// \brief sRGB byte of linear values evenly spaced in [0..1].
+    uint8_t toSrgb[kSrgbEncodeSize];
+  };
+
+  /// \brief Get the sRGB lookup tables, built on first use.
+  /// \return The tables.
+  const SrgbTables &Srgb()
+  {
+    static const SrgbTables tables;
+    return tables;
+  }
+
+  /// \brief Clamp a value to [0..1] for packing. NaN gives 0.
+  /// \param[in] _v Value.
+  /// \return Clamped value.
+  float ClampUnit(const float _v)
+  {
+    return _v > 0 ? (_v < 1 ? _v : 1.0f) : 0.0f;
+  }
+
+  /// \brief Clamp a red, green or blue value as Color::Clamp does.
+  /// \param[in] _v Value.
+  /// \return Clamped value.
+  float ClampChannel(float _v)
+  {
+    _v = _v < 0 || std::isnan(_v) ? 0 : _v;
+    return _v > 1 ? _v / 255.0f : _v;
+  }
+
+  /// \brief Convert RGB to HSV, see Color::HSV.
+  /// \param[in] _r Red.
+  /// \param[in] _g Green.
+  /// \param[in] _b Blue.
+  /// \param[out] _hsv Hue, saturation and value.
+  void RgbToHsv(const float _r, const float _g, const float _b,
+                float *_hsv)
+  {
+    const float min = std::min(_r, std::min(_g, _b));
+    const float max = std::max(_r, std::max(_g, _b));
+    const float delta = max - min;
+
+    _hsv[1] = delta / max;
+    _hsv[2] = max;
+
+    if (equal(delta, 0.0f))
+    {
+      _hsv[0] = 0.0;
+      _hsv[1] = 0.0;
+    }
+    else if (equal(_r, min))
+      _hsv[0] = 3 - ((_g - _b) / delta);
+    else if (equal(_g, min))
+      _hsv[0] = 5 - ((_b - _r) / delta);
+    else
+      _hsv[0] = 1 - ((_r - _g) / delta);
+
+    _hsv[0] *= 60.0;
+  }
+
+  /// \brief Convert HSV to RGB, see Color::SetFromHSV.
+  /// \param[in] _h Hue.
+  /// \param[in] _s Saturation.
+  /// \param[in] _v Value.
+  /// \param[out] _rgb Red, green and blue, not clamped.
+  /// \return False for an achromatic (grey) color, which SetFromHSV does
+  /// not clamp.
+  bool HsvToRgb(const float _h, const float _s, const float _v,
+                float *_rgb)
+  {
+    int i;
+    float f, p , q, t;
+
+    float h = static_cast<float>(static_cast<int>(_h < 0 ? 0 : _h) % 360);
+
+    if (equal(_s, 0.0f))
+    {
+      // acromatic (grey)
+      _rgb[0] = _rgb[1] = _rgb[2] = _v;
+      return false;
+    }
+
+    // sector 0 - 5
+    h /= 60;
+
+    i = static_cast<int>(floor(h));
+
+    f = h - i;
+
+    p = _v * (1-_s);
+    q = _v * (1 - _s * f);
+    t = _v * (1 - _s * (1-f));
+
+    switch (i)
+    {
+      case 0:
+        _rgb[0] = _v;
+        _rgb[1] = t;
+        _rgb[2] = p;
+        break;
+      case 1:
+        _rgb[0] = q;
+        _rgb[1] = _v;
+        _rgb[2] = p;
+        break;
+      case 2:
+        _rgb[0] = p;
+        _rgb[1] = _v;
+        _rgb[2] = t;
+        break;
+      case 3:
+        _rgb[0] = p;
+        _rgb[1] = q;
+        _rgb[2] = _v;
+        break;
+      case 4:
+        _rgb[0] = t;
+        _rgb[1] = p;
+        _rgb[2] = _v;
+        break;
+      case 5:
+      default:
+        _rgb[0] = _v;
+        _rgb[1] = p;
+        _rgb[2] = q;
+        break;
+    }
+    return true;
+  }
+
+  /// \brief Convert RGB to YUV, see Color::YUV.
+  /// \param[in] _r Red.
+  /// \param[in] _g Green.
+  /// \param[in] _b Blue.
+  /// \param[out] _yuv YUV values.
+  void RgbToYuv(const float _r, const float _g, const float _b,
+                float *_yuv)
+  {
+    _yuv[0] = 0.299f*_r + 0.587f*_g + 0.114f*_b;
+    _yuv[1] = -0.1679f*_r - 0.332f*_g + 0.5f*_b + 0.5f;
+    _yuv[2] = 0.5f*_r - 0.4189f*_g - 0.08105f*_b + 0.5f;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      _yuv[i] = _yuv[i] < 0 ? 0: _yuv[i];
+      _yuv[i] = _yuv[i] > 255 ? 255.0f: _yuv[i];
+    }
+  }
+
+  /// \brief Convert YUV to RGB, see Color::SetFromYUV.
+  /// \param[in] _y Y value.
+  /// \param[in] _u U value.
+  /// \param[in] _v V value.
+  /// \param[out] _rgb Red, green and blue, not clamped.
+  void YuvToRgb(const float _y, const float _u, const float _v, float *_rgb)
+  {
+    _rgb[0] = _y + 1.140f*_v;
+    _rgb[1] = _y - 0.395f*_u - 0.581f*_v;
+    _rgb[2] = _y + 2.032f*_u;
+  }
+
+#if defined(IGNITION_MATH_COLOR_SSE2)
+  /// \brief Unpack groups of four packed colors. The bytes of a color are
+  /// widened to the four lanes of a register, in memory order, and then
+  /// shuffled to red, green, blue, alpha.
+  /// \param[in] _packed Array of _count packed colors.
+  /// \param[in] _count Number of colors.
+  /// \param[out] _rgba Array of 4 * _count values.
+  /// \tparam Order _mm_shuffle_epi32 control from memory order to RGBA.
+  /// \return Number of colors unpacked, a multiple of four.
+  template<int Order>
+  std::size_t UnpackSse2(const unsigned int *_packed,
+                         const std::size_t _count, float *_rgba)
+  {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 scale = _mm_set1_ps(255.0f);
+    std::size_t i = 0;
+    for (; i + 4 <= _count; i += 4)
+    {
+      const __m128i p =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(_packed + i));
+      const __m128i lo = _mm_unpacklo_epi8(p, zero);
+      const __m128i hi = _mm_unpackhi_epi8(p, zero);
+      const __m128i c[4] = {
+        _mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero),
+        _mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero)};
+      for (std::size_t k = 0; k < 4; ++k)
+      {
+        // Divide rather than multiply by the reciprocal, to round as
+        // SetFromRGBA does.
+        _mm_storeu_ps(_rgba + 4 * (i + k), _mm_div_ps(
+            _mm_cvtepi32_ps(_mm_shuffle_epi32(c[k], Order)), scale));
+      }
+    }
+    return i;
+  }
+
+  /// \brief Pack groups of four colors, the reverse of UnpackSse2.
+  /// \param[in] _rgba Array of 4 * _count values.
+  /// \param[in] _count Number of colors.
+  /// \param[out] _packed Array of _count packed colors.
+  /// \tparam Order _mm_shuffle_epi32 control from RGBA to memory order.
+  /// \return Number of colors packed, a multiple of four.
+  template<int Order>
+  std::size_t PackSse2(const float *_rgba, const std::size_t _count,
+                       unsigned int *_packed)
+  {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+    std::size_t i = 0;
+    for (; i + 4 <= _count; i += 4)
+    {
+      __m128i c[4];
+      for (std::size_t k = 0; k < 4; ++k)
+      {
+        // maxps returns its second operand if either is NaN, so that NaN
+        // is packed as 0 like ClampUnit does.
+        const __m128 v = _mm_min_ps(
+            _mm_max_ps(_mm_loadu_ps(_rgba + 4 * (i + k)), zero), one);
+        c[k] = _mm_shuffle_epi32(
+            _mm_cvttps_epi32(_mm_mul_ps(v, scale)), Order);
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(_packed + i),
+          _mm_packus_epi16(_mm_packs_epi32(c[0], c[1]),
+                           _mm_packs_epi32(c[2], c[3])));
+    }
+    return i;
+  }
+#endif
+}
+
 const Color Color::White = Color(1, 1, 1, 1);
 const Color Color::Black = Color(0, 0, 0, 1);
 const Color Color::Red = Color(1, 0, 0, 1);
@@ -76,122 +356,40 @@ void Color::Set(const float _r, const float _g, const float _b, const float _a)
 //////////////////////////////////////////////////
 void Color::SetFromHSV(const float _h, const float _s, const float _v)
 {
-  int i;
-  float f, p , q, t;
+  float rgb[3];
+  const bool chromatic = HsvToRgb(_h, _s, _v, rgb);
+  this->r = rgb[0];
+  this->g = rgb[1];
+  this->b = rgb[2];
 
-  float h = static_cast<float>(static_cast<int>(_h < 0 ? 0 : _h) % 360);
-
-  if (equal(_s, 0.0f))
-  {
-    // acromatic (grey)
-    this->r = this->g = this->b = _v;
-    return;
-  }
-
-  // sector 0 - 5
-  h /= 60;
-
-  i = static_cast<int>(floor(h));
-
-  f = h - i;
-
-  p = _v * (1-_s);
-  q = _v * (1 - _s * f);
-  t = _v * (1 - _s * (1-f));
-
-  switch (i)
-  {
-    case 0:
-      this->r = _v;
-      this->g = t;
-      this->b = p;
-      break;
-    case 1:
-      this->r = q;
-      this->g = _v;
-      this->b = p;
-      break;
-    case 2:
-      this->r = p;
-      this->g = _v;
-      this->b = t;
-      break;
-    case 3:
-      this->r = p;
-      this->g = q;
-      this->b = _v;
-      break;
-    case 4:
-      this->r = t;
-      this->g = p;
-      this->b = _v;
-      break;
-    case 5:
-    default:
-      this->r = _v;
-      this->g = p;
-      this->b = q;
-      break;
-  }
-
-  this->Clamp();
+  if (chromatic)
+    this->Clamp();
 }
 
 //////////////////////////////////////////////////
 Vector3f Color::HSV() const
 {
-  Vector3f hsv;
-
-  float min = std::min(this->r, std::min(this->g, this->b));
-  float max = std::max(this->r, std::max(this->g, this->b));
-  float delta = max - min;
-
-  hsv.Y() = delta / max;
-  hsv.Z() = max;
-
-  if (equal(delta, 0.0f))
-  {
-    hsv.X() = 0.0;
-    hsv.Y() = 0.0;
-  }
-  else if (equal(this->r, min))
-    hsv.X() = 3 - ((this->g - this->b) / delta);
-  else if (equal(this->g, min))
-    hsv.X() = 5 - ((this->b - this->r) / delta);
-  else
-    hsv.X() = 1 - ((this->r - this->g) / delta);
-
-  hsv.X() *= 60.0;
-  return hsv;
+  float hsv[3];
+  RgbToHsv(this->r, this->g, this->b, hsv);
+  return Vector3f(hsv[0], hsv[1], hsv[2]);
 }
 
 //////////////////////////////////////////////////
 Vector3f Color::YUV() const
 {
-  Vector3f yuv;
-
-  yuv.X() = 0.299f*this->r + 0.587f*this->g + 0.114f*this->b;
-  yuv.Y() = -0.1679f*this->r - 0.332f*this->g + 0.5f*this->b + 0.5f;
-  yuv.Z() = 0.5f*this->r - 0.4189f*this->g - 0.08105f*this->b + 0.5f;
-
-  yuv.X() = yuv.X() < 0 ? 0: yuv.X();
-  yuv.X() = yuv.X() > 255 ? 255.0f: yuv.X();
-
-  yuv.Y() = yuv.Y() < 0 ? 0: yuv.Y();
-  yuv.Y() = yuv.Y() > 255 ? 255.0f: yuv.Y();
-
-  yuv.Z() = yuv.Z() < 0 ? 0: yuv.Z();
-  yuv.Z() = yuv.Z() > 255 ? 255.0f: yuv.Z();
-
-  return yuv;
+  float yuv[3];
+  RgbToYuv(this->r, this->g, this->b, yuv);
+  return Vector3f(yuv[0], yuv[1], yuv[2]);
 }
 
 //////////////////////////////////////////////////
 void Color::SetFromYUV(const float _y, const float _u, const float _v)
 {
-  this->r = _y + 1.140f*_v;
-  this->g = _y - 0.395f*_u - 0.581f*_v;
-  this->b = _y + 2.032f*_u;
+  float rgb[3];
+  YuvToRgb(_y, _u, _v, rgb);
+  this->r = rgb[0];
+  this->g = rgb[1];
+  this->b = rgb[2];
   this->Clamp();
 }
 
@@ -367,6 +565,164 @@ void Color::SetFromABGR(const Color::ABGR _v)
   this->r = (val32 & 0xFF) / 255.0f;
 }
 
+//////////////////////////////////////////////////
+void Color::Unpack(const unsigned int *_packed, const std::size_t _count,
+                   const PackedFormat _format, float *_rgba,
+                   const bool _srgb)
+{
+  const unsigned int *shift = kPackedShifts[_format];
+  std::size_t i = 0;
+  if (_srgb)
+  {
+    const float *toLinear = Srgb().toLinear;
+    for (; i < _count; ++i)
+    {
+      const unsigned int p = _packed[i];
+      for (int c = 0; c < 3; ++c)
+        _rgba[4 * i + c] = toLinear[(p >> shift[c]) & 0xFF];
+      _rgba[4 * i + 3] = ((p >> shift[3]) & 0xFF) / 255.0f;
+    }
+    return;
+  }
+
+#if defined(IGNITION_MATH_COLOR_SSE2)
+  switch (_format)
+  {
+    case PACKED_RGBA:
+      i = UnpackSse2<_MM_SHUFFLE(0, 1, 2, 3)>(_packed, _count, _rgba);
+      break;
+    case PACKED_BGRA:
+      i = UnpackSse2<_MM_SHUFFLE(0, 3, 2, 1)>(_packed, _count, _rgba);
+      break;
+    case PACKED_ARGB:
+      i = UnpackSse2<_MM_SHUFFLE(3, 0, 1, 2)>(_packed, _count, _rgba);
+      break;
+    case PACKED_ABGR:
+      i = UnpackSse2<_MM_SHUFFLE(3, 2, 1, 0)>(_packed, _count, _rgba);
+      break;
+    default:
+      break;
+  }
+#endif
+
+  for (; i < _count; ++i)
+  {
+    const unsigned int p = _packed[i];
+    for (int c = 0; c < 4; ++c)
+      _rgba[4 * i + c] = ((p >> shift[c]) & 0xFF) / 255.0f;
+  }
+}
+
+//////////////////////////////////////////////////
+void Color::Pack(const float *_rgba, const std::size_t _count,
+                 const PackedFormat _format, unsigned int *_packed,
+                 const bool _srgb)
+{
+  const unsigned int *shift = kPackedShifts[_format];
+  std::size_t i = 0;
+  if (_srgb)
+  {
+    const uint8_t *toSrgb = Srgb().toSrgb;
+    for (; i < _count; ++i)
+    {
+      unsigned int p = 0;
+      for (int c = 0; c < 3; ++c)
+      {
+        const int index = static_cast<int>(
+            ClampUnit(_rgba[4 * i + c]) * (kSrgbEncodeSize - 1) + 0.5f);
+        p |= static_cast<unsigned int>(toSrgb[index]) << shift[c];
+      }
+      p |= static_cast<unsigned int>(ClampUnit(_rgba[4 * i + 3]) * 255)
+        << shift[3];
+      _packed[i] = p;
+    }
+    return;
+  }
+
+#if defined(IGNITION_MATH_COLOR_SSE2)
+  switch (_format)
+  {
+    case PACKED_RGBA:
+      i = PackSse2<_MM_SHUFFLE(0, 1, 2, 3)>(_rgba, _count, _packed);
+      break;
+    case PACKED_BGRA:
+      i = PackSse2<_MM_SHUFFLE(2, 1, 0, 3)>(_rgba, _count, _packed);
+      break;
+    case PACKED_ARGB:
+      i = PackSse2<_MM_SHUFFLE(3, 0, 1, 2)>(_rgba, _count, _packed);
+      break;
+    case PACKED_ABGR:
+      i = PackSse2<_MM_SHUFFLE(3, 2, 1, 0)>(_rgba, _count, _packed);
+      break;
+    default:
+      break;
+  }
+#endif
+
+  for (; i < _count; ++i)
+  {
+    unsigned int p = 0;
+    for (int c = 0; c < 4; ++c)
+    {
+      p |= static_cast<unsigned int>(ClampUnit(_rgba[4 * i + c]) * 255)
+        << shift[c];
+    }
+    _packed[i] = p;
+  }
+}
+
+//////////////////////////////////////////////////
+void Color::RGBAToHSV(const float *_rgba, const std::size_t _count,
+                      float *_hsv)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const float *c = _rgba + 4 * i;
+    RgbToHsv(c[0], c[1], c[2], _hsv + 3 * i);
+  }
+}
+
+//////////////////////////////////////////////////
+void Color::HSVToRGBA(const float *_hsv, const std::size_t _count,
+                      float *_rgba)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const float *hsv = _hsv + 3 * i;
+    float *c = _rgba + 4 * i;
+    if (HsvToRgb(hsv[0], hsv[1], hsv[2], c))
+    {
+      for (int k = 0; k < 3; ++k)
+        c[k] = ClampChannel(c[k]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void Color::RGBAToYUV(const float *_rgba, const std::size_t _count,
+                      float *_yuv)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const float *c = _rgba + 4 * i;
+    RgbToYuv(c[0], c[1], c[2], _yuv + 3 * i);
+  }
+}
+
+//////////////////////////////////////////////////
+void Color::YUVToRGBA(const float *_yuv, const std::size_t _count,
+                      float *_rgba)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const float *yuv = _yuv + 3 * i;
+    float *c = _rgba + 4 * i;
+    YuvToRgb(yuv[0], yuv[1], yuv[2], c);
+    for (int k = 0; k < 3; ++k)
+      c[k] = ClampChannel(c[k]);
+  }
+}
+
 //////////////////////////////////////////////////
 Color &Color::operator=(const Color &_clr)
 {
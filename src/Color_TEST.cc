@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <cstdlib>
+#include <vector>
 #include <gz/math/Color.hh>
 
 using namespace gz;
@@ -408,6 +410,198 @@ TEST(Color, HSV)
   EXPECT_NEAR(clr.A(), 1.0, 1e-3);
 }
 
+/////////////////////////////////////////////////
+TEST(Color, PackUnpackArrays)
+{
+  const math::Color::PackedFormat formats[] = {
+    math::Color::PACKED_RGBA, math::Color::PACKED_BGRA,
+    math::Color::PACKED_ARGB, math::Color::PACKED_ABGR};
+
+  // Not a multiple of four, to cover the scalar tail
+  const std::size_t count = 37;
+  std::vector<unsigned int> packed(count);
+  for (std::size_t i = 0; i < count; ++i)
+    packed[i] = static_cast<unsigned int>(i * 2654435761u);
+  packed[0] = 0u;
+  packed[1] = 0xFFFFFFFFu;
+
+  for (const auto format : formats)
+  {
+    std::vector<float> rgba(4 * count);
+    math::Color::Unpack(packed.data(), count, format, rgba.data());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      math::Color clr;
+      switch (format)
+      {
+        case math::Color::PACKED_RGBA:
+          clr.SetFromRGBA(packed[i]);
+          break;
+        case math::Color::PACKED_BGRA:
+          clr.SetFromBGRA(packed[i]);
+          break;
+        case math::Color::PACKED_ARGB:
+          clr.SetFromARGB(packed[i]);
+          break;
+        case math::Color::PACKED_ABGR:
+          clr.SetFromABGR(packed[i]);
+          break;
+        default:
+          ADD_FAILURE() << "Unknown packed format";
+          break;
+      }
+      EXPECT_EQ(clr.R(), rgba[4 * i]);
+      EXPECT_EQ(clr.G(), rgba[4 * i + 1]);
+      EXPECT_EQ(clr.B(), rgba[4 * i + 2]);
+      EXPECT_EQ(clr.A(), rgba[4 * i + 3]);
+    }
+
+    // Packing gives back the same values, as AsRGBA does
+    std::vector<unsigned int> repacked(count);
+    math::Color::Pack(rgba.data(), count, format, repacked.data());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      math::Color clr(rgba[4 * i], rgba[4 * i + 1], rgba[4 * i + 2],
+                      rgba[4 * i + 3]);
+      unsigned int expected = 0;
+      switch (format)
+      {
+        case math::Color::PACKED_RGBA:
+          expected = clr.AsRGBA();
+          break;
+        case math::Color::PACKED_BGRA:
+          expected = clr.AsBGRA();
+          break;
+        case math::Color::PACKED_ARGB:
+          expected = clr.AsARGB();
+          break;
+        case math::Color::PACKED_ABGR:
+          expected = clr.AsABGR();
+          break;
+        default:
+          ADD_FAILURE() << "Unknown packed format";
+          break;
+      }
+      EXPECT_EQ(expected, repacked[i]);
+    }
+  }
+
+  // Out of range values are clamped, and NaN packs as 0
+  const float values[] = {
+    -1.0f, 2.0f, NAN, 0.5f,
+    0.0f, 1.0f, 0.25f, 1.5f,
+    1.0f, 0.0f, 0.0f, 1.0f,
+    0.0f, 0.0f, 1.0f, 1.0f,
+    1.0f, 1.0f, 0.0f, -0.5f};
+  unsigned int out[5];
+  math::Color::Pack(values, 5, math::Color::PACKED_RGBA, out);
+  EXPECT_EQ(0x00FF007Fu, out[0]);
+  EXPECT_EQ(0x00FF3FFFu, out[1]);
+  EXPECT_EQ(0xFF0000FFu, out[2]);
+  EXPECT_EQ(0x0000FFFFu, out[3]);
+  EXPECT_EQ(0xFFFF0000u, out[4]);
+  math::Color::Pack(values, 5, math::Color::PACKED_ARGB, out);
+  EXPECT_EQ(0x7F00FF00u, out[0]);
+  EXPECT_EQ(0xFFFF0000u, out[2]);
+}
+
+/////////////////////////////////////////////////
+TEST(Color, PackUnpackArraysSrgb)
+{
+  std::vector<unsigned int> packed(256);
+  for (unsigned int i = 0; i < 256; ++i)
+    packed[i] = (i << 24) | ((255 - i) << 16) | (i << 8) | i;
+
+  std::vector<float> rgba(4 * packed.size());
+  math::Color::Unpack(packed.data(), packed.size(),
+      math::Color::PACKED_RGBA, rgba.data(), true);
+
+  EXPECT_FLOAT_EQ(0.0f, rgba[0]);
+  EXPECT_FLOAT_EQ(1.0f, rgba[1]);
+  EXPECT_FLOAT_EQ(1.0f, rgba[4 * 255]);
+  // Middle grey of sRGB
+  EXPECT_NEAR(0.2158605f, rgba[4 * 128], 1e-6);
+  for (unsigned int i = 0; i < 256; ++i)
+  {
+    const float c = i / 255.0f;
+    const float linear = c <= 0.04045f ?
+      c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    EXPECT_NEAR(linear, rgba[4 * i], 1e-6);
+    // Alpha is linear
+    EXPECT_FLOAT_EQ(c, rgba[4 * i + 3]);
+  }
+
+  // Encoding the decoded values gives back the bytes, to within one unit
+  std::vector<unsigned int> repacked(packed.size());
+  math::Color::Pack(rgba.data(), rgba.size() / 4,
+      math::Color::PACKED_RGBA, repacked.data(), true);
+  for (std::size_t i = 0; i < packed.size(); ++i)
+  {
+    for (unsigned int shift : {8u, 16u, 24u})
+    {
+      const int expected = (packed[i] >> shift) & 0xFF;
+      const int actual = (repacked[i] >> shift) & 0xFF;
+      EXPECT_LE(std::abs(expected - actual), 1) << i;
+    }
+    EXPECT_EQ(packed[i] & 0xFF, repacked[i] & 0xFF);
+  }
+  EXPECT_EQ(packed.front(), repacked.front());
+  EXPECT_EQ(packed.back(), repacked.back());
+}
+
+/////////////////////////////////////////////////
+TEST(Color, HSVYUVArrays)
+{
+  const std::size_t count = 64;
+  std::vector<float> rgba(4 * count);
+  for (std::size_t i = 0; i < rgba.size(); ++i)
+    rgba[i] = std::fmod(i * 0.618034f, 1.0f);
+  // Grey, black and white
+  for (std::size_t k = 0; k < 3; ++k)
+  {
+    rgba[k] = 0.5f;
+    rgba[4 + k] = 0.0f;
+    rgba[8 + k] = 1.0f;
+  }
+
+  std::vector<float> hsv(3 * count);
+  std::vector<float> yuv(3 * count);
+  math::Color::RGBAToHSV(rgba.data(), count, hsv.data());
+  math::Color::RGBAToYUV(rgba.data(), count, yuv.data());
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const math::Color clr(rgba[4 * i], rgba[4 * i + 1], rgba[4 * i + 2]);
+    const math::Vector3f expectedHsv = clr.HSV();
+    const math::Vector3f expectedYuv = clr.YUV();
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      EXPECT_EQ(expectedHsv[k], hsv[3 * i + k]);
+      EXPECT_EQ(expectedYuv[k], yuv[3 * i + k]);
+    }
+  }
+
+  // Back to RGB, alpha is left unchanged
+  std::vector<float> fromHsv(4 * count, 0.25f);
+  std::vector<float> fromYuv(4 * count, 0.75f);
+  math::Color::HSVToRGBA(hsv.data(), count, fromHsv.data());
+  math::Color::YUVToRGBA(yuv.data(), count, fromYuv.data());
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    math::Color clrHsv;
+    clrHsv.SetFromHSV(hsv[3 * i], hsv[3 * i + 1], hsv[3 * i + 2]);
+    math::Color clrYuv;
+    clrYuv.SetFromYUV(yuv[3 * i], yuv[3 * i + 1], yuv[3 * i + 2]);
+    EXPECT_EQ(clrHsv.R(), fromHsv[4 * i]);
+    EXPECT_EQ(clrHsv.G(), fromHsv[4 * i + 1]);
+    EXPECT_EQ(clrHsv.B(), fromHsv[4 * i + 2]);
+    EXPECT_FLOAT_EQ(0.25f, fromHsv[4 * i + 3]);
+    EXPECT_EQ(clrYuv.R(), fromYuv[4 * i]);
+    EXPECT_EQ(clrYuv.G(), fromYuv[4 * i + 1]);
+    EXPECT_EQ(clrYuv.B(), fromYuv[4 * i + 2]);
+    EXPECT_FLOAT_EQ(0.75f, fromYuv[4 * i + 3]);
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "gz/math/Colormap.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/Instrumentation.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Number of packed formats of Color::PackedFormat.
+  const std::size_t kFormats = 4;
+
+  /// \brief Round a channel to the nearest byte.
+  /// \param[in] _c Channel value, clamped to [0, 1].
+  /// \return The byte.
+  int ToByte(const float _c)
+  {
+    return static_cast<int>(std::lround(clamp(_c, 0.0f, 1.0f) * 255.0f));
+  }
+
+  /// \brief Sample a colormap function, to build a colormap from evenly
+  /// spaced stops.
+  /// \param[in] _fn Function from [0, 1] to red, green and blue.
+  /// \return The colors of the stops.
+  template<typename F>
+  std::vector<Color> Sample(F _fn)
+  {
+    std::vector<Color> colors(Colormap::kDefaultSize);
+    for (std::size_t i = 0; i < colors.size(); ++i)
+    {
+      const Vector3d c = _fn(i / static_cast<double>(colors.size() - 1));
+      colors[i].Set(static_cast<float>(c.X()), static_cast<float>(c.Y()),
+                    static_cast<float>(c.Z()));
+    }
+    return colors;
+  }
+}
+
+/// \brief Private data for Colormap.
+class gz::math::ColormapPrivate
+{
+  /// \brief Build the lookup table from color stops.
+  /// \param[in] _positions Positions of the stops.
+  /// \param[in] _colors Colors of the stops.
+  /// \param[in] _size Number of colors of the table.
+  public: void Build(const std::vector<float> &_positions,
+                     const std::vector<Color> &_colors,
+                     const std::size_t _size)
+  {
+    this->rgba.clear();
+    for (auto &table : this->packed)
+      table.clear();
+
+    bool valid = !_colors.empty() && _size > 0 &&
+        _positions.size() == _colors.size();
+    if (valid && _colors.size() > 1)
+    {
+      valid = equal(_positions.front(), 0.0f) &&
+          equal(_positions.back(), 1.0f);
+      for (std::size_t k = 1; valid && k < _positions.size(); ++k)
+        valid = _positions[k - 1] < _positions[k];
+    }
+    if (!valid)
+      return;
+
+    // Each channel is rounded to the nearest byte, so that the packed
+    // colors are exact and At() returns what Map() writes.
+    this->rgba.resize(4 * _size);
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+      Color c = _colors.front();
+      if (_colors.size() > 1)
+      {
+        const float t = _size > 1 ? i / static_cast<float>(_size - 1) : 0;
+        while (k + 2 < _positions.size() && t > _positions[k + 1])
+          ++k;
+        const float s = clamp((t - _positions[k]) /
+            (_positions[k + 1] - _positions[k]), 0.0f, 1.0f);
+        c = _colors[k] * (1.0f - s) + _colors[k + 1] * s;
+        c.A(_colors[k].A() * (1.0f - s) + _colors[k + 1].A() * s);
+      }
+      const float channels[4] = {c.R(), c.G(), c.B(), c.A()};
+      for (int j = 0; j < 4; ++j)
+        this->rgba[4 * i + j] = ToByte(channels[j]) / 255.0f;
+    }
+
+    // Pack truncates, so pack the middle of each byte.
+    std::vector<float> middle(this->rgba.size());
+    for (std::size_t i = 0; i < middle.size(); ++i)
+      middle[i] = (ToByte(this->rgba[i]) + 0.5f) / 255.0f;
+    for (std::size_t f = 0; f < kFormats; ++f)
+    {
+      this->packed[f].resize(_size);
+      Color::Pack(middle.data(), _size,
+          static_cast<Color::PackedFormat>(f), this->packed[f].data());
+    }
+  }
+
+  /// \brief Set the color of NaN values, and pack it.
+  /// \param[in] _color The color.
+  public: void SetNanColor(const Color &_color)
+  {
+    this->nanColor = _color;
+    const float channels[4] = {_color.R(), _color.G(), _color.B(),
+                               _color.A()};
+    float middle[4];
+    for (int j = 0; j < 4; ++j)
+      middle[j] = (ToByte(channels[j]) + 0.5f) / 255.0f;
+    for (std::size_t f = 0; f < kFormats; ++f)
+    {
+      Color::Pack(middle, 1, static_cast<Color::PackedFormat>(f),
+          &this->nanPacked[f]);
+    }
+  }
+
+  /// \brief Map an array of values to packed colors.
+  /// \param[in] _values The values.
+  /// \param[in] _count Number of values.
+  /// \param[in] _min Value of the first color.
+  /// \param[in] _max Value of the last color.
+  /// \param[in] _format Channel order of the packed colors.
+  /// \param[out] _out Packed colors.
+  public: template<typename T>
+  void Map(const T *_values, const std::size_t _count, const T _min,
+           const T _max, const Color::PackedFormat _format,
+           unsigned int *_out) const
+  {
+    const unsigned int nan = this->nanPacked[_format];
+    const std::vector<unsigned int> &table = this->packed[_format];
+    if (table.empty())
+    {
+      std::fill(_out, _out + _count, nan);
+      return;
+    }
+
+    const unsigned int *lut = table.data();
+    const T last = static_cast<T>(table.size() - 1);
+    const T scale = _max > _min ? last / (_max - _min) : T(0);
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      const T v = _values[i];
+      // Comparisons with NaN are false, so the index of NaN is 0.
+      T t = (v - _min) * scale + T(0.5);
+      t = t > T(0) ? t : T(0);
+      t = t < last ? t : last;
+      const unsigned int c = lut[static_cast<std::size_t>(t)];
+      _out[i] = std::isnan(v) ? nan : c;
+    }
+  }
+
+  /// \brief Red, green, blue and alpha of each color of the table.
+  public: std::vector<float> rgba;
+
+  /// \brief Colors of the table packed in each format.
+  public: std::vector<unsigned int> packed[kFormats];
+
+  /// \brief Color of NaN values.
+  public: Color nanColor{0, 0, 0, 0};
+
+  /// \brief Color of NaN values packed in each format.
+  public: unsigned int nanPacked[kFormats] = {0, 0, 0, 0};
+};
+
+/////////////////////////////////////////////////
+Colormap::Colormap()
+  : Colormap({Color::Black, Color::White})
+{
+}
+
+/////////////////////////////////////////////////
+Colormap::Colormap(const std::vector<Color> &_colors,
+    const std::size_t _size)
+  : dataPtr(std::make_unique<ColormapPrivate>())
+{
+  std::vector<float> positions(_colors.size(), 0.0f);
+  for (std::size_t i = 1; i < positions.size(); ++i)
+    positions[i] = i / static_cast<float>(positions.size() - 1);
+  this->dataPtr->Build(positions, _colors, _size);
+}
+
+/////////////////////////////////////////////////
+Colormap::Colormap(const std::vector<float> &_positions,
+    const std::vector<Color> &_colors, const std::size_t _size)
+  : dataPtr(std::make_unique<ColormapPrivate>())
+{
+  this->dataPtr->Build(_positions, _colors, _size);
+}
+
+/////////////////////////////////////////////////
+Colormap::Colormap(const Colormap &_other)
+  : dataPtr(std::make_unique<ColormapPrivate>(*_other.dataPtr))
+{
+  IGN_MATH_COUNT_COPY(PIMPL, sizeof(ColormapPrivate) +
+      this->dataPtr->rgba.size() * (sizeof(float) + sizeof(unsigned int)));
+}
+
+/////////////////////////////////////////////////
+Colormap::Colormap(Colormap &&_other) noexcept = default;
+
+/////////////////////////////////////////////////
+Colormap::~Colormap() = default;
+
+/////////////////////////////////////////////////
+Colormap &Colormap::operator=(const Colormap &_other)
+{
+  if (this != &_other)
+  {
+    IGN_MATH_COUNT_COPY(PIMPL, sizeof(ColormapPrivate) +
+        _other.dataPtr->rgba.size() *
+        (sizeof(float) + sizeof(unsigned int)));
+    *this->dataPtr = *_other.dataPtr;
+  }
+  return *this;
+}
+
+/////////////////////////////////////////////////
+Colormap &Colormap::operator=(Colormap &&_other) noexcept = default;
+
+/////////////////////////////////////////////////
+const Colormap &Colormap::Viridis()
+{
+  static const Colormap viridis({
+      Color(0x44 / 255.0f, 0x01 / 255.0f, 0x54 / 255.0f),
+      Color(0x48 / 255.0f, 0x24 / 255.0f, 0x75 / 255.0f),
+      Color(0x41 / 255.0f, 0x44 / 255.0f, 0x87 / 255.0f),
+      Color(0x35 / 255.0f, 0x5f / 255.0f, 0x8d / 255.0f),
+      Color(0x2a / 255.0f, 0x78 / 255.0f, 0x8e / 255.0f),
+      Color(0x21 / 255.0f, 0x91 / 255.0f, 0x8c / 255.0f),
+      Color(0x22 / 255.0f, 0xa8 / 255.0f, 0x84 / 255.0f),
+      Color(0x44 / 255.0f, 0xbf / 255.0f, 0x70 / 255.0f),
+      Color(0x7a / 255.0f, 0xd1 / 255.0f, 0x51 / 255.0f),
+      Color(0xbd / 255.0f, 0xdf / 255.0f, 0x26 / 255.0f),
+      Color(0xfd / 255.0f, 0xe7 / 255.0f, 0x25 / 255.0f)});
+  return viridis;
+}
+
+/////////////////////////////////////////////////
+const Colormap &Colormap::Jet()
+{
+  static const Colormap jet(Sample([](const double _t)
+  {
+    return Vector3d(
+        clamp(1.5 - std::abs(4.0 * _t - 3.0), 0.0, 1.0),
+        clamp(1.5 - std::abs(4.0 * _t - 2.0), 0.0, 1.0),
+        clamp(1.5 - std::abs(4.0 * _t - 1.0), 0.0, 1.0));
+  }));
+  return jet;
+}
+
+/////////////////////////////////////////////////
+const Colormap &Colormap::Turbo()
+{
+  // Polynomial approximation of turbo, with coefficients of degree 0 to
+  // 5 for each channel, by Anton Mikhailov.
+  static const Colormap turbo(Sample([](const double _t)
+  {
+    static const double coefficients[3][6] = {
+      {0.13572138, 4.61539260, -42.66032258, 132.13108234, -152.94239396,
+       59.28637943},
+      {0.09140261, 2.19418839, 4.84296658, -14.18503333, 4.27729857,
+       2.82956604},
+      {0.10667330, 12.64194608, -60.58204836, 110.36276771, -89.90310912,
+       27.34824973}};
+    double c[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      c[j] = 0;
+      for (int d = 5; d >= 0; --d)
+        c[j] = c[j] * _t + coefficients[j][d];
+      c[j] = clamp(c[j], 0.0, 1.0);
+    }
+    return Vector3d(c[0], c[1], c[2]);
+  }));
+  return turbo;
+}
+
+/////////////////////////////////////////////////
+bool Colormap::Valid() const
+{
+  return !this->dataPtr->rgba.empty();
+}
+
+/////////////////////////////////////////////////
+std::size_t Colormap::Size() const
+{
+  return this->dataPtr->rgba.size() / 4;
+}
+
+/////////////////////////////////////////////////
+void Colormap::SetNanColor(const Color &_color)
+{
+  this->dataPtr->SetNanColor(_color);
+}
+
+/////////////////////////////////////////////////
+Color Colormap::NanColor() const
+{
+  return this->dataPtr->nanColor;
+}
+
+/////////////////////////////////////////////////
+Color Colormap::At(const float _t) const
+{
+  const std::vector<float> &rgba = this->dataPtr->rgba;
+  if (std::isnan(_t) || rgba.empty())
+    return this->dataPtr->nanColor;
+
+  const float last = static_cast<float>(this->Size() - 1);
+  const std::size_t i = static_cast<std::size_t>(
+      clamp(_t, 0.0f, 1.0f) * last + 0.5f);
+  return Color(rgba[4 * i], rgba[4 * i + 1], rgba[4 * i + 2],
+               rgba[4 * i + 3]);
+}
+
+/////////////////////////////////////////////////
+void Colormap::Map(const float *_values, const std::size_t _count,
+    const float _min, const float _max, const Color::PackedFormat _format,
+    unsigned int *_packed) const
+{
+  this->dataPtr->Map(_values, _count, _min, _max, _format, _packed);
+}
+
+/////////////////////////////////////////////////
+void Colormap::Map(const double *_values, const std::size_t _count,
+    const double _min, const double _max, const Color::PackedFormat _format,
+    unsigned int *_packed) const
+{
+  this->dataPtr->Map(_values, _count, _min, _max, _format, _packed);
+}
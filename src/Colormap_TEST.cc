@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Colormap.hh"
+#include "gz/math/PiecewiseScalarField3.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(ColormapTest, Constructor)
+{
+  Colormap gray;
+  EXPECT_TRUE(gray.Valid());
+  EXPECT_EQ(Colormap::kDefaultSize, gray.Size());
+  EXPECT_EQ(Color::Black, gray.At(0.0f));
+  EXPECT_EQ(Color::White, gray.At(1.0f));
+  EXPECT_EQ(Color(0, 0, 0, 0), gray.NanColor());
+
+  // Interpolated colors are rounded to bytes
+  const Color mid = gray.At(0.5f);
+  EXPECT_EQ(mid.AsRGBA(), Color(128 / 255.0f, 128 / 255.0f,
+      128 / 255.0f).AsRGBA());
+
+  Colormap uniform({Color::Red}, 4);
+  EXPECT_TRUE(uniform.Valid());
+  EXPECT_EQ(4u, uniform.Size());
+  EXPECT_EQ(Color::Red, uniform.At(0.7f));
+
+  // Stops at positions, with alpha
+  Colormap stops({0.0f, 0.25f, 1.0f},
+      {Color(0, 0, 0, 0), Color::Red, Color::Blue}, 5);
+  EXPECT_TRUE(stops.Valid());
+  EXPECT_EQ(Color(0, 0, 0, 0), stops.At(0.0f));
+  EXPECT_EQ(Color::Red, stops.At(0.25f));
+  EXPECT_EQ(Color::Blue, stops.At(1.0f));
+  EXPECT_EQ(Color::Blue, stops.At(2.0f));
+  EXPECT_EQ(Color(0, 0, 0, 0), stops.At(-1.0f));
+}
+
+/////////////////////////////////////////////////
+TEST(ColormapTest, Invalid)
+{
+  for (const auto &colormap : {
+       Colormap(std::vector<Color>()),
+       Colormap({Color::Red, Color::Blue}, 0),
+       Colormap({0.0f}, {Color::Red, Color::Blue}),
+       Colormap({0.0f, 0.5f}, {Color::Red, Color::Blue}),
+       Colormap({0.0f, 0.5f, 0.5f, 1.0f},
+                {Color::Red, Color::Blue, Color::Red, Color::Blue})})
+  {
+    EXPECT_FALSE(colormap.Valid());
+    EXPECT_EQ(0u, colormap.Size());
+    EXPECT_EQ(colormap.NanColor(), colormap.At(0.5f));
+
+    const float values[2] = {0.0f, 1.0f};
+    unsigned int packed[2] = {1, 1};
+    colormap.Map(values, 2, 0.0f, 1.0f, Color::PACKED_RGBA, packed);
+    EXPECT_EQ(0u, packed[0]);
+    EXPECT_EQ(0u, packed[1]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ColormapTest, Map)
+{
+  Colormap colormap({Color::Red, Color::Green, Color::Blue}, 3);
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float inf = std::numeric_limits<float>::infinity();
+  const std::vector<float> values = {
+    10.0f, 14.0f, 16.0f, 20.0f, 30.0f, -5.0f, nan, inf, -inf};
+  std::vector<unsigned int> packed(values.size());
+
+  colormap.Map(values.data(), values.size(), 10.0f, 20.0f,
+      Color::PACKED_RGBA, packed.data());
+  EXPECT_EQ(Color::Red.AsRGBA(), packed[0]);
+  EXPECT_EQ(Color::Green.AsRGBA(), packed[1]);
+  EXPECT_EQ(Color::Green.AsRGBA(), packed[2]);
+  EXPECT_EQ(Color::Blue.AsRGBA(), packed[3]);
+  EXPECT_EQ(Color::Blue.AsRGBA(), packed[4]);
+  EXPECT_EQ(Color::Red.AsRGBA(), packed[5]);
+  EXPECT_EQ(0u, packed[6]);
+  EXPECT_EQ(Color::Blue.AsRGBA(), packed[7]);
+  EXPECT_EQ(Color::Red.AsRGBA(), packed[8]);
+
+  // Every packed format, and a NaN color
+  colormap.SetNanColor(Color::Yellow);
+  EXPECT_EQ(Color::Yellow, colormap.NanColor());
+  colormap.Map(values.data(), values.size(), 10.0f, 20.0f,
+      Color::PACKED_ABGR, packed.data());
+  EXPECT_EQ(Color::Green.AsABGR(), packed[1]);
+  EXPECT_EQ(Color::Yellow.AsABGR(), packed[6]);
+  colormap.Map(values.data(), values.size(), 10.0f, 20.0f,
+      Color::PACKED_BGRA, packed.data());
+  EXPECT_EQ(Color::Blue.AsBGRA(), packed[3]);
+  colormap.Map(values.data(), values.size(), 10.0f, 20.0f,
+      Color::PACKED_ARGB, packed.data());
+  EXPECT_EQ(Color::Red.AsARGB(), packed[0]);
+
+  // An empty range maps to the first color
+  colormap.Map(values.data(), values.size(), 10.0f, 10.0f,
+      Color::PACKED_RGBA, packed.data());
+  EXPECT_EQ(Color::Red.AsRGBA(), packed[3]);
+  EXPECT_EQ(Color::Yellow.AsRGBA(), packed[6]);
+
+  // The table matches At
+  const Colormap &viridis = Colormap::Viridis();
+  std::vector<float> ramp(1000);
+  for (std::size_t i = 0; i < ramp.size(); ++i)
+    ramp[i] = i / 999.0f;
+  packed.resize(ramp.size());
+  viridis.Map(ramp.data(), ramp.size(), 0.0f, 1.0f, Color::PACKED_RGBA,
+      packed.data());
+  for (std::size_t i = 0; i < ramp.size(); ++i)
+    EXPECT_EQ(viridis.At(ramp[i]).AsRGBA(), packed[i]);
+}
+
+/////////////////////////////////////////////////
+TEST(ColormapTest, Builtin)
+{
+  // Ends of viridis
+  EXPECT_EQ(0x440154FFu, Colormap::Viridis().At(0.0f).AsRGBA());
+  EXPECT_EQ(0x21918CFFu, Colormap::Viridis().At(0.5f).AsRGBA());
+  EXPECT_EQ(0xFDE725FFu, Colormap::Viridis().At(1.0f).AsRGBA());
+  EXPECT_EQ(&Colormap::Viridis(), &Colormap::Viridis());
+
+  // Jet goes from dark blue through green to dark red
+  const Color jetLow = Colormap::Jet().At(0.0f);
+  EXPECT_NEAR(0.0f, jetLow.R(), 1e-6);
+  EXPECT_NEAR(0.5f, jetLow.B(), 0.01);
+  const Color jetMid = Colormap::Jet().At(0.5f);
+  EXPECT_NEAR(0.5f, jetMid.R(), 0.01);
+  EXPECT_NEAR(1.0f, jetMid.G(), 1e-6);
+  const Color jetHigh = Colormap::Jet().At(1.0f);
+  EXPECT_NEAR(0.5f, jetHigh.R(), 0.01);
+  EXPECT_NEAR(0.0f, jetHigh.B(), 1e-6);
+
+  // Turbo is dark at both ends, and bright in the middle
+  const Color turboLow = Colormap::Turbo().At(0.0f);
+  const Color turboMid = Colormap::Turbo().At(0.5f);
+  const Color turboHigh = Colormap::Turbo().At(1.0f);
+  EXPECT_LT(turboLow.G(), 0.2f);
+  EXPECT_GT(turboMid.G(), 0.9f);
+  EXPECT_GT(turboHigh.R(), turboHigh.G());
+  EXPECT_LT(turboHigh.B(), 0.1f);
+  for (const auto *colormap :
+       {&Colormap::Viridis(), &Colormap::Jet(), &Colormap::Turbo()})
+  {
+    EXPECT_TRUE(colormap->Valid());
+    EXPECT_EQ(Colormap::kDefaultSize, colormap->Size());
+    EXPECT_EQ(1.0f, colormap->At(0.3f).A());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ColormapTest, PiecewiseScalarField3)
+{
+  using ScalarField3dT = std::function<double(const Vector3d&)>;
+  const PiecewiseScalarField3d<ScalarField3dT> field({
+      {Region3d::Closed(0., 0., 0., 1., 1., 1.),
+       [](const Vector3d &_v) { return _v.X(); }}});
+
+  const std::vector<Vector3d> points = {
+    {0, 0, 0}, {0.5, 0, 0}, {1, 0, 0}, {2, 0, 0}};
+  std::vector<double> values(points.size());
+  field.Evaluate(points.data(), points.size(), values.data());
+
+  const Colormap colormap({Color::Black, Color::White}, 3);
+  std::vector<unsigned int> packed(values.size());
+  colormap.Map(values.data(), values.size(), 0.0, 1.0, Color::PACKED_RGBA,
+      packed.data());
+  EXPECT_EQ(Color::Black.AsRGBA(), packed[0]);
+  EXPECT_EQ(0x808080FFu, packed[1]);
+  EXPECT_EQ(Color::White.AsRGBA(), packed[2]);
+
+  // Outside of the field
+  EXPECT_EQ(0u, packed[3]);
+}
+
+/////////////////////////////////////////////////
+TEST(ColormapTest, CopyMove)
+{
+  Colormap colormap({Color::Red, Color::Blue}, 16);
+  colormap.SetNanColor(Color::White);
+
+  Colormap copy(colormap);
+  EXPECT_EQ(16u, copy.Size());
+  EXPECT_EQ(Color::White, copy.NanColor());
+
+  Colormap assigned;
+  assigned = copy;
+  EXPECT_EQ(Color::Blue, assigned.At(1.0f));
+
+  Colormap moved(std::move(copy));
+  EXPECT_EQ(Color::Red, moved.At(0.0f));
+
+  // The copies are independent
+  assigned.SetNanColor(Color::Black);
+  EXPECT_EQ(Color::White, colormap.NanColor());
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gz/math/ConvexHull3.hh"
+#include "gz/math/MeshMassProperties.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Check that a hull is a closed, convex triangle mesh that holds
+/// all the points.
+/// \param[in] _hull The hull.
+/// \param[in] _points Points the hull was built from.
+template<typename T>
+static void CheckHull(const ConvexHull3<T> &_hull,
+                      const std::vector<Vector3<T>> &_points)
+{
+  ASSERT_TRUE(_hull.Valid());
+  const auto &vertices = _hull.Vertices();
+  const auto &indices = _hull.Indices();
+  ASSERT_EQ(vertices.size(), _hull.InputIndices().size());
+  ASSERT_EQ(3 * _hull.TriangleCount(), indices.size());
+
+  // Each directed edge appears once, and its reverse once.
+  std::map<std::pair<std::size_t, std::size_t>, int> edges;
+  for (std::size_t t = 0; t < indices.size(); t += 3)
+  {
+    for (int e = 0; e < 3; ++e)
+      ++edges[{indices[t + e], indices[t + (e + 1) % 3]}];
+  }
+  for (const auto &edge : edges)
+  {
+    EXPECT_EQ(1, edge.second);
+    EXPECT_EQ(1u, edges.count({edge.first.second, edge.first.first}));
+  }
+
+  // Euler characteristic of a sphere.
+  EXPECT_EQ(2, static_cast<int>(vertices.size()) -
+               static_cast<int>(edges.size() / 2) +
+               static_cast<int>(_hull.TriangleCount()));
+
+  // Every point is below every face, which points out.
+  const T tolerance = 4 * _hull.Tolerance();
+  for (std::size_t t = 0; t < indices.size(); t += 3)
+  {
+    const Vector3<T> &a = vertices[indices[t]];
+    const Vector3<T> normal = (vertices[indices[t + 1]] - a).Cross(
+        vertices[indices[t + 2]] - a).Normalized();
+    for (const auto &p : _points)
+      EXPECT_LE(normal.Dot(p - a), tolerance);
+  }
+
+  for (std::size_t i = 0; i < vertices.size(); ++i)
+    EXPECT_EQ(_points[_hull.InputIndices()[i]], vertices[i]);
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHull3Test, Cube)
+{
+  // Corners of a cube, with points inside.
+  std::vector<Vector3d> points;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> coord(-1, 1);
+  for (int i = 0; i < 1000; ++i)
+    points.emplace_back(0.99 * coord(rng), 0.99 * coord(rng), coord(rng));
+  for (int i = 0; i < 8; ++i)
+    points.emplace_back(i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1);
+  points.emplace_back(std::numeric_limits<double>::quiet_NaN(), 0, 0);
+
+  ConvexHull3d hull;
+  ASSERT_TRUE(hull.Build(points));
+  EXPECT_EQ(8u, hull.Vertices().size());
+  EXPECT_EQ(12u, hull.TriangleCount());
+  CheckHull(hull, std::vector<Vector3d>(points.begin(), points.end() - 1));
+
+  // Input indices are in input order.
+  EXPECT_EQ(1000u, hull.InputIndices().front());
+  EXPECT_EQ(1007u, hull.InputIndices().back());
+
+  // The winding suits MeshMassProperties.
+  MeshMassPropertiesd props;
+  props.AddTriangles(hull.Vertices().data(), hull.Indices().data(),
+                     hull.TriangleCount());
+  EXPECT_NEAR(8.0, props.Volume(), 1e-12);
+
+  EXPECT_TRUE(hull.Contains(Vector3d(0.9, -0.9, 0.5)));
+  EXPECT_TRUE(hull.Contains(Vector3d(1, 1, 1)));
+  EXPECT_FALSE(hull.Contains(Vector3d(1.01, 0, 0)));
+
+  const std::size_t support = hull.Support(Vector3d(1, -2, 3));
+  ASSERT_NE(ConvexHull3d::kNoPoint, support);
+  EXPECT_EQ(Vector3d(1, -1, 1), hull.Vertices()[support]);
+
+  // Points on the sides may be kept as vertices, which doesn't change the
+  // shape of the hull.
+  for (int i = 0; i < 500; ++i)
+    points.emplace_back(coord(rng), coord(rng), 1);
+  points.erase(points.begin() + 1008);
+  ASSERT_TRUE(hull.Build(points));
+  EXPECT_GE(hull.Vertices().size(), 8u);
+  CheckHull(hull, points);
+  props.Reset();
+  props.AddTriangles(hull.Vertices().data(), hull.Indices().data(),
+                     hull.TriangleCount());
+  EXPECT_NEAR(8.0, props.Volume(), 1e-12);
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHull3Test, Sphere)
+{
+  // Points on a sphere are all vertices of their hull.
+  std::vector<Vector3d> points;
+  std::mt19937 rng(2);
+  std::normal_distribution<double> normal;
+  for (int i = 0; i < 2000; ++i)
+  {
+    points.push_back(
+        Vector3d(normal(rng), normal(rng), normal(rng)).Normalize() * 5 +
+        Vector3d(100, -50, 20));
+  }
+
+  ConvexHull3d hull;
+  ASSERT_TRUE(hull.Build(points));
+  EXPECT_EQ(points.size(), hull.Vertices().size());
+  CheckHull(hull, points);
+
+  // The hull doesn't depend on the number of threads.
+  for (int i = 0; i < 40000; ++i)
+  {
+    points.push_back(
+        Vector3d(normal(rng), normal(rng), normal(rng)) +
+        Vector3d(100, -50, 20));
+  }
+  ASSERT_TRUE(hull.Build(points));
+  CheckHull(hull, points);
+  for (const unsigned int threads : {0u, 3u})
+  {
+    ConvexHull3d parallel;
+    ASSERT_TRUE(parallel.Build(points, threads));
+    EXPECT_EQ(hull.InputIndices(), parallel.InputIndices());
+    EXPECT_EQ(hull.Indices(), parallel.Indices());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHull3Test, Float)
+{
+  std::vector<Vector3f> points;
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> coord(-3, 3);
+  for (int i = 0; i < 3000; ++i)
+    points.emplace_back(coord(rng), coord(rng), 0.1f * coord(rng));
+
+  ConvexHull3f hull;
+  ASSERT_TRUE(hull.Build(points.data(), points.size()));
+  EXPECT_LT(hull.Vertices().size(), 200u);
+  CheckHull(hull, points);
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHull3Test, Degenerate)
+{
+  ConvexHull3d hull;
+  EXPECT_FALSE(hull.Valid());
+  EXPECT_EQ(ConvexHull3d::kNoPoint, hull.Support(Vector3d::UnitX));
+  EXPECT_FALSE(hull.Contains(Vector3d::Zero));
+
+  // Too few points, or points on a plane or a line.
+  EXPECT_FALSE(hull.Build(std::vector<Vector3d>()));
+  EXPECT_FALSE(hull.Build({Vector3d(0, 0, 0), Vector3d(1, 0, 0),
+                           Vector3d(0, 1, 0)}));
+  EXPECT_FALSE(hull.Build({Vector3d(0, 0, 0), Vector3d(1, 0, 0),
+                           Vector3d(0, 1, 0), Vector3d(1, 1, 0)}));
+  EXPECT_FALSE(hull.Build({Vector3d(0, 0, 0), Vector3d(1, 1, 1),
+                           Vector3d(2, 2, 2), Vector3d(3, 3, 3)}));
+  EXPECT_FALSE(hull.Build({Vector3d::One, Vector3d::One, Vector3d::One,
+                           Vector3d::One}));
+  EXPECT_FALSE(hull.Valid());
+  EXPECT_TRUE(hull.Vertices().empty());
+
+  // A tetrahedron is its own hull, and a failed build clears the hull.
+  const std::vector<Vector3d> tetrahedron = {Vector3d(0, 0, 0),
+      Vector3d(1, 0, 0), Vector3d(0, 1, 0), Vector3d(0, 0, 1)};
+  ASSERT_TRUE(hull.Build(tetrahedron));
+  EXPECT_EQ(4u, hull.Vertices().size());
+  EXPECT_EQ(4u, hull.TriangleCount());
+  CheckHull(hull, tetrahedron);
+  EXPECT_FALSE(hull.Build(std::vector<Vector3d>(3, Vector3d::Zero)));
+  EXPECT_EQ(0u, hull.TriangleCount());
+}
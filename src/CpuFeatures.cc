@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #include <intrin.h>
+#endif
+
+#include "gz/math/CpuFeatures.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Number of instruction sets.
+  const int kSimdLevelCount = static_cast<int>(SimdLevel::NEON) + 1;
+
+  /// \brief Lowercase names of the instruction sets.
+  const char *const kSimdLevelNames[kSimdLevelCount] =
+      {"scalar", "sse2", "avx", "avx2", "avx512", "neon"};
+
+  /// \brief Detect the widest instruction set of the CPU and the
+  /// operating system.
+  /// \return The instruction set.
+  SimdLevel DetectSimdLevel()
+  {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+  #if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] & (1 << 26)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+
+    // The operating system saves the AVX and AVX-512 registers
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const unsigned __int64 xcr0 = osxsave ? _xgetbv(0) : 0;
+    const bool osAvx = (xcr0 & 0x6) == 0x6;
+    const bool osAvx512 = (xcr0 & 0xE6) == 0xE6;
+
+    bool avx2 = false;
+    bool avx512 = false;
+    if (maxLeaf >= 7)
+    {
+      __cpuidex(info, 7, 0);
+      avx2 = (info[1] & (1 << 5)) != 0;
+      avx512 = (info[1] & (1 << 16)) != 0;
+    }
+
+    if (avx512 && avx2 && fma && osAvx512)
+      return SimdLevel::AVX512;
+    if (avx2 && fma && osAvx)
+      return SimdLevel::AVX2;
+    if (avx && osAvx)
+      return SimdLevel::AVX;
+    return sse2 ? SimdLevel::SSE2 : SimdLevel::SCALAR;
+  #elif defined(__GNUC__)
+    // These also check that the operating system saves the registers
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+      return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+      return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("avx"))
+      return SimdLevel::AVX;
+    if (__builtin_cpu_supports("sse2"))
+      return SimdLevel::SSE2;
+    return SimdLevel::SCALAR;
+  #else
+    return SimdLevel::SCALAR;
+  #endif
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+    // NEON is part of AArch64, and 32 bit builds only use it when the
+    // compiler targets it.
+    return SimdLevel::NEON;
+#else
+    return SimdLevel::SCALAR;
+#endif
+  }
+
+  /// \brief Check if an instruction set is supported, given the widest
+  /// supported one.
+  /// \param[in] _level The instruction set.
+  /// \param[in] _supported The widest supported instruction set.
+  /// \return True if it is supported.
+  bool Supports(const SimdLevel _level, const SimdLevel _supported)
+  {
+    if (_level == SimdLevel::SCALAR || _level == _supported)
+      return true;
+    if (_level == SimdLevel::NEON || _supported == SimdLevel::NEON)
+      return false;
+    return static_cast<int>(_level) < static_cast<int>(_supported);
+  }
+
+  /// \brief Get the instruction set used by default.
+  /// \return The instruction set.
+  SimdLevel DefaultSimdLevel()
+  {
+#if defined(IGNITION_MATH_DISABLE_SIMD)
+    return SimdLevel::SCALAR;
+#else
+    const SimdLevel supported = SupportedSimdLevel();
+    const char *name = std::getenv("IGNITION_MATH_SIMD");
+    if (name)
+    {
+      for (int i = 0; i < kSimdLevelCount; ++i)
+      {
+        const SimdLevel level = static_cast<SimdLevel>(i);
+        if (std::strcmp(name, kSimdLevelNames[i]) == 0 &&
+            Supports(level, supported))
+        {
+          return level;
+        }
+      }
+    }
+    return supported;
+#endif
+  }
+
+  /// \brief Get the instruction set used by the batch kernels.
+  /// \return Reference to the instruction set.
+  std::atomic<SimdLevel> &Active()
+  {
+    static std::atomic<SimdLevel> active(DefaultSimdLevel());
+    return active;
+  }
+}
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    /////////////////////////////////////////////
+    SimdLevel SupportedSimdLevel()
+    {
+      static const SimdLevel supported = DetectSimdLevel();
+      return supported;
+    }
+
+    /////////////////////////////////////////////
+    SimdLevel ActiveSimdLevel()
+    {
+      return Active().load(std::memory_order_relaxed);
+    }
+
+    /////////////////////////////////////////////
+    bool SetActiveSimdLevel(const SimdLevel _level)
+    {
+      const int index = static_cast<int>(_level);
+      if (index < 0 || index >= kSimdLevelCount ||
+          !Supports(_level, SupportedSimdLevel()))
+      {
+        return false;
+      }
+      Active().store(_level, std::memory_order_relaxed);
+      return true;
+    }
+
+    /////////////////////////////////////////////
+    const char *SimdLevelName(const SimdLevel _level)
+    {
+      const int index = static_cast<int>(_level);
+      if (index < 0 || index >= kSimdLevelCount)
+        return "unknown";
+      return kSimdLevelNames[index];
+    }
+    }
+  }
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "gz/math/CpuFeatures.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(CpuFeaturesTest, Names)
+{
+  EXPECT_EQ(std::string("scalar"),
+            math::SimdLevelName(math::SimdLevel::SCALAR));
+  EXPECT_EQ(std::string("sse2"), math::SimdLevelName(math::SimdLevel::SSE2));
+  EXPECT_EQ(std::string("avx"), math::SimdLevelName(math::SimdLevel::AVX));
+  EXPECT_EQ(std::string("avx2"), math::SimdLevelName(math::SimdLevel::AVX2));
+  EXPECT_EQ(std::string("avx512"),
+            math::SimdLevelName(math::SimdLevel::AVX512));
+  EXPECT_EQ(std::string("neon"), math::SimdLevelName(math::SimdLevel::NEON));
+  EXPECT_EQ(std::string("unknown"),
+            math::SimdLevelName(static_cast<math::SimdLevel>(42)));
+}
+
+/////////////////////////////////////////////////
+TEST(CpuFeaturesTest, Levels)
+{
+  const math::SimdLevel supported = math::SupportedSimdLevel();
+  const math::SimdLevel active = math::ActiveSimdLevel();
+  EXPECT_EQ(supported, math::SupportedSimdLevel());
+
+#if defined(__x86_64__) || defined(_M_X64)
+  // SSE2 is part of x86-64
+  EXPECT_NE(math::SimdLevel::SCALAR, supported);
+  EXPECT_NE(math::SimdLevel::NEON, supported);
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  EXPECT_EQ(math::SimdLevel::NEON, supported);
+#endif
+
+  // The scalar code and the supported instruction set can be selected
+  EXPECT_TRUE(math::SetActiveSimdLevel(math::SimdLevel::SCALAR));
+  EXPECT_EQ(math::SimdLevel::SCALAR, math::ActiveSimdLevel());
+  EXPECT_TRUE(math::SetActiveSimdLevel(supported));
+  EXPECT_EQ(supported, math::ActiveSimdLevel());
+
+  // Instruction sets of other architectures can't
+  if (supported == math::SimdLevel::NEON)
+  {
+    EXPECT_FALSE(math::SetActiveSimdLevel(math::SimdLevel::SSE2));
+  }
+  else
+  {
+    EXPECT_FALSE(math::SetActiveSimdLevel(math::SimdLevel::NEON));
+  }
+  EXPECT_EQ(supported, math::ActiveSimdLevel());
+  EXPECT_FALSE(math::SetActiveSimdLevel(static_cast<math::SimdLevel>(42)));
+
+  EXPECT_TRUE(math::SetActiveSimdLevel(active));
+}
@@ -17,8 +17,11 @@
 #include <gtest/gtest.h>
 #include <cmath>
 #include <iostream>
+#include <tuple>
+#include <vector>
 
 #include "gz/math/Cylinder.hh"
+#include "gz/math/Helpers.hh"
 
 using namespace gz;
 
@@ -138,3 +141,120 @@ TEST(CylinderTest, Mass)
   EXPECT_EQ(expectedMassMat, massMat);
   EXPECT_DOUBLE_EQ(expectedMassMat.Mass(), massMat.Mass());
 }
+
+//////////////////////////////////////////////////
+TEST(CylinderTest, Batch)
+{
+  const double lengths[] = {2.0, 0.1, 1.0};
+  const double radii[] = {0.5, 0.02, -1.0};
+  const double densities[] = {1000.0, 2.5, 1.0};
+  const double masses[] = {2.0, 3.0, 1.0};
+
+  double volumes[3];
+  double densitiesFromMass[3];
+  math::MassMatrix3d massMats[3];
+  math::Cylinderd::Volumes(lengths, radii, 3, volumes);
+  math::Cylinderd::DensitiesFromMasses(lengths, radii, masses, 3,
+                                       densitiesFromMass);
+  EXPECT_FALSE(math::Cylinderd::MassMatrices(lengths, radii, densities, 3,
+                                             massMats));
+  EXPECT_TRUE(math::Cylinderd::MassMatrices(lengths, radii, densities, 2,
+                                            massMats));
+
+  for (int i = 0; i < 3; ++i)
+  {
+    math::Cylinderd cylinder(lengths[i], radii[i],
+                             math::Material(densities[i]));
+    EXPECT_DOUBLE_EQ(cylinder.Volume(), volumes[i]);
+    EXPECT_DOUBLE_EQ(cylinder.DensityFromMass(masses[i]),
+                     densitiesFromMass[i]);
+
+    math::MassMatrix3d expected;
+    EXPECT_EQ(cylinder.MassMatrix(expected), massMats[i].Mass() > 0);
+    EXPECT_EQ(expected, massMats[i]);
+  }
+  EXPECT_DOUBLE_EQ(0.0, massMats[2].Mass());
+}
+
+/////////////////////////////////////////////////
+TEST(CylinderTest, IntersectDist)
+{
+  const math::Cylinderd cylinder(2.0, 1.0);
+  const math::Pose3d pose(0, 0, 1, 0, 0, 0);
+
+  // Cap and side.
+  auto [hit, dist] = cylinder.IntersectDist(pose, math::Vector3d(0.5, 0, 5),
+      -math::Vector3d::UnitZ, 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(3.0, dist);
+  std::tie(hit, dist) = cylinder.IntersectDist(pose,
+      math::Vector3d(5, 0, 1.5), -math::Vector3d::UnitX, 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(4.0, dist);
+
+  // Through the rim, at 45 degrees.
+  std::tie(hit, dist) = cylinder.IntersectDist(pose,
+      math::Vector3d(3, 0, 4), math::Vector3d(-1, 0, -1), 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_NEAR(2 * std::sqrt(2.0), dist, 1e-12);
+
+  // From the inside.
+  std::tie(hit, dist) = cylinder.IntersectDist(pose,
+      math::Vector3d(0, 0, 1), math::Vector3d::UnitY, 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(1.0, dist);
+
+  // Misses, including rays parallel to the axis.
+  EXPECT_FALSE(std::get<0>(cylinder.IntersectDist(pose,
+      math::Vector3d(1.1, 0, 5), -math::Vector3d::UnitZ, 0, 10)));
+  EXPECT_FALSE(std::get<0>(cylinder.IntersectDist(pose,
+      math::Vector3d(5, 0, 2.1), -math::Vector3d::UnitX, 0, 10)));
+
+  // The rotational offset turns the axis.
+  const math::Cylinderd lying(4.0, 1.0,
+      math::Quaterniond(0, IGN_PI / 2, 0));
+  std::tie(hit, dist) = lying.IntersectDist(math::Pose3d::Zero,
+      math::Vector3d(5, 0, 0), -math::Vector3d::UnitX, 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_NEAR(3.0, dist, 1e-12);
+  std::tie(hit, dist) = lying.IntersectDist(math::Pose3d::Zero,
+      math::Vector3d(1.5, 0, 5), -math::Vector3d::UnitZ, 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_NEAR(4.0, dist, 1e-12);
+}
+
+/////////////////////////////////////////////////
+TEST(CylinderTest, IntersectRays)
+{
+  const math::Cylinderd cylinder(1.0, 0.4,
+      math::Quaterniond(0.2, 0.3, 0));
+  const math::Pose3d pose(0, 2, 0.2, 0.3, -0.4, 0.5);
+  const math::Vector3d origin(0.1, -0.2, 0.3);
+
+  std::vector<math::Vector3d> dirs;
+  for (int i = 0; i < 40; ++i)
+  {
+    for (int j = 0; j < 20; ++j)
+    {
+      const double yaw = 1.0 + i * 0.03;
+      const double pitch = -0.6 + j * 0.06;
+      dirs.push_back(math::Vector3d(std::cos(pitch) * std::cos(yaw),
+          std::cos(pitch) * std::sin(yaw), std::sin(pitch)));
+    }
+  }
+
+  std::vector<double> ranges(dirs.size(), 10.0);
+  const std::size_t hits = cylinder.IntersectRays(pose, origin, dirs.data(),
+      dirs.size(), 0.0, ranges.data());
+  EXPECT_GT(hits, 0u);
+  EXPECT_LT(hits, dirs.size());
+
+  std::size_t singleHits = 0;
+  for (std::size_t i = 0; i < dirs.size(); ++i)
+  {
+    auto [hit, dist] = cylinder.IntersectDist(pose, origin, dirs[i], 0, 10);
+    singleHits += hit;
+    EXPECT_NEAR(hit ? dist : 10.0, ranges[i], 1e-9);
+  }
+  EXPECT_EQ(singleHits, hits);
+}
@@ -0,0 +1,395 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Dbscan.hh"
+#include "gz/math/PointGrid.hh"
+#include "gz/math/Trace.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Private data for Dbscan.
+class gz::math::DbscanPrivate
+{
+  /// \brief Radius of the neighborhood of a point.
+  public: double epsilon = 0.1;
+
+  /// \brief Minimum number of points in the neighborhood of a core point.
+  public: std::size_t minPoints = 5;
+
+  /// \brief Minimum number of points of a cluster.
+  public: std::size_t minClusterSize = 1;
+
+  /// \brief Maximum number of points of a cluster.
+  public: std::size_t maxClusterSize =
+      std::numeric_limits<std::size_t>::max();
+
+  /// \brief Number of threads, 0 for hardware threads.
+  public: unsigned int threadCount = 1;
+
+  /// \brief Executor used instead of threadCount threads, if set.
+  public: std::shared_ptr<Executor> executor;
+};
+
+namespace
+{
+  /// \brief Minimum number of points processed by each block.
+  const std::size_t kMinPointsPerBlock = 1024;
+
+  /// \brief Index of no point.
+  const std::size_t kNone = std::numeric_limits<std::size_t>::max();
+
+  //////////////////////////////////////////////////
+  /// \brief Get the executor running the blocks of points, and the number
+  /// of blocks. Without an executor set by the user, each thread
+  /// processes a single block.
+  /// \param[in] _data Clustering data.
+  /// \param[in] _count Number of points.
+  /// \param[out] _local Thread pool created for the call, if any.
+  /// \param[out] _blocks Number of blocks.
+  /// \return The executor.
+  Executor &BlockExecutor(const DbscanPrivate &_data,
+      const std::size_t _count, std::unique_ptr<Executor> &_local,
+      std::size_t &_blocks)
+  {
+    static SerialExecutor serial;
+
+    if (_data.executor)
+    {
+      _blocks = _data.executor->BlockCount(_count, kMinPointsPerBlock);
+      return *_data.executor;
+    }
+
+    std::size_t threads = _data.threadCount;
+    if (threads == 0)
+      threads = std::thread::hardware_concurrency();
+    _blocks = std::max<std::size_t>(1,
+        std::min(threads, _count / kMinPointsPerBlock));
+    if (_blocks <= 1)
+      return serial;
+    _local.reset(new ThreadPool(static_cast<unsigned int>(_blocks)));
+    return *_local;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Find the root of the set of an element, halving its path.
+  /// Each parent is lower than its child, and only ever decreases, which
+  /// keeps concurrent finds and unions consistent.
+  /// \param[in,out] _parents Parent of each element.
+  /// \param[in] _i The element.
+  /// \return The root, the lowest element of the set.
+  std::size_t Find(std::vector<std::atomic<std::size_t>> &_parents,
+                   std::size_t _i)
+  {
+    while (true)
+    {
+      std::size_t parent = _parents[_i].load();
+      if (parent == _i)
+        return _i;
+      const std::size_t grandparent = _parents[parent].load();
+      if (grandparent != parent)
+        _parents[_i].compare_exchange_weak(parent, grandparent);
+      _i = grandparent;
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Merge the sets of two elements, linking the higher root under
+  /// the lower one.
+  /// \param[in,out] _parents Parent of each element.
+  /// \param[in] _a First element.
+  /// \param[in] _b Second element.
+  void Unite(std::vector<std::atomic<std::size_t>> &_parents,
+             std::size_t _a, std::size_t _b)
+  {
+    while (true)
+    {
+      _a = Find(_parents, _a);
+      _b = Find(_parents, _b);
+      if (_a == _b)
+        return;
+      if (_a < _b)
+        std::swap(_a, _b);
+      // Fails if another thread linked _a in the meantime
+      std::size_t expected = _a;
+      if (_parents[_a].compare_exchange_strong(expected, _b))
+        return;
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Cluster points.
+  /// \param[in] _data Clustering data.
+  /// \param[in] _points The points.
+  /// \param[in] _minPoints Minimum number of points of a core point.
+  /// \param[out] _centroids Centroids of the clusters.
+  /// \param[out] _labels Label of each point.
+  /// \return False if there are no points or the epsilon is invalid.
+  bool Run(const DbscanPrivate &_data, const std::vector<Vector3d> &_points,
+           const std::size_t _minPoints, std::vector<Vector3d> &_centroids,
+           std::vector<unsigned int> &_labels)
+  {
+    IGN_MATH_TRACE_ZONE("Dbscan::Cluster");
+    if (_points.empty() || !(_data.epsilon > 0) ||
+        !std::isfinite(_data.epsilon))
+    {
+      return false;
+    }
+
+    const std::size_t count = _points.size();
+    std::unique_ptr<Executor> local;
+    std::size_t blocks = 1;
+    Executor &executor = BlockExecutor(_data, count, local, blocks);
+
+    PointGrid grid(2 * _data.epsilon);
+    grid.Build(_points, _data.executor ? _data.executor->Concurrency() :
+                                         _data.threadCount);
+
+    // Neighbors of each point, stored per block, with the neighbors of
+    // point i of a block at [offsets[i - begin], offsets[i - begin + 1]).
+    std::vector<std::vector<std::size_t>> offsets(blocks);
+    std::vector<std::vector<std::size_t>> neighbors(blocks);
+    std::vector<char> core(count, 0);
+    executor.ForEachBlock(count, blocks,
+      [&](const std::size_t _begin, const std::size_t _end,
+          const std::size_t _block)
+      {
+        std::vector<std::size_t> &blockOffsets = offsets[_block];
+        std::vector<std::size_t> &blockNeighbors = neighbors[_block];
+        blockOffsets.reserve(_end - _begin + 1);
+        std::vector<std::size_t> found;
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          blockOffsets.push_back(blockNeighbors.size());
+          if (!_points[i].IsFinite())
+            continue;
+          grid.Overlaps(_points[i], _data.epsilon, found);
+          core[i] = found.size() >= _minPoints;
+          blockNeighbors.insert(blockNeighbors.end(), found.begin(),
+                                found.end());
+        }
+        blockOffsets.push_back(blockNeighbors.size());
+      });
+
+    // Merge the core points with their core neighbors, and attach the
+    // other points to their lowest core neighbor.
+    std::vector<std::atomic<std::size_t>> parents(count);
+    for (std::size_t i = 0; i < count; ++i)
+      parents[i].store(i);
+    std::vector<std::size_t> attached(count, kNone);
+    executor.ForEachBlock(count, blocks,
+      [&](const std::size_t _begin, const std::size_t _end,
+          const std::size_t _block)
+      {
+        const std::vector<std::size_t> &blockOffsets = offsets[_block];
+        const std::vector<std::size_t> &blockNeighbors = neighbors[_block];
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const std::size_t first = blockOffsets[i - _begin];
+          const std::size_t last = blockOffsets[i - _begin + 1];
+          for (std::size_t k = first; k < last; ++k)
+          {
+            const std::size_t j = blockNeighbors[k];
+            if (!core[j])
+              continue;
+            if (core[i])
+            {
+              // Each pair is merged once, by its higher point
+              if (j < i)
+                Unite(parents, i, j);
+            }
+            else
+            {
+              attached[i] = std::min(attached[i], j);
+            }
+          }
+        }
+      });
+
+    // Number the clusters by their root, the lowest core point
+    std::vector<unsigned int> clusters(count, Dbscan::kNoise);
+    std::vector<std::size_t> sizes;
+    std::vector<std::size_t> roots(count, kNone);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      if (core[i])
+        roots[i] = Find(parents, i);
+      else if (attached[i] != kNone)
+        roots[i] = Find(parents, attached[i]);
+      else
+        continue;
+
+      if (roots[i] == i)
+      {
+        clusters[i] = static_cast<unsigned int>(sizes.size());
+        sizes.push_back(0);
+      }
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      if (roots[i] != kNone)
+        ++sizes[clusters[roots[i]]];
+    }
+
+    // Drop the clusters outside of the size limits
+    std::vector<unsigned int> renumbered(sizes.size(), Dbscan::kNoise);
+    unsigned int kept = 0;
+    for (std::size_t c = 0; c < sizes.size(); ++c)
+    {
+      if (sizes[c] >= _data.minClusterSize &&
+          sizes[c] <= _data.maxClusterSize)
+      {
+        renumbered[c] = kept++;
+      }
+    }
+
+    _labels.assign(count, Dbscan::kNoise);
+    _centroids.assign(kept, Vector3d::Zero);
+    std::vector<std::size_t> members(kept, 0);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      if (roots[i] == kNone)
+        continue;
+      const unsigned int label = renumbered[clusters[roots[i]]];
+      _labels[i] = label;
+      if (label == Dbscan::kNoise)
+        continue;
+      _centroids[label] += _points[i];
+      ++members[label];
+    }
+    for (unsigned int c = 0; c < kept; ++c)
+      _centroids[c] /= static_cast<double>(members[c]);
+    return true;
+  }
+}
+
+/////////////////////////////////////////////////
+Dbscan::Dbscan()
+  : dataPtr(std::make_unique<DbscanPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+Dbscan::Dbscan(const double _epsilon, const std::size_t _minPoints)
+  : Dbscan()
+{
+  this->dataPtr->epsilon = _epsilon;
+  this->dataPtr->minPoints = _minPoints;
+}
+
+/////////////////////////////////////////////////
+Dbscan::Dbscan(const Dbscan &_other)
+  : dataPtr(std::make_unique<DbscanPrivate>(*_other.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+Dbscan::~Dbscan() = default;
+
+/////////////////////////////////////////////////
+Dbscan &Dbscan::operator=(const Dbscan &_other)
+{
+  *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void Dbscan::SetEpsilon(const double _epsilon)
+{
+  this->dataPtr->epsilon = _epsilon;
+}
+
+/////////////////////////////////////////////////
+double Dbscan::Epsilon() const
+{
+  return this->dataPtr->epsilon;
+}
+
+/////////////////////////////////////////////////
+void Dbscan::SetMinPoints(const std::size_t _minPoints)
+{
+  this->dataPtr->minPoints = _minPoints;
+}
+
+/////////////////////////////////////////////////
+std::size_t Dbscan::MinPoints() const
+{
+  return this->dataPtr->minPoints;
+}
+
+/////////////////////////////////////////////////
+void Dbscan::SetClusterSizeLimits(const std::size_t _min,
+    const std::size_t _max)
+{
+  this->dataPtr->minClusterSize = _min;
+  this->dataPtr->maxClusterSize = _max;
+}
+
+/////////////////////////////////////////////////
+std::size_t Dbscan::MinClusterSize() const
+{
+  return this->dataPtr->minClusterSize;
+}
+
+/////////////////////////////////////////////////
+std::size_t Dbscan::MaxClusterSize() const
+{
+  return this->dataPtr->maxClusterSize;
+}
+
+/////////////////////////////////////////////////
+void Dbscan::SetThreadCount(const unsigned int _threads)
+{
+  this->dataPtr->threadCount = _threads;
+}
+
+/////////////////////////////////////////////////
+unsigned int Dbscan::ThreadCount() const
+{
+  return this->dataPtr->threadCount;
+}
+
+/////////////////////////////////////////////////
+void Dbscan::SetExecutor(std::shared_ptr<Executor> _executor)
+{
+  this->dataPtr->executor = std::move(_executor);
+}
+
+/////////////////////////////////////////////////
+bool Dbscan::Cluster(const std::vector<Vector3d> &_points,
+    std::vector<Vector3d> &_centroids,
+    std::vector<unsigned int> &_labels) const
+{
+  return Run(*this->dataPtr, _points, this->dataPtr->minPoints, _centroids,
+             _labels);
+}
+
+/////////////////////////////////////////////////
+bool Dbscan::EuclideanCluster(const std::vector<Vector3d> &_points,
+    std::vector<Vector3d> &_centroids,
+    std::vector<unsigned int> &_labels) const
+{
+  return Run(*this->dataPtr, _points, 1, _centroids, _labels);
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "gz/math/Dbscan.hh"
+#include "gz/math/Executor.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(DbscanTest, Defaults)
+{
+  Dbscan dbscan;
+  EXPECT_DOUBLE_EQ(0.1, dbscan.Epsilon());
+  EXPECT_EQ(5u, dbscan.MinPoints());
+  EXPECT_EQ(1u, dbscan.MinClusterSize());
+  EXPECT_EQ(std::numeric_limits<std::size_t>::max(),
+            dbscan.MaxClusterSize());
+  EXPECT_EQ(1u, dbscan.ThreadCount());
+
+  dbscan.SetEpsilon(0.5);
+  dbscan.SetMinPoints(3);
+  dbscan.SetClusterSizeLimits(10, 100);
+  dbscan.SetThreadCount(4);
+  EXPECT_DOUBLE_EQ(0.5, dbscan.Epsilon());
+  EXPECT_EQ(3u, dbscan.MinPoints());
+  EXPECT_EQ(10u, dbscan.MinClusterSize());
+  EXPECT_EQ(100u, dbscan.MaxClusterSize());
+  EXPECT_EQ(4u, dbscan.ThreadCount());
+
+  Dbscan copy(dbscan);
+  EXPECT_DOUBLE_EQ(0.5, copy.Epsilon());
+  Dbscan assigned(2.0, 7);
+  EXPECT_DOUBLE_EQ(2.0, assigned.Epsilon());
+  EXPECT_EQ(7u, assigned.MinPoints());
+  assigned = dbscan;
+  EXPECT_EQ(3u, assigned.MinPoints());
+
+  // Invalid input leaves the outputs unchanged
+  std::vector<Vector3d> centroids{Vector3d::UnitX};
+  std::vector<unsigned int> labels{4};
+  EXPECT_FALSE(dbscan.Cluster({}, centroids, labels));
+  dbscan.SetEpsilon(0);
+  EXPECT_FALSE(dbscan.Cluster({Vector3d::Zero}, centroids, labels));
+  dbscan.SetEpsilon(std::numeric_limits<double>::infinity());
+  EXPECT_FALSE(dbscan.EuclideanCluster({Vector3d::Zero}, centroids,
+                                       labels));
+  EXPECT_EQ(1u, centroids.size());
+  EXPECT_EQ(4u, labels[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(DbscanTest, CoreBorderNoise)
+{
+  // A line of points 0.1 apart, with core points where at least 3 points,
+  // including themselves, are within 0.15.
+  const std::vector<Vector3d> points{
+      Vector3d(0, 0, 0), Vector3d(0.1, 0, 0), Vector3d(0.2, 0, 0),
+      Vector3d(0.3, 0, 0),
+      // Far away pair: two points only, so no core point
+      Vector3d(5, 0, 0), Vector3d(5.1, 0, 0),
+      // Second cluster
+      Vector3d(0, 3, 0), Vector3d(0, 3.1, 0), Vector3d(0, 3.2, 0)};
+
+  Dbscan dbscan(0.15, 3);
+  std::vector<Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(dbscan.Cluster(points, centroids, labels));
+  ASSERT_EQ(2u, centroids.size());
+  const std::vector<unsigned int> expected{0, 0, 0, 0, Dbscan::kNoise,
+      Dbscan::kNoise, 1, 1, 1};
+  EXPECT_EQ(expected, labels);
+  EXPECT_EQ(Vector3d(0.15, 0, 0), centroids[0]);
+  EXPECT_EQ(Vector3d(0, 3.1, 0), centroids[1]);
+
+  // Euclidean clusters keep the pair
+  ASSERT_TRUE(dbscan.EuclideanCluster(points, centroids, labels));
+  ASSERT_EQ(3u, centroids.size());
+  const std::vector<unsigned int> euclidean{0, 0, 0, 0, 1, 1, 2, 2, 2};
+  EXPECT_EQ(euclidean, labels);
+  EXPECT_EQ(Vector3d(5.05, 0, 0), centroids[1]);
+
+  // Size limits drop the pair and the line of four
+  dbscan.SetClusterSizeLimits(3, 3);
+  ASSERT_TRUE(dbscan.EuclideanCluster(points, centroids, labels));
+  ASSERT_EQ(1u, centroids.size());
+  const std::vector<unsigned int> limited{Dbscan::kNoise, Dbscan::kNoise,
+      Dbscan::kNoise, Dbscan::kNoise, Dbscan::kNoise, Dbscan::kNoise,
+      0, 0, 0};
+  EXPECT_EQ(limited, labels);
+}
+
+/////////////////////////////////////////////////
+TEST(DbscanTest, BorderPoint)
+{
+  // The middle point is within reach of the core points of two clusters,
+  // but is not a core point itself; it joins the lowest one.
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 5; ++i)
+    points.push_back(Vector3d(0.01 * i, 0, 0));
+  for (int i = 0; i < 5; ++i)
+    points.push_back(Vector3d(2 - 0.01 * i, 0, 0));
+  points.push_back(Vector3d(1, 0, 0));
+
+  Dbscan dbscan(0.97, 6);
+  std::vector<Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(dbscan.Cluster(points, centroids, labels));
+  ASSERT_EQ(2u, centroids.size());
+  for (int i = 0; i < 5; ++i)
+  {
+    EXPECT_EQ(0u, labels[i]);
+    EXPECT_EQ(1u, labels[5 + i]);
+  }
+  EXPECT_EQ(0u, labels[10]);
+}
+
+/////////////////////////////////////////////////
+TEST(DbscanTest, NotFinite)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const std::vector<Vector3d> points{Vector3d(nan, 0, 0), Vector3d::Zero,
+      Vector3d(0.05, 0, 0)};
+  Dbscan dbscan;
+  std::vector<Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(dbscan.EuclideanCluster(points, centroids, labels));
+  ASSERT_EQ(1u, centroids.size());
+  const std::vector<unsigned int> expected{Dbscan::kNoise, 0, 0};
+  EXPECT_EQ(expected, labels);
+  EXPECT_EQ(Vector3d(0.025, 0, 0), centroids[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(DbscanTest, Blobs)
+{
+  // Gaussian blobs and uniform noise
+  Rand::Seed(31);
+  const std::vector<Vector3d> centers{Vector3d(0, 0, 0),
+      Vector3d(5, 0, 0), Vector3d(0, 5, 0), Vector3d(0, 0, 5)};
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 8000; ++i)
+  {
+    points.push_back(centers[i % 4] + Vector3d(Rand::DblNormal(0, 0.2),
+        Rand::DblNormal(0, 0.2), Rand::DblNormal(0, 0.2)));
+  }
+  for (int i = 0; i < 200; ++i)
+  {
+    points.push_back(Vector3d(Rand::DblUniform(-10, 15),
+        Rand::DblUniform(-10, 15), Rand::DblUniform(-10, 15)));
+  }
+
+  Dbscan dbscan(0.2, 10);
+  std::vector<Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(dbscan.Cluster(points, centroids, labels));
+  ASSERT_EQ(4u, centroids.size());
+  for (unsigned int c = 0; c < 4; ++c)
+    EXPECT_TRUE(centroids[c].Equal(centers[c], 0.05)) << c;
+  std::size_t noise = 0;
+  for (std::size_t i = 8000; i < points.size(); ++i)
+    noise += labels[i] == Dbscan::kNoise;
+  EXPECT_GT(noise, 190u);
+
+  // Same result with threads and executors
+  for (unsigned int threads : {0u, 4u})
+  {
+    std::vector<Vector3d> threadCentroids;
+    std::vector<unsigned int> threadLabels;
+    dbscan.SetThreadCount(threads);
+    ASSERT_TRUE(dbscan.Cluster(points, threadCentroids, threadLabels));
+    EXPECT_EQ(labels, threadLabels);
+    EXPECT_EQ(centroids, threadCentroids);
+  }
+  dbscan.SetExecutor(std::make_shared<ThreadPool>(3));
+  std::vector<Vector3d> poolCentroids;
+  std::vector<unsigned int> poolLabels;
+  ASSERT_TRUE(dbscan.Cluster(points, poolCentroids, poolLabels));
+  EXPECT_EQ(labels, poolLabels);
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gz/math/Diagnostics.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Nanoseconds in a rate limit window.
+  const int64_t kWindow = 1000000000;
+
+  /// \brief Handler and rate limit of the diagnostics.
+  struct DiagnosticState
+  {
+    /// \brief Handler, or null to write to std::cerr.
+    std::shared_ptr<const DiagnosticHandler> handler;
+
+    /// \brief Diagnostics reported per window.
+    std::atomic<unsigned int> limit{kDefaultDiagnosticRateLimit};
+
+    /// \brief Start of the current window, in nanoseconds.
+    std::atomic<int64_t> windowStart{0};
+
+    /// \brief Diagnostics acquired in the current window.
+    std::atomic<uint64_t> count{0};
+
+    /// \brief Diagnostics dropped in the current window.
+    std::atomic<uint64_t> dropped{0};
+  };
+
+  /// \brief Get the state of the diagnostics.
+  /// \return Reference to the state.
+  DiagnosticState &State()
+  {
+    static DiagnosticState state;
+    return state;
+  }
+
+  /// \brief Get the current time of the steady clock.
+  /// \return The time in nanoseconds.
+  int64_t Now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  /// \brief Pass a message to the handler.
+  /// \param[in] _message The message.
+  void Deliver(const std::string &_message)
+  {
+    const auto handler = std::atomic_load(&State().handler);
+    if (handler)
+      (*handler)(_message);
+    else
+      std::cerr << _message + "\n";
+  }
+}
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    /////////////////////////////////////////////
+    void SetDiagnosticHandler(DiagnosticHandler _handler)
+    {
+      std::shared_ptr<const DiagnosticHandler> handler;
+      if (_handler)
+      {
+        handler =
+            std::make_shared<const DiagnosticHandler>(std::move(_handler));
+      }
+      std::atomic_store(&State().handler, handler);
+    }
+
+    /////////////////////////////////////////////
+    void SetDiagnosticRateLimit(const unsigned int _limit)
+    {
+      State().limit.store(_limit, std::memory_order_relaxed);
+    }
+
+    /////////////////////////////////////////////
+    unsigned int DiagnosticRateLimit()
+    {
+      return State().limit.load(std::memory_order_relaxed);
+    }
+
+    /////////////////////////////////////////////
+    bool AcquireDiagnostic()
+    {
+      DiagnosticState &state = State();
+      const unsigned int limit = state.limit.load(std::memory_order_relaxed);
+      if (limit == 0)
+        return false;
+
+      // The first diagnostic of a window reports those dropped in the
+      // previous one.
+      const int64_t now = Now();
+      int64_t start = state.windowStart.load(std::memory_order_relaxed);
+      if (now - start >= kWindow &&
+          state.windowStart.compare_exchange_strong(
+              start, now, std::memory_order_relaxed))
+      {
+        state.count.store(0, std::memory_order_relaxed);
+        const uint64_t dropped =
+            state.dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
+        {
+          Deliver("[gz-math] " + std::to_string(dropped) +
+                  " diagnostics were dropped by the rate limit");
+        }
+      }
+
+      if (state.count.fetch_add(1, std::memory_order_relaxed) < limit)
+        return true;
+      state.dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    /////////////////////////////////////////////
+    void ReportDiagnostic(const std::string &_message)
+    {
+      Deliver(_message);
+    }
+    }
+  }
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/Kmeans.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Handler which keeps the diagnostics it receives.
+class DiagnosticsTest : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    math::SetDiagnosticHandler([this](const std::string &_message)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->messages.push_back(_message);
+    });
+  }
+
+  protected: void TearDown() override
+  {
+    math::SetDiagnosticHandler(nullptr);
+    math::SetDiagnosticRateLimit(math::kDefaultDiagnosticRateLimit);
+  }
+
+  /// \brief Wait for the start of a new rate limit window.
+  protected: void NewWindow()
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  }
+
+  /// \brief Protects the messages.
+  protected: std::mutex mutex;
+
+  /// \brief Messages received.
+  protected: std::vector<std::string> messages;
+};
+
+/////////////////////////////////////////////////
+TEST_F(DiagnosticsTest, Handler)
+{
+  math::SetDiagnosticRateLimit(1000);
+  EXPECT_EQ(1000u, math::DiagnosticRateLimit());
+
+  IGN_MATH_DIAGNOSTIC("Vertex [" << 3 << "] Not found");
+  ASSERT_EQ(1u, this->messages.size());
+  EXPECT_EQ("Vertex [3] Not found", this->messages[0]);
+
+  // The library reports through the handler
+  math::Kmeans kmeans(std::vector<math::Vector3d>{math::Vector3d::Zero});
+  EXPECT_FALSE(kmeans.Observations(std::vector<math::Vector3d>()));
+  ASSERT_EQ(2u, this->messages.size());
+  EXPECT_NE(std::string::npos, this->messages[1].find("Kmeans"));
+
+  // Without a handler, diagnostics go to std::cerr
+  math::SetDiagnosticHandler(nullptr);
+  IGN_MATH_DIAGNOSTIC("Reported to std::cerr");
+  EXPECT_EQ(2u, this->messages.size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(DiagnosticsTest, RateLimit)
+{
+  math::SetDiagnosticRateLimit(5);
+  this->NewWindow();
+
+  // Dropped diagnostics are not formatted
+  int formatted = 0;
+  for (int i = 0; i < 100; ++i)
+    IGN_MATH_DIAGNOSTIC("Diagnostic " << ++formatted);
+  EXPECT_EQ(5, formatted);
+  ASSERT_EQ(5u, this->messages.size());
+  EXPECT_EQ("Diagnostic 5", this->messages[4]);
+
+  // Their number is reported in the next window
+  this->NewWindow();
+  IGN_MATH_DIAGNOSTIC("Next window");
+  ASSERT_EQ(7u, this->messages.size());
+  EXPECT_NE(std::string::npos, this->messages[5].find("95 diagnostics"));
+  EXPECT_EQ("Next window", this->messages[6]);
+
+  // A limit of 0 drops every diagnostic
+  math::SetDiagnosticRateLimit(0);
+  for (int i = 0; i < 100; ++i)
+    IGN_MATH_DIAGNOSTIC("Diagnostic " << ++formatted);
+  EXPECT_EQ(5, formatted);
+  EXPECT_EQ(7u, this->messages.size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(DiagnosticsTest, Threads)
+{
+  math::SetDiagnosticRateLimit(100);
+  this->NewWindow();
+
+  // The limit holds over all threads
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([t]
+    {
+      for (int i = 0; i < 1000; ++i)
+        IGN_MATH_DIAGNOSTIC("Thread " << t << " diagnostic " << i);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  EXPECT_LE(100u, this->messages.size());
+  EXPECT_GE(201u, this->messages.size());
+}
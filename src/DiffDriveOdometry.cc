@@ -14,9 +14,11 @@
  * limitations under the License.
  *
 */
+#include <array>
 #include <cmath>
+#include <limits>
 #include "gz/math/DiffDriveOdometry.hh"
-#include "gz/math/RollingMean.hh"
+#include "OdometryVelocityMean.hh"
 
 using namespace gz;
 using namespace math;
@@ -37,6 +39,14 @@ class gz::math::DiffDriveOdometryPrivate
   /// \param[in] _angular Angular velocity.
   public: void IntegrateExact(double _linear, double _angular);
 
+  /// \brief Integrates the velocities (linear and angular) along an arc,
+  /// with the chord of the arc written as
+  /// linear * sinc(angular / 2) in the direction heading + angular / 2,
+  /// which has no cancellation for small angular velocities.
+  /// \param[in] _linear Linear velocity.
+  /// \param[in] _angular Angular velocity.
+  public: void IntegrateArc(double _linear, double _angular);
+
   /// \brief Current timestamp.
   public: clock::time_point lastUpdateTime;
 
@@ -70,11 +80,13 @@ class gz::math::DiffDriveOdometryPrivate
   /// \brief Previous right wheel position/state in radians.
   public: double rightWheelOldPos{0.0};
 
-  /// \brief Rolling mean accumulators for the linear velocity
-  public: RollingMean linearMean;
+  /// \brief Rolling mean accumulators for the linear and angular
+  /// velocities.
+  public: OdometryVelocityMean<2> velocityMean;
 
-  /// \brief Rolling mean accumulators for the angular velocity
-  public: RollingMean angularMean;
+  /// \brief Integration method.
+  public: DiffDriveOdometry::IntegrationType integration{
+    DiffDriveOdometry::HYBRID};
 
   /// \brief Initialized flag.
   public: bool initialized{false};
@@ -84,8 +96,7 @@ class gz::math::DiffDriveOdometryPrivate
 DiffDriveOdometry::DiffDriveOdometry(size_t _windowSize)
   : dataPtr(new DiffDriveOdometryPrivate)
 {
-  this->dataPtr->linearMean.SetWindowSize(_windowSize);
-  this->dataPtr->angularMean.SetWindowSize(_windowSize);
+  this->dataPtr->velocityMean.SetWindowSize(_windowSize);
 }
 
 //////////////////////////////////////////////////
@@ -97,8 +108,7 @@ DiffDriveOdometry::~DiffDriveOdometry()
 void DiffDriveOdometry::Init(const clock::time_point &_time)
 {
   // Reset accumulators and timestamp.
-  this->dataPtr->linearMean.Clear();
-  this->dataPtr->angularMean.Clear();
+  this->dataPtr->velocityMean.Clear();
   this->dataPtr->x = 0.0;
   this->dataPtr->y = 0.0;
   this->dataPtr->heading = 0.0;
@@ -145,7 +155,10 @@ bool DiffDriveOdometry::Update(const Angle &_leftPos, const Angle &_rightPos,
   const double angular = (rightWheelEstVel - leftWheelEstVel) /
     this->dataPtr->wheelSeparation;
 
-  this->dataPtr->IntegrateExact(linear, angular);
+  if (this->dataPtr->integration == EXACT_ARC)
+    this->dataPtr->IntegrateArc(linear, angular);
+  else
+    this->dataPtr->IntegrateExact(linear, angular);
 
   // We cannot estimate the speed if the time interval is zero (or near
   // zero).
@@ -155,11 +168,12 @@ bool DiffDriveOdometry::Update(const Angle &_leftPos, const Angle &_rightPos,
   this->dataPtr->lastUpdateTime = _time;
 
   // Estimate speeds using a rolling mean to filter them out:
-  this->dataPtr->linearMean.Push(linear / dt.count());
-  this->dataPtr->angularMean.Push(angular / dt.count());
+  std::array<double, 2> means;
+  this->dataPtr->velocityMean.Push(
+      {linear / dt.count(), angular / dt.count()}, means);
 
-  this->dataPtr->linearVel = this->dataPtr->linearMean.Mean();
-  this->dataPtr->angularVel = this->dataPtr->angularMean.Mean();
+  this->dataPtr->linearVel = means[0];
+  this->dataPtr->angularVel = means[1];
 
   return true;
 }
@@ -176,8 +190,19 @@ void DiffDriveOdometry::SetWheelParams(double _wheelSeparation,
 //////////////////////////////////////////////////
 void DiffDriveOdometry::SetVelocityRollingWindowSize(size_t _size)
 {
-  this->dataPtr->linearMean.SetWindowSize(_size);
-  this->dataPtr->angularMean.SetWindowSize(_size);
+  this->dataPtr->velocityMean.SetWindowSize(_size);
+}
+
+//////////////////////////////////////////////////
+void DiffDriveOdometry::SetIntegration(IntegrationType _integration)
+{
+  this->dataPtr->integration = _integration;
+}
+
+//////////////////////////////////////////////////
+DiffDriveOdometry::IntegrationType DiffDriveOdometry::Integration() const
+{
+  return this->dataPtr->integration;
 }
 
 //////////////////////////////////////////////////
@@ -239,3 +264,19 @@ void DiffDriveOdometryPrivate::IntegrateExact(double _linear, double _angular)
     this->y += -ratio * (std::cos(*this->heading) - std::cos(headingOld));
   }
 }
+
+//////////////////////////////////////////////////
+void DiffDriveOdometryPrivate::IntegrateArc(double _linear, double _angular)
+{
+  // The chord of an arc of length l turning by a is 2 l sin(a / 2) / a,
+  // in the direction of the heading halfway along the arc. sin(t) / t is
+  // accurate down to t = 0, unlike the difference of sines.
+  const double half = _angular * 0.5;
+  const double chord = std::abs(half) < std::numeric_limits<double>::min() ?
+    _linear : _linear * (std::sin(half) / half);
+  const double direction = *this->heading + half;
+
+  this->x += chord * std::cos(direction);
+  this->y += chord * std::sin(direction);
+  this->heading += _angular;
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/DiffDriveOdometryBank.hh"
+#include "gz/math/Helpers.hh"
+#include "OdometryBankState.hh"
+
+using namespace gz;
+using namespace math;
+
+//////////////////////////////////////////////////
+class gz::math::DiffDriveOdometryBankPrivate
+{
+  /// \brief Compute the displacements of every vehicle from the wheel
+  /// positions, as DiffDriveOdometry::Update does.
+  /// \param[in] _leftPos Left wheel positions in radians.
+  /// \param[in] _rightPos Right wheel positions in radians.
+  public: void Displacements(const double *_leftPos,
+                             const double *_rightPos)
+  {
+    const std::size_t n = this->wheelSeparation.size();
+    const double *sep = this->wheelSeparation.data();
+    const double *leftRadius = this->leftWheelRadius.data();
+    const double *rightRadius = this->rightWheelRadius.data();
+    double *leftOld = this->leftWheelOldPos.data();
+    double *rightOld = this->rightWheelOldPos.data();
+    double *linear = this->state.delta[0].data();
+    double *angular = this->state.delta[2].data();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      const double left = _leftPos[i] * leftRadius[i];
+      const double right = _rightPos[i] * rightRadius[i];
+      const double leftVel = left - leftOld[i];
+      const double rightVel = right - rightOld[i];
+      leftOld[i] = left;
+      rightOld[i] = right;
+      linear[i] = (rightVel + leftVel) * 0.5;
+      angular[i] = (rightVel - leftVel) / sep[i];
+    }
+  }
+
+  /// \brief Poses and velocities.
+  public: OdometryBankState state;
+
+  /// \brief Current timestamp.
+  public: clock::time_point lastUpdateTime;
+
+  /// \brief Left wheel radii in meters.
+  public: std::vector<double> leftWheelRadius;
+
+  /// \brief Right wheel radii in meters.
+  public: std::vector<double> rightWheelRadius;
+
+  /// \brief Wheel separations in meters.
+  public: std::vector<double> wheelSeparation;
+
+  /// \brief Previous left wheel positions in meters.
+  public: std::vector<double> leftWheelOldPos;
+
+  /// \brief Previous right wheel positions in meters.
+  public: std::vector<double> rightWheelOldPos;
+
+  /// \brief Initialized flag.
+  public: bool initialized{false};
+};
+
+//////////////////////////////////////////////////
+DiffDriveOdometryBank::DiffDriveOdometryBank(const std::size_t _size,
+    const std::size_t _windowSize)
+  : dataPtr(new DiffDriveOdometryBankPrivate)
+{
+  this->dataPtr->state.SetWindowSize(_windowSize);
+  this->Resize(_size);
+}
+
+//////////////////////////////////////////////////
+DiffDriveOdometryBank::DiffDriveOdometryBank(
+    const DiffDriveOdometryBank &_bank)
+  : dataPtr(new DiffDriveOdometryBankPrivate(*_bank.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+DiffDriveOdometryBank::~DiffDriveOdometryBank()
+{
+}
+
+//////////////////////////////////////////////////
+DiffDriveOdometryBank &DiffDriveOdometryBank::operator=(
+    const DiffDriveOdometryBank &_bank)
+{
+  *this->dataPtr = *_bank.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void DiffDriveOdometryBank::Resize(const std::size_t _size)
+{
+  this->dataPtr->state.Resize(_size);
+  this->dataPtr->leftWheelRadius.resize(_size, 0.0);
+  this->dataPtr->rightWheelRadius.resize(_size, 0.0);
+  this->dataPtr->wheelSeparation.resize(_size, 1.0);
+  this->dataPtr->leftWheelOldPos.resize(_size, 0.0);
+  this->dataPtr->rightWheelOldPos.resize(_size, 0.0);
+}
+
+//////////////////////////////////////////////////
+std::size_t DiffDriveOdometryBank::Size() const
+{
+  return this->dataPtr->wheelSeparation.size();
+}
+
+//////////////////////////////////////////////////
+void DiffDriveOdometryBank::Init(const clock::time_point &_time)
+{
+  // Reset accumulators and timestamp.
+  this->dataPtr->state.Reset();
+  std::fill(this->dataPtr->leftWheelOldPos.begin(),
+            this->dataPtr->leftWheelOldPos.end(), 0.0);
+  std::fill(this->dataPtr->rightWheelOldPos.begin(),
+            this->dataPtr->rightWheelOldPos.end(), 0.0);
+
+  this->dataPtr->lastUpdateTime = _time;
+  this->dataPtr->initialized = true;
+}
+
+//////////////////////////////////////////////////
+bool DiffDriveOdometryBank::Initialized() const
+{
+  return this->dataPtr->initialized;
+}
+
+//////////////////////////////////////////////////
+bool DiffDriveOdometryBank::Update(const std::vector<double> &_leftPos,
+    const std::vector<double> &_rightPos, const clock::time_point &_time)
+{
+  if (_leftPos.size() != this->Size() || _rightPos.size() != this->Size())
+  {
+    IGN_MATH_DIAGNOSTIC("DiffDriveOdometryBank::Update() error: got "
+        << _leftPos.size() << " left and " << _rightPos.size()
+        << " right wheel positions for " << this->Size()
+        << " vehicles.");
+    return false;
+  }
+
+  const std::chrono::duration<double> dt =
+    _time - this->dataPtr->lastUpdateTime;
+
+  this->dataPtr->Displacements(_leftPos.data(), _rightPos.data());
+  this->dataPtr->state.Integrate<false>();
+
+  // We cannot estimate the speed if the time interval is zero (or near
+  // zero).
+  if (equal(0.0, dt.count()))
+    return false;
+
+  this->dataPtr->lastUpdateTime = _time;
+  this->dataPtr->state.PushVelocities<false>(dt.count());
+  return true;
+}
+
+//////////////////////////////////////////////////
+void DiffDriveOdometryBank::SetWheelParams(double _wheelSeparation,
+    double _leftWheelRadius, double _rightWheelRadius)
+{
+  std::fill(this->dataPtr->wheelSeparation.begin(),
+            this->dataPtr->wheelSeparation.end(), _wheelSeparation);
+  std::fill(this->dataPtr->leftWheelRadius.begin(),
+            this->dataPtr->leftWheelRadius.end(), _leftWheelRadius);
+  std::fill(this->dataPtr->rightWheelRadius.begin(),
+            this->dataPtr->rightWheelRadius.end(), _rightWheelRadius);
+}
+
+//////////////////////////////////////////////////
+bool DiffDriveOdometryBank::SetWheelParams(const std::size_t _index,
+    double _wheelSeparation, double _leftWheelRadius,
+    double _rightWheelRadius)
+{
+  if (_index >= this->Size())
+    return false;
+
+  this->dataPtr->wheelSeparation[_index] = _wheelSeparation;
+  this->dataPtr->leftWheelRadius[_index] = _leftWheelRadius;
+  this->dataPtr->rightWheelRadius[_index] = _rightWheelRadius;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void DiffDriveOdometryBank::SetVelocityRollingWindowSize(size_t _size)
+{
+  this->dataPtr->state.SetWindowSize(_size);
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &DiffDriveOdometryBank::Heading() const
+{
+  return this->dataPtr->state.heading;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &DiffDriveOdometryBank::X() const
+{
+  return this->dataPtr->state.x;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &DiffDriveOdometryBank::Y() const
+{
+  return this->dataPtr->state.y;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &DiffDriveOdometryBank::LinearVelocity() const
+{
+  return this->dataPtr->state.velocity[0];
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &DiffDriveOdometryBank::AngularVelocity() const
+{
+  return this->dataPtr->state.velocity[2];
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "gz/math/DiffDriveOdometryBank.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(DiffDriveOdometryBankTest, Construct)
+{
+  math::DiffDriveOdometryBank empty;
+  EXPECT_EQ(0u, empty.Size());
+  EXPECT_FALSE(empty.Initialized());
+
+  math::DiffDriveOdometryBank odom(3);
+  EXPECT_EQ(3u, odom.Size());
+  EXPECT_EQ(3u, odom.X().size());
+  EXPECT_EQ(3u, odom.LinearVelocity().size());
+  odom.Resize(5);
+  EXPECT_EQ(5u, odom.Heading().size());
+  EXPECT_TRUE(odom.SetWheelParams(4, 1.0, 0.5, 0.5));
+  EXPECT_FALSE(odom.SetWheelParams(5, 1.0, 0.5, 0.5));
+
+  auto time = std::chrono::steady_clock::now();
+  odom.Init(time);
+  EXPECT_TRUE(odom.Initialized());
+  std::vector<double> pos(5, 1.0);
+  std::vector<double> shortPos(2, 1.0);
+  EXPECT_FALSE(odom.Update(shortPos, pos, time + std::chrono::seconds(1)));
+  EXPECT_FALSE(odom.Update(pos, shortPos, time + std::chrono::seconds(1)));
+  EXPECT_DOUBLE_EQ(0.0, odom.X()[4]);
+
+  // Zero time step updates the pose but not the velocities
+  EXPECT_FALSE(odom.Update(pos, pos, time));
+  EXPECT_DOUBLE_EQ(0.5, odom.X()[4]);
+  EXPECT_DOUBLE_EQ(0.0, odom.LinearVelocity()[4]);
+
+  // Copies are independent
+  math::DiffDriveOdometryBank copy(odom);
+  std::vector<double> pos2(5, 2.0);
+  EXPECT_TRUE(copy.Update(pos2, pos2, time + std::chrono::seconds(1)));
+  EXPECT_DOUBLE_EQ(1.0, copy.X()[4]);
+  EXPECT_DOUBLE_EQ(0.5, odom.X()[4]);
+  copy = odom;
+  EXPECT_DOUBLE_EQ(0.5, copy.X()[4]);
+}
+
+/////////////////////////////////////////////////
+TEST(DiffDriveOdometryBankTest, MatchesDiffDriveOdometry)
+{
+  const std::size_t n = 6;
+  const std::size_t windowSize = 4;
+  math::DiffDriveOdometryBank bank(n, windowSize);
+  bank.SetWheelParams(2.0, 0.5, 0.5);
+  std::vector<std::unique_ptr<math::DiffDriveOdometry>> odoms;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    odoms.emplace_back(new math::DiffDriveOdometry(windowSize));
+    odoms[i]->SetWheelParams(2.0, 0.5, 0.5);
+  }
+  // Per-vehicle wheel parameters
+  bank.SetWheelParams(1, 1.5, 0.3, 0.35);
+  odoms[1]->SetWheelParams(1.5, 0.3, 0.35);
+
+  auto time = std::chrono::steady_clock::now();
+  bank.Init(time);
+  for (auto &odom : odoms)
+    odom->Init(time);
+
+  std::vector<double> left(n, 0.0);
+  std::vector<double> right(n, 0.0);
+  for (int step = 0; step < 200; ++step)
+  {
+    if (step != 100)
+      time += std::chrono::milliseconds(10);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      // Vehicle 0 drives straight, the others turn at varying rates
+      left[i] += 0.1 + 0.01 * std::sin(step * 0.05 + i);
+      right[i] += i == 0 ? 0.1 + 0.01 * std::sin(step * 0.05) :
+          0.1 + 0.02 * std::cos(step * 0.07 * i);
+    }
+
+    const bool updated = bank.Update(left, right, time);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      EXPECT_EQ(odoms[i]->Update(math::Angle(left[i]),
+                                 math::Angle(right[i]), time), updated);
+      EXPECT_NEAR(odoms[i]->X(), bank.X()[i], 1e-9);
+      EXPECT_NEAR(odoms[i]->Y(), bank.Y()[i], 1e-9);
+      EXPECT_NEAR(*odoms[i]->Heading(), bank.Heading()[i], 1e-9);
+      EXPECT_NEAR(odoms[i]->LinearVelocity(), bank.LinearVelocity()[i],
+                  1e-9);
+      EXPECT_NEAR(*odoms[i]->AngularVelocity(),
+                  bank.AngularVelocity()[i], 1e-9);
+    }
+  }
+  EXPECT_NEAR(0.0, bank.Heading()[0], 1e-12);
+}
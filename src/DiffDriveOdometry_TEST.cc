@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
 #include <thread>
 
 #include "gz/math/Angle.hh"
@@ -123,3 +124,108 @@ TEST(DiffDriveOdometryTest, DiffDriveOdometry)
       ((xDistTraveled - yDistTraveled) / wheelSeparation) / 0.1,
       *odom.AngularVelocity(), 1e-3);
 }
+
+/////////////////////////////////////////////////
+TEST(DiffDriveOdometryTest, VelocityRollingWindowSize)
+{
+  // Wheel radius of 1, so that velocities are in radians per second
+  math::DiffDriveOdometry odom(2);
+  odom.SetWheelParams(2.0, 1.0, 1.0);
+  auto time = std::chrono::steady_clock::now();
+  odom.Init(time);
+
+  // The mean is over the last two updates
+  time += std::chrono::seconds(1);
+  odom.Update(math::Angle(1.0), math::Angle(1.0), time);
+  EXPECT_NEAR(1.0, odom.LinearVelocity(), 1e-9);
+  time += std::chrono::seconds(1);
+  odom.Update(math::Angle(4.0), math::Angle(4.0), time);
+  EXPECT_NEAR(2.0, odom.LinearVelocity(), 1e-9);
+  time += std::chrono::seconds(1);
+  odom.Update(math::Angle(9.0), math::Angle(9.0), time);
+  EXPECT_NEAR(4.0, odom.LinearVelocity(), 1e-9);
+
+  // Back to the default window, which clears the history
+  odom.SetVelocityRollingWindowSize(10);
+  time += std::chrono::seconds(1);
+  odom.Update(math::Angle(10.0), math::Angle(10.0), time);
+  EXPECT_NEAR(1.0, odom.LinearVelocity(), 1e-9);
+  time += std::chrono::seconds(1);
+  odom.Update(math::Angle(13.0), math::Angle(13.0), time);
+  EXPECT_NEAR(2.0, odom.LinearVelocity(), 1e-9);
+
+  // A zero window size is ignored
+  odom.SetVelocityRollingWindowSize(0);
+  time += std::chrono::seconds(1);
+  odom.Update(math::Angle(18.0), math::Angle(18.0), time);
+  EXPECT_NEAR(3.0, odom.LinearVelocity(), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(DiffDriveOdometryTest, ExactArcIntegration)
+{
+  math::DiffDriveOdometry odom;
+  EXPECT_EQ(math::DiffDriveOdometry::HYBRID, odom.Integration());
+  odom.SetIntegration(math::DiffDriveOdometry::EXACT_ARC);
+  EXPECT_EQ(math::DiffDriveOdometry::EXACT_ARC, odom.Integration());
+
+  // Constant wheel speeds of 1 and 1.5 rad/s with unit radii and
+  // separation: a circle of radius 2.5 at 1.25 m/s.
+  const double leftSpeed = 1.0;
+  const double rightSpeed = 1.5;
+  const double radius = 2.5;
+  const double omega = 0.5;
+
+  for (int rate : {500, 50, 5})
+  {
+    math::DiffDriveOdometry arc;
+    arc.SetIntegration(math::DiffDriveOdometry::EXACT_ARC);
+    arc.SetWheelParams(1.0, 1.0, 1.0);
+    auto time = std::chrono::steady_clock::time_point();
+    arc.Init(time);
+
+    // Integrate for 2 seconds
+    const int steps = 2 * rate;
+    for (int i = 1; i <= steps; ++i)
+    {
+      const double t = static_cast<double>(i) / rate;
+      EXPECT_TRUE(arc.Update(math::Angle(leftSpeed * t),
+                             math::Angle(rightSpeed * t),
+                             time + std::chrono::microseconds(
+                                 1000000 * i / rate)));
+    }
+    const double heading = omega * 2.0;
+    EXPECT_NEAR(heading, *arc.Heading(), 1e-12) << rate;
+    EXPECT_NEAR(radius * std::sin(heading), arc.X(), 1e-12) << rate;
+    EXPECT_NEAR(radius * (1 - std::cos(heading)), arc.Y(), 1e-12) << rate;
+    EXPECT_NEAR(radius * omega, arc.LinearVelocity(), 1e-9) << rate;
+  }
+
+  // Tiny heading changes, where the hybrid method switches to Runge-Kutta
+  math::DiffDriveOdometry hybrid;
+  odom.SetWheelParams(1.0, 1.0, 1.0);
+  hybrid.SetWheelParams(1.0, 1.0, 1.0);
+  auto time = std::chrono::steady_clock::time_point();
+  odom.Init(time);
+  hybrid.Init(time);
+  double left = 0.0;
+  double right = 0.0;
+  for (int i = 1; i <= 100; ++i)
+  {
+    left += 0.1;
+    right += 0.1 + (i % 2 ? 1e-7 : 1e-3);
+    time += std::chrono::milliseconds(10);
+    odom.Update(math::Angle(left), math::Angle(right), time);
+    hybrid.Update(math::Angle(left), math::Angle(right), time);
+    EXPECT_NEAR(hybrid.X(), odom.X(), 1e-12);
+    EXPECT_NEAR(hybrid.Y(), odom.Y(), 1e-12);
+    EXPECT_DOUBLE_EQ(*hybrid.Heading(), *odom.Heading());
+  }
+
+  // Straight line
+  odom.Init(time);
+  odom.Update(math::Angle(1.0), math::Angle(1.0),
+              time + std::chrono::seconds(1));
+  EXPECT_DOUBLE_EQ(1.0, odom.X());
+  EXPECT_DOUBLE_EQ(0.0, odom.Y());
+}
@@ -0,0 +1,624 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gz/math/DynamicAabbTree.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Null node index.
+  constexpr std::size_t kNull = DynamicAabbTree::kNull;
+
+  /// \brief Number of entries of the traversal stacks kept on the call
+  /// stack. A traversal needs one more entry than the height of the tree,
+  /// which is logarithmic in the number of boxes since the tree is
+  /// balanced, so larger stacks are only allocated for degenerate trees.
+  constexpr std::size_t kStackSize = 128;
+
+  /// \brief A node of the tree. Leaves hold the fat box of a proxy, and
+  /// internal nodes the union of the boxes of their two children. Free
+  /// nodes form a list through their parent index.
+  struct Node
+  {
+    /// \brief Check if the node is a leaf.
+    /// \return True if the node has no children.
+    bool IsLeaf() const
+    {
+      return this->child1 == kNull;
+    }
+
+    /// \brief Minimum corner of the box.
+    Vector3d min;
+
+    /// \brief Maximum corner of the box.
+    Vector3d max;
+
+    /// \brief Parent node, or next free node.
+    std::size_t parent = kNull;
+
+    /// \brief First child, kNull for a leaf.
+    std::size_t child1 = kNull;
+
+    /// \brief Second child, kNull for a leaf.
+    std::size_t child2 = kNull;
+
+    /// \brief Height of the subtree, 0 for a leaf and -1 for a free node.
+    int height = -1;
+  };
+
+  /// \brief Get the surface area of a box.
+  /// \param[in] _min Minimum corner.
+  /// \param[in] _max Maximum corner.
+  /// \return The surface area.
+  double Area(const Vector3d &_min, const Vector3d &_max)
+  {
+    const Vector3d d = _max - _min;
+    return 2.0 * (d.X() * d.Y() + d.Y() * d.Z() + d.Z() * d.X());
+  }
+
+  /// \brief Get the surface area of the union of two boxes.
+  /// \param[in] _a First box.
+  /// \param[in] _b Second box.
+  /// \return The surface area.
+  double UnionArea(const Node &_a, const Node &_b)
+  {
+    return Area(Vector3d(std::min(_a.min.X(), _b.min.X()),
+                         std::min(_a.min.Y(), _b.min.Y()),
+                         std::min(_a.min.Z(), _b.min.Z())),
+                Vector3d(std::max(_a.max.X(), _b.max.X()),
+                         std::max(_a.max.Y(), _b.max.Y()),
+                         std::max(_a.max.Z(), _b.max.Z())));
+  }
+
+  /// \brief Check if two boxes intersect, as AxisAlignedBox::Intersects.
+  /// \param[in] _aMin Minimum corner of the first box.
+  /// \param[in] _aMax Maximum corner of the first box.
+  /// \param[in] _bMin Minimum corner of the second box.
+  /// \param[in] _bMax Maximum corner of the second box.
+  /// \return True if the boxes intersect.
+  bool Intersects(const Vector3d &_aMin, const Vector3d &_aMax,
+                  const Vector3d &_bMin, const Vector3d &_bMax)
+  {
+    return !(_aMax.X() < _bMin.X() || _aMax.Y() < _bMin.Y() ||
+             _aMax.Z() < _bMin.Z() || _aMin.X() > _bMax.X() ||
+             _aMin.Y() > _bMax.Y() || _aMin.Z() > _bMax.Z());
+  }
+
+  /// \brief Check if a box is finite and not empty.
+  /// \param[in] _box Box to check.
+  /// \return True if the box is valid.
+  bool Valid(const AxisAlignedBox &_box)
+  {
+    return _box.Min().IsFinite() && _box.Max().IsFinite() &&
+           _box.Min().X() <= _box.Max().X() &&
+           _box.Min().Y() <= _box.Max().Y() &&
+           _box.Min().Z() <= _box.Max().Z();
+  }
+}
+
+/// \brief Private data for the DynamicAabbTree class. The structure
+/// follows the dynamic tree of Box2D.
+class gz::math::DynamicAabbTreePrivate
+{
+  /// \brief Take a node from the free list, or add one.
+  /// \return Index of the node. It invalidates references to nodes.
+  public: std::size_t Allocate()
+  {
+    std::size_t index;
+    if (this->freeList == kNull)
+    {
+      index = this->nodes.size();
+      this->nodes.emplace_back();
+    }
+    else
+    {
+      index = this->freeList;
+      this->freeList = this->nodes[index].parent;
+    }
+    Node &node = this->nodes[index];
+    node.parent = kNull;
+    node.child1 = kNull;
+    node.child2 = kNull;
+    node.height = 0;
+    return index;
+  }
+
+  /// \brief Return a node to the free list.
+  /// \param[in] _index Index of the node.
+  public: void Free(const std::size_t _index)
+  {
+    this->nodes[_index].parent = this->freeList;
+    this->nodes[_index].height = -1;
+    this->freeList = _index;
+  }
+
+  /// \brief Check if an index is the index of a leaf.
+  /// \param[in] _index Index to check.
+  /// \return True if _index is a leaf.
+  public: bool IsProxy(const std::size_t _index) const
+  {
+    return _index < this->nodes.size() && this->nodes[_index].height == 0;
+  }
+
+  /// \brief Set the box of a node to the union of its children's boxes,
+  /// and its height to one more than the height of the taller one.
+  /// \param[in] _index Index of the node.
+  public: void Refit(const std::size_t _index)
+  {
+    Node &node = this->nodes[_index];
+    const Node &a = this->nodes[node.child1];
+    const Node &b = this->nodes[node.child2];
+    node.min.Set(std::min(a.min.X(), b.min.X()),
+                 std::min(a.min.Y(), b.min.Y()),
+                 std::min(a.min.Z(), b.min.Z()));
+    node.max.Set(std::max(a.max.X(), b.max.X()),
+                 std::max(a.max.Y(), b.max.Y()),
+                 std::max(a.max.Z(), b.max.Z()));
+    node.height = 1 + std::max(a.height, b.height);
+  }
+
+  /// \brief Refit and balance the ancestors of a node up to the root.
+  /// \param[in] _index Index of the first ancestor.
+  public: void RefitAncestors(std::size_t _index)
+  {
+    while (_index != kNull)
+    {
+      _index = this->Balance(_index);
+      this->Refit(_index);
+      _index = this->nodes[_index].parent;
+    }
+  }
+
+  /// \brief Insert a leaf next to the sibling that increases the surface
+  /// area of the tree the least.
+  /// \param[in] _leaf Index of the leaf.
+  public: void InsertLeaf(const std::size_t _leaf)
+  {
+    if (this->root == kNull)
+    {
+      this->root = _leaf;
+      this->nodes[_leaf].parent = kNull;
+      return;
+    }
+
+    // Descend while creating a parent here costs more than pushing the
+    // leaf into one of the children.
+    std::size_t index = this->root;
+    while (!this->nodes[index].IsLeaf())
+    {
+      const Node &node = this->nodes[index];
+      const Node &leaf = this->nodes[_leaf];
+      const double area = Area(node.min, node.max);
+      const double combinedArea = UnionArea(node, leaf);
+      const double cost = 2.0 * combinedArea;
+      const double inheritanceCost = 2.0 * (combinedArea - area);
+
+      auto childCost = [&](const std::size_t _child)
+      {
+        const Node &child = this->nodes[_child];
+        const double grown = UnionArea(child, leaf);
+        return (child.IsLeaf() ? grown : grown - Area(child.min, child.max))
+               + inheritanceCost;
+      };
+      const double cost1 = childCost(node.child1);
+      const double cost2 = childCost(node.child2);
+
+      if (cost < cost1 && cost < cost2)
+        break;
+      index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const std::size_t sibling = index;
+    const std::size_t oldParent = this->nodes[sibling].parent;
+    const std::size_t newParent = this->Allocate();
+    this->nodes[newParent].parent = oldParent;
+    this->nodes[newParent].child1 = sibling;
+    this->nodes[newParent].child2 = _leaf;
+    this->nodes[sibling].parent = newParent;
+    this->nodes[_leaf].parent = newParent;
+    this->Refit(newParent);
+
+    if (oldParent == kNull)
+    {
+      this->root = newParent;
+    }
+    else if (this->nodes[oldParent].child1 == sibling)
+    {
+      this->nodes[oldParent].child1 = newParent;
+    }
+    else
+    {
+      this->nodes[oldParent].child2 = newParent;
+    }
+
+    this->RefitAncestors(oldParent);
+  }
+
+  /// \brief Detach a leaf from the tree, freeing its parent.
+  /// \param[in] _leaf Index of the leaf.
+  public: void RemoveLeaf(const std::size_t _leaf)
+  {
+    if (_leaf == this->root)
+    {
+      this->root = kNull;
+      return;
+    }
+
+    const std::size_t parent = this->nodes[_leaf].parent;
+    const std::size_t grandParent = this->nodes[parent].parent;
+    const std::size_t sibling = this->nodes[parent].child1 == _leaf ?
+      this->nodes[parent].child2 : this->nodes[parent].child1;
+
+    this->nodes[sibling].parent = grandParent;
+    this->Free(parent);
+    if (grandParent == kNull)
+    {
+      this->root = sibling;
+      return;
+    }
+
+    if (this->nodes[grandParent].child1 == parent)
+      this->nodes[grandParent].child1 = sibling;
+    else
+      this->nodes[grandParent].child2 = sibling;
+    this->RefitAncestors(grandParent);
+  }
+
+  /// \brief Rotate a node if the heights of its children differ by more
+  /// than one, promoting the taller child.
+  /// \param[in] _a Index of the node.
+  /// \return Index of the node that took the place of _a.
+  public: std::size_t Balance(const std::size_t _a)
+  {
+    Node &a = this->nodes[_a];
+    if (a.IsLeaf() || a.height < 2)
+      return _a;
+
+    const std::size_t b = a.child1;
+    const std::size_t c = a.child2;
+    const int balance = this->nodes[c].height - this->nodes[b].height;
+    if (balance > 1)
+      return this->Rotate(_a, c, false);
+    if (balance < -1)
+      return this->Rotate(_a, b, true);
+    return _a;
+  }
+
+  /// \brief Promote a child of a node, which becomes the parent of the
+  /// node. The taller child of the promoted node stays with it, and the
+  /// shorter one replaces it under the node.
+  /// \param[in] _a Index of the node.
+  /// \param[in] _up Index of the child to promote.
+  /// \param[in] _first True if _up is the first child of _a.
+  /// \return Index of the promoted node.
+  public: std::size_t Rotate(const std::size_t _a, const std::size_t _up,
+                             const bool _first)
+  {
+    const std::size_t f = this->nodes[_up].child1;
+    const std::size_t g = this->nodes[_up].child2;
+    const std::size_t parent = this->nodes[_a].parent;
+
+    this->nodes[_up].child1 = _a;
+    this->nodes[_up].parent = parent;
+    this->nodes[_a].parent = _up;
+    if (parent == kNull)
+      this->root = _up;
+    else if (this->nodes[parent].child1 == _a)
+      this->nodes[parent].child1 = _up;
+    else
+      this->nodes[parent].child2 = _up;
+
+    const bool keepF = this->nodes[f].height > this->nodes[g].height;
+    const std::size_t kept = keepF ? f : g;
+    const std::size_t moved = keepF ? g : f;
+    this->nodes[_up].child2 = kept;
+    if (_first)
+      this->nodes[_a].child1 = moved;
+    else
+      this->nodes[_a].child2 = moved;
+    this->nodes[moved].parent = _a;
+
+    this->Refit(_a);
+    this->Refit(_up);
+    return _up;
+  }
+
+  /// \brief Call a function for each leaf whose box intersects a box.
+  /// \param[in] _min Minimum corner of the box.
+  /// \param[in] _max Maximum corner of the box.
+  /// \param[in] _f Function called with the index of each leaf.
+  public: template<typename F>
+          void Query(const Vector3d &_min, const Vector3d &_max,
+                     F &&_f) const
+  {
+    if (this->root == kNull)
+      return;
+
+    std::size_t localStack[kStackSize];
+    std::vector<std::size_t> heapStack;
+    std::size_t *stack = localStack;
+    const auto height =
+      static_cast<std::size_t>(this->nodes[this->root].height);
+    if (height >= kStackSize)
+    {
+      heapStack.resize(height + 1);
+      stack = heapStack.data();
+    }
+
+    std::size_t top = 0;
+    stack[top++] = this->root;
+    while (top > 0)
+    {
+      const Node &node = this->nodes[stack[--top]];
+      if (!Intersects(node.min, node.max, _min, _max))
+        continue;
+
+      if (node.IsLeaf())
+      {
+        _f(static_cast<std::size_t>(&node - this->nodes.data()));
+      }
+      else
+      {
+        stack[top++] = node.child1;
+        stack[top++] = node.child2;
+      }
+    }
+  }
+
+  /// \brief Nodes, including free ones.
+  public: std::vector<Node> nodes;
+
+  /// \brief Index of the root, kNull if the tree is empty.
+  public: std::size_t root = kNull;
+
+  /// \brief First free node.
+  public: std::size_t freeList = kNull;
+
+  /// \brief Number of leaves.
+  public: std::size_t size = 0;
+
+  /// \brief Margin of the fat boxes.
+  public: double margin = 0.1;
+};
+
+/////////////////////////////////////////////////
+DynamicAabbTree::DynamicAabbTree()
+  : dataPtr(std::make_unique<DynamicAabbTreePrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+DynamicAabbTree::DynamicAabbTree(const double _margin)
+  : DynamicAabbTree()
+{
+  this->SetMargin(_margin);
+}
+
+/////////////////////////////////////////////////
+DynamicAabbTree::DynamicAabbTree(const DynamicAabbTree &_tree)
+  : dataPtr(std::make_unique<DynamicAabbTreePrivate>(*_tree.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+DynamicAabbTree::~DynamicAabbTree() = default;
+
+/////////////////////////////////////////////////
+DynamicAabbTree &DynamicAabbTree::operator=(const DynamicAabbTree &_tree)
+{
+  *this->dataPtr = *_tree.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+double DynamicAabbTree::Margin() const
+{
+  return this->dataPtr->margin;
+}
+
+/////////////////////////////////////////////////
+void DynamicAabbTree::SetMargin(const double _margin)
+{
+  this->dataPtr->margin = std::max(_margin, 0.0);
+}
+
+/////////////////////////////////////////////////
+std::size_t DynamicAabbTree::Insert(const AxisAlignedBox &_box)
+{
+  if (!Valid(_box))
+    return kNull;
+
+  auto &d = *this->dataPtr;
+  const std::size_t leaf = d.Allocate();
+  const Vector3d margin(d.margin, d.margin, d.margin);
+  d.nodes[leaf].min = _box.Min() - margin;
+  d.nodes[leaf].max = _box.Max() + margin;
+  d.InsertLeaf(leaf);
+  ++d.size;
+  return leaf;
+}
+
+/////////////////////////////////////////////////
+bool DynamicAabbTree::Remove(const std::size_t _id)
+{
+  auto &d = *this->dataPtr;
+  if (!d.IsProxy(_id))
+    return false;
+
+  d.RemoveLeaf(_id);
+  d.Free(_id);
+  --d.size;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool DynamicAabbTree::Move(const std::size_t _id, const AxisAlignedBox &_box,
+    const Vector3d &_displacement)
+{
+  auto &d = *this->dataPtr;
+  if (!d.IsProxy(_id) || !Valid(_box) || !_displacement.IsFinite())
+    return false;
+
+  Node &leaf = d.nodes[_id];
+  if (leaf.min.X() <= _box.Min().X() && leaf.min.Y() <= _box.Min().Y() &&
+      leaf.min.Z() <= _box.Min().Z() && _box.Max().X() <= leaf.max.X() &&
+      _box.Max().Y() <= leaf.max.Y() && _box.Max().Z() <= leaf.max.Z())
+  {
+    return false;
+  }
+
+  d.RemoveLeaf(_id);
+
+  const Vector3d margin(d.margin, d.margin, d.margin);
+  Vector3d min = _box.Min() - margin;
+  Vector3d max = _box.Max() + margin;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (_displacement[i] < 0)
+      min[i] += _displacement[i];
+    else
+      max[i] += _displacement[i];
+  }
+  leaf.min = min;
+  leaf.max = max;
+
+  d.InsertLeaf(_id);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void DynamicAabbTree::Clear()
+{
+  auto &d = *this->dataPtr;
+  d.nodes.clear();
+  d.root = kNull;
+  d.freeList = kNull;
+  d.size = 0;
+}
+
+/////////////////////////////////////////////////
+bool DynamicAabbTree::Contains(const std::size_t _id) const
+{
+  return this->dataPtr->IsProxy(_id);
+}
+
+/////////////////////////////////////////////////
+AxisAlignedBox DynamicAabbTree::FatBox(const std::size_t _id) const
+{
+  const auto &d = *this->dataPtr;
+  if (!d.IsProxy(_id))
+    return AxisAlignedBox();
+  return AxisAlignedBox(d.nodes[_id].min, d.nodes[_id].max);
+}
+
+/////////////////////////////////////////////////
+std::size_t DynamicAabbTree::Size() const
+{
+  return this->dataPtr->size;
+}
+
+/////////////////////////////////////////////////
+std::size_t DynamicAabbTree::Height() const
+{
+  const auto &d = *this->dataPtr;
+  if (d.root == kNull)
+    return 0;
+  return static_cast<std::size_t>(d.nodes[d.root].height);
+}
+
+/////////////////////////////////////////////////
+void DynamicAabbTree::Overlaps(const AxisAlignedBox &_box,
+    std::vector<std::size_t> &_ids) const
+{
+  _ids.clear();
+  this->dataPtr->Query(_box.Min(), _box.Max(),
+      [&](const std::size_t _leaf)
+      {
+        _ids.push_back(_leaf);
+      });
+}
+
+/////////////////////////////////////////////////
+void DynamicAabbTree::OverlappingPairs(
+    std::vector<std::pair<std::size_t, std::size_t>> &_pairs) const
+{
+  const auto &d = *this->dataPtr;
+  _pairs.clear();
+  if (d.root == kNull)
+    return;
+
+  // Traverse the tree against itself. An entry with a second node of
+  // kNull stands for the pairs within the subtree of the first node, and
+  // the other entries for the pairs between the subtrees of two nodes.
+  // Each level of the descent leaves at most four entries on the stack.
+  using Entry = std::pair<std::size_t, std::size_t>;
+  Entry localStack[4 * kStackSize];
+  std::vector<Entry> heapStack;
+  Entry *stack = localStack;
+  const auto height = static_cast<std::size_t>(d.nodes[d.root].height);
+  if (4 * height + 4 > 4 * kStackSize)
+  {
+    heapStack.resize(4 * height + 4);
+    stack = heapStack.data();
+  }
+
+  std::size_t top = 0;
+  stack[top++] = Entry(d.root, kNull);
+  while (top > 0)
+  {
+    const Entry entry = stack[--top];
+    const Node &a = d.nodes[entry.first];
+    if (entry.second == kNull)
+    {
+      if (!a.IsLeaf())
+      {
+        stack[top++] = Entry(a.child1, kNull);
+        stack[top++] = Entry(a.child2, kNull);
+        stack[top++] = Entry(a.child1, a.child2);
+      }
+      continue;
+    }
+
+    const Node &b = d.nodes[entry.second];
+    if (!Intersects(a.min, a.max, b.min, b.max))
+      continue;
+
+    if (a.IsLeaf() && b.IsLeaf())
+    {
+      _pairs.emplace_back(std::min(entry.first, entry.second),
+                          std::max(entry.first, entry.second));
+    }
+    // Split the larger box, to keep the boxes of the pairs similar.
+    else if (b.IsLeaf() ||
+             (!a.IsLeaf() && Area(a.min, a.max) > Area(b.min, b.max)))
+    {
+      stack[top++] = Entry(a.child1, entry.second);
+      stack[top++] = Entry(a.child2, entry.second);
+    }
+    else
+    {
+      stack[top++] = Entry(entry.first, b.child1);
+      stack[top++] = Entry(entry.first, b.child2);
+    }
+  }
+}
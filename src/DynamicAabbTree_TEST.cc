@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gz/math/DynamicAabbTree.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+using PairList = std::vector<std::pair<std::size_t, std::size_t>>;
+
+/////////////////////////////////////////////////
+/// \brief A random box with a center in [-_range, _range] and sides up to
+/// _size.
+static AxisAlignedBox RandomBox(const double _range, const double _size)
+{
+  const Vector3d center(Rand::DblUniform(-_range, _range),
+                        Rand::DblUniform(-_range, _range),
+                        Rand::DblUniform(-_range, _range));
+  const Vector3d half(Rand::DblUniform(0, _size / 2),
+                      Rand::DblUniform(0, _size / 2),
+                      Rand::DblUniform(0, _size / 2));
+  return AxisAlignedBox(center - half, center + half);
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the overlapping pairs of fat boxes by testing every pair.
+static PairList BruteForcePairs(const DynamicAabbTree &_tree,
+                                const std::vector<std::size_t> &_ids)
+{
+  PairList pairs;
+  for (std::size_t i = 0; i < _ids.size(); ++i)
+  {
+    for (std::size_t j = i + 1; j < _ids.size(); ++j)
+    {
+      if (_tree.FatBox(_ids[i]).Intersects(_tree.FatBox(_ids[j])))
+      {
+        pairs.emplace_back(std::min(_ids[i], _ids[j]),
+                           std::max(_ids[i], _ids[j]));
+      }
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
+/////////////////////////////////////////////////
+TEST(DynamicAabbTreeTest, Empty)
+{
+  DynamicAabbTree tree;
+  EXPECT_DOUBLE_EQ(0.1, tree.Margin());
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_EQ(0u, tree.Height());
+  EXPECT_FALSE(tree.Contains(0));
+  EXPECT_FALSE(tree.Remove(0));
+  EXPECT_FALSE(tree.Move(0, AxisAlignedBox(Vector3d::Zero, Vector3d::One)));
+
+  std::vector<std::size_t> ids = {3};
+  tree.Overlaps(AxisAlignedBox(-Vector3d::One, Vector3d::One), ids);
+  EXPECT_TRUE(ids.empty());
+
+  PairList pairs = {{1, 2}};
+  tree.OverlappingPairs(pairs);
+  EXPECT_TRUE(pairs.empty());
+
+  // Empty and non-finite boxes are rejected.
+  EXPECT_EQ(DynamicAabbTree::kNull, tree.Insert(AxisAlignedBox()));
+  const double inf = std::numeric_limits<double>::infinity();
+  EXPECT_EQ(DynamicAabbTree::kNull, tree.Insert(
+      AxisAlignedBox(Vector3d::Zero, Vector3d(inf, 1, 1))));
+  EXPECT_EQ(0u, tree.Size());
+
+  DynamicAabbTree negative(-1.0);
+  EXPECT_DOUBLE_EQ(0.0, negative.Margin());
+}
+
+/////////////////////////////////////////////////
+TEST(DynamicAabbTreeTest, Simple)
+{
+  DynamicAabbTree tree(0.5);
+  const std::size_t a = tree.Insert(
+      AxisAlignedBox(Vector3d(0, 0, 0), Vector3d(1, 1, 1)));
+  const std::size_t b = tree.Insert(
+      AxisAlignedBox(Vector3d(1.5, 0, 0), Vector3d(2.5, 1, 1)));
+  const std::size_t c = tree.Insert(
+      AxisAlignedBox(Vector3d(10, 0, 0), Vector3d(11, 1, 1)));
+  ASSERT_NE(DynamicAabbTree::kNull, a);
+  ASSERT_NE(DynamicAabbTree::kNull, b);
+  ASSERT_NE(DynamicAabbTree::kNull, c);
+  EXPECT_EQ(3u, tree.Size());
+  EXPECT_TRUE(tree.Contains(a));
+  EXPECT_EQ(AxisAlignedBox(Vector3d(-0.5, -0.5, -0.5),
+                           Vector3d(1.5, 1.5, 1.5)), tree.FatBox(a));
+
+  // The fat boxes of a and b touch.
+  PairList pairs;
+  tree.OverlappingPairs(pairs);
+  ASSERT_EQ(1u, pairs.size());
+  EXPECT_EQ(std::make_pair(std::min(a, b), std::max(a, b)), pairs[0]);
+
+  std::vector<std::size_t> ids;
+  tree.Overlaps(AxisAlignedBox(Vector3d(9, 0, 0), Vector3d(9.6, 1, 1)), ids);
+  ASSERT_EQ(1u, ids.size());
+  EXPECT_EQ(c, ids[0]);
+
+  // A small motion stays within the fat box.
+  EXPECT_FALSE(tree.Move(c,
+      AxisAlignedBox(Vector3d(10.4, 0, 0), Vector3d(11.4, 1, 1))));
+  EXPECT_EQ(AxisAlignedBox(Vector3d(9.5, -0.5, -0.5),
+                           Vector3d(11.5, 1.5, 1.5)), tree.FatBox(c));
+
+  // A larger one updates it, extended by the displacement.
+  EXPECT_TRUE(tree.Move(c,
+      AxisAlignedBox(Vector3d(2, 0, 0), Vector3d(3, 1, 1)),
+      Vector3d(-1, 0, 2)));
+  EXPECT_EQ(AxisAlignedBox(Vector3d(0.5, -0.5, -0.5),
+                           Vector3d(3.5, 1.5, 3.5)), tree.FatBox(c));
+  tree.OverlappingPairs(pairs);
+  EXPECT_EQ(3u, pairs.size());
+
+  EXPECT_TRUE(tree.Remove(b));
+  EXPECT_FALSE(tree.Remove(b));
+  EXPECT_FALSE(tree.Contains(b));
+  EXPECT_EQ(AxisAlignedBox(), tree.FatBox(b));
+  EXPECT_EQ(2u, tree.Size());
+  tree.OverlappingPairs(pairs);
+  ASSERT_EQ(1u, pairs.size());
+  EXPECT_EQ(std::make_pair(std::min(a, c), std::max(a, c)), pairs[0]);
+
+  // Ids are reused.
+  const std::size_t d = tree.Insert(
+      AxisAlignedBox(Vector3d(0, 0, 0), Vector3d(1, 1, 1)));
+  EXPECT_TRUE(tree.Contains(d));
+  EXPECT_EQ(3u, tree.Size());
+
+  // Copies are independent.
+  DynamicAabbTree copy(tree);
+  tree.Clear();
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_FALSE(tree.Contains(a));
+  EXPECT_EQ(3u, copy.Size());
+  copy.OverlappingPairs(pairs);
+  EXPECT_EQ(3u, pairs.size());
+
+  tree = copy;
+  EXPECT_EQ(3u, tree.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(DynamicAabbTreeTest, MatchesBruteForce)
+{
+  Rand::Seed(7);
+  DynamicAabbTree tree(0.05);
+  std::vector<std::size_t> ids;
+  std::vector<AxisAlignedBox> boxes;
+  for (int i = 0; i < 500; ++i)
+  {
+    boxes.push_back(RandomBox(10, 1));
+    ids.push_back(tree.Insert(boxes.back()));
+  }
+
+  // The tree stays balanced.
+  EXPECT_LE(tree.Height(), 2 * std::log2(500.0));
+
+  PairList pairs;
+  for (int step = 0; step < 20; ++step)
+  {
+    // Move every box, remove some and insert others.
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+      const Vector3d displacement(Rand::DblUniform(-0.2, 0.2),
+                                  Rand::DblUniform(-0.2, 0.2),
+                                  Rand::DblUniform(-0.2, 0.2));
+      boxes[i] = AxisAlignedBox(boxes[i].Min() + displacement,
+                                boxes[i].Max() + displacement);
+      tree.Move(ids[i], boxes[i], displacement);
+      EXPECT_TRUE(tree.FatBox(ids[i]).Contains(boxes[i].Min()));
+      EXPECT_TRUE(tree.FatBox(ids[i]).Contains(boxes[i].Max()));
+    }
+    for (int k = 0; k < 10; ++k)
+    {
+      const auto i = static_cast<std::size_t>(
+          Rand::IntUniform(0, static_cast<int>(ids.size()) - 1));
+      EXPECT_TRUE(tree.Remove(ids[i]));
+      boxes[i] = RandomBox(10, 1);
+      ids[i] = tree.Insert(boxes[i]);
+    }
+    ASSERT_EQ(ids.size(), tree.Size());
+
+    tree.OverlappingPairs(pairs);
+    std::sort(pairs.begin(), pairs.end());
+    EXPECT_EQ(BruteForcePairs(tree, ids), pairs);
+
+    const AxisAlignedBox query = RandomBox(10, 4);
+    std::vector<std::size_t> found;
+    tree.Overlaps(query, found);
+    std::sort(found.begin(), found.end());
+    std::vector<std::size_t> expected;
+    for (std::size_t id : ids)
+    {
+      if (tree.FatBox(id).Intersects(query))
+        expected.push_back(id);
+    }
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, found);
+  }
+  EXPECT_LE(tree.Height(), 2 * std::log2(500.0));
+
+  // Removing everything leaves an empty tree.
+  for (std::size_t id : ids)
+    EXPECT_TRUE(tree.Remove(id));
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_EQ(0u, tree.Height());
+  tree.OverlappingPairs(pairs);
+  EXPECT_TRUE(pairs.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(DynamicAabbTreeTest, SortedInsertions)
+{
+  // Boxes inserted along a line would make a list without rotations.
+  DynamicAabbTree tree(0.0);
+  for (int i = 0; i < 1024; ++i)
+  {
+    tree.Insert(AxisAlignedBox(Vector3d(i, 0, 0),
+                               Vector3d(i + 0.5, 0.5, 0.5)));
+  }
+  EXPECT_LE(tree.Height(), 20u);
+
+  PairList pairs;
+  tree.OverlappingPairs(pairs);
+  EXPECT_TRUE(pairs.empty());
+}
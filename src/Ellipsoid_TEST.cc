@@ -17,6 +17,8 @@
 #include <gtest/gtest.h>
 #include <cmath>
 #include <iostream>
+#include <tuple>
+#include <vector>
 
 #include "gz/math/Ellipsoid.hh"
 #include "gz/math/Helpers.hh"
@@ -145,3 +147,109 @@ TEST(EllipsoidTest, Mass)
   const math::Ellipsoidd ellipsoid5(math::Vector3d(-1, -1, 1));
   EXPECT_EQ(std::nullopt, ellipsoid5.MassMatrix());
 }
+
+//////////////////////////////////////////////////
+TEST(EllipsoidTest, Batch)
+{
+  const math::Vector3d radii[] = {
+    {1.0, 2.0, 3.0}, {0.1, 0.2, 0.3}, {2.0, 0.0, 1.0}};
+  const double densities[] = {1000.0, 2.5, 1.0};
+  const double masses[] = {2.0, 3.0, 1.0};
+
+  double volumes[3];
+  double densitiesFromMass[3];
+  math::MassMatrix3d massMats[3];
+  math::Ellipsoidd::Volumes(radii, 3, volumes);
+  math::Ellipsoidd::DensitiesFromMasses(radii, masses, 3, densitiesFromMass);
+  EXPECT_FALSE(math::Ellipsoidd::MassMatrices(radii, densities, 3,
+                                              massMats));
+  EXPECT_TRUE(math::Ellipsoidd::MassMatrices(radii, densities, 2, massMats));
+
+  for (int i = 0; i < 2; ++i)
+  {
+    math::Ellipsoidd ellipsoid(radii[i], math::Material(densities[i]));
+    EXPECT_DOUBLE_EQ(ellipsoid.Volume(), volumes[i]);
+    EXPECT_DOUBLE_EQ(ellipsoid.DensityFromMass(masses[i]),
+                     densitiesFromMass[i]);
+
+    auto expected = ellipsoid.MassMatrix();
+    ASSERT_NE(std::nullopt, expected);
+    EXPECT_EQ(*expected, massMats[i]);
+  }
+  EXPECT_TRUE(std::isnan(densitiesFromMass[2]));
+  EXPECT_DOUBLE_EQ(0.0, massMats[2].Mass());
+}
+
+/////////////////////////////////////////////////
+TEST(EllipsoidTest, IntersectDist)
+{
+  const math::Ellipsoidd ellipsoid(math::Vector3d(3, 2, 1));
+  const math::Pose3d pose(1, 0, 0, 0, 0, 0);
+
+  // Along each axis.
+  auto [hit, dist] = ellipsoid.IntersectDist(pose, math::Vector3d(11, 0, 0),
+      -math::Vector3d::UnitX, 0, 20);
+  EXPECT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(7.0, dist);
+  std::tie(hit, dist) = ellipsoid.IntersectDist(pose,
+      math::Vector3d(1, 10, 0), -math::Vector3d::UnitY, 0, 20);
+  EXPECT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(8.0, dist);
+  std::tie(hit, dist) = ellipsoid.IntersectDist(pose,
+      math::Vector3d(1, 0, -10), math::Vector3d::UnitZ, 0, 20);
+  EXPECT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(9.0, dist);
+
+  // The hit is on the surface.
+  const math::Vector3d origin(-4, 5, 2);
+  const math::Vector3d dir = (math::Vector3d(1, 0.5, 0) - origin).Normalize();
+  std::tie(hit, dist) = ellipsoid.IntersectDist(pose, origin, dir, 0, 20);
+  ASSERT_TRUE(hit);
+  const math::Vector3d point = origin + dir * dist - pose.Pos();
+  EXPECT_NEAR(1.0, (point / ellipsoid.Radii()).SquaredLength(), 1e-12);
+
+  // A rotation by the pose.
+  std::tie(hit, dist) = ellipsoid.IntersectDist(
+      math::Pose3d(0, 0, 0, 0, 0, IGN_PI / 2), math::Vector3d(0, 10, 0),
+      -math::Vector3d::UnitY, 0, 20);
+  EXPECT_TRUE(hit);
+  EXPECT_NEAR(7.0, dist, 1e-12);
+
+  EXPECT_FALSE(std::get<0>(ellipsoid.IntersectDist(pose,
+      math::Vector3d(1, 0, 1.1), math::Vector3d::UnitX, 0, 20)));
+}
+
+/////////////////////////////////////////////////
+TEST(EllipsoidTest, IntersectRays)
+{
+  const math::Ellipsoidd ellipsoid(math::Vector3d(0.5, 0.3, 0.2));
+  const math::Pose3d pose(2, 0.5, 0.2, 0.3, -0.4, 0.5);
+  const math::Vector3d origin(0.1, -0.2, 0.3);
+
+  std::vector<math::Vector3d> dirs;
+  for (int i = 0; i < 40; ++i)
+  {
+    for (int j = 0; j < 20; ++j)
+    {
+      const double yaw = -0.6 + i * 0.03;
+      const double pitch = -0.6 + j * 0.06;
+      dirs.push_back(math::Vector3d(std::cos(pitch) * std::cos(yaw),
+          std::cos(pitch) * std::sin(yaw), std::sin(pitch)));
+    }
+  }
+
+  std::vector<double> ranges(dirs.size(), 10.0);
+  const std::size_t hits = ellipsoid.IntersectRays(pose, origin,
+      dirs.data(), dirs.size(), 0.0, ranges.data());
+  EXPECT_GT(hits, 0u);
+  EXPECT_LT(hits, dirs.size());
+
+  std::size_t singleHits = 0;
+  for (std::size_t i = 0; i < dirs.size(); ++i)
+  {
+    auto [hit, dist] = ellipsoid.IntersectDist(pose, origin, dirs[i], 0, 10);
+    singleHits += hit;
+    EXPECT_NEAR(hit ? dist : 10.0, ranges[i], 1e-9);
+  }
+  EXPECT_EQ(singleHits, hits);
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Executor.hh"
+
+using namespace gz::math;
+
+namespace
+{
+  /// \brief Indices of a Run which are left to one thread, which other
+  /// threads may also take once their own range is done.
+  struct alignas(64) TaskRange
+  {
+    /// \brief Next index to take.
+    std::atomic<std::size_t> next{0};
+
+    /// \brief End of the range.
+    std::size_t end = 0;
+  };
+
+  /// \brief Pool whose task is running on the current thread, if any.
+  thread_local const void *tlsPool = nullptr;
+}
+
+/// \brief Private data of ThreadPool.
+class gz::math::ThreadPoolPrivate
+{
+  /// \brief Run the tasks of the current batch, starting with a range.
+  /// \param[in] _first Index of the range of the calling thread.
+  public: void Work(const std::size_t _first)
+  {
+    const std::size_t count = this->ranges.size();
+    for (std::size_t r = 0; r < count; ++r)
+    {
+      TaskRange &range = this->ranges[(_first + r) % count];
+      while (true)
+      {
+        const std::size_t i =
+            range.next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= range.end)
+          break;
+        (*this->task)(i);
+      }
+    }
+  }
+
+  /// \brief Loop of a worker thread.
+  /// \param[in] _index Index of the range of the worker.
+  public: void WorkerLoop(const std::size_t _index)
+  {
+    tlsPool = this;
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true)
+    {
+      this->wake.wait(lock, [&]
+      {
+        return this->stop || this->generation != seen;
+      });
+      if (this->stop)
+        return;
+      seen = this->generation;
+      if (this->task == nullptr)
+        continue;
+
+      ++this->active;
+      lock.unlock();
+      this->Work(_index);
+      lock.lock();
+      if (--this->active == 0)
+        this->done.notify_all();
+    }
+  }
+
+  /// \brief Worker threads.
+  public: std::vector<std::thread> workers;
+
+  /// \brief Held by the thread running a batch on the pool.
+  public: std::mutex runMutex;
+
+  /// \brief Protects the state below.
+  public: std::mutex mutex;
+
+  /// \brief Signals a new batch or the end of the pool to the workers.
+  public: std::condition_variable wake;
+
+  /// \brief Signals the end of the work of the workers.
+  public: std::condition_variable done;
+
+  /// \brief Number of batches started.
+  public: uint64_t generation = 0;
+
+  /// \brief Number of workers running tasks of the current batch.
+  public: std::size_t active = 0;
+
+  /// \brief Whether the workers should stop.
+  public: bool stop = false;
+
+  /// \brief Task of the current batch, or null between batches.
+  public: const std::function<void(std::size_t)> *task = nullptr;
+
+  /// \brief Ranges of the current batch, one per thread.
+  public: std::vector<TaskRange> ranges;
+};
+
+//////////////////////////////////////////////////
+Executor::~Executor()
+{
+}
+
+//////////////////////////////////////////////////
+unsigned int SerialExecutor::Concurrency() const
+{
+  return 1;
+}
+
+//////////////////////////////////////////////////
+void SerialExecutor::Run(const std::size_t _count,
+    const std::function<void(std::size_t)> &_task)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+    _task(i);
+}
+
+//////////////////////////////////////////////////
+ThreadPool::ThreadPool(const unsigned int _threads)
+  : dataPtr(new ThreadPoolPrivate)
+{
+  unsigned int threads = _threads;
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+
+  this->dataPtr->ranges = std::vector<TaskRange>(threads);
+  for (unsigned int t = 1; t < threads; ++t)
+  {
+    this->dataPtr->workers.emplace_back(
+        &ThreadPoolPrivate::WorkerLoop, this->dataPtr.get(), t);
+  }
+}
+
+//////////////////////////////////////////////////
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->wake.notify_all();
+  for (auto &worker : this->dataPtr->workers)
+    worker.join();
+}
+
+//////////////////////////////////////////////////
+unsigned int ThreadPool::Concurrency() const
+{
+  return static_cast<unsigned int>(this->dataPtr->workers.size() + 1);
+}
+
+//////////////////////////////////////////////////
+void ThreadPool::Run(const std::size_t _count,
+    const std::function<void(std::size_t)> &_task)
+{
+  auto &d = *this->dataPtr;
+
+  // Run on the calling thread rather than wait for, or add threads to, a
+  // busy pool.
+  std::unique_lock<std::mutex> running(d.runMutex, std::defer_lock);
+  if (_count <= 1 || d.workers.empty() || tlsPool == &d ||
+      !running.try_lock())
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+      _task(i);
+    return;
+  }
+
+  const std::size_t threads = d.ranges.size();
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    d.ranges[t].next.store(_count * t / threads, std::memory_order_relaxed);
+    d.ranges[t].end = _count * (t + 1) / threads;
+  }
+  {
+    std::lock_guard<std::mutex> lock(d.mutex);
+    d.task = &_task;
+    ++d.generation;
+  }
+  d.wake.notify_all();
+
+  const void *outerPool = tlsPool;
+  tlsPool = &d;
+  d.Work(0);
+  tlsPool = outerPool;
+
+  // Every index was taken, so the batch is over once the workers which
+  // joined it are done.
+  std::unique_lock<std::mutex> lock(d.mutex);
+  d.done.wait(lock, [&d] { return d.active == 0; });
+  d.task = nullptr;
+}
+
+//////////////////////////////////////////////////
+FunctionExecutor::FunctionExecutor(RunFunction _run,
+    const unsigned int _concurrency)
+  : run(std::move(_run)), concurrency(std::max(1u, _concurrency))
+{
+}
+
+//////////////////////////////////////////////////
+unsigned int FunctionExecutor::Concurrency() const
+{
+  return this->concurrency;
+}
+
+//////////////////////////////////////////////////
+void FunctionExecutor::Run(const std::size_t _count,
+    const std::function<void(std::size_t)> &_task)
+{
+  if (_count == 0)
+    return;
+  if (!this->run)
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+      _task(i);
+    return;
+  }
+  this->run(_count, _task);
+}
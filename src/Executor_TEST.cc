@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "gz/math/Executor.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Check that an executor calls a task once with every index.
+void ExpectEachIndexOnce(math::Executor &_executor, const std::size_t _count)
+{
+  std::vector<std::atomic<int>> calls(_count);
+  _executor.Run(_count, [&calls](std::size_t _i) { ++calls[_i]; });
+  for (std::size_t i = 0; i < _count; ++i)
+    EXPECT_EQ(1, calls[i].load()) << i;
+}
+
+/////////////////////////////////////////////////
+TEST(ExecutorTest, Serial)
+{
+  math::SerialExecutor executor;
+  EXPECT_EQ(1u, executor.Concurrency());
+  ExpectEachIndexOnce(executor, 0);
+  ExpectEachIndexOnce(executor, 100);
+
+  // Tasks run in order on the calling thread
+  std::vector<std::size_t> order;
+  executor.Run(5, [&order](std::size_t _i) { order.push_back(_i); });
+  EXPECT_EQ(std::vector<std::size_t>({0, 1, 2, 3, 4}), order);
+}
+
+/////////////////////////////////////////////////
+TEST(ExecutorTest, ThreadPool)
+{
+  math::ThreadPool pool(4);
+  EXPECT_EQ(4u, pool.Concurrency());
+  ExpectEachIndexOnce(pool, 0);
+  ExpectEachIndexOnce(pool, 1);
+  ExpectEachIndexOnce(pool, 3);
+  for (int r = 0; r < 20; ++r)
+    ExpectEachIndexOnce(pool, 10000);
+
+  math::ThreadPool hardware;
+  EXPECT_LE(1u, hardware.Concurrency());
+  ExpectEachIndexOnce(hardware, 1000);
+
+  math::ThreadPool single(1);
+  EXPECT_EQ(1u, single.Concurrency());
+  ExpectEachIndexOnce(single, 1000);
+}
+
+/////////////////////////////////////////////////
+TEST(ExecutorTest, ThreadPoolNested)
+{
+  // Runs from within a task of the pool run on the calling thread
+  math::ThreadPool pool(4);
+  std::vector<std::atomic<int>> calls(64 * 64);
+  pool.Run(64, [&](std::size_t _i)
+  {
+    const std::thread::id outer = std::this_thread::get_id();
+    pool.Run(64, [&](std::size_t _j)
+    {
+      EXPECT_EQ(outer, std::this_thread::get_id());
+      ++calls[_i * 64 + _j];
+    });
+  });
+  for (std::size_t i = 0; i < calls.size(); ++i)
+    EXPECT_EQ(1, calls[i].load()) << i;
+}
+
+/////////////////////////////////////////////////
+TEST(ExecutorTest, ThreadPoolConcurrentRuns)
+{
+  // Runs from several threads at once all complete
+  math::ThreadPool pool(3);
+  std::vector<std::thread> callers;
+  for (int c = 0; c < 4; ++c)
+  {
+    callers.emplace_back([&pool]
+    {
+      for (int r = 0; r < 50; ++r)
+        ExpectEachIndexOnce(pool, 1000);
+    });
+  }
+  for (auto &caller : callers)
+    caller.join();
+}
+
+/////////////////////////////////////////////////
+TEST(ExecutorTest, FunctionExecutor)
+{
+  std::size_t forwarded = 0;
+  math::FunctionExecutor executor(
+      [&forwarded](std::size_t _count,
+                   const std::function<void(std::size_t)> &_task)
+      {
+        forwarded += _count;
+        for (std::size_t i = _count; i > 0; --i)
+          _task(i - 1);
+      }, 8);
+  EXPECT_EQ(8u, executor.Concurrency());
+  ExpectEachIndexOnce(executor, 0);
+  EXPECT_EQ(0u, forwarded);
+  ExpectEachIndexOnce(executor, 100);
+  EXPECT_EQ(100u, forwarded);
+
+  // Without a function, tasks run on the calling thread
+  math::FunctionExecutor empty(nullptr, 0);
+  EXPECT_EQ(1u, empty.Concurrency());
+  ExpectEachIndexOnce(empty, 100);
+}
+
+/////////////////////////////////////////////////
+TEST(ExecutorTest, Blocks)
+{
+  math::SerialExecutor serial;
+  EXPECT_EQ(1u, serial.BlockCount(1000000, 10));
+
+  math::FunctionExecutor executor(nullptr, 4);
+  EXPECT_EQ(1u, executor.BlockCount(0, 100));
+  EXPECT_EQ(1u, executor.BlockCount(150, 100));
+  EXPECT_EQ(5u, executor.BlockCount(500, 100));
+  EXPECT_EQ(4u * math::Executor::kBlocksPerTask,
+            executor.BlockCount(1000000, 100));
+  EXPECT_EQ(4u * math::Executor::kBlocksPerTask,
+            executor.BlockCount(1000, 0));
+
+  // Blocks are contiguous, cover the range and have about the same size
+  for (const std::size_t blocks : {1u, 3u, 7u})
+  {
+    std::vector<std::size_t> begins(blocks);
+    std::vector<std::size_t> ends(blocks);
+    executor.ForEachBlock(100, blocks,
+      [&](std::size_t _begin, std::size_t _end, std::size_t _block)
+      {
+        begins[_block] = _begin;
+        ends[_block] = _end;
+      });
+    EXPECT_EQ(0u, begins.front());
+    EXPECT_EQ(100u, ends.back());
+    for (std::size_t b = 0; b < blocks; ++b)
+    {
+      if (b > 0)
+      {
+        EXPECT_EQ(ends[b - 1], begins[b]);
+      }
+      EXPECT_LE(100 / blocks, ends[b] - begins[b]);
+      EXPECT_GE(100 / blocks + 1, ends[b] - begins[b]);
+    }
+  }
+}
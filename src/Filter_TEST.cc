@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include "gz/math/Filter.hh"
 
 using namespace gz;
@@ -103,3 +106,125 @@ TEST(FilterTest, BiquadVector3)
   EXPECT_EQ(filterB.Process(math::Vector3d(0.1, 20.3, 33.45)),
             math::Vector3d(0.031748, 6.44475, 10.6196));
 }
+
+/////////////////////////////////////////////////
+TEST(FilterTest, OnePoleBank)
+{
+  math::OnePoleBank<double> empty;
+  EXPECT_EQ(0u, empty.Channels());
+  empty.Process(nullptr, nullptr, 10);
+
+  // Each channel matches a scalar filter exactly
+  const std::size_t channels = 5;
+  const std::size_t frames = 50;
+  math::OnePoleBank<double> bank(channels, 0.1, 0.2);
+  std::vector<math::OnePole<double>> filters(channels,
+      math::OnePole<double>(0.1, 0.2));
+  bank.FcChannel(2, 0.3, 1.4);
+  filters[2].Fc(0.3, 1.4);
+  bank.FcChannel(channels, 0.3, 1.4);
+  bank.SetChannel(4, 2.5);
+  filters[4].Set(2.5);
+  bank.SetChannel(channels, 2.5);
+
+  std::vector<double> input(channels * frames);
+  for (std::size_t i = 0; i < input.size(); ++i)
+    input[i] = std::sin(0.37 * i) + 0.01 * i;
+  std::vector<double> output(input.size());
+  bank.Process(input.data(), output.data(), frames);
+  for (std::size_t i = 0; i < frames; ++i)
+  {
+    for (std::size_t c = 0; c < channels; ++c)
+    {
+      EXPECT_DOUBLE_EQ(filters[c].Process(input[i * channels + c]),
+                       output[i * channels + c]);
+    }
+  }
+  for (std::size_t c = 0; c < channels; ++c)
+    EXPECT_DOUBLE_EQ(filters[c].Value(), bank.Value()[c]);
+
+  // Processing in place and frame by frame gives the same outputs
+  bank.Set(0.0);
+  std::vector<double> inPlace = input;
+  bank.Process(inPlace.data(), inPlace.data(), frames);
+  math::OnePoleBank<double> stepped(channels, 0.1, 0.2);
+  stepped.FcChannel(2, 0.3, 1.4);
+  std::vector<double> frame(channels);
+  for (std::size_t i = 0; i < frames; ++i)
+  {
+    stepped.Process(&input[i * channels], frame.data());
+    for (std::size_t c = 0; c < channels; ++c)
+      EXPECT_DOUBLE_EQ(inPlace[i * channels + c], frame[c]);
+  }
+
+  // Vector types are supported
+  math::OnePoleBank<math::Vector3d> vectors(2, 0.1, 0.2);
+  math::OnePoleVector3 vectorFilter(0.1, 0.2);
+  const math::Vector3d vectorInput[2] = {
+    math::Vector3d(0.1, 0.2, 0.3), math::Vector3d(0.1, 0.2, 0.3)};
+  math::Vector3d vectorOutput[2];
+  vectors.Process(vectorInput, vectorOutput);
+  EXPECT_EQ(vectorFilter.Process(vectorInput[0]), vectorOutput[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(FilterTest, BiquadBank)
+{
+  math::BiQuadBank<double> empty;
+  EXPECT_EQ(0u, empty.Channels());
+  empty.Process(nullptr, nullptr, 10);
+
+  // Each channel matches a scalar filter exactly
+  const std::size_t channels = 7;
+  const std::size_t frames = 50;
+  math::BiQuadBank<double> bank(channels, 4.3, 10.6);
+  std::vector<math::BiQuad<double>> filters(channels,
+      math::BiQuad<double>(4.3, 10.6));
+  bank.Fc(0.3, 1.4);
+  for (auto &filter : filters)
+    filter.Fc(0.3, 1.4);
+  bank.FcChannel(1, 0.3, 1.4, 0.1);
+  filters[1].Fc(0.3, 1.4, 0.1);
+  bank.FcChannel(3, 4.3, 10.6);
+  filters[3].Fc(4.3, 10.6);
+  bank.FcChannel(channels, 1.0, 10.0);
+  bank.SetChannel(5, 4.5);
+  filters[5].Set(4.5);
+  bank.SetChannel(channels, 4.5);
+
+  std::vector<double> input(channels * frames);
+  for (std::size_t i = 0; i < input.size(); ++i)
+    input[i] = std::cos(0.21 * i) - 0.02 * i;
+  std::vector<double> output(input.size());
+  bank.Process(input.data(), output.data(), frames);
+  for (std::size_t i = 0; i < frames; ++i)
+  {
+    for (std::size_t c = 0; c < channels; ++c)
+    {
+      EXPECT_DOUBLE_EQ(filters[c].Process(input[i * channels + c]),
+                       output[i * channels + c]);
+    }
+  }
+  for (std::size_t c = 0; c < channels; ++c)
+    EXPECT_DOUBLE_EQ(filters[c].Value(), bank.Value()[c]);
+
+  // Set resets the history
+  bank.Set(1.0);
+  filters[0].Set(1.0);
+  bank.Process(input.data(), output.data());
+  EXPECT_DOUBLE_EQ(filters[0].Process(input[0]), output[0]);
+
+  // Processing in place gives the same outputs
+  math::BiQuadBank<double> inPlaceBank(channels, 0.3, 1.4);
+  math::BiQuadBank<double> copyBank(channels, 0.3, 1.4);
+  std::vector<double> inPlace = input;
+  inPlaceBank.Process(inPlace.data(), inPlace.data(), frames);
+  copyBank.Process(input.data(), output.data(), frames);
+  EXPECT_EQ(output, inPlace);
+
+  // Resizing keeps the existing channels
+  copyBank.Resize(channels + 1);
+  EXPECT_EQ(channels + 1, copyBank.Channels());
+  EXPECT_DOUBLE_EQ(inPlaceBank.Value()[0], copyBank.Value()[0]);
+  EXPECT_DOUBLE_EQ(0.0, copyBank.Value()[channels]);
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/FrameTree.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Private data for the FrameTree class. Frames are stored in the
+/// order they were added, which is a topological order of the tree since
+/// a parent is always added before its children.
+///
+/// A frame whose world pose is not cached is dirty. All the descendants of
+/// a dirty frame are dirty as well, which lets invalidation stop at frames
+/// that are already dirty and lets queries stop at the first clean
+/// ancestor.
+class gz::math::FrameTreePrivate
+{
+  /// \brief Check if a frame index is valid.
+  /// \param[in] _frame Index of the frame.
+  /// \return True if _frame is less than the number of frames.
+  public: bool Valid(const std::size_t _frame) const
+  {
+    return _frame < this->names.size();
+  }
+
+  /// \brief Mark a frame and its descendants as dirty.
+  /// \param[in] _frame Index of the frame.
+  public: void Invalidate(const std::size_t _frame)
+  {
+    if (this->dirty[_frame])
+      return;
+
+    this->stack.clear();
+    this->stack.push_back(_frame);
+    while (!this->stack.empty())
+    {
+      const std::size_t frame = this->stack.back();
+      this->stack.pop_back();
+      this->dirty[frame] = 1;
+      for (const std::size_t child : this->children[frame])
+      {
+        if (!this->dirty[child])
+          this->stack.push_back(child);
+      }
+    }
+  }
+
+  /// \brief Compute the world pose of a dirty frame whose parent is clean
+  /// and mark it as clean.
+  /// \param[in] _frame Index of the frame.
+  public: void Compute(const std::size_t _frame)
+  {
+    const std::size_t parent = this->parents[_frame];
+    if (parent == FrameTree::kNoFrame)
+      this->world[_frame] = this->relative[_frame];
+    else
+      this->world[_frame] = this->world[parent] * this->relative[_frame];
+    this->dirty[_frame] = 0;
+  }
+
+  /// \brief Make sure the world pose of a frame is cached, computing the
+  /// frames between it and its closest clean ancestor.
+  /// \param[in] _frame Index of the frame.
+  public: void Resolve(const std::size_t _frame)
+  {
+    if (!this->dirty[_frame])
+      return;
+
+    this->stack.clear();
+    std::size_t frame = _frame;
+    while (frame != FrameTree::kNoFrame && this->dirty[frame])
+    {
+      this->stack.push_back(frame);
+      frame = this->parents[frame];
+    }
+    for (auto it = this->stack.rbegin(); it != this->stack.rend(); ++it)
+      this->Compute(*it);
+  }
+
+  /// \brief Name of each frame.
+  public: std::vector<std::string> names;
+
+  /// \brief Parent of each frame, kNoFrame for frames relative to the
+  /// world.
+  public: std::vector<std::size_t> parents;
+
+  /// \brief Children of each frame.
+  public: std::vector<std::vector<std::size_t>> children;
+
+  /// \brief Pose of each frame relative to its parent.
+  public: std::vector<Pose3d> relative;
+
+  /// \brief Cached world pose of each frame, valid if the frame is not
+  /// dirty.
+  public: std::vector<Pose3d> world;
+
+  /// \brief Nonzero for the frames whose world pose is not cached.
+  public: std::vector<char> dirty;
+
+  /// \brief Index of each frame name.
+  public: std::unordered_map<std::string, std::size_t> index;
+
+  /// \brief Scratch stack reused by Invalidate() and Resolve().
+  public: std::vector<std::size_t> stack;
+};
+
+namespace
+{
+  /// \brief Returned by Name() for invalid frames.
+  const std::string kEmptyName;
+
+  /// \brief Returned by Children() for invalid frames.
+  const std::vector<std::size_t> kNoChildren;
+}
+
+/////////////////////////////////////////////////
+FrameTree::FrameTree()
+  : dataPtr(std::make_unique<FrameTreePrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+FrameTree::FrameTree(const FrameTree &_tree)
+  : dataPtr(std::make_unique<FrameTreePrivate>(*_tree.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+FrameTree::~FrameTree() = default;
+
+/////////////////////////////////////////////////
+FrameTree &FrameTree::operator=(const FrameTree &_tree)
+{
+  *this->dataPtr = *_tree.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+std::size_t FrameTree::AddFrame(const std::string &_name,
+    const std::size_t _parent, const Pose3d &_pose)
+{
+  auto &d = *this->dataPtr;
+  if (_parent != kNoFrame && !d.Valid(_parent))
+  {
+    IGN_MATH_DIAGNOSTIC("FrameTree::AddFrame() error: parent [" << _parent
+        << "] of frame [" << _name << "] does not exist.");
+    return kNoFrame;
+  }
+
+  const std::size_t frame = d.names.size();
+  if (!d.index.emplace(_name, frame).second)
+  {
+    IGN_MATH_DIAGNOSTIC("FrameTree::AddFrame() error: frame [" << _name
+        << "] already exists.");
+    return kNoFrame;
+  }
+
+  d.names.push_back(_name);
+  d.parents.push_back(_parent);
+  d.children.emplace_back();
+  d.relative.push_back(_pose);
+  d.world.push_back(Pose3d::Zero);
+  d.dirty.push_back(1);
+  if (_parent != kNoFrame)
+    d.children[_parent].push_back(frame);
+  return frame;
+}
+
+/////////////////////////////////////////////////
+std::size_t FrameTree::FrameCount() const
+{
+  return this->dataPtr->names.size();
+}
+
+/////////////////////////////////////////////////
+void FrameTree::Clear()
+{
+  *this->dataPtr = FrameTreePrivate();
+}
+
+/////////////////////////////////////////////////
+std::size_t FrameTree::FrameIndex(const std::string &_name) const
+{
+  const auto it = this->dataPtr->index.find(_name);
+  return it == this->dataPtr->index.end() ? kNoFrame : it->second;
+}
+
+/////////////////////////////////////////////////
+const std::string &FrameTree::Name(const std::size_t _frame) const
+{
+  if (!this->dataPtr->Valid(_frame))
+    return kEmptyName;
+  return this->dataPtr->names[_frame];
+}
+
+/////////////////////////////////////////////////
+std::size_t FrameTree::Parent(const std::size_t _frame) const
+{
+  if (!this->dataPtr->Valid(_frame))
+    return kNoFrame;
+  return this->dataPtr->parents[_frame];
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::size_t> &FrameTree::Children(
+    const std::size_t _frame) const
+{
+  if (!this->dataPtr->Valid(_frame))
+    return kNoChildren;
+  return this->dataPtr->children[_frame];
+}
+
+/////////////////////////////////////////////////
+bool FrameTree::SetRelativePose(const std::size_t _frame,
+    const Pose3d &_pose)
+{
+  auto &d = *this->dataPtr;
+  if (!d.Valid(_frame))
+    return false;
+
+  d.relative[_frame] = _pose;
+  d.Invalidate(_frame);
+  return true;
+}
+
+/////////////////////////////////////////////////
+const Pose3d &FrameTree::RelativePose(const std::size_t _frame) const
+{
+  if (!this->dataPtr->Valid(_frame))
+    return Pose3d::Zero;
+  return this->dataPtr->relative[_frame];
+}
+
+/////////////////////////////////////////////////
+const Pose3d &FrameTree::WorldPose(const std::size_t _frame) const
+{
+  auto &d = *this->dataPtr;
+  if (!d.Valid(_frame))
+    return Pose3d::Zero;
+
+  d.Resolve(_frame);
+  return d.world[_frame];
+}
+
+/////////////////////////////////////////////////
+void FrameTree::WorldPoses(const std::vector<std::size_t> &_frames,
+    std::vector<Pose3d> &_poses) const
+{
+  _poses.resize(_frames.size());
+  for (std::size_t i = 0; i < _frames.size(); ++i)
+    _poses[i] = this->WorldPose(_frames[i]);
+}
+
+/////////////////////////////////////////////////
+Pose3d FrameTree::PoseInFrame(const std::size_t _frame,
+    const std::size_t _base) const
+{
+  auto &d = *this->dataPtr;
+  if (!d.Valid(_frame) || (_base != kNoFrame && !d.Valid(_base)))
+    return Pose3d::Zero;
+
+  if (_base == kNoFrame)
+    return this->WorldPose(_frame);
+  return this->WorldPose(_base).Inverse() * this->WorldPose(_frame);
+}
+
+/////////////////////////////////////////////////
+void FrameTree::UpdateWorldPoses()
+{
+  auto &d = *this->dataPtr;
+  for (std::size_t i = 0; i < d.names.size(); ++i)
+  {
+    if (d.dirty[i])
+      d.Compute(i);
+  }
+}
+
+/////////////////////////////////////////////////
+bool FrameTree::WorldPoseCached(const std::size_t _frame) const
+{
+  return this->dataPtr->Valid(_frame) && !this->dataPtr->dirty[_frame];
+}
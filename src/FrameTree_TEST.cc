@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "gz/math/FrameTree.hh"
+
+using namespace gz;
+
+/// \brief Build world <- base <- link1 <- sensor, base <- link2, and a
+/// second root frame.
+static math::FrameTree TestTree()
+{
+  math::FrameTree tree;
+  const std::size_t base = tree.AddFrame("base", math::FrameTree::kNoFrame,
+      math::Pose3d(1, 0, 0, 0, 0, 0.5));
+  const std::size_t link1 = tree.AddFrame("link1", base,
+      math::Pose3d(0, 1, 0, 0.2, 0, 0));
+  tree.AddFrame("sensor", link1, math::Pose3d(0, 0, 0.5, 0, 0.3, 0));
+  tree.AddFrame("link2", base, math::Pose3d(0, -1, 0, 0, 0, -0.4));
+  tree.AddFrame("other", math::FrameTree::kNoFrame,
+      math::Pose3d(5, 5, 5, 0, 0, 0));
+  return tree;
+}
+
+/////////////////////////////////////////////////
+TEST(FrameTreeTest, Construct)
+{
+  math::FrameTree empty;
+  EXPECT_EQ(0u, empty.FrameCount());
+  EXPECT_EQ(math::FrameTree::kNoFrame, empty.FrameIndex("base"));
+
+  math::FrameTree tree = TestTree();
+  EXPECT_EQ(5u, tree.FrameCount());
+  const std::size_t base = tree.FrameIndex("base");
+  const std::size_t link1 = tree.FrameIndex("link1");
+  const std::size_t sensor = tree.FrameIndex("sensor");
+  const std::size_t link2 = tree.FrameIndex("link2");
+  EXPECT_EQ(0u, base);
+  EXPECT_EQ("sensor", tree.Name(sensor));
+  EXPECT_EQ(math::FrameTree::kNoFrame, tree.Parent(base));
+  EXPECT_EQ(link1, tree.Parent(sensor));
+  EXPECT_EQ((std::vector<std::size_t>{link1, link2}), tree.Children(base));
+  EXPECT_EQ(math::Pose3d(0, 1, 0, 0.2, 0, 0), tree.RelativePose(link1));
+
+  // Errors
+  EXPECT_EQ(math::FrameTree::kNoFrame,
+      tree.AddFrame("base", math::FrameTree::kNoFrame, math::Pose3d::Zero));
+  EXPECT_EQ(math::FrameTree::kNoFrame,
+      tree.AddFrame("new", 42, math::Pose3d::Zero));
+  EXPECT_EQ(5u, tree.FrameCount());
+  EXPECT_EQ("", tree.Name(42));
+  EXPECT_EQ(math::FrameTree::kNoFrame, tree.Parent(42));
+  EXPECT_TRUE(tree.Children(42).empty());
+  EXPECT_FALSE(tree.SetRelativePose(42, math::Pose3d::Zero));
+  EXPECT_EQ(math::Pose3d::Zero, tree.RelativePose(42));
+  EXPECT_EQ(math::Pose3d::Zero, tree.WorldPose(42));
+  EXPECT_FALSE(tree.WorldPoseCached(42));
+
+  // Copies are independent
+  math::FrameTree copy(tree);
+  copy.SetRelativePose(base, math::Pose3d(9, 9, 9, 0, 0, 0));
+  EXPECT_NE(copy.WorldPose(sensor), tree.WorldPose(sensor));
+  copy = tree;
+  EXPECT_EQ(copy.WorldPose(sensor), tree.WorldPose(sensor));
+
+  tree.Clear();
+  EXPECT_EQ(0u, tree.FrameCount());
+  EXPECT_EQ(math::FrameTree::kNoFrame, tree.FrameIndex("base"));
+}
+
+/////////////////////////////////////////////////
+TEST(FrameTreeTest, WorldPose)
+{
+  math::FrameTree tree = TestTree();
+  const std::size_t base = tree.FrameIndex("base");
+  const std::size_t link1 = tree.FrameIndex("link1");
+  const std::size_t sensor = tree.FrameIndex("sensor");
+  const std::size_t link2 = tree.FrameIndex("link2");
+  const std::size_t other = tree.FrameIndex("other");
+
+  const math::Pose3d expected = tree.RelativePose(base) *
+      tree.RelativePose(link1) * tree.RelativePose(sensor);
+  for (std::size_t i = 0; i < tree.FrameCount(); ++i)
+    EXPECT_FALSE(tree.WorldPoseCached(i));
+
+  // Only the path to the queried frame is computed
+  EXPECT_EQ(expected, tree.WorldPose(sensor));
+  EXPECT_TRUE(tree.WorldPoseCached(base));
+  EXPECT_TRUE(tree.WorldPoseCached(link1));
+  EXPECT_TRUE(tree.WorldPoseCached(sensor));
+  EXPECT_FALSE(tree.WorldPoseCached(link2));
+  EXPECT_FALSE(tree.WorldPoseCached(other));
+
+  EXPECT_EQ(tree.RelativePose(other), tree.WorldPose(other));
+
+  // Check a point against the explicit chain of transforms
+  const math::Vector3d p(0.3, -0.2, 0.1);
+  const math::Vector3d inBase = tree.RelativePose(link1).CoordPositionAdd(
+      tree.RelativePose(sensor).CoordPositionAdd(p));
+  EXPECT_TRUE(tree.RelativePose(base).CoordPositionAdd(inBase).Equal(
+      tree.WorldPose(sensor).CoordPositionAdd(p), 1e-12));
+
+  std::vector<math::Pose3d> poses;
+  tree.WorldPoses({sensor, link2, base}, poses);
+  ASSERT_EQ(3u, poses.size());
+  EXPECT_EQ(expected, poses[0]);
+  EXPECT_EQ(tree.RelativePose(base) * tree.RelativePose(link2), poses[1]);
+  EXPECT_EQ(tree.RelativePose(base), poses[2]);
+
+  // Pose of the sensor in link2
+  const math::Pose3d sensorInLink2 = tree.PoseInFrame(sensor, link2);
+  EXPECT_TRUE((tree.WorldPose(link2) * sensorInLink2).Pos().Equal(
+      tree.WorldPose(sensor).Pos(), 1e-12));
+  EXPECT_EQ(tree.WorldPose(sensor),
+      tree.PoseInFrame(sensor, math::FrameTree::kNoFrame));
+  EXPECT_EQ(math::Pose3d::Zero, tree.PoseInFrame(sensor, 42));
+}
+
+/////////////////////////////////////////////////
+TEST(FrameTreeTest, Invalidate)
+{
+  math::FrameTree tree = TestTree();
+  const std::size_t base = tree.FrameIndex("base");
+  const std::size_t link1 = tree.FrameIndex("link1");
+  const std::size_t sensor = tree.FrameIndex("sensor");
+  const std::size_t link2 = tree.FrameIndex("link2");
+  const std::size_t other = tree.FrameIndex("other");
+
+  tree.UpdateWorldPoses();
+  for (std::size_t i = 0; i < tree.FrameCount(); ++i)
+    EXPECT_TRUE(tree.WorldPoseCached(i));
+
+  // Updating a joint only invalidates its subtree
+  const math::Pose3d link2World = tree.WorldPose(link2);
+  EXPECT_TRUE(tree.SetRelativePose(link1, math::Pose3d(0, 2, 0, 0, 0, 0)));
+  EXPECT_TRUE(tree.WorldPoseCached(base));
+  EXPECT_FALSE(tree.WorldPoseCached(link1));
+  EXPECT_FALSE(tree.WorldPoseCached(sensor));
+  EXPECT_TRUE(tree.WorldPoseCached(link2));
+  EXPECT_TRUE(tree.WorldPoseCached(other));
+  EXPECT_EQ(link2World, tree.WorldPose(link2));
+  EXPECT_EQ(tree.RelativePose(base) * tree.RelativePose(link1) *
+            tree.RelativePose(sensor), tree.WorldPose(sensor));
+
+  // Changing the root invalidates everything below it
+  tree.SetRelativePose(base, math::Pose3d(0, 0, 1, 0, 0, 0));
+  EXPECT_FALSE(tree.WorldPoseCached(link2));
+  EXPECT_TRUE(tree.WorldPoseCached(other));
+  tree.UpdateWorldPoses();
+  EXPECT_EQ(math::Pose3d(0, 0, 1, 0, 0, 0) * tree.RelativePose(link2),
+            tree.WorldPose(link2));
+
+  // A long chain, queried from the leaf after changing the middle
+  math::FrameTree chain;
+  std::size_t parent = math::FrameTree::kNoFrame;
+  const math::Pose3d step(0.1, 0, 0, 0, 0, 0.05);
+  for (int i = 0; i < 200; ++i)
+    parent = chain.AddFrame("frame" + std::to_string(i), parent, step);
+  chain.SetRelativePose(100, math::Pose3d(0, 1, 0, 0, 0, 0));
+  math::Pose3d expected;
+  for (std::size_t i = 0; i < chain.FrameCount(); ++i)
+    expected = expected * chain.RelativePose(i);
+  const math::Pose3d leaf = chain.WorldPose(parent);
+  EXPECT_TRUE(expected.Pos().Equal(leaf.Pos(), 1e-9));
+  EXPECT_TRUE(expected.Rot().Equal(leaf.Rot(), 1e-9));
+}
@@ -14,125 +14,460 @@
  * limitations under the License.
  *
 */
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "gz/math/AxisAlignedBox.hh"
+#include "gz/math/CpuFeatures.hh"
 #include "gz/math/Frustum.hh"
+#include "gz/math/Instrumentation.hh"
 #include "gz/math/Matrix4.hh"
+#include "gz/math/Trace.hh"
 #include "FrustumPrivate.hh"
 
+// Select the instruction sets of the batch culling kernels. The AVX kernel
+// is built even when the library targets older CPUs, and ActiveSimdLevel()
+// chooses between the kernels at run time. Define
+// IGNITION_MATH_DISABLE_SIMD to always use the portable scalar code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define IGNITION_MATH_FRUSTUM_SSE2 1
+    #include <emmintrin.h>
+    #if defined(__AVX__) || defined(_MSC_VER)
+      #define IGNITION_MATH_FRUSTUM_AVX 1
+      #define IGNITION_MATH_FRUSTUM_AVX_TARGET
+      #include <immintrin.h>
+    #elif defined(__GNUC__)
+      #define IGNITION_MATH_FRUSTUM_AVX 1
+      #define IGNITION_MATH_FRUSTUM_AVX_TARGET __attribute__((target("avx")))
+      #include <immintrin.h>
+    #endif
+  #endif
+#endif
+
 using namespace gz;
 using namespace math;
 
-/////////////////////////////////////////////////
-Frustum::Frustum()
-  : dataPtr(new FrustumPrivate(0, 1, IGN_DTOR(45), 1, Pose3d::Zero))
+namespace
 {
-}
+  /// \brief Fill the data derived from the planes and the corners: the
+  /// structure of arrays plane data and the bounding box.
+  /// \param[in,out] _f Frustum data.
+  void UpdateCullData(FrustumPrivate &_f)
+  {
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      if (i < _f.planes.size())
+      {
+        const Vector3d &n = _f.planes[i].Normal();
+        _f.planeX[i] = n.X();
+        _f.planeY[i] = n.Y();
+        _f.planeZ[i] = n.Z();
+        _f.planeD[i] = _f.planes[i].Offset();
+      }
+      else
+      {
+        // Every point is at distance 1 of this plane.
+        _f.planeX[i] = 0;
+        _f.planeY[i] = 0;
+        _f.planeZ[i] = 0;
+        _f.planeD[i] = -1;
+      }
+      _f.absPlaneX[i] = std::abs(_f.planeX[i]);
+      _f.absPlaneY[i] = std::abs(_f.planeY[i]);
+      _f.absPlaneZ[i] = std::abs(_f.planeZ[i]);
+    }
 
-/////////////////////////////////////////////////
-Frustum::Frustum(const double _near,
-                 const double _far,
-                 const Angle &_fov,
-                 const double _aspectRatio,
-                 const Pose3d &_pose)
-  : dataPtr(new FrustumPrivate(_near, _far, _fov, _aspectRatio, _pose))
-{
-  // Compute plane based on near distance, far distance, field of view,
-  // aspect ratio, and pose
-  this->ComputePlanes();
-}
+    // The frustum is the convex hull of its corners.
+    _f.boundsMin = _f.points[0];
+    _f.boundsMax = _f.points[0];
+    for (const auto &pt : _f.points)
+    {
+      _f.boundsMin.Min(pt);
+      _f.boundsMax.Max(pt);
+    }
+  }
 
-/////////////////////////////////////////////////
-Frustum::~Frustum()
-{
-  delete this->dataPtr;
-  this->dataPtr = NULL;
-}
+  /// \brief Compute the planes, corners and edges of a frustum from its
+  /// properties.
+  /// \param[in,out] _f Frustum data.
+  void UpdatePlanes(FrustumPrivate &_f)
+  {
+    // Tangent of half the field of view.
+    double tanFOV2 = std::tan(_f.fov() * 0.5);
+
+    // Width of near plane
+    double nearWidth = 2.0 * tanFOV2 * _f.near;
+
+    // Height of near plane
+    double nearHeight = nearWidth / _f.aspectRatio;
+
+    // Width of far plane
+    double farWidth = 2.0 * tanFOV2 * _f.far;
+
+    // Height of far plane
+    double farHeight = farWidth / _f.aspectRatio;
+
+    // Up, right, and forward unit vectors.
+    Vector3d forward = _f.pose.Rot().RotateVector(Vector3d::UnitX);
+    Vector3d up = _f.pose.Rot().RotateVector(Vector3d::UnitZ);
+    Vector3d right = _f.pose.Rot().RotateVector(-Vector3d::UnitY);
+
+    // Near plane center
+    Vector3d nearCenter = _f.pose.Pos() + forward *
+      _f.near;
+
+    // Far plane center
+    Vector3d farCenter = _f.pose.Pos() + forward *
+      _f.far;
+
+    // These four variables are here for convenience.
+    Vector3d upNearHeight2 = up * (nearHeight * 0.5);
+    Vector3d rightNearWidth2 = right * (nearWidth * 0.5);
+    Vector3d upFarHeight2 = up * (farHeight * 0.5);
+    Vector3d rightFarWidth2 = right * (farWidth * 0.5);
+
+    // Compute the vertices of the near plane
+    Vector3d nearTopLeft = nearCenter + upNearHeight2 - rightNearWidth2;
+    Vector3d nearTopRight = nearCenter + upNearHeight2 + rightNearWidth2;
+    Vector3d nearBottomLeft = nearCenter - upNearHeight2 - rightNearWidth2;
+    Vector3d nearBottomRight = nearCenter - upNearHeight2 + rightNearWidth2;
+
+    // Compute the vertices of the far plane
+    Vector3d farTopLeft = farCenter + upFarHeight2 - rightFarWidth2;
+    Vector3d farTopRight = farCenter + upFarHeight2 + rightFarWidth2;
+    Vector3d farBottomLeft = farCenter - upFarHeight2 - rightFarWidth2;
+    Vector3d farBottomRight = farCenter - upFarHeight2 + rightFarWidth2;
+
+    // Save these vertices
+    _f.points[0] = nearTopLeft;
+    _f.points[1] = nearTopRight;
+    _f.points[2] = nearBottomLeft;
+    _f.points[3] = nearBottomRight;
+    _f.points[4] = farTopLeft;
+    _f.points[5] = farTopRight;
+    _f.points[6] = farBottomLeft;
+    _f.points[7] = farBottomRight;
+
+    // Save the edges
+    _f.edges[0] = {nearTopLeft, nearTopRight};
+    _f.edges[1] = {nearTopLeft, nearBottomLeft};
+    _f.edges[2] = {nearTopLeft, farTopLeft};
+    _f.edges[3] = {nearTopRight, nearBottomRight};
+    _f.edges[4] = {nearTopRight, farTopRight};
+    _f.edges[5] = {nearBottomLeft, nearBottomRight};
+    _f.edges[6] = {nearBottomLeft, farBottomLeft};
+    _f.edges[7] = {farTopLeft, farTopRight};
+    _f.edges[8] = {farTopLeft, farBottomLeft};
+    _f.edges[9] = {farTopRight, farBottomRight};
+    _f.edges[10] = {farBottomLeft, farBottomRight};
+    _f.edges[11] = {farBottomRight, nearBottomRight};
+
+    Vector3d leftCenter =
+      (farTopLeft + nearTopLeft + farBottomLeft + nearBottomLeft) / 4.0;
+
+    Vector3d rightCenter =
+      (farTopRight + nearTopRight + farBottomRight + nearBottomRight) / 4.0;
+
+    Vector3d topCenter =
+      (farTopRight + nearTopRight + farTopLeft + nearTopLeft) / 4.0;
+
+    Vector3d bottomCenter =
+      (farBottomRight + nearBottomRight + farBottomLeft + nearBottomLeft) / 4.0;
+
+    // Compute plane offsets
+    // Set the planes, where the first value is the plane normal and the
+    // second the plane offset
+    Vector3d norm = Vector3d::Normal(nearTopLeft, nearTopRight, nearBottomLeft);
+    _f.planes[Frustum::FRUSTUM_PLANE_NEAR].Set(norm, nearCenter.Dot(norm));
+
+    norm = Vector3d::Normal(farTopRight, farTopLeft, farBottomLeft);
+    _f.planes[Frustum::FRUSTUM_PLANE_FAR].Set(norm, farCenter.Dot(norm));
+
+    norm = Vector3d::Normal(farTopLeft, nearTopLeft, nearBottomLeft);
+    _f.planes[Frustum::FRUSTUM_PLANE_LEFT].Set(norm, leftCenter.Dot(norm));
+
+    norm = Vector3d::Normal(nearTopRight, farTopRight, farBottomRight);
+    _f.planes[Frustum::FRUSTUM_PLANE_RIGHT].Set(norm, rightCenter.Dot(norm));
+
+    norm = Vector3d::Normal(nearTopLeft, farTopLeft, nearTopRight);
+    _f.planes[Frustum::FRUSTUM_PLANE_TOP].Set(norm, topCenter.Dot(norm));
+
+    norm = Vector3d::Normal(nearBottomLeft, nearBottomRight, farBottomRight);
+    _f.planes[Frustum::FRUSTUM_PLANE_BOTTOM].Set(norm, bottomCenter.Dot(norm));
+
+    UpdateCullData(_f);
+  }
 
-/////////////////////////////////////////////////
-Frustum::Frustum(const Frustum &_p)
-  : dataPtr(new FrustumPrivate(_p.Near(), _p.Far(), _p.FOV(),
-        _p.AspectRatio(), _p.Pose()))
-{
-  for (int i = 0; i < 6; ++i)
-    this->dataPtr->planes[i] = _p.dataPtr->planes[i];
-}
+  /// \brief Recompute the planes, corners and edges of a frustum if one
+  /// of its properties changed since they were last computed. Concurrent
+  /// calls are serialized, so const member functions of Frustum can be
+  /// called from several threads.
+  /// \param[in,out] _f Frustum data.
+  /// \return The up to date frustum data.
+  const FrustumPrivate &Updated(FrustumPrivate &_f)
+  {
+    if (_f.dirty.load(std::memory_order_acquire))
+    {
+      std::lock_guard<std::mutex> lock(_f.mutex);
+      if (_f.dirty.load(std::memory_order_relaxed))
+      {
+        UpdatePlanes(_f);
+        _f.dirty.store(false, std::memory_order_release);
+      }
+    }
+    return _f;
+  }
 
-/////////////////////////////////////////////////
-Planed Frustum::Plane(const FrustumPlane _plane) const
-{
-  return this->dataPtr->planes[_plane];
-}
+  /// \brief Bounds of an object tested by the batch culling functions.
+  /// The object is the Minkowski sum of a box and a sphere, both centered
+  /// at c. Boxes have a zero radius and spheres zero half extents.
+  struct CullBounds
+  {
+    /// \brief Center.
+    double c[3];
+
+    /// \brief Half extents of the box.
+    double e[3];
+
+    /// \brief Radius of the sphere.
+    double radius;
+  };
+
+  /// \brief Get whether an object is on the negative side of a plane.
+  /// This uses the same arithmetic as Plane::Side.
+  /// \param[in] _f Frustum data.
+  /// \param[in] _plane Index of the plane.
+  /// \param[in] _b Object bounds.
+  /// \return True if the object is on the negative side of the plane.
+  bool Outside(const FrustumPrivate &_f, const std::size_t _plane,
+               const CullBounds &_b)
+  {
+    const double dist = _f.planeX[_plane] * _b.c[0] +
+      _f.planeY[_plane] * _b.c[1] + _f.planeZ[_plane] * _b.c[2] -
+      _f.planeD[_plane];
+    const double r = _f.absPlaneX[_plane] * _b.e[0] +
+      _f.absPlaneY[_plane] * _b.e[1] + _f.absPlaneZ[_plane] * _b.e[2] +
+      _b.radius;
+    return dist < -r;
+  }
 
-/////////////////////////////////////////////////
-bool Frustum::Contains(const AxisAlignedBox &_b) const
-{
-  // This is a fast test used for culling.
-  // If the box is on the negative side of a plane, then the box is not
-  // visible.
-  int overlapping = 0;
-  for (auto const &plane : this->dataPtr->planes)
+  /// \brief Function which finds the sides of the planes of a frustum an
+  /// object is on. Planes the object straddles are in neither bitmask, and
+  /// the bits of the padding planes are undefined.
+  /// \param[in] _f Frustum data.
+  /// \param[in] _b Object bounds.
+  /// \param[out] _negative Bitmask of the planes the object is on the
+  /// negative side of.
+  /// \param[out] _positive Bitmask of the planes the object is on the
+  /// positive side of.
+  using ClassifyKernel = void (*)(const FrustumPrivate &_f,
+                                  const CullBounds &_b,
+                                  unsigned int &_negative,
+                                  unsigned int &_positive);
+
+  /// \brief Portable ClassifyKernel.
+  void ClassifyScalar(const FrustumPrivate &_f, const CullBounds &_b,
+                      unsigned int &_negative, unsigned int &_positive)
   {
-    auto const sign = plane.Side(_b);
-    if (sign == Planed::NEGATIVE_SIDE)
-      return false;
-    else if (sign == Planed::BOTH_SIDE)
-      ++overlapping;
+    _negative = 0;
+    _positive = 0;
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+      const double dist = _f.planeX[i] * _b.c[0] + _f.planeY[i] * _b.c[1] +
+        _f.planeZ[i] * _b.c[2] - _f.planeD[i];
+      const double r = _f.absPlaneX[i] * _b.e[0] +
+        _f.absPlaneY[i] * _b.e[1] + _f.absPlaneZ[i] * _b.e[2] + _b.radius;
+      if (dist < -r)
+        _negative |= 1u << i;
+      if (dist > r)
+        _positive |= 1u << i;
+    }
   }
 
-  // it is possible to be outside of frustum and overlapping multiple planes
-  if (overlapping >= 2)
+#if defined(IGNITION_MATH_FRUSTUM_SSE2)
+  /// \brief SSE2 ClassifyKernel, two planes at a time.
+  void ClassifySse2(const FrustumPrivate &_f, const CullBounds &_b,
+                    unsigned int &_negative, unsigned int &_positive)
+  {
+    _negative = 0;
+    _positive = 0;
+    const __m128d cx = _mm_set1_pd(_b.c[0]);
+    const __m128d cy = _mm_set1_pd(_b.c[1]);
+    const __m128d cz = _mm_set1_pd(_b.c[2]);
+    const __m128d ex = _mm_set1_pd(_b.e[0]);
+    const __m128d ey = _mm_set1_pd(_b.e[1]);
+    const __m128d ez = _mm_set1_pd(_b.e[2]);
+    const __m128d radius = _mm_set1_pd(_b.radius);
+    const __m128d zero = _mm_setzero_pd();
+    for (std::size_t i = 0; i < 6; i += 2)
+    {
+      const __m128d dist = _mm_sub_pd(_mm_add_pd(_mm_add_pd(
+          _mm_mul_pd(_mm_load_pd(&_f.planeX[i]), cx),
+          _mm_mul_pd(_mm_load_pd(&_f.planeY[i]), cy)),
+          _mm_mul_pd(_mm_load_pd(&_f.planeZ[i]), cz)),
+          _mm_load_pd(&_f.planeD[i]));
+      const __m128d r = _mm_add_pd(_mm_add_pd(_mm_add_pd(
+          _mm_mul_pd(_mm_load_pd(&_f.absPlaneX[i]), ex),
+          _mm_mul_pd(_mm_load_pd(&_f.absPlaneY[i]), ey)),
+          _mm_mul_pd(_mm_load_pd(&_f.absPlaneZ[i]), ez)), radius);
+      _negative |= static_cast<unsigned int>(_mm_movemask_pd(
+          _mm_cmplt_pd(dist, _mm_sub_pd(zero, r)))) << i;
+      _positive |= static_cast<unsigned int>(_mm_movemask_pd(
+          _mm_cmpgt_pd(dist, r))) << i;
+    }
+  }
+#endif
+
+#if defined(IGNITION_MATH_FRUSTUM_AVX)
+  /// \brief AVX ClassifyKernel, four planes at a time.
+  IGNITION_MATH_FRUSTUM_AVX_TARGET
+  void ClassifyAvx(const FrustumPrivate &_f, const CullBounds &_b,
+                   unsigned int &_negative, unsigned int &_positive)
+  {
+    _negative = 0;
+    _positive = 0;
+    const __m256d cx = _mm256_set1_pd(_b.c[0]);
+    const __m256d cy = _mm256_set1_pd(_b.c[1]);
+    const __m256d cz = _mm256_set1_pd(_b.c[2]);
+    const __m256d ex = _mm256_set1_pd(_b.e[0]);
+    const __m256d ey = _mm256_set1_pd(_b.e[1]);
+    const __m256d ez = _mm256_set1_pd(_b.e[2]);
+    const __m256d radius = _mm256_set1_pd(_b.radius);
+    const __m256d zero = _mm256_setzero_pd();
+    for (std::size_t i = 0; i < 8; i += 4)
+    {
+      const __m256d dist = _mm256_sub_pd(_mm256_add_pd(_mm256_add_pd(
+          _mm256_mul_pd(_mm256_load_pd(&_f.planeX[i]), cx),
+          _mm256_mul_pd(_mm256_load_pd(&_f.planeY[i]), cy)),
+          _mm256_mul_pd(_mm256_load_pd(&_f.planeZ[i]), cz)),
+          _mm256_load_pd(&_f.planeD[i]));
+      const __m256d r = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+          _mm256_mul_pd(_mm256_load_pd(&_f.absPlaneX[i]), ex),
+          _mm256_mul_pd(_mm256_load_pd(&_f.absPlaneY[i]), ey)),
+          _mm256_mul_pd(_mm256_load_pd(&_f.absPlaneZ[i]), ez)), radius);
+      _negative |= static_cast<unsigned int>(_mm256_movemask_pd(
+          _mm256_cmp_pd(dist, _mm256_sub_pd(zero, r), _CMP_LT_OQ))) << i;
+      _positive |= static_cast<unsigned int>(_mm256_movemask_pd(
+          _mm256_cmp_pd(dist, r, _CMP_GT_OQ))) << i;
+    }
+  }
+#endif
+
+  /// \brief Get the widest classification kernel allowed by
+  /// ActiveSimdLevel().
+  /// \return The kernel.
+  ClassifyKernel SelectClassifyKernel()
+  {
+    const SimdLevel level = ActiveSimdLevel();
+    if (level == SimdLevel::SCALAR || level == SimdLevel::NEON)
+      return ClassifyScalar;
+#if defined(IGNITION_MATH_FRUSTUM_AVX)
+    if (level != SimdLevel::SSE2)
+      return ClassifyAvx;
+#endif
+#if defined(IGNITION_MATH_FRUSTUM_SSE2)
+    return ClassifySse2;
+#else
+    return ClassifyScalar;
+#endif
+  }
+
+  /// \brief Classify an object against the six planes of a frustum.
+  /// \param[in] _kernel Classification kernel.
+  /// \param[in] _f Frustum data.
+  /// \param[in] _b Object bounds.
+  /// \param[out] _straddled Bitmask of the planes the object straddles.
+  /// \return Bitmask of the planes the object is on the negative side of.
+  unsigned int Classify(const ClassifyKernel _kernel,
+                        const FrustumPrivate &_f, const CullBounds &_b,
+                        unsigned int &_straddled)
+  {
+    unsigned int negative = 0;
+    unsigned int positive = 0;
+    _kernel(_f, _b, negative, positive);
+    negative &= 0x3Fu;
+    positive &= 0x3Fu;
+    _straddled = ~(negative | positive) & 0x3Fu;
+    return negative;
+  }
+
+  /// \brief Exact test for a box that straddles at least two planes of a
+  /// frustum and is not on the negative side of any of them.
+  /// \param[in] _f Frustum data.
+  /// \param[in] _min Minimum corner of the box.
+  /// \param[in] _max Maximum corner of the box.
+  /// \return True if the box intersects the frustum.
+  bool Overlaps(const FrustumPrivate &_f, const Vector3d &_min,
+                const Vector3d &_max)
   {
     // return true if any box point is inside the frustum
-    auto const &min = _b.Min();
-    auto const &max = _b.Max();
     for (int p = 0; p < 8; ++p)
     {
-      const double &x = (p & 4) ? min.X() : max.X();
-      const double &y = (p & 2) ? min.Y() : max.Y();
-      const double &z = (p & 1) ? min.Z() : max.Z();
-      if (this->Contains(Vector3d(x, y, z)))
+      const Vector3d corner((p & 4) ? _min.X() : _max.X(),
+                            (p & 2) ? _min.Y() : _max.Y(),
+                            (p & 1) ? _min.Z() : _max.Z());
+      bool inside = true;
+      for (auto const &plane : _f.planes)
+      {
+        if (plane.Side(corner) == Planed::NEGATIVE_SIDE)
+        {
+          inside = false;
+          break;
+        }
+      }
+      if (inside)
         return true;
     }
+
     // return true if any frustum point is inside the box
-    for (auto const &pt : this->dataPtr->points)
+    for (auto const &pt : _f.points)
     {
-      if (_b.Contains(pt))
+      if (pt.X() >= _min.X() && pt.X() <= _max.X() &&
+          pt.Y() >= _min.Y() && pt.Y() <= _max.Y() &&
+          pt.Z() >= _min.Z() && pt.Z() <= _max.Z())
+      {
         return true;
+      }
     }
 
     // Return true if any edge of the frustum passes through the AABB
-    for (const auto &edge : this->dataPtr->edges)
+    for (const auto &edge : _f.edges)
     {
       // If the edge projected onto a world axis does not overlapp with the AABB
       // then the edge could not be passing through the AABB.
-      if (edge.first.X() < min.X() && edge.second.X() < min.X())
+      if (edge.first.X() < _min.X() && edge.second.X() < _min.X())
       {
         // both frustum edge points are below AABB on x axis
         continue;
       }
-      else if (edge.first.X() > max.X() && edge.second.X() > max.X())
+      else if (edge.first.X() > _max.X() && edge.second.X() > _max.X())
       {
         // both frustum edge points are above AABB on x axis
         continue;
       }
-      else if (edge.first.Y() < min.Y() && edge.second.Y() < min.Y())
+      else if (edge.first.Y() < _min.Y() && edge.second.Y() < _min.Y())
       {
         // both frustum edge points are below AABB on y axis
         continue;
       }
-      else if (edge.first.Y() > max.Y() && edge.second.Y() > max.Y())
+      else if (edge.first.Y() > _max.Y() && edge.second.Y() > _max.Y())
       {
         // both frustum edge points are above AABB on y axis
         continue;
       }
-      else if (edge.first.Z() < min.Z() && edge.second.Z() < min.Z())
+      else if (edge.first.Z() < _min.Z() && edge.second.Z() < _min.Z())
       {
         // both frustum edge points are below AABB on z axis
         continue;
       }
-      else if (edge.first.Z() > max.Z() && edge.second.Z() > max.Z())
+      else if (edge.first.Z() > _max.Z() && edge.second.Z() > _max.Z())
       {
         // both frustum edge points are above AABB on z axis
         continue;
@@ -146,6 +481,239 @@ bool Frustum::Contains(const AxisAlignedBox &_b) const
     return false;
   }
 
+  /// \brief Get the culling bounds of a box, computed in the same way as
+  /// AxisAlignedBox::Center and AxisAlignedBox::Size.
+  /// \param[in] _min Minimum corner of the box.
+  /// \param[in] _max Maximum corner of the box.
+  /// \return The bounds.
+  CullBounds BoxBounds(const Vector3d &_min, const Vector3d &_max)
+  {
+    CullBounds b;
+    b.c[0] = 0.5 * _min.X() + 0.5 * _max.X();
+    b.c[1] = 0.5 * _min.Y() + 0.5 * _max.Y();
+    b.c[2] = 0.5 * _min.Z() + 0.5 * _max.Z();
+    b.e[0] = std::max(0.0, _max.X() - _min.X()) / 2.0;
+    b.e[1] = std::max(0.0, _max.Y() - _min.Y()) / 2.0;
+    b.e[2] = std::max(0.0, _max.Z() - _min.Z()) / 2.0;
+    b.radius = 0;
+    return b;
+  }
+
+  /// \brief Cull a batch of objects.
+  /// \param[in] _f Frustum data.
+  /// \param[in] _count Number of objects.
+  /// \param[in] _bounds Function returning the CullBounds of an object.
+  /// \param[in] _exact Function called with the index of an object that
+  /// straddles two or more planes, returning its final visibility.
+  /// \param[out] _visible Visibility bitmask.
+  /// \param[in,out] _planeCache Last culling plane of each object, or
+  /// nullptr.
+  /// \return Number of visible objects.
+  template<typename BoundsFn, typename ExactFn>
+  std::size_t Cull(const FrustumPrivate &_f, const std::size_t _count,
+                   BoundsFn _bounds, ExactFn _exact,
+                   std::vector<uint64_t> &_visible,
+                   std::vector<uint8_t> *_planeCache)
+  {
+    _visible.assign((_count + 63) / 64, 0);
+    if (_planeCache && _planeCache->size() != _count)
+      _planeCache->assign(_count, 0);
+
+    const ClassifyKernel kernel = SelectClassifyKernel();
+    std::size_t visibleCount = 0;
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      const CullBounds b = _bounds(i);
+
+      // Plane coherency: the plane that culled the object last time is
+      // likely to cull it again.
+      if (_planeCache)
+      {
+        const std::size_t cached = (*_planeCache)[i];
+        if (cached < 6 && Outside(_f, cached, b))
+          continue;
+      }
+
+      unsigned int straddled = 0;
+      unsigned int negative = Classify(kernel, _f, b, straddled);
+      if (negative)
+      {
+        if (_planeCache)
+        {
+          uint8_t plane = 0;
+          while (!(negative & 1u))
+          {
+            negative >>= 1;
+            ++plane;
+          }
+          (*_planeCache)[i] = plane;
+        }
+        continue;
+      }
+
+      // it is possible to be outside of frustum and overlapping multiple
+      // planes
+      if ((straddled & (straddled - 1)) && !_exact(i))
+        continue;
+
+      _visible[i / 64] |= uint64_t(1) << (i % 64);
+      ++visibleCount;
+    }
+    return visibleCount;
+  }
+
+  /// \brief Convert a vector to double precision.
+  /// \param[in] _v Vector to convert.
+  /// \return The converted vector.
+  template<typename T>
+  Vector3d ToVector3d(const Vector3<T> &_v)
+  {
+    return Vector3d(_v.X(), _v.Y(), _v.Z());
+  }
+
+  /// \brief Cull a batch of boxes.
+  /// \param[in] _f Frustum data.
+  /// \param[in] _boxes Boxes to cull.
+  /// \param[out] _visible Visibility bitmask.
+  /// \param[in,out] _planeCache Last culling plane of each box, or nullptr.
+  /// \return Number of visible boxes.
+  template<typename BoxType>
+  std::size_t CullBoxes(const FrustumPrivate &_f,
+                        const std::vector<BoxType> &_boxes,
+                        std::vector<uint64_t> &_visible,
+                        std::vector<uint8_t> *_planeCache)
+  {
+    IGN_MATH_TRACE_ZONE("Frustum::Contains(boxes)");
+    return Cull(_f, _boxes.size(),
+      [&](const std::size_t _i)
+      {
+        return BoxBounds(ToVector3d(_boxes[_i].Min()),
+                         ToVector3d(_boxes[_i].Max()));
+      },
+      [&](const std::size_t _i)
+      {
+        return Overlaps(_f, ToVector3d(_boxes[_i].Min()),
+                        ToVector3d(_boxes[_i].Max()));
+      },
+      _visible, _planeCache);
+  }
+
+  /// \brief Cull a batch of spheres.
+  /// \param[in] _f Frustum data.
+  /// \param[in] _centers Centers of the spheres.
+  /// \param[in] _radii Radii of the spheres.
+  /// \param[out] _visible Visibility bitmask.
+  /// \param[in,out] _planeCache Last culling plane of each sphere, or
+  /// nullptr.
+  /// \return Number of visible spheres.
+  template<typename T>
+  std::size_t CullSpheres(const FrustumPrivate &_f,
+                          const std::vector<Vector3<T>> &_centers,
+                          const std::vector<T> &_radii,
+                          std::vector<uint64_t> &_visible,
+                          std::vector<uint8_t> *_planeCache)
+  {
+    IGN_MATH_TRACE_ZONE("Frustum::Contains(spheres)");
+    if (_centers.size() != _radii.size())
+    {
+      _visible.clear();
+      return 0;
+    }
+
+    return Cull(_f, _centers.size(),
+      [&](const std::size_t _i)
+      {
+        CullBounds b;
+        b.c[0] = _centers[_i].X();
+        b.c[1] = _centers[_i].Y();
+        b.c[2] = _centers[_i].Z();
+        b.e[0] = b.e[1] = b.e[2] = 0;
+        b.radius = _radii[_i];
+        return b;
+      },
+      [](const std::size_t)
+      {
+        return true;
+      },
+      _visible, _planeCache);
+  }
+}
+
+/////////////////////////////////////////////////
+Frustum::Frustum()
+  : dataPtr(new FrustumPrivate(0, 1, IGN_DTOR(45), 1, Pose3d::Zero))
+{
+  UpdateCullData(*this->dataPtr);
+  this->dataPtr->dirty = false;
+}
+
+/////////////////////////////////////////////////
+Frustum::Frustum(const double _near,
+                 const double _far,
+                 const Angle &_fov,
+                 const double _aspectRatio,
+                 const Pose3d &_pose)
+  : dataPtr(new FrustumPrivate(_near, _far, _fov, _aspectRatio, _pose))
+{
+  // The planes are computed from the near distance, far distance, field
+  // of view, aspect ratio, and pose when they are first needed.
+}
+
+/////////////////////////////////////////////////
+Frustum::~Frustum()
+{
+  delete this->dataPtr;
+  this->dataPtr = NULL;
+}
+
+/////////////////////////////////////////////////
+Frustum::Frustum(const Frustum &_p)
+  : dataPtr(new FrustumPrivate(_p.Near(), _p.Far(), _p.FOV(),
+        _p.AspectRatio(), _p.Pose()))
+{
+  IGN_MATH_COUNT_COPY(PIMPL, sizeof(FrustumPrivate));
+  const FrustumPrivate &p = Updated(*_p.dataPtr);
+  this->dataPtr->planes = p.planes;
+  this->dataPtr->points = p.points;
+  this->dataPtr->edges = p.edges;
+  UpdateCullData(*this->dataPtr);
+  this->dataPtr->dirty = false;
+}
+
+/////////////////////////////////////////////////
+Frustum::Frustum(Frustum &&_p) noexcept
+  : dataPtr(_p.dataPtr)
+{
+  _p.dataPtr = nullptr;
+}
+
+/////////////////////////////////////////////////
+Planed Frustum::Plane(const FrustumPlane _plane) const
+{
+  return Updated(*this->dataPtr).planes[_plane];
+}
+
+/////////////////////////////////////////////////
+bool Frustum::Contains(const AxisAlignedBox &_b) const
+{
+  // This is a fast test used for culling.
+  // If the box is on the negative side of a plane, then the box is not
+  // visible.
+  const FrustumPrivate &f = Updated(*this->dataPtr);
+  int overlapping = 0;
+  for (auto const &plane : f.planes)
+  {
+    auto const sign = plane.Side(_b);
+    if (sign == Planed::NEGATIVE_SIDE)
+      return false;
+    else if (sign == Planed::BOTH_SIDE)
+      ++overlapping;
+  }
+
+  // it is possible to be outside of frustum and overlapping multiple planes
+  if (overlapping >= 2)
+    return Overlaps(f, _b.Min(), _b.Max());
+
   return true;
 }
 
@@ -154,7 +722,7 @@ bool Frustum::Contains(const Vector3d &_p) const
 {
   // If the point is on the negative side of a plane, then the point is not
   // visible.
-  for (auto const &plane : this->dataPtr->planes)
+  for (auto const &plane : Updated(*this->dataPtr).planes)
   {
     if (plane.Side(_p) == Planed::NEGATIVE_SIDE)
       return false;
@@ -163,6 +731,95 @@ bool Frustum::Contains(const Vector3d &_p) const
   return true;
 }
 
+/////////////////////////////////////////////////
+std::size_t Frustum::Contains(const std::vector<AxisAlignedBox> &_boxes,
+    std::vector<uint64_t> &_visible) const
+{
+  return CullBoxes(Updated(*this->dataPtr), _boxes, _visible, nullptr);
+}
+
+/////////////////////////////////////////////////
+std::size_t Frustum::Contains(const std::vector<AxisAlignedBox> &_boxes,
+    std::vector<uint64_t> &_visible, std::vector<uint8_t> &_planeCache) const
+{
+  return CullBoxes(Updated(*this->dataPtr), _boxes, _visible, &_planeCache);
+}
+
+/////////////////////////////////////////////////
+std::size_t Frustum::Contains(const std::vector<AxisAlignedBox3d> &_boxes,
+    std::vector<uint64_t> &_visible) const
+{
+  return CullBoxes(Updated(*this->dataPtr), _boxes, _visible, nullptr);
+}
+
+/////////////////////////////////////////////////
+std::size_t Frustum::Contains(const std::vector<AxisAlignedBox3d> &_boxes,
+    std::vector<uint64_t> &_visible, std::vector<uint8_t> &_planeCache) const
+{
+  return CullBoxes(Updated(*this->dataPtr), _boxes, _visible, &_planeCache);
+}
+
+/////////////////////////////////////////////////
+std::size_t Frustum::Contains(const std::vector<Vector3d> &_centers,
+    const std::vector<double> &_radii, std::vector<uint64_t> &_visible) const
+{
+  return CullSpheres(Updated(*this->dataPtr), _centers, _radii, _visible,
+                     nullptr);
+}
+
+/////////////////////////////////////////////////
+std::size_t Frustum::Contains(const std::vector<Vector3d> &_centers,
+    const std::vector<double> &_radii, std::vector<uint64_t> &_visible,
+    std::vector<uint8_t> &_planeCache) const
+{
+  return CullSpheres(Updated(*this->dataPtr), _centers, _radii, _visible,
+                     &_planeCache);
+}
+
+/////////////////////////////////////////////////
+std::size_t Frustum::Contains(const std::vector<AxisAlignedBox3f> &_boxes,
+    std::vector<uint64_t> &_visible) const
+{
+  return CullBoxes(Updated(*this->dataPtr), _boxes, _visible, nullptr);
+}
+
+/////////////////////////////////////////////////
+std::size_t Frustum::Contains(const std::vector<AxisAlignedBox3f> &_boxes,
+    std::vector<uint64_t> &_visible, std::vector<uint8_t> &_planeCache) const
+{
+  return CullBoxes(Updated(*this->dataPtr), _boxes, _visible, &_planeCache);
+}
+
+/////////////////////////////////////////////////
+std::size_t Frustum::Contains(const std::vector<Vector3f> &_centers,
+    const std::vector<float> &_radii, std::vector<uint64_t> &_visible) const
+{
+  return CullSpheres(Updated(*this->dataPtr), _centers, _radii, _visible,
+                     nullptr);
+}
+
+/////////////////////////////////////////////////
+std::size_t Frustum::Contains(const std::vector<Vector3f> &_centers,
+    const std::vector<float> &_radii, std::vector<uint64_t> &_visible,
+    std::vector<uint8_t> &_planeCache) const
+{
+  return CullSpheres(Updated(*this->dataPtr), _centers, _radii, _visible,
+                     &_planeCache);
+}
+
+/////////////////////////////////////////////////
+std::array<Vector3d, 8> Frustum::Corners() const
+{
+  return Updated(*this->dataPtr).points;
+}
+
+/////////////////////////////////////////////////
+AxisAlignedBox Frustum::Bounds() const
+{
+  const FrustumPrivate &f = Updated(*this->dataPtr);
+  return AxisAlignedBox(f.boundsMin, f.boundsMax);
+}
+
 /////////////////////////////////////////////////
 double Frustum::Near() const
 {
@@ -173,7 +830,7 @@ double Frustum::Near() const
 void Frustum::SetNear(const double _near)
 {
   this->dataPtr->near = _near;
-  this->ComputePlanes();
+  this->dataPtr->dirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -186,7 +843,7 @@ double Frustum::Far() const
 void Frustum::SetFar(const double _far)
 {
   this->dataPtr->far = _far;
-  this->ComputePlanes();
+  this->dataPtr->dirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -199,7 +856,7 @@ Angle Frustum::FOV() const
 void Frustum::SetFOV(const Angle &_angle)
 {
   this->dataPtr->fov = _angle;
-  this->ComputePlanes();
+  this->dataPtr->dirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -212,7 +869,7 @@ Pose3d Frustum::Pose() const
 void Frustum::SetPose(const Pose3d &_pose)
 {
   this->dataPtr->pose = _pose;
-  this->ComputePlanes();
+  this->dataPtr->dirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -225,125 +882,40 @@ double Frustum::AspectRatio() const
 void Frustum::SetAspectRatio(const double _aspectRatio)
 {
   this->dataPtr->aspectRatio = _aspectRatio;
-  this->ComputePlanes();
+  this->dataPtr->dirty = true;
 }
 
 /////////////////////////////////////////////////
 void Frustum::ComputePlanes()
 {
-  // Tangent of half the field of view.
-  double tanFOV2 = std::tan(this->dataPtr->fov() * 0.5);
-
-  // Width of near plane
-  double nearWidth = 2.0 * tanFOV2 * this->dataPtr->near;
-
-  // Height of near plane
-  double nearHeight = nearWidth / this->dataPtr->aspectRatio;
-
-  // Width of far plane
-  double farWidth = 2.0 * tanFOV2 * this->dataPtr->far;
-
-  // Height of far plane
-  double farHeight = farWidth / this->dataPtr->aspectRatio;
-
-  // Up, right, and forward unit vectors.
-  Vector3d forward = this->dataPtr->pose.Rot().RotateVector(Vector3d::UnitX);
-  Vector3d up = this->dataPtr->pose.Rot().RotateVector(Vector3d::UnitZ);
-  Vector3d right = this->dataPtr->pose.Rot().RotateVector(-Vector3d::UnitY);
-
-  // Near plane center
-  Vector3d nearCenter = this->dataPtr->pose.Pos() + forward *
-    this->dataPtr->near;
-
-  // Far plane center
-  Vector3d farCenter = this->dataPtr->pose.Pos() + forward *
-    this->dataPtr->far;
-
-  // These four variables are here for convenience.
-  Vector3d upNearHeight2 = up * (nearHeight * 0.5);
-  Vector3d rightNearWidth2 = right * (nearWidth * 0.5);
-  Vector3d upFarHeight2 = up * (farHeight * 0.5);
-  Vector3d rightFarWidth2 = right * (farWidth * 0.5);
-
-  // Compute the vertices of the near plane
-  Vector3d nearTopLeft = nearCenter + upNearHeight2 - rightNearWidth2;
-  Vector3d nearTopRight = nearCenter + upNearHeight2 + rightNearWidth2;
-  Vector3d nearBottomLeft = nearCenter - upNearHeight2 - rightNearWidth2;
-  Vector3d nearBottomRight = nearCenter - upNearHeight2 + rightNearWidth2;
-
-  // Compute the vertices of the far plane
-  Vector3d farTopLeft = farCenter + upFarHeight2 - rightFarWidth2;
-  Vector3d farTopRight = farCenter + upFarHeight2 + rightFarWidth2;
-  Vector3d farBottomLeft = farCenter - upFarHeight2 - rightFarWidth2;
-  Vector3d farBottomRight = farCenter - upFarHeight2 + rightFarWidth2;
-
-  // Save these vertices
-  this->dataPtr->points[0] = nearTopLeft;
-  this->dataPtr->points[1] = nearTopRight;
-  this->dataPtr->points[2] = nearBottomLeft;
-  this->dataPtr->points[3] = nearBottomRight;
-  this->dataPtr->points[4] = farTopLeft;
-  this->dataPtr->points[5] = farTopRight;
-  this->dataPtr->points[6] = farBottomLeft;
-  this->dataPtr->points[7] = farBottomRight;
-
-  // Save the edges
-  this->dataPtr->edges[0] = {nearTopLeft, nearTopRight};
-  this->dataPtr->edges[1] = {nearTopLeft, nearBottomLeft};
-  this->dataPtr->edges[2] = {nearTopLeft, farTopLeft};
-  this->dataPtr->edges[3] = {nearTopRight, nearBottomRight};
-  this->dataPtr->edges[4] = {nearTopRight, farTopRight};
-  this->dataPtr->edges[5] = {nearBottomLeft, nearBottomRight};
-  this->dataPtr->edges[6] = {nearBottomLeft, farBottomLeft};
-  this->dataPtr->edges[7] = {farTopLeft, farTopRight};
-  this->dataPtr->edges[8] = {farTopLeft, farBottomLeft};
-  this->dataPtr->edges[9] = {farTopRight, farBottomRight};
-  this->dataPtr->edges[10] = {farBottomLeft, farBottomRight};
-  this->dataPtr->edges[11] = {farBottomRight, nearBottomRight};
-
-  Vector3d leftCenter =
-    (farTopLeft + nearTopLeft + farBottomLeft + nearBottomLeft) / 4.0;
-
-  Vector3d rightCenter =
-    (farTopRight + nearTopRight + farBottomRight + nearBottomRight) / 4.0;
-
-  Vector3d topCenter =
-    (farTopRight + nearTopRight + farTopLeft + nearTopLeft) / 4.0;
-
-  Vector3d bottomCenter =
-    (farBottomRight + nearBottomRight + farBottomLeft + nearBottomLeft) / 4.0;
-
-  // Compute plane offsets
-  // Set the planes, where the first value is the plane normal and the
-  // second the plane offset
-  Vector3d norm = Vector3d::Normal(nearTopLeft, nearTopRight, nearBottomLeft);
-  this->dataPtr->planes[FRUSTUM_PLANE_NEAR].Set(norm, nearCenter.Dot(norm));
-
-  norm = Vector3d::Normal(farTopRight, farTopLeft, farBottomLeft);
-  this->dataPtr->planes[FRUSTUM_PLANE_FAR].Set(norm, farCenter.Dot(norm));
-
-  norm = Vector3d::Normal(farTopLeft, nearTopLeft, nearBottomLeft);
-  this->dataPtr->planes[FRUSTUM_PLANE_LEFT].Set(norm, leftCenter.Dot(norm));
-
-  norm = Vector3d::Normal(nearTopRight, farTopRight, farBottomRight);
-  this->dataPtr->planes[FRUSTUM_PLANE_RIGHT].Set(norm, rightCenter.Dot(norm));
-
-  norm = Vector3d::Normal(nearTopLeft, farTopLeft, nearTopRight);
-  this->dataPtr->planes[FRUSTUM_PLANE_TOP].Set(norm, topCenter.Dot(norm));
-
-  norm = Vector3d::Normal(nearBottomLeft, nearBottomRight, farBottomRight);
-  this->dataPtr->planes[FRUSTUM_PLANE_BOTTOM].Set(norm, bottomCenter.Dot(norm));
+  UpdatePlanes(*this->dataPtr);
+  this->dataPtr->dirty = false;
 }
 
 //////////////////////////////////////////////////
 Frustum &Frustum::operator =(const Frustum &_f)
 {
+  // A moved from frustum has no data
+  if (this->dataPtr == nullptr)
+  {
+    this->dataPtr = new FrustumPrivate(_f.dataPtr->near, _f.dataPtr->far,
+        _f.dataPtr->fov, _f.dataPtr->aspectRatio, _f.dataPtr->pose);
+  }
+
+  IGN_MATH_COUNT_COPY(PIMPL, sizeof(FrustumPrivate));
   this->dataPtr->near = _f.dataPtr->near;
   this->dataPtr->far = _f.dataPtr->far;
   this->dataPtr->fov = _f.dataPtr->fov;
   this->dataPtr->aspectRatio = _f.dataPtr->aspectRatio;
   this->dataPtr->pose = _f.dataPtr->pose;
-  this->ComputePlanes();
+  this->dataPtr->dirty = true;
 
   return *this;
 }
+
+//////////////////////////////////////////////////
+Frustum &Frustum::operator =(Frustum &&_f) noexcept
+{
+  std::swap(this->dataPtr, _f.dataPtr);
+  return *this;
+}
@@ -18,6 +18,8 @@
 #define GZ_MATH_FRUSTUMPRIVATE_HH_
 
 #include <array>
+#include <atomic>
+#include <mutex>
 #include <utility>
 #include <gz/math/Pose3.hh>
 #include <gz/math/Angle.hh>
@@ -81,6 +83,43 @@ namespace ignition
 
       /// \brief each edge of the frustum.
       public: std::array<std::pair<Vector3d, Vector3d>, 12> edges;
+
+      /// \brief Normal x components of the planes in structure of arrays
+      /// form, used by the batch culling functions. The last two entries
+      /// are padding to allow processing the planes in groups of four.
+      /// Their plane has every point on its positive side.
+      public: alignas(32) std::array<double, 8> planeX;
+
+      /// \brief Normal y components of the planes, see planeX.
+      public: alignas(32) std::array<double, 8> planeY;
+
+      /// \brief Normal z components of the planes, see planeX.
+      public: alignas(32) std::array<double, 8> planeZ;
+
+      /// \brief Offsets of the planes, see planeX.
+      public: alignas(32) std::array<double, 8> planeD;
+
+      /// \brief Absolute value of planeX.
+      public: alignas(32) std::array<double, 8> absPlaneX;
+
+      /// \brief Absolute value of planeY.
+      public: alignas(32) std::array<double, 8> absPlaneY;
+
+      /// \brief Absolute value of planeZ.
+      public: alignas(32) std::array<double, 8> absPlaneZ;
+
+      /// \brief Minimum corner of the box that bounds the frustum.
+      public: Vector3d boundsMin;
+
+      /// \brief Maximum corner of the box that bounds the frustum.
+      public: Vector3d boundsMax;
+
+      /// \brief True when a property changed since the planes, points,
+      /// edges and the data derived from them were last computed.
+      public: std::atomic<bool> dirty{true};
+
+      /// \brief Mutex serializing the lazy updates of the planes.
+      public: std::mutex mutex;
     };
     }
   }
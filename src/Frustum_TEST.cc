@@ -17,8 +17,15 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gz/math/CpuFeatures.hh"
 #include "gz/math/Helpers.hh"
 #include "gz/math/Frustum.hh"
+#include "gz/math/Rand.hh"
 
 using namespace gz;
 using namespace math;
@@ -122,6 +129,37 @@ TEST(FrustumTest, AssignmentOperator)
             frustum2.Plane(Frustum::FRUSTUM_PLANE_BOTTOM).Normal());
 }
 
+/////////////////////////////////////////////////
+TEST(FrustumTest, Move)
+{
+  EXPECT_TRUE(std::is_nothrow_move_constructible<Frustum>::value);
+  EXPECT_TRUE(std::is_nothrow_move_assignable<Frustum>::value);
+
+  Frustum frustum(1, 10, Angle(IGN_DTOR(45)), 320.0/240.0,
+      Pose3d(0, 0, 0, 0, 0, IGN_DTOR(45)));
+  const Frustum expected(frustum);
+
+  Frustum moved(std::move(frustum));
+  EXPECT_DOUBLE_EQ(expected.Near(), moved.Near());
+  EXPECT_DOUBLE_EQ(expected.Far(), moved.Far());
+  EXPECT_EQ(expected.FOV(), moved.FOV());
+  EXPECT_EQ(expected.Pose(), moved.Pose());
+  EXPECT_EQ(expected.Plane(Frustum::FRUSTUM_PLANE_LEFT).Normal(),
+            moved.Plane(Frustum::FRUSTUM_PLANE_LEFT).Normal());
+
+  Frustum assigned;
+  assigned = std::move(moved);
+  EXPECT_DOUBLE_EQ(expected.Far(), assigned.Far());
+  EXPECT_EQ(expected.Pose(), assigned.Pose());
+
+  // Moved from frustums can be assigned to again
+  frustum = expected;
+  EXPECT_DOUBLE_EQ(expected.Far(), frustum.Far());
+  moved = std::move(assigned);
+  EXPECT_DOUBLE_EQ(expected.Far(), moved.Far());
+  EXPECT_TRUE(moved.Contains(Vector3d(5, 5, 0)));
+}
+
 /////////////////////////////////////////////////
 TEST(FrustumTest, PyramidXAxisPos)
 {
@@ -659,3 +697,289 @@ TEST(FrustumTest, AABBBFWall)
   EXPECT_TRUE(frustum.Contains(
         AxisAlignedBox(Vector3d(-10, -10, 1.95), Vector3d(10, 10, 2.05))));
 }
+
+/////////////////////////////////////////////////
+/// \brief Get a bit of a visibility bitmask.
+bool Visible(const std::vector<uint64_t> &_visible, const std::size_t _i)
+{
+  return (_visible[_i / 64] >> (_i % 64)) & 1u;
+}
+
+//////////////////////////////////////////////////
+TEST(FrustumTest, ContainsBatch)
+{
+  Rand::Seed(1234);
+
+  Frustum frustum;
+  frustum.SetNear(0.55);
+  frustum.SetFar(20);
+  frustum.SetFOV(1.05);
+  frustum.SetAspectRatio(1.8);
+  frustum.SetPose(Pose3d(0, 0, 2, 0, 0.2, 0.3));
+
+  // Boxes of all sizes, many of them straddling several planes.
+  std::vector<AxisAlignedBox> boxes;
+  std::vector<AxisAlignedBox3d> boxes3;
+  std::vector<Vector3d> centers;
+  std::vector<double> radii;
+  for (int i = 0; i < 2000; ++i)
+  {
+    Vector3d center(Rand::DblUniform(-5, 25), Rand::DblUniform(-15, 15),
+                    Rand::DblUniform(-10, 15));
+    Vector3d half(Rand::DblUniform(0, 3), Rand::DblUniform(0, 3),
+                  Rand::DblUniform(0, 3));
+    boxes.push_back(AxisAlignedBox(center - half, center + half));
+    boxes3.push_back(AxisAlignedBox3d(center - half, center + half));
+    centers.push_back(center);
+    radii.push_back(half.X());
+  }
+  // A default (empty) box.
+  boxes.push_back(AxisAlignedBox());
+  boxes3.push_back(AxisAlignedBox3d());
+
+  std::vector<uint64_t> visible;
+  std::vector<uint64_t> visible3;
+  std::vector<uint8_t> cache;
+  std::vector<uint8_t> cache3;
+
+  // Move the frustum around, so that the plane caches are reused.
+  for (int step = 0; step < 5; ++step)
+  {
+    frustum.SetPose(Pose3d(step * 0.5, 0, 2, 0, 0.2, 0.3 + 0.2 * step));
+
+    std::size_t count = frustum.Contains(boxes, visible, cache);
+    EXPECT_EQ(count, frustum.Contains(boxes3, visible3, cache3));
+    ASSERT_EQ((boxes.size() + 63) / 64, visible.size());
+    EXPECT_EQ(visible, visible3);
+    EXPECT_EQ(boxes.size(), cache.size());
+
+    std::size_t expectedCount = 0;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+      const bool expected = frustum.Contains(boxes[i]);
+      EXPECT_EQ(expected, Visible(visible, i)) << i;
+      expectedCount += expected;
+    }
+    EXPECT_EQ(expectedCount, count);
+    EXPECT_GT(count, 10u);
+    EXPECT_LT(count, boxes.size() - 10);
+
+    // Same result without the plane cache.
+    std::vector<uint64_t> uncached;
+    EXPECT_EQ(count, frustum.Contains(boxes, uncached));
+    EXPECT_EQ(visible, uncached);
+    EXPECT_EQ(count, frustum.Contains(boxes3, uncached));
+    EXPECT_EQ(visible, uncached);
+
+    // The sphere test is the plane test of Plane::Side with a radius.
+    count = frustum.Contains(centers, radii, visible, cache);
+    ASSERT_EQ((centers.size() + 63) / 64, visible.size());
+    EXPECT_EQ(count, frustum.Contains(centers, radii, uncached));
+    EXPECT_EQ(visible, uncached);
+    for (std::size_t i = 0; i < centers.size(); ++i)
+    {
+      bool expected = true;
+      for (int p = 0; p <= Frustum::FRUSTUM_PLANE_BOTTOM; ++p)
+      {
+        Planed plane = frustum.Plane(static_cast<Frustum::FrustumPlane>(p));
+        if (plane.Distance(centers[i]) < -radii[i])
+          expected = false;
+      }
+      EXPECT_EQ(expected, Visible(visible, i)) << i;
+    }
+  }
+
+  // Unused bits of the bitmask are zero.
+  EXPECT_EQ(0u, visible.back() >> (centers.size() % 64));
+
+  // Copies cull in the same way.
+  Frustum copy(frustum);
+  std::vector<uint64_t> copyVisible;
+  frustum.Contains(boxes, visible);
+  copy.Contains(boxes, copyVisible);
+  EXPECT_EQ(visible, copyVisible);
+  Frustum assigned;
+  assigned = frustum;
+  assigned.Contains(boxes, copyVisible);
+  EXPECT_EQ(visible, copyVisible);
+
+  // Empty batches and mismatched sizes.
+  EXPECT_EQ(0u, frustum.Contains(std::vector<AxisAlignedBox>(), visible));
+  EXPECT_TRUE(visible.empty());
+  radii.pop_back();
+  EXPECT_EQ(0u, frustum.Contains(centers, radii, visible));
+  EXPECT_TRUE(visible.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(FrustumTest, ContainsBatchSimdLevels)
+{
+  Rand::Seed(4321);
+
+  Frustum frustum(0.5, 30, IGN_PI_2, 1.5, Pose3d(1, 2, 3, 0.1, 0.2, 0.3));
+  std::vector<AxisAlignedBox3d> boxes;
+  std::vector<Vector3d> centers;
+  std::vector<double> radii;
+  for (int i = 0; i < 1000; ++i)
+  {
+    Vector3d center(Rand::DblUniform(-10, 35), Rand::DblUniform(-20, 20),
+                    Rand::DblUniform(-20, 20));
+    Vector3d half(Rand::DblUniform(0, 4), Rand::DblUniform(0, 4),
+                  Rand::DblUniform(0, 4));
+    boxes.push_back(AxisAlignedBox3d(center - half, center + half));
+    centers.push_back(center);
+    radii.push_back(half.Y());
+  }
+
+  // Every kernel the CPU supports culls in the same way.
+  const SimdLevel active = ActiveSimdLevel();
+  ASSERT_TRUE(SetActiveSimdLevel(SimdLevel::SCALAR));
+  std::vector<uint64_t> expectedBoxes;
+  std::vector<uint64_t> expectedSpheres;
+  frustum.Contains(boxes, expectedBoxes);
+  frustum.Contains(centers, radii, expectedSpheres);
+
+  for (const SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX,
+                                SimdLevel::AVX2, SimdLevel::AVX512,
+                                SimdLevel::NEON})
+  {
+    if (!SetActiveSimdLevel(level))
+      continue;
+    std::vector<uint64_t> visible;
+    frustum.Contains(boxes, visible);
+    EXPECT_EQ(expectedBoxes, visible) << SimdLevelName(level);
+    frustum.Contains(centers, radii, visible);
+    EXPECT_EQ(expectedSpheres, visible) << SimdLevelName(level);
+  }
+  EXPECT_TRUE(SetActiveSimdLevel(active));
+}
+
+//////////////////////////////////////////////////
+TEST(FrustumTest, ContainsBatchFloat)
+{
+  Rand::Seed(4321);
+
+  Frustum frustum;
+  frustum.SetNear(0.55);
+  frustum.SetFar(20);
+  frustum.SetFOV(1.05);
+  frustum.SetAspectRatio(1.8);
+  frustum.SetPose(Pose3d(0, 0, 2, 0, 0.2, 0.3));
+
+  // Single precision boxes and spheres cull as their double precision
+  // conversions do.
+  std::vector<AxisAlignedBox3f> boxesF;
+  std::vector<AxisAlignedBox3d> boxesD;
+  std::vector<Vector3f> centersF;
+  std::vector<Vector3d> centersD;
+  std::vector<float> radiiF;
+  std::vector<double> radiiD;
+  for (int i = 0; i < 1000; ++i)
+  {
+    const Vector3f center(
+        static_cast<float>(Rand::DblUniform(-5, 25)),
+        static_cast<float>(Rand::DblUniform(-15, 15)),
+        static_cast<float>(Rand::DblUniform(-10, 15)));
+    const Vector3f half(static_cast<float>(Rand::DblUniform(0, 3)),
+                        static_cast<float>(Rand::DblUniform(0, 3)),
+                        static_cast<float>(Rand::DblUniform(0, 3)));
+    const Vector3f lo = center - half;
+    const Vector3f hi = center + half;
+    boxesF.push_back(AxisAlignedBox3f(lo, hi));
+    boxesD.push_back(AxisAlignedBox3d(lo.X(), lo.Y(), lo.Z(),
+                                      hi.X(), hi.Y(), hi.Z()));
+    centersF.push_back(center);
+    centersD.push_back(Vector3d(center.X(), center.Y(), center.Z()));
+    radiiF.push_back(half.X());
+    radiiD.push_back(half.X());
+  }
+
+  std::vector<uint64_t> visibleF;
+  std::vector<uint64_t> visibleD;
+  std::vector<uint8_t> cacheF;
+  std::vector<uint8_t> cacheD;
+  for (int step = 0; step < 3; ++step)
+  {
+    frustum.SetPose(Pose3d(step * 0.5, 0, 2, 0, 0.2, 0.3 + 0.2 * step));
+
+    std::size_t count = frustum.Contains(boxesF, visibleF, cacheF);
+    EXPECT_EQ(count, frustum.Contains(boxesD, visibleD, cacheD));
+    EXPECT_EQ(visibleD, visibleF);
+    EXPECT_EQ(cacheD, cacheF);
+    EXPECT_EQ(count, frustum.Contains(boxesF, visibleF));
+    EXPECT_EQ(visibleD, visibleF);
+    EXPECT_GT(count, 10u);
+
+    count = frustum.Contains(centersF, radiiF, visibleF, cacheF);
+    EXPECT_EQ(count, frustum.Contains(centersD, radiiD, visibleD, cacheD));
+    EXPECT_EQ(visibleD, visibleF);
+    EXPECT_EQ(count, frustum.Contains(centersF, radiiF, visibleF));
+    EXPECT_EQ(visibleD, visibleF);
+  }
+
+  radiiF.pop_back();
+  EXPECT_EQ(0u, frustum.Contains(centersF, radiiF, visibleF));
+  EXPECT_TRUE(visibleF.empty());
+}
+
+//////////////////////////////////////////////////
+TEST(FrustumTest, CornersAndBounds)
+{
+  Frustum frustum;
+  frustum.SetNear(1);
+  frustum.SetFar(2);
+  frustum.SetFOV(IGN_DTOR(90));
+  frustum.SetAspectRatio(2);
+  frustum.SetPose(Pose3d(1, 0, 0, 0, 0, 0));
+
+  // The camera looks along +X, with +Z up and -Y to the right.
+  auto corners = frustum.Corners();
+  EXPECT_EQ(Vector3d(2, 1, 0.5), corners[0]);
+  EXPECT_EQ(Vector3d(2, -1, 0.5), corners[1]);
+  EXPECT_EQ(Vector3d(2, 1, -0.5), corners[2]);
+  EXPECT_EQ(Vector3d(2, -1, -0.5), corners[3]);
+  EXPECT_EQ(Vector3d(3, 2, 1), corners[4]);
+  EXPECT_EQ(Vector3d(3, -2, 1), corners[5]);
+  EXPECT_EQ(Vector3d(3, 2, -1), corners[6]);
+  EXPECT_EQ(Vector3d(3, -2, -1), corners[7]);
+  Vector3d centroid;
+  for (const auto &corner : corners)
+    centroid += corner / 8.0;
+  EXPECT_TRUE(frustum.Contains(centroid));
+
+  EXPECT_EQ(AxisAlignedBox(Vector3d(2, -2, -1), Vector3d(3, 2, 1)),
+            frustum.Bounds());
+
+  // The planes and corners follow property changes.
+  frustum.SetPose(Pose3d(0, 0, 0, 0, 0, IGN_PI * 0.5));
+  EXPECT_EQ(AxisAlignedBox(Vector3d(-2, 1, -1), Vector3d(2, 2, 1)),
+            frustum.Bounds());
+  EXPECT_EQ(Vector3d(0, 1, 0),
+            frustum.Plane(Frustum::FRUSTUM_PLANE_NEAR).Normal());
+  EXPECT_TRUE(frustum.Contains(Vector3d(0, 1.5, 0)));
+  EXPECT_FALSE(frustum.Contains(Vector3d(1.5, 0, 0)));
+
+  // Copies and assigned frustums get the same corners.
+  Frustum copy(frustum);
+  EXPECT_EQ(frustum.Corners(), copy.Corners());
+  EXPECT_EQ(frustum.Bounds(), copy.Bounds());
+  Frustum assigned;
+  assigned = frustum;
+  EXPECT_EQ(frustum.Corners(), assigned.Corners());
+  EXPECT_EQ(frustum.Bounds(), assigned.Bounds());
+
+  // Every box outside of the bounds is outside of the frustum.
+  Rand::Seed(42);
+  const AxisAlignedBox bounds = frustum.Bounds();
+  for (int i = 0; i < 1000; ++i)
+  {
+    Vector3d center(Rand::DblUniform(-4, 4), Rand::DblUniform(-4, 4),
+                    Rand::DblUniform(-4, 4));
+    AxisAlignedBox box(center - Vector3d(0.1, 0.1, 0.1),
+                       center + Vector3d(0.1, 0.1, 0.1));
+    if (frustum.Contains(box))
+    {
+      EXPECT_TRUE(bounds.Intersects(box));
+    }
+  }
+}
@@ -15,6 +15,10 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 #include <gz/math/GaussMarkovProcess.hh>
 #include <gz/math/Rand.hh>
 
@@ -37,6 +41,50 @@ class gz::math::GaussMarkovProcessPrivate
 
   /// \brief Process sigma value.
   public: double sigma{0};
+
+  /// \brief Method used to advance the process.
+  public: GaussMarkovProcess::DiscretizationType discretization{
+    GaussMarkovProcess::EULER};
+
+  /// \brief Time step of the cached exact coefficients, NaN if none.
+  public: double cachedDt{std::nan("")};
+
+  /// \brief Decay of the distance to mu over cachedDt.
+  public: double decay{1};
+
+  /// \brief Standard deviation of the exact noise over cachedDt.
+  public: double scale{0};
+
+  /// \brief Advance the process by a time step.
+  /// \param[in] _dt Time step in seconds.
+  /// \param[in] _normal Sample of the standard normal distribution.
+  /// \return The new value.
+  public: double Step(const double _dt, const double _normal)
+  {
+    if (this->discretization == GaussMarkovProcess::EULER)
+    {
+      this->value += this->theta * (this->mu - this->value) * _dt +
+        this->sigma * _normal;
+      return this->value;
+    }
+
+    // NaN marks an empty cache, and otherwise the cached time step must
+    // have the same bits.
+    if (std::isnan(this->cachedDt) ||
+        std::memcmp(&_dt, &this->cachedDt, sizeof(double)) != 0)
+    {
+      // expm1 keeps the precision of the variance for small theta * dt.
+      const double dt = std::max(0.0, _dt);
+      this->decay = std::exp(-this->theta * dt);
+      const double variance = this->theta > 0 ?
+        -std::expm1(-2.0 * this->theta * dt) / (2.0 * this->theta) : dt;
+      this->scale = this->sigma * std::sqrt(variance);
+      this->cachedDt = _dt;
+    }
+    this->value = this->mu + (this->value - this->mu) * this->decay +
+      this->scale * _normal;
+    return this->value;
+  }
 };
 
 //////////////////////////////////////////////////
@@ -66,6 +114,7 @@ void GaussMarkovProcess::Set(double _start, double _theta, double _mu,
   this->dataPtr->theta = std::max(0.0, _theta);
   this->dataPtr->mu = _mu;
   this->dataPtr->sigma = std::max(0.0, _sigma);
+  this->dataPtr->cachedDt = std::nan("");
   this->Reset();
 }
 
@@ -75,6 +124,20 @@ void GaussMarkovProcess::Reset()
   this->dataPtr->value = this->dataPtr->start;
 }
 
+//////////////////////////////////////////////////
+void GaussMarkovProcess::SetDiscretization(
+    DiscretizationType _discretization)
+{
+  this->dataPtr->discretization = _discretization;
+}
+
+//////////////////////////////////////////////////
+GaussMarkovProcess::DiscretizationType
+GaussMarkovProcess::Discretization() const
+{
+  return this->dataPtr->discretization;
+}
+
 //////////////////////////////////////////////////
 double GaussMarkovProcess::Start() const
 {
@@ -115,10 +178,20 @@ double GaussMarkovProcess::Update(const clock::duration &_dt)
 //////////////////////////////////////////////////
 double GaussMarkovProcess::Update(double _dt)
 {
-  this->dataPtr->value += this->dataPtr->theta *
-    (this->dataPtr->mu - this->dataPtr->value) * _dt +
-    this->dataPtr->sigma * Rand::DblNormal(0, 1);
+  return this->dataPtr->Step(_dt, Rand::DblNormal(0, 1));
+}
 
-  // Output the new value.
-  return this->dataPtr->value;
+//////////////////////////////////////////////////
+double GaussMarkovProcess::Update(const clock::duration &_dt,
+    PhiloxEngine &_engine)
+{
+  // Time difference in seconds
+  return this->Update(std::chrono::duration<double>(_dt).count(), _engine);
+}
+
+//////////////////////////////////////////////////
+double GaussMarkovProcess::Update(double _dt, PhiloxEngine &_engine)
+{
+  NormalRealDist d(0, 1);
+  return this->dataPtr->Step(_dt, d(_engine));
 }
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+
+#include <gz/math/GaussMarkovProcessEnsemble.hh>
+
+using namespace gz::math;
+
+//////////////////////////////////////////////////
+class gz::math::GaussMarkovProcessEnsemblePrivate
+{
+  /// \brief Current process values.
+  public: std::vector<double> values;
+
+  /// \brief Process start values.
+  public: std::vector<double> start;
+
+  /// \brief Process theta values.
+  public: std::vector<double> theta;
+
+  /// \brief Process mu values.
+  public: std::vector<double> mu;
+
+  /// \brief Process sigma values.
+  public: std::vector<double> sigma;
+
+  /// \brief Normal samples of the last update, kept to avoid allocating
+  /// them on every update.
+  public: std::vector<double> noise;
+
+  /// \brief Generator of the normal samples.
+  public: RandomGenerator generator;
+};
+
+//////////////////////////////////////////////////
+GaussMarkovProcessEnsemble::GaussMarkovProcessEnsemble()
+  : dataPtr(new GaussMarkovProcessEnsemblePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+GaussMarkovProcessEnsemble::GaussMarkovProcessEnsemble(std::size_t _size,
+    double _start, double _theta, double _mu, double _sigma)
+  : dataPtr(new GaussMarkovProcessEnsemblePrivate)
+{
+  this->Set(_size, _start, _theta, _mu, _sigma);
+}
+
+//////////////////////////////////////////////////
+GaussMarkovProcessEnsemble::GaussMarkovProcessEnsemble(
+    const GaussMarkovProcessEnsemble &_ensemble)
+  : dataPtr(new GaussMarkovProcessEnsemblePrivate(*_ensemble.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+GaussMarkovProcessEnsemble::~GaussMarkovProcessEnsemble()
+{
+}
+
+//////////////////////////////////////////////////
+GaussMarkovProcessEnsemble &GaussMarkovProcessEnsemble::operator=(
+    const GaussMarkovProcessEnsemble &_ensemble)
+{
+  *this->dataPtr = *_ensemble.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void GaussMarkovProcessEnsemble::Set(std::size_t _size, double _start,
+    double _theta, double _mu, double _sigma)
+{
+  this->dataPtr->start.assign(_size, _start);
+  this->dataPtr->theta.assign(_size, std::max(0.0, _theta));
+  this->dataPtr->mu.assign(_size, _mu);
+  this->dataPtr->sigma.assign(_size, std::max(0.0, _sigma));
+  this->dataPtr->noise.resize(_size);
+  this->Reset();
+}
+
+//////////////////////////////////////////////////
+bool GaussMarkovProcessEnsemble::Set(const std::vector<double> &_start,
+    const std::vector<double> &_theta, const std::vector<double> &_mu,
+    const std::vector<double> &_sigma)
+{
+  const std::size_t size = _start.size();
+  if (_theta.size() != size || _mu.size() != size || _sigma.size() != size)
+    return false;
+
+  auto nonNegative = [](double _v) {return std::max(0.0, _v);};
+  this->dataPtr->start = _start;
+  this->dataPtr->theta.resize(size);
+  std::transform(_theta.begin(), _theta.end(),
+                 this->dataPtr->theta.begin(), nonNegative);
+  this->dataPtr->mu = _mu;
+  this->dataPtr->sigma.resize(size);
+  std::transform(_sigma.begin(), _sigma.end(),
+                 this->dataPtr->sigma.begin(), nonNegative);
+  this->dataPtr->noise.resize(size);
+  this->Reset();
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::size_t GaussMarkovProcessEnsemble::Size() const
+{
+  return this->dataPtr->values.size();
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessEnsemble::Start() const
+{
+  return this->dataPtr->start;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessEnsemble::Values() const
+{
+  return this->dataPtr->values;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessEnsemble::Theta() const
+{
+  return this->dataPtr->theta;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessEnsemble::Mu() const
+{
+  return this->dataPtr->mu;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessEnsemble::Sigma() const
+{
+  return this->dataPtr->sigma;
+}
+
+//////////////////////////////////////////////////
+RandomGenerator &GaussMarkovProcessEnsemble::Generator()
+{
+  return this->dataPtr->generator;
+}
+
+//////////////////////////////////////////////////
+void GaussMarkovProcessEnsemble::Reset()
+{
+  this->dataPtr->values = this->dataPtr->start;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessEnsemble::Update(
+    const clock::duration &_dt)
+{
+  // Time difference in seconds
+  return this->Update(std::chrono::duration<double>(_dt).count());
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessEnsemble::Update(double _dt)
+{
+  const std::size_t size = this->dataPtr->values.size();
+
+  // Draw the samples of all the processes at once, so that the normal
+  // distribution state is kept between them.
+  this->dataPtr->generator.FillNormal(this->dataPtr->noise.data(), size);
+
+  double *value = this->dataPtr->values.data();
+  const double *theta = this->dataPtr->theta.data();
+  const double *mu = this->dataPtr->mu.data();
+  const double *sigma = this->dataPtr->sigma.data();
+  const double *noise = this->dataPtr->noise.data();
+  for (std::size_t i = 0; i < size; ++i)
+    value[i] += theta[i] * (mu[i] - value[i]) * _dt + sigma[i] * noise[i];
+
+  // Output the new values.
+  return this->dataPtr->values;
+}
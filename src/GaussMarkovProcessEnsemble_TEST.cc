@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gz/math/GaussMarkovProcess.hh"
+#include "gz/math/GaussMarkovProcessEnsemble.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(GaussMarkovProcessEnsembleTest, Set)
+{
+  GaussMarkovProcessEnsemble empty;
+  EXPECT_EQ(0u, empty.Size());
+  EXPECT_TRUE(empty.Update(0.1).empty());
+
+  // Shared parameters, with negative theta and sigma clamped to zero
+  GaussMarkovProcessEnsemble ensemble(3, 1.5, -1.0, 2.0, -0.5);
+  EXPECT_EQ(3u, ensemble.Size());
+  EXPECT_EQ(std::vector<double>(3, 1.5), ensemble.Start());
+  EXPECT_EQ(std::vector<double>(3, 1.5), ensemble.Values());
+  EXPECT_EQ(std::vector<double>(3, 0.0), ensemble.Theta());
+  EXPECT_EQ(std::vector<double>(3, 2.0), ensemble.Mu());
+  EXPECT_EQ(std::vector<double>(3, 0.0), ensemble.Sigma());
+
+  // Per process parameters
+  EXPECT_TRUE(ensemble.Set({0, 1}, {1, -2}, {3, 4}, {-5, 6}));
+  EXPECT_EQ(2u, ensemble.Size());
+  EXPECT_EQ(std::vector<double>({0, 1}), ensemble.Values());
+  EXPECT_EQ(std::vector<double>({1, 0}), ensemble.Theta());
+  EXPECT_EQ(std::vector<double>({3, 4}), ensemble.Mu());
+  EXPECT_EQ(std::vector<double>({0, 6}), ensemble.Sigma());
+
+  // Mismatched sizes are rejected
+  EXPECT_FALSE(ensemble.Set({0, 1}, {1}, {3, 4}, {5, 6}));
+  EXPECT_EQ(2u, ensemble.Size());
+  EXPECT_EQ(std::vector<double>({1, 0}), ensemble.Theta());
+
+  // Reset restores the start values
+  ensemble.Update(0.1);
+  EXPECT_NE(std::vector<double>({0, 1}), ensemble.Values());
+  ensemble.Reset();
+  EXPECT_EQ(std::vector<double>({0, 1}), ensemble.Values());
+}
+
+/////////////////////////////////////////////////
+TEST(GaussMarkovProcessEnsembleTest, MatchesProcess)
+{
+  // Without noise each process follows GaussMarkovProcess exactly
+  GaussMarkovProcess gmp(-1.2, 1.0, 2.5, 0);
+  GaussMarkovProcessEnsemble ensemble(4, -1.2, 1.0, 2.5, 0);
+  clock::duration dt = std::chrono::milliseconds(100);
+  for (int i = 0; i < 200; ++i)
+  {
+    const double expected = gmp.Update(dt);
+    for (double value : ensemble.Update(dt))
+      EXPECT_DOUBLE_EQ(expected, value);
+  }
+  EXPECT_NEAR(2.5, ensemble.Values()[0], 1e-4);
+
+  // With noise, each process uses the next sample of the generator
+  const std::vector<double> start = {20.2, -3.0, 0.0};
+  const std::vector<double> theta = {0.1, 1.0, 0.0};
+  const std::vector<double> mu = {0.0, 2.0, 5.0};
+  const std::vector<double> sigma = {0.5, 0.0, 2.0};
+  EXPECT_TRUE(ensemble.Set(start, theta, mu, sigma));
+  ensemble.Generator().Seed(1001);
+  RandomGenerator reference(1001);
+
+  std::vector<double> expected = start;
+  for (int i = 0; i < 100; ++i)
+  {
+    for (std::size_t j = 0; j < expected.size(); ++j)
+    {
+      expected[j] += theta[j] * (mu[j] - expected[j]) * 0.01 +
+        sigma[j] * reference.DblNormal();
+    }
+    const std::vector<double> &values = ensemble.Update(0.01);
+    for (std::size_t j = 0; j < expected.size(); ++j)
+      EXPECT_DOUBLE_EQ(expected[j], values[j]);
+  }
+
+  // Copies continue the same sequence
+  GaussMarkovProcessEnsemble copy(ensemble);
+  EXPECT_EQ(ensemble.Update(0.01), copy.Update(0.01));
+}
+
+/////////////////////////////////////////////////
+TEST(GaussMarkovProcessEnsembleTest, Stationary)
+{
+  // The processes reach the stationary distribution of the discrete
+  // update, which has a mean of mu and a variance of
+  // sigma^2 / (1 - (1 - theta * dt)^2).
+  const double theta = 2.0;
+  const double mu = -1.0;
+  const double sigma = 0.3;
+  const double dt = 0.1;
+  GaussMarkovProcessEnsemble ensemble(20000, 10.0, theta, mu, sigma);
+  ensemble.Generator().Seed(7);
+  for (int i = 0; i < 100; ++i)
+    ensemble.Update(dt);
+
+  double sum = 0, sumSq = 0;
+  for (double value : ensemble.Values())
+  {
+    sum += value;
+    sumSq += value * value;
+  }
+  const double mean = sum / ensemble.Size();
+  const double variance = sumSq / ensemble.Size() - mean * mean;
+  const double decay = 1.0 - theta * dt;
+  EXPECT_NEAR(mu, mean, 0.01);
+  EXPECT_NEAR(sigma * sigma / (1.0 - decay * decay), variance, 0.01);
+}
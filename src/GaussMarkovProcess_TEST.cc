@@ -17,8 +17,12 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cmath>
+
 #include "gz/math/GaussMarkovProcess.hh"
 #include "gz/math/Helpers.hh"
+#include "gz/math/PhiloxEngine.hh"
 #include "gz/math/Rand.hh"
 
 using namespace gz;
@@ -103,3 +107,79 @@ TEST(GaussMarkovProcessTest, Noise)
   EXPECT_NEAR(-4.118732, gmp.Value(), 1e-4);
 #endif
 }
+
+/////////////////////////////////////////////////
+TEST(GaussMarkovProcessTest, ExactDiscretization)
+{
+  GaussMarkovProcess gmp(-1.2, 0.5, 2.5, 0);
+  EXPECT_EQ(GaussMarkovProcess::EULER, gmp.Discretization());
+  gmp.SetDiscretization(GaussMarkovProcess::EXACT);
+  EXPECT_EQ(GaussMarkovProcess::EXACT, gmp.Discretization());
+
+  // Without noise, one long step is the closed form solution, as are many
+  // short ones.
+  const double expected = 2.5 + (-1.2 - 2.5) * std::exp(-0.5 * 3.0);
+  EXPECT_NEAR(expected, gmp.Update(3.0), 1e-12);
+  gmp.Reset();
+  for (int i = 0; i < 300; ++i)
+    gmp.Update(std::chrono::milliseconds(10));
+  EXPECT_NEAR(expected, gmp.Value(), 1e-12);
+
+  // Set keeps the discretization, but not the cached coefficients.
+  gmp.Set(0.0, 2.0, 1.0, 0);
+  EXPECT_EQ(GaussMarkovProcess::EXACT, gmp.Discretization());
+  EXPECT_NEAR(1.0 - std::exp(-2.0 * 3.0), gmp.Update(3.0), 1e-12);
+
+  // A zero step leaves the value unchanged.
+  EXPECT_NEAR(1.0 - std::exp(-2.0 * 3.0), gmp.Update(0.0), 1e-12);
+}
+
+/////////////////////////////////////////////////
+TEST(GaussMarkovProcessTest, ExactStatistics)
+{
+  // Moments of many processes after 2 seconds, updated in steps of 1 ms
+  // or in a single step, against the exact mean and variance.
+  const double theta = 0.8;
+  const double sigma = 0.6;
+  const double t = 2.0;
+  const double mean = 1.0 + (5.0 - 1.0) * std::exp(-theta * t);
+  const double variance = sigma * sigma *
+    (1.0 - std::exp(-2.0 * theta * t)) / (2.0 * theta);
+  const int count = 4000;
+
+  for (const int steps : {1, 2000})
+  {
+    double sum = 0;
+    double sumSq = 0;
+    for (int i = 0; i < count; ++i)
+    {
+      PhiloxEngine engine(1234, i);
+      GaussMarkovProcess gmp(5.0, theta, 1.0, sigma);
+      gmp.SetDiscretization(GaussMarkovProcess::EXACT);
+      for (int s = 0; s < steps; ++s)
+        gmp.Update(t / steps, engine);
+      sum += gmp.Value();
+      sumSq += gmp.Value() * gmp.Value();
+    }
+    const double sampleMean = sum / count;
+    const double sampleVariance = sumSq / count - sampleMean * sampleMean;
+
+    // About 4 standard errors.
+    EXPECT_NEAR(mean, sampleMean, 4.0 * std::sqrt(variance / count));
+    EXPECT_NEAR(variance, sampleVariance,
+        4.0 * variance * std::sqrt(2.0 / count));
+  }
+
+  // Without mean reversion, the process is a random walk.
+  double sumSq = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    PhiloxEngine engine(99, i);
+    GaussMarkovProcess gmp(0.0, 0.0, 0.0, sigma);
+    gmp.SetDiscretization(GaussMarkovProcess::EXACT);
+    const double value = gmp.Update(t, engine);
+    sumSq += value * value;
+  }
+  EXPECT_NEAR(sigma * sigma * t, sumSq / count,
+      4.0 * sigma * sigma * t * std::sqrt(2.0 / count));
+}
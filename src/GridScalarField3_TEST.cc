@@ -0,0 +1,347 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gz/math/AdditivelySeparableScalarField3.hh"
+#include "gz/math/Executor.hh"
+#include "gz/math/GridScalarField3.hh"
+#include "gz/math/MeshMassProperties.hh"
+#include "gz/math/PiecewiseScalarField3.hh"
+#include "gz/math/Polynomial3.hh"
+
+using namespace gz;
+
+/// \brief Fill the nodes of a field with a function of their position.
+/// \param[in,out] _field The field.
+/// \param[in] _func The function.
+template<typename Func>
+static void Fill(math::GridScalarField3d &_field, const Func &_func)
+{
+  for (std::size_t k = 0; k < _field.NodeCountZ(); ++k)
+  {
+    for (std::size_t j = 0; j < _field.NodeCountY(); ++j)
+    {
+      for (std::size_t i = 0; i < _field.NodeCountX(); ++i)
+        _field.SetValue(i, j, k, _func(_field.Node(i, j, k)));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(GridScalarField3Test, Construction)
+{
+  const auto region = math::Region3d::Closed(0., -1., 2., 4., 1., 3.);
+  math::GridScalarField3d field(region, 5, 3, 2, 7.);
+  ASSERT_TRUE(field.Valid());
+  EXPECT_EQ(region, field.Region());
+  EXPECT_EQ(5u, field.NodeCountX());
+  EXPECT_EQ(3u, field.NodeCountY());
+  EXPECT_EQ(2u, field.NodeCountZ());
+  EXPECT_EQ(math::Vector3d(1., 1., 1.), field.Spacing());
+  EXPECT_EQ(30u, field.Values().size());
+  EXPECT_EQ(math::Vector3d(3., 0., 3.), field.Node(3, 1, 1));
+  EXPECT_EQ(3u + 5u * (1u + 3u * 1u), field.Index(3, 1, 1));
+  EXPECT_DOUBLE_EQ(7., field.Value(3, 1, 1));
+  field.SetValue(3, 1, 1, -2.);
+  EXPECT_DOUBLE_EQ(-2., field.Values()[field.Index(3, 1, 1)]);
+  EXPECT_EQ(math::GridScalarField3d::TRILINEAR, field.Interpolation());
+
+  std::ostringstream os;
+  os << field;
+  EXPECT_EQ(0u, os.str().find("grid 5x3x2 over "));
+
+  // Invalid fields are undefined everywhere.
+  EXPECT_FALSE(math::GridScalarField3d().Valid());
+  EXPECT_TRUE(std::isnan(math::GridScalarField3d()(math::Vector3d::Zero)));
+  EXPECT_FALSE(math::GridScalarField3d(region, 1, 3, 2).Valid());
+  EXPECT_FALSE(math::GridScalarField3d(
+      math::Region3d::Unbounded, 2, 2, 2).Valid());
+  EXPECT_FALSE(math::GridScalarField3d(
+      math::Region3d::Closed(0., 0., 0., 1., 0., 1.), 2, 2, 2).Valid());
+}
+
+/////////////////////////////////////////////////
+TEST(GridScalarField3Test, Trilinear)
+{
+  // A trilinear function is reproduced exactly.
+  auto func = [](const math::Vector3d &_p)
+  {
+    return 1. + 2. * _p.X() - _p.Y() + 0.5 * _p.Z() +
+        0.25 * _p.X() * _p.Y() * _p.Z();
+  };
+  math::GridScalarField3d field(
+      math::Region3d::Closed(-1., -2., 0., 3., 2., 1.), 9, 5, 4);
+  Fill(field, func);
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> ux(-1., 3.), uy(-2., 2.),
+      uz(0., 1.);
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 200; ++i)
+  {
+    points.emplace_back(ux(rng), uy(rng), uz(rng));
+    EXPECT_NEAR(func(points.back()), field(points.back()), 1e-12);
+  }
+
+  // On the bounds and outside.
+  EXPECT_NEAR(func(math::Vector3d(3., 2., 1.)),
+              field(math::Vector3d(3., 2., 1.)), 1e-12);
+  EXPECT_NEAR(func(math::Vector3d(-1., -2., 0.)),
+              field(math::Vector3d(-1., -2., 0.)), 1e-12);
+  EXPECT_TRUE(std::isnan(field(math::Vector3d(3.1, 0., 0.5))));
+  EXPECT_TRUE(std::isnan(field(math::Vector3d(0., 0., math::NAN_D))));
+
+  // The batch gives the same values.
+  points.emplace_back(5., 0., 0.);
+  std::vector<double> values(points.size());
+  field.Evaluate(points.data(), points.size(), values.data());
+  for (std::size_t i = 0; i + 1 < points.size(); ++i)
+    EXPECT_DOUBLE_EQ(field(points[i]), values[i]);
+  EXPECT_TRUE(std::isnan(values.back()));
+}
+
+/////////////////////////////////////////////////
+TEST(GridScalarField3Test, Tricubic)
+{
+  // Catmull-Rom interpolation reproduces quadratic functions away from
+  // the bounds, and converges faster than trilinear interpolation.
+  auto quadratic = [](const math::Vector3d &_p)
+  {
+    return _p.X() * _p.X() - 2. * _p.Y() * _p.Z() + _p.Z();
+  };
+  math::GridScalarField3d field(
+      math::Region3d::Closed(0., 0., 0., 4., 4., 4.), 9, 9, 9);
+  Fill(field, quadratic);
+  field.SetInterpolation(math::GridScalarField3d::TRICUBIC);
+  EXPECT_EQ(math::GridScalarField3d::TRICUBIC, field.Interpolation());
+  const math::Vector3d inner(1.3, 2.2, 1.7);
+  EXPECT_NEAR(quadratic(inner), field(inner), 1e-12);
+
+  auto smooth = [](const math::Vector3d &_p)
+  {
+    return std::sin(_p.X()) * std::cos(_p.Y()) + std::sin(_p.Z());
+  };
+  Fill(field, smooth);
+  double cubicError = 0.;
+  double linearError = 0.;
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<double> u(0.5, 3.5);
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 200; ++i)
+  {
+    points.emplace_back(u(rng), u(rng), u(rng));
+    const double expected = smooth(points.back());
+    field.SetInterpolation(math::GridScalarField3d::TRICUBIC);
+    cubicError = std::max(cubicError,
+                          std::abs(field(points.back()) - expected));
+    field.SetInterpolation(math::GridScalarField3d::TRILINEAR);
+    linearError = std::max(linearError,
+                           std::abs(field(points.back()) - expected));
+  }
+  EXPECT_LT(cubicError, 0.5 * linearError);
+
+  // Nodes are interpolated exactly, including on the bounds.
+  field.SetInterpolation(math::GridScalarField3d::TRICUBIC);
+  EXPECT_NEAR(field.Value(8, 0, 3), field(field.Node(8, 0, 3)), 1e-12);
+
+  std::vector<double> values(points.size());
+  field.Evaluate(points.data(), points.size(), values.data());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_DOUBLE_EQ(field(points[i]), values[i]);
+}
+
+/////////////////////////////////////////////////
+TEST(GridScalarField3Test, Minimum)
+{
+  math::GridScalarField3d field(
+      math::Region3d::Closed(0., 0., 0., 2., 2., 2.), 3, 3, 3, 1.);
+  field.SetValue(1, 2, 0, -3.);
+
+  math::Vector3d pMin;
+  EXPECT_DOUBLE_EQ(-3., field.Minimum(pMin));
+  EXPECT_EQ(math::Vector3d(1., 2., 0.), pMin);
+
+  // Between nodes, the minimum is on the bounds of the region.
+  EXPECT_DOUBLE_EQ(-2., field.Minimum(
+      math::Region3d::Closed(0.5, 1., 0.25, 1.5, 2., 0.5), pMin));
+  EXPECT_EQ(math::Vector3d(1., 2., 0.25), pMin);
+  EXPECT_DOUBLE_EQ(-1., field.Minimum(
+      math::Region3d::Closed(0., 1.5, 0., 0.5, 3., 1.), pMin));
+  EXPECT_EQ(math::Vector3d(0.5, 2., 0.), pMin);
+
+  EXPECT_TRUE(std::isnan(field.Minimum(
+      math::Region3d::Closed(3., 3., 3., 4., 4., 4.), pMin)));
+  EXPECT_FALSE(pMin.IsFinite());
+  EXPECT_TRUE(std::isnan(math::GridScalarField3d().Minimum()));
+}
+
+/////////////////////////////////////////////////
+TEST(GridScalarField3Test, Piecewise)
+{
+  // Grids as pieces of a piecewise field.
+  using FieldT = math::PiecewiseScalarField3d<math::GridScalarField3d>;
+  math::GridScalarField3d low(
+      math::Region3d::Closed(0., 0., 0., 1., 1., 1.), 2, 2, 2, 1.);
+  math::GridScalarField3d high(
+      math::Region3d(math::Intervald::Open(1., 2.),
+                     math::Intervald::Closed(0., 1.),
+                     math::Intervald::Closed(0., 1.)), 3, 2, 2, 4.);
+  high.SetValue(2, 1, 1, -2.);
+  const FieldT field({{low.Region(), low}, {high.Region(), high}});
+
+  EXPECT_DOUBLE_EQ(1., field(math::Vector3d(0.5, 0.5, 0.5)));
+  EXPECT_DOUBLE_EQ(1., field(math::Vector3d(1., 0.5, 0.5)));
+  EXPECT_DOUBLE_EQ(4., field(math::Vector3d(1.25, 0.5, 0.)));
+  EXPECT_TRUE(std::isnan(field(math::Vector3d(2.5, 0.5, 0.5))));
+
+  math::Vector3d pMin;
+  EXPECT_DOUBLE_EQ(-2., field.Minimum(pMin));
+  EXPECT_EQ(math::Vector3d(2., 1., 1.), pMin);
+
+  std::ostringstream os;
+  os << field;
+  EXPECT_NE(std::string::npos, os.str().find("grid 3x2x2"));
+}
+
+/////////////////////////////////////////////////
+TEST(GridScalarField3Test, Sample)
+{
+  // A separable field is sampled with its batch evaluation.
+  using SeparableT = math::AdditivelySeparableScalarField3d<
+      math::Polynomial3d>;
+  const SeparableT separable(
+      2., math::Polynomial3d(math::Vector4d(0., 0., 1., 0.)),
+      math::Polynomial3d(math::Vector4d(0., 1., 0., 0.)),
+      math::Polynomial3d(math::Vector4d(0., 0., -1., 3.)));
+  const auto region = math::Region3d::Closed(-1., -2., 0., 3., 2., 1.);
+  math::GridScalarField3d field(region, 41, 33, 17);
+  field.Sample(separable);
+  for (std::size_t k = 0; k < field.NodeCountZ(); k += 4)
+  {
+    for (std::size_t j = 0; j < field.NodeCountY(); j += 4)
+    {
+      for (std::size_t i = 0; i < field.NodeCountX(); i += 4)
+      {
+        EXPECT_DOUBLE_EQ(separable(field.Node(i, j, k)),
+                         field.Value(i, j, k));
+      }
+    }
+  }
+
+  // The values don't depend on the number of threads.
+  for (const unsigned int threads : {0u, 3u})
+  {
+    math::GridScalarField3d parallel(region, 41, 33, 17);
+    parallel.Sample(separable, threads);
+    EXPECT_EQ(field.Values(), parallel.Values());
+  }
+  math::ThreadPool pool(3);
+  math::GridScalarField3d pooled(region, 41, 33, 17);
+  pooled.Sample(separable, pool);
+  EXPECT_EQ(field.Values(), pooled.Values());
+
+  // Fields without batch evaluation, and piecewise fields.
+  auto func = [](const math::Vector3d &_p)
+  {
+    return _p.X() - _p.Z();
+  };
+  field.Sample(func, 2);
+  EXPECT_DOUBLE_EQ(2., field.Value(40, 16, 16));
+  using PiecewiseT = math::PiecewiseScalarField3d<SeparableT>;
+  const PiecewiseT piecewise({{math::Region3d::Closed(
+      0., -2., 0., 3., 2., 1.), separable}});
+  field.Sample(piecewise);
+  EXPECT_TRUE(std::isnan(field.Value(0, 0, 0)));
+  EXPECT_DOUBLE_EQ(separable(field.Node(40, 0, 0)), field.Value(40, 0, 0));
+}
+
+/////////////////////////////////////////////////
+TEST(GridScalarField3Test, IsoSurface)
+{
+  // The level set of a signed distance is a closed surface around its
+  // volume.
+  const double radius = 1.2;
+  auto sphere = [radius](const math::Vector3d &_p)
+  {
+    return _p.Length() - radius;
+  };
+  math::GridScalarField3d field(
+      math::Region3d::Closed(-2., -2., -2., 2., 2., 2.), 41, 41, 41);
+  field.Sample(sphere, 4);
+
+  std::vector<math::Vector3d> vertices;
+  std::vector<std::size_t> indices;
+  field.IsoSurface(0., vertices, indices);
+  ASSERT_FALSE(indices.empty());
+  ASSERT_EQ(0u, indices.size() % 3);
+  for (const auto &vertex : vertices)
+    EXPECT_NEAR(radius, vertex.Length(), 0.01);
+
+  // Each directed edge appears once, and its reverse once.
+  std::map<std::pair<std::size_t, std::size_t>, int> edges;
+  for (std::size_t t = 0; t < indices.size(); t += 3)
+  {
+    for (int e = 0; e < 3; ++e)
+      ++edges[{indices[t + e], indices[t + (e + 1) % 3]}];
+  }
+  for (const auto &edge : edges)
+  {
+    EXPECT_EQ(1, edge.second);
+    EXPECT_EQ(1u, edges.count({edge.first.second, edge.first.first}));
+  }
+  EXPECT_EQ(2, static_cast<int>(vertices.size()) -
+               static_cast<int>(edges.size() / 2) +
+               static_cast<int>(indices.size() / 3));
+
+  // Chords of the sphere cut off a little of its volume.
+  math::MeshMassPropertiesd props;
+  props.AddTriangles(vertices.data(), indices.data(), indices.size() / 3);
+  EXPECT_NEAR(4. / 3. * IGN_PI * radius * radius * radius, props.Volume(),
+              0.05);
+
+  // Ambiguous configurations stay closed: two spheres touching at a cell.
+  auto pair = [](const math::Vector3d &_p)
+  {
+    return std::min((_p - math::Vector3d(-0.75, 0., 0.)).Length(),
+                    (_p - math::Vector3d(0.75, 0.1, 0.1)).Length()) - 0.8;
+  };
+  field.Sample(pair);
+  field.IsoSurface(0., vertices, indices);
+  edges.clear();
+  for (std::size_t t = 0; t < indices.size(); t += 3)
+  {
+    for (int e = 0; e < 3; ++e)
+      ++edges[{indices[t + e], indices[t + (e + 1) % 3]}];
+  }
+  for (const auto &edge : edges)
+    EXPECT_EQ(1u, edges.count({edge.first.second, edge.first.first}));
+
+  // No surface where the field doesn't cross the value.
+  field.IsoSurface(10., vertices, indices);
+  EXPECT_TRUE(vertices.empty());
+  EXPECT_TRUE(indices.empty());
+  math::GridScalarField3d().IsoSurface(0., vertices, indices);
+  EXPECT_TRUE(indices.empty());
+}
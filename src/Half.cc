@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+
+#include "gz/math/Half.hh"
+
+// Select the instruction set used by the array conversions.
+// Define IGNITION_MATH_DISABLE_SIMD to always use the portable scalar code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define IGNITION_MATH_HALF_SSE2 1
+    #include <emmintrin.h>
+  #endif
+#endif
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+#ifdef IGNITION_MATH_HALF_SSE2
+  /// \brief Convert groups of eight floats to halves, with the same
+  /// results as Half::FloatToBits.
+  /// \param[in] _in Values to convert.
+  /// \param[in] _count Number of values.
+  /// \param[out] _out Converted values.
+  /// \return Number of values converted, a multiple of eight.
+  std::size_t FromFloatSse2(const float *_in, const std::size_t _count,
+                            Half *_out)
+  {
+    const __m128i f16Max = _mm_set1_epi32((127 + 16) << 23);
+    const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+    const __m128i subnormMagic =
+      _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i normalBias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+    const __m128i nanBit = _mm_set1_epi32(0x200);
+    const __m128i infinity = _mm_set1_epi32(0x7c00);
+    const __m128 signMask = _mm_castsi128_ps(
+        _mm_set1_epi32(static_cast<int>(0x80000000u)));
+
+    auto convert = [&](const __m128 _f)
+    {
+      const __m128 sign = _mm_and_ps(_f, signMask);
+      const __m128 absF = _mm_xor_ps(_f, sign);
+      const __m128i absI = _mm_castps_si128(absF);
+
+      // Infinity and NaN, where NaN sets the quiet bit.
+      const __m128i isNan = _mm_castps_si128(_mm_cmpunord_ps(absF, absF));
+      const __m128i special =
+        _mm_or_si128(_mm_and_si128(isNan, nanBit), infinity);
+      const __m128i isRegular = _mm_cmpgt_epi32(f16Max, absI);
+
+      // Subnormal results, rounded by a float addition.
+      const __m128i isSub = _mm_cmpgt_epi32(minNormal, absI);
+      const __m128i sub = _mm_sub_epi32(_mm_castps_si128(
+          _mm_add_ps(absF, _mm_castsi128_ps(subnormMagic))), subnormMagic);
+
+      // Normal results, where subtracting -1 when the mantissa is odd
+      // rounds ties to even.
+      const __m128i mantOdd =
+        _mm_srai_epi32(_mm_slli_epi32(absI, 31 - 13), 31);
+      const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(
+          _mm_add_epi32(absI, normalBias), mantOdd), 13);
+
+      const __m128i finite = _mm_or_si128(_mm_and_si128(isSub, sub),
+                                          _mm_andnot_si128(isSub, normal));
+      const __m128i bits = _mm_or_si128(_mm_and_si128(isRegular, finite),
+                                        _mm_andnot_si128(isRegular, special));
+
+      // The arithmetic shift sets the high bits of negative values, so
+      // that the signed saturating pack keeps the low 16 bits.
+      return _mm_or_si128(bits,
+          _mm_srai_epi32(_mm_castps_si128(sign), 16));
+    };
+
+    std::size_t i = 0;
+    for (; i + 8 <= _count; i += 8)
+    {
+      const __m128i lo = convert(_mm_loadu_ps(_in + i));
+      const __m128i hi = convert(_mm_loadu_ps(_in + i + 4));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(_out + i),
+                       _mm_packs_epi32(lo, hi));
+    }
+    return i;
+  }
+
+  /// \brief Convert groups of eight halves to floats, with the same
+  /// results as Half::BitsToFloat.
+  /// \param[in] _in Values to convert.
+  /// \param[in] _count Number of values.
+  /// \param[out] _out Converted values.
+  /// \return Number of values converted, a multiple of eight.
+  std::size_t ToFloatSse2(const Half *_in, const std::size_t _count,
+                          float *_out)
+  {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i noSign = _mm_set1_epi32(0x7fff);
+    const __m128i maxFinite = _mm_set1_epi32(0x7bff);
+    const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+    const __m128i infExp = _mm_set1_epi32(255 << 23);
+
+    auto convert = [&](const __m128i _h)
+    {
+      const __m128i expMant = _mm_and_si128(_h, noSign);
+      const __m128i sign = _mm_slli_epi32(_mm_xor_si128(_h, expMant), 16);
+
+      // Shifting the exponent and mantissa into place and multiplying by
+      // 2^112 rebiases the exponent, and normalizes subnormal values.
+      const __m128 scaled = _mm_mul_ps(
+          _mm_castsi128_ps(_mm_slli_epi32(expMant, 13)), magic);
+
+      // Infinity and NaN keep an all ones exponent.
+      const __m128i special =
+        _mm_and_si128(_mm_cmpgt_epi32(expMant, maxFinite), infExp);
+      return _mm_or_ps(scaled,
+          _mm_castsi128_ps(_mm_or_si128(sign, special)));
+    };
+
+    std::size_t i = 0;
+    for (; i + 8 <= _count; i += 8)
+    {
+      const __m128i h =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(_in + i));
+      _mm_storeu_ps(_out + i, convert(_mm_unpacklo_epi16(h, zero)));
+      _mm_storeu_ps(_out + i + 4, convert(_mm_unpackhi_epi16(h, zero)));
+    }
+    return i;
+  }
+#endif
+}
+
+//////////////////////////////////////////////////
+void Half::FromFloat(const float *_in, const std::size_t _count, Half *_out)
+{
+  std::size_t i = 0;
+#ifdef IGNITION_MATH_HALF_SSE2
+  i = FromFloatSse2(_in, _count, _out);
+#endif
+  for (; i < _count; ++i)
+    _out[i] = Half(_in[i]);
+}
+
+//////////////////////////////////////////////////
+void Half::ToFloat(const Half *_in, const std::size_t _count, float *_out)
+{
+  std::size_t i = 0;
+#ifdef IGNITION_MATH_HALF_SSE2
+  i = ToFloatSse2(_in, _count, _out);
+#endif
+  for (; i < _count; ++i)
+    _out[i] = _in[i].Float();
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "gz/math/Half.hh"
+
+using namespace gz;
+
+/// \brief Get the bits of a float.
+/// \param[in] _f Float value.
+/// \return The bits.
+static uint32_t FloatBits(const float _f)
+{
+  uint32_t u;
+  std::memcpy(&u, &_f, sizeof(u));
+  return u;
+}
+
+/////////////////////////////////////////////////
+TEST(HalfTest, Construct)
+{
+  math::Half zero;
+  EXPECT_EQ(0u, zero.Bits());
+  EXPECT_EQ(0.0f, zero.Float());
+
+  math::Half one(1.0f);
+  EXPECT_EQ(0x3c00u, one.Bits());
+  EXPECT_EQ(1.0f, static_cast<float>(one));
+  EXPECT_EQ(one, math::Half::FromBits(0x3c00));
+  EXPECT_NE(one, zero);
+
+  EXPECT_EQ(0xc000u, math::Half(-2.0f).Bits());
+  EXPECT_EQ(0x3555u, math::Half(1.0f / 3.0f).Bits());
+  EXPECT_EQ(0x8000u, math::Half(-0.0f).Bits());
+
+  static_assert(math::Half::FromBits(0x3c00).Bits() == 0x3c00,
+                "FromBits is constexpr");
+}
+
+/////////////////////////////////////////////////
+TEST(HalfTest, Rounding)
+{
+  // Largest finite value, and rounding to infinity above it.
+  EXPECT_EQ(0x7bffu, math::Half(math::Half::Max).Bits());
+  EXPECT_EQ(math::Half::Max, math::Half::FromBits(0x7bff).Float());
+  EXPECT_EQ(0x7bffu, math::Half(65519.0f).Bits());
+  EXPECT_EQ(0x7c00u, math::Half(65520.0f).Bits());
+  EXPECT_EQ(0xfc00u, math::Half(-1e10f).Bits());
+
+  // Ties round to even.
+  EXPECT_EQ(0x3c00u, math::Half(1.0f + std::ldexp(1.0f, -11)).Bits());
+  EXPECT_EQ(0x3c02u, math::Half(1.0f + 3 * std::ldexp(1.0f, -11)).Bits());
+  EXPECT_EQ(0x3c01u, math::Half(1.0f + 1.01f * std::ldexp(1.0f, -11)).Bits());
+
+  // Subnormal values.
+  EXPECT_EQ(0x0001u, math::Half(std::ldexp(1.0f, -24)).Bits());
+  EXPECT_EQ(0x0000u, math::Half(std::ldexp(1.0f, -25)).Bits());
+  EXPECT_EQ(0x0001u, math::Half(1.5f * std::ldexp(1.0f, -25)).Bits());
+  EXPECT_EQ(0x0400u, math::Half(std::ldexp(1.0f, -14)).Bits());
+  EXPECT_EQ(0x03ffu, math::Half(std::ldexp(1023.0f, -24)).Bits());
+  EXPECT_EQ(std::ldexp(1.0f, -24), math::Half::FromBits(1).Float());
+
+  // Infinity and NaN.
+  const float inf = std::numeric_limits<float>::infinity();
+  EXPECT_EQ(0x7c00u, math::Half(inf).Bits());
+  EXPECT_EQ(0xfc00u, math::Half(-inf).Bits());
+  EXPECT_EQ(0x7e00u,
+            math::Half(std::numeric_limits<float>::quiet_NaN()).Bits());
+  EXPECT_EQ(inf, math::Half::FromBits(0x7c00).Float());
+  EXPECT_TRUE(std::isnan(math::Half::FromBits(0x7c01).Float()));
+}
+
+/////////////////////////////////////////////////
+TEST(HalfTest, RoundTrip)
+{
+  // Every half converts to a float that converts back to the same half.
+  for (uint32_t b = 0; b <= 0xffff; ++b)
+  {
+    const math::Half h = math::Half::FromBits(static_cast<uint16_t>(b));
+    const float f = h.Float();
+    if (std::isnan(f))
+      continue;
+    EXPECT_EQ(b, math::Half(f).Bits()) << b;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(HalfTest, Arrays)
+{
+  // All the halves, which exercises every exponent and the specials.
+  std::vector<math::Half> halves(0x10000 + 5);
+  for (std::size_t i = 0; i < halves.size(); ++i)
+    halves[i] = math::Half::FromBits(static_cast<uint16_t>(i));
+
+  std::vector<float> floats(halves.size());
+  math::Half::ToFloat(halves.data(), halves.size(), floats.data());
+  for (std::size_t i = 0; i < halves.size(); ++i)
+    EXPECT_EQ(FloatBits(halves[i].Float()), FloatBits(floats[i])) << i;
+
+  // Floats around every half, including the ties between halves.
+  std::vector<float> in;
+  for (uint32_t b = 0; b < 0x7c00; b += 7)
+  {
+    const float f = math::Half::FromBits(static_cast<uint16_t>(b)).Float();
+    const float next =
+      math::Half::FromBits(static_cast<uint16_t>(b + 1)).Float();
+    in.push_back(f);
+    in.push_back(-f);
+    in.push_back(0.5f * (f + next));
+    in.push_back(-0.5f * (f + next));
+    in.push_back(std::nextafter(0.5f * (f + next), next));
+  }
+  in.push_back(std::numeric_limits<float>::infinity());
+  in.push_back(-std::numeric_limits<float>::quiet_NaN());
+  in.push_back(1e30f);
+  in.push_back(-65520.0f);
+  in.push_back(std::numeric_limits<float>::denorm_min());
+
+  std::vector<math::Half> out(in.size());
+  math::Half::FromFloat(in.data(), in.size(), out.data());
+  for (std::size_t i = 0; i < in.size(); ++i)
+    EXPECT_EQ(math::Half(in[i]), out[i]) << i << " " << in[i];
+
+  // Empty arrays.
+  math::Half::FromFloat(nullptr, 0, nullptr);
+  math::Half::ToFloat(nullptr, 0, nullptr);
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "gz/math/Hash.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(HashTest, Values)
+{
+  static_assert(HashMix(0) == 0, "zero is a fixed point");
+  EXPECT_NE(HashMix(1), HashMix(2));
+  EXPECT_EQ(HashValue(0.0), HashValue(-0.0));
+  EXPECT_EQ(HashValue(0.5), HashValue(0.5f));
+  EXPECT_NE(HashValue(0.5), HashValue(0.25));
+  EXPECT_NE(HashValue(1), HashValue(2));
+
+  // Combining is ordered
+  std::size_t ab = HashValue(1);
+  HashCombine(ab, HashValue(2));
+  std::size_t ba = HashValue(2);
+  HashCombine(ba, HashValue(1));
+  EXPECT_NE(ab, ba);
+}
+
+/////////////////////////////////////////////////
+TEST(HashTest, Specializations)
+{
+  const std::hash<Vector3d> hash3;
+  EXPECT_EQ(hash3(Vector3d(1, 2, 3)), hash3(Vector3d(1, 2, 3)));
+  EXPECT_NE(hash3(Vector3d(1, 2, 3)), hash3(Vector3d(3, 2, 1)));
+  EXPECT_EQ(hash3(Vector3d(0, 0, 0)), hash3(Vector3d(-0.0, 0, -0.0)));
+
+  const std::hash<Vector2i> hash2;
+  EXPECT_NE(hash2(Vector2i(1, 2)), hash2(Vector2i(2, 1)));
+  const std::hash<Vector4f> hash4;
+  EXPECT_NE(hash4(Vector4f(1, 2, 3, 4)), hash4(Vector4f(1, 2, 4, 3)));
+  const std::hash<Quaterniond> hashQ;
+  EXPECT_EQ(hashQ(Quaterniond::Identity), hashQ(Quaterniond(1, 0, 0, 0)));
+  EXPECT_NE(hashQ(Quaterniond::Identity), hashQ(Quaterniond(-1, 0, 0, 0)));
+
+  const ExactlyEqual equal;
+  EXPECT_TRUE(equal(Vector2d(1, 2), Vector2d(1, 2)));
+  EXPECT_FALSE(equal(Vector3d(1, 2, 3), Vector3d(1, 2, 3 + 1e-9)));
+  EXPECT_TRUE(Vector3d(1, 2, 3) == Vector3d(1, 2, 3 + 1e-9));
+  EXPECT_FALSE(equal(Vector4d(1, 2, 3, 4), Vector4d(1, 2, 3, 5)));
+  EXPECT_FALSE(equal(Quaterniond(1, 0, 0, 0), Quaterniond(-1, 0, 0, 0)));
+  EXPECT_TRUE(equal(Vector2d(0.0, 1), Vector2d(-0.0, 1)));
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_TRUE(equal(Vector2d(nan, 1), Vector2d(nan, 1)));
+  EXPECT_FALSE(equal(Vector2d(nan, 1), Vector2d(0, 1)));
+
+  // Unordered containers of floating point values need exact equality
+  std::unordered_set<Vector3d, std::hash<Vector3d>, ExactlyEqual> points;
+  EXPECT_TRUE(points.insert(Vector3d(1, 2, 3)).second);
+  EXPECT_FALSE(points.insert(Vector3d(1, 2, 3)).second);
+  EXPECT_TRUE(points.insert(Vector3d(1, 2, 3.5)).second);
+  EXPECT_EQ(2u, points.size());
+
+  std::unordered_map<Quaterniond, int, std::hash<Quaterniond>,
+                     ExactlyEqual> rotations;
+  rotations[Quaterniond::Identity] = 3;
+  EXPECT_EQ(3, rotations.at(Quaterniond(1, 0, 0, 0)));
+}
+
+/////////////////////////////////////////////////
+TEST(HashTest, QuantizedCell)
+{
+  EXPECT_EQ(Vector3i(0, 0, 0), QuantizedCell(Vector3d(0.05, 0, 0.09), 0.1));
+  EXPECT_EQ(Vector3i(-1, 2, 10), QuantizedCell(Vector3d(-0.05, 0.25, 1),
+                                               0.1));
+  EXPECT_EQ(Vector3i(3, -4, 0), QuantizedCell(Vector3f(1.5f, -1.6f, 0.f),
+                                              0.5f));
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_EQ(Vector3i(std::numeric_limits<int>::max(),
+                     std::numeric_limits<int>::min(),
+                     std::numeric_limits<int>::min()),
+            QuantizedCell(Vector3d(1e300, -1e300, nan), 1.0));
+
+  // Voxel indices are integer vectors, whose operator== is exact
+  std::unordered_map<Vector3i, int> counts;
+  for (const Vector3d &p : {Vector3d(0.01, 0.01, 0.01),
+       Vector3d(0.09, 0.02, 0.03), Vector3d(0.11, 0.0, 0.0)})
+  {
+    ++counts[QuantizedCell(p, 0.1)];
+  }
+  EXPECT_EQ(2u, counts.size());
+  EXPECT_EQ(2, counts[Vector3i(0, 0, 0)]);
+  EXPECT_EQ(1, counts[Vector3i(1, 0, 0)]);
+}
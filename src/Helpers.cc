@@ -38,24 +38,9 @@ namespace ignition
     /////////////////////////////////////////////
     std::tuple<PairInput, PairInput> Unpair(const PairOutput _key)
     {
-      // Accurate 64-bit integer sqrt
-      //  From https://stackoverflow.com/a/18501209
-      //
-      // \todo: Remove this ifdef and use the "0x1p-20" version when c++17
-      // is used. All platforms should then support the "p" literal.
-      //
-      // Note that the of Hexadecimal floats is failing in some Linux g++
-      // compilers from 6.x/7.x series. The native support for C++ is defined
-      // in C++17 See https://bugzilla.redhat.com/show_bug.cgi?id=1321986
-#if (__cplusplus < 201703L)
-      uint64_t sqrt = static_cast<uint64_t>(std::sqrt(_key) -9.53674e-07);
-#else
-      uint64_t sqrt = static_cast<uint64_t>(std::sqrt(_key) - 0x1p-20);
-#endif
-      if (2 * sqrt < _key - sqrt * sqrt)
-        sqrt++;
-
-      uint64_t sq = sqrt * sqrt;
+      // Exact 64-bit integer sqrt
+      const uint64_t sqrt = detail::isqrt(_key);
+      const uint64_t sq = sqrt * sqrt;
 
       return ((_key - sq) >= sqrt) ?
         std::make_tuple(static_cast<PairInput>(sqrt),
@@ -63,6 +48,28 @@ namespace ignition
         std::make_tuple(static_cast<PairInput>(_key - sq),
                         static_cast<PairInput>(sqrt));
     }
+
+    /////////////////////////////////////////////
+    void Pair64(const uint32_t *_a, const uint32_t *_b,
+                const std::size_t _count, uint64_t *_keys)
+    {
+      for (std::size_t i = 0; i < _count; ++i)
+        _keys[i] = Pair64(_a[i], _b[i]);
+    }
+
+    /////////////////////////////////////////////
+    void Unpair64(const uint64_t *_keys, const std::size_t _count,
+                  uint32_t *_a, uint32_t *_b)
+    {
+      for (std::size_t i = 0; i < _count; ++i)
+      {
+        const uint64_t root = detail::isqrtDouble(_keys[i]);
+        const uint64_t rem = _keys[i] - root * root;
+        const bool first = rem >= root;
+        _a[i] = static_cast<uint32_t>(first ? root : rem);
+        _b[i] = static_cast<uint32_t>(first ? rem - root : root);
+      }
+    }
     }
   }
 }
@@ -17,6 +17,13 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "gz/math/Rand.hh"
 #include "gz/math/Vector3.hh"
 #include "gz/math/Helpers.hh"
@@ -67,6 +74,95 @@ TEST(HelpersTest, Helpers)
   EXPECT_EQ(2048u, math::roundUpPowerOfTwo(1025));
 }
 
+/////////////////////////////////////////////////
+TEST(HelpersTest, ParseLegacyForms)
+{
+  // Forms accepted by std::stoi and std::stod.
+  EXPECT_EQ(5, math::parseInt("+5"));
+  EXPECT_EQ(7, math::parseInt("\t\n 7"));
+  EXPECT_EQ(std::numeric_limits<int>::min(),
+            math::parseInt("-2147483648"));
+  EXPECT_EQ(math::NAN_I, math::parseInt("2147483648"));
+  EXPECT_EQ(math::NAN_I, math::parseInt("+-5"));
+  EXPECT_EQ(math::NAN_I, math::parseInt("-"));
+
+  EXPECT_DOUBLE_EQ(0.5, math::parseFloat("+.5"));
+  EXPECT_DOUBLE_EQ(-0.5, math::parseFloat(" -.5e0xyz"));
+  EXPECT_DOUBLE_EQ(8.0, math::parseFloat("0x1p3"));
+  EXPECT_DOUBLE_EQ(-26.0, math::parseFloat("-0x1A"));
+  EXPECT_DOUBLE_EQ(0.0, math::parseFloat("0x"));
+  EXPECT_TRUE(std::isinf(math::parseFloat("-inf")));
+  EXPECT_TRUE(math::isnan(math::parseFloat("nan")));
+  EXPECT_TRUE(math::isnan(math::parseFloat("1e400")));
+  EXPECT_TRUE(math::isnan(math::parseFloat("4.9e-324")));
+  EXPECT_TRUE(math::isnan(math::parseFloat("-1e-320")));
+  EXPECT_DOUBLE_EQ(2.2250738585072014e-308,
+                   math::parseFloat("2.2250738585072014e-308"));
+  EXPECT_TRUE(math::isnan(math::parseFloat("+-1")));
+
+  // Views that are not null terminated.
+  const std::string text = "12345";
+  EXPECT_EQ(123, math::parseInt(std::string_view(text).substr(0, 3)));
+  EXPECT_DOUBLE_EQ(34.0,
+      math::parseFloat(std::string_view(text).substr(2, 2)));
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, ParseNext)
+{
+  std::string_view text = "  1 -2.5\t3e2\n+4 0x10  ";
+  double d = 0;
+  EXPECT_TRUE(math::parseNext(text, d));
+  EXPECT_DOUBLE_EQ(1.0, d);
+  EXPECT_TRUE(math::parseNext(text, d));
+  EXPECT_DOUBLE_EQ(-2.5, d);
+  EXPECT_TRUE(math::parseNext(text, d));
+  EXPECT_DOUBLE_EQ(300.0, d);
+  EXPECT_TRUE(math::parseNext(text, d));
+  EXPECT_DOUBLE_EQ(4.0, d);
+  EXPECT_TRUE(math::parseNext(text, d));
+  EXPECT_DOUBLE_EQ(16.0, d);
+  EXPECT_FALSE(math::parseNext(text, d));
+  EXPECT_DOUBLE_EQ(16.0, d);
+  EXPECT_EQ("  ", text);
+
+  // A token must end at white space.
+  text = "1.5abc 2";
+  EXPECT_FALSE(math::parseNext(text, d));
+  EXPECT_EQ("1.5abc 2", text);
+
+  int i = 0;
+  text = "42 1.5";
+  EXPECT_TRUE(math::parseNext(text, i));
+  EXPECT_EQ(42, i);
+  EXPECT_FALSE(math::parseNext(text, i));
+  EXPECT_EQ(42, i);
+
+  // Out of range.
+  uint8_t u = 0;
+  text = "300";
+  EXPECT_FALSE(math::parseNext(text, u));
+  text = "-1";
+  EXPECT_FALSE(math::parseNext(text, u));
+
+  float f = 0;
+  text = "0.1";
+  EXPECT_TRUE(math::parseNext(text, f));
+  EXPECT_EQ(0.1f, f);
+
+  std::vector<double> values = {7};
+  EXPECT_TRUE(math::parseNumbers("1 2\n3\t4 ", values));
+  EXPECT_EQ(std::vector<double>({7, 1, 2, 3, 4}), values);
+  EXPECT_TRUE(math::parseNumbers("   ", values));
+  EXPECT_EQ(5u, values.size());
+  EXPECT_FALSE(math::parseNumbers("1 2 x 4", values));
+  EXPECT_EQ(5u, values.size());
+
+  std::vector<int> ints;
+  EXPECT_TRUE(math::parseNumbers("-1 0 +1", ints));
+  EXPECT_EQ(std::vector<int>({-1, 0, 1}), ints);
+}
+
 /////////////////////////////////////////////////
 // Test Helpers::precision
 TEST(HelpersTest, Precision)
@@ -432,6 +528,58 @@ TEST(HelpersTest, Volume)
                    IGN_BOX_VOLUME_V(math::Vector3d(0.1, 0.2, 0.3)));
 }
 
+/////////////////////////////////////////////////
+TEST(HelpersTest, FormatNumber)
+{
+  char buffer[64];
+  char *end = buffer + sizeof(buffer);
+
+  char *p = math::formatNumber(buffer, end, 0.1);
+  ASSERT_NE(nullptr, p);
+  EXPECT_EQ("0.1", std::string(buffer, p));
+  p = math::formatNumber(buffer, end, -12345);
+  ASSERT_NE(nullptr, p);
+  EXPECT_EQ("-12345", std::string(buffer, p));
+  p = math::formatNumber(buffer, end, 1.5f);
+  ASSERT_NE(nullptr, p);
+  EXPECT_EQ("1.5", std::string(buffer, p));
+  p = math::formatNumber(buffer, end, -0.0);
+  ASSERT_NE(nullptr, p);
+  EXPECT_EQ("0", std::string(buffer, p));
+
+  // Shortest round trip output.
+  for (int i = 0; i < 10000; ++i)
+  {
+    const double d = math::Rand::DblUniform(-1e6, 1e6) *
+      std::pow(10.0, math::Rand::IntUniform(-30, 30));
+    p = math::formatNumber(buffer, end, d);
+    ASSERT_NE(nullptr, p);
+    std::string_view text(buffer, static_cast<std::size_t>(p - buffer));
+    double parsed = 0;
+    EXPECT_TRUE(math::parseNext(text, parsed));
+    EXPECT_EQ(d, parsed);
+
+    const float f = static_cast<float>(d);
+    p = math::formatNumber(buffer, end, f);
+    ASSERT_NE(nullptr, p);
+    text = std::string_view(buffer, static_cast<std::size_t>(p - buffer));
+    float parsedF = 0;
+    EXPECT_TRUE(math::parseNext(text, parsedF));
+    EXPECT_EQ(f, parsedF);
+  }
+
+  // Buffer too small.
+  EXPECT_EQ(nullptr, math::formatNumber(buffer, buffer + 3, 0.125));
+  EXPECT_EQ(nullptr, math::formatNumber(buffer, buffer, 1));
+
+  const double values[3] = {1, -2.5, 1e-20};
+  p = math::formatNumbers(buffer, end, values, 3);
+  ASSERT_NE(nullptr, p);
+  EXPECT_EQ("1 -2.5 1e-20", std::string(buffer, p));
+  EXPECT_EQ(nullptr, math::formatNumbers(buffer, buffer + 5, values, 3));
+  EXPECT_EQ(buffer, math::formatNumbers(buffer, end, values, 0));
+}
+
 /////////////////////////////////////////////////
 TEST(HelpersTest, Pair)
 {
@@ -538,6 +686,95 @@ TEST(HelpersTest, Pair)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(HelpersTest, PairConstexpr)
+{
+  static_assert(math::Pair64(10, 20) == 410u, "Pair64 is constexpr");
+  static_assert(std::get<0>(math::Unpair64(410)) == 10u,
+                "Unpair64 is constexpr");
+  static_assert(std::get<1>(math::Unpair64(410)) == 20u,
+                "Unpair64 is constexpr");
+  static_assert(std::get<0>(math::Unpair64(math::MAX_UI64)) == math::MAX_UI32,
+                "Unpair64 is exact for the largest key");
+  static_assert(math::detail::isqrt(math::MAX_UI64) == math::MAX_UI32,
+                "isqrt is constexpr");
+
+  constexpr uint64_t key = math::Pair64(123456789u, 987654321u);
+  uint32_t a, b;
+  std::tie(a, b) = math::Unpair64(key);
+  EXPECT_EQ(123456789u, a);
+  EXPECT_EQ(987654321u, b);
+
+  // Pair64 matches Pair where their types match.
+  EXPECT_EQ(math::Pair(1000u, 2000u), math::Pair64(1000u, 2000u));
+  EXPECT_EQ(math::Pair(2000u, 1000u), math::Pair64(2000u, 1000u));
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, IntegerSqrt)
+{
+  // Both square roots are exact around every tested square, including
+  // the squares that are not representable as doubles.
+  auto check = [](const uint64_t _root)
+  {
+    const uint64_t sq = _root * _root;
+    EXPECT_EQ(_root, math::detail::isqrtBits(sq)) << _root;
+    EXPECT_EQ(_root, math::detail::isqrtDouble(sq)) << _root;
+    EXPECT_EQ(_root, math::detail::isqrtDouble(sq + _root)) << _root;
+    EXPECT_EQ(_root, math::detail::isqrtDouble(sq + 2 * _root)) << _root;
+    EXPECT_EQ(_root, math::detail::isqrtBits(sq + 2 * _root)) << _root;
+    if (_root > 0)
+    {
+      EXPECT_EQ(_root - 1, math::detail::isqrtDouble(sq - 1)) << _root;
+      EXPECT_EQ(_root - 1, math::detail::isqrtBits(sq - 1)) << _root;
+    }
+  };
+  for (uint64_t r = 0; r < 100000; ++r)
+    check(r);
+  for (uint64_t r = math::MAX_UI32 - 100000; r < math::MAX_UI32; ++r)
+    check(r);
+  for (int i = 0; i < 100000; ++i)
+    check(static_cast<uint64_t>(math::Rand::IntUniform(0, math::MAX_I32)) *
+          2 + 1);
+  EXPECT_EQ(math::MAX_UI32, math::detail::isqrtDouble(math::MAX_UI64));
+  EXPECT_EQ(math::MAX_UI32, math::detail::isqrtBits(math::MAX_UI64));
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, PairBatch)
+{
+  std::vector<uint32_t> a;
+  std::vector<uint32_t> b;
+  for (int i = 0; i < 1000; ++i)
+  {
+    a.push_back(static_cast<uint32_t>(
+        math::Rand::IntUniform(0, math::MAX_I32)) * 2u);
+    b.push_back(static_cast<uint32_t>(
+        math::Rand::IntUniform(0, math::MAX_I32)) * 2u + 1u);
+  }
+  a.push_back(math::MAX_UI32);
+  b.push_back(math::MAX_UI32);
+  a.push_back(0);
+  b.push_back(math::MAX_UI32);
+
+  std::vector<uint64_t> keys(a.size());
+  math::Pair64(a.data(), b.data(), a.size(), keys.data());
+
+  std::vector<uint32_t> c(a.size());
+  std::vector<uint32_t> d(a.size());
+  math::Unpair64(keys.data(), keys.size(), c.data(), d.data());
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    EXPECT_EQ(math::Pair64(a[i], b[i]), keys[i]);
+    EXPECT_EQ(a[i], c[i]);
+    EXPECT_EQ(b[i], d[i]);
+  }
+
+  // Empty batches.
+  math::Pair64(nullptr, nullptr, 0, nullptr);
+  math::Unpair64(nullptr, 0, nullptr, nullptr);
+}
+
 /////////////////////////////////////////////////
 TEST(HelpersTest, timePointToSecNsec)
 {
@@ -971,6 +1208,66 @@ TEST(HelpersTest, roundUpMultiple)
   EXPECT_EQ(-2, math::roundUpMultiple(-2, -2));
 }
 
+/////////////////////////////////////////////////
+TEST(HelpersTest, FastTrigonometry)
+{
+  // Errors documented in Helpers.hh
+  math::Rand::Seed(7);
+  for (int i = 0; i < 100000; ++i)
+  {
+    const double x = math::Rand::DblUniform(-1e4, 1e4);
+    double s;
+    double c;
+    math::fastSinCos(x, s, c);
+    EXPECT_NEAR(std::sin(x), s, 3e-9);
+    EXPECT_NEAR(std::cos(x), c, 3e-9);
+    EXPECT_DOUBLE_EQ(s, math::fastSin(x));
+    EXPECT_DOUBLE_EQ(c, math::fastCos(x));
+
+    const double y = math::Rand::DblUniform(-10, 10);
+    const double z = math::Rand::DblUniform(-10, 10);
+    EXPECT_NEAR(std::atan2(y, z), math::fastAtan2(y, z), 1e-8);
+
+    const double v = math::Rand::DblUniform(-1, 1);
+    EXPECT_NEAR(std::asin(v), math::fastAsin(v), 1e-8);
+    EXPECT_NEAR(std::acos(v), math::fastAcos(v), 1e-8);
+
+    const double e = math::Rand::DblUniform(-700, 700);
+    EXPECT_NEAR(1.0, math::fastExp(e) / std::exp(e), 2e-9);
+
+    // Float results are within one ULP
+    const float xf = static_cast<float>(x / 100);
+    const float sf = math::fastSin(xf);
+    const float ref = static_cast<float>(std::sin(static_cast<double>(xf)));
+    EXPECT_LE(std::abs(sf - ref), std::abs(std::nextafter(ref, 2.0f) - ref));
+  }
+
+  // Quadrants and special values
+  EXPECT_DOUBLE_EQ(0.0, math::fastSin(0.0));
+  EXPECT_DOUBLE_EQ(1.0, math::fastCos(0.0));
+  EXPECT_NEAR(-1.0, math::fastSin(-IGN_PI_2), 1e-15);
+  EXPECT_NEAR(-1.0, math::fastCos(IGN_PI), 1e-15);
+  EXPECT_TRUE(std::isnan(math::fastSin(std::nan(""))));
+  EXPECT_DOUBLE_EQ(0.0, math::fastAtan2(0.0, 0.0));
+  EXPECT_NEAR(IGN_PI, math::fastAtan2(0.0, -1.0), 1e-15);
+  EXPECT_NEAR(-IGN_PI, math::fastAtan2(-0.0, -1.0), 1e-15);
+  EXPECT_NEAR(IGN_PI_2, math::fastAtan2(1.0, 0.0), 1e-15);
+  EXPECT_NEAR(-IGN_PI_2, math::fastAsin(-1.0), 1e-15);
+  EXPECT_NEAR(0.0, math::fastAcos(1.0), 1e-15);
+  EXPECT_TRUE(std::isnan(math::fastAcos(1.5)));
+  EXPECT_DOUBLE_EQ(1.0, math::fastExp(0.0));
+  EXPECT_DOUBLE_EQ(0.0, math::fastExp(-1000.0));
+  EXPECT_TRUE(std::isinf(math::fastExp(1000.0)));
+  EXPECT_TRUE(std::isinf(math::fastExp(100.0f)));
+  EXPECT_TRUE(std::isnan(math::fastExp(std::nan(""))));
+
+  // Precision policies
+  EXPECT_DOUBLE_EQ(std::sin(0.3), math::FullPrecision::Sin(0.3));
+  EXPECT_DOUBLE_EQ(math::fastSin(0.3), math::FastPrecision::Sin(0.3));
+  EXPECT_DOUBLE_EQ(std::exp(0.3), math::FullPrecision::Exp(0.3));
+  EXPECT_DOUBLE_EQ(math::fastExp(0.3), math::FastPrecision::Exp(0.3));
+}
+
 /////////////////////////////////////////////////
 TEST(HelpersTest, AppendToStream)
 {
@@ -0,0 +1,555 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gz/math/IcpRegistration.hh"
+#include "gz/math/KdTree3.hh"
+#include "gz/math/Matrix3.hh"
+#include "gz/math/Matrix6.hh"
+#include "gz/math/NormalEstimator.hh"
+#include "gz/math/SpatialVector.hh"
+#include "gz/math/Trace.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Private data for IcpRegistration.
+class gz::math::IcpRegistrationPrivate
+{
+  /// \brief Target points.
+  public: std::vector<Vector3d> target;
+
+  /// \brief Tree over the target points.
+  public: KdTree3d tree;
+
+  /// \brief Normal of each target point, valid if normalsValid is true.
+  public: std::vector<Vector3d> normals;
+
+  /// \brief True if normals holds the normals of the target points.
+  public: bool normalsValid = false;
+
+  /// \brief True if the normals were passed to SetTarget().
+  public: bool normalsGiven = false;
+
+  /// \brief Error minimized by each iteration.
+  public: IcpRegistration::Metric metric = IcpRegistration::POINT_TO_POINT;
+
+  /// \brief Maximum number of iterations.
+  public: unsigned int maxIterations = 30;
+
+  /// \brief Maximum distance between matched points.
+  public: double maxDistance = std::numeric_limits<double>::infinity();
+
+  /// \brief Tolerance on the translation of an update.
+  public: double translationTolerance = 1e-6;
+
+  /// \brief Tolerance on the rotation angle of an update.
+  public: double rotationTolerance = 1e-6;
+
+  /// \brief Number of neighbors used to estimate each normal.
+  public: std::size_t normalNeighbors = 10;
+
+  /// \brief Number of threads, 0 for hardware threads.
+  public: unsigned int threadCount = 1;
+
+  /// \brief Executor used instead of threadCount threads, if set.
+  public: std::shared_ptr<Executor> executor;
+};
+
+namespace
+{
+  /// \brief Minimum number of points processed by each block.
+  const std::size_t kMinPointsPerBlock = 1024;
+
+  /// \brief Sums over the matches of a block of source points.
+  struct MatchSums
+  {
+    /// \brief Number of matched source points.
+    std::size_t count = 0;
+
+    /// \brief Sum of the squared distances between matched points.
+    double squaredError = 0;
+
+    /// \brief Sum of the matched source points, transformed.
+    Vector3d source = Vector3d::Zero;
+
+    /// \brief Sum of the target points they are matched with.
+    Vector3d target = Vector3d::Zero;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Get the executor running the blocks of points, and the number
+  /// of blocks. Without an executor set by the user, each thread
+  /// processes a single block.
+  /// \param[in] _data Registration data.
+  /// \param[in] _count Number of points.
+  /// \param[out] _local Thread pool created for the call, if any.
+  /// \param[out] _blocks Number of blocks.
+  /// \return The executor.
+  Executor &BlockExecutor(const IcpRegistrationPrivate &_data,
+      const std::size_t _count, std::unique_ptr<Executor> &_local,
+      std::size_t &_blocks)
+  {
+    static SerialExecutor serial;
+
+    if (_data.executor)
+    {
+      _blocks = _data.executor->BlockCount(_count, kMinPointsPerBlock);
+      return *_data.executor;
+    }
+
+    std::size_t threads = _data.threadCount;
+    if (threads == 0)
+      threads = std::thread::hardware_concurrency();
+    _blocks = std::max<std::size_t>(1,
+        std::min(threads, _count / kMinPointsPerBlock));
+    if (_blocks <= 1)
+      return serial;
+    _local.reset(new ThreadPool(static_cast<unsigned int>(_blocks)));
+    return *_local;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Estimate the normal of every target point.
+  /// \param[in,out] _data Registration data, whose normals are set.
+  void EstimateNormals(IcpRegistrationPrivate &_data)
+  {
+    NormalEstimator estimator;
+    estimator.SetNeighbors(_data.normalNeighbors);
+    estimator.SetThreadCount(_data.threadCount);
+    estimator.SetExecutor(_data.executor);
+
+    Vector3SoAd normals;
+    std::vector<double> curvatures;
+    estimator.Estimate(Vector3SoAd(_data.target), _data.tree, normals,
+                       curvatures);
+    normals.CopyTo(_data.normals);
+    _data.normalsValid = true;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Find the rotation that best maps a set of centered points
+  /// onto another one, in the least squares sense (Kabsch).
+  /// \param[in] _covariance Sum over the pairs of points of
+  /// source * target^T, with both points centered.
+  /// \param[out] _rot The rotation.
+  /// \return False if the points don't determine the rotation, such as
+  /// when they are collinear.
+  bool KabschRotation(const Matrix3d &_covariance, Matrix3d &_rot)
+  {
+    // With the SVD _covariance = U S V^T, the rotation is V U^T, with the
+    // sign of the last column of U chosen so that it is proper. V holds
+    // the eigenvectors of H^T H, and the first two columns of U follow
+    // from H V = U S.
+    Vector3d values;
+    Matrix3d vectors;
+    (_covariance.Transposed() * _covariance).SymmetricEigen(values,
+                                                            vectors);
+
+    // Columns of V by decreasing singular value, as a proper rotation
+    const Vector3d v1(vectors(0, 2), vectors(1, 2), vectors(2, 2));
+    const Vector3d v2(vectors(0, 1), vectors(1, 1), vectors(2, 1));
+    const Vector3d v3 = v1.Cross(v2);
+
+    Vector3d u1 = _covariance * v1;
+    const double s1 = u1.Length();
+    if (!(s1 > 0) || !std::isfinite(s1))
+      return false;
+    u1 /= s1;
+
+    Vector3d u2 = _covariance * v2;
+    u2 -= u1 * u1.Dot(u2);
+    const double s2 = u2.Length();
+    if (!(s2 > 1e-6 * s1))
+      return false;
+    u2 /= s2;
+    const Vector3d u3 = u1.Cross(u2);
+
+    const Matrix3d v(v1.X(), v2.X(), v3.X(),
+                     v1.Y(), v2.Y(), v3.Y(),
+                     v1.Z(), v2.Z(), v3.Z());
+    const Matrix3d uTransposed(u1.X(), u1.Y(), u1.Z(),
+                               u2.X(), u2.Y(), u2.Z(),
+                               u3.X(), u3.Y(), u3.Z());
+    _rot = v * uTransposed;
+    return true;
+  }
+}
+
+/////////////////////////////////////////////////
+IcpRegistration::IcpRegistration()
+  : dataPtr(std::make_unique<IcpRegistrationPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+IcpRegistration::IcpRegistration(const std::vector<Vector3d> &_target)
+  : IcpRegistration()
+{
+  this->SetTarget(_target);
+}
+
+/////////////////////////////////////////////////
+IcpRegistration::IcpRegistration(const IcpRegistration &_other)
+  : dataPtr(std::make_unique<IcpRegistrationPrivate>(*_other.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+IcpRegistration::~IcpRegistration() = default;
+
+/////////////////////////////////////////////////
+IcpRegistration &IcpRegistration::operator=(const IcpRegistration &_other)
+{
+  *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void IcpRegistration::SetTarget(const std::vector<Vector3d> &_target)
+{
+  this->dataPtr->target = _target;
+  this->dataPtr->tree.Build(_target);
+  this->dataPtr->normals.clear();
+  this->dataPtr->normalsValid = false;
+  this->dataPtr->normalsGiven = false;
+}
+
+/////////////////////////////////////////////////
+bool IcpRegistration::SetTarget(const std::vector<Vector3d> &_target,
+    const std::vector<Vector3d> &_normals)
+{
+  this->SetTarget(_target);
+  if (_normals.size() != _target.size())
+    return false;
+  this->dataPtr->normals = _normals;
+  this->dataPtr->normalsValid = true;
+  this->dataPtr->normalsGiven = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+const std::vector<Vector3d> &IcpRegistration::Target() const
+{
+  return this->dataPtr->target;
+}
+
+/////////////////////////////////////////////////
+const std::vector<Vector3d> &IcpRegistration::TargetNormals()
+{
+  if (!this->dataPtr->normalsValid)
+    EstimateNormals(*this->dataPtr);
+  return this->dataPtr->normals;
+}
+
+/////////////////////////////////////////////////
+void IcpRegistration::SetMetric(const Metric _metric)
+{
+  this->dataPtr->metric = _metric;
+}
+
+/////////////////////////////////////////////////
+IcpRegistration::Metric IcpRegistration::GetMetric() const
+{
+  return this->dataPtr->metric;
+}
+
+/////////////////////////////////////////////////
+void IcpRegistration::SetMaxIterations(const unsigned int _iterations)
+{
+  this->dataPtr->maxIterations = _iterations;
+}
+
+/////////////////////////////////////////////////
+unsigned int IcpRegistration::MaxIterations() const
+{
+  return this->dataPtr->maxIterations;
+}
+
+/////////////////////////////////////////////////
+void IcpRegistration::SetMaxCorrespondenceDistance(const double _distance)
+{
+  this->dataPtr->maxDistance = _distance;
+}
+
+/////////////////////////////////////////////////
+double IcpRegistration::MaxCorrespondenceDistance() const
+{
+  return this->dataPtr->maxDistance;
+}
+
+/////////////////////////////////////////////////
+void IcpRegistration::SetTolerance(const double _translation,
+    const double _rotation)
+{
+  this->dataPtr->translationTolerance = _translation;
+  this->dataPtr->rotationTolerance = _rotation;
+}
+
+/////////////////////////////////////////////////
+double IcpRegistration::TranslationTolerance() const
+{
+  return this->dataPtr->translationTolerance;
+}
+
+/////////////////////////////////////////////////
+double IcpRegistration::RotationTolerance() const
+{
+  return this->dataPtr->rotationTolerance;
+}
+
+/////////////////////////////////////////////////
+void IcpRegistration::SetNormalNeighbors(const std::size_t _neighbors)
+{
+  this->dataPtr->normalNeighbors = _neighbors;
+  if (!this->dataPtr->normalsGiven)
+    this->dataPtr->normalsValid = false;
+}
+
+/////////////////////////////////////////////////
+std::size_t IcpRegistration::NormalNeighbors() const
+{
+  return this->dataPtr->normalNeighbors;
+}
+
+/////////////////////////////////////////////////
+void IcpRegistration::SetThreadCount(const unsigned int _threads)
+{
+  this->dataPtr->threadCount = _threads;
+}
+
+/////////////////////////////////////////////////
+unsigned int IcpRegistration::ThreadCount() const
+{
+  return this->dataPtr->threadCount;
+}
+
+/////////////////////////////////////////////////
+void IcpRegistration::SetExecutor(std::shared_ptr<Executor> _executor)
+{
+  this->dataPtr->executor = std::move(_executor);
+}
+
+/////////////////////////////////////////////////
+IcpRegistration::Result IcpRegistration::Align(
+    const std::vector<Vector3d> &_source, const Pose3d &_initial)
+{
+  return this->Align(Vector3SoAd(_source), _initial);
+}
+
+/////////////////////////////////////////////////
+IcpRegistration::Result IcpRegistration::Align(const Vector3SoAd &_source,
+    const Pose3d &_initial)
+{
+  IGN_MATH_TRACE_ZONE("IcpRegistration::Align");
+  auto &d = *this->dataPtr;
+  const bool toPlane = d.metric == POINT_TO_PLANE;
+  if (toPlane)
+    this->TargetNormals();
+
+  Result result;
+  result.pose = _initial;
+
+  const std::size_t count = _source.Size();
+  std::unique_ptr<Executor> local;
+  std::size_t blocks = 1;
+  Executor &executor = BlockExecutor(d, count, local, blocks);
+
+  // Source points transformed by the current pose, and the index of the
+  // target point each of them is matched with.
+  Vector3SoAd moved;
+  std::vector<std::size_t> matches(count);
+  std::vector<MatchSums> sums(blocks);
+  Vector3d sourceCenter;
+  Vector3d targetCenter;
+
+  // Match the source points at the current pose, and update the
+  // statistics of the result.
+  auto match = [&]()
+  {
+    result.pose.CoordPositionAdd(_source, moved);
+    executor.ForEachBlock(count, blocks,
+      [&](const std::size_t _begin, const std::size_t _end,
+          const std::size_t _block)
+      {
+        MatchSums s;
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const Vector3d p = moved[i];
+          const auto nearest = d.tree.Nearest(p, d.maxDistance);
+          std::size_t index = std::get<2>(nearest);
+          if (!std::get<0>(nearest) ||
+              (toPlane && d.normals[index] == Vector3d::Zero))
+          {
+            index = KdTree3d::kNoPoint;
+          }
+          matches[i] = index;
+          if (index == KdTree3d::kNoPoint)
+            continue;
+          ++s.count;
+          s.squaredError += std::get<1>(nearest) * std::get<1>(nearest);
+          s.source += p;
+          s.target += d.target[index];
+        }
+        sums[_block] = s;
+      });
+
+    MatchSums total;
+    for (const MatchSums &s : sums)
+    {
+      total.count += s.count;
+      total.squaredError += s.squaredError;
+      total.source += s.source;
+      total.target += s.target;
+    }
+    result.inliers = total.count;
+    result.rmsError = 0;
+    if (total.count > 0)
+    {
+      const double n = static_cast<double>(total.count);
+      result.rmsError = std::sqrt(total.squaredError / n);
+      sourceCenter = total.source / n;
+      targetCenter = total.target / n;
+    }
+  };
+
+  // Find the update of the pose that best aligns the matched points.
+  std::vector<Matrix3d> covariances;
+  std::vector<Matrix6d> normalMatrices;
+  std::vector<std::vector<double>> rightSides;
+  auto solve = [&](Pose3d &_delta) -> bool
+  {
+    if (!toPlane)
+    {
+      if (result.inliers < 3)
+        return false;
+      covariances.assign(blocks, Matrix3d::Zero);
+      executor.ForEachBlock(count, blocks,
+        [&](const std::size_t _begin, const std::size_t _end,
+            const std::size_t _block)
+        {
+          Matrix3d h = Matrix3d::Zero;
+          for (std::size_t i = _begin; i < _end; ++i)
+          {
+            if (matches[i] == KdTree3d::kNoPoint)
+              continue;
+            const Vector3d p = moved[i] - sourceCenter;
+            const Vector3d q = d.target[matches[i]] - targetCenter;
+            h = h + Matrix3d(p.X() * q.X(), p.X() * q.Y(), p.X() * q.Z(),
+                          p.Y() * q.X(), p.Y() * q.Y(), p.Y() * q.Z(),
+                          p.Z() * q.X(), p.Z() * q.Y(), p.Z() * q.Z());
+          }
+          covariances[_block] = h;
+        });
+      Matrix3d h = Matrix3d::Zero;
+      for (const Matrix3d &c : covariances)
+        h = h + c;
+
+      Matrix3d rot;
+      if (!KabschRotation(h, rot))
+        return false;
+      _delta.Set(targetCenter - rot * sourceCenter, Quaterniond(rot));
+      return true;
+    }
+
+    // Linearize the rotation about the centroid of the matched source
+    // points, x -> x + w x (x - c) + t, and solve the normal equations of
+    // the distances to the planes for (w, t).
+    if (result.inliers < 6)
+      return false;
+    normalMatrices.assign(blocks, Matrix6d::Zero);
+    rightSides.assign(blocks, std::vector<double>(6, 0.0));
+    executor.ForEachBlock(count, blocks,
+      [&](const std::size_t _begin, const std::size_t _end,
+          const std::size_t _block)
+      {
+        Matrix6d ata = Matrix6d::Zero;
+        double atb[6] = {0, 0, 0, 0, 0, 0};
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          if (matches[i] == KdTree3d::kNoPoint)
+            continue;
+          const Vector3d p = moved[i];
+          const Vector3d &n = d.normals[matches[i]];
+          const Vector3d c = (p - sourceCenter).Cross(n);
+          const double a[6] = {c.X(), c.Y(), c.Z(), n.X(), n.Y(), n.Z()};
+          const double b = (d.target[matches[i]] - p).Dot(n);
+          for (std::size_t r = 0; r < 6; ++r)
+          {
+            for (std::size_t k = 0; k <= r; ++k)
+              ata(r, k) += a[r] * a[k];
+            atb[r] += a[r] * b;
+          }
+        }
+        normalMatrices[_block] = ata;
+        std::copy(atb, atb + 6, rightSides[_block].begin());
+      });
+    Matrix6d ata = Matrix6d::Zero;
+    double x[6] = {0, 0, 0, 0, 0, 0};
+    for (std::size_t b = 0; b < blocks; ++b)
+    {
+      ata += normalMatrices[b];
+      for (std::size_t r = 0; r < 6; ++r)
+        x[r] += rightSides[b][r];
+    }
+    if (!ata.CholeskyFactor(1e-12))
+      return false;
+    const SpatialVectord solution = ata.CholeskySolve(SpatialVectord(
+        Vector3d(x[0], x[1], x[2]), Vector3d(x[3], x[4], x[5])));
+
+    const Vector3d &w = solution.Angular();
+    const Vector3d &t = solution.Linear();
+    const double angle = w.Length();
+    const Quaterniond rot = angle > 0 ?
+        Quaterniond(w / angle, angle) : Quaterniond::Identity;
+    _delta.Set(sourceCenter + t - rot.RotateVector(sourceCenter), rot);
+    return true;
+  };
+
+  match();
+  while (result.iterations < d.maxIterations)
+  {
+    Pose3d delta;
+    if (!solve(delta))
+      break;
+
+    result.pose.Set(delta.CoordPositionAdd(result.pose.Pos()),
+                    delta.Rot() * result.pose.Rot());
+    result.pose.Rot().Normalize();
+    ++result.iterations;
+    match();
+
+    const Quaterniond &q = delta.Rot();
+    const double angle = 2.0 * std::atan2(
+        std::sqrt(q.X() * q.X() + q.Y() * q.Y() + q.Z() * q.Z()),
+        std::abs(q.W()));
+    if (delta.Pos().Length() <= d.translationTolerance &&
+        angle <= d.rotationTolerance)
+    {
+      result.converged = true;
+      break;
+    }
+  }
+  return result;
+}
@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "gz/math/Executor.hh"
+#include "gz/math/IcpRegistration.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Height of a smooth surface.
+  double Height(const double _x, const double _y)
+  {
+    return 0.3 * std::sin(2 * _x) * std::cos(3 * _y) + 0.1 * _x;
+  }
+
+  /// \brief Sample the surface on a grid over [-1, 1]^2.
+  std::vector<Vector3d> Surface(const int _side)
+  {
+    std::vector<Vector3d> points;
+    for (int i = 0; i < _side; ++i)
+    {
+      for (int j = 0; j < _side; ++j)
+      {
+        const double x = -1.0 + 2.0 * i / (_side - 1);
+        const double y = -1.0 + 2.0 * j / (_side - 1);
+        points.emplace_back(x, y, Height(x, y));
+      }
+    }
+    return points;
+  }
+
+  /// \brief Express points in the frame of a pose.
+  std::vector<Vector3d> InFrame(const std::vector<Vector3d> &_points,
+                                const Pose3d &_pose)
+  {
+    std::vector<Vector3d> result;
+    for (const Vector3d &p : _points)
+      result.push_back(_pose.Rot().RotateVectorReverse(p - _pose.Pos()));
+    return result;
+  }
+
+  /// \brief Pose of the source points in the tests.
+  const Pose3d kTruth(0.02, -0.015, 0.01, 0.02, -0.01, 0.03);
+}
+
+/////////////////////////////////////////////////
+TEST(IcpRegistrationTest, Defaults)
+{
+  IcpRegistration icp;
+  EXPECT_TRUE(icp.Target().empty());
+  EXPECT_EQ(IcpRegistration::POINT_TO_POINT, icp.GetMetric());
+  EXPECT_EQ(30u, icp.MaxIterations());
+  EXPECT_TRUE(std::isinf(icp.MaxCorrespondenceDistance()));
+  EXPECT_DOUBLE_EQ(1e-6, icp.TranslationTolerance());
+  EXPECT_DOUBLE_EQ(1e-6, icp.RotationTolerance());
+  EXPECT_EQ(10u, icp.NormalNeighbors());
+  EXPECT_EQ(1u, icp.ThreadCount());
+
+  icp.SetMetric(IcpRegistration::POINT_TO_PLANE);
+  icp.SetMaxIterations(5);
+  icp.SetMaxCorrespondenceDistance(0.5);
+  icp.SetTolerance(1e-3, 1e-4);
+  icp.SetNormalNeighbors(6);
+  icp.SetThreadCount(3);
+  EXPECT_EQ(IcpRegistration::POINT_TO_PLANE, icp.GetMetric());
+  EXPECT_EQ(5u, icp.MaxIterations());
+  EXPECT_DOUBLE_EQ(0.5, icp.MaxCorrespondenceDistance());
+  EXPECT_DOUBLE_EQ(1e-3, icp.TranslationTolerance());
+  EXPECT_DOUBLE_EQ(1e-4, icp.RotationTolerance());
+  EXPECT_EQ(6u, icp.NormalNeighbors());
+  EXPECT_EQ(3u, icp.ThreadCount());
+
+  IcpRegistration copy(icp);
+  EXPECT_EQ(5u, copy.MaxIterations());
+  IcpRegistration assigned;
+  assigned = icp;
+  EXPECT_EQ(IcpRegistration::POINT_TO_PLANE, assigned.GetMetric());
+}
+
+/////////////////////////////////////////////////
+TEST(IcpRegistrationTest, PointToPoint)
+{
+  const std::vector<Vector3d> target = Surface(40);
+  const std::vector<Vector3d> source = InFrame(target, kTruth);
+
+  IcpRegistration icp(target);
+  EXPECT_EQ(target.size(), icp.Target().size());
+  IcpRegistration::Result result = icp.Align(source);
+  EXPECT_TRUE(result.converged);
+  EXPECT_GT(result.iterations, 1u);
+  EXPECT_EQ(source.size(), result.inliers);
+  EXPECT_LT(result.rmsError, 1e-6);
+  EXPECT_TRUE(result.pose.Pos().Equal(kTruth.Pos(), 1e-6));
+  EXPECT_TRUE(result.pose.Rot().Equal(kTruth.Rot(), 1e-6));
+
+  // Starting from the solution
+  result = icp.Align(Vector3SoAd(source), kTruth);
+  EXPECT_TRUE(result.converged);
+  EXPECT_EQ(1u, result.iterations);
+  EXPECT_TRUE(result.pose.Pos().Equal(kTruth.Pos(), 1e-9));
+}
+
+/////////////////////////////////////////////////
+TEST(IcpRegistrationTest, PointToPlane)
+{
+  const std::vector<Vector3d> target = Surface(40);
+  const std::vector<Vector3d> source = InFrame(target, kTruth);
+
+  IcpRegistration icp(target);
+  const unsigned int pointIterations = icp.Align(source).iterations;
+
+  icp.SetMetric(IcpRegistration::POINT_TO_PLANE);
+  IcpRegistration::Result result = icp.Align(source);
+  EXPECT_TRUE(result.converged);
+  EXPECT_LT(result.iterations, pointIterations);
+  EXPECT_EQ(source.size(), result.inliers);
+  EXPECT_LT(result.rmsError, 1e-6);
+  EXPECT_TRUE(result.pose.Pos().Equal(kTruth.Pos(), 1e-6));
+  EXPECT_TRUE(result.pose.Rot().Equal(kTruth.Rot(), 1e-6));
+
+  // Exact normals
+  std::vector<Vector3d> normals;
+  for (const Vector3d &p : target)
+  {
+    const double x = p.X(), y = p.Y();
+    normals.push_back(Vector3d(
+        -(0.6 * std::cos(2 * x) * std::cos(3 * y) + 0.1),
+        0.9 * std::sin(2 * x) * std::sin(3 * y), 1).Normalize());
+  }
+  EXPECT_TRUE(icp.SetTarget(target, normals));
+  EXPECT_EQ(normals, icp.TargetNormals());
+  icp.SetNormalNeighbors(8);
+  EXPECT_EQ(normals, icp.TargetNormals());
+  result = icp.Align(source);
+  EXPECT_TRUE(result.converged);
+  EXPECT_TRUE(result.pose.Pos().Equal(kTruth.Pos(), 1e-6));
+  EXPECT_TRUE(result.pose.Rot().Equal(kTruth.Rot(), 1e-6));
+
+  // A normal per point is required
+  normals.pop_back();
+  EXPECT_FALSE(icp.SetTarget(target, normals));
+  EXPECT_EQ(target.size(), icp.TargetNormals().size());
+}
+
+/////////////////////////////////////////////////
+TEST(IcpRegistrationTest, EstimatedNormals)
+{
+  std::vector<Vector3d> target;
+  for (int i = 0; i < 10; ++i)
+  {
+    for (int j = 0; j < 10; ++j)
+      target.emplace_back(i * 0.1, j * 0.1, 2.0);
+  }
+  target.emplace_back(std::numeric_limits<double>::quiet_NaN(), 0, 0);
+
+  IcpRegistration icp(target);
+  const std::vector<Vector3d> &normals = icp.TargetNormals();
+  ASSERT_EQ(target.size(), normals.size());
+  for (std::size_t i = 0; i + 1 < normals.size(); ++i)
+    EXPECT_NEAR(1.0, std::abs(normals[i].Z()), 1e-12) << i;
+  EXPECT_EQ(Vector3d::Zero, normals.back());
+
+  // Collinear and too few neighbors
+  icp.SetTarget({Vector3d(0, 0, 0), Vector3d(1, 0, 0), Vector3d(2, 0, 0)});
+  for (const Vector3d &n : icp.TargetNormals())
+    EXPECT_EQ(Vector3d::Zero, n);
+  icp.SetTarget({Vector3d(0, 0, 0), Vector3d(1, 0, 0)});
+  for (const Vector3d &n : icp.TargetNormals())
+    EXPECT_EQ(Vector3d::Zero, n);
+}
+
+/////////////////////////////////////////////////
+TEST(IcpRegistrationTest, MaxCorrespondenceDistance)
+{
+  const std::vector<Vector3d> target = Surface(40);
+  std::vector<Vector3d> source = InFrame(target, kTruth);
+  const std::size_t surfacePoints = source.size();
+  for (int i = 0; i < 50; ++i)
+    source.emplace_back(0.1 * i, 5.0, 3.0);
+
+  for (auto metric : {IcpRegistration::POINT_TO_POINT,
+                      IcpRegistration::POINT_TO_PLANE})
+  {
+    IcpRegistration icp(target);
+    icp.SetMetric(metric);
+    icp.SetMaxCorrespondenceDistance(0.2);
+    const IcpRegistration::Result result = icp.Align(source);
+    EXPECT_TRUE(result.converged);
+    EXPECT_EQ(surfacePoints, result.inliers);
+    EXPECT_TRUE(result.pose.Pos().Equal(kTruth.Pos(), 1e-6));
+    EXPECT_TRUE(result.pose.Rot().Equal(kTruth.Rot(), 1e-6));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(IcpRegistrationTest, Threads)
+{
+  const std::vector<Vector3d> target = Surface(80);
+  const std::vector<Vector3d> source = InFrame(target, kTruth);
+
+  for (auto metric : {IcpRegistration::POINT_TO_POINT,
+                      IcpRegistration::POINT_TO_PLANE})
+  {
+    IcpRegistration icp(target);
+    icp.SetMetric(metric);
+    const IcpRegistration::Result serial = icp.Align(source);
+
+    icp.SetThreadCount(4);
+    const IcpRegistration::Result threaded = icp.Align(source);
+    EXPECT_EQ(serial.iterations, threaded.iterations);
+    EXPECT_EQ(serial.inliers, threaded.inliers);
+    EXPECT_TRUE(threaded.pose.Pos().Equal(serial.pose.Pos(), 1e-9));
+    EXPECT_TRUE(threaded.pose.Rot().Equal(serial.pose.Rot(), 1e-9));
+
+    // The same blocks give the same result on any executor
+    icp.SetExecutor(std::make_shared<ThreadPool>(3));
+    const IcpRegistration::Result pool = icp.Align(source);
+    icp.SetExecutor(std::make_shared<FunctionExecutor>(
+        [](const std::size_t _count,
+           const std::function<void(std::size_t)> &_task)
+        {
+          for (std::size_t i = _count; i-- > 0;)
+            _task(i);
+        }, 3));
+    const IcpRegistration::Result reversed = icp.Align(source);
+    EXPECT_EQ(pool.pose, reversed.pose);
+    EXPECT_DOUBLE_EQ(pool.rmsError, reversed.rmsError);
+    EXPECT_TRUE(pool.pose.Pos().Equal(serial.pose.Pos(), 1e-9));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(IcpRegistrationTest, Degenerate)
+{
+  const Pose3d initial(1, 2, 3, 0, 0, 0.5);
+
+  // No target
+  IcpRegistration icp;
+  IcpRegistration::Result result =
+      icp.Align({Vector3d(1, 0, 0), Vector3d(0, 1, 0), Vector3d(0, 0, 1)},
+                initial);
+  EXPECT_FALSE(result.converged);
+  EXPECT_EQ(0u, result.iterations);
+  EXPECT_EQ(0u, result.inliers);
+  EXPECT_DOUBLE_EQ(0.0, result.rmsError);
+  EXPECT_EQ(initial, result.pose);
+
+  // No source
+  icp.SetTarget(Surface(10));
+  result = icp.Align(Vector3SoAd(), initial);
+  EXPECT_FALSE(result.converged);
+  EXPECT_EQ(initial, result.pose);
+
+  // Collinear points don't determine the rotation about their line
+  std::vector<Vector3d> line;
+  for (int i = 0; i < 20; ++i)
+    line.emplace_back(i * 0.1, 0, 0);
+  icp.SetTarget(line);
+  result = icp.Align(line, Pose3d(0.01, 0, 0, 0, 0, 0));
+  EXPECT_FALSE(result.converged);
+  EXPECT_EQ(0u, result.iterations);
+  EXPECT_EQ(line.size(), result.inliers);
+
+  // No iteration allowed
+  icp.SetTarget(Surface(10));
+  icp.SetMaxIterations(0);
+  result = icp.Align(Surface(10), initial);
+  EXPECT_FALSE(result.converged);
+  EXPECT_EQ(0u, result.iterations);
+  EXPECT_EQ(100u, result.inliers);
+  EXPECT_GT(result.rmsError, 0.0);
+}
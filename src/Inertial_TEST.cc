@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 
 #include "gz/math/Inertial.hh"
 
@@ -603,3 +604,58 @@ TEST(Inertiald_Test, AdditionInvalid)
     EXPECT_TRUE((i0 + i).MassMatrix().IsValid());
   }
 }
+
+/////////////////////////////////////////////////
+TEST(Inertiald_Test, Sum)
+{
+  // Empty and zero mass ranges
+  std::vector<math::Inertiald> inertials;
+  EXPECT_EQ(math::Inertiald(), math::Inertiald::Sum(inertials));
+  const math::MassMatrix3d m0(0.0, math::Vector3d::Zero, math::Vector3d::Zero);
+  inertials.emplace_back(m0, math::Pose3d(-1, 0, 0, 0, 0, 0));
+  inertials.emplace_back(m0, math::Pose3d(1, 0, 0, 0, 0, 0));
+  EXPECT_EQ(inertials[0], math::Inertiald::Sum(inertials));
+
+  // Two half-cubes
+  {
+    math::MassMatrix3d cubeMM3;
+    EXPECT_TRUE(cubeMM3.SetFromBox(12.0, math::Vector3d(1, 1, 1)));
+    const math::Inertiald cube(cubeMM3, math::Pose3d::Zero);
+    math::MassMatrix3d half;
+    EXPECT_TRUE(half.SetFromBox(6.0, math::Vector3d(0.5, 1, 1)));
+    const math::Inertiald halves[] = {
+      math::Inertiald(half, math::Pose3d(-0.25, 0, 0, 0, 0, 0)),
+      math::Inertiald(half, math::Pose3d(0.25, 0, 0, 0, 0, 0))};
+    EXPECT_EQ(cube, math::Inertiald::Sum(halves, halves + 2));
+  }
+
+  // Many rotated bodies far from the origin give the same result as
+  // adding them one by one
+  inertials.clear();
+  for (int i = 0; i < 1000; ++i)
+  {
+    const double x = i % 10, y = (i / 10) % 10, z = i / 100;
+    const math::MassMatrix3d m(1.0 + 0.1 * (i % 7),
+        math::Vector3d(3 + 0.1 * x, 3 + 0.1 * y, 3 + 0.1 * z),
+        math::Vector3d(0.1, 0.2 - 0.01 * x, 0.3));
+    ASSERT_TRUE(m.IsValid());
+    inertials.emplace_back(m,
+        math::Pose3d(1000 + x, -500 + y, z, 0.1 * x, 0.2 * y, 0.3 * z));
+  }
+  math::Inertiald pairwise = inertials[0];
+  for (std::size_t i = 1; i < inertials.size(); ++i)
+    pairwise += inertials[i];
+
+  const math::Inertiald sum = math::Inertiald::Sum(inertials);
+  EXPECT_DOUBLE_EQ(pairwise.MassMatrix().Mass(), sum.MassMatrix().Mass());
+  EXPECT_EQ(math::Quaterniond::Identity, sum.Pose().Rot());
+  EXPECT_TRUE(sum.Pose().Pos().Equal(pairwise.Pose().Pos(), 1e-9));
+  const math::Matrix3d moi = sum.Moi();
+  const math::Matrix3d expected = pairwise.Moi();
+  for (int r = 0; r < 3; ++r)
+  {
+    for (int c = 0; c < 3; ++c)
+      EXPECT_NEAR(expected(r, c), moi(r, c), 1e-9 * expected(0, 0));
+  }
+  EXPECT_TRUE(sum.MassMatrix().IsValid());
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <array>
+#include <atomic>
+
+#include "gz/math/Instrumentation.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Counters of a subsystem, updated by all threads.
+  struct AtomicCounters
+  {
+    /// \brief Number of heap allocations.
+    std::atomic<uint64_t> allocations{0};
+
+    /// \brief Bytes allocated.
+    std::atomic<uint64_t> allocatedBytes{0};
+
+    /// \brief Number of deep copies.
+    std::atomic<uint64_t> copies{0};
+
+    /// \brief Bytes copied.
+    std::atomic<uint64_t> copiedBytes{0};
+  };
+
+  /// \brief Get the counters of a subsystem.
+  /// \param[in] _subsystem The subsystem.
+  /// \return Reference to the counters.
+  AtomicCounters &Counters(const InstrumentedSubsystem _subsystem)
+  {
+    static std::array<AtomicCounters, kInstrumentedSubsystemCount> counters;
+    return counters[static_cast<std::size_t>(_subsystem)];
+  }
+}
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    /////////////////////////////////////////////
+    bool InstrumentationEnabled()
+    {
+#ifdef IGNITION_MATH_INSTRUMENTATION
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    /////////////////////////////////////////////
+    InstrumentationCounters SubsystemCounters(
+        const InstrumentedSubsystem _subsystem)
+    {
+      const AtomicCounters &c = Counters(_subsystem);
+      InstrumentationCounters res;
+      res.allocations = c.allocations.load(std::memory_order_relaxed);
+      res.allocatedBytes = c.allocatedBytes.load(std::memory_order_relaxed);
+      res.copies = c.copies.load(std::memory_order_relaxed);
+      res.copiedBytes = c.copiedBytes.load(std::memory_order_relaxed);
+      return res;
+    }
+
+    /////////////////////////////////////////////
+    InstrumentationCounters TotalCounters()
+    {
+      InstrumentationCounters res;
+      for (std::size_t i = 0; i < kInstrumentedSubsystemCount; ++i)
+      {
+        const InstrumentationCounters c =
+            SubsystemCounters(static_cast<InstrumentedSubsystem>(i));
+        res.allocations += c.allocations;
+        res.allocatedBytes += c.allocatedBytes;
+        res.copies += c.copies;
+        res.copiedBytes += c.copiedBytes;
+      }
+      return res;
+    }
+
+    /////////////////////////////////////////////
+    void ResetInstrumentationCounters()
+    {
+      for (std::size_t i = 0; i < kInstrumentedSubsystemCount; ++i)
+      {
+        AtomicCounters &c = Counters(static_cast<InstrumentedSubsystem>(i));
+        c.allocations.store(0, std::memory_order_relaxed);
+        c.allocatedBytes.store(0, std::memory_order_relaxed);
+        c.copies.store(0, std::memory_order_relaxed);
+        c.copiedBytes.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    /////////////////////////////////////////////
+    const char *InstrumentedSubsystemName(
+        const InstrumentedSubsystem _subsystem)
+    {
+      switch (_subsystem)
+      {
+        case InstrumentedSubsystem::GRAPH:
+          return "graph";
+        case InstrumentedSubsystem::INTERSECTIONS:
+          return "intersections";
+        case InstrumentedSubsystem::PIMPL:
+          return "pimpl";
+        case InstrumentedSubsystem::KMEANS:
+          return "kmeans";
+        default:
+          break;
+      }
+      return "unknown";
+    }
+
+    /////////////////////////////////////////////
+    void CountAllocations(const InstrumentedSubsystem _subsystem,
+        const uint64_t _count, const uint64_t _bytes)
+    {
+      if (_count == 0)
+        return;
+      AtomicCounters &c = Counters(_subsystem);
+      c.allocations.fetch_add(_count, std::memory_order_relaxed);
+      c.allocatedBytes.fetch_add(_bytes, std::memory_order_relaxed);
+    }
+
+    /////////////////////////////////////////////
+    void CountCopy(const InstrumentedSubsystem _subsystem,
+        const uint64_t _bytes)
+    {
+      AtomicCounters &c = Counters(_subsystem);
+      c.copies.fetch_add(1, std::memory_order_relaxed);
+      c.copiedBytes.fetch_add(_bytes, std::memory_order_relaxed);
+    }
+    }
+  }
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gz/math/AxisAlignedBox.hh"
+#include "gz/math/Box.hh"
+#include "gz/math/Frustum.hh"
+#include "gz/math/Instrumentation.hh"
+#include "gz/math/Kmeans.hh"
+#include "gz/math/Material.hh"
+#include "gz/math/graph/Graph.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Reset the counters before each test.
+class InstrumentationTest : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    math::ResetInstrumentationCounters();
+  }
+
+  /// \brief Get the counters of a subsystem.
+  /// \param[in] _subsystem The subsystem.
+  /// \return The counters.
+  protected: static math::InstrumentationCounters Counters(
+      const math::InstrumentedSubsystem _subsystem)
+  {
+    return math::SubsystemCounters(_subsystem);
+  }
+
+  /// \brief Expected value of a counter: the counted value in
+  /// instrumented builds, and zero otherwise.
+  /// \param[in] _value The counted value.
+  /// \return The expected value.
+  protected: static uint64_t Expected(const uint64_t _value)
+  {
+    return math::InstrumentationEnabled() ? _value : 0;
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(InstrumentationTest, Names)
+{
+  EXPECT_EQ(std::string("graph"),
+      math::InstrumentedSubsystemName(math::InstrumentedSubsystem::GRAPH));
+  EXPECT_EQ(std::string("intersections"), math::InstrumentedSubsystemName(
+      math::InstrumentedSubsystem::INTERSECTIONS));
+  EXPECT_EQ(std::string("pimpl"),
+      math::InstrumentedSubsystemName(math::InstrumentedSubsystem::PIMPL));
+  EXPECT_EQ(std::string("kmeans"),
+      math::InstrumentedSubsystemName(math::InstrumentedSubsystem::KMEANS));
+}
+
+/////////////////////////////////////////////////
+TEST_F(InstrumentationTest, CountAndReset)
+{
+  math::CountAllocations(math::InstrumentedSubsystem::GRAPH, 3, 48);
+  math::CountCopy(math::InstrumentedSubsystem::PIMPL, 16);
+  math::CountCopy(math::InstrumentedSubsystem::PIMPL, 8);
+
+  auto graph = Counters(math::InstrumentedSubsystem::GRAPH);
+  EXPECT_EQ(3u, graph.allocations);
+  EXPECT_EQ(48u, graph.allocatedBytes);
+  EXPECT_EQ(0u, graph.copies);
+
+  auto total = math::TotalCounters();
+  EXPECT_EQ(3u, total.allocations);
+  EXPECT_EQ(48u, total.allocatedBytes);
+  EXPECT_EQ(2u, total.copies);
+  EXPECT_EQ(24u, total.copiedBytes);
+
+  math::ResetInstrumentationCounters();
+  total = math::TotalCounters();
+  EXPECT_EQ(0u, total.allocations);
+  EXPECT_EQ(0u, total.allocatedBytes);
+  EXPECT_EQ(0u, total.copies);
+  EXPECT_EQ(0u, total.copiedBytes);
+}
+
+/////////////////////////////////////////////////
+TEST_F(InstrumentationTest, Graph)
+{
+  math::graph::UndirectedGraph<int, double> graph(
+      {{{"0", 0, 0}, {"1", 1, 1}, {"2", 2, 2}},
+       {{{0, 1}, 1, 1.0}, {{1, 2}, 1, 1.0}}});
+  math::ResetInstrumentationCounters();
+
+  EXPECT_EQ(2u, graph.AdjacentsFrom(1).size());
+  EXPECT_EQ(3u, graph.Vertices().size());
+
+  const auto counters = Counters(math::InstrumentedSubsystem::GRAPH);
+  EXPECT_EQ(Expected(5), counters.allocations);
+  EXPECT_EQ(0u, counters.copies);
+
+  // Visiting the adjacency in place allocates nothing.
+  math::ResetInstrumentationCounters();
+  int count = 0;
+  graph.ForEachAdjacentFrom(1, [&count](const auto &, const auto &)
+  {
+    ++count;
+  });
+  EXPECT_EQ(2, count);
+  EXPECT_EQ(0u, math::TotalCounters().allocations);
+}
+
+/////////////////////////////////////////////////
+TEST_F(InstrumentationTest, Intersections)
+{
+  math::Boxd box(2, 2, 2);
+  const math::Planed plane(math::Vector3d::UnitZ, 0.0);
+
+  const auto vertices = box.VerticesBelow(plane);
+  EXPECT_EQ(4u, vertices.size());
+  auto counters = Counters(math::InstrumentedSubsystem::INTERSECTIONS);
+  EXPECT_EQ(Expected(4), counters.allocations);
+  EXPECT_EQ(Expected(4 * sizeof(math::Vector3d)), counters.allocatedBytes);
+
+  // The fixed capacity overload allocates nothing.
+  math::ResetInstrumentationCounters();
+  math::BoxIntersectionPoints<double> fixed;
+  box.VerticesBelow(plane, fixed);
+  EXPECT_EQ(4u, fixed.Size());
+  EXPECT_EQ(0u, math::TotalCounters().allocations);
+}
+
+/////////////////////////////////////////////////
+TEST_F(InstrumentationTest, Pimpl)
+{
+  const math::AxisAlignedBox box(math::Vector3d::Zero, math::Vector3d::One);
+  math::AxisAlignedBox copy(box);
+  copy = box;
+  math::AxisAlignedBox moved(std::move(copy));
+
+  const math::Frustum frustum;
+  math::Frustum frustumCopy(frustum);
+
+  const auto counters = Counters(math::InstrumentedSubsystem::PIMPL);
+  EXPECT_EQ(Expected(3), counters.copies);
+  EXPECT_EQ(0u, counters.allocations);
+}
+
+/////////////////////////////////////////////////
+TEST_F(InstrumentationTest, Material)
+{
+  // Shapes share their material with their copies.
+  const math::Boxd box(1, 2, 3, math::Material(math::MaterialType::WOOD));
+  std::vector<math::Boxd> boxes(100, box);
+  std::vector<math::Boxd> copies(boxes);
+  math::Material custom(500.0);
+  math::Material customCopy(custom);
+  EXPECT_EQ(0u, Counters(math::InstrumentedSubsystem::PIMPL).copies);
+
+  // Changing a shared material copies its data once.
+  copies[0].SetDensityFromMass(12.0);
+  customCopy.SetDensity(600.0);
+  customCopy.SetName("custom");
+  EXPECT_EQ(Expected(2),
+            Counters(math::InstrumentedSubsystem::PIMPL).copies);
+  EXPECT_EQ(box.Material(), boxes[0].Material());
+}
+
+/////////////////////////////////////////////////
+TEST_F(InstrumentationTest, Kmeans)
+{
+  std::vector<math::Vector3d> obs;
+  for (int i = 0; i < 10; ++i)
+    obs.emplace_back(i % 2 ? 10 : -10, i, 0);
+
+  // Moving the observations in doesn't copy them.
+  math::Kmeans kmeans{std::vector<math::Vector3d>(obs)};
+  EXPECT_EQ(0u, Counters(math::InstrumentedSubsystem::KMEANS).copies);
+
+  math::Kmeans copied(obs);
+  auto counters = Counters(math::InstrumentedSubsystem::KMEANS);
+  EXPECT_EQ(Expected(1), counters.copies);
+  EXPECT_EQ(Expected(10 * sizeof(math::Vector3d)), counters.copiedBytes);
+
+  math::ResetInstrumentationCounters();
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  EXPECT_TRUE(kmeans.Cluster(2, centroids, labels));
+  counters = Counters(math::InstrumentedSubsystem::KMEANS);
+  EXPECT_EQ(Expected(1), counters.copies);
+  EXPECT_EQ(Expected(2 * sizeof(math::Vector3d) + 10 * sizeof(unsigned int)),
+            counters.copiedBytes);
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "gz/math/Helpers.hh"
+#include "gz/math/IntervalSet.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(IntervalSetTest, Construction)
+{
+  EXPECT_TRUE(math::IntervalSetd().Empty());
+  EXPECT_TRUE(math::IntervalSetd(math::Intervald::Open(1., 1.)).Empty());
+
+  // Intervals are sorted, and merged where they overlap or touch.
+  const math::IntervalSetd set({
+      math::Intervald::Closed(5., 6.),
+      math::Intervald::LeftClosed(0., 1.),
+      math::Intervald::Closed(1., 2.),
+      math::Intervald::Open(3., 4.),
+      math::Intervald::Open(4., 5.),
+      math::Intervald::Open(7., 7.),
+      math::Intervald::Closed(0.5, 1.5)});
+  ASSERT_EQ(3u, set.Intervals().size());
+  EXPECT_EQ(math::Intervald::Closed(0., 2.), set.Intervals()[0]);
+  EXPECT_EQ(math::Intervald::Open(3., 4.), set.Intervals()[1]);
+  EXPECT_EQ(math::Intervald::RightClosed(4., 6.), set.Intervals()[2]);
+
+  std::ostringstream os;
+  os << set;
+  EXPECT_EQ("[0, 2] U (3, 4) U (4, 6]", os.str());
+  os.str("");
+  os << math::IntervalSetd();
+  EXPECT_EQ("{}", os.str());
+}
+
+/////////////////////////////////////////////////
+TEST(IntervalSetTest, Membership)
+{
+  const math::IntervalSetd set({
+      math::Intervald::LeftClosed(0., 1.),
+      math::Intervald::Open(2., 3.),
+      math::Intervald::Closed(3., 3.),
+      math::Intervald::RightClosed(5., 8.)});
+
+  EXPECT_FALSE(set.Contains(-1.));
+  EXPECT_TRUE(set.Contains(0.));
+  EXPECT_TRUE(set.Contains(0.5));
+  EXPECT_FALSE(set.Contains(1.));
+  EXPECT_FALSE(set.Contains(2.));
+  EXPECT_TRUE(set.Contains(3.));
+  EXPECT_FALSE(set.Contains(5.));
+  EXPECT_TRUE(set.Contains(8.));
+  EXPECT_FALSE(set.Contains(9.));
+  EXPECT_FALSE(set.Contains(math::NAN_D));
+
+  EXPECT_TRUE(set.Contains(math::Intervald::RightClosed(2., 3.)));
+  EXPECT_FALSE(set.Contains(math::Intervald::Closed(2., 3.)));
+  EXPECT_FALSE(set.Contains(math::Intervald::Closed(0., 2.)));
+  EXPECT_TRUE(set.Contains(math::Intervald::Open(5., 8.)));
+
+  EXPECT_TRUE(set.Intersects(math::Intervald::Closed(-1., 0.)));
+  EXPECT_FALSE(set.Intersects(math::Intervald::Open(-1., 0.)));
+  EXPECT_FALSE(set.Intersects(math::Intervald::Closed(1., 2.)));
+  EXPECT_TRUE(set.Intersects(math::Intervald::Closed(3.5, 5.5)));
+  EXPECT_FALSE(set.Intersects(math::Intervald::Closed(3.5, 5.)));
+  EXPECT_TRUE(set.Intersects(math::Intervald::Unbounded));
+}
+
+/////////////////////////////////////////////////
+TEST(IntervalSetTest, Operations)
+{
+  const math::IntervalSetd a({
+      math::Intervald::Closed(0., 2.),
+      math::Intervald::Open(4., 6.)});
+  const math::IntervalSetd b({
+      math::Intervald::LeftClosed(1., 4.),
+      math::Intervald::Closed(5., 7.)});
+
+  EXPECT_EQ(math::IntervalSetd({math::Intervald::LeftClosed(0., 4.),
+                                math::Intervald::RightClosed(4., 7.)}),
+            a.Union(b));
+  EXPECT_EQ(math::IntervalSetd({math::Intervald::Closed(1., 2.),
+                                math::Intervald::LeftClosed(5., 6.)}),
+            a.Intersection(b));
+  EXPECT_EQ(math::IntervalSetd({math::Intervald::LeftClosed(0., 1.),
+                                math::Intervald::Open(4., 5.)}),
+            a.Difference(b));
+
+  const math::IntervalSetd complement = a.Complement();
+  ASSERT_EQ(3u, complement.Intervals().size());
+  EXPECT_EQ(math::Intervald::Open(-math::INF_D, 0.),
+            complement.Intervals()[0]);
+  EXPECT_EQ(math::Intervald::RightClosed(2., 4.),
+            complement.Intervals()[1]);
+  EXPECT_EQ(math::Intervald::LeftClosed(6., math::INF_D),
+            complement.Intervals()[2]);
+  EXPECT_EQ(a, complement.Complement());
+  EXPECT_EQ(math::IntervalSetd(math::Intervald::Unbounded),
+            math::IntervalSetd().Complement());
+  EXPECT_TRUE(math::IntervalSetd(math::Intervald::Unbounded)
+      .Complement().Empty());
+
+  math::IntervalSetd c = a;
+  c.Add(math::Intervald::Closed(2., 4.));
+  EXPECT_EQ(math::IntervalSetd(math::Intervald::LeftClosed(0., 6.)), c);
+  EXPECT_NE(a, c);
+
+  // Operations agree with membership of their operands.
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> u(0., 20.);
+  std::vector<math::Intervald> intervals;
+  for (int i = 0; i < 40; ++i)
+  {
+    const double left = std::floor(u(rng));
+    intervals.emplace_back(left, i % 2 == 0, left + std::floor(u(rng) / 8.),
+                           i % 3 == 0);
+  }
+  const math::IntervalSetd x(std::vector<math::Intervald>(
+      intervals.begin(), intervals.begin() + 20));
+  const math::IntervalSetd y(std::vector<math::Intervald>(
+      intervals.begin() + 20, intervals.end()));
+  const auto unite = x.Union(y);
+  const auto intersect = x.Intersection(y);
+  const auto difference = x.Difference(y);
+  for (double v = -1.; v <= 30.; v += 0.25)
+  {
+    EXPECT_EQ(x.Contains(v) || y.Contains(v), unite.Contains(v)) << v;
+    EXPECT_EQ(x.Contains(v) && y.Contains(v), intersect.Contains(v)) << v;
+    EXPECT_EQ(x.Contains(v) && !y.Contains(v), difference.Contains(v))
+        << v;
+    EXPECT_NE(x.Contains(v), x.Complement().Contains(v)) << v;
+  }
+}
@@ -15,8 +15,11 @@
  *
 */
 #include <gtest/gtest.h>
+#include <cstdint>
 #include <ostream>
+#include <vector>
 
+#include "gz/math/Helpers.hh"
 #include "gz/math/Interval.hh"
 
 using namespace gz;
@@ -196,6 +199,38 @@ TEST(IntervalTest, IntervalIntersection)
   EXPECT_TRUE(closedInterval.Intersects(math::Intervald::RightClosed(-1., 0.)));
 }
 
+/////////////////////////////////////////////////
+TEST(IntervalTest, IntervalIntersectionOf)
+{
+  const math::Intervald closedInterval = math::Intervald::Closed(0., 1.);
+  EXPECT_EQ(math::Intervald::Closed(0.5, 1.),
+            closedInterval.Intersection(math::Intervald::Closed(0.5, 1.5)));
+  EXPECT_EQ(math::Intervald::LeftClosed(0., 0.5),
+            closedInterval.Intersection(math::Intervald::Open(-0.5, 0.5)));
+  EXPECT_EQ(closedInterval,
+            closedInterval.Intersection(math::Intervald::Unbounded));
+  EXPECT_EQ(math::Intervald::Closed(0.25, 0.75),
+            math::Intervald::Closed(0.25, 0.75).Intersection(closedInterval));
+
+  // Coincident bounds are closed only if closed in both intervals
+  const math::Intervald sameBounds =
+      closedInterval.Intersection(math::Intervald::LeftClosed(0., 1.));
+  EXPECT_TRUE(sameBounds.IsLeftClosed());
+  EXPECT_FALSE(sameBounds.IsRightClosed());
+  EXPECT_DOUBLE_EQ(0., sameBounds.LeftValue());
+  EXPECT_DOUBLE_EQ(1., sameBounds.RightValue());
+
+  // Touching and disjoint intervals
+  const math::Intervald point =
+      closedInterval.Intersection(math::Intervald::Closed(1., 2.));
+  EXPECT_FALSE(point.Empty());
+  EXPECT_TRUE(point.Contains(1.));
+  EXPECT_TRUE(closedInterval.Intersection(
+      math::Intervald::LeftClosed(-1., 0.)).Empty());
+  EXPECT_TRUE(closedInterval.Intersection(
+      math::Intervald::Open(2., 3.)).Empty());
+}
+
 /////////////////////////////////////////////////
 TEST(IntervalTest, IntervalStreaming)
 {
@@ -220,3 +255,54 @@ TEST(IntervalTest, IntervalStreaming)
     EXPECT_EQ(os.str(), "[0, 1]");
   }
 }
+
+/////////////////////////////////////////////////
+TEST(IntervalTest, BatchContains)
+{
+  // Values on and around the bounds, and past both ends of a block.
+  std::vector<double> values;
+  for (int i = 0; i < 150; ++i)
+    values.push_back(-1. + 0.02 * i);
+  values.push_back(std::nextafter(0., 1.));
+  values.push_back(std::nextafter(1., 0.));
+  values.push_back(math::INF_D);
+  values.push_back(-math::INF_D);
+  values.push_back(math::NAN_D);
+
+  for (const auto &interval : {
+          math::Intervald::Open(0., 1.), math::Intervald::Closed(0., 1.),
+          math::Intervald::LeftClosed(0., 1.),
+          math::Intervald::RightClosed(0., 1.),
+          math::Intervald::Open(0., 0.), math::Intervald::Closed(1., 1.),
+          math::Intervald::Unbounded})
+  {
+    std::vector<uint64_t> contained;
+    const std::size_t count =
+        interval.Contains(values.data(), values.size(), contained);
+    ASSERT_EQ(3u, contained.size());
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+      const bool bit = (contained[i / 64] >> (i % 64)) & 1;
+      EXPECT_EQ(interval.Contains(values[i]), bit) << interval << " "
+                                                   << values[i];
+      expected += interval.Contains(values[i]);
+    }
+    EXPECT_EQ(expected, count);
+    EXPECT_EQ(0u, contained.back() >> (values.size() % 64));
+  }
+
+  // Integral intervals.
+  const std::vector<int> ints = {-1, 0, 1, 2, 3,
+      std::numeric_limits<int>::max()};
+  std::vector<uint64_t> contained;
+  EXPECT_EQ(2u, math::Interval<int>::Open(0, 3).Contains(
+      ints.data(), ints.size(), contained));
+  EXPECT_EQ(0b001100u, contained[0]);
+  EXPECT_EQ(0u, math::Interval<int>::Open(
+      std::numeric_limits<int>::max(), std::numeric_limits<int>::max())
+      .Contains(ints.data(), ints.size(), contained));
+  EXPECT_EQ(0u, math::Intervald::Closed(0., 1.).Contains(
+      values.data(), 0, contained));
+  EXPECT_TRUE(contained.empty());
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "gz/math/KalmanFilter.hh"
+
+using namespace gz;
+
+using Matrix2 = math::MatrixN<double, 2, 2>;
+using Vector2 = math::VectorN<double, 2>;
+using Vector1 = math::VectorN<double, 1>;
+
+/////////////////////////////////////////////////
+TEST(KalmanFilterTest, ScalarConstant)
+{
+  // Estimating a constant from noisy samples averages them
+  math::KalmanFilter<double, 1, 1> filter(Vector1{0},
+                                          math::MatrixN<double, 1, 1>{1e6});
+  const auto one = math::MatrixN<double, 1, 1>::Identity();
+  const auto r = math::MatrixN<double, 1, 1>{4};
+  const double samples[] = {1.0, 3.0, 2.0, 2.5, 1.5};
+  for (const double z : samples)
+    ASSERT_TRUE(filter.Update(Vector1{z}, one, r));
+  EXPECT_NEAR(2.0, filter.State()[0], 1e-5);
+  EXPECT_NEAR(4.0 / 5, filter.Covariance()(0, 0), 1e-5);
+
+  // Prediction adds the process noise
+  filter.Predict(one, math::MatrixN<double, 1, 1>{0.2});
+  EXPECT_NEAR(1.0, filter.Covariance()(0, 0), 1e-5);
+
+  // A non positive definite innovation covariance is rejected
+  filter.SetCovariance(math::MatrixN<double, 1, 1>{-10});
+  const Vector1 before = filter.State();
+  EXPECT_FALSE(filter.Update(Vector1{5}, one, r));
+  EXPECT_EQ(before, filter.State());
+}
+
+/////////////////////////////////////////////////
+TEST(KalmanFilterTest, ConstantVelocity)
+{
+  // Position and velocity, with position measurements
+  const double dt = 0.1;
+  const Matrix2 f = {1, dt, 0, 1};
+  const Matrix2 q = Matrix2{dt * dt * dt / 3, dt * dt / 2,
+                            dt * dt / 2, dt} * 0.01;
+  const math::MatrixN<double, 1, 2> h = {1, 0};
+  const math::MatrixN<double, 1, 1> r = {0.01};
+
+  math::KalmanFilter<double, 2, 1> filter(Vector2{0, 0},
+                                          Matrix2::Identity() * 10);
+  for (int i = 1; i <= 100; ++i)
+  {
+    filter.Predict(f, q);
+    const double noise = 0.05 * std::sin(i * 1.7);
+    ASSERT_TRUE(filter.Update(Vector1{2.0 * i * dt + noise}, h, r));
+
+    // The Joseph form keeps the covariance symmetric
+    const Matrix2 &p = filter.Covariance();
+    EXPECT_DOUBLE_EQ(p(0, 1), p(1, 0));
+    EXPECT_GT(p(0, 0), 0);
+    EXPECT_GT(p(0, 0) * p(1, 1) - p(0, 1) * p(1, 0), 0);
+  }
+  EXPECT_NEAR(20.0, filter.State()[0], 0.1);
+  EXPECT_NEAR(2.0, filter.State()[1], 0.1);
+
+  // The extended update with a linear model gives the same result
+  math::KalmanFilter<double, 2, 1> extended = filter;
+  filter.Update(Vector1{20.3}, h, r);
+  extended.Update(Vector1{20.3}, h * extended.State(), h, r);
+  EXPECT_TRUE(filter.State().Equal(extended.State(), 1e-12));
+  EXPECT_TRUE(filter.Covariance().Equal(extended.Covariance(), 1e-12));
+}
+
+/////////////////////////////////////////////////
+TEST(KalmanFilterTest, ExtendedRange)
+{
+  // Position in the plane from range measurements to a beacon
+  const Vector2 beacon = {10, 0};
+  const Vector2 truth = {3, 4};
+  auto range = [&](const Vector2 &_x)
+  {
+    return (_x - beacon).Length();
+  };
+  math::KalmanFilter<double, 2, 1> filter(Vector2{2.5, 4.5},
+                                          Matrix2::Identity());
+  const math::MatrixN<double, 1, 1> r = {1e-4};
+  const Vector1 z = {range(truth)};
+  for (int i = 0; i < 20; ++i)
+  {
+    const Vector2 x = filter.State();
+    const Vector2 d = (x - beacon) / range(x);
+    const math::MatrixN<double, 1, 2> jacobian = {d[0], d[1]};
+    ASSERT_TRUE(filter.Update(z, Vector1{range(x)}, jacobian, r));
+  }
+  EXPECT_NEAR(range(truth), range(filter.State()), 1e-3);
+}
+
+/////////////////////////////////////////////////
+TEST(KalmanFilterTest, Unscented)
+{
+  // With linear models, the unscented filter matches the linear one
+  const double dt = 0.1;
+  const Matrix2 f = {1, dt, 0, 1};
+  const Matrix2 q = Matrix2::Identity() * 0.01;
+  const math::MatrixN<double, 1, 2> h = {1, 0};
+  const math::MatrixN<double, 1, 1> r = {0.04};
+  const Matrix2 p0 = {2, 0.5, 0.5, 1};
+
+  math::KalmanFilter<double, 2, 1> linear(Vector2{1, -1}, p0);
+  math::UnscentedKalmanFilter<double, 2, 1> unscented(Vector2{1, -1}, p0,
+                                                      1.0, 2.0, 1.0);
+  for (int i = 0; i < 10; ++i)
+  {
+    linear.Predict(f, q);
+    ASSERT_TRUE(unscented.Predict(
+        [&](const Vector2 &_x) { return Vector2(f * _x); }, q));
+    EXPECT_TRUE(linear.State().Equal(unscented.State(), 1e-9));
+    EXPECT_TRUE(linear.Covariance().Equal(unscented.Covariance(), 1e-9));
+
+    const Vector1 z = {0.3 * i};
+    ASSERT_TRUE(linear.Update(z, h, r));
+    ASSERT_TRUE(unscented.Update(z,
+        [&](const Vector2 &_x) { return Vector1(h * _x); }, r));
+    EXPECT_TRUE(linear.State().Equal(unscented.State(), 1e-9));
+    EXPECT_TRUE(linear.Covariance().Equal(unscented.Covariance(), 1e-9));
+  }
+
+  // A covariance that is not positive definite is rejected
+  unscented.SetCovariance(Matrix2{1, 2, 2, 1});
+  EXPECT_FALSE(unscented.Predict([](const Vector2 &_x) { return _x; }, q));
+
+  // Default parameters on a nonlinear model
+  math::UnscentedKalmanFilter<double, 2, 1> polar(Vector2{1, 0.1},
+                                                  Matrix2::Identity() * 0.1);
+  ASSERT_TRUE(polar.Update(Vector1{1.2},
+      [](const Vector2 &_x) { return Vector1{_x.Length()}; },
+      math::MatrixN<double, 1, 1>{0.01}));
+  EXPECT_GT(polar.State().Length(), 1.0);
+}
+
+/////////////////////////////////////////////////
+TEST(KalmanFilterTest, Bank)
+{
+  using Matrix4 = math::MatrixN<double, 4, 4>;
+  using Vector4 = math::VectorN<double, 4>;
+  const double dt = 0.1;
+  Matrix4 f = Matrix4::Identity();
+  f(0, 2) = f(1, 3) = dt;
+  const Matrix4 q = Matrix4::Identity() * 0.01;
+  const math::MatrixN<double, 2, 4> h = {1, 0, 0, 0, 0, 1, 0, 0};
+  const math::MatrixN<double, 2, 2> r = {0.04, 0.01, 0.01, 0.09};
+
+  // More filters than a block, and not a multiple of it
+  constexpr std::size_t count = 37;
+  math::KalmanFilterBank<double, 4, 2> bank(count);
+  EXPECT_EQ(count, bank.Size());
+  std::vector<math::KalmanFilter<double, 4, 2>> filters;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const Vector4 x = {0.1 * i, -0.2 * i, 1, 0.5};
+    Matrix4 p = Matrix4::Identity() * (1 + 0.1 * i);
+    p(0, 2) = p(2, 0) = 0.1;
+    filters.emplace_back(x, p);
+    bank.SetFilter(i, x, p);
+  }
+  EXPECT_EQ(filters[5].State(), bank.State(5));
+  EXPECT_EQ(filters[5].Covariance(), bank.Covariance(5));
+
+  std::vector<double> z(2 * count);
+  bool valid[count];
+  for (int step = 0; step < 5; ++step)
+  {
+    bank.Predict(f, q);
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      filters[i].Predict(f, q);
+      z[i] = 0.1 * i + step * 0.1;
+      z[count + i] = -0.2 * i + step * 0.05;
+      valid[i] = (i + step) % 3 != 0;
+      if (valid[i])
+      {
+        filters[i].Update(Vector2{z[i], z[count + i]}, h, r);
+        ++expected;
+      }
+    }
+    EXPECT_EQ(expected, bank.Update(z.data(), h, r, valid));
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      EXPECT_TRUE(filters[i].State().Equal(bank.State(i), 1e-12)) << i;
+      EXPECT_TRUE(filters[i].Covariance().Equal(bank.Covariance(i), 1e-12))
+          << i;
+    }
+  }
+  EXPECT_DOUBLE_EQ(bank.State(3)[1], bank.StateData(1)[3]);
+
+  // Every filter is updated without flags, and a filter whose innovation
+  // covariance is not positive definite is left unchanged
+  bank.SetFilter(4, Vector4{}, Matrix4::Identity() * -1);
+  EXPECT_EQ(count - 1, bank.Update(z.data(), h, r));
+  EXPECT_EQ(Matrix4::Identity() * -1, bank.Covariance(4));
+
+  // Resizing keeps the filters
+  const Vector4 x2 = bank.State(2);
+  bank.Resize(3);
+  EXPECT_EQ(x2, bank.State(2));
+  bank.Resize(40);
+  EXPECT_EQ(x2, bank.State(2));
+  EXPECT_EQ(Vector4{}, bank.State(39));
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gz/math/KdTree3.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+/// \brief Find the _k nearest points by sorting all of them.
+template<typename T>
+static std::vector<std::size_t> BruteForceNearest(
+    const std::vector<Vector3<T>> &_points, const Vector3<T> &_point,
+    const std::size_t _k)
+{
+  std::vector<std::pair<T, std::size_t>> sorted;
+  for (std::size_t i = 0; i < _points.size(); ++i)
+  {
+    if (_points[i].IsFinite())
+      sorted.emplace_back((_points[i] - _point).SquaredLength(), i);
+  }
+  std::sort(sorted.begin(), sorted.end());
+  std::vector<std::size_t> indices;
+  for (std::size_t i = 0; i < std::min(_k, sorted.size()); ++i)
+    indices.push_back(sorted[i].second);
+  return indices;
+}
+
+/////////////////////////////////////////////////
+TEST(KdTree3Test, Empty)
+{
+  KdTree3d tree;
+  EXPECT_EQ(0u, tree.Size());
+
+  const auto [found, distance, index] = tree.Nearest(Vector3d::Zero, 1e9);
+  EXPECT_FALSE(found);
+  EXPECT_DOUBLE_EQ(0.0, distance);
+  EXPECT_EQ(KdTree3d::kNoPoint, index);
+
+  std::vector<std::size_t> indices = {1};
+  tree.Nearest(Vector3d::Zero, 3, indices);
+  EXPECT_TRUE(indices.empty());
+  indices = {1};
+  tree.Overlaps(Vector3d::Zero, 1.0, indices);
+  EXPECT_TRUE(indices.empty());
+
+  std::vector<double> distances;
+  tree.Nearest({Vector3d::Zero}, 2, indices, distances);
+  EXPECT_EQ(std::vector<std::size_t>(2, KdTree3d::kNoPoint), indices);
+  ASSERT_EQ(2u, distances.size());
+  EXPECT_TRUE(std::isinf(distances[0]));
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  tree.Build({Vector3d(nan, 0, 0)});
+  EXPECT_EQ(0u, tree.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(KdTree3Test, Simple)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  const std::vector<Vector3d> points = {Vector3d(0, 0, 0),
+      Vector3d(1, 0, 0), Vector3d(inf, 0, 0), Vector3d(0, 2, 0),
+      Vector3d(1, 0, 0)};
+  KdTree3d tree(points);
+  EXPECT_EQ(4u, tree.Size());
+
+  // Ties go to the lowest index.
+  auto [found, distance, index] = tree.Nearest(Vector3d(0.9, 0, 0), 1.0);
+  EXPECT_TRUE(found);
+  EXPECT_NEAR(0.1, distance, 1e-12);
+  EXPECT_EQ(1u, index);
+
+  std::tie(found, distance, index) = tree.Nearest(Vector3d(0, 5, 0), 2.0);
+  EXPECT_FALSE(found);
+
+  std::vector<std::size_t> indices;
+  tree.Nearest(Vector3d(0.9, 0.1, 0), 3, indices);
+  EXPECT_EQ(std::vector<std::size_t>({1, 4, 0}), indices);
+
+  // The radius is inclusive.
+  tree.Overlaps(Vector3d::Zero, 1.0, indices);
+  std::sort(indices.begin(), indices.end());
+  EXPECT_EQ(std::vector<std::size_t>({0, 1, 4}), indices);
+
+  // Batches are padded past the number of points, and for locations
+  // that are not finite.
+  std::vector<double> distances;
+  tree.Nearest({Vector3d(0, 2, 0), Vector3d(inf, 0, 0)}, 5, indices,
+               distances);
+  ASSERT_EQ(10u, indices.size());
+  EXPECT_EQ(std::vector<std::size_t>({3, 0, 1, 4, KdTree3d::kNoPoint}),
+            std::vector<std::size_t>(indices.begin(), indices.begin() + 5));
+  EXPECT_DOUBLE_EQ(2.0, distances[1]);
+  EXPECT_DOUBLE_EQ(std::sqrt(5.0), distances[2]);
+  EXPECT_TRUE(std::isinf(distances[4]));
+  EXPECT_EQ(KdTree3d::kNoPoint, indices[5]);
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+class KdTree3TypedTest : public ::testing::Test
+{
+};
+
+using PrecisionTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(KdTree3TypedTest, PrecisionTypes);
+
+/////////////////////////////////////////////////
+TYPED_TEST(KdTree3TypedTest, MatchesBruteForce)
+{
+  using T = TypeParam;
+  Rand::Seed(6);
+  std::vector<Vector3<T>> points;
+  for (int i = 0; i < 3000; ++i)
+  {
+    // A dense cluster inside a sparse cloud, with some duplicates.
+    const T scale = static_cast<T>(i % 2 == 0 ? 10 : 0.2);
+    points.push_back(Vector3<T>(
+        static_cast<T>(Rand::DblUniform(-1, 1)) * scale,
+        static_cast<T>(Rand::DblUniform(-1, 1)) * scale,
+        static_cast<T>(Rand::DblUniform(-1, 1)) * scale));
+    if (i % 40 == 0)
+      points.push_back(points.back());
+  }
+  const KdTree3<T> tree(points);
+  EXPECT_EQ(points.size(), tree.Size());
+
+  std::vector<Vector3<T>> queries;
+  for (int q = 0; q < 600; ++q)
+  {
+    queries.push_back(q % 4 == 0 ? points[q * 5] : Vector3<T>(
+        static_cast<T>(Rand::DblUniform(-12, 12)),
+        static_cast<T>(Rand::DblUniform(-12, 12)),
+        static_cast<T>(Rand::DblUniform(-12, 12))));
+  }
+
+  const std::size_t k = 7;
+  std::vector<std::size_t> batch;
+  std::vector<T> distances;
+  tree.Nearest(queries, k, batch, distances);
+  std::vector<std::size_t> threadedBatch;
+  std::vector<T> threadedDistances;
+  tree.Nearest(queries, k, threadedBatch, threadedDistances, 2);
+  EXPECT_EQ(batch, threadedBatch);
+  EXPECT_EQ(distances, threadedDistances);
+
+  std::vector<std::size_t> indices;
+  for (std::size_t q = 0; q < queries.size(); ++q)
+  {
+    const Vector3<T> &query = queries[q];
+    const std::vector<std::size_t> expected =
+      BruteForceNearest(points, query, k);
+    tree.Nearest(query, k, indices);
+    EXPECT_EQ(expected, indices);
+    EXPECT_EQ(expected, std::vector<std::size_t>(
+        batch.begin() + q * k, batch.begin() + (q + 1) * k));
+    EXPECT_EQ(points[expected[0]].Distance(query), distances[q * k]);
+
+    const auto [found, distance, index] =
+      tree.Nearest(query, static_cast<T>(100));
+    EXPECT_TRUE(found);
+    EXPECT_EQ(expected[0], index);
+    EXPECT_EQ(distances[q * k], distance);
+
+    const T radius = static_cast<T>(Rand::DblUniform(0, 3));
+    std::vector<std::size_t> inside;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      if ((points[i] - query).SquaredLength() <= radius * radius)
+        inside.push_back(i);
+    }
+    tree.Overlaps(query, radius, indices);
+    std::sort(indices.begin(), indices.end());
+    EXPECT_EQ(inside, indices);
+  }
+}
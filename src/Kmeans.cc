@@ -15,23 +15,238 @@
  *
 */
 
+#include <gz/math/Diagnostics.hh>
 #include <gz/math/Kmeans.hh>
+#include <gz/math/Trace.hh>
 
-#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <utility>
 
+#include <gz/math/Executor.hh>
+#include <gz/math/Instrumentation.hh>
 #include <gz/math/Rand.hh>
 #include "KmeansPrivate.hh"
 
 using namespace gz;
 using namespace math;
 
+namespace
+{
+  /// \brief Minimum number of observations processed by each thread.
+  const std::size_t kMinObservationsPerThread = 4096;
+
+  //////////////////////////////////////////////////
+  /// \brief Get the number of threads to use for a number of observations.
+  /// \param[in] _requested Requested threads, 0 for hardware threads.
+  /// \param[in] _count Number of observations.
+  /// \return Number of threads, at least 1.
+  unsigned int WorkerCount(unsigned int _requested, std::size_t _count)
+  {
+    std::size_t threads = _requested;
+    if (threads == 0)
+      threads = std::thread::hardware_concurrency();
+
+    threads = std::min(threads, _count / kMinObservationsPerThread);
+    return static_cast<unsigned int>(std::max<std::size_t>(threads, 1));
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the executor running the blocks of observations, and the
+  /// number of blocks. Without an executor set by the user, each thread
+  /// processes a single block.
+  /// \param[in] _data Kmeans data.
+  /// \param[in] _count Number of observations.
+  /// \param[out] _local Thread pool created for the call, if any.
+  /// \param[out] _blocks Number of blocks.
+  /// \return The executor.
+  Executor &BlockExecutor(const KmeansPrivate &_data, std::size_t _count,
+      std::unique_ptr<Executor> &_local, unsigned int &_blocks)
+  {
+    static SerialExecutor serial;
+
+    if (_data.executor)
+    {
+      _blocks = static_cast<unsigned int>(
+          _data.executor->BlockCount(_count, kMinObservationsPerThread));
+      return *_data.executor;
+    }
+
+    _blocks = WorkerCount(_data.threadCount, _count);
+    if (_blocks <= 1)
+      return serial;
+    _local.reset(new ThreadPool(_blocks));
+    return *_local;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Split [0, _count) into _blocks contiguous blocks and call
+  /// _fn(begin, end, block) for each of them, on an executor.
+  /// \param[in] _executor Executor running the blocks.
+  /// \param[in] _count Number of elements.
+  /// \param[in] _blocks Number of blocks.
+  /// \param[in] _fn Function to call on each block.
+  template<typename F>
+  void ParallelChunks(Executor &_executor, std::size_t _count,
+      unsigned int _blocks, F &&_fn)
+  {
+    _executor.ForEachBlock(_count, _blocks,
+      [&_fn](std::size_t _begin, std::size_t _end, std::size_t _block)
+      {
+        _fn(_begin, _end, static_cast<unsigned int>(_block));
+      });
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Check that weighted observations are valid.
+  /// \param[in] _obs Observations.
+  /// \param[in] _weights Weight of each observation.
+  /// \param[in] _caller Name of the calling function, for diagnostics.
+  /// \return True if the vectors are not empty, have the same size and
+  /// each weight is finite and not negative.
+  bool ValidWeights(const std::vector<Vector3d> &_obs,
+      const std::vector<double> &_weights, const char *_caller)
+  {
+    if (_obs.empty())
+    {
+      IGN_MATH_DIAGNOSTIC(_caller << " error: input vector is empty");
+      return false;
+    }
+
+    if (_weights.size() != _obs.size())
+    {
+      IGN_MATH_DIAGNOSTIC(_caller << " error: there are [" << _weights.size()
+          << "] weights for [" << _obs.size() << "] observations");
+      return false;
+    }
+
+    for (const double w : _weights)
+    {
+      if (!std::isfinite(w) || w < 0)
+      {
+        IGN_MATH_DIAGNOSTIC(_caller << " error: invalid weight [" << w
+            << "]");
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Choose the initial centroids with k-means++.
+  /// \param[in] _obs Observations.
+  /// \param[in] _weights Weight of each observation, or nullptr when all
+  /// the weights are 1.
+  /// \param[in] _count Number of observations.
+  /// \param[in] _k Number of centroids.
+  /// \param[in] _executor Executor running the blocks of observations.
+  /// \param[in] _blocks Number of blocks of observations.
+  /// \param[out] _centroids Chosen centroids.
+  void SeedPlusPlus(const Vector3d *_obs, const double *_weights,
+      std::size_t _count, std::size_t _k, Executor &_executor,
+      unsigned int _blocks, std::pmr::vector<Vector3d> &_centroids)
+  {
+    // The first centroid is chosen with probability proportional to the
+    // weight of the observations.
+    double totalWeight = 0;
+    if (_weights)
+    {
+      for (std::size_t i = 0; i < _count; ++i)
+        totalWeight += _weights[i];
+    }
+
+    if (totalWeight > 0)
+    {
+      double target = Rand::DblUniform(0, totalWeight);
+      std::size_t first = 0;
+      for (; first < _count - 1; ++first)
+      {
+        target -= _weights[first];
+        if (target < 0)
+          break;
+      }
+      _centroids.push_back(_obs[first]);
+    }
+    else
+    {
+      const int last = static_cast<int>(_count) - 1;
+      _centroids.push_back(_obs[Rand::IntUniform(0, last)]);
+    }
+
+    // Weighted squared distance from each observation to its closest
+    // centroid.
+    std::pmr::memory_resource *resource =
+        _centroids.get_allocator().resource();
+    std::pmr::vector<double> dist2(_count, HUGE_VAL, resource);
+    std::pmr::vector<double> partial(_blocks, resource);
+
+    while (_centroids.size() < _k)
+    {
+      const Vector3d &newest = _centroids.back();
+      ParallelChunks(_executor, _count, _blocks,
+        [&](std::size_t _begin, std::size_t _end, unsigned int _block)
+        {
+          double total = 0;
+          for (std::size_t i = _begin; i < _end; ++i)
+          {
+            double d2 = (_obs[i] - newest).SquaredLength();
+            if (_weights)
+              d2 *= _weights[i];
+            dist2[i] = std::min(dist2[i], d2);
+            total += dist2[i];
+          }
+          partial[_block] = total;
+        });
+
+      double total = 0;
+      for (auto const &p : partial)
+        total += p;
+
+      // All observations are already centroids.
+      if (total <= 0)
+      {
+        _centroids.push_back(_obs[_centroids.size()]);
+        continue;
+      }
+
+      // Choose an observation with probability proportional to dist2.
+      double target = Rand::DblUniform(0, total);
+      std::size_t chosen = 0;
+      for (; chosen < _count - 1; ++chosen)
+      {
+        target -= dist2[chosen];
+        if (target < 0)
+          break;
+      }
+      _centroids.push_back(_obs[chosen]);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 Kmeans::Kmeans(const std::vector<Vector3d> &_obs)
-: dataPtr(new KmeansPrivate)
+: Kmeans(_obs, std::pmr::get_default_resource())
+{
+}
+
+//////////////////////////////////////////////////
+Kmeans::Kmeans(const std::vector<Vector3d> &_obs,
+               std::pmr::memory_resource *_resource)
+: dataPtr(new KmeansPrivate(_resource))
 {
   this->Observations(_obs);
 }
 
+//////////////////////////////////////////////////
+Kmeans::Kmeans(std::vector<Vector3d> &&_obs)
+: dataPtr(new KmeansPrivate(std::pmr::get_default_resource()))
+{
+  this->Observations(std::move(_obs));
+}
+
 //////////////////////////////////////////////////
 Kmeans::~Kmeans()
 {
@@ -42,7 +257,21 @@ Kmeans::~Kmeans()
 //////////////////////////////////////////////////
 std::vector<Vector3d> Kmeans::Observations() const
 {
-  return this->dataPtr->obs;
+  const Vector3d *obs = this->dataPtr->ObsData();
+  IGN_MATH_COUNT_COPY(KMEANS, this->dataPtr->ObsCount() * sizeof(Vector3d));
+  return std::vector<Vector3d>(obs, obs + this->dataPtr->ObsCount());
+}
+
+//////////////////////////////////////////////////
+const Vector3d *Kmeans::ObservationData() const
+{
+  return this->dataPtr->ObsData();
+}
+
+//////////////////////////////////////////////////
+std::size_t Kmeans::ObservationCount() const
+{
+  return this->dataPtr->ObsCount();
 }
 
 //////////////////////////////////////////////////
@@ -50,112 +279,477 @@ bool Kmeans::Observations(const std::vector<Vector3d> &_obs)
 {
   if (_obs.empty())
   {
-    std::cerr << "Kmeans::SetObservations() error: Observations vector is empty"
-              << std::endl;
+    IGN_MATH_DIAGNOSTIC(
+        "Kmeans::SetObservations() error: Observations vector is empty");
     return false;
   }
-  this->dataPtr->obs = _obs;
+  IGN_MATH_COUNT_COPY(KMEANS, _obs.size() * sizeof(Vector3d));
+  this->dataPtr->obs.assign(_obs.begin(), _obs.end());
+  std::vector<Vector3d>().swap(this->dataPtr->ownedObs);
+  this->dataPtr->weights.clear();
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Kmeans::Observations(std::vector<Vector3d> &&_obs)
+{
+  if (_obs.empty())
+  {
+    IGN_MATH_DIAGNOSTIC(
+        "Kmeans::SetObservations() error: Observations vector is empty");
+    return false;
+  }
+  this->dataPtr->ownedObs = std::move(_obs);
+  std::pmr::vector<Vector3d>(this->dataPtr->obs.get_allocator()).swap(
+      this->dataPtr->obs);
+  this->dataPtr->weights.clear();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Kmeans::Observations(const std::vector<Vector3d> &_obs,
+                          const std::vector<double> &_weights)
+{
+  if (!ValidWeights(_obs, _weights, "Kmeans::SetObservations()"))
+    return false;
+
+  this->Observations(_obs);
+  IGN_MATH_COUNT_COPY(KMEANS, _weights.size() * sizeof(double));
+  this->dataPtr->weights.assign(_weights.begin(), _weights.end());
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::vector<double> Kmeans::Weights() const
+{
+  const auto &weights = this->dataPtr->weights;
+  if (weights.empty())
+    return std::vector<double>(this->dataPtr->ObsCount(), 1.0);
+
+  IGN_MATH_COUNT_COPY(KMEANS, weights.size() * sizeof(double));
+  return std::vector<double>(weights.begin(), weights.end());
+}
+
 //////////////////////////////////////////////////
 bool Kmeans::AppendObservations(const std::vector<Vector3d> &_obs)
 {
   if (_obs.empty())
   {
-    std::cerr << "Kmeans::AppendObservations() error: input vector is empty"
-              << std::endl;
+    IGN_MATH_DIAGNOSTIC(
+        "Kmeans::AppendObservations() error: input vector is empty");
     return false;
   }
-  this->dataPtr->obs.insert(this->dataPtr->obs.end(), _obs.begin(), _obs.end());
+  IGN_MATH_COUNT_COPY(KMEANS, _obs.size() * sizeof(Vector3d));
+  if (this->dataPtr->ownedObs.empty())
+  {
+    this->dataPtr->obs.insert(this->dataPtr->obs.end(),
+                              _obs.begin(), _obs.end());
+  }
+  else
+  {
+    this->dataPtr->ownedObs.insert(this->dataPtr->ownedObs.end(),
+                                   _obs.begin(), _obs.end());
+  }
+
+  // The new observations have a weight of 1
+  if (!this->dataPtr->weights.empty())
+  {
+    this->dataPtr->weights.resize(this->dataPtr->ObsCount(), 1.0);
+  }
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Kmeans::AppendObservations(const std::vector<Vector3d> &_obs,
+                                const std::vector<double> &_weights)
+{
+  if (!ValidWeights(_obs, _weights, "Kmeans::AppendObservations()"))
+    return false;
+
+  // The observations already added without weights have a weight of 1
+  auto &weights = this->dataPtr->weights;
+  weights.resize(this->dataPtr->ObsCount(), 1.0);
+  IGN_MATH_COUNT_COPY(KMEANS, _weights.size() * sizeof(double));
+  weights.insert(weights.end(), _weights.begin(), _weights.end());
+  return this->AppendObservations(_obs);
+}
+
+//////////////////////////////////////////////////
+bool Kmeans::AppendObservations(std::vector<Vector3d> &&_obs)
+{
+  if (_obs.empty())
+  {
+    IGN_MATH_DIAGNOSTIC(
+        "Kmeans::AppendObservations() error: input vector is empty");
+    return false;
+  }
+
+  // Take the vector if there are no observations yet
+  if (this->dataPtr->ObsCount() == 0)
+    return this->Observations(std::move(_obs));
+
+  const std::vector<Vector3d> &obs = _obs;
+  return this->AppendObservations(obs);
+}
+
 //////////////////////////////////////////////////
 bool Kmeans::Cluster(int _k,
                      std::vector<Vector3d> &_centroids,
                      std::vector<unsigned int> &_labels)
 {
+  if (!this->Cluster(_k, nullptr, nullptr))
+    return false;
+
+  IGN_MATH_COUNT_COPY(KMEANS,
+      this->dataPtr->centroids.size() * sizeof(Vector3d) +
+      this->dataPtr->labels.size() * sizeof(unsigned int));
+  _centroids.assign(this->dataPtr->centroids.begin(),
+                    this->dataPtr->centroids.end());
+  _labels.assign(this->dataPtr->labels.begin(), this->dataPtr->labels.end());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Kmeans::Cluster(int _k, Vector3d *_centroids, unsigned int *_labels)
+{
+  IGN_MATH_TRACE_ZONE("Kmeans::Cluster");
+  const Vector3d *obs = this->dataPtr->ObsData();
+  const std::size_t obsCount = this->dataPtr->ObsCount();
+  const double *weights = this->dataPtr->weights.empty() ? nullptr :
+      this->dataPtr->weights.data();
+
   // Sanity check.
-  if (this->dataPtr->obs.empty())
+  if (obsCount == 0)
   {
-    std::cerr << "Kmeans error: The set of observations is empty" << std::endl;
+    IGN_MATH_DIAGNOSTIC("Kmeans error: The set of observations is empty");
     return false;
   }
 
   if (_k <= 0)
   {
-    std::cerr << "Kmeans error: The number of clusters has to"
-              << " be positive but its value is [" << _k << "]"
-              << std::endl;
+    IGN_MATH_DIAGNOSTIC("Kmeans error: The number of clusters has to"
+        << " be positive but its value is [" << _k << "]");
     return false;
   }
 
-  if (_k > static_cast<int>(this->dataPtr->obs.size()))
+  if (_k > static_cast<int>(obsCount))
   {
-    std::cerr << "Kmeans error: The number of clusters [" << _k << "] has to be"
-              << " lower or equal to the number of observations ["
-              << this->dataPtr->obs.size() << "]" << std::endl;
+    IGN_MATH_DIAGNOSTIC(
+        "Kmeans error: The number of clusters [" << _k << "] has to be"
+        << " lower or equal to the number of observations ["
+        << obsCount << "]");
     return false;
   }
 
-  size_t changed = 0;
+  auto &centroids = this->dataPtr->centroids;
+  auto &labels = this->dataPtr->labels;
+  auto &upper = this->dataPtr->upper;
+  auto &lower = this->dataPtr->lower;
+  const std::size_t k = static_cast<std::size_t>(_k);
+  std::unique_ptr<Executor> localExecutor;
+  unsigned int blocks = 1;
+  Executor &executor = BlockExecutor(*this->dataPtr, obsCount,
+                                     localExecutor, blocks);
 
   // Initialize the size of the vectors;
-  this->dataPtr->centroids.clear();
-  this->dataPtr->labels.resize(this->dataPtr->obs.size());
-  this->dataPtr->sums.resize(_k);
-  this->dataPtr->counters.resize(_k);
+  centroids.clear();
+  labels.assign(obsCount, 0);
+  this->dataPtr->clusterWeights.assign(k, 0);
+  upper.resize(obsCount);
+  lower.resize(obsCount);
 
-  for (auto i = 0; i < _k; ++i)
+  if (this->dataPtr->seeding == KMEANS_PLUS_PLUS)
   {
-    // Choose a random observation and make sure it has not been chosen before.
-    // Note: This is not really random but it's faster than choosing a random
-    // one and verifying that it was not taken before.
-    this->dataPtr->centroids.push_back(this->dataPtr->obs[i]);
+    SeedPlusPlus(obs, weights, obsCount, k, executor, blocks, centroids);
   }
+  else
+  {
+    for (auto i = 0u; i < k; ++i)
+    {
+      // Choose a random observation and make sure it has not been chosen
+      // before. Note: This is not really random but it's faster than
+      // choosing a random one and verifying that it was not taken before.
+      centroids.push_back(obs[i]);
+    }
+  }
+
+  // Per block partial weighted sums and sums of weights.
+  std::pmr::memory_resource *resource = centroids.get_allocator().resource();
+  std::pmr::vector<std::pmr::vector<Vector3d>> sums(blocks, resource);
+  std::pmr::vector<std::pmr::vector<double>> masses(blocks, resource);
+  std::pmr::vector<std::size_t> changed(blocks, resource);
 
-  // Initialize labels.
-  for (auto i = 0u; i < this->dataPtr->obs.size(); ++i)
-    this->dataPtr->labels[i] = 0;
+  // Half the distance from each centroid to its closest centroid, and the
+  // distance moved by each centroid in the last update.
+  std::pmr::vector<double> halfSeparation(k, resource);
+  std::pmr::vector<double> moved(k, resource);
 
+  bool firstIteration = true;
+  std::size_t totalChanged = 0;
   do
   {
-    // Reset sums and counters.
-    for (auto i = 0u; i < this->dataPtr->centroids.size(); ++i)
+    for (auto i = 0u; i < k; ++i)
     {
-      this->dataPtr->sums[i] = Vector3d::Zero;
-      this->dataPtr->counters[i] = 0;
+      halfSeparation[i] = HUGE_VAL;
+      for (auto j = 0u; j < k; ++j)
+      {
+        if (i != j)
+        {
+          halfSeparation[i] = std::min(halfSeparation[i],
+              0.5 * centroids[i].Distance(centroids[j]));
+        }
+      }
     }
-    changed = 0;
 
-    for (auto i = 0u; i < this->dataPtr->obs.size(); ++i)
+    ParallelChunks(executor, obsCount, blocks,
+      [&](std::size_t _begin, std::size_t _end, unsigned int _block)
+      {
+        auto &blockSums = sums[_block];
+        auto &blockMasses = masses[_block];
+        blockSums.assign(k, Vector3d::Zero);
+        blockMasses.assign(k, 0);
+        changed[_block] = 0;
+
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          unsigned int label = labels[i];
+
+          // Hamerly's test: the current centroid is strictly the closest if
+          // the distance to it is below both the lower bound to the second
+          // closest centroid and half the distance to any other centroid.
+          bool search = firstIteration;
+          if (!search)
+          {
+            const double bound = std::max(halfSeparation[label], lower[i]);
+            if (upper[i] >= bound)
+            {
+              upper[i] = obs[i].Distance(centroids[label]);
+              search = upper[i] >= bound;
+            }
+          }
+
+          if (search)
+          {
+            // Update the labels containing the closest centroid for each
+            // point.
+            double best = HUGE_VAL;
+            double second = HUGE_VAL;
+            label = 0;
+            for (auto j = 0u; j < k; ++j)
+            {
+              const double d = obs[i].Distance(centroids[j]);
+              if (d < best)
+              {
+                second = best;
+                best = d;
+                label = j;
+              }
+              else if (d < second)
+              {
+                second = d;
+              }
+            }
+            upper[i] = best;
+            lower[i] = second;
+
+            if (labels[i] != label)
+            {
+              labels[i] = label;
+              ++changed[_block];
+            }
+          }
+
+          if (weights)
+          {
+            blockSums[label] += obs[i] * weights[i];
+            blockMasses[label] += weights[i];
+          }
+          else
+          {
+            blockSums[label] += obs[i];
+            blockMasses[label] += 1.0;
+          }
+        }
+      });
+
+    // Update the centroids. A centroid without observations, or whose
+    // observations all have a weight of 0, keeps its position.
+    totalChanged = 0;
+    for (auto b = 0u; b < blocks; ++b)
+      totalChanged += changed[b];
+
+    std::size_t farthest = 0;
+    double maxMoved = 0;
+    double secondMoved = 0;
+    for (auto i = 0u; i < k; ++i)
     {
-      // Update the labels containing the closest centroid for each point.
-      auto label = this->ClosestCentroid(this->dataPtr->obs[i]);
-      if (this->dataPtr->labels[i] != label)
+      Vector3d sum = Vector3d::Zero;
+      double mass = 0;
+      for (auto b = 0u; b < blocks; ++b)
+      {
+        sum += sums[b][i];
+        mass += masses[b][i];
+      }
+
+      this->dataPtr->clusterWeights[i] = mass;
+      moved[i] = 0;
+      if (mass > 0)
+      {
+        const Vector3d centroid = sum / mass;
+        moved[i] = centroid.Distance(centroids[i]);
+        centroids[i] = centroid;
+      }
+
+      if (moved[i] > maxMoved)
+      {
+        secondMoved = maxMoved;
+        maxMoved = moved[i];
+        farthest = i;
+      }
+      else if (moved[i] > secondMoved)
       {
-        this->dataPtr->labels[i] = label;
-        changed++;
+        secondMoved = moved[i];
       }
-      this->dataPtr->sums[label] += this->dataPtr->obs[i];
-      this->dataPtr->counters[label]++;
     }
 
-    // Update the centroids.
-    for (auto i = 0u; i < this->dataPtr->centroids.size(); ++i)
+    // Keep the bounds valid after the centroids moved.
+    ParallelChunks(executor, obsCount, blocks,
+      [&](std::size_t _begin, std::size_t _end, unsigned int)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          upper[i] += moved[labels[i]];
+          lower[i] -= labels[i] == farthest ? secondMoved : maxMoved;
+        }
+      });
+
+    firstIteration = false;
+  }
+  while (totalChanged > (obsCount >> 10)); // NOLINT
+
+  if (_centroids)
+    std::copy(centroids.begin(), centroids.end(), _centroids);
+  if (_labels)
+    std::copy(labels.begin(), labels.end(), _labels);
+  return true;
+}
+
+//////////////////////////////////////////////////
+const Vector3d *Kmeans::CentroidData() const
+{
+  return this->dataPtr->centroids.data();
+}
+
+//////////////////////////////////////////////////
+std::size_t Kmeans::CentroidCount() const
+{
+  return this->dataPtr->centroids.size();
+}
+
+//////////////////////////////////////////////////
+const unsigned int *Kmeans::LabelData() const
+{
+  return this->dataPtr->labels.data();
+}
+
+//////////////////////////////////////////////////
+std::size_t Kmeans::LabelCount() const
+{
+  return this->dataPtr->labels.size();
+}
+
+//////////////////////////////////////////////////
+bool Kmeans::UpdateClusters(const std::vector<Vector3d> &_obs,
+                            std::vector<Vector3d> &_centroids,
+                            std::vector<unsigned int> &_labels)
+{
+  return this->UpdateClusters(_obs, std::vector<double>(_obs.size(), 1.0),
+                              _centroids, _labels);
+}
+
+//////////////////////////////////////////////////
+bool Kmeans::UpdateClusters(const std::vector<Vector3d> &_obs,
+                            const std::vector<double> &_weights,
+                            std::vector<Vector3d> &_centroids,
+                            std::vector<unsigned int> &_labels)
+{
+  IGN_MATH_TRACE_ZONE("Kmeans::UpdateClusters");
+  auto &centroids = this->dataPtr->centroids;
+  auto &clusterWeights = this->dataPtr->clusterWeights;
+
+  // Sanity check.
+  if (centroids.empty())
+  {
+    IGN_MATH_DIAGNOSTIC("Kmeans::UpdateClusters() error: Cluster() has to be "
+        << "called first");
+    return false;
+  }
+
+  if (!ValidWeights(_obs, _weights, "Kmeans::UpdateClusters()"))
+    return false;
+
+  // Assign the new observations to the current centroids.
+  _labels.resize(_obs.size());
+  std::unique_ptr<Executor> localExecutor;
+  unsigned int blocks = 1;
+  Executor &executor = BlockExecutor(*this->dataPtr, _obs.size(),
+                                     localExecutor, blocks);
+  ParallelChunks(executor, _obs.size(), blocks,
+    [&](std::size_t _begin, std::size_t _end, unsigned int)
     {
-      this->dataPtr->centroids[i] =
-        this->dataPtr->sums[i] / this->dataPtr->counters[i];
+      for (std::size_t i = _begin; i < _end; ++i)
+        _labels[i] = this->ClosestCentroid(_obs[i]);
+    });
+
+  // Move each centroid towards its new observations with a per centroid
+  // learning rate of weight / total weight, which keeps it at the weighted
+  // mean of all the observations it has been assigned.
+  for (std::size_t i = 0; i < _obs.size(); ++i)
+  {
+    const unsigned int label = _labels[i];
+    clusterWeights[label] += _weights[i];
+    if (clusterWeights[label] > 0)
+    {
+      const double rate = _weights[i] / clusterWeights[label];
+      centroids[label] += (_obs[i] - centroids[label]) * rate;
     }
   }
-  while (changed > (this->dataPtr->obs.size() >> 10)); // NOLINT
 
-  _centroids = this->dataPtr->centroids;
-  _labels = this->dataPtr->labels;
+  IGN_MATH_COUNT_COPY(KMEANS, centroids.size() * sizeof(Vector3d));
+  _centroids.assign(centroids.begin(), centroids.end());
   return true;
 }
 
+//////////////////////////////////////////////////
+void Kmeans::SetSeeding(SeedingType _seeding)
+{
+  this->dataPtr->seeding = _seeding;
+}
+
+//////////////////////////////////////////////////
+Kmeans::SeedingType Kmeans::Seeding() const
+{
+  return this->dataPtr->seeding;
+}
+
+//////////////////////////////////////////////////
+void Kmeans::SetThreadCount(unsigned int _threads)
+{
+  this->dataPtr->threadCount = _threads;
+}
+
+//////////////////////////////////////////////////
+unsigned int Kmeans::ThreadCount() const
+{
+  return this->dataPtr->threadCount;
+}
+
+//////////////////////////////////////////////////
+void Kmeans::SetExecutor(std::shared_ptr<Executor> _executor)
+{
+  this->dataPtr->executor = std::move(_executor);
+}
+
 //////////////////////////////////////////////////
 unsigned int Kmeans::ClosestCentroid(const Vector3d &_p) const
 {
@@ -17,9 +17,15 @@
 #ifndef GZ_MATH_KMEANSPRIVATE_HH_
 #define GZ_MATH_KMEANSPRIVATE_HH_
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <vector>
+#include <gz/math/Executor.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/Helpers.hh>
+#include <gz/math/Kmeans.hh>
 #include <gz/math/config.hh>
 
 namespace ignition
@@ -32,20 +38,68 @@ namespace ignition
     /// \brief Private data for Kmeans class
     class KmeansPrivate
     {
-      /// \brief Observations.
-      public: std::vector<Vector3d> obs;
+      /// \brief Constructor.
+      /// \param[in] _resource Memory resource of the arrays.
+      public: explicit KmeansPrivate(std::pmr::memory_resource *_resource)
+        : obs(_resource), weights(_resource), centroids(_resource),
+          labels(_resource), clusterWeights(_resource), upper(_resource),
+          lower(_resource)
+      {
+      }
+
+      /// \brief Get the observations.
+      /// \return Pointer to the first observation.
+      public: const Vector3d *ObsData() const
+      {
+        return this->ownedObs.empty() ? this->obs.data() :
+            this->ownedObs.data();
+      }
+
+      /// \brief Get the number of observations.
+      /// \return The number of observations.
+      public: std::size_t ObsCount() const
+      {
+        return this->ownedObs.empty() ? this->obs.size() :
+            this->ownedObs.size();
+      }
+
+      /// \brief Observations copied from the caller.
+      public: std::pmr::vector<Vector3d> obs;
+
+      /// \brief Observations moved in by the caller, which are used
+      /// instead of obs when not empty.
+      public: std::vector<Vector3d> ownedObs;
+
+      /// \brief Weight of each observation, or empty when all the weights
+      /// are 1.
+      public: std::pmr::vector<double> weights;
 
       /// \brief Centroids.
-      public: std::vector<Vector3d> centroids;
+      public: std::pmr::vector<Vector3d> centroids;
 
       /// \brief Each element stores the cluster to which observation i belongs.
-      public: std::vector<unsigned int> labels;
+      public: std::pmr::vector<unsigned int> labels;
+
+      /// \brief Sum of the weights of the observations contained in each
+      /// partition, including the ones added by UpdateClusters().
+      public: std::pmr::vector<double> clusterWeights;
+
+      /// \brief Upper bound of the distance from observation i to the
+      /// centroid it belongs to.
+      public: std::pmr::vector<double> upper;
+
+      /// \brief Lower bound of the distance from observation i to the second
+      /// closest centroid.
+      public: std::pmr::vector<double> lower;
+
+      /// \brief Seeding strategy.
+      public: Kmeans::SeedingType seeding = Kmeans::FIRST_OBSERVATIONS;
 
-      /// \brief Used to calculate the centroid of each partition.
-      public: std::vector<Vector3d> sums;
+      /// \brief Number of threads used by Cluster(), 0 for hardware threads.
+      public: unsigned int threadCount = 1;
 
-      /// \brief Counts the number of observations contained in each partition.
-      public: std::vector<unsigned int> counters;
+      /// \brief Executor used instead of threadCount threads, if set.
+      public: std::shared_ptr<Executor> executor;
     };
     }
   }
@@ -16,11 +16,43 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <memory_resource>
 #include <vector>
+#include "gz/math/Executor.hh"
 #include "gz/math/Kmeans.hh"
+#include "gz/math/Rand.hh"
 
 using namespace gz;
 
+/////////////////////////////////////////////////
+/// \brief Memory resource which counts its allocations.
+class CountingResource : public std::pmr::memory_resource
+{
+  /// \brief Number of allocations.
+  public: std::size_t allocations = 0;
+
+  private: void *do_allocate(std::size_t _bytes,
+                             std::size_t _alignment) override
+  {
+    ++this->allocations;
+    return std::pmr::new_delete_resource()->allocate(_bytes, _alignment);
+  }
+
+  private: void do_deallocate(void *_p, std::size_t _bytes,
+                              std::size_t _alignment) override
+  {
+    std::pmr::new_delete_resource()->deallocate(_p, _bytes, _alignment);
+  }
+
+  private: bool do_is_equal(
+               const std::pmr::memory_resource &_other) const noexcept override
+  {
+    return this == &_other;
+  }
+};
+
 //////////////////////////////////////////////////
 TEST(KmeansTest, Kmeans)
 {
@@ -140,3 +172,486 @@ TEST(KmeansTest, Append)
   std::vector<math::Vector3d> emptyVector;
   EXPECT_FALSE(kmeans.AppendObservations(emptyVector));
 }
+
+//////////////////////////////////////////////////
+/// \brief Reference brute force Lloyd iterations, seeded with the first k
+/// observations.
+void ReferenceKmeans(const std::vector<math::Vector3d> &_obs, unsigned int _k,
+    std::vector<math::Vector3d> &_centroids,
+    std::vector<unsigned int> &_labels)
+{
+  _centroids.assign(_obs.begin(), _obs.begin() + _k);
+  _labels.assign(_obs.size(), 0);
+  std::size_t changed = 0;
+  do
+  {
+    std::vector<math::Vector3d> sums(_k, math::Vector3d::Zero);
+    std::vector<unsigned int> counters(_k, 0);
+    changed = 0;
+    for (std::size_t i = 0; i < _obs.size(); ++i)
+    {
+      unsigned int label = 0;
+      for (unsigned int j = 1; j < _k; ++j)
+      {
+        if (_obs[i].Distance(_centroids[j]) <
+            _obs[i].Distance(_centroids[label]))
+        {
+          label = j;
+        }
+      }
+      if (_labels[i] != label)
+      {
+        _labels[i] = label;
+        ++changed;
+      }
+      sums[label] += _obs[i];
+      counters[label]++;
+    }
+    for (unsigned int j = 0; j < _k; ++j)
+    {
+      if (counters[j] > 0)
+        _centroids[j] = sums[j] / counters[j];
+    }
+  }
+  while (changed > (_obs.size() >> 10));
+}
+
+//////////////////////////////////////////////////
+/// \brief Random observations around _k well separated centers.
+std::vector<math::Vector3d> Blobs(unsigned int _k, std::size_t _perBlob,
+    std::vector<math::Vector3d> &_centers)
+{
+  std::vector<math::Vector3d> obs;
+  _centers.clear();
+  for (unsigned int j = 0; j < _k; ++j)
+  {
+    _centers.push_back(math::Vector3d(20.0 * j, 10.0 * (j % 2), 0));
+    for (std::size_t i = 0; i < _perBlob; ++i)
+    {
+      obs.push_back(_centers.back() + math::Vector3d(
+          math::Rand::DblUniform(-1, 1), math::Rand::DblUniform(-1, 1),
+          math::Rand::DblUniform(-1, 1)));
+    }
+  }
+  return obs;
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, Options)
+{
+  std::vector<math::Vector3d> obs = {{0, 0, 0}, {1, 1, 1}};
+  math::Kmeans kmeans(obs);
+  EXPECT_EQ(math::Kmeans::FIRST_OBSERVATIONS, kmeans.Seeding());
+  EXPECT_EQ(1u, kmeans.ThreadCount());
+
+  kmeans.SetSeeding(math::Kmeans::KMEANS_PLUS_PLUS);
+  EXPECT_EQ(math::Kmeans::KMEANS_PLUS_PLUS, kmeans.Seeding());
+  kmeans.SetThreadCount(0);
+  EXPECT_EQ(0u, kmeans.ThreadCount());
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, MatchesBruteForce)
+{
+  math::Rand::Seed(42);
+  std::vector<math::Vector3d> obs(2000);
+  for (auto &p : obs)
+  {
+    p.Set(math::Rand::DblUniform(-10, 10), math::Rand::DblUniform(-10, 10),
+          math::Rand::DblUniform(-10, 10));
+  }
+
+  for (unsigned int k : {1u, 2u, 7u, 32u})
+  {
+    std::vector<math::Vector3d> expectedCentroids;
+    std::vector<unsigned int> expectedLabels;
+    ReferenceKmeans(obs, k, expectedCentroids, expectedLabels);
+
+    math::Kmeans kmeans(obs);
+    std::vector<math::Vector3d> centroids;
+    std::vector<unsigned int> labels;
+    ASSERT_TRUE(kmeans.Cluster(static_cast<int>(k), centroids, labels));
+    EXPECT_EQ(expectedLabels, labels);
+    ASSERT_EQ(expectedCentroids.size(), centroids.size());
+    for (std::size_t j = 0; j < k; ++j)
+      EXPECT_TRUE(expectedCentroids[j].Equal(centroids[j], 1e-9));
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, PlusPlusSeeding)
+{
+  math::Rand::Seed(7);
+  std::vector<math::Vector3d> centers;
+  auto obs = Blobs(6, 50, centers);
+
+  math::Kmeans kmeans(obs);
+  kmeans.SetSeeding(math::Kmeans::KMEANS_PLUS_PLUS);
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(kmeans.Cluster(6, centroids, labels));
+
+  // Every blob is found, and all of its observations share a label.
+  for (std::size_t j = 0; j < centers.size(); ++j)
+  {
+    const unsigned int label = labels[j * 50];
+    EXPECT_LT(centroids[label].Distance(centers[j]), 0.5);
+    for (std::size_t i = 0; i < 50; ++i)
+      EXPECT_EQ(label, labels[j * 50 + i]);
+  }
+
+  // Duplicated observations.
+  std::vector<math::Vector3d> same(10, math::Vector3d::One);
+  math::Kmeans kmeansSame(same);
+  kmeansSame.SetSeeding(math::Kmeans::KMEANS_PLUS_PLUS);
+  ASSERT_TRUE(kmeansSame.Cluster(3, centroids, labels));
+  for (auto const &c : centroids)
+    EXPECT_EQ(math::Vector3d::One, c);
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, Multithreaded)
+{
+  math::Rand::Seed(3);
+  std::vector<math::Vector3d> centers;
+  auto obs = Blobs(4, 5000, centers);
+
+  math::Kmeans kmeans(obs);
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(kmeans.Cluster(4, centroids, labels));
+
+  for (unsigned int threads : {0u, 2u, 4u})
+  {
+    kmeans.SetThreadCount(threads);
+    std::vector<math::Vector3d> threadCentroids;
+    std::vector<unsigned int> threadLabels;
+    ASSERT_TRUE(kmeans.Cluster(4, threadCentroids, threadLabels));
+    EXPECT_EQ(labels, threadLabels);
+    for (std::size_t j = 0; j < centroids.size(); ++j)
+      EXPECT_TRUE(centroids[j].Equal(threadCentroids[j], 1e-9));
+  }
+
+  // A shared executor replaces the threads of each call.
+  kmeans.SetExecutor(std::make_shared<math::ThreadPool>(3));
+  std::vector<math::Vector3d> poolCentroids;
+  std::vector<unsigned int> poolLabels;
+  ASSERT_TRUE(kmeans.Cluster(4, poolCentroids, poolLabels));
+  EXPECT_EQ(labels, poolLabels);
+  for (std::size_t j = 0; j < centroids.size(); ++j)
+    EXPECT_TRUE(centroids[j].Equal(poolCentroids[j], 1e-9));
+  kmeans.SetExecutor(nullptr);
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, UpdateClusters)
+{
+  math::Rand::Seed(11);
+  std::vector<math::Vector3d> centers;
+  auto obs = Blobs(3, 40, centers);
+  auto batch = Blobs(3, 20, centers);
+
+  math::Kmeans kmeans(obs);
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+
+  // Clusters have to be computed first.
+  EXPECT_FALSE(kmeans.UpdateClusters(batch, centroids, labels));
+
+  kmeans.SetSeeding(math::Kmeans::KMEANS_PLUS_PLUS);
+  ASSERT_TRUE(kmeans.Cluster(3, centroids, labels));
+  std::vector<unsigned int> obsLabels = labels;
+
+  // Empty batch.
+  EXPECT_FALSE(kmeans.UpdateClusters({}, centroids, labels));
+
+  std::vector<unsigned int> batchLabels;
+  ASSERT_TRUE(kmeans.UpdateClusters(batch, centroids, batchLabels));
+  ASSERT_EQ(batch.size(), batchLabels.size());
+  ASSERT_EQ(3u, centroids.size());
+
+  // Observations are not stored.
+  EXPECT_EQ(obs.size(), kmeans.Observations().size());
+
+  // Each centroid is the mean of all the observations assigned to it.
+  for (unsigned int j = 0; j < 3; ++j)
+  {
+    math::Vector3d sum;
+    unsigned int count = 0;
+    for (std::size_t i = 0; i < obs.size(); ++i)
+    {
+      if (obsLabels[i] == j)
+      {
+        sum += obs[i];
+        ++count;
+      }
+    }
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+      if (batchLabels[i] == j)
+      {
+        EXPECT_EQ(obsLabels[(i / 20) * 40], j);
+        sum += batch[i];
+        ++count;
+      }
+    }
+    ASSERT_GT(count, 0u);
+    EXPECT_TRUE(centroids[j].Equal(sum / count, 1e-9));
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, MemoryResource)
+{
+  math::Rand::Seed(5);
+  std::vector<math::Vector3d> centers;
+  auto obs = Blobs(3, 200, centers);
+
+  CountingResource resource;
+  math::Kmeans kmeans(obs, &resource);
+  EXPECT_EQ(obs, kmeans.Observations());
+  math::Kmeans expected(obs);
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  std::vector<math::Vector3d> expectedCentroids;
+  std::vector<unsigned int> expectedLabels;
+  ASSERT_TRUE(kmeans.Cluster(3, centroids, labels));
+  ASSERT_TRUE(expected.Cluster(3, expectedCentroids, expectedLabels));
+  EXPECT_EQ(expectedCentroids, centroids);
+  EXPECT_EQ(expectedLabels, labels);
+  EXPECT_LT(0u, resource.allocations);
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, MoveAndViews)
+{
+  math::Rand::Seed(9);
+  std::vector<math::Vector3d> centers;
+  auto obs = Blobs(4, 100, centers);
+  const std::vector<math::Vector3d> copy = obs;
+
+  // Moved in observations are taken without a copy
+  const math::Vector3d *data = obs.data();
+  math::Kmeans kmeans(std::move(obs));
+  EXPECT_EQ(data, kmeans.ObservationData());
+  ASSERT_EQ(copy.size(), kmeans.ObservationCount());
+  EXPECT_EQ(copy, kmeans.Observations());
+  EXPECT_EQ(0u, kmeans.CentroidCount());
+  EXPECT_EQ(0u, kmeans.LabelCount());
+
+  // Same results as with copied observations, in caller owned buffers
+  math::Kmeans expected(copy);
+  std::vector<math::Vector3d> expectedCentroids;
+  std::vector<unsigned int> expectedLabels;
+  ASSERT_TRUE(expected.Cluster(4, expectedCentroids, expectedLabels));
+  std::vector<math::Vector3d> centroids(4);
+  std::vector<unsigned int> labels(copy.size());
+  ASSERT_TRUE(kmeans.Cluster(4, centroids.data(), labels.data()));
+  EXPECT_EQ(expectedCentroids, centroids);
+  EXPECT_EQ(expectedLabels, labels);
+
+  // The views hold the same results
+  ASSERT_EQ(4u, kmeans.CentroidCount());
+  ASSERT_EQ(copy.size(), kmeans.LabelCount());
+  EXPECT_EQ(centroids, std::vector<math::Vector3d>(kmeans.CentroidData(),
+      kmeans.CentroidData() + kmeans.CentroidCount()));
+  EXPECT_EQ(labels, std::vector<unsigned int>(kmeans.LabelData(),
+      kmeans.LabelData() + kmeans.LabelCount()));
+  EXPECT_TRUE(kmeans.Cluster(4, nullptr, nullptr));
+
+  // Failures leave the buffers untouched
+  EXPECT_FALSE(kmeans.Cluster(0, centroids.data(), labels.data()));
+  EXPECT_EQ(expectedCentroids, centroids);
+
+  // Appending to moved in observations, and moving into an empty set
+  std::vector<math::Vector3d> more(copy.begin(), copy.begin() + 10);
+  EXPECT_TRUE(kmeans.AppendObservations(more));
+  EXPECT_EQ(copy.size() + 10, kmeans.ObservationCount());
+  EXPECT_EQ(copy[3], kmeans.ObservationData()[copy.size() + 3]);
+  EXPECT_TRUE(kmeans.AppendObservations(std::move(more)));
+  EXPECT_EQ(copy.size() + 20, kmeans.ObservationCount());
+
+  std::vector<math::Vector3d> empty;
+  EXPECT_FALSE(kmeans.Observations(std::move(empty)));
+  EXPECT_FALSE(kmeans.AppendObservations(std::move(empty)));
+
+  // Copying observations replaces the moved in ones
+  EXPECT_TRUE(kmeans.Observations(copy));
+  EXPECT_EQ(copy, kmeans.Observations());
+  std::vector<math::Vector3d> moved = copy;
+  data = moved.data();
+  EXPECT_TRUE(kmeans.Observations(std::move(moved)));
+  EXPECT_EQ(data, kmeans.ObservationData());
+  EXPECT_EQ(copy, kmeans.Observations());
+}
+
+//////////////////////////////////////////////////
+/// \brief Random unique observations and the number of times each of them
+/// is repeated.
+/// \param[in] _count Number of unique observations.
+/// \param[out] _unique Unique observations.
+/// \param[out] _weights Number of repetitions of each unique observation.
+/// \return The repeated observations, starting with the unique ones.
+std::vector<math::Vector3d> Repeated(std::size_t _count,
+    std::vector<math::Vector3d> &_unique, std::vector<double> &_weights)
+{
+  _unique.clear();
+  _weights.clear();
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    _unique.push_back(math::Vector3d(math::Rand::DblUniform(0, 10),
+        math::Rand::DblUniform(0, 10), math::Rand::DblUniform(0, 10)));
+    _weights.push_back(math::Rand::IntUniform(1, 5));
+  }
+
+  std::vector<math::Vector3d> raw = _unique;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    for (int j = 1; j < static_cast<int>(_weights[i]); ++j)
+      raw.push_back(_unique[i]);
+  }
+  return raw;
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, Weighted)
+{
+  math::Rand::Seed(21);
+  std::vector<math::Vector3d> unique;
+  std::vector<double> weights;
+  const auto raw = Repeated(60, unique, weights);
+
+  // Weighted observations give the same clusters as the repeated ones
+  math::Kmeans rawKmeans(raw);
+  std::vector<math::Vector3d> rawCentroids;
+  std::vector<unsigned int> rawLabels;
+  ASSERT_TRUE(rawKmeans.Cluster(4, rawCentroids, rawLabels));
+
+  math::Kmeans kmeans(unique);
+  EXPECT_EQ(std::vector<double>(unique.size(), 1.0), kmeans.Weights());
+  ASSERT_TRUE(kmeans.Observations(unique, weights));
+  EXPECT_EQ(weights, kmeans.Weights());
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(kmeans.Cluster(4, centroids, labels));
+  ASSERT_EQ(unique.size(), labels.size());
+  for (std::size_t i = 0; i < unique.size(); ++i)
+    EXPECT_EQ(rawLabels[i], labels[i]);
+  for (unsigned int j = 0; j < 4; ++j)
+    EXPECT_TRUE(rawCentroids[j].Equal(centroids[j], 1e-9));
+
+  // Weighted observations added in two batches
+  const std::size_t half = unique.size() / 2;
+  math::Kmeans appended(unique);
+  ASSERT_TRUE(appended.Observations(
+      std::vector<math::Vector3d>(unique.begin(), unique.begin() + half),
+      std::vector<double>(weights.begin(), weights.begin() + half)));
+  ASSERT_TRUE(appended.AppendObservations(
+      std::vector<math::Vector3d>(unique.begin() + half, unique.end()),
+      std::vector<double>(weights.begin() + half, weights.end())));
+  EXPECT_EQ(weights, appended.Weights());
+  std::vector<math::Vector3d> appendedCentroids;
+  ASSERT_TRUE(appended.Cluster(4, appendedCentroids, labels));
+  EXPECT_EQ(centroids, appendedCentroids);
+
+  // Multiplying all the weights does not change the clusters
+  std::vector<double> scaled = weights;
+  for (auto &w : scaled)
+    w *= 0.25;
+  ASSERT_TRUE(appended.Observations(unique, scaled));
+  ASSERT_TRUE(appended.Cluster(4, appendedCentroids, labels));
+  for (unsigned int j = 0; j < 4; ++j)
+    EXPECT_TRUE(centroids[j].Equal(appendedCentroids[j], 1e-9));
+
+  // k-means++ seeding with weights
+  kmeans.SetSeeding(math::Kmeans::KMEANS_PLUS_PLUS);
+  ASSERT_TRUE(kmeans.Cluster(4, centroids, labels));
+  EXPECT_EQ(4u, centroids.size());
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, WeightedObservations)
+{
+  std::vector<math::Vector3d> obs = {
+    {0, 0, 0}, {1, 0, 0}, {10, 0, 0}, {11, 0, 0}};
+
+  // Invalid weights leave the observations unchanged
+  math::Kmeans kmeans(obs);
+  EXPECT_FALSE(kmeans.Observations(obs, {1, 2, 3}));
+  EXPECT_FALSE(kmeans.Observations(obs, {1, 2, -3, 4}));
+  EXPECT_FALSE(kmeans.Observations(obs, {1, 2, NAN, 4}));
+  EXPECT_FALSE(kmeans.Observations(obs, {1, 2, INFINITY, 4}));
+  EXPECT_FALSE(kmeans.Observations({}, {}));
+  EXPECT_FALSE(kmeans.AppendObservations(obs, {1}));
+  EXPECT_FALSE(kmeans.AppendObservations({}, {}));
+  EXPECT_EQ(obs, kmeans.Observations());
+  EXPECT_EQ(std::vector<double>(4, 1.0), kmeans.Weights());
+
+  // Observations added without weights have a weight of 1
+  EXPECT_TRUE(kmeans.AppendObservations({{20, 0, 0}}, {3}));
+  EXPECT_TRUE(kmeans.AppendObservations({{21, 0, 0}}));
+  EXPECT_TRUE(kmeans.AppendObservations(
+        std::vector<math::Vector3d>{{22, 0, 0}}));
+  EXPECT_EQ(std::vector<double>({1, 1, 1, 1, 3, 1, 1}), kmeans.Weights());
+  EXPECT_EQ(7u, kmeans.ObservationCount());
+
+  // Setting observations without weights removes the weights
+  EXPECT_TRUE(kmeans.Observations(obs));
+  EXPECT_EQ(std::vector<double>(4, 1.0), kmeans.Weights());
+
+  // Observations of weight 0 do not move the centroids
+  EXPECT_TRUE(kmeans.Observations(obs, {3, 1, 0, 1}));
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(kmeans.Cluster(2, centroids, labels));
+  EXPECT_EQ(std::vector<unsigned int>({0, 0, 1, 1}), labels);
+  EXPECT_EQ(math::Vector3d(0.25, 0, 0), centroids[0]);
+  EXPECT_EQ(math::Vector3d(11, 0, 0), centroids[1]);
+
+  // A cluster of weight 0 keeps its initial centroid
+  EXPECT_TRUE(kmeans.Observations({{10, 0, 0}, {0, 0, 0}, {1, 0, 0},
+      {11, 0, 0}}, {0, 1, 1, 0}));
+  ASSERT_TRUE(kmeans.Cluster(2, centroids, labels));
+  EXPECT_EQ(std::vector<unsigned int>({0, 1, 1, 0}), labels);
+  EXPECT_EQ(math::Vector3d(10, 0, 0), centroids[0]);
+  EXPECT_EQ(math::Vector3d(0.5, 0, 0), centroids[1]);
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, WeightedUpdateClusters)
+{
+  math::Rand::Seed(23);
+  std::vector<math::Vector3d> unique;
+  std::vector<double> weights;
+  const auto raw = Repeated(40, unique, weights);
+  std::vector<math::Vector3d> batch;
+  std::vector<double> batchWeights;
+  const auto rawBatch = Repeated(30, batch, batchWeights);
+
+  math::Kmeans rawKmeans(raw);
+  std::vector<math::Vector3d> rawCentroids;
+  std::vector<unsigned int> rawLabels;
+  ASSERT_TRUE(rawKmeans.Cluster(3, rawCentroids, rawLabels));
+  ASSERT_TRUE(rawKmeans.UpdateClusters(rawBatch, rawCentroids, rawLabels));
+
+  math::Kmeans kmeans(unique);
+  ASSERT_TRUE(kmeans.Observations(unique, weights));
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(kmeans.Cluster(3, centroids, labels));
+
+  // Invalid weights
+  EXPECT_FALSE(kmeans.UpdateClusters(batch, {1}, centroids, labels));
+  std::vector<double> negative = batchWeights;
+  negative.back() = -1;
+  EXPECT_FALSE(kmeans.UpdateClusters(batch, negative, centroids, labels));
+
+  // The weighted batch moves the centroids as the repeated one
+  ASSERT_TRUE(kmeans.UpdateClusters(batch, batchWeights, centroids,
+                                    labels));
+  ASSERT_EQ(batch.size(), labels.size());
+  for (std::size_t i = 0; i < batch.size(); ++i)
+    EXPECT_EQ(rawLabels[i], labels[i]);
+  for (unsigned int j = 0; j < 3; ++j)
+    EXPECT_TRUE(rawCentroids[j].Equal(centroids[j], 1e-9));
+}
@@ -266,3 +266,17 @@ TEST(Line2Test, OperatorStreamOut)
   stream << line;
   EXPECT_EQ(stream.str(), "0 1 2 3");
 }
+
+/////////////////////////////////////////////////
+TEST(Line2Test, PointDistance)
+{
+  const math::Line2d line(0, 0, 2, 0);
+  EXPECT_DOUBLE_EQ(1.0, line.Distance(math::Vector2d(1, 1)));
+  EXPECT_DOUBLE_EQ(1.0, line.Distance(math::Vector2d(1, -1)));
+  EXPECT_DOUBLE_EQ(0.0, line.Distance(math::Vector2d(0.5, 0)));
+  EXPECT_DOUBLE_EQ(5.0, line.Distance(math::Vector2d(-3, 4)));
+  EXPECT_DOUBLE_EQ(5.0, line.Distance(math::Vector2d(5, -4)));
+
+  const math::Line2d point(1, 1, 1, 1);
+  EXPECT_DOUBLE_EQ(5.0, point.Distance(math::Vector2d(4, 5)));
+}
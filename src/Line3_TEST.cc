@@ -17,8 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "gz/math/Line3.hh"
 #include "gz/math/Helpers.hh"
+#include "gz/math/Rand.hh"
 
 using namespace gz;
 
@@ -371,3 +374,122 @@ TEST(Line3Test, Coplanar)
   EXPECT_FALSE(line.Coplanar(math::Line3d(1, 0, 0, 1, 1, 1)));
   EXPECT_FALSE(line.Coplanar(math::Line3d(1, 0, 1, 2, 0, 0)));
 }
+
+/////////////////////////////////////////////////
+/// \brief Distance between two segments by ternary search over the first
+/// segment, since the distance from its points to the second segment is
+/// convex.
+double SegmentDistance(const math::Line3d &_a, math::Line3d _b)
+{
+  auto dist = [&](double _s)
+  {
+    return _b.Distance(_a[0] + (_a[1] - _a[0]) * _s);
+  };
+  double lo = 0;
+  double hi = 1;
+  for (int i = 0; i < 200; ++i)
+  {
+    const double m1 = lo + (hi - lo) / 3;
+    const double m2 = hi - (hi - lo) / 3;
+    if (dist(m1) < dist(m2))
+      hi = m2;
+    else
+      lo = m1;
+  }
+  return std::min({dist(lo), dist(0), dist(1)});
+}
+
+/////////////////////////////////////////////////
+TEST(Line3Test, Distances)
+{
+  std::vector<math::Line3d> segments = {
+      // Crossing
+      math::Line3d(math::Vector3d(-1, 0, 0), math::Vector3d(1, 0, 0)),
+      math::Line3d(math::Vector3d(0, -1, 1), math::Vector3d(0, 1, 1)),
+      // Parallel, overlapping and not
+      math::Line3d(math::Vector3d(0, 2, 0), math::Vector3d(3, 2, 0)),
+      math::Line3d(math::Vector3d(5, 0, 0), math::Vector3d(7, 0, 0)),
+      // Collinear and reversed
+      math::Line3d(math::Vector3d(0.5, 0, 0), math::Vector3d(-4, 0, 0)),
+      // Points
+      math::Line3d(math::Vector3d(0, 0, 3), math::Vector3d(0, 0, 3)),
+      math::Line3d(math::Vector3d(2, 2, 2), math::Vector3d(2, 2, 2))};
+  for (int i = 0; i < 200; ++i)
+  {
+    math::Vector3d a(math::Rand::DblUniform(-5, 5),
+                     math::Rand::DblUniform(-5, 5),
+                     math::Rand::DblUniform(-5, 5));
+    math::Vector3d b(math::Rand::DblUniform(-5, 5),
+                     math::Rand::DblUniform(-5, 5),
+                     math::Rand::DblUniform(-5, 5));
+    segments.push_back(math::Line3d(a, b));
+  }
+
+  math::Vector3SoA<double> starts;
+  math::Vector3SoA<double> ends;
+  for (const auto &segment : segments)
+  {
+    starts.PushBack(segment[0]);
+    ends.PushBack(segment[1]);
+  }
+
+  // One segment against all
+  std::vector<double> distances;
+  for (const auto &segment : segments)
+  {
+    segment.Distances(starts, ends, distances);
+    ASSERT_EQ(segments.size(), distances.size());
+    for (std::size_t i = 0; i < segments.size(); ++i)
+    {
+      EXPECT_NEAR(SegmentDistance(segment, segments[i]), distances[i], 1e-6)
+        << segment << " | " << segments[i];
+    }
+  }
+
+  segments[0].Distances(starts, ends, distances);
+  EXPECT_NEAR(1.0, distances[1], 1e-12);
+  EXPECT_NEAR(2.0, distances[2], 1e-12);
+  EXPECT_NEAR(4.0, distances[3], 1e-12);
+  EXPECT_NEAR(0.0, distances[4], 1e-12);
+  EXPECT_NEAR(3.0, distances[5], 1e-12);
+  EXPECT_NEAR(3.0, distances[6], 1e-12);
+
+  // Pairwise, each segment against the next one
+  math::Vector3SoA<double> nextStarts;
+  math::Vector3SoA<double> nextEnds;
+  for (std::size_t i = 0; i < segments.size(); ++i)
+  {
+    nextStarts.PushBack(segments[(i + 1) % segments.size()][0]);
+    nextEnds.PushBack(segments[(i + 1) % segments.size()][1]);
+  }
+  math::Line3d::Distances(starts, ends, nextStarts, nextEnds, distances);
+  ASSERT_EQ(segments.size(), distances.size());
+  for (std::size_t i = 0; i < segments.size(); ++i)
+  {
+    EXPECT_NEAR(SegmentDistance(segments[i],
+        segments[(i + 1) % segments.size()]), distances[i], 1e-6);
+  }
+
+  // Long parallel and nearly parallel segments
+  math::Vector3SoA<double> farStarts;
+  math::Vector3SoA<double> farEnds;
+  farStarts.PushBack(math::Vector3d(-1e6, 1, 0));
+  farEnds.PushBack(math::Vector3d(3e6, 1, 0));
+  farStarts.PushBack(math::Vector3d(-1e6, 1, 0));
+  farEnds.PushBack(math::Vector3d(3e6, 1.5, 0));
+  farStarts.PushBack(math::Vector3d(2e6 + 2, 0, 0));
+  farEnds.PushBack(math::Vector3d(5e6, 0, 0));
+  math::Line3d longLine(math::Vector3d(-2e6, 0, 0), math::Vector3d(2e6, 0, 0));
+  longLine.Distances(farStarts, farEnds, distances);
+  ASSERT_EQ(3u, distances.size());
+  EXPECT_NEAR(1.0, distances[0], 1e-6);
+  EXPECT_NEAR(SegmentDistance(longLine, math::Line3d(farStarts[1],
+      farEnds[1])), distances[1], 1e-6);
+  EXPECT_NEAR(2.0, distances[2], 1e-6);
+
+  // Empty batches
+  math::Line3d::Distances(math::Vector3SoA<double>(),
+      math::Vector3SoA<double>(), math::Vector3SoA<double>(),
+      math::Vector3SoA<double>(), distances);
+  EXPECT_TRUE(distances.empty());
+}
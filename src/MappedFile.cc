@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "gz/math/MappedFile.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Private data for the MappedFile class.
+class gz::math::MappedFilePrivate
+{
+  /// \brief Map a file.
+  /// \param[in] _filename Path of the file.
+  /// \return True on success.
+  public: bool Map(const std::string &_filename)
+  {
+#ifdef _WIN32
+    this->file = CreateFileA(_filename.c_str(), GENERIC_READ,
+        FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (this->file == INVALID_HANDLE_VALUE)
+      return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(this->file, &size) || size.QuadPart <= 0)
+      return false;
+    this->size = static_cast<std::size_t>(size.QuadPart);
+    this->mapping = CreateFileMappingA(this->file, nullptr, PAGE_READONLY,
+        0, 0, nullptr);
+    if (!this->mapping)
+      return false;
+    this->data = static_cast<const uint8_t *>(
+        MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0));
+    return this->data != nullptr;
+#else
+    const int fd = ::open(_filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+      ::close(fd);
+      return false;
+    }
+    this->size = static_cast<std::size_t>(st.st_size);
+    void *addr = ::mmap(nullptr, this->size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+    if (addr == MAP_FAILED)
+      return false;
+    this->data = static_cast<const uint8_t *>(addr);
+    return true;
+#endif
+  }
+
+  /// \brief Unmap the file.
+  public: void Unmap()
+  {
+#ifdef _WIN32
+    if (this->data)
+      UnmapViewOfFile(this->data);
+    if (this->mapping)
+      CloseHandle(this->mapping);
+    if (this->file != INVALID_HANDLE_VALUE)
+      CloseHandle(this->file);
+    this->mapping = nullptr;
+    this->file = INVALID_HANDLE_VALUE;
+#else
+    if (this->data)
+      ::munmap(const_cast<uint8_t *>(this->data), this->size);
+#endif
+    this->data = nullptr;
+    this->size = 0;
+  }
+
+  /// \brief Mapped bytes.
+  public: const uint8_t *data = nullptr;
+
+  /// \brief Number of mapped bytes.
+  public: std::size_t size = 0;
+
+#ifdef _WIN32
+  /// \brief Handle of the file.
+  public: HANDLE file = INVALID_HANDLE_VALUE;
+
+  /// \brief Handle of the mapping.
+  public: HANDLE mapping = nullptr;
+#endif
+};
+
+//////////////////////////////////////////////////
+MappedFile::MappedFile()
+  : dataPtr(new MappedFilePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+MappedFile::MappedFile(MappedFile &&_file)
+  : dataPtr(new MappedFilePrivate)
+{
+  std::swap(this->dataPtr, _file.dataPtr);
+}
+
+//////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+MappedFile &MappedFile::operator=(MappedFile &&_file) noexcept
+{
+  if (this != &_file)
+  {
+    this->Close();
+    std::swap(this->dataPtr, _file.dataPtr);
+  }
+  return *this;
+}
+
+//////////////////////////////////////////////////
+bool MappedFile::Open(const std::string &_filename)
+{
+  this->Close();
+  if (!this->dataPtr->Map(_filename))
+  {
+    this->Close();
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void MappedFile::Close()
+{
+  if (this->dataPtr)
+    this->dataPtr->Unmap();
+}
+
+//////////////////////////////////////////////////
+bool MappedFile::IsOpen() const
+{
+  return this->dataPtr->data != nullptr;
+}
+
+//////////////////////////////////////////////////
+const uint8_t *MappedFile::Data() const
+{
+  return this->dataPtr->data;
+}
+
+//////////////////////////////////////////////////
+std::size_t MappedFile::Size() const
+{
+  return this->dataPtr->size;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "gz/math/MappedFile.hh"
+
+using namespace gz;
+
+/// \brief Get a path in the temporary directory of the test.
+/// \param[in] _name Name of the file.
+/// \return Path of the file.
+static std::string TempPath(const std::string &_name)
+{
+  return testing::TempDir() + "MappedFile_TEST_" + _name;
+}
+
+/////////////////////////////////////////////////
+TEST(MappedFileTest, OpenClose)
+{
+  const std::string path = TempPath("data");
+  const std::string content = "mapped file content";
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+  }
+
+  math::MappedFile file;
+  EXPECT_FALSE(file.IsOpen());
+  EXPECT_EQ(nullptr, file.Data());
+  EXPECT_EQ(0u, file.Size());
+
+  ASSERT_TRUE(file.Open(path));
+  EXPECT_TRUE(file.IsOpen());
+  ASSERT_EQ(content.size(), file.Size());
+  EXPECT_EQ(content, std::string(reinterpret_cast<const char *>(file.Data()),
+                                 file.Size()));
+
+  // The mapping starts on a page boundary.
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(file.Data()) % 64);
+
+  // Moving transfers the mapping.
+  math::MappedFile moved(std::move(file));
+  EXPECT_FALSE(file.IsOpen());
+  ASSERT_TRUE(moved.IsOpen());
+  EXPECT_EQ('m', moved.Data()[0]);
+
+  file = std::move(moved);
+  EXPECT_TRUE(file.IsOpen());
+  EXPECT_FALSE(moved.IsOpen());
+
+  file.Close();
+  EXPECT_FALSE(file.IsOpen());
+  EXPECT_EQ(0u, file.Size());
+  std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////
+TEST(MappedFileTest, Invalid)
+{
+  math::MappedFile file;
+  EXPECT_FALSE(file.Open(TempPath("missing")));
+  EXPECT_FALSE(file.IsOpen());
+
+  // Empty files can't be mapped.
+  const std::string path = TempPath("empty");
+  std::ofstream(path, std::ios::binary).close();
+  EXPECT_FALSE(file.Open(path));
+  EXPECT_FALSE(file.IsOpen());
+  std::remove(path.c_str());
+}
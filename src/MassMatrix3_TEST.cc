@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 
 #include "gz/math/Helpers.hh"
 #include "gz/math/MassMatrix3.hh"
@@ -972,3 +973,45 @@ TEST(MassMatrix3dTest, ValidMomentsTolerance)
   EXPECT_FALSE(massMatrix.IsNearPositive(-1));
   EXPECT_FALSE(massMatrix.IsPositive(-1));
 }
+
+/////////////////////////////////////////////////
+TEST(MassMatrix3dTest, PrincipalAxes)
+{
+  // Diagonal, repeated and distinct moments, and an invalid matrix
+  std::vector<math::MassMatrix3d> matrices;
+  matrices.emplace_back(1.0, math::Vector3d(2, 3, 4), math::Vector3d::Zero);
+  matrices.emplace_back(1.0, math::Vector3d(4, 4, 3),
+                        math::Vector3d(-0.5, 0, 0));
+  matrices.emplace_back(1.0, math::Vector3d(4, 5, 6),
+                        math::Vector3d(0.5, 0.2, -0.3));
+  matrices.emplace_back(1.0, math::Vector3d(1, 1, 5), math::Vector3d::Zero);
+
+  std::vector<math::Vector3d> moments(matrices.size());
+  math::MassMatrix3d::PrincipalMoments(matrices.data(), matrices.size(),
+                                       moments.data());
+  bool valid[4];
+  EXPECT_FALSE(math::MassMatrix3d::IsValid(matrices.data(), matrices.size(),
+                                           valid));
+  EXPECT_TRUE(math::MassMatrix3d::IsValid(matrices.data(), 3, valid));
+
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+  {
+    const math::MassMatrix3d &m = matrices[i];
+    EXPECT_EQ(m.PrincipalMoments(), moments[i]);
+    EXPECT_EQ(m.IsValid(), valid[i]);
+
+    math::Vector3d combinedMoments;
+    math::Quaterniond offset;
+    EXPECT_TRUE(m.PrincipalAxes(combinedMoments, offset));
+    EXPECT_EQ(m.PrincipalMoments(), combinedMoments);
+    EXPECT_EQ(m.PrincipalAxesOffset(), offset);
+
+    // The offset diagonalizes the moment of inertia
+    const math::Matrix3d R(offset);
+    const math::Matrix3d L(moments[i][0], 0, 0,
+                           0, moments[i][1], 0,
+                           0, 0, moments[i][2]);
+    EXPECT_EQ(m.Moi(), R * L * R.Transposed());
+  }
+  EXPECT_FALSE(valid[3]);
+}
@@ -15,8 +15,15 @@
  *
 */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
 #include "gz/math/Material.hh"
 #include "gz/math/Helpers.hh"
+#include "gz/math/Instrumentation.hh"
 
 // Placing the kMaterialData in a separate file for conveniece and clarity.
 #include "MaterialType.hh"
@@ -29,28 +36,191 @@ static const std::map<MaterialType, Material> kMaterials = []()
 {
   std::map<MaterialType, Material> matMap;
 
-  for (const std::pair<const MaterialType, MaterialData> &mat : kMaterialData)
-  {
-    matMap[mat.first].SetType(mat.first);
-    matMap[mat.first].SetName(mat.second.name);
-    matMap[mat.first].SetDensity(mat.second.density);
-  }
+  for (const MaterialData &mat : kMaterialData)
+    matMap.emplace(mat.type, Material(mat.type));
 
   return matMap;
 }();
 
-// Private data for the Material class
-class gz::math::MaterialPrivate
+namespace
+{
+  /// \brief Number of slots in the material name hash table. This is a
+  /// power of two larger than the number of materials, so that probe
+  /// sequences stay short.
+  constexpr std::size_t kNameTableSize = 32;
+  static_assert(kNameTableSize >= 2 * kMaterialData.size(),
+      "kNameTableSize is too small for the number of materials");
+
+  //////////////////////////////////////////////////
+  /// \brief Convert an ASCII character to lowercase.
+  /// \param[in] _c Character to convert.
+  /// \return Lowercase character.
+  constexpr char ToLower(const char _c)
+  {
+    return (_c >= 'A' && _c <= 'Z') ? static_cast<char>(_c - 'A' + 'a') : _c;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief FNV-1a hash of the lowercase version of a string.
+  /// \param[in] _str Characters to hash.
+  /// \param[in] _size Number of characters.
+  /// \return Hash value.
+  constexpr std::uint32_t NameHash(const char *_str, const std::size_t _size)
+  {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+      hash ^= static_cast<unsigned char>(ToLower(_str[i]));
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Length of a null terminated string.
+  /// \param[in] _str String.
+  /// \return Number of characters before the null terminator.
+  constexpr std::size_t Length(const char *_str)
+  {
+    std::size_t size = 0;
+    while (_str[size] != '\0')
+      ++size;
+    return size;
+  }
+
+  /// \brief Open addressing hash table from the hash of a material name to
+  /// the index of the material in kMaterialData, or -1 for an empty slot.
+  /// Collisions are resolved with linear probing.
+  constexpr std::array<int, kNameTableSize> kNameTable = []()
+  {
+    std::array<int, kNameTableSize> table{};
+    for (auto &slot : table)
+      slot = -1;
+
+    for (std::size_t i = 0; i < kMaterialData.size(); ++i)
+    {
+      const char *name = kMaterialData[i].name;
+      std::size_t slot = NameHash(name, Length(name)) % kNameTableSize;
+      while (table[slot] >= 0)
+        slot = (slot + 1) % kNameTableSize;
+      table[slot] = static_cast<int>(i);
+    }
+    return table;
+  }();
+
+  /// \brief Indices into kMaterialData sorted by increasing density, and
+  /// by type for equal densities.
+  constexpr std::array<std::size_t, kMaterialData.size()> kDensityOrder = []()
+  {
+    std::array<std::size_t, kMaterialData.size()> order{};
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+      // Insertion sort, which is stable
+      std::size_t j = i;
+      while (j > 0 &&
+             kMaterialData[order[j - 1]].density > kMaterialData[i].density)
+      {
+        order[j] = order[j - 1];
+        --j;
+      }
+      order[j] = i;
+    }
+    return order;
+  }();
+
+  //////////////////////////////////////////////////
+  /// \brief Find a material by name, ignoring case.
+  /// \param[in] _name Name of the material.
+  /// \return Index of the material in kMaterialData, or -1 if there is no
+  /// material with that name.
+  int FindMaterial(const std::string &_name)
+  {
+    std::size_t slot = NameHash(_name.data(), _name.size()) % kNameTableSize;
+    for (; kNameTable[slot] >= 0; slot = (slot + 1) % kNameTableSize)
+    {
+      const char *name = kMaterialData[kNameTable[slot]].name;
+      std::size_t i = 0;
+      while (i < _name.size() && name[i] != '\0' &&
+             ToLower(_name[i]) == name[i])
+      {
+        ++i;
+      }
+      if (i == _name.size() && name[i] == '\0')
+        return kNameTable[slot];
+    }
+    return -1;
+  }
+}
+
+/// \brief Properties of a material, shared between copies of the material
+/// until one of them is changed.
+struct MaterialProperties
 {
   /// \brief The material type.
-  public: MaterialType type = MaterialType::UNKNOWN_MATERIAL;
+  MaterialType type = MaterialType::UNKNOWN_MATERIAL;
 
   /// \brief Name of the material. This will match the names
   /// used in MaterialType, but in lowercase.
-  public: std::string name = "";
+  std::string name = "";
 
   /// \brief Density value of the material in kg/m^3.
-  public: double density = -1;
+  double density = -1;
+};
+
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Get the shared properties of default constructed materials.
+  /// \return The shared properties.
+  const std::shared_ptr<MaterialProperties> &DefaultData()
+  {
+    static const std::shared_ptr<MaterialProperties> data =
+        std::make_shared<MaterialProperties>();
+    return data;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the shared properties of a built-in material.
+  /// \param[in] _index Index of the material in kMaterialData.
+  /// \return The shared properties.
+  const std::shared_ptr<MaterialProperties> &PredefinedData(
+      const std::size_t _index)
+  {
+    static const auto data = []()
+    {
+      std::array<std::shared_ptr<MaterialProperties>, kMaterialData.size()>
+          result;
+      for (std::size_t i = 0; i < kMaterialData.size(); ++i)
+      {
+        result[i] = std::make_shared<MaterialProperties>();
+        result[i]->type = kMaterialData[i].type;
+        result[i]->name = kMaterialData[i].name;
+        result[i]->density = kMaterialData[i].density;
+      }
+      return result;
+    }();
+    return data[_index];
+  }
+}
+
+// Private data for the Material class
+class gz::math::MaterialPrivate
+{
+  /// \brief Get the properties to change them, copying them first if they
+  /// are shared with other materials or with the static instances.
+  /// \return The properties, owned by this material only.
+  public: MaterialProperties &Mutable()
+  {
+    if (this->data.use_count() != 1)
+    {
+      IGN_MATH_COUNT_COPY(PIMPL, sizeof(MaterialProperties));
+      this->data = std::make_shared<MaterialProperties>(*this->data);
+    }
+    return *this->data;
+  }
+
+  /// \brief The material properties.
+  public: std::shared_ptr<MaterialProperties> data = DefaultData();
 };
 
 ///////////////////////////////
@@ -63,45 +233,33 @@ Material::Material()
 Material::Material(const MaterialType _type)
 : dataPtr(new MaterialPrivate)
 {
-  if (kMaterials.find(_type) != kMaterials.end())
-  {
-    this->dataPtr->type = _type;
-    this->dataPtr->name = kMaterials.at(_type).Name();
-    this->dataPtr->density = kMaterials.at(_type).Density();
-  }
+  const auto index = static_cast<std::size_t>(_type);
+  if (index < kMaterialData.size())
+    this->dataPtr->data = PredefinedData(index);
 }
 
 ///////////////////////////////
 Material::Material(const std::string &_typename)
 : dataPtr(new MaterialPrivate)
 {
-  // Convert to lowercase.
-  std::string material = _typename;
-  std::transform(material.begin(), material.end(), material.begin(), ::tolower);
-
-  for (const std::pair<const MaterialType, Material> &mat : kMaterials)
-  {
-    if (mat.second.Name() == material)
-    {
-      *this = mat.second;
-    }
-  }
+  // The name is matched without case.
+  const int index = FindMaterial(_typename);
+  if (index >= 0)
+    this->dataPtr->data = PredefinedData(index);
 }
 
 ///////////////////////////////
 Material::Material(const double _density)
 : dataPtr(new MaterialPrivate)
 {
-  this->dataPtr->density = _density;
+  this->dataPtr->data = std::make_shared<MaterialProperties>();
+  this->dataPtr->data->density = _density;
 }
 
 ///////////////////////////////
 Material::Material(const Material &_material)
-: dataPtr(new MaterialPrivate)
+: dataPtr(new MaterialPrivate(*_material.dataPtr))
 {
-  this->dataPtr->name = _material.Name();
-  this->dataPtr->density = _material.Density();
-  this->dataPtr->type = _material.Type();
 }
 
 ///////////////////////////////
@@ -128,8 +286,10 @@ const std::map<MaterialType, Material> &Material::Predefined()
 bool Material::operator==(const Material &_material) const
 {
   // Not checking the name, because type should be enough.
-  return this->dataPtr->type == _material.dataPtr->type &&
-         equal(this->dataPtr->density, _material.dataPtr->density);
+  if (this->dataPtr->data == _material.dataPtr->data)
+    return true;
+  return this->dataPtr->data->type == _material.dataPtr->data->type &&
+         equal(this->dataPtr->data->density, _material.dataPtr->data->density);
 }
 
 ///////////////////////////////
@@ -141,73 +301,104 @@ bool Material::operator!=(const Material &_material) const
 ///////////////////////////////
 Material &Material::operator=(const Material &_material)
 {
-  this->dataPtr->name = _material.Name();
-  this->dataPtr->density = _material.Density();
-  this->dataPtr->type = _material.Type();
+  this->dataPtr->data = _material.dataPtr->data;
   return *this;
 }
 
 ///////////////////////////////
 Material &Material::operator=(Material &&_material)
 {
-  delete this->dataPtr;
-  this->dataPtr = _material.dataPtr;
-  _material.dataPtr = new MaterialPrivate;
+  if (this != &_material)
+  {
+    delete this->dataPtr;
+    this->dataPtr = _material.dataPtr;
+    _material.dataPtr = new MaterialPrivate;
+  }
   return *this;
 }
 
 ///////////////////////////////
 MaterialType Material::Type() const
 {
-  return this->dataPtr->type;
+  return this->dataPtr->data->type;
 }
 
 //////////////////////////////////////////////////
 void Material::SetType(const MaterialType _type)
 {
-  this->dataPtr->type = _type;
+  this->dataPtr->Mutable().type = _type;
 }
 
 //////////////////////////////////////////////////
 std::string Material::Name() const
 {
-  return this->dataPtr->name;
+  return this->dataPtr->data->name;
 }
 
 //////////////////////////////////////////////////
 void Material::SetName(const std::string &_name)
 {
-  this->dataPtr->name = _name;
+  this->dataPtr->Mutable().name = _name;
 }
 
 //////////////////////////////////////////////////
 double Material::Density() const
 {
-  return this->dataPtr->density;
+  return this->dataPtr->data->density;
 }
 
 //////////////////////////////////////////////////
 void Material::SetDensity(const double _density)
 {
-  this->dataPtr->density = _density;
+  this->dataPtr->Mutable().density = _density;
 }
 
 //////////////////////////////////////////////////
 void Material::SetToNearestDensity(const double _value, const double _epsilon)
 {
-  double min = MAX_D;
-  Material result;
+  // Binary search for the first material with a density of at least _value.
+  // The nearest density is either that material or the one before it.
+  const auto first = std::lower_bound(kDensityOrder.begin(),
+      kDensityOrder.end(), _value, [](const std::size_t _index, double _v)
+      {
+        return kMaterialData[_index].density < _v;
+      });
 
-  for (const std::pair<const MaterialType, Material> &mat : kMaterials)
+  int nearest = -1;
+  double min = MAX_D;
+  auto consider = [&](const std::size_t _index)
   {
-    double diff = std::fabs(mat.second.Density() - _value);
-    if (diff < min && diff < _epsilon)
+    const double diff = std::fabs(kMaterialData[_index].density - _value);
+    // Prefer the lowest type for equal differences
+    if (diff < _epsilon && (diff < min ||
+        (equal(diff, min) && static_cast<int>(_index) < nearest)))
     {
       min = diff;
-      result = mat.second;
+      nearest = static_cast<int>(_index);
+    }
+  };
+
+  // Check every material with the same density as the candidates, so that
+  // ties are broken by type.
+  if (first != kDensityOrder.end())
+  {
+    const double density = kMaterialData[*first].density;
+    for (auto it = first; it != kDensityOrder.end() &&
+         equal(kMaterialData[*it].density, density); ++it)
+    {
+      consider(*it);
+    }
+  }
+  if (first != kDensityOrder.begin())
+  {
+    const double density = kMaterialData[*(first - 1)].density;
+    for (auto it = first; it != kDensityOrder.begin() &&
+         equal(kMaterialData[*(it - 1)].density, density); --it)
+    {
+      consider(*(it - 1));
     }
   }
 
-  if (result.Type() != MaterialType::UNKNOWN_MATERIAL)
-    *this = result;
+  if (nearest >= 0)
+    this->dataPtr->data = PredefinedData(static_cast<std::size_t>(nearest));
 }
@@ -17,8 +17,8 @@
 #ifndef GZ_MATERIAL_HH_
 #define GZ_MATERIAL_HH_
 
-#include <map>
-#include <string>
+#include <array>
+#include <cstddef>
 
 using namespace ignition;
 using namespace math;
@@ -26,31 +26,49 @@ using namespace math;
 // This class is used to curly-brace initialize kMaterialData
 struct MaterialData
 {
+  // Type of the material
+  MaterialType type;
+
   // Name of the material
-  std::string name;
+  const char *name;
 
   // Density of the material
   // cppcheck-suppress unusedStructMember
   double density;
 };
 
-// The mapping of material type to name and density values.
-// If you modify this map, make sure to also modify the MaterialType enum in
+// The type, name and density values of each material, in the order of the
+// MaterialType enum so that a material can be indexed by its type.
+// If you modify this table, make sure to also modify the MaterialType enum in
 // include/ignition/math/MaterialTypes.hh
-static std::map<MaterialType, MaterialData> kMaterialData =
+static constexpr std::array<MaterialData,
+    static_cast<std::size_t>(MaterialType::UNKNOWN_MATERIAL)> kMaterialData =
 {{
-  {MaterialType::STYROFOAM, {"styrofoam", 75.0}},
-  {MaterialType::PINE, {"pine", 373.0}},
-  {MaterialType::WOOD, {"wood", 700.0}},
-  {MaterialType::OAK, {"oak", 710.0}},
-  {MaterialType::PLASTIC, {"plastic", 1175.0}},
-  {MaterialType::CONCRETE, {"concrete", 2000.0}},
-  {MaterialType::ALUMINUM, {"aluminum", 2700.0}},
-  {MaterialType::STEEL_ALLOY, {"steel_alloy", 7600.0}},
-  {MaterialType::STEEL_STAINLESS, {"steel_stainless", 7800.0}},
-  {MaterialType::IRON, {"iron", 7870.0}},
-  {MaterialType::BRASS, {"brass", 8600.0}},
-  {MaterialType::COPPER, {"copper", 8940.0}},
-  {MaterialType::TUNGSTEN, {"tungsten", 19300.0}}
+  {MaterialType::STYROFOAM, "styrofoam", 75.0},
+  {MaterialType::PINE, "pine", 373.0},
+  {MaterialType::WOOD, "wood", 700.0},
+  {MaterialType::OAK, "oak", 710.0},
+  {MaterialType::PLASTIC, "plastic", 1175.0},
+  {MaterialType::CONCRETE, "concrete", 2000.0},
+  {MaterialType::ALUMINUM, "aluminum", 2700.0},
+  {MaterialType::STEEL_ALLOY, "steel_alloy", 7600.0},
+  {MaterialType::STEEL_STAINLESS, "steel_stainless", 7800.0},
+  {MaterialType::IRON, "iron", 7870.0},
+  {MaterialType::BRASS, "brass", 8600.0},
+  {MaterialType::COPPER, "copper", 8940.0},
+  {MaterialType::TUNGSTEN, "tungsten", 19300.0}
 }};
+
+// Check that each entry of kMaterialData is at the index of its type
+static constexpr bool MaterialDataInTypeOrder()
+{
+  for (std::size_t i = 0; i < kMaterialData.size(); ++i)
+  {
+    if (static_cast<std::size_t>(kMaterialData[i].type) != i)
+      return false;
+  }
+  return true;
+}
+static_assert(MaterialDataInTypeOrder(),
+    "kMaterialData must be in the order of the MaterialType enum");
 #endif
@@ -16,6 +16,10 @@
 */
 
 #include <gtest/gtest.h>
+#include <cctype>
+#include <string>
+#include <utility>
+
 #include "gz/math/Material.hh"
 #include "gz/math/MaterialType.hh"
 #include "gz/math/Helpers.hh"
@@ -137,3 +141,90 @@ TEST(MaterialTest, Accessors)
     EXPECT_DOUBLE_EQ(19300, material.Density());
   }
 }
+
+/////////////////////////////////////////////////
+TEST(MaterialTest, Shared)
+{
+  // Changing a copy leaves the other copies and the built-in materials
+  // unchanged
+  const Material wood(MaterialType::WOOD);
+  Material copy = wood;
+  copy.SetName("oak");
+  copy.SetDensity(750.0);
+  EXPECT_EQ("oak", copy.Name());
+  EXPECT_DOUBLE_EQ(750.0, copy.Density());
+  EXPECT_EQ(MaterialType::WOOD, copy.Type());
+  EXPECT_EQ("wood", wood.Name());
+  EXPECT_DOUBLE_EQ(700.0, wood.Density());
+  EXPECT_EQ(wood, Material::Predefined().at(MaterialType::WOOD));
+  EXPECT_DOUBLE_EQ(700.0, Material(MaterialType::WOOD).Density());
+
+  // A changed default material does not change the other default materials
+  Material custom;
+  custom.SetType(MaterialType::STEEL_STAINLESS);
+  custom.SetDensity(1.0);
+  EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL, Material().Type());
+  EXPECT_DOUBLE_EQ(-1.0, Material().Density());
+
+  // A material that is not shared is changed in place
+  Material single(12.0);
+  single.SetDensity(13.0);
+  Material other = single;
+  single.SetDensity(14.0);
+  EXPECT_DOUBLE_EQ(14.0, single.Density());
+  EXPECT_DOUBLE_EQ(13.0, other.Density());
+
+  // Choosing a built-in material by density drops the custom properties
+  copy.SetToNearestDensity(7810.0);
+  EXPECT_EQ(Material(MaterialType::STEEL_STAINLESS), copy);
+  EXPECT_EQ("steel_stainless", copy.Name());
+
+  // Self assignment
+  Material &ref = copy;
+  copy = ref;
+  EXPECT_EQ(Material(MaterialType::STEEL_STAINLESS), copy);
+  copy = std::move(ref);
+  EXPECT_EQ(Material(MaterialType::STEEL_STAINLESS), copy);
+}
+
+/////////////////////////////////////////////////
+TEST(MaterialTest, Lookup)
+{
+  // Every predefined material can be found by name, in any case
+  for (const auto &mat : Material::Predefined())
+  {
+    std::string upper = mat.second.Name();
+    for (auto &c : upper)
+      c = static_cast<char>(std::toupper(c));
+
+    EXPECT_EQ(mat.second, Material(mat.second.Name()));
+    EXPECT_EQ(mat.second, Material(upper));
+    EXPECT_EQ(mat.second.Name(), Material(upper).Name());
+    EXPECT_EQ(mat.second, Material(mat.first));
+
+    Material nearest;
+    nearest.SetToNearestDensity(mat.second.Density() + 0.1, 1.0);
+    EXPECT_EQ(mat.second, nearest);
+  }
+
+  // Prefixes, suffixes and empty names are not matched
+  EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL, Material("").Type());
+  EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL, Material("alu").Type());
+  EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL, Material("aluminum ").Type());
+  EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL, Material("steel").Type());
+
+  // Nearest density from either side
+  Material material;
+  material.SetToNearestDensity(0.0);
+  EXPECT_EQ(MaterialType::STYROFOAM, material.Type());
+  material.SetToNearestDensity(7700.0);
+  EXPECT_EQ(MaterialType::STEEL_ALLOY, material.Type());
+  material.SetToNearestDensity(7701.0);
+  EXPECT_EQ(MaterialType::STEEL_STAINLESS, material.Type());
+  material.SetToNearestDensity(7836.0);
+  EXPECT_EQ(MaterialType::IRON, material.Type());
+
+  // Out of range of every material, so unchanged
+  material.SetToNearestDensity(5000.0, 100.0);
+  EXPECT_EQ(MaterialType::IRON, material.Type());
+}
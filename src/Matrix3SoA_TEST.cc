@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gz/math/Matrix3SoA.hh"
+
+using namespace gz;
+
+/// \brief Matrices covering more than one block of the batch kernels.
+static std::vector<math::Matrix3d> TestMatrices()
+{
+  std::vector<math::Matrix3d> result;
+  for (int i = 0; i < 150; ++i)
+  {
+    const double s = 0.1 * i;
+    result.push_back(math::Matrix3d(1 + s, 0.5, -s, 0.2 * s, 2, 1,
+                                    -0.3, s * s, 3 - s));
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix3SoATest, Construct)
+{
+  math::Matrix3SoAd empty;
+  EXPECT_TRUE(empty.Empty());
+
+  math::Matrix3SoAd identity(3);
+  EXPECT_EQ(3u, identity.Size());
+  EXPECT_EQ(math::Matrix3d::Identity, identity[2]);
+
+  const auto matrices = TestMatrices();
+  math::Matrix3SoAd soa(matrices);
+  EXPECT_EQ(matrices.size(), soa.Size());
+  EXPECT_EQ(matrices, soa.ToVector());
+  EXPECT_DOUBLE_EQ(matrices[7](1, 2), soa.Data(1, 2)[7]);
+
+  soa.Set(0, math::Matrix3d::Zero);
+  EXPECT_EQ(math::Matrix3d::Zero, soa[0]);
+  EXPECT_NE(math::Matrix3SoAd(matrices), soa);
+  soa.PushBack(math::Matrix3d::Identity);
+  EXPECT_EQ(matrices.size() + 1, soa.Size());
+  soa.Clear();
+  EXPECT_TRUE(soa.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix3SoATest, DeterminantInverseMultiply)
+{
+  const auto matrices = TestMatrices();
+  math::Matrix3SoAd soa(matrices);
+
+  std::vector<double> det;
+  soa.Determinant(det);
+  ASSERT_EQ(matrices.size(), det.size());
+  math::Matrix3SoAd inv;
+  soa.Inverse(inv);
+  ASSERT_EQ(matrices.size(), inv.Size());
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(matrices[i].Determinant(), det[i]);
+    EXPECT_EQ(matrices[i].Inverse(), inv[i]);
+  }
+
+  // In place
+  math::Matrix3SoAd copy(soa);
+  copy.Inverse(copy);
+  EXPECT_EQ(inv, copy);
+
+  math::Vector3SoAd v;
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+    v.PushBack(math::Vector3d(0.5 * i, 1, -2));
+  math::Vector3SoAd out;
+  soa.Multiply(v, out);
+  ASSERT_EQ(matrices.size(), out.Size());
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+    EXPECT_EQ(matrices[i] * v[i], out[i]);
+  soa.Multiply(v, v);
+  EXPECT_EQ(out, v);
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix3SoATest, SymmetricEigen)
+{
+  std::vector<math::Matrix3d> matrices;
+  for (int i = 0; i < 100; ++i)
+  {
+    const math::Matrix3d rot(math::Quaterniond(0.1 * i, 0.03 * i, -0.2 * i));
+    const math::Matrix3d diag(i % 3, 0, 0, 0, 1, 0, 0, 0, 0.1 * i);
+    matrices.push_back(rot * diag * rot.Transposed());
+  }
+  math::Matrix3SoAd soa(matrices);
+
+  math::Vector3SoAd values;
+  math::Matrix3SoAd vectors;
+  soa.SymmetricEigen(values, vectors);
+  ASSERT_EQ(matrices.size(), values.Size());
+  ASSERT_EQ(matrices.size(), vectors.Size());
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+  {
+    math::Vector3d value;
+    math::Matrix3d vector;
+    matrices[i].SymmetricEigen(value, vector);
+    EXPECT_EQ(value, values[i]);
+    EXPECT_EQ(vector, vectors[i]);
+  }
+
+  // In place
+  soa.SymmetricEigen(values, soa);
+  EXPECT_EQ(vectors, soa);
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix3SoATest, CholeskyLdlt)
+{
+  std::vector<math::Matrix3d> matrices;
+  std::vector<math::Vector3d> vectors;
+  for (int i = 0; i < 100; ++i)
+  {
+    const math::Matrix3d rot(math::Quaterniond(0.1 * i, 0.03 * i, -0.2 * i));
+    const math::Matrix3d diag(1 + i % 3, 0, 0, 0, 1, 0, 0, 0, 0.1 + 0.1 * i);
+    matrices.push_back(rot * diag * rot.Transposed());
+    vectors.emplace_back(i, 1, -0.5 * i);
+  }
+  // Indefinite
+  matrices[7].Set(2, 1, 0, 1, -3, 1, 0, 1, 1);
+  const math::Matrix3SoAd soa(matrices);
+  const math::Vector3SoAd b(vectors);
+
+  math::Vector3SoAd x;
+  soa.CholeskySolve(b, x);
+  ASSERT_EQ(matrices.size(), x.Size());
+  math::Vector3SoAd y;
+  soa.LdltSolve(b, y);
+  ASSERT_EQ(matrices.size(), y.Size());
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+  {
+    EXPECT_TRUE((matrices[i] * y[i]).Equal(vectors[i], 1e-10));
+    if (i == 7)
+    {
+      EXPECT_FALSE(x[i].IsFinite());
+      continue;
+    }
+    EXPECT_TRUE((matrices[i] * x[i]).Equal(vectors[i], 1e-10));
+    math::Matrix3d l = matrices[i];
+    ASSERT_TRUE(l.CholeskyFactor());
+    EXPECT_TRUE(l.CholeskySolve(vectors[i]).Equal(x[i], 1e-12));
+  }
+
+  // In place
+  math::Vector3SoAd inPlace = b;
+  soa.LdltSolve(inPlace, inPlace);
+  EXPECT_EQ(y, inPlace);
+}
@@ -398,3 +398,166 @@ TEST(Matrix3dTest, From2Axes)
   m1.From2Axes(v1, v2);
   EXPECT_EQ(math::Matrix3d::Zero - math::Matrix3d::Identity, m1);
 }
+
+/////////////////////////////////////////////////
+/// \brief Check that _vectors is a rotation that diagonalizes _m with
+/// the sorted _values on the diagonal.
+static void CheckEigen(const math::Matrix3d &_m, const math::Vector3d &_values,
+    const math::Matrix3d &_vectors, const double _tol)
+{
+  EXPECT_LE(_values[0], _values[1]);
+  EXPECT_LE(_values[1], _values[2]);
+  EXPECT_NEAR(1.0, _vectors.Determinant(), 1e-12);
+  EXPECT_TRUE((_vectors.Transposed() * _vectors).Equal(
+      math::Matrix3d::Identity, 1e-12));
+  const math::Matrix3d diag(_values[0], 0, 0, 0, _values[1], 0,
+                            0, 0, _values[2]);
+  EXPECT_TRUE((_vectors * diag * _vectors.Transposed()).Equal(_m, _tol))
+      << _m << "\n" << _values << "\n" << _vectors;
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix3dTest, SymmetricEigen)
+{
+  math::Vector3d values;
+  math::Matrix3d vectors;
+
+  // Diagonal
+  math::Matrix3d m(3, 0, 0, 0, 1, 0, 0, 0, 2);
+  m.SymmetricEigen(values, vectors);
+  EXPECT_EQ(math::Vector3d(1, 2, 3), values);
+  CheckEigen(m, values, vectors, 1e-12);
+
+  // Generic, with a rotated diagonal matrix
+  const math::Matrix3d rot(math::Quaterniond(0.3, -0.7, 1.9));
+  const math::Matrix3d diag(-2, 0, 0, 0, 0.5, 0, 0, 0, 4);
+  m = rot * diag * rot.Transposed();
+  m.SymmetricEigen(values, vectors);
+  EXPECT_TRUE(values.Equal(math::Vector3d(-2, 0.5, 4), 1e-12));
+  CheckEigen(m, values, vectors, 1e-12);
+
+  // Repeated eigenvalues, both the smallest and the largest. The roots
+  // of the characteristic cubic lose half of the digits there.
+  for (const auto &d : {math::Vector3d(1, 1, 5), math::Vector3d(1, 5, 5)})
+  {
+    m = rot * math::Matrix3d(d[0], 0, 0, 0, d[1], 0, 0, 0, d[2]) *
+        rot.Transposed();
+    m.SymmetricEigen(values, vectors);
+    EXPECT_TRUE(values.Equal(d, 1e-7));
+    CheckEigen(m, values, vectors, 1e-7);
+  }
+
+  // Multiples of the identity and zero
+  m = math::Matrix3d::Identity * 2.5;
+  m.SymmetricEigen(values, vectors);
+  EXPECT_EQ(math::Vector3d(2.5, 2.5, 2.5), values);
+  EXPECT_EQ(math::Matrix3d::Identity, vectors);
+  math::Matrix3d::Zero.SymmetricEigen(values, vectors);
+  EXPECT_EQ(math::Vector3d::Zero, values);
+  EXPECT_EQ(math::Matrix3d::Identity, vectors);
+
+  // Nearly repeated, tiny and huge
+  m = rot * math::Matrix3d(1, 0, 0, 0, 1 + 1e-9, 0, 0, 0, 3) *
+      rot.Transposed();
+  m.SymmetricEigen(values, vectors);
+  CheckEigen(m, values, vectors, 1e-7);
+  m = rot * diag * rot.Transposed() * 1e-200;
+  m.SymmetricEigen(values, vectors);
+  EXPECT_TRUE((values * 1e200).Equal(math::Vector3d(-2, 0.5, 4), 1e-9));
+  m = rot * diag * rot.Transposed() * 1e200;
+  m.SymmetricEigen(values, vectors);
+  EXPECT_TRUE((values * 1e-200).Equal(math::Vector3d(-2, 0.5, 4), 1e-9));
+
+  // Covariance of a flat cloud: the normal is the first eigenvector
+  m.Set(2, 0.5, 0, 0.5, 1, 0, 0, 0, 0);
+  m = rot * m * rot.Transposed();
+  m.SymmetricEigen(values, vectors);
+  EXPECT_NEAR(0.0, values[0], 1e-12);
+  const math::Vector3d normal(vectors(0, 0), vectors(1, 0), vectors(2, 0));
+  const math::Vector3d expected(rot(0, 2), rot(1, 2), rot(2, 2));
+  EXPECT_NEAR(1.0, std::abs(normal.Dot(expected)), 1e-12);
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix3dTest, CholeskyLdlt)
+{
+  // Inertia of a box, rotated
+  const math::Matrix3d rot(math::Quaterniond(0.3, -0.5, 1.2));
+  const math::Matrix3d inertia =
+      rot * math::Matrix3d(2, 0, 0, 0, 3, 0, 0, 0, 0.5) * rot.Transposed();
+  const math::Vector3d b(1, -2, 0.5);
+
+  math::Matrix3d l = inertia;
+  ASSERT_TRUE(l.CholeskyFactor());
+  math::Vector3d x = l.CholeskySolve(b);
+  EXPECT_TRUE((inertia * x).Equal(b, 1e-12));
+  EXPECT_TRUE(x.Equal(inertia.Inverse() * b, 1e-12));
+  // The upper triangle is left unchanged
+  EXPECT_DOUBLE_EQ(inertia(0, 1), l(0, 1));
+  EXPECT_DOUBLE_EQ(inertia(1, 2), l(1, 2));
+
+  math::Matrix3d ld = inertia;
+  ASSERT_TRUE(ld.LdltFactor());
+  EXPECT_TRUE((inertia * ld.LdltSolve(b)).Equal(b, 1e-12));
+
+  // Indefinite: LDLT solves it, Cholesky does not
+  const math::Matrix3d indefinite(2, 1, 0, 1, -3, 1, 0, 1, 1);
+  l = indefinite;
+  EXPECT_FALSE(l.CholeskyFactor());
+  ld = indefinite;
+  ASSERT_TRUE(ld.LdltFactor());
+  x = ld.LdltSolve(b);
+  EXPECT_TRUE((indefinite * x).Equal(b, 1e-12));
+
+  // Singular and nearly singular matrices
+  const math::Matrix3d singular(1, 1, 0, 1, 1, 0, 0, 0, 1);
+  l = singular;
+  EXPECT_FALSE(l.CholeskyFactor());
+  ld = singular;
+  EXPECT_FALSE(ld.LdltFactor());
+  const math::Matrix3d nearly(1, 0, 0, 0, 1e-14, 0, 0, 0, 1);
+  l = nearly;
+  EXPECT_TRUE(l.CholeskyFactor());
+  l = nearly;
+  EXPECT_FALSE(l.CholeskyFactor(1e-12));
+  ld = nearly;
+  EXPECT_FALSE(ld.LdltFactor(1e-12));
+
+  // Non-finite matrices
+  l = inertia;
+  l(2, 1) = math::NAN_D;
+  EXPECT_FALSE(l.CholeskyFactor());
+  ld = inertia;
+  ld(0, 0) = math::INF_D;
+  EXPECT_FALSE(ld.LdltFactor());
+  ld = inertia;
+  ld(2, 2) = math::NAN_D;
+  EXPECT_FALSE(ld.LdltFactor());
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix3dTest, Constexpr)
+{
+  // The virtual destructor makes Matrix3 a literal type only from C++20.
+#if __cplusplus >= 202002L
+  constexpr math::Matrix3d m(1, 2, 3,
+                             0, 1, 4,
+                             5, 6, 0);
+  static_assert(static_cast<int>(m.Determinant()) == 1, "");
+  constexpr math::Matrix3d product = m * m.Inverse();
+  static_assert(static_cast<int>(product(0, 0)) == 1 &&
+                static_cast<int>(product(1, 2)) == 0, "");
+  static_assert(static_cast<int>(m.Transposed()(0, 2)) == 5, "");
+  static_assert(static_cast<int>((m + m - m)(2, 1)) == 6, "");
+#else
+  const math::Matrix3d m(1, 2, 3,
+                         0, 1, 4,
+                         5, 6, 0);
+  const math::Matrix3d product = m * m.Inverse();
+#endif
+  EXPECT_EQ(math::Matrix3d::Identity, product);
+  EXPECT_DOUBLE_EQ(1.0, m.Determinant());
+  EXPECT_DOUBLE_EQ(5.0, m.Transposed()(0, 2));
+  EXPECT_EQ(math::Vector3d(1, 2, 3),
+            math::Matrix3d::Identity * math::Vector3d(1, 2, 3));
+}
@@ -17,10 +17,15 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
 #include "gz/math/Pose3.hh"
 #include "gz/math/Quaternion.hh"
 #include "gz/math/Matrix4.hh"
 #include "gz/math/Vector3.hh"
+#include "gz/math/Vector3SoA.hh"
 
 using namespace gz;
 
@@ -287,6 +292,103 @@ TEST(Matrix4dTest, Inverse)
                                  -12, 24, 19, -1));
 }
 
+/////////////////////////////////////////////////
+// Reference product using plain loops, to check the vectorized kernels.
+template<typename T>
+math::Matrix4<T> ReferenceProduct(const math::Matrix4<T> &_a,
+    const math::Matrix4<T> &_b)
+{
+  math::Matrix4<T> r;
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      T sum = 0;
+      for (int k = 0; k < 4; ++k)
+        sum += _a(i, k) * _b(k, j);
+      r(i, j) = sum;
+    }
+  }
+  return r;
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix4Test, MultiplyKernels)
+{
+  math::Matrix4d ad(2, 3, 1, 5,
+                    1, 0, 3, 1,
+                    0, 2, -3, 2,
+                    0, 2, 3, 1);
+  math::Matrix4d bd(-1.5, 0.25, 3, 7,
+                    4, -2, 0.5, 1,
+                    1, 1, 1, 1,
+                    0.1, 0.2, 0.3, 0.4);
+  EXPECT_TRUE(ReferenceProduct(ad, bd).Equal(ad * bd, 1e-12));
+  EXPECT_TRUE(ReferenceProduct(bd, ad).Equal(bd * ad, 1e-12));
+
+  math::Matrix4f af(2, 3, 1, 5,
+                    1, 0, 3, 1,
+                    0, 2, -3, 2,
+                    0, 2, 3, 1);
+  math::Matrix4f bf(-1.5f, 0.25f, 3, 7,
+                    4, -2, 0.5f, 1,
+                    1, 1, 1, 1,
+                    0.1f, 0.2f, 0.3f, 0.4f);
+  EXPECT_TRUE(ReferenceProduct(af, bf).Equal(af * bf, 1e-5f));
+  EXPECT_TRUE(ReferenceProduct(bf, af).Equal(bf * af, 1e-5f));
+
+  math::Matrix4i ai(1, 2, 3, 4,
+                    5, 6, 7, 8,
+                    9, 10, 11, 12,
+                    13, 14, 15, 16);
+  EXPECT_EQ(ReferenceProduct(ai, ai), ai * ai);
+
+  // Self assignment goes through a temporary
+  math::Matrix4d cd = ad;
+  cd *= cd;
+  EXPECT_TRUE(ReferenceProduct(ad, ad).Equal(cd, 1e-12));
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix4Test, InverseFloat)
+{
+  math::Matrix4f mat(2, 3, 1, 5,
+                     1, 0, 3, 1,
+                     0, 2, -3, 2,
+                     0, 2, 3, 1);
+
+  math::Matrix4f expected(18, -35, -28, 1,
+                          9, -18, -14, 1,
+                          -2, 4, 3, 0,
+                          -12, 24, 19, -1);
+  EXPECT_TRUE(mat.Inverse().Equal(expected, 1e-4f));
+
+  // The float kernel must match the double implementation for general and
+  // rigid matrices.
+  const math::Pose3d poses[] = {
+    math::Pose3d(1, -2, 3, 0.1, 0.2, 0.3),
+    math::Pose3d(-10, 0.5, 7, -2.0, 1.2, -3.0),
+    math::Pose3d(0, 0, 0, 0, 0, 0)};
+  for (const auto &pose : poses)
+  {
+    math::Matrix4d md(pose);
+    md(3, 0) = 0.2;
+    md(0, 1) += 0.5;
+    math::Matrix4f mf;
+    for (int i = 0; i < 4; ++i)
+      for (int j = 0; j < 4; ++j)
+        mf(i, j) = static_cast<float>(md(i, j));
+
+    math::Matrix4d invd = md.Inverse();
+    math::Matrix4f invf = mf.Inverse();
+    for (int i = 0; i < 4; ++i)
+      for (int j = 0; j < 4; ++j)
+        EXPECT_NEAR(invd(i, j), invf(i, j), 1e-4) << i << " " << j;
+
+    EXPECT_TRUE((invf * mf).Equal(math::Matrix4f::Identity, 1e-5f));
+  }
+}
+
 /////////////////////////////////////////////////
 TEST(Matrix4dTest, GetAsPose3d)
 {
@@ -722,3 +824,147 @@ TEST(Matrix4dTest, LookAt)
                 .Pose(),
             math::Pose3d(1, 1, 1, IGN_PI_4, 0, IGN_PI));
 }
+
+/////////////////////////////////////////////////
+TEST(Matrix4dTest, InverseRigidAffine)
+{
+  for (const math::Pose3d &pose : {math::Pose3d::Zero,
+       math::Pose3d(1, -2, 3, 0.1, 0.2, 0.3),
+       math::Pose3d(-4, 0.5, 10, IGN_PI, -0.4, IGN_PI_2)})
+  {
+    const math::Matrix4d mat(pose);
+    EXPECT_EQ(mat.Inverse(), mat.InverseRigid());
+    EXPECT_EQ(mat.Inverse(), mat.InverseAffine());
+    EXPECT_EQ(math::Matrix4d(pose.Inverse()), mat.InverseRigid());
+    EXPECT_EQ(math::Matrix4d::Identity, mat * mat.InverseRigid());
+  }
+
+  // Affine matrices with scale and shear need InverseAffine
+  math::Matrix4d affine(2, 0.5, 0, 1,
+                        0, 3, 0.2, -2,
+                        0.1, 0, 0.5, 4,
+                        0, 0, 0, 1);
+  EXPECT_EQ(affine.Inverse(), affine.InverseAffine());
+  EXPECT_EQ(math::Matrix4d::Identity, affine * affine.InverseAffine());
+  EXPECT_NE(affine.Inverse(), affine.InverseRigid());
+
+  const math::Matrix4f rigid(math::Pose3f(1, 2, 3, 0.3, 0.2, 0.1));
+  EXPECT_EQ(math::Matrix4f::Identity, rigid * rigid.InverseRigid());
+}
+
+/////////////////////////////////////////////////
+/// \brief OpenGL perspective projection, looking along -Z with +Y up.
+template<typename T>
+math::Matrix4<T> Perspective(const T _fovY, const T _aspect, const T _near,
+                             const T _far)
+{
+  const T f = 1 / std::tan(_fovY / 2);
+  return math::Matrix4<T>(
+      f / _aspect, 0, 0, 0,
+      0, f, 0, 0,
+      0, 0, (_far + _near) / (_near - _far), 2 * _far * _near / (_near - _far),
+      0, 0, -1, 0);
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+void CheckProject()
+{
+  const math::Matrix4<T> proj = Perspective<T>(
+      static_cast<T>(IGN_PI_2), 2, 1, 100);
+  const math::Matrix4<T> view(
+      math::Pose3<T>(1, 2, 3, 0.1, -0.2, 0.3).Inverse());
+  const math::Matrix4<T> mat = proj * view;
+  const math::Pose3<T> camera(1, 2, 3, 0.1, -0.2, 0.3);
+
+  // Points in the camera frame, moved to the world frame
+  math::Vector3SoA<T> points;
+  const std::vector<math::Vector3<T>> local = {
+    {0, 0, -5}, {2, 1, -5}, {0, 0, 1}, {0, 0, -200}, {-20, 0, -5},
+    {0, 20, -10}, {0, -20, -10}, {20, 0, -0.5}};
+  for (const auto &p : local)
+    points.PushBack(camera.CoordPositionAdd(p));
+
+  std::vector<T> u, v, depth;
+  std::vector<uint8_t> clip;
+  EXPECT_EQ(2u, mat.Project(points, 640, 320, u, v, depth, clip));
+  ASSERT_EQ(local.size(), u.size());
+  ASSERT_EQ(local.size(), v.size());
+  ASSERT_EQ(local.size(), depth.size());
+  ASSERT_EQ(local.size(), clip.size());
+
+  const T tol = static_cast<T>(1e-3);
+  EXPECT_EQ(0u, clip[0]);
+  EXPECT_NEAR(320, u[0], tol);
+  EXPECT_NEAR(160, v[0], tol);
+  EXPECT_NEAR(5, depth[0], tol);
+
+  // Up and right of the center, with square pixels
+  EXPECT_EQ(0u, clip[1]);
+  EXPECT_NEAR(320 + 2.0 / 5 / 2 * 320, u[1], tol);
+  EXPECT_NEAR(160 - 1.0 / 5 * 160, v[1], tol);
+
+  // Behind the center of projection
+  EXPECT_NE(0, clip[2] & math::CLIP_NEAR);
+  EXPECT_NEAR(-1, depth[2], tol);
+  EXPECT_TRUE(std::isnan(u[2]));
+  EXPECT_TRUE(std::isnan(v[2]));
+
+  EXPECT_EQ(math::CLIP_FAR, clip[3]);
+  EXPECT_NEAR(200, depth[3], tol * 10);
+  EXPECT_EQ(math::CLIP_LEFT, clip[4]);
+  EXPECT_LT(u[4], 0);
+  EXPECT_EQ(math::CLIP_TOP, clip[5]);
+  EXPECT_LT(v[5], 0);
+  EXPECT_EQ(math::CLIP_BOTTOM, clip[6]);
+  EXPECT_EQ(math::CLIP_NEAR | math::CLIP_RIGHT, clip[7]);
+
+  // Every lane and the remainder of the vector kernels match a point by
+  // point projection.
+  math::Vector3SoA<T> many;
+  for (int i = 0; i < 103; ++i)
+  {
+    many.PushBack(camera.CoordPositionAdd(math::Vector3<T>(
+        static_cast<T>(std::sin(i) * 30), static_cast<T>(std::cos(i) * 20),
+        static_cast<T>(-std::fmod(i * 7.3, 120.0) + 10))));
+  }
+  const std::size_t inside = mat.Project(many, 640, 320, u, v, depth, clip);
+  std::size_t expectedInside = 0;
+  for (std::size_t i = 0; i < many.Size(); ++i)
+  {
+    const math::Vector3<T> p = many[i];
+    const math::Vector3<T> c = mat * p;
+    const T w = mat(3, 0) * p.X() + mat(3, 1) * p.Y() + mat(3, 2) * p.Z() +
+        mat(3, 3);
+    EXPECT_NEAR(w, depth[i], tol) << i;
+    uint8_t code = 0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      code |= (c[axis] < -w) << (2 * axis);
+      code |= (c[axis] > w) << (2 * axis + 1);
+    }
+    EXPECT_EQ(code, clip[i]) << i;
+    expectedInside += code == 0;
+    if (w > 0)
+    {
+      EXPECT_NEAR((c.X() / w + 1) * 320, u[i], tol * 10) << i;
+      EXPECT_NEAR((1 - c.Y() / w) * 160, v[i], tol * 10) << i;
+    }
+  }
+  EXPECT_EQ(expectedInside, inside);
+  EXPECT_GT(inside, 10u);
+  EXPECT_LT(inside, 90u);
+
+  // Empty input
+  EXPECT_EQ(0u, mat.Project(math::Vector3SoA<T>(), 640, 320, u, v, depth,
+                            clip));
+  EXPECT_TRUE(u.empty());
+  EXPECT_TRUE(clip.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix4dTest, Project)
+{
+  CheckProject<double>();
+  CheckProject<float>();
+}
@@ -17,7 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include "gz/math/Matrix6.hh"
+#include "gz/math/SpatialVector.hh"
 
 using namespace gz;
 using namespace math;
@@ -135,6 +139,28 @@ TEST(Matrix6dTest, Multiply)
   auto mat4 = mat;
   mat4 *= mat1;
   EXPECT_EQ(mat2, mat4);
+
+  // The double kernel may use SIMD, compare it with the portable one
+  Matrix6i imat, imat1;
+  for (int i = 0; i < 6; ++i)
+  {
+    for (int j = 0; j < 6; ++j)
+    {
+      imat(i, j) = i - j;
+      imat1(j, i) = i + j;
+    }
+  }
+  const Matrix6i imat2 = imat * imat1;
+  for (int i = 0; i < 6; ++i)
+  {
+    for (int j = 0; j < 6; ++j)
+      EXPECT_DOUBLE_EQ(mat2(i, j), imat2(i, j));
+  }
+
+  // Multiplying by itself
+  Matrix6d mat5 = mat;
+  mat5 *= mat5;
+  EXPECT_EQ(mat * mat, mat5);
 }
 
 /////////////////////////////////////////////////
@@ -393,3 +419,115 @@ TEST(Matrix6dTest, SetValue)
       4, 3, 2, 1, 0, -1,
       5, 4, 3, 2, 1, 0));
 }
+
+/////////////////////////////////////////////////
+/// \brief Multiply a matrix by a spatial vector, angular part first.
+SpatialVectord Multiply(const Matrix6d &_m, const SpatialVectord &_v)
+{
+  const double v[6] = {_v.Angular().X(), _v.Angular().Y(), _v.Angular().Z(),
+                       _v.Linear().X(), _v.Linear().Y(), _v.Linear().Z()};
+  double r[6] = {0, 0, 0, 0, 0, 0};
+  for (std::size_t i = 0; i < 6; ++i)
+  {
+    for (std::size_t j = 0; j < 6; ++j)
+      r[i] += _m(i, j) * v[j];
+  }
+  return SpatialVectord(Vector3d(r[0], r[1], r[2]),
+                        Vector3d(r[3], r[4], r[5]));
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix6dTest, CholeskyLdlt)
+{
+  // Spatial inertia of a body whose center of mass is off the origin
+  const double mass = 2;
+  const Matrix3d inertia(0.5, 0.1, 0, 0.1, 0.4, -0.05, 0, -0.05, 0.3);
+  const Vector3d c(0.2, -0.1, 0.3);
+  const Matrix3d cross(0, -c.Z(), c.Y(), c.Z(), 0, -c.X(), -c.Y(), c.X(), 0);
+  Matrix6d spatial;
+  spatial.SetSubmatrix(Matrix6d::TOP_LEFT,
+                       inertia + cross * cross.Transposed() * mass);
+  spatial.SetSubmatrix(Matrix6d::TOP_RIGHT, cross * mass);
+  spatial.SetSubmatrix(Matrix6d::BOTTOM_LEFT, cross.Transposed() * mass);
+  spatial.SetSubmatrix(Matrix6d::BOTTOM_RIGHT, Matrix3d::Identity * mass);
+  const SpatialVectord b(Vector3d(1, 2, -1), Vector3d(0.5, 0, 3));
+
+  Matrix6d l = spatial;
+  ASSERT_TRUE(l.CholeskyFactor(1e-12));
+  SpatialVectord x = l.CholeskySolve(b);
+  SpatialVectord product = Multiply(spatial, x);
+  EXPECT_TRUE(product.Angular().Equal(b.Angular(), 1e-12));
+  EXPECT_TRUE(product.Linear().Equal(b.Linear(), 1e-12));
+  EXPECT_DOUBLE_EQ(spatial(0, 5), l(0, 5));
+
+  Matrix6d ld = spatial;
+  ASSERT_TRUE(ld.LdltFactor(1e-12));
+  product = Multiply(spatial, ld.LdltSolve(b));
+  EXPECT_TRUE(product.Angular().Equal(b.Angular(), 1e-12));
+  EXPECT_TRUE(product.Linear().Equal(b.Linear(), 1e-12));
+
+  // Indefinite
+  Matrix6d indefinite = spatial;
+  indefinite(4, 4) = -mass;
+  l = indefinite;
+  EXPECT_FALSE(l.CholeskyFactor());
+  ld = indefinite;
+  ASSERT_TRUE(ld.LdltFactor());
+  product = Multiply(indefinite, ld.LdltSolve(b));
+  EXPECT_TRUE(product.Angular().Equal(b.Angular(), 1e-12));
+  EXPECT_TRUE(product.Linear().Equal(b.Linear(), 1e-12));
+
+  // Singular
+  l = Matrix6d::Identity;
+  l(3, 3) = 0;
+  EXPECT_FALSE(l.CholeskyFactor());
+  ld = Matrix6d::Identity;
+  ld(3, 3) = 0;
+  EXPECT_FALSE(ld.LdltFactor());
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix6dTest, CholeskyLdltBatch)
+{
+  std::vector<Matrix6d> matrices;
+  std::vector<SpatialVectord> vectors;
+  for (int i = 0; i < 10; ++i)
+  {
+    Matrix6d m = Matrix6d::Zero;
+    for (std::size_t k = 0; k < 6; ++k)
+      m(k, k) = 1 + i;
+    m(2, 0) = m(0, 2) = 0.1 * i;
+    m(5, 1) = m(1, 5) = -0.2 * i;
+    matrices.push_back(m);
+    vectors.emplace_back(Vector3d(i, 1, 2), Vector3d(-1, 0, i));
+  }
+  // A singular system in the middle
+  matrices[4](3, 3) = 0;
+
+  std::vector<Matrix6d> factors = matrices;
+  std::vector<SpatialVectord> solutions = vectors;
+  EXPECT_EQ(9u, Matrix6d::CholeskySolve(factors.data(), solutions.data(),
+                                        factors.size()));
+  std::vector<Matrix6d> ldlt = matrices;
+  std::vector<SpatialVectord> ldltSolutions = vectors;
+  EXPECT_EQ(9u, Matrix6d::LdltSolve(ldlt.data(), ldltSolutions.data(),
+                                    ldlt.size()));
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+  {
+    if (i == 4)
+    {
+      EXPECT_TRUE(std::isnan(solutions[i].Linear().X()));
+      EXPECT_TRUE(std::isnan(ldltSolutions[i].Angular().Z()));
+      continue;
+    }
+    Matrix6d single = matrices[i];
+    ASSERT_TRUE(single.CholeskyFactor());
+    EXPECT_EQ(single, factors[i]);
+    EXPECT_EQ(single.CholeskySolve(vectors[i]), solutions[i]);
+    const SpatialVectord product = Multiply(matrices[i], ldltSolutions[i]);
+    EXPECT_TRUE(product.Angular().Equal(vectors[i].Angular(), 1e-12));
+    EXPECT_TRUE(product.Linear().Equal(vectors[i].Linear(), 1e-12));
+  }
+
+  EXPECT_EQ(0u, Matrix6d::CholeskySolve(nullptr, nullptr, 0));
+}
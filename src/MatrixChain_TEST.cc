@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gz/math/Matrix3.hh"
+#include "gz/math/Matrix4.hh"
+#include "gz/math/Matrix6.hh"
+#include "gz/math/MatrixChain.hh"
+#include "gz/math/Pose3.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(MatrixChainTest, Matrix3)
+{
+  const math::Matrix3d a(math::Quaterniond(0.1, 0.2, 0.3));
+  const math::Matrix3d b(1, 2, 3, 0, 1, 4, 5, 6, 0);
+  const math::Matrix3d c(math::Quaterniond(-0.4, 0.5, 1.2));
+  const math::Vector3d v(0.3, -1.2, 2.5);
+
+  auto chain = math::Chain(a) * b * c;
+  EXPECT_EQ(3u, chain.Size());
+  EXPECT_EQ(a * b * c, chain.Eval());
+  const math::Matrix3d product = chain;
+  EXPECT_EQ(a * b * c, product);
+  EXPECT_TRUE((a * b * c * v).Equal(chain * v, 1e-12));
+  EXPECT_EQ(a * v, math::Chain(a) * v);
+}
+
+/////////////////////////////////////////////////
+TEST(MatrixChainTest, Matrix4)
+{
+  const math::Matrix4d a(math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3));
+  const math::Matrix4d b(math::Pose3d(-1, 0.5, 2, 0.4, -0.1, 0.9));
+  math::Matrix4d c(math::Pose3d(0, 0, 1, 0, 0.7, 0));
+  c.Scale(2, 1, 0.5);
+  const math::Vector3d v(0.3, -1.2, 2.5);
+
+  const auto chain = math::Chain(a) * b * c;
+  EXPECT_EQ(a * b * c, chain.Eval());
+  EXPECT_TRUE((a * b * c * v).Equal(chain * v, 1e-12));
+}
+
+/////////////////////////////////////////////////
+TEST(MatrixChainTest, Matrix6)
+{
+  math::Matrix6d a, b, c;
+  for (int i = 0; i < 6; ++i)
+  {
+    for (int j = 0; j < 6; ++j)
+    {
+      a(i, j) = i - j;
+      b(i, j) = 0.5 * (i + j);
+      c(i, j) = (i == j) ? 2.0 : 0.1 * j;
+    }
+  }
+
+  const math::Matrix6d product = math::Chain(a) * b * c * a;
+  EXPECT_EQ(a * b * c * a, product);
+}
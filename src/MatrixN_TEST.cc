@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "gz/math/MatrixN.hh"
+#include "gz/math/Quaternion.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(MatrixNTest, Construct)
+{
+  const math::MatrixN<double, 2, 3> zero;
+  for (std::size_t i = 0; i < zero.Size; ++i)
+    EXPECT_DOUBLE_EQ(0.0, zero[i]);
+  EXPECT_EQ(2u, zero.Rows);
+  EXPECT_EQ(3u, zero.Cols);
+
+  const math::MatrixN<double, 2, 3> m = {1, 2, 3, 4, 5, 6};
+  EXPECT_DOUBLE_EQ(2.0, m(0, 1));
+  EXPECT_DOUBLE_EQ(4.0, m(1, 0));
+  EXPECT_DOUBLE_EQ(6.0, m.Data()[5]);
+
+  // Missing elements are zero, extra ones are ignored
+  const math::VectorN<double, 3> partial = {1, 2};
+  EXPECT_DOUBLE_EQ(0.0, partial[2]);
+  const math::VectorN<double, 2> extra = {1, 2, 3};
+  EXPECT_DOUBLE_EQ(2.0, extra[1]);
+
+  const auto identity = math::MatrixN<double, 3, 4>::Identity();
+  EXPECT_DOUBLE_EQ(1.0, identity(2, 2));
+  EXPECT_DOUBLE_EQ(0.0, identity(2, 3));
+  EXPECT_DOUBLE_EQ(3.0, identity.Trace());
+  EXPECT_DOUBLE_EQ(2.0, (math::VectorN<double, 4>::Constant(2))[3]);
+
+  std::ostringstream stream;
+  stream << m;
+  EXPECT_EQ("1 2 3 4 5 6", stream.str());
+
+  // Storage is in place, and aligned when that adds no padding
+  EXPECT_EQ(sizeof(double) * 3, sizeof(math::VectorN<double, 3>));
+  EXPECT_EQ(16u, alignof(math::VectorN<double, 4>));
+  EXPECT_EQ(16u, alignof(math::MatrixN<float, 7, 4>));
+  EXPECT_EQ(alignof(float), alignof(math::MatrixN<float, 7, 3>));
+}
+
+/////////////////////////////////////////////////
+TEST(MatrixNTest, Arithmetic)
+{
+  const math::MatrixN<double, 2, 3> a = {1, 2, 3, 4, 5, 6};
+  const math::MatrixN<double, 3, 2> b = {1, 0, 0, 1, 2, -1};
+  const math::MatrixN<double, 2, 2> ab = a * b;
+  EXPECT_EQ((math::MatrixN<double, 2, 2>{7, -1, 16, -1}), ab);
+  EXPECT_EQ(a, a.Transposed().Transposed());
+  EXPECT_EQ((math::MatrixN<double, 3, 2>{1, 4, 2, 5, 3, 6}), a.Transposed());
+
+  EXPECT_EQ(a * 2, a + a);
+  EXPECT_EQ(2.0 * a, a + a);
+  EXPECT_EQ(a, (a * 4) / 4);
+  EXPECT_EQ((math::MatrixN<double, 2, 3>()), a - a);
+  EXPECT_EQ(-a, (math::MatrixN<double, 2, 3>() - a));
+  EXPECT_NE(a, a * 2);
+
+  const math::VectorN<double, 3> v = {1, -1, 2};
+  const math::VectorN<double, 2> av = a * v;
+  EXPECT_DOUBLE_EQ(5.0, av[0]);
+  EXPECT_DOUBLE_EQ(11.0, av[1]);
+  EXPECT_DOUBLE_EQ(6.0, v.SquaredLength());
+  EXPECT_DOUBLE_EQ(std::sqrt(6.0), v.Length());
+  EXPECT_DOUBLE_EQ(5.0, v.Dot(math::VectorN<double, 3>{1, 0, 2}));
+  EXPECT_TRUE(v.IsFinite());
+  math::VectorN<double, 3> w = v;
+  w[1] = math::NAN_D;
+  EXPECT_FALSE(w.IsFinite());
+
+  // Blocks
+  math::MatrixN<double, 4, 4> m;
+  m.SetBlock(1, 2, math::MatrixN<double, 2, 2>{1, 2, 3, 4});
+  EXPECT_DOUBLE_EQ(4.0, m(2, 3));
+  EXPECT_EQ((math::MatrixN<double, 2, 2>{1, 2, 3, 4}), (m.Block<2, 2>(1, 2)));
+  EXPECT_DOUBLE_EQ(0.0, (m.Block<3, 1>(0, 0)).SquaredLength());
+}
+
+/////////////////////////////////////////////////
+TEST(MatrixNTest, Interop)
+{
+  const math::Vector3d v3(1, 2, 3);
+  const math::VectorN<double, 3> n3(v3);
+  EXPECT_EQ(v3, math::Vector3d(n3));
+  const math::Vector2d v2(-1, 0.5);
+  EXPECT_EQ(v2, math::Vector2d(math::VectorN<double, 2>(v2)));
+  const math::Vector4d v4(1, 2, 3, 4);
+  EXPECT_EQ(v4, math::Vector4d(math::VectorN<double, 4>(v4)));
+
+  const math::Matrix3d m3(math::Quaterniond(0.1, 0.2, 0.3));
+  const math::MatrixN<double, 3, 3> n33(m3);
+  EXPECT_EQ(m3, math::Matrix3d(n33));
+  EXPECT_EQ(m3 * v3, math::Vector3d(n33 * n3));
+
+  const math::Matrix4d m4(math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3));
+  EXPECT_EQ(m4, math::Matrix4d(math::MatrixN<double, 4, 4>(m4)));
+
+  math::Matrix6d m6;
+  for (std::size_t i = 0; i < 6; ++i)
+    for (std::size_t j = 0; j < 6; ++j)
+      m6(i, j) = static_cast<double>(i * 6 + j);
+  const math::MatrixN<double, 6, 6> n66(m6);
+  EXPECT_DOUBLE_EQ(13.0, n66(2, 1));
+  EXPECT_EQ(m6, math::Matrix6d(n66));
+}
+
+/////////////////////////////////////////////////
+TEST(MatrixNTest, Solve)
+{
+  // Kalman update with a 4 state, 2 measurement model
+  const auto h = math::MatrixN<double, 2, 4>{1, 0, 0, 0, 0, 1, 0, 0};
+  auto p = math::MatrixN<double, 4, 4>::Identity() * 2;
+  p(0, 2) = p(2, 0) = 0.5;
+  const auto r = math::MatrixN<double, 2, 2>::Identity() * 0.1;
+  const auto pht = p * h.Transposed();
+  const math::MatrixN<double, 2, 2> s = h * pht + r;
+
+  math::MatrixN<double, 2, 2> l = s;
+  ASSERT_TRUE(l.CholeskyFactor());
+  // K = P H^T S^-1, so S K^T = H P
+  const math::MatrixN<double, 4, 2> k =
+      l.CholeskySolve(pht.Transposed()).Transposed();
+  EXPECT_TRUE((k * s).Equal(pht, 1e-12));
+
+  // A 7x7 indefinite system
+  math::MatrixN<double, 7, 7> a;
+  for (std::size_t i = 0; i < 7; ++i)
+  {
+    a(i, i) = i % 2 ? 3.0 + i : -2.0 - i;
+    if (i > 0)
+      a(i, i - 1) = a(i - 1, i) = 0.5;
+  }
+  const math::VectorN<double, 7> b = {1, 2, 3, 4, 5, 6, 7};
+  math::MatrixN<double, 7, 7> chol = a;
+  EXPECT_FALSE(chol.CholeskyFactor());
+  math::MatrixN<double, 7, 7> ldlt = a;
+  ASSERT_TRUE(ldlt.LdltFactor());
+  EXPECT_TRUE((a * ldlt.LdltSolve(b)).Equal(b, 1e-12));
+}
+
+/////////////////////////////////////////////////
+TEST(MatrixNTest, Constexpr)
+{
+  constexpr math::MatrixN<double, 2, 2> m = {1, 2, 3, 4};
+  constexpr math::MatrixN<double, 2, 2> product = m * m.Transposed();
+  static_assert(static_cast<int>(product(0, 1)) == 11, "");
+  static_assert(static_cast<int>((m + m)(1, 1)) == 8, "");
+  static_assert(math::MatrixN<int, 3, 3>::Identity().Trace() == 3, "");
+  EXPECT_DOUBLE_EQ(11.0, product(1, 0));
+
+  // Vector3d is not a literal type before C++20.
+  const math::VectorN<double, 3> v(math::Vector3d(1, 2, 3));
+  EXPECT_DOUBLE_EQ(14.0, v.SquaredLength());
+}
@@ -14,9 +14,10 @@
  * limitations under the License.
  *
 */
+#include <array>
 #include <cmath>
 #include "gz/math/MecanumDriveOdometry.hh"
-#include "gz/math/RollingMean.hh"
+#include "OdometryVelocityMean.hh"
 
 using namespace gz;
 using namespace math;
@@ -86,14 +87,9 @@ class gz::math::MecanumDriveOdometryPrivate
   /// \brief Previous backright wheel position/state in radians.
   public: double backRightWheelOldPos{0.0};
 
-  /// \brief Rolling mean accumulators for the linear velocity
-  public: RollingMean linearMean;
-
-  /// \brief Rolling mean accumulators for the lateral velocity
-  public: RollingMean lateralMean;
-
-  /// \brief Rolling mean accumulators for the angular velocity
-  public: RollingMean angularMean;
+  /// \brief Rolling mean accumulators for the linear, lateral and
+  /// angular velocities.
+  public: OdometryVelocityMean<3> velocityMean;
 
   /// \brief Initialized flag.
   public: bool initialized{false};
@@ -103,9 +99,7 @@ class gz::math::MecanumDriveOdometryPrivate
 MecanumDriveOdometry::MecanumDriveOdometry(size_t _windowSize)
   : dataPtr(new MecanumDriveOdometryPrivate)
 {
-  this->dataPtr->linearMean.SetWindowSize(_windowSize);
-  this->dataPtr->lateralMean.SetWindowSize(_windowSize);
-  this->dataPtr->angularMean.SetWindowSize(_windowSize);
+  this->dataPtr->velocityMean.SetWindowSize(_windowSize);
 }
 
 //////////////////////////////////////////////////
@@ -117,9 +111,7 @@ MecanumDriveOdometry::~MecanumDriveOdometry()
 void MecanumDriveOdometry::Init(const clock::time_point &_time)
 {
   // Reset accumulators and timestamp.
-  this->dataPtr->linearMean.Clear();
-  this->dataPtr->lateralMean.Clear();
-  this->dataPtr->angularMean.Clear();
+  this->dataPtr->velocityMean.Clear();
   this->dataPtr->x = 0.0;
   this->dataPtr->y = 0.0;
   this->dataPtr->heading = 0.0;
@@ -202,13 +194,13 @@ bool MecanumDriveOdometry::Update(const Angle &_frontLeftPos,
   this->dataPtr->lastUpdateTime = _time;
 
   // Estimate speeds using a rolling mean to filter them out:
-  this->dataPtr->linearMean.Push(linear / dt.count());
-  this->dataPtr->lateralMean.Push(lateral / dt.count());
-  this->dataPtr->angularMean.Push(angular / dt.count());
+  std::array<double, 3> means;
+  this->dataPtr->velocityMean.Push({linear / dt.count(),
+      lateral / dt.count(), angular / dt.count()}, means);
 
-  this->dataPtr->linearVel = this->dataPtr->linearMean.Mean();
-  this->dataPtr->lateralVel = this->dataPtr->lateralMean.Mean();
-  this->dataPtr->angularVel = this->dataPtr->angularMean.Mean();
+  this->dataPtr->linearVel = means[0];
+  this->dataPtr->lateralVel = means[1];
+  this->dataPtr->angularVel = means[2];
 
   return true;
 }
@@ -226,9 +218,7 @@ void MecanumDriveOdometry::SetWheelParams(double _wheelSeparation,
 //////////////////////////////////////////////////
 void MecanumDriveOdometry::SetVelocityRollingWindowSize(size_t _size)
 {
-  this->dataPtr->linearMean.SetWindowSize(_size);
-  this->dataPtr->lateralMean.SetWindowSize(_size);
-  this->dataPtr->angularMean.SetWindowSize(_size);
+  this->dataPtr->velocityMean.SetWindowSize(_size);
 }
 
 //////////////////////////////////////////////////
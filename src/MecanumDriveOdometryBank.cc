@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/MecanumDriveOdometryBank.hh"
+#include "OdometryBankState.hh"
+
+using namespace gz;
+using namespace math;
+
+//////////////////////////////////////////////////
+class gz::math::MecanumDriveOdometryBankPrivate
+{
+  /// \brief Compute the displacements of every vehicle from the wheel
+  /// positions, as MecanumDriveOdometry::Update does.
+  /// \param[in] _frontLeftPos Front left wheel positions in radians.
+  /// \param[in] _frontRightPos Front right wheel positions in radians.
+  /// \param[in] _backLeftPos Back left wheel positions in radians.
+  /// \param[in] _backRightPos Back right wheel positions in radians.
+  public: void Displacements(const double *_frontLeftPos,
+                             const double *_frontRightPos,
+                             const double *_backLeftPos,
+                             const double *_backRightPos)
+  {
+    const std::size_t n = this->wheelSeparation.size();
+    const double *sep = this->wheelSeparation.data();
+    const double *base = this->wheelBase.data();
+    const double *leftRadius = this->leftWheelRadius.data();
+    const double *rightRadius = this->rightWheelRadius.data();
+    double *frontLeftOld = this->frontLeftWheelOldPos.data();
+    double *frontRightOld = this->frontRightWheelOldPos.data();
+    double *backLeftOld = this->backLeftWheelOldPos.data();
+    double *backRightOld = this->backRightWheelOldPos.data();
+    double *linear = this->state.delta[0].data();
+    double *lateral = this->state.delta[1].data();
+    double *angular = this->state.delta[2].data();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      const double frontLeft = _frontLeftPos[i] * leftRadius[i];
+      const double frontRight = _frontRightPos[i] * rightRadius[i];
+      const double backLeft = _backLeftPos[i] * leftRadius[i];
+      const double backRight = _backRightPos[i] * rightRadius[i];
+      const double frontLeftVel = frontLeft - frontLeftOld[i];
+      const double frontRightVel = frontRight - frontRightOld[i];
+      const double backLeftVel = backLeft - backLeftOld[i];
+      const double backRightVel = backRight - backRightOld[i];
+      frontLeftOld[i] = frontLeft;
+      frontRightOld[i] = frontRight;
+      backLeftOld[i] = backLeft;
+      backRightOld[i] = backRight;
+
+      const double angularConst = (1/(4*(0.5*(sep[i] + base[i]))));
+      linear[i] = (frontLeftVel + frontRightVel
+        + backLeftVel + backRightVel) * 0.25;
+      lateral[i] = (-frontLeftVel + frontRightVel
+        + backLeftVel - backRightVel) * 0.25;
+      angular[i] = (-frontLeftVel + frontRightVel
+        - backLeftVel + backRightVel) * angularConst;
+    }
+  }
+
+  /// \brief Poses and velocities.
+  public: OdometryBankState state;
+
+  /// \brief Current timestamp.
+  public: MecanumDriveOdometryBank::clock::time_point lastUpdateTime;
+
+  /// \brief Left wheel radii in meters.
+  public: std::vector<double> leftWheelRadius;
+
+  /// \brief Right wheel radii in meters.
+  public: std::vector<double> rightWheelRadius;
+
+  /// \brief Wheel separations in meters.
+  public: std::vector<double> wheelSeparation;
+
+  /// \brief Wheel bases in meters.
+  public: std::vector<double> wheelBase;
+
+  /// \brief Previous front left wheel positions in meters.
+  public: std::vector<double> frontLeftWheelOldPos;
+
+  /// \brief Previous front right wheel positions in meters.
+  public: std::vector<double> frontRightWheelOldPos;
+
+  /// \brief Previous back left wheel positions in meters.
+  public: std::vector<double> backLeftWheelOldPos;
+
+  /// \brief Previous back right wheel positions in meters.
+  public: std::vector<double> backRightWheelOldPos;
+
+  /// \brief Initialized flag.
+  public: bool initialized{false};
+};
+
+//////////////////////////////////////////////////
+MecanumDriveOdometryBank::MecanumDriveOdometryBank(const std::size_t _size,
+    const std::size_t _windowSize)
+  : dataPtr(new MecanumDriveOdometryBankPrivate)
+{
+  this->dataPtr->state.SetWindowSize(_windowSize);
+  this->Resize(_size);
+}
+
+//////////////////////////////////////////////////
+MecanumDriveOdometryBank::MecanumDriveOdometryBank(
+    const MecanumDriveOdometryBank &_bank)
+  : dataPtr(new MecanumDriveOdometryBankPrivate(*_bank.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+MecanumDriveOdometryBank::~MecanumDriveOdometryBank()
+{
+}
+
+//////////////////////////////////////////////////
+MecanumDriveOdometryBank &MecanumDriveOdometryBank::operator=(
+    const MecanumDriveOdometryBank &_bank)
+{
+  *this->dataPtr = *_bank.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void MecanumDriveOdometryBank::Resize(const std::size_t _size)
+{
+  MecanumDriveOdometryBankPrivate &d = *this->dataPtr;
+  d.state.Resize(_size);
+  d.leftWheelRadius.resize(_size, 0.0);
+  d.rightWheelRadius.resize(_size, 0.0);
+  d.wheelSeparation.resize(_size, 1.0);
+  d.wheelBase.resize(_size, 1.0);
+  d.frontLeftWheelOldPos.resize(_size, 0.0);
+  d.frontRightWheelOldPos.resize(_size, 0.0);
+  d.backLeftWheelOldPos.resize(_size, 0.0);
+  d.backRightWheelOldPos.resize(_size, 0.0);
+}
+
+//////////////////////////////////////////////////
+std::size_t MecanumDriveOdometryBank::Size() const
+{
+  return this->dataPtr->wheelSeparation.size();
+}
+
+//////////////////////////////////////////////////
+void MecanumDriveOdometryBank::Init(const clock::time_point &_time)
+{
+  // Reset accumulators and timestamp.
+  MecanumDriveOdometryBankPrivate &d = *this->dataPtr;
+  d.state.Reset();
+  for (auto *old : {&d.frontLeftWheelOldPos, &d.frontRightWheelOldPos,
+                    &d.backLeftWheelOldPos, &d.backRightWheelOldPos})
+  {
+    std::fill(old->begin(), old->end(), 0.0);
+  }
+
+  d.lastUpdateTime = _time;
+  d.initialized = true;
+}
+
+//////////////////////////////////////////////////
+bool MecanumDriveOdometryBank::Initialized() const
+{
+  return this->dataPtr->initialized;
+}
+
+//////////////////////////////////////////////////
+bool MecanumDriveOdometryBank::Update(
+    const std::vector<double> &_frontLeftPos,
+    const std::vector<double> &_frontRightPos,
+    const std::vector<double> &_backLeftPos,
+    const std::vector<double> &_backRightPos,
+    const clock::time_point &_time)
+{
+  const std::size_t n = this->Size();
+  if (_frontLeftPos.size() != n || _frontRightPos.size() != n ||
+      _backLeftPos.size() != n || _backRightPos.size() != n)
+  {
+    IGN_MATH_DIAGNOSTIC("MecanumDriveOdometryBank::Update() error: got "
+        << _frontLeftPos.size() << ", " << _frontRightPos.size()
+        << ", " << _backLeftPos.size() << " and "
+        << _backRightPos.size() << " wheel positions for " << n
+        << " vehicles.");
+    return false;
+  }
+
+  const std::chrono::duration<double> dt =
+    _time - this->dataPtr->lastUpdateTime;
+
+  this->dataPtr->Displacements(_frontLeftPos.data(), _frontRightPos.data(),
+                               _backLeftPos.data(), _backRightPos.data());
+  this->dataPtr->state.Integrate<true>();
+
+  // We cannot estimate the speed if the time interval is zero (or near
+  // zero).
+  if (equal(0.0, dt.count()))
+    return false;
+
+  this->dataPtr->lastUpdateTime = _time;
+  this->dataPtr->state.PushVelocities<true>(dt.count());
+  return true;
+}
+
+//////////////////////////////////////////////////
+void MecanumDriveOdometryBank::SetWheelParams(double _wheelSeparation,
+    double _wheelBase, double _leftWheelRadius, double _rightWheelRadius)
+{
+  MecanumDriveOdometryBankPrivate &d = *this->dataPtr;
+  std::fill(d.wheelSeparation.begin(), d.wheelSeparation.end(),
+            _wheelSeparation);
+  std::fill(d.wheelBase.begin(), d.wheelBase.end(), _wheelBase);
+  std::fill(d.leftWheelRadius.begin(), d.leftWheelRadius.end(),
+            _leftWheelRadius);
+  std::fill(d.rightWheelRadius.begin(), d.rightWheelRadius.end(),
+            _rightWheelRadius);
+}
+
+//////////////////////////////////////////////////
+bool MecanumDriveOdometryBank::SetWheelParams(const std::size_t _index,
+    double _wheelSeparation, double _wheelBase, double _leftWheelRadius,
+    double _rightWheelRadius)
+{
+  if (_index >= this->Size())
+    return false;
+
+  this->dataPtr->wheelSeparation[_index] = _wheelSeparation;
+  this->dataPtr->wheelBase[_index] = _wheelBase;
+  this->dataPtr->leftWheelRadius[_index] = _leftWheelRadius;
+  this->dataPtr->rightWheelRadius[_index] = _rightWheelRadius;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void MecanumDriveOdometryBank::SetVelocityRollingWindowSize(size_t _size)
+{
+  this->dataPtr->state.SetWindowSize(_size);
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &MecanumDriveOdometryBank::Heading() const
+{
+  return this->dataPtr->state.heading;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &MecanumDriveOdometryBank::X() const
+{
+  return this->dataPtr->state.x;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &MecanumDriveOdometryBank::Y() const
+{
+  return this->dataPtr->state.y;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &MecanumDriveOdometryBank::LinearVelocity() const
+{
+  return this->dataPtr->state.velocity[0];
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &MecanumDriveOdometryBank::LateralVelocity() const
+{
+  return this->dataPtr->state.velocity[1];
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &MecanumDriveOdometryBank::AngularVelocity() const
+{
+  return this->dataPtr->state.velocity[2];
+}
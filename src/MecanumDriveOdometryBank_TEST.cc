@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "gz/math/MecanumDriveOdometryBank.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(MecanumDriveOdometryBankTest, Construct)
+{
+  math::MecanumDriveOdometryBank empty;
+  EXPECT_EQ(0u, empty.Size());
+  EXPECT_FALSE(empty.Initialized());
+
+  math::MecanumDriveOdometryBank odom(3);
+  EXPECT_EQ(3u, odom.Size());
+  EXPECT_EQ(3u, odom.LateralVelocity().size());
+  odom.Resize(2);
+  EXPECT_EQ(2u, odom.Y().size());
+  EXPECT_TRUE(odom.SetWheelParams(1, 1.0, 1.0, 0.5, 0.5));
+  EXPECT_FALSE(odom.SetWheelParams(2, 1.0, 1.0, 0.5, 0.5));
+
+  auto time = std::chrono::steady_clock::now();
+  odom.Init(time);
+  EXPECT_TRUE(odom.Initialized());
+  std::vector<double> pos(2, 1.0);
+  std::vector<double> shortPos(1, 1.0);
+  EXPECT_FALSE(odom.Update(pos, pos, pos, shortPos,
+                           time + std::chrono::seconds(1)));
+  EXPECT_DOUBLE_EQ(0.0, odom.X()[1]);
+  EXPECT_TRUE(odom.Update(pos, pos, pos, pos,
+                          time + std::chrono::seconds(1)));
+  EXPECT_DOUBLE_EQ(0.5, odom.X()[1]);
+  EXPECT_DOUBLE_EQ(0.5, odom.LinearVelocity()[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(MecanumDriveOdometryBankTest, MatchesMecanumDriveOdometry)
+{
+  const std::size_t n = 5;
+  math::MecanumDriveOdometryBank bank(n);
+  bank.SetWheelParams(1.0, 0.8, 0.2, 0.2);
+  std::vector<std::unique_ptr<math::MecanumDriveOdometry>> odoms;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    odoms.emplace_back(new math::MecanumDriveOdometry());
+    odoms[i]->SetWheelParams(1.0, 0.8, 0.2, 0.2);
+  }
+  // Per-vehicle wheel parameters
+  bank.SetWheelParams(2, 1.2, 0.9, 0.25, 0.3);
+  odoms[2]->SetWheelParams(1.2, 0.9, 0.25, 0.3);
+
+  // Window size other than the default
+  bank.SetVelocityRollingWindowSize(3);
+  for (auto &odom : odoms)
+    odom->SetVelocityRollingWindowSize(3);
+
+  auto time = std::chrono::steady_clock::now();
+  bank.Init(time);
+  for (auto &odom : odoms)
+    odom->Init(time);
+
+  std::vector<std::vector<double>> wheels(4, std::vector<double>(n, 0.0));
+  for (int step = 0; step < 200; ++step)
+  {
+    time += std::chrono::milliseconds(10);
+    for (std::size_t w = 0; w < 4; ++w)
+    {
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        // Vehicle 0 strafes without turning
+        const double turn = i == 0 ? 0.0 :
+            0.02 * std::sin(step * 0.03 * i + w);
+        const double strafe = (w == 1 || w == 2) ? 0.05 : -0.05;
+        wheels[w][i] += 0.1 + strafe + turn;
+      }
+    }
+
+    EXPECT_TRUE(bank.Update(wheels[0], wheels[1], wheels[2], wheels[3],
+                            time));
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      EXPECT_TRUE(odoms[i]->Update(
+          math::Angle(wheels[0][i]), math::Angle(wheels[1][i]),
+          math::Angle(wheels[2][i]), math::Angle(wheels[3][i]), time));
+      EXPECT_NEAR(odoms[i]->X(), bank.X()[i], 1e-9);
+      EXPECT_NEAR(odoms[i]->Y(), bank.Y()[i], 1e-9);
+      EXPECT_NEAR(*odoms[i]->Heading(), bank.Heading()[i], 1e-9);
+      EXPECT_NEAR(odoms[i]->LinearVelocity(), bank.LinearVelocity()[i],
+                  1e-9);
+      EXPECT_NEAR(odoms[i]->LateralVelocity(),
+                  bank.LateralVelocity()[i], 1e-9);
+      EXPECT_NEAR(*odoms[i]->AngularVelocity(),
+                  bank.AngularVelocity()[i], 1e-9);
+    }
+  }
+  EXPECT_LT(0.1, bank.Y()[0]);
+}
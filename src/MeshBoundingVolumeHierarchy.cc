@@ -0,0 +1,593 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+#include "gz/math/BoundingVolumeHierarchy.hh"
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/MeshBoundingVolumeHierarchy.hh"
+#include "gz/math/Trace.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Minimum number of triangles handled by each thread of a build.
+  const std::size_t kMinTrianglesPerThread = 16384;
+
+  /// \brief Minimum number of points handled by each thread of a batch of
+  /// signed distance queries.
+  const std::size_t kMinPointsPerThread = 1024;
+
+  /// \brief Feature of a triangle closest to a point. Edge features are
+  /// numbered like the edges of a triangle, edge i going from vertex i to
+  /// vertex (i + 1) % 3.
+  enum Feature
+  {
+    kVertex0,
+    kVertex1,
+    kVertex2,
+    kEdge0,
+    kEdge1,
+    kEdge2,
+    kFace
+  };
+
+  /////////////////////////////////////////////////
+  /// \brief Closest point of a segment to a point.
+  Vector3d ClosestPointOnSegment(const Vector3d &_p, const Vector3d &_a,
+                                 const Vector3d &_b)
+  {
+    const Vector3d ab = _b - _a;
+    const double lengthSq = ab.SquaredLength();
+    if (!(lengthSq > 0))
+      return _a;
+    const double t = std::clamp((_p - _a).Dot(ab) / lengthSq, 0.0, 1.0);
+    return _a + ab * t;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Closest point of a triangle to a point, following Ericson,
+  /// Real-Time Collision Detection, section 5.1.5.
+  /// \param[in] _p The point.
+  /// \param[in] _a First vertex of the triangle.
+  /// \param[in] _b Second vertex of the triangle.
+  /// \param[in] _c Third vertex of the triangle.
+  /// \param[out] _feature Feature of the triangle the closest point is on.
+  /// \return The closest point.
+  Vector3d ClosestPointOnTriangle(const Vector3d &_p, const Vector3d &_a,
+                                  const Vector3d &_b, const Vector3d &_c,
+                                  Feature &_feature)
+  {
+    const Vector3d ab = _b - _a;
+    const Vector3d ac = _c - _a;
+    const Vector3d ap = _p - _a;
+    const double d1 = ab.Dot(ap);
+    const double d2 = ac.Dot(ap);
+    if (d1 <= 0 && d2 <= 0)
+    {
+      _feature = kVertex0;
+      return _a;
+    }
+
+    const Vector3d bp = _p - _b;
+    const double d3 = ab.Dot(bp);
+    const double d4 = ac.Dot(bp);
+    if (d3 >= 0 && d4 <= d3)
+    {
+      _feature = kVertex1;
+      return _b;
+    }
+
+    const double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0)
+    {
+      _feature = kEdge0;
+      return _a + ab * (d1 / (d1 - d3));
+    }
+
+    const Vector3d cp = _p - _c;
+    const double d5 = ab.Dot(cp);
+    const double d6 = ac.Dot(cp);
+    if (d6 >= 0 && d5 <= d6)
+    {
+      _feature = kVertex2;
+      return _c;
+    }
+
+    const double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0)
+    {
+      _feature = kEdge2;
+      return _a + ac * (d2 / (d2 - d6));
+    }
+
+    const double va = d3 * d6 - d5 * d4;
+    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+    {
+      _feature = kEdge1;
+      return _b + (_c - _b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    const double sum = va + vb + vc;
+    if (!(sum > 0))
+    {
+      // Degenerate triangle, whose closest point is on one of its edges
+      const Vector3d points[3] = {ClosestPointOnSegment(_p, _a, _b),
+                                  ClosestPointOnSegment(_p, _b, _c),
+                                  ClosestPointOnSegment(_p, _c, _a)};
+      int best = 0;
+      for (int e = 1; e < 3; ++e)
+      {
+        if ((_p - points[e]).SquaredLength() <
+            (_p - points[best]).SquaredLength())
+          best = e;
+      }
+      _feature = static_cast<Feature>(kEdge0 + best);
+      return points[best];
+    }
+
+    _feature = kFace;
+    return _a + ab * (vb / sum) + ac * (vc / sum);
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Check if a triangle intersects a box, using the separating axis
+  /// theorem as in Akenine-Moller, Fast 3D Triangle-Box Overlap Testing.
+  /// \param[in] _center Center of the box.
+  /// \param[in] _half Half of the size of the box.
+  /// \param[in] _v0 First vertex of the triangle.
+  /// \param[in] _v1 Second vertex of the triangle.
+  /// \param[in] _v2 Third vertex of the triangle.
+  /// \return True if they intersect or touch.
+  bool TriangleBoxOverlap(const Vector3d &_center, const Vector3d &_half,
+                          const Vector3d &_v0, const Vector3d &_v1,
+                          const Vector3d &_v2)
+  {
+    const Vector3d v[3] = {_v0 - _center, _v1 - _center, _v2 - _center};
+
+    // Separation along the box axes
+    for (int a = 0; a < 3; ++a)
+    {
+      if (std::min({v[0][a], v[1][a], v[2][a]}) > _half[a] ||
+          std::max({v[0][a], v[1][a], v[2][a]}) < -_half[a])
+      {
+        return false;
+      }
+    }
+
+    // Separation along the normal of the triangle
+    const Vector3d edges[3] = {v[1] - v[0], v[2] - v[1], v[0] - v[2]};
+    const Vector3d normal = edges[0].Cross(edges[1]);
+    const double radius = _half.X() * std::abs(normal.X()) +
+        _half.Y() * std::abs(normal.Y()) + _half.Z() * std::abs(normal.Z());
+    if (std::abs(normal.Dot(v[0])) > radius)
+      return false;
+
+    // Separation along the cross products of the box axes and the edges
+    for (const Vector3d &edge : edges)
+    {
+      const Vector3d axes[3] = {
+          Vector3d(0, -edge.Z(), edge.Y()),
+          Vector3d(edge.Z(), 0, -edge.X()),
+          Vector3d(-edge.Y(), edge.X(), 0)};
+      for (const Vector3d &axis : axes)
+      {
+        const double p0 = axis.Dot(v[0]);
+        const double p1 = axis.Dot(v[1]);
+        const double p2 = axis.Dot(v[2]);
+        const double r = _half.X() * std::abs(axis.X()) +
+            _half.Y() * std::abs(axis.Y()) + _half.Z() * std::abs(axis.Z());
+        if (std::min({p0, p1, p2}) > r || std::max({p0, p1, p2}) < -r)
+          return false;
+      }
+    }
+    return true;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Call a function on contiguous blocks of a range, one block per
+  /// thread.
+  /// \param[in] _count Size of the range.
+  /// \param[in] _threads Requested number of threads, 0 for the number of
+  /// hardware threads.
+  /// \param[in] _minPerThread Minimum size of a block.
+  /// \param[in] _function Function taking the beginning and end of a block.
+  template<typename Function>
+  void ForEachBlock(const std::size_t _count, const unsigned int _threads,
+                    const std::size_t _minPerThread, const Function &_function)
+  {
+    std::size_t threads = _threads;
+    if (threads == 0)
+      threads = std::thread::hardware_concurrency();
+    threads = std::min(threads, _count / _minPerThread);
+    if (threads <= 1)
+    {
+      _function(std::size_t{0}, _count);
+      return;
+    }
+
+    const std::size_t chunk = (_count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (std::size_t t = 1; t < threads; ++t)
+    {
+      const std::size_t begin = std::min(_count, t * chunk);
+      const std::size_t end = std::min(_count, begin + chunk);
+      workers.emplace_back([&_function, begin, end]()
+          {
+            _function(begin, end);
+          });
+    }
+    _function(std::size_t{0}, std::min(_count, chunk));
+
+    for (auto &worker : workers)
+      worker.join();
+  }
+}
+
+/// \brief Private data for MeshBoundingVolumeHierarchy.
+class gz::math::MeshBoundingVolumeHierarchyPrivate
+{
+  /// \brief Find the closest point of the mesh.
+  /// \param[in] _point The point.
+  /// \param[in] _maxDistance Maximum allowed distance from _point.
+  /// \param[out] _closest Closest point of the mesh.
+  /// \param[out] _triangle Index of the triangle of the closest point.
+  /// \param[out] _feature Feature of that triangle the closest point is on.
+  /// \return True if a triangle is within _maxDistance of _point.
+  public: bool Closest(const Vector3d &_point, const double _maxDistance,
+                       Vector3d &_closest, std::size_t &_triangle,
+                       Feature &_feature) const;
+
+  /// \brief Closest point of a triangle.
+  /// \param[in] _point The point.
+  /// \param[in] _triangle Index of the triangle.
+  /// \param[out] _feature Feature of the triangle the closest point is on.
+  /// \return The closest point.
+  public: Vector3d ClosestOnTriangle(const Vector3d &_point,
+                                     const std::size_t _triangle,
+                                     Feature &_feature) const
+  {
+    const uint32_t *tri = &this->indices[3 * _triangle];
+    return ClosestPointOnTriangle(_point, this->vertices[tri[0]],
+        this->vertices[tri[1]], this->vertices[tri[2]], _feature);
+  }
+
+  /// \brief Vertex buffer.
+  public: std::vector<Vector3d> vertices;
+
+  /// \brief Index buffer, three indices per triangle.
+  public: std::vector<uint32_t> indices;
+
+  /// \brief Unit normal of each triangle, zero for degenerate triangles.
+  public: std::vector<Vector3d> faceNormals;
+
+  /// \brief Angle weighted pseudonormal of each vertex.
+  public: std::vector<Vector3d> vertexNormals;
+
+  /// \brief Pseudonormal of each edge of each triangle, the sum of the
+  /// normals of the triangles sharing it.
+  public: std::vector<Vector3d> edgeNormals;
+
+  /// \brief Hierarchy over the bounds of the triangles.
+  public: BoundingVolumeHierarchy bvh;
+};
+
+/////////////////////////////////////////////////
+bool MeshBoundingVolumeHierarchyPrivate::Closest(const Vector3d &_point,
+    const double _maxDistance, Vector3d &_closest, std::size_t &_triangle,
+    Feature &_feature) const
+{
+  const auto result = this->bvh.Nearest(_point, _maxDistance,
+      [&](const std::size_t _t, double &_dist)
+      {
+        Feature feature;
+        _dist = _point.Distance(this->ClosestOnTriangle(_point, _t, feature));
+        return true;
+      });
+  if (!std::get<0>(result))
+    return false;
+
+  _triangle = std::get<2>(result);
+  _closest = this->ClosestOnTriangle(_point, _triangle, _feature);
+  return true;
+}
+
+/////////////////////////////////////////////////
+MeshBoundingVolumeHierarchy::MeshBoundingVolumeHierarchy()
+  : dataPtr(std::make_unique<MeshBoundingVolumeHierarchyPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+MeshBoundingVolumeHierarchy::MeshBoundingVolumeHierarchy(
+    const std::vector<Vector3d> &_vertices,
+    const std::vector<uint32_t> &_indices, const unsigned int _threads)
+  : MeshBoundingVolumeHierarchy()
+{
+  this->Build(_vertices, _indices, _threads);
+}
+
+/////////////////////////////////////////////////
+MeshBoundingVolumeHierarchy::MeshBoundingVolumeHierarchy(
+    const MeshBoundingVolumeHierarchy &_bvh)
+  : dataPtr(std::make_unique<MeshBoundingVolumeHierarchyPrivate>(
+        *_bvh.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+MeshBoundingVolumeHierarchy::~MeshBoundingVolumeHierarchy() = default;
+
+/////////////////////////////////////////////////
+MeshBoundingVolumeHierarchy &MeshBoundingVolumeHierarchy::operator=(
+    const MeshBoundingVolumeHierarchy &_bvh)
+{
+  *this->dataPtr = *_bvh.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+bool MeshBoundingVolumeHierarchy::Build(const std::vector<Vector3d> &_vertices,
+    const std::vector<uint32_t> &_indices, const unsigned int _threads)
+{
+  IGN_MATH_TRACE_ZONE("MeshBoundingVolumeHierarchy::Build");
+  auto &d = *this->dataPtr;
+  d.vertices.clear();
+  d.indices.clear();
+  d.faceNormals.clear();
+  d.vertexNormals.clear();
+  d.edgeNormals.clear();
+  d.bvh.Build({});
+
+  if (_indices.size() % 3 != 0)
+  {
+    IGN_MATH_DIAGNOSTIC(
+        "MeshBoundingVolumeHierarchy::Build() error: the number of "
+        << "indices [" << _indices.size() << "] is not a multiple of 3");
+    return false;
+  }
+  for (const uint32_t index : _indices)
+  {
+    if (index >= _vertices.size())
+    {
+      IGN_MATH_DIAGNOSTIC("MeshBoundingVolumeHierarchy::Build() error: index ["
+          << index << "] is out of range for [" << _vertices.size()
+          << "] vertices");
+      return false;
+    }
+  }
+
+  d.vertices = _vertices;
+  d.indices = _indices;
+  const std::size_t triangleCount = _indices.size() / 3;
+
+  std::vector<AxisAlignedBox> boxes(triangleCount);
+  d.faceNormals.resize(triangleCount);
+  ForEachBlock(triangleCount, _threads, kMinTrianglesPerThread,
+      [&](const std::size_t _begin, const std::size_t _end)
+      {
+        for (std::size_t t = _begin; t < _end; ++t)
+        {
+          const Vector3d &a = d.vertices[d.indices[3 * t]];
+          const Vector3d &b = d.vertices[d.indices[3 * t + 1]];
+          const Vector3d &c = d.vertices[d.indices[3 * t + 2]];
+          Vector3d min = a;
+          Vector3d max = a;
+          min.Min(b);
+          min.Min(c);
+          max.Max(b);
+          max.Max(c);
+          boxes[t] = AxisAlignedBox(min, max);
+
+          const Vector3d normal = (b - a).Cross(c - a);
+          const double length = normal.Length();
+          d.faceNormals[t] = length > 0 ? normal / length : Vector3d::Zero;
+        }
+      });
+
+  // Each triangle adds its normal to its vertices, weighted by its angle
+  // at the vertex.
+  d.vertexNormals.assign(d.vertices.size(), Vector3d::Zero);
+  for (std::size_t t = 0; t < triangleCount; ++t)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      const Vector3d &v = d.vertices[d.indices[3 * t + k]];
+      const Vector3d u = d.vertices[d.indices[3 * t + (k + 1) % 3]] - v;
+      const Vector3d w = d.vertices[d.indices[3 * t + (k + 2) % 3]] - v;
+      const double angle = std::atan2(u.Cross(w).Length(), u.Dot(w));
+      d.vertexNormals[d.indices[3 * t + k]] += d.faceNormals[t] * angle;
+    }
+  }
+
+  // Group the edges of all triangles by their vertices to sum the normals
+  // of the triangles sharing each edge.
+  std::vector<std::pair<uint64_t, uint32_t>> edges(3 * triangleCount);
+  for (std::size_t e = 0; e < edges.size(); ++e)
+  {
+    const uint64_t i = d.indices[e];
+    const uint64_t j = d.indices[e - e % 3 + (e + 1) % 3];
+    edges[e] = {(std::min(i, j) << 32) | std::max(i, j),
+                static_cast<uint32_t>(e)};
+  }
+  std::sort(edges.begin(), edges.end());
+  d.edgeNormals.resize(edges.size());
+  for (std::size_t first = 0; first < edges.size();)
+  {
+    std::size_t last = first;
+    Vector3d normal;
+    while (last < edges.size() && edges[last].first == edges[first].first)
+    {
+      normal += d.faceNormals[edges[last].second / 3];
+      ++last;
+    }
+    for (std::size_t e = first; e < last; ++e)
+      d.edgeNormals[edges[e].second] = normal;
+    first = last;
+  }
+
+  d.bvh.Build(boxes, _threads);
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::size_t MeshBoundingVolumeHierarchy::TriangleCount() const
+{
+  return this->dataPtr->indices.size() / 3;
+}
+
+/////////////////////////////////////////////////
+bool MeshBoundingVolumeHierarchy::Empty() const
+{
+  return this->dataPtr->indices.empty();
+}
+
+/////////////////////////////////////////////////
+const std::vector<Vector3d> &MeshBoundingVolumeHierarchy::Vertices() const
+{
+  return this->dataPtr->vertices;
+}
+
+/////////////////////////////////////////////////
+const std::vector<uint32_t> &MeshBoundingVolumeHierarchy::Indices() const
+{
+  return this->dataPtr->indices;
+}
+
+/////////////////////////////////////////////////
+Triangle3d MeshBoundingVolumeHierarchy::Triangle(
+    const std::size_t _index) const
+{
+  const auto &d = *this->dataPtr;
+  return Triangle3d(d.vertices[d.indices[3 * _index]],
+                    d.vertices[d.indices[3 * _index + 1]],
+                    d.vertices[d.indices[3 * _index + 2]]);
+}
+
+/////////////////////////////////////////////////
+AxisAlignedBox MeshBoundingVolumeHierarchy::Bounds() const
+{
+  return this->dataPtr->bvh.Bounds();
+}
+
+/////////////////////////////////////////////////
+std::tuple<bool, double, std::size_t> MeshBoundingVolumeHierarchy::ClosestHit(
+    const Vector3d &_origin, const Vector3d &_dir,
+    const double _min, const double _max) const
+{
+  const auto &d = *this->dataPtr;
+  const Vector3d dir = _dir.Normalized();
+  return d.bvh.ClosestHit(_origin, dir, _min, _max,
+      [&](const std::size_t _t, double &_dist)
+      {
+        const uint32_t *tri = &d.indices[3 * _t];
+        double u, v;
+        return Triangle3d::RayIntersection(d.vertices[tri[0]],
+            d.vertices[tri[1]], d.vertices[tri[2]], _origin, dir, _dist,
+            u, v);
+      });
+}
+
+/////////////////////////////////////////////////
+bool MeshBoundingVolumeHierarchy::ClosestPoint(const Vector3d &_point,
+    Vector3d &_closest, std::size_t &_triangle,
+    const double _maxDistance) const
+{
+  Feature feature;
+  return this->dataPtr->Closest(_point, _maxDistance, _closest, _triangle,
+                                feature);
+}
+
+/////////////////////////////////////////////////
+double MeshBoundingVolumeHierarchy::SignedDistance(
+    const Vector3d &_point) const
+{
+  const auto &d = *this->dataPtr;
+  Vector3d closest;
+  std::size_t triangle;
+  Feature feature;
+  if (!d.Closest(_point, MAX_D, closest, triangle, feature))
+    return NAN_D;
+
+  Vector3d normal;
+  if (feature == kFace)
+    normal = d.faceNormals[triangle];
+  else if (feature >= kEdge0)
+    normal = d.edgeNormals[3 * triangle + (feature - kEdge0)];
+  else
+    normal = d.vertexNormals[d.indices[3 * triangle + feature]];
+
+  const Vector3d offset = _point - closest;
+  const double distance = offset.Length();
+  return offset.Dot(normal) < 0 ? -distance : distance;
+}
+
+/////////////////////////////////////////////////
+void MeshBoundingVolumeHierarchy::SignedDistances(const Vector3d *_points,
+    const std::size_t _count, double *_distances,
+    const unsigned int _threads) const
+{
+  IGN_MATH_TRACE_ZONE("MeshBoundingVolumeHierarchy::SignedDistances");
+  ForEachBlock(_count, _threads, kMinPointsPerThread,
+      [&](const std::size_t _begin, const std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+          _distances[i] = this->SignedDistance(_points[i]);
+      });
+}
+
+/////////////////////////////////////////////////
+void MeshBoundingVolumeHierarchy::Overlaps(const Vector3d &_center,
+    const double _radius, std::vector<std::size_t> &_indices) const
+{
+  const auto &d = *this->dataPtr;
+  const Vector3d half(_radius, _radius, _radius);
+  d.bvh.Overlaps(AxisAlignedBox(_center - half, _center + half), _indices);
+
+  const double radiusSq = _radius * _radius;
+  auto outside = [&](const std::size_t _t)
+  {
+    Feature feature;
+    return (_center - d.ClosestOnTriangle(_center, _t, feature))
+        .SquaredLength() > radiusSq;
+  };
+  _indices.erase(std::remove_if(_indices.begin(), _indices.end(), outside),
+                 _indices.end());
+}
+
+/////////////////////////////////////////////////
+void MeshBoundingVolumeHierarchy::Overlaps(const AxisAlignedBox &_box,
+    std::vector<std::size_t> &_indices) const
+{
+  const auto &d = *this->dataPtr;
+  d.bvh.Overlaps(_box, _indices);
+
+  const Vector3d center = (_box.Min() + _box.Max()) * 0.5;
+  const Vector3d half = (_box.Max() - _box.Min()) * 0.5;
+  auto outside = [&](const std::size_t _t)
+  {
+    const uint32_t *tri = &d.indices[3 * _t];
+    return !TriangleBoxOverlap(center, half, d.vertices[tri[0]],
+        d.vertices[tri[1]], d.vertices[tri[2]]);
+  };
+  _indices.erase(std::remove_if(_indices.begin(), _indices.end(), outside),
+                 _indices.end());
+}
@@ -0,0 +1,404 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "gz/math/MeshBoundingVolumeHierarchy.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+/// \brief Closed mesh of the box [-1, 1]^3, with _n x _n squares on each
+/// face and triangles wound counterclockwise seen from outside.
+void CubeMesh(int _n, std::vector<Vector3d> &_vertices,
+              std::vector<uint32_t> &_indices)
+{
+  _vertices.clear();
+  _indices.clear();
+  std::map<std::array<int, 3>, uint32_t> ids;
+  auto vertex = [&](const std::array<int, 3> &_grid)
+  {
+    auto it = ids.find(_grid);
+    if (it != ids.end())
+      return it->second;
+    uint32_t id = static_cast<uint32_t>(_vertices.size());
+    _vertices.push_back(Vector3d(_grid[0], _grid[1], _grid[2]) * (2.0 / _n) -
+                        Vector3d::One);
+    ids[_grid] = id;
+    return id;
+  };
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    for (int side = 0; side <= _n; side += _n)
+    {
+      const int u = (axis + 1) % 3;
+      const int v = (axis + 2) % 3;
+      for (int i = 0; i < _n; ++i)
+      {
+        for (int j = 0; j < _n; ++j)
+        {
+          std::array<int, 3> corners[4];
+          for (int c = 0; c < 4; ++c)
+          {
+            corners[c][axis] = side;
+            corners[c][u] = i + (c == 1 || c == 2);
+            corners[c][v] = j + (c >= 2);
+          }
+          uint32_t quad[4];
+          for (int c = 0; c < 4; ++c)
+            quad[c] = vertex(corners[c]);
+
+          // (u, v, axis) is right handed, so the corners are
+          // counterclockwise seen from the positive side.
+          if (side == _n)
+            _indices.insert(_indices.end(), {quad[0], quad[1], quad[2],
+                                             quad[0], quad[2], quad[3]});
+          else
+            _indices.insert(_indices.end(), {quad[0], quad[2], quad[1],
+                                             quad[0], quad[3], quad[2]});
+        }
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Signed distance to the box [-1, 1]^3.
+double CubeDistance(const Vector3d &_p)
+{
+  const Vector3d q = _p.Abs() - Vector3d::One;
+  Vector3d outside = q;
+  outside.Max(Vector3d::Zero);
+  return outside.Length() + std::min(q.Max(), 0.0);
+}
+
+/////////////////////////////////////////////////
+/// \brief Distance from a point to a segment.
+double SegmentDistance(const Vector3d &_p, const Vector3d &_a,
+                       const Vector3d &_b)
+{
+  const Vector3d ab = _b - _a;
+  double t = std::clamp((_p - _a).Dot(ab) / ab.SquaredLength(), 0.0, 1.0);
+  return _p.Distance(_a + ab * t);
+}
+
+/////////////////////////////////////////////////
+/// \brief Distance from a point to a triangle, by projection on its plane
+/// and otherwise its sides.
+double TriangleDistance(const Vector3d &_p, const Triangle3d &_tri)
+{
+  const Vector3d n = _tri.Normal();
+  const Vector3d projected = _p - n * n.Dot(_p - _tri[0]);
+  bool inside = true;
+  for (int k = 0; k < 3; ++k)
+  {
+    if ((_tri[(k + 1) % 3] - _tri[k]).Cross(projected - _tri[k]).Dot(n) < 0)
+      inside = false;
+  }
+  if (inside)
+    return _p.Distance(projected);
+  return std::min({SegmentDistance(_p, _tri[0], _tri[1]),
+                   SegmentDistance(_p, _tri[1], _tri[2]),
+                   SegmentDistance(_p, _tri[2], _tri[0])});
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if a triangle intersects a box by clipping it with the
+/// planes of the box.
+bool TriangleInBox(const Triangle3d &_tri, const AxisAlignedBox &_box)
+{
+  std::vector<Vector3d> polygon = {_tri[0], _tri[1], _tri[2]};
+  for (int axis = 0; axis < 3 && !polygon.empty(); ++axis)
+  {
+    for (int side = 0; side < 2 && !polygon.empty(); ++side)
+    {
+      // Signed distance inside of the plane, positive inside.
+      auto inside = [&](const Vector3d &_v)
+      {
+        return side == 0 ? _v[axis] - _box.Min()[axis] :
+                           _box.Max()[axis] - _v[axis];
+      };
+      std::vector<Vector3d> clipped;
+      for (std::size_t i = 0; i < polygon.size(); ++i)
+      {
+        const Vector3d &a = polygon[i];
+        const Vector3d &b = polygon[(i + 1) % polygon.size()];
+        const double da = inside(a);
+        const double db = inside(b);
+        if (da >= 0)
+          clipped.push_back(a);
+        if ((da >= 0) != (db >= 0))
+          clipped.push_back(a + (b - a) * (da / (da - db)));
+      }
+      polygon = clipped;
+    }
+  }
+  return !polygon.empty();
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBoundingVolumeHierarchyTest, Empty)
+{
+  MeshBoundingVolumeHierarchy bvh;
+  EXPECT_TRUE(bvh.Empty());
+  EXPECT_EQ(0u, bvh.TriangleCount());
+  EXPECT_EQ(AxisAlignedBox(), bvh.Bounds());
+  EXPECT_TRUE(std::isnan(bvh.SignedDistance(Vector3d::Zero)));
+
+  auto hit = bvh.ClosestHit(Vector3d::Zero, Vector3d::UnitX, 0, 100);
+  EXPECT_FALSE(std::get<0>(hit));
+  EXPECT_EQ(MeshBoundingVolumeHierarchy::kNoTriangle, std::get<2>(hit));
+
+  Vector3d closest;
+  std::size_t triangle;
+  EXPECT_FALSE(bvh.ClosestPoint(Vector3d::Zero, closest, triangle));
+
+  std::vector<std::size_t> indices = {1, 2};
+  bvh.Overlaps(Vector3d::Zero, 10, indices);
+  EXPECT_TRUE(indices.empty());
+  indices.push_back(1);
+  bvh.Overlaps(AxisAlignedBox(-Vector3d::One, Vector3d::One), indices);
+  EXPECT_TRUE(indices.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBoundingVolumeHierarchyTest, InvalidIndices)
+{
+  std::vector<Vector3d> vertices;
+  std::vector<uint32_t> indices;
+  CubeMesh(2, vertices, indices);
+
+  MeshBoundingVolumeHierarchy bvh(vertices, indices);
+  EXPECT_FALSE(bvh.Empty());
+
+  // Not a multiple of three
+  std::vector<uint32_t> bad = indices;
+  bad.pop_back();
+  EXPECT_FALSE(bvh.Build(vertices, bad));
+  EXPECT_TRUE(bvh.Empty());
+  EXPECT_TRUE(bvh.Vertices().empty());
+
+  // Out of range
+  bad = indices;
+  bad[5] = static_cast<uint32_t>(vertices.size());
+  EXPECT_FALSE(bvh.Build(vertices, bad));
+  EXPECT_TRUE(bvh.Empty());
+  EXPECT_TRUE(std::isnan(bvh.SignedDistance(Vector3d::Zero)));
+
+  EXPECT_TRUE(bvh.Build(vertices, indices));
+  EXPECT_EQ(indices.size() / 3, bvh.TriangleCount());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBoundingVolumeHierarchyTest, Cube)
+{
+  std::vector<Vector3d> vertices;
+  std::vector<uint32_t> indices;
+  CubeMesh(4, vertices, indices);
+  const std::size_t count = indices.size() / 3;
+  ASSERT_EQ(6u * 4 * 4 * 2, count);
+
+  MeshBoundingVolumeHierarchy bvh(vertices, indices);
+  EXPECT_EQ(count, bvh.TriangleCount());
+  EXPECT_EQ(vertices, bvh.Vertices());
+  EXPECT_EQ(indices, bvh.Indices());
+  EXPECT_EQ(AxisAlignedBox(-Vector3d::One, Vector3d::One), bvh.Bounds());
+  EXPECT_EQ(vertices[indices[3]], bvh.Triangle(1)[0]);
+  EXPECT_EQ(vertices[indices[4]], bvh.Triangle(1)[1]);
+  EXPECT_EQ(vertices[indices[5]], bvh.Triangle(1)[2]);
+
+  // Triangles face outward.
+  for (std::size_t t = 0; t < count; ++t)
+  {
+    Triangle3d tri = bvh.Triangle(t);
+    Vector3d center = (tri[0] + tri[1] + tri[2]) / 3;
+    EXPECT_GT(tri.Normal().Dot(center), 0) << t;
+  }
+
+  // Points on the faces, edges and corners, and points inside and outside.
+  std::vector<Vector3d> points = {Vector3d::Zero, Vector3d(0.9, 0.1, 0),
+      Vector3d(2, 0, 0), Vector3d(2, 2, 0), Vector3d(2, 2, 2),
+      Vector3d(-1.5, 1.5, 0.5), Vector3d(0.9, 0.95, 0.8),
+      Vector3d(1, 0.3, 0.2), Vector3d(0.25, -0.25, 0.75)};
+  for (int i = 0; i < 500; ++i)
+  {
+    points.push_back(Vector3d(Rand::DblUniform(-3, 3),
+                              Rand::DblUniform(-3, 3),
+                              Rand::DblUniform(-3, 3)));
+  }
+  for (int i = 0; i < 200; ++i)
+  {
+    points.push_back(Vector3d(Rand::DblUniform(-1, 1),
+                              Rand::DblUniform(-1, 1),
+                              Rand::DblUniform(-1, 1)));
+  }
+
+  for (const Vector3d &p : points)
+  {
+    const double expected = CubeDistance(p);
+    EXPECT_NEAR(expected, bvh.SignedDistance(p), 1e-9) << p;
+
+    Vector3d closest;
+    std::size_t triangle;
+    ASSERT_TRUE(bvh.ClosestPoint(p, closest, triangle)) << p;
+    EXPECT_NEAR(std::abs(expected), p.Distance(closest), 1e-9) << p;
+    ASSERT_LT(triangle, count);
+    EXPECT_NEAR(std::abs(expected),
+                TriangleDistance(p, bvh.Triangle(triangle)), 1e-9) << p;
+
+    // A maximum distance below the distance finds nothing.
+    if (std::abs(expected) > 1e-6)
+    {
+      EXPECT_FALSE(bvh.ClosestPoint(p, closest, triangle,
+                                    std::abs(expected) * 0.99)) << p;
+    }
+  }
+
+  // Batch signed distances match single queries.
+  std::vector<double> distances(points.size());
+  bvh.SignedDistances(points.data(), points.size(), distances.data(), 0);
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_DOUBLE_EQ(bvh.SignedDistance(points[i]), distances[i]);
+
+  // Rays match brute force.
+  for (int i = 0; i < 300; ++i)
+  {
+    Vector3d origin(Rand::DblUniform(-3, 3), Rand::DblUniform(-3, 3),
+                    Rand::DblUniform(-3, 3));
+    Vector3d dir(Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1),
+                 Rand::DblUniform(-1, 1));
+    if (i % 3 == 0)
+      dir = Vector3d(Rand::DblUniform(-0.5, 0.5), 0, 0) - origin;
+
+    std::size_t expectedTriangle;
+    double expectedDist;
+    bool expectedHit = Triangle3d::ClosestHit(vertices.data(),
+        indices.data(), count, origin, dir, 0.1, 10.0, expectedTriangle,
+        expectedDist);
+
+    auto hit = bvh.ClosestHit(origin, dir, 0.1, 10.0);
+    ASSERT_EQ(expectedHit, std::get<0>(hit)) << origin << " " << dir;
+    if (expectedHit)
+    {
+      EXPECT_NEAR(expectedDist, std::get<1>(hit), 1e-9);
+      EXPECT_EQ(expectedTriangle, std::get<2>(hit));
+    }
+  }
+
+  // Sphere and box overlaps match brute force.
+  std::vector<std::size_t> result;
+  for (int i = 0; i < 200; ++i)
+  {
+    Vector3d center(Rand::DblUniform(-2, 2), Rand::DblUniform(-2, 2),
+                    Rand::DblUniform(-2, 2));
+    double radius = Rand::DblUniform(0, 1.5);
+
+    std::vector<std::size_t> expected;
+    for (std::size_t t = 0; t < count; ++t)
+    {
+      if (TriangleDistance(center, bvh.Triangle(t)) <= radius)
+        expected.push_back(t);
+    }
+    bvh.Overlaps(center, radius, result);
+    std::sort(result.begin(), result.end());
+    EXPECT_EQ(expected, result);
+
+    Vector3d size(Rand::DblUniform(0, 1.5), Rand::DblUniform(0, 1.5),
+                  Rand::DblUniform(0, 1.5));
+    AxisAlignedBox box(center - size * 0.5, center + size * 0.5);
+    expected.clear();
+    for (std::size_t t = 0; t < count; ++t)
+    {
+      if (TriangleInBox(bvh.Triangle(t), box))
+        expected.push_back(t);
+    }
+    bvh.Overlaps(box, result);
+    std::sort(result.begin(), result.end());
+    EXPECT_EQ(expected, result);
+  }
+
+  // A box inside of the cube overlaps no triangle even though it overlaps
+  // their bounds.
+  bvh.Overlaps(AxisAlignedBox(Vector3d(-0.9, -0.9, -0.9),
+                              Vector3d(0.9, 0.9, 0.9)), result);
+  EXPECT_TRUE(result.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBoundingVolumeHierarchyTest, Copy)
+{
+  std::vector<Vector3d> vertices;
+  std::vector<uint32_t> indices;
+  CubeMesh(3, vertices, indices);
+
+  MeshBoundingVolumeHierarchy bvh(vertices, indices);
+  MeshBoundingVolumeHierarchy copy(bvh);
+  MeshBoundingVolumeHierarchy assigned;
+  assigned = bvh;
+
+  // The copies do not change with the original.
+  bvh.Build({}, {});
+  EXPECT_TRUE(bvh.Empty());
+
+  for (const auto *other : {&copy, &assigned})
+  {
+    EXPECT_EQ(indices.size() / 3, other->TriangleCount());
+    EXPECT_NEAR(-1, other->SignedDistance(Vector3d::Zero), 1e-12);
+    EXPECT_NEAR(1, other->SignedDistance(Vector3d(2, 0, 0)), 1e-12);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBoundingVolumeHierarchyTest, ThreadedBuild)
+{
+  std::vector<Vector3d> vertices;
+  std::vector<uint32_t> indices;
+  CubeMesh(60, vertices, indices);
+
+  MeshBoundingVolumeHierarchy serial(vertices, indices);
+  MeshBoundingVolumeHierarchy threaded(vertices, indices, 4);
+  EXPECT_EQ(serial.TriangleCount(), threaded.TriangleCount());
+  EXPECT_EQ(serial.Bounds(), threaded.Bounds());
+
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 3000; ++i)
+  {
+    points.push_back(Vector3d(Rand::DblUniform(-2, 2),
+                              Rand::DblUniform(-2, 2),
+                              Rand::DblUniform(-2, 2)));
+  }
+  std::vector<double> serialDistances(points.size());
+  std::vector<double> threadedDistances(points.size());
+  serial.SignedDistances(points.data(), points.size(),
+                         serialDistances.data());
+  threaded.SignedDistances(points.data(), points.size(),
+                           threadedDistances.data(), 4);
+  EXPECT_EQ(serialDistances, threadedDistances);
+
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_NEAR(CubeDistance(points[i]), threadedDistances[i], 1e-9);
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gz/math/Executor.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/MassMatrix3.hh"
+#include "gz/math/MeshMassProperties.hh"
+#include "gz/math/Pose3.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Vertices of a box of the given size, transformed by a pose.
+std::vector<math::Vector3d> BoxVertices(const math::Vector3d &_size,
+    const math::Pose3d &_pose)
+{
+  std::vector<math::Vector3d> vertices;
+  for (int i = 0; i < 8; ++i)
+  {
+    math::Vector3d v(i & 1 ? 0.5 : -0.5, i & 2 ? 0.5 : -0.5,
+                     i & 4 ? 0.5 : -0.5);
+    vertices.push_back(_pose.CoordPositionAdd(v * _size));
+  }
+  return vertices;
+}
+
+/////////////////////////////////////////////////
+/// \brief Indices of the 12 triangles of the box from BoxVertices, wound
+/// counter-clockwise when seen from outside.
+const std::vector<std::uint32_t> kBoxIndices = {
+  0, 2, 1,  1, 2, 3,  4, 5, 6,  5, 7, 6,
+  0, 1, 4,  1, 5, 4,  2, 6, 3,  3, 6, 7,
+  0, 4, 2,  2, 4, 6,  1, 3, 5,  3, 7, 5};
+
+/////////////////////////////////////////////////
+TEST(MeshMassPropertiesTest, Empty)
+{
+  math::MeshMassPropertiesd props;
+  EXPECT_DOUBLE_EQ(0.0, props.Volume());
+  EXPECT_EQ(math::Vector3d::Zero, props.CenterOfMass());
+
+  math::MassMatrix3d massMat(1.0, math::Vector3d::One, math::Vector3d::Zero);
+  EXPECT_FALSE(props.MassMatrix(1000.0, massMat));
+  EXPECT_DOUBLE_EQ(1.0, massMat.Mass());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshMassPropertiesTest, Box)
+{
+  const math::Vector3d size(1.0, 2.0, 3.0);
+  const math::Pose3d pose(1, -2, 3, 0.1, 0.2, 0.3);
+  const double density = 500.0;
+  const auto vertices = BoxVertices(size, pose);
+
+  math::MeshMassPropertiesd props;
+  props.AddTriangles(vertices.data(), kBoxIndices.data(),
+                     kBoxIndices.size() / 3);
+  EXPECT_DOUBLE_EQ(6.0, props.Volume());
+  EXPECT_EQ(pose.Pos(), props.CenterOfMass());
+
+  math::MassMatrix3d expected;
+  ASSERT_TRUE(expected.SetFromBox(density * 6.0, size, pose.Rot()));
+  math::MassMatrix3d massMat;
+  ASSERT_TRUE(props.MassMatrix(density, massMat));
+  EXPECT_DOUBLE_EQ(expected.Mass(), massMat.Mass());
+  EXPECT_EQ(expected, massMat);
+  EXPECT_TRUE(massMat.IsValid());
+
+  math::MassMatrix3d massMatFromMaterial;
+  ASSERT_TRUE(props.MassMatrix(math::Material(density),
+                               massMatFromMaterial));
+  EXPECT_EQ(massMat, massMatFromMaterial);
+  EXPECT_FALSE(props.MassMatrix(0.0, massMat));
+
+  // Single triangles give the same result
+  math::MeshMassPropertiesd single;
+  for (std::size_t i = 0; i < kBoxIndices.size(); i += 3)
+  {
+    if (i % 2)
+    {
+      single.AddTriangle(vertices[kBoxIndices[i]],
+                         vertices[kBoxIndices[i + 1]],
+                         vertices[kBoxIndices[i + 2]]);
+    }
+    else
+    {
+      single.AddTriangle(math::Triangle3d(vertices[kBoxIndices[i]],
+                                          vertices[kBoxIndices[i + 1]],
+                                          vertices[kBoxIndices[i + 2]]));
+    }
+  }
+  EXPECT_DOUBLE_EQ(props.Volume(), single.Volume());
+  ASSERT_TRUE(single.MassMatrix(density, massMat));
+  EXPECT_EQ(expected, massMat);
+
+  // Reversed winding gives the same result
+  std::vector<std::uint32_t> reversed(kBoxIndices.rbegin(),
+                                      kBoxIndices.rend());
+  math::MeshMassPropertiesd inverted;
+  inverted.AddTriangles(vertices.data(), reversed.data(),
+                        reversed.size() / 3);
+  EXPECT_DOUBLE_EQ(6.0, inverted.Volume());
+  EXPECT_EQ(pose.Pos(), inverted.CenterOfMass());
+  ASSERT_TRUE(inverted.MassMatrix(density, massMat));
+  EXPECT_EQ(expected, massMat);
+
+  inverted.Reset();
+  EXPECT_DOUBLE_EQ(0.0, inverted.Volume());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshMassPropertiesTest, Merge)
+{
+  const auto vertices = BoxVertices(math::Vector3d(1, 1, 2),
+                                    math::Pose3d(0.5, 0, 0, 0, 0, 0.4));
+
+  // Split the triangles of the box into two open parts
+  math::MeshMassPropertiesd all;
+  all.AddTriangles(vertices.data(), kBoxIndices.data(), 12);
+  math::MeshMassPropertiesd part1;
+  part1.AddTriangles(vertices.data(), kBoxIndices.data(), 5);
+  math::MeshMassPropertiesd part2;
+  part2.AddTriangles(vertices.data(), kBoxIndices.data() + 15, 7);
+
+  part1.Merge(part2);
+  EXPECT_DOUBLE_EQ(all.Volume(), part1.Volume());
+  EXPECT_EQ(all.CenterOfMass(), part1.CenterOfMass());
+
+  math::MassMatrix3d expected;
+  math::MassMatrix3d merged;
+  ASSERT_TRUE(all.MassMatrix(1.0, expected));
+  ASSERT_TRUE(part1.MassMatrix(1.0, merged));
+  EXPECT_EQ(expected, merged);
+}
+
+/////////////////////////////////////////////////
+TEST(MeshMassPropertiesTest, SphereThreads)
+{
+  // UV sphere with enough triangles to use several threads
+  const double radius = 0.5;
+  const math::Vector3d center(0.1, 0.2, -0.3);
+  const std::size_t rings = 200;
+  const std::size_t segments = 400;
+  std::vector<math::Vector3d> vertices;
+  for (std::size_t r = 0; r <= rings; ++r)
+  {
+    const double theta = IGN_PI * r / rings;
+    for (std::size_t s = 0; s < segments; ++s)
+    {
+      const double phi = 2 * IGN_PI * s / segments;
+      vertices.push_back(center + radius * math::Vector3d(
+          std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+          std::cos(theta)));
+    }
+  }
+  std::vector<std::uint32_t> indices;
+  for (std::uint32_t r = 0; r < rings; ++r)
+  {
+    for (std::uint32_t s = 0; s < segments; ++s)
+    {
+      const std::uint32_t s1 = (s + 1) % segments;
+      const std::uint32_t a = r * segments + s;
+      const std::uint32_t b = r * segments + s1;
+      const std::uint32_t c = (r + 1) * segments + s;
+      const std::uint32_t d = (r + 1) * segments + s1;
+      indices.insert(indices.end(), {a, c, b, b, c, d});
+    }
+  }
+  const std::size_t triangleCount = indices.size() / 3;
+
+  math::MeshMassPropertiesd serial;
+  serial.AddTriangles(vertices.data(), indices.data(), triangleCount);
+  math::MeshMassPropertiesd parallel;
+  parallel.AddTriangles(vertices.data(), indices.data(), triangleCount, 4);
+  math::MeshMassPropertiesd hardware;
+  hardware.AddTriangles(vertices.data(), indices.data(), triangleCount, 0);
+  math::ThreadPool pool(4);
+  math::MeshMassPropertiesd pooled;
+  pooled.AddTriangles(vertices.data(), indices.data(), triangleCount, pool);
+
+  EXPECT_NEAR(serial.Volume(), parallel.Volume(), 1e-12);
+  EXPECT_NEAR(serial.Volume(), hardware.Volume(), 1e-12);
+  EXPECT_NEAR(serial.Volume(), pooled.Volume(), 1e-12);
+  EXPECT_EQ(serial.CenterOfMass(), parallel.CenterOfMass());
+
+  // Close to a solid sphere
+  const double volume = 4.0 / 3.0 * IGN_PI * std::pow(radius, 3);
+  EXPECT_NEAR(volume, serial.Volume(), 1e-3 * volume);
+  EXPECT_EQ(center, serial.CenterOfMass());
+
+  math::MassMatrix3d expected;
+  ASSERT_TRUE(expected.SetFromSphere(volume, radius));
+  math::MassMatrix3d serialMassMat;
+  math::MassMatrix3d parallelMassMat;
+  ASSERT_TRUE(serial.MassMatrix(1.0, serialMassMat));
+  ASSERT_TRUE(parallel.MassMatrix(1.0, parallelMassMat));
+  EXPECT_EQ(serialMassMat, parallelMassMat);
+  EXPECT_TRUE(serialMassMat.DiagonalMoments().Equal(
+      expected.DiagonalMoments(), 1e-3 * expected.DiagonalMoments().X()));
+  EXPECT_TRUE(serialMassMat.OffDiagonalMoments().Equal(
+      math::Vector3d::Zero, 1e-9));
+}
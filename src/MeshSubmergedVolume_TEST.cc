@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gz/math/Box.hh"
+#include "gz/math/Executor.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/MeshSubmergedVolume.hh"
+#include "gz/math/Pose3.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Vertices of a box of the given size, transformed by a pose.
+std::vector<math::Vector3d> BoxVertices(const math::Vector3d &_size,
+    const math::Pose3d &_pose)
+{
+  std::vector<math::Vector3d> vertices;
+  for (int i = 0; i < 8; ++i)
+  {
+    math::Vector3d v(i & 1 ? 0.5 : -0.5, i & 2 ? 0.5 : -0.5,
+                     i & 4 ? 0.5 : -0.5);
+    vertices.push_back(_pose.CoordPositionAdd(v * _size));
+  }
+  return vertices;
+}
+
+/////////////////////////////////////////////////
+/// \brief Indices of the 12 triangles of the box from BoxVertices, wound
+/// counter-clockwise when seen from outside.
+const std::vector<std::uint32_t> kBoxIndices = {
+  0, 2, 1,  1, 2, 3,  4, 5, 6,  5, 7, 6,
+  0, 1, 4,  1, 5, 4,  2, 6, 3,  3, 6, 7,
+  0, 4, 2,  2, 4, 6,  1, 3, 5,  3, 7, 5};
+
+/////////////////////////////////////////////////
+TEST(MeshSubmergedVolumeTest, Empty)
+{
+  math::MeshSubmergedVolumed submerged;
+  EXPECT_EQ(math::Vector3d::UnitZ, submerged.ClipPlane().Normal());
+  EXPECT_DOUBLE_EQ(0.0, submerged.ClipPlane().Offset());
+  EXPECT_DOUBLE_EQ(0.0, submerged.Volume());
+  EXPECT_DOUBLE_EQ(0.0, submerged.WettedArea());
+  EXPECT_FALSE(submerged.CenterOfVolume().has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshSubmergedVolumeTest, HalfBox)
+{
+  // Box of 1 x 2 x 3 centered on the water plane z = 0
+  const math::Vector3d size(1.0, 2.0, 3.0);
+  const auto vertices = BoxVertices(size, math::Pose3d::Zero);
+
+  math::MeshSubmergedVolumed submerged;
+  submerged.AddTriangles(vertices.data(), kBoxIndices.data(),
+                         kBoxIndices.size() / 3);
+  EXPECT_DOUBLE_EQ(3.0, submerged.Volume());
+  ASSERT_TRUE(submerged.CenterOfVolume().has_value());
+  EXPECT_EQ(math::Vector3d(0, 0, -0.75), *submerged.CenterOfVolume());
+
+  // Bottom face and the lower halves of the sides
+  EXPECT_DOUBLE_EQ(2.0 + 2 * 1.5 + 2 * 3.0, submerged.WettedArea());
+
+  // Flipping the normal keeps the upper half
+  submerged.SetPlane(math::Planed(-math::Vector3d::UnitZ, -1.0));
+  EXPECT_DOUBLE_EQ(0.0, submerged.Volume());
+  submerged.AddTriangles(vertices.data(), kBoxIndices.data(),
+                         kBoxIndices.size() / 3);
+  EXPECT_DOUBLE_EQ(1.0, submerged.Volume());
+  EXPECT_EQ(math::Vector3d(0, 0, 1.25), *submerged.CenterOfVolume());
+  EXPECT_DOUBLE_EQ(2.0 + 2 * 0.5 + 2 * 1.0, submerged.WettedArea());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshSubmergedVolumeTest, AboveAndBelow)
+{
+  const math::Vector3d size(1.0, 2.0, 3.0);
+  const math::Pose3d pose(0.5, -1, 0, 0.1, 0.2, 0.3);
+  const auto vertices = BoxVertices(size, pose);
+  const double area = 2 * (1.0 * 2.0 + 1.0 * 3.0 + 2.0 * 3.0);
+
+  // Entirely above the plane
+  math::MeshSubmergedVolumed above(math::Planed(math::Vector3d::UnitZ, -5));
+  above.AddTriangles(vertices.data(), kBoxIndices.data(),
+                     kBoxIndices.size() / 3);
+  EXPECT_DOUBLE_EQ(0.0, above.Volume());
+  EXPECT_DOUBLE_EQ(0.0, above.WettedArea());
+  EXPECT_FALSE(above.CenterOfVolume().has_value());
+
+  // Entirely below the plane
+  math::MeshSubmergedVolumed below(math::Planed(math::Vector3d::UnitZ, 5));
+  below.AddTriangles(vertices.data(), kBoxIndices.data(),
+                     kBoxIndices.size() / 3);
+  EXPECT_NEAR(6.0, below.Volume(), 1e-12);
+  EXPECT_NEAR(area, below.WettedArea(), 1e-12);
+  ASSERT_TRUE(below.CenterOfVolume().has_value());
+  EXPECT_EQ(pose.Pos(), *below.CenterOfVolume());
+
+  // Reset keeps the plane
+  below.Reset();
+  EXPECT_DOUBLE_EQ(0.0, below.Volume());
+  EXPECT_DOUBLE_EQ(5.0, below.ClipPlane().Offset());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshSubmergedVolumeTest, TiltedBox)
+{
+  // Compare with the exact clipping of boxes, for tilted boxes and planes
+  const math::Vector3d size(1.0, 2.0, 3.0);
+  const std::vector<math::Pose3d> poses = {
+    {0, 0, 0, 0.3, -0.2, 0.5},
+    {0.2, 0.1, 0.7, 1.0, 0.5, -0.3},
+    {-3, 4, -1.2, 0.0, 0.8, 0.0}};
+  const std::vector<math::Planed> planes = {
+    math::Planed(math::Vector3d::UnitZ, 0.0),
+    math::Planed(math::Vector3d(0.2, -0.3, 1.0), 0.4),
+    math::Planed(math::Vector3d(1.0, 1.0, 2.0), -0.5)};
+
+  for (const auto &plane : planes)
+  {
+    for (const auto &pose : poses)
+    {
+      double volume;
+      math::Vector3d center;
+      math::Boxd::VolumesBelow(&size, &pose, 1, plane, &volume, &center);
+
+      const auto vertices = BoxVertices(size, pose);
+      math::MeshSubmergedVolumed submerged(plane);
+      submerged.AddTriangles(vertices.data(), kBoxIndices.data(),
+                             kBoxIndices.size() / 3);
+      EXPECT_NEAR(volume, submerged.Volume(), 1e-12);
+      if (volume > 0)
+      {
+        ASSERT_TRUE(submerged.CenterOfVolume().has_value());
+        EXPECT_EQ(center, *submerged.CenterOfVolume());
+      }
+
+      // Both windings give the same result
+      math::MeshSubmergedVolumed clockwise(plane);
+      for (std::size_t i = 0; i < kBoxIndices.size(); i += 3)
+      {
+        clockwise.AddTriangle(math::Triangle3d(vertices[kBoxIndices[i]],
+            vertices[kBoxIndices[i + 2]], vertices[kBoxIndices[i + 1]]));
+      }
+      EXPECT_NEAR(submerged.Volume(), clockwise.Volume(), 1e-12);
+      EXPECT_NEAR(submerged.WettedArea(), clockwise.WettedArea(), 1e-12);
+      if (volume > 0)
+      {
+        EXPECT_EQ(*submerged.CenterOfVolume(), *clockwise.CenterOfVolume());
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MeshSubmergedVolumeTest, SphereThreads)
+{
+  // UV sphere with enough triangles to use several threads, half
+  // submerged
+  const double radius = 0.5;
+  const math::Vector3d center(0.1, 0.2, -0.3);
+  const std::size_t rings = 200;
+  const std::size_t segments = 400;
+  std::vector<math::Vector3d> vertices;
+  for (std::size_t r = 0; r <= rings; ++r)
+  {
+    const double theta = IGN_PI * r / rings;
+    for (std::size_t s = 0; s < segments; ++s)
+    {
+      const double phi = 2 * IGN_PI * s / segments;
+      vertices.push_back(center + radius * math::Vector3d(
+          std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+          std::cos(theta)));
+    }
+  }
+  std::vector<std::uint32_t> indices;
+  for (std::uint32_t r = 0; r < rings; ++r)
+  {
+    for (std::uint32_t s = 0; s < segments; ++s)
+    {
+      const std::uint32_t s1 = (s + 1) % segments;
+      const std::uint32_t a = r * segments + s;
+      const std::uint32_t b = r * segments + s1;
+      const std::uint32_t c = (r + 1) * segments + s;
+      const std::uint32_t d = (r + 1) * segments + s1;
+      indices.insert(indices.end(), {a, c, b, b, c, d});
+    }
+  }
+  const std::size_t triangleCount = indices.size() / 3;
+  const math::Planed plane(math::Vector3d(0, 0, 2), 2 * center.Z());
+
+  math::MeshSubmergedVolumed serial(plane);
+  serial.AddTriangles(vertices.data(), indices.data(), triangleCount);
+  math::MeshSubmergedVolumed parallel(plane);
+  parallel.AddTriangles(vertices.data(), indices.data(), triangleCount, 4);
+  math::MeshSubmergedVolumed hardware(plane);
+  hardware.AddTriangles(vertices.data(), indices.data(), triangleCount, 0);
+  math::ThreadPool pool(4);
+  math::MeshSubmergedVolumed pooled(plane);
+  pooled.AddTriangles(vertices.data(), indices.data(), triangleCount, pool);
+
+  EXPECT_NEAR(serial.Volume(), parallel.Volume(), 1e-12);
+  EXPECT_NEAR(serial.Volume(), hardware.Volume(), 1e-12);
+  EXPECT_NEAR(serial.Volume(), pooled.Volume(), 1e-12);
+  EXPECT_NEAR(serial.WettedArea(), pooled.WettedArea(), 1e-12);
+  EXPECT_EQ(*serial.CenterOfVolume(), *parallel.CenterOfVolume());
+  EXPECT_EQ(*serial.CenterOfVolume(), *pooled.CenterOfVolume());
+
+  // Close to a solid half sphere, with its centroid 3/8 of the radius
+  // below the plane
+  const double volume = 2.0 / 3.0 * IGN_PI * std::pow(radius, 3);
+  EXPECT_NEAR(volume, serial.Volume(), 1e-3 * volume);
+  const double area = 2 * IGN_PI * radius * radius;
+  EXPECT_NEAR(area, serial.WettedArea(), 1e-3 * area);
+  const math::Vector3d centroid = *serial.CenterOfVolume();
+  EXPECT_NEAR(center.X(), centroid.X(), 1e-9);
+  EXPECT_NEAR(center.Y(), centroid.Y(), 1e-9);
+  EXPECT_NEAR(center.Z() - 3.0 / 8.0 * radius, centroid.Z(), 1e-3);
+
+  // Merged halves of the mesh match the whole
+  math::MeshSubmergedVolumed first(plane);
+  first.AddTriangles(vertices.data(), indices.data(), triangleCount / 2);
+  math::MeshSubmergedVolumed second(plane);
+  const std::size_t half = triangleCount / 2;
+  second.AddTriangles(vertices.data(), indices.data() + 3 * half,
+                      triangleCount - half);
+  first.Merge(second);
+  EXPECT_NEAR(serial.Volume(), first.Volume(), 1e-12);
+  EXPECT_EQ(*serial.CenterOfVolume(), *first.CenterOfVolume());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshSubmergedVolumeTest, Float)
+{
+  const auto vertices = BoxVertices(math::Vector3d(1, 2, 3),
+                                    math::Pose3d::Zero);
+  std::vector<math::Vector3f> verticesf;
+  for (const auto &v : vertices)
+    verticesf.emplace_back(v.X(), v.Y(), v.Z());
+
+  math::MeshSubmergedVolumef submerged(
+      math::Planef(math::Vector3f::UnitZ, 0.5f));
+  submerged.AddTriangles(verticesf.data(), kBoxIndices.data(),
+                         kBoxIndices.size() / 3);
+  EXPECT_FLOAT_EQ(4.0f, submerged.Volume());
+  EXPECT_NEAR(-0.5f, submerged.CenterOfVolume()->Z(), 1e-6);
+}
@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+
+#include <cmath>
+
 #include "gz/math/Vector3.hh"
 #include "gz/math/MovingWindowFilter.hh"
 
@@ -69,6 +72,78 @@ TEST(MovingWindowFilterTest, FilterSomething)
   EXPECT_EQ(vectorMWF.Value(), vsum / 20.0);
 }
 
+/////////////////////////////////////////////////
+TEST(MovingWindowFilterTest, FixedWindow)
+{
+  math::FixedMovingWindowFilter<double, 10> doubleMWF;
+  math::FixedMovingWindowFilter<int, 3> intMWF;
+  math::FixedMovingWindowFilter<math::Vector3d, 40> vectorMWF;
+  static_assert(decltype(doubleMWF)::WindowSize() == 10u,
+      "WindowSize must be constexpr");
+  EXPECT_FALSE(doubleMWF.WindowFilled());
+  EXPECT_EQ(0u, doubleMWF.Samples());
+
+  // Same results as the dynamic filter
+  math::MovingWindowFilter<double> reference;
+  reference.SetWindowSize(10);
+  for (unsigned int i = 0; i < 20; ++i)
+  {
+    doubleMWF.Update(static_cast<double>(i));
+    reference.Update(static_cast<double>(i));
+    intMWF.Update(static_cast<int>(i));
+    vectorMWF.Update(math::Vector3d(1.0, 2.0, 3.0) * i);
+    EXPECT_DOUBLE_EQ(reference.Value(), doubleMWF.Value());
+    EXPECT_EQ(reference.WindowFilled(), doubleMWF.WindowFilled());
+  }
+  EXPECT_TRUE(doubleMWF.WindowFilled());
+  EXPECT_EQ(10u, doubleMWF.Samples());
+  EXPECT_DOUBLE_EQ(14.5, doubleMWF.Value());
+  EXPECT_EQ(18, intMWF.Value());
+  EXPECT_FALSE(vectorMWF.WindowFilled());
+  EXPECT_EQ(math::Vector3d(9.5, 19.0, 28.5), vectorMWF.Value());
+
+  doubleMWF.Reset();
+  EXPECT_FALSE(doubleMWF.WindowFilled());
+  doubleMWF.Update(3.0);
+  EXPECT_DOUBLE_EQ(3.0, doubleMWF.Value());
+}
+
+/////////////////////////////////////////////////
+TEST(MovingWindowFilterTest, NoDrift)
+{
+  // A large offset with small variations loses precision in a naive
+  // running sum, which then drifts away from the window mean.
+  math::FixedMovingWindowFilter<double, 7> fixedMWF;
+  math::MovingWindowFilter<double> dynamicMWF;
+  dynamicMWF.SetWindowSize(7);
+
+  auto value = [](unsigned int _i)
+  {
+    return 1e8 + 0.1 * static_cast<double>(_i % 13) + 1e-3 * (_i % 5);
+  };
+
+  const unsigned int count = 1000000;
+  double naiveSum = 0;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    fixedMWF.Update(value(i));
+    dynamicMWF.Update(value(i));
+    naiveSum += value(i);
+    if (i >= 7)
+      naiveSum -= value(i - 7);
+  }
+
+  double exact = 0;
+  for (unsigned int i = count - 7; i < count; ++i)
+    exact += value(i) - 1e8;
+  exact = 1e8 + exact / 7.0;
+
+  EXPECT_NEAR(exact, fixedMWF.Value(), 1e-7);
+  EXPECT_NEAR(exact, dynamicMWF.Value(), 1e-7);
+  // Check that the case would drift without compensation
+  EXPECT_GT(std::abs(exact - naiveSum / 7.0), 1e-6);
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gz/math/NormalEstimator.hh"
+#include "gz/math/Trace.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Private data for NormalEstimator.
+class gz::math::NormalEstimatorPrivate
+{
+  /// \brief Number of nearest neighbors of each point.
+  public: std::size_t neighbors = 10;
+
+  /// \brief Maximum distance from a point to its neighbors.
+  public: double radius = std::numeric_limits<double>::infinity();
+
+  /// \brief Point the normals are flipped towards, if hasViewpoint.
+  public: Vector3d viewpoint = Vector3d::Zero;
+
+  /// \brief True if the normals are flipped towards the viewpoint.
+  public: bool hasViewpoint = false;
+
+  /// \brief Number of threads, 0 for hardware threads.
+  public: unsigned int threadCount = 1;
+
+  /// \brief Executor used instead of threadCount threads, if set.
+  public: std::shared_ptr<Executor> executor;
+};
+
+namespace
+{
+  /// \brief Minimum number of points processed by each block.
+  const std::size_t kMinPointsPerBlock = 1024;
+
+  /// \brief Number of points whose covariances are diagonalized together.
+  const std::size_t kChunk = 256;
+
+  //////////////////////////////////////////////////
+  /// \brief Get the executor running the blocks of points, and the number
+  /// of blocks. Without an executor set by the user, each thread
+  /// processes a single block.
+  /// \param[in] _data Estimator data.
+  /// \param[in] _count Number of points.
+  /// \param[out] _local Thread pool created for the call, if any.
+  /// \param[out] _blocks Number of blocks.
+  /// \return The executor.
+  Executor &BlockExecutor(const NormalEstimatorPrivate &_data,
+      const std::size_t _count, std::unique_ptr<Executor> &_local,
+      std::size_t &_blocks)
+  {
+    static SerialExecutor serial;
+
+    if (_data.executor)
+    {
+      _blocks = _data.executor->BlockCount(_count, kMinPointsPerBlock);
+      return *_data.executor;
+    }
+
+    std::size_t threads = _data.threadCount;
+    if (threads == 0)
+      threads = std::thread::hardware_concurrency();
+    _blocks = std::max<std::size_t>(1,
+        std::min(threads, _count / kMinPointsPerBlock));
+    if (_blocks <= 1)
+      return serial;
+    _local.reset(new ThreadPool(static_cast<unsigned int>(_blocks)));
+    return *_local;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Compute the covariances of the neighbors of a range of points.
+  /// \param[in] _data Estimator data.
+  /// \param[in] _points The points.
+  /// \param[in] _tree Tree over the points.
+  /// \param[in] _begin First point of the range.
+  /// \param[in] _end One past the last point of the range.
+  /// \param[in,out] _neighbors Scratch vector of neighbor indices.
+  /// \param[out] _covariances Covariance of point i at i - _begin, or
+  /// zero if it has fewer than 3 neighbors.
+  /// \param[out] _valid Whether each point has at least 3 neighbors,
+  /// at i - _begin.
+  void RangeCovariances(const NormalEstimatorPrivate &_data,
+      const Vector3SoAd &_points, const KdTree3d &_tree,
+      const std::size_t _begin, const std::size_t _end,
+      std::vector<std::size_t> &_neighbors, Matrix3SoAd &_covariances,
+      std::vector<char> &_valid)
+  {
+    const double *x = _points.XData();
+    const double *y = _points.YData();
+    const double *z = _points.ZData();
+    double *m00 = _covariances.Data(0, 0), *m01 = _covariances.Data(0, 1),
+           *m02 = _covariances.Data(0, 2), *m10 = _covariances.Data(1, 0),
+           *m11 = _covariances.Data(1, 1), *m12 = _covariances.Data(1, 2),
+           *m20 = _covariances.Data(2, 0), *m21 = _covariances.Data(2, 1),
+           *m22 = _covariances.Data(2, 2);
+    const double radiusSquared = _data.radius * _data.radius;
+
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      const std::size_t j = i - _begin;
+      _tree.Nearest(Vector3d(x[i], y[i], z[i]), _data.neighbors,
+                    _neighbors);
+
+      // Sums of the offsets from the point, which keeps them small
+      double n = 0;
+      double sx = 0, sy = 0, sz = 0;
+      double sxx = 0, sxy = 0, sxz = 0, syy = 0, syz = 0, szz = 0;
+      for (const std::size_t k : _neighbors)
+      {
+        const double dx = x[k] - x[i];
+        const double dy = y[k] - y[i];
+        const double dz = z[k] - z[i];
+        // Neighbors come nearest first
+        if (dx * dx + dy * dy + dz * dz > radiusSquared)
+          break;
+        n += 1;
+        sx += dx;
+        sy += dy;
+        sz += dz;
+        sxx += dx * dx;
+        sxy += dx * dy;
+        sxz += dx * dz;
+        syy += dy * dy;
+        syz += dy * dz;
+        szz += dz * dz;
+      }
+
+      _valid[j] = n >= 3;
+      if (!_valid[j])
+      {
+        m00[j] = m01[j] = m02[j] = m10[j] = m11[j] = m12[j] = 0;
+        m20[j] = m21[j] = m22[j] = 0;
+        continue;
+      }
+      const double inv = 1.0 / n;
+      const double mx = sx * inv;
+      const double my = sy * inv;
+      const double mz = sz * inv;
+      m00[j] = sxx * inv - mx * mx;
+      m01[j] = m10[j] = sxy * inv - mx * my;
+      m02[j] = m20[j] = sxz * inv - mx * mz;
+      m11[j] = syy * inv - my * my;
+      m12[j] = m21[j] = syz * inv - my * mz;
+      m22[j] = szz * inv - mz * mz;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+NormalEstimator::NormalEstimator()
+  : dataPtr(std::make_unique<NormalEstimatorPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+NormalEstimator::NormalEstimator(const NormalEstimator &_other)
+  : dataPtr(std::make_unique<NormalEstimatorPrivate>(*_other.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+NormalEstimator::~NormalEstimator() = default;
+
+/////////////////////////////////////////////////
+NormalEstimator &NormalEstimator::operator=(const NormalEstimator &_other)
+{
+  *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void NormalEstimator::SetNeighbors(const std::size_t _neighbors)
+{
+  this->dataPtr->neighbors = _neighbors;
+}
+
+/////////////////////////////////////////////////
+std::size_t NormalEstimator::Neighbors() const
+{
+  return this->dataPtr->neighbors;
+}
+
+/////////////////////////////////////////////////
+void NormalEstimator::SetRadius(const double _radius)
+{
+  this->dataPtr->radius = _radius;
+}
+
+/////////////////////////////////////////////////
+double NormalEstimator::Radius() const
+{
+  return this->dataPtr->radius;
+}
+
+/////////////////////////////////////////////////
+void NormalEstimator::SetViewpoint(const Vector3d &_viewpoint)
+{
+  this->dataPtr->viewpoint = _viewpoint;
+  this->dataPtr->hasViewpoint = true;
+}
+
+/////////////////////////////////////////////////
+void NormalEstimator::ClearViewpoint()
+{
+  this->dataPtr->hasViewpoint = false;
+}
+
+/////////////////////////////////////////////////
+bool NormalEstimator::HasViewpoint() const
+{
+  return this->dataPtr->hasViewpoint;
+}
+
+/////////////////////////////////////////////////
+const Vector3d &NormalEstimator::Viewpoint() const
+{
+  return this->dataPtr->viewpoint;
+}
+
+/////////////////////////////////////////////////
+void NormalEstimator::SetThreadCount(const unsigned int _threads)
+{
+  this->dataPtr->threadCount = _threads;
+}
+
+/////////////////////////////////////////////////
+unsigned int NormalEstimator::ThreadCount() const
+{
+  return this->dataPtr->threadCount;
+}
+
+/////////////////////////////////////////////////
+void NormalEstimator::SetExecutor(std::shared_ptr<Executor> _executor)
+{
+  this->dataPtr->executor = std::move(_executor);
+}
+
+/////////////////////////////////////////////////
+void NormalEstimator::Estimate(const Vector3SoAd &_points,
+    Vector3SoAd &_normals, std::vector<double> &_curvatures) const
+{
+  const KdTree3d tree(_points.ToVector());
+  this->Estimate(_points, tree, _normals, _curvatures);
+}
+
+/////////////////////////////////////////////////
+void NormalEstimator::Estimate(const Vector3SoAd &_points,
+    const KdTree3d &_tree, Vector3SoAd &_normals,
+    std::vector<double> &_curvatures) const
+{
+  IGN_MATH_TRACE_ZONE("NormalEstimator::Estimate");
+  const NormalEstimatorPrivate &data = *this->dataPtr;
+  const std::size_t count = _points.Size();
+  _normals.Resize(count);
+  _curvatures.resize(count);
+
+  double *nx = _normals.XData();
+  double *ny = _normals.YData();
+  double *nz = _normals.ZData();
+  const double *x = _points.XData();
+  const double *y = _points.YData();
+  const double *z = _points.ZData();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+
+  std::unique_ptr<Executor> local;
+  std::size_t blocks = 1;
+  Executor &executor = BlockExecutor(data, count, local, blocks);
+  executor.ForEachBlock(count, blocks,
+    [&](const std::size_t _begin, const std::size_t _end, std::size_t)
+    {
+      std::vector<std::size_t> neighbors;
+      Matrix3SoAd covariances(kChunk);
+      std::vector<char> valid(kChunk);
+      Vector3SoAd values;
+      Matrix3SoAd vectors;
+      for (std::size_t first = _begin; first < _end; first += kChunk)
+      {
+        const std::size_t last = std::min(first + kChunk, _end);
+        covariances.Resize(last - first);
+        RangeCovariances(data, _points, _tree, first, last, neighbors,
+                         covariances, valid);
+        covariances.SymmetricEigen(values, vectors);
+
+        const double *l0 = values.XData();
+        const double *l1 = values.YData();
+        const double *l2 = values.ZData();
+        const double *v0 = vectors.Data(0, 0);
+        const double *v1 = vectors.Data(1, 0);
+        const double *v2 = vectors.Data(2, 0);
+        for (std::size_t i = first; i < last; ++i)
+        {
+          const std::size_t j = i - first;
+
+          // The direction of least variance is normal to the surface,
+          // unless the neighbors are collinear.
+          if (!valid[j] || !(l1[j] > 1e-6 * l2[j]))
+          {
+            nx[i] = ny[i] = nz[i] = 0;
+            _curvatures[i] = nan;
+            continue;
+          }
+
+          double sign = 1;
+          if (data.hasViewpoint &&
+              (data.viewpoint.X() - x[i]) * v0[j] +
+              (data.viewpoint.Y() - y[i]) * v1[j] +
+              (data.viewpoint.Z() - z[i]) * v2[j] < 0)
+          {
+            sign = -1;
+          }
+          nx[i] = sign * v0[j];
+          ny[i] = sign * v1[j];
+          nz[i] = sign * v2[j];
+
+          const double smallest = std::max(l0[j], 0.0);
+          _curvatures[i] = smallest / (smallest + l1[j] + l2[j]);
+        }
+      }
+    });
+}
+
+/////////////////////////////////////////////////
+void NormalEstimator::Covariances(const Vector3SoAd &_points,
+    const KdTree3d &_tree, Matrix3SoAd &_covariances) const
+{
+  const std::size_t count = _points.Size();
+  _covariances.Resize(count);
+
+  std::unique_ptr<Executor> local;
+  std::size_t blocks = 1;
+  Executor &executor = BlockExecutor(*this->dataPtr, count, local, blocks);
+  executor.ForEachBlock(count, blocks,
+    [&](const std::size_t _begin, const std::size_t _end, std::size_t)
+    {
+      std::vector<std::size_t> neighbors;
+      std::vector<char> valid(_end - _begin);
+      Matrix3SoAd covariances(_end - _begin);
+      RangeCovariances(*this->dataPtr, _points, _tree, _begin, _end,
+                       neighbors, covariances, valid);
+      for (std::size_t i = _begin; i < _end; ++i)
+        _covariances.Set(i, covariances[i - _begin]);
+    });
+}
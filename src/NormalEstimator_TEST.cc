@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "gz/math/Executor.hh"
+#include "gz/math/NormalEstimator.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(NormalEstimatorTest, Defaults)
+{
+  NormalEstimator estimator;
+  EXPECT_EQ(10u, estimator.Neighbors());
+  EXPECT_TRUE(std::isinf(estimator.Radius()));
+  EXPECT_FALSE(estimator.HasViewpoint());
+  EXPECT_EQ(1u, estimator.ThreadCount());
+
+  estimator.SetNeighbors(5);
+  estimator.SetRadius(0.5);
+  estimator.SetViewpoint(Vector3d(1, 2, 3));
+  estimator.SetThreadCount(0);
+  EXPECT_EQ(5u, estimator.Neighbors());
+  EXPECT_DOUBLE_EQ(0.5, estimator.Radius());
+  EXPECT_TRUE(estimator.HasViewpoint());
+  EXPECT_EQ(Vector3d(1, 2, 3), estimator.Viewpoint());
+  EXPECT_EQ(0u, estimator.ThreadCount());
+
+  NormalEstimator copy(estimator);
+  EXPECT_EQ(5u, copy.Neighbors());
+  estimator.ClearViewpoint();
+  EXPECT_FALSE(estimator.HasViewpoint());
+  EXPECT_TRUE(copy.HasViewpoint());
+  copy = estimator;
+  EXPECT_FALSE(copy.HasViewpoint());
+}
+
+/////////////////////////////////////////////////
+TEST(NormalEstimatorTest, Plane)
+{
+  // Tilted grid
+  const Vector3d normal = Vector3d(0.2, -0.3, 1).Normalize();
+  const Vector3d u = normal.Cross(Vector3d::UnitX).Normalize();
+  const Vector3d v = normal.Cross(u);
+  Vector3SoAd points;
+  for (int i = 0; i < 20; ++i)
+  {
+    for (int j = 0; j < 20; ++j)
+      points.PushBack(Vector3d(1, 2, 3) + u * (0.1 * i) + v * (0.1 * j));
+  }
+
+  NormalEstimator estimator;
+  estimator.SetViewpoint(Vector3d(1, 2, 3) + normal * 10);
+  Vector3SoAd normals;
+  std::vector<double> curvatures;
+  estimator.Estimate(points, normals, curvatures);
+  ASSERT_EQ(points.Size(), normals.Size());
+  ASSERT_EQ(points.Size(), curvatures.size());
+  for (std::size_t i = 0; i < points.Size(); ++i)
+  {
+    EXPECT_TRUE(normals[i].Equal(normal, 1e-9)) << i;
+    EXPECT_NEAR(0.0, curvatures[i], 1e-12);
+  }
+
+  // Flipped towards the other side
+  estimator.SetViewpoint(Vector3d(1, 2, 3) - normal * 10);
+  estimator.Estimate(points, normals, curvatures);
+  for (std::size_t i = 0; i < points.Size(); ++i)
+    EXPECT_TRUE(normals[i].Equal(-normal, 1e-9)) << i;
+}
+
+/////////////////////////////////////////////////
+TEST(NormalEstimatorTest, Sphere)
+{
+  Rand::Seed(21);
+  Vector3SoAd points;
+  for (int i = 0; i < 3000; ++i)
+  {
+    points.PushBack(Vector3d(Rand::DblNormal(), Rand::DblNormal(),
+                             Rand::DblNormal()).Normalize());
+  }
+
+  // Normals of a sphere point outwards, away from a viewpoint at the
+  // center, and the curvature grows with the size of the neighborhoods.
+  NormalEstimator estimator;
+  estimator.SetViewpoint(Vector3d::Zero);
+  Vector3SoAd normals;
+  std::vector<double> small;
+  estimator.Estimate(points, normals, small);
+  for (std::size_t i = 0; i < points.Size(); ++i)
+  {
+    EXPECT_NEAR(-1.0, normals[i].Dot(points[i]), 1e-2) << i;
+    EXPECT_GT(small[i], 0.0);
+  }
+
+  std::vector<double> large;
+  estimator.SetNeighbors(40);
+  estimator.Estimate(points, normals, large);
+  double sumSmall = 0;
+  double sumLarge = 0;
+  for (std::size_t i = 0; i < points.Size(); ++i)
+  {
+    sumSmall += small[i];
+    sumLarge += large[i];
+  }
+  EXPECT_GT(sumLarge, 2 * sumSmall);
+}
+
+/////////////////////////////////////////////////
+TEST(NormalEstimatorTest, Degenerate)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  Vector3SoAd points;
+  // Collinear
+  for (int i = 0; i < 10; ++i)
+    points.PushBack(Vector3d(i, 0, 0));
+  // Isolated pair, farther than the radius from everything else
+  points.PushBack(Vector3d(100, 0, 0));
+  points.PushBack(Vector3d(100, 0.1, 0));
+  // Not finite
+  points.PushBack(Vector3d(nan, 0, 0));
+
+  NormalEstimator estimator;
+  estimator.SetRadius(5);
+  Vector3SoAd normals;
+  std::vector<double> curvatures;
+  estimator.Estimate(points, normals, curvatures);
+  ASSERT_EQ(13u, normals.Size());
+  for (std::size_t i = 0; i < points.Size(); ++i)
+  {
+    EXPECT_EQ(Vector3d::Zero, normals[i]) << i;
+    EXPECT_TRUE(std::isnan(curvatures[i])) << i;
+  }
+
+  Matrix3SoAd covariances;
+  estimator.Covariances(points, KdTree3d(points.ToVector()), covariances);
+  ASSERT_EQ(13u, covariances.Size());
+  EXPECT_EQ(Matrix3d::Zero, covariances[10]);
+  EXPECT_EQ(Matrix3d::Zero, covariances[12]);
+  EXPECT_GT(covariances[0](0, 0), 0.0);
+  EXPECT_DOUBLE_EQ(0.0, covariances[0](1, 1));
+
+  // Empty
+  estimator.Estimate(Vector3SoAd(), normals, curvatures);
+  EXPECT_TRUE(normals.Empty());
+  EXPECT_TRUE(curvatures.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(NormalEstimatorTest, Covariances)
+{
+  // Four corners of a square, which are all neighbors of each other
+  Vector3SoAd points(std::vector<Vector3d>{
+      Vector3d(0, 0, 0), Vector3d(2, 0, 0),
+      Vector3d(0, 2, 0), Vector3d(2, 2, 0)});
+  NormalEstimator estimator;
+  Matrix3SoAd covariances;
+  estimator.Covariances(points, KdTree3d(points.ToVector()), covariances);
+  ASSERT_EQ(4u, covariances.Size());
+  for (std::size_t i = 0; i < 4; ++i)
+    EXPECT_EQ(Matrix3d(1, 0, 0, 0, 1, 0, 0, 0, 0), covariances[i]);
+
+  // Only the point and its two nearest neighbors
+  estimator.SetNeighbors(3);
+  estimator.Covariances(points, KdTree3d(points.ToVector()), covariances);
+  const double a = 8.0 / 9.0;
+  const double b = 4.0 / 9.0;
+  EXPECT_EQ(Matrix3d(a, -b, 0, -b, a, 0, 0, 0, 0), covariances[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(NormalEstimatorTest, Threads)
+{
+  Rand::Seed(22);
+  Vector3SoAd points;
+  for (int i = 0; i < 5000; ++i)
+  {
+    const double x = Rand::DblUniform(-5, 5);
+    const double y = Rand::DblUniform(-5, 5);
+    points.PushBack(Vector3d(x, y, std::sin(x) * std::cos(y)));
+  }
+  const KdTree3d tree(points.ToVector());
+
+  NormalEstimator estimator;
+  Vector3SoAd expectedNormals;
+  std::vector<double> expectedCurvatures;
+  estimator.Estimate(points, tree, expectedNormals, expectedCurvatures);
+
+  auto expectSame = [&]()
+  {
+    Vector3SoAd normals;
+    std::vector<double> curvatures;
+    estimator.Estimate(points, tree, normals, curvatures);
+    ASSERT_EQ(expectedNormals.Size(), normals.Size());
+    for (std::size_t i = 0; i < normals.Size(); ++i)
+    {
+      EXPECT_DOUBLE_EQ(expectedNormals.XData()[i], normals.XData()[i]);
+      EXPECT_DOUBLE_EQ(expectedCurvatures[i], curvatures[i]);
+    }
+  };
+
+  estimator.SetThreadCount(4);
+  expectSame();
+  estimator.SetExecutor(std::make_shared<ThreadPool>(3));
+  expectSame();
+}
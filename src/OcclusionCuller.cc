@@ -0,0 +1,747 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gz/math/CpuFeatures.hh"
+#include "gz/math/Instrumentation.hh"
+#include "gz/math/OcclusionCuller.hh"
+#include "gz/math/Trace.hh"
+
+// Select the instruction set of the rasterization kernel. Define
+// IGNITION_MATH_DISABLE_SIMD to always use the portable scalar code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define IGNITION_MATH_OCCLUSION_SSE2 1
+    #include <emmintrin.h>
+  #endif
+#endif
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Rasterize a span of pixels of a triangle, keeping the nearest
+  /// depth of each pixel. The depth is stored as its reciprocal, which
+  /// varies linearly across the screen.
+  /// \param[in,out] _row First pixel of the span.
+  /// \param[in] _count Number of pixels, a multiple of 4.
+  /// \param[in] _e Edge functions at the first pixel. A pixel is inside the
+  /// triangle when none of them is negative.
+  /// \param[in] _de Change of the edge functions from a pixel to the next.
+  /// \param[in] _w Reciprocal depth at the first pixel.
+  /// \param[in] _dw Change of the reciprocal depth from a pixel to the next.
+  using RowKernel = void (*)(float *_row, const std::size_t _count,
+                             const float _e[3], const float _de[3],
+                             const float _w, const float _dw);
+
+  /// \brief Portable RowKernel.
+  void RasterRowScalar(float *_row, const std::size_t _count,
+                       const float _e[3], const float _de[3],
+                       const float _w, const float _dw)
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      const float x = static_cast<float>(i);
+      const float w = _w + _dw * x;
+      if (_e[0] + _de[0] * x >= 0 && _e[1] + _de[1] * x >= 0 &&
+          _e[2] + _de[2] * x >= 0 && w > _row[i])
+      {
+        _row[i] = w;
+      }
+    }
+  }
+
+#if defined(IGNITION_MATH_OCCLUSION_SSE2)
+  /// \brief SSE2 RowKernel, four pixels at a time.
+  void RasterRowSse2(float *_row, const std::size_t _count,
+                     const float _e[3], const float _de[3],
+                     const float _w, const float _dw)
+  {
+    const __m128 lane = _mm_set_ps(3, 2, 1, 0);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 e0 = _mm_set1_ps(_e[0]);
+    const __m128 e1 = _mm_set1_ps(_e[1]);
+    const __m128 e2 = _mm_set1_ps(_e[2]);
+    const __m128 de0 = _mm_set1_ps(_de[0]);
+    const __m128 de1 = _mm_set1_ps(_de[1]);
+    const __m128 de2 = _mm_set1_ps(_de[2]);
+    const __m128 w0 = _mm_set1_ps(_w);
+    const __m128 dw = _mm_set1_ps(_dw);
+    for (std::size_t i = 0; i < _count; i += 4)
+    {
+      const __m128 x = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), lane);
+      const __m128 w = _mm_add_ps(w0, _mm_mul_ps(dw, x));
+      const __m128 old = _mm_loadu_ps(_row + i);
+      __m128 inside = _mm_cmpgt_ps(w, old);
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(
+          _mm_add_ps(e0, _mm_mul_ps(de0, x)), zero));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(
+          _mm_add_ps(e1, _mm_mul_ps(de1, x)), zero));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(
+          _mm_add_ps(e2, _mm_mul_ps(de2, x)), zero));
+      _mm_storeu_ps(_row + i, _mm_or_ps(_mm_and_ps(inside, w),
+                                        _mm_andnot_ps(inside, old)));
+    }
+  }
+#endif
+
+  /// \brief Get the widest rasterization kernel allowed by
+  /// ActiveSimdLevel().
+  /// \return The kernel.
+  RowKernel SelectRowKernel()
+  {
+#if defined(IGNITION_MATH_OCCLUSION_SSE2)
+    const SimdLevel level = ActiveSimdLevel();
+    if (level != SimdLevel::SCALAR && level != SimdLevel::NEON)
+      return RasterRowSse2;
+#endif
+    return RasterRowScalar;
+  }
+
+  /// \brief Vertex projected on the depth buffer.
+  struct ScreenVertex
+  {
+    /// \brief Column, in pixels from the left.
+    double x;
+
+    /// \brief Row, in pixels from the top.
+    double y;
+
+    /// \brief Reciprocal of the depth.
+    double w;
+  };
+
+  /// \brief Inclusive rectangle of pixels.
+  struct PixelRect
+  {
+    /// \brief First column.
+    unsigned int x0 = std::numeric_limits<unsigned int>::max();
+
+    /// \brief First row.
+    unsigned int y0 = std::numeric_limits<unsigned int>::max();
+
+    /// \brief Last column.
+    unsigned int x1 = 0;
+
+    /// \brief Last row.
+    unsigned int y1 = 0;
+
+    /// \brief Get whether the rectangle holds no pixel.
+    /// \return True if empty.
+    bool Empty() const
+    {
+      return this->x0 > this->x1 || this->y0 > this->y1;
+    }
+
+    /// \brief Grow the rectangle to hold another one.
+    /// \param[in] _other The other rectangle.
+    void Merge(const PixelRect &_other)
+    {
+      this->x0 = std::min(this->x0, _other.x0);
+      this->y0 = std::min(this->y0, _other.y0);
+      this->x1 = std::max(this->x1, _other.x1);
+      this->y1 = std::max(this->y1, _other.y1);
+    }
+  };
+}
+
+/// \brief Private data for OcclusionCuller.
+class gz::math::OcclusionCullerPrivate
+{
+  /// \brief Allocate the depth buffer and its hierarchy.
+  /// \param[in] _width Width in pixels.
+  /// \param[in] _height Height in pixels.
+  public: void Resize(const unsigned int _width, const unsigned int _height)
+  {
+    this->widths.assign(1, std::max(1u, _width));
+    this->heights.assign(1, std::max(1u, _height));
+    this->strides.assign(1, (this->widths[0] + 3) & ~3u);
+    while (this->widths.back() > 1 || this->heights.back() > 1)
+    {
+      this->widths.push_back((this->widths.back() + 1) / 2);
+      this->heights.push_back((this->heights.back() + 1) / 2);
+      this->strides.push_back(this->widths.back());
+    }
+    this->levels.resize(this->widths.size());
+    for (std::size_t l = 0; l < this->levels.size(); ++l)
+      this->levels[l].resize(this->strides[l] * this->heights[l]);
+  }
+
+  /// \brief Set the view and clear the depth buffer.
+  /// \param[in] _frustum The view.
+  public: void SetView(const Frustum &_frustum)
+  {
+    const Pose3d pose = _frustum.Pose();
+    this->position = pose.Pos();
+    this->forward = pose.Rot().RotateVector(Vector3d::UnitX);
+    this->up = pose.Rot().RotateVector(Vector3d::UnitZ);
+    this->right = pose.Rot().RotateVector(-Vector3d::UnitY);
+
+    this->far = _frustum.Far();
+    this->near = _frustum.Near() > 0 ? _frustum.Near() : this->far * 1e-6;
+
+    const double tanFOV2 = std::tan(_frustum.FOV().Radian() * 0.5);
+    this->centerX = this->widths[0] * 0.5;
+    this->centerY = this->heights[0] * 0.5;
+    this->focalX = this->centerX / tanFOV2;
+    this->focalY = this->centerY * _frustum.AspectRatio() / tanFOV2;
+
+    const float clear = static_cast<float>(1.0 / this->far);
+    for (auto &level : this->levels)
+      std::fill(level.begin(), level.end(), clear);
+  }
+
+  /// \brief Convert a point to the view frame.
+  /// \param[in] _p The point.
+  /// \return Right, up and forward coordinates of the point.
+  public: Vector3d ToView(const Vector3d &_p) const
+  {
+    const Vector3d d = _p - this->position;
+    return Vector3d(this->right.Dot(d), this->up.Dot(d),
+                    this->forward.Dot(d));
+  }
+
+  /// \brief Project a point in front of the near plane on the buffer.
+  /// \param[in] _v The point, in the view frame.
+  /// \return The projected vertex.
+  public: ScreenVertex Project(const Vector3d &_v) const
+  {
+    const double w = 1.0 / _v.Z();
+    return {this->centerX + this->focalX * _v.X() * w,
+            this->centerY - this->focalY * _v.Y() * w, w};
+  }
+
+  /// \brief Clip a triangle against the near plane and rasterize it.
+  /// \param[in] _v Vertices in the view frame.
+  /// \param[in] _kernel Rasterization kernel.
+  /// \param[in,out] _dirty Rectangle of the changed pixels.
+  public: void AddTriangle(const Vector3d _v[3], const RowKernel _kernel,
+                           PixelRect &_dirty)
+  {
+    Vector3d poly[4];
+    int n = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+      const Vector3d &cur = _v[i];
+      const Vector3d &next = _v[(i + 1) % 3];
+      const bool curIn = cur.Z() >= this->near;
+      if (curIn)
+        poly[n++] = cur;
+      if (curIn != (next.Z() >= this->near))
+      {
+        const double t = (this->near - cur.Z()) / (next.Z() - cur.Z());
+        poly[n] = cur + (next - cur) * t;
+        poly[n++].Z(this->near);
+      }
+    }
+    if (n < 3)
+      return;
+
+    const ScreenVertex s0 = this->Project(poly[0]);
+    const ScreenVertex s1 = this->Project(poly[1]);
+    const ScreenVertex s2 = this->Project(poly[2]);
+    this->Rasterize(s0, s1, s2, _kernel, _dirty);
+    if (n == 4)
+      this->Rasterize(s0, s2, this->Project(poly[3]), _kernel, _dirty);
+  }
+
+  /// \brief Rasterize a projected triangle, sampling pixel centers.
+  /// \param[in] _a First vertex.
+  /// \param[in] _b Second vertex.
+  /// \param[in] _c Third vertex.
+  /// \param[in] _kernel Rasterization kernel.
+  /// \param[in,out] _dirty Rectangle of the changed pixels.
+  public: void Rasterize(const ScreenVertex &_a, ScreenVertex _b,
+                         ScreenVertex _c, const RowKernel _kernel,
+                         PixelRect &_dirty)
+  {
+    double area2 = (_b.x - _a.x) * (_c.y - _a.y) -
+                   (_b.y - _a.y) * (_c.x - _a.x);
+    if (!(std::abs(area2) > 1e-12))
+      return;
+    if (area2 < 0)
+    {
+      std::swap(_b, _c);
+      area2 = -area2;
+    }
+
+    // Pixels whose centers are within the bounds of the triangle, clamped
+    // to the buffer before converting to integers.
+    const double maxX = this->widths[0] - 1.0;
+    const double maxY = this->heights[0] - 1.0;
+    const double x0 = std::max(0.0,
+        std::ceil(std::min({_a.x, _b.x, _c.x}) - 0.5));
+    const double x1 = std::min(maxX,
+        std::floor(std::max({_a.x, _b.x, _c.x}) - 0.5));
+    const double y0 = std::max(0.0,
+        std::ceil(std::min({_a.y, _b.y, _c.y}) - 0.5));
+    const double y1 = std::min(maxY,
+        std::floor(std::max({_a.y, _b.y, _c.y}) - 0.5));
+    if (!(x0 <= x1) || !(y0 <= y1))
+      return;
+
+    PixelRect rect;
+    rect.x0 = static_cast<unsigned int>(x0);
+    rect.x1 = static_cast<unsigned int>(x1);
+    rect.y0 = static_cast<unsigned int>(y0);
+    rect.y1 = static_cast<unsigned int>(y1);
+    _dirty.Merge(rect);
+
+    // Edge functions A x + B y + C, each zero on an edge and positive on
+    // the side of the opposite vertex, and the reciprocal depth as the
+    // barycentric combination of the vertices.
+    const ScreenVertex *v[3] = {&_a, &_b, &_c};
+    double a[3], b[3], c[3];
+    double pw = 0, qw = 0, rw = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+      const ScreenVertex &p = *v[(i + 1) % 3];
+      const ScreenVertex &q = *v[(i + 2) % 3];
+      a[i] = p.y - q.y;
+      b[i] = q.x - p.x;
+      c[i] = p.x * q.y - p.y * q.x;
+      pw += a[i] * v[i]->w;
+      qw += b[i] * v[i]->w;
+      rw += c[i] * v[i]->w;
+    }
+    pw /= area2;
+    qw /= area2;
+    rw /= area2;
+
+    // Spans start and end on multiples of 4 pixels, within the padded
+    // rows. Pixels outside of the triangle are left unchanged.
+    const unsigned int start = rect.x0 & ~3u;
+    const std::size_t count = (rect.x1 + 1 - start + 3) & ~3u;
+    const double px = start + 0.5;
+    const float de[3] = {static_cast<float>(a[0]), static_cast<float>(a[1]),
+                         static_cast<float>(a[2])};
+    const float dw = static_cast<float>(pw);
+    float *pixels = this->levels[0].data();
+    for (unsigned int y = rect.y0; y <= rect.y1; ++y)
+    {
+      const double py = y + 0.5;
+      const float e[3] = {
+        static_cast<float>(a[0] * px + b[0] * py + c[0]),
+        static_cast<float>(a[1] * px + b[1] * py + c[1]),
+        static_cast<float>(a[2] * px + b[2] * py + c[2])};
+      _kernel(pixels + y * this->strides[0] + start, count, e, de,
+              static_cast<float>(pw * px + qw * py + rw), dw);
+    }
+  }
+
+  /// \brief Update the tiles of the hierarchy over changed pixels. Each
+  /// tile keeps the farthest depth, the smallest reciprocal, of its four
+  /// children.
+  /// \param[in] _dirty Rectangle of the changed pixels.
+  public: void UpdateHierarchy(PixelRect _dirty)
+  {
+    if (_dirty.Empty())
+      return;
+    for (std::size_t l = 1; l < this->levels.size(); ++l)
+    {
+      _dirty.x0 >>= 1;
+      _dirty.y0 >>= 1;
+      _dirty.x1 >>= 1;
+      _dirty.y1 >>= 1;
+      const std::vector<float> &fine = this->levels[l - 1];
+      const std::size_t fineStride = this->strides[l - 1];
+      const unsigned int fineWidth = this->widths[l - 1];
+      const unsigned int fineHeight = this->heights[l - 1];
+      for (unsigned int ty = _dirty.y0; ty <= _dirty.y1; ++ty)
+      {
+        const unsigned int cy1 = std::min(2 * ty + 1, fineHeight - 1);
+        for (unsigned int tx = _dirty.x0; tx <= _dirty.x1; ++tx)
+        {
+          const unsigned int cx1 = std::min(2 * tx + 1, fineWidth - 1);
+          float farthest = std::numeric_limits<float>::infinity();
+          for (unsigned int cy = 2 * ty; cy <= cy1; ++cy)
+          {
+            for (unsigned int cx = 2 * tx; cx <= cx1; ++cx)
+              farthest = std::min(farthest, fine[cy * fineStride + cx]);
+          }
+          this->levels[l][ty * this->strides[l] + tx] = farthest;
+        }
+      }
+    }
+  }
+
+  /// \brief Check whether a tile hides an object.
+  /// \param[in] _level Level of the tile, 0 for pixels.
+  /// \param[in] _tx Column of the tile.
+  /// \param[in] _ty Row of the tile.
+  /// \param[in] _rect Pixels covered by the object.
+  /// \param[in] _w Reciprocal of the nearest depth of the object.
+  /// \return True if the occluders of the pixels of the tile covered by
+  /// the object are all nearer than the object.
+  public: bool Occluded(const std::size_t _level, const unsigned int _tx,
+                        const unsigned int _ty, const PixelRect &_rect,
+                        const float _w) const
+  {
+    if (this->levels[_level][_ty * this->strides[_level] + _tx] > _w)
+      return true;
+    if (_level == 0)
+      return false;
+
+    const std::size_t l = _level - 1;
+    const unsigned int cx0 = std::max(2 * _tx, _rect.x0 >> l);
+    const unsigned int cx1 = std::min(2 * _tx + 1, _rect.x1 >> l);
+    const unsigned int cy0 = std::max(2 * _ty, _rect.y0 >> l);
+    const unsigned int cy1 = std::min(2 * _ty + 1, _rect.y1 >> l);
+    for (unsigned int cy = cy0; cy <= cy1; ++cy)
+    {
+      for (unsigned int cx = cx0; cx <= cx1; ++cx)
+      {
+        if (!this->Occluded(l, cx, cy, _rect, _w))
+          return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Check whether a box may be visible.
+  /// \param[in] _box The box.
+  /// \return False if it is hidden, beyond the far plane, or outside of
+  /// the view.
+  public: bool Visible(const AxisAlignedBox &_box) const
+  {
+    const Vector3d &bmin = _box.Min();
+    const Vector3d &bmax = _box.Max();
+    Vector3d corners[8];
+    int inFront = 0;
+    double nearest = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 8; ++i)
+    {
+      corners[i] = this->ToView(Vector3d(
+          (i & 1) ? bmax.X() : bmin.X(), (i & 2) ? bmax.Y() : bmin.Y(),
+          (i & 4) ? bmax.Z() : bmin.Z()));
+      inFront += corners[i].Z() >= this->near;
+      nearest = std::min(nearest, corners[i].Z());
+    }
+
+    // Boxes behind the near plane are out of view, and boxes that cross it
+    // may cover the whole view.
+    if (inFront == 0)
+      return false;
+    if (inFront < 8)
+      return true;
+
+    double sx0 = std::numeric_limits<double>::infinity();
+    double sy0 = sx0;
+    double sx1 = -sx0;
+    double sy1 = -sx0;
+    for (const auto &corner : corners)
+    {
+      const ScreenVertex s = this->Project(corner);
+      sx0 = std::min(sx0, s.x);
+      sy0 = std::min(sy0, s.y);
+      sx1 = std::max(sx1, s.x);
+      sy1 = std::max(sy1, s.y);
+    }
+
+    // Pixels touched by the projection of the box
+    const double maxX = this->widths[0] - 1.0;
+    const double maxY = this->heights[0] - 1.0;
+    sx0 = std::max(0.0, std::floor(sx0));
+    sy0 = std::max(0.0, std::floor(sy0));
+    sx1 = std::min(maxX, std::floor(sx1));
+    sy1 = std::min(maxY, std::floor(sy1));
+    if (!(sx0 <= sx1) || !(sy0 <= sy1))
+      return false;
+    PixelRect rect;
+    rect.x0 = static_cast<unsigned int>(sx0);
+    rect.y0 = static_cast<unsigned int>(sy0);
+    rect.x1 = static_cast<unsigned int>(sx1);
+    rect.y1 = static_cast<unsigned int>(sy1);
+
+    // Start from the finest level where the box covers at most 2 by 2
+    // tiles.
+    std::size_t level = 0;
+    while (level + 1 < this->levels.size() &&
+           ((rect.x1 >> level) - (rect.x0 >> level) > 1 ||
+            (rect.y1 >> level) - (rect.y0 >> level) > 1))
+    {
+      ++level;
+    }
+
+    const float w = static_cast<float>(1.0 / nearest);
+    for (unsigned int ty = rect.y0 >> level; ty <= rect.y1 >> level; ++ty)
+    {
+      for (unsigned int tx = rect.x0 >> level; tx <= rect.x1 >> level; ++tx)
+      {
+        if (!this->Occluded(level, tx, ty, rect, w))
+          return true;
+      }
+    }
+    return false;
+  }
+
+  /// \brief Width of each level, in tiles.
+  public: std::vector<unsigned int> widths;
+
+  /// \brief Height of each level, in tiles.
+  public: std::vector<unsigned int> heights;
+
+  /// \brief Distance between rows of each level. Rows of pixels are padded
+  /// to a multiple of 4.
+  public: std::vector<std::size_t> strides;
+
+  /// \brief Reciprocal depths of each level. Level 0 holds the pixels, and
+  /// each tile of the next levels covers 2 by 2 tiles of the previous one.
+  public: std::vector<std::vector<float>> levels;
+
+  /// \brief Position of the view.
+  public: Vector3d position;
+
+  /// \brief View direction.
+  public: Vector3d forward = Vector3d::UnitX;
+
+  /// \brief Up direction of the view.
+  public: Vector3d up = Vector3d::UnitZ;
+
+  /// \brief Right direction of the view.
+  public: Vector3d right = -Vector3d::UnitY;
+
+  /// \brief Distance of the near plane, where occluders are clipped.
+  public: double near = 0;
+
+  /// \brief Distance of the far plane.
+  public: double far = 1;
+
+  /// \brief Column of the view direction.
+  public: double centerX = 0;
+
+  /// \brief Row of the view direction.
+  public: double centerY = 0;
+
+  /// \brief Horizontal scale of the projection, in pixels.
+  public: double focalX = 0;
+
+  /// \brief Vertical scale of the projection, in pixels.
+  public: double focalY = 0;
+};
+
+/////////////////////////////////////////////////
+OcclusionCuller::OcclusionCuller()
+  : OcclusionCuller(kDefaultWidth, kDefaultHeight)
+{
+}
+
+/////////////////////////////////////////////////
+OcclusionCuller::OcclusionCuller(const unsigned int _width,
+    const unsigned int _height)
+  : dataPtr(std::make_unique<OcclusionCullerPrivate>())
+{
+  this->dataPtr->Resize(_width, _height);
+  this->dataPtr->SetView(Frustum());
+}
+
+/////////////////////////////////////////////////
+OcclusionCuller::OcclusionCuller(const OcclusionCuller &_other)
+  : dataPtr(std::make_unique<OcclusionCullerPrivate>(*_other.dataPtr))
+{
+  IGN_MATH_COUNT_COPY(PIMPL, sizeof(OcclusionCullerPrivate) +
+      this->dataPtr->levels[0].size() * sizeof(float));
+}
+
+/////////////////////////////////////////////////
+OcclusionCuller::OcclusionCuller(OcclusionCuller &&_other) noexcept =
+    default;
+
+/////////////////////////////////////////////////
+OcclusionCuller::~OcclusionCuller() = default;
+
+/////////////////////////////////////////////////
+OcclusionCuller &OcclusionCuller::operator=(const OcclusionCuller &_other)
+{
+  if (this != &_other)
+  {
+    IGN_MATH_COUNT_COPY(PIMPL, sizeof(OcclusionCullerPrivate) +
+        _other.dataPtr->levels[0].size() * sizeof(float));
+    *this->dataPtr = *_other.dataPtr;
+  }
+  return *this;
+}
+
+/////////////////////////////////////////////////
+OcclusionCuller &OcclusionCuller::operator=(
+    OcclusionCuller &&_other) noexcept = default;
+
+/////////////////////////////////////////////////
+unsigned int OcclusionCuller::Width() const
+{
+  return this->dataPtr->widths[0];
+}
+
+/////////////////////////////////////////////////
+unsigned int OcclusionCuller::Height() const
+{
+  return this->dataPtr->heights[0];
+}
+
+/////////////////////////////////////////////////
+void OcclusionCuller::Reset(const Frustum &_frustum)
+{
+  this->dataPtr->SetView(_frustum);
+}
+
+/////////////////////////////////////////////////
+void OcclusionCuller::AddOccluder(const Vector3d &_v0, const Vector3d &_v1,
+    const Vector3d &_v2)
+{
+  const Vector3d v[3] = {this->dataPtr->ToView(_v0),
+                         this->dataPtr->ToView(_v1),
+                         this->dataPtr->ToView(_v2)};
+  PixelRect dirty;
+  this->dataPtr->AddTriangle(v, SelectRowKernel(), dirty);
+  this->dataPtr->UpdateHierarchy(dirty);
+}
+
+/////////////////////////////////////////////////
+void OcclusionCuller::AddOccluder(const AxisAlignedBox &_box)
+{
+  this->AddOccluders(std::vector<AxisAlignedBox>{_box});
+}
+
+/////////////////////////////////////////////////
+void OcclusionCuller::AddOccluders(const std::vector<AxisAlignedBox> &_boxes)
+{
+  IGN_MATH_TRACE_ZONE("OcclusionCuller::AddOccluders(boxes)");
+  OcclusionCullerPrivate &d = *this->dataPtr;
+  const RowKernel kernel = SelectRowKernel();
+  PixelRect dirty;
+  for (const auto &box : _boxes)
+  {
+    const Vector3d bounds[2] = {box.Min(), box.Max()};
+
+    // Rasterize the faces whose outer side holds the view point, as two
+    // triangles each.
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      for (int side = 0; side < 2; ++side)
+      {
+        const double coord = bounds[side][axis];
+        if (side == 0 ? d.position[axis] >= coord :
+                        d.position[axis] <= coord)
+        {
+          continue;
+        }
+
+        const int j = (axis + 1) % 3;
+        const int k = (axis + 2) % 3;
+        Vector3d quad[4];
+        for (int q = 0; q < 4; ++q)
+        {
+          quad[q][axis] = coord;
+          quad[q][j] = bounds[q == 1 || q == 2][j];
+          quad[q][k] = bounds[q >= 2][k];
+          quad[q] = d.ToView(quad[q]);
+        }
+        const Vector3d first[3] = {quad[0], quad[1], quad[2]};
+        const Vector3d second[3] = {quad[0], quad[2], quad[3]};
+        d.AddTriangle(first, kernel, dirty);
+        d.AddTriangle(second, kernel, dirty);
+      }
+    }
+  }
+  d.UpdateHierarchy(dirty);
+}
+
+/////////////////////////////////////////////////
+void OcclusionCuller::AddOccluders(const Vector3d *_vertices,
+    const uint32_t *_indices, const std::size_t _triangleCount)
+{
+  IGN_MATH_TRACE_ZONE("OcclusionCuller::AddOccluders(triangles)");
+  OcclusionCullerPrivate &d = *this->dataPtr;
+  const RowKernel kernel = SelectRowKernel();
+  PixelRect dirty;
+  for (std::size_t i = 0; i < _triangleCount; ++i)
+  {
+    const uint32_t *tri = _indices + 3 * i;
+    const Vector3d v[3] = {d.ToView(_vertices[tri[0]]),
+                           d.ToView(_vertices[tri[1]]),
+                           d.ToView(_vertices[tri[2]])};
+    d.AddTriangle(v, kernel, dirty);
+  }
+  d.UpdateHierarchy(dirty);
+}
+
+/////////////////////////////////////////////////
+double OcclusionCuller::Depth(const unsigned int _x,
+    const unsigned int _y) const
+{
+  if (_x >= this->dataPtr->widths[0] || _y >= this->dataPtr->heights[0])
+    return std::numeric_limits<double>::quiet_NaN();
+  return 1.0 / this->dataPtr->levels[0][_y * this->dataPtr->strides[0] + _x];
+}
+
+/////////////////////////////////////////////////
+bool OcclusionCuller::Visible(const AxisAlignedBox &_box) const
+{
+  return this->dataPtr->Visible(_box);
+}
+
+/////////////////////////////////////////////////
+std::size_t OcclusionCuller::Visible(
+    const std::vector<AxisAlignedBox> &_boxes,
+    std::vector<uint64_t> &_visible) const
+{
+  _visible.assign((_boxes.size() + 63) / 64, ~uint64_t(0));
+  if (_boxes.size() % 64)
+    _visible.back() = (uint64_t(1) << (_boxes.size() % 64)) - 1;
+  return this->Cull(_boxes, _visible);
+}
+
+/////////////////////////////////////////////////
+std::size_t OcclusionCuller::Cull(const std::vector<AxisAlignedBox> &_boxes,
+    std::vector<uint64_t> &_visible) const
+{
+  IGN_MATH_TRACE_ZONE("OcclusionCuller::Cull");
+  if (_visible.size() != (_boxes.size() + 63) / 64)
+    return this->Visible(_boxes, _visible);
+
+  std::size_t visibleCount = 0;
+  for (std::size_t word = 0; word < _visible.size(); ++word)
+  {
+    uint64_t bits = _visible[word];
+    if (word + 1 == _visible.size() && _boxes.size() % 64)
+      bits &= (uint64_t(1) << (_boxes.size() % 64)) - 1;
+
+    uint64_t kept = 0;
+    unsigned int bit = 0;
+    while (bits)
+    {
+      while (!((bits >> bit) & 1u))
+        ++bit;
+      bits &= bits - 1;
+      if (this->dataPtr->Visible(_boxes[word * 64 + bit]))
+      {
+        kept |= uint64_t(1) << bit;
+        ++visibleCount;
+      }
+    }
+    _visible[word] = kept;
+  }
+  return visibleCount;
+}
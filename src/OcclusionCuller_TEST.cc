@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "gz/math/CpuFeatures.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/OcclusionCuller.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+/// \brief View from the origin along +X, with square pixels in the
+/// default buffer.
+Frustum TestFrustum()
+{
+  return Frustum(0.1, 100, Angle(IGN_DTOR(90)), 2.0);
+}
+
+/////////////////////////////////////////////////
+/// \brief Box of the given half size around a center.
+AxisAlignedBox CenteredBox(const Vector3d &_center, const double _half)
+{
+  return AxisAlignedBox(_center - Vector3d(_half, _half, _half),
+                        _center + Vector3d(_half, _half, _half));
+}
+
+/////////////////////////////////////////////////
+TEST(OcclusionCullerTest, Empty)
+{
+  OcclusionCuller culler;
+  EXPECT_EQ(OcclusionCuller::kDefaultWidth, culler.Width());
+  EXPECT_EQ(OcclusionCuller::kDefaultHeight, culler.Height());
+
+  OcclusionCuller small(0, 3);
+  EXPECT_EQ(1u, small.Width());
+  EXPECT_EQ(3u, small.Height());
+
+  culler.Reset(TestFrustum());
+  EXPECT_NEAR(100.0, culler.Depth(0, 0), 1e-4);
+  EXPECT_NEAR(100.0, culler.Depth(255, 127), 1e-4);
+  EXPECT_TRUE(std::isnan(culler.Depth(256, 0)));
+  EXPECT_TRUE(std::isnan(culler.Depth(0, 128)));
+
+  // Without occluders, only the boxes out of view are culled
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d(10, 0, 0), 1)));
+  EXPECT_FALSE(culler.Visible(CenteredBox(Vector3d(200, 0, 0), 1)));
+  EXPECT_FALSE(culler.Visible(CenteredBox(Vector3d(-10, 0, 0), 1)));
+  EXPECT_FALSE(culler.Visible(CenteredBox(Vector3d(10, 50, 0), 1)));
+  EXPECT_FALSE(culler.Visible(CenteredBox(Vector3d(10, 0, 50), 1)));
+
+  // A box around the view point is visible
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d::Zero, 1)));
+}
+
+/////////////////////////////////////////////////
+TEST(OcclusionCullerTest, Wall)
+{
+  OcclusionCuller culler;
+  culler.Reset(TestFrustum());
+
+  // A wall that fills the view
+  culler.AddOccluder(AxisAlignedBox(Vector3d(10, -20, -20),
+                                    Vector3d(11, 20, 20)));
+  EXPECT_NEAR(10.0, culler.Depth(0, 0), 1e-4);
+  EXPECT_NEAR(10.0, culler.Depth(128, 64), 1e-4);
+  EXPECT_NEAR(10.0, culler.Depth(255, 127), 1e-4);
+
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d(5, 0, 0), 1)));
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d(10, 3, 1), 0.5)));
+  EXPECT_FALSE(culler.Visible(CenteredBox(Vector3d(20, 0, 0), 1)));
+  EXPECT_FALSE(culler.Visible(CenteredBox(Vector3d(20, 15, 5), 5)));
+  EXPECT_FALSE(culler.Visible(CenteredBox(Vector3d(12, 8, -4), 0.5)));
+
+  // Reset removes the occluders
+  culler.Reset(TestFrustum());
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d(20, 0, 0), 1)));
+
+  // Occluders are seen from the pose of the frustum
+  Frustum turned = TestFrustum();
+  turned.SetPose(Pose3d(0, 0, 0, 0, 0, IGN_PI));
+  culler.Reset(turned);
+  culler.AddOccluder(AxisAlignedBox(Vector3d(10, -20, -20),
+                                    Vector3d(11, 20, 20)));
+  EXPECT_NEAR(100.0, culler.Depth(128, 64), 1e-4);
+  culler.AddOccluder(AxisAlignedBox(Vector3d(-11, -20, -20),
+                                    Vector3d(-10, 20, 20)));
+  EXPECT_NEAR(10.0, culler.Depth(128, 64), 1e-4);
+  EXPECT_FALSE(culler.Visible(CenteredBox(Vector3d(-20, 0, 0), 1)));
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d(-5, 0, 0), 1)));
+
+  // An occluder that contains the view point is ignored
+  culler.Reset(TestFrustum());
+  culler.AddOccluder(CenteredBox(Vector3d::Zero, 5));
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d(20, 0, 0), 1)));
+}
+
+/////////////////////////////////////////////////
+TEST(OcclusionCullerTest, PartialOccluder)
+{
+  OcclusionCuller culler;
+  culler.Reset(TestFrustum());
+
+  // A square of 4 m at 10 m, which covers 52 by 52 pixels
+  const std::vector<Vector3d> vertices = {
+    {10, -2, -2}, {10, 2, -2}, {10, 2, 2}, {10, -2, 2}};
+  const std::vector<uint32_t> indices = {0, 1, 2, 0, 2, 3};
+  culler.AddOccluders(vertices.data(), indices.data(), 2);
+  EXPECT_NEAR(10.0, culler.Depth(128, 64), 1e-4);
+  EXPECT_NEAR(100.0, culler.Depth(60, 64), 1e-4);
+  EXPECT_NEAR(100.0, culler.Depth(128, 10), 1e-4);
+
+  // Hidden when the whole projection is behind the square
+  EXPECT_FALSE(culler.Visible(CenteredBox(Vector3d(20, 0, 0), 1)));
+  EXPECT_FALSE(culler.Visible(CenteredBox(Vector3d(30, 2, -2), 2)));
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d(20, 5, 0), 1)));
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d(20, 0, 4), 1)));
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d(20, 0, 0), 6)));
+
+  // In front of the square, or crossing it
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d(8, 0, 0), 1)));
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d(10, 0, 0), 1)));
+
+  // A slanted triangle, from 10 m on the left to 20 m on the right. The
+  // depth buffer is exact at pixel centers.
+  culler.Reset(TestFrustum());
+  culler.AddOccluder(Vector3d(10, 10, -10), Vector3d(20, -20, -20),
+                     Vector3d(20, -20, 20));
+  for (unsigned int x = 0; x < culler.Width(); ++x)
+  {
+    // Direction of the center of the pixel, and intersection with the
+    // plane of the triangle, y = 40 - 3 x.
+    const double right = (x + 0.5 - 128) / 128;
+    const double depth = 40 / (3 - right);
+    if (depth > 14 && depth < 19.5)
+    {
+      EXPECT_NEAR(depth, culler.Depth(x, 64), 1e-4 * depth) << x;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(OcclusionCullerTest, NearClipping)
+{
+  // A floor under the view point, which crosses the near plane
+  OcclusionCuller culler;
+  culler.Reset(TestFrustum());
+  culler.AddOccluder(AxisAlignedBox(Vector3d(-50, -50, -2),
+                                    Vector3d(50, 50, -1)));
+
+  // The top face of the floor fills the bottom half of the view
+  EXPECT_NEAR(100.0, culler.Depth(128, 10), 1e-4);
+  EXPECT_NEAR(128 / 63.5, culler.Depth(128, 127), 1e-4);
+  EXPECT_NEAR(128 / 3.5, culler.Depth(128, 67), 1e-3);
+  EXPECT_NEAR(100.0, culler.Depth(128, 65), 1e-4);
+
+  // Boxes under the floor are hidden
+  EXPECT_FALSE(culler.Visible(CenteredBox(Vector3d(10, 0, -5), 1)));
+  EXPECT_FALSE(culler.Visible(CenteredBox(Vector3d(30, 10, -3), 1)));
+  EXPECT_TRUE(culler.Visible(CenteredBox(Vector3d(10, 0, 0), 0.5)));
+}
+
+/////////////////////////////////////////////////
+TEST(OcclusionCullerTest, Batch)
+{
+  Frustum frustum = TestFrustum();
+  OcclusionCuller culler;
+  culler.Reset(frustum);
+  culler.AddOccluders({
+      AxisAlignedBox(Vector3d(10, -1, -20), Vector3d(11, 20, 20)),
+      AxisAlignedBox(Vector3d(30, -20, -20), Vector3d(31, 20, 20))});
+
+  // Boxes on a grid: hidden by the first wall in the middle and on the
+  // left, by the second wall beyond it, and out of view on the sides and
+  // behind the view point.
+  std::vector<AxisAlignedBox> boxes;
+  std::vector<bool> expected;
+  for (int i = -9; i < 60; i += 2)
+  {
+    for (int j = -8; j <= 8; j += 4)
+    {
+      boxes.push_back(CenteredBox(Vector3d(i, j, 0), 0.25));
+      const bool inView = i > 0 && std::abs(j) < i;
+      expected.push_back(inView && i < 30 && (i < 10 || j < 0));
+    }
+  }
+
+  std::vector<uint64_t> visible;
+  const std::size_t count = culler.Visible(boxes, visible);
+  ASSERT_EQ((boxes.size() + 63) / 64, visible.size());
+  std::size_t expectedCount = 0;
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    EXPECT_EQ(expected[i], ((visible[i / 64] >> (i % 64)) & 1u) != 0) << i;
+    EXPECT_EQ(expected[i], culler.Visible(boxes[i])) << i;
+    expectedCount += expected[i];
+  }
+  EXPECT_EQ(expectedCount, count);
+  EXPECT_EQ(0u, visible.back() >> (boxes.size() % 64));
+
+  // After frustum culling
+  std::vector<uint64_t> inFrustum;
+  frustum.Contains(boxes, inFrustum);
+  EXPECT_EQ(count, culler.Cull(boxes, inFrustum));
+  EXPECT_EQ(visible, inFrustum);
+
+  // Only the set bits are tested
+  std::vector<uint64_t> none(visible.size(), 0);
+  EXPECT_EQ(0u, culler.Cull(boxes, none));
+
+  // A bitmask of the wrong size tests every box
+  std::vector<uint64_t> wrong;
+  EXPECT_EQ(count, culler.Cull(boxes, wrong));
+  EXPECT_EQ(visible, wrong);
+}
+
+/////////////////////////////////////////////////
+TEST(OcclusionCullerTest, Kernels)
+{
+  // The scalar and vector kernels fill the same depth buffer
+  const SimdLevel active = ActiveSimdLevel();
+  std::vector<Vector3d> vertices;
+  std::vector<uint32_t> indices;
+  for (uint32_t i = 0; i < 50; ++i)
+  {
+    const double x = 5 + i;
+    const double y = std::sin(i) * x;
+    const double z = std::cos(3 * i) * x / 2;
+    vertices.push_back(Vector3d(x, y, z));
+    vertices.push_back(Vector3d(x + 2, y + 3, z - 1));
+    vertices.push_back(Vector3d(x - 1, y - 2, z + 4));
+    indices.insert(indices.end(), {3 * i, 3 * i + 1, 3 * i + 2});
+  }
+
+  OcclusionCuller vectorCuller(101, 57);
+  vectorCuller.Reset(TestFrustum());
+  vectorCuller.AddOccluders(vertices.data(), indices.data(), 50);
+
+  SetActiveSimdLevel(SimdLevel::SCALAR);
+  OcclusionCuller scalarCuller(101, 57);
+  scalarCuller.Reset(TestFrustum());
+  scalarCuller.AddOccluders(vertices.data(), indices.data(), 50);
+  SetActiveSimdLevel(active);
+
+  int covered = 0;
+  for (unsigned int y = 0; y < 57; ++y)
+  {
+    for (unsigned int x = 0; x < 101; ++x)
+    {
+      EXPECT_NEAR(scalarCuller.Depth(x, y), vectorCuller.Depth(x, y), 1e-3);
+      covered += vectorCuller.Depth(x, y) < 99;
+    }
+  }
+  EXPECT_GT(covered, 100);
+}
+
+/////////////////////////////////////////////////
+TEST(OcclusionCullerTest, CopyMove)
+{
+  OcclusionCuller culler(64, 32);
+  culler.Reset(TestFrustum());
+  culler.AddOccluder(AxisAlignedBox(Vector3d(10, -20, -20),
+                                    Vector3d(11, 20, 20)));
+  const AxisAlignedBox hidden = CenteredBox(Vector3d(20, 0, 0), 1);
+
+  OcclusionCuller copy(culler);
+  EXPECT_EQ(64u, copy.Width());
+  EXPECT_FALSE(copy.Visible(hidden));
+
+  OcclusionCuller assigned;
+  assigned = copy;
+  EXPECT_EQ(32u, assigned.Height());
+  EXPECT_FALSE(assigned.Visible(hidden));
+
+  OcclusionCuller moved(std::move(copy));
+  EXPECT_FALSE(moved.Visible(hidden));
+
+  // The copies are independent
+  assigned.Reset(TestFrustum());
+  EXPECT_TRUE(assigned.Visible(hidden));
+  EXPECT_FALSE(culler.Visible(hidden));
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_ODOMETRYBANKSTATE_HH_
+#define GZ_MATH_ODOMETRYBANKSTATE_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <gz/math/MovingWindowFilter.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    /// \brief Poses and smoothed velocities of a set of vehicles, shared by
+    /// DiffDriveOdometryBank and MecanumDriveOdometryBank. Every quantity
+    /// is an array with one element per vehicle.
+    ///
+    /// The sine and cosine of each heading are kept from the previous
+    /// update, so that integrating a vehicle takes a single sine and cosine
+    /// instead of the four of DiffDriveOdometry. The rolling means of the
+    /// velocities share one ring buffer index, since every vehicle gets a
+    /// new value at each update.
+    class OdometryBankState
+    {
+      /// \brief Number of velocities: linear, lateral and angular.
+      public: static constexpr std::size_t kVelocities = 3;
+
+      /// \brief Change the number of vehicles. New vehicles start at the
+      /// origin, and the velocity means are cleared.
+      /// \param[in] _size Number of vehicles.
+      public: void Resize(const std::size_t _size)
+      {
+        this->x.resize(_size, 0.0);
+        this->y.resize(_size, 0.0);
+        this->heading.resize(_size, 0.0);
+        this->sinHeading.resize(_size, 0.0);
+        this->cosHeading.resize(_size, 1.0);
+        for (std::size_t c = 0; c < kVelocities; ++c)
+        {
+          this->delta[c].resize(_size, 0.0);
+          this->velocity[c].resize(_size, 0.0);
+        }
+        this->ClearMeans();
+      }
+
+      /// \brief Move every vehicle to the origin and clear the velocities.
+      public: void Reset()
+      {
+        std::fill(this->x.begin(), this->x.end(), 0.0);
+        std::fill(this->y.begin(), this->y.end(), 0.0);
+        std::fill(this->heading.begin(), this->heading.end(), 0.0);
+        std::fill(this->sinHeading.begin(), this->sinHeading.end(), 0.0);
+        std::fill(this->cosHeading.begin(), this->cosHeading.end(), 1.0);
+        for (std::size_t c = 0; c < kVelocities; ++c)
+          std::fill(this->velocity[c].begin(), this->velocity[c].end(), 0.0);
+        this->ClearMeans();
+      }
+
+      /// \brief Set the window size of the velocity means, and clear them.
+      /// Nothing happens if _windowSize is zero, as in RollingMean.
+      /// \param[in] _windowSize The window size to use.
+      public: void SetWindowSize(const std::size_t _windowSize)
+      {
+        if (_windowSize == 0)
+          return;
+        this->windowSize = _windowSize;
+        this->ClearMeans();
+      }
+
+      /// \brief Clear the velocity means.
+      public: void ClearMeans()
+      {
+        const std::size_t n = this->x.size();
+        for (std::size_t c = 0; c < kVelocities; ++c)
+        {
+          this->history[c].assign(this->windowSize * n, 0.0);
+          this->sum[c].assign(n, 0.0);
+          this->compensation[c].assign(n, 0.0);
+        }
+        this->index = 0;
+        this->count = 0;
+      }
+
+      /// \brief Integrate the displacements stored in delta, with the
+      /// equations of DiffDriveOdometry and MecanumDriveOdometry.
+      /// \tparam Lateral False to ignore the lateral displacements.
+      public: template<bool Lateral>
+              void Integrate()
+      {
+        const std::size_t n = this->x.size();
+        const double *linear = this->delta[0].data();
+        const double *lateral = this->delta[1].data();
+        const double *angular = this->delta[2].data();
+        double *px = this->x.data();
+        double *py = this->y.data();
+        double *h = this->heading.data();
+        double *sinH = this->sinHeading.data();
+        double *cosH = this->cosHeading.data();
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          const double lin = linear[i];
+          const double lat = Lateral ? lateral[i] : 0.0;
+          const double ang = angular[i];
+          const double s0 = sinH[i];
+          const double c0 = cosH[i];
+          const double hNew = h[i] + ang;
+          const double s1 = std::sin(hNew);
+          const double c1 = std::cos(hNew);
+
+          if (std::fabs(ang) < 1e-6)
+          {
+            // Runge-Kutta 2nd order integration, with the direction
+            // h + ang / 2 expanded from the cached heading. The angle is
+            // small enough for cos(ang / 2) = 1 - ang^2 / 8 and
+            // sin(ang / 2) = ang / 2 to be exact in double precision.
+            const double halfCos = 1.0 - ang * ang * 0.125;
+            const double halfSin = ang * 0.5;
+            const double cosDir = c0 * halfCos - s0 * halfSin;
+            const double sinDir = s0 * halfCos + c0 * halfSin;
+            px[i] += lin * cosDir - lat * sinDir;
+            py[i] += lin * sinDir + lat * cosDir;
+          }
+          else
+          {
+            // Exact integration
+            const double ratio = lin / ang;
+            const double ratio2 = lat / ang;
+            px[i] += ratio * (s1 - s0) + ratio2 * (c1 - c0);
+            py[i] += -ratio * (c1 - c0) + ratio2 * (s1 - s0);
+          }
+          h[i] = hNew;
+          sinH[i] = s1;
+          cosH[i] = c1;
+        }
+      }
+
+      /// \brief Push the displacements stored in delta divided by the time
+      /// step to the velocity means, and update the velocities.
+      /// \tparam Lateral False to ignore the lateral displacements.
+      /// \param[in] _dt Time step in seconds, not zero.
+      public: template<bool Lateral>
+              void PushVelocities(const double _dt)
+      {
+        const std::size_t n = this->x.size();
+        const bool full = this->count == this->windowSize;
+        if (!full)
+          ++this->count;
+        const double invCount = 1.0 / static_cast<double>(this->count);
+
+        for (std::size_t c = 0; c < kVelocities; ++c)
+        {
+          if (!Lateral && c == 1)
+            continue;
+
+          const double *d = this->delta[c].data();
+          double *slot = this->history[c].data() + this->index * n;
+          double *s = this->sum[c].data();
+          double *comp = this->compensation[c].data();
+          double *vel = this->velocity[c].data();
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            const double value = d[i] / _dt;
+            if (full)
+              detail::CompensatedSubtract(s[i], comp[i], slot[i]);
+            detail::CompensatedAdd(s[i], comp[i], value);
+            slot[i] = value;
+            vel[i] = (s[i] - comp[i]) * invCount;
+          }
+        }
+        this->index = this->index + 1 == this->windowSize ?
+          0 : this->index + 1;
+      }
+
+      /// \brief X positions in meters.
+      public: std::vector<double> x;
+
+      /// \brief Y positions in meters.
+      public: std::vector<double> y;
+
+      /// \brief Headings in radians.
+      public: std::vector<double> heading;
+
+      /// \brief Sines of the headings.
+      public: std::vector<double> sinHeading;
+
+      /// \brief Cosines of the headings.
+      public: std::vector<double> cosHeading;
+
+      /// \brief Linear, lateral and angular displacements of the last
+      /// update, in meters and radians.
+      public: std::vector<double> delta[kVelocities];
+
+      /// \brief Smoothed linear, lateral and angular velocities.
+      public: std::vector<double> velocity[kVelocities];
+
+      /// \brief Window size of the velocity means.
+      public: std::size_t windowSize{10};
+
+      /// \brief Values in the windows, windowSize blocks of one value per
+      /// vehicle, for each velocity.
+      public: std::vector<double> history[kVelocities];
+
+      /// \brief Running sums of the windows.
+      public: std::vector<double> sum[kVelocities];
+
+      /// \brief Rounding errors of the running sums.
+      public: std::vector<double> compensation[kVelocities];
+
+      /// \brief Block of history that holds the oldest values.
+      public: std::size_t index{0};
+
+      /// \brief Number of values in each window.
+      public: std::size_t count{0};
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_ODOMETRYVELOCITYMEAN_HH_
+#define GZ_MATH_ODOMETRYVELOCITYMEAN_HH_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+#include <gz/math/RollingMean.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    /// \brief Rolling means of the velocities estimated by the odometry
+    /// classes. The default window size, by far the most used, is served by
+    /// FixedRollingMean stored inline, so that odometry objects need no
+    /// allocation per velocity and take constant time per update. Other
+    /// window sizes fall back to RollingMean.
+    /// \tparam N Number of velocities.
+    template<std::size_t N>
+    class OdometryVelocityMean
+    {
+      /// \brief Window size of the inline means, the default of the
+      /// odometry classes.
+      public: static constexpr std::size_t kDefaultWindowSize = 10;
+
+      /// \brief Set the window size and clear the values. Nothing happens
+      /// if _windowSize is zero, as in RollingMean.
+      /// \param[in] _windowSize The window size to use.
+      public: void SetWindowSize(const std::size_t _windowSize)
+      {
+        if (_windowSize == 0)
+          return;
+
+        this->Clear();
+        if (_windowSize == kDefaultWindowSize)
+        {
+          this->dynamic.reset();
+          return;
+        }
+
+        if (!this->dynamic)
+          this->dynamic.reset(new std::array<RollingMean, N>());
+        for (auto &mean : *this->dynamic)
+          mean.SetWindowSize(_windowSize);
+      }
+
+      /// \brief Remove all the pushed values.
+      public: void Clear()
+      {
+        for (auto &mean : this->fixed)
+          mean.Clear();
+        if (this->dynamic)
+        {
+          for (auto &mean : *this->dynamic)
+            mean.Clear();
+        }
+      }
+
+      /// \brief Insert a new value of each velocity.
+      /// \param[in] _values New values.
+      /// \param[out] _means Mean of each velocity over the window.
+      public: void Push(const std::array<double, N> &_values,
+                        std::array<double, N> &_means)
+      {
+        if (this->dynamic)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+          {
+            (*this->dynamic)[i].Push(_values[i]);
+            _means[i] = (*this->dynamic)[i].Mean();
+          }
+          return;
+        }
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+          this->fixed[i].Push(_values[i]);
+          _means[i] = this->fixed[i].Mean();
+        }
+      }
+
+      /// \brief Means for the default window size.
+      private: std::array<FixedRollingMean<kDefaultWindowSize>, N> fixed;
+
+      /// \brief Means for other window sizes, null for the default.
+      private: std::unique_ptr<std::array<RollingMean, N>> dynamic;
+    };
+    }
+  }
+}
+#endif
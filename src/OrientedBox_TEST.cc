@@ -16,6 +16,7 @@
 */
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 
 #include "gz/math/Angle.hh"
 #include "gz/math/OrientedBox.hh"
@@ -375,3 +376,148 @@ TEST(OrientedBoxTest, Mass)
   EXPECT_EQ(expectedMassMat, massMat);
   EXPECT_DOUBLE_EQ(expectedMassMat.Mass(), massMat.Mass());
 }
+
+//////////////////////////////////////////////////
+TEST(OrientedBoxTest, Intersects)
+{
+  OrientedBoxd box(Vector3d(1, 1, 1));
+
+  // Axis aligned
+  EXPECT_TRUE(box.Intersects(box));
+  EXPECT_TRUE(box.Intersects(
+      OrientedBoxd(Vector3d(1, 1, 1), Pose3d(0.9, 0.9, 0, 0, 0, 0))));
+  EXPECT_TRUE(box.Intersects(
+      OrientedBoxd(Vector3d(1, 1, 1), Pose3d(1, 0, 0, 0, 0, 0))));
+  EXPECT_FALSE(box.Intersects(
+      OrientedBoxd(Vector3d(1, 1, 1), Pose3d(0, 0, -1.1, 0, 0, 0))));
+
+  // Separated by an axis of the rotated box only
+  OrientedBoxd rotated(Vector3d(1, 1, 1),
+                       Pose3d(1.0, 1.0, 0, 0, 0, IGN_PI_4));
+  EXPECT_FALSE(box.Intersects(rotated));
+  EXPECT_FALSE(rotated.Intersects(box));
+  rotated = OrientedBoxd(Vector3d(1, 1, 1),
+                         Pose3d(0.8, 0.8, 0, 0, 0, IGN_PI_4));
+  EXPECT_TRUE(box.Intersects(rotated));
+  EXPECT_TRUE(rotated.Intersects(box));
+
+  // Edges crossing above each other, which are only separated by the
+  // cross product of their directions
+  const OrientedBoxd edgeX(Vector3d(1, 1, 1), Pose3d(0, 0, 0, IGN_PI_4, 0, 0));
+  EXPECT_FALSE(edgeX.Intersects(
+      OrientedBoxd(Vector3d(1, 1, 1), Pose3d(0, 0, 1.6, 0, IGN_PI_4, 0))));
+  EXPECT_TRUE(edgeX.Intersects(
+      OrientedBoxd(Vector3d(1, 1, 1), Pose3d(0, 0, 1.3, 0, IGN_PI_4, 0))));
+
+  // The cached rotation follows the pose
+  OrientedBoxd moved(Vector3d(1, 1, 1));
+  Pose3d pose(0, 0, 1.6, 0, IGN_PI_4, 0);
+  moved.Pose(pose);
+  EXPECT_FALSE(edgeX.Intersects(moved));
+  OrientedBoxd copy(edgeX);
+  EXPECT_FALSE(copy.Intersects(moved));
+  pose.Set(0, 0, 1.1, 0, 0, 0);
+  moved.Pose(pose);
+  EXPECT_TRUE(copy.Intersects(moved));
+  copy = box;
+  EXPECT_FALSE(copy.Intersects(moved));
+
+  // Zero size boxes
+  EXPECT_TRUE(box.Intersects(OrientedBoxd()));
+  EXPECT_FALSE(box.Intersects(
+      OrientedBoxd(Vector3d::Zero, Pose3d(0.6, 0, 0, 0, 0, 0))));
+}
+
+//////////////////////////////////////////////////
+TEST(OrientedBoxTest, IntersectsAxisAlignedBox)
+{
+  OrientedBoxd box(Vector3d(1, 1, 1), Pose3d(0, 0, 0, 0, 0, IGN_PI_4));
+
+  EXPECT_FALSE(box.Intersects(AxisAlignedBox()));
+  EXPECT_TRUE(box.Intersects(AxisAlignedBox(Vector3d(-0.1, -0.1, -0.1),
+                                            Vector3d(0.1, 0.1, 0.1))));
+  EXPECT_TRUE(box.Intersects(AxisAlignedBox(Vector3d(0.6, -0.1, -0.1),
+                                            Vector3d(1, 0.1, 0.1))));
+  EXPECT_FALSE(box.Intersects(AxisAlignedBox(Vector3d(0.6, 0.6, -0.1),
+                                             Vector3d(1, 1, 0.1))));
+
+  // Same as an oriented box with the same extent
+  for (double x = -2; x <= 2; x += 0.25)
+  {
+    const AxisAlignedBox aabb(Vector3d(x, x / 2, -0.5),
+                              Vector3d(x + 0.5, x / 2 + 0.3, 0.5));
+    const OrientedBoxd obb(aabb.Size(), Pose3d(aabb.Center(), Quaterniond()));
+    EXPECT_EQ(box.Intersects(obb), box.Intersects(aabb)) << x;
+  }
+
+  OrientedBoxf boxf(Vector3f(1, 1, 1));
+  EXPECT_TRUE(boxf.Intersects(AxisAlignedBox(Vector3d(0.4, 0.4, 0.4),
+                                             Vector3d(1, 1, 1))));
+}
+
+//////////////////////////////////////////////////
+TEST(OrientedBoxTest, IntersectsBatch)
+{
+  const OrientedBoxd box(Vector3d(1, 2, 3),
+                         Pose3d(0.1, 0.2, 0.3, 0.4, 0.5, 0.6));
+
+  std::vector<OrientedBoxd> boxes;
+  for (int i = 0; i < 64; ++i)
+  {
+    const double x = -3 + 0.1 * i;
+    boxes.emplace_back(Vector3d(0.5 + 0.01 * i, 1, 0.2),
+                       Pose3d(x, -x / 2, 0.5, 0.1 * i, -0.05 * i, 0.2 * i));
+  }
+
+  bool out[64];
+  std::size_t expected = 0;
+  const std::size_t count = box.Intersects(boxes.data(), boxes.size(), out);
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    EXPECT_EQ(box.Intersects(boxes[i]), out[i]) << i;
+    EXPECT_EQ(boxes[i].Intersects(box), out[i]) << i;
+    expected += out[i];
+  }
+  EXPECT_EQ(expected, count);
+  EXPECT_GT(count, 0u);
+  EXPECT_LT(count, boxes.size());
+
+  EXPECT_EQ(0u, box.Intersects(boxes.data(), 0, out));
+}
+
+/////////////////////////////////////////////////
+TEST(OrientedBoxTest, ContainsBatch)
+{
+  const OrientedBoxd box(Vector3d(1, 2, 3),
+                         Pose3d(0.1, 0.2, 0.3, 0.4, 0.5, 0.6));
+
+  // Points on a grid, none of them near the faces, where rounding could
+  // differ from Contains
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 8; ++i)
+  {
+    for (int j = 0; j < 8; ++j)
+    {
+      for (int k = 0; k < 8; ++k)
+      {
+        points.emplace_back(-1.6 + 0.47 * i, -1.6 + 0.43 * j,
+                            -1.6 + 0.41 * k);
+      }
+    }
+  }
+
+  bool results[512];
+  std::size_t expected = 0;
+  const std::size_t count = box.Contains(points.data(), points.size(),
+                                         results);
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(box.Contains(points[i]), results[i]) << points[i];
+    expected += results[i];
+  }
+  EXPECT_EQ(expected, count);
+  EXPECT_GT(count, 0u);
+  EXPECT_LT(count, points.size());
+
+  EXPECT_EQ(0u, box.Contains(points.data(), 0, results));
+}
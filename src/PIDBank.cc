@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/PIDBank.hh"
+
+using namespace gz;
+using namespace math;
+
+//////////////////////////////////////////////////
+class gz::math::PIDBankPrivate
+{
+  /// \brief Append a loop with the gains and limits of a controller.
+  /// \param[in] _pid Controller to copy.
+  public: void PushBack(const PID &_pid)
+  {
+    this->pGain.push_back(_pid.PGain());
+    this->iGain.push_back(_pid.IGain());
+    this->dGain.push_back(_pid.DGain());
+    this->iMax.push_back(_pid.IMax());
+    this->iMin.push_back(_pid.IMin());
+    this->cmdMax.push_back(_pid.CmdMax());
+    this->cmdMin.push_back(_pid.CmdMin());
+    this->cmdOffset.push_back(_pid.CmdOffset());
+    this->iLow.push_back(0);
+    this->iHigh.push_back(0);
+    this->cmdLow.push_back(0);
+    this->cmdHigh.push_back(0);
+    this->pErr.push_back(0);
+    this->iErr.push_back(0);
+    this->dErr.push_back(0);
+    this->cmd.push_back(0);
+    this->UpdateLimits(this->pGain.size() - 1);
+  }
+
+  /// \brief Remove loops from the end.
+  /// \param[in] _size New number of loops, not larger than the current.
+  public: void Truncate(const std::size_t _size)
+  {
+    for (auto *array : {&this->pGain, &this->iGain, &this->dGain,
+                        &this->iMax, &this->iMin, &this->cmdMax,
+                        &this->cmdMin, &this->cmdOffset, &this->iLow,
+                        &this->iHigh, &this->cmdLow, &this->cmdHigh,
+                        &this->pErr, &this->iErr, &this->dErr, &this->cmd})
+    {
+      array->resize(_size);
+    }
+  }
+
+  /// \brief Compute the clamping bounds of a loop from its limits. As in
+  /// PID, a limit whose maximum is lower than its minimum is disabled.
+  /// \param[in] _index Index of the loop.
+  public: void UpdateLimits(const std::size_t _index)
+  {
+    const double inf = std::numeric_limits<double>::infinity();
+    const bool iClamp = this->iMax[_index] >= this->iMin[_index];
+    this->iLow[_index] = iClamp ? this->iMin[_index] : -inf;
+    this->iHigh[_index] = iClamp ? this->iMax[_index] : inf;
+    const bool cmdClamp = this->cmdMax[_index] >= this->cmdMin[_index];
+    this->cmdLow[_index] = cmdClamp ? this->cmdMin[_index] : -inf;
+    this->cmdHigh[_index] = cmdClamp ? this->cmdMax[_index] : inf;
+  }
+
+  /// \brief Update every loop.
+  /// \tparam HasRate True to use _rates, false to use the finite
+  /// difference of the errors.
+  /// \param[in] _errors Errors.
+  /// \param[in] _rates Error rates, unused if HasRate is false.
+  /// \param[in] _dt Time step, not zero.
+  /// \param[out] _cmds Commands, already of the right size.
+  public: template<bool HasRate>
+          void Update(const double *_errors, const double *_rates,
+                      const double _dt, double *_cmds)
+  {
+    const std::size_t n = this->pGain.size();
+    const double *pg = this->pGain.data();
+    const double *ig = this->iGain.data();
+    const double *dg = this->dGain.data();
+    const double *offset = this->cmdOffset.data();
+    const double *iLo = this->iLow.data();
+    const double *iHi = this->iHigh.data();
+    const double *cLo = this->cmdLow.data();
+    const double *cHi = this->cmdHigh.data();
+    double *pe = this->pErr.data();
+    double *ie = this->iErr.data();
+    double *de = this->dErr.data();
+    double *c = this->cmd.data();
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      const double e = _errors[i];
+      // The error of the previous update is the current proportional
+      // error, since PID sets both to the same value.
+      const double rate = HasRate ? _rates[i] : (e - pe[i]) / _dt;
+
+      // Both inputs are tested without a branch.
+      const bool valid = std::isfinite(e) & std::isfinite(rate);
+
+      const double iNew = std::min(std::max(ie[i] + ig[i] * _dt * e,
+                                            iLo[i]), iHi[i]);
+      const double cmdNew = std::min(std::max(
+          offset[i] - pg[i] * e - iNew - dg[i] * rate, cLo[i]), cHi[i]);
+
+      pe[i] = valid ? e : pe[i];
+      ie[i] = valid ? iNew : ie[i];
+      de[i] = valid ? rate : de[i];
+      c[i] = valid ? cmdNew : c[i];
+      _cmds[i] = valid ? cmdNew : 0.0;
+    }
+  }
+
+  /// \brief Proportional gains.
+  public: std::vector<double> pGain;
+
+  /// \brief Integral gains.
+  public: std::vector<double> iGain;
+
+  /// \brief Derivative gains.
+  public: std::vector<double> dGain;
+
+  /// \brief Integral upper limits, as set.
+  public: std::vector<double> iMax;
+
+  /// \brief Integral lower limits, as set.
+  public: std::vector<double> iMin;
+
+  /// \brief Command upper limits, as set.
+  public: std::vector<double> cmdMax;
+
+  /// \brief Command lower limits, as set.
+  public: std::vector<double> cmdMin;
+
+  /// \brief Command offsets.
+  public: std::vector<double> cmdOffset;
+
+  /// \brief Lower clamping bounds of the integral terms, -inf when
+  /// disabled.
+  public: std::vector<double> iLow;
+
+  /// \brief Upper clamping bounds of the integral terms, inf when
+  /// disabled.
+  public: std::vector<double> iHigh;
+
+  /// \brief Lower clamping bounds of the commands, -inf when disabled.
+  public: std::vector<double> cmdLow;
+
+  /// \brief Upper clamping bounds of the commands, inf when disabled.
+  public: std::vector<double> cmdHigh;
+
+  /// \brief Current errors, which are also the errors of the previous
+  /// update.
+  public: std::vector<double> pErr;
+
+  /// \brief Integrals of gain times error.
+  public: std::vector<double> iErr;
+
+  /// \brief Derivative errors.
+  public: std::vector<double> dErr;
+
+  /// \brief Current commands.
+  public: std::vector<double> cmd;
+};
+
+//////////////////////////////////////////////////
+PIDBank::PIDBank()
+  : dataPtr(new PIDBankPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+PIDBank::PIDBank(const std::size_t _size, const PID &_pid)
+  : dataPtr(new PIDBankPrivate)
+{
+  this->Resize(_size, _pid);
+}
+
+//////////////////////////////////////////////////
+PIDBank::PIDBank(const PIDBank &_bank)
+  : dataPtr(new PIDBankPrivate(*_bank.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+PIDBank::~PIDBank()
+{
+}
+
+//////////////////////////////////////////////////
+PIDBank &PIDBank::operator=(const PIDBank &_bank)
+{
+  *this->dataPtr = *_bank.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void PIDBank::Resize(const std::size_t _size, const PID &_pid)
+{
+  if (_size <= this->Size())
+  {
+    this->dataPtr->Truncate(_size);
+    return;
+  }
+  while (this->Size() < _size)
+    this->dataPtr->PushBack(_pid);
+}
+
+//////////////////////////////////////////////////
+std::size_t PIDBank::Add(const PID &_pid)
+{
+  this->dataPtr->PushBack(_pid);
+  return this->Size() - 1;
+}
+
+//////////////////////////////////////////////////
+std::size_t PIDBank::Size() const
+{
+  return this->dataPtr->pGain.size();
+}
+
+//////////////////////////////////////////////////
+bool PIDBank::Set(const std::size_t _index, const PID &_pid)
+{
+  if (_index >= this->Size())
+    return false;
+
+  PIDBankPrivate &d = *this->dataPtr;
+  d.pGain[_index] = _pid.PGain();
+  d.iGain[_index] = _pid.IGain();
+  d.dGain[_index] = _pid.DGain();
+  d.iMax[_index] = _pid.IMax();
+  d.iMin[_index] = _pid.IMin();
+  d.cmdMax[_index] = _pid.CmdMax();
+  d.cmdMin[_index] = _pid.CmdMin();
+  d.cmdOffset[_index] = _pid.CmdOffset();
+  d.UpdateLimits(_index);
+  d.pErr[_index] = 0;
+  d.iErr[_index] = 0;
+  d.dErr[_index] = 0;
+  d.cmd[_index] = 0;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool PIDBank::Loop(const std::size_t _index, PID &_pid) const
+{
+  if (_index >= this->Size())
+    return false;
+
+  const PIDBankPrivate &d = *this->dataPtr;
+  _pid.Init(d.pGain[_index], d.iGain[_index], d.dGain[_index],
+            d.iMax[_index], d.iMin[_index], d.cmdMax[_index],
+            d.cmdMin[_index], d.cmdOffset[_index]);
+  _pid.SetCmd(d.cmd[_index]);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void PIDBank::Reset()
+{
+  PIDBankPrivate &d = *this->dataPtr;
+  std::fill(d.pErr.begin(), d.pErr.end(), 0.0);
+  std::fill(d.iErr.begin(), d.iErr.end(), 0.0);
+  std::fill(d.dErr.begin(), d.dErr.end(), 0.0);
+  std::fill(d.cmd.begin(), d.cmd.end(), 0.0);
+}
+
+//////////////////////////////////////////////////
+bool PIDBank::Update(const std::vector<double> &_errors,
+                     const std::chrono::duration<double> &_dt,
+                     std::vector<double> &_cmds)
+{
+  if (_errors.size() != this->Size())
+  {
+    IGN_MATH_DIAGNOSTIC("PIDBank::Update() error: got " << _errors.size()
+        << " errors for " << this->Size() << " loops.");
+    return false;
+  }
+
+  _cmds.resize(this->Size());
+  if (_dt == std::chrono::duration<double>(0))
+  {
+    std::fill(_cmds.begin(), _cmds.end(), 0.0);
+    return true;
+  }
+
+  this->dataPtr->Update<false>(_errors.data(), nullptr, _dt.count(),
+                               _cmds.data());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool PIDBank::Update(const std::vector<double> &_errors,
+                     const std::vector<double> &_errorRates,
+                     const std::chrono::duration<double> &_dt,
+                     std::vector<double> &_cmds)
+{
+  if (_errors.size() != this->Size() || _errorRates.size() != this->Size())
+  {
+    IGN_MATH_DIAGNOSTIC("PIDBank::Update() error: got " << _errors.size()
+        << " errors and " << _errorRates.size() << " error rates for "
+        << this->Size() << " loops.");
+    return false;
+  }
+
+  _cmds.resize(this->Size());
+  if (_dt == std::chrono::duration<double>(0))
+  {
+    std::fill(_cmds.begin(), _cmds.end(), 0.0);
+    return true;
+  }
+
+  this->dataPtr->Update<true>(_errors.data(), _errorRates.data(),
+                              _dt.count(), _cmds.data());
+  return true;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &PIDBank::Cmd() const
+{
+  return this->dataPtr->cmd;
+}
+
+//////////////////////////////////////////////////
+bool PIDBank::Errors(const std::size_t _index, double &_pe, double &_ie,
+                     double &_de) const
+{
+  if (_index >= this->Size())
+    return false;
+
+  _pe = this->dataPtr->pErr[_index];
+  _ie = this->dataPtr->iErr[_index];
+  _de = this->dataPtr->dErr[_index];
+  return true;
+}
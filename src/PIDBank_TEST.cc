@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gz/math/PIDBank.hh"
+
+using namespace gz;
+
+/// \brief Controllers with every combination of enabled limits.
+static std::vector<math::PID> TestControllers()
+{
+  return {
+    math::PID(1.0, 0.1, 0.05),
+    math::PID(2.0, 0.5, 0.1, 0.2, -0.2),
+    math::PID(0.5, 1.0, 0.0, -1, 1, 1.0, -1.0),
+    math::PID(3.0, 0.2, 0.3, 0.5, -0.1, 0.8, -0.5, 0.25),
+    math::PID(0.0, 0.0, 1.0, 1, 1, -2, -2)};
+}
+
+/////////////////////////////////////////////////
+TEST(PIDBankTest, Construct)
+{
+  math::PIDBank empty;
+  EXPECT_EQ(0u, empty.Size());
+
+  const math::PID pid(1, 2, 3, 4, -4, 5, -5, 0.5);
+  math::PIDBank bank(3, pid);
+  EXPECT_EQ(3u, bank.Size());
+  math::PID loop;
+  EXPECT_TRUE(bank.Loop(2, loop));
+  EXPECT_DOUBLE_EQ(1, loop.PGain());
+  EXPECT_DOUBLE_EQ(2, loop.IGain());
+  EXPECT_DOUBLE_EQ(3, loop.DGain());
+  EXPECT_DOUBLE_EQ(4, loop.IMax());
+  EXPECT_DOUBLE_EQ(-4, loop.IMin());
+  EXPECT_DOUBLE_EQ(5, loop.CmdMax());
+  EXPECT_DOUBLE_EQ(-5, loop.CmdMin());
+  EXPECT_DOUBLE_EQ(0.5, loop.CmdOffset());
+  EXPECT_DOUBLE_EQ(0, loop.Cmd());
+
+  EXPECT_EQ(3u, bank.Add(math::PID(7)));
+  bank.Loop(3, loop);
+  EXPECT_DOUBLE_EQ(7, loop.PGain());
+  EXPECT_TRUE(bank.Set(0, math::PID(8)));
+  bank.Loop(0, loop);
+  EXPECT_DOUBLE_EQ(8, loop.PGain());
+  bank.Resize(2);
+  EXPECT_EQ(2u, bank.Size());
+  bank.Resize(4, math::PID(9));
+  bank.Loop(3, loop);
+  EXPECT_DOUBLE_EQ(9, loop.PGain());
+
+  // Errors
+  EXPECT_FALSE(bank.Set(4, pid));
+  EXPECT_FALSE(bank.Loop(4, loop));
+  EXPECT_DOUBLE_EQ(9, loop.PGain());
+  double pe, ie, de;
+  EXPECT_FALSE(bank.Errors(4, pe, ie, de));
+  std::vector<double> cmds;
+  EXPECT_FALSE(bank.Update({1, 2}, std::chrono::milliseconds(1), cmds));
+  EXPECT_FALSE(bank.Update({1, 2, 3, 4}, {1},
+                           std::chrono::milliseconds(1), cmds));
+
+  // Copies are independent
+  math::PIDBank copy(bank);
+  EXPECT_TRUE(copy.Update({1, 2, 3, 4}, std::chrono::milliseconds(1), cmds));
+  EXPECT_NE(copy.Cmd(), bank.Cmd());
+  copy = bank;
+  EXPECT_EQ(copy.Cmd(), bank.Cmd());
+}
+
+/////////////////////////////////////////////////
+TEST(PIDBankTest, MatchesPID)
+{
+  std::vector<math::PID> pids = TestControllers();
+  math::PIDBank bank;
+  for (const auto &pid : pids)
+    bank.Add(pid);
+  math::PIDBank rateBank(bank);
+  std::vector<math::PID> ratePids = pids;
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  const std::chrono::duration<double> dt(0.01);
+  std::vector<double> cmds;
+  std::vector<double> rateCmds;
+  for (int step = 0; step < 50; ++step)
+  {
+    std::vector<double> errors;
+    std::vector<double> rates;
+    for (std::size_t i = 0; i < pids.size(); ++i)
+    {
+      errors.push_back(std::sin(0.3 * step + i) * (1 + i));
+      rates.push_back(std::cos(0.2 * step - i));
+    }
+    // Invalid inputs leave the loop unchanged
+    if (step == 10)
+      errors[1] = nan;
+    if (step == 20)
+      errors[2] = -inf;
+    if (step == 30)
+      rates[3] = inf;
+
+    // A zero time step returns zeros and changes nothing
+    const std::chrono::duration<double> stepDt =
+        step == 40 ? std::chrono::duration<double>(0) : dt;
+
+    ASSERT_TRUE(bank.Update(errors, stepDt, cmds));
+    ASSERT_TRUE(rateBank.Update(errors, rates, stepDt, rateCmds));
+    for (std::size_t i = 0; i < pids.size(); ++i)
+    {
+      EXPECT_DOUBLE_EQ(pids[i].Update(errors[i], stepDt), cmds[i]);
+      EXPECT_DOUBLE_EQ(ratePids[i].Update(errors[i], rates[i], stepDt),
+                       rateCmds[i]);
+      EXPECT_DOUBLE_EQ(pids[i].Cmd(), bank.Cmd()[i]);
+      EXPECT_DOUBLE_EQ(ratePids[i].Cmd(), rateBank.Cmd()[i]);
+
+      double pe, ie, de, bpe, bie, bde;
+      pids[i].Errors(pe, ie, de);
+      ASSERT_TRUE(bank.Errors(i, bpe, bie, bde));
+      EXPECT_DOUBLE_EQ(pe, bpe);
+      EXPECT_DOUBLE_EQ(ie, bie);
+      EXPECT_DOUBLE_EQ(de, bde);
+    }
+  }
+
+  bank.Reset();
+  for (std::size_t i = 0; i < pids.size(); ++i)
+  {
+    double pe, ie, de;
+    bank.Errors(i, pe, ie, de);
+    EXPECT_DOUBLE_EQ(0, pe + ie + de);
+    EXPECT_DOUBLE_EQ(0, bank.Cmd()[i]);
+  }
+}
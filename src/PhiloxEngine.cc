@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "gz/math/PhiloxEngine.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Multipliers of the Philox4x32 rounds.
+  const uint32_t kPhiloxM0 = 0xD2511F53u;
+  const uint32_t kPhiloxM1 = 0xCD9E8D57u;
+
+  /// \brief Weyl sequence increments of the Philox4x32 keys.
+  const uint32_t kPhiloxW0 = 0x9E3779B9u;
+  const uint32_t kPhiloxW1 = 0xBB67AE85u;
+
+  /// \brief Number of rounds of Philox4x32-10.
+  const int kPhiloxRounds = 10;
+
+  /// \brief Apply one Philox4x32 round to a counter.
+  /// \param[in,out] _ctr Counter.
+  /// \param[in] _key Round key.
+  void PhiloxRound(std::array<uint32_t, 4> &_ctr, const uint32_t _key[2])
+  {
+    const uint64_t product0 = static_cast<uint64_t>(kPhiloxM0) * _ctr[0];
+    const uint64_t product1 = static_cast<uint64_t>(kPhiloxM1) * _ctr[2];
+    const uint32_t hi0 = static_cast<uint32_t>(product0 >> 32);
+    const uint32_t lo0 = static_cast<uint32_t>(product0);
+    const uint32_t hi1 = static_cast<uint32_t>(product1 >> 32);
+    const uint32_t lo1 = static_cast<uint32_t>(product1);
+    _ctr = {{hi1 ^ _ctr[1] ^ _key[0], lo1, hi0 ^ _ctr[3] ^ _key[1], lo0}};
+  }
+}
+
+//////////////////////////////////////////////////
+PhiloxEngine::PhiloxEngine(uint64_t _seed, uint64_t _stream,
+                           uint64_t _position)
+  : seed(_seed), stream(_stream), position(_position)
+{
+}
+
+//////////////////////////////////////////////////
+void PhiloxEngine::Seed(uint64_t _seed, uint64_t _stream)
+{
+  this->seed = _seed;
+  this->stream = _stream;
+  this->position = 0;
+  this->bufferValid = false;
+}
+
+//////////////////////////////////////////////////
+uint64_t PhiloxEngine::Seed() const
+{
+  return this->seed;
+}
+
+//////////////////////////////////////////////////
+uint64_t PhiloxEngine::Stream() const
+{
+  return this->stream;
+}
+
+//////////////////////////////////////////////////
+void PhiloxEngine::Seek(uint64_t _position)
+{
+  this->position = _position;
+}
+
+//////////////////////////////////////////////////
+uint64_t PhiloxEngine::Position() const
+{
+  return this->position;
+}
+
+//////////////////////////////////////////////////
+void PhiloxEngine::discard(unsigned long long _count)
+{
+  this->position += _count;
+}
+
+//////////////////////////////////////////////////
+std::array<uint32_t, 4> PhiloxEngine::Block(uint64_t _seed,
+    uint64_t _stream, uint64_t _block)
+{
+  // The block index fills the low half of the 128 bit counter and the
+  // stream index the high half, so that streams never overlap.
+  std::array<uint32_t, 4> ctr = {{
+    static_cast<uint32_t>(_block), static_cast<uint32_t>(_block >> 32),
+    static_cast<uint32_t>(_stream), static_cast<uint32_t>(_stream >> 32)}};
+  uint32_t key[2] = {
+    static_cast<uint32_t>(_seed), static_cast<uint32_t>(_seed >> 32)};
+
+  for (int i = 0; i < kPhiloxRounds; ++i)
+  {
+    if (i > 0)
+    {
+      key[0] += kPhiloxW0;
+      key[1] += kPhiloxW1;
+    }
+    PhiloxRound(ctr, key);
+  }
+  return ctr;
+}
+
+//////////////////////////////////////////////////
+bool PhiloxEngine::operator==(const PhiloxEngine &_engine) const
+{
+  return this->seed == _engine.seed && this->stream == _engine.stream &&
+         this->position == _engine.position;
+}
+
+//////////////////////////////////////////////////
+bool PhiloxEngine::operator!=(const PhiloxEngine &_engine) const
+{
+  return !(*this == _engine);
+}
+
+//////////////////////////////////////////////////
+void PhiloxEngine::Generate(uint64_t _block)
+{
+  this->buffer = Block(this->seed, this->stream, _block);
+  this->bufferBlock = _block;
+  this->bufferValid = true;
+}
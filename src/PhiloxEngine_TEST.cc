@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gz/math/GaussMarkovProcess.hh"
+#include "gz/math/PhiloxEngine.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(PhiloxEngineTest, KnownAnswers)
+{
+  // Known answer tests of Philox4x32-10 from the Random123 library. The
+  // counter words are the block index followed by the stream index, and
+  // the key words are the seed, least significant first.
+  using Block = std::array<uint32_t, 4>;
+  EXPECT_EQ(Block({{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}),
+            PhiloxEngine::Block(0, 0, 0));
+  EXPECT_EQ(Block({{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}),
+            PhiloxEngine::Block(0xffffffffffffffff, 0xffffffffffffffff,
+                                0xffffffffffffffff));
+  EXPECT_EQ(Block({{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}),
+            PhiloxEngine::Block(0x299f31d0a4093822, 0x0370734413198a2e,
+                                0x85a308d3243f6a88));
+
+  // The engine outputs the blocks in order
+  PhiloxEngine engine;
+  for (uint64_t block = 0; block < 3; ++block)
+  {
+    for (uint32_t value : PhiloxEngine::Block(0, 0, block))
+      EXPECT_EQ(value, engine());
+  }
+  EXPECT_EQ(12u, engine.Position());
+}
+
+/////////////////////////////////////////////////
+TEST(PhiloxEngineTest, Seek)
+{
+  PhiloxEngine engine(1234, 5);
+  EXPECT_EQ(1234u, engine.Seed());
+  EXPECT_EQ(5u, engine.Stream());
+  EXPECT_EQ(0u, engine.Position());
+
+  std::vector<uint32_t> values(100);
+  for (auto &v : values)
+    v = engine();
+
+  // Seeking, discarding and constructing at a position all give the same
+  // outputs as drawing sequentially
+  for (uint64_t position : {0u, 1u, 3u, 4u, 57u, 99u})
+  {
+    engine.Seek(position);
+    EXPECT_EQ(values[position], engine());
+
+    PhiloxEngine skipped(1234, 5);
+    skipped.discard(position);
+    EXPECT_EQ(engine.Position() - 1, skipped.Position());
+    EXPECT_EQ(values[position], skipped());
+
+    PhiloxEngine started(1234, 5, position);
+    EXPECT_EQ(values[position], started());
+    EXPECT_EQ(skipped, started);
+  }
+
+  // Other streams and seeds give other outputs
+  PhiloxEngine otherStream(1234, 6);
+  PhiloxEngine otherSeed(1235, 5);
+  EXPECT_NE(values[0], otherStream());
+  EXPECT_NE(values[0], otherSeed());
+  EXPECT_NE(otherStream, otherSeed);
+
+  // Seeding restarts at the first position
+  otherSeed.Seed(1234, 5);
+  EXPECT_EQ(0u, otherSeed.Position());
+  EXPECT_EQ(values[0], otherSeed());
+}
+
+/////////////////////////////////////////////////
+TEST(PhiloxEngineTest, Distributions)
+{
+  static_assert(PhiloxEngine::min() == 0u, "Wrong minimum");
+  static_assert(PhiloxEngine::max() == 0xffffffffu, "Wrong maximum");
+
+  // The engine works with the standard distributions, and the outputs are
+  // roughly uniform
+  PhiloxEngine engine(42);
+  UniformRealDist uniform(0, 1);
+  NormalRealDist normal(0, 1);
+  double sum = 0, sumSq = 0;
+  const int count = 100000;
+  for (int i = 0; i < count; ++i)
+  {
+    double u = uniform(engine);
+    EXPECT_GE(u, 0.0);
+    EXPECT_LT(u, 1.0);
+    double n = normal(engine);
+    sum += n;
+    sumSq += n * n;
+  }
+  EXPECT_NEAR(0.0, sum / count, 0.02);
+  EXPECT_NEAR(1.0, sumSq / count, 0.02);
+
+  // Rand provides streams keyed by its seed
+  Rand::Seed(99);
+  PhiloxEngine stream = Rand::StreamEngine(3, 8);
+  EXPECT_EQ(PhiloxEngine(99, 3, 8), stream);
+}
+
+/////////////////////////////////////////////////
+TEST(PhiloxEngineTest, ParallelGaussMarkovProcesses)
+{
+  // Each process draws from its own stream, so updating the processes
+  // from any number of threads gives bit identical results.
+  const std::size_t numProcesses = 64;
+  const int numSteps = 200;
+  auto run = [&](unsigned int _numThreads)
+  {
+    std::vector<GaussMarkovProcess> processes(numProcesses);
+    std::vector<PhiloxEngine> engines;
+    for (std::size_t i = 0; i < numProcesses; ++i)
+    {
+      processes[i].Set(1.0, 0.5, 0.0, 0.2);
+      engines.push_back(PhiloxEngine(7, i));
+    }
+
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < _numThreads; ++t)
+    {
+      workers.emplace_back([&, t]()
+      {
+        for (std::size_t i = t; i < numProcesses; i += _numThreads)
+        {
+          for (int step = 0; step < numSteps; ++step)
+            processes[i].Update(std::chrono::milliseconds(10), engines[i]);
+        }
+      });
+    }
+    for (auto &worker : workers)
+      worker.join();
+
+    std::vector<double> values;
+    for (const auto &p : processes)
+      values.push_back(p.Value());
+    return values;
+  };
+
+  const std::vector<double> serial = run(1);
+  EXPECT_EQ(serial, run(3));
+  EXPECT_EQ(serial, run(8));
+
+  // The noise is not shared between processes
+  EXPECT_NE(serial[0], serial[1]);
+}
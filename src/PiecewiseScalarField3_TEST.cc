@@ -18,6 +18,8 @@
 
 #include <cmath>
 #include <functional>
+#include <limits>
+#include <vector>
 
 #include "gz/math/AdditivelySeparableScalarField3.hh"
 #include "gz/math/PiecewiseScalarField3.hh"
@@ -82,6 +84,100 @@ TEST(PiecewiseScalarField3Test, Evaluate)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(PiecewiseScalarField3Test, EvaluateIndexed)
+{
+  using ScalarField3dT = std::function<double(const math::Vector3d&)>;
+  using PiecewiseScalarField3dT = math::PiecewiseScalarField3d<ScalarField3dT>;
+
+  // A 20x10x2 grid of half open cells, with a few overlapping and empty
+  // regions, and an unbounded region at the end to fill the gaps
+  std::vector<PiecewiseScalarField3dT::Piece> pieces;
+  for (int z = 0; z < 2; ++z)
+  {
+    for (int y = 0; y < 10; ++y)
+    {
+      for (int x = 0; x < 20; ++x)
+      {
+        if ((x + y + z) % 7 == 0)
+          continue;
+        const double value = static_cast<double>(pieces.size());
+        pieces.push_back({math::Region3d(
+            math::Intervald::LeftClosed(0.5 * x, 0.5 * (x + 1)),
+            math::Intervald::LeftClosed(y, y + 1),
+            math::Intervald::LeftClosed(3 * z, 3 * (z + 1))),
+            [value](const math::Vector3d &) { return value; }});
+      }
+    }
+  }
+  pieces.push_back({math::Region3d::Closed(2., 2., 0., 2.5, 8., 6.),
+                    [](const math::Vector3d &) { return -1.; }});
+  pieces.push_back({math::Region3d::Open(1., 1., 1., 1., 1., 1.),
+                    [](const math::Vector3d &) { return -2.; }});
+  pieces.push_back({math::Region3d(
+      math::Intervald::Unbounded, math::Intervald::Unbounded,
+      math::Intervald::Open(-1., 7.)),
+      [](const math::Vector3d &v) { return -3. - v.Z(); }});
+
+  const PiecewiseScalarField3dT scalarField(pieces);
+
+  // Same result as the first piece whose region contains the point
+  auto expected = [&pieces](const math::Vector3d &_p)
+  {
+    for (const auto &piece : pieces)
+    {
+      if (piece.region.Contains(_p))
+        return piece.field(_p);
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+  };
+
+  std::vector<math::Vector3d> points;
+  for (double z = -2; z <= 8; z += 0.75)
+  {
+    for (double y = -1; y <= 11; y += 0.5)
+    {
+      for (double x = -1; x <= 11; x += 0.25)
+        points.push_back(math::Vector3d(x, y, z));
+    }
+  }
+  points.push_back(math::Vector3d(1e300, 5, 5));
+  points.push_back(math::Vector3d(-1e300, -1e300, 0));
+  points.push_back(math::Vector3d(math::INF_D, 1, 1));
+  points.push_back(math::Vector3d(math::NAN_D, 1, 1));
+
+  std::vector<double> values(points.size());
+  scalarField.Evaluate(points.data(), points.size(), values.data());
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    const double value = expected(points[i]);
+    if (std::isnan(value))
+    {
+      EXPECT_TRUE(std::isnan(scalarField(points[i]))) << points[i];
+      EXPECT_TRUE(std::isnan(values[i])) << points[i];
+    }
+    else
+    {
+      EXPECT_DOUBLE_EQ(value, scalarField(points[i])) << points[i];
+      EXPECT_DOUBLE_EQ(value, values[i]) << points[i];
+    }
+  }
+
+  // Regions which do not overlap
+  pieces.resize(pieces.size() - 3);
+  const PiecewiseScalarField3dT gridField(pieces);
+  gridField.Evaluate(points.data(), points.size(), values.data());
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    const double value = expected(points[i]);
+    if (std::isnan(value))
+      EXPECT_TRUE(std::isnan(values[i])) << points[i];
+    else
+      EXPECT_DOUBLE_EQ(value, values[i]) << points[i];
+  }
+  gridField.Evaluate(points.data(), 0, values.data());
+}
+
 /////////////////////////////////////////////////
 TEST(PiecewiseScalarField3Test, Minimum)
 {
@@ -140,6 +236,107 @@ TEST(PiecewiseScalarField3Test, Minimum)
 }
 
 
+/////////////////////////////////////////////////
+TEST(PiecewiseScalarField3Test, MinimumInRegion)
+{
+  using AdditivelySeparableScalarField3dT =
+      math::AdditivelySeparableScalarField3d<math::Polynomial3d>;
+  using PiecewiseScalarField3dT =
+      math::PiecewiseScalarField3d<AdditivelySeparableScalarField3dT>;
+
+  // A grid of pieces, each a paraboloid centered on a point which may be
+  // outside of its region, more than enough pieces to be indexed
+  std::vector<PiecewiseScalarField3dT::Piece> pieces;
+  for (int y = 0; y < 6; ++y)
+  {
+    for (int x = 0; x < 6; ++x)
+    {
+      const double cx = x + 0.3 * ((x + y) % 4);
+      const double cy = y + 0.2 * ((2 * x + y) % 5);
+      const double offset = 0.1 * ((3 * x + 5 * y) % 7);
+      pieces.push_back({math::Region3d(
+          math::Intervald::LeftClosed(x, x + 1.),
+          math::Intervald::LeftClosed(y, y + 1.),
+          math::Intervald::Closed(0., 1.)),
+          AdditivelySeparableScalarField3dT(1.,
+              math::Polynomial3d(math::Vector4d(0., 1., -2. * cx, cx * cx)),
+              math::Polynomial3d(math::Vector4d(
+                  0., 1., -2. * cy, cy * cy + offset)),
+              math::Polynomial3d::Constant(0.))});
+    }
+  }
+
+  const std::vector<math::Region3d> regions{
+      math::Region3d::Unbounded,
+      math::Region3d::Closed(0., 0., 0., 6., 6., 1.),
+      math::Region3d::Closed(1.5, 2.25, 0.5, 4.75, 3.5, 0.5),
+      math::Region3d::Open(2.9, 0.1, -1., 3.1, 5.9, 2.),
+      math::Region3d(math::Intervald::LeftClosed(5.5, 100.),
+                     math::Intervald::Unbounded,
+                     math::Intervald::Unbounded)};
+
+  for (const size_t count : {size_t{4}, pieces.size()})
+  {
+    const std::vector<PiecewiseScalarField3dT::Piece> used(
+        pieces.begin(), pieces.begin() + count);
+    const PiecewiseScalarField3dT scalarField(used);
+    for (const math::Region3d &region : regions)
+    {
+      double expected = std::numeric_limits<double>::quiet_NaN();
+      for (const auto &piece : used)
+      {
+        if (!piece.region.Intersects(region))
+          continue;
+        const double y =
+            piece.field.Minimum(piece.region.Intersection(region));
+        if (std::isnan(expected) || y < expected)
+          expected = y;
+      }
+
+      math::Vector3d pMin;
+      const double actual = scalarField.Minimum(region, pMin);
+      if (std::isnan(expected))
+      {
+        EXPECT_TRUE(std::isnan(actual)) << region;
+        EXPECT_TRUE(std::isnan(pMin.X())) << region;
+        continue;
+      }
+      EXPECT_DOUBLE_EQ(expected, actual) << region;
+
+      // The minimum of an open region may be on its boundary
+      const math::Region3d closure(
+          math::Intervald::Closed(region.Ix().LeftValue(),
+                                  region.Ix().RightValue()),
+          math::Intervald::Closed(region.Iy().LeftValue(),
+                                  region.Iy().RightValue()),
+          math::Intervald::Closed(region.Iz().LeftValue(),
+                                  region.Iz().RightValue()));
+      EXPECT_TRUE(closure.Contains(pMin)) << region << " " << pMin;
+    }
+    EXPECT_DOUBLE_EQ(scalarField.Minimum(),
+                     scalarField.Minimum(math::Region3d::Unbounded));
+
+    // Copies share the cached minima
+    const PiecewiseScalarField3dT copy = scalarField;
+    PiecewiseScalarField3dT assigned;
+    assigned = copy;
+    EXPECT_DOUBLE_EQ(scalarField.Minimum(), copy.Minimum());
+    EXPECT_DOUBLE_EQ(scalarField.Minimum(regions[3]),
+                     assigned.Minimum(regions[3]));
+  }
+
+  // Regions where the field is not defined
+  const PiecewiseScalarField3dT scalarField(pieces);
+  math::Vector3d pMin = math::Vector3d::Zero;
+  EXPECT_TRUE(std::isnan(scalarField.Minimum(
+      math::Region3d::Closed(0., 0., 2., 6., 6., 3.), pMin)));
+  EXPECT_TRUE(std::isnan(pMin.X()));
+  EXPECT_TRUE(std::isnan(scalarField.Minimum(
+      math::Region3d::Open(1., 1., 0., 1., 2., 1.))));
+  EXPECT_TRUE(std::isnan(PiecewiseScalarField3dT().Minimum(
+      math::Region3d::Unbounded)));
+}
+
 /////////////////////////////////////////////////
 TEST(PiecewiseScalarField3Test, Stream)
 {
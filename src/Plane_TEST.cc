@@ -17,8 +17,13 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/Plane.hh"
+#include "gz/math/Rand.hh"
 
 using namespace gz;
 using namespace math;
@@ -211,3 +216,260 @@ TEST(PlaneTest, Intersection)
     EXPECT_FALSE(intersect2.has_value());
   }
 }
+
+/////////////////////////////////////////////////
+/// \brief Check batch ray intersections against Intersection().
+/// \param[in] _plane Plane to intersect.
+/// \param[in] _origins Ray origins.
+/// \param[in] _directions Ray directions.
+/// \param[in] _tol Tolerance of the comparisons.
+template<typename T>
+void CheckIntersections(const Plane<T> &_plane,
+    const std::vector<Vector3<T>> &_origins,
+    const std::vector<Vector3<T>> &_directions, const T _tol)
+{
+  const Vector3SoA<T> origins(_origins);
+  const Vector3SoA<T> directions(_directions);
+  Vector3SoA<T> hits;
+  std::vector<uint8_t> valid(_origins.size(), 2);
+  std::vector<T> distances(_origins.size());
+  const std::size_t count = _plane.Intersections(origins, directions, hits,
+      valid.data(), distances.data());
+  ASSERT_EQ(_origins.size(), hits.Size());
+
+  std::size_t expectedCount = 0;
+  for (std::size_t i = 0; i < _origins.size(); ++i)
+  {
+    auto expected = _plane.Intersection(_origins[i], _directions[i]);
+    if (expected &&
+        (*expected - _origins[i]).Dot(_directions[i]) < -_tol)
+    {
+      // Behind the origin of the ray
+      expected.reset();
+    }
+
+    if (!expected)
+    {
+      EXPECT_EQ(0u, valid[i]) << i;
+      EXPECT_TRUE(std::isnan(distances[i])) << i;
+      EXPECT_TRUE(std::isnan(hits[i].X())) << i;
+      continue;
+    }
+
+    ++expectedCount;
+    EXPECT_EQ(1u, valid[i]) << i;
+    EXPECT_TRUE(expected->Equal(hits[i], _tol)) << i;
+    EXPECT_TRUE((_origins[i] + _directions[i] * distances[i]).Equal(
+        hits[i], _tol)) << i;
+    EXPECT_GE(distances[i], 0) << i;
+  }
+  EXPECT_EQ(expectedCount, count);
+
+  // Without the optional outputs
+  Vector3SoA<T> hitsOnly;
+  EXPECT_EQ(count, _plane.Intersections(origins, directions, hitsOnly,
+      nullptr, nullptr));
+  for (std::size_t i = 0; i < _origins.size(); ++i)
+  {
+    if (valid[i])
+      EXPECT_EQ(hits[i], hitsOnly[i]);
+    else
+      EXPECT_TRUE(std::isnan(hitsOnly[i].Z()));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PlaneTest, BatchIntersections)
+{
+  // Camera rays towards the ground, with enough rays to span several
+  // blocks and a partial last group of SIMD lanes.
+  const std::size_t count = 517;
+  std::vector<Vector3d> origins;
+  std::vector<Vector3d> directions;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    origins.push_back(Vector3d(Rand::DblUniform(-5, 5),
+                               Rand::DblUniform(-5, 5),
+                               Rand::DblUniform(0.5, 5)));
+    directions.push_back(Vector3d(Rand::DblUniform(-1, 1),
+                                  Rand::DblUniform(-1, 1),
+                                  Rand::DblUniform(-1, 1)).Normalized());
+  }
+
+  // Rays parallel to the plane, on it, and through the origin
+  origins[3].Set(0, 0, 1);
+  directions[3].Set(1, 0, 0);
+  origins[4].Set(0, 0, 0);
+  directions[4].Set(0, 1, 0);
+  origins[5].Set(0, 0, 0);
+  directions[5].Set(0, 0, -1);
+  origins[6].Set(1, 2, 0);
+  directions[6].Set(1, 0, 1);
+
+  CheckIntersections(Planed(Vector3d::UnitZ, 0), origins, directions, 1e-9);
+  CheckIntersections(Planed(Vector3d(0.5, 0, 1), 1), origins, directions,
+                     1e-9);
+  CheckIntersections(Planed(Vector3d(1, -1, 0.2).Normalized(), -2),
+                     origins, directions, 1e-9);
+
+  // Bounded plane
+  CheckIntersections(Planed(Vector3d(0, 0, 1), Vector2d(4, 6), 0), origins,
+                     directions, 1e-9);
+
+  // Float
+  std::vector<Vector3f> originsf;
+  std::vector<Vector3f> directionsf;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    originsf.push_back(Vector3f(origins[i].X(), origins[i].Y(),
+                                origins[i].Z()));
+    directionsf.push_back(Vector3f(directions[i].X(), directions[i].Y(),
+                                   directions[i].Z()));
+  }
+  CheckIntersections(Planef(Vector3f::UnitZ, 0), originsf, directionsf,
+                     1e-4f);
+  CheckIntersections(Planef(Vector3f(0.5f, 0, 1), 1), originsf, directionsf,
+                     1e-4f);
+
+  // No rays
+  Vector3SoA<double> hits(3);
+  EXPECT_EQ(0u, Planed(Vector3d::UnitZ, 0).Intersections(
+      Vector3SoA<double>(), Vector3SoA<double>(origins), hits, nullptr,
+      nullptr));
+  EXPECT_EQ(0u, hits.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(PlaneTest, BatchPoints)
+{
+  // Enough points to span several blocks, with a partial last block and
+  // a partial last group of SIMD lanes.
+  const std::size_t count = 517;
+  std::vector<Vector3d> points;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    points.push_back(Vector3d(Rand::DblUniform(-5, 5),
+                              Rand::DblUniform(-5, 5),
+                              Rand::DblUniform(-5, 5)));
+  }
+  // Points exactly on the planes below.
+  points[3] = Vector3d(4, -2, 1);
+  points[count - 1] = Vector3d(0, 0, 0);
+  const Vector3SoAd soa(points);
+
+  const std::vector<Planed> planes = {
+    Planed(Vector3d::UnitZ, 1),
+    Planed(Vector3d(1, 1, 0).Normalized(), 0),
+    Planed(Vector3d(-0.3, 0.5, 0.8).Normalized(), -0.4)};
+
+  std::vector<double> distances(count);
+  std::vector<double> soaDistances(count);
+  std::vector<Planed::PlaneSide> sides(count);
+  std::vector<Planed::PlaneSide> soaSides(count);
+  for (const Planed &plane : planes)
+  {
+    plane.Distances(points.data(), count, distances.data());
+    plane.Distances(soa, soaDistances.data());
+    plane.Sides(points.data(), count, sides.data());
+    plane.Sides(soa, soaSides.data());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      EXPECT_DOUBLE_EQ(plane.Distance(points[i]), distances[i]);
+      EXPECT_DOUBLE_EQ(plane.Distance(points[i]), soaDistances[i]);
+      EXPECT_EQ(plane.Side(points[i]), sides[i]) << i;
+      EXPECT_EQ(plane.Side(points[i]), soaSides[i]) << i;
+    }
+  }
+
+  // All planes at once, one row of results per plane.
+  std::vector<double> allDistances(planes.size() * count);
+  std::vector<Planed::PlaneSide> allSides(planes.size() * count);
+  std::vector<Planed::PlaneSide> allSoaSides(planes.size() * count);
+  Planed::Distances(planes.data(), planes.size(), points.data(), count,
+                    allDistances.data());
+  Planed::Sides(planes.data(), planes.size(), points.data(), count,
+                allSides.data());
+  Planed::Sides(planes.data(), planes.size(), soa, allSoaSides.data());
+  for (std::size_t p = 0; p < planes.size(); ++p)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      EXPECT_DOUBLE_EQ(planes[p].Distance(points[i]),
+                       allDistances[p * count + i]);
+      EXPECT_EQ(planes[p].Side(points[i]), allSides[p * count + i]);
+      EXPECT_EQ(planes[p].Side(points[i]), allSoaSides[p * count + i]);
+    }
+  }
+  EXPECT_EQ(Planed::NO_SIDE, allSides[3]);
+  EXPECT_EQ(Planed::NO_SIDE, allSoaSides[2 * count - 1]);
+
+  // Empty batches write nothing.
+  Planed::Sides(planes.data(), planes.size(), points.data(), 0, nullptr);
+  planes[0].Distances(Vector3SoAd(), nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST(PlaneTest, BatchPointsFloat)
+{
+  const std::size_t count = 43;
+  std::vector<Vector3f> points;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    points.push_back(Vector3f(static_cast<float>(i) - 20.0f,
+                              0.5f * static_cast<float>(i % 7),
+                              -2.0f));
+  }
+  const Planef plane(Vector3f::UnitX, 1.0f);
+
+  std::vector<float> distances(count);
+  std::vector<Planef::PlaneSide> sides(count);
+  plane.Distances(points.data(), count, distances.data());
+  plane.Sides(Vector3SoAf(points), sides.data());
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    EXPECT_FLOAT_EQ(plane.Distance(points[i]), distances[i]);
+    EXPECT_EQ(plane.Side(points[i]), sides[i]);
+  }
+  EXPECT_EQ(Planef::NO_SIDE, sides[21]);
+}
+
+/////////////////////////////////////////////////
+TEST(PlaneTest, BatchAxisAlignedBoxes)
+{
+  const std::size_t count = 301;
+  std::vector<AxisAlignedBox> boxes;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const Vector3d center(Rand::DblUniform(-5, 5),
+                          Rand::DblUniform(-5, 5),
+                          Rand::DblUniform(-5, 5));
+    const Vector3d half(Rand::DblUniform(0, 2),
+                        Rand::DblUniform(0, 2),
+                        Rand::DblUniform(0, 2));
+    boxes.push_back(AxisAlignedBox(center - half, center + half));
+  }
+  // A box touching the plane, a point box on the plane and an empty box.
+  boxes[0] = AxisAlignedBox(Vector3d(0, 0, 1), Vector3d(1, 1, 2));
+  boxes[1] = AxisAlignedBox(Vector3d(2, 3, 1), Vector3d(2, 3, 1));
+  boxes[2] = AxisAlignedBox();
+
+  const std::vector<Planed> planes = {
+    Planed(Vector3d::UnitZ, 1),
+    Planed(Vector3d(1, -2, 0.5).Normalized(), 0.25)};
+
+  std::vector<Planed::PlaneSide> sides(count);
+  planes[0].Sides(boxes.data(), count, sides.data());
+  for (std::size_t i = 0; i < count; ++i)
+    EXPECT_EQ(planes[0].Side(boxes[i]), sides[i]) << i;
+  EXPECT_EQ(Planed::BOTH_SIDE, sides[0]);
+  EXPECT_EQ(Planed::BOTH_SIDE, sides[1]);
+
+  std::vector<Planed::PlaneSide> allSides(planes.size() * count);
+  Planed::Sides(planes.data(), planes.size(), boxes.data(), count,
+                allSides.data());
+  for (std::size_t p = 0; p < planes.size(); ++p)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+      EXPECT_EQ(planes[p].Side(boxes[i]), allSides[p * count + i]) << i;
+  }
+}
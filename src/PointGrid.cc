@@ -0,0 +1,642 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/PointGrid.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Cell coordinates are clamped to [-kCellLimit, kCellLimit), so
+  /// that the three coordinates of a cell fit in a 64 bit key.
+  constexpr int64_t kCellLimit = int64_t(1) << 20;
+
+  /// \brief Key of the empty slots of the hash table.
+  constexpr uint64_t kEmptyKey = std::numeric_limits<uint64_t>::max();
+
+  /// \brief Minimum number of points for each thread of a build.
+  constexpr std::size_t kMinPointsPerThread = 16384;
+
+  /// \brief An occupied cell, stored in the hash table.
+  struct Cell
+  {
+    /// \brief Key of the cell, kEmptyKey for an empty slot.
+    uint64_t key = kEmptyKey;
+
+    /// \brief First point of the cell.
+    uint32_t begin = 0;
+
+    /// \brief One past the last point of the cell.
+    uint32_t end = 0;
+  };
+
+  /// \brief A point found by a nearest neighbor search, ordered by
+  /// squared distance then index.
+  using Candidate = std::pair<double, std::size_t>;
+
+  /// \brief Get the key of a cell.
+  /// \param[in] _x X coordinate of the cell.
+  /// \param[in] _y Y coordinate of the cell.
+  /// \param[in] _z Z coordinate of the cell.
+  /// \return The key.
+  uint64_t Key(const int64_t _x, const int64_t _y, const int64_t _z)
+  {
+    return (static_cast<uint64_t>(_x + kCellLimit) << 42) |
+           (static_cast<uint64_t>(_y + kCellLimit) << 21) |
+           static_cast<uint64_t>(_z + kCellLimit);
+  }
+
+  /// \brief Get one coordinate of a cell from its key.
+  /// \param[in] _key Key of the cell.
+  /// \param[in] _axis Axis of the coordinate.
+  /// \return The coordinate.
+  int64_t Coordinate(const uint64_t _key, const int _axis)
+  {
+    return static_cast<int64_t>((_key >> (42 - 21 * _axis)) & 0x1FFFFF) -
+      kCellLimit;
+  }
+}
+
+/// \brief Private data for the PointGrid class.
+class gz::math::PointGridPrivate
+{
+  /// \brief Get the coordinate of the cell of a value along an axis.
+  /// \param[in] _value The value.
+  /// \return The coordinate, clamped to the range of the keys.
+  public: int64_t CellOf(const double _value) const
+  {
+    // Written so that NaN gives the lowest cell.
+    const double cell = std::floor(_value * this->inverse);
+    if (cell >= static_cast<double>(kCellLimit - 1))
+      return kCellLimit - 1;
+    if (cell >= static_cast<double>(-kCellLimit))
+      return static_cast<int64_t>(cell);
+    return -kCellLimit;
+  }
+
+  /// \brief Get the key of the cell of a point.
+  /// \param[in] _point The point.
+  /// \return The key.
+  public: uint64_t KeyOf(const Vector3d &_point) const
+  {
+    return Key(this->CellOf(_point.X()), this->CellOf(_point.Y()),
+               this->CellOf(_point.Z()));
+  }
+
+  /// \brief Get the slot of a key in the hash table.
+  /// \param[in] _key The key.
+  /// \return The first slot to probe.
+  public: std::size_t Slot(const uint64_t _key) const
+  {
+    return static_cast<std::size_t>(
+        (_key * 0x9E3779B97F4A7C15ull) >> 32) & this->mask;
+  }
+
+  /// \brief Find a cell.
+  /// \param[in] _key Key of the cell.
+  /// \return The cell, or nullptr if it holds no point.
+  public: const Cell *Find(const uint64_t _key) const
+  {
+    for (std::size_t slot = this->Slot(_key);;
+         slot = (slot + 1) & this->mask)
+    {
+      const Cell &cell = this->table[slot];
+      if (cell.key == _key)
+        return &cell;
+      if (cell.key == kEmptyKey)
+        return nullptr;
+    }
+  }
+
+  /// \brief Call a function for each occupied cell in a range of cells.
+  /// When the range has more cells than the grid holds, the occupied
+  /// cells are scanned instead.
+  /// \param[in] _min Minimum cell coordinates, inclusive.
+  /// \param[in] _max Maximum cell coordinates, inclusive.
+  /// \param[in] _f Function called with each cell.
+  public: template<typename F>
+  void ForCells(int64_t _min[3], int64_t _max[3], const F &_f) const
+  {
+    double volume = 1;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      _min[axis] = std::max(_min[axis], this->cellMin[axis]);
+      _max[axis] = std::min(_max[axis], this->cellMax[axis]);
+      if (_min[axis] > _max[axis])
+        return;
+      volume *= static_cast<double>(_max[axis] - _min[axis] + 1);
+    }
+
+    if (volume > static_cast<double>(this->cellCount))
+    {
+      for (const Cell &cell : this->table)
+      {
+        if (cell.key == kEmptyKey)
+          continue;
+        bool inside = true;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          const int64_t c = Coordinate(cell.key, axis);
+          inside = inside && c >= _min[axis] && c <= _max[axis];
+        }
+        if (inside)
+          _f(cell);
+      }
+      return;
+    }
+
+    for (int64_t x = _min[0]; x <= _max[0]; ++x)
+    {
+      for (int64_t y = _min[1]; y <= _max[1]; ++y)
+      {
+        for (int64_t z = _min[2]; z <= _max[2]; ++z)
+        {
+          const Cell *cell = this->Find(Key(x, y, z));
+          if (cell)
+            _f(*cell);
+        }
+      }
+    }
+  }
+
+  /// \brief Add the points of a cell to a max-heap of the nearest points.
+  /// \param[in] _cell The cell.
+  /// \param[in] _point Location of the search.
+  /// \param[in] _k Number of points to find.
+  /// \param[in] _maxDistanceSquared Squared maximum distance.
+  /// \param[in,out] _heap Max-heap of the points found.
+  public: void AddCandidates(const Cell &_cell, const Vector3d &_point,
+      const std::size_t _k, const double _maxDistanceSquared,
+      std::vector<Candidate> &_heap) const
+  {
+    for (uint32_t i = _cell.begin; i < _cell.end; ++i)
+    {
+      const Candidate candidate(
+          (this->points[i] - _point).SquaredLength(), this->indices[i]);
+      if (candidate.first > _maxDistanceSquared)
+        continue;
+      if (_heap.size() < _k)
+      {
+        _heap.push_back(candidate);
+        std::push_heap(_heap.begin(), _heap.end());
+      }
+      else if (candidate < _heap.front())
+      {
+        std::pop_heap(_heap.begin(), _heap.end());
+        _heap.back() = candidate;
+        std::push_heap(_heap.begin(), _heap.end());
+      }
+    }
+  }
+
+  /// \brief Find the points nearest to a location, visiting the cells in
+  /// shells of growing Chebyshev distance around the cell of the
+  /// location. Points in the shell r + 1 or beyond are at least r cell
+  /// sizes, plus the distance from the location to the faces of its cell,
+  /// away, clamped cells included, which ends the search.
+  /// \param[in] _point The location.
+  /// \param[in] _k Number of points to find.
+  /// \param[in] _maxDistanceSquared Squared maximum distance.
+  /// \param[out] _heap Max-heap of the points found.
+  public: void Search(const Vector3d &_point, const std::size_t _k,
+      const double _maxDistanceSquared, std::vector<Candidate> &_heap) const
+  {
+    _heap.clear();
+    if (this->points.empty() || _k == 0)
+      return;
+
+    const int64_t center[3] = {this->CellOf(_point.X()),
+        this->CellOf(_point.Y()), this->CellOf(_point.Z())};
+    int64_t maxShell = 0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      maxShell = std::max({maxShell, center[axis] - this->cellMin[axis],
+                           this->cellMax[axis] - center[axis]});
+    }
+
+    // Distance from the location to the nearest face of its cell. When
+    // the cell of the location is clamped, the faces are not known.
+    double margin = 0;
+    if (center[0] > -kCellLimit && center[0] < kCellLimit - 1 &&
+        center[1] > -kCellLimit && center[1] < kCellLimit - 1 &&
+        center[2] > -kCellLimit && center[2] < kCellLimit - 1)
+    {
+      margin = this->cellSize;
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        const double offset = _point[axis] -
+          static_cast<double>(center[axis]) * this->cellSize;
+        margin = std::min({margin, offset, this->cellSize - offset});
+      }
+      margin = std::max(margin, 0.0);
+    }
+
+    for (int64_t r = 0; r <= maxShell; ++r)
+    {
+      if (r > 0)
+      {
+        const double reach =
+          static_cast<double>(r - 1) * this->cellSize + margin;
+        const double bound =
+          _heap.size() < _k ? _maxDistanceSquared : _heap.front().first;
+        if (reach * reach > bound)
+          return;
+      }
+
+      // Scan all the points when the shell has more cells than the grid.
+      const double side = static_cast<double>(2 * r + 1);
+      if (side * side * side > 8.0 * static_cast<double>(this->cellCount))
+      {
+        _heap.clear();
+        Cell all;
+        all.end = static_cast<uint32_t>(this->points.size());
+        this->AddCandidates(all, _point, _k, _maxDistanceSquared, _heap);
+        return;
+      }
+
+      for (int64_t dx = -r; dx <= r; ++dx)
+      {
+        for (int64_t dy = -r; dy <= r; ++dy)
+        {
+          // Inside the shell, only the two cells at dz = -r and r.
+          const bool face = dx == -r || dx == r || dy == -r || dy == r;
+          const int64_t step = face || r == 0 ? 1 : 2 * r;
+          for (int64_t dz = -r; dz <= r; dz += step)
+          {
+            const int64_t x = center[0] + dx;
+            const int64_t y = center[1] + dy;
+            const int64_t z = center[2] + dz;
+            if (x < this->cellMin[0] || x > this->cellMax[0] ||
+                y < this->cellMin[1] || y > this->cellMax[1] ||
+                z < this->cellMin[2] || z > this->cellMax[2])
+            {
+              continue;
+            }
+            const Cell *cell = this->Find(Key(x, y, z));
+            if (cell)
+            {
+              this->AddCandidates(*cell, _point, _k, _maxDistanceSquared,
+                                  _heap);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /// \brief Requested cell size, 0 to choose it in Build().
+  public: double requestedSize = 0;
+
+  /// \brief Cell size of the last build.
+  public: double cellSize = 0;
+
+  /// \brief Inverse of the cell size.
+  public: double inverse = 0;
+
+  /// \brief Points, in the order of their cells.
+  public: std::vector<Vector3d> points;
+
+  /// \brief Index passed to Build() of each point.
+  public: std::vector<std::size_t> indices;
+
+  /// \brief Hash table of the occupied cells, with linear probing.
+  public: std::vector<Cell> table;
+
+  /// \brief Size of the hash table minus one.
+  public: std::size_t mask = 0;
+
+  /// \brief Number of occupied cells.
+  public: std::size_t cellCount = 0;
+
+  /// \brief Minimum coordinates of the occupied cells.
+  public: int64_t cellMin[3] = {0, 0, 0};
+
+  /// \brief Maximum coordinates of the occupied cells.
+  public: int64_t cellMax[3] = {-1, -1, -1};
+
+  /// \brief Minimum corner of the bounds of the points.
+  public: Vector3d min;
+
+  /// \brief Maximum corner of the bounds of the points.
+  public: Vector3d max;
+};
+
+/////////////////////////////////////////////////
+PointGrid::PointGrid()
+  : dataPtr(std::make_unique<PointGridPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+PointGrid::PointGrid(const double _cellSize)
+  : PointGrid()
+{
+  this->SetCellSize(_cellSize);
+}
+
+/////////////////////////////////////////////////
+PointGrid::PointGrid(const PointGrid &_grid)
+  : dataPtr(std::make_unique<PointGridPrivate>(*_grid.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+PointGrid::~PointGrid() = default;
+
+/////////////////////////////////////////////////
+PointGrid &PointGrid::operator=(const PointGrid &_grid)
+{
+  *this->dataPtr = *_grid.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+double PointGrid::CellSize() const
+{
+  if (this->dataPtr->cellSize > 0)
+    return this->dataPtr->cellSize;
+  return this->dataPtr->requestedSize;
+}
+
+/////////////////////////////////////////////////
+void PointGrid::SetCellSize(const double _cellSize)
+{
+  this->dataPtr->requestedSize =
+    _cellSize > 0 && std::isfinite(_cellSize) ? _cellSize : 0.0;
+}
+
+/////////////////////////////////////////////////
+void PointGrid::Build(const std::vector<Vector3d> &_points)
+{
+  this->Build(_points, 1);
+}
+
+/////////////////////////////////////////////////
+void PointGrid::Build(const std::vector<Vector3d> &_points,
+    const unsigned int _threads)
+{
+  auto &d = *this->dataPtr;
+  d.points.clear();
+  d.indices.clear();
+  d.table.clear();
+  d.mask = 0;
+  d.cellCount = 0;
+  d.cellSize = 0;
+  std::fill(d.cellMin, d.cellMin + 3, 0);
+  std::fill(d.cellMax, d.cellMax + 3, -1);
+
+  if (_points.size() >= std::numeric_limits<uint32_t>::max())
+  {
+    IGN_MATH_DIAGNOSTIC("PointGrid::Build() error: too many points ["
+        << _points.size() << "]");
+    return;
+  }
+
+  std::size_t count = 0;
+  for (const Vector3d &point : _points)
+  {
+    if (!point.IsFinite())
+      continue;
+    if (count == 0)
+    {
+      d.min = point;
+      d.max = point;
+    }
+    d.min.Min(point);
+    d.max.Max(point);
+    ++count;
+  }
+  if (count == 0)
+    return;
+
+  d.cellSize = d.requestedSize;
+  if (d.cellSize <= 0)
+  {
+    // Aim for two points per cell over the axes along which the points
+    // spread, so that flat or linear sets get cells of a useful size.
+    const Vector3d extent = d.max - d.min;
+    double volume = 1;
+    int dimensions = 0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (extent[axis] > 1e-3 * extent.Max())
+      {
+        volume *= extent[axis];
+        ++dimensions;
+      }
+    }
+    d.cellSize = dimensions == 0 ? 1.0 : std::pow(
+        2.0 * volume / static_cast<double>(count), 1.0 / dimensions);
+  }
+  d.inverse = 1.0 / d.cellSize;
+
+  // Find the cell of every point, in parallel for large sets.
+  std::vector<std::pair<uint64_t, uint32_t>> keys(_points.size());
+  auto computeKeys = [&](const std::size_t _begin, const std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      keys[i].first = _points[i].IsFinite() ? d.KeyOf(_points[i]) :
+        kEmptyKey;
+      keys[i].second = static_cast<uint32_t>(i);
+    }
+  };
+  unsigned int threads = _threads;
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = static_cast<unsigned int>(std::max<std::size_t>(1,
+      std::min<std::size_t>(threads, _points.size() / kMinPointsPerThread)));
+  std::vector<std::thread> workers;
+  for (unsigned int t = 1; t < threads; ++t)
+  {
+    workers.emplace_back(computeKeys, _points.size() * t / threads,
+                         _points.size() * (t + 1) / threads);
+  }
+  computeKeys(0, _points.size() / threads);
+  for (auto &worker : workers)
+    worker.join();
+
+  // Sort the points by cell. The points that are not finite sort last.
+  std::sort(keys.begin(), keys.end());
+  keys.resize(count);
+  d.points.reserve(count);
+  d.indices.reserve(count);
+  for (const auto &key : keys)
+  {
+    d.points.push_back(_points[key.second]);
+    d.indices.push_back(key.second);
+  }
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (i == 0 || keys[i].first != keys[i - 1].first)
+      ++d.cellCount;
+  }
+  std::size_t capacity = 16;
+  while (capacity < 2 * d.cellCount)
+    capacity *= 2;
+  d.table.assign(capacity, Cell());
+  d.mask = capacity - 1;
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    d.cellMin[axis] = kCellLimit;
+    d.cellMax[axis] = -kCellLimit;
+  }
+  for (std::size_t begin = 0; begin < count;)
+  {
+    const uint64_t key = keys[begin].first;
+    std::size_t end = begin + 1;
+    while (end < count && keys[end].first == key)
+      ++end;
+
+    std::size_t slot = d.Slot(key);
+    while (d.table[slot].key != kEmptyKey)
+      slot = (slot + 1) & d.mask;
+    d.table[slot].key = key;
+    d.table[slot].begin = static_cast<uint32_t>(begin);
+    d.table[slot].end = static_cast<uint32_t>(end);
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      d.cellMin[axis] = std::min(d.cellMin[axis], Coordinate(key, axis));
+      d.cellMax[axis] = std::max(d.cellMax[axis], Coordinate(key, axis));
+    }
+    begin = end;
+  }
+}
+
+/////////////////////////////////////////////////
+std::size_t PointGrid::Size() const
+{
+  return this->dataPtr->points.size();
+}
+
+/////////////////////////////////////////////////
+std::size_t PointGrid::CellCount() const
+{
+  return this->dataPtr->cellCount;
+}
+
+/////////////////////////////////////////////////
+AxisAlignedBox PointGrid::Bounds() const
+{
+  if (this->dataPtr->points.empty())
+    return AxisAlignedBox();
+  return AxisAlignedBox(this->dataPtr->min, this->dataPtr->max);
+}
+
+/////////////////////////////////////////////////
+std::tuple<bool, double, std::size_t> PointGrid::Nearest(
+    const Vector3d &_point, const double _maxDistance) const
+{
+  std::vector<Candidate> heap;
+  if (_maxDistance >= 0 && _point.IsFinite())
+    this->dataPtr->Search(_point, 1, _maxDistance * _maxDistance, heap);
+  if (heap.empty())
+    return std::make_tuple(false, 0.0, kNoPoint);
+  return std::make_tuple(true, std::sqrt(heap[0].first), heap[0].second);
+}
+
+/////////////////////////////////////////////////
+void PointGrid::Nearest(const Vector3d &_point, const std::size_t _k,
+    std::vector<std::size_t> &_indices) const
+{
+  std::vector<Candidate> heap;
+  if (_point.IsFinite())
+  {
+    this->dataPtr->Search(_point, _k,
+        std::numeric_limits<double>::infinity(), heap);
+  }
+  std::sort_heap(heap.begin(), heap.end());
+  _indices.clear();
+  for (const Candidate &candidate : heap)
+    _indices.push_back(candidate.second);
+}
+
+/////////////////////////////////////////////////
+void PointGrid::Overlaps(const Vector3d &_center, const double _radius,
+    std::vector<std::size_t> &_indices) const
+{
+  const auto &d = *this->dataPtr;
+  _indices.clear();
+  if (d.points.empty() || !(_radius >= 0))
+    return;
+
+  const double radiusSquared = _radius * _radius;
+  int64_t min[3];
+  int64_t max[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    min[axis] = d.CellOf(_center[axis] - _radius);
+    max[axis] = d.CellOf(_center[axis] + _radius);
+  }
+  d.ForCells(min, max, [&](const Cell &_cell)
+  {
+    for (uint32_t i = _cell.begin; i < _cell.end; ++i)
+    {
+      if ((d.points[i] - _center).SquaredLength() <= radiusSquared)
+        _indices.push_back(d.indices[i]);
+    }
+  });
+}
+
+/////////////////////////////////////////////////
+void PointGrid::Overlaps(const AxisAlignedBox &_box,
+    std::vector<std::size_t> &_indices) const
+{
+  const auto &d = *this->dataPtr;
+  _indices.clear();
+  const Vector3d &boxMin = _box.Min();
+  const Vector3d &boxMax = _box.Max();
+  if (d.points.empty() || boxMin.X() > boxMax.X() ||
+      boxMin.Y() > boxMax.Y() || boxMin.Z() > boxMax.Z())
+  {
+    return;
+  }
+
+  int64_t min[3];
+  int64_t max[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    min[axis] = d.CellOf(boxMin[axis]);
+    max[axis] = d.CellOf(boxMax[axis]);
+  }
+  d.ForCells(min, max, [&](const Cell &_cell)
+  {
+    for (uint32_t i = _cell.begin; i < _cell.end; ++i)
+    {
+      const Vector3d &p = d.points[i];
+      if (p.X() >= boxMin.X() && p.Y() >= boxMin.Y() &&
+          p.Z() >= boxMin.Z() && p.X() <= boxMax.X() &&
+          p.Y() <= boxMax.Y() && p.Z() <= boxMax.Z())
+      {
+        _indices.push_back(d.indices[i]);
+      }
+    }
+  });
+}
@@ -0,0 +1,577 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/PointOctree.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Maximum number of points in a leaf, unless the leaf is at the
+  /// maximum depth.
+  constexpr std::size_t kLeafSize = 8;
+
+  /// \brief Maximum depth of a leaf, which bounds the octree when many
+  /// points are at the same place.
+  constexpr int kMaxDepth = 21;
+
+  /// \brief Number of entries of the traversal stacks, enough for the
+  /// deepest octree since each level leaves at most seven nodes on it.
+  constexpr std::size_t kStackSize = 8 * (kMaxDepth + 1);
+
+  /// \brief Minimum number of points for a parallel build.
+  constexpr std::size_t kMinPointsPerThread = 16384;
+
+  /// \brief A node of the octree.
+  struct Node
+  {
+    /// \brief Minimum corner of the bounds of the points of the node.
+    Vector3d min;
+
+    /// \brief Maximum corner of the bounds of the points of the node.
+    Vector3d max;
+
+    /// \brief First point of the node.
+    uint32_t begin = 0;
+
+    /// \brief One past the last point of the node.
+    uint32_t end = 0;
+
+    /// \brief First child. The children are contiguous.
+    uint32_t firstChild = 0;
+
+    /// \brief Number of children, 0 for a leaf.
+    uint32_t childCount = 0;
+  };
+
+  /// \brief A point with its index, used during the build.
+  struct Item
+  {
+    /// \brief The point.
+    Vector3d point;
+
+    /// \brief Index of the point passed to Build().
+    std::size_t index;
+  };
+
+  /// \brief A point found by a nearest neighbor search, ordered by
+  /// squared distance then index.
+  using Candidate = std::pair<double, std::size_t>;
+
+  /// \brief Get the squared distance from a point to a box.
+  /// \param[in] _p The point.
+  /// \param[in] _min Minimum corner of the box.
+  /// \param[in] _max Maximum corner of the box.
+  /// \return Squared distance, 0 if the point is inside.
+  double DistanceSquared(const Vector3d &_p, const Vector3d &_min,
+                         const Vector3d &_max)
+  {
+    const double dx = std::max({_min.X() - _p.X(), 0.0, _p.X() - _max.X()});
+    const double dy = std::max({_min.Y() - _p.Y(), 0.0, _p.Y() - _max.Y()});
+    const double dz = std::max({_min.Z() - _p.Z(), 0.0, _p.Z() - _max.Z()});
+    return dx * dx + dy * dy + dz * dz;
+  }
+
+  /// \brief Get the squared distance from a point to the farthest corner
+  /// of a box.
+  /// \param[in] _p The point.
+  /// \param[in] _min Minimum corner of the box.
+  /// \param[in] _max Maximum corner of the box.
+  /// \return Squared distance.
+  double FarthestSquared(const Vector3d &_p, const Vector3d &_min,
+                         const Vector3d &_max)
+  {
+    const double dx = std::max(_p.X() - _min.X(), _max.X() - _p.X());
+    const double dy = std::max(_p.Y() - _min.Y(), _max.Y() - _p.Y());
+    const double dz = std::max(_p.Z() - _min.Z(), _max.Z() - _p.Z());
+    return dx * dx + dy * dy + dz * dz;
+  }
+}
+
+/// \brief Private data for the PointOctree class.
+class gz::math::PointOctreePrivate
+{
+  /// \brief Compute the bounds of a node and split it into the octants of
+  /// its cube that hold points.
+  /// \param[in] _nodes Nodes of the subtree being built.
+  /// \param[in] _index Index of the node in _nodes.
+  /// \param[in] _center Center of the cube of the node.
+  /// \param[in] _half Half the side of the cube.
+  /// \param[in] _depth Depth of the node.
+  /// \param[out] _centers Centers of the cubes of the children.
+  /// \return False if the node is a leaf.
+  public: bool Split(std::vector<Node> &_nodes, const std::size_t _index,
+      const Vector3d &_center, const double _half, const int _depth,
+      Vector3d _centers[8])
+  {
+    const uint32_t begin = _nodes[_index].begin;
+    const uint32_t end = _nodes[_index].end;
+    Vector3d min = this->items[begin].point;
+    Vector3d max = min;
+    for (uint32_t i = begin + 1; i < end; ++i)
+    {
+      min.Min(this->items[i].point);
+      max.Max(this->items[i].point);
+    }
+    _nodes[_index].min = min;
+    _nodes[_index].max = max;
+
+    if (end - begin <= kLeafSize || _depth >= kMaxDepth)
+      return false;
+
+    // Partition along X, then each half along Y, then each quarter
+    // along Z, which orders the points by octant.
+    const auto first = this->items.begin();
+    uint32_t bounds[9];
+    bounds[0] = begin;
+    bounds[8] = end;
+    auto split = [&](const int _axis, const uint32_t _from,
+                     const uint32_t _to)
+    {
+      return static_cast<uint32_t>(std::partition(first + _from,
+          first + _to, [&](const Item &_item)
+          {
+            return _item.point[_axis] < _center[_axis];
+          }) - first);
+    };
+    bounds[4] = split(0, begin, end);
+    bounds[2] = split(1, begin, bounds[4]);
+    bounds[6] = split(1, bounds[4], end);
+    for (int i = 0; i < 8; i += 2)
+      bounds[i + 1] = split(2, bounds[i], bounds[i + 2]);
+
+    const double quarter = _half * 0.5;
+    const auto firstChild = static_cast<uint32_t>(_nodes.size());
+    uint32_t childCount = 0;
+    for (int octant = 0; octant < 8; ++octant)
+    {
+      if (bounds[octant] == bounds[octant + 1])
+        continue;
+      Node child;
+      child.begin = bounds[octant];
+      child.end = bounds[octant + 1];
+      _nodes.push_back(child);
+      _centers[childCount++] = _center + Vector3d(
+          (octant & 4) ? quarter : -quarter,
+          (octant & 2) ? quarter : -quarter,
+          (octant & 1) ? quarter : -quarter);
+    }
+    _nodes[_index].firstChild = firstChild;
+    _nodes[_index].childCount = childCount;
+    return true;
+  }
+
+  /// \brief Build the subtree of a node.
+  /// \param[in] _nodes Nodes of the subtree being built.
+  /// \param[in] _index Index of the node in _nodes.
+  /// \param[in] _center Center of the cube of the node.
+  /// \param[in] _half Half the side of the cube.
+  /// \param[in] _depth Depth of the node.
+  public: void BuildNode(std::vector<Node> &_nodes, const std::size_t _index,
+      const Vector3d &_center, const double _half, const int _depth)
+  {
+    Vector3d centers[8];
+    if (!this->Split(_nodes, _index, _center, _half, _depth, centers))
+      return;
+
+    const uint32_t firstChild = _nodes[_index].firstChild;
+    const uint32_t childCount = _nodes[_index].childCount;
+    for (uint32_t i = 0; i < childCount; ++i)
+    {
+      this->BuildNode(_nodes, firstChild + i, centers[i], _half * 0.5,
+                      _depth + 1);
+    }
+  }
+
+  /// \brief Build the octree, with the subtrees of the children of the
+  /// root built concurrently. Each subtree is built in its own vector and
+  /// appended in order, which gives the same nodes as BuildNode().
+  /// \param[in] _center Center of the cube of the root.
+  /// \param[in] _half Half the side of the cube.
+  /// \param[in] _threads Number of threads.
+  public: void BuildParallel(const Vector3d &_center, const double _half,
+                             const unsigned int _threads)
+  {
+    Vector3d centers[8];
+    if (!this->Split(this->nodes, 0, _center, _half, 0, centers))
+      return;
+
+    const uint32_t childCount = this->nodes[0].childCount;
+    std::vector<std::vector<Node>> subtrees(childCount);
+    std::atomic<uint32_t> next(0);
+    auto work = [&]()
+    {
+      for (uint32_t i = next++; i < childCount; i = next++)
+      {
+        subtrees[i].push_back(this->nodes[1 + i]);
+        this->BuildNode(subtrees[i], 0, centers[i], _half * 0.5, 1);
+      }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned int t = 1; t < std::min(_threads, childCount); ++t)
+      workers.emplace_back(work);
+    work();
+    for (auto &worker : workers)
+      worker.join();
+
+    for (uint32_t i = 0; i < childCount; ++i)
+    {
+      // Node k > 0 of a subtree goes to base + k - 1.
+      const auto base = static_cast<uint32_t>(this->nodes.size());
+      for (Node &node : subtrees[i])
+      {
+        if (node.childCount > 0)
+          node.firstChild += base - 1;
+      }
+      this->nodes[1 + i] = subtrees[i][0];
+      this->nodes.insert(this->nodes.end(), subtrees[i].begin() + 1,
+                         subtrees[i].end());
+    }
+  }
+
+  /// \brief Find the points nearest to a location, visiting the nearest
+  /// children first and skipping the nodes farther than the farthest
+  /// point found.
+  /// \param[in] _point The location.
+  /// \param[in] _k Number of points to find.
+  /// \param[in] _maxDistanceSquared Squared maximum distance.
+  /// \param[out] _heap Max-heap of the points found.
+  public: void Search(const Vector3d &_point, const std::size_t _k,
+      const double _maxDistanceSquared, std::vector<Candidate> &_heap) const
+  {
+    _heap.clear();
+    if (this->nodes.empty() || _k == 0)
+      return;
+
+    auto bound = [&]()
+    {
+      return _heap.size() < _k ? _maxDistanceSquared : _heap.front().first;
+    };
+
+    Candidate stack[kStackSize];
+    std::size_t top = 0;
+    stack[top++] = Candidate(
+        DistanceSquared(_point, this->nodes[0].min, this->nodes[0].max), 0);
+    while (top > 0)
+    {
+      const Candidate entry = stack[--top];
+      if (entry.first > bound())
+        continue;
+
+      const Node &node = this->nodes[entry.second];
+      if (node.childCount == 0)
+      {
+        for (uint32_t i = node.begin; i < node.end; ++i)
+        {
+          const Candidate candidate(
+              (this->points[i] - _point).SquaredLength(), this->indices[i]);
+          if (candidate.first > _maxDistanceSquared)
+            continue;
+          if (_heap.size() < _k)
+          {
+            _heap.push_back(candidate);
+            std::push_heap(_heap.begin(), _heap.end());
+          }
+          else if (candidate < _heap.front())
+          {
+            std::pop_heap(_heap.begin(), _heap.end());
+            _heap.back() = candidate;
+            std::push_heap(_heap.begin(), _heap.end());
+          }
+        }
+        continue;
+      }
+
+      // Push the farthest children first so that the nearest are popped
+      // first.
+      const std::size_t childrenTop = top;
+      for (uint32_t c = 0; c < node.childCount; ++c)
+      {
+        const Node &child = this->nodes[node.firstChild + c];
+        const double distance = DistanceSquared(_point, child.min, child.max);
+        if (distance > bound())
+          continue;
+        std::size_t i = top++;
+        while (i > childrenTop && stack[i - 1].first < distance)
+        {
+          stack[i] = stack[i - 1];
+          --i;
+        }
+        stack[i] = Candidate(distance, node.firstChild + c);
+      }
+    }
+  }
+
+  /// \brief Report the points of the nodes that pass a test.
+  /// \param[in] _test Function called with a node. It returns 0 to skip
+  /// the node, 1 to test its points or children, and 2 to report all its
+  /// points.
+  /// \param[in] _contains Function that tests a point.
+  /// \param[out] _indices Indices of the points found.
+  public: template<typename NodeTest, typename PointTest>
+  void Collect(const NodeTest &_test, const PointTest &_contains,
+               std::vector<std::size_t> &_indices) const
+  {
+    _indices.clear();
+    if (this->nodes.empty())
+      return;
+
+    uint32_t stack[kStackSize];
+    std::size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+      const Node &node = this->nodes[stack[--top]];
+      const int result = _test(node);
+      if (result == 0)
+        continue;
+
+      if (result == 2)
+      {
+        _indices.insert(_indices.end(), this->indices.begin() + node.begin,
+                        this->indices.begin() + node.end);
+      }
+      else if (node.childCount == 0)
+      {
+        for (uint32_t i = node.begin; i < node.end; ++i)
+        {
+          if (_contains(this->points[i]))
+            _indices.push_back(this->indices[i]);
+        }
+      }
+      else
+      {
+        for (uint32_t c = 0; c < node.childCount; ++c)
+          stack[top++] = node.firstChild + c;
+      }
+    }
+  }
+
+  /// \brief Points and their indices during the build.
+  public: std::vector<Item> items;
+
+  /// \brief Points, in the order of the leaves.
+  public: std::vector<Vector3d> points;
+
+  /// \brief Index passed to Build() of each point.
+  public: std::vector<std::size_t> indices;
+
+  /// \brief Nodes, with the root first.
+  public: std::vector<Node> nodes;
+};
+
+/////////////////////////////////////////////////
+PointOctree::PointOctree()
+  : dataPtr(std::make_unique<PointOctreePrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+PointOctree::PointOctree(const std::vector<Vector3d> &_points)
+  : PointOctree()
+{
+  this->Build(_points);
+}
+
+/////////////////////////////////////////////////
+PointOctree::PointOctree(const PointOctree &_octree)
+  : dataPtr(std::make_unique<PointOctreePrivate>(*_octree.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+PointOctree::~PointOctree() = default;
+
+/////////////////////////////////////////////////
+PointOctree &PointOctree::operator=(const PointOctree &_octree)
+{
+  *this->dataPtr = *_octree.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void PointOctree::Build(const std::vector<Vector3d> &_points)
+{
+  this->Build(_points, 1);
+}
+
+/////////////////////////////////////////////////
+void PointOctree::Build(const std::vector<Vector3d> &_points,
+    const unsigned int _threads)
+{
+  auto &d = *this->dataPtr;
+  d.points.clear();
+  d.indices.clear();
+  d.nodes.clear();
+
+  if (_points.size() >= std::numeric_limits<uint32_t>::max())
+  {
+    IGN_MATH_DIAGNOSTIC("PointOctree::Build() error: too many points ["
+        << _points.size() << "]");
+    return;
+  }
+
+  d.items.clear();
+  d.items.reserve(_points.size());
+  for (std::size_t i = 0; i < _points.size(); ++i)
+  {
+    if (_points[i].IsFinite())
+      d.items.push_back({_points[i], i});
+  }
+  if (d.items.empty())
+    return;
+
+  Vector3d min = d.items[0].point;
+  Vector3d max = min;
+  for (const Item &item : d.items)
+  {
+    min.Min(item.point);
+    max.Max(item.point);
+  }
+  const Vector3d center = (min + max) * 0.5;
+  const double half = std::max((max - min).Max() * 0.5, 1e-12);
+
+  Node root;
+  root.end = static_cast<uint32_t>(d.items.size());
+  d.nodes.push_back(root);
+
+  unsigned int threads = _threads;
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  if (threads > 1 && d.items.size() >= 2 * kMinPointsPerThread)
+    d.BuildParallel(center, half, threads);
+  else
+    d.BuildNode(d.nodes, 0, center, half, 0);
+
+  d.points.reserve(d.items.size());
+  d.indices.reserve(d.items.size());
+  for (const Item &item : d.items)
+  {
+    d.points.push_back(item.point);
+    d.indices.push_back(item.index);
+  }
+  d.items.clear();
+  d.items.shrink_to_fit();
+}
+
+/////////////////////////////////////////////////
+std::size_t PointOctree::Size() const
+{
+  return this->dataPtr->points.size();
+}
+
+/////////////////////////////////////////////////
+std::size_t PointOctree::NodeCount() const
+{
+  return this->dataPtr->nodes.size();
+}
+
+/////////////////////////////////////////////////
+AxisAlignedBox PointOctree::Bounds() const
+{
+  if (this->dataPtr->nodes.empty())
+    return AxisAlignedBox();
+  return AxisAlignedBox(this->dataPtr->nodes[0].min,
+                        this->dataPtr->nodes[0].max);
+}
+
+/////////////////////////////////////////////////
+std::tuple<bool, double, std::size_t> PointOctree::Nearest(
+    const Vector3d &_point, const double _maxDistance) const
+{
+  std::vector<Candidate> heap;
+  if (_maxDistance >= 0 && _point.IsFinite())
+    this->dataPtr->Search(_point, 1, _maxDistance * _maxDistance, heap);
+  if (heap.empty())
+    return std::make_tuple(false, 0.0, kNoPoint);
+  return std::make_tuple(true, std::sqrt(heap[0].first), heap[0].second);
+}
+
+/////////////////////////////////////////////////
+void PointOctree::Nearest(const Vector3d &_point, const std::size_t _k,
+    std::vector<std::size_t> &_indices) const
+{
+  std::vector<Candidate> heap;
+  if (_point.IsFinite())
+  {
+    this->dataPtr->Search(_point, _k,
+        std::numeric_limits<double>::infinity(), heap);
+  }
+  std::sort_heap(heap.begin(), heap.end());
+  _indices.clear();
+  for (const Candidate &candidate : heap)
+    _indices.push_back(candidate.second);
+}
+
+/////////////////////////////////////////////////
+void PointOctree::Overlaps(const Vector3d &_center, const double _radius,
+    std::vector<std::size_t> &_indices) const
+{
+  const double radiusSquared = _radius * _radius;
+  if (_radius < 0)
+  {
+    _indices.clear();
+    return;
+  }
+  this->dataPtr->Collect(
+      [&](const Node &_node)
+      {
+        if (DistanceSquared(_center, _node.min, _node.max) > radiusSquared)
+          return 0;
+        return FarthestSquared(_center, _node.min, _node.max) <=
+          radiusSquared ? 2 : 1;
+      },
+      [&](const Vector3d &_p)
+      {
+        return (_p - _center).SquaredLength() <= radiusSquared;
+      }, _indices);
+}
+
+/////////////////////////////////////////////////
+void PointOctree::Overlaps(const AxisAlignedBox &_box,
+    std::vector<std::size_t> &_indices) const
+{
+  const Vector3d &min = _box.Min();
+  const Vector3d &max = _box.Max();
+  auto contains = [&](const Vector3d &_p)
+  {
+    return _p.X() >= min.X() && _p.Y() >= min.Y() && _p.Z() >= min.Z() &&
+           _p.X() <= max.X() && _p.Y() <= max.Y() && _p.Z() <= max.Z();
+  };
+  this->dataPtr->Collect(
+      [&](const Node &_node)
+      {
+        if (_node.max.X() < min.X() || _node.max.Y() < min.Y() ||
+            _node.max.Z() < min.Z() || _node.min.X() > max.X() ||
+            _node.min.Y() > max.Y() || _node.min.Z() > max.Z())
+        {
+          return 0;
+        }
+        return contains(_node.min) && contains(_node.max) ? 2 : 1;
+      }, contains, _indices);
+}
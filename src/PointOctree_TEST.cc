@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gz/math/PointOctree.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+/// \brief Points in a few dense clusters, with some duplicates.
+static std::vector<Vector3d> ClusteredPoints(const std::size_t _count)
+{
+  std::vector<Vector3d> points;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double scale = (i % 3 == 0) ? 10.0 : 0.1;
+    const Vector3d center = (i % 3 == 1) ? Vector3d(5, 5, 5) : Vector3d::Zero;
+    points.push_back(center + Vector3d(Rand::DblUniform(-scale, scale),
+        Rand::DblUniform(-scale, scale), Rand::DblUniform(-scale, scale)));
+    if (i % 50 == 0)
+      points.push_back(points.back());
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the _k nearest points by sorting all of them.
+static std::vector<std::size_t> BruteForceNearest(
+    const std::vector<Vector3d> &_points, const Vector3d &_point,
+    const std::size_t _k)
+{
+  std::vector<std::pair<double, std::size_t>> sorted;
+  for (std::size_t i = 0; i < _points.size(); ++i)
+  {
+    if (_points[i].IsFinite())
+      sorted.emplace_back((_points[i] - _point).SquaredLength(), i);
+  }
+  std::sort(sorted.begin(), sorted.end());
+  std::vector<std::size_t> indices;
+  for (std::size_t i = 0; i < std::min(_k, sorted.size()); ++i)
+    indices.push_back(sorted[i].second);
+  return indices;
+}
+
+/////////////////////////////////////////////////
+TEST(PointOctreeTest, Empty)
+{
+  PointOctree octree;
+  EXPECT_EQ(0u, octree.Size());
+  EXPECT_EQ(0u, octree.NodeCount());
+  EXPECT_EQ(AxisAlignedBox(), octree.Bounds());
+
+  const auto [found, distance, index] = octree.Nearest(Vector3d::Zero, 1e9);
+  EXPECT_FALSE(found);
+  EXPECT_DOUBLE_EQ(0.0, distance);
+  EXPECT_EQ(PointOctree::kNoPoint, index);
+
+  std::vector<std::size_t> indices = {1};
+  octree.Nearest(Vector3d::Zero, 3, indices);
+  EXPECT_TRUE(indices.empty());
+  indices = {1};
+  octree.Overlaps(Vector3d::Zero, 1.0, indices);
+  EXPECT_TRUE(indices.empty());
+  indices = {1};
+  octree.Overlaps(AxisAlignedBox(-Vector3d::One, Vector3d::One), indices);
+  EXPECT_TRUE(indices.empty());
+
+  // Points that are not finite are ignored.
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  octree.Build({Vector3d(nan, 0, 0)});
+  EXPECT_EQ(0u, octree.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(PointOctreeTest, Simple)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  const std::vector<Vector3d> points = {Vector3d(0, 0, 0),
+      Vector3d(1, 0, 0), Vector3d(inf, 0, 0), Vector3d(0, 2, 0),
+      Vector3d(1, 0, 0)};
+  PointOctree octree(points);
+  EXPECT_EQ(4u, octree.Size());
+  EXPECT_EQ(AxisAlignedBox(Vector3d::Zero, Vector3d(1, 2, 0)),
+            octree.Bounds());
+
+  // Ties go to the lowest index.
+  auto [found, distance, index] = octree.Nearest(Vector3d(0.9, 0, 0), 1.0);
+  EXPECT_TRUE(found);
+  EXPECT_NEAR(0.1, distance, 1e-12);
+  EXPECT_EQ(1u, index);
+
+  std::tie(found, distance, index) = octree.Nearest(Vector3d(0, 5, 0), 2.0);
+  EXPECT_FALSE(found);
+  EXPECT_EQ(PointOctree::kNoPoint, index);
+
+  std::vector<std::size_t> indices;
+  octree.Nearest(Vector3d(0.9, 0.1, 0), 3, indices);
+  EXPECT_EQ(std::vector<std::size_t>({1, 4, 0}), indices);
+  octree.Nearest(Vector3d(0.9, 0.1, 0), 10, indices);
+  EXPECT_EQ(4u, indices.size());
+
+  // The boundaries are inclusive.
+  octree.Overlaps(Vector3d::Zero, 1.0, indices);
+  std::sort(indices.begin(), indices.end());
+  EXPECT_EQ(std::vector<std::size_t>({0, 1, 4}), indices);
+  octree.Overlaps(AxisAlignedBox(Vector3d(0, 0, 0), Vector3d(0, 2, 0)),
+                  indices);
+  std::sort(indices.begin(), indices.end());
+  EXPECT_EQ(std::vector<std::size_t>({0, 3}), indices);
+  octree.Overlaps(Vector3d::Zero, -1.0, indices);
+  EXPECT_TRUE(indices.empty());
+
+  // Copies are independent.
+  PointOctree copy(octree);
+  octree.Build({});
+  EXPECT_EQ(0u, octree.Size());
+  EXPECT_EQ(4u, copy.Size());
+  octree = copy;
+  EXPECT_EQ(4u, octree.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(PointOctreeTest, MatchesBruteForce)
+{
+  Rand::Seed(3);
+  const std::vector<Vector3d> points = ClusteredPoints(3000);
+  PointOctree octree(points);
+  EXPECT_EQ(points.size(), octree.Size());
+  EXPECT_GT(octree.NodeCount(), 1u);
+
+  std::vector<std::size_t> indices;
+  for (int q = 0; q < 100; ++q)
+  {
+    const Vector3d point(Rand::DblUniform(-12, 12),
+        Rand::DblUniform(-12, 12), Rand::DblUniform(-12, 12));
+    const Vector3d query = (q % 2 == 0) ? point : points[q * 7];
+
+    octree.Nearest(query, 10, indices);
+    EXPECT_EQ(BruteForceNearest(points, query, 10), indices);
+
+    const auto [found, distance, index] = octree.Nearest(query, 100.0);
+    EXPECT_TRUE(found);
+    EXPECT_EQ(BruteForceNearest(points, query, 1)[0], index);
+    EXPECT_DOUBLE_EQ(points[index].Distance(query), distance);
+
+    const double radius = Rand::DblUniform(0, 3);
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      if (points[i].Distance(query) <= radius)
+        expected.push_back(i);
+    }
+    octree.Overlaps(query, radius, indices);
+    std::sort(indices.begin(), indices.end());
+    EXPECT_EQ(expected, indices);
+
+    const AxisAlignedBox box(query - Vector3d(radius, 1, 2),
+                             query + Vector3d(2, radius, 1));
+    expected.clear();
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      if (box.Contains(points[i]))
+        expected.push_back(i);
+    }
+    octree.Overlaps(box, indices);
+    std::sort(indices.begin(), indices.end());
+    EXPECT_EQ(expected, indices);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PointOctreeTest, Threads)
+{
+  Rand::Seed(8);
+  const std::vector<Vector3d> points = ClusteredPoints(40000);
+  PointOctree octree;
+  octree.Build(points);
+  PointOctree threaded;
+  threaded.Build(points, 4);
+  EXPECT_EQ(octree.NodeCount(), threaded.NodeCount());
+
+  std::vector<std::size_t> indices;
+  std::vector<std::size_t> threadedIndices;
+  for (int q = 0; q < 50; ++q)
+  {
+    const Vector3d query(Rand::DblUniform(-10, 10),
+        Rand::DblUniform(-10, 10), Rand::DblUniform(-10, 10));
+    octree.Nearest(query, 5, indices);
+    threaded.Nearest(query, 5, threadedIndices);
+    EXPECT_EQ(indices, threadedIndices);
+    octree.Overlaps(query, 1.0, indices);
+    threaded.Overlaps(query, 1.0, threadedIndices);
+    EXPECT_EQ(indices, threadedIndices);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PointOctreeTest, Duplicates)
+{
+  // Many copies of a point stop splitting at the maximum depth.
+  std::vector<Vector3d> points(1000, Vector3d(1, 2, 3));
+  points.push_back(Vector3d(1, 2, 4));
+  PointOctree octree(points);
+  EXPECT_EQ(1001u, octree.Size());
+
+  std::vector<std::size_t> indices;
+  octree.Nearest(Vector3d(1, 2, 3.9), 2, indices);
+  EXPECT_EQ(std::vector<std::size_t>({1000, 0}), indices);
+  octree.Overlaps(Vector3d(1, 2, 3), 0.0, indices);
+  EXPECT_EQ(1000u, indices.size());
+}
@@ -0,0 +1,584 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gz/math/CpuFeatures.hh"
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/KdTree3.hh"
+#include "gz/math/PointGrid.hh"
+#include "gz/math/PointSetFilter.hh"
+#include "gz/math/SignalStats.hh"
+
+// Select the instruction sets of the crop box kernels. The AVX kernel is
+// built even when the library targets older CPUs, and ActiveSimdLevel()
+// chooses between the kernels at run time. Define
+// IGNITION_MATH_DISABLE_SIMD to always use the portable scalar code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define IGNITION_MATH_CROP_SSE2 1
+    #include <emmintrin.h>
+    #if defined(__AVX__) || defined(_MSC_VER)
+      #define IGNITION_MATH_CROP_AVX 1
+      #define IGNITION_MATH_CROP_AVX_TARGET
+      #include <immintrin.h>
+    #elif defined(__GNUC__)
+      #define IGNITION_MATH_CROP_AVX 1
+      #define IGNITION_MATH_CROP_AVX_TARGET __attribute__((target("avx")))
+      #include <immintrin.h>
+    #endif
+  #endif
+#endif
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Number of cells along an axis that fit in a voxel key.
+  constexpr double kMaxVoxels = static_cast<double>(1 << 21);
+
+  /// \brief Key of the points that are not finite, which sorts last.
+  constexpr uint64_t kNoVoxel = std::numeric_limits<uint64_t>::max();
+
+  /// \brief Minimum number of points for each thread of a filter.
+  constexpr std::size_t kMinPointsPerThread = 4096;
+
+  /// \brief Get the number of threads used for a number of points.
+  /// \param[in] _threads Requested number of threads, 0 for the number of
+  /// hardware threads.
+  /// \param[in] _count Number of points.
+  /// \return Number of threads, at least 1.
+  unsigned int ThreadCount(const unsigned int _threads,
+                           const std::size_t _count)
+  {
+    unsigned int threads = _threads;
+    if (threads == 0)
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<unsigned int>(std::max<std::size_t>(1,
+        std::min<std::size_t>(threads, _count / kMinPointsPerThread)));
+  }
+
+  /// \brief Split [0, _count) into one contiguous range per thread.
+  /// \param[in] _count Number of items.
+  /// \param[in] _threads Number of threads, from ThreadCount().
+  /// \param[in] _work Function called with the beginning and end of a
+  /// range, and the index of its thread.
+  template<typename Work>
+  void ForRanges(const std::size_t _count, const unsigned int _threads,
+                 const Work &_work)
+  {
+    std::vector<std::thread> workers;
+    for (unsigned int t = 1; t < _threads; ++t)
+    {
+      workers.emplace_back(_work, _count * t / _threads,
+                           _count * (t + 1) / _threads, t);
+    }
+    _work(0, _count / _threads, 0u);
+    for (auto &worker : workers)
+      worker.join();
+  }
+
+  /// \brief Number of points tested against every box before they are
+  /// compacted, small enough for the block to stay in the L1 cache.
+  constexpr std::size_t kCropBlock = 512;
+
+  /// \brief Transform from the world into the frame of a box, and the
+  /// half size of the box, for the crop box kernels.
+  struct CropFrame
+  {
+    /// \brief Rows of the rotation from the world into the box frame.
+    double rot[3][3];
+
+    /// \brief Translation, after the rotation, into the box frame.
+    double offset[3];
+
+    /// \brief Half size of the box.
+    double half[3];
+  };
+
+  /// \brief Set up the frame of a box.
+  /// \param[in] _box The box.
+  /// \return The frame.
+  CropFrame MakeCropFrame(const OrientedBoxd &_box)
+  {
+    CropFrame frame;
+    const Matrix3d rotation(_box.Pose().Rot());
+    const Vector3d &pos = _box.Pose().Pos();
+    for (int i = 0; i < 3; ++i)
+    {
+      for (int j = 0; j < 3; ++j)
+        frame.rot[i][j] = rotation(j, i);
+      frame.offset[i] = -(frame.rot[i][0] * pos.X() +
+          frame.rot[i][1] * pos.Y() + frame.rot[i][2] * pos.Z());
+      frame.half[i] = _box.Size()[i] * 0.5;
+    }
+    return frame;
+  }
+
+  /// \brief Signature of the crop box kernels, which set the flags of the
+  /// points inside a box and leave the other flags unchanged.
+  using CropKernel = void (*)(const double *, const double *,
+      const double *, std::size_t, const CropFrame &, uint8_t *);
+
+  /// \brief Portable crop box kernel.
+  /// \param[in] _x X components of the points.
+  /// \param[in] _y Y components of the points.
+  /// \param[in] _z Z components of the points.
+  /// \param[in] _count Number of points.
+  /// \param[in] _frame Frame of the box.
+  /// \param[in,out] _inside Flags of the points, set to 1 for the points
+  /// inside the box.
+  void CropScalar(const double *_x, const double *_y, const double *_z,
+      const std::size_t _count, const CropFrame &_frame, uint8_t *_inside)
+  {
+    const CropFrame f = _frame;
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      bool in = true;
+      for (int a = 0; a < 3; ++a)
+      {
+        const double local = f.rot[a][0] * _x[i] + f.rot[a][1] * _y[i] +
+                             f.rot[a][2] * _z[i] + f.offset[a];
+        in &= std::abs(local) <= f.half[a];
+      }
+      _inside[i] |= static_cast<uint8_t>(in);
+    }
+  }
+
+#if defined(IGNITION_MATH_CROP_SSE2)
+  /// \brief SSE2 crop box kernel, two points at a time.
+  void CropSse2(const double *_x, const double *_y, const double *_z,
+      const std::size_t _count, const CropFrame &_frame, uint8_t *_inside)
+  {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    __m128d rot[3][3];
+    __m128d offset[3];
+    __m128d half[3];
+    for (int a = 0; a < 3; ++a)
+    {
+      for (int b = 0; b < 3; ++b)
+        rot[a][b] = _mm_set1_pd(_frame.rot[a][b]);
+      offset[a] = _mm_set1_pd(_frame.offset[a]);
+      half[a] = _mm_set1_pd(_frame.half[a]);
+    }
+
+    std::size_t i = 0;
+    for (; i + 2 <= _count; i += 2)
+    {
+      const __m128d x = _mm_loadu_pd(_x + i);
+      const __m128d y = _mm_loadu_pd(_y + i);
+      const __m128d z = _mm_loadu_pd(_z + i);
+      __m128d in = _mm_castsi128_pd(_mm_set1_epi32(-1));
+      for (int a = 0; a < 3; ++a)
+      {
+        const __m128d local = _mm_add_pd(_mm_add_pd(_mm_add_pd(
+            _mm_mul_pd(rot[a][0], x), _mm_mul_pd(rot[a][1], y)),
+            _mm_mul_pd(rot[a][2], z)), offset[a]);
+        in = _mm_and_pd(in, _mm_cmple_pd(_mm_andnot_pd(sign, local),
+                                         half[a]));
+      }
+      const int mask = _mm_movemask_pd(in);
+      _inside[i] |= static_cast<uint8_t>(mask & 1);
+      _inside[i + 1] |= static_cast<uint8_t>(mask >> 1);
+    }
+    CropScalar(_x + i, _y + i, _z + i, _count - i, _frame, _inside + i);
+  }
+#endif
+
+#if defined(IGNITION_MATH_CROP_AVX)
+  /// \brief AVX crop box kernel, four points at a time.
+  IGNITION_MATH_CROP_AVX_TARGET
+  void CropAvx(const double *_x, const double *_y, const double *_z,
+      const std::size_t _count, const CropFrame &_frame, uint8_t *_inside)
+  {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d rot[3][3];
+    __m256d offset[3];
+    __m256d half[3];
+    for (int a = 0; a < 3; ++a)
+    {
+      for (int b = 0; b < 3; ++b)
+        rot[a][b] = _mm256_set1_pd(_frame.rot[a][b]);
+      offset[a] = _mm256_set1_pd(_frame.offset[a]);
+      half[a] = _mm256_set1_pd(_frame.half[a]);
+    }
+
+    std::size_t i = 0;
+    for (; i + 4 <= _count; i += 4)
+    {
+      const __m256d x = _mm256_loadu_pd(_x + i);
+      const __m256d y = _mm256_loadu_pd(_y + i);
+      const __m256d z = _mm256_loadu_pd(_z + i);
+      __m256d in = _mm256_castsi256_pd(_mm256_set1_epi32(-1));
+      for (int a = 0; a < 3; ++a)
+      {
+        const __m256d local = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+            _mm256_mul_pd(rot[a][0], x), _mm256_mul_pd(rot[a][1], y)),
+            _mm256_mul_pd(rot[a][2], z)), offset[a]);
+        in = _mm256_and_pd(in, _mm256_cmp_pd(
+            _mm256_andnot_pd(sign, local), half[a], _CMP_LE_OQ));
+      }
+      const int mask = _mm256_movemask_pd(in);
+      for (int k = 0; k < 4; ++k)
+        _inside[i + k] |= static_cast<uint8_t>((mask >> k) & 1);
+    }
+    // GCC does not clear the upper lanes when leaving functions with an
+    // AVX target attribute, which slows down the SSE code that follows.
+    _mm256_zeroupper();
+    CropScalar(_x + i, _y + i, _z + i, _count - i, _frame, _inside + i);
+  }
+#endif
+
+  /// \brief Get the widest crop box kernel allowed by ActiveSimdLevel().
+  /// \return The kernel.
+  CropKernel SelectCropKernel()
+  {
+    const SimdLevel level = ActiveSimdLevel();
+    if (level == SimdLevel::SCALAR || level == SimdLevel::NEON)
+      return CropScalar;
+#if defined(IGNITION_MATH_CROP_AVX)
+    if (level != SimdLevel::SSE2)
+      return CropAvx;
+#endif
+#if defined(IGNITION_MATH_CROP_SSE2)
+    return CropSse2;
+#else
+    return CropScalar;
+#endif
+  }
+
+  /// \brief Check whether the point at an index is finite.
+  /// \param[in] _points The points.
+  /// \param[in] _index Index of the point.
+  /// \return True if its three components are finite.
+  bool IsFinite(const Vector3SoAd &_points, const std::size_t _index)
+  {
+    return std::isfinite(_points.XData()[_index]) &&
+      std::isfinite(_points.YData()[_index]) &&
+      std::isfinite(_points.ZData()[_index]);
+  }
+}
+
+/////////////////////////////////////////////////
+bool PointSetFilter::VoxelDownsample(const Vector3SoAd &_points,
+    const double _voxelSize, Vector3SoAd &_centroids,
+    const unsigned int _threads)
+{
+  _centroids.Clear();
+  const double inverse = 1.0 / _voxelSize;
+  if (!(_voxelSize > 0) || !std::isfinite(_voxelSize) ||
+      !std::isfinite(inverse))
+  {
+    IGN_MATH_DIAGNOSTIC(
+        "PointSetFilter::VoxelDownsample() error: invalid voxel "
+        << "size [" << _voxelSize << "]");
+    return false;
+  }
+
+  const std::size_t size = _points.Size();
+  const double *data[3] = {_points.XData(), _points.YData(),
+                           _points.ZData()};
+
+  // Bounds of the cells, which must fit in the keys.
+  double lowest[3];
+  double highest[3];
+  std::fill(lowest, lowest + 3, std::numeric_limits<double>::infinity());
+  std::fill(highest, highest + 3, -std::numeric_limits<double>::infinity());
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    if (!IsFinite(_points, i))
+      continue;
+    for (int a = 0; a < 3; ++a)
+    {
+      const double cell = std::floor(data[a][i] * inverse);
+      lowest[a] = std::min(lowest[a], cell);
+      highest[a] = std::max(highest[a], cell);
+    }
+  }
+  if (lowest[0] > highest[0])
+    return true;
+  for (int a = 0; a < 3; ++a)
+  {
+    if (!(highest[a] - lowest[a] < kMaxVoxels))
+    {
+      IGN_MATH_DIAGNOSTIC("PointSetFilter::VoxelDownsample() error: the points "
+          << "span too many voxels of size [" << _voxelSize << "]");
+      return false;
+    }
+  }
+
+  // Sort the points by cell.
+  const unsigned int threads = ThreadCount(_threads, size);
+  std::vector<std::pair<uint64_t, std::size_t>> keys(size);
+  ForRanges(size, threads,
+    [&](const std::size_t _begin, const std::size_t _end, unsigned int)
+    {
+      for (std::size_t i = _begin; i < _end; ++i)
+      {
+        keys[i].second = i;
+        if (!IsFinite(_points, i))
+        {
+          keys[i].first = kNoVoxel;
+          continue;
+        }
+        uint64_t key = 0;
+        for (int a = 0; a < 3; ++a)
+        {
+          key = (key << 21) | static_cast<uint64_t>(
+              std::floor(data[a][i] * inverse) - lowest[a]);
+        }
+        keys[i].first = key;
+      }
+    });
+  std::sort(keys.begin(), keys.end());
+  while (!keys.empty() && keys.back().first == kNoVoxel)
+    keys.pop_back();
+
+  // Each cell is a range of the sorted keys, whose first point has the
+  // lowest index of the cell.
+  std::vector<std::pair<std::size_t, std::size_t>> cells;
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    if (i == 0 || keys[i].first != keys[i - 1].first)
+      cells.emplace_back(keys[i].second, i);
+  }
+  std::vector<std::size_t> ends(cells.size());
+  for (std::size_t c = 0; c < cells.size(); ++c)
+    ends[c] = c + 1 < cells.size() ? cells[c + 1].second : keys.size();
+  std::vector<std::size_t> order(cells.size());
+  for (std::size_t c = 0; c < cells.size(); ++c)
+    order[c] = c;
+  std::sort(order.begin(), order.end(),
+    [&](const std::size_t _a, const std::size_t _b)
+    {
+      return cells[_a].first < cells[_b].first;
+    });
+
+  _centroids.Resize(cells.size());
+  double *centroids[3] = {_centroids.XData(), _centroids.YData(),
+                          _centroids.ZData()};
+  ForRanges(cells.size(), ThreadCount(_threads, keys.size()),
+    [&](const std::size_t _begin, const std::size_t _end, unsigned int)
+    {
+      for (std::size_t o = _begin; o < _end; ++o)
+      {
+        const std::size_t c = order[o];
+        const std::size_t count = ends[c] - cells[c].second;
+        for (int a = 0; a < 3; ++a)
+        {
+          double sum = 0;
+          for (std::size_t k = cells[c].second; k < ends[c]; ++k)
+            sum += data[a][keys[k].second];
+          centroids[a][o] = sum / static_cast<double>(count);
+        }
+      }
+    });
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool PointSetFilter::RemoveRadiusOutliers(const Vector3SoAd &_points,
+    const double _radius, const std::size_t _minNeighbors,
+    std::vector<std::size_t> &_inliers, const unsigned int _threads)
+{
+  _inliers.clear();
+  if (!(_radius > 0) || !std::isfinite(_radius))
+  {
+    IGN_MATH_DIAGNOSTIC("PointSetFilter::RemoveRadiusOutliers() error: invalid "
+        << "radius [" << _radius << "]");
+    return false;
+  }
+
+  // Cells the size of the radius keep each query to 27 cells.
+  const std::vector<Vector3d> points = _points.ToVector();
+  PointGrid grid(_radius);
+  grid.Build(points, _threads);
+
+  std::vector<uint8_t> keep(points.size(), 0);
+  const unsigned int threads = ThreadCount(_threads, points.size());
+  ForRanges(points.size(), threads,
+    [&](const std::size_t _begin, const std::size_t _end, unsigned int)
+    {
+      std::vector<std::size_t> neighbors;
+      for (std::size_t i = _begin; i < _end; ++i)
+      {
+        if (!points[i].IsFinite())
+          continue;
+        // The point itself is among the points found.
+        grid.Overlaps(points[i], _radius, neighbors);
+        keep[i] = neighbors.size() > _minNeighbors;
+      }
+    });
+
+  for (std::size_t i = 0; i < keep.size(); ++i)
+  {
+    if (keep[i])
+      _inliers.push_back(i);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool PointSetFilter::RemoveStatisticalOutliers(const Vector3SoAd &_points,
+    const std::size_t _k, const double _stddevRatio,
+    std::vector<std::size_t> &_inliers, const unsigned int _threads)
+{
+  _inliers.clear();
+  if (_k == 0 || !std::isfinite(_stddevRatio))
+  {
+    IGN_MATH_DIAGNOSTIC("PointSetFilter::RemoveStatisticalOutliers() error: "
+        << "invalid number of neighbors [" << _k << "] or ratio ["
+        << _stddevRatio << "]");
+    return false;
+  }
+
+  // The nearest point to each point is itself, or a duplicate at the same
+  // location, so it is left out of the mean.
+  const std::vector<Vector3d> points = _points.ToVector();
+  const KdTree3d tree(points);
+  const std::size_t row = _k + 1;
+  std::vector<std::size_t> indices;
+  std::vector<double> distances;
+  tree.Nearest(points, row, indices, distances, _threads);
+
+  std::vector<double> meanDistances(points.size(), 0.0);
+  const unsigned int threads = ThreadCount(_threads, points.size());
+  std::vector<SignalAccumulator> accumulators(threads);
+  ForRanges(points.size(), threads,
+    [&](const std::size_t _begin, const std::size_t _end,
+        const unsigned int _thread)
+    {
+      for (std::size_t i = _begin; i < _end; ++i)
+      {
+        if (!points[i].IsFinite())
+          continue;
+        double sum = 0;
+        std::size_t count = 0;
+        for (std::size_t n = i * row + 1; n < (i + 1) * row; ++n)
+        {
+          if (indices[n] == KdTree3d::kNoPoint)
+            break;
+          sum += distances[n];
+          ++count;
+        }
+        meanDistances[i] = count == 0 ? 0.0 :
+          sum / static_cast<double>(count);
+        accumulators[_thread].InsertData(meanDistances[i]);
+      }
+    });
+  for (unsigned int t = 1; t < threads; ++t)
+    accumulators[0].Merge(accumulators[t]);
+
+  const double threshold = accumulators[0].Mean() +
+    _stddevRatio * std::sqrt(accumulators[0].Variance());
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    if (points[i].IsFinite() && meanDistances[i] <= threshold)
+      _inliers.push_back(i);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::size_t PointSetFilter::CropBox(Vector3SoAd &_points,
+    const OrientedBoxd &_box, const bool _removeInside,
+    const unsigned int _threads)
+{
+  return CropBoxes(_points, &_box, 1, _removeInside, _threads);
+}
+
+/////////////////////////////////////////////////
+std::size_t PointSetFilter::CropBoxes(Vector3SoAd &_points,
+    const OrientedBoxd *_boxes, const std::size_t _count,
+    const bool _removeInside, const unsigned int _threads)
+{
+  std::vector<CropFrame> frames(_count);
+  for (std::size_t b = 0; b < _count; ++b)
+    frames[b] = MakeCropFrame(_boxes[b]);
+  const CropKernel kernel = SelectCropKernel();
+  const uint8_t keepFlag = _removeInside ? 0 : 1;
+
+  // Each thread compacts its own range, which is then moved next to the
+  // previous ranges.
+  const std::size_t size = _points.Size();
+  double *data[3] = {_points.XData(), _points.YData(), _points.ZData()};
+  const unsigned int threads = ThreadCount(_threads, size);
+  std::vector<std::size_t> kept(threads, 0);
+  ForRanges(size, threads,
+    [&](const std::size_t _begin, const std::size_t _end,
+        const unsigned int _thread)
+    {
+      uint8_t inside[kCropBlock];
+      std::size_t write = _begin;
+      for (std::size_t block = _begin; block < _end; block += kCropBlock)
+      {
+        const std::size_t n = std::min(kCropBlock, _end - block);
+        std::fill(inside, inside + n, uint8_t(0));
+        for (const CropFrame &frame : frames)
+          kernel(data[0] + block, data[1] + block, data[2] + block, n,
+                 frame, inside);
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          const double x = data[0][block + i];
+          const double y = data[1][block + i];
+          const double z = data[2][block + i];
+          const bool finite =
+              std::isfinite(x) & std::isfinite(y) & std::isfinite(z);
+          data[0][write] = x;
+          data[1][write] = y;
+          data[2][write] = z;
+          write += (inside[i] == keepFlag) & finite;
+        }
+      }
+      kept[_thread] = write - _begin;
+    });
+
+  std::size_t total = kept[0];
+  for (unsigned int t = 1; t < threads; ++t)
+  {
+    const std::size_t begin = size * t / threads;
+    for (int a = 0; a < 3; ++a)
+    {
+      std::copy(data[a] + begin, data[a] + begin + kept[t],
+                data[a] + total);
+    }
+    total += kept[t];
+  }
+  _points.Resize(total);
+  return total;
+}
+
+/////////////////////////////////////////////////
+void PointSetFilter::Select(const Vector3SoAd &_points,
+    const std::vector<std::size_t> &_indices, Vector3SoAd &_selected)
+{
+  _selected.Resize(_indices.size());
+  for (std::size_t i = 0; i < _indices.size(); ++i)
+  {
+    _selected.XData()[i] = _points.XData()[_indices[i]];
+    _selected.YData()[i] = _points.YData()[_indices[i]];
+    _selected.ZData()[i] = _points.ZData()[_indices[i]];
+  }
+}
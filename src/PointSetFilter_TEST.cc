@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gz/math/CpuFeatures.hh"
+#include "gz/math/PointSetFilter.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(PointSetFilterTest, VoxelDownsample)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const Vector3SoAd points(std::vector<Vector3d>({
+      Vector3d(0.5, 0.5, 0.5), Vector3d(1.5, 0.2, 0.2),
+      Vector3d(0.1, 0.3, 0.9), Vector3d(-0.5, 0.5, 0.5),
+      Vector3d(nan, 0, 0), Vector3d(1.7, 0.4, 0.6)}));
+
+  Vector3SoAd centroids;
+  EXPECT_TRUE(PointSetFilter::VoxelDownsample(points, 1.0, centroids));
+  ASSERT_EQ(3u, centroids.Size());
+  // Ordered by the first point of each cell.
+  EXPECT_EQ(Vector3d(0.3, 0.4, 0.7), centroids[0]);
+  EXPECT_EQ(Vector3d(1.6, 0.3, 0.4), centroids[1]);
+  EXPECT_EQ(Vector3d(-0.5, 0.5, 0.5), centroids[2]);
+
+  EXPECT_TRUE(PointSetFilter::VoxelDownsample(points, 10.0, centroids));
+  ASSERT_EQ(2u, centroids.Size());
+
+  // Invalid sizes, and points that span too many cells.
+  EXPECT_FALSE(PointSetFilter::VoxelDownsample(points, 0.0, centroids));
+  EXPECT_TRUE(centroids.Empty());
+  EXPECT_FALSE(PointSetFilter::VoxelDownsample(points, nan, centroids));
+  EXPECT_FALSE(PointSetFilter::VoxelDownsample(points, 1e-7, centroids));
+  EXPECT_FALSE(PointSetFilter::VoxelDownsample(points, 1e-320, centroids));
+
+  EXPECT_TRUE(PointSetFilter::VoxelDownsample(Vector3SoAd(), 1.0,
+                                              centroids));
+  EXPECT_TRUE(centroids.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PointSetFilterTest, VoxelDownsampleThreads)
+{
+  Rand::Seed(4);
+  Vector3SoAd points;
+  for (int i = 0; i < 50000; ++i)
+  {
+    points.PushBack(Vector3d(Rand::DblUniform(-5, 5),
+        Rand::DblUniform(-5, 5), Rand::DblUniform(-1, 1)));
+  }
+
+  Vector3SoAd centroids;
+  EXPECT_TRUE(PointSetFilter::VoxelDownsample(points, 0.5, centroids));
+  Vector3SoAd threaded;
+  EXPECT_TRUE(PointSetFilter::VoxelDownsample(points, 0.5, threaded, 4));
+  EXPECT_EQ(centroids.ToVector(), threaded.ToVector());
+  EXPECT_EQ(20u * 20u * 4u, centroids.Size());
+
+  // Every centroid lies in the cell of its points.
+  for (std::size_t i = 0; i < centroids.Size(); ++i)
+  {
+    const Vector3d cell = centroids[i] / 0.5;
+    EXPECT_LT(cell.X() - std::floor(cell.X()), 1.0);
+    EXPECT_GE(cell.Z(), -2.0);
+    EXPECT_LT(cell.Z(), 2.0);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PointSetFilterTest, RadiusOutliers)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  const Vector3SoAd points(std::vector<Vector3d>({
+      Vector3d(0, 0, 0), Vector3d(0.5, 0, 0), Vector3d(0, 0.5, 0),
+      Vector3d(5, 5, 5), Vector3d(inf, 0, 0), Vector3d(5, 5, 5),
+      Vector3d(0, 0, 1)}));
+
+  std::vector<std::size_t> inliers;
+  EXPECT_TRUE(PointSetFilter::RemoveRadiusOutliers(points, 0.5, 1,
+                                                   inliers));
+  EXPECT_EQ(std::vector<std::size_t>({0, 1, 2, 3, 5}), inliers);
+
+  EXPECT_TRUE(PointSetFilter::RemoveRadiusOutliers(points, 0.5, 2,
+                                                   inliers));
+  EXPECT_EQ(std::vector<std::size_t>({0}), inliers);
+
+  EXPECT_TRUE(PointSetFilter::RemoveRadiusOutliers(points, 1.0, 0,
+                                                   inliers));
+  EXPECT_EQ(6u, inliers.size());
+
+  Vector3SoAd selected;
+  PointSetFilter::Select(points, {2, 6}, selected);
+  EXPECT_EQ(std::vector<Vector3d>({Vector3d(0, 0.5, 0), Vector3d(0, 0, 1)}),
+            selected.ToVector());
+
+  EXPECT_FALSE(PointSetFilter::RemoveRadiusOutliers(points, -1.0, 1,
+                                                    inliers));
+  EXPECT_TRUE(inliers.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PointSetFilterTest, StatisticalOutliers)
+{
+  Rand::Seed(5);
+  // A dense cloud with a few scattered points far around it.
+  Vector3SoAd points;
+  for (int i = 0; i < 20000; ++i)
+  {
+    points.PushBack(Vector3d(Rand::DblUniform(-1, 1),
+        Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1)));
+  }
+  std::vector<std::size_t> outliers;
+  for (int i = 0; i < 20; ++i)
+  {
+    outliers.push_back(points.Size());
+    points.PushBack(Vector3d(Rand::DblUniform(-50, 50),
+        Rand::DblUniform(20, 50), Rand::DblUniform(-50, 50)));
+  }
+  points.PushBack(Vector3d(std::numeric_limits<double>::quiet_NaN(), 0, 0));
+
+  std::vector<std::size_t> inliers;
+  EXPECT_TRUE(PointSetFilter::RemoveStatisticalOutliers(points, 8, 3.0,
+                                                        inliers));
+  EXPECT_TRUE(std::is_sorted(inliers.begin(), inliers.end()));
+  EXPECT_GT(inliers.size(), 19900u);
+  for (const std::size_t outlier : outliers)
+  {
+    EXPECT_FALSE(std::binary_search(inliers.begin(), inliers.end(),
+                                    outlier));
+  }
+  EXPECT_FALSE(std::binary_search(inliers.begin(), inliers.end(),
+                                  points.Size() - 1));
+
+  std::vector<std::size_t> threaded;
+  EXPECT_TRUE(PointSetFilter::RemoveStatisticalOutliers(points, 8, 3.0,
+                                                        threaded, 3));
+  EXPECT_EQ(inliers, threaded);
+
+  // More neighbors than points.
+  const Vector3SoAd few(std::vector<Vector3d>({Vector3d(0, 0, 0),
+      Vector3d(1, 0, 0), Vector3d(2, 0, 0), Vector3d(10, 0, 0)}));
+  EXPECT_TRUE(PointSetFilter::RemoveStatisticalOutliers(few, 10, 0.5,
+                                                        inliers));
+  EXPECT_EQ(std::vector<std::size_t>({0, 1, 2}), inliers);
+
+  EXPECT_FALSE(PointSetFilter::RemoveStatisticalOutliers(few, 0, 1.0,
+                                                         inliers));
+  EXPECT_TRUE(inliers.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PointSetFilterTest, CropBox)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  const std::vector<Vector3d> input = {
+      Vector3d(0, 0, 0), Vector3d(2, 0, 0), Vector3d(0.9, 0.4, -0.2),
+      Vector3d(nan, 0, 0), Vector3d(0, 1, 0), Vector3d(inf, 0, 0),
+      Vector3d(-1, 0.5, 0.5), Vector3d(0, 0, 3)};
+  const OrientedBoxd box(Vector3d(2, 1, 1));
+
+  // The points inside are kept in their order, with the faces inside
+  Vector3SoAd points(input);
+  EXPECT_EQ(3u, PointSetFilter::CropBox(points, box));
+  ASSERT_EQ(3u, points.Size());
+  EXPECT_EQ(Vector3d(0, 0, 0), points[0]);
+  EXPECT_EQ(Vector3d(0.9, 0.4, -0.2), points[1]);
+  EXPECT_EQ(Vector3d(-1, 0.5, 0.5), points[2]);
+
+  // Removing the points inside keeps the finite points outside
+  points.Assign(input);
+  EXPECT_EQ(3u, PointSetFilter::CropBox(points, box, true));
+  ASSERT_EQ(3u, points.Size());
+  EXPECT_EQ(Vector3d(2, 0, 0), points[0]);
+  EXPECT_EQ(Vector3d(0, 1, 0), points[1]);
+  EXPECT_EQ(Vector3d(0, 0, 3), points[2]);
+
+  // A rotated and moved box
+  const OrientedBoxd turned(Vector3d(4, 1, 1),
+      Pose3d(Vector3d(10, 0, 0), Quaterniond(0, 0, IGN_PI_2)));
+  points.Assign({Vector3d(10, 1.9, 0), Vector3d(11.9, 0, 0),
+                 Vector3d(10.4, -1, 0.4)});
+  EXPECT_EQ(2u, PointSetFilter::CropBox(points, turned));
+  EXPECT_EQ(Vector3d(10, 1.9, 0), points[0]);
+  EXPECT_EQ(Vector3d(10.4, -1, 0.4), points[1]);
+
+  points.Clear();
+  EXPECT_EQ(0u, PointSetFilter::CropBox(points, box));
+}
+
+/////////////////////////////////////////////////
+TEST(PointSetFilterTest, CropBoxes)
+{
+  // Points of a scan, with robot links as boxes
+  Rand::Seed(11);
+  std::vector<Vector3d> input;
+  for (int i = 0; i < 20000; ++i)
+  {
+    input.push_back(Vector3d(Rand::DblUniform(-3, 3),
+        Rand::DblUniform(-3, 3), Rand::DblUniform(-1, 2)));
+  }
+  input[77].Z(std::numeric_limits<double>::quiet_NaN());
+  std::vector<OrientedBoxd> boxes;
+  for (int b = 0; b < 6; ++b)
+  {
+    boxes.push_back(OrientedBoxd(Vector3d(0.4 + 0.1 * b, 0.3, 0.8),
+        Pose3d(-1.5 + 0.6 * b, 0.2 * b, 0.3, 0.1 * b, 0.2, -0.3 * b)));
+  }
+
+  for (const bool removeInside : {false, true})
+  {
+    // Expected points from OrientedBox::Contains, in order
+    std::vector<Vector3d> expected;
+    for (const Vector3d &p : input)
+    {
+      bool inside = false;
+      for (const OrientedBoxd &box : boxes)
+        inside = inside || box.Contains(p);
+      if (p.IsFinite() && inside != removeInside)
+        expected.push_back(p);
+    }
+    ASSERT_FALSE(expected.empty());
+
+    // Every kernel the CPU supports and every number of threads keeps
+    // the same points.
+    const SimdLevel active = ActiveSimdLevel();
+    for (const SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2,
+                                  SimdLevel::AVX, SimdLevel::AVX2})
+    {
+      if (!SetActiveSimdLevel(level))
+        continue;
+      for (const unsigned int threads : {1u, 3u, 0u})
+      {
+        Vector3SoAd points(input);
+        EXPECT_EQ(expected.size(), PointSetFilter::CropBoxes(points,
+            boxes.data(), boxes.size(), removeInside, threads));
+        EXPECT_EQ(expected, points.ToVector())
+          << SimdLevelName(level) << " " << threads;
+      }
+    }
+    EXPECT_TRUE(SetActiveSimdLevel(active));
+  }
+
+  // Without boxes, either nothing or every finite point is kept
+  Vector3SoAd points(input);
+  EXPECT_EQ(0u, PointSetFilter::CropBoxes(points, nullptr, 0));
+  points.Assign(input);
+  EXPECT_EQ(input.size() - 1,
+            PointSetFilter::CropBoxes(points, nullptr, 0, true));
+}
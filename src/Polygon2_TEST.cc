@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "gz/math/Polygon2.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Triangle.hh"
+
+using namespace gz;
+
+/// \brief An L shaped polygon, counterclockwise.
+/// \return The vertices.
+std::vector<math::Vector2d> LShape()
+{
+  return {{0, 0}, {4, 0}, {4, 1}, {1, 1}, {1, 3}, {0, 3}};
+}
+
+/////////////////////////////////////////////////
+TEST(Polygon2Test, Construction)
+{
+  math::Polygon2d empty;
+  EXPECT_EQ(0u, empty.VertexCount());
+  EXPECT_FALSE(empty.Contains(math::Vector2d::Zero));
+  EXPECT_DOUBLE_EQ(0.0, empty.Area());
+
+  const math::Polygon2d polygon(LShape());
+  EXPECT_EQ(6u, polygon.VertexCount());
+  EXPECT_EQ(LShape(), polygon.Vertices());
+  EXPECT_EQ(math::Line2d(0, 3, 0, 0), polygon.Edge(5));
+  EXPECT_DOUBLE_EQ(6.0, polygon.SignedArea());
+  EXPECT_DOUBLE_EQ(6.0, polygon.Area());
+  EXPECT_EQ(math::Vector2d(0, 0), polygon.Min());
+  EXPECT_EQ(math::Vector2d(4, 3), polygon.Max());
+
+  std::vector<math::Vector2d> clockwise = LShape();
+  std::reverse(clockwise.begin(), clockwise.end());
+  EXPECT_DOUBLE_EQ(-6.0, math::Polygon2d(clockwise).SignedArea());
+}
+
+/////////////////////////////////////////////////
+TEST(Polygon2Test, Contains)
+{
+  const math::Polygon2d polygon(LShape());
+  EXPECT_TRUE(polygon.Contains(math::Vector2d(0.5, 0.5)));
+  EXPECT_TRUE(polygon.Contains(math::Vector2d(3.5, 0.5)));
+  EXPECT_TRUE(polygon.Contains(math::Vector2d(0.5, 2.5)));
+  EXPECT_FALSE(polygon.Contains(math::Vector2d(2, 2)));
+  EXPECT_FALSE(polygon.Contains(math::Vector2d(5, 0.5)));
+  EXPECT_FALSE(polygon.Contains(math::Vector2d(-1, 0.5)));
+
+  // Points just below and above the top edge of the foot
+  EXPECT_TRUE(polygon.Contains(math::Vector2d(3, 1 - 1e-12)));
+  EXPECT_FALSE(polygon.Contains(math::Vector2d(3, 1 + 1e-12)));
+
+  EXPECT_EQ(1, polygon.WindingNumber(math::Vector2d(0.5, 0.5)));
+  EXPECT_EQ(0, polygon.WindingNumber(math::Vector2d(2, 2)));
+  std::vector<math::Vector2d> clockwise = LShape();
+  std::reverse(clockwise.begin(), clockwise.end());
+  EXPECT_EQ(-1, math::Polygon2d(clockwise).WindingNumber(
+      math::Vector2d(0.5, 0.5)));
+
+  // Batch results match the single point test.
+  std::vector<math::Vector2d> points(1000);
+  for (auto &p : points)
+  {
+    p.Set(math::Rand::DblUniform(-1, 5), math::Rand::DblUniform(-1, 4));
+  }
+  // Points on the vertices and edges
+  for (const auto &v : LShape())
+    points.push_back(v);
+  points.push_back(math::Vector2d(2, 0));
+  points.push_back(math::Vector2d(1, 2));
+
+  std::unique_ptr<bool[]> inside(new bool[points.size()]);
+  const std::size_t count = polygon.Contains(points.data(), points.size(),
+                                             inside.get());
+  std::size_t expected = 0;
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(polygon.Contains(points[i]), inside[i]) << points[i];
+    if (i < 1000)
+    {
+      EXPECT_EQ(polygon.Contains(points[i]),
+                polygon.WindingNumber(points[i]) != 0) << points[i];
+    }
+    expected += inside[i];
+  }
+  EXPECT_EQ(expected, count);
+}
+
+/////////////////////////////////////////////////
+TEST(Polygon2Test, Locate)
+{
+  // Two unit squares sharing an edge, and a square overlapping both.
+  const std::vector<math::Polygon2d> zones{
+      math::Polygon2d({{0, 0}, {1, 0}, {1, 1}, {0, 1}}),
+      math::Polygon2d({{1, 0}, {2, 0}, {2, 1}, {1, 1}}),
+      math::Polygon2d({{0.5, 0.5}, {1.5, 0.5}, {1.5, 2}, {0.5, 2}})};
+
+  const std::vector<math::Vector2d> points{
+      {0.25, 0.25}, {1.75, 0.25}, {1, 0.25}, {1, 1.5}, {3, 3}, {0.75, 0.75}};
+  std::vector<int> located(points.size());
+  EXPECT_EQ(5u, math::Polygon2d::Locate(zones.data(), zones.size(),
+      points.data(), points.size(), located.data()));
+  EXPECT_EQ(0, located[0]);
+  EXPECT_EQ(1, located[1]);
+  // A point on the shared edge is in exactly one of the squares.
+  EXPECT_EQ(0, located[2]);
+  EXPECT_EQ(2, located[3]);
+  EXPECT_EQ(-1, located[4]);
+  EXPECT_EQ(0, located[5]);
+}
+
+/////////////////////////////////////////////////
+TEST(Polygon2Test, Triangulate)
+{
+  std::vector<std::size_t> indices;
+  EXPECT_FALSE(math::Polygon2d().Triangulate(indices));
+  EXPECT_FALSE(math::Polygon2d({{0, 0}, {1, 0}}).Triangulate(indices));
+
+  // Convex and concave polygons, in both orientations, and with a
+  // vertex on a straight angle.
+  std::vector<std::vector<math::Vector2d>> shapes{
+      LShape(),
+      {{0, 0}, {1, 0}, {1, 1}},
+      {{0, 0}, {2, 0}, {4, 0}, {4, 2}, {0, 2}},
+      {{0, 0}, {4, 0}, {4, 4}, {2, 1}, {0, 4}}};
+  // A star
+  std::vector<math::Vector2d> star;
+  for (int i = 0; i < 10; ++i)
+  {
+    const double radius = i % 2 == 0 ? 2.0 : 0.8;
+    const double angle = i * IGN_PI / 5;
+    star.push_back(math::Vector2d(radius * std::cos(angle),
+                                  radius * std::sin(angle)));
+  }
+  shapes.push_back(star);
+  for (std::size_t s = 0, n = shapes.size(); s < n; ++s)
+  {
+    shapes.push_back(shapes[s]);
+    std::reverse(shapes.back().begin(), shapes.back().end());
+  }
+
+  for (const auto &shape : shapes)
+  {
+    const math::Polygon2d polygon(shape);
+    ASSERT_TRUE(polygon.Triangulate(indices));
+    ASSERT_EQ(0u, indices.size() % 3);
+    EXPECT_LE(indices.size(), 3 * (shape.size() - 2));
+
+    // The triangles are counterclockwise, inside the polygon, and cover
+    // its area.
+    double area = 0.0;
+    for (std::size_t t = 0; t < indices.size(); t += 3)
+    {
+      const math::Vector2d &a = shape[indices[t]];
+      const math::Vector2d &b = shape[indices[t + 1]];
+      const math::Vector2d &c = shape[indices[t + 2]];
+      const double cross = (b - a).X() * (c - a).Y() -
+                           (b - a).Y() * (c - a).X();
+      EXPECT_GE(cross, 0.0);
+      area += 0.5 * cross;
+      EXPECT_TRUE(polygon.Contains((a + b + c) / 3.0));
+    }
+    EXPECT_NEAR(polygon.Area(), area, 1e-9);
+  }
+}
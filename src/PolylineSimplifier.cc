@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Line2.hh"
+#include "gz/math/Line3.hh"
+#include "gz/math/PolylineSimplifier.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Minimum number of points for each thread searching the
+  /// farthest point of an interval, which amortizes starting the thread.
+  constexpr std::size_t kMinPointsPerThread = 16384;
+
+  /// \brief Get the segment between two points of a polyline.
+  /// \param[in] _a Start point.
+  /// \param[in] _b End point.
+  /// \return The segment.
+  Line2d Segment(const Vector2d &_a, const Vector2d &_b)
+  {
+    return Line2d(_a, _b);
+  }
+
+  /// \brief Get the segment between two points of a 3D polyline.
+  /// \param[in] _a Start point.
+  /// \param[in] _b End point.
+  /// \return The segment.
+  Line3d Segment(const Vector3d &_a, const Vector3d &_b)
+  {
+    return Line3d(_a, _b);
+  }
+
+  /// \brief Get the area of a triangle.
+  /// \param[in] _a First vertex.
+  /// \param[in] _b Second vertex.
+  /// \param[in] _c Third vertex.
+  /// \return The area.
+  double TriangleArea(const Vector2d &_a, const Vector2d &_b,
+                      const Vector2d &_c)
+  {
+    const Vector2d ab = _b - _a;
+    const Vector2d ac = _c - _a;
+    return 0.5 * std::abs(ab.X() * ac.Y() - ab.Y() * ac.X());
+  }
+
+  /// \brief Get the area of a 3D triangle.
+  /// \param[in] _a First vertex.
+  /// \param[in] _b Second vertex.
+  /// \param[in] _c Third vertex.
+  /// \return The area.
+  double TriangleArea(const Vector3d &_a, const Vector3d &_b,
+                      const Vector3d &_c)
+  {
+    return 0.5 * (_b - _a).Cross(_c - _a).Length();
+  }
+
+  /// \brief Point of an interval that is farthest from a segment.
+  struct Farthest
+  {
+    /// \brief Index of the point.
+    std::size_t index = 0;
+
+    /// \brief Distance from the point to the segment, negative if no
+    /// point was searched.
+    double distance = -1.0;
+  };
+
+  /// \brief Find the point farthest from a segment in a range of points.
+  /// Ties are broken by the lowest index.
+  /// \param[in] _line The segment.
+  /// \param[in] _points Points of the polyline.
+  /// \param[in] _begin Index of the first point of the range.
+  /// \param[in] _end Index past the last point of the range.
+  /// \return The farthest point.
+  template<typename Line, typename Vector>
+  Farthest FindFarthest(const Line &_line, const Vector *_points,
+                        const std::size_t _begin, const std::size_t _end)
+  {
+    Farthest result;
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      const double distance = _line.Distance(_points[i]);
+      if (distance > result.distance)
+      {
+        result.index = i;
+        result.distance = distance;
+      }
+    }
+    return result;
+  }
+
+  /// \brief Find the point farthest from a segment in a range of points,
+  /// on several threads if the range is long enough.
+  /// \param[in] _line The segment.
+  /// \param[in] _points Points of the polyline.
+  /// \param[in] _begin Index of the first point of the range.
+  /// \param[in] _end Index past the last point of the range.
+  /// \param[in] _threads Maximum number of threads.
+  /// \return The farthest point, the same as with a single thread.
+  template<typename Line, typename Vector>
+  Farthest FindFarthest(const Line &_line, const Vector *_points,
+                        const std::size_t _begin, const std::size_t _end,
+                        const unsigned int _threads)
+  {
+    const std::size_t count = _end - _begin;
+    const unsigned int threads = static_cast<unsigned int>(
+        std::min<std::size_t>(_threads, count / kMinPointsPerThread));
+    if (threads <= 1)
+      return FindFarthest(_line, _points, _begin, _end);
+
+    std::vector<Farthest> results(threads);
+    std::vector<std::thread> workers;
+    for (unsigned int t = 1; t < threads; ++t)
+    {
+      workers.emplace_back([&, t]()
+      {
+        results[t] = FindFarthest(_line, _points,
+            _begin + count * t / threads,
+            _begin + count * (t + 1) / threads);
+      });
+    }
+    results[0] = FindFarthest(_line, _points, _begin,
+                              _begin + count / threads);
+    for (auto &worker : workers)
+      worker.join();
+
+    // The ranges are in increasing order, so the first of equally far
+    // points has the lowest index.
+    Farthest result;
+    for (const Farthest &farthest : results)
+    {
+      if (farthest.distance > result.distance)
+        result = farthest;
+    }
+    return result;
+  }
+
+  /// \brief Keep every point of a polyline.
+  /// \param[in] _count Number of points.
+  /// \param[out] _indices Array of _count indices.
+  /// \return _count.
+  std::size_t KeepAll(const std::size_t _count, std::size_t *_indices)
+  {
+    std::iota(_indices, _indices + _count, std::size_t(0));
+    return _count;
+  }
+
+  /// \brief Douglas-Peucker simplification of a 2D or 3D polyline.
+  /// \param[in] _points Array of _count points.
+  /// \param[in] _count Number of points.
+  /// \param[in] _tolerance Maximum distance of the removed points.
+  /// \param[out] _indices Array of _count indices.
+  /// \param[in] _threads Number of threads, 0 for the hardware threads.
+  /// \return Number of points kept.
+  template<typename Vector>
+  std::size_t DouglasPeuckerImpl(const Vector *_points,
+      const std::size_t _count, const double _tolerance,
+      std::size_t *_indices, const unsigned int _threads)
+  {
+    if (_count < 3)
+      return KeepAll(_count, _indices);
+
+    unsigned int threads = _threads;
+    if (threads == 0)
+      threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // The kept points are written from the start of _indices, and the
+    // end points of the intervals left to simplify are stacked from its
+    // end. The stacked points come after the last kept point, so the two
+    // never overlap.
+    std::size_t kept = 0;
+    std::size_t stacked = 1;
+    _indices[kept++] = 0;
+    _indices[_count - 1] = _count - 1;
+
+    std::size_t start = 0;
+    while (stacked > 0)
+    {
+      const std::size_t end = _indices[_count - stacked];
+      const Farthest farthest = FindFarthest(
+          Segment(_points[start], _points[end]), _points, start + 1, end,
+          threads);
+      if (end > start + 1 && farthest.distance > _tolerance)
+      {
+        // Simplify the first half before the second.
+        ++stacked;
+        _indices[_count - stacked] = farthest.index;
+      }
+      else
+      {
+        --stacked;
+        _indices[kept++] = end;
+        start = end;
+      }
+    }
+    return kept;
+  }
+
+  /// \brief Visvalingam-Whyatt simplification of a 2D or 3D polyline.
+  /// \param[in] _points Array of _count points.
+  /// \param[in] _count Number of points.
+  /// \param[in] _minArea Area of the smallest triangle that is kept.
+  /// \param[out] _indices Array of _count indices.
+  /// \return Number of points kept.
+  template<typename Vector>
+  std::size_t VisvalingamImpl(const Vector *_points,
+      const std::size_t _count, const double _minArea,
+      std::size_t *_indices)
+  {
+    if (_count < 3)
+      return KeepAll(_count, _indices);
+
+    // Doubly linked list of the remaining points, and the area of the
+    // triangle of each interior point with its neighbors.
+    std::vector<std::size_t> prev(_count);
+    std::vector<std::size_t> next(_count);
+    std::vector<double> area(_count, INF_D);
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      prev[i] = i > 0 ? i - 1 : 0;
+      next[i] = i + 1;
+    }
+
+    // Min heap of the areas. Entries whose area changed since they were
+    // pushed are skipped, and ties are broken by the lowest index.
+    using Entry = std::pair<double, std::size_t>;
+    std::vector<Entry> storage;
+    storage.reserve(_count);
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>
+        heap(std::greater<Entry>(), std::move(storage));
+    for (std::size_t i = 1; i + 1 < _count; ++i)
+    {
+      area[i] = TriangleArea(_points[i - 1], _points[i], _points[i + 1]);
+      heap.emplace(area[i], i);
+    }
+
+    while (!heap.empty())
+    {
+      // An entry is stale once the area of its point has been updated,
+      // which gives different bits.
+      const Entry top = heap.top();
+      if (std::memcmp(&top.first, &area[top.second], sizeof(double)) != 0)
+      {
+        heap.pop();
+        continue;
+      }
+      if (!(top.first < _minArea))
+        break;
+      heap.pop();
+
+      const std::size_t i = top.second;
+      const std::size_t before = prev[i];
+      const std::size_t after = next[i];
+      next[before] = after;
+      prev[after] = before;
+      area[i] = NAN_D;
+
+      // A neighbor's area is at least that of the removed point, so that
+      // the points are removed in order of increasing area.
+      for (const std::size_t j : {before, after})
+      {
+        if (j == 0 || j + 1 == _count)
+          continue;
+        area[j] = std::max(top.first, TriangleArea(
+            _points[prev[j]], _points[j], _points[next[j]]));
+        heap.emplace(area[j], j);
+      }
+    }
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < _count; i = next[i])
+      _indices[kept++] = i;
+    return kept;
+  }
+
+  /// \brief Copy the points of a polyline at some indices.
+  /// \param[in] _points Points of the polyline.
+  /// \param[in] _indices Indices of the points to copy.
+  /// \param[in] _count Number of indices.
+  /// \return The points.
+  template<typename Vector>
+  std::vector<Vector> Select(const std::vector<Vector> &_points,
+                             const std::vector<std::size_t> &_indices,
+                             const std::size_t _count)
+  {
+    std::vector<Vector> result(_count);
+    for (std::size_t i = 0; i < _count; ++i)
+      result[i] = _points[_indices[i]];
+    return result;
+  }
+}
+
+/////////////////////////////////////////////////
+std::size_t PolylineSimplifier::DouglasPeucker(const Vector2d *_points,
+    const std::size_t _count, const double _tolerance,
+    std::size_t *_indices, const unsigned int _threads)
+{
+  return DouglasPeuckerImpl(_points, _count, _tolerance, _indices,
+                            _threads);
+}
+
+/////////////////////////////////////////////////
+std::size_t PolylineSimplifier::DouglasPeucker(const Vector3d *_points,
+    const std::size_t _count, const double _tolerance,
+    std::size_t *_indices, const unsigned int _threads)
+{
+  return DouglasPeuckerImpl(_points, _count, _tolerance, _indices,
+                            _threads);
+}
+
+/////////////////////////////////////////////////
+std::vector<Vector2d> PolylineSimplifier::DouglasPeucker(
+    const std::vector<Vector2d> &_points, const double _tolerance,
+    const unsigned int _threads)
+{
+  std::vector<std::size_t> indices(_points.size());
+  const std::size_t kept = DouglasPeuckerImpl(_points.data(),
+      _points.size(), _tolerance, indices.data(), _threads);
+  return Select(_points, indices, kept);
+}
+
+/////////////////////////////////////////////////
+std::vector<Vector3d> PolylineSimplifier::DouglasPeucker(
+    const std::vector<Vector3d> &_points, const double _tolerance,
+    const unsigned int _threads)
+{
+  std::vector<std::size_t> indices(_points.size());
+  const std::size_t kept = DouglasPeuckerImpl(_points.data(),
+      _points.size(), _tolerance, indices.data(), _threads);
+  return Select(_points, indices, kept);
+}
+
+/////////////////////////////////////////////////
+std::size_t PolylineSimplifier::Visvalingam(const Vector2d *_points,
+    const std::size_t _count, const double _minArea, std::size_t *_indices)
+{
+  return VisvalingamImpl(_points, _count, _minArea, _indices);
+}
+
+/////////////////////////////////////////////////
+std::size_t PolylineSimplifier::Visvalingam(const Vector3d *_points,
+    const std::size_t _count, const double _minArea, std::size_t *_indices)
+{
+  return VisvalingamImpl(_points, _count, _minArea, _indices);
+}
+
+/////////////////////////////////////////////////
+std::vector<Vector2d> PolylineSimplifier::Visvalingam(
+    const std::vector<Vector2d> &_points, const double _minArea)
+{
+  std::vector<std::size_t> indices(_points.size());
+  const std::size_t kept = VisvalingamImpl(_points.data(), _points.size(),
+                                           _minArea, indices.data());
+  return Select(_points, indices, kept);
+}
+
+/////////////////////////////////////////////////
+std::vector<Vector3d> PolylineSimplifier::Visvalingam(
+    const std::vector<Vector3d> &_points, const double _minArea)
+{
+  std::vector<std::size_t> indices(_points.size());
+  const std::size_t kept = VisvalingamImpl(_points.data(), _points.size(),
+                                           _minArea, indices.data());
+  return Select(_points, indices, kept);
+}
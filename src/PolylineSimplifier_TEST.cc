@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "gz/math/Line2.hh"
+#include "gz/math/Line3.hh"
+#include "gz/math/PolylineSimplifier.hh"
+
+using namespace gz;
+
+/// \brief Get the largest distance from the points of a polyline to the
+/// simplified polyline that skips them.
+/// \param[in] _points Points of the polyline.
+/// \param[in] _indices Indices of the kept points, in increasing order.
+/// \param[in] _count Number of kept points.
+/// \return The largest distance.
+template<typename Vector, typename Line>
+double MaxDeviation(const std::vector<Vector> &_points,
+                    const std::vector<std::size_t> &_indices,
+                    const std::size_t _count)
+{
+  double result = 0.0;
+  for (std::size_t k = 0; k + 1 < _count; ++k)
+  {
+    const Line line(_points[_indices[k]], _points[_indices[k + 1]]);
+    for (std::size_t i = _indices[k] + 1; i < _indices[k + 1]; ++i)
+      result = std::max(result, static_cast<double>(line.Distance(
+          _points[i])));
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+TEST(PolylineSimplifierTest, Small)
+{
+  std::vector<std::size_t> indices(2);
+  const std::vector<math::Vector2d> two{{0, 0}, {1, 1}};
+  EXPECT_EQ(0u, math::PolylineSimplifier::DouglasPeucker(
+      two.data(), 0, 1.0, indices.data()));
+  EXPECT_EQ(2u, math::PolylineSimplifier::DouglasPeucker(
+      two.data(), 2, 1.0, indices.data()));
+  EXPECT_EQ(0u, indices[0]);
+  EXPECT_EQ(1u, indices[1]);
+  EXPECT_EQ(2u, math::PolylineSimplifier::Visvalingam(
+      two.data(), 2, 1.0, indices.data()));
+  EXPECT_EQ(two, math::PolylineSimplifier::Visvalingam(two, 1.0));
+}
+
+/////////////////////////////////////////////////
+TEST(PolylineSimplifierTest, DouglasPeucker2)
+{
+  // A zigzag with small noise on straight runs.
+  const std::vector<math::Vector2d> points{
+      {0, 0}, {1, 0.01}, {2, -0.01}, {3, 0}, {4, 3}, {5, 6.02}, {6, 9},
+      {7, 8.99}, {8, 9}, {9, 9.01}, {10, 9}};
+
+  std::vector<std::size_t> indices(points.size());
+  const std::size_t kept = math::PolylineSimplifier::DouglasPeucker(
+      points.data(), points.size(), 0.1, indices.data());
+  ASSERT_EQ(4u, kept);
+  EXPECT_EQ(0u, indices[0]);
+  EXPECT_EQ(3u, indices[1]);
+  EXPECT_EQ(6u, indices[2]);
+  EXPECT_EQ(10u, indices[3]);
+  EXPECT_LE((MaxDeviation<math::Vector2d, math::Line2d>(
+      points, indices, kept)), 0.1);
+
+  // A zero tolerance only removes the points that are exactly on the
+  // simplified polyline, such as point 8, and a large one keeps the ends.
+  EXPECT_EQ(points.size() - 1, math::PolylineSimplifier::DouglasPeucker(
+      points.data(), points.size(), 0.0, indices.data()));
+  EXPECT_EQ(2u, math::PolylineSimplifier::DouglasPeucker(
+      points.data(), points.size(), 100.0, indices.data()));
+
+  const std::vector<math::Vector2d> simplified =
+      math::PolylineSimplifier::DouglasPeucker(points, 0.1);
+  const std::vector<math::Vector2d> expected{
+      points[0], points[3], points[6], points[10]};
+  EXPECT_EQ(expected, simplified);
+}
+
+/////////////////////////////////////////////////
+TEST(PolylineSimplifierTest, DouglasPeucker3)
+{
+  // A noisy helix, long enough to search intervals on several threads.
+  std::vector<math::Vector3d> points(100000);
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    const double angle = 0.001 * i;
+    points[i].Set(10 * std::cos(angle), 10 * std::sin(angle),
+                  0.01 * angle + 1e-3 * std::sin(7.0 * i));
+  }
+
+  for (const double tolerance : {0.001, 0.01, 0.1, 1.0})
+  {
+    std::vector<std::size_t> indices(points.size());
+    const std::size_t kept = math::PolylineSimplifier::DouglasPeucker(
+        points.data(), points.size(), tolerance, indices.data());
+    EXPECT_LT(kept, points.size());
+    EXPECT_EQ(0u, indices[0]);
+    EXPECT_EQ(points.size() - 1, indices[kept - 1]);
+    for (std::size_t k = 0; k + 1 < kept; ++k)
+      ASSERT_LT(indices[k], indices[k + 1]);
+    EXPECT_LE((MaxDeviation<math::Vector3d, math::Line3d>(
+        points, indices, kept)), tolerance);
+
+    // Threads give the same result.
+    std::vector<std::size_t> threaded(points.size());
+    ASSERT_EQ(kept, math::PolylineSimplifier::DouglasPeucker(
+        points.data(), points.size(), tolerance, threaded.data(), 4));
+    threaded.resize(kept);
+    indices.resize(kept);
+    EXPECT_EQ(indices, threaded);
+  }
+
+  // A closed loop, whose end points are equal.
+  const std::vector<math::Vector3d> loop{
+      {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 0}};
+  EXPECT_EQ(loop, math::PolylineSimplifier::DouglasPeucker(loop, 0.1));
+}
+
+/////////////////////////////////////////////////
+TEST(PolylineSimplifierTest, Visvalingam)
+{
+  // Triangles of areas 0.01, 0.505 and 0.5 at points 1, 2 and 3.
+  const std::vector<math::Vector2d> points{
+      {0, 0}, {1, 0.01}, {2, 0}, {3, 1}, {4, 1}};
+  std::vector<std::size_t> indices(points.size());
+
+  // Removing point 1 grows the triangle of point 2 to an area of 1.
+  std::size_t kept = math::PolylineSimplifier::Visvalingam(
+      points.data(), points.size(), 0.1, indices.data());
+  ASSERT_EQ(4u, kept);
+  EXPECT_EQ(0u, indices[0]);
+  EXPECT_EQ(2u, indices[1]);
+  EXPECT_EQ(3u, indices[2]);
+  EXPECT_EQ(4u, indices[3]);
+
+  kept = math::PolylineSimplifier::Visvalingam(
+      points.data(), points.size(), 0.001, indices.data());
+  EXPECT_EQ(points.size(), kept);
+  kept = math::PolylineSimplifier::Visvalingam(
+      points.data(), points.size(), 10.0, indices.data());
+  EXPECT_EQ(2u, kept);
+
+  // 3D triangles have the same areas.
+  std::vector<math::Vector3d> points3;
+  for (const auto &p : points)
+    points3.emplace_back(p.X(), 0, p.Y());
+  const std::vector<math::Vector3d> simplified =
+      math::PolylineSimplifier::Visvalingam(points3, 0.1);
+  const std::vector<math::Vector3d> expected{
+      points3[0], points3[2], points3[3], points3[4]};
+  EXPECT_EQ(expected, simplified);
+}
@@ -16,6 +16,7 @@
 */
 #include <gtest/gtest.h>
 #include <ostream>
+#include <vector>
 
 #include "gz/math/Polynomial3.hh"
 
@@ -64,6 +65,42 @@ TEST(Polynomial3Test, Evaluate)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(Polynomial3Test, EvaluateBatch)
+{
+  const math::Polynomial3d p(math::Vector4d(0.5, -2., 3., -1.));
+  const std::vector<double> xs{-3., -1., 0., 0.25, 1., 2.5, 100.,
+      math::INF_D, -math::INF_D, math::NAN_D};
+  std::vector<double> ys(xs.size());
+  p.Evaluate(xs.data(), xs.size(), ys.data());
+  for (std::size_t i = 0; i < xs.size(); ++i)
+  {
+    if (std::isnan(xs[i]))
+    {
+      EXPECT_TRUE(std::isnan(ys[i]));
+    }
+    else if (std::isinf(xs[i]))
+    {
+      EXPECT_DOUBLE_EQ(p(xs[i]), ys[i]);
+    }
+    else
+    {
+      EXPECT_NEAR(p(xs[i]), ys[i], 1e-9 * std::max(1., std::abs(ys[i])));
+    }
+  }
+
+  // Non-finite arguments of a polynomial of lower degree
+  const math::Polynomial3d q = math::Polynomial3d::Constant(2.);
+  const double inf[] = {math::INF_D, -math::INF_D};
+  double values[2];
+  q.Evaluate(inf, 2, values);
+  EXPECT_DOUBLE_EQ(2., values[0]);
+  EXPECT_DOUBLE_EQ(2., values[1]);
+
+  // Nothing to evaluate
+  p.Evaluate(xs.data(), 0, nullptr);
+}
+
 /////////////////////////////////////////////////
 TEST(Polynomial3Test, Minimum)
 {
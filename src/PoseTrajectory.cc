@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/PoseTrajectory.hh"
+#include "gz/math/RotationSpline.hh"
+#include "gz/math/Spline.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Private data for the PoseTrajectory class. The splines are
+/// built from the samples, and rebuilt when the trajectory is copied.
+class gz::math::PoseTrajectoryPrivate
+{
+  /// \brief Build the splines from the samples. The tangents are
+  /// calculated once after all the points are added, and the segments of
+  /// the rotation spline are cached, so that queries only read.
+  public: void Build()
+  {
+    this->positions = std::make_unique<Spline>();
+    this->rotations = std::make_unique<RotationSpline>();
+    this->positions->AutoCalculate(false);
+    this->rotations->AutoCalculate(false);
+    for (const Pose3d &pose : this->poses)
+    {
+      this->positions->AddPoint(pose.Pos());
+      this->rotations->AddPoint(pose.Rot());
+    }
+    this->positions->RecalcTangents();
+    this->rotations->RecalcTangents();
+  }
+
+  /// \brief Find the segment of a time, walking forward from a segment.
+  /// \param[in] _time Time to look up.
+  /// \param[in] _start Segment to walk from, used if _time is not
+  /// earlier than its start.
+  /// \return Index of the first sample of the segment, lower than
+  /// Size() - 1.
+  public: std::size_t Segment(const double _time,
+                              const std::size_t _start) const
+  {
+    const std::size_t lastSegment = this->times.size() - 2;
+    if (_time < this->times[_start])
+    {
+      const std::size_t i = static_cast<std::size_t>(std::upper_bound(
+          this->times.begin(), this->times.end(), _time) -
+          this->times.begin());
+      return std::min(i > 0 ? i - 1 : 0, lastSegment);
+    }
+
+    std::size_t i = _start;
+    while (i < lastSegment && this->times[i + 1] <= _time)
+      ++i;
+    return i;
+  }
+
+  /// \brief Interpolate a pose in a segment.
+  /// \param[in] _segment Index of the first sample of the segment.
+  /// \param[in] _time Time to evaluate, clamped to the segment.
+  /// \return Interpolated pose.
+  public: Pose3d Interpolate(const std::size_t _segment,
+                             const double _time) const
+  {
+    const double t0 = this->times[_segment];
+    const double dt = this->times[_segment + 1] - t0;
+    const double fraction =
+      dt > 0 ? std::clamp((_time - t0) / dt, 0.0, 1.0) : 0.0;
+    const auto index = static_cast<unsigned int>(_segment);
+    return Pose3d(this->positions->Interpolate(index, fraction),
+                  this->rotations->Interpolate(index, fraction));
+  }
+
+  /// \brief Sample times.
+  public: std::vector<double> times;
+
+  /// \brief Sample poses.
+  public: std::vector<Pose3d> poses;
+
+  /// \brief Spline through the positions.
+  public: std::unique_ptr<Spline> positions;
+
+  /// \brief Spline through the rotations.
+  public: std::unique_ptr<RotationSpline> rotations;
+};
+
+/////////////////////////////////////////////////
+PoseTrajectory::PoseTrajectory()
+  : dataPtr(std::make_unique<PoseTrajectoryPrivate>())
+{
+  this->dataPtr->Build();
+}
+
+/////////////////////////////////////////////////
+PoseTrajectory::PoseTrajectory(const PoseTrajectory &_trajectory)
+  : PoseTrajectory()
+{
+  *this = _trajectory;
+}
+
+/////////////////////////////////////////////////
+PoseTrajectory::~PoseTrajectory() = default;
+
+/////////////////////////////////////////////////
+PoseTrajectory &PoseTrajectory::operator=(
+    const PoseTrajectory &_trajectory)
+{
+  if (this != &_trajectory)
+  {
+    this->dataPtr->times = _trajectory.dataPtr->times;
+    this->dataPtr->poses = _trajectory.dataPtr->poses;
+    this->dataPtr->Build();
+  }
+  return *this;
+}
+
+/////////////////////////////////////////////////
+bool PoseTrajectory::SetPoses(const double *_times, const Pose3d *_poses,
+    const std::size_t _count)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    if (!std::isfinite(_times[i]) || (i > 0 && _times[i] < _times[i - 1]))
+    {
+      IGN_MATH_DIAGNOSTIC("Pose trajectory time[" << _times[i] << "] at index["
+          << i << "] is not finite and non-decreasing");
+      return false;
+    }
+  }
+
+  this->dataPtr->times.assign(_times, _times + _count);
+  this->dataPtr->poses.assign(_poses, _poses + _count);
+  this->dataPtr->Build();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool PoseTrajectory::SetPoses(const std::vector<double> &_times,
+    const std::vector<Pose3d> &_poses)
+{
+  if (_times.size() != _poses.size())
+  {
+    IGN_MATH_DIAGNOSTIC("Pose trajectory has " << _times.size() << " times and "
+        << _poses.size() << " poses");
+    return false;
+  }
+  return this->SetPoses(_times.data(), _poses.data(), _times.size());
+}
+
+/////////////////////////////////////////////////
+void PoseTrajectory::Clear()
+{
+  this->dataPtr->times.clear();
+  this->dataPtr->poses.clear();
+  this->dataPtr->Build();
+}
+
+/////////////////////////////////////////////////
+std::size_t PoseTrajectory::Size() const
+{
+  return this->dataPtr->times.size();
+}
+
+/////////////////////////////////////////////////
+double PoseTrajectory::Time(const std::size_t _index) const
+{
+  return this->dataPtr->times[_index];
+}
+
+/////////////////////////////////////////////////
+const Pose3d &PoseTrajectory::SamplePose(const std::size_t _index) const
+{
+  return this->dataPtr->poses[_index];
+}
+
+/////////////////////////////////////////////////
+bool PoseTrajectory::Interpolate(const double _time, Pose3d &_pose) const
+{
+  return this->Interpolate(&_time, 1, &_pose);
+}
+
+/////////////////////////////////////////////////
+bool PoseTrajectory::Interpolate(const double *_times,
+    const std::size_t _count, Pose3d *_poses) const
+{
+  const auto &d = *this->dataPtr;
+  if (d.times.empty())
+    return false;
+
+  if (d.times.size() == 1)
+  {
+    std::fill(_poses, _poses + _count, d.poses[0]);
+    return true;
+  }
+
+  std::size_t segment = 0;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    segment = d.Segment(_times[i], segment);
+    _poses[i] = d.Interpolate(segment, _times[i]);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool PoseTrajectory::Interpolate(const std::vector<double> &_times,
+    std::vector<Pose3d> &_poses) const
+{
+  if (this->dataPtr->times.empty())
+    return false;
+
+  _poses.resize(_times.size());
+  return this->Interpolate(_times.data(), _times.size(), _poses.data());
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gz/math/PoseTrajectory.hh"
+#include "gz/math/RotationSpline.hh"
+#include "gz/math/Spline.hh"
+
+using namespace gz;
+
+/// \brief Create a trajectory with uneven sample times.
+/// \param[out] _times Sample times.
+/// \param[out] _poses Sample poses.
+static void MakeSamples(std::vector<double> &_times,
+                        std::vector<math::Pose3d> &_poses)
+{
+  for (int i = 0; i < 30; ++i)
+  {
+    const double t = 0.05 * i * i;
+    _times.push_back(t);
+    _poses.emplace_back(std::cos(t), std::sin(t), 0.2 * t,
+                        0.1 * std::sin(t), 0, 0.5 * t);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTrajectoryTest, Empty)
+{
+  math::PoseTrajectory trajectory;
+  EXPECT_EQ(0u, trajectory.Size());
+
+  math::Pose3d pose(1, 2, 3, 0, 0, 0);
+  EXPECT_FALSE(trajectory.Interpolate(0.0, pose));
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0), pose);
+
+  std::vector<math::Pose3d> poses(2);
+  EXPECT_FALSE(trajectory.Interpolate({0.0, 1.0, 2.0}, poses));
+  EXPECT_EQ(2u, poses.size());
+
+  // One sample is returned for every time.
+  const math::Pose3d sample(1, 2, 3, 0.1, 0.2, 0.3);
+  EXPECT_TRUE(trajectory.SetPoses({5.0}, {sample}));
+  EXPECT_TRUE(trajectory.Interpolate({0.0, 5.0, 9.0}, poses));
+  ASSERT_EQ(3u, poses.size());
+  for (const auto &p : poses)
+    EXPECT_EQ(sample, p);
+
+  trajectory.Clear();
+  EXPECT_EQ(0u, trajectory.Size());
+  EXPECT_FALSE(trajectory.Interpolate(0.0, pose));
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTrajectoryTest, Interpolate)
+{
+  std::vector<double> times;
+  std::vector<math::Pose3d> samples;
+  MakeSamples(times, samples);
+
+  math::PoseTrajectory trajectory;
+  ASSERT_TRUE(trajectory.SetPoses(times, samples));
+  ASSERT_EQ(samples.size(), trajectory.Size());
+  EXPECT_DOUBLE_EQ(times[4], trajectory.Time(4));
+  EXPECT_EQ(samples[4], trajectory.SamplePose(4));
+
+  // Samples are returned at their times, and times outside of the
+  // samples are clamped.
+  math::Pose3d pose;
+  for (std::size_t i = 0; i < samples.size(); ++i)
+  {
+    EXPECT_TRUE(trajectory.Interpolate(times[i], pose));
+    EXPECT_EQ(samples[i], pose);
+  }
+  EXPECT_TRUE(trajectory.Interpolate(-1.0, pose));
+  EXPECT_EQ(samples.front(), pose);
+  EXPECT_TRUE(trajectory.Interpolate(1e6, pose));
+  EXPECT_EQ(samples.back(), pose);
+
+  // Between samples, the poses are those of splines fed point by point,
+  // with a parameter linear in time within each segment.
+  math::Spline spline;
+  math::RotationSpline rotationSpline;
+  for (const auto &p : samples)
+  {
+    spline.AddPoint(p.Pos());
+    rotationSpline.AddPoint(p.Rot());
+  }
+  for (unsigned int i : {0u, 3u, 15u, 28u})
+  {
+    const double time = times[i] + 0.25 * (times[i + 1] - times[i]);
+    EXPECT_TRUE(trajectory.Interpolate(time, pose));
+    EXPECT_EQ(spline.Interpolate(i, 0.25), pose.Pos());
+    EXPECT_EQ(rotationSpline.Interpolate(i, 0.25), pose.Rot());
+  }
+
+  // Copies are independent.
+  math::PoseTrajectory copy(trajectory);
+  trajectory.Clear();
+  EXPECT_EQ(samples.size(), copy.Size());
+  EXPECT_TRUE(copy.Interpolate(times[7], pose));
+  EXPECT_EQ(samples[7], pose);
+
+  math::PoseTrajectory assigned;
+  assigned = copy;
+  EXPECT_TRUE(assigned.Interpolate(times[8], pose));
+  EXPECT_EQ(samples[8], pose);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTrajectoryTest, Batch)
+{
+  std::vector<double> times;
+  std::vector<math::Pose3d> samples;
+  MakeSamples(times, samples);
+
+  math::PoseTrajectory trajectory;
+  ASSERT_TRUE(trajectory.SetPoses(times, samples));
+
+  // Sorted times, including repeats and times outside of the samples,
+  // followed by times that go back.
+  std::vector<double> queries;
+  for (double t = -1.0; t < times.back() + 1.0; t += 0.37)
+    queries.push_back(t);
+  queries.push_back(queries.back());
+  queries.push_back(10.0);
+  queries.push_back(0.5);
+  queries.push_back(-2.0);
+  queries.push_back(times[12]);
+
+  std::vector<math::Pose3d> poses;
+  EXPECT_TRUE(trajectory.Interpolate(queries, poses));
+  ASSERT_EQ(queries.size(), poses.size());
+  for (std::size_t i = 0; i < queries.size(); ++i)
+  {
+    math::Pose3d expected;
+    EXPECT_TRUE(trajectory.Interpolate(queries[i], expected));
+    EXPECT_EQ(expected, poses[i]) << queries[i];
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTrajectoryTest, RepeatedTimes)
+{
+  const std::vector<double> times = {0.0, 1.0, 1.0, 2.0};
+  const std::vector<math::Pose3d> samples = {
+    math::Pose3d(0, 0, 0, 0, 0, 0), math::Pose3d(1, 0, 0, 0, 0, 0),
+    math::Pose3d(5, 0, 0, 0, 0, 0), math::Pose3d(6, 0, 0, 0, 0, 0)};
+
+  math::PoseTrajectory trajectory;
+  ASSERT_TRUE(trajectory.SetPoses(times, samples));
+
+  // A repeated time selects its last sample.
+  math::Pose3d pose;
+  EXPECT_TRUE(trajectory.Interpolate(1.0, pose));
+  EXPECT_EQ(samples[2], pose);
+  EXPECT_TRUE(trajectory.Interpolate(0.5, pose));
+  EXPECT_GT(pose.Pos().X(), 0.0);
+  EXPECT_LT(pose.Pos().X(), 5.0);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTrajectoryTest, Invalid)
+{
+  const math::Pose3d sample(1, 0, 0, 0, 0, 0);
+
+  math::PoseTrajectory trajectory;
+  ASSERT_TRUE(trajectory.SetPoses({0.0}, {sample}));
+
+  EXPECT_FALSE(trajectory.SetPoses({0.0, 1.0}, {sample}));
+  EXPECT_FALSE(trajectory.SetPoses({1.0, 0.0}, {sample, sample}));
+  EXPECT_FALSE(trajectory.SetPoses(
+      {0.0, std::numeric_limits<double>::infinity()}, {sample, sample}));
+
+  // The trajectory is unchanged.
+  EXPECT_EQ(1u, trajectory.Size());
+  EXPECT_EQ(sample, trajectory.SamplePose(0));
+}
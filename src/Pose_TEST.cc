@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/Pose3.hh"
 
@@ -230,3 +234,129 @@ TEST(PoseTest, SetPoseElements)
   EXPECT_DOUBLE_EQ(pose.Y(), 12);
   EXPECT_DOUBLE_EQ(pose.Z(), 13);
 }
+
+/////////////////////////////////////////////////
+TEST(PoseTest, CoordPositionAddBatch)
+{
+  const math::Pose3d pose(1, -2, 3, 0.3, -1.1, 2.5);
+  std::vector<math::Vector3d> points = {
+    {0, 0, 0}, {1, 2, 3}, {-4, 5, 0.5}, {100, -200, 1e-3}};
+
+  std::vector<math::Vector3d> out;
+  pose.CoordPositionAdd(points, out);
+  ASSERT_EQ(points.size(), out.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    auto expected = pose.CoordPositionAdd(points[i]);
+    EXPECT_TRUE(expected.Equal(out[i], 1e-9)) << expected << " " << out[i];
+  }
+
+  // Structure of arrays
+  math::Vector3SoAd soa(points);
+  math::Vector3SoAd soaOut;
+  pose.CoordPositionAdd(soa, soaOut);
+  ASSERT_EQ(points.size(), soaOut.Size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(out[i].Equal(soaOut[i], 1e-9));
+
+  // In place
+  pose.CoordPositionAdd(soa);
+  EXPECT_EQ(soaOut, soa);
+
+  // In place with the same vector as input and output
+  pose.CoordPositionAdd(points, points);
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(out[i].Equal(points[i], 1e-9));
+
+  // Non-normalized quaternion behaves like the single point version
+  math::Pose3d scaled(math::Vector3d(1, 2, 3),
+      math::Quaterniond(2, 0, 0, 2));
+  std::vector<math::Vector3d> one = {{1, 0, 0}};
+  scaled.CoordPositionAdd(one, out);
+  EXPECT_TRUE(scaled.CoordPositionAdd(one[0]).Equal(out[0], 1e-9));
+
+  // Empty input
+  std::vector<math::Vector3d> empty;
+  pose.CoordPositionAdd(empty, out);
+  EXPECT_TRUE(out.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTest, Parse)
+{
+  math::Pose3d pose;
+  EXPECT_TRUE(math::Pose3d::Parse("1 2 3 0.1 -0.2 0.3", pose));
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0.1, -0.2, 0.3), pose);
+
+  // Same result as the stream operator.
+  std::istringstream stream("1 2 3 0.1 -0.2 0.3");
+  math::Pose3d streamed;
+  stream >> streamed;
+  EXPECT_EQ(streamed, pose);
+
+  EXPECT_FALSE(math::Pose3d::Parse("1 2 3 0.1 -0.2", pose));
+  EXPECT_FALSE(math::Pose3d::Parse("1 2 3 0.1 -0.2 0.3 1", pose));
+  EXPECT_FALSE(math::Pose3d::Parse("1 2 3 0.1 -0.2 z", pose));
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0.1, -0.2, 0.3), pose);
+
+  std::vector<math::Pose3d> poses;
+  EXPECT_TRUE(math::Pose3d::ParseArray(
+        "0 0 0 0 0 0\n1 2 3 0 0 1.5707963267948966\n", poses));
+  ASSERT_EQ(2u, poses.size());
+  EXPECT_EQ(math::Pose3d::Zero, poses[0]);
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, IGN_PI_2), poses[1]);
+
+  EXPECT_FALSE(math::Pose3d::ParseArray("1 2 3 4 5 6 7", poses));
+  EXPECT_EQ(2u, poses.size());
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTest, ToChars)
+{
+  char buffer[256];
+  char *end = buffer + sizeof(buffer);
+
+  const math::Pose3d pose(1, 2.5, -3, 0, 0, 0);
+  char *p = pose.ToChars(buffer, end);
+  ASSERT_NE(nullptr, p);
+  EXPECT_EQ("1 2.5 -3 0 0 0", std::string(buffer, p));
+
+  const math::Pose3d rotated(0.1, -0.2, 0.3, 0.4, -0.5, 0.6);
+  p = rotated.ToChars(buffer, end);
+  ASSERT_NE(nullptr, p);
+  math::Pose3d parsed;
+  EXPECT_TRUE(math::Pose3d::Parse(
+      std::string_view(buffer, static_cast<std::size_t>(p - buffer)),
+      parsed));
+  EXPECT_EQ(rotated.Pos().X(), parsed.Pos().X());
+  EXPECT_EQ(rotated.Pos().Y(), parsed.Pos().Y());
+  EXPECT_EQ(rotated.Pos().Z(), parsed.Pos().Z());
+  EXPECT_EQ(rotated, parsed);
+
+  EXPECT_EQ(nullptr, rotated.ToChars(buffer, buffer + 10));
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTest, InverseBatch)
+{
+  std::vector<math::Pose3d> poses = {
+    math::Pose3d::Zero,
+    math::Pose3d(1, -2, 3, 0.1, 0.2, 0.3),
+    math::Pose3d(-4, 0.5, 10, IGN_PI, -0.4, IGN_PI_2),
+    // Quaternions which are not normalized, or zero
+    math::Pose3d(math::Vector3d(1, 2, 3), math::Quaterniond(2, 0, 0, 2)),
+    math::Pose3d(math::Vector3d(1, 2, 3), math::Quaterniond(0, 0, 0, 0))};
+
+  std::vector<math::Pose3d> inverses(poses.size());
+  math::Pose3d::Inverse(poses.data(), poses.size(), inverses.data());
+  for (std::size_t i = 0; i < poses.size(); ++i)
+  {
+    EXPECT_EQ(poses[i].Inverse(), inverses[i]) << i;
+    EXPECT_EQ(poses[i].Inverse().Rot().W(), inverses[i].Rot().W()) << i;
+  }
+
+  // In place
+  math::Pose3d::Inverse(poses.data(), poses.size(), poses.data());
+  for (std::size_t i = 0; i < poses.size(); ++i)
+    EXPECT_EQ(inverses[i], poses[i]) << i;
+}
@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Profiler.hh"
+
+using namespace gz::math;
+
+namespace
+{
+  /// \brief Duration recorded in a zone.
+  struct ProfilerSample
+  {
+    /// \brief Identifier of the zone.
+    std::size_t zone;
+
+    /// \brief Duration.
+    clock::duration elapsed;
+  };
+
+  /// \brief Ring buffer of the durations recorded by one thread. The
+  /// thread is the only writer of the head and dropped count, and the
+  /// collecting thread the only writer of the tail.
+  class ProfilerBuffer
+  {
+    /// \brief Constructor.
+    /// \param[in] _size Capacity, a power of two.
+    public: explicit ProfilerBuffer(const std::size_t _size)
+      : samples(_size), mask(_size - 1)
+    {
+    }
+
+    /// \brief Add a duration, or count it as dropped if the buffer is
+    /// full. Only called by the owning thread.
+    /// \param[in] _sample Duration to add.
+    public: void Push(const ProfilerSample &_sample)
+    {
+      const uint64_t h = this->head.load(std::memory_order_relaxed);
+      if (h - this->tail.load(std::memory_order_acquire) >
+          this->mask)
+      {
+        this->dropped.store(
+            this->dropped.load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
+        return;
+      }
+      this->samples[h & this->mask] = _sample;
+      this->head.store(h + 1, std::memory_order_release);
+    }
+
+    /// \brief Remove all the durations. Only called by the collecting
+    /// thread.
+    /// \param[in] _f Function called with each duration, in order.
+    public: template <typename F>
+    void Drain(F _f)
+    {
+      const uint64_t t = this->tail.load(std::memory_order_relaxed);
+      const uint64_t h = this->head.load(std::memory_order_acquire);
+      for (uint64_t i = t; i != h; ++i)
+        _f(this->samples[i & this->mask]);
+      this->tail.store(h, std::memory_order_release);
+    }
+
+    /// \brief Get the number of dropped durations.
+    /// \return Number of durations dropped since construction.
+    public: uint64_t Dropped() const
+    {
+      return this->dropped.load(std::memory_order_relaxed);
+    }
+
+    /// \brief Storage of the durations.
+    private: std::vector<ProfilerSample> samples;
+
+    /// \brief Capacity minus one, to wrap indices.
+    private: const uint64_t mask;
+
+    /// \brief Number of durations ever added.
+    private: std::atomic<uint64_t> head{0};
+
+    /// \brief Number of durations ever removed.
+    private: std::atomic<uint64_t> tail{0};
+
+    /// \brief Number of durations dropped.
+    private: std::atomic<uint64_t> dropped{0};
+  };
+
+  /// \brief Buffers of the calling thread, one per profiler it used.
+  struct ProfilerThreadBuffers
+  {
+    /// \brief Identifier of the last profiler used.
+    uint64_t lastProfiler = 0;
+
+    /// \brief Buffer of the last profiler used.
+    ProfilerBuffer *lastBuffer = nullptr;
+
+    /// \brief Identifier of each profiler used and its buffer. The
+    /// buffers are shared with the profilers, so that they outlive
+    /// either the thread or the profiler.
+    std::vector<std::pair<uint64_t, std::shared_ptr<ProfilerBuffer>>> all;
+  };
+
+  /// \brief Source of unique profiler identifiers, which unlike addresses
+  /// are never reused.
+  std::atomic<uint64_t> nextProfilerId{1};
+
+  /// \brief Buffers of the calling thread.
+  /// \return The buffers.
+  ProfilerThreadBuffers &ThreadBuffers()
+  {
+    static thread_local ProfilerThreadBuffers buffers;
+    return buffers;
+  }
+
+  /// \brief Round a buffer size up to a power of two.
+  /// \param[in] _size Requested size.
+  /// \return Power of two of at least _size, and at least 2.
+  std::size_t BufferSize(const std::size_t _size)
+  {
+    std::size_t size = 2;
+    while (size < _size)
+      size *= 2;
+    return size;
+  }
+}
+
+/// \brief Private data for the Profiler class.
+class gz::math::ProfilerPrivate
+{
+  /// \brief Get the buffer of the calling thread, creating it if needed.
+  /// \return The buffer.
+  public: ProfilerBuffer &Buffer();
+
+  /// \brief Unique identifier of the profiler.
+  public: const uint64_t id = nextProfilerId++;
+
+  /// \brief Statistics of each zone.
+  public: std::string statistics;
+
+  /// \brief Capacity of each buffer.
+  public: std::size_t bufferSize = 0;
+
+  /// \brief Protects all the members below.
+  public: mutable std::mutex mutex;
+
+  /// \brief Identifier of each zone name.
+  public: std::map<std::string, std::size_t> zones;
+
+  /// \brief Statistics of each zone.
+  public: std::vector<SignalStats> stats;
+
+  /// \brief Buffer of each thread that recorded a duration, and the
+  /// number of its dropped durations at the last reset.
+  public: std::vector<std::pair<std::shared_ptr<ProfilerBuffer>, uint64_t>>
+    buffers;
+};
+
+//////////////////////////////////////////////////
+ProfilerBuffer &ProfilerPrivate::Buffer()
+{
+  ProfilerThreadBuffers &thread = ThreadBuffers();
+  if (thread.lastProfiler == this->id)
+    return *thread.lastBuffer;
+
+  ProfilerBuffer *buffer = nullptr;
+  for (auto const &entry : thread.all)
+  {
+    if (entry.first == this->id)
+      buffer = entry.second.get();
+  }
+  if (!buffer)
+  {
+    auto created = std::make_shared<ProfilerBuffer>(this->bufferSize);
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->buffers.emplace_back(created, 0);
+    }
+    thread.all.emplace_back(this->id, created);
+    buffer = created.get();
+  }
+  thread.lastProfiler = this->id;
+  thread.lastBuffer = buffer;
+  return *buffer;
+}
+
+//////////////////////////////////////////////////
+Profiler::Profiler(const std::string &_statistics,
+    const std::size_t _bufferSize)
+  : dataPtr(new ProfilerPrivate)
+{
+  this->dataPtr->statistics = _statistics;
+  this->dataPtr->bufferSize = BufferSize(_bufferSize);
+}
+
+//////////////////////////////////////////////////
+Profiler::~Profiler()
+{
+}
+
+//////////////////////////////////////////////////
+std::size_t Profiler::Zone(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->zones.find(_name);
+  if (iter != this->dataPtr->zones.end())
+    return iter->second;
+
+  const std::size_t zone = this->dataPtr->stats.size();
+  this->dataPtr->zones[_name] = zone;
+  this->dataPtr->stats.emplace_back();
+  this->dataPtr->stats.back().InsertStatistics(this->dataPtr->statistics);
+  return zone;
+}
+
+//////////////////////////////////////////////////
+std::size_t Profiler::ZoneCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->stats.size();
+}
+
+//////////////////////////////////////////////////
+void Profiler::Record(const std::size_t _zone,
+    const clock::duration &_elapsed)
+{
+  this->dataPtr->Buffer().Push({_zone, _elapsed});
+}
+
+//////////////////////////////////////////////////
+void Profiler::Collect()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::vector<SignalStats> &stats = this->dataPtr->stats;
+  for (auto &buffer : this->dataPtr->buffers)
+  {
+    buffer.first->Drain([&stats](const ProfilerSample &_sample)
+    {
+      if (_sample.zone < stats.size())
+      {
+        stats[_sample.zone].InsertData(
+            std::chrono::duration<double>(_sample.elapsed).count());
+      }
+    });
+  }
+}
+
+//////////////////////////////////////////////////
+std::map<std::string, std::map<std::string, double>> Profiler::Export()
+{
+  this->Collect();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::map<std::string, std::map<std::string, double>> result;
+  for (auto const &zone : this->dataPtr->zones)
+    result[zone.first] = this->dataPtr->stats[zone.second].Map();
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::size_t Profiler::Count(const std::size_t _zone) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (_zone >= this->dataPtr->stats.size())
+    return 0;
+  return this->dataPtr->stats[_zone].Count();
+}
+
+//////////////////////////////////////////////////
+uint64_t Profiler::Dropped() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  uint64_t dropped = 0;
+  for (auto const &buffer : this->dataPtr->buffers)
+    dropped += buffer.first->Dropped() - buffer.second;
+  return dropped;
+}
+
+//////////////////////////////////////////////////
+void Profiler::Reset()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto &buffer : this->dataPtr->buffers)
+  {
+    buffer.first->Drain([](const ProfilerSample &) {});
+    buffer.second = buffer.first->Dropped();
+  }
+  for (auto &stats : this->dataPtr->stats)
+    stats.Reset();
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/math/Profiler.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(ProfilerTest, Zones)
+{
+  Profiler profiler("max,mean,min");
+  EXPECT_EQ(0u, profiler.ZoneCount());
+  EXPECT_TRUE(profiler.Export().empty());
+
+  const std::size_t a = profiler.Zone("a");
+  const std::size_t b = profiler.Zone("b");
+  EXPECT_NE(a, b);
+  EXPECT_EQ(a, profiler.Zone("a"));
+  EXPECT_EQ(2u, profiler.ZoneCount());
+
+  // Durations are collected in seconds
+  profiler.Record(a, std::chrono::milliseconds(2));
+  profiler.Record(a, std::chrono::milliseconds(4));
+  profiler.Record(b, std::chrono::microseconds(5));
+  profiler.Record(100, std::chrono::milliseconds(1));
+  EXPECT_EQ(0u, profiler.Count(a));
+  profiler.Collect();
+  EXPECT_EQ(2u, profiler.Count(a));
+  EXPECT_EQ(1u, profiler.Count(b));
+  EXPECT_EQ(0u, profiler.Count(100));
+
+  auto stats = profiler.Export();
+  ASSERT_EQ(2u, stats.size());
+  EXPECT_DOUBLE_EQ(0.004, stats["a"]["max"]);
+  EXPECT_DOUBLE_EQ(0.003, stats["a"]["mean"]);
+  EXPECT_DOUBLE_EQ(0.002, stats["a"]["min"]);
+  EXPECT_DOUBLE_EQ(5e-6, stats["b"]["mean"]);
+  EXPECT_EQ(3u, stats["a"].size());
+
+  // Scopes time their lifetime
+  {
+    ProfilerScope scope(profiler, b);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  stats = profiler.Export();
+  EXPECT_EQ(2u, profiler.Count(b));
+  EXPECT_GE(stats["b"]["max"], 0.002);
+
+  // Reset keeps the zones
+  profiler.Record(a, std::chrono::milliseconds(1));
+  profiler.Reset();
+  EXPECT_EQ(0u, profiler.Count(a));
+  EXPECT_EQ(2u, profiler.ZoneCount());
+  profiler.Collect();
+  EXPECT_EQ(0u, profiler.Count(a));
+}
+
+/////////////////////////////////////////////////
+TEST(ProfilerTest, Dropped)
+{
+  // Durations past the buffer size are dropped until the next collection
+  Profiler profiler("mean", 5);
+  const std::size_t zone = profiler.Zone("zone");
+  for (int i = 0; i < 10; ++i)
+    profiler.Record(zone, std::chrono::milliseconds(1));
+  EXPECT_EQ(2u, profiler.Dropped());
+  profiler.Collect();
+  EXPECT_EQ(8u, profiler.Count(zone));
+  profiler.Record(zone, std::chrono::milliseconds(1));
+  profiler.Collect();
+  EXPECT_EQ(9u, profiler.Count(zone));
+  profiler.Reset();
+  EXPECT_EQ(0u, profiler.Dropped());
+
+  // Each profiler has its own buffers
+  Profiler other("mean", 4);
+  const std::size_t otherZone = other.Zone("zone");
+  for (int i = 0; i < 4; ++i)
+  {
+    profiler.Record(zone, std::chrono::milliseconds(1));
+    other.Record(otherZone, std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(0u, profiler.Dropped());
+  EXPECT_EQ(0u, other.Dropped());
+  profiler.Collect();
+  other.Collect();
+  EXPECT_EQ(4u, profiler.Count(zone));
+  EXPECT_EQ(4u, other.Count(otherZone));
+}
+
+/////////////////////////////////////////////////
+TEST(ProfilerTest, Threads)
+{
+  // Threads record while another thread collects
+  Profiler profiler("max,mean,min,p99", 1024);
+  const std::size_t zone = profiler.Zone("work");
+  const int numThreads = 4;
+  const int perThread = 20000;
+  std::atomic<bool> done{false};
+  std::thread collector([&]()
+  {
+    while (!done)
+      profiler.Collect();
+  });
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < numThreads; ++t)
+  {
+    workers.emplace_back([&, t]()
+    {
+      const std::size_t local = profiler.Zone("thread" + std::to_string(t));
+      for (int i = 0; i < perThread; ++i)
+      {
+        profiler.Record(zone, std::chrono::microseconds(1 + t));
+        ProfilerScope scope(profiler, local);
+      }
+    });
+  }
+  for (auto &worker : workers)
+    worker.join();
+  done = true;
+  collector.join();
+
+  // Every duration is either collected or dropped
+  auto stats = profiler.Export();
+  EXPECT_EQ(1u + numThreads, stats.size());
+  uint64_t total = profiler.Count(zone) + profiler.Dropped();
+  for (int t = 0; t < numThreads; ++t)
+    total += profiler.Count(profiler.Zone("thread" + std::to_string(t)));
+  EXPECT_EQ(2u * numThreads * perThread, total);
+  EXPECT_DOUBLE_EQ(1e-6, stats["work"]["min"]);
+  EXPECT_DOUBLE_EQ(1e-6 * numThreads, stats["work"]["max"]);
+}
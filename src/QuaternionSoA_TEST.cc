@@ -0,0 +1,481 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gz/math/QuaternionSoA.hh"
+
+using namespace gz;
+
+/// \brief Quaternions covering the generic, near parallel and near
+/// opposite cases of Slerp, plus non unit and zero quaternions.
+static std::vector<math::Quaterniond> TestQuaternions()
+{
+  return {
+    math::Quaterniond(0.1, 0.2, 0.3),
+    math::Quaterniond(-1.2, 0.4, 2.9),
+    math::Quaterniond(0.1, 0.2, 0.3001),
+    math::Quaterniond(math::Vector3d(1, 1, 0).Normalize(), 2.5),
+    math::Quaterniond(2, 0, 0, 0),
+    math::Quaterniond(0.5, -1, 2, 0.25),
+    math::Quaterniond(0, 0, 0, 0)};
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, Construct)
+{
+  math::QuaternionSoAd empty;
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ(0u, empty.Size());
+
+  math::QuaternionSoAd identities(3);
+  EXPECT_EQ(3u, identities.Size());
+  for (std::size_t i = 0; i < identities.Size(); ++i)
+    EXPECT_EQ(math::Quaterniond::Identity, identities[i]);
+
+  std::vector<math::Quaterniond> aos = TestQuaternions();
+  math::QuaternionSoAd soa(aos);
+  ASSERT_EQ(aos.size(), soa.Size());
+  for (std::size_t i = 0; i < aos.size(); ++i)
+    EXPECT_EQ(aos[i], soa[i]);
+  EXPECT_EQ(aos, soa.ToVector());
+
+  // Component arrays are contiguous views of the data
+  EXPECT_DOUBLE_EQ(0.5, soa.WData()[5]);
+  EXPECT_DOUBLE_EQ(-1.0, soa.XData()[5]);
+  EXPECT_DOUBLE_EQ(2.0, soa.YData()[5]);
+  EXPECT_DOUBLE_EQ(0.25, soa.ZData()[5]);
+  soa.WData()[6] = 1;
+  EXPECT_EQ(math::Quaterniond::Identity, soa[6]);
+
+  soa.Set(0, math::Quaterniond(0, 1, 0, 0));
+  EXPECT_EQ(math::Quaterniond(0, 1, 0, 0), soa[0]);
+  EXPECT_NE(math::QuaternionSoAd(aos), soa);
+
+  soa.Resize(soa.Size() + 1);
+  EXPECT_EQ(math::Quaterniond::Identity, soa[soa.Size() - 1]);
+
+  soa.Clear();
+  EXPECT_TRUE(soa.Empty());
+
+  math::QuaternionSoAf soaf;
+  soaf.Reserve(10);
+  soaf.PushBack(math::Quaternionf(1, 2, 3, 4));
+  EXPECT_EQ(math::Quaternionf(1, 2, 3, 4), soaf[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, Multiply)
+{
+  std::vector<math::Quaterniond> a = TestQuaternions();
+  std::vector<math::Quaterniond> b(a.rbegin(), a.rend());
+  math::QuaternionSoAd sa(a);
+  math::QuaternionSoAd sb(b);
+
+  math::QuaternionSoAd out;
+  math::QuaternionSoAd::Multiply(sa, sb, out);
+  ASSERT_EQ(a.size(), out.Size());
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_TRUE(out[i].Equal(a[i] * b[i], 1e-12)) << i;
+
+  const math::Quaterniond q(0.3, -0.2, 1.1);
+  math::QuaternionSoAd::Multiply(q, sb, out);
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_TRUE(out[i].Equal(q * b[i], 1e-12)) << i;
+
+  math::QuaternionSoAd::Multiply(sa, q, out);
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_TRUE(out[i].Equal(a[i] * q, 1e-12)) << i;
+
+  // In place
+  math::QuaternionSoAd::Multiply(sa, sb, sa);
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_TRUE(sa[i].Equal(a[i] * b[i], 1e-12)) << i;
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, RotateVector)
+{
+  std::vector<math::Quaterniond> q = TestQuaternions();
+  std::vector<math::Vector3d> v;
+  for (std::size_t i = 0; i < q.size(); ++i)
+    v.push_back(math::Vector3d(1.0 + i, -2.0 * i, 0.5));
+
+  math::QuaternionSoAd sq(q);
+  math::Vector3SoAd sv(v);
+  math::Vector3SoAd out;
+  sq.RotateVector(sv, out);
+  ASSERT_EQ(q.size(), out.Size());
+  for (std::size_t i = 0; i < q.size(); ++i)
+  {
+    const math::Vector3d expected = q[i].RotateVector(v[i]);
+    EXPECT_NEAR(expected.X(), out[i].X(), 1e-12) << i;
+    EXPECT_NEAR(expected.Y(), out[i].Y(), 1e-12) << i;
+    EXPECT_NEAR(expected.Z(), out[i].Z(), 1e-12) << i;
+  }
+
+  // Zero quaternions give zero vectors, like Quaternion::RotateVector
+  EXPECT_EQ(math::Vector3d::Zero, out[q.size() - 1]);
+
+  // In place
+  sq.RotateVector(sv, sv);
+  EXPECT_EQ(out, sv);
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, Normalize)
+{
+  std::vector<math::Quaterniond> q = TestQuaternions();
+  math::QuaternionSoAd sq(q);
+  sq.Normalize();
+  for (std::size_t i = 0; i < q.size(); ++i)
+    EXPECT_TRUE(sq[i].Equal(q[i].Normalized(), 1e-15)) << i;
+
+  // Zero quaternion becomes identity, like Quaternion::Normalize
+  EXPECT_EQ(math::Quaterniond::Identity, sq[q.size() - 1]);
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, Slerp)
+{
+  std::vector<math::Quaterniond> p = TestQuaternions();
+  std::vector<math::Quaterniond> q(p.size(), math::Quaterniond(0.1, 0.2, 0.3));
+  q[1] = -p[0];
+  q[4] = math::Quaterniond(-0.5, 0.1, -0.2);
+  for (auto &r : p)
+    r.Normalize();
+  for (auto &r : q)
+    r.Normalize();
+
+  math::QuaternionSoAd sp(p);
+  math::QuaternionSoAd sq(q);
+  math::QuaternionSoAd out;
+  for (const bool shortest : {false, true})
+  {
+    for (const double t : {0.0, 0.25, 0.5, 0.9, 1.0})
+    {
+      math::QuaternionSoAd::Slerp(t, sp, sq, out, shortest);
+      ASSERT_EQ(p.size(), out.Size());
+      for (std::size_t i = 0; i < p.size(); ++i)
+      {
+        EXPECT_TRUE(out[i].Equal(
+            math::Quaterniond::Slerp(t, p[i], q[i], shortest), 1e-12))
+          << i << " " << t << " " << shortest;
+      }
+    }
+
+    std::vector<double> ts;
+    for (std::size_t i = 0; i < p.size(); ++i)
+      ts.push_back(i / static_cast<double>(p.size()));
+    math::QuaternionSoAd::Slerp(ts, sp, sq, out, shortest);
+    for (std::size_t i = 0; i < p.size(); ++i)
+    {
+      EXPECT_TRUE(out[i].Equal(
+          math::Quaterniond::Slerp(ts[i], p[i], q[i], shortest), 1e-12))
+        << i << " " << shortest;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, SlerpFastPrecision)
+{
+  std::vector<math::Quaterniond> p = TestQuaternions();
+  std::vector<math::Quaterniond> q(p.size(), math::Quaterniond(0.1, 0.2, 0.3));
+  q[4] = math::Quaterniond(-0.5, 0.1, -0.2);
+  for (auto &r : p)
+    r.Normalize();
+  for (auto &r : q)
+    r.Normalize();
+
+  // The approximations of Helpers.hh keep the error around 1e-8
+  math::QuaternionSoAd sp(p);
+  math::QuaternionSoAd sq(q);
+  math::QuaternionSoAd out;
+  for (const double t : {0.0, 0.25, 0.5, 0.9, 1.0})
+  {
+    math::QuaternionSoAd::Slerp<math::FastPrecision>(t, sp, sq, out, true);
+    for (std::size_t i = 0; i < p.size(); ++i)
+    {
+      EXPECT_TRUE(out[i].Equal(
+          math::Quaterniond::Slerp(t, p[i], q[i], true), 1e-7)) << i;
+    }
+  }
+
+  math::QuaternionSoAf fp(std::vector<math::Quaternionf>(
+      {math::Quaternionf(0.1f, 0.2f, 0.3f)}));
+  math::QuaternionSoAf fq(std::vector<math::Quaternionf>(
+      {math::Quaternionf(-1.2f, 0.4f, 2.9f)}));
+  math::QuaternionSoAf fout;
+  math::QuaternionSoAf::Slerp<math::FastPrecision>(0.3f, fp, fq, fout);
+  EXPECT_TRUE(fout[0].Equal(math::Quaternionf::Slerp(
+      0.3f, fp[0], fq[0]), 1e-6f));
+
+  math::QuaternionSoAd a(std::vector<math::Quaterniond>(
+      p.size(), math::Quaterniond(0.3, -0.2, 0.1)));
+  math::QuaternionSoAd full;
+  math::QuaternionSoAd::Squad(0.4, sp, a, a, sq, full);
+  math::QuaternionSoAd::Squad<math::FastPrecision>(0.4, sp, a, a, sq, out);
+  for (std::size_t i = 0; i < p.size(); ++i)
+    EXPECT_TRUE(out[i].Equal(full[i], 1e-7)) << i;
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, Euler)
+{
+  std::vector<math::Quaterniond> q = TestQuaternions();
+  q.push_back(math::Quaterniond(0.3, IGN_PI_2, -0.4));
+  q.push_back(math::Quaterniond(0.3, -IGN_PI_2, 0.2));
+  math::QuaternionSoAd sq(q);
+
+  math::Vector3SoAd full;
+  sq.Euler(full);
+  math::Vector3SoAd fast;
+  sq.Euler<math::FastPrecision>(fast);
+  ASSERT_EQ(q.size(), full.Size());
+  ASSERT_EQ(q.size(), fast.Size());
+  for (std::size_t i = 0; i < q.size(); ++i)
+  {
+    EXPECT_EQ(q[i].Euler(), full[i]) << i;
+    EXPECT_NEAR(q[i].Euler().X(), fast[i].X(), 1e-7) << i;
+    EXPECT_NEAR(q[i].Euler().Y(), fast[i].Y(), 1e-7) << i;
+    EXPECT_NEAR(q[i].Euler().Z(), fast[i].Z(), 1e-7) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, Integrate)
+{
+  const std::vector<math::Quaterniond> q = TestQuaternions();
+  const std::vector<math::Vector3d> w0 = {
+    math::Vector3d(0.4, -1.3, 2.0), math::Vector3d::Zero,
+    math::Vector3d(1e-9, 0, -1e-9), math::Vector3d(3, 0, 0),
+    math::Vector3d(-2, 5, 1), math::Vector3d(0, 0.2, 0),
+    math::Vector3d(1, 1, 1)};
+  std::vector<math::Vector3d> w1(w0.rbegin(), w0.rend());
+  math::QuaternionSoAd sq(q);
+  const math::Vector3SoAd sw0(w0);
+  const math::Vector3SoAd sw1(w1);
+  const double dt = 0.05;
+
+  math::QuaternionSoAd out;
+  sq.Integrate(sw0, dt, out);
+  ASSERT_EQ(q.size(), out.Size());
+  for (std::size_t i = 0; i < q.size(); ++i)
+    EXPECT_TRUE(out[i].Equal(q[i].Integrate(w0[i], dt), 1e-15)) << i;
+
+  // Steps too large for the series
+  sq.Integrate(sw0, 2.0, out);
+  for (std::size_t i = 0; i < q.size(); ++i)
+    EXPECT_TRUE(out[i].Equal(q[i].Integrate(w0[i], 2.0), 1e-15)) << i;
+
+  sq.Integrate(sw0, sw1, dt, out);
+  for (std::size_t i = 0; i < q.size(); ++i)
+  {
+    EXPECT_TRUE(out[i].Equal(q[i].Integrate(w0[i], w1[i], dt), 1e-15))
+      << i;
+  }
+
+  // In place
+  sq.Integrate(sw0, sw1, dt, sq);
+  EXPECT_EQ(out, sq);
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, Squad)
+{
+  std::vector<math::Quaterniond> p, a, b, q;
+  for (int i = 0; i < 8; ++i)
+  {
+    p.push_back(math::Quaterniond(0.1 * i, 0.2, -0.3));
+    a.push_back(math::Quaterniond(0.2 * i, 0.1, 0.4));
+    b.push_back(math::Quaterniond(-0.1 * i, 0.5, 0.1));
+    q.push_back(math::Quaterniond(0.3 * i, -0.4, 0.2));
+  }
+  math::QuaternionSoAd sp(p), sa(a), sb(b), sq(q);
+  math::QuaternionSoAd out;
+  for (const double t : {0.0, 0.3, 0.75})
+  {
+    math::QuaternionSoAd::Squad(t, sp, sa, sb, sq, out, true);
+    ASSERT_EQ(p.size(), out.Size());
+    for (std::size_t i = 0; i < p.size(); ++i)
+    {
+      EXPECT_TRUE(out[i].Equal(
+          math::Quaterniond::Squad(t, p[i], a[i], b[i], q[i], true), 1e-12))
+        << i << " " << t;
+    }
+  }
+
+  // In place
+  math::QuaternionSoAd::Squad(0.3, sp, sa, sb, sq, sp, true);
+  EXPECT_TRUE(sp[5].Equal(
+      math::Quaterniond::Squad(0.3, p[5], a[5], b[5], q[5], true), 1e-12));
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, NlerpAndSlerpFast)
+{
+  std::vector<math::Quaterniond> p, q;
+  for (int i = 0; i < 100; ++i)
+  {
+    p.push_back(math::Quaterniond(0.05 * i, -0.1, 0.3));
+    q.push_back(math::Quaterniond(0.05 * i + 0.2, 0.1 * (i % 7), -0.3));
+  }
+  // Opposite quaternions
+  q[3] = -p[3];
+
+  math::QuaternionSoAd sp(p), sq(q);
+  math::QuaternionSoAd out;
+  for (const double t : {0.0, 0.2, 0.5, 1.0})
+  {
+    for (const bool shortest : {false, true})
+    {
+      math::QuaternionSoAd::Nlerp(t, sp, sq, out, shortest);
+      ASSERT_EQ(p.size(), out.Size());
+      for (std::size_t i = 0; i < p.size(); ++i)
+      {
+        EXPECT_TRUE(out[i].Equal(
+            math::Quaterniond::Nlerp(t, p[i], q[i], shortest), 1e-12))
+          << i << " " << t << " " << shortest;
+      }
+    }
+
+    math::QuaternionSoAd::SlerpFast(t, sp, sq, out);
+    for (std::size_t i = 0; i < p.size(); ++i)
+    {
+      EXPECT_TRUE(out[i].Equal(
+          math::Quaterniond::SlerpFast(t, p[i], q[i]), 1e-12))
+        << i << " " << t;
+    }
+  }
+
+  // In place
+  math::QuaternionSoAd::SlerpFast(0.3, sp, sq, sp);
+  EXPECT_TRUE(sp[42].Equal(
+      math::Quaterniond::SlerpFast(0.3, p[42], q[42]), 1e-12));
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, SetFromEuler)
+{
+  std::vector<math::Vector3d> angles{
+      {0.1, 0.2, 0.3}, {-1.2, 0.4, 2.9}, {0, 0, 0}, {0.3, IGN_PI_2, -0.4},
+      {3.0, -1.5, -3.1}, {100.0, -20.0, 7.0}};
+  math::Vector3SoAd euler(angles);
+
+  math::QuaternionSoAd full;
+  full.SetFromEuler(euler);
+  math::QuaternionSoAd fast;
+  fast.SetFromEuler<math::FastPrecision>(euler);
+  ASSERT_EQ(angles.size(), full.Size());
+  ASSERT_EQ(angles.size(), fast.Size());
+  for (std::size_t i = 0; i < angles.size(); ++i)
+  {
+    const math::Quaterniond expected(angles[i]);
+    EXPECT_EQ(expected, full[i]) << i;
+    EXPECT_TRUE(expected.Equal(fast[i], 1e-8)) << i;
+  }
+
+  // Round trip through the batch getter
+  math::Vector3SoAd back;
+  full.Euler(back);
+  math::QuaternionSoAd again;
+  again.SetFromEuler(back);
+  for (std::size_t i = 0; i < angles.size(); ++i)
+    EXPECT_TRUE(full[i].Equal(again[i], 1e-9)) << i;
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, Matrix)
+{
+  std::vector<math::Quaterniond> q = TestQuaternions();
+  // Rotations which take each branch of Quaternion::Matrix
+  q.push_back(math::Quaterniond(IGN_PI, 0, 0));
+  q.push_back(math::Quaterniond(0, IGN_PI, 0));
+  q.push_back(math::Quaterniond(0, 0, IGN_PI));
+  q.push_back(math::Quaterniond(0.1, 3.0, -0.2));
+  math::QuaternionSoAd sq(q);
+
+  math::Matrix3SoAd mat;
+  sq.ToMatrix(mat);
+  ASSERT_EQ(q.size(), mat.Size());
+  for (std::size_t i = 0; i < q.size(); ++i)
+    EXPECT_EQ(math::Matrix3d(q[i]), mat[i]) << i;
+
+  math::QuaternionSoAd back;
+  back.SetFromMatrix(mat);
+  ASSERT_EQ(q.size(), back.Size());
+  for (std::size_t i = 0; i < q.size(); ++i)
+  {
+    math::Quaterniond expected;
+    expected.Matrix(mat[i]);
+    EXPECT_EQ(expected, back[i]) << i;
+    // The same rotation as the normalized input, up to the sign
+    EXPECT_TRUE(math::Matrix3d(back[i]) == mat[i]) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionSoATest, Axis)
+{
+  std::vector<math::Quaterniond> q = TestQuaternions();
+  q.push_back(math::Quaterniond::Identity);
+  q.push_back(math::Quaterniond(0, 0, 1e-8));
+  for (auto &r : q)
+    r.Normalize();
+  math::QuaternionSoAd sq(q);
+
+  math::Vector3SoAd axis;
+  std::vector<double> angle;
+  sq.ToAxis(axis, angle);
+  math::Vector3SoAd fastAxis;
+  std::vector<double> fastAngle;
+  sq.ToAxis<math::FastPrecision>(fastAxis, fastAngle);
+  ASSERT_EQ(q.size(), axis.Size());
+  ASSERT_EQ(q.size(), angle.size());
+  for (std::size_t i = 0; i < q.size(); ++i)
+  {
+    math::Vector3d expectedAxis;
+    double expectedAngle;
+    q[i].ToAxis(expectedAxis, expectedAngle);
+    EXPECT_EQ(expectedAxis, axis[i]) << i;
+    EXPECT_DOUBLE_EQ(expectedAngle, angle[i]) << i;
+    EXPECT_EQ(expectedAxis, fastAxis[i]) << i;
+    EXPECT_NEAR(expectedAngle, fastAngle[i], 1e-7) << i;
+  }
+
+  math::QuaternionSoAd back;
+  back.SetFromAxis(axis, angle);
+  math::QuaternionSoAd fast;
+  fast.SetFromAxis<math::FastPrecision>(axis, angle);
+  ASSERT_EQ(q.size(), back.Size());
+  for (std::size_t i = 0; i < q.size(); ++i)
+  {
+    math::Quaterniond expected;
+    expected.Axis(axis[i], angle[i]);
+    EXPECT_EQ(expected, back[i]) << i;
+    EXPECT_TRUE(expected.Equal(fast[i], 1e-8)) << i;
+  }
+
+  // Zero axes give the identity
+  math::Vector3SoAd zero(std::vector<math::Vector3d>(3));
+  back.SetFromAxis(zero, std::vector<double>{1.0, 2.0, 3.0});
+  for (std::size_t i = 0; i < 3; ++i)
+    EXPECT_EQ(math::Quaterniond::Identity, back[i]);
+}
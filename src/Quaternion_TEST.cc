@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
 
 #include "gz/math/Helpers.hh"
@@ -265,6 +266,48 @@ TEST(QuaternionTest, Integrate)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(QuaternionTest, IntegrateConing)
+{
+  const math::Quaterniond q(0.3, -0.2, 1.1);
+
+  // A constant angular velocity gives the first order integration
+  {
+    const math::Vector3d w(0.4, -1.3, 2.0);
+    EXPECT_EQ(q.Integrate(w, 0.1), q.Integrate(w, w, 0.1));
+    EXPECT_EQ(q, q.Integrate(w, -w, 0.0));
+  }
+
+  // Angular velocity varying linearly along the interval, compared to
+  // many small steps
+  const math::Vector3d w0(2.0, -1.0, 0.5);
+  const math::Vector3d w1(-1.0, 1.5, 2.5);
+  const double dt = 0.1;
+  const int substeps = 20000;
+  math::Quaterniond reference = q;
+  for (int i = 0; i < substeps; ++i)
+  {
+    const math::Vector3d a = w0 + (w1 - w0) * (i / double(substeps));
+    const math::Vector3d b = w0 + (w1 - w0) * ((i + 1) / double(substeps));
+    reference = reference.Integrate((a + b) / 2, dt / substeps);
+  }
+
+  const math::Quaterniond mean = q.Integrate((w0 + w1) / 2, dt);
+  const math::Quaterniond coning = q.Integrate(w0, w1, dt);
+  // Angle of the rotation between two quaternions
+  auto error = [&reference](const math::Quaterniond &_q)
+  {
+    const math::Quaterniond d = _q.Inverse() * reference;
+    return 2 * std::asin(math::Vector3d(d.X(), d.Y(), d.Z()).Length());
+  };
+  const double meanError = error(mean);
+  const double coningError = error(coning);
+  EXPECT_GT(meanError, 1e-3);
+  EXPECT_LT(coningError, meanError / 20);
+  EXPECT_NEAR(1.0, coning.W() * coning.W() + coning.X() * coning.X() +
+              coning.Y() * coning.Y() + coning.Z() * coning.Z(), 1e-12);
+}
+
 /////////////////////////////////////////////////
 TEST(QuaternionTest, MathLog)
 {
@@ -612,6 +655,131 @@ TEST(QuaternionTest, Slerp)
   EXPECT_EQ(q3, math::Quaterniond(0.554528, -0.717339, 0.32579, 0.267925));
 }
 
+/////////////////////////////////////////////////
+/// \brief Angle of the rotation between two unit quaternions.
+double RotationAngle(const math::Quaterniond &_a, const math::Quaterniond &_b)
+{
+  return 2.0 * std::acos(std::min(1.0, std::abs(_a.Dot(_b))));
+}
+
+/////////////////////////////////////////////////
+/// \brief Largest rotation angle between an interpolation and Slerp, for
+/// rotations at most _maxAngle apart.
+template<typename F>
+double MaxInterpolationError(double _maxAngle, F _interpolate)
+{
+  double maxError = 0;
+  const math::Vector3d axes[] = {{1, 0, 0}, {0.3, -0.5, 0.8}, {-1, 1, 1}};
+  const math::Quaterniond p(0.3, -0.2, 1.4);
+  for (const auto &axis : axes)
+  {
+    for (int a = 1; a <= 20; ++a)
+    {
+      const math::Quaterniond q =
+          p * math::Quaterniond(axis.Normalized(), _maxAngle * a / 20.0);
+      for (int t = 0; t <= 50; ++t)
+      {
+        const double ft = t / 50.0;
+        maxError = std::max(maxError, RotationAngle(
+            _interpolate(ft, p, q),
+            math::Quaterniond::Slerp(ft, p, q, true)));
+      }
+    }
+  }
+  return maxError;
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionTest, NormalizeFast)
+{
+  for (const double scale : {1e-5, 0.5, 1.0, 1.0 + 1e-6, 3.0, 1e5})
+  {
+    math::Quaterniond q(0.1 * scale, -1.2 * scale, 2.3 * scale, 0.4 * scale);
+    math::Quaterniond expected = q.Normalized();
+    q.NormalizeFast();
+    EXPECT_NEAR(1.0, q.Dot(q), 6e-7) << scale;
+    EXPECT_TRUE(q.Equal(expected, 1e-6)) << scale;
+  }
+
+  math::Quaternionf qf(0.1f, -1.2f, 2.3f, 0.4f);
+  qf.NormalizeFast();
+  EXPECT_NEAR(1.0f, qf.Dot(qf), 1e-6f);
+
+  // Zero and tiny quaternions become the identity, as with Normalize
+  math::Quaterniond zero(0, 0, 0, 0);
+  zero.NormalizeFast();
+  EXPECT_EQ(math::Quaterniond::Identity, zero);
+
+  // Huge quaternions fall back to Normalize
+  math::Quaterniond huge(1e100, 0, 0, 1e100);
+  huge.NormalizeFast();
+  EXPECT_TRUE(huge.Equal(math::Quaterniond(1, 0, 0, 1).Normalized(),
+                         1e-12));
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionTest, Nlerp)
+{
+  const math::Quaterniond q1(0.1, 1.2, 2.3);
+  const math::Quaterniond q2(1.2, 2.3, -3.4);
+
+  // Exact at both ends and in the middle
+  for (const double t : {0.0, 0.5, 1.0})
+  {
+    EXPECT_LT(RotationAngle(math::Quaterniond::Slerp(t, q1, q2, true),
+        math::Quaterniond::Nlerp(t, q1, q2, true)), 1e-7) << t;
+  }
+
+  // The long path when the shortest path is not requested
+  const math::Quaterniond q3 = -q2;
+  EXPECT_TRUE(math::Quaterniond::Nlerp(0.25, q1, q3).Equal(
+      math::Quaterniond::Slerp(0.25, q1, q3), 0.01));
+  EXPECT_TRUE(math::Quaterniond::Nlerp(0.25, q1, q3, true).Equal(
+      -math::Quaterniond::Slerp(0.25, q1, q3, true), 0.01) ||
+    math::Quaterniond::Nlerp(0.25, q1, q3, true).Equal(
+      math::Quaterniond::Slerp(0.25, q1, q3, true), 0.01));
+
+  // Opposite quaternions blend to the identity in the middle
+  EXPECT_EQ(math::Quaterniond::Identity,
+            math::Quaterniond::Nlerp(0.5, q1, -q1));
+
+  // Documented error bounds
+  auto nlerp = [](double _t, const math::Quaterniond &_p,
+                  const math::Quaterniond &_q)
+  {
+    return math::Quaterniond::Nlerp(_t, _p, _q, true);
+  };
+  EXPECT_LT(MaxInterpolationError(IGN_DTOR(10), nlerp), 2.2e-5);
+  EXPECT_LT(MaxInterpolationError(IGN_DTOR(30), nlerp), 5.8e-4);
+  EXPECT_LT(MaxInterpolationError(IGN_DTOR(90), nlerp), 1.7e-2);
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionTest, SlerpFast)
+{
+  const math::Quaterniond q1(0.1, 1.2, 2.3);
+  const math::Quaterniond q2(1.2, 2.3, -3.4);
+  EXPECT_TRUE(math::Quaterniond::SlerpFast(0.0, q1, q2).Equal(q1, 1e-12));
+  EXPECT_EQ(math::Quaterniond::SlerpFast(1.0, q1, q2),
+            math::Quaterniond::Slerp(1.0, q1, q2, true));
+
+  // Documented error bounds
+  auto slerpFast = [](double _t, const math::Quaterniond &_p,
+                      const math::Quaterniond &_q)
+  {
+    return math::Quaterniond::SlerpFast(_t, _p, _q);
+  };
+  EXPECT_LT(MaxInterpolationError(IGN_DTOR(30), slerpFast), 3.3e-5);
+  EXPECT_LT(MaxInterpolationError(IGN_DTOR(90), slerpFast), 7.3e-5);
+  EXPECT_LT(MaxInterpolationError(IGN_DTOR(180), slerpFast), 8e-4);
+  EXPECT_LT(MaxInterpolationError(IGN_DTOR(359), slerpFast), 8e-4);
+
+  math::Quaternionf f1(0.1f, 1.2f, 2.3f);
+  math::Quaternionf f2(0.2f, 1.1f, 2.4f);
+  EXPECT_TRUE(math::Quaternionf::SlerpFast(0.3f, f1, f2).Equal(
+      math::Quaternionf::Slerp(0.3f, f1, f2, true), 1e-5f));
+}
+
 /////////////////////////////////////////////////
 TEST(QuaternionTest, From2Axes)
 {
@@ -687,3 +855,28 @@ TEST(QuaternionTest, From2Axes)
   EXPECT_TRUE(math::equal(q2.Z(), 0.0));
 }
 
+
+/////////////////////////////////////////////////
+TEST(QuaternionTest, Constexpr)
+{
+  // 180 degree rotation around x
+  constexpr math::Quaterniond q(0, 1, 0, 0);
+  static_assert(static_cast<int>((q * q).W()) == -1, "");
+  static_assert(static_cast<int>(q.Dot(math::Quaterniond(1, 0, 0, 0))) == 0,
+                "");
+  static_assert(static_cast<int>((q + q - q).X()) == 1, "");
+
+  // Vector3 has a virtual destructor, so rotated vectors can be constexpr
+  // from C++20.
+#if __cplusplus >= 202002L
+  constexpr math::Vector3d v = q * math::Vector3d(1, 2, 3);
+  static_assert(static_cast<int>(v.X()) == 1 &&
+                static_cast<int>(v.Y()) == -2 &&
+                static_cast<int>(v.Z()) == -3, "");
+  static_assert(static_cast<int>(q.YAxis().Y()) == -1, "");
+#else
+  const math::Vector3d v = q * math::Vector3d(1, 2, 3);
+#endif
+  EXPECT_EQ(math::Vector3d(1, -2, -3), v);
+  EXPECT_EQ(math::Vector3d(0, -1, 0), q.YAxis());
+}
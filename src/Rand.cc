@@ -16,6 +16,7 @@
 */
 
 #include <sys/types.h>
+#include <atomic>
 #include <ctime>
 
 #ifdef _WIN32
@@ -30,12 +31,163 @@
 using namespace gz;
 using namespace math;
 
+/// \brief Private data for the RandomGenerator class.
+class gz::math::RandomGeneratorPrivate
+{
+  /// \brief Seed of the sequence.
+  public: unsigned int seed = 0;
+
+  /// \brief Index of the sequence derived from the seed.
+  public: uint64_t stream = 0;
+
+  /// \brief The engine.
+  public: GeneratorType engine;
+
+  /// \brief Uniform distribution. It is kept across calls for the
+  /// parameters to be the only per call state.
+  public: UniformRealDist uniform;
+
+  /// \brief Normal distribution. It is kept across calls so that the
+  /// second value produced by each draw of its algorithm is not wasted.
+  public: NormalRealDist normal;
+};
+
+namespace
+{
+  /// \brief Get the number of times Rand::Seed(unsigned int) was called,
+  /// which tells thread generators to seed themselves again.
+  /// \return Reference to the counter.
+  std::atomic<uint64_t> &SeedGeneration()
+  {
+    static std::atomic<uint64_t> generation{0};
+    return generation;
+  }
+
+  /// \brief Get the stream index of the next thread generator.
+  /// \return Reference to the counter.
+  std::atomic<uint64_t> &NextThreadStream()
+  {
+    static std::atomic<uint64_t> stream{0};
+    return stream;
+  }
+}
+
+//////////////////////////////////////////////////
+RandomGenerator::RandomGenerator()
+  : RandomGenerator(Rand::Seed())
+{
+}
+
+//////////////////////////////////////////////////
+RandomGenerator::RandomGenerator(unsigned int _seed, uint64_t _stream)
+  : dataPtr(new RandomGeneratorPrivate)
+{
+  this->Seed(_seed, _stream);
+}
+
+//////////////////////////////////////////////////
+RandomGenerator::RandomGenerator(const RandomGenerator &_gen)
+  : dataPtr(new RandomGeneratorPrivate(*_gen.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+RandomGenerator::~RandomGenerator()
+{
+}
+
+//////////////////////////////////////////////////
+RandomGenerator &RandomGenerator::operator=(const RandomGenerator &_gen)
+{
+  *this->dataPtr = *_gen.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void RandomGenerator::Seed(unsigned int _seed, uint64_t _stream)
+{
+  // The stream is mixed into the seed sequence, so that nearby streams of
+  // the same seed produce unrelated engine states.
+  std::seed_seq seq{static_cast<uint32_t>(_seed),
+                    static_cast<uint32_t>(_stream & 0xFFFFFFFFu),
+                    static_cast<uint32_t>(_stream >> 32)};
+  this->dataPtr->seed = _seed;
+  this->dataPtr->stream = _stream;
+  this->dataPtr->engine.seed(seq);
+  this->dataPtr->uniform.reset();
+  this->dataPtr->normal.reset();
+}
+
+//////////////////////////////////////////////////
+unsigned int RandomGenerator::Seed() const
+{
+  return this->dataPtr->seed;
+}
+
+//////////////////////////////////////////////////
+uint64_t RandomGenerator::Stream() const
+{
+  return this->dataPtr->stream;
+}
+
+//////////////////////////////////////////////////
+double RandomGenerator::DblUniform(double _min, double _max)
+{
+  return this->dataPtr->uniform(this->dataPtr->engine,
+      UniformRealDist::param_type(_min, _max));
+}
+
+//////////////////////////////////////////////////
+double RandomGenerator::DblNormal(double _mean, double _sigma)
+{
+  return this->dataPtr->normal(this->dataPtr->engine,
+      NormalRealDist::param_type(_mean, _sigma));
+}
+
+//////////////////////////////////////////////////
+int32_t RandomGenerator::IntUniform(int _min, int _max)
+{
+  UniformIntDist d(_min, _max);
+  return d(this->dataPtr->engine);
+}
+
+//////////////////////////////////////////////////
+int32_t RandomGenerator::IntNormal(int _mean, int _sigma)
+{
+  return static_cast<int32_t>(this->DblNormal(_mean, _sigma));
+}
+
+//////////////////////////////////////////////////
+void RandomGenerator::FillUniform(double *_values, const std::size_t _count,
+                                  double _min, double _max)
+{
+  const UniformRealDist::param_type param(_min, _max);
+  for (std::size_t i = 0; i < _count; ++i)
+    _values[i] = this->dataPtr->uniform(this->dataPtr->engine, param);
+}
+
+//////////////////////////////////////////////////
+void RandomGenerator::FillNormal(double *_values, const std::size_t _count,
+                                 double _mean, double _sigma)
+{
+  const NormalRealDist::param_type param(_mean, _sigma);
+  for (std::size_t i = 0; i < _count; ++i)
+    _values[i] = this->dataPtr->normal(this->dataPtr->engine, param);
+}
+
+//////////////////////////////////////////////////
+GeneratorType &RandomGenerator::Engine()
+{
+  return this->dataPtr->engine;
+}
+
 //////////////////////////////////////////////////
 void Rand::Seed(unsigned int _seed)
 {
   std::seed_seq seq{_seed};
   SeedMutable() = _seed;
   RandGenerator().seed(seq);
+  SeedGeneration().fetch_add(1, std::memory_order_release);
 }
 
 //////////////////////////////////////////////////
@@ -90,3 +242,27 @@ GeneratorType &Rand::RandGenerator()
   static GeneratorType randGenerator(Seed());
   return randGenerator;
 }
+
+//////////////////////////////////////////////////
+RandomGenerator &Rand::ThreadGenerator()
+{
+  thread_local const uint64_t stream = NextThreadStream().fetch_add(1);
+  thread_local uint64_t generation =
+      SeedGeneration().load(std::memory_order_acquire);
+  thread_local RandomGenerator generator(Seed(), stream);
+
+  // Seed again if Seed(unsigned int) was called since the last use
+  const uint64_t current = SeedGeneration().load(std::memory_order_acquire);
+  if (current != generation)
+  {
+    generation = current;
+    generator.Seed(Seed(), stream);
+  }
+  return generator;
+}
+
+//////////////////////////////////////////////////
+PhiloxEngine Rand::StreamEngine(uint64_t _stream, uint64_t _position)
+{
+  return PhiloxEngine(Seed(), _stream, _position);
+}
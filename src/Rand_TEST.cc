@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/Rand.hh"
 
@@ -77,3 +80,138 @@ TEST(RandTest, SetSeed)
     EXPECT_EQ(second[i], math::Rand::IntUniform(-10, 10));
   }
 }
+
+//////////////////////////////////////////////////
+TEST(RandTest, RandomGenerator)
+{
+  // The same seed and stream produce the same sequence
+  math::RandomGenerator a(1234, 7);
+  math::RandomGenerator b(1234, 7);
+  EXPECT_EQ(1234u, a.Seed());
+  EXPECT_EQ(7u, a.Stream());
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_DOUBLE_EQ(a.DblUniform(-1, 1), b.DblUniform(-1, 1));
+    EXPECT_DOUBLE_EQ(a.DblNormal(2, 3), b.DblNormal(2, 3));
+    EXPECT_EQ(a.IntUniform(-10, 10), b.IntUniform(-10, 10));
+    EXPECT_EQ(a.IntNormal(10, 5), b.IntNormal(10, 5));
+  }
+
+  // Copies continue the same sequence
+  math::RandomGenerator copy(a);
+  EXPECT_DOUBLE_EQ(a.DblNormal(), copy.DblNormal());
+  b = a;
+  EXPECT_DOUBLE_EQ(a.DblNormal(), b.DblNormal());
+  EXPECT_EQ(a.Engine()(), b.Engine()());
+
+  // Other streams and seeds produce other sequences
+  math::RandomGenerator otherStream(1234, 8);
+  math::RandomGenerator otherSeed(1235, 7);
+  a.Seed(1234, 7);
+  std::vector<double> first(8), second(8), third(8);
+  a.FillUniform(first.data(), first.size());
+  otherStream.FillUniform(second.data(), second.size());
+  otherSeed.FillUniform(third.data(), third.size());
+  EXPECT_NE(first, second);
+  EXPECT_NE(first, third);
+
+  // Seeding restarts the sequence
+  a.Seed(1234, 7);
+  for (double v : first)
+    EXPECT_DOUBLE_EQ(v, a.DblUniform());
+
+  // The default generator uses the global seed
+  math::Rand::Seed(42);
+  math::RandomGenerator defaultGen;
+  EXPECT_EQ(42u, defaultGen.Seed());
+  EXPECT_EQ(0u, defaultGen.Stream());
+}
+
+//////////////////////////////////////////////////
+TEST(RandTest, Fill)
+{
+  const std::size_t count = 1001;
+  std::vector<double> values(count);
+
+  // Fills produce the same values as the same number of single draws,
+  // including the odd count of normal values
+  math::RandomGenerator gen(5);
+  math::RandomGenerator reference(5);
+  gen.FillUniform(values.data(), count, 2, 3);
+  for (double v : values)
+  {
+    EXPECT_GE(v, 2);
+    EXPECT_LT(v, 3);
+    EXPECT_DOUBLE_EQ(reference.DblUniform(2, 3), v);
+  }
+  gen.FillNormal(values.data(), count, -1, 0.5);
+  for (double v : values)
+    EXPECT_DOUBLE_EQ(reference.DblNormal(-1, 0.5), v);
+  EXPECT_DOUBLE_EQ(reference.DblNormal(), gen.DblNormal());
+
+  // Rough moments of a large normal sample
+  values.resize(100000);
+  gen.FillNormal(values.data(), values.size(), 3, 2);
+  double sum = 0, sumSq = 0;
+  for (double v : values)
+  {
+    sum += v;
+    sumSq += v * v;
+  }
+  const double mean = sum / values.size();
+  const double variance = sumSq / values.size() - mean * mean;
+  EXPECT_NEAR(3.0, mean, 0.05);
+  EXPECT_NEAR(4.0, variance, 0.1);
+
+  // Nothing is written for an empty fill
+  gen.FillUniform(nullptr, 0);
+  gen.FillNormal(nullptr, 0);
+}
+
+//////////////////////////////////////////////////
+TEST(RandTest, ThreadGenerator)
+{
+  math::Rand::Seed(99);
+
+  // Each thread gets its own generator, with its own stream
+  const int numThreads = 4;
+  std::vector<uint64_t> streams(numThreads);
+  std::vector<double> values(numThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numThreads; ++i)
+  {
+    threads.emplace_back([&streams, &values, i]()
+    {
+      math::RandomGenerator &gen = math::Rand::ThreadGenerator();
+      EXPECT_EQ(&gen, &math::Rand::ThreadGenerator());
+      EXPECT_EQ(99u, gen.Seed());
+      streams[i] = gen.Stream();
+
+      // Same sequence as an owned generator with the same stream
+      math::RandomGenerator reference(99, gen.Stream());
+      values[i] = gen.DblUniform();
+      EXPECT_DOUBLE_EQ(reference.DblUniform(), values[i]);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (int i = 0; i < numThreads; ++i)
+  {
+    for (int j = i + 1; j < numThreads; ++j)
+    {
+      EXPECT_NE(streams[i], streams[j]);
+      EXPECT_NE(values[i], values[j]);
+    }
+  }
+
+  // Setting the seed restarts the generator of this thread
+  math::RandomGenerator &gen = math::Rand::ThreadGenerator();
+  const uint64_t stream = gen.Stream();
+  math::Rand::Seed(100);
+  EXPECT_EQ(100u, math::Rand::ThreadGenerator().Seed());
+  EXPECT_EQ(stream, math::Rand::ThreadGenerator().Stream());
+  const double first = math::Rand::ThreadGenerator().DblUniform();
+  math::Rand::Seed(100);
+  EXPECT_DOUBLE_EQ(first, math::Rand::ThreadGenerator().DblUniform());
+}
@@ -0,0 +1,856 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Matrix3.hh"
+#include "gz/math/Matrix4.hh"
+#include "gz/math/PhiloxEngine.hh"
+#include "gz/math/RansacFitter.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Vector4.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Private data for RansacFitter.
+class gz::math::RansacFitterPrivate
+{
+  /// \brief Maximum distance from an inlier to the surface of a shape.
+  public: double distanceThreshold = 0.01;
+
+  /// \brief Maximum number of hypotheses.
+  public: unsigned int maxIterations = 1000;
+
+  /// \brief Probability of a sample of inliers only to stop at.
+  public: double confidence = 0.99;
+
+  /// \brief Minimum number of inliers of a shape.
+  public: std::size_t minInliers = 0;
+
+  /// \brief Minimum radius of spheres and cylinders.
+  public: double minRadius = 0;
+
+  /// \brief Maximum radius of spheres and cylinders.
+  public: double maxRadius = std::numeric_limits<double>::infinity();
+
+  /// \brief Stream of the first hypothesis.
+  public: uint64_t stream = 0;
+
+  /// \brief Number of threads, 0 for hardware threads.
+  public: unsigned int threadCount = 1;
+
+  /// \brief Executor used instead of threadCount threads, if set.
+  public: std::shared_ptr<Executor> executor;
+};
+
+namespace
+{
+  /// \brief Number of points measured at once by the inlier counts.
+  constexpr std::size_t kChunk = 256;
+
+  /// \brief Parameters of a shape.
+  using Model = std::array<double, 7>;
+
+  //////////////////////////////////////////////////
+  /// \brief Get a vector from three consecutive parameters of a model.
+  /// \param[in] _model The model.
+  /// \param[in] _first Index of the first parameter.
+  /// \return The vector.
+  Vector3d ModelVector(const Model &_model, const std::size_t _first)
+  {
+    return Vector3d(_model[_first], _model[_first + 1],
+                    _model[_first + 2]);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Store a vector in three consecutive parameters of a model.
+  /// \param[in] _v The vector.
+  /// \param[in] _first Index of the first parameter.
+  /// \param[in,out] _model The model.
+  void SetModelVector(const Vector3d &_v, const std::size_t _first,
+                      Model &_model)
+  {
+    _model[_first] = _v.X();
+    _model[_first + 1] = _v.Y();
+    _model[_first + 2] = _v.Z();
+  }
+
+  /// \brief Plane n.p = d, with the parameters (n, d).
+  struct PlaneShape
+  {
+    /// \brief Number of points of a minimal sample.
+    static constexpr std::size_t kSampleSize = 3;
+
+    /// \brief Fit a plane through a sample.
+    /// \param[in] _points The points.
+    /// \param[in] _sample Indices of the sample.
+    /// \param[out] _model The plane.
+    /// \return False if the sample is degenerate.
+    bool FromSample(const Vector3SoAd &_points, const std::size_t *_sample,
+                    Model &_model) const
+    {
+      const Vector3d p0 = _points[_sample[0]];
+      const Vector3d e1 = _points[_sample[1]] - p0;
+      const Vector3d e2 = _points[_sample[2]] - p0;
+      const Vector3d n = e1.Cross(e2);
+      const double length2 = n.SquaredLength();
+      if (!(length2 > 1e-12 * e1.SquaredLength() * e2.SquaredLength()) ||
+          !std::isfinite(length2))
+      {
+        return false;
+      }
+      const Vector3d unit = n / std::sqrt(length2);
+      SetModelVector(unit, 0, _model);
+      _model[3] = unit.Dot(p0);
+      return true;
+    }
+
+    /// \brief Measure points against a plane: their signed distances.
+    /// \param[in] _points The points.
+    /// \param[in] _model The plane.
+    /// \param[in] _begin First point.
+    /// \param[in] _count Number of points.
+    /// \param[out] _out Measures.
+    void Measure(const Vector3SoAd &_points, const Model &_model,
+                 const std::size_t _begin, const std::size_t _count,
+                 double *_out) const
+    {
+      detail::PlaneDistances(_model[0], _model[1], _model[2], _model[3],
+          _points.XData() + _begin, _points.YData() + _begin,
+          _points.ZData() + _begin, _count, _out);
+    }
+
+    /// \brief Get the range of measures of inliers.
+    /// \param[in] _model The plane.
+    /// \param[in] _threshold Distance threshold.
+    /// \return Lowest and highest measures.
+    std::pair<double, double> Band(const Model &,
+                                   const double _threshold) const
+    {
+      return {-_threshold, _threshold};
+    }
+
+    /// \brief Fit a plane to inliers by least squares.
+    /// \param[in] _points The points.
+    /// \param[in] _inliers Indices of the inliers.
+    /// \param[in,out] _model The plane, which orients the result.
+    /// \return False if the inliers don't determine a plane.
+    bool Refine(const Vector3SoAd &_points,
+                const std::vector<std::size_t> &_inliers,
+                Model &_model) const
+    {
+      Vector3d centroid;
+      for (const std::size_t i : _inliers)
+        centroid += _points[i];
+      centroid /= static_cast<double>(_inliers.size());
+
+      double c[6] = {0, 0, 0, 0, 0, 0};
+      for (const std::size_t i : _inliers)
+      {
+        const Vector3d d = _points[i] - centroid;
+        c[0] += d.X() * d.X();
+        c[1] += d.X() * d.Y();
+        c[2] += d.X() * d.Z();
+        c[3] += d.Y() * d.Y();
+        c[4] += d.Y() * d.Z();
+        c[5] += d.Z() * d.Z();
+      }
+      Vector3d values;
+      Matrix3d vectors;
+      Matrix3d(c[0], c[1], c[2], c[1], c[3], c[4], c[2], c[4], c[5])
+          .SymmetricEigen(values, vectors);
+      if (!(values[1] > 1e-6 * values[2]))
+        return false;
+
+      Vector3d n(vectors(0, 0), vectors(1, 0), vectors(2, 0));
+      if (n.Dot(ModelVector(_model, 0)) < 0)
+        n = -n;
+      SetModelVector(n, 0, _model);
+      _model[3] = n.Dot(centroid);
+      return true;
+    }
+  };
+
+  /// \brief Sphere of center c and radius r, with the parameters (c, r).
+  struct SphereShape
+  {
+    /// \brief Number of points of a minimal sample.
+    static constexpr std::size_t kSampleSize = 4;
+
+    /// \brief Fitter data, for the radius limits.
+    const RansacFitterPrivate &data;
+
+    /// \brief Fit a sphere through a sample.
+    /// \param[in] _points The points.
+    /// \param[in] _sample Indices of the sample.
+    /// \param[out] _model The sphere.
+    /// \return False if the sample is degenerate, or the radius is out of
+    /// the limits.
+    bool FromSample(const Vector3SoAd &_points, const std::size_t *_sample,
+                    Model &_model) const
+    {
+      // The center is equidistant from the points:
+      // 2 (p_i - p_0).c = |p_i|^2 - |p_0|^2, relative to p_0.
+      const Vector3d p0 = _points[_sample[0]];
+      const Vector3d e1 = _points[_sample[1]] - p0;
+      const Vector3d e2 = _points[_sample[2]] - p0;
+      const Vector3d e3 = _points[_sample[3]] - p0;
+      const Matrix3d a(e1.X(), e1.Y(), e1.Z(),
+                       e2.X(), e2.Y(), e2.Z(),
+                       e3.X(), e3.Y(), e3.Z());
+      const double det = a.Determinant();
+      const double scale = e1.Length() * e2.Length() * e3.Length();
+      if (!(std::abs(det) > 1e-6 * scale) || !std::isfinite(det))
+        return false;
+      const Vector3d c = a.Inverse() * Vector3d(e1.SquaredLength(),
+          e2.SquaredLength(), e3.SquaredLength()) * 0.5;
+      SetModelVector(p0 + c, 0, _model);
+      _model[3] = c.Length();
+      return this->InLimits(_model[3]);
+    }
+
+    /// \brief Check a radius against the limits.
+    /// \param[in] _radius The radius.
+    /// \return True if it is within the limits.
+    bool InLimits(const double _radius) const
+    {
+      return _radius >= this->data.minRadius &&
+          _radius <= this->data.maxRadius;
+    }
+
+    /// \brief Measure points against a sphere: their squared distances
+    /// to its center.
+    /// \param[in] _points The points.
+    /// \param[in] _model The sphere.
+    /// \param[in] _begin First point.
+    /// \param[in] _count Number of points.
+    /// \param[out] _out Measures.
+    void Measure(const Vector3SoAd &_points, const Model &_model,
+                 const std::size_t _begin, const std::size_t _count,
+                 double *_out) const
+    {
+      const double *x = _points.XData() + _begin;
+      const double *y = _points.YData() + _begin;
+      const double *z = _points.ZData() + _begin;
+      const double cx = _model[0], cy = _model[1], cz = _model[2];
+      for (std::size_t i = 0; i < _count; ++i)
+      {
+        const double dx = x[i] - cx, dy = y[i] - cy, dz = z[i] - cz;
+        _out[i] = dx * dx + dy * dy + dz * dz;
+      }
+    }
+
+    /// \brief Get the range of measures of inliers.
+    /// \param[in] _model The sphere.
+    /// \param[in] _threshold Distance threshold.
+    /// \return Lowest and highest measures.
+    std::pair<double, double> Band(const Model &_model,
+                                   const double _threshold) const
+    {
+      const double inner = std::max(0.0, _model[3] - _threshold);
+      const double outer = _model[3] + _threshold;
+      return {inner * inner, outer * outer};
+    }
+
+    /// \brief Fit a sphere to inliers by least squares.
+    /// \param[in] _points The points.
+    /// \param[in] _inliers Indices of the inliers.
+    /// \param[in,out] _model The sphere, whose center is the origin of
+    /// the fit.
+    /// \return False if the inliers don't determine a sphere.
+    bool Refine(const Vector3SoAd &_points,
+                const std::vector<std::size_t> &_inliers,
+                Model &_model) const
+    {
+      const Vector3d origin = ModelVector(_model, 0);
+      Matrix4d normal = Matrix4d::Zero;
+      Vector4d rhs;
+      for (const std::size_t i : _inliers)
+      {
+        const Vector3d q = _points[i] - origin;
+        const double row[4] = {2 * q.X(), 2 * q.Y(), 2 * q.Z(), 1};
+        const double b = q.SquaredLength();
+        for (int r = 0; r < 4; ++r)
+        {
+          for (int k = 0; k < 4; ++k)
+            normal(r, k) += row[r] * row[k];
+          rhs[r] += row[r] * b;
+        }
+      }
+      // The normal equations of the algebraic fit |q|^2 = 2 q.c + k, for
+      // the center c and k = r^2 - |c|^2. The matrix is symmetric.
+      // The determinant of the symmetric positive semidefinite matrix is
+      // at most the product of its diagonal, which gives a relative
+      // tolerance for singular matrices.
+      const double det = normal.Determinant();
+      const double scale = normal(0, 0) * normal(1, 1) * normal(2, 2) *
+          normal(3, 3);
+      if (!std::isfinite(det) ||
+          std::abs(det) <= std::numeric_limits<double>::epsilon() * scale)
+      {
+        return false;
+      }
+      const Vector4d solution = rhs * normal.Inverse();
+      const Vector3d c(solution[0], solution[1], solution[2]);
+      const double radius2 = solution[3] + c.SquaredLength();
+      if (!(radius2 > 0) || !this->InLimits(std::sqrt(radius2)))
+        return false;
+      SetModelVector(origin + c, 0, _model);
+      _model[3] = std::sqrt(radius2);
+      return true;
+    }
+  };
+
+  /// \brief Cylinder of axis point a, unit axis direction u and radius r,
+  /// with the parameters (a, u, r).
+  struct CylinderShape
+  {
+    /// \brief Number of points of a minimal sample.
+    static constexpr std::size_t kSampleSize = 2;
+
+    /// \brief Fitter data, for the radius limits.
+    const RansacFitterPrivate &data;
+
+    /// \brief Normal of each point.
+    const Vector3SoAd &normals;
+
+    /// \brief Check a radius against the limits.
+    /// \param[in] _radius The radius.
+    /// \return True if it is within the limits.
+    bool InLimits(const double _radius) const
+    {
+      return _radius >= this->data.minRadius &&
+          _radius <= this->data.maxRadius;
+    }
+
+    /// \brief Fit a cylinder through a sample.
+    /// \param[in] _points The points.
+    /// \param[in] _sample Indices of the sample.
+    /// \param[out] _model The cylinder.
+    /// \return False if the sample is degenerate, or the radius is out of
+    /// the limits.
+    bool FromSample(const Vector3SoAd &_points, const std::size_t *_sample,
+                    Model &_model) const
+    {
+      const Vector3d p1 = _points[_sample[0]];
+      const Vector3d p2 = _points[_sample[1]];
+      const Vector3d n1 = this->normals[_sample[0]];
+      const Vector3d n2 = this->normals[_sample[1]];
+
+      // The axis is perpendicular to both normals, and crosses the lines
+      // along them.
+      Vector3d u = n1.Cross(n2);
+      const double length = u.Length();
+      if (!(length > 1e-3) || !std::isfinite(length))
+        return false;
+      u /= length;
+
+      const Vector3d w = p1 - p2;
+      const double a = n1.Dot(n1), b = n1.Dot(n2), c = n2.Dot(n2);
+      const double d = n1.Dot(w), e = n2.Dot(w);
+      const double denom = a * c - b * b;
+      const double s = (b * e - c * d) / denom;
+      const double t = (a * e - b * d) / denom;
+      const Vector3d center = ((p1 + n1 * s) + (p2 + n2 * t)) * 0.5;
+      const Vector3d axisPoint = center - u * center.Dot(u);
+
+      const Vector3d offset = (p1 - axisPoint).Cross(u);
+      _model[6] = offset.Length();
+      SetModelVector(axisPoint, 0, _model);
+      SetModelVector(u, 3, _model);
+      return std::isfinite(_model[6]) && this->InLimits(_model[6]);
+    }
+
+    /// \brief Measure points against a cylinder: their squared distances
+    /// to its axis.
+    /// \param[in] _points The points.
+    /// \param[in] _model The cylinder.
+    /// \param[in] _begin First point.
+    /// \param[in] _count Number of points.
+    /// \param[out] _out Measures.
+    void Measure(const Vector3SoAd &_points, const Model &_model,
+                 const std::size_t _begin, const std::size_t _count,
+                 double *_out) const
+    {
+      const double *x = _points.XData() + _begin;
+      const double *y = _points.YData() + _begin;
+      const double *z = _points.ZData() + _begin;
+      const double ax = _model[0], ay = _model[1], az = _model[2];
+      const double ux = _model[3], uy = _model[4], uz = _model[5];
+      for (std::size_t i = 0; i < _count; ++i)
+      {
+        const double wx = x[i] - ax, wy = y[i] - ay, wz = z[i] - az;
+        const double cx = wy * uz - wz * uy;
+        const double cy = wz * ux - wx * uz;
+        const double cz = wx * uy - wy * ux;
+        _out[i] = cx * cx + cy * cy + cz * cz;
+      }
+    }
+
+    /// \brief Get the range of measures of inliers.
+    /// \param[in] _model The cylinder.
+    /// \param[in] _threshold Distance threshold.
+    /// \return Lowest and highest measures.
+    std::pair<double, double> Band(const Model &_model,
+                                   const double _threshold) const
+    {
+      const double inner = std::max(0.0, _model[6] - _threshold);
+      const double outer = _model[6] + _threshold;
+      return {inner * inner, outer * outer};
+    }
+
+    /// \brief Fit a cylinder to inliers by least squares: the axis is the
+    /// direction most perpendicular to their normals, and the circle is
+    /// fit to the inliers projected along it.
+    /// \param[in] _points The points.
+    /// \param[in] _inliers Indices of the inliers.
+    /// \param[in,out] _model The cylinder, which orients the result.
+    /// \return False if the inliers don't determine a cylinder.
+    bool Refine(const Vector3SoAd &_points,
+                const std::vector<std::size_t> &_inliers,
+                Model &_model) const
+    {
+      double m[6] = {0, 0, 0, 0, 0, 0};
+      for (const std::size_t i : _inliers)
+      {
+        const Vector3d n = this->normals[i];
+        m[0] += n.X() * n.X();
+        m[1] += n.X() * n.Y();
+        m[2] += n.X() * n.Z();
+        m[3] += n.Y() * n.Y();
+        m[4] += n.Y() * n.Z();
+        m[5] += n.Z() * n.Z();
+      }
+      Vector3d values;
+      Matrix3d vectors;
+      Matrix3d(m[0], m[1], m[2], m[1], m[3], m[4], m[2], m[4], m[5])
+          .SymmetricEigen(values, vectors);
+      Vector3d u(vectors(0, 0), vectors(1, 0), vectors(2, 0));
+      if (u.Dot(ModelVector(_model, 3)) < 0)
+        u = -u;
+      const Vector3d e1(vectors(0, 1), vectors(1, 1), vectors(2, 1));
+      const Vector3d e2(vectors(0, 2), vectors(1, 2), vectors(2, 2));
+
+      const Vector3d origin = ModelVector(_model, 0);
+      Matrix3d normal = Matrix3d::Zero;
+      Vector3d rhs;
+      for (const std::size_t i : _inliers)
+      {
+        const Vector3d q = _points[i] - origin;
+        const double qx = q.Dot(e1), qy = q.Dot(e2);
+        const double row[3] = {2 * qx, 2 * qy, 1};
+        const double b = qx * qx + qy * qy;
+        for (int r = 0; r < 3; ++r)
+        {
+          for (int k = 0; k < 3; ++k)
+            normal(r, k) += row[r] * row[k];
+          rhs[r] += row[r] * b;
+        }
+      }
+      // Algebraic circle fit, as for spheres
+      const double det = normal.Determinant();
+      const double scale = normal(0, 0) * normal(1, 1) * normal(2, 2);
+      if (!std::isfinite(det) ||
+          std::abs(det) <= std::numeric_limits<double>::epsilon() * scale)
+      {
+        return false;
+      }
+      const Vector3d solution = normal.Inverse() * rhs;
+      const double radius2 = solution[2] + solution[0] * solution[0] +
+          solution[1] * solution[1];
+      if (!(radius2 > 0) || !this->InLimits(std::sqrt(radius2)))
+        return false;
+
+      const Vector3d center = origin + e1 * solution[0] + e2 * solution[1];
+      SetModelVector(center - u * center.Dot(u), 0, _model);
+      SetModelVector(u, 3, _model);
+      _model[6] = std::sqrt(radius2);
+      return true;
+    }
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Count the inliers of a shape.
+  /// \param[in] _shape The shape type.
+  /// \param[in] _points The points.
+  /// \param[in] _model The shape.
+  /// \param[in] _threshold Distance threshold.
+  /// \return Number of inliers.
+  template<typename Shape>
+  std::size_t CountInliers(const Shape &_shape, const Vector3SoAd &_points,
+                           const Model &_model, const double _threshold)
+  {
+    const std::pair<double, double> band = _shape.Band(_model, _threshold);
+    double measures[kChunk];
+    std::size_t count = 0;
+    for (std::size_t begin = 0; begin < _points.Size(); begin += kChunk)
+    {
+      const std::size_t size = std::min(kChunk, _points.Size() - begin);
+      _shape.Measure(_points, _model, begin, size, measures);
+      count += detail::CountInRange(measures, size, band.first, band.second);
+    }
+    return count;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Find the inliers of a shape.
+  /// \param[in] _shape The shape type.
+  /// \param[in] _points The points.
+  /// \param[in] _model The shape.
+  /// \param[in] _threshold Distance threshold.
+  /// \param[out] _inliers Indices of the inliers, in increasing order.
+  template<typename Shape>
+  void FindInliers(const Shape &_shape, const Vector3SoAd &_points,
+                   const Model &_model, const double _threshold,
+                   std::vector<std::size_t> &_inliers)
+  {
+    const std::pair<double, double> band = _shape.Band(_model, _threshold);
+    double measures[kChunk];
+    _inliers.clear();
+    for (std::size_t begin = 0; begin < _points.Size(); begin += kChunk)
+    {
+      const std::size_t size = std::min(kChunk, _points.Size() - begin);
+      _shape.Measure(_points, _model, begin, size, measures);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        if (measures[i] >= band.first && measures[i] <= band.second)
+          _inliers.push_back(begin + i);
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the number of hypotheses after which a sample of inliers
+  /// only has been drawn with a given probability.
+  /// \param[in] _ratio Ratio of inliers.
+  /// \param[in] _sampleSize Number of points of a sample.
+  /// \param[in] _confidence The probability.
+  /// \param[in] _max Maximum number of hypotheses.
+  /// \return Number of hypotheses, at most _max.
+  unsigned int RequiredIterations(const double _ratio,
+      const std::size_t _sampleSize, const double _confidence,
+      const unsigned int _max)
+  {
+    if (!(_confidence < 1))
+      return _max;
+    if (!(_confidence > 0))
+      return 0;
+    const double good = std::pow(_ratio, static_cast<double>(_sampleSize));
+    if (!(good > 0))
+      return _max;
+    if (!(good < 1))
+      return 1;
+    const double required =
+        std::ceil(std::log1p(-_confidence) / std::log1p(-good));
+    if (!(required < _max))
+      return _max;
+    return static_cast<unsigned int>(required);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Draw distinct random points.
+  /// \param[in] _engine Engine of the hypothesis.
+  /// \param[in] _count Number of points.
+  /// \param[in] _size Number of points to draw.
+  /// \param[out] _sample Indices of the points.
+  /// \return False if distinct points could not be drawn.
+  bool DrawSample(PhiloxEngine &_engine, const std::size_t _count,
+                  const std::size_t _size, std::size_t *_sample)
+  {
+    std::size_t drawn = 0;
+    for (int attempt = 0; attempt < 100 && drawn < _size; ++attempt)
+    {
+      const uint64_t high = _engine();
+      const uint64_t r = (high << 32) | _engine();
+      const std::size_t index = static_cast<std::size_t>(r % _count);
+      if (std::find(_sample, _sample + drawn, index) == _sample + drawn)
+        _sample[drawn++] = index;
+    }
+    return drawn == _size;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Run RANSAC for a shape.
+  /// \param[in] _data Fitter data.
+  /// \param[in] _shape The shape type.
+  /// \param[in] _points The points.
+  /// \param[out] _model The shape found.
+  /// \return Statistics and inliers of the fit.
+  template<typename Shape>
+  RansacFitter::Result Fit(const RansacFitterPrivate &_data,
+      const Shape &_shape, const Vector3SoAd &_points, Model &_model)
+  {
+    RansacFitter::Result result;
+    const std::size_t count = _points.Size();
+    const std::size_t needed =
+        std::max<std::size_t>(_data.minInliers, Shape::kSampleSize);
+    if (count < needed)
+      return result;
+
+    static SerialExecutor serial;
+    std::unique_ptr<Executor> local;
+    Executor *executor = _data.executor.get();
+    if (!executor)
+    {
+      std::size_t threads = _data.threadCount;
+      if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+      threads = std::min<std::size_t>(threads,
+                                      RansacFitter::kHypothesesPerRound);
+      executor = &serial;
+      if (threads > 1)
+      {
+        local.reset(new ThreadPool(static_cast<unsigned int>(threads)));
+        executor = local.get();
+      }
+    }
+
+    std::vector<Model> models(RansacFitter::kHypothesesPerRound);
+    std::vector<std::size_t> counts(RansacFitter::kHypothesesPerRound);
+    std::size_t bestCount = 0;
+    Model best{};
+    unsigned int required = _data.maxIterations;
+    while (result.iterations < required)
+    {
+      const unsigned int first = result.iterations;
+      const unsigned int round = std::min(RansacFitter::kHypothesesPerRound,
+                                          required - first);
+      executor->Run(round, [&](const std::size_t _k)
+      {
+        PhiloxEngine engine = Rand::StreamEngine(_data.stream + first + _k);
+        std::size_t sample[Shape::kSampleSize];
+        counts[_k] = 0;
+        if (DrawSample(engine, count, Shape::kSampleSize, sample) &&
+            _shape.FromSample(_points, sample, models[_k]))
+        {
+          counts[_k] = CountInliers(_shape, _points, models[_k],
+                                    _data.distanceThreshold);
+        }
+      });
+      result.iterations += round;
+
+      for (unsigned int k = 0; k < round; ++k)
+      {
+        if (counts[k] > bestCount)
+        {
+          bestCount = counts[k];
+          best = models[k];
+        }
+      }
+      if (bestCount > 0)
+      {
+        required = std::max(result.iterations, RequiredIterations(
+            static_cast<double>(bestCount) / count, Shape::kSampleSize,
+            _data.confidence, _data.maxIterations));
+      }
+    }
+    if (bestCount < needed)
+      return result;
+
+    // Refit the best hypothesis to its inliers, and keep the refit if it
+    // doesn't lose any.
+    FindInliers(_shape, _points, best, _data.distanceThreshold,
+                result.inliers);
+    Model refined = best;
+    if (_shape.Refine(_points, result.inliers, refined))
+    {
+      std::vector<std::size_t> inliers;
+      FindInliers(_shape, _points, refined, _data.distanceThreshold,
+                  inliers);
+      if (inliers.size() >= result.inliers.size())
+      {
+        best = refined;
+        result.inliers = std::move(inliers);
+      }
+    }
+    result.found = true;
+    _model = best;
+    return result;
+  }
+}
+
+/////////////////////////////////////////////////
+RansacFitter::RansacFitter()
+  : dataPtr(std::make_unique<RansacFitterPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+RansacFitter::RansacFitter(const RansacFitter &_other)
+  : dataPtr(std::make_unique<RansacFitterPrivate>(*_other.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+RansacFitter::~RansacFitter() = default;
+
+/////////////////////////////////////////////////
+RansacFitter &RansacFitter::operator=(const RansacFitter &_other)
+{
+  *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void RansacFitter::SetDistanceThreshold(const double _distance)
+{
+  this->dataPtr->distanceThreshold = _distance;
+}
+
+/////////////////////////////////////////////////
+double RansacFitter::DistanceThreshold() const
+{
+  return this->dataPtr->distanceThreshold;
+}
+
+/////////////////////////////////////////////////
+void RansacFitter::SetMaxIterations(const unsigned int _iterations)
+{
+  this->dataPtr->maxIterations = _iterations;
+}
+
+/////////////////////////////////////////////////
+unsigned int RansacFitter::MaxIterations() const
+{
+  return this->dataPtr->maxIterations;
+}
+
+/////////////////////////////////////////////////
+void RansacFitter::SetConfidence(const double _confidence)
+{
+  this->dataPtr->confidence = _confidence;
+}
+
+/////////////////////////////////////////////////
+double RansacFitter::Confidence() const
+{
+  return this->dataPtr->confidence;
+}
+
+/////////////////////////////////////////////////
+void RansacFitter::SetMinInliers(const std::size_t _inliers)
+{
+  this->dataPtr->minInliers = _inliers;
+}
+
+/////////////////////////////////////////////////
+std::size_t RansacFitter::MinInliers() const
+{
+  return this->dataPtr->minInliers;
+}
+
+/////////////////////////////////////////////////
+void RansacFitter::SetRadiusLimits(const double _min, const double _max)
+{
+  this->dataPtr->minRadius = _min;
+  this->dataPtr->maxRadius = _max;
+}
+
+/////////////////////////////////////////////////
+double RansacFitter::MinRadius() const
+{
+  return this->dataPtr->minRadius;
+}
+
+/////////////////////////////////////////////////
+double RansacFitter::MaxRadius() const
+{
+  return this->dataPtr->maxRadius;
+}
+
+/////////////////////////////////////////////////
+void RansacFitter::SetStream(const uint64_t _stream)
+{
+  this->dataPtr->stream = _stream;
+}
+
+/////////////////////////////////////////////////
+uint64_t RansacFitter::Stream() const
+{
+  return this->dataPtr->stream;
+}
+
+/////////////////////////////////////////////////
+void RansacFitter::SetThreadCount(const unsigned int _threads)
+{
+  this->dataPtr->threadCount = _threads;
+}
+
+/////////////////////////////////////////////////
+unsigned int RansacFitter::ThreadCount() const
+{
+  return this->dataPtr->threadCount;
+}
+
+/////////////////////////////////////////////////
+void RansacFitter::SetExecutor(std::shared_ptr<Executor> _executor)
+{
+  this->dataPtr->executor = std::move(_executor);
+}
+
+/////////////////////////////////////////////////
+RansacFitter::Result RansacFitter::FitPlane(const Vector3SoAd &_points,
+    Planed &_plane) const
+{
+  Model model{};
+  Result result = Fit(*this->dataPtr, PlaneShape(), _points, model);
+  if (result.found)
+    _plane.Set(ModelVector(model, 0), model[3]);
+  return result;
+}
+
+/////////////////////////////////////////////////
+RansacFitter::Result RansacFitter::FitSphere(const Vector3SoAd &_points,
+    Vector3d &_center, double &_radius) const
+{
+  Model model{};
+  Result result = Fit(*this->dataPtr, SphereShape{*this->dataPtr},
+                      _points, model);
+  if (result.found)
+  {
+    _center = ModelVector(model, 0);
+    _radius = model[3];
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+RansacFitter::Result RansacFitter::FitCylinder(const Vector3SoAd &_points,
+    const Vector3SoAd &_normals, Vector3d &_axisPoint,
+    Vector3d &_axisDirection, double &_radius) const
+{
+  if (_normals.Size() != _points.Size())
+    return Result();
+
+  Model model{};
+  Result result = Fit(*this->dataPtr,
+      CylinderShape{*this->dataPtr, _normals}, _points, model);
+  if (result.found)
+  {
+    _axisPoint = ModelVector(model, 0);
+    _axisDirection = ModelVector(model, 3);
+    _radius = model[6];
+  }
+  return result;
+}
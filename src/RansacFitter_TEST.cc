@@ -0,0 +1,304 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "gz/math/Executor.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/RansacFitter.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Append points scattered uniformly in a box.
+  void AddOutliers(const std::size_t _count, Vector3SoAd &_points)
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      _points.PushBack(Vector3d(Rand::DblUniform(-2, 2),
+          Rand::DblUniform(-2, 2), Rand::DblUniform(-2, 2)));
+    }
+  }
+
+  /// \brief Check that the first points are all inliers.
+  void ExpectInliers(const std::size_t _count,
+                     const RansacFitter::Result &_result)
+  {
+    ASSERT_GE(_result.inliers.size(), _count);
+    for (std::size_t i = 0; i < _count; ++i)
+      EXPECT_EQ(i, _result.inliers[i]);
+    for (std::size_t i = 1; i < _result.inliers.size(); ++i)
+      EXPECT_LT(_result.inliers[i - 1], _result.inliers[i]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(RansacFitterTest, Defaults)
+{
+  RansacFitter ransac;
+  EXPECT_DOUBLE_EQ(0.01, ransac.DistanceThreshold());
+  EXPECT_EQ(1000u, ransac.MaxIterations());
+  EXPECT_DOUBLE_EQ(0.99, ransac.Confidence());
+  EXPECT_EQ(0u, ransac.MinInliers());
+  EXPECT_DOUBLE_EQ(0.0, ransac.MinRadius());
+  EXPECT_TRUE(std::isinf(ransac.MaxRadius()));
+  EXPECT_EQ(0u, ransac.Stream());
+  EXPECT_EQ(1u, ransac.ThreadCount());
+
+  ransac.SetDistanceThreshold(0.1);
+  ransac.SetMaxIterations(50);
+  ransac.SetConfidence(0.9);
+  ransac.SetMinInliers(20);
+  ransac.SetRadiusLimits(0.5, 2.0);
+  ransac.SetStream(7);
+  ransac.SetThreadCount(4);
+  EXPECT_DOUBLE_EQ(0.1, ransac.DistanceThreshold());
+  EXPECT_EQ(50u, ransac.MaxIterations());
+  EXPECT_DOUBLE_EQ(0.9, ransac.Confidence());
+  EXPECT_EQ(20u, ransac.MinInliers());
+  EXPECT_DOUBLE_EQ(0.5, ransac.MinRadius());
+  EXPECT_DOUBLE_EQ(2.0, ransac.MaxRadius());
+  EXPECT_EQ(7u, ransac.Stream());
+  EXPECT_EQ(4u, ransac.ThreadCount());
+
+  RansacFitter copy(ransac);
+  EXPECT_EQ(50u, copy.MaxIterations());
+  RansacFitter assigned;
+  assigned = ransac;
+  EXPECT_EQ(7u, assigned.Stream());
+}
+
+/////////////////////////////////////////////////
+TEST(RansacFitterTest, Plane)
+{
+  Rand::Seed(11);
+  const Vector3d normal = Vector3d(-0.1, 0.2, 1).Normalize();
+  Vector3SoAd points;
+  for (int i = 0; i < 2000; ++i)
+  {
+    const double x = Rand::DblUniform(-2, 2);
+    const double y = Rand::DblUniform(-2, 2);
+    points.PushBack(Vector3d(x, y, 1 + 0.1 * x - 0.2 * y) +
+        normal * Rand::DblUniform(-0.005, 0.005));
+  }
+  AddOutliers(1000, points);
+
+  RansacFitter ransac;
+  ransac.SetDistanceThreshold(0.02);
+  Planed plane;
+  const RansacFitter::Result result = ransac.FitPlane(points, plane);
+  EXPECT_TRUE(result.found);
+  ExpectInliers(2000, result);
+  EXPECT_LT(result.inliers.size(), 2100u);
+  EXPECT_NEAR(1.0, std::abs(plane.Normal().Dot(normal)), 1e-5);
+  EXPECT_NEAR(1.0, plane.Normal().Length(), 1e-12);
+  EXPECT_NEAR(std::abs(plane.Offset()), normal.Z(), 1e-3);
+
+  // Two thirds of inliers: a few rounds are enough
+  EXPECT_GE(result.iterations, RansacFitter::kHypothesesPerRound);
+  EXPECT_LT(result.iterations, 200u);
+
+  // Without early stops, every hypothesis is evaluated
+  ransac.SetConfidence(1.0);
+  ransac.SetMaxIterations(100);
+  Planed all;
+  EXPECT_EQ(100u, ransac.FitPlane(points, all).iterations);
+}
+
+/////////////////////////////////////////////////
+TEST(RansacFitterTest, Sphere)
+{
+  Rand::Seed(12);
+  const Vector3d center(1, 2, 3);
+  Vector3SoAd points;
+  for (int i = 0; i < 500; ++i)
+  {
+    const Vector3d dir = Vector3d(Rand::DblNormal(), Rand::DblNormal(),
+                                  Rand::DblNormal()).Normalize();
+    points.PushBack(center + dir * (0.5 + Rand::DblUniform(-0.002, 0.002)));
+  }
+  AddOutliers(500, points);
+
+  RansacFitter ransac;
+  ransac.SetDistanceThreshold(0.01);
+  Vector3d c;
+  double radius = 0;
+  RansacFitter::Result result = ransac.FitSphere(points, c, radius);
+  EXPECT_TRUE(result.found);
+  ExpectInliers(500, result);
+  EXPECT_TRUE(c.Equal(center, 1e-3));
+  EXPECT_NEAR(0.5, radius, 1e-3);
+
+  // Radius limits reject it
+  ransac.SetRadiusLimits(1.0, 2.0);
+  ransac.SetMinInliers(100);
+  radius = 0;
+  result = ransac.FitSphere(points, c, radius);
+  EXPECT_FALSE(result.found);
+  EXPECT_TRUE(result.inliers.empty());
+  EXPECT_DOUBLE_EQ(0.0, radius);
+}
+
+/////////////////////////////////////////////////
+TEST(RansacFitterTest, Cylinder)
+{
+  Rand::Seed(13);
+  const Vector3d axisPoint(0, 1, 0);
+  const Vector3d axis = Vector3d(0.2, 0.1, 1).Normalize();
+  const Vector3d e1 = axis.Cross(Vector3d::UnitX).Normalize();
+  const Vector3d e2 = axis.Cross(e1);
+  Vector3SoAd points;
+  Vector3SoAd normals;
+  for (int i = 0; i < 1000; ++i)
+  {
+    const double angle = Rand::DblUniform(0, 2 * IGN_PI);
+    const Vector3d n = e1 * std::cos(angle) + e2 * std::sin(angle);
+    points.PushBack(axisPoint + axis * Rand::DblUniform(-1, 1) +
+                    n * (0.3 + Rand::DblUniform(-0.002, 0.002)));
+    normals.PushBack(n);
+  }
+  AddOutliers(300, points);
+  for (int i = 0; i < 300; ++i)
+  {
+    normals.PushBack(Vector3d(Rand::DblNormal(), Rand::DblNormal(),
+                              Rand::DblNormal()).Normalize());
+  }
+
+  RansacFitter ransac;
+  ransac.SetDistanceThreshold(0.01);
+  Vector3d point;
+  Vector3d direction;
+  double radius = 0;
+  RansacFitter::Result result =
+      ransac.FitCylinder(points, normals, point, direction, radius);
+  EXPECT_TRUE(result.found);
+  ExpectInliers(1000, result);
+  EXPECT_NEAR(1.0, std::abs(direction.Dot(axis)), 1e-5);
+  EXPECT_NEAR(0.3, radius, 1e-3);
+  EXPECT_NEAR(0.0, point.Dot(direction), 1e-12);
+  EXPECT_NEAR(0.0, (point - axisPoint).Cross(direction).Length(), 1e-3);
+
+  // A normal per point is required
+  Vector3SoAd fewer = normals;
+  fewer.Resize(10);
+  result = ransac.FitCylinder(points, fewer, point, direction, radius);
+  EXPECT_FALSE(result.found);
+  EXPECT_EQ(0u, result.iterations);
+}
+
+/////////////////////////////////////////////////
+TEST(RansacFitterTest, Reproducible)
+{
+  Rand::Seed(14);
+  Vector3SoAd points;
+  for (int i = 0; i < 3000; ++i)
+  {
+    points.PushBack(Vector3d(Rand::DblUniform(-5, 5),
+        Rand::DblUniform(-5, 5), Rand::DblUniform(-0.01, 0.01)));
+  }
+  AddOutliers(3000, points);
+
+  RansacFitter ransac;
+  ransac.SetDistanceThreshold(0.02);
+  Planed serial;
+  const RansacFitter::Result expected = ransac.FitPlane(points, serial);
+  EXPECT_TRUE(expected.found);
+
+  auto expectSame = [&](const RansacFitter &_fitter)
+  {
+    Planed plane;
+    const RansacFitter::Result result = _fitter.FitPlane(points, plane);
+    EXPECT_EQ(expected.iterations, result.iterations);
+    EXPECT_EQ(expected.inliers, result.inliers);
+    EXPECT_EQ(serial.Normal(), plane.Normal());
+    EXPECT_DOUBLE_EQ(serial.Offset(), plane.Offset());
+  };
+
+  expectSame(ransac);
+  ransac.SetThreadCount(4);
+  expectSame(ransac);
+  ransac.SetExecutor(std::make_shared<ThreadPool>(3));
+  expectSame(ransac);
+  ransac.SetExecutor(std::make_shared<FunctionExecutor>(
+      [](const std::size_t _count,
+         const std::function<void(std::size_t)> &_task)
+      {
+        for (std::size_t i = _count; i-- > 0;)
+          _task(i);
+      }, 5));
+  expectSame(ransac);
+
+  // The samples depend on the seed and the stream
+  ransac.SetStream(1000);
+  Planed other;
+  const RansacFitter::Result shifted = ransac.FitPlane(points, other);
+  EXPECT_TRUE(shifted.found);
+  EXPECT_NEAR(1.0, std::abs(other.Normal().Z()), 1e-4);
+}
+
+/////////////////////////////////////////////////
+TEST(RansacFitterTest, Degenerate)
+{
+  RansacFitter ransac;
+  const Planed unchanged(Vector3d::UnitX, 3.0);
+  Planed plane = unchanged;
+
+  // Too few points
+  RansacFitter::Result result = ransac.FitPlane(
+      Vector3SoAd(std::vector<Vector3d>{Vector3d::Zero, Vector3d::UnitX}),
+      plane);
+  EXPECT_FALSE(result.found);
+  EXPECT_EQ(0u, result.iterations);
+  EXPECT_EQ(unchanged.Normal(), plane.Normal());
+
+  // Collinear points and points that aren't finite
+  Vector3SoAd line;
+  for (int i = 0; i < 50; ++i)
+    line.PushBack(Vector3d(i, 2 * i, 0));
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  line.PushBack(Vector3d(nan, 0, 0));
+  ransac.SetMaxIterations(64);
+  result = ransac.FitPlane(line, plane);
+  EXPECT_FALSE(result.found);
+  EXPECT_EQ(64u, result.iterations);
+  EXPECT_DOUBLE_EQ(3.0, plane.Offset());
+
+  // Not enough inliers
+  Vector3SoAd square;
+  for (int i = 0; i < 10; ++i)
+  {
+    for (int j = 0; j < 10; ++j)
+      square.PushBack(Vector3d(i, j, 1));
+  }
+  ransac.SetMinInliers(101);
+  EXPECT_FALSE(ransac.FitPlane(square, plane).found);
+  ransac.SetMinInliers(100);
+  result = ransac.FitPlane(square, plane);
+  EXPECT_TRUE(result.found);
+  EXPECT_EQ(100u, result.inliers.size());
+  EXPECT_NEAR(1.0, std::abs(plane.Normal().Z()), 1e-12);
+  EXPECT_NEAR(1.0, std::abs(plane.Offset()), 1e-12);
+}
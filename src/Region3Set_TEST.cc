@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "gz/math/Helpers.hh"
+#include "gz/math/Region3Set.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(Region3SetTest, FewRegions)
+{
+  const math::Region3Setd set({
+      math::Region3d::Closed(0., 0., 0., 1., 1., 1.),
+      math::Region3d::Open(0.5, 0.5, 0.5, 2., 2., 2.),
+      math::Region3d()});
+  EXPECT_FALSE(set.Empty());
+  EXPECT_TRUE(math::Region3Setd().Empty());
+  EXPECT_TRUE(math::Region3Setd({math::Region3d()}).Empty());
+
+  EXPECT_TRUE(set.Contains(math::Vector3d(1., 1., 1.)));
+  EXPECT_EQ(0u, set.RegionIndex(math::Vector3d(1., 1., 1.)));
+  EXPECT_EQ(1u, set.RegionIndex(math::Vector3d(1.5, 1., 1.)));
+  EXPECT_FALSE(set.Contains(math::Vector3d(2., 1., 1.)));
+  EXPECT_EQ(math::Region3Setd::kNoRegion,
+            set.RegionIndex(math::Vector3d(2., 1., 1.)));
+
+  EXPECT_FALSE(set.Intersects(
+      math::Region3d::Closed(2., 2., 2., 3., 3., 3.)));
+  EXPECT_TRUE(set.Intersects(math::Region3d::Closed(1., 1., 1., 3., 3., 3.)));
+
+  std::ostringstream os;
+  os << math::Region3Setd({math::Region3d::Closed(0., 0., 0., 1., 1., 1.)});
+  EXPECT_EQ("([0, 1] x [0, 1] x [0, 1])", os.str());
+}
+
+/////////////////////////////////////////////////
+TEST(Region3SetTest, Indexed)
+{
+  // Many small zones and an unbounded slab, checked against a scan.
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> u(-100., 100.);
+  std::uniform_real_distribution<double> size(0., 10.);
+  std::vector<math::Region3d> regions;
+  for (int i = 0; i < 500; ++i)
+  {
+    const math::Vector3d p(u(rng), u(rng), u(rng) / 10.);
+    regions.push_back(math::Region3d::Closed(
+        p.X(), p.Y(), p.Z(), p.X() + size(rng), p.Y() + size(rng),
+        p.Z() + 1.));
+  }
+  regions.emplace_back(math::Intervald::Unbounded,
+                       math::Intervald::Unbounded,
+                       math::Intervald::Open(50., math::INF_D));
+  const math::Region3Setd set(regions);
+
+  for (int i = 0; i < 5000; ++i)
+  {
+    const math::Vector3d p(u(rng), u(rng), u(rng));
+    std::size_t expected = math::Region3Setd::kNoRegion;
+    for (std::size_t r = 0; r < regions.size(); ++r)
+    {
+      if (regions[r].Contains(p))
+      {
+        expected = r;
+        break;
+      }
+    }
+    EXPECT_EQ(expected, set.RegionIndex(p));
+
+    const math::Region3d box = math::Region3d::Closed(
+        p.X(), p.Y(), p.Z(), p.X() + 2., p.Y() + 2., p.Z() + 2.);
+    bool intersects = false;
+    for (const auto &region : regions)
+      intersects = intersects || region.Intersects(box);
+    EXPECT_EQ(intersects, set.Intersects(box));
+  }
+
+  EXPECT_TRUE(set.Contains(math::Vector3d(1e6, -1e6, 1e3)));
+  EXPECT_FALSE(set.Contains(math::Vector3d(1e6, -1e6, 0.)));
+  EXPECT_FALSE(set.Contains(math::Vector3d(math::NAN_D, 0., 60.)));
+}
@@ -15,8 +15,11 @@
  *
 */
 #include <gtest/gtest.h>
+#include <cstdint>
 #include <ostream>
+#include <vector>
 
+#include "gz/math/Helpers.hh"
 #include "gz/math/Region3.hh"
 
 using namespace gz;
@@ -149,6 +152,24 @@ TEST(Region3Test, RegionIntersection)
       math::Region3d::Open(-1., -1., -1., 0., 0., 0.)));
 }
 
+/////////////////////////////////////////////////
+TEST(Region3Test, RegionIntersectionOf)
+{
+  const math::Region3d region =
+      math::Region3d::Closed(0., 0., 0., 1., 1., 1.);
+  EXPECT_EQ(math::Region3d(
+                math::Intervald::Closed(0.5, 1.),
+                math::Intervald::LeftClosed(0., 0.5),
+                math::Intervald::Closed(0., 1.)),
+            region.Intersection(math::Region3d(
+                math::Intervald::Closed(0.5, 1.5),
+                math::Intervald::Open(-0.5, 0.5),
+                math::Intervald::Unbounded)));
+  EXPECT_EQ(region, region.Intersection(math::Region3d::Unbounded));
+  EXPECT_TRUE(region.Intersection(
+      math::Region3d::Open(1., 1., 1., 2., 2., 2.)).Empty());
+}
+
 /////////////////////////////////////////////////
 TEST(IntervalTest, RegionStreaming)
 {
@@ -173,3 +194,50 @@ TEST(IntervalTest, RegionStreaming)
     EXPECT_EQ(os.str(), "[0, 100) x (-100, 0] x [0, 1]");
   }
 }
+
+/////////////////////////////////////////////////
+TEST(Region3Test, BatchContains)
+{
+  // Points on a lattice, which puts many of them on the bounds.
+  std::vector<math::Vector3d> points;
+  for (int z = -1; z <= 2; ++z)
+  {
+    for (int y = -1; y <= 2; ++y)
+    {
+      for (int x = -1; x <= 2; ++x)
+        points.emplace_back(0.5 * x, 0.5 * y, 0.5 * z);
+    }
+  }
+  points.emplace_back(math::NAN_D, 0.5, 0.5);
+  points.emplace_back(0.5, math::INF_D, 0.5);
+  const math::Vector3SoAd soa(points);
+
+  for (const auto &region : {
+          math::Region3d::Open(0., 0., 0., 1., 1., 1.),
+          math::Region3d::Closed(0., 0., 0., 1., 1., 1.),
+          math::Region3d(math::Intervald::LeftClosed(0., 1.),
+                         math::Intervald::RightClosed(0., 1.),
+                         math::Intervald::Open(0., 1.)),
+          math::Region3d(math::Intervald::Unbounded,
+                         math::Intervald::Closed(0.5, 0.5),
+                         math::Intervald::LeftClosed(0., 1.)),
+          math::Region3d()})
+  {
+    std::vector<uint64_t> contained;
+    std::vector<uint64_t> containedSoA;
+    const std::size_t count =
+        region.Contains(points.data(), points.size(), contained);
+    EXPECT_EQ(count, region.Contains(soa, containedSoA));
+    EXPECT_EQ(contained, containedSoA);
+    ASSERT_EQ(2u, contained.size());
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      const bool bit = (contained[i / 64] >> (i % 64)) & 1;
+      EXPECT_EQ(region.Contains(points[i]), bit) << region << " "
+                                                 << points[i];
+      expected += region.Contains(points[i]);
+    }
+    EXPECT_EQ(expected, count);
+  }
+}
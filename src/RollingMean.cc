@@ -15,9 +15,8 @@
  *
 */
 
-#include <numeric>
 #include <limits>
-#include <deque>
+#include <vector>
 #include "gz/math/RollingMean.hh"
 
 using namespace gz::math;
@@ -25,19 +24,31 @@ using namespace gz::math;
 /// \brief Private data
 class gz::math::RollingMeanPrivate
 {
-  /// \brief The window size
-  public: size_t windowSize{10};
+  /// \brief Allocate the buffer for a window size and clear the values.
+  /// \param[in] _windowSize The window size.
+  public: void Resize(size_t _windowSize)
+  {
+    this->values.assign(_windowSize, 0.0);
+    this->oldest = 0;
+    this->count = 0;
+  }
+
+  /// \brief The values, in a ring buffer of the window size allocated
+  /// up front, so that Push never allocates.
+  public: std::vector<double> values;
 
-  /// \brief The values.
-  public: std::deque<double> values;
+  /// \brief Index of the oldest value.
+  public: size_t oldest{0};
+
+  /// \brief Number of values.
+  public: size_t count{0};
 };
 
 //////////////////////////////////////////////////
 RollingMean::RollingMean(size_t _windowSize)
   : dataPtr(new RollingMeanPrivate)
 {
-  if (_windowSize > 0)
-    this->dataPtr->windowSize = _windowSize;
+  this->dataPtr->Resize(_windowSize > 0 ? _windowSize : 10);
 }
 
 //////////////////////////////////////////////////
@@ -48,11 +59,18 @@ RollingMean::~RollingMean()
 //////////////////////////////////////////////////
 double RollingMean::Mean() const
 {
-  if (!this->dataPtr->values.empty())
+  const auto &d = *this->dataPtr;
+  if (d.count > 0)
   {
-    return std::accumulate(
-        this->dataPtr->values.begin(), this->dataPtr->values.end(), 0.0) /
-      this->dataPtr->values.size();
+    // Sum from the oldest value, as values were pushed
+    double sum = 0.0;
+    for (size_t i = 0, j = d.oldest; i < d.count; ++i)
+    {
+      sum += d.values[j];
+      if (++j == d.values.size())
+        j = 0;
+    }
+    return sum / d.count;
   }
 
   return std::numeric_limits<double>::quiet_NaN();
@@ -61,38 +79,41 @@ double RollingMean::Mean() const
 //////////////////////////////////////////////////
 size_t RollingMean::Count() const
 {
-  return this->dataPtr->values.size();
+  return this->dataPtr->count;
 }
 
 //////////////////////////////////////////////////
 void RollingMean::Push(double _value)
 {
-  this->dataPtr->values.push_back(_value);
-  while (this->dataPtr->values.size() > this->dataPtr->windowSize &&
-         !this->dataPtr->values.empty())
-  {
-    this->dataPtr->values.pop_front();
-  }
+  auto &d = *this->dataPtr;
+  const size_t windowSize = d.values.size();
+  size_t next = d.oldest + d.count;
+  if (next >= windowSize)
+    next -= windowSize;
+  d.values[next] = _value;
+
+  if (d.count < windowSize)
+    ++d.count;
+  else if (++d.oldest == windowSize)
+    d.oldest = 0;
 }
 
 //////////////////////////////////////////////////
 void RollingMean::Clear()
 {
-  this->dataPtr->values.clear();
+  this->dataPtr->oldest = 0;
+  this->dataPtr->count = 0;
 }
 
 //////////////////////////////////////////////////
 void RollingMean::SetWindowSize(size_t _windowSize)
 {
   if (_windowSize > 0)
-  {
-    this->dataPtr->windowSize = _windowSize;
-    this->Clear();
-  }
+    this->dataPtr->Resize(_windowSize);
 }
 
 //////////////////////////////////////////////////
 size_t RollingMean::WindowSize() const
 {
-  return this->dataPtr->windowSize;
+  return this->dataPtr->values.size();
 }
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/RollingMean.hh"
 
@@ -55,3 +57,72 @@ TEST(RollingMeanTest, RollingMean)
   mean.SetWindowSize(2);
   EXPECT_EQ(0u, mean.Count());
 }
+
+/////////////////////////////////////////////////
+TEST(RollingMeanTest, FixedRollingMean)
+{
+  math::FixedRollingMean<4> mean;
+  EXPECT_EQ(0u, mean.Count());
+  EXPECT_EQ(4u, mean.WindowSize());
+  EXPECT_TRUE(math::isnan(mean.Mean()));
+
+  mean.Push(1.0);
+  EXPECT_DOUBLE_EQ(1.0, mean.Mean());
+  mean.Push(2.0);
+  EXPECT_DOUBLE_EQ(1.5, mean.Mean());
+  mean.Push(3.0);
+  EXPECT_DOUBLE_EQ(2.0, mean.Mean());
+  mean.Push(10.0);
+  EXPECT_DOUBLE_EQ(4.0, mean.Mean());
+  mean.Push(20.0);
+  EXPECT_DOUBLE_EQ(8.75, mean.Mean());
+  EXPECT_EQ(4u, mean.Count());
+
+  mean.Clear();
+  EXPECT_EQ(0u, mean.Count());
+  EXPECT_TRUE(math::isnan(mean.Mean()));
+
+  // Matches RollingMean over a long run
+  math::RollingMean dynamicMean(4);
+  for (int i = 0; i < 10000; ++i)
+  {
+    const double value = std::sin(i * 0.1) * 1e3 + 1e6;
+    mean.Push(value);
+    dynamicMean.Push(value);
+  }
+  EXPECT_NEAR(dynamicMean.Mean(), mean.Mean(), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(RollingMeanTest, FixedRollingMeanNonFinite)
+{
+  // A NaN is averaged while in the window, and dropped with it
+  math::FixedRollingMean<3> mean;
+  mean.Push(math::NAN_D);
+  EXPECT_TRUE(math::isnan(mean.Mean()));
+  mean.Push(1.0);
+  mean.Push(2.0);
+  EXPECT_TRUE(math::isnan(mean.Mean()));
+  mean.Push(3.0);
+  EXPECT_DOUBLE_EQ(2.0, mean.Mean());
+  mean.Push(4.0);
+  EXPECT_DOUBLE_EQ(3.0, mean.Mean());
+
+  // inf - inf is NaN, so an infinite value must not stick either
+  mean.Push(math::INF_D);
+  EXPECT_FALSE(std::isfinite(mean.Mean()));
+  mean.Push(5.0);
+  mean.Push(6.0);
+  mean.Push(7.0);
+  EXPECT_DOUBLE_EQ(6.0, mean.Mean());
+
+  // Before the window is full
+  mean.Clear();
+  mean.Push(1.0);
+  mean.Push(-math::INF_D);
+  EXPECT_FALSE(std::isfinite(mean.Mean()));
+  mean.Push(2.0);
+  mean.Push(3.0);
+  mean.Push(4.0);
+  EXPECT_DOUBLE_EQ(3.0, mean.Mean());
+}
@@ -14,6 +14,11 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "gz/math/Instrumentation.hh"
 #include "gz/math/Quaternion.hh"
 #include "gz/math/RotationSpline.hh"
 #include "RotationSplinePrivate.hh"
@@ -23,10 +28,29 @@ using namespace math;
 
 /////////////////////////////////////////////////
 RotationSpline::RotationSpline()
-: dataPtr(new RotationSplinePrivate)
+: RotationSpline(std::pmr::get_default_resource())
+{
+}
+
+/////////////////////////////////////////////////
+RotationSpline::RotationSpline(std::pmr::memory_resource *_resource)
+: dataPtr(new RotationSplinePrivate(_resource))
+{
+}
+
+/////////////////////////////////////////////////
+RotationSpline::RotationSpline(const RotationSpline &_other)
+: dataPtr(new RotationSplinePrivate(*_other.dataPtr))
 {
 }
 
+/////////////////////////////////////////////////
+RotationSpline::RotationSpline(RotationSpline &&_other) noexcept
+: dataPtr(_other.dataPtr)
+{
+  _other.dataPtr = nullptr;
+}
+
 /////////////////////////////////////////////////
 RotationSpline::~RotationSpline()
 {
@@ -34,20 +58,58 @@ RotationSpline::~RotationSpline()
   this->dataPtr = NULL;
 }
 
+/////////////////////////////////////////////////
+RotationSpline &RotationSpline::operator=(const RotationSpline &_other)
+{
+  // A moved from spline has no data
+  if (this->dataPtr == nullptr)
+    this->dataPtr = new RotationSplinePrivate(*_other.dataPtr);
+  else
+    this->dataPtr->data = _other.dataPtr->data;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+RotationSpline &RotationSpline::operator=(RotationSpline &&_other) noexcept
+{
+  std::swap(this->dataPtr, _other.dataPtr);
+  return *this;
+}
+
+/////////////////////////////////////////////////
+RotationSplineData &RotationSplinePrivate::Mutable()
+{
+  if (this->data.use_count() > 1)
+  {
+    IGN_MATH_COUNT_COPY(PIMPL, sizeof(RotationSplineData));
+    this->data = std::make_shared<RotationSplineData>(*this->data);
+  }
+  return *this->data;
+}
+
 /////////////////////////////////////////////////
 void RotationSpline::AddPoint(const Quaterniond &_p)
 {
-  this->dataPtr->points.push_back(_p);
-  if (this->dataPtr->autoCalc)
+  this->dataPtr->Mutable();
+  this->dataPtr->data->points.push_back(_p);
+  this->dataPtr->data->segmentsDirty = true;
+  if (this->dataPtr->data->autoCalc)
     this->RecalcTangents();
 }
 
 /////////////////////////////////////////////////
 Quaterniond RotationSpline::Interpolate(double _t,
                                         const bool _useShortestPath)
+{
+  return std::as_const(*this).Interpolate(_t, _useShortestPath);
+}
+
+/////////////////////////////////////////////////
+Quaterniond RotationSpline::Interpolate(double _t,
+                                        const bool _useShortestPath) const
 {
   // Work out which segment this is in
-  double fSeg = _t * (this->dataPtr->points.size() - 1);
+  double fSeg = _t * (this->dataPtr->data->points.size() - 1);
   unsigned int segIdx = (unsigned int)fSeg;
 
   // Apportion t
@@ -59,35 +121,81 @@ Quaterniond RotationSpline::Interpolate(double _t,
 /////////////////////////////////////////////////
 Quaterniond RotationSpline::Interpolate(const unsigned int _fromIndex,
     const double _t, const bool _useShortestPath)
+{
+  return std::as_const(*this).Interpolate(_fromIndex, _t, _useShortestPath);
+}
+
+/////////////////////////////////////////////////
+Quaterniond RotationSpline::Interpolate(const unsigned int _fromIndex,
+    const double _t, const bool _useShortestPath) const
 {
   // Bounds check
-  if (_fromIndex >= this->dataPtr->points.size())
+  if (_fromIndex >= this->dataPtr->data->points.size())
     return Quaterniond(INF_D, INF_D, INF_D, INF_D);
 
-  if ((_fromIndex + 1) == this->dataPtr->points.size())
+  if ((_fromIndex + 1) == this->dataPtr->data->points.size())
   {
     // Duff request, cannot blend to nothing
     // Just return source
-    return this->dataPtr->points[_fromIndex];
+    return this->dataPtr->data->points[_fromIndex];
   }
 
   // Fast special cases
   if (equal(_t, 0.0))
-    return this->dataPtr->points[_fromIndex];
+    return this->dataPtr->data->points[_fromIndex];
   else if (equal(_t, 1.0))
-    return this->dataPtr->points[_fromIndex + 1];
+    return this->dataPtr->data->points[_fromIndex + 1];
 
   // double interpolation
   // Use squad using tangents we've already set up
-  Quaterniond &p = this->dataPtr->points[_fromIndex];
-  Quaterniond &q = this->dataPtr->points[_fromIndex+1];
-  Quaterniond &a = this->dataPtr->tangents[_fromIndex];
-  Quaterniond &b = this->dataPtr->tangents[_fromIndex+1];
+  this->dataPtr->data->UpdateSegments();
+  if (_fromIndex < this->dataPtr->data->segments.size())
+  {
+    return this->dataPtr->data->segments[_fromIndex].Interpolate(
+        _t, _useShortestPath);
+  }
+
+  const Quaterniond &p = this->dataPtr->data->points[_fromIndex];
+  const Quaterniond &q = this->dataPtr->data->points[_fromIndex+1];
+  const Quaterniond &a = this->dataPtr->data->tangents[_fromIndex];
+  const Quaterniond &b = this->dataPtr->data->tangents[_fromIndex+1];
 
   // NB interpolate to nearest rotation
   return Quaterniond::Squad(_t, p, a, b, q, _useShortestPath);
 }
 
+/////////////////////////////////////////////////
+bool RotationSpline::Interpolate(const double *_t, const size_t _count,
+    Quaterniond *_rotations, const bool _useShortestPath)
+{
+  return std::as_const(*this).Interpolate(_t, _count, _rotations,
+                                          _useShortestPath);
+}
+
+/////////////////////////////////////////////////
+bool RotationSpline::Interpolate(const double *_t, const size_t _count,
+    Quaterniond *_rotations, const bool _useShortestPath) const
+{
+  const size_t numPoints = this->dataPtr->data->points.size();
+  if (numPoints == 0)
+  {
+    std::fill(_rotations, _rotations + _count,
+              Quaterniond(INF_D, INF_D, INF_D, INF_D));
+    return false;
+  }
+
+  this->dataPtr->data->UpdateSegments();
+  for (size_t i = 0; i < _count; ++i)
+  {
+    // Work out which segment this is in, as in Interpolate(double)
+    double fSeg = _t[i] * (numPoints - 1);
+    unsigned int segIdx = (unsigned int)fSeg;
+    _rotations[i] = this->Interpolate(segIdx, fSeg - segIdx,
+                                      _useShortestPath);
+  }
+  return true;
+}
+
 /////////////////////////////////////////////////
 void RotationSpline::RecalcTangents()
 {
@@ -101,10 +209,11 @@ void RotationSpline::RecalcTangents()
   //
   // Assume endpoint tangents are parallel with line with neighbour
 
+  this->dataPtr->Mutable();
   unsigned int i;
   bool isClosed;
 
-  size_t numPoints = this->dataPtr->points.size();
+  size_t numPoints = this->dataPtr->data->points.size();
 
   if (numPoints < 2)
   {
@@ -112,9 +221,10 @@ void RotationSpline::RecalcTangents()
     return;
   }
 
-  this->dataPtr->tangents.resize(numPoints);
+  this->dataPtr->data->tangents.resize(numPoints);
 
-  if (this->dataPtr->points[0] == this->dataPtr->points[numPoints-1])
+  const auto &points = this->dataPtr->data->points;
+  if (points[0] == points[numPoints-1])
     isClosed = true;
   else
     isClosed = false;
@@ -122,17 +232,17 @@ void RotationSpline::RecalcTangents()
   Quaterniond invp, part1, part2, preExp;
   for (i = 0; i < numPoints; ++i)
   {
-    Quaterniond &p = this->dataPtr->points[i];
+    Quaterniond &p = this->dataPtr->data->points[i];
     invp = p.Inverse();
 
     if (i == 0)
     {
       // special case start
-      part1 = (invp * this->dataPtr->points[i+1]).Log();
+      part1 = (invp * this->dataPtr->data->points[i+1]).Log();
       if (isClosed)
       {
         // Use numPoints-2 since numPoints-1 == end == start == this one
-        part2 = (invp * this->dataPtr->points[numPoints-2]).Log();
+        part2 = (invp * this->dataPtr->data->points[numPoints-2]).Log();
       }
       else
       {
@@ -145,23 +255,27 @@ void RotationSpline::RecalcTangents()
       if (isClosed)
       {
         // Wrap to [1] (not [0], this is the same as end == this one)
-        part1 = (invp * this->dataPtr->points[1]).Log();
+        part1 = (invp * this->dataPtr->data->points[1]).Log();
       }
       else
       {
         part1 = (invp * p).Log();
       }
-      part2 = (invp * this->dataPtr->points[i-1]).Log();
+      part2 = (invp * this->dataPtr->data->points[i-1]).Log();
     }
     else
     {
-      part1 = (invp * this->dataPtr->points[i+1]).Log();
-      part2 = (invp * this->dataPtr->points[i-1]).Log();
+      part1 = (invp * this->dataPtr->data->points[i+1]).Log();
+      part2 = (invp * this->dataPtr->data->points[i-1]).Log();
     }
 
     preExp = (part1 + part2) * -0.25;
-    this->dataPtr->tangents[i] = p * preExp.Exp();
+    this->dataPtr->data->tangents[i] = p * preExp.Exp();
   }
+
+  // Cache the slerp terms of every segment
+  this->dataPtr->data->segmentsDirty = true;
+  this->dataPtr->data->UpdateSegments();
 }
 
 /////////////////////////////////////////////////
@@ -169,36 +283,41 @@ const Quaterniond &RotationSpline::Point(const unsigned int _index) const
 {
   static Quaterniond inf(INF_D, INF_D, INF_D, INF_D);
 
-  if (this->dataPtr->points.empty())
+  if (this->dataPtr->data->points.empty())
     return inf;
 
-  return this->dataPtr->points[
+  return this->dataPtr->data->points[
     clamp(_index, 0u, static_cast<unsigned int>(
-          this->dataPtr->points.size()-1))];
+          this->dataPtr->data->points.size()-1))];
 }
 
 /////////////////////////////////////////////////
 unsigned int RotationSpline::PointCount() const
 {
-  return static_cast<unsigned int>(this->dataPtr->points.size());
+  return static_cast<unsigned int>(this->dataPtr->data->points.size());
 }
 
 /////////////////////////////////////////////////
 void RotationSpline::Clear()
 {
-  this->dataPtr->points.clear();
-  this->dataPtr->tangents.clear();
+  this->dataPtr->Mutable();
+  this->dataPtr->data->points.clear();
+  this->dataPtr->data->tangents.clear();
+  this->dataPtr->data->segments.clear();
+  this->dataPtr->data->segmentsDirty = true;
 }
 
 /////////////////////////////////////////////////
 bool RotationSpline::UpdatePoint(const unsigned int _index,
                                  const Quaterniond &_value)
 {
-  if (_index >= this->dataPtr->points.size())
+  if (_index >= this->dataPtr->data->points.size())
     return false;
 
-  this->dataPtr->points[_index] = _value;
-  if (this->dataPtr->autoCalc)
+  this->dataPtr->Mutable();
+  this->dataPtr->data->points[_index] = _value;
+  this->dataPtr->data->segmentsDirty = true;
+  if (this->dataPtr->data->autoCalc)
     this->RecalcTangents();
 
   return true;
@@ -207,5 +326,18 @@ bool RotationSpline::UpdatePoint(const unsigned int _index,
 /////////////////////////////////////////////////
 void RotationSpline::AutoCalculate(bool _autoCalc)
 {
-  this->dataPtr->autoCalc = _autoCalc;
+  this->dataPtr->Mutable();
+  this->dataPtr->data->autoCalc = _autoCalc;
+}
+
+/////////////////////////////////////////////////
+void RotationSpline::Finalize()
+{
+  this->dataPtr->data->UpdateSegments();
+}
+
+/////////////////////////////////////////////////
+bool RotationSpline::Finalized() const
+{
+  return !this->dataPtr->data->segmentsDirty.load(std::memory_order_acquire);
 }
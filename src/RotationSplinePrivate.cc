@@ -14,13 +14,120 @@
  * limitations under the License.
  *
 */
+#include <cmath>
+
 #include "RotationSplinePrivate.hh"
 
 using namespace gz;
 using namespace math;
 
 /////////////////////////////////////////////////
-RotationSplinePrivate::RotationSplinePrivate()
-: autoCalc(true)
+RotationSplineData::RotationSplineData(
+    std::pmr::memory_resource *_resource)
+: autoCalc(true), points(_resource), tangents(_resource), segments(_resource)
+{
+}
+
+/////////////////////////////////////////////////
+RotationSplineData::RotationSplineData(
+    const RotationSplineData &_other)
+: autoCalc(_other.autoCalc),
+  points(_other.points, _other.points.get_allocator()),
+  tangents(_other.tangents, _other.tangents.get_allocator()),
+  segments(_other.segments.get_allocator())
+{
+  // Other splines sharing _other may be building its segments
+  std::lock_guard<std::mutex> lock(_other.segmentsMutex);
+  this->segments = _other.segments;
+  this->segmentsDirty = _other.segmentsDirty.load();
+}
+
+/////////////////////////////////////////////////
+void SlerpArc::Set(const Quaterniond &_p, const Quaterniond &_q,
+                   const bool _shortestPath)
+{
+  this->start = _p;
+
+  double fCos = _p.Dot(_q);
+
+  // Do we need to invert rotation?
+  if (fCos < 0.0 && _shortestPath)
+  {
+    fCos = -fCos;
+    this->end = -_q;
+  }
+  else
+  {
+    this->end = _q;
+  }
+
+  // Same threshold as Quaterniond::Slerp
+  this->linear = !(std::abs(fCos) < 1 - 1e-03);
+  if (!this->linear)
+  {
+    double fSin = std::sqrt(1 - (fCos*fCos));
+    this->angle = std::atan2(fSin, fCos);
+    this->invSin = 1.0 / fSin;
+  }
+}
+
+/////////////////////////////////////////////////
+Quaterniond SlerpArc::Interpolate(const double _t) const
 {
+  if (!this->linear)
+  {
+    double fCoeff0 = std::sin((1.0 - _t) * this->angle) * this->invSin;
+    double fCoeff1 = std::sin(_t * this->angle) * this->invSin;
+    return this->start * fCoeff0 + this->end * fCoeff1;
+  }
+
+  Quaterniond t = this->start * (1.0 - _t) + this->end * _t;
+  // taking the complement requires renormalisation
+  t.Normalize();
+  return t;
+}
+
+/////////////////////////////////////////////////
+void SquadSegment::Set(const Quaterniond &_p, const Quaterniond &_a,
+                       const Quaterniond &_b, const Quaterniond &_q)
+{
+  this->pointArc.Set(_p, _q, false);
+  this->shortestPointArc.Set(_p, _q, true);
+  this->tangentArc.Set(_a, _b, false);
+}
+
+/////////////////////////////////////////////////
+Quaterniond SquadSegment::Interpolate(const double _t,
+                                      const bool _shortestPath) const
+{
+  double fSlerpT = 2.0*_t*(1.0-_t);
+  Quaterniond kSlerpP = _shortestPath ?
+      this->shortestPointArc.Interpolate(_t) :
+      this->pointArc.Interpolate(_t);
+  Quaterniond kSlerpQ = this->tangentArc.Interpolate(_t);
+  return Quaterniond::Slerp(fSlerpT, kSlerpP, kSlerpQ);
+}
+
+/////////////////////////////////////////////////
+void RotationSplineData::UpdateSegments()
+{
+  if (!this->segmentsDirty.load(std::memory_order_acquire))
+    return;
+
+  std::lock_guard<std::mutex> lock(this->segmentsMutex);
+  if (!this->segmentsDirty.load(std::memory_order_relaxed))
+    return;
+
+  this->segments.clear();
+  if (this->points.size() >= 2 &&
+      this->tangents.size() == this->points.size())
+  {
+    this->segments.resize(this->points.size() - 1);
+    for (size_t i = 0; i < this->segments.size(); ++i)
+    {
+      this->segments[i].Set(this->points[i], this->tangents[i],
+                            this->tangents[i+1], this->points[i+1]);
+    }
+  }
+  this->segmentsDirty.store(false, std::memory_order_release);
 }
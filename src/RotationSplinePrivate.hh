@@ -17,6 +17,10 @@
 #ifndef GZ_MATH_ROTATIONSPLINEPRIVATE_HH_
 #define GZ_MATH_ROTATIONSPLINEPRIVATE_HH_
 
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <vector>
 #include <gz/math/config.hh>
 #include "gz/math/Quaternion.hh"
@@ -28,21 +32,136 @@ namespace ignition
     inline namespace IGNITION_MATH_VERSION_NAMESPACE
     {
     /// \internal
-    /// \brief Private data for RotationSpline
-    class RotationSplinePrivate
+    /// \brief Spherical linear interpolation between two quaternions, with
+    /// the terms that do not depend on the interpolation parameter
+    /// computed once. The result is the same as Quaterniond::Slerp.
+    class SlerpArc
+    {
+      /// \brief Sets the ends of the arc.
+      /// \param[in] _p the beginning quaternion
+      /// \param[in] _q the end quaternion
+      /// \param[in] _shortestPath when true, the rotation may be inverted
+      /// to minimize rotation
+      public: void Set(const Quaterniond &_p, const Quaterniond &_q,
+                       const bool _shortestPath);
+
+      /// \brief Interpolates along the arc.
+      /// \param[in] _t the interpolation parameter
+      /// \return The interpolated quaternion
+      public: Quaterniond Interpolate(const double _t) const;
+
+      /// \brief the beginning quaternion
+      private: Quaterniond start;
+
+      /// \brief the end quaternion, inverted if that is shorter
+      private: Quaterniond end;
+
+      /// \brief angle between the ends
+      private: double angle = 0.0;
+
+      /// \brief inverse of the sine of the angle between the ends
+      private: double invSin = 0.0;
+
+      /// \brief true if the ends are too close, or too far, to use the
+      /// standard slerp formula, in which case they are interpolated
+      /// linearly
+      private: bool linear = true;
+    };
+
+    /// \internal
+    /// \brief SQUAD interpolation over one segment of a rotation spline,
+    /// with the slerp arcs between its points and between its tangents
+    /// computed once. The result is the same as Quaterniond::Squad.
+    class SquadSegment
+    {
+      /// \brief Sets the points and tangents of the segment.
+      /// \param[in] _p the beginning point
+      /// \param[in] _a the beginning tangent
+      /// \param[in] _b the end tangent
+      /// \param[in] _q the end point
+      public: void Set(const Quaterniond &_p, const Quaterniond &_a,
+                       const Quaterniond &_b, const Quaterniond &_q);
+
+      /// \brief Interpolates the segment.
+      /// \param[in] _t the interpolation parameter
+      /// \param[in] _shortestPath when true, the rotation between the
+      /// points may be inverted to minimize rotation
+      /// \return The interpolated rotation
+      public: Quaterniond Interpolate(const double _t,
+                                      const bool _shortestPath) const;
+
+      /// \brief arc between the points
+      private: SlerpArc pointArc;
+
+      /// \brief shortest arc between the points
+      private: SlerpArc shortestPointArc;
+
+      /// \brief arc between the tangents
+      private: SlerpArc tangentArc;
+    };
+
+    /// \internal
+    /// \brief Data of a RotationSpline, shared by copies of the spline
+    /// until one of them changes.
+    class RotationSplineData
     {
       /// \brief Constructor
-      public: RotationSplinePrivate();
+      /// \param[in] _resource Memory resource of the arrays.
+      public: explicit RotationSplineData(
+                  std::pmr::memory_resource *_resource);
+
+      /// \brief Copy constructor, used to copy the data shared by several
+      /// splines before one of them changes it. The arrays use the memory
+      /// resource of _other.
+      /// \param[in] _other Data to copy.
+      public: RotationSplineData(const RotationSplineData &_other);
 
       /// \brief Automatic recalculation of tangents when control points are
       /// updated
       public: bool autoCalc;
 
       /// \brief the control points
-      public: std::vector<Quaterniond> points;
+      public: std::pmr::vector<Quaterniond> points;
 
       /// \brief the tangents
-      public: std::vector<Quaterniond> tangents;
+      public: std::pmr::vector<Quaterniond> tangents;
+
+      /// \brief Rebuilds the segments if the points or tangents changed
+      /// since they were last built. Splines sharing the data rebuild them
+      /// only once.
+      public: void UpdateSegments();
+
+      /// \brief the segments between consecutive points. It is empty if
+      /// the tangents do not match the points.
+      public: std::pmr::vector<SquadSegment> segments;
+
+      /// \brief true if the segments must be rebuilt before use
+      public: std::atomic<bool> segmentsDirty{true};
+
+      /// \brief Mutex that protects the lazy segments build.
+      public: mutable std::mutex segmentsMutex;
+    };
+
+    /// \internal
+    /// \brief Private data for RotationSpline
+    class RotationSplinePrivate
+    {
+      /// \brief Constructor
+      /// \param[in] _resource Memory resource of the arrays.
+      public: explicit RotationSplinePrivate(
+                  std::pmr::memory_resource *_resource)
+        : data(std::make_shared<RotationSplineData>(_resource))
+      {
+      }
+
+      /// \brief Get the data to change it, copying it first if other
+      /// splines share it.
+      /// \return The data, only used by this spline.
+      public: RotationSplineData &Mutable();
+
+      /// \brief Data of the spline, shared by its copies until one of
+      /// them changes.
+      public: std::shared_ptr<RotationSplineData> data;
     };
     }
   }
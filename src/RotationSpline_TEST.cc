@@ -17,6 +17,13 @@
 
 #include <gtest/gtest.h>
 
+#include <memory_resource>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/Vector3.hh"
 #include "gz/math/Quaternion.hh"
@@ -24,6 +31,33 @@
 
 using namespace gz;
 
+/////////////////////////////////////////////////
+/// \brief Memory resource which counts its allocations.
+class CountingResource : public std::pmr::memory_resource
+{
+  /// \brief Number of allocations.
+  public: std::size_t allocations = 0;
+
+  private: void *do_allocate(std::size_t _bytes,
+                             std::size_t _alignment) override
+  {
+    ++this->allocations;
+    return std::pmr::new_delete_resource()->allocate(_bytes, _alignment);
+  }
+
+  private: void do_deallocate(void *_p, std::size_t _bytes,
+                              std::size_t _alignment) override
+  {
+    std::pmr::new_delete_resource()->deallocate(_p, _bytes, _alignment);
+  }
+
+  private: bool do_is_equal(
+               const std::pmr::memory_resource &_other) const noexcept override
+  {
+    return this == &_other;
+  }
+};
+
 /////////////////////////////////////////////////
 TEST(RotationSplineTest, RotationSpline)
 {
@@ -97,3 +131,174 @@ TEST(RotationSplineTest, RecalcTangents)
   EXPECT_EQ(s.Interpolate(1, 0.5),
       math::Quaterniond(0.987225, 0.077057, 0.11624, 0.077057));
 }
+
+/////////////////////////////////////////////////
+TEST(RotationSplineTest, InterpolateBatch)
+{
+  math::RotationSpline s;
+  const double t[] = {0.0, 0.5, 1.0};
+  math::Quaterniond rotations[3];
+
+  // Empty spline
+  EXPECT_FALSE(s.Interpolate(t, 3, rotations));
+  for (const auto &q : rotations)
+    EXPECT_FALSE(q.IsFinite());
+
+  // Points that need the shortest path, and almost equal points that are
+  // interpolated linearly
+  s.AddPoint(math::Quaterniond(0, 0, 0));
+  s.AddPoint(math::Quaterniond(.4, .4, .4));
+  s.AddPoint(math::Quaterniond(-.4, -.4, -.4) * -1.0);
+  s.AddPoint(math::Quaterniond(1.6, -.4, 3.0));
+  s.AddPoint(math::Quaterniond(1.6, -.4, 3.0001));
+  s.AddPoint(math::Quaterniond(-1.0, 2.0, 0.5));
+
+  std::vector<double> values;
+  for (int i = -5; i <= 205; ++i)
+    values.push_back(i / 200.0);
+
+  std::vector<math::Quaterniond> result(values.size());
+  for (bool shortestPath : {true, false})
+  {
+    EXPECT_TRUE(s.Interpolate(values.data(), values.size(), result.data(),
+                              shortestPath));
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      const math::Quaterniond expected =
+          s.Interpolate(values[i], shortestPath);
+      EXPECT_EQ(expected.IsFinite(), result[i].IsFinite()) << values[i];
+      if (expected.IsFinite())
+      {
+        EXPECT_DOUBLE_EQ(expected.W(), result[i].W()) << values[i];
+        EXPECT_DOUBLE_EQ(expected.X(), result[i].X()) << values[i];
+        EXPECT_DOUBLE_EQ(expected.Y(), result[i].Y()) << values[i];
+        EXPECT_DOUBLE_EQ(expected.Z(), result[i].Z()) << values[i];
+      }
+    }
+  }
+
+  // Points changed without recalculating the tangents are still used
+  s.AutoCalculate(false);
+  const math::Quaterniond moved(0.3, 0.2, 0.1);
+  EXPECT_TRUE(s.UpdatePoint(0, moved));
+  const double start = 1e-5;
+  EXPECT_TRUE(s.Interpolate(&start, 1, rotations));
+  EXPECT_EQ(moved, rotations[0]);
+
+  // Nothing is written for an empty batch
+  EXPECT_TRUE(s.Interpolate(nullptr, 0, nullptr));
+}
+
+/////////////////////////////////////////////////
+TEST(RotationSplineTest, MemoryResource)
+{
+  CountingResource resource;
+  math::RotationSpline s(&resource);
+  math::RotationSpline expected;
+  for (int i = 0; i < 10; ++i)
+  {
+    const math::Quaterniond q(0.1 * i, 0.2 * i, -0.3 * i);
+    s.AddPoint(q);
+    expected.AddPoint(q);
+  }
+  EXPECT_EQ(expected.Interpolate(0.25), s.Interpolate(0.25));
+  EXPECT_LT(0u, resource.allocations);
+}
+
+/////////////////////////////////////////////////
+TEST(RotationSplineTest, CopyOnWrite)
+{
+  EXPECT_TRUE(
+      std::is_nothrow_move_constructible<math::RotationSpline>::value);
+  EXPECT_TRUE(std::is_nothrow_move_assignable<math::RotationSpline>::value);
+
+  CountingResource resource;
+  math::RotationSpline s(&resource);
+  s.AddPoint(math::Quaterniond(0, 0, 0));
+  s.AddPoint(math::Quaterniond(0.5, 0, 0));
+  s.AddPoint(math::Quaterniond(0.5, 0.5, 0));
+  const math::Quaterniond q = s.Interpolate(0.5);
+
+  // Copies share the data until one of them changes
+  const std::size_t allocations = resource.allocations;
+  math::RotationSpline copy(s);
+  math::RotationSpline assigned;
+  assigned = s;
+  EXPECT_EQ(allocations, resource.allocations);
+  EXPECT_EQ(q, copy.Interpolate(0.5));
+
+  // Changing a copy leaves the others as they were
+  copy.UpdatePoint(1, math::Quaterniond(0, 0.5, 0));
+  EXPECT_LT(allocations, resource.allocations);
+  EXPECT_EQ(math::Quaterniond(0, 0.5, 0), copy.Point(1));
+  EXPECT_EQ(math::Quaterniond(0.5, 0, 0), s.Point(1));
+  EXPECT_EQ(q, s.Interpolate(0.5));
+  EXPECT_NE(q, copy.Interpolate(0.5));
+
+  s.Clear();
+  EXPECT_EQ(0u, s.PointCount());
+  EXPECT_EQ(3u, assigned.PointCount());
+  EXPECT_EQ(q, assigned.Interpolate(0.5));
+
+  // Moves keep the data, and moved from splines can be assigned to
+  math::RotationSpline moved(std::move(assigned));
+  EXPECT_EQ(q, moved.Interpolate(0.5));
+  assigned = std::move(moved);
+  EXPECT_EQ(q, assigned.Interpolate(0.5));
+  moved = copy;
+  EXPECT_EQ(copy.Point(1), moved.Point(1));
+}
+
+/////////////////////////////////////////////////
+TEST(RotationSplineTest, Finalize)
+{
+  math::RotationSpline s;
+  EXPECT_FALSE(s.Finalized());
+  for (int i = 0; i < 20; ++i)
+    s.AddPoint(math::Quaterniond(i * 0.1, i * 0.05, -i * 0.2));
+
+  // Tangents calculated automatically rebuild the segments
+  EXPECT_TRUE(s.Finalized());
+  s.UpdatePoint(2, math::Quaterniond(0, 0.5, 0));
+  EXPECT_TRUE(s.Finalized());
+
+  // Otherwise edits leave them to the next interpolation
+  s.AutoCalculate(false);
+  s.UpdatePoint(2, math::Quaterniond(0, 0.4, 0));
+  EXPECT_FALSE(s.Finalized());
+  s.Interpolate(0.5);
+  EXPECT_TRUE(s.Finalized());
+  s.RecalcTangents();
+  s.UpdatePoint(3, math::Quaterniond(0, 0.3, 0));
+  EXPECT_FALSE(s.Finalized());
+  s.Finalize();
+  EXPECT_TRUE(s.Finalized());
+
+  // Threads interpolate one finalized spline through a const reference
+  const math::RotationSpline &shared = s;
+  std::vector<double> t(100);
+  for (std::size_t i = 0; i < t.size(); ++i)
+    t[i] = i / 99.0;
+  std::vector<math::Quaterniond> expected(t.size());
+  EXPECT_TRUE(shared.Interpolate(t.data(), t.size(), expected.data()));
+  EXPECT_EQ(s.Interpolate(0.3), shared.Interpolate(0.3));
+  EXPECT_EQ(s.Interpolate(4u, 0.25), shared.Interpolate(4u, 0.25));
+
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(4, 0);
+  for (std::size_t k = 0; k < mismatches.size(); ++k)
+  {
+    threads.emplace_back([&, k]
+    {
+      for (std::size_t i = 0; i < t.size(); ++i)
+      {
+        if (shared.Interpolate(t[i]) != expected[i])
+          ++mismatches[k];
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  for (int count : mismatches)
+    EXPECT_EQ(0, count);
+}
@@ -15,8 +15,7 @@
  *
 */
 
-#include <sstream>
-
+#include "gz/math/Instrumentation.hh"
 #include "gz/math/SemanticVersion.hh"
 
 using namespace gz;
@@ -48,6 +47,23 @@ namespace ignition
       /// appending a plus sign and a series of dot separated identifiers
       /// immediately following the patch or pre-release version
       public: std::string build = "";
+
+      /// \brief Packed ordering key, see SemanticVersion::MakeKey.
+      public: std::uint64_t key = SemanticVersion::MakeKey(0, 0, 0, false);
+
+      /// \brief True if the key represents the numbers exactly, so that
+      /// comparisons can use it alone.
+      public: bool exactKey = true;
+
+      /// \brief Update the key from the other fields.
+      public: void UpdateKey()
+      {
+        this->key = SemanticVersion::MakeKey(this->maj, this->min,
+            this->patch, !this->prerelease.empty());
+        this->exactKey = this->maj < SemanticVersion::kMaxKeyNumber &&
+            this->min < SemanticVersion::kMaxKeyNumber &&
+            this->patch < SemanticVersion::kMaxKeyNumber;
+      }
     };
     }
   }
@@ -79,18 +95,21 @@ SemanticVersion::SemanticVersion(const unsigned int _major,
   this->dataPtr->patch = _patch;
   this->dataPtr->prerelease = _prerelease;
   this->dataPtr->build = _build;
+  this->dataPtr->UpdateKey();
 }
 
 /////////////////////////////////////////////////
 SemanticVersion::SemanticVersion(const SemanticVersion  &_copy)
 : dataPtr(new SemanticVersionPrivate())
 {
+  IGN_MATH_COUNT_COPY(PIMPL, sizeof(SemanticVersionPrivate));
   *this->dataPtr = *_copy.dataPtr;
 }
 
 /////////////////////////////////////////////////
 SemanticVersion& SemanticVersion::operator=(const SemanticVersion &_other)
 {
+  IGN_MATH_COUNT_COPY(PIMPL, sizeof(SemanticVersionPrivate));
   *this->dataPtr = *_other.dataPtr;
   return *this;
 }
@@ -119,48 +138,27 @@ std::string SemanticVersion::Version() const
 /////////////////////////////////////////////////
 bool SemanticVersion::operator<(const SemanticVersion &_other) const
 {
-  if (this == &_other)
-    return false;
+  if (this->dataPtr->exactKey && _other.dataPtr->exactKey)
+    return this->dataPtr->key < _other.dataPtr->key;
 
-  if (this->dataPtr->maj < _other.dataPtr->maj)
-  {
-    return true;
-  }
-  if (this->dataPtr->maj > _other.dataPtr->maj)
-  {
-    return false;
-  }
-  if (this->dataPtr->min < _other.dataPtr->min)
-  {
-    return true;
-  }
-  if (this->dataPtr->min > _other.dataPtr->min)
-  {
-    return false;
-  }
-  if (this->dataPtr->patch < _other.dataPtr->patch)
-  {
-    return true;
-  }
-  if (this->dataPtr->patch > _other.dataPtr->patch)
-  {
-    return false;
-  }
+  if (this->dataPtr->maj != _other.dataPtr->maj)
+    return this->dataPtr->maj < _other.dataPtr->maj;
+  if (this->dataPtr->min != _other.dataPtr->min)
+    return this->dataPtr->min < _other.dataPtr->min;
+  if (this->dataPtr->patch != _other.dataPtr->patch)
+    return this->dataPtr->patch < _other.dataPtr->patch;
 
   // If this version has prelrease and the _other doesn't, then this
   // version is lower. We don't compare the prerelease strings because
   // they can contain any alphanumeric values.
-  if (!this->dataPtr->prerelease.empty() && _other.dataPtr->prerelease.empty())
-    return true;
-
-  // _other is equal
-  return false;
+  return !this->dataPtr->prerelease.empty() &&
+         _other.dataPtr->prerelease.empty();
 }
 
 /////////////////////////////////////////////////
 bool SemanticVersion::operator<=(const SemanticVersion &_other) const
 {
-  return (_other > *this) || (_other == *this);
+  return (*this < _other) || (*this == _other);
 }
 
 /////////////////////////////////////////////////
@@ -178,8 +176,9 @@ bool SemanticVersion::operator>=(const SemanticVersion &_other) const
 /////////////////////////////////////////////////
 bool SemanticVersion::operator==(const SemanticVersion &_other) const
 {
-  if (this == &_other)
-    return true;
+  // Equality ignores the prerelease bit of the keys.
+  if (this->dataPtr->exactKey && _other.dataPtr->exactKey)
+    return (this->dataPtr->key >> 1) == (_other.dataPtr->key >> 1);
 
   return (_other.dataPtr->maj == this->dataPtr->maj)
     && (_other.dataPtr->min == this->dataPtr->min)
@@ -223,75 +222,27 @@ std::string SemanticVersion::Build() const
 }
 
 /////////////////////////////////////////////////
-bool SemanticVersion::Parse(const std::string &_versionStr)
+std::uint64_t SemanticVersion::Key() const
 {
-  if (_versionStr.empty())
-    return false;
-
-  size_t numericEnd = _versionStr.size();
-  size_t prereleaseStart = _versionStr.find("-");
-  size_t buildStart = _versionStr.find("+");
+  return this->dataPtr->key;
+}
 
-  // Build meta data, if present, must be after prerelease string, if
-  // present
-  if (buildStart != std::string::npos &&
-      prereleaseStart != std::string::npos &&
-      buildStart < prereleaseStart)
-  {
+/////////////////////////////////////////////////
+bool SemanticVersion::Parse(const std::string &_versionStr)
+{
+  unsigned int maj = 0;
+  unsigned int min = 0;
+  unsigned int patch = 0;
+  std::string_view prerelease;
+  std::string_view build;
+  if (!Split(_versionStr, maj, min, patch, prerelease, build))
     return false;
-  }
 
-  // Check if a prerelease version is present
-  if (prereleaseStart != std::string::npos)
-  {
-    // Set the end of the numeric (major.minor.patch) portion to the
-    // start of the prerelease
-    numericEnd = prereleaseStart;
-
-    // Check if build metadata is present
-    if (buildStart != std::string::npos)
-    {
-      // Set prerelease to the portion between "-" and "+"
-      this->dataPtr->prerelease = _versionStr.substr(numericEnd + 1,
-           buildStart - numericEnd - 1);
-
-      // Get the build metadata.
-      this->dataPtr->build = _versionStr.substr(buildStart + 1);
-    }
-    else
-    {
-      // Set prerelease to the portion between "-" and the string's end
-      this->dataPtr->prerelease = _versionStr.substr(numericEnd + 1);
-    }
-  }
-  // Check if build metadata is present
-  else if (buildStart != std::string::npos)
-  {
-    // Set the end of the numeric (major.minor.patch) portion to the
-    // start of the build metadata
-    numericEnd = buildStart;
-    // Pre-release info can't follow the build metadata.
-    this->dataPtr->build = _versionStr.substr(numericEnd + 1);
-  }
-
-  std::string numeric = _versionStr.substr(0, numericEnd);
-  std::istringstream is(numeric);
-  std::string token;
-  for (int i = 0; std::getline(is, token, '.'); ++i)
-  {
-    switch (i)
-    {
-      default:
-      case 0:
-        this->dataPtr->maj = std::stoi(token);
-        break;
-      case 1:
-        this->dataPtr->min = std::stoi(token);
-        break;
-      case 2:
-        this->dataPtr->patch = std::stoi(token);
-        break;
-    };
-  }
+  this->dataPtr->maj = maj;
+  this->dataPtr->min = min;
+  this->dataPtr->patch = patch;
+  this->dataPtr->prerelease.assign(prerelease.data(), prerelease.size());
+  this->dataPtr->build.assign(build.data(), build.size());
+  this->dataPtr->UpdateKey();
   return true;
 }
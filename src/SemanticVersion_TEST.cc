@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
 #include "gz/math/SemanticVersion.hh"
 
 using namespace gz;
@@ -194,6 +198,116 @@ TEST(SemVerTest, Parse)
   SemanticVersion a;
   EXPECT_FALSE(a.Parse(""));
   EXPECT_FALSE(a.Parse("0.1.2+1-1"));
+
+  // Invalid numbers leave the version unchanged.
+  EXPECT_TRUE(a.Parse("1.2.3-pr+b"));
+  EXPECT_FALSE(a.Parse("1.x.3"));
+  EXPECT_FALSE(a.Parse("1..3"));
+  EXPECT_FALSE(a.Parse("1.2.3.4"));
+  EXPECT_FALSE(a.Parse("1.2."));
+  EXPECT_FALSE(a.Parse("4294967296.0.0"));
+  EXPECT_EQ("1.2.3-pr+b", a.Version());
+
+  // Reparsing replaces the prerelease and build strings.
+  EXPECT_TRUE(a.Parse("2"));
+  EXPECT_EQ("2.0.0", a.Version());
+  EXPECT_TRUE(a.Parse("4294967295.1"));
+  EXPECT_EQ(4294967295u, a.Major());
+  EXPECT_EQ(1u, a.Minor());
+
+  // Surrounding whitespace and a suffix of the last number are ignored.
+  EXPECT_TRUE(a.Parse(" 1.2.3"));
+  EXPECT_EQ("1.2.3", a.Version());
+  EXPECT_TRUE(a.Parse("1.2.4 "));
+  EXPECT_EQ("1.2.4", a.Version());
+  EXPECT_TRUE(a.Parse("1.2.3beta"));
+  EXPECT_EQ("1.2.3", a.Version());
+  EXPECT_TRUE(a.Parse("\t2.1-pr\n"));
+  EXPECT_EQ("2.1.0-pr", a.Version());
+  EXPECT_FALSE(a.Parse(" "));
+  EXPECT_FALSE(a.Parse("1x.2.3"));
+  EXPECT_FALSE(a.Parse("1.2.beta"));
+}
+
+/////////////////////////////////////////////////
+TEST(SemVerTest, Split)
+{
+  unsigned int maj = 9;
+  unsigned int min = 9;
+  unsigned int pat = 9;
+  std::string_view prerelease;
+  std::string_view build;
+  EXPECT_TRUE(SemanticVersion::Split("1.22.333-pr.1+b.2", maj, min,
+      pat, prerelease, build));
+  EXPECT_EQ(1u, maj);
+  EXPECT_EQ(22u, min);
+  EXPECT_EQ(333u, pat);
+  EXPECT_EQ("pr.1", prerelease);
+  EXPECT_EQ("b.2", build);
+
+  EXPECT_TRUE(SemanticVersion::Split("4+b", maj, min, pat,
+      prerelease, build));
+  EXPECT_EQ(4u, maj);
+  EXPECT_EQ(0u, min);
+  EXPECT_EQ(0u, pat);
+  EXPECT_TRUE(prerelease.empty());
+  EXPECT_EQ("b", build);
+
+  EXPECT_FALSE(SemanticVersion::Split("", maj, min, pat,
+      prerelease, build));
+  EXPECT_FALSE(SemanticVersion::Split("1.2+b-pr", maj, min, pat,
+      prerelease, build));
+  EXPECT_TRUE(SemanticVersion::Split(" 3.4rc+b ", maj, min, pat,
+      prerelease, build));
+  EXPECT_EQ(3u, maj);
+  EXPECT_EQ(4u, min);
+  EXPECT_EQ(0u, pat);
+  EXPECT_TRUE(prerelease.empty());
+  EXPECT_EQ("b", build);
+}
+
+/////////////////////////////////////////////////
+TEST(SemVerTest, Key)
+{
+  // Keys of versions known at compile time
+  constexpr std::uint64_t key = [] {
+    std::uint64_t k = 0;
+    SemanticVersion::ParseKey("1.2.3", k);
+    return k;
+  }();
+  static_assert(key == SemanticVersion::MakeKey(1, 2, 3, false),
+                "ParseKey must be constexpr");
+  EXPECT_EQ(key, SemanticVersion("1.2.3+b").Key());
+
+  std::uint64_t prerelease = 0;
+  EXPECT_TRUE(SemanticVersion::ParseKey("1.2.3-pr", prerelease));
+  EXPECT_LT(prerelease, key);
+  EXPECT_FALSE(SemanticVersion::ParseKey("1.2.a", prerelease));
+
+  // Keys order versions as operator< does
+  const std::vector<SemanticVersion> versions{
+      SemanticVersion("0.0.1"), SemanticVersion("0.1.0-pr"),
+      SemanticVersion("0.1.0"), SemanticVersion("0.1.1"),
+      SemanticVersion("1.0.0-alpha"), SemanticVersion("1.0.0+b"),
+      SemanticVersion(1, 10, 0), SemanticVersion(2, 0, 0, "rc1"),
+      SemanticVersion(2097150, 0, 0)};
+  for (const auto &a : versions)
+  {
+    for (const auto &b : versions)
+    {
+      EXPECT_EQ(a < b, a.Key() < b.Key()) << a << " " << b;
+      EXPECT_EQ(a == b, (a.Key() >> 1) == (b.Key() >> 1)) << a << " " << b;
+    }
+  }
+
+  // Numbers too large for the key saturate, and comparisons fall back on
+  // the numbers.
+  const SemanticVersion big(3000000, 1, 0);
+  const SemanticVersion bigger(4000000, 0, 0);
+  EXPECT_EQ(big.Key(), bigger.Key() + (1ull << 22));
+  EXPECT_TRUE(big < bigger);
+  EXPECT_FALSE(big == bigger);
+  EXPECT_TRUE(SemanticVersion(2097150, 0, 0) < big);
 }
 
 /////////////////////////////////////////////////
@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "gz/math/Helpers.hh"
+#include "gz/math/OrientedBox.hh"
+#include "gz/math/ShapeDistance.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Check that a result is consistent with its signed distance.
+/// \param[in] _result Result of a query.
+static void ExpectConsistent(const ShapeDistanceResult<double> &_result)
+{
+  EXPECT_NEAR(1.0, _result.normal.Length(), 1e-6);
+  const Vector3d offset = _result.pointB - _result.pointA;
+  EXPECT_NEAR(_result.distance, offset.Dot(_result.normal), 1e-6);
+  EXPECT_NEAR(std::abs(_result.distance), offset.Length(), 1e-6);
+}
+
+/////////////////////////////////////////////////
+TEST(ShapeDistanceTest, Spheres)
+{
+  const Sphered a(1.0);
+  const Sphered b(0.5);
+  ShapeDistanceResult<double> result;
+
+  EXPECT_TRUE(ShapeDistance(a, Pose3d(1, 2, 3, 0, 0, 0), b,
+                            Pose3d(1, 5, 3, 0.1, 0.2, 0.3), result));
+  EXPECT_DOUBLE_EQ(1.5, result.distance);
+  EXPECT_EQ(Vector3d(1, 3, 3), result.pointA);
+  EXPECT_EQ(Vector3d(1, 4.5, 3), result.pointB);
+  EXPECT_EQ(Vector3d::UnitY, result.normal);
+
+  // Overlapping spheres only report the depth with ShapePenetration.
+  EXPECT_FALSE(ShapeDistance(a, Pose3d::Zero, b, Pose3d(1, 0, 0, 0, 0, 0),
+                             result));
+  EXPECT_DOUBLE_EQ(0.0, result.distance);
+  EXPECT_TRUE(ShapePenetration(a, Pose3d::Zero, b,
+                               Pose3d(1, 0, 0, 0, 0, 0), result));
+  EXPECT_DOUBLE_EQ(-0.5, result.distance);
+  EXPECT_EQ(Vector3d::UnitX, result.normal);
+  EXPECT_EQ(Vector3d(1, 0, 0), result.pointA);
+  EXPECT_EQ(Vector3d(0.5, 0, 0), result.pointB);
+  ExpectConsistent(result);
+
+  // Concentric spheres go through EPA.
+  EXPECT_TRUE(ShapePenetration(a, Pose3d::Zero, b, Pose3d::Zero, result));
+  EXPECT_NEAR(-1.5, result.distance, 1e-6);
+  ExpectConsistent(result);
+
+  // Separated shapes are reported by ShapePenetration too.
+  EXPECT_FALSE(ShapePenetration(a, Pose3d::Zero, b,
+                                Pose3d(0, 0, -2, 0, 0, 0), result));
+  EXPECT_DOUBLE_EQ(0.5, result.distance);
+  EXPECT_EQ(-Vector3d::UnitZ, result.normal);
+}
+
+/////////////////////////////////////////////////
+TEST(ShapeDistanceTest, Boxes)
+{
+  const Boxd a(2, 2, 2);
+  const Boxd b(1, 1, 1);
+  ShapeDistanceResult<double> result;
+
+  // Face to face.
+  EXPECT_TRUE(ShapeDistance(a, Pose3d::Zero, b, Pose3d(3, 0.2, 0, 0, 0, 0),
+                            result));
+  EXPECT_NEAR(1.5, result.distance, 1e-9);
+  EXPECT_NEAR(1.0, result.pointA.X(), 1e-9);
+  EXPECT_NEAR(2.5, result.pointB.X(), 1e-9);
+  ExpectConsistent(result);
+
+  // Corner of a rotated box to a face.
+  EXPECT_TRUE(ShapeDistance(a, Pose3d(0, 0, 0, 0, 0, IGN_PI / 4), b,
+                            Pose3d(3, 0, 0, 0, 0, 0), result));
+  EXPECT_NEAR(2.5 - std::sqrt(2.0), result.distance, 1e-9);
+  EXPECT_NEAR(std::sqrt(2.0), result.pointA.X(), 1e-9);
+  EXPECT_NEAR(0.0, result.pointA.Y(), 1e-9);
+  ExpectConsistent(result);
+
+  // Overlap along the axis of least penetration.
+  EXPECT_FALSE(ShapeDistance(a, Pose3d::Zero, b, Pose3d(1.2, 0.1, 0, 0, 0, 0),
+                             result));
+  EXPECT_TRUE(ShapePenetration(a, Pose3d::Zero, b,
+                               Pose3d(1.2, 0.1, 0, 0, 0, 0), result));
+  EXPECT_NEAR(-0.3, result.distance, 1e-9);
+  EXPECT_NEAR(1.0, result.normal.X(), 1e-9);
+  ExpectConsistent(result);
+
+  // Swapping the shapes flips the normal.
+  EXPECT_TRUE(ShapePenetration(b, Pose3d(1.2, 0.1, 0, 0, 0, 0), a,
+                               Pose3d::Zero, result));
+  EXPECT_NEAR(-0.3, result.distance, 1e-9);
+  EXPECT_NEAR(-1.0, result.normal.X(), 1e-9);
+
+  // Boxes touching on a face.
+  EXPECT_TRUE(ShapePenetration(a, Pose3d::Zero, b,
+                               Pose3d(1.5, 0, 0, 0, 0, 0), result));
+  EXPECT_NEAR(0.0, result.distance, 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(ShapeDistanceTest, Capsules)
+{
+  const Capsuled a(2.0, 0.5);
+  const Capsuled b(4.0, 0.25);
+  ShapeDistanceResult<double> result;
+
+  // Crossing axes, 2 apart.
+  EXPECT_TRUE(ShapeDistance(a, Pose3d::Zero, b,
+                            Pose3d(2, 0, 0.5, IGN_PI / 2, 0, 0), result));
+  EXPECT_NEAR(1.25, result.distance, 1e-12);
+  EXPECT_EQ(Vector3d::UnitX, result.normal);
+  EXPECT_NEAR(0.5, result.pointA.X(), 1e-12);
+  EXPECT_NEAR(0.5, result.pointA.Z(), 1e-12);
+
+  // Capsule end to a box face.
+  const Boxd box(1, 1, 1);
+  EXPECT_TRUE(ShapeDistance(a, Pose3d::Zero, box, Pose3d(0, 0, 3, 0, 0, 0),
+                            result));
+  EXPECT_NEAR(0.0, result.distance - 1.0, 1e-12);
+  EXPECT_EQ(Vector3d(0, 0, 1.5), result.pointA);
+
+  // Crossing axes, where the depth is the sum of the radii.
+  EXPECT_TRUE(ShapePenetration(a, Pose3d::Zero, b,
+                               Pose3d(0.1, 0, 0, 0, IGN_PI / 2, 0), result));
+  EXPECT_NEAR(-0.75, result.distance, 1e-12);
+  EXPECT_NEAR(1.0, std::abs(result.normal.Y()), 1e-12);
+  ExpectConsistent(result);
+
+  // Parallel axes.
+  EXPECT_TRUE(ShapePenetration(a, Pose3d::Zero, b,
+                               Pose3d(0.5, 0, 0.5, 0, 0, 0), result));
+  EXPECT_NEAR(-0.25, result.distance, 1e-12);
+  EXPECT_EQ(Vector3d::UnitX, result.normal);
+  ExpectConsistent(result);
+}
+
+/////////////////////////////////////////////////
+TEST(ShapeDistanceTest, CurvedShapes)
+{
+  const Cylinderd cylinder(2.0, 1.0);
+  const Ellipsoidd ellipsoid(Vector3d(3, 1, 0.5));
+  const Sphered sphere(1.0);
+  const Boxd box(1, 1, 1);
+  ShapeDistanceResult<double> result;
+
+  // Side of a cylinder.
+  EXPECT_TRUE(ShapeDistance(cylinder, Pose3d::Zero, box,
+                            Pose3d(0, 2, 0.3, 0, 0, 0), result));
+  EXPECT_NEAR(0.5, result.distance, 1e-6);
+  ExpectConsistent(result);
+
+  // The rotational offset turns the axis of the cylinder.
+  const Cylinderd lying(2.0, 1.0, Quaterniond(0, IGN_PI / 2, 0));
+  EXPECT_TRUE(ShapeDistance(lying, Pose3d::Zero, box,
+                            Pose3d(2, 0, 0, 0, 0, 0), result));
+  EXPECT_NEAR(0.5, result.distance, 1e-6);
+  EXPECT_TRUE(ShapeDistance(lying, Pose3d::Zero, box,
+                            Pose3d(0, 0, 2, 0, 0, 0), result));
+  EXPECT_NEAR(0.5, result.distance, 1e-6);
+  EXPECT_TRUE(ShapeDistance(lying, Pose3d::Zero, box,
+                            Pose3d(0, 2.5, 0, 0, 0, 0), result));
+  EXPECT_NEAR(1.0, result.distance, 1e-6);
+
+  // Rim of a cylinder.
+  EXPECT_TRUE(ShapeDistance(cylinder, Pose3d::Zero, sphere,
+                            Pose3d(3, 0, 3, 0, 0, 0), result));
+  EXPECT_NEAR(2.0 * std::sqrt(2.0) - 1.0, result.distance, 1e-6);
+  EXPECT_NEAR(1.0, result.pointA.X(), 1e-6);
+  EXPECT_NEAR(1.0, result.pointA.Z(), 1e-6);
+
+  // Ellipsoid along each axis.
+  EXPECT_TRUE(ShapeDistance(ellipsoid, Pose3d::Zero, sphere,
+                            Pose3d(5, 0, 0, 0, 0, 0), result));
+  EXPECT_NEAR(1.0, result.distance, 1e-6);
+  EXPECT_TRUE(ShapeDistance(ellipsoid, Pose3d::Zero, sphere,
+                            Pose3d(0, -3, 0, 0, 0, 0), result));
+  EXPECT_NEAR(1.0, result.distance, 1e-6);
+  EXPECT_TRUE(ShapeDistance(ellipsoid, Pose3d(0, 0, 0, 0, 0, IGN_PI / 2),
+                            sphere, Pose3d(0, 5, 0, 0, 0, 0), result));
+  EXPECT_NEAR(1.0, result.distance, 1e-6);
+  ExpectConsistent(result);
+
+  // Penetration of curved shapes.
+  EXPECT_TRUE(ShapePenetration(ellipsoid, Pose3d::Zero, cylinder,
+                               Pose3d(0, 0, 1.3, 0, 0, 0), result));
+  EXPECT_NEAR(-0.2, result.distance, 1e-3);
+  EXPECT_NEAR(1.0, result.normal.Z(), 1e-3);
+  ExpectConsistent(result);
+
+  // Results don't depend on the order of the shapes.
+  ShapeDistanceResult<double> swapped;
+  const Pose3d poseA(0.3, -0.2, 0.1, 0.4, 0.5, 0.6);
+  const Pose3d poseB(4.5, 2.5, -1.0, -0.3, 0.2, 0.1);
+  EXPECT_TRUE(ShapeDistance(ellipsoid, poseA, cylinder, poseB, result));
+  EXPECT_TRUE(ShapeDistance(cylinder, poseB, ellipsoid, poseA, swapped));
+  EXPECT_NEAR(result.distance, swapped.distance, 1e-6);
+  EXPECT_NEAR(0.0, (result.normal + swapped.normal).Length(), 1e-3);
+  ExpectConsistent(result);
+}
+
+/////////////////////////////////////////////////
+TEST(ShapeDistanceTest, RandomBoxes)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> size(0.2, 2.0);
+  std::uniform_real_distribution<double> position(-2.0, 2.0);
+  std::uniform_real_distribution<double> angle(-IGN_PI, IGN_PI);
+  auto randomPose = [&]()
+  {
+    return Pose3d(position(generator), position(generator),
+                  position(generator), angle(generator), angle(generator),
+                  angle(generator));
+  };
+
+  int overlaps = 0;
+  for (int i = 0; i < 500; ++i)
+  {
+    const Vector3d sizeA(size(generator), size(generator), size(generator));
+    const Vector3d sizeB(size(generator), size(generator), size(generator));
+    const Pose3d poseA = randomPose();
+    const Pose3d poseB = randomPose();
+
+    // GJK agrees with the separating axis test.
+    ShapeDistanceResult<double> result;
+    const bool overlap = ShapePenetration(Boxd(sizeA), poseA, Boxd(sizeB),
+                                          poseB, result);
+    EXPECT_EQ(OrientedBoxd(sizeA, poseA).Intersects(
+        OrientedBoxd(sizeB, poseB)), overlap);
+    ExpectConsistent(result);
+    if (!overlap)
+      continue;
+    ++overlaps;
+
+    // Moving the second box out of the first one by the penetration
+    // depth along the normal separates them.
+    const Vector3d out = result.normal * -result.distance;
+    ShapeDistanceResult<double> moved;
+    const Pose3d poseOut(poseB.Pos() + out * 1.001, poseB.Rot());
+    EXPECT_TRUE(ShapeDistance(Boxd(sizeA), poseA, Boxd(sizeB), poseOut,
+                              moved));
+    EXPECT_LT(moved.distance, 1e-2);
+  }
+  EXPECT_GT(overlaps, 50);
+}
+
+/////////////////////////////////////////////////
+TEST(ShapeDistanceTest, WarmStart)
+{
+  const Boxd box(1, 2, 3);
+  const Cylinderd cylinder(1.0, 0.5);
+  ShapeDistanceCache<double> cache;
+  EXPECT_EQ(0u, cache.Size());
+
+  // Move the cylinder around the box, with and without the cache.
+  unsigned int cold = 0;
+  unsigned int warm = 0;
+  for (int i = 0; i < 200; ++i)
+  {
+    const double angle = i * 0.01;
+    const Pose3d pose(3 * std::cos(angle), 3 * std::sin(angle), 0.5,
+                      0, 0.2, angle);
+    ShapeDistanceResult<double> coldResult;
+    ShapeDistanceResult<double> warmResult;
+    const bool coldSeparated = ShapeDistance(box, Pose3d::Zero, cylinder,
+                                             pose, coldResult);
+    const bool warmSeparated = ShapeDistance(box, Pose3d::Zero, cylinder,
+                                             pose, warmResult, &cache);
+    ASSERT_TRUE(coldSeparated);
+    ASSERT_TRUE(warmSeparated);
+    EXPECT_NEAR(coldResult.distance, warmResult.distance, 1e-6);
+    EXPECT_GT(cache.Size(), 0u);
+    cold += coldResult.iterations;
+    warm += warmResult.iterations;
+  }
+  EXPECT_LT(warm, cold);
+
+  // A cache from an overlapping pair still finds the distance.
+  ShapeDistanceResult<double> result;
+  EXPECT_TRUE(ShapePenetration(box, Pose3d::Zero, cylinder,
+                               Pose3d(0.5, 0, 0, 0, 0, 0), result, &cache));
+  EXPECT_NEAR(-0.5, result.distance, 1e-6);
+  EXPECT_TRUE(ShapeDistance(box, Pose3d::Zero, cylinder,
+                            Pose3d(0, 0, 3, 0, 0, 0), result, &cache));
+  EXPECT_NEAR(1.0, result.distance, 1e-6);
+
+  cache.Reset();
+  EXPECT_EQ(0u, cache.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(ShapeDistanceTest, Float)
+{
+  const Boxf box(1, 1, 1);
+  const Spheref sphere(0.5f);
+  ShapeDistanceResult<float> result;
+  EXPECT_TRUE(ShapeDistance(box, Pose3f::Zero, sphere,
+                            Pose3f(2, 0, 0, 0, 0, 0), result));
+  EXPECT_NEAR(1.0f, result.distance, 1e-5f);
+  EXPECT_TRUE(ShapePenetration(box, Pose3f::Zero, sphere,
+                               Pose3f(0.8f, 0, 0, 0, 0, 0), result));
+  EXPECT_NEAR(-0.2f, result.distance, 1e-4f);
+}
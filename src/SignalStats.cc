@@ -14,14 +14,222 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cctype>
 #include <cmath>
-#include <iostream>
+#include <cstdlib>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gz/math/Diagnostics.hh>
 #include <gz/math/SignalStats.hh>
 #include "SignalStatsPrivate.hh"
 
 using namespace gz;
 using namespace math;
 
+namespace
+{
+  /// \brief Add a sample to a monotonic queue, and drop the samples that
+  /// have left the window.
+  /// \param[in,out] _queue Queue of candidate values, ordered by _before.
+  /// \param[in] _index Index of the sample in the signal.
+  /// \param[in] _value Value of the sample.
+  /// \param[in] _oldest Index of the oldest sample in the window.
+  /// \param[in] _before Strict ordering of the values, true if the first
+  /// value should be in front of the second one.
+  template <typename Compare>
+  void PushMonotonic(SignalMonotonicQueue &_queue, const uint64_t _index,
+                     const double _value, const uint64_t _oldest,
+                     Compare _before)
+  {
+    // Older samples that do not come before the new one can never be the
+    // front of the queue again.
+    while (!_queue.Empty() && !_before(_queue.Back().value, _value))
+      _queue.PopBack();
+    if (!_queue.Empty() && _queue.Front().index < _oldest)
+      _queue.PopFront();
+    _queue.PushBack({_index, _value});
+  }
+
+  /// \brief Recompute the sums of a full window from its samples.
+  /// \param[in,out] _d Window data.
+  void RecomputeSums(SignalWindowAccumulatorPrivate &_d)
+  {
+    _d.sum = 0.0;
+    _d.sumSq = 0.0;
+    for (const double sample : _d.samples)
+    {
+      _d.sum += sample;
+      _d.sumSq += sample * sample;
+    }
+    _d.mean = _d.sum / _d.count;
+    _d.m2 = 0.0;
+    for (const double sample : _d.samples)
+      _d.m2 += (sample - _d.mean) * (sample - _d.mean);
+  }
+
+  /// \brief Merge the running mean and sum of squared differences of two
+  /// sets of data, with the parallel algorithm of Chan et al.
+  /// \param[in] _count Number of data points of the first set.
+  /// \param[in,out] _mean Mean of the first set, then of both sets.
+  /// \param[in,out] _m2 Sum of squared differences to the mean of the
+  /// first set, then of both sets.
+  /// \param[in] _otherCount Number of data points of the second set.
+  /// \param[in] _otherMean Mean of the second set.
+  /// \param[in] _otherM2 Sum of squared differences of the second set.
+  void MergeVariance(const size_t _count, double &_mean, double &_m2,
+                     const size_t _otherCount, const double _otherMean,
+                     const double _otherM2)
+  {
+    if (_otherCount == 0)
+      return;
+    const double count = static_cast<double>(_count);
+    const double otherCount = static_cast<double>(_otherCount);
+    const double total = count + otherCount;
+    const double delta = _otherMean - _mean;
+    _mean += delta * otherCount / total;
+    _m2 += _otherM2 + delta * delta * count * otherCount / total;
+  }
+
+  /// \brief Scale function of the t-digest, which maps a quantile to a
+  /// centroid index. Centroids can span at most one unit of it.
+  /// \param[in] _q Quantile between 0 and 1.
+  /// \param[in] _compression Compression of the digest.
+  /// \return Scaled index.
+  double DigestScale(const double _q, const double _compression)
+  {
+    return _compression / (2 * IGN_PI) * std::asin(2 * _q - 1);
+  }
+
+  /// \brief Inverse of DigestScale.
+  /// \param[in] _k Scaled index.
+  /// \param[in] _compression Compression of the digest.
+  /// \return Quantile between 0 and 1.
+  double DigestScaleInverse(const double _k, const double _compression)
+  {
+    const double angle = std::min(_k * 2 * IGN_PI / _compression, IGN_PI / 2);
+    return (std::sin(angle) + 1) / 2;
+  }
+
+  /// \brief Merge the buffer of a digest into its centroids.
+  /// \param[in,out] _d Digest.
+  void CompressDigest(SignalQuantilePrivate &_d)
+  {
+    if (_d.buffer.empty())
+      return;
+
+    // The centroids are already sorted, so only the buffer is sorted
+    // before merging both.
+    using Centroid = SignalQuantilePrivate::Centroid;
+    auto byMean = [](const Centroid &_a, const Centroid &_b)
+    {
+      return _a.mean < _b.mean;
+    };
+    std::sort(_d.buffer.begin(), _d.buffer.end(), byMean);
+    auto &all = _d.scratch;
+    all.resize(_d.centroids.size() + _d.buffer.size());
+    std::merge(_d.centroids.begin(), _d.centroids.end(),
+               _d.buffer.begin(), _d.buffer.end(), all.begin(), byMean);
+    _d.buffer.clear();
+
+    // Merge neighbours as long as the merged centroid spans at most one
+    // unit of the scale function.
+    _d.centroids.clear();
+    Centroid current = all.front();
+    double before = 0;
+    double limit = _d.total * DigestScaleInverse(
+        DigestScale(0, _d.compression) + 1, _d.compression);
+    for (size_t i = 1; i < all.size(); ++i)
+    {
+      const Centroid &next = all[i];
+      if (before + current.weight + next.weight <= limit)
+      {
+        current.weight += next.weight;
+        current.mean += (next.mean - current.mean) * next.weight /
+          current.weight;
+      }
+      else
+      {
+        before += current.weight;
+        _d.centroids.push_back(current);
+        limit = _d.total * DigestScaleInverse(
+            DigestScale(before / _d.total, _d.compression) + 1,
+            _d.compression);
+        current = next;
+      }
+    }
+    _d.centroids.push_back(current);
+  }
+
+  /// \brief Parse the name of a percentile statistic, such as "p99".
+  /// \param[in] _name Name of the statistic.
+  /// \param[out] _quantile Quantile between 0 and 1.
+  /// \return True if the name is "p" followed by a number between 0 and
+  /// 100.
+  bool ParsePercentile(const std::string &_name, double &_quantile)
+  {
+    if (_name.size() < 2 || _name[0] != 'p' ||
+        _name.find_first_not_of("0123456789.", 1) != std::string::npos ||
+        !std::isdigit(static_cast<unsigned char>(_name[1])))
+    {
+      return false;
+    }
+    char *end = nullptr;
+    const double percent = std::strtod(_name.c_str() + 1, &end);
+    if (end != _name.c_str() + _name.size() || percent > 100)
+      return false;
+    _quantile = percent / 100;
+    return true;
+  }
+
+  /// \brief Merge a statistic into another one if both are of type T.
+  /// \param[in,out] _to Statistic to merge into.
+  /// \param[in] _from Statistic to merge.
+  /// \return True if both statistics are of type T.
+  template <typename T>
+  bool MergeAs(SignalStatistic &_to, const SignalStatistic &_from)
+  {
+    T *to = dynamic_cast<T *>(&_to);
+    const T *from = dynamic_cast<const T *>(&_from);
+    if (!to || !from)
+      return false;
+    to->Merge(*from);
+    return true;
+  }
+
+  /// \brief Merge a statistic into another one of the same type.
+  /// \param[in,out] _to Statistic to merge into.
+  /// \param[in] _from Statistic to merge.
+  void MergeStatistic(SignalStatistic &_to, const SignalStatistic &_from)
+  {
+    MergeAs<SignalMaximum>(_to, _from) ||
+      MergeAs<SignalMaxAbsoluteValue>(_to, _from) ||
+      MergeAs<SignalMean>(_to, _from) ||
+      MergeAs<SignalMinimum>(_to, _from) ||
+      MergeAs<SignalRootMeanSquare>(_to, _from) ||
+      MergeAs<SignalVariance>(_to, _from) ||
+      MergeAs<SignalQuantile>(_to, _from);
+  }
+
+  /// \brief Build the map of statistics shared by the accumulators.
+  /// \param[in] _acc Accumulator.
+  /// \return Map with the short name of each statistic as key.
+  template <typename Accumulator>
+  std::map<std::string, double> StatisticsMap(const Accumulator &_acc)
+  {
+    return {
+      {"max", _acc.Max()},
+      {"maxAbs", _acc.MaxAbs()},
+      {"mean", _acc.Mean()},
+      {"min", _acc.Min()},
+      {"rms", _acc.Rms()},
+      {"var", _acc.Variance()}};
+  }
+}
+
 //////////////////////////////////////////////////
 SignalStatistic::SignalStatistic()
   : dataPtr(new SignalStatisticPrivate)
@@ -77,6 +285,16 @@ void SignalMaximum::InsertData(const double _data)
   this->dataPtr->count++;
 }
 
+//////////////////////////////////////////////////
+void SignalMaximum::Merge(const SignalMaximum &_max)
+{
+  if (_max.dataPtr->count == 0)
+    return;
+  if (this->dataPtr->count == 0 || _max.dataPtr->data > this->dataPtr->data)
+    this->dataPtr->data = _max.dataPtr->data;
+  this->dataPtr->count += _max.dataPtr->count;
+}
+
 //////////////////////////////////////////////////
 double SignalMean::Value() const
 {
@@ -100,6 +318,13 @@ void SignalMean::InsertData(const double _data)
   this->dataPtr->count++;
 }
 
+//////////////////////////////////////////////////
+void SignalMean::Merge(const SignalMean &_mean)
+{
+  this->dataPtr->data += _mean.dataPtr->data;
+  this->dataPtr->count += _mean.dataPtr->count;
+}
+
 //////////////////////////////////////////////////
 double SignalMinimum::Value() const
 {
@@ -122,6 +347,16 @@ void SignalMinimum::InsertData(const double _data)
   this->dataPtr->count++;
 }
 
+//////////////////////////////////////////////////
+void SignalMinimum::Merge(const SignalMinimum &_min)
+{
+  if (_min.dataPtr->count == 0)
+    return;
+  if (this->dataPtr->count == 0 || _min.dataPtr->data < this->dataPtr->data)
+    this->dataPtr->data = _min.dataPtr->data;
+  this->dataPtr->count += _min.dataPtr->count;
+}
+
 //////////////////////////////////////////////////
 double SignalRootMeanSquare::Value() const
 {
@@ -145,6 +380,13 @@ void SignalRootMeanSquare::InsertData(const double _data)
   this->dataPtr->count++;
 }
 
+//////////////////////////////////////////////////
+void SignalRootMeanSquare::Merge(const SignalRootMeanSquare &_rms)
+{
+  this->dataPtr->data += _rms.dataPtr->data;
+  this->dataPtr->count += _rms.dataPtr->count;
+}
+
 //////////////////////////////////////////////////
 double SignalMaxAbsoluteValue::Value() const
 {
@@ -168,6 +410,14 @@ void SignalMaxAbsoluteValue::InsertData(const double _data)
   this->dataPtr->count++;
 }
 
+//////////////////////////////////////////////////
+void SignalMaxAbsoluteValue::Merge(const SignalMaxAbsoluteValue &_maxAbs)
+{
+  if (_maxAbs.dataPtr->data > this->dataPtr->data)
+    this->dataPtr->data = _maxAbs.dataPtr->data;
+  this->dataPtr->count += _maxAbs.dataPtr->count;
+}
+
 //////////////////////////////////////////////////
 // wikipedia.org/wiki/Algorithms_for_calculating_variance#Online_algorithm
 // based on Knuth's algorithm
@@ -204,12 +454,166 @@ void SignalVariance::InsertData(const double _data)
   this->dataPtr->data += delta * (_data - this->dataPtr->extraData);
 }
 
+//////////////////////////////////////////////////
+void SignalVariance::Merge(const SignalVariance &_var)
+{
+  // data holds the sum of squared differences and extraData the mean
+  MergeVariance(this->dataPtr->count, this->dataPtr->extraData,
+                this->dataPtr->data, _var.dataPtr->count,
+                _var.dataPtr->extraData, _var.dataPtr->data);
+  this->dataPtr->count += _var.dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+SignalQuantile::SignalQuantile(const double _quantile,
+    const double _compression)
+  : SignalQuantile(_quantile, _compression, std::pmr::get_default_resource())
+{
+}
+
+//////////////////////////////////////////////////
+SignalQuantile::SignalQuantile(const double _quantile,
+    const double _compression, std::pmr::memory_resource *_resource)
+  : quantilePtr(new SignalQuantilePrivate(_resource))
+{
+  this->quantilePtr->quantile = clamp(_quantile, 0.0, 1.0);
+  this->quantilePtr->compression = std::max(10.0, _compression);
+  this->quantilePtr->bufferCapacity =
+    static_cast<size_t>(5 * this->quantilePtr->compression);
+  this->quantilePtr->buffer.reserve(this->quantilePtr->bufferCapacity);
+}
+
+//////////////////////////////////////////////////
+SignalQuantile::SignalQuantile(const SignalQuantile &_sq)
+  : SignalStatistic(_sq),
+    quantilePtr(new SignalQuantilePrivate(*_sq.quantilePtr))
+{
+}
+
+//////////////////////////////////////////////////
+SignalQuantile::~SignalQuantile()
+{
+}
+
+//////////////////////////////////////////////////
+double SignalQuantile::Quantile() const
+{
+  return this->quantilePtr->quantile;
+}
+
+//////////////////////////////////////////////////
+double SignalQuantile::Compression() const
+{
+  return this->quantilePtr->compression;
+}
+
+//////////////////////////////////////////////////
+double SignalQuantile::Value() const
+{
+  return this->Value(this->quantilePtr->quantile);
+}
+
+//////////////////////////////////////////////////
+double SignalQuantile::Value(const double _quantile) const
+{
+  SignalQuantilePrivate &d = *this->quantilePtr;
+  if (this->dataPtr->count == 0)
+    return 0.0;
+  CompressDigest(d);
+
+  // Each centroid sits at the middle of its weight. Interpolate linearly
+  // between the centroids, and between the extreme centroids and the
+  // smallest and largest samples.
+  const double index = clamp(_quantile, 0.0, 1.0) * d.total;
+  double before = 0;
+  double previousCenter = 0;
+  double previousMean = d.min;
+  for (const auto &centroid : d.centroids)
+  {
+    const double center = before + centroid.weight / 2;
+    if (index < center)
+    {
+      return previousMean + (index - previousCenter) /
+        (center - previousCenter) * (centroid.mean - previousMean);
+    }
+    previousCenter = center;
+    previousMean = centroid.mean;
+    before += centroid.weight;
+  }
+  return previousMean + (index - previousCenter) /
+    (d.total - previousCenter) * (d.max - previousMean);
+}
+
+//////////////////////////////////////////////////
+std::string SignalQuantile::ShortName() const
+{
+  std::ostringstream name;
+  name << "p" << this->quantilePtr->quantile * 100;
+  return name.str();
+}
+
+//////////////////////////////////////////////////
+void SignalQuantile::InsertData(const double _data)
+{
+  SignalQuantilePrivate &d = *this->quantilePtr;
+  if (this->dataPtr->count == 0 || _data < d.min)
+    d.min = _data;
+  if (this->dataPtr->count == 0 || _data > d.max)
+    d.max = _data;
+  this->dataPtr->count++;
+  d.total += 1;
+  d.buffer.push_back({_data, 1});
+  if (d.buffer.size() >= d.bufferCapacity)
+    CompressDigest(d);
+}
+
+//////////////////////////////////////////////////
+void SignalQuantile::Reset()
+{
+  SignalStatistic::Reset();
+  this->quantilePtr->centroids.clear();
+  this->quantilePtr->buffer.clear();
+  this->quantilePtr->total = 0.0;
+}
+
+//////////////////////////////////////////////////
+void SignalQuantile::Merge(const SignalQuantile &_sq)
+{
+  const SignalQuantilePrivate &other = *_sq.quantilePtr;
+  if (_sq.dataPtr->count == 0)
+    return;
+
+  SignalQuantilePrivate &d = *this->quantilePtr;
+  if (this->dataPtr->count == 0 || other.min < d.min)
+    d.min = other.min;
+  if (this->dataPtr->count == 0 || other.max > d.max)
+    d.max = other.max;
+  this->dataPtr->count += _sq.dataPtr->count;
+  d.total += other.total;
+
+  // Copy before inserting, in case the other digest is this one
+  const std::pmr::vector<SignalQuantilePrivate::Centroid> centroids(
+    other.centroids, d.scratch.get_allocator());
+  const std::pmr::vector<SignalQuantilePrivate::Centroid> buffer(
+    other.buffer, d.scratch.get_allocator());
+  d.buffer.insert(d.buffer.end(), centroids.begin(), centroids.end());
+  d.buffer.insert(d.buffer.end(), buffer.begin(), buffer.end());
+  CompressDigest(d);
+}
+
 //////////////////////////////////////////////////
 SignalStats::SignalStats()
   : dataPtr(new SignalStatsPrivate)
 {
 }
 
+//////////////////////////////////////////////////
+SignalStats::SignalStats(std::pmr::memory_resource *_resource)
+  : dataPtr(new SignalStatsPrivate)
+{
+  this->dataPtr->resource = _resource;
+}
+
 //////////////////////////////////////////////////
 SignalStats::~SignalStats()
 {
@@ -258,15 +662,15 @@ bool SignalStats::InsertStatistic(const std::string &_name)
     auto map = this->Map();
     if (map.find(_name) != map.end())
     {
-      std::cerr << "Unable to InsertStatistic ["
-                << _name
-                << "] since it has already been inserted."
-                << std::endl;
+      IGN_MATH_DIAGNOSTIC("Unable to InsertStatistic ["
+          << _name
+          << "] since it has already been inserted.");
       return false;
     }
   }
 
   SignalStatisticPtr stat;
+  double quantile = 0;
   if (_name == "max")
   {
     stat.reset(new SignalMaximum());
@@ -291,13 +695,27 @@ bool SignalStats::InsertStatistic(const std::string &_name)
   {
     stat.reset(new SignalVariance());
   }
+  else if (ParsePercentile(_name, quantile))
+  {
+    stat.reset(new SignalQuantile(quantile, 100, this->dataPtr->resource));
+
+    // Different spellings of the same percentile, such as "p99" and
+    // "p99.0", are the same statistic
+    auto map = this->Map();
+    if (map.find(stat->ShortName()) != map.end())
+    {
+      IGN_MATH_DIAGNOSTIC("Unable to InsertStatistic ["
+          << _name
+          << "] since it has already been inserted.");
+      return false;
+    }
+  }
   else
   {
     // Unrecognized name string
-    std::cerr << "Unable to InsertStatistic ["
-              << _name
-              << "] since it is an unrecognized name."
-              << std::endl;
+    IGN_MATH_DIAGNOSTIC("Unable to InsertStatistic ["
+        << _name
+        << "] since it is an unrecognized name.");
     return false;
   }
   this->dataPtr->stats.push_back(stat);
@@ -309,9 +727,8 @@ bool SignalStats::InsertStatistics(const std::string &_names)
 {
   if (_names.empty())
   {
-    std::cerr << "Unable to InsertStatistics "
-              << "since no names were supplied."
-              << std::endl;
+    IGN_MATH_DIAGNOSTIC("Unable to InsertStatistics "
+        << "since no names were supplied.");
     return false;
   }
 
@@ -342,6 +759,42 @@ bool SignalStats::InsertStatistics(const std::string &_names)
   return result;
 }
 
+//////////////////////////////////////////////////
+bool SignalStats::Merge(const SignalStats &_stats)
+{
+  const SignalStatistic_V &stats = this->dataPtr->stats;
+  const SignalStatistic_V &others = _stats.dataPtr->stats;
+
+  // Pair each statistic with the statistic of the same name, and check
+  // that all of them are paired before changing any.
+  std::vector<std::pair<SignalStatistic *, const SignalStatistic *>> pairs;
+  if (stats.size() == others.size())
+  {
+    for (auto const &statistic : stats)
+    {
+      const std::string name = statistic->ShortName();
+      auto other = std::find_if(others.begin(), others.end(),
+          [&name](const SignalStatisticPtr &_other)
+          {
+            return _other->ShortName() == name;
+          });
+      if (other == others.end())
+        break;
+      pairs.emplace_back(statistic.get(), other->get());
+    }
+  }
+  if (pairs.size() != stats.size() || stats.size() != others.size())
+  {
+    IGN_MATH_DIAGNOSTIC("Unable to Merge "
+        << "since the statistics do not match.");
+    return false;
+  }
+
+  for (auto &pair : pairs)
+    MergeStatistic(*pair.first, *pair.second);
+  return true;
+}
+
 //////////////////////////////////////////////////
 void SignalStats::Reset()
 {
@@ -357,3 +810,293 @@ SignalStats &SignalStats::operator=(const SignalStats &_s)
   this->dataPtr = _s.dataPtr->Clone();
   return *this;
 }
+
+//////////////////////////////////////////////////
+SignalAccumulator::SignalAccumulator()
+  : dataPtr(new SignalAccumulatorPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+SignalAccumulator::~SignalAccumulator()
+{
+}
+
+//////////////////////////////////////////////////
+SignalAccumulator::SignalAccumulator(const SignalAccumulator &_acc)
+  : dataPtr(new SignalAccumulatorPrivate(*_acc.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+SignalAccumulator &SignalAccumulator::operator=(
+    const SignalAccumulator &_acc)
+{
+  *this->dataPtr = *_acc.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void SignalAccumulatorPrivate::Merge(const SignalAccumulatorPrivate &_other)
+{
+  const SignalAccumulatorPrivate other = _other;
+  if (other.count == 0)
+    return;
+  if (this->count == 0 || other.max > this->max)
+    this->max = other.max;
+  if (this->count == 0 || other.min < this->min)
+    this->min = other.min;
+  if (other.maxAbs > this->maxAbs)
+    this->maxAbs = other.maxAbs;
+  this->sum += other.sum;
+  this->sumSq += other.sumSq;
+  MergeVariance(this->count, this->mean, this->m2,
+                other.count, other.mean, other.m2);
+  this->count += other.count;
+}
+
+//////////////////////////////////////////////////
+void SignalAccumulator::InsertData(const double _data)
+{
+  this->dataPtr->InsertData(_data);
+}
+
+//////////////////////////////////////////////////
+void SignalAccumulator::InsertData(const double *_data, const size_t _count)
+{
+  for (size_t i = 0; i < _count; ++i)
+    this->dataPtr->InsertData(_data[i]);
+}
+
+//////////////////////////////////////////////////
+void SignalAccumulator::Merge(const SignalAccumulator &_acc)
+{
+  this->dataPtr->Merge(*_acc.dataPtr);
+}
+
+//////////////////////////////////////////////////
+void SignalAccumulator::Reset()
+{
+  *this->dataPtr = SignalAccumulatorPrivate();
+}
+
+//////////////////////////////////////////////////
+size_t SignalAccumulator::Count() const
+{
+  return this->dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+double SignalAccumulator::Max() const
+{
+  return this->dataPtr->max;
+}
+
+//////////////////////////////////////////////////
+double SignalAccumulator::MaxAbs() const
+{
+  return this->dataPtr->maxAbs;
+}
+
+//////////////////////////////////////////////////
+double SignalAccumulator::Mean() const
+{
+  if (this->dataPtr->count == 0)
+    return 0;
+  return this->dataPtr->sum / this->dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+double SignalAccumulator::Min() const
+{
+  return this->dataPtr->min;
+}
+
+//////////////////////////////////////////////////
+double SignalAccumulator::Rms() const
+{
+  if (this->dataPtr->count == 0)
+    return 0;
+  return sqrt(this->dataPtr->sumSq / this->dataPtr->count);
+}
+
+//////////////////////////////////////////////////
+double SignalAccumulator::Variance() const
+{
+  if (this->dataPtr->count < 2)
+    return 0.0;
+  return this->dataPtr->m2 / (this->dataPtr->count - 1);
+}
+
+//////////////////////////////////////////////////
+std::map<std::string, double> SignalAccumulator::Map() const
+{
+  return StatisticsMap(*this);
+}
+
+//////////////////////////////////////////////////
+SignalWindowAccumulator::SignalWindowAccumulator(const size_t _windowSize)
+  : dataPtr(new SignalWindowAccumulatorPrivate)
+{
+  this->SetWindowSize(_windowSize);
+}
+
+//////////////////////////////////////////////////
+SignalWindowAccumulator::~SignalWindowAccumulator()
+{
+}
+
+//////////////////////////////////////////////////
+SignalWindowAccumulator::SignalWindowAccumulator(
+    const SignalWindowAccumulator &_acc)
+  : dataPtr(new SignalWindowAccumulatorPrivate(*_acc.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+SignalWindowAccumulator &SignalWindowAccumulator::operator=(
+    const SignalWindowAccumulator &_acc)
+{
+  *this->dataPtr = *_acc.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void SignalWindowAccumulator::SetWindowSize(const size_t _windowSize)
+{
+  this->dataPtr->samples.assign(std::max<size_t>(1, _windowSize), 0.0);
+  this->dataPtr->inverseSize = 1.0 / this->dataPtr->samples.size();
+  this->dataPtr->maxQueue.Resize(this->dataPtr->samples.size());
+  this->dataPtr->minQueue.Resize(this->dataPtr->samples.size());
+  this->dataPtr->maxAbsQueue.Resize(this->dataPtr->samples.size());
+  this->Reset();
+}
+
+//////////////////////////////////////////////////
+size_t SignalWindowAccumulator::WindowSize() const
+{
+  return this->dataPtr->samples.size();
+}
+
+//////////////////////////////////////////////////
+void SignalWindowAccumulator::InsertData(const double _data)
+{
+  SignalWindowAccumulatorPrivate &d = *this->dataPtr;
+  const size_t windowSize = d.samples.size();
+  if (d.count < windowSize)
+  {
+    d.count++;
+    d.sum += _data;
+    d.sumSq += _data * _data;
+    const double delta = _data - d.mean;
+    d.mean += delta / d.count;
+    d.m2 += delta * (_data - d.mean);
+  }
+  else
+  {
+    // Replace the oldest sample
+    const double old = d.samples[d.next];
+    const double oldMean = d.mean;
+    d.sum += _data - old;
+    d.sumSq += _data * _data - old * old;
+    d.mean += (_data - old) * d.inverseSize;
+    d.m2 += (_data - old) * (_data - d.mean + old - oldMean);
+  }
+  d.samples[d.next] = _data;
+  if (++d.next == windowSize)
+  {
+    d.next = 0;
+    RecomputeSums(d);
+  }
+
+  const uint64_t oldest = d.index + 1 - d.count;
+  PushMonotonic(d.maxQueue, d.index, _data, oldest, std::greater<double>());
+  PushMonotonic(d.minQueue, d.index, _data, oldest, std::less<double>());
+  PushMonotonic(d.maxAbsQueue, d.index, std::abs(_data), oldest,
+                std::greater<double>());
+  d.index++;
+}
+
+//////////////////////////////////////////////////
+void SignalWindowAccumulator::InsertData(const double *_data,
+                                         const size_t _count)
+{
+  for (size_t i = 0; i < _count; ++i)
+    this->InsertData(_data[i]);
+}
+
+//////////////////////////////////////////////////
+void SignalWindowAccumulator::Reset()
+{
+  SignalWindowAccumulatorPrivate &d = *this->dataPtr;
+  d.next = 0;
+  d.count = 0;
+  d.index = 0;
+  d.sum = 0.0;
+  d.sumSq = 0.0;
+  d.mean = 0.0;
+  d.m2 = 0.0;
+  d.maxQueue.Clear();
+  d.minQueue.Clear();
+  d.maxAbsQueue.Clear();
+}
+
+//////////////////////////////////////////////////
+size_t SignalWindowAccumulator::Count() const
+{
+  return this->dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+double SignalWindowAccumulator::Max() const
+{
+  if (this->dataPtr->maxQueue.Empty())
+    return 0.0;
+  return this->dataPtr->maxQueue.Front().value;
+}
+
+//////////////////////////////////////////////////
+double SignalWindowAccumulator::MaxAbs() const
+{
+  if (this->dataPtr->maxAbsQueue.Empty())
+    return 0.0;
+  return this->dataPtr->maxAbsQueue.Front().value;
+}
+
+//////////////////////////////////////////////////
+double SignalWindowAccumulator::Mean() const
+{
+  if (this->dataPtr->count == 0)
+    return 0;
+  return this->dataPtr->sum / this->dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+double SignalWindowAccumulator::Min() const
+{
+  if (this->dataPtr->minQueue.Empty())
+    return 0.0;
+  return this->dataPtr->minQueue.Front().value;
+}
+
+//////////////////////////////////////////////////
+double SignalWindowAccumulator::Rms() const
+{
+  if (this->dataPtr->count == 0)
+    return 0;
+  return sqrt(std::max(0.0, this->dataPtr->sumSq) / this->dataPtr->count);
+}
+
+//////////////////////////////////////////////////
+double SignalWindowAccumulator::Variance() const
+{
+  if (this->dataPtr->count < 2)
+    return 0.0;
+  return std::max(0.0, this->dataPtr->m2) / (this->dataPtr->count - 1);
+}
+
+//////////////////////////////////////////////////
+std::map<std::string, double> SignalWindowAccumulator::Map() const
+{
+  return StatisticsMap(*this);
+}
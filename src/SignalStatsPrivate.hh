@@ -17,7 +17,11 @@
 #ifndef GZ_MATH_SIGNALSTATSPRIVATE_HH_
 #define GZ_MATH_SIGNALSTATSPRIVATE_HH_
 
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <gz/math/config.hh>
 
@@ -50,6 +54,55 @@ namespace ignition
       }
     };
 
+    /// \brief Private data class for the SignalQuantile class.
+    class SignalQuantilePrivate
+    {
+      /// \brief Constructor.
+      /// \param[in] _resource Memory resource of the centroids.
+      public: explicit SignalQuantilePrivate(
+                  std::pmr::memory_resource *_resource)
+        : centroids(_resource), buffer(_resource), scratch(_resource)
+      {
+      }
+
+      /// \brief Centroid of the digest.
+      public: struct Centroid
+      {
+        /// \brief Mean of the samples in the centroid.
+        double mean;
+
+        /// \brief Number of samples in the centroid.
+        double weight;
+      };
+
+      /// \brief Quantile to estimate, between 0 and 1.
+      public: double quantile = 0.5;
+
+      /// \brief Compression of the digest.
+      public: double compression = 100;
+
+      /// \brief Centroids of the digest, sorted by mean.
+      public: std::pmr::vector<Centroid> centroids;
+
+      /// \brief Samples and centroids not yet merged into the digest.
+      public: std::pmr::vector<Centroid> buffer;
+
+      /// \brief Number of entries of the buffer that triggers a merge.
+      public: size_t bufferCapacity = 500;
+
+      /// \brief Storage for the merge, kept to avoid allocations.
+      public: std::pmr::vector<Centroid> scratch;
+
+      /// \brief Smallest sample.
+      public: double min = 0.0;
+
+      /// \brief Largest sample.
+      public: double max = 0.0;
+
+      /// \brief Total weight of the digest and buffer.
+      public: double total = 0.0;
+    };
+
     class SignalStatistic;
 
     /// \def SignalStatisticPtr
@@ -66,6 +119,10 @@ namespace ignition
       /// \brief Vector of `SignalStatistic`s.
       public: SignalStatistic_V stats;
 
+      /// \brief Memory resource of the quantile statistics.
+      public: std::pmr::memory_resource *resource =
+                  std::pmr::get_default_resource();
+
       /// \brief Clone the SignalStatsPrivate object. Used for implementing
       /// copy semantics.
       public: std::unique_ptr<SignalStatsPrivate> Clone() const
@@ -75,6 +132,191 @@ namespace ignition
         return dataPtr;
       }
     };
+
+    /// \brief Private data class for the SignalAccumulator class.
+    class SignalAccumulatorPrivate
+    {
+      /// \brief Add a new sample, with the same arithmetic as each of the
+      /// SignalStatistic classes.
+      /// \param[in] _data New signal data point.
+      public: void InsertData(const double _data)
+      {
+        if (this->count == 0 || _data > this->max)
+          this->max = _data;
+        if (this->count == 0 || _data < this->min)
+          this->min = _data;
+        const double absData = std::abs(_data);
+        if (absData > this->maxAbs)
+          this->maxAbs = absData;
+        this->sum += _data;
+        this->sumSq += _data * _data;
+
+        this->count++;
+        const double delta = _data - this->mean;
+        this->mean += delta / this->count;
+        this->m2 += delta * (_data - this->mean);
+      }
+
+      /// \brief Add the data points of another accumulator.
+      /// \param[in] _other Accumulator to merge into this one. It may be
+      /// this one.
+      public: void Merge(const SignalAccumulatorPrivate &_other);
+
+      /// \brief Count of data values.
+      public: size_t count = 0;
+
+      /// \brief Sum of the data values.
+      public: double sum = 0.0;
+
+      /// \brief Sum of the squared data values.
+      public: double sumSq = 0.0;
+
+      /// \brief Running mean of the variance algorithm.
+      public: double mean = 0.0;
+
+      /// \brief Sum of the squared differences to the mean.
+      public: double m2 = 0.0;
+
+      /// \brief Maximum value.
+      public: double max = 0.0;
+
+      /// \brief Minimum value.
+      public: double min = 0.0;
+
+      /// \brief Maximum absolute value.
+      public: double maxAbs = 0.0;
+    };
+
+    /// \brief Queue of the samples of a window that can still become its
+    /// extremum, by some ordering. The values in the queue are ordered, so
+    /// the extremum is at the front. The queue is a double ended ring
+    /// buffer, which never holds more entries than the window.
+    class SignalMonotonicQueue
+    {
+      /// \brief Entry of the queue.
+      public: struct Entry
+      {
+        /// \brief Index of the sample in the signal.
+        uint64_t index;
+
+        /// \brief Value of the sample.
+        double value;
+      };
+
+      /// \brief Set the capacity of the queue, and empty it.
+      /// \param[in] _capacity Maximum number of entries.
+      public: void Resize(const size_t _capacity)
+      {
+        this->entries.assign(_capacity, Entry{0, 0.0});
+        this->Clear();
+      }
+
+      /// \brief Remove all the entries.
+      public: void Clear()
+      {
+        this->head = 0;
+        this->size = 0;
+      }
+
+      /// \brief Check if the queue is empty.
+      /// \return True if there are no entries.
+      public: bool Empty() const
+      {
+        return this->size == 0;
+      }
+
+      /// \brief Get the first entry. The queue must not be empty.
+      /// \return The first entry.
+      public: const Entry &Front() const
+      {
+        return this->entries[this->head];
+      }
+
+      /// \brief Get the last entry. The queue must not be empty.
+      /// \return The last entry.
+      public: const Entry &Back() const
+      {
+        return this->entries[this->Wrap(this->head + this->size - 1)];
+      }
+
+      /// \brief Remove the first entry. The queue must not be empty.
+      public: void PopFront()
+      {
+        this->head = this->Wrap(this->head + 1);
+        this->size--;
+      }
+
+      /// \brief Remove the last entry. The queue must not be empty.
+      public: void PopBack()
+      {
+        this->size--;
+      }
+
+      /// \brief Add an entry at the back. The queue must not be full.
+      /// \param[in] _entry New entry.
+      public: void PushBack(const Entry &_entry)
+      {
+        this->entries[this->Wrap(this->head + this->size)] = _entry;
+        this->size++;
+      }
+
+      /// \brief Wrap a position around the ring buffer.
+      /// \param[in] _i Position, less than twice the capacity.
+      /// \return Position in the ring buffer.
+      private: size_t Wrap(const size_t _i) const
+      {
+        return _i < this->entries.size() ? _i : _i - this->entries.size();
+      }
+
+      /// \brief Storage of the entries.
+      private: std::vector<Entry> entries;
+
+      /// \brief Position of the first entry.
+      private: size_t head = 0;
+
+      /// \brief Number of entries.
+      private: size_t size = 0;
+    };
+
+    /// \brief Private data class for the SignalWindowAccumulator class.
+    class SignalWindowAccumulatorPrivate
+    {
+      /// \brief Samples in the window, as a ring buffer.
+      public: std::vector<double> samples;
+
+      /// \brief Inverse of the window size.
+      public: double inverseSize = 1.0;
+
+      /// \brief Position of the next sample in the ring buffer.
+      public: size_t next = 0;
+
+      /// \brief Number of samples in the window.
+      public: size_t count = 0;
+
+      /// \brief Index of the next sample in the whole signal.
+      public: uint64_t index = 0;
+
+      /// \brief Sum of the samples in the window.
+      public: double sum = 0.0;
+
+      /// \brief Sum of the squared samples in the window.
+      public: double sumSq = 0.0;
+
+      /// \brief Mean of the samples in the window, for the variance.
+      public: double mean = 0.0;
+
+      /// \brief Sum of the squared differences to the mean.
+      public: double m2 = 0.0;
+
+      /// \brief Candidates for the maximum value.
+      public: SignalMonotonicQueue maxQueue;
+
+      /// \brief Candidates for the minimum value.
+      public: SignalMonotonicQueue minQueue;
+
+      /// \brief Candidates for the maximum absolute value.
+      public: SignalMonotonicQueue maxAbsQueue;
+    };
     }
   }
 }
@@ -17,11 +17,44 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <memory_resource>
+#include <cstddef>
+#include <vector>
+
 #include <gz/math/Rand.hh>
 #include <gz/math/SignalStats.hh>
 
 using namespace gz;
 
+/////////////////////////////////////////////////
+/// \brief Memory resource which counts its allocations.
+class CountingResource : public std::pmr::memory_resource
+{
+  /// \brief Number of allocations.
+  public: std::size_t allocations = 0;
+
+  private: void *do_allocate(std::size_t _bytes,
+                             std::size_t _alignment) override
+  {
+    ++this->allocations;
+    return std::pmr::new_delete_resource()->allocate(_bytes, _alignment);
+  }
+
+  private: void do_deallocate(void *_p, std::size_t _bytes,
+                              std::size_t _alignment) override
+  {
+    std::pmr::new_delete_resource()->deallocate(_p, _bytes, _alignment);
+  }
+
+  private: bool do_is_equal(
+               const std::pmr::memory_resource &_other) const noexcept override
+  {
+    return this == &_other;
+  }
+};
+
 //////////////////////////////////////////////////
 TEST(SignalStatsTest, SignalMaximumConstructor)
 {
@@ -639,3 +672,376 @@ TEST(SignalStatsTest, SignalStats)
   }
 }
 
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalAccumulator)
+{
+  math::SignalAccumulator acc;
+  EXPECT_EQ(acc.Count(), 0u);
+  std::map<std::string, double> map = acc.Map();
+  EXPECT_EQ(map.size(), 6u);
+  for (auto const &stat : map)
+    EXPECT_DOUBLE_EQ(stat.second, 0.0);
+
+  // Matches the separate statistics exactly
+  math::SignalStats stats;
+  EXPECT_TRUE(stats.InsertStatistics("max,maxAbs,mean,min,rms,var"));
+  std::vector<double> values(1000);
+  for (auto &value : values)
+    value = math::Rand::DblUniform(-10, 5);
+  acc.InsertData(values.data(), values.size() / 2);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    stats.InsertData(values[i]);
+    if (i >= values.size() / 2)
+      acc.InsertData(values[i]);
+  }
+  EXPECT_EQ(stats.Count(), acc.Count());
+  EXPECT_EQ(stats.Map(), acc.Map());
+  EXPECT_DOUBLE_EQ(*std::max_element(values.begin(), values.end()),
+                   acc.Max());
+  EXPECT_DOUBLE_EQ(*std::min_element(values.begin(), values.end()),
+                   acc.Min());
+
+  // Copy and reset
+  math::SignalAccumulator copy(acc);
+  EXPECT_EQ(acc.Map(), copy.Map());
+  acc.Reset();
+  EXPECT_EQ(acc.Count(), 0u);
+  EXPECT_DOUBLE_EQ(acc.Variance(), 0.0);
+  EXPECT_EQ(copy.Count(), values.size());
+  copy = acc;
+  EXPECT_EQ(copy.Count(), 0u);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalWindowAccumulator)
+{
+  math::SignalWindowAccumulator zero(0);
+  EXPECT_EQ(zero.WindowSize(), 1u);
+  zero.InsertData(-3.0);
+  zero.InsertData(2.0);
+  EXPECT_EQ(zero.Count(), 1u);
+  EXPECT_DOUBLE_EQ(zero.Min(), 2.0);
+  EXPECT_DOUBLE_EQ(zero.Variance(), 0.0);
+
+  // Compare with the statistics of the last samples, for window sizes
+  // that do and do not divide the number of samples
+  std::vector<double> values(500);
+  for (auto &value : values)
+    value = math::Rand::DblUniform(-10, 5);
+  for (size_t windowSize : {1u, 2u, 7u, 50u, 600u})
+  {
+    math::SignalWindowAccumulator acc(windowSize);
+    EXPECT_EQ(acc.WindowSize(), windowSize);
+    EXPECT_EQ(acc.Count(), 0u);
+    EXPECT_DOUBLE_EQ(acc.Max(), 0.0);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      acc.InsertData(values[i]);
+      const size_t first = i + 1 > windowSize ? i + 1 - windowSize : 0;
+      math::SignalAccumulator reference;
+      reference.InsertData(&values[first], i + 1 - first);
+      EXPECT_EQ(reference.Count(), acc.Count());
+      EXPECT_DOUBLE_EQ(reference.Max(), acc.Max());
+      EXPECT_DOUBLE_EQ(reference.Min(), acc.Min());
+      EXPECT_DOUBLE_EQ(reference.MaxAbs(), acc.MaxAbs());
+      EXPECT_NEAR(reference.Mean(), acc.Mean(), 1e-12);
+      EXPECT_NEAR(reference.Rms(), acc.Rms(), 1e-12);
+      EXPECT_NEAR(reference.Variance(), acc.Variance(), 1e-10);
+    }
+  }
+
+  // Constant values within the window
+  math::SignalWindowAccumulator acc(3);
+  acc.InsertData(values.data(), values.size());
+  for (int i = 0; i < 3; ++i)
+    acc.InsertData(-4.0);
+  EXPECT_DOUBLE_EQ(acc.Max(), -4.0);
+  EXPECT_DOUBLE_EQ(acc.Min(), -4.0);
+  EXPECT_DOUBLE_EQ(acc.MaxAbs(), 4.0);
+  EXPECT_DOUBLE_EQ(acc.Mean(), -4.0);
+  EXPECT_DOUBLE_EQ(acc.Rms(), 4.0);
+  EXPECT_NEAR(acc.Variance(), 0.0, 1e-12);
+
+  // Copy, reset and resize
+  math::SignalWindowAccumulator copy(acc);
+  EXPECT_EQ(acc.Map(), copy.Map());
+  acc.Reset();
+  EXPECT_EQ(acc.Count(), 0u);
+  EXPECT_DOUBLE_EQ(acc.Min(), 0.0);
+  EXPECT_EQ(copy.Count(), 3u);
+  copy.SetWindowSize(5);
+  EXPECT_EQ(copy.WindowSize(), 5u);
+  EXPECT_EQ(copy.Count(), 0u);
+  copy = acc;
+  EXPECT_EQ(copy.WindowSize(), 3u);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalWindowAccumulatorNoDrift)
+{
+  // A long signal with a large offset does not build up rounding errors
+  math::SignalWindowAccumulator acc(100);
+  std::vector<double> window;
+  for (int i = 0; i < 1000003; ++i)
+  {
+    const double value = 1e6 + std::sin(0.1 * i);
+    acc.InsertData(value);
+  }
+  for (int i = 1000003 - 100; i < 1000003; ++i)
+    window.push_back(1e6 + std::sin(0.1 * i));
+  math::SignalAccumulator reference;
+  reference.InsertData(window.data(), window.size());
+  EXPECT_NEAR(reference.Mean(), acc.Mean(), 1e-9);
+  EXPECT_NEAR(reference.Variance(), acc.Variance(), 1e-6);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, Merge)
+{
+  std::vector<double> values(1000);
+  for (auto &value : values)
+    value = math::Rand::DblUniform(-10, 5);
+  const size_t split = 377;
+
+  // Each statistic gives the same result from two shards as from the
+  // whole signal
+  auto check = [&](auto _all, auto _first, auto _second)
+  {
+    decltype(_all) empty;
+    _all.Merge(empty);
+    _first.Merge(empty);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      _all.InsertData(values[i]);
+      if (i < split)
+        _first.InsertData(values[i]);
+      else
+        _second.InsertData(values[i]);
+    }
+    _first.Merge(_second);
+    EXPECT_EQ(_all.Count(), _first.Count());
+    EXPECT_NEAR(_all.Value(), _first.Value(), 1e-10) << _all.ShortName();
+
+    // Merging into an empty statistic copies it
+    empty.Merge(_all);
+    EXPECT_EQ(_all.Count(), empty.Count());
+    EXPECT_DOUBLE_EQ(_all.Value(), empty.Value());
+  };
+  check(math::SignalMaximum(), math::SignalMaximum(),
+        math::SignalMaximum());
+  check(math::SignalMaxAbsoluteValue(), math::SignalMaxAbsoluteValue(),
+        math::SignalMaxAbsoluteValue());
+  check(math::SignalMean(), math::SignalMean(), math::SignalMean());
+  check(math::SignalMinimum(), math::SignalMinimum(),
+        math::SignalMinimum());
+  check(math::SignalRootMeanSquare(), math::SignalRootMeanSquare(),
+        math::SignalRootMeanSquare());
+  check(math::SignalVariance(), math::SignalVariance(),
+        math::SignalVariance());
+
+  // Collections of statistics, reduced from several shards
+  const std::string names = "max,maxAbs,mean,min,rms,var";
+  math::SignalStats all;
+  EXPECT_TRUE(all.InsertStatistics(names));
+  all.InsertData(values.data()[0]);
+  all.Reset();
+  std::vector<math::SignalStats> shards(4);
+  for (auto &shard : shards)
+    EXPECT_TRUE(shard.InsertStatistics(names));
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    all.InsertData(values[i]);
+    shards[i * shards.size() / values.size()].InsertData(values[i]);
+  }
+  for (size_t i = 1; i < shards.size(); ++i)
+    EXPECT_TRUE(shards[0].Merge(shards[i]));
+  EXPECT_EQ(all.Count(), shards[0].Count());
+  std::map<std::string, double> allMap = all.Map();
+  std::map<std::string, double> mergedMap = shards[0].Map();
+  EXPECT_EQ(allMap.size(), mergedMap.size());
+  for (auto const &stat : allMap)
+    EXPECT_NEAR(stat.second, mergedMap[stat.first], 1e-10) << stat.first;
+
+  // Collections with different statistics are not merged
+  math::SignalStats other;
+  EXPECT_TRUE(other.InsertStatistics("max,mean"));
+  other.InsertData(100.0);
+  EXPECT_FALSE(shards[0].Merge(other));
+  EXPECT_FALSE(other.Merge(shards[0]));
+  EXPECT_EQ(mergedMap, shards[0].Map());
+  EXPECT_TRUE(other.InsertStatistics("min,maxAbs,rms,var"));
+  EXPECT_TRUE(other.Merge(shards[0]));
+  EXPECT_DOUBLE_EQ(100.0, other.Map()["max"]);
+
+  // Accumulators
+  math::SignalAccumulator accAll, accFirst, accSecond, accEmpty;
+  accAll.InsertData(values.data(), values.size());
+  accFirst.InsertData(values.data(), split);
+  accSecond.InsertData(values.data() + split, values.size() - split);
+  accFirst.Merge(accEmpty);
+  accFirst.Merge(accSecond);
+  EXPECT_EQ(accAll.Count(), accFirst.Count());
+  allMap = accAll.Map();
+  mergedMap = accFirst.Map();
+  for (auto const &stat : allMap)
+    EXPECT_NEAR(stat.second, mergedMap[stat.first], 1e-10) << stat.first;
+  accEmpty.Merge(accAll);
+  EXPECT_EQ(allMap, accEmpty.Map());
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalQuantile)
+{
+  math::SignalQuantile median;
+  EXPECT_DOUBLE_EQ(median.Quantile(), 0.5);
+  EXPECT_DOUBLE_EQ(median.Compression(), 100);
+  EXPECT_EQ(median.ShortName(), "p50");
+  EXPECT_DOUBLE_EQ(median.Value(), 0.0);
+  EXPECT_EQ(median.Count(), 0u);
+
+  // Few samples are kept exactly, and interpolated
+  for (double value : {4.0, 1.0, 3.0, 2.0})
+    median.InsertData(value);
+  EXPECT_EQ(median.Count(), 4u);
+  EXPECT_DOUBLE_EQ(median.Value(), 2.5);
+  EXPECT_DOUBLE_EQ(median.Value(0.0), 1.0);
+  EXPECT_DOUBLE_EQ(median.Value(1.0), 4.0);
+  EXPECT_DOUBLE_EQ(median.Value(2.0), 4.0);
+
+  // Copies are independent
+  math::SignalQuantile copy(median);
+  copy.InsertData(10.0);
+  EXPECT_EQ(median.Count(), 4u);
+  EXPECT_DOUBLE_EQ(copy.Value(), 3.0);
+
+  median.Reset();
+  EXPECT_EQ(median.Count(), 0u);
+  EXPECT_DOUBLE_EQ(median.Value(), 0.0);
+  median.InsertData(-7.0);
+  EXPECT_DOUBLE_EQ(median.Value(), -7.0);
+
+  // Tail quantiles of many samples, in bounded memory
+  math::SignalQuantile p99(0.99);
+  math::SignalQuantile p999(0.999);
+  EXPECT_EQ(p99.ShortName(), "p99");
+  EXPECT_EQ(p999.ShortName(), "p99.9");
+  const int count = 200000;
+  std::vector<double> values(count);
+  for (auto &value : values)
+  {
+    value = math::Rand::DblNormal(1.0, 2.0);
+    p99.InsertData(value);
+    p999.InsertData(value);
+  }
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(p99.Count(), static_cast<size_t>(count));
+
+  // The error of a t-digest is in rank, and smaller in the tails
+  auto rank = [&values](double _value)
+  {
+    return static_cast<double>(std::lower_bound(values.begin(),
+        values.end(), _value) - values.begin()) / values.size();
+  };
+  EXPECT_NEAR(0.99, rank(p99.Value()), 1e-3);
+  EXPECT_NEAR(0.999, rank(p999.Value()), 5e-4);
+  EXPECT_NEAR(0.5, rank(p99.Value(0.5)), 5e-3);
+  EXPECT_NEAR(0.01, rank(p99.Value(0.01)), 1e-3);
+  EXPECT_DOUBLE_EQ(values.front(), p99.Value(0.0));
+  EXPECT_DOUBLE_EQ(values.back(), p99.Value(1.0));
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalQuantileMerge)
+{
+  std::vector<math::SignalQuantile> shards(5, math::SignalQuantile(0.9));
+  math::SignalQuantile all(0.9);
+  std::vector<double> values;
+  for (int i = 0; i < 50000; ++i)
+  {
+    const double value = math::Rand::DblUniform(0, 10);
+    values.push_back(value);
+    all.InsertData(value);
+    shards[i % shards.size()].InsertData(value);
+  }
+  math::SignalQuantile merged(0.9);
+  for (auto const &shard : shards)
+    merged.Merge(shard);
+  EXPECT_EQ(all.Count(), merged.Count());
+  std::sort(values.begin(), values.end());
+  EXPECT_NEAR(values[values.size() * 9 / 10], merged.Value(), 0.05);
+  EXPECT_NEAR(all.Value(), merged.Value(), 0.05);
+  EXPECT_DOUBLE_EQ(values.front(), merged.Value(0.0));
+  EXPECT_DOUBLE_EQ(values.back(), merged.Value(1.0));
+
+  // Merging with itself doubles the weights
+  math::SignalQuantile self(0.5);
+  for (double value : {1.0, 2.0, 3.0})
+    self.InsertData(value);
+  self.Merge(self);
+  EXPECT_EQ(self.Count(), 6u);
+  EXPECT_DOUBLE_EQ(self.Value(), 2.0);
+
+  // Through SignalStats
+  math::SignalStats stats, other;
+  EXPECT_TRUE(stats.InsertStatistics("p90,mean"));
+  EXPECT_TRUE(other.InsertStatistics("mean,p90"));
+  for (size_t i = 0; i < values.size(); ++i)
+    (i % 2 ? stats : other).InsertData(values[i]);
+  EXPECT_TRUE(stats.Merge(other));
+  EXPECT_NEAR(values[values.size() * 9 / 10], stats.Map()["p90"], 0.05);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalStatsPercentiles)
+{
+  math::SignalStats stats;
+  EXPECT_TRUE(stats.InsertStatistic("p99"));
+  EXPECT_TRUE(stats.InsertStatistic("p99.9"));
+  EXPECT_TRUE(stats.InsertStatistic("p0"));
+  EXPECT_TRUE(stats.InsertStatistic("p100"));
+  EXPECT_TRUE(stats.InsertStatistic("p50"));
+  EXPECT_FALSE(stats.InsertStatistic("p99"));
+  EXPECT_FALSE(stats.InsertStatistic("p99.0"));
+  EXPECT_FALSE(stats.InsertStatistic("p101"));
+  EXPECT_FALSE(stats.InsertStatistic("p"));
+  EXPECT_FALSE(stats.InsertStatistic("p-1"));
+  EXPECT_FALSE(stats.InsertStatistic("p.5"));
+  EXPECT_FALSE(stats.InsertStatistic("p9x"));
+  EXPECT_FALSE(stats.InsertStatistic("p1e1"));
+
+  for (int i = 1; i <= 1000; ++i)
+    stats.InsertData(i);
+  std::map<std::string, double> map = stats.Map();
+  EXPECT_EQ(map.size(), 5u);
+  EXPECT_DOUBLE_EQ(map["p0"], 1.0);
+  EXPECT_DOUBLE_EQ(map["p100"], 1000.0);
+  EXPECT_NEAR(map["p50"], 500.5, 1.0);
+  EXPECT_NEAR(map["p99"], 990.5, 1.0);
+  EXPECT_NEAR(map["p99.9"], 999.5, 1.0);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, MemoryResource)
+{
+  CountingResource resource;
+  math::SignalQuantile quantile(0.9, 100, &resource);
+  math::SignalQuantile expected(0.9);
+  math::SignalStats stats(&resource);
+  EXPECT_TRUE(stats.InsertStatistic("p90"));
+  for (int i = 0; i < 5000; ++i)
+  {
+    const double value = (i * 7919) % 1000;
+    quantile.InsertData(value);
+    expected.InsertData(value);
+    stats.InsertData(value);
+  }
+  EXPECT_LT(0u, resource.allocations);
+  EXPECT_DOUBLE_EQ(expected.Value(), quantile.Value());
+  EXPECT_DOUBLE_EQ(expected.Value(), stats.Map()["p90"]);
+
+  const std::size_t allocations = resource.allocations;
+  quantile.Merge(expected);
+  EXPECT_LT(allocations, resource.allocations);
+}
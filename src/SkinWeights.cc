@@ -0,0 +1,451 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/SkinWeights.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Minimum number of vertices deformed by each thread.
+  const std::size_t kMinVerticesPerThread = 4096;
+
+  /////////////////////////////////////////////////
+  /// \brief Call a function on contiguous blocks of a range, one block per
+  /// thread.
+  /// \param[in] _count Size of the range.
+  /// \param[in] _threads Requested number of threads, 0 for the number of
+  /// hardware threads.
+  /// \param[in] _minPerThread Minimum size of a block.
+  /// \param[in] _function Function taking the beginning and end of a block.
+  template<typename Function>
+  void ForEachBlock(const std::size_t _count, const unsigned int _threads,
+                    const std::size_t _minPerThread, const Function &_function)
+  {
+    std::size_t threads = _threads;
+    if (threads == 0)
+      threads = std::thread::hardware_concurrency();
+    threads = std::min(threads, _count / _minPerThread);
+    if (threads <= 1)
+    {
+      _function(std::size_t{0}, _count);
+      return;
+    }
+
+    const std::size_t chunk = (_count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (std::size_t t = 1; t < threads; ++t)
+    {
+      const std::size_t begin = std::min(_count, t * chunk);
+      const std::size_t end = std::min(_count, begin + chunk);
+      workers.emplace_back([&_function, begin, end]()
+          {
+            _function(begin, end);
+          });
+    }
+    _function(std::size_t{0}, std::min(_count, chunk));
+
+    for (auto &worker : workers)
+      worker.join();
+  }
+}
+
+/// \brief Private data for SkinWeights.
+class gz::math::SkinWeightsPrivate
+{
+  /// \brief Recompute boneCount from the bones.
+  public: void UpdateBoneCount()
+  {
+    this->boneCount = this->bones.empty() ? 0 :
+      static_cast<std::size_t>(
+          *std::max_element(this->bones.begin(), this->bones.end())) + 1;
+  }
+
+  /// \brief Linear blend skinning of the vertices [_begin, _end).
+  /// \param[in] _m Top three rows of each bone transform in row major
+  /// order, 12 consecutive values per bone.
+  /// \param[in] _rest Rest positions.
+  /// \param[out] _out Deformed positions.
+  /// \param[in] _begin First vertex.
+  /// \param[in] _end One past the last vertex.
+  public: void LinearBlend(const std::vector<double> &_m,
+                           const Vector3SoAd &_rest, Vector3SoAd &_out,
+                           const std::size_t _begin,
+                           const std::size_t _end) const;
+
+  /// \brief Dual quaternion skinning of the vertices [_begin, _end).
+  /// \param[in] _dq Real w, x, y, z and dual w, x, y, z parts of the unit
+  /// dual quaternion of each bone, 8 consecutive values per bone.
+  /// \param[in] _rest Rest positions.
+  /// \param[out] _out Deformed positions.
+  /// \param[in] _begin First vertex.
+  /// \param[in] _end One past the last vertex.
+  public: void DualQuaternionBlend(const std::vector<double> &_dq,
+                                   const Vector3SoAd &_rest,
+                                   Vector3SoAd &_out,
+                                   const std::size_t _begin,
+                                   const std::size_t _end) const;
+
+  /// \brief Number of vertices.
+  public: std::size_t vertexCount = 0;
+
+  /// \brief Number of influences of each vertex.
+  public: std::size_t influenceCount = 0;
+
+  /// \brief Bone of each influence. Influence k of vertex v is at index
+  /// k * vertexCount + v.
+  public: std::vector<uint32_t> bones;
+
+  /// \brief Weight of each influence, laid out like bones.
+  public: std::vector<double> weights;
+
+  /// \brief Largest bone index plus one.
+  public: std::size_t boneCount = 0;
+};
+
+/////////////////////////////////////////////////
+void SkinWeightsPrivate::LinearBlend(const std::vector<double> &_m,
+    const Vector3SoAd &_rest, Vector3SoAd &_out, const std::size_t _begin,
+    const std::size_t _end) const
+{
+  const double *rx = _rest.XData(), *ry = _rest.YData(),
+               *rz = _rest.ZData();
+  double *ox = _out.XData(), *oy = _out.YData(), *oz = _out.ZData();
+  const uint32_t *b = this->bones.data();
+  const double *w = this->weights.data();
+  const std::size_t stride = this->vertexCount;
+
+  for (std::size_t v = _begin; v < _end; ++v)
+  {
+    double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+    double a10 = 0, a11 = 0, a12 = 0, a13 = 0;
+    double a20 = 0, a21 = 0, a22 = 0, a23 = 0;
+    double wsum = 0;
+    for (std::size_t k = 0; k < this->influenceCount; ++k)
+    {
+      const double *m = _m.data() + 12 * b[k * stride + v];
+      const double wk = w[k * stride + v];
+      wsum += wk;
+      a00 += wk * m[0];
+      a01 += wk * m[1];
+      a02 += wk * m[2];
+      a03 += wk * m[3];
+      a10 += wk * m[4];
+      a11 += wk * m[5];
+      a12 += wk * m[6];
+      a13 += wk * m[7];
+      a20 += wk * m[8];
+      a21 += wk * m[9];
+      a22 += wk * m[10];
+      a23 += wk * m[11];
+    }
+
+    // Vertices without weights keep their rest position
+    const double keep = equal(wsum, 0.0) ? 1.0 : 0.0;
+    const double x = rx[v], y = ry[v], z = rz[v];
+    ox[v] = (a00 + keep) * x + a01 * y + a02 * z + a03;
+    oy[v] = a10 * x + (a11 + keep) * y + a12 * z + a13;
+    oz[v] = a20 * x + a21 * y + (a22 + keep) * z + a23;
+  }
+}
+
+/////////////////////////////////////////////////
+void SkinWeightsPrivate::DualQuaternionBlend(const std::vector<double> &_dq,
+    const Vector3SoAd &_rest, Vector3SoAd &_out, const std::size_t _begin,
+    const std::size_t _end) const
+{
+  const double *rx = _rest.XData(), *ry = _rest.YData(),
+               *rz = _rest.ZData();
+  double *ox = _out.XData(), *oy = _out.YData(), *oz = _out.ZData();
+  const uint32_t *b = this->bones.data();
+  const double *w = this->weights.data();
+  const std::size_t stride = this->vertexCount;
+
+  for (std::size_t v = _begin; v < _end; ++v)
+  {
+    // Blend in the hemisphere of the first influence
+    const double *pivot = _dq.data() + 8 * b[v];
+    double rw = 0, rx2 = 0, ry2 = 0, rz2 = 0;
+    double ew = 0, ex = 0, ey = 0, ez = 0;
+    for (std::size_t k = 0; k < this->influenceCount; ++k)
+    {
+      const double *q = _dq.data() + 8 * b[k * stride + v];
+      const double dot = q[0] * pivot[0] + q[1] * pivot[1] +
+        q[2] * pivot[2] + q[3] * pivot[3];
+      // copysign keeps this branch free, the sign is hard to predict
+      const double wk = std::copysign(w[k * stride + v], dot);
+      rw += wk * q[0];
+      rx2 += wk * q[1];
+      ry2 += wk * q[2];
+      rz2 += wk * q[3];
+      ew += wk * q[4];
+      ex += wk * q[5];
+      ey += wk * q[6];
+      ez += wk * q[7];
+    }
+
+    // Normalize the blend, an all zero blend becomes the identity
+    const double len2 = rw * rw + rx2 * rx2 + ry2 * ry2 + rz2 * rz2;
+    const double keep = len2 > 0.0 ? 0.0 : 1.0;
+    const double inv = 1.0 / std::sqrt(len2 + keep);
+    const double qw = rw * inv + keep;
+    const double ux = rx2 * inv, uy = ry2 * inv, uz = rz2 * inv;
+    ew *= inv;
+    ex *= inv;
+    ey *= inv;
+    ez *= inv;
+
+    // Rotation, v + 2w(u x v) + 2u x (u x v)
+    const double x = rx[v], y = ry[v], z = rz[v];
+    const double cx = 2.0 * (uy * z - uz * y);
+    const double cy = 2.0 * (uz * x - ux * z);
+    const double cz = 2.0 * (ux * y - uy * x);
+
+    // Translation, 2(w e - ew u + u x e)
+    const double tx = 2.0 * (qw * ex - ew * ux + (uy * ez - uz * ey));
+    const double ty = 2.0 * (qw * ey - ew * uy + (uz * ex - ux * ez));
+    const double tz = 2.0 * (qw * ez - ew * uz + (ux * ey - uy * ex));
+
+    ox[v] = x + qw * cx + (uy * cz - uz * cy) + tx;
+    oy[v] = y + qw * cy + (uz * cx - ux * cz) + ty;
+    oz[v] = z + qw * cz + (ux * cy - uy * cx) + tz;
+  }
+}
+
+/////////////////////////////////////////////////
+SkinWeights::SkinWeights()
+  : dataPtr(std::make_unique<SkinWeightsPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+SkinWeights::SkinWeights(const std::size_t _vertexCount,
+    const std::size_t _influenceCount)
+  : SkinWeights()
+{
+  auto &d = *this->dataPtr;
+  d.vertexCount = _vertexCount;
+  d.influenceCount = _influenceCount;
+  d.bones.assign(_vertexCount * _influenceCount, 0);
+  d.weights.assign(_vertexCount * _influenceCount, 0.0);
+  d.UpdateBoneCount();
+}
+
+/////////////////////////////////////////////////
+SkinWeights::SkinWeights(const SkinWeights &_weights)
+  : dataPtr(std::make_unique<SkinWeightsPrivate>(*_weights.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+SkinWeights::~SkinWeights() = default;
+
+/////////////////////////////////////////////////
+SkinWeights &SkinWeights::operator=(const SkinWeights &_weights)
+{
+  *this->dataPtr = *_weights.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+bool SkinWeights::Set(const std::vector<uint32_t> &_bones,
+    const std::vector<double> &_weights, const std::size_t _influenceCount)
+{
+  if (_influenceCount == 0 || _bones.size() != _weights.size() ||
+      _bones.size() % _influenceCount != 0)
+  {
+    IGN_MATH_DIAGNOSTIC("SkinWeights::Set() error: expected the same number of "
+        << "bones and weights, a multiple of the number of influences ["
+        << _influenceCount << "], got [" << _bones.size() << "] and ["
+        << _weights.size() << "].");
+    return false;
+  }
+
+  auto &d = *this->dataPtr;
+  d.influenceCount = _influenceCount;
+  d.vertexCount = _bones.size() / _influenceCount;
+  d.bones.resize(_bones.size());
+  d.weights.resize(_weights.size());
+  for (std::size_t v = 0; v < d.vertexCount; ++v)
+  {
+    for (std::size_t k = 0; k < _influenceCount; ++k)
+    {
+      d.bones[k * d.vertexCount + v] = _bones[v * _influenceCount + k];
+      d.weights[k * d.vertexCount + v] = _weights[v * _influenceCount + k];
+    }
+  }
+  d.UpdateBoneCount();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SkinWeights::SetInfluence(const std::size_t _vertex,
+    const std::size_t _influence, const uint32_t _bone, const double _weight)
+{
+  auto &d = *this->dataPtr;
+  if (_vertex >= d.vertexCount || _influence >= d.influenceCount)
+    return false;
+
+  const std::size_t index = _influence * d.vertexCount + _vertex;
+  const uint32_t previous = d.bones[index];
+  d.bones[index] = _bone;
+  d.weights[index] = _weight;
+  if (_bone >= d.boneCount)
+    d.boneCount = static_cast<std::size_t>(_bone) + 1;
+  else if (previous + std::size_t{1} == d.boneCount)
+    d.UpdateBoneCount();
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::size_t SkinWeights::VertexCount() const
+{
+  return this->dataPtr->vertexCount;
+}
+
+/////////////////////////////////////////////////
+std::size_t SkinWeights::InfluenceCount() const
+{
+  return this->dataPtr->influenceCount;
+}
+
+/////////////////////////////////////////////////
+uint32_t SkinWeights::Bone(const std::size_t _vertex,
+    const std::size_t _influence) const
+{
+  const auto &d = *this->dataPtr;
+  if (_vertex >= d.vertexCount || _influence >= d.influenceCount)
+    return 0;
+  return d.bones[_influence * d.vertexCount + _vertex];
+}
+
+/////////////////////////////////////////////////
+double SkinWeights::Weight(const std::size_t _vertex,
+    const std::size_t _influence) const
+{
+  const auto &d = *this->dataPtr;
+  if (_vertex >= d.vertexCount || _influence >= d.influenceCount)
+    return 0.0;
+  return d.weights[_influence * d.vertexCount + _vertex];
+}
+
+/////////////////////////////////////////////////
+std::size_t SkinWeights::BoneCount() const
+{
+  return this->dataPtr->boneCount;
+}
+
+/////////////////////////////////////////////////
+void SkinWeights::NormalizeWeights()
+{
+  auto &d = *this->dataPtr;
+  std::vector<double> sum(d.vertexCount, 0.0);
+  for (std::size_t k = 0; k < d.influenceCount; ++k)
+  {
+    const double *w = d.weights.data() + k * d.vertexCount;
+    for (std::size_t v = 0; v < d.vertexCount; ++v)
+      sum[v] += w[v];
+  }
+  for (auto &s : sum)
+    s = equal(s, 0.0) ? 1.0 : 1.0 / s;
+  for (std::size_t k = 0; k < d.influenceCount; ++k)
+  {
+    double *w = d.weights.data() + k * d.vertexCount;
+    for (std::size_t v = 0; v < d.vertexCount; ++v)
+      w[v] *= sum[v];
+  }
+}
+
+/////////////////////////////////////////////////
+bool SkinWeights::LinearBlend(const std::vector<Matrix4d> &_transforms,
+    const Vector3SoAd &_rest, Vector3SoAd &_out,
+    const unsigned int _threads) const
+{
+  const auto &d = *this->dataPtr;
+  if (_rest.Size() != d.vertexCount || _transforms.size() < d.boneCount)
+  {
+    IGN_MATH_DIAGNOSTIC("SkinWeights::LinearBlend() error: expected ["
+        << d.vertexCount << "] rest positions and at least ["
+        << d.boneCount << "] transforms, got [" << _rest.Size()
+        << "] and [" << _transforms.size() << "].");
+    return false;
+  }
+
+  std::vector<double> m(12 * _transforms.size());
+  for (std::size_t j = 0; j < _transforms.size(); ++j)
+  {
+    for (std::size_t c = 0; c < 12; ++c)
+      m[12 * j + c] = _transforms[j](c / 4, c % 4);
+  }
+
+  _out.Resize(_rest.Size());
+  ForEachBlock(d.vertexCount, _threads, kMinVerticesPerThread,
+      [&](const std::size_t _begin, const std::size_t _end)
+      {
+        d.LinearBlend(m, _rest, _out, _begin, _end);
+      });
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SkinWeights::DualQuaternionBlend(const std::vector<Pose3d> &_poses,
+    const Vector3SoAd &_rest, Vector3SoAd &_out,
+    const unsigned int _threads) const
+{
+  const auto &d = *this->dataPtr;
+  if (_rest.Size() != d.vertexCount || _poses.size() < d.boneCount)
+  {
+    IGN_MATH_DIAGNOSTIC("SkinWeights::DualQuaternionBlend() error: expected ["
+        << d.vertexCount << "] rest positions and at least ["
+        << d.boneCount << "] poses, got [" << _rest.Size()
+        << "] and [" << _poses.size() << "].");
+    return false;
+  }
+
+  // Unit dual quaternion q + e d of each bone, with d = 0.5 (0, t) q
+  std::vector<double> dq(8 * _poses.size());
+  for (std::size_t j = 0; j < _poses.size(); ++j)
+  {
+    const Quaterniond q = _poses[j].Rot().Normalized();
+    const Vector3d &t = _poses[j].Pos();
+    const Vector3d u(q.X(), q.Y(), q.Z());
+    const Vector3d v = t * q.W() + t.Cross(u);
+    dq[8 * j + 0] = q.W();
+    dq[8 * j + 1] = q.X();
+    dq[8 * j + 2] = q.Y();
+    dq[8 * j + 3] = q.Z();
+    dq[8 * j + 4] = -0.5 * t.Dot(u);
+    dq[8 * j + 5] = 0.5 * v.X();
+    dq[8 * j + 6] = 0.5 * v.Y();
+    dq[8 * j + 7] = 0.5 * v.Z();
+  }
+
+  _out.Resize(_rest.Size());
+  ForEachBlock(d.vertexCount, _threads, kMinVerticesPerThread,
+      [&](const std::size_t _begin, const std::size_t _end)
+      {
+        d.DualQuaternionBlend(dq, _rest, _out, _begin, _end);
+      });
+  return true;
+}
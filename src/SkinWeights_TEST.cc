@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gz/math/SkinWeights.hh"
+
+using namespace gz;
+
+/// \brief Bone poses used by the tests.
+static std::vector<math::Pose3d> TestPoses()
+{
+  return {
+    math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3),
+    math::Pose3d(-1, 0, 0.5, 0, 0, 2.5),
+    math::Pose3d(0, 0, 0, 1.2, -0.4, 0),
+    // Non unit quaternion in the opposite hemisphere of bone 0
+    math::Pose3d(math::Vector3d(0.2, 0.1, 0),
+                 math::Quaterniond(0.1, 0.2, 0.35) * -2.0)};
+}
+
+/// \brief Dual quaternion blending with Quaternion operations.
+static math::Vector3d ReferenceDualQuaternionBlend(
+    const std::vector<math::Pose3d> &_poses,
+    const std::vector<uint32_t> &_bones, const std::vector<double> &_weights,
+    const math::Vector3d &_v)
+{
+  math::Quaterniond real(0, 0, 0, 0), dual(0, 0, 0, 0);
+  const math::Quaterniond pivot = _poses[_bones[0]].Rot().Normalized();
+  for (std::size_t k = 0; k < _bones.size(); ++k)
+  {
+    const math::Pose3d &pose = _poses[_bones[k]];
+    const math::Quaterniond q = pose.Rot().Normalized();
+    const math::Quaterniond t(0, pose.Pos().X(), pose.Pos().Y(),
+                              pose.Pos().Z());
+    const math::Quaterniond d = t * q * 0.5;
+    const double dot = q.W() * pivot.W() + q.X() * pivot.X() +
+      q.Y() * pivot.Y() + q.Z() * pivot.Z();
+    const double w = dot < 0 ? -_weights[k] : _weights[k];
+    real = real + q * w;
+    dual = dual + d * w;
+  }
+  const double len = std::sqrt(real.W() * real.W() + real.X() * real.X() +
+      real.Y() * real.Y() + real.Z() * real.Z());
+  real = real * (1.0 / len);
+  dual = dual * (1.0 / len);
+  const math::Quaterniond t = dual * real.Inverse() * 2.0;
+  return real.RotateVector(_v) + math::Vector3d(t.X(), t.Y(), t.Z());
+}
+
+/////////////////////////////////////////////////
+TEST(SkinWeightsTest, Construct)
+{
+  math::SkinWeights empty;
+  EXPECT_EQ(0u, empty.VertexCount());
+  EXPECT_EQ(0u, empty.InfluenceCount());
+  EXPECT_EQ(0u, empty.BoneCount());
+
+  math::SkinWeights weights(3, 2);
+  EXPECT_EQ(3u, weights.VertexCount());
+  EXPECT_EQ(2u, weights.InfluenceCount());
+  EXPECT_EQ(1u, weights.BoneCount());
+  EXPECT_DOUBLE_EQ(0.0, weights.Weight(2, 1));
+
+  EXPECT_TRUE(weights.SetInfluence(2, 1, 5, 0.25));
+  EXPECT_EQ(5u, weights.Bone(2, 1));
+  EXPECT_DOUBLE_EQ(0.25, weights.Weight(2, 1));
+  EXPECT_EQ(6u, weights.BoneCount());
+  EXPECT_TRUE(weights.SetInfluence(2, 1, 1, 0.25));
+  EXPECT_EQ(2u, weights.BoneCount());
+  EXPECT_FALSE(weights.SetInfluence(3, 0, 0, 1));
+  EXPECT_FALSE(weights.SetInfluence(0, 2, 0, 1));
+  EXPECT_EQ(0u, weights.Bone(3, 0));
+  EXPECT_DOUBLE_EQ(0.0, weights.Weight(0, 2));
+
+  // Rows are given per vertex
+  EXPECT_TRUE(weights.Set({0, 1, 2, 3}, {0.5, 0.5, 1.0, 3.0}, 2));
+  EXPECT_EQ(2u, weights.VertexCount());
+  EXPECT_EQ(4u, weights.BoneCount());
+  EXPECT_EQ(2u, weights.Bone(1, 0));
+  EXPECT_DOUBLE_EQ(3.0, weights.Weight(1, 1));
+
+  weights.NormalizeWeights();
+  EXPECT_DOUBLE_EQ(0.5, weights.Weight(0, 0));
+  EXPECT_DOUBLE_EQ(0.25, weights.Weight(1, 0));
+  EXPECT_DOUBLE_EQ(0.75, weights.Weight(1, 1));
+
+  math::SkinWeights copy(weights);
+  EXPECT_EQ(2u, copy.Bone(1, 0));
+  copy = empty;
+  EXPECT_EQ(0u, copy.VertexCount());
+
+  // Errors
+  EXPECT_FALSE(weights.Set({0, 1, 2}, {0.5, 0.5}, 1));
+  EXPECT_FALSE(weights.Set({0, 1, 2}, {0.5, 0.5, 0.5}, 2));
+  EXPECT_FALSE(weights.Set({0, 1}, {0.5, 0.5}, 0));
+  EXPECT_EQ(2u, weights.VertexCount());
+}
+
+/////////////////////////////////////////////////
+TEST(SkinWeightsTest, LinearBlend)
+{
+  const std::vector<math::Pose3d> poses = TestPoses();
+  std::vector<math::Matrix4d> transforms;
+  for (const auto &pose : poses)
+    transforms.push_back(math::Matrix4d(pose));
+
+  // More vertices than a block, three influences each, the last vertex
+  // without weights
+  const std::size_t count = 150;
+  std::vector<uint32_t> bones;
+  std::vector<double> w;
+  std::vector<math::Vector3d> rest;
+  for (std::size_t v = 0; v < count; ++v)
+  {
+    for (uint32_t k = 0; k < 3; ++k)
+    {
+      bones.push_back(static_cast<uint32_t>((v + k) % poses.size()));
+      w.push_back(v + 1 == count ? 0.0 : 0.1 + 0.2 * k + 0.001 * v);
+    }
+    rest.push_back(math::Vector3d(0.1 * v, 1.0 - 0.02 * v, 0.5));
+  }
+
+  math::SkinWeights weights;
+  ASSERT_TRUE(weights.Set(bones, w, 3));
+  math::Vector3SoAd restSoA(rest);
+  math::Vector3SoAd out;
+  ASSERT_TRUE(weights.LinearBlend(transforms, restSoA, out));
+  ASSERT_EQ(count, out.Size());
+  for (std::size_t v = 0; v < count; ++v)
+  {
+    math::Vector3d expected;
+    for (std::size_t k = 0; k < 3; ++k)
+      expected += (transforms[bones[3 * v + k]] * rest[v]) * w[3 * v + k];
+    if (v + 1 == count)
+      expected = rest[v];
+    EXPECT_TRUE(expected.Equal(out[v], 1e-12)) << v;
+  }
+
+  // A single bone with full weight is the bone transform
+  math::SkinWeights single(count, 1);
+  for (std::size_t v = 0; v < count; ++v)
+    single.SetInfluence(v, 0, 1, 1.0);
+  ASSERT_TRUE(single.LinearBlend(transforms, restSoA, out));
+  for (std::size_t v = 0; v < count; ++v)
+    EXPECT_TRUE(poses[1].CoordPositionAdd(rest[v]).Equal(out[v], 1e-12));
+
+  // In place, with threads
+  math::Vector3SoAd inPlace(restSoA);
+  ASSERT_TRUE(single.LinearBlend(transforms, inPlace, inPlace, 0));
+  EXPECT_EQ(out, inPlace);
+
+  // Errors
+  EXPECT_FALSE(weights.LinearBlend({transforms[0]}, restSoA, out));
+  EXPECT_FALSE(weights.LinearBlend(transforms, math::Vector3SoAd(3), out));
+}
+
+/////////////////////////////////////////////////
+TEST(SkinWeightsTest, DualQuaternionBlend)
+{
+  const std::vector<math::Pose3d> poses = TestPoses();
+
+  const std::size_t count = 150;
+  std::vector<uint32_t> bones;
+  std::vector<double> w;
+  std::vector<math::Vector3d> rest;
+  for (std::size_t v = 0; v < count; ++v)
+  {
+    for (uint32_t k = 0; k < 2; ++k)
+    {
+      bones.push_back(static_cast<uint32_t>((v + 3 * k) % poses.size()));
+      w.push_back(v + 1 == count ? 0.0 : (k == 0 ? 0.7 : 0.3));
+    }
+    rest.push_back(math::Vector3d(0.1 * v, 1.0 - 0.02 * v, 0.5));
+  }
+
+  math::SkinWeights weights;
+  ASSERT_TRUE(weights.Set(bones, w, 2));
+  math::Vector3SoAd restSoA(rest);
+  math::Vector3SoAd out;
+  ASSERT_TRUE(weights.DualQuaternionBlend(poses, restSoA, out));
+  ASSERT_EQ(count, out.Size());
+  for (std::size_t v = 0; v + 1 < count; ++v)
+  {
+    const math::Vector3d expected = ReferenceDualQuaternionBlend(poses,
+        {bones[2 * v], bones[2 * v + 1]}, {w[2 * v], w[2 * v + 1]},
+        rest[v]);
+    EXPECT_TRUE(expected.Equal(out[v], 1e-12)) << v;
+  }
+  EXPECT_EQ(rest[count - 1], out[count - 1]);
+
+  // A single bone is the rigid transform of the bone
+  math::SkinWeights single(count, 1);
+  for (std::size_t v = 0; v < count; ++v)
+    single.SetInfluence(v, 0, 3, 1.0);
+  ASSERT_TRUE(single.DualQuaternionBlend(poses, restSoA, out));
+  for (std::size_t v = 0; v < count; ++v)
+    EXPECT_TRUE(poses[3].CoordPositionAdd(rest[v]).Equal(out[v], 1e-12));
+
+  // Blending a rotation with itself, the translation is interpolated
+  const math::Quaterniond rot(0.3, -0.2, 0.9);
+  math::SkinWeights pair(1, 2);
+  pair.SetInfluence(0, 0, 0, 0.25);
+  pair.SetInfluence(0, 1, 1, 0.75);
+  math::Vector3SoAd point(std::vector<math::Vector3d>{{1, 2, 3}});
+  ASSERT_TRUE(pair.DualQuaternionBlend(
+      {math::Pose3d(math::Vector3d(4, 0, 0), rot),
+       math::Pose3d(math::Vector3d(0, 8, 0), rot)}, point, point, 0));
+  EXPECT_TRUE(point[0].Equal(
+      rot.RotateVector(math::Vector3d(1, 2, 3)) + math::Vector3d(1, 6, 0),
+      1e-12));
+
+  // Errors
+  EXPECT_FALSE(weights.DualQuaternionBlend({poses[0]}, restSoA, out));
+  EXPECT_FALSE(weights.DualQuaternionBlend(poses, math::Vector3SoAd(3),
+      out));
+}
+
+/////////////////////////////////////////////////
+TEST(SkinWeightsTest, Threads)
+{
+  const std::vector<math::Pose3d> poses = TestPoses();
+  std::vector<math::Matrix4d> transforms;
+  for (const auto &pose : poses)
+    transforms.push_back(math::Matrix4d(pose));
+
+  // Large enough to be split between threads
+  const std::size_t count = 20000;
+  math::SkinWeights weights(count, 2);
+  std::vector<math::Vector3d> rest;
+  for (std::size_t v = 0; v < count; ++v)
+  {
+    weights.SetInfluence(v, 0, static_cast<uint32_t>(v % 4), 0.6);
+    weights.SetInfluence(v, 1, static_cast<uint32_t>((v / 4) % 4), 0.4);
+    rest.push_back(math::Vector3d(0.001 * v, 1.0, -0.002 * v));
+  }
+  math::Vector3SoAd restSoA(rest);
+
+  math::Vector3SoAd single, multi;
+  ASSERT_TRUE(weights.LinearBlend(transforms, restSoA, single, 1));
+  ASSERT_TRUE(weights.LinearBlend(transforms, restSoA, multi, 4));
+  EXPECT_EQ(single, multi);
+
+  ASSERT_TRUE(weights.DualQuaternionBlend(poses, restSoA, single, 1));
+  ASSERT_TRUE(weights.DualQuaternionBlend(poses, restSoA, multi, 4));
+  EXPECT_EQ(single, multi);
+}
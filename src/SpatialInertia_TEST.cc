@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gz/math/SpatialInertia.hh"
+
+using namespace gz;
+
+/// \brief Multiply two 6x6 matrices.
+static math::Matrix6d Multiply(const math::Matrix6d &_a,
+    const math::Matrix6d &_b)
+{
+  math::Matrix6d result;
+  for (std::size_t i = 0; i < 6; ++i)
+  {
+    for (std::size_t j = 0; j < 6; ++j)
+    {
+      double sum = 0;
+      for (std::size_t k = 0; k < 6; ++k)
+        sum += _a(i, k) * _b(k, j);
+      result(i, j) = sum;
+    }
+  }
+  return result;
+}
+
+/// \brief Multiply a spatial vector by a 6x6 matrix.
+static math::SpatialVectord Multiply(const math::Matrix6d &_m,
+    const math::SpatialVectord &_v)
+{
+  const double in[6] = {_v.Angular().X(), _v.Angular().Y(), _v.Angular().Z(),
+                        _v.Linear().X(), _v.Linear().Y(), _v.Linear().Z()};
+  double out[6] = {0, 0, 0, 0, 0, 0};
+  for (std::size_t i = 0; i < 6; ++i)
+  {
+    for (std::size_t j = 0; j < 6; ++j)
+      out[i] += _m(i, j) * in[j];
+  }
+  return math::SpatialVectord(math::Vector3d(out[0], out[1], out[2]),
+                              math::Vector3d(out[3], out[4], out[5]));
+}
+
+/// \brief Get the inertial of a box offset from its frame.
+static math::Inertiald BoxInertial()
+{
+  math::MassMatrix3d massMatrix;
+  massMatrix.SetFromBox(2.5, math::Vector3d(0.4, 1, 0.2));
+  return math::Inertiald(massMatrix,
+                         math::Pose3d(0.3, -0.5, 1.2, 0.4, -0.1, 0.9));
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialInertiaTest, Construct)
+{
+  const math::SpatialInertiad zero;
+  EXPECT_DOUBLE_EQ(0.0, zero.Mass());
+  EXPECT_EQ(math::Vector3d::Zero, zero.CenterOfMass());
+  EXPECT_EQ(math::Matrix6d::Zero, zero.Matrix());
+
+  math::MassMatrix3d massMatrix;
+  massMatrix.SetFromBox(2.5, math::Vector3d(0.4, 1, 0.2));
+  const math::SpatialInertiad atCenter(massMatrix);
+  EXPECT_DOUBLE_EQ(2.5, atCenter.Mass());
+  EXPECT_EQ(math::Vector3d::Zero, atCenter.FirstMoment());
+  EXPECT_EQ(massMatrix.Moi(), atCenter.RotationalInertia());
+
+  const math::Inertiald inertial = BoxInertial();
+  const math::SpatialInertiad spatial(inertial);
+  EXPECT_DOUBLE_EQ(2.5, spatial.Mass());
+  EXPECT_TRUE(spatial.CenterOfMass().Equal(inertial.Pose().Pos(), 1e-12));
+  EXPECT_TRUE(spatial.Moi().Equal(inertial.Moi(), 1e-12));
+
+  // Parallel axis theorem about the origin
+  const math::Vector3d c = inertial.Pose().Pos();
+  const math::Matrix3d cx(0, -c.Z(), c.Y(), c.Z(), 0, -c.X(), -c.Y(), c.X(),
+                          0);
+  EXPECT_TRUE(spatial.RotationalInertia().Equal(
+      inertial.Moi() + cx * cx.Transposed() * 2.5, 1e-12));
+
+  // Momentum of the body matches the 6x6 matrix, and the linear momentum
+  // is the mass times the velocity of the center of mass
+  const math::SpatialVectord twist(math::Vector3d(0.3, -1, 0.5),
+                                   math::Vector3d(1, 2, -0.5));
+  const math::SpatialVectord momentum = spatial * twist;
+  EXPECT_TRUE(momentum.Equal(Multiply(spatial.Matrix(), twist), 1e-12));
+  EXPECT_TRUE(momentum.Linear().Equal(
+      (twist.Linear() + twist.Angular().Cross(c)) * 2.5, 1e-12));
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialInertiaTest, Transform)
+{
+  const math::SpatialInertiad inertia(BoxInertial());
+  const math::SpatialTransformd x(math::Pose3d(1, -2, 0.5, 0.3, -0.2, 1.1));
+  const double tol = 1e-12;
+
+  // X* I X^-1
+  const math::SpatialInertiad inB = inertia.Transform(x);
+  const math::Matrix6d expected = Multiply(x.ForceMatrix(),
+      Multiply(inertia.Matrix(), x.Inverse().MotionMatrix()));
+  EXPECT_TRUE(inB.Matrix().Equal(expected, tol));
+  EXPECT_DOUBLE_EQ(inertia.Mass(), inB.Mass());
+
+  // X^T I X, and the round trip
+  const math::SpatialInertiad inA = inB.InverseTransform(x);
+  EXPECT_TRUE(inA.Equal(inertia, tol));
+  EXPECT_TRUE(inB.InverseTransform(x).Equal(
+      inB.Transform(x.Inverse()), tol));
+
+  // Kinetic energy does not depend on the frame
+  const math::SpatialVectord twist(math::Vector3d(0.3, -1, 0.5),
+                                   math::Vector3d(1, 2, -0.5));
+  const math::SpatialVectord twistB = x.ApplyMotion(twist);
+  EXPECT_NEAR(twist.Dot(inertia * twist), twistB.Dot(inB * twistB), tol);
+
+  // The inertia of a frame relative to itself is unchanged
+  EXPECT_TRUE(inertia.Transform(math::SpatialTransformd()).Equal(
+      inertia, tol));
+
+  // A rigidly attached composite transforms as its parts
+  const math::SpatialInertiad other(1.5, math::Vector3d(-1, 0, 2),
+                                    math::Matrix3d(0.1, 0, 0, 0, 0.2, 0,
+                                                   0, 0, 0.3));
+  EXPECT_TRUE((inertia + other).Transform(x).Equal(
+      inB + other.Transform(x), tol));
+  EXPECT_DOUBLE_EQ(4.0, (inertia + other).Mass());
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialInertiaTest, Batch)
+{
+  std::vector<math::Inertiald> inertials;
+  std::vector<math::SpatialTransformd> transforms;
+  for (int i = 0; i < 10; ++i)
+  {
+    math::MassMatrix3d massMatrix;
+    massMatrix.SetFromBox(1 + i, math::Vector3d(0.1 * (i + 1), 0.5, 1));
+    inertials.emplace_back(massMatrix,
+        math::Pose3d(0.1 * i, 1, -0.2 * i, 0.3 * i, 0, -0.1 * i));
+    transforms.emplace_back(math::Pose3d(i, -1, 0.5, 0, 0.2 * i, 0.1));
+  }
+
+  std::vector<math::SpatialInertiad> spatial(inertials.size());
+  math::SpatialInertiad::FromInertials(inertials.data(), inertials.size(),
+                                       spatial.data());
+  std::vector<math::SpatialInertiad> transformed(inertials.size());
+  math::SpatialInertiad::Transform(transforms.data(), spatial.data(),
+                                   spatial.size(), transformed.data());
+  for (std::size_t i = 0; i < inertials.size(); ++i)
+  {
+    const math::SpatialInertiad single(inertials[i]);
+    EXPECT_TRUE(single.Equal(spatial[i], 0));
+    EXPECT_TRUE(single.Transform(transforms[i]).Equal(transformed[i], 0));
+  }
+
+  // In place
+  math::SpatialInertiad::Transform(transforms.data(), spatial.data(),
+                                   spatial.size(), spatial.data());
+  for (std::size_t i = 0; i < spatial.size(); ++i)
+    EXPECT_TRUE(spatial[i].Equal(transformed[i], 0));
+}
@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Executor.hh"
+#include "gz/math/SpatialSort.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Minimum number of elements processed by each thread.
+  const std::size_t kMinPerThread = 16384;
+
+  /// \brief Number of bits of a radix sort digit.
+  const unsigned int kDigitBits = 11;
+
+  /// \brief Number of values of a radix sort digit.
+  const std::size_t kBuckets = std::size_t(1) << kDigitBits;
+
+  /// \brief Key of the elements that sort last.
+  const uint64_t kLastKey = std::numeric_limits<uint64_t>::max();
+
+  /// \brief Largest cell coordinate of a key.
+  const uint32_t kMaxCell = (1u << kCurveBits) - 1;
+
+  //////////////////////////////////////////////////
+  /// \brief Get the executor running the parts of an array, and the
+  /// number of parts.
+  /// \param[in] _threads Requested number of threads, 0 for hardware
+  /// threads.
+  /// \param[in] _count Number of elements.
+  /// \param[out] _local Thread pool created for the call, if any.
+  /// \param[out] _parts Number of parts.
+  /// \return The executor.
+  Executor &PartExecutor(const unsigned int _threads,
+      const std::size_t _count, std::unique_ptr<Executor> &_local,
+      std::size_t &_parts)
+  {
+    static SerialExecutor serial;
+
+    std::size_t threads = _threads;
+    if (threads == 0)
+      threads = std::thread::hardware_concurrency();
+    _parts = std::max<std::size_t>(1,
+        std::min(threads, _count / kMinPerThread));
+    if (_parts <= 1)
+      return serial;
+    _local.reset(new ThreadPool(static_cast<unsigned int>(_parts)));
+    return *_local;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Maps points to the cells of a grid of 2^kCurveBits cells per
+  /// axis over a box.
+  class CellMapper
+  {
+    /// \brief Constructor.
+    /// \param[in] _bounds The box.
+    public: explicit CellMapper(const AxisAlignedBox &_bounds)
+      : min(_bounds.Min())
+    {
+      const Vector3d extent = _bounds.Max() - _bounds.Min();
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        this->scale[axis] = extent[axis] > 0 ?
+            static_cast<double>(kMaxCell + 1) / extent[axis] : 0.0;
+      }
+    }
+
+    /// \brief Get the cell of a point, clamped to the grid.
+    /// \param[in] _point The point.
+    /// \param[out] _cell The cell coordinates.
+    public: void Cell(const Vector3d &_point, uint32_t (&_cell)[3]) const
+    {
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        const double q = (_point[axis] - this->min[axis]) *
+            this->scale[axis];
+        if (!(q > 0))
+          _cell[axis] = 0;
+        else if (q >= kMaxCell)
+          _cell[axis] = kMaxCell;
+        else
+          _cell[axis] = static_cast<uint32_t>(q);
+      }
+    }
+
+    /// \brief Get the key of a point.
+    /// \param[in] _point The point.
+    /// \param[in] _curve The curve.
+    /// \return The key.
+    public: uint64_t Key(const Vector3d &_point,
+                         const SpaceFillingCurve _curve) const
+    {
+      uint32_t c[3];
+      this->Cell(_point, c);
+      return _curve == SpaceFillingCurve::HILBERT ?
+          HilbertEncode(c[0], c[1], c[2]) : MortonEncode(c[0], c[1], c[2]);
+    }
+
+    /// \brief Minimum corner of the box.
+    private: Vector3d min;
+
+    /// \brief Number of cells per unit of length along each axis.
+    private: Vector3d scale;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Compute keys in parallel.
+  /// \param[in] _count Number of keys.
+  /// \param[in] _threads Number of threads, 0 for hardware threads.
+  /// \param[in] _key Function returning the key of an element.
+  /// \param[out] _keys The keys.
+  template<typename KeyFunction>
+  void ComputeKeys(const std::size_t _count, const unsigned int _threads,
+                   const KeyFunction &_key, std::vector<uint64_t> &_keys)
+  {
+    _keys.resize(_count);
+    std::unique_ptr<Executor> local;
+    std::size_t parts = 1;
+    Executor &executor = PartExecutor(_threads, _count, local, parts);
+    executor.ForEachBlock(_count, parts,
+      [&](const std::size_t _begin, const std::size_t _end, std::size_t)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+          _keys[i] = _key(i);
+      });
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Reorder an array.
+  /// \param[in,out] _values The array.
+  /// \param[in] _order Original index of each element.
+  template<typename T>
+  void Permute(std::vector<T> &_values, const std::vector<std::size_t> &_order)
+  {
+    std::vector<T> sorted;
+    sorted.reserve(_values.size());
+    for (const std::size_t index : _order)
+      sorted.push_back(std::move(_values[index]));
+    _values = std::move(sorted);
+  }
+}
+
+/////////////////////////////////////////////////
+uint64_t math::CurveKey(const Vector3d &_point,
+    const AxisAlignedBox &_bounds, const SpaceFillingCurve _curve)
+{
+  return CellMapper(_bounds).Key(_point, _curve);
+}
+
+/////////////////////////////////////////////////
+Vector3d math::CurvePoint(const uint64_t _key,
+    const AxisAlignedBox &_bounds, const SpaceFillingCurve _curve)
+{
+  const auto cell = _curve == SpaceFillingCurve::HILBERT ?
+      HilbertDecode(_key) : MortonDecode(_key);
+  const Vector3d c(std::get<0>(cell), std::get<1>(cell), std::get<2>(cell));
+  const Vector3d extent = _bounds.Max() - _bounds.Min();
+  return _bounds.Min() +
+      (c + Vector3d(0.5, 0.5, 0.5)) * extent / (kMaxCell + 1.0);
+}
+
+/////////////////////////////////////////////////
+void math::CurveKeys(const std::vector<Vector3d> &_points,
+    const AxisAlignedBox &_bounds, const SpaceFillingCurve _curve,
+    std::vector<uint64_t> &_keys, const unsigned int _threads)
+{
+  const CellMapper mapper(_bounds);
+  ComputeKeys(_points.size(), _threads,
+    [&](const std::size_t _i)
+    {
+      return _points[_i].IsFinite() ?
+          mapper.Key(_points[_i], _curve) : kLastKey;
+    }, _keys);
+}
+
+/////////////////////////////////////////////////
+void math::RadixSort(std::vector<uint64_t> &_keys,
+    std::vector<std::size_t> &_order, const unsigned int _threads)
+{
+  const std::size_t count = _keys.size();
+  _order.resize(count);
+  std::iota(_order.begin(), _order.end(), std::size_t(0));
+  if (count < 2)
+    return;
+
+  // Bits that differ between keys
+  uint64_t any = 0;
+  uint64_t all = kLastKey;
+  for (const uint64_t key : _keys)
+  {
+    any |= key;
+    all &= key;
+  }
+  const uint64_t varying = any ^ all;
+
+  std::unique_ptr<Executor> local;
+  std::size_t parts = 1;
+  Executor &executor = PartExecutor(_threads, count, local, parts);
+
+  // Each part counts its digits, then moves its keys after those of the
+  // lower digits and of the previous parts with the same digit, which
+  // keeps the sort stable.
+  std::vector<std::size_t> offsets(parts * kBuckets);
+  std::vector<uint64_t> keys(count);
+  std::vector<std::size_t> order(count);
+  for (unsigned int shift = 0; shift < 64; shift += kDigitBits)
+  {
+    if (((varying >> shift) & (kBuckets - 1)) == 0)
+      continue;
+
+    executor.ForEachBlock(count, parts,
+      [&](const std::size_t _begin, const std::size_t _end,
+          const std::size_t _part)
+      {
+        std::size_t *counts = &offsets[_part * kBuckets];
+        std::fill(counts, counts + kBuckets, 0);
+        for (std::size_t i = _begin; i < _end; ++i)
+          ++counts[(_keys[i] >> shift) & (kBuckets - 1)];
+      });
+
+    std::size_t sum = 0;
+    for (std::size_t digit = 0; digit < kBuckets; ++digit)
+    {
+      for (std::size_t part = 0; part < parts; ++part)
+      {
+        const std::size_t n = offsets[part * kBuckets + digit];
+        offsets[part * kBuckets + digit] = sum;
+        sum += n;
+      }
+    }
+
+    executor.ForEachBlock(count, parts,
+      [&](const std::size_t _begin, const std::size_t _end,
+          const std::size_t _part)
+      {
+        std::size_t *next = &offsets[_part * kBuckets];
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const std::size_t dst =
+              next[(_keys[i] >> shift) & (kBuckets - 1)]++;
+          keys[dst] = _keys[i];
+          order[dst] = _order[i];
+        }
+      });
+    std::swap(keys, _keys);
+    std::swap(order, _order);
+  }
+}
+
+/////////////////////////////////////////////////
+void math::SpatialSort(std::vector<Vector3d> &_points,
+    std::vector<std::size_t> &_order, const SpaceFillingCurve _curve,
+    const unsigned int _threads)
+{
+  Vector3d min(std::numeric_limits<double>::max(),
+               std::numeric_limits<double>::max(),
+               std::numeric_limits<double>::max());
+  Vector3d max = -min;
+  for (const Vector3d &point : _points)
+  {
+    if (point.IsFinite())
+    {
+      min.Min(point);
+      max.Max(point);
+    }
+  }
+
+  std::vector<uint64_t> keys;
+  CurveKeys(_points, AxisAlignedBox(min, max), _curve, keys, _threads);
+  RadixSort(keys, _order, _threads);
+  Permute(_points, _order);
+}
+
+/////////////////////////////////////////////////
+void math::SpatialSort(std::vector<AxisAlignedBox> &_boxes,
+    std::vector<std::size_t> &_order, const SpaceFillingCurve _curve,
+    const unsigned int _threads)
+{
+  // Centers of the boxes that are not empty
+  std::vector<Vector3d> centers(_boxes.size());
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  for (std::size_t i = 0; i < _boxes.size(); ++i)
+  {
+    const Vector3d &boxMin = _boxes[i].Min();
+    const Vector3d &boxMax = _boxes[i].Max();
+    if (boxMin.X() <= boxMax.X() && boxMin.Y() <= boxMax.Y() &&
+        boxMin.Z() <= boxMax.Z())
+    {
+      centers[i] = 0.5 * boxMin + 0.5 * boxMax;
+    }
+    else
+    {
+      centers[i].Set(nan, nan, nan);
+    }
+  }
+
+  SpatialSort(centers, _order, _curve, _threads);
+  Permute(_boxes, _order);
+}
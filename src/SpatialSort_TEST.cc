@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Rand.hh"
+#include "gz/math/SpatialSort.hh"
+
+using namespace gz;
+using namespace math;
+
+// Codes are usable in constant expressions
+static_assert(MortonEncode(1, 0, 0) == 1u, "x is the lowest bit");
+static_assert(MortonEncode(0, 1, 0) == 2u, "y is the middle bit");
+static_assert(MortonEncode(0, 0, 1) == 4u, "z is the highest bit");
+static_assert(std::get<2>(MortonDecode(MortonEncode(3, 5, 7))) == 7u,
+              "Morton round trip");
+static_assert(std::get<0>(HilbertDecode(HilbertEncode(9, 4, 1))) == 9u,
+              "Hilbert round trip");
+
+/////////////////////////////////////////////////
+TEST(SpatialSortTest, Morton)
+{
+  const uint32_t max = (1u << kCurveBits) - 1;
+  EXPECT_EQ(0u, MortonEncode(0, 0, 0));
+  EXPECT_EQ((uint64_t(1) << 63) - 1, MortonEncode(max, max, max));
+  EXPECT_EQ(0x1249249249249249ull, MortonEncode(max, 0, 0));
+  EXPECT_EQ(56u, MortonEncode(2, 2, 2));
+
+  Rand::Seed(5);
+  for (int i = 0; i < 1000; ++i)
+  {
+    const uint32_t x = Rand::IntUniform(0, max);
+    const uint32_t y = Rand::IntUniform(0, max);
+    const uint32_t z = Rand::IntUniform(0, max);
+    const uint64_t code = MortonEncode(x, y, z);
+    EXPECT_EQ(std::make_tuple(x, y, z), MortonDecode(code));
+
+    // Same result as the portable code used in constant expressions
+    const uint64_t portable = detail::MortonSpread(x) |
+        (detail::MortonSpread(y) << 1) | (detail::MortonSpread(z) << 2);
+    EXPECT_EQ(portable, code);
+    EXPECT_EQ(x, detail::MortonCompact(code));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialSortTest, Hilbert)
+{
+  EXPECT_EQ(0u, HilbertEncode(0, 0, 0));
+
+  // Consecutive indices are adjacent cells, and every cell of a small
+  // grid is visited once.
+  const uint32_t side = 1u << kCurveBits;
+  std::vector<bool> seen(512, false);
+  auto previous = HilbertDecode(0);
+  for (uint64_t index = 1; index < 4096; ++index)
+  {
+    const auto cell = HilbertDecode(index);
+    const int dx = std::abs(static_cast<int>(std::get<0>(cell)) -
+        static_cast<int>(std::get<0>(previous)));
+    const int dy = std::abs(static_cast<int>(std::get<1>(cell)) -
+        static_cast<int>(std::get<1>(previous)));
+    const int dz = std::abs(static_cast<int>(std::get<2>(cell)) -
+        static_cast<int>(std::get<2>(previous)));
+    EXPECT_EQ(1, dx + dy + dz) << index;
+    EXPECT_EQ(index, HilbertEncode(std::get<0>(cell), std::get<1>(cell),
+                                   std::get<2>(cell)));
+    previous = cell;
+  }
+  for (uint64_t index = 0; index < 512; ++index)
+  {
+    const auto cell = HilbertDecode(index);
+    ASSERT_LT(std::get<0>(cell), 8u);
+    ASSERT_LT(std::get<1>(cell), 8u);
+    ASSERT_LT(std::get<2>(cell), 8u);
+    const uint32_t flat = std::get<0>(cell) + 8 * std::get<1>(cell) +
+        64 * std::get<2>(cell);
+    EXPECT_FALSE(seen[flat]);
+    seen[flat] = true;
+  }
+
+  Rand::Seed(7);
+  for (int i = 0; i < 1000; ++i)
+  {
+    const uint32_t x = Rand::IntUniform(0, side - 1);
+    const uint32_t y = Rand::IntUniform(0, side - 1);
+    const uint32_t z = Rand::IntUniform(0, side - 1);
+    EXPECT_EQ(std::make_tuple(x, y, z), HilbertDecode(HilbertEncode(x, y, z)));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialSortTest, CurveKey)
+{
+  const AxisAlignedBox box(Vector3d(-1, -2, -3), Vector3d(1, 2, 3));
+  for (auto curve : {SpaceFillingCurve::MORTON, SpaceFillingCurve::HILBERT})
+  {
+    EXPECT_EQ(0u, CurveKey(box.Min(), box, curve));
+    const Vector3d corner = CurvePoint(CurveKey(box.Max(), box, curve),
+        box, curve);
+    EXPECT_TRUE(corner.Equal(box.Max(), 1e-5));
+
+    // Points round trip up to the size of a cell, and are clamped
+    const Vector3d point(0.3, -1.7, 2.2);
+    EXPECT_TRUE(point.Equal(
+        CurvePoint(CurveKey(point, box, curve), box, curve), 1e-5));
+    EXPECT_EQ(CurveKey(box.Max(), box, curve),
+              CurveKey(Vector3d(5, 5, 5), box, curve));
+    EXPECT_EQ(0u, CurveKey(Vector3d(-5, -5, -5), box, curve));
+  }
+
+  // Flat boxes map every point of the flat axis to the first cell
+  const AxisAlignedBox flat(Vector3d(0, 0, 0), Vector3d(1, 1, 0));
+  EXPECT_EQ(CurveKey(Vector3d(1, 1, 0), flat),
+            CurveKey(Vector3d(1, 1, 7), flat));
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<uint64_t> keys;
+  CurveKeys({Vector3d(nan, 0, 0), box.Min()}, box,
+            SpaceFillingCurve::MORTON, keys);
+  ASSERT_EQ(2u, keys.size());
+  EXPECT_EQ(std::numeric_limits<uint64_t>::max(), keys[0]);
+  EXPECT_EQ(0u, keys[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialSortTest, RadixSort)
+{
+  std::vector<uint64_t> keys;
+  std::vector<std::size_t> order{4};
+  RadixSort(keys, order);
+  EXPECT_TRUE(order.empty());
+
+  // Small keys, with many duplicates to check that the sort is stable,
+  // and large keys that use every digit.
+  for (uint64_t range : {uint64_t(100), std::numeric_limits<uint64_t>::max()})
+  {
+    Rand::Seed(11);
+    std::vector<uint64_t> input(100000);
+    for (uint64_t &key : input)
+    {
+      key = (static_cast<uint64_t>(Rand::IntUniform(0, 1 << 30)) << 34) ^
+          static_cast<uint64_t>(Rand::IntUniform(0, 1 << 30));
+      key %= range;
+    }
+
+    std::vector<std::size_t> expected(input.size());
+    std::iota(expected.begin(), expected.end(), std::size_t(0));
+    std::stable_sort(expected.begin(), expected.end(),
+        [&](std::size_t _a, std::size_t _b)
+        {
+          return input[_a] < input[_b];
+        });
+
+    for (unsigned int threads : {1u, 0u, 4u})
+    {
+      keys = input;
+      RadixSort(keys, order, threads);
+      EXPECT_EQ(expected, order) << threads;
+      EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+      for (std::size_t i = 0; i < keys.size(); ++i)
+        ASSERT_EQ(input[order[i]], keys[i]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialSortTest, SpatialSortPoints)
+{
+  Rand::Seed(13);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<Vector3d> input;
+  for (int i = 0; i < 40000; ++i)
+  {
+    input.push_back(Vector3d(Rand::DblUniform(-10, 10),
+        Rand::DblUniform(-10, 10), Rand::DblUniform(0, 1)));
+  }
+  input[17].Set(nan, 0, 0);
+
+  for (auto curve : {SpaceFillingCurve::MORTON, SpaceFillingCurve::HILBERT})
+  {
+    std::vector<Vector3d> points = input;
+    std::vector<std::size_t> order;
+    SpatialSort(points, order, curve);
+    ASSERT_EQ(input.size(), order.size());
+    EXPECT_EQ(17u, order.back());
+    EXPECT_TRUE(std::isnan(points.back().X()));
+    for (std::size_t i = 0; i + 1 < points.size(); ++i)
+      ASSERT_EQ(input[order[i]], points[i]);
+
+    // Sorted points are much closer to each other than shuffled ones
+    double sortedGap = 0;
+    double inputGap = 0;
+    for (std::size_t i = 0; i + 2 < points.size(); ++i)
+    {
+      sortedGap += points[i].Distance(points[i + 1]);
+      if (input[i].IsFinite() && input[i + 1].IsFinite())
+        inputGap += input[i].Distance(input[i + 1]);
+    }
+    EXPECT_LT(sortedGap * 10, inputGap);
+
+    // Same result with threads
+    std::vector<Vector3d> threadPoints = input;
+    std::vector<std::size_t> threadOrder;
+    SpatialSort(threadPoints, threadOrder, curve, 4);
+    EXPECT_EQ(order, threadOrder);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialSortTest, SpatialSortBoxes)
+{
+  std::vector<AxisAlignedBox> boxes{
+      AxisAlignedBox(Vector3d(9, 9, 9), Vector3d(10, 10, 10)),
+      AxisAlignedBox(),
+      AxisAlignedBox(Vector3d(0, 0, 0), Vector3d(1, 1, 1)),
+      AxisAlignedBox(Vector3d(5, 5, 5), Vector3d(6, 6, 6))};
+  std::vector<std::size_t> order;
+  SpatialSort(boxes, order);
+  const std::vector<std::size_t> expected{2, 3, 0, 1};
+  EXPECT_EQ(expected, order);
+  EXPECT_EQ(Vector3d(0, 0, 0), boxes[0].Min());
+  EXPECT_EQ(Vector3d(10, 10, 10), boxes[2].Max());
+  EXPECT_EQ(AxisAlignedBox(), boxes[3]);
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gz/math/SpatialTransform.hh"
+
+using namespace gz;
+
+/// \brief Multiply a spatial vector by a 6x6 matrix.
+static math::SpatialVectord Multiply(const math::Matrix6d &_m,
+    const math::SpatialVectord &_v)
+{
+  const double in[6] = {_v.Angular().X(), _v.Angular().Y(), _v.Angular().Z(),
+                        _v.Linear().X(), _v.Linear().Y(), _v.Linear().Z()};
+  double out[6] = {0, 0, 0, 0, 0, 0};
+  for (std::size_t i = 0; i < 6; ++i)
+  {
+    for (std::size_t j = 0; j < 6; ++j)
+      out[i] += _m(i, j) * in[j];
+  }
+  return math::SpatialVectord(math::Vector3d(out[0], out[1], out[2]),
+                              math::Vector3d(out[3], out[4], out[5]));
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialTransformTest, Construct)
+{
+  const math::SpatialTransformd identity;
+  EXPECT_EQ(math::Matrix3d::Identity, identity.Rotation());
+  EXPECT_EQ(math::Vector3d::Zero, identity.Translation());
+  EXPECT_EQ(math::Matrix6d::Identity, identity.MotionMatrix());
+  EXPECT_EQ(math::Matrix6d::Identity, identity.ForceMatrix());
+
+  const math::Pose3d pose(1, -2, 0.5, 0.3, -0.2, 1.1);
+  const math::SpatialTransformd x(pose);
+  EXPECT_EQ(pose.Pos(), x.Translation());
+  EXPECT_EQ(math::Matrix3d(pose.Rot()).Transposed(), x.Rotation());
+  EXPECT_EQ(pose, x.Pose());
+
+  // A point fixed in B moves with the twist of B. The linear velocity of a
+  // twist is that of the point at the origin of the frame it is expressed
+  // in, so transforming the twist of a rotation about A's origin gives the
+  // velocity of B's origin.
+  const math::SpatialVectord spin(math::Vector3d(0, 0, 1), math::Vector3d());
+  const math::SpatialVectord inB = x.ApplyMotion(spin);
+  EXPECT_TRUE(inB.Linear().Equal(pose.Rot().RotateVectorReverse(
+      math::Vector3d(0, 0, 1).Cross(pose.Pos())), 1e-12));
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialTransformTest, Apply)
+{
+  const math::SpatialTransformd x(math::Pose3d(1, -2, 0.5, 0.3, -0.2, 1.1));
+  const math::SpatialVectord m(math::Vector3d(-0.4, 0.2, 0.3),
+                               math::Vector3d(0.5, -1, 2));
+  const math::SpatialVectord f(math::Vector3d(2, 0, -1),
+                               math::Vector3d(0.3, 0.6, 0.9));
+  const double tol = 1e-12;
+
+  EXPECT_TRUE(x.ApplyMotion(m).Equal(Multiply(x.MotionMatrix(), m), tol));
+  EXPECT_TRUE(x.ApplyForce(f).Equal(Multiply(x.ForceMatrix(), f), tol));
+
+  // Power does not depend on the frame
+  EXPECT_NEAR(m.Dot(f), x.ApplyMotion(m).Dot(x.ApplyForce(f)), tol);
+
+  // Inverse application
+  EXPECT_TRUE(m.Equal(x.InverseApplyMotion(x.ApplyMotion(m)), tol));
+  EXPECT_TRUE(f.Equal(x.InverseApplyForce(x.ApplyForce(f)), tol));
+  const math::SpatialTransformd inv = x.Inverse();
+  EXPECT_TRUE(inv.ApplyMotion(m).Equal(x.InverseApplyMotion(m), tol));
+  EXPECT_TRUE(inv.ApplyForce(f).Equal(x.InverseApplyForce(f), tol));
+  EXPECT_TRUE((x * inv).Equal(math::SpatialTransformd(), tol));
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialTransformTest, Compose)
+{
+  const math::Pose3d poseAB(1, -2, 0.5, 0.3, -0.2, 1.1);
+  const math::Pose3d poseBC(-0.5, 0.2, 1, 0.9, 0.4, -0.6);
+  const math::SpatialTransformd xAB(poseAB);
+  const math::SpatialTransformd xBC(poseBC);
+  const math::SpatialTransformd xAC = xBC * xAB;
+
+  EXPECT_TRUE(xAC.MotionMatrix().Equal(
+      xBC.MotionMatrix() * xAB.MotionMatrix(), 1e-12));
+  EXPECT_TRUE(xAC.ForceMatrix().Equal(
+      xBC.ForceMatrix() * xAB.ForceMatrix(), 1e-12));
+
+  // Composition matches the pose of C in A
+  const math::SpatialTransformd fromPose(poseAB * poseBC);
+  EXPECT_TRUE(xAC.Equal(fromPose, 1e-12));
+}
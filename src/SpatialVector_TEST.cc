@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "gz/math/SpatialVector.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(SpatialVectorTest, Construct)
+{
+  math::SpatialVectord zero;
+  EXPECT_EQ(math::Vector3d::Zero, zero.Angular());
+  EXPECT_EQ(math::Vector3d::Zero, zero.Linear());
+
+  math::SpatialVectord v(math::Vector3d(1, 2, 3), math::Vector3d(4, 5, 6));
+  EXPECT_EQ(math::Vector3d(1, 2, 3), v.Angular());
+  EXPECT_EQ(math::Vector3d(4, 5, 6), v.Linear());
+
+  v.Linear().X(-4);
+  v.Angular() = math::Vector3d(0, 0, 1);
+  EXPECT_EQ(math::SpatialVectord(math::Vector3d(0, 0, 1),
+                                 math::Vector3d(-4, 5, 6)), v);
+  v.Set(math::Vector3d(1, 1, 1), math::Vector3d::Zero);
+  EXPECT_NE(zero, v);
+
+  std::ostringstream stream;
+  stream << math::SpatialVectord(math::Vector3d(1, 2, 3),
+                                 math::Vector3d(4, 5, 6));
+  EXPECT_EQ("1 2 3 4 5 6", stream.str());
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialVectorTest, Arithmetic)
+{
+  const math::SpatialVectord a(math::Vector3d(1, 2, 3),
+                               math::Vector3d(4, 5, 6));
+  const math::SpatialVectord b(math::Vector3d(-1, 0, 2),
+                               math::Vector3d(0.5, 1, -3));
+
+  EXPECT_EQ(math::SpatialVectord(math::Vector3d(0, 2, 5),
+                                 math::Vector3d(4.5, 6, 3)), a + b);
+  EXPECT_EQ(math::SpatialVectord(math::Vector3d(2, 2, 1),
+                                 math::Vector3d(3.5, 4, 9)), a - b);
+  EXPECT_EQ(a * 2.0, 2.0 * a);
+  EXPECT_EQ(a + a, a * 2.0);
+  EXPECT_EQ(math::SpatialVectord(), a + (-a));
+
+  math::SpatialVectord c = a;
+  c += b;
+  EXPECT_EQ(a + b, c);
+  c -= b;
+  EXPECT_EQ(a, c);
+
+  EXPECT_DOUBLE_EQ(-1 + 6 + 2 + 5 - 18, a.Dot(b));
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialVectorTest, Cross)
+{
+  const math::SpatialVectord v(math::Vector3d(0.1, -0.3, 0.7),
+                               math::Vector3d(1, 2, -0.5));
+  const math::SpatialVectord m(math::Vector3d(-0.4, 0.2, 0.3),
+                               math::Vector3d(0.5, -1, 2));
+  const math::SpatialVectord f(math::Vector3d(2, 0, -1),
+                               math::Vector3d(0.3, 0.6, 0.9));
+
+  // A vector crossed with itself is zero
+  EXPECT_EQ(math::SpatialVectord(), v.CrossMotion(v));
+
+  // The force cross product is the negative transpose of the motion one,
+  // so (v x m) . f = -m . (v x* f)
+  EXPECT_NEAR(v.CrossMotion(m).Dot(f), -m.Dot(v.CrossForce(f)), 1e-12);
+
+  // A pure rotation about the origin
+  const math::SpatialVectord w(math::Vector3d(0, 0, 1), math::Vector3d());
+  const math::SpatialVectord x(math::Vector3d(), math::Vector3d(1, 0, 0));
+  EXPECT_EQ(math::SpatialVectord(math::Vector3d(),
+                                 math::Vector3d(0, 1, 0)), w.CrossMotion(x));
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <limits>
+
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/SpeedLimiterBank.hh"
+
+using namespace gz;
+using namespace math;
+
+//////////////////////////////////////////////////
+class gz::math::SpeedLimiterBankPrivate
+{
+  /// \brief Append an axis with the limits of a limiter.
+  /// \param[in] _limiter Limiter to copy.
+  public: void PushBack(const SpeedLimiter &_limiter)
+  {
+    this->minVelocity.push_back(_limiter.MinVelocity());
+    this->maxVelocity.push_back(_limiter.MaxVelocity());
+    this->minAcceleration.push_back(_limiter.MinAcceleration());
+    this->maxAcceleration.push_back(_limiter.MaxAcceleration());
+    this->minJerk.push_back(_limiter.MinJerk());
+    this->maxJerk.push_back(_limiter.MaxJerk());
+    this->prevVel.push_back(0);
+    this->prevPrevVel.push_back(0);
+  }
+
+  /// \brief Remove axes from the end.
+  /// \param[in] _size New number of axes, not larger than the current.
+  public: void Truncate(const std::size_t _size)
+  {
+    for (auto *array : {&this->minVelocity, &this->maxVelocity,
+                        &this->minAcceleration, &this->maxAcceleration,
+                        &this->minJerk, &this->maxJerk, &this->prevVel,
+                        &this->prevPrevVel})
+    {
+      array->resize(_size);
+    }
+  }
+
+  /// \brief Limit every axis and push the result to the history.
+  /// \param[in, out] _vels Velocities, Size() of them.
+  /// \param[in] _dt Time step in seconds, not zero.
+  public: void Limit(double *_vels, const double _dt)
+  {
+    const std::size_t n = this->minVelocity.size();
+    const double *vMin = this->minVelocity.data();
+    const double *vMax = this->maxVelocity.data();
+    const double *aMin = this->minAcceleration.data();
+    const double *aMax = this->maxAcceleration.data();
+    const double *jMin = this->minJerk.data();
+    const double *jMax = this->maxJerk.data();
+    double *prev = this->prevVel.data();
+    double *prevPrev = this->prevPrevVel.data();
+
+    // Same operations in the same order as SpeedLimiter::Limit, so that
+    // the results are identical.
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      const double p = prev[i];
+      double v = _vels[i];
+
+      // Jerk
+      const double accPrev = (p - prevPrev[i]) / _dt;
+      const double jerk = std::max(std::min(
+          ((v - p) / _dt - accPrev) / _dt, jMax[i]), jMin[i]);
+      v = p + (accPrev + jerk * _dt) * _dt;
+
+      // Acceleration
+      const double acc = std::max(std::min((v - p) / _dt, aMax[i]),
+                                  aMin[i]);
+      v = p + acc * _dt;
+
+      // Velocity
+      v = std::max(std::min(v, vMax[i]), vMin[i]);
+
+      _vels[i] = v;
+      prevPrev[i] = p;
+      prev[i] = v;
+    }
+  }
+
+  /// \brief Minimum velocity limits.
+  public: std::vector<double> minVelocity;
+
+  /// \brief Maximum velocity limits.
+  public: std::vector<double> maxVelocity;
+
+  /// \brief Minimum acceleration limits.
+  public: std::vector<double> minAcceleration;
+
+  /// \brief Maximum acceleration limits.
+  public: std::vector<double> maxAcceleration;
+
+  /// \brief Minimum jerk limits.
+  public: std::vector<double> minJerk;
+
+  /// \brief Maximum jerk limits.
+  public: std::vector<double> maxJerk;
+
+  /// \brief Velocities of the last time step.
+  public: std::vector<double> prevVel;
+
+  /// \brief Velocities of the time step before the last.
+  public: std::vector<double> prevPrevVel;
+};
+
+//////////////////////////////////////////////////
+SpeedLimiterBank::SpeedLimiterBank()
+  : dataPtr(new SpeedLimiterBankPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+SpeedLimiterBank::SpeedLimiterBank(const std::size_t _size,
+    const SpeedLimiter &_limiter)
+  : dataPtr(new SpeedLimiterBankPrivate)
+{
+  this->Resize(_size, _limiter);
+}
+
+//////////////////////////////////////////////////
+SpeedLimiterBank::SpeedLimiterBank(const SpeedLimiterBank &_bank)
+  : dataPtr(new SpeedLimiterBankPrivate(*_bank.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+SpeedLimiterBank::~SpeedLimiterBank()
+{
+}
+
+//////////////////////////////////////////////////
+SpeedLimiterBank &SpeedLimiterBank::operator=(const SpeedLimiterBank &_bank)
+{
+  *this->dataPtr = *_bank.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void SpeedLimiterBank::Resize(const std::size_t _size,
+    const SpeedLimiter &_limiter)
+{
+  if (_size <= this->Size())
+  {
+    this->dataPtr->Truncate(_size);
+    return;
+  }
+  while (this->Size() < _size)
+    this->dataPtr->PushBack(_limiter);
+}
+
+//////////////////////////////////////////////////
+std::size_t SpeedLimiterBank::Add(const SpeedLimiter &_limiter)
+{
+  this->dataPtr->PushBack(_limiter);
+  return this->Size() - 1;
+}
+
+//////////////////////////////////////////////////
+std::size_t SpeedLimiterBank::Size() const
+{
+  return this->dataPtr->minVelocity.size();
+}
+
+//////////////////////////////////////////////////
+bool SpeedLimiterBank::Set(const std::size_t _index,
+    const SpeedLimiter &_limiter)
+{
+  if (_index >= this->Size())
+    return false;
+
+  SpeedLimiterBankPrivate &d = *this->dataPtr;
+  d.minVelocity[_index] = _limiter.MinVelocity();
+  d.maxVelocity[_index] = _limiter.MaxVelocity();
+  d.minAcceleration[_index] = _limiter.MinAcceleration();
+  d.maxAcceleration[_index] = _limiter.MaxAcceleration();
+  d.minJerk[_index] = _limiter.MinJerk();
+  d.maxJerk[_index] = _limiter.MaxJerk();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SpeedLimiterBank::Limiter(const std::size_t _index,
+    SpeedLimiter &_limiter) const
+{
+  if (_index >= this->Size())
+    return false;
+
+  const SpeedLimiterBankPrivate &d = *this->dataPtr;
+  _limiter.SetMinVelocity(d.minVelocity[_index]);
+  _limiter.SetMaxVelocity(d.maxVelocity[_index]);
+  _limiter.SetMinAcceleration(d.minAcceleration[_index]);
+  _limiter.SetMaxAcceleration(d.maxAcceleration[_index]);
+  _limiter.SetMinJerk(d.minJerk[_index]);
+  _limiter.SetMaxJerk(d.maxJerk[_index]);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SpeedLimiterBank::SetHistory(const std::size_t _index,
+    const double _prevVel, const double _prevPrevVel)
+{
+  if (_index >= this->Size())
+    return false;
+
+  this->dataPtr->prevVel[_index] = _prevVel;
+  this->dataPtr->prevPrevVel[_index] = _prevPrevVel;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SpeedLimiterBank::History(const std::size_t _index, double &_prevVel,
+    double &_prevPrevVel) const
+{
+  if (_index >= this->Size())
+    return false;
+
+  _prevVel = this->dataPtr->prevVel[_index];
+  _prevPrevVel = this->dataPtr->prevPrevVel[_index];
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SpeedLimiterBank::Reset()
+{
+  SpeedLimiterBankPrivate &d = *this->dataPtr;
+  std::fill(d.prevVel.begin(), d.prevVel.end(), 0.0);
+  std::fill(d.prevPrevVel.begin(), d.prevPrevVel.end(), 0.0);
+}
+
+//////////////////////////////////////////////////
+bool SpeedLimiterBank::Limit(std::vector<double> &_vels,
+    const std::chrono::steady_clock::duration _dt)
+{
+  if (_vels.size() != this->Size())
+  {
+    IGN_MATH_DIAGNOSTIC("SpeedLimiterBank::Limit() error: got " << _vels.size()
+        << " velocities for " << this->Size() << " axes.");
+    return false;
+  }
+
+  const double dtSec = std::chrono::duration<double>(_dt).count();
+  if (equal(dtSec, 0.0))
+  {
+    const SpeedLimiterBankPrivate &d = *this->dataPtr;
+    for (std::size_t i = 0; i < _vels.size(); ++i)
+      _vels[i] = clamp(_vels[i], d.minVelocity[i], d.maxVelocity[i]);
+    return true;
+  }
+
+  this->dataPtr->Limit(_vels.data(), dtSec);
+  return true;
+}
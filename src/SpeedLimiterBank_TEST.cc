@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "gz/math/SpeedLimiterBank.hh"
+
+using namespace gz;
+using namespace math;
+using namespace std::literals::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(SpeedLimiterBankTest, Construct)
+{
+  SpeedLimiterBank empty;
+  EXPECT_EQ(0u, empty.Size());
+
+  SpeedLimiter limiter;
+  limiter.SetMinVelocity(-1);
+  limiter.SetMaxVelocity(2);
+  limiter.SetMinAcceleration(-3);
+  limiter.SetMaxAcceleration(4);
+  limiter.SetMinJerk(-5);
+  limiter.SetMaxJerk(6);
+  SpeedLimiterBank bank(3, limiter);
+  EXPECT_EQ(3u, bank.Size());
+
+  SpeedLimiter axis;
+  EXPECT_TRUE(bank.Limiter(2, axis));
+  EXPECT_DOUBLE_EQ(-1, axis.MinVelocity());
+  EXPECT_DOUBLE_EQ(2, axis.MaxVelocity());
+  EXPECT_DOUBLE_EQ(-3, axis.MinAcceleration());
+  EXPECT_DOUBLE_EQ(4, axis.MaxAcceleration());
+  EXPECT_DOUBLE_EQ(-5, axis.MinJerk());
+  EXPECT_DOUBLE_EQ(6, axis.MaxJerk());
+
+  SpeedLimiter fast;
+  fast.SetMaxVelocity(10);
+  EXPECT_EQ(3u, bank.Add(fast));
+  EXPECT_TRUE(bank.Limiter(3, axis));
+  EXPECT_DOUBLE_EQ(10, axis.MaxVelocity());
+  EXPECT_TRUE(std::isinf(axis.MinVelocity()));
+  EXPECT_TRUE(bank.Set(0, fast));
+  EXPECT_TRUE(bank.Limiter(0, axis));
+  EXPECT_DOUBLE_EQ(10, axis.MaxVelocity());
+  bank.Resize(2);
+  EXPECT_EQ(2u, bank.Size());
+  bank.Resize(4, fast);
+  EXPECT_TRUE(bank.Limiter(3, axis));
+  EXPECT_DOUBLE_EQ(10, axis.MaxVelocity());
+
+  double prev, prevPrev;
+  EXPECT_TRUE(bank.SetHistory(1, 0.5, 0.25));
+  EXPECT_TRUE(bank.History(1, prev, prevPrev));
+  EXPECT_DOUBLE_EQ(0.5, prev);
+  EXPECT_DOUBLE_EQ(0.25, prevPrev);
+  bank.Reset();
+  EXPECT_TRUE(bank.History(1, prev, prevPrev));
+  EXPECT_DOUBLE_EQ(0, prev);
+  EXPECT_DOUBLE_EQ(0, prevPrev);
+
+  // Errors
+  EXPECT_FALSE(bank.Set(4, fast));
+  EXPECT_FALSE(bank.Limiter(4, axis));
+  EXPECT_FALSE(bank.SetHistory(4, 1, 1));
+  EXPECT_FALSE(bank.History(4, prev, prevPrev));
+  std::vector<double> vels{1, 2};
+  EXPECT_FALSE(bank.Limit(vels, 1ms));
+  EXPECT_EQ(2u, vels.size());
+
+  // Copies are independent
+  SpeedLimiterBank copy(bank);
+  vels = {1, 2, 3, 4};
+  EXPECT_TRUE(copy.Limit(vels, 10ms));
+  EXPECT_TRUE(copy.History(0, prev, prevPrev));
+  EXPECT_DOUBLE_EQ(1, prev);
+  EXPECT_TRUE(bank.History(0, prev, prevPrev));
+  EXPECT_DOUBLE_EQ(0, prev);
+  copy = bank;
+  EXPECT_TRUE(copy.History(0, prev, prevPrev));
+  EXPECT_DOUBLE_EQ(0, prev);
+}
+
+/////////////////////////////////////////////////
+TEST(SpeedLimiterBankTest, MatchesSpeedLimiter)
+{
+  // Axes limited by velocity, acceleration, jerk, all three and none
+  std::vector<SpeedLimiter> limiters(5);
+  limiters[0].SetMinVelocity(-0.5);
+  limiters[0].SetMaxVelocity(0.5);
+  limiters[1].SetMinAcceleration(-2);
+  limiters[1].SetMaxAcceleration(1);
+  limiters[2].SetMinJerk(-20);
+  limiters[2].SetMaxJerk(20);
+  limiters[3].SetMinVelocity(-0.8);
+  limiters[3].SetMaxVelocity(0.6);
+  limiters[3].SetMinAcceleration(-3);
+  limiters[3].SetMaxAcceleration(3);
+  limiters[3].SetMinJerk(-50);
+  limiters[3].SetMaxJerk(40);
+
+  SpeedLimiterBank bank;
+  for (const auto &limiter : limiters)
+    bank.Add(limiter);
+
+  std::vector<double> prev(limiters.size(), 0.0);
+  std::vector<double> prevPrev(limiters.size(), 0.0);
+  for (int step = 0; step < 100; ++step)
+  {
+    std::vector<double> vels;
+    for (std::size_t i = 0; i < limiters.size(); ++i)
+      vels.push_back(std::sin(0.1 * step + i) * (1 + 0.2 * i));
+
+    // A zero time step only limits the velocity
+    const auto dt = step == 50 ? 0ms : 10ms;
+
+    std::vector<double> expected = vels;
+    ASSERT_TRUE(bank.Limit(vels, dt));
+    for (std::size_t i = 0; i < limiters.size(); ++i)
+    {
+      limiters[i].Limit(expected[i], prev[i], prevPrev[i], dt);
+      EXPECT_DOUBLE_EQ(expected[i], vels[i]);
+      if (dt != 0ms)
+      {
+        prevPrev[i] = prev[i];
+        prev[i] = expected[i];
+      }
+
+      double bankPrev, bankPrevPrev;
+      ASSERT_TRUE(bank.History(i, bankPrev, bankPrevPrev));
+      EXPECT_DOUBLE_EQ(prev[i], bankPrev);
+      EXPECT_DOUBLE_EQ(prevPrev[i], bankPrevPrev);
+    }
+  }
+}
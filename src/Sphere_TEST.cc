@@ -17,6 +17,8 @@
 #include <gtest/gtest.h>
 #include <cmath>
 #include <iostream>
+#include <tuple>
+#include <vector>
 
 #include "gz/math/Sphere.hh"
 
@@ -267,3 +269,153 @@ TEST(SphereTest, CenterOfVolumeBelow)
     );
   }
 }
+
+//////////////////////////////////////////////////
+TEST(SphereTest, Batch)
+{
+  const double radii[] = {0.5, 0.02, 1.0};
+  const double densities[] = {1000.0, 2.5, 0.0};
+  const double masses[] = {2.0, 3.0, -1.0};
+
+  double volumes[3];
+  double densitiesFromMass[3];
+  math::MassMatrix3d massMats[3];
+  math::Sphered::Volumes(radii, 3, volumes);
+  math::Sphered::DensitiesFromMasses(radii, masses, 3, densitiesFromMass);
+  EXPECT_FALSE(math::Sphered::MassMatrices(radii, densities, 3, massMats));
+  EXPECT_TRUE(math::Sphered::MassMatrices(radii, densities, 2, massMats));
+
+  for (int i = 0; i < 3; ++i)
+  {
+    math::Sphered sphere(radii[i], math::Material(densities[i]));
+    EXPECT_DOUBLE_EQ(sphere.Volume(), volumes[i]);
+    EXPECT_DOUBLE_EQ(sphere.DensityFromMass(masses[i]), densitiesFromMass[i]);
+
+    math::MassMatrix3d expected;
+    EXPECT_EQ(sphere.MassMatrix(expected), massMats[i].Mass() > 0);
+    EXPECT_EQ(expected, massMats[i]);
+  }
+  EXPECT_DOUBLE_EQ(0.0, massMats[2].Mass());
+}
+
+//////////////////////////////////////////////////
+TEST(SphereTest, VolumesBelow)
+{
+  const math::Planed plane(math::Vector3d(0, 0, 2), 1.0);
+  const double radii[] = {1.0, 2.0, 0.5, 0.5};
+  const math::Vector3d positions[] = {
+    {0, 0, 0.5}, {1, 2, -0.5}, {0, 0, 5}, {3, 2, -5}};
+  const std::size_t count = 4;
+
+  double volumes[count];
+  math::Vector3d centers[count];
+  math::Sphered::VolumesBelow(radii, positions, count, plane, volumes,
+                              centers);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    // Plane in the frame of the sphere
+    math::Sphered sphere(radii[i]);
+    math::Planed local(math::Vector3d::UnitZ, 0.5 - positions[i].Z());
+    EXPECT_NEAR(sphere.VolumeBelow(local), volumes[i], 1e-12);
+
+    auto center = sphere.CenterOfVolumeBelow(local);
+    if (center)
+      EXPECT_EQ(*center + positions[i], centers[i]);
+    else
+      EXPECT_EQ(positions[i], centers[i]);
+  }
+
+  EXPECT_DOUBLE_EQ(2.0 / 3.0 * IGN_PI, volumes[0]);
+  EXPECT_DOUBLE_EQ(0.0, volumes[2]);
+  EXPECT_DOUBLE_EQ(math::Sphered(0.5).Volume(), volumes[3]);
+}
+
+//////////////////////////////////////////////////
+TEST(SphereTest, IntersectDist)
+{
+  const Sphered sphere(1.0);
+  const Pose3d pose(5, 0, 0, 0.1, 0.2, 0.3);
+
+  // Outside, towards the center.
+  auto [hit, dist] = sphere.IntersectDist(pose, Vector3d::Zero,
+                                          Vector3d(2, 0, 0), 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_NEAR(4.0, dist, 1e-12);
+
+  // The distance is relative to the minimum distance.
+  std::tie(hit, dist) = sphere.IntersectDist(pose, Vector3d::Zero,
+                                             Vector3d::UnitX, 1, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_NEAR(3.0, dist, 1e-12);
+
+  // Rays starting inside hit the sphere where they leave it.
+  std::tie(hit, dist) = sphere.IntersectDist(pose, Vector3d::Zero,
+                                             Vector3d::UnitX, 5, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_NEAR(1.0, dist, 1e-12);
+
+  // Tangent ray.
+  std::tie(hit, dist) = sphere.IntersectDist(Pose3d(5, 0, 0, 0, 0, 0),
+      Vector3d(0, 1, 0), Vector3d::UnitX, 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_NEAR(5.0, dist, 1e-9);
+
+  // Misses.
+  EXPECT_FALSE(std::get<0>(sphere.IntersectDist(pose, Vector3d::Zero,
+                                                Vector3d::UnitY, 0, 10)));
+  EXPECT_FALSE(std::get<0>(sphere.IntersectDist(pose, Vector3d::Zero,
+                                                -Vector3d::UnitX, 0, 10)));
+  EXPECT_FALSE(std::get<0>(sphere.IntersectDist(pose, Vector3d::Zero,
+                                                Vector3d::UnitX, 0, 3.9)));
+  EXPECT_FALSE(std::get<0>(sphere.IntersectDist(pose, Vector3d::Zero,
+                                                Vector3d::UnitX, 6.1, 10)));
+}
+
+//////////////////////////////////////////////////
+TEST(SphereTest, IntersectRays)
+{
+  // A planar range sensor at the origin between two spheres.
+  const Sphered sphere(1.0);
+  const int count = 360;
+  std::vector<Vector3d> dirs;
+  for (int i = 0; i < count; ++i)
+  {
+    const double angle = 2 * IGN_PI * i / count;
+    dirs.push_back(Vector3d(std::cos(angle), std::sin(angle), 0));
+  }
+
+  std::vector<double> ranges(count, 20.0);
+  const Pose3d near(0, 3, 0, 0, 0, 0);
+  const Pose3d far(0, 6, 0, 0, 0, 0);
+  EXPECT_GT(sphere.IntersectRays(far, Vector3d::Zero, dirs.data(), count,
+                                 0.1, ranges.data()), 0u);
+  const std::size_t hits = sphere.IntersectRays(near, Vector3d::Zero,
+      dirs.data(), count, 0.1, ranges.data());
+
+  // The ranges are already at the hits of the near sphere.
+  EXPECT_EQ(0u, sphere.IntersectRays(near, Vector3d::Zero, dirs.data(),
+                                     count, 0.1, ranges.data()));
+
+  // Every ray matches the closest single ray query.
+  std::size_t lowered = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    auto [nearHit, nearDist] = sphere.IntersectDist(near, Vector3d::Zero,
+                                                    dirs[i], 0.1, 20.0);
+    const bool farHit = std::get<0>(sphere.IntersectDist(far,
+        Vector3d::Zero, dirs[i], 0.1, 20.0));
+    EXPECT_FALSE(farHit && !nearHit);
+    if (nearHit)
+    {
+      ++lowered;
+      EXPECT_NEAR(nearDist + 0.1, ranges[i], 1e-12);
+    }
+    else
+    {
+      EXPECT_DOUBLE_EQ(20.0, ranges[i]);
+    }
+  }
+  EXPECT_EQ(hits, lowered);
+  EXPECT_NEAR(2.0, ranges[count / 4], 1e-12);
+}
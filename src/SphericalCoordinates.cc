@@ -14,10 +14,30 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
 #include <string>
+#include <vector>
 
+#include "gz/math/Diagnostics.hh"
 #include "gz/math/Matrix3.hh"
 #include "gz/math/SphericalCoordinates.hh"
+#include "gz/math/Trace.hh"
+
+// Select the instruction set used by the batch distance kernel.
+// Define IGNITION_MATH_DISABLE_SIMD to always use the portable scalar code.
+#if !defined(IGNITION_MATH_DISABLE_SIMD)
+  #if defined(__AVX__)
+    #define IGNITION_MATH_SPHERICAL_AVX 1
+    #include <immintrin.h>
+  #elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define IGNITION_MATH_SPHERICAL_SSE2 1
+    #include <emmintrin.h>
+  #endif
+#endif
 
 using namespace gz;
 using namespace math;
@@ -37,6 +57,85 @@ const double g_EarthWGS84Flattening = 1.0/298.257223563;
 // Radius of the Earth (meters).
 const double g_EarthRadius = 6371000.0;
 
+namespace
+{
+  /// \brief Second order Taylor expansion of a position conversion around
+  /// the reference point, used by the FAST accuracy.
+  struct TangentExpansion
+  {
+    /// \brief Evaluate the expansion.
+    /// \param[in] _v Offset from the expansion point.
+    /// \return Approximate value of the conversion.
+    Vector3d Evaluate(const Vector3d &_v) const
+    {
+      const double terms[9] = {_v.X(), _v.Y(), _v.Z(),
+        _v.X() * _v.X(), _v.Y() * _v.Y(), _v.Z() * _v.Z(),
+        _v.X() * _v.Y(), _v.X() * _v.Z(), _v.Y() * _v.Z()};
+      double result[3];
+      for (int k = 0; k < 3; ++k)
+      {
+        result[k] = this->coefficients[k][0];
+        for (int t = 0; t < 9; ++t)
+          result[k] += this->coefficients[k][t + 1] * terms[t];
+      }
+      return Vector3d(result[0], result[1], result[2]);
+    }
+
+    /// \brief Coefficients of each component: the value at the expansion
+    /// point, the first order coefficients for x, y and z, and the second
+    /// order coefficients for the xx, yy, zz, xy, xz and yz products of the
+    /// offset.
+    double coefficients[3][10];
+  };
+
+  /// \brief Transformation of a reference origin, kept in the cache of
+  /// recently used origins.
+  struct CachedOrigin
+  {
+    /// \brief Surface type of the origin.
+    SphericalCoordinates::SurfaceType surfaceType;
+
+    /// \brief Accuracy the expansions were computed for.
+    SphericalCoordinates::AccuracyType accuracy;
+
+    /// \brief Latitude of the origin in radians.
+    double latitude;
+
+    /// \brief Longitude of the origin in radians.
+    double longitude;
+
+    /// \brief Elevation of the origin in meters.
+    double elevation;
+
+    /// \brief Heading offset in radians.
+    double heading;
+
+    /// \brief Rotation matrix that moves ECEF to GLOBAL.
+    Matrix3d rotECEFToGlobal;
+
+    /// \brief Rotation matrix that moves GLOBAL to ECEF.
+    Matrix3d rotGlobalToECEF;
+
+    /// \brief ECEF position of the origin.
+    Vector3d origin;
+
+    /// \brief Cosine of the negated heading.
+    double cosHea;
+
+    /// \brief Sine of the negated heading.
+    double sinHea;
+
+    /// \brief Expansion of the GLOBAL to SPHERICAL conversion.
+    TangentExpansion globalToSpherical;
+
+    /// \brief Expansion of the SPHERICAL to GLOBAL conversion.
+    TangentExpansion sphericalToGlobal;
+
+    /// \brief Radius of validity of the expansions.
+    double tangentRadius;
+  };
+}
+
 // Private data for the SphericalCoordinates class.
 class gz::math::SphericalCoordinatesPrivate
 {
@@ -85,8 +184,957 @@ class gz::math::SphericalCoordinatesPrivate
 
   /// \brief Cache sine head transform
   public: double sinHea;
+
+  /// \brief Accuracy of the position conversions.
+  public: SphericalCoordinates::AccuracyType accuracy =
+    SphericalCoordinates::PRECISE;
+
+  /// \brief Expansion of the GLOBAL to SPHERICAL conversion around the
+  /// origin, giving offsets from the reference.
+  public: TangentExpansion globalToSpherical;
+
+  /// \brief Expansion of the SPHERICAL to GLOBAL conversion around the
+  /// reference, taking offsets from the reference.
+  public: TangentExpansion sphericalToGlobal;
+
+  /// \brief Distance from the origin in meters below which the expansions
+  /// are used. Zero when they are disabled.
+  public: double tangentRadius = 0;
+
+  /// \brief True when the reference changed since the transformation was
+  /// last computed.
+  public: std::atomic<bool> dirty{true};
+
+  /// \brief Serializes the lazy computation of the transformation by
+  /// concurrent conversions.
+  public: std::mutex updateMutex;
+
+  /// \brief Transformations of recently used origins, the most recent
+  /// first.
+  public: std::vector<CachedOrigin> originCache;
+
+  /// \brief Maximum number of origins in the cache.
+  public: std::size_t originCacheSize = 0;
 };
 
+namespace
+{
+  /// \brief Number of positions converted at a time by the batch
+  /// conversions. The chunk is small enough to stay in the L1 cache.
+  const std::size_t kChunkSize = 256;
+
+  /// \brief Bound of the error of the tangent expansions used by the FAST
+  /// accuracy, in meters.
+  const double kTangentTolerance = 1e-3;
+
+  /// \brief Largest distance from the origin at which the tangent
+  /// expansions are used, in meters.
+  const double kMaxTangentRadius = 5000;
+
+  /// \brief Smallest distance from the origin worth caching the tangent
+  /// expansions for, in meters. It disables them near the poles.
+  const double kMinTangentRadius = 10;
+
+  /// \brief Finite difference step used to compute the tangent expansions,
+  /// in meters.
+  const double kTangentStep = 100;
+
+  /// \brief Check that a coordinate type can be used by PositionTransform.
+  /// \param[in] _type Coordinate type to check.
+  /// \return True if the type is valid.
+  bool ValidPositionType(const SphericalCoordinates::CoordinateType _type)
+  {
+    switch (_type)
+    {
+      case SphericalCoordinates::SPHERICAL:
+      case SphericalCoordinates::ECEF:
+      case SphericalCoordinates::GLOBAL:
+      case SphericalCoordinates::LOCAL:
+      case SphericalCoordinates::LOCAL2:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /// \brief Check if a coordinate type is a Cartesian frame tangent to the
+  /// surface at the origin, i.e. GLOBAL, LOCAL or LOCAL2.
+  /// \param[in] _type Coordinate type to check.
+  /// \return True if the type is a tangent frame.
+  bool TangentFrame(const SphericalCoordinates::CoordinateType _type)
+  {
+    return _type == SphericalCoordinates::GLOBAL ||
+      _type == SphericalCoordinates::LOCAL ||
+      _type == SphericalCoordinates::LOCAL2;
+  }
+
+  /// \brief Get the rotation from a tangent frame to the GLOBAL frame, as
+  /// applied by SphericalCoordinates::PositionTransform.
+  /// \param[in] _d Spherical coordinates data.
+  /// \param[in] _type Tangent frame.
+  /// \return The rotation.
+  Matrix3d TangentToGlobal(const SphericalCoordinatesPrivate &_d,
+                           const SphericalCoordinates::CoordinateType _type)
+  {
+    const double c = _d.cosHea;
+    const double s = _d.sinHea;
+    if (_type == SphericalCoordinates::LOCAL)
+      return Matrix3d(-c, s, 0, -s, -c, 0, 0, 0, 1);
+    if (_type == SphericalCoordinates::LOCAL2)
+      return Matrix3d(c, s, 0, -s, c, 0, 0, 0, 1);
+    return Matrix3d::Identity;
+  }
+
+  /// \brief Get the rotation from the GLOBAL frame to a tangent frame, as
+  /// applied by SphericalCoordinates::PositionTransform.
+  /// \param[in] _d Spherical coordinates data.
+  /// \param[in] _type Tangent frame.
+  /// \return The rotation.
+  Matrix3d GlobalToTangent(const SphericalCoordinatesPrivate &_d,
+                           const SphericalCoordinates::CoordinateType _type)
+  {
+    const double c = _d.cosHea;
+    const double s = _d.sinHea;
+    if (_type == SphericalCoordinates::GLOBAL)
+      return Matrix3d::Identity;
+    return Matrix3d(c, -s, 0, s, c, 0, 0, 0, 1);
+  }
+
+  /// \brief Get the rotation applied by
+  /// SphericalCoordinates::VelocityTransform between two coordinate types.
+  /// \param[in] _d Spherical coordinates data.
+  /// \param[in] _in Coordinate type of the input.
+  /// \param[in] _out Coordinate type of the output.
+  /// \param[out] _m The rotation, the identity if _in or _out is
+  /// SPHERICAL.
+  /// \return False if _in or _out is not a valid coordinate type.
+  bool VelocityRotation(const SphericalCoordinatesPrivate &_d,
+                        const SphericalCoordinates::CoordinateType _in,
+                        const SphericalCoordinates::CoordinateType _out,
+                        Matrix3d &_m)
+  {
+    _m = Matrix3d::Identity;
+    if (_in == SphericalCoordinates::SPHERICAL ||
+        _out == SphericalCoordinates::SPHERICAL)
+    {
+      return true;
+    }
+    if (!ValidPositionType(_in) || !ValidPositionType(_out))
+      return false;
+
+    if (TangentFrame(_in))
+      _m = _d.rotGlobalToECEF * TangentToGlobal(_d, _in);
+    if (TangentFrame(_out))
+      _m = GlobalToTangent(_d, _out) * _d.rotECEFToGlobal * _m;
+    return true;
+  }
+
+  /// \brief A chunk of positions in structure of arrays form. The arrays
+  /// are members of the same object, which lets compilers prove that they
+  /// do not overlap and vectorize the loops over them.
+  struct PositionChunk
+  {
+    /// \brief X components.
+    double x[kChunkSize];
+
+    /// \brief Y components.
+    double y[kChunkSize];
+
+    /// \brief Z components.
+    double z[kChunkSize];
+  };
+
+  /// \brief Transform a chunk of positions in place with the same
+  /// arithmetic as SphericalCoordinates::PositionTransform. The affine
+  /// stages run as simple loops over the arrays, and the cached rotation
+  /// matrices are read once per chunk. The affine loops always cover the
+  /// whole chunk, so that compilers vectorize them without a scalar
+  /// epilogue; the positions past _n must be initialized.
+  /// \param[in] _d Spherical coordinates data.
+  /// \param[in,out] _c Positions to transform.
+  /// \param[in] _n Number of positions, at most kChunkSize.
+  /// \param[in] _in Coordinate type of the input, which must be valid.
+  /// \param[in] _out Coordinate type of the output, which must be valid.
+  void TransformChunk(const SphericalCoordinatesPrivate &_d,
+                      PositionChunk &_c, const std::size_t _n,
+                      const SphericalCoordinates::CoordinateType _in,
+                      const SphericalCoordinates::CoordinateType _out)
+  {
+    const double cosHea = _d.cosHea;
+    const double sinHea = _d.sinHea;
+    const double ox = _d.origin.X();
+    const double oy = _d.origin.Y();
+    const double oz = _d.origin.Z();
+
+    // Transforms between tangent frames go through ECEF and back with the
+    // same origin, which amounts to a single rotation.
+    if (TangentFrame(_in) && TangentFrame(_out))
+    {
+      const Matrix3d m = GlobalToTangent(_d, _out) * _d.rotECEFToGlobal *
+        _d.rotGlobalToECEF * TangentToGlobal(_d, _in);
+      const double m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+      const double m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+      const double m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+      for (std::size_t i = 0; i < kChunkSize; ++i)
+      {
+        const double x = _c.x[i];
+        const double y = _c.y[i];
+        const double z = _c.z[i];
+        _c.x[i] = m00 * x + m01 * y + m02 * z;
+        _c.y[i] = m10 * x + m11 * y + m12 * z;
+        _c.z[i] = m20 * x + m21 * y + m22 * z;
+      }
+      return;
+    }
+
+    // Convert whatever arrives to ECEF.
+    if (_in == SphericalCoordinates::LOCAL)
+    {
+      for (std::size_t i = 0; i < kChunkSize; ++i)
+      {
+        const double x = _c.x[i];
+        const double y = _c.y[i];
+        _c.x[i] = -x * cosHea + y * sinHea;
+        _c.y[i] = -x * sinHea - y * cosHea;
+      }
+    }
+    else if (_in == SphericalCoordinates::LOCAL2)
+    {
+      for (std::size_t i = 0; i < kChunkSize; ++i)
+      {
+        const double x = _c.x[i];
+        const double y = _c.y[i];
+        _c.x[i] = x * cosHea + y * sinHea;
+        _c.y[i] = -x * sinHea + y * cosHea;
+      }
+    }
+
+    if (_in == SphericalCoordinates::LOCAL ||
+        _in == SphericalCoordinates::LOCAL2 ||
+        _in == SphericalCoordinates::GLOBAL)
+    {
+      const Matrix3d &m = _d.rotGlobalToECEF;
+      const double m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+      const double m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+      const double m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+      for (std::size_t i = 0; i < kChunkSize; ++i)
+      {
+        const double x = _c.x[i];
+        const double y = _c.y[i];
+        const double z = _c.z[i];
+        _c.x[i] = ox + (m00 * x + m01 * y + m02 * z);
+        _c.y[i] = oy + (m10 * x + m11 * y + m12 * z);
+        _c.z[i] = oz + (m20 * x + m21 * y + m22 * z);
+      }
+    }
+    else if (_in == SphericalCoordinates::SPHERICAL)
+    {
+      const double e2 = _d.ellE * _d.ellE;
+      const double b2a2 = (_d.ellB * _d.ellB) / (_d.ellA * _d.ellA);
+      for (std::size_t i = 0; i < _n; ++i)
+      {
+        const double cosLat = cos(_c.x[i]);
+        const double sinLat = sin(_c.x[i]);
+        const double cosLon = cos(_c.y[i]);
+        const double sinLon = sin(_c.y[i]);
+        const double curvature =
+          _d.ellA / sqrt(1.0 - e2 * sinLat * sinLat);
+        const double alt = _c.z[i];
+        _c.x[i] = (alt + curvature) * cosLat * cosLon;
+        _c.y[i] = (alt + curvature) * cosLat * sinLon;
+        _c.z[i] = (b2a2 * curvature + alt) * sinLat;
+      }
+    }
+
+    // Convert ECEF to the requested output coordinate system.
+    if (_out == SphericalCoordinates::SPHERICAL)
+    {
+      const double p2b = _d.ellP * _d.ellP * _d.ellB;
+      const double e2a = _d.ellE * _d.ellE * _d.ellA;
+      const double e2 = _d.ellE * _d.ellE;
+      for (std::size_t i = 0; i < _n; ++i)
+      {
+        const double x = _c.x[i];
+        const double y = _c.y[i];
+        const double z = _c.z[i];
+        const double p = sqrt(x * x + y * y);
+        const double theta = atan((z * _d.ellA) / (p * _d.ellB));
+        const double sinTheta = sin(theta);
+        const double cosTheta = cos(theta);
+        const double lat = atan(
+            (z + p2b * sinTheta * sinTheta * sinTheta) /
+            (p - e2a * cosTheta * cosTheta * cosTheta));
+        const double sinLat = sin(lat);
+        const double nCurvature = _d.ellA / sqrt(1.0 - e2 * sinLat * sinLat);
+        _c.x[i] = lat;
+        _c.y[i] = atan2(y, x);
+        _c.z[i] = p / cos(lat) - nCurvature;
+      }
+    }
+    else if (_out != SphericalCoordinates::ECEF)
+    {
+      const Matrix3d &m = _d.rotECEFToGlobal;
+      const double m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+      const double m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+      const double m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+      // GLOBAL is LOCAL without the heading rotation.
+      const bool local = _out != SphericalCoordinates::GLOBAL;
+      const double c = local ? cosHea : 1.0;
+      const double s = local ? sinHea : 0.0;
+      for (std::size_t i = 0; i < kChunkSize; ++i)
+      {
+        const double x = _c.x[i] - ox;
+        const double y = _c.y[i] - oy;
+        const double z = _c.z[i] - oz;
+        const double gx = m00 * x + m01 * y + m02 * z;
+        const double gy = m10 * x + m11 * y + m12 * z;
+        _c.x[i] = gx * c - gy * s;
+        _c.y[i] = gx * s + gy * c;
+        _c.z[i] = m20 * x + m21 * y + m22 * z;
+      }
+    }
+  }
+
+  /// \brief Half angle terms of a chunk of points, used by the batch
+  /// Haversine distances. They let the distance between two points be
+  /// computed without trigonometric functions, with the angle difference
+  /// identities.
+  struct HaversineChunk
+  {
+    /// \brief Sines of half the latitudes.
+    double sinHalfLat[kChunkSize];
+
+    /// \brief Cosines of half the latitudes.
+    double cosHalfLat[kChunkSize];
+
+    /// \brief Sines of half the longitudes.
+    double sinHalfLon[kChunkSize];
+
+    /// \brief Cosines of half the longitudes.
+    double cosHalfLon[kChunkSize];
+
+    /// \brief Cosines of the latitudes.
+    double cosLat[kChunkSize];
+
+    /// \brief Distances to the points, filled by HaversineRow.
+    double distance[kChunkSize];
+  };
+
+  /// \brief Compute the half angle terms of a set of points. The last
+  /// chunk is padded with points at zero latitude and longitude.
+  /// \param[in] _lat Latitudes in radians.
+  /// \param[in] _lon Longitudes in radians, with the same size as _lat.
+  /// \return The chunks.
+  std::vector<HaversineChunk> HaversineChunks(const std::vector<double> &_lat,
+                                              const std::vector<double> &_lon)
+  {
+    std::vector<HaversineChunk> chunks(
+        (_lat.size() + kChunkSize - 1) / kChunkSize);
+    for (std::size_t i = 0; i < chunks.size() * kChunkSize; ++i)
+    {
+      HaversineChunk &chunk = chunks[i / kChunkSize];
+      const std::size_t j = i % kChunkSize;
+      const double lat = i < _lat.size() ? _lat[i] : 0.0;
+      const double lon = i < _lon.size() ? _lon[i] : 0.0;
+      chunk.sinHalfLat[j] = sin(lat / 2);
+      chunk.cosHalfLat[j] = cos(lat / 2);
+      chunk.sinHalfLon[j] = sin(lon / 2);
+      chunk.cosHalfLon[j] = cos(lon / 2);
+      chunk.cosLat[j] = cos(lat);
+    }
+    return chunks;
+  }
+
+  /// \brief Coefficients of the rational approximation of the arc sine of
+  /// fdlibm, asin(x) = x + x * P(x^2) / Q(x^2) for x in [0, 0.5].
+  const double kAsinP[6] = {1.66666666666666657415e-01,
+    -3.25565818622400915405e-01, 2.01212532134862925881e-01,
+    -4.00555345006794114027e-02, 7.91534994289814532176e-04,
+    3.47933107596021167570e-05};
+  const double kAsinQ[4] = {-2.40339491173441421878e+00,
+    2.02094576023350569471e+00, -6.88283971605453293030e-01,
+    7.70381505559019352791e-02};
+
+  /// \brief Compute the Haversine distances from a point to a chunk of
+  /// points into HaversineChunk::distance. The arc sine is evaluated with
+  /// the rational approximation of fdlibm, without branches, and values
+  /// above 0.5 use asin(x) = pi/2 - 2 asin(sqrt((1 - x) / 2)).
+  /// \param[in] _lat Latitude of the point in radians.
+  /// \param[in] _lon Longitude of the point in radians.
+  /// \param[in,out] _chunk Chunk of points.
+  void HaversineRow(const double _lat, const double _lon,
+                    HaversineChunk &_chunk)
+  {
+    const double sinHalfLat = sin(_lat / 2);
+    const double cosHalfLat = cos(_lat / 2);
+    const double sinHalfLon = sin(_lon / 2);
+    const double cosHalfLon = cos(_lon / 2);
+    const double cosLat = cos(_lat);
+#if defined(IGNITION_MATH_SPHERICAL_AVX)
+    const __m256d sLat = _mm256_set1_pd(sinHalfLat);
+    const __m256d cLat = _mm256_set1_pd(cosHalfLat);
+    const __m256d sLon = _mm256_set1_pd(sinHalfLon);
+    const __m256d cLon = _mm256_set1_pd(cosHalfLon);
+    const __m256d cosA = _mm256_set1_pd(cosLat);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d two = _mm256_set1_pd(2.0);
+    const __m256d halfPi = _mm256_set1_pd(IGN_PI_2);
+    const __m256d diameter = _mm256_set1_pd(2 * g_EarthRadius);
+    for (std::size_t i = 0; i < kChunkSize; i += 4)
+    {
+      const __m256d sinDLat = _mm256_sub_pd(
+          _mm256_mul_pd(_mm256_loadu_pd(&_chunk.sinHalfLat[i]), cLat),
+          _mm256_mul_pd(_mm256_loadu_pd(&_chunk.cosHalfLat[i]), sLat));
+      const __m256d sinDLon = _mm256_sub_pd(
+          _mm256_mul_pd(_mm256_loadu_pd(&_chunk.sinHalfLon[i]), cLon),
+          _mm256_mul_pd(_mm256_loadu_pd(&_chunk.cosHalfLon[i]), sLon));
+      const __m256d a = _mm256_min_pd(one, _mm256_add_pd(
+          _mm256_mul_pd(sinDLat, sinDLat),
+          _mm256_mul_pd(_mm256_mul_pd(sinDLon, sinDLon),
+            _mm256_mul_pd(cosA, _mm256_loadu_pd(&_chunk.cosLat[i])))));
+
+      const __m256d x = _mm256_sqrt_pd(a);
+      const __m256d small = _mm256_cmp_pd(x, half, _CMP_LE_OQ);
+      const __m256d t = _mm256_blendv_pd(
+          _mm256_mul_pd(_mm256_sub_pd(one, x), half),
+          _mm256_mul_pd(x, x), small);
+      const __m256d z = _mm256_blendv_pd(_mm256_sqrt_pd(t), x, small);
+      __m256d p = _mm256_set1_pd(kAsinP[5]);
+      for (int k = 4; k >= 0; --k)
+        p = _mm256_add_pd(_mm256_mul_pd(p, t), _mm256_set1_pd(kAsinP[k]));
+      p = _mm256_mul_pd(p, t);
+      __m256d q = _mm256_set1_pd(kAsinQ[3]);
+      for (int k = 2; k >= 0; --k)
+        q = _mm256_add_pd(_mm256_mul_pd(q, t), _mm256_set1_pd(kAsinQ[k]));
+      q = _mm256_add_pd(_mm256_mul_pd(q, t), one);
+      const __m256d y = _mm256_add_pd(z,
+          _mm256_mul_pd(z, _mm256_div_pd(p, q)));
+      const __m256d angle = _mm256_blendv_pd(
+          _mm256_sub_pd(halfPi, _mm256_mul_pd(two, y)), y, small);
+      _mm256_storeu_pd(&_chunk.distance[i], _mm256_mul_pd(diameter, angle));
+    }
+#elif defined(IGNITION_MATH_SPHERICAL_SSE2)
+    const __m128d sLat = _mm_set1_pd(sinHalfLat);
+    const __m128d cLat = _mm_set1_pd(cosHalfLat);
+    const __m128d sLon = _mm_set1_pd(sinHalfLon);
+    const __m128d cLon = _mm_set1_pd(cosHalfLon);
+    const __m128d cosA = _mm_set1_pd(cosLat);
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d half = _mm_set1_pd(0.5);
+    const __m128d two = _mm_set1_pd(2.0);
+    const __m128d halfPi = _mm_set1_pd(IGN_PI_2);
+    const __m128d diameter = _mm_set1_pd(2 * g_EarthRadius);
+    for (std::size_t i = 0; i < kChunkSize; i += 2)
+    {
+      const __m128d sinDLat = _mm_sub_pd(
+          _mm_mul_pd(_mm_loadu_pd(&_chunk.sinHalfLat[i]), cLat),
+          _mm_mul_pd(_mm_loadu_pd(&_chunk.cosHalfLat[i]), sLat));
+      const __m128d sinDLon = _mm_sub_pd(
+          _mm_mul_pd(_mm_loadu_pd(&_chunk.sinHalfLon[i]), cLon),
+          _mm_mul_pd(_mm_loadu_pd(&_chunk.cosHalfLon[i]), sLon));
+      const __m128d a = _mm_min_pd(one, _mm_add_pd(
+          _mm_mul_pd(sinDLat, sinDLat),
+          _mm_mul_pd(_mm_mul_pd(sinDLon, sinDLon),
+            _mm_mul_pd(cosA, _mm_loadu_pd(&_chunk.cosLat[i])))));
+
+      const __m128d x = _mm_sqrt_pd(a);
+      const __m128d small = _mm_cmple_pd(x, half);
+      const __m128d t = _mm_or_pd(_mm_and_pd(small, _mm_mul_pd(x, x)),
+          _mm_andnot_pd(small, _mm_mul_pd(_mm_sub_pd(one, x), half)));
+      const __m128d z = _mm_or_pd(_mm_and_pd(small, x),
+          _mm_andnot_pd(small, _mm_sqrt_pd(t)));
+      __m128d p = _mm_set1_pd(kAsinP[5]);
+      for (int k = 4; k >= 0; --k)
+        p = _mm_add_pd(_mm_mul_pd(p, t), _mm_set1_pd(kAsinP[k]));
+      p = _mm_mul_pd(p, t);
+      __m128d q = _mm_set1_pd(kAsinQ[3]);
+      for (int k = 2; k >= 0; --k)
+        q = _mm_add_pd(_mm_mul_pd(q, t), _mm_set1_pd(kAsinQ[k]));
+      q = _mm_add_pd(_mm_mul_pd(q, t), one);
+      const __m128d y = _mm_add_pd(z, _mm_mul_pd(z, _mm_div_pd(p, q)));
+      const __m128d angle = _mm_or_pd(_mm_and_pd(small, y),
+          _mm_andnot_pd(small, _mm_sub_pd(halfPi, _mm_mul_pd(two, y))));
+      _mm_storeu_pd(&_chunk.distance[i], _mm_mul_pd(diameter, angle));
+    }
+#else
+    for (std::size_t i = 0; i < kChunkSize; ++i)
+    {
+      // sin(dLat / 2) and sin(dLon / 2), from the angle difference
+      // identities.
+      const double sinDLat = _chunk.sinHalfLat[i] * cosHalfLat -
+        _chunk.cosHalfLat[i] * sinHalfLat;
+      const double sinDLon = _chunk.sinHalfLon[i] * cosHalfLon -
+        _chunk.cosHalfLon[i] * sinHalfLon;
+      const double a = std::min(1.0, sinDLat * sinDLat +
+        sinDLon * sinDLon * cosLat * _chunk.cosLat[i]);
+
+      // 2 * atan2(sqrt(a), sqrt(1 - a)) is 2 * asin(sqrt(a)).
+      const double x = sqrt(a);
+      const bool small = x <= 0.5;
+      const double t = small ? x * x : (1.0 - x) * 0.5;
+      const double z = small ? x : sqrt(t);
+      double p = kAsinP[5];
+      for (int k = 4; k >= 0; --k)
+        p = p * t + kAsinP[k];
+      double q = kAsinQ[3];
+      for (int k = 2; k >= 0; --k)
+        q = q * t + kAsinQ[k];
+      const double y = z + z * (p * t / (q * t + 1.0));
+      _chunk.distance[i] =
+        2 * g_EarthRadius * (small ? y : IGN_PI_2 - 2.0 * y);
+    }
+#endif
+  }
+
+  /// \brief Compute the Haversine distances from a point to a set of
+  /// points.
+  /// \param[in] _lat Latitude of the point in radians.
+  /// \param[in] _lon Longitude of the point in radians.
+  /// \param[in,out] _chunks Chunks of the other points.
+  /// \param[in] _count Number of other points.
+  /// \param[out] _distances Distances to the other points.
+  void HaversineRows(const double _lat, const double _lon,
+                     std::vector<HaversineChunk> &_chunks,
+                     const std::size_t _count, double *_distances)
+  {
+    for (std::size_t c = 0; c < _chunks.size(); ++c)
+    {
+      HaversineRow(_lat, _lon, _chunks[c]);
+      const std::size_t start = c * kChunkSize;
+      std::memcpy(_distances + start, _chunks[c].distance,
+          std::min(kChunkSize, _count - start) * sizeof(double));
+    }
+  }
+
+  /// \brief Convert an ECEF position to SPHERICAL.
+  /// \param[in] _d Spherical coordinates data.
+  /// \param[in] _ecef ECEF position.
+  /// \param[in] _fast True to compute the same Bowring approximation with
+  /// fewer trigonometric functions. This is also robust at the poles.
+  /// \return Latitude and longitude in radians, and altitude in meters.
+  Vector3d EcefToSpherical(const SphericalCoordinatesPrivate &_d,
+                           const Vector3d &_ecef, const bool _fast)
+  {
+    const double p = sqrt(_ecef.X() * _ecef.X() + _ecef.Y() * _ecef.Y());
+    const double lon = atan2(_ecef.Y(), _ecef.X());
+
+    if (_fast)
+    {
+      // The sine and cosine of the parametric latitude and of the latitude
+      // follow from the sides of the triangles that define their tangents.
+      const double za = _ecef.Z() * _d.ellA;
+      const double pb = p * _d.ellB;
+      const double r = sqrt(za * za + pb * pb);
+      const double sinTheta = r > 0 ? za / r : 0.0;
+      const double cosTheta = r > 0 ? pb / r : 1.0;
+
+      const double num = _ecef.Z() + _d.ellP * _d.ellP * _d.ellB *
+        sinTheta * sinTheta * sinTheta;
+      const double den = p - _d.ellE * _d.ellE * _d.ellA *
+        cosTheta * cosTheta * cosTheta;
+      const double hyp = sqrt(num * num + den * den);
+      const double sinLat = hyp > 0 ? num / hyp : 0.0;
+      const double cosLat = hyp > 0 ? den / hyp : 1.0;
+
+      const double w = sqrt(1.0 - _d.ellE * _d.ellE * sinLat * sinLat);
+      return Vector3d(atan2(num, den), lon,
+          p * cosLat + _ecef.Z() * sinLat - _d.ellA * w);
+    }
+
+    double theta = atan((_ecef.Z() * _d.ellA) / (p * _d.ellB));
+
+    // Calculate latitude
+    double lat = atan(
+        (_ecef.Z() + std::pow(_d.ellP, 2) * _d.ellB *
+         std::pow(sin(theta), 3)) /
+        (p - std::pow(_d.ellE, 2) * _d.ellA * std::pow(cos(theta), 3)));
+
+    // Recalculate radius of planet curvature at the current latitude.
+    double nCurvature = 1.0 - std::pow(_d.ellE, 2) * std::pow(sin(lat), 2);
+    nCurvature = _d.ellA / sqrt(nCurvature);
+
+    return Vector3d(lat, lon, p / cos(lat) - nCurvature);
+  }
+
+  /// \brief Convert a position between coordinate types, as documented by
+  /// SphericalCoordinates::PositionTransform.
+  /// \param[in] _d Spherical coordinates data.
+  /// \param[in] _pos Position vector in frame defined by parameter _in
+  /// \param[in] _in  CoordinateType for input
+  /// \param[in] _out CoordinateType for output
+  /// \param[in] _fast True to use the fast conversion from ECEF to
+  /// SPHERICAL.
+  /// \return Transformed coordinate using cached origin.
+  Vector3d TransformPosition(const SphericalCoordinatesPrivate &_d,
+                             const Vector3d &_pos,
+                             const SphericalCoordinates::CoordinateType _in,
+                             const SphericalCoordinates::CoordinateType _out,
+                             const bool _fast)
+  {
+    Vector3d tmp = _pos;
+
+    // Convert whatever arrives to a more flexible ECEF coordinate
+    switch (_in)
+    {
+      // East, North, Up (ENU), note no break at end of case
+      case SphericalCoordinates::LOCAL:
+        {
+          tmp.X(-_pos.X() * _d.cosHea + _pos.Y() * _d.sinHea);
+          tmp.Y(-_pos.X() * _d.sinHea - _pos.Y() * _d.cosHea);
+          tmp = _d.origin + _d.rotGlobalToECEF * tmp;
+          break;
+        }
+
+      case SphericalCoordinates::LOCAL2:
+        {
+          tmp.X(_pos.X() * _d.cosHea + _pos.Y() * _d.sinHea);
+          tmp.Y(-_pos.X() * _d.sinHea + _pos.Y() * _d.cosHea);
+          tmp = _d.origin + _d.rotGlobalToECEF * tmp;
+          break;
+        }
+
+      case SphericalCoordinates::GLOBAL:
+        {
+          tmp = _d.origin + _d.rotGlobalToECEF * tmp;
+          break;
+        }
+
+      case SphericalCoordinates::SPHERICAL:
+        {
+          // Cache trig results
+          double cosLat = cos(_pos.X());
+          double sinLat = sin(_pos.X());
+          double cosLon = cos(_pos.Y());
+          double sinLon = sin(_pos.Y());
+
+          // Radius of planet curvature (meters)
+          double curvature = 1.0 - _d.ellE * _d.ellE * sinLat * sinLat;
+          curvature = _d.ellA / sqrt(curvature);
+
+          tmp.X((_pos.Z() + curvature) * cosLat * cosLon);
+          tmp.Y((_pos.Z() + curvature) * cosLat * sinLon);
+          tmp.Z(((_d.ellB * _d.ellB) / (_d.ellA * _d.ellA) *
+                curvature + _pos.Z()) * sinLat);
+          break;
+        }
+
+      // Do nothing
+      case SphericalCoordinates::ECEF:
+        break;
+      default:
+        {
+          IGN_MATH_DIAGNOSTIC("Invalid coordinate type[" << _in << "]");
+          return _pos;
+        }
+    }
+
+    // Convert ECEF to the requested output coordinate system
+    switch (_out)
+    {
+      case SphericalCoordinates::SPHERICAL:
+        tmp = EcefToSpherical(_d, tmp, _fast);
+        break;
+
+      // Convert from ECEF TO GLOBAL
+      case SphericalCoordinates::GLOBAL:
+        tmp = _d.rotECEFToGlobal * (tmp - _d.origin);
+        break;
+
+      // Convert from ECEF TO LOCAL
+      case SphericalCoordinates::LOCAL:
+      case SphericalCoordinates::LOCAL2:
+        tmp = _d.rotECEFToGlobal * (tmp - _d.origin);
+
+        tmp = Vector3d(
+            tmp.X() * _d.cosHea - tmp.Y() * _d.sinHea,
+            tmp.X() * _d.sinHea + tmp.Y() * _d.cosHea,
+            tmp.Z());
+        break;
+
+      // Return ECEF (do nothing)
+      case SphericalCoordinates::ECEF:
+        break;
+
+      default:
+        IGN_MATH_DIAGNOSTIC("Unknown coordinate type[" << _out << "]");
+        return _pos;
+    }
+
+    return tmp;
+  }
+
+  /// \brief Convert a position with the FAST accuracy. Conversions between
+  /// SPHERICAL and the Cartesian coordinate types near the origin evaluate
+  /// the cached tangent expansions, and the others use the fast conversion
+  /// from ECEF to SPHERICAL.
+  /// \param[in] _d Spherical coordinates data.
+  /// \param[in] _pos Position vector in frame defined by parameter _in
+  /// \param[in] _in  CoordinateType for input
+  /// \param[in] _out CoordinateType for output
+  /// \return Transformed coordinate using cached origin.
+  Vector3d FastTransformPosition(
+      const SphericalCoordinatesPrivate &_d, const Vector3d &_pos,
+      const SphericalCoordinates::CoordinateType _in,
+      const SphericalCoordinates::CoordinateType _out)
+  {
+    const double radius2 = _d.tangentRadius * _d.tangentRadius;
+    if (radius2 > 0 && ValidPositionType(_in) && ValidPositionType(_out) &&
+        (_in == SphericalCoordinates::SPHERICAL) !=
+        (_out == SphericalCoordinates::SPHERICAL))
+    {
+      if (_out == SphericalCoordinates::SPHERICAL)
+      {
+        const Vector3d global = _in == SphericalCoordinates::ECEF ?
+          _d.rotECEFToGlobal * (_pos - _d.origin) :
+          TangentToGlobal(_d, _in) * _pos;
+        if (global.SquaredLength() < radius2)
+        {
+          const Vector3d offset = _d.globalToSpherical.Evaluate(global);
+          double lon = _d.longitudeReference.Radian() + offset.Y();
+          if (lon > IGN_PI)
+            lon -= 2 * IGN_PI;
+          else if (lon < -IGN_PI)
+            lon += 2 * IGN_PI;
+          return Vector3d(_d.latitudeReference.Radian() + offset.X(), lon,
+              _d.elevationReference + offset.Z());
+        }
+      }
+      else
+      {
+        double dLon = _pos.Y() - _d.longitudeReference.Radian();
+        if (dLon > IGN_PI)
+          dLon -= 2 * IGN_PI;
+        else if (dLon < -IGN_PI)
+          dLon += 2 * IGN_PI;
+        const Vector3d offset(_pos.X() - _d.latitudeReference.Radian(), dLon,
+            _pos.Z() - _d.elevationReference);
+        const Vector3d global = _d.sphericalToGlobal.Evaluate(offset);
+        if (global.SquaredLength() < radius2)
+        {
+          if (_out == SphericalCoordinates::ECEF)
+            return _d.origin + _d.rotGlobalToECEF * global;
+          return GlobalToTangent(_d, _out) * global;
+        }
+      }
+    }
+    return TransformPosition(_d, _pos, _in, _out, true);
+  }
+
+  /// \brief Compute the second order Taylor expansion of a conversion
+  /// around zero with central finite differences.
+  /// \param[in] _f Conversion to expand.
+  /// \param[in] _step Finite difference step along each axis.
+  /// \return The expansion.
+  template<typename Conversion>
+  TangentExpansion Expand(const Conversion &_f, const Vector3d &_step)
+  {
+    const Vector3d axes[3] = {Vector3d(_step.X(), 0, 0),
+      Vector3d(0, _step.Y(), 0), Vector3d(0, 0, _step.Z())};
+    const double steps[3] = {_step.X(), _step.Y(), _step.Z()};
+
+    TangentExpansion result;
+    const Vector3d value = _f(Vector3d::Zero);
+    auto set = [&result](const int _index, const Vector3d &_c)
+    {
+      result.coefficients[0][_index] = _c.X();
+      result.coefficients[1][_index] = _c.Y();
+      result.coefficients[2][_index] = _c.Z();
+    };
+    set(0, value);
+    for (int i = 0; i < 3; ++i)
+    {
+      const Vector3d plus = _f(axes[i]);
+      const Vector3d minus = _f(-axes[i]);
+      set(1 + i, (plus - minus) / (2 * steps[i]));
+      set(4 + i, (plus - 2 * value + minus) / (2 * steps[i] * steps[i]));
+    }
+
+    // Mixed terms, in the xy, xz, yz order.
+    const int pairs[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+    for (int t = 0; t < 3; ++t)
+    {
+      const int i = pairs[t][0];
+      const int j = pairs[t][1];
+      set(7 + t, (_f(axes[i] + axes[j]) - _f(axes[i] - axes[j]) -
+          _f(-axes[i] + axes[j]) + _f(-axes[i] - axes[j])) /
+        (4 * steps[i] * steps[j]));
+    }
+    return result;
+  }
+
+  /// \brief Update the tangent expansions of the FAST accuracy after the
+  /// reference changed.
+  /// \param[in,out] _d Spherical coordinates data.
+  void UpdateTangentExpansions(SphericalCoordinatesPrivate &_d)
+  {
+    _d.tangentRadius = 0;
+    if (_d.accuracy != SphericalCoordinates::FAST)
+      return;
+
+    // The error of the expansions grows with the cube of the distance to
+    // the origin, divided by the square of the distance to the polar axis,
+    // since longitude varies fastest there. The radius keeps it below
+    // kTangentTolerance.
+    const double axis =
+      sqrt(_d.origin.X() * _d.origin.X() + _d.origin.Y() * _d.origin.Y());
+    const double radius = std::min(kMaxTangentRadius,
+        std::cbrt(kTangentTolerance * axis * axis));
+    if (radius < kMinTangentRadius)
+      return;
+
+    const double lat = _d.latitudeReference.Radian();
+    const double lon = _d.longitudeReference.Radian();
+    const double elevation = _d.elevationReference;
+    const double step = kTangentStep;
+
+    _d.globalToSpherical = Expand([&](const Vector3d &_global)
+        {
+          const Vector3d pos = TransformPosition(_d, _global,
+              SphericalCoordinates::GLOBAL, SphericalCoordinates::SPHERICAL,
+              false);
+          return Vector3d(pos.X() - lat,
+              std::remainder(pos.Y() - lon, 2 * IGN_PI),
+              pos.Z() - elevation);
+        }, Vector3d(step, step, step));
+
+    _d.sphericalToGlobal = Expand([&](const Vector3d &_offset)
+        {
+          return TransformPosition(_d,
+              Vector3d(lat + _offset.X(), lon + _offset.Y(),
+                elevation + _offset.Z()),
+              SphericalCoordinates::SPHERICAL, SphericalCoordinates::GLOBAL,
+              false);
+        }, Vector3d(step / _d.ellA, step / axis, step));
+
+    _d.tangentRadius = radius;
+  }
+
+  /// \brief Check if two values of a cache key have the same bits.
+  /// \param[in] _a First value.
+  /// \param[in] _b Second value.
+  /// \return True if the bits are the same.
+  bool SameBits(const double _a, const double _b)
+  {
+    return std::memcmp(&_a, &_b, sizeof(double)) == 0;
+  }
+
+  /// \brief Check if a cached origin matches the reference.
+  /// \param[in] _d Spherical coordinates data.
+  /// \param[in] _c Cached origin.
+  /// \return True if the transformation of _c is the one of _d.
+  bool Matches(const SphericalCoordinatesPrivate &_d, const CachedOrigin &_c)
+  {
+    return _c.surfaceType == _d.surfaceType && _c.accuracy == _d.accuracy &&
+      SameBits(_c.latitude, _d.latitudeReference.Radian()) &&
+      SameBits(_c.longitude, _d.longitudeReference.Radian()) &&
+      SameBits(_c.elevation, _d.elevationReference) &&
+      SameBits(_c.heading, _d.headingOffset.Radian());
+  }
+
+  /// \brief Compute the transformation matrices, the ECEF position of the
+  /// origin and the tangent expansions for the reference, or take them
+  /// from the cache of recently used origins.
+  /// \param[in,out] _d Spherical coordinates data.
+  void UpdateTransformation(SphericalCoordinatesPrivate &_d)
+  {
+    for (auto it = _d.originCache.begin(); it != _d.originCache.end(); ++it)
+    {
+      if (!Matches(_d, *it))
+        continue;
+      _d.rotECEFToGlobal = it->rotECEFToGlobal;
+      _d.rotGlobalToECEF = it->rotGlobalToECEF;
+      _d.origin = it->origin;
+      _d.cosHea = it->cosHea;
+      _d.sinHea = it->sinHea;
+      _d.globalToSpherical = it->globalToSpherical;
+      _d.sphericalToGlobal = it->sphericalToGlobal;
+      _d.tangentRadius = it->tangentRadius;
+      std::rotate(_d.originCache.begin(), it, it + 1);
+      return;
+    }
+
+    // Cache trig results
+    double cosLat = cos(_d.latitudeReference.Radian());
+    double sinLat = sin(_d.latitudeReference.Radian());
+    double cosLon = cos(_d.longitudeReference.Radian());
+    double sinLon = sin(_d.longitudeReference.Radian());
+
+    // Create a rotation matrix that moves ECEF to GLOBAL
+    // http://www.navipedia.net/index.php/
+    // Transformations_between_ECEF_and_ENU_coordinates
+    _d.rotECEFToGlobal = Matrix3d(
+                        -sinLon,           cosLon,          0.0,
+                        -cosLon * sinLat, -sinLon * sinLat, cosLat,
+                         cosLon * cosLat,  sinLon * cosLat, sinLat);
+
+    // Create a rotation matrix that moves GLOBAL to ECEF
+    // http://www.navipedia.net/index.php/
+    // Transformations_between_ECEF_and_ENU_coordinates
+    _d.rotGlobalToECEF = Matrix3d(
+                        -sinLon, -cosLon * sinLat, cosLon * cosLat,
+                         cosLon, -sinLon * sinLat, sinLon * cosLat,
+                         0,      cosLat,           sinLat);
+
+    // Cache heading transforms -- note that we have to negate the heading
+    // in order to preserve backward compatibility. ie. Gazebo has
+    // traditionally expressed positive angle as a CLOCKWISE rotation that
+    // takes the GLOBAL frame to the LOCAL frame. However, right hand
+    // coordinate systems require this to be expressed as an ANTI-CLOCKWISE
+    // rotation. So, we negate it.
+    _d.cosHea = cos(-_d.headingOffset.Radian());
+    _d.sinHea = sin(-_d.headingOffset.Radian());
+
+    // Cache the ECEF coordinate of the origin
+    _d.origin = Vector3d(
+      _d.latitudeReference.Radian(),
+      _d.longitudeReference.Radian(),
+      _d.elevationReference);
+    _d.origin = TransformPosition(_d, _d.origin,
+        SphericalCoordinates::SPHERICAL, SphericalCoordinates::ECEF, false);
+
+    UpdateTangentExpansions(_d);
+
+    if (_d.originCacheSize == 0)
+      return;
+    if (_d.originCache.size() >= _d.originCacheSize)
+      _d.originCache.pop_back();
+    CachedOrigin entry;
+    entry.surfaceType = _d.surfaceType;
+    entry.accuracy = _d.accuracy;
+    entry.latitude = _d.latitudeReference.Radian();
+    entry.longitude = _d.longitudeReference.Radian();
+    entry.elevation = _d.elevationReference;
+    entry.heading = _d.headingOffset.Radian();
+    entry.rotECEFToGlobal = _d.rotECEFToGlobal;
+    entry.rotGlobalToECEF = _d.rotGlobalToECEF;
+    entry.origin = _d.origin;
+    entry.cosHea = _d.cosHea;
+    entry.sinHea = _d.sinHea;
+    entry.globalToSpherical = _d.globalToSpherical;
+    entry.sphericalToGlobal = _d.sphericalToGlobal;
+    entry.tangentRadius = _d.tangentRadius;
+    _d.originCache.insert(_d.originCache.begin(), entry);
+  }
+
+  /// \brief Compute the transformation if the reference changed since it
+  /// was last computed. The setters only mark it as changed, so setting
+  /// several parts of the reference computes it once, on the next
+  /// conversion.
+  /// \param[in,out] _d Spherical coordinates data.
+  void EnsureUpdated(SphericalCoordinatesPrivate &_d)
+  {
+    if (!_d.dirty.load(std::memory_order_acquire))
+      return;
+    std::lock_guard<std::mutex> lock(_d.updateMutex);
+    if (_d.dirty.load(std::memory_order_relaxed))
+    {
+      UpdateTransformation(_d);
+      _d.dirty.store(false, std::memory_order_release);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 SphericalCoordinates::SurfaceType SphericalCoordinates::Convert(
   const std::string &_str)
@@ -94,8 +1142,8 @@ SphericalCoordinates::SurfaceType SphericalCoordinates::Convert(
   if ("EARTH_WGS84" == _str)
     return EARTH_WGS84;
 
-  std::cerr << "SurfaceType string not recognized, "
-    << "EARTH_WGS84 returned by default" << std::endl;
+  IGN_MATH_DIAGNOSTIC("SurfaceType string not recognized, "
+      << "EARTH_WGS84 returned by default");
   return EARTH_WGS84;
 }
 
@@ -106,8 +1154,8 @@ std::string SphericalCoordinates::Convert(
   if (_type == EARTH_WGS84)
     return "EARTH_WGS84";
 
-  std::cerr << "SurfaceType not recognized, "
-    << "EARTH_WGS84 returned by default" << std::endl;
+  IGN_MATH_DIAGNOSTIC("SurfaceType not recognized, "
+      << "EARTH_WGS84 returned by default");
   return "EARTH_WGS84";
 }
 
@@ -143,9 +1191,6 @@ SphericalCoordinates::SphericalCoordinates(const SurfaceType _type,
   this->dataPtr->longitudeReference = _longitude;
   this->dataPtr->elevationReference = _elevation;
   this->dataPtr->headingOffset = _heading;
-
-  // Generate transformation matrix
-  this->UpdateTransformationMatrix();
 }
 
 //////////////////////////////////////////////////
@@ -223,11 +1268,12 @@ void SphericalCoordinates::SetSurface(const SurfaceType &_type)
       }
     default:
       {
-        std::cerr << "Unknown surface type["
-          << this->dataPtr->surfaceType << "]\n";
+        IGN_MATH_DIAGNOSTIC("Unknown surface type["
+            << this->dataPtr->surfaceType << "]");
       break;
       }
   }
+  this->dataPtr->dirty = true;
 }
 
 //////////////////////////////////////////////////
@@ -235,7 +1281,7 @@ void SphericalCoordinates::SetLatitudeReference(
     const Angle &_angle)
 {
   this->dataPtr->latitudeReference = _angle;
-  this->UpdateTransformationMatrix();
+  this->dataPtr->dirty = true;
 }
 
 //////////////////////////////////////////////////
@@ -243,21 +1289,47 @@ void SphericalCoordinates::SetLongitudeReference(
     const Angle &_angle)
 {
   this->dataPtr->longitudeReference = _angle;
-  this->UpdateTransformationMatrix();
+  this->dataPtr->dirty = true;
 }
 
 //////////////////////////////////////////////////
 void SphericalCoordinates::SetElevationReference(const double _elevation)
 {
   this->dataPtr->elevationReference = _elevation;
-  this->UpdateTransformationMatrix();
+  this->dataPtr->dirty = true;
 }
 
 //////////////////////////////////////////////////
 void SphericalCoordinates::SetHeadingOffset(const Angle &_angle)
 {
   this->dataPtr->headingOffset.Radian(_angle.Radian());
-  this->UpdateTransformationMatrix();
+  this->dataPtr->dirty = true;
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::SetOrigin(const Angle &_latitude,
+    const Angle &_longitude, const double _elevation, const Angle &_heading)
+{
+  this->dataPtr->latitudeReference = _latitude;
+  this->dataPtr->longitudeReference = _longitude;
+  this->dataPtr->elevationReference = _elevation;
+  this->dataPtr->headingOffset.Radian(_heading.Radian());
+  this->dataPtr->dirty = true;
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::SetOriginCacheSize(const std::size_t _size)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->updateMutex);
+  this->dataPtr->originCacheSize = _size;
+  if (this->dataPtr->originCache.size() > _size)
+    this->dataPtr->originCache.resize(_size);
+}
+
+//////////////////////////////////////////////////
+std::size_t SphericalCoordinates::OriginCacheSize() const
+{
+  return this->dataPtr->originCacheSize;
 }
 
 //////////////////////////////////////////////////
@@ -314,46 +1386,64 @@ double SphericalCoordinates::Distance(const Angle &_latA,
   return d;
 }
 
+//////////////////////////////////////////////////
+bool SphericalCoordinates::Distance(const Angle &_latA,
+                                    const Angle &_lonA,
+                                    const std::vector<double> &_latB,
+                                    const std::vector<double> &_lonB,
+                                    std::vector<double> &_distances)
+{
+  IGN_MATH_TRACE_ZONE("SphericalCoordinates::Distance");
+  if (_latB.size() != _lonB.size())
+    return false;
+
+  std::vector<HaversineChunk> chunks = HaversineChunks(_latB, _lonB);
+  _distances.resize(_latB.size());
+  HaversineRows(_latA.Radian(), _lonA.Radian(), chunks, _latB.size(),
+      _distances.data());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SphericalCoordinates::Distance(const std::vector<double> &_latA,
+                                    const std::vector<double> &_lonA,
+                                    const std::vector<double> &_latB,
+                                    const std::vector<double> &_lonB,
+                                    std::vector<double> &_distances)
+{
+  IGN_MATH_TRACE_ZONE("SphericalCoordinates::Distance");
+  if (_latA.size() != _lonA.size() || _latB.size() != _lonB.size())
+    return false;
+
+  std::vector<HaversineChunk> chunks = HaversineChunks(_latB, _lonB);
+  _distances.resize(_latA.size() * _latB.size());
+  for (std::size_t i = 0; i < _latA.size(); ++i)
+  {
+    HaversineRows(_latA[i], _lonA[i], chunks, _latB.size(),
+        _distances.data() + i * _latB.size());
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 void SphericalCoordinates::UpdateTransformationMatrix()
 {
-  // Cache trig results
-  double cosLat = cos(this->dataPtr->latitudeReference.Radian());
-  double sinLat = sin(this->dataPtr->latitudeReference.Radian());
-  double cosLon = cos(this->dataPtr->longitudeReference.Radian());
-  double sinLon = sin(this->dataPtr->longitudeReference.Radian());
-
-  // Create a rotation matrix that moves ECEF to GLOBAL
-  // http://www.navipedia.net/index.php/
-  // Transformations_between_ECEF_and_ENU_coordinates
-  this->dataPtr->rotECEFToGlobal = Matrix3d(
-                      -sinLon,           cosLon,          0.0,
-                      -cosLon * sinLat, -sinLon * sinLat, cosLat,
-                       cosLon * cosLat,  sinLon * cosLat, sinLat);
-
-  // Create a rotation matrix that moves GLOBAL to ECEF
-  // http://www.navipedia.net/index.php/
-  // Transformations_between_ECEF_and_ENU_coordinates
-  this->dataPtr->rotGlobalToECEF = Matrix3d(
-                      -sinLon, -cosLon * sinLat, cosLon * cosLat,
-                       cosLon, -sinLon * sinLat, sinLon * cosLat,
-                       0,      cosLat,           sinLat);
-
-  // Cache heading transforms -- note that we have to negate the heading in
-  // order to preserve backward compatibility. ie. Gazebo has traditionally
-  // expressed positive angle as a CLOCKWISE rotation that takes the GLOBAL
-  // frame to the LOCAL frame. However, right hand coordinate systems require
-  // this to be expressed as an ANTI-CLOCKWISE rotation. So, we negate it.
-  this->dataPtr->cosHea = cos(-this->dataPtr->headingOffset.Radian());
-  this->dataPtr->sinHea = sin(-this->dataPtr->headingOffset.Radian());
-
-  // Cache the ECEF coordinate of the origin
-  this->dataPtr->origin = Vector3d(
-    this->dataPtr->latitudeReference.Radian(),
-    this->dataPtr->longitudeReference.Radian(),
-    this->dataPtr->elevationReference);
-  this->dataPtr->origin =
-    this->PositionTransform(this->dataPtr->origin, SPHERICAL, ECEF);
+  std::lock_guard<std::mutex> lock(this->dataPtr->updateMutex);
+  UpdateTransformation(*this->dataPtr);
+  this->dataPtr->dirty.store(false, std::memory_order_release);
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::SetAccuracy(const AccuracyType &_accuracy)
+{
+  this->dataPtr->accuracy = _accuracy;
+  this->dataPtr->dirty = true;
+}
+
+//////////////////////////////////////////////////
+SphericalCoordinates::AccuracyType SphericalCoordinates::Accuracy() const
+{
+  return this->dataPtr->accuracy;
 }
 
 /////////////////////////////////////////////////
@@ -361,134 +1451,125 @@ Vector3d SphericalCoordinates::PositionTransform(
     const Vector3d &_pos,
     const CoordinateType &_in, const CoordinateType &_out) const
 {
-  Vector3d tmp = _pos;
-
-  // Cache trig results
-  double cosLat = cos(_pos.X());
-  double sinLat = sin(_pos.X());
-  double cosLon = cos(_pos.Y());
-  double sinLon = sin(_pos.Y());
-
-  // Radius of planet curvature (meters)
-  double curvature = 1.0 -
-    this->dataPtr->ellE * this->dataPtr->ellE * sinLat * sinLat;
-  curvature = this->dataPtr->ellA / sqrt(curvature);
+  EnsureUpdated(*this->dataPtr);
+  if (this->dataPtr->accuracy == FAST)
+    return FastTransformPosition(*this->dataPtr, _pos, _in, _out);
+  return TransformPosition(*this->dataPtr, _pos, _in, _out, false);
+}
 
-  // Convert whatever arrives to a more flexible ECEF coordinate
-  switch (_in)
+//////////////////////////////////////////////////
+bool SphericalCoordinates::PositionTransform(
+    const std::vector<Vector3d> &_pos,
+    const CoordinateType &_in, const CoordinateType &_out,
+    std::vector<Vector3d> &_result) const
+{
+  IGN_MATH_TRACE_ZONE("SphericalCoordinates::PositionTransform");
+  EnsureUpdated(*this->dataPtr);
+  if (!ValidPositionType(_in) || !ValidPositionType(_out))
   {
-    // East, North, Up (ENU), note no break at end of case
-    case LOCAL:
-      {
-        tmp.X(-_pos.X() * this->dataPtr->cosHea + _pos.Y() *
-            this->dataPtr->sinHea);
-        tmp.Y(-_pos.X() * this->dataPtr->sinHea - _pos.Y() *
-            this->dataPtr->cosHea);
-        tmp = this->dataPtr->origin + this->dataPtr->rotGlobalToECEF * tmp;
-        break;
-      }
-
-    case LOCAL2:
-      {
-        tmp.X(_pos.X() * this->dataPtr->cosHea + _pos.Y() *
-            this->dataPtr->sinHea);
-        tmp.Y(-_pos.X() * this->dataPtr->sinHea + _pos.Y() *
-            this->dataPtr->cosHea);
-        tmp = this->dataPtr->origin + this->dataPtr->rotGlobalToECEF * tmp;
-        break;
-      }
+    if (!ValidPositionType(_in))
+      IGN_MATH_DIAGNOSTIC("Invalid coordinate type[" << _in << "]");
+    else
+      IGN_MATH_DIAGNOSTIC("Unknown coordinate type[" << _out << "]");
+    if (&_result != &_pos)
+      _result = _pos;
+    return false;
+  }
 
-    case GLOBAL:
-      {
-        tmp = this->dataPtr->origin + this->dataPtr->rotGlobalToECEF * tmp;
-        break;
-      }
+  // Each chunk is copied out of _pos before its results are written, so
+  // _result may be the same object.
+  _result.resize(_pos.size());
 
-    case SPHERICAL:
-      {
-        tmp.X((_pos.Z() + curvature) * cosLat * cosLon);
-        tmp.Y((_pos.Z() + curvature) * cosLat * sinLon);
-        tmp.Z(((this->dataPtr->ellB * this->dataPtr->ellB)/
-              (this->dataPtr->ellA * this->dataPtr->ellA) *
-              curvature + _pos.Z()) * sinLat);
-        break;
-      }
-
-    // Do nothing
-    case ECEF:
-      break;
-    default:
-      {
-        std::cerr << "Invalid coordinate type[" << _in << "]\n";
-        return _pos;
-      }
+  // The FAST accuracy converts each position on its own, since those near
+  // the origin evaluate the tangent expansions.
+  if (this->dataPtr->accuracy == FAST &&
+      (_in == SPHERICAL || _out == SPHERICAL))
+  {
+    for (std::size_t i = 0; i < _pos.size(); ++i)
+      _result[i] = FastTransformPosition(*this->dataPtr, _pos[i], _in, _out);
+    return true;
   }
 
-  // Convert ECEF to the requested output coordinate system
-  switch (_out)
+  PositionChunk chunk;
+  for (std::size_t start = 0; start < _pos.size(); start += kChunkSize)
   {
-    case SPHERICAL:
-      {
-        // Convert from ECEF to SPHERICAL
-        double p = sqrt(tmp.X() * tmp.X() + tmp.Y() * tmp.Y());
-        double theta = atan((tmp.Z() * this->dataPtr->ellA) /
-            (p * this->dataPtr->ellB));
-
-        // Calculate latitude and longitude
-        double lat = atan(
-            (tmp.Z() + std::pow(this->dataPtr->ellP, 2) * this->dataPtr->ellB *
-             std::pow(sin(theta), 3)) /
-            (p - std::pow(this->dataPtr->ellE, 2) *
-             this->dataPtr->ellA * std::pow(cos(theta), 3)));
-
-        double lon = atan2(tmp.Y(), tmp.X());
-
-        // Recalculate radius of planet curvature at the current latitude.
-        double nCurvature = 1.0 - std::pow(this->dataPtr->ellE, 2) *
-          std::pow(sin(lat), 2);
-        nCurvature = this->dataPtr->ellA / sqrt(nCurvature);
-
-        tmp.X(lat);
-        tmp.Y(lon);
-
-        // Now calculate Z
-        tmp.Z(p/cos(lat) - nCurvature);
-        break;
-      }
-
-    // Convert from ECEF TO GLOBAL
-    case GLOBAL:
-      tmp = this->dataPtr->rotECEFToGlobal * (tmp - this->dataPtr->origin);
-      break;
-
-    // Convert from ECEF TO LOCAL
-    case LOCAL:
-    case LOCAL2:
-      tmp = this->dataPtr->rotECEFToGlobal * (tmp - this->dataPtr->origin);
+    const std::size_t n = std::min(kChunkSize, _pos.size() - start);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      const Vector3d &p = _pos[start + i];
+      chunk.x[i] = p.X();
+      chunk.y[i] = p.Y();
+      chunk.z[i] = p.Z();
+    }
+    for (std::size_t i = n; i < kChunkSize; ++i)
+      chunk.x[i] = chunk.y[i] = chunk.z[i] = 0.0;
+    TransformChunk(*this->dataPtr, chunk, n, _in, _out);
+    for (std::size_t i = 0; i < n; ++i)
+      _result[start + i].Set(chunk.x[i], chunk.y[i], chunk.z[i]);
+  }
+  return true;
+}
 
-      tmp = Vector3d(
-          tmp.X() * this->dataPtr->cosHea - tmp.Y() * this->dataPtr->sinHea,
-          tmp.X() * this->dataPtr->sinHea + tmp.Y() * this->dataPtr->cosHea,
-          tmp.Z());
-      break;
+/////////////////////////////////////////////////
+bool SphericalCoordinates::PositionTransform(
+    const Vector3SoA<double> &_pos,
+    const CoordinateType &_in, const CoordinateType &_out,
+    Vector3SoA<double> &_result) const
+{
+  IGN_MATH_TRACE_ZONE("SphericalCoordinates::PositionTransform");
+  EnsureUpdated(*this->dataPtr);
+  if (!ValidPositionType(_in) || !ValidPositionType(_out))
+  {
+    if (!ValidPositionType(_in))
+      IGN_MATH_DIAGNOSTIC("Invalid coordinate type[" << _in << "]");
+    else
+      IGN_MATH_DIAGNOSTIC("Unknown coordinate type[" << _out << "]");
+    if (&_result != &_pos)
+      _result = _pos;
+    return false;
+  }
 
-    // Return ECEF (do nothing)
-    case ECEF:
-      break;
+  // Each chunk is copied out of _pos before its results are written, so
+  // _result may be the same object.
+  _result.Resize(_pos.Size());
 
-    default:
-      std::cerr << "Unknown coordinate type[" << _out << "]\n";
-      return _pos;
+  // The FAST accuracy converts each position on its own, since those near
+  // the origin evaluate the tangent expansions.
+  if (this->dataPtr->accuracy == FAST &&
+      (_in == SPHERICAL || _out == SPHERICAL))
+  {
+    for (std::size_t i = 0; i < _pos.Size(); ++i)
+    {
+      _result.Set(i,
+          FastTransformPosition(*this->dataPtr, _pos[i], _in, _out));
+    }
+    return true;
   }
 
-  return tmp;
+  PositionChunk chunk;
+  for (std::size_t start = 0; start < _pos.Size(); start += kChunkSize)
+  {
+    const std::size_t n = std::min(kChunkSize, _pos.Size() - start);
+    const std::size_t bytes = n * sizeof(double);
+    std::memcpy(chunk.x, _pos.XData() + start, bytes);
+    std::memcpy(chunk.y, _pos.YData() + start, bytes);
+    std::memcpy(chunk.z, _pos.ZData() + start, bytes);
+    for (std::size_t i = n; i < kChunkSize; ++i)
+      chunk.x[i] = chunk.y[i] = chunk.z[i] = 0.0;
+    TransformChunk(*this->dataPtr, chunk, n, _in, _out);
+    std::memcpy(_result.XData() + start, chunk.x, bytes);
+    std::memcpy(_result.YData() + start, chunk.y, bytes);
+    std::memcpy(_result.ZData() + start, chunk.z, bytes);
+  }
+  return true;
 }
 
-//////////////////////////////////////////////////
+/////////////////////////////////////////////////
 Vector3d SphericalCoordinates::VelocityTransform(
     const Vector3d &_vel,
     const CoordinateType &_in, const CoordinateType &_out) const
 {
+  EnsureUpdated(*this->dataPtr);
   // Sanity check -- velocity should not be expressed in spherical coordinates
   if (_in == SPHERICAL || _out == SPHERICAL)
   {
@@ -525,7 +1606,7 @@ Vector3d SphericalCoordinates::VelocityTransform(
       tmp = _vel;
       break;
     default:
-      std::cerr << "Unknown coordinate type[" << _in << "]\n";
+      IGN_MATH_DIAGNOSTIC("Unknown coordinate type[" << _in << "]");
       return _vel;
   }
 
@@ -552,13 +1633,115 @@ Vector3d SphericalCoordinates::VelocityTransform(
       break;
 
     default:
-      std::cerr << "Unknown coordinate type[" << _out << "]\n";
+      IGN_MATH_DIAGNOSTIC("Unknown coordinate type[" << _out << "]");
       return _vel;
   }
 
   return tmp;
 }
 
+//////////////////////////////////////////////////
+bool SphericalCoordinates::VelocityTransform(
+    const std::vector<Vector3d> &_vel,
+    const CoordinateType &_in, const CoordinateType &_out,
+    std::vector<Vector3d> &_result) const
+{
+  IGN_MATH_TRACE_ZONE("SphericalCoordinates::VelocityTransform");
+  EnsureUpdated(*this->dataPtr);
+  Matrix3d m;
+  if (!VelocityRotation(*this->dataPtr, _in, _out, m))
+  {
+    if (!ValidPositionType(_in))
+      IGN_MATH_DIAGNOSTIC("Unknown coordinate type[" << _in << "]");
+    else
+      IGN_MATH_DIAGNOSTIC("Unknown coordinate type[" << _out << "]");
+    if (&_result != &_vel)
+      _result = _vel;
+    return false;
+  }
+
+  const double m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+  const double m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+  const double m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+  _result.resize(_vel.size());
+  for (std::size_t i = 0; i < _vel.size(); ++i)
+  {
+    const double x = _vel[i].X();
+    const double y = _vel[i].Y();
+    const double z = _vel[i].Z();
+    _result[i].Set(m00 * x + m01 * y + m02 * z,
+                   m10 * x + m11 * y + m12 * z,
+                   m20 * x + m21 * y + m22 * z);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SphericalCoordinates::VelocityTransform(
+    const Vector3SoA<double> &_vel,
+    const CoordinateType &_in, const CoordinateType &_out,
+    Vector3SoA<double> &_result) const
+{
+  IGN_MATH_TRACE_ZONE("SphericalCoordinates::VelocityTransform");
+  EnsureUpdated(*this->dataPtr);
+  Matrix3d m;
+  if (!VelocityRotation(*this->dataPtr, _in, _out, m))
+  {
+    if (!ValidPositionType(_in))
+      IGN_MATH_DIAGNOSTIC("Unknown coordinate type[" << _in << "]");
+    else
+      IGN_MATH_DIAGNOSTIC("Unknown coordinate type[" << _out << "]");
+    if (&_result != &_vel)
+      _result = _vel;
+    return false;
+  }
+
+  const double m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+  const double m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+  const double m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+  const std::size_t n = _vel.Size();
+  _result.Resize(n);
+  const double *vx = _vel.XData(), *vy = _vel.YData(), *vz = _vel.ZData();
+  double *rx = _result.XData(), *ry = _result.YData(), *rz = _result.ZData();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const double x = vx[i];
+    const double y = vy[i];
+    const double z = vz[i];
+    rx[i] = m00 * x + m01 * y + m02 * z;
+    ry[i] = m10 * x + m11 * y + m12 * z;
+    rz[i] = m20 * x + m21 * y + m22 * z;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::ConvertEnuNed(const std::vector<Vector3d> &_vec,
+    std::vector<Vector3d> &_result)
+{
+  _result.resize(_vec.size());
+  for (std::size_t i = 0; i < _vec.size(); ++i)
+    _result[i].Set(_vec[i].Y(), _vec[i].X(), -_vec[i].Z());
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::ConvertEnuNed(const Vector3SoA<double> &_vec,
+    Vector3SoA<double> &_result)
+{
+  const std::size_t n = _vec.Size();
+  _result.Resize(n);
+  const double *vx = _vec.XData(), *vy = _vec.YData(), *vz = _vec.ZData();
+  double *rx = _result.XData(), *ry = _result.YData(), *rz = _result.ZData();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const double x = vx[i];
+    const double y = vy[i];
+    rx[i] = y;
+    ry[i] = x;
+    rz[i] = -vz[i];
+  }
+}
+
 //////////////////////////////////////////////////
 bool SphericalCoordinates::operator==(const SphericalCoordinates &_sc) const
 {
@@ -580,13 +1763,9 @@ SphericalCoordinates &SphericalCoordinates::operator=(
   const SphericalCoordinates &_sc)
 {
   this->SetSurface(_sc.Surface());
-  this->SetLatitudeReference(_sc.LatitudeReference());
-  this->SetLongitudeReference(_sc.LongitudeReference());
-  this->SetElevationReference(_sc.ElevationReference());
-  this->SetHeadingOffset(_sc.HeadingOffset());
-
-  // Generate transformation matrix
-  this->UpdateTransformationMatrix();
+  this->SetOrigin(_sc.LatitudeReference(), _sc.LongitudeReference(),
+      _sc.ElevationReference(), _sc.HeadingOffset());
+  this->SetAccuracy(_sc.Accuracy());
 
   return *this;
 }
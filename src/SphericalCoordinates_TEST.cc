@@ -16,6 +16,11 @@
 */
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "gz/math/Rand.hh"
 #include "gz/math/SphericalCoordinates.hh"
 
 using namespace gz;
@@ -318,6 +323,72 @@ TEST(SphericalCoordinatesTest, Distance)
   EXPECT_NEAR(14002, d, 20);
 }
 
+//////////////////////////////////////////////////
+// Test that batch distances match the single pair distance
+TEST(SphericalCoordinatesTest, BatchDistance)
+{
+  math::Rand::Seed(1234);
+  auto randomPoints = [](std::size_t _count, std::vector<double> &_lat,
+      std::vector<double> &_lon)
+  {
+    _lat.clear();
+    _lon.clear();
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      _lat.push_back(math::Rand::DblUniform(-IGN_PI_2, IGN_PI_2));
+      _lon.push_back(math::Rand::DblUniform(-IGN_PI, IGN_PI));
+    }
+  };
+
+  // More points than a single chunk, with a partial last chunk.
+  std::vector<double> latA, lonA, latB, lonB;
+  randomPoints(30, latA, lonA);
+  randomPoints(600, latB, lonB);
+
+  // Include close and identical points.
+  latB[0] = latA[0];
+  lonB[0] = lonA[0];
+  latB[1] = latA[0] + 1e-7;
+  lonB[1] = lonA[0] - 1e-7;
+
+  std::vector<double> matrix;
+  EXPECT_TRUE(math::SphericalCoordinates::Distance(latA, lonA, latB, lonB,
+        matrix));
+  ASSERT_EQ(latA.size() * latB.size(), matrix.size());
+
+  std::vector<double> row;
+  for (std::size_t i = 0; i < latA.size(); ++i)
+  {
+    EXPECT_TRUE(math::SphericalCoordinates::Distance(math::Angle(latA[i]),
+          math::Angle(lonA[i]), latB, lonB, row));
+    ASSERT_EQ(latB.size(), row.size());
+    for (std::size_t j = 0; j < latB.size(); ++j)
+    {
+      const double expected = math::SphericalCoordinates::Distance(
+          math::Angle(latA[i]), math::Angle(lonA[i]),
+          math::Angle(latB[j]), math::Angle(lonB[j]));
+      EXPECT_NEAR(expected, row[j], 1e-6 * std::max(1.0, expected));
+      EXPECT_DOUBLE_EQ(row[j], matrix[i * latB.size() + j]);
+    }
+  }
+  EXPECT_DOUBLE_EQ(0.0, matrix[0]);
+  EXPECT_NEAR(math::SphericalCoordinates::Distance(
+        math::Angle(latA[0]), math::Angle(lonA[0]),
+        math::Angle(latB[1]), math::Angle(lonB[1])), matrix[1], 1e-6);
+
+  // Sizes must match.
+  lonB.pop_back();
+  EXPECT_FALSE(math::SphericalCoordinates::Distance(latA, lonA, latB, lonB,
+        matrix));
+  EXPECT_FALSE(math::SphericalCoordinates::Distance(math::Angle(),
+        math::Angle(), latB, lonB, row));
+
+  // Empty sets.
+  EXPECT_TRUE(math::SphericalCoordinates::Distance(latA, lonA, {}, {},
+        matrix));
+  EXPECT_TRUE(matrix.empty());
+}
+
 //////////////////////////////////////////////////
 TEST(SphericalCoordinatesTest, BadSetSurface)
 {
@@ -667,3 +738,344 @@ TEST(SphericalCoordinatesTest, Inverse)
     EXPECT_EQ(in, reverse);
   }
 }
+
+//////////////////////////////////////////////////
+// Test that batch conversions match the single position conversions
+TEST(SphericalCoordinatesTest, BatchPositionTransform)
+{
+  math::SphericalCoordinates sc(math::SphericalCoordinates::EARTH_WGS84,
+      IGN_DTOR(-22.9068), IGN_DTOR(-43.1729), 10, IGN_DTOR(30));
+
+  const std::vector<math::SphericalCoordinates::CoordinateType> types = {
+    math::SphericalCoordinates::SPHERICAL,
+    math::SphericalCoordinates::ECEF,
+    math::SphericalCoordinates::GLOBAL,
+    math::SphericalCoordinates::LOCAL,
+    math::SphericalCoordinates::LOCAL2};
+
+  // More positions than a single chunk, with a partial last chunk.
+  math::Rand::Seed(1234);
+  std::vector<math::Vector3d> spherical;
+  for (int i = 0; i < 600; ++i)
+  {
+    spherical.push_back(math::Vector3d(
+        math::Rand::DblUniform(-1.5, 1.5),
+        math::Rand::DblUniform(-3.1, 3.1),
+        math::Rand::DblUniform(-100, 5000)));
+  }
+
+  for (auto in : types)
+  {
+    std::vector<math::Vector3d> input;
+    for (const auto &pos : spherical)
+    {
+      input.push_back(sc.PositionTransform(pos,
+          math::SphericalCoordinates::SPHERICAL, in));
+    }
+    const math::Vector3SoA<double> inputSoA(input);
+
+    for (auto out : types)
+    {
+      std::vector<math::Vector3d> result;
+      EXPECT_TRUE(sc.PositionTransform(input, in, out, result));
+      math::Vector3SoA<double> resultSoA;
+      EXPECT_TRUE(sc.PositionTransform(inputSoA, in, out, resultSoA));
+      ASSERT_EQ(input.size(), result.size());
+      ASSERT_EQ(input.size(), resultSoA.Size());
+
+      const double tol =
+        out == math::SphericalCoordinates::SPHERICAL ? 1e-9 : 1e-6;
+      for (std::size_t i = 0; i < input.size(); ++i)
+      {
+        const math::Vector3d expected = sc.PositionTransform(input[i], in, out);
+        const double zTol = tol * (out == math::SphericalCoordinates::SPHERICAL
+            ? 1e3 : 1.0);
+        EXPECT_NEAR(expected.X(), result[i].X(), tol);
+        EXPECT_NEAR(expected.Y(), result[i].Y(), tol);
+        EXPECT_NEAR(expected.Z(), result[i].Z(), zTol);
+        EXPECT_NEAR(expected.X(), resultSoA[i].X(), tol);
+        EXPECT_NEAR(expected.Y(), resultSoA[i].Y(), tol);
+        EXPECT_NEAR(expected.Z(), resultSoA[i].Z(), zTol);
+      }
+    }
+  }
+
+  // The output may alias the input.
+  std::vector<math::Vector3d> aliased = spherical;
+  EXPECT_TRUE(sc.PositionTransform(aliased,
+      math::SphericalCoordinates::SPHERICAL,
+      math::SphericalCoordinates::LOCAL, aliased));
+  EXPECT_EQ(sc.PositionTransform(spherical[0],
+      math::SphericalCoordinates::SPHERICAL,
+      math::SphericalCoordinates::LOCAL), aliased[0]);
+
+  // Invalid types leave a copy of the input.
+  std::vector<math::Vector3d> result;
+  EXPECT_FALSE(sc.PositionTransform(spherical,
+      static_cast<math::SphericalCoordinates::CoordinateType>(7),
+      math::SphericalCoordinates::ECEF, result));
+  EXPECT_EQ(spherical, result);
+  math::Vector3SoA<double> resultSoA;
+  EXPECT_FALSE(sc.PositionTransform(math::Vector3SoA<double>(spherical),
+      math::SphericalCoordinates::ECEF,
+      static_cast<math::SphericalCoordinates::CoordinateType>(7),
+      resultSoA));
+  EXPECT_EQ(math::Vector3SoA<double>(spherical), resultSoA);
+}
+
+//////////////////////////////////////////////////
+// Test that the FAST accuracy stays within its error bound
+TEST(SphericalCoordinatesTest, FastAccuracy)
+{
+  math::SphericalCoordinates sc;
+  EXPECT_EQ(math::SphericalCoordinates::PRECISE, sc.Accuracy());
+  sc.SetAccuracy(math::SphericalCoordinates::FAST);
+  EXPECT_EQ(math::SphericalCoordinates::FAST, sc.Accuracy());
+  math::SphericalCoordinates copy(sc);
+  EXPECT_EQ(math::SphericalCoordinates::FAST, copy.Accuracy());
+
+  math::Rand::Seed(1234);
+  for (double latitude : {0.0, 45.0, -70.0, 85.0, 90.0})
+  {
+    math::SphericalCoordinates precise(
+        math::SphericalCoordinates::EARTH_WGS84, IGN_DTOR(latitude),
+        IGN_DTOR(179.99), 100, IGN_DTOR(30));
+    math::SphericalCoordinates fast(precise);
+    fast.SetAccuracy(math::SphericalCoordinates::FAST);
+
+    // Positions near the reference, which use the tangent expansions, and
+    // far from it.
+    for (double distance : {2000.0, 100000.0})
+    {
+      std::vector<math::Vector3d> local;
+      for (int i = 0; i < 200; ++i)
+      {
+        local.push_back(math::Vector3d(
+              math::Rand::DblUniform(-1, 1),
+              math::Rand::DblUniform(-1, 1),
+              math::Rand::DblUniform(-0.1, 0.1)) * distance);
+      }
+
+      std::vector<math::Vector3d> spherical;
+      EXPECT_TRUE(fast.PositionTransform(local,
+          math::SphericalCoordinates::LOCAL2,
+          math::SphericalCoordinates::SPHERICAL, spherical));
+      for (std::size_t i = 0; i < local.size(); ++i)
+      {
+        // Compare the positions in meters.
+        const math::Vector3d expected = precise.PositionTransform(local[i],
+            math::SphericalCoordinates::LOCAL2,
+            math::SphericalCoordinates::ECEF);
+        const math::Vector3d result = precise.PositionTransform(
+            spherical[i], math::SphericalCoordinates::SPHERICAL,
+            math::SphericalCoordinates::ECEF);
+        EXPECT_NEAR(0, (expected - result).Length(), 1e-3);
+        EXPECT_EQ(fast.PositionTransform(local[i],
+            math::SphericalCoordinates::LOCAL2,
+            math::SphericalCoordinates::SPHERICAL), spherical[i]);
+
+        const math::Vector3d back = fast.PositionTransform(spherical[i],
+            math::SphericalCoordinates::SPHERICAL,
+            math::SphericalCoordinates::LOCAL2);
+        EXPECT_NEAR(0, (precise.PositionTransform(spherical[i],
+            math::SphericalCoordinates::SPHERICAL,
+            math::SphericalCoordinates::LOCAL2) - back).Length(), 1e-3);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+// Test that setting the origin at once, or part by part, and the cache of
+// origins give the same conversions as a new object
+TEST(SphericalCoordinatesTest, SetOrigin)
+{
+  const math::Vector3d local(1500, -700, 20);
+  const math::Vector3d velocity(1, 2, 3);
+  auto expectSame = [&](const math::SphericalCoordinates &_a,
+                        const math::SphericalCoordinates &_b)
+  {
+    for (auto type : {math::SphericalCoordinates::SPHERICAL,
+                      math::SphericalCoordinates::ECEF,
+                      math::SphericalCoordinates::GLOBAL})
+    {
+      EXPECT_EQ(_a.PositionTransform(local,
+          math::SphericalCoordinates::LOCAL2, type),
+          _b.PositionTransform(local, math::SphericalCoordinates::LOCAL2,
+          type)) << type;
+    }
+    EXPECT_EQ(_a.VelocityTransform(velocity,
+        math::SphericalCoordinates::LOCAL, math::SphericalCoordinates::ECEF),
+        _b.VelocityTransform(velocity, math::SphericalCoordinates::LOCAL,
+        math::SphericalCoordinates::ECEF));
+  };
+
+  // Origins of neighboring tiles
+  std::vector<math::SphericalCoordinates> tiles;
+  for (int i = 0; i < 3; ++i)
+  {
+    tiles.push_back(math::SphericalCoordinates(
+        math::SphericalCoordinates::EARTH_WGS84, IGN_DTOR(37.0 + 0.01 * i),
+        IGN_DTOR(-122.0 - 0.02 * i), 10.0 * i, IGN_DTOR(5.0 * i)));
+  }
+
+  for (auto accuracy : {math::SphericalCoordinates::PRECISE,
+                        math::SphericalCoordinates::FAST})
+  {
+    for (auto &tile : tiles)
+      tile.SetAccuracy(accuracy);
+
+    // Part by part, converting between the parts
+    math::SphericalCoordinates sc;
+    sc.SetAccuracy(accuracy);
+    EXPECT_EQ(0u, sc.OriginCacheSize());
+    sc.SetLatitudeReference(tiles[1].LatitudeReference());
+    sc.PositionTransform(local, math::SphericalCoordinates::LOCAL2,
+        math::SphericalCoordinates::SPHERICAL);
+    sc.SetLongitudeReference(tiles[1].LongitudeReference());
+    sc.SetElevationReference(tiles[1].ElevationReference());
+    sc.SetHeadingOffset(tiles[1].HeadingOffset());
+    EXPECT_EQ(tiles[1], sc);
+    expectSame(tiles[1], sc);
+
+    // At once, with and without the cache, returning to cached origins
+    for (std::size_t cacheSize : {0u, 2u, 5u})
+    {
+      math::SphericalCoordinates cached;
+      cached.SetAccuracy(accuracy);
+      cached.SetOriginCacheSize(cacheSize);
+      EXPECT_EQ(cacheSize, cached.OriginCacheSize());
+      for (int i : {0, 1, 0, 2, 1, 1, 0, 2, 2})
+      {
+        const math::SphericalCoordinates &tile = tiles[i];
+        cached.SetOrigin(tile.LatitudeReference(), tile.LongitudeReference(),
+            tile.ElevationReference(), tile.HeadingOffset());
+        EXPECT_EQ(tile, cached);
+        expectSame(tile, cached);
+      }
+
+      // Shrinking the cache keeps the most recent origins
+      cached.SetOriginCacheSize(1);
+      EXPECT_EQ(1u, cached.OriginCacheSize());
+      cached.SetHeadingOffset(tiles[0].HeadingOffset());
+      math::SphericalCoordinates expected(
+          math::SphericalCoordinates::EARTH_WGS84,
+          tiles[2].LatitudeReference(), tiles[2].LongitudeReference(),
+          tiles[2].ElevationReference(), tiles[0].HeadingOffset());
+      expected.SetAccuracy(accuracy);
+      expectSame(expected, cached);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+// Test that concurrent conversions compute a changed origin once
+TEST(SphericalCoordinatesTest, LazyUpdateThreads)
+{
+  const math::SphericalCoordinates expected(
+      math::SphericalCoordinates::EARTH_WGS84, IGN_DTOR(-33.9),
+      IGN_DTOR(151.2), 40, IGN_DTOR(12));
+  const math::Vector3d local(-300, 800, 5);
+  const math::Vector3d result = expected.PositionTransform(local,
+      math::SphericalCoordinates::LOCAL, math::SphericalCoordinates::ECEF);
+
+  for (int r = 0; r < 20; ++r)
+  {
+    math::SphericalCoordinates sc;
+    sc.SetOrigin(expected.LatitudeReference(),
+        expected.LongitudeReference(), expected.ElevationReference(),
+        expected.HeadingOffset());
+    const math::SphericalCoordinates &constSc = sc;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+      threads.emplace_back([&]
+      {
+        EXPECT_EQ(result, constSc.PositionTransform(local,
+            math::SphericalCoordinates::LOCAL,
+            math::SphericalCoordinates::ECEF));
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+  }
+}
+
+//////////////////////////////////////////////////
+// Test that batch velocity transforms match the single velocity ones
+TEST(SphericalCoordinatesTest, BatchVelocityTransform)
+{
+  math::SphericalCoordinates sc(math::SphericalCoordinates::EARTH_WGS84,
+      IGN_DTOR(52.5), IGN_DTOR(13.4), 35, IGN_DTOR(-20));
+  std::vector<math::Vector3d> vel;
+  for (int i = 0; i < 50; ++i)
+    vel.push_back(math::Vector3d(i * 0.5 - 3, 2 - i * 0.1, 0.3 * i));
+  const math::Vector3SoA<double> velSoA(vel);
+
+  const auto invalid =
+    static_cast<math::SphericalCoordinates::CoordinateType>(7);
+  const std::vector<math::SphericalCoordinates::CoordinateType> types = {
+    math::SphericalCoordinates::SPHERICAL, math::SphericalCoordinates::ECEF,
+    math::SphericalCoordinates::GLOBAL, math::SphericalCoordinates::LOCAL,
+    math::SphericalCoordinates::LOCAL2};
+  std::vector<math::Vector3d> result;
+  math::Vector3SoA<double> resultSoA;
+  for (auto in : types)
+  {
+    for (auto out : types)
+    {
+      EXPECT_TRUE(sc.VelocityTransform(vel, in, out, result));
+      EXPECT_TRUE(sc.VelocityTransform(velSoA, in, out, resultSoA));
+      ASSERT_EQ(vel.size(), result.size());
+      ASSERT_EQ(vel.size(), resultSoA.Size());
+      for (std::size_t i = 0; i < vel.size(); ++i)
+      {
+        const math::Vector3d expected =
+          sc.VelocityTransform(vel[i], in, out);
+        EXPECT_NEAR(0, (expected - result[i]).Length(), 1e-12)
+          << in << " " << out << " " << i;
+        EXPECT_EQ(result[i], resultSoA[i]);
+      }
+    }
+  }
+
+  // In place
+  std::vector<math::Vector3d> inPlace = vel;
+  EXPECT_TRUE(sc.VelocityTransform(inPlace,
+      math::SphericalCoordinates::LOCAL, math::SphericalCoordinates::GLOBAL,
+      inPlace));
+  EXPECT_TRUE(sc.VelocityTransform(vel, math::SphericalCoordinates::LOCAL,
+      math::SphericalCoordinates::GLOBAL, result));
+  EXPECT_EQ(result, inPlace);
+
+  // Invalid types copy the input
+  EXPECT_FALSE(sc.VelocityTransform(vel, invalid,
+      math::SphericalCoordinates::GLOBAL, result));
+  EXPECT_EQ(vel, result);
+  EXPECT_FALSE(sc.VelocityTransform(velSoA,
+      math::SphericalCoordinates::ECEF, invalid, resultSoA));
+  EXPECT_EQ(velSoA, resultSoA);
+}
+
+//////////////////////////////////////////////////
+TEST(SphericalCoordinatesTest, ConvertEnuNed)
+{
+  const std::vector<math::Vector3d> enu = {
+    math::Vector3d(1, 2, 3), math::Vector3d(-4, 0.5, -6)};
+  std::vector<math::Vector3d> ned;
+  math::SphericalCoordinates::ConvertEnuNed(enu, ned);
+  ASSERT_EQ(2u, ned.size());
+  EXPECT_EQ(math::Vector3d(2, 1, -3), ned[0]);
+  EXPECT_EQ(math::Vector3d(0.5, -4, 6), ned[1]);
+
+  math::Vector3SoA<double> soa(enu);
+  math::Vector3SoA<double> nedSoA;
+  math::SphericalCoordinates::ConvertEnuNed(soa, nedSoA);
+  EXPECT_EQ(math::Vector3SoA<double>(ned), nedSoA);
+
+  // The conversion is its own inverse
+  math::SphericalCoordinates::ConvertEnuNed(ned, ned);
+  EXPECT_EQ(enu, ned);
+  math::SphericalCoordinates::ConvertEnuNed(nedSoA, nedSoA);
+  EXPECT_EQ(soa, nedSoA);
+}
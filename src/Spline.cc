@@ -17,22 +17,364 @@
 // Note: Originally cribbed from Ogre3d. Modified to implement Cardinal
 // spline and catmull-rom spline
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include "SplinePrivate.hh"
 #include "gz/math/Helpers.hh"
+#include "gz/math/Instrumentation.hh"
 #include "gz/math/Vector4.hh"
 #include "gz/math/Spline.hh"
 
 using namespace gz;
 using namespace math;
 
+namespace
+{
+  /// \brief Build the arc length table if the spline changed since it was
+  /// last built. Concurrent const queries build it only once.
+  /// \param[in,out] _d Spline data.
+  void UpdateArcLengthTable(SplineData &_d)
+  {
+    if (!_d.arcLengthTableDirty.load(std::memory_order_acquire))
+      return;
+
+    std::lock_guard<std::mutex> lock(_d.arcLengthTableMutex);
+    if (!_d.arcLengthTableDirty.load(std::memory_order_relaxed))
+      return;
+
+    _d.arcLengthTable.clear();
+    if (!_d.segments.empty())
+    {
+      const unsigned int samples = _d.arcLengthResolution;
+      _d.arcLengthTable.reserve(_d.segments.size() * samples + 1);
+      for (size_t i = 0; i < _d.segments.size(); ++i)
+      {
+        for (unsigned int j = 0; j < samples; ++j)
+        {
+          double length = _d.cumulativeArcLengths[i];
+          if (j > 0)
+            length += _d.segments[i].ArcLength(
+                static_cast<double>(j) / samples);
+
+          // Keep the table sorted even if the quadrature is not monotonic.
+          if (!_d.arcLengthTable.empty())
+            length = std::max(length, _d.arcLengthTable.back());
+          _d.arcLengthTable.push_back(length);
+        }
+      }
+      _d.arcLengthTable.push_back(
+          std::max(_d.arcLength, _d.arcLengthTable.back()));
+    }
+    _d.arcLengthTableDirty.store(false, std::memory_order_release);
+  }
+
+  /// \brief Build the bounds table if the spline changed since it was
+  /// last built. Concurrent const queries build it only once.
+  /// \param[in,out] _d Spline data.
+  void UpdateBoundsTable(SplineData &_d)
+  {
+    if (!_d.boundsTableDirty.load(std::memory_order_acquire))
+      return;
+
+    std::lock_guard<std::mutex> lock(_d.boundsTableMutex);
+    if (!_d.boundsTableDirty.load(std::memory_order_relaxed))
+      return;
+
+    const size_t numSegments = _d.segments.size();
+    const size_t blockSize = SplineData::kBoundsBlockSize;
+    const size_t numBlocks = (numSegments + blockSize - 1) / blockSize;
+    _d.boundsTable.resize(2 * (numSegments + numBlocks));
+    for (size_t i = 0; i < numSegments; ++i)
+    {
+      Vector3d &min = _d.boundsTable[2 * i];
+      Vector3d &max = _d.boundsTable[2 * i + 1];
+      _d.segments[i].Bounds(min, max);
+
+      const size_t block = numSegments + i / blockSize;
+      Vector3d &blockMin = _d.boundsTable[2 * block];
+      Vector3d &blockMax = _d.boundsTable[2 * block + 1];
+      if (i % blockSize == 0)
+      {
+        blockMin = min;
+        blockMax = max;
+      }
+      else
+      {
+        blockMin.Min(min);
+        blockMax.Max(max);
+      }
+    }
+    _d.boundsTableDirty.store(false, std::memory_order_release);
+  }
+
+  /// \brief Closest point found by a projection on the spline.
+  struct ClosestPoint
+  {
+    /// \brief Index of the segment of the point.
+    size_t index = 0;
+
+    /// \brief Parameter value fraction of the point on the segment.
+    double fraction = 0.0;
+
+    /// \brief Squared distance to the projected point.
+    double squaredDistance = INF_D;
+  };
+
+  /// \brief Get the squared distance from a point to a box.
+  /// \param[in] _point The point.
+  /// \param[in] _box Minimum and maximum corners of the box.
+  /// \return Squared distance, zero inside the box.
+  double SquaredDistanceToBox(const Vector3d &_point, const Vector3d *_box)
+  {
+    double result = 0.0;
+    for (int k = 0; k < 3; ++k)
+    {
+      const double outside = std::max(
+          std::max(_box[0][k] - _point[k], _point[k] - _box[1][k]), 0.0);
+      result += outside * outside;
+    }
+    return result;
+  }
+
+  /// \brief Project a point on a segment, unless its box shows that it
+  /// cannot be closer than the closest point found so far.
+  /// \param[in] _d Spline data with an up to date bounds table.
+  /// \param[in] _index Index of the segment.
+  /// \param[in] _point Point to project.
+  /// \param[in,out] _closest Closest point found so far.
+  void ProjectOnSegment(const SplineData &_d, const size_t _index,
+                        const Vector3d &_point, ClosestPoint &_closest)
+  {
+    if (!(SquaredDistanceToBox(_point, &_d.boundsTable[2 * _index]) <
+          _closest.squaredDistance))
+    {
+      return;
+    }
+
+    double squaredDistance;
+    const double fraction =
+        _d.segments[_index].ClosestParameter(_point, squaredDistance);
+    if (squaredDistance < _closest.squaredDistance)
+    {
+      _closest.index = _index;
+      _closest.fraction = fraction;
+      _closest.squaredDistance = squaredDistance;
+    }
+  }
+
+  /// \brief Convert a point of a segment to a parameter value over the
+  /// whole spline, inverting MapToSegment.
+  /// \param[in] _d Spline data with at least one segment.
+  /// \param[in] _closest Segment and parameter value fraction.
+  /// \return the parameter value (range 0 to 1).
+  double SplineParameter(const SplineData &_d,
+                         const ClosestPoint &_closest)
+  {
+    if (!(_d.arcLength > 0.0))
+      return 0.0;
+    const double t = (_d.cumulativeArcLengths[_closest.index] +
+        _closest.fraction * _d.segments[_closest.index].ArcLength()) /
+        _d.arcLength;
+    return std::min(1.0, std::max(0.0, t));
+  }
+
+  /// \brief Check whether the first and last control points are equal,
+  /// in which case the spline is closed.
+  /// \param[in] _d Spline data.
+  /// \return True if the spline is closed.
+  bool IsClosed(const SplineData &_d)
+  {
+    const size_t numPoints = _d.points.size();
+    return numPoints >= 2 && _d.points[0].MthDerivative(0) ==
+        _d.points[numPoints-1].MthDerivative(0);
+  }
+
+  /// \brief Recalculate the tangent of a control point that is not fixed.
+  /// The tangent of the last point of a closed spline is copied from the
+  /// first point, which must be up to date.
+  /// \param[in,out] _d Spline data with at least two points.
+  /// \param[in] _i Index of the control point.
+  void RecalcTangent(SplineData &_d, const size_t _i)
+  {
+    // Catmull-Rom approach
+    //
+    // tangent[i] = 0.5 * (point[i+1] - point[i-1])
+    //
+    // Assume endpoint tangents are parallel with line with neighbour
+    if (_d.fixings[_i])
+      return;
+
+    const size_t numPoints = _d.points.size();
+    const double t = 1.0 - _d.tension;
+    Vector3d &tangent = _d.points[_i].MthDerivative(1);
+    if (_i == 0)
+    {
+      // Special case start
+      if (_d.closed)
+      {
+        // Use points-2 since points-1 is the last point and == [0]
+        tangent = ((_d.points[1].MthDerivative(0) -
+                    _d.points[numPoints-2].MthDerivative(0)) * 0.5) * t;
+      }
+      else
+      {
+        tangent = ((_d.points[1].MthDerivative(0) -
+                    _d.points[0].MthDerivative(0)) * 0.5) * t;
+      }
+    }
+    else if (_i == numPoints-1)
+    {
+      // Special case end
+      if (_d.closed)
+      {
+        // Use same tangent as already calculated for [0]
+        tangent = _d.points[0].MthDerivative(1);
+      }
+      else
+      {
+        tangent = ((_d.points[_i].MthDerivative(0) -
+                    _d.points[_i-1].MthDerivative(0)) * 0.5) * t;
+      }
+    }
+    else
+    {
+      tangent = ((_d.points[_i+1].MthDerivative(0) -
+                  _d.points[_i-1].MthDerivative(0)) * 0.5) * t;
+    }
+  }
+
+  /// \brief Update the cumulative arc lengths of the segments after some
+  /// of them were rebuilt.
+  /// \param[in,out] _d Spline data with at least one segment.
+  /// \param[in] _first Index of the first rebuilt segment.
+  void UpdateArcLengths(SplineData &_d, const size_t _first)
+  {
+    for (size_t i = _first; i < _d.segments.size(); ++i)
+    {
+      if (i > 0)
+      {
+        _d.cumulativeArcLengths[i] =
+            _d.segments[i-1].ArcLength() + _d.cumulativeArcLengths[i-1];
+      }
+      else
+      {
+        _d.cumulativeArcLengths[i] = 0.0;
+      }
+    }
+    _d.arcLength =
+        _d.cumulativeArcLengths.back() + _d.segments.back().ArcLength();
+    _d.arcLengthTableDirty = true;
+    _d.boundsTableDirty = true;
+  }
+
+  /// \brief Update the tangents and segments that depend on a control
+  /// point after it was changed or appended. When autoCalc is false only
+  /// the segments are rebuilt.
+  /// \param[in,out] _d Spline data.
+  /// \param[in] _index Index of the control point.
+  void UpdateAroundPoint(SplineData &_d, const size_t _index)
+  {
+    const size_t numPoints = _d.points.size();
+    if (numPoints < 2)
+    {
+      // Can't do anything yet
+      return;
+    }
+
+    const size_t lastPoint = numPoints - 1;
+    const size_t numSegments = lastPoint;
+
+    // Segments that start or end at the point
+    size_t first = _index > 0 ? _index - 1 : 0;
+    size_t last = _index;
+    bool ends = false;
+
+    if (_d.autoCalc)
+    {
+      // The end tangents depend on whether the spline is closed and, if
+      // it is, on the neighbours of both ends.
+      const bool wasClosed = _d.closed;
+      _d.closed = IsClosed(_d);
+      ends = _d.closed || wasClosed;
+
+      // The tangents of the point and its neighbours depend on the point.
+      // The first tangent is calculated before the last one, which may
+      // copy it.
+      if (ends || _index <= 1)
+        RecalcTangent(_d, 0);
+      for (size_t i = std::max<size_t>(_index, 2) - 1;
+           i <= std::min(_index + 1, lastPoint - 1); ++i)
+      {
+        RecalcTangent(_d, i);
+      }
+      if (ends || _index + 1 >= lastPoint)
+        RecalcTangent(_d, lastPoint);
+
+      // Segments that start or end at a recalculated tangent
+      first = _index > 1 ? _index - 2 : 0;
+      last = _index + 1;
+    }
+    else
+    {
+      _d.tangentsOutdated = true;
+    }
+
+    // Appended points add segments that were never built
+    if (_d.segments.size() < numSegments)
+    {
+      first = std::min(first, _d.segments.size());
+      last = numSegments - 1;
+      _d.segments.resize(numSegments);
+      _d.cumulativeArcLengths.resize(numSegments);
+    }
+
+    last = std::min(last, numSegments - 1);
+    for (size_t i = first; i <= last; ++i)
+      _d.segments[i].SetPoints(_d.points[i], _d.points[i+1]);
+
+    if (ends)
+    {
+      _d.segments[0].SetPoints(_d.points[0], _d.points[1]);
+      _d.segments[numSegments-1].SetPoints(
+          _d.points[lastPoint-1], _d.points[lastPoint]);
+      first = 0;
+    }
+    UpdateArcLengths(_d, first);
+  }
+}
+
 ///////////////////////////////////////////////////////////
 Spline::Spline()
-    : dataPtr(new SplinePrivate())
+    : Spline(std::pmr::get_default_resource())
+{
+}
+
+///////////////////////////////////////////////////////////
+Spline::Spline(std::pmr::memory_resource *_resource)
+    : dataPtr(new SplinePrivate(_resource))
 {
   // Set up matrix
-  this->dataPtr->autoCalc = true;
-  this->dataPtr->tension = 0.0;
-  this->dataPtr->arcLength = INF_D;
+  this->dataPtr->data->autoCalc = true;
+  this->dataPtr->data->tension = 0.0;
+  this->dataPtr->data->arcLength = INF_D;
+}
+
+///////////////////////////////////////////////////////////
+Spline::Spline(const Spline &_other)
+    : dataPtr(new SplinePrivate(*_other.dataPtr))
+{
+}
+
+///////////////////////////////////////////////////////////
+Spline::Spline(Spline &&_other) noexcept
+    : dataPtr(_other.dataPtr)
+{
+  _other.dataPtr = nullptr;
 }
 
 ///////////////////////////////////////////////////////////
@@ -42,24 +384,56 @@ Spline::~Spline()
   this->dataPtr = NULL;
 }
 
+///////////////////////////////////////////////////////////
+Spline &Spline::operator=(const Spline &_other)
+{
+  // A moved from spline has no data
+  if (this->dataPtr == nullptr)
+    this->dataPtr = new SplinePrivate(*_other.dataPtr);
+  else
+    this->dataPtr->data = _other.dataPtr->data;
+  return *this;
+}
+
+///////////////////////////////////////////////////////////
+Spline &Spline::operator=(Spline &&_other) noexcept
+{
+  std::swap(this->dataPtr, _other.dataPtr);
+  return *this;
+}
+
+///////////////////////////////////////////////////////////
+SplineData &SplinePrivate::Mutable()
+{
+  if (this->data.use_count() > 1)
+  {
+    IGN_MATH_COUNT_COPY(PIMPL, sizeof(SplineData));
+    this->data = std::make_shared<SplineData>(*this->data);
+  }
+  return *this->data;
+}
+
 ///////////////////////////////////////////////////////////
 void Spline::Tension(double _t)
 {
-  this->dataPtr->tension = _t;
-  if (this->dataPtr->autoCalc)
+  this->dataPtr->Mutable();
+  this->dataPtr->data->tension = _t;
+  if (this->dataPtr->data->autoCalc)
     this->RecalcTangents();
+  else
+    this->dataPtr->data->tangentsOutdated = true;
 }
 
 ///////////////////////////////////////////////////////////
 double Spline::Tension() const
 {
-  return this->dataPtr->tension;
+  return this->dataPtr->data->tension;
 }
 
 ///////////////////////////////////////////////////////////
 double Spline::ArcLength() const
 {
-  return this->dataPtr->arcLength;
+  return this->dataPtr->data->arcLength;
 }
 
 ///////////////////////////////////////////////////////////
@@ -68,7 +442,7 @@ double Spline::ArcLength(const double _t) const
   unsigned int fromIndex; double tFraction;
   if (!this->MapToSegment(_t, fromIndex, tFraction))
     return INF_D;
-  return (this->dataPtr->cumulativeArcLengths[fromIndex] +
+  return (this->dataPtr->data->cumulativeArcLengths[fromIndex] +
           this->ArcLength(fromIndex, tFraction));
 }
 
@@ -76,9 +450,151 @@ double Spline::ArcLength(const double _t) const
 double Spline::ArcLength(const unsigned int _index,
                          const double _t) const
 {
-  if (_index >= this->dataPtr->segments.size())
+  if (_index >= this->dataPtr->data->segments.size())
     return INF_D;
-  return this->dataPtr->segments[_index].ArcLength(_t);
+  return this->dataPtr->data->segments[_index].ArcLength(_t);
+}
+
+///////////////////////////////////////////////////////////
+void Spline::ArcLengthResolution(const unsigned int _samples)
+{
+  this->dataPtr->Mutable();
+  this->dataPtr->data->arcLengthResolution = std::max(1u, _samples);
+  this->dataPtr->data->arcLengthTableDirty = true;
+}
+
+///////////////////////////////////////////////////////////
+unsigned int Spline::ArcLengthResolution() const
+{
+  return this->dataPtr->data->arcLengthResolution;
+}
+
+///////////////////////////////////////////////////////////
+double Spline::ParameterAtDistance(const double _s) const
+{
+  unsigned int fromIndex; double tFraction;
+  if (!this->MapDistanceToSegment(_s, fromIndex, tFraction))
+    return INF_D;
+
+  // Invert the linear relationship between t and arc length assumed by
+  // MapToSegment.
+  if (!(this->dataPtr->data->arcLength > 0.0))
+    return 0.0;
+  return (this->dataPtr->data->cumulativeArcLengths[fromIndex] +
+          tFraction * this->dataPtr->data->segments[fromIndex].ArcLength()) /
+         this->dataPtr->data->arcLength;
+}
+
+///////////////////////////////////////////////////////////
+Vector3d Spline::InterpolateByDistance(const double _s) const
+{
+  unsigned int fromIndex; double tFraction;
+  if (!this->MapDistanceToSegment(_s, fromIndex, tFraction))
+    return Vector3d(INF_D, INF_D, INF_D);
+  return this->Interpolate(fromIndex, tFraction);
+}
+
+///////////////////////////////////////////////////////////
+double Spline::ClosestParameter(const Vector3d &_point) const
+{
+  const SplineData &d = *this->dataPtr->data;
+  if (d.segments.empty() || !_point.IsFinite())
+    return INF_D;
+
+  UpdateBoundsTable(*this->dataPtr->data);
+  const size_t numSegments = d.segments.size();
+  const size_t blockSize = SplineData::kBoundsBlockSize;
+  const size_t numBlocks = (numSegments + blockSize - 1) / blockSize;
+  const Vector3d *blocks = &d.boundsTable[2 * numSegments];
+
+  // Search the block closest to the point first, so that its closest
+  // point prunes most of the other blocks and their segments.
+  size_t first = 0;
+  double firstDistance = INF_D;
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const double distance = SquaredDistanceToBox(_point, &blocks[2 * b]);
+    if (distance < firstDistance)
+    {
+      first = b;
+      firstDistance = distance;
+    }
+  }
+
+  ClosestPoint closest;
+  for (size_t n = 0; n < numBlocks; ++n)
+  {
+    const size_t b = n == 0 ? first : (n <= first ? n - 1 : n);
+    if (n > 0 && !(SquaredDistanceToBox(_point, &blocks[2 * b]) <
+                   closest.squaredDistance))
+    {
+      continue;
+    }
+    const size_t end = std::min(numSegments, (b + 1) * blockSize);
+    for (size_t i = b * blockSize; i < end; ++i)
+      ProjectOnSegment(d, i, _point, closest);
+  }
+  return SplineParameter(d, closest);
+}
+
+///////////////////////////////////////////////////////////
+double Spline::ClosestParameter(const Vector3d &_point,
+                                const double _previous,
+                                const double _window) const
+{
+  const SplineData &d = *this->dataPtr->data;
+  unsigned int start; double tFraction;
+  if (!_point.IsFinite() || std::isnan(_previous) ||
+      !this->MapToSegment(std::min(1.0, std::max(0.0, _previous)),
+                          start, tFraction))
+  {
+    return INF_D;
+  }
+
+  UpdateBoundsTable(*this->dataPtr->data);
+  const size_t numSegments = d.segments.size();
+  const double window = std::max(0.0, _window);
+  const double s = (d.cumulativeArcLengths[start] +
+      tFraction * d.segments[start].ArcLength());
+
+  ClosestPoint closest;
+  ProjectOnSegment(d, start, _point, closest);
+
+  // Walk forward and backward from the segment of the previous
+  // parameter value, over the segments that are within the window.
+  // Closed splines wrap around their ends.
+  for (size_t k = 1; k < numSegments; ++k)
+  {
+    size_t i = start + k;
+    double ahead = -s;
+    if (i >= numSegments)
+    {
+      if (!d.closed)
+        break;
+      i -= numSegments;
+      ahead += d.arcLength;
+    }
+    ahead += d.cumulativeArcLengths[i];
+    if (ahead > window)
+      break;
+    ProjectOnSegment(d, i, _point, closest);
+  }
+  for (size_t k = 1; k < numSegments; ++k)
+  {
+    size_t i = start + numSegments - k;
+    double behind = s;
+    if (i >= numSegments)
+      i -= numSegments;
+    else if (!d.closed)
+      break;
+    else
+      behind += d.arcLength;
+    behind -= d.cumulativeArcLengths[i] + d.segments[i].ArcLength();
+    if (behind > window)
+      break;
+    ProjectOnSegment(d, i, _point, closest);
+  }
+  return SplineParameter(d, closest);
 }
 
 ///////////////////////////////////////////////////////////
@@ -98,12 +614,18 @@ void Spline::AddPoint(const Vector3d &_p, const Vector3d &_t)
 ///////////////////////////////////////////////////////////
 void Spline::AddPoint(const ControlPoint &_cp, const bool _fixed)
 {
-  this->dataPtr->points.push_back(_cp);
-  this->dataPtr->fixings.push_back(_fixed);
-  if (this->dataPtr->autoCalc)
+  this->dataPtr->Mutable();
+  this->dataPtr->data->points.push_back(_cp);
+  this->dataPtr->data->fixings.push_back(_fixed);
+  if (this->dataPtr->data->autoCalc && this->dataPtr->data->tangentsOutdated)
+  {
     this->RecalcTangents();
+  }
   else
-    this->Rebuild();
+  {
+    UpdateAroundPoint(*this->dataPtr->data,
+                      this->dataPtr->data->points.size() - 1);
+  }
 }
 
 ///////////////////////////////////////////////////////////
@@ -121,18 +643,20 @@ Vector3d Spline::InterpolateMthDerivative(const unsigned int _fromIndex,
                                           const double _t) const
 {
   // Bounds check
-  if (_fromIndex >= this->dataPtr->points.size())
+  if (_fromIndex >= this->dataPtr->data->points.size())
     return Vector3d(INF_D, INF_D, INF_D);
 
-  if (_fromIndex == this->dataPtr->segments.size())
+  if (_fromIndex == this->dataPtr->data->segments.size())
   {
     // Duff request, cannot blend to nothing
     // Just return source
-    return this->dataPtr->points[_fromIndex].MthDerivative(_mth);
+    const ControlPoint &point = this->dataPtr->data->points[_fromIndex];
+    return point.MthDerivative(_mth);
   }
 
   // Interpolate derivative
-  return this->dataPtr->segments[_fromIndex].InterpolateMthDerivative(_mth, _t);
+  return this->dataPtr->data->segments[_fromIndex].InterpolateMthDerivative(
+      _mth, _t);
 }
 
 ///////////////////////////////////////////////////////////
@@ -148,6 +672,61 @@ Vector3d Spline::Interpolate(const unsigned int _fromIndex,
   return this->InterpolateMthDerivative(_fromIndex, 0, _t);
 }
 
+///////////////////////////////////////////////////////////
+bool Spline::Interpolate(const double *_t, const size_t _count,
+                         Vector3d *_points) const
+{
+  const auto &segments = this->dataPtr->data->segments;
+  const auto &cumulative =
+      this->dataPtr->data->cumulativeArcLengths;
+
+  if (segments.empty())
+  {
+    // Without segments every parameter value maps to the first point, the
+    // same as MapToSegment.
+    const Vector3d point = this->Interpolate(0u, 0.0);
+    std::fill(_points, _points + _count, point);
+    return !this->dataPtr->data->points.empty();
+  }
+
+  const size_t lastIndex = segments.size() - 1;
+  const double arcLength = this->dataPtr->data->arcLength;
+  size_t index = 0;
+  double prevArc = -INF_D;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const double t = _t[i];
+
+    // Check corner cases, as in MapToSegment
+    if (equal(t, 0.0))
+    {
+      _points[i] = segments[0].InterpolateMthDerivative(0, 0.0);
+      continue;
+    }
+    if (equal(t, 1.0))
+    {
+      _points[i] = segments[lastIndex].InterpolateMthDerivative(0, 1.0);
+      continue;
+    }
+
+    // Assume linear relationship between t and arclength
+    const double tArc = t * arcLength;
+    if (tArc < prevArc)
+      index = 0;
+    prevArc = tArc;
+
+    // Walk forward to the last segment starting before tArc, which is the
+    // segment found by the binary search of MapToSegment.
+    while (index < lastIndex && cumulative[index + 1] < tArc)
+      ++index;
+
+    const double fraction =
+        (tArc - cumulative[index]) / segments[index].ArcLength();
+    _points[i] = segments[index].InterpolateMthDerivative(0, fraction);
+  }
+  return true;
+}
+
 ///////////////////////////////////////////////////////////
 Vector3d Spline::InterpolateTangent(const double _t) const
 {
@@ -164,16 +743,10 @@ Vector3d Spline::InterpolateTangent(const unsigned int _fromIndex,
 ///////////////////////////////////////////////////////////
 void Spline::RecalcTangents()
 {
-  // Catmull-Rom approach
-  //
-  // tangent[i] = 0.5 * (point[i+1] - point[i-1])
-  //
-  // Assume endpoint tangents are parallel with line with neighbour
+  this->dataPtr->Mutable();
+  this->dataPtr->data->tangentsOutdated = false;
 
-  size_t i, numPoints;
-  bool isClosed;
-
-  numPoints = this->dataPtr->points.size();
+  size_t numPoints = this->dataPtr->data->points.size();
   if (numPoints < 2)
   {
     // Can't do anything yet
@@ -181,60 +754,10 @@ void Spline::RecalcTangents()
   }
 
   // Closed or open?
-  if (this->dataPtr->points[0].MthDerivative(0) ==
-      this->dataPtr->points[numPoints-1].MthDerivative(0))
-    isClosed = true;
-  else
-    isClosed = false;
+  this->dataPtr->data->closed = IsClosed(*this->dataPtr->data);
 
-  double t = 1.0 - this->dataPtr->tension;
-
-  for (i = 0; i < numPoints; ++i)
-  {
-    if (!this->dataPtr->fixings[i])
-    {
-      if (i == 0)
-      {
-        // Special case start
-        if (isClosed)
-        {
-          // Use this->dataPtr->points-2 since this->dataPtr->points-1
-          // is the last point and == [0]
-          this->dataPtr->points[i].MthDerivative(1) =
-              ((this->dataPtr->points[1].MthDerivative(0) -
-                this->dataPtr->points[numPoints-2].MthDerivative(0)) * 0.5) * t;
-        }
-        else
-        {
-          this->dataPtr->points[i].MthDerivative(1) =
-              ((this->dataPtr->points[1].MthDerivative(0) -
-                this->dataPtr->points[0].MthDerivative(0)) * 0.5) * t;
-        }
-      }
-      else if (i == numPoints-1)
-      {
-        // Special case end
-        if (isClosed)
-        {
-          // Use same tangent as already calculated for [0]
-          this->dataPtr->points[i].MthDerivative(1) =
-              this->dataPtr->points[0].MthDerivative(1);
-        }
-        else
-        {
-          this->dataPtr->points[i].MthDerivative(1) =
-              ((this->dataPtr->points[i].MthDerivative(0) -
-                this->dataPtr->points[i-1].MthDerivative(0)) * 0.5) * t;
-        }
-      }
-      else
-      {
-        this->dataPtr->points[i].MthDerivative(1) =
-            ((this->dataPtr->points[i+1].MthDerivative(0) -
-              this->dataPtr->points[i-1].MthDerivative(0)) * 0.5) * t;
-      }
-    }
-  }
+  for (size_t i = 0; i < numPoints; ++i)
+    RecalcTangent(*this->dataPtr->data, i);
   this->Rebuild();
 }
 
@@ -247,7 +770,7 @@ bool Spline::MapToSegment(const double _t,
   _fraction = 0.0;
 
   // Check corner cases
-  if (this->dataPtr->segments.empty())
+  if (this->dataPtr->data->segments.empty())
     return false;
 
   if (equal(_t, 0.0))
@@ -255,33 +778,78 @@ bool Spline::MapToSegment(const double _t,
 
   if (equal(_t, 1.0))
   {
-    _index = static_cast<unsigned int>(this->dataPtr->segments.size()-1);
+    _index = static_cast<unsigned int>(this->dataPtr->data->segments.size()-1);
     _fraction = 1.0;
     return true;
   }
 
   // Assume linear relationship between t and arclength
-  double tArc = _t * this->dataPtr->arcLength;
+  double tArc = _t * this->dataPtr->data->arcLength;
 
   // Get segment index where t would lie
-  auto it = std::lower_bound(this->dataPtr->cumulativeArcLengths.begin(),
-                             this->dataPtr->cumulativeArcLengths.end(),
+  auto it = std::lower_bound(this->dataPtr->data->cumulativeArcLengths.begin(),
+                             this->dataPtr->data->cumulativeArcLengths.end(),
                              tArc);
 
-  if (it != this->dataPtr->cumulativeArcLengths.begin())
+  if (it != this->dataPtr->data->cumulativeArcLengths.begin())
     _index = static_cast<unsigned int>(
-        (it - this->dataPtr->cumulativeArcLengths.begin() - 1));
+        (it - this->dataPtr->data->cumulativeArcLengths.begin() - 1));
 
   // Get fraction of t, but renormalized to the segment
-  _fraction = (tArc - this->dataPtr->cumulativeArcLengths[_index])
-              / this->dataPtr->segments[_index].ArcLength();
+  _fraction = (tArc - this->dataPtr->data->cumulativeArcLengths[_index])
+              / this->dataPtr->data->segments[_index].ArcLength();
+
+  // Rounding can put a knot slightly past an end of its segment, such as
+  // the parameter value of a knot from ClosestParameter.
+  if (_t >= 0.0 && _t <= 1.0)
+    _fraction = std::min(1.0, std::max(0.0, _fraction));
+  return true;
+}
+
+///////////////////////////////////////////////////////////
+bool Spline::MapDistanceToSegment(const double _s,
+                                  unsigned int &_index,
+                                  double &_fraction) const
+{
+  _index = 0;
+  _fraction = 0.0;
+
+  // Check corner cases
+  if (this->dataPtr->data->segments.empty())
+    return false;
+
+  double s = _s;
+  if (equal(s, 0.0))
+    s = 0.0;
+  else if (equal(s, this->dataPtr->data->arcLength))
+    s = this->dataPtr->data->arcLength;
+  else if (s < 0.0 || s > this->dataPtr->data->arcLength)
+    return false;
+
+  UpdateArcLengthTable(*this->dataPtr->data);
+  const auto &table = this->dataPtr->data->arcLengthTable;
+
+  // Get the table interval where s would lie
+  size_t k = static_cast<size_t>(
+      std::upper_bound(table.begin(), table.end(), s) - table.begin());
+  k = std::min(k > 0 ? k - 1 : 0, table.size() - 2);
+
+  // Interpolate the parameter value linearly within the interval
+  const double width = table[k + 1] - table[k];
+  double fraction = width > 0.0 ? (s - table[k]) / width : 0.0;
+  fraction = std::min(1.0, std::max(0.0, fraction));
+
+  const unsigned int samples = this->dataPtr->data->arcLengthResolution;
+  _index = static_cast<unsigned int>(k / samples);
+  _fraction = (static_cast<double>(k % samples) + fraction) / samples;
   return true;
 }
 
 ///////////////////////////////////////////////////////////
 void Spline::Rebuild()
 {
-  size_t numPoints = this->dataPtr->points.size();
+  this->dataPtr->Mutable();
+  size_t numPoints = this->dataPtr->data->points.size();
 
   if (numPoints < 2) {
     // Can't do anything yet
@@ -289,25 +857,14 @@ void Spline::Rebuild()
   }
 
   size_t numSegments = numPoints - 1;
-  this->dataPtr->segments.resize(numSegments);
-  this->dataPtr->cumulativeArcLengths.resize(numSegments);
+  this->dataPtr->data->segments.resize(numSegments);
+  this->dataPtr->data->cumulativeArcLengths.resize(numSegments);
   for (size_t i = 0 ; i < numSegments ; ++i)
   {
-    this->dataPtr->segments[i].SetPoints(this->dataPtr->points[i],
-                                         this->dataPtr->points[i+1]);
-
-    if (i > 0) {
-      this->dataPtr->cumulativeArcLengths[i] =
-          (this->dataPtr->segments[i-1].ArcLength()
-           + this->dataPtr->cumulativeArcLengths[i-1]);
-    }
-    else
-    {
-      this->dataPtr->cumulativeArcLengths[i] = 0.0;
-    }
+    this->dataPtr->data->segments[i].SetPoints(this->dataPtr->data->points[i],
+                                         this->dataPtr->data->points[i+1]);
   }
-  this->dataPtr->arcLength = (this->dataPtr->cumulativeArcLengths.back()
-                              + this->dataPtr->segments.back().ArcLength());
+  UpdateArcLengths(*this->dataPtr->data, 0);
 }
 
 ///////////////////////////////////////////////////////////
@@ -326,23 +883,29 @@ Vector3d Spline::Tangent(const unsigned int _index) const
 Vector3d Spline::MthDerivative(const unsigned int _index,
                                const unsigned int _mth) const
 {
-  if (_index >= this->dataPtr->points.size())
+  if (_index >= this->dataPtr->data->points.size())
     return Vector3d(INF_D, INF_D, INF_D);
-  return this->dataPtr->points[_index].MthDerivative(_mth);
+  const ControlPoint &point = this->dataPtr->data->points[_index];
+  return point.MthDerivative(_mth);
 }
 
 ///////////////////////////////////////////////////////////
 size_t Spline::PointCount() const
 {
-  return this->dataPtr->points.size();
+  return this->dataPtr->data->points.size();
 }
 
 ///////////////////////////////////////////////////////////
 void Spline::Clear()
 {
-  this->dataPtr->points.clear();
-  this->dataPtr->segments.clear();
-  this->dataPtr->fixings.clear();
+  this->dataPtr->Mutable();
+  this->dataPtr->data->points.clear();
+  this->dataPtr->data->segments.clear();
+  this->dataPtr->data->fixings.clear();
+  this->dataPtr->data->tangentsOutdated = false;
+  this->dataPtr->data->closed = false;
+  this->dataPtr->data->arcLengthTableDirty = true;
+  this->dataPtr->data->boundsTableDirty = true;
 }
 
 ///////////////////////////////////////////////////////////
@@ -365,21 +928,38 @@ bool Spline::UpdatePoint(const unsigned int _index,
                          const ControlPoint &_point,
                          const bool _fixed)
 {
-  if (_index >= this->dataPtr->points.size())
+  if (_index >= this->dataPtr->data->points.size())
     return false;
 
-  this->dataPtr->points[_index].Match(_point);
-  this->dataPtr->fixings[_index] = _fixed;
+  this->dataPtr->Mutable();
+  this->dataPtr->data->points[_index].Match(_point);
+  this->dataPtr->data->fixings[_index] = _fixed;
 
-  if (this->dataPtr->autoCalc)
+  if (this->dataPtr->data->autoCalc && this->dataPtr->data->tangentsOutdated)
     this->RecalcTangents();
   else
-    this->Rebuild();
+    UpdateAroundPoint(*this->dataPtr->data, _index);
   return true;
 }
 
 ///////////////////////////////////////////////////////////
 void Spline::AutoCalculate(bool _autoCalc)
 {
-  this->dataPtr->autoCalc = _autoCalc;
+  this->dataPtr->Mutable();
+  this->dataPtr->data->autoCalc = _autoCalc;
+}
+
+///////////////////////////////////////////////////////////
+void Spline::Finalize()
+{
+  UpdateArcLengthTable(*this->dataPtr->data);
+  UpdateBoundsTable(*this->dataPtr->data);
+}
+
+///////////////////////////////////////////////////////////
+bool Spline::Finalized() const
+{
+  const SplineData &d = *this->dataPtr->data;
+  return !d.arcLengthTableDirty.load(std::memory_order_acquire) &&
+         !d.boundsTableDirty.load(std::memory_order_acquire);
 }
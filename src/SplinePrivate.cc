@@ -15,6 +15,10 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
 #include "gz/math/Matrix4.hh"
 
 #include "SplinePrivate.hh"
@@ -25,6 +29,94 @@ namespace math
 {
 inline namespace IGNITION_MATH_VERSION_NAMESPACE
 {
+namespace
+{
+  /// \brief Evaluate a polynomial.
+  /// \param[in] _coeffs Coefficients, from the constant one up.
+  /// \param[in] _degree Degree of the polynomial.
+  /// \param[in] _t Value of the variable.
+  /// \return the value of the polynomial.
+  double EvaluatePolynomial(const double *_coeffs, const int _degree,
+                            const double _t)
+  {
+    double result = _coeffs[_degree];
+    for (int i = _degree - 1; i >= 0; --i)
+      result = result * _t + _coeffs[i];
+    return result;
+  }
+
+  /// \brief Get the sign of a value.
+  /// \param[in] _value The value.
+  /// \return -1, 0 or 1.
+  int Sign(const double _value)
+  {
+    return (_value > 0.0) - (_value < 0.0);
+  }
+
+  /// \brief Find the roots of a polynomial in [0, 1] where it changes
+  /// sign. The polynomial is monotonic between the roots of its
+  /// derivative, which are found first, so each of these intervals
+  /// brackets at most one root, refined by Newton steps kept inside the
+  /// bracket.
+  /// \param[in] _coeffs Coefficients, from the constant one up.
+  /// \param[in] _degree Degree of the polynomial, 1 to 5.
+  /// \param[out] _roots The roots, in increasing order, at most _degree.
+  /// \return the number of roots.
+  int SignChangeRoots(const double *_coeffs, const int _degree,
+                      double *_roots)
+  {
+    double derivative[5];
+    for (int i = 1; i <= _degree; ++i)
+      derivative[i - 1] = i * _coeffs[i];
+
+    // Bounds of the monotonic intervals.
+    double bounds[7];
+    int numBounds = 0;
+    bounds[numBounds++] = 0.0;
+    if (_degree > 1)
+      numBounds += SignChangeRoots(derivative, _degree - 1, &bounds[1]);
+    bounds[numBounds++] = 1.0;
+
+    int numRoots = 0;
+    for (int k = 0; k + 1 < numBounds; ++k)
+    {
+      double lo = bounds[k];
+      double hi = bounds[k + 1];
+      const int signLo = Sign(EvaluatePolynomial(_coeffs, _degree, lo));
+      const int signHi = Sign(EvaluatePolynomial(_coeffs, _degree, hi));
+      if (signLo == 0 && k > 0)
+      {
+        // A root on an inner bound.
+        _roots[numRoots++] = lo;
+        continue;
+      }
+      if (signLo == 0 || signHi == 0 || signLo == signHi)
+        continue;
+
+      double t = 0.5 * (lo + hi);
+      for (int i = 0; i < 100; ++i)
+      {
+        const double f = EvaluatePolynomial(_coeffs, _degree, t);
+        if (Sign(f) == signLo)
+          lo = t;
+        else
+          hi = t;
+
+        double next = t - f / EvaluatePolynomial(
+            derivative, _degree - 1, t);
+        if (!(next > lo && next < hi))
+          next = 0.5 * (lo + hi);
+        const bool converged = std::abs(next - t) < 1e-15;
+        t = next;
+        if (converged)
+          break;
+      }
+      _roots[numRoots++] = t;
+    }
+    return numRoots;
+  }
+}
+
 ///////////////////////////////////////////////////////////
 Vector4d PolynomialPowers(const unsigned int _order,
                           const double _t)
@@ -126,6 +218,71 @@ double IntervalCubicSpline::ArcLength(const double _t) const
   return arc_length;
 }
 
+///////////////////////////////////////////////////////////
+void IntervalCubicSpline::Bounds(Vector3d &_min, Vector3d &_max) const
+{
+  // The curve lies in the convex hull of its Bezier control points
+  // p0, p0 + t0 / 3, p1 - t1 / 3 and p1, which are derived from the
+  // polynomial coefficients so that they match the interpolation.
+  const Matrix4d &c = this->coeffs;
+  for (int k = 0; k < 3; ++k)
+  {
+    const double p0 = c(3, k);
+    const double b1 = p0 + c(2, k) / 3.0;
+    const double b2 = b1 + (c(1, k) + c(2, k)) / 3.0;
+    const double p1 = c(0, k) + c(1, k) + c(2, k) + p0;
+    _min[k] = std::min(std::min(p0, b1), std::min(b2, p1));
+    _max[k] = std::max(std::max(p0, b1), std::max(b2, p1));
+  }
+}
+
+///////////////////////////////////////////////////////////
+double IntervalCubicSpline::ClosestParameter(const Vector3d &_point,
+                                             double &_squaredDistance) const
+{
+  // Curve p(t) = a t^3 + b t^2 + c t + d, relative to _point
+  const Matrix4d &m = this->coeffs;
+  const Vector3d a(m(0, 0), m(0, 1), m(0, 2));
+  const Vector3d b(m(1, 0), m(1, 1), m(1, 2));
+  const Vector3d c(m(2, 0), m(2, 1), m(2, 2));
+  const Vector3d d = Vector3d(m(3, 0), m(3, 1), m(3, 2)) - _point;
+  auto squaredDistance = [&](const double _t)
+  {
+    return (((a * _t + b) * _t + c) * _t + d).SquaredLength();
+  };
+
+  // The squared distance has degree 6 and can have several minima. They
+  // are among the ends of the segment and the roots of its derivative,
+  // twice the degree 5 polynomial (p - _point) . p'.
+  const double stationary[6] =
+  {
+    d.Dot(c),
+    2.0 * d.Dot(b) + c.Dot(c),
+    3.0 * (a.Dot(d) + b.Dot(c)),
+    4.0 * a.Dot(c) + 2.0 * b.Dot(b),
+    5.0 * a.Dot(b),
+    3.0 * a.Dot(a)
+  };
+  double candidates[7];
+  int numCandidates = 0;
+  candidates[numCandidates++] = 0.0;
+  numCandidates += SignChangeRoots(stationary, 5, &candidates[1]);
+  candidates[numCandidates++] = 1.0;
+
+  double t = 0.0;
+  _squaredDistance = INF_D;
+  for (int i = 0; i < numCandidates; ++i)
+  {
+    const double distance = squaredDistance(candidates[i]);
+    if (distance < _squaredDistance)
+    {
+      t = candidates[i];
+      _squaredDistance = distance;
+    }
+  }
+  return t;
+}
+
 ///////////////////////////////////////////////////////////
 Vector3d IntervalCubicSpline::DoInterpolateMthDerivative(
     const unsigned int _mth, const double _t) const
@@ -150,6 +307,30 @@ Vector3d IntervalCubicSpline::InterpolateMthDerivative(
 
   return this->DoInterpolateMthDerivative(_mth, _t);
 }
+
+///////////////////////////////////////////////////////////
+SplineData::SplineData(const SplineData &_other)
+  : autoCalc(_other.autoCalc), tension(_other.tension),
+    fixings(_other.fixings, _other.fixings.get_allocator()),
+    points(_other.points, _other.points.get_allocator()),
+    segments(_other.segments, _other.segments.get_allocator()),
+    cumulativeArcLengths(_other.cumulativeArcLengths,
+                         _other.cumulativeArcLengths.get_allocator()),
+    arcLength(_other.arcLength), tangentsOutdated(_other.tangentsOutdated),
+    closed(_other.closed), arcLengthResolution(_other.arcLengthResolution),
+    arcLengthTable(_other.arcLengthTable.get_allocator()),
+    boundsTable(_other.boundsTable.get_allocator())
+{
+  // Other splines sharing _other may be building its lazy tables
+  {
+    std::lock_guard<std::mutex> lock(_other.arcLengthTableMutex);
+    this->arcLengthTable = _other.arcLengthTable;
+    this->arcLengthTableDirty = _other.arcLengthTableDirty.load();
+  }
+  std::lock_guard<std::mutex> lock(_other.boundsTableMutex);
+  this->boundsTable = _other.boundsTable;
+  this->boundsTableDirty = _other.boundsTableDirty.load();
+}
 }
 }
 }
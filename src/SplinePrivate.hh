@@ -1,211 +1,316 @@
-/*
- * Copyright (C) 2015 Open Source Robotics Foundation
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- *
-*/
-#ifndef GZ_MATH_SPLINEPRIVATE_HH_
-#define GZ_MATH_SPLINEPRIVATE_HH_
-
-#include <algorithm>
-#include <vector>
-#include <gz/math/Vector3.hh>
-#include <gz/math/Vector4.hh>
-#include <gz/math/Matrix4.hh>
-#include <gz/math/config.hh>
-
-namespace ignition
-{
-  namespace math
-  {
-    inline namespace IGNITION_MATH_VERSION_NAMESPACE
-    {
-    /// \brief Control point representation for
-    /// polynomial interpolation, defined in terms
-    /// of arbitrary m derivatives at such point.
-    class ControlPoint
-    {
-      /// \brief Default constructor.
-      public: ControlPoint()
-      {
-      }
-
-      /// \brief Constructor that takes the M derivatives that
-      /// define the control point.
-      /// \param[in] _initList with the M derivatives.
-      public: explicit ControlPoint(const std::vector<Vector3d> &_initList)
-          : derivatives(_initList.begin(), _initList.end())
-      {
-      }
-
-      /// \brief Matches all mth derivatives defined in \p _other
-      /// to this.
-      /// \remarks Higher order derivatives in this and not defined
-      /// in \p _other are kept.
-      /// \param[in] _other control point to be matches.
-      public: inline void Match(const ControlPoint &_other)
-      {
-        std::copy(_other.derivatives.begin(),
-                  _other.derivatives.end(),
-                  this->derivatives.begin());
-      }
-
-      /// \brief Checks for control point equality.
-      /// \param[in] _other control point to compare against.
-      /// \return whether this and \p _other can be seen as equal.
-      public: inline bool operator==(const ControlPoint &_other) const
-      {
-        // Workaround to compare the two vector of vectors in MSVC 2013
-        // and MSVC 2015. See
-        // https://github.com/ignitionrobotics/ign-math/issues/70
-        if (this->derivatives.size() != _other.derivatives.size())
-          return false;
-
-        for (size_t i = 0; i < this->derivatives.size(); ++i)
-          if (this->derivatives[i] != _other.derivatives[i])
-            return false;
-
-        return true;
-      }
-
-      /// \brief Gets the mth derivative of this control point.
-      /// \remarks Higher derivatives than those defined
-      /// default to [0.0, 0.0, 0.0].
-      /// \param[in] _mth derivative order.
-      /// \return The mth derivative value.
-      public: inline Vector3d MthDerivative(const unsigned int _mth) const
-      {
-        if (_mth >= this->derivatives.size())
-          return Vector3d(0.0, 0.0, 0.0);
-        return this->derivatives[_mth];
-      }
-
-      /// \brief Returns a mutable reference to the mth derivative of
-      /// this control point.
-      /// \remarks Higher derivatives than those defined
-      /// default to [0.0, 0.0, 0.0].
-      /// \param[in] _mth derivative order.
-      /// \return The mth derivative value.
-      public: inline Vector3d& MthDerivative(const unsigned int _mth)
-      {
-        if (_mth >= this->derivatives.size())
-        {
-          this->derivatives.insert(this->derivatives.end(),
-                                   _mth - this->derivatives.size() + 1,
-                                   Vector3d(0.0, 0.0, 0.0));
-        }
-        return this->derivatives[_mth];
-      }
-
-      /// \brief control point M derivatives (0 to M-1).
-      private: std::vector<Vector3d> derivatives;
-    };
-
-    /// \brief Cubic interpolator for splines defined
-    /// between each pair of control points.
-    class IntervalCubicSpline
-    {
-      /// \brief Dummy constructor.
-      public: IntervalCubicSpline();
-
-      /// \brief Sets both control points.
-      /// \param[in] _startPoint start control point.
-      /// \param[in] _endPoint end control point.
-      public: void SetPoints(const ControlPoint &_startPoint,
-                             const ControlPoint &_endPoint);
-
-      /// \brief Gets the start control point.
-      /// \return the start control point.
-      public: inline const ControlPoint &StartPoint() const
-      {
-        return this->startPoint;
-      };
-
-      /// \brief Gets the end control point.
-      /// \return the end control point.
-      public: inline const ControlPoint &EndPoint() const
-      {
-        return this->endPoint;
-      };
-
-      /// \brief Interpolates the curve mth derivative at
-      /// parameter value \p _t.
-      /// \param[in] _mth order of curve derivative to interpolate.
-      /// \param[in] _t parameter value (range 0 to 1).
-      /// \return the interpolated mth derivative, or [INF, INF, INF]
-      /// on error. Use Vector3d::IsFinite() to check for an error.
-      public: Vector3d InterpolateMthDerivative(
-          const unsigned int _mth, const double _t) const;
-
-      /// \brief Gets curve arc length
-      /// \return the arc length
-      public: inline double ArcLength() const { return this->arcLength; }
-
-      /// \brief Gets curve arc length up to a given point \p _t.
-      /// \param[in] _t parameter value (range 0 to 1).
-      /// \return the arc length up to \p _t or INF on error.
-      public: double ArcLength(const double _t) const;
-
-      /// \internal
-      /// \brief Interpolates the curve mth derivative at parameter
-      /// value \p _t.
-      /// \param[in] _mth order of curve derivative to interpolate.
-      /// \param[in] _t parameter value (range 0 to 1).
-      /// \return the interpolated mth derivative of the curve.
-      private: Vector3d DoInterpolateMthDerivative(
-          const unsigned int _mth, const double _t) const;
-
-      /// \brief start control point for the curve.
-      private: ControlPoint startPoint;
-
-      /// \brief end control point for the curve.
-      private: ControlPoint endPoint;
-
-      /// \brief Bernstein-Hermite polynomial coefficients
-      /// for interpolation.
-      private: Matrix4d coeffs;
-
-      /// \brief curve arc length.
-      private: double arcLength;
-    };
-
-    /// \brief Private data for Spline class.
-    class SplinePrivate
-    {
-      /// \brief when true, the tangents are recalculated when the control
-      /// point change.
-      public: bool autoCalc;
-
-      /// \brief tension of 0 = Catmull-Rom spline, otherwise a Cardinal spline.
-      public: double tension;
-
-      /// \brief fixings for control points.
-      public: std::vector<bool> fixings;
-
-      /// \brief control points.
-      public: std::vector<ControlPoint> points;
-
-      // \brief interpolated segments.
-      public: std::vector<IntervalCubicSpline> segments;
-
-      // \brief segments arc length cumulative distribution.
-      public: std::vector<double> cumulativeArcLengths;
-
-      // \brief spline arc length.
-      public: double arcLength;
-    };
-    }
-  }
-}
-
-#endif
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SPLINEPRIVATE_HH_
+#define GZ_MATH_SPLINEPRIVATE_HH_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+#include <gz/math/Vector3.hh>
+#include <gz/math/Vector4.hh>
+#include <gz/math/Matrix4.hh>
+#include <gz/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    /// \brief Control point representation for
+    /// polynomial interpolation, defined in terms
+    /// of its first derivatives at such point, up to the third one of
+    /// cubic segments. They are stored in place, so control points never
+    /// allocate.
+    class ControlPoint
+    {
+      /// \brief Default constructor.
+      public: ControlPoint()
+      {
+      }
+
+      /// \brief Constructor that takes the derivatives that
+      /// define the control point.
+      /// \param[in] _initList with up to kMaxDerivatives derivatives.
+      public: ControlPoint(std::initializer_list<Vector3d> _initList)
+          : count(std::min(_initList.size(), kMaxDerivatives))
+      {
+        std::copy(_initList.begin(), _initList.begin() + this->count,
+                  this->derivatives.begin());
+      }
+
+      /// \brief Matches all mth derivatives defined in \p _other
+      /// to this.
+      /// \remarks Higher order derivatives in this and not defined
+      /// in \p _other are kept.
+      /// \param[in] _other control point to be matches.
+      public: inline void Match(const ControlPoint &_other)
+      {
+        std::copy(_other.derivatives.begin(),
+                  _other.derivatives.begin() + _other.count,
+                  this->derivatives.begin());
+        this->count = std::max(this->count, _other.count);
+      }
+
+      /// \brief Checks for control point equality.
+      /// \param[in] _other control point to compare against.
+      /// \return whether this and \p _other can be seen as equal.
+      public: inline bool operator==(const ControlPoint &_other) const
+      {
+        if (this->count != _other.count)
+          return false;
+
+        for (size_t i = 0; i < this->count; ++i)
+          if (this->derivatives[i] != _other.derivatives[i])
+            return false;
+
+        return true;
+      }
+
+      /// \brief Gets the mth derivative of this control point.
+      /// \remarks Higher derivatives than those defined
+      /// default to [0.0, 0.0, 0.0].
+      /// \param[in] _mth derivative order.
+      /// \return The mth derivative value.
+      public: inline Vector3d MthDerivative(const unsigned int _mth) const
+      {
+        if (_mth >= this->count)
+          return Vector3d(0.0, 0.0, 0.0);
+        return this->derivatives[_mth];
+      }
+
+      /// \brief Returns a mutable reference to the mth derivative of
+      /// this control point.
+      /// \remarks Higher derivatives than those defined
+      /// default to [0.0, 0.0, 0.0].
+      /// \param[in] _mth derivative order, lower than kMaxDerivatives.
+      /// \return The mth derivative value.
+      public: inline Vector3d& MthDerivative(const unsigned int _mth)
+      {
+        assert(_mth < kMaxDerivatives);
+        for (; this->count <= _mth; ++this->count)
+          this->derivatives[this->count] = Vector3d(0.0, 0.0, 0.0);
+        return this->derivatives[_mth];
+      }
+
+      /// \brief Maximum number of derivatives of a control point.
+      public: static constexpr std::size_t kMaxDerivatives = 4;
+
+      /// \brief control point derivatives (0 to count-1).
+      private: std::array<Vector3d, kMaxDerivatives> derivatives;
+
+      /// \brief Number of derivatives defined.
+      private: std::size_t count = 0;
+    };
+
+    /// \brief Cubic interpolator for splines defined
+    /// between each pair of control points.
+    class IntervalCubicSpline
+    {
+      /// \brief Dummy constructor.
+      public: IntervalCubicSpline();
+
+      /// \brief Sets both control points.
+      /// \param[in] _startPoint start control point.
+      /// \param[in] _endPoint end control point.
+      public: void SetPoints(const ControlPoint &_startPoint,
+                             const ControlPoint &_endPoint);
+
+      /// \brief Gets the start control point.
+      /// \return the start control point.
+      public: inline const ControlPoint &StartPoint() const
+      {
+        return this->startPoint;
+      };
+
+      /// \brief Gets the end control point.
+      /// \return the end control point.
+      public: inline const ControlPoint &EndPoint() const
+      {
+        return this->endPoint;
+      };
+
+      /// \brief Interpolates the curve mth derivative at
+      /// parameter value \p _t.
+      /// \param[in] _mth order of curve derivative to interpolate.
+      /// \param[in] _t parameter value (range 0 to 1).
+      /// \return the interpolated mth derivative, or [INF, INF, INF]
+      /// on error. Use Vector3d::IsFinite() to check for an error.
+      public: Vector3d InterpolateMthDerivative(
+          const unsigned int _mth, const double _t) const;
+
+      /// \brief Gets curve arc length
+      /// \return the arc length
+      public: inline double ArcLength() const { return this->arcLength; }
+
+      /// \brief Gets curve arc length up to a given point \p _t.
+      /// \param[in] _t parameter value (range 0 to 1).
+      /// \return the arc length up to \p _t or INF on error.
+      public: double ArcLength(const double _t) const;
+
+      /// \brief Gets an axis aligned box that contains the curve, the
+      /// box of its Bezier control points.
+      /// \param[out] _min Minimum corner of the box.
+      /// \param[out] _max Maximum corner of the box.
+      public: void Bounds(Vector3d &_min, Vector3d &_max) const;
+
+      /// \brief Finds the parameter value of the point of the curve
+      /// closest to a given point. Every minimum of the squared distance
+      /// is found, as a root of its derivative or an end of the curve.
+      /// \param[in] _point Point to project on the curve.
+      /// \param[out] _squaredDistance Squared distance from \p _point to
+      /// the closest point.
+      /// \return the parameter value (range 0 to 1).
+      public: double ClosestParameter(const Vector3d &_point,
+                                      double &_squaredDistance) const;
+
+      /// \internal
+      /// \brief Interpolates the curve mth derivative at parameter
+      /// value \p _t.
+      /// \param[in] _mth order of curve derivative to interpolate.
+      /// \param[in] _t parameter value (range 0 to 1).
+      /// \return the interpolated mth derivative of the curve.
+      private: Vector3d DoInterpolateMthDerivative(
+          const unsigned int _mth, const double _t) const;
+
+      /// \brief start control point for the curve.
+      private: ControlPoint startPoint;
+
+      /// \brief end control point for the curve.
+      private: ControlPoint endPoint;
+
+      /// \brief Bernstein-Hermite polynomial coefficients
+      /// for interpolation.
+      private: Matrix4d coeffs;
+
+      /// \brief curve arc length.
+      private: double arcLength;
+    };
+
+    /// \brief Data of a Spline, shared by copies of the spline until one
+    /// of them changes.
+    class SplineData
+    {
+      /// \brief Constructor.
+      /// \param[in] _resource Memory resource of the arrays.
+      public: explicit SplineData(std::pmr::memory_resource *_resource)
+        : fixings(_resource), points(_resource), segments(_resource),
+          cumulativeArcLengths(_resource), arcLengthTable(_resource),
+          boundsTable(_resource)
+      {
+      }
+
+      /// \brief Copy constructor, used to copy the data shared by several
+      /// splines before one of them changes it. The arrays use the memory
+      /// resource of _other.
+      /// \param[in] _other Data to copy.
+      public: SplineData(const SplineData &_other);
+
+      /// \brief when true, the tangents are recalculated when the control
+      /// point change.
+      public: bool autoCalc;
+
+      /// \brief tension of 0 = Catmull-Rom spline, otherwise a Cardinal spline.
+      public: double tension;
+
+      /// \brief fixings for control points.
+      public: std::pmr::vector<bool> fixings;
+
+      /// \brief control points.
+      public: std::pmr::vector<ControlPoint> points;
+
+      // \brief interpolated segments.
+      public: std::pmr::vector<IntervalCubicSpline> segments;
+
+      // \brief segments arc length cumulative distribution.
+      public: std::pmr::vector<double> cumulativeArcLengths;
+
+      // \brief spline arc length.
+      public: double arcLength;
+
+      /// \brief True if the tangents may not match the control points,
+      /// because points or the tension changed while autoCalc was false.
+      /// Point changes then recalculate all the tangents instead of only
+      /// those around the changed point.
+      public: bool tangentsOutdated = false;
+
+      /// \brief Whether the first and last points were equal when the
+      /// tangents were last calculated.
+      public: bool closed = false;
+
+      /// \brief Number of arc length table samples per segment.
+      public: unsigned int arcLengthResolution = 16;
+
+      /// \brief Arc length from the start of the spline at uniformly
+      /// spaced parameter values of each segment. The j-th sample of the
+      /// i-th segment is at index i * arcLengthResolution + j, and the last
+      /// entry is the spline arc length.
+      public: std::pmr::vector<double> arcLengthTable;
+
+      /// \brief True if the arc length table must be rebuilt before use.
+      public: std::atomic<bool> arcLengthTableDirty{true};
+
+      /// \brief Mutex that protects the lazy arc length table build.
+      public: mutable std::mutex arcLengthTableMutex;
+
+      /// \brief Number of segments in each block of the bounds table.
+      public: static constexpr std::size_t kBoundsBlockSize = 16;
+
+      /// \brief Axis aligned boxes of the segments, followed by the boxes
+      /// of blocks of kBoundsBlockSize consecutive segments. Each box is
+      /// stored as its minimum and maximum corners, so the box of the
+      /// i-th segment is at index 2 * i.
+      public: std::pmr::vector<Vector3d> boundsTable;
+
+      /// \brief True if the bounds table must be rebuilt before use.
+      public: std::atomic<bool> boundsTableDirty{true};
+
+      /// \brief Mutex that protects the lazy bounds table build.
+      public: mutable std::mutex boundsTableMutex;
+    };
+
+    /// \brief Private data for Spline class.
+    class SplinePrivate
+    {
+      /// \brief Constructor.
+      /// \param[in] _resource Memory resource of the arrays.
+      public: explicit SplinePrivate(std::pmr::memory_resource *_resource)
+        : data(std::make_shared<SplineData>(_resource))
+      {
+      }
+
+      /// \brief Get the data to change it, copying it first if other
+      /// splines share it.
+      /// \return The data, only used by this spline.
+      public: SplineData &Mutable();
+
+      /// \brief Data of the spline, shared by its copies until one of
+      /// them changes.
+      public: std::shared_ptr<SplineData> data;
+    };
+    }
+  }
+}
+
+#endif
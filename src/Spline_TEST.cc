@@ -17,11 +17,48 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <memory_resource>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Rand.hh"
 #include "gz/math/Vector3.hh"
 #include "gz/math/Spline.hh"
 
 using namespace gz;
 
+/////////////////////////////////////////////////
+/// \brief Memory resource which counts its allocations.
+class CountingResource : public std::pmr::memory_resource
+{
+  /// \brief Number of allocations.
+  public: std::size_t allocations = 0;
+
+  private: void *do_allocate(std::size_t _bytes,
+                             std::size_t _alignment) override
+  {
+    ++this->allocations;
+    return std::pmr::new_delete_resource()->allocate(_bytes, _alignment);
+  }
+
+  private: void do_deallocate(void *_p, std::size_t _bytes,
+                              std::size_t _alignment) override
+  {
+    std::pmr::new_delete_resource()->deallocate(_p, _bytes, _alignment);
+  }
+
+  private: bool do_is_equal(
+               const std::pmr::memory_resource &_other) const noexcept override
+  {
+    return this == &_other;
+  }
+};
+
 /////////////////////////////////////////////////
 TEST(SplineTest, Spline)
 {
@@ -99,6 +136,202 @@ TEST(SplineTest, ArcLength)
   EXPECT_FALSE(std::isfinite(s.ArcLength(4, 0.0)));
 }
 
+/////////////////////////////////////////////////
+TEST(SplineTest, ArcLengthTable)
+{
+  math::Spline s;
+  EXPECT_EQ(16u, s.ArcLengthResolution());
+  EXPECT_FALSE(std::isfinite(s.ParameterAtDistance(0.0)));
+  EXPECT_FALSE(s.InterpolateByDistance(0.0).IsFinite());
+
+  // Points at uneven distances, so that the parameter is far from
+  // proportional to the arc length.
+  s.AddPoint(math::Vector3d(0, 0, 0));
+  s.AddPoint(math::Vector3d(1, 0, 0));
+  s.AddPoint(math::Vector3d(1, 5, 0));
+  s.AddPoint(math::Vector3d(2, 5, 1));
+  s.AddPoint(math::Vector3d(10, 6, 1));
+  const double length = s.ArcLength();
+
+  EXPECT_DOUBLE_EQ(0.0, s.ParameterAtDistance(0.0));
+  EXPECT_DOUBLE_EQ(1.0, s.ParameterAtDistance(length));
+  EXPECT_EQ(s.Point(0), s.InterpolateByDistance(0.0));
+  EXPECT_EQ(s.Point(4), s.InterpolateByDistance(length));
+  EXPECT_FALSE(std::isfinite(s.ParameterAtDistance(-0.1)));
+  EXPECT_FALSE(s.InterpolateByDistance(length + 0.1).IsFinite());
+
+  for (unsigned int resolution : {1u, 16u, 64u})
+  {
+    s.ArcLengthResolution(resolution);
+    EXPECT_EQ(resolution, s.ArcLengthResolution());
+
+    // The spline arc length at the parameter value is the distance, up to
+    // the linear interpolation of the table, whose error decreases with the
+    // square of the resolution.
+    const double tolerance = 3.0 / (resolution * resolution);
+    double previous = 0.0;
+    for (int i = 0; i <= 100; ++i)
+    {
+      const double distance = length * i / 100.0;
+      const double t = s.ParameterAtDistance(distance);
+      EXPECT_GE(t, previous);
+      previous = t;
+      EXPECT_NEAR(distance, s.ArcLength(t), tolerance);
+      EXPECT_EQ(s.Interpolate(t), s.InterpolateByDistance(distance));
+    }
+  }
+
+  s.ArcLengthResolution(0);
+  EXPECT_EQ(1u, s.ArcLengthResolution());
+
+  // The table follows changes to the spline.
+  s.ArcLengthResolution(16);
+  s.UpdatePoint(4, math::Vector3d(2, 6, 1));
+  EXPECT_LT(s.ArcLength(), length);
+  EXPECT_EQ(s.Point(4), s.InterpolateByDistance(s.ArcLength()));
+  EXPECT_FALSE(s.InterpolateByDistance(length).IsFinite());
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, ClosestParameter)
+{
+  math::Spline s;
+  EXPECT_FALSE(std::isfinite(s.ClosestParameter(math::Vector3d::Zero)));
+  EXPECT_FALSE(std::isfinite(
+      s.ClosestParameter(math::Vector3d::Zero, 0.0, 1.0)));
+
+  // A helix with enough segments to use several blocks of bounds.
+  const int kPoints = 101;
+  for (int i = 0; i < kPoints; ++i)
+  {
+    const double angle = 0.2 * i;
+    s.AddPoint(math::Vector3d(
+        5 * std::cos(angle), 5 * std::sin(angle), 0.1 * i));
+  }
+
+  // Dense sampling of the spline finds the closest point up to the
+  // sampling step.
+  std::vector<double> samples(20001);
+  std::vector<math::Vector3d> points(samples.size());
+  for (size_t i = 0; i < samples.size(); ++i)
+    samples[i] = static_cast<double>(i) / (samples.size() - 1);
+  ASSERT_TRUE(s.Interpolate(samples.data(), samples.size(), points.data()));
+  auto sampledDistance = [&](const math::Vector3d &_p)
+  {
+    double result = math::INF_D;
+    for (const auto &point : points)
+      result = std::min(result, point.Distance(_p));
+    return result;
+  };
+
+  for (const math::Vector3d &p : {math::Vector3d(0, 0, 5),
+                                  math::Vector3d(6, 1, 3),
+                                  math::Vector3d(-4, 2, -1),
+                                  math::Vector3d(1, -7, 12),
+                                  math::Vector3d(5, 0, 0)})
+  {
+    const double t = s.ClosestParameter(p);
+    ASSERT_GE(t, 0.0);
+    ASSERT_LE(t, 1.0);
+    EXPECT_LE(s.Interpolate(t).Distance(p), sampledDistance(p) + 1e-9);
+    EXPECT_GE(s.Interpolate(t).Distance(p), sampledDistance(p) - 1e-3);
+  }
+  EXPECT_NEAR(0.0, s.ClosestParameter(s.Point(0)), 1e-9);
+  EXPECT_NEAR(1.0, s.ClosestParameter(s.Point(kPoints - 1)), 1e-9);
+  EXPECT_FALSE(std::isfinite(
+      s.ClosestParameter(math::Vector3d(math::NAN_D, 0, 0))));
+
+  // Track a point moving along the spline, slightly off it. The helix
+  // turns are 0.2 * 2 pi / 0.2 * 0.1 ~ 3.1 apart, closer than the
+  // offset, but the window only covers nearby turns.
+  double t = 0.0;
+  for (int i = 0; i <= 200; ++i)
+  {
+    const double expected = i / 200.0;
+    const math::Vector3d p = s.Interpolate(expected) +
+        math::Vector3d(0.05, -0.05, 0.02);
+    t = s.ClosestParameter(p, t, 2.0);
+    ASSERT_TRUE(std::isfinite(t));
+    EXPECT_NEAR(expected, t, 0.01);
+    EXPECT_LE(s.Interpolate(t).Distance(p), 0.1);
+  }
+
+  // A window of zero only searches the segment of the previous value.
+  const double end = s.ClosestParameter(s.Point(kPoints - 1), 0.0, 0.0);
+  EXPECT_LT(end, 0.02);
+
+  // Projections follow changes to the spline.
+  s.UpdatePoint(50, math::Vector3d(20, 20, 20));
+  EXPECT_NEAR(0.0, s.Interpolate(s.ClosestParameter(
+      math::Vector3d(20, 20, 20))).Distance(s.Point(50)), 1e-6);
+
+  // Closed splines wrap around their ends.
+  math::Spline loop;
+  loop.AddPoint(math::Vector3d(0, 0, 0));
+  loop.AddPoint(math::Vector3d(1, 0, 0));
+  loop.AddPoint(math::Vector3d(1, 1, 0));
+  loop.AddPoint(math::Vector3d(0, 1, 0));
+  loop.AddPoint(math::Vector3d(0, 0, 0));
+  const math::Vector3d nearEnd = loop.Interpolate(0.98);
+  const double wrapped = loop.ClosestParameter(nearEnd, 0.01, 0.2);
+  EXPECT_NEAR(0.98, wrapped, 1e-6);
+  const math::Vector3d nearStart = loop.Interpolate(0.02);
+  EXPECT_NEAR(0.02, loop.ClosestParameter(nearStart, wrapped, 0.2), 1e-6);
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, ClosestParameterRandom)
+{
+  std::mt19937 generator(4);
+  std::uniform_real_distribution<double> coordinate(-10.0, 10.0);
+  std::uniform_real_distribution<double> tension(0.0, 1.0);
+  std::vector<double> samples(20001);
+  for (size_t i = 0; i < samples.size(); ++i)
+    samples[i] = static_cast<double>(i) / (samples.size() - 1);
+  std::vector<math::Vector3d> points(samples.size());
+
+  for (int n = 0; n < 20; ++n)
+  {
+    math::Spline s;
+    s.Tension(tension(generator));
+    const int numPoints = 14;
+    for (int i = 0; i < numPoints; ++i)
+    {
+      s.AddPoint(math::Vector3d(coordinate(generator),
+          coordinate(generator), coordinate(generator)));
+    }
+    if (n % 2)
+      s.AddPoint(s.Point(0));
+
+    // A projection on a knot is a valid parameter value of that knot.
+    for (unsigned int i = 0; i < s.PointCount(); ++i)
+    {
+      const math::Vector3d knot = s.Point(i);
+      const double t = s.ClosestParameter(knot);
+      ASSERT_TRUE(s.Interpolate(t).IsFinite()) << n << " " << i;
+      EXPECT_NEAR(0.0, s.Interpolate(t).Distance(knot), 1e-6);
+    }
+
+    // No sample is closer than the projection, even with several local
+    // minima of the distance to a segment.
+    ASSERT_TRUE(s.Interpolate(samples.data(), samples.size(),
+                              points.data()));
+    for (int k = 0; k < 20; ++k)
+    {
+      const math::Vector3d p(coordinate(generator), coordinate(generator),
+                             coordinate(generator));
+      double sampled = math::INF_D;
+      for (const auto &point : points)
+        sampled = std::min(sampled, point.Distance(p));
+
+      const double t = s.ClosestParameter(p);
+      ASSERT_TRUE(s.Interpolate(t).IsFinite());
+      EXPECT_LE(s.Interpolate(t).Distance(p), sampled + 1e-9)
+          << n << " " << k;
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 TEST(SplineTest, Tension)
 {
@@ -137,6 +370,67 @@ TEST(SplineTest, Interpolate)
   EXPECT_EQ(s.InterpolateMthDerivative(4, 1.0), math::Vector3d(0, 0, 0));
 }
 
+/////////////////////////////////////////////////
+TEST(SplineTest, InterpolateBatch)
+{
+  math::Spline s;
+  const double t[] = {-0.5, 0.0, 0.3, 1.0, 1.5};
+  math::Vector3d points[5];
+
+  // Empty spline
+  EXPECT_FALSE(s.Interpolate(t, 5, points));
+  for (const auto &p : points)
+    EXPECT_FALSE(p.IsFinite());
+
+  // A single point is returned for every parameter value
+  s.AddPoint(math::Vector3d(1, 2, 3));
+  EXPECT_TRUE(s.Interpolate(t, 5, points));
+  for (const auto &p : points)
+    EXPECT_EQ(math::Vector3d(1, 2, 3), p);
+
+  // Segments of uneven lengths
+  s.AddPoint(math::Vector3d(2, 2, 3));
+  s.AddPoint(math::Vector3d(2, 7, 3));
+  s.AddPoint(math::Vector3d(3, 7, 4));
+  s.AddPoint(math::Vector3d(3, 7, 4.5));
+
+  // Sorted values, including out of range ones and segment boundaries
+  std::vector<double> sorted = {-0.5, -1e-9, 0.0};
+  for (int i = 1; i < 200; ++i)
+    sorted.push_back(i / 200.0);
+  for (unsigned int i = 1; i < s.PointCount() - 1; ++i)
+    sorted.push_back(s.ArcLength(i - 1, 1.0) / s.ArcLength());
+  sorted.push_back(1.0);
+  sorted.push_back(1.0 + 1e-9);
+  sorted.push_back(1.5);
+  std::sort(sorted.begin(), sorted.end());
+
+  // Unsorted values restart the walk
+  std::vector<double> unsorted = sorted;
+  std::reverse(unsorted.begin(), unsorted.end());
+  std::rotate(unsorted.begin(), unsorted.begin() + 50, unsorted.end());
+
+  for (const auto &values : {sorted, unsorted})
+  {
+    std::vector<math::Vector3d> result(values.size());
+    EXPECT_TRUE(s.Interpolate(values.data(), values.size(), result.data()));
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      const math::Vector3d expected = s.Interpolate(values[i]);
+      EXPECT_EQ(expected.IsFinite(), result[i].IsFinite()) << values[i];
+      if (expected.IsFinite())
+      {
+        EXPECT_DOUBLE_EQ(expected.X(), result[i].X()) << values[i];
+        EXPECT_DOUBLE_EQ(expected.Y(), result[i].Y()) << values[i];
+        EXPECT_DOUBLE_EQ(expected.Z(), result[i].Z()) << values[i];
+      }
+    }
+  }
+
+  // Nothing is written for an empty batch
+  EXPECT_TRUE(s.Interpolate(nullptr, 0, nullptr));
+}
+
 /////////////////////////////////////////////////
 TEST(SplineTest, Point)
 {
@@ -177,3 +471,249 @@ TEST(SplineTest, RecalcTangents)
   EXPECT_EQ(s.Interpolate(0, 0.5), math::Vector3d(0.2, 0.2, 0.2));
   EXPECT_EQ(s.Interpolate(1, 0.5), math::Vector3d(0.2, 0.2, 0.2));
 }
+
+/////////////////////////////////////////////////
+// Check that a spline matches one with the same control points and
+// tangents recalculated from scratch.
+void ExpectRecalculated(const math::Spline &_s,
+    const std::vector<math::Vector3d> &_points, const double _tension = 0.0)
+{
+  math::Spline reference;
+  reference.AutoCalculate(false);
+  reference.Tension(_tension);
+  for (const auto &p : _points)
+    reference.AddPoint(p);
+  reference.RecalcTangents();
+
+  ASSERT_EQ(reference.PointCount(), _s.PointCount());
+  for (unsigned int i = 0; i < _s.PointCount(); ++i)
+  {
+    EXPECT_EQ(reference.Point(i), _s.Point(i)) << i;
+    EXPECT_EQ(reference.Tangent(i), _s.Tangent(i)) << i;
+  }
+  EXPECT_DOUBLE_EQ(reference.ArcLength(), _s.ArcLength());
+  for (double t = 0.0; t <= 1.0; t += 0.0625)
+    EXPECT_EQ(reference.Interpolate(t), _s.Interpolate(t)) << t;
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, IncrementalTangents)
+{
+  math::Rand::Seed(1234);
+  auto randomPoint = []()
+  {
+    return math::Vector3d(math::Rand::DblUniform(-10, 10),
+                          math::Rand::DblUniform(-10, 10),
+                          math::Rand::DblUniform(-10, 10));
+  };
+
+  // Streaming appends only update the end of the spline
+  math::Spline s;
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 40; ++i)
+  {
+    points.push_back(randomPoint());
+    s.AddPoint(points.back());
+    if (points.size() >= 2)
+      ExpectRecalculated(s, points);
+  }
+
+  // Updates at the ends, next to the ends and in the middle
+  for (unsigned int i : {0u, 1u, 20u, 38u, 39u, 20u, 0u})
+  {
+    points[i] = randomPoint();
+    EXPECT_TRUE(s.UpdatePoint(i, points[i]));
+    ExpectRecalculated(s, points);
+  }
+
+  // Closing the spline changes the tangents of both ends, and so does
+  // opening it again
+  points.back() = points.front();
+  EXPECT_TRUE(s.UpdatePoint(39, points.back()));
+  ExpectRecalculated(s, points);
+  for (unsigned int i : {1u, 38u, 20u})
+  {
+    points[i] = randomPoint();
+    EXPECT_TRUE(s.UpdatePoint(i, points[i]));
+    ExpectRecalculated(s, points);
+  }
+  points.push_back(randomPoint());
+  s.AddPoint(points.back());
+  ExpectRecalculated(s, points);
+
+  // Fixed tangents are kept, and their neighbours are still updated
+  const math::Vector3d tangent(1, 2, 3);
+  EXPECT_TRUE(s.UpdatePoint(10, points[10], tangent));
+  points[11] = randomPoint();
+  EXPECT_TRUE(s.UpdatePoint(11, points[11]));
+  EXPECT_EQ(tangent, s.Tangent(10));
+  EXPECT_EQ((points[12] - points[10]) * 0.5, s.Tangent(11));
+
+  // Changes made without AutoCalculate are caught up on the next change
+  math::Spline deferred;
+  deferred.AutoCalculate(false);
+  std::vector<math::Vector3d> deferredPoints;
+  for (int i = 0; i < 10; ++i)
+  {
+    deferredPoints.push_back(randomPoint());
+    deferred.AddPoint(deferredPoints.back());
+  }
+  deferred.Tension(0.3);
+  deferred.AutoCalculate(true);
+  deferredPoints[5] = randomPoint();
+  EXPECT_TRUE(deferred.UpdatePoint(5, deferredPoints[5]));
+  ExpectRecalculated(deferred, deferredPoints, 0.3);
+  deferredPoints.push_back(randomPoint());
+  deferred.AddPoint(deferredPoints.back());
+  ExpectRecalculated(deferred, deferredPoints, 0.3);
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, MemoryResource)
+{
+  CountingResource resource;
+  math::Spline s(&resource);
+  math::Spline expected;
+  for (int i = 0; i < 20; ++i)
+  {
+    const math::Vector3d p(i, i * i * 0.1, -i);
+    s.AddPoint(p);
+    expected.AddPoint(p);
+  }
+  EXPECT_LT(0u, resource.allocations);
+  EXPECT_DOUBLE_EQ(expected.ArcLength(), s.ArcLength());
+  for (double t = 0; t <= 1; t += 0.05)
+  {
+    EXPECT_EQ(expected.Interpolate(t), s.Interpolate(t));
+    EXPECT_EQ(expected.InterpolateTangent(t), s.InterpolateTangent(t));
+  }
+
+  // Evaluation doesn't allocate once the arc length table is built
+  const std::size_t allocations = resource.allocations;
+  s.Interpolate(0.3);
+  s.ArcLength(0.5);
+  EXPECT_EQ(allocations, resource.allocations);
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, CopyOnWrite)
+{
+  EXPECT_TRUE(std::is_nothrow_move_constructible<math::Spline>::value);
+  EXPECT_TRUE(std::is_nothrow_move_assignable<math::Spline>::value);
+
+  CountingResource resource;
+  math::Spline s(&resource);
+  for (int i = 0; i < 10; ++i)
+    s.AddPoint(math::Vector3d(i, i * i * 0.1, -i));
+  const double arcLength = s.ArcLength();
+
+  // Copies share the data until one of them changes
+  std::size_t allocations = resource.allocations;
+  math::Spline copy(s);
+  math::Spline assigned;
+  assigned = s;
+  EXPECT_EQ(allocations, resource.allocations);
+  EXPECT_DOUBLE_EQ(arcLength, copy.ArcLength());
+  EXPECT_EQ(s.Interpolate(0.3), assigned.Interpolate(0.3));
+
+  // Changing a copy leaves the others as they were
+  copy.UpdatePoint(0, math::Vector3d(-5, 0, 0));
+  EXPECT_LT(allocations, resource.allocations);
+  EXPECT_EQ(math::Vector3d(-5, 0, 0), copy.Point(0));
+  EXPECT_EQ(math::Vector3d(0, 0, 0), s.Point(0));
+  EXPECT_DOUBLE_EQ(arcLength, s.ArcLength());
+  EXPECT_LT(arcLength, copy.ArcLength());
+
+  s.Clear();
+  EXPECT_EQ(0u, s.PointCount());
+  EXPECT_EQ(10u, assigned.PointCount());
+  EXPECT_DOUBLE_EQ(arcLength, assigned.ArcLength());
+
+  // Copies evaluated from several threads build the shared arc length
+  // table once
+  math::Spline shared;
+  for (int i = 0; i < 50; ++i)
+    shared.AddPoint(math::Vector3d(i, std::sin(i * 0.3), 0));
+  const math::Spline expected(shared);
+  std::vector<std::thread> threads;
+  std::vector<double> lengths(4);
+  for (std::size_t t = 0; t < lengths.size(); ++t)
+  {
+    threads.emplace_back([&, t]
+    {
+      math::Spline local(expected);
+      lengths[t] = local.ArcLength(0.5);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  for (double length : lengths)
+    EXPECT_DOUBLE_EQ(shared.ArcLength(0.5), length);
+
+  // Moves keep the data, and moved from splines can be assigned to
+  math::Spline moved(std::move(assigned));
+  EXPECT_EQ(10u, moved.PointCount());
+  assigned = std::move(moved);
+  EXPECT_EQ(10u, assigned.PointCount());
+  moved = copy;
+  EXPECT_EQ(copy.Point(0), moved.Point(0));
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, Finalize)
+{
+  math::Spline s;
+  EXPECT_FALSE(s.Finalized());
+  for (int i = 0; i < 100; ++i)
+    s.AddPoint(math::Vector3d(i, std::sin(i * 0.2), std::cos(i * 0.1)));
+  EXPECT_FALSE(s.Finalized());
+
+  s.Finalize();
+  EXPECT_TRUE(s.Finalized());
+
+  // Edits invalidate the tables, and queries build them again
+  s.UpdatePoint(3, math::Vector3d(3, 2, 1));
+  EXPECT_FALSE(s.Finalized());
+  s.InterpolateByDistance(1.0);
+  s.ClosestParameter(math::Vector3d::Zero);
+  EXPECT_TRUE(s.Finalized());
+  s.ArcLengthResolution(8);
+  EXPECT_FALSE(s.Finalized());
+  s.Finalize();
+
+  // Copies share the finalized data
+  const math::Spline copy(s);
+  EXPECT_TRUE(copy.Finalized());
+
+  // Threads query one finalized spline without building anything
+  const math::Spline &shared = s;
+  std::vector<math::Vector3d> expected(64);
+  std::vector<double> closest(expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i)
+  {
+    expected[i] = shared.InterpolateByDistance(i * 1.5);
+    closest[i] = shared.ClosestParameter(expected[i]);
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(4, 0);
+  for (std::size_t t = 0; t < mismatches.size(); ++t)
+  {
+    threads.emplace_back([&, t]
+    {
+      for (std::size_t i = 0; i < expected.size(); ++i)
+      {
+        if (shared.InterpolateByDistance(i * 1.5) != expected[i] ||
+            !math::equal(shared.ClosestParameter(expected[i]), closest[i]))
+        {
+          ++mismatches[t];
+        }
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  for (int count : mismatches)
+    EXPECT_EQ(0, count);
+  EXPECT_TRUE(shared.Finalized());
+}
@@ -0,0 +1,407 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gz/math/SweepAndPrune.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Minimum number of boxes swept by each thread.
+  constexpr std::size_t kMinBoxesPerThread = 2048;
+
+  /// \brief A box in a sorted list.
+  struct Entry
+  {
+    /// \brief Minimum of the box along the axis of the list, as of the
+    /// last sort.
+    double min;
+
+    /// \brief Id of the box.
+    std::size_t id;
+  };
+
+  /// \brief The extents of a box needed by the sweep, stored in the order
+  /// of the swept list so that the sweep reads memory in order.
+  struct SweepBox
+  {
+    /// \brief Maximum along the swept axis.
+    double max;
+
+    /// \brief Minimum along the first other axis.
+    double min1;
+
+    /// \brief Maximum along the first other axis.
+    double max1;
+
+    /// \brief Minimum along the second other axis.
+    double min2;
+
+    /// \brief Maximum along the second other axis.
+    double max2;
+
+    /// \brief Id of the box.
+    std::size_t id;
+  };
+
+  /// \brief Check if a box is finite and not empty.
+  /// \param[in] _box Box to check.
+  /// \return True if the box is valid.
+  bool Valid(const AxisAlignedBox &_box)
+  {
+    return _box.Min().IsFinite() && _box.Max().IsFinite() &&
+           _box.Min().X() <= _box.Max().X() &&
+           _box.Min().Y() <= _box.Max().Y() &&
+           _box.Min().Z() <= _box.Max().Z();
+  }
+}
+
+/// \brief Private data for the SweepAndPrune class.
+class gz::math::SweepAndPrunePrivate
+{
+  /// \brief Choose the axis along which the centers of the boxes have the
+  /// largest variance.
+  /// \return The axis.
+  public: int ChooseAxis() const
+  {
+    double sum[3] = {0, 0, 0};
+    double sumSquares[3] = {0, 0, 0};
+    for (std::size_t id = 0; id < this->boxes.size(); ++id)
+    {
+      if (!this->used[id])
+        continue;
+      const Vector3d center =
+        (this->boxes[id].Min() + this->boxes[id].Max()) * 0.5;
+      for (int i = 0; i < 3; ++i)
+      {
+        sum[i] += center[i];
+        sumSquares[i] += center[i] * center[i];
+      }
+    }
+
+    int best = 0;
+    double bestVariance = -1.0;
+    for (int i = 0; i < 3; ++i)
+    {
+      // The count is the same for every axis, so it is left out.
+      const double variance = sumSquares[i] -
+        sum[i] * sum[i] / static_cast<double>(this->size);
+      if (variance > bestVariance)
+      {
+        best = i;
+        bestVariance = variance;
+      }
+    }
+    return best;
+  }
+
+  /// \brief Sort the list of an axis by insertion sort, and copy the
+  /// boxes in its order for the sweep.
+  /// \param[in] _axis The axis.
+  public: void Sort(const int _axis)
+  {
+    std::vector<Entry> &list = this->lists[_axis];
+    for (Entry &entry : list)
+      entry.min = this->boxes[entry.id].Min()[_axis];
+
+    auto less = [](const Entry &_a, const Entry &_b)
+    {
+      return _a.min < _b.min;
+    };
+
+    // Many new boxes at the end of the list would make insertion sort
+    // quadratic.
+    if (this->inserted[_axis] > list.size() / 8 + 16)
+    {
+      std::sort(list.begin(), list.end(), less);
+    }
+    else
+    {
+      for (std::size_t i = 1; i < list.size(); ++i)
+      {
+        if (!less(list[i], list[i - 1]))
+          continue;
+        const Entry entry = list[i];
+        std::size_t j = i;
+        do
+        {
+          list[j] = list[j - 1];
+          --j;
+        } while (j > 0 && less(entry, list[j - 1]));
+        list[j] = entry;
+      }
+    }
+    this->inserted[_axis] = 0;
+
+    const int axis1 = (_axis + 1) % 3;
+    const int axis2 = (_axis + 2) % 3;
+    this->sweepMin.resize(list.size());
+    this->sweepBoxes.resize(list.size());
+    for (std::size_t i = 0; i < list.size(); ++i)
+    {
+      const AxisAlignedBox &box = this->boxes[list[i].id];
+      this->sweepMin[i] = list[i].min;
+      SweepBox &sweepBox = this->sweepBoxes[i];
+      sweepBox.max = box.Max()[_axis];
+      sweepBox.min1 = box.Min()[axis1];
+      sweepBox.max1 = box.Max()[axis1];
+      sweepBox.min2 = box.Min()[axis2];
+      sweepBox.max2 = box.Max()[axis2];
+      sweepBox.id = list[i].id;
+    }
+  }
+
+  /// \brief Sweep part of the boxes copied by Sort().
+  /// \param[in] _begin First box to sweep.
+  /// \param[in] _end One past the last box to sweep.
+  /// \param[out] _pairs Pairs found, appended.
+  public: void Sweep(const std::size_t _begin, const std::size_t _end,
+      std::vector<std::pair<std::size_t, std::size_t>> &_pairs) const
+  {
+    const std::size_t count = this->sweepMin.size();
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      const SweepBox &a = this->sweepBoxes[i];
+      for (std::size_t j = i + 1;
+           j < count && this->sweepMin[j] <= a.max; ++j)
+      {
+        const SweepBox &b = this->sweepBoxes[j];
+        // Non short-circuit tests, which branch less.
+        if ((a.max1 >= b.min1) & (a.min1 <= b.max1) &
+            (a.max2 >= b.min2) & (a.min2 <= b.max2))
+        {
+          _pairs.emplace_back(std::min(a.id, b.id), std::max(a.id, b.id));
+        }
+      }
+    }
+  }
+
+  /// \brief Boxes indexed by id, including unused ones.
+  public: std::vector<AxisAlignedBox> boxes;
+
+  /// \brief Whether each id is used.
+  public: std::vector<bool> used;
+
+  /// \brief Unused ids.
+  public: std::vector<std::size_t> freeIds;
+
+  /// \brief Boxes sorted by their minimum along each axis, as of the last
+  /// sort of the list, followed by the boxes inserted since.
+  public: std::vector<Entry> lists[3];
+
+  /// \brief Minimum of the boxes along the swept axis, in sweep order.
+  public: std::vector<double> sweepMin;
+
+  /// \brief Other extents of the boxes, in sweep order.
+  public: std::vector<SweepBox> sweepBoxes;
+
+  /// \brief Number of boxes inserted in each list since it was sorted.
+  public: std::size_t inserted[3] = {0, 0, 0};
+
+  /// \brief Number of boxes.
+  public: std::size_t size = 0;
+
+  /// \brief Axis of the last sweep.
+  public: int axis = 0;
+
+  /// \brief Pairs found by each thread but the first, kept to reuse
+  /// their memory.
+  public: std::vector<std::vector<std::pair<std::size_t, std::size_t>>>
+          threadPairs;
+};
+
+/////////////////////////////////////////////////
+SweepAndPrune::SweepAndPrune()
+  : dataPtr(std::make_unique<SweepAndPrunePrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+SweepAndPrune::SweepAndPrune(const SweepAndPrune &_sap)
+  : dataPtr(std::make_unique<SweepAndPrunePrivate>(*_sap.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+SweepAndPrune::~SweepAndPrune() = default;
+
+/////////////////////////////////////////////////
+SweepAndPrune &SweepAndPrune::operator=(const SweepAndPrune &_sap)
+{
+  *this->dataPtr = *_sap.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+std::size_t SweepAndPrune::Insert(const AxisAlignedBox &_box)
+{
+  if (!Valid(_box))
+    return kNull;
+
+  auto &d = *this->dataPtr;
+  std::size_t id;
+  if (d.freeIds.empty())
+  {
+    id = d.boxes.size();
+    d.boxes.push_back(_box);
+    d.used.push_back(true);
+  }
+  else
+  {
+    id = d.freeIds.back();
+    d.freeIds.pop_back();
+    d.boxes[id] = _box;
+    d.used[id] = true;
+  }
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    Entry entry{};
+    entry.id = id;
+    d.lists[axis].push_back(entry);
+    ++d.inserted[axis];
+  }
+  ++d.size;
+  return id;
+}
+
+/////////////////////////////////////////////////
+bool SweepAndPrune::Remove(const std::size_t _id)
+{
+  auto &d = *this->dataPtr;
+  if (!this->Contains(_id))
+    return false;
+
+  for (auto &list : d.lists)
+  {
+    const auto it = std::find_if(list.begin(), list.end(),
+        [_id](const Entry &_entry) {return _entry.id == _id;});
+    list.erase(it);
+  }
+  d.boxes[_id] = AxisAlignedBox();
+  d.used[_id] = false;
+  d.freeIds.push_back(_id);
+  --d.size;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SweepAndPrune::SetBox(const std::size_t _id, const AxisAlignedBox &_box)
+{
+  if (!this->Contains(_id) || !Valid(_box))
+    return false;
+
+  this->dataPtr->boxes[_id] = _box;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SweepAndPrune::Clear()
+{
+  *this->dataPtr = SweepAndPrunePrivate();
+}
+
+/////////////////////////////////////////////////
+bool SweepAndPrune::Contains(const std::size_t _id) const
+{
+  return _id < this->dataPtr->used.size() && this->dataPtr->used[_id];
+}
+
+/////////////////////////////////////////////////
+AxisAlignedBox SweepAndPrune::Box(const std::size_t _id) const
+{
+  if (!this->Contains(_id))
+    return AxisAlignedBox();
+  return this->dataPtr->boxes[_id];
+}
+
+/////////////////////////////////////////////////
+std::size_t SweepAndPrune::Size() const
+{
+  return this->dataPtr->size;
+}
+
+/////////////////////////////////////////////////
+int SweepAndPrune::SweepAxis() const
+{
+  return this->dataPtr->axis;
+}
+
+/////////////////////////////////////////////////
+void SweepAndPrune::OverlappingPairs(
+    std::vector<std::pair<std::size_t, std::size_t>> &_pairs)
+{
+  this->OverlappingPairs(_pairs, 1);
+}
+
+/////////////////////////////////////////////////
+void SweepAndPrune::OverlappingPairs(
+    std::vector<std::pair<std::size_t, std::size_t>> &_pairs,
+    const unsigned int _threads)
+{
+  auto &d = *this->dataPtr;
+  _pairs.clear();
+  if (d.size == 0)
+    return;
+
+  d.axis = d.ChooseAxis();
+  d.Sort(d.axis);
+
+  unsigned int threads = _threads;
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = static_cast<unsigned int>(std::max<std::size_t>(1,
+      std::min<std::size_t>(threads, d.size / kMinBoxesPerThread)));
+
+  if (threads == 1)
+  {
+    d.Sweep(0, d.size, _pairs);
+    return;
+  }
+
+  // Each thread sweeps a range of the list and finds the pairs whose
+  // first box in the list is in its range. The first thread writes to
+  // _pairs directly and the others are appended in order.
+  d.threadPairs.resize(threads - 1);
+  auto rangeBegin = [&](const unsigned int _thread)
+  {
+    return d.size * _thread / threads;
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (unsigned int t = 1; t < threads; ++t)
+  {
+    workers.emplace_back([&d, &rangeBegin, t]()
+    {
+      auto &pairs = d.threadPairs[t - 1];
+      pairs.clear();
+      d.Sweep(rangeBegin(t), rangeBegin(t + 1), pairs);
+    });
+  }
+  d.Sweep(0, rangeBegin(1), _pairs);
+  for (auto &worker : workers)
+    worker.join();
+
+  for (const auto &pairs : d.threadPairs)
+    _pairs.insert(_pairs.end(), pairs.begin(), pairs.end());
+}
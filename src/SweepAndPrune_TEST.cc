@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Rand.hh"
+#include "gz/math/SweepAndPrune.hh"
+
+using namespace gz;
+using namespace math;
+
+using PairList = std::vector<std::pair<std::size_t, std::size_t>>;
+
+/////////////////////////////////////////////////
+/// \brief A random box with a center in [-_range, _range] and sides up to
+/// _size.
+static AxisAlignedBox RandomBox(const double _range, const double _size)
+{
+  const Vector3d center(Rand::DblUniform(-_range, _range),
+                        Rand::DblUniform(-_range, _range),
+                        Rand::DblUniform(-_range, _range));
+  const Vector3d half(Rand::DblUniform(0, _size / 2),
+                      Rand::DblUniform(0, _size / 2),
+                      Rand::DblUniform(0, _size / 2));
+  return AxisAlignedBox(center - half, center + half);
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the overlapping pairs of boxes by testing every pair.
+static PairList BruteForcePairs(const SweepAndPrune &_sap,
+                                const std::vector<std::size_t> &_ids)
+{
+  PairList pairs;
+  for (std::size_t i = 0; i < _ids.size(); ++i)
+  {
+    for (std::size_t j = i + 1; j < _ids.size(); ++j)
+    {
+      if (_sap.Box(_ids[i]).Intersects(_sap.Box(_ids[j])))
+      {
+        pairs.emplace_back(std::min(_ids[i], _ids[j]),
+                           std::max(_ids[i], _ids[j]));
+      }
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, Empty)
+{
+  SweepAndPrune sap;
+  EXPECT_EQ(0u, sap.Size());
+  EXPECT_FALSE(sap.Contains(0));
+  EXPECT_FALSE(sap.Remove(0));
+  EXPECT_FALSE(sap.SetBox(0, AxisAlignedBox(Vector3d::Zero, Vector3d::One)));
+  EXPECT_EQ(AxisAlignedBox(), sap.Box(0));
+
+  PairList pairs = {{1, 2}};
+  sap.OverlappingPairs(pairs);
+  EXPECT_TRUE(pairs.empty());
+
+  // Empty and non-finite boxes are rejected.
+  EXPECT_EQ(SweepAndPrune::kNull, sap.Insert(AxisAlignedBox()));
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_EQ(SweepAndPrune::kNull, sap.Insert(
+      AxisAlignedBox(Vector3d::Zero, Vector3d(nan, 1, 1))));
+  EXPECT_EQ(0u, sap.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, Simple)
+{
+  SweepAndPrune sap;
+  const std::size_t a = sap.Insert(
+      AxisAlignedBox(Vector3d(0, 0, 0), Vector3d(1, 1, 1)));
+  const std::size_t b = sap.Insert(
+      AxisAlignedBox(Vector3d(1, 0, 0), Vector3d(2, 1, 1)));
+  const std::size_t c = sap.Insert(
+      AxisAlignedBox(Vector3d(10, 0, 0), Vector3d(11, 1, 1)));
+  ASSERT_NE(SweepAndPrune::kNull, c);
+  EXPECT_EQ(3u, sap.Size());
+  EXPECT_TRUE(sap.Contains(b));
+
+  // a and b touch.
+  PairList pairs;
+  sap.OverlappingPairs(pairs);
+  ASSERT_EQ(1u, pairs.size());
+  EXPECT_EQ(std::make_pair(a, b), pairs[0]);
+  EXPECT_EQ(0, sap.SweepAxis());
+
+  // c moves onto b, and the boxes now spread along Z.
+  EXPECT_TRUE(sap.SetBox(c,
+      AxisAlignedBox(Vector3d(1.5, 0.5, 0.5), Vector3d(2.5, 1.5, 20))));
+  EXPECT_FALSE(sap.SetBox(c, AxisAlignedBox()));
+  EXPECT_EQ(AxisAlignedBox(Vector3d(1.5, 0.5, 0.5), Vector3d(2.5, 1.5, 20)),
+            sap.Box(c));
+  sap.OverlappingPairs(pairs);
+  std::sort(pairs.begin(), pairs.end());
+  EXPECT_EQ(PairList({{a, b}, {b, c}}), pairs);
+  EXPECT_EQ(2, sap.SweepAxis());
+
+  EXPECT_TRUE(sap.Remove(b));
+  EXPECT_FALSE(sap.Remove(b));
+  EXPECT_FALSE(sap.Contains(b));
+  EXPECT_EQ(2u, sap.Size());
+  sap.OverlappingPairs(pairs);
+  EXPECT_TRUE(pairs.empty());
+
+  // Ids are reused.
+  const std::size_t d = sap.Insert(
+      AxisAlignedBox(Vector3d(0.5, 0.5, 0.5), Vector3d(2, 1, 1)));
+  EXPECT_EQ(b, d);
+  sap.OverlappingPairs(pairs);
+  EXPECT_EQ(2u, pairs.size());
+
+  // Copies are independent.
+  SweepAndPrune copy(sap);
+  sap.Clear();
+  EXPECT_EQ(0u, sap.Size());
+  EXPECT_FALSE(sap.Contains(a));
+  copy.OverlappingPairs(pairs);
+  EXPECT_EQ(2u, pairs.size());
+
+  sap = copy;
+  EXPECT_EQ(3u, sap.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, MatchesBruteForce)
+{
+  Rand::Seed(11);
+  SweepAndPrune sap;
+  std::vector<std::size_t> ids;
+  std::vector<AxisAlignedBox> boxes;
+  for (int i = 0; i < 500; ++i)
+  {
+    boxes.push_back(RandomBox(10, 1));
+    ids.push_back(sap.Insert(boxes.back()));
+  }
+
+  PairList pairs;
+  for (int step = 0; step < 20; ++step)
+  {
+    // Move every box, remove some and insert others.
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+      const Vector3d displacement(Rand::DblUniform(-0.2, 0.2),
+                                  Rand::DblUniform(-0.2, 0.2),
+                                  Rand::DblUniform(-0.2, 0.2));
+      boxes[i] = AxisAlignedBox(boxes[i].Min() + displacement,
+                                boxes[i].Max() + displacement);
+      EXPECT_TRUE(sap.SetBox(ids[i], boxes[i]));
+    }
+    for (int k = 0; k < 10; ++k)
+    {
+      const auto i = static_cast<std::size_t>(
+          Rand::IntUniform(0, static_cast<int>(ids.size()) - 1));
+      EXPECT_TRUE(sap.Remove(ids[i]));
+      boxes[i] = RandomBox(10, 1);
+      ids[i] = sap.Insert(boxes[i]);
+    }
+    ASSERT_EQ(ids.size(), sap.Size());
+
+    sap.OverlappingPairs(pairs);
+    std::sort(pairs.begin(), pairs.end());
+    EXPECT_EQ(BruteForcePairs(sap, ids), pairs);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, Threads)
+{
+  Rand::Seed(5);
+  SweepAndPrune sap;
+  std::vector<std::size_t> ids;
+  for (int i = 0; i < 5000; ++i)
+    ids.push_back(sap.Insert(RandomBox(20, 1)));
+
+  PairList pairs;
+  PairList threadPairs;
+  for (int step = 0; step < 3; ++step)
+  {
+    for (std::size_t id : ids)
+    {
+      const AxisAlignedBox box = sap.Box(id);
+      const Vector3d displacement(Rand::DblUniform(-0.1, 0.1),
+                                  Rand::DblUniform(-0.1, 0.1),
+                                  Rand::DblUniform(-0.1, 0.1));
+      sap.SetBox(id, AxisAlignedBox(box.Min() + displacement,
+                                    box.Max() + displacement));
+    }
+
+    // The pairs are the same, in the same order.
+    sap.OverlappingPairs(pairs);
+    sap.OverlappingPairs(threadPairs, 4);
+    EXPECT_FALSE(pairs.empty());
+    EXPECT_EQ(pairs, threadPairs);
+    sap.OverlappingPairs(threadPairs, 0);
+    EXPECT_EQ(pairs, threadPairs);
+  }
+  std::sort(pairs.begin(), pairs.end());
+  EXPECT_EQ(BruteForcePairs(sap, ids), pairs);
+}
@@ -92,6 +92,54 @@ double Temperature::FahrenheitToKelvin(const double _temp)
   return (_temp + 459.67) / 1.8;
 }
 
+/////////////////////////////////////////////////
+void Temperature::KelvinToCelsius(const double *_in,
+    const std::size_t _count, double *_out)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+    _out[i] = KelvinToCelsius(_in[i]);
+}
+
+/////////////////////////////////////////////////
+void Temperature::KelvinToFahrenheit(const double *_in,
+    const std::size_t _count, double *_out)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+    _out[i] = KelvinToFahrenheit(_in[i]);
+}
+
+/////////////////////////////////////////////////
+void Temperature::CelsiusToFahrenheit(const double *_in,
+    const std::size_t _count, double *_out)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+    _out[i] = CelsiusToFahrenheit(_in[i]);
+}
+
+/////////////////////////////////////////////////
+void Temperature::CelsiusToKelvin(const double *_in,
+    const std::size_t _count, double *_out)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+    _out[i] = CelsiusToKelvin(_in[i]);
+}
+
+/////////////////////////////////////////////////
+void Temperature::FahrenheitToCelsius(const double *_in,
+    const std::size_t _count, double *_out)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+    _out[i] = FahrenheitToCelsius(_in[i]);
+}
+
+/////////////////////////////////////////////////
+void Temperature::FahrenheitToKelvin(const double *_in,
+    const std::size_t _count, double *_out)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+    _out[i] = FahrenheitToKelvin(_in[i]);
+}
+
 /////////////////////////////////////////////////
 void Temperature::SetKelvin(const double _temp)
 {
@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "gz/math/Instrumentation.hh"
+#include "gz/math/TemperatureQuantizer.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Number of 16 bit codes, and size of the lookup table.
+  const std::size_t kCodes = 65536;
+
+  /// \brief Highest 8 bit count.
+  const double kMaxCount8 = 255.0;
+}
+
+/// \brief Private data for TemperatureQuantizer.
+class gz::math::TemperatureQuantizerPrivate
+{
+  /// \brief Update the values derived from the range and resolution.
+  public: void Update()
+  {
+    this->valid = std::isfinite(this->min) && std::isfinite(this->max) &&
+        std::isfinite(this->resolution) && this->min < this->max &&
+        this->resolution > 0.0;
+
+    // An invalid quantizer scales every temperature to count 0.
+    this->scale = 0.0;
+    this->maxCount = 0;
+    if (!this->valid)
+      return;
+
+    // Tolerate the rounding of ranges that hold a whole number of steps.
+    const double steps = (this->max - this->min) / this->resolution;
+    this->scale = 1.0 / this->resolution;
+    this->maxCount = static_cast<uint16_t>(std::min(
+        std::floor(steps + 1e-6),
+        static_cast<double>(std::numeric_limits<uint16_t>::max())));
+  }
+
+  /// \brief Convert an array of temperatures to counts. The loop has no
+  /// branches so that it vectorizes.
+  /// \param[in] _kelvin Temperatures in Kelvin.
+  /// \param[in] _count Number of temperatures.
+  /// \param[in] _maxCount Highest count of the output type.
+  /// \param[out] _out Counts.
+  public: template<typename T>
+  void Quantize(const double *_kelvin, const std::size_t _count,
+                const double _maxCount, T *_out) const
+  {
+    const double lowest = this->min;
+    const double countsPerKelvin = this->scale;
+    const double highest = std::min(_maxCount,
+        static_cast<double>(this->maxCount));
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      double v = (_kelvin[i] - lowest) * countsPerKelvin + 0.5;
+      // Comparisons with NaN are false, so NaN becomes 0.
+      v = v > 0.0 ? v : 0.0;
+      v = v < highest ? v : highest;
+      _out[i] = static_cast<T>(static_cast<int32_t>(v));
+    }
+  }
+
+  /// \brief Build the lookup table of the input encoding.
+  public: void BuildLut()
+  {
+    std::vector<double> kelvin(kCodes);
+    for (std::size_t c = 0; c < kCodes; ++c)
+      kelvin[c] = this->lutOffset + c * this->lutResolution;
+    this->lut.resize(kCodes);
+    this->Quantize(kelvin.data(), kCodes,
+        std::numeric_limits<uint16_t>::max(), this->lut.data());
+  }
+
+  /// \brief Temperature of count 0, in Kelvin.
+  public: double min = 0.0;
+
+  /// \brief Highest temperature, in Kelvin.
+  public: double max = 655.35;
+
+  /// \brief Temperature step of one count, in Kelvin.
+  public: double resolution = 0.01;
+
+  /// \brief Counts per Kelvin, 0 if invalid.
+  public: double scale = 0.0;
+
+  /// \brief Highest count.
+  public: uint16_t maxCount = 0;
+
+  /// \brief Whether the range and resolution are usable.
+  public: bool valid = false;
+
+  /// \brief Temperature step of one input code, in Kelvin.
+  public: double lutResolution = 0.0;
+
+  /// \brief Temperature of input code 0, in Kelvin.
+  public: double lutOffset = 0.0;
+
+  /// \brief Count of each input code, empty without an input encoding.
+  public: std::vector<uint16_t> lut;
+};
+
+/////////////////////////////////////////////////
+TemperatureQuantizer::TemperatureQuantizer()
+  : dataPtr(std::make_unique<TemperatureQuantizerPrivate>())
+{
+  this->dataPtr->Update();
+}
+
+/////////////////////////////////////////////////
+TemperatureQuantizer::TemperatureQuantizer(const double _min,
+    const double _max, const double _resolution)
+  : TemperatureQuantizer()
+{
+  this->SetRange(_min, _max, _resolution);
+}
+
+/////////////////////////////////////////////////
+TemperatureQuantizer::TemperatureQuantizer(
+    const TemperatureQuantizer &_other)
+  : dataPtr(std::make_unique<TemperatureQuantizerPrivate>(*_other.dataPtr))
+{
+  IGN_MATH_COUNT_COPY(PIMPL, sizeof(TemperatureQuantizerPrivate) +
+      this->dataPtr->lut.size() * sizeof(uint16_t));
+}
+
+/////////////////////////////////////////////////
+TemperatureQuantizer::TemperatureQuantizer(
+    TemperatureQuantizer &&_other) noexcept = default;
+
+/////////////////////////////////////////////////
+TemperatureQuantizer::~TemperatureQuantizer() = default;
+
+/////////////////////////////////////////////////
+TemperatureQuantizer &TemperatureQuantizer::operator=(
+    const TemperatureQuantizer &_other)
+{
+  if (this != &_other)
+  {
+    IGN_MATH_COUNT_COPY(PIMPL, sizeof(TemperatureQuantizerPrivate) +
+        _other.dataPtr->lut.size() * sizeof(uint16_t));
+    *this->dataPtr = *_other.dataPtr;
+  }
+  return *this;
+}
+
+/////////////////////////////////////////////////
+TemperatureQuantizer &TemperatureQuantizer::operator=(
+    TemperatureQuantizer &&_other) noexcept = default;
+
+/////////////////////////////////////////////////
+void TemperatureQuantizer::SetRange(const double _min, const double _max,
+    const double _resolution)
+{
+  this->dataPtr->min = _min;
+  this->dataPtr->max = _max;
+  this->dataPtr->resolution = _resolution;
+  this->dataPtr->Update();
+  if (!this->dataPtr->lut.empty())
+    this->dataPtr->BuildLut();
+}
+
+/////////////////////////////////////////////////
+bool TemperatureQuantizer::Valid() const
+{
+  return this->dataPtr->valid;
+}
+
+/////////////////////////////////////////////////
+double TemperatureQuantizer::Min() const
+{
+  return this->dataPtr->min;
+}
+
+/////////////////////////////////////////////////
+double TemperatureQuantizer::Max() const
+{
+  return this->dataPtr->max;
+}
+
+/////////////////////////////////////////////////
+double TemperatureQuantizer::Resolution() const
+{
+  return this->dataPtr->resolution;
+}
+
+/////////////////////////////////////////////////
+uint16_t TemperatureQuantizer::MaxCount() const
+{
+  return this->dataPtr->maxCount;
+}
+
+/////////////////////////////////////////////////
+uint16_t TemperatureQuantizer::Count(const double _kelvin) const
+{
+  uint16_t count;
+  this->Quantize(&_kelvin, 1, &count);
+  return count;
+}
+
+/////////////////////////////////////////////////
+double TemperatureQuantizer::Kelvin(const uint16_t _count) const
+{
+  return this->dataPtr->min + _count * this->dataPtr->resolution;
+}
+
+/////////////////////////////////////////////////
+void TemperatureQuantizer::Quantize(const double *_kelvin,
+    const std::size_t _count, uint16_t *_out) const
+{
+  this->dataPtr->Quantize(_kelvin, _count,
+      std::numeric_limits<uint16_t>::max(), _out);
+}
+
+/////////////////////////////////////////////////
+void TemperatureQuantizer::Quantize(const double *_kelvin,
+    const std::size_t _count, uint8_t *_out) const
+{
+  this->dataPtr->Quantize(_kelvin, _count, kMaxCount8, _out);
+}
+
+/////////////////////////////////////////////////
+void TemperatureQuantizer::Dequantize(const uint16_t *_counts,
+    const std::size_t _count, double *_kelvin) const
+{
+  const double lowest = this->dataPtr->min;
+  const double resolution = this->dataPtr->resolution;
+  for (std::size_t i = 0; i < _count; ++i)
+    _kelvin[i] = lowest + _counts[i] * resolution;
+}
+
+/////////////////////////////////////////////////
+bool TemperatureQuantizer::SetInputEncoding(const double _resolution,
+    const double _offset)
+{
+  if (!std::isfinite(_resolution) || !std::isfinite(_offset) ||
+      _resolution <= 0.0)
+  {
+    this->dataPtr->lut.clear();
+    this->dataPtr->lut.shrink_to_fit();
+    return false;
+  }
+
+  this->dataPtr->lutResolution = _resolution;
+  this->dataPtr->lutOffset = _offset;
+  this->dataPtr->BuildLut();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool TemperatureQuantizer::HasInputEncoding() const
+{
+  return !this->dataPtr->lut.empty();
+}
+
+/////////////////////////////////////////////////
+bool TemperatureQuantizer::QuantizeEncoded(const uint16_t *_codes,
+    const std::size_t _count, uint16_t *_out) const
+{
+  if (this->dataPtr->lut.empty())
+    return false;
+
+  const uint16_t *lut = this->dataPtr->lut.data();
+  for (std::size_t i = 0; i < _count; ++i)
+    _out[i] = lut[_codes[i]];
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool TemperatureQuantizer::QuantizeEncoded(const uint16_t *_codes,
+    const std::size_t _count, uint8_t *_out) const
+{
+  if (this->dataPtr->lut.empty())
+    return false;
+
+  const uint16_t *lut = this->dataPtr->lut.data();
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    _out[i] = static_cast<uint8_t>(
+        std::min<uint16_t>(lut[_codes[i]], 255));
+  }
+  return true;
+}
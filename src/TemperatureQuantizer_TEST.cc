@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gz/math/TemperatureQuantizer.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(TemperatureQuantizerTest, Constructor)
+{
+  TemperatureQuantizer quantizer;
+  EXPECT_TRUE(quantizer.Valid());
+  EXPECT_DOUBLE_EQ(0.0, quantizer.Min());
+  EXPECT_DOUBLE_EQ(655.35, quantizer.Max());
+  EXPECT_DOUBLE_EQ(0.01, quantizer.Resolution());
+  EXPECT_EQ(65535u, quantizer.MaxCount());
+  EXPECT_FALSE(quantizer.HasInputEncoding());
+
+  TemperatureQuantizer range(250.0, 350.0, 100.0 / 255);
+  EXPECT_TRUE(range.Valid());
+  EXPECT_EQ(255u, range.MaxCount());
+
+  // The highest count doesn't exceed the range
+  range.SetRange(0.0, 10.0, 3.0);
+  EXPECT_EQ(3u, range.MaxCount());
+
+  // And is limited to 16 bits
+  range.SetRange(0.0, 1000.0, 0.001);
+  EXPECT_EQ(65535u, range.MaxCount());
+}
+
+/////////////////////////////////////////////////
+TEST(TemperatureQuantizerTest, Invalid)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  for (const auto &range : std::vector<std::vector<double>>{
+       {300.0, 200.0, 1.0}, {200.0, 200.0, 1.0}, {200.0, 300.0, 0.0},
+       {200.0, 300.0, -1.0}, {nan, 300.0, 1.0}, {200.0, inf, 1.0}})
+  {
+    TemperatureQuantizer quantizer(range[0], range[1], range[2]);
+    EXPECT_FALSE(quantizer.Valid());
+    EXPECT_EQ(0u, quantizer.MaxCount());
+    EXPECT_EQ(0u, quantizer.Count(250.0));
+  }
+
+  TemperatureQuantizer quantizer;
+  EXPECT_FALSE(quantizer.SetInputEncoding(0.0));
+  EXPECT_FALSE(quantizer.SetInputEncoding(0.01, nan));
+  EXPECT_FALSE(quantizer.HasInputEncoding());
+
+  std::vector<uint16_t> codes = {1, 2};
+  std::vector<uint16_t> out = {7, 7};
+  EXPECT_FALSE(quantizer.QuantizeEncoded(codes.data(), codes.size(),
+      out.data()));
+  EXPECT_EQ(7u, out[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(TemperatureQuantizerTest, Quantize)
+{
+  TemperatureQuantizer quantizer(200.0, 400.0, 0.5);
+  EXPECT_EQ(400u, quantizer.MaxCount());
+
+  EXPECT_EQ(0u, quantizer.Count(200.0));
+  EXPECT_EQ(1u, quantizer.Count(200.3));
+  EXPECT_EQ(0u, quantizer.Count(200.2));
+  EXPECT_EQ(200u, quantizer.Count(300.0));
+  EXPECT_EQ(400u, quantizer.Count(400.0));
+  EXPECT_DOUBLE_EQ(300.0, quantizer.Kelvin(200));
+
+  // Out of range and not a number
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  EXPECT_EQ(0u, quantizer.Count(-50.0));
+  EXPECT_EQ(400u, quantizer.Count(1e9));
+  EXPECT_EQ(400u, quantizer.Count(inf));
+  EXPECT_EQ(0u, quantizer.Count(-inf));
+  EXPECT_EQ(0u, quantizer.Count(nan));
+
+  const std::vector<double> kelvin = {150.0, 200.0, 250.25, 327.6, 500.0};
+  std::vector<uint16_t> counts(kelvin.size());
+  quantizer.Quantize(kelvin.data(), kelvin.size(), counts.data());
+  for (std::size_t i = 0; i < kelvin.size(); ++i)
+    EXPECT_EQ(quantizer.Count(kelvin[i]), counts[i]);
+  EXPECT_EQ(101u, counts[2]);
+
+  // 8 bit counts saturate
+  std::vector<uint8_t> counts8(kelvin.size());
+  quantizer.Quantize(kelvin.data(), kelvin.size(), counts8.data());
+  EXPECT_EQ(0u, counts8[0]);
+  EXPECT_EQ(101u, counts8[2]);
+  EXPECT_EQ(255u, counts8[3]);
+  EXPECT_EQ(255u, counts8[4]);
+
+  std::vector<double> back(counts.size());
+  quantizer.Dequantize(counts.data(), counts.size(), back.data());
+  EXPECT_DOUBLE_EQ(200.0, back[0]);
+  EXPECT_DOUBLE_EQ(250.5, back[2]);
+  EXPECT_DOUBLE_EQ(400.0, back[4]);
+}
+
+/////////////////////////////////////////////////
+TEST(TemperatureQuantizerTest, InputEncoding)
+{
+  // 8 bit image of 250 K to 350 K from codes in hundredths of a Kelvin
+  TemperatureQuantizer quantizer(250.0, 350.0, 100.0 / 255);
+  EXPECT_TRUE(quantizer.SetInputEncoding(0.01));
+  EXPECT_TRUE(quantizer.HasInputEncoding());
+
+  std::vector<uint16_t> codes(65536);
+  std::vector<double> kelvin(codes.size());
+  for (std::size_t c = 0; c < codes.size(); ++c)
+  {
+    codes[c] = static_cast<uint16_t>(c);
+    kelvin[c] = c * 0.01;
+  }
+
+  // The lookup table matches the direct conversion for every code
+  std::vector<uint8_t> direct(codes.size());
+  std::vector<uint8_t> encoded(codes.size());
+  quantizer.Quantize(kelvin.data(), kelvin.size(), direct.data());
+  EXPECT_TRUE(quantizer.QuantizeEncoded(codes.data(), codes.size(),
+      encoded.data()));
+  EXPECT_EQ(direct, encoded);
+  EXPECT_EQ(0u, encoded[25000]);
+  EXPECT_EQ(153u, encoded[31000]);
+  EXPECT_EQ(255u, encoded[35000]);
+
+  // The table follows a new range
+  quantizer.SetRange(273.15, 373.15, 0.1);
+  std::vector<uint16_t> direct16(codes.size());
+  std::vector<uint16_t> encoded16(codes.size());
+  quantizer.Quantize(kelvin.data(), kelvin.size(), direct16.data());
+  EXPECT_TRUE(quantizer.QuantizeEncoded(codes.data(), codes.size(),
+      encoded16.data()));
+  EXPECT_EQ(direct16, encoded16);
+  EXPECT_EQ(1000u, encoded16[40000]);
+
+  // In place, with an offset
+  EXPECT_TRUE(quantizer.SetInputEncoding(0.1, 273.15));
+  std::vector<uint16_t> image = {0, 10, 5000};
+  EXPECT_TRUE(quantizer.QuantizeEncoded(image.data(), image.size(),
+      image.data()));
+  EXPECT_EQ(0u, image[0]);
+  EXPECT_EQ(10u, image[1]);
+  EXPECT_EQ(1000u, image[2]);
+}
+
+/////////////////////////////////////////////////
+TEST(TemperatureQuantizerTest, CopyMove)
+{
+  TemperatureQuantizer quantizer(250.0, 350.0, 0.5);
+  quantizer.SetInputEncoding(0.01);
+
+  TemperatureQuantizer copy(quantizer);
+  EXPECT_TRUE(copy.HasInputEncoding());
+  EXPECT_DOUBLE_EQ(250.0, copy.Min());
+
+  TemperatureQuantizer assigned;
+  assigned = copy;
+  EXPECT_TRUE(assigned.HasInputEncoding());
+  EXPECT_EQ(200u, assigned.MaxCount());
+
+  TemperatureQuantizer moved(std::move(copy));
+  EXPECT_TRUE(moved.HasInputEncoding());
+  EXPECT_EQ(20u, moved.Count(260.0));
+
+  // The copies are independent
+  assigned.SetRange(0.0, 100.0, 1.0);
+  EXPECT_DOUBLE_EQ(250.0, quantizer.Min());
+}
@@ -16,6 +16,9 @@
 */
 #include <gtest/gtest.h>
 
+#include <utility>
+#include <vector>
+
 #include "gz/math/Temperature.hh"
 
 using namespace gz;
@@ -181,6 +184,40 @@ TEST(TemperatureTest, Negative)
   EXPECT_NEAR(temp5.Kelvin(), 2.0, 1e-6);
 }
 
+/////////////////////////////////////////////////
+TEST(TemperatureTest, BatchConversions)
+{
+  const std::vector<double> in = {-40.0, 0.0, 100.0, 273.15, 1e6};
+  std::vector<double> out(in.size());
+
+  using Converter = double (*)(const double);
+  using BatchConverter = void (*)(const double *, const std::size_t,
+      double *);
+  const std::vector<std::pair<Converter, BatchConverter>> converters = {
+    {&Temperature::KelvinToCelsius, &Temperature::KelvinToCelsius},
+    {&Temperature::KelvinToFahrenheit, &Temperature::KelvinToFahrenheit},
+    {&Temperature::CelsiusToFahrenheit, &Temperature::CelsiusToFahrenheit},
+    {&Temperature::CelsiusToKelvin, &Temperature::CelsiusToKelvin},
+    {&Temperature::FahrenheitToCelsius, &Temperature::FahrenheitToCelsius},
+    {&Temperature::FahrenheitToKelvin, &Temperature::FahrenheitToKelvin}};
+
+  for (const auto &converter : converters)
+  {
+    converter.second(in.data(), in.size(), out.data());
+    for (std::size_t i = 0; i < in.size(); ++i)
+      EXPECT_DOUBLE_EQ(converter.first(in[i]), out[i]);
+  }
+
+  // In place
+  out = in;
+  Temperature::CelsiusToKelvin(out.data(), out.size(), out.data());
+  EXPECT_DOUBLE_EQ(233.15, out[0]);
+  EXPECT_DOUBLE_EQ(546.3, out[3]);
+
+  // Nothing to convert
+  Temperature::KelvinToCelsius(nullptr, 0, nullptr);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
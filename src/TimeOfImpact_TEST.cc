@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Helpers.hh"
+#include "gz/math/TimeOfImpact.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(TimeOfImpactTest, SweptBoxes)
+{
+  const AxisAlignedBox a(Vector3d(0, 0, 0), Vector3d(1, 1, 1));
+  const AxisAlignedBox b(Vector3d(3, 0.5, 0), Vector3d(4, 1.5, 1));
+  TimeOfImpactResult<double> result;
+
+  // The second box moves through the first one.
+  EXPECT_TRUE(SweptBoxTimeOfImpact(a, Vector3d::Zero, b,
+                                   Vector3d(-4, 0, 0), result));
+  EXPECT_DOUBLE_EQ(0.5, result.time);
+  EXPECT_EQ(Vector3d(1, 0, 0), result.normal);
+  EXPECT_EQ(Vector3d(1, 0.75, 0.5), result.point);
+  EXPECT_EQ(0u, result.iterations);
+
+  // Both boxes move, and only the relative motion matters.
+  EXPECT_TRUE(SweptBoxTimeOfImpact(a, Vector3d(3, 1, 0), b,
+                                   Vector3d(-1, 1, 0), result));
+  EXPECT_DOUBLE_EQ(0.5, result.time);
+  EXPECT_EQ(Vector3d(1, 0, 0), result.normal);
+  EXPECT_EQ(Vector3d(2.5, 1.25, 0.5), result.point);
+
+  // The first box moves into the second one from below along Z.
+  const AxisAlignedBox c(Vector3d(0, 0, 2), Vector3d(1, 1, 3));
+  EXPECT_TRUE(SweptBoxTimeOfImpact(a, Vector3d(0, 0, 4), c,
+                                   Vector3d::Zero, result));
+  EXPECT_DOUBLE_EQ(0.25, result.time);
+  EXPECT_EQ(Vector3d(0, 0, 1), result.normal);
+
+  // Misses, by moving too little, away, or beside.
+  result = TimeOfImpactResult<double>();
+  EXPECT_FALSE(SweptBoxTimeOfImpact(a, Vector3d::Zero, b,
+                                    Vector3d(-1.5, 0, 0), result));
+  EXPECT_FALSE(SweptBoxTimeOfImpact(a, Vector3d::Zero, b,
+                                    Vector3d(4, 0, 0), result));
+  EXPECT_FALSE(SweptBoxTimeOfImpact(a, Vector3d::Zero, b,
+                                    Vector3d(-4, 2, 0), result));
+  EXPECT_FALSE(SweptBoxTimeOfImpact(a, Vector3d::Zero, b,
+                                    Vector3d(-4, 0, 3), result));
+  EXPECT_DOUBLE_EQ(1.0, result.time);
+
+  // Overlapping at the start.
+  EXPECT_TRUE(SweptBoxTimeOfImpact(a, Vector3d(1, 1, 1),
+      AxisAlignedBox(Vector3d(0.5, 0.5, 0.5), Vector3d(2, 2, 2)),
+      Vector3d::Zero, result));
+  EXPECT_DOUBLE_EQ(0.0, result.time);
+  EXPECT_EQ(Vector3d::Zero, result.normal);
+
+  // Empty boxes never touch.
+  EXPECT_FALSE(SweptBoxTimeOfImpact(a, Vector3d::Zero, AxisAlignedBox(),
+                                    Vector3d::Zero, result));
+}
+
+/////////////////////////////////////////////////
+TEST(TimeOfImpactTest, SweptBoxPairs)
+{
+  const std::vector<AxisAlignedBox> boxes = {
+    AxisAlignedBox(Vector3d(0, 0, 0), Vector3d(1, 1, 1)),
+    AxisAlignedBox(Vector3d(3, 0, 0), Vector3d(4, 1, 1)),
+    AxisAlignedBox(Vector3d(0, 3, 0), Vector3d(1, 4, 1))};
+  const std::vector<Vector3d> motions = {
+    Vector3d(4, 0, 0), Vector3d::Zero, Vector3d(0, -1, 0)};
+  const std::vector<std::pair<std::size_t, std::size_t>> pairs = {
+    {0, 1}, {0, 2}, {1, 2}};
+
+  std::vector<std::pair<std::size_t, TimeOfImpactResult<double>>> hits;
+  hits.emplace_back(5, TimeOfImpactResult<double>());
+  SweptBoxTimesOfImpact(boxes, motions, pairs, hits);
+  ASSERT_EQ(1u, hits.size());
+  EXPECT_EQ(0u, hits[0].first);
+  EXPECT_DOUBLE_EQ(0.5, hits[0].second.time);
+  EXPECT_EQ(Vector3d(1, 0, 0), hits[0].second.normal);
+
+  // Agrees with the single pair queries.
+  for (const auto &pair : pairs)
+  {
+    TimeOfImpactResult<double> result;
+    EXPECT_EQ(&pair == &pairs[0], SweptBoxTimeOfImpact(
+        boxes[pair.first], motions[pair.first], boxes[pair.second],
+        motions[pair.second], result));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(TimeOfImpactTest, Spheres)
+{
+  const Sphered sphere(1.0);
+  const Pose3d origin = Pose3d::Zero;
+  TimeOfImpactResult<double> result;
+
+  // A fast sphere that would pass through the other one in one step.
+  EXPECT_TRUE(ShapeTimeOfImpact(sphere, origin, origin, sphere,
+      Pose3d(10, 0, 0, 0, 0, 0), Pose3d(-10, 0, 0, 0, 0, 0), result));
+  EXPECT_NEAR(0.4, result.time, 1e-5);
+  EXPECT_LE(result.time, 0.4);
+  EXPECT_TRUE(result.normal.Equal(Vector3d::UnitX, 1e-9));
+  EXPECT_TRUE(result.point.Equal(Vector3d::UnitX, 1e-4));
+  EXPECT_GE(result.iterations, 1u);
+
+  // Swapping the shapes flips the normal.
+  EXPECT_TRUE(ShapeTimeOfImpact(sphere, Pose3d(10, 0, 0, 0, 0, 0),
+      Pose3d(-10, 0, 0, 0, 0, 0), sphere, origin, origin, result));
+  EXPECT_NEAR(0.4, result.time, 1e-5);
+  EXPECT_TRUE(result.normal.Equal(-Vector3d::UnitX, 1e-9));
+
+  // Passing by.
+  result = TimeOfImpactResult<double>();
+  EXPECT_FALSE(ShapeTimeOfImpact(sphere, origin, origin, sphere,
+      Pose3d(10, 2.1, 0, 0, 0, 0), Pose3d(-10, 2.1, 0, 0, 0, 0), result));
+  // Stopping short, and moving away.
+  EXPECT_FALSE(ShapeTimeOfImpact(sphere, origin, origin, sphere,
+      Pose3d(10, 0, 0, 0, 0, 0), Pose3d(2.1, 0, 0, 0, 0, 0), result));
+  EXPECT_FALSE(ShapeTimeOfImpact(sphere, origin, origin, sphere,
+      Pose3d(3, 0, 0, 0, 0, 0), Pose3d(10, 0, 0, 0, 0, 0), result));
+  EXPECT_DOUBLE_EQ(1.0, result.time);
+  EXPECT_EQ(0u, result.iterations);
+
+  // Overlapping at the start.
+  EXPECT_TRUE(ShapeTimeOfImpact(sphere, origin, origin, sphere,
+      Pose3d(1, 0, 0, 0, 0, 0), Pose3d(10, 0, 0, 0, 0, 0), result));
+  EXPECT_DOUBLE_EQ(0.0, result.time);
+  EXPECT_EQ(Vector3d::Zero, result.normal);
+  EXPECT_EQ(1u, result.iterations);
+}
+
+/////////////////////////////////////////////////
+TEST(TimeOfImpactTest, ThinWall)
+{
+  // A small fast capsule crossing a thin wall between two steps.
+  const Boxd wall(0.01, 4, 4);
+  const Pose3d wallPose(0, 0, 0, 0, 0, 0);
+  const Capsuled bullet(0.1, 0.02);
+  const Pose3d start(-1, 0.3, 0, 0, IGN_PI / 2, 0);
+  const Pose3d end(1, 0.5, 0, 0, IGN_PI / 2, 0);
+
+  ShapeDistanceResult<double> distance;
+  EXPECT_TRUE(ShapeDistance(wall, wallPose, bullet, start, distance));
+  EXPECT_TRUE(ShapeDistance(wall, wallPose, bullet, end, distance));
+
+  TimeOfImpactResult<double> result;
+  ASSERT_TRUE(ShapeTimeOfImpact(wall, wallPose, wallPose, bullet, start,
+                                end, result));
+  // The capsule touches the wall when its center is at -0.075.
+  EXPECT_NEAR(0.4625, result.time, 1e-4);
+  EXPECT_TRUE(result.normal.Equal(-Vector3d::UnitX, 1e-6));
+  EXPECT_NEAR(-0.005, result.point.X(), 1e-4);
+
+  const Pose3d contact(start.Pos() + (end.Pos() - start.Pos()) * result.time,
+                       start.Rot());
+  EXPECT_TRUE(ShapeDistance(wall, wallPose, bullet, contact, distance));
+  EXPECT_LT(distance.distance, 1e-4);
+}
+
+/////////////////////////////////////////////////
+TEST(TimeOfImpactTest, Rotation)
+{
+  // A rod sweeping a quarter turn about Z hits a sphere on the Y axis.
+  const Boxd rod(4, 0.2, 0.2);
+  const Sphered sphere(0.5);
+  const Pose3d spherePose(0, 1.5, 0, 0, 0, 0);
+  const Pose3d start = Pose3d::Zero;
+  const Pose3d end(0, 0, 0, 0, 0, IGN_PI / 2);
+
+  TimeOfImpactResult<double> result;
+  ASSERT_TRUE(ShapeTimeOfImpact(rod, start, end, sphere, spherePose,
+                                spherePose, result));
+  // The face of the rod is 0.6 from the center of the sphere when
+  // 1.5 cos(yaw) = 0.6.
+  const double yaw = std::acos(0.4);
+  EXPECT_NEAR(yaw / (IGN_PI / 2), result.time, 1e-4);
+  EXPECT_LE(result.time, yaw / (IGN_PI / 2));
+  EXPECT_GT(result.iterations, 1u);
+  const Vector3d normal(-std::sin(yaw), std::cos(yaw), 0);
+  EXPECT_TRUE(result.normal.Equal(normal, 1e-3));
+
+  // A sphere beyond the ends of the rod.
+  const Pose3d farPose(0, 2.6, 0, 0, 0, 0);
+  EXPECT_FALSE(ShapeTimeOfImpact(rod, start, end, sphere, farPose, farPose,
+                                 result));
+
+  // The iterations running out give a time before the contact.
+  TimeOfImpactResult<double> partial;
+  EXPECT_TRUE(ShapeTimeOfImpact(rod, start, end, sphere, spherePose,
+                                spherePose, partial, 1e-4, 2u));
+  EXPECT_EQ(2u, partial.iterations);
+  EXPECT_LT(partial.time, result.time);
+}
+
+/////////////////////////////////////////////////
+TEST(TimeOfImpactTest, Earliest)
+{
+  const Sphered ball(0.5);
+  const Pose3d start(-10, 0, 0, 0, 0, 0);
+  const Pose3d end(10, 0, 0, 0, 0, 0);
+
+  const std::vector<Boxd> boxes(4, Boxd(1, 1, 1));
+  const std::vector<Pose3d> starts = {
+    Pose3d(5, 0, 0, 0, 0, 0),
+    Pose3d(0, 5, 0, 0, 0, 0),
+    Pose3d(-2, 0, 0, 0, 0, 0),
+    Pose3d(0, 0, 0, 0, 0, 0)};
+  const std::vector<Pose3d> ends = {
+    Pose3d(5, 0, 0, 0, 0, 0),
+    Pose3d(0, 5, 0, 0, 0, 0),
+    Pose3d(-2, 3, 0, 0, 0, 0),
+    Pose3d(0, 0, 0, 0, 0, 0)};
+
+  TimeOfImpactResult<double> result;
+  std::size_t index = 100;
+  ASSERT_TRUE(ShapeTimeOfImpact(ball, start, end, boxes.data(),
+      starts.data(), ends.data(), boxes.size(), result, index));
+  EXPECT_EQ(3u, index);
+  // The ball reaches the box at the origin at x = -1.
+  EXPECT_NEAR(0.45, result.time, 1e-5);
+
+  // Agrees with the single queries.
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    TimeOfImpactResult<double> single;
+    if (ShapeTimeOfImpact(ball, start, end, boxes[i], starts[i], ends[i],
+                          single))
+    {
+      EXPECT_GE(single.time, result.time - 1e-9);
+    }
+  }
+
+  index = 100;
+  EXPECT_FALSE(ShapeTimeOfImpact(ball, start, end, boxes.data() + 1,
+      starts.data() + 1, ends.data() + 1, 1u, result, index));
+  EXPECT_EQ(100u, index);
+}
+
+/////////////////////////////////////////////////
+TEST(TimeOfImpactTest, Float)
+{
+  const Ellipsoidf ellipsoid(Vector3f(1, 2, 3));
+  const Cylinderf cylinder(2.0f, 0.5f);
+  TimeOfImpactResult<float> result;
+  ASSERT_TRUE(ShapeTimeOfImpact(ellipsoid, Pose3f::Zero, Pose3f::Zero,
+      cylinder, Pose3f(0, 10, 0, 0, 0, 0), Pose3f(0, -10, 0, 0, 0, 0),
+      result, 1e-3f));
+  // The cylinder touches the ellipsoid when its center is at y = 2.5.
+  EXPECT_NEAR(0.375f, result.time, 1e-3f);
+}
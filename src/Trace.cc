@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <atomic>
+
+#include "gz/math/Trace.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Get the functions receiving the trace zones.
+  /// \return Reference to the functions, or to nullptr.
+  std::atomic<const TraceCallbacks *> &Callbacks()
+  {
+    static std::atomic<const TraceCallbacks *> callbacks{nullptr};
+    return callbacks;
+  }
+}
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    /////////////////////////////////////////////
+    void SetTraceCallbacks(const TraceCallbacks *_callbacks)
+    {
+      Callbacks().store(_callbacks, std::memory_order_release);
+    }
+
+    /////////////////////////////////////////////
+    const TraceCallbacks *ActiveTraceCallbacks()
+    {
+      return Callbacks().load(std::memory_order_acquire);
+    }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TraceZone::TraceZone(const char *_name)
+  : name(_name), callbacks(Callbacks().load(std::memory_order_acquire))
+{
+  if (this->callbacks && this->callbacks->begin)
+    this->callbacks->begin(this->name, this->callbacks->userData);
+}
+
+/////////////////////////////////////////////////
+TraceZone::~TraceZone()
+{
+  if (this->callbacks && this->callbacks->end)
+    this->callbacks->end(this->name, this->callbacks->userData);
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "gz/math/BoundingVolumeHierarchy.hh"
+#include "gz/math/Kmeans.hh"
+#include "gz/math/Trace.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Record the zones, as "+name" when they begin and "-name" when
+/// they end.
+class TraceTest : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    this->callbacks.begin = [](const char *_name, void *_userData)
+    {
+      static_cast<TraceTest *>(_userData)->events.push_back(
+          std::string("+") + _name);
+    };
+    this->callbacks.end = [](const char *_name, void *_userData)
+    {
+      static_cast<TraceTest *>(_userData)->events.push_back(
+          std::string("-") + _name);
+    };
+    this->callbacks.userData = this;
+    math::SetTraceCallbacks(&this->callbacks);
+  }
+
+  protected: void TearDown() override
+  {
+    math::SetTraceCallbacks(nullptr);
+  }
+
+  /// \brief Callbacks recording the zones.
+  protected: math::TraceCallbacks callbacks;
+
+  /// \brief Zones received.
+  protected: std::vector<std::string> events;
+};
+
+/////////////////////////////////////////////////
+TEST_F(TraceTest, Callbacks)
+{
+  EXPECT_EQ(&this->callbacks, math::ActiveTraceCallbacks());
+
+  math::SetTraceCallbacks(nullptr);
+  EXPECT_EQ(nullptr, math::ActiveTraceCallbacks());
+  {
+    math::TraceZone zone("ignored");
+  }
+  EXPECT_TRUE(this->events.empty());
+
+  math::SetTraceCallbacks(&this->callbacks);
+  {
+    math::TraceZone outer("outer");
+    {
+      math::TraceZone inner("inner");
+    }
+  }
+  EXPECT_EQ(std::vector<std::string>({"+outer", "+inner", "-inner",
+                                      "-outer"}), this->events);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceTest, ChangedDuringZone)
+{
+  // The end of a zone goes to the callbacks which received its beginning.
+  {
+    math::TraceZone zone("zone");
+    math::SetTraceCallbacks(nullptr);
+  }
+  EXPECT_EQ(std::vector<std::string>({"+zone", "-zone"}), this->events);
+
+  this->events.clear();
+  {
+    math::TraceZone zone("zone");
+    math::SetTraceCallbacks(&this->callbacks);
+  }
+  EXPECT_TRUE(this->events.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceTest, PartialCallbacks)
+{
+  this->callbacks.end = nullptr;
+  {
+    math::TraceZone zone("zone");
+  }
+  EXPECT_EQ(std::vector<std::string>({"+zone"}), this->events);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TraceTest, LibraryZones)
+{
+  std::vector<math::Vector3d> obs;
+  for (int i = 0; i < 20; ++i)
+    obs.emplace_back(i % 2 ? 10 : -10, i, 0);
+  math::Kmeans kmeans(obs);
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  EXPECT_TRUE(kmeans.Cluster(2, centroids, labels));
+  EXPECT_EQ(std::vector<std::string>({"+Kmeans::Cluster",
+                                      "-Kmeans::Cluster"}), this->events);
+
+  this->events.clear();
+  math::graph::UndirectedGraph<int, double> graph(
+      {{{"0", 0, 0}, {"1", 1, 1}, {"2", 2, 2}},
+       {{{0, 1}, 1, 1.0}, {{1, 2}, 1, 1.0}}});
+  auto res = math::graph::Dijkstra(graph, 0, 2);
+  EXPECT_DOUBLE_EQ(2.0, res.at(2).first);
+  EXPECT_EQ(std::vector<std::string>({"+Dijkstra", "-Dijkstra"}),
+            this->events);
+
+  this->events.clear();
+  math::BoundingVolumeHierarchy bvh;
+  bvh.Build({math::AxisAlignedBox(math::Vector3d::Zero,
+                                  math::Vector3d::One)});
+  EXPECT_EQ(std::vector<std::string>({"+BoundingVolumeHierarchy::Build",
+      "-BoundingVolumeHierarchy::Build"}), this->events);
+}
@@ -0,0 +1,473 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gz/math/BinaryCodec.hh"
+#include "gz/math/Diagnostics.hh"
+#include "gz/math/MappedFile.hh"
+#include "gz/math/RotationSpline.hh"
+#include "gz/math/Spline.hh"
+#include "gz/math/TrajectoryFile.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief First bytes of a trajectory file.
+  constexpr char kMagic[8] = {'G', 'Z', 'T', 'R', 'A', 'J', '\0', '\0'};
+
+  /// \brief Version of the format.
+  constexpr uint32_t kVersion = 1;
+
+  /// \brief Size of the header, which keeps the columns aligned.
+  constexpr std::size_t kHeaderSize = 64;
+
+  /// \brief Flag of the header set when there is a rotation column.
+  constexpr uint32_t kHasRotations = 1;
+
+  /// \brief Number of components of a position.
+  constexpr std::size_t kPositionSize = 3;
+
+  /// \brief Number of components of a rotation.
+  constexpr std::size_t kRotationSize = 4;
+
+  /// \brief Number of values encoded at a time when writing.
+  constexpr std::size_t kChunk = 4096;
+
+  /// \brief Check if the host is little endian.
+  /// \return True if the host is little endian.
+  bool LittleEndianHost()
+  {
+    const uint16_t one = 1;
+    uint8_t first;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+  }
+
+  /// \brief Encode a column and write it to a stream in chunks.
+  /// \param[in] _out Stream to write to.
+  /// \param[in] _values Values to write.
+  template<typename T>
+  void WriteColumn(std::ofstream &_out, const std::vector<T> &_values)
+  {
+    std::vector<uint8_t> buffer;
+    for (std::size_t i = 0; i < _values.size(); i += kChunk)
+    {
+      buffer.clear();
+      BinaryEncoder encoder(buffer);
+      encoder.WriteArray(_values.data() + i,
+                         std::min(kChunk, _values.size() - i));
+      _out.write(reinterpret_cast<const char *>(buffer.data()),
+                 static_cast<std::streamsize>(buffer.size()));
+    }
+  }
+}
+
+/// \brief Private data for the TrajectoryFile class.
+class gz::math::TrajectoryFilePrivate
+{
+  /// \brief Unmap the file and reset the columns.
+  public: void Unmap()
+  {
+    this->file.Close();
+    this->data = nullptr;
+    this->size = 0;
+    this->count = 0;
+    this->times = nullptr;
+    this->positions = nullptr;
+    this->rotations = nullptr;
+  }
+
+  /// \brief Check the header of the mapped file and set the columns.
+  /// \return True if the header is valid.
+  public: bool ReadHeader()
+  {
+    this->data = this->file.Data();
+    this->size = this->file.Size();
+    if (this->size < kHeaderSize ||
+        std::memcmp(this->data, kMagic, sizeof(kMagic)) != 0)
+    {
+      return false;
+    }
+
+    BinaryDecoder decoder(this->data + sizeof(kMagic),
+                          kHeaderSize - sizeof(kMagic));
+    uint32_t version = 0;
+    uint32_t flags = 0;
+    uint64_t n = 0;
+    uint64_t offsets[3] = {0, 0, 0};
+    decoder.Read(version);
+    decoder.Read(flags);
+    decoder.Read(n);
+    decoder.ReadArray(offsets, 3);
+    if (!decoder.Good() || version != kVersion)
+      return false;
+
+    // Each column must be aligned and fit in the file.
+    const bool hasRotations = (flags & kHasRotations) != 0;
+    const std::size_t sizes[3] = {sizeof(double),
+                                  kPositionSize * sizeof(double),
+                                  kRotationSize * sizeof(double)};
+    for (int i = 0; i < (hasRotations ? 3 : 2); ++i)
+    {
+      if (offsets[i] < kHeaderSize || offsets[i] % sizeof(double) != 0 ||
+          offsets[i] > this->size ||
+          n > (this->size - offsets[i]) / sizes[i])
+      {
+        return false;
+      }
+    }
+
+    this->count = static_cast<std::size_t>(n);
+    this->times = reinterpret_cast<const double *>(this->data + offsets[0]);
+    this->positions =
+      reinterpret_cast<const double *>(this->data + offsets[1]);
+    if (hasRotations)
+    {
+      this->rotations =
+        reinterpret_cast<const double *>(this->data + offsets[2]);
+    }
+    return true;
+  }
+
+  /// \brief Find the segment of a time and the fraction of the segment.
+  /// \param[in] _time Time to look up, clamped to the recording.
+  /// \param[out] _fraction Fraction of the segment, in [0, 1].
+  /// \return Index of the first sample of the segment.
+  public: std::size_t Segment(const double _time, double &_fraction) const
+  {
+    const double *end = this->times + this->count;
+    std::size_t i = static_cast<std::size_t>(
+        std::upper_bound(this->times, end, _time) - this->times);
+    i = std::min(i > 0 ? i - 1 : 0, this->count - 2);
+
+    const double dt = this->times[i + 1] - this->times[i];
+    _fraction = dt > 0 ? (_time - this->times[i]) / dt : 0.0;
+    _fraction = std::clamp(_fraction, 0.0, 1.0);
+    return i;
+  }
+
+  /// \brief Get the position of a sample.
+  /// \param[in] _index Index of the sample.
+  /// \return The position.
+  public: Vector3d SamplePosition(const std::size_t _index) const
+  {
+    const double *p = this->positions + kPositionSize * _index;
+    return Vector3d(p[0], p[1], p[2]);
+  }
+
+  /// \brief Get the rotation of a sample.
+  /// \param[in] _index Index of the sample.
+  /// \return The rotation, the identity if there is no rotation column.
+  public: Quaterniond SampleRotation(const std::size_t _index) const
+  {
+    if (!this->rotations)
+      return Quaterniond::Identity;
+    const double *q = this->rotations + kRotationSize * _index;
+    return Quaterniond(q[0], q[1], q[2], q[3]);
+  }
+
+  /// \brief Interpolate the position in a segment with a spline through
+  /// the samples around it, which gives the same result as a spline
+  /// through all the samples.
+  /// \param[in] _segment Index of the first sample of the segment.
+  /// \param[in] _fraction Fraction of the segment.
+  /// \return Interpolated position.
+  public: Vector3d Position(const std::size_t _segment,
+                            const double _fraction) const
+  {
+    const std::size_t first = _segment > 0 ? _segment - 1 : 0;
+    const std::size_t last = std::min(_segment + 2, this->count - 1);
+    Spline spline;
+    for (std::size_t i = first; i <= last; ++i)
+      spline.AddPoint(this->SamplePosition(i));
+    return spline.Interpolate(
+        static_cast<unsigned int>(_segment - first), _fraction);
+  }
+
+  /// \brief Interpolate the rotation in a segment with a rotation spline
+  /// through the samples around it.
+  /// \param[in] _segment Index of the first sample of the segment.
+  /// \param[in] _fraction Fraction of the segment.
+  /// \return Interpolated rotation.
+  public: Quaterniond Rotation(const std::size_t _segment,
+                               const double _fraction) const
+  {
+    const std::size_t first = _segment > 0 ? _segment - 1 : 0;
+    const std::size_t last = std::min(_segment + 2, this->count - 1);
+    RotationSpline spline;
+    for (std::size_t i = first; i <= last; ++i)
+      spline.AddPoint(this->SampleRotation(i));
+    return spline.Interpolate(
+        static_cast<unsigned int>(_segment - first), _fraction);
+  }
+
+  /// \brief Mapped bytes.
+  public: const uint8_t *data = nullptr;
+
+  /// \brief Number of mapped bytes.
+  public: std::size_t size = 0;
+
+  /// \brief Number of samples.
+  public: std::size_t count = 0;
+
+  /// \brief Time column.
+  public: const double *times = nullptr;
+
+  /// \brief Position column, x, y, z per sample.
+  public: const double *positions = nullptr;
+
+  /// \brief Rotation column, w, x, y, z per sample, nullptr if there is
+  /// none.
+  public: const double *rotations = nullptr;
+
+  /// \brief The mapped file.
+  public: MappedFile file;
+};
+
+//////////////////////////////////////////////////
+TrajectoryFile::TrajectoryFile()
+  : dataPtr(new TrajectoryFilePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+TrajectoryFile::TrajectoryFile(TrajectoryFile &&_file)
+  : dataPtr(new TrajectoryFilePrivate)
+{
+  std::swap(this->dataPtr, _file.dataPtr);
+}
+
+//////////////////////////////////////////////////
+TrajectoryFile::~TrajectoryFile()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+TrajectoryFile &TrajectoryFile::operator=(TrajectoryFile &&_file) noexcept
+{
+  if (this != &_file)
+  {
+    this->Close();
+    std::swap(this->dataPtr, _file.dataPtr);
+  }
+  return *this;
+}
+
+//////////////////////////////////////////////////
+bool TrajectoryFile::Write(const std::string &_filename,
+    const std::vector<double> &_times,
+    const std::vector<Vector3d> &_positions,
+    const std::vector<Quaterniond> &_rotations)
+{
+  if (_positions.size() != _times.size() ||
+      (!_rotations.empty() && _rotations.size() != _times.size()))
+  {
+    IGN_MATH_DIAGNOSTIC("Trajectory has " << _times.size() << " times, "
+        << _positions.size() << " positions and "
+        << _rotations.size() << " rotations");
+    return false;
+  }
+
+  for (std::size_t i = 0; i < _times.size(); ++i)
+  {
+    if (!std::isfinite(_times[i]) || (i > 0 && _times[i] < _times[i - 1]))
+    {
+      IGN_MATH_DIAGNOSTIC("Trajectory time[" << _times[i] << "] at index[" << i
+          << "] is not finite and non-decreasing");
+      return false;
+    }
+  }
+
+  const uint64_t n = _times.size();
+  const uint64_t timesOffset = kHeaderSize;
+  const uint64_t positionsOffset = timesOffset + n * sizeof(double);
+  const uint64_t rotationsOffset = _rotations.empty() ? 0 :
+    positionsOffset + n * kPositionSize * sizeof(double);
+
+  std::vector<uint8_t> header(kMagic, kMagic + sizeof(kMagic));
+  BinaryEncoder encoder(header);
+  encoder.Write(kVersion);
+  encoder.Write(_rotations.empty() ? uint32_t(0) : kHasRotations);
+  encoder.Write(n);
+  encoder.Write(timesOffset);
+  encoder.Write(positionsOffset);
+  encoder.Write(rotationsOffset);
+  header.resize(kHeaderSize, 0);
+
+  std::ofstream out(_filename, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char *>(header.data()),
+            static_cast<std::streamsize>(header.size()));
+  WriteColumn(out, _times);
+  WriteColumn(out, _positions);
+  WriteColumn(out, _rotations);
+  out.close();
+  if (!out)
+  {
+    IGN_MATH_DIAGNOSTIC("Unable to write trajectory file[" << _filename << "]");
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool TrajectoryFile::Write(const std::string &_filename,
+    const std::vector<double> &_times, const std::vector<Pose3d> &_poses)
+{
+  std::vector<Vector3d> positions(_poses.size());
+  std::vector<Quaterniond> rotations(_poses.size());
+  for (std::size_t i = 0; i < _poses.size(); ++i)
+  {
+    positions[i] = _poses[i].Pos();
+    rotations[i] = _poses[i].Rot();
+  }
+  return Write(_filename, _times, positions, rotations);
+}
+
+//////////////////////////////////////////////////
+bool TrajectoryFile::Open(const std::string &_filename)
+{
+  this->Close();
+
+  if (!LittleEndianHost())
+  {
+    IGN_MATH_DIAGNOSTIC("Trajectory files can only be mapped on little endian "
+        << "hosts");
+    return false;
+  }
+
+  if (!this->dataPtr->file.Open(_filename))
+  {
+    IGN_MATH_DIAGNOSTIC("Unable to map trajectory file[" << _filename << "]");
+    this->Close();
+    return false;
+  }
+
+  if (!this->dataPtr->ReadHeader())
+  {
+    IGN_MATH_DIAGNOSTIC("Invalid trajectory file[" << _filename << "]");
+    this->Close();
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void TrajectoryFile::Close()
+{
+  if (this->dataPtr)
+    this->dataPtr->Unmap();
+}
+
+//////////////////////////////////////////////////
+bool TrajectoryFile::IsOpen() const
+{
+  return this->dataPtr->times != nullptr;
+}
+
+//////////////////////////////////////////////////
+std::size_t TrajectoryFile::Size() const
+{
+  return this->dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+bool TrajectoryFile::HasRotations() const
+{
+  return this->dataPtr->rotations != nullptr;
+}
+
+//////////////////////////////////////////////////
+const double *TrajectoryFile::Times() const
+{
+  return this->dataPtr->times;
+}
+
+//////////////////////////////////////////////////
+const double *TrajectoryFile::Positions() const
+{
+  return this->dataPtr->positions;
+}
+
+//////////////////////////////////////////////////
+const double *TrajectoryFile::Rotations() const
+{
+  return this->dataPtr->rotations;
+}
+
+//////////////////////////////////////////////////
+Pose3d TrajectoryFile::SamplePose(const std::size_t _index) const
+{
+  return Pose3d(this->dataPtr->SamplePosition(_index),
+                this->dataPtr->SampleRotation(_index));
+}
+
+//////////////////////////////////////////////////
+std::size_t TrajectoryFile::SampleIndex(const double _time) const
+{
+  const double *times = this->dataPtr->times;
+  if (this->dataPtr->count == 0)
+    return 0;
+  const std::size_t i = static_cast<std::size_t>(std::upper_bound(
+      times, times + this->dataPtr->count, _time) - times);
+  return i > 0 ? i - 1 : 0;
+}
+
+//////////////////////////////////////////////////
+bool TrajectoryFile::Interpolate(const double _time,
+    Vector3d &_position) const
+{
+  if (this->dataPtr->count == 0)
+    return false;
+  if (this->dataPtr->count == 1)
+  {
+    _position = this->dataPtr->SamplePosition(0);
+    return true;
+  }
+
+  double fraction;
+  const std::size_t segment = this->dataPtr->Segment(_time, fraction);
+  _position = this->dataPtr->Position(segment, fraction);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool TrajectoryFile::Interpolate(const double _time, Pose3d &_pose) const
+{
+  if (this->dataPtr->count == 0)
+    return false;
+  if (this->dataPtr->count == 1)
+  {
+    _pose = this->SamplePose(0);
+    return true;
+  }
+
+  double fraction;
+  const std::size_t segment = this->dataPtr->Segment(_time, fraction);
+  const Quaterniond rot = this->dataPtr->rotations ?
+    this->dataPtr->Rotation(segment, fraction) : Quaterniond::Identity;
+  _pose.Set(this->dataPtr->Position(segment, fraction), rot);
+  return true;
+}
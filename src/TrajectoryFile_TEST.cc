@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gz/math/RotationSpline.hh"
+#include "gz/math/Spline.hh"
+#include "gz/math/TrajectoryFile.hh"
+
+using namespace gz;
+
+/// \brief Get a path in the temporary directory of the test.
+/// \param[in] _name Name of the file.
+/// \return Path of the file.
+static std::string TempPath(const std::string &_name)
+{
+  return testing::TempDir() + "TrajectoryFile_TEST_" + _name;
+}
+
+/////////////////////////////////////////////////
+TEST(TrajectoryFileTest, Poses)
+{
+  std::vector<double> times;
+  std::vector<math::Pose3d> poses;
+  for (int i = 0; i < 20; ++i)
+  {
+    const double t = 0.1 * i * i;
+    times.push_back(t);
+    poses.emplace_back(std::cos(t), std::sin(t), 0.5 * t, 0, 0.1 * t, t);
+  }
+
+  const std::string path = TempPath("poses");
+  ASSERT_TRUE(math::TrajectoryFile::Write(path, times, poses));
+
+  math::TrajectoryFile file;
+  EXPECT_FALSE(file.IsOpen());
+  EXPECT_EQ(0u, file.Size());
+  EXPECT_EQ(nullptr, file.Times());
+  ASSERT_TRUE(file.Open(path));
+  EXPECT_TRUE(file.IsOpen());
+  EXPECT_TRUE(file.HasRotations());
+  ASSERT_EQ(times.size(), file.Size());
+
+  // The columns are read in place, bit for bit.
+  for (std::size_t i = 0; i < times.size(); ++i)
+  {
+    EXPECT_EQ(times[i], file.Times()[i]);
+    EXPECT_EQ(poses[i].Pos().X(), file.Positions()[3 * i]);
+    EXPECT_EQ(poses[i].Pos().Z(), file.Positions()[3 * i + 2]);
+    EXPECT_EQ(poses[i].Rot().W(), file.Rotations()[4 * i]);
+    EXPECT_EQ(poses[i].Rot().Z(), file.Rotations()[4 * i + 3]);
+    EXPECT_EQ(poses[i], file.SamplePose(i));
+  }
+
+  EXPECT_EQ(0u, file.SampleIndex(-1.0));
+  EXPECT_EQ(0u, file.SampleIndex(0.0));
+  EXPECT_EQ(0u, file.SampleIndex(0.05));
+  EXPECT_EQ(1u, file.SampleIndex(0.1));
+  EXPECT_EQ(5u, file.SampleIndex(3.0));
+  EXPECT_EQ(19u, file.SampleIndex(1000.0));
+
+  // Samples are interpolated exactly, and times outside of the recording
+  // are clamped.
+  math::Pose3d pose;
+  for (std::size_t i = 0; i < times.size(); ++i)
+  {
+    EXPECT_TRUE(file.Interpolate(times[i], pose));
+    EXPECT_EQ(poses[i].Pos(), pose.Pos());
+    EXPECT_EQ(poses[i].Rot(), pose.Rot());
+  }
+  EXPECT_TRUE(file.Interpolate(-5.0, pose));
+  EXPECT_EQ(poses.front(), pose);
+  EXPECT_TRUE(file.Interpolate(1e9, pose));
+  EXPECT_EQ(poses.back(), pose);
+
+  // Between samples, the result matches splines through all the samples,
+  // parameterized linearly in time within each segment.
+  math::Spline spline;
+  math::RotationSpline rotationSpline;
+  for (const auto &p : poses)
+  {
+    spline.AddPoint(p.Pos());
+    rotationSpline.AddPoint(p.Rot());
+  }
+  for (unsigned int i : {0u, 1u, 7u, 17u, 18u})
+  {
+    const double time = times[i] + 0.3 * (times[i + 1] - times[i]);
+    EXPECT_TRUE(file.Interpolate(time, pose));
+    EXPECT_EQ(spline.Interpolate(i, 0.3), pose.Pos());
+    EXPECT_EQ(rotationSpline.Interpolate(i, 0.3), pose.Rot());
+
+    math::Vector3d position;
+    EXPECT_TRUE(file.Interpolate(time, position));
+    EXPECT_EQ(pose.Pos(), position);
+  }
+
+  // Move.
+  math::TrajectoryFile moved(std::move(file));
+  EXPECT_TRUE(moved.IsOpen());
+  EXPECT_EQ(times.size(), moved.Size());
+
+  math::TrajectoryFile assigned;
+  assigned = std::move(moved);
+  EXPECT_TRUE(assigned.IsOpen());
+  EXPECT_EQ(poses[3], assigned.SamplePose(3));
+
+  assigned.Close();
+  EXPECT_FALSE(assigned.IsOpen());
+  EXPECT_EQ(0u, assigned.Size());
+  EXPECT_FALSE(assigned.Interpolate(0.0, pose));
+}
+
+/////////////////////////////////////////////////
+TEST(TrajectoryFileTest, Positions)
+{
+  const std::vector<double> times = {1.0, 2.0, 2.0, 3.0};
+  const std::vector<math::Vector3d> positions = {
+    math::Vector3d(0, 0, 0), math::Vector3d(1, 0, 0),
+    math::Vector3d(2, 0, 0), math::Vector3d(3, 1, 0)};
+
+  const std::string path = TempPath("positions");
+  ASSERT_TRUE(math::TrajectoryFile::Write(path, times, positions));
+
+  math::TrajectoryFile file;
+  ASSERT_TRUE(file.Open(path));
+  EXPECT_FALSE(file.HasRotations());
+  EXPECT_EQ(nullptr, file.Rotations());
+  EXPECT_EQ(math::Pose3d(2, 0, 0, 0, 0, 0), file.SamplePose(2));
+
+  // Repeated times select the last of their samples.
+  EXPECT_EQ(2u, file.SampleIndex(2.0));
+  math::Vector3d position;
+  EXPECT_TRUE(file.Interpolate(2.0, position));
+  EXPECT_EQ(positions[2], position);
+
+  math::Pose3d pose;
+  EXPECT_TRUE(file.Interpolate(2.5, pose));
+  EXPECT_EQ(math::Quaterniond::Identity, pose.Rot());
+  EXPECT_GT(pose.Pos().X(), 2.0);
+  EXPECT_LT(pose.Pos().X(), 3.0);
+
+  // One sample.
+  ASSERT_TRUE(math::TrajectoryFile::Write(path, {4.0},
+        {math::Vector3d(1, 2, 3)}));
+  ASSERT_TRUE(file.Open(path));
+  EXPECT_EQ(1u, file.Size());
+  EXPECT_TRUE(file.Interpolate(0.0, position));
+  EXPECT_EQ(math::Vector3d(1, 2, 3), position);
+
+  // No samples.
+  ASSERT_TRUE(math::TrajectoryFile::Write(path, {},
+        std::vector<math::Vector3d>()));
+  ASSERT_TRUE(file.Open(path));
+  EXPECT_TRUE(file.IsOpen());
+  EXPECT_EQ(0u, file.Size());
+  EXPECT_EQ(0u, file.SampleIndex(1.0));
+  EXPECT_FALSE(file.Interpolate(0.0, position));
+}
+
+/////////////////////////////////////////////////
+TEST(TrajectoryFileTest, Invalid)
+{
+  const std::string path = TempPath("invalid");
+  const std::vector<math::Vector3d> positions(3);
+
+  EXPECT_FALSE(math::TrajectoryFile::Write(path, {0, 1}, positions));
+  EXPECT_FALSE(math::TrajectoryFile::Write(path, {0, 1, 2}, positions,
+        std::vector<math::Quaterniond>(2)));
+  EXPECT_FALSE(math::TrajectoryFile::Write(path, {0, 2, 1}, positions));
+  EXPECT_FALSE(math::TrajectoryFile::Write(path,
+        {0, 1, std::numeric_limits<double>::quiet_NaN()}, positions));
+  EXPECT_FALSE(math::TrajectoryFile::Write("/no/such/dir/file",
+        {0, 1, 2}, positions));
+
+  math::TrajectoryFile file;
+  EXPECT_FALSE(file.Open(TempPath("missing")));
+  EXPECT_FALSE(file.IsOpen());
+
+  // Not a trajectory file.
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << std::string(100, 'x');
+  }
+  EXPECT_FALSE(file.Open(path));
+
+  // Truncated columns.
+  ASSERT_TRUE(math::TrajectoryFile::Write(path, {0, 1, 2}, positions,
+        std::vector<math::Quaterniond>(3)));
+  std::string bytes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in),
+                 std::istreambuf_iterator<char>());
+  }
+  EXPECT_EQ(64u + 3 * (8u + 24u + 32u), bytes.size());
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << bytes.substr(0, bytes.size() - 1);
+  }
+  EXPECT_FALSE(file.Open(path));
+  EXPECT_FALSE(file.IsOpen());
+
+  // A failed open closes the current file.
+  const std::string valid = TempPath("valid");
+  ASSERT_TRUE(math::TrajectoryFile::Write(valid, {0}, {math::Vector3d()}));
+  ASSERT_TRUE(file.Open(valid));
+  EXPECT_FALSE(file.Open(path));
+  EXPECT_FALSE(file.IsOpen());
+}
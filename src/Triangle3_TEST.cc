@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
+
 #include "gz/math/Triangle3.hh"
 #include "gz/math/Helpers.hh"
 
@@ -202,6 +207,131 @@ TEST(Triangle3Test, Intersects)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(Triangle3Test, RayIntersection)
+{
+  const Vector3d v0(0, 0, 0), v1(2, 0, 0), v2(0, 2, 0);
+  double t, u, v;
+
+  // Hit, with the position along the direction and barycentrics
+  EXPECT_TRUE(Triangle3d::RayIntersection(v0, v1, v2, Vector3d(0.5, 1, 3),
+      Vector3d(0, 0, -2), t, u, v));
+  EXPECT_DOUBLE_EQ(1.5, t);
+  EXPECT_DOUBLE_EQ(0.25, u);
+  EXPECT_DOUBLE_EQ(0.5, v);
+
+  // Back face, and hits behind the origin
+  EXPECT_TRUE(Triangle3d::RayIntersection(v0, v1, v2, Vector3d(0.5, 1, -3),
+      Vector3d(0, 0, 1), t, u, v));
+  EXPECT_DOUBLE_EQ(3, t);
+  EXPECT_TRUE(Triangle3d::RayIntersection(v0, v1, v2, Vector3d(0.5, 1, 3),
+      Vector3d(0, 0, 1), t, u, v));
+  EXPECT_DOUBLE_EQ(-3, t);
+
+  // Vertices and edges are hit
+  EXPECT_TRUE(Triangle3d::RayIntersection(v0, v1, v2, Vector3d(2, 0, 1),
+      -Vector3d::UnitZ, t, u, v));
+  EXPECT_TRUE(Triangle3d::RayIntersection(v0, v1, v2, Vector3d(1, 1, 1),
+      -Vector3d::UnitZ, t, u, v));
+
+  // Misses
+  EXPECT_FALSE(Triangle3d::RayIntersection(v0, v1, v2, Vector3d(1.5, 1, 1),
+      -Vector3d::UnitZ, t, u, v));
+  EXPECT_FALSE(Triangle3d::RayIntersection(v0, v1, v2, Vector3d(-0.1, 1, 1),
+      -Vector3d::UnitZ, t, u, v));
+  EXPECT_FALSE(Triangle3d::RayIntersection(v0, v1, v2, Vector3d(0.5, 0.5, 0),
+      Vector3d::UnitX, t, u, v));
+  EXPECT_FALSE(Triangle3d::RayIntersection(v0, v1, v2,
+      Vector3d(NAN_D, 0.5, 1), -Vector3d::UnitZ, t, u, v));
+  EXPECT_FALSE(Triangle3d::RayIntersection(v0, v0, v2, Vector3d(0, 0.5, 1),
+      -Vector3d::UnitZ, t, u, v));
+}
+
+/////////////////////////////////////////////////
+TEST(Triangle3Test, IntersectDist)
+{
+  const Triangle3d tri(Vector3d(0, 0, 0), Vector3d(2, 0, 0),
+                       Vector3d(0, 2, 0));
+
+  auto result = tri.IntersectDist(Vector3d(0.5, 0.5, 4), Vector3d(0, 0, -7),
+                                  0, 10);
+  EXPECT_TRUE(std::get<0>(result));
+  EXPECT_DOUBLE_EQ(4, std::get<1>(result));
+
+  // Distances are measured from _min
+  result = tri.IntersectDist(Vector3d(0.5, 0.5, 4), -Vector3d::UnitZ, 1, 10);
+  EXPECT_TRUE(std::get<0>(result));
+  EXPECT_DOUBLE_EQ(3, std::get<1>(result));
+
+  // Outside of the allowed distances
+  result = tri.IntersectDist(Vector3d(0.5, 0.5, 4), -Vector3d::UnitZ, 0, 3);
+  EXPECT_FALSE(std::get<0>(result));
+  EXPECT_DOUBLE_EQ(0, std::get<1>(result));
+  EXPECT_FALSE(std::get<0>(tri.IntersectDist(Vector3d(0.5, 0.5, 4),
+      Vector3d::UnitZ, 0, 10)));
+}
+
+/////////////////////////////////////////////////
+TEST(Triangle3Test, ClosestHit)
+{
+  // Two unit squares at z = 0 and z = 1, and a triangle off to the side
+  const std::vector<Vector3d> vertices{
+      Vector3d(0, 0, 0), Vector3d(1, 0, 0), Vector3d(1, 1, 0),
+      Vector3d(0, 1, 0), Vector3d(0, 0, 1), Vector3d(1, 0, 1),
+      Vector3d(1, 1, 1), Vector3d(0, 1, 1), Vector3d(5, 5, 5),
+      Vector3d(6, 5, 5), Vector3d(5, 6, 5)};
+  const std::vector<uint32_t> indices{
+      0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7, 8, 9, 10};
+  const std::size_t triangleCount = indices.size() / 3;
+
+  std::size_t triangle = 0;
+  double dist = 0;
+  EXPECT_TRUE(Triangle3d::ClosestHit(vertices.data(), indices.data(),
+      triangleCount, Vector3d(0.75, 0.25, 3), -Vector3d::UnitZ, 0, 10,
+      triangle, dist));
+  EXPECT_EQ(2u, triangle);
+  EXPECT_DOUBLE_EQ(2, dist);
+
+  // From below, and skipping the first square with _min
+  EXPECT_TRUE(Triangle3d::ClosestHit(vertices.data(), indices.data(),
+      triangleCount, Vector3d(0.25, 0.75, -1), Vector3d::UnitZ, 0, 10,
+      triangle, dist));
+  EXPECT_EQ(1u, triangle);
+  EXPECT_DOUBLE_EQ(1, dist);
+  EXPECT_TRUE(Triangle3d::ClosestHit(vertices.data(), indices.data(),
+      triangleCount, Vector3d(0.25, 0.75, -1), Vector3d::UnitZ, 1.5, 10,
+      triangle, dist));
+  EXPECT_EQ(3u, triangle);
+  EXPECT_DOUBLE_EQ(0.5, dist);
+
+  // The lowest index is reported on a shared edge
+  EXPECT_TRUE(Triangle3d::ClosestHit(vertices.data(), indices.data(),
+      triangleCount, Vector3d(0.5, 0.5, -1), Vector3d::UnitZ, 0, 10,
+      triangle, dist));
+  EXPECT_EQ(0u, triangle);
+
+  EXPECT_FALSE(Triangle3d::ClosestHit(vertices.data(), indices.data(),
+      triangleCount, Vector3d(3, 3, 3), -Vector3d::UnitZ, 0, 10,
+      triangle, dist));
+
+  // Batch of rays
+  const std::vector<Vector3d> origins{
+      Vector3d(0.75, 0.25, 3), Vector3d(5.2, 5.2, 0), Vector3d(3, 3, 3)};
+  const std::vector<Vector3d> dirs{
+      -Vector3d::UnitZ, Vector3d(0, 0, 2), -Vector3d::UnitZ};
+  std::vector<std::size_t> triangles(origins.size());
+  std::vector<double> distances(origins.size());
+  Triangle3d::ClosestHits(vertices.data(), indices.data(), triangleCount,
+      origins.data(), dirs.data(), origins.size(), 0, 10, triangles.data(),
+      distances.data());
+  EXPECT_EQ(2u, triangles[0]);
+  EXPECT_DOUBLE_EQ(2, distances[0]);
+  EXPECT_EQ(4u, triangles[1]);
+  EXPECT_DOUBLE_EQ(5, distances[1]);
+  EXPECT_EQ(std::numeric_limits<std::size_t>::max(), triangles[2]);
+  EXPECT_DOUBLE_EQ(0, distances[2]);
+}
+
 /////////////////////////////////////////////////
 TEST(Triangle3Test, ContainsPt)
 {
@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <vector>
+
 #include "gz/math/Triangle.hh"
 #include "gz/math/Helpers.hh"
 
@@ -192,3 +195,29 @@ TEST(TriangleTest, Area)
 
   EXPECT_NEAR(tri.Area(), 0.499999, 1e-6);
 }
+
+/////////////////////////////////////////////////
+TEST(TriangleTest, ContainsPoints)
+{
+  const math::Triangled tri(math::Vector2d(0, 0), math::Vector2d(2, 0),
+                            math::Vector2d(0, 2));
+  std::vector<math::Vector2d> points;
+  for (int i = -5; i <= 25; ++i)
+  {
+    for (int j = -5; j <= 25; ++j)
+      points.push_back(math::Vector2d(i * 0.1, j * 0.1));
+  }
+
+  std::unique_ptr<bool[]> results(new bool[points.size()]);
+  const std::size_t count = tri.Contains(points.data(), points.size(),
+                                         results.get());
+  std::size_t expected = 0;
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(tri.Contains(points[i]), results[i]) << points[i];
+    expected += tri.Contains(points[i]);
+  }
+  EXPECT_EQ(expected, count);
+  EXPECT_GT(count, 0u);
+  EXPECT_EQ(0u, tri.Contains(points.data(), 0, results.get()));
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "gz/math/TscClock.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(TscClockTest, Steady)
+{
+  static_assert(math::TscClock::is_steady, "TscClock is steady");
+  math::TscClock::Calibrate();
+  EXPECT_GT(math::TscClock::TicksPerSecond(), 0.0);
+
+  auto previous = math::TscClock::now();
+  for (int i = 0; i < 10000; ++i)
+  {
+    const auto now = math::TscClock::now();
+    EXPECT_GE(now, previous);
+    previous = now;
+  }
+
+  const uint64_t ticks = math::TscClock::Ticks();
+  EXPECT_GE(math::TscClock::Ticks(), ticks);
+}
+
+/////////////////////////////////////////////////
+TEST(TscClockTest, MatchesSteadyClock)
+{
+  using steady = std::chrono::steady_clock;
+
+  // Sleeping does not stop the counter, and the calibrated durations
+  // match the steady clock within 2%, with some room for the scheduler
+  // between the reads of the two clocks.
+  for (const auto sleep : {std::chrono::milliseconds(20),
+                           std::chrono::milliseconds(100)})
+  {
+    const auto steadyStart = steady::now();
+    const auto start = math::TscClock::now();
+    std::this_thread::sleep_for(sleep);
+    const auto end = math::TscClock::now();
+    const auto steadyEnd = steady::now();
+
+    const double elapsed =
+      std::chrono::duration<double>(end - start).count();
+    const double expected =
+      std::chrono::duration<double>(steadyEnd - steadyStart).count();
+    EXPECT_GE(elapsed, 0.98 * std::chrono::duration<double>(sleep).count());
+    EXPECT_NEAR(expected, elapsed, 0.02 * expected + 1e-4);
+  }
+}
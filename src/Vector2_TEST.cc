@@ -465,3 +465,23 @@ TEST(Vector2Test, NaN)
   EXPECT_TRUE(nanVecF.IsFinite());
 }
 
+/////////////////////////////////////////////////
+TEST(Vector2Test, Constexpr)
+{
+  // The virtual destructor makes Vector2 a literal type only from C++20.
+#if __cplusplus >= 202002L
+  constexpr math::Vector2d v(1, 2);
+  constexpr math::Vector2d scaled = v * 3.0 - math::Vector2d(1, 1);
+  static_assert(static_cast<int>(scaled.X()) == 2 &&
+                static_cast<int>(scaled.Y()) == 5, "");
+  static_assert(static_cast<int>(v.Dot(scaled)) == 12, "");
+  static_assert(static_cast<int>(v.SquaredLength()) == 5, "");
+  static_assert(static_cast<int>(v[1]) == 2, "");
+#else
+  const math::Vector2d v(1, 2);
+  const math::Vector2d scaled = v * 3.0 - math::Vector2d::One;
+#endif
+  EXPECT_EQ(math::Vector2d(2, 5), scaled);
+  EXPECT_DOUBLE_EQ(12.0, v.Dot(scaled));
+  EXPECT_DOUBLE_EQ(5.0, v.SquaredLength());
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <set>
+#include <vector>
+
+#include "gz/math/Rand.hh"
+#include "gz/math/Vector3HashSet.hh"
+#include "gz/math/detail/WellOrderedVector.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(Vector3HashSetTest, Insert)
+{
+  Vector3HashSet<double> set;
+  EXPECT_DOUBLE_EQ(1e-3, set.Tolerance());
+  EXPECT_TRUE(set.Empty());
+  EXPECT_EQ(Vector3HashSet<double>::kNotFound, set.Find(Vector3d::Zero));
+
+  EXPECT_EQ(std::make_pair(std::size_t(0), true),
+            set.Insert(Vector3d(1, 2, 3)));
+  EXPECT_EQ(std::make_pair(std::size_t(0), false),
+            set.Insert(Vector3d(1.0009, 1.9991, 3)));
+  EXPECT_EQ(std::make_pair(std::size_t(1), true),
+            set.Insert(Vector3d(1.0011, 2, 3)));
+  EXPECT_EQ(std::make_pair(std::size_t(2), true),
+            set.Insert(Vector3d(-1, -2, -3)));
+  EXPECT_EQ(3u, set.Size());
+  EXPECT_TRUE(set.Contains(Vector3d(-1.0005, -2, -3)));
+  EXPECT_FALSE(set.Contains(Vector3d(-1, -2, -3.002)));
+  EXPECT_EQ(Vector3d(1.0011, 2, 3), set.Points()[1]);
+
+  // The first inserted point within the tolerance wins
+  EXPECT_EQ(0u, set.Find(Vector3d(1.0006, 2, 3)));
+
+  // NaN is never merged
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_TRUE(set.Insert(Vector3d(nan, 0, 0)).second);
+  EXPECT_TRUE(set.Insert(Vector3d(nan, 0, 0)).second);
+  EXPECT_EQ(5u, set.Size());
+
+  set.Clear();
+  EXPECT_TRUE(set.Empty());
+  EXPECT_FALSE(set.Contains(Vector3d(1, 2, 3)));
+  EXPECT_TRUE(set.Insert(Vector3d(1, 2, 3)).second);
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3HashSetTest, Exact)
+{
+  Vector3HashSet<float> set(0);
+  EXPECT_FLOAT_EQ(0.f, set.Tolerance());
+  EXPECT_TRUE(set.Insert(Vector3f(1, 2, 3)).second);
+  EXPECT_FALSE(set.Insert(Vector3f(1, 2, 3)).second);
+  EXPECT_TRUE(set.Insert(Vector3f(1, 2, 3.0001f)).second);
+  EXPECT_TRUE(set.Insert(Vector3f(0, 0, 0)).second);
+  EXPECT_FALSE(set.Insert(Vector3f(-0.f, 0, -0.f)).second);
+  EXPECT_EQ(3u, set.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3HashSetTest, WellOrderedVectors)
+{
+  // Vertices of a grid of triangles, each shared by several triangles
+  // with a little noise, as read from a mesh file.
+  Rand::Seed(3);
+  std::vector<Vector3d> exact;
+  std::vector<Vector3d> vertices;
+  for (int copy = 0; copy < 4; ++copy)
+  {
+    for (int i = 0; i < 50; ++i)
+    {
+      for (int j = 0; j < 50; ++j)
+      {
+        exact.push_back(Vector3d(0.1 * i, 0.1 * j, 0.01 * i * j));
+        vertices.push_back(exact.back() + Vector3d(
+            Rand::DblUniform(-1e-5, 1e-5), Rand::DblUniform(-1e-5, 1e-5),
+            Rand::DblUniform(-1e-5, 1e-5)));
+      }
+    }
+  }
+
+  std::vector<Vector3d> welded;
+  std::vector<std::size_t> remap;
+  WeldVertices(vertices, 1e-4, welded, remap);
+  ASSERT_EQ(2500u, welded.size());
+  ASSERT_EQ(vertices.size(), remap.size());
+  for (std::size_t v = 0; v < vertices.size(); ++v)
+  {
+    EXPECT_EQ(v % 2500, remap[v]);
+    EXPECT_TRUE(welded[remap[v]].Equal(vertices[v], 1e-4));
+  }
+
+  // A std::set of WellOrderedVectors finds the same vertices without
+  // noise. Its order is not strict with noise, so it keeps most copies.
+  std::set<Vector3d, WellOrderedVectors<double>> tree(exact.begin(),
+      exact.end());
+  EXPECT_EQ(tree.size(), welded.size());
+
+  // Growing from an empty table gives the same result
+  Vector3HashSet<double> set(1e-4);
+  for (std::size_t v = 0; v < vertices.size(); ++v)
+    EXPECT_EQ(remap[v], set.Insert(vertices[v]).first);
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3HashSetTest, CellBoundaries)
+{
+  // Points on both sides of the boundaries of the cells are merged
+  const double tolerance = 0.25;
+  Vector3HashSet<double> set(tolerance);
+  for (double x = -3; x <= 3; x += 0.125)
+  {
+    set.Clear();
+    ASSERT_TRUE(set.Insert(Vector3d(x, -x, 2 * x)).second);
+    for (double d : {-tolerance, -0.1, 0.1, tolerance})
+    {
+      EXPECT_EQ(0u, set.Find(Vector3d(x + d, -x - d, 2 * x + d))) << x;
+    }
+    EXPECT_FALSE(set.Contains(Vector3d(x + tolerance + 1e-9, -x, 2 * x)));
+    EXPECT_FALSE(set.Contains(Vector3d(x, -x - tolerance - 1e-9, 2 * x)));
+  }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gz/math/Vector3SoA.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(Vector3SoATest, Construct)
+{
+  math::Vector3SoAd empty;
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ(0u, empty.Size());
+
+  math::Vector3SoAd zeros(4);
+  EXPECT_EQ(4u, zeros.Size());
+  for (std::size_t i = 0; i < zeros.Size(); ++i)
+    EXPECT_EQ(math::Vector3d::Zero, zeros[i]);
+
+  std::vector<math::Vector3d> aos = {{1, 2, 3}, {4, 5, 6}, {-1, 0, 1}};
+  math::Vector3SoAd soa(aos);
+  ASSERT_EQ(3u, soa.Size());
+  EXPECT_EQ(aos[0], soa[0]);
+  EXPECT_EQ(aos[1], soa[1]);
+  EXPECT_EQ(aos[2], soa[2]);
+  EXPECT_EQ(aos, soa.ToVector());
+
+  // Component arrays are contiguous views of the data
+  EXPECT_DOUBLE_EQ(4.0, soa.XData()[1]);
+  EXPECT_DOUBLE_EQ(5.0, soa.YData()[1]);
+  EXPECT_DOUBLE_EQ(6.0, soa.ZData()[1]);
+  soa.ZData()[2] = 7;
+  EXPECT_EQ(math::Vector3d(-1, 0, 7), soa[2]);
+
+  soa.Set(0, math::Vector3d(9, 8, 7));
+  EXPECT_EQ(math::Vector3d(9, 8, 7), soa[0]);
+
+  soa.PushBack(math::Vector3d(1, 1, 1));
+  EXPECT_EQ(4u, soa.Size());
+  EXPECT_EQ(math::Vector3d::One, soa[3]);
+
+  soa.Clear();
+  EXPECT_TRUE(soa.Empty());
+
+  math::Vector3SoAf soaf;
+  soaf.Reserve(10);
+  soaf.PushBack(math::Vector3f(1, 2, 3));
+  EXPECT_EQ(math::Vector3f(1, 2, 3), soaf[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3SoATest, Arithmetic)
+{
+  std::vector<math::Vector3d> a = {{1, 2, 3}, {4, 5, 6}, {-1, 0, 1}};
+  std::vector<math::Vector3d> b = {{0, 1, 0}, {2, 2, 2}, {3, -4, 5}};
+  math::Vector3SoAd sa(a);
+  math::Vector3SoAd sb(b);
+
+  math::Vector3SoAd out;
+  math::Vector3SoAd::Add(sa, sb, out);
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_EQ(a[i] + b[i], out[i]);
+
+  math::Vector3SoAd::Sub(sa, sb, out);
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_EQ(a[i] - b[i], out[i]);
+
+  math::Vector3SoAd::Cross(sa, sb, out);
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_EQ(a[i].Cross(b[i]), out[i]);
+
+  std::vector<double> dots;
+  sa.Dot(sb, dots);
+  ASSERT_EQ(a.size(), dots.size());
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_DOUBLE_EQ(a[i].Dot(b[i]), dots[i]);
+
+  sa.Dot(math::Vector3d::UnitZ, dots);
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_DOUBLE_EQ(a[i].Z(), dots[i]);
+
+  std::vector<double> lengths;
+  sa.Length(lengths);
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_DOUBLE_EQ(a[i].Length(), lengths[i]);
+
+  sa.SquaredLength(lengths);
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_DOUBLE_EQ(a[i].SquaredLength(), lengths[i]);
+
+  math::Vector3SoAd c(sa);
+  c += sb;
+  EXPECT_EQ(a[1] + b[1], c[1]);
+  c -= sb;
+  EXPECT_EQ(sa, c);
+
+  c += math::Vector3d(1, 1, 1);
+  EXPECT_EQ(a[0] + math::Vector3d::One, c[0]);
+  c -= math::Vector3d(1, 1, 1);
+  EXPECT_EQ(sa, c);
+
+  c *= 2.0;
+  EXPECT_EQ(a[2] * 2.0, c[2]);
+  EXPECT_NE(sa, c);
+
+  EXPECT_EQ(a[0] + a[1] + a[2], sa.Sum());
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3SoATest, Normalize)
+{
+  std::vector<math::Vector3d> a = {{3, 0, 4}, {0, 0, 0}, {1, 1, 1}};
+  math::Vector3SoAd sa(a);
+  sa.Normalize();
+
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_EQ(a[i].Normalized(), sa[i]);
+
+  // Zero vector is left untouched, like Vector3::Normalize
+  EXPECT_EQ(math::Vector3d::Zero, sa[1]);
+}
@@ -14,12 +14,36 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <map>
+#include <string>
+
 #include <gz/math/Vector3Stats.hh>
 #include "Vector3StatsPrivate.hh"
 
 using namespace gz;
 using namespace math;
 
+namespace
+{
+  /// \brief Check if two collections hold the same statistics.
+  /// \param[in] _a First collection.
+  /// \param[in] _b Second collection.
+  /// \return True if the statistics have the same names.
+  bool SameStatistics(const SignalStats &_a, const SignalStats &_b)
+  {
+    const std::map<std::string, double> a = _a.Map();
+    const std::map<std::string, double> b = _b.Map();
+    return a.size() == b.size() &&
+      std::equal(a.begin(), a.end(), b.begin(),
+          [](const std::pair<const std::string, double> &_x,
+             const std::pair<const std::string, double> &_y)
+          {
+            return _x.first == _y.first;
+          });
+  }
+}
+
 //////////////////////////////////////////////////
 Vector3Stats::Vector3Stats()
   : dataPtr(new Vector3StatsPrivate)
@@ -62,6 +86,25 @@ bool Vector3Stats::InsertStatistics(const std::string &_names)
   return x && y && z && mag;
 }
 
+//////////////////////////////////////////////////
+bool Vector3Stats::Merge(const Vector3Stats &_stats)
+{
+  // Check all the components first, so that nothing is changed if any of
+  // them do not match.
+  if (!SameStatistics(this->dataPtr->x, _stats.dataPtr->x) ||
+      !SameStatistics(this->dataPtr->y, _stats.dataPtr->y) ||
+      !SameStatistics(this->dataPtr->z, _stats.dataPtr->z) ||
+      !SameStatistics(this->dataPtr->mag, _stats.dataPtr->mag))
+  {
+    return false;
+  }
+  bool x = this->dataPtr->x.Merge(_stats.dataPtr->x);
+  bool y = this->dataPtr->y.Merge(_stats.dataPtr->y);
+  bool z = this->dataPtr->z.Merge(_stats.dataPtr->z);
+  bool mag = this->dataPtr->mag.Merge(_stats.dataPtr->mag);
+  return x && y && z && mag;
+}
+
 //////////////////////////////////////////////////
 void Vector3Stats::Reset()
 {
@@ -119,3 +162,104 @@ SignalStats &Vector3Stats::Mag()
   return this->dataPtr->mag;
 }
 
+//////////////////////////////////////////////////
+Vector3Accumulator::Vector3Accumulator()
+  : dataPtr(new Vector3AccumulatorPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+Vector3Accumulator::~Vector3Accumulator()
+{
+}
+
+//////////////////////////////////////////////////
+Vector3Accumulator::Vector3Accumulator(const Vector3Accumulator &_acc)
+  : dataPtr(new Vector3AccumulatorPrivate(*_acc.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+Vector3Accumulator &Vector3Accumulator::operator=(
+    const Vector3Accumulator &_acc)
+{
+  *this->dataPtr = *_acc.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void Vector3Accumulator::InsertData(const Vector3d &_data)
+{
+  Vector3AccumulatorPrivate &d = *this->dataPtr;
+  d.x.InsertData(_data.X());
+  d.y.InsertData(_data.Y());
+  d.z.InsertData(_data.Z());
+  d.mag.InsertData(_data.Length());
+}
+
+//////////////////////////////////////////////////
+void Vector3Accumulator::InsertData(const Vector3d *_data,
+    const size_t _count)
+{
+  Vector3AccumulatorPrivate &d = *this->dataPtr;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    d.x.InsertData(_data[i].X());
+    d.y.InsertData(_data[i].Y());
+    d.z.InsertData(_data[i].Z());
+    d.mag.InsertData(_data[i].Length());
+  }
+}
+
+//////////////////////////////////////////////////
+void Vector3Accumulator::Merge(const Vector3Accumulator &_acc)
+{
+  this->dataPtr->x.Merge(_acc.dataPtr->x);
+  this->dataPtr->y.Merge(_acc.dataPtr->y);
+  this->dataPtr->z.Merge(_acc.dataPtr->z);
+  this->dataPtr->mag.Merge(_acc.dataPtr->mag);
+}
+
+//////////////////////////////////////////////////
+void Vector3Accumulator::Reset()
+{
+  *this->dataPtr = Vector3AccumulatorPrivate();
+}
+
+//////////////////////////////////////////////////
+size_t Vector3Accumulator::Count() const
+{
+  return this->dataPtr->x.count;
+}
+
+//////////////////////////////////////////////////
+SignalAccumulator Vector3Accumulator::X() const
+{
+  SignalAccumulator acc;
+  *acc.dataPtr = this->dataPtr->x;
+  return acc;
+}
+
+//////////////////////////////////////////////////
+SignalAccumulator Vector3Accumulator::Y() const
+{
+  SignalAccumulator acc;
+  *acc.dataPtr = this->dataPtr->y;
+  return acc;
+}
+
+//////////////////////////////////////////////////
+SignalAccumulator Vector3Accumulator::Z() const
+{
+  SignalAccumulator acc;
+  *acc.dataPtr = this->dataPtr->z;
+  return acc;
+}
+
+//////////////////////////////////////////////////
+SignalAccumulator Vector3Accumulator::Mag() const
+{
+  SignalAccumulator acc;
+  *acc.dataPtr = this->dataPtr->mag;
+  return acc;
+}
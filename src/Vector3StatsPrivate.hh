@@ -19,6 +19,7 @@
 
 #include <gz/math/SignalStats.hh>
 #include <gz/math/config.hh>
+#include "SignalStatsPrivate.hh"
 
 namespace ignition
 {
@@ -41,6 +42,22 @@ namespace ignition
       /// \brief Statistics for magnitude of signal.
       public: SignalStats mag;
     };
+
+    /// \brief Private data class for the Vector3Accumulator class.
+    class Vector3AccumulatorPrivate
+    {
+      /// \brief Running sums for x component of signal.
+      public: SignalAccumulatorPrivate x;
+
+      /// \brief Running sums for y component of signal.
+      public: SignalAccumulatorPrivate y;
+
+      /// \brief Running sums for z component of signal.
+      public: SignalAccumulatorPrivate z;
+
+      /// \brief Running sums for magnitude of signal.
+      public: SignalAccumulatorPrivate mag;
+    };
     }
   }
 }
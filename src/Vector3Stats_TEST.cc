@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <string>
+
 #include <gz/math/Vector3Stats.hh>
 
 using namespace gz;
@@ -187,3 +190,111 @@ TEST_F(Vector3StatsTest, Vector3Stats)
     EXPECT_NEAR(this->Mag(name), 1.0, 1e-10);
   }
 }
+
+//////////////////////////////////////////////////
+TEST_F(Vector3StatsTest, Merge)
+{
+  EXPECT_TRUE(this->stats.InsertStatistics("maxAbs,mean,rms,var"));
+  math::Vector3Stats first, second;
+  EXPECT_TRUE(first.InsertStatistics("maxAbs,mean,rms,var"));
+  EXPECT_TRUE(second.InsertStatistics("maxAbs,mean,rms,var"));
+  for (int i = 0; i < 100; ++i)
+  {
+    const math::Vector3d v(std::sin(0.3 * i), 2.0 * i, -0.5 * i);
+    this->stats.InsertData(v);
+    if (i < 40)
+      first.InsertData(v);
+    else
+      second.InsertData(v);
+  }
+  EXPECT_TRUE(first.Merge(second));
+  for (const std::string name : {"maxAbs", "mean", "rms", "var"})
+  {
+    EXPECT_NEAR(this->X(name), first.X().Map()[name], 1e-9);
+    EXPECT_NEAR(this->Y(name), first.Y().Map()[name], 1e-9);
+    EXPECT_NEAR(this->Z(name), first.Z().Map()[name], 1e-9);
+    EXPECT_NEAR(this->Mag(name), first.Mag().Map()[name], 1e-9);
+  }
+  EXPECT_EQ(this->stats.X().Count(), first.X().Count());
+
+  // Nothing changes if any component does not match
+  math::Vector3Stats other;
+  EXPECT_TRUE(other.InsertStatistics("maxAbs,mean,rms,var"));
+  EXPECT_TRUE(other.Mag().InsertStatistic("max"));
+  other.InsertData(math::Vector3d(1, 2, 3));
+  EXPECT_FALSE(other.Merge(first));
+  EXPECT_EQ(1u, other.X().Count());
+}
+
+//////////////////////////////////////////////////
+TEST(Vector3AccumulatorTest, Accumulator)
+{
+  math::Vector3Accumulator acc;
+  EXPECT_EQ(0u, acc.Count());
+  EXPECT_EQ(0u, acc.Mag().Count());
+
+  math::Vector3Stats v3stats;
+  EXPECT_TRUE(v3stats.InsertStatistics("max,maxAbs,mean,min,rms,var"));
+  math::SignalAccumulator x, y, z, mag;
+  std::vector<math::Vector3d> data;
+  for (int i = 0; i < 100; ++i)
+  {
+    const math::Vector3d v(std::sin(0.3 * i), 2.0 * i - 50, -0.5 * i);
+    data.push_back(v);
+    acc.InsertData(v);
+    v3stats.InsertData(v);
+    x.InsertData(v.X());
+    y.InsertData(v.Y());
+    z.InsertData(v.Z());
+    mag.InsertData(v.Length());
+  }
+  EXPECT_EQ(100u, acc.Count());
+
+  // Same results as an accumulator per component
+  for (const auto &pair : {std::make_pair(acc.X(), x),
+                           std::make_pair(acc.Y(), y),
+                           std::make_pair(acc.Z(), z),
+                           std::make_pair(acc.Mag(), mag)})
+  {
+    EXPECT_EQ(pair.second.Map(), pair.first.Map());
+  }
+
+  // and as Vector3Stats
+  for (const std::string name : {"max", "maxAbs", "mean", "min", "rms", "var"})
+  {
+    EXPECT_NEAR(v3stats.X().Map()[name], acc.X().Map()[name], 1e-9);
+    EXPECT_NEAR(v3stats.Y().Map()[name], acc.Y().Map()[name], 1e-9);
+    EXPECT_NEAR(v3stats.Z().Map()[name], acc.Z().Map()[name], 1e-9);
+    EXPECT_NEAR(v3stats.Mag().Map()[name], acc.Mag().Map()[name], 1e-9);
+  }
+
+  // Batch insertion
+  math::Vector3Accumulator batch;
+  batch.InsertData(data.data(), data.size());
+  EXPECT_EQ(acc.Mag().Map(), batch.Mag().Map());
+  EXPECT_EQ(acc.X().Map(), batch.X().Map());
+
+  // Merge of two halves
+  math::Vector3Accumulator first, second;
+  first.InsertData(data.data(), 40);
+  second.InsertData(data.data() + 40, 60);
+  first.Merge(second);
+  EXPECT_EQ(100u, first.Count());
+  for (const std::string name : {"max", "maxAbs", "mean", "min", "rms", "var"})
+  {
+    EXPECT_NEAR(acc.X().Map()[name], first.X().Map()[name], 1e-9);
+    EXPECT_NEAR(acc.Y().Map()[name], first.Y().Map()[name], 1e-9);
+    EXPECT_NEAR(acc.Z().Map()[name], first.Z().Map()[name], 1e-9);
+    EXPECT_NEAR(acc.Mag().Map()[name], first.Mag().Map()[name], 1e-9);
+  }
+
+  // Copy and reset
+  math::Vector3Accumulator copy(acc);
+  acc.Reset();
+  EXPECT_EQ(0u, acc.Count());
+  EXPECT_EQ(0u, acc.Z().Count());
+  EXPECT_DOUBLE_EQ(0.0, acc.Mag().Mean());
+  EXPECT_EQ(100u, copy.Count());
+  acc = copy;
+  EXPECT_EQ(copy.Mag().Map(), acc.Mag().Map());
+}
@@ -19,7 +19,10 @@
 
 #include <numeric>
 #include <sstream>
+#include <string>
+#include <vector>
 
+#include "gz/math/Rand.hh"
 #include "gz/math/Vector3.hh"
 #include "gz/math/Helpers.hh"
 
@@ -534,3 +537,105 @@ TEST(Vector3dTest, DistToLine)
     EXPECT_DOUBLE_EQ(point.DistToLine(pointA, pointB), 0);
   }
 }
+
+/////////////////////////////////////////////////
+TEST(Vector3dTest, Constexpr)
+{
+  // The virtual destructor makes Vector3 a literal type only from C++20.
+#if __cplusplus >= 202002L
+  constexpr math::Vector3d v(1, 2, 3);
+  constexpr math::Vector3d w =
+    v.Cross(math::Vector3d(0, 0, 1)) + 2.0 * v - v / 2.0;
+  static_assert(static_cast<int>(2 * w.X()) == 7 &&
+                static_cast<int>(w.Y()) == 2 &&
+                static_cast<int>(2 * w.Z()) == 9, "");
+  static_assert(static_cast<int>(v.Dot(v)) == 14, "");
+  static_assert(static_cast<int>(v.Max()) == 3 &&
+                static_cast<int>(v.Min()) == 1, "");
+  static_assert(static_cast<int>(v[1]) == 2, "");
+
+  // A table built at compile time
+  constexpr math::Vector3d axes[] = {
+    math::Vector3d(1, 0, 0), -math::Vector3d(0, 1, 0),
+    math::Vector3d(0, 0, 1) * 2.0};
+  static_assert(static_cast<int>(axes[1].Y()) == -1 &&
+                static_cast<int>(axes[2].Z()) == 2, "");
+#else
+  const math::Vector3d v(1, 2, 3);
+  const math::Vector3d w =
+    v.Cross(math::Vector3d::UnitZ) + 2.0 * v - v / 2.0;
+#endif
+  EXPECT_EQ(math::Vector3d(3.5, 2, 4.5), w);
+  EXPECT_DOUBLE_EQ(14.0, v.Dot(v));
+  EXPECT_DOUBLE_EQ(3.0, v.Max());
+  EXPECT_DOUBLE_EQ(1.0, v.Min());
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3dTest, Parse)
+{
+  math::Vector3d v(9, 9, 9);
+  EXPECT_TRUE(math::Vector3d::Parse(" 1 -2.5 3e1 ", v));
+  EXPECT_EQ(math::Vector3d(1, -2.5, 30), v);
+
+  // Wrong number of values or malformed values leave the vector unchanged.
+  EXPECT_FALSE(math::Vector3d::Parse("1 2", v));
+  EXPECT_FALSE(math::Vector3d::Parse("1 2 3 4", v));
+  EXPECT_FALSE(math::Vector3d::Parse("1 2 3a", v));
+  EXPECT_FALSE(math::Vector3d::Parse("", v));
+  EXPECT_EQ(math::Vector3d(1, -2.5, 30), v);
+
+  math::Vector3i vi;
+  EXPECT_TRUE(math::Vector3i::Parse("1 2 3", vi));
+  EXPECT_EQ(math::Vector3i(1, 2, 3), vi);
+  EXPECT_FALSE(math::Vector3i::Parse("1 2 3.5", vi));
+
+  std::vector<math::Vector3d> values = {math::Vector3d::One};
+  EXPECT_TRUE(math::Vector3d::ParseArray("1 2 3\n4 5 6\n", values));
+  ASSERT_EQ(3u, values.size());
+  EXPECT_EQ(math::Vector3d::One, values[0]);
+  EXPECT_EQ(math::Vector3d(1, 2, 3), values[1]);
+  EXPECT_EQ(math::Vector3d(4, 5, 6), values[2]);
+
+  EXPECT_FALSE(math::Vector3d::ParseArray("1 2 3 4 5", values));
+  EXPECT_FALSE(math::Vector3d::ParseArray("1 2 3 4 5 x", values));
+  EXPECT_EQ(3u, values.size());
+  EXPECT_TRUE(math::Vector3d::ParseArray("", values));
+  EXPECT_EQ(3u, values.size());
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3dTest, ToChars)
+{
+  char buffer[128];
+  char *end = buffer + sizeof(buffer);
+
+  const math::Vector3d v(1, -0.1, 2.5e-8);
+  char *p = v.ToChars(buffer, end);
+  ASSERT_NE(nullptr, p);
+  EXPECT_EQ("1 -0.1 2.5e-08", std::string(buffer, p));
+
+  // The text parses back to the same vector.
+  for (int i = 0; i < 1000; ++i)
+  {
+    const math::Vector3d r(math::Rand::DblUniform(-1e3, 1e3),
+                           math::Rand::DblUniform(-1, 1),
+                           math::Rand::DblUniform(-1e-3, 1e-3));
+    p = r.ToChars(buffer, end);
+    ASSERT_NE(nullptr, p);
+    math::Vector3d parsed;
+    EXPECT_TRUE(math::Vector3d::Parse(
+        std::string_view(buffer, static_cast<std::size_t>(p - buffer)),
+        parsed));
+    EXPECT_EQ(r.X(), parsed.X());
+    EXPECT_EQ(r.Y(), parsed.Y());
+    EXPECT_EQ(r.Z(), parsed.Z());
+  }
+
+  const math::Vector3i vi(1, -2, 3);
+  p = vi.ToChars(buffer, end);
+  ASSERT_NE(nullptr, p);
+  EXPECT_EQ("1 -2 3", std::string(buffer, p));
+
+  EXPECT_EQ(nullptr, v.ToChars(buffer, buffer + 8));
+}
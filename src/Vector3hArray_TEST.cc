@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gz/math/Rand.hh"
+#include "gz/math/Vector3hArray.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(Vector3hArrayTest, Construct)
+{
+  math::Vector3hArray empty;
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ(0u, empty.Size());
+  EXPECT_TRUE(empty.Bounds().Empty());
+
+  math::Vector3hArray zeros(4);
+  EXPECT_EQ(4u, zeros.Size());
+  for (std::size_t i = 0; i < zeros.Size(); ++i)
+    EXPECT_EQ(math::Vector3f::Zero, zeros[i]);
+
+  // Values that are exact in half precision.
+  std::vector<math::Vector3d> points = {{1, 2, 3}, {-0.5, 0.25, 1024},
+                                        {0, -7, 0.125}};
+  math::Vector3hArray packed(points);
+  ASSERT_EQ(3u, packed.Size());
+  EXPECT_EQ(math::Vector3f(1, 2, 3), packed[0]);
+  EXPECT_EQ(math::Vector3f(-0.5f, 0.25f, 1024), packed[1]);
+  EXPECT_EQ(math::Vector3f(0, -7, 0.125f), packed[2]);
+
+  // Interleaved layout.
+  EXPECT_EQ(0x3c00u, packed.Data()[0].Bits());
+  EXPECT_EQ(0x4000u, packed.Data()[1].Bits());
+  EXPECT_EQ(0x4200u, packed.Data()[2].Bits());
+
+  std::vector<math::Vector3d> copy;
+  packed.CopyTo(copy);
+  EXPECT_EQ(points, copy);
+
+  packed.Set(1, math::Vector3f(4, 5, 6));
+  EXPECT_EQ(math::Vector3f(4, 5, 6), packed[1]);
+  packed.PushBack(math::Vector3f(-1, -2, -3));
+  ASSERT_EQ(4u, packed.Size());
+  EXPECT_EQ(math::Vector3f(-1, -2, -3), packed[3]);
+
+  math::Vector3hArray other(packed);
+  EXPECT_EQ(packed, other);
+  other.Set(0, math::Vector3f(1, 2, 4));
+  EXPECT_NE(packed, other);
+
+  packed.Resize(6);
+  EXPECT_EQ(6u, packed.Size());
+  EXPECT_EQ(math::Vector3f::Zero, packed[5]);
+  packed.Reserve(100);
+  packed.Clear();
+  EXPECT_TRUE(packed.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3hArrayTest, Bulk)
+{
+  // More points than the conversion block, so that several blocks and a
+  // partial block are converted.
+  math::Rand::Seed(42);
+  std::vector<math::Vector3f> points;
+  for (int i = 0; i < 1000; ++i)
+  {
+    points.push_back(math::Vector3f(
+        static_cast<float>(math::Rand::DblUniform(-100, 100)),
+        static_cast<float>(math::Rand::DblUniform(-100, 100)),
+        static_cast<float>(math::Rand::DblUniform(0, 10))));
+  }
+
+  math::Vector3hArray packed(points);
+  ASSERT_EQ(points.size(), packed.Size());
+
+  math::AxisAlignedBox3f expectedBounds;
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    const math::Vector3f p = packed[i];
+    EXPECT_EQ(math::Half(points[i].X()).Float(), p.X());
+    EXPECT_EQ(math::Half(points[i].Y()).Float(), p.Y());
+    EXPECT_EQ(math::Half(points[i].Z()).Float(), p.Z());
+    EXPECT_NEAR(points[i].X(), p.X(), 0.04);
+    expectedBounds.Merge(p);
+  }
+  EXPECT_EQ(expectedBounds, packed.Bounds());
+
+  // Conversions through vectors and through interleaved floats agree.
+  std::vector<math::Vector3f> unpacked;
+  packed.CopyTo(unpacked);
+  std::vector<float> xyz(3 * packed.Size());
+  packed.CopyTo(xyz.data());
+  for (std::size_t i = 0; i < packed.Size(); ++i)
+  {
+    EXPECT_EQ(packed[i], unpacked[i]);
+    EXPECT_EQ(packed[i], math::Vector3f(xyz[3 * i], xyz[3 * i + 1],
+                                        xyz[3 * i + 2]));
+  }
+
+  math::Vector3hArray fromFloats;
+  fromFloats.Assign(xyz.data(), packed.Size());
+  EXPECT_EQ(packed, fromFloats);
+
+  math::Vector3hArray fromUnpacked;
+  fromUnpacked.Assign(unpacked);
+  EXPECT_EQ(packed, fromUnpacked);
+}
@@ -468,3 +468,24 @@ TEST(Vector4Test, NaN)
   EXPECT_EQ(math::Vector4f::Zero, nanVecF);
   EXPECT_TRUE(nanVecF.IsFinite());
 }
+
+/////////////////////////////////////////////////
+TEST(Vector4dTest, Constexpr)
+{
+  // The virtual destructor makes Vector4 a literal type only from C++20.
+#if __cplusplus >= 202002L
+  constexpr math::Vector4d v =
+    math::Vector4d(1, 2, 3, 4) + math::Vector4d(1, 1, 1, 1);
+  static_assert(static_cast<int>(v.X()) == 2 &&
+                static_cast<int>(v.W()) == 5, "");
+  static_assert(static_cast<int>(v.Sum()) == 14 &&
+                static_cast<int>(v.Max()) == 5 &&
+                static_cast<int>(v.Min()) == 2, "");
+  static_assert(static_cast<int>((v * 2.0 - v)[2]) == 4, "");
+#else
+  const math::Vector4d v = math::Vector4d(1, 2, 3, 4) + math::Vector4d::One;
+#endif
+  EXPECT_EQ(math::Vector4d(2, 3, 4, 5), v);
+  EXPECT_DOUBLE_EQ(14.0, v.Dot(math::Vector4d::One));
+  EXPECT_DOUBLE_EQ(14.0, v.Sum());
+}
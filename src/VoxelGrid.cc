@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gz/math/VoxelGrid.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Minimum number of rays for each thread of MarkRays.
+  constexpr std::size_t kMinRaysPerThread = 4096;
+
+  /// \brief Check that an endpoint can be traced.
+  /// \param[in] _point The endpoint.
+  /// \return True if all the coordinates are finite.
+  bool Traceable(const Vector3d &_point)
+  {
+    return std::isfinite(_point.X()) && std::isfinite(_point.Y()) &&
+           std::isfinite(_point.Z());
+  }
+
+  /// \brief Call a function on the linear index of each cell crossed by a
+  /// ray of a scan.
+  /// \param[in] _grid Grid to traverse.
+  /// \param[in] _origin Origin of the ray.
+  /// \param[in] _endpoint Endpoint of the ray.
+  /// \param[in] _maxRange Maximum length of the ray.
+  /// \param[in] _visit Function called with each linear index.
+  template<typename Visit>
+  void TraceRay(const VoxelGrid &_grid, const Vector3d &_origin,
+                const Vector3d &_endpoint, const double _maxRange,
+                const Visit &_visit)
+  {
+    const Vector3d dir = _endpoint - _origin;
+    const double length = std::min(dir.Length(), _maxRange);
+    for (VoxelTraversal it(_grid, _origin, dir, 0, length); it.Valid();
+         it.Next())
+    {
+      _visit(_grid.Index(it.Cell()));
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+VoxelGrid::VoxelGrid(const AxisAlignedBox &_bounds,
+                     const double _resolution)
+{
+  const Vector3d &min = _bounds.Min();
+  const Vector3d &max = _bounds.Max();
+  if (!(_resolution > 0) || !std::isfinite(_resolution) ||
+      !Traceable(min) || !Traceable(max))
+  {
+    return;
+  }
+
+  Vector3i cells;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (!(min[i] <= max[i]))
+      return;
+    const double count = std::ceil((max[i] - min[i]) / _resolution);
+    if (count >= static_cast<double>(std::numeric_limits<int>::max()))
+      return;
+    cells[i] = std::max(1, static_cast<int>(count));
+  }
+
+  this->origin = min;
+  this->resolution = _resolution;
+  this->counts = cells;
+}
+
+//////////////////////////////////////////////////
+bool VoxelGrid::Valid() const
+{
+  return this->resolution > 0;
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox VoxelGrid::Bounds() const
+{
+  if (!this->Valid())
+    return AxisAlignedBox();
+  return AxisAlignedBox(this->origin, this->origin + Vector3d(
+      this->counts.X(), this->counts.Y(), this->counts.Z()) *
+      this->resolution);
+}
+
+//////////////////////////////////////////////////
+double VoxelGrid::Resolution() const
+{
+  return this->resolution;
+}
+
+//////////////////////////////////////////////////
+const Vector3i &VoxelGrid::CellCounts() const
+{
+  return this->counts;
+}
+
+//////////////////////////////////////////////////
+std::size_t VoxelGrid::CellCount() const
+{
+  return static_cast<std::size_t>(this->counts.X()) *
+         static_cast<std::size_t>(this->counts.Y()) *
+         static_cast<std::size_t>(this->counts.Z());
+}
+
+//////////////////////////////////////////////////
+bool VoxelGrid::Cell(const Vector3d &_point, Vector3i &_cell) const
+{
+  if (!this->Valid())
+    return false;
+
+  Vector3i cell;
+  for (int i = 0; i < 3; ++i)
+  {
+    const double offset = (_point[i] - this->origin[i]) / this->resolution;
+    if (!(offset >= 0) || offset > this->counts[i])
+      return false;
+    cell[i] = std::min(static_cast<int>(offset), this->counts[i] - 1);
+  }
+  _cell = cell;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool VoxelGrid::Contains(const Vector3i &_cell) const
+{
+  return _cell.X() >= 0 && _cell.X() < this->counts.X() &&
+         _cell.Y() >= 0 && _cell.Y() < this->counts.Y() &&
+         _cell.Z() >= 0 && _cell.Z() < this->counts.Z();
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox VoxelGrid::CellBox(const Vector3i &_cell) const
+{
+  const Vector3d min = this->origin +
+      Vector3d(_cell.X(), _cell.Y(), _cell.Z()) * this->resolution;
+  return AxisAlignedBox(min, min + Vector3d::One * this->resolution);
+}
+
+//////////////////////////////////////////////////
+void VoxelGrid::MarkRays(const Vector3d &_origin,
+                         const std::vector<Vector3d> &_endpoints,
+                         const double _maxRange,
+                         std::vector<uint8_t> &_marks) const
+{
+  this->MarkRays(_origin, _endpoints, _maxRange, _marks, 1);
+}
+
+//////////////////////////////////////////////////
+void VoxelGrid::MarkRays(const Vector3d &_origin,
+                         const std::vector<Vector3d> &_endpoints,
+                         const double _maxRange,
+                         std::vector<uint8_t> &_marks,
+                         const unsigned int _threads) const
+{
+  _marks.assign(this->CellCount(), kUnknown);
+  if (!this->Valid() || !Traceable(_origin))
+    return;
+
+  unsigned int threads = _threads;
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = static_cast<unsigned int>(std::max<std::size_t>(1,
+      std::min<std::size_t>(threads, _endpoints.size() / kMinRaysPerThread)));
+
+  if (threads == 1)
+  {
+    for (const auto &endpoint : _endpoints)
+    {
+      if (Traceable(endpoint))
+      {
+        TraceRay(*this, _origin, endpoint, _maxRange,
+                 [&_marks](const std::size_t _index)
+                 {
+                   _marks[_index] = kFree;
+                 });
+      }
+    }
+  }
+  else
+  {
+    // Each thread lists the cells of its rays, which are then marked in
+    // order, so that no two threads write to the same mark.
+    std::vector<std::vector<std::size_t>> freeCells(threads);
+    auto trace = [&](const unsigned int _t)
+    {
+      const std::size_t begin = _endpoints.size() * _t / threads;
+      const std::size_t end = _endpoints.size() * (_t + 1) / threads;
+      auto &cells = freeCells[_t];
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        if (Traceable(_endpoints[i]))
+        {
+          TraceRay(*this, _origin, _endpoints[i], _maxRange,
+                   [&cells](const std::size_t _index)
+                   {
+                     cells.push_back(_index);
+                   });
+        }
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int t = 1; t < threads; ++t)
+      workers.emplace_back(trace, t);
+    trace(0);
+    for (auto &worker : workers)
+      worker.join();
+
+    for (const auto &cells : freeCells)
+    {
+      for (const std::size_t index : cells)
+        _marks[index] = kFree;
+    }
+  }
+
+  // Occupied cells take precedence over the free ones.
+  Vector3i cell;
+  for (const auto &endpoint : _endpoints)
+  {
+    if (Traceable(endpoint) &&
+        endpoint.Distance(_origin) <= _maxRange &&
+        this->Cell(endpoint, cell))
+    {
+      _marks[this->Index(cell)] = kOccupied;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+VoxelTraversal::VoxelTraversal(const VoxelGrid &_grid,
+                               const Vector3d &_origin,
+                               const Vector3d &_dir,
+                               const double _min, const double _max)
+: grid(&_grid)
+{
+  const double length = _dir.Length();
+  this->Start(_origin, length > 0 ? _dir / length : Vector3d::Zero,
+              _min, _max);
+}
+
+//////////////////////////////////////////////////
+VoxelTraversal::VoxelTraversal(const VoxelGrid &_grid,
+                               const Line3d &_segment)
+: grid(&_grid)
+{
+  const Vector3d dir = _segment[1] - _segment[0];
+  const double length = dir.Length();
+  this->Start(_segment[0], length > 0 ? dir / length : Vector3d::Zero,
+              0, length);
+}
+
+//////////////////////////////////////////////////
+void VoxelTraversal::Start(const Vector3d &_origin, const Vector3d &_dir,
+                           const double _min, const double _max)
+{
+  if (!this->grid->Valid() || !Traceable(_origin) || !Traceable(_dir) ||
+      std::isnan(_min) || std::isnan(_max))
+  {
+    return;
+  }
+
+  // Clip the ray to the bounds of the grid.
+  const AxisAlignedBox bounds = this->grid->Bounds();
+  const Vector3d &lower = bounds.Min();
+  const Vector3d &upper = bounds.Max();
+  double t0 = _min;
+  double t1 = _max;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (std::abs(_dir[i]) <= 0)
+    {
+      if (_origin[i] < lower[i] || _origin[i] > upper[i])
+        return;
+      continue;
+    }
+    double ta = (lower[i] - _origin[i]) / _dir[i];
+    double tb = (upper[i] - _origin[i]) / _dir[i];
+    if (ta > tb)
+      std::swap(ta, tb);
+    t0 = std::max(t0, ta);
+    t1 = std::min(t1, tb);
+  }
+  if (t0 > t1 || !std::isfinite(t0))
+    return;
+
+  const double resolution = this->grid->Resolution();
+  const Vector3i &counts = this->grid->CellCounts();
+  const Vector3d start = _origin + _dir * t0;
+  for (int i = 0; i < 3; ++i)
+  {
+    // Rounding may put the clipped start just outside of the grid.
+    const double offset = std::floor((start[i] - lower[i]) / resolution);
+    this->cell[i] = static_cast<int>(std::min<double>(
+        std::max(offset, 0.0), counts[i] - 1));
+
+    if (_dir[i] > 0)
+    {
+      this->step[i] = 1;
+      this->tMax[i] = (lower[i] + (this->cell[i] + 1) * resolution -
+                       _origin[i]) / _dir[i];
+      this->tDelta[i] = resolution / _dir[i];
+    }
+    else if (_dir[i] < 0)
+    {
+      this->step[i] = -1;
+      this->tMax[i] = (lower[i] + this->cell[i] * resolution -
+                       _origin[i]) / _dir[i];
+      this->tDelta[i] = -resolution / _dir[i];
+    }
+    else
+    {
+      this->step[i] = 0;
+      this->tMax[i] = std::numeric_limits<double>::infinity();
+      this->tDelta[i] = std::numeric_limits<double>::infinity();
+    }
+  }
+
+  this->entry = t0;
+  this->end = t1;
+  this->valid = true;
+}
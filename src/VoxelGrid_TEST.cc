@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gz/math/Helpers.hh"
+#include "gz/math/VoxelGrid.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Collect the cells visited by a traversal.
+/// \param[in] _it Traversal, at its first cell.
+/// \return Coordinates of the cells, in order.
+static std::vector<Vector3i> Cells(VoxelTraversal _it)
+{
+  std::vector<Vector3i> cells;
+  for (; _it.Valid(); _it.Next())
+    cells.push_back(_it.Cell());
+  return cells;
+}
+
+/////////////////////////////////////////////////
+TEST(VoxelGridTest, Grid)
+{
+  const VoxelGrid grid(AxisAlignedBox(Vector3d(0, -1, 1),
+                                      Vector3d(1, 1, 4.05)), 0.5);
+  ASSERT_TRUE(grid.Valid());
+  EXPECT_DOUBLE_EQ(0.5, grid.Resolution());
+  EXPECT_EQ(Vector3i(2, 4, 7), grid.CellCounts());
+  EXPECT_EQ(56u, grid.CellCount());
+  EXPECT_EQ(AxisAlignedBox(Vector3d(0, -1, 1), Vector3d(1, 1, 4.5)),
+            grid.Bounds());
+
+  Vector3i cell;
+  EXPECT_TRUE(grid.Cell(Vector3d(0.7, -0.2, 1.1), cell));
+  EXPECT_EQ(Vector3i(1, 1, 0), cell);
+  EXPECT_EQ(1u + 2u * (1u + 4u * 0u), grid.Index(cell));
+  EXPECT_EQ(AxisAlignedBox(Vector3d(0.5, -0.5, 1), Vector3d(1, 0, 1.5)),
+            grid.CellBox(cell));
+
+  // Boundaries belong to the upper cell, except at the top of the grid.
+  EXPECT_TRUE(grid.Cell(Vector3d(0.5, -1, 4.5), cell));
+  EXPECT_EQ(Vector3i(1, 0, 6), cell);
+  EXPECT_EQ(grid.CellCount() - 7u, grid.Index(cell));
+
+  cell.Set(9, 9, 9);
+  EXPECT_FALSE(grid.Cell(Vector3d(1.1, 0, 2), cell));
+  EXPECT_FALSE(grid.Cell(Vector3d(0.5, 0, 0.9), cell));
+  EXPECT_FALSE(grid.Cell(
+        Vector3d(std::numeric_limits<double>::quiet_NaN(), 0, 2), cell));
+  EXPECT_EQ(Vector3i(9, 9, 9), cell);
+
+  EXPECT_TRUE(grid.Contains(Vector3i(0, 0, 0)));
+  EXPECT_TRUE(grid.Contains(Vector3i(1, 3, 6)));
+  EXPECT_FALSE(grid.Contains(Vector3i(2, 3, 6)));
+  EXPECT_FALSE(grid.Contains(Vector3i(0, -1, 0)));
+
+  // A flat box has one layer of cells.
+  const VoxelGrid flat(AxisAlignedBox(Vector3d(0, 0, 0),
+                                      Vector3d(2, 2, 0)), 1.0);
+  EXPECT_EQ(Vector3i(2, 2, 1), flat.CellCounts());
+
+  // Invalid grids.
+  EXPECT_FALSE(VoxelGrid().Valid());
+  EXPECT_EQ(0u, VoxelGrid().CellCount());
+  EXPECT_FALSE(VoxelGrid(AxisAlignedBox(), 1.0).Valid());
+  EXPECT_FALSE(VoxelGrid(grid.Bounds(), 0.0).Valid());
+  EXPECT_FALSE(VoxelGrid(grid.Bounds(), -1.0).Valid());
+  EXPECT_FALSE(VoxelGrid(grid.Bounds(),
+      std::numeric_limits<double>::infinity()).Valid());
+  EXPECT_FALSE(VoxelGrid(grid.Bounds(), 1e-12).Valid());
+  EXPECT_FALSE(VoxelGrid().Cell(Vector3d::Zero, cell));
+}
+
+/////////////////////////////////////////////////
+TEST(VoxelGridTest, TraverseAxis)
+{
+  const VoxelGrid grid(AxisAlignedBox(Vector3d(0, 0, 0),
+                                      Vector3d(4, 4, 4)), 1.0);
+
+  // Along X, entering the grid from outside.
+  VoxelTraversal it(grid, Vector3d(-1, 0.5, 2.5), Vector3d(2, 0, 0), 0, 10);
+  for (int i = 0; i < 4; ++i)
+  {
+    ASSERT_TRUE(it.Valid());
+    EXPECT_EQ(Vector3i(i, 0, 2), it.Cell());
+    EXPECT_DOUBLE_EQ(i + 1.0, it.Entry());
+    EXPECT_DOUBLE_EQ(i + 2.0, it.Exit());
+    EXPECT_EQ(i < 3, it.Next());
+  }
+  EXPECT_FALSE(it.Valid());
+  EXPECT_FALSE(it.Next());
+
+  // Backwards along Y, stopping inside of the grid.
+  const std::vector<Vector3i> cells = Cells(VoxelTraversal(grid,
+      Vector3d(1.5, 3.5, 0.5), -Vector3d::UnitY, 0, 2.2));
+  ASSERT_EQ(3u, cells.size());
+  EXPECT_EQ(Vector3i(1, 3, 0), cells[0]);
+  EXPECT_EQ(Vector3i(1, 1, 0), cells[2]);
+
+  // The range can start past the origin.
+  VoxelTraversal late(grid, Vector3d(0.5, 0.5, 0.5), Vector3d::UnitZ,
+                      1.5, 2.5);
+  ASSERT_TRUE(late.Valid());
+  EXPECT_EQ(Vector3i(0, 0, 2), late.Cell());
+  EXPECT_DOUBLE_EQ(1.5, late.Entry());
+  EXPECT_DOUBLE_EQ(2.5, late.Exit());
+  // The range ends on the boundary of the next cell, which isn't visited.
+  EXPECT_FALSE(late.Next());
+
+  // A zero direction visits the cell of the origin.
+  const std::vector<Vector3i> still = Cells(VoxelTraversal(grid,
+      Vector3d(2.5, 1.5, 0.5), Vector3d::Zero, 0, 10));
+  ASSERT_EQ(1u, still.size());
+  EXPECT_EQ(Vector3i(2, 1, 0), still[0]);
+
+  // Misses.
+  EXPECT_FALSE(VoxelTraversal(grid, Vector3d(-1, 0.5, 0.5),
+                              -Vector3d::UnitX, 0, 10).Valid());
+  EXPECT_FALSE(VoxelTraversal(grid, Vector3d(-1, 0.5, 0.5),
+                              Vector3d::UnitX, 0, 0.5).Valid());
+  EXPECT_FALSE(VoxelTraversal(grid, Vector3d(-1, 5, 0.5),
+                              Vector3d::UnitX, 0, 10).Valid());
+  EXPECT_FALSE(VoxelTraversal(VoxelGrid(), Vector3d::Zero,
+                              Vector3d::UnitX, 0, 10).Valid());
+}
+
+/////////////////////////////////////////////////
+TEST(VoxelGridTest, TraverseSegment)
+{
+  const VoxelGrid grid(AxisAlignedBox(Vector3d(-2, -2, -2),
+                                      Vector3d(2, 2, 2)), 0.5);
+  const Line3d segment(Vector3d(-1.9, -1.9, 0.1), Vector3d(0.8, 0.3, 0.1));
+  const std::vector<Vector3i> cells = Cells(VoxelTraversal(grid, segment));
+  ASSERT_FALSE(cells.empty());
+
+  Vector3i first, last;
+  ASSERT_TRUE(grid.Cell(segment[0], first));
+  ASSERT_TRUE(grid.Cell(segment[1], last));
+  EXPECT_EQ(first, cells.front());
+  EXPECT_EQ(last, cells.back());
+  // Each step crosses a face, moving by one cell along X or Y.
+  EXPECT_EQ(static_cast<std::size_t>((last - first).Abs().Sum() + 1),
+            cells.size());
+}
+
+/////////////////////////////////////////////////
+TEST(VoxelGridTest, TraverseRandom)
+{
+  const VoxelGrid grid(AxisAlignedBox(Vector3d(-1, -2, 0),
+                                      Vector3d(3, 1, 2)), 0.25);
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> coord(-3, 4);
+
+  for (int r = 0; r < 200; ++r)
+  {
+    const Vector3d origin(coord(rng), coord(rng), coord(rng));
+    const Vector3d dir =
+        (Vector3d(coord(rng), coord(rng), coord(rng)) - origin).Normalize();
+    const double range = 8;
+
+    std::vector<Vector3i> cells;
+    double previousExit = 0;
+    for (VoxelTraversal it(grid, origin, dir, 0, range); it.Valid();
+         it.Next())
+    {
+      EXPECT_TRUE(grid.Contains(it.Cell()));
+      EXPECT_LE(it.Entry(), it.Exit());
+      if (!cells.empty())
+      {
+        // Consecutive cells share a face, and the intervals are
+        // contiguous.
+        EXPECT_EQ(1, (it.Cell() - cells.back()).Abs().Sum());
+        EXPECT_DOUBLE_EQ(previousExit, it.Entry());
+      }
+      cells.push_back(it.Cell());
+      previousExit = it.Exit();
+    }
+
+    // Every cell of points sampled along the ray is visited.
+    std::set<std::size_t> visited;
+    for (const auto &cell : cells)
+      visited.insert(grid.Index(cell));
+    for (int s = 1; s < 1000; ++s)
+    {
+      Vector3i cell;
+      if (grid.Cell(origin + dir * (range * s / 1000.0), cell))
+      {
+        EXPECT_EQ(1u, visited.count(grid.Index(cell)));
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(VoxelGridTest, MarkRays)
+{
+  const VoxelGrid grid(AxisAlignedBox(Vector3d(0, 0, 0),
+                                      Vector3d(10, 10, 1)), 1.0);
+  const Vector3d origin(0.5, 0.5, 0.5);
+  const std::vector<Vector3d> endpoints = {
+    Vector3d(5.5, 0.5, 0.5),
+    Vector3d(0.5, 20, 0.5),
+    Vector3d(std::numeric_limits<double>::quiet_NaN(), 0, 0),
+    Vector3d(2.5, 0.5, 0.5)};
+
+  std::vector<uint8_t> marks(3, 7);
+  grid.MarkRays(origin, endpoints, 6.0, marks);
+  ASSERT_EQ(grid.CellCount(), marks.size());
+
+  auto mark = [&](const int _x, const int _y)
+  {
+    return marks[grid.Index(Vector3i(_x, _y, 0))];
+  };
+  // The first ray frees the cells before its endpoint, except the one of
+  // the endpoint of the last ray.
+  EXPECT_EQ(VoxelGrid::kFree, mark(0, 0));
+  EXPECT_EQ(VoxelGrid::kFree, mark(1, 0));
+  EXPECT_EQ(VoxelGrid::kOccupied, mark(2, 0));
+  EXPECT_EQ(VoxelGrid::kFree, mark(4, 0));
+  EXPECT_EQ(VoxelGrid::kOccupied, mark(5, 0));
+  EXPECT_EQ(VoxelGrid::kUnknown, mark(6, 0));
+
+  // The second ray is cut at the maximum range, without an endpoint.
+  EXPECT_EQ(VoxelGrid::kFree, mark(0, 6));
+  EXPECT_EQ(VoxelGrid::kUnknown, mark(0, 7));
+  EXPECT_EQ(VoxelGrid::kUnknown, mark(0, 9));
+
+  EXPECT_EQ(VoxelGrid::kUnknown, mark(5, 5));
+
+  // An invalid grid has no marks.
+  VoxelGrid().MarkRays(origin, endpoints, 6.0, marks);
+  EXPECT_TRUE(marks.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(VoxelGridTest, MarkRaysThreads)
+{
+  const VoxelGrid grid(AxisAlignedBox(Vector3d(-5, -5, -1),
+                                      Vector3d(5, 5, 3)), 0.1);
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> angle(-IGN_PI, IGN_PI);
+  std::uniform_real_distribution<double> range(0.5, 7);
+  std::uniform_real_distribution<double> height(-1.5, 3);
+
+  std::vector<Vector3d> endpoints;
+  for (int i = 0; i < 30000; ++i)
+  {
+    const double a = angle(rng);
+    const double r = range(rng);
+    endpoints.emplace_back(r * std::cos(a), r * std::sin(a), height(rng));
+  }
+
+  const Vector3d origin(0.05, -0.02, 1.0);
+  std::vector<uint8_t> single;
+  grid.MarkRays(origin, endpoints, 6.0, single);
+  for (const unsigned int threads : {0u, 2u, 3u})
+  {
+    std::vector<uint8_t> marks;
+    grid.MarkRays(origin, endpoints, 6.0, marks, threads);
+    EXPECT_EQ(single, marks);
+  }
+
+  std::size_t occupied = 0;
+  for (const uint8_t mark : single)
+    occupied += mark == VoxelGrid::kOccupied;
+  EXPECT_GT(occupied, 1000u);
+}
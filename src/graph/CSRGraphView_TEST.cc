@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gz/math/MappedFile.hh"
+#include "gz/math/graph/CSRGraph.hh"
+#include "gz/math/graph/CSRGraphView.hh"
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+
+using namespace gz;
+using namespace math;
+using namespace graph;
+
+/// \brief A vertex record.
+struct Position
+{
+  double x;
+  double y;
+};
+
+/////////////////////////////////////////////////
+/// \brief Write a graph to a buffer aligned like a mapped file.
+/// \param[in] _graph The graph.
+/// \param[out] _buffer 8 byte words holding the stored graph.
+/// \param[in] _vertexData Vertex records, or empty.
+/// \param[in] _arcData Arc records, or empty.
+/// \return Number of bytes of the stored graph.
+template<typename VD = char, typename AD = char>
+std::size_t Store(const CSRGraph &_graph, std::vector<uint64_t> &_buffer,
+                  const std::vector<VD> &_vertexData = {},
+                  const std::vector<AD> &_arcData = {})
+{
+  std::ostringstream out;
+  EXPECT_TRUE(CSRGraphView::Write(out, _graph, _vertexData, _arcData));
+  const std::string bytes = out.str();
+  _buffer.assign(bytes.size() / sizeof(uint64_t) + 1, 0);
+  std::memcpy(_buffer.data(), bytes.data(), bytes.size());
+  return bytes.size();
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that a view holds the same graph as a CSRGraph.
+/// \param[in] _graph The graph.
+/// \param[in] _view The view.
+void ExpectEqual(const CSRGraph &_graph, const CSRGraphView &_view)
+{
+  ASSERT_TRUE(_view.IsOpen());
+  EXPECT_TRUE(_view.Validate());
+  ASSERT_EQ(_graph.VertexCount(), _view.VertexCount());
+  ASSERT_EQ(_graph.ArcCount(), _view.ArcCount());
+  EXPECT_EQ(_graph.Empty(), _view.Empty());
+  EXPECT_EQ(_graph.Directed(), _view.Directed());
+  for (CSRIndex i = 0; i < _graph.VertexCount(); ++i)
+  {
+    EXPECT_EQ(_graph.Ids()[i], _view.Ids()[i]);
+    EXPECT_EQ(i, _view.Index(_graph.Id(i)));
+    EXPECT_EQ(_graph.Id(i), _view.Id(i));
+    EXPECT_EQ(_graph.OutDegree(i), _view.OutDegree(i));
+  }
+  for (CSRIndex i = 0; i <= _graph.VertexCount(); ++i)
+    EXPECT_EQ(_graph.Offsets()[i], _view.Offsets()[i]);
+  for (CSRIndex arc = 0; arc < _graph.ArcCount(); ++arc)
+  {
+    EXPECT_EQ(_graph.Targets()[arc], _view.Targets()[arc]);
+    EXPECT_DOUBLE_EQ(_graph.Weights()[arc], _view.Weights()[arc]);
+    EXPECT_EQ(_graph.EdgeIds()[arc], _view.EdgeIds()[arc]);
+  }
+  EXPECT_EQ(kNullId, _view.Id(_graph.VertexCount()));
+  EXPECT_EQ(0u, _view.OutDegree(_graph.VertexCount()));
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphViewTest, RoundTrip)
+{
+  // Sparse vertex Ids, so Index() searches the Ids.
+  UndirectedGraph<int, double> graph(
+  {
+    {{"A", 0, 2}, {"B", 1, 5}, {"C", 2, 9}, {"D", 3, 12}},
+    {{{2, 5}, 0.0, 1.5}, {{5, 9}, 0.0, 2.0}, {{2, 9}, 0.0, 4.0}}
+  });
+  const CSRGraph csr(graph);
+
+  std::vector<uint64_t> buffer;
+  const std::size_t size = Store(csr, buffer);
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(buffer.data());
+
+  CSRGraphView view;
+  EXPECT_FALSE(view.IsOpen());
+  EXPECT_FALSE(view.Validate());
+  ASSERT_TRUE(view.Open(data, size));
+  ExpectEqual(csr, view);
+  EXPECT_EQ(kNullIndex, view.Index(3));
+  EXPECT_EQ(kNullIndex, view.Index(99));
+  EXPECT_EQ(0u, view.VertexDataSize());
+  EXPECT_EQ(nullptr, view.VertexData<Position>());
+  EXPECT_EQ(nullptr, view.ArcData<double>());
+
+  // The algorithms run on the stored arrays.
+  SearchWorkspace workspace;
+  std::vector<VertexId> visited;
+  std::vector<VertexId> expected;
+  BreadthFirstSort(view, 2, workspace, visited);
+  BreadthFirstSort(csr, 2, workspace, expected);
+  EXPECT_EQ(expected, visited);
+  DepthFirstSort(view, 9, workspace, visited);
+  DepthFirstSort(csr, 9, workspace, expected);
+  EXPECT_EQ(expected, visited);
+
+  ASSERT_TRUE(Dijkstra(view, 2, workspace));
+  std::vector<VertexId> path;
+  EXPECT_DOUBLE_EQ(3.5, workspace.Path(view, 9, path));
+  EXPECT_EQ(std::vector<VertexId>({2, 5, 9}), path);
+  EXPECT_DOUBLE_EQ(MAX_D, workspace.Path(view, 12, path));
+  EXPECT_FALSE(Dijkstra(view, 3, workspace));
+
+  ASSERT_TRUE(Dijkstra(view, {2, 12}, workspace, {9}));
+  EXPECT_DOUBLE_EQ(3.5, workspace.Path(view, 9, path));
+
+  view.Close();
+  EXPECT_FALSE(view.IsOpen());
+  EXPECT_EQ(0u, view.VertexCount());
+
+  // Empty graph.
+  const std::size_t emptySize = Store(CSRGraph(), buffer);
+  ASSERT_TRUE(view.Open(data, emptySize));
+  ExpectEqual(CSRGraph(), view);
+  EXPECT_FALSE(Dijkstra(view, 0, workspace));
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphViewTest, Records)
+{
+  // Dense vertex Ids, so Index() is O(1).
+  const CSRGraph csr(3, {{0, 1}, {1, 2}, {2, 0}}, {1.0, 2.0, 3.0}, true);
+  const std::vector<Position> positions = {{0, 0}, {1, 0}, {1, 1}};
+  const std::vector<uint16_t> lanes = {1, 2, 3};
+
+  std::vector<uint64_t> buffer;
+  const std::size_t size = Store(csr, buffer, positions, lanes);
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(buffer.data());
+
+  CSRGraphView view;
+  ASSERT_TRUE(view.Open(data, size));
+  ExpectEqual(csr, view);
+  EXPECT_EQ(kNullIndex, view.Index(3));
+
+  EXPECT_EQ(sizeof(Position), view.VertexDataSize());
+  EXPECT_EQ(sizeof(uint16_t), view.ArcDataSize());
+  EXPECT_EQ(nullptr, view.VertexData<double>());
+  EXPECT_EQ(nullptr, view.ArcData<uint32_t>());
+  const Position *storedPositions = view.VertexData<Position>();
+  ASSERT_NE(nullptr, storedPositions);
+  for (std::size_t i = 0; i < positions.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(positions[i].x, storedPositions[i].x);
+    EXPECT_DOUBLE_EQ(positions[i].y, storedPositions[i].y);
+  }
+  const uint16_t *storedLanes = view.ArcData<uint16_t>();
+  ASSERT_NE(nullptr, storedLanes);
+  for (CSRIndex arc = 0; arc < view.ArcCount(); ++arc)
+    EXPECT_EQ(lanes[view.EdgeIds()[arc]], storedLanes[arc]);
+
+  // Only vertex records.
+  const std::size_t vertexOnly =
+    Store(csr, buffer, positions, std::vector<char>());
+  ASSERT_TRUE(view.Open(data, vertexOnly));
+  EXPECT_NE(nullptr, view.VertexData<Position>());
+  EXPECT_EQ(0u, view.ArcDataSize());
+
+  // Records must match the vertices and arcs.
+  std::ostringstream out;
+  EXPECT_FALSE(CSRGraphView::Write(out, csr, std::vector<Position>(2),
+                                   lanes));
+  EXPECT_FALSE(CSRGraphView::Write(out, csr, positions,
+                                   std::vector<uint16_t>(4)));
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphViewTest, Invalid)
+{
+  const CSRGraph csr(4, {{0, 1}, {1, 2}, {2, 3}}, {1.0, 1.0, 1.0});
+  std::vector<uint64_t> buffer;
+  const std::size_t size = Store(csr, buffer);
+  uint8_t *data = reinterpret_cast<uint8_t *>(buffer.data());
+
+  CSRGraphView view;
+  EXPECT_FALSE(view.Open(nullptr, size));
+  EXPECT_FALSE(view.Open(data, 63));
+  EXPECT_FALSE(view.IsOpen());
+
+  // Truncated arrays.
+  EXPECT_FALSE(view.Open(data, size - 1));
+
+  // Misaligned memory.
+  std::vector<uint64_t> shifted(buffer.size() + 1);
+  uint8_t *shiftedData = reinterpret_cast<uint8_t *>(shifted.data()) + 4;
+  std::memcpy(shiftedData, data, size);
+  EXPECT_FALSE(view.Open(shiftedData, size));
+
+  // Bad magic and version.
+  data[0] = 'X';
+  EXPECT_FALSE(view.Open(data, size));
+  data[0] = 'G';
+  data[8] = 2;
+  EXPECT_FALSE(view.Open(data, size));
+  data[8] = 1;
+  ASSERT_TRUE(view.Open(data, size));
+  EXPECT_TRUE(view.Validate());
+
+  // Open() trusts the arrays, Validate() checks them.
+  CSRIndex *targets = const_cast<CSRIndex *>(view.Targets());
+  targets[0] = 7;
+  ASSERT_TRUE(view.Open(data, size));
+  EXPECT_FALSE(view.Validate());
+  targets[0] = 1;
+  EXPECT_TRUE(view.Validate());
+
+  // Offsets that don't cover the arcs.
+  CSRIndex *offsets = const_cast<CSRIndex *>(view.Offsets());
+  offsets[0] = 1;
+  EXPECT_FALSE(view.Open(data, size));
+  EXPECT_FALSE(view.IsOpen());
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphViewTest, MappedFile)
+{
+  // A grid graph, stored in a file and queried in place.
+  const CSRIndex width = 20;
+  std::vector<std::pair<CSRIndex, CSRIndex>> edges;
+  std::vector<double> weights;
+  for (CSRIndex i = 0; i < width * width; ++i)
+  {
+    if (i % width + 1 < width)
+    {
+      edges.push_back({i, i + 1});
+      weights.push_back(1.0 + (i % 3));
+    }
+    if (i + width < width * width)
+    {
+      edges.push_back({i, i + width});
+      weights.push_back(1.0 + (i % 5));
+    }
+  }
+  const CSRGraph csr(width * width, edges, weights);
+
+  const std::string path = testing::TempDir() + "CSRGraphView_TEST_grid";
+  {
+    std::ofstream out(path, std::ios::binary);
+    ASSERT_TRUE(CSRGraphView::Write(out, csr));
+  }
+
+  MappedFile file;
+  ASSERT_TRUE(file.Open(path));
+  CSRGraphView view;
+  ASSERT_TRUE(view.Open(file.Data(), file.Size()));
+  ExpectEqual(csr, view);
+
+  SearchWorkspace workspace;
+  const auto expected = Dijkstra(csr, 0);
+  ASSERT_TRUE(Dijkstra(view, 0, workspace));
+  for (CSRIndex i = 0; i < view.VertexCount(); ++i)
+    EXPECT_DOUBLE_EQ(expected[i].first, workspace.Cost(i));
+
+  view.Close();
+  file.Close();
+  std::remove(path.c_str());
+}
@@ -0,0 +1,999 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gz/math/graph/CSRGraph.hh"
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+#include "gz/math/graph/SearchStats.hh"
+#include "gz/math/graph/SearchWorkspace.hh"
+
+using namespace gz;
+using namespace math;
+using namespace graph;
+
+// Define a test fixture class template.
+template <class T>
+class CSRGraphTestFixture : public testing::Test
+{
+};
+
+// The list of graphs we want to test.
+using GraphTypes = ::testing::Types<DirectedGraph<int, double>,
+                                    UndirectedGraph<int, double>>;
+TYPED_TEST_CASE(CSRGraphTestFixture, GraphTypes);
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, Empty)
+{
+  CSRGraph empty;
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ(0u, empty.VertexCount());
+  EXPECT_EQ(0u, empty.ArcCount());
+  ASSERT_EQ(1u, empty.Offsets().size());
+  EXPECT_EQ(kNullIndex, empty.Index(0));
+  EXPECT_EQ(kNullId, empty.Id(0));
+  EXPECT_EQ(0u, empty.OutDegree(0));
+
+  CSRGraph fromEmpty{UndirectedGraph<int, double>()};
+  EXPECT_TRUE(fromEmpty.Empty());
+  EXPECT_FALSE(fromEmpty.Directed());
+  EXPECT_TRUE(BreadthFirstSort(fromEmpty, 0).empty());
+  EXPECT_TRUE(DepthFirstSort(fromEmpty, 0).empty());
+  EXPECT_TRUE(Dijkstra(fromEmpty, 0).empty());
+  EXPECT_TRUE(ConnectedComponents(fromEmpty).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, Directed)
+{
+  // Sparse vertex ids, a parallel edge and a self loop.
+  DirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"A", 0, 10}, {"B", 1, 20}, {"C", 2, 30}, {"D", 3, 40}},
+    // Edges.
+    {{{10, 30}, 0, 3.0}, {{10, 20}, 0, 2.0}, {{10, 20}, 0, 1.5},
+     {{20, 20}, 0, 1.0}, {{30, 40}, 0, 2.0}}
+  });
+
+  CSRGraph csr(graph);
+  EXPECT_TRUE(csr.Directed());
+  EXPECT_FALSE(csr.Empty());
+  ASSERT_EQ(4u, csr.VertexCount());
+  EXPECT_EQ(5u, csr.ArcCount());
+
+  std::vector<VertexId> ids = {10, 20, 30, 40};
+  EXPECT_EQ(ids, csr.Ids());
+  for (CSRIndex i = 0; i < ids.size(); ++i)
+  {
+    EXPECT_EQ(i, csr.Index(ids[i]));
+    EXPECT_EQ(ids[i], csr.Id(i));
+  }
+  EXPECT_EQ(kNullIndex, csr.Index(0));
+  EXPECT_EQ(kNullIndex, csr.Index(25));
+  EXPECT_EQ(kNullId, csr.Id(4));
+
+  std::vector<CSRIndex> offsets = {0, 3, 4, 5, 5};
+  EXPECT_EQ(offsets, csr.Offsets());
+  EXPECT_EQ(3u, csr.OutDegree(0));
+  EXPECT_EQ(1u, csr.OutDegree(1));
+  EXPECT_EQ(0u, csr.OutDegree(3));
+
+  // Rows are sorted by target; parallel arcs keep the edge order.
+  std::vector<CSRIndex> targets = {1, 1, 2, 1, 3};
+  EXPECT_EQ(targets, csr.Targets());
+  std::vector<double> weights = {2.0, 1.5, 3.0, 1.0, 2.0};
+  EXPECT_EQ(weights, csr.Weights());
+  std::vector<EdgeId> edgeIds = {1, 2, 0, 3, 4};
+  EXPECT_EQ(edgeIds, csr.EdgeIds());
+
+  // The parallel edge with the smaller weight is used.
+  auto res = Dijkstra(csr, 10);
+  ASSERT_EQ(4u, res.size());
+  EXPECT_DOUBLE_EQ(0.0, res[csr.Index(10)].first);
+  EXPECT_EQ(10u, res[csr.Index(10)].second);
+  EXPECT_DOUBLE_EQ(1.5, res[csr.Index(20)].first);
+  EXPECT_EQ(10u, res[csr.Index(20)].second);
+  EXPECT_DOUBLE_EQ(5.0, res[csr.Index(40)].first);
+  EXPECT_EQ(30u, res[csr.Index(40)].second);
+
+  // Unreachable vertex.
+  res = Dijkstra(csr, 40);
+  EXPECT_DOUBLE_EQ(MAX_D, res[csr.Index(10)].first);
+  EXPECT_EQ(kNullId, res[csr.Index(10)].second);
+
+  // Directed graphs have no connected components.
+  EXPECT_TRUE(ConnectedComponents(csr).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, Undirected)
+{
+  UndirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}},
+    // Edges.
+    {{{0, 1}, 0, 2.0}, {{2, 2}, 0, 1.0}}
+  });
+
+  CSRGraph csr(graph);
+  EXPECT_FALSE(csr.Directed());
+  EXPECT_EQ(3u, csr.VertexCount());
+
+  // Each edge is stored in both directions, except the self loop.
+  EXPECT_EQ(3u, csr.ArcCount());
+  std::vector<CSRIndex> offsets = {0, 1, 2, 3};
+  EXPECT_EQ(offsets, csr.Offsets());
+  std::vector<CSRIndex> targets = {1, 0, 2};
+  EXPECT_EQ(targets, csr.Targets());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(CSRGraphTestFixture, Traversals)
+{
+  TypeParam graph(
+  {
+    // Vertices.
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}, {"D", 3, 3}, {"E", 4, 4},
+     {"F", 5, 5}, {"G", 6, 6}},
+    // Edges.
+    {{{0, 1}, 2.0}, {{0, 2}, 3.0}, {{0, 4}, 4.0},
+     {{1, 3}, 2.0}, {{1, 5}, 3.0}, {{2, 6}, 4.0},
+     {{5, 4}, 2.0}}
+  });
+
+  CSRGraph csr(graph);
+
+  // Same results as the algorithms running on the original graph.
+  for (VertexId v = 0; v < 7; ++v)
+  {
+    EXPECT_EQ(BreadthFirstSort(graph, v), BreadthFirstSort(csr, v));
+    EXPECT_EQ(DepthFirstSort(graph, v), DepthFirstSort(csr, v));
+  }
+
+  std::vector<VertexId> expected = {0, 1, 2, 4, 3, 5, 6};
+  EXPECT_EQ(expected, BreadthFirstSort(csr, 0));
+
+  // Inexistent vertex.
+  EXPECT_TRUE(BreadthFirstSort(csr, 99).empty());
+  EXPECT_TRUE(DepthFirstSort(csr, 99).empty());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(CSRGraphTestFixture, Dijkstra)
+{
+  TypeParam graph(
+  {
+    // Vertices.
+    {{"0", 0, 0}, {"1", 1, 1}, {"2", 2, 2}, {"3", 3, 3}, {"4", 4, 4}},
+    // Edges.
+    {{{0, 1}, 2.0, 6.0}, {{0, 3}, 3.0, 1.0},
+     {{1, 2}, 4.0, 5.0}, {{1, 3}, 4.0, 2.0}, {{1, 4}, 4.0, 2.0},
+     {{2, 4}, 2.0, 5.0},
+     {{3, 4}, 2.0, 1.0}}
+  });
+
+  CSRGraph csr(graph);
+
+  // Inexistent source and destination vertices.
+  EXPECT_TRUE(Dijkstra(csr, 99).empty());
+  EXPECT_TRUE(Dijkstra(csr, 0, 99).empty());
+
+  for (VertexId from = 0; from < 5; ++from)
+  {
+    auto expected = Dijkstra(graph, from);
+    auto res = Dijkstra(csr, from);
+    ASSERT_EQ(expected.size(), res.size());
+    for (auto const &entry : expected)
+    {
+      const auto &cost = res[csr.Index(entry.first)];
+      EXPECT_DOUBLE_EQ(entry.second.first, cost.first);
+      EXPECT_EQ(entry.second.second, cost.second);
+    }
+  }
+
+  // With a destination vertex, its entry is the shortest path.
+  auto res = Dijkstra(csr, 0, 2);
+  auto expected = Dijkstra(graph, 0, 2);
+  EXPECT_DOUBLE_EQ(expected.at(2).first, res[csr.Index(2)].first);
+  EXPECT_EQ(expected.at(2).second, res[csr.Index(2)].second);
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(CSRGraphTestFixture, SearchWorkspace)
+{
+  TypeParam graph(
+  {
+    // Vertices, with Ids that are not dense.
+    {{"0", 0, 0}, {"1", 1, 10}, {"2", 2, 20}, {"3", 3, 30}, {"4", 4, 40},
+     {"5", 5, 50}},
+    // Edges.
+    {{{0, 10}, 2.0, 6.0}, {{0, 30}, 3.0, 1.0},
+     {{10, 20}, 4.0, 5.0}, {{10, 30}, 4.0, 2.0}, {{10, 40}, 4.0, 2.0},
+     {{20, 40}, 2.0, 5.0},
+     {{30, 40}, 2.0, 1.0}}
+  });
+  CSRGraph csr(graph);
+
+  // The same workspace gives the same results as fresh searches, query
+  // after query.
+  SearchWorkspace workspace;
+  std::vector<VertexId> visited;
+  std::vector<VertexId> path;
+  for (int round = 0; round < 2; ++round)
+  {
+    for (VertexId from = 0; from <= 50; from += 10)
+    {
+      BreadthFirstSort(csr, from, workspace, visited);
+      EXPECT_EQ(BreadthFirstSort(csr, from), visited);
+      const auto levels = BreadthFirstLevels(csr, from);
+      for (CSRIndex i = 0; i < csr.VertexCount(); ++i)
+      {
+        EXPECT_EQ(levels[i] == kNullIndex, !workspace.Reached(i));
+        if (workspace.Reached(i))
+        {
+          EXPECT_DOUBLE_EQ(levels[i], workspace.Cost(i));
+        }
+      }
+
+      DepthFirstSort(csr, from, workspace, visited);
+      EXPECT_EQ(DepthFirstSort(csr, from), visited);
+
+      ASSERT_TRUE(Dijkstra(csr, from, workspace));
+      const auto expected = Dijkstra(csr, from);
+      for (CSRIndex i = 0; i < csr.VertexCount(); ++i)
+      {
+        EXPECT_DOUBLE_EQ(expected[i].first, workspace.Cost(i));
+        EXPECT_EQ(expected[i].second, csr.Id(workspace.Previous(i)));
+      }
+    }
+  }
+
+  // Paths, with and without a destination. Directed edges can't be
+  // followed backwards.
+  const bool directed = csr.Directed();
+  ASSERT_TRUE(Dijkstra(csr, 0, workspace, 20));
+  EXPECT_DOUBLE_EQ(directed ? 11.0 : 7.0, workspace.Path(csr, 20, path));
+  EXPECT_EQ(directed ? std::vector<VertexId>({0, 10, 20}) :
+            std::vector<VertexId>({0, 30, 40, 20}), path);
+  ASSERT_TRUE(Dijkstra(csr, 0, workspace));
+  const double cost10 = directed ? 6.0 : 3.0;
+  EXPECT_DOUBLE_EQ(cost10, workspace.Path(csr, 10, path));
+  EXPECT_EQ(directed ? std::vector<VertexId>({0, 10}) :
+            std::vector<VertexId>({0, 30, 10}), path);
+  EXPECT_DOUBLE_EQ(0.0, workspace.Path(csr, 0, path));
+  EXPECT_EQ(std::vector<VertexId>({0}), path);
+  EXPECT_DOUBLE_EQ(MAX_D, workspace.Path(csr, 50, path));
+  EXPECT_TRUE(path.empty());
+  EXPECT_DOUBLE_EQ(MAX_D, workspace.Path(csr, 99, path));
+
+  // Inexistent vertices leave the previous results.
+  EXPECT_FALSE(Dijkstra(csr, 99, workspace));
+  EXPECT_FALSE(Dijkstra(csr, 0, workspace, 99));
+  EXPECT_DOUBLE_EQ(cost10, workspace.Cost(csr.Index(10)));
+  BreadthFirstSort(csr, 99, workspace, visited);
+  EXPECT_TRUE(visited.empty());
+
+  // The workspace adapts to a larger graph.
+  const CSRGraph line(100, {{0, 1}, {1, 2}, {2, 99}});
+  ASSERT_TRUE(Dijkstra(line, 0, workspace));
+  EXPECT_DOUBLE_EQ(3.0, workspace.Cost(99));
+  EXPECT_FALSE(workspace.Reached(50));
+  EXPECT_EQ(kNullIndex, workspace.Previous(50));
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(CSRGraphTestFixture, MultiSourceDijkstra)
+{
+  TypeParam graph(
+  {
+    // Vertices.
+    {{"0", 0, 0}, {"1", 1, 10}, {"2", 2, 20}, {"3", 3, 30}, {"4", 4, 40},
+     {"5", 5, 50}},
+    // Edges.
+    {{{0, 10}, 2.0, 6.0}, {{0, 30}, 3.0, 1.0},
+     {{10, 20}, 4.0, 5.0}, {{10, 30}, 4.0, 2.0}, {{10, 40}, 4.0, 2.0},
+     {{20, 40}, 2.0, 5.0},
+     {{30, 40}, 2.0, 1.0}}
+  });
+  CSRGraph csr(graph);
+
+  // Every vertex gets the cost from its closest source.
+  const std::vector<VertexId> sources = {0, 20};
+  const auto res = Dijkstra(csr, sources);
+  const auto from0 = Dijkstra(csr, 0);
+  const auto from20 = Dijkstra(csr, 20);
+  ASSERT_EQ(csr.VertexCount(), res.size());
+  for (CSRIndex i = 0; i < csr.VertexCount(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(std::min(from0[i].first, from20[i].first),
+                     res[i].first);
+  }
+  EXPECT_EQ(0u, res[csr.Index(0)].second);
+  EXPECT_EQ(20u, res[csr.Index(20)].second);
+  EXPECT_DOUBLE_EQ(MAX_D, res[csr.Index(50)].first);
+  EXPECT_EQ(kNullId, res[csr.Index(50)].second);
+
+  // The first vertex of a path is the closest source.
+  SearchWorkspace workspace;
+  std::vector<VertexId> path;
+  ASSERT_TRUE(Dijkstra(csr, sources, workspace));
+  const double cost40 = workspace.Path(csr, 40, path);
+  EXPECT_DOUBLE_EQ(res[csr.Index(40)].first, cost40);
+  ASSERT_FALSE(path.empty());
+  EXPECT_DOUBLE_EQ(cost40, path.front() == 0 ?
+      from0[csr.Index(40)].first : from20[csr.Index(40)].first);
+  for (CSRIndex i = 0; i < csr.VertexCount(); ++i)
+    EXPECT_EQ(workspace.Reached(i), workspace.Settled(i));
+
+  // Duplicate sources and targets. The search stops once the targets are
+  // settled.
+  ASSERT_TRUE(Dijkstra(csr, {0, 0}, workspace, {30, 30, 0}));
+  EXPECT_DOUBLE_EQ(1.0, workspace.Path(csr, 30, path));
+  EXPECT_EQ(std::vector<VertexId>({0, 30}), path);
+  EXPECT_TRUE(workspace.Settled(csr.Index(30)));
+  EXPECT_FALSE(workspace.Settled(csr.Index(20)));
+
+  // Unreachable targets.
+  ASSERT_TRUE(Dijkstra(csr, sources, workspace, {50}));
+  EXPECT_FALSE(workspace.Reached(csr.Index(50)));
+  EXPECT_DOUBLE_EQ(res[csr.Index(10)].first,
+                   workspace.Cost(csr.Index(10)));
+
+  // Invalid sources and targets leave the previous results.
+  EXPECT_TRUE(Dijkstra(csr, std::vector<VertexId>()).empty());
+  EXPECT_TRUE(Dijkstra(csr, {0, 99}).empty());
+  EXPECT_FALSE(Dijkstra(csr, sources, workspace, {10, 99}));
+  EXPECT_DOUBLE_EQ(res[csr.Index(10)].first,
+                   workspace.Cost(csr.Index(10)));
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, DijkstraDecreaseKey)
+{
+  // A dense graph where most vertices are improved several times, so the
+  // queue has to move them up.
+  std::vector<Vertex<int>> vertices;
+  std::vector<EdgeInitializer<double>> edges;
+  const VertexId n = 60;
+  for (VertexId i = 0; i < n; ++i)
+    vertices.push_back(Vertex<int>("", 0, i));
+  for (VertexId i = 0; i < n; ++i)
+  {
+    for (VertexId j = 0; j < n; ++j)
+    {
+      if (i != j && (i * 7 + j * 3) % 5 != 0)
+        edges.push_back({{i, j}, 0.0, 1.0 + static_cast<double>(
+            (i * 31 + j * 17) % 23)});
+    }
+  }
+  const DirectedGraph<int, double> graph(vertices, edges);
+  const CSRGraph csr(graph);
+
+  SearchWorkspace workspace;
+  for (VertexId from = 0; from < n; from += 7)
+  {
+    const auto expected = Dijkstra(graph, from);
+    ASSERT_TRUE(Dijkstra(csr, from, workspace));
+    for (auto const &entry : expected)
+    {
+      const CSRIndex i = csr.Index(entry.first);
+      EXPECT_DOUBLE_EQ(entry.second.first, workspace.Cost(i));
+      EXPECT_EQ(entry.second.second, csr.Id(workspace.Previous(i)));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, ConnectedComponents)
+{
+  UndirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}, {"D", 3, 3}, {"E", 4, 4}},
+    // Edges.
+    {{{0, 2}, 2.0, 6.0},
+     {{1, 4}, 4.0, 5.0}}
+  });
+
+  CSRGraph csr(graph);
+  auto components = ConnectedComponents(csr);
+  ASSERT_EQ(3u, components.size());
+
+  std::vector<VertexId> expected = {0, 2};
+  EXPECT_EQ(expected, components[0]);
+  expected = {1, 4};
+  EXPECT_EQ(expected, components[1]);
+  expected = {3};
+  EXPECT_EQ(expected, components[2]);
+
+  // Same partition as the algorithm running on the original graph.
+  auto graphComponents = ConnectedComponents(graph);
+  ASSERT_EQ(graphComponents.size(), components.size());
+  for (std::size_t i = 0; i < components.size(); ++i)
+  {
+    auto vertices = graphComponents[i].Vertices();
+    ASSERT_EQ(vertices.size(), components[i].size());
+    for (auto const &v : components[i])
+      EXPECT_NE(vertices.end(), vertices.find(v));
+  }
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(CSRGraphTestFixture, BreadthFirstLevels)
+{
+  TypeParam graph(
+  {
+    // Vertices.
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}, {"D", 3, 3}, {"E", 4, 4},
+     {"F", 5, 5}, {"G", 6, 6}, {"H", 7, 7}},
+    // Edges.
+    {{{0, 1}, 2.0}, {{0, 2}, 3.0}, {{0, 4}, 4.0},
+     {{1, 3}, 2.0}, {{1, 5}, 3.0}, {{2, 6}, 4.0},
+     {{5, 4}, 2.0}}
+  });
+
+  CSRGraph csr(graph);
+
+  std::vector<CSRIndex> expected = {0, 1, 1, 2, 1, 2, 2, kNullIndex};
+  EXPECT_EQ(expected, BreadthFirstLevels(csr, 0));
+  EXPECT_EQ(expected, BreadthFirstLevels(csr, 0, 4));
+
+  // Inexistent vertex.
+  EXPECT_TRUE(BreadthFirstLevels(csr, 99).empty());
+}
+
+/////////////////////////////////////////////////
+/// \brief Build a random undirected graph made of several dense clusters
+/// joined by a few edges, and some isolated vertices.
+UndirectedGraph<int, double> RandomGraph(const VertexId _vertexCount,
+                                         const std::size_t _edgeCount)
+{
+  UndirectedGraph<int, double> graph;
+  for (VertexId v = 0; v < _vertexCount; ++v)
+    graph.AddVertex(std::to_string(v), 0, v);
+
+  // Fixed linear congruential generator, for reproducible graphs.
+  uint64_t state = 12345;
+  auto next = [&state](const VertexId _max)
+  {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<VertexId>((state >> 33) % _max);
+  };
+
+  // Vertices are in 8 clusters by their Id modulo 8. The last cluster only
+  // gets the edges that join it to the others, and the first 100 vertices
+  // of it stay isolated.
+  const VertexId clusters = 8;
+  for (std::size_t i = 0; i < _edgeCount; ++i)
+  {
+    const VertexId c = next(clusters - 1);
+    const VertexId u = next(_vertexCount / clusters) * clusters + c;
+    const VertexId v = next(_vertexCount / clusters) * clusters + c;
+    graph.AddEdge({u, v}, 0);
+  }
+  for (VertexId c = 0; c + 1 < clusters - 1; c += 2)
+    graph.AddEdge({c, c + 1}, 0);
+  for (VertexId v = 800 + clusters - 1; v < _vertexCount;
+       v += clusters)
+  {
+    graph.AddEdge({v, v - clusters}, 0);
+  }
+
+  return graph;
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, ParallelSearches)
+{
+  const auto graph = RandomGraph(40000, 120000);
+  CSRGraph csr(graph);
+
+  // Reference levels, from a plain breadth first search.
+  for (const VertexId from : {VertexId(0), VertexId(3), VertexId(2007)})
+  {
+    std::vector<CSRIndex> expected(csr.VertexCount(), kNullIndex);
+    std::vector<CSRIndex> pending = {csr.Index(from)};
+    expected[pending[0]] = 0;
+    for (std::size_t head = 0; head < pending.size(); ++head)
+    {
+      const CSRIndex u = pending[head];
+      for (CSRIndex arc = csr.Offsets()[u]; arc < csr.Offsets()[u + 1];
+           ++arc)
+      {
+        const CSRIndex v = csr.Targets()[arc];
+        if (expected[v] == kNullIndex)
+        {
+          expected[v] = expected[u] + 1;
+          pending.push_back(v);
+        }
+      }
+    }
+
+    EXPECT_EQ(expected, BreadthFirstLevels(csr, from));
+    EXPECT_EQ(expected, BreadthFirstLevels(csr, from, 4));
+  }
+
+  // Same components as the single threaded breadth first version.
+  const auto components = ConnectedComponents(csr);
+  EXPECT_LT(100u, components.size());
+  for (const unsigned int threads : {1u, 4u})
+  {
+    std::vector<CSRIndex> labels;
+    EXPECT_EQ(components.size(), ConnectedComponents(csr, labels, threads));
+    ASSERT_EQ(csr.VertexCount(), labels.size());
+    for (std::size_t c = 0; c < components.size(); ++c)
+    {
+      for (const VertexId v : components[c])
+        EXPECT_EQ(c, labels[csr.Index(v)]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check shortest paths against Dijkstra, and that every previous
+/// vertex leads back to a source along arcs of matching cost.
+/// \param[in] _csr The graph.
+/// \param[in] _sources The source vertices.
+/// \param[in] _res Result of DeltaStepping.
+void ExpectShortestPaths(const CSRGraph &_csr,
+                         const std::vector<VertexId> &_sources,
+                         const std::vector<CostInfo> &_res)
+{
+  const auto expected = Dijkstra(_csr, _sources);
+  ASSERT_EQ(expected.size(), _res.size());
+  for (CSRIndex v = 0; v < _csr.VertexCount(); ++v)
+  {
+    EXPECT_EQ(expected[v].first, _res[v].first);
+    if (math::equal(_res[v].first, MAX_D))
+    {
+      EXPECT_EQ(kNullId, _res[v].second);
+      continue;
+    }
+
+    // Walk back to a source.
+    CSRIndex u = v;
+    for (CSRIndex steps = 0; steps <= _csr.VertexCount(); ++steps)
+    {
+      const CSRIndex p = _csr.Index(_res[u].second);
+      ASSERT_NE(kNullIndex, p);
+      if (p == u)
+        break;
+
+      bool found = false;
+      for (CSRIndex arc = _csr.Offsets()[p]; arc < _csr.Offsets()[p + 1];
+           ++arc)
+      {
+        found = found || (_csr.Targets()[arc] == u &&
+            math::equal(_res[p].first + _csr.Weights()[arc],
+                        _res[u].first));
+      }
+      ASSERT_TRUE(found);
+      u = p;
+    }
+    EXPECT_EQ(0.0, _res[u].first);
+    EXPECT_NE(_sources.end(),
+        std::find(_sources.begin(), _sources.end(), _csr.Id(u)));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, DeltaStepping)
+{
+  // Random weights from 0 to 9, so that paths tie and some arcs are free.
+  uint64_t state = 54321;
+  auto next = [&state](const VertexId _max)
+  {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<VertexId>((state >> 33) % _max);
+  };
+
+  const VertexId vertexCount = 20000;
+  DirectedGraph<int, double> directed;
+  UndirectedGraph<int, double> undirected;
+  for (VertexId v = 0; v < vertexCount; ++v)
+  {
+    directed.AddVertex(std::to_string(v), 0, v);
+    undirected.AddVertex(std::to_string(v), 0, v);
+  }
+  for (std::size_t i = 0; i < 100000; ++i)
+  {
+    const VertexId u = next(vertexCount);
+    const VertexId v = next(vertexCount);
+    const double weight = static_cast<double>(next(10));
+    directed.AddEdge({u, v}, 0, weight);
+    if (i % 2 == 0)
+      undirected.AddEdge({u, v}, 0, weight);
+  }
+
+  for (const CSRGraph &csr : {CSRGraph(directed), CSRGraph(undirected)})
+  {
+    for (const double delta : {0.0, 0.5, 3.0, 100.0})
+    {
+      for (const unsigned int threads : {1u, 4u})
+      {
+        ExpectShortestPaths(csr, {0},
+            DeltaStepping(csr, 0, delta, threads));
+        ExpectShortestPaths(csr, {5, 17, 2007},
+            DeltaStepping(csr, {5, 17, 2007}, delta, threads));
+      }
+    }
+  }
+
+  // Same results as Dijkstra on a small graph.
+  DirectedGraph<int, double> graph(
+  {
+    {{"A", 2, 0}, {"B", 3, 1}, {"C", 4, 2}, {"D", 7, 3}},
+    {{{0, 1}, 0, 2.0}, {{0, 2}, 0, 7.0}, {{1, 2}, 0, 3.0},
+     {{2, 0}, 0, 1.0}}
+  });
+  CSRGraph csr(graph);
+  EXPECT_EQ(Dijkstra(csr, 0), DeltaStepping(csr, 0));
+  EXPECT_EQ(Dijkstra(csr, 0), DeltaStepping(csr, 0, 1.0, 2));
+
+  // Missing vertices.
+  EXPECT_TRUE(DeltaStepping(csr, 99).empty());
+  EXPECT_TRUE(DeltaStepping(csr, std::vector<VertexId>()).empty());
+  EXPECT_TRUE(DeltaStepping(csr, {0, 99}).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, DistanceTable)
+{
+  const auto graph = RandomGraph(4000, 12000);
+  CSRGraph csr(graph);
+
+  const std::vector<VertexId> sources = {0, 3, 2007, 815, 12, 3999, 3};
+  const std::vector<VertexId> targets = {1, 8, 2007, 77, 801};
+  for (const unsigned int threads : {1u, 3u})
+  {
+    std::vector<double> table;
+    ASSERT_TRUE(DistanceTable(csr, sources, targets, table, threads));
+    ASSERT_EQ(sources.size() * targets.size(), table.size());
+    for (std::size_t i = 0; i < sources.size(); ++i)
+    {
+      const auto expected = Dijkstra(csr, sources[i]);
+      for (std::size_t j = 0; j < targets.size(); ++j)
+      {
+        EXPECT_EQ(expected[csr.Index(targets[j])].first,
+                  table[i * targets.size() + j]);
+      }
+    }
+
+    // Same table from the graph.
+    std::vector<double> fromGraph;
+    ASSERT_TRUE(DistanceTable(graph, sources, targets, fromGraph,
+                              threads));
+    EXPECT_EQ(table, fromGraph);
+  }
+
+  // Isolated vertices can't be reached.
+  std::vector<double> table;
+  ASSERT_TRUE(DistanceTable(csr, {0}, {0, 807}, table));
+  EXPECT_EQ(std::vector<double>({0.0, MAX_D}), table);
+
+  // Empty rows or columns, and missing vertices.
+  EXPECT_TRUE(DistanceTable(csr, {}, targets, table));
+  EXPECT_TRUE(table.empty());
+  EXPECT_TRUE(DistanceTable(csr, sources, {}, table));
+  EXPECT_TRUE(table.empty());
+  table.assign(3, 1.0);
+  EXPECT_FALSE(DistanceTable(csr, {0, 99999}, targets, table));
+  EXPECT_TRUE(table.empty());
+  EXPECT_FALSE(DistanceTable(csr, sources, {99999}, table));
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, ConnectedComponentLabels)
+{
+  UndirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"A", 0, 10}, {"B", 1, 11}, {"C", 2, 12}, {"D", 3, 13}, {"E", 4, 14}},
+    // Edges.
+    {{{12, 10}, 2.0, 6.0},
+     {{14, 11}, 4.0, 5.0}}
+  });
+
+  CSRGraph csr(graph);
+  std::vector<CSRIndex> labels;
+  EXPECT_EQ(3u, ConnectedComponents(csr, labels));
+  std::vector<CSRIndex> expected = {0, 1, 0, 2, 1};
+  EXPECT_EQ(expected, labels);
+
+  // Empty graph.
+  EXPECT_EQ(0u, ConnectedComponents(CSRGraph(), labels, 4));
+  EXPECT_TRUE(labels.empty());
+
+  // Directed graphs are not supported.
+  DirectedGraph<int, double> directed(
+  {
+    {{"A", 0, 0}, {"B", 1, 1}},
+    {{{0, 1}, 2.0}}
+  });
+  labels = {1, 2, 3};
+  EXPECT_EQ(0u, ConnectedComponents(CSRGraph(directed), labels));
+  EXPECT_TRUE(labels.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, EdgeList)
+{
+  // Same graph as an edge list and as a Graph with Ids 0..n-1.
+  const std::vector<std::pair<CSRIndex, CSRIndex>> edgeList =
+    {{0, 1}, {0, 3}, {1, 2}, {1, 3}, {1, 4}, {2, 4}, {3, 4}, {4, 4}, {4, 0}};
+  const std::vector<double> weights =
+    {6.0, 1.0, 5.0, 2.0, 2.0, 5.0, 1.0, 3.0, 7.0};
+
+  for (const bool directed : {false, true})
+  {
+    CSRGraph csr(5, edgeList, weights, directed);
+    EXPECT_EQ(directed, csr.Directed());
+    EXPECT_EQ(5u, csr.VertexCount());
+    EXPECT_EQ(directed ? 9u : 17u, csr.ArcCount());
+    for (CSRIndex i = 0; i < 5; ++i)
+    {
+      EXPECT_EQ(i, csr.Index(i));
+      EXPECT_EQ(i, csr.Id(i));
+    }
+
+    std::vector<Vertex<int>> vertices;
+    for (VertexId v = 0; v < 5; ++v)
+      vertices.push_back(Vertex<int>(std::to_string(v), 0, v));
+    std::vector<EdgeInitializer<double>> edges;
+    for (std::size_t e = 0; e < edgeList.size(); ++e)
+      edges.push_back({{edgeList[e].first, edgeList[e].second}, 0,
+                       weights[e]});
+
+    CSRGraph expected = directed ?
+      CSRGraph(DirectedGraph<int, double>(vertices, edges)) :
+      CSRGraph(UndirectedGraph<int, double>(vertices, edges));
+    EXPECT_EQ(expected.Offsets(), csr.Offsets());
+    EXPECT_EQ(expected.Targets(), csr.Targets());
+    EXPECT_EQ(expected.Weights(), csr.Weights());
+    EXPECT_EQ(expected.EdgeIds(), csr.EdgeIds());
+  }
+
+  // Default weights, and edges with an inexistent vertex are ignored.
+  CSRGraph unweighted(3, {{0, 1}, {1, 7}, {2, 1}});
+  EXPECT_EQ(4u, unweighted.ArcCount());
+  std::vector<double> ones(4, 1.0);
+  EXPECT_EQ(ones, unweighted.Weights());
+  std::vector<EdgeId> edgeIds = {0, 0, 2, 2};
+  EXPECT_EQ(edgeIds, unweighted.EdgeIds());
+
+  // The number of weights must match the number of edges.
+  CSRGraph mismatch(3, {{0, 1}, {1, 2}}, {1.0});
+  EXPECT_TRUE(mismatch.Empty());
+
+  // Isolated vertices only.
+  CSRGraph isolated(4, {});
+  EXPECT_EQ(4u, isolated.VertexCount());
+  std::vector<CSRIndex> labels;
+  EXPECT_EQ(4u, ConnectedComponents(isolated, labels));
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, MinimumSpanningTree)
+{
+  // An undirected grid with pseudo random weights and a second component.
+  const CSRIndex width = 30;
+  std::vector<std::pair<CSRIndex, CSRIndex>> edges;
+  std::vector<double> weights;
+  uint32_t seed = 7;
+  for (CSRIndex i = 0; i < width * width; ++i)
+  {
+    for (const CSRIndex j : {i + 1, i + width})
+    {
+      if ((j == i + 1 && j % width == 0) || j >= width * width)
+        continue;
+      seed = seed * 1103515245u + 12345u;
+      edges.push_back({i, j});
+      weights.push_back(static_cast<double>((seed >> 16) % 50));
+    }
+  }
+  const CSRIndex n = width * width + 3;
+  edges.push_back({n - 3, n - 2});
+  weights.push_back(1.0);
+  edges.push_back({n - 2, n - 1});
+  weights.push_back(2.0);
+  const CSRGraph csr(n, edges, weights);
+
+  auto total = [&](const std::vector<EdgeId> &_ids)
+  {
+    double sum = 0.0;
+    for (const EdgeId id : _ids)
+      sum += weights[id];
+    return sum;
+  };
+
+  // Kruskal spans both components.
+  const auto forest = MinimumSpanningForest(csr);
+  EXPECT_EQ(n - 2, forest.size());
+
+  // The same forest as the Graph version.
+  UndirectedGraph<int, double> graph;
+  for (CSRIndex i = 0; i < n; ++i)
+    graph.AddVertex("", 0, i);
+  for (std::size_t e = 0; e < edges.size(); ++e)
+    graph.AddEdge({edges[e].first, edges[e].second}, 0.0, weights[e]);
+  std::vector<EdgeId> sorted = forest;
+  std::sort(sorted.begin(), sorted.end());
+  EXPECT_EQ(sorted, MinimumSpanningForest(graph).EdgeIds());
+
+  // Prim spans the component of the root, with the same weight.
+  SearchWorkspace workspace;
+  std::vector<EdgeId> tree;
+  ASSERT_TRUE(MinimumSpanningTree(csr, 0, workspace, tree));
+  EXPECT_EQ(width * width - 1, tree.size());
+  EXPECT_DOUBLE_EQ(total(forest) - 3.0, total(tree));
+  for (CSRIndex i = 1; i < width * width; ++i)
+  {
+    EXPECT_NE(kNullIndex, workspace.Previous(i));
+    EXPECT_LE(workspace.Cost(i), 49.0);
+  }
+  EXPECT_FALSE(workspace.Reached(n - 1));
+
+  ASSERT_TRUE(MinimumSpanningTree(csr, n - 1, workspace, tree));
+  EXPECT_EQ(std::vector<EdgeId>({edges.size() - 1, edges.size() - 2}),
+            tree);
+
+  // Parallel edges keep the lightest one.
+  const CSRGraph parallel(2, {{0, 1}, {1, 0}, {0, 1}}, {3.0, 1.0, 2.0});
+  ASSERT_TRUE(MinimumSpanningTree(parallel, 0, workspace, tree));
+  EXPECT_EQ(std::vector<EdgeId>({1}), tree);
+  EXPECT_EQ(std::vector<EdgeId>({1}), MinimumSpanningForest(parallel));
+
+  // Directed graphs and missing roots.
+  const CSRGraph directed(2, {{0, 1}}, {}, true);
+  EXPECT_TRUE(MinimumSpanningForest(directed).empty());
+  EXPECT_FALSE(MinimumSpanningTree(directed, 0, workspace, tree));
+  EXPECT_TRUE(tree.empty());
+  EXPECT_FALSE(MinimumSpanningTree(csr, n, workspace, tree));
+  EXPECT_TRUE(MinimumSpanningForest(CSRGraph()).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, SearchStats)
+{
+  // A directed chain 0 -> 1 -> ... -> 9 with a shortcut 0 -> 9.
+  const CSRIndex n = 10;
+  std::vector<std::pair<CSRIndex, CSRIndex>> edges;
+  std::vector<double> weights;
+  for (CSRIndex i = 0; i + 1 < n; ++i)
+  {
+    edges.push_back({i, i + 1});
+    weights.push_back(1.0);
+  }
+  edges.push_back({0, n - 1});
+  weights.push_back(20.0);
+  const CSRGraph csr(n, edges, weights, true);
+
+  SearchWorkspace workspace;
+  SearchStats stats;
+  ASSERT_TRUE(Dijkstra(csr, 0, workspace, kNullId, stats));
+  EXPECT_EQ(1u, stats.searches);
+  EXPECT_EQ(n, stats.expanded);
+  EXPECT_EQ(csr.ArcCount(), stats.relaxed);
+  // Every vertex is pushed once, and 9 moves up once.
+  EXPECT_EQ(n + 1, stats.pushes);
+  EXPECT_EQ(2u, stats.peakQueueSize);
+  EXPECT_DOUBLE_EQ(9.0, workspace.Cost(n - 1));
+
+  // Stopping at a target expands fewer vertices.
+  SearchStats early;
+  ASSERT_TRUE(Dijkstra(csr, 0, workspace, 3, early));
+  EXPECT_EQ(1u, early.searches);
+  EXPECT_LT(early.expanded, stats.expanded);
+  EXPECT_LE(early.relaxed, stats.relaxed);
+
+  // The counters accumulate over searches.
+  SearchStats total = stats;
+  total += early;
+  EXPECT_EQ(2u, total.searches);
+  EXPECT_EQ(stats.expanded + early.expanded, total.expanded);
+  EXPECT_EQ(stats.peakQueueSize, total.peakQueueSize);
+  ASSERT_TRUE(Dijkstra(csr, std::vector<VertexId>({0}), workspace,
+                       std::vector<VertexId>(), stats));
+  ASSERT_TRUE(Dijkstra(csr, 3, workspace, 3, stats));
+  EXPECT_EQ(3u, stats.searches);
+
+  // Unknown vertices fail without expanding anything.
+  SearchStats failed;
+  EXPECT_FALSE(Dijkstra(csr, n, workspace, kNullId, failed));
+  EXPECT_EQ(0u, failed.expanded);
+
+  // Traversals expand every reachable vertex once.
+  std::vector<VertexId> visited;
+  stats.Reset();
+  EXPECT_EQ(0u, stats.searches);
+  EXPECT_EQ(0u, stats.peakQueueSize);
+  BreadthFirstSort(csr, 0, workspace, visited, stats);
+  EXPECT_EQ(n, visited.size());
+  EXPECT_EQ(1u, stats.searches);
+  EXPECT_EQ(n, stats.expanded);
+  EXPECT_EQ(csr.ArcCount(), stats.relaxed);
+  EXPECT_EQ(n, stats.pushes);
+
+  stats.Reset();
+  DepthFirstSort(csr, 5, workspace, visited, stats);
+  EXPECT_EQ(5u, visited.size());
+  EXPECT_EQ(1u, stats.searches);
+  EXPECT_EQ(5u, stats.expanded);
+  EXPECT_EQ(4u, stats.relaxed);
+  EXPECT_LE(stats.peakQueueSize, stats.pushes);
+}
+
+/////////////////////////////////////////////////
+/////////////////////////////////////////////////
+/// \brief Memory resource which counts its allocations.
+class CountingResource : public std::pmr::memory_resource
+{
+  /// \brief Number of allocations.
+  public: std::size_t allocations = 0;
+
+  private: void *do_allocate(std::size_t _bytes,
+                             std::size_t _alignment) override
+  {
+    ++this->allocations;
+    return std::pmr::new_delete_resource()->allocate(_bytes, _alignment);
+  }
+
+  private: void do_deallocate(void *_p, std::size_t _bytes,
+                              std::size_t _alignment) override
+  {
+    std::pmr::new_delete_resource()->deallocate(_p, _bytes, _alignment);
+  }
+
+  private: bool do_is_equal(
+               const std::pmr::memory_resource &_other) const noexcept override
+  {
+    return this == &_other;
+  }
+};
+
+/////////////////////////////////////////////////
+TEST(CSRGraphTest, SearchWorkspaceMemoryResource)
+{
+  const CSRGraph line(100, {{0, 1}, {1, 2}, {2, 99}});
+  CountingResource resource;
+  SearchWorkspace workspace(&resource);
+  SearchWorkspace expected;
+  ASSERT_TRUE(Dijkstra(line, 0, workspace));
+  ASSERT_TRUE(Dijkstra(line, 0, expected));
+  EXPECT_LT(0u, resource.allocations);
+  for (CSRIndex i = 0; i < line.VertexCount(); ++i)
+  {
+    EXPECT_EQ(expected.Reached(i), workspace.Reached(i));
+    EXPECT_EQ(expected.Previous(i), workspace.Previous(i));
+  }
+
+  // Repeated queries reuse the memory
+  const std::size_t allocations = resource.allocations;
+  ASSERT_TRUE(Dijkstra(line, 0, workspace));
+  EXPECT_EQ(allocations, resource.allocations);
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "gz/math/graph/ContractionHierarchy.hh"
+#include "gz/math/graph/CSRGraph.hh"
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+
+using namespace gz;
+using namespace math;
+using namespace graph;
+
+// Define a test fixture class template.
+template <class T>
+class ContractionHierarchyTestFixture : public testing::Test
+{
+};
+
+// The list of graphs we want to test.
+using GraphTypes = ::testing::Types<DirectedGraph<int, double>,
+                                    UndirectedGraph<int, double>>;
+TYPED_TEST_CASE(ContractionHierarchyTestFixture, GraphTypes);
+
+/////////////////////////////////////////////////
+/// \brief Check that a path follows arcs of a graph and has a given cost.
+/// \param[in] _csr The graph.
+/// \param[in] _path The vertices of the path.
+/// \param[in] _cost Expected cost.
+void ExpectPath(const CSRGraph &_csr, const std::vector<VertexId> &_path,
+                const double _cost)
+{
+  double cost = 0.0;
+  for (std::size_t i = 1; i < _path.size(); ++i)
+  {
+    const CSRIndex u = _csr.Index(_path[i - 1]);
+    const CSRIndex v = _csr.Index(_path[i]);
+    ASSERT_NE(kNullIndex, u);
+    double weight = MAX_D;
+    for (CSRIndex arc = _csr.Offsets()[u]; arc < _csr.Offsets()[u + 1];
+         ++arc)
+    {
+      if (_csr.Targets()[arc] == v)
+        weight = std::min(weight, _csr.Weights()[arc]);
+    }
+    ASSERT_LT(weight, MAX_D);
+    cost += weight;
+  }
+  EXPECT_NEAR(_cost, cost, 1e-9);
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(ContractionHierarchyTestFixture, ShortestPath)
+{
+  TypeParam graph(
+  {
+    // Vertices, with Ids that are not dense.
+    {{"0", 0, 0}, {"1", 1, 10}, {"2", 2, 20}, {"3", 3, 30}, {"4", 4, 40},
+     {"5", 5, 50}},
+    // Edges.
+    {{{0, 10}, 2.0, 6.0}, {{0, 30}, 3.0, 1.0},
+     {{10, 20}, 4.0, 5.0}, {{10, 30}, 4.0, 2.0}, {{10, 40}, 4.0, 2.0},
+     {{20, 40}, 2.0, 5.0},
+     {{30, 40}, 2.0, 1.0}}
+  });
+  const CSRGraph csr(graph);
+  const ContractionHierarchy ch(graph);
+  EXPECT_EQ(6u, ch.VertexCount());
+  EXPECT_FALSE(ch.Empty());
+  EXPECT_EQ(csr.ArcCount(), ch.ArcCount() - ch.ShortcutCount());
+
+  // Same costs as Dijkstra between every pair of vertices.
+  for (const VertexId from : csr.Ids())
+  {
+    const auto expected = Dijkstra(csr, from);
+    for (const VertexId to : csr.Ids())
+    {
+      const auto res = ch.ShortestPath(from, to);
+      EXPECT_DOUBLE_EQ(expected[csr.Index(to)].first, res.first);
+      if (res.first < MAX_D)
+      {
+        ASSERT_FALSE(res.second.empty());
+        EXPECT_EQ(from, res.second.front());
+        EXPECT_EQ(to, res.second.back());
+        ExpectPath(csr, res.second, res.first);
+      }
+      else
+      {
+        EXPECT_TRUE(res.second.empty());
+      }
+    }
+  }
+
+  auto res = ch.ShortestPath(20, 20);
+  EXPECT_DOUBLE_EQ(0.0, res.first);
+  EXPECT_EQ(std::vector<VertexId>({20}), res.second);
+
+  // Inexistent vertices.
+  res = ch.ShortestPath(0, 99);
+  EXPECT_DOUBLE_EQ(MAX_D, res.first);
+  EXPECT_TRUE(res.second.empty());
+  res = ch.ShortestPath(99, 0);
+  EXPECT_DOUBLE_EQ(MAX_D, res.first);
+
+  const ContractionHierarchy empty;
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ(0u, empty.ArcCount());
+  EXPECT_DOUBLE_EQ(MAX_D, empty.ShortestPath(0, 0).first);
+}
+
+/////////////////////////////////////////////////
+/// \brief Build a directed grid with pseudo random weights, and a few
+/// long arcs.
+/// \param[in] _width Number of vertices along each side.
+/// \return The graph, with vertex y * _width + x at row y and column x.
+CSRGraph RandomGrid(const CSRIndex _width)
+{
+  std::vector<std::pair<CSRIndex, CSRIndex>> edges;
+  std::vector<double> weights;
+  uint32_t seed = 7;
+  auto random = [&seed]()
+  {
+    seed = seed * 1103515245u + 12345u;
+    return static_cast<double>((seed >> 16) % 100) / 10.0 + 0.5;
+  };
+  for (CSRIndex y = 0; y < _width; ++y)
+  {
+    for (CSRIndex x = 0; x < _width; ++x)
+    {
+      const CSRIndex i = y * _width + x;
+      if (x + 1 < _width)
+      {
+        edges.push_back({i, i + 1});
+        weights.push_back(random());
+        edges.push_back({i + 1, i});
+        weights.push_back(random());
+      }
+      if (y + 1 < _width)
+      {
+        edges.push_back({i, i + _width});
+        weights.push_back(random());
+        edges.push_back({i + _width, i});
+        weights.push_back(random());
+      }
+      if (i % 37 == 0 && i + 5 * _width + 3 < _width * _width)
+      {
+        edges.push_back({i, i + 5 * _width + 3});
+        weights.push_back(4.0 * random());
+      }
+    }
+  }
+  return CSRGraph(_width * _width, edges, weights, true);
+}
+
+/////////////////////////////////////////////////
+TEST(ContractionHierarchyTest, Grid)
+{
+  const CSRIndex width = 30;
+  const CSRGraph csr = RandomGrid(width);
+  const ContractionHierarchy ch(csr);
+  ASSERT_EQ(csr.VertexCount(), ch.VertexCount());
+
+  // Every rank is used once.
+  std::vector<bool> used(ch.VertexCount(), false);
+  for (CSRIndex i = 0; i < ch.VertexCount(); ++i)
+  {
+    ASSERT_LT(ch.Rank(i), ch.VertexCount());
+    EXPECT_FALSE(used[ch.Rank(i)]);
+    used[ch.Rank(i)] = true;
+  }
+  EXPECT_EQ(kNullIndex, ch.Rank(ch.VertexCount()));
+
+  SearchWorkspace forward;
+  SearchWorkspace backward;
+  std::vector<VertexId> path;
+  for (VertexId from = 0; from < width * width; from += 97)
+  {
+    const auto expected = Dijkstra(csr, from);
+    for (VertexId to = 3; to < width * width; to += 41)
+    {
+      const double cost = ch.ShortestPath(from, to, forward, backward,
+                                          path);
+      EXPECT_NEAR(expected[to].first, cost, 1e-9);
+      ASSERT_FALSE(path.empty());
+      EXPECT_EQ(from, path.front());
+      EXPECT_EQ(to, path.back());
+      ExpectPath(csr, path, cost);
+    }
+  }
+
+  // Save and load.
+  std::vector<uint8_t> buffer;
+  ch.Save(buffer);
+  ContractionHierarchy loaded;
+  ASSERT_TRUE(loaded.Load(buffer));
+  EXPECT_EQ(ch.ArcCount(), loaded.ArcCount());
+  EXPECT_EQ(ch.ShortcutCount(), loaded.ShortcutCount());
+  for (VertexId from = 5; from < width * width; from += 131)
+  {
+    const auto expected = ch.ShortestPath(from, 800);
+    EXPECT_EQ(expected, loaded.ShortestPath(from, 800));
+  }
+
+  std::stringstream stream;
+  EXPECT_TRUE(ch.Save(stream));
+  ContractionHierarchy streamed;
+  ASSERT_TRUE(streamed.Load(stream));
+  EXPECT_EQ(ch.ShortestPath(0, 899), streamed.ShortestPath(0, 899));
+
+  // Invalid data leaves the hierarchy unchanged.
+  std::vector<uint8_t> truncated(buffer.begin(), buffer.end() - 1);
+  EXPECT_FALSE(loaded.Load(truncated));
+  std::vector<uint8_t> corrupted = buffer;
+  corrupted[0] = 'X';
+  EXPECT_FALSE(loaded.Load(corrupted));
+  EXPECT_FALSE(loaded.Load(std::vector<uint8_t>()));
+  EXPECT_EQ(ch.ShortestPath(0, 899), loaded.ShortestPath(0, 899));
+
+  // An empty hierarchy round trips.
+  buffer.clear();
+  ContractionHierarchy().Save(buffer);
+  ASSERT_TRUE(loaded.Load(buffer));
+  EXPECT_TRUE(loaded.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(ContractionHierarchyTest, DistanceTable)
+{
+  const CSRIndex width = 30;
+  const CSRGraph csr = RandomGrid(width);
+  const ContractionHierarchy ch(csr);
+
+  std::vector<VertexId> sources;
+  for (VertexId v = 0; v < width * width; v += 23)
+    sources.push_back(v);
+  const std::vector<VertexId> targets = {899, 3, 450, 3, 17, 612};
+
+  std::vector<double> expected;
+  ASSERT_TRUE(DistanceTable(csr, sources, targets, expected));
+  for (const unsigned int threads : {1u, 4u})
+  {
+    std::vector<double> table;
+    ASSERT_TRUE(ch.DistanceTable(sources, targets, table, threads));
+    ASSERT_EQ(sources.size() * targets.size(), table.size());
+    for (std::size_t k = 0; k < table.size(); ++k)
+      EXPECT_NEAR(expected[k], table[k], 1e-9);
+  }
+
+  // Along a directed path, the earlier vertices can't be reached.
+  const CSRGraph oneWay(3, {{0, 1}, {1, 2}}, {1.0, 2.5}, true);
+  const ContractionHierarchy oneWayCh(oneWay);
+  std::vector<double> table;
+  ASSERT_TRUE(oneWayCh.DistanceTable({0, 2}, {0, 1, 2}, table));
+  EXPECT_EQ(std::vector<double>({0.0, 1.0, 3.5, MAX_D, MAX_D, 0.0}),
+            table);
+
+  // Empty rows or columns, and missing vertices.
+  EXPECT_TRUE(ch.DistanceTable({}, targets, table));
+  EXPECT_TRUE(table.empty());
+  EXPECT_TRUE(ch.DistanceTable(sources, {}, table));
+  EXPECT_TRUE(table.empty());
+  table.assign(3, 1.0);
+  EXPECT_FALSE(ch.DistanceTable({0, 5000}, targets, table));
+  EXPECT_TRUE(table.empty());
+  EXPECT_FALSE(ch.DistanceTable(sources, {5000}, table));
+}
@@ -16,7 +16,11 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "gz/math/graph/Graph.hh"
 #include "gz/math/graph/GraphAlgorithms.hh"
@@ -211,6 +215,179 @@ TEST(GraphTestFixture, DijkstraDirected)
   EXPECT_EQ(0u, res.at(1).second);
 }
 
+/////////////////////////////////////////////////
+TEST(GraphTestFixture, PointToPointDirected)
+{
+  ///              (6)                  |
+  ///           0------>1               |
+  ///           |      /|\              |
+  ///           |     / | \(5)          |
+  ///           | (2)/  |  ┘            |
+  ///           |   /   |   2           |
+  ///        (1)|  / (2)|  /            |
+  ///           | /     | /(5)          |
+  ///           VL      VL              |
+  ///           3------>4               |
+  ///              (1)                  |
+  DirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"0", 0, 0}, {"1", 1, 1}, {"2", 2, 2}, {"3", 3, 3}, {"4", 4, 4}},
+    // Edges.
+    {{{0, 1}, 2.0, 6.0}, {{0, 3}, 3.0, 1.0},
+     {{1, 2}, 4.0, 5.0}, {{1, 3}, 4.0, 2.0}, {{1, 4}, 4.0, 2.0},
+     {{2, 4}, 2.0, 5.0},
+     {{3, 4}, 2.0, 1.0}}
+  });
+
+  auto zero = [](const VertexId &) {return 0.0;};
+
+  // Inexistent source and destination vertices.
+  for (auto const &query : {std::make_pair(99u, 0u), std::make_pair(0u, 99u)})
+  {
+    auto res = AStar(graph, query.first, query.second, zero);
+    EXPECT_DOUBLE_EQ(MAX_D, res.first);
+    EXPECT_TRUE(res.second.empty());
+    res = BidirectionalDijkstra(graph, query.first, query.second);
+    EXPECT_DOUBLE_EQ(MAX_D, res.first);
+    EXPECT_TRUE(res.second.empty());
+  }
+
+  std::vector<VertexId> expected = {0, 1, 2};
+  for (auto const &res : {AStar(graph, 0, 2, zero),
+                          BidirectionalDijkstra(graph, 0, 2)})
+  {
+    EXPECT_DOUBLE_EQ(11.0, res.first);
+    EXPECT_EQ(expected, res.second);
+  }
+
+  expected = {0, 3, 4};
+  for (auto const &res : {AStar(graph, 0, 4, zero),
+                          BidirectionalDijkstra(graph, 0, 4)})
+  {
+    EXPECT_DOUBLE_EQ(2.0, res.first);
+    EXPECT_EQ(expected, res.second);
+  }
+
+  // Same source and destination.
+  expected = {3};
+  for (auto const &res : {AStar(graph, 3, 3, zero),
+                          BidirectionalDijkstra(graph, 3, 3)})
+  {
+    EXPECT_DOUBLE_EQ(0.0, res.first);
+    EXPECT_EQ(expected, res.second);
+  }
+
+  // Unreachable destination.
+  for (auto const &res : {AStar(graph, 4, 0, zero),
+                          BidirectionalDijkstra(graph, 4, 0)})
+  {
+    EXPECT_DOUBLE_EQ(MAX_D, res.first);
+    EXPECT_TRUE(res.second.empty());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(GraphTestFixture, PointToPointGrid)
+{
+  // A 10x10 grid where the vertex data is the cell index and edge weights
+  // are never smaller than the euclidean distance between cells.
+  const int n = 10;
+  UndirectedGraph<int, double> graph;
+  for (int i = 0; i < n * n; ++i)
+    graph.AddVertex(std::to_string(i), i, i);
+  for (int i = 0; i < n * n; ++i)
+  {
+    const double weight = 1.0 + (i % 3) * 0.5;
+    if (i % n < n - 1)
+      graph.AddEdge({i, i + 1}, 0, weight);
+    if (i / n < n - 1)
+      graph.AddEdge({i, i + n}, 0, weight);
+  }
+
+  for (VertexId from : {0u, 7u, 45u})
+  {
+    auto all = Dijkstra(graph, from);
+    for (VertexId to = 0; to < n * n; ++to)
+    {
+      auto heuristic = [&](const VertexId &_id)
+      {
+        const double dx = static_cast<double>(_id % n) - (to % n);
+        const double dy = static_cast<double>(_id / n) - (to / n);
+        return std::sqrt(dx * dx + dy * dy);
+      };
+
+      for (auto const &res : {AStar(graph, from, to, heuristic),
+                              BidirectionalDijkstra(graph, from, to)})
+      {
+        EXPECT_NEAR(all.at(to).first, res.first, 1e-9);
+        ASSERT_FALSE(res.second.empty());
+        EXPECT_EQ(from, res.second.front());
+        EXPECT_EQ(to, res.second.back());
+
+        // The path is connected and its cost matches.
+        double cost = 0;
+        for (std::size_t i = 1; i < res.second.size(); ++i)
+        {
+          const auto &edge =
+            graph.EdgeFromVertices(res.second[i - 1], res.second[i]);
+          ASSERT_TRUE(edge.Valid());
+          cost += edge.Weight();
+        }
+        EXPECT_NEAR(res.first, cost, 1e-9);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(GraphTestFixture, AStarStats)
+{
+  // A 20x20 grid with unit weights, where the euclidean distance is an
+  // admissible heuristic.
+  const int n = 20;
+  UndirectedGraph<int, double> graph;
+  for (int i = 0; i < n * n; ++i)
+    graph.AddVertex(std::to_string(i), i, i);
+  for (int i = 0; i < n * n; ++i)
+  {
+    if (i % n < n - 1)
+      graph.AddEdge({i, i + 1}, 0, 1.0);
+    if (i / n < n - 1)
+      graph.AddEdge({i, i + n}, 0, 1.0);
+  }
+
+  const VertexId from = 0;
+  const VertexId to = n - 1;
+  auto zero = [](const VertexId &) {return 0.0;};
+  auto euclidean = [&](const VertexId &_id)
+  {
+    const double dx = static_cast<double>(_id % n) - (to % n);
+    const double dy = static_cast<double>(_id / n) - (to / n);
+    return std::sqrt(dx * dx + dy * dy);
+  };
+
+  SearchStats blind;
+  SearchStats guided;
+  const auto blindPath = AStar(graph, from, to, zero, blind);
+  const auto guidedPath = AStar(graph, from, to, euclidean, guided);
+  EXPECT_NEAR(n - 1.0, blindPath.first, 1e-9);
+  EXPECT_NEAR(n - 1.0, guidedPath.first, 1e-9);
+
+  EXPECT_EQ(1u, blind.searches);
+  EXPECT_EQ(1u, guided.searches);
+  EXPECT_LE(blind.expanded, graph.Vertices().size());
+  EXPECT_LT(guided.expanded, blind.expanded);
+  EXPECT_LT(guided.relaxed, blind.relaxed);
+  EXPECT_GE(guided.pushes, guided.expanded);
+  EXPECT_GE(guided.peakQueueSize, 1u);
+
+  // Missing vertices don't count as a search.
+  SearchStats missing;
+  EXPECT_TRUE(AStar(graph, from, n * n, zero, missing).second.empty());
+  EXPECT_EQ(0u, missing.expanded);
+}
+
 /////////////////////////////////////////////////
 TEST(GraphTestFixture, ConnectedComponents)
 {
@@ -310,6 +487,118 @@ TEST(GraphTestFixture, ConnectedComponents)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(GraphTestFixture, ConnectedComponentLabels)
+{
+  std::map<VertexId, unsigned int> labels = {{7, 7}};
+
+  // Empty graph.
+  UndirectedGraph<int, double> emptyGraph;
+  EXPECT_EQ(0u, ConnectedComponents(emptyGraph, labels));
+  EXPECT_TRUE(labels.empty());
+
+  UndirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}, {"D", 3, 3}, {"E", 4, 4},
+     {"F", 5, 5}},
+    // Edges.
+    {{{2, 0}, 2.0, 6.0},
+     {{4, 1}, 4.0, 5.0},
+     {{5, 2}, 1.0, 1.0}}
+  });
+
+  EXPECT_EQ(3u, ConnectedComponents(graph, labels));
+  std::map<VertexId, unsigned int> expected =
+    {{0, 0}, {1, 1}, {2, 0}, {3, 2}, {4, 1}, {5, 0}};
+  EXPECT_EQ(expected, labels);
+
+  // Same numbering as the copied components.
+  auto components = ConnectedComponents(graph);
+  ASSERT_EQ(3u, components.size());
+  for (unsigned int c = 0; c < components.size(); ++c)
+  {
+    for (auto const &v : components[c].Vertices())
+      EXPECT_EQ(c, labels.at(v.first));
+  }
+
+  // Directed graphs give their weakly connected components.
+  DirectedGraph<int, double> directed(
+  {
+    // Vertices.
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}, {"D", 3, 3}},
+    // Edges.
+    {{{3, 0}, 2.0}, {{3, 1}, 2.0}}
+  });
+  EXPECT_EQ(2u, ConnectedComponents(directed, labels));
+  expected = {{0, 0}, {1, 0}, {2, 1}, {3, 0}};
+  EXPECT_EQ(expected, labels);
+}
+
+/////////////////////////////////////////////////
+TEST(GraphTestFixture, ConnectedComponentViews)
+{
+  UndirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}, {"D", 3, 3}, {"E", 4, 4}},
+    // Edges.
+    {{{0, 2}, 2.0, 6.0},
+     {{1, 4}, 4.0, 5.0},
+     {{4, 1}, 3.0, 2.0}}
+  });
+
+  auto views = ConnectedComponentViews(graph);
+  ASSERT_EQ(3u, views.size());
+
+  std::vector<VertexId> expectedVertices = {0, 2};
+  EXPECT_EQ(expectedVertices, views[0].VertexIds());
+  EXPECT_EQ(1u, views[0].EdgeCount());
+  expectedVertices = {1, 4};
+  EXPECT_EQ(expectedVertices, views[1].VertexIds());
+  EXPECT_EQ(2u, views[1].EdgeCount());
+  expectedVertices = {3};
+  EXPECT_EQ(expectedVertices, views[2].VertexIds());
+  EXPECT_EQ(0u, views[2].EdgeCount());
+
+  // The views refer to the original vertices and edges.
+  EXPECT_EQ(&graph.VertexFromId(4), &views[1].VertexFromId(4));
+  EXPECT_FALSE(views[1].VertexFromId(0).Valid());
+  const EdgeId edge = views[0].EdgeIds()[0];
+  EXPECT_EQ(&graph.EdgeFromId(edge), &views[0].EdgeFromId(edge));
+  EXPECT_DOUBLE_EQ(6.0, views[0].EdgeFromId(edge).Weight());
+
+  // Same components as the copies.
+  auto components = ConnectedComponents(graph);
+  ASSERT_EQ(components.size(), views.size());
+  for (std::size_t c = 0; c < views.size(); ++c)
+  {
+    auto copy = views[c].ToGraph();
+    EXPECT_EQ(components[c].Vertices().size(), copy.Vertices().size());
+    EXPECT_EQ(components[c].Edges().size(), copy.Edges().size());
+    for (auto const &v : components[c].Vertices())
+      EXPECT_EQ(v.second.get().Name(), copy.VertexFromId(v.first).Name());
+  }
+
+  // Directed graphs are split in weakly connected components.
+  DirectedGraph<int, double> directed(
+  {
+    // Vertices.
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}},
+    // Edges.
+    {{{2, 0}, 2.0}}
+  });
+  auto directedViews = ConnectedComponentViews(directed);
+  ASSERT_EQ(2u, directedViews.size());
+  expectedVertices = {0, 2};
+  EXPECT_EQ(expectedVertices, directedViews[0].VertexIds());
+  EXPECT_EQ(1u, directedViews[0].EdgeCount());
+
+  // Empty graph.
+  UndirectedGraph<int, double> emptyGraph;
+  EXPECT_TRUE(ConnectedComponentViews(emptyGraph).empty());
+}
+
 /////////////////////////////////////////////////
 TEST(GraphTestFixture, ToUndirectedGraph)
 {
@@ -369,3 +658,80 @@ TEST(GraphTestFixture, ToUndirectedGraph)
   // std::cerr << directed << std::endl;
   // std::cerr << undirected << std::endl;
 }
+
+/////////////////////////////////////////////////
+TEST(GraphTestFixture, MinimumSpanningForest)
+{
+  // Two components, with a parallel edge, a self loop and a tie.
+  const UndirectedGraph<int, double> graph(
+  {
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}, {"D", 3, 3},
+     {"E", 4, 4}, {"F", 5, 5}, {"G", 6, 6}},
+    {{{0, 1}, 0.0, 4.0}, {{0, 1}, 0.0, 1.0}, {{1, 2}, 0.0, 2.0},
+     {{0, 2}, 0.0, 2.5}, {{2, 3}, 0.0, 3.0}, {{1, 3}, 0.0, 3.0},
+     {{3, 3}, 0.0, 0.1}, {{4, 5}, 0.0, 1.0}, {{5, 6}, 0.0, 1.0},
+     {{4, 6}, 0.0, 1.0}}
+  });
+
+  const auto forest = MinimumSpanningForest(graph);
+  EXPECT_EQ(&graph, &forest.Source());
+  EXPECT_EQ(7u, forest.VertexIds().size());
+  EXPECT_EQ(std::vector<EdgeId>({1, 2, 4, 7, 8}), forest.EdgeIds());
+
+  double weight = 0.0;
+  forest.ForEachEdge([&](const UndirectedEdge<double> &_edge)
+  {
+    weight += _edge.Weight();
+  });
+  EXPECT_DOUBLE_EQ(8.0, weight);
+
+  // Both components remain connected.
+  std::map<VertexId, unsigned int> labels;
+  EXPECT_EQ(2u, ConnectedComponents(graph, labels));
+
+  // Graphs without edges or vertices.
+  const UndirectedGraph<int, double> empty;
+  EXPECT_TRUE(MinimumSpanningForest(empty).EdgeIds().empty());
+  const UndirectedGraph<int, double> isolated({{{"A", 0, 0}}, {}});
+  const auto single = MinimumSpanningForest(isolated);
+  EXPECT_EQ(1u, single.VertexIds().size());
+  EXPECT_TRUE(single.EdgeIds().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(GraphTestFixture, TopologicalSort)
+{
+  // Task dependencies, with non consecutive Ids.
+  DirectedGraph<int, double> graph(
+  {
+    {{"shirt", 0, 1}, {"tie", 0, 3}, {"jacket", 0, 5}, {"belt", 0, 7},
+     {"pants", 0, 9}, {"shoes", 0, 11}, {"socks", 0, 13}},
+    {{{1, 3}, 0.0, 1.0}, {{3, 5}, 0.0, 1.0}, {{1, 7}, 0.0, 1.0},
+     {{7, 5}, 0.0, 1.0}, {{9, 7}, 0.0, 1.0}, {{9, 11}, 0.0, 1.0},
+     {{13, 11}, 0.0, 1.0}, {{9, 11}, 0.0, 1.0}}
+  });
+
+  const auto order = TopologicalSort(graph);
+  EXPECT_EQ(std::vector<VertexId>({1, 9, 13, 3, 7, 11, 5}), order);
+
+  // Every edge goes forward.
+  std::map<VertexId, std::size_t> rank;
+  for (std::size_t i = 0; i < order.size(); ++i)
+    rank[order[i]] = i;
+  for (auto const &edge : graph.Edges())
+  {
+    EXPECT_LT(rank.at(edge.second.get().Tail()),
+              rank.at(edge.second.get().Head()));
+  }
+
+  // A cycle can't be sorted.
+  graph.AddEdge({5, 1}, 0.0, 1.0);
+  EXPECT_TRUE(TopologicalSort(graph).empty());
+
+  // Neither can a self loop.
+  DirectedGraph<int, double> loop({{{"A", 0, 0}, {"B", 0, 1}},
+                                   {{{0, 1}, 0.0, 1.0}, {{1, 1}, 0.0, 1.0}}});
+  EXPECT_TRUE(TopologicalSort(loop).empty());
+
+  EXPECT_TRUE(TopologicalSort(DirectedGraph<int, double>()).empty());
+}
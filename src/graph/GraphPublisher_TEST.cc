@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+#include "gz/math/graph/GraphPublisher.hh"
+
+using namespace gz;
+using namespace math;
+using namespace graph;
+
+/////////////////////////////////////////////////
+TEST(GraphPublisherTest, Publish)
+{
+  GraphPublisher publisher;
+  auto empty = publisher.Load();
+  ASSERT_NE(nullptr, empty);
+  EXPECT_EQ(0u, empty->version);
+  EXPECT_TRUE(empty->graph.Empty());
+
+  DirectedGraph<int, double> graph(
+  {
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}},
+    {{{0, 1}, 0.0, 1.0}, {{1, 2}, 0.0, 1.0}}
+  });
+  EXPECT_EQ(1u, publisher.Publish(graph));
+  auto first = publisher.Load();
+  EXPECT_EQ(1u, first->version);
+  EXPECT_EQ(3u, first->graph.VertexCount());
+  EXPECT_DOUBLE_EQ(2.0, Dijkstra(first->graph, 0)[2].first);
+
+  // Edits don't affect published snapshots, and older snapshots stay
+  // valid after a new publication.
+  graph.SetEdgeWeight(1, 5.0);
+  graph.AddVertex("D", 3, 3);
+  EXPECT_DOUBLE_EQ(2.0, Dijkstra(first->graph, 0)[2].first);
+  EXPECT_EQ(2u, publisher.Publish(graph));
+  auto second = publisher.Load();
+  EXPECT_EQ(4u, second->graph.VertexCount());
+  EXPECT_DOUBLE_EQ(6.0, Dijkstra(second->graph, 0)[2].first);
+  EXPECT_EQ(3u, first->graph.VertexCount());
+  EXPECT_DOUBLE_EQ(2.0, Dijkstra(first->graph, 0)[2].first);
+
+  EXPECT_EQ(3u, publisher.Publish(CSRGraph(10, {{0, 9}})));
+  EXPECT_EQ(10u, publisher.Load()->graph.VertexCount());
+}
+
+/////////////////////////////////////////////////
+TEST(GraphPublisherTest, ConcurrentReaders)
+{
+  // A path graph that grows by one vertex per publication, so that every
+  // snapshot can be checked against its version.
+  GraphPublisher publisher;
+  std::atomic<bool> done{false};
+  std::atomic<int> errors{0};
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t)
+  {
+    readers.emplace_back([&]()
+    {
+      uint64_t last = 0;
+      while (!done)
+      {
+        auto snapshot = publisher.Load();
+        const CSRGraph &csr = snapshot->graph;
+        if (snapshot->version < last ||
+            csr.VertexCount() != snapshot->version)
+        {
+          ++errors;
+        }
+        last = snapshot->version;
+
+        if (csr.VertexCount() > 0)
+        {
+          const auto res = Dijkstra(csr, 0);
+          const VertexId lastId = csr.VertexCount() - 1;
+          if (static_cast<VertexId>(res[lastId].first) != lastId)
+            ++errors;
+        }
+      }
+    });
+  }
+
+  UndirectedGraph<int, double> graph;
+  for (VertexId i = 0; i < 200; ++i)
+  {
+    graph.AddVertex("", 0, i);
+    if (i > 0)
+      graph.AddEdge({i - 1, i}, 0.0, 1.0);
+    EXPECT_EQ(i + 1, publisher.Publish(graph));
+  }
+  done = true;
+  for (auto &reader : readers)
+    reader.join();
+
+  EXPECT_EQ(0, errors);
+  EXPECT_EQ(200u, publisher.Load()->graph.VertexCount());
+}
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -306,6 +307,73 @@ TEST(UndirectedGraphTest, IncidentsTo)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(UndirectedGraphTest, ForEachIncidentAndAdjacent)
+{
+  // Create a graph with edges [(v0--v0), (v0--v1), (v1--v2), (v2--v0)]
+  UndirectedGraph<int, double> graph(
+  {
+    {{"0", 0, 0}, {"1", 1, 1}, {"2", 2, 2}},
+    {{{0, 0}, 1.0}, {{0, 1}, 2.0}, {{1, 2}, 3.0}, {{2, 0}, 4.0}}
+  });
+
+  for (VertexId v = 0; v < 3; ++v)
+  {
+    // Incident edges match IncidentsFrom() and IncidentsTo().
+    std::vector<EdgeId> expected;
+    for (auto const &edgePair : graph.IncidentsFrom(v))
+      expected.push_back(edgePair.first);
+    std::vector<EdgeId> edges;
+    graph.ForEachIncidentFrom(v, [&](const UndirectedEdge<double> &_edge)
+    {
+      edges.push_back(_edge.Id());
+    });
+    EXPECT_EQ(expected, edges);
+
+    expected.clear();
+    for (auto const &edgePair : graph.IncidentsTo(v))
+      expected.push_back(edgePair.first);
+    edges.clear();
+    graph.ForEachIncidentTo(v, [&](const UndirectedEdge<double> &_edge)
+    {
+      edges.push_back(_edge.Id());
+    });
+    EXPECT_EQ(expected, edges);
+
+    // Adjacent vertices match AdjacentsFrom() and AdjacentsTo().
+    std::set<VertexId> expectedIds;
+    for (auto const &vertexPair : graph.AdjacentsFrom(v))
+      expectedIds.insert(vertexPair.first);
+    std::set<VertexId> ids;
+    graph.ForEachAdjacentFrom(v,
+      [&](const Vertex<int> &_vertex, const UndirectedEdge<double> &_edge)
+      {
+        EXPECT_EQ(_vertex.Id(), _edge.From(v));
+        ids.insert(_vertex.Id());
+      });
+    EXPECT_EQ(expectedIds, ids);
+
+    expectedIds.clear();
+    for (auto const &vertexPair : graph.AdjacentsTo(v))
+      expectedIds.insert(vertexPair.first);
+    ids.clear();
+    graph.ForEachAdjacentTo(v,
+      [&](const Vertex<int> &_vertex, const UndirectedEdge<double> &_edge)
+      {
+        EXPECT_EQ(_vertex.Id(), _edge.To(v));
+        ids.insert(_vertex.Id());
+      });
+    EXPECT_EQ(expectedIds, ids);
+  }
+
+  // Try an inexistent vertex.
+  int calls = 0;
+  auto countEdge = [&](const UndirectedEdge<double> &) {++calls;};
+  graph.ForEachIncidentFrom(kNullId, countEdge);
+  graph.ForEachIncidentTo(kNullId, countEdge);
+  EXPECT_EQ(0, calls);
+}
+
 /////////////////////////////////////////////////
 TEST(UndirectedGraphTest, InDegree)
 {
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <vector>
 
 #include "gz/math/graph/Graph.hh"
 
@@ -307,6 +308,64 @@ TYPED_TEST(GraphTestFixture, VerticesNames)
   }
 }
 
+/////////////////////////////////////////////////
+TYPED_TEST(GraphTestFixture, SetVertexName)
+{
+  TypeParam graph(
+  {
+    {{"vertex_0", 0}, {"common", 1}, {"common", 2}, {"common", 3}},
+    {}
+  });
+
+  // Vertices with the same name share it.
+  EXPECT_EQ(graph.VertexFromId(1).SharedName(),
+            graph.VertexFromId(3).SharedName());
+  EXPECT_NE(graph.VertexFromId(0).SharedName(),
+            graph.VertexFromId(1).SharedName());
+
+  EXPECT_TRUE(graph.SetVertexName(2, "vertex_0"));
+  EXPECT_FALSE(graph.SetVertexName(kNullId, "vertex_0"));
+  EXPECT_EQ("vertex_0", graph.VertexFromId(2).Name());
+  EXPECT_EQ(graph.VertexFromId(0).SharedName(),
+            graph.VertexFromId(2).SharedName());
+
+  auto vertices = graph.Vertices("vertex_0");
+  ASSERT_EQ(2u, vertices.size());
+  EXPECT_EQ(0u, vertices.begin()->first);
+  EXPECT_EQ(2u, vertices.rbegin()->first);
+  EXPECT_EQ(2u, graph.Vertices("common").size());
+
+  // A vertex renamed on its own is no longer found by its old name.
+  graph.VertexFromId(3).SetName("other");
+  EXPECT_EQ(1u, graph.Vertices("common").size());
+  EXPECT_TRUE(graph.Vertices("other").empty());
+
+  EXPECT_EQ(1u, graph.RemoveVertices("common"));
+  EXPECT_EQ(2u, graph.RemoveVertices("vertex_0"));
+  EXPECT_TRUE(graph.Vertices("vertex_0").empty());
+
+  // Only the new vertex and the map of names hold the name now.
+  auto &vertex = graph.AddVertex("vertex_0", 5);
+  EXPECT_EQ(2, graph.VertexFromId(vertex.Id()).SharedName().use_count());
+  EXPECT_EQ(1u, graph.Vertices("vertex_0").size());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(GraphTestFixture, SetEdgeWeight)
+{
+  TypeParam graph(
+  {
+    {{"A", 0}, {"B", 1}},
+    {{{0, 1}, 2, 3.0}}
+  });
+
+  EXPECT_TRUE(graph.SetEdgeWeight(0, 5.0));
+  EXPECT_DOUBLE_EQ(5.0, graph.EdgeFromId(0).Weight());
+  EXPECT_DOUBLE_EQ(5.0, graph.EdgeFromVertices(0, 1).Weight());
+  EXPECT_FALSE(graph.SetEdgeWeight(1, 5.0));
+  EXPECT_FALSE(graph.SetEdgeWeight(kNullId, 5.0));
+}
+
 /////////////////////////////////////////////////
 TYPED_TEST(GraphTestFixture, Empty)
 {
@@ -360,6 +419,63 @@ TYPED_TEST(GraphTestFixture, AddVertex)
   }
 }
 
+/////////////////////////////////////////////////
+TYPED_TEST(GraphTestFixture, Assign)
+{
+  // Vertices with and without Ids, some repeated, and edges with a
+  // missing vertex.
+  const std::vector<Vertex<int>> vertices = {{"a", 0}, {"b", 1, 1},
+      {"c", 2}, {"d", 3, 1}, {"a", 4, 7}, {"e", 5}, {"f", 6, 2}};
+  const std::vector<EdgeInitializer<double>> edges = {{{0, 1}, 0.5},
+      {{1, 9}, 1.0}, {{7, 0}, 2.0, 3.0}, {{3, 3}, 4.0}, {{2, 7}, 5.0}};
+
+  TypeParam expected;
+  for (auto const &v : vertices)
+    expected.AddVertex(v.Name(), v.Data(), v.Id());
+  for (auto const &e : edges)
+    expected.AddEdge(e.vertices, e.data, e.weight);
+
+  TypeParam graph;
+  graph.AddVertex("old", 0);
+  EXPECT_FALSE(graph.Assign(vertices, edges));
+
+  ASSERT_EQ(expected.Vertices().size(), graph.Vertices().size());
+  for (auto const &[id, vertex] : expected.Vertices())
+  {
+    const auto &v = graph.VertexFromId(id);
+    EXPECT_EQ(vertex.get().Name(), v.Name());
+    EXPECT_EQ(vertex.get().Data(), v.Data());
+    EXPECT_EQ(expected.IncidentsFrom(id).size(),
+              graph.IncidentsFrom(id).size());
+    EXPECT_EQ(expected.IncidentsTo(id).size(), graph.IncidentsTo(id).size());
+  }
+  ASSERT_EQ(expected.Edges().size(), graph.Edges().size());
+  for (auto const &[id, edge] : expected.Edges())
+  {
+    const auto &e = graph.EdgeFromId(id);
+    EXPECT_EQ(edge.get().Vertices(), e.Vertices());
+    EXPECT_DOUBLE_EQ(edge.get().Data(), e.Data());
+    EXPECT_DOUBLE_EQ(edge.get().Weight(), e.Weight());
+  }
+  EXPECT_EQ(2u, graph.Vertices("a").size());
+  EXPECT_TRUE(graph.Vertices("old").empty());
+
+  // New elements get the same Ids.
+  EXPECT_EQ(expected.AddVertex("g", 7).Id(), graph.AddVertex("g", 7).Id());
+  EXPECT_EQ(expected.AddEdge({0, 2}, 1.0).Id(),
+            graph.AddEdge({0, 2}, 1.0).Id());
+
+  // Elements that are all valid.
+  EXPECT_TRUE(graph.Assign({{"x", 1}, {"y", 2}, {"x", 3}},
+                           {{{0, 1}, 1.0}, {{1, 2}, 2.0}}));
+  EXPECT_EQ(3u, graph.Vertices().size());
+  EXPECT_EQ(2u, graph.Vertices("x").size());
+  EXPECT_EQ(1u, graph.EdgeFromVertices(1, 2).Id());
+
+  EXPECT_TRUE(graph.Assign({}, {}));
+  EXPECT_TRUE(graph.Empty());
+}
+
 /////////////////////////////////////////////////
 TYPED_TEST(GraphTestFixture, EdgeFromVertices)
 {
@@ -457,3 +573,37 @@ TYPED_TEST(GraphTestFixture, EdgelessOutDegree)
     EXPECT_EQ(0u, graph.OutDegree(idVertex.first));
   }
 }
+
+/////////////////////////////////////////////////
+TYPED_TEST(GraphTestFixture, ForEachVertexAndEdge)
+{
+  TypeParam graph(
+  {
+    // Vertices.
+    {{"A", 0, 5}, {"B", 1, 1}, {"C", 2, 3}},
+    // Edges.
+    {{{5, 1}, 2.0}, {{1, 3}, 3.0}, {{3, 5}, 4.0}}
+  });
+
+  std::vector<VertexId> vertices;
+  graph.ForEachVertex([&vertices](const Vertex<int> &_v)
+  {
+    vertices.push_back(_v.Id());
+  });
+  std::vector<VertexId> expectedVertices = {1, 3, 5};
+  EXPECT_EQ(expectedVertices, vertices);
+
+  std::vector<double> data;
+  graph.ForEachEdge([&data](const auto &_edge)
+  {
+    data.push_back(_edge.Data());
+  });
+  std::vector<double> expectedData = {2.0, 3.0, 4.0};
+  EXPECT_EQ(expectedData, data);
+
+  TypeParam empty;
+  std::size_t calls = 0;
+  empty.ForEachVertex([&calls](const Vertex<int> &) {++calls;});
+  empty.ForEachEdge([&calls](const auto &) {++calls;});
+  EXPECT_EQ(0u, calls);
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+#include "gz/math/graph/IncrementalShortestPath.hh"
+
+using namespace gz;
+using namespace math;
+using namespace graph;
+
+// Define a test fixture class template.
+template <class T>
+class IncrementalShortestPathTestFixture : public testing::Test
+{
+};
+
+// The list of graphs we want to test.
+using GraphTypes = ::testing::Types<DirectedGraph<int, double>,
+                                    UndirectedGraph<int, double>>;
+TYPED_TEST_CASE(IncrementalShortestPathTestFixture, GraphTypes);
+
+/////////////////////////////////////////////////
+/// \brief Check that a planner agrees with Dijkstra for every vertex.
+/// \param[in] _graph The graph.
+/// \param[in] _planner Planner from vertex _from.
+/// \param[in] _from The source vertex.
+template<typename G, typename P>
+void ExpectDijkstra(const G &_graph, P &_planner, const VertexId &_from)
+{
+  const auto expected = Dijkstra(_graph, _from);
+  for (auto const &entry : expected)
+  {
+    const auto path = _planner.ShortestPath(entry.first);
+    EXPECT_DOUBLE_EQ(entry.second.first, path.first);
+    if (path.first < MAX_D)
+    {
+      ASSERT_FALSE(path.second.empty());
+      EXPECT_EQ(_from, path.second.front());
+      EXPECT_EQ(entry.first, path.second.back());
+
+      // The path follows edges and adds up to its cost.
+      double cost = 0.0;
+      for (std::size_t i = 1; i < path.second.size(); ++i)
+      {
+        double weight = MAX_D;
+        _graph.ForEachIncidentFrom(path.second[i - 1], [&](auto &_edge)
+        {
+          if (_edge.From(path.second[i - 1]) == path.second[i])
+            weight = std::min(weight, _edge.Weight());
+        });
+        cost += weight;
+      }
+      EXPECT_NEAR(path.first, cost, 1e-9);
+    }
+    else
+    {
+      EXPECT_TRUE(path.second.empty());
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(IncrementalShortestPathTestFixture, WeightChanges)
+{
+  TypeParam graph(
+  {
+    // Vertices.
+    {{"0", 0, 0}, {"1", 1, 1}, {"2", 2, 2}, {"3", 3, 3}, {"4", 4, 4},
+     {"5", 5, 5}},
+    // Edges.
+    {{{0, 1}, 2.0, 6.0}, {{0, 3}, 3.0, 1.0},
+     {{1, 2}, 4.0, 5.0}, {{1, 3}, 4.0, 2.0}, {{1, 4}, 4.0, 2.0},
+     {{2, 4}, 2.0, 5.0},
+     {{3, 4}, 2.0, 1.0}}
+  });
+
+  IncrementalShortestPath planner(graph, 0);
+  ASSERT_TRUE(planner.Valid());
+  ExpectDijkstra(graph, planner, 0);
+  const std::size_t initial = planner.ExpandedCount();
+  EXPECT_GT(initial, 0u);
+
+  // Nothing to repair.
+  EXPECT_EQ(0u, planner.Repair());
+
+  // Increase, block, decrease and restore weights.
+  const double inf = std::numeric_limits<double>::infinity();
+  for (auto const &change : std::vector<std::pair<EdgeId, double>>({
+      {1, 10.0}, {6, inf}, {0, 0.5}, {1, 1.0}, {6, 1.0}, {3, inf},
+      {4, inf}, {0, inf}}))
+  {
+    ASSERT_TRUE(graph.SetEdgeWeight(change.first, change.second));
+    EXPECT_TRUE(planner.UpdateEdge(change.first));
+    ExpectDijkstra(graph, planner, 0);
+  }
+  EXPECT_DOUBLE_EQ(MAX_D, planner.Cost(5));
+  EXPECT_TRUE(planner.ShortestPath(5).second.empty());
+
+  // Inexistent vertices and edges.
+  EXPECT_FALSE(planner.UpdateEdge(99));
+  EXPECT_DOUBLE_EQ(MAX_D, planner.Cost(99));
+  EXPECT_DOUBLE_EQ(MAX_D, planner.ShortestPath().first);
+
+  IncrementalShortestPath invalid(graph, 99);
+  EXPECT_FALSE(invalid.Valid());
+  EXPECT_DOUBLE_EQ(MAX_D, invalid.Cost(0));
+  EXPECT_TRUE(invalid.UpdateEdge(0));
+  IncrementalShortestPath invalidTo(graph, 0, 99);
+  EXPECT_FALSE(invalidTo.Valid());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(IncrementalShortestPathTestFixture, ZeroWeights)
+{
+  // 1 and 2 are joined by a zero weight edge, and 2 has a zero weight
+  // loop. Increasing the cost of 1 must not leave it supported by 2.
+  TypeParam graph(
+  {
+    // Vertices.
+    {{"0", 0, 0}, {"1", 1, 1}, {"2", 2, 2}, {"3", 3, 3}},
+    // Edges.
+    {{{0, 1}, 0.0, 2.0}, {{1, 2}, 0.0, 0.0}, {{2, 2}, 0.0, 0.0},
+     {{0, 3}, 0.0, 9.0}, {{3, 2}, 0.0, 0.0}}
+  });
+
+  IncrementalShortestPath planner(graph, 0);
+  ExpectDijkstra(graph, planner, 0);
+  EXPECT_DOUBLE_EQ(2.0, planner.Cost(1));
+  EXPECT_DOUBLE_EQ(2.0, planner.Cost(2));
+
+  ASSERT_TRUE(graph.SetEdgeWeight(0, 5.0));
+  EXPECT_TRUE(planner.UpdateEdge(0));
+  EXPECT_DOUBLE_EQ(5.0, planner.Cost(1));
+  ExpectDijkstra(graph, planner, 0);
+
+  const double inf = std::numeric_limits<double>::infinity();
+  ASSERT_TRUE(graph.SetEdgeWeight(0, inf));
+  EXPECT_TRUE(planner.UpdateEdge(0));
+  ExpectDijkstra(graph, planner, 0);
+
+  ASSERT_TRUE(graph.SetEdgeWeight(3, 1.0));
+  EXPECT_TRUE(planner.UpdateEdge(3));
+  ExpectDijkstra(graph, planner, 0);
+
+  ASSERT_TRUE(graph.SetEdgeWeight(0, 0.0));
+  EXPECT_TRUE(planner.UpdateEdge(0));
+  ExpectDijkstra(graph, planner, 0);
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(IncrementalShortestPathTestFixture, RandomZeroWeights)
+{
+  // Random graphs where a third of the weights are zero, so that zero
+  // weight cycles are common.
+  uint32_t seed = 7;
+  auto random = [&seed](const uint32_t _n)
+  {
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 16) % _n;
+  };
+  auto weight = [&random]()
+  {
+    return random(3) == 0 ? 0.0 : static_cast<double>(random(5) + 1);
+  };
+
+  for (int trial = 0; trial < 20; ++trial)
+  {
+    const VertexId size = 12;
+    std::vector<Vertex<int>> vertices;
+    std::vector<EdgeInitializer<double>> edges;
+    for (VertexId i = 0; i < size; ++i)
+      vertices.push_back(Vertex<int>("", 0, i));
+    for (int i = 0; i < 30; ++i)
+      edges.push_back({{random(size), random(size)}, 0.0, weight()});
+    TypeParam graph(vertices, edges);
+
+    IncrementalShortestPath planner(graph, 0);
+    ExpectDijkstra(graph, planner, 0);
+
+    for (int i = 0; i < 20; ++i)
+    {
+      const EdgeId id = random(static_cast<uint32_t>(edges.size()));
+      const double w = random(4) == 0 ?
+          std::numeric_limits<double>::infinity() : weight();
+      graph.SetEdgeWeight(id, w);
+      planner.UpdateEdge(id);
+      ExpectDijkstra(graph, planner, 0);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(IncrementalShortestPathTest, Grid)
+{
+  // An undirected grid with pseudo random weights.
+  const VertexId width = 25;
+  std::vector<Vertex<int>> vertices;
+  std::vector<EdgeInitializer<double>> edges;
+  uint32_t seed = 3;
+  auto random = [&seed]()
+  {
+    seed = seed * 1103515245u + 12345u;
+    return static_cast<double>((seed >> 16) % 100) / 10.0 + 1.0;
+  };
+  for (VertexId i = 0; i < width * width; ++i)
+  {
+    vertices.push_back(Vertex<int>("", 0, i));
+    if (i % width + 1 < width)
+      edges.push_back({{i, i + 1}, 0.0, random()});
+    if (i + width < width * width)
+      edges.push_back({{i, i + width}, 0.0, random()});
+  }
+  UndirectedGraph<int, double> graph(vertices, edges);
+
+  IncrementalShortestPath<int, double, UndirectedEdge<double>> planner(
+      graph, 0);
+  ExpectDijkstra(graph, planner, 0);
+
+  // A local change only expands the vertices whose cost changes.
+  const EdgeId far = graph.EdgeFromVertices(width * width - 2,
+                                            width * width - 1).Id();
+  graph.SetEdgeWeight(far, 0.5 * graph.EdgeFromId(far).Weight());
+  planner.UpdateEdge(far);
+  EXPECT_LT(planner.Repair(), 10u);
+  ExpectDijkstra(graph, planner, 0);
+
+  // Several changes at once, including blocked edges.
+  for (int round = 0; round < 5; ++round)
+  {
+    for (int i = 0; i < 4; ++i)
+    {
+      const EdgeId id = static_cast<EdgeId>(random() * 97) % edges.size();
+      const double weight = round % 2 ?
+          std::numeric_limits<double>::infinity() : random();
+      graph.SetEdgeWeight(id, weight);
+      planner.UpdateEdge(id);
+    }
+    ExpectDijkstra(graph, planner, 0);
+  }
+
+  // With a destination and a consistent heuristic, only its path is kept
+  // up to date, expanding fewer vertices.
+  const VertexId to = width * (width / 2) + width / 2;
+  auto manhattan = [&](const VertexId &_id)
+  {
+    const double dx = std::abs(static_cast<double>(_id % width) -
+                               static_cast<double>(to % width));
+    const double dy = std::abs(static_cast<double>(_id / width) -
+                               static_cast<double>(to / width));
+    return dx + dy;
+  };
+  IncrementalShortestPath<int, double, UndirectedEdge<double>> focused(
+      graph, 0, to, manhattan);
+  auto expected = Dijkstra(graph, 0);
+  EXPECT_DOUBLE_EQ(expected.at(to).first, focused.ShortestPath().first);
+  EXPECT_LT(focused.ExpandedCount(), width * width);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    const EdgeId id = static_cast<EdgeId>(random() * 89) % edges.size();
+    graph.SetEdgeWeight(id, random());
+    focused.UpdateEdge(id);
+    expected = Dijkstra(graph, 0);
+    const auto path = focused.ShortestPath();
+    EXPECT_DOUBLE_EQ(expected.at(to).first, path.first);
+    ASSERT_FALSE(path.second.empty());
+    EXPECT_EQ(to, path.second.back());
+  }
+}
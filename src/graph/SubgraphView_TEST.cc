@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/SubgraphView.hh"
+
+using namespace gz;
+using namespace math;
+using namespace graph;
+
+// Define a test fixture class template.
+template <class T>
+class SubgraphViewTestFixture : public testing::Test
+{
+};
+
+// The list of graphs we want to test.
+using GraphTypes = ::testing::Types<DirectedGraph<int, double>,
+                                    UndirectedGraph<int, double>>;
+TYPED_TEST_CASE(SubgraphViewTestFixture, GraphTypes);
+
+// View type of a graph type.
+template <typename G>
+struct ViewOf;
+template <typename V, typename E, typename EdgeType>
+struct ViewOf<Graph<V, E, EdgeType>>
+{
+  using Type = SubgraphView<V, E, EdgeType>;
+};
+
+/////////////////////////////////////////////////
+TYPED_TEST(SubgraphViewTestFixture, Induced)
+{
+  TypeParam graph(
+  {
+    // Vertices.
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}, {"D", 3, 3}},
+    // Edges.
+    {{{0, 1}, 2.0}, {{1, 2}, 3.0}, {{2, 0}, 4.0}, {{2, 3}, 5.0},
+     {{2, 2}, 6.0}}
+  });
+
+  // Unsorted, duplicated and inexistent vertices.
+  typename ViewOf<TypeParam>::Type view(
+    graph, {2, 0, 99, 1, 2});
+  ASSERT_EQ(3u, view.VertexCount());
+  std::vector<VertexId> expectedVertices = {0, 1, 2};
+  EXPECT_EQ(expectedVertices, view.VertexIds());
+  EXPECT_FALSE(view.Empty());
+  EXPECT_EQ(&graph, &view.Source());
+
+  // Every edge between two of the vertices, including the self loop.
+  std::vector<double> data;
+  view.ForEachEdge([&data](const auto &_edge)
+  {
+    data.push_back(_edge.Data());
+  });
+  std::vector<double> expectedData = {2.0, 3.0, 4.0, 6.0};
+  EXPECT_EQ(expectedData, data);
+  EXPECT_EQ(4u, view.EdgeCount());
+
+  EXPECT_TRUE(view.HasVertex(1));
+  EXPECT_FALSE(view.HasVertex(3));
+  EXPECT_EQ("B", view.VertexFromId(1).Name());
+  EXPECT_FALSE(view.VertexFromId(3).Valid());
+  const EdgeId outside = graph.EdgeFromVertices(2, 3).Id();
+  EXPECT_FALSE(view.HasEdge(outside));
+  EXPECT_FALSE(view.EdgeFromId(outside).Valid());
+
+  std::vector<VertexId> vertices;
+  view.ForEachVertex([&vertices](const Vertex<int> &_v)
+  {
+    vertices.push_back(_v.Id());
+  });
+  EXPECT_EQ(expectedVertices, vertices);
+
+  // Independent copy.
+  auto copy = view.ToGraph();
+  EXPECT_EQ(3u, copy.Vertices().size());
+  EXPECT_EQ(4u, copy.Edges().size());
+  EXPECT_EQ("C", copy.VertexFromId(2).Name());
+
+  // Empty view.
+  typename ViewOf<TypeParam>::Type empty(graph, {});
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ(0u, empty.EdgeCount());
+  EXPECT_TRUE(empty.ToGraph().Empty());
+}
@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include <iostream>
 #include <string>
+#include <utility>
 
 #include "gz/math/graph/Vertex.hh"
 
@@ -54,6 +55,31 @@ TEST(VertexTest, Accessors)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(VertexTest, Move)
+{
+  Vertex<int> vertex("my_name", 5, 2);
+  Vertex<int> moved(std::move(vertex));
+  EXPECT_EQ("my_name", moved.Name());
+  EXPECT_EQ(5, moved.Data());
+  EXPECT_EQ(2u, moved.Id());
+
+  // The moved-from vertex has an empty name, as with a moved-from string.
+  ASSERT_NE(nullptr, vertex.SharedName());
+  EXPECT_TRUE(vertex.Name().empty());
+
+  Vertex<int> assigned("other", 1, 3);
+  assigned = std::move(moved);
+  EXPECT_EQ("my_name", assigned.Name());
+  EXPECT_EQ(2u, assigned.Id());
+  ASSERT_NE(nullptr, moved.SharedName());
+  EXPECT_TRUE(moved.Name().empty());
+
+  // A moved-from vertex can be reused.
+  moved.SetName("reused");
+  EXPECT_EQ("reused", moved.Name());
+}
+
 /////////////////////////////////////////////////
 TEST(VertexTest, StreamInsertion)
 {
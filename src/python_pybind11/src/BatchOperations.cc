@@ -0,0 +1,417 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <limits>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <pybind11/numpy.h>
+
+#include "BatchOperations.hh"
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Kmeans.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/SphericalCoordinates.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/Vector3SoA.hh>
+
+namespace ignition
+{
+namespace math
+{
+namespace python
+{
+/// \brief Input array type. Arrays of float64 in C order are used in place,
+/// anything else is converted once by numpy.
+using InputArray =
+    py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// \brief Get the number of rows of an input array.
+/// \param[in] _a Array of shape (N, _cols), or (_cols,) for a single row.
+/// \param[in] _cols Expected number of columns.
+/// \param[in] _name Name of the argument, used in error messages.
+/// \return Number of rows of the array.
+py::ssize_t Rows(const InputArray &_a, const py::ssize_t _cols,
+                 const char *_name)
+{
+  if (_a.ndim() == 1 && _a.shape(0) == _cols)
+    return 1;
+  if (_a.ndim() == 2 && _a.shape(1) == _cols)
+    return _a.shape(0);
+
+  throw py::value_error(std::string(_name) + " must have shape (N, " +
+      std::to_string(_cols) + ") or (" + std::to_string(_cols) + ",)");
+}
+
+/// \brief Get the number of rows of the result of an operation on two
+/// arrays. An array with a single row is broadcast to the other one.
+/// \param[in] _rowsA Number of rows of the first array.
+/// \param[in] _rowsB Number of rows of the second array.
+/// \return Number of rows of the result.
+py::ssize_t BroadcastRows(const py::ssize_t _rowsA, const py::ssize_t _rowsB)
+{
+  if (_rowsA == _rowsB || _rowsB == 1)
+    return _rowsA;
+  if (_rowsA == 1)
+    return _rowsB;
+
+  throw py::value_error("arrays with " + std::to_string(_rowsA) + " and " +
+      std::to_string(_rowsB) + " rows cannot be broadcast together");
+}
+
+/// \brief Get the array that receives the result of an operation.
+/// \param[in] _out None to allocate a new array, or a writeable C ordered
+/// array of the result type and shape, which is filled in place.
+/// \param[in] _rows Number of rows of the result.
+/// \param[in] _cols Number of columns of the result, or 0 for a one
+/// dimensional result.
+/// \return The output array.
+template<typename T>
+py::array_t<T, py::array::c_style> Output(const py::object &_out,
+    const py::ssize_t _rows, const py::ssize_t _cols)
+{
+  using Array = py::array_t<T, py::array::c_style>;
+  if (_out.is_none())
+  {
+    if (_cols == 0)
+      return Array(_rows);
+    return Array({_rows, _cols});
+  }
+
+  if (!py::isinstance<Array>(_out))
+  {
+    throw py::type_error("out must be a C contiguous array of " +
+        std::string(py::str(py::dtype::of<T>())));
+  }
+
+  Array res = py::reinterpret_borrow<Array>(_out);
+  const bool shapeOk = _cols == 0 ?
+      (res.ndim() == 1 && res.shape(0) == _rows) :
+      (res.ndim() == 2 && res.shape(0) == _rows && res.shape(1) == _cols);
+  if (!shapeOk)
+    throw py::value_error("out does not have the shape of the result");
+  if (!res.writeable())
+    throw py::value_error("out is not writeable");
+
+  return res;
+}
+
+/// \brief Apply a pose to a set of points.
+/// \param[in] _pose The pose.
+/// \param[in] _points Array of shape (N, 3).
+/// \param[in] _out Optional output array of shape (N, 3).
+/// \return Transformed points, _pose.CoordPositionAdd(p) for each point p.
+py::array_t<double, py::array::c_style> TransformPoints(
+    const gz::math::Pose3d &_pose, const InputArray &_points,
+    const py::object &_out)
+{
+  const py::ssize_t rows = Rows(_points, 3, "points");
+  auto res = Output<double>(_out, rows, 3);
+
+  const double *in = _points.data();
+  double *out = res.mutable_data();
+  const gz::math::Pose3d pose = _pose;
+  {
+    py::gil_scoped_release release;
+    for (py::ssize_t i = 0; i < rows; ++i, in += 3, out += 3)
+    {
+      const gz::math::Vector3d p =
+          pose.CoordPositionAdd(gz::math::Vector3d(in[0], in[1], in[2]));
+      out[0] = p.X();
+      out[1] = p.Y();
+      out[2] = p.Z();
+    }
+  }
+  return res;
+}
+
+/// \brief Rotate a set of vectors.
+/// \param[in] _quats Array of shape (N, 4) or (4,), in (w, x, y, z) order.
+/// \param[in] _vectors Array of shape (N, 3) or (3,).
+/// \param[in] _out Optional output array of shape (N, 3).
+/// \return Rotated vectors, q.RotateVector(v) for each pair.
+py::array_t<double, py::array::c_style> RotateVectors(
+    const InputArray &_quats, const InputArray &_vectors,
+    const py::object &_out)
+{
+  const py::ssize_t rowsQ = Rows(_quats, 4, "quaternions");
+  const py::ssize_t rowsV = Rows(_vectors, 3, "vectors");
+  const py::ssize_t rows = BroadcastRows(rowsQ, rowsV);
+  auto res = Output<double>(_out, rows, 3);
+
+  const double *q = _quats.data();
+  const double *v = _vectors.data();
+  const py::ssize_t strideQ = rowsQ == 1 ? 0 : 4;
+  const py::ssize_t strideV = rowsV == 1 ? 0 : 3;
+  double *out = res.mutable_data();
+  {
+    py::gil_scoped_release release;
+    for (py::ssize_t i = 0; i < rows; ++i, q += strideQ, v += strideV)
+    {
+      const gz::math::Vector3d r =
+          gz::math::Quaterniond(q[0], q[1], q[2], q[3]).RotateVector(
+          gz::math::Vector3d(v[0], v[1], v[2]));
+      out[3*i] = r.X();
+      out[3*i+1] = r.Y();
+      out[3*i+2] = r.Z();
+    }
+  }
+  return res;
+}
+
+/// \brief Multiply two sets of quaternions.
+/// \param[in] _a Array of shape (N, 4) or (4,), in (w, x, y, z) order.
+/// \param[in] _b Array of shape (N, 4) or (4,), in (w, x, y, z) order.
+/// \param[in] _out Optional output array of shape (N, 4).
+/// \return Products a * b of each pair.
+py::array_t<double, py::array::c_style> QuaternionMultiply(
+    const InputArray &_a, const InputArray &_b, const py::object &_out)
+{
+  const py::ssize_t rowsA = Rows(_a, 4, "a");
+  const py::ssize_t rowsB = Rows(_b, 4, "b");
+  const py::ssize_t rows = BroadcastRows(rowsA, rowsB);
+  auto res = Output<double>(_out, rows, 4);
+
+  const double *a = _a.data();
+  const double *b = _b.data();
+  const py::ssize_t strideA = rowsA == 1 ? 0 : 4;
+  const py::ssize_t strideB = rowsB == 1 ? 0 : 4;
+  double *out = res.mutable_data();
+  {
+    py::gil_scoped_release release;
+    for (py::ssize_t i = 0; i < rows; ++i, a += strideA, b += strideB)
+    {
+      const gz::math::Quaterniond r =
+          gz::math::Quaterniond(a[0], a[1], a[2], a[3]) *
+          gz::math::Quaterniond(b[0], b[1], b[2], b[3]);
+      out[4*i] = r.W();
+      out[4*i+1] = r.X();
+      out[4*i+2] = r.Y();
+      out[4*i+3] = r.Z();
+    }
+  }
+  return res;
+}
+
+/// \brief Intersect a set of rays with a box.
+/// \param[in] _box The box.
+/// \param[in] _origins Ray origins, array of shape (N, 3) or (3,).
+/// \param[in] _dirs Ray directions, array of shape (N, 3) or (3,).
+/// \param[in] _min Minimum allowed distance.
+/// \param[in] _max Maximum allowed distance.
+/// \return Tuple of an array of N booleans, true for the rays that
+/// intersect the box, and an array of N distances to the intersection
+/// points, as returned by AxisAlignedBox::IntersectDist.
+std::tuple<py::array_t<bool, py::array::c_style>,
+           py::array_t<double, py::array::c_style>> BoxIntersectDist(
+    const gz::math::AxisAlignedBox &_box, const InputArray &_origins,
+    const InputArray &_dirs, const double _min, const double _max)
+{
+  const py::ssize_t rowsO = Rows(_origins, 3, "origins");
+  const py::ssize_t rowsD = Rows(_dirs, 3, "directions");
+  const py::ssize_t rows = BroadcastRows(rowsO, rowsD);
+  auto hits = Output<bool>(py::none(), rows, 0);
+  auto dists = Output<double>(py::none(), rows, 0);
+
+  const double *o = _origins.data();
+  const double *d = _dirs.data();
+  const py::ssize_t strideO = rowsO == 1 ? 0 : 3;
+  const py::ssize_t strideD = rowsD == 1 ? 0 : 3;
+  bool *hit = hits.mutable_data();
+  double *dist = dists.mutable_data();
+  const gz::math::AxisAlignedBox box = _box;
+  {
+    py::gil_scoped_release release;
+    for (py::ssize_t i = 0; i < rows; ++i, o += strideO, d += strideD)
+    {
+      std::tie(hit[i], dist[i]) = box.IntersectDist(
+          gz::math::Vector3d(o[0], o[1], o[2]),
+          gz::math::Vector3d(d[0], d[1], d[2]), _min, _max);
+    }
+  }
+  return std::make_tuple(hits, dists);
+}
+
+/// \brief Check which points of a set are inside a box.
+/// \param[in] _box The box.
+/// \param[in] _points Array of shape (N, 3).
+/// \param[in] _out Optional boolean output array of shape (N,).
+/// \return Array of N booleans, _box.Contains(p) for each point p.
+py::array_t<bool, py::array::c_style> BoxContains(
+    const gz::math::AxisAlignedBox &_box, const InputArray &_points,
+    const py::object &_out)
+{
+  const py::ssize_t rows = Rows(_points, 3, "points");
+  auto res = Output<bool>(_out, rows, 0);
+
+  const double *p = _points.data();
+  bool *out = res.mutable_data();
+  const gz::math::AxisAlignedBox box = _box;
+  {
+    py::gil_scoped_release release;
+    for (py::ssize_t i = 0; i < rows; ++i, p += 3)
+      out[i] = box.Contains(gz::math::Vector3d(p[0], p[1], p[2]));
+  }
+  return res;
+}
+
+/// \brief Convert a set of positions between coordinate frames.
+/// \param[in] _sc The spherical coordinates defining the frames.
+/// \param[in] _pos Positions, array of shape (N, 3).
+/// \param[in] _in Frame of the positions.
+/// \param[in] _outType Frame of the result.
+/// \param[in] _out Optional output array of shape (N, 3).
+/// \return Transformed positions.
+py::array_t<double, py::array::c_style> SphericalPositionTransform(
+    const gz::math::SphericalCoordinates &_sc, const InputArray &_pos,
+    const gz::math::SphericalCoordinates::CoordinateType _in,
+    const gz::math::SphericalCoordinates::CoordinateType _outType,
+    const py::object &_out)
+{
+  const py::ssize_t rows = Rows(_pos, 3, "positions");
+  auto res = Output<double>(_out, rows, 3);
+
+  const double *in = _pos.data();
+  double *out = res.mutable_data();
+  bool ok = false;
+  {
+    py::gil_scoped_release release;
+
+    // The batch transform works on a structure of arrays.
+    gz::math::Vector3SoA<double> soa(static_cast<std::size_t>(rows));
+    double *x = soa.XData();
+    double *y = soa.YData();
+    double *z = soa.ZData();
+    for (py::ssize_t i = 0; i < rows; ++i)
+    {
+      x[i] = in[3*i];
+      y[i] = in[3*i+1];
+      z[i] = in[3*i+2];
+    }
+
+    ok = _sc.PositionTransform(soa, _in, _outType, soa);
+
+    for (py::ssize_t i = 0; i < rows; ++i)
+    {
+      out[3*i] = x[i];
+      out[3*i+1] = y[i];
+      out[3*i+2] = z[i];
+    }
+  }
+
+  if (!ok)
+    throw py::value_error("invalid coordinate type");
+
+  return res;
+}
+
+/// \brief Cluster a set of points with the k-means algorithm.
+/// \param[in] _points Observations, array of shape (N, 3).
+/// \param[in] _k Number of clusters.
+/// \return Tuple of the success flag, an array of shape (_k, 3) with the
+/// centroids and an array of N labels, as returned by Kmeans.cluster. The
+/// arrays are empty on failure.
+std::tuple<bool, py::array_t<double, py::array::c_style>,
+           py::array_t<unsigned int, py::array::c_style>> KmeansCluster(
+    const InputArray &_points, const int _k)
+{
+  const py::ssize_t rows = Rows(_points, 3, "points");
+  const py::ssize_t clusters = _k > 0 ? _k : 0;
+  auto centroids = Output<double>(py::none(), clusters, 3);
+  auto labels = Output<unsigned int>(py::none(), rows, 0);
+
+  const double *in = _points.data();
+  double *out = centroids.mutable_data();
+  unsigned int *label = labels.mutable_data();
+  bool ok = false;
+  {
+    py::gil_scoped_release release;
+    std::vector<gz::math::Vector3d> obs(static_cast<std::size_t>(rows));
+    for (py::ssize_t i = 0; i < rows; ++i)
+      obs[i].Set(in[3*i], in[3*i+1], in[3*i+2]);
+
+    gz::math::Kmeans kmeans(std::move(obs));
+    std::vector<gz::math::Vector3d> result(static_cast<std::size_t>(clusters));
+    ok = kmeans.Cluster(_k, result.data(), label);
+    for (py::ssize_t i = 0; ok && i < clusters; ++i)
+    {
+      out[3*i] = result[i].X();
+      out[3*i+1] = result[i].Y();
+      out[3*i+2] = result[i].Z();
+    }
+  }
+
+  if (!ok)
+  {
+    return std::make_tuple(false, Output<double>(py::none(), 0, 3),
+                           Output<unsigned int>(py::none(), 0, 0));
+  }
+  return std::make_tuple(true, centroids, labels);
+}
+
+void defineMathBatchOperations(py::module &m)
+{
+  m.def("transform_points",
+        &TransformPoints,
+        py::arg("pose"), py::arg("points"), py::arg("out") = py::none(),
+        "Apply a pose to an (N, 3) array of points, "
+        "like Pose3d.coord_position_add for each point.")
+   .def("rotate_vectors",
+        &RotateVectors,
+        py::arg("quaternions"), py::arg("vectors"),
+        py::arg("out") = py::none(),
+        "Rotate an (N, 3) array of vectors by an (N, 4) array of "
+        "quaternions in (w, x, y, z) order. A single quaternion or vector "
+        "is applied to every row of the other array.")
+   .def("quaternion_multiply",
+        &QuaternionMultiply,
+        py::arg("a"), py::arg("b"), py::arg("out") = py::none(),
+        "Multiply two (N, 4) arrays of quaternions in (w, x, y, z) order "
+        "row by row. A single quaternion is applied to every row of the "
+        "other array.")
+   .def("axis_aligned_box_intersect_dist",
+        &BoxIntersectDist,
+        py::arg("box"), py::arg("origins"), py::arg("directions"),
+        py::arg("min") = 0.0,
+        py::arg("max") = std::numeric_limits<double>::max(),
+        "Intersect rays given by (N, 3) arrays of origins and directions "
+        "with a box. Return an array of hit flags and an array of "
+        "distances, like AxisAlignedBox.intersect_dist for each ray.")
+   .def("axis_aligned_box_contains",
+        &BoxContains,
+        py::arg("box"), py::arg("points"), py::arg("out") = py::none(),
+        "Check which points of an (N, 3) array are inside a box.")
+   .def("spherical_position_transform",
+        &SphericalPositionTransform,
+        py::arg("spherical_coordinates"), py::arg("positions"),
+        py::arg("in_type"), py::arg("out_type"),
+        py::arg("out") = py::none(),
+        "Convert an (N, 3) array of positions between "
+        "SPHERICAL/ECEF/LOCAL/GLOBAL frames, like "
+        "SphericalCoordinates.position_transform for each position.")
+   .def("kmeans_cluster",
+        &KmeansCluster,
+        py::arg("points"), py::arg("k"),
+        "Cluster an (N, 3) array of points in k clusters. Return a success "
+        "flag, a (k, 3) array of centroids and an array of N labels, like "
+        "Kmeans.cluster on the same observations.");
+}
+}  // namespace python
+}  // namespace math
+}  // namespace ignition
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MATH_PYTHON__BATCHOPERATIONS_HH_
+#define GZ_MATH_PYTHON__BATCHOPERATIONS_HH_
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace ignition
+{
+namespace math
+{
+namespace python
+{
+/// Define py::bind11 wrappers for batch operations over numpy arrays
+/**
+ * Positions and vectors are passed as N x 3 arrays and quaternions as
+ * N x 4 arrays in (w, x, y, z) order. C contiguous float64 arrays are
+ * read in place, and results are written either to a new array or in place
+ * to an array given through the `out` argument.
+ *
+ * \param[in] module a py::bind11 module to add the definitions to
+ */
+void defineMathBatchOperations(py::module &m);
+}  // namespace python
+}  // namespace math
+}  // namespace ignition
+
+#endif  // GZ_MATH_PYTHON__BATCHOPERATIONS_HH_
@@ -40,12 +40,26 @@ void defineMathKmeans(py::module &m, const std::string &typestr)
        py::overload_cast<const std::vector<gz::math::Vector3d>&>
         (&Class::Observations),
         "Set the observations to cluster.")
+  .def("observations",
+       py::overload_cast<const std::vector<gz::math::Vector3d>&,
+                         const std::vector<double>&>
+        (&Class::Observations),
+        "Set weighted observations to cluster.")
   .def("observations",
        py::overload_cast<>(&Class::Observations, py::const_),
        "Get the observations to cluster.")
+  .def("weights",
+       &Class::Weights,
+       "Get the weights of the observations.")
   .def("append_observations",
-       &Class::AppendObservations,
+       py::overload_cast<const std::vector<gz::math::Vector3d>&>
+        (&Class::AppendObservations),
        "Add observations to the cluster.")
+  .def("append_observations",
+       py::overload_cast<const std::vector<gz::math::Vector3d>&,
+                         const std::vector<double>&>
+        (&Class::AppendObservations),
+       "Add weighted observations to the cluster.")
   .def("cluster",
        [](Class &self, int k) {
          std::vector<gz::math::Vector3<double>> centroids;
@@ -53,7 +67,41 @@ void defineMathKmeans(py::module &m, const std::string &typestr)
          bool result = self.Cluster(k, centroids, labels);
          return std::make_tuple(result, centroids, labels);
        },
-       "Executes the k-means algorithm.");
+       py::call_guard<py::gil_scoped_release>(),
+       "Executes the k-means algorithm. The GIL is released during the "
+       "call, so the object must not be used from other threads "
+       "meanwhile.")
+  .def("update_clusters",
+       [](Class &self, const std::vector<gz::math::Vector3d> &_obs) {
+         std::vector<gz::math::Vector3<double>> centroids;
+         std::vector<unsigned int> labels;
+         bool result = self.UpdateClusters(_obs, centroids, labels);
+         return std::make_tuple(result, centroids, labels);
+       },
+       py::call_guard<py::gil_scoped_release>(),
+       "Update the clusters computed by the last call to cluster with a "
+       "batch of new observations. The GIL is released during the call, "
+       "so the object must not be used from other threads meanwhile.")
+  .def("update_clusters",
+       [](Class &self, const std::vector<gz::math::Vector3d> &_obs,
+          const std::vector<double> &_weights) {
+         std::vector<gz::math::Vector3<double>> centroids;
+         std::vector<unsigned int> labels;
+         bool result = self.UpdateClusters(_obs, _weights, centroids,
+                                           labels);
+         return std::make_tuple(result, centroids, labels);
+       },
+       py::call_guard<py::gil_scoped_release>(),
+       "Update the clusters with a batch of new weighted observations. The "
+       "GIL is released during the call, so the object must not be used "
+       "from other threads meanwhile.")
+  .def("set_thread_count",
+       &Class::SetThreadCount,
+       "Set the number of threads used by cluster, 0 for the number of "
+       "hardware threads.")
+  .def("thread_count",
+       &Class::ThreadCount,
+       "Get the number of threads used by cluster.");
 }
 }  // namespace python
 }  // namespace math
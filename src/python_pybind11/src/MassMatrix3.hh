@@ -159,6 +159,7 @@ void helpDefineMathMassMatrix3(py::module &m, const std::string &typestr)
        "using the current mass value.")
   .def("equivalent_box",
        &Class::EquivalentBox,
+       py::call_guard<py::gil_scoped_release>(),
        py::arg("_size") = gz::math::Vector3<T>::Zero,
        py::arg("_rot") = gz::math::Quaternion<T>::Identity,
        py::arg("_tol") = 1e-6,
@@ -166,10 +167,12 @@ void helpDefineMathMassMatrix3(py::module &m, const std::string &typestr)
        "with equivalent mass and moment of inertia.")
   .def("principal_axes_offset",
        &Class::PrincipalAxesOffset,
+       py::call_guard<py::gil_scoped_release>(),
        py::arg("_tol") = 1e-6,
        "Compute rotational offset of principal axes.")
   .def("principal_moments",
        &Class::PrincipalMoments,
+       py::call_guard<py::gil_scoped_release>(),
        py::arg("_tol") = 1e-6,
        "Compute principal moments of inertia.")
   .def("valid_moments",
@@ -41,13 +41,16 @@ void defineMathSpline(py::module &m, const std::string &typestr)
        "Gets the tension value.")
   .def("arc_length",
        py::overload_cast<const double>(&Class::ArcLength, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Sets the tension parameter.")
   .def("arc_length",
        py::overload_cast<>(&Class::ArcLength, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Gets spline arc length up to")
   .def("arc_length",
        py::overload_cast<const unsigned int,
                          const double>(&Class::ArcLength, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Sets the tension parameter.")
   .def("add_point",
        py::overload_cast<const Vector3d&>(&Class::AddPoint),
@@ -92,28 +95,33 @@ void defineMathSpline(py::module &m, const std::string &typestr)
        " with its tangent.")
   .def("interpolate",
        py::overload_cast<const double>(&Class::Interpolate, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Interpolates a point on the spline "
        "at parameter value p _t.")
   .def("interpolate",
        py::overload_cast<const unsigned int,
                          const double>(&Class::Interpolate, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Interpolates a point on the spline "
        "at parameter value p _t.")
   .def("interpolate_tangent",
        py::overload_cast<const double>
            (&Class::InterpolateTangent, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Interpolates a tangent on the spline "
        "at parameter value p _t.")
   .def("interpolate_tangent",
        py::overload_cast<const unsigned int,
                          const double>(
            &Class::InterpolateTangent, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Interpolates a tangent on the spline "
        "at parameter value p _t.")
   .def("interpolate_mth_derivative",
        py::overload_cast<const unsigned int,
                          const double>(
            &Class::InterpolateMthDerivative, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Interpolates the mth derivative on the spline "
        "at parameter value p _t.")
   .def("interpolate_mth_derivative",
@@ -121,6 +129,7 @@ void defineMathSpline(py::module &m, const std::string &typestr)
                          const unsigned int,
                          const double>(
            &Class::InterpolateMthDerivative, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Interpolates the mth derivative on the spline "
        "at parameter value p _t.")
   .def("auto_calculate", &Class::AutoCalculate,
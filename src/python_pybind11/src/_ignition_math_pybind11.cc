@@ -16,6 +16,7 @@
 
 #include "Angle.hh"
 #include "AxisAlignedBox.hh"
+#include "BatchOperations.hh"
 #include "Box.hh"
 #include "Capsule.hh"
 #include "Color.hh"
@@ -71,6 +72,8 @@ PYBIND11_MODULE(math, m)
 
   gz::math::python::defineMathAxisAlignedBox(m, "AxisAlignedBox");
 
+  gz::math::python::defineMathBatchOperations(m);
+
   gz::math::python::defineMathCapsule(m, "Capsule");
 
   gz::math::python::defineMathColor(m, "Color");
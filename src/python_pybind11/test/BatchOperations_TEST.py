@@ -0,0 +1,177 @@
+# Copyright (C) 2023 Open Source Robotics Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License")
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#       http:#www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import math
+import unittest
+
+import numpy as np
+
+from ignition.math import (AxisAlignedBox, Angle, Kmeans, Pose3d,
+                           Quaterniond, SphericalCoordinates, Vector3d,
+                           axis_aligned_box_contains,
+                           axis_aligned_box_intersect_dist, kmeans_cluster,
+                           quaternion_multiply, rotate_vectors,
+                           spherical_position_transform, transform_points)
+
+
+def to_vector(row):
+    return Vector3d(row[0], row[1], row[2])
+
+
+def to_quaternion(row):
+    return Quaterniond(row[0], row[1], row[2], row[3])
+
+
+class TestBatchOperations(unittest.TestCase):
+
+    def setUp(self):
+        rng = np.random.default_rng(7)
+        self.points = rng.uniform(-10, 10, (50, 3))
+        quats = rng.normal(size=(50, 4))
+        self.quats = quats / np.linalg.norm(quats, axis=1)[:, np.newaxis]
+
+    def test_transform_points(self):
+        pose = Pose3d(1, -2, 3, 0.1, 0.2, 0.3)
+        result = transform_points(pose, self.points)
+        self.assertEqual(result.shape, (50, 3))
+        for row, res in zip(self.points, result):
+            expected = pose.coord_position_add(to_vector(row))
+            self.assertAlmostEqual(to_vector(res), expected)
+
+        # In place
+        points = self.points.copy()
+        out = transform_points(pose, points, out=points)
+        self.assertTrue(np.shares_memory(out, points))
+        np.testing.assert_allclose(points, result)
+
+        # Integer input is converted
+        result = transform_points(Pose3d(), np.array([[1, 2, 3]]))
+        np.testing.assert_allclose(result, [[1.0, 2.0, 3.0]])
+
+        with self.assertRaises(ValueError):
+            transform_points(pose, np.zeros((4, 2)))
+        with self.assertRaises(ValueError):
+            transform_points(pose, self.points, out=np.zeros((4, 3)))
+        with self.assertRaises(TypeError):
+            transform_points(pose, self.points,
+                             out=np.zeros((50, 3), dtype=np.float32))
+
+    def test_rotate_vectors(self):
+        result = rotate_vectors(self.quats, self.points)
+        for q, v, res in zip(self.quats, self.points, result):
+            expected = to_quaternion(q).rotate_vector(to_vector(v))
+            self.assertAlmostEqual(to_vector(res), expected)
+
+        # A single quaternion is applied to every vector
+        q = Quaterniond(0, 0, math.pi / 2)
+        result = rotate_vectors([q.w(), q.x(), q.y(), q.z()], self.points)
+        np.testing.assert_allclose(result[:, 0], -self.points[:, 1],
+                                   atol=1e-12)
+        np.testing.assert_allclose(result[:, 1], self.points[:, 0],
+                                   atol=1e-12)
+
+        with self.assertRaises(ValueError):
+            rotate_vectors(self.quats, self.points[:10])
+
+    def test_quaternion_multiply(self):
+        b = self.quats[::-1].copy()
+        result = quaternion_multiply(self.quats, b)
+        self.assertEqual(result.shape, (50, 4))
+        for qa, qb, res in zip(self.quats, b, result):
+            expected = to_quaternion(qa) * to_quaternion(qb)
+            self.assertAlmostEqual(res[0], expected.w())
+            self.assertAlmostEqual(res[1], expected.x())
+            self.assertAlmostEqual(res[2], expected.y())
+            self.assertAlmostEqual(res[3], expected.z())
+
+        # Identity broadcast
+        result = quaternion_multiply([1, 0, 0, 0], self.quats)
+        np.testing.assert_allclose(result, self.quats)
+
+    def test_axis_aligned_box(self):
+        box = AxisAlignedBox(Vector3d(-1, -1, -1), Vector3d(1, 1, 1))
+
+        inside = axis_aligned_box_contains(box, self.points)
+        self.assertEqual(inside.dtype, np.bool_)
+        for p, res in zip(self.points, inside):
+            self.assertEqual(res, box.contains(to_vector(p)))
+
+        origins = np.array([[5.0, 0, 0], [5.0, 5.0, 0], [0, 0, 0]])
+        hits, dists = axis_aligned_box_intersect_dist(
+            box, origins, [-1.0, 0, 0], 0, 1000)
+        np.testing.assert_array_equal(hits, [True, False, True])
+        self.assertAlmostEqual(dists[0], 4.0)
+        for o, hit, dist in zip(origins, hits, dists):
+            expected = box.intersect_dist(to_vector(o), Vector3d(-1, 0, 0),
+                                          0, 1000)
+            self.assertEqual(hit, expected[0])
+            self.assertAlmostEqual(dist, expected[1])
+
+    def test_spherical_position_transform(self):
+        sc = SphericalCoordinates(
+            SphericalCoordinates.EARTH_WGS84, Angle(0.3), Angle(-1.2),
+            10.0, Angle(0.4))
+        local = self.points * 100.0
+
+        result = spherical_position_transform(
+            sc, local, SphericalCoordinates.LOCAL2,
+            SphericalCoordinates.ECEF)
+        for p, res in zip(local, result):
+            expected = sc.position_transform(
+                to_vector(p), SphericalCoordinates.LOCAL2,
+                SphericalCoordinates.ECEF)
+            self.assertAlmostEqual(res[0], expected.x(), delta=1e-6)
+            self.assertAlmostEqual(res[1], expected.y(), delta=1e-6)
+            self.assertAlmostEqual(res[2], expected.z(), delta=1e-6)
+
+        back = spherical_position_transform(
+            sc, result, SphericalCoordinates.ECEF,
+            SphericalCoordinates.LOCAL2)
+        np.testing.assert_allclose(back, local, atol=1e-6)
+
+    def test_kmeans_cluster(self):
+        # Two well separated blobs, whose means are the centroids
+        rng = np.random.default_rng(3)
+        points = np.vstack([rng.uniform(0, 1, (20, 3)),
+                            rng.uniform(10, 11, (30, 3))])
+
+        ok, centroids, labels = kmeans_cluster(points, 2)
+        self.assertTrue(ok)
+        self.assertEqual(centroids.shape, (2, 3))
+        self.assertEqual(labels.shape, (50,))
+        self.assertTrue(np.all(labels[:20] == labels[0]))
+        self.assertTrue(np.all(labels[20:] == labels[20]))
+        self.assertNotEqual(labels[0], labels[20])
+        np.testing.assert_allclose(centroids[labels[0]],
+                                   points[:20].mean(axis=0))
+        np.testing.assert_allclose(centroids[labels[20]],
+                                   points[20:].mean(axis=0))
+
+        # Same centroids as the Kmeans class
+        result, expected, _ = Kmeans([to_vector(p) for p in points]).cluster(2)
+        self.assertTrue(result)
+        for c in expected:
+            distances = np.linalg.norm(centroids - [c.x(), c.y(), c.z()],
+                                       axis=1)
+            self.assertAlmostEqual(distances.min(), 0.0)
+
+        # More clusters than points
+        ok, centroids, labels = kmeans_cluster(points[:1], 2)
+        self.assertFalse(ok)
+        self.assertEqual(centroids.shape, (0, 3))
+        self.assertEqual(labels.shape, (0,))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -13,6 +13,7 @@
 # limitations under the License.
 
 import unittest
+from concurrent.futures import ThreadPoolExecutor
 from ignition.math import Kmeans
 from ignition.math import Vector3d
 
@@ -136,6 +137,74 @@ class TestKmeans(unittest.TestCase):
         emptyVector = []
         self.assertFalse(kmeans.append_observations(emptyVector))
 
+    def test_kmeans_update_clusters(self):
+        obs = [Vector3d(1.0 + 0.1 * i, 1.0, 0.0) for i in range(5)]
+        obs += [Vector3d(5.0 + 0.1 * i, 1.0, 0.0) for i in range(5)]
+        kmeans = Kmeans(obs)
+
+        # Cluster() has to be called first.
+        result, centroids, labels = kmeans.update_clusters(obs)
+        self.assertFalse(result)
+
+        result, centroids, labels = kmeans.cluster(2)
+        self.assertTrue(result)
+
+        result, centroids, labels = kmeans.update_clusters(
+            [Vector3d(1.0, 1.0, 0.0), Vector3d(5.4, 1.0, 0.0)])
+        self.assertTrue(result)
+        self.assertEqual(len(centroids), 2)
+        self.assertEqual(len(labels), 2)
+        self.assertNotEqual(labels[0], labels[1])
+
+    def test_kmeans_threads(self):
+        obs = [Vector3d(1.0 + 0.1 * i, 1.0, 0.0) for i in range(5)]
+        obs += [Vector3d(5.0 + 0.1 * i, 1.0, 0.0) for i in range(5)]
+
+        kmeans = Kmeans(obs)
+        self.assertEqual(kmeans.thread_count(), 1)
+        kmeans.set_thread_count(2)
+        self.assertEqual(kmeans.thread_count(), 2)
+
+        # The GIL is released while clustering, so that one object per
+        # thread can be clustered in parallel.
+        def cluster(_):
+            return Kmeans(obs).cluster(2)
+
+        with ThreadPoolExecutor(max_workers=4) as pool:
+            results = list(pool.map(cluster, range(8)))
+
+        expected = kmeans.cluster(2)
+        for result, centroids, labels in results:
+            self.assertTrue(result)
+            self.assertEqual(list(labels), list(expected[2]))
+
+    def test_kmeans_weighted(self):
+        obs = [Vector3d(0, 0, 0), Vector3d(1, 0, 0),
+               Vector3d(10, 0, 0), Vector3d(11, 0, 0)]
+
+        kmeans = Kmeans(obs)
+        self.assertEqual(kmeans.weights(), [1.0, 1.0, 1.0, 1.0])
+        self.assertFalse(kmeans.observations(obs, [1.0, 2.0]))
+        self.assertFalse(kmeans.observations(obs, [1.0, 2.0, -1.0, 1.0]))
+        self.assertTrue(kmeans.observations(obs, [3.0, 1.0, 0.0, 1.0]))
+
+        result, centroids, labels = kmeans.cluster(2)
+        self.assertTrue(result)
+        self.assertEqual(list(labels), [0, 0, 1, 1])
+        self.assertEqual(centroids[0], Vector3d(0.25, 0, 0))
+        self.assertEqual(centroids[1], Vector3d(11, 0, 0))
+
+        result, centroids, labels = kmeans.update_clusters(
+            [Vector3d(13, 0, 0)], [1.0])
+        self.assertTrue(result)
+        self.assertEqual(list(labels), [1])
+        self.assertEqual(centroids[1], Vector3d(12, 0, 0))
+
+        self.assertTrue(kmeans.append_observations([Vector3d(20, 0, 0)],
+                                                   [2.0]))
+        self.assertTrue(kmeans.append_observations([Vector3d(21, 0, 0)]))
+        self.assertEqual(kmeans.weights(), [3.0, 1.0, 0.0, 1.0, 2.0, 1.0])
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MATH_RUBY__BATCHOPERATIONS_HH_
+#define GZ_MATH_RUBY__BATCHOPERATIONS_HH_
+
+#include <ruby.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Kmeans.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/Vector3SoA.hh>
+
+namespace ignition
+{
+namespace math
+{
+namespace ruby
+{
+/// \brief Doubles returned to Ruby as a binary String of native doubles,
+/// to be read with String#unpack("d*").
+struct PackedDoubles
+{
+  /// \brief The values.
+  std::vector<double> values;
+};
+
+/// \brief Flags returned to Ruby as a binary String of bytes which are 0
+/// or 1, to be read with String#unpack("C*").
+struct PackedFlags
+{
+  /// \brief The flags.
+  std::vector<uint8_t> values;
+};
+
+/// \brief Result of KmeansCluster, returned to Ruby as the Array
+/// [ok, centroids, labels]. The centroids are a String of native doubles
+/// and the labels a String of native 32 bit unsigned integers, to be read
+/// with String#unpack("L*"). Both are empty on failure.
+struct PackedClusters
+{
+  /// \brief True if the clustering succeeded.
+  bool ok = false;
+
+  /// \brief Centroids, 3 doubles each.
+  std::vector<double> centroids;
+
+  /// \brief Cluster of each point.
+  std::vector<uint32_t> labels;
+};
+
+/// \brief Get the doubles of a Ruby argument without converting each of
+/// them to a Ruby object. A binary String, such as built by
+/// Array#pack("d*"), is used in place. An Array of numbers is converted
+/// into _storage.
+/// \param[in] _value The Ruby String or Array.
+/// \param[in] _name Name of the argument, used in error messages.
+/// \param[in] _storage Storage for converted values.
+/// \param[out] _data The doubles.
+/// \param[out] _size Number of doubles.
+inline void FromRuby(VALUE _value, const char *_name,
+    std::vector<double> &_storage, const double *&_data, std::size_t &_size)
+{
+  if (RB_TYPE_P(_value, T_STRING))
+  {
+    const char *bytes = RSTRING_PTR(_value);
+    const std::size_t length = static_cast<std::size_t>(RSTRING_LEN(_value));
+    if (length % sizeof(double) != 0)
+    {
+      rb_raise(rb_eArgError,
+          "%s: packed String length %zu is not a multiple of %zu", _name,
+          length, sizeof(double));
+    }
+    _size = length / sizeof(double);
+
+    // Short strings are stored inside the Ruby object, which doesn't
+    // guarantee the alignment of a double.
+    if (reinterpret_cast<uintptr_t>(bytes) % alignof(double) == 0)
+    {
+      _data = reinterpret_cast<const double *>(bytes);
+    }
+    else
+    {
+      _storage.resize(_size);
+      std::memcpy(_storage.data(), bytes, length);
+      _data = _storage.data();
+    }
+    return;
+  }
+
+  if (!RB_TYPE_P(_value, T_ARRAY))
+  {
+    rb_raise(rb_eTypeError,
+        "%s: expected a packed String or an Array of numbers", _name);
+  }
+  const long count = RARRAY_LEN(_value);
+  _storage.resize(static_cast<std::size_t>(count));
+  for (long i = 0; i < count; ++i)
+    _storage[i] = NUM2DBL(rb_ary_entry(_value, i));
+  _data = _storage.data();
+  _size = _storage.size();
+}
+
+/// \brief Convert doubles to a binary Ruby String.
+/// \param[in] _packed The doubles.
+/// \return The String.
+inline VALUE ToRuby(const PackedDoubles &_packed)
+{
+  return rb_str_new(reinterpret_cast<const char *>(_packed.values.data()),
+      static_cast<long>(_packed.values.size() * sizeof(double)));
+}
+
+/// \brief Convert flags to a binary Ruby String.
+/// \param[in] _packed The flags.
+/// \return The String.
+inline VALUE ToRuby(const PackedFlags &_packed)
+{
+  return rb_str_new(reinterpret_cast<const char *>(_packed.values.data()),
+      static_cast<long>(_packed.values.size()));
+}
+
+/// \brief Convert a clustering result to a Ruby Array.
+/// \param[in] _packed The result.
+/// \return The Array [ok, centroids, labels].
+inline VALUE ToRuby(const PackedClusters &_packed)
+{
+  return rb_ary_new_from_args(3, _packed.ok ? Qtrue : Qfalse,
+      rb_str_new(reinterpret_cast<const char *>(_packed.centroids.data()),
+          static_cast<long>(_packed.centroids.size() * sizeof(double))),
+      rb_str_new(reinterpret_cast<const char *>(_packed.labels.data()),
+          static_cast<long>(_packed.labels.size() * sizeof(uint32_t))));
+}
+
+/// \brief Get the number of rows of a packed argument.
+/// \param[in] _size Number of doubles.
+/// \param[in] _cols Number of doubles per row.
+/// \param[in] _name Name of the argument, used in error messages.
+/// \return Number of rows.
+/// \throws std::invalid_argument if _size is not a multiple of _cols.
+inline std::size_t Rows(const std::size_t _size, const std::size_t _cols,
+    const char *_name)
+{
+  if (_size % _cols != 0)
+  {
+    throw std::invalid_argument(std::string(_name) + ": " +
+        std::to_string(_size) + " values is not a multiple of " +
+        std::to_string(_cols));
+  }
+  return _size / _cols;
+}
+
+/// \brief Get the number of rows of two arguments of which one may be a
+/// single row, which is then used with every row of the other one.
+/// \param[in] _rowsA Rows of the first argument.
+/// \param[in] _rowsB Rows of the second argument.
+/// \return Number of rows of the result.
+/// \throws std::invalid_argument if the numbers of rows differ and none of
+/// them is 1.
+inline std::size_t BroadcastRows(const std::size_t _rowsA,
+    const std::size_t _rowsB)
+{
+  if (_rowsA == _rowsB || _rowsB == 1)
+    return _rowsA;
+  if (_rowsA == 1)
+    return _rowsB;
+  throw std::invalid_argument("arguments have " + std::to_string(_rowsA) +
+      " and " + std::to_string(_rowsB) + " rows");
+}
+
+/// \brief Apply a pose to a set of points.
+/// \param[in] _pose The pose as x, y, z, qw, qx, qy, qz.
+/// \param[in] _poseSize Number of doubles of _pose, 7.
+/// \param[in] _points Points as x, y, z of each point.
+/// \param[in] _pointsSize Number of doubles of _points.
+/// \return Transformed points, Pose3d::CoordPositionAdd of each point.
+inline PackedDoubles TransformPoints(
+    const double *_pose, const std::size_t _poseSize,
+    const double *_points, const std::size_t _pointsSize)
+{
+  if (_poseSize != 7)
+    throw std::invalid_argument("pose: expected x, y, z, qw, qx, qy, qz");
+  const std::size_t rows = Rows(_pointsSize, 3, "points");
+  const Pose3d pose(_pose[0], _pose[1], _pose[2],
+                    _pose[3], _pose[4], _pose[5], _pose[6]);
+
+  // The batch transform works on a structure of arrays.
+  Vector3SoAd soa(rows);
+  double *x = soa.XData();
+  double *y = soa.YData();
+  double *z = soa.ZData();
+  for (std::size_t i = 0; i < rows; ++i)
+  {
+    x[i] = _points[3*i];
+    y[i] = _points[3*i+1];
+    z[i] = _points[3*i+2];
+  }
+  pose.CoordPositionAdd(soa);
+
+  PackedDoubles res;
+  res.values.resize(3 * rows);
+  for (std::size_t i = 0; i < rows; ++i)
+  {
+    res.values[3*i] = x[i];
+    res.values[3*i+1] = y[i];
+    res.values[3*i+2] = z[i];
+  }
+  return res;
+}
+
+/// \brief Rotate a set of vectors.
+/// \param[in] _quats Quaternions as w, x, y, z of each quaternion, or a
+/// single quaternion used for every vector.
+/// \param[in] _quatsSize Number of doubles of _quats.
+/// \param[in] _vectors Vectors as x, y, z of each vector, or a single
+/// vector rotated by every quaternion.
+/// \param[in] _vectorsSize Number of doubles of _vectors.
+/// \return Rotated vectors, Quaterniond::RotateVector of each pair.
+inline PackedDoubles RotateVectors(
+    const double *_quats, const std::size_t _quatsSize,
+    const double *_vectors, const std::size_t _vectorsSize)
+{
+  const std::size_t rowsQ = Rows(_quatsSize, 4, "quaternions");
+  const std::size_t rowsV = Rows(_vectorsSize, 3, "vectors");
+  const std::size_t rows = BroadcastRows(rowsQ, rowsV);
+  const std::size_t strideQ = rowsQ == 1 ? 0 : 4;
+  const std::size_t strideV = rowsV == 1 ? 0 : 3;
+
+  PackedDoubles res;
+  res.values.resize(3 * rows);
+  const double *q = _quats;
+  const double *v = _vectors;
+  for (std::size_t i = 0; i < rows; ++i, q += strideQ, v += strideV)
+  {
+    const Vector3d r = Quaterniond(q[0], q[1], q[2], q[3]).RotateVector(
+        Vector3d(v[0], v[1], v[2]));
+    res.values[3*i] = r.X();
+    res.values[3*i+1] = r.Y();
+    res.values[3*i+2] = r.Z();
+  }
+  return res;
+}
+
+/// \brief Multiply two sets of quaternions.
+/// \param[in] _a Quaternions as w, x, y, z of each quaternion, or a single
+/// quaternion.
+/// \param[in] _aSize Number of doubles of _a.
+/// \param[in] _b Quaternions as w, x, y, z of each quaternion, or a single
+/// quaternion.
+/// \param[in] _bSize Number of doubles of _b.
+/// \return Products a * b of each pair, as w, x, y, z.
+inline PackedDoubles QuaternionMultiply(
+    const double *_a, const std::size_t _aSize,
+    const double *_b, const std::size_t _bSize)
+{
+  const std::size_t rowsA = Rows(_aSize, 4, "a");
+  const std::size_t rowsB = Rows(_bSize, 4, "b");
+  const std::size_t rows = BroadcastRows(rowsA, rowsB);
+  const std::size_t strideA = rowsA == 1 ? 0 : 4;
+  const std::size_t strideB = rowsB == 1 ? 0 : 4;
+
+  PackedDoubles res;
+  res.values.resize(4 * rows);
+  const double *a = _a;
+  const double *b = _b;
+  for (std::size_t i = 0; i < rows; ++i, a += strideA, b += strideB)
+  {
+    const Quaterniond r = Quaterniond(a[0], a[1], a[2], a[3]) *
+        Quaterniond(b[0], b[1], b[2], b[3]);
+    res.values[4*i] = r.W();
+    res.values[4*i+1] = r.X();
+    res.values[4*i+2] = r.Y();
+    res.values[4*i+3] = r.Z();
+  }
+  return res;
+}
+
+/// \brief Check which points of a set are inside a box.
+/// \param[in] _box The box as its minimum then maximum corner.
+/// \param[in] _boxSize Number of doubles of _box, 6.
+/// \param[in] _points Points as x, y, z of each point.
+/// \param[in] _pointsSize Number of doubles of _points.
+/// \return AxisAlignedBox::Contains of each point.
+inline PackedFlags BoxContains(
+    const double *_box, const std::size_t _boxSize,
+    const double *_points, const std::size_t _pointsSize)
+{
+  if (_boxSize != 6)
+    throw std::invalid_argument("box: expected the min and max corners");
+  const std::size_t rows = Rows(_pointsSize, 3, "points");
+  const AxisAlignedBox box(Vector3d(_box[0], _box[1], _box[2]),
+                           Vector3d(_box[3], _box[4], _box[5]));
+
+  PackedFlags res;
+  res.values.resize(rows);
+  for (std::size_t i = 0; i < rows; ++i)
+  {
+    res.values[i] = box.Contains(Vector3d(
+        _points[3*i], _points[3*i+1], _points[3*i+2])) ? 1 : 0;
+  }
+  return res;
+}
+
+/// \brief Cluster a set of points with the k-means algorithm.
+/// \param[in] _points Observations as x, y, z of each point.
+/// \param[in] _pointsSize Number of doubles of _points.
+/// \param[in] _k Number of clusters.
+/// \return The result of Kmeans::Cluster.
+inline PackedClusters KmeansCluster(
+    const double *_points, const std::size_t _pointsSize, const int _k)
+{
+  const std::size_t rows = Rows(_pointsSize, 3, "points");
+  std::vector<Vector3d> obs(rows);
+  for (std::size_t i = 0; i < rows; ++i)
+    obs[i].Set(_points[3*i], _points[3*i+1], _points[3*i+2]);
+
+  PackedClusters res;
+  const std::size_t clusters = _k > 0 ? static_cast<std::size_t>(_k) : 0;
+  std::vector<Vector3d> centroids(clusters);
+  std::vector<unsigned int> labels(rows);
+  Kmeans kmeans(std::move(obs));
+  if (!kmeans.Cluster(_k, centroids.data(), labels.data()))
+    return res;
+
+  res.ok = true;
+  res.centroids.resize(3 * clusters);
+  for (std::size_t i = 0; i < clusters; ++i)
+  {
+    res.centroids[3*i] = centroids[i].X();
+    res.centroids[3*i+1] = centroids[i].Y();
+    res.centroids[3*i+2] = centroids[i].Z();
+  }
+  res.labels.assign(labels.begin(), labels.end());
+  return res;
+}
+}
+}
+}
+
+#endif
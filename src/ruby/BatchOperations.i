@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Batch functions over packed arrays. Each array argument is a binary
+// String of native doubles, such as built by Array#pack("d*"), which is
+// passed to the C++ kernel without copying, or an Array of numbers. The
+// results are binary Strings, read with String#unpack. No Ruby object is
+// created per element:
+//
+//   points = [1, 2, 3, 4, 5, 6].pack("d*")
+//   pose = [0, 0, 1, 1, 0, 0, 0].pack("d*")
+//   Ignition::Math::TransformPoints(pose, points).unpack("d*")
+
+%module batchoperations
+%{
+#include "BatchOperations.hh"
+%}
+
+%include "exception.i"
+
+%typemap(in) (const double *, const std::size_t)
+    (std::vector<double> storage)
+{
+  const double *data = nullptr;
+  std::size_t size = 0;
+  ignition::math::ruby::FromRuby($input, "$1_name", storage, data, size);
+  $1 = ($1_ltype) data;
+  $2 = size;
+}
+
+%typemap(out) ignition::math::ruby::PackedDoubles,
+              ignition::math::ruby::PackedFlags,
+              ignition::math::ruby::PackedClusters
+{
+  $result = ignition::math::ruby::ToRuby($1);
+}
+
+%exception
+{
+  try
+  {
+    $action
+  }
+  catch (const std::invalid_argument &_e)
+  {
+    SWIG_exception(SWIG_ValueError, _e.what());
+  }
+}
+
+namespace ignition
+{
+  namespace math
+  {
+    namespace ruby
+    {
+      struct PackedDoubles;
+      struct PackedFlags;
+      struct PackedClusters;
+
+      PackedDoubles TransformPoints(
+          const double *_pose, const std::size_t _poseSize,
+          const double *_points, const std::size_t _pointsSize);
+      PackedDoubles RotateVectors(
+          const double *_quats, const std::size_t _quatsSize,
+          const double *_vectors, const std::size_t _vectorsSize);
+      PackedDoubles QuaternionMultiply(
+          const double *_a, const std::size_t _aSize,
+          const double *_b, const std::size_t _bSize);
+      PackedFlags BoxContains(
+          const double *_box, const std::size_t _boxSize,
+          const double *_points, const std::size_t _pointsSize);
+      PackedClusters KmeansCluster(
+          const double *_points, const std::size_t _pointsSize,
+          const int _k);
+    }
+  }
+}
+
+%exception;
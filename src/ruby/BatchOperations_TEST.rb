@@ -0,0 +1,121 @@
+# Copyright (C) 2023 Open Source Robotics Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+#!/usr/bin/env ruby
+
+require 'test/unit/ui/console/testrunner'
+require 'test/unit'
+require 'math'
+
+class BatchOperations_TEST < Test::Unit::TestCase
+  def assert_values(expected, actual)
+    assert(expected.size == actual.size,
+           "Expected #{expected.size} values, got #{actual.size}")
+    expected.zip(actual).each do |e, a|
+      assert_in_delta(e, a, 1e-9)
+    end
+  end
+
+  def test_transform_points
+    # Translation by (1, 2, 3) and rotation of 90 degrees around Z
+    s = Math.sqrt(0.5)
+    pose = [1, 2, 3, s, 0, 0, s]
+    points = [1, 0, 0, 0, 1, 0, 2, 2, 2]
+    expected = [1, 3, 3, 0, 2, 3, -1, 4, 5]
+
+    res = Ignition::Math::TransformPoints(pose.pack("d*"),
+                                          points.pack("d*"))
+    assert_values(expected, res.unpack("d*"))
+
+    # Arrays of numbers are accepted too
+    res = Ignition::Math::TransformPoints(pose, points)
+    assert_values(expected, res.unpack("d*"))
+
+    assert_equal("", Ignition::Math::TransformPoints(pose, ""))
+  end
+
+  def test_rotate_vectors
+    s = Math.sqrt(0.5)
+    quats = [1, 0, 0, 0, s, 0, 0, s]
+    vectors = [1, 0, 0, 1, 0, 0]
+    res = Ignition::Math::RotateVectors(quats.pack("d*"),
+                                        vectors.pack("d*"))
+    assert_values([1, 0, 0, 0, 1, 0], res.unpack("d*"))
+
+    # A single vector is rotated by every quaternion
+    res = Ignition::Math::RotateVectors(quats.pack("d*"), [1, 0, 0])
+    assert_values([1, 0, 0, 0, 1, 0], res.unpack("d*"))
+  end
+
+  def test_quaternion_multiply
+    s = Math.sqrt(0.5)
+    a = [s, 0, 0, s, 1, 0, 0, 0]
+    res = Ignition::Math::QuaternionMultiply(a.pack("d*"),
+                                             [s, 0, 0, s].pack("d*"))
+    assert_values([0, 0, 0, 1, s, 0, 0, s], res.unpack("d*"))
+  end
+
+  def test_box_contains
+    box = [0, 0, 0, 1, 1, 1]
+    points = [0.5, 0.5, 0.5, 2, 0, 0, 1, 1, 1]
+    res = Ignition::Math::BoxContains(box, points.pack("d*"))
+    assert_equal([1, 0, 1], res.unpack("C*"))
+  end
+
+  def test_kmeans_cluster
+    points = []
+    10.times do |i|
+      points.push(i.odd? ? 10.0 : -10.0, i * 0.01, 0.0)
+    end
+
+    ok, centroids, labels = Ignition::Math::KmeansCluster(
+      points.pack("d*"), 2)
+    assert(ok, "Clustering should succeed")
+    centroids = centroids.unpack("d*")
+    labels = labels.unpack("L*")
+    assert_equal(6, centroids.size)
+    assert_equal(10, labels.size)
+    labels.each_with_index do |label, i|
+      assert_in_delta(points[3 * i], centroids[3 * label], 1e-9)
+    end
+
+    ok, centroids, labels = Ignition::Math::KmeansCluster([], 2)
+    assert(!ok, "Clustering without points should fail")
+    assert_equal("", centroids)
+    assert_equal("", labels)
+  end
+
+  def test_invalid
+    # The number of values must match the rows
+    assert_raise(ArgumentError) do
+      Ignition::Math::TransformPoints([0, 0, 0, 1, 0, 0, 0], [1, 2])
+    end
+    assert_raise(ArgumentError) do
+      Ignition::Math::TransformPoints([0, 0, 0], [1, 2, 3])
+    end
+    assert_raise(ArgumentError) do
+      Ignition::Math::RotateVectors([1, 0, 0, 0] * 2, [1, 0, 0] * 3)
+    end
+
+    # Packed strings must hold whole doubles
+    assert_raise(ArgumentError) do
+      Ignition::Math::BoxContains([0, 0, 0, 1, 1, 1], "abc")
+    end
+    assert_raise(TypeError) do
+      Ignition::Math::BoxContains([0, 0, 0, 1, 1, 1], 3)
+    end
+  end
+end
+
+exit Test::Unit::UI::Console::TestRunner.run(BatchOperations_TEST).passed? ? 0 : -1
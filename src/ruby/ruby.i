@@ -1,5 +1,6 @@
 %module "ignition::math"
 %include Angle.i
+%include BatchOperations.i
 %include GaussMarkovProcess.i
 %include Rand.i
 %include Vector2.i
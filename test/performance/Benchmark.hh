@@ -0,0 +1,411 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_TEST_PERFORMANCE_BENCHMARK_HH_
+#define GZ_MATH_TEST_PERFORMANCE_BENCHMARK_HH_
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/math/CpuFeatures.hh"
+#include "gz/math/Instrumentation.hh"
+#include "gz/math/SignalStats.hh"
+#include "gz/math/config.hh"
+
+#include "test_config.h"  // NOLINT(build/include)
+
+namespace benchmark
+{
+  /// \brief Prevent the compiler from optimizing away a computed value.
+  /// \param[in] _value Value that must be considered observable.
+  template<typename T>
+  inline void DoNotOptimize(const T &_value)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(_value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &_value;
+#endif
+  }
+
+  /// \brief Timing summary of a single benchmark.
+  struct Result
+  {
+    /// \brief Name of the benchmark.
+    std::string name;
+
+    /// \brief Number of operations executed per repetition.
+    std::size_t iterations = 0;
+
+    /// \brief Number of timed repetitions.
+    std::size_t repetitions = 0;
+
+    /// \brief Mean time per operation in nanoseconds.
+    double meanNs = 0;
+
+    /// \brief Standard deviation of the time per operation across
+    /// repetitions, in nanoseconds.
+    double stdDevNs = 0;
+
+    /// \brief Fastest repetition, in nanoseconds per operation.
+    double minNs = 0;
+
+    /// \brief Slowest repetition, in nanoseconds per operation.
+    double maxNs = 0;
+
+    /// \brief Time per operation of each repetition, in nanoseconds.
+    std::vector<double> samplesNs;
+
+    /// \brief Name of the gtest test that ran the benchmark, such as
+    /// "CoreTypesPerformance.Matrix4Multiply".
+    std::string test;
+
+    /// \brief Other measurements, such as the peak memory, by name.
+    std::map<std::string, double> metrics;
+  };
+
+  /// \brief Get the results reported by the benchmarks of this process.
+  /// \return The results, in the order they were reported.
+  inline std::vector<Result> &Results()
+  {
+    static std::vector<Result> results;
+    return results;
+  }
+
+  /// \brief Record a result as gtest properties and print it.
+  /// The properties are written to the XML report produced by
+  /// --gtest_output, which is what our test harness consumes.
+  /// \param[in] _result Result to report.
+  inline void Report(const Result &_result)
+  {
+    auto str = [](double _v)
+    {
+      std::ostringstream ss;
+      ss << std::fixed << std::setprecision(3) << _v;
+      return ss.str();
+    };
+
+    ::testing::Test::RecordProperty(_result.name + ".mean_ns",
+        str(_result.meanNs));
+    ::testing::Test::RecordProperty(_result.name + ".stddev_ns",
+        str(_result.stdDevNs));
+    ::testing::Test::RecordProperty(_result.name + ".min_ns",
+        str(_result.minNs));
+    ::testing::Test::RecordProperty(_result.name + ".max_ns",
+        str(_result.maxNs));
+    ::testing::Test::RecordProperty(_result.name + ".iterations",
+        static_cast<int>(_result.iterations));
+
+    std::cout << "[ BENCH    ] " << std::left << std::setw(40) << _result.name
+              << std::right << std::setw(12) << str(_result.meanNs)
+              << " ns/op  +- " << str(_result.stdDevNs)
+              << "  (min " << str(_result.minNs)
+              << ", max " << str(_result.maxNs) << ")" << std::endl;
+
+    Results().push_back(_result);
+    const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+    if (info && Results().back().test.empty())
+    {
+      Results().back().test =
+          std::string(info->test_case_name()) + "." + info->name();
+    }
+  }
+
+  /// \brief Record another measurement of a benchmark, such as its peak
+  /// memory, as a gtest property and in its result.
+  /// \param[in] _name Name of the benchmark, which must have been
+  /// reported.
+  /// \param[in] _metric Name of the measurement, such as "peak_bytes".
+  /// \param[in] _value Value of the measurement.
+  inline void ReportMetric(const std::string &_name,
+                           const std::string &_metric, const double _value)
+  {
+    std::ostringstream ss;
+    ss << std::setprecision(17) << _value;
+    ::testing::Test::RecordProperty(_name + "." + _metric, ss.str());
+
+    auto &results = Results();
+    auto it = std::find_if(results.rbegin(), results.rend(),
+        [&_name](const Result &_r) { return _r.name == _name; });
+    if (it != results.rend())
+      it->metrics[_metric] = _value;
+  }
+
+  /// \brief Quote a string for JSON.
+  /// \param[in] _s The string.
+  /// \return The quoted string, with the special characters escaped.
+  inline std::string JsonString(const std::string &_s)
+  {
+    std::ostringstream ss;
+    ss << '"';
+    for (const char c : _s)
+    {
+      if (c == '"' || c == '\\')
+        ss << '\\' << c;
+      else if (c == '\n')
+        ss << "\\n";
+      else if (static_cast<unsigned char>(c) < 0x20)
+        ss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+           << static_cast<int>(c) << std::dec << std::setfill(' ');
+      else
+        ss << c;
+    }
+    ss << '"';
+    return ss.str();
+  }
+
+  /// \brief Get the model name of the CPU.
+  /// \return The model name read from /proc/cpuinfo, or "unknown" on
+  /// other systems.
+  inline std::string CpuModel()
+  {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line))
+    {
+      if (line.compare(0, 10, "model name") != 0)
+        continue;
+      const std::size_t colon = line.find(':');
+      if (colon != std::string::npos)
+      {
+        const std::size_t start = line.find_first_not_of(' ', colon + 1);
+        if (start != std::string::npos)
+          return line.substr(start);
+      }
+    }
+    return "unknown";
+  }
+
+  /// \brief Get the compiler that built the benchmarks.
+  /// \return Name and version of the compiler.
+  inline std::string Compiler()
+  {
+#if defined(__clang__)
+    return std::string("Clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    return std::string("GCC ") + __VERSION__;
+#elif defined(_MSC_VER)
+    return "MSVC " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+  }
+
+  /// \brief Write the results of this process as a JSON document, with
+  /// the environment they were measured in. The format is described by
+  /// benchmark_schema.json, next to this file.
+  /// \param[in] _out Output stream.
+  /// \param[in] _label Label of the run, such as a commit hash, or an
+  /// empty string.
+  inline void WriteJson(std::ostream &_out, const std::string &_label)
+  {
+    auto number = [](double _v)
+    {
+      std::ostringstream ss;
+      if (std::isfinite(_v))
+        ss << std::setprecision(17) << _v;
+      else
+        ss << "null";
+      return ss.str();
+    };
+
+    char timestamp[32] = "";
+    const std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ",
+                  std::gmtime(&now));
+
+    _out << "{\n"
+         << "  \"schema\": \"gz-math-benchmark\",\n"
+         << "  \"schema_version\": 1,\n"
+         << "  \"label\": " << JsonString(_label) << ",\n"
+         << "  \"timestamp\": " << JsonString(timestamp) << ",\n"
+         << "  \"environment\": {\n"
+         << "    \"cpu\": " << JsonString(CpuModel()) << ",\n"
+         << "    \"hardware_threads\": "
+         << std::thread::hardware_concurrency() << ",\n"
+         << "    \"simd\": " << JsonString(gz::math::SimdLevelName(
+                gz::math::ActiveSimdLevel())) << ",\n"
+         << "    \"compiler\": " << JsonString(Compiler()) << ",\n"
+         << "    \"build_type\": "
+         << JsonString(IGN_MATH_BENCHMARK_BUILD_TYPE) << ",\n"
+         << "    \"flags\": " << JsonString(IGN_MATH_BENCHMARK_CXX_FLAGS)
+         << ",\n"
+         << "    \"version\": " << JsonString(IGNITION_MATH_VERSION_FULL)
+         << "\n"
+         << "  },\n"
+         << "  \"benchmarks\": [";
+
+    const auto &results = Results();
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      const Result &r = results[i];
+      _out << (i == 0 ? "\n" : ",\n")
+           << "    {\n"
+           << "      \"name\": " << JsonString(r.name) << ",\n"
+           << "      \"test\": " << JsonString(r.test) << ",\n"
+           << "      \"iterations\": " << r.iterations << ",\n"
+           << "      \"repetitions\": " << r.repetitions << ",\n"
+           << "      \"mean_ns\": " << number(r.meanNs) << ",\n"
+           << "      \"stddev_ns\": " << number(r.stdDevNs) << ",\n"
+           << "      \"min_ns\": " << number(r.minNs) << ",\n"
+           << "      \"max_ns\": " << number(r.maxNs) << ",\n"
+           << "      \"samples_ns\": [";
+      for (std::size_t s = 0; s < r.samplesNs.size(); ++s)
+        _out << (s == 0 ? "" : ", ") << number(r.samplesNs[s]);
+      _out << "],\n"
+           << "      \"metrics\": {";
+      bool first = true;
+      for (const auto &metric : r.metrics)
+      {
+        _out << (first ? "" : ", ") << JsonString(metric.first) << ": "
+             << number(metric.second);
+        first = false;
+      }
+      _out << "}\n"
+           << "    }";
+    }
+    _out << (results.empty() ? "]\n" : "\n  ]\n") << "}\n";
+  }
+
+  /// \brief Writes the results to a JSON file after all the tests, when
+  /// the IGNITION_MATH_BENCHMARK_OUTPUT environment variable is set. If it
+  /// names a .json file, the results are written to it. Otherwise it
+  /// names a directory, and the results are written to a file named after
+  /// the first test case, such as CoreTypesPerformance.json, so that the
+  /// performance tests can share the directory. The optional
+  /// IGNITION_MATH_BENCHMARK_LABEL environment variable labels the run.
+  class JsonOutput : public ::testing::Environment
+  {
+    public: void TearDown() override
+    {
+      const char *output = std::getenv("IGNITION_MATH_BENCHMARK_OUTPUT");
+      if (!output || !*output || Results().empty())
+        return;
+
+      std::string path = output;
+      const std::string extension = ".json";
+      if (path.size() < extension.size() ||
+          path.compare(path.size() - extension.size(), extension.size(),
+                       extension) != 0)
+      {
+        const std::string &test = Results().front().test;
+        path += "/" + test.substr(0, test.find('.')) + extension;
+      }
+
+      const char *label = std::getenv("IGNITION_MATH_BENCHMARK_LABEL");
+      std::ofstream out(path);
+      WriteJson(out, label ? label : "");
+      if (!out)
+        std::cerr << "Unable to write benchmark results to " << path << "\n";
+      else
+        std::cout << "[ BENCH    ] Results written to " << path << "\n";
+    }
+  };
+
+  /// \brief Registration of JsonOutput with gtest.
+  inline const bool kJsonOutputRegistered =
+      (::testing::AddGlobalTestEnvironment(new JsonOutput), true);
+
+  /// \brief Time a callable and report the time per call.
+  /// \param[in] _name Name of the benchmark, used as a property prefix.
+  /// \param[in] _iterations Number of calls per repetition.
+  /// \param[in] _fn Callable taking the iteration index.
+  /// \param[in] _repetitions Number of timed repetitions. One additional
+  /// untimed repetition is executed first to warm up caches.
+  /// \return The timing summary. In instrumented builds of the library,
+  /// the allocations and copies per call are reported as metrics.
+  template<typename F>
+  Result Run(const std::string &_name, std::size_t _iterations, F &&_fn,
+      std::size_t _repetitions = 5)
+  {
+    using Clock = std::chrono::steady_clock;
+
+    for (std::size_t i = 0; i < _iterations; ++i)
+      _fn(i);
+
+    gz::math::SignalStats stats;
+    stats.InsertStatistics("mean,var");
+
+    Result result;
+    result.name = _name;
+    result.iterations = _iterations;
+    result.repetitions = _repetitions;
+    result.minNs = std::numeric_limits<double>::max();
+    result.maxNs = 0;
+
+    const gz::math::InstrumentationCounters before =
+        gz::math::TotalCounters();
+    for (std::size_t r = 0; r < _repetitions; ++r)
+    {
+      auto start = Clock::now();
+      for (std::size_t i = 0; i < _iterations; ++i)
+        _fn(i);
+      auto end = Clock::now();
+
+      double ns = std::chrono::duration<double, std::nano>(end - start).count()
+        / static_cast<double>(_iterations);
+      stats.InsertData(ns);
+      result.samplesNs.push_back(ns);
+      result.minNs = std::min(result.minNs, ns);
+      result.maxNs = std::max(result.maxNs, ns);
+    }
+
+    auto map = stats.Map();
+    result.meanNs = map["mean"];
+    result.stdDevNs = std::sqrt(map["var"]);
+    const gz::math::InstrumentationCounters after =
+        gz::math::TotalCounters();
+
+    Report(result);
+    if (gz::math::InstrumentationEnabled())
+    {
+      const double calls = static_cast<double>(_iterations * _repetitions);
+      auto perCall = [calls](uint64_t _before, uint64_t _after)
+      {
+        return static_cast<double>(_after - _before) / calls;
+      };
+      ReportMetric(_name, "allocations_per_op",
+          perCall(before.allocations, after.allocations));
+      ReportMetric(_name, "allocated_bytes_per_op",
+          perCall(before.allocatedBytes, after.allocatedBytes));
+      ReportMetric(_name, "copies_per_op",
+          perCall(before.copies, after.copies));
+      ReportMetric(_name, "copied_bytes_per_op",
+          perCall(before.copiedBytes, after.copiedBytes));
+      result.metrics = Results().back().metrics;
+    }
+    return result;
+  }
+}
+
+#endif
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+# Copyright (C) 2023 Open Source Robotics Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License")
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#       http:#www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Measure the cost of the Python binding glue.
+
+The same operations are timed with one call per element, which constructs
+and converts a Python object for each element, and with the batch functions
+over numpy arrays. The throughput of both is printed in the format of the
+C++ performance tests. Nothing is checked: the results of the batch
+functions are tested by BatchOperations_TEST.py, and the timings depend on
+the machine.
+"""
+
+import time
+
+import numpy as np
+
+from ignition.math import (Angle, Kmeans, Pose3d, Quaterniond,
+                           SphericalCoordinates, Vector3d, kmeans_cluster,
+                           quaternion_multiply, rotate_vectors,
+                           spherical_position_transform, transform_points)
+
+# Number of elements of each benchmark.
+COUNT = 2000
+
+# Number of timed repetitions, of which the fastest is reported.
+REPETITIONS = 5
+
+
+def benchmark(name, count, fn):
+    """Time a function processing count elements.
+
+    Print the time per element and the number of elements processed per
+    second by the fastest repetition. A first untimed call warms up caches.
+    """
+    fn()
+    best = float('inf')
+    for _ in range(REPETITIONS):
+        start = time.perf_counter()
+        fn()
+        best = min(best, time.perf_counter() - start)
+
+    print('[ BENCH    ] {:<48}{:12.3f} ns/elem {:14.0f} elem/s'.format(
+        name, best * 1e9 / count, count / best))
+
+
+def to_vector(row):
+    return Vector3d(row[0], row[1], row[2])
+
+
+def to_quaternion(row):
+    return Quaterniond(row[0], row[1], row[2], row[3])
+
+
+def main():
+    rng = np.random.default_rng(1234)
+    points = rng.uniform(-10, 10, (COUNT, 3))
+    others = rng.uniform(-10, 10, (COUNT, 3))
+    quats = rng.normal(size=(COUNT, 4))
+    quats /= np.linalg.norm(quats, axis=1)[:, np.newaxis]
+    shifted = np.roll(quats, 1, axis=0)
+
+    # Python objects, converted once, as kept by a caller that works with
+    # the per element API.
+    vectors = [to_vector(p) for p in points]
+    other_vectors = [to_vector(p) for p in others]
+    quaternions = [to_quaternion(q) for q in quats]
+    shifted_quaternions = [to_quaternion(q) for q in shifted]
+
+    # Vector3 has no batch functions: numpy already provides the element
+    # wise arithmetic on (N, 3) arrays.
+    benchmark('Vector3d cross,dot,length', COUNT,
+              lambda: [a.cross(b).dot(a) + a.length()
+                       for a, b in zip(vectors, other_vectors)])
+    benchmark('Vector3d cross,dot,length batch', COUNT,
+              lambda: np.einsum('ij,ij->i', np.cross(points, others),
+                                points) + np.linalg.norm(points, axis=1))
+
+    pose = Pose3d(1, -2, 3, 0.1, 0.2, 0.3)
+    out = np.empty_like(points)
+    benchmark('Pose3d.coord_position_add', COUNT,
+              lambda: [pose.coord_position_add(v) for v in vectors])
+    benchmark('transform_points', COUNT,
+              lambda: transform_points(pose, points))
+    benchmark('transform_points(out)', COUNT,
+              lambda: transform_points(pose, points, out=out))
+
+    benchmark('Quaterniond.rotate_vector', COUNT,
+              lambda: [q.rotate_vector(v)
+                       for q, v in zip(quaternions, vectors)])
+    benchmark('rotate_vectors', COUNT,
+              lambda: rotate_vectors(quats, points))
+
+    benchmark('Quaterniond.__mul__', COUNT,
+              lambda: [a * b
+                       for a, b in zip(quaternions, shifted_quaternions)])
+    benchmark('quaternion_multiply', COUNT,
+              lambda: quaternion_multiply(quats, shifted))
+
+    sc = SphericalCoordinates(
+        SphericalCoordinates.EARTH_WGS84, Angle(0.3), Angle(-1.2),
+        10.0, Angle(0.4))
+    local = points * 100.0
+    local_vectors = [to_vector(p) for p in local]
+    benchmark('SphericalCoordinates.position_transform', COUNT,
+              lambda: [sc.position_transform(v, SphericalCoordinates.LOCAL2,
+                                             SphericalCoordinates.ECEF)
+                       for v in local_vectors])
+    benchmark('spherical_position_transform', COUNT,
+              lambda: spherical_position_transform(
+                  sc, local, SphericalCoordinates.LOCAL2,
+                  SphericalCoordinates.ECEF))
+
+    # The clustering dominates, so only the conversion of the observations
+    # and results differs.
+    benchmark('Kmeans.cluster', COUNT,
+              lambda: Kmeans([to_vector(p) for p in points]).cluster(8))
+    benchmark('kmeans_cluster', COUNT,
+              lambda: kmeans_cluster(points, 8))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,4360 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gz/math/AdditivelySeparableScalarField3.hh"
+#include "gz/math/AxisAlignedBox.hh"
+#include "gz/math/AxisAlignedBox3.hh"
+#include "gz/math/BasicStopwatch.hh"
+#include "gz/math/BinaryCodec.hh"
+#include "gz/math/BoundingVolumeHierarchy.hh"
+#include "gz/math/Box.hh"
+#include "gz/math/CachedPose3.hh"
+#include "gz/math/Capsule.hh"
+#include "gz/math/Color.hh"
+#include "gz/math/Colormap.hh"
+#include "gz/math/Dbscan.hh"
+#include "gz/math/DiffDriveOdometry.hh"
+#include "gz/math/DiffDriveOdometryBank.hh"
+#include "gz/math/DynamicAabbTree.hh"
+#include "gz/math/Filter.hh"
+#include "gz/math/FrameTree.hh"
+#include "gz/math/Frustum.hh"
+#include "gz/math/GaussMarkovProcess.hh"
+#include "gz/math/GaussMarkovProcessEnsemble.hh"
+#include "gz/math/Half.hh"
+#include "gz/math/IcpRegistration.hh"
+#include "gz/math/Inertial.hh"
+#include "gz/math/KalmanFilter.hh"
+#include "gz/math/KdTree3.hh"
+#include "gz/math/Line2.hh"
+#include "gz/math/Line3.hh"
+#include "gz/math/MassMatrix3.hh"
+#include "gz/math/Material.hh"
+#include "gz/math/Matrix3SoA.hh"
+#include "gz/math/Matrix4.hh"
+#include "gz/math/Matrix6.hh"
+#include "gz/math/MatrixChain.hh"
+#include "gz/math/MatrixN.hh"
+#include "gz/math/MeshBoundingVolumeHierarchy.hh"
+#include "gz/math/MovingWindowFilter.hh"
+#include "gz/math/NormalEstimator.hh"
+#include "gz/math/OcclusionCuller.hh"
+#include "gz/math/OrientedBox.hh"
+#include "gz/math/PID.hh"
+#include "gz/math/PIDBank.hh"
+#include "gz/math/PiecewiseScalarField3.hh"
+#include "gz/math/PointGrid.hh"
+#include "gz/math/PointOctree.hh"
+#include "gz/math/PointSetFilter.hh"
+#include "gz/math/Polygon2.hh"
+#include "gz/math/PolylineSimplifier.hh"
+#include "gz/math/Plane.hh"
+#include "gz/math/Polynomial3.hh"
+#include "gz/math/Pose3.hh"
+#include "gz/math/PoseTrajectory.hh"
+#include "gz/math/Profiler.hh"
+#include "gz/math/Quaternion.hh"
+#include "gz/math/QuaternionSoA.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/RansacFitter.hh"
+#include "gz/math/RollingMean.hh"
+#include "gz/math/RotationSpline.hh"
+#include "gz/math/SemanticVersion.hh"
+#include "gz/math/SignalStats.hh"
+#include "gz/math/SpatialSort.hh"
+#include "gz/math/SkinWeights.hh"
+#include "gz/math/SpatialInertia.hh"
+#include "gz/math/SpatialTransform.hh"
+#include "gz/math/SpeedLimiter.hh"
+#include "gz/math/SpeedLimiterBank.hh"
+#include "gz/math/SphericalCoordinates.hh"
+#include "gz/math/Spline.hh"
+#include "gz/math/SweepAndPrune.hh"
+#include "gz/math/Temperature.hh"
+#include "gz/math/TemperatureQuantizer.hh"
+#include "gz/math/TrajectoryFile.hh"
+#include "gz/math/Triangle.hh"
+#include "gz/math/Triangle3.hh"
+#include "gz/math/TscClock.hh"
+#include "gz/math/Vector3.hh"
+#include "gz/math/Vector3HashSet.hh"
+#include "gz/math/Vector3SoA.hh"
+#include "gz/math/Vector3Stats.hh"
+#include "gz/math/Vector3hArray.hh"
+
+#include "performance/Benchmark.hh"
+
+using namespace gz;
+using namespace math;
+
+// Number of distinct inputs cycled through by each benchmark. Kept small
+// enough to stay in cache so that we measure arithmetic, not memory.
+static const std::size_t kInputs = 1024;
+
+// Number of operations per timed repetition.
+static const std::size_t kIterations = 200000;
+
+/////////////////////////////////////////////////
+std::vector<Vector3d> RandomPoints(double _min, double _max)
+{
+  std::vector<Vector3d> points(kInputs);
+  for (auto &p : points)
+  {
+    p.Set(Rand::DblUniform(_min, _max),
+          Rand::DblUniform(_min, _max),
+          Rand::DblUniform(_min, _max));
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+std::vector<Pose3d> RandomPoses()
+{
+  std::vector<Pose3d> poses(kInputs);
+  for (auto &p : poses)
+  {
+    p.Set(Rand::DblUniform(-10, 10), Rand::DblUniform(-10, 10),
+          Rand::DblUniform(-10, 10), Rand::DblUniform(-IGN_PI, IGN_PI),
+          Rand::DblUniform(-IGN_PI * 0.5, IGN_PI * 0.5),
+          Rand::DblUniform(-IGN_PI, IGN_PI));
+  }
+  return poses;
+}
+
+/////////////////////////////////////////////////
+class CoreTypesPerformance : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    Rand::Seed(1234);
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, AngleNormalizeBatch)
+{
+  std::vector<double> angles(kInputs);
+  double heading = 0;
+  for (auto &a : angles)
+  {
+    heading += Rand::DblUniform(-0.5, 1.5);
+    a = heading;
+  }
+  std::vector<double> out(kInputs);
+
+  const std::size_t batches = kIterations / kInputs;
+  benchmark::Run("Angle.Normalized (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        out[i] = *Angle(angles[i]).Normalized();
+      benchmark::DoNotOptimize(out.data());
+    });
+
+  benchmark::Run("Angle::Normalize (batch)", batches,
+    [&](std::size_t)
+    {
+      Angle::Normalize(angles.data(), kInputs, out.data());
+      benchmark::DoNotOptimize(out.data());
+    });
+
+  std::vector<double> wrapped(kInputs);
+  Angle::Normalize(angles.data(), kInputs, wrapped.data());
+  benchmark::Run("Angle::Unwrap", batches,
+    [&](std::size_t)
+    {
+      Angle::Unwrap(wrapped.data(), kInputs, out.data());
+      benchmark::DoNotOptimize(out.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, Pose3Multiply)
+{
+  auto poses = RandomPoses();
+  Pose3d acc;
+  benchmark::Run("Pose3d.operator*", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = poses[_i % kInputs] * poses[(_i + 1) % kInputs];
+      benchmark::DoNotOptimize(acc);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, Pose3CoordPositionAdd)
+{
+  auto poses = RandomPoses();
+  auto points = RandomPoints(-10, 10);
+  Vector3d acc;
+  benchmark::Run("Pose3d.CoordPositionAdd", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = poses[_i % kInputs].CoordPositionAdd(points[_i % kInputs]);
+      benchmark::DoNotOptimize(acc);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, Pose3CoordPositionAddBatch)
+{
+  auto poses = RandomPoses();
+  auto points = RandomPoints(-10, 10);
+  std::vector<Vector3d> out;
+  benchmark::Run("Pose3d.CoordPositionAdd(vector)", kIterations / kInputs,
+    [&](std::size_t _i)
+    {
+      poses[_i % kInputs].CoordPositionAdd(points, out);
+      benchmark::DoNotOptimize(out.data());
+    });
+
+  Vector3SoAd soa(points);
+  Vector3SoAd soaOut;
+  benchmark::Run("Pose3d.CoordPositionAdd(Vector3SoA)",
+    kIterations / kInputs,
+    [&](std::size_t _i)
+    {
+      poses[_i % kInputs].CoordPositionAdd(soa, soaOut);
+      benchmark::DoNotOptimize(soaOut.XData());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, CachedPose3Attitude)
+{
+  auto poses = RandomPoses();
+  auto points = RandomPoints(-10, 10);
+  double acc = 0;
+  benchmark::Run("Pose3d Roll+Pitch+Yaw", kIterations,
+    [&](std::size_t _i)
+    {
+      const Pose3d &pose = poses[_i % kInputs];
+      acc = pose.Roll() + pose.Pitch() + pose.Yaw();
+      benchmark::DoNotOptimize(acc);
+    });
+
+  std::vector<CachedPose3d> cached;
+  for (const auto &pose : poses)
+    cached.push_back(CachedPose3d(pose));
+  benchmark::Run("CachedPose3d Roll+Pitch+Yaw", kIterations,
+    [&](std::size_t _i)
+    {
+      const CachedPose3d &pose = cached[_i % kInputs];
+      acc = pose.Roll() + pose.Pitch() + pose.Yaw();
+      benchmark::DoNotOptimize(acc);
+    });
+
+  Vector3d point;
+  benchmark::Run("CachedPose3d.CoordPositionAdd", kIterations,
+    [&](std::size_t _i)
+    {
+      point = cached[_i % kInputs].CoordPositionAdd(points[_i % kInputs]);
+      benchmark::DoNotOptimize(point);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, FrameTreeWorldPoses)
+{
+  // A robot with 8 limbs of 32 links, the leaves queried every tick after
+  // one joint of one limb moves
+  const auto poses = RandomPoses();
+  FrameTree tree;
+  const std::size_t base = tree.AddFrame("base", FrameTree::kNoFrame,
+      poses[0]);
+  std::vector<std::size_t> leaves;
+  std::vector<std::vector<std::size_t>> limbs;
+  for (std::size_t limb = 0; limb < 8; ++limb)
+  {
+    limbs.emplace_back();
+    std::size_t parent = base;
+    for (std::size_t link = 0; link < 32; ++link)
+    {
+      const std::string name =
+        "limb" + std::to_string(limb) + "_link" + std::to_string(link);
+      parent = tree.AddFrame(name, parent, poses[limbs.size() * 32 + link]);
+      limbs.back().push_back(parent);
+    }
+    leaves.push_back(parent);
+  }
+
+  std::vector<Pose3d> world(leaves.size());
+  benchmark::Run("Pose3d chain composition (tick)", kIterations / 256,
+    [&](std::size_t _i)
+    {
+      const std::size_t limb = _i % limbs.size();
+      const std::size_t joint = limbs[limb][_i % 32];
+      tree.SetRelativePose(joint, poses[_i % kInputs]);
+      for (std::size_t l = 0; l < limbs.size(); ++l)
+      {
+        Pose3d pose = tree.RelativePose(base);
+        for (const std::size_t frame : limbs[l])
+          pose = pose * tree.RelativePose(frame);
+        world[l] = pose;
+      }
+      benchmark::DoNotOptimize(world.data());
+    });
+
+  benchmark::Run("FrameTree.WorldPoses (tick)", kIterations / 256,
+    [&](std::size_t _i)
+    {
+      const std::size_t limb = _i % limbs.size();
+      const std::size_t joint = limbs[limb][_i % 32];
+      tree.SetRelativePose(joint, poses[_i % kInputs]);
+      tree.WorldPoses(leaves, world);
+      benchmark::DoNotOptimize(world.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SkinWeightsBlend)
+{
+  // 64 bones and four influences per vertex
+  const std::size_t bones = 64;
+  const std::size_t vertices = 16 * kInputs;
+  const auto poses = RandomPoses();
+  std::vector<Pose3d> bonePoses(poses.begin(), poses.begin() + bones);
+  std::vector<Matrix4d> transforms;
+  for (const auto &pose : bonePoses)
+    transforms.push_back(Matrix4d(pose));
+
+  SkinWeights weights(vertices, 4);
+  std::vector<Vector3d> rest;
+  for (std::size_t v = 0; v < vertices; ++v)
+  {
+    for (std::size_t k = 0; k < 4; ++k)
+    {
+      weights.SetInfluence(v, k,
+          static_cast<uint32_t>(Rand::IntUniform(0, bones - 1)),
+          Rand::DblUniform(0, 1));
+    }
+    rest.push_back(Vector3d(Rand::DblUniform(-1, 1),
+        Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1)));
+  }
+  weights.NormalizeWeights();
+
+  std::vector<Vector3d> out(vertices);
+  const std::size_t calls = kIterations / vertices + 1;
+  benchmark::Run("Linear blend skinning (loop)", calls,
+    [&](std::size_t)
+    {
+      for (std::size_t v = 0; v < vertices; ++v)
+      {
+        Vector3d p;
+        for (std::size_t k = 0; k < 4; ++k)
+        {
+          p += (transforms[weights.Bone(v, k)] * rest[v]) *
+            weights.Weight(v, k);
+        }
+        out[v] = p;
+      }
+      benchmark::DoNotOptimize(out.data());
+    });
+
+  Vector3SoAd restSoA(rest);
+  Vector3SoAd outSoA;
+  benchmark::Run("SkinWeights.LinearBlend", calls,
+    [&](std::size_t)
+    {
+      weights.LinearBlend(transforms, restSoA, outSoA);
+      benchmark::DoNotOptimize(outSoA.XData());
+    });
+
+  benchmark::Run("SkinWeights.DualQuaternionBlend", calls,
+    [&](std::size_t)
+    {
+      weights.DualQuaternionBlend(bonePoses, restSoA, outSoA);
+      benchmark::DoNotOptimize(outSoA.XData());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, InertialSum)
+{
+  const std::vector<Pose3d> poses = RandomPoses();
+  std::vector<Inertiald> inertials;
+  for (const auto &pose : poses)
+  {
+    inertials.emplace_back(MassMatrix3d(Rand::DblUniform(1, 2),
+        Vector3d(3, 3, 3), Vector3d(0.1, 0.2, 0.3)), pose);
+  }
+
+  // Each call sums kInputs bodies
+  const std::size_t sums = kIterations / kInputs;
+  benchmark::Run("Inertial::operator+=", sums,
+    [&](std::size_t)
+    {
+      Inertiald sum = inertials[0];
+      for (std::size_t i = 1; i < kInputs; ++i)
+        sum += inertials[i];
+      benchmark::DoNotOptimize(sum);
+    });
+
+  benchmark::Run("Inertial::Sum", sums,
+    [&](std::size_t)
+    {
+      Inertiald sum = Inertiald::Sum(inertials);
+      benchmark::DoNotOptimize(sum);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, BoxVolumesBelow)
+{
+  // Floating boxes around a water plane at z = 0
+  const Planed water(Vector3d::UnitZ, 0);
+  std::vector<Pose3d> poses = RandomPoses();
+  std::vector<Vector3d> sizes(kInputs);
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    poses[i].Pos().Z() = Rand::DblUniform(-1, 1);
+    sizes[i].Set(Rand::DblUniform(0.5, 2), Rand::DblUniform(0.5, 2),
+                 Rand::DblUniform(0.5, 2));
+  }
+
+  // Each call computes kInputs boxes
+  const std::size_t calls = kIterations / kInputs;
+  std::vector<double> volumes(kInputs);
+  std::vector<Vector3d> centers(kInputs);
+  benchmark::Run("Box::VolumeBelow", calls,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+      {
+        const Vector3d n = poses[i].Rot().RotateVectorReverse(
+            water.Normal());
+        const Planed local(n, water.Offset() - poses[i].Pos().Z());
+        volumes[i] = Boxd(sizes[i]).VolumeBelow(local);
+      }
+      benchmark::DoNotOptimize(volumes);
+    });
+
+  benchmark::Run("Box::VolumesBelow", calls,
+    [&](std::size_t)
+    {
+      Boxd::VolumesBelow(sizes.data(), poses.data(), kInputs, water,
+                         volumes.data(), centers.data());
+      benchmark::DoNotOptimize(volumes);
+      benchmark::DoNotOptimize(centers);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, CapsuleMassMatrices)
+{
+  std::vector<double> lengths(kInputs);
+  std::vector<double> radii(kInputs);
+  std::vector<double> densities(kInputs);
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    lengths[i] = Rand::DblUniform(0.1, 2);
+    radii[i] = Rand::DblUniform(0.1, 1);
+    densities[i] = Rand::DblUniform(100, 1000);
+  }
+
+  // Each call computes kInputs mass matrices
+  const std::size_t calls = kIterations / kInputs;
+  std::vector<MassMatrix3d> massMats(kInputs);
+  benchmark::Run("Capsule::MassMatrix", calls,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+      {
+        Capsuled capsule(lengths[i], radii[i], Material(densities[i]));
+        massMats[i] = *capsule.MassMatrix();
+      }
+      benchmark::DoNotOptimize(massMats);
+    });
+
+  benchmark::Run("Capsule::MassMatrices", calls,
+    [&](std::size_t)
+    {
+      bool ok = Capsuled::MassMatrices(lengths.data(), radii.data(),
+          densities.data(), kInputs, massMats.data());
+      benchmark::DoNotOptimize(ok);
+      benchmark::DoNotOptimize(massMats);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, MassMatrix3PrincipalAxes)
+{
+  // Random rotated boxes, which have distinct principal moments
+  std::vector<MassMatrix3d> matrices(kInputs);
+  for (auto &m : matrices)
+  {
+    m.SetFromBox(Rand::DblUniform(1, 2),
+        Vector3d(Rand::DblUniform(1, 2), Rand::DblUniform(1, 2),
+                 Rand::DblUniform(1, 2)),
+        Quaterniond(Rand::DblUniform(-IGN_PI, IGN_PI),
+                    Rand::DblUniform(-IGN_PI, IGN_PI),
+                    Rand::DblUniform(-IGN_PI, IGN_PI)));
+  }
+
+  benchmark::Run("MassMatrix3::IsValid", kIterations,
+    [&](std::size_t _i)
+    {
+      bool valid = matrices[_i % kInputs].IsValid();
+      benchmark::DoNotOptimize(valid);
+    });
+
+  benchmark::Run("MassMatrix3::EquivalentBox", kIterations,
+    [&](std::size_t _i)
+    {
+      Vector3d size;
+      Quaterniond rot;
+      bool ok = matrices[_i % kInputs].EquivalentBox(size, rot);
+      benchmark::DoNotOptimize(ok);
+      benchmark::DoNotOptimize(size);
+    });
+
+  std::vector<Vector3d> moments(kInputs);
+  benchmark::Run("MassMatrix3::PrincipalMoments batch", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      MassMatrix3d::PrincipalMoments(matrices.data(), kInputs,
+                                     moments.data());
+      benchmark::DoNotOptimize(moments);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, MaterialLookup)
+{
+  std::vector<std::string> names;
+  std::vector<double> densities;
+  for (const auto &mat : Material::Predefined())
+  {
+    names.push_back(mat.second.Name());
+    densities.push_back(mat.second.Density() * 1.01);
+  }
+
+  benchmark::Run("Material(name)", kIterations,
+    [&](std::size_t _i)
+    {
+      Material material(names[_i % names.size()]);
+      benchmark::DoNotOptimize(material);
+    });
+
+  benchmark::Run("Material::SetToNearestDensity", kIterations,
+    [&](std::size_t _i)
+    {
+      Material material;
+      material.SetToNearestDensity(densities[_i % densities.size()]);
+      benchmark::DoNotOptimize(material);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, Matrix4Inverse)
+{
+  auto poses = RandomPoses();
+  std::vector<Matrix4d> matrices;
+  for (const auto &p : poses)
+    matrices.push_back(Matrix4d(p));
+
+  Matrix4d acc;
+  benchmark::Run("Matrix4d.Inverse", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = matrices[_i % kInputs].Inverse();
+      benchmark::DoNotOptimize(acc);
+    });
+
+  std::vector<Matrix4f> matricesf;
+  for (const auto &m : matrices)
+  {
+    Matrix4f mf;
+    for (int i = 0; i < 4; ++i)
+      for (int j = 0; j < 4; ++j)
+        mf(i, j) = static_cast<float>(m(i, j));
+    matricesf.push_back(mf);
+  }
+
+  Matrix4f accf;
+  benchmark::Run("Matrix4f.Inverse", kIterations,
+    [&](std::size_t _i)
+    {
+      accf = matricesf[_i % kInputs].Inverse();
+      benchmark::DoNotOptimize(accf);
+    });
+
+  benchmark::Run("Matrix4d.InverseRigid", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = matrices[_i % kInputs].InverseRigid();
+      benchmark::DoNotOptimize(acc);
+    });
+  benchmark::Run("Matrix4d.InverseAffine", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = matrices[_i % kInputs].InverseAffine();
+      benchmark::DoNotOptimize(acc);
+    });
+
+  std::vector<Pose3d> inverses(poses.size());
+  benchmark::Run("Pose3d.Inverse (loop of 1024)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < poses.size(); ++i)
+        inverses[i] = poses[i].Inverse();
+      benchmark::DoNotOptimize(inverses);
+    });
+  benchmark::Run("Pose3d::Inverse (batch of 1024)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      Pose3d::Inverse(poses.data(), poses.size(), inverses.data());
+      benchmark::DoNotOptimize(inverses);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, Matrix4Multiply)
+{
+  auto poses = RandomPoses();
+  std::vector<Matrix4d> matrices;
+  for (const auto &p : poses)
+    matrices.push_back(Matrix4d(p));
+
+  Matrix4d acc;
+  benchmark::Run("Matrix4d.operator*", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = matrices[_i % kInputs] * matrices[(_i + 1) % kInputs];
+      benchmark::DoNotOptimize(acc);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, Matrix4Project)
+{
+  // Perspective projection of a camera with a 90 degree field of view,
+  // times the view matrix of a camera at the origin.
+  const Matrix4d proj(1, 0, 0, 0,
+                      0, 1, 0, 0,
+                      0, 0, -1.002, -0.2002,
+                      0, 0, -1, 0);
+  const Matrix4d mat = proj * Matrix4d(Pose3d(0, 0, 0, 0.1, 0.2, 0.3));
+  auto points = RandomPoints(-10, 10);
+  const Vector3SoAd soa(points);
+  Vector3SoAf soaf;
+  for (const auto &p : points)
+    soaf.PushBack(Vector3f(p.X(), p.Y(), p.Z()));
+  const Matrix4f matf(
+      mat(0, 0), mat(0, 1), mat(0, 2), mat(0, 3),
+      mat(1, 0), mat(1, 1), mat(1, 2), mat(1, 3),
+      mat(2, 0), mat(2, 1), mat(2, 2), mat(2, 3),
+      mat(3, 0), mat(3, 1), mat(3, 2), mat(3, 3));
+
+  // The batch benchmarks report the time per batch of kInputs points.
+  std::vector<Vector3d> projected(kInputs);
+  benchmark::Run("Matrix4d.operator*(Vector3d) batch", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        projected[i] = mat * points[i];
+      benchmark::DoNotOptimize(projected.data());
+    });
+
+  std::vector<double> u, v, depth;
+  std::vector<uint8_t> clip;
+  benchmark::Run("Matrix4d.Project(Vector3SoAd)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      std::size_t inside = mat.Project(soa, 640, 480, u, v, depth, clip);
+      benchmark::DoNotOptimize(inside);
+    });
+
+  std::vector<float> uf, vf, depthf;
+  benchmark::Run("Matrix4f.Project(Vector3SoAf)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      std::size_t inside = matf.Project(soaf, 640, 480, uf, vf, depthf,
+                                        clip);
+      benchmark::DoNotOptimize(inside);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, MatrixChain)
+{
+  auto poses = RandomPoses();
+  auto points = RandomPoints(-10, 10);
+  std::vector<Matrix4d> matrices;
+  for (const auto &p : poses)
+    matrices.push_back(Matrix4d(p));
+
+  Vector3d accPoint;
+  benchmark::Run("Matrix4d A*B*C*v", kIterations,
+    [&](std::size_t _i)
+    {
+      accPoint = matrices[_i % kInputs] * matrices[(_i + 1) % kInputs] *
+          matrices[(_i + 2) % kInputs] * points[_i % kInputs];
+      benchmark::DoNotOptimize(accPoint);
+    });
+  benchmark::Run("Chain(A)*B*C*v", kIterations,
+    [&](std::size_t _i)
+    {
+      accPoint = Chain(matrices[_i % kInputs]) *
+          matrices[(_i + 1) % kInputs] * matrices[(_i + 2) % kInputs] *
+          points[_i % kInputs];
+      benchmark::DoNotOptimize(accPoint);
+    });
+
+  // Spatial inertia style 6x6 products
+  std::vector<Matrix6d> spatial(kInputs);
+  for (std::size_t n = 0; n < kInputs; ++n)
+  {
+    const Matrix3d rot(poses[n].Rot());
+    spatial[n].SetSubmatrix(Matrix6d::TOP_LEFT, rot);
+    spatial[n].SetSubmatrix(Matrix6d::BOTTOM_RIGHT, rot);
+    spatial[n].SetSubmatrix(Matrix6d::BOTTOM_LEFT, rot * 0.5);
+  }
+  Matrix6d acc;
+  benchmark::Run("Matrix6d A*B*C", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = spatial[_i % kInputs] * spatial[(_i + 1) % kInputs] *
+          spatial[(_i + 2) % kInputs];
+      benchmark::DoNotOptimize(acc);
+    });
+  benchmark::Run("Matrix6d A+B", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = spatial[_i % kInputs] + spatial[(_i + 1) % kInputs];
+      benchmark::DoNotOptimize(acc);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, MatrixN)
+{
+  auto poses = RandomPoses();
+  std::vector<Matrix6d> matrices(kInputs);
+  std::vector<MatrixN<double, 6, 6>> fixed;
+  for (std::size_t n = 0; n < kInputs; ++n)
+  {
+    const Matrix3d rot(poses[n].Rot());
+    matrices[n].SetSubmatrix(Matrix6d::TOP_LEFT, rot);
+    matrices[n].SetSubmatrix(Matrix6d::BOTTOM_RIGHT, rot);
+    matrices[n].SetSubmatrix(Matrix6d::BOTTOM_LEFT, rot * 0.5);
+    fixed.emplace_back(matrices[n]);
+  }
+
+  Matrix6d acc;
+  benchmark::Run("Matrix6d A*B", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = matrices[_i % kInputs] * matrices[(_i + 1) % kInputs];
+      benchmark::DoNotOptimize(acc);
+    });
+  MatrixN<double, 6, 6> accFixed;
+  benchmark::Run("MatrixN<double, 6, 6> A*B", kIterations,
+    [&](std::size_t _i)
+    {
+      accFixed = fixed[_i % kInputs] * fixed[(_i + 1) % kInputs];
+      benchmark::DoNotOptimize(accFixed);
+    });
+
+  // Covariance update of a 7 state Kalman filter with a 3D position
+  // measurement
+  auto f = MatrixN<double, 7, 7>::Identity();
+  for (std::size_t i = 0; i < 3; ++i)
+    f(i, i + 3) = 0.01;
+  const auto q = MatrixN<double, 7, 7>::Identity() * 1e-4;
+  const auto h = MatrixN<double, 3, 7>::Identity();
+  const auto r = MatrixN<double, 3, 3>::Identity() * 0.01;
+  auto p = MatrixN<double, 7, 7>::Identity();
+  benchmark::Run("MatrixN 7 state Kalman predict + update", kIterations,
+    [&](std::size_t)
+    {
+      p = f * p * f.Transposed() + q;
+      const auto pht = p * h.Transposed();
+      auto s = h * pht + r;
+      s.CholeskyFactor();
+      const auto k = s.CholeskySolve(pht.Transposed()).Transposed();
+      p = p - k * pht.Transposed();
+      benchmark::DoNotOptimize(p);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, KalmanFilterBank)
+{
+  // Constant velocity trackers in 3D with position measurements
+  using Matrix6 = MatrixN<double, 6, 6>;
+  const double dt = 0.033;
+  Matrix6 f = Matrix6::Identity();
+  for (std::size_t i = 0; i < 3; ++i)
+    f(i, i + 3) = dt;
+  const Matrix6 q = Matrix6::Identity() * 1e-3;
+  const auto h = MatrixN<double, 3, 6>::Identity();
+  const auto r = MatrixN<double, 3, 3>::Identity() * 0.01;
+
+  auto points = RandomPoints(-10, 10);
+  const std::size_t count = kInputs;
+  std::vector<KalmanFilter<double, 6, 3>> filters;
+  KalmanFilterBank<double, 6, 3> bank(count);
+  std::vector<double> z(3 * count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    VectorN<double, 6> x;
+    x.SetBlock(0, 0, VectorN<double, 3>(points[i]));
+    filters.emplace_back(x, Matrix6::Identity());
+    bank.SetFilter(i, x, Matrix6::Identity());
+    for (std::size_t k = 0; k < 3; ++k)
+      z[k * count + i] = points[i][k] + 0.01;
+  }
+
+  benchmark::Run("KalmanFilter predict + update (loop of 1024)",
+    kIterations / kInputs / 10,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        filters[i].Predict(f, q);
+        filters[i].Update(VectorN<double, 3>{z[i], z[count + i],
+                          z[2 * count + i]}, h, r);
+      }
+      benchmark::DoNotOptimize(filters.data());
+    });
+  benchmark::Run("KalmanFilterBank predict + update (1024)",
+    kIterations / kInputs / 10,
+    [&](std::size_t)
+    {
+      bank.Predict(f, q);
+      bank.Update(z.data(), h, r);
+      benchmark::DoNotOptimize(bank.StateData(0));
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SpatialTransformApply)
+{
+  auto poses = RandomPoses();
+  auto points = RandomPoints(-10, 10);
+  std::vector<SpatialTransformd> transforms;
+  std::vector<Matrix6d> matrices;
+  std::vector<SpatialVectord> twists;
+  for (std::size_t n = 0; n < kInputs; ++n)
+  {
+    transforms.push_back(SpatialTransformd(poses[n]));
+    matrices.push_back(transforms.back().MotionMatrix());
+    twists.push_back(SpatialVectord(points[n], points[(n + 1) % kInputs]));
+  }
+
+  SpatialVectord acc;
+  benchmark::Run("Matrix6d motion transform", kIterations,
+    [&](std::size_t _i)
+    {
+      const Matrix6d &m = matrices[_i % kInputs];
+      const SpatialVectord &v = twists[_i % kInputs];
+      double in[6] = {v.Angular().X(), v.Angular().Y(), v.Angular().Z(),
+                      v.Linear().X(), v.Linear().Y(), v.Linear().Z()};
+      double out[6];
+      for (std::size_t r = 0; r < 6; ++r)
+      {
+        out[r] = 0;
+        for (std::size_t c = 0; c < 6; ++c)
+          out[r] += m(r, c) * in[c];
+      }
+      acc.Set(Vector3d(out[0], out[1], out[2]),
+              Vector3d(out[3], out[4], out[5]));
+      benchmark::DoNotOptimize(acc);
+    });
+  benchmark::Run("SpatialTransformd.ApplyMotion", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = transforms[_i % kInputs].ApplyMotion(twists[_i % kInputs]);
+      benchmark::DoNotOptimize(acc);
+    });
+  benchmark::Run("SpatialTransformd.InverseApplyForce", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = transforms[_i % kInputs].InverseApplyForce(twists[_i % kInputs]);
+      benchmark::DoNotOptimize(acc);
+    });
+
+  Matrix6d accMatrix;
+  SpatialTransformd accTransform;
+  benchmark::Run("Matrix6d compose", kIterations,
+    [&](std::size_t _i)
+    {
+      accMatrix = matrices[_i % kInputs] * matrices[(_i + 1) % kInputs];
+      benchmark::DoNotOptimize(accMatrix);
+    });
+  benchmark::Run("SpatialTransformd compose", kIterations,
+    [&](std::size_t _i)
+    {
+      accTransform = transforms[_i % kInputs] *
+          transforms[(_i + 1) % kInputs];
+      benchmark::DoNotOptimize(accTransform);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SpatialInertiaTransform)
+{
+  auto poses = RandomPoses();
+  auto points = RandomPoints(-1, 1);
+  std::vector<Inertiald> inertials;
+  std::vector<SpatialTransformd> transforms;
+  std::vector<Matrix6d> forceMatrices;
+  std::vector<Matrix6d> motionMatrices;
+  for (std::size_t n = 0; n < kInputs; ++n)
+  {
+    MassMatrix3d massMatrix;
+    massMatrix.SetFromBox(1 + std::abs(points[n].X()),
+                          Vector3d(0.5, 1, 0.25));
+    inertials.push_back(Inertiald(massMatrix,
+        Pose3d(points[n], poses[(n + 1) % kInputs].Rot())));
+    transforms.push_back(SpatialTransformd(poses[n]));
+    forceMatrices.push_back(transforms.back().ForceMatrix());
+    motionMatrices.push_back(transforms.back().Inverse().MotionMatrix());
+  }
+  std::vector<SpatialInertiad> spatial(kInputs);
+  SpatialInertiad::FromInertials(inertials.data(), kInputs, spatial.data());
+  std::vector<Matrix6d> spatialMatrices;
+  for (const auto &i : spatial)
+    spatialMatrices.push_back(i.Matrix());
+
+  Matrix6d accMatrix;
+  benchmark::Run("Matrix6d from Inertiald", kIterations,
+    [&](std::size_t _i)
+    {
+      const Inertiald &inertial = inertials[_i % kInputs];
+      const Vector3d &c = inertial.Pose().Pos();
+      const double m = inertial.MassMatrix().Mass();
+      const Matrix3d cx(0, -c.Z(), c.Y(), c.Z(), 0, -c.X(), -c.Y(), c.X(),
+                        0);
+      accMatrix.SetSubmatrix(Matrix6d::TOP_LEFT,
+          inertial.Moi() + cx * cx.Transposed() * m);
+      accMatrix.SetSubmatrix(Matrix6d::TOP_RIGHT, cx * m);
+      accMatrix.SetSubmatrix(Matrix6d::BOTTOM_LEFT, cx.Transposed() * m);
+      accMatrix.SetSubmatrix(Matrix6d::BOTTOM_RIGHT, Matrix3d::Identity * m);
+      benchmark::DoNotOptimize(accMatrix);
+    });
+  SpatialInertiad acc;
+  benchmark::Run("SpatialInertiad from Inertiald", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = SpatialInertiad(inertials[_i % kInputs]);
+      benchmark::DoNotOptimize(acc);
+    });
+
+  benchmark::Run("Matrix6d X* I X^-1", kIterations,
+    [&](std::size_t _i)
+    {
+      const std::size_t n = _i % kInputs;
+      accMatrix = forceMatrices[n] * spatialMatrices[n] * motionMatrices[n];
+      benchmark::DoNotOptimize(accMatrix);
+    });
+  benchmark::Run("SpatialInertiad.Transform", kIterations,
+    [&](std::size_t _i)
+    {
+      const std::size_t n = _i % kInputs;
+      acc = spatial[n].Transform(transforms[n]);
+      benchmark::DoNotOptimize(acc);
+    });
+  benchmark::Run("SpatialInertiad.InverseTransform", kIterations,
+    [&](std::size_t _i)
+    {
+      const std::size_t n = _i % kInputs;
+      acc = spatial[n].InverseTransform(transforms[n]);
+      benchmark::DoNotOptimize(acc);
+    });
+
+  std::vector<SpatialInertiad> out(kInputs);
+  benchmark::Run("SpatialInertiad::Transform (batch of 1024)",
+    kIterations / kInputs,
+    [&](std::size_t)
+    {
+      SpatialInertiad::Transform(transforms.data(), spatial.data(), kInputs,
+                                 out.data());
+      benchmark::DoNotOptimize(out.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, Matrix3Batch)
+{
+  auto poses = RandomPoses();
+  auto points = RandomPoints(-10, 10);
+  std::vector<Matrix3d> matrices;
+  std::vector<Matrix3d> covariances;
+  for (std::size_t n = 0; n < kInputs; ++n)
+  {
+    const Matrix3d rot(poses[n].Rot());
+    const Vector3d &p = points[n];
+    matrices.push_back(rot * Matrix3d(p.X(), 0, 0, 0, 1, 0, 0, 0, 2));
+    covariances.push_back(rot * Matrix3d(std::abs(p.X()), 0, 0,
+        0, std::abs(p.Y()), 0, 0, 0, std::abs(p.Z())) * rot.Transposed());
+  }
+
+  // Each repetition processes kInputs elements
+  const std::size_t batches = kIterations / kInputs;
+  std::vector<Matrix3d> out(kInputs);
+  benchmark::Run("Matrix3d.Inverse (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        out[i] = matrices[i].Inverse();
+      benchmark::DoNotOptimize(out.data());
+    });
+
+  Matrix3SoAd soa(matrices);
+  Matrix3SoAd soaOut;
+  benchmark::Run("Matrix3SoAd.Inverse", batches,
+    [&](std::size_t)
+    {
+      soa.Inverse(soaOut);
+      benchmark::DoNotOptimize(soaOut.Data(0, 0));
+    });
+
+  std::vector<double> det;
+  benchmark::Run("Matrix3SoAd.Determinant", batches,
+    [&](std::size_t)
+    {
+      soa.Determinant(det);
+      benchmark::DoNotOptimize(det.data());
+    });
+
+  // Principal axes of covariance matrices
+  std::vector<Vector3d> moments(kInputs);
+  std::vector<Quaterniond> offsets(kInputs);
+  const std::size_t eigenBatches = batches / 10;
+  benchmark::Run("MassMatrix3d.PrincipalAxes (loop)", eigenBatches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+      {
+        const Matrix3d &c = covariances[i];
+        MassMatrix3d m(1, Vector3d(c(0, 0), c(1, 1), c(2, 2)),
+                       Vector3d(c(0, 1), c(0, 2), c(1, 2)));
+        m.PrincipalAxes(moments[i], offsets[i]);
+      }
+      benchmark::DoNotOptimize(offsets.data());
+    });
+
+  Matrix3SoAd covarianceSoa(covariances);
+  Vector3SoAd values;
+  benchmark::Run("Matrix3SoAd.SymmetricEigen", eigenBatches,
+    [&](std::size_t)
+    {
+      covarianceSoa.SymmetricEigen(values, soaOut);
+      benchmark::DoNotOptimize(soaOut.Data(0, 0));
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, CholeskySolve)
+{
+  auto poses = RandomPoses();
+  auto points = RandomPoints(1, 10);
+  std::vector<Matrix3d> inertias;
+  std::vector<Matrix6d> spatial;
+  for (std::size_t n = 0; n < kInputs; ++n)
+  {
+    const Matrix3d rot(poses[n].Rot());
+    const Vector3d &p = points[n];
+    const Matrix3d inertia = rot * Matrix3d(p.X(), 0, 0, 0, p.Y(), 0,
+                                            0, 0, p.Z()) * rot.Transposed();
+    inertias.push_back(inertia);
+    const Matrix3d cross(0, -p.Z(), p.Y(), p.Z(), 0, -p.X(), -p.Y(), p.X(), 0);
+    Matrix6d m;
+    m.SetSubmatrix(Matrix6d::TOP_LEFT,
+                   inertia + cross * cross.Transposed() * 0.1);
+    m.SetSubmatrix(Matrix6d::TOP_RIGHT, cross * 0.1);
+    m.SetSubmatrix(Matrix6d::BOTTOM_LEFT, cross.Transposed() * 0.1);
+    m.SetSubmatrix(Matrix6d::BOTTOM_RIGHT, Matrix3d::Identity * 0.1);
+    spatial.push_back(m);
+  }
+
+  Vector3d acc;
+  benchmark::Run("Matrix3d Inverse() * b", kIterations,
+    [&](std::size_t _i)
+    {
+      acc = inertias[_i % kInputs].Inverse() * points[_i % kInputs];
+      benchmark::DoNotOptimize(acc);
+    });
+  benchmark::Run("Matrix3d CholeskyFactor + Solve", kIterations,
+    [&](std::size_t _i)
+    {
+      Matrix3d l = inertias[_i % kInputs];
+      l.CholeskyFactor();
+      acc = l.CholeskySolve(points[_i % kInputs]);
+      benchmark::DoNotOptimize(acc);
+    });
+  benchmark::Run("Matrix3d LdltFactor + Solve", kIterations,
+    [&](std::size_t _i)
+    {
+      Matrix3d l = inertias[_i % kInputs];
+      l.LdltFactor();
+      acc = l.LdltSolve(points[_i % kInputs]);
+      benchmark::DoNotOptimize(acc);
+    });
+
+  const std::size_t batches = kIterations / kInputs;
+  const Matrix3SoAd soa(inertias);
+  const Vector3SoAd b(points);
+  Vector3SoAd x;
+  benchmark::Run("Matrix3SoAd.CholeskySolve", batches,
+    [&](std::size_t)
+    {
+      soa.CholeskySolve(b, x);
+      benchmark::DoNotOptimize(x.XData());
+    });
+  benchmark::Run("Matrix3SoAd.LdltSolve", batches,
+    [&](std::size_t)
+    {
+      soa.LdltSolve(b, x);
+      benchmark::DoNotOptimize(x.XData());
+    });
+
+  SpatialVectord spatialAcc;
+  benchmark::Run("Matrix6d CholeskyFactor + Solve", kIterations,
+    [&](std::size_t _i)
+    {
+      Matrix6d l = spatial[_i % kInputs];
+      l.CholeskyFactor();
+      spatialAcc = l.CholeskySolve(
+          SpatialVectord(points[_i % kInputs], points[_i % kInputs]));
+      benchmark::DoNotOptimize(spatialAcc);
+    });
+  benchmark::Run("Matrix6d LdltFactor + Solve", kIterations,
+    [&](std::size_t _i)
+    {
+      Matrix6d l = spatial[_i % kInputs];
+      l.LdltFactor();
+      spatialAcc = l.LdltSolve(
+          SpatialVectord(points[_i % kInputs], points[_i % kInputs]));
+      benchmark::DoNotOptimize(spatialAcc);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, QuaternionEulerRoundTrip)
+{
+  auto poses = RandomPoses();
+  Quaterniond acc;
+  benchmark::Run("Quaterniond.Euler round-trip", kIterations,
+    [&](std::size_t _i)
+    {
+      acc.Euler(poses[_i % kInputs].Rot().Euler());
+      benchmark::DoNotOptimize(acc);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, QuaternionBatch)
+{
+  auto poses = RandomPoses();
+  auto points = RandomPoints(-10, 10);
+  std::vector<Quaterniond> rots;
+  for (const auto &p : poses)
+    rots.push_back(p.Rot());
+  std::vector<Quaterniond> rotsB(rots.rbegin(), rots.rend());
+
+  // Each repetition processes kInputs elements
+  const std::size_t batches = kIterations / kInputs;
+  std::vector<Quaterniond> out(kInputs);
+  std::vector<Vector3d> outPoints(kInputs);
+  benchmark::Run("Quaterniond.operator* (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        out[i] = rots[i] * rotsB[i];
+      benchmark::DoNotOptimize(out.data());
+    });
+
+  QuaternionSoAd soa(rots);
+  QuaternionSoAd soaB(rotsB);
+  QuaternionSoAd soaOut;
+  benchmark::Run("QuaternionSoAd::Multiply", batches,
+    [&](std::size_t)
+    {
+      QuaternionSoAd::Multiply(soa, soaB, soaOut);
+      benchmark::DoNotOptimize(soaOut.WData());
+    });
+
+  benchmark::Run("Quaterniond.RotateVector (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        outPoints[i] = rots[i].RotateVector(points[i]);
+      benchmark::DoNotOptimize(outPoints.data());
+    });
+
+  Vector3SoAd soaPoints(points);
+  Vector3SoAd soaPointsOut;
+  benchmark::Run("QuaternionSoAd.RotateVector", batches,
+    [&](std::size_t)
+    {
+      soa.RotateVector(soaPoints, soaPointsOut);
+      benchmark::DoNotOptimize(soaPointsOut.XData());
+    });
+
+  benchmark::Run("Quaterniond::Slerp (loop)", batches,
+    [&](std::size_t _i)
+    {
+      const double t = (_i % 16) / 16.0;
+      for (std::size_t i = 0; i < kInputs; ++i)
+        out[i] = Quaterniond::Slerp(t, rots[i], rotsB[i], true);
+      benchmark::DoNotOptimize(out.data());
+    });
+
+  benchmark::Run("QuaternionSoAd::Slerp", batches,
+    [&](std::size_t _i)
+    {
+      const double t = (_i % 16) / 16.0;
+      QuaternionSoAd::Slerp(t, soa, soaB, soaOut, true);
+      benchmark::DoNotOptimize(soaOut.WData());
+    });
+
+  benchmark::Run("QuaternionSoAd::Slerp<FastPrecision>", batches,
+    [&](std::size_t _i)
+    {
+      const double t = (_i % 16) / 16.0;
+      QuaternionSoAd::Slerp<FastPrecision>(t, soa, soaB, soaOut, true);
+      benchmark::DoNotOptimize(soaOut.WData());
+    });
+
+  Vector3SoAd euler;
+  benchmark::Run("QuaternionSoAd.Euler", batches,
+    [&](std::size_t)
+    {
+      soa.Euler(euler);
+      benchmark::DoNotOptimize(euler.XData());
+    });
+
+  std::vector<Vector3d> eulerOut(kInputs);
+  benchmark::Run("Quaterniond.Euler (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        eulerOut[i] = rots[i].Euler();
+      benchmark::DoNotOptimize(eulerOut.data());
+    });
+
+  benchmark::Run("QuaternionSoAd.Euler<FastPrecision>", batches,
+    [&](std::size_t)
+    {
+      soa.Euler<FastPrecision>(euler);
+      benchmark::DoNotOptimize(euler.XData());
+    });
+
+  benchmark::Run("Quaterniond.Euler(Vector3d) (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        out[i].Euler(eulerOut[i]);
+      benchmark::DoNotOptimize(out.data());
+    });
+
+  benchmark::Run("QuaternionSoAd.SetFromEuler", batches,
+    [&](std::size_t)
+    {
+      soaOut.SetFromEuler(euler);
+      benchmark::DoNotOptimize(soaOut.WData());
+    });
+
+  benchmark::Run("QuaternionSoAd.SetFromEuler<FastPrecision>", batches,
+    [&](std::size_t)
+    {
+      soaOut.SetFromEuler<FastPrecision>(euler);
+      benchmark::DoNotOptimize(soaOut.WData());
+    });
+
+  std::vector<Matrix3d> mats(kInputs);
+  benchmark::Run("Matrix3d(Quaterniond) (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        mats[i] = Matrix3d(rots[i]);
+      benchmark::DoNotOptimize(mats.data());
+    });
+
+  Matrix3SoAd soaMats;
+  benchmark::Run("QuaternionSoAd.ToMatrix", batches,
+    [&](std::size_t)
+    {
+      soa.ToMatrix(soaMats);
+      benchmark::DoNotOptimize(soaMats.Data(0, 0));
+    });
+
+  benchmark::Run("Quaterniond.Matrix (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        out[i].Matrix(mats[i]);
+      benchmark::DoNotOptimize(out.data());
+    });
+
+  benchmark::Run("QuaternionSoAd.SetFromMatrix", batches,
+    [&](std::size_t)
+    {
+      soaOut.SetFromMatrix(soaMats);
+      benchmark::DoNotOptimize(soaOut.WData());
+    });
+
+  std::vector<double> angles(kInputs);
+  benchmark::Run("Quaterniond.ToAxis (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        rots[i].ToAxis(eulerOut[i], angles[i]);
+      benchmark::DoNotOptimize(eulerOut.data());
+    });
+
+  Vector3SoAd axes;
+  benchmark::Run("QuaternionSoAd.ToAxis", batches,
+    [&](std::size_t)
+    {
+      soa.ToAxis(axes, angles);
+      benchmark::DoNotOptimize(axes.XData());
+    });
+
+  benchmark::Run("QuaternionSoAd.ToAxis<FastPrecision>", batches,
+    [&](std::size_t)
+    {
+      soa.ToAxis<FastPrecision>(axes, angles);
+      benchmark::DoNotOptimize(axes.XData());
+    });
+
+  benchmark::Run("Quaterniond.Axis (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        out[i].Axis(eulerOut[i], angles[i]);
+      benchmark::DoNotOptimize(out.data());
+    });
+
+  benchmark::Run("QuaternionSoAd.SetFromAxis", batches,
+    [&](std::size_t)
+    {
+      soaOut.SetFromAxis(axes, angles);
+      benchmark::DoNotOptimize(soaOut.WData());
+    });
+
+  benchmark::Run("QuaternionSoAd.SetFromAxis<FastPrecision>", batches,
+    [&](std::size_t)
+    {
+      soaOut.SetFromAxis<FastPrecision>(axes, angles);
+      benchmark::DoNotOptimize(soaOut.WData());
+    });
+
+  // Attitude propagation of many bodies from gyroscope rates
+  std::vector<Vector3d> rates = RandomPoints(-5, 5);
+  std::vector<Vector3d> ratesB(rates.rbegin(), rates.rend());
+  const double dt = 0.001;
+  benchmark::Run("Quaterniond.Integrate (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        out[i] = rots[i].Integrate(rates[i], dt);
+      benchmark::DoNotOptimize(out.data());
+    });
+
+  Vector3SoAd soaRates(rates);
+  Vector3SoAd soaRatesB(ratesB);
+  benchmark::Run("QuaternionSoAd.Integrate", batches,
+    [&](std::size_t)
+    {
+      soa.Integrate(soaRates, dt, soaOut);
+      benchmark::DoNotOptimize(soaOut.WData());
+    });
+
+  benchmark::Run("QuaternionSoAd.Integrate (coning)", batches,
+    [&](std::size_t)
+    {
+      soa.Integrate(soaRates, soaRatesB, dt, soaOut);
+      benchmark::DoNotOptimize(soaOut.WData());
+    });
+
+  benchmark::Run("Quaterniond::SlerpFast (loop)", batches,
+    [&](std::size_t _i)
+    {
+      const double t = (_i % 16) / 16.0;
+      for (std::size_t i = 0; i < kInputs; ++i)
+        out[i] = Quaterniond::SlerpFast(t, rots[i], rotsB[i]);
+      benchmark::DoNotOptimize(out.data());
+    });
+
+  benchmark::Run("QuaternionSoAd::SlerpFast", batches,
+    [&](std::size_t _i)
+    {
+      const double t = (_i % 16) / 16.0;
+      QuaternionSoAd::SlerpFast(t, soa, soaB, soaOut);
+      benchmark::DoNotOptimize(soaOut.WData());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, AxisAlignedBoxIntersect)
+{
+  std::vector<AxisAlignedBox> boxes;
+  auto mins = RandomPoints(-10, 0);
+  auto maxs = RandomPoints(0.5, 10);
+  for (std::size_t i = 0; i < kInputs; ++i)
+    boxes.push_back(AxisAlignedBox(mins[i], maxs[i]));
+
+  auto origins = RandomPoints(-20, 20);
+  auto dirs = RandomPoints(-1, 1);
+  for (auto &d : dirs)
+    d.Normalize();
+
+  benchmark::Run("AxisAlignedBox.Intersect", kIterations,
+    [&](std::size_t _i)
+    {
+      auto result = boxes[_i % kInputs].Intersect(
+          origins[_i % kInputs], dirs[(_i + 7) % kInputs], 0, 100);
+      benchmark::DoNotOptimize(result);
+    });
+
+  benchmark::Run("AxisAlignedBox.IntersectCheck", kIterations,
+    [&](std::size_t _i)
+    {
+      bool result = boxes[_i % kInputs].IntersectCheck(
+          origins[_i % kInputs], dirs[(_i + 7) % kInputs], 0, 100);
+      benchmark::DoNotOptimize(result);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, AxisAlignedBoxMerge)
+{
+  auto mins = RandomPoints(-10, 0);
+  auto maxs = RandomPoints(0.5, 10);
+  std::vector<AxisAlignedBox> boxes;
+  std::vector<AxisAlignedBox3d> boxes3;
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    boxes.push_back(AxisAlignedBox(mins[i], maxs[i]));
+    boxes3.push_back(AxisAlignedBox3d(mins[i], maxs[i]));
+  }
+
+  // Each operation returns a new box, as a broadphase does when it merges
+  // and intersects boxes.
+  benchmark::Run("AxisAlignedBox.operator+", kIterations,
+    [&](std::size_t _i)
+    {
+      AxisAlignedBox result =
+        boxes[_i % kInputs] + boxes[(_i + 1) % kInputs];
+      benchmark::DoNotOptimize(result);
+    });
+
+  benchmark::Run("AxisAlignedBox3d.operator+", kIterations,
+    [&](std::size_t _i)
+    {
+      AxisAlignedBox3d result =
+        boxes3[_i % kInputs] + boxes3[(_i + 1) % kInputs];
+      benchmark::DoNotOptimize(result);
+    });
+
+  benchmark::Run("AxisAlignedBox.Intersects", kIterations,
+    [&](std::size_t _i)
+    {
+      bool result = boxes[_i % kInputs].Intersects(boxes[(_i + 1) % kInputs]);
+      benchmark::DoNotOptimize(result);
+    });
+
+  benchmark::Run("AxisAlignedBox3d.Intersects", kIterations,
+    [&](std::size_t _i)
+    {
+      bool result =
+        boxes3[_i % kInputs].Intersects(boxes3[(_i + 1) % kInputs]);
+      benchmark::DoNotOptimize(result);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, OrientedBoxIntersects)
+{
+  const auto poses = RandomPoses();
+  const auto sizes = RandomPoints(0.5, 5);
+  std::vector<OrientedBoxd> boxes;
+  for (std::size_t i = 0; i < kInputs; ++i)
+    boxes.emplace_back(sizes[i], poses[i]);
+
+  benchmark::Run("OrientedBox::Intersects", kIterations,
+    [&](std::size_t _i)
+    {
+      bool result = boxes[_i % kInputs].Intersects(
+          boxes[(_i + 7) % kInputs]);
+      benchmark::DoNotOptimize(result);
+    });
+
+  // Each call checks one box against kInputs boxes
+  bool out[kInputs];
+  benchmark::Run("OrientedBox::Intersects batch", kIterations / kInputs,
+    [&](std::size_t _i)
+    {
+      std::size_t count = boxes[_i % kInputs].Intersects(boxes.data(),
+                                                         kInputs, out);
+      benchmark::DoNotOptimize(count);
+      benchmark::DoNotOptimize(out);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, Line3Distances)
+{
+  // Capsule axes of 32 robot links, checked all pairs against each other
+  const std::size_t count = 32;
+  const auto starts = RandomPoints(-1, 1);
+  const auto offsets = RandomPoints(-0.3, 0.3);
+  std::vector<Line3d> segments;
+  Vector3SoAd startsSoA;
+  Vector3SoAd endsSoA;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    segments.push_back(Line3d(starts[i], starts[i] + offsets[i]));
+    startsSoA.PushBack(segments[i][0]);
+    endsSoA.PushBack(segments[i][1]);
+  }
+
+  benchmark::Run("Line3d.Distance(Line3d) (all pairs)", 10000,
+    [&](std::size_t)
+    {
+      double sum = 0;
+      Line3d closest;
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        for (std::size_t j = 0; j < count; ++j)
+        {
+          if (segments[i].Distance(segments[j], closest))
+            sum += closest.Length();
+        }
+      }
+      benchmark::DoNotOptimize(sum);
+    });
+
+  std::vector<double> distances;
+  benchmark::Run("Line3d.Distances(Vector3SoA) (all pairs)", 10000,
+    [&](std::size_t)
+    {
+      double sum = 0;
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        segments[i].Distances(startsSoA, endsSoA, distances);
+        sum += distances[i];
+      }
+      benchmark::DoNotOptimize(sum);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, PlaneSides)
+{
+  // A point cloud clipped against a ground plane and three cut planes
+  const auto points = RandomPoints(-10, 10);
+  const Vector3SoAd pointsSoA(points);
+  const std::vector<Planed> planes = {
+    Planed(Vector3d::UnitZ, -1),
+    Planed(Vector3d(1, 1, 0).Normalized(), 2),
+    Planed(Vector3d(-1, 0.5, 0.2).Normalized(), -3),
+    Planed(Vector3d(0.3, -1, 0.1).Normalized(), 4)};
+  const std::size_t count = points.size();
+  std::vector<Planed::PlaneSide> sides(planes.size() * count);
+
+  benchmark::Run("Planed.Side(Vector3d) (1024 points, 4 planes)", 10000,
+    [&](std::size_t)
+    {
+      for (std::size_t p = 0; p < planes.size(); ++p)
+      {
+        for (std::size_t i = 0; i < count; ++i)
+          sides[p * count + i] = planes[p].Side(points[i]);
+      }
+      benchmark::DoNotOptimize(sides.data());
+    });
+
+  benchmark::Run("Planed::Sides(Vector3d *) (1024 points, 4 planes)", 10000,
+    [&](std::size_t)
+    {
+      Planed::Sides(planes.data(), planes.size(), points.data(), count,
+                    sides.data());
+      benchmark::DoNotOptimize(sides.data());
+    });
+
+  benchmark::Run("Planed::Sides(Vector3SoA) (1024 points, 4 planes)", 10000,
+    [&](std::size_t)
+    {
+      Planed::Sides(planes.data(), planes.size(), pointsSoA, sides.data());
+      benchmark::DoNotOptimize(sides.data());
+    });
+
+  std::vector<AxisAlignedBox> boxes;
+  for (const Vector3d &p : points)
+    boxes.push_back(AxisAlignedBox(p - Vector3d::One, p + Vector3d::One));
+
+  benchmark::Run("Planed.Side(AxisAlignedBox) (1024 boxes, 4 planes)", 10000,
+    [&](std::size_t)
+    {
+      for (std::size_t p = 0; p < planes.size(); ++p)
+      {
+        for (std::size_t i = 0; i < count; ++i)
+          sides[p * count + i] = planes[p].Side(boxes[i]);
+      }
+      benchmark::DoNotOptimize(sides.data());
+    });
+
+  benchmark::Run("Planed::Sides(AxisAlignedBox *) (1024 boxes, 4 planes)",
+    10000, [&](std::size_t)
+    {
+      Planed::Sides(planes.data(), planes.size(), boxes.data(), count,
+                    sides.data());
+      benchmark::DoNotOptimize(sides.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, PlaneIntersections)
+{
+  // Rays of a camera 2 m above the ground, most of them towards it
+  const Vector3d origin(0, 0, 2);
+  std::vector<Vector3d> origins(kInputs, origin);
+  const auto directions = RandomPoints(-1, 1);
+  const Vector3SoAd originsSoA(origins);
+  const Vector3SoAd directionsSoA(directions);
+  const Planed ground(Vector3d::UnitZ, 0);
+  Vector3SoAd hits;
+  std::vector<uint8_t> valid(kInputs);
+  std::vector<double> distances(kInputs);
+
+  benchmark::Run("Planed.Intersection (1024 rays)", 10000,
+    [&](std::size_t)
+    {
+      double sum = 0;
+      for (std::size_t i = 0; i < kInputs; ++i)
+      {
+        const auto hit = ground.Intersection(origins[i], directions[i]);
+        if (hit && (*hit - origins[i]).Dot(directions[i]) >= 0)
+          sum += hit->X();
+      }
+      benchmark::DoNotOptimize(sum);
+    });
+
+  benchmark::Run("Planed.Intersections (1024 rays)", 10000,
+    [&](std::size_t)
+    {
+      benchmark::DoNotOptimize(ground.Intersections(originsSoA,
+          directionsSoA, hits, valid.data(), distances.data()));
+    });
+
+  const Vector3SoAf originsf(std::vector<Vector3f>(kInputs,
+      Vector3f(0, 0, 2)));
+  Vector3SoAf directionsf(kInputs);
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    directionsf.Set(i, Vector3f(directions[i].X(), directions[i].Y(),
+                                directions[i].Z()));
+  }
+  const Planef groundf(Vector3f::UnitZ, 0);
+  Vector3SoAf hitsf;
+  std::vector<float> distancesf(kInputs);
+
+  benchmark::Run("Planef.Intersections (1024 rays)", 10000,
+    [&](std::size_t)
+    {
+      benchmark::DoNotOptimize(groundf.Intersections(originsf, directionsf,
+          hitsf, valid.data(), distancesf.data()));
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, AdditivelySeparableScalarField3Evaluate)
+{
+  const AdditivelySeparableScalarField3d<Polynomial3d> field(
+      0.5, Polynomial3d(Vector4d(0.1, -0.2, 0.3, -0.4)),
+      Polynomial3d(Vector4d(0., 0.5, -0.6, 0.7)),
+      Polynomial3d(Vector4d(-0.8, 0.9, -1., 1.1)));
+  const auto points = RandomPoints(-10, 10);
+  std::vector<double> values(kInputs);
+
+  benchmark::Run("AdditivelySeparableScalarField3::Evaluate",
+    kIterations / kInputs,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        values[i] = field.Evaluate(points[i]);
+      benchmark::DoNotOptimize(values);
+    });
+
+  benchmark::Run("AdditivelySeparableScalarField3::Evaluate batch",
+    kIterations / kInputs,
+    [&](std::size_t)
+    {
+      field.Evaluate(points.data(), kInputs, values.data());
+      benchmark::DoNotOptimize(values);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, PiecewiseScalarField3Evaluate)
+{
+  // A 100x100x4 grid of pieces, like a current or wind field
+  using Field = std::function<double(const Vector3d &)>;
+  std::vector<PiecewiseScalarField3d<Field>::Piece> pieces;
+  for (int z = 0; z < 4; ++z)
+  {
+    for (int y = 0; y < 100; ++y)
+    {
+      for (int x = 0; x < 100; ++x)
+      {
+        const double value = x + y + z;
+        pieces.push_back({Region3d(
+            Intervald::LeftClosed(10 * x, 10 * (x + 1)),
+            Intervald::LeftClosed(10 * y, 10 * (y + 1)),
+            Intervald::LeftClosed(-5 * (z + 1), -5 * z)),
+            [value](const Vector3d &) { return value; }});
+      }
+    }
+  }
+  const PiecewiseScalarField3d<Field> field(pieces);
+  const std::vector<Vector3d> points = RandomPoints(-20, 1000);
+
+  benchmark::Run("PiecewiseScalarField3::Evaluate", kIterations,
+    [&](std::size_t _i)
+    {
+      double value = field.Evaluate(points[_i % kInputs]);
+      benchmark::DoNotOptimize(value);
+    });
+
+  // Each call evaluates a line of kInputs nearby points
+  std::vector<Vector3d> line(kInputs);
+  for (std::size_t i = 0; i < kInputs; ++i)
+    line[i].Set(0.5 * i, 200, -7);
+  std::vector<double> values(kInputs);
+  benchmark::Run("PiecewiseScalarField3::Evaluate batch", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      field.Evaluate(line.data(), kInputs, values.data());
+      benchmark::DoNotOptimize(values);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, PiecewiseScalarField3Minimum)
+{
+  // A 100x100 grid of pieces with a different paraboloid in each
+  using Field = AdditivelySeparableScalarField3d<Polynomial3d>;
+  std::vector<PiecewiseScalarField3d<Field>::Piece> pieces;
+  for (int y = 0; y < 100; ++y)
+  {
+    for (int x = 0; x < 100; ++x)
+    {
+      const double cx = 10 * x + (x * 7 + y * 3) % 10;
+      pieces.push_back({Region3d(
+          Intervald::LeftClosed(10 * x, 10 * (x + 1)),
+          Intervald::LeftClosed(10 * y, 10 * (y + 1)),
+          Intervald::Unbounded),
+          Field(1., Polynomial3d(Vector4d(0, 1, -2 * cx, cx * cx)),
+                Polynomial3d::Constant(0.1 * ((x + y) % 13)),
+                Polynomial3d::Constant(0.))});
+    }
+  }
+  const PiecewiseScalarField3d<Field> field(pieces);
+
+  benchmark::Run("PiecewiseScalarField3::Minimum", kIterations,
+    [&](std::size_t)
+    {
+      double value = field.Minimum();
+      benchmark::DoNotOptimize(value);
+    });
+
+  const auto corners = RandomPoints(0, 950);
+  benchmark::Run("PiecewiseScalarField3::Minimum in region", kIterations,
+    [&](std::size_t _i)
+    {
+      const Vector3d &corner = corners[_i % kInputs];
+      double value = field.Minimum(Region3d::Closed(
+          corner.X(), corner.Y(), 0, corner.X() + 45, corner.Y() + 45, 1));
+      benchmark::DoNotOptimize(value);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, BoundingVolumeHierarchyClosestHit)
+{
+  // Small obstacles scattered in a large volume, as seen by range sensors.
+  std::vector<AxisAlignedBox> boxes;
+  auto centers = RandomPoints(-50, 50);
+  for (const auto &c : centers)
+    boxes.push_back(AxisAlignedBox(c - Vector3d::One, c + Vector3d::One));
+
+  auto origins = RandomPoints(-50, 50);
+  auto dirs = RandomPoints(-1, 1);
+
+  benchmark::Run("AxisAlignedBox.Intersect (all boxes)",
+    kIterations / kInputs,
+    [&](std::size_t _i)
+    {
+      double best = MAX_D;
+      for (const auto &box : boxes)
+      {
+        auto result = box.Intersect(origins[_i % kInputs],
+            dirs[(_i + 7) % kInputs], 0, 100);
+        if (std::get<0>(result) && std::get<1>(result) < best)
+          best = std::get<1>(result);
+      }
+      benchmark::DoNotOptimize(best);
+    });
+
+  BoundingVolumeHierarchy bvh(boxes);
+  benchmark::Run("BoundingVolumeHierarchy.ClosestHit", kIterations,
+    [&](std::size_t _i)
+    {
+      auto result = bvh.ClosestHit(origins[_i % kInputs],
+          dirs[(_i + 7) % kInputs], 0, 100);
+      benchmark::DoNotOptimize(result);
+    });
+
+  std::vector<std::size_t> indices;
+  std::vector<double> distances;
+  benchmark::Run("BoundingVolumeHierarchy.ClosestHits", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      bvh.ClosestHits(origins, dirs, 0, 100, indices, distances);
+      benchmark::DoNotOptimize(indices);
+    });
+
+  // Hierarchical culling against a flat batch over the same boxes.
+  Frustum frustum(0.1, 30, Angle(IGN_DTOR(60)), 4.0 / 3.0,
+      Pose3d(0, 0, 1, 0, 0, 0));
+  benchmark::Run("BoundingVolumeHierarchy.Overlaps(Frustum)",
+    kIterations / kInputs,
+    [&](std::size_t)
+    {
+      bvh.Overlaps(frustum, indices);
+      benchmark::DoNotOptimize(indices);
+    });
+
+  std::vector<uint64_t> visible;
+  benchmark::Run("Frustum.Contains(vector<AxisAlignedBox>)",
+    kIterations / kInputs,
+    [&](std::size_t)
+    {
+      std::size_t result = frustum.Contains(boxes, visible);
+      benchmark::DoNotOptimize(result);
+    });
+
+  benchmark::Run("BoundingVolumeHierarchy.Build", 20,
+    [&](std::size_t)
+    {
+      bvh.Build(boxes);
+      benchmark::DoNotOptimize(bvh);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, TriangleMeshClosestHit)
+{
+  // A height field mesh of 20000 triangles seen from above, as by a lidar
+  const int n = 100;
+  std::vector<Vector3d> vertices;
+  for (int y = 0; y <= n; ++y)
+  {
+    for (int x = 0; x <= n; ++x)
+      vertices.push_back(Vector3d(x - n / 2, y - n / 2, std::sin(x + y)));
+  }
+  std::vector<unsigned int> indices;
+  std::vector<AxisAlignedBox> boxes;
+  for (int y = 0; y < n; ++y)
+  {
+    for (int x = 0; x < n; ++x)
+    {
+      const unsigned int i = y * (n + 1) + x;
+      indices.insert(indices.end(), {i, i + 1, i + n + 2});
+      indices.insert(indices.end(), {i, i + n + 2, i + n + 1});
+    }
+  }
+  const std::size_t triangleCount = indices.size() / 3;
+  for (std::size_t t = 0; t < triangleCount; ++t)
+  {
+    AxisAlignedBox box;
+    for (int k = 0; k < 3; ++k)
+    {
+      const Vector3d &v = vertices[indices[3 * t + k]];
+      box.Merge(AxisAlignedBox(v, v));
+    }
+    boxes.push_back(box);
+  }
+
+  const auto origins = RandomPoints(-40, 40);
+  std::vector<Vector3d> dirs = RandomPoints(-1, 1);
+  for (auto &dir : dirs)
+    dir.Z(-1);
+
+  benchmark::Run("Triangle3::ClosestHit (all triangles)", 100,
+    [&](std::size_t _i)
+    {
+      std::size_t triangle = 0;
+      double dist = 0;
+      bool hit = Triangle3d::ClosestHit(vertices.data(), indices.data(),
+          triangleCount, origins[_i % kInputs] + Vector3d(0, 0, 45),
+          dirs[_i % kInputs], 0, 100, triangle, dist);
+      benchmark::DoNotOptimize(hit);
+    });
+
+  const BoundingVolumeHierarchy bvh(boxes);
+  benchmark::Run("BoundingVolumeHierarchy.ClosestHit (triangles)",
+    kIterations,
+    [&](std::size_t _i)
+    {
+      const Vector3d origin = origins[_i % kInputs] + Vector3d(0, 0, 45);
+      const Vector3d dir = dirs[_i % kInputs].Normalized();
+      auto result = bvh.ClosestHit(origin, dir, 0, 100,
+          [&](std::size_t _t, double &_dist)
+          {
+            const unsigned int *tri = &indices[3 * _t];
+            double u, v;
+            return Triangle3d::RayIntersection(vertices[tri[0]],
+                vertices[tri[1]], vertices[tri[2]], origin, dir, _dist,
+                u, v);
+          });
+      benchmark::DoNotOptimize(result);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, MeshBoundingVolumeHierarchy)
+{
+  // A closed mesh of 20000 triangles, a bumpy sphere of radius about 10
+  const int rings = 100;
+  const int segments = 101;
+  std::vector<Vector3d> vertices = {Vector3d(0, 0, 10), Vector3d(0, 0, -10)};
+  for (int r = 1; r < rings; ++r)
+  {
+    const double polar = IGN_PI * r / rings;
+    for (int s = 0; s < segments; ++s)
+    {
+      const double azimuth = 2 * IGN_PI * s / segments;
+      const double radius = 10 + 0.5 * std::sin(5 * polar + 3 * azimuth);
+      vertices.push_back(radius * Vector3d(std::sin(polar) * std::cos(azimuth),
+          std::sin(polar) * std::sin(azimuth), std::cos(polar)));
+    }
+  }
+  auto ring = [&](int _r, int _s)
+  {
+    return static_cast<uint32_t>(2 + (_r - 1) * segments + _s % segments);
+  };
+  std::vector<uint32_t> indices;
+  for (int s = 0; s < segments; ++s)
+  {
+    indices.insert(indices.end(), {0, ring(1, s), ring(1, s + 1)});
+    indices.insert(indices.end(),
+                   {1, ring(rings - 1, s + 1), ring(rings - 1, s)});
+    for (int r = 1; r + 1 < rings; ++r)
+    {
+      indices.insert(indices.end(),
+                     {ring(r, s), ring(r + 1, s), ring(r + 1, s + 1)});
+      indices.insert(indices.end(),
+                     {ring(r, s), ring(r + 1, s + 1), ring(r, s + 1)});
+    }
+  }
+
+  const MeshBoundingVolumeHierarchy mesh(vertices, indices);
+
+  // Points near the surface, as for contact queries
+  auto points = RandomPoints(-1, 1);
+  for (auto &p : points)
+    p = p.Normalized() * Rand::DblUniform(8, 12);
+
+  benchmark::Run("MeshBoundingVolumeHierarchy.SignedDistance", kIterations,
+    [&](std::size_t _i)
+    {
+      double result = mesh.SignedDistance(points[_i % kInputs]);
+      benchmark::DoNotOptimize(result);
+    });
+
+  Vector3d closest;
+  std::size_t triangle;
+  benchmark::Run("MeshBoundingVolumeHierarchy.ClosestPoint (within 1)",
+    kIterations,
+    [&](std::size_t _i)
+    {
+      bool result = mesh.ClosestPoint(points[_i % kInputs], closest,
+                                      triangle, 1.0);
+      benchmark::DoNotOptimize(result);
+    });
+
+  std::vector<std::size_t> overlaps;
+  benchmark::Run("MeshBoundingVolumeHierarchy.Overlaps (sphere)",
+    kIterations,
+    [&](std::size_t _i)
+    {
+      mesh.Overlaps(points[_i % kInputs], 1.0, overlaps);
+      benchmark::DoNotOptimize(overlaps.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, FrustumContains)
+{
+  Frustum frustum(0.1, 50, Angle(IGN_DTOR(60)), 4.0 / 3.0,
+      Pose3d(0, 0, 1, 0, 0, 0));
+
+  auto points = RandomPoints(-60, 60);
+  benchmark::Run("Frustum.Contains(Vector3d)", kIterations,
+    [&](std::size_t _i)
+    {
+      bool result = frustum.Contains(points[_i % kInputs]);
+      benchmark::DoNotOptimize(result);
+    });
+
+  std::vector<AxisAlignedBox> boxes;
+  for (const auto &p : points)
+    boxes.push_back(AxisAlignedBox(p - Vector3d::One, p + Vector3d::One));
+
+  benchmark::Run("Frustum.Contains(AxisAlignedBox)", kIterations,
+    [&](std::size_t _i)
+    {
+      bool result = frustum.Contains(boxes[_i % kInputs]);
+      benchmark::DoNotOptimize(result);
+    });
+
+  // Setting several properties only computes the planes once, when they
+  // are next used.
+  auto poses = RandomPoses();
+  benchmark::Run("Frustum.SetPose+SetFar+Contains", kIterations,
+    [&](std::size_t _i)
+    {
+      frustum.SetPose(poses[_i % kInputs]);
+      frustum.SetFar(50 + (_i % 2));
+      bool result = frustum.Contains(points[_i % kInputs]);
+      benchmark::DoNotOptimize(result);
+    });
+  frustum.SetPose(Pose3d(0, 0, 1, 0, 0, 0));
+  frustum.SetFar(50);
+
+  std::vector<AxisAlignedBox3d> boxes3;
+  for (const auto &p : points)
+    boxes3.push_back(AxisAlignedBox3d(p - Vector3d::One, p + Vector3d::One));
+  std::vector<double> radii(kInputs, 1.0);
+
+  // The batch benchmarks report the time per batch of kInputs objects.
+  std::vector<uint64_t> visible;
+  std::vector<uint8_t> cache;
+  benchmark::Run("Frustum.Contains(vector<AxisAlignedBox>)",
+    kIterations / kInputs,
+    [&](std::size_t)
+    {
+      std::size_t result = frustum.Contains(boxes, visible);
+      benchmark::DoNotOptimize(result);
+    });
+
+  benchmark::Run("Frustum.Contains(vector<AxisAlignedBox3d>)",
+    kIterations / kInputs,
+    [&](std::size_t)
+    {
+      std::size_t result = frustum.Contains(boxes3, visible);
+      benchmark::DoNotOptimize(result);
+    });
+
+  benchmark::Run("Frustum.Contains(vector<AxisAlignedBox3d>, cache)",
+    kIterations / kInputs,
+    [&](std::size_t)
+    {
+      std::size_t result = frustum.Contains(boxes3, visible, cache);
+      benchmark::DoNotOptimize(result);
+    });
+
+  benchmark::Run("Frustum.Contains(spheres, cache)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      std::size_t result = frustum.Contains(points, radii, visible, cache);
+      benchmark::DoNotOptimize(result);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, OcclusionCuller)
+{
+  // An indoor scene: rows of walls in front of the view, and objects
+  // scattered among and behind them.
+  Frustum frustum(0.1, 60, Angle(IGN_DTOR(90)), 2.0,
+      Pose3d(0, 0, 1, 0, 0, 0));
+  std::vector<AxisAlignedBox> walls;
+  for (int row = 0; row < 4; ++row)
+  {
+    for (int col = -4; col < 4; ++col)
+    {
+      const double x = 6 + 8 * row;
+      const double y = 6 * col + 3 * (row % 2);
+      walls.push_back(AxisAlignedBox(Vector3d(x, y, 0),
+                                     Vector3d(x + 0.2, y + 5, 3)));
+    }
+  }
+
+  auto points = RandomPoints(-60, 60);
+  std::vector<AxisAlignedBox> boxes;
+  for (const auto &p : points)
+  {
+    const Vector3d c(std::abs(p.X()) / 2, p.Y() / 2, 1 + p.Z() / 120);
+    boxes.push_back(AxisAlignedBox(c - Vector3d(0.3, 0.3, 0.3),
+                                   c + Vector3d(0.3, 0.3, 0.3)));
+  }
+
+  OcclusionCuller culler;
+  benchmark::Run("OcclusionCuller.Reset+AddOccluders(32 boxes)",
+    kIterations / kInputs,
+    [&](std::size_t)
+    {
+      culler.Reset(frustum);
+      culler.AddOccluders(walls);
+    });
+
+  // The batch benchmarks report the time per batch of kInputs objects.
+  std::vector<uint64_t> visible;
+  benchmark::Run("Frustum.Contains+OcclusionCuller.Cull",
+    kIterations / kInputs,
+    [&](std::size_t)
+    {
+      frustum.Contains(boxes, visible);
+      std::size_t result = culler.Cull(boxes, visible);
+      benchmark::DoNotOptimize(result);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SphericalCoordinatesVelocityTransform)
+{
+  SphericalCoordinates sc(SphericalCoordinates::EARTH_WGS84,
+      IGN_DTOR(-22.9), IGN_DTOR(-43.2), 10, IGN_DTOR(30));
+  const auto velocities = RandomPoints(-10, 10);
+  const Vector3SoA<double> velocitiesSoA(velocities);
+  std::vector<Vector3d> result(kInputs);
+  Vector3SoA<double> resultSoA;
+
+  benchmark::Run("SphericalCoordinates.VelocityTransform (loop, "
+    "LOCAL->ECEF)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+      {
+        result[i] = sc.VelocityTransform(velocities[i],
+            SphericalCoordinates::LOCAL, SphericalCoordinates::ECEF);
+      }
+      benchmark::DoNotOptimize(result.data());
+    });
+
+  benchmark::Run("SphericalCoordinates.VelocityTransform(vector, "
+    "LOCAL->ECEF)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      bool ok = sc.VelocityTransform(velocities,
+          SphericalCoordinates::LOCAL, SphericalCoordinates::ECEF, result);
+      benchmark::DoNotOptimize(ok);
+    });
+
+  benchmark::Run("SphericalCoordinates.VelocityTransform(SoA, "
+    "LOCAL->ECEF)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      bool ok = sc.VelocityTransform(velocitiesSoA,
+          SphericalCoordinates::LOCAL, SphericalCoordinates::ECEF,
+          resultSoA);
+      benchmark::DoNotOptimize(ok);
+    });
+
+  benchmark::Run("SphericalCoordinates::ConvertEnuNed(SoA)",
+    kIterations / kInputs,
+    [&](std::size_t)
+    {
+      SphericalCoordinates::ConvertEnuNed(velocitiesSoA, resultSoA);
+      benchmark::DoNotOptimize(resultSoA.XData());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SphericalCoordinatesSetOrigin)
+{
+  // Origins of the tiles a vehicle moves between
+  std::vector<Vector3d> origins;
+  for (int i = 0; i < 4; ++i)
+  {
+    origins.push_back(
+        Vector3d(IGN_DTOR(47.6 + 0.01 * i), IGN_DTOR(-122.3), 20));
+  }
+  const Vector3d local(100, 200, 3);
+
+  SphericalCoordinates sc;
+  benchmark::Run("SphericalCoordinates set origin part by part", kIterations,
+    [&](std::size_t _i)
+    {
+      const Vector3d &o = origins[_i % origins.size()];
+      sc.SetLatitudeReference(o.X());
+      sc.SetLongitudeReference(o.Y());
+      sc.SetElevationReference(o.Z());
+      sc.SetHeadingOffset(0.1);
+      benchmark::DoNotOptimize(sc.PositionTransform(local,
+          SphericalCoordinates::LOCAL, SphericalCoordinates::ECEF));
+    });
+
+  for (const std::size_t cacheSize : {0u, 4u})
+  {
+    SphericalCoordinates fast;
+    fast.SetAccuracy(SphericalCoordinates::FAST);
+    fast.SetOriginCacheSize(cacheSize);
+    benchmark::Run("SphericalCoordinates.SetOrigin (FAST, cache " +
+      std::to_string(cacheSize) + ")", kIterations / 100,
+      [&](std::size_t _i)
+      {
+        const Vector3d &o = origins[_i % origins.size()];
+        fast.SetOrigin(o.X(), o.Y(), o.Z(), 0.1);
+        benchmark::DoNotOptimize(fast.PositionTransform(local,
+            SphericalCoordinates::LOCAL, SphericalCoordinates::SPHERICAL));
+      });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SphericalCoordinatesPositionTransform)
+{
+  SphericalCoordinates sc(SphericalCoordinates::EARTH_WGS84,
+      IGN_DTOR(-22.9), IGN_DTOR(-43.2), 10, IGN_DTOR(30));
+  auto points = RandomPoints(-1000, 1000);
+  std::vector<Vector3d> spherical;
+  for (const auto &p : points)
+  {
+    spherical.push_back(sc.PositionTransform(p,
+        SphericalCoordinates::LOCAL, SphericalCoordinates::SPHERICAL));
+  }
+  const Vector3SoA<double> localSoA(points);
+
+  std::vector<Vector3d> result;
+  Vector3SoA<double> resultSoA;
+  benchmark::Run("SphericalCoordinates.PositionTransform(LOCAL->GLOBAL)",
+    kIterations,
+    [&](std::size_t _i)
+    {
+      Vector3d out = sc.PositionTransform(points[_i % kInputs],
+          SphericalCoordinates::LOCAL, SphericalCoordinates::GLOBAL);
+      benchmark::DoNotOptimize(out);
+    });
+
+  benchmark::Run("SphericalCoordinates.PositionTransform(vector, "
+    "LOCAL->GLOBAL)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      bool ok = sc.PositionTransform(points,
+          SphericalCoordinates::LOCAL, SphericalCoordinates::GLOBAL, result);
+      benchmark::DoNotOptimize(ok);
+    });
+
+  benchmark::Run("SphericalCoordinates.PositionTransform(SoA, "
+    "LOCAL->GLOBAL)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      bool ok = sc.PositionTransform(localSoA,
+          SphericalCoordinates::LOCAL, SphericalCoordinates::GLOBAL,
+          resultSoA);
+      benchmark::DoNotOptimize(ok);
+    });
+
+  benchmark::Run("SphericalCoordinates.PositionTransform(SPHERICAL->LOCAL)",
+    kIterations,
+    [&](std::size_t _i)
+    {
+      Vector3d out = sc.PositionTransform(spherical[_i % kInputs],
+          SphericalCoordinates::SPHERICAL, SphericalCoordinates::LOCAL);
+      benchmark::DoNotOptimize(out);
+    });
+
+  benchmark::Run("SphericalCoordinates.PositionTransform(vector, "
+    "SPHERICAL->LOCAL)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      bool ok = sc.PositionTransform(spherical,
+          SphericalCoordinates::SPHERICAL, SphericalCoordinates::LOCAL,
+          result);
+      benchmark::DoNotOptimize(ok);
+    });
+  // Points within a few kilometers use the tangent expansions.
+  SphericalCoordinates fast(sc);
+  fast.SetAccuracy(SphericalCoordinates::FAST);
+  benchmark::Run("SphericalCoordinates.PositionTransform(LOCAL->SPHERICAL)",
+    kIterations,
+    [&](std::size_t _i)
+    {
+      Vector3d out = sc.PositionTransform(points[_i % kInputs],
+          SphericalCoordinates::LOCAL, SphericalCoordinates::SPHERICAL);
+      benchmark::DoNotOptimize(out);
+    });
+
+  benchmark::Run("SphericalCoordinates.PositionTransform(LOCAL->SPHERICAL, "
+    "FAST)", kIterations,
+    [&](std::size_t _i)
+    {
+      Vector3d out = fast.PositionTransform(points[_i % kInputs],
+          SphericalCoordinates::LOCAL, SphericalCoordinates::SPHERICAL);
+      benchmark::DoNotOptimize(out);
+    });
+
+  benchmark::Run("SphericalCoordinates.PositionTransform(SPHERICAL->LOCAL, "
+    "FAST)", kIterations,
+    [&](std::size_t _i)
+    {
+      Vector3d out = fast.PositionTransform(spherical[_i % kInputs],
+          SphericalCoordinates::SPHERICAL, SphericalCoordinates::LOCAL);
+      benchmark::DoNotOptimize(out);
+    });
+
+  // Points far from the reference use the closed form solution.
+  auto farPoints = RandomPoints(-1e6, 1e6);
+  benchmark::Run("SphericalCoordinates.PositionTransform(far LOCAL->"
+    "SPHERICAL)", kIterations,
+    [&](std::size_t _i)
+    {
+      Vector3d out = sc.PositionTransform(farPoints[_i % kInputs],
+          SphericalCoordinates::LOCAL, SphericalCoordinates::SPHERICAL);
+      benchmark::DoNotOptimize(out);
+    });
+
+  benchmark::Run("SphericalCoordinates.PositionTransform(far LOCAL->"
+    "SPHERICAL, FAST)", kIterations,
+    [&](std::size_t _i)
+    {
+      Vector3d out = fast.PositionTransform(farPoints[_i % kInputs],
+          SphericalCoordinates::LOCAL, SphericalCoordinates::SPHERICAL);
+      benchmark::DoNotOptimize(out);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SphericalCoordinatesDistance)
+{
+  std::vector<double> lat, lon;
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    lat.push_back(Rand::DblUniform(-1.5, 1.5));
+    lon.push_back(Rand::DblUniform(-3.1, 3.1));
+  }
+
+  benchmark::Run("SphericalCoordinates::Distance", kIterations,
+    [&](std::size_t _i)
+    {
+      double d = SphericalCoordinates::Distance(
+          Angle(lat[_i % kInputs]), Angle(lon[_i % kInputs]),
+          Angle(lat[(_i + 1) % kInputs]), Angle(lon[(_i + 1) % kInputs]));
+      benchmark::DoNotOptimize(d);
+    });
+
+  std::vector<double> distances;
+  benchmark::Run("SphericalCoordinates::Distance(one to many)",
+    kIterations / kInputs,
+    [&](std::size_t _i)
+    {
+      bool ok = SphericalCoordinates::Distance(Angle(lat[_i % kInputs]),
+          Angle(lon[_i % kInputs]), lat, lon, distances);
+      benchmark::DoNotOptimize(ok);
+    });
+
+  // The half angle terms are computed once for the whole matrix.
+  benchmark::Run("SphericalCoordinates::Distance(many to many)", 1,
+    [&](std::size_t)
+    {
+      bool ok = SphericalCoordinates::Distance(lat, lon, lat, lon,
+          distances);
+      benchmark::DoNotOptimize(ok);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SplineInterpolate)
+{
+  Spline spline;
+  spline.AutoCalculate(false);
+  for (const auto &p : RandomPoints(-10, 10))
+    spline.AddPoint(p);
+  spline.RecalcTangents();
+
+  std::vector<double> t(kInputs);
+  for (std::size_t i = 0; i < kInputs; ++i)
+    t[i] = static_cast<double>(i) / (kInputs - 1);
+
+  benchmark::Run("Spline::Interpolate", kIterations,
+    [&](std::size_t _i)
+    {
+      Vector3d p = spline.Interpolate(t[_i % kInputs]);
+      benchmark::DoNotOptimize(p);
+    });
+
+  // Sorted parameter values are mapped to segments by a single walk.
+  std::vector<Vector3d> points(kInputs);
+  benchmark::Run("Spline::Interpolate(batch)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      bool ok = spline.Interpolate(t.data(), t.size(), points.data());
+      benchmark::DoNotOptimize(ok);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SplineClosestParameter)
+{
+  // A path of 4096 segments along a smooth curve.
+  Spline spline;
+  spline.AutoCalculate(false);
+  for (int i = 0; i <= 4096; ++i)
+  {
+    const double angle = 0.01 * i;
+    spline.AddPoint(Vector3d(100 * std::cos(angle), 100 * std::sin(angle),
+                             0.05 * i));
+  }
+  spline.RecalcTangents();
+
+  std::vector<double> t(kInputs);
+  std::vector<Vector3d> queries(kInputs);
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    t[i] = static_cast<double>(i) / (kInputs - 1);
+    queries[i] = spline.Interpolate(t[i]) + Vector3d(0.3, -0.2, 0.1);
+  }
+
+  // Dense sampling, 8 samples per segment.
+  std::vector<double> samples(8 * 4096 + 1);
+  for (std::size_t i = 0; i < samples.size(); ++i)
+    samples[i] = static_cast<double>(i) / (samples.size() - 1);
+  std::vector<Vector3d> points(samples.size());
+  benchmark::Run("Spline sampled projection", 100,
+    [&](std::size_t _i)
+    {
+      spline.Interpolate(samples.data(), samples.size(), points.data());
+      const Vector3d &q = queries[_i % kInputs];
+      double best = INF_D;
+      for (const auto &p : points)
+        best = std::min(best, (p - q).SquaredLength());
+      benchmark::DoNotOptimize(best);
+    });
+
+  benchmark::Run("Spline::ClosestParameter", kIterations / 100,
+    [&](std::size_t _i)
+    {
+      double c = spline.ClosestParameter(queries[_i % kInputs]);
+      benchmark::DoNotOptimize(c);
+    });
+
+  // A path follower tracks its progress from the previous projection,
+  // which is about 4 segments behind here.
+  double previous = 0.0;
+  benchmark::Run("Spline::ClosestParameter(tracked)", kIterations,
+    [&](std::size_t _i)
+    {
+      if (_i % kInputs == 0)
+        previous = 0.0;
+      previous = spline.ClosestParameter(queries[_i % kInputs], previous,
+                                         8.0);
+      benchmark::DoNotOptimize(previous);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SplineAddPoint)
+{
+  std::vector<Vector3d> points = RandomPoints(-10, 10);
+
+  // Tangents and segments are only updated around the appended point, so
+  // streaming a spline point by point is linear in its size.
+  benchmark::Run("Spline::AddPoint(streaming 1024 points)", 10,
+    [&](std::size_t)
+    {
+      Spline spline;
+      for (const auto &p : points)
+        spline.AddPoint(p);
+      benchmark::DoNotOptimize(spline);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, RotationSplineInterpolate)
+{
+  RotationSpline spline;
+  spline.AutoCalculate(false);
+  for (const auto &p : RandomPoints(-IGN_PI, IGN_PI))
+    spline.AddPoint(Quaterniond(p));
+  spline.RecalcTangents();
+
+  std::vector<double> t(kInputs);
+  for (std::size_t i = 0; i < kInputs; ++i)
+    t[i] = static_cast<double>(i) / kInputs;
+
+  benchmark::Run("RotationSpline::Interpolate", kIterations,
+    [&](std::size_t _i)
+    {
+      Quaterniond q = spline.Interpolate(t[_i % kInputs]);
+      benchmark::DoNotOptimize(q);
+    });
+
+  std::vector<Quaterniond> rotations(kInputs);
+  benchmark::Run("RotationSpline::Interpolate(batch)", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      bool ok = spline.Interpolate(t.data(), t.size(), rotations.data());
+      benchmark::DoNotOptimize(ok);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, RandNormal)
+{
+  benchmark::Run("Rand::DblNormal", kIterations,
+    [&](std::size_t)
+    {
+      double v = Rand::DblNormal(1, 2);
+      benchmark::DoNotOptimize(v);
+    });
+
+  RandomGenerator &gen = Rand::ThreadGenerator();
+  benchmark::Run("RandomGenerator::DblNormal", kIterations,
+    [&](std::size_t)
+    {
+      double v = gen.DblNormal(1, 2);
+      benchmark::DoNotOptimize(v);
+    });
+
+  // The spare value of each polar method draw is kept by the generator.
+  std::vector<double> values(kInputs);
+  benchmark::Run("RandomGenerator::FillNormal", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      gen.FillNormal(values.data(), values.size(), 1, 2);
+      benchmark::DoNotOptimize(values);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, GaussMarkovProcessUpdate)
+{
+  std::vector<GaussMarkovProcess> processes(kInputs);
+  for (auto &p : processes)
+    p.Set(0.0, 0.5, 1.0, 0.1);
+
+  benchmark::Run("GaussMarkovProcess::Update", kIterations,
+    [&](std::size_t _i)
+    {
+      double v = processes[_i % kInputs].Update(0.01);
+      benchmark::DoNotOptimize(v);
+    });
+
+  // One call advances every process, with bulk normal samples.
+  GaussMarkovProcessEnsemble ensemble(kInputs, 0.0, 0.5, 1.0, 0.1);
+  benchmark::Run("GaussMarkovProcessEnsemble::Update", kIterations / kInputs,
+    [&](std::size_t)
+    {
+      const std::vector<double> &v = ensemble.Update(0.01);
+      benchmark::DoNotOptimize(v);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, PIDBankUpdate)
+{
+  const std::size_t loops = 4096;
+  std::vector<PID> pids;
+  for (std::size_t i = 0; i < loops; ++i)
+  {
+    // Mix of clamped and unclamped controllers
+    if (i % 2)
+      pids.push_back(PID(1.0, 0.1, 0.05, 0.5, -0.5, 10, -10));
+    else
+      pids.push_back(PID(2.0, 0.2, 0.01));
+  }
+  PIDBank bank;
+  for (const auto &pid : pids)
+    bank.Add(pid);
+
+  auto points = RandomPoints(-1, 1);
+  std::vector<double> errors(loops);
+  for (std::size_t i = 0; i < loops; ++i)
+    errors[i] = points[i % kInputs].X();
+
+  const std::chrono::duration<double> dt(0.001);
+  const std::size_t batches = kIterations / loops;
+  std::vector<double> cmds(loops);
+  benchmark::Run("PID.Update (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < loops; ++i)
+        cmds[i] = pids[i].Update(errors[i], dt);
+      benchmark::DoNotOptimize(cmds.data());
+    });
+  benchmark::Run("PIDBank.Update", batches,
+    [&](std::size_t)
+    {
+      bank.Update(errors, dt, cmds);
+      benchmark::DoNotOptimize(cmds.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SpeedLimiterBankLimit)
+{
+  const std::size_t axes = 500;
+  std::vector<SpeedLimiter> limiters(axes);
+  SpeedLimiterBank bank;
+  for (auto &limiter : limiters)
+  {
+    limiter.SetMinVelocity(-1);
+    limiter.SetMaxVelocity(1);
+    limiter.SetMinAcceleration(-2);
+    limiter.SetMaxAcceleration(2);
+    limiter.SetMinJerk(-10);
+    limiter.SetMaxJerk(10);
+    bank.Add(limiter);
+  }
+
+  auto points = RandomPoints(-2, 2);
+  std::vector<double> targets(axes);
+  for (std::size_t i = 0; i < axes; ++i)
+    targets[i] = points[i % kInputs].X();
+
+  const std::chrono::steady_clock::duration dt =
+      std::chrono::milliseconds(10);
+  const std::size_t batches = kIterations / axes;
+  std::vector<double> prev(axes, 0.0);
+  std::vector<double> prevPrev(axes, 0.0);
+  std::vector<double> vels(axes);
+  benchmark::Run("SpeedLimiter::Limit (loop)", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < axes; ++i)
+      {
+        double v = targets[i];
+        limiters[i].Limit(v, prev[i], prevPrev[i], dt);
+        prevPrev[i] = prev[i];
+        prev[i] = v;
+      }
+      benchmark::DoNotOptimize(prev.data());
+    });
+  benchmark::Run("SpeedLimiterBank::Limit", batches,
+    [&](std::size_t)
+    {
+      vels = targets;
+      bank.Limit(vels, dt);
+      benchmark::DoNotOptimize(vels.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, RollingMean)
+{
+  std::vector<double> values(kInputs);
+  for (auto &v : values)
+    v = Rand::DblUniform(-1, 1);
+
+  RollingMean mean(10);
+  benchmark::Run("RollingMean::Push+Mean", kIterations,
+    [&](std::size_t _i)
+    {
+      mean.Push(values[_i % kInputs]);
+      double m = mean.Mean();
+      benchmark::DoNotOptimize(m);
+    });
+
+  FixedRollingMean<10> fixedMean;
+  benchmark::Run("FixedRollingMean::Push+Mean", kIterations,
+    [&](std::size_t _i)
+    {
+      fixedMean.Push(values[_i % kInputs]);
+      double m = fixedMean.Mean();
+      benchmark::DoNotOptimize(m);
+    });
+
+  auto time = std::chrono::steady_clock::now();
+  DiffDriveOdometry odom;
+  odom.SetWheelParams(0.5, 0.1, 0.1);
+  odom.Init(time);
+  benchmark::Run("DiffDriveOdometry::Update", kIterations,
+    [&](std::size_t _i)
+    {
+      time += std::chrono::milliseconds(10);
+      odom.Update(Angle(_i * 0.01), Angle(_i * 0.011), time);
+      double v = odom.LinearVelocity();
+      benchmark::DoNotOptimize(v);
+    });
+
+  odom.SetIntegration(DiffDriveOdometry::EXACT_ARC);
+  odom.Init(time);
+  benchmark::Run("DiffDriveOdometry::Update (EXACT_ARC)", kIterations,
+    [&](std::size_t _i)
+    {
+      time += std::chrono::milliseconds(10);
+      odom.Update(Angle(_i * 0.01), Angle(_i * 0.011), time);
+      double v = odom.LinearVelocity();
+      benchmark::DoNotOptimize(v);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, DiffDriveOdometryBankUpdate)
+{
+  const std::size_t vehicles = 500;
+  std::vector<std::unique_ptr<DiffDriveOdometry>> odoms;
+  DiffDriveOdometryBank bank(vehicles);
+  bank.SetWheelParams(0.5, 0.1, 0.1);
+  auto time = std::chrono::steady_clock::now();
+  bank.Init(time);
+  for (std::size_t i = 0; i < vehicles; ++i)
+  {
+    odoms.emplace_back(new DiffDriveOdometry());
+    odoms[i]->SetWheelParams(0.5, 0.1, 0.1);
+    odoms[i]->Init(time);
+  }
+
+  // Turning vehicles, with wheel speeds that differ
+  auto points = RandomPoints(0.5, 1.5);
+  std::vector<double> left(vehicles, 0.0);
+  std::vector<double> right(vehicles, 0.0);
+  const std::size_t batches = kIterations / vehicles;
+  benchmark::Run("DiffDriveOdometry::Update (loop)", batches,
+    [&](std::size_t)
+    {
+      time += std::chrono::milliseconds(10);
+      for (std::size_t i = 0; i < vehicles; ++i)
+      {
+        left[i] += 0.1 * points[i].X();
+        right[i] += 0.1 * points[i].Y();
+        odoms[i]->Update(Angle(left[i]), Angle(right[i]), time);
+      }
+      double x = odoms[0]->X();
+      benchmark::DoNotOptimize(x);
+    });
+  benchmark::Run("DiffDriveOdometryBank::Update", batches,
+    [&](std::size_t)
+    {
+      time += std::chrono::milliseconds(10);
+      for (std::size_t i = 0; i < vehicles; ++i)
+      {
+        left[i] += 0.1 * points[i].X();
+        right[i] += 0.1 * points[i].Y();
+      }
+      bank.Update(left, right, time);
+      benchmark::DoNotOptimize(bank.X().data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, ColorArrays)
+{
+  // Colorizing a point cloud, one packed color per point
+  std::vector<float> rgba(4 * kInputs);
+  for (auto &v : rgba)
+    v = static_cast<float>(Rand::DblUniform(0, 1));
+  std::vector<unsigned int> packed(kInputs);
+
+  benchmark::Run("Color.AsRGBA (1024 colors)", 10000,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+      {
+        const Color clr(rgba[4 * i], rgba[4 * i + 1], rgba[4 * i + 2],
+                        rgba[4 * i + 3]);
+        packed[i] = clr.AsRGBA();
+      }
+      benchmark::DoNotOptimize(packed.data());
+    });
+
+  benchmark::Run("Color::Pack (1024 colors)", 10000,
+    [&](std::size_t)
+    {
+      Color::Pack(rgba.data(), kInputs, Color::PACKED_RGBA, packed.data());
+      benchmark::DoNotOptimize(packed.data());
+    });
+
+  benchmark::Run("Color::Pack sRGB (1024 colors)", 10000,
+    [&](std::size_t)
+    {
+      Color::Pack(rgba.data(), kInputs, Color::PACKED_RGBA, packed.data(),
+                  true);
+      benchmark::DoNotOptimize(packed.data());
+    });
+
+  benchmark::Run("Color.SetFromBGRA (1024 colors)", 10000,
+    [&](std::size_t)
+    {
+      Color clr;
+      for (std::size_t i = 0; i < kInputs; ++i)
+      {
+        clr.SetFromBGRA(packed[i]);
+        rgba[4 * i] = clr.R();
+        rgba[4 * i + 1] = clr.G();
+        rgba[4 * i + 2] = clr.B();
+        rgba[4 * i + 3] = clr.A();
+      }
+      benchmark::DoNotOptimize(rgba.data());
+    });
+
+  benchmark::Run("Color::Unpack (1024 colors)", 10000,
+    [&](std::size_t)
+    {
+      Color::Unpack(packed.data(), kInputs, Color::PACKED_BGRA, rgba.data());
+      benchmark::DoNotOptimize(rgba.data());
+    });
+
+  std::vector<float> hsv(3 * kInputs);
+  benchmark::Run("Color.HSV (1024 colors)", 10000,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+      {
+        const Color clr(rgba[4 * i], rgba[4 * i + 1], rgba[4 * i + 2]);
+        const Vector3f v = clr.HSV();
+        hsv[3 * i] = v.X();
+        hsv[3 * i + 1] = v.Y();
+        hsv[3 * i + 2] = v.Z();
+      }
+      benchmark::DoNotOptimize(hsv.data());
+    });
+
+  benchmark::Run("Color::RGBAToHSV (1024 colors)", 10000,
+    [&](std::size_t)
+    {
+      Color::RGBAToHSV(rgba.data(), kInputs, hsv.data());
+      benchmark::DoNotOptimize(hsv.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, HalfArrays)
+{
+  // Packing point coordinates for a half precision vertex buffer
+  std::vector<Vector3f> points(kInputs);
+  for (auto &p : points)
+  {
+    p.Set(static_cast<float>(Rand::DblUniform(-100, 100)),
+          static_cast<float>(Rand::DblUniform(-100, 100)),
+          static_cast<float>(Rand::DblUniform(0, 10)));
+  }
+  std::vector<float> xyz(3 * kInputs);
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    xyz[3 * i] = points[i].X();
+    xyz[3 * i + 1] = points[i].Y();
+    xyz[3 * i + 2] = points[i].Z();
+  }
+  std::vector<Half> halves(3 * kInputs);
+
+  benchmark::Run("Half(float) (1024 points)", 10000,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < xyz.size(); ++i)
+        halves[i] = Half(xyz[i]);
+      benchmark::DoNotOptimize(halves.data());
+    });
+
+  benchmark::Run("Half::FromFloat (1024 points)", 10000,
+    [&](std::size_t)
+    {
+      Half::FromFloat(xyz.data(), xyz.size(), halves.data());
+      benchmark::DoNotOptimize(halves.data());
+    });
+
+  benchmark::Run("Half.Float (1024 points)", 10000,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < xyz.size(); ++i)
+        xyz[i] = halves[i].Float();
+      benchmark::DoNotOptimize(xyz.data());
+    });
+
+  benchmark::Run("Half::ToFloat (1024 points)", 10000,
+    [&](std::size_t)
+    {
+      Half::ToFloat(halves.data(), halves.size(), xyz.data());
+      benchmark::DoNotOptimize(xyz.data());
+    });
+
+  Vector3hArray packed;
+  benchmark::Run("Vector3hArray.Assign (1024 points)", 10000,
+    [&](std::size_t)
+    {
+      packed.Assign(points);
+      benchmark::DoNotOptimize(packed.Data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, ParsePoses)
+{
+  // Loading the "x y z roll pitch yaw" pose strings of a world file
+  std::vector<std::string> texts;
+  std::string all;
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    std::ostringstream stream;
+    stream << Pose3d(Rand::DblUniform(-100, 100), Rand::DblUniform(-100, 100),
+                     Rand::DblUniform(0, 10), Rand::DblUniform(-1, 1),
+                     Rand::DblUniform(-1, 1), Rand::DblUniform(-3, 3));
+    texts.push_back(stream.str());
+    all += texts.back() + "\n";
+  }
+  std::vector<Pose3d> poses(kInputs);
+
+  benchmark::Run("Pose3d operator>> (1024 poses)", 1000,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+      {
+        std::istringstream stream(texts[i]);
+        stream >> poses[i];
+      }
+      benchmark::DoNotOptimize(poses.data());
+    });
+
+  benchmark::Run("Pose3d::Parse (1024 poses)", 1000,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        Pose3d::Parse(texts[i], poses[i]);
+      benchmark::DoNotOptimize(poses.data());
+    });
+
+  benchmark::Run("Pose3d::ParseArray (1024 poses)", 1000,
+    [&](std::size_t)
+    {
+      poses.clear();
+      Pose3d::ParseArray(all, poses);
+      benchmark::DoNotOptimize(poses.data());
+    });
+
+  // Single numbers, such as the scalar elements of a world file
+  std::vector<std::string> numbers;
+  for (std::size_t i = 0; i < kInputs; ++i)
+    numbers.push_back(std::to_string(Rand::DblUniform(-100, 100)));
+  std::vector<double> values(kInputs);
+
+  benchmark::Run("std::stod (1024 numbers)", 1000,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        values[i] = std::stod(numbers[i]);
+      benchmark::DoNotOptimize(values.data());
+    });
+
+  benchmark::Run("parseFloat (1024 numbers)", 1000,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        values[i] = parseFloat(numbers[i]);
+      benchmark::DoNotOptimize(values.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, FormatPoses)
+{
+  // Logging poses as text
+  std::vector<Pose3d> poses;
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    poses.push_back(Pose3d(
+        Rand::DblUniform(-100, 100), Rand::DblUniform(-100, 100),
+        Rand::DblUniform(0, 10), Rand::DblUniform(-1, 1),
+        Rand::DblUniform(-1, 1), Rand::DblUniform(-3, 3)));
+  }
+
+  benchmark::Run("Pose3d operator<< (1024 poses)", 1000,
+    [&](std::size_t)
+    {
+      std::ostringstream stream;
+      for (const auto &pose : poses)
+        stream << pose << "\n";
+      benchmark::DoNotOptimize(stream);
+    });
+
+  std::vector<char> buffer(256 * kInputs);
+  benchmark::Run("Pose3d::ToChars (1024 poses)", 1000,
+    [&](std::size_t)
+    {
+      char *p = buffer.data();
+      char *end = p + buffer.size();
+      for (const auto &pose : poses)
+      {
+        p = pose.ToChars(p, end);
+        *p++ = '\n';
+      }
+      benchmark::DoNotOptimize(buffer.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, PairUnpair)
+{
+  // Keys of the entity pairs of a contact cache
+  std::vector<uint32_t> a(kInputs);
+  std::vector<uint32_t> b(kInputs);
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    a[i] = static_cast<uint32_t>(Rand::IntUniform(0, 1000000));
+    b[i] = static_cast<uint32_t>(Rand::IntUniform(0, 1000000));
+  }
+  std::vector<uint64_t> keys(kInputs);
+
+  benchmark::Run("Pair64 (1024 keys)", 10000,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        keys[i] = Pair64(a[i], b[i]);
+      benchmark::DoNotOptimize(keys.data());
+    });
+
+  benchmark::Run("Pair64 batch (1024 keys)", 10000,
+    [&](std::size_t)
+    {
+      Pair64(a.data(), b.data(), kInputs, keys.data());
+      benchmark::DoNotOptimize(keys.data());
+    });
+
+  benchmark::Run("Unpair64 (1024 keys)", 10000,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        std::tie(a[i], b[i]) = Unpair64(keys[i]);
+      benchmark::DoNotOptimize(a.data());
+    });
+
+  benchmark::Run("Unpair64 batch (1024 keys)", 10000,
+    [&](std::size_t)
+    {
+      Unpair64(keys.data(), kInputs, a.data(), b.data());
+      benchmark::DoNotOptimize(a.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, EncodePoses)
+{
+  // Logging a smooth trajectory
+  std::vector<Pose3d> poses;
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    const double t = 0.01 * static_cast<double>(i);
+    poses.push_back(Pose3d(10 * std::cos(t), 10 * std::sin(t), 0.1 * t,
+                           0, 0.1 * std::sin(t), t));
+  }
+
+  benchmark::Run("Pose3d operator<< (1024 poses)", 1000,
+    [&](std::size_t)
+    {
+      std::ostringstream stream;
+      for (const auto &pose : poses)
+        stream << pose << "\n";
+      benchmark::DoNotOptimize(stream);
+    });
+
+  std::vector<uint8_t> buffer;
+  benchmark::Run("BinaryEncoder::WriteArray (1024 poses)", 1000,
+    [&](std::size_t)
+    {
+      buffer.clear();
+      BinaryEncoder encoder(buffer);
+      encoder.WriteArray(poses.data(), poses.size());
+      benchmark::DoNotOptimize(buffer.data());
+    });
+
+  benchmark::Run("BinaryEncoder::WritePoseDeltas (1024 poses)", 1000,
+    [&](std::size_t)
+    {
+      buffer.clear();
+      BinaryEncoder encoder(buffer);
+      encoder.WritePoseDeltas(poses.data(), poses.size());
+      benchmark::DoNotOptimize(buffer.data());
+    });
+
+  std::vector<Pose3d> decoded;
+  benchmark::Run("BinaryDecoder::ReadPoseDeltas (1024 poses)", 1000,
+    [&](std::size_t)
+    {
+      BinaryDecoder decoder(buffer);
+      decoder.ReadPoseDeltas(decoded);
+      benchmark::DoNotOptimize(decoded.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, TrajectoryFile)
+{
+  // Replaying a recorded trajectory
+  std::vector<double> times;
+  std::vector<Pose3d> poses;
+  for (std::size_t i = 0; i < 100 * kInputs; ++i)
+  {
+    const double t = 0.01 * static_cast<double>(i);
+    times.push_back(t);
+    poses.push_back(Pose3d(10 * std::cos(t), 10 * std::sin(t), 0.1 * t,
+                           0, 0.1 * std::sin(t), t));
+  }
+  const std::string path = testing::TempDir() + "CoreTypes_trajectory";
+  ASSERT_TRUE(TrajectoryFile::Write(path, times, poses));
+
+  benchmark::Run("TrajectoryFile::Open (102400 poses)", 1000,
+    [&](std::size_t)
+    {
+      TrajectoryFile file;
+      file.Open(path);
+      benchmark::DoNotOptimize(file.Times());
+    });
+
+  std::vector<double> queries(kInputs);
+  for (auto &q : queries)
+    q = Rand::DblUniform(0, times.back());
+
+  TrajectoryFile file;
+  ASSERT_TRUE(file.Open(path));
+  benchmark::Run("TrajectoryFile::Interpolate (1024 times)", 100,
+    [&](std::size_t)
+    {
+      Pose3d pose;
+      for (const double q : queries)
+        file.Interpolate(q, pose);
+      benchmark::DoNotOptimize(pose);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, PoseTrajectory)
+{
+  // Resampling a pose stream to the timestamps of another sensor
+  std::vector<double> times;
+  std::vector<Pose3d> poses;
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    const double t = 0.01 * static_cast<double>(i);
+    times.push_back(t);
+    poses.push_back(Pose3d(10 * std::cos(t), 10 * std::sin(t), 0.1 * t,
+                           0, 0.1 * std::sin(t), t));
+  }
+  std::vector<double> queries;
+  for (std::size_t i = 0; i < kInputs; ++i)
+    queries.push_back(0.0073 * static_cast<double>(i));
+
+  benchmark::Run("Spline+RotationSpline::AddPoint (1024 poses)", 10,
+    [&](std::size_t)
+    {
+      Spline spline;
+      RotationSpline rotationSpline;
+      for (const auto &pose : poses)
+      {
+        spline.AddPoint(pose.Pos());
+        rotationSpline.AddPoint(pose.Rot());
+      }
+      benchmark::DoNotOptimize(spline);
+    });
+
+  PoseTrajectory trajectory;
+  benchmark::Run("PoseTrajectory::SetPoses (1024 poses)", 100,
+    [&](std::size_t)
+    {
+      trajectory.SetPoses(times, poses);
+      benchmark::DoNotOptimize(trajectory);
+    });
+
+  std::vector<Pose3d> resampled;
+  benchmark::Run("PoseTrajectory::Interpolate (1024 times)", 1000,
+    [&](std::size_t)
+    {
+      trajectory.Interpolate(queries, resampled);
+      benchmark::DoNotOptimize(resampled.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, DynamicAabbTree)
+{
+  // Broadphase step of 4096 moving bodies
+  const std::size_t count = 4 * kInputs;
+  std::vector<AxisAlignedBox> boxes;
+  std::vector<Vector3d> velocities;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const Vector3d center(Rand::DblUniform(-50, 50),
+        Rand::DblUniform(-50, 50), Rand::DblUniform(-50, 50));
+    boxes.push_back(AxisAlignedBox(center - Vector3d(0.5, 0.5, 0.5),
+                                   center + Vector3d(0.5, 0.5, 0.5)));
+    velocities.push_back(Vector3d(Rand::DblUniform(-0.02, 0.02),
+        Rand::DblUniform(-0.02, 0.02), Rand::DblUniform(-0.02, 0.02)));
+  }
+  auto step = [&]()
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      boxes[i] = AxisAlignedBox(boxes[i].Min() + velocities[i],
+                                boxes[i].Max() + velocities[i]);
+    }
+  };
+
+  BoundingVolumeHierarchy bvh;
+  std::vector<std::size_t> overlaps;
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  benchmark::Run("BoundingVolumeHierarchy rebuild + queries (4096)", 20,
+    [&](std::size_t)
+    {
+      step();
+      bvh.Build(boxes);
+      pairs.clear();
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        bvh.Overlaps(boxes[i], overlaps);
+        for (const std::size_t j : overlaps)
+        {
+          if (j > i)
+            pairs.emplace_back(i, j);
+        }
+      }
+      benchmark::DoNotOptimize(pairs.data());
+    });
+
+  DynamicAabbTree tree(0.1);
+  std::vector<std::size_t> ids;
+  for (const auto &box : boxes)
+    ids.push_back(tree.Insert(box));
+  benchmark::Run("DynamicAabbTree Move + OverlappingPairs (4096)", 20,
+    [&](std::size_t)
+    {
+      step();
+      for (std::size_t i = 0; i < count; ++i)
+        tree.Move(ids[i], boxes[i], velocities[i]);
+      tree.OverlappingPairs(pairs);
+      benchmark::DoNotOptimize(pairs.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SweepAndPrune)
+{
+  // Broadphase step of 16384 resting boxes that barely move
+  std::vector<AxisAlignedBox> boxes;
+  for (std::size_t i = 0; i < 16 * kInputs; ++i)
+  {
+    const Vector3d min(Rand::DblUniform(-60, 60),
+        Rand::DblUniform(-60, 60), Rand::DblUniform(-60, 60));
+    boxes.push_back(AxisAlignedBox(min, min + Vector3d(1, 1, 1)));
+  }
+  const std::vector<AxisAlignedBox> rest = boxes;
+  auto step = [&]()
+  {
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+      const Vector3d jitter(Rand::DblUniform(-0.01, 0.01),
+          Rand::DblUniform(-0.01, 0.01), Rand::DblUniform(-0.01, 0.01));
+      boxes[i] = AxisAlignedBox(rest[i].Min() + jitter,
+                                rest[i].Max() + jitter);
+    }
+  };
+
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  DynamicAabbTree tree(0.05);
+  std::vector<std::size_t> ids;
+  for (const auto &box : boxes)
+    ids.push_back(tree.Insert(box));
+  benchmark::Run("DynamicAabbTree Move + OverlappingPairs (16384)", 10,
+    [&](std::size_t)
+    {
+      step();
+      for (std::size_t i = 0; i < boxes.size(); ++i)
+        tree.Move(ids[i], boxes[i]);
+      tree.OverlappingPairs(pairs);
+      benchmark::DoNotOptimize(pairs.data());
+    });
+
+  SweepAndPrune sap;
+  ids.clear();
+  for (const auto &box : boxes)
+    ids.push_back(sap.Insert(box));
+  for (const unsigned int threads : {1u, 4u})
+  {
+    benchmark::Run("SweepAndPrune SetBox + OverlappingPairs (16384, " +
+      std::to_string(threads) + " threads)", 10,
+      [&](std::size_t)
+      {
+        step();
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+          sap.SetBox(ids[i], boxes[i]);
+        sap.OverlappingPairs(pairs, threads);
+        benchmark::DoNotOptimize(pairs.data());
+      });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, PointIndex)
+{
+  // 8-nearest neighbors of 1024 locations among 65536 points
+  std::vector<Vector3d> points;
+  for (std::size_t i = 0; i < 64 * kInputs; ++i)
+  {
+    points.push_back(Vector3d(Rand::DblUniform(-10, 10),
+        Rand::DblUniform(-10, 10), Rand::DblUniform(-1, 1)));
+  }
+  std::vector<Vector3d> queries;
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    queries.push_back(Vector3d(Rand::DblUniform(-10, 10),
+        Rand::DblUniform(-10, 10), Rand::DblUniform(-1, 1)));
+  }
+  const std::size_t k = 8;
+
+  std::vector<std::pair<double, std::size_t>> sorted(points.size());
+  benchmark::Run("Brute force 8-nearest (1024 of 65536)", 3,
+    [&](std::size_t)
+    {
+      for (const auto &query : queries)
+      {
+        for (std::size_t i = 0; i < points.size(); ++i)
+          sorted[i] = {(points[i] - query).SquaredLength(), i};
+        std::partial_sort(sorted.begin(), sorted.begin() + k, sorted.end());
+        benchmark::DoNotOptimize(sorted.data());
+      }
+    });
+
+  PointOctree octree;
+  benchmark::Run("PointOctree::Build (65536)", 10,
+    [&](std::size_t)
+    {
+      octree.Build(points);
+    });
+  PointGrid grid;
+  benchmark::Run("PointGrid::Build (65536)", 10,
+    [&](std::size_t)
+    {
+      grid.Build(points);
+    });
+
+  KdTree3d kdTree;
+  benchmark::Run("KdTree3d::Build (65536)", 10,
+    [&](std::size_t)
+    {
+      kdTree.Build(points);
+    });
+
+  std::vector<std::size_t> indices;
+  std::vector<double> distances;
+  benchmark::Run("KdTree3d batched 8-nearest (1024 of 65536)", 20,
+    [&](std::size_t)
+    {
+      kdTree.Nearest(queries, k, indices, distances);
+      benchmark::DoNotOptimize(indices.data());
+    });
+  benchmark::Run("PointOctree 8-nearest (1024 of 65536)", 20,
+    [&](std::size_t)
+    {
+      for (const auto &query : queries)
+        octree.Nearest(query, k, indices);
+      benchmark::DoNotOptimize(indices.data());
+    });
+  benchmark::Run("PointGrid 8-nearest (1024 of 65536)", 20,
+    [&](std::size_t)
+    {
+      for (const auto &query : queries)
+        grid.Nearest(query, k, indices);
+      benchmark::DoNotOptimize(indices.data());
+    });
+  benchmark::Run("PointOctree radius 0.5 (1024 of 65536)", 20,
+    [&](std::size_t)
+    {
+      for (const auto &query : queries)
+        octree.Overlaps(query, 0.5, indices);
+      benchmark::DoNotOptimize(indices.data());
+    });
+  benchmark::Run("PointGrid radius 0.5 (1024 of 65536)", 20,
+    [&](std::size_t)
+    {
+      for (const auto &query : queries)
+        grid.Overlaps(query, 0.5, indices);
+      benchmark::DoNotOptimize(indices.data());
+    });
+  benchmark::Run("KdTree3d radius 0.5 (1024 of 65536)", 20,
+    [&](std::size_t)
+    {
+      for (const auto &query : queries)
+        kdTree.Overlaps(query, 0.5, indices);
+      benchmark::DoNotOptimize(indices.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, Polygon2Contains)
+{
+  // A 64 vertex geofence and 1024 agents around it
+  std::vector<Vector2d> fence;
+  for (int i = 0; i < 64; ++i)
+  {
+    const double angle = i * 2 * IGN_PI / 64;
+    const double radius = 50 + 10 * std::sin(5 * angle);
+    fence.push_back(Vector2d(radius * std::cos(angle),
+                             radius * std::sin(angle)));
+  }
+  const Polygon2d polygon(fence);
+  std::vector<Vector2d> agents(kInputs);
+  for (auto &agent : agents)
+    agent.Set(Rand::DblUniform(-70, 70), Rand::DblUniform(-70, 70));
+
+  std::unique_ptr<bool[]> inside(new bool[kInputs]);
+  benchmark::Run("Polygon2::Contains(64 vertices, loop of 1024)", 200,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        inside[i] = polygon.Contains(agents[i]);
+    });
+  benchmark::Run("Polygon2::Contains(64 vertices, batch of 1024)", 200,
+    [&](std::size_t)
+    {
+      polygon.Contains(agents.data(), kInputs, inside.get());
+    });
+
+  const Triangled triangle(Vector2d(-50, -50), Vector2d(60, -40),
+                           Vector2d(0, 55));
+  benchmark::Run("Triangle::Contains(loop of 1024)", 2000,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        inside[i] = triangle.Contains(agents[i]);
+    });
+  benchmark::Run("Triangle::Contains(batch of 1024)", 2000,
+    [&](std::size_t)
+    {
+      triangle.Contains(agents.data(), kInputs, inside.get());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, PolylineSimplifier)
+{
+  // A 65536 point GPS track of a vehicle turning slowly, with noise
+  std::vector<Vector2d> track(64 * kInputs);
+  double heading = 0.0;
+  for (std::size_t i = 1; i < track.size(); ++i)
+  {
+    heading += 0.01 * std::sin(0.001 * i);
+    track[i] = track[i - 1] + Vector2d(std::cos(heading),
+        std::sin(heading)) * 0.5 + Vector2d(Rand::DblUniform(-0.05, 0.05),
+        Rand::DblUniform(-0.05, 0.05));
+  }
+
+  // Recursive Douglas-Peucker that marks the kept points.
+  std::vector<bool> keep(track.size());
+  std::function<void(std::size_t, std::size_t)> recurse =
+    [&](std::size_t _a, std::size_t _b)
+    {
+      const Line2d line(track[_a], track[_b]);
+      std::size_t farthest = _a;
+      double distance = -1.0;
+      for (std::size_t i = _a + 1; i < _b; ++i)
+      {
+        const double d = line.Distance(track[i]);
+        if (d > distance)
+        {
+          farthest = i;
+          distance = d;
+        }
+      }
+      if (distance > 0.5)
+      {
+        keep[farthest] = true;
+        recurse(_a, farthest);
+        recurse(farthest, _b);
+      }
+    };
+  benchmark::Run("recursive Douglas-Peucker 0.5 (65536)", 10,
+    [&](std::size_t)
+    {
+      std::fill(keep.begin(), keep.end(), false);
+      keep.front() = keep.back() = true;
+      recurse(0, track.size() - 1);
+    });
+
+  std::vector<std::size_t> indices(track.size());
+  std::size_t kept = 0;
+  benchmark::Run("PolylineSimplifier::DouglasPeucker 0.5 (65536)", 10,
+    [&](std::size_t)
+    {
+      kept = PolylineSimplifier::DouglasPeucker(track.data(), track.size(),
+                                                0.5, indices.data());
+    });
+  EXPECT_EQ(static_cast<std::size_t>(
+      std::count(keep.begin(), keep.end(), true)), kept);
+
+  benchmark::Run("PolylineSimplifier::Visvalingam 0.5 (65536)", 10,
+    [&](std::size_t)
+    {
+      kept = PolylineSimplifier::Visvalingam(track.data(), track.size(),
+                                             0.5, indices.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, PointSetFilter)
+{
+  // A 65536 point scan of a noisy floor with a few stray returns
+  Vector3SoAd points;
+  for (std::size_t i = 0; i < 64 * kInputs; ++i)
+  {
+    const double spread = (i % 100 == 0) ? 5.0 : 0.05;
+    points.PushBack(Vector3d(Rand::DblUniform(-10, 10),
+        Rand::DblUniform(-10, 10), Rand::DblUniform(-spread, spread)));
+  }
+
+  Vector3SoAd centroids;
+  benchmark::Run("std::map voxel centroids 0.2 (65536)", 5,
+    [&](std::size_t)
+    {
+      std::map<std::tuple<int64_t, int64_t, int64_t>,
+               std::pair<Vector3d, int>> cells;
+      for (std::size_t i = 0; i < points.Size(); ++i)
+      {
+        const Vector3d point = points[i];
+        auto &cell = cells[std::make_tuple(
+            static_cast<int64_t>(std::floor(point.X() / 0.2)),
+            static_cast<int64_t>(std::floor(point.Y() / 0.2)),
+            static_cast<int64_t>(std::floor(point.Z() / 0.2)))];
+        cell.first += point;
+        ++cell.second;
+      }
+      centroids.Clear();
+      for (const auto &cell : cells)
+        centroids.PushBack(cell.second.first / cell.second.second);
+    });
+  benchmark::Run("VoxelDownsample 0.2 (65536)", 10,
+    [&](std::size_t)
+    {
+      PointSetFilter::VoxelDownsample(points, 0.2, centroids);
+    });
+
+  std::vector<std::size_t> inliers;
+  benchmark::Run("RemoveRadiusOutliers 0.2 (65536)", 5,
+    [&](std::size_t)
+    {
+      PointSetFilter::RemoveRadiusOutliers(points, 0.2, 2, inliers);
+    });
+  benchmark::Run("RemoveStatisticalOutliers 8 (65536)", 5,
+    [&](std::size_t)
+    {
+      PointSetFilter::RemoveStatisticalOutliers(points, 8, 2.0, inliers);
+    });
+
+  // Self hits of a scan on eight links of a robot
+  std::vector<OrientedBoxd> links;
+  for (int b = 0; b < 8; ++b)
+  {
+    links.push_back(OrientedBoxd(Vector3d(0.6, 0.2, 0.3),
+        Pose3d(-1 + 0.3 * b, 0.1 * b, 0, 0.2 * b, 0.1, -0.3 * b)));
+  }
+  const std::vector<Vector3d> scan = points.ToVector();
+  std::size_t expected = 0;
+  Vector3SoAd kept;
+  benchmark::Run("OrientedBox::Contains crop of 8 boxes (65536)", 5,
+    [&](std::size_t)
+    {
+      kept.Clear();
+      for (const Vector3d &p : scan)
+      {
+        bool inside = false;
+        for (const OrientedBoxd &link : links)
+          inside = inside || link.Contains(p);
+        if (!inside)
+          kept.PushBack(p);
+      }
+      expected = kept.Size();
+    });
+
+  std::size_t count = 0;
+  benchmark::Run("CropBoxes of 8 boxes (65536)", 20,
+    [&](std::size_t)
+    {
+      kept = points;
+      count = PointSetFilter::CropBoxes(kept, links.data(), links.size(),
+                                        true);
+    });
+  EXPECT_EQ(expected, count);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, IcpRegistration)
+{
+  // A 16384 point scan of a wavy floor, matched against a 65536 point map
+  std::vector<Vector3d> map;
+  for (int i = 0; i < 256; ++i)
+  {
+    for (int j = 0; j < 256; ++j)
+    {
+      const double x = -10 + 20.0 * i / 255, y = -10 + 20.0 * j / 255;
+      map.emplace_back(x, y, 0.5 * std::sin(0.7 * x) * std::cos(0.9 * y));
+    }
+  }
+  const Pose3d truth(0.05, -0.04, 0.02, 0.01, -0.01, 0.03);
+  std::vector<Vector3d> scan;
+  for (std::size_t i = 0; i < map.size(); i += 4)
+  {
+    scan.push_back(
+        truth.Rot().RotateVectorReverse(map[i] - truth.Pos()));
+  }
+
+  IcpRegistration icp(map);
+  icp.SetMaxCorrespondenceDistance(1.0);
+  const Vector3SoAd source(scan);
+  for (auto metric : {IcpRegistration::POINT_TO_POINT,
+                      IcpRegistration::POINT_TO_PLANE})
+  {
+    icp.SetMetric(metric);
+    icp.TargetNormals();
+    const std::string name = metric == IcpRegistration::POINT_TO_POINT ?
+        "point-to-point" : "point-to-plane";
+    for (unsigned int threads : {1u, 4u})
+    {
+      icp.SetThreadCount(threads);
+      IcpRegistration::Result result;
+      benchmark::Run("IcpRegistration " + name + " (16384 to 65536, " +
+          std::to_string(threads) + " threads)", 3,
+        [&](std::size_t)
+        {
+          result = icp.Align(source);
+        });
+      // Point-to-point crawls along smooth surfaces, and may stop at the
+      // maximum number of iterations
+      if (metric == IcpRegistration::POINT_TO_PLANE)
+      {
+        EXPECT_TRUE(result.converged);
+        EXPECT_TRUE(result.pose.Pos().Equal(truth.Pos(), 1e-4));
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, RansacFitter)
+{
+  // Ground segmentation of a 65536 point scan, two thirds on the floor
+  std::vector<Vector3d> scan;
+  for (std::size_t i = 0; i < 64 * kInputs; ++i)
+  {
+    const bool floor = i % 3 != 0;
+    scan.push_back(Vector3d(Rand::DblUniform(-20, 20),
+        Rand::DblUniform(-20, 20),
+        floor ? Rand::DblUniform(-0.02, 0.02) : Rand::DblUniform(0, 3)));
+  }
+  const Vector3SoAd points(scan);
+  const unsigned int hypotheses = 128;
+
+  std::size_t bestCount = 0;
+  benchmark::Run("Plane::Distance loop RANSAC (128 of 65536)", 3,
+    [&](std::size_t)
+    {
+      bestCount = 0;
+      for (unsigned int h = 0; h < hypotheses; ++h)
+      {
+        const Vector3d &p0 = scan[(h * 7919) % scan.size()];
+        const Vector3d &p1 = scan[(h * 104729 + 1) % scan.size()];
+        const Vector3d &p2 = scan[(h * 1299709 + 2) % scan.size()];
+        const Vector3d n = (p1 - p0).Cross(p2 - p0).Normalize();
+        const Planed plane(n, n.Dot(p0));
+        std::size_t count = 0;
+        for (const Vector3d &p : scan)
+          count += std::abs(plane.Distance(p)) <= 0.05;
+        bestCount = std::max(bestCount, count);
+      }
+    });
+  benchmark::DoNotOptimize(bestCount);
+
+  RansacFitter ransac;
+  ransac.SetDistanceThreshold(0.05);
+  ransac.SetConfidence(1.0);
+  ransac.SetMaxIterations(hypotheses);
+  Planed ground;
+  for (unsigned int threads : {1u, 4u})
+  {
+    ransac.SetThreadCount(threads);
+    benchmark::Run("RansacFitter::FitPlane (128 of 65536, " +
+        std::to_string(threads) + " threads)", 3,
+      [&](std::size_t)
+      {
+        ransac.FitPlane(points, ground);
+      });
+  }
+
+  // With early stops, as run on each frame
+  ransac.SetThreadCount(1);
+  ransac.SetConfidence(0.99);
+  ransac.SetMaxIterations(1000);
+  RansacFitter::Result result;
+  benchmark::Run("RansacFitter::FitPlane (early stop, 65536)", 5,
+    [&](std::size_t)
+    {
+      result = ransac.FitPlane(points, ground);
+    });
+  EXPECT_TRUE(result.found);
+  EXPECT_LE(result.iterations, 64u);
+  EXPECT_NEAR(1.0, std::abs(ground.Normal().Z()), 1e-3);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, NormalEstimator)
+{
+  // Normals of a 65536 point wavy floor, from 10 neighbors each
+  std::vector<Vector3d> cloud;
+  for (int i = 0; i < 256; ++i)
+  {
+    for (int j = 0; j < 256; ++j)
+    {
+      const double x = -10 + 20.0 * i / 255, y = -10 + 20.0 * j / 255;
+      cloud.emplace_back(x, y, 0.5 * std::sin(0.7 * x) * std::cos(0.9 * y));
+    }
+  }
+  const Vector3SoAd points(cloud);
+  const KdTree3d tree(cloud);
+  const std::size_t neighbors = 10;
+
+  std::vector<Vector3d> expected(cloud.size());
+  benchmark::Run("Matrix3 covariance loop normals (65536)", 3,
+    [&](std::size_t)
+    {
+      std::vector<std::size_t> indices;
+      for (std::size_t i = 0; i < cloud.size(); ++i)
+      {
+        tree.Nearest(cloud[i], neighbors, indices);
+        Vector3d mean;
+        for (const std::size_t n : indices)
+          mean += cloud[n];
+        mean /= static_cast<double>(indices.size());
+        Matrix3d covariance = Matrix3d::Zero;
+        for (const std::size_t n : indices)
+        {
+          const Vector3d d = cloud[n] - mean;
+          covariance = covariance + Matrix3d(
+              d.X() * d.X(), d.X() * d.Y(), d.X() * d.Z(),
+              d.Y() * d.X(), d.Y() * d.Y(), d.Y() * d.Z(),
+              d.Z() * d.X(), d.Z() * d.Y(), d.Z() * d.Z());
+        }
+        Vector3d values;
+        Matrix3d vectors;
+        covariance.SymmetricEigen(values, vectors);
+        expected[i].Set(vectors(0, 0), vectors(1, 0), vectors(2, 0));
+      }
+    });
+
+  NormalEstimator estimator;
+  estimator.SetNeighbors(neighbors);
+  Vector3SoAd normals;
+  std::vector<double> curvatures;
+  for (unsigned int threads : {1u, 4u})
+  {
+    estimator.SetThreadCount(threads);
+    benchmark::Run("NormalEstimator::Estimate (65536, " +
+        std::to_string(threads) + " threads)", 3,
+      [&](std::size_t)
+      {
+        estimator.Estimate(points, tree, normals, curvatures);
+      });
+  }
+  ASSERT_EQ(expected.size(), normals.Size());
+  for (std::size_t i = 0; i < expected.size(); i += 97)
+    EXPECT_NEAR(1.0, std::abs(expected[i].Dot(normals[i])), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, Dbscan)
+{
+  // 64 obstacles of 1024 points each, and 1024 points of clutter
+  std::vector<Vector3d> cloud;
+  for (int o = 0; o < 64; ++o)
+  {
+    const Vector3d center(4.0 * (o % 8), 4.0 * (o / 8), 0);
+    for (int i = 0; i < 1024; ++i)
+    {
+      cloud.push_back(center + Vector3d(Rand::DblNormal(0, 0.3),
+          Rand::DblNormal(0, 0.3), Rand::DblNormal(0, 0.3)));
+    }
+  }
+  for (int i = 0; i < 1024; ++i)
+  {
+    cloud.push_back(Vector3d(Rand::DblUniform(-4, 32),
+        Rand::DblUniform(-4, 32), Rand::DblUniform(-2, 2)));
+  }
+  const double epsilon = 0.15;
+  const std::size_t minPoints = 8;
+
+  // Textbook DBSCAN, expanding clusters from a queue with KdTree3 queries
+  std::size_t expected = 0;
+  benchmark::Run("KdTree3 queue DBSCAN (66560)", 3,
+    [&](std::size_t)
+    {
+      const KdTree3d tree(cloud);
+      const int unvisited = -2, noise = -1;
+      std::vector<int> labels(cloud.size(), unvisited);
+      std::vector<std::size_t> found;
+      std::vector<std::size_t> queue;
+      int clusters = 0;
+      for (std::size_t i = 0; i < cloud.size(); ++i)
+      {
+        if (labels[i] != unvisited)
+          continue;
+        tree.Overlaps(cloud[i], epsilon, found);
+        if (found.size() < minPoints)
+        {
+          labels[i] = noise;
+          continue;
+        }
+        labels[i] = clusters;
+        queue.assign(found.begin(), found.end());
+        while (!queue.empty())
+        {
+          const std::size_t j = queue.back();
+          queue.pop_back();
+          if (labels[j] == noise)
+            labels[j] = clusters;
+          if (labels[j] != unvisited)
+            continue;
+          labels[j] = clusters;
+          tree.Overlaps(cloud[j], epsilon, found);
+          if (found.size() >= minPoints)
+            queue.insert(queue.end(), found.begin(), found.end());
+        }
+        ++clusters;
+      }
+      expected = static_cast<std::size_t>(clusters);
+    });
+
+  Dbscan dbscan(epsilon, minPoints);
+  std::vector<Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  for (unsigned int threads : {1u, 4u})
+  {
+    dbscan.SetThreadCount(threads);
+    benchmark::Run("Dbscan::Cluster (66560, " + std::to_string(threads) +
+        " threads)", 3,
+      [&](std::size_t)
+      {
+        dbscan.Cluster(cloud, centroids, labels);
+      });
+  }
+  EXPECT_EQ(expected, centroids.size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SpatialSort)
+{
+  // A scan of 2^18 random points
+  const std::size_t count = 1 << 18;
+  std::vector<Vector3d> cloud(count);
+  for (Vector3d &point : cloud)
+  {
+    point.Set(Rand::DblUniform(-50, 50), Rand::DblUniform(-50, 50),
+              Rand::DblUniform(-2, 2));
+  }
+  const AxisAlignedBox bounds(Vector3d(-50, -50, -2), Vector3d(50, 50, 2));
+  std::vector<uint64_t> input;
+  CurveKeys(cloud, bounds, SpaceFillingCurve::MORTON, input);
+
+  // Sorting (key, index) pairs by comparison
+  std::vector<std::pair<uint64_t, std::size_t>> pairs;
+  benchmark::Run("std::sort of Morton keys (2^18)", 3,
+    [&](std::size_t)
+    {
+      pairs.resize(count);
+      for (std::size_t i = 0; i < count; ++i)
+        pairs[i] = std::make_pair(input[i], i);
+      std::sort(pairs.begin(), pairs.end());
+    });
+
+  std::vector<uint64_t> keys;
+  std::vector<std::size_t> order;
+  for (unsigned int threads : {1u, 4u})
+  {
+    benchmark::Run("RadixSort of Morton keys (2^18, " +
+        std::to_string(threads) + " threads)", 3,
+      [&](std::size_t)
+      {
+        keys = input;
+        RadixSort(keys, order, threads);
+      });
+  }
+  for (std::size_t i = 0; i < count; i += 1021)
+    EXPECT_EQ(pairs[i].second, order[i]);
+
+  for (auto curve : {SpaceFillingCurve::MORTON, SpaceFillingCurve::HILBERT})
+  {
+    const std::string name = curve == SpaceFillingCurve::MORTON ?
+        "Morton" : "Hilbert";
+    benchmark::Run("CurveKeys " + name + " (2^18)", 3,
+      [&](std::size_t)
+      {
+        CurveKeys(cloud, bounds, curve, keys);
+      });
+  }
+
+  // Nearest neighbor queries in the order of the points, which is what
+  // spatial sorting is for: consecutive queries visit the same nodes.
+  std::vector<Vector3d> sorted = cloud;
+  SpatialSort(sorted, order, SpaceFillingCurve::HILBERT);
+  for (const std::vector<Vector3d> *points : {&cloud, &sorted})
+  {
+    const KdTree3d tree(*points);
+    std::vector<std::size_t> found;
+    std::size_t sum = 0;
+    benchmark::Run(std::string("KdTree3::Nearest 8 of ") +
+        (points == &cloud ? "unsorted" : "sorted") + " points (2^18)", 3,
+      [&](std::size_t)
+      {
+        for (const Vector3d &point : *points)
+        {
+          tree.Nearest(point, 8, found);
+          sum += found[0];
+        }
+      });
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, WeldVertices)
+{
+  // A triangle soup of a 512 x 512 grid mesh, six vertices per quad, as
+  // read from a mesh file without an index buffer
+  std::vector<Vector3d> soup;
+  auto vertex = [](int _i, int _j)
+  {
+    return Vector3d(0.01 * _i, 0.01 * _j, 0.001 * ((_i * _j) % 17));
+  };
+  for (int i = 0; i < 512; ++i)
+  {
+    for (int j = 0; j < 512; ++j)
+    {
+      for (const auto &c : {std::make_pair(0, 0), std::make_pair(1, 0),
+           std::make_pair(1, 1), std::make_pair(0, 0), std::make_pair(1, 1),
+           std::make_pair(0, 1)})
+      {
+        soup.push_back(vertex(i + c.first, j + c.second));
+      }
+    }
+  }
+
+  // The map is on par for small meshes in file order, which keeps its
+  // path cached, and falls behind on larger or shuffled meshes.
+  std::size_t expected = 0;
+  benchmark::Run("std::map<WellOrderedVectors> weld (1572864)", 3,
+    [&](std::size_t)
+    {
+      std::map<Vector3d, std::size_t, WellOrderedVectors<double>> tree;
+      std::vector<std::size_t> remap(soup.size());
+      for (std::size_t v = 0; v < soup.size(); ++v)
+        remap[v] = tree.emplace(soup[v], tree.size()).first->second;
+      expected = tree.size();
+      benchmark::DoNotOptimize(remap);
+    });
+
+  std::vector<Vector3d> welded;
+  std::vector<std::size_t> remap;
+  benchmark::Run("WeldVertices (1572864)", 3,
+    [&](std::size_t)
+    {
+      WeldVertices(soup, 1e-4, welded, remap);
+    });
+  EXPECT_EQ(expected, welded.size());
+  EXPECT_EQ(513u * 513u, welded.size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, AxisAlignedBoxBounds)
+{
+  const std::size_t count = 1 << 20;
+  std::vector<Vector3d> points(count);
+  for (Vector3d &p : points)
+  {
+    p.Set(Rand::DblUniform(-100, 100), Rand::DblUniform(-100, 100),
+          Rand::DblUniform(-100, 100));
+  }
+
+  AxisAlignedBox expected;
+  benchmark::Run("AxisAlignedBox += per point (1048576)", 5,
+    [&](std::size_t)
+    {
+      AxisAlignedBox box;
+      for (const Vector3d &p : points)
+        box += AxisAlignedBox(p, p);
+      expected = box;
+    });
+
+  AxisAlignedBox bounds;
+  benchmark::Run("AxisAlignedBox::FromPoints (1048576)", 5,
+    [&](std::size_t)
+    {
+      bounds = AxisAlignedBox::FromPoints(points.data(), points.size());
+    });
+  EXPECT_EQ(expected, bounds);
+
+  benchmark::Run("AxisAlignedBox::FromPoints, all threads (1048576)", 5,
+    [&](std::size_t)
+    {
+      bounds = AxisAlignedBox::FromPoints(points.data(), points.size(), 0);
+    });
+  EXPECT_EQ(expected, bounds);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, MovingWindowFilter)
+{
+  std::vector<double> values(kInputs);
+  for (auto &v : values)
+    v = Rand::DblUniform(-1, 1);
+
+  MovingWindowFilter<double> filter;
+  filter.SetWindowSize(16);
+  benchmark::Run("MovingWindowFilter::Update+Value", kIterations,
+    [&](std::size_t _i)
+    {
+      filter.Update(values[_i % kInputs]);
+      double v = filter.Value();
+      benchmark::DoNotOptimize(v);
+    });
+
+  FixedMovingWindowFilter<double, 16> fixedFilter;
+  benchmark::Run("FixedMovingWindowFilter::Update+Value", kIterations,
+    [&](std::size_t _i)
+    {
+      fixedFilter.Update(values[_i % kInputs]);
+      double v = fixedFilter.Value();
+      benchmark::DoNotOptimize(v);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, FilterBank)
+{
+  // 256 channels, each sample processed through the virtual interface.
+  const std::size_t channels = 256;
+  const std::size_t frames = kInputs / 8;
+  std::vector<double> input(channels * frames);
+  for (auto &v : input)
+    v = Rand::DblUniform(-1, 1);
+  std::vector<double> output(input.size());
+
+  std::vector<BiQuad<double>> filters(channels, BiQuad<double>(50, 1000));
+  std::vector<BiQuad<double> *> bases;
+  for (auto &f : filters)
+    bases.push_back(&f);
+  benchmark::Run("BiQuad::Process per channel", kIterations / channels,
+    [&](std::size_t _i)
+    {
+      const std::size_t offset = (_i % frames) * channels;
+      for (std::size_t c = 0; c < channels; ++c)
+        output[offset + c] = bases[c]->Process(input[offset + c]);
+      benchmark::DoNotOptimize(output);
+    });
+
+  // One call per frame of all the channels.
+  BiQuadBank<double> bank(channels, 50, 1000);
+  benchmark::Run("BiQuadBank::Process frame", kIterations / channels,
+    [&](std::size_t _i)
+    {
+      const std::size_t offset = (_i % frames) * channels;
+      bank.Process(&input[offset], &output[offset]);
+      benchmark::DoNotOptimize(output);
+    });
+
+  OnePoleBank<double> onePoleBank(channels, 50, 1000);
+  benchmark::Run("OnePoleBank::Process frame", kIterations / channels,
+    [&](std::size_t _i)
+    {
+      const std::size_t offset = (_i % frames) * channels;
+      onePoleBank.Process(&input[offset], &output[offset]);
+      benchmark::DoNotOptimize(output);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SignalStats)
+{
+  std::vector<double> values(kInputs);
+  for (auto &v : values)
+    v = Rand::DblUniform(-1, 1);
+
+  // Six statistics, each updated through a virtual call.
+  SignalStats stats;
+  stats.InsertStatistics("max,maxAbs,mean,min,rms,var");
+  benchmark::Run("SignalStats::InsertData", kIterations,
+    [&](std::size_t _i)
+    {
+      stats.InsertData(values[_i % kInputs]);
+    });
+  benchmark::DoNotOptimize(stats);
+
+  SignalAccumulator acc;
+  benchmark::Run("SignalAccumulator::InsertData", kIterations,
+    [&](std::size_t _i)
+    {
+      acc.InsertData(values[_i % kInputs]);
+    });
+  double v = acc.Variance();
+  benchmark::DoNotOptimize(v);
+
+  SignalQuantile p99(0.99);
+  benchmark::Run("SignalQuantile::InsertData", kIterations,
+    [&](std::size_t _i)
+    {
+      p99.InsertData(values[_i % kInputs]);
+    });
+  v = p99.Value();
+  benchmark::DoNotOptimize(v);
+
+  SignalWindowAccumulator window(100);
+  benchmark::Run("SignalWindowAccumulator::InsertData", kIterations,
+    [&](std::size_t _i)
+    {
+      window.InsertData(values[_i % kInputs]);
+    });
+  v = window.Max();
+  benchmark::DoNotOptimize(v);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, Vector3Stats)
+{
+  std::vector<Vector3d> values(kInputs);
+  for (auto &v : values)
+  {
+    v.Set(Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1),
+          Rand::DblUniform(-1, 1));
+  }
+
+  // Four SignalStats of six statistics each.
+  Vector3Stats stats;
+  stats.InsertStatistics("max,maxAbs,mean,min,rms,var");
+  benchmark::Run("Vector3Stats::InsertData", kIterations,
+    [&](std::size_t _i)
+    {
+      stats.InsertData(values[_i % kInputs]);
+    });
+  benchmark::DoNotOptimize(stats);
+
+  Vector3Accumulator acc;
+  benchmark::Run("Vector3Accumulator::InsertData", kIterations,
+    [&](std::size_t _i)
+    {
+      acc.InsertData(values[_i % kInputs]);
+    });
+  double v = acc.Mag().Variance();
+  benchmark::DoNotOptimize(v);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, Profiler)
+{
+  // The clock reads are part of any timer.
+  benchmark::Run("clock::now", kIterations,
+    [&](std::size_t)
+    {
+      clock::time_point t = clock::now();
+      benchmark::DoNotOptimize(t);
+    });
+
+  // Collecting is left out, so that only the cost in the zone is timed.
+  // The buffer holds the warm up and the 5 timed repetitions, so that
+  // nothing is dropped.
+  Profiler profiler("mean", 6 * kIterations);
+  const std::size_t zone = profiler.Zone("zone");
+  benchmark::Run("Profiler::Record", kIterations,
+    [&](std::size_t _i)
+    {
+      profiler.Record(zone, std::chrono::nanoseconds(_i));
+    });
+  profiler.Reset();
+
+  benchmark::Run("ProfilerScope", kIterations,
+    [&](std::size_t)
+    {
+      ProfilerScope scope(profiler, zone);
+    });
+  profiler.Reset();
+
+  Stopwatch watch;
+  benchmark::Run("Stopwatch::Start+Stop", kIterations,
+    [&](std::size_t)
+    {
+      watch.Start();
+      watch.Stop();
+    });
+
+  BasicStopwatch<> steadyWatch;
+  benchmark::Run("BasicStopwatch<steady_clock>::Start+Stop", kIterations,
+    [&](std::size_t)
+    {
+      steadyWatch.Start();
+      steadyWatch.Stop();
+    });
+  benchmark::DoNotOptimize(steadyWatch.ElapsedRunTime());
+
+  TscClock::Calibrate();
+  TscStopwatch tscWatch;
+  benchmark::Run("TscStopwatch::Start+Stop", kIterations,
+    [&](std::size_t)
+    {
+      tscWatch.Start();
+      tscWatch.Stop();
+    });
+  benchmark::DoNotOptimize(tscWatch.ElapsedRunTime());
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, SemanticVersion)
+{
+  // Version strings of the kind a plugin resolver compares on startup
+  std::vector<std::string> strings;
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    strings.push_back(std::to_string(i % 7) + "." +
+        std::to_string((i * 13) % 31) + "." + std::to_string(i % 101) +
+        (i % 5 == 0 ? "-rc" + std::to_string(i % 3) : ""));
+  }
+
+  const std::size_t batches = kIterations / kInputs;
+  std::vector<SemanticVersion> versions(kInputs);
+  benchmark::Run("SemanticVersion::Parse", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        versions[i].Parse(strings[i]);
+      benchmark::DoNotOptimize(versions.data());
+    });
+
+  std::vector<std::uint64_t> keys(kInputs);
+  benchmark::Run("SemanticVersion::ParseKey", batches,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < kInputs; ++i)
+        SemanticVersion::ParseKey(strings[i], keys[i]);
+      benchmark::DoNotOptimize(keys.data());
+    });
+
+  // Count the versions which satisfy a constraint
+  const SemanticVersion minimum("3.15.0");
+  benchmark::Run("SemanticVersion::operator>=", batches,
+    [&](std::size_t)
+    {
+      std::size_t count = 0;
+      for (std::size_t i = 0; i < kInputs; ++i)
+        count += versions[i] >= minimum;
+      benchmark::DoNotOptimize(count);
+    });
+
+  const std::uint64_t minimumKey = minimum.Key();
+  benchmark::Run("SemanticVersion::Key >=", batches,
+    [&](std::size_t)
+    {
+      std::size_t count = 0;
+      for (std::size_t i = 0; i < kInputs; ++i)
+        count += keys[i] >= minimumKey;
+      benchmark::DoNotOptimize(count);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, ThermalImageQuantize)
+{
+  // One 640x512 thermal camera frame of 280 K to 320 K
+  const std::size_t pixels = 640 * 512;
+  std::vector<double> kelvin(pixels);
+  std::vector<uint16_t> codes(pixels);
+  for (std::size_t i = 0; i < pixels; ++i)
+  {
+    kelvin[i] = Rand::DblUniform(280.0, 320.0);
+    codes[i] = static_cast<uint16_t>(kelvin[i] * 100.0);
+  }
+  std::vector<uint8_t> counts(pixels);
+
+  const double low = 290.0;
+  const double high = 310.0;
+  const double resolution = (high - low) / 255;
+  const std::size_t frames = 20;
+  benchmark::Run("Thermal frame (loop)", frames,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < pixels; ++i)
+      {
+        const double t = Temperature(kelvin[i]).Kelvin();
+        counts[i] = static_cast<uint8_t>(std::round(
+            clamp(t - low, 0.0, high - low) / resolution));
+      }
+      benchmark::DoNotOptimize(counts.data());
+    });
+
+  TemperatureQuantizer quantizer(low, high, resolution);
+  benchmark::Run("TemperatureQuantizer::Quantize", frames,
+    [&](std::size_t)
+    {
+      quantizer.Quantize(kelvin.data(), pixels, counts.data());
+      benchmark::DoNotOptimize(counts.data());
+    });
+
+  quantizer.SetInputEncoding(0.01);
+  benchmark::Run("TemperatureQuantizer::QuantizeEncoded", frames,
+    [&](std::size_t)
+    {
+      quantizer.QuantizeEncoded(codes.data(), pixels, counts.data());
+      benchmark::DoNotOptimize(counts.data());
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(CoreTypesPerformance, ColormapMap)
+{
+  // Intensities of one million points
+  const std::size_t points = 1000000;
+  std::vector<float> values(points);
+  for (auto &v : values)
+    v = static_cast<float>(Rand::DblUniform(0.0, 100.0));
+  std::vector<unsigned int> packed(points);
+
+  // Interpolation between color stops in user code
+  const std::vector<Color> stops = {Color::Blue, Color::Green, Color::Red};
+  const std::size_t frames = 10;
+  benchmark::Run("Color stops interpolation (loop)", frames,
+    [&](std::size_t)
+    {
+      for (std::size_t i = 0; i < points; ++i)
+      {
+        const float t = clamp(values[i] / 100.0f, 0.0f, 1.0f) * 2.0f;
+        const std::size_t k = std::min<std::size_t>(
+            static_cast<std::size_t>(t), 1);
+        const float s = t - k;
+        packed[i] = (stops[k] * (1.0f - s) + stops[k + 1] * s).AsRGBA();
+      }
+      benchmark::DoNotOptimize(packed.data());
+    });
+
+  const Colormap colormap(stops);
+  benchmark::Run("Colormap::Map", frames,
+    [&](std::size_t)
+    {
+      colormap.Map(values.data(), points, 0.0f, 100.0f,
+          Color::PACKED_RGBA, packed.data());
+      benchmark::DoNotOptimize(packed.data());
+    });
+}
@@ -0,0 +1,642 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Times the geometric queries with controlled input distributions: the
+// fraction of queries that hit, and degenerate inputs such as axis aligned
+// rays, coplanar lines or repeated principal moments. The timings depend
+// on these distributions through branches and early exits, so each
+// distribution is reported separately, with the scalar and batch variants
+// of a query next to each other.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gz/math/AxisAlignedBox.hh"
+#include "gz/math/AxisAlignedBox3.hh"
+#include "gz/math/Box.hh"
+#include "gz/math/Frustum.hh"
+#include "gz/math/Line3.hh"
+#include "gz/math/MassMatrix3.hh"
+#include "gz/math/Plane.hh"
+#include "gz/math/Pose3.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Sphere.hh"
+#include "gz/math/Triangle3.hh"
+#include "gz/math/Vector3.hh"
+
+#include "performance/Benchmark.hh"
+
+using namespace gz;
+using namespace math;
+
+// Number of distinct inputs cycled through by each benchmark. Kept small
+// enough to stay in cache so that we measure arithmetic, not memory.
+static const std::size_t kInputs = 1024;
+
+// Number of operations per timed repetition.
+static const std::size_t kIterations = 200000;
+
+// Fractions of queries that hit.
+static const double kHitRatios[] = {0.1, 0.5, 0.9};
+
+/////////////////////////////////////////////////
+/// \brief Get the name of a hit ratio, such as "hit=0.5".
+/// \param[in] _ratio Fraction of queries that hit.
+/// \return The name.
+std::string RatioName(const double _ratio)
+{
+  std::ostringstream ss;
+  ss << "hit=" << _ratio;
+  return ss.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Build kInputs queries, of which a given fraction hits, in a
+/// random order. Random queries are generated and classified until there
+/// are enough hits and misses.
+/// \param[in] _ratio Fraction of queries that hit.
+/// \param[in] _generate Function returning a random query.
+/// \param[in] _hit Function telling whether a query hits.
+/// \return The queries.
+template<typename G, typename H>
+auto MixQueries(const double _ratio, G &&_generate, H &&_hit)
+{
+  using Query = decltype(_generate());
+  const std::size_t hitCount = static_cast<std::size_t>(_ratio * kInputs);
+  std::vector<Query> hits;
+  std::vector<Query> misses;
+  while (hits.size() < hitCount || misses.size() < kInputs - hitCount)
+  {
+    Query query = _generate();
+    if (_hit(query))
+    {
+      if (hits.size() < hitCount)
+        hits.push_back(query);
+    }
+    else if (misses.size() < kInputs - hitCount)
+    {
+      misses.push_back(query);
+    }
+  }
+
+  hits.insert(hits.end(), misses.begin(), misses.end());
+  std::shuffle(hits.begin(), hits.end(), std::mt19937(1234));
+  return hits;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a random unit vector.
+/// \return The vector.
+Vector3d RandomDirection()
+{
+  Vector3d dir;
+  while (dir.SquaredLength() < 1e-6)
+  {
+    dir.Set(Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1),
+            Rand::DblUniform(-1, 1));
+  }
+  return dir.Normalize();
+}
+
+/////////////////////////////////////////////////
+class GeometryQueriesPerformance : public ::testing::Test
+{
+  protected: void SetUp() override
+  {
+    Rand::Seed(1234);
+  }
+};
+
+/// \brief Ray and box of a ray query.
+struct BoxRay
+{
+  /// \brief Box.
+  AxisAlignedBox box;
+
+  /// \brief Same box, in the header-only representation.
+  AxisAlignedBox3d box3;
+
+  /// \brief Origin of the ray.
+  Vector3d origin;
+
+  /// \brief Unit direction of the ray.
+  Vector3d dir;
+};
+
+/////////////////////////////////////////////////
+/// \brief Benchmark the ray queries of AxisAlignedBox and AxisAlignedBox3
+/// on a set of rays.
+/// \param[in] _name Name of the distribution.
+/// \param[in] _rays Rays.
+void BenchmarkBoxRays(const std::string &_name,
+                      const std::vector<BoxRay> &_rays)
+{
+  benchmark::Run("AxisAlignedBox.Intersect " + _name, kIterations,
+    [&](std::size_t _i)
+    {
+      const BoxRay &r = _rays[_i % kInputs];
+      auto result = r.box.Intersect(r.origin, r.dir, 0, 100);
+      benchmark::DoNotOptimize(result);
+    });
+
+  benchmark::Run("AxisAlignedBox.IntersectCheck " + _name, kIterations,
+    [&](std::size_t _i)
+    {
+      const BoxRay &r = _rays[_i % kInputs];
+      bool result = r.box.IntersectCheck(r.origin, r.dir, 0, 100);
+      benchmark::DoNotOptimize(result);
+    });
+
+  benchmark::Run("AxisAlignedBox3d.IntersectCheck " + _name, kIterations,
+    [&](std::size_t _i)
+    {
+      const BoxRay &r = _rays[_i % kInputs];
+      bool result = r.box3.IntersectCheck(r.origin, r.dir, 0, 100);
+      benchmark::DoNotOptimize(result);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(GeometryQueriesPerformance, AxisAlignedBoxRays)
+{
+  // Boxes around the origin, and rays from a surrounding shell towards a
+  // random point near the boxes.
+  auto generate = []()
+  {
+    BoxRay r;
+    const Vector3d half(Rand::DblUniform(0.5, 2), Rand::DblUniform(0.5, 2),
+                        Rand::DblUniform(0.5, 2));
+    r.box = AxisAlignedBox(-half, half);
+    r.box3 = AxisAlignedBox3d(-half, half);
+    r.origin = RandomDirection() * Rand::DblUniform(5, 20);
+    const Vector3d target(Rand::DblUniform(-4, 4), Rand::DblUniform(-4, 4),
+                          Rand::DblUniform(-4, 4));
+    r.dir = (target - r.origin).Normalize();
+    return r;
+  };
+  auto hit = [](const BoxRay &_r)
+  {
+    return _r.box.IntersectCheck(_r.origin, _r.dir, 0, 100);
+  };
+
+  for (const double ratio : kHitRatios)
+    BenchmarkBoxRays(RatioName(ratio), MixQueries(ratio, generate, hit));
+
+  // Degenerate rays parallel to the axes, with zero direction components
+  // whose inverse is infinite, and half of them starting inside the box.
+  std::vector<BoxRay> rays(kInputs);
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    BoxRay &r = rays[i];
+    r = generate();
+    r.dir = Vector3d::Zero;
+    r.dir[i % 3] = i % 6 < 3 ? 1 : -1;
+    if (i % 2 == 0)
+      r.origin = r.box.Center();
+  }
+  BenchmarkBoxRays("axis-aligned", rays);
+}
+
+/////////////////////////////////////////////////
+TEST_F(GeometryQueriesPerformance, FrustumContains)
+{
+  const Frustum frustum(0.1, 50, Angle(IGN_DTOR(60)), 4.0 / 3.0,
+      Pose3d(0, 0, 1, 0, 0, 0));
+
+  auto generate = []()
+  {
+    const Vector3d center(Rand::DblUniform(-10, 60),
+        Rand::DblUniform(-40, 40), Rand::DblUniform(-30, 30));
+    const double half = Rand::DblUniform(0.1, 2);
+    return AxisAlignedBox(center - Vector3d(half, half, half),
+                          center + Vector3d(half, half, half));
+  };
+  auto hit = [&frustum](const AxisAlignedBox &_box)
+  {
+    return frustum.Contains(_box);
+  };
+
+  for (const double ratio : kHitRatios)
+  {
+    const std::string name = RatioName(ratio);
+    const std::vector<AxisAlignedBox> boxes =
+        MixQueries(ratio, generate, hit);
+    std::vector<AxisAlignedBox3d> boxes3;
+    std::vector<Vector3d> centers;
+    std::vector<double> radii;
+    for (const auto &box : boxes)
+    {
+      boxes3.emplace_back(box);
+      centers.push_back(box.Center());
+      radii.push_back(box.Size().Length() * 0.5);
+    }
+
+    // Points of the same distribution, at the center of the boxes.
+    benchmark::Run("Frustum.Contains(Vector3d) " + name, kIterations,
+      [&](std::size_t _i)
+      {
+        bool result = frustum.Contains(centers[_i % kInputs]);
+        benchmark::DoNotOptimize(result);
+      });
+
+    // The loops and batches report the time per batch of kInputs boxes.
+    const std::size_t batches = kIterations / kInputs;
+    benchmark::Run("Frustum.Contains(AxisAlignedBox) loop " + name, batches,
+      [&](std::size_t)
+      {
+        std::size_t count = 0;
+        for (const auto &box : boxes)
+          count += frustum.Contains(box);
+        benchmark::DoNotOptimize(count);
+      });
+
+    std::vector<uint64_t> visible;
+    benchmark::Run("Frustum.Contains(vector<AxisAlignedBox>) " + name,
+      batches,
+      [&](std::size_t)
+      {
+        std::size_t count = frustum.Contains(boxes, visible);
+        benchmark::DoNotOptimize(count);
+      });
+
+    benchmark::Run("Frustum.Contains(vector<AxisAlignedBox3d>) " + name,
+      batches,
+      [&](std::size_t)
+      {
+        std::size_t count = frustum.Contains(boxes3, visible);
+        benchmark::DoNotOptimize(count);
+      });
+
+    benchmark::Run("Frustum.Contains(spheres) " + name, batches,
+      [&](std::size_t)
+      {
+        std::size_t count = frustum.Contains(centers, radii, visible);
+        benchmark::DoNotOptimize(count);
+      });
+  }
+}
+
+/// \brief Triangle and line of a triangle query.
+struct TriangleLine
+{
+  /// \brief Triangle.
+  Triangle3d triangle;
+
+  /// \brief Line segment.
+  Line3d line;
+};
+
+/////////////////////////////////////////////////
+/// \brief Benchmark the line and ray queries of Triangle3, one triangle
+/// after the other, and the closest hit of rays in a buffer of the
+/// triangles.
+/// \param[in] _name Name of the distribution.
+/// \param[in] _queries Queries.
+void BenchmarkTriangleLines(const std::string &_name,
+                            const std::vector<TriangleLine> &_queries)
+{
+  benchmark::Run("Triangle3.Intersects(Line3) " + _name, kIterations,
+    [&](std::size_t _i)
+    {
+      const TriangleLine &q = _queries[_i % kInputs];
+      Vector3d point;
+      bool result = q.triangle.Intersects(q.line, point);
+      benchmark::DoNotOptimize(result);
+      benchmark::DoNotOptimize(point);
+    });
+
+  std::vector<Vector3d> dirs;
+  for (const auto &q : _queries)
+    dirs.push_back(q.line.Direction());
+
+  benchmark::Run("Triangle3.IntersectDist " + _name, kIterations,
+    [&](std::size_t _i)
+    {
+      const TriangleLine &q = _queries[_i % kInputs];
+      auto result = q.triangle.IntersectDist(q.line[0], dirs[_i % kInputs],
+                                             0, q.line.Length());
+      benchmark::DoNotOptimize(result);
+    });
+
+  // One ray against every triangle, reporting the time per batch of
+  // kInputs triangles.
+  std::vector<Vector3d> vertices;
+  std::vector<uint32_t> indices;
+  for (const auto &q : _queries)
+  {
+    for (unsigned int v = 0; v < 3; ++v)
+    {
+      indices.push_back(static_cast<uint32_t>(vertices.size()));
+      vertices.push_back(q.triangle[v]);
+    }
+  }
+
+  const std::size_t batches = kIterations / kInputs;
+  benchmark::Run("Triangle3.IntersectDist loop " + _name, batches,
+    [&](std::size_t _i)
+    {
+      const TriangleLine &ray = _queries[_i % kInputs];
+      bool hit = false;
+      double closest = 100;
+      for (const auto &q : _queries)
+      {
+        bool ok;
+        double dist = 0;
+        std::tie(ok, dist) = q.triangle.IntersectDist(ray.line[0],
+            dirs[_i % kInputs], 0, closest);
+        if (ok)
+        {
+          hit = true;
+          closest = dist;
+        }
+      }
+      benchmark::DoNotOptimize(hit);
+      benchmark::DoNotOptimize(closest);
+    });
+
+  benchmark::Run("Triangle3.ClosestHit " + _name, batches,
+    [&](std::size_t _i)
+    {
+      const TriangleLine &ray = _queries[_i % kInputs];
+      std::size_t triangle = 0;
+      double dist = 0;
+      bool hit = Triangle3d::ClosestHit(vertices.data(), indices.data(),
+          kInputs, ray.line[0], dirs[_i % kInputs], 0.0, 100.0,
+          triangle, dist);
+      benchmark::DoNotOptimize(hit);
+      benchmark::DoNotOptimize(dist);
+    });
+}
+
+/////////////////////////////////////////////////
+TEST_F(GeometryQueriesPerformance, Triangle3Intersects)
+{
+  // Triangles near the origin, and segments from a surrounding shell
+  // towards a random point near the triangles.
+  auto randomPoint = [](const double _extent)
+  {
+    return Vector3d(Rand::DblUniform(-_extent, _extent),
+                    Rand::DblUniform(-_extent, _extent),
+                    Rand::DblUniform(-_extent, _extent));
+  };
+  auto generate = [&randomPoint]()
+  {
+    TriangleLine q;
+    q.triangle.Set(randomPoint(2), randomPoint(2), randomPoint(2));
+    const Vector3d start = RandomDirection() * Rand::DblUniform(5, 10);
+    const Vector3d dir = (randomPoint(2) - start).Normalize();
+    q.line.Set(start, start + dir * 20);
+    return q;
+  };
+  auto hit = [](const TriangleLine &_q)
+  {
+    Vector3d point;
+    return _q.triangle.Intersects(_q.line, point);
+  };
+
+  for (const double ratio : kHitRatios)
+  {
+    BenchmarkTriangleLines(RatioName(ratio),
+                           MixQueries(ratio, generate, hit));
+  }
+
+  // Degenerate queries: lines in the plane of the triangle, which take
+  // the coplanar path of Intersects, and triangles with a zero area.
+  std::vector<TriangleLine> queries(kInputs);
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    TriangleLine &q = queries[i];
+    const Vector3d a = randomPoint(2);
+    const Vector3d b = randomPoint(2);
+    if (i % 2 == 0)
+    {
+      q.triangle.Set(a, b, randomPoint(2));
+      const Vector3d start = a + (a - b) * Rand::DblUniform(0, 2);
+      q.line.Set(start, b + (b - a) * Rand::DblUniform(0, 2));
+    }
+    else
+    {
+      q.triangle.Set(a, b, a + (b - a) * Rand::DblUniform(0, 1));
+      q.line = generate().line;
+    }
+  }
+  BenchmarkTriangleLines("degenerate", queries);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the poses of floating bodies around a water plane at z = 0.
+/// \param[in] _above Fraction of the bodies that are fully above the
+/// water.
+/// \param[in] _below Fraction of the bodies that are fully below the
+/// water. The other bodies cross the water.
+/// \param[in] _reach Largest distance from the center of a body to its
+/// surface.
+/// \return kInputs poses, in a random order.
+std::vector<Pose3d> FloatingPoses(const double _above, const double _below,
+                                  const double _reach)
+{
+  std::vector<Pose3d> poses(kInputs);
+  for (std::size_t i = 0; i < kInputs; ++i)
+  {
+    const double u = static_cast<double>(i) / kInputs;
+    double z = Rand::DblUniform(-0.5, 0.5) * _reach;
+    if (u < _above)
+      z = Rand::DblUniform(1.1, 2) * _reach;
+    else if (u < _above + _below)
+      z = -Rand::DblUniform(1.1, 2) * _reach;
+
+    poses[i].Set(Rand::DblUniform(-10, 10), Rand::DblUniform(-10, 10), z,
+        Rand::DblUniform(-IGN_PI, IGN_PI),
+        Rand::DblUniform(-IGN_PI * 0.5, IGN_PI * 0.5),
+        Rand::DblUniform(-IGN_PI, IGN_PI));
+  }
+  std::shuffle(poses.begin(), poses.end(), std::mt19937(1234));
+  return poses;
+}
+
+/// \brief Mixes of bodies fully above, fully below and crossing a plane.
+struct Waterline
+{
+  /// \brief Name of the mix.
+  const char *name;
+
+  /// \brief Fraction of the bodies fully above the plane.
+  double above;
+
+  /// \brief Fraction of the bodies fully below the plane.
+  double below;
+};
+
+// Mixes of floating bodies: all crossing the water, such as boats, and
+// mostly away from it, such as debris of which a few float.
+static const Waterline kWaterlines[] = {
+  {"crossing", 0.0, 0.0},
+  {"mixed", 0.45, 0.45},
+};
+
+/////////////////////////////////////////////////
+TEST_F(GeometryQueriesPerformance, BoxVolumeBelow)
+{
+  const Planed water(Vector3d::UnitZ, 0);
+  std::vector<Vector3d> sizes(kInputs);
+  for (auto &size : sizes)
+  {
+    size.Set(Rand::DblUniform(0.5, 2), Rand::DblUniform(0.5, 2),
+             Rand::DblUniform(0.5, 2));
+  }
+
+  // Each call computes kInputs boxes
+  const std::size_t calls = kIterations / kInputs;
+  std::vector<double> volumes(kInputs);
+  std::vector<Vector3d> centers(kInputs);
+  for (const auto &waterline : kWaterlines)
+  {
+    const std::string name = waterline.name;
+    const std::vector<Pose3d> poses =
+        FloatingPoses(waterline.above, waterline.below, std::sqrt(3.0));
+
+    benchmark::Run("Box::VolumeBelow " + name, calls,
+      [&](std::size_t)
+      {
+        for (std::size_t i = 0; i < kInputs; ++i)
+        {
+          const Vector3d n = poses[i].Rot().RotateVectorReverse(
+              water.Normal());
+          const Planed local(n, water.Offset() - poses[i].Pos().Z());
+          volumes[i] = Boxd(sizes[i]).VolumeBelow(local);
+        }
+        benchmark::DoNotOptimize(volumes);
+      });
+
+    benchmark::Run("Box::VolumesBelow " + name, calls,
+      [&](std::size_t)
+      {
+        Boxd::VolumesBelow(sizes.data(), poses.data(), kInputs, water,
+                           volumes.data(), centers.data());
+        benchmark::DoNotOptimize(volumes);
+        benchmark::DoNotOptimize(centers);
+      });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(GeometryQueriesPerformance, SphereVolumeBelow)
+{
+  const Planed water(Vector3d::UnitZ, 0);
+  std::vector<double> radii(kInputs);
+  for (auto &radius : radii)
+    radius = Rand::DblUniform(0.5, 1);
+
+  // Each call computes kInputs spheres
+  const std::size_t calls = kIterations / kInputs;
+  std::vector<double> volumes(kInputs);
+  std::vector<Vector3d> centers(kInputs);
+  for (const auto &waterline : kWaterlines)
+  {
+    const std::string name = waterline.name;
+    std::vector<Vector3d> positions;
+    for (const auto &pose :
+         FloatingPoses(waterline.above, waterline.below, 1.0))
+    {
+      positions.push_back(pose.Pos());
+    }
+
+    benchmark::Run("Sphere::VolumeBelow " + name, calls,
+      [&](std::size_t)
+      {
+        for (std::size_t i = 0; i < kInputs; ++i)
+        {
+          const Planed local(water.Normal(),
+                             water.Offset() - positions[i].Z());
+          volumes[i] = Sphered(radii[i]).VolumeBelow(local);
+        }
+        benchmark::DoNotOptimize(volumes);
+      });
+
+    benchmark::Run("Sphere::VolumesBelow " + name, calls,
+      [&](std::size_t)
+      {
+        Sphered::VolumesBelow(radii.data(), positions.data(), kInputs,
+                              water, volumes.data(), centers.data());
+        benchmark::DoNotOptimize(volumes);
+        benchmark::DoNotOptimize(centers);
+      });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(GeometryQueriesPerformance, MassMatrix3PrincipalMoments)
+{
+  auto randomRotation = []()
+  {
+    return Quaterniond(Rand::DblUniform(-IGN_PI, IGN_PI),
+                       Rand::DblUniform(-IGN_PI, IGN_PI),
+                       Rand::DblUniform(-IGN_PI, IGN_PI));
+  };
+
+  // Rotated boxes with distinct principal moments, rotated boxes with
+  // two equal sides, which have a repeated moment, cubes, whose three
+  // moments are equal, and boxes aligned with the axes, whose matrix is
+  // already diagonal.
+  const char *names[] = {"distinct", "repeated", "spherical", "diagonal"};
+  for (unsigned int kind = 0; kind < 4; ++kind)
+  {
+    std::vector<MassMatrix3d> matrices(kInputs);
+    for (auto &m : matrices)
+    {
+      Vector3d size(Rand::DblUniform(1, 2), Rand::DblUniform(1, 2),
+                    Rand::DblUniform(1, 2));
+      Quaterniond rot = randomRotation();
+      if (kind == 1)
+        size.Y() = size.X();
+      else if (kind == 2)
+        size.Set(size.X(), size.X(), size.X());
+      else if (kind == 3)
+        rot = Quaterniond::Identity;
+      m.SetFromBox(Rand::DblUniform(1, 2), size, rot);
+    }
+
+    const std::string name = names[kind];
+    std::vector<Vector3d> moments(kInputs);
+    // Each call computes kInputs matrices
+    const std::size_t calls = kIterations / kInputs;
+    benchmark::Run("MassMatrix3::PrincipalMoments " + name, calls,
+      [&](std::size_t)
+      {
+        for (std::size_t i = 0; i < kInputs; ++i)
+          moments[i] = matrices[i].PrincipalMoments();
+        benchmark::DoNotOptimize(moments);
+      });
+
+    benchmark::Run("MassMatrix3::PrincipalMoments batch " + name, calls,
+      [&](std::size_t)
+      {
+        MassMatrix3d::PrincipalMoments(matrices.data(), kInputs,
+                                       moments.data());
+        benchmark::DoNotOptimize(moments);
+      });
+  }
+}
@@ -0,0 +1,578 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Times the graph library on synthetic grid, random geometric and
+// road-like graphs, and records the peak memory of each operation. The
+// global allocation functions of this test are replaced to track the
+// number of bytes allocated.
+//
+// The graphs have 10^3 to 10^5 vertices by default. Set the environment
+// variable IGNITION_MATH_GRAPH_BENCHMARK_MAX_VERTICES to run larger sizes,
+// up to 10^7 vertices. A Graph of 10^7 vertices needs several GB.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gz/math/graph/CSRGraph.hh"
+#include "gz/math/graph/ContractionHierarchy.hh"
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+#include "gz/math/graph/SearchWorkspace.hh"
+
+#include "performance/Benchmark.hh"
+
+namespace
+{
+  /// \brief Size of the header that stores the size of each allocation,
+  /// which keeps the default alignment of operator new.
+  constexpr std::size_t kHeaderSize = alignof(std::max_align_t);
+
+  /// \brief Number of bytes currently allocated.
+  std::atomic<std::size_t> currentBytes{0};
+
+  /// \brief Largest value of currentBytes since the last ResetPeak().
+  std::atomic<std::size_t> peakBytes{0};
+
+  /// \brief Restart the tracking of the peak memory.
+  /// \return The number of bytes currently allocated.
+  std::size_t ResetPeak()
+  {
+    const std::size_t current = currentBytes.load();
+    peakBytes.store(current);
+    return current;
+  }
+}
+
+// GCC takes the pointers freed by the replaced operator delete for ones
+// returned by operator new, rather than by the malloc below.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  auto *p = static_cast<unsigned char *>(std::malloc(_size + kHeaderSize));
+  if (!p)
+    throw std::bad_alloc();
+
+  *reinterpret_cast<std::size_t *>(p) = _size;
+  const std::size_t current = currentBytes.fetch_add(_size) + _size;
+  std::size_t peak = peakBytes.load();
+  while (current > peak && !peakBytes.compare_exchange_weak(peak, current))
+  {
+  }
+  return p + kHeaderSize;
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_p) noexcept
+{
+  if (!_p)
+    return;
+
+  auto *p = static_cast<unsigned char *>(_p) - kHeaderSize;
+  currentBytes.fetch_sub(*reinterpret_cast<std::size_t *>(p));
+  std::free(p);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_p, std::size_t) noexcept
+{
+  operator delete(_p);
+}
+
+using namespace gz;
+using namespace math;
+using namespace graph;
+
+/// \brief Vertex pair of each edge of a synthetic graph.
+using EdgeList = std::vector<std::pair<CSRIndex, CSRIndex>>;
+
+/// \brief Synthetic graph, as an edge list over dense vertex indices.
+struct SyntheticGraph
+{
+  /// \brief Number of vertices.
+  CSRIndex vertexCount = 0;
+
+  /// \brief Vertices of each edge.
+  EdgeList edges;
+
+  /// \brief Weight of each edge.
+  std::vector<double> weights;
+};
+
+// Seed of the graph generators, so that every run measures the same
+// graphs.
+static const unsigned int kSeed = 12345;
+
+// Number of vertices sampled by the AdjacentsFrom benchmarks.
+static const std::size_t kAdjacentSamples = 1000;
+
+// Number of queries of the point to point benchmarks.
+static const std::size_t kQueries = 100;
+
+// Number of queries of the point to point benchmarks on a Graph, whose
+// Dijkstra visits every vertex even when it has a destination.
+static const std::size_t kGraphQueries = 10;
+
+// Number of sources and of targets of the distance table benchmarks.
+static const std::size_t kTableSize = 32;
+
+// Largest graph whose contraction hierarchy is built. The preprocessing
+// grows faster than linearly, and takes seconds at 10^4 vertices.
+static const std::size_t kMaxContractionVertices = 10000;
+
+// Number of timed repetitions of the whole graph benchmarks.
+static const std::size_t kRepetitions = 3;
+
+/////////////////////////////////////////////////
+/// \brief Build a square grid with 4-neighbour connectivity. The weights
+/// are perturbed so that the shortest paths are unique.
+/// \param[in] _vertices Approximate number of vertices.
+/// \return The grid, whose vertices are numbered row by row.
+SyntheticGraph GridGraph(const std::size_t _vertices)
+{
+  const CSRIndex side = static_cast<CSRIndex>(
+      std::ceil(std::sqrt(static_cast<double>(_vertices))));
+  std::mt19937 engine(kSeed);
+  std::uniform_real_distribution<double> jitter(1.0, 1.1);
+
+  SyntheticGraph res;
+  res.vertexCount = side * side;
+  for (CSRIndex row = 0; row < side; ++row)
+  {
+    for (CSRIndex col = 0; col < side; ++col)
+    {
+      const CSRIndex v = row * side + col;
+      if (col + 1 < side)
+      {
+        res.edges.emplace_back(v, v + 1);
+        res.weights.push_back(jitter(engine));
+      }
+      if (row + 1 < side)
+      {
+        res.edges.emplace_back(v, v + side);
+        res.weights.push_back(jitter(engine));
+      }
+    }
+  }
+  return res;
+}
+
+/////////////////////////////////////////////////
+/// \brief Build a random geometric graph: points uniformly distributed in
+/// the unit square, connected when they are closer than a radius chosen
+/// for an average degree of 6. The weights are the distances.
+/// \param[in] _vertices Number of vertices.
+/// \return The graph.
+SyntheticGraph GeometricGraph(const std::size_t _vertices)
+{
+  const double n = static_cast<double>(_vertices);
+  const double radius = std::sqrt(6.0 / (IGN_PI * n));
+  std::mt19937 engine(kSeed);
+  std::uniform_real_distribution<double> coordinate(0.0, 1.0);
+
+  std::vector<double> x(_vertices);
+  std::vector<double> y(_vertices);
+  for (std::size_t i = 0; i < _vertices; ++i)
+  {
+    x[i] = coordinate(engine);
+    y[i] = coordinate(engine);
+  }
+
+  // Bucket the points in cells of the size of the radius, so that only
+  // the neighbouring cells are searched.
+  const std::size_t cells = std::max<std::size_t>(1,
+      static_cast<std::size_t>(1.0 / radius));
+  auto cellOf = [cells](const double _c)
+  {
+    return std::min(cells - 1, static_cast<std::size_t>(_c * cells));
+  };
+  std::vector<std::size_t> start(cells * cells + 1, 0);
+  for (std::size_t i = 0; i < _vertices; ++i)
+    ++start[cellOf(y[i]) * cells + cellOf(x[i]) + 1];
+  for (std::size_t c = 0; c < cells * cells; ++c)
+    start[c + 1] += start[c];
+  std::vector<CSRIndex> members(_vertices);
+  std::vector<std::size_t> next(start.begin(), start.end() - 1);
+  for (std::size_t i = 0; i < _vertices; ++i)
+    members[next[cellOf(y[i]) * cells + cellOf(x[i])]++] =
+        static_cast<CSRIndex>(i);
+
+  SyntheticGraph res;
+  res.vertexCount = static_cast<CSRIndex>(_vertices);
+  for (std::size_t i = 0; i < _vertices; ++i)
+  {
+    const std::size_t cx = cellOf(x[i]);
+    const std::size_t cy = cellOf(y[i]);
+    for (std::size_t ny = cy > 0 ? cy - 1 : 0;
+         ny <= std::min(cells - 1, cy + 1); ++ny)
+    {
+      for (std::size_t nx = cx > 0 ? cx - 1 : 0;
+           nx <= std::min(cells - 1, cx + 1); ++nx)
+      {
+        const std::size_t c = ny * cells + nx;
+        for (std::size_t m = start[c]; m < start[c + 1]; ++m)
+        {
+          const CSRIndex j = members[m];
+          if (j <= i)
+            continue;
+          const double d = std::hypot(x[j] - x[i], y[j] - y[i]);
+          if (d < radius)
+          {
+            res.edges.emplace_back(static_cast<CSRIndex>(i), j);
+            res.weights.push_back(d);
+          }
+        }
+      }
+    }
+  }
+  return res;
+}
+
+/////////////////////////////////////////////////
+/// \brief Build a road-like graph: a grid of local streets with a quarter
+/// of the streets removed, overlaid with a sparser grid of faster
+/// highways every 16 blocks.
+/// \param[in] _vertices Approximate number of vertices.
+/// \return The graph, whose vertices are numbered row by row.
+SyntheticGraph RoadGraph(const std::size_t _vertices)
+{
+  const CSRIndex side = static_cast<CSRIndex>(
+      std::ceil(std::sqrt(static_cast<double>(_vertices))));
+  const CSRIndex spacing = 16;
+  std::mt19937 engine(kSeed);
+  std::uniform_real_distribution<double> street(1.0, 2.0);
+  std::bernoulli_distribution removed(0.25);
+
+  SyntheticGraph res;
+  res.vertexCount = side * side;
+  for (CSRIndex row = 0; row < side; ++row)
+  {
+    for (CSRIndex col = 0; col < side; ++col)
+    {
+      const CSRIndex v = row * side + col;
+      if (col + 1 < side && !removed(engine))
+      {
+        res.edges.emplace_back(v, v + 1);
+        res.weights.push_back(street(engine));
+      }
+      if (row + 1 < side && !removed(engine))
+      {
+        res.edges.emplace_back(v, v + side);
+        res.weights.push_back(street(engine));
+      }
+      const bool junction = row % spacing == 0 && col % spacing == 0;
+      if (junction && col + spacing < side)
+      {
+        res.edges.emplace_back(v, v + spacing);
+        res.weights.push_back(0.5 * spacing);
+      }
+      if (junction && row + spacing < side)
+      {
+        res.edges.emplace_back(v, v + spacing * side);
+        res.weights.push_back(0.5 * spacing);
+      }
+    }
+  }
+  return res;
+}
+
+/////////////////////////////////////////////////
+/// \brief Build an UndirectedGraph from a synthetic graph, with vertex Ids
+/// equal to the dense indices.
+/// \param[in] _synthetic Synthetic graph.
+/// \return The graph.
+UndirectedGraph<int, double> BuildGraph(const SyntheticGraph &_synthetic)
+{
+  UndirectedGraph<int, double> res;
+  for (CSRIndex v = 0; v < _synthetic.vertexCount; ++v)
+    res.AddVertex("", 0, v);
+  for (std::size_t e = 0; e < _synthetic.edges.size(); ++e)
+  {
+    res.AddEdge({_synthetic.edges[e].first, _synthetic.edges[e].second},
+                0.0, _synthetic.weights[e]);
+  }
+  return res;
+}
+
+/////////////////////////////////////////////////
+/// \brief Time a callable and record its peak memory, above the memory
+/// allocated when it starts, as the .peak_bytes property.
+/// \param[in] _name Name of the benchmark.
+/// \param[in] _iterations Number of calls per repetition.
+/// \param[in] _fn Callable taking the iteration index.
+/// \param[in] _repetitions Number of timed repetitions.
+template<typename F>
+void Measure(const std::string &_name, const std::size_t _iterations,
+             F &&_fn, const std::size_t _repetitions = kRepetitions)
+{
+  const std::size_t baseline = ResetPeak();
+  benchmark::Run(_name, _iterations, _fn, _repetitions);
+  const std::size_t peak = peakBytes.load() - baseline;
+
+  benchmark::ReportMetric(_name, "peak_bytes", static_cast<double>(peak));
+  std::cout << "[ MEMORY   ] " << _name << " peak " << peak << " bytes"
+            << std::endl;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the sizes of the benchmarked graphs.
+/// \return Powers of ten from 10^3 to 10^5, or to the value of
+/// IGNITION_MATH_GRAPH_BENCHMARK_MAX_VERTICES, capped at 10^7.
+std::vector<std::size_t> Sizes()
+{
+  std::size_t maxVertices = 100000;
+  if (const char *env = std::getenv(
+        "IGNITION_MATH_GRAPH_BENCHMARK_MAX_VERTICES"))
+  {
+    maxVertices = std::min<std::size_t>(std::strtoull(env, nullptr, 10),
+                                        10000000);
+  }
+
+  std::vector<std::size_t> res;
+  for (std::size_t n = 1000; n <= maxVertices; n *= 10)
+    res.push_back(n);
+  return res;
+}
+
+/////////////////////////////////////////////////
+/// \brief Benchmark the graph library on one family of synthetic graphs,
+/// for each size returned by Sizes().
+/// \param[in] _family Name of the family.
+/// \param[in] _generator Function building a graph of a given size.
+template<typename G>
+void BenchmarkFamily(const std::string &_family, G &&_generator)
+{
+  for (const std::size_t size : Sizes())
+  {
+    const SyntheticGraph synthetic = _generator(size);
+    const std::string prefix = _family + "_" + std::to_string(size) + ".";
+    std::cout << "[ GRAPH    ] " << _family << " " << synthetic.vertexCount
+              << " vertices, " << synthetic.edges.size() << " edges"
+              << std::endl;
+
+    // Sample vertices and pairs of vertices.
+    std::mt19937 engine(kSeed);
+    std::uniform_int_distribution<CSRIndex> vertex(0,
+        synthetic.vertexCount - 1);
+    std::vector<VertexId> samples(kAdjacentSamples);
+    for (auto &s : samples)
+      s = vertex(engine);
+    std::vector<std::pair<VertexId, VertexId>> queries(kQueries);
+    for (auto &q : queries)
+      q = {vertex(engine), vertex(engine)};
+
+    // Construction.
+    Measure(prefix + "Graph.Construct", 1, [&](std::size_t)
+    {
+      auto g = BuildGraph(synthetic);
+      benchmark::DoNotOptimize(g);
+    });
+    Measure(prefix + "CSRGraph.ConstructFromEdges", 1, [&](std::size_t)
+    {
+      CSRGraph csr(synthetic.vertexCount, synthetic.edges,
+                   synthetic.weights);
+      benchmark::DoNotOptimize(csr);
+    });
+
+    const auto g = BuildGraph(synthetic);
+    Measure(prefix + "CSRGraph.ConstructFromGraph", 1, [&](std::size_t)
+    {
+      CSRGraph csr(g);
+      benchmark::DoNotOptimize(csr);
+    });
+    const CSRGraph csr(g);
+
+    // Neighbour queries.
+    Measure(prefix + "Graph.AdjacentsFrom", kAdjacentSamples,
+        [&](std::size_t _i)
+    {
+      auto adjacents = g.AdjacentsFrom(samples[_i]);
+      benchmark::DoNotOptimize(adjacents);
+    });
+    Measure(prefix + "CSRGraph.Adjacents", kAdjacentSamples,
+        [&](std::size_t _i)
+    {
+      const CSRIndex u = csr.Index(samples[_i]);
+      double sum = 0;
+      for (CSRIndex arc = csr.Offsets()[u]; arc < csr.Offsets()[u + 1];
+           ++arc)
+      {
+        sum += csr.Weights()[arc];
+      }
+      benchmark::DoNotOptimize(sum);
+    });
+
+    // Traversals.
+    Measure(prefix + "Graph.BreadthFirstSort", 1, [&](std::size_t)
+    {
+      auto visited = BreadthFirstSort(g, samples[0]);
+      benchmark::DoNotOptimize(visited);
+    });
+    Measure(prefix + "Graph.DepthFirstSort", 1, [&](std::size_t)
+    {
+      auto visited = DepthFirstSort(g, samples[0]);
+      benchmark::DoNotOptimize(visited);
+    });
+
+    SearchWorkspace workspace;
+    std::vector<VertexId> visited;
+    Measure(prefix + "CSRGraph.BreadthFirstSort", 1, [&](std::size_t)
+    {
+      BreadthFirstSort(csr, samples[0], workspace, visited);
+      benchmark::DoNotOptimize(visited);
+    });
+    Measure(prefix + "CSRGraph.DepthFirstSort", 1, [&](std::size_t)
+    {
+      DepthFirstSort(csr, samples[0], workspace, visited);
+      benchmark::DoNotOptimize(visited);
+    });
+
+    // Shortest paths, to every vertex and between pairs of vertices.
+    Measure(prefix + "Graph.Dijkstra", 1, [&](std::size_t)
+    {
+      auto costs = Dijkstra(g, samples[0]);
+      benchmark::DoNotOptimize(costs);
+    });
+    Measure(prefix + "CSRGraph.Dijkstra", 1, [&](std::size_t)
+    {
+      const bool ok = Dijkstra(csr, samples[0], workspace);
+      benchmark::DoNotOptimize(ok);
+    });
+    Measure(prefix + "CSRGraph.DeltaStepping", 1, [&](std::size_t)
+    {
+      auto costs = DeltaStepping(csr, samples[0]);
+      benchmark::DoNotOptimize(costs);
+    });
+    Measure(prefix + "CSRGraph.DeltaSteppingParallel", 1, [&](std::size_t)
+    {
+      auto costs = DeltaStepping(csr, samples[0], 0.0, 0);
+      benchmark::DoNotOptimize(costs);
+    });
+    Measure(prefix + "Graph.DijkstraToTarget", kGraphQueries,
+        [&](std::size_t _i)
+    {
+      auto costs = Dijkstra(g, queries[_i].first, queries[_i].second);
+      benchmark::DoNotOptimize(costs);
+    }, 1);
+    Measure(prefix + "CSRGraph.DijkstraToTarget", kQueries,
+        [&](std::size_t _i)
+    {
+      const bool ok = Dijkstra(csr, queries[_i].first, workspace,
+                               queries[_i].second);
+      benchmark::DoNotOptimize(ok);
+    }, 1);
+
+    // Distance table between the ends of the queries.
+    std::vector<VertexId> tableSources(kTableSize);
+    std::vector<VertexId> tableTargets(kTableSize);
+    for (std::size_t i = 0; i < kTableSize; ++i)
+    {
+      tableSources[i] = queries[i].first;
+      tableTargets[i] = queries[i].second;
+    }
+    std::vector<double> table;
+    Measure(prefix + "CSRGraph.DistanceTable", 1, [&](std::size_t)
+    {
+      const bool ok = DistanceTable(csr, tableSources, tableTargets, table);
+      benchmark::DoNotOptimize(ok);
+    }, 1);
+
+    // Contraction hierarchy preprocessing and queries.
+    if (size <= kMaxContractionVertices)
+    {
+      ContractionHierarchy ch;
+      Measure(prefix + "ContractionHierarchy.Construct", 1, [&](std::size_t)
+      {
+        ch = ContractionHierarchy(csr);
+      }, 1);
+      SearchWorkspace backward;
+      std::vector<VertexId> path;
+      Measure(prefix + "ContractionHierarchy.ShortestPath", kQueries,
+          [&](std::size_t _i)
+      {
+        const double cost = ch.ShortestPath(queries[_i].first,
+            queries[_i].second, workspace, backward, path);
+        benchmark::DoNotOptimize(cost);
+      });
+      Measure(prefix + "ContractionHierarchy.DistanceTable", 1,
+          [&](std::size_t)
+      {
+        const bool ok = ch.DistanceTable(tableSources, tableTargets, table);
+        benchmark::DoNotOptimize(ok);
+      });
+    }
+
+    // Connected components.
+    Measure(prefix + "Graph.ConnectedComponents", 1, [&](std::size_t)
+    {
+      auto components = ConnectedComponents(g);
+      benchmark::DoNotOptimize(components);
+    });
+    Measure(prefix + "Graph.ConnectedComponentLabels", 1, [&](std::size_t)
+    {
+      std::map<VertexId, unsigned int> labels;
+      const unsigned int count = ConnectedComponents(g, labels);
+      benchmark::DoNotOptimize(count);
+    });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(GraphBenchmark, MemoryTracking)
+{
+  // The peak memory would be meaningless if allocations were not tracked
+  const std::size_t baseline = ResetPeak();
+  {
+    std::vector<double> values(1000);
+    benchmark::DoNotOptimize(values.data());
+  }
+  EXPECT_EQ(baseline, currentBytes.load());
+  EXPECT_EQ(1000 * sizeof(double), peakBytes.load() - baseline);
+}
+
+/////////////////////////////////////////////////
+TEST(GraphBenchmark, Grid)
+{
+  BenchmarkFamily("Grid", GridGraph);
+}
+
+/////////////////////////////////////////////////
+TEST(GraphBenchmark, Geometric)
+{
+  BenchmarkFamily("Geometric", GeometricGraph);
+}
+
+/////////////////////////////////////////////////
+TEST(GraphBenchmark, Road)
+{
+  BenchmarkFamily("Road", RoadGraph);
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Checks that the hot paths of the control loop classes, documented as
+// real-time safe, never allocate once the objects are set up, and times
+// them. The global allocation functions of this test are replaced to count
+// the allocations of each thread.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "gz/math/Angle.hh"
+#include "gz/math/DiffDriveOdometry.hh"
+#include "gz/math/GaussMarkovProcess.hh"
+#include "gz/math/MecanumDriveOdometry.hh"
+#include "gz/math/MovingWindowFilter.hh"
+#include "gz/math/PID.hh"
+#include "gz/math/PhiloxEngine.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/RollingMean.hh"
+#include "gz/math/SpeedLimiter.hh"
+#include "gz/math/Vector3.hh"
+
+#include "performance/Benchmark.hh"
+
+namespace
+{
+  /// \brief Number of allocations made by the current thread.
+  thread_local std::size_t tlsAllocations = 0;
+}
+
+// GCC takes the pointers freed by the replaced operator delete for ones
+// returned by operator new, rather than by the malloc below.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  ++tlsAllocations;
+  if (void *p = std::malloc(_size > 0 ? _size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_p) noexcept
+{
+  std::free(_p);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_p, std::size_t) noexcept
+{
+  std::free(_p);
+}
+
+using namespace gz;
+using namespace math;
+
+// Number of calls per timed repetition.
+static const std::size_t kIterations = 100000;
+
+/////////////////////////////////////////////////
+/// \brief Call a function, check that it doesn't allocate, and time it.
+/// The first calls, which may set up lazily allocated state such as the
+/// engine of Rand, are not checked.
+/// \param[in] _name Name of the benchmark.
+/// \param[in] _fn Function taking the iteration index.
+template<typename F>
+void ExpectRealTimeSafe(const std::string &_name, F &&_fn)
+{
+  for (std::size_t i = 0; i < 100; ++i)
+    _fn(i);
+
+  const std::size_t before = tlsAllocations;
+  for (std::size_t i = 0; i < kIterations; ++i)
+    _fn(i);
+  EXPECT_EQ(0u, tlsAllocations - before) << _name << " allocated";
+
+  benchmark::Run(_name, kIterations, _fn);
+}
+
+/////////////////////////////////////////////////
+TEST(RealTime, AllocationHook)
+{
+  // The check would pass trivially if allocations were not counted
+  const std::size_t before = tlsAllocations;
+  std::vector<double> values(10);
+  benchmark::DoNotOptimize(values.data());
+  EXPECT_EQ(1u, tlsAllocations - before);
+}
+
+/////////////////////////////////////////////////
+TEST(RealTime, PID)
+{
+  PID pid(1.0, 0.1, 0.05, 0.5, -0.5, 10, -10);
+  const std::chrono::duration<double> dt(0.001);
+  ExpectRealTimeSafe("PID.Update", [&](std::size_t _i)
+  {
+    benchmark::DoNotOptimize(pid.Update(std::sin(_i * 0.01), dt));
+  });
+  ExpectRealTimeSafe("PID.Update (error rate)", [&](std::size_t _i)
+  {
+    benchmark::DoNotOptimize(
+        pid.Update(std::sin(_i * 0.01), std::cos(_i * 0.01), dt));
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(RealTime, SpeedLimiter)
+{
+  SpeedLimiter limiter;
+  limiter.SetMinVelocity(-2.0);
+  limiter.SetMaxVelocity(2.0);
+  limiter.SetMinAcceleration(-1.0);
+  limiter.SetMaxAcceleration(1.0);
+  limiter.SetMinJerk(-5.0);
+  limiter.SetMaxJerk(5.0);
+  const auto dt = std::chrono::milliseconds(10);
+  double prevVel = 0.0;
+  double prevPrevVel = 0.0;
+  ExpectRealTimeSafe("SpeedLimiter.Limit", [&](std::size_t _i)
+  {
+    double vel = 3.0 * std::sin(_i * 0.01);
+    benchmark::DoNotOptimize(limiter.Limit(vel, prevVel, prevPrevVel, dt));
+    prevPrevVel = prevVel;
+    prevVel = vel;
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(RealTime, DiffDriveOdometry)
+{
+  // The default window size is stored inline, other ones in a RollingMean
+  for (std::size_t windowSize : {10u, 25u})
+  {
+    DiffDriveOdometry odom(windowSize);
+    odom.SetWheelParams(1.0, 0.2, 0.2);
+    auto time = std::chrono::steady_clock::time_point();
+    odom.Init(time);
+    ExpectRealTimeSafe("DiffDriveOdometry.Update (window " +
+        std::to_string(windowSize) + ")", [&](std::size_t _i)
+    {
+      time += std::chrono::milliseconds(10);
+      odom.Update(Angle(_i * 0.02), Angle(_i * 0.021), time);
+      benchmark::DoNotOptimize(odom.X());
+    });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(RealTime, MecanumDriveOdometry)
+{
+  for (std::size_t windowSize : {10u, 25u})
+  {
+    MecanumDriveOdometry odom(windowSize);
+    odom.SetWheelParams(1.0, 1.0, 0.2, 0.2);
+    auto time = std::chrono::steady_clock::time_point();
+    odom.Init(time);
+    ExpectRealTimeSafe("MecanumDriveOdometry.Update (window " +
+        std::to_string(windowSize) + ")", [&](std::size_t _i)
+    {
+      time += std::chrono::milliseconds(10);
+      odom.Update(Angle(_i * 0.02), Angle(_i * 0.021), Angle(_i * 0.019),
+                  Angle(_i * 0.02), time);
+      benchmark::DoNotOptimize(odom.X());
+    });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(RealTime, MovingWindowFilter)
+{
+  MovingWindowFilter<Vector3d> filter;
+  filter.SetWindowSize(32);
+  ExpectRealTimeSafe("MovingWindowFilter.Update", [&](std::size_t _i)
+  {
+    filter.Update(Vector3d(_i * 0.1, 1.0, -2.0));
+    benchmark::DoNotOptimize(filter.Value());
+  });
+
+  FixedMovingWindowFilter<Vector3d, 32> fixed;
+  ExpectRealTimeSafe("FixedMovingWindowFilter.Update", [&](std::size_t _i)
+  {
+    fixed.Update(Vector3d(_i * 0.1, 1.0, -2.0));
+    benchmark::DoNotOptimize(fixed.Value());
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(RealTime, RollingMean)
+{
+  RollingMean mean(32);
+  ExpectRealTimeSafe("RollingMean.Push", [&](std::size_t _i)
+  {
+    mean.Push(_i * 0.5);
+    benchmark::DoNotOptimize(mean.Mean());
+  });
+
+  // Clearing keeps the buffer
+  ExpectRealTimeSafe("RollingMean.Clear", [&](std::size_t _i)
+  {
+    if (_i % 64 == 0)
+      mean.Clear();
+    mean.Push(_i * 0.5);
+    benchmark::DoNotOptimize(mean.Count());
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(RealTime, GaussMarkovProcess)
+{
+  GaussMarkovProcess process(0.0, 0.5, 1.0, 0.1);
+  const auto dt = std::chrono::milliseconds(10);
+  ExpectRealTimeSafe("GaussMarkovProcess.Update", [&](std::size_t)
+  {
+    benchmark::DoNotOptimize(process.Update(dt));
+  });
+
+  PhiloxEngine engine = Rand::StreamEngine(7);
+  ExpectRealTimeSafe("GaussMarkovProcess.Update (engine)", [&](std::size_t)
+  {
+    benchmark::DoNotOptimize(process.Update(dt, engine));
+  });
+}
@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+# Copyright (C) 2023 Open Source Robotics Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License")
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#       http:#www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Compare two sets of benchmark results written by the performance tests.
+
+Run the performance tests of two builds with IGNITION_MATH_BENCHMARK_OUTPUT
+set to a directory, then compare the directories, or two result files:
+
+    compare_benchmarks.py baseline/ candidate/
+
+A benchmark is flagged as slower when its mean time grew by more than the
+threshold and Welch's t-test on the mean and standard deviation of the
+repetitions, as computed by SignalStats, finds the slowdown significant.
+The exit status is 1 when a benchmark is slower, so that the tool can gate
+a build. The printed p-value is the one-sided p-value of a slowdown.
+
+The test only accounts for the noise within each run, so both runs should
+be made on the same idle machine. A warning is printed when the CPU,
+compiler or flags recorded in the results differ.
+"""
+
+import argparse
+import json
+import math
+import os
+import sys
+
+SCHEMA = 'gz-math-benchmark'
+SCHEMA_VERSION = 1
+
+# Environment fields which make timings incomparable when they differ.
+ENVIRONMENT_KEYS = ['cpu', 'simd', 'compiler', 'build_type', 'flags']
+
+
+def incomplete_beta(a, b, x):
+    """Regularized incomplete beta function I_x(a, b).
+
+    Evaluated with the continued fraction of Numerical Recipes, which
+    converges quickly for x < (a + 1) / (a + b + 2), and the symmetry
+    I_x(a, b) = 1 - I_(1-x)(b, a) otherwise.
+    """
+    if x <= 0:
+        return 0.0
+    if x >= 1:
+        return 1.0
+    if x > (a + 1) / (a + b + 2):
+        return 1.0 - incomplete_beta(b, a, 1 - x)
+
+    log_front = (math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) +
+                 a * math.log(x) + b * math.log(1 - x))
+    tiny = 1e-300
+    c = 1.0
+    d = 1.0 - (a + b) * x / (a + 1)
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    f = d
+    for m in range(1, 300):
+        # Even and odd steps of the continued fraction
+        for numerator in (m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m)),
+                          -(a + m) * (a + b + m) * x /
+                          ((a + 2 * m) * (a + 2 * m + 1))):
+            d = 1.0 + numerator * d
+            d = 1.0 / (d if abs(d) > tiny else tiny)
+            c = 1.0 + numerator / c
+            c = c if abs(c) > tiny else tiny
+            f *= c * d
+        if abs(c * d - 1.0) < 1e-12:
+            break
+    return math.exp(log_front) * f / a
+
+
+def welch_p_value(base, cand):
+    """One-sided p-value of the candidate being slower than the baseline.
+
+    Each argument is a (mean, standard deviation, repetitions) tuple.
+    Return None when there are too few repetitions for a test.
+    """
+    (m1, s1, n1), (m2, s2, n2) = base, cand
+    if n1 < 2 or n2 < 2:
+        return None
+
+    v1 = s1 * s1 / n1
+    v2 = s2 * s2 / n2
+    if v1 + v2 == 0:
+        return 0.0 if m2 > m1 else 1.0
+
+    t = (m2 - m1) / math.sqrt(v1 + v2)
+    df = (v1 + v2) ** 2 / (v1 * v1 / (n1 - 1) + v2 * v2 / (n2 - 1))
+    tail = 0.5 * incomplete_beta(df / 2, 0.5, df / (df + t * t))
+    return tail if t > 0 else 1.0 - tail
+
+
+def load(path):
+    """Load result files, keyed by (test, benchmark name).
+
+    Return the results and the environment of each file.
+    """
+    if os.path.isdir(path):
+        files = sorted(os.path.join(path, f) for f in os.listdir(path)
+                       if f.endswith('.json'))
+    else:
+        files = [path]
+
+    results = {}
+    environments = []
+    for filename in files:
+        with open(filename) as f:
+            doc = json.load(f)
+        if (doc.get('schema') != SCHEMA or
+                doc.get('schema_version') != SCHEMA_VERSION):
+            sys.exit('{}: not a {} version {} file'.format(
+                filename, SCHEMA, SCHEMA_VERSION))
+        environments.append(doc['environment'])
+        for bench in doc['benchmarks']:
+            results[(bench['test'], bench['name'])] = bench
+    return results, environments
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('baseline', help='result file or directory')
+    parser.add_argument('candidate', help='result file or directory')
+    parser.add_argument('--threshold', type=float, default=0.05,
+                        help='smallest relative change reported '
+                             '(default: %(default)s)')
+    parser.add_argument('--alpha', type=float, default=0.01,
+                        help='significance level of the t-test '
+                             '(default: %(default)s)')
+    parser.add_argument('--all', action='store_true',
+                        help='print unchanged benchmarks too')
+    args = parser.parse_args()
+
+    base, base_env = load(args.baseline)
+    cand, cand_env = load(args.candidate)
+
+    for key in ENVIRONMENT_KEYS:
+        before = sorted({str(e.get(key)) for e in base_env})
+        after = sorted({str(e.get(key)) for e in cand_env})
+        if before != after:
+            print('warning: {} differs: {} -> {}'.format(
+                key, ', '.join(before), ', '.join(after)))
+
+    slower = 0
+    for key in sorted(set(base) & set(cand)):
+        b, c = base[key], cand[key]
+        if not b['mean_ns'] or c['mean_ns'] is None:
+            continue
+
+        change = c['mean_ns'] / b['mean_ns'] - 1
+        p = welch_p_value((b['mean_ns'], b['stddev_ns'] or 0,
+                           b['repetitions']),
+                          (c['mean_ns'], c['stddev_ns'] or 0,
+                           c['repetitions']))
+        if abs(change) <= args.threshold:
+            status = 'same'
+        elif p is None:
+            status = 'untested'
+        elif change > 0 and p < args.alpha:
+            status = 'SLOWER'
+            slower += 1
+        elif change < 0 and 1 - p < args.alpha:
+            status = 'faster'
+        else:
+            status = 'noise'
+
+        if status != 'same' or args.all:
+            print('{:<9}{:+8.1%}  {:>12.3f} -> {:>12.3f} ns/op  '
+                  'p={}  {} / {}'.format(
+                      status, change, b['mean_ns'], c['mean_ns'],
+                      'n/a' if p is None else '{:.4f}'.format(p),
+                      key[0], key[1]))
+
+        # Other measurements have a single value per run.
+        for metric in sorted(set(b['metrics']) & set(c['metrics'])):
+            before, after = b['metrics'][metric], c['metrics'][metric]
+            if before and after and after > before * (1 + args.threshold):
+                print('{:<9}{:+8.1%}  {} of {} / {}'.format(
+                    'more', after / before - 1, metric, key[0], key[1]))
+
+    for key in sorted(set(base) - set(cand)):
+        print('removed  {} / {}'.format(*key))
+    for key in sorted(set(cand) - set(base)):
+        print('added    {} / {}'.format(*key))
+
+    print('{} of {} benchmarks significantly slower'.format(
+        slower, len(set(base) & set(cand))))
+    return 1 if slower else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())